@@ -620,6 +620,60 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt&      ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+/// Structure-of-arrays axis-aligned bounding box data used by GetBoxVisibilityBatch().
+///
+/// Each member points to an array of NumBoxes floats, for example
+/// box i spans [MinX[i], MaxX[i]] x [MinY[i], MaxY[i]] x [MinZ[i], MaxZ[i]].
+struct BoundBoxSOA
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+};
+
+/// Tests the visibility of multiple axis-aligned bounding boxes against the view frustum.
+
+/// \param[in]  Frustum         - View frustum.
+/// \param[in]  Boxes           - Bounding boxes in the structure-of-arrays layout.
+/// \param[in]  NumBoxes        - The number of boxes.
+/// \param[out] pVisibility     - Optional array of NumBoxes elements that receives the visibility of every box.
+/// \param[out] pVisibilityMask - Optional bit mask of (NumBoxes + 31) / 32 elements. Bit i % 32 of element i / 32
+///                               is set if box i is visible (i.e. fully visible or intersecting the frustum).
+///                               Unused bits of the last element are cleared.
+/// \param[in]  PlaneFlags      - Frustum planes to test the boxes against.
+///
+/// \remarks   The results match GetBoxVisibility(const ViewFrustum&, const BoundBox&, FRUSTUM_PLANE_FLAGS).
+///            The boxes are processed 8 or 4 at a time using AVX2 or SSE instructions when available.
+///
+///            The additional frustum corner test performed by the ViewFrustumExt overload is not applied.
+///            If needed, it can be run for the intersecting boxes only.
+void GetBoxVisibilityBatch(const ViewFrustum&  Frustum,
+                           const BoundBoxSOA&  Boxes,
+                           size_t              NumBoxes,
+                           BoxVisibility*      pVisibility,
+                           Uint32*             pVisibilityMask,
+                           FRUSTUM_PLANE_FLAGS PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+struct IThreadPool;
+
+/// Same as GetBoxVisibilityBatch(), but splits the boxes into chunks that are processed by the thread pool.
+
+/// \param[in] pThreadPool  - Thread pool. If null, the boxes are processed on the calling thread.
+/// \param[in] BoxesPerTask - The number of boxes processed by one task. It is rounded up to a multiple of 32.
+///
+/// \remarks   The calling thread processes one chunk itself and then waits for the remaining tasks to complete.
+void GetBoxVisibilityBatchParallel(IThreadPool*        pThreadPool,
+                                   const ViewFrustum&  Frustum,
+                                   const BoundBoxSOA&  Boxes,
+                                   size_t              NumBoxes,
+                                   BoxVisibility*      pVisibility,
+                                   Uint32*             pVisibilityMask,
+                                   FRUSTUM_PLANE_FLAGS PlaneFlags   = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                                   size_t              BoxesPerTask = 4096);
+
 inline float GetPointToBoxDistanceSqr(const BoundBox& BB, const float3& Pos)
 {
     VERIFY_EXPR(BB.Max.x >= BB.Min.x &&
@@ -0,0 +1,476 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::BVH class
+
+#include <cfloat>
+#include <vector>
+
+#include "AdvancedMath.hpp"
+#include "ThreadPool.hpp"
+#include "../../Platforms/interface/Intrinsics.hpp"
+
+#if !defined(DILIGENT_DISABLE_SIMD_MATH)
+#    if DILIGENT_SSE2_ENABLED
+#        define DILIGENT_BVH_SSE 1
+#    elif DILIGENT_NEON_ENABLED
+#        define DILIGENT_BVH_NEON 1
+#    endif
+#endif
+
+namespace Diligent
+{
+
+/// Bounding volume hierarchy for CPU ray and box queries.
+
+/// The hierarchy is built over arbitrary primitives defined by their axis-aligned bounding boxes,
+/// e.g. triangles, meshes or instances. The primitives themselves are tested by the user-provided
+/// function, so that the same hierarchy can be used for triangle meshes, oriented boxes, etc.
+///
+/// The hierarchy is built by the binned SAH builder as a binary tree, which is then collapsed into
+/// a 4-wide tree. The children of every node are tested against the ray at once using SSE2 or NEON
+/// instructions when available. The large subtrees are built in parallel by the thread pool.
+///
+/// Usage example:
+///
+///     std::vector<BoundBox> TriBoxes = ...;
+///     BVH Bvh;
+///     Bvh.Build(TriBoxes.data(), NumTriangles);
+///
+///     BVH::Ray Ray{Origin, Direction};
+///     BVH::Hit Hit = Bvh.CastRay(Ray, [&](Uint32 Tri, const BVH::Ray& Ray) {
+///         return IntersectRayTriangle(V[Tri * 3 + 0], V[Tri * 3 + 1], V[Tri * 3 + 2], Ray.Origin, Ray.Direction);
+///     });
+///
+/// \remarks    The hierarchy is complementary to the GPU bottom- and top-level acceleration structures (IBottomLevelAS
+///             and ITopLevelAS) and is intended for the queries that are run on the CPU, e.g. picking or gameplay ray casts.
+class BVH
+{
+public:
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    /// Maximum tree depth. Primitives in deeper nodes are kept in larger leaves.
+    static constexpr Uint32 MaxDepth = 64;
+
+    struct BuildInfo
+    {
+        /// Maximum number of primitives in a leaf.
+        Uint32 MaxLeafSize = 4;
+
+        /// The number of bins used by the SAH builder, up to 32.
+        Uint32 NumBins = 16;
+
+        /// Optional thread pool used to build the subtrees in parallel.
+        IThreadPool* pThreadPool = nullptr;
+
+        /// Subtrees with fewer primitives are built by a single thread.
+        Uint32 ParallelBuildThreshold = 4096;
+    };
+
+    struct Ray
+    {
+        float3 Origin;
+
+        /// Ray direction. Does not need to be normalized; distances are measured in units of the direction length.
+        float3 Direction;
+
+        float MinDistance = 0;
+        float MaxDistance = FLT_MAX;
+
+        Ray() noexcept {}
+
+        Ray(const float3& _Origin,
+            const float3& _Direction,
+            float         _MinDistance = 0,
+            float         _MaxDistance = FLT_MAX) noexcept :
+            Origin{_Origin},
+            Direction{_Direction},
+            MinDistance{_MinDistance},
+            MaxDistance{_MaxDistance}
+        {}
+    };
+
+    struct Hit
+    {
+        /// Index of the closest primitive hit, or InvalidIndex if there was no hit.
+        Uint32 PrimitiveId = InvalidIndex;
+
+        /// Distance to the hit point along the ray.
+        float Distance = FLT_MAX;
+
+        explicit operator bool() const { return PrimitiveId != InvalidIndex; }
+    };
+
+    /// Builds the hierarchy.
+
+    /// \param [in] pPrimitiveBoxes - Bounding boxes of the primitives.
+    /// \param [in] NumPrimitives   - The number of primitives.
+    /// \param [in] Info            - Build parameters.
+    void Build(const BoundBox* pPrimitiveBoxes, Uint32 NumPrimitives, const BuildInfo& Info);
+
+    /// Builds the hierarchy with the default parameters on the calling thread.
+    void Build(const BoundBox* pPrimitiveBoxes, Uint32 NumPrimitives)
+    {
+        Build(pPrimitiveBoxes, NumPrimitives, BuildInfo{});
+    }
+
+    /// Updates the bounding boxes of the nodes without changing the tree topology.
+
+    /// \param [in] pPrimitiveBoxes - New bounding boxes of the primitives. The number of primitives and
+    ///                               their order must be the same as in the last call to Build().
+    ///
+    /// \remarks    Refitting is much faster than rebuilding, but the quality of the tree degrades
+    ///             when the primitives move significantly, e.g. for animated instances. Rebuild the tree
+    ///             from time to time in this case.
+    void Refit(const BoundBox* pPrimitiveBoxes);
+
+    /// Finds the closest primitive hit by the ray.
+
+    /// \param [in] R                  - Ray.
+    /// \param [in] IntersectPrimitive - Function with the signature float(Uint32 PrimitiveId, const Ray& R) that
+    ///                                  returns the distance to the primitive along the ray, or FLT_MAX if the
+    ///                                  ray misses the primitive. The hits outside of [R.MinDistance, R.MaxDistance]
+    ///                                  are ignored, so IntersectRayTriangle() can be used directly.
+    template <typename IntersectPrimitiveType>
+    Hit CastRay(const Ray& R, IntersectPrimitiveType&& IntersectPrimitive) const
+    {
+        Hit Result;
+        Result.Distance = R.MaxDistance;
+        Traverse(R, [&](Uint32 PrimitiveId, float& MaxDistance) {
+            const float Distance = IntersectPrimitive(PrimitiveId, R);
+            if (Distance >= R.MinDistance && Distance < MaxDistance)
+            {
+                MaxDistance        = Distance;
+                Result.PrimitiveId = PrimitiveId;
+                Result.Distance    = Distance;
+            }
+            return true;
+        });
+        if (!Result)
+            Result.Distance = FLT_MAX;
+        return Result;
+    }
+
+    /// Returns true if the ray hits any primitive, see CastRay().
+
+    /// \remarks    The traversal stops at the first hit found, which is not necessarily the closest one.
+    template <typename IntersectPrimitiveType>
+    bool IntersectsAny(const Ray& R, IntersectPrimitiveType&& IntersectPrimitive) const
+    {
+        bool AnyHit = false;
+        Traverse(R, [&](Uint32 PrimitiveId, float& MaxDistance) {
+            const float Distance = IntersectPrimitive(PrimitiveId, R);
+            AnyHit               = Distance >= R.MinDistance && Distance < MaxDistance;
+            return !AnyHit;
+        });
+        return AnyHit;
+    }
+
+    /// Casts multiple rays, see CastRay().
+
+    /// \param [in]  pRays              - Rays.
+    /// \param [in]  NumRays            - The number of rays.
+    /// \param [out] pHits              - Array of NumRays elements that receives the closest hit of every ray.
+    /// \param [in]  IntersectPrimitive - Primitive intersection function, see CastRay().
+    ///                                   Must be thread-safe if the thread pool is used.
+    /// \param [in]  pThreadPool        - Optional thread pool used to process the rays in parallel.
+    /// \param [in]  RaysPerTask        - The number of rays processed by one thread pool task.
+    template <typename IntersectPrimitiveType>
+    void CastRays(const Ray*             pRays,
+                  size_t                 NumRays,
+                  Hit*                   pHits,
+                  IntersectPrimitiveType IntersectPrimitive,
+                  IThreadPool*           pThreadPool = nullptr,
+                  size_t                 RaysPerTask = 256) const
+    {
+        RaysPerTask = std::max(RaysPerTask, size_t{1});
+        if (pThreadPool == nullptr || NumRays <= RaysPerTask)
+        {
+            for (size_t i = 0; i < NumRays; ++i)
+                pHits[i] = CastRay(pRays[i], IntersectPrimitive);
+            return;
+        }
+
+        ProcessItemsInParallel(pThreadPool, (NumRays + RaysPerTask - 1) / RaysPerTask,
+                               [&](size_t Chunk) {
+                                   const size_t Start = Chunk * RaysPerTask;
+                                   const size_t End   = std::min(Start + RaysPerTask, NumRays);
+                                   for (size_t i = Start; i < End; ++i)
+                                       pHits[i] = CastRay(pRays[i], IntersectPrimitive);
+                               });
+    }
+
+    /// Calls the callback for the primitives in all leaves whose bounds overlap the given box.
+
+    /// \param [in] Box      - Query box.
+    /// \param [in] Callback - Function with the signature bool(Uint32 PrimitiveId). Return false to stop the query.
+    ///
+    /// \remarks    Individual primitive boxes are not stored in the hierarchy, so the callback
+    ///             should test the primitive itself if needed.
+    template <typename CallbackType>
+    void QueryBox(const BoundBox& Box, CallbackType&& Callback) const;
+
+    /// Returns the bounding box of all primitives.
+    BoundBox GetBounds() const;
+
+    /// Returns the number of primitives in the hierarchy.
+    Uint32 GetNumPrimitives() const { return static_cast<Uint32>(m_PrimitiveIndices.size()); }
+
+    /// Returns the number of 4-wide nodes in the hierarchy.
+    Uint32 GetNumNodes() const { return static_cast<Uint32>(m_Nodes.size()); }
+
+    /// Returns the name of the SIMD instruction set used to traverse the hierarchy.
+    static const char* GetImplementationName();
+
+private:
+    // 4-wide node with the children bounds in the structure-of-arrays layout
+    struct alignas(16) Node
+    {
+        float MinX[4];
+        float MinY[4];
+        float MinZ[4];
+        float MaxX[4];
+        float MaxY[4];
+        float MaxZ[4];
+
+        // Index of the child node for internal children, index of the first primitive in
+        // m_PrimitiveIndices for leaves, or InvalidIndex for unused slots.
+        Uint32 Child[4];
+
+        // The number of primitives for leaves, and 0 for internal children and unused slots.
+        Uint32 Count[4];
+
+        void SetBounds(Uint32 Slot, const BoundBox& Box);
+        void ResetSlot(Uint32 Slot);
+    };
+
+    struct RayData
+    {
+        float3 Origin;
+        float3 InvDirection;
+        float  MinDistance;
+
+        explicit RayData(const Ray& R);
+    };
+
+    // Intersects the ray with the bounds of all children of the node, returns the mask of the children hit and
+    // writes the entry distances to pDistances.
+    static Uint32 IntersectNode(const RayData& RD, const Node& N, float MaxDistance, float* pDistances);
+
+    // Calls LeafHandler(PrimitiveId, MaxDistance) for every primitive whose leaf is hit by the ray, front to back.
+    // The handler may reduce MaxDistance and returns false to stop the traversal.
+    template <typename LeafHandlerType>
+    void Traverse(const Ray& R, LeafHandlerType&& LeafHandler) const;
+
+    std::vector<Node>   m_Nodes;
+    std::vector<Uint32> m_PrimitiveIndices;
+};
+
+inline BVH::RayData::RayData(const Ray& R) :
+    Origin{R.Origin},
+    MinDistance{R.MinDistance}
+{
+    // Avoid infinities, so that 0 * InvDirection is never NaN, same as IntersectRayBox3D()
+    static constexpr float Epsilon = 1e-20f;
+    for (int i = 0; i < 3; ++i)
+    {
+        const float d   = R.Direction[i];
+        InvDirection[i] = 1.f / (std::abs(d) > Epsilon ? d : (d < 0 ? -Epsilon : Epsilon));
+    }
+}
+
+// NB: all implementations must perform the same operations in the same order to produce identical results.
+inline Uint32 BVH::IntersectNode(const RayData& RD, const Node& N, float MaxDistance, float* pDistances)
+{
+#if DILIGENT_BVH_SSE
+    const __m128 Ox = _mm_set1_ps(RD.Origin.x);
+    const __m128 Oy = _mm_set1_ps(RD.Origin.y);
+    const __m128 Oz = _mm_set1_ps(RD.Origin.z);
+    const __m128 Ix = _mm_set1_ps(RD.InvDirection.x);
+    const __m128 Iy = _mm_set1_ps(RD.InvDirection.y);
+    const __m128 Iz = _mm_set1_ps(RD.InvDirection.z);
+
+    const __m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(N.MinX), Ox), Ix);
+    const __m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(N.MinY), Oy), Iy);
+    const __m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(N.MinZ), Oz), Iz);
+    const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(N.MaxX), Ox), Ix);
+    const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(N.MaxY), Oy), Iy);
+    const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(N.MaxZ), Oz), Iz);
+
+    const __m128 Enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)),
+                                    _mm_max_ps(_mm_min_ps(t0z, t1z), _mm_set1_ps(RD.MinDistance)));
+    const __m128 Exit  = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)),
+                                    _mm_min_ps(_mm_max_ps(t0z, t1z), _mm_set1_ps(MaxDistance)));
+    _mm_storeu_ps(pDistances, Enter);
+    return static_cast<Uint32>(_mm_movemask_ps(_mm_cmple_ps(Enter, Exit)));
+#elif DILIGENT_BVH_NEON
+    const float32x4_t Ox = vdupq_n_f32(RD.Origin.x);
+    const float32x4_t Oy = vdupq_n_f32(RD.Origin.y);
+    const float32x4_t Oz = vdupq_n_f32(RD.Origin.z);
+
+    const float32x4_t t0x = vmulq_n_f32(vsubq_f32(vld1q_f32(N.MinX), Ox), RD.InvDirection.x);
+    const float32x4_t t0y = vmulq_n_f32(vsubq_f32(vld1q_f32(N.MinY), Oy), RD.InvDirection.y);
+    const float32x4_t t0z = vmulq_n_f32(vsubq_f32(vld1q_f32(N.MinZ), Oz), RD.InvDirection.z);
+    const float32x4_t t1x = vmulq_n_f32(vsubq_f32(vld1q_f32(N.MaxX), Ox), RD.InvDirection.x);
+    const float32x4_t t1y = vmulq_n_f32(vsubq_f32(vld1q_f32(N.MaxY), Oy), RD.InvDirection.y);
+    const float32x4_t t1z = vmulq_n_f32(vsubq_f32(vld1q_f32(N.MaxZ), Oz), RD.InvDirection.z);
+
+    const float32x4_t Enter = vmaxq_f32(vmaxq_f32(vminq_f32(t0x, t1x), vminq_f32(t0y, t1y)),
+                                        vmaxq_f32(vminq_f32(t0z, t1z), vdupq_n_f32(RD.MinDistance)));
+    const float32x4_t Exit  = vminq_f32(vminq_f32(vmaxq_f32(t0x, t1x), vmaxq_f32(t0y, t1y)),
+                                        vminq_f32(vmaxq_f32(t0z, t1z), vdupq_n_f32(MaxDistance)));
+    vst1q_f32(pDistances, Enter);
+
+    Uint32 HitMask[4];
+    vst1q_u32(HitMask, vcleq_f32(Enter, Exit));
+    return (HitMask[0] & 1u) | (HitMask[1] & 2u) | (HitMask[2] & 4u) | (HitMask[3] & 8u);
+#else
+    Uint32 Mask = 0;
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        const float t0x = (N.MinX[i] - RD.Origin.x) * RD.InvDirection.x;
+        const float t0y = (N.MinY[i] - RD.Origin.y) * RD.InvDirection.y;
+        const float t0z = (N.MinZ[i] - RD.Origin.z) * RD.InvDirection.z;
+        const float t1x = (N.MaxX[i] - RD.Origin.x) * RD.InvDirection.x;
+        const float t1y = (N.MaxY[i] - RD.Origin.y) * RD.InvDirection.y;
+        const float t1z = (N.MaxZ[i] - RD.Origin.z) * RD.InvDirection.z;
+
+        const float Enter = std::max(std::max(std::min(t0x, t1x), std::min(t0y, t1y)), std::max(std::min(t0z, t1z), RD.MinDistance));
+        const float Exit  = std::min(std::min(std::max(t0x, t1x), std::max(t0y, t1y)), std::min(std::max(t0z, t1z), MaxDistance));
+        pDistances[i]     = Enter;
+        if (Enter <= Exit)
+            Mask |= 1u << i;
+    }
+    return Mask;
+#endif
+}
+
+template <typename LeafHandlerType>
+void BVH::Traverse(const Ray& R, LeafHandlerType&& LeafHandler) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    struct StackEntry
+    {
+        Uint32 Node;
+        float  Distance;
+    };
+    // Every node pushes at most 3 more entries than it pops, and the depth of the 4-wide tree
+    // does not exceed the depth of the binary tree.
+    StackEntry Stack[MaxDepth * 3 + 4];
+    Uint32     StackSize = 0;
+
+    const RayData RD{R};
+
+    float MaxDistance  = R.MaxDistance;
+    Stack[StackSize++] = {0, R.MinDistance};
+    while (StackSize > 0)
+    {
+        const StackEntry Entry = Stack[--StackSize];
+        if (Entry.Distance > MaxDistance)
+            continue;
+
+        const Node& N = m_Nodes[Entry.Node];
+
+        float        Distances[4];
+        const Uint32 HitMask = IntersectNode(RD, N, MaxDistance, Distances);
+
+        StackEntry Children[4];
+        Uint32     NumChildren = 0;
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            if ((HitMask & (1u << i)) == 0 || N.Child[i] == InvalidIndex)
+                continue;
+
+            if (N.Count[i] != 0)
+            {
+                for (Uint32 p = N.Child[i]; p < N.Child[i] + N.Count[i]; ++p)
+                {
+                    if (!LeafHandler(m_PrimitiveIndices[p], MaxDistance))
+                        return;
+                }
+            }
+            else
+            {
+                // Sort the children by the distance in descending order
+                Uint32 j = NumChildren++;
+                for (; j > 0 && Children[j - 1].Distance < Distances[i]; --j)
+                    Children[j] = Children[j - 1];
+                Children[j] = {N.Child[i], Distances[i]};
+            }
+        }
+
+        // Push the nearest child last, so that it is processed first
+        VERIFY(StackSize + NumChildren <= _countof(Stack), "Traversal stack overflow");
+        for (Uint32 i = 0; i < NumChildren; ++i)
+            Stack[StackSize++] = Children[i];
+    }
+}
+
+template <typename CallbackType>
+void BVH::QueryBox(const BoundBox& Box, CallbackType&& Callback) const
+{
+    if (m_Nodes.empty())
+        return;
+
+    Uint32 Stack[MaxDepth * 3 + 4];
+    Uint32 StackSize = 0;
+
+    Stack[StackSize++] = 0;
+    while (StackSize > 0)
+    {
+        const Node& N = m_Nodes[Stack[--StackSize]];
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            if (N.Child[i] == InvalidIndex ||
+                N.MinX[i] > Box.Max.x || N.MaxX[i] < Box.Min.x ||
+                N.MinY[i] > Box.Max.y || N.MaxY[i] < Box.Min.y ||
+                N.MinZ[i] > Box.Max.z || N.MaxZ[i] < Box.Min.z)
+                continue;
+
+            if (N.Count[i] != 0)
+            {
+                for (Uint32 p = N.Child[i]; p < N.Child[i] + N.Count[i]; ++p)
+                {
+                    if (!Callback(m_PrimitiveIndices[p]))
+                        return;
+                }
+            }
+            else
+            {
+                VERIFY(StackSize < _countof(Stack), "Traversal stack overflow");
+                Stack[StackSize++] = N.Child[i];
+            }
+        }
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,354 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// SIMD implementations of the most frequently used float4x4 and float4 operations.
+///
+/// The implementation is selected at compile time:
+/// - AVX2 if the code is compiled with AVX2 support (e.g. -mavx2 or /arch:AVX2)
+/// - SSE2 on all other x86/x64 targets
+/// - NEON on ARM targets
+/// - Scalar code otherwise, or if DILIGENT_DISABLE_SIMD_MATH is defined
+///
+/// The functions produce the same results as the corresponding BasicMath operations,
+/// up to floating-point rounding differences in InverseSIMD().
+
+#include "BasicMath.hpp"
+#include "../../Platforms/interface/Intrinsics.hpp"
+
+#if !defined(DILIGENT_DISABLE_SIMD_MATH)
+#    if DILIGENT_AVX2_ENABLED
+#        define DILIGENT_SIMD_MATH_AVX2 1
+#        define DILIGENT_SIMD_MATH_SSE  1
+#    elif DILIGENT_SSE2_ENABLED
+#        define DILIGENT_SIMD_MATH_SSE 1
+#    elif DILIGENT_NEON_ENABLED
+#        define DILIGENT_SIMD_MATH_NEON 1
+#    endif
+#endif
+
+namespace Diligent
+{
+
+/// Returns the name of the SIMD instruction set used by the functions in this file.
+inline const char* GetSIMDMathImplementationName()
+{
+#if DILIGENT_SIMD_MATH_AVX2
+    return "AVX2";
+#elif DILIGENT_SIMD_MATH_SSE
+    return "SSE2";
+#elif DILIGENT_SIMD_MATH_NEON
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+#if DILIGENT_SIMD_MATH_SSE
+
+namespace SIMDMathInternal
+{
+
+inline __m128 LoadRow(const float4x4& m, int i)
+{
+    return _mm_loadu_ps(m.m[i]);
+}
+
+inline void StoreRow(float4x4& m, int i, __m128 r)
+{
+    _mm_storeu_ps(m.m[i], r);
+}
+
+// Computes v.x * r0 + v.y * r1 + v.z * r2 + v.w * r3
+inline __m128 MulRow(__m128 v, __m128 r0, __m128 r1, __m128 r2, __m128 r3)
+{
+    __m128 res = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+    res        = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+    res        = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+    res        = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+    return res;
+}
+
+// 2x2 matrices are stored in row-major order as (m00, m01, m10, m11)
+
+#    define DILIGENT_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+
+// A * B
+inline __m128 Mat2Mul(__m128 A, __m128 B)
+{
+    return _mm_add_ps(_mm_mul_ps(A, DILIGENT_SWIZZLE(B, 0, 3, 0, 3)),
+                      _mm_mul_ps(DILIGENT_SWIZZLE(A, 1, 0, 3, 2), DILIGENT_SWIZZLE(B, 2, 1, 2, 1)));
+}
+
+// adj(A) * B
+inline __m128 Mat2AdjMul(__m128 A, __m128 B)
+{
+    return _mm_sub_ps(_mm_mul_ps(DILIGENT_SWIZZLE(A, 3, 3, 0, 0), B),
+                      _mm_mul_ps(DILIGENT_SWIZZLE(A, 1, 1, 2, 2), DILIGENT_SWIZZLE(B, 2, 3, 0, 1)));
+}
+
+// A * adj(B)
+inline __m128 Mat2MulAdj(__m128 A, __m128 B)
+{
+    return _mm_sub_ps(_mm_mul_ps(A, DILIGENT_SWIZZLE(B, 3, 0, 3, 0)),
+                      _mm_mul_ps(DILIGENT_SWIZZLE(A, 1, 0, 3, 2), DILIGENT_SWIZZLE(B, 2, 1, 2, 1)));
+}
+
+} // namespace SIMDMathInternal
+
+#elif DILIGENT_SIMD_MATH_NEON
+
+namespace SIMDMathInternal
+{
+
+// Computes v.x * r0 + v.y * r1 + v.z * r2 + v.w * r3
+inline float32x4_t MulRow(float32x4_t v, float32x4_t r0, float32x4_t r1, float32x4_t r2, float32x4_t r3)
+{
+    // NB: use separate multiplications and additions rather than fused multiply-add
+    //     to match the results of the scalar code.
+    float32x4_t res = vmulq_n_f32(r0, vgetq_lane_f32(v, 0));
+    res             = vaddq_f32(res, vmulq_n_f32(r1, vgetq_lane_f32(v, 1)));
+    res             = vaddq_f32(res, vmulq_n_f32(r2, vgetq_lane_f32(v, 2)));
+    res             = vaddq_f32(res, vmulq_n_f32(r3, vgetq_lane_f32(v, 3)));
+    return res;
+}
+
+} // namespace SIMDMathInternal
+
+#endif
+
+/// Computes m1 * m2, same as Matrix4x4<float>::Mul().
+inline float4x4 MulSIMD(const float4x4& m1, const float4x4& m2)
+{
+#if DILIGENT_SIMD_MATH_AVX2
+    // Process two rows of m1 at a time
+    const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+    const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+    const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+    const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+
+    float4x4 mOut;
+    for (int i = 0; i < 4; i += 2)
+    {
+        const __m256 a   = _mm256_loadu_ps(m1.m[i]);
+        __m256       res = _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+        res              = _mm256_add_ps(res, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), r1));
+        res              = _mm256_add_ps(res, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), r2));
+        res              = _mm256_add_ps(res, _mm256_mul_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), r3));
+        _mm256_storeu_ps(mOut.m[i], res);
+    }
+    return mOut;
+#elif DILIGENT_SIMD_MATH_SSE
+    using namespace SIMDMathInternal;
+
+    const __m128 r0 = LoadRow(m2, 0);
+    const __m128 r1 = LoadRow(m2, 1);
+    const __m128 r2 = LoadRow(m2, 2);
+    const __m128 r3 = LoadRow(m2, 3);
+
+    float4x4 mOut;
+    for (int i = 0; i < 4; ++i)
+        StoreRow(mOut, i, MulRow(LoadRow(m1, i), r0, r1, r2, r3));
+    return mOut;
+#elif DILIGENT_SIMD_MATH_NEON
+    const float32x4_t r0 = vld1q_f32(m2.m[0]);
+    const float32x4_t r1 = vld1q_f32(m2.m[1]);
+    const float32x4_t r2 = vld1q_f32(m2.m[2]);
+    const float32x4_t r3 = vld1q_f32(m2.m[3]);
+
+    float4x4 mOut;
+    for (int i = 0; i < 4; ++i)
+        vst1q_f32(mOut.m[i], SIMDMathInternal::MulRow(vld1q_f32(m1.m[i]), r0, r1, r2, r3));
+    return mOut;
+#else
+    return float4x4::Mul(m1, m2);
+#endif
+}
+
+/// Computes v * m, same as float4::operator*(const float4x4&).
+inline float4 MulSIMD(const float4& v, const float4x4& m)
+{
+#if DILIGENT_SIMD_MATH_SSE
+    using namespace SIMDMathInternal;
+
+    float4 out;
+    _mm_storeu_ps(&out.x, MulRow(_mm_loadu_ps(&v.x), LoadRow(m, 0), LoadRow(m, 1), LoadRow(m, 2), LoadRow(m, 3)));
+    return out;
+#elif DILIGENT_SIMD_MATH_NEON
+    float4 out;
+    vst1q_f32(&out.x, SIMDMathInternal::MulRow(vld1q_f32(&v.x), vld1q_f32(m.m[0]), vld1q_f32(m.m[1]), vld1q_f32(m.m[2]), vld1q_f32(m.m[3])));
+    return out;
+#else
+    return v * m;
+#endif
+}
+
+/// Transforms Count vectors by the matrix: pDst[i] = pSrc[i] * m.
+/// In-place transformation (pDst == pSrc) is allowed.
+inline void TransformVectorsSIMD(const float4* pSrc, size_t Count, const float4x4& m, float4* pDst)
+{
+#if DILIGENT_SIMD_MATH_SSE
+    using namespace SIMDMathInternal;
+
+    const __m128 r0 = LoadRow(m, 0);
+    const __m128 r1 = LoadRow(m, 1);
+    const __m128 r2 = LoadRow(m, 2);
+    const __m128 r3 = LoadRow(m, 3);
+    for (size_t i = 0; i < Count; ++i)
+        _mm_storeu_ps(&pDst[i].x, MulRow(_mm_loadu_ps(&pSrc[i].x), r0, r1, r2, r3));
+#elif DILIGENT_SIMD_MATH_NEON
+    const float32x4_t r0 = vld1q_f32(m.m[0]);
+    const float32x4_t r1 = vld1q_f32(m.m[1]);
+    const float32x4_t r2 = vld1q_f32(m.m[2]);
+    const float32x4_t r3 = vld1q_f32(m.m[3]);
+    for (size_t i = 0; i < Count; ++i)
+        vst1q_f32(&pDst[i].x, SIMDMathInternal::MulRow(vld1q_f32(&pSrc[i].x), r0, r1, r2, r3));
+#else
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = pSrc[i] * m;
+#endif
+}
+
+/// Multiplies Count matrices by the matrix: pDst[i] = pSrc[i] * m.
+/// This is typically used to combine instance world matrices with the view-projection matrix.
+/// In-place multiplication (pDst == pSrc) is allowed.
+inline void MulMatricesSIMD(const float4x4* pSrc, size_t Count, const float4x4& m, float4x4* pDst)
+{
+    for (size_t i = 0; i < Count; ++i)
+        pDst[i] = MulSIMD(pSrc[i], m);
+}
+
+/// Computes the transpose of the matrix, same as Matrix4x4<float>::Transpose().
+inline float4x4 TransposeSIMD(const float4x4& m)
+{
+#if DILIGENT_SIMD_MATH_SSE
+    using namespace SIMDMathInternal;
+
+    __m128 r0 = LoadRow(m, 0);
+    __m128 r1 = LoadRow(m, 1);
+    __m128 r2 = LoadRow(m, 2);
+    __m128 r3 = LoadRow(m, 3);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    float4x4 mOut;
+    StoreRow(mOut, 0, r0);
+    StoreRow(mOut, 1, r1);
+    StoreRow(mOut, 2, r2);
+    StoreRow(mOut, 3, r3);
+    return mOut;
+#elif DILIGENT_SIMD_MATH_NEON
+    // De-interleaving load returns the matrix columns
+    const float32x4x4_t Cols = vld4q_f32(m.Data());
+
+    float4x4 mOut;
+    vst1q_f32(mOut.m[0], Cols.val[0]);
+    vst1q_f32(mOut.m[1], Cols.val[1]);
+    vst1q_f32(mOut.m[2], Cols.val[2]);
+    vst1q_f32(mOut.m[3], Cols.val[3]);
+    return mOut;
+#else
+    return m.Transpose();
+#endif
+}
+
+/// Computes the inverse of the matrix, same as Matrix4x4<float>::Inverse().
+inline float4x4 InverseSIMD(const float4x4& m)
+{
+#if DILIGENT_SIMD_MATH_SSE
+    // The matrix is partitioned into 2x2 blocks
+    //
+    //      | A  B |
+    //  M = |      |
+    //      | C  D |
+    //
+    // and the inverse is computed using the block-wise formula with adjugates of 2x2 matrices.
+    using namespace SIMDMathInternal;
+
+    const __m128 r0 = LoadRow(m, 0);
+    const __m128 r1 = LoadRow(m, 1);
+    const __m128 r2 = LoadRow(m, 2);
+    const __m128 r3 = LoadRow(m, 3);
+
+    const __m128 A = _mm_movelh_ps(r0, r1);
+    const __m128 B = _mm_movehl_ps(r1, r0);
+    const __m128 C = _mm_movelh_ps(r2, r3);
+    const __m128 D = _mm_movehl_ps(r3, r2);
+
+    // Determinants of the blocks: (|A|, |B|, |C|, |D|)
+    const __m128 DetSub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+    const __m128 DetA = DILIGENT_SWIZZLE(DetSub, 0, 0, 0, 0);
+    const __m128 DetB = DILIGENT_SWIZZLE(DetSub, 1, 1, 1, 1);
+    const __m128 DetC = DILIGENT_SWIZZLE(DetSub, 2, 2, 2, 2);
+    const __m128 DetD = DILIGENT_SWIZZLE(DetSub, 3, 3, 3, 3);
+
+    const __m128 D_C = Mat2AdjMul(D, C);
+    const __m128 A_B = Mat2AdjMul(A, B);
+
+    __m128 X = _mm_sub_ps(_mm_mul_ps(DetD, A), Mat2Mul(B, D_C));
+    __m128 W = _mm_sub_ps(_mm_mul_ps(DetA, D), Mat2Mul(C, A_B));
+    __m128 Y = _mm_sub_ps(_mm_mul_ps(DetB, C), Mat2MulAdj(D, A_B));
+    __m128 Z = _mm_sub_ps(_mm_mul_ps(DetC, B), Mat2MulAdj(A, D_C));
+
+    // |M| = |A|*|D| + |B|*|C| - tr(adj(A)B * adj(D)C)
+    __m128 Tr = _mm_mul_ps(A_B, DILIGENT_SWIZZLE(D_C, 0, 2, 1, 3));
+    Tr        = _mm_add_ps(Tr, _mm_movehl_ps(Tr, Tr));
+    Tr        = _mm_add_ps(Tr, DILIGENT_SWIZZLE(Tr, 1, 1, 1, 1));
+    Tr        = DILIGENT_SWIZZLE(Tr, 0, 0, 0, 0);
+
+    const __m128 DetM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(DetA, DetD), _mm_mul_ps(DetB, DetC)), Tr);
+
+    // (1/|M|, -1/|M|, -1/|M|, 1/|M|)
+    const __m128 RcpDetM = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), DetM);
+
+    X = _mm_mul_ps(X, RcpDetM);
+    Y = _mm_mul_ps(Y, RcpDetM);
+    Z = _mm_mul_ps(Z, RcpDetM);
+    W = _mm_mul_ps(W, RcpDetM);
+
+    // Apply the adjugate and store the rows
+    float4x4 mOut;
+    StoreRow(mOut, 0, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+    StoreRow(mOut, 1, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+    StoreRow(mOut, 2, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+    StoreRow(mOut, 3, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+    return mOut;
+#else
+    // NB: NEON lacks the cheap arbitrary shuffles the block-wise algorithm relies on,
+    //     so the scalar implementation is used.
+    return m.Inverse();
+#endif
+}
+
+#if DILIGENT_SIMD_MATH_SSE
+#    undef DILIGENT_SWIZZLE
+#endif
+
+} // namespace Diligent
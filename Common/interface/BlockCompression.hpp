@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// LZ4 block compression with an optional dictionary
+
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Returns the maximum size of the compressed data for the source of the given size.
+size_t GetLZ4CompressBound(size_t SrcSize);
+
+/// Compresses the data using the LZ4 block format.
+
+/// \param [in]  pSrc        - Source data.
+/// \param [in]  SrcSize     - Source data size.
+/// \param [out] pDst        - Destination buffer.
+/// \param [in]  DstCapacity - Destination buffer size. GetLZ4CompressBound(SrcSize) bytes
+///                            are always enough.
+/// \param [in]  pDict       - Optional dictionary. Matches may reference the last 64 KB of the dictionary
+///                            as if it immediately preceded the source data.
+/// \param [in]  DictSize    - Dictionary size.
+///
+/// \return     The compressed data size, or 0 if the data does not fit into the destination buffer.
+///
+/// \remarks    The output follows the LZ4 block format specification.
+size_t CompressLZ4Block(const void* pSrc,
+                        size_t      SrcSize,
+                        void*       pDst,
+                        size_t      DstCapacity,
+                        const void* pDict    = nullptr,
+                        size_t      DictSize = 0);
+
+/// Decompresses the data compressed by CompressLZ4Block().
+
+/// \param [in]  pSrc     - Compressed data.
+/// \param [in]  SrcSize  - Compressed data size.
+/// \param [out] pDst     - Destination buffer.
+/// \param [in]  DstSize  - The exact size of the decompressed data.
+/// \param [in]  pDict    - The dictionary that was used to compress the data.
+/// \param [in]  DictSize - Dictionary size.
+///
+/// \return     true if the data has been decompressed successfully, and false if
+///             the input is malformed or does not decompress to exactly DstSize bytes.
+///
+/// \remarks    The function never reads or writes outside of the provided buffers.
+bool DecompressLZ4Block(const void* pSrc,
+                        size_t      SrcSize,
+                        void*       pDst,
+                        size_t      DstSize,
+                        const void* pDict    = nullptr,
+                        size_t      DictSize = 0);
+
+/// Compression dictionary training sample.
+struct CompressionSample
+{
+    const void* pData = nullptr;
+    size_t      Size  = 0;
+};
+
+/// Builds a compression dictionary from the samples.
+
+/// The dictionary is made of the byte sequences that occur in the largest number
+/// of samples, with the most common sequences placed at the end of the dictionary
+/// where they are the cheapest to reference.
+///
+/// \param [in] Samples     - Training samples, e.g. the bytecode of all shaders.
+/// \param [in] MaxDictSize - The maximum dictionary size. LZ4 can only reference
+///                           the last 64 KB of the dictionary.
+///
+/// \return     The dictionary, which is empty if the samples have no common sequences.
+std::vector<Uint8> TrainCompressionDictionary(const std::vector<CompressionSample>& Samples, size_t MaxDictSize);
+
+} // namespace Diligent
@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::BorrowedPtr class
+
+#include <type_traits>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Non-owning pointer to a reference-counted object.
+
+/// Copying a RefCntAutoPtr atomically increments and decrements the reference counter,
+/// which is expensive when the same object (e.g. a pipeline state or a texture shared by many
+/// draw calls) is used by multiple threads. BorrowedPtr is intended for engine code where
+/// the lifetime of the object is already guaranteed by another owner for the duration of
+/// the borrow, for example by the caller or by the release queue that keeps resources
+/// alive until the GPU has finished using them. It does not touch the reference counters.
+///
+/// In development builds, the pointer additionally keeps a weak reference to the object
+/// and verifies on every access that the object is still alive.
+///
+/// Use Lock() to obtain a strong reference when the object must be kept.
+template <typename T>
+class BorrowedPtr
+{
+public:
+    BorrowedPtr() noexcept {}
+
+    BorrowedPtr(T* pObj) noexcept :
+        m_pObject{pObj}
+#ifdef DILIGENT_DEVELOPMENT
+        ,
+        m_DvpWeakRef{pObj}
+#endif
+    {
+    }
+
+    template <typename DerivedType, typename = typename std::enable_if<std::is_convertible<DerivedType*, T*>::value>::type>
+    BorrowedPtr(const RefCntAutoPtr<DerivedType>& AutoPtr) noexcept :
+        BorrowedPtr{AutoPtr.RawPtr()}
+    {
+    }
+
+    BorrowedPtr& operator=(T* pObj) noexcept
+    {
+        m_pObject = pObj;
+#ifdef DILIGENT_DEVELOPMENT
+        m_DvpWeakRef = pObj;
+#endif
+        return *this;
+    }
+
+    void Reset() noexcept
+    {
+        *this = nullptr;
+    }
+
+    T* RawPtr() const noexcept
+    {
+        DvpVerifyAlive();
+        return m_pObject;
+    }
+
+    T* operator->() const noexcept
+    {
+        VERIFY_EXPR(m_pObject != nullptr);
+        return RawPtr();
+    }
+
+    T& operator*() const noexcept
+    {
+        VERIFY_EXPR(m_pObject != nullptr);
+        return *RawPtr();
+    }
+
+    operator T*() const noexcept { return RawPtr(); }
+
+    explicit operator bool() const noexcept { return m_pObject != nullptr; }
+
+    /// Obtains a strong reference to the object.
+    RefCntAutoPtr<T> Lock() const noexcept
+    {
+        return RefCntAutoPtr<T>{RawPtr()};
+    }
+
+    bool operator==(const BorrowedPtr& Ptr) const noexcept { return m_pObject == Ptr.m_pObject; }
+    bool operator!=(const BorrowedPtr& Ptr) const noexcept { return m_pObject != Ptr.m_pObject; }
+
+private:
+    void DvpVerifyAlive() const noexcept
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        DEV_CHECK_ERR(m_pObject == nullptr || m_DvpWeakRef.IsValid(),
+                      "The borrowed object has been destroyed. The owner must keep the object alive while it is borrowed.");
+#endif
+    }
+
+    T* m_pObject = nullptr;
+
+#ifdef DILIGENT_DEVELOPMENT
+    RefCntWeakPtr<T> m_DvpWeakRef;
+#endif
+};
+
+} // namespace Diligent
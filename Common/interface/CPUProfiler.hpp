@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Lightweight hierarchical CPU profiler
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+/// When the macro is 0 (default), DILIGENT_CPU_PROFILE_SCOPE() compiles to nothing.
+/// The macro is set by the DILIGENT_ENABLE_CPU_PROFILER CMake option.
+#ifndef DILIGENT_CPU_PROFILER_ENABLED
+#    define DILIGENT_CPU_PROFILER_ENABLED 0
+#endif
+
+namespace Diligent
+{
+
+/// Statistics of all profiling scopes with the same name
+struct CPUProfileScopeStats
+{
+    std::string Name;
+
+    /// The number of times the scope was entered.
+    Uint32 Count = 0;
+
+    /// The total time spent in the scope, in seconds.
+    double TotalTime = 0;
+
+    /// The maximum time spent in a single instance of the scope, in seconds.
+    double MaxTime = 0;
+};
+
+/// Hierarchical CPU profiler.
+
+/// Profiling scopes (see CPUProfileScope and DILIGENT_CPU_PROFILE_SCOPE) are recorded into
+/// per-thread ring buffers without any locks. EndFrame() collects the events from all threads
+/// and aggregates them into per-frame statistics. Between BeginCapture() and EndCapture(), the
+/// events are also accumulated and written out in the Chrome trace event format that can be
+/// opened in chrome://tracing or https://ui.perfetto.dev.
+///
+/// \remarks    Scope names must be string literals or otherwise outlive the profiler.
+///             Dynamic names must be interned with InternName().
+class CPUProfiler
+{
+public:
+    /// Enables or disables recording at run time. Recording is enabled by default.
+    static void SetEnabled(bool Enabled);
+
+    static bool IsEnabled()
+    {
+        return sm_Enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the current time in nanoseconds.
+    static Uint64 GetTimestamp();
+
+    /// Sets the name of the current thread that is shown in the trace.
+    /// The name is copied.
+    static void SetThreadName(const char* Name);
+
+    /// Returns a pointer to the persistent copy of the name.
+    static const char* InternName(const char* Name);
+
+    /// Records a scope that started at StartTime and ended at EndTime.
+    static void RecordScope(const char* Name, Uint64 StartTime, Uint64 EndTime, Uint32 Depth);
+
+    /// Collects the events recorded by all threads since the previous call and aggregates them
+    /// into the frame statistics that are returned by GetFrameStats().
+    static void EndFrame();
+
+    /// Returns the statistics of the last completed frame, sorted by the total time.
+    static std::vector<CPUProfileScopeStats> GetFrameStats();
+
+    /// Returns the total number of events that were lost because a thread buffer overflowed.
+    static Uint64 GetNumDroppedEvents();
+
+    /// Starts accumulating the events for the trace.
+    static void BeginCapture();
+
+    static bool IsCapturing();
+
+    /// Stops the capture and returns the trace in Chrome trace event JSON format.
+    static std::string EndCapture();
+
+private:
+    friend class CPUProfileScope;
+
+    static Uint32 EnterScope();
+    static void   LeaveScope();
+
+    static std::atomic<bool> sm_Enabled;
+};
+
+/// RAII profiling scope
+class CPUProfileScope
+{
+public:
+    CPUProfileScope() noexcept {}
+
+    explicit CPUProfileScope(const char* Name) noexcept
+    {
+        if (Name != nullptr && CPUProfiler::IsEnabled())
+        {
+            m_Name      = Name;
+            m_Depth     = CPUProfiler::EnterScope();
+            m_StartTime = CPUProfiler::GetTimestamp();
+        }
+    }
+
+    ~CPUProfileScope()
+    {
+        End();
+    }
+
+    // clang-format off
+    CPUProfileScope           (const CPUProfileScope&) = delete;
+    CPUProfileScope& operator=(const CPUProfileScope&) = delete;
+    // clang-format on
+
+    CPUProfileScope(CPUProfileScope&& rhs) noexcept :
+        m_Name{rhs.m_Name},
+        m_StartTime{rhs.m_StartTime},
+        m_Depth{rhs.m_Depth}
+    {
+        rhs.m_Name = nullptr;
+    }
+
+    CPUProfileScope& operator=(CPUProfileScope&& rhs) noexcept
+    {
+        End();
+        m_Name      = rhs.m_Name;
+        m_StartTime = rhs.m_StartTime;
+        m_Depth     = rhs.m_Depth;
+        rhs.m_Name  = nullptr;
+        return *this;
+    }
+
+    /// Ends the scope before the object is destroyed.
+    void End()
+    {
+        if (m_Name != nullptr)
+        {
+            CPUProfiler::RecordScope(m_Name, m_StartTime, CPUProfiler::GetTimestamp(), m_Depth);
+            CPUProfiler::LeaveScope();
+            m_Name = nullptr;
+        }
+    }
+
+private:
+    const char* m_Name      = nullptr;
+    Uint64      m_StartTime = 0;
+    Uint32      m_Depth     = 0;
+};
+
+} // namespace Diligent
+
+#define DILIGENT_CPU_PROFILE_CONCATENATE0(X, Y) X##Y
+#define DILIGENT_CPU_PROFILE_CONCATENATE(X, Y)  DILIGENT_CPU_PROFILE_CONCATENATE0(X, Y)
+
+#if DILIGENT_CPU_PROFILER_ENABLED
+/// Profiles the enclosing scope. Name must be a string literal.
+#    define DILIGENT_CPU_PROFILE_SCOPE(Name) ::Diligent::CPUProfileScope DILIGENT_CPU_PROFILE_CONCATENATE(_CPUProfileScope, __LINE__){Name}
+#else
+#    define DILIGENT_CPU_PROFILE_SCOPE(Name)
+#endif
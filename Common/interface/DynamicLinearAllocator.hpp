@@ -32,6 +32,7 @@
 
 #include <vector>
 #include <cstring>
+#include <algorithm>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
@@ -72,16 +73,67 @@ public:
             m_pAllocator->Free(block.Data);
         }
         m_Blocks.clear();
+        m_CurrBlock    = 0;
+        m_UsedSize     = 0;
+        m_ReservedSize = 0;
 
         m_pAllocator = nullptr;
     }
 
+    /// Discards all allocations, but keeps the memory blocks so that they can be reused.
     void Discard()
     {
         for (auto& block : m_Blocks)
         {
             block.CurrPtr = block.Data;
         }
+        m_CurrBlock = 0;
+        m_UsedSize  = 0;
+    }
+
+    /// Allocator state that can be restored with Rewind()
+    struct Marker
+    {
+        size_t BlockIdx = 0;
+        size_t Offset   = 0;
+        size_t UsedSize = 0;
+    };
+
+    /// Returns the marker that identifies the current allocator state.
+    Marker GetMarker() const
+    {
+        Marker M;
+        M.BlockIdx = m_CurrBlock;
+        M.Offset   = m_CurrBlock < m_Blocks.size() ? static_cast<size_t>(m_Blocks[m_CurrBlock].CurrPtr - m_Blocks[m_CurrBlock].Data) : 0;
+        M.UsedSize = m_UsedSize;
+        return M;
+    }
+
+    /// Releases all allocations made after the marker was obtained.
+    /// The memory blocks are kept and will be reused by subsequent allocations.
+    ///
+    /// \remarks    Markers must be rewound in the reverse order they were obtained.
+    ///             Rewinding to a marker invalidates all markers obtained after it.
+    void Rewind(const Marker& M)
+    {
+        if (M.BlockIdx >= m_Blocks.size())
+        {
+            // No blocks were allocated when the marker was obtained
+            VERIFY(M.BlockIdx == 0 && M.Offset == 0 && M.UsedSize == 0, "Invalid marker");
+            Discard();
+            return;
+        }
+
+        VERIFY(M.BlockIdx <= m_CurrBlock, "The marker has been invalidated by rewinding to an earlier marker");
+        VERIFY(M.UsedSize <= m_UsedSize, "The marker has been invalidated by rewinding to an earlier marker");
+        for (size_t i = M.BlockIdx + 1; i <= m_CurrBlock; ++i)
+            m_Blocks[i].CurrPtr = m_Blocks[i].Data;
+
+        auto& block = m_Blocks[M.BlockIdx];
+        VERIFY(block.Data + M.Offset <= block.CurrPtr, "The marker has been invalidated by rewinding to an earlier marker");
+        block.CurrPtr = block.Data + M.Offset;
+        m_CurrBlock   = M.BlockIdx;
+        m_UsedSize    = M.UsedSize;
     }
 
     NODISCARD void* Allocate(size_t size, size_t align)
@@ -89,14 +141,19 @@ public:
         if (size == 0)
             return nullptr;
 
-        for (auto& block : m_Blocks)
+        // NB: blocks are filled in order, so that all blocks past the current one are always empty.
+        //     This is what makes Rewind() possible.
+        for (; m_CurrBlock < m_Blocks.size(); ++m_CurrBlock)
         {
-            auto* Ptr = AlignUp(block.CurrPtr, align);
+            auto& block = m_Blocks[m_CurrBlock];
+            auto* Ptr   = AlignUp(block.CurrPtr, align);
             if (Ptr + size <= block.Data + block.Size)
             {
-                block.CurrPtr = Ptr + size;
+                OnAllocated(block, Ptr + size);
                 return Ptr;
             }
+            if (m_CurrBlock + 1 == m_Blocks.size())
+                break;
         }
 
         // Create a new block
@@ -104,11 +161,13 @@ public:
         while (BlockSize < size + align - 1)
             BlockSize *= 2;
         m_Blocks.emplace_back(m_pAllocator->Allocate(BlockSize, "dynamic linear allocator page", __FILE__, __LINE__), BlockSize);
+        m_ReservedSize += BlockSize;
 
+        m_CurrBlock = m_Blocks.size() - 1;
         auto& block = m_Blocks.back();
         auto* Ptr   = AlignUp(block.Data, align);
         VERIFY(Ptr + size <= block.Data + block.Size, "Not enough space in the new block - this is a bug");
-        block.CurrPtr = Ptr + size;
+        OnAllocated(block, Ptr + size);
         return Ptr;
     }
 
@@ -198,6 +257,33 @@ public:
         return m_Blocks.size();
     }
 
+    /// Returns the number of bytes currently allocated, including the alignment padding.
+    size_t GetUsedSize() const
+    {
+        return m_UsedSize;
+    }
+
+    /// Returns the total size of all memory blocks.
+    size_t GetReservedSize() const
+    {
+        return m_ReservedSize;
+    }
+
+    /// Returns the maximum number of bytes that were allocated at the same time since
+    /// the allocator was created or since the last call to ResetPeakUsedSize().
+    ///
+    /// \remarks    This value can be used to choose the initial block size that avoids
+    ///             allocating additional blocks.
+    size_t GetPeakUsedSize() const
+    {
+        return m_PeakUsedSize;
+    }
+
+    void ResetPeakUsedSize()
+    {
+        m_PeakUsedSize = m_UsedSize;
+    }
+
     template <typename HandlerType>
     void ProcessBlocks(HandlerType&& Handler) const
     {
@@ -216,9 +302,21 @@ private:
             Data{static_cast<uint8_t*>(_Data)}, Size{_Size}, CurrPtr{Data} {}
     };
 
+    void OnAllocated(Block& block, uint8_t* NewCurrPtr)
+    {
+        m_UsedSize += static_cast<size_t>(NewCurrPtr - block.CurrPtr);
+        m_PeakUsedSize = (std::max)(m_PeakUsedSize, m_UsedSize);
+        block.CurrPtr  = NewCurrPtr;
+    }
+
     std::vector<Block> m_Blocks;
-    const Uint32       m_BlockSize  = 4 << 10;
-    IMemoryAllocator*  m_pAllocator = nullptr;
+    // Index of the block that is currently being filled. All blocks past it are empty.
+    size_t            m_CurrBlock    = 0;
+    size_t            m_UsedSize     = 0;
+    size_t            m_PeakUsedSize = 0;
+    size_t            m_ReservedSize = 0;
+    const Uint32      m_BlockSize    = 4 << 10;
+    IMemoryAllocator* m_pAllocator   = nullptr;
 };
 
 } // namespace Diligent
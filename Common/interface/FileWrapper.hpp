@@ -92,6 +92,12 @@ public:
 
     static bool ReadWholeFile(const char* FilePath, std::vector<Uint8>& Data, bool Silent = false);
     static bool ReadWholeFile(const char* FilePath, IDataBlob** ppData, bool Silent = false);
+
+    /// Maps the file into memory, see MappedFileDataBlob. The file pages are only loaded when
+    /// they are accessed, so this is the preferred way to open large files that are used in place
+    /// (e.g. device object archives loaded with MakeCopy = false).
+    /// If memory-mapped files are not supported by the platform, reads the whole file.
+    static bool MapWholeFile(const char* FilePath, IDataBlob** ppData, bool Silent = false);
     static bool WriteFile(const char* FilePath, const void* Data, size_t Size, bool Silent = false);
 
 private:
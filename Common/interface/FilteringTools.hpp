@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "../../Platforms/interface/PlatformDefinitions.h"
 
 #include "BasicMath.hpp"
@@ -245,4 +247,168 @@ DstType FilterTexture2DBilinearClampUC(Uint32         Width,
     return FilterTexture2DBilinear<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, false>(Width, Height, pData, Stride, u, v);
 }
 
+/// Samples 2D texture at multiple locations using bilinear filter.
+///
+/// \tparam SrcType           - Source pixel type.
+/// \tparam DstType           - Destination type.
+/// \tparam AddressModeU      - U coordinate address mode.
+/// \tparam AddressModeV      - V coordinate address mode.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width        - Texture width.
+/// \param [in]  Height       - Texture height.
+/// \param [in]  pData        - Pointer to the texture data.
+/// \param [in]  Stride       - Data stride, in pixels.
+/// \param [in]  pUV          - Array of NumSamples sample coordinates.
+/// \param [in]  NumSamples   - The number of samples.
+/// \param [out] pDst         - Array of NumSamples values that receives the filtered samples.
+///
+/// \remarks   The function produces the same results as FilterTexture2DBilinear called for each sample.
+///           The specializations for float data and CLAMP address mode are vectorized,
+///           see FilterTexture2DBilinearBatchImplementationName().
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV,
+          bool                 IsNormalizedCoord>
+void FilterTexture2DBilinearBatch(Uint32         Width,
+                                  Uint32         Height,
+                                  const SrcType* pData,
+                                  size_t         Stride,
+                                  const float2*  pUV,
+                                  size_t         NumSamples,
+                                  DstType*       pDst)
+{
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        pDst[i] = FilterTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV, IsNormalizedCoord>(Width, Height, pData, Stride, pUV[i].x, pUV[i].y);
+    }
+}
+
+// clang-format off
+template <>
+void FilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, true>(Uint32        Width,
+                                                                                                   Uint32        Height,
+                                                                                                   const float*  pData,
+                                                                                                   size_t        Stride,
+                                                                                                   const float2* pUV,
+                                                                                                   size_t        NumSamples,
+                                                                                                   float*        pDst);
+template <>
+void FilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, false>(Uint32        Width,
+                                                                                                    Uint32        Height,
+                                                                                                    const float*  pData,
+                                                                                                    size_t        Stride,
+                                                                                                    const float2* pUV,
+                                                                                                    size_t        NumSamples,
+                                                                                                    float*        pDst);
+// clang-format on
+
+/// Returns the name of the instruction set used by the vectorized FilterTexture2DBilinearBatch specializations
+/// (e.g. "AVX2", "SSE2", "NEON" or "Scalar").
+const char* FilterTexture2DBilinearBatchImplementationName();
+
+/// Specialization of FilterTexture2DBilinearBatch function that uses CLAMP texture address mode
+/// and takes normalized texture coordinates.
+template <typename SrcType, typename DstType>
+void FilterTexture2DBilinearClampBatch(Uint32         Width,
+                                       Uint32         Height,
+                                       const SrcType* pData,
+                                       size_t         Stride,
+                                       const float2*  pUV,
+                                       size_t         NumSamples,
+                                       DstType*       pDst)
+{
+    FilterTexture2DBilinearBatch<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, true>(Width, Height, pData, Stride, pUV, NumSamples, pDst);
+}
+
+/// Specialization of FilterTexture2DBilinearBatch function that uses CLAMP texture address mode
+/// and takes unnormalized texture coordinates.
+template <typename SrcType, typename DstType>
+void FilterTexture2DBilinearClampUCBatch(Uint32         Width,
+                                         Uint32         Height,
+                                         const SrcType* pData,
+                                         size_t         Stride,
+                                         const float2*  pUV,
+                                         size_t         NumSamples,
+                                         DstType*       pDst)
+{
+    FilterTexture2DBilinearBatch<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, false>(Width, Height, pData, Stride, pUV, NumSamples, pDst);
+}
+
+
+/// Resamples 2D texture on a regular grid using bilinear filter.
+///
+/// \tparam SrcType           - Source pixel type.
+/// \tparam DstType           - Destination type.
+/// \tparam AddressModeU      - U coordinate address mode.
+/// \tparam AddressModeV      - V coordinate address mode.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  SrcWidth     - Source texture width.
+/// \param [in]  SrcHeight    - Source texture height.
+/// \param [in]  pSrcData     - Pointer to the source texture data.
+/// \param [in]  SrcStride    - Source data stride, in pixels.
+/// \param [in]  StartUV      - Sample coordinates of the first destination pixel.
+/// \param [in]  StepUV       - Sample coordinate increment between adjacent destination pixels.
+/// \param [in]  DstWidth     - Destination width.
+/// \param [in]  DstHeight    - Destination height.
+/// \param [out] pDstData     - Pointer to the destination data.
+/// \param [in]  DstStride    - Destination data stride, in pixels.
+///
+/// \remarks   Destination pixel (x, y) receives the value of FilterTexture2DBilinear sampled at
+///           (StartUV.x + StepUV.x * x, StartUV.y + StepUV.y * y).
+///           Horizontal filter info is computed once for all rows and vertical filter info once per row.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV,
+          bool                 IsNormalizedCoord>
+void ResampleTexture2DBilinear(Uint32         SrcWidth,
+                               Uint32         SrcHeight,
+                               const SrcType* pSrcData,
+                               size_t         SrcStride,
+                               const float2&  StartUV,
+                               const float2&  StepUV,
+                               Uint32         DstWidth,
+                               Uint32         DstHeight,
+                               DstType*       pDstData,
+                               size_t         DstStride)
+{
+    std::vector<LinearTexFilterSampleInfo> UFilterInfos(DstWidth);
+    for (Uint32 x = 0; x < DstWidth; ++x)
+    {
+        const float u = StartUV.x + StepUV.x * static_cast<float>(x);
+
+        UFilterInfos[x] = GetLinearTexFilterSampleInfo<AddressModeU, IsNormalizedCoord>(SrcWidth, u);
+#ifdef DILIGENT_DEBUG
+        _DbgVerifyFilterInfo<AddressModeU>(UFilterInfos[x], SrcWidth, "horizontal", u);
+#endif
+    }
+
+    for (Uint32 y = 0; y < DstHeight; ++y)
+    {
+        const float v = StartUV.y + StepUV.y * static_cast<float>(y);
+
+        const auto VFilterInfo = GetLinearTexFilterSampleInfo<AddressModeV, IsNormalizedCoord>(SrcHeight, v);
+#ifdef DILIGENT_DEBUG
+        _DbgVerifyFilterInfo<AddressModeV>(VFilterInfo, SrcHeight, "vertical", v);
+#endif
+
+        const SrcType* pSrcRow0 = pSrcData + VFilterInfo.i0 * SrcStride;
+        const SrcType* pSrcRow1 = pSrcData + VFilterInfo.i1 * SrcStride;
+        DstType*       pDstRow  = pDstData + y * DstStride;
+        for (Uint32 x = 0; x < DstWidth; ++x)
+        {
+            const auto& UFilterInfo = UFilterInfos[x];
+
+            auto S00 = static_cast<DstType>(pSrcRow0[UFilterInfo.i0]);
+            auto S10 = static_cast<DstType>(pSrcRow0[UFilterInfo.i1]);
+            auto S01 = static_cast<DstType>(pSrcRow1[UFilterInfo.i0]);
+            auto S11 = static_cast<DstType>(pSrcRow1[UFilterInfo.i1]);
+            pDstRow[x] = lerp(lerp(S00, S10, UFilterInfo.w), lerp(S01, S11, UFilterInfo.w), VFilterInfo.w);
+        }
+    }
+}
+
 } // namespace Diligent
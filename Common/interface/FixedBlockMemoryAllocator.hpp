@@ -47,7 +47,18 @@ namespace Diligent
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    /// \param [in] RawMemoryAllocator - Allocator that is used to allocate memory pages.
+    /// \param [in] BlockSize          - Block size.
+    /// \param [in] NumBlocksInPage    - The number of blocks in one memory page.
+    /// \param [in] ThreadCacheSize    - The maximum number of blocks kept in a thread-local cache.
+    ///                                  If zero, thread-local caches are disabled.
+    ///
+    /// \remarks    When thread-local caches are enabled, every thread that uses the allocator
+    ///             keeps a small cache (also known as a magazine) of free blocks. Allocate() and Free()
+    ///             take blocks from and return them to the cache without locking the allocator mutex.
+    ///             The mutex is only locked when the cache is empty and needs to be refilled, or
+    ///             when the cache is full and half of its blocks are returned to the memory pages.
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage, Uint32 ThreadCacheSize = 0);
     ~FixedBlockMemoryAllocator();
 
     /// Allocates block of memory
@@ -62,6 +73,26 @@ public:
     /// Releases memory allocated with AllocateAligned
     virtual void FreeAligned(void* Ptr) override final;
 
+    /// Thread-local cache statistics
+    struct ThreadCacheStats
+    {
+        /// The total number of allocations made through the thread-local caches.
+        Uint64 NumAllocations = 0;
+
+        /// The number of allocations that were served by the thread-local caches
+        /// without locking the allocator mutex.
+        Uint64 NumCacheHits = 0;
+
+        /// The number of times the caches were refilled from the memory pages.
+        Uint64 NumRefills = 0;
+
+        /// The number of times the blocks were returned from the caches to the memory pages.
+        Uint64 NumFlushes = 0;
+    };
+
+    /// Returns the combined statistics of all thread-local caches.
+    ThreadCacheStats GetThreadCacheStats() const;
+
 private:
     // clang-format off
     FixedBlockMemoryAllocator             (const FixedBlockMemoryAllocator&) = delete;
@@ -72,6 +103,16 @@ private:
 
     void CreateNewPage();
 
+    // The following methods must be called while holding m_Mutex
+    void* AllocateFromPages();
+    void  FreeToPages(void* Ptr);
+
+    class ThreadCache;
+    struct ThreadCacheTable;
+
+    ThreadCache& GetThreadCache();
+    void         ReleaseThreadCache(ThreadCache& Cache);
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -117,11 +158,23 @@ private:
     using AddrToPageIdMapElem = std::pair<void* const, size_t>;
     std::unordered_map<void*, size_t, std::hash<void*>, std::equal_to<void*>, STDAllocatorRawMem<AddrToPageIdMapElem>> m_AddrToPageId;
 
-    std::mutex m_Mutex;
+    mutable std::mutex m_Mutex;
 
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
     const Uint32      m_NumBlocksInPage;
+    const Uint32      m_ThreadCacheSize;
+
+    // Unique allocator id that is used to find the thread-local cache.
+    // Unlike the allocator address, the id is never reused.
+    const Uint64 m_Id;
+
+    // Thread-local caches of all threads that used the allocator (protected by m_Mutex)
+    std::vector<std::shared_ptr<ThreadCache>> m_ThreadCaches;
+    // Statistics of the caches that have been released (protected by m_Mutex)
+    ThreadCacheStats m_ReleasedCacheStats;
+
+    static thread_local ThreadCacheTable tl_ThreadCaches;
 };
 
 IMemoryAllocator& GetRawAllocator();
@@ -150,6 +203,16 @@ public:
 #endif
         m_NumAllocationsInPage = NumAllocationsInPage;
     }
+    static void SetThreadCacheSize(Uint32 ThreadCacheSize)
+    {
+#ifdef DILIGENT_DEBUG
+        if (m_bPoolInitialized && m_ThreadCacheSize != ThreadCacheSize)
+        {
+            LOG_WARNING_MESSAGE("Setting pool thread cache size after the pool has been initialized has no effect");
+        }
+#endif
+        m_ThreadCacheSize = ThreadCacheSize;
+    }
     static ObjectPool& GetPool()
     {
         static ObjectPool ThePool;
@@ -185,10 +248,11 @@ public:
 
 private:
     static Uint32            m_NumAllocationsInPage;
+    static Uint32            m_ThreadCacheSize;
     static IMemoryAllocator* m_pRawAllocator;
 
     ObjectPool() :
-        m_FixedBlockAllocator(m_pRawAllocator ? *m_pRawAllocator : GetRawAllocator(), sizeof(ObjectType), m_NumAllocationsInPage)
+        m_FixedBlockAllocator(m_pRawAllocator ? *m_pRawAllocator : GetRawAllocator(), sizeof(ObjectType), m_NumAllocationsInPage, m_ThreadCacheSize)
     {}
 #ifdef DILIGENT_DEBUG
     static bool m_bPoolInitialized;
@@ -198,6 +262,9 @@ private:
 template <typename ObjectType>
 Uint32 ObjectPool<ObjectType>::m_NumAllocationsInPage = 64;
 
+template <typename ObjectType>
+Uint32 ObjectPool<ObjectType>::m_ThreadCacheSize = 0;
+
 template <typename ObjectType>
 IMemoryAllocator* ObjectPool<ObjectType>::m_pRawAllocator = nullptr;
 
@@ -206,9 +273,10 @@ template <typename ObjectType>
 bool ObjectPool<ObjectType>::m_bPoolInitialized = false;
 #endif
 
-#define SET_POOL_RAW_ALLOCATOR(ObjectType, Allocator)        ObjectPool<ObjectType>::SetRawAllocator(Allocator)
-#define SET_POOL_PAGE_SIZE(ObjectType, NumAllocationsInPage) ObjectPool<ObjectType>::SetPageSize(NumAllocationsInPage)
-#define NEW_POOL_OBJECT(ObjectType, Desc, ...)               ObjectPool<ObjectType>::GetPool().NewObject(Desc, __FILE__, __LINE__, ##__VA_ARGS__)
-#define DESTROY_POOL_OBJECT(pObject)                         ObjectPool<std::remove_reference<decltype(*pObject)>::type>::GetPool().Destroy(pObject)
+#define SET_POOL_RAW_ALLOCATOR(ObjectType, Allocator)           ObjectPool<ObjectType>::SetRawAllocator(Allocator)
+#define SET_POOL_PAGE_SIZE(ObjectType, NumAllocationsInPage)    ObjectPool<ObjectType>::SetPageSize(NumAllocationsInPage)
+#define SET_POOL_THREAD_CACHE_SIZE(ObjectType, ThreadCacheSize) ObjectPool<ObjectType>::SetThreadCacheSize(ThreadCacheSize)
+#define NEW_POOL_OBJECT(ObjectType, Desc, ...)                  ObjectPool<ObjectType>::GetPool().NewObject(Desc, __FILE__, __LINE__, ##__VA_ARGS__)
+#define DESTROY_POOL_OBJECT(pObject)                            ObjectPool<std::remove_reference<decltype(*pObject)>::type>::GetPool().Destroy(pObject)
 
 } // namespace Diligent
@@ -0,0 +1,623 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::FlatHashMap class
+
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <memory>
+#include <type_traits>
+#include <iterator>
+#include <tuple>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DILIGENT_FLAT_HASH_MAP_SSE2 1
+#    include <emmintrin.h>
+#else
+#    define DILIGENT_FLAT_HASH_MAP_SSE2 0
+#endif
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../Platforms/interface/PlatformMisc.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+/// Open-addressing hash map that stores the elements in a flat array.
+
+/// The map follows the design of the Swiss tables: every slot has a control byte that is either
+/// empty, deleted, or contains the 7 low bits of the element hash. Lookups load groups of 16 control
+/// bytes and compare them with the hash bits of the key at once (using SSE2 when available), so only
+/// the slots whose hash bits match are compared with the key. Elements are stored in place and no
+/// memory is allocated per element.
+///
+/// The interface is a subset of std::unordered_map. Unlike std::unordered_map, inserting
+/// an element invalidates iterators and references to other elements when the table grows.
+/// Erasing an element does not invalidate iterators to other elements, so elements may be
+/// erased while iterating over the map:
+///
+///     for (auto it = Map.begin(); it != Map.end();)
+///     {
+///         if (ShouldErase(*it))
+///             it = Map.erase(it);
+///         else
+///             ++it;
+///     }
+template <typename KeyType,
+          typename ValueType,
+          typename Hasher   = std::hash<KeyType>,
+          typename KeyEqual = std::equal_to<KeyType>>
+class FlatHashMap
+{
+public:
+    using key_type    = KeyType;
+    using mapped_type = ValueType;
+    using value_type  = std::pair<const KeyType, ValueType>;
+    using size_type   = size_t;
+    using hasher      = Hasher;
+    using key_equal   = KeyEqual;
+
+private:
+    using CtrlType = Int8;
+
+    static constexpr CtrlType CtrlEmpty   = -128; // 0b10000000
+    static constexpr CtrlType CtrlDeleted = -2;   // 0b11111110
+
+    static constexpr size_t GroupWidth = 16;
+
+    // Group of GroupWidth control bytes. The masks returned by the Match* methods
+    // have bit i set if the byte i matches.
+    struct Group
+    {
+#if DILIGENT_FLAT_HASH_MAP_SSE2
+        explicit Group(const CtrlType* pCtrl) noexcept :
+            Ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl))}
+        {}
+
+        Uint32 Match(CtrlType H2) const noexcept
+        {
+            return static_cast<Uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(H2), Ctrl)));
+        }
+
+        Uint32 MatchEmpty() const noexcept
+        {
+            return Match(CtrlEmpty);
+        }
+
+        Uint32 MatchEmptyOrDeleted() const noexcept
+        {
+            // Empty and deleted bytes are the only ones less than -1
+            return static_cast<Uint32>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), Ctrl)));
+        }
+
+        __m128i Ctrl;
+#else
+        explicit Group(const CtrlType* pCtrl) noexcept
+        {
+            std::memcpy(Ctrl, pCtrl, GroupWidth);
+        }
+
+        Uint32 Match(CtrlType H2) const noexcept
+        {
+            Uint32 Mask = 0;
+            for (Uint32 i = 0; i < GroupWidth; ++i)
+                Mask |= (Ctrl[i] == H2 ? 1u : 0u) << i;
+            return Mask;
+        }
+
+        Uint32 MatchEmpty() const noexcept
+        {
+            return Match(CtrlEmpty);
+        }
+
+        Uint32 MatchEmptyOrDeleted() const noexcept
+        {
+            Uint32 Mask = 0;
+            for (Uint32 i = 0; i < GroupWidth; ++i)
+                Mask |= (Ctrl[i] < -1 ? 1u : 0u) << i;
+            return Mask;
+        }
+
+        CtrlType Ctrl[GroupWidth];
+#endif
+    };
+
+    template <bool IsConst>
+    class IteratorBase
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = FlatHashMap::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = typename std::conditional<IsConst, const value_type*, value_type*>::type;
+        using reference         = typename std::conditional<IsConst, const value_type&, value_type&>::type;
+
+        IteratorBase() noexcept {}
+
+        // Allows conversion from iterator to const_iterator
+        template <bool RHSIsConst, typename = typename std::enable_if<IsConst && !RHSIsConst>::type>
+        IteratorBase(const IteratorBase<RHSIsConst>& rhs) noexcept :
+            m_pCtrl{rhs.m_pCtrl},
+            m_pSlot{rhs.m_pSlot},
+            m_pCtrlEnd{rhs.m_pCtrlEnd}
+        {}
+
+        reference operator*() const noexcept
+        {
+            VERIFY_EXPR(m_pCtrl != m_pCtrlEnd);
+            return *m_pSlot;
+        }
+
+        pointer operator->() const noexcept
+        {
+            VERIFY_EXPR(m_pCtrl != m_pCtrlEnd);
+            return m_pSlot;
+        }
+
+        IteratorBase& operator++() noexcept
+        {
+            VERIFY_EXPR(m_pCtrl != m_pCtrlEnd);
+            ++m_pCtrl;
+            ++m_pSlot;
+            SkipFreeSlots();
+            return *this;
+        }
+
+        IteratorBase operator++(int) noexcept
+        {
+            IteratorBase Tmp{*this};
+            ++(*this);
+            return Tmp;
+        }
+
+        bool operator==(const IteratorBase& rhs) const noexcept { return m_pCtrl == rhs.m_pCtrl; }
+        bool operator!=(const IteratorBase& rhs) const noexcept { return m_pCtrl != rhs.m_pCtrl; }
+
+    private:
+        friend class FlatHashMap;
+        template <bool>
+        friend class IteratorBase;
+
+        IteratorBase(const CtrlType* pCtrl, pointer pSlot, const CtrlType* pCtrlEnd) noexcept :
+            m_pCtrl{pCtrl},
+            m_pSlot{pSlot},
+            m_pCtrlEnd{pCtrlEnd}
+        {}
+
+        void SkipFreeSlots() noexcept
+        {
+            while (m_pCtrl != m_pCtrlEnd && *m_pCtrl < 0)
+            {
+                ++m_pCtrl;
+                ++m_pSlot;
+            }
+        }
+
+        const CtrlType* m_pCtrl    = nullptr;
+        pointer         m_pSlot    = nullptr;
+        const CtrlType* m_pCtrlEnd = nullptr;
+    };
+
+public:
+    using iterator       = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    FlatHashMap() noexcept {}
+
+    explicit FlatHashMap(size_t Capacity, const Hasher& Hash = Hasher{}, const KeyEqual& Equal = KeyEqual{}) :
+        m_Hasher{Hash},
+        m_KeyEqual{Equal}
+    {
+        reserve(Capacity);
+    }
+
+    FlatHashMap(FlatHashMap&& rhs) noexcept :
+        m_Hasher{std::move(rhs.m_Hasher)},
+        m_KeyEqual{std::move(rhs.m_KeyEqual)}
+    {
+        Swap(rhs);
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            Release();
+            m_Hasher   = std::move(rhs.m_Hasher);
+            m_KeyEqual = std::move(rhs.m_KeyEqual);
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    // clang-format off
+    FlatHashMap           (const FlatHashMap&) = delete;
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+    // clang-format on
+
+    ~FlatHashMap()
+    {
+        Release();
+    }
+
+    iterator begin() noexcept
+    {
+        iterator it{m_pCtrl, m_pSlots, m_pCtrl + m_Capacity};
+        it.SkipFreeSlots();
+        return it;
+    }
+
+    iterator end() noexcept
+    {
+        return iterator{m_pCtrl + m_Capacity, m_pSlots + m_Capacity, m_pCtrl + m_Capacity};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        const_iterator it{m_pCtrl, m_pSlots, m_pCtrl + m_Capacity};
+        it.SkipFreeSlots();
+        return it;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator{m_pCtrl + m_Capacity, m_pSlots + m_Capacity, m_pCtrl + m_Capacity};
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_t size() const noexcept { return m_Size; }
+    bool   empty() const noexcept { return m_Size == 0; }
+
+    /// Returns the number of slots in the table.
+    size_t capacity() const noexcept { return m_Capacity; }
+
+    iterator find(const KeyType& Key)
+    {
+        const size_t Index = FindIndex(Key, HashKey(Key));
+        return Index != InvalidIndex ? MakeIterator(Index) : end();
+    }
+
+    const_iterator find(const KeyType& Key) const
+    {
+        const size_t Index = FindIndex(Key, HashKey(Key));
+        return Index != InvalidIndex ? const_iterator{m_pCtrl + Index, m_pSlots + Index, m_pCtrl + m_Capacity} : end();
+    }
+
+    size_t count(const KeyType& Key) const
+    {
+        return FindIndex(Key, HashKey(Key)) != InvalidIndex ? 1 : 0;
+    }
+
+    /// Inserts a new element with the given key if there is no such element in the map.
+    /// The value is constructed from Args only if the element is inserted.
+    template <typename KeyArgType, typename... ArgsType>
+    std::pair<iterator, bool> try_emplace(KeyArgType&& Key, ArgsType&&... Args)
+    {
+        const size_t Hash  = HashKey(Key);
+        size_t       Index = FindIndex(Key, Hash);
+        if (Index != InvalidIndex)
+            return {MakeIterator(Index), false};
+
+        Index = PrepareInsert(Hash);
+        new (m_pSlots + Index) value_type{std::piecewise_construct,
+                                          std::forward_as_tuple(std::forward<KeyArgType>(Key)),
+                                          std::forward_as_tuple(std::forward<ArgsType>(Args)...)};
+        if (m_pCtrl[Index] == CtrlDeleted)
+            --m_NumDeleted;
+        SetCtrl(Index, H2(Hash));
+        ++m_Size;
+        return {MakeIterator(Index), true};
+    }
+
+    /// Same as try_emplace(). Unlike std::unordered_map::emplace(), the first argument
+    /// must be the key.
+    template <typename KeyArgType, typename... ArgsType>
+    std::pair<iterator, bool> emplace(KeyArgType&& Key, ArgsType&&... Args)
+    {
+        return try_emplace(std::forward<KeyArgType>(Key), std::forward<ArgsType>(Args)...);
+    }
+
+    template <typename PairType>
+    std::pair<iterator, bool> insert(PairType&& Pair)
+    {
+        return try_emplace(std::forward<PairType>(Pair).first, std::forward<PairType>(Pair).second);
+    }
+
+    ValueType& operator[](const KeyType& Key)
+    {
+        return try_emplace(Key).first->second;
+    }
+
+    ValueType& operator[](KeyType&& Key)
+    {
+        return try_emplace(std::move(Key)).first->second;
+    }
+
+    /// Erases the element and returns the iterator to the next element.
+    iterator erase(const_iterator it)
+    {
+        VERIFY_EXPR(it.m_pCtrl >= m_pCtrl && it.m_pCtrl < m_pCtrl + m_Capacity && *it.m_pCtrl >= 0);
+        const size_t Index = static_cast<size_t>(it.m_pCtrl - m_pCtrl);
+        EraseAt(Index);
+
+        iterator next{m_pCtrl + Index, m_pSlots + Index, m_pCtrl + m_Capacity};
+        next.SkipFreeSlots();
+        return next;
+    }
+
+    iterator erase(iterator it)
+    {
+        return erase(const_iterator{it});
+    }
+
+    size_t erase(const KeyType& Key)
+    {
+        const size_t Index = FindIndex(Key, HashKey(Key));
+        if (Index == InvalidIndex)
+            return 0;
+
+        EraseAt(Index);
+        return 1;
+    }
+
+    /// Destroys all elements. The memory is not released.
+    void clear()
+    {
+        if (m_Capacity == 0)
+            return;
+
+        DestroySlots();
+        std::memset(m_pCtrl, CtrlEmpty, m_Capacity + GroupWidth);
+        m_Size        = 0;
+        m_NumDeleted  = 0;
+        m_GrowthLimit = MaxLoad(m_Capacity);
+    }
+
+    /// Makes sure that the map can hold Count elements without growing.
+    void reserve(size_t Count)
+    {
+        if (Count > MaxLoad(m_Capacity))
+        {
+            size_t NewCapacity = GroupWidth;
+            while (MaxLoad(NewCapacity) < Count)
+                NewCapacity *= 2;
+            Rehash(NewCapacity);
+        }
+    }
+
+private:
+    static constexpr size_t InvalidIndex = ~size_t{0};
+
+    // Maximum number of elements (including deleted) in the table with the given capacity.
+    // The load factor is 7/8.
+    static constexpr size_t MaxLoad(size_t Capacity)
+    {
+        return Capacity - Capacity / 8;
+    }
+
+    size_t HashKey(const KeyType& Key) const
+    {
+        // Mix the bits as many hashers (e.g. std::hash for integers) return the value as is,
+        // while both low (H2) and high (H1) bits must be well distributed.
+        Uint64 h = static_cast<Uint64>(m_Hasher(Key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+
+    static size_t   H1(size_t Hash) { return Hash >> 7; }
+    static CtrlType H2(size_t Hash) { return static_cast<CtrlType>(Hash & 0x7F); }
+
+    iterator MakeIterator(size_t Index) noexcept
+    {
+        return iterator{m_pCtrl + Index, m_pSlots + Index, m_pCtrl + m_Capacity};
+    }
+
+    // Iterates over the groups in the probe sequence of the hash until the handler returns true.
+    // The sequence visits every group position once because the offsets are triangular numbers
+    // and the capacity is a power of two.
+    template <typename HandlerType>
+    void Probe(size_t Hash, HandlerType&& Handler) const
+    {
+        const size_t Mask   = m_Capacity - 1;
+        size_t       Pos    = H1(Hash) & Mask;
+        size_t       Stride = 0;
+        while (!Handler(Group{m_pCtrl + Pos}, Pos))
+        {
+            Stride += GroupWidth;
+            VERIFY(Stride < m_Capacity, "The table has no empty slots. This should never happen as the load factor is limited.");
+            Pos = (Pos + Stride) & Mask;
+        }
+    }
+
+    size_t FindIndex(const KeyType& Key, size_t Hash) const
+    {
+        if (m_Size == 0)
+            return InvalidIndex;
+
+        const CtrlType h2     = H2(Hash);
+        const size_t   Mask   = m_Capacity - 1;
+        size_t         Result = InvalidIndex;
+        Probe(Hash, [&](const Group& G, size_t Pos) {
+            for (Uint32 Matches = G.Match(h2); Matches != 0; Matches &= Matches - 1)
+            {
+                const size_t Index = (Pos + PlatformMisc::GetLSB(Matches)) & Mask;
+                if (m_KeyEqual(m_pSlots[Index].first, Key))
+                {
+                    Result = Index;
+                    return true;
+                }
+            }
+            // If the group has an empty slot, the key is not in the table,
+            // since it would have been inserted into this slot.
+            return G.MatchEmpty() != 0;
+        });
+        return Result;
+    }
+
+    size_t FindInsertIndex(size_t Hash) const
+    {
+        const size_t Mask   = m_Capacity - 1;
+        size_t       Result = InvalidIndex;
+        Probe(Hash, [&](const Group& G, size_t Pos) {
+            const Uint32 Free = G.MatchEmptyOrDeleted();
+            if (Free == 0)
+                return false;
+            Result = (Pos + PlatformMisc::GetLSB(Free)) & Mask;
+            return true;
+        });
+        return Result;
+    }
+
+    // Returns the index of the slot where the element with the given hash should be inserted.
+    size_t PrepareInsert(size_t Hash)
+    {
+        if (m_Size + m_NumDeleted >= m_GrowthLimit)
+        {
+            // If many slots are occupied by deleted elements, rehash the table
+            // without growing to clean them up.
+            Rehash(m_Size + 1 <= MaxLoad(m_Capacity) / 2 ? m_Capacity : (m_Capacity != 0 ? m_Capacity * 2 : size_t{GroupWidth}));
+        }
+        return FindInsertIndex(Hash);
+    }
+
+    void SetCtrl(size_t Index, CtrlType Ctrl) noexcept
+    {
+        m_pCtrl[Index] = Ctrl;
+        // The first GroupWidth bytes are mirrored after the end of the table,
+        // so that groups can be loaded at any position.
+        if (Index < GroupWidth)
+            m_pCtrl[m_Capacity + Index] = Ctrl;
+    }
+
+    void EraseAt(size_t Index)
+    {
+        m_pSlots[Index].~value_type();
+        --m_Size;
+
+        // If there was never a full group around the slot, no probe sequence
+        // has passed it, and the slot can be marked as empty rather than deleted.
+        const size_t Mask        = m_Capacity - 1;
+        const Uint32 EmptyAfter  = Group{m_pCtrl + Index}.MatchEmpty();
+        const Uint32 EmptyBefore = Group{m_pCtrl + ((Index - GroupWidth) & Mask)}.MatchEmpty();
+        if (EmptyAfter != 0 && EmptyBefore != 0 &&
+            PlatformMisc::GetLSB(EmptyAfter) + (GroupWidth - 1 - PlatformMisc::GetMSB(EmptyBefore)) < GroupWidth)
+        {
+            SetCtrl(Index, CtrlEmpty);
+        }
+        else
+        {
+            SetCtrl(Index, CtrlDeleted);
+            ++m_NumDeleted;
+        }
+    }
+
+    void Rehash(size_t NewCapacity)
+    {
+        VERIFY_EXPR(IsPowerOfTwo(NewCapacity) && NewCapacity >= GroupWidth && MaxLoad(NewCapacity) > m_Size);
+
+        FlatHashMap NewMap;
+        NewMap.m_pCtrl       = new CtrlType[NewCapacity + GroupWidth];
+        NewMap.m_pSlots      = std::allocator<value_type>{}.allocate(NewCapacity);
+        NewMap.m_Capacity    = NewCapacity;
+        NewMap.m_GrowthLimit = MaxLoad(NewCapacity);
+        std::memset(NewMap.m_pCtrl, CtrlEmpty, NewCapacity + GroupWidth);
+
+        for (size_t i = 0; i < m_Capacity; ++i)
+        {
+            if (m_pCtrl[i] < 0)
+                continue;
+
+            const size_t Hash  = HashKey(m_pSlots[i].first);
+            const size_t Index = NewMap.FindInsertIndex(Hash);
+            new (NewMap.m_pSlots + Index) value_type{std::move(m_pSlots[i])};
+            NewMap.SetCtrl(Index, H2(Hash));
+            ++NewMap.m_Size;
+        }
+
+        Swap(NewMap);
+    }
+
+    void DestroySlots()
+    {
+        for (size_t i = 0; i < m_Capacity; ++i)
+        {
+            if (m_pCtrl[i] >= 0)
+                m_pSlots[i].~value_type();
+        }
+    }
+
+    void Release()
+    {
+        if (m_Capacity == 0)
+            return;
+
+        DestroySlots();
+        delete[] m_pCtrl;
+        std::allocator<value_type>{}.deallocate(m_pSlots, m_Capacity);
+
+        m_pCtrl       = nullptr;
+        m_pSlots      = nullptr;
+        m_Capacity    = 0;
+        m_Size        = 0;
+        m_NumDeleted  = 0;
+        m_GrowthLimit = 0;
+    }
+
+    void Swap(FlatHashMap& rhs) noexcept
+    {
+        std::swap(m_pCtrl, rhs.m_pCtrl);
+        std::swap(m_pSlots, rhs.m_pSlots);
+        std::swap(m_Capacity, rhs.m_Capacity);
+        std::swap(m_Size, rhs.m_Size);
+        std::swap(m_NumDeleted, rhs.m_NumDeleted);
+        std::swap(m_GrowthLimit, rhs.m_GrowthLimit);
+    }
+
+private:
+    Hasher   m_Hasher;
+    KeyEqual m_KeyEqual;
+
+    // Capacity + GroupWidth control bytes
+    CtrlType*   m_pCtrl       = nullptr;
+    value_type* m_pSlots      = nullptr;
+    size_t      m_Capacity    = 0; // Zero or a power of two that is not less than GroupWidth
+    size_t      m_Size        = 0;
+    size_t      m_NumDeleted  = 0;
+    size_t      m_GrowthLimit = 0;
+};
+
+} // namespace Diligent
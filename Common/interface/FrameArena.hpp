@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::FrameArena class
+
+#include <memory>
+#include <vector>
+
+#include "DynamicLinearAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Multi-buffered linear allocator for per-frame transient data.
+
+/// The arena keeps one DynamicLinearAllocator per frame in flight. At the beginning of every
+/// frame, the allocator of the oldest frame is discarded and reused. Memory blocks are never
+/// released until the arena is destroyed, so that in a steady state no calls to the
+/// raw memory allocator are made.
+class FrameArena
+{
+public:
+    // clang-format off
+    FrameArena           (const FrameArena&) = delete;
+    FrameArena           (FrameArena&&)      = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena& operator=(FrameArena&&)      = delete;
+    // clang-format on
+
+    /// \param [in] Allocator    - Raw memory allocator that is used to allocate memory blocks.
+    /// \param [in] NumFrames    - The number of frames in flight, typically 2 or 3.
+    ///                            The memory allocated in a frame remains valid until
+    ///                            BeginFrame() is called NumFrames times.
+    /// \param [in] BlockSize    - The size of one memory block, must be a power of two.
+    explicit FrameArena(IMemoryAllocator& Allocator, Uint32 NumFrames = 2, Uint32 BlockSize = 64 << 10)
+    {
+        VERIFY(NumFrames > 0, "The number of frames must not be zero");
+        m_FrameAllocators.reserve(NumFrames);
+        for (Uint32 i = 0; i < (std::max)(NumFrames, 1u); ++i)
+            m_FrameAllocators.emplace_back(std::make_unique<DynamicLinearAllocator>(Allocator, BlockSize));
+    }
+
+    /// Starts a new frame and discards all allocations made NumFrames frames ago.
+    void BeginFrame()
+    {
+        ++m_FrameNumber;
+        GetAllocator().Discard();
+    }
+
+    /// Returns the allocator of the current frame.
+    DynamicLinearAllocator& GetAllocator()
+    {
+        return *m_FrameAllocators[m_FrameNumber % m_FrameAllocators.size()];
+    }
+
+    const DynamicLinearAllocator& GetAllocator() const
+    {
+        return *m_FrameAllocators[m_FrameNumber % m_FrameAllocators.size()];
+    }
+
+    template <typename T>
+    NODISCARD T* Allocate(size_t count = 1)
+    {
+        return GetAllocator().Allocate<T>(count);
+    }
+
+    NODISCARD void* Allocate(size_t size, size_t align)
+    {
+        return GetAllocator().Allocate(size, align);
+    }
+
+    Uint32 GetNumFrames() const
+    {
+        return static_cast<Uint32>(m_FrameAllocators.size());
+    }
+
+    Uint64 GetFrameNumber() const
+    {
+        return m_FrameNumber;
+    }
+
+    /// Returns the maximum number of bytes allocated in a single frame.
+    size_t GetPeakFrameSize() const
+    {
+        size_t PeakSize = 0;
+        for (const auto& pAllocator : m_FrameAllocators)
+            PeakSize = (std::max)(PeakSize, pAllocator->GetPeakUsedSize());
+        return PeakSize;
+    }
+
+    /// Returns the total size of memory blocks reserved by all frames.
+    size_t GetReservedSize() const
+    {
+        size_t ReservedSize = 0;
+        for (const auto& pAllocator : m_FrameAllocators)
+            ReservedSize += pAllocator->GetReservedSize();
+        return ReservedSize;
+    }
+
+    void ResetPeakFrameSize()
+    {
+        for (auto& pAllocator : m_FrameAllocators)
+            pAllocator->ResetPeakUsedSize();
+    }
+
+private:
+    std::vector<std::unique_ptr<DynamicLinearAllocator>> m_FrameAllocators;
+
+    Uint64 m_FrameNumber = 0;
+};
+
+} // namespace Diligent
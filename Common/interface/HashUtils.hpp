@@ -39,6 +39,7 @@
 #include "../../Graphics/GraphicsEngine/interface/DepthStencilState.h"
 #include "../../Graphics/GraphicsEngine/interface/BlendState.h"
 #include "../../Graphics/GraphicsEngine/interface/TextureView.h"
+#include "../../Graphics/GraphicsEngine/interface/BufferView.h"
 #include "../../Graphics/GraphicsEngine/interface/PipelineResourceSignature.h"
 #include "../../Graphics/GraphicsEngine/interface/PipelineState.h"
 #include "../../Graphics/GraphicsTools/interface/VertexPool.h"
@@ -184,6 +185,54 @@ inline std::size_t ComputeHashRaw(const void* pData, size_t Size) noexcept
     return Hash;
 }
 
+namespace HashUtilsInternal
+{
+
+constexpr Uint64 RotL64(Uint64 x, int r) noexcept
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+// MurmurHash3 finalization mix
+constexpr Uint64 FMix64(Uint64 k) noexcept
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdull;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ull;
+    k ^= k >> 33;
+    return k;
+}
+
+// MurmurHash3 x64 block mix
+constexpr Uint64 MixBlock64(Uint64 h, Uint64 k) noexcept
+{
+    k *= 0x87c37b91114253d5ull;
+    k = RotL64(k, 31);
+    k *= 0x4cf5ad432745937full;
+    h ^= k;
+    h = RotL64(h, 27);
+    return h * 5 + 0x52dce729;
+}
+
+} // namespace HashUtilsInternal
+
+/// Computes the hash of an array of 32-bit words.
+
+/// The words are processed in pairs as 64-bit blocks, which is considerably faster
+/// than combining the hashes of individual values with HashCombine.
+/// The function is constexpr and can be evaluated at compile time.
+constexpr std::size_t ComputeWordsHash(const Uint32* pWords, size_t NumWords) noexcept
+{
+    Uint64 Hash = Uint64{NumWords} * 0x9e3779b97f4a7c15ull;
+    size_t i    = 0;
+    for (; i + 2 <= NumWords; i += 2)
+        Hash = HashUtilsInternal::MixBlock64(Hash, Uint64{pWords[i]} | (Uint64{pWords[i + 1]} << 32u));
+    if (i < NumWords)
+        Hash = HashUtilsInternal::MixBlock64(Hash, Uint64{pWords[i]});
+    return static_cast<std::size_t>(HashUtilsInternal::FMix64(Hash));
+}
+
 template <typename CharType>
 struct CStringHash
 {
@@ -290,6 +339,19 @@ public:
     HashMapStringKey& operator=(const HashMapStringKey&) = delete;
     // clang-format on
 
+    /// Creates a key that references the string without copying it and uses the hash
+    /// precomputed by CStringHash<Char>, so that the string does not need to be hashed again.
+    static HashMapStringKey FromPrecomputedHash(const Char* Str, size_t Hash) noexcept
+    {
+        VERIFY(Str, "String pointer must not be null");
+        VERIFY((CStringHash<Char>{}(Str) & HashMask) == (Hash & HashMask), "The hash does not match the string");
+
+        HashMapStringKey Key;
+        Key.Str            = Str;
+        Key.Ownership_Hash = Hash & HashMask;
+        return Key;
+    }
+
     HashMapStringKey Clone() const
     {
         return HashMapStringKey{GetStr(), (Ownership_Hash & StrOwnershipMask) != 0};
@@ -597,6 +659,33 @@ struct HashCombiner<HasherType, TextureViewDesc> : HashCombinerBase<HasherType>
 };
 
 
+template <typename HasherType>
+struct HashCombiner<HasherType, BufferViewDesc> : HashCombinerBase<HasherType>
+{
+    HashCombiner(HasherType& Hasher) :
+        HashCombinerBase<HasherType>{Hasher}
+    {}
+
+    void operator()(const BufferViewDesc& BuffViewDesc) const
+    {
+        ASSERT_SIZEOF(BuffViewDesc.ViewType, 1, "Hash logic below may be incorrect.");
+        ASSERT_SIZEOF(BuffViewDesc.Format.ValueType, 1, "Hash logic below may be incorrect.");
+        ASSERT_SIZEOF(BuffViewDesc.Format.NumComponents, 1, "Hash logic below may be incorrect.");
+        ASSERT_SIZEOF(BuffViewDesc.Format.IsNormalized, 1, "Hash logic below may be incorrect.");
+
+        // Ignore Name. This is consistent with the operator==
+        this->m_Hasher(
+            ((static_cast<uint32_t>(BuffViewDesc.ViewType) << 0u) |
+             (static_cast<uint32_t>(BuffViewDesc.Format.ValueType) << 8u) |
+             (static_cast<uint32_t>(BuffViewDesc.Format.NumComponents) << 16u) |
+             ((BuffViewDesc.Format.IsNormalized ? 1u : 0u) << 24u)),
+            BuffViewDesc.ByteOffset,
+            BuffViewDesc.ByteWidth);
+        ASSERT_SIZEOF64(BuffViewDesc, 32, "Did you add new members to BufferViewDesc? Please handle them here.");
+    }
+};
+
+
 template <typename HasherType>
 struct HashCombiner<HasherType, SampleDesc> : HashCombinerBase<HasherType>
 {
@@ -793,7 +882,8 @@ struct HashCombiner<HasherType, SubpassDesc> : HashCombinerBase<HasherType>
         this->m_Hasher(
             Subpass.InputAttachmentCount,
             Subpass.RenderTargetAttachmentCount,
-            Subpass.PreserveAttachmentCount);
+            Subpass.PreserveAttachmentCount,
+            Subpass.ViewMask);
 
         if (Subpass.pInputAttachments != nullptr)
         {
@@ -837,7 +927,7 @@ struct HashCombiner<HasherType, SubpassDesc> : HashCombinerBase<HasherType>
         if (Subpass.pShadingRateAttachment)
             this->m_Hasher(*Subpass.pShadingRateAttachment);
 
-        ASSERT_SIZEOF64(Subpass, 72, "Did you add new members to SubpassDesc? Please handle them here.");
+        ASSERT_SIZEOF64(Subpass, 80, "Did you add new members to SubpassDesc? Please handle them here.");
     }
 };
 
@@ -1343,6 +1433,142 @@ struct StdHasher
     }
 };
 
+/// Hasher that packs the values into a fixed-size array of 32-bit words
+/// and hashes the array in one pass with ComputeWordsHash().
+
+/// The hasher is used for flat descriptors (e.g. SamplerDesc, BlendStateDesc) whose
+/// HashCombiner only produces a fixed number of fundamental values. Capacity must
+/// be large enough to hold all words. Unlike hashing the raw bytes of the struct,
+/// the hash does not depend on the padding and the ignored members (e.g. Name),
+/// and is consistent with the comparison operators.
+template <size_t Capacity>
+class PackedWordsHasher
+{
+public:
+    template <typename... ArgsType>
+    void operator()(const ArgsType&... Args) noexcept
+    {
+        Append(Args...);
+    }
+
+    size_t Get() const noexcept
+    {
+        return ComputeWordsHash(m_Words, m_NumWords);
+    }
+
+    size_t GetNumWords() const noexcept
+    {
+        return m_NumWords;
+    }
+
+private:
+    template <typename T>
+    typename std::enable_if<(std::is_fundamental<T>::value || std::is_enum<T>::value) && sizeof(T) <= 4>::type Append(const T& Val) noexcept
+    {
+        Uint32 Word = 0;
+        std::memcpy(&Word, &Val, sizeof(Val));
+        AppendWord(Word);
+    }
+
+    template <typename T>
+    typename std::enable_if<(std::is_fundamental<T>::value || std::is_enum<T>::value) && sizeof(T) == 8>::type Append(const T& Val) noexcept
+    {
+        Uint64 Val64 = 0;
+        std::memcpy(&Val64, &Val, sizeof(Val));
+        AppendWord(static_cast<Uint32>(Val64));
+        AppendWord(static_cast<Uint32>(Val64 >> 32u));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_class<T>::value>::type Append(const T& Val) noexcept
+    {
+        HashCombiner<PackedWordsHasher, T> Combiner{*this};
+        Combiner(Val);
+    }
+
+    template <typename FirstArgType, typename SecondArgType, typename... RestArgsType>
+    void Append(const FirstArgType& FirstArg, const SecondArgType& SecondArg, const RestArgsType&... RestArgs) noexcept
+    {
+        Append(FirstArg);
+        Append(SecondArg, RestArgs...);
+    }
+
+    void AppendWord(Uint32 Word) noexcept
+    {
+        VERIFY(m_NumWords < Capacity, "Packed hasher capacity (", Capacity, ") is exceeded. Increase the capacity.");
+        if (m_NumWords < Capacity)
+            m_Words[m_NumWords++] = Word;
+    }
+
+private:
+    Uint32 m_Words[Capacity] = {};
+    size_t m_NumWords        = 0;
+};
+
+/// Hash function object for flat descriptors that uses PackedWordsHasher.
+template <typename Type, size_t NumWords>
+struct PackedStdHasher
+{
+    size_t operator()(const Type& Val) const noexcept
+    {
+        PackedWordsHasher<NumWords>                     Hasher;
+        HashCombiner<PackedWordsHasher<NumWords>, Type> Combiner{Hasher};
+        Combiner(Val);
+        VERIFY(Hasher.GetNumWords() == NumWords, "The number of hashed words (", Hasher.GetNumWords(), ") does not match the expected value (", NumWords,
+               "). Did you change the HashCombiner?");
+        return Hasher.Get();
+    }
+};
+
+/// Descriptor wrapper that caches the hash of the descriptor.
+
+/// The hash is computed once when the wrapper is created, and is then reused
+/// by the hash maps every time they rehash or look up the key. The comparison
+/// operator compares the hashes first, so the descriptors themselves are only compared
+/// when the hashes match.
+///
+///     FlatHashMap<HashedDesc<SamplerDesc>, RefCntAutoPtr<ISampler>, HashedDesc<SamplerDesc>::Hasher> Samplers;
+///     Samplers.try_emplace(HashedDesc<SamplerDesc>{Desc}, pSampler);
+///
+/// \note  Since the hash is computed at construction, the descriptor can't be modified.
+///         Pointer members (e.g. Name) are copied as is, and must outlive the wrapper
+///         if they are accessed.
+template <typename DescType, typename DescHasher = std::hash<DescType>>
+class HashedDesc
+{
+public:
+    HashedDesc(const DescType& Desc) noexcept(noexcept(DescHasher{}(Desc))) :
+        m_Desc{Desc},
+        m_Hash{DescHasher{}(Desc)}
+    {}
+
+    const DescType& GetDesc() const noexcept { return m_Desc; }
+    size_t          GetHash() const noexcept { return m_Hash; }
+
+    operator const DescType&() const noexcept { return m_Desc; }
+
+    bool operator==(const HashedDesc& rhs) const
+    {
+        return m_Hash == rhs.m_Hash && m_Desc == rhs.m_Desc;
+    }
+    bool operator!=(const HashedDesc& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const HashedDesc& Desc) const noexcept
+        {
+            return Desc.GetHash();
+        }
+    };
+
+private:
+    DescType m_Desc;
+    size_t   m_Hash;
+};
+
 } // namespace Diligent
 
 
@@ -1369,6 +1595,16 @@ struct hash<Diligent::HashMapStringKey>
 };
 
 
+template <typename DescType, typename DescHasher>
+struct hash<Diligent::HashedDesc<DescType, DescHasher>>
+{
+    size_t operator()(const Diligent::HashedDesc<DescType, DescHasher>& Desc) const noexcept
+    {
+        return Desc.GetHash();
+    }
+};
+
+
 #define DEFINE_HASH(Type)                        \
     template <>                                  \
     struct hash<Type>                            \
@@ -1380,20 +1616,35 @@ struct hash<Diligent::HashMapStringKey>
         }                                        \
     }
 
-DEFINE_HASH(Diligent::SamplerDesc);
-DEFINE_HASH(Diligent::StencilOpDesc);
-DEFINE_HASH(Diligent::DepthStencilStateDesc);
-DEFINE_HASH(Diligent::RasterizerStateDesc);
-DEFINE_HASH(Diligent::BlendStateDesc);
-DEFINE_HASH(Diligent::TextureViewDesc);
-DEFINE_HASH(Diligent::SampleDesc);
+// Flat descriptors are hashed in one pass by PackedWordsHasher.
+// The second argument is the number of 32-bit words produced by the HashCombiner.
+#define DEFINE_PACKED_HASH(Type, NumWords)                    \
+    template <>                                               \
+    struct hash<Type>                                         \
+    {                                                         \
+        size_t operator()(const Type& Val) const noexcept     \
+        {                                                     \
+            Diligent::PackedStdHasher<Type, NumWords> Hasher; \
+            return Hasher(Val);                               \
+        }                                                     \
+    }
+
+DEFINE_PACKED_HASH(Diligent::SamplerDesc, 12);
+DEFINE_PACKED_HASH(Diligent::StencilOpDesc, 1);
+DEFINE_PACKED_HASH(Diligent::DepthStencilStateDesc, 3);
+DEFINE_PACKED_HASH(Diligent::RasterizerStateDesc, 4);
+DEFINE_PACKED_HASH(Diligent::BlendStateDesc, 3 * DILIGENT_MAX_RENDER_TARGETS + 1);
+DEFINE_PACKED_HASH(Diligent::TextureViewDesc, 7);
+DEFINE_PACKED_HASH(Diligent::BufferViewDesc, 5);
+DEFINE_PACKED_HASH(Diligent::SampleDesc, 1);
+DEFINE_PACKED_HASH(Diligent::AttachmentReference, 2);
+DEFINE_PACKED_HASH(Diligent::ShadingRateAttachment, 4);
+
 DEFINE_HASH(Diligent::ShaderResourceVariableDesc);
 DEFINE_HASH(Diligent::ImmutableSamplerDesc);
 DEFINE_HASH(Diligent::PipelineResourceDesc);
 DEFINE_HASH(Diligent::PipelineResourceLayoutDesc);
 DEFINE_HASH(Diligent::RenderPassAttachmentDesc);
-DEFINE_HASH(Diligent::AttachmentReference);
-DEFINE_HASH(Diligent::ShadingRateAttachment);
 DEFINE_HASH(Diligent::SubpassDesc);
 DEFINE_HASH(Diligent::SubpassDependencyDesc);
 DEFINE_HASH(Diligent::RenderPassDesc);
@@ -1414,6 +1665,7 @@ DEFINE_HASH(Diligent::TilePipelineStateCreateInfo);
 DEFINE_HASH(Diligent::VertexPoolElementDesc);
 
 
+#undef DEFINE_PACKED_HASH
 #undef DEFINE_HASH
 
 } // namespace std
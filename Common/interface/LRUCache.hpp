@@ -25,11 +25,33 @@
 #include <atomic>
 #include <vector>
 
+#include "../../../DiligentCore/Primitives/interface/BasicTypes.h"
 #include "../../../DiligentCore/Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
 {
 
+/// LRU cache statistics
+struct LRUCacheStats
+{
+    /// The number of Get() calls that found the data in the cache.
+    size_t NumHits = 0;
+
+    /// The number of Get() calls that initialized the data.
+    size_t NumMisses = 0;
+
+    /// The number of objects evicted from the cache.
+    size_t NumEvictions = 0;
+
+    LRUCacheStats& operator+=(const LRUCacheStats& RHS)
+    {
+        NumHits += RHS.NumHits;
+        NumMisses += RHS.NumMisses;
+        NumEvictions += RHS.NumEvictions;
+        return *this;
+    }
+};
+
 /// A thread-safe and exception-safe LRU cache.
 ///
 /// Usage example:
@@ -85,6 +107,7 @@ public:
             DataType Data;
             size_t   DataSize = 0;
             InitData(Data, DataSize); // May throw
+            m_NumMisses.fetch_add(1, std::memory_order_relaxed);
             return Data;
         }
 
@@ -99,6 +122,7 @@ public:
         // InitData may throw, which will leave the wrapper in the cache in the 'InitFailure' state.
         // It will be removed from the cache later when the LRU queue is processed.
         auto Data = pDataWrpr->GetData(std::forward<InitDataType>(InitData), IsNewObject);
+        (IsNewObject ? m_NumMisses : m_NumHits).fetch_add(1, std::memory_order_relaxed);
 
         // Process the release queue
         std::vector<std::shared_ptr<DataWrapper>> DeleteList;
@@ -202,6 +226,7 @@ public:
                 m_LRUQueue.erase(m_LRUQueue.begin() + idx);
                 VERIFY_EXPR(m_CurrSize >= AccountedSize);
                 m_CurrSize -= AccountedSize;
+                m_NumEvictions.fetch_add(1, std::memory_order_relaxed);
             }
             VERIFY_EXPR(m_Cache.size() == m_LRUQueue.size());
         }
@@ -224,6 +249,22 @@ public:
         return m_CurrSize;
     }
 
+    /// Returns the maximum cache size.
+    size_t GetMaxSize() const
+    {
+        return m_MaxSize;
+    }
+
+    /// Returns the cache statistics.
+    LRUCacheStats GetStats() const
+    {
+        LRUCacheStats Stats;
+        Stats.NumHits      = m_NumHits.load(std::memory_order_relaxed);
+        Stats.NumMisses    = m_NumMisses.load(std::memory_order_relaxed);
+        Stats.NumEvictions = m_NumEvictions.load(std::memory_order_relaxed);
+        return Stats;
+    }
+
     ~LRUCache()
     {
 #ifdef DILIGENT_DEBUG
@@ -347,6 +388,114 @@ private:
 
     std::atomic<size_t> m_CurrSize{0};
     std::atomic<size_t> m_MaxSize{0};
+
+    std::atomic<size_t> m_NumHits{0};
+    std::atomic<size_t> m_NumMisses{0};
+    std::atomic<size_t> m_NumEvictions{0};
+};
+
+
+/// A thread-safe LRU cache that is split into independently locked shards.
+///
+/// Every key is assigned to one of the shards based on its hash, and every shard is
+/// an LRUCache with its own mutex and its own share of the maximum cache size.
+/// Threads that access keys in different shards do not contend for the same lock.
+///
+/// The LRU order is only maintained within every shard, so the eviction policy
+/// approximates the global LRU order: when a shard exceeds its size budget,
+/// the least recently used objects of that shard are evicted.
+///
+/// The interface and the InitData contract of the Get() method are the same as in LRUCache.
+///
+/// \note  Since every shard only gets a fraction of the maximum size, an object that is
+///        larger than the shard budget will be evicted immediately after it is created.
+template <typename KeyType, typename DataType, typename KeyHasher = std::hash<KeyType>>
+class ShardedLRUCache
+{
+public:
+    using ShardType = LRUCache<KeyType, DataType, KeyHasher>;
+
+    static constexpr size_t DefaultNumShards = 16;
+
+    explicit ShardedLRUCache(size_t MaxSize   = 0,
+                             size_t NumShards = DefaultNumShards) :
+        m_NumShards{(std::max)(NumShards, size_t{1})},
+        m_Shards{new ShardType[m_NumShards]}
+    {
+        SetMaxSize(MaxSize);
+    }
+
+    /// Finds the data in the cache and returns it. If the data is not found, it is atomically created
+    /// using the provided initializer, see LRUCache::Get().
+    template <typename InitDataType>
+    DataType Get(const KeyType& Key,
+                 InitDataType&& InitData // May throw
+                 ) noexcept(false)
+    {
+        return m_Shards[GetShardIndex(Key)].Get(Key, std::forward<InitDataType>(InitData));
+    }
+
+    /// Sets the maximum cache size that is evenly distributed between the shards.
+
+    /// \remarks   The size must not be less than the number of shards, as otherwise
+    ///            some shards get a zero budget and never cache their keys.
+    void SetMaxSize(size_t MaxSize)
+    {
+        DEV_CHECK_ERR(MaxSize == 0 || MaxSize >= m_NumShards, "Maximum cache size (", MaxSize, ") is less than the number of shards (", m_NumShards,
+                      "). Shards with zero budget will not cache any data. Use fewer shards or increase the size.");
+        for (size_t i = 0; i < m_NumShards; ++i)
+        {
+            // Distribute the remainder between the first shards
+            m_Shards[i].SetMaxSize(MaxSize / m_NumShards + (i < MaxSize % m_NumShards ? 1 : 0));
+        }
+    }
+
+    /// Returns the total current size of all shards.
+    size_t GetCurrSize() const
+    {
+        size_t CurrSize = 0;
+        for (size_t i = 0; i < m_NumShards; ++i)
+            CurrSize += m_Shards[i].GetCurrSize();
+        return CurrSize;
+    }
+
+    /// Returns the number of shards.
+    size_t GetNumShards() const
+    {
+        return m_NumShards;
+    }
+
+    /// Returns the shard with the given index, which may be used to query its size and statistics.
+    const ShardType& GetShard(size_t ShardIdx) const
+    {
+        VERIFY_EXPR(ShardIdx < m_NumShards);
+        return m_Shards[ShardIdx];
+    }
+
+    /// Returns the combined statistics of all shards.
+    LRUCacheStats GetStats() const
+    {
+        LRUCacheStats Stats;
+        for (size_t i = 0; i < m_NumShards; ++i)
+            Stats += m_Shards[i].GetStats();
+        return Stats;
+    }
+
+    /// Returns the index of the shard that the key is assigned to.
+    size_t GetShardIndex(const KeyType& Key) const
+    {
+        // Mix the hash bits since the shard caches use the same hash function
+        // to select the buckets (see MurmurHash3 finalizer).
+        Uint64 Hash = static_cast<Uint64>(KeyHasher{}(Key));
+        Hash ^= Hash >> 33;
+        Hash *= 0xff51afd7ed558ccdull;
+        Hash ^= Hash >> 33;
+        return static_cast<size_t>(Hash % m_NumShards);
+    }
+
+private:
+    const size_t                 m_NumShards;
+    std::unique_ptr<ShardType[]> m_Shards;
 };
 
 } // namespace Diligent
@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::LockFreeBlockPool class
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <new>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../Platforms/interface/PlatformMisc.hpp"
+#include "CompilerDefinitions.h"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+/// Thread-safe pool of fixed-size memory blocks that does not use locks.
+
+/// Blocks are carved out of chunks, every next chunk being twice as large as the previous one.
+/// Chunks are never released until the pool is destroyed. Released blocks are kept in a free list
+/// whose head is tagged with a counter to protect against the ABA problem, so Allocate() and Free()
+/// may be called from any thread. Every block is aligned by alignof(std::max_align_t).
+class LockFreeBlockPool
+{
+public:
+    /// \param [in] Allocator           - Raw memory allocator that is used to allocate chunks.
+    /// \param [in] BlockSize           - The size of one block.
+    /// \param [in] NumFirstChunkBlocks - The number of blocks in the first chunk. Must be a power of two
+    ///                                   not greater than 128.
+    LockFreeBlockPool(IMemoryAllocator& Allocator, size_t BlockSize, Uint32 NumFirstChunkBlocks = 64) :
+        m_Allocator{Allocator},
+        m_BlockSize{BlockSize},
+        m_BlockStride{sizeof(BlockHeader) + AlignUp(BlockSize, alignof(std::max_align_t))},
+        m_FirstChunkLog2{PlatformMisc::GetMSB(NumFirstChunkBlocks)}
+    {
+        VERIFY(IsPowerOfTwo(NumFirstChunkBlocks) && NumFirstChunkBlocks <= 128, "The number of blocks in the first chunk (", NumFirstChunkBlocks, ") must be a power of two not greater than 128");
+        for (auto& pChunk : m_Chunks)
+            pChunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~LockFreeBlockPool()
+    {
+        DEV_CHECK_ERR(m_NumUsedBlocks.load() == 0, m_NumUsedBlocks.load(), " block(s) have not been returned to the pool");
+        for (auto& pChunk : m_Chunks)
+        {
+            if (void* pData = pChunk.load())
+                m_Allocator.FreeAligned(pData);
+        }
+    }
+
+    // clang-format off
+    LockFreeBlockPool           (const LockFreeBlockPool&)  = delete;
+    LockFreeBlockPool           (      LockFreeBlockPool&&) = delete;
+    LockFreeBlockPool& operator=(const LockFreeBlockPool&)  = delete;
+    LockFreeBlockPool& operator=(      LockFreeBlockPool&&) = delete;
+    // clang-format on
+
+    /// Allocates a block. Returns null if the pool is exhausted.
+    NODISCARD void* Allocate()
+    {
+        Uint64 Head = m_FreeHead.load(std::memory_order_acquire);
+        while ((Head & FreeListMask) != 0)
+        {
+            BlockHeader& Header = GetHeader(static_cast<Uint32>(Head & FreeListMask) - 1);
+            // The block may have been taken by another thread in the meantime, in which case
+            // the tag will not match and the exchange will fail.
+            const Uint64 NewHead = NextTag(Head) | Header.NextFree.load(std::memory_order_relaxed);
+            if (m_FreeHead.compare_exchange_weak(Head, NewHead, std::memory_order_acquire, std::memory_order_acquire))
+            {
+                m_NumUsedBlocks.fetch_add(1, std::memory_order_relaxed);
+                return &Header + 1;
+            }
+        }
+
+        // The free list is empty - carve a new block
+        const Uint32 BlockIdx = m_NumCarvedBlocks.fetch_add(1, std::memory_order_relaxed);
+
+        const Uint32 ChunkIdx = GetChunkIndex(BlockIdx);
+        if (ChunkIdx >= MaxChunks)
+        {
+            m_NumCarvedBlocks.fetch_sub(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Uint8* pChunk = m_Chunks[ChunkIdx].load(std::memory_order_acquire);
+        if (pChunk == nullptr)
+            pChunk = CreateChunk(ChunkIdx);
+
+        m_NumUsedBlocks.fetch_add(1, std::memory_order_relaxed);
+        BlockHeader* pHeader = reinterpret_cast<BlockHeader*>(pChunk + (BlockIdx - GetFirstBlockIndex(ChunkIdx)) * m_BlockStride);
+        VERIFY_EXPR(pHeader->Index == BlockIdx);
+        return pHeader + 1;
+    }
+
+    /// Returns the block to the pool.
+    void Free(void* pBlock)
+    {
+        VERIFY_EXPR(pBlock != nullptr);
+        BlockHeader* pHeader = reinterpret_cast<BlockHeader*>(pBlock) - 1;
+        VERIFY(pHeader->Index < m_NumCarvedBlocks.load(std::memory_order_relaxed), "The block was not allocated from this pool");
+
+        Uint64 Head = m_FreeHead.load(std::memory_order_relaxed);
+        do
+        {
+            pHeader->NextFree.store(static_cast<Uint32>(Head & FreeListMask), std::memory_order_relaxed);
+        } while (!m_FreeHead.compare_exchange_weak(Head, NextTag(Head) | (Uint64{pHeader->Index} + 1), std::memory_order_release, std::memory_order_relaxed));
+
+        m_NumUsedBlocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    size_t GetBlockSize() const { return m_BlockSize; }
+
+    /// Returns the number of blocks that are currently allocated.
+    Uint32 GetNumUsedBlocks() const { return static_cast<Uint32>(m_NumUsedBlocks.load(std::memory_order_relaxed)); }
+
+    /// Returns the total number of blocks that have ever been taken from the chunks.
+    Uint32 GetNumCarvedBlocks() const { return m_NumCarvedBlocks.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(std::max_align_t) BlockHeader
+    {
+        // Index + 1 of the next block in the free list, or 0
+        std::atomic<Uint32> NextFree{0};
+
+        Uint32 Index = 0;
+    };
+
+    // The lower 32 bits of the free list head contain the index + 1 of the first free block,
+    // the upper 32 bits contain the tag that is incremented with every update.
+    static constexpr Uint64 FreeListMask = 0xFFFFFFFFull;
+
+    static Uint64 NextTag(Uint64 Head)
+    {
+        return (Head & ~FreeListMask) + (FreeListMask + 1);
+    }
+
+    // Chunk i contains NumFirstChunkBlocks << i blocks, so that with at most 128 blocks
+    // in the first chunk, the index + 1 of any block fits into 32 bits.
+    static constexpr Uint32 MaxChunks = 24;
+
+    Uint32 GetChunkIndex(Uint32 BlockIdx) const
+    {
+        return PlatformMisc::GetMSB((BlockIdx >> m_FirstChunkLog2) + 1);
+    }
+
+    Uint32 GetFirstBlockIndex(Uint32 ChunkIdx) const
+    {
+        return ((1u << ChunkIdx) - 1u) << m_FirstChunkLog2;
+    }
+
+    BlockHeader& GetHeader(Uint32 BlockIdx) const
+    {
+        const Uint32 ChunkIdx = GetChunkIndex(BlockIdx);
+        Uint8*       pChunk   = m_Chunks[ChunkIdx].load(std::memory_order_acquire);
+        VERIFY_EXPR(pChunk != nullptr);
+        return *reinterpret_cast<BlockHeader*>(pChunk + (BlockIdx - GetFirstBlockIndex(ChunkIdx)) * m_BlockStride);
+    }
+
+    Uint8* CreateChunk(Uint32 ChunkIdx)
+    {
+        const Uint32 NumBlocks  = 1u << (m_FirstChunkLog2 + ChunkIdx);
+        const Uint32 FirstBlock = GetFirstBlockIndex(ChunkIdx);
+
+        Uint8* pNewChunk = static_cast<Uint8*>(m_Allocator.AllocateAligned(NumBlocks * m_BlockStride, alignof(BlockHeader), "Lock-free block pool chunk", __FILE__, __LINE__));
+        for (Uint32 i = 0; i < NumBlocks; ++i)
+        {
+            BlockHeader* pHeader = new (pNewChunk + i * m_BlockStride) BlockHeader{};
+            pHeader->Index       = FirstBlock + i;
+        }
+
+        // Another thread may have created the chunk while we were initializing ours
+        Uint8* pChunk = nullptr;
+        if (m_Chunks[ChunkIdx].compare_exchange_strong(pChunk, pNewChunk, std::memory_order_acq_rel, std::memory_order_acquire))
+            return pNewChunk;
+
+        m_Allocator.FreeAligned(pNewChunk);
+        return pChunk;
+    }
+
+private:
+    IMemoryAllocator& m_Allocator;
+
+    const size_t m_BlockSize;
+    const size_t m_BlockStride;
+    const Uint32 m_FirstChunkLog2;
+
+    std::array<std::atomic<Uint8*>, MaxChunks> m_Chunks;
+
+    std::atomic<Uint64> m_FreeHead{0};
+    std::atomic<Uint32> m_NumCarvedBlocks{0};
+    std::atomic<Int32>  m_NumUsedBlocks{0};
+};
+
+} // namespace Diligent
@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the IDataBlob interface backed by a memory-mapped file
+
+#include <memory>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "../../Platforms/Basic/interface/MemoryMappedFile.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Data blob that references the contents of a memory-mapped file.
+
+/// Unlike the blob filled by FileWrapper::ReadWholeFile(), the file is not read into memory
+/// when the blob is created. The pages are loaded by the operating system on first access,
+/// so that large files (e.g. device object archives) can be used in place, and the parts of
+/// the file that are never accessed never consume physical memory.
+/// The data is mapped with copy-on-write semantics: it may be modified through GetDataPtr(),
+/// but the changes are never written back to the file.
+class MappedFileDataBlob : public ObjectBase<IDataBlob>
+{
+public:
+    typedef ObjectBase<IDataBlob> TBase;
+
+    /// Throws std::runtime_error if the file can't be mapped.
+    MappedFileDataBlob(IReferenceCounters* pRefCounters, const Char* FilePath) noexcept(false) :
+        TBase{pRefCounters},
+        m_File{FilePath}
+    {}
+
+    /// Maps the file and returns the new data blob, or null if the file can't be mapped.
+    static RefCntAutoPtr<MappedFileDataBlob> Create(const Char* FilePath)
+    {
+        try
+        {
+            return RefCntAutoPtr<MappedFileDataBlob>{MakeNewRCObj<MappedFileDataBlob>()(FilePath)};
+        }
+        catch (...)
+        {
+            return {};
+        }
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    /// Sets the size of the internal data buffer
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override
+    {
+        UNEXPECTED("Resize is not supported by memory-mapped file data blob.");
+    }
+
+    /// Returns the size of the internal data buffer
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override
+    {
+        return m_File.GetSize();
+    }
+
+    /// Returns the pointer to the internal data buffer
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr(size_t Offset = 0) override
+    {
+        // Offset equal to the size is allowed, so that the data pointer of an empty file can be requested
+        VERIFY(Offset <= m_File.GetSize(), "Offset (", Offset, ") exceeds the data size (", m_File.GetSize(), ")");
+        return static_cast<Uint8*>(m_File.GetData()) + Offset;
+    }
+
+    /// Returns the pointer to the internal data buffer
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr(size_t Offset = 0) const override
+    {
+        VERIFY(Offset <= m_File.GetSize(), "Offset (", Offset, ") exceeds the data size (", m_File.GetSize(), ")");
+        return static_cast<const Uint8*>(m_File.GetData()) + Offset;
+    }
+
+private:
+    MemoryMappedFile m_File;
+};
+
+} // namespace Diligent
@@ -17,7 +17,6 @@
 
 #pragma once
 
-#include <unordered_map>
 #include <mutex>
 #include <memory>
 #include <algorithm>
@@ -25,6 +24,7 @@
 
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "FlatHashMap.hpp"
 
 namespace Diligent
 {
@@ -325,7 +325,7 @@ private:
     }
 
 private:
-    using CacheType = std::unordered_map<KeyType, std::shared_ptr<ObjectWrapper>, KeyHasher, KeyEqual>;
+    using CacheType = FlatHashMap<KeyType, std::shared_ptr<ObjectWrapper>, KeyHasher, KeyEqual>;
 
     const Uint32 m_NumRequestsToPurge;
 
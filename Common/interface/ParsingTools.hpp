@@ -34,10 +34,14 @@
 #include <limits>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <type_traits>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/FlagEnum.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../Platforms/interface/PlatformMisc.hpp"
+#include "../../Platforms/interface/Intrinsics.hpp"
 #include "StringTools.h"
 
 namespace Diligent
@@ -76,6 +80,180 @@ inline bool IsDigit(Char Symbol) noexcept
     return Symbol >= '0' && Symbol <= '9';
 }
 
+namespace Internal
+{
+
+// Iterators that point to contiguous memory and can be scanned 16 characters at a time.
+template <typename IteratorType>
+struct IsContiguousCharIterator : std::false_type
+{};
+
+template <>
+struct IsContiguousCharIterator<const char*> : std::true_type
+{};
+
+template <>
+struct IsContiguousCharIterator<char*> : std::true_type
+{};
+
+template <>
+struct IsContiguousCharIterator<std::string::const_iterator> : std::true_type
+{};
+
+template <>
+struct IsContiguousCharIterator<std::string::iterator> : std::true_type
+{};
+
+#if DILIGENT_SSE2_ENABLED || (DILIGENT_NEON_ENABLED && (defined(__aarch64__) || defined(_M_ARM64)))
+#    define DILIGENT_PARSING_TOOLS_SIMD 1
+#else
+#    define DILIGENT_PARSING_TOOLS_SIMD 0
+#endif
+
+#if DILIGENT_PARSING_TOOLS_SIMD
+static constexpr size_t CharBlockSize = 16;
+
+#    if DILIGENT_SSE2_ENABLED
+using CharBlock = __m128i;
+
+inline CharBlock LoadCharBlock(const char* Pos) noexcept
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Pos));
+}
+
+inline CharBlock MatchChar(const CharBlock& Block, char Symbol) noexcept
+{
+    return _mm_cmpeq_epi8(Block, _mm_set1_epi8(Symbol));
+}
+
+inline CharBlock Or(const CharBlock& A, const CharBlock& B) noexcept
+{
+    return _mm_or_si128(A, B);
+}
+
+inline CharBlock Not(const CharBlock& A) noexcept
+{
+    return _mm_xor_si128(A, _mm_cmpeq_epi8(A, A));
+}
+
+// Returns the index of the first matched byte in the block, or CharBlockSize if there is none
+inline size_t FindFirstMatch(const CharBlock& Matches) noexcept
+{
+    const Uint32 Mask = static_cast<Uint32>(_mm_movemask_epi8(Matches));
+    return Mask != 0 ? PlatformMisc::GetLSB(Mask) : CharBlockSize;
+}
+#    else
+using CharBlock = uint8x16_t;
+
+inline CharBlock LoadCharBlock(const char* Pos) noexcept
+{
+    return vld1q_u8(reinterpret_cast<const uint8_t*>(Pos));
+}
+
+inline CharBlock MatchChar(const CharBlock& Block, char Symbol) noexcept
+{
+    return vceqq_u8(Block, vdupq_n_u8(static_cast<uint8_t>(Symbol)));
+}
+
+inline CharBlock Or(const CharBlock& A, const CharBlock& B) noexcept
+{
+    return vorrq_u8(A, B);
+}
+
+inline CharBlock Not(const CharBlock& A) noexcept
+{
+    return vmvnq_u8(A);
+}
+
+inline size_t FindFirstMatch(const CharBlock& Matches) noexcept
+{
+    // Narrow every byte to 4 bits
+    const Uint64 Mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Matches), 4)), 0);
+    return Mask != 0 ? PlatformMisc::GetLSB(Mask) / 4 : CharBlockSize;
+}
+#    endif
+#endif
+
+// Finds the first new line or null character in [Pos, End).
+inline const char* FindNewLineOrNull(const char* Pos, const char* End) noexcept
+{
+#if DILIGENT_PARSING_TOOLS_SIMD
+    for (; static_cast<size_t>(End - Pos) >= CharBlockSize; Pos += CharBlockSize)
+    {
+        const CharBlock Block = LoadCharBlock(Pos);
+        const size_t    Idx   = FindFirstMatch(Or(Or(MatchChar(Block, '\n'), MatchChar(Block, '\r')), MatchChar(Block, '\0')));
+        if (Idx < CharBlockSize)
+            return Pos + Idx;
+    }
+#endif
+    while (Pos != End && *Pos != '\0' && !IsNewLine(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+// Finds the first character in [Pos, End) that is not a delimiter.
+inline const char* FindNonDelimiter(const char* Pos, const char* End) noexcept
+{
+#if DILIGENT_PARSING_TOOLS_SIMD
+    for (; static_cast<size_t>(End - Pos) >= CharBlockSize; Pos += CharBlockSize)
+    {
+        const CharBlock Block = LoadCharBlock(Pos);
+        const size_t    Idx   = FindFirstMatch(Not(Or(Or(MatchChar(Block, ' '), MatchChar(Block, '\t')), Or(MatchChar(Block, '\r'), MatchChar(Block, '\n')))));
+        if (Idx < CharBlockSize)
+            return Pos + Idx;
+    }
+#endif
+    while (Pos != End && IsDelimiter(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+// Finds the first '*' or null character in [Pos, End).
+inline const char* FindAsteriskOrNull(const char* Pos, const char* End) noexcept
+{
+#if DILIGENT_PARSING_TOOLS_SIMD
+    for (; static_cast<size_t>(End - Pos) >= CharBlockSize; Pos += CharBlockSize)
+    {
+        const CharBlock Block = LoadCharBlock(Pos);
+        const size_t    Idx   = FindFirstMatch(Or(MatchChar(Block, '*'), MatchChar(Block, '\0')));
+        if (Idx < CharBlockSize)
+            return Pos + Idx;
+    }
+#endif
+    while (Pos != End && *Pos != '\0' && *Pos != '*')
+        ++Pos;
+    return Pos;
+}
+
+// Advances the iterator while the predicate is true. For contiguous character
+// iterators, uses the FastScan function that processes multiple characters at once.
+template <typename IteratorType, typename PredicateType>
+IteratorType ScanWhile(IteratorType Pos, const IteratorType& End, PredicateType&& Predicate, const char* (*)(const char*, const char*), std::false_type) noexcept
+{
+    while (Pos != End && Predicate(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+template <typename IteratorType, typename PredicateType>
+IteratorType ScanWhile(IteratorType Pos, const IteratorType& End, PredicateType&&, const char* (*FastScan)(const char*, const char*), std::true_type) noexcept
+{
+    if (Pos == End)
+        return Pos;
+
+    const char* pStart = &*Pos;
+    const char* pEnd   = pStart + (End - Pos);
+    return Pos + (FastScan(pStart, pEnd) - pStart);
+}
+
+template <typename IteratorType, typename PredicateType>
+IteratorType ScanWhile(const IteratorType& Pos, const IteratorType& End, PredicateType&& Predicate, const char* (*FastScan)(const char*, const char*)) noexcept
+{
+    return ScanWhile(Pos, End, std::forward<PredicateType>(Predicate), FastScan, IsContiguousCharIterator<IteratorType>{});
+}
+
+} // namespace Internal
+
 /// Skips all characters until the end of the line.
 
 /// \param[in] Start        - starting position.
@@ -91,9 +269,8 @@ inline bool IsDigit(Char Symbol) noexcept
 template <typename InteratorType>
 InteratorType SkipLine(const InteratorType& Start, const InteratorType& End, bool GoToNextLine = false) noexcept
 {
-    auto Pos = Start;
-    while (Pos != End && *Pos != '\0' && !IsNewLine(*Pos))
-        ++Pos;
+    auto Pos = Internal::ScanWhile(
+        Start, End, [](char c) { return c != '\0' && !IsNewLine(c); }, Internal::FindNewLineOrNull);
     if (GoToNextLine && Pos != End && IsNewLine(*Pos))
     {
         ++Pos;
@@ -181,29 +358,29 @@ InteratorType SkipComment(const InteratorType& Start, const InteratorType& End,
         //    ^
         while (Pos != End && *Pos != '\0')
         {
-            if (*Pos == '*')
-            {
-                //  /* Comment */
-                //             ^
-                //             Pos
-                ++Pos;
+            // Jump to the next '*'
+            Pos = Internal::ScanWhile(
+                Pos, End, [](char c) { return c != '\0' && c != '*'; }, Internal::FindAsteriskOrNull);
+            if (Pos == End || *Pos == '\0')
+                break;
 
-                if (Pos != End && *Pos == '/')
-                {
-                    //  /* Comment */
-                    //              ^
-                    //              Pos
+            //  /* Comment */
+            //             ^
+            //             Pos
+            VERIFY_EXPR(*Pos == '*');
+            ++Pos;
 
-                    ++Pos;
-                    //  /* Comment */
-                    //               ^
-                    //              Pos
-                    return Pos;
-                }
-            }
-            else
+            if (Pos != End && *Pos == '/')
             {
+                //  /* Comment */
+                //              ^
+                //              Pos
+
                 ++Pos;
+                //  /* Comment */
+                //               ^
+                //              Pos
+                return Pos;
             }
         }
 
@@ -230,8 +407,7 @@ InteratorType SkipDelimiters(const InteratorType& Start, const InteratorType& En
     }
     else
     {
-        while (Pos != End && IsDelimiter(*Pos))
-            ++Pos;
+        Pos = Internal::ScanWhile(Pos, End, IsDelimiter, Internal::FindNonDelimiter);
     }
     return Pos;
 }
@@ -0,0 +1,130 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Radix sort
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Sorts the items in ascending order of their unsigned integer keys using LSD radix sort.
+
+/// \param [in, out] pItems   - Items to sort. On return, contains the sorted items.
+/// \param [in]      pScratch - Temporary storage for at least Count items.
+/// \param [in]      Count    - The number of items.
+/// \param [in]      GetKey   - Function that returns the key of an item.
+///
+/// \remarks The sort is stable. Byte passes where all keys have the same digit are skipped,
+///          so sorting keys that only use a few low bits only takes a few passes.
+///          Small arrays are sorted with insertion sort.
+template <typename ItemType, typename KeyFuncType>
+void RadixSort(ItemType* pItems, ItemType* pScratch, size_t Count, KeyFuncType&& GetKey)
+{
+    using KeyType = typename std::decay<decltype(GetKey(*pItems))>::type;
+    static_assert(std::is_integral<KeyType>::value && std::is_unsigned<KeyType>::value, "Key must be an unsigned integer");
+
+    constexpr size_t InsertionSortThreshold = 32;
+    if (Count <= InsertionSortThreshold)
+    {
+        for (size_t i = 1; i < Count; ++i)
+        {
+            if (!(GetKey(pItems[i]) < GetKey(pItems[i - 1])))
+                continue;
+
+            ItemType   Item = std::move(pItems[i]);
+            const auto Key  = GetKey(Item);
+
+            size_t j = i;
+            for (; j > 0 && Key < GetKey(pItems[j - 1]); --j)
+                pItems[j] = std::move(pItems[j - 1]);
+            pItems[j] = std::move(Item);
+        }
+        return;
+    }
+
+    VERIFY_EXPR(pScratch != nullptr);
+
+    constexpr size_t NumPasses = sizeof(KeyType);
+    size_t           Histograms[NumPasses][256];
+    std::memset(Histograms, 0, sizeof(Histograms));
+
+    // Build all histograms in one pass over the data
+    bool IsSorted = true;
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const KeyType Key = GetKey(pItems[i]);
+        for (size_t pass = 0; pass < NumPasses; ++pass)
+            ++Histograms[pass][(Key >> (pass * 8)) & 0xFF];
+        if (i > 0 && Key < GetKey(pItems[i - 1]))
+            IsSorted = false;
+    }
+    if (IsSorted)
+        return;
+
+    ItemType* pSrc = pItems;
+    ItemType* pDst = pScratch;
+    for (size_t pass = 0; pass < NumPasses; ++pass)
+    {
+        size_t* Histogram = Histograms[pass];
+
+        const size_t Shift = pass * 8;
+        // Skip the pass if all keys have the same digit
+        if (Histogram[(GetKey(pSrc[0]) >> Shift) & 0xFF] == Count)
+            continue;
+
+        // Convert counts to offsets
+        size_t Offset = 0;
+        for (size_t d = 0; d < 256; ++d)
+        {
+            const size_t DigitCount = Histogram[d];
+            Histogram[d]            = Offset;
+            Offset += DigitCount;
+        }
+
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const size_t Digit = (GetKey(pSrc[i]) >> Shift) & 0xFF;
+            pDst[Histogram[Digit]++] = std::move(pSrc[i]);
+        }
+        std::swap(pSrc, pDst);
+    }
+
+    if (pSrc != pItems)
+    {
+        for (size_t i = 0; i < Count; ++i)
+            pItems[i] = std::move(pSrc[i]);
+    }
+}
+
+} // namespace Diligent
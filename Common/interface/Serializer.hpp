@@ -30,6 +30,7 @@
 #include <array>
 #include <cstring>
 #include <atomic>
+#include <limits>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
@@ -155,6 +156,9 @@ public:
     template <typename T>
     using TEnable = typename std::enable_if_t<IsTriviallySerializable<T>::value, bool>;
 
+    template <typename T>
+    using TEnableVarInt = typename std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value, bool>;
+
     template <typename T>
     using TEnableStr = typename std::enable_if_t<(std::is_same<const char* const, T>::value || std::is_same<const char*, T>::value), bool>;
     using CharPtr    = typename std::conditional_t<Mode == SerializerMode::Read, const char*&, const char*>;
@@ -231,11 +235,29 @@ public:
                         CountType&              Count,
                         ArrayElemSerializerType ElemSerializer);
 
+    /// Serializes the array of elements using the default element serializer.
+    /// Arrays of trivially serializable elements are serialized with SerializeArrayBulk().
     template <typename ElemPtrType, typename CountType>
     bool SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                            ElemPtrType&            Elements,
                            CountType&              Count);
 
+    /// Serializes the array of trivially serializable elements as the element count
+    /// followed by the elements, using a single copy for the whole array.
+    ///
+    /// \note  The layout is identical to the one produced by serializing the elements
+    ///        one by one, so bulk and per-element paths are interchangeable.
+    template <typename ElemPtrType, typename CountType>
+    bool SerializeArrayBulk(DynamicLinearAllocator* Allocator,
+                            ElemPtrType&            Elements,
+                            CountType&              Count);
+
+    /// Serializes an unsigned integer using variable-length encoding (LEB128):
+    /// every byte stores 7 bits of the value, starting from the least significant bits,
+    /// and the high bit indicates that more bytes follow. Values below 128 take one byte.
+    template <typename T>
+    TEnableVarInt<T> SerializeVarInt(ConstQual<T>& Value);
+
     template <typename T>
     TReadOnly<T> Cast()
     {
@@ -296,6 +318,28 @@ private:
     template <typename T>
     bool Copy(T* pData, size_t Size);
 
+    template <typename ElemPtrType, typename CountType>
+    bool SerializeArrayRawImpl(DynamicLinearAllocator* Allocator,
+                               ElemPtrType&            Elements,
+                               CountType&              Count,
+                               std::true_type /*IsTriviallySerializable*/)
+    {
+        return SerializeArrayBulk(Allocator, Elements, Count);
+    }
+
+    template <typename ElemPtrType, typename CountType>
+    bool SerializeArrayRawImpl(DynamicLinearAllocator* Allocator,
+                               ElemPtrType&            Elements,
+                               CountType&              Count,
+                               std::false_type /*IsTriviallySerializable*/)
+    {
+        return SerializeArray(Allocator, Elements, Count,
+                              [](Serializer<Mode>& Ser, auto& Elem) //
+                              {
+                                  return Ser(Elem);
+                              });
+    }
+
     void AlignOffset(size_t Alignment)
     {
         const auto Size       = GetSize();
@@ -488,11 +532,108 @@ bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                                          ElemPtrType&            Elements,
                                          CountType&              Count)
 {
-    return SerializeArray(Allocator, Elements, Count,
-                          [](Serializer<Mode>& Ser, auto& Elem) //
-                          {
-                              return Ser(Elem);
-                          });
+    using ElemType = RawType<decltype(Elements[0])>;
+    return SerializeArrayRawImpl(Allocator, Elements, Count, std::integral_constant<bool, IsTriviallySerializable<ElemType>::value>{});
+}
+
+
+template <SerializerMode Mode> // Write or Measure
+template <typename ElemPtrType, typename CountType>
+bool Serializer<Mode>::SerializeArrayBulk(DynamicLinearAllocator* Allocator,
+                                          ElemPtrType&            SrcArray,
+                                          CountType&              Count)
+{
+    static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Unexpected mode");
+    using ElemType = RawType<decltype(SrcArray[0])>;
+    static_assert(IsTriviallySerializable<ElemType>::value, "Only arrays of trivially serializable elements can be serialized in bulk");
+    VERIFY_EXPR((SrcArray != nullptr) == (Count != 0));
+
+    if (!(*this)(Count))
+        return false;
+
+    if (Count == 0)
+        return true;
+
+    return Copy(static_cast<const ElemType*>(SrcArray), sizeof(ElemType) * static_cast<size_t>(Count));
+}
+
+template <>
+template <typename ElemPtrType, typename CountType>
+bool Serializer<SerializerMode::Read>::SerializeArrayBulk(DynamicLinearAllocator* Allocator,
+                                                          ElemPtrType&            DstArray,
+                                                          CountType&              Count)
+{
+    using ElemType = RawType<decltype(DstArray[0])>;
+    static_assert(IsTriviallySerializable<ElemType>::value, "Only arrays of trivially serializable elements can be serialized in bulk");
+    VERIFY_EXPR(Allocator != nullptr);
+    VERIFY_EXPR(DstArray == nullptr);
+
+    if (!(*this)(Count))
+        return false;
+
+    if (Count == 0)
+        return true;
+
+    const size_t Size = sizeof(ElemType) * static_cast<size_t>(Count);
+    CHECK_REMAINING_SIZE(Size, "Not enough data to read ", Count, " array elements");
+
+    ElemType* pDstElements = Allocator->Allocate<ElemType>(static_cast<size_t>(Count));
+    if (!Copy(pDstElements, Size))
+        return false;
+    DstArray = pDstElements;
+
+    return true;
+}
+
+
+template <SerializerMode Mode> // Write or Measure
+template <typename T>
+typename Serializer<Mode>::template TEnableVarInt<T> Serializer<Mode>::SerializeVarInt(ConstQual<T>& Value)
+{
+    static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Unexpected mode");
+
+    Uint8  Bytes[(sizeof(T) * 8 + 6) / 7];
+    size_t NumBytes = 0;
+
+    T Val = Value;
+    do
+    {
+        Uint8 Byte = static_cast<Uint8>(Val & 0x7Fu);
+        Val        = static_cast<T>(Val >> 7u);
+        if (Val != 0)
+            Byte |= 0x80u;
+        Bytes[NumBytes++] = Byte;
+    } while (Val != 0);
+
+    return Copy(Bytes, NumBytes);
+}
+
+template <>
+template <typename T>
+typename Serializer<SerializerMode::Read>::TEnableVarInt<T> Serializer<SerializerMode::Read>::SerializeVarInt(ConstQual<T>& Value)
+{
+    constexpr size_t MaxBytes = (sizeof(T) * 8 + 6) / 7;
+
+    Uint64 Val = 0;
+    for (size_t i = 0; i < MaxBytes; ++i)
+    {
+        CHECK_REMAINING_SIZE(1, "Not enough data to read variable-length integer");
+        const Uint8 Byte = *(m_Ptr++);
+        Val |= Uint64{Byte & 0x7Fu} << (i * 7u);
+        if ((Byte & 0x80u) == 0)
+        {
+            if (Val > Uint64{std::numeric_limits<T>::max()})
+            {
+                UNEXPECTED("Variable-length integer value ", Val, " does not fit into ", sizeof(T), " bytes");
+                return false;
+            }
+            Value = static_cast<T>(Val);
+            return true;
+        }
+    }
+
+    UNEXPECTED("Variable-length integer is too long");
+    return false;
 }
 
 #undef CHECK_REMAINING_SIZE
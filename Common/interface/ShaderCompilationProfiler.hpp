@@ -0,0 +1,241 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Shader and pipeline compilation time instrumentation
+
+#include <atomic>
+#include <functional>
+#include <string>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Shader compilation stage
+enum SHADER_COMPILATION_STAGE : Uint32
+{
+    /// Include unrolling and source string construction
+    SHADER_COMPILATION_STAGE_PREPROCESS = 0,
+
+    /// Compilation by the frontend compiler (DXC, FXC or glslang)
+    SHADER_COMPILATION_STAGE_COMPILE,
+
+    /// SPIR-V optimization and legalization
+    SHADER_COMPILATION_STAGE_OPTIMIZE,
+
+    /// Conversion to another shading language (HLSL to GLSL, SPIR-V to WGSL)
+    SHADER_COMPILATION_STAGE_CROSS_COMPILE,
+
+    /// Shader resource reflection
+    SHADER_COMPILATION_STAGE_REFLECTION,
+
+    /// Shader and pipeline compilation by the driver
+    SHADER_COMPILATION_STAGE_DRIVER_COMPILE,
+
+    SHADER_COMPILATION_STAGE_COUNT
+};
+
+/// Returns the literal name of the stage, e.g. "Preprocess".
+const char* GetShaderCompilationStageName(SHADER_COMPILATION_STAGE Stage);
+
+/// Compilation time breakdown of a single shader or pipeline state
+struct ShaderCompilationTimings
+{
+    /// Object name. The pointer is only valid in the callback.
+    const char* Name = nullptr;
+
+    /// true for pipeline states, false for shaders.
+    bool IsPipeline = false;
+
+    /// Total creation time, in seconds, including the time not attributed to any stage.
+    double TotalTime = 0;
+
+    /// Exclusive time spent in every stage, in seconds. The time of a nested stage
+    /// is not counted in the enclosing stage.
+    double StageTimes[SHADER_COMPILATION_STAGE_COUNT] = {};
+
+    /// The number of compilation cache hits and misses.
+    Uint32 CacheHits   = 0;
+    Uint32 CacheMisses = 0;
+};
+
+/// Aggregated compilation statistics of all shaders or all pipeline states
+struct ShaderCompilationStats
+{
+    /// The number of objects.
+    Uint32 Count = 0;
+
+    /// The total time, in seconds.
+    double TotalTime = 0;
+
+    /// The total time spent in every stage, in seconds.
+    double StageTimes[SHADER_COMPILATION_STAGE_COUNT] = {};
+
+    Uint32 CacheHits   = 0;
+    Uint32 CacheMisses = 0;
+
+    /// The slowest object and its time, in seconds.
+    std::string SlowestName;
+    double      MaxTime = 0;
+};
+
+/// Shader compilation summary
+struct ShaderCompilationSummary
+{
+    ShaderCompilationStats Shaders;
+    ShaderCompilationStats Pipelines;
+};
+
+/// Shader and pipeline compilation profiler.
+
+/// Shader and pipeline state creation is measured by ShaderCompilationScope, and the stages
+/// of the compilation (see SHADER_COMPILATION_STAGE) by ShaderCompilationStageScope.
+/// Stages are attributed to the innermost object scope of the current thread, so the shader
+/// compilers in ShaderTools that do not know about the object report to the shader or the
+/// pipeline that is being created.
+///
+/// The profiler is process-wide and covers the objects created by all render devices,
+/// the archiver, and render state caches.
+///
+/// \remarks    The profiler is disabled by default. When it is disabled, the scopes only
+///             check an atomic flag.
+class ShaderCompilationProfiler
+{
+public:
+    using CallbackType = std::function<void(const ShaderCompilationTimings&)>;
+
+    /// Enables or disables the profiler.
+    static void SetEnabled(bool Enabled);
+
+    static bool IsEnabled()
+    {
+        return sm_Enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Sets the function that is called when a shader or a pipeline state has been created.
+    /// The callback is called on the thread that created the object and may be called
+    /// from multiple threads simultaneously. Pass an empty function to remove the callback.
+    static void SetCallback(CallbackType Callback);
+
+    /// Returns the statistics accumulated since the profiler was enabled or reset.
+    static ShaderCompilationSummary GetSummary();
+
+    /// Resets the accumulated statistics.
+    static void ResetSummary();
+
+    /// Returns the summary formatted as a table.
+    static std::string GetSummaryString();
+
+    /// Records a compilation cache hit or miss for the current object.
+    static void AddCacheResult(bool Hit);
+
+private:
+    friend class ShaderCompilationScope;
+
+    static void Report(const ShaderCompilationTimings& Timings);
+
+    static std::atomic<bool> sm_Enabled;
+};
+
+class ShaderCompilationStageScope;
+
+/// RAII scope that measures the creation of a shader or a pipeline state.
+class ShaderCompilationScope
+{
+public:
+    ShaderCompilationScope(const char* Name, bool IsPipeline) noexcept
+    {
+        if (ShaderCompilationProfiler::IsEnabled())
+            Begin(Name, IsPipeline);
+    }
+
+    ~ShaderCompilationScope()
+    {
+        if (m_IsActive)
+            End();
+    }
+
+    // clang-format off
+    ShaderCompilationScope           (const ShaderCompilationScope&)  = delete;
+    ShaderCompilationScope           (      ShaderCompilationScope&&) = delete;
+    ShaderCompilationScope& operator=(const ShaderCompilationScope&)  = delete;
+    ShaderCompilationScope& operator=(      ShaderCompilationScope&&) = delete;
+    // clang-format on
+
+private:
+    friend class ShaderCompilationProfiler;
+    friend class ShaderCompilationStageScope;
+
+    void Begin(const char* Name, bool IsPipeline);
+    void End();
+
+    ShaderCompilationTimings     m_Timings;
+    Uint64                       m_StartTime    = 0;
+    ShaderCompilationScope*      m_pParent      = nullptr;
+    ShaderCompilationStageScope* m_pActiveStage = nullptr;
+    bool                         m_IsActive     = false;
+};
+
+/// RAII scope that measures a compilation stage of the current shader or pipeline state.
+/// If there is no object scope on the current thread, the stage is not recorded.
+class ShaderCompilationStageScope
+{
+public:
+    explicit ShaderCompilationStageScope(SHADER_COMPILATION_STAGE Stage) noexcept
+    {
+        if (ShaderCompilationProfiler::IsEnabled())
+            Begin(Stage);
+    }
+
+    ~ShaderCompilationStageScope()
+    {
+        if (m_pScope != nullptr)
+            End();
+    }
+
+    // clang-format off
+    ShaderCompilationStageScope           (const ShaderCompilationStageScope&)  = delete;
+    ShaderCompilationStageScope           (      ShaderCompilationStageScope&&) = delete;
+    ShaderCompilationStageScope& operator=(const ShaderCompilationStageScope&)  = delete;
+    ShaderCompilationStageScope& operator=(      ShaderCompilationStageScope&&) = delete;
+    // clang-format on
+
+private:
+    void Begin(SHADER_COMPILATION_STAGE Stage);
+    void End();
+
+    ShaderCompilationScope*      m_pScope    = nullptr;
+    ShaderCompilationStageScope* m_pParent   = nullptr;
+    Uint64                       m_StartTime = 0;
+    Uint64                       m_ChildTime = 0;
+    SHADER_COMPILATION_STAGE     m_Stage     = SHADER_COMPILATION_STAGE_COUNT;
+};
+
+} // namespace Diligent
@@ -0,0 +1,198 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::SoftwareOcclusionCuller class
+
+#include <vector>
+
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+struct IThreadPool;
+
+/// Software occlusion culler.
+
+/// The culler rasterizes occluder meshes into a low-resolution depth buffer on the CPU
+/// and tests bounding boxes of the occludees against it. This is useful on platforms where
+/// GPU-driven culling is not available, e.g. OpenGLES, WebGL or Direct3D11.
+///
+/// The depth buffer is split into TileSize x TileSize tiles. The triangles are binned into
+/// the tiles they overlap, and the tiles are rasterized independently, optionally in parallel
+/// by the thread pool. Every tile keeps the maximum depth of its pixels, which allows rejecting
+/// most of the occludees without reading the pixels (two-level hierarchical depth buffer).
+/// Pixels are rasterized 4 at a time using SSE2 or NEON instructions when available.
+///
+/// Usage example:
+///
+///     Culler.BeginFrame(ViewProj, IsOpenGL);
+///     for (const auto& Occluder : Occluders)
+///         Culler.AddOccluder(Occluder.pVertices, Occluder.NumVertices, Occluder.pIndices, Occluder.NumIndices, Occluder.World);
+///     Culler.RasterizeOccluders();
+///     Culler.TestBoxes(pBoxes, NumBoxes, pVisibilityMask);
+///
+/// \remarks    The culler assumes standard (not reversed) depth, where the nearest surface has the smallest depth.
+///
+///             The results are conservative: occluder triangles crossing the near plane are skipped, and boxes
+///             that intersect the near plane or are outside of the viewport are reported as visible.
+///             Frustum culling is not performed and should be applied separately.
+class SoftwareOcclusionCuller
+{
+public:
+    /// Tile size in pixels.
+    static constexpr Uint32 TileSize = 8;
+
+    struct CreateInfo
+    {
+        /// Depth buffer width. Rounded up to a multiple of TileSize.
+        Uint32 Width = 256;
+
+        /// Depth buffer height. Rounded up to a multiple of TileSize.
+        Uint32 Height = 128;
+
+        /// Optional thread pool that is used to rasterize the tiles and test the boxes in parallel.
+        IThreadPool* pThreadPool = nullptr;
+
+        /// The number of tiles rasterized by one thread pool task.
+        Uint32 TilesPerTask = 32;
+
+        /// The number of boxes tested by one thread pool task. Rounded up to a multiple of 32.
+        Uint32 BoxesPerTask = 1024;
+    };
+
+    explicit SoftwareOcclusionCuller(const CreateInfo& CI);
+
+    // clang-format off
+    SoftwareOcclusionCuller           (const SoftwareOcclusionCuller&) = delete;
+    SoftwareOcclusionCuller           (SoftwareOcclusionCuller&&)      = delete;
+    SoftwareOcclusionCuller& operator=(const SoftwareOcclusionCuller&) = delete;
+    SoftwareOcclusionCuller& operator=(SoftwareOcclusionCuller&&)      = delete;
+    // clang-format on
+
+    /// Clears the depth buffer and removes all occluders.
+
+    /// \param [in] ViewProj - View-projection matrix.
+    /// \param [in] IsOpenGL - Whether the matrix maps depth to the [-1, 1] range (OpenGL) rather than [0, 1].
+    void BeginFrame(const float4x4& ViewProj, bool IsOpenGL);
+
+    /// Adds an indexed triangle list occluder.
+
+    /// \param [in] pVertices   - Vertex positions in the model space.
+    /// \param [in] NumVertices - The number of vertices.
+    /// \param [in] pIndices    - Triangle list indices.
+    /// \param [in] NumIndices  - The number of indices. Must be a multiple of 3.
+    /// \param [in] World       - World matrix of the occluder.
+    ///
+    /// \remarks    The occluders are rasterized by RasterizeOccluders().
+    void AddOccluder(const float3*   pVertices,
+                     Uint32          NumVertices,
+                     const Uint32*   pIndices,
+                     Uint32          NumIndices,
+                     const float4x4& World = float4x4::Identity());
+
+    /// Rasterizes all occluders added since the last call to BeginFrame().
+    void RasterizeOccluders();
+
+    /// Returns false if the box is fully occluded by the rasterized occluders, and true otherwise.
+
+    /// \param [in] Box - World-space axis-aligned bounding box.
+    bool IsBoxVisible(const BoundBox& Box) const;
+
+    /// Tests multiple boxes against the depth buffer.
+
+    /// \param [in]  pBoxes          - World-space axis-aligned bounding boxes.
+    /// \param [in]  NumBoxes        - The number of boxes.
+    /// \param [out] pVisibilityMask - Bit mask of (NumBoxes + 31) / 32 elements. Bit i % 32 of element i / 32
+    ///                                is set if box i is visible, see IsBoxVisible().
+    ///                                Unused bits of the last element are cleared.
+    ///
+    /// \remarks    If the thread pool was provided, the boxes are split into chunks that are processed in parallel.
+    void TestBoxes(const BoundBox* pBoxes, size_t NumBoxes, Uint32* pVisibilityMask) const;
+
+    /// Returns the depth buffer width.
+    Uint32 GetWidth() const { return m_Width; }
+
+    /// Returns the depth buffer height.
+    Uint32 GetHeight() const { return m_Height; }
+
+    /// Returns the depth buffer data, row by row, top to bottom.
+    const float* GetDepthData() const { return m_Depth.data(); }
+
+    /// Returns the number of triangles added since the last call to BeginFrame()
+    /// that passed the near plane and the viewport tests.
+    size_t GetNumTriangles() const { return m_Triangles.size(); }
+
+    /// Returns the name of the SIMD instruction set used to rasterize the triangles.
+    static const char* GetImplementationName();
+
+private:
+    struct Triangle
+    {
+        // Edge functions E(x, y) = A * x + B * y + C that are non-negative inside the triangle
+        float EdgeA[3];
+        float EdgeB[3];
+        float EdgeC[3];
+
+        // Depth plane Z(x, y) = ZA * x + ZB * y + ZC
+        float ZA;
+        float ZB;
+        float ZC;
+
+        // Pixel bounds, clamped to the viewport
+        int MinX;
+        int MinY;
+        int MaxX;
+        int MaxY;
+    };
+
+    void RasterizeTile(Uint32 TileIdx);
+
+    Uint32 m_Width        = 0;
+    Uint32 m_Height       = 0;
+    Uint32 m_NumTilesX    = 0;
+    Uint32 m_NumTilesY    = 0;
+    Uint32 m_TilesPerTask = 0;
+    Uint32 m_BoxesPerTask = 0;
+
+    IThreadPool* const m_pThreadPool;
+
+    float4x4 m_ViewProj;
+    bool     m_IsOpenGL = false;
+
+    std::vector<float> m_Depth;
+    std::vector<float> m_TileMaxDepth;
+
+    std::vector<float4>              m_ClipVerts;
+    std::vector<Triangle>            m_Triangles;
+    std::vector<std::vector<Uint32>> m_TileBins;
+};
+
+} // namespace Diligent
@@ -28,12 +28,16 @@
 #pragma once
 
 /// \file
-/// Defines Diligent::StringPool class
+/// Defines Diligent::StringPool and Diligent::InternedStringPool classes
 
 #include <cstring>
+#include <vector>
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FlatHashMap.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -173,4 +177,203 @@ private:
     IMemoryAllocator* m_pAllocator   = nullptr;
 };
 
+
+/// Handle of a string interned by Diligent::InternedStringPool.
+
+/// The handle references the pooled string and keeps its precomputed hash.
+/// Handles from the same pool are equal if and only if the strings are equal,
+/// so the handles are compared by pointer.
+class InternedString
+{
+public:
+    InternedString() noexcept {}
+
+    const Char* GetStr() const noexcept { return m_Str; }
+    size_t      GetHash() const noexcept { return m_Hash; }
+
+    explicit operator bool() const noexcept { return m_Str != nullptr; }
+
+    bool operator==(const InternedString& RHS) const noexcept { return m_Str == RHS.m_Str; }
+    bool operator!=(const InternedString& RHS) const noexcept { return m_Str != RHS.m_Str; }
+
+    /// Returns the hash map key that references the pooled string and reuses its hash.
+    HashMapStringKey GetKey() const noexcept
+    {
+        VERIFY(m_Str != nullptr, "The handle is empty");
+        return HashMapStringKey::FromPrecomputedHash(m_Str, m_Hash);
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const InternedString& Str) const noexcept
+        {
+            return Str.GetHash();
+        }
+    };
+
+private:
+    friend class InternedStringPool;
+
+    InternedString(const Char* Str, size_t Hash) noexcept :
+        m_Str{Str},
+        m_Hash{Hash}
+    {}
+
+    const Char* m_Str  = nullptr;
+    size_t      m_Hash = 0;
+};
+
+
+/// String pool that stores a single copy of every string.
+
+/// Intern() returns the handle of the pooled copy of the string, adding the string
+/// to the pool if it is not there yet. Strings are stored in pages that never move,
+/// so the handles remain valid until the pool is cleared or destroyed, including
+/// when the pool itself is moved.
+///
+/// \note  The class is not thread-safe.
+class InternedStringPool
+{
+public:
+    explicit InternedStringPool(IMemoryAllocator& Allocator = DefaultRawMemoryAllocator::GetAllocator(),
+                                size_t            PageSize  = 4096) noexcept :
+        m_pAllocator{&Allocator},
+        m_PageSize{PageSize}
+    {}
+
+    // clang-format off
+    InternedStringPool           (const InternedStringPool&) = delete;
+    InternedStringPool& operator=(const InternedStringPool&) = delete;
+    // clang-format on
+
+    InternedStringPool(InternedStringPool&& Pool) noexcept :
+        // clang-format off
+        m_Strings      {std::move(Pool.m_Strings)},
+        m_Pages        {std::move(Pool.m_Pages)  },
+        m_pCurrPtr     {Pool.m_pCurrPtr          },
+        m_RemainingSize{Pool.m_RemainingSize     },
+        m_pAllocator   {Pool.m_pAllocator        },
+        m_PageSize     {Pool.m_PageSize          }
+    // clang-format on
+    {
+        Pool.m_Pages.clear();
+        Pool.m_pCurrPtr      = nullptr;
+        Pool.m_RemainingSize = 0;
+    }
+
+    InternedStringPool& operator=(InternedStringPool&& Pool) noexcept
+    {
+        if (this != &Pool)
+        {
+            Clear();
+            m_Strings       = std::move(Pool.m_Strings);
+            m_Pages         = std::move(Pool.m_Pages);
+            m_pCurrPtr      = Pool.m_pCurrPtr;
+            m_RemainingSize = Pool.m_RemainingSize;
+            m_pAllocator    = Pool.m_pAllocator;
+            m_PageSize      = Pool.m_PageSize;
+
+            Pool.m_Pages.clear();
+            Pool.m_pCurrPtr      = nullptr;
+            Pool.m_RemainingSize = 0;
+        }
+        return *this;
+    }
+
+    ~InternedStringPool()
+    {
+        Clear();
+    }
+
+    /// Returns the handle of the pooled copy of the string, adding the string to the pool if necessary.
+    /// If Str is null, returns an empty handle.
+    InternedString Intern(const Char* Str)
+    {
+        if (Str == nullptr)
+            return {};
+
+        const InternedString Key{Str, CStringHash<Char>{}(Str)};
+
+        auto it = m_Strings.find(Key);
+        if (it != m_Strings.end())
+            return it->first;
+
+        const size_t LenWithNull = strlen(Str) + 1;
+        Char*        pCopy       = AllocateString(LenWithNull);
+        std::memcpy(pCopy, Str, LenWithNull);
+
+        const InternedString Interned{pCopy, Key.GetHash()};
+        m_Strings.emplace(Interned, true);
+        return Interned;
+    }
+
+    InternedString Intern(const String& Str)
+    {
+        return Intern(Str.c_str());
+    }
+
+    /// Returns the handle of the pooled copy of the string, or an empty handle
+    /// if the string is not in the pool.
+    InternedString Find(const Char* Str) const
+    {
+        if (Str == nullptr)
+            return {};
+
+        auto it = m_Strings.find(InternedString{Str, CStringHash<Char>{}(Str)});
+        return it != m_Strings.end() ? it->first : InternedString{};
+    }
+
+    /// Returns the number of unique strings in the pool.
+    size_t GetNumStrings() const noexcept
+    {
+        return m_Strings.size();
+    }
+
+    /// Releases all strings. All handles become invalid.
+    void Clear()
+    {
+        m_Strings.clear();
+        for (Char* pPage : m_Pages)
+            m_pAllocator->Free(pPage);
+        m_Pages.clear();
+        m_pCurrPtr      = nullptr;
+        m_RemainingSize = 0;
+    }
+
+private:
+    Char* AllocateString(size_t LenWithNull)
+    {
+        if (LenWithNull > m_RemainingSize)
+        {
+            const size_t PageSize = (std::max)(m_PageSize, LenWithNull);
+            m_pCurrPtr            = reinterpret_cast<Char*>(m_pAllocator->Allocate(PageSize, "Interned string pool page", __FILE__, __LINE__));
+            m_RemainingSize       = PageSize;
+            m_Pages.push_back(m_pCurrPtr);
+        }
+
+        Char* Ptr = m_pCurrPtr;
+        m_pCurrPtr += LenWithNull;
+        m_RemainingSize -= LenWithNull;
+        return Ptr;
+    }
+
+    struct StringEqual
+    {
+        bool operator()(const InternedString& Str1, const InternedString& Str2) const noexcept
+        {
+            return Str1.GetStr() == Str2.GetStr() ||
+                (Str1.GetHash() == Str2.GetHash() && strcmp(Str1.GetStr(), Str2.GetStr()) == 0);
+        }
+    };
+
+    // The map is used as a set: values are not used.
+    FlatHashMap<InternedString, bool, InternedString::Hasher, StringEqual> m_Strings;
+
+    std::vector<Char*> m_Pages;
+    Char*              m_pCurrPtr      = nullptr;
+    size_t             m_RemainingSize = 0;
+    IMemoryAllocator*  m_pAllocator    = nullptr;
+    size_t             m_PageSize      = 0;
+};
+
 } // namespace Diligent
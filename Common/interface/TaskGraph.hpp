@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::TaskGraph class
+
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Task graph built on top of the thread pool.
+
+/// The graph consists of tasks connected by explicit dependency edges.
+/// Unlike the prerequisites passed to IThreadPool::EnqueueTask(), which are
+/// checked by polling, every task in the graph keeps a counter of unfinished
+/// prerequisites, and the task is only enqueued into the thread pool when its
+/// last prerequisite is finished. Thus tasks are never re-queued while waiting
+/// for their dependencies.
+///
+/// Usage example:
+///
+///     TaskGraph Graph{pThreadPool};
+///     const auto Shader    = Graph.AddAsyncWork([](Uint32 ThreadId) { ...; return ASYNC_TASK_STATUS_COMPLETE; });
+///     const auto Signature = Graph.AddAsyncWork([](Uint32 ThreadId) { ...; return ASYNC_TASK_STATUS_COMPLETE; });
+///     const auto PSO       = Graph.AddAsyncWork([](Uint32 ThreadId) { ...; return ASYNC_TASK_STATUS_COMPLETE; });
+///     Graph.AddDependency(PSO, Shader);
+///     Graph.AddDependency(PSO, Signature);
+///     Graph.Execute();
+///     Graph.WaitForCompletion();
+///
+/// \remarks    A task is considered finished when it is either complete or cancelled.
+///             Dependent tasks are started in both cases.
+///
+///             The graph object may be safely destroyed while the tasks are running.
+///             The thread pool, however, must be kept alive until all tasks are finished.
+class TaskGraph
+{
+public:
+    explicit TaskGraph(IThreadPool* pThreadPool);
+    ~TaskGraph();
+
+    // clang-format off
+    TaskGraph           (const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+    TaskGraph           (TaskGraph&&)      = delete;
+    TaskGraph& operator=(TaskGraph&&)      = delete;
+    // clang-format on
+
+    /// Adds the task to the graph and returns its index.
+
+    /// \remarks    The task must not be enqueued into the thread pool by the application.
+    Uint32 AddTask(IAsyncTask* pTask);
+
+    /// Adds the task that executes the handler function, see Diligent::CreateAsyncTask().
+    template <typename HanlderType>
+    Uint32 AddAsyncWork(HanlderType Handler, float fPriority = 0)
+    {
+        return AddTask(CreateAsyncTask(std::move(Handler), fPriority));
+    }
+
+    /// Makes the task depend on the prerequisite task, so that it will only start
+    /// after the prerequisite is finished.
+
+    /// \note   An application must ensure that the dependencies are not circular.
+    void AddDependency(Uint32 Task, Uint32 Prerequisite);
+
+    /// Starts the graph execution by enqueuing all tasks that have no prerequisites.
+
+    /// \remarks    No tasks or dependencies can be added after the graph has been executed.
+    void Execute();
+
+    /// Returns true if all tasks in the graph are finished.
+    bool IsFinished() const;
+
+    /// Blocks the calling thread until all tasks in the graph are finished.
+
+    /// \note   This method must not be called from a task in the graph.
+    void WaitForCompletion() const;
+
+    /// Returns the number of tasks in the graph.
+    Uint32 GetTaskCount() const;
+
+    /// Returns the task with the given index.
+    IAsyncTask* GetTask(Uint32 Task) const;
+
+private:
+    class GraphState;
+    class NodeTask;
+
+    RefCntAutoPtr<GraphState> m_pState;
+};
+
+} // namespace Diligent
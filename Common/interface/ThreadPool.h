@@ -124,6 +124,17 @@ DILIGENT_BEGIN_INTERFACE(IAsyncTask, IObject)
     ///
     ///           This method must not be called from the worker thread.
     VIRTUAL void METHOD(WaitUntilRunning)(THIS) CONST PURE;
+
+    /// Waits until the task is complete or the timeout expires.
+
+    /// \param [in] TimeoutMilliseconds - The maximum time to wait, in milliseconds.
+    ///
+    /// \return     true if the task is finished, and false if the timeout expired.
+    ///
+    /// \note       This method must not be called from the same thread that is
+    ///             running the task.
+    VIRTUAL bool METHOD(WaitForCompletionWithTimeout)(THIS_
+                                                      Uint32 TimeoutMilliseconds) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -131,15 +142,16 @@ DILIGENT_END_INTERFACE
 
 #if DILIGENT_C_INTERFACE
 
-#    define IAsyncTask_Run(This, ...)          CALL_IFACE_METHOD(AsyncTask, Run, This, __VA_ARGS__)
-#    define IAsyncTask_Cancel(This)            CALL_IFACE_METHOD(AsyncTask, Cancel, This)
-#    define IAsyncTask_SetStatus(This, ...)    CALL_IFACE_METHOD(AsyncTask, SetStatus, This, __VA_ARGS__)
-#    define IAsyncTask_GetStatus(This)         CALL_IFACE_METHOD(AsyncTask, GetStatus, This)
-#    define IAsyncTask_SetPriority(This, ...)  CALL_IFACE_METHOD(AsyncTask, SetPriority, This, __VA_ARGS__)
-#    define IAsyncTask_GetPriority(This)       CALL_IFACE_METHOD(AsyncTask, GetPriority, This)
-#    define IAsyncTask_IsFinished(This)        CALL_IFACE_METHOD(AsyncTask, IsFinished, This)
-#    define IAsyncTask_WaitForCompletion(This) CALL_IFACE_METHOD(AsyncTask, WaitForCompletion, This)
-#    define IAsyncTask_WaitUntilRunning(This)  CALL_IFACE_METHOD(AsyncTask, WaitUntilRunning, This)
+#    define IAsyncTask_Run(This, ...)                          CALL_IFACE_METHOD(AsyncTask, Run, This, __VA_ARGS__)
+#    define IAsyncTask_Cancel(This)                            CALL_IFACE_METHOD(AsyncTask, Cancel, This)
+#    define IAsyncTask_SetStatus(This, ...)                    CALL_IFACE_METHOD(AsyncTask, SetStatus, This, __VA_ARGS__)
+#    define IAsyncTask_GetStatus(This)                         CALL_IFACE_METHOD(AsyncTask, GetStatus, This)
+#    define IAsyncTask_SetPriority(This, ...)                  CALL_IFACE_METHOD(AsyncTask, SetPriority, This, __VA_ARGS__)
+#    define IAsyncTask_GetPriority(This)                       CALL_IFACE_METHOD(AsyncTask, GetPriority, This)
+#    define IAsyncTask_IsFinished(This)                        CALL_IFACE_METHOD(AsyncTask, IsFinished, This)
+#    define IAsyncTask_WaitForCompletion(This)                 CALL_IFACE_METHOD(AsyncTask, WaitForCompletion, This)
+#    define IAsyncTask_WaitUntilRunning(This)                  CALL_IFACE_METHOD(AsyncTask, WaitUntilRunning, This)
+#    define IAsyncTask_WaitForCompletionWithTimeout(This, ...) CALL_IFACE_METHOD(AsyncTask, WaitForCompletionWithTimeout, This, __VA_ARGS__)
 
 #endif
 
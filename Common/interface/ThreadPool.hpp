@@ -29,10 +29,14 @@
 #include "ThreadPool.h"
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <thread>
 
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../Platforms/Basic/interface/BasicPlatformMisc.hpp"
 
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
@@ -40,6 +44,26 @@
 namespace Diligent
 {
 
+/// Worker thread core placement policy
+enum class ThreadPoolCorePlacement
+{
+    /// Worker threads may run on any core.
+    Any,
+
+    /// Worker threads are restricted to the performance cores (Intel P-cores, ARM big cores).
+    /// This is a good choice for latency-critical work such as command list recording.
+    PerformanceCores,
+
+    /// Worker threads are restricted to the efficiency cores (Intel E-cores, ARM LITTLE cores).
+    /// This is a good choice for background work such as shader compilation that should not
+    /// compete with the render thread for the performance cores.
+    EfficiencyCores,
+
+    /// Worker threads are restricted to one logical core per physical core,
+    /// so that they do not share a core with SMT siblings.
+    PhysicalCores
+};
+
 /// Thread pool create information
 struct ThreadPoolCreateInfo
 {
@@ -58,8 +82,45 @@ struct ThreadPoolCreateInfo
     /// An optional function that will be called by the thread pool from
     /// the worker thread before the worker thread exits.
     std::function<void(Uint32)> OnThreadExiting = nullptr;
+
+    /// Whether to use the work-stealing scheduler.
+
+    /// \remarks    By default, all tasks are kept in a single priority queue protected
+    ///             by one mutex, and the tasks are always started in the strict priority order.
+    ///             When work stealing is enabled, every worker thread owns a separate
+    ///             queue with its own lock, where tasks are grouped into priority buckets.
+    ///             Tasks enqueued from a worker thread are added to that thread's queue, while
+    ///             other tasks are distributed between the queues in a round-robin fashion.
+    ///             A worker thread that runs out of tasks steals tasks from other queues.
+    ///
+    ///             The priority order is only guaranteed within a single queue, so the
+    ///             work-stealing mode trades strict global ordering for lower contention.
+    ///
+    ///             If the pool is created with zero threads, the number of queues is set
+    ///             to the number of hardware threads, and the application should use
+    ///             distinct thread ids when calling IThreadPool::ProcessTask().
+    bool EnableWorkStealing = false;
+
+    /// Worker thread core placement policy.
+
+    /// \remarks    The affinity of every worker thread is set to the cores selected by the
+    ///             policy, as reported by PlatformMisc::GetCPUTopology(), before OnThreadStarted
+    ///             is called. On CPUs that don't have the requested core type (e.g. efficiency
+    ///             cores on a non-hybrid CPU), worker threads are allowed to run on all cores.
+    ///             Placement is ignored on platforms that do not support thread affinity.
+    ThreadPoolCorePlacement CorePlacement = ThreadPoolCorePlacement::Any;
+
+    /// Worker thread priority.
+
+    /// \remarks    If the priority is ThreadPriority::Unknown, the priority of the worker
+    ///             threads is not changed.
+    ThreadPriority WorkerThreadPriority = ThreadPriority::Unknown;
 };
 
+/// Returns the mask of the logical cores selected by the given placement policy,
+/// or 0 if the policy does not restrict the cores.
+Uint64 GetThreadPoolCoresMask(ThreadPoolCorePlacement CorePlacement);
+
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI);
 
 /// Pins the worker thread to one of the allowed cores.
@@ -133,6 +194,20 @@ public:
         }
 #endif
         m_TaskStatus.store(TaskStatus);
+
+        // NB: the status must be stored before the number of waiters is checked, see WaitForStatus().
+        if (m_NumWaiters.load() > 0)
+        {
+            {
+                // Lock the mutex to make sure that the waiting thread is either blocked
+                // on the condition variable or has not checked the status yet.
+                std::lock_guard<std::mutex> Lock{m_StatusMtx};
+            }
+            m_StatusCond.notify_all();
+        }
+
+        if (TaskStatus >= ASYNC_TASK_STATUS_CANCELLED)
+            NotifyTaskFinished();
     }
 
     virtual ASYNC_TASK_STATUS DILIGENT_CALL_TYPE GetStatus() const override final
@@ -159,34 +234,125 @@ public:
 
     virtual void DILIGENT_CALL_TYPE WaitForCompletion() const override final
     {
-        while (!IsFinished())
-            std::this_thread::yield();
+        WaitForStatus([this]() { return IsFinished(); }, InfiniteTimeout);
     }
 
     virtual void DILIGENT_CALL_TYPE WaitUntilRunning() const override final
     {
-        while (GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED)
-            std::this_thread::yield();
+        WaitForStatus([this]() { return GetStatus() != ASYNC_TASK_STATUS_NOT_STARTED; }, InfiniteTimeout);
     }
 
+    virtual bool DILIGENT_CALL_TYPE WaitForCompletionWithTimeout(Uint32 TimeoutMilliseconds) const override final
+    {
+        return WaitForStatus([this]() { return IsFinished(); }, TimeoutMilliseconds);
+    }
+
+    static constexpr Uint32 InfiniteTimeout = ~0u;
+
 protected:
     std::atomic<bool> m_bSafelyCancel{false};
 
+private:
+    // Waits until the predicate returns true or the timeout expires.
+    // The thread first spins for a short time, since the task may be about to finish,
+    // and then blocks on the condition variable, which is notified by SetStatus().
+    template <typename PredicateType>
+    bool WaitForStatus(PredicateType&& Predicate, Uint32 TimeoutMilliseconds) const
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const auto StartTime = Clock::now();
+
+        constexpr auto SpinDuration = std::chrono::microseconds{50};
+        for (Uint32 Iteration = 0; !Predicate(); ++Iteration)
+        {
+            // Check the time every few iterations only
+            if ((Iteration % 16) == 15 && Clock::now() - StartTime >= SpinDuration)
+            {
+                // Increment the number of waiters before checking the predicate under the mutex.
+                // If SetStatus() has not seen the waiter, we will see the new status.
+                m_NumWaiters.fetch_add(1);
+
+                bool Result = true;
+                {
+                    std::unique_lock<std::mutex> Lock{m_StatusMtx};
+                    if (TimeoutMilliseconds == InfiniteTimeout)
+                        m_StatusCond.wait(Lock, Predicate);
+                    else
+                        Result = m_StatusCond.wait_until(Lock, StartTime + std::chrono::milliseconds{TimeoutMilliseconds}, Predicate);
+                }
+
+                m_NumWaiters.fetch_add(-1);
+                return Result;
+            }
+
+            if (TimeoutMilliseconds == 0)
+                return false;
+
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    // Wakes up the threads waiting in WaitForAnyTask() and WaitForAllTasks().
+    static void NotifyTaskFinished();
+
 private:
     std::atomic<float>             m_fPriority{0};
     std::atomic<ASYNC_TASK_STATUS> m_TaskStatus{ASYNC_TASK_STATUS_NOT_STARTED};
+
+    mutable std::mutex              m_StatusMtx;
+    mutable std::condition_variable m_StatusCond;
+    mutable std::atomic<int>        m_NumWaiters{0};
 };
 
 
-/// Enqueues a function to be executed asynchronously by the thread pool.
-/// For the list of parameters, see Diligent::IThreadPool::EnqueueTask() method.
+/// Waits until all tasks in the array are finished or the timeout expires.
+
+/// \param [in] ppTasks             - Array of tasks to wait for. Null entries are ignored.
+/// \param [in] NumTasks            - The number of tasks in the array.
+/// \param [in] TimeoutMilliseconds - The maximum time to wait, in milliseconds.
+///
+/// \return     true if all tasks are finished, and false if the timeout expired.
+bool WaitForAllTasks(IAsyncTask* const* ppTasks,
+                     Uint32             NumTasks,
+                     Uint32             TimeoutMilliseconds = AsyncTaskBase::InfiniteTimeout);
+
+/// Waits until any task in the array is finished or the timeout expires.
+
+/// \param [in] ppTasks             - Array of tasks to wait for. Null entries are ignored.
+/// \param [in] NumTasks            - The number of tasks in the array.
+/// \param [in] TimeoutMilliseconds - The maximum time to wait, in milliseconds.
+///
+/// \return     The index of the first finished task in the array, or -1 if the timeout expired
+///             or the array contains no tasks.
+///
+/// \remarks    Tasks derived from AsyncTaskBase wake up the waiting thread as soon as they finish.
+///             Other implementations of IAsyncTask are periodically polled.
+int WaitForAnyTask(IAsyncTask* const* ppTasks,
+                   Uint32             NumTasks,
+                   Uint32             TimeoutMilliseconds = AsyncTaskBase::InfiniteTimeout);
+
+/// Calls the handler for every item on the thread pool threads and on the calling thread,
+/// and returns when all items have been processed.
+
+/// \param [in] pThreadPool - Thread pool to run the items on.
+/// \param [in] NumItems    - The number of items.
+/// \param [in] Handler     - Function that is called for every item index.
+///
+/// \remarks   The calling thread processes the items that have not been picked up by the pool threads,
+///            so the function never waits for a task that has not started. This makes it safe
+///            to call the function from a pool thread or when all pool threads are busy.
+///            The first exception thrown by the handler is rethrown after all items are complete.
+void ProcessItemsInParallel(IThreadPool* pThreadPool, size_t NumItems, std::function<void(size_t)> Handler) noexcept(false);
+
+
+/// Creates an asynchronous task that executes the handler function.
 /// The handler function must return the task status, see Diligent::IAsyncTask::Run() method.
 template <typename HanlderType>
-RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool,
-                                           IAsyncTask** ppPrerequisites,
-                                           Uint32       NumPrerequisites,
-                                           HanlderType  Handler,
-                                           float        fPriority = 0)
+RefCntAutoPtr<IAsyncTask> CreateAsyncTask(HanlderType Handler,
+                                          float       fPriority = 0)
 {
     class TaskImpl final : public AsyncTaskBase
     {
@@ -209,7 +375,20 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool,
         HanlderType m_Handler;
     };
 
-    RefCntAutoPtr<TaskImpl> pTask{MakeNewRCObj<TaskImpl>()(fPriority, std::move(Handler))};
+    return RefCntAutoPtr<IAsyncTask>{MakeNewRCObj<TaskImpl>()(fPriority, std::move(Handler))};
+}
+
+/// Enqueues a function to be executed asynchronously by the thread pool.
+/// For the list of parameters, see Diligent::IThreadPool::EnqueueTask() method.
+/// The handler function must return the task status, see Diligent::IAsyncTask::Run() method.
+template <typename HanlderType>
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool,
+                                           IAsyncTask** ppPrerequisites,
+                                           Uint32       NumPrerequisites,
+                                           HanlderType  Handler,
+                                           float        fPriority = 0)
+{
+    RefCntAutoPtr<IAsyncTask> pTask = CreateAsyncTask(std::move(Handler), fPriority);
     pThreadPool->EnqueueTask(pTask, ppPrerequisites, NumPrerequisites);
 
     return pTask;
@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::TrackingMemoryAllocator class
+
+#include "../../Primitives/interface/MemoryAllocator.h"
+
+/// Allocation counters are only updated in debug and development builds.
+/// In other builds, TrackingMemoryAllocator simply forwards all calls to the wrapped allocator.
+#if defined(DILIGENT_DEBUG) || defined(DILIGENT_DEVELOPMENT)
+#    define DILIGENT_ALLOCATION_TRACKING_ENABLED 1
+#else
+#    define DILIGENT_ALLOCATION_TRACKING_ENABLED 0
+#endif
+
+namespace Diligent
+{
+
+/// Heap allocation counters of a single thread.
+struct AllocationCounters
+{
+    /// The total number of allocations.
+    Uint64 NumAllocations = 0;
+
+    /// The total number of deallocations.
+    Uint64 NumFrees = 0;
+
+    /// The total number of bytes allocated.
+    Uint64 AllocatedBytes = 0;
+};
+
+/// Memory allocator that counts the allocations made by every thread and forwards them to another allocator.
+
+/// The allocator can be passed as EngineCreateInfo::pRawMemAllocator to track the allocations
+/// made by the engine. The counters are kept per thread, so that the allocations made on the
+/// thread that records the commands can be checked without synchronization, e.g.:
+///
+///     const AllocationCounters Start = TrackingMemoryAllocator::GetThreadCounters();
+///     RenderFrame();
+///     const Uint64 NumAllocations = TrackingMemoryAllocator::GetThreadCounters().NumAllocations - Start.NumAllocations;
+///
+/// Allocations that do not go through the allocator (e.g. std containers) can be reported
+/// with RecordAllocation() and RecordFree(), for instance from the replaced global operator new.
+class TrackingMemoryAllocator final : public IMemoryAllocator
+{
+public:
+    explicit TrackingMemoryAllocator(IMemoryAllocator& Allocator) noexcept :
+        m_Allocator{Allocator}
+    {}
+
+    // clang-format off
+    TrackingMemoryAllocator           (const TrackingMemoryAllocator&) = delete;
+    TrackingMemoryAllocator           (TrackingMemoryAllocator&&)      = delete;
+    TrackingMemoryAllocator& operator=(const TrackingMemoryAllocator&) = delete;
+    TrackingMemoryAllocator& operator=(TrackingMemoryAllocator&&)      = delete;
+    // clang-format on
+
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    virtual void Free(void* Ptr) override final;
+
+    virtual void* AllocateAligned(size_t Size, size_t Alignment, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    virtual void FreeAligned(void* Ptr) override final;
+
+    /// Returns the counters of the calling thread.
+    static AllocationCounters GetThreadCounters();
+
+    /// Records an allocation of the given size made by the calling thread.
+    static void RecordAllocation(size_t Size);
+
+    /// Records a deallocation made by the calling thread.
+    static void RecordFree();
+
+    /// Returns true if the counters are updated in this build.
+    static constexpr bool IsEnabled()
+    {
+        return DILIGENT_ALLOCATION_TRACKING_ENABLED != 0;
+    }
+
+private:
+    IMemoryAllocator& m_Allocator;
+};
+
+} // namespace Diligent
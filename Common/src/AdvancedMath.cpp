@@ -0,0 +1,327 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "AdvancedMath.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "Intrinsics.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct FrustumPlanesSOA
+{
+    Uint32 NumPlanes = 0;
+
+    float Nx[ViewFrustum::NUM_PLANES];
+    float Ny[ViewFrustum::NUM_PLANES];
+    float Nz[ViewFrustum::NUM_PLANES];
+    float AbsNx[ViewFrustum::NUM_PLANES];
+    float AbsNy[ViewFrustum::NUM_PLANES];
+    float AbsNz[ViewFrustum::NUM_PLANES];
+    float D[ViewFrustum::NUM_PLANES];
+
+    FrustumPlanesSOA(const ViewFrustum& Frustum, FRUSTUM_PLANE_FLAGS PlaneFlags)
+    {
+        for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+        {
+            if ((PlaneFlags & (1 << plane_idx)) == 0)
+                continue;
+
+            const Plane3D& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+
+            Nx[NumPlanes]    = Plane.Normal.x;
+            Ny[NumPlanes]    = Plane.Normal.y;
+            Nz[NumPlanes]    = Plane.Normal.z;
+            AbsNx[NumPlanes] = std::abs(Plane.Normal.x);
+            AbsNy[NumPlanes] = std::abs(Plane.Normal.y);
+            AbsNz[NumPlanes] = std::abs(Plane.Normal.z);
+            D[NumPlanes]     = Plane.Distance;
+            ++NumPlanes;
+        }
+    }
+};
+
+// NB: all implementations below must perform the same operations in the same order as
+//     GetBoxVisibilityAgainstPlane(const Plane3D&, const BoundBox&) to produce identical results.
+
+BoxVisibility GetBoxVisibilityScalar(const FrustumPlanesSOA& Planes, const BoundBoxSOA& Boxes, size_t i)
+{
+    const float SumX  = Boxes.MaxX[i] + Boxes.MinX[i];
+    const float SumY  = Boxes.MaxY[i] + Boxes.MinY[i];
+    const float SumZ  = Boxes.MaxZ[i] + Boxes.MinZ[i];
+    const float DiffX = Boxes.MaxX[i] - Boxes.MinX[i];
+    const float DiffY = Boxes.MaxY[i] - Boxes.MinY[i];
+    const float DiffZ = Boxes.MaxZ[i] - Boxes.MinZ[i];
+
+    bool AllInside = true;
+    for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+    {
+        const float DistanceToCenter = (SumX * Planes.Nx[p] + SumY * Planes.Ny[p] + SumZ * Planes.Nz[p]) * 0.5f + Planes.D[p];
+        const float ProjHalfLen      = (DiffX * Planes.AbsNx[p] + DiffY * Planes.AbsNy[p] + DiffZ * Planes.AbsNz[p]) * 0.5f;
+        if (DistanceToCenter < -ProjHalfLen)
+            return BoxVisibility::Invisible;
+        if (!(DistanceToCenter > ProjHalfLen))
+            AllInside = false;
+    }
+    return AllInside ? BoxVisibility::FullyVisible : BoxVisibility::Intersecting;
+}
+
+// Writes the results for the boxes [Start, Start + Count)
+// Visible and Inside are the bit masks of the boxes that are visible and fully inside the frustum.
+inline void WriteResults(size_t Start, size_t Count, Uint32 Visible, Uint32 Inside, BoxVisibility* pVisibility, Uint32* pVisibilityMask)
+{
+    if (pVisibility != nullptr)
+    {
+        for (size_t j = 0; j < Count; ++j)
+        {
+            const Uint32 Bit = 1u << j;
+            pVisibility[Start + j] =
+                (Visible & Bit) == 0 ? BoxVisibility::Invisible :
+                (Inside & Bit) != 0  ? BoxVisibility::FullyVisible :
+                                       BoxVisibility::Intersecting;
+        }
+    }
+
+    if (pVisibilityMask != nullptr)
+    {
+        // NB: Start is always a multiple of the batch size, which divides 32
+        const size_t Word  = Start / 32;
+        const size_t Shift = Start % 32;
+        if (Shift == 0)
+            pVisibilityMask[Word] = 0;
+        pVisibilityMask[Word] |= Visible << Shift;
+    }
+}
+
+#if DILIGENT_AVX2_ENABLED
+
+constexpr size_t BatchSize = 8;
+
+size_t GetBoxVisibilitySIMD(const FrustumPlanesSOA& Planes, const BoundBoxSOA& Boxes, size_t NumBoxes, BoxVisibility* pVisibility, Uint32* pVisibilityMask)
+{
+    const __m256 Half = _mm256_set1_ps(0.5f);
+    const __m256 Zero = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + BatchSize <= NumBoxes; i += BatchSize)
+    {
+        const __m256 MinX = _mm256_loadu_ps(Boxes.MinX + i);
+        const __m256 MinY = _mm256_loadu_ps(Boxes.MinY + i);
+        const __m256 MinZ = _mm256_loadu_ps(Boxes.MinZ + i);
+        const __m256 MaxX = _mm256_loadu_ps(Boxes.MaxX + i);
+        const __m256 MaxY = _mm256_loadu_ps(Boxes.MaxY + i);
+        const __m256 MaxZ = _mm256_loadu_ps(Boxes.MaxZ + i);
+
+        const __m256 SumX  = _mm256_add_ps(MaxX, MinX);
+        const __m256 SumY  = _mm256_add_ps(MaxY, MinY);
+        const __m256 SumZ  = _mm256_add_ps(MaxZ, MinZ);
+        const __m256 DiffX = _mm256_sub_ps(MaxX, MinX);
+        const __m256 DiffY = _mm256_sub_ps(MaxY, MinY);
+        const __m256 DiffZ = _mm256_sub_ps(MaxZ, MinZ);
+
+        __m256 Outside = _mm256_setzero_ps();
+        __m256 Inside  = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+        {
+            __m256 Dist = _mm256_mul_ps(SumX, _mm256_set1_ps(Planes.Nx[p]));
+            Dist        = _mm256_add_ps(Dist, _mm256_mul_ps(SumY, _mm256_set1_ps(Planes.Ny[p])));
+            Dist        = _mm256_add_ps(Dist, _mm256_mul_ps(SumZ, _mm256_set1_ps(Planes.Nz[p])));
+            Dist        = _mm256_add_ps(_mm256_mul_ps(Dist, Half), _mm256_set1_ps(Planes.D[p]));
+
+            __m256 HalfLen = _mm256_mul_ps(DiffX, _mm256_set1_ps(Planes.AbsNx[p]));
+            HalfLen        = _mm256_add_ps(HalfLen, _mm256_mul_ps(DiffY, _mm256_set1_ps(Planes.AbsNy[p])));
+            HalfLen        = _mm256_add_ps(HalfLen, _mm256_mul_ps(DiffZ, _mm256_set1_ps(Planes.AbsNz[p])));
+            HalfLen        = _mm256_mul_ps(HalfLen, Half);
+
+            Outside = _mm256_or_ps(Outside, _mm256_cmp_ps(Dist, _mm256_sub_ps(Zero, HalfLen), _CMP_LT_OQ));
+            Inside  = _mm256_and_ps(Inside, _mm256_cmp_ps(Dist, HalfLen, _CMP_GT_OQ));
+        }
+
+        const Uint32 Visible = ~static_cast<Uint32>(_mm256_movemask_ps(Outside)) & 0xFFu;
+        WriteResults(i, BatchSize, Visible, static_cast<Uint32>(_mm256_movemask_ps(Inside)), pVisibility, pVisibilityMask);
+    }
+    return i;
+}
+
+#elif DILIGENT_SSE2_ENABLED
+
+constexpr size_t BatchSize = 4;
+
+size_t GetBoxVisibilitySIMD(const FrustumPlanesSOA& Planes, const BoundBoxSOA& Boxes, size_t NumBoxes, BoxVisibility* pVisibility, Uint32* pVisibilityMask)
+{
+    const __m128 Half = _mm_set1_ps(0.5f);
+    const __m128 Zero = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + BatchSize <= NumBoxes; i += BatchSize)
+    {
+        const __m128 MinX = _mm_loadu_ps(Boxes.MinX + i);
+        const __m128 MinY = _mm_loadu_ps(Boxes.MinY + i);
+        const __m128 MinZ = _mm_loadu_ps(Boxes.MinZ + i);
+        const __m128 MaxX = _mm_loadu_ps(Boxes.MaxX + i);
+        const __m128 MaxY = _mm_loadu_ps(Boxes.MaxY + i);
+        const __m128 MaxZ = _mm_loadu_ps(Boxes.MaxZ + i);
+
+        const __m128 SumX  = _mm_add_ps(MaxX, MinX);
+        const __m128 SumY  = _mm_add_ps(MaxY, MinY);
+        const __m128 SumZ  = _mm_add_ps(MaxZ, MinZ);
+        const __m128 DiffX = _mm_sub_ps(MaxX, MinX);
+        const __m128 DiffY = _mm_sub_ps(MaxY, MinY);
+        const __m128 DiffZ = _mm_sub_ps(MaxZ, MinZ);
+
+        __m128 Outside = _mm_setzero_ps();
+        __m128 Inside  = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+        {
+            __m128 Dist = _mm_mul_ps(SumX, _mm_set1_ps(Planes.Nx[p]));
+            Dist        = _mm_add_ps(Dist, _mm_mul_ps(SumY, _mm_set1_ps(Planes.Ny[p])));
+            Dist        = _mm_add_ps(Dist, _mm_mul_ps(SumZ, _mm_set1_ps(Planes.Nz[p])));
+            Dist        = _mm_add_ps(_mm_mul_ps(Dist, Half), _mm_set1_ps(Planes.D[p]));
+
+            __m128 HalfLen = _mm_mul_ps(DiffX, _mm_set1_ps(Planes.AbsNx[p]));
+            HalfLen        = _mm_add_ps(HalfLen, _mm_mul_ps(DiffY, _mm_set1_ps(Planes.AbsNy[p])));
+            HalfLen        = _mm_add_ps(HalfLen, _mm_mul_ps(DiffZ, _mm_set1_ps(Planes.AbsNz[p])));
+            HalfLen        = _mm_mul_ps(HalfLen, Half);
+
+            Outside = _mm_or_ps(Outside, _mm_cmplt_ps(Dist, _mm_sub_ps(Zero, HalfLen)));
+            Inside  = _mm_and_ps(Inside, _mm_cmpgt_ps(Dist, HalfLen));
+        }
+
+        const Uint32 Visible = ~static_cast<Uint32>(_mm_movemask_ps(Outside)) & 0xFu;
+        WriteResults(i, BatchSize, Visible, static_cast<Uint32>(_mm_movemask_ps(Inside)), pVisibility, pVisibilityMask);
+    }
+    return i;
+}
+
+#endif
+
+} // namespace
+
+void GetBoxVisibilityBatch(const ViewFrustum&  Frustum,
+                           const BoundBoxSOA&  Boxes,
+                           size_t              NumBoxes,
+                           BoxVisibility*      pVisibility,
+                           Uint32*             pVisibilityMask,
+                           FRUSTUM_PLANE_FLAGS PlaneFlags)
+{
+    if (NumBoxes == 0)
+        return;
+
+    DEV_CHECK_ERR(Boxes.MinX != nullptr && Boxes.MinY != nullptr && Boxes.MinZ != nullptr &&
+                      Boxes.MaxX != nullptr && Boxes.MaxY != nullptr && Boxes.MaxZ != nullptr,
+                  "Bounding box data must not be null");
+
+    const FrustumPlanesSOA Planes{Frustum, PlaneFlags};
+
+    size_t i = 0;
+#if DILIGENT_AVX2_ENABLED || DILIGENT_SSE2_ENABLED
+    i = GetBoxVisibilitySIMD(Planes, Boxes, NumBoxes, pVisibility, pVisibilityMask);
+#endif
+
+    // Process the remaining boxes
+    for (; i < NumBoxes; ++i)
+    {
+        const BoxVisibility Visibility = GetBoxVisibilityScalar(Planes, Boxes, i);
+        if (pVisibility != nullptr)
+            pVisibility[i] = Visibility;
+        if (pVisibilityMask != nullptr)
+        {
+            const Uint32 Bit = 1u << (i % 32);
+            if (i % 32 == 0)
+                pVisibilityMask[i / 32] = 0;
+            if (Visibility != BoxVisibility::Invisible)
+                pVisibilityMask[i / 32] |= Bit;
+            else
+                pVisibilityMask[i / 32] &= ~Bit;
+        }
+    }
+}
+
+void GetBoxVisibilityBatchParallel(IThreadPool*        pThreadPool,
+                                   const ViewFrustum&  Frustum,
+                                   const BoundBoxSOA&  Boxes,
+                                   size_t              NumBoxes,
+                                   BoxVisibility*      pVisibility,
+                                   Uint32*             pVisibilityMask,
+                                   FRUSTUM_PLANE_FLAGS PlaneFlags,
+                                   size_t              BoxesPerTask)
+{
+    // The chunks must start at 32-box boundaries so that the tasks never write to the same mask element
+    BoxesPerTask = AlignUp(std::max(BoxesPerTask, size_t{1}), size_t{32});
+
+    if (pThreadPool == nullptr || NumBoxes <= BoxesPerTask)
+    {
+        GetBoxVisibilityBatch(Frustum, Boxes, NumBoxes, pVisibility, pVisibilityMask, PlaneFlags);
+        return;
+    }
+
+    auto ProcessChunk = [&Frustum, Boxes, NumBoxes, pVisibility, pVisibilityMask, PlaneFlags](size_t Start, size_t Count) {
+        VERIFY_EXPR(Start % 32 == 0 && Start + Count <= NumBoxes);
+        BoundBoxSOA Chunk;
+        Chunk.MinX = Boxes.MinX + Start;
+        Chunk.MinY = Boxes.MinY + Start;
+        Chunk.MinZ = Boxes.MinZ + Start;
+        Chunk.MaxX = Boxes.MaxX + Start;
+        Chunk.MaxY = Boxes.MaxY + Start;
+        Chunk.MaxZ = Boxes.MaxZ + Start;
+        GetBoxVisibilityBatch(Frustum, Chunk, Count,
+                              pVisibility != nullptr ? pVisibility + Start : nullptr,
+                              pVisibilityMask != nullptr ? pVisibilityMask + Start / 32 : nullptr,
+                              PlaneFlags);
+    };
+
+    const size_t NumChunks = (NumBoxes + BoxesPerTask - 1) / BoxesPerTask;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumChunks - 1);
+    for (size_t chunk = 1; chunk < NumChunks; ++chunk)
+    {
+        const size_t Start = chunk * BoxesPerTask;
+        const size_t Count = std::min(BoxesPerTask, NumBoxes - Start);
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [ProcessChunk, Start, Count](Uint32 ThreadId) {
+                                                ProcessChunk(Start, Count);
+                                                return ASYNC_TASK_STATUS_COMPLETE;
+                                            }));
+    }
+
+    // Process the first chunk on this thread
+    ProcessChunk(0, BoxesPerTask);
+
+    std::vector<IAsyncTask*> pTasks(Tasks.size());
+    for (size_t i = 0; i < Tasks.size(); ++i)
+        pTasks[i] = Tasks[i];
+    WaitForAllTasks(pTasks.data(), static_cast<Uint32>(pTasks.size()));
+}
+
+} // namespace Diligent
@@ -0,0 +1,438 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BVH.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 MaxBins = 32;
+
+inline float GetHalfArea(const BoundBox& Box)
+{
+    const float3 Size = Box.Max - Box.Min;
+    return (Size.x < 0 || Size.y < 0 || Size.z < 0) ? 0.f : Size.x * Size.y + Size.y * Size.z + Size.z * Size.x;
+}
+
+inline BoundBox GetEmptyBox()
+{
+    return BoundBox{float3{+FLT_MAX, +FLT_MAX, +FLT_MAX}, float3{-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+}
+
+inline void Enclose(BoundBox& Box, const BoundBox& Other)
+{
+    Box.Min = (std::min)(Box.Min, Other.Min);
+    Box.Max = (std::max)(Box.Max, Other.Max);
+}
+
+inline void Enclose(BoundBox& Box, const float3& Point)
+{
+    Box.Min = (std::min)(Box.Min, Point);
+    Box.Max = (std::max)(Box.Max, Point);
+}
+
+// Builds the binary tree using the binned SAH
+class BinaryTreeBuilder
+{
+public:
+    struct Node
+    {
+        BoundBox Bounds;
+
+        // Index of the first child. The second child immediately follows it.
+        Uint32 FirstChild = BVH::InvalidIndex;
+
+        Uint32 FirstPrimitive = 0;
+        Uint32 NumPrimitives  = 0;
+
+        bool IsLeaf() const { return FirstChild == BVH::InvalidIndex; }
+    };
+
+    BinaryTreeBuilder(const BoundBox*      pPrimitiveBoxes,
+                      Uint32               NumPrimitives,
+                      const BVH::BuildInfo& Info,
+                      std::vector<Uint32>& PrimitiveIndices) :
+        m_pBoxes{pPrimitiveBoxes},
+        m_Info{Info},
+        m_PrimitiveIndices{PrimitiveIndices},
+        m_Centroids(NumPrimitives),
+        // A binary tree with N leaves has 2 * N - 1 nodes
+        m_Nodes(size_t{NumPrimitives} * 2)
+    {
+        m_Info.MaxLeafSize = std::max(m_Info.MaxLeafSize, 1u);
+        m_Info.NumBins     = std::min(std::max(m_Info.NumBins, 2u), MaxBins);
+
+        for (Uint32 i = 0; i < NumPrimitives; ++i)
+            m_Centroids[i] = (pPrimitiveBoxes[i].Min + pPrimitiveBoxes[i].Max) * 0.5f;
+
+        m_Nodes[0].FirstPrimitive = 0;
+        m_Nodes[0].NumPrimitives  = NumPrimitives;
+        m_NumNodes.store(1);
+    }
+
+    void Build()
+    {
+        // Split the top of the tree on this thread until the subtrees are small enough,
+        // and then build the subtrees in parallel. The subtrees only write to their own nodes
+        // and ranges of primitive indices, so no synchronization is required.
+        std::vector<std::pair<Uint32, Uint32>> Subtrees; // (Node, Depth)
+        std::vector<std::pair<Uint32, Uint32>> Stack{{0u, 0u}};
+        while (!Stack.empty())
+        {
+            const std::pair<Uint32, Uint32> NodeAndDepth = Stack.back();
+            Stack.pop_back();
+
+            if (m_Info.pThreadPool == nullptr || m_Nodes[NodeAndDepth.first].NumPrimitives <= m_Info.ParallelBuildThreshold)
+            {
+                Subtrees.push_back(NodeAndDepth);
+            }
+            else if (SplitNode(NodeAndDepth.first, NodeAndDepth.second))
+            {
+                const Uint32 FirstChild = m_Nodes[NodeAndDepth.first].FirstChild;
+                Stack.emplace_back(FirstChild, NodeAndDepth.second + 1);
+                Stack.emplace_back(FirstChild + 1, NodeAndDepth.second + 1);
+            }
+        }
+
+        if (m_Info.pThreadPool != nullptr && Subtrees.size() > 1)
+        {
+            ProcessItemsInParallel(m_Info.pThreadPool, Subtrees.size(),
+                                   [&](size_t i) {
+                                       BuildSubtree(Subtrees[i].first, Subtrees[i].second);
+                                   });
+        }
+        else
+        {
+            for (const std::pair<Uint32, Uint32>& Subtree : Subtrees)
+                BuildSubtree(Subtree.first, Subtree.second);
+        }
+
+        m_Nodes.resize(m_NumNodes.load());
+    }
+
+    const std::vector<Node>& GetNodes() const { return m_Nodes; }
+
+private:
+    void BuildSubtree(Uint32 NodeIdx, Uint32 Depth)
+    {
+        if (SplitNode(NodeIdx, Depth))
+        {
+            const Uint32 FirstChild = m_Nodes[NodeIdx].FirstChild;
+            BuildSubtree(FirstChild, Depth + 1);
+            BuildSubtree(FirstChild + 1, Depth + 1);
+        }
+    }
+
+    // Computes the node bounds and splits the node into two children.
+    // Returns false if the node is a leaf.
+    bool SplitNode(Uint32 NodeIdx, Uint32 Depth)
+    {
+        Node& N = m_Nodes[NodeIdx];
+
+        const Uint32 First = N.FirstPrimitive;
+        const Uint32 Count = N.NumPrimitives;
+
+        BoundBox CentroidBounds = GetEmptyBox();
+        N.Bounds                = GetEmptyBox();
+        for (Uint32 i = First; i < First + Count; ++i)
+        {
+            const Uint32 Prim = m_PrimitiveIndices[i];
+            Enclose(N.Bounds, m_pBoxes[Prim]);
+            Enclose(CentroidBounds, m_Centroids[Prim]);
+        }
+
+        if (Count <= m_Info.MaxLeafSize || Depth >= BVH::MaxDepth)
+            return false;
+
+        const Uint32 NumBins = m_Info.NumBins;
+
+        int    BestAxis = -1;
+        Uint32 BestBin  = 0;
+        float  BestCost = FLT_MAX;
+        for (int Axis = 0; Axis < 3; ++Axis)
+        {
+            const float Extent = CentroidBounds.Max[Axis] - CentroidBounds.Min[Axis];
+            if (Extent <= 0)
+                continue;
+
+            BoundBox BinBounds[MaxBins];
+            Uint32   BinCounts[MaxBins] = {};
+            for (Uint32 b = 0; b < NumBins; ++b)
+                BinBounds[b] = GetEmptyBox();
+
+            const float BinScale = static_cast<float>(NumBins) / Extent;
+            for (Uint32 i = First; i < First + Count; ++i)
+            {
+                const Uint32 Prim = m_PrimitiveIndices[i];
+                const Uint32 Bin  = GetBin(m_Centroids[Prim][Axis], CentroidBounds.Min[Axis], BinScale);
+                Enclose(BinBounds[Bin], m_pBoxes[Prim]);
+                ++BinCounts[Bin];
+            }
+
+            // Sweep from the right to compute the cost of the right side of every split
+            float    RightCost[MaxBins];
+            BoundBox RightBounds = GetEmptyBox();
+            Uint32   RightCount  = 0;
+            for (Uint32 b = NumBins - 1; b > 0; --b)
+            {
+                Enclose(RightBounds, BinBounds[b]);
+                RightCount += BinCounts[b];
+                RightCost[b - 1] = GetHalfArea(RightBounds) * static_cast<float>(RightCount);
+            }
+
+            // Split after bin b
+            BoundBox LeftBounds = GetEmptyBox();
+            Uint32   LeftCount  = 0;
+            for (Uint32 b = 0; b + 1 < NumBins; ++b)
+            {
+                Enclose(LeftBounds, BinBounds[b]);
+                LeftCount += BinCounts[b];
+                if (LeftCount == 0 || LeftCount == Count)
+                    continue;
+
+                const float Cost = GetHalfArea(LeftBounds) * static_cast<float>(LeftCount) + RightCost[b];
+                if (Cost < BestCost)
+                {
+                    BestCost = Cost;
+                    BestAxis = Axis;
+                    BestBin  = b;
+                }
+            }
+        }
+
+        Uint32 Middle = First + Count / 2;
+        if (BestAxis >= 0)
+        {
+            const float BinScale = static_cast<float>(NumBins) / (CentroidBounds.Max[BestAxis] - CentroidBounds.Min[BestAxis]);
+            const auto  MiddleIt = std::partition(m_PrimitiveIndices.begin() + First, m_PrimitiveIndices.begin() + First + Count,
+                                                  [&](Uint32 Prim) {
+                                                      return GetBin(m_Centroids[Prim][BestAxis], CentroidBounds.Min[BestAxis], BinScale) <= BestBin;
+                                                  });
+            Middle = static_cast<Uint32>(MiddleIt - m_PrimitiveIndices.begin());
+        }
+        // Otherwise all centroids are the same, so split the primitives in the middle
+        VERIFY_EXPR(Middle > First && Middle < First + Count);
+
+        const Uint32 FirstChild = m_NumNodes.fetch_add(2);
+        VERIFY_EXPR(FirstChild + 2 <= m_Nodes.size());
+        N.FirstChild = FirstChild;
+
+        m_Nodes[FirstChild].FirstPrimitive     = First;
+        m_Nodes[FirstChild].NumPrimitives      = Middle - First;
+        m_Nodes[FirstChild + 1].FirstPrimitive = Middle;
+        m_Nodes[FirstChild + 1].NumPrimitives  = First + Count - Middle;
+
+        return true;
+    }
+
+    Uint32 GetBin(float Centroid, float Min, float BinScale) const
+    {
+        const float Bin = (Centroid - Min) * BinScale;
+        return std::min(static_cast<Uint32>(std::max(Bin, 0.f)), m_Info.NumBins - 1);
+    }
+
+private:
+    const BoundBox* const m_pBoxes;
+    BVH::BuildInfo        m_Info;
+    std::vector<Uint32>&  m_PrimitiveIndices;
+    std::vector<float3>   m_Centroids;
+    std::vector<Node>     m_Nodes;
+    std::atomic<Uint32>   m_NumNodes{0};
+};
+
+} // namespace
+
+void BVH::Node::SetBounds(Uint32 Slot, const BoundBox& Box)
+{
+    MinX[Slot] = Box.Min.x;
+    MinY[Slot] = Box.Min.y;
+    MinZ[Slot] = Box.Min.z;
+    MaxX[Slot] = Box.Max.x;
+    MaxY[Slot] = Box.Max.y;
+    MaxZ[Slot] = Box.Max.z;
+}
+
+void BVH::Node::ResetSlot(Uint32 Slot)
+{
+    SetBounds(Slot, GetEmptyBox());
+    Child[Slot] = InvalidIndex;
+    Count[Slot] = 0;
+}
+
+const char* BVH::GetImplementationName()
+{
+#if DILIGENT_BVH_SSE
+    return "SSE2";
+#elif DILIGENT_BVH_NEON
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+void BVH::Build(const BoundBox* pPrimitiveBoxes, Uint32 NumPrimitives, const BuildInfo& Info)
+{
+    m_Nodes.clear();
+    m_PrimitiveIndices.resize(NumPrimitives);
+    if (NumPrimitives == 0)
+        return;
+
+    VERIFY_EXPR(pPrimitiveBoxes != nullptr);
+    for (Uint32 i = 0; i < NumPrimitives; ++i)
+        m_PrimitiveIndices[i] = i;
+
+    BinaryTreeBuilder Builder{pPrimitiveBoxes, NumPrimitives, Info, m_PrimitiveIndices};
+    Builder.Build();
+
+    const std::vector<BinaryTreeBuilder::Node>& BinaryNodes = Builder.GetNodes();
+
+    // Collapses the binary subtree into the 4-wide node and returns its index.
+    // The parent nodes are always created before their children, which is relied upon by Refit().
+    std::function<Uint32(Uint32)> CollapseNode = [&](Uint32 BinaryNodeIdx) -> Uint32 {
+        Uint32 Children[4];
+        Uint32 NumChildren = 0;
+        if (BinaryNodes[BinaryNodeIdx].IsLeaf())
+        {
+            Children[NumChildren++] = BinaryNodeIdx;
+        }
+        else
+        {
+            Children[NumChildren++] = BinaryNodes[BinaryNodeIdx].FirstChild;
+            Children[NumChildren++] = BinaryNodes[BinaryNodeIdx].FirstChild + 1;
+            // Open the internal child with the largest surface area until all four slots are used
+            while (NumChildren < 4)
+            {
+                int   Best     = -1;
+                float BestArea = -1;
+                for (Uint32 i = 0; i < NumChildren; ++i)
+                {
+                    const BinaryTreeBuilder::Node& Child = BinaryNodes[Children[i]];
+                    if (!Child.IsLeaf() && GetHalfArea(Child.Bounds) > BestArea)
+                    {
+                        Best     = static_cast<int>(i);
+                        BestArea = GetHalfArea(Child.Bounds);
+                    }
+                }
+                if (Best < 0)
+                    break;
+
+                const Uint32 FirstGrandChild = BinaryNodes[Children[Best]].FirstChild;
+                Children[Best]               = FirstGrandChild;
+                Children[NumChildren++]      = FirstGrandChild + 1;
+            }
+        }
+
+        const Uint32 NodeIdx = static_cast<Uint32>(m_Nodes.size());
+        m_Nodes.emplace_back();
+        for (Uint32 i = 0; i < 4; ++i)
+            m_Nodes[NodeIdx].ResetSlot(i);
+
+        for (Uint32 i = 0; i < NumChildren; ++i)
+        {
+            const BinaryTreeBuilder::Node& Child = BinaryNodes[Children[i]];
+            m_Nodes[NodeIdx].SetBounds(i, Child.Bounds);
+            if (Child.IsLeaf())
+            {
+                m_Nodes[NodeIdx].Child[i] = Child.FirstPrimitive;
+                m_Nodes[NodeIdx].Count[i] = Child.NumPrimitives;
+            }
+            else
+            {
+                // NB: m_Nodes may be reallocated by the recursive call
+                const Uint32 ChildNodeIdx = CollapseNode(Children[i]);
+                m_Nodes[NodeIdx].Child[i] = ChildNodeIdx;
+                m_Nodes[NodeIdx].Count[i] = 0;
+            }
+        }
+        return NodeIdx;
+    };
+
+    m_Nodes.reserve(BinaryNodes.size() / 2 + 1);
+    CollapseNode(0);
+}
+
+void BVH::Refit(const BoundBox* pPrimitiveBoxes)
+{
+    VERIFY_EXPR(pPrimitiveBoxes != nullptr || m_PrimitiveIndices.empty());
+
+    // Children always follow their parents, so process the nodes in the reverse order
+    for (size_t NodeIdx = m_Nodes.size(); NodeIdx-- > 0;)
+    {
+        Node& N = m_Nodes[NodeIdx];
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            if (N.Child[i] == InvalidIndex)
+                continue;
+
+            BoundBox Bounds = GetEmptyBox();
+            if (N.Count[i] != 0)
+            {
+                for (Uint32 p = N.Child[i]; p < N.Child[i] + N.Count[i]; ++p)
+                    Enclose(Bounds, pPrimitiveBoxes[m_PrimitiveIndices[p]]);
+            }
+            else
+            {
+                VERIFY_EXPR(N.Child[i] > NodeIdx);
+                const Node& ChildNode = m_Nodes[N.Child[i]];
+                for (Uint32 j = 0; j < 4; ++j)
+                {
+                    if (ChildNode.Child[j] == InvalidIndex)
+                        continue;
+                    Enclose(Bounds, BoundBox{float3{ChildNode.MinX[j], ChildNode.MinY[j], ChildNode.MinZ[j]},
+                                             float3{ChildNode.MaxX[j], ChildNode.MaxY[j], ChildNode.MaxZ[j]}});
+                }
+            }
+            N.SetBounds(i, Bounds);
+        }
+    }
+}
+
+BoundBox BVH::GetBounds() const
+{
+    BoundBox Bounds = GetEmptyBox();
+    if (m_Nodes.empty())
+        return Bounds;
+
+    const Node& Root = m_Nodes[0];
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        if (Root.Child[i] == InvalidIndex)
+            continue;
+        Enclose(Bounds, BoundBox{float3{Root.MinX[i], Root.MinY[i], Root.MinZ[i]},
+                                 float3{Root.MaxX[i], Root.MaxY[i], Root.MaxZ[i]}});
+    }
+    return Bounds;
+}
+
+} // namespace Diligent
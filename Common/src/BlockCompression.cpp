@@ -0,0 +1,398 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// LZ4 block format constants
+constexpr size_t MinMatch     = 4;
+constexpr size_t LastLiterals = 5;  // The last 5 bytes are always literals
+constexpr size_t MFLimit      = 12; // The last match must start at least 12 bytes before the end
+constexpr size_t MaxOffset    = 65535;
+constexpr Uint32 HashLog      = 16;
+
+inline Uint32 Read32(const Uint8* p)
+{
+    Uint32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline Uint32 HashSequence(Uint32 v)
+{
+    return (v * 2654435761u) >> (32 - HashLog);
+}
+
+inline void WriteLength(Uint8*& op, size_t Len)
+{
+    for (; Len >= 255; Len -= 255)
+        *op++ = 255;
+    *op++ = static_cast<Uint8>(Len);
+}
+
+// Writes the sequence of literals followed by the match. MatchLen is 0 for the last sequence.
+bool WriteSequence(Uint8*& op, const Uint8* oend, const Uint8* pLiterals, size_t LitLen, size_t Offset, size_t MatchLen)
+{
+    const size_t MaxSize = 1 + LitLen + LitLen / 255 + 1 + (MatchLen != 0 ? 2 + MatchLen / 255 + 1 : 0);
+    if (static_cast<size_t>(oend - op) < MaxSize)
+        return false;
+
+    Uint8* pToken = op++;
+    Uint8  Token  = static_cast<Uint8>(std::min(LitLen, size_t{15}) << 4);
+    if (LitLen >= 15)
+        WriteLength(op, LitLen - 15);
+    memcpy(op, pLiterals, LitLen);
+    op += LitLen;
+
+    if (MatchLen != 0)
+    {
+        VERIFY_EXPR(MatchLen >= MinMatch && Offset > 0 && Offset <= MaxOffset);
+        *op++ = static_cast<Uint8>(Offset & 0xFF);
+        *op++ = static_cast<Uint8>(Offset >> 8);
+
+        const size_t Len = MatchLen - MinMatch;
+        Token |= static_cast<Uint8>(std::min(Len, size_t{15}));
+        if (Len >= 15)
+            WriteLength(op, Len - 15);
+    }
+    *pToken = Token;
+
+    return true;
+}
+
+} // namespace
+
+size_t GetLZ4CompressBound(size_t SrcSize)
+{
+    return SrcSize + SrcSize / 255 + 16;
+}
+
+size_t CompressLZ4Block(const void* pSrc,
+                        size_t      SrcSize,
+                        void*       pDst,
+                        size_t      DstCapacity,
+                        const void* pDict,
+                        size_t      DictSize)
+{
+    if ((pSrc == nullptr && SrcSize != 0) || pDst == nullptr)
+    {
+        DEV_ERROR("Source and destination must not be null");
+        return 0;
+    }
+    if (pDict == nullptr)
+        DictSize = 0;
+
+    // Place the part of the dictionary that can be referenced right before the source
+    // so that matches can be searched in a single buffer.
+    const size_t       DictTail = std::min(DictSize, MaxOffset);
+    std::vector<Uint8> Buffer(DictTail + SrcSize);
+    if (DictTail > 0)
+        memcpy(Buffer.data(), static_cast<const Uint8*>(pDict) + DictSize - DictTail, DictTail);
+    if (SrcSize > 0)
+        memcpy(Buffer.data() + DictTail, pSrc, SrcSize);
+
+    const Uint8* const Base   = Buffer.data();
+    const Uint8* const iend   = Base + Buffer.size();
+    const Uint8*       ip     = Base + DictTail;
+    const Uint8*       anchor = ip;
+
+    Uint8*             op   = static_cast<Uint8*>(pDst);
+    const Uint8* const oend = op + DstCapacity;
+
+    if (SrcSize > MFLimit)
+    {
+        constexpr size_t    InvalidPos = ~size_t{0};
+        std::vector<size_t> HashTable(size_t{1} << HashLog, InvalidPos);
+        for (size_t Pos = 0; Pos + MinMatch <= DictTail; ++Pos)
+            HashTable[HashSequence(Read32(Base + Pos))] = Pos;
+
+        const Uint8* const MatchStartLimit = iend - MFLimit;
+        const Uint8* const MatchEndLimit   = iend - LastLiterals;
+        while (ip <= MatchStartLimit)
+        {
+            const Uint32 Sequence = Read32(ip);
+            const Uint32 Hash     = HashSequence(Sequence);
+            const size_t RefPos   = HashTable[Hash];
+            HashTable[Hash]       = ip - Base;
+
+            if (RefPos == InvalidPos || static_cast<size_t>(ip - Base) - RefPos > MaxOffset || Read32(Base + RefPos) != Sequence)
+            {
+                ++ip;
+                continue;
+            }
+
+            const Uint8* ref = Base + RefPos;
+            while (ip > anchor && ref > Base && ip[-1] == ref[-1])
+            {
+                --ip;
+                --ref;
+            }
+
+            const Uint8* MatchEnd = ip + MinMatch;
+            for (const Uint8* r = ref + MinMatch; MatchEnd < MatchEndLimit && *MatchEnd == *r; ++r)
+                ++MatchEnd;
+
+            if (!WriteSequence(op, oend, anchor, ip - anchor, ip - ref, MatchEnd - ip))
+                return 0;
+
+            ip     = MatchEnd;
+            anchor = ip;
+
+            HashTable[HashSequence(Read32(ip - 2))] = ip - 2 - Base;
+        }
+    }
+
+    if (!WriteSequence(op, oend, anchor, iend - anchor, 0, 0))
+        return 0;
+
+    return op - static_cast<Uint8*>(pDst);
+}
+
+bool DecompressLZ4Block(const void* pSrc,
+                        size_t      SrcSize,
+                        void*       pDst,
+                        size_t      DstSize,
+                        const void* pDict,
+                        size_t      DictSize)
+{
+    if (pSrc == nullptr || (pDst == nullptr && DstSize != 0))
+        return false;
+    if (pDict == nullptr)
+        DictSize = 0;
+
+    const Uint8*       ip   = static_cast<const Uint8*>(pSrc);
+    const Uint8* const iend = ip + SrcSize;
+    Uint8* const       dst  = static_cast<Uint8*>(pDst);
+    Uint8*             op   = dst;
+    Uint8* const       oend = dst + DstSize;
+
+    auto ReadLength = [&](size_t& Len) {
+        Uint8 b = 0;
+        do
+        {
+            if (ip == iend)
+                return false;
+            b = *ip++;
+            Len += b;
+        } while (b == 255);
+        return true;
+    };
+
+    while (true)
+    {
+        if (ip == iend)
+            return false;
+        const Uint8 Token = *ip++;
+
+        size_t LitLen = Token >> 4;
+        if (LitLen == 15 && !ReadLength(LitLen))
+            return false;
+        if (LitLen > static_cast<size_t>(iend - ip) || LitLen > static_cast<size_t>(oend - op))
+            return false;
+        memcpy(op, ip, LitLen);
+        op += LitLen;
+        ip += LitLen;
+
+        // The last sequence only contains literals
+        if (ip == iend)
+            break;
+
+        if (iend - ip < 2)
+            return false;
+        const size_t Offset = size_t{ip[0]} | (size_t{ip[1]} << 8);
+        ip += 2;
+        if (Offset == 0)
+            return false;
+
+        size_t MatchLen = Token & 0x0F;
+        if (MatchLen == 15 && !ReadLength(MatchLen))
+            return false;
+        MatchLen += MinMatch;
+        if (MatchLen > static_cast<size_t>(oend - op))
+            return false;
+
+        const size_t Produced = op - dst;
+        if (Offset > Produced)
+        {
+            // The match starts in the dictionary and may continue in the output
+            const size_t DictOffset = Offset - Produced;
+            if (DictOffset > DictSize)
+                return false;
+            const size_t DictLen = std::min(MatchLen, DictOffset);
+            memcpy(op, static_cast<const Uint8*>(pDict) + DictSize - DictOffset, DictLen);
+            op += DictLen;
+            MatchLen -= DictLen;
+        }
+
+        const Uint8* pMatch = op - Offset;
+        if (Offset >= MatchLen)
+        {
+            memcpy(op, pMatch, MatchLen);
+            op += MatchLen;
+        }
+        else
+        {
+            // Overlapping match repeats the last Offset bytes
+            for (size_t i = 0; i < MatchLen; ++i)
+                *op++ = *pMatch++;
+        }
+    }
+
+    return op == oend;
+}
+
+std::vector<Uint8> TrainCompressionDictionary(const std::vector<CompressionSample>& Samples, size_t MaxDictSize)
+{
+    if (MaxDictSize == 0 || Samples.size() < 2)
+        return {};
+
+    constexpr size_t SegmentSize = 16;
+
+    size_t TotalSize = 0;
+    for (const CompressionSample& Sample : Samples)
+        TotalSize += Sample.pData != nullptr ? Sample.Size : 0;
+
+    // Bytecode is typically made of 4-byte words. Increase the step for large inputs
+    // to bound the memory used by the segment table.
+    constexpr size_t MaxSegments = size_t{1} << 22;
+    size_t           Step        = 4;
+    while (TotalSize / Step > MaxSegments)
+        Step *= 2;
+
+    struct SegmentInfo
+    {
+        // The number of samples that contain the segment
+        Uint32 Count = 0;
+
+        Uint32 LastSample = ~0u;
+
+        // The first occurrence of the segment
+        Uint32 Sample = 0;
+        size_t Offset = 0;
+    };
+    std::unordered_map<Uint64, SegmentInfo> Segments;
+    for (Uint32 s = 0; s < Samples.size(); ++s)
+    {
+        const Uint8* pData = static_cast<const Uint8*>(Samples[s].pData);
+        if (pData == nullptr)
+            continue;
+
+        for (size_t Offset = 0; Offset + SegmentSize <= Samples[s].Size; Offset += Step)
+        {
+            // FNV-1a. Hash collisions only make the dictionary less efficient.
+            Uint64 Hash = 14695981039346656037ull;
+            for (size_t i = 0; i < SegmentSize; ++i)
+                Hash = (Hash ^ pData[Offset + i]) * 1099511628211ull;
+
+            SegmentInfo& Info = Segments[Hash];
+            if (Info.LastSample == s)
+                continue;
+            if (Info.Count == 0)
+            {
+                Info.Sample = s;
+                Info.Offset = Offset;
+            }
+            Info.LastSample = s;
+            ++Info.Count;
+        }
+    }
+
+    std::vector<const SegmentInfo*> CommonSegments;
+    for (const auto& it : Segments)
+    {
+        if (it.second.Count >= 2)
+            CommonSegments.push_back(&it.second);
+    }
+    // Sort by all fields to make the dictionary independent of the hash map order
+    std::sort(CommonSegments.begin(), CommonSegments.end(),
+              [](const SegmentInfo* lhs, const SegmentInfo* rhs) {
+                  if (lhs->Count != rhs->Count)
+                      return lhs->Count > rhs->Count;
+                  if (lhs->Sample != rhs->Sample)
+                      return lhs->Sample < rhs->Sample;
+                  return lhs->Offset < rhs->Offset;
+              });
+    if (CommonSegments.size() * SegmentSize > MaxDictSize)
+        CommonSegments.resize((MaxDictSize + SegmentSize - 1) / SegmentSize);
+
+    // Merge overlapping segments into ranges
+    std::sort(CommonSegments.begin(), CommonSegments.end(),
+              [](const SegmentInfo* lhs, const SegmentInfo* rhs) {
+                  return lhs->Sample != rhs->Sample ? lhs->Sample < rhs->Sample : lhs->Offset < rhs->Offset;
+              });
+
+    struct Range
+    {
+        Uint32 Sample;
+        size_t Start;
+        size_t End;
+        Uint32 Count;
+    };
+    std::vector<Range> Ranges;
+    for (const SegmentInfo* pSegment : CommonSegments)
+    {
+        if (!Ranges.empty() && Ranges.back().Sample == pSegment->Sample && pSegment->Offset <= Ranges.back().End)
+        {
+            Ranges.back().End   = std::max(Ranges.back().End, pSegment->Offset + SegmentSize);
+            Ranges.back().Count = std::max(Ranges.back().Count, pSegment->Count);
+        }
+        else
+        {
+            Ranges.push_back({pSegment->Sample, pSegment->Offset, pSegment->Offset + SegmentSize, pSegment->Count});
+        }
+    }
+
+    // The most common ranges go last where the offsets are the smallest
+    std::stable_sort(Ranges.begin(), Ranges.end(),
+                     [](const Range& lhs, const Range& rhs) {
+                         return lhs.Count < rhs.Count;
+                     });
+
+    std::vector<Uint8> Dictionary;
+    for (const Range& R : Ranges)
+    {
+        const Uint8* pData = static_cast<const Uint8*>(Samples[R.Sample].pData);
+        Dictionary.insert(Dictionary.end(), pData + R.Start, pData + R.End);
+    }
+    if (Dictionary.size() > MaxDictSize)
+        Dictionary.erase(Dictionary.begin(), Dictionary.begin() + (Dictionary.size() - MaxDictSize));
+
+    return Dictionary;
+}
+
+} // namespace Diligent
@@ -0,0 +1,470 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "CPUProfiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+std::atomic<bool> CPUProfiler::sm_Enabled{true};
+
+namespace
+{
+
+struct ScopeEvent
+{
+    const char* Name      = nullptr;
+    Uint64      StartTime = 0;
+    Uint64      EndTime   = 0;
+    Uint32      Depth     = 0;
+    Uint32      ThreadId  = 0;
+};
+
+// Single-producer ring buffer of events recorded by one thread.
+// The owning thread writes the events without locks, and the profiler reads them in EndFrame().
+class ThreadEventBuffer
+{
+public:
+    static constexpr Uint64 Capacity = 1 << 14;
+
+    explicit ThreadEventBuffer(Uint32 _ThreadId) :
+        ThreadId{_ThreadId}
+    {}
+
+    void Push(const char* Name, Uint64 StartTime, Uint64 EndTime, Uint32 Depth)
+    {
+        const Uint64 Idx = m_WriteIdx.load(std::memory_order_relaxed);
+
+        // Announce that the slot is being overwritten before writing it (see Drain()).
+        m_BeginIdx.store(Idx + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Slot& S = m_Slots[Idx & (Capacity - 1)];
+        S.Name.store(Name, std::memory_order_relaxed);
+        S.StartTime.store(StartTime, std::memory_order_relaxed);
+        S.EndTime.store(EndTime, std::memory_order_relaxed);
+        S.Depth.store(Depth, std::memory_order_relaxed);
+
+        m_WriteIdx.store(Idx + 1, std::memory_order_release);
+    }
+
+    // Must only be called by one thread at a time (the profiler mutex is held)
+    Uint64 Drain(std::vector<ScopeEvent>& Events)
+    {
+        const Uint64 WriteIdx = m_WriteIdx.load(std::memory_order_acquire);
+
+        Uint64 NumDropped = 0;
+        Uint64 ReadIdx    = m_ReadIdx;
+        if (WriteIdx - ReadIdx > Capacity)
+        {
+            NumDropped += WriteIdx - ReadIdx - Capacity;
+            ReadIdx = WriteIdx - Capacity;
+        }
+
+        const size_t FirstEvent = Events.size();
+        for (Uint64 Idx = ReadIdx; Idx < WriteIdx; ++Idx)
+        {
+            const Slot& S = m_Slots[Idx & (Capacity - 1)];
+            ScopeEvent  Event;
+            Event.Name      = S.Name.load(std::memory_order_relaxed);
+            Event.StartTime = S.StartTime.load(std::memory_order_relaxed);
+            Event.EndTime   = S.EndTime.load(std::memory_order_relaxed);
+            Event.Depth     = S.Depth.load(std::memory_order_relaxed);
+            Event.ThreadId  = ThreadId;
+            Events.push_back(Event);
+        }
+
+        // If we have read any data written by the producer after it announced a new slot, the fence
+        // synchronizes with the producer's release fence, and we are guaranteed to see the new begin index.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const Uint64 BeginIdx = m_BeginIdx.load(std::memory_order_relaxed);
+        // Events with indices below BeginIdx - Capacity may have been overwritten while we were reading them
+        if (BeginIdx > ReadIdx + Capacity)
+        {
+            const Uint64 NumOverwritten = std::min(BeginIdx - Capacity - ReadIdx, WriteIdx - ReadIdx);
+            Events.erase(Events.begin() + FirstEvent, Events.begin() + FirstEvent + static_cast<size_t>(NumOverwritten));
+            NumDropped += NumOverwritten;
+        }
+
+        m_ReadIdx = WriteIdx;
+        return NumDropped;
+    }
+
+    bool IsEmpty() const
+    {
+        return m_ReadIdx == m_WriteIdx.load(std::memory_order_acquire);
+    }
+
+    const Uint32 ThreadId;
+
+    std::string ThreadName;
+
+    std::atomic<bool> ThreadExited{false};
+
+private:
+    struct Slot
+    {
+        std::atomic<const char*> Name{nullptr};
+        std::atomic<Uint64>      StartTime{0};
+        std::atomic<Uint64>      EndTime{0};
+        std::atomic<Uint32>      Depth{0};
+    };
+    Slot m_Slots[Capacity];
+
+    std::atomic<Uint64> m_WriteIdx{0};
+    std::atomic<Uint64> m_BeginIdx{0};
+
+    // Only accessed by the reader
+    Uint64 m_ReadIdx = 0;
+};
+
+struct ProfilerState
+{
+    std::mutex Mtx;
+
+    std::vector<std::shared_ptr<ThreadEventBuffer>> ThreadBuffers;
+    Uint32                                          NextThreadId = 0;
+
+    std::vector<CPUProfileScopeStats> FrameStats;
+
+    bool                    IsCapturing = false;
+    std::vector<ScopeEvent> CapturedEvents;
+    std::vector<Uint64>     CapturedFrames;
+
+    Uint64 NumDroppedEvents = 0;
+
+    std::unordered_set<std::string> InternedNames;
+
+    // Collects the events from all threads. Mtx must be locked.
+    void CollectEvents(std::vector<ScopeEvent>& Events)
+    {
+        for (auto& pBuffer : ThreadBuffers)
+            NumDroppedEvents += pBuffer->Drain(Events);
+
+        // Remove the buffers of the threads that have exited
+        ThreadBuffers.erase(std::remove_if(ThreadBuffers.begin(), ThreadBuffers.end(),
+                                           [this](const std::shared_ptr<ThreadEventBuffer>& pBuffer) {
+                                               if (!pBuffer->ThreadExited.load() || !pBuffer->IsEmpty())
+                                                   return false;
+                                               if (IsCapturing && !pBuffer->ThreadName.empty())
+                                                   return false; // Keep the name for the trace
+                                               return true;
+                                           }),
+                            ThreadBuffers.end());
+
+        if (IsCapturing)
+            CapturedEvents.insert(CapturedEvents.end(), Events.begin(), Events.end());
+    }
+};
+
+ProfilerState& GetProfilerState()
+{
+    // Intentionally leaked so that threads that exit after static destruction can still access it
+    static ProfilerState* pState = new ProfilerState;
+    return *pState;
+}
+
+// Owns the event buffer of the current thread
+struct ThreadBufferHolder
+{
+    std::shared_ptr<ThreadEventBuffer> pBuffer;
+    Uint32                             Depth = 0;
+
+    ThreadEventBuffer& Get()
+    {
+        if (!pBuffer)
+        {
+            auto&            State = GetProfilerState();
+            std::lock_guard<std::mutex> Lock{State.Mtx};
+            pBuffer = std::make_shared<ThreadEventBuffer>(State.NextThreadId++);
+            State.ThreadBuffers.push_back(pBuffer);
+        }
+        return *pBuffer;
+    }
+
+    ~ThreadBufferHolder()
+    {
+        if (pBuffer)
+            pBuffer->ThreadExited.store(true);
+    }
+};
+
+thread_local ThreadBufferHolder tl_ThreadBuffer;
+
+const std::chrono::steady_clock::time_point g_StartTime = std::chrono::steady_clock::now();
+
+void WriteEscapedString(std::string& Out, const char* Str)
+{
+    for (const char* c = Str; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            Out.push_back('\\');
+            Out.push_back(*c);
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20)
+        {
+            char Buff[8];
+            snprintf(Buff, sizeof(Buff), "\\u%04x", static_cast<unsigned int>(*c));
+            Out += Buff;
+        }
+        else
+        {
+            Out.push_back(*c);
+        }
+    }
+}
+
+void WriteMicroseconds(std::string& Out, Uint64 Nanoseconds)
+{
+    char Buff[32];
+    snprintf(Buff, sizeof(Buff), "%llu.%03u",
+             static_cast<unsigned long long>(Nanoseconds / 1000),
+             static_cast<unsigned int>(Nanoseconds % 1000));
+    Out += Buff;
+}
+
+} // namespace
+
+void CPUProfiler::SetEnabled(bool Enabled)
+{
+    sm_Enabled.store(Enabled, std::memory_order_relaxed);
+}
+
+Uint64 CPUProfiler::GetTimestamp()
+{
+    return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_StartTime).count());
+}
+
+void CPUProfiler::SetThreadName(const char* Name)
+{
+    auto& Buffer = tl_ThreadBuffer.Get();
+
+    std::lock_guard<std::mutex> Lock{GetProfilerState().Mtx};
+    Buffer.ThreadName = Name != nullptr ? Name : "";
+}
+
+const char* CPUProfiler::InternName(const char* Name)
+{
+    if (Name == nullptr)
+        return nullptr;
+
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    return State.InternedNames.emplace(Name).first->c_str();
+}
+
+Uint32 CPUProfiler::EnterScope()
+{
+    return tl_ThreadBuffer.Depth++;
+}
+
+void CPUProfiler::LeaveScope()
+{
+    VERIFY_EXPR(tl_ThreadBuffer.Depth > 0);
+    --tl_ThreadBuffer.Depth;
+}
+
+void CPUProfiler::RecordScope(const char* Name, Uint64 StartTime, Uint64 EndTime, Uint32 Depth)
+{
+    tl_ThreadBuffer.Get().Push(Name, StartTime, EndTime, Depth);
+}
+
+void CPUProfiler::EndFrame()
+{
+    auto& State = GetProfilerState();
+
+    std::vector<ScopeEvent> Events;
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    State.CollectEvents(Events);
+    if (State.IsCapturing)
+        State.CapturedFrames.push_back(GetTimestamp());
+
+    // Aggregate events by name pointer first, which is cheap, and then by name
+    std::unordered_map<const char*, CPUProfileScopeStats> StatsByPtr;
+    for (const auto& Event : Events)
+    {
+        auto&        Stats = StatsByPtr[Event.Name];
+        const double Time  = static_cast<double>(Event.EndTime - Event.StartTime) * 1e-9;
+        ++Stats.Count;
+        Stats.TotalTime += Time;
+        Stats.MaxTime = (std::max)(Stats.MaxTime, Time);
+    }
+
+    std::unordered_map<std::string, CPUProfileScopeStats> StatsByName;
+    for (auto& it : StatsByPtr)
+    {
+        auto& Stats = StatsByName[it.first];
+        Stats.Count += it.second.Count;
+        Stats.TotalTime += it.second.TotalTime;
+        Stats.MaxTime = (std::max)(Stats.MaxTime, it.second.MaxTime);
+    }
+
+    State.FrameStats.clear();
+    State.FrameStats.reserve(StatsByName.size());
+    for (auto& it : StatsByName)
+    {
+        State.FrameStats.emplace_back(std::move(it.second));
+        State.FrameStats.back().Name = it.first;
+    }
+    std::sort(State.FrameStats.begin(), State.FrameStats.end(),
+              [](const CPUProfileScopeStats& lhs, const CPUProfileScopeStats& rhs) {
+                  return lhs.TotalTime > rhs.TotalTime;
+              });
+}
+
+std::vector<CPUProfileScopeStats> CPUProfiler::GetFrameStats()
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    return State.FrameStats;
+}
+
+Uint64 CPUProfiler::GetNumDroppedEvents()
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    return State.NumDroppedEvents;
+}
+
+void CPUProfiler::BeginCapture()
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    if (State.IsCapturing)
+    {
+        LOG_WARNING_MESSAGE("CPU profiler capture is already in progress");
+        return;
+    }
+
+    // Discard the events recorded before the capture started
+    std::vector<ScopeEvent> Events;
+    State.CollectEvents(Events);
+
+    State.IsCapturing = true;
+    State.CapturedEvents.clear();
+    State.CapturedFrames.clear();
+}
+
+bool CPUProfiler::IsCapturing()
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    return State.IsCapturing;
+}
+
+std::string CPUProfiler::EndCapture()
+{
+    auto& State = GetProfilerState();
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    if (!State.IsCapturing)
+    {
+        LOG_WARNING_MESSAGE("CPU profiler capture has not been started");
+        return {};
+    }
+
+    {
+        std::vector<ScopeEvent> Events;
+        State.CollectEvents(Events);
+    }
+    State.IsCapturing = false;
+
+    std::string Trace;
+    Trace.reserve(128 + State.CapturedEvents.size() * 96);
+    Trace += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool IsFirst = true;
+    auto BeginEvent = [&]() {
+        if (!IsFirst)
+            Trace += ",";
+        Trace += "\n{";
+        IsFirst = false;
+    };
+
+    for (const auto& pBuffer : State.ThreadBuffers)
+    {
+        if (pBuffer->ThreadName.empty())
+            continue;
+        BeginEvent();
+        Trace += "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+        Trace += std::to_string(pBuffer->ThreadId);
+        Trace += ",\"args\":{\"name\":\"";
+        WriteEscapedString(Trace, pBuffer->ThreadName.c_str());
+        Trace += "\"}}";
+    }
+
+    for (const auto& Event : State.CapturedEvents)
+    {
+        BeginEvent();
+        Trace += "\"name\":\"";
+        WriteEscapedString(Trace, Event.Name);
+        Trace += "\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+        Trace += std::to_string(Event.ThreadId);
+        Trace += ",\"ts\":";
+        WriteMicroseconds(Trace, Event.StartTime);
+        Trace += ",\"dur\":";
+        WriteMicroseconds(Trace, Event.EndTime - Event.StartTime);
+        Trace += ",\"args\":{\"depth\":";
+        Trace += std::to_string(Event.Depth);
+        Trace += "}}";
+    }
+
+    for (Uint64 FrameTime : State.CapturedFrames)
+    {
+        BeginEvent();
+        Trace += "\"name\":\"EndFrame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":";
+        WriteMicroseconds(Trace, FrameTime);
+        Trace += "}";
+    }
+
+    Trace += "\n]}\n";
+
+    State.CapturedEvents.clear();
+    State.CapturedEvents.shrink_to_fit();
+    State.CapturedFrames.clear();
+
+    return Trace;
+}
+
+} // namespace Diligent
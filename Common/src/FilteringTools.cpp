@@ -0,0 +1,342 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "FilteringTools.hpp"
+
+#include <climits>
+
+#include "Intrinsics.hpp"
+
+#if !defined(DILIGENT_DISABLE_SIMD_MATH)
+#    if DILIGENT_SSE2_ENABLED
+#        define DILIGENT_FILTER_SSE 1
+#        if DILIGENT_AVX2_ENABLED
+#            define DILIGENT_FILTER_AVX2 1
+#        endif
+#    elif DILIGENT_NEON_ENABLED
+#        define DILIGENT_FILTER_NEON 1
+#    endif
+#endif
+
+namespace Diligent
+{
+
+namespace
+{
+
+// NB: all implementations must perform the same operations in the same order as
+//     GetLinearTexFilterSampleInfo and FilterTexture2DBilinear to produce identical results.
+//     Sample indices are clamped in floating-point domain, which is equivalent for the valid
+//     index range, but avoids integer overflow for out-of-range coordinates.
+
+#if DILIGENT_FILTER_SSE
+
+// Computes linear filter sample info for 4 coordinates that are already scaled to the texture size.
+inline void GetClampSampleInfoSSE(__m128 x, __m128 MaxIdx, __m128i& i0, __m128i& i1, __m128& w)
+{
+    const __m128 Zero = _mm_setzero_ps();
+    const __m128 One  = _mm_set1_ps(1.f);
+
+    x = _mm_sub_ps(x, _mm_set1_ps(0.5f));
+
+    // Same as FastFloor: values that are too large to have a fractional part are left unchanged
+    const __m128 Trunc    = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+    const __m128 Floor    = _mm_sub_ps(Trunc, _mm_and_ps(_mm_cmpgt_ps(Trunc, x), One));
+    const __m128 AbsX     = _mm_andnot_ps(_mm_set1_ps(-0.f), x);
+    const __m128 HasFrac  = _mm_cmplt_ps(AbsX, _mm_set1_ps(8388608.f));
+    const __m128 x0       = _mm_or_ps(_mm_and_ps(HasFrac, Floor), _mm_andnot_ps(HasFrac, x));
+    const __m128 x0Plus1  = _mm_add_ps(x0, One);
+    const __m128 Clamped0 = _mm_min_ps(_mm_max_ps(x0, Zero), MaxIdx);
+    const __m128 Clamped1 = _mm_min_ps(_mm_max_ps(x0Plus1, Zero), MaxIdx);
+
+    w  = _mm_sub_ps(x, x0);
+    i0 = _mm_cvttps_epi32(Clamped0);
+    i1 = _mm_cvttps_epi32(Clamped1);
+}
+
+inline __m128 BilinearSSE(__m128 S00, __m128 S10, __m128 S01, __m128 S11, __m128 wu, __m128 wv)
+{
+    const __m128 One = _mm_set1_ps(1.f);
+    const __m128 omu = _mm_sub_ps(One, wu);
+    const __m128 omv = _mm_sub_ps(One, wv);
+    const __m128 Top = _mm_add_ps(_mm_mul_ps(S00, omu), _mm_mul_ps(S10, wu));
+    const __m128 Btm = _mm_add_ps(_mm_mul_ps(S01, omu), _mm_mul_ps(S11, wu));
+    return _mm_add_ps(_mm_mul_ps(Top, omv), _mm_mul_ps(Btm, wv));
+}
+
+#endif
+
+#if DILIGENT_FILTER_AVX2
+
+inline void GetClampSampleInfoAVX2(__m256 x, __m256 MaxIdx, __m256i& i0, __m256i& i1, __m256& w)
+{
+    const __m256 Zero = _mm256_setzero_ps();
+
+    x = _mm256_sub_ps(x, _mm256_set1_ps(0.5f));
+
+    const __m256 x0       = _mm256_floor_ps(x);
+    const __m256 x0Plus1  = _mm256_add_ps(x0, _mm256_set1_ps(1.f));
+    const __m256 Clamped0 = _mm256_min_ps(_mm256_max_ps(x0, Zero), MaxIdx);
+    const __m256 Clamped1 = _mm256_min_ps(_mm256_max_ps(x0Plus1, Zero), MaxIdx);
+
+    w  = _mm256_sub_ps(x, x0);
+    i0 = _mm256_cvttps_epi32(Clamped0);
+    i1 = _mm256_cvttps_epi32(Clamped1);
+}
+
+#endif
+
+#if DILIGENT_FILTER_NEON
+
+inline void GetClampSampleInfoNEON(float32x4_t x, float32x4_t MaxIdx, int32x4_t& i0, int32x4_t& i1, float32x4_t& w)
+{
+    const float32x4_t Zero = vdupq_n_f32(0.f);
+    const float32x4_t One  = vdupq_n_f32(1.f);
+
+    x = vsubq_f32(x, vdupq_n_f32(0.5f));
+
+    // vrndmq_f32 is not available on ARMv7
+    const float32x4_t Trunc    = vcvtq_f32_s32(vcvtq_s32_f32(x));
+    const float32x4_t Floor    = vsubq_f32(Trunc, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(Trunc, x), vreinterpretq_u32_f32(One))));
+    const uint32x4_t  HasFrac  = vcltq_f32(vabsq_f32(x), vdupq_n_f32(8388608.f));
+    const float32x4_t x0       = vbslq_f32(HasFrac, Floor, x);
+    const float32x4_t x0Plus1  = vaddq_f32(x0, One);
+    const float32x4_t Clamped0 = vminq_f32(vmaxq_f32(x0, Zero), MaxIdx);
+    const float32x4_t Clamped1 = vminq_f32(vmaxq_f32(x0Plus1, Zero), MaxIdx);
+
+    w  = vsubq_f32(x, x0);
+    i0 = vcvtq_s32_f32(Clamped0);
+    i1 = vcvtq_s32_f32(Clamped1);
+}
+
+#endif
+
+template <bool IsNormalizedCoord>
+void FilterTexture2DBilinearClampBatchImpl(Uint32        Width,
+                                           Uint32        Height,
+                                           const float*  pData,
+                                           size_t        Stride,
+                                           const float2* pUV,
+                                           size_t        NumSamples,
+                                           float*        pDst)
+{
+    size_t s = 0;
+
+#if DILIGENT_FILTER_SSE || DILIGENT_FILTER_NEON
+    const float ScaleU = IsNormalizedCoord ? static_cast<float>(Width) : 1.f;
+    const float ScaleV = IsNormalizedCoord ? static_cast<float>(Height) : 1.f;
+    const float MaxU   = static_cast<float>(Width - 1);
+    const float MaxV   = static_cast<float>(Height - 1);
+#endif
+
+#if DILIGENT_FILTER_AVX2
+    // Gather instructions use 32-bit offsets
+    if (Height == 0 || (Height - 1) * Stride + Width <= static_cast<size_t>(INT_MAX))
+    {
+        const __m256  vScaleU = _mm256_set1_ps(ScaleU);
+        const __m256  vScaleV = _mm256_set1_ps(ScaleV);
+        const __m256  vMaxU   = _mm256_set1_ps(MaxU);
+        const __m256  vMaxV   = _mm256_set1_ps(MaxV);
+        const __m256i vStride = _mm256_set1_epi32(static_cast<int>(Stride));
+        const __m256  One     = _mm256_set1_ps(1.f);
+        for (; s + 8 <= NumSamples; s += 8)
+        {
+            // u0 v0 u1 v1 u2 v2 u3 v3 | u4 v4 u5 v5 u6 v6 u7 v7
+            const __m256 UV0 = _mm256_loadu_ps(&pUV[s].x);
+            const __m256 UV1 = _mm256_loadu_ps(&pUV[s + 4].x);
+
+            // u0 u1 u4 u5 u2 u3 u6 u7 -> u0 u1 u2 u3 u4 u5 u6 u7
+            __m256 u = _mm256_shuffle_ps(UV0, UV1, _MM_SHUFFLE(2, 0, 2, 0));
+            __m256 v = _mm256_shuffle_ps(UV0, UV1, _MM_SHUFFLE(3, 1, 3, 1));
+            u        = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(u), _MM_SHUFFLE(3, 1, 2, 0)));
+            v        = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(3, 1, 2, 0)));
+            if (IsNormalizedCoord)
+            {
+                u = _mm256_mul_ps(u, vScaleU);
+                v = _mm256_mul_ps(v, vScaleV);
+            }
+
+            __m256i iu0, iu1, iv0, iv1;
+            __m256  wu, wv;
+            GetClampSampleInfoAVX2(u, vMaxU, iu0, iu1, wu);
+            GetClampSampleInfoAVX2(v, vMaxV, iv0, iv1, wv);
+
+            const __m256i Row0 = _mm256_mullo_epi32(iv0, vStride);
+            const __m256i Row1 = _mm256_mullo_epi32(iv1, vStride);
+
+            const __m256 S00 = _mm256_i32gather_ps(pData, _mm256_add_epi32(Row0, iu0), 4);
+            const __m256 S10 = _mm256_i32gather_ps(pData, _mm256_add_epi32(Row0, iu1), 4);
+            const __m256 S01 = _mm256_i32gather_ps(pData, _mm256_add_epi32(Row1, iu0), 4);
+            const __m256 S11 = _mm256_i32gather_ps(pData, _mm256_add_epi32(Row1, iu1), 4);
+
+            const __m256 omu = _mm256_sub_ps(One, wu);
+            const __m256 omv = _mm256_sub_ps(One, wv);
+            const __m256 Top = _mm256_add_ps(_mm256_mul_ps(S00, omu), _mm256_mul_ps(S10, wu));
+            const __m256 Btm = _mm256_add_ps(_mm256_mul_ps(S01, omu), _mm256_mul_ps(S11, wu));
+            _mm256_storeu_ps(pDst + s, _mm256_add_ps(_mm256_mul_ps(Top, omv), _mm256_mul_ps(Btm, wv)));
+        }
+    }
+#endif
+
+#if DILIGENT_FILTER_SSE
+    {
+        const __m128 vScaleU = _mm_set1_ps(ScaleU);
+        const __m128 vScaleV = _mm_set1_ps(ScaleV);
+        const __m128 vMaxU   = _mm_set1_ps(MaxU);
+        const __m128 vMaxV   = _mm_set1_ps(MaxV);
+        for (; s + 4 <= NumSamples; s += 4)
+        {
+            const __m128 UV0 = _mm_loadu_ps(&pUV[s].x);
+            const __m128 UV1 = _mm_loadu_ps(&pUV[s + 2].x);
+
+            __m128 u = _mm_shuffle_ps(UV0, UV1, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 v = _mm_shuffle_ps(UV0, UV1, _MM_SHUFFLE(3, 1, 3, 1));
+            if (IsNormalizedCoord)
+            {
+                u = _mm_mul_ps(u, vScaleU);
+                v = _mm_mul_ps(v, vScaleV);
+            }
+
+            __m128i iu0, iu1, iv0, iv1;
+            __m128  wu, wv;
+            GetClampSampleInfoSSE(u, vMaxU, iu0, iu1, wu);
+            GetClampSampleInfoSSE(v, vMaxV, iv0, iv1, wv);
+
+            alignas(16) Int32 U0[4], U1[4], V0[4], V1[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(U0), iu0);
+            _mm_store_si128(reinterpret_cast<__m128i*>(U1), iu1);
+            _mm_store_si128(reinterpret_cast<__m128i*>(V0), iv0);
+            _mm_store_si128(reinterpret_cast<__m128i*>(V1), iv1);
+
+            // SSE2 has no gather instruction
+            const float* pRow0[4] = {pData + V0[0] * Stride, pData + V0[1] * Stride, pData + V0[2] * Stride, pData + V0[3] * Stride};
+            const float* pRow1[4] = {pData + V1[0] * Stride, pData + V1[1] * Stride, pData + V1[2] * Stride, pData + V1[3] * Stride};
+
+            const __m128 S00 = _mm_setr_ps(pRow0[0][U0[0]], pRow0[1][U0[1]], pRow0[2][U0[2]], pRow0[3][U0[3]]);
+            const __m128 S10 = _mm_setr_ps(pRow0[0][U1[0]], pRow0[1][U1[1]], pRow0[2][U1[2]], pRow0[3][U1[3]]);
+            const __m128 S01 = _mm_setr_ps(pRow1[0][U0[0]], pRow1[1][U0[1]], pRow1[2][U0[2]], pRow1[3][U0[3]]);
+            const __m128 S11 = _mm_setr_ps(pRow1[0][U1[0]], pRow1[1][U1[1]], pRow1[2][U1[2]], pRow1[3][U1[3]]);
+
+            _mm_storeu_ps(pDst + s, BilinearSSE(S00, S10, S01, S11, wu, wv));
+        }
+    }
+#elif DILIGENT_FILTER_NEON
+    {
+        const float32x4_t vMaxU = vdupq_n_f32(MaxU);
+        const float32x4_t vMaxV = vdupq_n_f32(MaxV);
+        const float32x4_t One   = vdupq_n_f32(1.f);
+        for (; s + 4 <= NumSamples; s += 4)
+        {
+            const float32x4x2_t UV = vld2q_f32(&pUV[s].x);
+
+            float32x4_t u = UV.val[0];
+            float32x4_t v = UV.val[1];
+            if (IsNormalizedCoord)
+            {
+                u = vmulq_n_f32(u, ScaleU);
+                v = vmulq_n_f32(v, ScaleV);
+            }
+
+            int32x4_t   iu0, iu1, iv0, iv1;
+            float32x4_t wu, wv;
+            GetClampSampleInfoNEON(u, vMaxU, iu0, iu1, wu);
+            GetClampSampleInfoNEON(v, vMaxV, iv0, iv1, wv);
+
+            Int32 U0[4], U1[4], V0[4], V1[4];
+            vst1q_s32(U0, iu0);
+            vst1q_s32(U1, iu1);
+            vst1q_s32(V0, iv0);
+            vst1q_s32(V1, iv1);
+
+            float S00[4], S10[4], S01[4], S11[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                const float* pRow0 = pData + V0[i] * Stride;
+                const float* pRow1 = pData + V1[i] * Stride;
+
+                S00[i] = pRow0[U0[i]];
+                S10[i] = pRow0[U1[i]];
+                S01[i] = pRow1[U0[i]];
+                S11[i] = pRow1[U1[i]];
+            }
+
+            // Do not use vmlaq_f32 as it may be fused
+            const float32x4_t omu = vsubq_f32(One, wu);
+            const float32x4_t omv = vsubq_f32(One, wv);
+            const float32x4_t Top = vaddq_f32(vmulq_f32(vld1q_f32(S00), omu), vmulq_f32(vld1q_f32(S10), wu));
+            const float32x4_t Btm = vaddq_f32(vmulq_f32(vld1q_f32(S01), omu), vmulq_f32(vld1q_f32(S11), wu));
+            vst1q_f32(pDst + s, vaddq_f32(vmulq_f32(Top, omv), vmulq_f32(Btm, wv)));
+        }
+    }
+#endif
+
+    for (; s < NumSamples; ++s)
+    {
+        pDst[s] = FilterTexture2DBilinear<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, IsNormalizedCoord>(Width, Height, pData, Stride, pUV[s].x, pUV[s].y);
+    }
+}
+
+} // namespace
+
+template <>
+void FilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, true>(Uint32        Width,
+                                                                                                   Uint32        Height,
+                                                                                                   const float*  pData,
+                                                                                                   size_t        Stride,
+                                                                                                   const float2* pUV,
+                                                                                                   size_t        NumSamples,
+                                                                                                   float*        pDst)
+{
+    FilterTexture2DBilinearClampBatchImpl<true>(Width, Height, pData, Stride, pUV, NumSamples, pDst);
+}
+
+template <>
+void FilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, false>(Uint32        Width,
+                                                                                                    Uint32        Height,
+                                                                                                    const float*  pData,
+                                                                                                    size_t        Stride,
+                                                                                                    const float2* pUV,
+                                                                                                    size_t        NumSamples,
+                                                                                                    float*        pDst)
+{
+    FilterTexture2DBilinearClampBatchImpl<false>(Width, Height, pData, Stride, pUV, NumSamples, pDst);
+}
+
+const char* FilterTexture2DBilinearBatchImplementationName()
+{
+#if DILIGENT_FILTER_AVX2
+    return "AVX2";
+#elif DILIGENT_FILTER_SSE
+    return "SSE2";
+#elif DILIGENT_FILTER_NEON
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+} // namespace Diligent
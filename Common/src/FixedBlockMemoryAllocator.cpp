@@ -27,8 +27,10 @@
 
 #include "pch.h"
 #include <algorithm>
+#include <atomic>
 #include "FixedBlockMemoryAllocator.hpp"
 #include "Align.hpp"
+#include "SpinLock.hpp"
 
 namespace Diligent
 {
@@ -164,6 +166,72 @@ void FixedBlockMemoryAllocator::MemoryPage::DeAllocate(void* p)
 }
 
 
+// Thread-local cache of free blocks
+class FixedBlockMemoryAllocator::ThreadCache
+{
+public:
+    explicit ThreadCache(FixedBlockMemoryAllocator& Owner) :
+        pOwner{&Owner}
+    {
+        Blocks.reserve(Owner.m_ThreadCacheSize);
+    }
+
+    // The lock is only taken by the thread that owns the cache, except when the allocator
+    // is destroyed or the thread exits, so it is practically never contended.
+    Threading::SpinLock Lock;
+
+    // The allocator that owns the cache, or null if the allocator has been destroyed
+    FixedBlockMemoryAllocator* pOwner = nullptr;
+
+    std::vector<void*> Blocks;
+
+    // The counters are only modified by the thread that owns the cache,
+    // but may be read by any thread.
+    std::atomic<Uint64> NumAllocations{0};
+    std::atomic<Uint64> NumCacheHits{0};
+    std::atomic<Uint64> NumRefills{0};
+    std::atomic<Uint64> NumFlushes{0};
+
+    static void Increment(std::atomic<Uint64>& Counter)
+    {
+        Counter.store(Counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void AddStats(ThreadCacheStats& Stats) const
+    {
+        Stats.NumAllocations += NumAllocations.load(std::memory_order_relaxed);
+        Stats.NumCacheHits += NumCacheHits.load(std::memory_order_relaxed);
+        Stats.NumRefills += NumRefills.load(std::memory_order_relaxed);
+        Stats.NumFlushes += NumFlushes.load(std::memory_order_relaxed);
+    }
+};
+
+// Thread-local caches of all allocators used by the thread
+struct FixedBlockMemoryAllocator::ThreadCacheTable
+{
+    struct Entry
+    {
+        Uint64                       AllocatorId = 0;
+        std::shared_ptr<ThreadCache> pCache;
+    };
+    std::vector<Entry> Entries;
+
+    ~ThreadCacheTable()
+    {
+        // Return the blocks to the allocators that are still alive
+        for (auto& Entry : Entries)
+        {
+            Threading::SpinLockGuard Guard{Entry.pCache->Lock};
+            if (Entry.pCache->pOwner != nullptr)
+                Entry.pCache->pOwner->ReleaseThreadCache(*Entry.pCache);
+        }
+    }
+};
+
+thread_local FixedBlockMemoryAllocator::ThreadCacheTable FixedBlockMemoryAllocator::tl_ThreadCaches;
+
+static std::atomic<Uint64> g_NextAllocatorId{1};
+
 static size_t AdjustBlockSize(size_t BlockSize)
 {
     return AlignUp(BlockSize, sizeof(void*));
@@ -171,14 +239,17 @@ static size_t AdjustBlockSize(size_t BlockSize)
 
 FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                      size_t            BlockSize,
-                                                     Uint32            NumBlocksInPage) :
+                                                     Uint32            NumBlocksInPage,
+                                                     Uint32            ThreadCacheSize) :
     // clang-format off
     m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
     m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
     m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
     m_RawMemoryAllocator{RawMemoryAllocator        },
     m_BlockSize         {AdjustBlockSize(BlockSize)},
-    m_NumBlocksInPage   {NumBlocksInPage           }
+    m_NumBlocksInPage   {NumBlocksInPage           },
+    m_ThreadCacheSize   {ThreadCacheSize           },
+    m_Id                {g_NextAllocatorId.fetch_add(1)}
 // clang-format on
 {
     // Allocate one page
@@ -190,6 +261,34 @@ FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemory
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
+    if (m_ThreadCacheSize > 0)
+    {
+        // NB: we must not lock the cache while holding m_Mutex, since a thread that
+        //     is exiting locks the cache first and then calls ReleaseThreadCache().
+        std::vector<std::shared_ptr<ThreadCache>> ThreadCaches;
+        {
+            std::lock_guard<std::mutex> LockGuard{m_Mutex};
+            ThreadCaches.swap(m_ThreadCaches);
+        }
+
+        std::vector<void*> Blocks;
+        for (auto& pCache : ThreadCaches)
+        {
+            Threading::SpinLockGuard Guard{pCache->Lock};
+            if (pCache->pOwner == nullptr)
+                continue; // The cache has been released by the thread
+
+            // Detach the cache so that the thread never uses it again
+            pCache->pOwner = nullptr;
+            Blocks.insert(Blocks.end(), pCache->Blocks.begin(), pCache->Blocks.end());
+            pCache->Blocks.clear();
+        }
+
+        std::lock_guard<std::mutex> LockGuard{m_Mutex};
+        for (void* pBlock : Blocks)
+            FreeToPages(pBlock);
+    }
+
 #ifdef DILIGENT_DEBUG
     for (size_t p = 0; p < m_PagePool.size(); ++p)
     {
@@ -207,15 +306,8 @@ void FixedBlockMemoryAllocator::CreateNewPage()
     m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
 }
 
-void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+void* FixedBlockMemoryAllocator::AllocateFromPages()
 {
-    VERIFY_EXPR(Size > 0);
-
-    Size = AdjustBlockSize(Size);
-    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
-
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-
     if (m_AvailablePages.empty())
     {
         CreateNewPage();
@@ -233,10 +325,9 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     return Ptr;
 }
 
-void FixedBlockMemoryAllocator::Free(void* Ptr)
+void FixedBlockMemoryAllocator::FreeToPages(void* Ptr)
 {
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
+    auto PageIdIt = m_AddrToPageId.find(Ptr);
     if (PageIdIt != m_AddrToPageId.end())
     {
         auto PageId = PageIdIt->second;
@@ -259,6 +350,131 @@ void FixedBlockMemoryAllocator::Free(void* Ptr)
     }
 }
 
+FixedBlockMemoryAllocator::ThreadCache& FixedBlockMemoryAllocator::GetThreadCache()
+{
+    auto& Entries = tl_ThreadCaches.Entries;
+    for (auto& Entry : Entries)
+    {
+        if (Entry.AllocatorId == m_Id)
+            return *Entry.pCache;
+    }
+
+    // Remove the caches of the allocators that have been destroyed
+    Entries.erase(std::remove_if(Entries.begin(), Entries.end(),
+                                 [](ThreadCacheTable::Entry& Entry) {
+                                     Threading::SpinLockGuard Guard{Entry.pCache->Lock};
+                                     return Entry.pCache->pOwner == nullptr;
+                                 }),
+                  Entries.end());
+
+    auto pCache = std::make_shared<ThreadCache>(*this);
+    {
+        std::lock_guard<std::mutex> LockGuard{m_Mutex};
+        m_ThreadCaches.emplace_back(pCache);
+    }
+    Entries.emplace_back(ThreadCacheTable::Entry{m_Id, pCache});
+
+    return *pCache;
+}
+
+void FixedBlockMemoryAllocator::ReleaseThreadCache(ThreadCache& Cache)
+{
+    // Called by the thread that owns the cache when it exits.
+    // The cache lock is held by the caller.
+    VERIFY_EXPR(Cache.pOwner == this);
+
+    std::lock_guard<std::mutex> LockGuard{m_Mutex};
+    for (void* pBlock : Cache.Blocks)
+        FreeToPages(pBlock);
+    Cache.Blocks.clear();
+    Cache.AddStats(m_ReleasedCacheStats);
+    Cache.pOwner = nullptr;
+
+    m_ThreadCaches.erase(std::remove_if(m_ThreadCaches.begin(), m_ThreadCaches.end(),
+                                        [&Cache](const std::shared_ptr<ThreadCache>& pCache) {
+                                            return pCache.get() == &Cache;
+                                        }),
+                         m_ThreadCaches.end());
+}
+
+void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    Size = AdjustBlockSize(Size);
+    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+
+    if (m_ThreadCacheSize > 0)
+    {
+        ThreadCache& Cache = GetThreadCache();
+
+        Threading::SpinLockGuard Guard{Cache.Lock};
+        VERIFY_EXPR(Cache.pOwner == this);
+        ThreadCache::Increment(Cache.NumAllocations);
+        if (!Cache.Blocks.empty())
+        {
+            ThreadCache::Increment(Cache.NumCacheHits);
+        }
+        else
+        {
+            // Refill half of the cache at once
+            const Uint32 NumBlocks = std::max(m_ThreadCacheSize / 2, 1u);
+
+            std::lock_guard<std::mutex> LockGuard{m_Mutex};
+            for (Uint32 i = 0; i < NumBlocks; ++i)
+                Cache.Blocks.push_back(AllocateFromPages());
+            ThreadCache::Increment(Cache.NumRefills);
+        }
+
+        void* Ptr = Cache.Blocks.back();
+        Cache.Blocks.pop_back();
+        return Ptr;
+    }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    return AllocateFromPages();
+}
+
+void FixedBlockMemoryAllocator::Free(void* Ptr)
+{
+    if (m_ThreadCacheSize > 0)
+    {
+        ThreadCache& Cache = GetThreadCache();
+
+        Threading::SpinLockGuard Guard{Cache.Lock};
+        VERIFY_EXPR(Cache.pOwner == this);
+        if (Cache.Blocks.size() >= m_ThreadCacheSize)
+        {
+            // Return the oldest half of the cache to the memory pages
+            const size_t NumBlocks = std::max(Cache.Blocks.size() / 2, size_t{1});
+
+            {
+                std::lock_guard<std::mutex> LockGuard{m_Mutex};
+                for (size_t i = 0; i < NumBlocks; ++i)
+                    FreeToPages(Cache.Blocks[i]);
+            }
+            Cache.Blocks.erase(Cache.Blocks.begin(), Cache.Blocks.begin() + NumBlocks);
+            ThreadCache::Increment(Cache.NumFlushes);
+        }
+        Cache.Blocks.push_back(Ptr);
+        return;
+    }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    FreeToPages(Ptr);
+}
+
+FixedBlockMemoryAllocator::ThreadCacheStats FixedBlockMemoryAllocator::GetThreadCacheStats() const
+{
+    std::lock_guard<std::mutex> LockGuard{m_Mutex};
+
+    ThreadCacheStats Stats = m_ReleasedCacheStats;
+    for (const auto& pCache : m_ThreadCaches)
+        pCache->AddStats(Stats);
+
+    return Stats;
+}
+
 void* FixedBlockMemoryAllocator::AllocateAligned(size_t Size, size_t Alignment, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
 {
     VERIFY(Alignment <= sizeof(void*), "Alignment (", Alignment, ") exceeds the default alignment (", sizeof(void*), ")");
@@ -0,0 +1,245 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ShaderCompilationProfiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "CPUProfiler.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+std::atomic<bool> ShaderCompilationProfiler::sm_Enabled{false};
+
+namespace
+{
+
+// The innermost object scope of the current thread
+thread_local ShaderCompilationScope* t_pCurrentScope = nullptr;
+
+struct ProfilerState
+{
+    std::mutex Mtx;
+
+    ShaderCompilationSummary Summary;
+
+    // Shared pointer allows calling the callback outside of the lock
+    std::shared_ptr<const ShaderCompilationProfiler::CallbackType> pCallback;
+
+    static ProfilerState& Get()
+    {
+        static ProfilerState State;
+        return State;
+    }
+};
+
+void AccumulateStats(ShaderCompilationStats& Stats, const ShaderCompilationTimings& Timings)
+{
+    ++Stats.Count;
+    Stats.TotalTime += Timings.TotalTime;
+    for (Uint32 i = 0; i < SHADER_COMPILATION_STAGE_COUNT; ++i)
+        Stats.StageTimes[i] += Timings.StageTimes[i];
+    Stats.CacheHits += Timings.CacheHits;
+    Stats.CacheMisses += Timings.CacheMisses;
+    if (Stats.Count == 1 || Timings.TotalTime > Stats.MaxTime)
+    {
+        Stats.MaxTime     = Timings.TotalTime;
+        Stats.SlowestName = Timings.Name != nullptr ? Timings.Name : "";
+    }
+}
+
+} // namespace
+
+const char* GetShaderCompilationStageName(SHADER_COMPILATION_STAGE Stage)
+{
+    static_assert(SHADER_COMPILATION_STAGE_COUNT == 6, "Please handle the new stage below");
+    switch (Stage)
+    {
+        // clang-format off
+        case SHADER_COMPILATION_STAGE_PREPROCESS:     return "Preprocess";
+        case SHADER_COMPILATION_STAGE_COMPILE:        return "Compile";
+        case SHADER_COMPILATION_STAGE_OPTIMIZE:       return "Optimize";
+        case SHADER_COMPILATION_STAGE_CROSS_COMPILE:  return "Cross-compile";
+        case SHADER_COMPILATION_STAGE_REFLECTION:     return "Reflection";
+        case SHADER_COMPILATION_STAGE_DRIVER_COMPILE: return "Driver compile";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected shader compilation stage");
+            return "Unknown";
+    }
+}
+
+void ShaderCompilationProfiler::SetEnabled(bool Enabled)
+{
+    sm_Enabled.store(Enabled);
+}
+
+void ShaderCompilationProfiler::SetCallback(CallbackType Callback)
+{
+    ProfilerState& State = ProfilerState::Get();
+
+    std::shared_ptr<const CallbackType> pCallback;
+    if (Callback)
+        pCallback = std::make_shared<const CallbackType>(std::move(Callback));
+
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    State.pCallback = std::move(pCallback);
+}
+
+ShaderCompilationSummary ShaderCompilationProfiler::GetSummary()
+{
+    ProfilerState&              State = ProfilerState::Get();
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    return State.Summary;
+}
+
+void ShaderCompilationProfiler::ResetSummary()
+{
+    ProfilerState&              State = ProfilerState::Get();
+    std::lock_guard<std::mutex> Lock{State.Mtx};
+    State.Summary = {};
+}
+
+std::string ShaderCompilationProfiler::GetSummaryString()
+{
+    const ShaderCompilationSummary Summary = GetSummary();
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+
+    ss << std::left << std::setw(12) << "" << std::right << std::setw(8) << "Count" << std::setw(12) << "Total, ms";
+    for (Uint32 i = 0; i < SHADER_COMPILATION_STAGE_COUNT; ++i)
+        ss << std::setw(16) << GetShaderCompilationStageName(static_cast<SHADER_COMPILATION_STAGE>(i));
+    ss << std::setw(12) << "Other" << std::setw(12) << "Cache hits" << std::setw(14) << "Cache misses" << '\n';
+
+    auto PrintStats = [&ss](const char* Label, const ShaderCompilationStats& Stats) {
+        ss << std::left << std::setw(12) << Label << std::right << std::setw(8) << Stats.Count << std::setw(12) << Stats.TotalTime * 1000.0;
+
+        double StagesTime = 0;
+        for (Uint32 i = 0; i < SHADER_COMPILATION_STAGE_COUNT; ++i)
+        {
+            ss << std::setw(16) << Stats.StageTimes[i] * 1000.0;
+            StagesTime += Stats.StageTimes[i];
+        }
+        ss << std::setw(12) << std::max(Stats.TotalTime - StagesTime, 0.0) * 1000.0
+           << std::setw(12) << Stats.CacheHits
+           << std::setw(14) << Stats.CacheMisses << '\n';
+    };
+    PrintStats("Shaders", Summary.Shaders);
+    PrintStats("Pipelines", Summary.Pipelines);
+
+    if (Summary.Shaders.Count > 0)
+        ss << "Slowest shader: '" << Summary.Shaders.SlowestName << "' (" << Summary.Shaders.MaxTime * 1000.0 << " ms)\n";
+    if (Summary.Pipelines.Count > 0)
+        ss << "Slowest pipeline: '" << Summary.Pipelines.SlowestName << "' (" << Summary.Pipelines.MaxTime * 1000.0 << " ms)\n";
+
+    return ss.str();
+}
+
+void ShaderCompilationProfiler::AddCacheResult(bool Hit)
+{
+    if (!IsEnabled())
+        return;
+
+    if (ShaderCompilationScope* pScope = t_pCurrentScope)
+    {
+        if (Hit)
+            ++pScope->m_Timings.CacheHits;
+        else
+            ++pScope->m_Timings.CacheMisses;
+    }
+}
+
+void ShaderCompilationProfiler::Report(const ShaderCompilationTimings& Timings)
+{
+    ProfilerState& State = ProfilerState::Get();
+
+    std::shared_ptr<const CallbackType> pCallback;
+    {
+        std::lock_guard<std::mutex> Lock{State.Mtx};
+        AccumulateStats(Timings.IsPipeline ? State.Summary.Pipelines : State.Summary.Shaders, Timings);
+        pCallback = State.pCallback;
+    }
+
+    if (pCallback)
+        (*pCallback)(Timings);
+}
+
+
+void ShaderCompilationScope::Begin(const char* Name, bool IsPipeline)
+{
+    m_Timings.Name       = Name != nullptr ? Name : "";
+    m_Timings.IsPipeline = IsPipeline;
+    m_pParent            = t_pCurrentScope;
+    t_pCurrentScope      = this;
+    m_IsActive           = true;
+    m_StartTime          = CPUProfiler::GetTimestamp();
+}
+
+void ShaderCompilationScope::End()
+{
+    m_Timings.TotalTime = static_cast<double>(CPUProfiler::GetTimestamp() - m_StartTime) * 1e-9;
+    VERIFY(t_pCurrentScope == this, "Shader compilation scopes must be destroyed in reverse order");
+    VERIFY(m_pActiveStage == nullptr, "All stage scopes must be ended before the object scope");
+    t_pCurrentScope = m_pParent;
+    m_IsActive      = false;
+    ShaderCompilationProfiler::Report(m_Timings);
+}
+
+
+void ShaderCompilationStageScope::Begin(SHADER_COMPILATION_STAGE Stage)
+{
+    VERIFY_EXPR(Stage < SHADER_COMPILATION_STAGE_COUNT);
+    m_pScope = t_pCurrentScope;
+    if (m_pScope == nullptr)
+        return;
+
+    m_Stage                  = Stage;
+    m_pParent                = m_pScope->m_pActiveStage;
+    m_pScope->m_pActiveStage = this;
+    m_StartTime              = CPUProfiler::GetTimestamp();
+}
+
+void ShaderCompilationStageScope::End()
+{
+    const Uint64 Elapsed = CPUProfiler::GetTimestamp() - m_StartTime;
+    VERIFY(m_pScope->m_pActiveStage == this, "Stage scopes must be destroyed in reverse order");
+
+    m_pScope->m_Timings.StageTimes[m_Stage] += static_cast<double>(Elapsed - std::min(m_ChildTime, Elapsed)) * 1e-9;
+    if (m_pParent != nullptr)
+        m_pParent->m_ChildTime += Elapsed;
+    m_pScope->m_pActiveStage = m_pParent;
+    m_pScope                 = nullptr;
+}
+
+} // namespace Diligent
@@ -0,0 +1,457 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "SoftwareOcclusionCuller.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "Align.hpp"
+#include "DebugUtilities.hpp"
+#include "Intrinsics.hpp"
+#include "ThreadPool.hpp"
+
+#if !defined(DILIGENT_DISABLE_SIMD_MATH)
+#    if DILIGENT_SSE2_ENABLED
+#        define DILIGENT_SOC_SSE 1
+#    elif DILIGENT_NEON_ENABLED
+#        define DILIGENT_SOC_NEON 1
+#    endif
+#endif
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Returns true if the clip-space position is in front of the near plane
+inline bool IsInFrontOfNearPlane(const float4& ClipPos, bool IsOpenGL)
+{
+    return ClipPos.w > 0 && ClipPos.z >= (IsOpenGL ? -ClipPos.w : 0.f);
+}
+
+// Converts the clip-space position to the screen space, where pixel centers are located at integer coordinates
+inline float3 ClipToScreen(const float4& ClipPos, float Width, float Height, bool IsOpenGL)
+{
+    const float InvW = 1.f / ClipPos.w;
+
+    float3 ScreenPos;
+    ScreenPos.x = (ClipPos.x * InvW * 0.5f + 0.5f) * Width - 0.5f;
+    ScreenPos.y = (0.5f - ClipPos.y * InvW * 0.5f) * Height - 0.5f;
+    ScreenPos.z = ClipPos.z * InvW;
+    if (IsOpenGL)
+        ScreenPos.z = ScreenPos.z * 0.5f + 0.5f;
+    return ScreenPos;
+}
+
+// Processes pixels [MinX, MaxX] of row Y. MinX must be a multiple of 4 and MaxX + 3 must not exceed the row length.
+// NB: all implementations must perform the same operations in the same order to produce identical results.
+template <typename TriangleType>
+void RasterizeSpan(const TriangleType& Tri, int Y, int MinX, int MaxX, float* pRow)
+{
+    VERIFY_EXPR(MinX % 4 == 0);
+
+    const float fY    = static_cast<float>(Y);
+    const float E0Row = Tri.EdgeB[0] * fY + Tri.EdgeC[0];
+    const float E1Row = Tri.EdgeB[1] * fY + Tri.EdgeC[1];
+    const float E2Row = Tri.EdgeB[2] * fY + Tri.EdgeC[2];
+    const float ZRow  = Tri.ZB * fY + Tri.ZC;
+
+#if DILIGENT_SOC_SSE
+    const __m128 Zero    = _mm_setzero_ps();
+    const __m128 Offsets = _mm_setr_ps(0, 1, 2, 3);
+    const __m128 A0      = _mm_set1_ps(Tri.EdgeA[0]);
+    const __m128 A1      = _mm_set1_ps(Tri.EdgeA[1]);
+    const __m128 A2      = _mm_set1_ps(Tri.EdgeA[2]);
+    const __m128 ZA      = _mm_set1_ps(Tri.ZA);
+    const __m128 vE0Row  = _mm_set1_ps(E0Row);
+    const __m128 vE1Row  = _mm_set1_ps(E1Row);
+    const __m128 vE2Row  = _mm_set1_ps(E2Row);
+    const __m128 vZRow   = _mm_set1_ps(ZRow);
+    for (int x = MinX; x <= MaxX; x += 4)
+    {
+        const __m128 X = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), Offsets);
+
+        const __m128 E0 = _mm_add_ps(_mm_mul_ps(A0, X), vE0Row);
+        const __m128 E1 = _mm_add_ps(_mm_mul_ps(A1, X), vE1Row);
+        const __m128 E2 = _mm_add_ps(_mm_mul_ps(A2, X), vE2Row);
+
+        const __m128 Inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(E0, Zero), _mm_cmpge_ps(E1, Zero)), _mm_cmpge_ps(E2, Zero));
+        if (_mm_movemask_ps(Inside) == 0)
+            continue;
+
+        const __m128 Z      = _mm_max_ps(_mm_add_ps(_mm_mul_ps(ZA, X), vZRow), Zero);
+        const __m128 Depth  = _mm_loadu_ps(pRow + x);
+        const __m128 Result = _mm_or_ps(_mm_and_ps(Inside, _mm_min_ps(Depth, Z)), _mm_andnot_ps(Inside, Depth));
+        _mm_storeu_ps(pRow + x, Result);
+    }
+#elif DILIGENT_SOC_NEON
+    const float32x4_t Zero    = vdupq_n_f32(0);
+    const float       OffsetsData[4]{0, 1, 2, 3};
+    const float32x4_t Offsets = vld1q_f32(OffsetsData);
+    const float32x4_t vE0Row  = vdupq_n_f32(E0Row);
+    const float32x4_t vE1Row  = vdupq_n_f32(E1Row);
+    const float32x4_t vE2Row  = vdupq_n_f32(E2Row);
+    const float32x4_t vZRow   = vdupq_n_f32(ZRow);
+    for (int x = MinX; x <= MaxX; x += 4)
+    {
+        const float32x4_t X = vaddq_f32(vdupq_n_f32(static_cast<float>(x)), Offsets);
+
+        // NB: use separate multiplications and additions rather than fused multiply-add
+        //     to match the results of the scalar code.
+        const float32x4_t E0 = vaddq_f32(vmulq_n_f32(X, Tri.EdgeA[0]), vE0Row);
+        const float32x4_t E1 = vaddq_f32(vmulq_n_f32(X, Tri.EdgeA[1]), vE1Row);
+        const float32x4_t E2 = vaddq_f32(vmulq_n_f32(X, Tri.EdgeA[2]), vE2Row);
+
+        const uint32x4_t Inside = vandq_u32(vandq_u32(vcgeq_f32(E0, Zero), vcgeq_f32(E1, Zero)), vcgeq_f32(E2, Zero));
+        const uint32x2_t AnyInside = vorr_u32(vget_low_u32(Inside), vget_high_u32(Inside));
+        if ((vget_lane_u32(AnyInside, 0) | vget_lane_u32(AnyInside, 1)) == 0)
+            continue;
+
+        const float32x4_t Z     = vmaxq_f32(vaddq_f32(vmulq_n_f32(X, Tri.ZA), vZRow), Zero);
+        const float32x4_t Depth = vld1q_f32(pRow + x);
+        vst1q_f32(pRow + x, vbslq_f32(Inside, vminq_f32(Depth, Z), Depth));
+    }
+#else
+    for (int x = MinX; x <= MaxX; ++x)
+    {
+        const float X = static_cast<float>(x);
+        if (Tri.EdgeA[0] * X + E0Row >= 0 &&
+            Tri.EdgeA[1] * X + E1Row >= 0 &&
+            Tri.EdgeA[2] * X + E2Row >= 0)
+        {
+            const float Z = (std::max)(Tri.ZA * X + ZRow, 0.f);
+            pRow[x]       = (std::min)(pRow[x], Z);
+        }
+    }
+#endif
+}
+
+// Runs Handler(Start, Count) for chunks of ItemsPerTask items. The first chunk is processed
+// by the calling thread, and the remaining chunks are processed by the thread pool.
+template <typename HandlerType>
+void ProcessInParallel(IThreadPool* pThreadPool, size_t NumItems, size_t ItemsPerTask, HandlerType Handler)
+{
+    if (pThreadPool == nullptr || NumItems <= ItemsPerTask)
+    {
+        Handler(size_t{0}, NumItems);
+        return;
+    }
+
+    const size_t NumChunks = (NumItems + ItemsPerTask - 1) / ItemsPerTask;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(NumChunks - 1);
+    for (size_t chunk = 1; chunk < NumChunks; ++chunk)
+    {
+        const size_t Start = chunk * ItemsPerTask;
+        const size_t Count = std::min(ItemsPerTask, NumItems - Start);
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [Handler, Start, Count](Uint32 ThreadId) {
+                                                Handler(Start, Count);
+                                                return ASYNC_TASK_STATUS_COMPLETE;
+                                            }));
+    }
+
+    Handler(size_t{0}, ItemsPerTask);
+
+    std::vector<IAsyncTask*> pTasks(Tasks.size());
+    for (size_t i = 0; i < Tasks.size(); ++i)
+        pTasks[i] = Tasks[i];
+    WaitForAllTasks(pTasks.data(), static_cast<Uint32>(pTasks.size()));
+}
+
+} // namespace
+
+SoftwareOcclusionCuller::SoftwareOcclusionCuller(const CreateInfo& CI) :
+    m_Width{AlignUp(std::max(CI.Width, 1u), TileSize)},
+    m_Height{AlignUp(std::max(CI.Height, 1u), TileSize)},
+    m_NumTilesX{m_Width / TileSize},
+    m_NumTilesY{m_Height / TileSize},
+    m_TilesPerTask{std::max(CI.TilesPerTask, 1u)},
+    m_BoxesPerTask{AlignUp(std::max(CI.BoxesPerTask, 1u), 32u)},
+    m_pThreadPool{CI.pThreadPool},
+    m_Depth(size_t{m_Width} * m_Height, 1.f),
+    m_TileMaxDepth(size_t{m_NumTilesX} * m_NumTilesY, 1.f),
+    m_TileBins(size_t{m_NumTilesX} * m_NumTilesY)
+{
+}
+
+const char* SoftwareOcclusionCuller::GetImplementationName()
+{
+#if DILIGENT_SOC_SSE
+    return "SSE2";
+#elif DILIGENT_SOC_NEON
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+void SoftwareOcclusionCuller::BeginFrame(const float4x4& ViewProj, bool IsOpenGL)
+{
+    m_ViewProj = ViewProj;
+    m_IsOpenGL = IsOpenGL;
+
+    std::fill(m_Depth.begin(), m_Depth.end(), 1.f);
+    std::fill(m_TileMaxDepth.begin(), m_TileMaxDepth.end(), 1.f);
+    m_Triangles.clear();
+}
+
+void SoftwareOcclusionCuller::AddOccluder(const float3*   pVertices,
+                                          Uint32          NumVertices,
+                                          const Uint32*   pIndices,
+                                          Uint32          NumIndices,
+                                          const float4x4& World)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") must be a multiple of 3");
+    if (NumVertices == 0 || NumIndices < 3)
+        return;
+    VERIFY_EXPR(pVertices != nullptr && pIndices != nullptr);
+
+    const float4x4 WorldViewProj = World * m_ViewProj;
+
+    m_ClipVerts.resize(NumVertices);
+    for (Uint32 i = 0; i < NumVertices; ++i)
+        m_ClipVerts[i] = float4{pVertices[i], 1} * WorldViewProj;
+
+    const float Width  = static_cast<float>(m_Width);
+    const float Height = static_cast<float>(m_Height);
+    for (Uint32 i = 0; i + 2 < NumIndices; i += 3)
+    {
+        const Uint32 Idx[] = {pIndices[i], pIndices[i + 1], pIndices[i + 2]};
+        DEV_CHECK_ERR(Idx[0] < NumVertices && Idx[1] < NumVertices && Idx[2] < NumVertices, "Triangle ", i / 3, " references a vertex out of range");
+
+        // Skipping triangles that cross the near plane makes the culling less efficient, but keeps it conservative
+        if (!IsInFrontOfNearPlane(m_ClipVerts[Idx[0]], m_IsOpenGL) ||
+            !IsInFrontOfNearPlane(m_ClipVerts[Idx[1]], m_IsOpenGL) ||
+            !IsInFrontOfNearPlane(m_ClipVerts[Idx[2]], m_IsOpenGL))
+            continue;
+
+        const float3 V[] = {
+            ClipToScreen(m_ClipVerts[Idx[0]], Width, Height, m_IsOpenGL),
+            ClipToScreen(m_ClipVerts[Idx[1]], Width, Height, m_IsOpenGL),
+            ClipToScreen(m_ClipVerts[Idx[2]], Width, Height, m_IsOpenGL),
+        };
+
+        // Triangles beyond the far plane can't occlude anything
+        if (V[0].z >= 1 && V[1].z >= 1 && V[2].z >= 1)
+            continue;
+
+        Triangle Tri;
+        Tri.MinX = std::max(static_cast<int>(FastCeil(std::min({V[0].x, V[1].x, V[2].x}))), 0);
+        Tri.MinY = std::max(static_cast<int>(FastCeil(std::min({V[0].y, V[1].y, V[2].y}))), 0);
+        Tri.MaxX = std::min(static_cast<int>(FastFloor(std::max({V[0].x, V[1].x, V[2].x}))), static_cast<int>(m_Width) - 1);
+        Tri.MaxY = std::min(static_cast<int>(FastFloor(std::max({V[0].y, V[1].y, V[2].y}))), static_cast<int>(m_Height) - 1);
+        if (Tri.MinX > Tri.MaxX || Tri.MinY > Tri.MaxY)
+            continue;
+
+        // Edge j is opposite to vertex j, so that E_j(V_j) is twice the signed triangle area
+        for (int j = 0; j < 3; ++j)
+        {
+            const float3& Va = V[(j + 1) % 3];
+            const float3& Vb = V[(j + 2) % 3];
+
+            Tri.EdgeA[j] = Va.y - Vb.y;
+            Tri.EdgeB[j] = Vb.x - Va.x;
+            Tri.EdgeC[j] = -(Tri.EdgeA[j] * Va.x + Tri.EdgeB[j] * Va.y);
+        }
+
+        const float Area = Tri.EdgeA[0] * V[0].x + Tri.EdgeB[0] * V[0].y + Tri.EdgeC[0];
+        if (Area == 0)
+            continue;
+
+        // Make the edge functions non-negative inside the triangle regardless of the winding order
+        if (Area < 0)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                Tri.EdgeA[j] = -Tri.EdgeA[j];
+                Tri.EdgeB[j] = -Tri.EdgeB[j];
+                Tri.EdgeC[j] = -Tri.EdgeC[j];
+            }
+        }
+
+        // Z = (E_0 * Z_0 + E_1 * Z_1 + E_2 * Z_2) / Area
+        const float InvArea = 1.f / std::abs(Area);
+        Tri.ZA              = (Tri.EdgeA[0] * V[0].z + Tri.EdgeA[1] * V[1].z + Tri.EdgeA[2] * V[2].z) * InvArea;
+        Tri.ZB              = (Tri.EdgeB[0] * V[0].z + Tri.EdgeB[1] * V[1].z + Tri.EdgeB[2] * V[2].z) * InvArea;
+        Tri.ZC              = (Tri.EdgeC[0] * V[0].z + Tri.EdgeC[1] * V[1].z + Tri.EdgeC[2] * V[2].z) * InvArea;
+
+        m_Triangles.push_back(Tri);
+    }
+}
+
+void SoftwareOcclusionCuller::RasterizeTile(Uint32 TileIdx)
+{
+    const std::vector<Uint32>& Bin = m_TileBins[TileIdx];
+    if (Bin.empty())
+        return;
+
+    const int TileMinX = static_cast<int>((TileIdx % m_NumTilesX) * TileSize);
+    const int TileMinY = static_cast<int>((TileIdx / m_NumTilesX) * TileSize);
+    const int TileMaxX = TileMinX + static_cast<int>(TileSize) - 1;
+    const int TileMaxY = TileMinY + static_cast<int>(TileSize) - 1;
+
+    for (Uint32 TriIdx : Bin)
+    {
+        const Triangle& Tri = m_Triangles[TriIdx];
+
+        // Start at a 4-pixel boundary. The tile size is a multiple of 4, so the spans never cross the tile boundary.
+        const int MinX = std::max(Tri.MinX, TileMinX) & ~3;
+        const int MaxX = std::min(Tri.MaxX, TileMaxX);
+        const int MinY = std::max(Tri.MinY, TileMinY);
+        const int MaxY = std::min(Tri.MaxY, TileMaxY);
+        for (int y = MinY; y <= MaxY; ++y)
+            RasterizeSpan(Tri, y, MinX, MaxX, &m_Depth[size_t{m_Width} * y]);
+    }
+
+    float MaxDepth = 0;
+    for (int y = TileMinY; y <= TileMaxY; ++y)
+    {
+        const float* pRow = &m_Depth[size_t{m_Width} * y];
+        for (int x = TileMinX; x <= TileMaxX; ++x)
+            MaxDepth = std::max(MaxDepth, pRow[x]);
+    }
+    m_TileMaxDepth[TileIdx] = MaxDepth;
+}
+
+void SoftwareOcclusionCuller::RasterizeOccluders()
+{
+    static_assert(TileSize % 4 == 0, "Tile size must be a multiple of SIMD width");
+
+    for (std::vector<Uint32>& Bin : m_TileBins)
+        Bin.clear();
+
+    for (size_t i = 0; i < m_Triangles.size(); ++i)
+    {
+        const Triangle& Tri = m_Triangles[i];
+        for (Uint32 ty = Tri.MinY / TileSize; ty <= Tri.MaxY / TileSize; ++ty)
+        {
+            for (Uint32 tx = Tri.MinX / TileSize; tx <= Tri.MaxX / TileSize; ++tx)
+                m_TileBins[ty * m_NumTilesX + tx].push_back(static_cast<Uint32>(i));
+        }
+    }
+
+    // Tiles are independent, so they can be rasterized in parallel without synchronization
+    ProcessInParallel(m_pThreadPool, m_TileBins.size(), m_TilesPerTask,
+                      [this](size_t Start, size_t Count) {
+                          for (size_t i = Start; i < Start + Count; ++i)
+                              RasterizeTile(static_cast<Uint32>(i));
+                      });
+}
+
+bool SoftwareOcclusionCuller::IsBoxVisible(const BoundBox& Box) const
+{
+    const float Width  = static_cast<float>(m_Width);
+    const float Height = static_cast<float>(m_Height);
+
+    float2 RectMin{+FLT_MAX, +FLT_MAX};
+    float2 RectMax{-FLT_MAX, -FLT_MAX};
+    float  MinZ = +FLT_MAX;
+    for (Uint32 i = 0; i < 8; ++i)
+    {
+        const float3 Corner{
+            (i & 0x01) ? Box.Max.x : Box.Min.x,
+            (i & 0x02) ? Box.Max.y : Box.Min.y,
+            (i & 0x04) ? Box.Max.z : Box.Min.z,
+        };
+        const float4 ClipPos = float4{Corner, 1} * m_ViewProj;
+        if (!IsInFrontOfNearPlane(ClipPos, m_IsOpenGL))
+            return true;
+
+        const float3 ScreenPos = ClipToScreen(ClipPos, Width, Height, m_IsOpenGL);
+
+        RectMin.x = std::min(RectMin.x, ScreenPos.x);
+        RectMin.y = std::min(RectMin.y, ScreenPos.y);
+        RectMax.x = std::max(RectMax.x, ScreenPos.x);
+        RectMax.y = std::max(RectMax.y, ScreenPos.y);
+        MinZ      = std::min(MinZ, ScreenPos.z);
+    }
+    // Boxes beyond the far plane are not occluded by the cleared depth
+    MinZ = std::min(MinZ, 1.f);
+
+    // Use the pixels whose centers are outside of the box, but are closer than one pixel to it
+    const int MinX = std::max(static_cast<int>(FastFloor(RectMin.x)), 0);
+    const int MinY = std::max(static_cast<int>(FastFloor(RectMin.y)), 0);
+    const int MaxX = std::min(static_cast<int>(FastCeil(RectMax.x)), static_cast<int>(m_Width) - 1);
+    const int MaxY = std::min(static_cast<int>(FastCeil(RectMax.y)), static_cast<int>(m_Height) - 1);
+    if (MinX > MaxX || MinY > MaxY)
+        return true;
+
+    for (int ty = MinY / static_cast<int>(TileSize); ty <= MaxY / static_cast<int>(TileSize); ++ty)
+    {
+        for (int tx = MinX / static_cast<int>(TileSize); tx <= MaxX / static_cast<int>(TileSize); ++tx)
+        {
+            // All pixels of the tile are closer than the box
+            if (m_TileMaxDepth[ty * m_NumTilesX + tx] < MinZ)
+                continue;
+
+            const int TileMinX = std::max(tx * static_cast<int>(TileSize), MinX);
+            const int TileMinY = std::max(ty * static_cast<int>(TileSize), MinY);
+            const int TileMaxX = std::min((tx + 1) * static_cast<int>(TileSize) - 1, MaxX);
+            const int TileMaxY = std::min((ty + 1) * static_cast<int>(TileSize) - 1, MaxY);
+            for (int y = TileMinY; y <= TileMaxY; ++y)
+            {
+                const float* pRow = &m_Depth[size_t{m_Width} * y];
+                for (int x = TileMinX; x <= TileMaxX; ++x)
+                {
+                    if (pRow[x] >= MinZ)
+                        return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void SoftwareOcclusionCuller::TestBoxes(const BoundBox* pBoxes, size_t NumBoxes, Uint32* pVisibilityMask) const
+{
+    if (NumBoxes == 0)
+        return;
+    VERIFY_EXPR(pBoxes != nullptr && pVisibilityMask != nullptr);
+
+    // The chunks start at 32-box boundaries, so that the tasks never write to the same mask element
+    ProcessInParallel(m_pThreadPool, NumBoxes, m_BoxesPerTask,
+                      [this, pBoxes, NumBoxes, pVisibilityMask](size_t Start, size_t Count) {
+                          VERIFY_EXPR(Start % 32 == 0 && Start + Count <= NumBoxes);
+                          for (size_t i = Start; i < Start + Count; i += 32)
+                          {
+                              Uint32 Bits = 0;
+                              for (size_t j = 0; j < std::min(size_t{32}, Start + Count - i); ++j)
+                              {
+                                  if (IsBoxVisible(pBoxes[i + j]))
+                                      Bits |= 1u << j;
+                              }
+                              pVisibilityMask[i / 32] = Bits;
+                          }
+                      });
+}
+
+} // namespace Diligent
@@ -0,0 +1,284 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TaskGraph.hpp"
+
+#include <atomic>
+#include <memory>
+
+#include "ThreadSignal.hpp"
+
+namespace Diligent
+{
+
+class TaskGraph::GraphState final : public ObjectBase<IObject>
+{
+public:
+    using TBase = ObjectBase<IObject>;
+
+    GraphState(IReferenceCounters* pRefCounters, IThreadPool* pThreadPool) :
+        TBase{pRefCounters},
+        m_pThreadPool{pThreadPool}
+    {
+        VERIFY_EXPR(m_pThreadPool);
+    }
+
+    struct Node
+    {
+        RefCntAutoPtr<IAsyncTask> pTask;
+
+        // The wrapper task that is enqueued into the thread pool.
+        // The reference is released when the node is enqueued.
+        RefCntAutoPtr<NodeTask> pNodeTask;
+
+        std::vector<Uint32> Dependents;
+
+        Uint32 NumPrerequisites = 0;
+    };
+
+    void OnNodeFinished(Uint32 NodeIdx);
+    void EnqueueNode(Uint32 NodeIdx);
+
+    // NB: the state must not keep a strong reference to the thread pool, since the state
+    //     may be released by a worker thread, which would then destroy the pool.
+    IThreadPool* const m_pThreadPool;
+
+    std::vector<Node> m_Nodes;
+
+    // The number of unfinished prerequisites of every node
+    std::unique_ptr<std::atomic<Uint32>[]> m_PendingPrerequisites;
+
+    std::atomic<Uint32> m_NumPendingNodes{0};
+
+    bool m_IsExecuted = false;
+
+    Threading::Signal m_CompletionSignal;
+};
+
+class TaskGraph::NodeTask final : public AsyncTaskBase
+{
+public:
+    NodeTask(IReferenceCounters* pRefCounters,
+             GraphState*         pState,
+             Uint32              NodeIdx) :
+        AsyncTaskBase{pRefCounters},
+        m_pState{pState},
+        m_NodeIdx{NodeIdx}
+    {}
+
+    virtual ASYNC_TASK_STATUS DILIGENT_CALL_TYPE Run(Uint32 ThreadId) override final
+    {
+        IAsyncTask* pTask = m_pState->m_Nodes[m_NodeIdx].pTask;
+
+        ASYNC_TASK_STATUS Status = ASYNC_TASK_STATUS_CANCELLED;
+        if (!m_bSafelyCancel.load())
+        {
+            pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+            Status = pTask->Run(ThreadId);
+        }
+        // Keep the same contract as the thread pool: the status is set after Run() returns.
+        pTask->SetStatus(Status);
+
+        if (pTask->IsFinished())
+        {
+            m_pState->OnNodeFinished(m_NodeIdx);
+        }
+        else
+        {
+            // The task requested to be re-run
+            SetPriority(pTask->GetPriority());
+        }
+
+        return Status;
+    }
+
+    virtual void DILIGENT_CALL_TYPE Cancel() override final
+    {
+        AsyncTaskBase::Cancel();
+        m_pState->m_Nodes[m_NodeIdx].pTask->Cancel();
+    }
+
+private:
+    // Keep the state alive while the task is running, so that the
+    // graph object may be destroyed before all tasks are finished.
+    RefCntAutoPtr<GraphState> m_pState;
+
+    const Uint32 m_NodeIdx;
+};
+
+void TaskGraph::GraphState::EnqueueNode(Uint32 NodeIdx)
+{
+    Node& N = m_Nodes[NodeIdx];
+    VERIFY_EXPR(N.pNodeTask);
+
+    // Release the reference held by the node to break the reference cycle.
+    // The thread pool keeps its own reference until the task is finished.
+    RefCntAutoPtr<NodeTask> pNodeTask = std::move(N.pNodeTask);
+    pNodeTask->SetPriority(N.pTask->GetPriority());
+    m_pThreadPool->EnqueueTask(pNodeTask);
+}
+
+void TaskGraph::GraphState::OnNodeFinished(Uint32 NodeIdx)
+{
+    for (Uint32 Dependent : m_Nodes[NodeIdx].Dependents)
+    {
+        // fetch_sub returns the value immediately preceding the subtraction
+        const Uint32 NumPendingPrereqs = m_PendingPrerequisites[Dependent].fetch_sub(1) - 1;
+        if (NumPendingPrereqs == 0)
+        {
+            // This was the last prerequisite
+            EnqueueNode(Dependent);
+        }
+    }
+
+    if (m_NumPendingNodes.fetch_sub(1) - 1 == 0)
+    {
+        m_CompletionSignal.Trigger(/*NotifyAll = */ true);
+    }
+}
+
+
+TaskGraph::TaskGraph(IThreadPool* pThreadPool) :
+    m_pState{MakeNewRCObj<GraphState>()(pThreadPool)}
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+    if (!m_pState->m_IsExecuted)
+    {
+        // Break the reference cycles between the nodes and the state
+        for (GraphState::Node& N : m_pState->m_Nodes)
+            N.pNodeTask.Release();
+    }
+}
+
+Uint32 TaskGraph::AddTask(IAsyncTask* pTask)
+{
+    DEV_CHECK_ERR(pTask != nullptr, "Task must not be null");
+    DEV_CHECK_ERR(!m_pState->m_IsExecuted, "Tasks can't be added to the graph that has already been executed");
+
+    const Uint32 NodeIdx = static_cast<Uint32>(m_pState->m_Nodes.size());
+
+    GraphState::Node N;
+    N.pTask     = pTask;
+    N.pNodeTask = MakeNewRCObj<NodeTask>()(m_pState.RawPtr(), NodeIdx);
+    m_pState->m_Nodes.emplace_back(std::move(N));
+
+    return NodeIdx;
+}
+
+void TaskGraph::AddDependency(Uint32 Task, Uint32 Prerequisite)
+{
+    DEV_CHECK_ERR(!m_pState->m_IsExecuted, "Dependencies can't be added to the graph that has already been executed");
+    DEV_CHECK_ERR(Task < m_pState->m_Nodes.size(), "Task index (", Task, ") is out of range");
+    DEV_CHECK_ERR(Prerequisite < m_pState->m_Nodes.size(), "Prerequisite index (", Prerequisite, ") is out of range");
+    DEV_CHECK_ERR(Task != Prerequisite, "A task can't depend on itself");
+
+    m_pState->m_Nodes[Prerequisite].Dependents.push_back(Task);
+    ++m_pState->m_Nodes[Task].NumPrerequisites;
+}
+
+void TaskGraph::Execute()
+{
+    GraphState& State = *m_pState;
+    DEV_CHECK_ERR(!State.m_IsExecuted, "The graph has already been executed");
+    if (State.m_IsExecuted)
+        return;
+
+    const Uint32 NumNodes = static_cast<Uint32>(State.m_Nodes.size());
+
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        // Check that the graph has no cycles using Kahn's algorithm
+        std::vector<Uint32> NumPrereqs(NumNodes);
+        std::vector<Uint32> Queue;
+        Queue.reserve(NumNodes);
+        for (Uint32 i = 0; i < NumNodes; ++i)
+        {
+            NumPrereqs[i] = State.m_Nodes[i].NumPrerequisites;
+            if (NumPrereqs[i] == 0)
+                Queue.push_back(i);
+        }
+        for (size_t i = 0; i < Queue.size(); ++i)
+        {
+            for (Uint32 Dependent : State.m_Nodes[Queue[i]].Dependents)
+            {
+                if (--NumPrereqs[Dependent] == 0)
+                    Queue.push_back(Dependent);
+            }
+        }
+        DEV_CHECK_ERR(Queue.size() == NumNodes, "The task graph contains circular dependencies");
+    }
+#endif
+
+    State.m_IsExecuted = true;
+    State.m_PendingPrerequisites.reset(new std::atomic<Uint32>[NumNodes]);
+    for (Uint32 i = 0; i < NumNodes; ++i)
+        State.m_PendingPrerequisites[i].store(State.m_Nodes[i].NumPrerequisites);
+    State.m_NumPendingNodes.store(NumNodes);
+
+    if (NumNodes == 0)
+    {
+        State.m_CompletionSignal.Trigger(/*NotifyAll = */ true);
+        return;
+    }
+
+    // Collect the root nodes first as the nodes may start running and
+    // modify the state as soon as they are enqueued.
+    std::vector<Uint32> RootNodes;
+    for (Uint32 i = 0; i < NumNodes; ++i)
+    {
+        if (State.m_Nodes[i].NumPrerequisites == 0)
+            RootNodes.push_back(i);
+    }
+    for (Uint32 NodeIdx : RootNodes)
+        State.EnqueueNode(NodeIdx);
+}
+
+bool TaskGraph::IsFinished() const
+{
+    return m_pState->m_CompletionSignal.IsTriggered();
+}
+
+void TaskGraph::WaitForCompletion() const
+{
+    DEV_CHECK_ERR(m_pState->m_IsExecuted, "The graph has not been executed");
+    m_pState->m_CompletionSignal.Wait();
+}
+
+Uint32 TaskGraph::GetTaskCount() const
+{
+    return static_cast<Uint32>(m_pState->m_Nodes.size());
+}
+
+IAsyncTask* TaskGraph::GetTask(Uint32 Task) const
+{
+    DEV_CHECK_ERR(Task < m_pState->m_Nodes.size(), "Task index (", Task, ") is out of range");
+    return m_pState->m_Nodes[Task].pTask;
+}
+
+} // namespace Diligent
@@ -30,19 +30,312 @@
 #include <mutex>
 #include <thread>
 #include <map>
+#include <deque>
 #include <vector>
 #include <condition_variable>
 #include <cfloat>
+#include <chrono>
+#include <exception>
+#include <memory>
 
 #include "PlatformMisc.hpp"
 
 namespace Diligent
 {
 
+static void InitWorkerThread(const ThreadPoolCreateInfo& PoolCI, Uint64 CoresMask)
+{
+    if (CoresMask != 0)
+    {
+        if (PlatformMisc::SetCurrentThreadAffinity(CoresMask) == 0)
+            LOG_WARNING_MESSAGE_ONCE("Failed to set the thread pool worker thread affinity mask (0x", std::hex, CoresMask, ")");
+    }
+
+    if (PoolCI.WorkerThreadPriority != ThreadPriority::Unknown)
+    {
+        if (PlatformMisc::SetCurrentThreadPriority(PoolCI.WorkerThreadPriority) == ThreadPriority::Unknown)
+            LOG_WARNING_MESSAGE_ONCE("Failed to set the thread pool worker thread priority");
+    }
+}
+
 AsyncTaskBase::~AsyncTaskBase()
 {
 }
 
+namespace
+{
+
+// The event that is signaled whenever any task derived from AsyncTaskBase is finished
+struct TaskFinishedEvent
+{
+    std::mutex              Mtx;
+    std::condition_variable Cond;
+    std::atomic<int>        NumWaiters{0};
+};
+
+TaskFinishedEvent& GetTaskFinishedEvent()
+{
+    static TaskFinishedEvent Event;
+    return Event;
+}
+
+// Waits until the predicate returns true or the timeout expires.
+template <typename PredicateType>
+bool WaitForTaskFinishedEvent(PredicateType&& Predicate, Uint32 TimeoutMilliseconds)
+{
+    if (Predicate())
+        return true;
+    if (TimeoutMilliseconds == 0)
+        return false;
+
+    using Clock = std::chrono::steady_clock;
+
+    const auto Deadline = TimeoutMilliseconds != AsyncTaskBase::InfiniteTimeout ?
+        Clock::now() + std::chrono::milliseconds{TimeoutMilliseconds} :
+        Clock::time_point::max();
+
+    // Tasks that are not derived from AsyncTaskBase do not signal the event,
+    // so we need to periodically check the predicate.
+    constexpr auto PollInterval = std::chrono::milliseconds{10};
+
+    TaskFinishedEvent& Event = GetTaskFinishedEvent();
+    // NB: the number of waiters must be incremented before the predicate is checked, see NotifyTaskFinished().
+    Event.NumWaiters.fetch_add(1);
+
+    bool Result = false;
+    {
+        std::unique_lock<std::mutex> Lock{Event.Mtx};
+        while (!(Result = Predicate()))
+        {
+            const auto CurrTime = Clock::now();
+            if (CurrTime >= Deadline)
+                break;
+
+            const auto WaitUntil = Deadline - CurrTime > PollInterval ? CurrTime + PollInterval : Deadline;
+            Event.Cond.wait_until(Lock, WaitUntil);
+        }
+    }
+
+    Event.NumWaiters.fetch_add(-1);
+
+    return Result;
+}
+
+} // namespace
+
+void AsyncTaskBase::NotifyTaskFinished()
+{
+    TaskFinishedEvent& Event = GetTaskFinishedEvent();
+    // NB: the task status must be stored before the number of waiters is checked
+    if (Event.NumWaiters.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> Lock{Event.Mtx};
+        }
+        Event.Cond.notify_all();
+    }
+}
+
+bool WaitForAllTasks(IAsyncTask* const* ppTasks,
+                     Uint32             NumTasks,
+                     Uint32             TimeoutMilliseconds)
+{
+    if (ppTasks == nullptr || NumTasks == 0)
+        return true;
+
+    // Skip the tasks that are already finished
+    Uint32 FirstUnfinished = 0;
+    return WaitForTaskFinishedEvent(
+        [&]() {
+            for (; FirstUnfinished < NumTasks; ++FirstUnfinished)
+            {
+                if (ppTasks[FirstUnfinished] != nullptr && !ppTasks[FirstUnfinished]->IsFinished())
+                    return false;
+            }
+            return true;
+        },
+        TimeoutMilliseconds);
+}
+
+int WaitForAnyTask(IAsyncTask* const* ppTasks,
+                   Uint32             NumTasks,
+                   Uint32             TimeoutMilliseconds)
+{
+    if (ppTasks == nullptr)
+        return -1;
+
+    bool HasTasks = false;
+    for (Uint32 i = 0; i < NumTasks && !HasTasks; ++i)
+        HasTasks = ppTasks[i] != nullptr;
+    if (!HasTasks)
+        return -1;
+
+    int FinishedTask = -1;
+    WaitForTaskFinishedEvent(
+        [&]() {
+            for (Uint32 i = 0; i < NumTasks; ++i)
+            {
+                if (ppTasks[i] != nullptr && ppTasks[i]->IsFinished())
+                {
+                    FinishedTask = static_cast<int>(i);
+                    return true;
+                }
+            }
+            return false;
+        },
+        TimeoutMilliseconds);
+
+    return FinishedTask;
+}
+
+void ProcessItemsInParallel(IThreadPool* pThreadPool, size_t NumItems, std::function<void(size_t)> Handler) noexcept(false)
+{
+    // The state is shared with the tasks as they may start after the function returns
+    struct State
+    {
+        State(size_t _NumItems, std::function<void(size_t)>&& _Handler) :
+            NumItems{_NumItems},
+            Handler{std::move(_Handler)}
+        {}
+
+        bool ProcessNextItem()
+        {
+            const size_t Item = NextItem.fetch_add(1);
+            if (Item >= NumItems)
+                return false;
+
+            std::exception_ptr pItemException;
+            try
+            {
+                Handler(Item);
+            }
+            catch (...)
+            {
+                pItemException = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> Lock{Mtx};
+                if (pItemException && !pException)
+                    pException = pItemException;
+                ++NumCompleted;
+            }
+            CompletedCV.notify_all();
+            return true;
+        }
+
+        const size_t                NumItems;
+        std::function<void(size_t)> Handler;
+        std::atomic<size_t>         NextItem{0};
+
+        std::mutex              Mtx;
+        std::condition_variable CompletedCV;
+        size_t                  NumCompleted = 0;
+        std::exception_ptr      pException;
+    };
+    auto pState = std::make_shared<State>(NumItems, std::move(Handler));
+
+    for (size_t i = 1; i < NumItems; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [pState](Uint32 ThreadId) {
+                             pState->ProcessNextItem();
+                             return ASYNC_TASK_STATUS_COMPLETE;
+                         });
+    }
+
+    while (pState->ProcessNextItem())
+    {
+    }
+
+    std::unique_lock<std::mutex> Lock{pState->Mtx};
+    pState->CompletedCV.wait(Lock, [&]() { return pState->NumCompleted == pState->NumItems; });
+    if (pState->pException)
+        std::rethrow_exception(pState->pException);
+}
+
+
+namespace
+{
+
+struct QueuedTaskInfo
+{
+    RefCntAutoPtr<IAsyncTask>              pTask;
+    std::vector<RefCntWeakPtr<IAsyncTask>> Prerequisites;
+};
+
+QueuedTaskInfo MakeQueuedTaskInfo(IAsyncTask*  pTask,
+                                  IAsyncTask** ppPrerequisites,
+                                  Uint32       NumPrerequisites)
+{
+    QueuedTaskInfo TaskInfo;
+    TaskInfo.pTask = pTask;
+    if (ppPrerequisites != nullptr && NumPrerequisites > 0)
+    {
+        TaskInfo.Prerequisites.reserve(NumPrerequisites);
+        float MinPrereqPriority = +FLT_MAX;
+        for (Uint32 i = 0; i < NumPrerequisites; ++i)
+        {
+            if (ppPrerequisites[i] != nullptr)
+            {
+                TaskInfo.Prerequisites.emplace_back(ppPrerequisites[i]);
+                MinPrereqPriority = std::min(MinPrereqPriority, ppPrerequisites[i]->GetPriority());
+            }
+        }
+        if (pTask->GetPriority() > MinPrereqPriority)
+        {
+            TaskInfo.pTask->SetPriority(MinPrereqPriority);
+        }
+    }
+    return TaskInfo;
+}
+
+// Runs the task if all its prerequisites are met.
+// Returns true if the task is finished, and false if it needs to be re-enqueued.
+bool RunQueuedTask(QueuedTaskInfo& TaskInfo, Uint32 ThreadId)
+{
+    // Check prerequisites
+    bool  PrerequisitesMet  = true;
+    float MinPrereqPriority = +FLT_MAX;
+    for (auto& pPrereq : TaskInfo.Prerequisites)
+    {
+        if (auto pPrereqTask = pPrereq.Lock())
+        {
+            if (!pPrereqTask->IsFinished())
+            {
+                PrerequisitesMet  = false;
+                MinPrereqPriority = std::min(MinPrereqPriority, pPrereqTask->GetPriority());
+            }
+        }
+    }
+
+    bool TaskFinished = false;
+    if (PrerequisitesMet)
+    {
+        TaskInfo.pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+        ASYNC_TASK_STATUS ReturnStatus = TaskInfo.pTask->Run(ThreadId);
+        // NB: It is essential to set the task status after the Run() method returns.
+        //     This way if the GetStatus() method returns any value other than ASYNC_TASK_STATUS_RUNNING,
+        //     it is guaranteed that the task is not executed by any thread.
+        TaskInfo.pTask->SetStatus(ReturnStatus);
+        TaskFinished = TaskInfo.pTask->IsFinished();
+        DEV_CHECK_ERR((TaskFinished || TaskInfo.pTask->GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED),
+                      "Finished tasks must be in COMPLETE, CANCELLED or NOT_STARTED state");
+    }
+
+    if (!TaskFinished)
+    {
+        // If prerequisites are not met or the task requested to be re-run,
+        // re-enqueue the task with the minimum prerequisite priority
+        if (TaskInfo.pTask->GetPriority() > MinPrereqPriority)
+            TaskInfo.pTask->SetPriority(MinPrereqPriority);
+    }
+
+    return TaskFinished;
+}
+
+} // namespace
+
 class ThreadPoolImpl final : public ObjectBase<IThreadPool>
 {
 public:
@@ -52,12 +345,16 @@ public:
                    const ThreadPoolCreateInfo& PoolCI) :
         TBase{pRefCounters}
     {
+        const Uint64 CoresMask = PoolCI.NumThreads > 0 ? GetThreadPoolCoresMask(PoolCI.CorePlacement) : 0;
+
         m_WorkerThreads.reserve(PoolCI.NumThreads);
         for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
         {
             m_WorkerThreads.emplace_back(
-                [this, PoolCI, i] //
+                [this, PoolCI, CoresMask, i] //
                 {
+                    InitWorkerThread(PoolCI, CoresMask);
+
                     if (PoolCI.OnThreadStarted)
                         PoolCI.OnThreadStarted(i);
 
@@ -112,34 +409,7 @@ public:
 
         if (TaskInfo.pTask)
         {
-            // Check prerequisites
-            bool  PrerequisitesMet  = true;
-            float MinPrereqPriority = +FLT_MAX;
-            for (auto& pPrereq : TaskInfo.Prerequisites)
-            {
-                if (auto pPrereqTask = pPrereq.Lock())
-                {
-                    if (!pPrereqTask->IsFinished())
-                    {
-                        PrerequisitesMet  = false;
-                        MinPrereqPriority = std::min(MinPrereqPriority, pPrereqTask->GetPriority());
-                    }
-                }
-            }
-
-            bool TaskFinished = false;
-            if (PrerequisitesMet)
-            {
-                TaskInfo.pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
-                ASYNC_TASK_STATUS ReturnStatus = TaskInfo.pTask->Run(ThreadId);
-                // NB: It is essential to set the task status after the Run() method returns.
-                //     This way if the GetStatus() method returns any value other than ASYNC_TASK_STATUS_RUNNING,
-                //     it is guaranteed that the task is not executed by any thread.
-                TaskInfo.pTask->SetStatus(ReturnStatus);
-                TaskFinished = TaskInfo.pTask->IsFinished();
-                DEV_CHECK_ERR((TaskFinished || TaskInfo.pTask->GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED),
-                              "Finished tasks must be in COMPLETE, CANCELLED or NOT_STARTED state");
-            }
+            const bool TaskFinished = RunQueuedTask(TaskInfo, ThreadId);
 
             {
                 std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
@@ -155,10 +425,6 @@ public:
                 }
                 else
                 {
-                    // If prerequisites are not met or the task requested to be re-run,
-                    // re-enqueue the task with the minimum prerequisite priority
-                    if (TaskInfo.pTask->GetPriority() > MinPrereqPriority)
-                        TaskInfo.pTask->SetPriority(MinPrereqPriority);
                     m_TasksQueue.emplace(TaskInfo.pTask->GetPriority(), std::move(TaskInfo));
                 }
             }
@@ -184,26 +450,7 @@ public:
             std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
             DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
 
-            QueuedTaskInfo TaskInfo;
-            TaskInfo.pTask = pTask;
-            if (ppPrerequisites != nullptr && NumPrerequisites > 0)
-            {
-                TaskInfo.Prerequisites.reserve(NumPrerequisites);
-                float MinPrereqPriority = +FLT_MAX;
-                for (Uint32 i = 0; i < NumPrerequisites; ++i)
-                {
-                    if (ppPrerequisites[i] != nullptr)
-                    {
-                        TaskInfo.Prerequisites.emplace_back(ppPrerequisites[i]);
-                        MinPrereqPriority = std::min(MinPrereqPriority, ppPrerequisites[i]->GetPriority());
-                    }
-                }
-                if (pTask->GetPriority() > MinPrereqPriority)
-                {
-                    TaskInfo.pTask->SetPriority(MinPrereqPriority);
-                }
-            }
-
+            QueuedTaskInfo TaskInfo = MakeQueuedTaskInfo(pTask, ppPrerequisites, NumPrerequisites);
             m_TasksQueue.emplace(pTask->GetPriority(), std::move(TaskInfo));
         }
         m_NextTaskCond.notify_one();
@@ -329,11 +576,6 @@ public:
 private:
     std::vector<std::thread> m_WorkerThreads;
 
-    struct QueuedTaskInfo
-    {
-        RefCntAutoPtr<IAsyncTask>              pTask;
-        std::vector<RefCntWeakPtr<IAsyncTask>> Prerequisites;
-    };
     // Priority queue
     std::mutex                                                m_TasksQueueMtx;
     std::multimap<float, QueuedTaskInfo, std::greater<float>> m_TasksQueue;
@@ -347,9 +589,463 @@ private:
     std::atomic<int> m_NumRunningTasks{0};
 };
 
+// Thread pool implementation that keeps a separate task queue for every worker thread.
+// Every queue is protected by its own mutex, so that worker threads do not contend for
+// a single lock. A worker that runs out of tasks steals them from other queues.
+class WorkStealingThreadPoolImpl final : public ObjectBase<IThreadPool>
+{
+public:
+    using TBase = ObjectBase<IThreadPool>;
+
+    WorkStealingThreadPoolImpl(IReferenceCounters*         pRefCounters,
+                               const ThreadPoolCreateInfo& PoolCI) :
+        TBase{pRefCounters},
+        m_Queues(PoolCI.NumThreads > 0 ? PoolCI.NumThreads : std::max(std::thread::hardware_concurrency(), 1u))
+    {
+        const Uint64 CoresMask = PoolCI.NumThreads > 0 ? GetThreadPoolCoresMask(PoolCI.CorePlacement) : 0;
+
+        m_WorkerThreads.reserve(PoolCI.NumThreads);
+        for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
+        {
+            m_WorkerThreads.emplace_back(
+                [this, PoolCI, CoresMask, i] //
+                {
+                    InitWorkerThread(PoolCI, CoresMask);
+
+                    if (PoolCI.OnThreadStarted)
+                        PoolCI.OnThreadStarted(i);
+
+                    while (ProcessTask(i, /*WaitForTask =*/true))
+                    {
+                    }
+
+                    if (PoolCI.OnThreadExiting)
+                        PoolCI.OnThreadExiting(i);
+                });
+        }
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ThreadPool, TBase)
+
+    virtual bool DILIGENT_CALL_TYPE ProcessTask(Uint32 ThreadId, bool WaitForTask) override final
+    {
+        const size_t QueueIdx = ThreadId % m_Queues.size();
+
+        QueuedTaskInfo TaskInfo;
+        while (!PopTask(QueueIdx, TaskInfo))
+        {
+            // m_Stop must be accessed under the mutex
+            std::unique_lock<std::mutex> lock{m_IdleMtx};
+            if (m_Stop.load() && m_NumQueuedTasks.load() == 0)
+                return false;
+
+            if (!WaitForTask)
+                return true;
+
+            // NB: the idle thread counter must be incremented before checking the
+            //     number of queued tasks, see EnqueueTaskInfo().
+            m_NumIdleThreads.fetch_add(1);
+            m_TaskAvailableCond.wait(lock,
+                                     [this] //
+                                     {
+                                         return m_Stop.load() || m_NumQueuedTasks.load() > 0;
+                                     } //
+            );
+            m_NumIdleThreads.fetch_add(-1);
+        }
+
+        bool TaskFinished = false;
+        {
+            // Make the tasks enqueued by this task go to the same queue
+            CurrentQueueScope CurrQueue{this, QueueIdx};
+
+            TaskFinished = RunQueuedTask(TaskInfo, ThreadId);
+        }
+
+        if (TaskFinished)
+        {
+            TaskInfo.pTask.Release();
+        }
+        else
+        {
+            // NB: the task must be re-enqueued before the running task
+            //     counter is decremented, otherwise WaitForAllTasks() may miss it.
+            EnqueueTaskInfo(QueueIdx, std::move(TaskInfo));
+        }
+
+        m_NumRunningTasks.fetch_add(-1);
+        NotifyIfAllTasksFinished();
+
+        return true;
+    }
+
+    virtual void DILIGENT_CALL_TYPE EnqueueTask(IAsyncTask*  pTask,
+                                                IAsyncTask** ppPrerequisites,
+                                                Uint32       NumPrerequisites) override final
+    {
+        VERIFY_EXPR(pTask != nullptr);
+        if (pTask == nullptr)
+            return;
+
+        DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+
+        size_t QueueIdx = 0;
+        if (tl_CurrentPool == this)
+        {
+            // The task is enqueued from a task running in this pool
+            QueueIdx = tl_CurrentQueueIdx;
+        }
+        else
+        {
+            QueueIdx = m_NextQueueIdx.fetch_add(1) % m_Queues.size();
+        }
+
+        EnqueueTaskInfo(QueueIdx, MakeQueuedTaskInfo(pTask, ppPrerequisites, NumPrerequisites));
+    }
+
+    virtual void DILIGENT_CALL_TYPE WaitForAllTasks() override final
+    {
+        std::unique_lock<std::mutex> lock{m_TasksFinishedMtx};
+        m_TasksFinishedCond.wait(lock,
+                                 [this] //
+                                 {
+                                     return m_NumQueuedTasks.load() == 0 && m_NumRunningTasks.load() == 0;
+                                 } //
+        );
+    }
+
+    virtual void DILIGENT_CALL_TYPE StopThreads() override final
+    {
+        {
+            std::unique_lock<std::mutex> lock{m_IdleMtx};
+            // NB: even if the shared variable is atomic, it must be modified under the mutex
+            //     in order to correctly publish the modification to the waiting thread.
+            m_Stop.store(true);
+        }
+        m_TaskAvailableCond.notify_all();
+        for (std::thread& worker : m_WorkerThreads)
+            worker.join();
+
+        m_WorkerThreads.clear();
+    }
+
+    virtual bool DILIGENT_CALL_TYPE RemoveTask(IAsyncTask* pTask) override final
+    {
+        for (TaskQueue& Queue : m_Queues)
+        {
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+            if (Queue.Remove(pTask, nullptr))
+            {
+                lock.unlock();
+                m_NumQueuedTasks.fetch_add(-1);
+                NotifyIfAllTasksFinished();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    virtual bool DILIGENT_CALL_TYPE ReprioritizeTask(IAsyncTask* pTask) override final
+    {
+        for (TaskQueue& Queue : m_Queues)
+        {
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+
+            QueuedTaskInfo TaskInfo;
+            if (Queue.Remove(pTask, &TaskInfo))
+            {
+                Queue.Push(std::move(TaskInfo));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    virtual void DILIGENT_CALL_TYPE ReprioritizeAllTasks() override final
+    {
+        for (TaskQueue& Queue : m_Queues)
+        {
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+            Queue.Reprioritize();
+        }
+    }
+
+    Uint32 DILIGENT_CALL_TYPE GetQueueSize() override final
+    {
+        return static_cast<Uint32>(std::max(m_NumQueuedTasks.load(), 0));
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetRunningTaskCount() const override final
+    {
+        return m_NumRunningTasks.load();
+    }
+
+    ~WorkStealingThreadPoolImpl()
+    {
+        StopThreads();
+        VERIFY_EXPR(m_NumQueuedTasks.load() == 0);
+        VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+    }
+
+private:
+    void EnqueueTaskInfo(size_t QueueIdx, QueuedTaskInfo&& TaskInfo)
+    {
+        {
+            TaskQueue&                   Queue = m_Queues[QueueIdx];
+            std::unique_lock<std::mutex> lock{Queue.Mtx};
+            Queue.Push(std::move(TaskInfo));
+        }
+        // NB: the counter must be incremented after the task has been added to the queue,
+        //     so that a thread that observes a non-zero value is able to find the task.
+        m_NumQueuedTasks.fetch_add(1);
+
+        // If the idle thread sees zero queued tasks, it must have incremented the idle thread
+        // counter before we incremented the queued task counter, and we will see it here.
+        if (m_NumIdleThreads.load() > 0)
+        {
+            {
+                std::unique_lock<std::mutex> lock{m_IdleMtx};
+            }
+            m_TaskAvailableCond.notify_one();
+        }
+    }
+
+    void NotifyIfAllTasksFinished()
+    {
+        if (m_NumRunningTasks.load() == 0 && m_NumQueuedTasks.load() == 0)
+        {
+            {
+                // Lock the mutex to make sure that WaitForAllTasks() is either waiting on
+                // the condition variable or has not checked the predicate yet.
+                std::unique_lock<std::mutex> lock{m_TasksFinishedMtx};
+            }
+            m_TasksFinishedCond.notify_all();
+        }
+    }
+
+    bool PopTask(size_t QueueIdx, QueuedTaskInfo& TaskInfo)
+    {
+        // Try the own queue first
+        if (m_Queues[QueueIdx].Pop(TaskInfo, /*FromFront = */ true, m_NumRunningTasks))
+        {
+            m_NumQueuedTasks.fetch_add(-1);
+            return true;
+        }
+
+        // Steal from other queues
+        for (size_t i = 1; i < m_Queues.size(); ++i)
+        {
+            TaskQueue& Victim = m_Queues[(QueueIdx + i) % m_Queues.size()];
+            if (Victim.Pop(TaskInfo, /*FromFront = */ false, m_NumRunningTasks))
+            {
+                m_NumQueuedTasks.fetch_add(-1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    struct PriorityBucket
+    {
+        float                      Priority = 0;
+        std::deque<QueuedTaskInfo> Tasks;
+    };
+
+    struct TaskQueue
+    {
+        std::mutex Mtx;
+
+        // Non-empty buckets sorted by priority in descending order.
+        // The number of distinct priorities is typically small, so a linear
+        // search is faster than a map lookup.
+        std::vector<PriorityBucket> Buckets;
+
+        void Push(QueuedTaskInfo&& TaskInfo)
+        {
+            const float Priority = TaskInfo.pTask->GetPriority();
+
+            auto it = std::find_if(Buckets.begin(), Buckets.end(),
+                                   [Priority](const PriorityBucket& Bucket) {
+                                       return Bucket.Priority <= Priority;
+                                   });
+            if (it == Buckets.end() || it->Priority != Priority)
+            {
+                it           = Buckets.emplace(it);
+                it->Priority = Priority;
+            }
+            it->Tasks.emplace_back(std::move(TaskInfo));
+        }
+
+        bool Pop(QueuedTaskInfo& TaskInfo, bool FromFront, std::atomic<int>& NumRunningTasks)
+        {
+            std::unique_lock<std::mutex> lock{Mtx};
+            if (Buckets.empty())
+                return false;
+
+            // Always take the task from the highest-priority bucket.
+            // The owner thread takes tasks in FIFO order to preserve the enqueue order,
+            // while thieves take the most recently added tasks.
+            auto& Tasks = Buckets.front().Tasks;
+            VERIFY_EXPR(!Tasks.empty());
+            if (FromFront)
+            {
+                TaskInfo = std::move(Tasks.front());
+                Tasks.pop_front();
+            }
+            else
+            {
+                TaskInfo = std::move(Tasks.back());
+                Tasks.pop_back();
+            }
+            if (Tasks.empty())
+                Buckets.erase(Buckets.begin());
+
+            // NB: we must increment the running task counter while holding the lock and
+            //     before the queued task counter is decremented, otherwise WaitForAllTasks()
+            //     may miss the task.
+            NumRunningTasks.fetch_add(1);
+
+            return true;
+        }
+
+        bool Remove(IAsyncTask* pTask, QueuedTaskInfo* pTaskInfo)
+        {
+            for (auto bucket_it = Buckets.begin(); bucket_it != Buckets.end(); ++bucket_it)
+            {
+                auto& Tasks   = bucket_it->Tasks;
+                auto  task_it = std::find_if(Tasks.begin(), Tasks.end(),
+                                             [pTask](const QueuedTaskInfo& TaskInfo) {
+                                                 return TaskInfo.pTask == pTask;
+                                             });
+                if (task_it != Tasks.end())
+                {
+                    if (pTaskInfo != nullptr)
+                        *pTaskInfo = std::move(*task_it);
+                    Tasks.erase(task_it);
+                    if (Tasks.empty())
+                        Buckets.erase(bucket_it);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Reprioritize()
+        {
+            std::vector<QueuedTaskInfo> ReprioritizationList;
+            for (auto bucket_it = Buckets.begin(); bucket_it != Buckets.end();)
+            {
+                auto& Tasks = bucket_it->Tasks;
+                for (auto task_it = Tasks.begin(); task_it != Tasks.end();)
+                {
+                    if (task_it->pTask->GetPriority() != bucket_it->Priority)
+                    {
+                        ReprioritizationList.emplace_back(std::move(*task_it));
+                        task_it = Tasks.erase(task_it);
+                    }
+                    else
+                    {
+                        ++task_it;
+                    }
+                }
+
+                if (Tasks.empty())
+                    bucket_it = Buckets.erase(bucket_it);
+                else
+                    ++bucket_it;
+            }
+
+            for (QueuedTaskInfo& TaskInfo : ReprioritizationList)
+                Push(std::move(TaskInfo));
+        }
+    };
+
+    // Sets the queue that the tasks enqueued by the current thread are added to.
+    class CurrentQueueScope
+    {
+    public:
+        CurrentQueueScope(const WorkStealingThreadPoolImpl* pPool, size_t QueueIdx) :
+            m_pPrevPool{tl_CurrentPool},
+            m_PrevQueueIdx{tl_CurrentQueueIdx}
+        {
+            tl_CurrentPool     = pPool;
+            tl_CurrentQueueIdx = QueueIdx;
+        }
+
+        ~CurrentQueueScope()
+        {
+            tl_CurrentPool     = m_pPrevPool;
+            tl_CurrentQueueIdx = m_PrevQueueIdx;
+        }
+
+    private:
+        const WorkStealingThreadPoolImpl* const m_pPrevPool;
+        const size_t                            m_PrevQueueIdx;
+    };
+
+    static thread_local const WorkStealingThreadPoolImpl* tl_CurrentPool;
+    static thread_local size_t                            tl_CurrentQueueIdx;
+
+private:
+    std::vector<TaskQueue> m_Queues;
+
+    std::vector<std::thread> m_WorkerThreads;
+
+    std::atomic<size_t> m_NextQueueIdx{0};
+    std::atomic<int>    m_NumQueuedTasks{0};
+    std::atomic<int>    m_NumRunningTasks{0};
+    std::atomic<int>    m_NumIdleThreads{0};
+
+    std::mutex              m_IdleMtx;
+    std::condition_variable m_TaskAvailableCond{};
+    std::atomic<bool>       m_Stop{false};
+
+    std::mutex              m_TasksFinishedMtx;
+    std::condition_variable m_TasksFinishedCond{};
+};
+
+thread_local const WorkStealingThreadPoolImpl* WorkStealingThreadPoolImpl::tl_CurrentPool     = nullptr;
+thread_local size_t                            WorkStealingThreadPoolImpl::tl_CurrentQueueIdx = 0;
+
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI)
 {
-    return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
+    if (ThreadPoolCI.EnableWorkStealing)
+        return RefCntAutoPtr<WorkStealingThreadPoolImpl>{MakeNewRCObj<WorkStealingThreadPoolImpl>()(ThreadPoolCI)};
+    else
+        return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
+}
+
+Uint64 GetThreadPoolCoresMask(ThreadPoolCorePlacement CorePlacement)
+{
+    if (CorePlacement == ThreadPoolCorePlacement::Any)
+        return 0;
+
+    const CPUTopologyInfo Topology = PlatformMisc::GetCPUTopology();
+
+    Uint64 CoresMask = 0;
+    switch (CorePlacement)
+    {
+        case ThreadPoolCorePlacement::Any:
+            break;
+
+        case ThreadPoolCorePlacement::PerformanceCores:
+            CoresMask = Topology.IsHybrid() ? Topology.PerformanceCoresMask : 0;
+            break;
+
+        case ThreadPoolCorePlacement::EfficiencyCores:
+            CoresMask = Topology.IsHybrid() ? Topology.EfficiencyCoresMask : 0;
+            break;
+
+        case ThreadPoolCorePlacement::PhysicalCores:
+            CoresMask = Topology.NumPhysicalCores < Topology.NumLogicalCores ? Topology.PrimaryThreadsMask : 0;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected core placement");
+    }
+
+    return CoresMask;
 }
 
 Uint64 PinWorkerThread(Uint32 ThreadId, Uint64 AllowedCoresMask)
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TrackingMemoryAllocator.hpp"
+
+namespace Diligent
+{
+
+#if DILIGENT_ALLOCATION_TRACKING_ENABLED
+namespace
+{
+thread_local AllocationCounters tl_Counters;
+} // namespace
+#endif
+
+AllocationCounters TrackingMemoryAllocator::GetThreadCounters()
+{
+#if DILIGENT_ALLOCATION_TRACKING_ENABLED
+    return tl_Counters;
+#else
+    return {};
+#endif
+}
+
+void TrackingMemoryAllocator::RecordAllocation(size_t Size)
+{
+#if DILIGENT_ALLOCATION_TRACKING_ENABLED
+    ++tl_Counters.NumAllocations;
+    tl_Counters.AllocatedBytes += Size;
+#endif
+}
+
+void TrackingMemoryAllocator::RecordFree()
+{
+#if DILIGENT_ALLOCATION_TRACKING_ENABLED
+    ++tl_Counters.NumFrees;
+#endif
+}
+
+void* TrackingMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    RecordAllocation(Size);
+    return m_Allocator.Allocate(Size, dbgDescription, dbgFileName, dbgLineNumber);
+}
+
+void TrackingMemoryAllocator::Free(void* Ptr)
+{
+    if (Ptr != nullptr)
+        RecordFree();
+    m_Allocator.Free(Ptr);
+}
+
+void* TrackingMemoryAllocator::AllocateAligned(size_t Size, size_t Alignment, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    RecordAllocation(Size);
+    return m_Allocator.AllocateAligned(Size, Alignment, dbgDescription, dbgFileName, dbgLineNumber);
+}
+
+void TrackingMemoryAllocator::FreeAligned(void* Ptr)
+{
+    if (Ptr != nullptr)
+        RecordFree();
+    m_Allocator.FreeAligned(Ptr);
+}
+
+} // namespace Diligent
@@ -37,6 +37,8 @@
 #include "ObjectBase.hpp"
 #include "DXCompiler.hpp"
 #include "RenderDeviceBase.hpp"
+#include "ShaderBase.hpp"
+#include "ObjectsRegistry.hpp"
 
 namespace Diligent
 {
@@ -116,6 +118,11 @@ public:
     /// Implementation of ISerializationDevice::AddRenderDevice().
     virtual void DILIGENT_CALL_TYPE AddRenderDevice(IRenderDevice* pDevice) override final;
 
+    /// Implementation of ISerializationDevice::CompileShaderJob().
+    virtual void DILIGENT_CALL_TYPE CompileShaderJob(const void* pJobData,
+                                                     Uint64      DataSize,
+                                                     IDataBlob** ppByteCode) override final;
+
     void CreateSerializedResourceSignature(const PipelineResourceSignatureDesc& Desc,
                                            const ResourceSignatureArchiveInfo&  ArchiveInfo,
                                            SHADER_TYPE                          ShaderStages,
@@ -172,6 +179,14 @@ public:
     const VkProperties&    GetVkProperties() const { return m_VkProps; }
     const MtlProperties&   GetMtlProperties() const { return m_MtlProps; }
 
+    bool GetCompressShaders() const { return m_CompressShaders; }
+
+    IShaderCompileExecutor* GetCompileExecutor() const { return m_pCompileExecutor; }
+
+    // Sends the shader to the compile executor and returns the compiled byte code,
+    // or null if the shader should be compiled locally.
+    RefCntAutoPtr<IDataBlob> CompileWithExecutor(const ShaderCreateInfo& ShaderCI, ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag) const;
+
     IRenderDevice* GetRenderDevice(RENDER_DEVICE_TYPE Type) const
     {
         return m_RenderDevices[Type];
@@ -211,9 +226,34 @@ private:
     VkProperties    m_VkProps;
     MtlProperties   m_MtlProps;
 
+    const bool m_CompressShaders;
+
+    RefCntAutoPtr<IShaderCompileExecutor> m_pCompileExecutor;
+
     std::vector<PipelineResourceBinding> m_ResourceBindings;
 
     std::array<RefCntAutoPtr<IRenderDevice>, RENDER_DEVICE_TYPE_COUNT> m_RenderDevices;
+
+    // Identical shaders requested by different pipelines are compiled only once
+    struct ShaderRegistryKey
+    {
+        ShaderRegistryKey(const ShaderCreateInfo& ShaderCI, ARCHIVE_DEVICE_DATA_FLAGS _DeviceFlags) noexcept(false);
+
+        bool operator==(const ShaderRegistryKey& RHS) const noexcept;
+
+        struct Hasher
+        {
+            size_t operator()(const ShaderRegistryKey& Key) const noexcept
+            {
+                return Key.Hash;
+            }
+        };
+
+        std::shared_ptr<const ShaderCreateInfoWrapper> pCreateInfo;
+        ARCHIVE_DEVICE_DATA_FLAGS                      DeviceFlags = ARCHIVE_DEVICE_DATA_FLAG_NONE;
+        size_t                                         Hash        = 0;
+    };
+    ObjectsRegistry<ShaderRegistryKey, RefCntAutoPtr<IShader>, ShaderRegistryKey::Hasher> m_ShaderRegistry;
 };
 
 } // namespace Diligent
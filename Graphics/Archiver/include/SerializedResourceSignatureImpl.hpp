@@ -30,6 +30,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <functional>
 
 #include "PipelineResourceSignature.h"
 #include "ObjectBase.hpp"
@@ -69,6 +70,7 @@ public:
 
     // clang-format off
     UNSUPPORTED_METHOD      (void, CreateShaderResourceBinding, IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources)
+    UNSUPPORTED_METHOD      (void, CreateShaderResourceBindings, Uint32 NumSRBs, IShaderResourceBinding** ppShaderResourceBindings, bool InitStaticResources)
     UNSUPPORTED_METHOD      (void, BindStaticResources,         SHADER_TYPE ShaderStages, IResourceMapping* pResourceMapping, BIND_SHADER_RESOURCES_FLAGS Flags)
     UNSUPPORTED_METHOD      (IShaderResourceVariable*, GetStaticVariableByName, SHADER_TYPE ShaderType, const Char* Name)
     UNSUPPORTED_METHOD      (IShaderResourceVariable*, GetStaticVariableByIndex, SHADER_TYPE ShaderType, Uint32 Index)
@@ -125,7 +127,9 @@ private:
         return Wrpr ? Wrpr->GetPRS() : nullptr;
     }
 
-    void InitCommonData(const PipelineResourceSignatureDesc& Desc);
+    // GetInlineConstantCount returns the number of inline constants for the resource with the given index
+    // in the device signature description.
+    void InitCommonData(const PipelineResourceSignatureDesc& Desc, const std::function<Uint32(Uint32)>& GetInlineConstantCount);
 
 private:
     const std::string m_Name;
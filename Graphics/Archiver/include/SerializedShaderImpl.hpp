@@ -52,7 +52,8 @@ public:
                          SerializationDeviceImpl* pDevice,
                          const ShaderCreateInfo&  ShaderCI,
                          const ShaderArchiveInfo& ArchiveInfo,
-                         IDataBlob**              ppCompilerOutput);
+                         IDataBlob**              ppCompilerOutput,
+                         bool                     UseCompileExecutor = true);
     ~SerializedShaderImpl();
 
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
@@ -120,6 +121,12 @@ private:
 
     std::array<std::unique_ptr<CompiledShader>, static_cast<size_t>(DeviceType::Count)> m_Shaders;
 
+    void CreateDeviceShader(ARCHIVE_DEVICE_DATA_FLAGS Flag,
+                            IReferenceCounters*       pRefCounters,
+                            const ShaderCreateInfo&   ShaderCI,
+                            IDataBlob**               ppCompilerOutput,
+                            const ShaderCreateInfo*   pPreprocessedCI = nullptr) noexcept(false);
+
     template <typename ShaderType, typename... ArgTypes>
     void CreateShader(DeviceType              Type,
                       IReferenceCounters*     pRefCounters,
@@ -32,6 +32,7 @@
 #include "../../../Primitives/interface/Object.h"
 #include "../../../Primitives/interface/DebugOutput.h"
 #include "SerializationDevice.h"
+#include "ShaderCompileExecutor.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
@@ -239,6 +240,24 @@ struct SerializationDeviceCreateInfo
     ///             thread pool is used instead.
     Uint32 NumAsyncShaderCompilationThreads DEFAULT_INITIALIZER(0);
 
+    /// Whether to compress the shader bytecode in the archives.
+    ///
+    /// \remarks    When this flag is set to True, the shaders of every device type are compressed
+    ///             with LZ4 using a dictionary built from the shaders of this device type. SPIR-V
+    ///             and other bytecode formats that share a lot of common sequences typically compress
+    ///             several times. Shaders are decompressed on demand when they are unpacked by the
+    ///             dearchiver, so the shaders that are never used are never decompressed.
+    Bool CompressShaders DEFAULT_INITIALIZER(False);
+
+    /// An optional shader compile executor, see Diligent::IShaderCompileExecutor.
+    ///
+    /// \remarks    When the executor is provided, the serialization device first asks it to
+    ///             compile Direct3D11, Direct3D12 and Vulkan shaders, and only compiles the shader
+    ///             locally if the executor did not return the byte code. This can be used to
+    ///             distribute compilation to remote workers or to share compiled shaders between
+    ///             machines. Shaders for other backends are always processed locally.
+    IShaderCompileExecutor* pCompileExecutor DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     SerializationDeviceCreateInfo() noexcept
     {
@@ -322,6 +341,27 @@ DILIGENT_BEGIN_INTERFACE(IArchiverFactory, IObject)
                                        IDataBlob**      ppDstArchive) CONST PURE;
 
 
+    /// Creates a delta archive that only contains the resources that have changed.
+
+    /// \param [in]  pBaseArchive  - The base archive, e.g. the archive that has been shipped.
+    /// \param [in]  pNewArchive   - The new archive that contains all resources.
+    /// \param [out] ppDstArchive  - Memory address where a pointer to the delta archive will be written.
+    /// \return     true if the delta archive was successfully created, and false otherwise.
+    ///
+    /// \remarks    The delta archive contains the resources of the new archive that are not present
+    ///             in the base archive or differ from the resources with the same names, together with
+    ///             the shaders they use. Resources are compared by content, so the archives may be produced
+    ///             by different archiver runs. Shaders are deduplicated by content.
+    ///
+    ///             To apply the delta, load the base archive followed by the delta archive into a dearchiver
+    ///             created with DearchiverCreateInfo::AllowOverrides set to True. Resources that are removed from
+    ///             the new archive remain available in the base archive.
+    VIRTUAL Bool METHOD(CreateDeltaArchive)(THIS_
+                                            const IDataBlob* pBaseArchive,
+                                            const IDataBlob* pNewArchive,
+                                            IDataBlob**      ppDstArchive) CONST PURE;
+
+
     /// Prints archive content for debugging and validation.
     VIRTUAL Bool METHOD(PrintArchiveContent)(THIS_
                                              const IDataBlob* pArchive) CONST PURE;
@@ -350,6 +390,7 @@ DILIGENT_END_INTERFACE
 #    define IArchiverFactory_RemoveDeviceData(This, ...)                        CALL_IFACE_METHOD(ArchiverFactory, RemoveDeviceData,                       This, __VA_ARGS__)
 #    define IArchiverFactory_AppendDeviceData(This, ...)                        CALL_IFACE_METHOD(ArchiverFactory, AppendDeviceData,                       This, __VA_ARGS__)
 #    define IArchiverFactory_MergeArchives(This, ...)                           CALL_IFACE_METHOD(ArchiverFactory, MergeArchives,                          This, __VA_ARGS__)
+#    define IArchiverFactory_CreateDeltaArchive(This, ...)                      CALL_IFACE_METHOD(ArchiverFactory, CreateDeltaArchive,                     This, __VA_ARGS__)
 #    define IArchiverFactory_PrintArchiveContent(This, ...)                     CALL_IFACE_METHOD(ArchiverFactory, PrintArchiveContent,                    This, __VA_ARGS__)
 #    define IArchiverFactory_SetMessageCallback(This, ...)                      CALL_IFACE_METHOD(ArchiverFactory, SetMessageCallback,                     This, __VA_ARGS__)
 #    define IEngineFactory_SetBreakOnError(This, ...)                           CALL_IFACE_METHOD(EngineFactory,   SetBreakOnError,                        This, __VA_ARGS__)
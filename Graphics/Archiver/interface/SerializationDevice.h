@@ -152,6 +152,15 @@ DILIGENT_BEGIN_INTERFACE(ISerializationDevice, IRenderDevice)
     ///                                 If null, the output will be ignored.
     /// \note
     ///     The method is thread-safe and may be called from multiple threads simultaneously.
+    ///
+    /// \remarks
+    ///     If a shader with the same create info and archive info is alive, the method
+    ///     returns that shader instead of compiling a new one, unless ppCompilerOutput is not null.
+    ///     Note that shaders loaded from files are identified by the file path, so
+    ///     the application must release the shaders to recompile modified files.
+    ///
+    ///     If the serialization device has a shader compilation thread pool, the shader
+    ///     variants for different backends are compiled in parallel.
     VIRTUAL void METHOD(CreateShader)(THIS_
                                       const ShaderCreateInfo REF  ShaderCI,
                                       const ShaderArchiveInfo REF ArchiveInfo,
@@ -259,6 +268,21 @@ DILIGENT_BEGIN_INTERFACE(ISerializationDevice, IRenderDevice)
     VIRTUAL void METHOD(AddRenderDevice)(THIS_
                                          IRenderDevice* pDevice) PURE;
 
+    /// Compiles a serialized shader compile job.
+
+    /// \param [in]  pJobData   - Serialized job data, see Diligent::ShaderCompileJob::pData.
+    /// \param [in]  DataSize   - The size of the job data, in bytes.
+    /// \param [out] ppByteCode - Memory address where a pointer to the data blob
+    ///                          containing the compiled byte code will be written.
+    ///
+    /// \remarks    This method is intended to be called by the remote compilation workers.
+    ///             The device attributes of the worker device that affect compilation must
+    ///             match those of the device that created the job.
+    VIRTUAL void METHOD(CompileShaderJob)(THIS_
+                                          const void* pJobData,
+                                          Uint64      DataSize,
+                                          IDataBlob** ppByteCode) PURE;
+
 #if DILIGENT_CPP_INTERFACE
     /// Overloaded alias for CreateGraphicsPipelineState.
     void CreatePipelineState(const GraphicsPipelineStateCreateInfo& CI, const PipelineStateArchiveInfo& ArchiveInfo, IPipelineState** ppPipelineState)
@@ -295,6 +319,9 @@ DILIGENT_END_INTERFACE
 #    define ISerializationDevice_CreateRayTracingPipelineState(This, ...)   CALL_IFACE_METHOD(SerializationDevice, CreateRayTracingPipelineState,   This, __VA_ARGS__)
 #    define ISerializationDevice_CreateTilePipelineState(This, ...)         CALL_IFACE_METHOD(SerializationDevice, CreateTilePipelineState,         This, __VA_ARGS__)
 #    define ISerializationDevice_GetPipelineResourceBindings(This, ...)     CALL_IFACE_METHOD(SerializationDevice, GetPipelineResourceBindings,     This, __VA_ARGS__)
+#    define ISerializationDevice_GetSupportedDeviceFlags(This)              CALL_IFACE_METHOD(SerializationDevice, GetSupportedDeviceFlags,         This)
+#    define ISerializationDevice_AddRenderDevice(This, ...)                 CALL_IFACE_METHOD(SerializationDevice, AddRenderDevice,                 This, __VA_ARGS__)
+#    define ISerializationDevice_CompileShaderJob(This, ...)                CALL_IFACE_METHOD(SerializationDevice, CompileShaderJob,                This, __VA_ARGS__)
 
 #endif
 
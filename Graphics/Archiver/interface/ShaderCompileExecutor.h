@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::IShaderCompileExecutor interface
+
+#include "../../../Primitives/interface/Object.h"
+#include "../../../Primitives/interface/DataBlob.h"
+#include "../../GraphicsEngine/interface/Shader.h"
+#include "Archiver.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {E2993A65-FFAC-4E95-9EDF-B0B12ECEA96D}
+static DILIGENT_CONSTEXPR INTERFACE_ID IID_ShaderCompileExecutor =
+    {0xe2993a65, 0xffac, 0x4e95, {0x9e, 0xdf, 0xb0, 0xb1, 0x2e, 0xce, 0xa9, 0x6d}};
+
+
+#define DILIGENT_INTERFACE_NAME IShaderCompileExecutor
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IShaderCompileExecutorInclusiveMethods \
+    IObjectInclusiveMethods;                   \
+    IShaderCompileExecutorMethods ShaderCompileExecutor
+
+// clang-format off
+
+/// Shader compile job
+struct ShaderCompileJob
+{
+    /// Shader create info. All includes are already inlined into the
+    /// source, so the shader can be compiled without the source stream factory.
+    const ShaderCreateInfo* pShaderCI DEFAULT_INITIALIZER(nullptr);
+
+    /// Target device, must be one of ARCHIVE_DEVICE_DATA_FLAG_D3D11,
+    /// ARCHIVE_DEVICE_DATA_FLAG_D3D12 or ARCHIVE_DEVICE_DATA_FLAG_VULKAN.
+    ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag DEFAULT_INITIALIZER(ARCHIVE_DEVICE_DATA_FLAG_NONE);
+
+    /// Self-contained serialized representation of the job that includes
+    /// the shader create info, the target device and the device attributes
+    /// that affect compilation.
+    ///
+    /// \remarks    This data can be sent to a remote worker that compiles it with
+    ///             ISerializationDevice::CompileShaderJob(). Identical jobs produce
+    ///             identical data, so its hash can be used as a cache key.
+    const void* pData    DEFAULT_INITIALIZER(nullptr);
+
+    /// The size of the serialized job data, in bytes.
+    Uint64      DataSize DEFAULT_INITIALIZER(0);
+};
+typedef struct ShaderCompileJob ShaderCompileJob;
+
+
+/// Shader compile executor interface
+
+/// The executor allows the serialization device to offload shader compilation,
+/// for instance to a farm of remote workers or a shared compilation cache.
+DILIGENT_BEGIN_INTERFACE(IShaderCompileExecutor, IObject)
+{
+    /// Compiles the shader.
+
+    /// \param [in]  Job        - Shader compile job, see Diligent::ShaderCompileJob.
+    /// \param [out] ppByteCode - Memory address where a pointer to the data blob
+    ///                           containing the compiled byte code will be written.
+    ///
+    /// \remarks    If the executor is not able to compile the shader, it should
+    ///             leave *ppByteCode null. In this case the shader will be compiled
+    ///             locally by the serialization device.
+    ///
+    ///             The method may be called simultaneously from multiple threads.
+    VIRTUAL void METHOD(Compile)(THIS_
+                                 const ShaderCompileJob REF Job,
+                                 IDataBlob**                ppByteCode) PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+#    define IShaderCompileExecutor_Compile(This, ...) CALL_IFACE_METHOD(ShaderCompileExecutor, Compile, This, __VA_ARGS__)
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
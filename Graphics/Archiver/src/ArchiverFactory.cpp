@@ -137,6 +137,11 @@ public:
         Uint32           NumSrcArchives,
         IDataBlob**      ppDstArchive) const override final;
 
+    virtual Bool DILIGENT_CALL_TYPE CreateDeltaArchive(
+        const IDataBlob* pBaseArchive,
+        const IDataBlob* pNewArchive,
+        IDataBlob**      ppDstArchive) const override final;
+
     virtual Bool DILIGENT_CALL_TYPE PrintArchiveContent(const IDataBlob* pArchive) const override final;
 
     virtual void DILIGENT_CALL_TYPE SetMessageCallback(DebugMessageCallbackType MessageCallback) const override final;
@@ -324,6 +329,35 @@ Bool ArchiverFactoryImpl::MergeArchives(
     }
 }
 
+Bool ArchiverFactoryImpl::CreateDeltaArchive(
+    const IDataBlob* pBaseArchive,
+    const IDataBlob* pNewArchive,
+    IDataBlob**      ppDstArchive) const
+{
+    DEV_CHECK_ERR(pBaseArchive != nullptr, "pBaseArchive must not be null");
+    DEV_CHECK_ERR(pNewArchive != nullptr, "pNewArchive must not be null");
+    DEV_CHECK_ERR(ppDstArchive != nullptr, "ppDstArchive must not be null");
+
+    if (pBaseArchive == nullptr || pNewArchive == nullptr || ppDstArchive == nullptr)
+        return false;
+
+    try
+    {
+        const DeviceObjectArchive BaseArchive{DeviceObjectArchive::CreateInfo{pBaseArchive}};
+        const DeviceObjectArchive NewArchive{DeviceObjectArchive::CreateInfo{pNewArchive}};
+
+        DeviceObjectArchive DeltaArchive;
+        DeltaArchive.CreateDelta(BaseArchive, NewArchive);
+
+        DeltaArchive.Serialize(ppDstArchive);
+        return *ppDstArchive != nullptr;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
 Bool ArchiverFactoryImpl::PrintArchiveContent(const IDataBlob* pArchive) const
 {
     try
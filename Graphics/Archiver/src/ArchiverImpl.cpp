@@ -76,6 +76,7 @@ Bool ArchiverImpl::SerializeToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
         return false;
 
     DeviceObjectArchive Archive{ContentVersion};
+    Archive.SetCompressShaders(m_pSerializationDevice->GetCompressShaders());
 
     // A hash map that maps shader byte code to the index in the archive, for each device type
     std::array<std::unordered_map<size_t, Uint32>, static_cast<size_t>(DeviceType::Count)> BytecodeHashToIdx;
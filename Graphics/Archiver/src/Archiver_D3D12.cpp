@@ -40,6 +40,47 @@ namespace Diligent
 namespace
 {
 
+// Packs the bytecode and the shader resources into the data that is stored in ShaderCreateInfo::ByteCode,
+// see ShaderD3D12Serializer. The resources are null if the shader is compiled without the reflection.
+SerializedData SerializeBytecodeD3D12(const IDataBlob* pBytecode, const ShaderResourcesD3D12* pResources)
+{
+    SerializedData Resources;
+    if (pResources != nullptr)
+    {
+        {
+            Serializer<SerializerMode::Measure> Ser;
+            pResources->Serialize(Ser);
+            Resources = Ser.AllocateData(GetRawAllocator());
+        }
+
+        {
+            Serializer<SerializerMode::Write> Ser{Resources};
+            pResources->Serialize(Ser);
+            VERIFY_EXPR(Ser.IsEnded());
+        }
+    }
+
+    const void*  pBytecodeData = pBytecode->GetConstDataPtr();
+    const size_t BytecodeSize  = pBytecode->GetSize();
+    const void*  pResourceData = Resources.Ptr();
+    const size_t ResourceSize  = Resources.Size();
+
+    SerializedData ShaderData;
+    {
+        Serializer<SerializerMode::Measure> Ser;
+        ShaderD3D12Serializer<SerializerMode::Measure>::SerializeBytecode(Ser, pBytecodeData, BytecodeSize, pResourceData, ResourceSize);
+        ShaderData = Ser.AllocateData(GetRawAllocator());
+    }
+
+    {
+        Serializer<SerializerMode::Write> Ser{ShaderData};
+        ShaderD3D12Serializer<SerializerMode::Write>::SerializeBytecode(Ser, pBytecodeData, BytecodeSize, pResourceData, ResourceSize);
+        VERIFY_EXPR(Ser.IsEnded());
+    }
+
+    return ShaderData;
+}
+
 struct CompiledShaderD3D12 final : SerializedShaderImpl::CompiledShader
 {
     ShaderD3D12Impl ShaderD3D12;
@@ -53,13 +94,13 @@ struct CompiledShaderD3D12 final : SerializedShaderImpl::CompiledShader
 
     virtual SerializedData Serialize(ShaderCreateInfo ShaderCI) const override final
     {
-        const IDataBlob* pBytecode = ShaderD3D12.GetD3DBytecode();
+        const SerializedData ShaderData = SerializeBytecodeD3D12(ShaderD3D12.GetD3DBytecode(), ShaderD3D12.GetShaderResources().get());
 
         ShaderCI.Source       = nullptr;
         ShaderCI.FilePath     = nullptr;
         ShaderCI.Macros       = {};
-        ShaderCI.ByteCode     = pBytecode->GetConstDataPtr();
-        ShaderCI.ByteCodeSize = pBytecode->GetSize();
+        ShaderCI.ByteCode     = ShaderData.Ptr();
+        ShaderCI.ByteCodeSize = ShaderData.Size();
         return SerializedShaderImpl::SerializeCreateInfo(ShaderCI);
     }
 
@@ -165,14 +206,31 @@ void SerializedPipelineStateImpl::PatchShadersD3D12(const CreateInfoType& Create
         const auto& Stage = ShaderStagesD3D12[j];
         for (size_t i = 0; i < Stage.Count(); ++i)
         {
-            const IDataBlob* pBytecode = Stage.ByteCodes[i];
-            ShaderCreateInfo ShaderCI  = ShaderStages[j].Serialized[i]->GetCreateInfo();
+            IDataBlob* const       pBytecode    = Stage.ByteCodes[i];
+            const ShaderD3D12Impl* pShaderD3D12 = Stage.Shaders[i];
+
+            // Resource bindings in the patched bytecode differ from the original shader,
+            // so reflect the patched bytecode to archive the resources that match it.
+            std::unique_ptr<ShaderResourcesD3D12> pPatchedResources;
+            if (const auto& pResources = pShaderD3D12->GetShaderResources())
+            {
+                pPatchedResources = std::make_unique<ShaderResourcesD3D12>(
+                    pBytecode,
+                    pShaderD3D12->GetDesc(),
+                    pResources->GetCombinedSamplerSuffix(),
+                    m_pSerializationDevice->GetD3D12Properties().pDxCompiler,
+                    false // LoadConstantBufferReflection
+                );
+            }
+            const SerializedData ShaderData = SerializeBytecodeD3D12(pBytecode, pPatchedResources.get());
+
+            ShaderCreateInfo ShaderCI = ShaderStages[j].Serialized[i]->GetCreateInfo();
 
             ShaderCI.Source       = nullptr;
             ShaderCI.FilePath     = nullptr;
             ShaderCI.Macros       = {};
-            ShaderCI.ByteCode     = pBytecode->GetConstDataPtr();
-            ShaderCI.ByteCodeSize = pBytecode->GetSize();
+            ShaderCI.ByteCode     = ShaderData.Ptr();
+            ShaderCI.ByteCodeSize = ShaderData.Size();
             SerializeShaderCreateInfo(DeviceType::Direct3D12, ShaderCI);
         }
     }
@@ -144,7 +144,9 @@ void SerializedResourceSignatureImpl::CreateDeviceSignature(DeviceType
     m_pDeviceSignatures[static_cast<size_t>(Type)] = std::move(pDeviceSignature);
 
     const auto& SignDesc = DeviceSignature.GetPRS()->GetDesc();
-    InitCommonData(SignDesc);
+    InitCommonData(SignDesc, [&DeviceSignature](Uint32 ResIndex) {
+        return DeviceSignature.PRS.GetInlineConstantCount(ResIndex);
+    });
 
     const auto InternalData = DeviceSignature.PRS.GetInternalData();
 
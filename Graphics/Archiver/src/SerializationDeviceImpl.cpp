@@ -32,6 +32,10 @@
 #include "SerializedResourceSignatureImpl.hpp"
 #include "SerializedPipelineStateImpl.hpp"
 #include "EngineMemory.h"
+#include "DataBlobImpl.hpp"
+#include "DynamicLinearAllocator.hpp"
+#include "PSOSerializer.hpp"
+#include "APIInfo.h"
 
 namespace Diligent
 {
@@ -65,9 +69,94 @@ static constexpr ARCHIVE_DEVICE_DATA_FLAGS GetSupportedDeviceFlags()
     return Flags;
 }
 
+namespace
+{
+
+// Header of the serialized shader compile job. Besides the target device, it contains
+// the device attributes that affect the compiled byte code, so that a worker whose
+// serialization device is configured differently rejects the job instead of producing
+// incompatible byte code.
+struct ShaderCompileJobHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x4A435344; // 'DSCJ'
+    static constexpr Uint32 ExpectedVersion = 1;
+
+    Uint32                    Magic         = ExpectedMagic;
+    Uint32                    FormatVersion = ExpectedVersion;
+    Uint32                    APIVersion    = DILIGENT_API_VERSION;
+    ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag    = ARCHIVE_DEVICE_DATA_FLAG_NONE;
+
+    Uint32  D3D11FeatureLevel  = 0;
+    Version D3D12ShaderVersion = {};
+    Uint32  VkVersion          = 0;
+    Bool    VkSupportsSpirv14  = False;
+
+    bool operator==(const ShaderCompileJobHeader& RHS) const
+    {
+        // clang-format off
+        return Magic              == RHS.Magic              &&
+               FormatVersion      == RHS.FormatVersion      &&
+               APIVersion         == RHS.APIVersion         &&
+               DeviceFlag         == RHS.DeviceFlag         &&
+               D3D11FeatureLevel  == RHS.D3D11FeatureLevel  &&
+               D3D12ShaderVersion == RHS.D3D12ShaderVersion &&
+               VkVersion          == RHS.VkVersion          &&
+               VkSupportsSpirv14  == RHS.VkSupportsSpirv14;
+        // clang-format on
+    }
+    bool operator!=(const ShaderCompileJobHeader& RHS) const
+    {
+        return !(*this == RHS);
+    }
+};
+
+template <SerializerMode Mode>
+bool SerializeShaderCompileJob(Serializer<Mode>&                                                      Ser,
+                               typename Serializer<Mode>::template ConstQual<ShaderCompileJobHeader>& Header,
+                               typename Serializer<Mode>::template ConstQual<ShaderCreateInfo>&       ShaderCI,
+                               DynamicLinearAllocator*                                                Allocator)
+{
+    if (!Ser(Header.Magic, Header.FormatVersion))
+        return false;
+
+    // Do not attempt to read the rest of the data if the format is unknown
+    if (Header.Magic != ShaderCompileJobHeader::ExpectedMagic || Header.FormatVersion != ShaderCompileJobHeader::ExpectedVersion)
+        return false;
+
+    if (!Ser(Header.APIVersion,
+             Header.DeviceFlag,
+             Header.D3D11FeatureLevel,
+             Header.D3D12ShaderVersion,
+             Header.VkVersion,
+             Header.VkSupportsSpirv14))
+        return false;
+
+    if (!ShaderSerializer<Mode>::SerializeCI(Ser, ShaderCI))
+        return false;
+
+    return Ser.SerializeArray(Allocator, ShaderCI.Macros.Elements, ShaderCI.Macros.Count,
+                              [](Serializer<Mode>& Ser, typename Serializer<Mode>::template ConstQual<ShaderMacro>& Macro) {
+                                  return Ser(Macro.Name, Macro.Definition);
+                              });
+}
+
+RENDER_DEVICE_TYPE CompileJobDeviceFlagToRenderDeviceType(ARCHIVE_DEVICE_DATA_FLAGS Flag)
+{
+    switch (Flag)
+    {
+        case ARCHIVE_DEVICE_DATA_FLAG_D3D11: return RENDER_DEVICE_TYPE_D3D11;
+        case ARCHIVE_DEVICE_DATA_FLAG_D3D12: return RENDER_DEVICE_TYPE_D3D12;
+        case ARCHIVE_DEVICE_DATA_FLAG_VULKAN: return RENDER_DEVICE_TYPE_VULKAN;
+        default: return RENDER_DEVICE_TYPE_UNDEFINED;
+    }
+}
+
+} // namespace
+
 SerializationDeviceImpl::SerializationDeviceImpl(IReferenceCounters* pRefCounters, const SerializationDeviceCreateInfo& CreateInfo) :
     TBase{pRefCounters, GetRawAllocator(), nullptr, EngineCreateInfo{}, CreateInfo.AdapterInfo},
-    m_ValidDeviceFlags{Diligent::GetSupportedDeviceFlags()}
+    m_ValidDeviceFlags{Diligent::GetSupportedDeviceFlags()},
+    m_CompressShaders{CreateInfo.CompressShaders != False}
 {
     m_DeviceInfo = CreateInfo.DeviceInfo;
 
@@ -146,6 +235,8 @@ SerializationDeviceImpl::SerializationDeviceImpl(IReferenceCounters* pRefCounter
     }
 
     InitShaderCompilationThreadPool(CreateInfo.pAsyncShaderCompilationThreadPool, CreateInfo.NumAsyncShaderCompilationThreads);
+
+    m_pCompileExecutor = CreateInfo.pCompileExecutor;
 }
 
 SerializationDeviceImpl::~SerializationDeviceImpl()
@@ -155,12 +246,197 @@ SerializationDeviceImpl::~SerializationDeviceImpl()
 #endif
 }
 
+SerializationDeviceImpl::ShaderRegistryKey::ShaderRegistryKey(const ShaderCreateInfo& ShaderCI, ARCHIVE_DEVICE_DATA_FLAGS _DeviceFlags) noexcept(false) :
+    pCreateInfo{std::make_shared<ShaderCreateInfoWrapper>(ShaderCI, GetRawAllocator())},
+    DeviceFlags{_DeviceFlags}
+{
+    const ShaderCreateInfo& CI = pCreateInfo->Get();
+
+    // The hash does not need to cover all members as the keys are compared with ShaderCreateInfo::operator==
+    Hash = ComputeHash(CStringHash<char>{}(CI.Desc.Name), CI.Desc.ShaderType, CI.CompileFlags, CI.SourceLanguage, static_cast<Uint32>(DeviceFlags));
+    HashCombine(Hash, CStringHash<char>{}(CI.FilePath), CStringHash<char>{}(CI.EntryPoint));
+    if (CI.Source != nullptr)
+        HashCombine(Hash, ComputeHashRaw(CI.Source, CI.SourceLength));
+    if (CI.ByteCode != nullptr)
+        HashCombine(Hash, ComputeHashRaw(CI.ByteCode, CI.ByteCodeSize));
+    for (size_t i = 0; i < CI.Macros.Count; ++i)
+        HashCombine(Hash, CStringHash<char>{}(CI.Macros[i].Name), CStringHash<char>{}(CI.Macros[i].Definition));
+}
+
+bool SerializationDeviceImpl::ShaderRegistryKey::operator==(const ShaderRegistryKey& RHS) const noexcept
+{
+    const ShaderCreateInfo& CI1 = pCreateInfo->Get();
+    const ShaderCreateInfo& CI2 = RHS.pCreateInfo->Get();
+
+    // ShaderCreateInfo::operator== ignores the name and the source stream factory
+    return (Hash == RHS.Hash &&
+            DeviceFlags == RHS.DeviceFlags &&
+            SafeStrEqual(CI1.Desc.Name, CI2.Desc.Name) &&
+            CI1.pShaderSourceStreamFactory == CI2.pShaderSourceStreamFactory &&
+            CI1 == CI2);
+}
+
 void SerializationDeviceImpl::CreateShader(const ShaderCreateInfo&  ShaderCI,
                                            const ShaderArchiveInfo& ArchiveInfo,
                                            IShader**                ppShader,
                                            IDataBlob**              ppCompilerOutput)
 {
-    CreateShaderImpl(ppShader, ShaderCI, ArchiveInfo, ppCompilerOutput);
+    // The compiler output is only produced when the shader is compiled,
+    // so shaders that request it are not taken from the registry.
+    if (ppCompilerOutput != nullptr)
+    {
+        CreateShaderImpl(ppShader, ShaderCI, ArchiveInfo, ppCompilerOutput);
+        return;
+    }
+
+    std::unique_ptr<ShaderRegistryKey> pKey;
+    try
+    {
+        pKey = std::make_unique<ShaderRegistryKey>(ShaderCI, ArchiveInfo.DeviceFlags);
+    }
+    catch (...)
+    {
+        // The create info is invalid - let the shader constructor report the error
+        CreateShaderImpl(ppShader, ShaderCI, ArchiveInfo, ppCompilerOutput);
+        return;
+    }
+
+    RefCntAutoPtr<IShader> pShader = m_ShaderRegistry.Get(
+        *pKey,
+        [&]() {
+            RefCntAutoPtr<IShader> pNewShader;
+            CreateShaderImpl(&pNewShader, ShaderCI, ArchiveInfo, nullptr);
+            return pNewShader;
+        });
+    *ppShader = pShader.Detach();
+}
+
+RefCntAutoPtr<IDataBlob> SerializationDeviceImpl::CompileWithExecutor(const ShaderCreateInfo& ShaderCI, ARCHIVE_DEVICE_DATA_FLAGS DeviceFlag) const
+{
+    VERIFY_EXPR(m_pCompileExecutor);
+    VERIFY(ShaderCI.pShaderSourceStreamFactory == nullptr && ShaderCI.FilePath == nullptr,
+           "Shader includes must be unrolled before the shader is sent to the compile executor");
+
+    ShaderCompileJobHeader Header;
+    Header.DeviceFlag = DeviceFlag;
+    switch (DeviceFlag)
+    {
+        case ARCHIVE_DEVICE_DATA_FLAG_D3D11:
+            Header.D3D11FeatureLevel = m_D3D11Props.FeatureLevel;
+            break;
+
+        case ARCHIVE_DEVICE_DATA_FLAG_D3D12:
+            Header.D3D12ShaderVersion = m_D3D12Props.ShaderVersion;
+            break;
+
+        case ARCHIVE_DEVICE_DATA_FLAG_VULKAN:
+            Header.VkVersion         = m_VkProps.VkVersion;
+            Header.VkSupportsSpirv14 = m_VkProps.SupportsSpirv14;
+            break;
+
+        default:
+            UNEXPECTED("Only Direct3D11, Direct3D12 and Vulkan shaders can be compiled by the executor");
+            return {};
+    }
+
+    SerializedData JobData;
+    {
+        Serializer<SerializerMode::Measure> Ser;
+        SerializeShaderCompileJob(Ser, Header, ShaderCI, nullptr);
+        JobData = Ser.AllocateData(GetRawAllocator());
+    }
+    {
+        Serializer<SerializerMode::Write> Ser{JobData};
+        const bool Res = SerializeShaderCompileJob(Ser, Header, ShaderCI, nullptr);
+        VERIFY(Res && Ser.IsEnded(), "Failed to serialize the shader compile job");
+        (void)Res;
+    }
+
+    ShaderCompileJob Job;
+    Job.pShaderCI  = &ShaderCI;
+    Job.DeviceFlag = DeviceFlag;
+    Job.pData      = JobData.Ptr();
+    Job.DataSize   = JobData.Size();
+
+    RefCntAutoPtr<IDataBlob> pByteCode;
+    m_pCompileExecutor->Compile(Job, &pByteCode);
+    if (pByteCode && pByteCode->GetSize() == 0)
+    {
+        LOG_WARNING_MESSAGE("Shader compile executor returned empty byte code for shader '", ShaderCI.Desc.Name, "'. The shader will be compiled locally.");
+        pByteCode.Release();
+    }
+    return pByteCode;
+}
+
+void SerializationDeviceImpl::CompileShaderJob(const void* pJobData,
+                                               Uint64      DataSize,
+                                               IDataBlob** ppByteCode)
+{
+    DEV_CHECK_ERR(ppByteCode != nullptr, "ppByteCode must not be null");
+    DEV_CHECK_ERR(*ppByteCode == nullptr, "Overwriting reference to an existing object may result in memory leaks");
+    if (pJobData == nullptr || DataSize == 0 || ppByteCode == nullptr)
+    {
+        DEV_ERROR("Shader compile job data must not be empty");
+        return;
+    }
+
+    DynamicLinearAllocator Allocator{GetRawAllocator()};
+    ShaderCompileJobHeader Header;
+    ShaderCreateInfo       ShaderCI;
+
+    Serializer<SerializerMode::Read> Ser{SerializedData{const_cast<void*>(pJobData), StaticCast<size_t>(DataSize)}};
+    if (!SerializeShaderCompileJob(Ser, Header, ShaderCI, &Allocator) || !Ser.IsEnded())
+    {
+        LOG_ERROR_MESSAGE("Failed to read the shader compile job. The data is either corrupted or was created by an incompatible version of the engine.");
+        return;
+    }
+
+    if ((Header.DeviceFlag & m_ValidDeviceFlags) == 0 || CompileJobDeviceFlagToRenderDeviceType(Header.DeviceFlag) == RENDER_DEVICE_TYPE_UNDEFINED)
+    {
+        LOG_ERROR_MESSAGE("Shader compile job '", ShaderCI.Desc.Name, "' targets a device type that is not supported by this serialization device.");
+        return;
+    }
+
+    ShaderCompileJobHeader ExpectedHeader = Header;
+    ExpectedHeader.APIVersion             = DILIGENT_API_VERSION;
+    ExpectedHeader.D3D11FeatureLevel      = Header.DeviceFlag == ARCHIVE_DEVICE_DATA_FLAG_D3D11 ? m_D3D11Props.FeatureLevel : 0;
+    ExpectedHeader.D3D12ShaderVersion     = Header.DeviceFlag == ARCHIVE_DEVICE_DATA_FLAG_D3D12 ? m_D3D12Props.ShaderVersion : Version{};
+    ExpectedHeader.VkVersion              = Header.DeviceFlag == ARCHIVE_DEVICE_DATA_FLAG_VULKAN ? m_VkProps.VkVersion : 0;
+    ExpectedHeader.VkSupportsSpirv14      = Header.DeviceFlag == ARCHIVE_DEVICE_DATA_FLAG_VULKAN && m_VkProps.SupportsSpirv14 ? True : False;
+    if (Header != ExpectedHeader)
+    {
+        LOG_ERROR_MESSAGE("Shader compile job '", ShaderCI.Desc.Name,
+                          "' was created by a serialization device with different attributes or engine version.");
+        return;
+    }
+
+    ShaderArchiveInfo ArchiveInfo;
+    ArchiveInfo.DeviceFlags = Header.DeviceFlag;
+
+    RefCntAutoPtr<IShader> pShader;
+    CreateShaderImpl(&pShader, ShaderCI, ArchiveInfo, static_cast<IDataBlob**>(nullptr), /*UseCompileExecutor = */ false);
+    if (!pShader)
+        return;
+
+    RefCntAutoPtr<SerializedShaderImpl> pSerializedShader{pShader, SerializedShaderImpl::IID_InternalImpl};
+    VERIFY_EXPR(pSerializedShader);
+    IShader* pDeviceShader = pSerializedShader->GetDeviceShader(CompileJobDeviceFlagToRenderDeviceType(Header.DeviceFlag));
+    if (pDeviceShader == nullptr || pDeviceShader->GetStatus() != SHADER_STATUS_READY)
+    {
+        LOG_ERROR_MESSAGE("Failed to compile shader '", ShaderCI.Desc.Name, "'");
+        return;
+    }
+
+    const void* pByteCode    = nullptr;
+    Uint64      ByteCodeSize = 0;
+    pDeviceShader->GetBytecode(&pByteCode, ByteCodeSize);
+    if (pByteCode == nullptr || ByteCodeSize == 0)
+    {
+        LOG_ERROR_MESSAGE("Shader '", ShaderCI.Desc.Name, "' has no byte code");
+        return;
+    }
+
+    *ppByteCode = DataBlobImpl::Create(StaticCast<size_t>(ByteCodeSize), pByteCode).Detach();
 }
 
 void SerializationDeviceImpl::CreateRenderPass(const RenderPassDesc& Desc, IRenderPass** ppRenderPass)
@@ -481,9 +481,11 @@ ShaderCreateInfo DILIGENT_CALL_TYPE SerializedPipelineStateImpl::GetPatchedShade
             Serializer<SerializerMode::Read> Ser{Shaders[ShaderIndex].Data};
             ShaderSerializer<SerializerMode::Read>::SerializeCI(Ser, ShaderCI);
         }
-        if (Type == DeviceType::Metal_MacOS || Type == DeviceType::Metal_iOS)
+        if (Type == DeviceType::Metal_MacOS || Type == DeviceType::Metal_iOS || Type == DeviceType::Direct3D12)
         {
-            // See DeviceObjectArchiveMtlImpl::UnpackShader and ShaderMtlSerializer<>::SerializeSource
+            // See DeviceObjectArchiveMtlImpl::UnpackShader and ShaderMtlSerializer<>::SerializeSource,
+            // DearchiverD3D12Impl::UnpackShader and ShaderD3D12Serializer<>::SerializeBytecode.
+            // In both cases, the data starts with the bytecode.
             Serializer<SerializerMode::Read> Ser{SerializedData{const_cast<void*>(ShaderCI.ByteCode), ShaderCI.ByteCodeSize}};
             Ser.SerializeBytes(ShaderCI.ByteCode, ShaderCI.ByteCodeSize);
         }
@@ -25,6 +25,9 @@
  */
 
 #include "SerializedResourceSignatureImpl.hpp"
+
+#include <vector>
+
 #include "PipelineResourceSignatureBase.hpp"
 #include "SerializationDeviceImpl.hpp"
 #include "FixedLinearAllocator.hpp"
@@ -133,7 +136,7 @@ const PipelineResourceSignatureDesc& SerializedResourceSignatureImpl::GetDesc()
 }
 
 
-void SerializedResourceSignatureImpl::InitCommonData(const PipelineResourceSignatureDesc& Desc)
+void SerializedResourceSignatureImpl::InitCommonData(const PipelineResourceSignatureDesc& Desc, const std::function<Uint32(Uint32)>& GetInlineConstantCount)
 {
     VERIFY(m_Name == Desc.Name, "Inconsistent signature name");
 
@@ -143,12 +146,23 @@ void SerializedResourceSignatureImpl::InitCommonData(const PipelineResourceSigna
         // Note that since Desc is kept by the device signatures, there is no need to copy the data.
         m_pDesc = &Desc;
 
+        // Device signatures expose inline constants as constant buffers with array size 1.
+        // Restore the number of constants in the serialized description.
+        PipelineResourceSignatureDesc     SerDesc = Desc;
+        std::vector<PipelineResourceDesc> Resources{Desc.Resources, Desc.Resources + Desc.NumResources};
+        for (Uint32 r = 0; r < Desc.NumResources; ++r)
+        {
+            if (const Uint32 NumConstants = GetInlineConstantCount(r))
+                Resources[r].ArraySize = NumConstants;
+        }
+        SerDesc.Resources = Resources.data();
+
         Serializer<SerializerMode::Measure> MeasureSer;
-        PRSSerializer<SerializerMode::Measure>::SerializeDesc(MeasureSer, Desc, nullptr);
+        PRSSerializer<SerializerMode::Measure>::SerializeDesc(MeasureSer, SerDesc, nullptr);
 
         m_CommonData = MeasureSer.AllocateData(GetRawAllocator());
         Serializer<SerializerMode::Write> WSer{m_CommonData};
-        PRSSerializer<SerializerMode::Write>::SerializeDesc(WSer, Desc, nullptr);
+        PRSSerializer<SerializerMode::Write>::SerializeDesc(WSer, SerDesc, nullptr);
         VERIFY_EXPR(WSer.IsEnded());
 
         VERIFY_EXPR(GetDesc() == Desc);
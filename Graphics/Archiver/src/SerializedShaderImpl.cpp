@@ -27,6 +27,7 @@
 #include "SerializedShaderImpl.hpp"
 
 #include <cstring>
+#include <vector>
 
 #include "SerializationDeviceImpl.hpp"
 #include "EngineMemory.h"
@@ -34,6 +35,8 @@
 #include "PlatformMisc.hpp"
 #include "BasicMath.hpp"
 #include "PSOSerializer.hpp"
+#include "ThreadPool.hpp"
+#include "ShaderToolsCommon.hpp"
 
 namespace Diligent
 {
@@ -44,7 +47,8 @@ SerializedShaderImpl::SerializedShaderImpl(IReferenceCounters*      pRefCounters
                                            SerializationDeviceImpl* pDevice,
                                            const ShaderCreateInfo&  ShaderCI,
                                            const ShaderArchiveInfo& ArchiveInfo,
-                                           IDataBlob**              ppCompilerOutput) :
+                                           IDataBlob**              ppCompilerOutput,
+                                           bool                     UseCompileExecutor) :
     TBase{pRefCounters},
     m_pDevice{pDevice}
 {
@@ -72,59 +76,137 @@ SerializedShaderImpl::SerializedShaderImpl(IReferenceCounters*      pRefCounters
         DeviceFlags &= ~ARCHIVE_DEVICE_DATA_FLAG_GLES;
     }
 
+    // Direct3D11, Direct3D12 and Vulkan shaders may be compiled by the compile executor.
+    // The includes are unrolled once here so that the compile jobs are self-contained.
+    // Compiler output is only produced by local compilation, so shaders that request it
+    // as well as asynchronous shaders are always compiled locally.
+    constexpr ARCHIVE_DEVICE_DATA_FLAGS ExecutorDeviceFlags = ARCHIVE_DEVICE_DATA_FLAG_D3D11 | ARCHIVE_DEVICE_DATA_FLAG_D3D12 | ARCHIVE_DEVICE_DATA_FLAG_VULKAN;
+
+    std::string      PreprocessedSource;
+    ShaderCreateInfo PreprocessedCI;
+    if (UseCompileExecutor &&
+        m_pDevice->GetCompileExecutor() != nullptr &&
+        (DeviceFlags & ExecutorDeviceFlags) != 0 &&
+        ppCompilerOutput == nullptr &&
+        (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_ASYNCHRONOUS) == 0 &&
+        ShaderCI.ByteCode == nullptr)
+    {
+        PreprocessedSource = UnrollShaderIncludes(ShaderCI);
+
+        PreprocessedCI                            = ShaderCI;
+        PreprocessedCI.Source                     = PreprocessedSource.c_str();
+        PreprocessedCI.SourceLength               = PreprocessedSource.length();
+        PreprocessedCI.FilePath                   = nullptr;
+        PreprocessedCI.pShaderSourceStreamFactory = nullptr;
+    }
+    const ShaderCreateInfo* pPreprocessedCI = PreprocessedCI.Source != nullptr ? &PreprocessedCI : nullptr;
+
+    // Shader variants for different backends are independent and can be compiled in parallel.
+    // Compiler output is shared by all backends, and asynchronous shaders are compiled by the
+    // backend tasks, so in both cases the variants are created one after another.
+    // OpenGL shaders are always created on the calling thread as the GL render device may not
+    // be used by other threads.
+    IThreadPool* const pThreadPool = m_pDevice->GetShaderCompilationThreadPool();
+    if (pThreadPool != nullptr && ppCompilerOutput == nullptr && (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_ASYNCHRONOUS) == 0)
+    {
+        std::vector<ARCHIVE_DEVICE_DATA_FLAGS> ParallelFlags;
+        for (ARCHIVE_DEVICE_DATA_FLAGS Flags = DeviceFlags; Flags != ARCHIVE_DEVICE_DATA_FLAG_NONE;)
+        {
+            const ARCHIVE_DEVICE_DATA_FLAGS Flag = ExtractLSB(Flags);
+            if ((Flag & (ARCHIVE_DEVICE_DATA_FLAG_GL | ARCHIVE_DEVICE_DATA_FLAG_GLES)) == 0)
+                ParallelFlags.push_back(Flag);
+        }
+
+        if (ParallelFlags.size() > 1)
+        {
+            ProcessItemsInParallel(pThreadPool, ParallelFlags.size(),
+                                   [&](size_t i) {
+                                       CreateDeviceShader(ParallelFlags[i], pRefCounters, ShaderCI, nullptr, pPreprocessedCI);
+                                   });
+            for (ARCHIVE_DEVICE_DATA_FLAGS Flag : ParallelFlags)
+                DeviceFlags &= ~Flag;
+        }
+    }
+
     while (DeviceFlags != ARCHIVE_DEVICE_DATA_FLAG_NONE)
     {
-        const ARCHIVE_DEVICE_DATA_FLAGS Flag = ExtractLSB(DeviceFlags);
+        CreateDeviceShader(ExtractLSB(DeviceFlags), pRefCounters, ShaderCI, ppCompilerOutput, pPreprocessedCI);
+    }
+}
 
-        static_assert(ARCHIVE_DEVICE_DATA_FLAG_LAST == 1 << 7, "Please update the switch below to handle the new device data type");
-        switch (Flag)
+void SerializedShaderImpl::CreateDeviceShader(ARCHIVE_DEVICE_DATA_FLAGS Flag,
+                                              IReferenceCounters*       pRefCounters,
+                                              const ShaderCreateInfo&   ShaderCI,
+                                              IDataBlob**               ppCompilerOutput,
+                                              const ShaderCreateInfo*   pPreprocessedCI) noexcept(false)
+{
+    if (pPreprocessedCI != nullptr && (Flag & (ARCHIVE_DEVICE_DATA_FLAG_D3D11 | ARCHIVE_DEVICE_DATA_FLAG_D3D12 | ARCHIVE_DEVICE_DATA_FLAG_VULKAN)) != 0)
+    {
+        if (RefCntAutoPtr<IDataBlob> pByteCode = m_pDevice->CompileWithExecutor(*pPreprocessedCI, Flag))
         {
+            // The archive only stores the byte code, so the shader created from the byte code
+            // produces the same device data as the shader compiled locally.
+            ShaderCreateInfo ByteCodeCI{ShaderCI};
+            ByteCodeCI.Source                     = nullptr;
+            ByteCodeCI.SourceLength               = 0;
+            ByteCodeCI.FilePath                   = nullptr;
+            ByteCodeCI.pShaderSourceStreamFactory = nullptr;
+            ByteCodeCI.Macros                     = {};
+            ByteCodeCI.ByteCode                   = pByteCode->GetConstDataPtr();
+            ByteCodeCI.ByteCodeSize               = pByteCode->GetSize();
+            CreateDeviceShader(Flag, pRefCounters, ByteCodeCI, ppCompilerOutput);
+            return;
+        }
+    }
+
+    static_assert(ARCHIVE_DEVICE_DATA_FLAG_LAST == 1 << 7, "Please update the switch below to handle the new device data type");
+    switch (Flag)
+    {
 #if D3D11_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_D3D11:
-                CreateShaderD3D11(pRefCounters, ShaderCI, ppCompilerOutput);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_D3D11:
+            CreateShaderD3D11(pRefCounters, ShaderCI, ppCompilerOutput);
+            break;
 #endif
 
 #if D3D12_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_D3D12:
-                CreateShaderD3D12(pRefCounters, ShaderCI, ppCompilerOutput);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_D3D12:
+            CreateShaderD3D12(pRefCounters, ShaderCI, ppCompilerOutput);
+            break;
 #endif
 
 #if GL_SUPPORTED || GLES_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_GL:
-            case ARCHIVE_DEVICE_DATA_FLAG_GLES:
-                CreateShaderGL(pRefCounters, ShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_GL ? RENDER_DEVICE_TYPE_GL : RENDER_DEVICE_TYPE_GLES, ppCompilerOutput);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_GL:
+        case ARCHIVE_DEVICE_DATA_FLAG_GLES:
+            CreateShaderGL(pRefCounters, ShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_GL ? RENDER_DEVICE_TYPE_GL : RENDER_DEVICE_TYPE_GLES, ppCompilerOutput);
+            break;
 #endif
 
 #if VULKAN_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_VULKAN:
-                CreateShaderVk(pRefCounters, ShaderCI, ppCompilerOutput);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_VULKAN:
+            CreateShaderVk(pRefCounters, ShaderCI, ppCompilerOutput);
+            break;
 #endif
 
 #if METAL_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS:
-            case ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS:
-                CreateShaderMtl(pRefCounters, ShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS ? DeviceType::Metal_MacOS : DeviceType::Metal_iOS, ppCompilerOutput);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS:
+        case ARCHIVE_DEVICE_DATA_FLAG_METAL_IOS:
+            CreateShaderMtl(pRefCounters, ShaderCI, Flag == ARCHIVE_DEVICE_DATA_FLAG_METAL_MACOS ? DeviceType::Metal_MacOS : DeviceType::Metal_iOS, ppCompilerOutput);
+            break;
 #endif
 
 #if WEBGPU_SUPPORTED
-            case ARCHIVE_DEVICE_DATA_FLAG_WEBGPU:
-                CreateShaderWebGPU(pRefCounters, ShaderCI, ppCompilerOutput);
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_WEBGPU:
+            CreateShaderWebGPU(pRefCounters, ShaderCI, ppCompilerOutput);
+            break;
 #endif
 
-            case ARCHIVE_DEVICE_DATA_FLAG_NONE:
-                UNEXPECTED("ARCHIVE_DEVICE_DATA_FLAG_NONE(0) should never occur");
-                break;
+        case ARCHIVE_DEVICE_DATA_FLAG_NONE:
+            UNEXPECTED("ARCHIVE_DEVICE_DATA_FLAG_NONE(0) should never occur");
+            break;
 
-            default:
-                LOG_ERROR_MESSAGE("Unexpected render device type");
-                break;
-        }
+        default:
+            LOG_ERROR_MESSAGE("Unexpected render device type");
+            break;
     }
 }
 
@@ -32,10 +32,10 @@
 /// Declaration of DynamicAtlasManager class
 
 #include <map>
-#include <unordered_map>
 
 #include "../../../Primitives/interface/BasicTypes.h"
 #include "../../../Common/interface/HashUtils.hpp"
+#include "../../../Common/interface/FlatHashMap.hpp"
 
 namespace Diligent
 {
@@ -117,6 +117,9 @@ public:
         return static_cast<Uint32>(m_FreeRegionsByWidth.size());
     }
 
+    /// Returns the area of the largest free region.
+    Uint64 GetMaxFreeRegionArea() const;
+
     Uint32 GetWidth() const { return m_Width; }
     Uint32 GetHeight() const { return m_Height; }
     Uint64 GetTotalFreeArea() const { return m_TotalFreeArea; }
@@ -228,7 +231,7 @@ private:
     // Free regions ordered by height->width->y->x
     std::map<Region, Node*, HeightFirstCompare> m_FreeRegionsByHeight;
     // Allocated regions
-    std::unordered_map<Region, Node*, Region::Hasher> m_AllocatedRegions;
+    FlatHashMap<Region, Node*, Region::Hasher> m_AllocatedRegions;
 };
 
 } // namespace Diligent
@@ -36,9 +36,11 @@
 #include <mutex>
 #include <deque>
 #include <atomic>
+#include <algorithm>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Common/interface/STDAllocator.hpp"
+#include "../../../Common/interface/LockFreeBlockPool.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
@@ -66,8 +68,16 @@ public:
 
     using RefCounterType = long;
 
+    /// Creates a wrapper for the resource.
+
+    /// \param [in] Resource      - Resource to be released.
+    /// \param [in] NumReferences - Number of references to the resource.
+    /// \param [in] pPool         - Optional pool to allocate the wrapped resource from.
+    ///                             If the resource does not fit into the pool block, or
+    ///                             the pool is null, the resource is allocated on the heap.
+    ///                             The pool must outlive the wrapped resource.
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
-    static DynamicStaleResourceWrapper Create(ResourceType&& Resource, RefCounterType NumReferences)
+    static DynamicStaleResourceWrapper Create(ResourceType&& Resource, RefCounterType NumReferences, LockFreeBlockPool* pPool = nullptr)
     {
         VERIFY_EXPR(NumReferences >= 1);
 
@@ -87,7 +97,7 @@ public:
 
             virtual void Release() override final
             {
-                delete this;
+                Destroy(this);
             }
 
         private:
@@ -114,7 +124,7 @@ public:
             {
                 if (m_RefCounter.fetch_add(-1) - 1 == 0)
                 {
-                    delete this;
+                    Destroy(this);
                 }
             }
 
@@ -125,8 +135,8 @@ public:
 
         return DynamicStaleResourceWrapper{
             NumReferences == 1 ?
-                static_cast<StaleResourceBase*>(new SpecificStaleResource{std::move(Resource)}) :
-                static_cast<StaleResourceBase*>(new SpecificSharedStaleResource{std::move(Resource), NumReferences})};
+                NewStaleResource<SpecificStaleResource>(pPool, std::move(Resource)) :
+                NewStaleResource<SpecificSharedStaleResource>(pPool, std::move(Resource), NumReferences)};
     }
 
     DynamicStaleResourceWrapper(DynamicStaleResourceWrapper&& rhs) noexcept :
@@ -140,10 +150,19 @@ public:
     {
     }
 
-    // clang-format off
-    DynamicStaleResourceWrapper& operator = (const DynamicStaleResourceWrapper&)  = delete;
-    DynamicStaleResourceWrapper& operator = (      DynamicStaleResourceWrapper&&) = delete;
-    // clang-format on
+    DynamicStaleResourceWrapper& operator=(DynamicStaleResourceWrapper&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            if (m_pStaleResource != nullptr)
+                m_pStaleResource->Release();
+            m_pStaleResource     = rhs.m_pStaleResource;
+            rhs.m_pStaleResource = nullptr;
+        }
+        return *this;
+    }
+
+    DynamicStaleResourceWrapper& operator=(const DynamicStaleResourceWrapper&) = delete;
 
     void GiveUpOwnership()
     {
@@ -162,8 +181,44 @@ private:
     public:
         virtual ~StaleResourceBase() = 0;
         virtual void Release()       = 0;
+
+    protected:
+        template <typename StaleResourceType>
+        static void Destroy(StaleResourceType* pResource)
+        {
+            if (LockFreeBlockPool* pPool = pResource->m_pPool)
+            {
+                pResource->~StaleResourceType();
+                pPool->Free(pResource);
+            }
+            else
+            {
+                delete pResource;
+            }
+        }
+
+    private:
+        friend DynamicStaleResourceWrapper;
+
+        // Pool the object was allocated from, or null if it was allocated on the heap
+        LockFreeBlockPool* m_pPool = nullptr;
     };
 
+    template <typename StaleResourceType, typename... ArgsType>
+    static StaleResourceBase* NewStaleResource(LockFreeBlockPool* pPool, ArgsType&&... Args)
+    {
+        if (pPool != nullptr && sizeof(StaleResourceType) <= pPool->GetBlockSize() && alignof(StaleResourceType) <= alignof(std::max_align_t))
+        {
+            if (void* pMem = pPool->Allocate())
+            {
+                StaleResourceBase* pResource = new (pMem) StaleResourceType{std::forward<ArgsType>(Args)...};
+                pResource->m_pPool           = pPool;
+                return pResource;
+            }
+        }
+        return new StaleResourceType{std::forward<ArgsType>(Args)...};
+    }
+
     DynamicStaleResourceWrapper(StaleResourceBase* pStaleResource) :
         m_pStaleResource(pStaleResource)
     {}
@@ -220,6 +275,10 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Releasing threads do not take locks: SafeReleaseResource() and DiscardResource() push the resources
+/// into lock-free staging lists. The lists are drained and sorted by the command list number or the fence
+/// value when stale resources are discarded and when the queue is purged, respectively.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
@@ -227,13 +286,16 @@ class ResourceReleaseQueue
 public:
     // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+        m_StagingNodePool{Allocator, sizeof(StagingNode)},
+        m_ReleaseQueue   (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
+        m_StaleResources (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
     {}
     // clang-format on
 
     ~ResourceReleaseQueue()
     {
+        DrainStagingList(m_StagedStaleResources, m_StaleResources);
+        DrainStagingList(m_StagedReleaseQueue, m_ReleaseQueue);
         DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
         DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
     }
@@ -261,8 +323,8 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(ResourceWrapperType&& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+        StagingNode* pNode = CreateStagingNode(NextCommandListNumber, std::move(Wrapper));
+        PushToStagingList(m_StagedStaleResources, pNode, pNode);
     }
 
     /// Moves a copy of the resource wrapper to the stale resources queue
@@ -270,8 +332,8 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(const ResourceWrapperType& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+        StagingNode* pNode = CreateStagingNode(NextCommandListNumber, Wrapper);
+        PushToStagingList(m_StagedStaleResources, pNode, pNode);
     }
 
     /// Adds a resource directly to the release queue
@@ -288,8 +350,8 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+        StagingNode* pNode = CreateStagingNode(FenceValue, std::move(Wrapper));
+        PushToStagingList(m_StagedReleaseQueue, pNode, pNode);
     }
 
     /// Adds a copy of the resource wrapper directly to the release queue
@@ -297,8 +359,8 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
+        StagingNode* pNode = CreateStagingNode(FenceValue, Wrapper);
+        PushToStagingList(m_StagedReleaseQueue, pNode, pNode);
     }
 
     /// Adds multiple resources directly to the release queue
@@ -307,12 +369,21 @@ public:
     template <typename ResourceType, typename IteratorType>
     void DiscardResources(Uint64 FenceValue, IteratorType Iterator)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        ResourceType                Resource;
+        // Link the nodes in the order opposite to the push order, which is
+        // the order of the staging list, and push them all at once.
+        StagingNode* pFirst = nullptr;
+        StagingNode* pLast  = nullptr;
+        ResourceType Resource;
         while (Iterator(Resource))
         {
-            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+            StagingNode* pNode = CreateStagingNode(FenceValue, CreateWrapper(std::move(Resource), 1));
+            pNode->pNext       = pFirst;
+            pFirst             = pNode;
+            if (pLast == nullptr)
+                pLast = pNode;
         }
+        if (pFirst != nullptr)
+            PushToStagingList(m_StagedReleaseQueue, pFirst, pLast);
     }
 
     /// Moves stale objects to the release queue
@@ -324,10 +395,13 @@ public:
     ///                                      is greater or equal to the fence value associated with the resource
     void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
     {
+        std::lock_guard<std::mutex> Lock{m_QueuesMtx};
+
+        DrainStagingList(m_StagedStaleResources, m_StaleResources);
+
         // Only discard these stale objects that were released before CmdBuffNumber
         // was executed
-        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+        const size_t NumSorted = m_ReleaseQueue.size();
         while (!m_StaleResources.empty())
         {
             auto& FirstStaleObj = m_StaleResources.front();
@@ -339,6 +413,8 @@ public:
             else
                 break;
         }
+        // Resources discarded directly may have greater fence values
+        MergeSorted(m_ReleaseQueue, NumSorted);
     }
 
 
@@ -347,7 +423,9 @@ public:
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
     void Purge(Uint64 CompletedFenceValue)
     {
-        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        std::lock_guard<std::mutex> Lock{m_QueuesMtx};
+
+        DrainStagingList(m_StagedReleaseQueue, m_ReleaseQueue);
 
         // Release all objects whose associated fence value is at most CompletedFenceValue
         // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
@@ -364,22 +442,144 @@ public:
     /// Returns the number of stale resources
     size_t GetStaleResourceCount() const
     {
-        return m_StaleResources.size();
+        std::lock_guard<std::mutex> Lock{m_QueuesMtx};
+        return m_StaleResources.size() + GetStagingListSize(m_StagedStaleResources);
     }
 
     /// Returns the number of resources pending release
     size_t GetPendingReleaseResourceCount() const
     {
-        return m_ReleaseQueue.size();
+        std::lock_guard<std::mutex> Lock{m_QueuesMtx};
+        return m_ReleaseQueue.size() + GetStagingListSize(m_StagedReleaseQueue);
     }
 
 private:
-    std::mutex m_ReleaseQueueMutex;
     using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
+    using QueueType            = std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>>;
+
+    struct StagingNode
+    {
+        template <typename WrapperType>
+        StagingNode(Uint64 _Value, WrapperType&& _Wrapper) :
+            Value{_Value},
+            Wrapper{std::forward<WrapperType>(_Wrapper)}
+        {}
+
+        StagingNode*        pNext = nullptr;
+        const Uint64        Value;
+        ResourceWrapperType Wrapper;
+
+        // True if the node was allocated from m_StagingNodePool, false if it was allocated on the heap
+        bool FromPool = false;
+    };
+
+    static_assert(alignof(StagingNode) <= alignof(std::max_align_t), "Staging nodes are allocated from the pool, which does not support over-aligned types");
+
+    template <typename WrapperType>
+    StagingNode* CreateStagingNode(Uint64 Value, WrapperType&& Wrapper)
+    {
+        if (void* pMem = m_StagingNodePool.Allocate())
+        {
+            StagingNode* pNode = new (pMem) StagingNode{Value, std::forward<WrapperType>(Wrapper)};
+            pNode->FromPool    = true;
+            return pNode;
+        }
+        // The pool is exhausted
+        return new StagingNode{Value, std::forward<WrapperType>(Wrapper)};
+    }
+
+    void DestroyStagingNode(StagingNode* pNode)
+    {
+        if (pNode->FromPool)
+        {
+            pNode->~StagingNode();
+            m_StagingNodePool.Free(pNode);
+        }
+        else
+        {
+            delete pNode;
+        }
+    }
+
+    // Pushes the chain of nodes pFirst -> ... -> pLast to the head of the list.
+    static void PushToStagingList(std::atomic<StagingNode*>& Head, StagingNode* pFirst, StagingNode* pLast)
+    {
+        StagingNode* pHead = Head.load(std::memory_order_relaxed);
+        do
+        {
+            pLast->pNext = pHead;
+        } while (!Head.compare_exchange_weak(pHead, pFirst, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Moves all staged resources to the queue and keeps the queue sorted.
+    // Must be called while m_QueuesMtx is locked.
+    void DrainStagingList(std::atomic<StagingNode*>& Head, QueueType& Queue)
+    {
+        StagingNode* pNode = Head.exchange(nullptr, std::memory_order_acquire);
+        if (pNode == nullptr)
+            return;
+
+        // The most recently pushed node is at the head - reverse the list to restore the push order
+        StagingNode* pFirst = nullptr;
+        while (pNode != nullptr)
+        {
+            StagingNode* pNext = pNode->pNext;
+            pNode->pNext       = pFirst;
+            pFirst             = pNode;
+            pNode              = pNext;
+        }
+
+        const size_t NumSorted = Queue.size();
+        for (pNode = pFirst; pNode != nullptr;)
+        {
+            Queue.emplace_back(pNode->Value, std::move(pNode->Wrapper));
+
+            StagingNode* pNext = pNode->pNext;
+            DestroyStagingNode(pNode);
+            pNode = pNext;
+        }
+
+        MergeSorted(Queue, NumSorted);
+    }
+
+    // Sorts the elements starting at NumSorted and merges them with the sorted range that precedes them.
+    static void MergeSorted(QueueType& Queue, size_t NumSorted)
+    {
+        const auto Less = [](const ReleaseQueueElemType& lhs, const ReleaseQueueElemType& rhs) {
+            return lhs.first < rhs.first;
+        };
+
+        const auto Middle = Queue.begin() + NumSorted;
+        if (!std::is_sorted(Middle, Queue.end(), Less))
+            std::stable_sort(Middle, Queue.end(), Less);
+        if (Middle != Queue.begin() && Middle != Queue.end() && Less(*Middle, *(Middle - 1)))
+            std::inplace_merge(Queue.begin(), Middle, Queue.end(), Less);
+    }
+
+    // Must be called while m_QueuesMtx is locked, so that the nodes are not released.
+    static size_t GetStagingListSize(const std::atomic<StagingNode*>& Head)
+    {
+        size_t Size = 0;
+        for (const StagingNode* pNode = Head.load(std::memory_order_acquire); pNode != nullptr; pNode = pNode->pNext)
+            ++Size;
+        return Size;
+    }
+
+private:
+    LockFreeBlockPool m_StagingNodePool;
+
+    // Lock-free lists of the resources released by SafeReleaseResource() and DiscardResource().
+    // The most recently released resource is at the head.
+    std::atomic<StagingNode*> m_StagedStaleResources{nullptr};
+    std::atomic<StagingNode*> m_StagedReleaseQueue{nullptr};
+
+    // Protects the queues below. Only the threads that discard stale resources and purge
+    // the queue take the mutex.
+    mutable std::mutex m_QueuesMtx;
 
-    std::mutex                                                                 m_StaleObjectsMutex;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+    // Both queues are sorted by the command list number and the fence value, respectively.
+    QueueType m_ReleaseQueue;
+    QueueType m_StaleResources;
 };
 
 } // namespace Diligent
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of ShelfAtlasManager class
+
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include "DynamicAtlasManager.hpp"
+
+namespace Diligent
+{
+
+/// Shelf-packing 2D atlas manager
+
+/// The atlas is split into horizontal shelves. The height of every shelf is rounded up to one of
+/// the size classes (1, 2, 3, 4, 6, 8, 12, 16, 24, ...), so that regions of similar height share the
+/// same shelves. Regions are placed left to right in the shelves. When a region is freed, its
+/// space is merged with free neighbors in the same shelf. When all regions in a shelf are freed,
+/// the shelf is released.
+///
+/// All queries take O(log n) time, so the manager is well suited for atlases that contain a large
+/// number of small regions of similar sizes, such as glyphs or thumbnails. DynamicAtlasManager
+/// packs regions of arbitrary sizes more tightly, but its allocation cost grows with the
+/// number of free regions.
+///
+/// The manager uses the same region type as DynamicAtlasManager and is interchangeable with it.
+class ShelfAtlasManager
+{
+public:
+    using Region = DynamicAtlasManager::Region;
+
+    ShelfAtlasManager(Uint32 Width, Uint32 Height);
+    ~ShelfAtlasManager();
+
+    // clang-format off
+    ShelfAtlasManager             (const ShelfAtlasManager&)  = delete;
+    ShelfAtlasManager& operator = (const ShelfAtlasManager&)  = delete;
+    ShelfAtlasManager             (      ShelfAtlasManager&&) = default;
+    ShelfAtlasManager& operator = (      ShelfAtlasManager&&) = delete;
+    // clang-format on
+
+    Region Allocate(Uint32 Width, Uint32 Height);
+    void   Free(Region&& R);
+
+    /// Returns the number of free segments in the shelves plus the number of free
+    /// horizontal bands that are not occupied by shelves.
+    Uint32 GetFreeRegionCount() const
+    {
+        VERIFY_EXPR(m_FreeSegments.size() == m_FreeSegmentsByPosition.size());
+        VERIFY_EXPR(m_FreeBands.size() == m_FreeBandsByHeight.size());
+        return static_cast<Uint32>(m_FreeSegments.size() + m_FreeBands.size());
+    }
+
+    /// Returns the area of the largest free region.
+    Uint64 GetMaxFreeRegionArea() const;
+
+    Uint32 GetWidth() const { return m_Width; }
+    Uint32 GetHeight() const { return m_Height; }
+    Uint64 GetTotalFreeArea() const { return m_TotalFreeArea; }
+    Uint32 GetShelfCount() const { return static_cast<Uint32>(m_Shelves.size()); }
+
+    bool IsEmpty() const
+    {
+        VERIFY_EXPR(m_Shelves.empty() && (m_TotalFreeArea == Uint64{m_Width} * Uint64{m_Height}) ||
+                    !m_Shelves.empty() && (m_TotalFreeArea < Uint64{m_Width} * Uint64{m_Height}));
+        return m_Shelves.empty();
+    }
+
+    /// Returns the height of the shelf that fits a region of the given height.
+    static Uint32 GetShelfHeight(Uint32 Height);
+
+    struct PositionCompare
+    {
+        bool operator()(const Region& R0, const Region& R1) const
+        {
+            return R0.y < R1.y || (R0.y == R1.y && R0.x < R1.x);
+        }
+    };
+
+private:
+    void AddFreeSegment(const Region& R);
+    void RemoveFreeSegment(const Region& R);
+
+    void AddFreeBand(Uint32 y, Uint32 Height);
+    void RemoveFreeBand(Uint32 y, Uint32 Height);
+
+    // Creates a new shelf at least MinHeight high and returns its free segment.
+    Region AddShelf(Uint32 Height, Uint32 MinHeight);
+
+#if DILIGENT_DEBUG
+    void DbgVerifyConsistency() const;
+#endif
+
+    const Uint32 m_Width;
+    const Uint32 m_Height;
+
+    Uint64 m_TotalFreeArea = 0;
+
+    struct Shelf
+    {
+        Uint32 Height         = 0;
+        Uint32 NumAllocations = 0;
+    };
+    // Shelf y -> shelf
+    std::unordered_map<Uint32, Shelf> m_Shelves;
+
+    // Free segments of the shelves ordered by height->width->y->x.
+    // The height of every segment is the height of its shelf.
+    std::set<Region, DynamicAtlasManager::HeightFirstCompare> m_FreeSegments;
+    // Free segments of the shelves ordered by y->x
+    std::set<Region, PositionCompare> m_FreeSegmentsByPosition;
+
+    // Full-width horizontal bands not occupied by shelves: y -> height
+    std::map<Uint32, Uint32> m_FreeBands;
+    // Free bands ordered by height->y
+    std::set<std::pair<Uint32, Uint32>> m_FreeBandsByHeight;
+};
+
+} // namespace Diligent
@@ -0,0 +1,622 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+// Two-level segregated fit (TLSF) free block manager with the same interface as VariableSizeAllocationsManager
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+
+namespace Diligent
+{
+// The class is a drop-in replacement for VariableSizeAllocationsManager that performs Allocate() and Free()
+// in constant time and does not allocate memory in a steady state.
+//
+// Free blocks are segregated into lists by size. The first level splits sizes by powers of two, the second
+// level splits every power-of-two range into 32 linear sub-ranges (sizes less than 64 are mapped exactly).
+// Two bitmaps record which lists are non-empty, so that a list with blocks large enough to accommodate
+// the request is found with two bit scans:
+//
+//      FL bitmap        0 1 1 0 1 ...            SL bitmaps
+//                         | |   |
+//                         | |   '--> [32..63]: 0 0 1 0 ...   --> {Offset, Size} <-> {Offset, Size}
+//                         | '------> [64..127]: ...
+//                         '--------> ...
+//
+// Unlike VariableSizeAllocationsManager, the manager takes the first block from the list whose smallest
+// size is not less than the requested size (good fit rather than best fit), so it may return a larger
+// block than necessary and does not prefer blocks with smaller offsets. Only when there is no such block,
+// the list of the requested size class is searched for a block that fits.
+//
+// Block headers are stored in a side array and are recycled, so the manager never touches the managed
+// memory. To merge the released range with its neighbors, free blocks are also indexed in two open-addressing
+// hash tables by their start and end offsets.
+//
+// The allocations are VariableSizeAllocationsManager::Allocation objects, so users can switch between
+// the two managers by changing the manager type.
+class TLSFAllocationsManager
+{
+public:
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using CreateInfo = VariableSizeAllocationsManager::CreateInfo;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    explicit TLSFAllocationsManager(const CreateInfo& CI)
+        // clang-format off
+        : m_Blocks       {STD_ALLOCATOR_RAW_MEM(FreeBlock, CI.Allocator, "Allocator for vector<FreeBlock>")}
+        , m_BlocksByStart{CI.Allocator}
+        , m_BlocksByEnd  {CI.Allocator}
+#ifdef DILIGENT_DEBUG
+        , m_DbgDisableDebugValidation{CI.DbgDisableDebugValidation}
+#endif
+    // clang-format on
+    {
+        for (auto& Lists : m_FreeLists)
+            Lists.fill(Uint32{InvalidIndex});
+        m_SLBitmaps.fill(0);
+
+        Extend(CI.MaxSize);
+    }
+
+    TLSFAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        TLSFAllocationsManager{CreateInfo{Allocator, MaxSize}}
+    {}
+
+    ~TLSFAllocationsManager()
+    {
+#ifdef DILIGENT_DEBUG
+        if (m_NumFreeBlocks != 0)
+        {
+            VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+            const auto HeadIdx = m_BlocksByStart.Find(0);
+            VERIFY(HeadIdx != InvalidIndex, "Head chunk offset is expected to be 0");
+            if (HeadIdx != InvalidIndex)
+                VERIFY(m_Blocks[HeadIdx].Size == m_MaxSize, "Head chunk size is expected to be ", m_MaxSize);
+        }
+#endif
+    }
+
+    // clang-format off
+    TLSFAllocationsManager(TLSFAllocationsManager&& rhs) noexcept
+        : m_Blocks          {std::move(rhs.m_Blocks)       }
+        , m_BlocksByStart   {std::move(rhs.m_BlocksByStart)}
+        , m_BlocksByEnd     {std::move(rhs.m_BlocksByEnd)  }
+        , m_FreeLists       {rhs.m_FreeLists       }
+        , m_SLBitmaps       {rhs.m_SLBitmaps       }
+        , m_FLBitmap        {rhs.m_FLBitmap        }
+        , m_FirstUnusedBlock{rhs.m_FirstUnusedBlock}
+        , m_NumFreeBlocks   {rhs.m_NumFreeBlocks   }
+        , m_MaxSize         {rhs.m_MaxSize         }
+        , m_FreeSize        {rhs.m_FreeSize        }
+#ifdef DILIGENT_DEBUG
+        , m_DbgDisableDebugValidation{rhs.m_DbgDisableDebugValidation}
+#endif
+    {
+        // clang-format on
+        rhs.m_FLBitmap         = 0;
+        rhs.m_FirstUnusedBlock = InvalidIndex;
+        rhs.m_NumFreeBlocks    = 0;
+        rhs.m_MaxSize          = 0;
+        rhs.m_FreeSize         = 0;
+    }
+
+    // clang-format off
+    TLSFAllocationsManager& operator = (      TLSFAllocationsManager&&) = delete;
+    TLSFAllocationsManager             (const TLSFAllocationsManager&)  = delete;
+    TLSFAllocationsManager& operator = (const TLSFAllocationsManager&)  = delete;
+    // clang-format on
+
+    // As with VariableSizeAllocationsManager, the offset returned by Allocate() may not be aligned,
+    // but the size of the allocation is sufficient to properly align it.
+    Allocation Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
+
+        // All blocks in the list found for Size are large enough, but the first one may need padding.
+        // If it does not fit, look for a list where every block can accommodate the worst-case padding.
+        Uint32 BlockIdx = FindFreeBlock(Size);
+        if (BlockIdx != InvalidIndex && !BlockFits(BlockIdx, Size, Alignment))
+            BlockIdx = FindFreeBlock(Size + (Alignment - 1));
+        // The lists above only contain blocks that are larger than the size class of the request,
+        // so a block that fits exactly (e.g. the whole range) may only be found in the request's own list.
+        if (BlockIdx == InvalidIndex)
+            BlockIdx = FindFittingBlockInSizeClass(Size, Alignment);
+        if (BlockIdx == InvalidIndex)
+            return Allocation::InvalidAllocation();
+
+        const auto BlockOffset = m_Blocks[BlockIdx].Offset;
+        const auto BlockSize   = m_Blocks[BlockIdx].Size;
+        RemoveFreeBlock(BlockIdx);
+
+        //     BlockOffset
+        //        |                                        |
+        //        |<---------------BlockSize-------------->|
+        //        |<-Padding->|<------Size------>|<-Tail-->|
+        //                    |
+        //              AlignedOffset
+        //
+        const auto AlignedOffset = AlignUp(BlockOffset, Alignment);
+        const auto Padding       = AlignedOffset - BlockOffset;
+        const auto TailSize      = BlockSize - Padding - Size;
+        VERIFY_EXPR(Padding + Size <= BlockSize);
+        // The padding is returned to the free lists rather than included in the allocation
+        if (Padding > 0)
+            AddFreeBlock(BlockOffset, Padding);
+        if (TailSize > 0)
+            AddFreeBlock(AlignedOffset + Size, TailSize);
+
+        m_FreeSize -= Size;
+
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+        return Allocation{AlignedOffset, Size};
+    }
+
+    void Free(Allocation&& allocation)
+    {
+        VERIFY_EXPR(allocation.IsValid());
+        Free(allocation.UnalignedOffset, allocation.Size);
+        allocation = Allocation{};
+    }
+
+    void Free(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Offset != Allocation::InvalidOffset && Offset + Size <= m_MaxSize);
+        VERIFY(m_BlocksByStart.Find(Offset) == InvalidIndex && m_BlocksByEnd.Find(Offset + Size) == InvalidIndex,
+               "Block being deallocated overlaps with a free block");
+
+        auto NewOffset = Offset;
+        auto NewSize   = Size;
+
+        //   PrevBlock.Offset             Offset                NextBlock.Offset
+        //       |                          |                        |
+        //       |<-----PrevBlock.Size----->|<------Size-------->|<-----NextBlock.Size----->|
+        //
+        const auto PrevBlockIdx = m_BlocksByEnd.Find(Offset);
+        if (PrevBlockIdx != InvalidIndex)
+        {
+            NewOffset = m_Blocks[PrevBlockIdx].Offset;
+            NewSize += m_Blocks[PrevBlockIdx].Size;
+            RemoveFreeBlock(PrevBlockIdx);
+        }
+
+        const auto NextBlockIdx = m_BlocksByStart.Find(Offset + Size);
+        if (NextBlockIdx != InvalidIndex)
+        {
+            NewSize += m_Blocks[NextBlockIdx].Size;
+            RemoveFreeBlock(NextBlockIdx);
+        }
+
+        AddFreeBlock(NewOffset, NewSize);
+
+        m_FreeSize += Size;
+
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+    }
+
+    // clang-format off
+    bool IsFull() const{ return m_FreeSize==0; };
+    bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+    OffsetType GetMaxSize() const{return m_MaxSize;}
+    OffsetType GetFreeSize()const{return m_FreeSize;}
+    OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+    // clang-format on
+
+    size_t GetNumFreeBlocks() const
+    {
+        return m_NumFreeBlocks;
+    }
+
+    OffsetType GetMaxFreeBlockSize() const
+    {
+        if (m_FLBitmap == 0)
+            return 0;
+
+        // The largest block is in the last non-empty list
+        const auto FL = PlatformMisc::GetMSB(m_FLBitmap);
+        const auto SL = PlatformMisc::GetMSB(m_SLBitmaps[FL]);
+
+        OffsetType MaxSize = 0;
+        for (auto BlockIdx = m_FreeLists[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+            MaxSize = (std::max)(MaxSize, m_Blocks[BlockIdx].Size);
+        return MaxSize;
+    }
+
+    void Extend(size_t ExtraSize)
+    {
+        if (ExtraSize == 0)
+            return;
+
+        auto NewBlockOffset = m_MaxSize;
+        auto NewBlockSize   = ExtraSize;
+
+        const auto LastBlockIdx = m_BlocksByEnd.Find(m_MaxSize);
+        if (LastBlockIdx != InvalidIndex)
+        {
+            // Extend the last block
+            NewBlockOffset = m_Blocks[LastBlockIdx].Offset;
+            NewBlockSize += m_Blocks[LastBlockIdx].Size;
+            RemoveFreeBlock(LastBlockIdx);
+        }
+
+        AddFreeBlock(NewBlockOffset, NewBlockSize);
+
+        m_MaxSize += ExtraSize;
+        m_FreeSize += ExtraSize;
+
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+    }
+
+private:
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    static constexpr Uint32 SLIndexCountLog2 = 5;
+    static constexpr Uint32 SLIndexCount     = 1u << SLIndexCountLog2;
+    // Sizes less than SmallBlockSize are mapped to the first level 0 with the granularity of 1
+    static constexpr Uint32 FLIndexShift   = SLIndexCountLog2;
+    static constexpr Uint32 SmallBlockSize = 1u << FLIndexShift;
+    static constexpr Uint32 FLIndexCount   = sizeof(OffsetType) * 8 - FLIndexShift + 1;
+    static_assert(FLIndexCount <= 64, "First-level bitmap is too small");
+
+    struct FreeBlock
+    {
+        OffsetType Offset = 0;
+        OffsetType Size   = 0;
+
+        // Links in the free list. For unused headers, NextFree links the list of unused headers.
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+    };
+
+    // Open-addressing hash table with linear probing that maps offsets to block indices
+    class BlockIndexMap
+    {
+    public:
+        explicit BlockIndexMap(IMemoryAllocator& Allocator) :
+            m_Slots{STD_ALLOCATOR_RAW_MEM(Slot, Allocator, "Allocator for vector<Slot>")}
+        {}
+
+        // clang-format off
+        BlockIndexMap           (BlockIndexMap&&)      = default;
+        BlockIndexMap           (const BlockIndexMap&) = delete;
+        BlockIndexMap& operator=(const BlockIndexMap&) = delete;
+        BlockIndexMap& operator=(BlockIndexMap&&)      = delete;
+        // clang-format on
+
+        Uint32 Find(OffsetType Key) const
+        {
+            if (m_Slots.empty())
+                return InvalidIndex;
+
+            for (size_t i = Hash(Key);; i = (i + 1) & m_Mask)
+            {
+                const auto& Slot = m_Slots[i];
+                if (Slot.Index == InvalidIndex || Slot.Key == Key)
+                    return Slot.Index;
+            }
+        }
+
+        void Insert(OffsetType Key, Uint32 Index)
+        {
+            VERIFY_EXPR(Index != InvalidIndex);
+            // Keep the load factor at or below 1/2
+            if ((m_Count + 1) * 2 > m_Slots.size())
+                Rehash((std::max)(m_Slots.size() * 2, size_t{16}));
+
+            size_t i = Hash(Key);
+            while (m_Slots[i].Index != InvalidIndex)
+            {
+                VERIFY(m_Slots[i].Key != Key, "Key ", Key, " is already in the map");
+                i = (i + 1) & m_Mask;
+            }
+            m_Slots[i] = Slot{Key, Index};
+            ++m_Count;
+        }
+
+        void Erase(OffsetType Key)
+        {
+            VERIFY_EXPR(!m_Slots.empty());
+
+            size_t i = Hash(Key);
+            while (m_Slots[i].Key != Key || m_Slots[i].Index == InvalidIndex)
+            {
+                VERIFY(m_Slots[i].Index != InvalidIndex, "Key ", Key, " is not found in the map");
+                i = (i + 1) & m_Mask;
+            }
+
+            // Shift back the following entries of the probe sequence so that no tombstones are needed
+            for (size_t j = i;;)
+            {
+                j = (j + 1) & m_Mask;
+                if (m_Slots[j].Index == InvalidIndex)
+                    break;
+
+                // The entry can be moved to slot i only if its home slot k is not in the cyclic range (i, j]
+                const size_t k = Hash(m_Slots[j].Key);
+                if (i < j ? (k <= i || k > j) : (k <= i && k > j))
+                {
+                    m_Slots[i] = m_Slots[j];
+                    i          = j;
+                }
+            }
+            m_Slots[i].Index = InvalidIndex;
+            --m_Count;
+        }
+
+        size_t GetCount() const { return m_Count; }
+
+    private:
+        struct Slot
+        {
+            OffsetType Key   = 0;
+            Uint32     Index = InvalidIndex;
+        };
+
+        size_t Hash(OffsetType Key) const
+        {
+            // Fibonacci hashing spreads aligned offsets over the table
+            return static_cast<size_t>((static_cast<Uint64>(Key) * Uint64{0x9E3779B97F4A7C15}) >> m_Shift);
+        }
+
+        void Rehash(size_t NewSize)
+        {
+            VERIFY_EXPR(IsPowerOfTwo(NewSize));
+            std::vector<Slot, STDAllocatorRawMem<Slot>> OldSlots{NewSize, Slot{}, m_Slots.get_allocator()};
+            std::swap(OldSlots, m_Slots);
+            m_Mask  = NewSize - 1;
+            m_Shift = 64 - PlatformMisc::GetMSB(Uint64{NewSize});
+            m_Count = 0;
+            for (const auto& Slot : OldSlots)
+            {
+                if (Slot.Index != InvalidIndex)
+                    Insert(Slot.Key, Slot.Index);
+            }
+        }
+
+        std::vector<Slot, STDAllocatorRawMem<Slot>> m_Slots;
+
+        size_t m_Mask  = 0;
+        size_t m_Count = 0;
+        Uint32 m_Shift = 64;
+    };
+
+    static void MapSize(OffsetType Size, Uint32& FL, Uint32& SL)
+    {
+        if (Size < SmallBlockSize)
+        {
+            FL = 0;
+            SL = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+            SL             = static_cast<Uint32>(Size >> (MSB - SLIndexCountLog2)) ^ SLIndexCount;
+            FL             = MSB - (FLIndexShift - 1);
+        }
+        VERIFY_EXPR(FL < FLIndexCount && SL < SLIndexCount);
+    }
+
+    // Returns the index of a free block that is at least Size bytes large, or InvalidIndex
+    Uint32 FindFreeBlock(OffsetType Size) const
+    {
+        if (Size >= SmallBlockSize)
+        {
+            // Round the size up to the next list boundary so that every block in the list is large enough
+            const auto Round = (OffsetType{1} << (PlatformMisc::GetMSB(static_cast<Uint64>(Size)) - SLIndexCountLog2)) - 1;
+            if (Size > ~OffsetType{0} - Round)
+                return InvalidIndex;
+            Size += Round;
+        }
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Size, FL, SL);
+
+        auto SLMap = m_SLBitmaps[FL] & (~0u << SL);
+        if (SLMap == 0)
+        {
+            const auto FLMap = m_FLBitmap & (~Uint64{0} << (FL + 1));
+            if (FLMap == 0)
+                return InvalidIndex;
+
+            FL    = PlatformMisc::GetLSB(FLMap);
+            SLMap = m_SLBitmaps[FL];
+            VERIFY_EXPR(SLMap != 0);
+        }
+        SL = PlatformMisc::GetLSB(SLMap);
+
+        VERIFY_EXPR(m_FreeLists[FL][SL] != InvalidIndex);
+        return m_FreeLists[FL][SL];
+    }
+
+    bool BlockFits(Uint32 BlockIdx, OffsetType Size, OffsetType Alignment) const
+    {
+        const auto& Block = m_Blocks[BlockIdx];
+        return (AlignUp(Block.Offset, Alignment) - Block.Offset) + Size <= Block.Size;
+    }
+
+    // Searches the list that contains blocks of the same size class as Size for a block
+    // that can accommodate the aligned request. Returns InvalidIndex if there is none.
+    Uint32 FindFittingBlockInSizeClass(OffsetType Size, OffsetType Alignment) const
+    {
+        Uint32 FL = 0, SL = 0;
+        MapSize(Size, FL, SL);
+        for (auto BlockIdx = m_FreeLists[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+        {
+            if (BlockFits(BlockIdx, Size, Alignment))
+                return BlockIdx;
+        }
+        return InvalidIndex;
+    }
+
+    void AddFreeBlock(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Size > 0);
+
+        Uint32 BlockIdx = m_FirstUnusedBlock;
+        if (BlockIdx != InvalidIndex)
+        {
+            m_FirstUnusedBlock = m_Blocks[BlockIdx].NextFree;
+        }
+        else
+        {
+            BlockIdx = static_cast<Uint32>(m_Blocks.size());
+            m_Blocks.emplace_back();
+        }
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Size, FL, SL);
+
+        auto& Block    = m_Blocks[BlockIdx];
+        Block.Offset   = Offset;
+        Block.Size     = Size;
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = m_FreeLists[FL][SL];
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = BlockIdx;
+        m_FreeLists[FL][SL] = BlockIdx;
+
+        m_FLBitmap |= Uint64{1} << FL;
+        m_SLBitmaps[FL] |= 1u << SL;
+
+        m_BlocksByStart.Insert(Offset, BlockIdx);
+        m_BlocksByEnd.Insert(Offset + Size, BlockIdx);
+        ++m_NumFreeBlocks;
+    }
+
+    void RemoveFreeBlock(Uint32 BlockIdx)
+    {
+        auto& Block = m_Blocks[BlockIdx];
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Block.Size, FL, SL);
+
+        if (Block.PrevFree != InvalidIndex)
+        {
+            m_Blocks[Block.PrevFree].NextFree = Block.NextFree;
+        }
+        else
+        {
+            VERIFY_EXPR(m_FreeLists[FL][SL] == BlockIdx);
+            m_FreeLists[FL][SL] = Block.NextFree;
+            if (Block.NextFree == InvalidIndex)
+            {
+                m_SLBitmaps[FL] &= ~(1u << SL);
+                if (m_SLBitmaps[FL] == 0)
+                    m_FLBitmap &= ~(Uint64{1} << FL);
+            }
+        }
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+
+        m_BlocksByStart.Erase(Block.Offset);
+        m_BlocksByEnd.Erase(Block.Offset + Block.Size);
+        VERIFY_EXPR(m_NumFreeBlocks > 0);
+        --m_NumFreeBlocks;
+
+        Block              = FreeBlock{};
+        Block.NextFree     = m_FirstUnusedBlock;
+        m_FirstUnusedBlock = BlockIdx;
+    }
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerifyList() const
+    {
+        OffsetType TotalFreeSize = 0;
+        size_t     NumBlocks     = 0;
+        for (Uint32 FL = 0; FL < FLIndexCount; ++FL)
+        {
+            VERIFY(((m_FLBitmap >> FL) & 1) == (m_SLBitmaps[FL] != 0 ? 1 : 0), "First-level bitmap is inconsistent with second-level bitmap ", FL);
+            for (Uint32 SL = 0; SL < SLIndexCount; ++SL)
+            {
+                const auto HeadIdx = m_FreeLists[FL][SL];
+                VERIFY(((m_SLBitmaps[FL] >> SL) & 1) == (HeadIdx != InvalidIndex ? 1u : 0u), "Second-level bitmap is inconsistent with free list [", FL, "][", SL, "]");
+
+                Uint32 PrevIdx = InvalidIndex;
+                for (auto BlockIdx = HeadIdx; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                {
+                    const auto& Block = m_Blocks[BlockIdx];
+                    VERIFY_EXPR(Block.Size > 0 && Block.Offset + Block.Size <= m_MaxSize);
+                    VERIFY_EXPR(Block.PrevFree == PrevIdx);
+
+                    Uint32 BlockFL = 0, BlockSL = 0;
+                    MapSize(Block.Size, BlockFL, BlockSL);
+                    VERIFY(BlockFL == FL && BlockSL == SL, "Block of size ", Block.Size, " is in the wrong list");
+
+                    VERIFY_EXPR(m_BlocksByStart.Find(Block.Offset) == BlockIdx);
+                    VERIFY_EXPR(m_BlocksByEnd.Find(Block.Offset + Block.Size) == BlockIdx);
+                    VERIFY(m_BlocksByEnd.Find(Block.Offset) == InvalidIndex, "Unmerged adjacent blocks detected");
+
+                    TotalFreeSize += Block.Size;
+                    ++NumBlocks;
+                    PrevIdx = BlockIdx;
+                }
+            }
+        }
+
+        VERIFY_EXPR(NumBlocks == m_NumFreeBlocks);
+        VERIFY_EXPR(m_BlocksByStart.GetCount() == m_NumFreeBlocks && m_BlocksByEnd.GetCount() == m_NumFreeBlocks);
+        VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+    }
+#endif
+
+    // Free block headers; headers of merged and allocated blocks are recycled
+    std::vector<FreeBlock, STDAllocatorRawMem<FreeBlock>> m_Blocks;
+
+    BlockIndexMap m_BlocksByStart;
+    BlockIndexMap m_BlocksByEnd;
+
+    std::array<std::array<Uint32, SLIndexCount>, FLIndexCount> m_FreeLists;
+    std::array<Uint32, FLIndexCount>                           m_SLBitmaps;
+
+    Uint64 m_FLBitmap = 0;
+
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    size_t m_NumFreeBlocks    = 0;
+
+    OffsetType m_MaxSize  = 0;
+    OffsetType m_FreeSize = 0;
+#ifdef DILIGENT_DEBUG
+    bool m_DbgDisableDebugValidation = false;
+#endif
+    // When adding new members, do not forget to update move ctor
+};
+} // namespace Diligent
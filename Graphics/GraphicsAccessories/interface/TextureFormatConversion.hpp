@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Bulk texel conversion between uncompressed texture formats
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Converts a 32-bit floating-point value to a 16-bit half-precision value, rounding to the nearest even.
+/// Values that are too large to be represented are converted to infinity.
+Uint16 FloatToHalf(float f);
+
+/// Converts a 16-bit half-precision value to a 32-bit floating-point value.
+float HalfToFloat(Uint16 h);
+
+/// Packs the color into the TEX_FORMAT_R11G11B10_FLOAT format.
+///
+/// \remarks    Negative values are converted to zero, and values that are too large to be
+///             represented are clamped to the largest representable value.
+Uint32 PackR11G11B10F(const float3& RGB);
+
+/// Unpacks the color stored in the TEX_FORMAT_R11G11B10_FLOAT format.
+float3 UnpackR11G11B10F(Uint32 Packed);
+
+/// Packs the color into the TEX_FORMAT_RGB9E5_SHAREDEXP format.
+///
+/// \remarks    The components are clamped to [0, 65408].
+Uint32 PackRGB9E5(const float3& RGB);
+
+/// Unpacks the color stored in the TEX_FORMAT_RGB9E5_SHAREDEXP format.
+float3 UnpackRGB9E5(Uint32 Packed);
+
+
+/// Returns true if ConvertTexels() supports the conversion from SrcFormat to DstFormat.
+///
+/// The following formats are supported:
+/// - TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB
+/// - TEX_FORMAT_BGRA8_UNORM, TEX_FORMAT_BGRA8_UNORM_SRGB
+/// - TEX_FORMAT_RGBA16_FLOAT
+/// - TEX_FORMAT_RGBA32_FLOAT, TEX_FORMAT_RGB32_FLOAT
+/// - TEX_FORMAT_R11G11B10_FLOAT
+/// - TEX_FORMAT_RGB9E5_SHAREDEXP
+bool IsTexelConversionSupported(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat);
+
+/// Converts the texels from one format to another.
+///
+/// \param [in]  SrcFormat - Source format.
+/// \param [in]  pSrc      - Source texels.
+/// \param [in]  DstFormat - Destination format.
+/// \param [out] pDst      - Destination texels. The source and destination must not overlap.
+/// \param [in]  NumTexels - The number of texels to convert.
+///
+/// \return     true if the texels have been converted, and false if the conversion is not supported.
+///
+/// \remarks    The conversion preserves the values that a shader would read from the texture:
+///             the sRGB-encoded channels are converted to linear space and back, missing
+///             alpha channel is set to one, and the values that can't be represented are
+///             clamped. Conversions between the 8-bit formats, e.g. a BGRA to RGBA swizzle,
+///             as well as conversions to and from the floating-point formats use SSE2 or NEON
+///             where available.
+bool ConvertTexels(TEXTURE_FORMAT SrcFormat,
+                   const void*    pSrc,
+                   TEXTURE_FORMAT DstFormat,
+                   void*          pDst,
+                   size_t         NumTexels);
+
+/// Attributes of the ConvertTextureData function.
+struct ConvertTextureDataAttribs
+{
+    /// Surface width, in texels.
+    Uint32 Width = 0;
+
+    /// Surface height, in texels.
+    Uint32 Height = 0;
+
+    /// Source format.
+    TEXTURE_FORMAT SrcFormat = TEX_FORMAT_UNKNOWN;
+
+    /// Source data.
+    const void* pSrcData = nullptr;
+
+    /// Source row stride, in bytes.
+    size_t SrcStride = 0;
+
+    /// Destination format.
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// Destination data.
+    void* pDstData = nullptr;
+
+    /// Destination row stride, in bytes.
+    size_t DstStride = 0;
+};
+
+/// Converts a 2D surface from one format to another, see ConvertTexels().
+bool ConvertTextureData(const ConvertTextureDataAttribs& Attribs);
+
+/// Expands 3-channel 8-bit texels to 4 channels.
+///
+/// \param [in]  pSrc      - Source RGB texels.
+/// \param [out] pDst      - Destination RGBA texels. The source and destination must not overlap.
+/// \param [in]  NumTexels - The number of texels to expand.
+/// \param [in]  Alpha     - The value of the alpha channel.
+void ExpandRGB8ToRGBA8(const Uint8* pSrc, Uint8* pDst, size_t NumTexels, Uint8 Alpha = 255);
+
+} // namespace Diligent
@@ -28,6 +28,7 @@
 #include "DynamicAtlasManager.hpp"
 
 #include <climits>
+#include <algorithm>
 
 #include "AdvancedMath.hpp"
 
@@ -370,6 +371,15 @@ void DynamicAtlasManager::Free(Region&& R)
 }
 
 
+Uint64 DynamicAtlasManager::GetMaxFreeRegionArea() const
+{
+    Uint64 MaxArea = 0;
+    for (const auto& it : m_FreeRegionsByWidth)
+        MaxArea = std::max(MaxArea, Uint64{it.first.width} * Uint64{it.first.height});
+    return MaxArea;
+}
+
+
 #if DILIGENT_DEBUG
 
 void DynamicAtlasManager::DbgVerifyRegion(const Region& R) const
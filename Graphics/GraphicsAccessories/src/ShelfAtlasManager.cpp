@@ -0,0 +1,312 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShelfAtlasManager.hpp"
+
+#include <climits>
+#include <algorithm>
+
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+static const ShelfAtlasManager::Region InvalidRegion{UINT_MAX, UINT_MAX, 0, 0};
+
+ShelfAtlasManager::ShelfAtlasManager(Uint32 Width, Uint32 Height) :
+    m_Width{Width},
+    m_Height{Height},
+    m_TotalFreeArea{Uint64{Width} * Uint64{Height}}
+{
+    AddFreeBand(0, m_Height);
+}
+
+ShelfAtlasManager::~ShelfAtlasManager()
+{
+    if (m_Width != 0 && m_Height != 0)
+    {
+        VERIFY(m_Shelves.empty(), "Not all allocations have been released");
+    }
+}
+
+Uint32 ShelfAtlasManager::GetShelfHeight(Uint32 Height)
+{
+    if (Height <= 2)
+        return Height;
+
+    // Size classes are powers of two and their 1.5x multiples: 3, 4, 6, 8, 12, 16, 24, ...
+    // This limits the space wasted in a shelf to 1/3 of its height.
+    const Uint32 Pow2 = 1u << PlatformMisc::GetMSB(Height - 1);
+    return Pow2 + Pow2 / 2 >= Height ? Pow2 + Pow2 / 2 : Pow2 * 2;
+}
+
+void ShelfAtlasManager::AddFreeSegment(const Region& R)
+{
+    VERIFY_EXPR(!R.IsEmpty());
+    VERIFY(m_FreeSegments.find(R) == m_FreeSegments.end(), "Segment is already present in the free segments set");
+    m_FreeSegments.insert(R);
+    m_FreeSegmentsByPosition.insert(R);
+}
+
+void ShelfAtlasManager::RemoveFreeSegment(const Region& R)
+{
+    VERIFY(m_FreeSegments.find(R) != m_FreeSegments.end(), "Segment is not found in the free segments set");
+    m_FreeSegments.erase(R);
+    m_FreeSegmentsByPosition.erase(R);
+}
+
+void ShelfAtlasManager::AddFreeBand(Uint32 y, Uint32 Height)
+{
+    VERIFY_EXPR(Height > 0);
+
+    // Merge with the adjacent bands
+    auto next_it = m_FreeBands.lower_bound(y);
+    if (next_it != m_FreeBands.end() && next_it->first == y + Height)
+    {
+        Height += next_it->second;
+        m_FreeBandsByHeight.erase(std::make_pair(next_it->second, next_it->first));
+        next_it = m_FreeBands.erase(next_it);
+    }
+    if (next_it != m_FreeBands.begin())
+    {
+        auto prev_it = std::prev(next_it);
+        if (prev_it->first + prev_it->second == y)
+        {
+            y = prev_it->first;
+            Height += prev_it->second;
+            m_FreeBandsByHeight.erase(std::make_pair(prev_it->second, prev_it->first));
+            m_FreeBands.erase(prev_it);
+        }
+    }
+
+    m_FreeBands.emplace(y, Height);
+    m_FreeBandsByHeight.emplace(Height, y);
+}
+
+void ShelfAtlasManager::RemoveFreeBand(Uint32 y, Uint32 Height)
+{
+    VERIFY_EXPR(m_FreeBands.find(y) != m_FreeBands.end() && m_FreeBands.find(y)->second == Height);
+    m_FreeBands.erase(y);
+    m_FreeBandsByHeight.erase(std::make_pair(Height, y));
+}
+
+ShelfAtlasManager::Region ShelfAtlasManager::AddShelf(Uint32 Height, Uint32 MinHeight)
+{
+    // Find the smallest band that fits the shelf
+    auto band_it = m_FreeBandsByHeight.lower_bound(std::make_pair(Height, Uint32{0}));
+    if (band_it == m_FreeBandsByHeight.end())
+    {
+        // There is no band large enough for the full shelf. Use the largest band that fits
+        // the region: it is smaller than Height, so the waste is lower anyway.
+        if (m_FreeBandsByHeight.empty() || m_FreeBandsByHeight.rbegin()->first < MinHeight)
+            return Region{};
+        band_it = std::prev(m_FreeBandsByHeight.end());
+        Height  = band_it->first;
+    }
+
+    const Uint32 BandY      = band_it->second;
+    const Uint32 BandHeight = band_it->first;
+    RemoveFreeBand(BandY, BandHeight);
+    if (BandHeight > Height)
+        AddFreeBand(BandY + Height, BandHeight - Height);
+
+    VERIFY_EXPR(m_Shelves.find(BandY) == m_Shelves.end());
+    m_Shelves.emplace(BandY, Shelf{Height, 0});
+
+    Region Segment{0, BandY, m_Width, Height};
+    AddFreeSegment(Segment);
+    return Segment;
+}
+
+ShelfAtlasManager::Region ShelfAtlasManager::Allocate(Uint32 Width, Uint32 Height)
+{
+    if (Width == 0 || Height == 0 || Width > m_Width || Height > m_Height)
+        return Region{};
+
+    const Uint32 ShelfHeight = std::min(GetShelfHeight(Height), m_Height);
+
+    // Find the narrowest free segment in the shelves of the same size class
+    auto seg_it = m_FreeSegments.lower_bound(Region{0, 0, Width, ShelfHeight});
+
+    Region Segment;
+    if (seg_it != m_FreeSegments.end() && seg_it->height == ShelfHeight)
+    {
+        VERIFY_EXPR(seg_it->width >= Width);
+        Segment = *seg_it;
+    }
+    else
+    {
+        Segment = AddShelf(ShelfHeight, Height);
+        if (Segment.IsEmpty())
+        {
+            // Try the shelves of other size classes that are tall enough
+            seg_it = m_FreeSegments.lower_bound(Region{0, 0, Width, Height});
+            while (seg_it != m_FreeSegments.end() && seg_it->width < Width)
+            {
+                // Skip to the next shelf height
+                seg_it = m_FreeSegments.lower_bound(Region{0, 0, Width, seg_it->height});
+            }
+            if (seg_it == m_FreeSegments.end())
+                return Region{};
+
+            Segment = *seg_it;
+        }
+    }
+    VERIFY_EXPR(Segment.width >= Width && Segment.height >= Height);
+
+    RemoveFreeSegment(Segment);
+    if (Segment.width > Width)
+        AddFreeSegment(Region{Segment.x + Width, Segment.y, Segment.width - Width, Segment.height});
+
+    auto shelf_it = m_Shelves.find(Segment.y);
+    VERIFY_EXPR(shelf_it != m_Shelves.end() && shelf_it->second.Height == Segment.height);
+    ++shelf_it->second.NumAllocations;
+
+    VERIFY_EXPR(m_TotalFreeArea >= Uint64{Width} * Uint64{Height});
+    m_TotalFreeArea -= Uint64{Width} * Uint64{Height};
+
+#if DILIGENT_DEBUG
+    DbgVerifyConsistency();
+#endif
+
+    return Region{Segment.x, Segment.y, Width, Height};
+}
+
+void ShelfAtlasManager::Free(Region&& R)
+{
+    VERIFY_EXPR(R != InvalidRegion && !R.IsEmpty());
+    VERIFY(R.x + R.width <= m_Width && R.y + R.height <= m_Height,
+           "Region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, ") exceeds atlas dimensions ", m_Width, " x ", m_Height);
+
+    auto shelf_it = m_Shelves.find(R.y);
+    if (shelf_it == m_Shelves.end() || shelf_it->second.Height < R.height)
+    {
+        UNEXPECTED("Unable to find the shelf of region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, "). Have you ever allocated it?");
+        return;
+    }
+    auto& ShelfInfo = shelf_it->second;
+    VERIFY_EXPR(ShelfInfo.NumAllocations > 0);
+
+    Region Segment{R.x, R.y, R.width, ShelfInfo.Height};
+
+    // Merge with the free neighbors in the same shelf
+    auto next_it = m_FreeSegmentsByPosition.lower_bound(Segment);
+    VERIFY(next_it == m_FreeSegmentsByPosition.end() || next_it->y != R.y || next_it->x >= R.x + R.width,
+           "Region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, ") overlaps with a free segment. Is it a double free?");
+    if (next_it != m_FreeSegmentsByPosition.begin())
+    {
+        const Region& Prev = *std::prev(next_it);
+        VERIFY(Prev.y != R.y || Prev.x + Prev.width <= R.x,
+               "Region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, ") overlaps with a free segment. Is it a double free?");
+        if (Prev.y == R.y && Prev.x + Prev.width == R.x)
+        {
+            Segment.x = Prev.x;
+            Segment.width += Prev.width;
+            RemoveFreeSegment(Region{Prev});
+        }
+    }
+    if (next_it != m_FreeSegmentsByPosition.end() && next_it->y == R.y && next_it->x == R.x + R.width)
+    {
+        Segment.width += next_it->width;
+        RemoveFreeSegment(Region{*next_it});
+    }
+
+    if (--ShelfInfo.NumAllocations == 0)
+    {
+        // Release the empty shelf
+        VERIFY_EXPR(Segment.x == 0 && Segment.width == m_Width);
+        AddFreeBand(R.y, ShelfInfo.Height);
+        m_Shelves.erase(shelf_it);
+    }
+    else
+    {
+        AddFreeSegment(Segment);
+    }
+
+    m_TotalFreeArea += Uint64{R.width} * Uint64{R.height};
+
+#if DILIGENT_DEBUG
+    DbgVerifyConsistency();
+#endif
+
+    R = InvalidRegion;
+}
+
+Uint64 ShelfAtlasManager::GetMaxFreeRegionArea() const
+{
+    Uint64 MaxArea = 0;
+    for (const auto& Segment : m_FreeSegments)
+        MaxArea = std::max(MaxArea, Uint64{Segment.width} * Uint64{Segment.height});
+    if (!m_FreeBandsByHeight.empty())
+        MaxArea = std::max(MaxArea, Uint64{m_Width} * Uint64{m_FreeBandsByHeight.rbegin()->first});
+    return MaxArea;
+}
+
+#if DILIGENT_DEBUG
+void ShelfAtlasManager::DbgVerifyConsistency() const
+{
+    VERIFY_EXPR(m_FreeSegments.size() == m_FreeSegmentsByPosition.size());
+    VERIFY_EXPR(m_FreeBands.size() == m_FreeBandsByHeight.size());
+
+    Uint32 TotalHeight = 0;
+    for (const auto& Band : m_FreeBands)
+    {
+        VERIFY(m_FreeBandsByHeight.find(std::make_pair(Band.second, Band.first)) != m_FreeBandsByHeight.end(), "Band is not found in the bands-by-height set");
+        VERIFY(m_Shelves.find(Band.first) == m_Shelves.end(), "Band overlaps with a shelf");
+        TotalHeight += Band.second;
+    }
+
+    Uint64 AllocatedShelfArea = 0;
+    for (const auto& it : m_Shelves)
+    {
+        VERIFY_EXPR(it.second.NumAllocations > 0);
+        TotalHeight += it.second.Height;
+        AllocatedShelfArea += Uint64{m_Width} * Uint64{it.second.Height};
+    }
+    VERIFY(TotalHeight == m_Height, "Bands and shelves do not cover the entire atlas");
+
+    const Region* pPrev = nullptr;
+    for (const auto& Segment : m_FreeSegmentsByPosition)
+    {
+        VERIFY(m_FreeSegments.find(Segment) != m_FreeSegments.end(), "Segment is not found in the free segments set");
+        auto shelf_it = m_Shelves.find(Segment.y);
+        VERIFY(shelf_it != m_Shelves.end(), "Free segment does not belong to any shelf");
+        VERIFY(shelf_it->second.Height == Segment.height, "Free segment height does not match the shelf height");
+        VERIFY(Segment.x + Segment.width <= m_Width, "Free segment exceeds atlas width");
+        if (pPrev != nullptr && pPrev->y == Segment.y)
+            VERIFY(pPrev->x + pPrev->width < Segment.x, "Free segments overlap or are not merged");
+        AllocatedShelfArea -= Uint64{Segment.width} * Uint64{Segment.height};
+        pPrev = &Segment;
+    }
+
+    // AllocatedShelfArea is now the area of the shelves occupied by allocations, which
+    // includes the space wasted above the regions that are lower than their shelves.
+    VERIFY(Uint64{m_Width} * Uint64{m_Height} - m_TotalFreeArea <= AllocatedShelfArea, "Allocated area exceeds the occupied shelf area");
+}
+#endif
+
+} // namespace Diligent
@@ -0,0 +1,829 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TextureFormatConversion.hpp"
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "DebugUtilities.hpp"
+#include "Intrinsics.hpp"
+
+#if DILIGENT_NEON_ENABLED && defined(__aarch64__)
+#    define DILIGENT_NEON_FP16_ENABLED 1
+#endif
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline Uint32 FloatBits(float f)
+{
+    Uint32 u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+inline float BitsToFloat(Uint32 u)
+{
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// Packs the value into an unsigned floating-point format with a 5-bit exponent, e.g. 11- and 10-bit floats.
+Uint32 PackUnsignedSmallFloat(float f, Uint32 MantissaBits)
+{
+    const Uint32 Bits        = FloatBits(f);
+    const Uint32 MaxExpValue = 0x1Fu << MantissaBits;
+    if ((Bits & 0x7F800000u) == 0x7F800000u)
+    {
+        if ((Bits & 0x007FFFFFu) != 0)
+            return MaxExpValue | 1u; // NaN
+
+        return (Bits & 0x80000000u) != 0 ? 0 : MaxExpValue; // -Inf or +Inf
+    }
+
+    if ((Bits & 0x80000000u) != 0 || Bits == 0)
+        return 0;
+
+    // Exponent 30 with all mantissa bits set
+    const Uint32 MaxFinite = MaxExpValue - 1u;
+
+    const int Exp = static_cast<int>(Bits >> 23) - 127;
+    if (Exp < -14)
+    {
+        // Denormal value: Mantissa * 2^(-14 - MantissaBits).
+        // The rounding may produce the smallest normal value, which has the next binary representation.
+        return static_cast<Uint32>(std::nearbyint(std::ldexp(f, 14 + static_cast<int>(MantissaBits))));
+    }
+    if (Exp > 15)
+        return MaxFinite;
+
+    // Rebias the exponent and round the mantissa to the nearest even. The carry propagates to the exponent.
+    const Uint32 Shift    = 23u - MantissaBits;
+    const Uint32 Rebiased = (static_cast<Uint32>(Exp + 15) << 23) | (Bits & 0x007FFFFFu);
+    const Uint32 Rounded  = (Rebiased + (1u << (Shift - 1u)) - 1u + ((Rebiased >> Shift) & 1u)) >> Shift;
+    return std::min(Rounded, MaxFinite);
+}
+
+float UnpackUnsignedSmallFloat(Uint32 Value, Uint32 MantissaBits)
+{
+    const Uint32 Exp      = (Value >> MantissaBits) & 0x1Fu;
+    const Uint32 Mantissa = Value & ((1u << MantissaBits) - 1u);
+    if (Exp == 0)
+        return std::ldexp(static_cast<float>(Mantissa), -14 - static_cast<int>(MantissaBits));
+    if (Exp == 0x1Fu)
+        return BitsToFloat(Mantissa != 0 ? 0x7FC00000u : 0x7F800000u);
+
+    return BitsToFloat(((Exp + 127u - 15u) << 23) | (Mantissa << (23u - MantissaBits)));
+}
+
+inline float Saturate(float x)
+{
+    // NaN is converted to zero
+    return x > 0.f ? (x < 1.f ? x : 1.f) : 0.f;
+}
+
+inline Uint8 FloatToUnorm8(float x)
+{
+    return static_cast<Uint8>(Saturate(x) * 255.f + 0.5f);
+}
+
+inline float Unorm8ToFloat(Uint8 x)
+{
+    return static_cast<float>(x) * (1.f / 255.f);
+}
+
+class SRGBTables
+{
+public:
+    static const SRGBTables& Get()
+    {
+        static const SRGBTables Tables;
+        return Tables;
+    }
+
+    // Returns the sRGB value that is the closest to the linear value in [0, 1]
+    Uint8 LinearToSRGB8(float Linear) const
+    {
+        VERIFY_EXPR(Linear >= 0 && Linear <= 1);
+        Uint32 SRGB = m_SearchStart[static_cast<Uint32>(Linear * static_cast<float>(SearchStartSize - 1))];
+        while (SRGB < m_Thresholds.size() && m_Thresholds[SRGB] <= Linear)
+            ++SRGB;
+        return static_cast<Uint8>(SRGB);
+    }
+
+    std::array<float, 256> ToLinear;
+    std::array<Uint8, 256> UnormToSRGB;
+    std::array<Uint8, 256> SRGBToUnorm;
+
+private:
+    SRGBTables()
+    {
+        for (Uint32 i = 0; i < ToLinear.size(); ++i)
+            ToLinear[i] = GammaToLinear(static_cast<float>(i) / 255.f);
+
+        // Linear values halfway between the consecutive sRGB values
+        for (Uint32 i = 0; i < m_Thresholds.size(); ++i)
+            m_Thresholds[i] = GammaToLinear((static_cast<float>(i) + 0.5f) / 255.f);
+
+        // The search starts from the number of thresholds that are below the smallest value in the bucket.
+        // Since the thresholds are farther apart than the buckets, the search takes at most a couple of steps.
+        Uint32 Threshold = 0;
+        for (Uint32 Bucket = 0; Bucket < SearchStartSize; ++Bucket)
+        {
+            while (Threshold < m_Thresholds.size() && static_cast<Uint32>(m_Thresholds[Threshold] * static_cast<float>(SearchStartSize - 1)) < Bucket)
+                ++Threshold;
+            m_SearchStart[Bucket] = static_cast<Uint8>(Threshold);
+        }
+
+        for (Uint32 i = 0; i < 256; ++i)
+        {
+            UnormToSRGB[i] = LinearToSRGB8(Unorm8ToFloat(static_cast<Uint8>(i)));
+            SRGBToUnorm[i] = FloatToUnorm8(ToLinear[i]);
+        }
+    }
+
+    static constexpr Uint32 SearchStartSize = 4096;
+
+    std::array<float, 255>             m_Thresholds{};
+    std::array<Uint8, SearchStartSize> m_SearchStart{};
+};
+
+#if DILIGENT_SSE2_ENABLED
+// Converts four 16-bit values in the lower half of the register to 32-bit floats
+inline __m128 HalfToFloatSSE2(__m128i h)
+{
+    const __m128i ShiftedExp = _mm_set1_epi32(0x7C00 << 13);
+
+    h = _mm_unpacklo_epi16(h, _mm_setzero_si128());
+
+    __m128i       Bits = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7FFF)), 13);
+    const __m128i Exp  = _mm_and_si128(Bits, ShiftedExp);
+    Bits               = _mm_add_epi32(Bits, _mm_set1_epi32((127 - 15) << 23));
+
+    // Inf or NaN
+    const __m128i IsInfNaN = _mm_cmpeq_epi32(Exp, ShiftedExp);
+    Bits                   = _mm_add_epi32(Bits, _mm_and_si128(IsInfNaN, _mm_set1_epi32((128 - 16) << 23)));
+
+    // Zero or denormal
+    const __m128i IsDenorm = _mm_cmpeq_epi32(Exp, _mm_setzero_si128());
+    const __m128  Denorm   = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(Bits, _mm_set1_epi32(1 << 23))), _mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+    Bits                   = _mm_or_si128(_mm_andnot_si128(IsDenorm, Bits), _mm_and_si128(IsDenorm, _mm_castps_si128(Denorm)));
+
+    const __m128i Sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+    return _mm_castsi128_ps(_mm_or_si128(Bits, Sign));
+}
+
+// Converts four floats to 16-bit values in the lower 16 bits of every 32-bit lane, see FloatToHalf()
+inline __m128i FloatToHalfSSE2(__m128 f)
+{
+    __m128i       Bits = _mm_castps_si128(f);
+    const __m128i Sign = _mm_and_si128(Bits, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    Bits               = _mm_xor_si128(Bits, Sign);
+
+    // All comparisons are signed, which is fine since the sign bit is cleared
+    const __m128i IsOverflow = _mm_cmpgt_epi32(Bits, _mm_set1_epi32(((127 + 16) << 23) - 1));
+    const __m128i IsNaN      = _mm_cmpgt_epi32(Bits, _mm_set1_epi32(255 << 23));
+    const __m128i InfNaN     = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(IsNaN, _mm_set1_epi32(0x0200)));
+
+    const __m128i IsDenorm    = _mm_cmpgt_epi32(_mm_set1_epi32(113 << 23), Bits);
+    const __m128i DenormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i Denorm      = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(Bits), _mm_castsi128_ps(DenormMagic))), DenormMagic);
+
+    const __m128i MantissaOdd = _mm_and_si128(_mm_srli_epi32(Bits, 13), _mm_set1_epi32(1));
+    __m128i       Normal      = _mm_sub_epi32(Bits, _mm_set1_epi32((127 - 15) << 23));
+    Normal                    = _mm_add_epi32(Normal, _mm_add_epi32(_mm_set1_epi32(0xFFF), MantissaOdd));
+    Normal                    = _mm_srli_epi32(Normal, 13);
+
+    __m128i h = _mm_or_si128(_mm_andnot_si128(IsDenorm, Normal), _mm_and_si128(IsDenorm, Denorm));
+    h         = _mm_or_si128(_mm_andnot_si128(IsOverflow, h), _mm_and_si128(IsOverflow, InfNaN));
+    return _mm_or_si128(h, _mm_srli_epi32(Sign, 16));
+}
+
+// Packs the lower 16 bits of every 32-bit lane of two registers
+inline __m128i Pack32To16SSE2(__m128i lo, __m128i hi)
+{
+    // Sign-extend the values so that the signed saturation keeps them intact
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+    return _mm_packs_epi32(lo, hi);
+}
+#endif
+
+template <bool IsBGRA>
+void DecodeUnorm8(const void* pSrc, float* pDst, size_t NumTexels)
+{
+    const Uint8* pSrc8 = static_cast<const Uint8*>(pSrc);
+
+    size_t t = 0;
+#if DILIGENT_SSE2_ENABLED
+    const __m128i Zero  = _mm_setzero_si128();
+    const __m128  Scale = _mm_set1_ps(1.f / 255.f);
+    for (; t + 4 <= NumTexels; t += 4)
+    {
+        const __m128i Texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc8 + t * 4));
+        const __m128i Lo     = _mm_unpacklo_epi8(Texels, Zero);
+        const __m128i Hi     = _mm_unpackhi_epi8(Texels, Zero);
+
+        __m128 Texel[4] = {
+            _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(Lo, Zero)), Scale),
+            _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(Lo, Zero)), Scale),
+            _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(Hi, Zero)), Scale),
+            _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(Hi, Zero)), Scale),
+        };
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            if (IsBGRA)
+                Texel[i] = _mm_shuffle_ps(Texel[i], Texel[i], _MM_SHUFFLE(3, 0, 1, 2));
+            _mm_storeu_ps(pDst + (t + i) * 4, Texel[i]);
+        }
+    }
+#elif DILIGENT_NEON_ENABLED
+    for (; t + 8 <= NumTexels; t += 8)
+    {
+        const uint8x8x4_t Texels = vld4_u8(pSrc8 + t * 4);
+
+        float32x4x4_t Lo, Hi;
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            const uint16x8_t Channel = vmovl_u8(Texels.val[IsBGRA && c < 3 ? 2 - c : c]);
+            Lo.val[c]                = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(Channel))), 1.f / 255.f);
+            Hi.val[c]                = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(Channel))), 1.f / 255.f);
+        }
+        vst4q_f32(pDst + t * 4, Lo);
+        vst4q_f32(pDst + t * 4 + 16, Hi);
+    }
+#endif
+    for (; t < NumTexels; ++t)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            pDst[t * 4 + c] = Unorm8ToFloat(pSrc8[t * 4 + (IsBGRA && c < 3 ? 2 - c : c)]);
+    }
+}
+
+template <bool IsBGRA>
+void EncodeUnorm8(const float* pSrc, void* pDst, size_t NumTexels)
+{
+    Uint8* pDst8 = static_cast<Uint8*>(pDst);
+
+    size_t t = 0;
+#if DILIGENT_SSE2_ENABLED
+    const __m128 Zero  = _mm_setzero_ps();
+    const __m128 One   = _mm_set1_ps(1.f);
+    const __m128 Scale = _mm_set1_ps(255.f);
+    const __m128 Half  = _mm_set1_ps(0.5f);
+    for (; t + 4 <= NumTexels; t += 4)
+    {
+        __m128i Texel[4];
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            __m128 Val = _mm_loadu_ps(pSrc + (t + i) * 4);
+            if (IsBGRA)
+                Val = _mm_shuffle_ps(Val, Val, _MM_SHUFFLE(3, 0, 1, 2));
+            // _mm_max_ps returns the second operand if the first one is NaN
+            Val      = _mm_min_ps(_mm_max_ps(Val, Zero), One);
+            Texel[i] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(Val, Scale), Half));
+        }
+        const __m128i Packed = _mm_packus_epi16(_mm_packs_epi32(Texel[0], Texel[1]), _mm_packs_epi32(Texel[2], Texel[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst8 + t * 4), Packed);
+    }
+#elif DILIGENT_NEON_ENABLED
+    const float32x4_t Zero = vdupq_n_f32(0.f);
+    const float32x4_t One  = vdupq_n_f32(1.f);
+    const float32x4_t Half = vdupq_n_f32(0.5f);
+    for (; t + 8 <= NumTexels; t += 8)
+    {
+        const float32x4x4_t Lo = vld4q_f32(pSrc + t * 4);
+        const float32x4x4_t Hi = vld4q_f32(pSrc + t * 4 + 16);
+
+        uint8x8x4_t Texels;
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            // vmaxq_f32 propagates NaN, which is converted to zero by vcvtq_u32_f32
+            const uint32x4_t LoChannel = vcvtq_u32_f32(vmlaq_n_f32(Half, vminq_f32(vmaxq_f32(Lo.val[c], Zero), One), 255.f));
+            const uint32x4_t HiChannel = vcvtq_u32_f32(vmlaq_n_f32(Half, vminq_f32(vmaxq_f32(Hi.val[c], Zero), One), 255.f));
+
+            Texels.val[IsBGRA && c < 3 ? 2 - c : c] = vmovn_u16(vcombine_u16(vmovn_u32(LoChannel), vmovn_u32(HiChannel)));
+        }
+        vst4_u8(pDst8 + t * 4, Texels);
+    }
+#endif
+    for (; t < NumTexels; ++t)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            pDst8[t * 4 + (IsBGRA && c < 3 ? 2 - c : c)] = FloatToUnorm8(pSrc[t * 4 + c]);
+    }
+}
+
+template <bool IsBGRA>
+void DecodeSRGB8(const void* pSrc, float* pDst, size_t NumTexels)
+{
+    const SRGBTables& Tables = SRGBTables::Get();
+    const Uint8*      pSrc8  = static_cast<const Uint8*>(pSrc);
+    for (size_t t = 0; t < NumTexels; ++t, pSrc8 += 4, pDst += 4)
+    {
+        pDst[0] = Tables.ToLinear[pSrc8[IsBGRA ? 2 : 0]];
+        pDst[1] = Tables.ToLinear[pSrc8[1]];
+        pDst[2] = Tables.ToLinear[pSrc8[IsBGRA ? 0 : 2]];
+        pDst[3] = Unorm8ToFloat(pSrc8[3]);
+    }
+}
+
+template <bool IsBGRA>
+void EncodeSRGB8(const float* pSrc, void* pDst, size_t NumTexels)
+{
+    const SRGBTables& Tables = SRGBTables::Get();
+    Uint8*            pDst8  = static_cast<Uint8*>(pDst);
+    for (size_t t = 0; t < NumTexels; ++t, pSrc += 4, pDst8 += 4)
+    {
+        pDst8[IsBGRA ? 2 : 0] = Tables.LinearToSRGB8(Saturate(pSrc[0]));
+        pDst8[1]              = Tables.LinearToSRGB8(Saturate(pSrc[1]));
+        pDst8[IsBGRA ? 0 : 2] = Tables.LinearToSRGB8(Saturate(pSrc[2]));
+        pDst8[3]              = FloatToUnorm8(pSrc[3]);
+    }
+}
+
+void DecodeRGBA16F(const void* pSrc, float* pDst, size_t NumTexels)
+{
+    const Uint16* pSrc16 = static_cast<const Uint16*>(pSrc);
+
+    const size_t NumValues = NumTexels * 4;
+
+    size_t i = 0;
+#if DILIGENT_SSE2_ENABLED
+    for (; i + 8 <= NumValues; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc16 + i));
+        _mm_storeu_ps(pDst + i, HalfToFloatSSE2(h));
+        _mm_storeu_ps(pDst + i + 4, HalfToFloatSSE2(_mm_unpackhi_epi64(h, h)));
+    }
+#elif DILIGENT_NEON_FP16_ENABLED
+    for (; i + 4 <= NumValues; i += 4)
+        vst1q_f32(pDst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(pSrc16 + i))));
+#endif
+    for (; i < NumValues; ++i)
+        pDst[i] = HalfToFloat(pSrc16[i]);
+}
+
+void EncodeRGBA16F(const float* pSrc, void* pDst, size_t NumTexels)
+{
+    Uint16* pDst16 = static_cast<Uint16*>(pDst);
+
+    const size_t NumValues = NumTexels * 4;
+
+    size_t i = 0;
+#if DILIGENT_SSE2_ENABLED
+    for (; i + 8 <= NumValues; i += 8)
+    {
+        const __m128i Lo = FloatToHalfSSE2(_mm_loadu_ps(pSrc + i));
+        const __m128i Hi = FloatToHalfSSE2(_mm_loadu_ps(pSrc + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst16 + i), Pack32To16SSE2(Lo, Hi));
+    }
+#elif DILIGENT_NEON_FP16_ENABLED
+    for (; i + 4 <= NumValues; i += 4)
+        vst1_u16(pDst16 + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(pSrc + i))));
+#endif
+    for (; i < NumValues; ++i)
+        pDst16[i] = FloatToHalf(pSrc[i]);
+}
+
+void DecodeRGBA32F(const void* pSrc, float* pDst, size_t NumTexels)
+{
+    memcpy(pDst, pSrc, NumTexels * 4 * sizeof(float));
+}
+
+void EncodeRGBA32F(const float* pSrc, void* pDst, size_t NumTexels)
+{
+    memcpy(pDst, pSrc, NumTexels * 4 * sizeof(float));
+}
+
+void DecodeRGB32F(const void* pSrc, float* pDst, size_t NumTexels)
+{
+    const float* pSrc32 = static_cast<const float*>(pSrc);
+    for (size_t t = 0; t < NumTexels; ++t, pSrc32 += 3, pDst += 4)
+    {
+        pDst[0] = pSrc32[0];
+        pDst[1] = pSrc32[1];
+        pDst[2] = pSrc32[2];
+        pDst[3] = 1.f;
+    }
+}
+
+void EncodeRGB32F(const float* pSrc, void* pDst, size_t NumTexels)
+{
+    float* pDst32 = static_cast<float*>(pDst);
+    for (size_t t = 0; t < NumTexels; ++t, pSrc += 4, pDst32 += 3)
+    {
+        pDst32[0] = pSrc[0];
+        pDst32[1] = pSrc[1];
+        pDst32[2] = pSrc[2];
+    }
+}
+
+template <float3 (*Unpack)(Uint32)>
+void DecodePacked32(const void* pSrc, float* pDst, size_t NumTexels)
+{
+    const Uint8* pSrc8 = static_cast<const Uint8*>(pSrc);
+    for (size_t t = 0; t < NumTexels; ++t, pDst += 4)
+    {
+        Uint32 Packed;
+        memcpy(&Packed, pSrc8 + t * 4, sizeof(Packed));
+        const float3 RGB = Unpack(Packed);
+        pDst[0]          = RGB.r;
+        pDst[1]          = RGB.g;
+        pDst[2]          = RGB.b;
+        pDst[3]          = 1.f;
+    }
+}
+
+template <Uint32 (*Pack)(const float3&)>
+void EncodePacked32(const float* pSrc, void* pDst, size_t NumTexels)
+{
+    Uint8* pDst8 = static_cast<Uint8*>(pDst);
+    for (size_t t = 0; t < NumTexels; ++t, pSrc += 4)
+    {
+        const Uint32 Packed = Pack(float3{pSrc[0], pSrc[1], pSrc[2]});
+        memcpy(pDst8 + t * 4, &Packed, sizeof(Packed));
+    }
+}
+
+// Converts linear texels in RGBA32_FLOAT format from and to the other formats
+using DecodeTexelsFuncType = void (*)(const void* pSrc, float* pDst, size_t NumTexels);
+using EncodeTexelsFuncType = void (*)(const float* pSrc, void* pDst, size_t NumTexels);
+
+struct TexelCodec
+{
+    DecodeTexelsFuncType Decode = nullptr;
+    EncodeTexelsFuncType Encode = nullptr;
+};
+
+TexelCodec GetTexelCodec(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        // clang-format off
+        case TEX_FORMAT_RGBA8_UNORM:       return {DecodeUnorm8<false>, EncodeUnorm8<false>};
+        case TEX_FORMAT_BGRA8_UNORM:       return {DecodeUnorm8<true>,  EncodeUnorm8<true>};
+        case TEX_FORMAT_RGBA8_UNORM_SRGB:  return {DecodeSRGB8<false>,  EncodeSRGB8<false>};
+        case TEX_FORMAT_BGRA8_UNORM_SRGB:  return {DecodeSRGB8<true>,   EncodeSRGB8<true>};
+        case TEX_FORMAT_RGBA16_FLOAT:      return {DecodeRGBA16F,       EncodeRGBA16F};
+        case TEX_FORMAT_RGBA32_FLOAT:      return {DecodeRGBA32F,       EncodeRGBA32F};
+        case TEX_FORMAT_RGB32_FLOAT:       return {DecodeRGB32F,        EncodeRGB32F};
+        case TEX_FORMAT_R11G11B10_FLOAT:   return {DecodePacked32<UnpackR11G11B10F>, EncodePacked32<PackR11G11B10F>};
+        case TEX_FORMAT_RGB9E5_SHAREDEXP:  return {DecodePacked32<UnpackRGB9E5>,     EncodePacked32<PackRGB9E5>};
+        // clang-format on
+
+        default:
+            return {};
+    }
+}
+
+bool Is8BitRGBAFormat(TEXTURE_FORMAT Format)
+{
+    return (Format == TEX_FORMAT_RGBA8_UNORM ||
+            Format == TEX_FORMAT_RGBA8_UNORM_SRGB ||
+            Format == TEX_FORMAT_BGRA8_UNORM ||
+            Format == TEX_FORMAT_BGRA8_UNORM_SRGB);
+}
+
+bool IsBGRAFormat(TEXTURE_FORMAT Format)
+{
+    return Format == TEX_FORMAT_BGRA8_UNORM || Format == TEX_FORMAT_BGRA8_UNORM_SRGB;
+}
+
+bool IsSRGB8Format(TEXTURE_FORMAT Format)
+{
+    return Format == TEX_FORMAT_RGBA8_UNORM_SRGB || Format == TEX_FORMAT_BGRA8_UNORM_SRGB;
+}
+
+// Swaps the red and blue channels of 8-bit RGBA texels
+void SwapRB8(const Uint8* pSrc, Uint8* pDst, size_t NumTexels)
+{
+    size_t t = 0;
+#if DILIGENT_SSE2_ENABLED
+    const __m128i GAMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+    const __m128i ByteMask = _mm_set1_epi32(0xFF);
+    for (; t + 4 <= NumTexels; t += 4)
+    {
+        const __m128i Texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + t * 4));
+
+        const __m128i GA = _mm_and_si128(Texels, GAMask);
+        const __m128i R  = _mm_slli_epi32(_mm_and_si128(Texels, ByteMask), 16);
+        const __m128i B  = _mm_and_si128(_mm_srli_epi32(Texels, 16), ByteMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + t * 4), _mm_or_si128(GA, _mm_or_si128(R, B)));
+    }
+#elif DILIGENT_NEON_ENABLED
+    for (; t + 16 <= NumTexels; t += 16)
+    {
+        uint8x16x4_t Texels = vld4q_u8(pSrc + t * 4);
+        std::swap(Texels.val[0], Texels.val[2]);
+        vst4q_u8(pDst + t * 4, Texels);
+    }
+#endif
+    for (; t < NumTexels; ++t)
+    {
+        pDst[t * 4 + 0] = pSrc[t * 4 + 2];
+        pDst[t * 4 + 1] = pSrc[t * 4 + 1];
+        pDst[t * 4 + 2] = pSrc[t * 4 + 0];
+        pDst[t * 4 + 3] = pSrc[t * 4 + 3];
+    }
+}
+
+// Converts 8-bit RGBA texels between the formats without going through floating point
+void Convert8BitRGBA(TEXTURE_FORMAT SrcFormat, const Uint8* pSrc, TEXTURE_FORMAT DstFormat, Uint8* pDst, size_t NumTexels)
+{
+    const bool SwapRB = IsBGRAFormat(SrcFormat) != IsBGRAFormat(DstFormat);
+
+    const bool SrcSRGB = IsSRGB8Format(SrcFormat);
+    const bool DstSRGB = IsSRGB8Format(DstFormat);
+    if (SrcSRGB == DstSRGB)
+    {
+        if (SwapRB)
+            SwapRB8(pSrc, pDst, NumTexels);
+        else
+            memcpy(pDst, pSrc, NumTexels * 4);
+        return;
+    }
+
+    const SRGBTables&             Tables = SRGBTables::Get();
+    const std::array<Uint8, 256>& LUT    = DstSRGB ? Tables.UnormToSRGB : Tables.SRGBToUnorm;
+    for (size_t t = 0; t < NumTexels; ++t, pSrc += 4, pDst += 4)
+    {
+        pDst[SwapRB ? 2 : 0] = LUT[pSrc[0]];
+        pDst[1]              = LUT[pSrc[1]];
+        pDst[SwapRB ? 0 : 2] = LUT[pSrc[2]];
+        pDst[3]              = pSrc[3];
+    }
+}
+
+} // namespace
+
+Uint16 FloatToHalf(float f)
+{
+    // https://gist.github.com/rygorous/2156668
+    constexpr Uint32 F32Infinity = 255u << 23;
+    constexpr Uint32 F16Overflow = (127u + 16u) << 23;
+    constexpr Uint32 DenormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    Uint32       Bits = FloatBits(f);
+    const Uint32 Sign = Bits & 0x80000000u;
+    Bits ^= Sign;
+
+    Uint32 h = 0;
+    if (Bits >= F16Overflow)
+    {
+        // Inf or NaN
+        h = Bits > F32Infinity ? 0x7E00u : 0x7C00u;
+    }
+    else if (Bits < (113u << 23))
+    {
+        // The floating-point addition shifts the mantissa into place and rounds it
+        h = FloatBits(BitsToFloat(Bits) + BitsToFloat(DenormMagic)) - DenormMagic;
+    }
+    else
+    {
+        const Uint32 MantissaOdd = (Bits >> 13) & 1u;
+        // Rebias the exponent and round the mantissa to the nearest even
+        Bits -= (127u - 15u) << 23;
+        Bits += 0xFFFu + MantissaOdd;
+        h = Bits >> 13;
+    }
+
+    return static_cast<Uint16>(h | (Sign >> 16));
+}
+
+float HalfToFloat(Uint16 h)
+{
+    constexpr Uint32 ShiftedExp = 0x7C00u << 13;
+
+    Uint32       Bits = (h & 0x7FFFu) << 13;
+    const Uint32 Exp  = Bits & ShiftedExp;
+    Bits += (127u - 15u) << 23;
+    if (Exp == ShiftedExp)
+    {
+        // Inf or NaN
+        Bits += (128u - 16u) << 23;
+    }
+    else if (Exp == 0)
+    {
+        // Zero or denormal
+        Bits += 1u << 23;
+        Bits = FloatBits(BitsToFloat(Bits) - BitsToFloat(113u << 23));
+    }
+
+    return BitsToFloat(Bits | (Uint32{h & 0x8000u} << 16));
+}
+
+Uint32 PackR11G11B10F(const float3& RGB)
+{
+    return (PackUnsignedSmallFloat(RGB.r, 6) << 0) |
+        (PackUnsignedSmallFloat(RGB.g, 6) << 11) |
+        (PackUnsignedSmallFloat(RGB.b, 5) << 22);
+}
+
+float3 UnpackR11G11B10F(Uint32 Packed)
+{
+    return float3{
+        UnpackUnsignedSmallFloat((Packed >> 0) & 0x7FFu, 6),
+        UnpackUnsignedSmallFloat((Packed >> 11) & 0x7FFu, 6),
+        UnpackUnsignedSmallFloat((Packed >> 22) & 0x3FFu, 5),
+    };
+}
+
+Uint32 PackRGB9E5(const float3& RGB)
+{
+    // https://registry.khronos.org/OpenGL/extensions/EXT/EXT_texture_shared_exponent.txt
+    constexpr int   MantissaBits = 9;
+    constexpr int   ExpBias      = 15;
+    constexpr float MaxValue     = 65408.f; // (2^9 - 1) / 2^9 * 2^(31 - 15)
+
+    auto ClampComponent = [](float x) {
+        // NaN is converted to zero
+        return x > 0.f ? (x < MaxValue ? x : MaxValue) : 0.f;
+    };
+    const float R = ClampComponent(RGB.r);
+    const float G = ClampComponent(RGB.g);
+    const float B = ClampComponent(RGB.b);
+
+    const float MaxComponent = std::max(std::max(R, G), B);
+
+    // max(-ExpBias - 1, floor(log2(MaxComponent)))
+    int Exp = -ExpBias - 1;
+    if (MaxComponent >= std::ldexp(1.f, -ExpBias - 1))
+    {
+        std::frexp(MaxComponent, &Exp);
+        Exp -= 1;
+    }
+
+    int   SharedExp = Exp + 1 + ExpBias;
+    float Scale     = std::ldexp(1.f, SharedExp - ExpBias - MantissaBits);
+    if (static_cast<int>(std::floor(MaxComponent / Scale + 0.5f)) == (1 << MantissaBits))
+    {
+        Scale *= 2.f;
+        ++SharedExp;
+    }
+    VERIFY_EXPR(SharedExp >= 0 && SharedExp <= 31);
+
+    auto Quantize = [Scale](float x) {
+        return static_cast<Uint32>(std::floor(x / Scale + 0.5f));
+    };
+    return Quantize(R) | (Quantize(G) << 9) | (Quantize(B) << 18) | (static_cast<Uint32>(SharedExp) << 27);
+}
+
+float3 UnpackRGB9E5(Uint32 Packed)
+{
+    const float Scale = std::ldexp(1.f, static_cast<int>(Packed >> 27) - 15 - 9);
+    return float3{
+        static_cast<float>((Packed >> 0) & 0x1FFu) * Scale,
+        static_cast<float>((Packed >> 9) & 0x1FFu) * Scale,
+        static_cast<float>((Packed >> 18) & 0x1FFu) * Scale,
+    };
+}
+
+bool IsTexelConversionSupported(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat)
+{
+    return GetTexelCodec(SrcFormat).Decode != nullptr && GetTexelCodec(DstFormat).Encode != nullptr;
+}
+
+bool ConvertTexels(TEXTURE_FORMAT SrcFormat,
+                   const void*    pSrc,
+                   TEXTURE_FORMAT DstFormat,
+                   void*          pDst,
+                   size_t         NumTexels)
+{
+    if (!IsTexelConversionSupported(SrcFormat, DstFormat))
+    {
+        DEV_ERROR("Conversion from ", GetTextureFormatAttribs(SrcFormat).Name, " to ", GetTextureFormatAttribs(DstFormat).Name, " is not supported");
+        return false;
+    }
+    if (NumTexels == 0)
+        return true;
+
+    DEV_CHECK_ERR(pSrc != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(pDst != nullptr, "Destination data must not be null");
+
+    if (SrcFormat == DstFormat)
+    {
+        memcpy(pDst, pSrc, NumTexels * GetTextureFormatAttribs(SrcFormat).GetElementSize());
+        return true;
+    }
+
+    if (Is8BitRGBAFormat(SrcFormat) && Is8BitRGBAFormat(DstFormat))
+    {
+        Convert8BitRGBA(SrcFormat, static_cast<const Uint8*>(pSrc), DstFormat, static_cast<Uint8*>(pDst), NumTexels);
+        return true;
+    }
+
+    const TexelCodec SrcCodec = GetTexelCodec(SrcFormat);
+    const TexelCodec DstCodec = GetTexelCodec(DstFormat);
+    if (SrcFormat == TEX_FORMAT_RGBA32_FLOAT)
+    {
+        DstCodec.Encode(static_cast<const float*>(pSrc), pDst, NumTexels);
+        return true;
+    }
+    if (DstFormat == TEX_FORMAT_RGBA32_FLOAT)
+    {
+        SrcCodec.Decode(pSrc, static_cast<float*>(pDst), NumTexels);
+        return true;
+    }
+
+    // Convert the texels in chunks through the intermediate linear representation
+    const size_t SrcTexelSize = GetTextureFormatAttribs(SrcFormat).GetElementSize();
+    const size_t DstTexelSize = GetTextureFormatAttribs(DstFormat).GetElementSize();
+
+    constexpr size_t ChunkSize = 64;
+    alignas(16) float Texels[ChunkSize * 4];
+    for (size_t t = 0; t < NumTexels; t += ChunkSize)
+    {
+        const size_t NumChunkTexels = std::min(ChunkSize, NumTexels - t);
+        SrcCodec.Decode(static_cast<const Uint8*>(pSrc) + t * SrcTexelSize, Texels, NumChunkTexels);
+        DstCodec.Encode(Texels, static_cast<Uint8*>(pDst) + t * DstTexelSize, NumChunkTexels);
+    }
+
+    return true;
+}
+
+bool ConvertTextureData(const ConvertTextureDataAttribs& Attribs)
+{
+    if (!IsTexelConversionSupported(Attribs.SrcFormat, Attribs.DstFormat))
+    {
+        DEV_ERROR("Conversion from ", GetTextureFormatAttribs(Attribs.SrcFormat).Name, " to ", GetTextureFormatAttribs(Attribs.DstFormat).Name, " is not supported");
+        return false;
+    }
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pDstData != nullptr, "Destination data must not be null");
+    DEV_CHECK_ERR(Attribs.SrcStride >= size_t{Attribs.Width} * GetTextureFormatAttribs(Attribs.SrcFormat).GetElementSize(), "Source stride is too small");
+    DEV_CHECK_ERR(Attribs.DstStride >= size_t{Attribs.Width} * GetTextureFormatAttribs(Attribs.DstFormat).GetElementSize(), "Destination stride is too small");
+
+    for (Uint32 row = 0; row < Attribs.Height; ++row)
+    {
+        ConvertTexels(Attribs.SrcFormat, static_cast<const Uint8*>(Attribs.pSrcData) + row * Attribs.SrcStride,
+                      Attribs.DstFormat, static_cast<Uint8*>(Attribs.pDstData) + row * Attribs.DstStride,
+                      Attribs.Width);
+    }
+
+    return true;
+}
+
+void ExpandRGB8ToRGBA8(const Uint8* pSrc, Uint8* pDst, size_t NumTexels, Uint8 Alpha)
+{
+    size_t t = 0;
+#if DILIGENT_NEON_ENABLED
+    for (; t + 8 <= NumTexels; t += 8)
+    {
+        const uint8x8x3_t RGB = vld3_u8(pSrc + t * 3);
+
+        uint8x8x4_t RGBA;
+        RGBA.val[0] = RGB.val[0];
+        RGBA.val[1] = RGB.val[1];
+        RGBA.val[2] = RGB.val[2];
+        RGBA.val[3] = vdup_n_u8(Alpha);
+        vst4_u8(pDst + t * 4, RGBA);
+    }
+#endif
+    const Uint32 AlphaBits = Uint32{Alpha} << 24;
+    for (; t < NumTexels; ++t)
+    {
+        const Uint8* pRGB  = pSrc + t * 3;
+        // Texels are written as 32-bit little-endian values
+        const Uint32 Texel = Uint32{pRGB[0]} | (Uint32{pRGB[1]} << 8) | (Uint32{pRGB[2]} << 16) | AlphaBits;
+        memcpy(pDst + t * 4, &Texel, sizeof(Texel));
+    }
+}
+
+} // namespace Diligent
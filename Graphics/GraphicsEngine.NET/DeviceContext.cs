@@ -38,7 +38,12 @@ public partial class IDeviceContext
         return MemoryMarshal.Cast<byte, T>(data);
     }
 
-    public unsafe void SetVertexBuffers(uint startSlot, IBuffer[] buffers, ulong[] offsets, ResourceStateTransitionMode stateTransitionMode, SetVertexBuffersFlags flags = SetVertexBuffersFlags.None)
+    public void SetVertexBuffers(uint startSlot, IBuffer[] buffers, ulong[] offsets, ResourceStateTransitionMode stateTransitionMode, SetVertexBuffersFlags flags = SetVertexBuffersFlags.None)
+    {
+        SetVertexBuffers(startSlot, new ReadOnlySpan<IBuffer>(buffers), new ReadOnlySpan<ulong>(offsets), stateTransitionMode, flags);
+    }
+
+    public unsafe void SetVertexBuffers(uint startSlot, ReadOnlySpan<IBuffer> buffers, ReadOnlySpan<ulong> offsets, ResourceStateTransitionMode stateTransitionMode, SetVertexBuffersFlags flags = SetVertexBuffersFlags.None)
     {
         var ppBuffers = stackalloc IntPtr[buffers.Length];
         for (var i = 0; i < buffers.Length; i++)
@@ -46,16 +51,35 @@ public partial class IDeviceContext
 
         fixed (ulong* pOffsets = offsets)
             SetVertexBuffers(startSlot, (uint)buffers.Length, ppBuffers, pOffsets, stateTransitionMode, flags);
-        GC.KeepAlive(buffers);
+        for (var i = 0; i < buffers.Length; i++)
+            GC.KeepAlive(buffers[i]);
+    }
+
+    public void SetRenderTargets(ITextureView[] renderTargetViews, ITextureView depthStencilView, ResourceStateTransitionMode mode)
+    {
+        SetRenderTargets(new ReadOnlySpan<ITextureView>(renderTargetViews), depthStencilView, mode);
     }
 
-    public unsafe void SetRenderTargets(ITextureView[] renderTargetViews, ITextureView depthStencilView, ResourceStateTransitionMode mode)
+    public unsafe void SetRenderTargets(ReadOnlySpan<ITextureView> renderTargetViews, ITextureView depthStencilView, ResourceStateTransitionMode mode)
     {
-        var ppRTVs = stackalloc IntPtr[renderTargetViews?.Length ?? 0];
-        for (var i = 0; i < renderTargetViews?.Length; i++)
+        var ppRTVs = stackalloc IntPtr[renderTargetViews.Length];
+        for (var i = 0; i < renderTargetViews.Length; i++)
             ppRTVs[i] = renderTargetViews[i]?.NativePointer ?? IntPtr.Zero;
-        SetRenderTargets((uint)(renderTargetViews?.Length ?? 0), ppRTVs, depthStencilView, mode);
-        GC.KeepAlive(renderTargetViews);
+        SetRenderTargets((uint)renderTargetViews.Length, ppRTVs, depthStencilView, mode);
+        for (var i = 0; i < renderTargetViews.Length; i++)
+            GC.KeepAlive(renderTargetViews[i]);
+    }
+
+    public unsafe void SetViewports(ReadOnlySpan<Viewport> viewports, uint width, uint height)
+    {
+        fixed (Viewport* pViewports = viewports)
+            SetViewports((uint)viewports.Length, pViewports, width, height);
+    }
+
+    public unsafe void SetScissorRects(ReadOnlySpan<Rect> rects, uint width, uint height)
+    {
+        fixed (Rect* pRects = rects)
+            SetScissorRects((uint)rects.Length, pRects, width, height);
     }
 
     public unsafe void UpdateBuffer<T>(IBuffer buffer, ulong offset, ReadOnlySpan<T> data, ResourceStateTransitionMode stateTransitionMode) where T : unmanaged
@@ -64,12 +88,45 @@ public partial class IDeviceContext
             UpdateBuffer(buffer, offset, (ulong)(Unsafe.SizeOf<T>() * data.Length), new(dataPtr), stateTransitionMode);
     }
 
-    public unsafe void ExecuteCommandLists(ICommandList[] commandLists)
+    public unsafe void MultiDraw(ReadOnlySpan<MultiDrawItem> drawItems, DrawFlags flags, uint numInstances = 1, uint firstInstanceLocation = 0)
+    {
+        fixed (MultiDrawItem* pDrawItems = drawItems)
+            MultiDraw(new MultiDrawAttribs
+            {
+                DrawCount = (uint)drawItems.Length,
+                DrawItems = new IntPtr(pDrawItems),
+                Flags = flags,
+                NumInstances = numInstances,
+                FirstInstanceLocation = firstInstanceLocation
+            });
+    }
+
+    public unsafe void MultiDrawIndexed(ReadOnlySpan<MultiDrawIndexedItem> drawItems, ValueType indexType, DrawFlags flags, uint numInstances = 1, uint firstInstanceLocation = 0)
+    {
+        fixed (MultiDrawIndexedItem* pDrawItems = drawItems)
+            MultiDrawIndexed(new MultiDrawIndexedAttribs
+            {
+                DrawCount = (uint)drawItems.Length,
+                DrawItems = new IntPtr(pDrawItems),
+                IndexType = indexType,
+                Flags = flags,
+                NumInstances = numInstances,
+                FirstInstanceLocation = firstInstanceLocation
+            });
+    }
+
+    public void ExecuteCommandLists(ICommandList[] commandLists)
+    {
+        ExecuteCommandLists(new ReadOnlySpan<ICommandList>(commandLists));
+    }
+
+    public unsafe void ExecuteCommandLists(ReadOnlySpan<ICommandList> commandLists)
     {
         var ppCmdLists = stackalloc IntPtr[commandLists.Length];
         for (var i = 0; i < commandLists.Length; i++)
             ppCmdLists[i] = commandLists[i].NativePointer;
         ExecuteCommandLists((uint)commandLists.Length, ppCmdLists);
-        GC.KeepAlive(commandLists);
+        for (var i = 0; i < commandLists.Length; i++)
+            GC.KeepAlive(commandLists[i]);
     }
 }
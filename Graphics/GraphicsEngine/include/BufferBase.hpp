@@ -31,6 +31,8 @@
 /// Implementation of the Diligent::BufferBase template class
 
 #include <memory>
+#include <array>
+#include <mutex>
 
 #include "Buffer.h"
 #include "GraphicsTypes.h"
@@ -38,6 +40,10 @@
 #include "GraphicsAccessories.hpp"
 #include "STDAllocator.hpp"
 #include "FormatString.hpp"
+#include "ObjectsRegistry.hpp"
+#include "HashUtils.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ResourceStateEpoch.hpp"
 
 namespace Diligent
 {
@@ -117,7 +123,74 @@ public:
         else
             UNEXPECTED("Unexpected buffer view type");
 
-        CreateViewInternal(ViewDesc, ppView, false);
+        DEV_CHECK_ERR(ppView != nullptr, "ppView must not be null");
+        if (ppView == nullptr)
+            return;
+
+        DEV_CHECK_ERR(*ppView == nullptr, "Overwriting reference to existing object may cause memory leaks");
+        *ppView = nullptr;
+
+        const size_t Hash = std::hash<BufferViewDesc>{}(ViewDesc);
+
+        {
+            std::lock_guard<std::mutex> Lock{m_CachedViewsMtx};
+            for (size_t i = 0; i < m_NumCachedViews; ++i)
+            {
+                const CachedViewInfo& View = m_CachedViews[i];
+                if (View.Hash == Hash && View.Desc == ViewDesc)
+                {
+                    *ppView = View.pView;
+                    (*ppView)->AddRef();
+                    return;
+                }
+            }
+
+            if (m_NumCachedViews < m_CachedViews.size())
+            {
+                // Cached views are owned by the buffer and share its reference counters, the same way
+                // as the default views do. Since external references to a view can't be told apart
+                // from references to the buffer, cached views can't be evicted and live as long as the buffer.
+                IBufferView* pView = nullptr;
+                CreateViewInternal(ViewDesc, &pView, true);
+                if (pView == nullptr)
+                {
+                    LOG_ERROR("Failed to create view '", (ViewDesc.Name ? ViewDesc.Name : ""), "' for buffer '", this->m_Desc.Name, "'");
+                    return;
+                }
+
+                CachedViewInfo& View = m_CachedViews[m_NumCachedViews++];
+                View.Hash            = Hash;
+                View.Desc            = ViewDesc;
+                View.Desc.Name       = nullptr;
+                View.pView           = static_cast<BufferViewImplType*>(pView);
+
+                *ppView = pView;
+                (*ppView)->AddRef();
+                return;
+            }
+        }
+
+        try
+        {
+            auto pView = m_ViewsRegistry.Get(
+                ViewDesc,
+                [&]() {
+                    RefCntAutoPtr<IBufferView> pNewView;
+                    CreateViewInternal(ViewDesc, &pNewView, false);
+                    return pNewView;
+                });
+            *ppView = pView.Detach();
+        }
+        catch (...)
+        {
+            LOG_ERROR("Failed to create view '", (ViewDesc.Name ? ViewDesc.Name : ""), "' for buffer '", this->m_Desc.Name, "'");
+        }
+    }
+
+    ~BufferBase()
+    {
+        for (size_t i = 0; i < m_NumCachedViews; ++i)
+            m_pDefaultSRV.get_deleter()(m_CachedViews[i].pView);
     }
 
 
@@ -190,7 +263,11 @@ public:
 
     virtual void DILIGENT_CALL_TYPE SetState(RESOURCE_STATE State) override final
     {
-        this->m_State = State;
+        if (this->m_State != State)
+        {
+            this->m_State = State;
+            IncrementResourceStateEpoch();
+        }
     }
 
     virtual RESOURCE_STATE DILIGENT_CALL_TYPE GetState() const override final
@@ -266,6 +343,24 @@ protected:
 
     /// Default SRV addressing the entire buffer
     std::unique_ptr<BufferViewImplType, STDDeleter<BufferViewImplType, TBuffViewObjAllocator>> m_pDefaultSRV;
+
+    struct CachedViewInfo
+    {
+        size_t              Hash  = 0;
+        BufferViewDesc      Desc;
+        BufferViewImplType* pView = nullptr;
+    };
+
+    // Small fixed-size cache of views created through CreateView(), keyed by their description (the name is ignored).
+    // It holds the views with the first distinct descriptions requested from the buffer; they are never evicted.
+    // The storage is fixed, so looking up a cached view never allocates memory.
+    std::mutex                        m_CachedViewsMtx;
+    std::array<CachedViewInfo, 8>     m_CachedViews{};
+    size_t                            m_NumCachedViews = 0;
+
+    // Views that did not fit into the cache. Views keep strong references to the buffer,
+    // so the registry only holds weak pointers and a view is destroyed when it is released.
+    ObjectsRegistry<HashedDesc<BufferViewDesc>, RefCntAutoPtr<IBufferView>, HashedDesc<BufferViewDesc>::Hasher> m_ViewsRegistry{64};
 };
 
 } // namespace Diligent
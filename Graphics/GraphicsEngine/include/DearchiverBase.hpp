@@ -55,16 +55,16 @@ class DearchiverBase : public ObjectBase<IDearchiver>
 public:
     using TObjectBase = ObjectBase<IDearchiver>;
 
-    DearchiverBase(IReferenceCounters* pRefCounters, const DearchiverCreateInfo& CI) noexcept :
-        TObjectBase{pRefCounters}
-    {
-    }
+    DearchiverBase(IReferenceCounters* pRefCounters, const DearchiverCreateInfo& CI) noexcept;
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Dearchiver, TObjectBase)
 
     /// Implementation of IDearchiver::LoadArchive().
     virtual bool DILIGENT_CALL_TYPE LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVersion, bool MakeCopy) override final;
 
+    /// Implementation of IDearchiver::LoadArchiveFromStream().
+    virtual bool DILIGENT_CALL_TYPE LoadArchiveFromStream(IFileStream* pStream, Uint32 ContentVersion) override final;
+
     /// Implementation of IDearchiver::UnpackShader().
     virtual void DILIGENT_CALL_TYPE UnpackShader(const ShaderUnpackInfo& UnpackInfo,
                                                  IShader**               ppShader) override final;
@@ -123,7 +123,11 @@ protected:
         // clang-format on
 
         bool Get(ResourceType Type, const char* Name, ResType** ppResource);
-        void Set(ResourceType Type, const char* Name, ResType* pResource);
+        // Adds the resource to the cache. If another live resource with the same name
+        // is already in the cache, *ppResource is replaced with the cached object.
+        void Set(ResourceType Type, const char* Name, ResType** ppResource);
+
+        void Remove(ResourceType Type, const char* Name);
 
         void Clear() { m_Map.clear(); }
 
@@ -133,11 +137,55 @@ protected:
         std::unordered_map<ResourceKey, RefCntWeakPtr<ResType>, ResourceKey::Hasher> m_Map;
     };
 
+    // Cache of unpacked shaders addressed by the serialized shader data, so that
+    // identical shaders from different archives share the same object.
+    class ShaderContentCache
+    {
+    public:
+        ShaderContentCache() noexcept {};
+
+        // clang-format off
+        ShaderContentCache           (const ShaderContentCache&) = delete;
+        ShaderContentCache& operator=(const ShaderContentCache&) = delete;
+        // clang-format on
+
+        RefCntAutoPtr<IShader> Get(DeviceType DevType, const SerializedData& Data, bool SkipReflection);
+        // Adds the shader to the cache. If another live shader with the same data
+        // is already in the cache, pShader is replaced with the cached object.
+        void Set(DeviceType DevType, const SerializedData& Data, bool SkipReflection, RefCntAutoPtr<IShader>& pShader);
+
+        void Clear();
+
+    private:
+        struct Key
+        {
+            // The data is owned by the archive and must remain valid while the key is in the cache
+            const SerializedData* pData          = nullptr;
+            DeviceType            DevType        = DeviceType::Count;
+            bool                  SkipReflection = false;
+
+            bool operator==(const Key& Rhs) const noexcept
+            {
+                return DevType == Rhs.DevType && SkipReflection == Rhs.SkipReflection && *pData == *Rhs.pData;
+            }
+
+            struct Hasher
+            {
+                size_t operator()(const Key& K) const noexcept;
+            };
+        };
+
+        std::mutex m_Mtx;
+        // Keep weak references in the cache
+        std::unordered_map<Key, RefCntWeakPtr<IShader>, Key::Hasher> m_Map;
+    };
+
     struct ResourceCache
     {
         NamedResourceCache<IPipelineResourceSignature> Sign;
         NamedResourceCache<IRenderPass>                RenderPass;
         NamedResourceCache<IPipelineState>             PSO;
+        ShaderContentCache                             Shader;
     } m_Cache;
 
     struct PRSData
@@ -212,6 +260,8 @@ private:
 
     ArchiveData* FindArchive(ResourceType ResType, const char* ResName);
 
+    bool AddArchive(const DeviceObjectArchive::CreateInfo& ArchiveCI);
+
 private:
     // Resource type and name -> archive index that contains this resource.
     // Names must be unique for each resource type.
@@ -219,6 +269,8 @@ private:
     std::unordered_map<NamedResourceKey, size_t, NamedResourceKey::Hasher> m_ResNameToArchiveIdx;
 
     std::vector<ArchiveData> m_Archives;
+
+    const bool m_AllowOverrides;
 };
 
 
@@ -293,7 +345,7 @@ RefCntAutoPtr<IPipelineResourceSignature> DearchiverBase::UnpackResourceSignatur
     pRenderDevice->CreatePipelineResourceSignature(PRS.Desc, InternalData, &pSignature);
 
     if (!IsImplicit)
-        m_Cache.Sign.Set(PRSData::ArchiveResType, DeArchiveInfo.Name, pSignature.RawPtr());
+        m_Cache.Sign.Set(PRSData::ArchiveResType, DeArchiveInfo.Name, pSignature.RawDblPtr());
 
     return pSignature;
 }
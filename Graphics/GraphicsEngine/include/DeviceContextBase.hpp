@@ -34,6 +34,9 @@
 #include <array>
 #include <functional>
 #include <vector>
+#include <chrono>
+#include <utility>
+#include <cstring>
 
 #include "PrivateConstants.h"
 #include "DeviceContext.h"
@@ -43,12 +46,15 @@
 #include "ObjectBase.hpp"
 #include "DebugUtilities.hpp"
 #include "Cast.hpp"
+#include "BorrowedPtr.hpp"
 #include "GraphicsAccessories.hpp"
 #include "TextureBase.hpp"
 #include "IndexWrapper.hpp"
 #include "BasicMath.hpp"
 #include "PlatformMisc.hpp"
 #include "Align.hpp"
+#include "CPUProfiler.hpp"
+#include "RadixSort.hpp"
 
 namespace Diligent
 {
@@ -72,7 +78,7 @@ bool VerifyResolveTextureSubresourceAttribs(const ResolveTextureSubresourceAttri
                                             const TextureDesc&                      SrcTexDesc,
                                             const TextureDesc&                      DstTexDesc);
 
-bool VerifyBeginRenderPassAttribs(const BeginRenderPassAttribs& Attribs);
+bool VerifyBeginRenderPassAttribs(const BeginRenderPassAttribs& Attribs, bool IsDeferredContext);
 
 // Verifies state transition (resource barrier) description.
 // ExecutionCtxId - index of the immediate context where the barrier will be executed.
@@ -186,14 +192,23 @@ public:
         return this->SetRenderTargetsExt({NumRenderTargets, ppRenderTargets, pDepthStencil, StateTransitionMode});
     }
 
+    virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
+                                                     Uint32                         NumBuffersSet,
+                                                     IBuffer* const*                ppBuffers,
+                                                     const Uint64*                  pOffsets,
+                                                     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                                     SET_VERTEX_BUFFERS_FLAGS       Flags) override = 0;
+
     /// Base implementation of IDeviceContext::SetVertexBuffers(); validates parameters and
-    /// caches references to the buffers.
-    inline virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
-                                                            Uint32                         NumBuffersSet,
-                                                            IBuffer* const*                ppBuffers,
-                                                            const Uint64*                  pOffsets,
-                                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
-                                                            SET_VERTEX_BUFFERS_FLAGS       Flags) override = 0;
+    /// caches references to the buffers. Returns true if any vertex stream is different
+    /// from the cached value and false otherwise.
+    inline bool SetVertexBuffers(Uint32                         StartSlot,
+                                 Uint32                         NumBuffersSet,
+                                 IBuffer* const*                ppBuffers,
+                                 const Uint64*                  pOffsets,
+                                 RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                 SET_VERTEX_BUFFERS_FLAGS       Flags,
+                                 int                            Dummy);
 
     inline virtual void DILIGENT_CALL_TYPE InvalidateState() override = 0;
 
@@ -202,16 +217,24 @@ public:
                                       RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                       int);
 
-    /// Base implementation of IDeviceContext::SetIndexBuffer(); caches the strong reference to the index buffer
-    inline virtual void DILIGENT_CALL_TYPE SetIndexBuffer(IBuffer*                       pIndexBuffer,
-                                                          Uint64                         ByteOffset,
-                                                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override = 0;
+    virtual void DILIGENT_CALL_TYPE SetIndexBuffer(IBuffer*                       pIndexBuffer,
+                                                   Uint64                         ByteOffset,
+                                                   RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override = 0;
 
-    /// Caches the viewports
-    inline void SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32& RTWidth, Uint32& RTHeight);
+    /// Base implementation of IDeviceContext::SetIndexBuffer(); caches the strong reference to the index buffer.
+    /// Returns true if the buffer or the offset is different from the cached value and false otherwise.
+    inline bool SetIndexBuffer(IBuffer*                       pIndexBuffer,
+                               Uint64                         ByteOffset,
+                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                               int                            Dummy);
 
-    /// Caches the scissor rects
-    inline void SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32& RTWidth, Uint32& RTHeight);
+    /// Caches the viewports. Returns true if the viewports are different from the cached values
+    /// and false otherwise.
+    inline bool SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32& RTWidth, Uint32& RTHeight);
+
+    /// Caches the scissor rects. Returns true if the rects are different from the cached values
+    /// and false otherwise.
+    inline bool SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32& RTWidth, Uint32& RTHeight);
 
     virtual void DILIGENT_CALL_TYPE BeginRenderPass(const BeginRenderPassAttribs& Attribs) override = 0;
 
@@ -256,6 +279,14 @@ public:
     /// Base implementation of IDeviceContext::CopyTexture(); validates input parameters
     virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override = 0;
 
+    /// Implementation of IDeviceContext::UpdateTextures(); calls UpdateTexture() for every update.
+    /// Backends that record explicit barriers override this method to batch the updates.
+    virtual void DILIGENT_CALL_TYPE UpdateTextures(const UpdateTextureAttribs* pUpdates, Uint32 NumUpdates) override;
+
+    /// Implementation of IDeviceContext::CopyTextures(); calls CopyTexture() for every copy.
+    /// Backends that record explicit barriers override this method to batch the copies.
+    virtual void DILIGENT_CALL_TYPE CopyTextures(const CopyTextureAttribs* pCopies, Uint32 NumCopies) override;
+
     /// Base implementation of IDeviceContext::MapTextureSubresource()
     virtual void DILIGENT_CALL_TYPE MapTextureSubresource(ITexture*                 pTexture,
                                                           Uint32                    MipLevel,
@@ -315,6 +346,12 @@ public:
         return m_Stats;
     }
 
+    /// Implementation of IDeviceContext::SubmitDrawPackets.
+
+    /// \remarks The packets are executed through the final device context implementation type,
+    ///          so that the per-packet state-setting and draw calls are not virtual.
+    virtual void DILIGENT_CALL_TYPE SubmitDrawPackets(const DrawPacket* pPackets, Uint32 NumPackets) override final;
+
     /// Returns currently bound pipeline state and blend factors
     inline void GetPipelineState(IPipelineState** ppPSO, float* BlendFactors, Uint32& StencilRef);
 
@@ -350,19 +387,22 @@ public:
     }
 
 protected:
+    /// Returns the destination region of the update: pDstBox or the entire subresource if pDstBox is null.
+    static Box GetUpdateTextureBox(const UpdateTextureAttribs& Update);
+
     /// Committed shader resources for each resource signature
     struct CommittedShaderResources
     {
         // Pointers to shader resource caches for each signature
         std::array<ShaderResourceCacheImplType*, MAX_RESOURCE_SIGNATURES> ResourceCaches = {};
 
+        // Shader resource cache revision for every SRB at the time when the SRB was set
+        std::array<Uint32, MAX_RESOURCE_SIGNATURES> CacheRevisions = {};
+
 #ifdef DILIGENT_DEVELOPMENT
         // SRB array for each resource signature, corresponding to ResourceCaches
         std::array<RefCntWeakPtr<ShaderResourceBindingImplType>, MAX_RESOURCE_SIGNATURES> SRBs;
 
-        // Shader resource cache version for every SRB at the time when the SRB was set
-        std::array<Uint32, MAX_RESOURCE_SIGNATURES> CacheRevisions = {};
-
         // Indicates if the resources have been validated since they were committed
         bool ResourcesValidated = false;
 #endif
@@ -381,6 +421,11 @@ protected:
         // buffers with dynamic offsets in all backends).
         SRBMaskType DynamicSRBMask = 0;
 
+        // Indicates SRBs whose resources were committed and are still bound in the
+        // command buffer, so that committing the same SRB again is redundant unless
+        // its resource cache has been modified.
+        SRBMaskType IntactSRBMask = 0;
+
         void Set(Uint32 Index, ShaderResourceBindingImplType* pSRB)
         {
             VERIFY_EXPR(Index < MAX_RESOURCE_SIGNATURES);
@@ -398,14 +443,30 @@ protected:
             else
                 DynamicSRBMask &= ~SRBBit;
 
+            if (pResourceCache != nullptr)
+                IntactSRBMask |= SRBBit;
+            else
+                IntactSRBMask &= ~SRBBit;
+
+            CacheRevisions[Index] = pResourceCache != nullptr ? pResourceCache->GetRevision() : 0;
+
 #ifdef DILIGENT_DEVELOPMENT
             SRBs[Index] = pSRB;
             if (pSRB != nullptr)
                 ResourcesValidated = false;
-            CacheRevisions[Index] = pResourceCache != nullptr ? pResourceCache->DvpGetRevision() : 0;
 #endif
         }
 
+        // Returns true if the resource cache is already committed at the given index
+        // and has not been modified since then.
+        bool IsIntact(Uint32 Index, const ShaderResourceCacheImplType& ResourceCache) const
+        {
+            VERIFY_EXPR(Index < MAX_RESOURCE_SIGNATURES);
+            return (IntactSRBMask & (1u << Index)) != 0 &&
+                ResourceCaches[Index] == &ResourceCache &&
+                CacheRevisions[Index] == ResourceCache.GetRevision();
+        }
+
         void MakeAllStale()
         {
             StaleSRBMask = 0xFFu;
@@ -439,7 +500,7 @@ protected:
                 const auto* pCache = ResourceCaches[Idx];
                 if (pCache != nullptr)
                 {
-                    DEV_CHECK_ERR(CacheRevisions[Idx] == pCache->DvpGetRevision(),
+                    DEV_CHECK_ERR(CacheRevisions[Idx] == pCache->GetRevision(),
                                   "Revision of the shader resource cache at index ", Idx,
                                   " does not match the revision recorded when the SRB was committed. "
                                   "This indicates that resources have been changed since that time, but "
@@ -465,7 +526,12 @@ protected:
 
     inline bool SetStencilRef(Uint32 StencilRef, int Dummy);
 
-    inline void SetPipelineState(RefCntAutoPtr<PipelineStateImplType> pPipelineState, int /*Dummy*/);
+    /// Casts the pipeline state to the implementation type without adding a reference.
+    /// The context only needs a strong reference if the pipeline state actually changes,
+    /// so the reference counters of a PSO that is shared by many draw calls are not touched.
+    static inline BorrowedPtr<PipelineStateImplType> BorrowPipelineState(IPipelineState* pPipelineState);
+
+    inline void SetPipelineState(BorrowedPtr<PipelineStateImplType> pPipelineState, int /*Dummy*/);
 
     /// Clears all cached resources
     inline void ClearStateCache();
@@ -536,6 +602,7 @@ protected:
     void DvpVerifyBufferState (const BufferImplType&    Buffer,  RESOURCE_STATE RequiredState, const char* OperationName) const;
     void DvpVerifyBLASState   (const BottomLevelASType& BLAS,    RESOURCE_STATE RequiredState, const char* OperationName) const;
     void DvpVerifyTLASState   (const TopLevelASType&    TLAS,    RESOURCE_STATE RequiredState, const char* OperationName) const;
+    void DvpVerifyTextureSubresourceState(const TextureImplType& Texture, const TextureSubresourceRange& Range, RESOURCE_STATE RequiredState, const char* OperationName) const;
     // clang-format on
 
     // Verifies compatibility between current PSO and SRBs
@@ -552,9 +619,56 @@ protected:
     void DvpVerifyBufferState (const BufferImplType&    Buffer,  RESOURCE_STATE RequiredState, const char* OperationName) const {}
     void DvpVerifyBLASState   (const BottomLevelASType& BLAS,    RESOURCE_STATE RequiredState, const char* OperationName) const {}
     void DvpVerifyTLASState   (const TopLevelASType&    TLAS,    RESOURCE_STATE RequiredState, const char* OperationName) const {}
+    void DvpVerifyTextureSubresourceState(const TextureImplType& Texture, const TextureSubresourceRange& Range, RESOURCE_STATE RequiredState, const char* OperationName) const {}
     // clang-format on
 #endif
 
+    static constexpr Uint32 CPUTimeSamplingPeriod = 16;
+
+    /// Times the command it is created in if the command is selected for sampling, see SampleCPUTime().
+    class CPUTimeSample
+    {
+    public:
+        explicit CPUTimeSample(Uint64* pTimeNs) noexcept :
+            m_pTimeNs{pTimeNs}
+        {
+            if (m_pTimeNs != nullptr)
+                m_StartTime = std::chrono::steady_clock::now();
+        }
+
+        ~CPUTimeSample()
+        {
+            if (m_pTimeNs != nullptr)
+            {
+                const auto Elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_StartTime);
+                *m_pTimeNs += static_cast<Uint64>(Elapsed.count()) * CPUTimeSamplingPeriod;
+            }
+        }
+
+        CPUTimeSample(CPUTimeSample&& Other) noexcept :
+            m_pTimeNs{std::exchange(Other.m_pTimeNs, nullptr)},
+            m_StartTime{Other.m_StartTime}
+        {}
+
+        // clang-format off
+        CPUTimeSample           (const CPUTimeSample&)  = delete;
+        CPUTimeSample& operator=(const CPUTimeSample&)  = delete;
+        CPUTimeSample& operator=(      CPUTimeSample&&) = delete;
+        // clang-format on
+
+    private:
+        Uint64*                               m_pTimeNs;
+        std::chrono::steady_clock::time_point m_StartTime;
+    };
+
+    /// Returns an object that accumulates the CPU time of the enclosing draw or dispatch command
+    /// to DeviceContextStats::EstimatedCPUTimeNs. Only every CPUTimeSamplingPeriod-th command is timed.
+    CPUTimeSample SampleCPUTime() noexcept
+    {
+        const bool Sample = (m_CPUTimeSampleCounter++ % CPUTimeSamplingPeriod) == 0;
+        return CPUTimeSample{Sample ? &m_Stats.EstimatedCPUTimeNs : nullptr};
+    }
+
     void Draw(const DrawAttribs& Attribs, int);
     void DrawIndexed(const DrawIndexedAttribs& Attribs, int);
     void DrawIndirect(const DrawIndirectAttribs& Attribs, int);
@@ -584,6 +698,12 @@ protected:
 
     void BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs, int);
 
+    void ResolveQueries(const ResolveQueriesAttribs& Attribs, int);
+    void BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs, int);
+    void EndConditionalRendering(int);
+
+    void SetDynamicRenderState(const DynamicRenderState& State, int) const;
+
 protected:
     static constexpr Uint32 DrawMeshIndirectCommandStride = sizeof(Uint32) * 3; // D3D12: 12 bytes (x, y, z dimension)
                                                                                 // Vulkan: 8 bytes (task count, first task)
@@ -623,11 +743,18 @@ protected:
     Viewport m_Viewports[MAX_VIEWPORTS];
     /// Number of current viewports
     Uint32 m_NumViewports = 0;
+    /// Render target size the current viewports were set for.
+    /// OpenGL computes the window-space origin from the render target height.
+    Uint32 m_ViewportsRTWidth  = 0;
+    Uint32 m_ViewportsRTHeight = 0;
 
     /// Current scissor rects
     Rect m_ScissorRects[MAX_VIEWPORTS];
     /// Number of current scissor rects
     Uint32 m_NumScissorRects = 0;
+    /// Render target size the current scissor rects were set for
+    Uint32 m_ScissorRectsRTWidth  = 0;
+    Uint32 m_ScissorRectsRTHeight = 0;
 
     /// Vector of strong references to the bound render targets.
     /// Use final texture view implementation type to avoid virtual calls to AddRef()/Release()
@@ -643,6 +770,10 @@ protected:
     /// Number of samples in the currently bound framebuffer
     Uint32 m_FramebufferSamples = 0;
 
+    /// Flags that were used when the currently bound render targets were set
+    /// (see SetRenderTargetsAttribs::Flags).
+    SET_RENDER_TARGETS_FLAGS m_RenderTargetsFlags = SET_RENDER_TARGETS_FLAG_NONE;
+
     /// Strong references to the bound depth stencil view.
     /// Use final texture view implementation type to avoid virtual calls to AddRef()/Release()
     RefCntAutoPtr<TextureViewImplType> m_pBoundDepthStencil;
@@ -681,6 +812,13 @@ protected:
 
     DeviceContextStats m_Stats;
 
+    Uint32 m_CPUTimeSampleCounter = 0;
+
+    /// Sort key and index of every packet submitted to SubmitDrawPackets().
+    std::vector<std::pair<Uint64, Uint32>> m_DrawPacketOrder;
+    /// Scratch space for sorting m_DrawPacketOrder.
+    std::vector<std::pair<Uint64, Uint32>> m_DrawPacketSortScratch;
+
     std::vector<Uint8> m_ScratchSpace;
 
 #ifdef DILIGENT_DEBUG
@@ -694,6 +832,10 @@ protected:
 #endif
 #ifdef DILIGENT_DEVELOPMENT
     int m_DvpDebugGroupCount = 0;
+
+    bool m_DvpConditionalRenderingActive = false;
+    // The subpass where the active conditional rendering began, or -1 if it began outside of a render pass
+    Int32 m_DvpConditionalRenderingSubpass = -1;
 #endif
 };
 
@@ -710,13 +852,14 @@ protected:
     } while (false)
 
 template <typename ImplementationTraits>
-inline void DeviceContextBase<ImplementationTraits>::SetVertexBuffers(
+inline bool DeviceContextBase<ImplementationTraits>::SetVertexBuffers(
     Uint32                         StartSlot,
     Uint32                         NumBuffersSet,
     IBuffer* const*                ppBuffers,
     const Uint64*                  pOffsets,
     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
-    SET_VERTEX_BUFFERS_FLAGS       Flags)
+    SET_VERTEX_BUFFERS_FLAGS       Flags,
+    int)
 {
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetVertexBuffers");
 
@@ -730,24 +873,38 @@ inline void DeviceContextBase<ImplementationTraits>::SetVertexBuffers(
                   "Resource state transitions are not allowed inside a render pass and may result in an undefined behavior. "
                   "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
 
+    bool StreamsChanged = false;
     if (Flags & SET_VERTEX_BUFFERS_FLAG_RESET)
     {
         // Reset only these buffer slots that are not being set.
         // It is very important to not reset buffers that stay unchanged
         // as AddRef()/Release() are not free
         for (Uint32 s = 0; s < StartSlot; ++s)
+        {
+            StreamsChanged = StreamsChanged || m_VertexStreams[s].pBuffer;
             m_VertexStreams[s] = VertexStreamInfo<BufferImplType>{};
+        }
         for (Uint32 s = StartSlot + NumBuffersSet; s < m_NumVertexStreams; ++s)
+        {
+            StreamsChanged = StreamsChanged || m_VertexStreams[s].pBuffer;
             m_VertexStreams[s] = VertexStreamInfo<BufferImplType>{};
+        }
         m_NumVertexStreams = 0;
     }
     m_NumVertexStreams = (std::max)(m_NumVertexStreams, StartSlot + NumBuffersSet);
 
     for (Uint32 Buff = 0; Buff < NumBuffersSet; ++Buff)
     {
-        auto& CurrStream   = m_VertexStreams[StartSlot + Buff];
-        CurrStream.pBuffer = ppBuffers ? ClassPtrCast<BufferImplType>(ppBuffers[Buff]) : nullptr;
-        CurrStream.Offset  = pOffsets ? pOffsets[Buff] : 0;
+        auto&           CurrStream = m_VertexStreams[StartSlot + Buff];
+        BufferImplType* pBuffer    = ppBuffers ? ClassPtrCast<BufferImplType>(ppBuffers[Buff]) : nullptr;
+        const Uint64    Offset     = pOffsets ? pOffsets[Buff] : 0;
+        // Only update the stream if it changes to avoid AddRef()/Release()
+        if (CurrStream.pBuffer != pBuffer || CurrStream.Offset != Offset)
+        {
+            CurrStream.pBuffer = pBuffer;
+            CurrStream.Offset  = Offset;
+            StreamsChanged     = true;
+        }
 #ifdef DILIGENT_DEVELOPMENT
         if (CurrStream.pBuffer)
         {
@@ -763,11 +920,24 @@ inline void DeviceContextBase<ImplementationTraits>::SetVertexBuffers(
         m_VertexStreams[m_NumVertexStreams--] = VertexStreamInfo<BufferImplType>{};
 
     ++m_Stats.CommandCounters.SetVertexBuffers;
+    if (!StreamsChanged)
+        ++m_Stats.CommandCounters.RedundantSetVertexBuffers;
+
+    return StreamsChanged;
+}
+
+template <typename ImplementationTraits>
+inline BorrowedPtr<typename DeviceContextBase<ImplementationTraits>::PipelineStateImplType>
+DeviceContextBase<ImplementationTraits>::BorrowPipelineState(IPipelineState* pPipelineState)
+{
+    VERIFY(pPipelineState == nullptr || RefCntAutoPtr<PipelineStateImplType>(pPipelineState, PipelineStateImplType::IID_InternalImpl) != nullptr,
+           "Unknown pipeline state object implementation");
+    return BorrowedPtr<PipelineStateImplType>{ClassPtrCast<PipelineStateImplType>(pPipelineState)};
 }
 
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::SetPipelineState(
-    RefCntAutoPtr<PipelineStateImplType> pPipelineState,
+    BorrowedPtr<PipelineStateImplType> pPipelineState,
     int /*Dummy*/)
 {
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "SetPipelineState");
@@ -775,7 +945,7 @@ inline void DeviceContextBase<ImplementationTraits>::SetPipelineState(
                   "PSO '", pPipelineState->GetDesc().Name, "' can't be used in device context '", m_Desc.Name, "'.");
     DEV_CHECK_ERR(pPipelineState->GetStatus() == PIPELINE_STATE_STATUS_READY, "PSO '", pPipelineState->GetDesc().Name, "' is not ready. Use GetStatus() to check the pipeline status.");
 
-    m_pPipelineState = std::move(pPipelineState);
+    m_pPipelineState = pPipelineState.RawPtr();
     ++m_Stats.CommandCounters.SetPipelineState;
 }
 
@@ -792,6 +962,24 @@ inline void DeviceContextBase<ImplementationTraits>::CommitShaderResources(
 
     DEV_CHECK_ERR(pShaderResourceBinding != nullptr, "pShaderResourceBinding must not be null");
 
+    // Upload inline constants to their buffers. The buffers are dynamic, so this has to be done
+    // every time the SRB is committed.
+    const auto& ResourceCache = ClassPtrCast<ShaderResourceBindingImplType>(pShaderResourceBinding)->GetResourceCache();
+    if (ResourceCache.HasInlineConstants())
+    {
+        auto* const pThis = static_cast<DeviceContextImplType*>(this);
+        for (const auto& InlineConstants : ResourceCache.GetAllInlineConstants())
+        {
+            void* pData = nullptr;
+            pThis->MapBuffer(InlineConstants.pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+            if (pData != nullptr)
+            {
+                memcpy(pData, InlineConstants.Values.data(), InlineConstants.Values.size() * sizeof(Uint32));
+                pThis->UnmapBuffer(InlineConstants.pBuffer, MAP_WRITE);
+            }
+        }
+    }
+
     ++m_Stats.CommandCounters.CommitShaderResources;
 }
 
@@ -804,13 +992,20 @@ inline void DeviceContextBase<ImplementationTraits>::InvalidateState()
 }
 
 template <typename ImplementationTraits>
-inline void DeviceContextBase<ImplementationTraits>::SetIndexBuffer(
+inline bool DeviceContextBase<ImplementationTraits>::SetIndexBuffer(
     IBuffer*                       pIndexBuffer,
     Uint64                         ByteOffset,
-    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+    int)
 {
-    m_pIndexBuffer         = ClassPtrCast<BufferImplType>(pIndexBuffer);
-    m_IndexDataStartOffset = ByteOffset;
+    BufferImplType* pIndexBufferImpl = ClassPtrCast<BufferImplType>(pIndexBuffer);
+
+    const bool IndexBufferChanged = m_pIndexBuffer != pIndexBufferImpl || m_IndexDataStartOffset != ByteOffset;
+    if (IndexBufferChanged)
+    {
+        m_pIndexBuffer         = pIndexBufferImpl;
+        m_IndexDataStartOffset = ByteOffset;
+    }
 
 #ifdef DILIGENT_DEVELOPMENT
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetIndexBuffer");
@@ -828,6 +1023,10 @@ inline void DeviceContextBase<ImplementationTraits>::SetIndexBuffer(
 #endif
 
     ++m_Stats.CommandCounters.SetIndexBuffer;
+    if (!IndexBufferChanged)
+        ++m_Stats.CommandCounters.RedundantSetIndexBuffer;
+
+    return IndexBufferChanged;
 }
 
 
@@ -864,6 +1063,8 @@ inline bool DeviceContextBase<ImplementationTraits>::SetBlendFactors(const float
     }
     if (FactorsDiffer)
         ++m_Stats.CommandCounters.SetBlendFactors;
+    else
+        ++m_Stats.CommandCounters.RedundantSetBlendFactors;
 
     return FactorsDiffer;
 }
@@ -879,11 +1080,12 @@ inline bool DeviceContextBase<ImplementationTraits>::SetStencilRef(Uint32 Stenci
         ++m_Stats.CommandCounters.SetStencilRef;
         return true;
     }
+    ++m_Stats.CommandCounters.RedundantSetStencilRef;
     return false;
 }
 
 template <typename ImplementationTraits>
-inline void DeviceContextBase<ImplementationTraits>::SetViewports(
+inline bool DeviceContextBase<ImplementationTraits>::SetViewports(
     Uint32          NumViewports,
     const Viewport* pViewports,
     Uint32&         RTWidth,
@@ -903,16 +1105,30 @@ inline void DeviceContextBase<ImplementationTraits>::SetViewports(
     }
 
     DEV_CHECK_ERR(NumViewports < MAX_VIEWPORTS, "Number of viewports (", NumViewports, ") exceeds the limit (", MAX_VIEWPORTS, ")");
-    m_NumViewports = (std::min)(MAX_VIEWPORTS, NumViewports);
+    NumViewports = (std::min)(MAX_VIEWPORTS, NumViewports);
 
     Viewport DefaultVP{RTWidth, RTHeight};
     // If no viewports are specified, use default viewport
-    if (m_NumViewports == 1 && pViewports == nullptr)
+    if (NumViewports == 1 && pViewports == nullptr)
     {
         pViewports = &DefaultVP;
     }
     DEV_CHECK_ERR(pViewports != nullptr, "pViewports must not be null");
 
+    ++m_Stats.CommandCounters.SetViewports;
+
+    bool ViewportsChanged = m_NumViewports != NumViewports || m_ViewportsRTWidth != RTWidth || m_ViewportsRTHeight != RTHeight;
+    for (Uint32 vp = 0; vp < NumViewports && !ViewportsChanged; ++vp)
+        ViewportsChanged = m_Viewports[vp] != pViewports[vp];
+    if (!ViewportsChanged)
+    {
+        ++m_Stats.CommandCounters.RedundantSetViewports;
+        return false;
+    }
+
+    m_NumViewports      = NumViewports;
+    m_ViewportsRTWidth  = RTWidth;
+    m_ViewportsRTHeight = RTHeight;
     for (Uint32 vp = 0; vp < m_NumViewports; ++vp)
     {
         m_Viewports[vp] = pViewports[vp];
@@ -921,7 +1137,7 @@ inline void DeviceContextBase<ImplementationTraits>::SetViewports(
         DEV_CHECK_ERR(m_Viewports[vp].MaxDepth >= m_Viewports[vp].MinDepth, "Incorrect viewport depth range [", m_Viewports[vp].MinDepth, ", ", m_Viewports[vp].MaxDepth, "]");
     }
 
-    ++m_Stats.CommandCounters.SetViewports;
+    return true;
 }
 
 template <typename ImplementationTraits>
@@ -936,7 +1152,7 @@ inline void DeviceContextBase<ImplementationTraits>::GetViewports(Uint32& NumVie
 }
 
 template <typename ImplementationTraits>
-inline void DeviceContextBase<ImplementationTraits>::SetScissorRects(
+inline bool DeviceContextBase<ImplementationTraits>::SetScissorRects(
     Uint32      NumRects,
     const Rect* pRects,
     Uint32&     RTWidth,
@@ -956,8 +1172,22 @@ inline void DeviceContextBase<ImplementationTraits>::SetScissorRects(
     }
 
     DEV_CHECK_ERR(NumRects < MAX_VIEWPORTS, "Number of scissor rects (", NumRects, ") exceeds the limit (", MAX_VIEWPORTS, ")");
-    m_NumScissorRects = (std::min)(MAX_VIEWPORTS, NumRects);
+    NumRects = (std::min)(MAX_VIEWPORTS, NumRects);
+
+    ++m_Stats.CommandCounters.SetScissorRects;
+
+    bool RectsChanged = m_NumScissorRects != NumRects || m_ScissorRectsRTWidth != RTWidth || m_ScissorRectsRTHeight != RTHeight;
+    for (Uint32 sr = 0; sr < NumRects && !RectsChanged; ++sr)
+        RectsChanged = m_ScissorRects[sr] != pRects[sr];
+    if (!RectsChanged)
+    {
+        ++m_Stats.CommandCounters.RedundantSetScissorRects;
+        return false;
+    }
 
+    m_NumScissorRects      = NumRects;
+    m_ScissorRectsRTWidth  = RTWidth;
+    m_ScissorRectsRTHeight = RTHeight;
     for (Uint32 sr = 0; sr < m_NumScissorRects; ++sr)
     {
         m_ScissorRects[sr] = pRects[sr];
@@ -965,7 +1195,7 @@ inline void DeviceContextBase<ImplementationTraits>::SetScissorRects(
         DEV_CHECK_ERR(m_ScissorRects[sr].top <= m_ScissorRects[sr].bottom, "Incorrect vertical bounds for a scissor rect [", m_ScissorRects[sr].top, ", ", m_ScissorRects[sr].bottom, ")");
     }
 
-    ++m_Stats.CommandCounters.SetScissorRects;
+    return true;
 }
 
 template <typename ImplementationTraits>
@@ -1162,7 +1392,10 @@ inline bool DeviceContextBase<ImplementationTraits>::SetRenderTargets(const SetR
 #endif
 
     if (bBindRenderTargets)
+    {
+        m_RenderTargetsFlags = Attribs.Flags;
         ++m_Stats.CommandCounters.SetRenderTargets;
+    }
 
     return bBindRenderTargets;
 }
@@ -1177,6 +1410,8 @@ inline bool DeviceContextBase<ImplementationTraits>::SetSubpassRenderTargets()
     const auto& FBDesc  = m_pBoundFramebuffer->GetDesc();
     const auto& Subpass = m_pActiveRenderPass->GetSubpass(m_SubpassIndex);
 
+    // Load and store operations are defined by the render pass
+    m_RenderTargetsFlags = SET_RENDER_TARGETS_FLAG_NONE;
     m_FramebufferSamples = 0;
 
     ITextureView* ppRTVs[MAX_RENDER_TARGETS] = {};
@@ -1302,11 +1537,15 @@ inline void DeviceContextBase<ImplementationTraits>::ClearStateCache()
 
     for (Uint32 vp = 0; vp < m_NumViewports; ++vp)
         m_Viewports[vp] = Viewport();
-    m_NumViewports = 0;
+    m_NumViewports      = 0;
+    m_ViewportsRTWidth  = 0;
+    m_ViewportsRTHeight = 0;
 
     for (Uint32 sr = 0; sr < m_NumScissorRects; ++sr)
         m_ScissorRects[sr] = Rect();
-    m_NumScissorRects = 0;
+    m_NumScissorRects      = 0;
+    m_ScissorRectsRTWidth  = 0;
+    m_ScissorRectsRTHeight = 0;
 
     ResetRenderTargets();
 
@@ -1414,6 +1653,7 @@ void DeviceContextBase<ImplementationTraits>::ResetRenderTargets()
 
     m_pBoundDepthStencil.Release();
     m_pBoundShadingRateMap.Release();
+    m_RenderTargetsFlags = SET_RENDER_TARGETS_FLAG_NONE;
 
     // Do not reset framebuffer here as there may potentially
     // be a subpass without any render target attachments.
@@ -1426,14 +1666,20 @@ inline void DeviceContextBase<ImplementationTraits>::BeginRenderPass(const Begin
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Attempting to begin render pass while another render pass ('", m_pActiveRenderPass->GetDesc().Name, "') is active.");
     DEV_CHECK_ERR(m_pBoundFramebuffer == nullptr, "Attempting to begin render pass while another framebuffer ('", m_pBoundFramebuffer->GetDesc().Name, "') is bound.");
 
-    VerifyBeginRenderPassAttribs(Attribs);
+    VerifyBeginRenderPassAttribs(Attribs, IsDeferred());
+    DEV_CHECK_ERR((Attribs.Flags & BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS) == 0 || m_pDevice->GetDeviceInfo().IsVulkanDevice(),
+                  "BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS is only supported in Vulkan backend");
+
+    // Deferred contexts that inherit the render pass do not start the render pass instance
+    // and must not touch the attachment states: this is done by the immediate context.
+    const bool InheritRenderPass = IsDeferred() && (Attribs.Flags & BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS) != 0;
 
     // Reset current render targets (in Vulkan backend, this may end current render pass).
     ResetRenderTargets();
 
     auto* pNewRenderPass  = ClassPtrCast<RenderPassImplType>(Attribs.pRenderPass);
     auto* pNewFramebuffer = ClassPtrCast<FramebufferImplType>(Attribs.pFramebuffer);
-    if (Attribs.StateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_NONE)
+    if (Attribs.StateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_NONE && !InheritRenderPass)
     {
         const auto& RPDesc = pNewRenderPass->GetDesc();
         const auto& FBDesc = pNewFramebuffer->GetDesc();
@@ -1452,7 +1698,28 @@ inline void DeviceContextBase<ImplementationTraits>::BeginRenderPass(const Begin
 
             auto* pTex          = ClassPtrCast<TextureImplType>(pView->GetTexture());
             auto  RequiredState = RPDesc.pAttachments[i].InitialState;
-            if (Attribs.StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+            if (pTex->HasSubresourceStates())
+            {
+                // Only transition the subresources referenced by the attachment
+                const auto Range = pTex->GetViewSubresourceRange(pView->GetDesc());
+                if (Attribs.StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+                {
+                    if (pTex->IsInKnownState() && !pTex->CheckSubresourceState(Range, RequiredState))
+                    {
+                        StateTransitionDesc Barrier{pTex, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE};
+                        Barrier.FirstMipLevel   = Range.FirstMip;
+                        Barrier.MipLevelsCount  = Range.NumMips;
+                        Barrier.FirstArraySlice = Range.FirstSlice;
+                        Barrier.ArraySliceCount = Range.NumSlices;
+                        this->TransitionResourceStates(1, &Barrier);
+                    }
+                }
+                else if (Attribs.StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
+                {
+                    DvpVerifyTextureSubresourceState(*pTex, Range, RequiredState, "BeginRenderPass");
+                }
+            }
+            else if (Attribs.StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
             {
                 if (pTex->IsInKnownState() && !pTex->CheckState(RequiredState))
                 {
@@ -1470,7 +1737,7 @@ inline void DeviceContextBase<ImplementationTraits>::BeginRenderPass(const Begin
     m_pActiveRenderPass                   = pNewRenderPass;
     m_pBoundFramebuffer                   = pNewFramebuffer;
     m_SubpassIndex                        = 0;
-    m_RenderPassAttachmentsTransitionMode = Attribs.StateTransitionMode;
+    m_RenderPassAttachmentsTransitionMode = InheritRenderPass ? RESOURCE_STATE_TRANSITION_MODE_NONE : Attribs.StateTransitionMode;
 
     UpdateAttachmentStates(m_SubpassIndex);
     SetSubpassRenderTargets();
@@ -1515,7 +1782,10 @@ inline void DeviceContextBase<ImplementationTraits>::UpdateAttachmentStates(Uint
                 auto CurrState = SubpassIndex < RPDesc.SubpassCount ?
                     m_pActiveRenderPass->GetAttachmentState(SubpassIndex, i) :
                     RPDesc.pAttachments[i].FinalState;
-                pTex->SetState(CurrState);
+                if (pTex->HasSubresourceStates())
+                    pTex->SetSubresourceState(pTex->GetViewSubresourceRange(pView->GetDesc()), CurrState);
+                else
+                    pTex->SetState(CurrState);
             }
         }
     }
@@ -1691,6 +1961,7 @@ inline void DeviceContextBase<ImplementationTraits>::UpdateBuffer(
 #endif
 
     ++m_Stats.CommandCounters.UpdateBuffer;
+    m_Stats.UploadBytes += Size;
 }
 
 template <typename ImplementationTraits>
@@ -1810,6 +2081,8 @@ inline void DeviceContextBase<ImplementationTraits>::UpdateTexture(
 
     ValidateUpdateTextureParams(pTexture->GetDesc(), MipLevel, Slice, DstBox, SubresData);
     ++m_Stats.CommandCounters.UpdateTexture;
+    if (SubresData.pData != nullptr)
+        m_Stats.UploadBytes += GetBufferToTextureCopyInfo(pTexture->GetDesc().Format, DstBox, 1).MemorySize;
 }
 
 template <typename ImplementationTraits>
@@ -1824,6 +2097,42 @@ inline void DeviceContextBase<ImplementationTraits>::CopyTexture(const CopyTextu
     ++m_Stats.CommandCounters.CopyTexture;
 }
 
+template <typename ImplementationTraits>
+inline Box DeviceContextBase<ImplementationTraits>::GetUpdateTextureBox(const UpdateTextureAttribs& Update)
+{
+    if (Update.pDstBox != nullptr)
+        return *Update.pDstBox;
+
+    const auto MipProps = GetMipLevelProperties(Update.pTexture->GetDesc(), Update.MipLevel);
+    return Box{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, MipProps.Depth};
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::UpdateTextures(const UpdateTextureAttribs* pUpdates, Uint32 NumUpdates)
+{
+    DEV_CHECK_ERR(pUpdates != nullptr || NumUpdates == 0, "pUpdates must not be null when NumUpdates is not zero");
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update = pUpdates[i];
+        DEV_CHECK_ERR(Update.pTexture != nullptr, "pUpdates[", i, "].pTexture must not be null");
+        if (Update.pTexture == nullptr)
+            continue;
+
+        this->UpdateTexture(Update.pTexture, Update.MipLevel, Update.Slice, GetUpdateTextureBox(Update), Update.SubresData,
+                            Update.SrcBufferTransitionMode, Update.TextureTransitionMode);
+    }
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::CopyTextures(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+{
+    DEV_CHECK_ERR(pCopies != nullptr || NumCopies == 0, "pCopies must not be null when NumCopies is not zero");
+    for (Uint32 i = 0; i < NumCopies; ++i)
+    {
+        this->CopyTexture(pCopies[i]);
+    }
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::MapTextureSubresource(
     ITexture*                 pTexture,
@@ -2126,6 +2435,235 @@ void DeviceContextBase<ImplementationTraits>::BindSparseResourceMemory(const Bin
     ++m_Stats.CommandCounters.BindSparseResourceMemory;
 }
 
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::ResolveQueries(const ResolveQueriesAttribs& Attribs, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "ResolveQueries");
+
+    DEV_CHECK_ERR(m_pDevice->GetDeviceInfo().Features.ConditionalRendering, "IDeviceContext::ResolveQueries: ConditionalRendering feature must be enabled");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "ResolveQueries command must be used outside of render pass.");
+    DEV_CHECK_ERR(Attribs.pDstBuffer != nullptr, "Destination buffer must not be null");
+    DEV_CHECK_ERR(Attribs.ppQueries != nullptr || Attribs.NumQueries == 0, "ppQueries must not be null when NumQueries is not zero");
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        const BufferDesc& DstBuffDesc = Attribs.pDstBuffer->GetDesc();
+        DEV_CHECK_ERR(DstBuffDesc.Usage == USAGE_DEFAULT || DstBuffDesc.Usage == USAGE_SPARSE ||
+                          (DstBuffDesc.Usage == USAGE_STAGING && (DstBuffDesc.CPUAccessFlags & CPU_ACCESS_READ) != 0),
+                      "Unable to resolve queries into buffer '", DstBuffDesc.Name, "': only USAGE_DEFAULT, USAGE_SPARSE and readable USAGE_STAGING buffers are allowed");
+        DEV_CHECK_ERR(Attribs.DstOffset % sizeof(Uint64) == 0, "Unable to resolve queries into buffer '", DstBuffDesc.Name, "': offset (", Attribs.DstOffset, ") must be a multiple of 8");
+        DEV_CHECK_ERR(Attribs.DstOffset + Uint64{Attribs.NumQueries} * sizeof(Uint64) <= DstBuffDesc.Size,
+                      "Unable to resolve queries into buffer '", DstBuffDesc.Name, "': destination range [", Attribs.DstOffset, ",",
+                      Attribs.DstOffset + Uint64{Attribs.NumQueries} * sizeof(Uint64), ") is out of buffer bounds [0,", DstBuffDesc.Size, ")");
+
+        for (Uint32 i = 0; i < Attribs.NumQueries; ++i)
+        {
+            const IQuery* pQuery = Attribs.ppQueries[i];
+            DEV_CHECK_ERR(pQuery != nullptr, "Query ", i, " must not be null");
+            if (pQuery == nullptr)
+                continue;
+
+            const QueryDesc& Desc = pQuery->GetDesc();
+            DEV_CHECK_ERR(Desc.Type == QUERY_TYPE_OCCLUSION || Desc.Type == QUERY_TYPE_BINARY_OCCLUSION || Desc.Type == QUERY_TYPE_TIMESTAMP,
+                          "Query '", Desc.Name, "' is a ", GetQueryTypeString(Desc.Type),
+                          " query. Only occlusion, binary occlusion and timestamp queries can be resolved into a buffer.");
+        }
+    }
+#endif
+
+    ++m_Stats.CommandCounters.ResolveQueries;
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "BeginConditionalRendering");
+
+    DEV_CHECK_ERR(m_pDevice->GetDeviceInfo().Features.ConditionalRendering, "IDeviceContext::BeginConditionalRendering: ConditionalRendering feature must be enabled");
+    DEV_CHECK_ERR(Attribs.pBuffer != nullptr, "Conditional rendering buffer must not be null");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr || Attribs.BufferTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                  "Resource state transitions are not allowed inside a render pass and may result in an undefined behavior. "
+                  "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        DEV_CHECK_ERR(!m_DvpConditionalRenderingActive, "Conditional rendering is already active. Conditional rendering can't be nested.");
+
+        const BufferDesc& BuffDesc = Attribs.pBuffer->GetDesc();
+        DEV_CHECK_ERR((BuffDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                      "Buffer '", BuffDesc.Name, "' can't be used for conditional rendering because it was not created with BIND_INDIRECT_DRAW_ARGS flag");
+        DEV_CHECK_ERR(BuffDesc.Usage != USAGE_DYNAMIC, "Dynamic buffer '", BuffDesc.Name, "' can't be used for conditional rendering");
+        DEV_CHECK_ERR(Attribs.Offset % sizeof(Uint64) == 0, "Conditional rendering offset (", Attribs.Offset, ") must be a multiple of 8");
+        DEV_CHECK_ERR(Attribs.Offset + sizeof(Uint64) <= BuffDesc.Size,
+                      "Conditional rendering offset (", Attribs.Offset, ") is out of bounds of buffer '", BuffDesc.Name, "' of size ", BuffDesc.Size);
+
+        m_DvpConditionalRenderingActive  = true;
+        m_DvpConditionalRenderingSubpass = m_pActiveRenderPass != nullptr ? static_cast<Int32>(m_SubpassIndex) : -1;
+    }
+#endif
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::SetDynamicRenderState(const DynamicRenderState& State, int) const
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetDynamicRenderState");
+
+    DEV_CHECK_ERR(m_pDevice->GetDeviceInfo().Features.ExtendedDynamicState, "IDeviceContext::SetDynamicRenderState: ExtendedDynamicState feature must be enabled");
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        DEV_CHECK_ERR(m_pPipelineState, "IDeviceContext::SetDynamicRenderState: no pipeline state is bound");
+        const PipelineStateDesc& PSODesc = m_pPipelineState->GetDesc();
+        DEV_CHECK_ERR(PSODesc.IsAnyGraphicsPipeline(), "IDeviceContext::SetDynamicRenderState: pipeline '", PSODesc.Name, "' is not a graphics pipeline");
+        DEV_CHECK_ERR(m_pPipelineState->HasExtendedDynamicState(), "IDeviceContext::SetDynamicRenderState: pipeline '", PSODesc.Name,
+                      "' was not created with PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE flag");
+
+        DEV_CHECK_ERR(State.CullMode != CULL_MODE_UNDEFINED, "IDeviceContext::SetDynamicRenderState: CullMode must not be CULL_MODE_UNDEFINED");
+
+        const DepthStencilStateDesc& DSDesc = State.DepthStencilDesc;
+        DEV_CHECK_ERR(!DSDesc.DepthEnable || DSDesc.DepthFunc != COMPARISON_FUNC_UNKNOWN,
+                      "IDeviceContext::SetDynamicRenderState: DepthFunc must not be COMPARISON_FUNC_UNKNOWN when depth is enabled");
+        if (DSDesc.StencilEnable)
+        {
+            for (const StencilOpDesc* pFace : {&DSDesc.FrontFace, &DSDesc.BackFace})
+            {
+                DEV_CHECK_ERR(pFace->StencilFailOp != STENCIL_OP_UNDEFINED && pFace->StencilDepthFailOp != STENCIL_OP_UNDEFINED &&
+                                  pFace->StencilPassOp != STENCIL_OP_UNDEFINED && pFace->StencilFunc != COMPARISON_FUNC_UNKNOWN,
+                              "IDeviceContext::SetDynamicRenderState: stencil operations and functions must be defined when stencil is enabled");
+            }
+        }
+
+        if (State.PrimitiveTopology != PRIMITIVE_TOPOLOGY_UNDEFINED && PSODesc.PipelineType == PIPELINE_TYPE_GRAPHICS)
+        {
+            const auto GetTopologyClass = [](PRIMITIVE_TOPOLOGY Topology) {
+                switch (Topology)
+                {
+                    case PRIMITIVE_TOPOLOGY_POINT_LIST:
+                        return 0;
+
+                    case PRIMITIVE_TOPOLOGY_LINE_LIST:
+                    case PRIMITIVE_TOPOLOGY_LINE_STRIP:
+                    case PRIMITIVE_TOPOLOGY_LINE_LIST_ADJ:
+                    case PRIMITIVE_TOPOLOGY_LINE_STRIP_ADJ:
+                        return 1;
+
+                    case PRIMITIVE_TOPOLOGY_TRIANGLE_LIST:
+                    case PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP:
+                    case PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_ADJ:
+                    case PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_ADJ:
+                        return 2;
+
+                    default:
+                        // Patch lists: the number of control points is baked into the pipeline
+                        return 3 + static_cast<int>(Topology);
+                }
+            };
+
+            const PRIMITIVE_TOPOLOGY PSOTopology = m_pPipelineState->GetGraphicsPipelineDesc().PrimitiveTopology;
+            DEV_CHECK_ERR(GetTopologyClass(State.PrimitiveTopology) == GetTopologyClass(PSOTopology),
+                          "IDeviceContext::SetDynamicRenderState: primitive topology (", Uint32{State.PrimitiveTopology},
+                          ") does not belong to the same topology class as the topology of pipeline '", PSODesc.Name, "' (",
+                          Uint32{PSOTopology}, ")");
+        }
+    }
+#endif
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::EndConditionalRendering(int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "EndConditionalRendering");
+
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        DEV_CHECK_ERR(m_DvpConditionalRenderingActive, "There is no active conditional rendering to end");
+
+        const Int32 Subpass = m_pActiveRenderPass != nullptr ? static_cast<Int32>(m_SubpassIndex) : -1;
+        DEV_CHECK_ERR(Subpass == m_DvpConditionalRenderingSubpass,
+                      "Conditional rendering that begins inside a render pass must end in the same subpass, and conditional rendering "
+                      "that begins outside of a render pass must end outside of a render pass.");
+
+        m_DvpConditionalRenderingActive  = false;
+        m_DvpConditionalRenderingSubpass = -1;
+    }
+#endif
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::SubmitDrawPackets(const DrawPacket* pPackets, Uint32 NumPackets)
+{
+    if (NumPackets == 0)
+        return;
+
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SubmitDrawPackets");
+    DEV_CHECK_ERR(pPackets != nullptr, "pPackets must not be null when NumPackets is not zero");
+
+    m_DrawPacketOrder.resize(NumPackets);
+    m_DrawPacketSortScratch.resize(NumPackets);
+    for (Uint32 i = 0; i < NumPackets; ++i)
+        m_DrawPacketOrder[i] = {pPackets[i].SortKey, i};
+    RadixSort(m_DrawPacketOrder.data(), m_DrawPacketSortScratch.data(), NumPackets,
+              [](const std::pair<Uint64, Uint32>& Item) { return Item.first; });
+
+    // Call the final implementation type directly to avoid virtual calls
+    DeviceContextImplType* const pThis = static_cast<DeviceContextImplType*>(this);
+
+    const DrawPacket* pPrev = nullptr;
+    for (const auto& It : m_DrawPacketOrder)
+    {
+        const DrawPacket& Packet = pPackets[It.second];
+
+        bool PSOChanged = false;
+        if (Packet.pPSO != nullptr && (pPrev == nullptr || Packet.pPSO != pPrev->pPSO))
+        {
+            pThis->SetPipelineState(Packet.pPSO);
+            PSOChanged = true;
+        }
+
+        DEV_CHECK_ERR(Packet.NumSRBs == 0 || Packet.ppSRBs != nullptr, "Draw packet ", It.second, ": ppSRBs must not be null when NumSRBs is not zero");
+        for (Uint32 i = 0; i < Packet.NumSRBs; ++i)
+        {
+            IShaderResourceBinding* pSRB = Packet.ppSRBs[i];
+            if (pSRB == nullptr)
+                continue;
+            if (PSOChanged || pPrev == nullptr || i >= pPrev->NumSRBs || pPrev->ppSRBs[i] != pSRB || pPrev->StateTransitionMode != Packet.StateTransitionMode)
+                pThis->CommitShaderResources(pSRB, Packet.StateTransitionMode);
+        }
+
+        DEV_CHECK_ERR(Packet.NumVertexBuffers == 0 || Packet.ppVertexBuffers != nullptr, "Draw packet ", It.second, ": ppVertexBuffers must not be null when NumVertexBuffers is not zero");
+        bool VBsChanged = pPrev == nullptr || Packet.NumVertexBuffers != pPrev->NumVertexBuffers || Packet.StateTransitionMode != pPrev->StateTransitionMode;
+        for (Uint32 i = 0; i < Packet.NumVertexBuffers && !VBsChanged; ++i)
+        {
+            const Uint64 Offset     = Packet.pVertexOffsets != nullptr ? Packet.pVertexOffsets[i] : 0;
+            const Uint64 PrevOffset = pPrev->pVertexOffsets != nullptr ? pPrev->pVertexOffsets[i] : 0;
+            VBsChanged              = Packet.ppVertexBuffers[i] != pPrev->ppVertexBuffers[i] || Offset != PrevOffset;
+        }
+        if (VBsChanged && Packet.NumVertexBuffers > 0)
+        {
+            pThis->SetVertexBuffers(0, Packet.NumVertexBuffers, Packet.ppVertexBuffers, Packet.pVertexOffsets,
+                                    Packet.StateTransitionMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+        }
+
+        if (Packet.pIndexBuffer != nullptr)
+        {
+            if (pPrev == nullptr ||
+                Packet.pIndexBuffer != pPrev->pIndexBuffer ||
+                Packet.IndexDataStartOffset != pPrev->IndexDataStartOffset ||
+                Packet.StateTransitionMode != pPrev->StateTransitionMode)
+            {
+                pThis->SetIndexBuffer(Packet.pIndexBuffer, Packet.IndexDataStartOffset, Packet.StateTransitionMode);
+            }
+
+            pThis->DrawIndexed({Packet.NumElements, Packet.IndexType, Packet.Flags, Packet.NumInstances,
+                                Packet.FirstElementLocation, Packet.BaseVertex, Packet.FirstInstanceLocation});
+        }
+        else
+        {
+            pThis->Draw({Packet.NumElements, Packet.Flags, Packet.NumInstances,
+                         Packet.FirstElementLocation, Packet.FirstInstanceLocation});
+        }
+
+        pPrev = &Packet;
+    }
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::PrepareCommittedResources(CommittedShaderResources& Resources, Uint32& DvpCompatibleSRBCount)
 {
@@ -2592,6 +3130,28 @@ void DeviceContextBase<ImplementationTraits>::DvpVerifyTextureState(
     }
 }
 
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::DvpVerifyTextureSubresourceState(
+    const TextureImplType&         Texture,
+    const TextureSubresourceRange& Range,
+    RESOURCE_STATE                 RequiredState,
+    const char*                    OperationName) const
+{
+    if (!Texture.HasSubresourceStates())
+    {
+        DvpVerifyTextureState(Texture, RequiredState, OperationName);
+        return;
+    }
+
+    if (Texture.IsInKnownState() && !Texture.CheckSubresourceState(Range, RequiredState))
+    {
+        LOG_ERROR_MESSAGE(OperationName, " requires mip levels ", Range.FirstMip, "..", Range.FirstMip + Range.NumMips - 1,
+                          ", array slices ", Range.FirstSlice, "..", Range.FirstSlice + Range.NumSlices - 1,
+                          " of texture '", Texture.GetDesc().Name, "' to be transitioned to ", GetResourceStateString(RequiredState),
+                          " state. Use appropriate state transition flags or explicitly transition the texture using IDeviceContext::TransitionResourceStates() method.");
+    }
+}
+
 template <typename ImplementationTraits>
 void DeviceContextBase<ImplementationTraits>::DvpVerifyBufferState(
     const BufferImplType& Buffer,
@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Non-virtual device context facade for single-backend builds.
+///
+/// When the engine is built with DILIGENT_STATIC_DISPATCH CMake option, exactly one
+/// rendering backend is enabled and its implementation headers are exposed to the
+/// applications. DeviceContextImpl wraps the device context implementation class of
+/// that backend and calls its methods directly rather than through the IDeviceContext
+/// vtable. Since all implementation classes are final, the compiler resolves the calls
+/// statically; with link-time optimization they can also be inlined.
+
+#if DILIGENT_STATIC_DISPATCH
+
+#    if D3D11_SUPPORTED
+#        include "pch.h"
+#        include "EngineD3D11ImplTraits.hpp"
+#        include "DeviceContextD3D11Impl.hpp"
+#        include "RenderDeviceD3D11Impl.hpp"
+#    elif D3D12_SUPPORTED
+#        include "pch.h"
+#        include "EngineD3D12ImplTraits.hpp"
+#        include "DeviceContextD3D12Impl.hpp"
+#        include "RenderDeviceD3D12Impl.hpp"
+#    elif GL_SUPPORTED || GLES_SUPPORTED
+#        include "pch.h"
+#        include "EngineGLImplTraits.hpp"
+#        include "DeviceContextGLImpl.hpp"
+#        include "RenderDeviceGLImpl.hpp"
+#    elif VULKAN_SUPPORTED
+#        include "pch.h"
+#        include "EngineVkImplTraits.hpp"
+#        include "DeviceContextVkImpl.hpp"
+#        include "RenderDeviceVkImpl.hpp"
+#    elif WEBGPU_SUPPORTED
+#        include "pch.h"
+#        include "EngineWebGPUImplTraits.hpp"
+#        include "DeviceContextWebGPUImpl.hpp"
+#        include "RenderDeviceWebGPUImpl.hpp"
+#    else
+#        error Static dispatch is not supported by the enabled rendering backend
+#    endif
+
+#    include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Thin wrapper over the backend-specific device context implementation.
+
+/// \tparam EngineImplTraits - Engine implementation type traits of the backend (e.g. EngineVkImplTraits).
+///
+/// The facade does not hold a reference to the context; the application must keep
+/// the context alive while the facade is in use.
+template <typename EngineImplTraits>
+class DeviceContextImplFacade
+{
+public:
+    using DeviceContextImplType = typename EngineImplTraits::DeviceContextImplType;
+
+    explicit DeviceContextImplFacade(IDeviceContext* pContext) noexcept :
+        m_pContext{ClassPtrCast<DeviceContextImplType>(pContext)}
+    {
+        VERIFY_EXPR(pContext != nullptr);
+    }
+
+    DeviceContextImplType* operator->() const noexcept { return m_pContext; }
+    DeviceContextImplType& operator*() const noexcept { return *m_pContext; }
+    DeviceContextImplType* GetImpl() const noexcept { return m_pContext; }
+
+    // clang-format off
+    void SetPipelineState(IPipelineState* pPipelineState)
+    {
+        m_pContext->DeviceContextImplType::SetPipelineState(pPipelineState);
+    }
+
+    void CommitShaderResources(IShaderResourceBinding*        pShaderResourceBinding,
+                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+    {
+        m_pContext->DeviceContextImplType::CommitShaderResources(pShaderResourceBinding, StateTransitionMode);
+    }
+
+    void SetVertexBuffers(Uint32                         StartSlot,
+                          Uint32                         NumBuffersSet,
+                          IBuffer* const*                ppBuffers,
+                          const Uint64*                  pOffsets,
+                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                          SET_VERTEX_BUFFERS_FLAGS       Flags = SET_VERTEX_BUFFERS_FLAG_NONE)
+    {
+        m_pContext->DeviceContextImplType::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    }
+
+    void SetIndexBuffer(IBuffer*                       pIndexBuffer,
+                        Uint64                         ByteOffset,
+                        RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+    {
+        m_pContext->DeviceContextImplType::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    }
+
+    void Draw               (const DrawAttribs&                Attribs) { m_pContext->DeviceContextImplType::Draw(Attribs); }
+    void DrawIndexed        (const DrawIndexedAttribs&         Attribs) { m_pContext->DeviceContextImplType::DrawIndexed(Attribs); }
+    void DrawIndirect       (const DrawIndirectAttribs&        Attribs) { m_pContext->DeviceContextImplType::DrawIndirect(Attribs); }
+    void DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs) { m_pContext->DeviceContextImplType::DrawIndexedIndirect(Attribs); }
+    void MultiDraw          (const MultiDrawAttribs&           Attribs) { m_pContext->DeviceContextImplType::MultiDraw(Attribs); }
+    void MultiDrawIndexed   (const MultiDrawIndexedAttribs&    Attribs) { m_pContext->DeviceContextImplType::MultiDrawIndexed(Attribs); }
+
+    void DispatchCompute        (const DispatchComputeAttribs&         Attribs) { m_pContext->DeviceContextImplType::DispatchCompute(Attribs); }
+    void DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs) { m_pContext->DeviceContextImplType::DispatchComputeIndirect(Attribs); }
+    // clang-format on
+
+    void MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
+    {
+        m_pContext->DeviceContextImplType::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
+    }
+
+    void UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
+    {
+        m_pContext->DeviceContextImplType::UnmapBuffer(pBuffer, MapType);
+    }
+
+    void UpdateBuffer(IBuffer*                       pBuffer,
+                      Uint64                         Offset,
+                      Uint64                         Size,
+                      const void*                    pData,
+                      RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+    {
+        m_pContext->DeviceContextImplType::UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
+    }
+
+private:
+    DeviceContextImplType* const m_pContext;
+};
+
+#    if D3D11_SUPPORTED
+using DeviceContextImpl = DeviceContextImplFacade<EngineD3D11ImplTraits>;
+#    elif D3D12_SUPPORTED
+using DeviceContextImpl = DeviceContextImplFacade<EngineD3D12ImplTraits>;
+#    elif GL_SUPPORTED || GLES_SUPPORTED
+using DeviceContextImpl = DeviceContextImplFacade<EngineGLImplTraits>;
+#    elif VULKAN_SUPPORTED
+using DeviceContextImpl = DeviceContextImplFacade<EngineVkImplTraits>;
+#    elif WEBGPU_SUPPORTED
+using DeviceContextImpl = DeviceContextImplFacade<EngineWebGPUImplTraits>;
+#    endif
+
+} // namespace Diligent
+
+#endif // DILIGENT_STATIC_DISPATCH
@@ -30,6 +30,9 @@
 /// Implementation of the Diligent::DeviceObjectArchive class
 
 #include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -44,37 +47,51 @@
 
 // Device object archive structure:
 //
-// | Header |  Resource Data  |  Shader Data  |
+// | Header |  Resource Data  |  OpenGL section  |  D3D11 section  | ... |  WebGPU section  |
+//
+//     |  Header  | = | Magic | Version | API Version | Content Version | Section table | Git Hash |
 //
 //     |  Resource Data  | = | Res1 | Res2 | ... | ResN |
 //
-//         | ResI | = | Type | Name | Common Data |  OpenGL data | D3D11 data | ...  | Metal-iOS data |
+//         | ResI | = | Type | Name | Common Data |
+//
+//     |  Device section  | = | Res1 device data | ... | ResN device data | Shaders |
 //
-//     |  Shader Data  | =  |  OpenGL shaders | D3D11 shaders | ...  | Metal-iOS shaders |
+//         |  Shaders  | = | Count | Compression | [Dictionary] | Shader 0 | Shader 1 | ... |
 //
 // The header contains general information such as:
 // - Magic number
 // - Archive version
 // - API version
-
+// - The offset and the size of each device section
+//
 // Resource data contains an array of resources. Each resource contains:
 // - Type (Signature, Graphics Pipeline, Render Pass, etc.)
 // - Name
 // - Common data (e.g. a resource description)
-// - Device-specific data (e.g. shader indices)
 //
-// Shader data contains an array of shaders for each device type
+// Every device type has its own section that contains the device-specific data
+// of all resources (e.g. shader indices) in the same order as in the resource data,
+// followed by the array of shaders. The section is empty if the archive has no data
+// for the device. Since a process only uses one device type, sections are loaded
+// on demand the first time the device data is accessed.
+//
+// Shaders may be compressed with LZ4 using a dictionary built from all shaders of the
+// section. In this case, every shader is preceded by its decompressed size, and is
+// decompressed the first time it is accessed.
 //
 //
 // For pipelines, device-specific data is the array of shader indices in the
 // archive's shader array, e.g.:
 //
-// | PsoX | = |   Type   |   Name   |   Common Data   |   OpenGL data   |    D3D11 data   | ...
-//              Graphics   "My PSO"    <Description>        {0, 1}             {1, 2}
-//                                                                  ____________|  |
-//                                                                 |               |
-//                                                                 V               V
-// | GL Shader 0 | GL Shader 1 |  ... | D3D11 Shader 0 | D3D11 Shader 1 | D3D11 Shader 2 | ...
+// | PsoX | = |   Type   |   Name   |   Common Data   |
+//              Graphics   "My PSO"    <Description>
+//
+// | OpenGL section | = |  ...  | PsoX data | ... | GL Shader 0 | GL Shader 1 | ...
+//                                 {0, 1}
+//
+// | D3D11 section  | = |  ...  | PsoX data | ... | D3D11 Shader 0 | D3D11 Shader 1 | D3D11 Shader 2 | ...
+//                                 {1, 2}
 
 namespace Diligent
 {
@@ -128,7 +145,7 @@ public:
     };
 
     static constexpr Uint32 HeaderMagicNumber = 0xDE00000A;
-    static constexpr Uint32 ArchiveVersion    = 8;
+    static constexpr Uint32 ArchiveVersion    = 12;
 
     struct ArchiveHeader
     {
@@ -141,6 +158,17 @@ public:
         const char* GitHash        = nullptr;
     };
 
+    // The location of the device section in the archive.
+    struct DeviceSection
+    {
+        Uint64 Offset = 0;
+        Uint64 Size   = 0;
+    };
+    using DeviceSectionsArray = std::array<DeviceSection, static_cast<size_t>(DeviceType::Count)>;
+
+    // The size of the header part that precedes the Git hash: magic number, versions and the section table.
+    static constexpr size_t FixedHeaderSize = sizeof(Uint32) * 4 + sizeof(DeviceSection) * static_cast<size_t>(DeviceType::Count);
+
     struct ResourceData
     {
         // Device-agnostic data (e.g. description)
@@ -220,17 +248,36 @@ public:
         return m_pArchiveData;
     }
 
+    const IFileStream* GetStream() const
+    {
+        return m_pStream;
+    }
+
     Uint32 GetContentVersion() const
     {
         return m_ContentVersion;
     }
 
+    // Sets whether to compress the shaders when the archive is serialized.
+    // Archives that have been deserialized from the data with compressed shaders
+    // are compressed by default.
+    void SetCompressShaders(bool CompressShaders)
+    {
+        m_CompressShaders = CompressShaders;
+    }
+
 public:
     struct CreateInfo
     {
         const IDataBlob* pData          = nullptr;
         Uint32           ContentVersion = ~0u;
         bool             MakeCopy       = false;
+
+        // Archive file stream. If not null, pData must be null. The header and the common
+        // resource data are read immediately, and the device sections are read from the
+        // stream when they are accessed for the first time. The archive keeps a strong
+        // reference to the stream.
+        IFileStream* pStream = nullptr;
     };
     /// Initializes a new device object archive from pData.
     explicit DeviceObjectArchive(const CreateInfo& CI) noexcept(false);
@@ -238,9 +285,23 @@ public:
     /// Initializes an empty archive.
     explicit DeviceObjectArchive(Uint32 ContentVersion = 0) noexcept;
 
+    // clang-format off
+    DeviceObjectArchive           (const DeviceObjectArchive&)  = delete;
+    DeviceObjectArchive           (      DeviceObjectArchive&&) = delete;
+    DeviceObjectArchive& operator=(const DeviceObjectArchive&)  = delete;
+    DeviceObjectArchive& operator=(      DeviceObjectArchive&&) = delete;
+    // clang-format on
+
     void RemoveDeviceData(DeviceType Dev) noexcept(false);
     void AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false);
-    void Merge(const DeviceObjectArchive& Src) noexcept(false);
+    // Merges the resources and the shaders of Src into this archive. If OverrideExisting is true, the resources
+    // of Src replace the resources with the same names, otherwise the existing resources are kept.
+    void Merge(const DeviceObjectArchive& Src, bool OverrideExisting = false) noexcept(false);
+
+    // Fills the empty archive with the resources of New that are not present in Base or differ from
+    // the resources in Base, together with the shaders they use. Resources are compared by content,
+    // and the shaders are deduplicated. Loading the result on top of Base gives the contents of New.
+    void CreateDelta(const DeviceObjectArchive& Base, const DeviceObjectArchive& New) noexcept(false);
 
     bool Deserialize(const CreateInfo& CI) noexcept;
     void Serialize(IFileStream* pStream) const;
@@ -248,6 +309,14 @@ public:
 
     std::string ToString() const;
 
+    // Loads the device section if it has not been loaded yet.
+    // Returns false if the section could not be read.
+    // The method is thread-safe.
+    bool LoadDeviceData(DeviceType Dev) const noexcept;
+
+    // Loads all device sections.
+    bool LoadAllDeviceData() const noexcept;
+
     template <typename ReourceDataType>
     bool LoadResourceCommonData(ResourceType     Type,
                                 const char*      Name,
@@ -282,18 +351,16 @@ public:
 
     auto& GetDeviceShaders(DeviceType Type) noexcept
     {
+        LoadDeviceData(Type);
+        DecompressShaders(static_cast<size_t>(Type));
+        // The shaders may be modified by the caller
+        m_CompressedShaders[static_cast<size_t>(Type)].clear();
         return m_DeviceShaders[static_cast<size_t>(Type)];
     }
 
-    const auto& GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
-    {
-        const auto& DeviceShaders = m_DeviceShaders[static_cast<size_t>(Type)];
-        if (Idx < DeviceShaders.size())
-            return DeviceShaders[Idx];
-
-        static const SerializedData NullData;
-        return NullData;
-    }
+    // Returns the serialized shader, decompressing it if necessary.
+    // The method is thread-safe.
+    const SerializedData& GetSerializedShader(DeviceType Type, size_t Idx) const noexcept;
 
     const auto& GetNamedResources() const
     {
@@ -303,16 +370,60 @@ public:
     void Clear() noexcept;
 
 private:
-    // Named resources
+    bool LoadDeviceSection(size_t DevIdx) const;
+    void SetDeviceDataLoaded(DeviceType Dev) noexcept;
+
+    void DecompressShader(size_t DevIdx, size_t Idx) const noexcept;
+    void DecompressShaders(size_t DevIdx) const noexcept;
+
+private:
+    // Named resources.
+    // Device-specific data of the archives that have been deserialized is loaded by LoadDeviceData().
     std::unordered_map<NamedResourceKey, ResourceData, NamedResourceKey::Hasher> m_NamedResources;
 
-    // Shaders
-    std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
+    // Shaders. Loaded by LoadDeviceData().
+    mutable std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
 
-    // Strong reference to the original data blob.
+    // Strong reference to the original data blob, or to the header and the resource data
+    // if the archive was loaded from a stream.
     // Resources will not make copies and reference this data.
     RefCntAutoPtr<IDataBlob> m_pArchiveData;
 
+    // Archive stream to read the device sections from.
+    RefCntAutoPtr<IFileStream> m_pStream;
+
+    // Device sections of the deserialized archive.
+    DeviceSectionsArray m_DeviceSections{};
+
+    // Resources in the order of the archive resource data, which is also the order of
+    // the device-specific data in the device sections.
+    std::vector<ResourceData*> m_ResourceOrder;
+
+    // Device sections read from the stream.
+    mutable std::array<RefCntAutoPtr<IDataBlob>, static_cast<size_t>(DeviceType::Count)> m_DeviceSectionData;
+
+    mutable std::mutex                                                    m_DeviceDataMtx;
+    mutable std::array<std::atomic<bool>, static_cast<size_t>(DeviceType::Count)> m_DeviceDataLoaded{};
+
+    // Compressed shader that is decompressed into m_DeviceShaders when it is accessed for the first time.
+    struct CompressedShader
+    {
+        // References the archive data
+        SerializedData Data;
+
+        Uint32 Size = 0;
+
+        std::once_flag DecompressFlag;
+    };
+    // Compressed shaders of every device type. Null entries are the shaders that are not compressed.
+    mutable std::array<std::vector<std::unique_ptr<CompressedShader>>, static_cast<size_t>(DeviceType::Count)> m_CompressedShaders;
+
+    // Shader compression dictionaries. Reference the archive data.
+    mutable std::array<SerializedData, static_cast<size_t>(DeviceType::Count)> m_ShaderDictionaries;
+
+    // Set by LoadDeviceSection() if the archive contains compressed shaders.
+    mutable bool m_CompressShaders = false;
+
     Uint32 m_ContentVersion = 0;
 };
 
@@ -31,6 +31,7 @@
 /// Implementation of the Diligent::FenceBase template class
 
 #include <atomic>
+#include <chrono>
 
 #include "DeviceObjectBase.hpp"
 #include "GraphicsTypes.h"
@@ -39,6 +40,42 @@
 namespace Diligent
 {
 
+/// Tracks the time that is left until the timeout of a fence wait expires
+/// (see IFence::WaitWithTimeout() and IRenderDevice::WaitForFences()).
+class FenceWaitTimeout
+{
+public:
+    static constexpr Uint64 Infinite = ~Uint64{0};
+
+    explicit FenceWaitTimeout(Uint64 Timeout) noexcept :
+        m_IsInfinite{Timeout == Infinite},
+        m_Deadline{m_IsInfinite ? Clock::time_point{} : Clock::now() + std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(Timeout < MaxTimeout ? Timeout : MaxTimeout)}}
+    {}
+
+    /// Returns the remaining time in nanoseconds, or Infinite if the wait is not limited.
+    Uint64 GetRemaining() const
+    {
+        if (m_IsInfinite)
+            return Infinite;
+
+        const auto Now = Clock::now();
+        return Now < m_Deadline ?
+            static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_Deadline - Now).count()) :
+            0;
+    }
+
+    bool IsExpired() const { return GetRemaining() == 0; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Longer timeouts are clamped to avoid overflowing the time point (~146 years)
+    static constexpr Uint64 MaxTimeout = Uint64{1} << 62;
+
+    const bool              m_IsInfinite;
+    const Clock::time_point m_Deadline;
+};
+
 /// Template class implementing base functionality of the fence object
 
 /// \tparam EngineImplTraits - Engine implementation type traits.
@@ -61,7 +98,14 @@ public:
     ///							   must not keep a strong reference to the device.
     FenceBase(IReferenceCounters* pRefCounters, RenderDeviceImplType* pDevice, const FenceDesc& Desc, bool bIsDeviceInternal = false) :
         TDeviceObjectBase{pRefCounters, pDevice, Desc, bIsDeviceInternal}
-    {}
+    {
+        if ((this->m_Desc.Flags & FENCE_FLAG_EXPORTABLE) != 0)
+        {
+            const auto& DeviceInfo = this->GetDevice()->GetDeviceInfo();
+            if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && !DeviceInfo.IsVulkanDevice())
+                LOG_ERROR_AND_THROW("Description of fence '", this->m_Desc.Name, "' is invalid: FENCE_FLAG_EXPORTABLE is only supported in Direct3D12 and Vulkan.");
+        }
+    }
 
     ~FenceBase()
     {
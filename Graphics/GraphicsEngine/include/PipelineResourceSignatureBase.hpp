@@ -37,6 +37,7 @@
 #include <functional>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 
 #include "PrivateConstants.h"
 #include "PipelineResourceSignature.h"
@@ -49,6 +50,7 @@
 #include "SRBMemoryAllocator.hpp"
 #include "ShaderResourceCacheCommon.hpp"
 #include "HashUtils.hpp"
+#include "StringPool.hpp"
 
 #if defined(_MSC_VER) && defined(FindResource)
 #    error One of Windows headers leaks FindResource macro, which may result in odd errors. You need to undef the macro.
@@ -220,7 +222,7 @@ public:
         m_Desc.Resources    = m_Resources.data();
 
         auto& Res{m_Resources.back()};
-        Res.Name = m_StringPool.insert(Res.Name).first->c_str();
+        Res.Name = m_StringPool.Intern(Res.Name).GetStr();
     }
 
     template <typename... ArgsType>
@@ -231,7 +233,7 @@ public:
         m_Desc.ImmutableSamplers    = m_ImmutableSamplers.data();
 
         auto& ImtblSam{m_ImmutableSamplers.back()};
-        ImtblSam.SamplerOrTextureName = m_StringPool.insert(ImtblSam.SamplerOrTextureName).first->c_str();
+        ImtblSam.SamplerOrTextureName = m_StringPool.Intern(ImtblSam.SamplerOrTextureName).GetStr();
     }
 
     template <class HandlerType>
@@ -242,7 +244,7 @@ public:
             const char* OrigName = ImtblSam.SamplerOrTextureName;
             Handler(ImtblSam);
             if (ImtblSam.SamplerOrTextureName != OrigName) // Compare pointers, not strings!
-                ImtblSam.SamplerOrTextureName = m_StringPool.insert(ImtblSam.SamplerOrTextureName).first->c_str();
+                ImtblSam.SamplerOrTextureName = m_StringPool.Intern(ImtblSam.SamplerOrTextureName).GetStr();
         }
     }
 
@@ -254,7 +256,7 @@ public:
             const char* OrigName = Res.Name;
             Handler(Res);
             if (Res.Name != OrigName) // Compare pointers, not strings!
-                Res.Name = m_StringPool.insert(Res.Name).first->c_str();
+                Res.Name = m_StringPool.Intern(Res.Name).GetStr();
         }
     }
 
@@ -311,7 +313,7 @@ private:
 
     std::vector<PipelineResourceDesc> m_Resources;
     std::vector<ImmutableSamplerDesc> m_ImmutableSamplers;
-    std::unordered_set<String>        m_StringPool;
+    InternedStringPool                m_StringPool;
 
     PipelineResourceSignatureDesc m_Desc;
 
@@ -529,14 +531,40 @@ public:
             DEV_ERROR("ppShaderResourceBinding must not be null");
             return;
         }
-        DEV_CHECK_ERR(*ppShaderResourceBinding == nullptr, "Overwriting existing shader resource binding pointer may cause memory leaks.");
+
+        CreateShaderResourceBindings(1, ppShaderResourceBinding, InitStaticResources);
+    }
+
+    /// Implementation of IPipelineResourceSignature::CreateShaderResourceBindings.
+    virtual void DILIGENT_CALL_TYPE CreateShaderResourceBindings(Uint32                   NumSRBs,
+                                                                 IShaderResourceBinding** ppShaderResourceBindings,
+                                                                 bool                     InitStaticResources) override final
+    {
+        if (NumSRBs == 0)
+            return;
+
+        if (ppShaderResourceBindings == nullptr)
+        {
+            DEV_ERROR("ppShaderResourceBindings must not be null");
+            return;
+        }
 
         auto* pThisImpl{static_cast<PipelineResourceSignatureImplType*>(this)};
         auto& SRBAllocator{pThisImpl->GetDevice()->GetSRBAllocator()};
-        auto* pResBindingImpl{NEW_RC_OBJ(SRBAllocator, "ShaderResourceBinding instance", ShaderResourceBindingImplType)(pThisImpl)};
-        if (InitStaticResources)
-            pThisImpl->InitializeStaticSRBResources(pResBindingImpl);
-        pResBindingImpl->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBinding));
+        for (Uint32 i = 0; i < NumSRBs; ++i)
+        {
+            DEV_CHECK_ERR(ppShaderResourceBindings[i] == nullptr, "Overwriting existing shader resource binding pointer at index ", i, " may cause memory leaks.");
+
+            auto* pResBindingImpl{NEW_RC_OBJ(SRBAllocator, "ShaderResourceBinding instance", ShaderResourceBindingImplType)(pThisImpl)};
+            if (InitStaticResources)
+            {
+                // The SRB was created by this signature, so there is no need to validate the compatibility
+                // as InitializeStaticSRBResources() does.
+                pThisImpl->CopyStaticResources(pResBindingImpl->GetResourceCache());
+                pResBindingImpl->SetStaticResourcesInitialized();
+            }
+            pResBindingImpl->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBindings + i));
+        }
     }
 
     /// Implementation of IPipelineResourceSignature::InitializeStaticSRBResources.
@@ -610,6 +638,9 @@ public:
         if (!PipelineResourceSignaturesCompatible(This.GetDesc(), Other.GetDesc()))
             return false;
 
+        if (This.m_InlineConstantCounts != Other.m_InlineConstantCounts)
+            return false;
+
         const auto ResCount = This.GetTotalResourceCount();
         VERIFY_EXPR(ResCount == Other.GetTotalResourceCount());
         for (Uint32 r = 0; r < ResCount; ++r)
@@ -677,9 +708,22 @@ public:
 
     /// Finds a resource with the given name in the specified shader stage and returns its
     /// index in m_Desc.Resources[], or InvalidPipelineResourceIndex if the resource is not found.
+    /// The lookup uses the name index built at initialization and does not compare strings linearly.
     Uint32 FindResource(SHADER_TYPE ShaderStage, const char* ResourceName) const
     {
-        return Diligent::FindResource(this->m_Desc.Resources, this->m_Desc.NumResources, ShaderStage, ResourceName);
+        VERIFY_EXPR(ResourceName != nullptr && ResourceName[0] != '\0');
+
+        // Resources with the same name may only be defined in different shader stages, so
+        // the range typically contains a single element.
+        Uint32     ResIndex = InvalidPipelineResourceIndex;
+        const auto Range    = m_ResourceNameToIndex.equal_range(ResourceName);
+        for (auto it = Range.first; it != Range.second; ++it)
+        {
+            if ((GetResourceDesc(it->second).ShaderStages & ShaderStage) != 0)
+                ResIndex = std::min(ResIndex, it->second);
+        }
+        VERIFY_EXPR(ResIndex == Diligent::FindResource(this->m_Desc.Resources, this->m_Desc.NumResources, ShaderStage, ResourceName));
+        return ResIndex;
     }
 
     /// Finds an immutable with the given name in the specified shader stage and returns its
@@ -696,6 +740,14 @@ public:
         return this->m_Desc.Resources[ResIndex];
     }
 
+    /// Returns the number of 32-bit inline constants of the resource with the given index,
+    /// or 0 if the resource was not created with PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag.
+    Uint32 GetInlineConstantCount(Uint32 ResIndex) const
+    {
+        VERIFY_EXPR(ResIndex < this->m_Desc.NumResources);
+        return !m_InlineConstantCounts.empty() ? m_InlineConstantCounts[ResIndex] : 0;
+    }
+
     const ImmutableSamplerDesc& GetImmutableSamplerDesc(Uint32 SampIndex) const
     {
         VERIFY_EXPR(SampIndex < this->m_Desc.NumImmutableSamplers);
@@ -825,6 +877,25 @@ protected:
 
         CopyPipelineResourceSignatureDesc(Allocator, Desc, this->m_Desc, m_ResourceOffsets);
 
+        // Inline constants are backed by a single constant buffer, so the backends see them as
+        // regular constant buffers with array size 1. The number of constants is kept separately.
+        for (Uint32 r = 0; r < this->m_Desc.NumResources; ++r)
+        {
+            auto& ResDesc = const_cast<PipelineResourceDesc&>(this->m_Desc.Resources[r]);
+            if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) == 0)
+                continue;
+
+            if (m_InlineConstantCounts.empty())
+                m_InlineConstantCounts.resize(this->m_Desc.NumResources);
+            m_InlineConstantCounts[r] = ResDesc.ArraySize;
+            ResDesc.ArraySize         = 1;
+        }
+
+        // Keys reference the resource names copied to the signature memory
+        m_ResourceNameToIndex.reserve(this->m_Desc.NumResources);
+        for (Uint32 r = 0; r < this->m_Desc.NumResources; ++r)
+            m_ResourceNameToIndex.emplace(this->m_Desc.Resources[r].Name, r);
+
 #ifdef DILIGENT_DEBUG
         VERIFY_EXPR(m_ResourceOffsets[SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES] == this->m_Desc.NumResources);
         for (Uint32 VarType = 0; VarType < SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES; ++VarType)
@@ -1084,6 +1155,13 @@ protected:
     // Resource offsets (e.g. index of the first resource), for each variable type.
     std::array<Uint16, SHADER_RESOURCE_VARIABLE_TYPE_NUM_TYPES + 1> m_ResourceOffsets = {};
 
+    // Resource name -> index in m_Desc.Resources[], shared by all SRBs created from this signature.
+    std::unordered_multimap<HashMapStringKey, Uint32> m_ResourceNameToIndex;
+
+    // The number of 32-bit inline constants for each resource in m_Desc.Resources[].
+    // Empty if the signature has no inline constants.
+    std::vector<Uint32> m_InlineConstantCounts;
+
     // Shader stages that have resources.
     SHADER_TYPE m_ShaderStages = SHADER_TYPE_UNKNOWN;
 
@@ -48,6 +48,7 @@
 #include "RefCntAutoPtr.hpp"
 #include "AsyncInitializer.hpp"
 #include "GraphicsTypesX.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 namespace Diligent
 {
@@ -404,7 +405,8 @@ public:
         TDeviceObjectBase{pRefCounters, pDevice, CreateInfo.PSODesc, bIsDeviceInternal},
         m_UsingImplicitSignature{CreateInfo.ppResourceSignatures == nullptr ||
                                  CreateInfo.ResourceSignaturesCount == 0 ||
-                                 (GetInternalCreateFlags(CreateInfo) & PSO_CREATE_INTERNAL_FLAG_IMPLICIT_SIGNATURE0) != 0}
+                                 (GetInternalCreateFlags(CreateInfo) & PSO_CREATE_INTERNAL_FLAG_IMPLICIT_SIGNATURE0) != 0},
+        m_ExtendedDynamicState{(CreateInfo.Flags & PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE) != 0}
     {
         try
         {
@@ -772,6 +774,12 @@ public:
         return m_ActiveShaderStages;
     }
 
+    /// Returns true if the pipeline was created with PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE flag.
+    bool HasExtendedDynamicState() const
+    {
+        return m_ExtendedDynamicState;
+    }
+
 protected:
     using TNameToGroupIndexMap = std::unordered_map<HashMapStringKey, Uint32>;
 
@@ -785,19 +793,14 @@ protected:
         const auto& InputLayout = CreateInfo.GraphicsPipeline.InputLayout;
         if (InputLayout.NumElements > 0)
         {
+            ReserveInputLayout(InputLayout, MemPool);
+
             Uint32 BufferSlotsUsed = 0;
-            MemPool.AddSpace<LayoutElement>(InputLayout.NumElements);
             for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
-            {
-                auto& LayoutElem = InputLayout.LayoutElements[i];
-                MemPool.AddSpaceForString(LayoutElem.HLSLSemantic);
-                BufferSlotsUsed = std::max(BufferSlotsUsed, LayoutElem.BufferSlot + 1);
-            }
+                BufferSlotsUsed = std::max(BufferSlotsUsed, InputLayout.LayoutElements[i].BufferSlot + 1);
 
             MemPool.AddSpace<Uint32>(BufferSlotsUsed);
         }
-
-        static_assert(std::is_trivially_destructible<decltype(*InputLayout.LayoutElements)>::value, "Add destructor for this object to Destruct()");
     }
 
     void ReserveSpaceForPipelineDesc(const ComputePipelineStateCreateInfo& CreateInfo,
@@ -883,7 +886,7 @@ protected:
 #ifdef DILIGENT_DEBUG
                  Shaders,
 #endif
-                 CreateInfo = typename PipelineStateCreateInfoXTraits<PSOCreateInfoType>::CreateInfoXType{CreateInfo}](Uint32 ThreadId) mutable //
+                 CreateInfo = PipelineStateCreateInfoCopy<PSOCreateInfoType>{CreateInfo, GetRawAllocator()}](Uint32 ThreadId) mutable //
                 {
 #ifdef DILIGENT_DEBUG
                     for (const ShaderImplType* pShader : Shaders)
@@ -894,6 +897,7 @@ protected:
 #endif
                     try
                     {
+                        ShaderCompilationScope CompilationScope{pThisImpl->m_Desc.Name, true};
                         pThisImpl->InitializePipeline(CreateInfo);
                         pThisImpl->m_Status.store(PIPELINE_STATE_STATUS_READY);
                     }
@@ -910,6 +914,7 @@ protected:
         {
             try
             {
+                ShaderCompilationScope CompilationScope{this->m_Desc.Name, true};
                 pThisImpl->InitializePipeline(CreateInfo);
                 m_Status.store(PIPELINE_STATE_STATUS_READY);
             }
@@ -981,14 +986,7 @@ protected:
         LayoutElement* pLayoutElements = nullptr;
         if (InputLayout.NumElements > 0)
         {
-            pLayoutElements = MemPool.ConstructArray<LayoutElement>(InputLayout.NumElements);
-            for (size_t Elem = 0; Elem < InputLayout.NumElements; ++Elem)
-            {
-                const auto& SrcElem   = InputLayout.LayoutElements[Elem];
-                pLayoutElements[Elem] = SrcElem;
-                VERIFY_EXPR(SrcElem.HLSLSemantic != nullptr);
-                pLayoutElements[Elem].HLSLSemantic = MemPool.CopyString(SrcElem.HLSLSemantic);
-            }
+            pLayoutElements = CopyInputLayout(InputLayout, MemPool);
 
             // Correct description and compute offsets and tight strides
             const auto Strides = ResolveInputLayoutAutoOffsetsAndStrides(pLayoutElements, InputLayout.NumElements);
@@ -1153,69 +1151,28 @@ private:
 
     static void ReserveResourceLayout(const PipelineResourceLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool) noexcept
     {
-        if (SrcLayout.Variables != nullptr)
-        {
-            MemPool.AddSpace<ShaderResourceVariableDesc>(SrcLayout.NumVariables);
-            for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
-            {
-                VERIFY(SrcLayout.Variables[i].Name != nullptr, "Variable name can't be null");
-                MemPool.AddSpaceForString(SrcLayout.Variables[i].Name);
-            }
-        }
-
-        if (SrcLayout.ImmutableSamplers != nullptr)
-        {
-            MemPool.AddSpace<ImmutableSamplerDesc>(SrcLayout.NumImmutableSamplers);
-            for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
-            {
-                VERIFY(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName != nullptr, "Immutable sampler or texture name can't be null");
-                MemPool.AddSpaceForString(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName);
-            }
-        }
-
-        static_assert(std::is_trivially_destructible<decltype(*SrcLayout.Variables)>::value, "Add destructor for this object to Destruct()");
-        static_assert(std::is_trivially_destructible<decltype(*SrcLayout.ImmutableSamplers)>::value, "Add destructor for this object to Destruct()");
+        ReservePipelineResourceLayout(SrcLayout, MemPool);
     }
 
     static void CopyResourceLayout(const PipelineResourceLayoutDesc& SrcLayout, PipelineResourceLayoutDesc& DstLayout, FixedLinearAllocator& MemPool)
     {
-        if (SrcLayout.Variables != nullptr)
+#ifdef DILIGENT_DEVELOPMENT
+        for (Uint32 i = 0; SrcLayout.ImmutableSamplers != nullptr && i < SrcLayout.NumImmutableSamplers; ++i)
         {
-            auto* const Variables = MemPool.ConstructArray<ShaderResourceVariableDesc>(SrcLayout.NumVariables);
-            DstLayout.Variables   = Variables;
-            for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
+            const auto& SrcSmplr    = SrcLayout.ImmutableSamplers[i];
+            const auto& BorderColor = SrcSmplr.Desc.BorderColor;
+            if (!((BorderColor[0] == 0 && BorderColor[1] == 0 && BorderColor[2] == 0 && BorderColor[3] == 0) ||
+                  (BorderColor[0] == 0 && BorderColor[1] == 0 && BorderColor[2] == 0 && BorderColor[3] == 1) ||
+                  (BorderColor[0] == 1 && BorderColor[1] == 1 && BorderColor[2] == 1 && BorderColor[3] == 1)))
             {
-                const auto& SrcVar = SrcLayout.Variables[i];
-                Variables[i]       = SrcVar;
-                Variables[i].Name  = MemPool.CopyString(SrcVar.Name);
+                LOG_WARNING_MESSAGE("Immutable sampler for variable \"", SrcSmplr.SamplerOrTextureName, "\" specifies border color (",
+                                    BorderColor[0], ", ", BorderColor[1], ", ", BorderColor[2], ", ", BorderColor[3],
+                                    "). D3D12 static samplers only allow transparent black (0,0,0,0), opaque black (0,0,0,1) or opaque white (1,1,1,1) as border colors");
             }
         }
-
-        if (SrcLayout.ImmutableSamplers != nullptr)
-        {
-            auto* const ImmutableSamplers = MemPool.ConstructArray<ImmutableSamplerDesc>(SrcLayout.NumImmutableSamplers);
-            DstLayout.ImmutableSamplers   = ImmutableSamplers;
-            for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
-            {
-                const auto& SrcSmplr = SrcLayout.ImmutableSamplers[i];
-#ifdef DILIGENT_DEVELOPMENT
-                {
-                    const auto& BorderColor = SrcSmplr.Desc.BorderColor;
-                    if (!((BorderColor[0] == 0 && BorderColor[1] == 0 && BorderColor[2] == 0 && BorderColor[3] == 0) ||
-                          (BorderColor[0] == 0 && BorderColor[1] == 0 && BorderColor[2] == 0 && BorderColor[3] == 1) ||
-                          (BorderColor[0] == 1 && BorderColor[1] == 1 && BorderColor[2] == 1 && BorderColor[3] == 1)))
-                    {
-                        LOG_WARNING_MESSAGE("Immutable sampler for variable \"", SrcSmplr.SamplerOrTextureName, "\" specifies border color (",
-                                            BorderColor[0], ", ", BorderColor[1], ", ", BorderColor[2], ", ", BorderColor[3],
-                                            "). D3D12 static samplers only allow transparent black (0,0,0,0), opaque black (0,0,0,1) or opaque white (1,1,1,1) as border colors");
-                    }
-                }
 #endif
 
-                ImmutableSamplers[i]                      = SrcSmplr;
-                ImmutableSamplers[i].SamplerOrTextureName = MemPool.CopyString(SrcSmplr.SamplerOrTextureName);
-            }
-        }
+        CopyPipelineResourceLayout(SrcLayout, DstLayout, MemPool);
     }
 
     void ReserveResourceSignatures(const PipelineStateCreateInfo& CreateInfo, FixedLinearAllocator& MemPool)
@@ -1294,6 +1251,9 @@ protected:
     /// True if the pipeline was created using implicit root signature.
     const bool m_UsingImplicitSignature;
 
+    /// True if the pipeline was created with PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE flag.
+    const bool m_ExtendedDynamicState;
+
     std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_UNINITIALIZED};
 
     /// The number of signatures in m_Signatures array.
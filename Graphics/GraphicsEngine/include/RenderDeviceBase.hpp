@@ -35,6 +35,7 @@
 
 #include "RenderDevice.h"
 #include "DeviceObjectBase.hpp"
+#include "FenceBase.hpp"
 #include "Defines.h"
 #include "ResourceMappingImpl.hpp"
 #include "ObjectsRegistry.hpp"
@@ -48,6 +49,8 @@
 #include "STDAllocator.hpp"
 #include "IndexWrapper.hpp"
 #include "ThreadPool.hpp"
+#include "PlatformMisc.hpp"
+#include "CPUProfiler.hpp"
 
 namespace Diligent
 {
@@ -143,7 +146,8 @@ public:
         m_ShaderObjAllocator  {RawMemAllocator, sizeof(ShaderImplType),                    16},
         m_SamplerObjAllocator {RawMemAllocator, sizeof(SamplerImplType),                   32},
         m_PSOAllocator        {RawMemAllocator, sizeof(PipelineStateImplType),             16},
-        m_SRBAllocator        {RawMemAllocator, sizeof(ShaderResourceBindingImplType),     64},
+        // SRBs are frequently created and destroyed from multiple threads, so use thread-local caches
+        m_SRBAllocator        {RawMemAllocator, sizeof(ShaderResourceBindingImplType),     64, 16},
         m_ResMappingAllocator {RawMemAllocator, sizeof(ResourceMappingImpl),                8},
         m_FenceAllocator      {RawMemAllocator, sizeof(FenceImplType),                     16},
         m_QueryAllocator      {RawMemAllocator, sizeof(QueryImplType),                     16},
@@ -343,9 +347,75 @@ public:
         return m_pShaderCompilationThreadPool;
     }
 
+    /// Base implementation of IRenderDevice::WaitForFences() that waits for the fences one by one.
+    /// Backends that support native multi-fence waits override this method.
+    virtual Bool DILIGENT_CALL_TYPE WaitForFences(const WaitForFencesAttribs& Attribs) override
+    {
+        if (Attribs.NumFences == 0)
+            return True;
+        if (!VerifyWaitForFencesAttribs(Attribs))
+            return False;
+
+        FenceWaitTimeout WaitTimeout{Attribs.Timeout};
+        if (Attribs.WaitAll)
+        {
+            for (Uint32 i = 0; i < Attribs.NumFences; ++i)
+            {
+                if (!Attribs.ppFences[i]->WaitWithTimeout(Attribs.pValues[i], WaitTimeout.GetRemaining()))
+                    return False;
+            }
+            return True;
+        }
+
+        // Wait for every fence in turn for a short time slice, so that the fence that
+        // completes first is detected without a noticeable delay.
+        constexpr Uint64 TimeSlice = 100000; // 100 us
+        while (true)
+        {
+            for (Uint32 i = 0; i < Attribs.NumFences; ++i)
+            {
+                if (Attribs.ppFences[i]->GetCompletedValue() >= Attribs.pValues[i])
+                    return True;
+            }
+
+            for (Uint32 i = 0; i < Attribs.NumFences; ++i)
+            {
+                const Uint64 Remaining = WaitTimeout.GetRemaining();
+                if (Remaining == 0)
+                    return False;
+
+                if (Attribs.ppFences[i]->WaitWithTimeout(Attribs.pValues[i], std::min(Remaining, TimeSlice)))
+                    return True;
+            }
+        }
+    }
+
+    /// Base implementation of IRenderDevice::GetMemoryStats() for backends that don't track memory.
+    virtual void DILIGENT_CALL_TYPE GetMemoryStats(DeviceMemoryStats& Stats) override
+    {
+        Stats = DeviceMemoryStats{};
+    }
+
 protected:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) = 0;
 
+    bool VerifyWaitForFencesAttribs(const WaitForFencesAttribs& Attribs) const
+    {
+        DEV_CHECK_ERR(Attribs.ppFences != nullptr, "ppFences must not be null when NumFences (", Attribs.NumFences, ") is not zero");
+        DEV_CHECK_ERR(Attribs.pValues != nullptr, "pValues must not be null when NumFences (", Attribs.NumFences, ") is not zero");
+        if (Attribs.ppFences == nullptr || Attribs.pValues == nullptr)
+            return false;
+
+        for (Uint32 i = 0; i < Attribs.NumFences; ++i)
+        {
+            DEV_CHECK_ERR(Attribs.ppFences[i] != nullptr, "Fence at index ", i, " is null");
+            if (Attribs.ppFences[i] == nullptr)
+                return false;
+        }
+
+        return true;
+    }
+
     void InitShaderCompilationThreadPool(IThreadPool* pShaderCompilationThreadPool, Uint32 NumThreads)
     {
         if (!m_DeviceInfo.Features.AsyncShaderCompilation)
@@ -357,19 +427,37 @@ protected:
         }
         else if (NumThreads != 0)
         {
+#if PLATFORM_EMSCRIPTEN && !defined(__EMSCRIPTEN_PTHREADS__)
+            LOG_INFO_MESSAGE("The engine is built without WebAssembly threads support. Shaders will be compiled on the calling thread.");
+#else
             const Uint32 NumCores = (std::max)(std::thread::hardware_concurrency(), 1u);
 
+            // Keep shader compilation off the performance cores on hybrid CPUs and
+            // run it at lower priority so that it does not steal time from the render thread.
             ThreadPoolCreateInfo ThreadPoolCI;
+            ThreadPoolCI.CorePlacement = ThreadPoolCorePlacement::EfficiencyCores;
+#    if PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_ANDROID
+            ThreadPoolCI.WorkerThreadPriority = ThreadPriority::BelowNormal;
+#    endif
             if (NumThreads == ~0u)
             {
-                // Leave one core for the main thread
-                ThreadPoolCI.NumThreads = (std::max)(NumCores, 2u) - 1u;
+                const CPUTopologyInfo Topology = PlatformMisc::GetCPUTopology();
+                if (Topology.IsHybrid())
+                {
+                    ThreadPoolCI.NumThreads = Topology.NumEfficiencyCores;
+                }
+                else
+                {
+                    // Leave one core for the main thread
+                    ThreadPoolCI.NumThreads = (std::max)(NumCores, 2u) - 1u;
+                }
             }
             else
             {
                 ThreadPoolCI.NumThreads = (std::min)(NumThreads, (std::max)(NumCores * 4, 128u));
             }
             m_pShaderCompilationThreadPool = CreateThreadPool(ThreadPoolCI);
+#endif
         }
     }
     /// Helper template function to facilitate device object creation
@@ -430,6 +518,8 @@ protected:
     template <typename PSOCreateInfoType, typename... ExtraArgsType>
     void CreatePipelineStateImpl(IPipelineState** ppPipelineState, const PSOCreateInfoType& PSOCreateInfo, const ExtraArgsType&... ExtraArgs)
     {
+        DILIGENT_CPU_PROFILE_SCOPE("RenderDevice::CreatePipelineState");
+
         CreateDeviceObject("Pipeline State", PSOCreateInfo.PSODesc, ppPipelineState,
                            [&]() //
                            {
@@ -606,7 +696,7 @@ protected:
     // All state object registries hold raw pointers.
     // This is safe because every object unregisters itself
     // when it is deleted.
-    ObjectsRegistry<SamplerDesc, RefCntAutoPtr<ISampler>>                       m_SamplersRegistry; ///< Sampler state registry
+    ObjectsRegistry<HashedDesc<SamplerDesc>, RefCntAutoPtr<ISampler>>           m_SamplersRegistry; ///< Sampler state registry
     std::vector<TextureFormatInfoExt, STDAllocatorRawMem<TextureFormatInfoExt>> m_TextureFormatsInfo;
     std::vector<bool, STDAllocatorRawMem<bool>>                                 m_TexFmtInfoInitFlags;
 
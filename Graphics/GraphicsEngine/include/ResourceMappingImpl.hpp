@@ -31,6 +31,8 @@
 /// Declaration of the Diligent::ResourceMappingImpl class
 
 #include <unordered_map>
+#include <vector>
+#include <atomic>
 
 #include "ResourceMapping.h"
 #include "ObjectBase.hpp"
@@ -44,6 +46,13 @@ namespace Diligent
 class FixedBlockMemoryAllocator;
 
 /// Implementation of the resource mapping
+
+/// Resources are stored in a hash table protected by a spin lock. GetResource() does not
+/// access the hash table: it searches an immutable snapshot of the mapping that is published
+/// through an atomic pointer, so lookups from multiple threads do not block each other.
+/// Any modification of the mapping discards the snapshot, and the next GetResource() call
+/// rebuilds it under the lock. Mappings that are filled once and then read by many
+/// threads (the typical use case) thus never contend.
 class ResourceMappingImpl : public ObjectBase<IResourceMapping>
 {
 public:
@@ -53,6 +62,7 @@ public:
     /// \param RawMemAllocator - raw memory allocator that is used by the m_HashTable member
     ResourceMappingImpl(IReferenceCounters* pRefCounters, IMemoryAllocator& RawMemAllocator) :
         TObjectBase{pRefCounters},
+        m_RawMemAllocator{RawMemAllocator},
         m_HashTable{STD_ALLOCATOR_RAW_MEM(HashTableElem, RawMemAllocator, "Allocator for unordered_map<ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>")}
     {}
 
@@ -122,8 +132,28 @@ private:
         const Uint32 ArrayIndex;
     };
 
+    // Immutable open-addressing table that is used by GetResource().
+    struct Snapshot;
+
+    // The methods below must be called while m_Lock is held.
+    const Snapshot* CreateSnapshot();
+    void            InvalidateSnapshot();
+    void            ReleaseRetiredSnapshots();
+
+    IMemoryAllocator& m_RawMemAllocator;
+
     Threading::SpinLock m_Lock;
 
+    // Current snapshot, or null if the mapping has been modified since the snapshot was created.
+    std::atomic<const Snapshot*> m_pSnapshot{nullptr};
+
+    // The number of GetResource() calls that may be accessing a snapshot.
+    std::atomic<Uint32> m_NumActiveReaders{0};
+
+    // Snapshots that have been replaced, but may still be accessed by readers.
+    // They are released when there are no active readers.
+    std::vector<const Snapshot*> m_RetiredSnapshots;
+
     using HashTableElem = std::pair<const ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>;
     std::unordered_map<ResMappingHashKey,
                        RefCntAutoPtr<IDeviceObject>,
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Definition of the global resource state epoch
+
+#include <atomic>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Returns the global resource state epoch counter.
+
+/// The epoch is incremented every time the state of a buffer, texture or
+/// top-level acceleration structure changes. Shader resource caches use it to
+/// detect that none of their resources could have changed state since the
+/// last transition pass and skip iterating over all cached resources.
+inline std::atomic<Uint64>& GetResourceStateEpochCounter()
+{
+    static std::atomic<Uint64> Epoch{1};
+    return Epoch;
+}
+
+/// Returns the current value of the global resource state epoch.
+inline Uint64 GetResourceStateEpoch()
+{
+    return GetResourceStateEpochCounter().load(std::memory_order_relaxed);
+}
+
+/// Advances the global resource state epoch.
+inline void IncrementResourceStateEpoch()
+{
+    GetResourceStateEpochCounter().fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace Diligent
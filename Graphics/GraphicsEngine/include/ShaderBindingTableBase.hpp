@@ -32,6 +32,7 @@
 
 #include <unordered_map>
 #include <cstring>
+#include <algorithm>
 
 #include "ShaderBindingTable.h"
 #include "TopLevelASBase.hpp"
@@ -108,8 +109,12 @@ public:
         this->m_MissShadersRecord.clear();
         this->m_CallableShadersRecord.clear();
         this->m_HitGroupsRecord.clear();
-        this->m_Changed = true;
-        this->m_pPSO    = nullptr;
+        this->m_RayGenDirtyRange    = {};
+        this->m_MissDirtyRange      = {};
+        this->m_CallableDirtyRange  = {};
+        this->m_HitGroupsDirtyRange = {};
+        this->m_Changed             = true;
+        this->m_pPSO                = nullptr;
 
         this->m_Desc.pPSO = pPSO;
 
@@ -135,7 +140,8 @@ public:
         this->m_DbgHitGroupBindings.clear();
 #endif
         this->m_HitGroupsRecord.clear();
-        this->m_Changed = true;
+        this->m_HitGroupsDirtyRange = {};
+        this->m_Changed             = true;
     }
 
 
@@ -144,7 +150,8 @@ public:
         VERIFY_EXPR((pData == nullptr) == (DataSize == 0));
         VERIFY_EXPR((pData == nullptr) || (DataSize == this->m_ShaderRecordSize));
 
-        this->m_RayGenShaderRecord.resize(this->m_ShaderRecordStride, Uint8{EmptyElem});
+        ResizeRecords(this->m_RayGenShaderRecord, this->m_RayGenDirtyRange, this->m_ShaderRecordStride);
+        this->m_RayGenDirtyRange.Add(0, this->m_ShaderRecordStride);
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_RayGenShaderRecord.data(), this->m_ShaderRecordStride);
 
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
@@ -161,7 +168,8 @@ public:
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Stride    = this->m_ShaderRecordStride;
         const size_t Offset    = MissIndex * Stride;
-        this->m_MissShadersRecord.resize(std::max(this->m_MissShadersRecord.size(), Offset + Stride), Uint8{EmptyElem});
+        ResizeRecords(this->m_MissShadersRecord, this->m_MissDirtyRange, Offset + Stride);
+        this->m_MissDirtyRange.Add(Offset, Offset + Stride);
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_MissShadersRecord.data() + Offset, Stride);
         std::memcpy(this->m_MissShadersRecord.data() + Offset + GroupSize, pData, DataSize);
@@ -181,7 +189,8 @@ public:
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Offset    = BindingIndex * Stride;
 
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), Offset + Stride), Uint8{EmptyElem});
+        ResizeRecords(this->m_HitGroupsRecord, this->m_HitGroupsDirtyRange, Offset + Stride);
+        this->m_HitGroupsDirtyRange.Add(Offset, Offset + Stride);
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
         std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
@@ -223,7 +232,8 @@ public:
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Offset    = Index * Stride;
 
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), Offset + Stride), Uint8{EmptyElem});
+        ResizeRecords(this->m_HitGroupsRecord, this->m_HitGroupsDirtyRange, Offset + Stride);
+        this->m_HitGroupsDirtyRange.Add(Offset, Offset + Stride);
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
         std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
@@ -274,13 +284,14 @@ public:
         const Uint32 GroupSize  = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Stride     = this->m_ShaderRecordStride;
 
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), EndIndex * Stride), Uint8{EmptyElem});
+        ResizeRecords(this->m_HitGroupsRecord, this->m_HitGroupsDirtyRange, EndIndex * Stride);
         this->m_Changed = true;
 
         for (Uint32 i = 0; i < GeometryCount; ++i)
         {
             Uint32 Index  = BeginIndex + i * Info.HitGroupStride + RayOffsetInHitGroupIndex;
             size_t Offset = Index * Stride;
+            this->m_HitGroupsDirtyRange.Add(Offset, Offset + Stride);
             this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
 
             std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
@@ -312,7 +323,7 @@ public:
 
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Stride    = this->m_ShaderRecordStride;
-        this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), (size_t{Info.LastContributionToHitGroupIndex} + 1) * Stride), Uint8{EmptyElem});
+        ResizeRecords(this->m_HitGroupsRecord, this->m_HitGroupsDirtyRange, (size_t{Info.LastContributionToHitGroupIndex} + 1) * Stride);
         this->m_Changed = true;
 
         for (Uint32 Index = RayOffsetInHitGroupIndex + Info.FirstContributionToHitGroupIndex;
@@ -320,6 +331,7 @@ public:
              Index += Info.HitGroupStride)
         {
             const size_t Offset = Index * Stride;
+            this->m_HitGroupsDirtyRange.Add(Offset, Offset + Stride);
             this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
             std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
 
@@ -340,7 +352,8 @@ public:
 
         const Uint32 GroupSize = this->GetDevice()->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Offset    = size_t{CallableIndex} * size_t{this->m_ShaderRecordStride};
-        this->m_CallableShadersRecord.resize(std::max(this->m_CallableShadersRecord.size(), Offset + this->m_ShaderRecordStride), Uint8{EmptyElem});
+        ResizeRecords(this->m_CallableShadersRecord, this->m_CallableDirtyRange, Offset + this->m_ShaderRecordStride);
+        this->m_CallableDirtyRange.Add(Offset, Offset + this->m_ShaderRecordStride);
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_CallableShadersRecord.data() + Offset, this->m_ShaderRecordStride);
         std::memcpy(this->m_CallableShadersRecord.data() + Offset + GroupSize, pData, DataSize);
@@ -438,10 +451,16 @@ public:
 protected:
     struct BindingTable
     {
+        // Data to write to the buffer at UpdateOffset, or null if the table is up to date.
         const void* pData  = nullptr;
         Uint32      Size   = 0;
         Uint32      Offset = 0;
         Uint32      Stride = 0;
+
+        // The range of the buffer that needs to be updated. Only the records that
+        // have changed since the last update are written.
+        Uint32 UpdateOffset = 0;
+        Uint32 UpdateSize   = 0;
     };
     void GetData(BufferImplType*& pSBTBuffer,
                  BindingTable&    RaygenShaderBindingTable,
@@ -464,14 +483,23 @@ protected:
         // Recreate buffer
         if (m_pBuffer == nullptr || m_pBuffer->GetDesc().Size < BufSize)
         {
+            // Grow the buffer geometrically to avoid reallocations when new records are added
+            const Uint64 OldSize = m_pBuffer != nullptr ? m_pBuffer->GetDesc().Size : 0;
+
             m_pBuffer = nullptr;
 
+            // All records need to be written to the new buffer
+            m_RayGenUploadOffset   = InvalidUploadOffset;
+            m_MissUploadOffset     = InvalidUploadOffset;
+            m_HitGroupUploadOffset = InvalidUploadOffset;
+            m_CallableUploadOffset = InvalidUploadOffset;
+
             String     BuffName = String{this->m_Desc.Name} + " - internal buffer";
             BufferDesc BuffDesc;
             BuffDesc.Name      = BuffName.c_str();
             BuffDesc.Usage     = USAGE_DEFAULT;
             BuffDesc.BindFlags = BIND_RAY_TRACING;
-            BuffDesc.Size      = BufSize;
+            BuffDesc.Size      = std::max(Uint64{BufSize}, AlignUp(OldSize + OldSize / 2, Uint64{ShaderGroupBaseAlignment}));
 
             this->GetDevice()->CreateBuffer(BuffDesc, nullptr, m_pBuffer.template DblPtr<IBuffer>());
             VERIFY_EXPR(m_pBuffer != nullptr);
@@ -482,39 +510,75 @@ protected:
 
         pSBTBuffer = m_pBuffer;
 
-        if (!m_RayGenShaderRecord.empty())
+        InitBindingTable(RaygenShaderBindingTable, m_RayGenShaderRecord, m_RayGenDirtyRange, RayGenOffset, m_RayGenUploadOffset);
+        InitBindingTable(MissShaderBindingTable, m_MissShadersRecord, m_MissDirtyRange, MissShaderOffset, m_MissUploadOffset);
+        InitBindingTable(HitShaderBindingTable, m_HitGroupsRecord, m_HitGroupsDirtyRange, HitGroupOffset, m_HitGroupUploadOffset);
+        InitBindingTable(CallableShaderBindingTable, m_CallableShadersRecord, m_CallableDirtyRange, CallableShadersOffset, m_CallableUploadOffset);
+
+        m_Changed = false;
+    }
+
+private:
+    // Byte range of the records that have changed since the last update.
+    struct DirtyRange
+    {
+        size_t Begin = ~size_t{0};
+        size_t End   = 0;
+
+        void Add(size_t RangeBegin, size_t RangeEnd)
+        {
+            Begin = std::min(Begin, RangeBegin);
+            End   = std::max(End, RangeEnd);
+        }
+
+        bool IsEmpty() const
         {
-            RaygenShaderBindingTable.pData  = m_Changed ? m_RayGenShaderRecord.data() : nullptr;
-            RaygenShaderBindingTable.Offset = RayGenOffset;
-            RaygenShaderBindingTable.Size   = static_cast<Uint32>(m_RayGenShaderRecord.size());
-            RaygenShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            return Begin >= End;
         }
+    };
+
+    static constexpr Uint32 InvalidUploadOffset = ~0u;
 
-        if (!m_MissShadersRecord.empty())
+    static void ResizeRecords(std::vector<Uint8>& Records, DirtyRange& Dirty, size_t Size)
+    {
+        if (Records.size() < Size)
         {
-            MissShaderBindingTable.pData  = m_Changed ? m_MissShadersRecord.data() : nullptr;
-            MissShaderBindingTable.Offset = MissShaderOffset;
-            MissShaderBindingTable.Size   = static_cast<Uint32>(m_MissShadersRecord.size());
-            MissShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            // New records are initialized with empty elements that also need to be written
+            Dirty.Add(Records.size(), Size);
+            Records.resize(Size, Uint8{EmptyElem});
         }
+    }
 
-        if (!m_HitGroupsRecord.empty())
+    void InitBindingTable(BindingTable&             Table,
+                          const std::vector<Uint8>& Records,
+                          DirtyRange&               Dirty,
+                          Uint32                    Offset,
+                          Uint32&                   UploadOffset)
+    {
+        if (Records.empty())
         {
-            HitShaderBindingTable.pData  = m_Changed ? m_HitGroupsRecord.data() : nullptr;
-            HitShaderBindingTable.Offset = HitGroupOffset;
-            HitShaderBindingTable.Size   = static_cast<Uint32>(m_HitGroupsRecord.size());
-            HitShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            Dirty = {};
+            return;
         }
 
-        if (!m_CallableShadersRecord.empty())
+        // If the table has moved in the buffer or the buffer has been recreated, write all records
+        if (UploadOffset != Offset)
+            Dirty.Add(0, Records.size());
+
+        Table.Offset = Offset;
+        Table.Size   = static_cast<Uint32>(Records.size());
+        Table.Stride = this->m_ShaderRecordStride;
+
+        if (!Dirty.IsEmpty())
         {
-            CallableShaderBindingTable.pData  = m_Changed ? m_CallableShadersRecord.data() : nullptr;
-            CallableShaderBindingTable.Offset = CallableShadersOffset;
-            CallableShaderBindingTable.Size   = static_cast<Uint32>(m_CallableShadersRecord.size());
-            CallableShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            VERIFY_EXPR(Dirty.End <= Records.size());
+            Table.pData        = Records.data() + Dirty.Begin;
+            Table.UpdateOffset = Offset + static_cast<Uint32>(Dirty.Begin);
+            Table.UpdateSize   = static_cast<Uint32>(Dirty.End - Dirty.Begin);
         }
 
-        m_Changed = false;
+        UploadOffset = Offset;
+        Dirty        = {};
     }
 
 protected:
@@ -523,6 +587,17 @@ protected:
     std::vector<Uint8> m_CallableShadersRecord;
     std::vector<Uint8> m_HitGroupsRecord;
 
+    DirtyRange m_RayGenDirtyRange;
+    DirtyRange m_MissDirtyRange;
+    DirtyRange m_CallableDirtyRange;
+    DirtyRange m_HitGroupsDirtyRange;
+
+    // Offsets of the tables in the buffer at the time of the last update
+    Uint32 m_RayGenUploadOffset   = InvalidUploadOffset;
+    Uint32 m_MissUploadOffset     = InvalidUploadOffset;
+    Uint32 m_HitGroupUploadOffset = InvalidUploadOffset;
+    Uint32 m_CallableUploadOffset = InvalidUploadOffset;
+
     RefCntAutoPtr<PipelineStateImplType> m_pPSO;
     RefCntAutoPtr<BufferImplType>        m_pBuffer;
 
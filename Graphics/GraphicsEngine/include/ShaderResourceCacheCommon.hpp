@@ -31,8 +31,13 @@
 /// Definition of the common share resource cache constants
 
 #include <atomic>
+#include <vector>
+#include <algorithm>
 
 #include "BasicTypes.h"
+#include "Buffer.h"
+#include "RefCntAutoPtr.hpp"
+#include "ResourceStateEpoch.hpp"
 
 namespace Diligent
 {
@@ -50,24 +55,159 @@ enum class ResourceCacheContentType : Uint8
 class ShaderResourceCacheBase
 {
 public:
-#ifdef DILIGENT_DEVELOPMENT
-    uint32_t DvpGetRevision() const
+    /// Returns the revision of the cache contents.
+
+    /// The revision changes every time a resource is bound to the cache. Implementations
+    /// may keep the revision when a resource is rebound with an identical descriptor.
+    /// Revisions are unique across all caches, so two different caches never
+    /// report the same revision even if one was allocated at the address of
+    /// the other one.
+    uint32_t GetRevision() const
+    {
+        return m_Revision.load(std::memory_order_relaxed);
+    }
+
+    /// Inline constants of a pipeline resource created with PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag.
+    struct InlineConstantsData
+    {
+        /// Resource index in the pipeline resource signature
+        Uint32 ResIndex = 0;
+
+        /// Dynamic uniform buffer that holds the constants on the GPU
+        RefCntAutoPtr<IBuffer> pBuffer;
+
+        /// The current values of the 32-bit constants
+        std::vector<Uint32> Values;
+    };
+
+    /// Returns the inline constants data for the resource with the given index,
+    /// or null if the constants have not been set yet.
+    InlineConstantsData* GetInlineConstants(Uint32 ResIndex)
+    {
+        for (InlineConstantsData& Data : m_InlineConstants)
+        {
+            if (Data.ResIndex == ResIndex)
+                return &Data;
+        }
+        return nullptr;
+    }
+
+    /// Adds inline constants storage for the resource with the given index.
+    InlineConstantsData& AddInlineConstants(Uint32 ResIndex, IBuffer* pBuffer, Uint32 NumConstants)
+    {
+        m_InlineConstants.emplace_back();
+        InlineConstantsData& Data = m_InlineConstants.back();
+        Data.ResIndex             = ResIndex;
+        Data.pBuffer              = pBuffer;
+        Data.Values.resize(NumConstants);
+        return Data;
+    }
+
+    bool HasInlineConstants() const
+    {
+        return !m_InlineConstants.empty();
+    }
+
+    const std::vector<InlineConstantsData>& GetAllInlineConstants() const
     {
-        return m_DvpRevision.load();
+        return m_InlineConstants;
     }
-#endif
 
 protected:
     void UpdateRevision()
     {
-#ifdef DILIGENT_DEVELOPMENT
-        m_DvpRevision.fetch_add(1);
-#endif
+        m_Revision.store(GenerateRevision(), std::memory_order_relaxed);
+    }
+
+    /// Range of cached resources that must be processed by a state transition pass.
+    struct StateTransitionRange
+    {
+        Uint32 First = 0;
+        Uint32 End   = 0;
+        Uint64 Epoch = 0;
+
+        bool IsFullRange(Uint32 TotalResources) const
+        {
+            return First == 0 && End == TotalResources;
+        }
+    };
+
+    /// Marks the resource with the given index as modified since the last state transition pass.
+    void MarkResourceForTransition(Uint32 ResIdx)
+    {
+        m_FirstTransitionRes = std::min(m_FirstTransitionRes, ResIdx);
+        m_EndTransitionRes   = std::max(m_EndTransitionRes, ResIdx + 1);
+    }
+
+    /// Returns the range of resources that need to be processed by the state transition pass.
+
+    /// If no resource in the process changed its state since the last pass that found all
+    /// resources already in the required states, only resources bound after that pass need
+    /// to be processed. Caches that contain resources requiring a barrier on every use
+    /// (e.g. UAVs) are always processed entirely.
+    StateTransitionRange BeginStateTransition(Uint32 TotalResources) const
+    {
+        StateTransitionRange Range;
+        Range.Epoch = GetResourceStateEpoch();
+        if (m_TransitionEpoch == Range.Epoch && !m_HasUnconditionalTransitions)
+        {
+            Range.First = std::min(m_FirstTransitionRes, TotalResources);
+            Range.End   = std::max(std::min(m_EndTransitionRes, TotalResources), Range.First);
+        }
+        else
+        {
+            Range.First = 0;
+            Range.End   = TotalResources;
+        }
+        return Range;
+    }
+
+    /// Completes the state transition pass started by BeginStateTransition().
+
+    /// \param [in] Range                      - Range returned by BeginStateTransition().
+    /// \param [in] TotalResources             - Total number of resources in the cache.
+    /// \param [in] HasUnconditionalTransitions - Whether any processed resource requires
+    ///                                          a barrier every time it is used.
+    void EndStateTransition(const StateTransitionRange& Range, Uint32 TotalResources, bool HasUnconditionalTransitions)
+    {
+        const bool IsFullPass = Range.IsFullRange(TotalResources);
+        if (IsFullPass)
+            m_HasUnconditionalTransitions = HasUnconditionalTransitions;
+        else
+            m_HasUnconditionalTransitions = m_HasUnconditionalTransitions || HasUnconditionalTransitions;
+
+        // If any resource changed its state during the pass, the next pass must process all resources
+        // as resources that were not processed may share the underlying objects with the ones that were.
+        const bool StatesUnchanged = GetResourceStateEpoch() == Range.Epoch;
+        const bool WasValid        = IsFullPass || m_TransitionEpoch == Range.Epoch;
+        m_TransitionEpoch          = (StatesUnchanged && WasValid) ? Range.Epoch : 0;
+
+        m_FirstTransitionRes = ~0u;
+        m_EndTransitionRes   = 0;
+    }
+
+private:
+    static uint32_t GenerateRevision()
+    {
+        static std::atomic<uint32_t> NextRevision{1};
+        return NextRevision.fetch_add(1, std::memory_order_relaxed);
     }
 
-#ifdef DILIGENT_DEVELOPMENT
-    std::atomic<uint32_t> m_DvpRevision{0};
-#endif
+    std::atomic<uint32_t> m_Revision{GenerateRevision()};
+
+    // Resource state epoch at the end of the last transition pass that found all
+    // resources in the required states, or zero if the next pass must process all resources.
+    Uint64 m_TransitionEpoch = 0;
+
+    // Range of resources bound since the last transition pass
+    Uint32 m_FirstTransitionRes = ~0u;
+    Uint32 m_EndTransitionRes   = 0;
+
+    bool m_HasUnconditionalTransitions = false;
+
+    // Inline constants are rare and there are only a few of them in any cache,
+    // so linear search is faster than any map.
+    std::vector<InlineConstantsData> m_InlineConstants;
 };
 
 } // namespace Diligent
@@ -31,14 +31,19 @@
 /// Implementation of the Diligent::ShaderBase template class
 
 #include <vector>
+#include <algorithm>
+#include <cstring>
+#include <string>
 
 #include "ShaderResourceVariable.h"
 #include "PipelineState.h"
+#include "RenderDevice.h"
 #include "StringTools.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ShaderResourceCacheCommon.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -668,7 +673,9 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
 
     virtual void DILIGENT_CALL_TYPE Set(IDeviceObject* pObject, SET_SHADER_RESOURCE_FLAGS Flags) override final
     {
-        static_cast<ThisImplType*>(this)->BindResource(BindResourceInfo{pObject, Flags});
+        DEV_CHECK_ERR((GetDesc().Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) == 0,
+                      "Set() is not allowed for inline constants variable '", GetDesc().Name, "'. Use SetInlineConstants() instead.");
+        static_cast<ThisImplType*>(this)->BindResource(BindResourceInfo{ResolveDefaultView(pObject), Flags});
     }
 
     virtual void DILIGENT_CALL_TYPE SetArray(IDeviceObject* const*     ppObjects,
@@ -681,9 +688,11 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
         DEV_CHECK_ERR(FirstElement + NumElements <= Desc.ArraySize,
                       "SetArray arguments are invalid for '", Desc.Name, "' variable: specified element range (", FirstElement, " .. ",
                       FirstElement + NumElements - 1, ") is out of array bounds 0 .. ", Desc.ArraySize - 1);
+        DEV_CHECK_ERR((Desc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) == 0,
+                      "SetArray() is not allowed for inline constants variable '", Desc.Name, "'. Use SetInlineConstants() instead.");
 
         for (Uint32 elem = 0; elem < NumElements; ++elem)
-            static_cast<ThisImplType*>(this)->BindResource(BindResourceInfo{FirstElement + elem, ppObjects[elem], Flags});
+            static_cast<ThisImplType*>(this)->BindResource(BindResourceInfo{FirstElement + elem, ResolveDefaultView(ppObjects[elem]), Flags});
     }
 
     virtual void DILIGENT_CALL_TYPE SetBufferRange(IDeviceObject*            pObject,
@@ -693,6 +702,7 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
                                                    SET_SHADER_RESOURCE_FLAGS Flags) override
     {
         DEV_CHECK_ERR(GetDesc().ResourceType == SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, "SetBufferRange() is only allowed for constant buffers.");
+        DEV_CHECK_ERR((GetDesc().Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) == 0, "SetBufferRange() is not allowed for inline constants.");
         static_cast<ThisImplType*>(this)->BindResource(BindResourceInfo{ArrayIndex, pObject, Flags, Offset, Size});
     }
 
@@ -706,6 +716,8 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
                           "SetBufferOffset() is not only allowed for variables created with PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS flag.");
             DEV_CHECK_ERR(Desc.VarType != SHADER_RESOURCE_VARIABLE_TYPE_STATIC,
                           "SetBufferOffset() is not allowed for static variables.");
+            DEV_CHECK_ERR((Desc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) == 0,
+                          "SetBufferOffset() is not allowed for inline constants.");
         }
 #endif
 
@@ -713,6 +725,58 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
     }
 
 
+    virtual void DILIGENT_CALL_TYPE SetInlineConstants(const void* pConstants,
+                                                       Uint32      FirstConstant,
+                                                       Uint32      NumConstants) override final
+    {
+        const auto&  Desc               = GetDesc();
+        const auto&  Signature          = m_ParentManager.GetSignature();
+        const Uint32 NumInlineConstants = Signature.GetInlineConstantCount(m_ResIndex);
+        auto&        ResourceCache      = m_ParentManager.GetResourceCache();
+
+        if (NumInlineConstants == 0)
+        {
+            DEV_ERROR("SetInlineConstants() is only allowed for variables created with PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag. "
+                      "Variable '", Desc.Name, "' is not an inline constants variable.");
+            return;
+        }
+        DEV_CHECK_ERR(pConstants != nullptr || NumConstants == 0, "pConstants must not be null");
+        DEV_CHECK_ERR(FirstConstant + NumConstants <= NumInlineConstants,
+                      "SetInlineConstants arguments are invalid for '", Desc.Name, "' variable: specified constant range (", FirstConstant, " .. ",
+                      FirstConstant + NumConstants - 1, ") is out of bounds 0 .. ", NumInlineConstants - 1);
+        VERIFY(ResourceCache.GetContentType() == ResourceCacheContentType::SRB,
+               "Inline constants can't be static. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
+
+        auto* pInlineConstants = ResourceCache.GetInlineConstants(m_ResIndex);
+        if (pInlineConstants == nullptr)
+        {
+            // The buffer is created on first use and is bound to the variable for the lifetime of the SRB.
+            const std::string BufferName = std::string{"Inline constants '"} + Desc.Name + "'";
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name           = BufferName.c_str();
+            BuffDesc.Size           = AlignUp(Uint64{NumInlineConstants} * sizeof(Uint32), Uint64{16});
+            BuffDesc.Usage          = USAGE_DYNAMIC;
+            BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+            IRenderDevice* const   pDevice = Signature.GetDevice();
+            RefCntAutoPtr<IBuffer> pBuffer;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+            if (!pBuffer)
+            {
+                LOG_ERROR_MESSAGE("Failed to create the buffer for inline constants '", Desc.Name, "'.");
+                return;
+            }
+
+            static_cast<ThisImplType*>(this)->BindResource(BindResourceInfo{pBuffer, SET_SHADER_RESOURCE_FLAG_NONE});
+            pInlineConstants = &ResourceCache.AddInlineConstants(m_ResIndex, pBuffer, NumInlineConstants);
+        }
+
+        if (NumConstants > 0)
+            memcpy(&pInlineConstants->Values[FirstConstant], pConstants, NumConstants * sizeof(Uint32));
+    }
+
     virtual SHADER_RESOURCE_VARIABLE_TYPE DILIGENT_CALL_TYPE GetType() const override final
     {
         return GetDesc().VarType;
@@ -749,7 +813,7 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
                 const auto SetResFlags = (Flags & BIND_SHADER_RESOURCES_ALLOW_OVERWRITE) != 0 ?
                     SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE :
                     SET_SHADER_RESOURCE_FLAG_NONE;
-                pThis->BindResource(BindResourceInfo{ArrInd, pObj, SetResFlags});
+                pThis->BindResource(BindResourceInfo{ArrInd, ResolveDefaultView(pObj), SetResFlags});
             }
             else
             {
@@ -792,7 +856,7 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
             {
                 if (auto* pObj = pResourceMapping->GetResource(ResDesc.Name, ArrInd))
                 {
-                    if (pObj != pBoundObj)
+                    if (ResolveDefaultView(pObj) != pBoundObj)
                     {
                         StaleVarTypes |= VarTypeFlag;
                         return;
@@ -804,7 +868,50 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
 
     const PipelineResourceDesc& GetDesc() const { return m_ParentManager.GetResourceDesc(m_ResIndex); }
 
+    Uint32 GetResIndex() const { return m_ResIndex; }
+
 protected:
+    // If a buffer or a texture is bound to a shader resource or unordered access view variable,
+    // returns its default view of the matching type. This lets applications bind resources
+    // directly without creating or looking up views. If the resource does not have such a view,
+    // the original object is returned so that the binding validation reports the error.
+    IDeviceObject* ResolveDefaultView(IDeviceObject* pObject) const
+    {
+        if (pObject == nullptr)
+            return nullptr;
+
+        BUFFER_VIEW_TYPE  BuffViewType = BUFFER_VIEW_UNDEFINED;
+        TEXTURE_VIEW_TYPE TexViewType  = TEXTURE_VIEW_UNDEFINED;
+        switch (GetDesc().ResourceType)
+        {
+            case SHADER_RESOURCE_TYPE_BUFFER_SRV: BuffViewType = BUFFER_VIEW_SHADER_RESOURCE; break;
+            case SHADER_RESOURCE_TYPE_BUFFER_UAV: BuffViewType = BUFFER_VIEW_UNORDERED_ACCESS; break;
+            case SHADER_RESOURCE_TYPE_TEXTURE_SRV: TexViewType = TEXTURE_VIEW_SHADER_RESOURCE; break;
+            case SHADER_RESOURCE_TYPE_TEXTURE_UAV: TexViewType = TEXTURE_VIEW_UNORDERED_ACCESS; break;
+            default:
+                return pObject;
+        }
+
+        IDeviceObject* pView = nullptr;
+        if (BuffViewType != BUFFER_VIEW_UNDEFINED)
+        {
+            if (RefCntAutoPtr<IBuffer> pBuffer{pObject, IID_Buffer})
+                pView = pBuffer->GetDefaultView(BuffViewType);
+            else
+                return pObject;
+        }
+        else
+        {
+            if (RefCntAutoPtr<ITexture> pTexture{pObject, IID_Texture})
+                pView = pTexture->GetDefaultView(TexViewType);
+            else
+                return pObject;
+        }
+
+        // Default views share the reference counters of their resource, so the pointer remains valid.
+        return pView != nullptr ? pView : pObject;
+    }
+
     // Variable manager that owns this variable
     VarManagerType& m_ParentManager;
 
@@ -831,10 +938,11 @@ protected:
         VERIFY(m_pVariables == nullptr, "Destroy() has not been called. The shader variable memory will leak.");
     }
 
-    void Initialize(const PipelineResourceSignatureType& Signature, IMemoryAllocator& Allocator, size_t Size)
+    void Initialize(const PipelineResourceSignatureType& Signature, IMemoryAllocator& Allocator, size_t Size, SHADER_TYPE ShaderType)
     {
         VERIFY_EXPR(m_pSignature == nullptr);
         m_pSignature = &Signature;
+        m_ShaderType = ShaderType;
 
         if (Size > 0)
         {
@@ -860,6 +968,14 @@ protected:
 #endif
     }
 
+    const PipelineResourceSignatureType& GetSignature() const
+    {
+        VERIFY_EXPR(m_pSignature != nullptr);
+        return *m_pSignature;
+    }
+
+    ShaderResourceCacheType& GetResourceCache() { return m_ResourceCache; }
+
     void BindResources(IResourceMapping* pResourceMapping, BIND_SHADER_RESOURCES_FLAGS Flags)
     {
         DEV_CHECK_ERR(pResourceMapping != nullptr, "Failed to bind resources: resource mapping is null");
@@ -890,6 +1006,27 @@ protected:
         }
     }
 
+protected:
+    // Returns the index of the resource in the signature that matches the name in the manager's
+    // shader stage, or InvalidPipelineResourceIndex if there is no such resource.
+    Uint32 FindResourceIndex(const Char* Name) const
+    {
+        VERIFY_EXPR(m_pSignature != nullptr);
+        return m_pSignature->FindResource(m_ShaderType, Name);
+    }
+
+    // Variables are initialized in the order of signature resources, so every array of variables
+    // is sorted by the resource index and can be searched with binary search.
+    template <typename VarType>
+    static VarType* FindVariableByResIndex(VarType* pVariables, Uint32 NumVariables, Uint32 ResIndex)
+    {
+        VarType* const pEnd = pVariables + NumVariables;
+        VarType* const pVar = std::lower_bound(pVariables, pEnd, ResIndex,
+                                               [](const VarType& Var, Uint32 Idx) {
+                                                   return Var.GetResIndex() < Idx;
+                                               });
+        return (pVar != pEnd && pVar->GetResIndex() == ResIndex) ? pVar : nullptr;
+    }
 
 protected:
     IObject& m_Owner;
@@ -902,6 +1039,9 @@ protected:
 
     PipelineResourceSignatureType const* m_pSignature = nullptr;
 
+    // Shader stage whose variables are managed by this object
+    SHADER_TYPE m_ShaderType = SHADER_TYPE_UNKNOWN;
+
     // Memory is allocated through the allocator provided by the pipeline resource signature. If allocation
     // granularity > 1, fixed block memory allocator is used. This ensures that all resources from different
     // shader resource bindings reside in continuous memory. If allocation granularity == 1, raw allocator is used.
@@ -95,6 +95,11 @@ public:
     virtual void DILIGENT_CALL_TYPE SetMaximumFrameLatency(Uint32 MaxLatency) override
     {}
 
+    virtual Bool DILIGENT_CALL_TYPE WaitForNextFrame(Uint32 Timeout) override
+    {
+        return True;
+    }
+
 protected:
     bool Resize(Uint32 NewWidth, Uint32 NewHeight, SURFACE_TRANSFORM NewPreTransform, Int32 Dummy = 0 /*To be different from virtual function*/)
     {
@@ -32,6 +32,7 @@
 
 #include <memory>
 #include <array>
+#include <vector>
 
 #include "Texture.h"
 #include "GraphicsTypes.h"
@@ -40,12 +41,26 @@
 #include "STDAllocator.hpp"
 #include "FormatString.hpp"
 #include "PlatformMisc.hpp"
+#include "ObjectsRegistry.hpp"
+#include "HashUtils.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ResourceStateEpoch.hpp"
 
 namespace Diligent
 {
 
 struct CopyTextureAttribs;
 
+/// Range of texture subresources expressed in mip levels and array slices.
+/// For 3D textures, the array slice range always covers the single slice of the texture.
+struct TextureSubresourceRange
+{
+    Uint32 FirstMip   = 0;
+    Uint32 NumMips    = 0;
+    Uint32 FirstSlice = 0;
+    Uint32 NumSlices  = 0;
+};
+
 /// Validates texture description and throws an exception in case of an error.
 void ValidateTextureDesc(const TextureDesc& TexDesc, const IRenderDevice* pDevice) noexcept(false);
 
@@ -140,12 +155,21 @@ public:
 
         if ((this->m_Desc.BindFlags & BIND_INPUT_ATTACHMENT) != 0)
             this->m_Desc.BindFlags |= BIND_SHADER_RESOURCE;
+
+        if ((this->m_Desc.MiscFlags & MISC_TEXTURE_FLAG_SUBRESOURCE_STATES) != 0)
+        {
+            // Backends that only support whole-resource transitions ignore the flag
+            const auto DeviceType = this->GetDevice()->GetDeviceInfo().Type;
+            if (DeviceType == RENDER_DEVICE_TYPE_D3D12 || DeviceType == RENDER_DEVICE_TYPE_VULKAN)
+                m_SubresourceStates.resize(size_t{this->m_Desc.MipLevels} * size_t{this->m_Desc.GetArraySize()}, RESOURCE_STATE_UNKNOWN);
+        }
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Texture, TDeviceObjectBase)
 
     /// Implementation of ITexture::CreateView(); calls CreateViewInternal() virtual function that
     /// creates texture view for the specific engine implementation.
+    /// If a view with the same description is alive, it is returned instead of creating a new one.
     virtual void DILIGENT_CALL_TYPE CreateView(const struct TextureViewDesc& ViewDesc, ITextureView** ppView) override
     {
         DEV_CHECK_ERR(ViewDesc.ViewType != TEXTURE_VIEW_UNDEFINED, "Texture view type is not specified");
@@ -160,7 +184,27 @@ public:
         else
             UNEXPECTED("Unexpected texture view type.");
 
-        CreateViewInternal(ViewDesc, ppView, false);
+        DEV_CHECK_ERR(ppView != nullptr, "Null pointer provided");
+        if (ppView == nullptr)
+            return;
+        DEV_CHECK_ERR(*ppView == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+        *ppView = nullptr;
+        try
+        {
+            auto pView = m_ViewsRegistry.Get(
+                ViewDesc,
+                [&]() {
+                    RefCntAutoPtr<ITextureView> pNewView;
+                    CreateViewInternal(ViewDesc, &pNewView, false);
+                    return pNewView;
+                });
+            *ppView = pView.Detach();
+        }
+        catch (...)
+        {
+            LOG_ERROR("Failed to create view '", (ViewDesc.Name ? ViewDesc.Name : ""), "' for texture '", this->m_Desc.Name, "'");
+        }
     }
 
     ~TextureBase()
@@ -283,32 +327,194 @@ public:
 
     virtual void DILIGENT_CALL_TYPE SetState(RESOURCE_STATE State) override final
     {
-        this->m_State = State;
+        if (this->m_State != State || m_MixedSubresourceStates)
+        {
+            this->m_State = State;
+            for (auto& SubresState : m_SubresourceStates)
+                SubresState = State;
+            m_MixedSubresourceStates = false;
+            IncrementResourceStateEpoch();
+        }
     }
 
+    /// Implementation of ITexture::GetState().
+    /// If subresources of the texture are in different states, returns RESOURCE_STATE_UNKNOWN.
     virtual RESOURCE_STATE DILIGENT_CALL_TYPE GetState() const override final
     {
         return this->m_State;
     }
 
+    /// Implementation of ITexture::GetSubresourceState().
+    virtual RESOURCE_STATE DILIGENT_CALL_TYPE GetSubresourceState(Uint32 MipLevel, Uint32 ArraySlice) const override final
+    {
+        if (!HasSubresourceStates())
+            return this->m_State;
+
+        DEV_CHECK_ERR(MipLevel < this->m_Desc.MipLevels, "Mip level ", MipLevel, " is out of range: the texture has only ", this->m_Desc.MipLevels, " mip levels");
+        DEV_CHECK_ERR(ArraySlice < this->m_Desc.GetArraySize(), "Array slice ", ArraySlice, " is out of range: the texture has only ", this->m_Desc.GetArraySize(), " slices");
+        return m_SubresourceStates[GetSubresourceIndex(MipLevel, ArraySlice)];
+    }
+
     bool IsInKnownState() const
     {
-        return this->m_State != RESOURCE_STATE_UNKNOWN;
+        return this->m_State != RESOURCE_STATE_UNKNOWN || m_MixedSubresourceStates;
     }
 
     bool CheckState(RESOURCE_STATE State) const
     {
         VERIFY((State & (State - 1)) == 0, "Single state is expected");
         VERIFY(IsInKnownState(), "Texture state is unknown");
+        if (m_MixedSubresourceStates)
+            return CheckSubresourceState(GetSubresourceRange(0, REMAINING_MIP_LEVELS, 0, REMAINING_ARRAY_SLICES), State);
+
         return (this->m_State & State) == State;
     }
 
     bool CheckAnyState(RESOURCE_STATE States) const
     {
         VERIFY(IsInKnownState(), "Texture state is unknown");
+        if (m_MixedSubresourceStates)
+        {
+            for (auto SubresState : m_SubresourceStates)
+            {
+                if ((SubresState & States) != 0)
+                    return true;
+            }
+            return false;
+        }
+
         return (this->m_State & States) != 0;
     }
 
+    /// Returns true if the texture tracks states of individual subresources
+    /// (see MISC_TEXTURE_FLAG_SUBRESOURCE_STATES).
+    bool HasSubresourceStates() const
+    {
+        return !m_SubresourceStates.empty();
+    }
+
+    /// Resolves REMAINING_MIP_LEVELS and REMAINING_ARRAY_SLICES and returns the subresource range.
+    TextureSubresourceRange GetSubresourceRange(Uint32 FirstMip, Uint32 NumMips, Uint32 FirstSlice, Uint32 NumSlices) const
+    {
+        const Uint32 ArraySize = this->m_Desc.GetArraySize();
+        VERIFY_EXPR(FirstMip < this->m_Desc.MipLevels && FirstSlice < ArraySize);
+
+        TextureSubresourceRange Range;
+        Range.FirstMip   = FirstMip;
+        Range.NumMips    = NumMips == REMAINING_MIP_LEVELS ? this->m_Desc.MipLevels - FirstMip : NumMips;
+        Range.FirstSlice = FirstSlice;
+        Range.NumSlices  = NumSlices == REMAINING_ARRAY_SLICES ? ArraySize - FirstSlice : NumSlices;
+        VERIFY_EXPR(Range.FirstMip + Range.NumMips <= this->m_Desc.MipLevels);
+        VERIFY_EXPR(Range.FirstSlice + Range.NumSlices <= ArraySize);
+        return Range;
+    }
+
+    /// Returns the range of subresources referenced by the texture view.
+    TextureSubresourceRange GetViewSubresourceRange(const TextureViewDesc& ViewDesc) const
+    {
+        // Depth slices of a 3D texture view all belong to the same subresource
+        return this->m_Desc.Is3D() ?
+            GetSubresourceRange(ViewDesc.MostDetailedMip, ViewDesc.NumMipLevels, 0, 1) :
+            GetSubresourceRange(ViewDesc.MostDetailedMip, ViewDesc.NumMipLevels, ViewDesc.FirstArraySlice, ViewDesc.NumArraySlices);
+    }
+
+    /// Sets the state of the subresources in the range. The texture must track subresource states.
+    void SetSubresourceState(const TextureSubresourceRange& Range, RESOURCE_STATE State)
+    {
+        VERIFY(HasSubresourceStates(), "The texture does not track subresource states");
+
+        bool StateChanged = false;
+        for (Uint32 Slice = Range.FirstSlice; Slice < Range.FirstSlice + Range.NumSlices; ++Slice)
+        {
+            for (Uint32 Mip = Range.FirstMip; Mip < Range.FirstMip + Range.NumMips; ++Mip)
+            {
+                auto& SubresState = m_SubresourceStates[GetSubresourceIndex(Mip, Slice)];
+                if (SubresState != State)
+                {
+                    SubresState  = State;
+                    StateChanged = true;
+                }
+            }
+        }
+
+        if (StateChanged)
+        {
+            UpdateUniformState();
+            IncrementResourceStateEpoch();
+        }
+    }
+
+    /// Returns true if all subresources in the range are in the given state.
+    bool CheckSubresourceState(const TextureSubresourceRange& Range, RESOURCE_STATE State) const
+    {
+        if (!HasSubresourceStates())
+            return CheckState(State);
+
+        for (Uint32 Slice = Range.FirstSlice; Slice < Range.FirstSlice + Range.NumSlices; ++Slice)
+        {
+            for (Uint32 Mip = Range.FirstMip; Mip < Range.FirstMip + Range.NumMips; ++Mip)
+            {
+                if ((m_SubresourceStates[GetSubresourceIndex(Mip, Slice)] & State) != State)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /// Splits the range into the smallest number of rectangular sub-ranges whose subresources
+    /// share the same state, and calls Handler(const TextureSubresourceRange&, RESOURCE_STATE)
+    /// for every sub-range. Equal runs of mip levels in consecutive slices are merged.
+    /// The handler must not modify the texture state.
+    template <typename HandlerType>
+    void ProcessSubresourceStates(const TextureSubresourceRange& Range, HandlerType&& Handler) const
+    {
+        VERIFY(HasSubresourceStates(), "The texture does not track subresource states");
+
+        struct StateRun
+        {
+            TextureSubresourceRange Range;
+            RESOURCE_STATE          State;
+        };
+        std::vector<StateRun> PendingRuns; // Runs of the previous slice that may be extended
+        std::vector<StateRun> SliceRuns;
+        for (Uint32 Slice = Range.FirstSlice; Slice < Range.FirstSlice + Range.NumSlices; ++Slice)
+        {
+            SliceRuns.clear();
+            for (Uint32 Mip = Range.FirstMip; Mip < Range.FirstMip + Range.NumMips; ++Mip)
+            {
+                const auto State = m_SubresourceStates[GetSubresourceIndex(Mip, Slice)];
+                if (!SliceRuns.empty() && SliceRuns.back().State == State)
+                    ++SliceRuns.back().Range.NumMips;
+                else
+                    SliceRuns.push_back({TextureSubresourceRange{Mip, 1, Slice, 1}, State});
+            }
+
+            // Runs of this slice can only be merged with the previous slice if the layout of runs is identical
+            bool CanMerge = PendingRuns.size() == SliceRuns.size();
+            for (size_t i = 0; i < SliceRuns.size() && CanMerge; ++i)
+            {
+                CanMerge = (PendingRuns[i].State == SliceRuns[i].State &&
+                            PendingRuns[i].Range.FirstMip == SliceRuns[i].Range.FirstMip &&
+                            PendingRuns[i].Range.NumMips == SliceRuns[i].Range.NumMips);
+            }
+
+            if (CanMerge)
+            {
+                for (auto& Run : PendingRuns)
+                    ++Run.Range.NumSlices;
+            }
+            else
+            {
+                for (const auto& Run : PendingRuns)
+                    Handler(Run.Range, Run.State);
+                std::swap(PendingRuns, SliceRuns);
+            }
+        }
+
+        for (const auto& Run : PendingRuns)
+            Handler(Run.Range, Run.State);
+    }
+
     /// Implementation of ITexture::GetDefaultView().
     virtual ITextureView* DILIGENT_CALL_TYPE GetDefaultView(TEXTURE_VIEW_TYPE ViewType) override
     {
@@ -331,6 +537,29 @@ public:
     }
 
 protected:
+    size_t GetSubresourceIndex(Uint32 MipLevel, Uint32 ArraySlice) const
+    {
+        return size_t{ArraySlice} * size_t{this->m_Desc.MipLevels} + size_t{MipLevel};
+    }
+
+    // Updates m_State after states of individual subresources have changed
+    void UpdateUniformState()
+    {
+        VERIFY_EXPR(HasSubresourceStates());
+        const auto FirstState = m_SubresourceStates.front();
+
+        m_MixedSubresourceStates = false;
+        for (auto SubresState : m_SubresourceStates)
+        {
+            if (SubresState != FirstState)
+            {
+                m_MixedSubresourceStates = true;
+                break;
+            }
+        }
+        this->m_State = m_MixedSubresourceStates ? RESOURCE_STATE_UNKNOWN : FirstState;
+    }
+
     void DestroyDefaultViews()
     {
         if (m_pDefaultViews == nullptr)
@@ -395,7 +624,18 @@ protected:
 
     RESOURCE_STATE m_State = RESOURCE_STATE_UNKNOWN;
 
+    // Per-subresource states (MipLevels x ArraySize, mip-major within a slice).
+    // Empty unless the texture was created with MISC_TEXTURE_FLAG_SUBRESOURCE_STATES.
+    std::vector<RESOURCE_STATE> m_SubresourceStates;
+
+    // Whether subresources are in different states, in which case m_State is RESOURCE_STATE_UNKNOWN
+    bool m_MixedSubresourceStates = false;
+
     std::unique_ptr<SparseTextureProperties> m_pSparseProps;
+
+    // Non-default views keyed by their description (the name is ignored).
+    // Views keep strong references to the texture, so the registry only holds weak pointers.
+    ObjectsRegistry<HashedDesc<TextureViewDesc>, RefCntAutoPtr<ITextureView>, HashedDesc<TextureViewDesc>::Hasher> m_ViewsRegistry{64};
 };
 
 } // namespace Diligent
@@ -31,7 +31,9 @@
 /// Implementation of the Diligent::TopLevelASBase template class
 
 #include <unordered_map>
+#include <vector>
 #include <atomic>
+#include <cstring>
 
 #include "TopLevelAS.h"
 #include "BottomLevelASBase.hpp"
@@ -39,6 +41,7 @@
 #include "RenderDeviceBase.hpp"
 #include "StringPool.hpp"
 #include "HashUtils.hpp"
+#include "ResourceStateEpoch.hpp"
 
 namespace Diligent
 {
@@ -116,6 +119,7 @@ public:
             }
 
             this->m_StringPool.Reserve(StringPoolSize, GetRawAllocator());
+            this->m_InstancesByIndex.reserve(InstanceCount);
 
             Uint32 InstanceOffset = BaseContributionToHitGroupIndex;
 
@@ -133,9 +137,10 @@ public:
 #ifdef DILIGENT_DEVELOPMENT
                 Desc.dvpVersion = Desc.pBLAS->DvpGetVersion();
 #endif
-                bool IsUniqueName = this->m_Instances.emplace(NameCopy, Desc).second;
-                if (!IsUniqueName)
+                auto it_inserted = this->m_Instances.emplace(NameCopy, Desc);
+                if (!it_inserted.second)
                     LOG_ERROR_AND_THROW("Instance name must be unique!");
+                this->m_InstancesByIndex.emplace_back(NameCopy, &it_inserted.first->second);
             }
 
             VERIFY_EXPR(this->m_StringPool.GetRemainingSize() == 0);
@@ -177,16 +182,15 @@ public:
 
         for (Uint32 i = 0; i < InstanceCount; ++i)
         {
-            const auto& Inst = pInstances[i];
-            auto        Iter = this->m_Instances.find(Inst.InstanceName);
-
-            if (Iter == this->m_Instances.end())
+            const auto&   Inst  = pInstances[i];
+            InstanceDesc* pDesc = FindInstance(Inst.InstanceName, i);
+            if (pDesc == nullptr)
             {
                 UNEXPECTED("Failed to find instance with name '", Inst.InstanceName, "' in instances from the previous build");
                 return false;
             }
 
-            auto&      Desc      = Iter->second;
+            auto&      Desc      = *pDesc;
             const auto PrevIndex = Desc.ContributionToHitGroupIndex;
             const auto pPrevBLAS = Desc.pBLAS;
 
@@ -227,10 +231,15 @@ public:
         this->m_StringPool.Reserve(Src.m_StringPool.GetReservedSize(), GetRawAllocator());
         this->m_BuildInfo = Src.m_BuildInfo;
 
+        this->m_InstancesByIndex.resize(Src.m_InstancesByIndex.size());
         for (auto& SrcInst : Src.m_Instances)
         {
             const char* NameCopy = this->m_StringPool.CopyString(SrcInst.first.GetStr());
-            this->m_Instances.emplace(NameCopy, SrcInst.second);
+            auto        it       = this->m_Instances.emplace(NameCopy, SrcInst.second).first;
+
+            const Uint32 Index = SrcInst.second.InstanceIndex;
+            VERIFY_EXPR(Index < this->m_InstancesByIndex.size());
+            this->m_InstancesByIndex[Index] = {NameCopy, &it->second};
         }
 
         VERIFY_EXPR(this->m_StringPool.GetRemainingSize() == 0);
@@ -242,15 +251,21 @@ public:
 
     /// Implementation of ITopLevelAS::GetInstanceDesc().
     virtual TLASInstanceDesc DILIGENT_CALL_TYPE GetInstanceDesc(const char* Name) const override final
+    {
+        return GetInstanceDesc(Name, INVALID_INDEX);
+    }
+
+    /// Returns the instance description, see ITopLevelAS::GetInstanceDesc().
+    /// IndexHint is the expected position of the instance in the array used by the last build.
+    TLASInstanceDesc GetInstanceDesc(const char* Name, Uint32 IndexHint) const
     {
         VERIFY_EXPR(Name != nullptr && Name[0] != '\0');
 
         TLASInstanceDesc Result = {};
 
-        auto Iter = this->m_Instances.find(Name);
-        if (Iter != this->m_Instances.end())
+        if (const InstanceDesc* pInst = FindInstance(Name, IndexHint))
         {
-            const auto& Inst                   = Iter->second;
+            const auto& Inst                   = *pInst;
             Result.ContributionToHitGroupIndex = Inst.ContributionToHitGroupIndex;
             Result.InstanceIndex               = Inst.InstanceIndex;
             Result.pBLAS                       = Inst.pBLAS;
@@ -276,7 +291,11 @@ public:
     {
         VERIFY(State == RESOURCE_STATE_UNKNOWN || State == RESOURCE_STATE_BUILD_AS_READ || State == RESOURCE_STATE_BUILD_AS_WRITE || State == RESOURCE_STATE_RAY_TRACING,
                "Unsupported state for top-level acceleration structure");
-        this->m_State = State;
+        if (this->m_State != State)
+        {
+            this->m_State = State;
+            IncrementResourceStateEpoch();
+        }
     }
 
     /// Implementation of ITopLevelAS::GetState().
@@ -344,9 +363,30 @@ public:
 #endif // DILIGENT_DEVELOPMENT
 
 private:
+    // Instances are typically passed in the same order in every build, in which case
+    // the instance at the hinted index is checked first to avoid the hash map lookup.
+    const InstanceDesc* FindInstance(const char* Name, Uint32 IndexHint) const
+    {
+        if (IndexHint < this->m_InstancesByIndex.size())
+        {
+            const auto& NameAndInst = this->m_InstancesByIndex[IndexHint];
+            if (strcmp(NameAndInst.first, Name) == 0)
+                return NameAndInst.second;
+        }
+
+        auto Iter = this->m_Instances.find(Name);
+        return Iter != this->m_Instances.end() ? &Iter->second : nullptr;
+    }
+
+    InstanceDesc* FindInstance(const char* Name, Uint32 IndexHint)
+    {
+        return const_cast<InstanceDesc*>(static_cast<const TopLevelASBase*>(this)->FindInstance(Name, IndexHint));
+    }
+
     void ClearInstanceData()
     {
         this->m_Instances.clear();
+        this->m_InstancesByIndex.clear();
         this->m_StringPool.Clear();
 
         this->m_BuildInfo.BindingMode                      = HIT_GROUP_BINDING_MODE_LAST;
@@ -389,6 +429,9 @@ protected:
 
     std::unordered_map<HashMapStringKey, InstanceDesc> m_Instances;
 
+    // Instance names and descriptions indexed by InstanceDesc::InstanceIndex
+    std::vector<std::pair<const char*, InstanceDesc*>> m_InstancesByIndex;
+
     StringPool m_StringPool;
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -257,6 +257,12 @@ DILIGENT_BEGIN_INTERFACE(IBuffer, IDeviceObject)
     ///          of the ViewDesc structure and leave all other members in their default values.\n
     ///          Buffer view will contain strong reference to the buffer, so the buffer will not be destroyed
     ///          until all views are released.\n
+    ///          Views are cached by the buffer: if a view with an identical description (ignoring the name)
+    ///          was created before and is still alive, the function returns that view instead of creating
+    ///          a new one. The views with the first eight distinct descriptions are kept alive by the buffer
+    ///          until it is destroyed and are never evicted. Other views are destroyed when the last
+    ///          reference is released, so a view that is created and released every frame is recreated
+    ///          every frame unless it is one of the first eight.\n
     ///          The function calls AddRef() for the created interface, so it must be released by
     ///          a call to Release() when it is no longer needed.
     VIRTUAL void METHOD(CreateView)(THIS_
@@ -137,6 +137,10 @@ struct BufferViewDesc DILIGENT_DERIVE(DeviceObjectAttribs)
                ByteWidth == RHS.ByteWidth  &&
                Format    == RHS.Format;
     }
+    constexpr bool operator!=(const BufferViewDesc& RHS) const
+    {
+        return !(*this == RHS);
+    }
 #endif
 };
 typedef struct BufferViewDesc BufferViewDesc;
@@ -37,6 +37,40 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static DILIGENT_CONSTEXPR INTERFACE_ID IID_CommandQueue =
     {0xff427f7, 0x6284, 0x409e, {0x81, 0x61, 0xa0, 0x23, 0xca, 0x7, 0xef, 0x5d}};
 
+/// Calibrated pair of GPU and CPU timestamps, see ICommandQueue::GetTimestampCalibration().
+
+/// The CPU clock is the one std::chrono::steady_clock is based on: QueryPerformanceCounter
+/// on Windows and CLOCK_MONOTONIC on other platforms.
+struct TimestampCalibration
+{
+    /// GPU timestamp in the same time domain as the values returned by timestamp queries
+    /// (see Diligent::QueryDataTimestamp) recorded by the command queue.
+    Uint64 GPUTimestamp DEFAULT_INITIALIZER(0);
+
+    /// GPU timestamp frequency, in Hz (ticks/second).
+    Uint64 GPUFrequency DEFAULT_INITIALIZER(0);
+
+    /// CPU timestamp sampled at the same moment as GPUTimestamp.
+    Uint64 CPUTimestamp DEFAULT_INITIALIZER(0);
+
+    /// CPU timestamp frequency, in Hz (ticks/second).
+    Uint64 CPUFrequency DEFAULT_INITIALIZER(0);
+
+    /// The maximum deviation between the two timestamps, in nanoseconds,
+    /// or 0 if the backend does not report it.
+    Uint64 MaxDeviation DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    /// Converts a GPU timestamp to the CPU time base, in seconds.
+    double GPUTimestampToCPUSeconds(Uint64 Timestamp) const
+    {
+        const double GPUDelta = static_cast<double>(static_cast<Int64>(Timestamp - GPUTimestamp)) / static_cast<double>(GPUFrequency);
+        return static_cast<double>(CPUTimestamp) / static_cast<double>(CPUFrequency) + GPUDelta;
+    }
+#endif
+};
+typedef struct TimestampCalibration TimestampCalibration;
+
 #define DILIGENT_INTERFACE_NAME ICommandQueue
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -57,6 +91,21 @@ DILIGENT_BEGIN_INTERFACE(ICommandQueue, IObject)
 
     /// Blocks execution until all pending GPU commands are complete
     VIRTUAL Uint64 METHOD(WaitForIdle)(THIS) PURE;
+
+    /// Samples a pair of calibrated GPU and CPU timestamps.
+
+    /// \param [out] Calibration - Calibrated timestamps.
+    /// \return     true if the timestamps were sampled successfully, and false otherwise.
+    ///
+    /// \remarks   Use the calibration to convert the timestamp query results to the CPU time base
+    ///            and correlate them with CPU profiling data, see TimestampCalibration::GPUTimestampToCPUSeconds().
+    ///            GPU and CPU clocks drift apart, so the calibration should be refreshed periodically.
+    ///
+    ///            In Direct3D12 backend, the timestamps are obtained with ID3D12CommandQueue::GetClockCalibration().
+    ///            In Vulkan backend, VK_EXT_calibrated_timestamps extension is required, and the method
+    ///            returns false if the extension is not supported.
+    VIRTUAL Bool METHOD(GetTimestampCalibration)(THIS_
+                                                 TimestampCalibration REF Calibration) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -66,9 +115,10 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define ICommandQueue_GetNextFenceValue(This)        CALL_IFACE_METHOD(CommandQueue, GetNextFenceValue,      This)
-#    define ICommandQueue_GetCompletedFenceValue(This)   CALL_IFACE_METHOD(CommandQueue, GetCompletedFenceValue, This)
-#    define ICommandQueue_WaitForIdle(This)              CALL_IFACE_METHOD(CommandQueue, WaitForIdle,            This)
+#    define ICommandQueue_GetNextFenceValue(This)            CALL_IFACE_METHOD(CommandQueue, GetNextFenceValue,       This)
+#    define ICommandQueue_GetCompletedFenceValue(This)       CALL_IFACE_METHOD(CommandQueue, GetCompletedFenceValue,  This)
+#    define ICommandQueue_WaitForIdle(This)                  CALL_IFACE_METHOD(CommandQueue, WaitForIdle,             This)
+#    define ICommandQueue_GetTimestampCalibration(This, ...) CALL_IFACE_METHOD(CommandQueue, GetTimestampCalibration, This, __VA_ARGS__)
 
 // clang-format on
 
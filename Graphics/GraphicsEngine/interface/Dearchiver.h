@@ -30,6 +30,7 @@
 /// Definition of the Diligent::IDearchiver interface and related data structures
 
 #include "../../../Primitives/interface/DataBlob.h"
+#include "../../../Primitives/interface/FileStream.h"
 #include "PipelineResourceSignature.h"
 #include "PipelineState.h"
 
@@ -233,6 +234,12 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
     ///             to the pArchive data blob. It will be kept alive until the dearchiver object
     ///             is released or the Reset() method is called.
     ///
+    /// \note       The archive data is referenced in place when MakeCopy is false. The device-specific
+    ///             data of every device type is stored in a separate contiguous section of the archive
+    ///             and is only accessed when the first object is unpacked. When the archive is loaded
+    ///             from a memory-mapped file (see Diligent::MappedFileDataBlob), the pages that hold
+    ///             the data of other device types are never read from disk.
+    ///
     /// \warning    If the archive was loaded without making a copy, the application
     ///             must not modify its contents while it is in use by the dearchiver.
     /// 
@@ -243,6 +250,28 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
                                      Uint32           ContentVersion DEFAULT_VALUE(~0u),
                                      Bool             MakeCopy       DEFAULT_VALUE(false)) PURE;
 
+    /// Loads a device object archive from a file stream.
+
+    /// \param [in] pStream        - Archive file stream.
+    /// \param [in] ContentVersion - The expected version of the content in the archive,
+    ///                              see LoadArchive().
+    ///
+    /// \return     true if the archive has been loaded successfully, and false otherwise.
+    ///
+    /// \note       The method only reads the archive header and the resource descriptions.
+    ///             The device-specific section is read from the stream when the first object
+    ///             is unpacked, and the sections of other device types are never read.
+    ///             The dearchiver keeps a strong reference to the stream until it is
+    ///             released or the Reset() method is called.
+    ///
+    /// \warning    The application must not use the stream while it is in use by the dearchiver.
+    ///
+    /// \warning    This method is not thread-safe and must not be called simultaneously
+    ///             with other methods.
+    VIRTUAL Bool METHOD(LoadArchiveFromStream)(THIS_
+                                               IFileStream* pStream,
+                                               Uint32       ContentVersion DEFAULT_VALUE(~0u)) PURE;
+
     /// Unpacks a shader from the device object archive.
 
     /// \param [in]  UnpackInfo - Shader unpack info, see Diligent::ShaderUnpackInfo.
@@ -326,6 +355,7 @@ DILIGENT_END_INTERFACE
 #if DILIGENT_C_INTERFACE
 
 #    define IDearchiver_LoadArchive(This, ...)             CALL_IFACE_METHOD(Dearchiver, LoadArchive,             This, __VA_ARGS__)
+#    define IDearchiver_LoadArchiveFromStream(This, ...)   CALL_IFACE_METHOD(Dearchiver, LoadArchiveFromStream,   This, __VA_ARGS__)
 #    define IDearchiver_UnpackShader(This, ...)            CALL_IFACE_METHOD(Dearchiver, UnpackShader,            This, __VA_ARGS__)
 #    define IDearchiver_UnpackPipelineState(This, ...)     CALL_IFACE_METHOD(Dearchiver, UnpackPipelineState,     This, __VA_ARGS__)
 #    define IDearchiver_UnpackResourceSignature(This, ...) CALL_IFACE_METHOD(Dearchiver, UnpackResourceSignature, This, __VA_ARGS__)
@@ -763,6 +763,71 @@ constexpr MultiDrawIndexedAttribs() noexcept {}
 typedef struct MultiDrawIndexedAttribs MultiDrawIndexedAttribs;
 
 
+/// Draw packet.
+
+/// A draw packet contains all the state required to issue a single draw command.
+/// Draw packets are executed by IDeviceContext::SubmitDrawPackets().
+struct DrawPacket
+{
+    /// Sort key. Packets are executed in ascending order of their keys.
+    /// Packets with equal keys are executed in the order they are given.
+    Uint64 SortKey DEFAULT_INITIALIZER(0);
+
+    /// Pipeline state to use for the draw command.
+    IPipelineState* pPSO DEFAULT_INITIALIZER(nullptr);
+
+    /// Number of shader resource bindings in the ppSRBs array.
+    Uint32 NumSRBs DEFAULT_INITIALIZER(0);
+
+    /// An array of NumSRBs shader resource bindings to commit.
+    IShaderResourceBinding* const* ppSRBs DEFAULT_INITIALIZER(nullptr);
+
+    /// Number of vertex buffers in the ppVertexBuffers array.
+    Uint32 NumVertexBuffers DEFAULT_INITIALIZER(0);
+
+    /// An array of NumVertexBuffers vertex buffers to bind starting at slot 0.
+    IBuffer* const* ppVertexBuffers DEFAULT_INITIALIZER(nullptr);
+
+    /// An optional array of NumVertexBuffers offsets, in bytes. If null, all offsets are zero.
+    const Uint64* pVertexOffsets DEFAULT_INITIALIZER(nullptr);
+
+    /// Index buffer. If null, a non-indexed draw command is issued.
+    IBuffer* pIndexBuffer DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the index buffer to the start of the index data, in bytes.
+    Uint64 IndexDataStartOffset DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the shader resources, vertex and index buffers.
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// The type of elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32. Ignored if pIndexBuffer is null.
+    VALUE_TYPE IndexType DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// The number of vertices to draw (non-indexed draw) or the number of indices to draw (indexed draw).
+    Uint32 NumElements DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (NOT the byte offset) of the first vertex (non-indexed draw) or
+    /// the first index (indexed draw) to start reading from.
+    Uint32 FirstElementLocation DEFAULT_INITIALIZER(0);
+
+    /// A constant which is added to each index before accessing the vertex buffer.
+    /// Ignored for non-indexed draws.
+    Uint32 BaseVertex DEFAULT_INITIALIZER(0);
+
+    /// Number of instances to draw.
+    Uint32 NumInstances DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex
+    /// buffer to start reading instance data from.
+    Uint32 FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+};
+typedef struct DrawPacket DrawPacket;
+
+
 /// Defines which parts of the depth-stencil buffer to clear.
 
 /// These flags are used by IDeviceContext::ClearDepthStencil().
@@ -1130,6 +1195,89 @@ struct CopyTextureAttribs
 typedef struct CopyTextureAttribs CopyTextureAttribs;
 
 
+/// Describes a single texture update of the IDeviceContext::UpdateTextures() command.
+struct UpdateTextureAttribs
+{
+    /// Texture to update.
+    ITexture*                      pTexture                 DEFAULT_INITIALIZER(nullptr);
+
+    /// Mip level of the texture subresource to update.
+    Uint32                         MipLevel                 DEFAULT_INITIALIZER(0);
+
+    /// Array slice. Must be 0 for non-array textures.
+    Uint32                         Slice                    DEFAULT_INITIALIZER(0);
+
+    /// Destination region on the texture to update. Use nullptr to update the entire subresource.
+    const Box*                     pDstBox                  DEFAULT_INITIALIZER(nullptr);
+
+    /// Source data to copy to the texture.
+    TextureSubResData              SubresData;
+
+    /// If SubresData.pSrcBuffer is not null, state transition mode of the source buffer.
+    RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode  DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Texture state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode    DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr UpdateTextureAttribs() noexcept {}
+
+    constexpr UpdateTextureAttribs(ITexture*                      _pTexture,
+                                   Uint32                         _MipLevel,
+                                   Uint32                         _Slice,
+                                   const TextureSubResData&       _SubresData,
+                                   RESOURCE_STATE_TRANSITION_MODE _TextureTransitionMode,
+                                   const Box*                     _pDstBox = nullptr) noexcept :
+        pTexture             {_pTexture             },
+        MipLevel             {_MipLevel             },
+        Slice                {_Slice                },
+        pDstBox              {_pDstBox              },
+        SubresData           {_SubresData           },
+        TextureTransitionMode{_TextureTransitionMode}
+    {}
+#endif
+};
+typedef struct UpdateTextureAttribs UpdateTextureAttribs;
+
+
+/// Defines allowed flags for IDeviceContext::SetRenderTargetsExt() function.
+
+/// The flags let the engine skip loading the attachments into the tile memory when the render
+/// targets are bound and writing them back to memory when they are unbound, which saves bandwidth
+/// on tile-based GPUs. The flags only take effect when the call changes the bound render targets.
+DILIGENT_TYPED_ENUM(SET_RENDER_TARGETS_FLAGS, Uint8)
+{
+    /// No extra operations.
+    SET_RENDER_TARGETS_FLAG_NONE = 0x00,
+
+    /// The previous contents of the render targets are not needed and become undefined.
+    ///
+    /// Vulkan counterpart: ATTACHMENT_LOAD_OP_DISCARD for the color attachments of the implicit render pass.
+    /// OpenGL counterpart: glInvalidateFramebuffer for the color attachments.
+    SET_RENDER_TARGETS_FLAG_DISCARD_RENDER_TARGETS = 0x01,
+
+    /// The previous contents of the depth-stencil buffer are not needed and become undefined.
+    ///
+    /// Vulkan counterpart: ATTACHMENT_LOAD_OP_DISCARD for the depth-stencil attachment of the implicit render pass.
+    /// OpenGL counterpart: glInvalidateFramebuffer for the depth-stencil attachment.
+    SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL = 0x02,
+
+    /// The contents of the depth-stencil buffer are not needed after it is unbound and
+    /// become undefined.
+    ///
+    /// Vulkan counterpart: ATTACHMENT_STORE_OP_DISCARD for the depth-stencil attachment of the implicit render pass.
+    /// OpenGL counterpart: glInvalidateFramebuffer for the depth-stencil attachment before it is unbound.
+    ///
+    /// \warning   In Vulkan, the implicit render pass is ended by any command that can't be executed
+    ///            inside a render pass (e.g. resource state transitions, copies or updates). The depth-stencil
+    ///            buffer contents are also undefined after such commands.
+    SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL_ON_UNBIND = 0x04,
+
+    SET_RENDER_TARGETS_FLAG_LAST = SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL_ON_UNBIND
+};
+DEFINE_FLAG_ENUM_OPERATORS(SET_RENDER_TARGETS_FLAGS)
+
+
 /// SetRenderTargetsExt command attributes.
 
 /// This structure is used by IDeviceContext::SetRenderTargetsExt().
@@ -1155,6 +1303,9 @@ struct SetRenderTargetsAttribs
     /// and shading rate map being set (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode  DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
 
+    /// Load and store hints for the render targets, see Diligent::SET_RENDER_TARGETS_FLAGS.
+    SET_RENDER_TARGETS_FLAGS       Flags                DEFAULT_INITIALIZER(SET_RENDER_TARGETS_FLAG_NONE);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr SetRenderTargetsAttribs() noexcept {}
 
@@ -1174,6 +1325,37 @@ struct SetRenderTargetsAttribs
 typedef struct SetRenderTargetsAttribs SetRenderTargetsAttribs;
 
 
+/// Defines allowed flags for IDeviceContext::BeginRenderPass() function.
+DILIGENT_TYPED_ENUM(BEGIN_RENDER_PASS_FLAGS, Uint8)
+{
+    /// No flags.
+    BEGIN_RENDER_PASS_FLAG_NONE = 0x00,
+
+    /// The render pass contents are recorded by deferred contexts into secondary command lists
+    /// that are executed inside the pass, which allows recording a single pass in parallel.
+    ///
+    /// When the flag is used with the immediate context, the render pass instance is started
+    /// and the context may only execute secondary command lists with IDeviceContext::ExecuteCommandLists(),
+    /// until the pass is ended.
+    ///
+    /// When the flag is used with a deferred context, the context inherits the render pass and the framebuffer:
+    /// the render pass instance is neither started nor ended by the command list, clear values and
+    /// state transition mode are ignored, and the command list may only be executed inside the render pass
+    /// instance started by the immediate context with the same render pass and framebuffer.
+    /// BeginRenderPass() must be the first command recorded by the deferred context, EndRenderPass() must be
+    /// the last one, and the render pass must have a single subpass.
+    ///
+    /// Vulkan counterpart: VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS and secondary command buffers
+    /// that are executed with vkCmdExecuteCommands.
+    ///
+    /// \note  The flag is only supported in Vulkan backend.
+    BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS = 0x01,
+
+    BEGIN_RENDER_PASS_FLAG_LAST = BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS
+};
+DEFINE_FLAG_ENUM_OPERATORS(BEGIN_RENDER_PASS_FLAGS)
+
+
 /// BeginRenderPass command attributes.
 
 /// This structure is used by IDeviceContext::BeginRenderPass().
@@ -1208,6 +1390,9 @@ struct BeginRenderPassAttribs
     /// internal state variables are not updated and it is the application responsibility to set them
     /// manually to match the actual states.
     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Render pass flags, see Diligent::BEGIN_RENDER_PASS_FLAGS.
+    BEGIN_RENDER_PASS_FLAGS Flags DEFAULT_INITIALIZER(BEGIN_RENDER_PASS_FLAG_NONE);
 };
 typedef struct BeginRenderPassAttribs BeginRenderPassAttribs;
 
@@ -2046,6 +2231,124 @@ struct BindSparseResourceMemoryAttribs
 };
 typedef struct BindSparseResourceMemoryAttribs BindSparseResourceMemoryAttribs;
 
+/// Attributes of the IDeviceContext::ResolveQueries() command.
+struct ResolveQueriesAttribs
+{
+    /// An array of NumQueries queries whose data will be written to the buffer.
+
+    /// \remarks Only occlusion, binary occlusion and timestamp queries are allowed.
+    ///          The queries may have different types.
+    IQuery**      ppQueries  DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in the ppQueries array.
+    Uint32        NumQueries DEFAULT_INITIALIZER(0);
+
+    /// Destination buffer.
+    IBuffer*      pDstBuffer DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset in bytes from the beginning of the buffer to the data of the first query.
+    /// Must be a multiple of 8.
+    Uint64        DstOffset  DEFAULT_INITIALIZER(0);
+
+    /// Destination buffer state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure with default values.
+    constexpr ResolveQueriesAttribs() noexcept {}
+
+    /// Initializes the structure with user-specified values.
+    constexpr ResolveQueriesAttribs(IQuery**                       _ppQueries,
+                                    Uint32                         _NumQueries,
+                                    IBuffer*                       _pDstBuffer,
+                                    Uint64                         _DstOffset               = 0,
+                                    RESOURCE_STATE_TRANSITION_MODE _DstBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE) noexcept :
+        ppQueries              {_ppQueries              },
+        NumQueries             {_NumQueries             },
+        pDstBuffer             {_pDstBuffer             },
+        DstOffset              {_DstOffset              },
+        DstBufferTransitionMode{_DstBufferTransitionMode}
+    {}
+#endif
+};
+typedef struct ResolveQueriesAttribs ResolveQueriesAttribs;
+
+/// Attributes of the IDeviceContext::BeginConditionalRendering() command.
+struct BeginConditionalRenderingAttribs
+{
+    /// The buffer that contains the predicate value.
+
+    /// \remarks The buffer must have been created with BIND_INDIRECT_DRAW_ARGS flag
+    ///          and must not be a USAGE_DYNAMIC buffer.
+    IBuffer*      pBuffer     DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset in bytes from the beginning of the buffer to the predicate value.
+    /// Must be a multiple of 8.
+    Uint64        Offset      DEFAULT_INITIALIZER(0);
+
+    /// If false, the commands are discarded when the predicate value is zero.
+    /// If true, the commands are discarded when the predicate value is not zero.
+    Bool          Inverted    DEFAULT_INITIALIZER(False);
+
+    /// State transition mode for the buffer (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    /// The buffer must be in RESOURCE_STATE_INDIRECT_ARGUMENT state.
+    RESOURCE_STATE_TRANSITION_MODE BufferTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure with default values.
+    constexpr BeginConditionalRenderingAttribs() noexcept {}
+
+    /// Initializes the structure with user-specified values.
+    constexpr BeginConditionalRenderingAttribs(IBuffer*                       _pBuffer,
+                                               Uint64                         _Offset               = 0,
+                                               Bool                           _Inverted             = False,
+                                               RESOURCE_STATE_TRANSITION_MODE _BufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE) noexcept :
+        pBuffer             {_pBuffer             },
+        Offset              {_Offset              },
+        Inverted            {_Inverted            },
+        BufferTransitionMode{_BufferTransitionMode}
+    {}
+#endif
+};
+typedef struct BeginConditionalRenderingAttribs BeginConditionalRenderingAttribs;
+
+/// Dynamic render state that is set by IDeviceContext::SetDynamicRenderState().
+struct DynamicRenderState
+{
+    /// Triangle culling mode, see Diligent::RasterizerStateDesc::CullMode.
+    CULL_MODE             CullMode              DEFAULT_INITIALIZER(CULL_MODE_BACK);
+
+    /// Triangle winding order, see Diligent::RasterizerStateDesc::FrontCounterClockwise.
+    Bool                  FrontCounterClockwise DEFAULT_INITIALIZER(False);
+
+    /// Primitive topology.
+
+    /// \remarks The topology must belong to the same class (points, lines, triangles or patches)
+    ///          as the topology of the pipeline state. Use PRIMITIVE_TOPOLOGY_UNDEFINED to keep
+    ///          the topology of the pipeline state. The member is ignored by mesh pipelines.
+    PRIMITIVE_TOPOLOGY    PrimitiveTopology     DEFAULT_INITIALIZER(PRIMITIVE_TOPOLOGY_UNDEFINED);
+
+    /// Depth-stencil state, see Diligent::DepthStencilStateDesc.
+    DepthStencilStateDesc DepthStencilDesc;
+
+#if DILIGENT_CPP_INTERFACE
+    /// Initializes the structure with default values.
+    constexpr DynamicRenderState() noexcept {}
+
+    /// Initializes the structure with user-specified values.
+    constexpr DynamicRenderState(CULL_MODE                    _CullMode,
+                                 Bool                         _FrontCounterClockwise,
+                                 const DepthStencilStateDesc& _DepthStencilDesc,
+                                 PRIMITIVE_TOPOLOGY           _PrimitiveTopology = PRIMITIVE_TOPOLOGY_UNDEFINED) noexcept :
+        CullMode             {_CullMode             },
+        FrontCounterClockwise{_FrontCounterClockwise},
+        PrimitiveTopology    {_PrimitiveTopology    },
+        DepthStencilDesc     {_DepthStencilDesc     }
+    {}
+#endif
+};
+typedef struct DynamicRenderState DynamicRenderState;
+
 /// Special constant for all remaining mipmap levels.
 #define DILIGENT_REMAINING_MIP_LEVELS 0xFFFFFFFFU
 
@@ -2334,6 +2637,9 @@ struct DeviceContextCommandCounters
     /// The total number of BeginQuery calls.
     Uint32 BeginQuery DEFAULT_INITIALIZER(0);
 
+    /// The total number of ResolveQueries calls.
+    Uint32 ResolveQueries DEFAULT_INITIALIZER(0);
+
     /// The total number of GenerateMips calls.
     Uint32 GenerateMips DEFAULT_INITIALIZER(0);
 
@@ -2342,6 +2648,38 @@ struct DeviceContextCommandCounters
 
     /// The total number of BindSparseResourceMemory calls.
     Uint32 BindSparseResourceMemory DEFAULT_INITIALIZER(0);
+
+    /// The number of SetPipelineState calls that were filtered because the
+    /// pipeline state was already bound.
+    Uint32 RedundantSetPipelineState DEFAULT_INITIALIZER(0);
+
+    /// The number of SetVertexBuffers calls that were filtered because they
+    /// did not change the bound buffers and offsets.
+    Uint32 RedundantSetVertexBuffers DEFAULT_INITIALIZER(0);
+
+    /// The number of SetIndexBuffer calls that were filtered because they
+    /// did not change the bound buffer and offset.
+    Uint32 RedundantSetIndexBuffer DEFAULT_INITIALIZER(0);
+
+    /// The number of SetBlendFactors calls that were filtered because the
+    /// blend factors did not change.
+    Uint32 RedundantSetBlendFactors DEFAULT_INITIALIZER(0);
+
+    /// The number of SetStencilRef calls that were filtered because the
+    /// stencil reference value did not change.
+    Uint32 RedundantSetStencilRef DEFAULT_INITIALIZER(0);
+
+    /// The number of SetViewports calls that were filtered because the
+    /// viewports did not change.
+    Uint32 RedundantSetViewports DEFAULT_INITIALIZER(0);
+
+    /// The number of SetScissorRects calls that were filtered because the
+    /// scissor rects did not change.
+    Uint32 RedundantSetScissorRects DEFAULT_INITIALIZER(0);
+
+    /// The number of CommitShaderResources calls that were filtered because the
+    /// shader resource binding was already committed and its resources did not change.
+    Uint32 RedundantCommitShaderResources DEFAULT_INITIALIZER(0);
 };
 typedef struct DeviceContextCommandCounters DeviceContextCommandCounters;
 
@@ -2354,6 +2692,33 @@ struct DeviceContextStats
     /// Command counters, see Diligent::DeviceContextCommandCounters.
     DeviceContextCommandCounters CommandCounters DEFAULT_INITIALIZER({});
 
+    /// The number of resource barriers recorded by the context.
+
+    /// \remarks   Barriers are accounted for when the context is flushed or the command list
+    ///            is finished. Only Direct3D12 and Vulkan backends record explicit barriers.
+    Uint32 BarrierCount DEFAULT_INITIALIZER(0);
+
+    /// The number of times the context submitted commands to the command queue.
+    Uint32 SubmitCount DEFAULT_INITIALIZER(0);
+
+    /// The number of bytes of CPU data uploaded by UpdateBuffer and UpdateTexture commands.
+    Uint64 UploadBytes DEFAULT_INITIALIZER(0);
+
+    /// The number of bytes allocated from the dynamic heap (Direct3D12, Vulkan and WebGPU only).
+    /// In Direct3D12 and Vulkan, this includes the staging memory used for uploads.
+    Uint64 DynamicMemoryAllocated DEFAULT_INITIALIZER(0);
+
+    /// The number of bytes of descriptors copied to shader-visible memory when committing
+    /// shader resources (Direct3D12 dynamic descriptors and Vulkan descriptor buffers only).
+    Uint64 DescriptorBytesCopied DEFAULT_INITIALIZER(0);
+
+    /// An estimate of the CPU time, in nanoseconds, spent in draw and dispatch commands,
+    /// including the state and resource commits they trigger.
+
+    /// \remarks   To keep the overhead low, only every 16th command is timed, and the
+    ///            measured time is scaled accordingly.
+    Uint64 EstimatedCPUTimeNs DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr Uint32 GetTotalTriangleCount() const noexcept
     {
@@ -2991,6 +3356,13 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     /// \param [in] NumCommandLists - The number of command lists to execute.
     /// \param [in] ppCommandLists  - Pointer to the array of NumCommandLists command lists to execute.
     /// \remarks After a command list is executed, it is no longer valid and must be released.
+    ///          The exception is Direct3D11 backend, where a command list may be executed any number
+    ///          of times, which allows recording static passes once and replaying them every frame.
+    ///
+    /// \remarks Inside a render pass that was begun with Diligent::BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS
+    ///          flag, the command lists must have been recorded by deferred contexts that inherited the same render pass.
+    ///          Such command lists are executed as part of the current command buffer, which is not flushed.
+    ///          All other command lists must be executed outside of render passes.
     VIRTUAL void METHOD(ExecuteCommandLists)(THIS_
                                              Uint32               NumCommandLists,
                                              ICommandList* const* ppCommandLists) PURE;
@@ -3204,6 +3576,39 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                      const CopyTextureAttribs REF CopyAttribs) PURE;
 
 
+    /// Updates multiple texture subresources.
+
+    /// \param [in] pUpdates   - Array of NumUpdates updates, see Diligent::UpdateTextureAttribs.
+    /// \param [in] NumUpdates - The number of elements in pUpdates array.
+    ///
+    /// \remarks The result is the same as calling IDeviceContext::UpdateTexture() for every element
+    ///          in order, but backends that record explicit barriers (Direct3D12, Vulkan) write the data
+    ///          of all updates into one upload allocation, issue all state transitions as a single batch,
+    ///          and merge the copies to the same texture into a single command where the API allows it.
+    ///          This is the preferred way to upload a whole mip chain or all faces of a cube map.
+    ///
+    /// \remarks Supported contexts: graphics, compute, transfer.
+    VIRTUAL void METHOD(UpdateTextures)(THIS_
+                                        const UpdateTextureAttribs* pUpdates,
+                                        Uint32                      NumUpdates) PURE;
+
+
+    /// Copies data between multiple pairs of textures.
+
+    /// \param [in] pCopies   - Array of NumCopies copy commands, see Diligent::CopyTextureAttribs.
+    /// \param [in] NumCopies - The number of elements in pCopies array.
+    ///
+    /// \remarks The result is the same as calling IDeviceContext::CopyTexture() for every element
+    ///          in order, but in Direct3D12 and Vulkan the state transitions of all textures are issued
+    ///          as a single batch before the copies. A texture that is used as a copy destination
+    ///          and later in the array as a copy source (or vice versa) splits the batch.
+    ///
+    /// \remarks Supported contexts: graphics, compute, transfer.
+    VIRTUAL void METHOD(CopyTextures)(THIS_
+                                      const CopyTextureAttribs* pCopies,
+                                      Uint32                    NumCopies) PURE;
+
+
     /// Maps the texture subresource.
 
     /// \param [in] pTexture    - Pointer to the texture to map.
@@ -3572,6 +3977,90 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     VIRTUAL void METHOD(BindSparseResourceMemory)(THIS_
                                                   const BindSparseResourceMemoryAttribs REF Attribs) PURE;
 
+    /// Sorts the draw packets by their keys and executes them.
+
+    /// \param [in] pPackets   - An array of NumPackets draw packets, see Diligent::DrawPacket.
+    /// \param [in] NumPackets - The number of packets in the pPackets array.
+    ///
+    /// \remarks The packets are sorted by DrawPacket::SortKey using a stable radix sort;
+    ///          the array itself is not modified.
+    ///          For every packet, only the state that differs from the previous packet
+    ///          is set: the pipeline state, shader resource bindings, vertex buffers and
+    ///          index buffer. Shader resource bindings are re-committed whenever the
+    ///          pipeline state changes.
+    ///          State set by the last packet remains bound after the command returns.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(SubmitDrawPackets)(THIS_
+                                           const DrawPacket* pPackets,
+                                           Uint32            NumPackets) PURE;
+
+    /// Writes the data of multiple queries to a buffer on the GPU.
+
+    /// \param [in] Attribs - Command attributes, see Diligent::ResolveQueriesAttribs.
+    ///
+    /// \remarks The data of every query is written as a 64-bit unsigned integer at the
+    ///          offset Attribs.DstOffset + 8 * i, where i is the index of the query in the array:
+    ///          - Occlusion query: the number of samples that passed the depth and stencil tests.
+    ///          - Binary occlusion query: non-zero if any samples passed the tests, and zero otherwise.
+    ///            Direct3D12 writes 1 or 0, while Vulkan may write any non-zero value.
+    ///          - Timestamp query: the raw counter value. Use IQuery::GetData() to get the counter frequency.
+    ///
+    ///          All queries must have been ended by this context. The results stay on the GPU and
+    ///          can be used for conditional rendering (see IDeviceContext::BeginConditionalRendering())
+    ///          or read by shaders without a CPU round trip. Queries that are adjacent in the array and
+    ///          in the internal query heap are resolved by a single command.
+    ///
+    ///          The command must be executed outside of a render pass.
+    ///          Requires DeviceFeatures::ConditionalRendering feature.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(ResolveQueries)(THIS_
+                                        const ResolveQueriesAttribs REF Attribs) PURE;
+
+    /// Begins conditional rendering.
+
+    /// \param [in] Attribs - Command attributes, see Diligent::BeginConditionalRenderingAttribs.
+    ///
+    /// \remarks Until IDeviceContext::EndConditionalRendering() is called, draw and dispatch commands
+    ///          are discarded by the GPU depending on the predicate value stored in the buffer.
+    ///          The predicate can be written by IDeviceContext::ResolveQueries(), e.g. from a
+    ///          binary occlusion query of an object's bounding box.
+    ///
+    ///          Direct3D12 reads a 64-bit predicate value, while Vulkan reads a 32-bit value.
+    ///          For portable behavior, the upper 32 bits of the value must be zero if the lower
+    ///          32 bits are zero, which is the case for binary occlusion query results.
+    ///          In Direct3D12, copy, clear and resolve commands are also predicated.
+    ///
+    ///          Conditional rendering can't be nested. If it begins inside a render pass, it must
+    ///          end in the same subpass. The context must not be flushed while conditional rendering
+    ///          is active.
+    ///          Requires DeviceFeatures::ConditionalRendering feature.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(BeginConditionalRendering)(THIS_
+                                                   const BeginConditionalRenderingAttribs REF Attribs) PURE;
+
+    /// Ends conditional rendering that was started by IDeviceContext::BeginConditionalRendering().
+
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(EndConditionalRendering)(THIS) PURE;
+
+    /// Sets the dynamic render state of the currently bound pipeline.
+
+    /// \param [in] State - Dynamic render state, see Diligent::DynamicRenderState.
+    ///
+    /// \remarks The pipeline state bound to the context must have been created with the
+    ///          PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE flag. Binding the pipeline state applies the
+    ///          states from its description, so this method must be called after
+    ///          IDeviceContext::SetPipelineState(). The state remains in effect until the next
+    ///          SetPipelineState() or SetDynamicRenderState() call.
+    ///          Requires DeviceFeatures::ExtendedDynamicState feature.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(SetDynamicRenderState)(THIS_
+                                               const DynamicRenderState REF State) PURE;
+
     /// Clears the device context statistics.
     VIRTUAL void METHOD(ClearStats)(THIS) PURE;
 
@@ -3629,6 +4118,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_UnmapBuffer(This, ...)                   CALL_IFACE_METHOD(DeviceContext, UnmapBuffer,               This, __VA_ARGS__)
 #    define IDeviceContext_UpdateTexture(This, ...)                 CALL_IFACE_METHOD(DeviceContext, UpdateTexture,             This, __VA_ARGS__)
 #    define IDeviceContext_CopyTexture(This, ...)                   CALL_IFACE_METHOD(DeviceContext, CopyTexture,               This, __VA_ARGS__)
+#    define IDeviceContext_UpdateTextures(This, ...)                CALL_IFACE_METHOD(DeviceContext, UpdateTextures,            This, __VA_ARGS__)
+#    define IDeviceContext_CopyTextures(This, ...)                  CALL_IFACE_METHOD(DeviceContext, CopyTextures,              This, __VA_ARGS__)
 #    define IDeviceContext_MapTextureSubresource(This, ...)         CALL_IFACE_METHOD(DeviceContext, MapTextureSubresource,     This, __VA_ARGS__)
 #    define IDeviceContext_UnmapTextureSubresource(This, ...)       CALL_IFACE_METHOD(DeviceContext, UnmapTextureSubresource,   This, __VA_ARGS__)
 #    define IDeviceContext_GenerateMips(This, ...)                  CALL_IFACE_METHOD(DeviceContext, GenerateMips,              This, __VA_ARGS__)
@@ -3654,6 +4145,11 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_UnlockCommandQueue(This)                 CALL_IFACE_METHOD(DeviceContext, UnlockCommandQueue,        This)
 #    define IDeviceContext_SetShadingRate(This, ...)                CALL_IFACE_METHOD(DeviceContext, SetShadingRate,            This, __VA_ARGS__)
 #    define IDeviceContext_BindSparseResourceMemory(This, ...)      CALL_IFACE_METHOD(DeviceContext, BindSparseResourceMemory,  This, __VA_ARGS__)
+#    define IDeviceContext_SubmitDrawPackets(This, ...)             CALL_IFACE_METHOD(DeviceContext, SubmitDrawPackets,         This, __VA_ARGS__)
+#    define IDeviceContext_ResolveQueries(This, ...)                CALL_IFACE_METHOD(DeviceContext, ResolveQueries,            This, __VA_ARGS__)
+#    define IDeviceContext_BeginConditionalRendering(This, ...)     CALL_IFACE_METHOD(DeviceContext, BeginConditionalRendering, This, __VA_ARGS__)
+#    define IDeviceContext_EndConditionalRendering(This)            CALL_IFACE_METHOD(DeviceContext, EndConditionalRendering,   This)
+#    define IDeviceContext_SetDynamicRenderState(This, ...)         CALL_IFACE_METHOD(DeviceContext, SetDynamicRenderState,     This, __VA_ARGS__)
 #    define IDeviceContext_ClearStats(This)                         CALL_IFACE_METHOD(DeviceContext, ClearStats,                This)
 #    define IDeviceContext_GetStats(This)                           CALL_IFACE_METHOD(DeviceContext, GetStats,                  This)
 
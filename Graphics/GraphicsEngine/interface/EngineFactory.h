@@ -63,7 +63,17 @@ static DILIGENT_CONSTEXPR INTERFACE_ID IID_EngineFactory =
 /// Dearchiver create information
 struct DearchiverCreateInfo
 {
-    void* pDummy DEFAULT_INITIALIZER(nullptr);
+    /// Whether the resources of the archives that are loaded later override the resources
+    /// with the same names in the archives that have been loaded before.
+
+    /// \remarks    This allows applying patch archives, e.g. the ones created by
+    ///             IArchiverFactory::CreateDeltaArchive(), on top of the base archive.
+    ///             Objects are unpacked from the last archive that contains them. Objects that
+    ///             had been unpacked before the overriding archive was loaded are not affected.
+    ///
+    ///             When this member is False, the resource from the first archive that contains it
+    ///             is used, and an error is reported for conflicting resources in other archives.
+    Bool AllowOverrides DEFAULT_INITIALIZER(False);
 };
 typedef struct DearchiverCreateInfo DearchiverCreateInfo;
 
@@ -63,11 +63,34 @@ DILIGENT_TYPED_ENUM(FENCE_TYPE, Uint8)
     FENCE_TYPE_LAST = FENCE_TYPE_GENERAL
 };
 
+/// Fence flags.
+
+/// This enumeration is used by FenceDesc structure.
+DILIGENT_TYPED_ENUM(FENCE_FLAGS, Uint8)
+{
+    FENCE_FLAG_NONE = 0u,
+
+    /// The fence may be exported to another API or process, so that it can wait for the
+    /// GPU work that was signaled on the fence (e.g. a video encoder waiting for a frame).
+    ///
+    /// \remarks In Vulkan, the fence must be FENCE_TYPE_GENERAL and NativeFence feature must be enabled.
+    ///          The timeline semaphore is created exportable (VK_KHR_external_semaphore_fd or
+    ///          VK_KHR_external_semaphore_win32), use IFenceVk::ExportSemaphoreHandle() to get the handle.
+    ///          In Direct3D12, the fence is created with D3D12_FENCE_FLAG_SHARED,
+    ///          use ID3D12Device::CreateSharedHandle() to get the handle.
+    ///          Other backends do not support this flag.
+    FENCE_FLAG_EXPORTABLE = 1u << 0
+};
+DEFINE_FLAG_ENUM_OPERATORS(FENCE_FLAGS)
+
 /// Fence description
 struct FenceDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 
     /// Fence type, see Diligent::FENCE_TYPE.
     FENCE_TYPE Type DEFAULT_INITIALIZER(FENCE_TYPE_CPU_WAIT_ONLY);
+
+    /// Fence flags, see Diligent::FENCE_FLAGS.
+    FENCE_FLAGS Flags DEFAULT_INITIALIZER(FENCE_FLAG_NONE);
 };
 typedef struct FenceDesc FenceDesc;
 
@@ -125,6 +148,25 @@ DILIGENT_BEGIN_INTERFACE(IFence, IDeviceObject)
     /// \note  The method blocks the execution of the calling thread until the wait is complete.
     VIRTUAL void METHOD(Wait)(THIS_
                               Uint64 Value) PURE;
+
+
+    /// Waits until the fence reaches or exceeds the specified value, on the host,
+    /// or until the timeout expires.
+
+    /// \param [in] Value   - The value that the fence is waiting for to reach.
+    /// \param [in] Timeout - The timeout, in nanoseconds. If the timeout is zero, the method
+    ///                       only checks the fence value. If the timeout is UINT64_MAX,
+    ///                       the method waits indefinitely, same as Wait().
+    ///
+    /// \return    True if the fence has reached the value, and false if the timeout has expired.
+    ///
+    /// \remarks   The thread is blocked on a native wait object where the API provides one
+    ///            (timeline semaphores and fences in Vulkan, fence completion events in Direct3D12,
+    ///            sync objects in OpenGL), so the method returns as soon as the value is reached.
+    ///            In Direct3D12, the timeout is rounded up to whole milliseconds.
+    VIRTUAL Bool METHOD(WaitWithTimeout)(THIS_
+                                         Uint64 Value,
+                                         Uint64 Timeout) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -136,12 +178,51 @@ DILIGENT_END_INTERFACE
 
 #    define IFence_GetDesc(This) (const struct FenceDesc*)IDeviceObject_GetDesc(This)
 
-#    define IFence_GetCompletedValue(This) CALL_IFACE_METHOD(Fence, GetCompletedValue, This)
-#    define IFence_Signal(This, ...)       CALL_IFACE_METHOD(Fence, Signal,            This, __VA_ARGS__)
-#    define IFence_Wait(This, ...)         CALL_IFACE_METHOD(Fence, Wait,              This, __VA_ARGS__)
+#    define IFence_GetCompletedValue(This)    CALL_IFACE_METHOD(Fence, GetCompletedValue, This)
+#    define IFence_Signal(This, ...)          CALL_IFACE_METHOD(Fence, Signal,            This, __VA_ARGS__)
+#    define IFence_Wait(This, ...)            CALL_IFACE_METHOD(Fence, Wait,              This, __VA_ARGS__)
+#    define IFence_WaitWithTimeout(This, ...) CALL_IFACE_METHOD(Fence, WaitWithTimeout,   This, __VA_ARGS__)
 
 // clang-format on
 
 #endif
 
+/// Attributes of the IRenderDevice::WaitForFences() method.
+struct WaitForFencesAttribs
+{
+    /// The number of elements in ppFences and pValues arrays.
+    Uint32 NumFences DEFAULT_INITIALIZER(0);
+
+    /// An array of NumFences fences to wait for.
+    IFence** ppFences DEFAULT_INITIALIZER(nullptr);
+
+    /// An array of NumFences values that the respective fences are waiting for to reach.
+    const Uint64* pValues DEFAULT_INITIALIZER(nullptr);
+
+    /// If true, the method waits until all fences reach their values.
+    /// Otherwise, the method waits until any fence reaches its value.
+    Bool WaitAll DEFAULT_INITIALIZER(True);
+
+    /// The timeout, in nanoseconds. If the timeout is zero, the method only checks
+    /// the fence values. If the timeout is UINT64_MAX, the method waits indefinitely.
+    Uint64 Timeout DEFAULT_INITIALIZER(~0ull);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr WaitForFencesAttribs() noexcept {}
+
+    constexpr WaitForFencesAttribs(Uint32        _NumFences,
+                                   IFence**      _ppFences,
+                                   const Uint64* _pValues,
+                                   Bool          _WaitAll = WaitForFencesAttribs{}.WaitAll,
+                                   Uint64        _Timeout = WaitForFencesAttribs{}.Timeout) noexcept :
+        NumFences{_NumFences},
+        ppFences {_ppFences },
+        pValues  {_pValues  },
+        WaitAll  {_WaitAll  },
+        Timeout  {_Timeout  }
+    {}
+#endif
+};
+typedef struct WaitForFencesAttribs WaitForFencesAttribs;
+
 DILIGENT_END_NAMESPACE // namespace Diligent
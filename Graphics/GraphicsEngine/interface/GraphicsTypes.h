@@ -1469,6 +1469,29 @@ DILIGENT_TYPED_ENUM(SURFACE_TRANSFORM, Uint32)
 };
 
 
+/// Presentation mode that the swap chain uses when vertical synchronization is disabled,
+/// i.e. when ISwapChain::Present() is called with zero sync interval.
+DILIGENT_TYPED_ENUM(UNSYNCED_PRESENT_MODE, Uint8)
+{
+    /// The presented image replaces the image that waits for the next vertical blank.
+    /// The image never tears, but the frames that are replaced are never shown.
+    ///
+    /// \remarks    In Vulkan and WebGPU, mailbox present mode is used if it is supported, and
+    ///             immediate mode otherwise.
+    UNSYNCED_PRESENT_MODE_MAILBOX = 0,
+
+    /// The image is presented immediately, which gives the lowest latency, but may result in tearing.
+    ///
+    /// \remarks    In Vulkan and WebGPU, immediate present mode is used if it is supported, and
+    ///             mailbox mode otherwise.
+    ///             In Direct3D11 and Direct3D12, tearing is only allowed in windowed mode and
+    ///             if the system supports it.
+    UNSYNCED_PRESENT_MODE_IMMEDIATE,
+
+    UNSYNCED_PRESENT_MODE_COUNT
+};
+
+
 /// Swap chain description
 struct SwapChainDesc
 {
@@ -1514,6 +1537,15 @@ struct SwapChainDesc
     /// for the primary swap chain, the engine releases stale resources.
     Bool  IsPrimary                     DEFAULT_INITIALIZER(true);
 
+    /// Presentation mode that is used when vertical synchronization is disabled,
+    /// see Diligent::UNSYNCED_PRESENT_MODE.
+    UNSYNCED_PRESENT_MODE UnsyncedPresentMode DEFAULT_INITIALIZER(UNSYNCED_PRESENT_MODE_MAILBOX);
+
+    /// The initial maximum number of frames that the swap chain is allowed to queue
+    /// for rendering, see ISwapChain::SetMaximumFrameLatency().
+    /// If zero, the number of buffers in the swap chain is used.
+    Uint32 MaxFrameLatency              DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr SwapChainDesc() noexcept
     {
@@ -1854,6 +1886,32 @@ struct DeviceFeatures
     /// Indicates if device supports formatted buffers.
     DEVICE_FEATURE_STATE FormattedBuffers       DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
+    /// Indicates if device supports conditional rendering and resolving query data into buffers.
+    ///
+    /// \remarks    When this feature is enabled, an application can use IDeviceContext::ResolveQueries()
+    ///             to write query results to a GPU buffer, and IDeviceContext::BeginConditionalRendering()
+    ///             to let the GPU discard commands depending on a value in a buffer, e.g. the result of
+    ///             an occlusion query, with no CPU round trip.
+    ///             Supported in Direct3D12 and in Vulkan (VK_EXT_conditional_rendering).
+    DEVICE_FEATURE_STATE ConditionalRendering   DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports multiview rendering.
+    ///
+    /// \remarks    When this feature is enabled, an application can set SubpassDesc::ViewMask to render
+    ///             a subpass into several slices of the texture array attachments with a single set of
+    ///             draw commands, e.g. both eyes of a stereo view. The shaders use SV_ViewID (HLSL) or
+    ///             gl_ViewIndex (GLSL) to select view-dependent data.
+    ///             Supported in Vulkan (VK_KHR_multiview) and in Direct3D12 (view instancing).
+    DEVICE_FEATURE_STATE MultiView              DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports extended dynamic state.
+    ///
+    /// \remarks    When this feature is enabled, pipeline states can be created with the
+    ///             PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE flag, and cull mode, front face, depth-stencil
+    ///             states and primitive topology can be set with IDeviceContext::SetDynamicRenderState().
+    ///             Supported in Vulkan (VK_EXT_extended_dynamic_state).
+    DEVICE_FEATURE_STATE ExtendedDynamicState   DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr DeviceFeatures() noexcept {}
 
@@ -1904,11 +1962,14 @@ struct DeviceFeatures
 	Handler(TextureSubresourceViews)		   \
 	Handler(NativeMultiDraw)                   \
     Handler(AsyncShaderCompilation)			   \
-	Handler(FormattedBuffers)
+	Handler(FormattedBuffers)                  \
+    Handler(ConditionalRendering)              \
+    Handler(MultiView)                         \
+    Handler(ExtendedDynamicState)
 
     explicit constexpr DeviceFeatures(DEVICE_FEATURE_STATE State) noexcept
     {
-        static_assert(sizeof(*this) == 47, "Did you add a new feature to DeviceFeatures? Please add it to ENUMERATE_DEVICE_FEATURES.");
+        static_assert(sizeof(*this) == 50, "Did you add a new feature to DeviceFeatures? Please add it to ENUMERATE_DEVICE_FEATURES.");
     #define INIT_FEATURE(Feature) Feature = State;
         ENUMERATE_DEVICE_FEATURES(INIT_FEATURE)
     #undef INIT_FEATURE
@@ -3284,6 +3345,15 @@ struct GraphicsAdapterInfo
     /// Number of video outputs this adapter has (if available).
     Uint32 NumOutputs       DEFAULT_INITIALIZER(0);
 
+    /// The number of physical GPUs (nodes) linked together in this adapter.
+
+    /// Direct3D12 backend: the number of nodes reported by ID3D12Device::GetNodeCount().
+    /// Vulkan backend:     the number of physical devices in the device group that contains this adapter.
+    /// Other backends:     always 1.
+    ///
+    /// \remarks   The render device always runs on the first node of a linked adapter.
+    Uint32 NumNodes         DEFAULT_INITIALIZER(1);
+
     /// Device memory information, see Diligent::AdapterMemoryInfo.
     AdapterMemoryInfo Memory;
 
@@ -3352,6 +3422,7 @@ struct GraphicsAdapterInfo
                VendorId        == RHS.VendorId        &&
                DeviceId        == RHS.DeviceId        &&
                NumOutputs      == RHS.NumOutputs      &&
+               NumNodes        == RHS.NumNodes        &&
                Memory          == RHS.Memory          &&
                RayTracing      == RHS.RayTracing      &&
                WaveOp          == RHS.WaveOp          &&
@@ -3462,6 +3533,12 @@ struct EngineCreateInfo
     /// IEngineFactoryD3D12::CreateDeviceAndContextsD3D12, and IEngineFactoryVk::CreateDeviceAndContextsVk)
     /// starting at position max(1, NumImmediateContexts).
     ///
+    /// IEngineFactoryOpenGL::CreateDeviceAndSwapChainGL and IEngineFactoryOpenGL::AttachToActiveGLContext
+    /// write the deferred contexts to ppImmediateContext array right after the immediate context.
+    /// OpenGL deferred contexts may record commands on any thread, but never make GL calls:
+    /// the commands are replayed by the immediate context on the thread that owns the GL context
+    /// when the command lists are executed.
+    ///
     /// \warning  An application must manually call IDeviceContext::FinishFrame for
     ///           deferred contexts to let the engine release stale resources.
     Uint32                   NumDeferredContexts    DEFAULT_INITIALIZER(0);
@@ -3508,6 +3585,8 @@ struct EngineCreateInfo
     /// \remarks    If AsyncShaderCompilation device feature is enabled and pAsyncShaderCompilationThreadPool is null,
     ///             this value is used to define the number of threads in the default thread pool.
     ///             If the value is 0xFFFFFFFF, the number of threads will be determined automatically.
+    ///             The default thread pool runs at below-normal priority where supported and, on hybrid CPUs, is
+    ///             restricted to the efficiency cores (see ThreadPoolCorePlacement::EfficiencyCores).
     ///             
     ///             If pAsyncShaderCompilationThreadPool is not null, the value is ignored as the user-provided
     ///             thread pool is used instead.
@@ -3516,8 +3595,23 @@ struct EngineCreateInfo
     ///             function.
     Uint32 NumAsyncShaderCompilationThreads DEFAULT_INITIALIZER(0xFFFFFFFFu);
 
-    // The structure must be 8-byte aligned
-    Uint32 Padding DEFAULT_INITIALIZER(0);
+    /// Whether to defer the initialization of optional engine subsystems until they are first used.
+    ///
+    /// \remarks    This reduces the time it takes to create the device. The following subsystems are deferred:
+    ///             - glslang (Vulkan and WebGPU backends) is initialized when the first shader is compiled with it;
+    ///             - mipmap generation pipelines (Direct3D12 backend) are created by the first
+    ///               IDeviceContext::GenerateMips() call.
+    ///
+    ///             The DX Shader Compiler library is always loaded when it is first used,
+    ///             and the SPIRV-Tools optimizer is only created when a shader is optimized.
+    ///
+    ///             The first operation that uses a deferred subsystem takes longer.
+    ///
+    ///             When the flag is not set and the shader compilation thread pool is available
+    ///             (see DeviceFeatures::AsyncShaderCompilation), the Direct3D12 mipmap generation
+    ///             pipelines are created on the thread pool, and the first IDeviceContext::GenerateMips()
+    ///             call waits for them.
+    Bool DeferSubsystemInitialization DEFAULT_INITIALIZER(False);
 
     /// An optional pointer to the OpenXR attributes, must be set if OpenXR is used.
     /// See Diligent::OpenXRAttribs.
@@ -3626,6 +3720,18 @@ struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// * On Linux this affects the `DRI_PRIME` environment variable that is used by Mesa drivers that support PRIME.
     ADAPTER_TYPE PreferredAdapterType DEFAULT_INITIALIZER(ADAPTER_TYPE_UNKNOWN);
 
+    /// The size of the persistently mapped dynamic heap, in bytes.
+    ///
+    /// When this value is not zero and the device supports GL4.4 or GL_ARB_buffer_storage extension,
+    /// USAGE_DYNAMIC uniform buffers mapped with MAP_FLAG_DISCARD are suballocated from the heap
+    /// and bound by offset, avoiding glMapBufferRange()/glUnmapBuffer() calls.
+    ///
+    /// \remarks   Similar to Direct3D12 and Vulkan backends, the contents of dynamic uniform buffers
+    ///             are only valid in the frame they were mapped in, so the buffers must be mapped
+    ///             with MAP_FLAG_DISCARD in every frame they are used in.
+    ///             If there is not enough space in the heap, the buffer falls back to glMapBufferRange().
+    Uint32 DynamicHeapSize DEFAULT_INITIALIZER(0);
+
 #if PLATFORM_EMSCRIPTEN
     /// WebGL context attributes.
     WebGLContextAttribs WebGLAttribs;
@@ -3667,6 +3773,20 @@ struct EngineD3D11CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// Direct3D11-specific validation options, see Diligent::D3D11_VALIDATION_FLAGS.
     D3D11_VALIDATION_FLAGS D3D11ValidationFlags DEFAULT_INITIALIZER(D3D11_VALIDATION_FLAG_NONE);
 
+    /// Size of the dynamic constant buffer ring of every device context, in bytes.
+    ///
+    /// \remarks    When the ring is enabled, the data of dynamic constant buffers (USAGE_DYNAMIC buffers
+    ///             with BIND_UNIFORM_BUFFER flag only) mapped with MAP_FLAG_DISCARD is suballocated from
+    ///             a large buffer owned by the context, which is mapped with D3D11_MAP_WRITE_NO_OVERWRITE,
+    ///             and the buffers are bound with offsets. The ring is discarded only when it wraps around,
+    ///             which avoids renaming every small buffer in the driver.
+    ///             Similar to Direct3D12 and Vulkan, the contents of such buffers are only valid until the ring
+    ///             wraps around, so the buffers must be mapped every frame before they are used.
+    ///
+    ///             The ring is not used if the size is zero or if the device does not support
+    ///             D3D11_MAP_WRITE_NO_OVERWRITE for dynamic constant buffers.
+    Uint32 DynamicConstantRingSize DEFAULT_INITIALIZER(4 << 20);
+
 #if DILIGENT_CPP_INTERFACE
     EngineD3D11CreateInfo() noexcept :
         EngineD3D11CreateInfo{EngineCreateInfo{}}
@@ -3817,13 +3937,54 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// IDeviceContext::UpdateTexture(), or to map dynamic resources.
     /// Device contexts first request a chunk of memory from global dynamic
     /// resource manager and then suballocate from this chunk in a lock-free
-    /// fashion. DynamicHeapPageSize defines the size of this chunk.
+    /// fashion. DynamicHeapPageSize defines the minimum size of this chunk.
+    /// To reduce contention on the global manager, the context requests larger chunks
+    /// when it used more memory during the previous frame (up to 16 * DynamicHeapPageSize).
     Uint32 DynamicHeapPageSize       DEFAULT_INITIALIZER(1 << 20);
 
     /// Number of dynamic heap pages that will be reserved by the
     /// global dynamic heap manager to avoid page creation at run time.
     Uint32 NumDynamicHeapPagesToReserve DEFAULT_INITIALIZER(1);
 
+    /// Dynamic buffers that have any of these bind flags are suballocated from GPU-local,
+    /// CPU-visible memory (D3D12_HEAP_TYPE_GPU_UPLOAD, requires resizable BAR) instead of
+    /// the upload heap, which reduces GPU read latency. For example, BIND_UNIFORM_BUFFER | BIND_VERTEX_BUFFER
+    /// places dynamic constant and vertex/instance buffers into video memory.
+    /// The flags are ignored if the adapter does not support GPU upload heaps.
+    BIND_FLAGS DynamicGPUUploadHeapBindFlags DEFAULT_INITIALIZER(BIND_NONE);
+
+    /// Default-usage buffers and textures up to this size (in bytes) are created as placed
+    /// resources suballocated from shared D3D12 heaps instead of committed resources.
+    /// Render targets, depth-stencil buffers and multisampled textures are always committed.
+    /// Note that the contents of placed resources are not zero-initialized.
+    /// Zero disables placed resources.
+    Uint32 PlacedResourceMaxSize        DEFAULT_INITIALIZER(4 << 20);
+
+    /// The size of a D3D12 heap that placed resources are suballocated from, see PlacedResourceMaxSize.
+    Uint32 PlacedResourceHeapSize       DEFAULT_INITIALIZER(64 << 20);
+
+    /// Enables residency management. When the video memory usage exceeds the budget reported
+    /// by the OS, committed buffers and textures that have not been used for at least
+    /// ResidencyEvictionFrameThreshold frames are evicted, and are made resident again
+    /// before the command list that uses them is submitted.
+    /// Command lists recorded by deferred contexts must be executed within
+    /// ResidencyEvictionFrameThreshold frames after they have been recorded.
+    Bool   EnableResidencyManagement       DEFAULT_INITIALIZER(False);
+
+    /// The minimum number of frames a resource must stay unused before it may be evicted,
+    /// see EnableResidencyManagement.
+    Uint32 ResidencyEvictionFrameThreshold DEFAULT_INITIALIZER(8);
+
+    /// The maximum number of command list submissions that a command queue batches into one
+    /// ID3D12CommandQueue::ExecuteCommandLists() call. Zero disables batching.
+    ///
+    /// \remarks   Batched command lists are submitted when the immediate context finishes the frame,
+    ///             when the batch is full, and before any operation that depends on them, such as
+    ///             a CPU or GPU fence wait, presentation or tile mapping update.
+    ///             Command queue fence signals are delayed until the batch is submitted.
+    ///             Applications that submit work to the native queue directly must not enable batching.
+    Uint32 SubmitBatchSize DEFAULT_INITIALIZER(0);
+
     /// Query pool size for each query type.
     ///
     /// \remarks    In Direct3D12, queries are allocated from the pool, and
@@ -4010,6 +4171,30 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// pages when resources are released.
     Uint32 HostVisibleMemoryReserveSize     DEFAULT_INITIALIZER(256 << 20);
 
+    /// Resources that are at least this large are allocated in their own memory page
+    /// rather than suballocated from shared pages.
+    ///
+    /// \remarks   Large resources fragment shared pages and force the pages to grow.
+    ///             If VK_KHR_dedicated_allocation is supported, such resources as well as
+    ///             the resources for which the driver prefers dedicated memory use dedicated
+    ///             allocations. Zero disables dedicated pages for large resources.
+    Uint32 DedicatedAllocationThreshold     DEFAULT_INITIALIZER(8 << 20);
+
+    /// Memory allocations up to this size are rounded up to a power-of-two size class,
+    /// and every size class is suballocated from its own memory pages.
+    /// Zero disables size classes.
+    Uint32 SmallAllocationMaxSize           DEFAULT_INITIALIZER(64 << 10);
+
+    /// Page size of the small allocation size classes, see SmallAllocationMaxSize.
+    Uint32 SmallAllocationPageSize          DEFAULT_INITIALIZER(2 << 20);
+
+    /// The number of elements in pMemoryTypePageSizes array.
+    Uint32        MemoryTypePageSizeCount   DEFAULT_INITIALIZER(0);
+
+    /// An optional array of MemoryTypePageSizeCount page sizes, one for every Vulkan memory type.
+    /// Zero value means that DeviceLocalMemoryPageSize or HostVisibleMemoryPageSize is used.
+    const Uint32* pMemoryTypePageSizes      DEFAULT_INITIALIZER(nullptr);
+
     /// Page size of the upload heap that is allocated by immediate/deferred
     /// contexts from the global memory manager to perform lock-free dynamic
     /// suballocations.
@@ -4029,6 +4214,23 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     ///
     Uint32 UploadHeapPageSize               DEFAULT_INITIALIZER(1 << 20);
 
+    /// The maximum total size of the upload pages that the engine keeps for reuse
+    /// after the GPU is done with them.
+    ///
+    /// \remarks   Pages released by the upload heaps of all contexts are grouped by size classes
+    ///             and are reused by the following uploads of similar size, so that repeated uploads
+    ///             do not create new buffers and allocate memory. Zero disables page reuse.
+    ///             On exit, the engine prints the page pool hit rate to the log.
+    Uint32 UploadPagePoolSize               DEFAULT_INITIALIZER(64 << 20);
+
+    /// The size of the persistent upload page.
+    ///
+    /// \remarks   The page is created by the first upload that is at least half as large,
+    ///             and is never released until the device is destroyed. Uploads of this size class
+    ///             always reuse the page once the GPU is done with it, regardless of UploadPagePoolSize.
+    ///             Zero disables the persistent page.
+    Uint32 PersistentUploadPageSize         DEFAULT_INITIALIZER(0);
+
     /// Size of the dynamic heap (the buffer that is used to suballocate
     /// memory for dynamic resources) shared by all contexts.
     /// 
@@ -4065,6 +4267,10 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     ///             heap (which requires synchronization with other contexts), and
     ///             then performs lock-free suballocations from the chunk.
     ///             The size of this chunk is set by DynamicHeapPageSize variable.
+    ///             To reduce contention between contexts, the first chunk requested in a frame
+    ///             is large enough to hold the memory the context used in the previous frame,
+    ///             and every following chunk in the same frame is twice as large (up to
+    ///             1/16 of DynamicHeapSize), so DynamicHeapPageSize is the minimum chunk size.
     ///
     ///             When the application exits, the engine prints dynamic heap statistics
     ///             for each context to the log, for example:
@@ -4107,6 +4313,75 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// features when compiling shaders from HLSL.
     const Char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
 
+    /// Whether to use VK_KHR_dynamic_rendering for implicit render passes, if the device supports it.
+    ///
+    /// \remarks   When enabled, render targets set with IDeviceContext::SetRenderTargets() are
+    ///             bound with vkCmdBeginRendering, and pipeline states that do not use an explicit
+    ///             render pass are created without a Vulkan render pass object. This avoids
+    ///             render pass and framebuffer cache lookups as well as framebuffer creation
+    ///             when texture views are recreated.
+    ///             Explicit render passes (IDeviceContext::BeginRenderPass()) and render targets
+    ///             with a shading rate map always use Vulkan render pass objects.
+    ///
+    ///             IPipelineStateVk::GetRenderPass() returns null for pipelines that use dynamic rendering.
+    Bool EnableDynamicRendering DEFAULT_INITIALIZER(False);
+
+    /// Whether to use VK_EXT_descriptor_buffer for shader resource bindings, if the device supports it.
+    ///
+    /// \remarks   When enabled, descriptors are written directly to the memory of the dynamic heap
+    ///             (see DynamicHeapSize) instead of Vulkan descriptor sets: no descriptor sets are
+    ///             allocated from descriptor pools, and vkUpdateDescriptorSets is never called.
+    ///             Descriptors of each shader resource binding are copied to the device context's
+    ///             dynamic heap every time the resources are committed.
+    ///
+    ///             The extension is only enabled if the entire dynamic heap is addressable as a descriptor
+    ///             buffer. Sparse buffers can't be used as shader resources when descriptor buffers are enabled.
+    Bool EnableDescriptorBuffer DEFAULT_INITIALIZER(False);
+
+    /// Whether to use VK_EXT_graphics_pipeline_library to create graphics pipelines, if the device supports it.
+    ///
+    /// \remarks   When enabled, every graphics pipeline is split into vertex input, pre-rasterization,
+    ///             fragment shader and fragment output libraries. The libraries are cached by the render
+    ///             device and shared between pipelines with identical state, so that only the parts that
+    ///             have not been seen before are compiled. The pipeline is then created by fast-linking
+    ///             the libraries.
+    ///
+    ///             If the engine was created with a shader compilation thread pool (see
+    ///             EngineCreateInfo::NumAsyncShaderCompilationThreads), a link-time optimized pipeline
+    ///             is additionally compiled in the background and replaces the fast-linked one when it
+    ///             is ready.
+    ///
+    ///             Mesh shader pipelines are always created as monolithic objects.
+    Bool EnableGraphicsPipelineLibrary DEFAULT_INITIALIZER(False);
+
+    /// Path to the file that stores the engine-managed pipeline cache.
+    ///
+    /// \remarks   When not null, the pipeline cache is loaded from the file when the device is created, and
+    ///             is used by all pipelines that are created without an explicit pipeline state cache
+    ///             (see PipelineStateCreateInfo::pPSOCache). The data is discarded if it was created by a
+    ///             different device or driver version. The cache is saved to the file when the device is destroyed
+    ///             and, if PipelineCacheSaveInterval is not zero, periodically in a background thread.
+    ///
+    ///             If VK_EXT_shader_module_identifier is supported, the file also stores the shader module
+    ///             identifiers, and compute and monolithic graphics pipelines found in the cache are created
+    ///             without creating the shader modules.
+    const Char* PipelineCacheFilePath DEFAULT_INITIALIZER(nullptr);
+
+    /// Interval, in seconds, at which the engine-managed pipeline cache is saved to PipelineCacheFilePath
+    /// in the background. If zero, the cache is only saved when the device is destroyed.
+    Uint32 PipelineCacheSaveInterval DEFAULT_INITIALIZER(0);
+
+    /// The maximum number of command buffer submissions that a command queue batches into one
+    /// vkQueueSubmit() call. Zero disables batching.
+    ///
+    /// \remarks   Batched command buffers are submitted when the immediate context finishes the frame,
+    ///             when the batch is full, and before any operation that depends on them, such as
+    ///             a CPU fence wait, presentation or sparse binding.
+    ///             Batching is only enabled when timeline semaphores are supported or there is a single
+    ///             immediate context. Applications that submit work to the native queue directly
+    ///             must not enable batching.
+    Uint32 SubmitBatchSize DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     EngineVkCreateInfo() noexcept :
         EngineVkCreateInfo{EngineCreateInfo{}}
@@ -4172,6 +4447,15 @@ struct EngineWebGPUCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     ///  	        IDeviceContext::UpdateTexture(), or to map dynamic textures.
     Uint32 UploadHeapPageSize  DEFAULT_INITIALIZER(8 << 20);
 
+    /// Whether to use mapped staging buffers for the upload heap.
+    ///
+    /// \remarks    When enabled, upload heap pages are MapWrite buffers that the data is written to
+    ///             directly, and that are asynchronously mapped again once the GPU has finished
+    ///             copying from them. This avoids the extra copy wgpuQueueWriteBuffer performs in
+    ///             some implementations (e.g. in browsers), at the cost of keeping more pages alive.
+    ///             When disabled, the data is written to the pages with wgpuQueueWriteBuffer.
+    Bool UseMappedUploadHeap   DEFAULT_INITIALIZER(False);
+
     /// The size of the dynamic heap (the buffer that is used to suballocate memory for dynamic resources).
     ///
     /// \remarks    The dynamic heap is used to allocate memory for dynamic
@@ -4186,6 +4470,14 @@ struct EngineWebGPUCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// the global dynamic heap to perform lock-free dynamic suballocations.
     Uint32 DynamicHeapPageSize DEFAULT_INITIALIZER(256 << 10);
 
+    /// The maximum number of bind groups kept in the bind group cache.
+    ///
+    /// \remarks    Bind groups are shared between shader resource bindings that bind identical
+    ///             resources, and are reused when the same resources are bound again.
+    ///             Least recently used bind groups are evicted when the cache is full.
+    ///             Zero disables the cache.
+    Uint32 BindGroupCacheSize  DEFAULT_INITIALIZER(1024);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[QUERY_TYPE_NUM_TYPES]
 #if DILIGENT_CPP_INTERFACE
@@ -4494,6 +4786,96 @@ struct SparseTextureFormatInfo
 };
 typedef struct SparseTextureFormatInfo SparseTextureFormatInfo;
 
+
+/// Memory heap statistics, see Diligent::DeviceMemoryStats.
+struct MemoryHeapStats
+{
+    /// The amount of heap memory, in bytes, that the process can use without
+    /// degrading performance, as reported by the OS or the driver.
+    /// Zero if the budget is not known.
+    Uint64 Budget   DEFAULT_INITIALIZER(0);
+
+    /// The amount of heap memory, in bytes, that is currently used by the process,
+    /// as reported by the OS or the driver. Zero if the usage is not known.
+    Uint64 Usage    DEFAULT_INITIALIZER(0);
+
+    /// The total size, in bytes, of the memory blocks that the engine has allocated
+    /// from the heap to suballocate resources from (Vulkan memory pages,
+    /// Direct3D12 placed resource heaps).
+    Uint64 Reserved DEFAULT_INITIALIZER(0);
+
+    /// The total size, in bytes, of the suballocations in the reserved memory blocks.
+    Uint64 Used     DEFAULT_INITIALIZER(0);
+
+    /// Indicates if the heap is local to the device.
+    Bool   DeviceLocal DEFAULT_INITIALIZER(False);
+};
+typedef struct MemoryHeapStats MemoryHeapStats;
+
+
+/// Descriptor heap or descriptor pool statistics, see Diligent::DeviceMemoryStats.
+struct DescriptorHeapStats
+{
+    /// The number of allocated descriptors (Direct3D12) or descriptor sets (Vulkan).
+    Uint32 Allocated DEFAULT_INITIALIZER(0);
+
+    /// The total number of descriptors (Direct3D12) or descriptor sets (Vulkan)
+    /// in all heaps or pools created by the engine.
+    Uint32 Capacity  DEFAULT_INITIALIZER(0);
+};
+typedef struct DescriptorHeapStats DescriptorHeapStats;
+
+
+/// Device memory statistics, see IRenderDevice::GetMemoryStats().
+struct DeviceMemoryStats
+{
+    /// The number of elements in the Heaps array.
+    Uint32 NumHeaps DEFAULT_INITIALIZER(0);
+
+    /// Memory heap statistics.
+
+    /// \remarks
+    ///     In Vulkan, the heaps correspond to VkPhysicalDeviceMemoryProperties::memoryHeaps.
+    ///     In Direct3D11 and Direct3D12, the first heap is the local memory segment group
+    ///     (DXGI_MEMORY_SEGMENT_GROUP_LOCAL), and the second heap is the non-local memory
+    ///     segment group (DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL).
+    ///     In Vulkan, if VK_EXT_memory_budget is not available, Budget is the heap size,
+    ///     and Usage is the same as Reserved.
+    ///     In other backends, there are no heaps.
+    MemoryHeapStats Heaps[DILIGENT_MAX_MEMORY_HEAPS] DEFAULT_INITIALIZER({});
+
+    /// The total size, in bytes, of the memory reserved for dynamic resources and
+    /// upload data (Direct3D12 dynamic pages, Vulkan and WebGPU dynamic memory buffers).
+    Uint64 DynamicMemoryReserved DEFAULT_INITIALIZER(0);
+
+    /// The part of the dynamic memory, in bytes, that is used by the device contexts
+    /// or is waiting for the GPU to finish using it.
+    Uint64 DynamicMemoryUsed     DEFAULT_INITIALIZER(0);
+
+    /// Shader-visible resource descriptors.
+
+    /// \remarks
+    ///     In Direct3D12, this is the shader-visible CBV_SRV_UAV descriptor heap, including
+    ///     the space used for dynamic descriptors.
+    ///     In Vulkan, these are the descriptor sets allocated from the main descriptor pools.
+    DescriptorHeapStats ShaderVisibleResourceDescriptors DEFAULT_INITIALIZER({});
+
+    /// Shader-visible sampler descriptors (Direct3D12 only).
+    DescriptorHeapStats ShaderVisibleSamplerDescriptors  DEFAULT_INITIALIZER({});
+
+    /// CPU-only descriptors of all types (Direct3D12 only).
+    DescriptorHeapStats CPUDescriptors                   DEFAULT_INITIALIZER({});
+
+    /// The number of released objects that will be moved to the release queue
+    /// when the next command list is submitted (Direct3D12 and Vulkan only).
+    Uint32 StaleResourceCount          DEFAULT_INITIALIZER(0);
+
+    /// The number of objects in the release queue waiting for the GPU to finish
+    /// using them (Direct3D12 and Vulkan only).
+    Uint32 PendingReleaseResourceCount DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceMemoryStats DeviceMemoryStats;
+
 /// Pipeline stage flags.
 
 /// These flags mirror [VkPipelineStageFlagBits](https://www.khronos.org/registry/vulkan/specs/1.1-extensions/html/vkspec.html#VkPipelineStageFlagBits)
@@ -44,6 +44,8 @@
 #include "RenderDevice.h"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/FixedLinearAllocator.hpp"
+#include "../../../Common/interface/DefaultRawMemoryAllocator.hpp"
 #include "../../GraphicsAccessories/interface/GraphicsAccessories.hpp"
 
 namespace Diligent
@@ -161,6 +163,12 @@ struct SubpassDescX
         return SetShadingRate(&ShadingRateAttachment);
     }
 
+    SubpassDescX& SetViewMask(Uint32 ViewMask) noexcept
+    {
+        Desc.ViewMask = ViewMask;
+        return *this;
+    }
+
     void ClearInputs()
     {
         Inputs.clear();
@@ -1199,6 +1207,97 @@ private:
 
 std::unique_ptr<Uint8[]> CopyPSOCreateInternalInfo(void* pData);
 
+/// Reserves space for the copy of the pipeline state create internal info.
+void ReservePSOCreateInternalInfo(const void* pData, FixedLinearAllocator& MemPool) noexcept;
+
+/// Copies the pipeline state create internal info into the memory pool.
+void* CopyPSOCreateInternalInfo(const void* pData, FixedLinearAllocator& MemPool);
+
+/// Reserves space for the resource layout variables, immutable samplers and their names.
+inline void ReservePipelineResourceLayout(const PipelineResourceLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool) noexcept
+{
+    if (SrcLayout.Variables != nullptr)
+    {
+        MemPool.AddSpace<ShaderResourceVariableDesc>(SrcLayout.NumVariables);
+        for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
+        {
+            VERIFY(SrcLayout.Variables[i].Name != nullptr, "Variable name can't be null");
+            MemPool.AddSpaceForString(SrcLayout.Variables[i].Name);
+        }
+    }
+
+    if (SrcLayout.ImmutableSamplers != nullptr)
+    {
+        MemPool.AddSpace<ImmutableSamplerDesc>(SrcLayout.NumImmutableSamplers);
+        for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
+        {
+            VERIFY(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName != nullptr, "Immutable sampler or texture name can't be null");
+            MemPool.AddSpaceForString(SrcLayout.ImmutableSamplers[i].SamplerOrTextureName);
+        }
+    }
+
+    static_assert(std::is_trivially_destructible<ShaderResourceVariableDesc>::value, "ShaderResourceVariableDesc must be trivially destructible");
+    static_assert(std::is_trivially_destructible<ImmutableSamplerDesc>::value, "ImmutableSamplerDesc must be trivially destructible");
+}
+
+/// Copies the resource layout arrays and names into the memory pool.
+/// The space must have been reserved by ReservePipelineResourceLayout().
+inline void CopyPipelineResourceLayout(const PipelineResourceLayoutDesc& SrcLayout, PipelineResourceLayoutDesc& DstLayout, FixedLinearAllocator& MemPool)
+{
+    if (SrcLayout.Variables != nullptr)
+    {
+        ShaderResourceVariableDesc* const Variables = MemPool.ConstructArray<ShaderResourceVariableDesc>(SrcLayout.NumVariables);
+        DstLayout.Variables                         = Variables;
+        for (Uint32 i = 0; i < SrcLayout.NumVariables; ++i)
+        {
+            const ShaderResourceVariableDesc& SrcVar = SrcLayout.Variables[i];
+            Variables[i]                             = SrcVar;
+            Variables[i].Name                        = MemPool.CopyString(SrcVar.Name);
+        }
+    }
+
+    if (SrcLayout.ImmutableSamplers != nullptr)
+    {
+        ImmutableSamplerDesc* const ImmutableSamplers = MemPool.ConstructArray<ImmutableSamplerDesc>(SrcLayout.NumImmutableSamplers);
+        DstLayout.ImmutableSamplers                   = ImmutableSamplers;
+        for (Uint32 i = 0; i < SrcLayout.NumImmutableSamplers; ++i)
+        {
+            const ImmutableSamplerDesc& SrcSmplr      = SrcLayout.ImmutableSamplers[i];
+            ImmutableSamplers[i]                      = SrcSmplr;
+            ImmutableSamplers[i].SamplerOrTextureName = MemPool.CopyString(SrcSmplr.SamplerOrTextureName);
+        }
+    }
+}
+
+/// Reserves space for the input layout elements and their semantic names.
+inline void ReserveInputLayout(const InputLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool) noexcept
+{
+    if (SrcLayout.NumElements == 0)
+        return;
+
+    MemPool.AddSpace<LayoutElement>(SrcLayout.NumElements);
+    for (Uint32 i = 0; i < SrcLayout.NumElements; ++i)
+        MemPool.AddSpaceForString(SrcLayout.LayoutElements[i].HLSLSemantic);
+
+    static_assert(std::is_trivially_destructible<LayoutElement>::value, "LayoutElement must be trivially destructible");
+}
+
+/// Copies the input layout elements and their semantic names into the memory pool.
+/// The space must have been reserved by ReserveInputLayout().
+///
+/// \return     Pointer to the copied elements, or null if the layout is empty.
+inline LayoutElement* CopyInputLayout(const InputLayoutDesc& SrcLayout, FixedLinearAllocator& MemPool)
+{
+    if (SrcLayout.NumElements == 0)
+        return nullptr;
+
+    LayoutElement* const pElements = MemPool.CopyConstructArray<LayoutElement>(SrcLayout.LayoutElements, SrcLayout.NumElements);
+    for (Uint32 i = 0; i < SrcLayout.NumElements; ++i)
+        pElements[i].HLSLSemantic = MemPool.CopyString(SrcLayout.LayoutElements[i].HLSLSemantic);
+
+    return pElements;
+}
+
 /// C++ wrapper over PipelineStateCreateInfo
 
 template <typename DerivedType, typename CreateInfoType>
@@ -2014,6 +2113,228 @@ struct PipelineStateCreateInfoXTraits<TilePipelineStateCreateInfo>
     using CreateInfoXType = TilePipelineStateCreateInfoX;
 };
 
+/// Immutable deep copy of a pipeline state create info.
+
+/// Unlike the PipelineStateCreateInfoX wrappers that keep every string and array in its own
+/// container, the copy computes the total size of the create info graph up front and places
+/// the name, the resource layout, the input layout, ray tracing shader groups, the internal data
+/// and all strings in a single memory block. All device objects referenced by the create info
+/// (shaders, signatures, render pass, pipeline state cache) are kept alive until the copy is cleared.
+template <typename CreateInfoType>
+class PipelineStateCreateInfoCopy
+{
+public:
+    PipelineStateCreateInfoCopy() noexcept {}
+
+    explicit PipelineStateCreateInfoCopy(const CreateInfoType& CI,
+                                         IMemoryAllocator&     Allocator = DefaultRawMemoryAllocator::GetAllocator()) :
+        m_CI{CI},
+        m_MemPool{Allocator}
+    {
+        size_t NumObjects = 0;
+        ProcessObjects(CI, [&NumObjects](IDeviceObject* pObject) {
+            if (pObject != nullptr)
+                ++NumObjects;
+        });
+
+        m_MemPool.AddSpace<IDeviceObject*>(NumObjects);
+        m_MemPool.AddSpaceForString(CI.PSODesc.Name);
+        ReservePipelineResourceLayout(CI.PSODesc.ResourceLayout, m_MemPool);
+        m_MemPool.AddSpace<IPipelineResourceSignature*>(CI.ResourceSignaturesCount);
+        ReservePSOCreateInternalInfo(CI.pInternalData, m_MemPool);
+        ReservePipelineData(CI, m_MemPool);
+
+        m_MemPool.Reserve();
+
+        m_ppObjects = m_MemPool.Allocate<IDeviceObject*>(NumObjects);
+        ProcessObjects(CI, [this](IDeviceObject* pObject) {
+            if (pObject != nullptr)
+            {
+                pObject->AddRef();
+                m_ppObjects[m_NumObjects++] = pObject;
+            }
+        });
+        VERIFY_EXPR(m_NumObjects == NumObjects);
+
+        m_CI.PSODesc.Name = m_MemPool.CopyString(CI.PSODesc.Name);
+        CopyPipelineResourceLayout(CI.PSODesc.ResourceLayout, m_CI.PSODesc.ResourceLayout, m_MemPool);
+        if (CI.ResourceSignaturesCount > 0)
+            m_CI.ppResourceSignatures = m_MemPool.CopyArray<IPipelineResourceSignature*>(CI.ppResourceSignatures, CI.ResourceSignaturesCount);
+        m_CI.pInternalData = CopyPSOCreateInternalInfo(CI.pInternalData, m_MemPool);
+        CopyPipelineData(CI, m_CI, m_MemPool);
+    }
+
+    // clang-format off
+    PipelineStateCreateInfoCopy           (const PipelineStateCreateInfoCopy&) = delete;
+    PipelineStateCreateInfoCopy& operator=(const PipelineStateCreateInfoCopy&) = delete;
+    // clang-format on
+
+    PipelineStateCreateInfoCopy(PipelineStateCreateInfoCopy&& Other) noexcept :
+        m_CI{Other.m_CI},
+        m_MemPool{std::move(Other.m_MemPool)},
+        m_ppObjects{Other.m_ppObjects},
+        m_NumObjects{Other.m_NumObjects}
+    {
+        Other.m_CI         = CreateInfoType{};
+        Other.m_ppObjects  = nullptr;
+        Other.m_NumObjects = 0;
+    }
+
+    PipelineStateCreateInfoCopy& operator=(PipelineStateCreateInfoCopy&& Other) noexcept
+    {
+        if (this != &Other)
+        {
+            Clear();
+            m_CI         = Other.m_CI;
+            m_MemPool    = std::move(Other.m_MemPool);
+            m_ppObjects  = Other.m_ppObjects;
+            m_NumObjects = Other.m_NumObjects;
+
+            Other.m_CI         = CreateInfoType{};
+            Other.m_ppObjects  = nullptr;
+            Other.m_NumObjects = 0;
+        }
+        return *this;
+    }
+
+    ~PipelineStateCreateInfoCopy()
+    {
+        Clear();
+    }
+
+    /// Releases the device objects and the memory block.
+    void Clear()
+    {
+        for (size_t i = 0; i < m_NumObjects; ++i)
+            m_ppObjects[i]->Release();
+        m_ppObjects  = nullptr;
+        m_NumObjects = 0;
+        m_CI         = CreateInfoType{};
+        m_MemPool.Free();
+    }
+
+    const CreateInfoType& Get() const noexcept { return m_CI; }
+    operator const CreateInfoType&() const noexcept { return m_CI; }
+    const CreateInfoType* operator->() const noexcept { return &m_CI; }
+
+    /// Returns the size of the memory block that holds the copy.
+    size_t GetMemorySize() const noexcept { return m_MemPool.GetReservedSize(); }
+
+private:
+    template <typename HandlerType>
+    static void ProcessCommonObjects(const PipelineStateCreateInfo& CI, HandlerType&& Handler)
+    {
+        for (Uint32 i = 0; i < CI.ResourceSignaturesCount; ++i)
+            Handler(CI.ppResourceSignatures[i]);
+        Handler(CI.pPSOCache);
+    }
+
+    template <typename HandlerType>
+    static void ProcessObjects(const GraphicsPipelineStateCreateInfo& CI, HandlerType&& Handler)
+    {
+        ProcessCommonObjects(CI, Handler);
+        for (IShader* pShader : {CI.pVS, CI.pPS, CI.pDS, CI.pHS, CI.pGS, CI.pAS, CI.pMS})
+            Handler(pShader);
+        Handler(CI.GraphicsPipeline.pRenderPass);
+    }
+
+    template <typename HandlerType>
+    static void ProcessObjects(const ComputePipelineStateCreateInfo& CI, HandlerType&& Handler)
+    {
+        ProcessCommonObjects(CI, Handler);
+        Handler(CI.pCS);
+    }
+
+    template <typename HandlerType>
+    static void ProcessObjects(const TilePipelineStateCreateInfo& CI, HandlerType&& Handler)
+    {
+        ProcessCommonObjects(CI, Handler);
+        Handler(CI.pTS);
+    }
+
+    template <typename HandlerType>
+    static void ProcessObjects(const RayTracingPipelineStateCreateInfo& CI, HandlerType&& Handler)
+    {
+        ProcessCommonObjects(CI, Handler);
+        for (Uint32 i = 0; i < CI.GeneralShaderCount; ++i)
+            Handler(CI.pGeneralShaders[i].pShader);
+        for (Uint32 i = 0; i < CI.TriangleHitShaderCount; ++i)
+        {
+            Handler(CI.pTriangleHitShaders[i].pClosestHitShader);
+            Handler(CI.pTriangleHitShaders[i].pAnyHitShader);
+        }
+        for (Uint32 i = 0; i < CI.ProceduralHitShaderCount; ++i)
+        {
+            Handler(CI.pProceduralHitShaders[i].pIntersectionShader);
+            Handler(CI.pProceduralHitShaders[i].pClosestHitShader);
+            Handler(CI.pProceduralHitShaders[i].pAnyHitShader);
+        }
+    }
+
+    static void ReservePipelineData(const GraphicsPipelineStateCreateInfo& CI, FixedLinearAllocator& MemPool) noexcept
+    {
+        ReserveInputLayout(CI.GraphicsPipeline.InputLayout, MemPool);
+    }
+
+    static void CopyPipelineData(const GraphicsPipelineStateCreateInfo& SrcCI, GraphicsPipelineStateCreateInfo& DstCI, FixedLinearAllocator& MemPool)
+    {
+        DstCI.GraphicsPipeline.InputLayout.LayoutElements = CopyInputLayout(SrcCI.GraphicsPipeline.InputLayout, MemPool);
+    }
+
+    static void ReservePipelineData(const ComputePipelineStateCreateInfo&, FixedLinearAllocator&) noexcept {}
+    static void CopyPipelineData(const ComputePipelineStateCreateInfo&, ComputePipelineStateCreateInfo&, FixedLinearAllocator&) {}
+
+    static void ReservePipelineData(const TilePipelineStateCreateInfo&, FixedLinearAllocator&) noexcept {}
+    static void CopyPipelineData(const TilePipelineStateCreateInfo&, TilePipelineStateCreateInfo&, FixedLinearAllocator&) {}
+
+    template <typename ShaderGroupType>
+    static void ReserveShaderGroups(const ShaderGroupType* pGroups, Uint32 Count, FixedLinearAllocator& MemPool) noexcept
+    {
+        MemPool.AddSpace<ShaderGroupType>(Count);
+        for (Uint32 i = 0; i < Count; ++i)
+            MemPool.AddSpaceForString(pGroups[i].Name);
+    }
+
+    template <typename ShaderGroupType>
+    static const ShaderGroupType* CopyShaderGroups(const ShaderGroupType* pSrcGroups, Uint32 Count, FixedLinearAllocator& MemPool)
+    {
+        if (Count == 0)
+            return nullptr;
+
+        ShaderGroupType* const pDstGroups = MemPool.CopyArray<ShaderGroupType>(pSrcGroups, Count);
+        for (Uint32 i = 0; i < Count; ++i)
+            pDstGroups[i].Name = MemPool.CopyString(pSrcGroups[i].Name);
+        return pDstGroups;
+    }
+
+    static void ReservePipelineData(const RayTracingPipelineStateCreateInfo& CI, FixedLinearAllocator& MemPool) noexcept
+    {
+        ReserveShaderGroups(CI.pGeneralShaders, CI.GeneralShaderCount, MemPool);
+        ReserveShaderGroups(CI.pTriangleHitShaders, CI.TriangleHitShaderCount, MemPool);
+        ReserveShaderGroups(CI.pProceduralHitShaders, CI.ProceduralHitShaderCount, MemPool);
+        MemPool.AddSpaceForString(CI.pShaderRecordName);
+    }
+
+    static void CopyPipelineData(const RayTracingPipelineStateCreateInfo& SrcCI, RayTracingPipelineStateCreateInfo& DstCI, FixedLinearAllocator& MemPool)
+    {
+        DstCI.pGeneralShaders       = CopyShaderGroups(SrcCI.pGeneralShaders, SrcCI.GeneralShaderCount, MemPool);
+        DstCI.pTriangleHitShaders   = CopyShaderGroups(SrcCI.pTriangleHitShaders, SrcCI.TriangleHitShaderCount, MemPool);
+        DstCI.pProceduralHitShaders = CopyShaderGroups(SrcCI.pProceduralHitShaders, SrcCI.ProceduralHitShaderCount, MemPool);
+        DstCI.pShaderRecordName     = MemPool.CopyString(SrcCI.pShaderRecordName);
+    }
+
+private:
+    CreateInfoType       m_CI;
+    FixedLinearAllocator m_MemPool;
+    IDeviceObject**      m_ppObjects  = nullptr;
+    size_t               m_NumObjects = 0;
+};
+
+using GraphicsPipelineStateCreateInfoCopy   = PipelineStateCreateInfoCopy<GraphicsPipelineStateCreateInfo>;
+using ComputePipelineStateCreateInfoCopy    = PipelineStateCreateInfoCopy<ComputePipelineStateCreateInfo>;
+using TilePipelineStateCreateInfoCopy       = PipelineStateCreateInfoCopy<TilePipelineStateCreateInfo>;
+using RayTracingPipelineStateCreateInfoCopy = PipelineStateCreateInfoCopy<RayTracingPipelineStateCreateInfo>;
+
 
 /// C++ wrapper over IRenderDevice.
 template <bool ThrowOnError = true>
@@ -2256,6 +2577,13 @@ public:
         return m_pDevice->GetShaderCompilationThreadPool();
     }
 
+    DeviceMemoryStats GetMemoryStats() const noexcept
+    {
+        DeviceMemoryStats Stats;
+        m_pDevice->GetMemoryStats(Stats);
+        return Stats;
+    }
+
     IRenderDevice* GetDevice() const noexcept
     {
         return m_pDevice;
@@ -129,7 +129,25 @@ DILIGENT_TYPED_ENUM(PIPELINE_RESOURCE_FLAGS, Uint8)
     /// \note This flag is only valid in Vulkan.
     PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT = 1u << 4,
 
-    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_GENERAL_INPUT_ATTACHMENT
+    /// Indicates that the resource is a block of inline constants.
+    /// Applies to SHADER_RESOURCE_TYPE_CONSTANT_BUFFER resources only.
+    ///
+    /// For inline constants, PipelineResourceDesc::ArraySize specifies the number of
+    /// 32-bit constants in the block rather than the array size. The shader declares
+    /// the block as a regular constant (uniform) buffer.
+    /// The values are set with IShaderResourceVariable::SetInlineConstants() and become
+    /// visible to the shaders when the resources are committed with
+    /// IDeviceContext::CommitShaderResources().
+    ///
+    /// \remarks    Inline constants are intended for small per-draw data such as object or material
+    ///             indices and may not exceed MAX_INLINE_CONSTANTS 32-bit values.
+    ///             The variable type must be SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE or
+    ///             SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, and the flag can't be combined with other flags.
+    ///             In all backends, the constants are currently stored in a small internal dynamic
+    ///             uniform buffer owned by the shader resource binding object.
+    PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS   = 1u << 5,
+
+    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS
 };
 DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_RESOURCE_FLAGS);
 
@@ -463,6 +481,26 @@ DILIGENT_BEGIN_INTERFACE(IPipelineResourceSignature, IDeviceObject)
                                                      Bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
 
 
+    /// Creates multiple shader resource binding objects
+
+    /// \param [in]  NumSRBs                  - The number of shader resource binding objects to create.
+    /// \param [out] ppShaderResourceBindings - Array of NumSRBs memory locations where pointers to the new
+    ///                                         shader resource binding objects are written.
+    /// \param [in]  InitStaticResources      - If set to true, the method will initialize static resources in
+    ///                                         all created objects, which has the exact same effect as calling
+    ///                                         IPipelineResourceSignature::InitializeStaticSRBResources() for each of them.
+    ///
+    /// \remarks   The method is equivalent to calling IPipelineResourceSignature::CreateShaderResourceBinding()
+    ///            NumSRBs times, but validates the arguments once for the whole batch.
+    ///            Internal data of every shader resource binding is allocated from fixed-block pools owned by
+    ///            the signature. Set PipelineResourceSignatureDesc::SRBAllocationGranularity to the typical
+    ///            batch size to keep the objects created by one call in contiguous memory.
+    VIRTUAL void METHOD(CreateShaderResourceBindings)(THIS_
+                                                      Uint32                   NumSRBs,
+                                                      IShaderResourceBinding** ppShaderResourceBindings,
+                                                      Bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
+
+
     /// Binds static resources for the specified shader stages in the pipeline resource signature.
 
     /// \param [in] ShaderStages     - Flags that specify shader stages, for which resources will be bound.
@@ -578,6 +616,7 @@ DILIGENT_END_INTERFACE
 #    define IPipelineResourceSignature_GetDesc(This) (const struct PipelineResourceSignatureDesc*)IDeviceObject_GetDesc(This)
 
 #    define IPipelineResourceSignature_CreateShaderResourceBinding(This, ...)  CALL_IFACE_METHOD(PipelineResourceSignature, CreateShaderResourceBinding, This, __VA_ARGS__)
+#    define IPipelineResourceSignature_CreateShaderResourceBindings(This, ...) CALL_IFACE_METHOD(PipelineResourceSignature, CreateShaderResourceBindings,This, __VA_ARGS__)
 #    define IPipelineResourceSignature_BindStaticResources(This, ...)          CALL_IFACE_METHOD(PipelineResourceSignature, BindStaticResources,         This, __VA_ARGS__)
 #    define IPipelineResourceSignature_GetStaticVariableByName(This, ...)      CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByName,     This, __VA_ARGS__)
 #    define IPipelineResourceSignature_GetStaticVariableByIndex(This, ...)     CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByIndex,    This, __VA_ARGS__)
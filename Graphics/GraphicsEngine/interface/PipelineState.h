@@ -661,7 +661,21 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
     ///             the flag is ignored and the pipeline is created synchronously.
     PSO_CREATE_FLAG_ASYNCHRONOUS                      = 1u << 3u,
 
-    PSO_CREATE_FLAG_LAST = PSO_CREATE_FLAG_ASYNCHRONOUS
+    /// Make rasterizer, depth-stencil and primitive topology states dynamic.
+
+    /// \remarks   When this flag is set, the following states of a graphics or mesh pipeline are
+    ///             not baked into the pipeline and can be changed with IDeviceContext::SetDynamicRenderState()
+    ///             without creating a new pipeline state object:
+    ///             - Cull mode and front face (RasterizerDesc::CullMode, RasterizerDesc::FrontCounterClockwise)
+    ///             - All members of DepthStencilDesc
+    ///             - Primitive topology (within the same topology class, e.g. triangle list and triangle strip)
+    ///
+    ///             The values specified in the pipeline description are applied every time the pipeline
+    ///             is bound to the context.
+    ///             Requires DeviceFeatures::ExtendedDynamicState feature.
+    PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE            = 1u << 4u,
+
+    PSO_CREATE_FLAG_LAST = PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE
 };
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
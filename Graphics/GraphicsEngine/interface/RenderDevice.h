@@ -394,6 +394,23 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     VIRTUAL void METHOD(IdleGPU)(THIS) PURE;
 
 
+    /// Waits on the host until all or any of the fences reach the specified values,
+    /// or until the timeout expires.
+
+    /// \param [in] Attribs - Wait attributes, see Diligent::WaitForFencesAttribs.
+    ///
+    /// \return    True if the wait condition has been satisfied, and false if the timeout has expired.
+    ///
+    /// \remarks   In Vulkan, when all fences are backed by timeline semaphores, the method performs a
+    ///            single vkWaitSemaphores call. In Direct3D12, the method waits on one event that is signaled
+    ///            by ID3D12Device1::SetEventOnMultipleFenceCompletion. In other cases, the fences are waited
+    ///            for one by one with IFence::WaitWithTimeout().
+    ///
+    /// \note      All fences must have been created by this device.
+    VIRTUAL Bool METHOD(WaitForFences)(THIS_
+                                       const WaitForFencesAttribs REF Attribs) PURE;
+
+
     /// Returns engine factory this device was created from.
     /// \remarks This method does not increment the reference counter of the returned interface,
     ///          so an application should not call Release().
@@ -405,6 +422,20 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     ///          so an application should not call Release().
     VIRTUAL IThreadPool* METHOD(GetShaderCompilationThreadPool)(THIS) CONST PURE;
 
+
+    /// Returns device memory statistics.
+
+    /// \param [out] Stats - Memory statistics, see Diligent::DeviceMemoryStats.
+    ///
+    /// \remarks   The method is thread-safe and is cheap enough to be called every frame.
+    ///            The members that the backend does not track are set to zero.
+    ///
+    /// \remarks   Reserved and used sizes only cover the memory suballocated by the engine.
+    ///            Resources that have their own allocations (e.g. Direct3D12 committed resources)
+    ///            are only accounted for in MemoryHeapStats::Usage.
+    VIRTUAL void METHOD(GetMemoryStats)(THIS_
+                                        DeviceMemoryStats REF Stats) PURE;
+
 #if DILIGENT_CPP_INTERFACE
     /// Overloaded alias for CreateGraphicsPipelineState.
     void CreatePipelineState(const GraphicsPipelineStateCreateInfo& CI, IPipelineState** ppPipelineState)
@@ -459,8 +490,10 @@ DILIGENT_END_INTERFACE
 #    define IRenderDevice_GetSparseTextureFormatInfo(This, ...)      CALL_IFACE_METHOD(RenderDevice, GetSparseTextureFormatInfo,      This, __VA_ARGS__)
 #    define IRenderDevice_ReleaseStaleResources(This, ...)           CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,           This, __VA_ARGS__)
 #    define IRenderDevice_IdleGPU(This)                              CALL_IFACE_METHOD(RenderDevice, IdleGPU,                         This)
+#    define IRenderDevice_WaitForFences(This, ...)                   CALL_IFACE_METHOD(RenderDevice, WaitForFences,                   This, __VA_ARGS__)
 #    define IRenderDevice_GetEngineFactory(This)                     CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,                This)
 #    define IRenderDevice_GetShaderCompilationThreadPool(This)       CALL_IFACE_METHOD(RenderDevice, GetShaderCompilationThreadPool,  This)
+#    define IRenderDevice_GetMemoryStats(This, ...)                  CALL_IFACE_METHOD(RenderDevice, GetMemoryStats,                  This, __VA_ARGS__)
 // clang-format on
 
 #endif
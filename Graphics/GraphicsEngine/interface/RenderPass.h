@@ -274,6 +274,18 @@ struct SubpassDesc
     /// Pointer to the shading rate attachment, see Diligent::ShadingRateAttachment.
     const ShadingRateAttachment* pShadingRateAttachment     DEFAULT_INITIALIZER(nullptr);
 
+    /// A bit mask of the views the subpass renders to.
+
+    /// If the view mask is not zero, the subpass uses multiview rendering: every draw command
+    /// is broadcast to all views whose bits are set in the mask, and view N renders to array slice N
+    /// of every attachment. The shaders use SV_ViewID (HLSL) or gl_ViewIndex (GLSL) to get
+    /// the index of the view being rendered.
+    /// The view mask must either be zero for all subpasses of the render pass or non-zero for all of them.
+    ///
+    /// \remarks    Requires DeviceFeatures::MultiView feature.
+    ///             In Direct3D12, the highest bit of the mask must be less than 4.
+    Uint32                      ViewMask                    DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     /// Tests if two structures are equivalent
 
@@ -285,7 +297,8 @@ struct SubpassDesc
     {
         if (InputAttachmentCount        != RHS.InputAttachmentCount ||
             RenderTargetAttachmentCount != RHS.RenderTargetAttachmentCount ||
-            PreserveAttachmentCount     != RHS.PreserveAttachmentCount)
+            PreserveAttachmentCount     != RHS.PreserveAttachmentCount ||
+            ViewMask                    != RHS.ViewMask)
             return false;
 
         for(Uint32 i=0; i < InputAttachmentCount; ++i)
@@ -369,7 +369,14 @@ DILIGENT_TYPED_ENUM(SHADER_COMPILE_FLAGS, Uint32)
     ///             they are laid out in memory row-by-row.
     SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR   = 1u << 3u,
 
-    SHADER_COMPILE_FLAG_LAST = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR
+    /// Optimize the shader for size rather than for performance.
+    ///
+    /// \remarks    When the shader is compiled to SPIR-V (Vulkan and WebGPU backends),
+    ///             the SPIR-V optimizer runs size reduction passes instead of the
+    ///             performance passes. The flag is ignored by other backends.
+    SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE       = 1u << 4u,
+
+    SHADER_COMPILE_FLAG_LAST = SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE
 };
 DEFINE_FLAG_ENUM_OPERATORS(SHADER_COMPILE_FLAGS);
 
@@ -179,6 +179,11 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceVariable, IObject)
     /// \remark The method performs run-time correctness checks.
     ///         For instance, shader resource view cannot
     ///         be assigned to a constant buffer variable.
+    ///
+    ///         A buffer or a texture may be bound to a shader resource or unordered
+    ///         access view variable directly, in which case its default view of the
+    ///         matching type is used. The same applies to SetArray() and
+    ///         IShaderResourceBinding::BindResources().
     VIRTUAL void METHOD(Set)(THIS_
                              IDeviceObject*            pObject,
                              SET_SHADER_RESOURCE_FLAGS Flags DEFAULT_VALUE(SET_SHADER_RESOURCE_FLAG_NONE)) PURE;
@@ -260,6 +265,11 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceVariable, IObject)
 
 
     /// Returns the variable index that can be used to access the variable.
+
+    /// \remarks   The index is the same in all shader resource bindings created from the
+    ///            same pipeline resource signature. An application may look up the variable
+    ///            by name once and then use the index with IShaderResourceBinding::GetVariableByIndex()
+    ///            for every SRB of the signature.
     VIRTUAL Uint32 METHOD(GetIndex)(THIS) CONST PURE;
 
 
@@ -269,6 +279,26 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceVariable, IObject)
     ///                          non-array variables.
     VIRTUAL IDeviceObject* METHOD(Get)(THIS_
                                        Uint32 ArrayIndex DEFAULT_VALUE(0)) CONST PURE;
+
+
+    /// Sets the values of the inline constants
+
+    /// \param [in] pConstants    - pointer to the array of NumConstants 32-bit values.
+    /// \param [in] FirstConstant - index of the first 32-bit constant to set.
+    /// \param [in] NumConstants  - the number of 32-bit constants to set.
+    ///
+    /// \remarks This method is only allowed for variables created with
+    ///          PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag. FirstConstant + NumConstants must not
+    ///          exceed the number of constants specified by PipelineResourceDesc::ArraySize.
+    ///
+    ///          The values are copied to the shader resource binding and are uploaded to the GPU
+    ///          when the SRB is committed by IDeviceContext::CommitShaderResources().
+    ///          An application must commit the SRB after updating the constants and before
+    ///          the draw or dispatch command that uses them.
+    VIRTUAL void METHOD(SetInlineConstants)(THIS_
+                                            const void* pConstants,
+                                            Uint32      FirstConstant,
+                                            Uint32      NumConstants) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -278,14 +308,15 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IShaderResourceVariable_Set(This, ...)             CALL_IFACE_METHOD(ShaderResourceVariable, Set,             This, __VA_ARGS__)
-#    define IShaderResourceVariable_SetArray(This, ...)        CALL_IFACE_METHOD(ShaderResourceVariable, SetArray,        This, __VA_ARGS__)
-#    define IShaderResourceVariable_SetBufferRange(This, ...)  CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferRange,  This, __VA_ARGS__)
-#    define IShaderResourceVariable_SetBufferOffset(This, ...) CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferOffset, This, __VA_ARGS__)
-#    define IShaderResourceVariable_GetType(This)              CALL_IFACE_METHOD(ShaderResourceVariable, GetType,         This)
-#    define IShaderResourceVariable_GetResourceDesc(This, ...) CALL_IFACE_METHOD(ShaderResourceVariable, GetResourceDesc, This, __VA_ARGS__)
-#    define IShaderResourceVariable_GetIndex(This)             CALL_IFACE_METHOD(ShaderResourceVariable, GetIndex,        This)
-#    define IShaderResourceVariable_Get(This, ...)             CALL_IFACE_METHOD(ShaderResourceVariable, Get,             This, __VA_ARGS__)
+#    define IShaderResourceVariable_Set(This, ...)                CALL_IFACE_METHOD(ShaderResourceVariable, Set,                This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetArray(This, ...)           CALL_IFACE_METHOD(ShaderResourceVariable, SetArray,           This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetBufferRange(This, ...)     CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferRange,     This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetBufferOffset(This, ...)    CALL_IFACE_METHOD(ShaderResourceVariable, SetBufferOffset,    This, __VA_ARGS__)
+#    define IShaderResourceVariable_GetType(This)                 CALL_IFACE_METHOD(ShaderResourceVariable, GetType,            This)
+#    define IShaderResourceVariable_GetResourceDesc(This, ...)    CALL_IFACE_METHOD(ShaderResourceVariable, GetResourceDesc,    This, __VA_ARGS__)
+#    define IShaderResourceVariable_GetIndex(This)                CALL_IFACE_METHOD(ShaderResourceVariable, GetIndex,           This)
+#    define IShaderResourceVariable_Get(This, ...)                CALL_IFACE_METHOD(ShaderResourceVariable, Get,                This, __VA_ARGS__)
+#    define IShaderResourceVariable_SetInlineConstants(This, ...) CALL_IFACE_METHOD(ShaderResourceVariable, SetInlineConstants, This, __VA_ARGS__)
 
 // clang-format on
 
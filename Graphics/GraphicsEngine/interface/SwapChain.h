@@ -91,14 +91,35 @@ DILIGENT_BEGIN_INTERFACE(ISwapChain, IObject)
 
     /// Sets the maximum number of frames that the swap chain is allowed to queue for rendering.
 
-    /// This value is only relevant for D3D11 and D3D12 backends and ignored for others.
+    /// This value is only relevant for D3D11, D3D12 and Vulkan backends and ignored for others.
     /// By default it matches the number of buffers in the swap chain. For example, for a 2-buffer
     /// swap chain, the CPU can enqueue frames 0 and 1, but Present command of frame 2
     /// will block until frame 0 is presented. If in the example above the maximum frame latency is set
     /// to 1, then Present command of frame 1 will block until Present of frame 0 is complete.
+    ///
+    /// \note  In Vulkan, the latency is limited by waiting for the GPU to complete the frames,
+    ///        and values greater than the number of buffers in the swap chain have no effect.
     VIRTUAL void METHOD(SetMaximumFrameLatency)(THIS_
                                                 Uint32 MaxLatency) PURE;
 
+    /// Waits until the swap chain is ready to accept the next frame.
+
+    /// \param [in] Timeout - Maximum time to wait, in milliseconds.
+    ///                       The default value waits indefinitely.
+    ///
+    /// \return     true if the swap chain is ready for the next frame, and false if the timeout has elapsed.
+    ///
+    /// \remarks    Present() blocks until the number of queued frames is less than the maximum frame latency
+    ///             (see SetMaximumFrameLatency()). An application that calls this method right before it starts
+    ///             recording the next frame performs the wait before the CPU work rather than after it,
+    ///             so that the frame is built from the latest input, which reduces the end-to-end latency.
+    ///             If the method has returned true, the next call to Present() does not wait again.
+    ///             Calling the method more than once per frame has no effect.
+    ///
+    ///             The method is supported in D3D11, D3D12 and Vulkan backends. Other backends return true immediately.
+    VIRTUAL Bool METHOD(WaitForNextFrame)(THIS_
+                                          Uint32 Timeout DEFAULT_VALUE(0xFFFFFFFFu)) PURE;
+
     /// Returns render target view of the current back buffer in the swap chain
 
     /// \note For Direct3D12 and Vulkan backends, the function returns
@@ -131,6 +152,7 @@ DILIGENT_END_INTERFACE
 #    define ISwapChain_SetFullscreenMode(This, ...)      CALL_IFACE_METHOD(SwapChain, SetFullscreenMode,       This, __VA_ARGS__)
 #    define ISwapChain_SetWindowedMode(This)             CALL_IFACE_METHOD(SwapChain, SetWindowedMode,         This)
 #    define ISwapChain_SetMaximumFrameLatency(This, ...) CALL_IFACE_METHOD(SwapChain, SetMaximumFrameLatency,  This, __VA_ARGS__)
+#    define ISwapChain_WaitForNextFrame(This, ...)       CALL_IFACE_METHOD(SwapChain, WaitForNextFrame,        This, __VA_ARGS__)
 #    define ISwapChain_GetCurrentBackBufferRTV(This)     CALL_IFACE_METHOD(SwapChain, GetCurrentBackBufferRTV, This)
 #    define ISwapChain_GetDepthBufferDSV(This)           CALL_IFACE_METHOD(SwapChain, GetDepthBufferDSV,       This)
 
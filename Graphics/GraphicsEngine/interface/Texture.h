@@ -72,7 +72,31 @@ DILIGENT_TYPED_ENUM(MISC_TEXTURE_FLAGS, Uint8)
     /// Requires SHADING_RATE_CAP_FLAG_SUBSAMPLED_RENDER_TARGET capability.
     /// 
     /// \note  Copy operations are not supported for subsampled textures.
-    MISC_TEXTURE_FLAG_SUBSAMPLED      = 1u << 3
+    MISC_TEXTURE_FLAG_SUBSAMPLED      = 1u << 3,
+
+    /// The texture memory may be exported to another API or process (e.g. a video encoder)
+    /// without copying.
+    ///
+    /// \remarks In Vulkan, the image is allocated from its own exportable memory object
+    ///          (VK_KHR_external_memory_fd or VK_KHR_external_memory_win32), use
+    ///          ITextureVk::ExportMemoryHandle() to get the handle.
+    ///          In Direct3D12, the texture is created as a committed resource with
+    ///          D3D12_HEAP_FLAG_SHARED, use ID3D12Device::CreateSharedHandle() to get the handle.
+    ///          Other backends do not support this flag.
+    MISC_TEXTURE_FLAG_EXPORTABLE      = 1u << 4,
+
+    /// The engine will track the state of every mip level and array slice of the texture
+    /// individually rather than a single state for the whole texture.
+    ///
+    /// \remarks When the flag is set, automatic state transitions only affect the subresources
+    ///          referenced by a view (e.g. a single mip level bound as a render target), and
+    ///          barriers use the actual state of each subresource, so that e.g. generating
+    ///          a mip chain does not require whole-texture layout changes.
+    ///          ITexture::GetState() returns RESOURCE_STATE_UNKNOWN while subresources are in
+    ///          different states; use ITexture::GetSubresourceState() to query individual states.
+    ///          The flag is only used by Direct3D12 and Vulkan backends and is ignored by other
+    ///          backends, which only support whole-resource transitions.
+    MISC_TEXTURE_FLAG_SUBRESOURCE_STATES = 1u << 5
 };
 DEFINE_FLAG_ENUM_OPERATORS(MISC_TEXTURE_FLAGS)
 
@@ -444,6 +468,9 @@ DILIGENT_BEGIN_INTERFACE(ITexture, IDeviceObject)
     ///          For non-array textures, the only allowed values for the number of slices are 0 and 1.\n
     ///          Texture view will contain strong reference to the texture, so the texture will not be destroyed
     ///          until all views are released.\n
+    ///          If a view with an identical description (ignoring the name) is alive, the function
+    ///          returns that view instead of creating a new one. Note that the sampler assigned by
+    ///          ITextureView::SetSampler() and the user data are then shared by all owners of the view.\n
     ///          The function calls AddRef() for the created interface, so it must be released by
     ///          a call to Release() when it is no longer needed.
     VIRTUAL void METHOD(CreateView)(THIS_
@@ -479,8 +506,22 @@ DILIGENT_BEGIN_INTERFACE(ITexture, IDeviceObject)
                                   RESOURCE_STATE State) PURE;
 
     /// Returns the internal texture state
+
+    /// \remarks If the texture was created with MISC_TEXTURE_FLAG_SUBRESOURCE_STATES flag and
+    ///          its subresources are in different states, the method returns RESOURCE_STATE_UNKNOWN.
     VIRTUAL RESOURCE_STATE METHOD(GetState)(THIS) CONST PURE;
 
+    /// Returns the internal state of the texture subresource
+
+    /// \param [in] MipLevel   - Mip level of the subresource.
+    /// \param [in] ArraySlice - Array slice of the subresource. Must be 0 for 3D textures.
+    ///
+    /// \remarks If the texture does not track subresource states (see MISC_TEXTURE_FLAG_SUBRESOURCE_STATES),
+    ///          the method returns the state of the whole texture.
+    VIRTUAL RESOURCE_STATE METHOD(GetSubresourceState)(THIS_
+                                                       Uint32 MipLevel,
+                                                       Uint32 ArraySlice) CONST PURE;
+
     /// Returns the sparse texture properties, see Diligent::SparseTextureProperties.
     VIRTUAL const SparseTextureProperties REF METHOD(GetSparseProperties)(THIS) CONST PURE;
 };
@@ -494,12 +535,13 @@ DILIGENT_END_INTERFACE
 
 #    define ITexture_GetDesc(This) (const struct TextureDesc*)IDeviceObject_GetDesc(This)
 
-#    define ITexture_CreateView(This, ...)     CALL_IFACE_METHOD(Texture, CreateView,          This, __VA_ARGS__)
-#    define ITexture_GetDefaultView(This, ...) CALL_IFACE_METHOD(Texture, GetDefaultView,      This, __VA_ARGS__)
-#    define ITexture_GetNativeHandle(This)     CALL_IFACE_METHOD(Texture, GetNativeHandle,     This)
-#    define ITexture_SetState(This, ...)       CALL_IFACE_METHOD(Texture, SetState,            This, __VA_ARGS__)
-#    define ITexture_GetState(This)            CALL_IFACE_METHOD(Texture, GetState,            This)
-#    define ITexture_GetSparseProperties(This) CALL_IFACE_METHOD(Texture, GetSparseProperties, This)
+#    define ITexture_CreateView(This, ...)          CALL_IFACE_METHOD(Texture, CreateView,          This, __VA_ARGS__)
+#    define ITexture_GetDefaultView(This, ...)      CALL_IFACE_METHOD(Texture, GetDefaultView,      This, __VA_ARGS__)
+#    define ITexture_GetNativeHandle(This)          CALL_IFACE_METHOD(Texture, GetNativeHandle,     This)
+#    define ITexture_SetState(This, ...)            CALL_IFACE_METHOD(Texture, SetState,            This, __VA_ARGS__)
+#    define ITexture_GetState(This)                 CALL_IFACE_METHOD(Texture, GetState,            This)
+#    define ITexture_GetSubresourceState(This, ...) CALL_IFACE_METHOD(Texture, GetSubresourceState, This, __VA_ARGS__)
+#    define ITexture_GetSparseProperties(This)      CALL_IFACE_METHOD(Texture, GetSparseProperties, This)
 
 // clang-format on
 
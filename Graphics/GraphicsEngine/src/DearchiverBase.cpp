@@ -27,6 +27,8 @@
 #include "DearchiverBase.hpp"
 #include "PipelineStateBase.hpp"
 #include "PSOSerializer.hpp"
+#include "EngineFactory.h"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -94,6 +96,12 @@ bool VerifShaderUnpackInfo(const ShaderUnpackInfo& DeArchiveInfo, IShader** ppSh
 } // namespace
 
 
+DearchiverBase::DearchiverBase(IReferenceCounters* pRefCounters, const DearchiverCreateInfo& CI) noexcept :
+    TObjectBase{pRefCounters},
+    m_AllowOverrides{CI.AllowOverrides != False}
+{
+}
+
 DearchiverBase::DeviceType DearchiverBase::GetArchiveDeviceType(const IRenderDevice* pDevice)
 {
     VERIFY_EXPR(pDevice != nullptr);
@@ -167,13 +175,79 @@ bool DearchiverBase::NamedResourceCache<ResType>::Get(ResourceType Type, const c
 }
 
 template <typename ResType>
-void DearchiverBase::NamedResourceCache<ResType>::Set(ResourceType Type, const char* Name, ResType* pResource)
+void DearchiverBase::NamedResourceCache<ResType>::Set(ResourceType Type, const char* Name, ResType** ppResource)
 {
     VERIFY_EXPR(Name != nullptr && Name[0] != '\0');
-    VERIFY_EXPR(pResource != nullptr);
+    VERIFY_EXPR(ppResource != nullptr);
+    if (*ppResource == nullptr)
+        return;
+
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Map.find(NamedResourceKey{Type, Name});
+    if (it == m_Map.end())
+    {
+        m_Map.emplace(NamedResourceKey{Type, Name, /*CopyName = */ true}, *ppResource);
+        return;
+    }
+
+    // The same resource may have been unpacked by another thread in the meantime.
+    // Use the cached object so that all pipelines share the same instance.
+    if (auto pCached = it->second.Lock())
+    {
+        if (pCached.RawPtr() != *ppResource)
+        {
+            (*ppResource)->Release();
+            *ppResource = pCached.Detach();
+        }
+        return;
+    }
+
+    // The cached object has expired
+    it->second = RefCntWeakPtr<ResType>{*ppResource};
+}
+
+template <typename ResType>
+void DearchiverBase::NamedResourceCache<ResType>::Remove(ResourceType Type, const char* Name)
+{
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+    m_Map.erase(NamedResourceKey{Type, Name});
+}
+
+size_t DearchiverBase::ShaderContentCache::Key::Hasher::operator()(const Key& K) const noexcept
+{
+    return ComputeHash(K.pData->GetHash(), static_cast<Uint32>(K.DevType), K.SkipReflection);
+}
+
+RefCntAutoPtr<IShader> DearchiverBase::ShaderContentCache::Get(DeviceType DevType, const SerializedData& Data, bool SkipReflection)
+{
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Map.find(Key{&Data, DevType, SkipReflection});
+    return it != m_Map.end() ? it->second.Lock() : RefCntAutoPtr<IShader>{};
+}
+
+void DearchiverBase::ShaderContentCache::Set(DeviceType DevType, const SerializedData& Data, bool SkipReflection, RefCntAutoPtr<IShader>& pShader)
+{
+    VERIFY_EXPR(pShader);
 
     std::unique_lock<std::mutex> Lock{m_Mtx};
-    m_Map.emplace(NamedResourceKey{Type, Name, /*CopyName = */ true}, pResource);
+
+    auto it = m_Map.emplace(Key{&Data, DevType, SkipReflection}, pShader);
+    if (it.second)
+        return;
+
+    // The same shader may have been unpacked by another thread in the meantime
+    if (auto pCached = it.first->second.Lock())
+        pShader = std::move(pCached);
+    else
+        it.first->second = pShader;
+}
+
+void DearchiverBase::ShaderContentCache::Clear()
+{
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+    m_Map.clear();
 }
 
 // Instantiation is required by UnpackResourceSignatureImpl
@@ -453,6 +527,11 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
         if (!SerializedShader)
             return false;
 
+        const bool SkipReflection = (PSO.InternalCI.Flags & PSO_CREATE_INTERNAL_FLAG_NO_SHADER_REFLECTION) != 0;
+
+        // The same shader may have been unpacked from another archive
+        pShader = m_Cache.Shader.Get(DevType, SerializedShader, SkipReflection);
+        if (!pShader)
         {
             ShaderCreateInfo ShaderCI;
             {
@@ -465,12 +544,14 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
                 VERIFY_EXPR(ShaderSer.IsEnded());
             }
 
-            if ((PSO.InternalCI.Flags & PSO_CREATE_INTERNAL_FLAG_NO_SHADER_REFLECTION) != 0)
+            if (SkipReflection)
                 ShaderCI.CompileFlags |= SHADER_COMPILE_FLAG_SKIP_REFLECTION;
 
             pShader = UnpackShader(ShaderCI, pDevice);
             if (!pShader)
                 return false;
+
+            m_Cache.Shader.Set(DevType, SerializedShader, SkipReflection, pShader);
         }
 
         // Add to the cache
@@ -478,7 +559,15 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
             std::unique_lock<std::mutex> WriteLock{ShaderCache.Mtx};
             if (Idx >= ShaderCache.Shaders.size())
                 ShaderCache.Shaders.resize(size_t{Idx} + 1);
-            ShaderCache.Shaders[Idx] = pShader;
+            if (ShaderCache.Shaders[Idx])
+            {
+                // The shader has been unpacked by another thread in the meantime
+                pShader = ShaderCache.Shaders[Idx];
+            }
+            else
+            {
+                ShaderCache.Shaders[Idx] = pShader;
+            }
         }
     }
 
@@ -645,7 +734,7 @@ void DearchiverBase::UnpackPipelineStateImpl(const PipelineStateUnpackInfo& Unpa
     PSO.CreatePipeline(UnpackInfo.pDevice, ppPSO);
 
     if (UnpackInfo.ModifyPipelineStateCreateInfo == nullptr)
-        m_Cache.PSO.Set(ResType, UnpackInfo.Name, *ppPSO);
+        m_Cache.PSO.Set(ResType, UnpackInfo.Name, ppPSO);
 }
 
 bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVersion, bool MakeCopy)
@@ -662,8 +751,37 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVe
         }
     }
 
+    DeviceObjectArchive::CreateInfo ArchiveCI;
+    ArchiveCI.pData          = pArchiveData;
+    ArchiveCI.ContentVersion = ContentVersion;
+    ArchiveCI.MakeCopy       = MakeCopy;
+    return AddArchive(ArchiveCI);
+}
+
+bool DearchiverBase::LoadArchiveFromStream(IFileStream* pStream, Uint32 ContentVersion)
+{
+    if (pStream == nullptr)
+        return false;
+
+    for (const ArchiveData& Archive : m_Archives)
+    {
+        if (Archive.pObjArchive->GetStream() == pStream)
+        {
+            // The archive is already loaded
+            return true;
+        }
+    }
+
+    DeviceObjectArchive::CreateInfo ArchiveCI;
+    ArchiveCI.pStream        = pStream;
+    ArchiveCI.ContentVersion = ContentVersion;
+    return AddArchive(ArchiveCI);
+}
+
+bool DearchiverBase::AddArchive(const DeviceObjectArchive::CreateInfo& ArchiveCI)
+{
     std::unique_ptr<DeviceObjectArchive> pObjArchive = std::make_unique<DeviceObjectArchive>();
-    if (!pObjArchive->Deserialize(DeviceObjectArchive::CreateInfo{pArchiveData, ContentVersion, MakeCopy}))
+    if (!pObjArchive->Deserialize(ArchiveCI))
         return false;
 
     const size_t ArchiveIdx = m_Archives.size();
@@ -678,15 +796,51 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVe
         const auto it_inserted = m_ResNameToArchiveIdx.emplace(NamedResourceKey{ResType, ResName, MakeNameCopy}, ArchiveIdx);
         if (!it_inserted.second)
         {
-            const auto& OtherArchiveResources = m_Archives[it_inserted.first->second].pObjArchive->GetNamedResources();
-            const auto  it_other              = OtherArchiveResources.find(NamedResourceKey{ResType, ResName});
+            const DeviceObjectArchive& OtherArchive          = *m_Archives[it_inserted.first->second].pObjArchive;
+            const auto&                OtherArchiveResources = OtherArchive.GetNamedResources();
+            const auto                 it_other              = OtherArchiveResources.find(NamedResourceKey{ResType, ResName});
+
+            // Device-specific data is compared too
+            pObjArchive->LoadAllDeviceData();
+            OtherArchive.LoadAllDeviceData();
 
             const bool IsDuplicate =
                 (it_other != OtherArchiveResources.end()) &&
                 (it.second == it_other->second);
             if (!IsDuplicate)
             {
-                LOG_ERROR_MESSAGE("Resource with name '", ResName, "' already exists in the archive.");
+                if (m_AllowOverrides)
+                {
+                    // Unpack the resource from the new archive
+                    it_inserted.first->second = ArchiveIdx;
+
+                    // Do not return the objects unpacked from the overridden archive
+                    static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Did you add a new resource type? You may need to handle it here.");
+                    switch (ResType)
+                    {
+                        case ResourceType::ResourceSignature:
+                            m_Cache.Sign.Remove(ResType, ResName);
+                            break;
+
+                        case ResourceType::RenderPass:
+                            m_Cache.RenderPass.Remove(ResType, ResName);
+                            break;
+
+                        case ResourceType::GraphicsPipeline:
+                        case ResourceType::ComputePipeline:
+                        case ResourceType::RayTracingPipeline:
+                        case ResourceType::TilePipeline:
+                            m_Cache.PSO.Remove(ResType, ResName);
+                            break;
+
+                        default:
+                            break;
+                    }
+                }
+                else
+                {
+                    LOG_ERROR_MESSAGE("Resource with name '", ResName, "' already exists in the archive.");
+                }
             }
         }
     }
@@ -797,6 +951,16 @@ void DearchiverBase::UnpackShader(const ShaderUnpackInfo& UnpackInfo,
         VERIFY_EXPR(Ser.IsEnded());
     }
 
+    // Do not cache modified shaders
+    if (UnpackInfo.ModifyShaderDesc == nullptr)
+    {
+        if (auto pCachedShader = m_Cache.Shader.Get(DevType, SerializedShader, /*SkipReflection = */ false))
+        {
+            *ppShader = pCachedShader.Detach();
+            return;
+        }
+    }
+
     if (!ModifyShaderDesc(ShaderCI.Desc, UnpackInfo))
         return;
 
@@ -804,6 +968,9 @@ void DearchiverBase::UnpackShader(const ShaderUnpackInfo& UnpackInfo,
     if (!pShader)
         return;
 
+    if (UnpackInfo.ModifyShaderDesc == nullptr)
+        m_Cache.Shader.Set(DevType, SerializedShader, /*SkipReflection = */ false, pShader);
+
     pShader->QueryInterface(IID_Shader, reinterpret_cast<IObject**>(ppShader));
 }
 
@@ -854,7 +1021,7 @@ void DearchiverBase::UnpackRenderPass(const RenderPassUnpackInfo& UnpackInfo, IR
     UnpackInfo.pDevice->CreateRenderPass(RP.Desc, ppRP);
 
     if (UnpackInfo.ModifyRenderPassDesc == nullptr)
-        m_Cache.RenderPass.Set(RPData::ArchiveResType, UnpackInfo.Name, *ppRP);
+        m_Cache.RenderPass.Set(RPData::ArchiveResType, UnpackInfo.Name, ppRP);
 }
 
 bool DearchiverBase::Store(IDataBlob** ppArchive) const
@@ -873,7 +1040,7 @@ bool DearchiverBase::Store(IDataBlob** ppArchive) const
         for (const auto& Archive : m_Archives)
         {
             if (Archive.pObjArchive)
-                MergedArchive.Merge(*Archive.pObjArchive);
+                MergedArchive.Merge(*Archive.pObjArchive, m_AllowOverrides);
         }
 
         MergedArchive.Serialize(ppArchive);
@@ -887,6 +1054,9 @@ bool DearchiverBase::Store(IDataBlob** ppArchive) const
 
 void DearchiverBase::Reset()
 {
+    // The shader cache references the archive data
+    m_Cache.Shader.Clear();
+    m_ResNameToArchiveIdx.clear();
     m_Archives.clear();
 }
 
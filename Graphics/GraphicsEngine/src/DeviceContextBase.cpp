@@ -318,7 +318,7 @@ bool VerifyResolveTextureSubresourceAttribs(const ResolveTextureSubresourceAttri
     return true;
 }
 
-bool VerifyBeginRenderPassAttribs(const BeginRenderPassAttribs& Attribs)
+bool VerifyBeginRenderPassAttribs(const BeginRenderPassAttribs& Attribs, bool IsDeferredContext)
 {
 #define CHECK_BEGIN_RENDER_PASS_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Begin render pass attribs are invalid: ", __VA_ARGS__)
 
@@ -327,6 +327,16 @@ bool VerifyBeginRenderPassAttribs(const BeginRenderPassAttribs& Attribs)
 
     const auto& RPDesc = Attribs.pRenderPass->GetDesc();
 
+    if (IsDeferredContext && (Attribs.Flags & BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS) != 0)
+    {
+        // The render pass is inherited from the immediate context that starts the instance,
+        // so clear values are not used.
+        CHECK_BEGIN_RENDER_PASS_ATTRIBS(RPDesc.SubpassCount == 1,
+                                        "render pass '", RPDesc.Name, "' inherited by a deferred context must have a single subpass, but it has ",
+                                        RPDesc.SubpassCount, " subpasses.");
+        return true;
+    }
+
     Uint32 NumRequiredClearValues = 0;
     for (Uint32 i = 0; i < RPDesc.AttachmentCount; ++i)
     {
@@ -501,12 +511,6 @@ bool VerifyStateTransitionDesc(const IRenderDevice*       pDevice,
         ImmediateContextMask = TexDesc.ImmediateContextMask;
 
         CHECK_STATE_TRANSITION_DESC(VerifyResourceStates(Barrier.NewState, true), "invalid new state specified for texture '", TexDesc.Name, "'.");
-        OldState = Barrier.OldState != RESOURCE_STATE_UNKNOWN ? Barrier.OldState : pTexture->GetState();
-        CHECK_STATE_TRANSITION_DESC(OldState != RESOURCE_STATE_UNKNOWN,
-                                    "the state of texture '", TexDesc.Name,
-                                    "' is unknown to the engine and is not explicitly specified in the barrier.");
-        CHECK_STATE_TRANSITION_DESC(VerifyResourceStates(OldState, true), "invalid old state specified for texture '", TexDesc.Name, "'.");
-
         CHECK_STATE_TRANSITION_DESC(Barrier.FirstMipLevel < TexDesc.MipLevels, "first mip level (", Barrier.FirstMipLevel,
                                     ") specified by the barrier is out of range. Texture '",
                                     TexDesc.Name, "' has only ", TexDesc.MipLevels, " mip level(s).");
@@ -523,6 +527,14 @@ bool VerifyStateTransitionDesc(const IRenderDevice*       pDevice,
                                     " specified by the barrier is out of range. Array size of texture '",
                                     TexDesc.Name, "' is ", TexDesc.GetArraySize());
 
+        // When the texture tracks subresource states, its subresources may be in different states,
+        // in which case GetState() returns unknown state. Use the state of the first subresource in the range.
+        OldState = Barrier.OldState != RESOURCE_STATE_UNKNOWN ? Barrier.OldState : pTexture->GetSubresourceState(Barrier.FirstMipLevel, Barrier.FirstArraySlice);
+        CHECK_STATE_TRANSITION_DESC(OldState != RESOURCE_STATE_UNKNOWN,
+                                    "the state of texture '", TexDesc.Name,
+                                    "' is unknown to the engine and is not explicitly specified in the barrier.");
+        CHECK_STATE_TRANSITION_DESC(VerifyResourceStates(OldState, true), "invalid old state specified for texture '", TexDesc.Name, "'.");
+
         auto DeviceType = pDevice->GetDeviceInfo().Type;
         if (DeviceType != RENDER_DEVICE_TYPE_D3D12 && DeviceType != RENDER_DEVICE_TYPE_VULKAN)
         {
@@ -27,12 +27,16 @@
 #include "DeviceObjectArchive.hpp"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <sstream>
 
 #include "Shader.h"
 #include "EngineMemory.h"
 #include "DataBlobImpl.hpp"
 #include "PSOSerializer.hpp"
+#include "Align.hpp"
+#include "BlockCompression.hpp"
 
 namespace Diligent
 {
@@ -73,6 +77,21 @@ DeviceObjectArchive::ArchiveHeader::ArchiveHeader() noexcept
 namespace
 {
 
+enum class ShaderCompression : Uint32
+{
+    None = 0,
+    LZ4  = 1
+};
+
+// Shaders prepared for serialization
+struct ShaderCompressionData
+{
+    std::vector<Uint8> Dictionary;
+
+    // Compressed data of every shader. Empty if the shader is stored uncompressed.
+    std::vector<std::vector<Uint8>> Data;
+};
+
 template <SerializerMode Mode>
 struct ArchiveSerializer
 {
@@ -81,74 +100,273 @@ struct ArchiveSerializer
     template <typename T>
     using ConstQual = typename Serializer<Mode>::template ConstQual<T>;
 
-    using ArchiveHeader = DeviceObjectArchive::ArchiveHeader;
-    using ResourceData  = DeviceObjectArchive::ResourceData;
-    using ShadersVector = std::vector<SerializedData>;
+    using ArchiveHeader       = DeviceObjectArchive::ArchiveHeader;
+    using DeviceSectionsArray = DeviceObjectArchive::DeviceSectionsArray;
+    using ShadersVector       = std::vector<SerializedData>;
 
-    bool SerializeHeader(ConstQual<ArchiveHeader>& Header) const
+    bool SerializeHeader(ConstQual<ArchiveHeader>& Header, ConstQual<DeviceSectionsArray>& Sections) const
     {
         ASSERT_SIZEOF64(Header, 24, "Please handle new members here");
-        // NB: this must match header deserialization in DeviceObjectArchive::Deserialize
-        return Ser(Header.MagicNumber, Header.Version, Header.APIVersion, Header.ContentVersion, Header.GitHash);
-    }
-
-    bool SerializeResourceData(ConstQual<ResourceData>& ResData) const
-    {
-        if (!Ser.Serialize(ResData.Common))
-            return true;
+        // NB: this must match header deserialization in ReadFixedHeader and DeviceObjectArchive::Deserialize
+        if (!Ser(Header.MagicNumber, Header.Version, Header.APIVersion, Header.ContentVersion))
+            return false;
 
-        for (auto& DevData : ResData.DeviceSpecific)
+        for (auto& Section : Sections)
         {
-            if (!Ser.Serialize(DevData))
+            if (!Ser(Section.Offset, Section.Size))
                 return false;
         }
 
-        return true;
+        return Ser(Header.GitHash);
     }
 
-    bool SerializeShaders(ConstQual<ShadersVector>& Shaders) const;
+    bool SerializeShaders(const ShadersVector& Shaders, const ShaderCompressionData* pCompression) const;
 };
 
 template <SerializerMode Mode>
-bool ArchiveSerializer<Mode>::SerializeShaders(ConstQual<ShadersVector>& Shaders) const
+bool ArchiveSerializer<Mode>::SerializeShaders(const ShadersVector& Shaders, const ShaderCompressionData* pCompression) const
 {
     static_assert(Mode == SerializerMode::Measure || Mode == SerializerMode::Write, "Measure or Write mode is expected.");
+    VERIFY_EXPR(pCompression == nullptr || pCompression->Data.size() == Shaders.size());
 
-    Uint32 NumShaders = static_cast<Uint32>(Shaders.size());
-    if (!Ser(NumShaders))
+    // NB: this must match shader deserialization in DeviceObjectArchive::LoadDeviceSection
+    const Uint32            NumShaders  = static_cast<Uint32>(Shaders.size());
+    const ShaderCompression Compression = pCompression != nullptr ? ShaderCompression::LZ4 : ShaderCompression::None;
+    if (!Ser(NumShaders, Compression))
         return false;
 
-    for (const auto& Shader : Shaders)
+    if (pCompression != nullptr)
     {
-        if (!Ser.Serialize(Shader))
+        const std::vector<Uint8>& Dictionary = pCompression->Dictionary;
+        if (!Ser.Serialize(SerializedData{const_cast<Uint8*>(Dictionary.data()), Dictionary.size()}))
+            return false;
+    }
+
+    for (size_t i = 0; i < Shaders.size(); ++i)
+    {
+        const SerializedData& Shader = Shaders[i];
+        if (pCompression == nullptr)
+        {
+            if (!Ser.Serialize(Shader))
+                return false;
+            continue;
+        }
+
+        // The shader is stored uncompressed if its size is equal to the decompressed size
+        const Uint32              Size       = static_cast<Uint32>(Shader.Size());
+        const std::vector<Uint8>& Compressed = pCompression->Data[i];
+        if (!Ser(Size))
+            return false;
+        if (!Ser.Serialize(Compressed.empty() ? SerializedData{Shader.Ptr(), Shader.Size()} : SerializedData{const_cast<Uint8*>(Compressed.data()), Compressed.size()}))
             return false;
     }
 
     return true;
 }
 
-template <>
-bool ArchiveSerializer<SerializerMode::Read>::SerializeShaders(ShadersVector& Shaders) const
+ShaderCompressionData CompressShaders(const std::vector<SerializedData>& Shaders)
 {
-    Uint32 NumShaders = 0;
-    if (!Ser(NumShaders))
-        return false;
+    ShaderCompressionData Compression;
 
-    Shaders.resize(NumShaders);
-    for (auto& Shader : Shaders)
+    std::vector<CompressionSample> Samples;
+    Samples.reserve(Shaders.size());
+    size_t TotalSize = 0;
+    for (const SerializedData& Shader : Shaders)
     {
-        if (!Ser.Serialize(Shader))
+        Samples.push_back({Shader.Ptr(), Shader.Size()});
+        TotalSize += Shader.Size();
+    }
+
+    // LZ4 can only reference the last 64 KB of the dictionary
+    Compression.Dictionary = TrainCompressionDictionary(Samples, std::min(size_t{64} << 10, TotalSize / 8));
+
+    Compression.Data.resize(Shaders.size());
+    for (size_t i = 0; i < Shaders.size(); ++i)
+    {
+        const SerializedData& Shader = Shaders[i];
+
+        std::vector<Uint8> Compressed(GetLZ4CompressBound(Shader.Size()));
+        const size_t       CompressedSize = CompressLZ4Block(Shader.Ptr(), Shader.Size(), Compressed.data(), Compressed.size(),
+                                                             Compression.Dictionary.data(), Compression.Dictionary.size());
+        // Keep incompressible shaders as is
+        if (CompressedSize != 0 && CompressedSize < Shader.Size())
+        {
+            Compressed.resize(CompressedSize);
+            Compression.Data[i] = std::move(Compressed);
+        }
+    }
+
+    return Compression;
+}
+
+const char* ArchiveDeviceTypeToString(Uint32 dev)
+{
+    using DeviceType = DeviceObjectArchive::DeviceType;
+    static_assert(static_cast<Uint32>(DeviceType::Count) == 7, "Please handle the new archive device type below");
+    switch (static_cast<DeviceType>(dev))
+    {
+            // clang-format off
+        case DeviceType::OpenGL:      return "OpenGL";
+        case DeviceType::Direct3D11:  return "Direct3D11";
+        case DeviceType::Direct3D12:  return "Direct3D12";
+        case DeviceType::Vulkan:      return "Vulkan";
+        case DeviceType::Metal_MacOS: return "Metal for MacOS";
+        case DeviceType::Metal_iOS:   return "Metal for iOS";
+        case DeviceType::WebGPU:      return "WebGPU";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected device type");
+            return "unknown";
+    }
+}
+
+const char* ResourceTypeToString(DeviceObjectArchive::ResourceType Type)
+{
+    using ResourceType = DeviceObjectArchive::ResourceType;
+    static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Please handle the new chunk type below");
+    switch (Type)
+    {
+            // clang-format off
+        case ResourceType::Undefined:          return "Undefined";
+        case ResourceType::StandaloneShader:   return "Standalone Shaders";
+        case ResourceType::ResourceSignature:  return "Resource Signatures";
+        case ResourceType::GraphicsPipeline:   return "Graphics Pipelines";
+        case ResourceType::ComputePipeline:    return "Compute Pipelines";
+        case ResourceType::RayTracingPipeline: return "Ray-Tracing Pipelines";
+        case ResourceType::TilePipeline:       return "Tile Pipelines";
+        case ResourceType::RenderPass:         return "Render Passes";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected chunk type");
+            return "";
+    }
+}
+
+// Reads the part of the header that precedes the Git hash and validates it.
+bool ReadFixedHeader(Serializer<SerializerMode::Read>&         Reader,
+                     DeviceObjectArchive::ArchiveHeader&       Header,
+                     DeviceObjectArchive::DeviceSectionsArray& Sections,
+                     Uint32                                    ExpectedContentVersion,
+                     size_t                                    ArchiveSize)
+{
+#define CHECK_HEADER(Expr, ...)             \
+    do                                      \
+    {                                       \
+        if (!(Expr))                        \
+        {                                   \
+            LOG_ERROR_MESSAGE(__VA_ARGS__); \
+            return false;                   \
+        }                                   \
+    } while (false)
+
+    // NB: this must match header serialization in ArchiveSerializer::SerializeHeader
+    ASSERT_SIZEOF64(Header, 24, "Please handle new members here");
+    CHECK_HEADER(Reader(Header.MagicNumber), "Failed to read device object archive header magic number.");
+
+    CHECK_HEADER(Header.MagicNumber == DeviceObjectArchive::HeaderMagicNumber, "Invalid device object archive header.");
+
+    CHECK_HEADER(Reader(Header.Version), "Failed to read device object archive version.");
+
+    CHECK_HEADER(Header.Version == DeviceObjectArchive::ArchiveVersion, "Unsupported device object archive version: ", Header.Version, ". Expected version: ", Uint32{DeviceObjectArchive::ArchiveVersion});
+
+    CHECK_HEADER(Reader(Header.APIVersion), "Failed to read Diligent API version.");
+
+    CHECK_HEADER(Reader(Header.ContentVersion), "Failed to read device object archive content version.");
+
+    CHECK_HEADER(ExpectedContentVersion == DeviceObjectArchive::CreateInfo{}.ContentVersion || Header.ContentVersion == ExpectedContentVersion,
+                 "Invalid archive content version: ", Header.ContentVersion, ". Expected version: ", ExpectedContentVersion);
+
+    for (auto& Section : Sections)
+    {
+        CHECK_HEADER(Reader(Section.Offset, Section.Size), "Failed to read device object archive section table.");
+        CHECK_HEADER(Section.Offset <= ArchiveSize && Section.Size <= ArchiveSize - Section.Offset,
+                     "Device section [", Section.Offset, ", ", Section.Offset + Section.Size, ") is out of the archive bounds.");
+    }
+#undef CHECK_HEADER
+
+    return true;
+}
+
+bool HasShaderIndices(DeviceObjectArchive::ResourceType ResType)
+{
+    using ResourceType = DeviceObjectArchive::ResourceType;
+    static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Did you add a new resource type? You may need to handle it here.");
+    return (ResType == ResourceType::StandaloneShader ||
+            ResType == ResourceType::GraphicsPipeline ||
+            ResType == ResourceType::ComputePipeline ||
+            ResType == ResourceType::RayTracingPipeline ||
+            ResType == ResourceType::TilePipeline);
+}
+
+// Reads the indices of the shaders in the archive's shader array that are used by the resource.
+bool ReadShaderIndices(DeviceObjectArchive::ResourceType ResType,
+                       const SerializedData&             DeviceData,
+                       DynamicLinearAllocator&           Allocator,
+                       std::vector<Uint32>&              Indices)
+{
+    Indices.clear();
+    if (!DeviceData || !HasShaderIndices(ResType))
+        return true;
+
+    Serializer<SerializerMode::Read> Ser{DeviceData};
+    if (ResType == DeviceObjectArchive::ResourceType::StandaloneShader)
+    {
+        // For shaders, device-specific data is the serialized shader bytecode index
+        Uint32 ShaderIndex = 0;
+        if (!Ser(ShaderIndex))
+            return false;
+        VERIFY(Ser.IsEnded(), "No other data besides the shader index is expected");
+        Indices.push_back(ShaderIndex);
+    }
+    else
+    {
+        // For pipelines, device-specific data is the shader index array
+        DeviceObjectArchive::ShaderIndexArray ShaderIndices;
+        if (!PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(Ser, ShaderIndices, &Allocator))
             return false;
+        VERIFY(Ser.IsEnded(), "No other data besides shader indices is expected");
+        Indices.assign(ShaderIndices.pIndices, ShaderIndices.pIndices + ShaderIndices.Count);
     }
 
     return true;
 }
 
+// Replaces every shader index of the resource with Remap(Index). The data is updated in place.
+template <typename RemapType>
+void RemapShaderIndices(DeviceObjectArchive::ResourceType ResType,
+                        SerializedData&                   DeviceData,
+                        DynamicLinearAllocator&           Allocator,
+                        RemapType&&                       Remap) noexcept(false)
+{
+    std::vector<Uint32> Indices;
+    if (!ReadShaderIndices(ResType, DeviceData, Allocator, Indices))
+    {
+        LOG_ERROR_AND_THROW(ResType == DeviceObjectArchive::ResourceType::StandaloneShader ?
+                                "Failed to deserialize standalone shader index. Archive file may be corrupted or invalid." :
+                                "Failed to deserialize PSO shader indices. Archive file may be corrupted or invalid.");
+    }
+    if (Indices.empty())
+        return;
+
+    for (Uint32& Idx : Indices)
+        Idx = Remap(Idx);
+
+    // The size of the serialized indices does not change
+    Serializer<SerializerMode::Write> Ser{DeviceData};
+    if (ResType == DeviceObjectArchive::ResourceType::StandaloneShader)
+        Ser(Indices[0]);
+    else
+        PSOSerializer<SerializerMode::Write>::SerializeShaderIndices(Ser, DeviceObjectArchive::ShaderIndexArray{Indices.data(), static_cast<Uint32>(Indices.size())}, nullptr);
+    VERIFY_EXPR(Ser.IsEnded());
+}
+
 } // namespace
 
 DeviceObjectArchive::DeviceObjectArchive(Uint32 ContentVersion) noexcept :
     m_ContentVersion{ContentVersion}
 {
+    for (auto& Loaded : m_DeviceDataLoaded)
+        Loaded.store(true);
 }
 
 void DeviceObjectArchive::Clear() noexcept
@@ -156,9 +374,212 @@ void DeviceObjectArchive::Clear() noexcept
     m_NamedResources.clear();
     m_DeviceShaders = {};
     m_pArchiveData.Release();
+    m_pStream.Release();
+    m_DeviceSections = {};
+    m_ResourceOrder.clear();
+    m_DeviceSectionData = {};
+    m_CompressedShaders = {};
+    m_ShaderDictionaries = {};
+    m_CompressShaders = false;
+    for (auto& Loaded : m_DeviceDataLoaded)
+        Loaded.store(true);
     m_ContentVersion = 0;
 }
 
+bool DeviceObjectArchive::LoadDeviceData(DeviceType Dev) const noexcept
+{
+    const size_t DevIdx = static_cast<size_t>(Dev);
+    VERIFY_EXPR(DevIdx < m_DeviceDataLoaded.size());
+    if (m_DeviceDataLoaded[DevIdx].load(std::memory_order_acquire))
+        return true;
+
+    std::lock_guard<std::mutex> Lock{m_DeviceDataMtx};
+    if (m_DeviceDataLoaded[DevIdx].load(std::memory_order_relaxed))
+        return true;
+
+    bool Res = false;
+    try
+    {
+        Res = LoadDeviceSection(DevIdx);
+    }
+    catch (...)
+    {
+    }
+
+    if (!Res)
+    {
+        // Leave the device data empty so that the objects can't be unpacked
+        for (ResourceData* pResData : m_ResourceOrder)
+            pResData->DeviceSpecific[DevIdx] = {};
+        m_DeviceShaders[DevIdx].clear();
+        m_CompressedShaders[DevIdx].clear();
+        m_ShaderDictionaries[DevIdx] = {};
+        m_DeviceSectionData[DevIdx].Release();
+    }
+
+    // Do not retry if the section could not be read
+    m_DeviceDataLoaded[DevIdx].store(true, std::memory_order_release);
+
+    return Res;
+}
+
+bool DeviceObjectArchive::LoadAllDeviceData() const noexcept
+{
+    bool Res = true;
+    for (size_t i = 0; i < static_cast<size_t>(DeviceType::Count); ++i)
+    {
+        if (!LoadDeviceData(static_cast<DeviceType>(i)))
+            Res = false;
+    }
+    return Res;
+}
+
+void DeviceObjectArchive::SetDeviceDataLoaded(DeviceType Dev) noexcept
+{
+    const size_t DevIdx = static_cast<size_t>(Dev);
+
+    std::lock_guard<std::mutex> Lock{m_DeviceDataMtx};
+    m_DeviceSectionData[DevIdx].Release();
+    m_DeviceDataLoaded[DevIdx].store(true, std::memory_order_release);
+}
+
+bool DeviceObjectArchive::LoadDeviceSection(size_t DevIdx) const
+{
+    const DeviceSection& Section = m_DeviceSections[DevIdx];
+
+    SerializedData SectionData;
+    if (m_pStream)
+    {
+        RefCntAutoPtr<DataBlobImpl> pData = DataBlobImpl::Create(StaticCast<size_t>(Section.Size));
+        if (!m_pStream->SetPos(StaticCast<size_t>(Section.Offset), SEEK_SET) ||
+            !m_pStream->Read(pData->GetDataPtr(), pData->GetSize()))
+        {
+            LOG_ERROR_MESSAGE("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " section of the device object archive.");
+            return false;
+        }
+        SectionData                 = SerializedData{pData->GetDataPtr(), pData->GetSize()};
+        m_DeviceSectionData[DevIdx] = std::move(pData);
+    }
+    else
+    {
+        VERIFY_EXPR(m_pArchiveData && Section.Offset + Section.Size <= m_pArchiveData->GetSize());
+        SectionData = SerializedData{
+            const_cast<Uint8*>(m_pArchiveData->GetConstDataPtr<Uint8>()) + Section.Offset,
+            StaticCast<size_t>(Section.Size),
+        };
+    }
+
+    Serializer<SerializerMode::Read> Reader{SectionData};
+    for (ResourceData* pResData : m_ResourceOrder)
+    {
+        if (!Reader.Serialize(pResData->DeviceSpecific[DevIdx]))
+        {
+            LOG_ERROR_MESSAGE("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " resource data from the device object archive.");
+            return false;
+        }
+    }
+
+    // NB: this must match shader serialization in ArchiveSerializer::SerializeShaders
+    Uint32            NumShaders  = 0;
+    ShaderCompression Compression = ShaderCompression::None;
+    if (!Reader(NumShaders, Compression) || (Compression != ShaderCompression::None && Compression != ShaderCompression::LZ4))
+    {
+        LOG_ERROR_MESSAGE("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shader data from the device object archive.");
+        return false;
+    }
+
+    auto& Shaders = m_DeviceShaders[DevIdx];
+    Shaders.clear();
+    Shaders.resize(NumShaders);
+
+    auto& CompressedShaders = m_CompressedShaders[DevIdx];
+    CompressedShaders.clear();
+    if (Compression == ShaderCompression::LZ4)
+    {
+        m_CompressShaders = true;
+        CompressedShaders.resize(NumShaders);
+        if (!Reader.Serialize(m_ShaderDictionaries[DevIdx]))
+        {
+            LOG_ERROR_MESSAGE("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shader compression dictionary from the device object archive.");
+            return false;
+        }
+    }
+
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        Uint32 Size = 0;
+        if ((Compression == ShaderCompression::LZ4 && !Reader(Size)) || !Reader.Serialize(Shaders[i]))
+        {
+            LOG_ERROR_MESSAGE("Failed to read ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shader data from the device object archive.");
+            return false;
+        }
+
+        if (Compression == ShaderCompression::LZ4 && Shaders[i].Size() != Size)
+        {
+            // The shader is decompressed when it is accessed for the first time
+            CompressedShaders[i]       = std::make_unique<CompressedShader>();
+            CompressedShaders[i]->Data = std::move(Shaders[i]);
+            CompressedShaders[i]->Size = Size;
+        }
+    }
+    VERIFY(Reader.IsEnded(), "There is unread data in the device section");
+
+    return true;
+}
+
+
+void DeviceObjectArchive::DecompressShader(size_t DevIdx, size_t Idx) const noexcept
+{
+    const auto& CompressedShaders = m_CompressedShaders[DevIdx];
+    if (Idx >= CompressedShaders.size() || !CompressedShaders[Idx])
+        return;
+
+    CompressedShader& Shader = *CompressedShaders[Idx];
+    try
+    {
+        // Different shaders are decompressed in parallel
+        std::call_once(Shader.DecompressFlag, [&]() {
+            const SerializedData& Dictionary = m_ShaderDictionaries[DevIdx];
+
+            SerializedData Data{Shader.Size, GetRawAllocator()};
+            if (DecompressLZ4Block(Shader.Data.Ptr(), Shader.Data.Size(), Data.Ptr(), Data.Size(), Dictionary.Ptr(), Dictionary.Size()))
+            {
+                m_DeviceShaders[DevIdx][Idx] = std::move(Data);
+            }
+            else
+            {
+                LOG_ERROR_MESSAGE("Failed to decompress ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shader ", Idx,
+                                  ". Archive file may be corrupted or invalid.");
+            }
+        });
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to decompress ", ArchiveDeviceTypeToString(static_cast<Uint32>(DevIdx)), " shader ", Idx, '.');
+    }
+}
+
+void DeviceObjectArchive::DecompressShaders(size_t DevIdx) const noexcept
+{
+    for (size_t i = 0; i < m_CompressedShaders[DevIdx].size(); ++i)
+        DecompressShader(DevIdx, i);
+}
+
+const SerializedData& DeviceObjectArchive::GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
+{
+    LoadDeviceData(Type);
+
+    const size_t DevIdx        = static_cast<size_t>(Type);
+    const auto&  DeviceShaders = m_DeviceShaders[DevIdx];
+    if (Idx >= DeviceShaders.size())
+    {
+        static const SerializedData NullData;
+        return NullData;
+    }
+
+    DecompressShader(DevIdx, Idx);
+    return DeviceShaders[Idx];
+}
 
 bool DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept
 {
@@ -175,44 +596,72 @@ bool DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept
         }                                   \
     } while (false)
 
-    CHECK_ARCHIVE(CI.pData != nullptr, "pData must not be null");
+    CHECK_ARCHIVE((CI.pData != nullptr) != (CI.pStream != nullptr), "Exactly one of pData and pStream must not be null");
 
-    m_pArchiveData = CI.MakeCopy ?
-        DataBlobImpl::MakeCopy(CI.pData) :
-        const_cast<IDataBlob*>(CI.pData); // Need to remove const for AddRef/Release
-
-    Serializer<SerializerMode::Read> Reader{
-        SerializedData{
-            const_cast<void*>(CI.pData->GetConstDataPtr()),
-            CI.pData->GetSize(),
-        },
-    };
-    ArchiveSerializer<SerializerMode::Read> ArchiveReader{Reader};
+    ArchiveHeader       Header;
+    DeviceSectionsArray Sections;
+    if (CI.pStream != nullptr)
+    {
+        m_pStream = CI.pStream;
 
-    // NB: this must match header serialization in DeviceObjectArchive::SerializeHeader
-    ArchiveHeader Header;
-    ASSERT_SIZEOF64(Header, 24, "Please handle new members here");
-    CHECK_ARCHIVE(ArchiveReader.Ser(Header.MagicNumber), "Failed to read device object archive header magic number.");
+        const size_t ArchiveSize = m_pStream->GetSize();
 
-    CHECK_ARCHIVE(Header.MagicNumber == HeaderMagicNumber, "Invalid device object archive header.");
+        // Read the section table first to find out where the resource data ends
+        std::array<Uint8, FixedHeaderSize> FixedHeader{};
+        CHECK_ARCHIVE(ArchiveSize >= FixedHeader.size() &&
+                          m_pStream->SetPos(0, SEEK_SET) &&
+                          m_pStream->Read(FixedHeader.data(), FixedHeader.size()),
+                      "Failed to read device object archive header.");
 
-    CHECK_ARCHIVE(ArchiveReader.Ser(Header.Version), "Failed to read device object archive version.");
+        Serializer<SerializerMode::Read> Reader{SerializedData{FixedHeader.data(), FixedHeader.size()}};
+        if (!ReadFixedHeader(Reader, Header, Sections, CI.ContentVersion, ArchiveSize))
+        {
+            Clear();
+            return false;
+        }
+        VERIFY_EXPR(Reader.IsEnded());
 
-    CHECK_ARCHIVE(Header.Version == ArchiveVersion, "Unsupported device object archive version: ", Header.Version, ". Expected version: ", Uint32{ArchiveVersion});
+        // Device sections follow the resource data
+        size_t CommonDataSize = ArchiveSize;
+        for (const DeviceSection& Section : Sections)
+        {
+            if (Section.Size != 0)
+                CommonDataSize = std::min(CommonDataSize, StaticCast<size_t>(Section.Offset));
+        }
 
-    CHECK_ARCHIVE(ArchiveReader.Ser(Header.APIVersion), "Failed to read Diligent API version.");
+        RefCntAutoPtr<DataBlobImpl> pCommonData = DataBlobImpl::Create(CommonDataSize);
+        CHECK_ARCHIVE(m_pStream->SetPos(0, SEEK_SET) && m_pStream->Read(pCommonData->GetDataPtr(), CommonDataSize),
+                      "Failed to read device object archive resource data.");
+        m_pArchiveData = std::move(pCommonData);
+    }
+    else
+    {
+        m_pArchiveData = CI.MakeCopy ?
+            DataBlobImpl::MakeCopy(CI.pData) :
+            const_cast<IDataBlob*>(CI.pData); // Need to remove const for AddRef/Release
+    }
 
-    CHECK_ARCHIVE(ArchiveReader.Ser(Header.ContentVersion), "Failed to read device object archive content version.");
+    Serializer<SerializerMode::Read> Reader{
+        SerializedData{
+            m_pArchiveData->GetDataPtr(),
+            m_pArchiveData->GetSize(),
+        },
+    };
 
-    CHECK_ARCHIVE(CI.ContentVersion == CreateInfo{}.ContentVersion || Header.ContentVersion == CI.ContentVersion,
-                  "Invalid archive content version: ", Header.ContentVersion, ". Expected version: ", CI.ContentVersion);
+    if (!ReadFixedHeader(Reader, Header, Sections, CI.ContentVersion, m_pStream ? m_pStream->GetSize() : m_pArchiveData->GetSize()))
+    {
+        Clear();
+        return false;
+    }
     m_ContentVersion = Header.ContentVersion;
+    m_DeviceSections = Sections;
 
-    CHECK_ARCHIVE(ArchiveReader.Ser(Header.GitHash), "Failed to read Git Hash.");
+    CHECK_ARCHIVE(Reader(Header.GitHash), "Failed to read Git Hash.");
 
     Uint32 NumResources = 0;
     CHECK_ARCHIVE(Reader(NumResources), "Failed to read the number of named resources in the device object archive.");
 
+    m_ResourceOrder.reserve(NumResources);
     for (Uint32 res = 0; res < NumResources; ++res)
     {
         const char*  Name    = nullptr;
@@ -224,15 +673,15 @@ bool DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept
         constexpr bool MakeNameCopy = false;
         ResourceData&  ResData      = m_NamedResources[NamedResourceKey{ResType, Name, MakeNameCopy}];
 
-        CHECK_ARCHIVE(ArchiveReader.SerializeResourceData(ResData), "Failed to read data of resource '", Name, "'.");
-    }
-
-    for (std::vector<SerializedData>& Shaders : m_DeviceShaders)
-    {
-        CHECK_ARCHIVE(ArchiveReader.SerializeShaders(Shaders), "Failed to read shader data from the device object archive.");
+        CHECK_ARCHIVE(Reader.Serialize(ResData.Common), "Failed to read data of resource '", Name, "'.");
+        m_ResourceOrder.push_back(&ResData);
     }
 #undef CHECK_ARCHIVE
 
+    // Device sections are loaded on demand
+    for (size_t i = 0; i < m_DeviceSections.size(); ++i)
+        m_DeviceDataLoaded[i].store(m_DeviceSections[i].Size == 0);
+
     return true;
 }
 
@@ -245,99 +694,129 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
     }
     DEV_CHECK_ERR(*ppDataBlob == nullptr, "Data blob object must be null");
 
-    auto SerializeThis = [this](auto& Ser) {
+    LoadAllDeviceData();
+
+    std::array<ShaderCompressionData, static_cast<size_t>(DeviceType::Count)> Compression;
+    for (size_t i = 0; i < m_DeviceShaders.size(); ++i)
+    {
+        DecompressShaders(i);
+        if (m_CompressShaders && !m_DeviceShaders[i].empty())
+            Compression[i] = CompressShaders(m_DeviceShaders[i]);
+    }
+
+    // The order of the resources must be the same in the resource data and in all device sections
+    std::vector<const decltype(m_NamedResources)::value_type*> Resources;
+    Resources.reserve(m_NamedResources.size());
+    for (const auto& res_it : m_NamedResources)
+        Resources.push_back(&res_it);
+
+    ArchiveHeader Header;
+    Header.ContentVersion = m_ContentVersion;
+
+    auto SerializeCommonData = [&](auto& Ser, const DeviceSectionsArray& Sections) {
         constexpr auto SerMode    = std::remove_reference<decltype(Ser)>::type::GetMode();
         const auto     ArchiveSer = ArchiveSerializer<SerMode>{Ser};
 
-        ArchiveHeader Header;
-        Header.ContentVersion = m_ContentVersion;
-
-        auto res = ArchiveSer.SerializeHeader(Header);
+        auto res = ArchiveSer.SerializeHeader(Header, Sections);
         VERIFY(res, "Failed to serialize header");
 
-        Uint32 NumResources = StaticCast<Uint32>(m_NamedResources.size());
+        Uint32 NumResources = StaticCast<Uint32>(Resources.size());
         res                 = Ser(NumResources);
         VERIFY(res, "Failed to serialize the number of resources");
 
-        for (const auto& res_it : m_NamedResources)
+        for (const auto* pRes : Resources)
         {
-            const auto* Name    = res_it.first.GetName();
-            const auto  ResType = res_it.first.GetType();
+            const auto* Name    = pRes->first.GetName();
+            const auto  ResType = pRes->first.GetType();
 
             res = Ser(ResType, Name);
             VERIFY(res, "Failed to serialize resource type and name");
 
-            res = ArchiveSer.SerializeResourceData(res_it.second);
+            res = Ser.Serialize(pRes->second.Common);
             VERIFY(res, "Failed to serialize resource data");
         }
+    };
+
+    auto SerializeDeviceSection = [&](auto& Ser, size_t DevIdx) {
+        constexpr auto SerMode    = std::remove_reference<decltype(Ser)>::type::GetMode();
+        const auto     ArchiveSer = ArchiveSerializer<SerMode>{Ser};
 
-        for (auto& Shaders : m_DeviceShaders)
+        for (const auto* pRes : Resources)
         {
-            res = ArchiveSer.SerializeShaders(Shaders);
-            VERIFY(res, "Failed to serialize shaders");
+            auto res = Ser.Serialize(pRes->second.DeviceSpecific[DevIdx]);
+            VERIFY(res, "Failed to serialize device-specific resource data");
         }
+
+        auto res = ArchiveSer.SerializeShaders(m_DeviceShaders[DevIdx], !Compression[DevIdx].Data.empty() ? &Compression[DevIdx] : nullptr);
+        VERIFY(res, "Failed to serialize shaders");
     };
 
-    Serializer<SerializerMode::Measure> Measurer;
-    SerializeThis(Measurer);
+    // Sections are aligned so that the data in them is aligned in the archive as well
+    constexpr size_t SectionAlignment = 16;
 
-    auto pDataBlob = DataBlobImpl::Create(Measurer.GetSize());
+    DeviceSectionsArray Sections;
+    {
+        Serializer<SerializerMode::Measure> Measurer;
+        SerializeCommonData(Measurer, Sections);
+        size_t Offset = AlignUp(Measurer.GetSize(), SectionAlignment);
 
-    Serializer<SerializerMode::Write> Writer{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
-    SerializeThis(Writer);
-    VERIFY_EXPR(Writer.IsEnded());
+        for (size_t i = 0; i < Sections.size(); ++i)
+        {
+            bool HasData = !m_DeviceShaders[i].empty();
+            for (const auto* pRes : Resources)
+                HasData = HasData || pRes->second.DeviceSpecific[i];
+            if (!HasData)
+                continue;
 
-    *ppDataBlob = pDataBlob.Detach();
-}
+            Serializer<SerializerMode::Measure> SectionMeasurer;
+            SerializeDeviceSection(SectionMeasurer, i);
 
+            Sections[i].Offset = Offset;
+            Sections[i].Size   = SectionMeasurer.GetSize();
+            Offset             = AlignUp(Offset + SectionMeasurer.GetSize(), SectionAlignment);
+        }
+    }
 
-namespace
-{
+    size_t ArchiveSize = 0;
+    {
+        Serializer<SerializerMode::Measure> Measurer;
+        SerializeCommonData(Measurer, Sections);
+        ArchiveSize = Measurer.GetSize();
+        for (const DeviceSection& Section : Sections)
+        {
+            if (Section.Size != 0)
+                ArchiveSize = StaticCast<size_t>(Section.Offset + Section.Size);
+        }
+    }
+
+    auto pDataBlob = DataBlobImpl::Create(ArchiveSize);
+    // Zero the padding between the sections
+    memset(pDataBlob->GetDataPtr(), 0, ArchiveSize);
+    Uint8* const pArchiveData = pDataBlob->GetDataPtr<Uint8>();
 
-const char* ArchiveDeviceTypeToString(Uint32 dev)
-{
-    using DeviceType = DeviceObjectArchive::DeviceType;
-    static_assert(static_cast<Uint32>(DeviceType::Count) == 7, "Please handle the new archive device type below");
-    switch (static_cast<DeviceType>(dev))
     {
-            // clang-format off
-        case DeviceType::OpenGL:      return "OpenGL";
-        case DeviceType::Direct3D11:  return "Direct3D11";
-        case DeviceType::Direct3D12:  return "Direct3D12";
-        case DeviceType::Vulkan:      return "Vulkan";
-        case DeviceType::Metal_MacOS: return "Metal for MacOS";
-        case DeviceType::Metal_iOS:   return "Metal for iOS";
-        case DeviceType::WebGPU:      return "WebGPU";
-        // clang-format on
-        default:
-            UNEXPECTED("Unexpected device type");
-            return "unknown";
+        Serializer<SerializerMode::Measure> Measurer;
+        SerializeCommonData(Measurer, Sections);
+
+        Serializer<SerializerMode::Write> Writer{SerializedData{pArchiveData, Measurer.GetSize()}};
+        SerializeCommonData(Writer, Sections);
+        VERIFY_EXPR(Writer.IsEnded());
     }
-}
 
-const char* ResourceTypeToString(DeviceObjectArchive::ResourceType Type)
-{
-    using ResourceType = DeviceObjectArchive::ResourceType;
-    static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Please handle the new chunk type below");
-    switch (Type)
+    for (size_t i = 0; i < Sections.size(); ++i)
     {
-            // clang-format off
-        case ResourceType::Undefined:          return "Undefined";
-        case ResourceType::StandaloneShader:   return "Standalone Shaders";
-        case ResourceType::ResourceSignature:  return "Resource Signatures";
-        case ResourceType::GraphicsPipeline:   return "Graphics Pipelines";
-        case ResourceType::ComputePipeline:    return "Compute Pipelines";
-        case ResourceType::RayTracingPipeline: return "Ray-Tracing Pipelines";
-        case ResourceType::TilePipeline:       return "Tile Pipelines";
-        case ResourceType::RenderPass:         return "Render Passes";
-        // clang-format on
-        default:
-            UNEXPECTED("Unexpected chunk type");
-            return "";
+        if (Sections[i].Size == 0)
+            continue;
+
+        Serializer<SerializerMode::Write> Writer{SerializedData{pArchiveData + Sections[i].Offset, StaticCast<size_t>(Sections[i].Size)}};
+        SerializeDeviceSection(Writer, i);
+        VERIFY_EXPR(Writer.IsEnded());
     }
+
+    *ppDataBlob = pDataBlob.Detach();
 }
 
-} // namespace
+
 
 
 DeviceObjectArchive::DeviceObjectArchive(const CreateInfo& CI) noexcept(false)
@@ -360,11 +839,14 @@ const SerializedData& DeviceObjectArchive::GetDeviceSpecificData(ResourceType Ty
         return NullData;
     }
     VERIFY_EXPR(SafeStrEqual(Name, it->first.GetName()));
+    LoadDeviceData(DevType);
     return it->second.DeviceSpecific[static_cast<size_t>(DevType)];
 }
 
 std::string DeviceObjectArchive::ToString() const
 {
+    LoadAllDeviceData();
+
     std::stringstream Output;
     Output << "Archive contents:\n";
 
@@ -482,6 +964,7 @@ std::string DeviceObjectArchive::ToString() const
 
             for (Uint32 dev = 0; dev < m_DeviceShaders.size(); ++dev)
             {
+                DecompressShaders(dev);
                 const auto& Shaders = m_DeviceShaders[dev];
                 if (Shaders.empty())
                     continue;
@@ -529,10 +1012,16 @@ void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
         res_it.second.DeviceSpecific[static_cast<size_t>(Dev)] = {};
 
     m_DeviceShaders[static_cast<size_t>(Dev)].clear();
+    m_CompressedShaders[static_cast<size_t>(Dev)].clear();
+
+    // The section must not be loaded on top of the removed data
+    SetDeviceDataLoaded(Dev);
 }
 
 void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false)
 {
+    Src.LoadDeviceData(Dev);
+
     auto& Allocator = GetRawAllocator();
     for (auto& dst_res_it : m_NamedResources)
     {
@@ -550,20 +1039,30 @@ void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, Devic
     }
 
     // Copy all shaders to make sure PSO shader indices are correct
+    Src.DecompressShaders(static_cast<size_t>(Dev));
+    m_CompressedShaders[static_cast<size_t>(Dev)].clear();
     const auto& SrcShaders = Src.m_DeviceShaders[static_cast<size_t>(Dev)];
     auto&       DstShaders = m_DeviceShaders[static_cast<size_t>(Dev)];
     DstShaders.clear();
     for (const auto& SrcShader : SrcShaders)
         DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
+
+    // All device data has been replaced
+    SetDeviceDataLoaded(Dev);
 }
 
-void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
+void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src, bool OverrideExisting) noexcept(false)
 {
     if (m_ContentVersion != Src.m_ContentVersion)
         LOG_WARNING_MESSAGE("Merging archives with different content versions (", m_ContentVersion, " and ", Src.m_ContentVersion, ").");
 
     static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Did you add a new resource type? You may need to handle it here.");
 
+    // Shader indices of the merged resources depend on the number of shaders in every section
+    LoadAllDeviceData();
+    Src.LoadAllDeviceData();
+    m_CompressShaders = m_CompressShaders || Src.m_CompressShaders;
+
     auto&                  Allocator = GetRawAllocator();
     DynamicLinearAllocator DynAllocator{Allocator, 512};
 
@@ -571,6 +1070,10 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
     std::array<Uint32, static_cast<size_t>(DeviceType::Count)> ShaderBaseIndices{};
     for (size_t i = 0; i < m_DeviceShaders.size(); ++i)
     {
+        DecompressShaders(i);
+        m_CompressedShaders[i].clear();
+        Src.DecompressShaders(i);
+
         const auto& SrcShaders = Src.m_DeviceShaders[i];
         auto&       DstShaders = m_DeviceShaders[i];
         ShaderBaseIndices[i]   = static_cast<Uint32>(DstShaders.size());
@@ -591,75 +1094,122 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
         if (!it_inserted.second)
         {
             // Silently skip duplicate resources
-            if (it_inserted.first->second != src_res_it.second)
+            if (it_inserted.first->second == src_res_it.second)
+                continue;
+
+            if (!OverrideExisting)
+            {
                 LOG_WARNING_MESSAGE("Failed to copy resource '", ResName, "': resource with the same name already exists.");
+                continue;
+            }
 
-            continue;
+            // The shaders of the replaced resource are left in the archive
+            it_inserted.first->second = src_res_it.second.MakeCopy(Allocator);
         }
 
-        const auto IsStandaloneShader = (ResType == ResourceType::StandaloneShader);
-        const auto IsPipeline =
-            (ResType == ResourceType::GraphicsPipeline ||
-             ResType == ResourceType::ComputePipeline ||
-             ResType == ResourceType::RayTracingPipeline ||
-             ResType == ResourceType::TilePipeline);
-
         // Update shader indices
-        if (IsStandaloneShader || IsPipeline)
+        for (size_t i = 0; i < static_cast<size_t>(DeviceType::Count); ++i)
         {
-            for (size_t i = 0; i < static_cast<size_t>(DeviceType::Count); ++i)
-            {
-                const auto BaseIdx = ShaderBaseIndices[i];
+            const auto BaseIdx = ShaderBaseIndices[i];
+            RemapShaderIndices(ResType, it_inserted.first->second.DeviceSpecific[i], DynAllocator,
+                               [BaseIdx](Uint32 Idx) { return Idx + BaseIdx; });
+        }
+    }
+}
 
-                auto& DeviceData = it_inserted.first->second.DeviceSpecific[i];
-                if (!DeviceData)
-                    continue;
+void DeviceObjectArchive::CreateDelta(const DeviceObjectArchive& Base, const DeviceObjectArchive& New) noexcept(false)
+{
+    VERIFY(m_NamedResources.empty(), "The archive must be empty");
 
-                if (IsStandaloneShader)
-                {
-                    // For shaders, device-specific data is the serialized shader bytecode index
-                    Uint32 ShaderIndex = 0;
-                    {
-                        Serializer<SerializerMode::Read> Ser{DeviceData};
-                        if (!Ser(ShaderIndex))
-                            LOG_ERROR_AND_THROW("Failed to deserialize standalone shader index. Archive file may be corrupted or invalid.");
-                        VERIFY(Ser.IsEnded(), "No other data besides the shader index is expected");
-                    }
+    Base.LoadAllDeviceData();
+    New.LoadAllDeviceData();
+    for (size_t i = 0; i < m_DeviceShaders.size(); ++i)
+    {
+        Base.DecompressShaders(i);
+        New.DecompressShaders(i);
+    }
+    m_ContentVersion  = New.m_ContentVersion;
+    m_CompressShaders = New.m_CompressShaders;
 
-                    ShaderIndex += BaseIdx;
+    auto&                  Allocator = GetRawAllocator();
+    DynamicLinearAllocator DynAllocator{Allocator, 512};
 
-                    {
-                        Serializer<SerializerMode::Write> Ser{DeviceData};
-                        Ser(ShaderIndex);
-                        VERIFY_EXPR(Ser.IsEnded());
-                    }
-                }
-                else if (IsPipeline)
-                {
-                    // For pipelines, device-specific data is the shader index array
-                    ShaderIndexArray ShaderIndices;
-                    {
-                        Serializer<SerializerMode::Read> Ser{DeviceData};
-                        if (!PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(Ser, ShaderIndices, &DynAllocator))
-                            LOG_ERROR_AND_THROW("Failed to deserialize PSO shader indices. Archive file may be corrupted or invalid.");
-                        VERIFY(Ser.IsEnded(), "No other data besides shader indices is expected");
-                    }
+    // Returns the shader indices of the resource, which are only valid within its archive
+    auto GetShaderIndices = [&DynAllocator](ResourceType ResType, const SerializedData& DeviceData) {
+        std::vector<Uint32> Indices;
+        if (!ReadShaderIndices(ResType, DeviceData, DynAllocator, Indices))
+            LOG_ERROR_AND_THROW("Failed to deserialize shader indices. Archive file may be corrupted or invalid.");
+        return Indices;
+    };
 
-                    std::vector<Uint32> NewIndices{ShaderIndices.pIndices, ShaderIndices.pIndices + ShaderIndices.Count};
-                    for (auto& Idx : NewIndices)
-                        Idx += BaseIdx;
+    // Compares the resources by content, resolving the shader indices to the shader data
+    auto IsSameResource = [&](ResourceType ResType, const ResourceData& BaseRes, const ResourceData& NewRes) {
+        if (BaseRes.Common != NewRes.Common)
+            return false;
 
-                    {
-                        Serializer<SerializerMode::Write> Ser{DeviceData};
-                        PSOSerializer<SerializerMode::Write>::SerializeShaderIndices(Ser, ShaderIndexArray{NewIndices.data(), ShaderIndices.Count}, nullptr);
-                        VERIFY_EXPR(Ser.IsEnded());
-                    }
-                }
-                else
-                {
-                    UNEXPECTED("Unexpected resource type");
-                }
+        for (size_t i = 0; i < static_cast<size_t>(DeviceType::Count); ++i)
+        {
+            if (!HasShaderIndices(ResType) || !BaseRes.DeviceSpecific[i] || !NewRes.DeviceSpecific[i])
+            {
+                if (BaseRes.DeviceSpecific[i] != NewRes.DeviceSpecific[i])
+                    return false;
+                continue;
             }
+
+            const std::vector<Uint32> BaseIndices = GetShaderIndices(ResType, BaseRes.DeviceSpecific[i]);
+            const std::vector<Uint32> NewIndices  = GetShaderIndices(ResType, NewRes.DeviceSpecific[i]);
+            if (BaseIndices.size() != NewIndices.size())
+                return false;
+
+            for (size_t j = 0; j < BaseIndices.size(); ++j)
+            {
+                if (Base.GetSerializedShader(static_cast<DeviceType>(i), BaseIndices[j]) != New.GetSerializedShader(static_cast<DeviceType>(i), NewIndices[j]))
+                    return false;
+            }
+        }
+
+        return true;
+    };
+
+    // Shader hash -> index in this archive, for every device type
+    std::array<std::unordered_multimap<size_t, Uint32>, static_cast<size_t>(DeviceType::Count)> ShaderHashToIdx;
+
+    auto AddShader = [&](size_t DevIdx, Uint32 SrcIdx) {
+        const SerializedData& Shader = New.GetSerializedShader(static_cast<DeviceType>(DevIdx), SrcIdx);
+        if (!Shader)
+            LOG_ERROR_AND_THROW("Invalid shader index ", SrcIdx, ". Archive file may be corrupted or invalid.");
+
+        auto& Shaders  = m_DeviceShaders[DevIdx];
+        auto& HashMap  = ShaderHashToIdx[DevIdx];
+        auto  range_it = HashMap.equal_range(Shader.GetHash());
+        for (auto it = range_it.first; it != range_it.second; ++it)
+        {
+            if (Shaders[it->second] == Shader)
+                return it->second;
+        }
+
+        const Uint32 Idx = static_cast<Uint32>(Shaders.size());
+        Shaders.emplace_back(Shader.MakeCopy(Allocator));
+        HashMap.emplace(Shader.GetHash(), Idx);
+        return Idx;
+    };
+
+    for (const auto& new_res_it : New.m_NamedResources)
+    {
+        const ResourceType ResType = new_res_it.first.GetType();
+        const char*        ResName = new_res_it.first.GetName();
+
+        auto base_it = Base.m_NamedResources.find(new_res_it.first);
+        if (base_it != Base.m_NamedResources.end() && IsSameResource(ResType, base_it->second, new_res_it.second))
+            continue;
+
+        auto& DstData = m_NamedResources.emplace(NamedResourceKey{ResType, ResName, /*CopyName = */ true}, new_res_it.second.MakeCopy(Allocator)).first->second;
+
+        // Only copy the shaders that are used by the changed resources
+        for (size_t i = 0; i < static_cast<size_t>(DeviceType::Count); ++i)
+        {
+            RemapShaderIndices(ResType, DstData.DeviceSpecific[i], DynAllocator,
+                               [&AddShader, i](Uint32 Idx) { return AddShader(i, Idx); });
         }
     }
 }
@@ -26,7 +26,11 @@
  */
 
 #include "FramebufferBase.hpp"
+
+#include <algorithm>
+
 #include "GraphicsAccessories.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -71,6 +75,15 @@ void ValidateFramebufferDesc(const FramebufferDesc& Desc, IRenderDevice* pDevice
 
     const bool IsMetal = pDevice->GetDeviceInfo().IsMetalDevice();
 
+    // View N of a multiview subpass renders to array slice N of every attachment
+    Uint32 NumViews = 0;
+    for (Uint32 subpass = 0; subpass < RPDesc.SubpassCount; ++subpass)
+    {
+        const Uint32 ViewMask = RPDesc.pSubpasses[subpass].ViewMask;
+        if (ViewMask != 0)
+            NumViews = std::max(NumViews, PlatformMisc::GetMSB(ViewMask) + 1);
+    }
+
     for (Uint32 i = 0; i < RPDesc.AttachmentCount; ++i)
     {
         if (Desc.ppAttachments[i] == nullptr)
@@ -110,6 +123,12 @@ void ValidateFramebufferDesc(const FramebufferDesc& Desc, IRenderDevice* pDevice
                                             ") defined by the render pass for the same attachment.");
         }
 
+        if (NumViews > 0 && ViewDesc.ViewType != TEXTURE_VIEW_SHADING_RATE && ViewDesc.NumArraySlices < NumViews)
+        {
+            LOG_FRAMEBUFFER_ERROR_AND_THROW("the render pass uses ", NumViews, " views, but attachment ", i, " only has ", ViewDesc.NumArraySlices,
+                                            " array slice(s). Every attachment of a multiview render pass must have at least as many slices as there are views.");
+        }
+
         if ((TexDesc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) != 0)
         {
             const bool HasStencilComponent = GetTextureFormatAttribs(AttDesc.Format).ComponentType == COMPONENT_TYPE_DEPTH_STENCIL;
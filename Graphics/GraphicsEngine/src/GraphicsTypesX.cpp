@@ -43,4 +43,17 @@ std::unique_ptr<Uint8[]> CopyPSOCreateInternalInfo(void* pData)
     return pCopy;
 }
 
+void ReservePSOCreateInternalInfo(const void* pData, FixedLinearAllocator& MemPool) noexcept
+{
+    if (pData != nullptr)
+        MemPool.AddSpace<PSOCreateInternalInfo>();
+}
+
+void* CopyPSOCreateInternalInfo(const void* pData, FixedLinearAllocator& MemPool)
+{
+    return pData != nullptr ?
+        MemPool.Copy(*static_cast<const PSOCreateInternalInfo*>(pData)) :
+        nullptr;
+}
+
 } // namespace Diligent
@@ -391,23 +391,21 @@ bool RPSerializer<Mode>::SerializeDesc(
                                    return false;
 
 
-                               if (!Ser.SerializeArray(Allocator, Subpass.pPreserveAttachments, Subpass.PreserveAttachmentCount,
-                                                       [](Serializer<Mode>&  Ser,
-                                                          ConstQual<Uint32>& Attach) //
+                               if (!Ser.SerializeArrayRaw(Allocator, Subpass.pPreserveAttachments, Subpass.PreserveAttachmentCount))
+                                   return false;
+
+                               Uint32 ShadingRateAttachCount = Subpass.pShadingRateAttachment != nullptr ? 1 : 0;
+                               if (!Ser.SerializeArray(Allocator, Subpass.pShadingRateAttachment, ShadingRateAttachCount,
+                                                       [](Serializer<Mode>&                 Ser,
+                                                          ConstQual<ShadingRateAttachment>& SRAttachment) //
                                                        {
-                                                           return Ser(Attach);
+                                                           return Ser(SRAttachment.Attachment.AttachmentIndex,
+                                                                      SRAttachment.Attachment.State,
+                                                                      SRAttachment.TileSize);
                                                        }))
                                    return false;
 
-                               Uint32 ShadingRateAttachCount = Subpass.pShadingRateAttachment != nullptr ? 1 : 0;
-                               return Ser.SerializeArray(Allocator, Subpass.pShadingRateAttachment, ShadingRateAttachCount,
-                                                         [](Serializer<Mode>&                 Ser,
-                                                            ConstQual<ShadingRateAttachment>& SRAttachment) //
-                                                         {
-                                                             return Ser(SRAttachment.Attachment.AttachmentIndex,
-                                                                        SRAttachment.Attachment.State,
-                                                                        SRAttachment.TileSize);
-                                                         });
+                               return Ser(Subpass.ViewMask);
                            });
     if (!res) return false;
 
@@ -426,7 +424,7 @@ bool RPSerializer<Mode>::SerializeDesc(
     return res;
 
     ASSERT_SIZEOF64(RenderPassDesc, 56, "Did you add a new member to RenderPassDesc? Please add serialization here.");
-    ASSERT_SIZEOF64(SubpassDesc, 72, "Did you add a new member to SubpassDesc? Please add serialization here.");
+    ASSERT_SIZEOF64(SubpassDesc, 80, "Did you add a new member to SubpassDesc? Please add serialization here.");
     ASSERT_SIZEOF(RenderPassAttachmentDesc, 16, "Did you add a new member to RenderPassAttachmentDesc? Please add serialization here.");
     ASSERT_SIZEOF(SubpassDependencyDesc, 24, "Did you add a new member to SubpassDependencyDesc? Please add serialization here.");
     ASSERT_SIZEOF(ShadingRateAttachment, 16, "Did you add a new member to ShadingRateAttachment? Please add serialization here.");
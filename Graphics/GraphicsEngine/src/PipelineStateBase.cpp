@@ -569,6 +569,9 @@ void ValidateGraphicsPipelineCreateInfo(const GraphicsPipelineStateCreateInfo& C
     ValidateGraphicsPipelineDesc(PSODesc, GraphicsPipeline, AdapterInfo.ShadingRate);
     ValidatePipelineResourceLayoutDesc(PSODesc, Features);
 
+    if ((CreateInfo.Flags & PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE) != 0 && !Features.ExtendedDynamicState)
+        LOG_PSO_ERROR_AND_THROW("PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE flag requires ExtendedDynamicState device feature.");
+
 
     if (PSODesc.PipelineType == PIPELINE_TYPE_GRAPHICS)
     {
@@ -119,10 +119,13 @@ DeviceFeatures EnableDeviceFeatures(const DeviceFeatures& SupportedFeatures,
     ENABLE_FEATURE(NativeMultiDraw,                   "Native multi-draw commands are");
     ENABLE_FEATURE(AsyncShaderCompilation,            "Async shader compilation is");
     ENABLE_FEATURE(FormattedBuffers,                  "Formatted buffers are");
+    ENABLE_FEATURE(ConditionalRendering,              "Conditional rendering is");
+    ENABLE_FEATURE(MultiView,                         "Multiview rendering is");
+    ENABLE_FEATURE(ExtendedDynamicState,              "Extended dynamic state is");
     // clang-format on
 #undef ENABLE_FEATURE
 
-    ASSERT_SIZEOF(DeviceFeatures, 47, "Did you add a new feature to DeviceFeatures? Please handle its status here (if necessary).");
+    ASSERT_SIZEOF(DeviceFeatures, 50, "Did you add a new feature to DeviceFeatures? Please handle its status here (if necessary).");
 
     return EnabledFeatures;
 }
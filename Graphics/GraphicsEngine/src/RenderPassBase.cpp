@@ -404,6 +404,17 @@ void ValidateRenderPassDesc(const RenderPassDesc&      Desc,
                 }
             }
         }
+
+        if (Subpass.ViewMask != 0 && !Features.MultiView)
+            LOG_RENDER_PASS_ERROR_AND_THROW("subpass ", subpass, " uses a non-zero view mask, but MultiView device feature is not enabled");
+
+        if ((Subpass.ViewMask != 0) != (Desc.pSubpasses[0].ViewMask != 0))
+        {
+            VERIFY_EXPR(subpass > 0);
+            LOG_RENDER_PASS_ERROR_AND_THROW("the view mask of subpass ", subpass, " is ", (Subpass.ViewMask != 0 ? "not zero" : "zero"),
+                                            ", while the view mask of subpass 0 is ", (Subpass.ViewMask != 0 ? "zero" : "not zero"),
+                                            ". The view mask must either be zero for all subpasses or non-zero for all subpasses.");
+        }
     }
 
     if (pShadingRateAttachment != nullptr && (SRProps.CapFlags & SHADING_RATE_CAP_FLAG_SAME_TEXTURE_FOR_WHOLE_RENDERPASS) != SHADING_RATE_CAP_FLAG_NONE)
@@ -26,13 +26,121 @@
  */
 
 #include "ResourceMappingImpl.hpp"
+
+#include <cstring>
+#include <new>
+
 #include "DeviceObjectBase.hpp"
+#include "EngineMemory.h"
+#include "Align.hpp"
 
 namespace Diligent
 {
 
+struct ResourceMappingImpl::Snapshot
+{
+    struct Entry
+    {
+        size_t         Hash       = 0;
+        const Char*    Name       = nullptr; // Null for empty slots
+        Uint32         ArrayIndex = 0;
+        IDeviceObject* pObject    = nullptr;
+    };
+
+    // Power of two that is at least twice the number of resources,
+    // so that every probe sequence ends at an empty slot.
+    size_t NumSlots = 0;
+    Entry* Slots    = nullptr;
+
+    IDeviceObject* Find(const Char* Name, Uint32 ArrayIndex) const
+    {
+        const size_t Hash = ResMappingHashKey{Name, false, ArrayIndex}.GetHash();
+        for (size_t Slot = Hash & (NumSlots - 1);; Slot = (Slot + 1) & (NumSlots - 1))
+        {
+            const Entry& E = Slots[Slot];
+            if (E.Name == nullptr)
+                return nullptr;
+
+            if (E.Hash == Hash && E.ArrayIndex == ArrayIndex && strcmp(E.Name, Name) == 0)
+                return E.pObject;
+        }
+    }
+};
+
 ResourceMappingImpl::~ResourceMappingImpl()
 {
+    VERIFY(m_NumActiveReaders.load() == 0, "Resource mapping is being destroyed while GetResource() is in progress");
+    InvalidateSnapshot();
+    ReleaseRetiredSnapshots();
+}
+
+const ResourceMappingImpl::Snapshot* ResourceMappingImpl::CreateSnapshot()
+{
+    size_t NumSlots = 2;
+    while (NumSlots < m_HashTable.size() * 2)
+        NumSlots *= 2;
+
+    size_t StringsSize = 0;
+    for (const auto& it : m_HashTable)
+        StringsSize += strlen(it.first.GetStr()) + 1;
+
+    // Snapshot header, slots and names are allocated as a single memory block
+    const size_t SlotsOffset   = AlignUp(sizeof(Snapshot), alignof(Snapshot::Entry));
+    const size_t StringsOffset = SlotsOffset + sizeof(Snapshot::Entry) * NumSlots;
+
+    Uint8* pMemory = static_cast<Uint8*>(ALLOCATE_RAW(m_RawMemAllocator, "Memory for resource mapping snapshot", StringsOffset + StringsSize));
+
+    Snapshot* pSnapshot = new (pMemory) Snapshot{};
+    pSnapshot->NumSlots = NumSlots;
+    pSnapshot->Slots    = reinterpret_cast<Snapshot::Entry*>(pMemory + SlotsOffset);
+    for (size_t i = 0; i < NumSlots; ++i)
+        new (pSnapshot->Slots + i) Snapshot::Entry{};
+
+    Char* pStrings = reinterpret_cast<Char*>(pMemory + StringsOffset);
+    for (const auto& it : m_HashTable)
+    {
+        const ResMappingHashKey& Key = it.first;
+
+        size_t Slot = Key.GetHash() & (NumSlots - 1);
+        while (pSnapshot->Slots[Slot].Name != nullptr)
+            Slot = (Slot + 1) & (NumSlots - 1);
+
+        // Names are copied because the keys may be removed from the hash table
+        // while the snapshot is still in use.
+        const size_t LenWithZeroTerm = strlen(Key.GetStr()) + 1;
+        memcpy(pStrings, Key.GetStr(), LenWithZeroTerm);
+
+        Snapshot::Entry& E = pSnapshot->Slots[Slot];
+        E.Hash             = Key.GetHash();
+        E.Name             = pStrings;
+        E.ArrayIndex       = Key.ArrayIndex;
+        E.pObject          = it.second.RawPtr();
+
+        pStrings += LenWithZeroTerm;
+    }
+
+    return pSnapshot;
+}
+
+void ResourceMappingImpl::InvalidateSnapshot()
+{
+    if (const Snapshot* pSnapshot = m_pSnapshot.exchange(nullptr))
+        m_RetiredSnapshots.push_back(pSnapshot);
+
+    // A reader that increments the counter after this point is guaranteed
+    // to see the null snapshot pointer and will not access retired snapshots.
+    if (!m_RetiredSnapshots.empty() && m_NumActiveReaders.load() == 0)
+        ReleaseRetiredSnapshots();
+}
+
+void ResourceMappingImpl::ReleaseRetiredSnapshots()
+{
+    for (const Snapshot* pSnapshot : m_RetiredSnapshots)
+    {
+        // Snapshot and Entry are trivially destructible
+        FREE(m_RawMemAllocator, const_cast<Snapshot*>(pSnapshot));
+    }
+    m_RetiredSnapshots.clear();
 }
 
 void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex, IDeviceObject* const* ppObjects, Uint32 NumElements, bool bIsUnique)
@@ -41,14 +149,20 @@ void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex,
         return;
 
     Threading::SpinLockGuard Guard{m_Lock};
+
+    bool Modified = false;
     for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
     {
         auto* pObject = ppObjects[Elem];
 
         // Try to construct new element in place
         auto Elems = m_HashTable.emplace(ResMappingHashKey{Name, true /*Make copy*/, StartIndex + Elem}, pObject);
+        if (Elems.second)
+        {
+            Modified = true;
+        }
         // If there is already element with the same name, replace it
-        if (!Elems.second && Elems.first->second != pObject)
+        else if (Elems.first->second != pObject)
         {
             if (bIsUnique)
             {
@@ -59,8 +173,12 @@ void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex,
                     "New resource will be used\n.");
             }
             Elems.first->second = pObject;
+            Modified            = true;
         }
     }
+
+    if (Modified)
+        InvalidateSnapshot();
 }
 
 void ResourceMappingImpl::AddResource(const Char* Name, IDeviceObject* pObject, bool bIsUnique)
@@ -76,7 +194,8 @@ void ResourceMappingImpl::RemoveResourceByName(const Char* Name, Uint32 ArrayInd
     Threading::SpinLockGuard Guard{m_Lock};
     // Remove object with the given name
     // Name will be implicitly converted to HashMapStringKey without making a copy
-    m_HashTable.erase(ResMappingHashKey{Name, false, ArrayIndex});
+    if (m_HashTable.erase(ResMappingHashKey{Name, false, ArrayIndex}) != 0)
+        InvalidateSnapshot();
 }
 
 IDeviceObject* ResourceMappingImpl::GetResource(const Char* Name, Uint32 ArrayIndex)
@@ -87,15 +206,34 @@ IDeviceObject* ResourceMappingImpl::GetResource(const Char* Name, Uint32 ArrayIn
         return nullptr;
     }
 
-    Threading::SpinLockGuard Guard{m_Lock};
+    // The counter must be incremented before the snapshot pointer is loaded,
+    // see InvalidateSnapshot().
+    m_NumActiveReaders.fetch_add(1);
+
+    const Snapshot* pSnapshot = m_pSnapshot.load();
+    if (pSnapshot == nullptr)
+    {
+        Threading::SpinLockGuard Guard{m_Lock};
+
+        pSnapshot = m_pSnapshot.load();
+        if (pSnapshot == nullptr)
+        {
+            pSnapshot = CreateSnapshot();
+            m_pSnapshot.store(pSnapshot);
+        }
+    }
 
     // Find an object with the requested name
-    auto It = m_HashTable.find(ResMappingHashKey{Name, false, ArrayIndex});
-    return It != m_HashTable.end() ? It->second.RawPtr() : nullptr;
+    IDeviceObject* pObject = pSnapshot->Find(Name, ArrayIndex);
+
+    m_NumActiveReaders.fetch_sub(1);
+
+    return pObject;
 }
 
 size_t ResourceMappingImpl::GetSize()
 {
+    Threading::SpinLockGuard Guard{m_Lock};
     return m_HashTable.size();
 }
 
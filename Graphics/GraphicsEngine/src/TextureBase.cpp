@@ -167,6 +167,18 @@ void ValidateTextureDesc(const TextureDesc& Desc, const IRenderDevice* pDevice)
             LOG_TEXTURE_ERROR_AND_THROW("Memoryless attachment is not compatible with mipmap generation.");
     }
 
+    if (Desc.MiscFlags & MISC_TEXTURE_FLAG_EXPORTABLE)
+    {
+        if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && !DeviceInfo.IsVulkanDevice())
+            LOG_TEXTURE_ERROR_AND_THROW("MISC_TEXTURE_FLAG_EXPORTABLE is only supported in Direct3D12 and Vulkan.");
+
+        if (Desc.Usage != USAGE_DEFAULT)
+            LOG_TEXTURE_ERROR_AND_THROW("Exportable textures require USAGE_DEFAULT.");
+
+        if (Desc.MiscFlags & (MISC_TEXTURE_FLAG_MEMORYLESS | MISC_TEXTURE_FLAG_SUBSAMPLED))
+            LOG_TEXTURE_ERROR_AND_THROW("MISC_TEXTURE_FLAG_EXPORTABLE is not compatible with MISC_TEXTURE_FLAG_MEMORYLESS and MISC_TEXTURE_FLAG_SUBSAMPLED.");
+    }
+
     if (Desc.Usage == USAGE_STAGING)
     {
         if (Desc.BindFlags != 0)
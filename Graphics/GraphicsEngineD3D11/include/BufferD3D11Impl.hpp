@@ -30,10 +30,12 @@
 /// \file
 /// Declaration of Diligent::BufferD3D11Impl class
 
+#include <vector>
 #include <atlbase.h>
 
 #include "EngineD3D11ImplTraits.hpp"
 #include "BufferBase.hpp"
+#include "IndexWrapper.hpp"
 #include "ResourceD3D11Base.hpp"
 
 namespace Diligent
@@ -87,6 +89,31 @@ public:
             m_State = RESOURCE_STATE_UNDEFINED;
     }
 
+    // Returns true if the buffer data may be suballocated from the dynamic constant buffer ring
+    bool UsesDynamicRing() const { return !m_DynamicAllocations.empty(); }
+
+    // Returns the d3d11 buffer that contains the data written by the last map
+    // in the given device context, and the offset of the data in this buffer.
+    // RingGeneration is the current generation of the context's dynamic ring (see D3D11DynamicRing::GetGeneration()).
+    ID3D11Buffer* GetD3D11Buffer(DeviceContextIndex CtxId, Uint64 RingGeneration, Uint32& Offset) const
+    {
+        if (UsesDynamicRing())
+        {
+            VERIFY_EXPR(CtxId < m_DynamicAllocations.size());
+            const auto& Alloc = m_DynamicAllocations[CtxId];
+            if (Alloc.pd3d11Buffer != nullptr)
+            {
+                DEV_CHECK_ERR(Alloc.Generation == RingGeneration, "Dynamic constant buffer '", m_Desc.Name,
+                              "' was last mapped before the dynamic constant buffer ring of this context was discarded, so its data has been overwritten. "
+                              "Dynamic buffers must be mapped with MAP_FLAG_DISCARD every frame and in every command list before they are used.");
+                Offset = Alloc.Offset;
+                return Alloc.pd3d11Buffer;
+            }
+        }
+        Offset = 0;
+        return m_pd3d11Buffer;
+    }
+
 private:
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
@@ -95,6 +122,18 @@ private:
 
     friend class DeviceContextD3D11Impl;
     CComPtr<ID3D11Buffer> m_pd3d11Buffer; ///< D3D11 buffer object
+
+    // The location of the buffer data in the dynamic constant buffer ring of every device context.
+    // If pd3d11Buffer is null, the data is in m_pd3d11Buffer.
+    static constexpr size_t CacheLineSize = 64;
+    struct alignas(CacheLineSize) CtxDynamicAllocation
+    {
+        ID3D11Buffer* pd3d11Buffer = nullptr;
+        Uint32        Offset       = 0;
+        Uint64        Generation   = 0;
+    };
+    static_assert(sizeof(CtxDynamicAllocation) == CacheLineSize, "Unexpected sizeof(CtxDynamicAllocation)");
+    std::vector<CtxDynamicAllocation> m_DynamicAllocations;
 };
 
 } // namespace Diligent
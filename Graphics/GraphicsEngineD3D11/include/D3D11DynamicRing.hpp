@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::D3D11DynamicRing class
+
+#include <string>
+#include <atlbase.h>
+
+namespace Diligent
+{
+
+// Dynamic constant buffer ring used by a device context to suballocate the data of dynamic
+// constant buffers. Every buffer mapped with MAP_FLAG_DISCARD gets a new range of the ring,
+// which is mapped with D3D11_MAP_WRITE_NO_OVERWRITE. The whole ring is only discarded when
+// it wraps around and at the start of every command list recorded by a deferred context.
+//
+//    ______________________________________________________
+//   |                                                      |
+//   |  | Alloc0 | Alloc1 | ... | AllocN |                  |
+//   |__________________________________^___________________|
+//                                      |
+//                                  m_CurrOffset
+//
+// The ring is not thread-safe and must only be used by the context that owns it.
+class D3D11DynamicRing
+{
+public:
+    // Offsets passed to *SSetConstantBuffers1 must be multiples of 16 constants (256 bytes)
+    static constexpr Uint32 Alignment = 256;
+
+    D3D11DynamicRing(ID3D11Device* pd3d11Device, Uint32 Size, std::string Name);
+    ~D3D11DynamicRing();
+
+    // clang-format off
+    D3D11DynamicRing           (const D3D11DynamicRing&)  = delete;
+    D3D11DynamicRing           (      D3D11DynamicRing&&) = delete;
+    D3D11DynamicRing& operator=(const D3D11DynamicRing&)  = delete;
+    D3D11DynamicRing& operator=(      D3D11DynamicRing&&) = delete;
+    // clang-format on
+
+    struct Allocation
+    {
+        ID3D11Buffer* pd3d11Buffer = nullptr;
+        Uint32        Offset       = 0;
+        void*         pData        = nullptr;
+
+        // The number of times the ring was discarded before the allocation was made
+        Uint64 Generation = 0;
+
+        explicit operator bool() const { return pData != nullptr; }
+    };
+
+    // Allocates Size bytes from the ring and maps the ring buffer.
+    // Returns an empty allocation if the data can't be placed in the ring,
+    // in which case the caller should map its own buffer.
+    Allocation Allocate(ID3D11DeviceContext* pd3d11Ctx, Uint32 Size);
+
+    // Maps the ring buffer to update the data of the allocation previously returned by Allocate().
+    // Returns null if the ring has been discarded since the allocation was made.
+    void* MapNoOverwrite(ID3D11DeviceContext* pd3d11Ctx, Uint32 Offset, Uint64 Generation);
+
+    // Unmaps the ring buffer. Every Allocate() or MapNoOverwrite() call that
+    // returned a valid pointer must be matched by Unmap().
+    void Unmap(ID3D11DeviceContext* pd3d11Ctx);
+
+    // Requests the next allocation to discard the ring. Deferred contexts must call
+    // this method when a command list is finished, as the first map of a dynamic buffer in
+    // every command list must use D3D11_MAP_WRITE_DISCARD.
+    void RequestDiscard() { m_DiscardRequired = true; }
+
+    ID3D11Buffer* GetD3D11Buffer() const { return m_pd3d11Buffer; }
+
+    // Returns the generation of allocations that are currently valid. An allocation whose
+    // Generation differs from this value has been overwritten after the ring wrapped around
+    // or belongs to a previous command list of a deferred context.
+    Uint64 GetGeneration() const { return m_NumDiscards + (m_DiscardRequired ? 1 : 0); }
+
+private:
+    void* Map(ID3D11DeviceContext* pd3d11Ctx, D3D11_MAP MapType);
+
+private:
+    const std::string     m_Name;
+    CComPtr<ID3D11Buffer> m_pd3d11Buffer;
+    const Uint32          m_Size;
+
+    Uint32 m_CurrOffset = 0;
+
+    // The ring has never been mapped yet or a new command list has been started
+    bool m_DiscardRequired = true;
+
+    // The ring may be mapped several times if the application maps multiple
+    // buffers at once. The buffer is only unmapped when the count reaches zero.
+    Uint8* m_pMappedData = nullptr;
+    Uint32 m_MapCount    = 0;
+
+    Uint64 m_NumAllocations = 0;
+    Uint64 m_NumDiscards    = 0;
+    Uint64 m_NumFallbacks   = 0;
+};
+
+} // namespace Diligent
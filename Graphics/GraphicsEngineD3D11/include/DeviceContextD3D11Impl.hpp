@@ -31,6 +31,7 @@
 /// Declaration of Diligent::DeviceContextD3D11Impl class
 
 #include <vector>
+#include <memory>
 
 #include "EngineD3D11ImplTraits.hpp"
 #include "DeviceContextBase.hpp"
@@ -41,6 +42,7 @@
 #include "FramebufferD3D11Impl.hpp"
 #include "RenderPassD3D11Impl.hpp"
 #include "DisjointQueryPool.hpp"
+#include "D3D11DynamicRing.hpp"
 #include "BottomLevelASBase.hpp"
 #include "TopLevelASBase.hpp"
 #include "ShaderResourceBindingD3D11Impl.hpp"
@@ -288,6 +290,18 @@ public:
     /// Implementation of IDeviceContext::BindSparseResourceMemory() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::ResolveQueries() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE ResolveQueries(const ResolveQueriesAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
+    /// Implementation of IDeviceContext::SetDynamicRenderState() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetDynamicRenderState(const DynamicRenderState& State) override final;
+
     /// Implementation of IDeviceContextD3D11::GetD3D11DeviceContext().
     virtual ID3D11DeviceContext* DILIGENT_CALL_TYPE GetD3D11DeviceContext() override final { return m_pd3d11DeviceContext; }
 
@@ -437,6 +451,8 @@ private:
     void BindDynamicCBs(const ShaderResourceCacheD3D11&    ResourceCache,
                         const D3D11ShaderResourceCounters& BaseBindings);
 
+    Uint64 GetDynamicRingGeneration() const { return m_pDynamicRing ? m_pDynamicRing->GetGeneration() : 0; }
+
 #ifdef DILIGENT_DEVELOPMENT
     void DvpValidateCommittedShaderResources();
 #endif
@@ -445,6 +461,9 @@ private:
 
     CComPtr<ID3D11DeviceContext1> m_pd3d11DeviceContext; ///< D3D11 device context
 
+    // Ring that dynamic constant buffers are suballocated from, or null if the ring is disabled
+    std::unique_ptr<D3D11DynamicRing> m_pDynamicRing;
+
     struct BindInfo : CommittedShaderResources
     {
         // Shader stages that are active in current PSO.
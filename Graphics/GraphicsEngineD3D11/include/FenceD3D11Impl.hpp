@@ -63,6 +63,9 @@ public:
     /// Implementation of IFence::Wait() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE Wait(Uint64 Value) override final;
 
+    /// Implementation of IFence::WaitWithTimeout() in Direct3D11 backend.
+    virtual Bool DILIGENT_CALL_TYPE WaitWithTimeout(Uint64 Value, Uint64 Timeout) override final;
+
     void AddPendingQuery(CComPtr<ID3D11DeviceContext1> pCtx, CComPtr<ID3D11Query> pQuery, Uint64 Value)
     {
         m_PendingQueries.emplace_back(std::move(pCtx), std::move(pQuery), Value);
@@ -71,7 +74,7 @@ public:
         m_MaxPendingQueries = std::max(m_MaxPendingQueries, m_PendingQueries.size());
     }
 
-    void Wait(Uint64 Value, bool FlushCommands);
+    bool Wait(Uint64 Value, bool FlushCommands, Uint64 Timeout);
 
 private:
     struct PendingFenceData
@@ -159,6 +159,9 @@ public:
     /// Implementation of IRenderDevice::IdleGPU() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
+    /// Implementation of IRenderDevice::GetMemoryStats() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE GetMemoryStats(DeviceMemoryStats& Stats) override final;
+
     /// Implementation of IRenderDevice::GetSparseTextureFormatInfo() in Direct3D11 backend.
     virtual SparseTextureFormatInfo DILIGENT_CALL_TYPE GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
                                                                                   RESOURCE_DIMENSION Dimension,
@@ -167,6 +170,10 @@ public:
     size_t GetCommandQueueCount() const { return 1; }
     Uint64 GetCommandQueueMask() const { return Uint64{1}; }
 
+    // Returns the size of the dynamic constant buffer ring of every device context,
+    // or zero if the ring is disabled.
+    Uint32 GetDynamicConstantRingSize() const { return m_DynamicConstantRingSize; }
+
 
 #define GET_D3D11_DEVICE(Version)                                                  \
     ID3D11Device##Version* GetD3D11Device##Version()                               \
@@ -196,6 +203,8 @@ private:
     /// D3D11 device
     CComPtr<ID3D11Device> m_pd3d11Device;
 
+    Uint32 m_DynamicConstantRingSize = 0;
+
 #ifdef DILIGENT_DEVELOPMENT
     Uint32 m_MaxD3D11DeviceVersion = 0;
 #endif
@@ -138,6 +138,13 @@ public:
             return pBuff && RangeSize != 0 && RangeSize < pBuff->GetDesc().Size;
         }
 
+        // Returns true if the buffer has to be rebound on every draw call, i.e. if it allows
+        // setting dynamic offset or its data is suballocated from the dynamic constant buffer ring.
+        bool RequiresRebinding() const
+        {
+            return AllowsDynamicOffset() || (pBuff && pBuff->UsesDynamicRing());
+        }
+
         // Returns ID3D11Buffer
         template <D3D11_RESOURCE_RANGE ResRange>
         typename CachedResourceTraits<ResRange>::D3D11ResourceType* GetD3D11Resource();
@@ -329,14 +336,41 @@ public:
         UINT MinSlot = UINT_MAX;
         UINT MaxSlot = 0;
 
+        // Contiguous runs of changed slots within [MinSlot, MaxSlot], so that unchanged
+        // slots between them are not resubmitted. When the number of runs reaches MaxRanges,
+        // the last run is extended to cover the remaining slots.
+        static constexpr Uint32 MaxRanges = 4;
+
+        UINT   RangeStart[MaxRanges] = {};
+        UINT   RangeEnd[MaxRanges]   = {}; // Inclusive
+        Uint32 NumRanges             = 0;
+
         void Add(UINT Slot)
         {
             MinSlot = std::min(MinSlot, Slot);
 
             VERIFY_EXPR(Slot >= MaxSlot);
+            if (NumRanges > 0 && (Slot == MaxSlot + 1 || NumRanges == MaxRanges))
+            {
+                RangeEnd[NumRanges - 1] = Slot;
+            }
+            else
+            {
+                RangeStart[NumRanges] = Slot;
+                RangeEnd[NumRanges]   = Slot;
+                ++NumRanges;
+            }
             MaxSlot = Slot;
         }
 
+        // Calls Handler(StartSlot, NumSlots) for every contiguous run of changed slots
+        template <typename HandlerType>
+        void ProcessRanges(HandlerType&& Handler) const
+        {
+            for (Uint32 r = 0; r < NumRanges; ++r)
+                Handler(RangeStart[r], RangeEnd[r] - RangeStart[r] + 1);
+        }
+
         explicit operator bool() const
         {
             return MinSlot <= MaxSlot;
@@ -354,11 +388,17 @@ public:
                                         ID3D11Resource*                                          CommittedD3D11Resources[],
                                         const D3D11ShaderResourceCounters&                       BaseBindings) const;
 
+    // CtxId is the index of the device context that binds the buffers. It is used to
+    // find the data of the buffers suballocated from the dynamic constant buffer ring.
+    // RingGeneration is the current generation of this context's ring and is used to
+    // detect buffers whose data has been overwritten.
     inline MinMaxSlot BindCBs(Uint32                             ShaderInd,
                               ID3D11Buffer*                      CommittedD3D11Resources[],
                               UINT                               FirstConstants[],
                               UINT                               NumConstants[],
-                              const D3D11ShaderResourceCounters& BaseBindings) const;
+                              const D3D11ShaderResourceCounters& BaseBindings,
+                              DeviceContextIndex                 CtxId,
+                              Uint64                             RingGeneration) const;
 
     template <typename BindHandlerType>
     inline void BindDynamicCBs(Uint32                             ShaderInd,
@@ -366,6 +406,8 @@ public:
                                UINT                               FirstConstants[],
                                UINT                               NumConstants[],
                                const D3D11ShaderResourceCounters& BaseBindings,
+                               DeviceContextIndex                 CtxId,
+                               Uint64                             RingGeneration,
                                BindHandlerType&&                  BindHandler) const;
 
     enum class StateTransitionMode
@@ -474,7 +516,8 @@ private:
     // Indicates which slots may contain constant buffers with dynamic offsets
     std::array<Uint16, NumShaderTypes> m_DynamicCBSlotsMask{};
 
-    // Indicates which slots actually contain constant buffers with dynamic offsets
+    // Indicates which slots actually contain constant buffers that need to be rebound on every draw call,
+    // i.e. buffers with dynamic offsets or buffers suballocated from the dynamic constant buffer ring
     std::array<Uint16, NumShaderTypes> m_DynamicCBOffsetsMask{};
     static_assert(sizeof(m_DynamicCBOffsetsMask[0]) * 8 >= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT, "Not enough bits for all dynamic buffer slots");
 
@@ -625,7 +668,9 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
     ID3D11Buffer*                      CommittedD3D11Resources[],
     UINT                               FirstConstants[],
     UINT                               NumConstants[],
-    const D3D11ShaderResourceCounters& BaseBindings) const
+    const D3D11ShaderResourceCounters& BaseBindings,
+    DeviceContextIndex                 CtxId,
+    Uint64                             RingGeneration) const
 {
     constexpr auto Range = D3D11_RESOURCE_RANGE_CBV;
 
@@ -636,12 +681,16 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
     MinMaxSlot Slots;
     for (Uint32 res = 0; res < ResCount; ++res)
     {
-        const Uint32 Slot     = BaseBinding + res;
-        auto* const  pd3d11CB = ResArrays.second[res];
+        const Uint32 Slot       = BaseBinding + res;
+        const auto&  CB         = ResArrays.first[res];
+        auto*        pd3d11CB   = ResArrays.second[res];
+        Uint32       DataOffset = 0;
+        if (CB.pBuff && CB.pBuff->UsesDynamicRing())
+            pd3d11CB = CB.pBuff->GetD3D11Buffer(CtxId, RingGeneration, DataOffset);
         // Offsets in Direct3D11 are measure in float4 constants.
-        const auto FirstCBConstant = StaticCast<UINT>((ResArrays.first[res].BaseOffset + ResArrays.first[res].DynamicOffset) / 16u);
+        const auto FirstCBConstant = StaticCast<UINT>((DataOffset + CB.BaseOffset + CB.DynamicOffset) / 16u);
         // The number of constants must be a multiple of 16 constants. It is OK if it is past the end of the buffer.
-        const auto NumCBConstants = StaticCast<UINT>(AlignUp(ResArrays.first[res].RangeSize / 16u, 16u));
+        const auto NumCBConstants = StaticCast<UINT>(AlignUp(CB.RangeSize / 16u, 16u));
         // clang-format off
         if (CommittedD3D11Resources[Slot] != pd3d11CB        ||
             FirstConstants[Slot]          != FirstCBConstant ||
@@ -669,6 +718,8 @@ inline void ShaderResourceCacheD3D11::BindDynamicCBs(Uint32
                                                      UINT                               FirstConstants[],
                                                      UINT                               NumConstants[],
                                                      const D3D11ShaderResourceCounters& BaseBindings,
+                                                     DeviceContextIndex                 CtxId,
+                                                     Uint64                             RingGeneration,
                                                      BindHandlerType&&                  BindHandler) const
 {
     constexpr auto Range = D3D11_RESOURCE_RANGE_CBV;
@@ -683,10 +734,13 @@ inline void ShaderResourceCacheD3D11::BindDynamicCBs(Uint32
 
         const Uint32 Slot = BaseBinding + Binding;
         const auto&  CB   = ResArrays.first[Binding];
-        VERIFY_EXPR(CB.AllowsDynamicOffset() && (m_DynamicCBSlotsMask[ShaderInd] & CBBit) != 0);
-        auto* const pd3d11CB = ResArrays.second[Binding];
+        VERIFY_EXPR(CB.RequiresRebinding() && (m_DynamicCBSlotsMask[ShaderInd] & CBBit) != 0);
+        auto*  pd3d11CB   = ResArrays.second[Binding];
+        Uint32 DataOffset = 0;
+        if (CB.pBuff->UsesDynamicRing())
+            pd3d11CB = CB.pBuff->GetD3D11Buffer(CtxId, RingGeneration, DataOffset);
         // Offsets in Direct3D11 are measure in float4 constants.
-        const auto FirstCBConstant = StaticCast<UINT>((CB.BaseOffset + CB.DynamicOffset) / 16u);
+        const auto FirstCBConstant = StaticCast<UINT>((DataOffset + CB.BaseOffset + CB.DynamicOffset) / 16u);
         // The number of constants must be a multiple of 16 constants. It is OK if it is past the end of the buffer.
         const auto NumCBConstants = StaticCast<UINT>(AlignUp(CB.RangeSize / 16u, 16u));
         // clang-format off
@@ -736,7 +790,7 @@ inline void ShaderResourceCacheD3D11::UpdateDynamicCBOffsetFlag<D3D11_RESOURCE_R
     {
         // Only set the flag for those slots that allow dynamic buffers
         // (i.e. the variable was not created with NO_DYNAMIC_BUFFERS flag).
-        if (CB.AllowsDynamicOffset())
+        if (CB.RequiresRebinding())
             m_DynamicCBOffsetsMask[ShaderInd] |= BufferBit;
         else
             m_DynamicCBOffsetsMask[ShaderInd] &= ~BufferBit;
@@ -199,6 +199,9 @@ public:
 
     IObject& GetOwner() { return m_Owner; }
 
+    using TBase::GetSignature;
+    using TBase::GetResourceCache;
+
     Uint32 GetVariableCount() const;
 
     Uint32 GetVariableIndex(const IShaderResourceVariable& Variable) const;
@@ -255,7 +258,7 @@ private:
     }
 
     template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(const Char* Name) const;
+    IShaderResourceVariable* GetResourceByResIndex(Uint32 ResIndex) const;
 
     template <typename THandleCB,
               typename THandleTexSRV,
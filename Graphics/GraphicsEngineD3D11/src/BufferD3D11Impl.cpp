@@ -133,6 +133,13 @@ BufferD3D11Impl::BufferD3D11Impl(IReferenceCounters*        pRefCounters,
 
     // The memory is always coherent in Direct3D11
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
+
+    if (m_Desc.Usage == USAGE_DYNAMIC && m_Desc.BindFlags == BIND_UNIFORM_BUFFER && pRenderDeviceD3D11->GetDynamicConstantRingSize() != 0)
+    {
+        // The data of dynamic constant buffers is suballocated from the context dynamic rings
+        const auto CtxCount = pRenderDeviceD3D11->GetNumImmediateContexts() + pRenderDeviceD3D11->GetNumDeferredContexts();
+        m_DynamicAllocations.resize(CtxCount);
+    }
 }
 
 static BufferDesc BuffDescFromD3D11Buffer(ID3D11Buffer* pd3d11Buffer, BufferDesc BuffDesc)
@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "D3D11DynamicRing.hpp"
+
+#include "GraphicsAccessories.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+D3D11DynamicRing::D3D11DynamicRing(ID3D11Device* pd3d11Device, Uint32 Size, std::string Name) :
+    m_Name{std::move(Name)},
+    m_Size{AlignUp(Size, Alignment)}
+{
+    D3D11_BUFFER_DESC D3D11BuffDesc{};
+    D3D11BuffDesc.ByteWidth      = m_Size;
+    D3D11BuffDesc.Usage          = D3D11_USAGE_DYNAMIC;
+    D3D11BuffDesc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
+    D3D11BuffDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    CHECK_D3D_RESULT_THROW(pd3d11Device->CreateBuffer(&D3D11BuffDesc, nullptr, &m_pd3d11Buffer),
+                           "Failed to create the dynamic constant buffer ring");
+
+    auto hr = m_pd3d11Buffer->SetPrivateData(WKPDID_D3DDebugObjectName, static_cast<UINT>(m_Name.length()), m_Name.c_str());
+    DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to set buffer name");
+}
+
+D3D11DynamicRing::~D3D11DynamicRing()
+{
+    VERIFY(m_MapCount == 0, "The ring is destroyed while being mapped");
+
+    LOG_INFO_MESSAGE(m_Name, " usage stats:\n"
+                             "                       Size: ",
+                     FormatMemorySize(m_Size, 2),
+                     ". Allocations: ", m_NumAllocations,
+                     ". Discards: ", m_NumDiscards,
+                     ". Allocations that did not fit into the ring: ", m_NumFallbacks);
+}
+
+void* D3D11DynamicRing::Map(ID3D11DeviceContext* pd3d11Ctx, D3D11_MAP MapType)
+{
+    if (m_MapCount == 0)
+    {
+        D3D11_MAPPED_SUBRESOURCE MappedData{};
+
+        HRESULT hr = pd3d11Ctx->Map(m_pd3d11Buffer, 0, MapType, 0, &MappedData);
+        if (FAILED(hr))
+        {
+            LOG_ERROR_MESSAGE("Failed to map ", m_Name);
+            return nullptr;
+        }
+        m_pMappedData = static_cast<Uint8*>(MappedData.pData);
+    }
+    else
+    {
+        // The ring is already mapped with either D3D11_MAP_WRITE_DISCARD or D3D11_MAP_WRITE_NO_OVERWRITE.
+        // Discarding the ring while it is mapped is not allowed.
+        VERIFY_EXPR(MapType == D3D11_MAP_WRITE_NO_OVERWRITE);
+    }
+    ++m_MapCount;
+
+    return m_pMappedData;
+}
+
+D3D11DynamicRing::Allocation D3D11DynamicRing::Allocate(ID3D11DeviceContext* pd3d11Ctx, Uint32 Size)
+{
+    const Uint32 AlignedSize = AlignUp(Size, Alignment);
+
+    const bool NeedsDiscard = m_DiscardRequired || m_CurrOffset + AlignedSize > m_Size;
+    if (AlignedSize > m_Size || (NeedsDiscard && m_MapCount != 0))
+    {
+        // The data is larger than the ring, or the ring needs to be discarded while
+        // it is mapped for another buffer.
+        ++m_NumFallbacks;
+        return {};
+    }
+
+    if (NeedsDiscard)
+    {
+        // Previous contents of the ring are renamed by the driver, so draw commands
+        // that have already been recorded are not affected.
+        m_CurrOffset      = 0;
+        m_DiscardRequired = false;
+        ++m_NumDiscards;
+    }
+
+    auto* pMappedData = Map(pd3d11Ctx, NeedsDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE);
+    if (pMappedData == nullptr)
+        return {};
+
+    Allocation Alloc;
+    Alloc.pd3d11Buffer = m_pd3d11Buffer;
+    Alloc.Offset       = m_CurrOffset;
+    Alloc.pData        = pMappedData + m_CurrOffset;
+    Alloc.Generation   = m_NumDiscards;
+
+    m_CurrOffset += AlignedSize;
+    ++m_NumAllocations;
+
+    return Alloc;
+}
+
+void* D3D11DynamicRing::MapNoOverwrite(ID3D11DeviceContext* pd3d11Ctx, Uint32 Offset, Uint64 Generation)
+{
+    VERIFY(Offset < m_Size, "Offset (", Offset, ") is out of the ring bounds");
+    if (m_DiscardRequired || Generation != m_NumDiscards)
+    {
+        // The ring has been discarded since the allocation was made
+        return nullptr;
+    }
+
+    auto* pMappedData = Map(pd3d11Ctx, D3D11_MAP_WRITE_NO_OVERWRITE);
+    return pMappedData != nullptr ? pMappedData + Offset : nullptr;
+}
+
+void D3D11DynamicRing::Unmap(ID3D11DeviceContext* pd3d11Ctx)
+{
+    VERIFY(m_MapCount > 0, "The ring is not mapped");
+    if (--m_MapCount == 0)
+    {
+        pd3d11Ctx->Unmap(m_pd3d11Buffer, 0);
+        m_pMappedData = nullptr;
+    }
+}
+
+} // namespace Diligent
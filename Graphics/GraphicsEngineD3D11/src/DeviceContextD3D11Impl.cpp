@@ -67,6 +67,12 @@ DeviceContextD3D11Impl::DeviceContextD3D11Impl(IReferenceCounters*          pRef
     m_CmdListAllocator    {GetRawAllocator(), sizeof(CommandListD3D11Impl), 64}
 // clang-format on
 {
+    if (const auto RingSize = pDevice->GetDynamicConstantRingSize())
+    {
+        std::string RingName = "Dynamic constant buffer ring of ";
+        RingName += Desc.IsDeferred ? (std::string{"deferred context #"} + std::to_string(Uint32{Desc.ContextId})) : std::string{"immediate context"};
+        m_pDynamicRing = std::make_unique<D3D11DynamicRing>(pDevice->GetD3D11Device(), RingSize, std::move(RingName));
+    }
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextD3D11Impl, IID_DeviceContextD3D11, TDeviceContextBase)
@@ -80,12 +86,16 @@ void DeviceContextD3D11Impl::Begin(Uint32 ImmediateContextId)
 
 void DeviceContextD3D11Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
-    RefCntAutoPtr<PipelineStateD3D11Impl> pPipelineStateD3D11{pPipelineState, PipelineStateD3D11Impl::IID_InternalImpl};
-    VERIFY(pPipelineState == nullptr || pPipelineStateD3D11 != nullptr, "Unknown pipeline state object implementation");
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::SetPipelineState");
+
+    BorrowedPtr<PipelineStateD3D11Impl> pPipelineStateD3D11 = BorrowPipelineState(pPipelineState);
     if (PipelineStateD3D11Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D11))
+    {
+        ++m_Stats.CommandCounters.RedundantSetPipelineState;
         return;
+    }
 
-    TDeviceContextBase::SetPipelineState(std::move(pPipelineStateD3D11), 0 /*Dummy*/);
+    TDeviceContextBase::SetPipelineState(pPipelineStateD3D11, 0 /*Dummy*/);
     const auto& Desc = m_pPipelineState->GetDesc();
     if (Desc.PipelineType == PIPELINE_TYPE_COMPUTE)
     {
@@ -218,6 +228,8 @@ void DeviceContextD3D11Impl::TransitionShaderResources(IShaderResourceBinding* p
 
 void DeviceContextD3D11Impl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::CommitShaderResources");
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* const pShaderResBindingD3D11 = ClassPtrCast<ShaderResourceBindingD3D11Impl>(pShaderResourceBinding);
@@ -257,13 +269,17 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
             auto* d3d11CBs       = m_CommittedRes.d3d11CBs[ShaderInd];
             auto* FirstConstants = m_CommittedRes.CBFirstConstants[ShaderInd];
             auto* NumConstants   = m_CommittedRes.CBNumConstants[ShaderInd];
-            if (auto Slots = ResourceCache.BindCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings))
+            if (auto Slots = ResourceCache.BindCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings, GetContextId(), GetDynamicRingGeneration()))
             {
                 auto SetCB1Method = SetCB1Methods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetCB1Method)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1,
-                                                       d3d11CBs + Slots.MinSlot,
-                                                       FirstConstants + Slots.MinSlot,
-                                                       NumConstants + Slots.MinSlot);
+                Slots.ProcessRanges(
+                    [&](UINT StartSlot, UINT NumSlots) //
+                    {
+                        (m_pd3d11DeviceContext->*SetCB1Method)(StartSlot, NumSlots,
+                                                               d3d11CBs + StartSlot,
+                                                               FirstConstants + StartSlot,
+                                                               NumConstants + StartSlot);
+                    });
                 m_CommittedRes.NumCBs[ShaderInd] = std::max(m_CommittedRes.NumCBs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
             }
 #ifdef DILIGENT_DEVELOPMENT
@@ -281,7 +297,11 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
             if (auto Slots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_SRV>(ShaderInd, d3d11SRVs, d3d11SRVRes, BaseBindings))
             {
                 auto SetSRVMethod = SetSRVMethods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetSRVMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11SRVs + Slots.MinSlot);
+                Slots.ProcessRanges(
+                    [&](UINT StartSlot, UINT NumSlots) //
+                    {
+                        (m_pd3d11DeviceContext->*SetSRVMethod)(StartSlot, NumSlots, d3d11SRVs + StartSlot);
+                    });
                 m_CommittedRes.NumSRVs[ShaderInd] = std::max(m_CommittedRes.NumSRVs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
             }
 #ifdef DILIGENT_DEVELOPMENT
@@ -298,7 +318,11 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
             if (auto Slots = ResourceCache.BindResources<D3D11_RESOURCE_RANGE_SAMPLER>(ShaderInd, d3d11Samplers, BaseBindings))
             {
                 auto SetSamplerMethod = SetSamplerMethods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetSamplerMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11Samplers + Slots.MinSlot);
+                Slots.ProcessRanges(
+                    [&](UINT StartSlot, UINT NumSlots) //
+                    {
+                        (m_pd3d11DeviceContext->*SetSamplerMethod)(StartSlot, NumSlots, d3d11Samplers + StartSlot);
+                    });
                 m_CommittedRes.NumSamplers[ShaderInd] = std::max(m_CommittedRes.NumSamplers[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
             }
 #ifdef DILIGENT_DEVELOPMENT
@@ -414,11 +438,18 @@ void DeviceContextD3D11Impl::BindDynamicCBs(const ShaderResourceCacheD3D11&    R
         auto* NumConstants   = m_CommittedRes.CBNumConstants[ShaderInd];
         auto  SetCB1Method   = SetCB1Methods[ShaderInd];
 
-        ResourceCache.BindDynamicCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings,
+        // Slots are visited in increasing order, so adjacent changed slots are bound with a single call
+        ShaderResourceCacheD3D11::MinMaxSlot Slots;
+        ResourceCache.BindDynamicCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings, GetContextId(), GetDynamicRingGeneration(),
                                      [&](Uint32 Slot) //
                                      {
-                                         (m_pd3d11DeviceContext->*SetCB1Method)(Slot, 1, d3d11CBs + Slot, FirstConstants + Slot, NumConstants + Slot);
+                                         Slots.Add(Slot);
                                      });
+        Slots.ProcessRanges(
+            [&](UINT StartSlot, UINT NumSlots) //
+            {
+                (m_pd3d11DeviceContext->*SetCB1Method)(StartSlot, NumSlots, d3d11CBs + StartSlot, FirstConstants + StartSlot, NumConstants + StartSlot);
+            });
 
 #ifdef DILIGENT_DEVELOPMENT
         if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
@@ -714,6 +745,7 @@ void DeviceContextD3D11Impl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE
 
 void DeviceContextD3D11Impl::Draw(const DrawAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::Draw(Attribs, 0);
 
     PrepareForDraw(Attribs.Flags);
@@ -729,6 +761,7 @@ void DeviceContextD3D11Impl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextD3D11Impl::MultiDraw(const MultiDrawAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDraw(Attribs, 0);
 
     PrepareForDraw(Attribs.Flags);
@@ -759,6 +792,7 @@ void DeviceContextD3D11Impl::MultiDraw(const MultiDrawAttribs& Attribs)
 
 void DeviceContextD3D11Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexed(Attribs, 0);
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
@@ -774,6 +808,7 @@ void DeviceContextD3D11Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
 void DeviceContextD3D11Impl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDrawIndexed(Attribs, 0);
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
@@ -798,6 +833,7 @@ void DeviceContextD3D11Impl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Att
 
 void DeviceContextD3D11Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndirect(Attribs, 0);
     DEV_CHECK_ERR(Attribs.pCounterBuffer == nullptr, "Direct3D11 does not support indirect counter buffer");
 
@@ -835,6 +871,7 @@ void DeviceContextD3D11Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextD3D11Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexedIndirect(Attribs, 0);
     DEV_CHECK_ERR(Attribs.pCounterBuffer == nullptr, "Direct3D11 does not support indirect counter buffer");
 
@@ -881,6 +918,7 @@ void DeviceContextD3D11Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Att
 
 void DeviceContextD3D11Impl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchCompute(Attribs, 0);
 
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask())
@@ -911,6 +949,7 @@ void DeviceContextD3D11Impl::DispatchCompute(const DispatchComputeAttribs& Attri
 
 void DeviceContextD3D11Impl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchComputeIndirect(Attribs, 0);
 
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask())
@@ -991,8 +1030,11 @@ void DeviceContextD3D11Impl::ClearRenderTarget(ITextureView* pView, const void*
 
 void DeviceContextD3D11Impl::Flush()
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextD3D11Impl::Flush");
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Flushing device context inside an active render pass.");
     m_pd3d11DeviceContext->Flush();
+    ++m_Stats.SubmitCount;
 }
 
 void DeviceContextD3D11Impl::UpdateBuffer(IBuffer*                       pBuffer,
@@ -1029,14 +1071,18 @@ void DeviceContextD3D11Impl::CopyBuffer(IBuffer*                       pSrcBuffe
     auto* pSrcBufferD3D11Impl = ClassPtrCast<BufferD3D11Impl>(pSrcBuffer);
     auto* pDstBufferD3D11Impl = ClassPtrCast<BufferD3D11Impl>(pDstBuffer);
 
+    // The source data may be located in the dynamic constant buffer ring
+    Uint32 SrcDataOffset = 0;
+    auto*  pd3d11SrcBuff = pSrcBufferD3D11Impl->GetD3D11Buffer(GetContextId(), GetDynamicRingGeneration(), SrcDataOffset);
+
     D3D11_BOX SrcBox;
-    SrcBox.left   = StaticCast<UINT>(SrcOffset);
-    SrcBox.right  = StaticCast<UINT>(SrcOffset + Size);
+    SrcBox.left   = StaticCast<UINT>(SrcDataOffset + SrcOffset);
+    SrcBox.right  = StaticCast<UINT>(SrcDataOffset + SrcOffset + Size);
     SrcBox.top    = 0;
     SrcBox.bottom = 1;
     SrcBox.front  = 0;
     SrcBox.back   = 1;
-    m_pd3d11DeviceContext->CopySubresourceRegion(pDstBufferD3D11Impl->m_pd3d11Buffer, 0, StaticCast<UINT>(DstOffset), 0, 0, pSrcBufferD3D11Impl->m_pd3d11Buffer, 0, &SrcBox);
+    m_pd3d11DeviceContext->CopySubresourceRegion(pDstBufferD3D11Impl->m_pd3d11Buffer, 0, StaticCast<UINT>(DstOffset), 0, 0, pd3d11SrcBuff, 0, &SrcBox);
 }
 
 
@@ -1044,7 +1090,38 @@ void DeviceContextD3D11Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_F
 {
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
 
-    auto*     pBufferD3D11  = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    auto* pBufferD3D11 = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    if (pBufferD3D11->UsesDynamicRing() && m_pDynamicRing && MapType == MAP_WRITE)
+    {
+        auto& DynAlloc = pBufferD3D11->m_DynamicAllocations[GetContextId()];
+        if (MapFlags & MAP_FLAG_DISCARD)
+        {
+            auto RingAlloc = m_pDynamicRing->Allocate(m_pd3d11DeviceContext, StaticCast<Uint32>(pBufferD3D11->GetDesc().Size));
+            if (RingAlloc)
+            {
+                DynAlloc.pd3d11Buffer = RingAlloc.pd3d11Buffer;
+                DynAlloc.Offset       = RingAlloc.Offset;
+                DynAlloc.Generation   = RingAlloc.Generation;
+                pMappedData           = RingAlloc.pData;
+                return;
+            }
+        }
+        else if (DynAlloc.pd3d11Buffer != nullptr)
+        {
+            if (auto* pData = m_pDynamicRing->MapNoOverwrite(m_pd3d11DeviceContext, DynAlloc.Offset, DynAlloc.Generation))
+            {
+                pMappedData = pData;
+                return;
+            }
+            DEV_ERROR("Failed to map dynamic buffer '", pBufferD3D11->GetDesc().Name,
+                      "' with MAP_FLAG_NO_OVERWRITE: the buffer contents have been discarded. "
+                      "Dynamic buffers must be mapped with MAP_FLAG_DISCARD every frame before they are used.");
+        }
+
+        // The data is placed in the buffer's own d3d11 buffer
+        DynAlloc = {};
+    }
+
     D3D11_MAP d3d11MapType  = static_cast<D3D11_MAP>(0);
     UINT      d3d11MapFlags = 0;
     MapParamsToD3D11MapParams(MapType, MapFlags, d3d11MapType, d3d11MapFlags);
@@ -1063,6 +1140,12 @@ void DeviceContextD3D11Impl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* pBufferD3D11 = ClassPtrCast<BufferD3D11Impl>(pBuffer);
+    if (pBufferD3D11->UsesDynamicRing() && pBufferD3D11->m_DynamicAllocations[GetContextId()].pd3d11Buffer != nullptr)
+    {
+        VERIFY_EXPR(m_pDynamicRing && MapType == MAP_WRITE);
+        m_pDynamicRing->Unmap(m_pd3d11DeviceContext);
+        return;
+    }
     m_pd3d11DeviceContext->Unmap(pBufferD3D11->m_pd3d11Buffer, 0);
 }
 
@@ -1206,7 +1289,7 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    const bool StreamsChanged = TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags, 0);
     for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
     {
         auto& CurrStream = m_VertexStreams[Slot];
@@ -1233,12 +1316,13 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
         }
     }
 
-    m_bCommittedD3D11VBsUpToDate = false;
+    if (StreamsChanged)
+        m_bCommittedD3D11VBsUpToDate = false;
 }
 
 void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const bool IndexBufferChanged = TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode, 0);
 
     if (m_pIndexBuffer)
     {
@@ -1262,13 +1346,15 @@ void DeviceContextD3D11Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOf
 #endif
     }
 
-    m_bCommittedD3D11IBUpToDate = false;
+    if (IndexBufferChanged)
+        m_bCommittedD3D11IBUpToDate = false;
 }
 
 void DeviceContextD3D11Impl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
     static_assert(MAX_VIEWPORTS >= D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
 
     D3D11_VIEWPORT d3d11Viewports[MAX_VIEWPORTS];
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
@@ -1289,7 +1375,8 @@ void DeviceContextD3D11Impl::SetViewports(Uint32 NumViewports, const Viewport* p
 void DeviceContextD3D11Impl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
     static_assert(MAX_VIEWPORTS >= D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     D3D11_RECT d3d11ScissorRects[MAX_VIEWPORTS];
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
@@ -1901,8 +1988,13 @@ void DeviceContextD3D11Impl::FinishCommandList(ICommandList** ppCommandList)
     CommandListD3D11Impl* pCmdListD3D11(NEW_RC_OBJ(m_CmdListAllocator, "CommandListD3D11Impl instance", CommandListD3D11Impl)(m_pDevice, this, pd3d11CmdList));
     pCmdListD3D11->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
 
-    // Device context is now in default state
-    InvalidateState();
+    // Device context is now in default state, so only the state cache needs to be reset.
+    // Unbinding resources through InvalidateState() would be redundant.
+    ClearStateCache();
+
+    // The first map of a dynamic buffer in every command list must use D3D11_MAP_WRITE_DISCARD
+    if (m_pDynamicRing)
+        m_pDynamicRing->RequestDiscard();
 
 #ifdef DILIGENT_DEVELOPMENT
     if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
@@ -1933,6 +2025,7 @@ void DeviceContextD3D11Impl::ExecuteCommandLists(Uint32               NumCommand
 
     for (Uint32 i = 0; i < NumCommandLists; ++i)
     {
+        // D3D11 command lists are immutable and may be executed any number of times
         auto* pCmdListD3D11 = ClassPtrCast<CommandListD3D11Impl>(ppCommandLists[i]);
         auto* pd3d11CmdList = pCmdListD3D11->GetD3D11CommandList();
         m_pd3d11DeviceContext->ExecuteCommandList(pd3d11CmdList,
@@ -1945,8 +2038,10 @@ void DeviceContextD3D11Impl::ExecuteCommandLists(Uint32               NumCommand
         );
     }
 
-    // Device context is now in default state
-    InvalidateState();
+    // Device context is now in default state. Reset the state cache without issuing
+    // redundant unbind commands so that the state set after the replay is only the
+    // difference from the default state.
+    ClearStateCache();
 
 #ifdef DILIGENT_DEVELOPMENT
     if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
@@ -2452,6 +2547,26 @@ bool DeviceContextD3D11Impl::ResizeTilePool(ID3D11Buffer* pBuffer, UINT NewSize)
     return SUCCEEDED(pd3d11DeviceContext2->ResizeTilePool(pBuffer, NewSize));
 }
 
+void DeviceContextD3D11Impl::ResolveQueries(const ResolveQueriesAttribs& Attribs)
+{
+    UNSUPPORTED("ResolveQueries is not supported in Direct3D11");
+}
+
+void DeviceContextD3D11Impl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    UNSUPPORTED("BeginConditionalRendering is not supported in Direct3D11");
+}
+
+void DeviceContextD3D11Impl::EndConditionalRendering()
+{
+    UNSUPPORTED("EndConditionalRendering is not supported in Direct3D11");
+}
+
+void DeviceContextD3D11Impl::SetDynamicRenderState(const DynamicRenderState& State)
+{
+    UNSUPPORTED("SetDynamicRenderState is not supported in Direct3D11");
+}
+
 void DeviceContextD3D11Impl::BeginDebugGroup(const Char* Name, const float* pColor)
 {
     TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
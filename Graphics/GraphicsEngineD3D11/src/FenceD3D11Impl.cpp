@@ -75,25 +75,39 @@ Uint64 FenceD3D11Impl::GetCompletedValue()
 
 void FenceD3D11Impl::Wait(Uint64 Value)
 {
-    return Wait(Value, true);
+    Wait(Value, true, FenceWaitTimeout::Infinite);
 }
 
-void FenceD3D11Impl::Wait(Uint64 Value, bool FlushCommands)
+Bool FenceD3D11Impl::WaitWithTimeout(Uint64 Value, Uint64 Timeout)
 {
+    return Wait(Value, true, Timeout);
+}
+
+bool FenceD3D11Impl::Wait(Uint64 Value, bool FlushCommands, Uint64 Timeout)
+{
+    FenceWaitTimeout WaitTimeout{Timeout};
     while (!m_PendingQueries.empty())
     {
         auto& QueryData = m_PendingQueries.front();
         if (QueryData.Value > Value)
             break;
 
+        // Direct3D11 event queries can only be polled. Yield the time slice rather than
+        // sleep, since the sleep may take as long as the scheduler quantum (up to 1 ms on Windows).
         BOOL Data;
         while (QueryData.pd3d11Ctx->GetData(QueryData.pd3d11Query, &Data, sizeof(Data), FlushCommands ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
-            std::this_thread::sleep_for(std::chrono::microseconds{1});
+        {
+            if (WaitTimeout.IsExpired())
+                return false;
+            std::this_thread::yield();
+        }
 
         VERIFY_EXPR(Data == TRUE);
         UpdateLastCompletedFenceValue(QueryData.Value);
         m_PendingQueries.pop_front();
     }
+
+    return m_LastCompletedFenceValue.load() >= Value;
 }
 
 void FenceD3D11Impl::Signal(Uint64 Value)
@@ -126,6 +126,30 @@ RenderDeviceD3D11Impl::RenderDeviceD3D11Impl(IReferenceCounters*          pRefCo
     // Initialize device features
     m_DeviceInfo.Features = EnableDeviceFeatures(m_AdapterInfo.Features, EngineCI.Features);
 
+    if (CComQIPtr<IDXGIDevice> pDXGIDevice{m_pd3d11Device})
+    {
+        CComPtr<IDXGIAdapter> pDXGIAdapter;
+        if (SUCCEEDED(pDXGIDevice->GetAdapter(&pDXGIAdapter)))
+            m_pDXGIAdapter3 = CComQIPtr<IDXGIAdapter3>{pDXGIAdapter};
+    }
+
+    if (EngineCI.DynamicConstantRingSize != 0)
+    {
+        // Suballocating dynamic constant buffers requires mapping them with D3D11_MAP_WRITE_NO_OVERWRITE
+        // and binding them with offsets, which is only supported starting with Windows 8.
+        D3D11_FEATURE_DATA_D3D11_OPTIONS d3d11Options{};
+        if (SUCCEEDED(m_pd3d11Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &d3d11Options, sizeof(d3d11Options))) &&
+            d3d11Options.MapNoOverwriteOnDynamicConstantBuffer && d3d11Options.ConstantBufferOffsetting)
+        {
+            m_DynamicConstantRingSize = EngineCI.DynamicConstantRingSize;
+        }
+        else
+        {
+            LOG_INFO_MESSAGE("Dynamic constant buffer ring is disabled as the device does not support "
+                             "D3D11_MAP_WRITE_NO_OVERWRITE on dynamic constant buffers or constant buffer offsetting");
+        }
+    }
+
     InitShaderCompilationThreadPool(EngineCI.pAsyncShaderCompilationThreadPool, EngineCI.NumAsyncShaderCompilationThreads);
 }
 
@@ -394,6 +418,12 @@ void RenderDeviceD3D11Impl::IdleGPU()
     }
 }
 
+void RenderDeviceD3D11Impl::GetMemoryStats(DeviceMemoryStats& Stats)
+{
+    Stats = DeviceMemoryStats{};
+    GetDXGIMemoryBudget(Stats);
+}
+
 SparseTextureFormatInfo RenderDeviceD3D11Impl::GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
                                                                           RESOURCE_DIMENSION Dimension,
                                                                           Uint32             SampleCount) const
@@ -160,6 +160,8 @@ ID3D11DeviceChild* ShaderD3D11Impl::GetD3D11Shader(IDataBlob* pBytecode) noexcep
 
     auto* pd3d11Device = GetDevice()->GetD3D11Device();
 
+    ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+
     CComPtr<ID3D11DeviceChild> pd3d11Shader;
     switch (m_Desc.ShaderType)
     {
@@ -349,8 +349,8 @@ void ShaderResourceCacheD3D11::DbgVerifyDynamicBufferMasks() const
             const auto  BuffBit = 1u << i;
             const auto& CB      = CBArrays.first[i];
 
-            const auto IsDynamicOffset = CB.AllowsDynamicOffset() && (m_DynamicCBSlotsMask[ShaderInd] & BuffBit) != 0;
-            VERIFY(IsDynamicOffset == ((m_DynamicCBOffsetsMask[ShaderInd] & BuffBit) != 0), "Bit ", i, " in m_DynamicCBOffsetsMask is not valid");
+            const auto IsDynamic = CB.RequiresRebinding() && (m_DynamicCBSlotsMask[ShaderInd] & BuffBit) != 0;
+            VERIFY(IsDynamic == ((m_DynamicCBOffsetsMask[ShaderInd] & BuffBit) != 0), "Bit ", i, " in m_DynamicCBOffsetsMask is not valid");
         }
     }
 }
@@ -152,7 +152,7 @@ void SwapChainD3D11Impl::Present(Uint32 SyncInterval)
     // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
     WaitForFrame();
 
-    m_pSwapChain->Present(SyncInterval, 0);
+    m_pSwapChain->Present(SyncInterval, GetPresentFlags(SyncInterval));
 }
 
 void SwapChainD3D11Impl::UpdateSwapChain(bool CreateNew)
@@ -35,6 +35,7 @@
 #include "BufferViewD3D12Impl.hpp" // Required by BufferBase
 #include "D3D12ResourceBase.hpp"
 #include "D3D12DynamicHeap.hpp"
+#include "D3D12PlacedResourceAllocator.hpp"
 #include "DescriptorHeap.hpp"
 #include "IndexWrapper.hpp"
 
@@ -117,6 +118,9 @@ public:
 
     D3D12_CPU_DESCRIPTOR_HANDLE GetCBVHandle() { return m_CBVDescriptorAllocation.GetCpuHandle(); }
 
+    // Returns true if the resource is suballocated from a shared heap, see D3D12PlacedResourceAllocator.
+    bool IsPlaced() const { return !m_PlacedAllocation.IsNull(); }
+
     void CreateCBV(D3D12_CPU_DESCRIPTOR_HANDLE CBVDescriptor, Uint64 Offset = 0, Uint64 Size = 0) const;
 
 private:
@@ -127,6 +131,9 @@ private:
 
     DescriptorHeapAllocation m_CBVDescriptorAllocation;
 
+    // Heap suballocation of a placed buffer. Null for committed buffers.
+    D3D12PlacedResourceAllocation m_PlacedAllocation;
+
     // Align the struct size to the cache line size to avoid false sharing
     static constexpr size_t CacheLineSize = 64;
     struct alignas(CacheLineSize) CtxDynamicData : D3D12DynamicAllocation
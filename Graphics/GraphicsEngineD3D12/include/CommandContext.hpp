@@ -29,10 +29,12 @@
 #pragma once
 
 #include <vector>
+#include <utility>
 
 #include "DeviceContext.h"
 #include "D3D12ResourceBase.hpp"
 #include "DescriptorHeap.hpp"
+#include "CommandListManager.hpp"
 
 namespace Diligent
 {
@@ -119,6 +121,9 @@ public:
     void TransitionResource(BottomLevelASD3D12Impl& BLAS, RESOURCE_STATE NewState);
     void TransitionResource(TopLevelASD3D12Impl& TLAS, RESOURCE_STATE NewState);
 
+    // Transitions the subresources in the range; the texture must track subresource states.
+    void TransitionResource(TextureD3D12Impl& Texture, const TextureSubresourceRange& Range, RESOURCE_STATE NewState);
+
     void TransitionResource(TextureD3D12Impl& Texture, const StateTransitionDesc& Barrier);
     void TransitionResource(BufferD3D12Impl& Buffer, const StateTransitionDesc& Barrier);
     void TransitionResource(BottomLevelASD3D12Impl& BLAS, const StateTransitionDesc& Barrier);
@@ -143,6 +148,9 @@ public:
             m_pCommandList->ResourceBarrier(static_cast<UINT>(m_PendingResourceBarriers.size()), m_PendingResourceBarriers.data());
             m_PendingResourceBarriers.clear();
         }
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+        FlushEnhancedBarriers();
+#endif
     }
 
 
@@ -179,9 +187,13 @@ public:
     }
 
     void                       SetID(const Char* ID) { m_ID = ID; }
+    CommandAllocatorRing&      GetAllocatorRing() { return m_AllocatorRing; }
     ID3D12GraphicsCommandList* GetCommandList() { return m_pCommandList; }
     D3D12_COMMAND_LIST_TYPE    GetCommandListType() const { return m_pCommandList->GetType(); }
 
+    // Returns the number of barriers recorded since the last call to this method
+    Uint32 ExtractNumBarriers() { return std::exchange(m_NumBarriers, 0u); }
+
     DescriptorHeapAllocation AllocateDynamicGPUVisibleDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count = 1)
     {
         VERIFY(m_DynamicGPUDescriptorAllocators != nullptr, "Dynamic GPU descriptor allocators have not been initialized. Did you forget to call SetDynamicGPUDescriptorAllocators() after resetting the context?");
@@ -191,9 +203,39 @@ public:
 
     void ResourceBarrier(const D3D12_RESOURCE_BARRIER& Barrier)
     {
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+        // Preserve the order of legacy and enhanced barriers
+        FlushEnhancedBarriers();
+#endif
         m_PendingResourceBarriers.emplace_back(Barrier);
+        ++m_NumBarriers;
     }
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    // Enhanced barriers are only used in direct command lists that expose ID3D12GraphicsCommandList7,
+    // which CommandListManager only requests when the device supports them.
+    bool UseEnhancedBarriers() const
+    {
+        return m_MaxInterfaceVer >= 7 && m_pCommandList->GetType() == D3D12_COMMAND_LIST_TYPE_DIRECT;
+    }
+
+    void BufferBarrier(const D3D12_BUFFER_BARRIER& Barrier)
+    {
+        VERIFY_EXPR(UseEnhancedBarriers());
+        FlushLegacyBarriers();
+        m_PendingBufferBarriers.emplace_back(Barrier);
+        ++m_NumBarriers;
+    }
+
+    void TextureBarrier(const D3D12_TEXTURE_BARRIER& Barrier)
+    {
+        VERIFY_EXPR(UseEnhancedBarriers());
+        FlushLegacyBarriers();
+        m_PendingTextureBarriers.emplace_back(Barrier);
+        ++m_NumBarriers;
+    }
+#endif
+
     void SetPipelineState(ID3D12PipelineState* pPSO)
     {
         if (pPSO != m_pCurPipelineState)
@@ -218,6 +260,11 @@ public:
         m_pCommandList->EndQuery(pQueryHeap, Type, Index);
     }
 
+    void SetPredication(ID3D12Resource* pBuffer, UINT64 AlignedBufferOffset, D3D12_PREDICATION_OP Operation)
+    {
+        m_pCommandList->SetPredication(pBuffer, AlignedBufferOffset, Operation);
+    }
+
     void ResolveQueryData(ID3D12QueryHeap* pQueryHeap,
                           D3D12_QUERY_TYPE Type,
                           UINT             StartIndex,
@@ -252,14 +299,34 @@ public:
 protected:
     void InsertAliasBarrier(D3D12ResourceBase& Before, D3D12ResourceBase& After, bool FlushImmediate = false);
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    void FlushLegacyBarriers()
+    {
+        if (!m_PendingResourceBarriers.empty())
+        {
+            m_pCommandList->ResourceBarrier(static_cast<UINT>(m_PendingResourceBarriers.size()), m_PendingResourceBarriers.data());
+            m_PendingResourceBarriers.clear();
+        }
+    }
+
+    void FlushEnhancedBarriers();
+#endif
+
     CComPtr<ID3D12GraphicsCommandList> m_pCommandList;
     CComPtr<ID3D12CommandAllocator>    m_pCurrentAllocator;
 
+    // Allocators used by previous command lists recorded by this context
+    CommandAllocatorRing m_AllocatorRing;
+
     void*                m_pCurPipelineState         = nullptr;
     ID3D12RootSignature* m_pCurGraphicsRootSignature = nullptr;
     ID3D12RootSignature* m_pCurComputeRootSignature  = nullptr;
 
     std::vector<D3D12_RESOURCE_BARRIER, STDAllocatorRawMem<D3D12_RESOURCE_BARRIER>> m_PendingResourceBarriers;
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    std::vector<D3D12_BUFFER_BARRIER, STDAllocatorRawMem<D3D12_BUFFER_BARRIER>>   m_PendingBufferBarriers;
+    std::vector<D3D12_TEXTURE_BARRIER, STDAllocatorRawMem<D3D12_TEXTURE_BARRIER>> m_PendingTextureBarriers;
+#endif
 
     ShaderDescriptorHeaps m_BoundDescriptorHeaps;
 
@@ -270,6 +337,8 @@ protected:
     D3D12_PRIMITIVE_TOPOLOGY m_PrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
 
     Uint32 m_MaxInterfaceVer = 0;
+
+    Uint32 m_NumBarriers = 0;
 };
 
 class ComputeContext : public CommandContext
@@ -368,6 +437,11 @@ public:
 
 class GraphicsContext1 : public GraphicsContext
 {
+public:
+    void SetViewInstanceMask(UINT Mask)
+    {
+        static_cast<ID3D12GraphicsCommandList1*>(m_pCommandList.p)->SetViewInstanceMask(Mask);
+    }
 };
 
 class GraphicsContext2 : public GraphicsContext1
@@ -30,6 +30,7 @@
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <array>
 #include <stdint.h>
 #include "IndexWrapper.hpp"
 
@@ -38,6 +39,57 @@ namespace Diligent
 
 class RenderDeviceD3D12Impl;
 
+// Small ring of command allocators owned by a single command context.
+// Allocators are retired with the fence value of the submission that used them and
+// are reused once the fence has completed, bypassing the shared allocator pool.
+// The ring is not thread-safe: it is only accessed by the thread that owns the context.
+class CommandAllocatorRing
+{
+public:
+    static constexpr Uint32 Capacity = 4;
+
+    struct RetiredAllocator
+    {
+        CComPtr<ID3D12CommandAllocator> pAllocator;
+        SoftwareQueueIndex              CmdQueue{0};
+        Uint64                          FenceValue = 0;
+    };
+
+    bool IsEmpty() const { return m_Size == 0; }
+    bool IsFull() const { return m_Size == Capacity; }
+
+    void Push(CComPtr<ID3D12CommandAllocator>&& pAllocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
+    {
+        VERIFY_EXPR(!IsFull());
+        auto& Entry{m_Allocators[(m_Head + m_Size) % Capacity]};
+        Entry.pAllocator = std::move(pAllocator);
+        Entry.CmdQueue   = CmdQueue;
+        Entry.FenceValue = FenceValue;
+        ++m_Size;
+    }
+
+    const RetiredAllocator& Front() const
+    {
+        VERIFY_EXPR(!IsEmpty());
+        return m_Allocators[m_Head];
+    }
+
+    CComPtr<ID3D12CommandAllocator> Pop()
+    {
+        VERIFY_EXPR(!IsEmpty());
+        CComPtr<ID3D12CommandAllocator> pAllocator = std::move(m_Allocators[m_Head].pAllocator);
+        m_Head = (m_Head + 1) % Capacity;
+        --m_Size;
+        return pAllocator;
+    }
+
+private:
+    std::array<RetiredAllocator, Capacity> m_Allocators;
+
+    Uint32 m_Head = 0;
+    Uint32 m_Size = 0;
+};
+
 class CommandListManager
 {
 public:
@@ -54,8 +106,13 @@ public:
     // Returns the maximum supported interface version
     void CreateNewCommandList(ID3D12GraphicsCommandList** ppList, ID3D12CommandAllocator** ppAllocator, Uint32& IfaceVersion);
 
-    void RequestAllocator(ID3D12CommandAllocator** ppAllocator);
-    void ReleaseAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue);
+    // If pRing is not null, the oldest allocator in the ring is reused without locking the
+    // shared pool, provided that the GPU has finished using it.
+    void RequestAllocator(ID3D12CommandAllocator** ppAllocator, CommandAllocatorRing* pRing = nullptr);
+
+    // If pRing is not null and has free space, the allocator is retired to the ring.
+    // Otherwise it is returned to the shared pool through the release queue.
+    void ReleaseAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue, CommandAllocatorRing* pRing = nullptr);
 
     // Returns allocator to the list of available allocators. The GPU must have finished using the
     // allocator
@@ -73,6 +130,13 @@ public:
         return m_CmdListType;
     }
 
+    // Returns the total number of command allocators created by the manager.
+    // A steadily growing value indicates that allocators are leaked.
+    Int32 GetAllocatorCount() const
+    {
+        return m_NumAllocators.load();
+    }
+
 private:
     std::mutex                                                                                        m_AllocatorMutex;
     std::vector<CComPtr<ID3D12CommandAllocator>, STDAllocatorRawMem<CComPtr<ID3D12CommandAllocator>>> m_FreeAllocators;
@@ -81,7 +145,7 @@ private:
 
     const D3D12_COMMAND_LIST_TYPE m_CmdListType;
 
-    std::atomic<Int32> m_NumAllocators{0}; // For logging only
+    std::atomic<Int32> m_NumAllocators{0};
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Int32> m_AllocatorCounter{0};
@@ -32,6 +32,7 @@
 
 #include <mutex>
 #include <atomic>
+#include <vector>
 
 #include "CommandQueueD3D12.h"
 #include "ObjectBase.hpp"
@@ -45,7 +46,10 @@ class CommandQueueD3D12Impl final : public ObjectBase<ICommandQueueD3D12>
 public:
     using TBase = ObjectBase<ICommandQueueD3D12>;
 
-    CommandQueueD3D12Impl(IReferenceCounters* pRefCounters, ID3D12CommandQueue* pd3d12NativeCmdQueue, ID3D12Fence* pd3d12Fence);
+    CommandQueueD3D12Impl(IReferenceCounters* pRefCounters,
+                          ID3D12CommandQueue* pd3d12NativeCmdQueue,
+                          ID3D12Fence*        pd3d12Fence,
+                          Uint32              SubmitBatchSize = 0);
     ~CommandQueueD3D12Impl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_CommandQueueD3D12, TBase)
@@ -59,6 +63,9 @@ public:
     // Implementation of ICommandQueue::GetCompletedFenceValue().
     virtual Uint64 DILIGENT_CALL_TYPE GetCompletedFenceValue() override final;
 
+    // Implementation of ICommandQueue::GetTimestampCalibration().
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final;
+
     // Implementation of ICommandQueueD3D12::Submit().
     virtual Uint64 DILIGENT_CALL_TYPE Submit(Uint32                    NumCommandLists,
                                              ID3D12CommandList* const* ppCommandLists) override final;
@@ -82,7 +89,17 @@ public:
     virtual void DILIGENT_CALL_TYPE UpdateTileMappings(ResourceTileMappingsD3D12* pMappings,
                                                        Uint32                     Count) override final;
 
+    // Executes all batched command lists and signals, see EngineD3D12CreateInfo::SubmitBatchSize.
+    void FlushBatchedSubmits();
+
+    // Returns true if there are command lists or signals that have not been submitted to the queue yet.
+    bool HasBatchedSubmits();
+
+    bool IsSubmitBatchingEnabled() const { return m_SubmitBatchSize != 0; }
+
 private:
+    void InternalFlushBatchedSubmits();
+
     // A value that will be signaled by the command queue next
     std::atomic<Uint64> m_NextFenceValue{1};
 
@@ -101,6 +118,18 @@ private:
     CComPtr<ID3D12Fence> m_d3d12Fence;
 
     HANDLE m_WaitForGPUEventHandle = {};
+
+    // The maximum number of submissions that are batched into one ExecuteCommandLists() call.
+    // Zero if batching is disabled.
+    const Uint32 m_SubmitBatchSize;
+
+    // The members below are protected by m_QueueMtx.
+    Uint32                                               m_NumBatchedSubmits = 0;
+    std::vector<CComPtr<ID3D12CommandList>>              m_BatchedCmdLists;
+    std::vector<ID3D12CommandList*>                      m_TempCmdLists;
+    std::vector<std::pair<CComPtr<ID3D12Fence>, Uint64>> m_BatchedSignals;
+    // The queue fence value to signal after the batched command lists, or zero
+    Uint64 m_BatchedFenceValue = 0;
 };
 
 } // namespace Diligent
@@ -76,7 +76,8 @@ struct D3D12DynamicAllocation
 class D3D12DynamicPage
 {
 public:
-    D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size);
+    // If GPUUpload is true, the page is created in the D3D12_HEAP_TYPE_GPU_UPLOAD heap
+    D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size, bool GPUUpload = false);
 
     // clang-format off
     D3D12DynamicPage            (const D3D12DynamicPage&)  = delete;
@@ -112,10 +113,13 @@ public:
 
     bool IsValid() const { return m_pd3d12Buffer != nullptr; }
 
+    bool IsGPUUpload() const { return m_IsGPUUpload; }
+
 private:
     CComPtr<ID3D12Resource>   m_pd3d12Buffer;
     void*                     m_CPUVirtualAddress = nullptr; // The CPU-writeable address
     D3D12_GPU_VIRTUAL_ADDRESS m_GPUVirtualAddress = 0;       // The GPU-visible address
+    bool                      m_IsGPUUpload       = false;
 };
 
 
@@ -139,7 +143,14 @@ public:
 
     void Destroy();
 
-    D3D12DynamicPage AllocatePage(Uint64 SizeInBytes);
+    D3D12DynamicPage AllocatePage(Uint64 SizeInBytes, bool GPUUpload = false);
+
+    // Returns true if the adapter supports D3D12_HEAP_TYPE_GPU_UPLOAD heaps
+    bool IsGPUUploadHeapSupported() const { return m_GPUUploadHeapSupported; }
+
+    // Returns the total size of all pages and the size of the pages that are
+    // used by the contexts or are waiting in the release queues.
+    void GetMemoryStats(Uint64& TotalSize, Uint64& UsedSize);
 
 #ifdef DILIGENT_DEVELOPMENT
     Int32 GetAllocatedPageCounter() const
@@ -153,7 +164,17 @@ private:
 
     std::mutex m_AvailablePagesMtx;
     using AvailablePagesMapElemType = std::pair<const Uint64, D3D12DynamicPage>;
-    std::multimap<Uint64, D3D12DynamicPage, std::less<Uint64>, STDAllocatorRawMem<AvailablePagesMapElemType>> m_AvailablePages;
+    using AvailablePagesMapType     = std::multimap<Uint64, D3D12DynamicPage, std::less<Uint64>, STDAllocatorRawMem<AvailablePagesMapElemType>>;
+    AvailablePagesMapType m_AvailablePages;
+    AvailablePagesMapType m_AvailableGPUUploadPages;
+
+    AvailablePagesMapType& GetAvailablePages(bool GPUUpload) { return GPUUpload ? m_AvailableGPUUploadPages : m_AvailablePages; }
+
+    bool m_GPUUploadHeapSupported = false;
+
+    // The total size of all pages and the size of the allocated pages, protected by m_AvailablePagesMtx
+    Uint64 m_TotalPageSize     = 0;
+    Uint64 m_AllocatedPageSize = 0;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Int32> m_AllocatedPageCounter{0};
@@ -161,14 +182,25 @@ private:
 };
 
 
+// Dynamic heap is used by a device context to allocate dynamic space. Pages are requested
+// from the global dynamic memory manager, which requires a lock. To reduce contention when
+// many deferred contexts map dynamic resources in parallel, the first page requested in a frame
+// is large enough to hold the memory used by the heap during the previous frame, and every
+// following page in the same frame is twice as large as the previous one (up to MaxPageSizeScale * PageSize).
 class D3D12DynamicHeap
 {
 public:
-    D3D12DynamicHeap(D3D12DynamicMemoryManager& DynamicMemMgr, std::string HeapName, Uint64 PageSize) :
+    static constexpr Uint64 MaxPageSizeScale = 16;
+
+    D3D12DynamicHeap(D3D12DynamicMemoryManager& DynamicMemMgr, std::string HeapName, Uint64 PageSize, bool GPUUpload = false) :
         m_GlobalDynamicMemMgr{DynamicMemMgr},
         m_HeapName{std::move(HeapName)},
-        m_PageSize{PageSize}
-    {}
+        m_PageSize{PageSize},
+        m_GPUUpload{GPUUpload},
+        m_NextPageSize{PageSize}
+    {
+        VERIFY(!m_GPUUpload || m_GlobalDynamicMemMgr.IsGPUUploadHeapSupported(), "GPU upload heaps are not supported");
+    }
 
     // clang-format off
     D3D12DynamicHeap            (const D3D12DynamicHeap&) = delete;
@@ -193,6 +225,10 @@ private:
     std::vector<D3D12DynamicPage> m_AllocatedPages;
 
     const Uint64 m_PageSize;
+    const bool   m_GPUUpload;
+
+    // The size of the next page to request from the global manager
+    Uint64 m_NextPageSize;
 
     Uint64 m_CurrOffset    = InvalidOffset;
     Uint64 m_AvailableSize = 0;
@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::D3D12PlacedResourceAllocator class
+
+#include <mutex>
+#include <vector>
+#include <memory>
+
+#include "RenderDeviceD3D12.h"
+#include "VariableSizeAllocationsManager.hpp"
+
+namespace Diligent
+{
+
+class D3D12PlacedResourceAllocator;
+struct D3D12PlacedResourceHeap;
+
+// The class represents a suballocation of a placed resource within a D3D12 heap.
+// The allocation is returned to the allocator when the object is destroyed, so
+// it must only be destroyed after the placed resource has been released.
+class D3D12PlacedResourceAllocation
+{
+public:
+    D3D12PlacedResourceAllocation() noexcept {}
+
+    D3D12PlacedResourceAllocation(D3D12PlacedResourceAllocator&                    Allocator,
+                                  D3D12PlacedResourceHeap&                         Heap,
+                                  const VariableSizeAllocationsManager::Allocation& Allocation) noexcept :
+        // clang-format off
+        m_pAllocator{&Allocator},
+        m_pHeap     {&Heap     },
+        m_Allocation{Allocation}
+    // clang-format on
+    {}
+
+    // clang-format off
+    D3D12PlacedResourceAllocation            (const D3D12PlacedResourceAllocation&) = delete;
+    D3D12PlacedResourceAllocation& operator= (const D3D12PlacedResourceAllocation&) = delete;
+    // clang-format on
+
+    D3D12PlacedResourceAllocation(D3D12PlacedResourceAllocation&& rhs) noexcept :
+        // clang-format off
+        m_pAllocator{rhs.m_pAllocator},
+        m_pHeap     {rhs.m_pHeap     },
+        m_Allocation{rhs.m_Allocation}
+    // clang-format on
+    {
+        rhs.Reset();
+    }
+
+    D3D12PlacedResourceAllocation& operator=(D3D12PlacedResourceAllocation&& rhs) noexcept;
+
+    ~D3D12PlacedResourceAllocation();
+
+    bool IsNull() const { return m_pHeap == nullptr; }
+
+private:
+    void Reset()
+    {
+        m_pAllocator = nullptr;
+        m_pHeap      = nullptr;
+        m_Allocation = VariableSizeAllocationsManager::Allocation{};
+    }
+
+    D3D12PlacedResourceAllocator*              m_pAllocator = nullptr;
+    D3D12PlacedResourceHeap*                   m_pHeap      = nullptr;
+    VariableSizeAllocationsManager::Allocation m_Allocation;
+};
+
+
+// Placed resource allocator suballocates default-usage buffers and textures from large D3D12 heaps
+// to avoid creating a separate implicit heap for every committed resource.
+//
+//    m_Heaps[HEAP_CATEGORY_BUFFERS]     | X X X O O X O O |, | X O O O O O O O |
+//    m_Heaps[HEAP_CATEGORY_TEXTURES]    | X X O X X X O X |
+//
+// Buffers and textures are allocated from separate heaps, which is required on resource heap tier 1 hardware.
+// Render targets, depth-stencil buffers and multisampled textures are never placed as they require
+// initialization with Clear, Discard or Copy command before they are used.
+class D3D12PlacedResourceAllocator
+{
+public:
+    D3D12PlacedResourceAllocator(IMemoryAllocator& Allocator,
+                                 ID3D12Device*     pd3d12Device,
+                                 Uint64            HeapSize,
+                                 Uint64            MaxResourceSize);
+    ~D3D12PlacedResourceAllocator();
+
+    // clang-format off
+    D3D12PlacedResourceAllocator            (const D3D12PlacedResourceAllocator&)  = delete;
+    D3D12PlacedResourceAllocator            (      D3D12PlacedResourceAllocator&&) = delete;
+    D3D12PlacedResourceAllocator& operator= (const D3D12PlacedResourceAllocator&)  = delete;
+    D3D12PlacedResourceAllocator& operator= (      D3D12PlacedResourceAllocator&&) = delete;
+    // clang-format on
+
+    // Creates a placed resource in the default heap. Returns false if the resource is not eligible
+    // for placement or could not be created, in which case the caller should create a committed resource.
+    bool CreateResource(const D3D12_RESOURCE_DESC&     d3d12Desc,
+                        D3D12_RESOURCE_STATES          d3d12InitialState,
+                        const D3D12_CLEAR_VALUE*       pClearValue,
+                        CComPtr<ID3D12Resource>&       pd3d12Resource,
+                        D3D12PlacedResourceAllocation& Allocation);
+
+    void GetStats(PlacedResourceHeapStatsD3D12& Stats) const;
+
+private:
+    friend class D3D12PlacedResourceAllocation;
+    void Free(D3D12PlacedResourceHeap& Heap, VariableSizeAllocationsManager::Allocation& Allocation);
+
+    enum HEAP_CATEGORY : Uint32
+    {
+        HEAP_CATEGORY_BUFFERS = 0,
+        HEAP_CATEGORY_TEXTURES,
+        HEAP_CATEGORY_COUNT
+    };
+
+    IMemoryAllocator& m_Allocator;
+    ID3D12Device*     m_pd3d12Device;
+
+    const Uint64 m_HeapSize;
+    const Uint64 m_MaxResourceSize;
+
+    mutable std::mutex                                    m_HeapsMtx;
+    std::vector<std::unique_ptr<D3D12PlacedResourceHeap>> m_Heaps[HEAP_CATEGORY_COUNT];
+
+    Uint32 m_AllocationCount = 0;
+    Uint64 m_UsedSize        = 0;
+    Uint64 m_TotalHeapSize   = 0;
+    Uint64 m_PeakHeapSize    = 0;
+};
+
+} // namespace Diligent
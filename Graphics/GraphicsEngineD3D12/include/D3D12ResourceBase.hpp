@@ -30,6 +30,8 @@
 /// \file
 /// Implementation of the Diligent::D3D12ResourceBase class
 
+#include "ResidencyManagerD3D12.hpp"
+
 namespace Diligent
 {
 
@@ -40,10 +42,29 @@ public:
     D3D12ResourceBase()
     {}
 
+    ~D3D12ResourceBase()
+    {
+        // The entry must be removed before the resource is released
+        if (m_pResidencyEntry != nullptr)
+            m_pResidencyEntry->Mgr.Unregister(m_pResidencyEntry);
+    }
+
     ID3D12Resource* GetD3D12Resource() const { return m_pd3d12Resource; }
 
+    ResidencyManagerD3D12::Entry* GetResidencyEntry() const { return m_pResidencyEntry; }
+
+    /// Marks the resource as referenced by the command list that is being recorded, see Diligent::ResidencyManagerD3D12.
+    void MarkResidencyUsed() const
+    {
+        if (m_pResidencyEntry != nullptr)
+            m_pResidencyEntry->Mgr.MarkUsed(*m_pResidencyEntry);
+    }
+
 protected:
     CComPtr<ID3D12Resource> m_pd3d12Resource; ///< D3D12 resource object
+
+    /// Residency manager entry. Null if the residency of the resource is not tracked.
+    ResidencyManagerD3D12::Entry* m_pResidencyEntry = nullptr;
 };
 
 } // namespace Diligent
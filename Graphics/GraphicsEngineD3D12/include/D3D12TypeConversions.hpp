@@ -81,6 +81,18 @@ D3D12_RESOURCE_STATES     ResourceStateFlagsToD3D12ResourceStates(RESOURCE_STATE
 RESOURCE_STATE            D3D12ResourceStatesToResourceStateFlags(D3D12_RESOURCE_STATES StateFlags);
 D3D12_RESOURCE_STATES     GetSupportedD3D12ResourceStatesForCommandList(D3D12_COMMAND_LIST_TYPE CmdListType);
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+struct D3D12BarrierAccessInfo
+{
+    D3D12_BARRIER_SYNC   Sync   = D3D12_BARRIER_SYNC_NONE;
+    D3D12_BARRIER_ACCESS Access = D3D12_BARRIER_ACCESS_COMMON;
+    D3D12_BARRIER_LAYOUT Layout = D3D12_BARRIER_LAYOUT_UNDEFINED;
+};
+// Converts resource state flags to the enhanced barrier synchronization scope, access and texture layout.
+// Returns false if the state has no precise enhanced barrier equivalent.
+bool ResourceStateFlagsToD3D12BarrierAccessInfo(RESOURCE_STATE StateFlags, bool IsTexture, D3D12BarrierAccessInfo& Info);
+#endif
+
 D3D12_QUERY_HEAP_TYPE QueryTypeToD3D12QueryHeapType(QUERY_TYPE QueryType, HardwareQueueIndex QueueId);
 D3D12_QUERY_TYPE      QueryTypeToD3D12QueryType(QUERY_TYPE QueryType);
 
@@ -44,6 +44,8 @@ public:
 
 protected:
     RefCntAutoPtr<IPipelineResourceSignature> UnpackResourceSignature(const ResourceSignatureUnpackInfo& DeArchiveInfo, bool IsImplicit) override final;
+
+    RefCntAutoPtr<IShader> UnpackShader(const ShaderCreateInfo& ShaderCI, IRenderDevice* pDevice) override final;
 };
 
 } // namespace Diligent
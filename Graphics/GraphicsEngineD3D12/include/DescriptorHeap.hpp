@@ -36,8 +36,14 @@
 #include <string>
 #include <unordered_set>
 #include <atomic>
+#include <array>
+#include <memory>
 
-#include "VariableSizeAllocationsManager.hpp"
+#if DILIGENT_USE_TLSF_ALLOCATIONS_MANAGER
+#    include "TLSFAllocationsManager.hpp"
+#else
+#    include "VariableSizeAllocationsManager.hpp"
+#endif
 
 namespace Diligent
 {
@@ -240,7 +246,8 @@ private:
 
 
 // The class performs suballocations within one D3D12 descriptor heap.
-// It uses VariableSizeAllocationsManager to manage free space in the heap
+// It uses VariableSizeAllocationsManager (or TLSFAllocationsManager if DILIGENT_USE_TLSF_ALLOCATIONS_MANAGER
+// is enabled) to manage free space in the heap
 //
 // |  X  X  X  X  O  O  O  X  X  O  O  X  O  O  O  O  |  D3D12 descriptor heap
 //
@@ -317,6 +324,13 @@ public:
     size_t GetMaxAllocatedSize()       const { return m_MaxAllocatedSize;               }
     // clang-format on
 
+    // Returns the number of currently allocated descriptors
+    Uint32 GetNumAllocatedDescriptors()
+    {
+        std::lock_guard<std::mutex> LockGuard(m_FreeBlockManagerMutex);
+        return static_cast<Uint32>(m_FreeBlockManager.GetUsedSize());
+    }
+
 #ifdef DILIGENT_DEVELOPMENT
     Int32 DvpGetAllocationsCounter() const
     {
@@ -342,8 +356,13 @@ private:
     Uint32 m_NumDescriptorsInAllocation = 0;
 
     // Allocations manager used to handle descriptor allocations within the heap
-    std::mutex                     m_FreeBlockManagerMutex;
-    VariableSizeAllocationsManager m_FreeBlockManager;
+#if DILIGENT_USE_TLSF_ALLOCATIONS_MANAGER
+    using FreeBlockManagerType = TLSFAllocationsManager;
+#else
+    using FreeBlockManagerType = VariableSizeAllocationsManager;
+#endif
+    std::mutex           m_FreeBlockManagerMutex;
+    FreeBlockManagerType m_FreeBlockManager;
 
     // Strong reference to D3D12 descriptor heap object
     CComPtr<ID3D12DescriptorHeap> m_pd3d12DescriptorHeap;
@@ -386,6 +405,11 @@ private:
 // Render device contains four CPUDescriptorHeap object instances (one for each D3D12 heap type). The heaps are accessed
 // when a texture or a buffer view is created.
 //
+// To reduce contention when views are created from many threads, the heap is split into NumShards shards. Every shard
+// has its own pool of descriptor heap managers protected by its own mutex. A thread always allocates from the same
+// shard, while an allocation is always returned to the shard that created it (the shard index is encoded in the
+// allocation manager ID). Heaps of all shards except the first one are created on demand.
+//
 class CPUDescriptorHeap final : public IDescriptorAllocator
 {
 public:
@@ -409,6 +433,9 @@ public:
     virtual void                     Free(DescriptorHeapAllocation&& Allocation, Uint64 CmdQueueMask) override final;
     virtual Uint32                   GetDescriptorSize() const override final { return m_DescriptorSize; }
 
+    // Adds the number of allocated descriptors and the total size of all heaps to the stats
+    void GetStats(DescriptorHeapStats& Stats);
+
 #ifdef DILIGENT_DEVELOPMENT
     int32_t DvpGetTotalAllocationCount();
 #endif
@@ -416,21 +443,33 @@ public:
 private:
     void FreeAllocation(DescriptorHeapAllocation&& Allocation);
 
+    static Uint32 GetThreadShardIndex();
+
     IMemoryAllocator&      m_MemAllocator;
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
-    // Pool of descriptor heap managers
-    std::mutex                                                                                        m_HeapPoolMutex;
-    std::vector<DescriptorHeapAllocationManager, STDAllocatorRawMem<DescriptorHeapAllocationManager>> m_HeapPool;
-    // Indices of available descriptor heap managers
-    std::unordered_set<size_t, std::hash<size_t>, std::equal_to<size_t>, STDAllocatorRawMem<size_t>> m_AvailableHeaps;
+    static constexpr Uint32 NumShards = 8;
 
-    D3D12_DESCRIPTOR_HEAP_DESC m_HeapDesc;
-    const UINT                 m_DescriptorSize = 0;
+    struct HeapShard
+    {
+        HeapShard(const D3D12_DESCRIPTOR_HEAP_DESC& _HeapDesc);
+
+        // Pool of descriptor heap managers
+        std::mutex                                                                                        HeapPoolMutex;
+        std::vector<DescriptorHeapAllocationManager, STDAllocatorRawMem<DescriptorHeapAllocationManager>> HeapPool;
+        // Indices of available descriptor heap managers
+        std::unordered_set<size_t, std::hash<size_t>, std::equal_to<size_t>, STDAllocatorRawMem<size_t>> AvailableHeaps;
+
+        D3D12_DESCRIPTOR_HEAP_DESC HeapDesc;
+
+        // Maximum shard size during the application lifetime - for statistic purposes
+        Uint32 MaxSize     = 0;
+        Uint32 CurrentSize = 0;
+    };
+    std::array<std::unique_ptr<HeapShard>, NumShards> m_Shards;
 
-    // Maximum heap size during the application lifetime - for statistic purposes
-    Uint32 m_MaxSize     = 0;
-    Uint32 m_CurrentSize = 0;
+    const D3D12_DESCRIPTOR_HEAP_TYPE m_HeapType;
+    const UINT                       m_DescriptorSize = 0;
 };
 
 // GPU descriptor heap provides storage for shader-visible descriptors
@@ -508,6 +547,13 @@ public:
     Uint32                            GetMaxStaticDescriptors() const { return m_HeapAllocationManager.GetMaxDescriptors(); }
     Uint32                            GetMaxDynamicDescriptors() const { return m_DynamicAllocationsManager.GetMaxDescriptors(); }
 
+    // Adds the number of allocated static and dynamic descriptors and the heap size to the stats
+    void GetStats(DescriptorHeapStats& Stats)
+    {
+        Stats.Allocated += m_HeapAllocationManager.GetNumAllocatedDescriptors() + m_DynamicAllocationsManager.GetNumAllocatedDescriptors();
+        Stats.Capacity += m_HeapDesc.NumDescriptors;
+    }
+
 #ifdef DILIGENT_DEVELOPMENT
     int32_t DvpGetTotalAllocationCount() const
     {
@@ -202,6 +202,12 @@ public:
     /// Implementation of IDeviceContext::CopyTexture() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override final;
 
+    /// Implementation of IDeviceContext::UpdateTextures() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE UpdateTextures(const UpdateTextureAttribs* pUpdates, Uint32 NumUpdates) override final;
+
+    /// Implementation of IDeviceContext::CopyTextures() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE CopyTextures(const CopyTextureAttribs* pCopies, Uint32 NumCopies) override final;
+
     /// Implementation of IDeviceContext::MapTextureSubresource() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE MapTextureSubresource(ITexture*                 pTexture,
                                                           Uint32                    MipLevel,
@@ -295,6 +301,9 @@ public:
     /// Implementation of IDeviceContextD3D12::ID3D12GraphicsCommandList() in Direct3D12 backend.
     virtual ID3D12GraphicsCommandList* DILIGENT_CALL_TYPE GetD3D12CommandList() override final;
 
+    /// Implementation of IDeviceContextD3D12::ExecuteIndirectCommands() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE ExecuteIndirectCommands(const ExecuteIndirectCommandsAttribsD3D12& Attribs) override final;
+
     /// Implementation of IDeviceContext::SetShadingRate() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE SetShadingRate(SHADING_RATE          BaseRate,
                                                    SHADING_RATE_COMBINER PrimitiveCombiner,
@@ -303,6 +312,18 @@ public:
     /// Implementation of IDeviceContext::BindSparseResourceMemory() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::ResolveQueries() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE ResolveQueries(const ResolveQueriesAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
+    /// Implementation of IDeviceContext::SetDynamicRenderState() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetDynamicRenderState(const DynamicRenderState& State) override final;
+
     void UpdateBufferRegion(class BufferD3D12Impl*         pBuffD3D12,
                             D3D12DynamicAllocation&        Allocation,
                             Uint64                         DstOffset,
@@ -320,6 +341,11 @@ public:
                            Uint32                         DstZ,
                            RESOURCE_STATE_TRANSITION_MODE DstTextureTransitionMode);
 
+    void PrepareTextureCopy(class TextureD3D12Impl&        SrcTexture,
+                            RESOURCE_STATE_TRANSITION_MODE SrcTextureTransitionMode,
+                            class TextureD3D12Impl&        DstTexture,
+                            RESOURCE_STATE_TRANSITION_MODE DstTextureTransitionMode);
+
     void CopyTextureRegion(IBuffer*                       pSrcBuffer,
                            Uint64                         SrcOffset,
                            Uint64                         SrcStride,
@@ -339,6 +365,18 @@ public:
                            const Box&                     DstBox,
                            RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode);
 
+    bool GetTextureCopyDestBarrier(class TextureD3D12Impl&        TextureD3D12,
+                                   Uint32                         DstSubResIndex,
+                                   RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode,
+                                   D3D12_RESOURCE_BARRIER&        BarrierDesc);
+
+    void RecordBufferToTextureCopy(ID3D12Resource*         pd3d12Buffer,
+                                   Uint64                  SrcOffset,
+                                   Uint64                  SrcStride,
+                                   class TextureD3D12Impl& TextureD3D12,
+                                   Uint32                  DstSubResIndex,
+                                   const Box&              DstBox);
+
     void UpdateTextureRegion(const void*                    pSrcData,
                              Uint64                         SrcStride,
                              Uint64                         SrcDepthStride,
@@ -349,7 +387,7 @@ public:
 
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override final;
 
-    D3D12DynamicAllocation AllocateDynamicSpace(Uint64 NumBytes, Uint32 Alignment);
+    D3D12DynamicAllocation AllocateDynamicSpace(Uint64 NumBytes, Uint32 Alignment, bool GPUUpload = false);
 
     size_t GetNumCommandsInCtx() const { return m_State.NumCommands; }
 
@@ -361,6 +399,10 @@ public:
     }
 
 private:
+    // Minimum number of draw items for MultiDraw/MultiDrawIndexed to be executed
+    // with a single ExecuteIndirect instead of individual draw calls.
+    static constexpr Uint32 MultiDrawIndirectThreshold = 8;
+
     void CommitD3D12IndexBuffer(GraphicsContext& GraphCtx, VALUE_TYPE IndexType);
     void CommitD3D12VertexBuffers(GraphicsContext& GraphCtx);
     void CommitRenderTargets(RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
@@ -379,11 +421,14 @@ private:
                                                      RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                      RESOURCE_STATE                 RequiredState,
                                                      const char*                    OperationName);
+    // If pRange is not null and the texture tracks subresource states, only the
+    // subresources in the range are transitioned or verified.
     __forceinline void TransitionOrVerifyTextureState(CommandContext&                CmdCtx,
                                                       TextureD3D12Impl&              Texture,
                                                       RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                       RESOURCE_STATE                 RequiredState,
-                                                      const char*                    OperationName);
+                                                      const char*                    OperationName,
+                                                      const TextureSubresourceRange* pRange = nullptr);
     __forceinline void TransitionOrVerifyBLASState(CommandContext&                CmdCtx,
                                                    BottomLevelASD3D12Impl&        BLAS,
                                                    RESOURCE_STATE_TRANSITION_MODE TransitionMode,
@@ -416,7 +461,7 @@ private:
     __forceinline RootTableInfo& GetRootTableInfo(PIPELINE_TYPE PipelineType);
 
     template <bool IsCompute>
-    __forceinline void CommitRootTablesAndViews(RootTableInfo& RootInfo, Uint32 CommitSRBMask, CommandContext& CmdCtx) const;
+    __forceinline void CommitRootTablesAndViews(RootTableInfo& RootInfo, Uint32 CommitSRBMask, CommandContext& CmdCtx);
 
 #ifdef DILIGENT_DEVELOPMENT
     void DvpValidateCommittedShaderResources(RootTableInfo& RootInfo) const;
@@ -438,6 +483,17 @@ private:
     TextureUploadSpace AllocateTextureUploadSpace(TEXTURE_FORMAT TexFmt,
                                                   const Box&     Region);
 
+    // Computes the layout of the region data in the upload memory and returns the required memory size.
+    static Uint64 GetTextureUploadLayout(TEXTURE_FORMAT      TexFmt,
+                                         const Box&          Region,
+                                         TextureUploadSpace& UploadSpace);
+
+    static void WriteTextureUploadData(const void*               pSrcData,
+                                       Uint64                    SrcStride,
+                                       Uint64                    SrcDepthStride,
+                                       const TextureUploadSpace& UploadSpace,
+                                       void*                     pDstData);
+
 
     friend class SwapChainD3D12Impl;
     inline CommandContext& GetCmdContext()
@@ -481,16 +537,28 @@ private:
 
     D3D12DynamicHeap m_DynamicHeap;
 
+    // Dynamic buffers with any of m_GPUUploadHeapBindFlags are suballocated from this heap
+    // that resides in GPU-local CPU-visible memory. The flags are empty if GPU upload heaps are not supported.
+    D3D12DynamicHeap m_GPUUploadDynamicHeap;
+    const BIND_FLAGS m_GPUUploadHeapBindFlags;
+
     // Every context must use its own allocator that maintains individual list of retired descriptor heaps to
     // avoid interference with other command contexts
     // The allocations in heaps are discarded at the end of the frame.
     DynamicSuballocationsManager m_DynamicGPUDescriptorAllocator[2];
 
+    // Dynamic descriptors committed during this frame. They are allocated from m_DynamicGPUDescriptorAllocator
+    // and are reused when the same resource cache is committed again and its contents have not changed.
+    PipelineResourceSignatureD3D12Impl::CommittedDynamicDescriptorsMap m_CommittedDynamicDescriptors;
+
     FixedBlockMemoryAllocator m_CmdListAllocator;
 
     std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> m_SignalFences;
     std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> m_WaitFences;
 
+    // Command contexts submitted by Flush(), kept to avoid allocating memory on every flush
+    std::vector<RenderDeviceD3D12Impl::PooledCommandContext> m_FlushContexts;
+
     struct MappedTextureKey
     {
         TextureD3D12Impl* const Texture;
@@ -48,6 +48,26 @@ struct PRSSerializerD3D12 : PRSSerializer<Mode>
                                       DynamicLinearAllocator*      Allocator);
 };
 
+// Direct3D12 shaders in the archive store the bytecode along with the serialized
+// shader resources (see ShaderResources::Serialize()) in ShaderCreateInfo::ByteCode,
+// so that the shaders can be unpacked without the bytecode reflection.
+// The data is unpacked by DearchiverD3D12Impl::UnpackShader().
+template <SerializerMode Mode>
+struct ShaderD3D12Serializer
+{
+    template <typename T>
+    using ConstQual = typename Serializer<Mode>::template ConstQual<T>;
+
+    using VoidPtr = typename Serializer<Mode>::VoidPtr;
+
+    // Resources are empty if the shader was serialized without the reflection.
+    static bool SerializeBytecode(Serializer<Mode>&  Ser,
+                                  VoidPtr            pBytecode,
+                                  ConstQual<size_t>& BytecodeSize,
+                                  VoidPtr            pResources,
+                                  ConstQual<size_t>& ResourcesSize);
+};
+
 DECL_TRIVIALLY_SERIALIZABLE(PipelineResourceAttribsD3D12);
 DECL_TRIVIALLY_SERIALIZABLE(ImmutableSamplerAttribsD3D12);
 
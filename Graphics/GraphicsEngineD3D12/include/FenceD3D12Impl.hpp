@@ -58,14 +58,26 @@ public:
     /// Implementation of IFenceD3D12::Wait() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE Wait(Uint64 Value) override final;
 
+    /// Implementation of IFence::WaitWithTimeout() in Direct3D12 backend.
+    virtual Bool DILIGENT_CALL_TYPE WaitWithTimeout(Uint64 Value, Uint64 Timeout) override final;
+
     /// Implementation of IFenceD3D12::GetD3D12Fence().
     virtual ID3D12Fence* DILIGENT_CALL_TYPE GetD3D12Fence() override final { return m_pd3d12Fence; }
 
+    // Returns the auto-reset event that the calling thread uses for timed fence waits.
+    //
+    // An event passed to SetEventOnCompletion() remains registered with the fence until the fence
+    // reaches the value, so an event must not be closed after a wait has timed out. The per-thread
+    // event lives as long as the thread. A stale registration may signal the event later, so the
+    // waiting code must always recheck the fence values after the event is signaled.
+    static HANDLE GetThreadWaitEvent();
+
+    // Converts the timeout in nanoseconds to the timeout of WaitForSingleObject(), rounding it up
+    static DWORD TimeoutToMilliseconds(Uint64 Timeout);
+
 private:
     /// Access to the fence internal data is thread safe.
     CComPtr<ID3D12Fence> m_pd3d12Fence; ///< D3D12 Fence object
-
-    const HANDLE m_FenceCompleteEvent;
 };
 
 } // namespace Diligent
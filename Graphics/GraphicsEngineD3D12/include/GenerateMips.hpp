@@ -48,6 +48,11 @@
 /// \file
 /// Implementation of mipmap generation routines
 
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+#include "AsyncInitializer.hpp"
 
 namespace Diligent
 {
@@ -55,11 +60,27 @@ namespace Diligent
 class GenerateMipsHelper
 {
 public:
-    GenerateMipsHelper(ID3D12Device* pd3d12Device);
+    explicit GenerateMipsHelper(ID3D12Device* pd3d12Device);
+    ~GenerateMipsHelper();
+
+    // Creates the pipeline states. If pThreadPool is not null, the pipeline states are created asynchronously
+    // and the first GenerateMips() call waits for them. If the method is not called, the pipeline states
+    // are created by the first GenerateMips() call.
+    void Initialize(IThreadPool* pThreadPool) noexcept(false);
 
-    void GenerateMips(ID3D12Device* pd3d12Device, class TextureViewD3D12Impl* pTexView, class CommandContext& Ctx) const;
+    void GenerateMips(class TextureViewD3D12Impl* pTexView, class CommandContext& Ctx);
+
+private:
+    void CreatePipelineStates() noexcept(false);
 
 private:
+    CComPtr<ID3D12Device> m_pd3d12Device;
+
+    std::mutex        m_InitMtx;
+    std::atomic<bool> m_Initialized{false};
+
+    std::unique_ptr<AsyncInitializer> m_AsyncInitializer;
+
     CComPtr<ID3D12RootSignature> m_pGenerateMipsRS;
     CComPtr<ID3D12PipelineState> m_pGenerateMipsLinearPSO[4];
     CComPtr<ID3D12PipelineState> m_pGenerateMipsGammaPSO[4];
@@ -31,6 +31,7 @@
 /// Declaration of Diligent::PipelineResourceSignatureD3D12Impl class
 
 #include <array>
+#include <unordered_map>
 
 #include "EngineD3D12ImplTraits.hpp"
 #include "PipelineResourceAttribsD3D12.hpp"
@@ -143,6 +144,17 @@ public:
     // Make the base class method visible
     using TPipelineResourceSignatureBase::CopyStaticResources;
 
+    // GPU-visible copies of the dynamic descriptors of a resource cache committed by a device context.
+    // The copies remain valid until the end of the frame, so they are reused when the same cache
+    // is committed again and its contents have not changed.
+    struct CommittedDynamicDescriptors
+    {
+        std::array<DescriptorHeapAllocation, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1> Allocations;
+    };
+    // Committed dynamic descriptors, indexed by the resource cache revision.
+    // Revisions are unique across all caches and change whenever a descriptor changes.
+    using CommittedDynamicDescriptorsMap = std::unordered_map<Uint32, CommittedDynamicDescriptors>;
+
     struct CommitCacheResourcesAttribs
     {
         ID3D12Device* const             pd3d12Device;
@@ -151,6 +163,10 @@ public:
         const bool                      IsCompute;
         const ShaderResourceCacheD3D12* pResourceCache = nullptr;
         Uint32                          BaseRootIndex  = ~0u;
+        // If not null, dynamic descriptors are reused from/stored in this map
+        CommittedDynamicDescriptorsMap* pCommittedDynamicDescriptors = nullptr;
+        // If not null, the size of the copied dynamic descriptors is added to this value
+        Uint64* pDescriptorBytesCopied = nullptr;
     };
     void CommitRootTables(const CommitCacheResourcesAttribs& CommitAttribs) const;
 
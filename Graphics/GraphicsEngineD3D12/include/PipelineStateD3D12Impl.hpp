@@ -105,7 +105,8 @@ public:
         class IDXCompiler*                                       pDxCompiler,
         LocalRootSignatureD3D12*                                 pLocalRootSig             = nullptr,
         const TValidateShaderResourcesFn&                        ValidateShaderResourcesFn = {},
-        const TValidateShaderBindingsFn&                         VlidateBindingsFn         = {}) noexcept(false);
+        const TValidateShaderBindingsFn&                         VlidateBindingsFn         = {},
+        IThreadPool*                                             pThreadPool               = nullptr) noexcept(false);
 
     static PipelineResourceSignatureDescWrapper GetDefaultResourceSignatureDesc(
         const TShaderStages&              ShaderStages,
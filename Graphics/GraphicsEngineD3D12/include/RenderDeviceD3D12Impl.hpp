@@ -42,6 +42,8 @@
 #include "CommandListManager.hpp"
 #include "CommandContext.hpp"
 #include "D3D12DynamicHeap.hpp"
+#include "D3D12PlacedResourceAllocator.hpp"
+#include "ResidencyManagerD3D12.hpp"
 #include "GenerateMips.hpp"
 #include "DXCompiler.hpp"
 #include "RootSignature.hpp"
@@ -108,6 +110,12 @@ public:
                                                  IShader**               ppShader,
                                                  IDataBlob**             ppCompilerOutput) override final;
 
+    /// Creates the shader from the bytecode using the serialized shader resources instead of the
+    /// bytecode reflection, see ShaderResources::Serialize().
+    void CreateShader(const ShaderCreateInfo& ShaderCreateInfo,
+                      const SerializedData&   SerializedResources,
+                      IShader**               ppShader);
+
     /// Implementation of IRenderDevice::CreateTexture() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CreateTexture(const TextureDesc& TexDesc,
                                                   const TextureData* pData,
@@ -200,6 +208,16 @@ public:
                                                               RESOURCE_STATE        InitialState,
                                                               ITopLevelAS**         ppTLAS) override final;
 
+    /// Implementation of IRenderDeviceD3D12::GetPlacedResourceHeapStats().
+    virtual void DILIGENT_CALL_TYPE GetPlacedResourceHeapStats(PlacedResourceHeapStatsD3D12& Stats) const override final
+    {
+        m_PlacedResourceAllocator.GetStats(Stats);
+    }
+
+    /// Implementation of IRenderDeviceD3D12::SetResidencyPriority().
+    virtual void DILIGENT_CALL_TYPE SetResidencyPriority(IDeviceObject*           pResource,
+                                                         D3D12_RESIDENCY_PRIORITY Priority) override final;
+
     void CreateRootSignature(const RefCntAutoPtr<class PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount, size_t Hash, RootSignatureD3D12** ppRootSig);
 
     RootSignatureCacheD3D12& GetRootSignatureCache() { return m_RootSignatureCache; }
@@ -210,6 +228,12 @@ public:
     /// Implementation of IRenderDevice::IdleGPU() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
+    /// Implementation of IRenderDevice::WaitForFences() in Direct3D12 backend.
+    virtual Bool DILIGENT_CALL_TYPE WaitForFences(const WaitForFencesAttribs& Attribs) override final;
+
+    /// Implementation of IRenderDevice::GetMemoryStats() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE GetMemoryStats(DeviceMemoryStats& Stats) override final;
+
     D3D12_COMMAND_LIST_TYPE GetCommandQueueType(SoftwareQueueIndex CmdQueueInd) const
     {
         return GetCommandQueue(CmdQueueInd).GetD3D12CommandQueueDesc().Type;
@@ -233,6 +257,11 @@ public:
     // Disposes an unused command context
     void DisposeCommandContext(PooledCommandContext&& Ctx);
 
+    // Submits the command lists batched by the command queue (see EngineD3D12CreateInfo::SubmitBatchSize)
+    // and returns the command contexts that recorded them to the pool.
+    void FlushBatchedSubmits(SoftwareQueueIndex CommandQueueId);
+    void FlushBatchedSubmits();
+
     void FlushStaleResources(SoftwareQueueIndex CommandQueueId);
 
     /// Implementation of IRenderDevice::() in Direct3D12 backend.
@@ -240,13 +269,18 @@ public:
 
     D3D12DynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
+    D3D12PlacedResourceAllocator& GetPlacedResourceAllocator() { return m_PlacedResourceAllocator; }
+
+    // Returns null if residency management is disabled, see EngineD3D12CreateInfo::EnableResidencyManagement.
+    ResidencyManagerD3D12* GetResidencyManager() { return m_pResidencyMgr.get(); }
+
     GPUDescriptorHeap& GetGPUDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE Type)
     {
         VERIFY_EXPR(Type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || Type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
         return m_GPUDescriptorHeaps[Type];
     }
 
-    const GenerateMipsHelper& GetMipsGenerator() const { return m_MipsGenerator; }
+    GenerateMipsHelper& GetMipsGenerator() { return m_MipsGenerator; }
 
     IDXCompiler* GetDxCompiler() const { return m_pDxCompiler.get(); }
 
@@ -279,6 +313,10 @@ private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
     void         FreeCommandContext(PooledCommandContext&& Ctx);
 
+    // Returns the context to the pool once its command list is no longer batched by the command queue.
+    void FreeSubmittedCommandContext(SoftwareQueueIndex CommandQueueId, PooledCommandContext&& Ctx);
+    void ReleaseBatchedCommandContexts(SoftwareQueueIndex CommandQueueId);
+
     CommandListManager& GetCmdListManager(SoftwareQueueIndex CommandQueueId);
     CommandListManager& GetCmdListManager(D3D12_COMMAND_LIST_TYPE CmdListType);
 
@@ -292,12 +330,21 @@ private:
 
     std::mutex                                                             m_ContextPoolMutex;
     std::unordered_multimap<D3D12_COMMAND_LIST_TYPE, PooledCommandContext> m_ContextPool;
+
+    // Contexts whose command lists may not have been executed by the command queue yet.
+    // A closed command list must not be reset until it is executed.
+    std::mutex                                                       m_BatchedCtxMutex;
+    std::vector<std::pair<SoftwareQueueIndex, PooledCommandContext>> m_BatchedCtxs;
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int m_AllocatedCtxCounter{0};
 #endif
 
     D3D12DynamicMemoryManager m_DynamicMemoryManager;
 
+    D3D12PlacedResourceAllocator m_PlacedResourceAllocator;
+
+    std::unique_ptr<ResidencyManagerD3D12> m_pResidencyMgr;
+
     // Note: mips generator must be released after the device has been idled
     GenerateMipsHelper m_MipsGenerator;
 
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ResidencyManagerD3D12 class
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <deque>
+#include <unordered_set>
+
+#include "WinHPreface.h"
+#include <dxgi1_4.h>
+#include "WinHPostface.h"
+
+#include "RenderDeviceD3D12.h"
+
+namespace Diligent
+{
+
+class RenderDeviceD3D12Impl;
+
+// Residency manager keeps the video memory usage within the budget reported by the OS.
+// Every committed buffer and texture is registered with the manager and is stamped with the
+// index of the frame in which it was last referenced by a command list. When the usage exceeds
+// the budget, the manager evicts the least recently used resources that are no longer referenced
+// by the GPU. An evicted resource is made resident again before the next command list is submitted
+// after the resource has been referenced.
+//
+//   Context thread:                          Residency manager (Update):
+//     LastUsedFrame = CurrentFrame             Entry.EvictionRequested = true
+//     if (Entry.EvictionRequested)             if (Entry.LastUsedFrame < SafeFrame)
+//         RequestMakeResident()                    Evict()
+//
+// The two sides are ordered by sequentially consistent atomics so that a resource that is being
+// referenced by a command list is either not evicted or is queued to be made resident before submission.
+class ResidencyManagerD3D12
+{
+public:
+    struct Entry
+    {
+        Entry(ResidencyManagerD3D12& _Mgr, ID3D12Pageable* _pPageable, Uint64 _Size) noexcept :
+            // clang-format off
+            Mgr      {_Mgr      },
+            pPageable{_pPageable},
+            Size     {_Size     }
+        // clang-format on
+        {}
+
+        ResidencyManagerD3D12& Mgr;
+        ID3D12Pageable* const  pPageable;
+        const Uint64           Size;
+
+        std::atomic<Uint64> LastUsedFrame{0};
+        std::atomic<bool>   EvictionRequested{false};
+
+        // The members below are protected by the manager's mutex
+        D3D12_RESIDENCY_PRIORITY Priority            = D3D12_RESIDENCY_PRIORITY_NORMAL;
+        bool                     Evicted             = false;
+        bool                     MakeResidentPending = false;
+    };
+
+    ResidencyManagerD3D12(RenderDeviceD3D12Impl& Device, Uint32 EvictionFrameThreshold);
+    ~ResidencyManagerD3D12();
+
+    // clang-format off
+    ResidencyManagerD3D12            (const ResidencyManagerD3D12&)  = delete;
+    ResidencyManagerD3D12            (      ResidencyManagerD3D12&&) = delete;
+    ResidencyManagerD3D12& operator= (const ResidencyManagerD3D12&)  = delete;
+    ResidencyManagerD3D12& operator= (      ResidencyManagerD3D12&&) = delete;
+    // clang-format on
+
+    // Starts tracking the residency of a committed resource.
+    Entry* Register(ID3D12Resource* pd3d12Resource);
+
+    // Stops tracking the resource. Must be called before the resource is released.
+    void Unregister(Entry* pEntry);
+
+    // Marks the resource as referenced by a command list that is being recorded.
+    void MarkUsed(Entry& E)
+    {
+        E.LastUsedFrame.store(m_CurrentFrame.load(std::memory_order_relaxed));
+        if (E.EvictionRequested.load())
+            RequestMakeResident(E);
+    }
+
+    void SetPriority(Entry& E, D3D12_RESIDENCY_PRIORITY Priority);
+
+    // Makes resident all evicted resources that have been referenced since they were evicted.
+    // Must be called before command lists are submitted to a queue.
+    void MakeResidentPending();
+
+    // Ends the current frame and evicts resources if the video memory usage exceeds the budget.
+    void Update();
+
+private:
+    void RequestMakeResident(Entry& E);
+
+    RenderDeviceD3D12Impl& m_Device;
+    CComPtr<IDXGIAdapter3> m_pDXGIAdapter;
+    const Uint32           m_EvictionFrameThreshold;
+
+    std::atomic<Uint64> m_CurrentFrame{1};
+
+    std::mutex                 m_Mtx;
+    std::unordered_set<Entry*> m_Entries;
+    std::vector<Entry*>        m_PendingEntries;
+    std::atomic<Uint32>        m_NumPendingEntries{0};
+
+    struct FrameFenceValues
+    {
+        Uint64              Frame;
+        std::vector<Uint64> NextFenceValues;
+    };
+    // Frames that may still be executed by the GPU
+    std::deque<FrameFenceValues> m_InFlightFrames;
+
+    // The last frame whose commands have been completed by the GPU
+    Uint64 m_CompletedFrame = 0;
+};
+
+} // namespace Diligent
@@ -51,9 +51,17 @@ public:
     {
         const ShaderVersion MaxShaderVersion;
 
-        CreateInfo(const TShaderBase::CreateInfo& _BaseCreateInfo, ShaderVersion _MaxShaderVersion) :
+        // Optional shader resources serialized by ShaderResources::Serialize() that are used
+        // instead of the bytecode reflection. The data must be valid until the shader is initialized,
+        // which happens synchronously when the shader is created from the bytecode.
+        const SerializedData* const pSerializedResources;
+
+        CreateInfo(const TShaderBase::CreateInfo& _BaseCreateInfo,
+                   ShaderVersion                  _MaxShaderVersion,
+                   const SerializedData*          _pSerializedResources = nullptr) :
             TShaderBase::CreateInfo{_BaseCreateInfo},
-            MaxShaderVersion{_MaxShaderVersion}
+            MaxShaderVersion{_MaxShaderVersion},
+            pSerializedResources{_pSerializedResources}
         {}
     };
     ShaderD3D12Impl(IReferenceCounters*     pRefCounters,
@@ -104,6 +104,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "Shader.h"
 #include "DescriptorHeap.hpp"
@@ -264,11 +265,58 @@ public:
                                 Uint32     OffsetFromTableStart,
                                 Resource&& SrcRes);
 
-    // Copies the resource to the given root index and offset from the table start
-    const Resource& CopyResource(ID3D12Device*   pd3d12Device,
-                                 Uint32          RootIndex,
-                                 Uint32          OffsetFromTableStart,
-                                 const Resource& SrcRes);
+    // Accumulates descriptor copies and issues them with a single ID3D12Device::CopyDescriptors()
+    // call per heap type. Source and destination descriptors that immediately follow the
+    // previous ones are merged into a single range.
+    class DescriptorCopyBatch
+    {
+    public:
+        explicit DescriptorCopyBatch(ID3D12Device* pd3d12Device);
+        ~DescriptorCopyBatch();
+
+        // clang-format off
+        DescriptorCopyBatch             (const DescriptorCopyBatch&) = delete;
+        DescriptorCopyBatch& operator = (const DescriptorCopyBatch&) = delete;
+        // clang-format on
+
+        void Add(D3D12_DESCRIPTOR_HEAP_TYPE  HeapType,
+                 D3D12_CPU_DESCRIPTOR_HANDLE DstHandle,
+                 D3D12_CPU_DESCRIPTOR_HANDLE SrcHandle);
+
+        // Copies all accumulated descriptors
+        void Flush();
+
+    private:
+        struct DescriptorRanges
+        {
+            std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> Starts;
+            std::vector<UINT>                        Sizes;
+
+            void Add(D3D12_CPU_DESCRIPTOR_HANDLE Handle, UINT DescriptorSize);
+            void Clear();
+        };
+
+        struct HeapTypeBatch
+        {
+            DescriptorRanges Dst;
+            DescriptorRanges Src;
+
+            UINT NumDescriptors = 0;
+            UINT DescriptorSize = 0;
+        };
+
+        ID3D12Device* const m_pd3d12Device;
+
+        std::array<HeapTypeBatch, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1> m_Batches;
+    };
+
+    // Copies the resource to the given root index and offset from the table start.
+    // If pCopyBatch is not null, the descriptor copy is deferred until the batch is flushed.
+    const Resource& CopyResource(ID3D12Device*        pd3d12Device,
+                                 Uint32               RootIndex,
+                                 Uint32               OffsetFromTableStart,
+                                 const Resource&      SrcRes,
+                                 DescriptorCopyBatch* pCopyBatch = nullptr);
 
     // Resets the resource at the given root index and offset from the table start to default state
     const Resource& ResetResource(Uint32 RootIndex,
@@ -331,6 +379,9 @@ public:
     // Transitions all resources in the cache
     void TransitionResourceStates(CommandContext& Ctx, StateTransitionMode Mode);
 
+    // Marks all buffers and textures in the cache as referenced by the command list, see ResidencyManagerD3D12.
+    void MarkResidencyUsed() const;
+
     ResourceCacheContentType GetContentType() const { return m_ContentType; }
 
     // Returns the bitmask indicating root views with bound dynamic buffers (including buffer ranges)
@@ -123,6 +123,9 @@ public:
 
     IObject& GetOwner() { return m_Owner; }
 
+    using TBase::GetSignature;
+    using TBase::GetResourceCache;
+
 private:
     friend TBase;
     friend ShaderVariableD3D12Impl;
@@ -78,6 +78,9 @@ public:
 
     D3D12_RESOURCE_DESC GetD3D12TextureDesc() const;
 
+    // Returns true if the resource is suballocated from a shared heap, see D3D12PlacedResourceAllocator.
+    bool IsPlaced() const { return !m_PlacedAllocation.IsNull(); }
+
     const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& GetStagingFootprint(Uint32 Subresource)
     {
         VERIFY_EXPR(m_StagingFootprints != nullptr);
@@ -101,6 +104,9 @@ protected:
     void InitSparseProperties();
 
     D3D12_PLACED_SUBRESOURCE_FOOTPRINT* m_StagingFootprints = nullptr;
+
+    // Heap suballocation of a placed texture. Null for committed textures.
+    D3D12PlacedResourceAllocation m_PlacedAllocation;
 };
 
 } // namespace Diligent
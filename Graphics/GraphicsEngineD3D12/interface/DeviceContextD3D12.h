@@ -39,6 +39,84 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static DILIGENT_CONSTEXPR INTERFACE_ID IID_DeviceContextD3D12 =
     {0xdde9e3ab, 0x5109, 0x4026, {0x92, 0xb7, 0xf5, 0xe7, 0xec, 0x83, 0xe2, 0x1e}};
 
+/// Flags that indicate which pipeline states are modified by the arguments
+/// of an application-provided Direct3D12 command signature.
+DILIGENT_TYPED_ENUM(INDIRECT_COMMAND_STATE_FLAGS_D3D12, Uint8)
+{
+    /// The command signature only contains a draw or dispatch argument.
+    INDIRECT_COMMAND_STATE_FLAG_D3D12_NONE           = 0u,
+
+    /// The command signature contains D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW arguments.
+    INDIRECT_COMMAND_STATE_FLAG_D3D12_VERTEX_BUFFERS = 1u << 0u,
+
+    /// The command signature contains D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW argument.
+    INDIRECT_COMMAND_STATE_FLAG_D3D12_INDEX_BUFFER   = 1u << 1u,
+
+    /// The command signature contains root constant or root descriptor arguments.
+    INDIRECT_COMMAND_STATE_FLAG_D3D12_ROOT_ARGUMENTS = 1u << 2u,
+
+    INDIRECT_COMMAND_STATE_FLAG_D3D12_LAST           = INDIRECT_COMMAND_STATE_FLAG_D3D12_ROOT_ARGUMENTS
+};
+DEFINE_FLAG_ENUM_OPERATORS(INDIRECT_COMMAND_STATE_FLAGS_D3D12)
+
+
+/// Describes the arguments of IDeviceContextD3D12::ExecuteIndirectCommands().
+struct ExecuteIndirectCommandsAttribsD3D12
+{
+    /// Direct3D12 command signature that describes the layout of the commands in the arguments buffer.
+
+    /// The signature may contain any combination of vertex buffer view, index buffer view,
+    /// root constant and root descriptor arguments followed by a draw, indexed draw, mesh
+    /// or dispatch argument. If the signature contains root arguments, it must be created
+    /// with the root signature of the pipeline state that is currently bound to the context
+    /// (see IPipelineStateD3D12::GetD3D12RootSignature()).
+    ID3D12CommandSignature* pCommandSignature DEFAULT_INITIALIZER(nullptr);
+
+    /// A pointer to the buffer that contains the commands.
+    IBuffer* pArgsBuffer DEFAULT_INITIALIZER(nullptr);
+
+    /// The offset from the beginning of the arguments buffer to the first command.
+    Uint64 ArgsByteOffset DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE ArgsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// The maximum number of commands to execute.
+
+    /// When counter buffer is not null, the actual number of commands is
+    /// the minimum of this value and the value in the counter buffer.
+    Uint32 MaxCommandCount DEFAULT_INITIALIZER(1);
+
+    /// Pipeline states modified by the command signature arguments, see Diligent::INDIRECT_COMMAND_STATE_FLAGS_D3D12.
+
+    /// The engine does not commit the states that are set by the commands and
+    /// invalidates its internal tracking of these states after the commands are executed.
+    INDIRECT_COMMAND_STATE_FLAGS_D3D12 ModifiedStates DEFAULT_INITIALIZER(INDIRECT_COMMAND_STATE_FLAG_D3D12_NONE);
+
+    /// The type of the elements in the index buffer bound to the context.
+
+    /// If the command signature contains an indexed draw argument, but does not contain
+    /// an index buffer view argument, this member must specify the index type (VT_UINT16 or VT_UINT32)
+    /// of the index buffer that was set by IDeviceContext::SetIndexBuffer().
+    /// Otherwise, it must be VT_UNDEFINED.
+    VALUE_TYPE IndexType DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// A pointer to the optional buffer that contains the number of commands to execute
+    /// as a Uint32 value at offset CounterOffset.
+    IBuffer* pCounterBuffer DEFAULT_INITIALIZER(nullptr);
+
+    /// The offset from the beginning of the counter buffer to the command count value.
+    Uint64 CounterOffset DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the counter buffer.
+    RESOURCE_STATE_TRANSITION_MODE CounterBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS. Ignored by compute pipelines.
+    DRAW_FLAGS Flags DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+};
+typedef struct ExecuteIndirectCommandsAttribsD3D12 ExecuteIndirectCommandsAttribsD3D12;
+
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextD3D12
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -85,6 +163,26 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextD3D12, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL ID3D12GraphicsCommandList* METHOD(GetD3D12CommandList)(THIS) PURE;
+
+    /// Executes GPU-generated commands described by an application-provided Direct3D12 command signature.
+
+    /// \param [in] Attribs - Command execution attributes, see Diligent::ExecuteIndirectCommandsAttribsD3D12.
+    ///
+    /// \remarks  Unlike IDeviceContext::DrawIndexedIndirect(), which can only source draw arguments
+    ///           from the buffer, this method allows every command to also change vertex buffers,
+    ///           the index buffer and root arguments. This lets GPU culling emit heterogeneous
+    ///           draws without any CPU involvement.
+    ///
+    ///           The method commits the currently bound pipeline state and shader resources
+    ///           (as well as vertex and index buffers not modified by the commands) the same way
+    ///           a regular draw or dispatch command does. The pipeline type determines whether
+    ///           the commands are executed on the graphics or the compute root signature.
+    ///
+    ///           Since the engine does not track the buffers referenced by the commands,
+    ///           an application is responsible for transitioning them to the required states
+    ///           (e.g. using IDeviceContext::TransitionResourceStates()).
+    VIRTUAL void METHOD(ExecuteIndirectCommands)(THIS_
+                                                 const ExecuteIndirectCommandsAttribsD3D12 REF Attribs) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -94,9 +192,10 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IDeviceContextD3D12_TransitionTextureState(This, ...) CALL_IFACE_METHOD(DeviceContextD3D12, TransitionTextureState,This, __VA_ARGS__)
-#    define IDeviceContextD3D12_TransitionBufferState(This, ...)  CALL_IFACE_METHOD(DeviceContextD3D12, TransitionBufferState, This, __VA_ARGS__)
-#    define IDeviceContextD3D12_GetD3D12CommandList(This)         CALL_IFACE_METHOD(DeviceContextD3D12, GetD3D12CommandList,   This)
+#    define IDeviceContextD3D12_TransitionTextureState(This, ...)  CALL_IFACE_METHOD(DeviceContextD3D12, TransitionTextureState,  This, __VA_ARGS__)
+#    define IDeviceContextD3D12_TransitionBufferState(This, ...)   CALL_IFACE_METHOD(DeviceContextD3D12, TransitionBufferState,   This, __VA_ARGS__)
+#    define IDeviceContextD3D12_GetD3D12CommandList(This)          CALL_IFACE_METHOD(DeviceContextD3D12, GetD3D12CommandList,     This)
+#    define IDeviceContextD3D12_ExecuteIndirectCommands(This, ...) CALL_IFACE_METHOD(DeviceContextD3D12, ExecuteIndirectCommands, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -47,6 +47,26 @@ static DILIGENT_CONSTEXPR INTERFACE_ID IID_RenderDeviceD3D12 =
 
 // clang-format off
 
+/// Placed resource heap statistics, see IRenderDeviceD3D12::GetPlacedResourceHeapStats().
+struct PlacedResourceHeapStatsD3D12
+{
+    /// The number of D3D12 heaps that placed resources are suballocated from.
+    Uint32 HeapCount       DEFAULT_INITIALIZER(0);
+
+    /// The number of live placed resources.
+    Uint32 AllocationCount DEFAULT_INITIALIZER(0);
+
+    /// The total size of all heaps, in bytes.
+    Uint64 HeapSize        DEFAULT_INITIALIZER(0);
+
+    /// The total size of all placed resources, in bytes.
+    Uint64 UsedSize        DEFAULT_INITIALIZER(0);
+
+    /// The peak total size of all heaps during the device lifetime, in bytes.
+    Uint64 PeakHeapSize    DEFAULT_INITIALIZER(0);
+};
+typedef struct PlacedResourceHeapStatsD3D12 PlacedResourceHeapStatsD3D12;
+
 /// Exposes Direct3D12-specific functionality of a render device.
 DILIGENT_BEGIN_INTERFACE(IRenderDeviceD3D12, IRenderDevice)
 {
@@ -117,6 +137,26 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceD3D12, IRenderDevice)
                                                    const TopLevelASDesc REF Desc,
                                                    RESOURCE_STATE           InitialState,
                                                    ITopLevelAS**            ppTLAS) PURE;
+
+    /// Returns the statistics of the heaps that placed buffers and textures are suballocated from.
+
+    /// \param [out] Stats - Placed resource heap statistics.
+    ///
+    /// \remarks   See EngineD3D12CreateInfo::PlacedResourceMaxSize.
+    VIRTUAL void METHOD(GetPlacedResourceHeapStats)(THIS_
+                                                    PlacedResourceHeapStatsD3D12 REF Stats) CONST PURE;
+
+    /// Sets the residency priority of a buffer or a texture.
+
+    /// \param [in] pResource - Pointer to the buffer or texture.
+    /// \param [in] Priority  - Residency priority, see ID3D12Device1::SetResidencyPriority.
+    ///
+    /// \remarks   When residency management is enabled (see EngineD3D12CreateInfo::EnableResidencyManagement),
+    ///            resources with lower priority are evicted first.
+    ///            Placed resources share the priority of their heap and are not affected.
+    VIRTUAL void METHOD(SetResidencyPriority)(THIS_
+                                              IDeviceObject*           pResource,
+                                              D3D12_RESIDENCY_PRIORITY Priority) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -131,6 +171,8 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceD3D12_CreateBufferFromD3DResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceD3D12, CreateBufferFromD3DResource,  This, __VA_ARGS__)
 #    define IRenderDeviceD3D12_CreateBLASFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateBLASFromD3DResource,    This, __VA_ARGS__)
 #    define IRenderDeviceD3D12_CreateTLASFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateTLASFromD3DResource,    This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_GetPlacedResourceHeapStats(This, ...)   CALL_IFACE_METHOD(RenderDeviceD3D12, GetPlacedResourceHeapStats,   This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_SetResidencyPriority(This, ...)         CALL_IFACE_METHOD(RenderDeviceD3D12, SetResidencyPriority,         This, __VA_ARGS__)
 
 // clang-format on
 
@@ -173,13 +173,26 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                 D3D12_HEAP_FLAG_CREATE_NOT_ZEROED :
                 D3D12_HEAP_FLAG_NONE;
 
-            auto hr = pd3d12Device->CreateCommittedResource(
-                &HeapProps, d3d12HeapFlags, &d3d12BuffDesc, d3d12State,
-                nullptr, // pOptimizedClearValue
-                __uuidof(m_pd3d12Resource),
-                reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
-            if (FAILED(hr))
-                LOG_ERROR_AND_THROW("Failed to create D3D12 buffer");
+            // Small default-heap buffers are suballocated from shared heaps
+            const auto IsPlaced = HeapProps.Type == D3D12_HEAP_TYPE_DEFAULT &&
+                pRenderDeviceD3D12->GetPlacedResourceAllocator().CreateResource(d3d12BuffDesc, d3d12State, nullptr, m_pd3d12Resource, m_PlacedAllocation);
+
+            HRESULT hr = S_OK;
+            if (!IsPlaced)
+            {
+                hr = pd3d12Device->CreateCommittedResource(
+                    &HeapProps, d3d12HeapFlags, &d3d12BuffDesc, d3d12State,
+                    nullptr, // pOptimizedClearValue
+                    __uuidof(m_pd3d12Resource),
+                    reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+                if (FAILED(hr))
+                    LOG_ERROR_AND_THROW("Failed to create D3D12 buffer");
+
+                // Only buffers in the default heap use video memory
+                auto* pResidencyMgr = pRenderDeviceD3D12->GetResidencyManager();
+                if (pResidencyMgr != nullptr && HeapProps.Type == D3D12_HEAP_TYPE_DEFAULT)
+                    m_pResidencyEntry = pResidencyMgr->Register(m_pd3d12Resource);
+            }
 
             if (*m_Desc.Name != 0)
                 m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
@@ -341,6 +354,9 @@ BufferD3D12Impl::~BufferD3D12Impl()
 {
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Resource), m_Desc.ImmediateContextMask);
+    // Heap memory of a placed buffer must be released after the buffer itself
+    if (!m_PlacedAllocation.IsNull())
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_PlacedAllocation), m_Desc.ImmediateContextMask);
 }
 
 void BufferD3D12Impl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, IBufferView** ppView, bool bIsDefaultView)
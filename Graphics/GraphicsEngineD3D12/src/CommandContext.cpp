@@ -56,8 +56,17 @@ namespace Diligent
 
 CommandContext::CommandContext(CommandListManager& CmdListManager) :
     m_PendingResourceBarriers(STD_ALLOCATOR_RAW_MEM(D3D12_RESOURCE_BARRIER, GetRawAllocator(), "Allocator for vector<D3D12_RESOURCE_BARRIER>"))
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    ,
+    m_PendingBufferBarriers(STD_ALLOCATOR_RAW_MEM(D3D12_BUFFER_BARRIER, GetRawAllocator(), "Allocator for vector<D3D12_BUFFER_BARRIER>")),
+    m_PendingTextureBarriers(STD_ALLOCATOR_RAW_MEM(D3D12_TEXTURE_BARRIER, GetRawAllocator(), "Allocator for vector<D3D12_TEXTURE_BARRIER>"))
+#endif
 {
     m_PendingResourceBarriers.reserve(32);
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    m_PendingBufferBarriers.reserve(16);
+    m_PendingTextureBarriers.reserve(16);
+#endif
     CmdListManager.CreateNewCommandList(&m_pCommandList, &m_pCurrentAllocator, m_MaxInterfaceVer);
 }
 
@@ -74,7 +83,7 @@ void CommandContext::Reset(CommandListManager& CmdListManager)
     VERIFY_EXPR(m_pCommandList->GetType() == CmdListManager.GetCommandListType());
     if (!m_pCurrentAllocator)
     {
-        CmdListManager.RequestAllocator(&m_pCurrentAllocator);
+        CmdListManager.RequestAllocator(&m_pCurrentAllocator, &m_AllocatorRing);
         // Unlike ID3D12CommandAllocator::Reset, ID3D12GraphicsCommandList::Reset can be called while the
         // command list is still being executed. A typical pattern is to submit a command list and then
         // immediately reset it to reuse the allocated memory for another command list.
@@ -85,7 +94,12 @@ void CommandContext::Reset(CommandListManager& CmdListManager)
     m_pCurGraphicsRootSignature = nullptr;
     m_pCurComputeRootSignature  = nullptr;
     m_PendingResourceBarriers.clear();
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    m_PendingBufferBarriers.clear();
+    m_PendingTextureBarriers.clear();
+#endif
     m_BoundDescriptorHeaps = ShaderDescriptorHeaps{};
+    m_NumBarriers          = 0;
 
     m_DynamicGPUDescriptorAllocators = nullptr;
 
@@ -116,6 +130,19 @@ void CommandContext::TransitionResource(TextureD3D12Impl& TexD3D12, RESOURCE_STA
     TransitionResource(TexD3D12, StateTransitionDesc{&TexD3D12, RESOURCE_STATE_UNKNOWN, NewState, STATE_TRANSITION_FLAG_UPDATE_STATE});
 }
 
+void CommandContext::TransitionResource(TextureD3D12Impl& TexD3D12, const TextureSubresourceRange& Range, RESOURCE_STATE NewState)
+{
+    VERIFY(TexD3D12.IsInKnownState(), "Texture state can't be unknown");
+    VERIFY(TexD3D12.HasSubresourceStates(), "Texture does not track subresource states");
+
+    StateTransitionDesc Barrier{&TexD3D12, RESOURCE_STATE_UNKNOWN, NewState, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    Barrier.FirstMipLevel   = Range.FirstMip;
+    Barrier.MipLevelsCount  = Range.NumMips;
+    Barrier.FirstArraySlice = Range.FirstSlice;
+    Barrier.ArraySliceCount = Range.NumSlices;
+    TransitionResource(TexD3D12, Barrier);
+}
+
 void CommandContext::TransitionResource(BufferD3D12Impl& BuffD3D12, RESOURCE_STATE NewState)
 {
     VERIFY(BuffD3D12.IsInKnownState(), "Buffer state can't be unknown");
@@ -172,15 +199,38 @@ public:
     void GetD3D12ResourceAndState(ResourceType& Resource);
 
     template <> void GetD3D12ResourceAndState<BufferD3D12Impl>(BufferD3D12Impl& Buffer);
+    template <> void GetD3D12ResourceAndState<TextureD3D12Impl>(TextureD3D12Impl& Texture);
 
     void AddD3D12ResourceBarriers(TextureD3D12Impl& Tex, D3D12_RESOURCE_BARRIER& d3d12Barrier);
     void AddD3D12ResourceBarriers(BufferD3D12Impl& Buff, D3D12_RESOURCE_BARRIER& d3d12Barrier);
     void AddD3D12ResourceBarriers(TopLevelASD3D12Impl& TLAS, D3D12_RESOURCE_BARRIER& d3d12Barrier);
     void AddD3D12ResourceBarriers(BottomLevelASD3D12Impl& BLAS, D3D12_RESOURCE_BARRIER& d3d12Barrier);
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    bool CanUseEnhancedBarrier() const;
+
+    // Returns false if the transition must be performed with legacy barriers
+    bool AddD3D12EnhancedBarrier(TextureD3D12Impl& Tex, RESOURCE_STATE NewState);
+    bool AddD3D12EnhancedBarrier(BufferD3D12Impl& Buff, RESOURCE_STATE NewState);
+
+    // Acceleration structures always use legacy UAV barriers
+    template <typename ResourceType>
+    bool AddD3D12EnhancedBarrier(ResourceType&, RESOURCE_STATE)
+    {
+        return false;
+    }
+#endif
+
     template <typename ResourceType>
     void operator()(ResourceType& Resource);
 
+    template <typename ResourceType>
+    void UpdateState(ResourceType& Resource, RESOURCE_STATE NewState)
+    {
+        Resource.SetState(NewState);
+    }
+    void UpdateState(TextureD3D12Impl& Tex, RESOURCE_STATE NewState);
+
     void DiscardIfAppropriate(const TextureDesc&    TexDesc,
                               D3D12_RESOURCE_STATES d3d12State,
                               Uint32                EndMip   = REMAINING_MIP_LEVELS,
@@ -225,6 +275,16 @@ void StateTransitionHelper::GetD3D12ResourceAndState<BufferD3D12Impl>(BufferD3D1
     m_pd3d12Resource = Buffer.GetD3D12Resource();
 }
 
+template <>
+void StateTransitionHelper::GetD3D12ResourceAndState<TextureD3D12Impl>(TextureD3D12Impl& Texture)
+{
+    VERIFY_EXPR(m_Barrier.pResource == &Texture);
+    // When the texture tracks subresource states, the subresources in the barrier range may be in
+    // a different state than the rest of the texture, so the explicitly specified old state is used.
+    m_OldState       = Texture.HasSubresourceStates() && m_Barrier.OldState != RESOURCE_STATE_UNKNOWN ? RESOURCE_STATE_UNKNOWN : Texture.GetState();
+    m_pd3d12Resource = Texture.GetD3D12Resource();
+}
+
 void StateTransitionHelper::DiscardIfAppropriate(const TextureDesc&    TexDesc,
                                                  D3D12_RESOURCE_STATES d3d12State,
                                                  Uint32                EndMip,
@@ -372,6 +432,118 @@ void StateTransitionHelper::AddD3D12ResourceBarriers(BottomLevelASD3D12Impl& BLA
         m_RequireUAVBarrier = true;
 }
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+bool StateTransitionHelper::CanUseEnhancedBarrier() const
+{
+    // Split barriers are expressed differently by enhanced barriers, so keep them on the legacy path
+    return m_CmdCtx.UseEnhancedBarriers() &&
+        m_Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE &&
+        m_pd3d12Resource != nullptr;
+}
+
+bool StateTransitionHelper::AddD3D12EnhancedBarrier(TextureD3D12Impl& Tex, RESOURCE_STATE NewState)
+{
+    if (!CanUseEnhancedBarrier())
+        return false;
+
+    D3D12BarrierAccessInfo Before, After;
+    if (!ResourceStateFlagsToD3D12BarrierAccessInfo(m_OldState, true, Before) ||
+        !ResourceStateFlagsToD3D12BarrierAccessInfo(NewState, true, After))
+        return false;
+
+    const auto& TexDesc = Tex.GetDesc();
+    VERIFY(m_Barrier.FirstMipLevel < TexDesc.MipLevels, "First mip level is out of range");
+    VERIFY(m_Barrier.FirstArraySlice < TexDesc.GetArraySize(), "First array slice is out of range");
+
+    const Uint32 EndMip   = m_Barrier.MipLevelsCount == REMAINING_MIP_LEVELS ? TexDesc.MipLevels : m_Barrier.FirstMipLevel + m_Barrier.MipLevelsCount;
+    const Uint32 EndSlice = m_Barrier.ArraySliceCount == REMAINING_ARRAY_SLICES ? TexDesc.GetArraySize() : m_Barrier.FirstArraySlice + m_Barrier.ArraySliceCount;
+    VERIFY(EndMip <= TexDesc.MipLevels, "Invalid mip level range");
+    VERIFY(EndSlice <= TexDesc.GetArraySize(), "Invalid array slice range");
+
+    D3D12_TEXTURE_BARRIER d3d12Barrier{};
+    d3d12Barrier.SyncBefore   = Before.Sync;
+    d3d12Barrier.SyncAfter    = After.Sync;
+    d3d12Barrier.AccessBefore = Before.Access;
+    d3d12Barrier.AccessAfter  = After.Access;
+    d3d12Barrier.LayoutBefore = Before.Layout;
+    d3d12Barrier.LayoutAfter  = After.Layout;
+    d3d12Barrier.pResource    = m_pd3d12Resource;
+    d3d12Barrier.Flags        = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+
+    const bool IsFullRange = m_Barrier.FirstMipLevel == 0 && EndMip == TexDesc.MipLevels && m_Barrier.FirstArraySlice == 0 && EndSlice == TexDesc.GetArraySize();
+    if (IsFullRange)
+    {
+        // 0xFFFFFFFF in IndexOrFirstMipLevel with zero NumMipLevels selects all subresources
+        d3d12Barrier.Subresources.IndexOrFirstMipLevel = 0xFFFFFFFFu;
+    }
+    else
+    {
+        // Unlike legacy barriers, a single enhanced barrier covers the whole subresource range
+        const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+
+        d3d12Barrier.Subresources.IndexOrFirstMipLevel = m_Barrier.FirstMipLevel;
+        d3d12Barrier.Subresources.NumMipLevels         = EndMip - m_Barrier.FirstMipLevel;
+        d3d12Barrier.Subresources.FirstArraySlice      = m_Barrier.FirstArraySlice;
+        d3d12Barrier.Subresources.NumArraySlices       = EndSlice - m_Barrier.FirstArraySlice;
+        d3d12Barrier.Subresources.FirstPlane           = 0;
+        d3d12Barrier.Subresources.NumPlanes            = FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL ? 2 : 1;
+    }
+
+    const auto StateBefore = ResourceStateFlagsToD3D12ResourceStates(m_OldState);
+    const auto StateAfter  = ResourceStateFlagsToD3D12ResourceStates(NewState);
+    if (IsFullRange)
+        DiscardIfAppropriate(TexDesc, StateBefore);
+    else
+        DiscardIfAppropriate(TexDesc, StateBefore, EndMip, EndSlice);
+
+    m_CmdCtx.TextureBarrier(d3d12Barrier);
+
+    if (IsFullRange)
+        DiscardIfAppropriate(TexDesc, StateAfter);
+    else
+        DiscardIfAppropriate(TexDesc, StateAfter, EndMip, EndSlice);
+
+    return true;
+}
+
+bool StateTransitionHelper::AddD3D12EnhancedBarrier(BufferD3D12Impl& Buff, RESOURCE_STATE NewState)
+{
+    if (!CanUseEnhancedBarrier())
+        return false;
+
+    D3D12BarrierAccessInfo Before, After;
+    if (!ResourceStateFlagsToD3D12BarrierAccessInfo(m_OldState, false, Before) ||
+        !ResourceStateFlagsToD3D12BarrierAccessInfo(NewState, false, After))
+        return false;
+
+    D3D12_BUFFER_BARRIER d3d12Barrier{};
+    d3d12Barrier.SyncBefore   = Before.Sync;
+    d3d12Barrier.SyncAfter    = After.Sync;
+    d3d12Barrier.AccessBefore = Before.Access;
+    d3d12Barrier.AccessAfter  = After.Access;
+    d3d12Barrier.pResource    = m_pd3d12Resource;
+    d3d12Barrier.Offset       = 0;
+    d3d12Barrier.Size         = UINT64_MAX;
+    m_CmdCtx.BufferBarrier(d3d12Barrier);
+
+    return true;
+}
+#endif
+
+void StateTransitionHelper::UpdateState(TextureD3D12Impl& Tex, RESOURCE_STATE NewState)
+{
+    if (Tex.HasSubresourceStates())
+    {
+        // Only update the state of the subresources affected by the barrier
+        const auto Range = Tex.GetSubresourceRange(m_Barrier.FirstMipLevel, m_Barrier.MipLevelsCount, m_Barrier.FirstArraySlice, m_Barrier.ArraySliceCount);
+        Tex.SetSubresourceState(Range, NewState);
+    }
+    else
+    {
+        Tex.SetState(NewState);
+    }
+}
+
 template <typename ResourceType>
 void StateTransitionHelper::operator()(ResourceType& Resource)
 {
@@ -398,14 +570,24 @@ void StateTransitionHelper::operator()(ResourceType& Resource)
         (m_Barrier.NewState == RESOURCE_STATE_UNORDERED_ACCESS || m_Barrier.NewState == RESOURCE_STATE_BUILD_AS_WRITE);
 
     // Check if required state is already set
-    if ((m_OldState & m_Barrier.NewState) != m_Barrier.NewState)
-    {
-        auto NewState = m_Barrier.NewState;
-        // If both old state and new state are read-only states, combine the two
-        if ((m_OldState & RESOURCE_STATE_GENERIC_READ) == m_OldState &&
-            (NewState & RESOURCE_STATE_GENERIC_READ) == NewState)
-            NewState |= m_OldState;
+    const bool StateChangeRequired = (m_OldState & m_Barrier.NewState) != m_Barrier.NewState;
+
+    auto NewState = m_Barrier.NewState;
+    // If both old state and new state are read-only states, combine the two
+    if (StateChangeRequired &&
+        (m_OldState & RESOURCE_STATE_GENERIC_READ) == m_OldState &&
+        (NewState & RESOURCE_STATE_GENERIC_READ) == NewState)
+        NewState |= m_OldState;
+
+    // An enhanced barrier performs both the transition and the UAV synchronization
+    bool EnhancedBarrierAdded = false;
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    if (StateChangeRequired || m_RequireUAVBarrier)
+        EnhancedBarrierAdded = AddD3D12EnhancedBarrier(Resource, StateChangeRequired ? NewState : m_OldState);
+#endif
 
+    if (StateChangeRequired && !EnhancedBarrierAdded)
+    {
         D3D12_RESOURCE_BARRIER d3d12Barrier;
         d3d12Barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
         d3d12Barrier.Flags                  = TransitionTypeToD3D12ResourceBarrierFlag(m_Barrier.TransitionType);
@@ -415,16 +597,16 @@ void StateTransitionHelper::operator()(ResourceType& Resource)
         d3d12Barrier.Transition.StateAfter  = ResourceStateFlagsToD3D12ResourceStates(NewState) & m_ResStateMask;
 
         AddD3D12ResourceBarriers(Resource, d3d12Barrier);
+    }
 
-        if ((m_Barrier.Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0)
-        {
-            VERIFY(m_Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE || m_Barrier.TransitionType == STATE_TRANSITION_TYPE_END,
-                   "Resource state can't be updated in begin-split barrier");
-            Resource.SetState(NewState);
-        }
+    if (StateChangeRequired && (m_Barrier.Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0)
+    {
+        VERIFY(m_Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE || m_Barrier.TransitionType == STATE_TRANSITION_TYPE_END,
+               "Resource state can't be updated in begin-split barrier");
+        UpdateState(Resource, NewState);
     }
 
-    if (m_RequireUAVBarrier)
+    if (m_RequireUAVBarrier && !EnhancedBarrierAdded)
     {
         // UAV barrier indicates that all UAV accesses (reads or writes) to a particular resource
         // must complete before any future UAV accesses (reads or writes) can begin.
@@ -440,6 +622,35 @@ void StateTransitionHelper::operator()(ResourceType& Resource)
 
 void CommandContext::TransitionResource(TextureD3D12Impl& Texture, const StateTransitionDesc& Barrier)
 {
+    if (Barrier.OldState == RESOURCE_STATE_UNKNOWN && Texture.HasSubresourceStates() && Texture.IsInKnownState())
+    {
+        // Transition every group of subresources that share the same state individually,
+        // so that the barriers use the exact before-states.
+        const auto Range = Texture.GetSubresourceRange(Barrier.FirstMipLevel, Barrier.MipLevelsCount, Barrier.FirstArraySlice, Barrier.ArraySliceCount);
+        Texture.ProcessSubresourceStates(
+            Range,
+            [&](const TextureSubresourceRange& SubRange, RESOURCE_STATE SubresState) {
+                VERIFY(SubresState != RESOURCE_STATE_UNKNOWN, "Subresources of a texture in known state must not be in unknown state");
+                StateTransitionDesc SubresBarrier{Barrier};
+                SubresBarrier.OldState        = SubresState;
+                SubresBarrier.Flags           = Barrier.Flags & ~STATE_TRANSITION_FLAG_UPDATE_STATE;
+                SubresBarrier.FirstMipLevel   = SubRange.FirstMip;
+                SubresBarrier.MipLevelsCount  = SubRange.NumMips;
+                SubresBarrier.FirstArraySlice = SubRange.FirstSlice;
+                SubresBarrier.ArraySliceCount = SubRange.NumSlices;
+
+                StateTransitionHelper Helper{SubresBarrier, *this};
+                Helper(Texture);
+            });
+        if ((Barrier.Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0)
+        {
+            VERIFY(Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE || Barrier.TransitionType == STATE_TRANSITION_TYPE_END,
+                   "Resource state can't be updated in begin-split barrier");
+            Texture.SetSubresourceState(Range, Barrier.NewState);
+        }
+        return;
+    }
+
     StateTransitionHelper Helper{Barrier, *this};
     Helper(Texture);
 }
@@ -462,8 +673,40 @@ void CommandContext::TransitionResource(TopLevelASD3D12Impl& TLAS, const StateTr
     Helper(TLAS);
 }
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+void CommandContext::FlushEnhancedBarriers()
+{
+    if (m_PendingBufferBarriers.empty() && m_PendingTextureBarriers.empty())
+        return;
+
+    D3D12_BARRIER_GROUP BarrierGroups[2];
+    UINT                NumGroups = 0;
+    if (!m_PendingBufferBarriers.empty())
+    {
+        auto& Group{BarrierGroups[NumGroups++]};
+        Group.Type             = D3D12_BARRIER_TYPE_BUFFER;
+        Group.NumBarriers      = static_cast<UINT32>(m_PendingBufferBarriers.size());
+        Group.pBufferBarriers  = m_PendingBufferBarriers.data();
+    }
+    if (!m_PendingTextureBarriers.empty())
+    {
+        auto& Group{BarrierGroups[NumGroups++]};
+        Group.Type             = D3D12_BARRIER_TYPE_TEXTURE;
+        Group.NumBarriers      = static_cast<UINT32>(m_PendingTextureBarriers.size());
+        Group.pTextureBarriers = m_PendingTextureBarriers.data();
+    }
+    static_cast<ID3D12GraphicsCommandList7*>(m_pCommandList.p)->Barrier(NumGroups, BarrierGroups);
+
+    m_PendingBufferBarriers.clear();
+    m_PendingTextureBarriers.clear();
+}
+#endif
+
 void CommandContext::InsertAliasBarrier(D3D12ResourceBase& Before, D3D12ResourceBase& After, bool FlushImmediate)
 {
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    FlushEnhancedBarriers();
+#endif
     m_PendingResourceBarriers.emplace_back();
     D3D12_RESOURCE_BARRIER& BarrierDesc = m_PendingResourceBarriers.back();
 
@@ -44,7 +44,7 @@ CommandListManager::CommandListManager(RenderDeviceD3D12Impl& DeviceD3D12Impl, D
 CommandListManager::~CommandListManager()
 {
     DEV_CHECK_ERR(m_AllocatorCounter == 0, m_AllocatorCounter, " allocator(s) have not been returned to the manager. This will cause a crash if these allocators are referenced by release queues and later returned via FreeAllocator()");
-    LOG_INFO_MESSAGE("Command list manager: created ", m_FreeAllocators.size(), " allocators");
+    LOG_INFO_MESSAGE("Command list manager: created ", m_NumAllocators.load(), " allocators");
 }
 
 void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List, ID3D12CommandAllocator** Allocator, Uint32& IfaceVersion)
@@ -54,6 +54,9 @@ void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List,
 
     const IID CmdListIIDs[] =
         {
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+            __uuidof(ID3D12GraphicsCommandList7),
+#endif
 #ifdef D3D12_H_HAS_MESH_SHADER
             __uuidof(ID3D12GraphicsCommandList6),
             __uuidof(ID3D12GraphicsCommandList5),
@@ -65,8 +68,20 @@ void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List,
             __uuidof(ID3D12GraphicsCommandList) //
         };
 
+    Uint32 FirstIID = 0;
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+    {
+        // ID3D12GraphicsCommandList7 is only requested when enhanced barriers are supported,
+        // so that interface version 7 indicates that ID3D12GraphicsCommandList7::Barrier() may be used.
+        D3D12_FEATURE_DATA_D3D12_OPTIONS12 d3d12Features12{};
+        if (FAILED(pd3d12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS12, &d3d12Features12, sizeof(d3d12Features12))) ||
+            !d3d12Features12.EnhancedBarriersSupported)
+            FirstIID = 1;
+    }
+#endif
+
     HRESULT hr = E_FAIL;
-    for (Uint32 i = 0; i < _countof(CmdListIIDs); ++i)
+    for (Uint32 i = FirstIID; i < _countof(CmdListIIDs); ++i)
     {
         hr = pd3d12Device->CreateCommandList(1, m_CmdListType, *Allocator, nullptr, CmdListIIDs[i], reinterpret_cast<void**>(List));
         if (SUCCEEDED(hr))
@@ -81,13 +96,29 @@ void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List,
 }
 
 
-void CommandListManager::RequestAllocator(ID3D12CommandAllocator** ppAllocator)
+void CommandListManager::RequestAllocator(ID3D12CommandAllocator** ppAllocator, CommandAllocatorRing* pRing)
 {
-    std::lock_guard<std::mutex> LockGuard{m_AllocatorMutex};
-
     VERIFY((*ppAllocator) == nullptr, "Allocator pointer is not null");
     (*ppAllocator) = nullptr;
 
+    if (pRing != nullptr && !pRing->IsEmpty())
+    {
+        // Fence values are monotonic, so only the oldest allocator needs to be checked
+        const auto& Oldest = pRing->Front();
+        if (m_DeviceD3D12Impl.GetCompletedFenceValue(Oldest.CmdQueue) >= Oldest.FenceValue)
+        {
+            *ppAllocator = pRing->Pop().Detach();
+            auto hr      = (*ppAllocator)->Reset();
+            DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to reset command allocator");
+#ifdef DILIGENT_DEVELOPMENT
+            m_AllocatorCounter.fetch_add(1);
+#endif
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> LockGuard{m_AllocatorMutex};
+
     if (!m_FreeAllocators.empty())
     {
         *ppAllocator = m_FreeAllocators.back().Detach();
@@ -111,8 +142,18 @@ void CommandListManager::RequestAllocator(ID3D12CommandAllocator** ppAllocator)
 #endif
 }
 
-void CommandListManager::ReleaseAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
+void CommandListManager::ReleaseAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue, CommandAllocatorRing* pRing)
 {
+    if (pRing != nullptr && !pRing->IsFull())
+    {
+        pRing->Push(std::move(Allocator), CmdQueue, FenceValue);
+        // Allocators in the ring are not considered outstanding
+#ifdef DILIGENT_DEVELOPMENT
+        m_AllocatorCounter.fetch_add(-1);
+#endif
+        return;
+    }
+
     struct StaleAllocator
     {
         CComPtr<ID3D12CommandAllocator> Allocator;
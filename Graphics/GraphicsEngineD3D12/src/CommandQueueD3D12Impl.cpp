@@ -39,14 +39,16 @@ namespace Diligent
 
 CommandQueueD3D12Impl::CommandQueueD3D12Impl(IReferenceCounters* pRefCounters,
                                              ID3D12CommandQueue* pd3d12NativeCmdQueue,
-                                             ID3D12Fence*        pd3d12Fence) :
+                                             ID3D12Fence*        pd3d12Fence,
+                                             Uint32              SubmitBatchSize) :
     // clang-format off
     TBase{pRefCounters},
     m_NextFenceValue       {1                   },
     m_pd3d12CmdQueue       {pd3d12NativeCmdQueue},
     m_d3d12CmdQueueDesc    {pd3d12NativeCmdQueue->GetDesc()},
     m_d3d12Fence           {pd3d12Fence         },
-    m_WaitForGPUEventHandle{CreateEvent(nullptr, false, false, nullptr)}
+    m_WaitForGPUEventHandle{CreateEvent(nullptr, false, false, nullptr)},
+    m_SubmitBatchSize      {SubmitBatchSize     }
 // clang-format on
 {
     VERIFY_EXPR(m_WaitForGPUEventHandle != INVALID_HANDLE_VALUE);
@@ -76,7 +78,19 @@ Uint64 CommandQueueD3D12Impl::Submit(Uint32                    NumCommandLists,
             VERIFY(ppCommandLists[i] != nullptr, "Command list must not be null");
         }
 #endif
-        m_pd3d12CmdQueue->ExecuteCommandLists(NumCommandLists, ppCommandLists);
+        if (m_SubmitBatchSize == 0)
+            m_pd3d12CmdQueue->ExecuteCommandLists(NumCommandLists, ppCommandLists);
+        else
+            m_BatchedCmdLists.insert(m_BatchedCmdLists.end(), ppCommandLists, ppCommandLists + NumCommandLists);
+    }
+
+    if (m_SubmitBatchSize != 0)
+    {
+        // The fence is signaled with the last value when the batch is executed
+        m_BatchedFenceValue = FenceValue;
+        if (++m_NumBatchedSubmits >= m_SubmitBatchSize)
+            InternalFlushBatchedSubmits();
+        return FenceValue;
     }
 
     // Signal the fence. This must be done atomically with command list submission.
@@ -89,6 +103,8 @@ Uint64 CommandQueueD3D12Impl::WaitForIdle()
 {
     std::lock_guard<std::mutex> Lock{m_QueueMtx};
 
+    InternalFlushBatchedSubmits();
+
     Uint64 LastSignaledFenceValue = m_NextFenceValue.fetch_add(1);
 
     m_pd3d12CmdQueue->Signal(m_d3d12Fence, LastSignaledFenceValue);
@@ -116,11 +132,42 @@ Uint64 CommandQueueD3D12Impl::GetCompletedFenceValue()
     return m_LastCompletedFenceValue.load();
 }
 
+Bool CommandQueueD3D12Impl::GetTimestampCalibration(TimestampCalibration& Calibration)
+{
+    Calibration = {};
+
+    // Copy queues may not support timestamps, in which case the method fails
+    UINT64 GPUFrequency = 0;
+    if (FAILED(m_pd3d12CmdQueue->GetTimestampFrequency(&GPUFrequency)) || GPUFrequency == 0)
+        return False;
+
+    UINT64 GPUTimestamp = 0;
+    UINT64 CPUTimestamp = 0;
+    if (FAILED(m_pd3d12CmdQueue->GetClockCalibration(&GPUTimestamp, &CPUTimestamp)))
+        return False;
+
+    LARGE_INTEGER CPUFrequency{};
+    QueryPerformanceFrequency(&CPUFrequency);
+
+    Calibration.GPUTimestamp = GPUTimestamp;
+    Calibration.GPUFrequency = GPUFrequency;
+    Calibration.CPUTimestamp = CPUTimestamp;
+    Calibration.CPUFrequency = static_cast<Uint64>(CPUFrequency.QuadPart);
+    return True;
+}
+
 void CommandQueueD3D12Impl::EnqueueSignal(ID3D12Fence* pFence, Uint64 Value)
 {
     DEV_CHECK_ERR(pFence, "Fence must not be null");
 
     std::lock_guard<std::mutex> Lock{m_QueueMtx};
+    if (m_SubmitBatchSize != 0)
+    {
+        // The signal is executed after all command lists in the batch,
+        // which is later than requested but never too early.
+        m_BatchedSignals.emplace_back(pFence, Value);
+        return;
+    }
     m_pd3d12CmdQueue->Signal(pFence, Value);
 }
 
@@ -129,15 +176,57 @@ void CommandQueueD3D12Impl::WaitFence(ID3D12Fence* pFence, Uint64 Value)
     DEV_CHECK_ERR(pFence, "Fence must not be null");
 
     std::lock_guard<std::mutex> Lock{m_QueueMtx};
+    // The wait must only affect the command lists submitted after it
+    InternalFlushBatchedSubmits();
     m_pd3d12CmdQueue->Wait(pFence, Value);
 }
 
+void CommandQueueD3D12Impl::InternalFlushBatchedSubmits()
+{
+    if (!m_BatchedCmdLists.empty())
+    {
+        m_TempCmdLists.clear();
+        for (auto& pCmdList : m_BatchedCmdLists)
+            m_TempCmdLists.push_back(pCmdList);
+        m_pd3d12CmdQueue->ExecuteCommandLists(static_cast<UINT>(m_TempCmdLists.size()), m_TempCmdLists.data());
+        m_TempCmdLists.clear();
+        m_BatchedCmdLists.clear();
+    }
+
+    if (m_BatchedFenceValue != 0)
+    {
+        m_pd3d12CmdQueue->Signal(m_d3d12Fence, m_BatchedFenceValue);
+        m_BatchedFenceValue = 0;
+    }
+
+    for (auto& Signal : m_BatchedSignals)
+        m_pd3d12CmdQueue->Signal(Signal.first, Signal.second);
+    m_BatchedSignals.clear();
+
+    m_NumBatchedSubmits = 0;
+}
+
+void CommandQueueD3D12Impl::FlushBatchedSubmits()
+{
+    std::lock_guard<std::mutex> Lock{m_QueueMtx};
+    InternalFlushBatchedSubmits();
+}
+
+bool CommandQueueD3D12Impl::HasBatchedSubmits()
+{
+    std::lock_guard<std::mutex> Lock{m_QueueMtx};
+    return !m_BatchedCmdLists.empty() || m_BatchedFenceValue != 0 || !m_BatchedSignals.empty();
+}
+
 void CommandQueueD3D12Impl::UpdateTileMappings(ResourceTileMappingsD3D12* pMappings, Uint32 Count)
 {
     DEV_CHECK_ERR(pMappings != nullptr, "Tile mappings must not be null");
 
     std::lock_guard<std::mutex> Lock{m_QueueMtx};
 
+    // Tile mappings must be updated in order with the batched command lists
+    InternalFlushBatchedSubmits();
+
     for (Uint32 i = 0; i < Count; ++i)
     {
         const auto& Mapping = pMappings[i];
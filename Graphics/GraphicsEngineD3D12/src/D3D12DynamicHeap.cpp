@@ -32,7 +32,8 @@
 namespace Diligent
 {
 
-D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size)
+D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size, bool GPUUpload) :
+    m_IsGPUUpload{GPUUpload}
 {
     D3D12_HEAP_PROPERTIES HeapProps;
     HeapProps.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
@@ -53,6 +54,12 @@ D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size)
 
     D3D12_RESOURCE_STATES DefaultUsage = D3D12_RESOURCE_STATE_GENERIC_READ;
     HeapProps.Type                     = D3D12_HEAP_TYPE_UPLOAD;
+#ifdef D3D12_H_HAS_GPU_UPLOAD_HEAP
+    if (GPUUpload)
+        HeapProps.Type = D3D12_HEAP_TYPE_GPU_UPLOAD;
+#else
+    VERIFY(!GPUUpload, "GPU upload heaps are not supported by the D3D12 headers");
+#endif
     ResourceDesc.Flags                 = D3D12_RESOURCE_FLAG_NONE;
     DefaultUsage                       = D3D12_RESOURCE_STATE_GENERIC_READ;
     ResourceDesc.Width                 = Size;
@@ -66,13 +73,13 @@ D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size)
         return;
     }
 
-    m_pd3d12Buffer->SetName(L"Dynamic memory page");
+    m_pd3d12Buffer->SetName(GPUUpload ? L"Dynamic memory page (GPU upload)" : L"Dynamic memory page");
 
     m_GPUVirtualAddress = m_pd3d12Buffer->GetGPUVirtualAddress();
 
     m_pd3d12Buffer->Map(0, nullptr, &m_CPUVirtualAddress);
 
-    LOG_INFO_MESSAGE("Created dynamic memory page. Size: ", FormatMemorySize(Size, 2), "; GPU virtual address 0x", std::hex, m_GPUVirtualAddress);
+    LOG_INFO_MESSAGE("Created dynamic memory page", (GPUUpload ? " in GPU upload heap" : ""), ". Size: ", FormatMemorySize(Size, 2), "; GPU virtual address 0x", std::hex, m_GPUVirtualAddress);
 }
 
 D3D12DynamicMemoryManager::D3D12DynamicMemoryManager(IMemoryAllocator&      Allocator,
@@ -80,36 +87,63 @@ D3D12DynamicMemoryManager::D3D12DynamicMemoryManager(IMemoryAllocator&      Allo
                                                      Uint32                 NumPagesToReserve,
                                                      Uint64                 PageSize) :
     m_DeviceD3D12Impl{DeviceD3D12Impl},
-    m_AvailablePages(STD_ALLOCATOR_RAW_MEM(AvailablePagesMapElemType, Allocator, "Allocator for multimap<AvailablePagesMapElemType>"))
+    m_AvailablePages(STD_ALLOCATOR_RAW_MEM(AvailablePagesMapElemType, Allocator, "Allocator for multimap<AvailablePagesMapElemType>")),
+    m_AvailableGPUUploadPages(STD_ALLOCATOR_RAW_MEM(AvailablePagesMapElemType, Allocator, "Allocator for multimap<AvailablePagesMapElemType>"))
 {
+#ifdef D3D12_H_HAS_GPU_UPLOAD_HEAP
+    {
+        D3D12_FEATURE_DATA_D3D12_OPTIONS16 d3d12Features16{};
+        if (SUCCEEDED(m_DeviceD3D12Impl.GetD3D12Device()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS16, &d3d12Features16, sizeof(d3d12Features16))))
+            m_GPUUploadHeapSupported = d3d12Features16.GPUUploadHeapSupported != FALSE;
+    }
+#endif
+
     for (Uint32 i = 0; i < NumPagesToReserve; ++i)
     {
         D3D12DynamicPage Page(m_DeviceD3D12Impl.GetD3D12Device(), PageSize);
         auto             Size = Page.GetSize();
+        m_TotalPageSize += Size;
         m_AvailablePages.emplace(Size, std::move(Page));
     }
 }
 
-D3D12DynamicPage D3D12DynamicMemoryManager::AllocatePage(Uint64 SizeInBytes)
+D3D12DynamicPage D3D12DynamicMemoryManager::AllocatePage(Uint64 SizeInBytes, bool GPUUpload)
 {
+    VERIFY(!GPUUpload || m_GPUUploadHeapSupported, "GPU upload heaps are not supported");
+
     std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
 #ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedPageCounter;
 #endif
-    auto PageIt = m_AvailablePages.lower_bound(SizeInBytes); // Returns an iterator pointing to the first element that is not less than key
-    if (PageIt != m_AvailablePages.end())
+    auto& AvailablePages = GetAvailablePages(GPUUpload);
+    auto  PageIt         = AvailablePages.lower_bound(SizeInBytes); // Returns an iterator pointing to the first element that is not less than key
+    if (PageIt != AvailablePages.end())
     {
         VERIFY_EXPR(PageIt->first >= SizeInBytes);
         D3D12DynamicPage Page(std::move(PageIt->second));
-        m_AvailablePages.erase(PageIt);
+        AvailablePages.erase(PageIt);
+        m_AllocatedPageSize += Page.GetSize();
         return Page;
     }
     else
     {
-        return D3D12DynamicPage{m_DeviceD3D12Impl.GetD3D12Device(), SizeInBytes};
+        D3D12DynamicPage Page{m_DeviceD3D12Impl.GetD3D12Device(), SizeInBytes, GPUUpload};
+        if (Page.IsValid())
+        {
+            m_TotalPageSize += Page.GetSize();
+            m_AllocatedPageSize += Page.GetSize();
+        }
+        return Page;
     }
 }
 
+void D3D12DynamicMemoryManager::GetMemoryStats(Uint64& TotalSize, Uint64& UsedSize)
+{
+    std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
+    TotalSize = m_TotalPageSize;
+    UsedSize  = m_AllocatedPageSize;
+}
+
 void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Pages, Uint64 QueueMask)
 {
     struct StalePage
@@ -145,7 +179,8 @@ void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Page
                 --Mgr->m_AllocatedPageCounter;
 #endif
                 auto PageSize = Page.GetSize();
-                Mgr->m_AvailablePages.emplace(PageSize, std::move(Page));
+                Mgr->m_AllocatedPageSize -= PageSize;
+                Mgr->GetAvailablePages(Page.IsGPUUpload()).emplace(PageSize, std::move(Page));
             }
         }
     };
@@ -161,18 +196,24 @@ void D3D12DynamicMemoryManager::Destroy()
     Uint64 TotalAllocatedSize = 0;
     for (const auto& Page : m_AvailablePages)
         TotalAllocatedSize += Page.second.GetSize();
+    Uint64 TotalGPUUploadSize = 0;
+    for (const auto& Page : m_AvailableGPUUploadPages)
+        TotalGPUUploadSize += Page.second.GetSize();
 
     LOG_INFO_MESSAGE("Dynamic memory manager usage stats:\n"
                      "                       Total allocated memory: ",
-                     FormatMemorySize(TotalAllocatedSize, 2));
+                     FormatMemorySize(TotalAllocatedSize, 2),
+                     "\n                       Total allocated GPU upload memory: ",
+                     FormatMemorySize(TotalGPUUploadSize, 2));
 
     m_AvailablePages.clear();
+    m_AvailableGPUUploadPages.clear();
 }
 
 D3D12DynamicMemoryManager::~D3D12DynamicMemoryManager()
 {
     DEV_CHECK_ERR(m_AllocatedPageCounter == 0, m_AllocatedPageCounter, " page(s) have not been released. If there are outstanding references to the pages in release queues, the app will crash when the page is returned to the manager.");
-    VERIFY(m_AvailablePages.empty(), "Not all pages are destroyed. Dynamic memory manager must be explicitly destroyed with Destroy() method");
+    VERIFY(m_AvailablePages.empty() && m_AvailableGPUUploadPages.empty(), "Not all pages are destroyed. Dynamic memory manager must be explicitly destroyed with Destroy() method");
 }
 
 
@@ -199,11 +240,11 @@ D3D12DynamicAllocation D3D12DynamicHeap::Allocate(Uint64 SizeInBytes, Uint64 Ali
 
     if (m_CurrOffset == InvalidOffset || SizeInBytes + (AlignUp(m_CurrOffset, Alignment) - m_CurrOffset) > m_AvailableSize)
     {
-        auto NewPageSize = m_PageSize;
+        auto NewPageSize = m_NextPageSize;
         while (NewPageSize < SizeInBytes)
             NewPageSize *= 2;
 
-        auto NewPage = m_GlobalDynamicMemMgr.AllocatePage(NewPageSize);
+        auto NewPage = m_GlobalDynamicMemMgr.AllocatePage(NewPageSize, m_GPUUpload);
         if (NewPage.IsValid())
         {
             m_CurrOffset    = 0;
@@ -213,6 +254,10 @@ D3D12DynamicAllocation D3D12DynamicHeap::Allocate(Uint64 SizeInBytes, Uint64 Ali
             m_PeakAllocatedSize = std::max(m_PeakAllocatedSize, m_CurrAllocatedSize);
 
             m_AllocatedPages.emplace_back(std::move(NewPage));
+
+            // If the context needs more memory in this frame, request a larger page next time
+            if (m_NextPageSize < m_PageSize * MaxPageSizeScale)
+                m_NextPageSize *= 2;
         }
     }
 
@@ -254,6 +299,14 @@ void D3D12DynamicHeap::ReleaseAllocatedPages(Uint64 QueueMask)
     m_GlobalDynamicMemMgr.ReleasePages(m_AllocatedPages, QueueMask);
     m_AllocatedPages.clear();
 
+    // Size the first page of the next frame by the memory used in this frame, so that
+    // a context with steady usage locks the global manager only once per frame.
+    // Page sizes are kept at power-of-two multiples of the base size so that
+    // released pages can be reused by other heaps.
+    m_NextPageSize = m_PageSize;
+    while (m_NextPageSize < m_CurrAlignedSize && m_NextPageSize < m_PageSize * MaxPageSizeScale)
+        m_NextPageSize *= 2;
+
     m_CurrOffset        = InvalidOffset;
     m_AvailableSize     = 0;
     m_CurrAllocatedSize = 0;
@@ -0,0 +1,241 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "D3D12PlacedResourceAllocator.hpp"
+
+#include <algorithm>
+
+namespace Diligent
+{
+
+struct D3D12PlacedResourceHeap
+{
+    D3D12PlacedResourceHeap(IMemoryAllocator&     Allocator,
+                            CComPtr<ID3D12Heap>&& _pd3d12Heap,
+                            Uint64                _Size,
+                            Uint32                _Category) :
+        // clang-format off
+        pd3d12Heap{std::move(_pd3d12Heap)},
+        Mgr       {_Size, Allocator      },
+        Category  {_Category             }
+    // clang-format on
+    {}
+
+    CComPtr<ID3D12Heap>            pd3d12Heap;
+    VariableSizeAllocationsManager Mgr;
+    const Uint32                   Category;
+};
+
+D3D12PlacedResourceAllocation& D3D12PlacedResourceAllocation::operator=(D3D12PlacedResourceAllocation&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        if (m_pHeap != nullptr)
+            m_pAllocator->Free(*m_pHeap, m_Allocation);
+
+        m_pAllocator = rhs.m_pAllocator;
+        m_pHeap      = rhs.m_pHeap;
+        m_Allocation = rhs.m_Allocation;
+        rhs.Reset();
+    }
+    return *this;
+}
+
+D3D12PlacedResourceAllocation::~D3D12PlacedResourceAllocation()
+{
+    if (m_pHeap != nullptr)
+        m_pAllocator->Free(*m_pHeap, m_Allocation);
+}
+
+
+D3D12PlacedResourceAllocator::D3D12PlacedResourceAllocator(IMemoryAllocator& Allocator,
+                                                           ID3D12Device*     pd3d12Device,
+                                                           Uint64            HeapSize,
+                                                           Uint64            MaxResourceSize) :
+    // clang-format off
+    m_Allocator      {Allocator      },
+    m_pd3d12Device   {pd3d12Device   },
+    m_HeapSize       {AlignUp(std::max(HeapSize, MaxResourceSize), Uint64{D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT})},
+    m_MaxResourceSize{MaxResourceSize}
+// clang-format on
+{
+}
+
+D3D12PlacedResourceAllocator::~D3D12PlacedResourceAllocator()
+{
+    DEV_CHECK_ERR(m_AllocationCount == 0, "Not all placed resource allocations have been released");
+    if (m_PeakHeapSize > 0)
+    {
+        LOG_INFO_MESSAGE("Placed resource heaps peak size: ", std::fixed, std::setprecision(2), m_PeakHeapSize / double{1 << 20}, " MB.");
+    }
+}
+
+bool D3D12PlacedResourceAllocator::CreateResource(const D3D12_RESOURCE_DESC&     d3d12Desc,
+                                                  D3D12_RESOURCE_STATES          d3d12InitialState,
+                                                  const D3D12_CLEAR_VALUE*       pClearValue,
+                                                  CComPtr<ID3D12Resource>&       pd3d12Resource,
+                                                  D3D12PlacedResourceAllocation& Allocation)
+{
+    if (m_MaxResourceSize == 0)
+        return false;
+
+    D3D12_RESOURCE_DESC d3d12PlacedDesc = d3d12Desc;
+
+    HEAP_CATEGORY Category = HEAP_CATEGORY_COUNT;
+    if (d3d12Desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        Category = HEAP_CATEGORY_BUFFERS;
+    }
+    else
+    {
+        // Placed render targets and depth-stencil buffers must be initialized with
+        // Clear, Discard or Copy operation before they are used.
+        if ((d3d12Desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0)
+            return false;
+        if (d3d12Desc.SampleDesc.Count > 1 || d3d12Desc.Layout != D3D12_TEXTURE_LAYOUT_UNKNOWN)
+            return false;
+
+        Category = HEAP_CATEGORY_TEXTURES;
+        // Small textures may use 4KB alignment instead of the default 64KB
+        d3d12PlacedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+    }
+
+    auto AllocInfo = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12PlacedDesc);
+    if (d3d12PlacedDesc.Alignment == D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT && AllocInfo.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+    {
+        d3d12PlacedDesc.Alignment = 0;
+        AllocInfo                 = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12PlacedDesc);
+    }
+
+    if (AllocInfo.SizeInBytes == ~UINT64{0} ||
+        AllocInfo.SizeInBytes > m_MaxResourceSize ||
+        AllocInfo.Alignment > D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT)
+        return false;
+
+    D3D12PlacedResourceHeap*                   pHeap = nullptr;
+    VariableSizeAllocationsManager::Allocation HeapAllocation;
+    {
+        std::lock_guard<std::mutex> Lock{m_HeapsMtx};
+
+        auto& Heaps = m_Heaps[Category];
+        for (auto& Heap : Heaps)
+        {
+            HeapAllocation = Heap->Mgr.Allocate(AllocInfo.SizeInBytes, AllocInfo.Alignment);
+            if (HeapAllocation.IsValid())
+            {
+                pHeap = Heap.get();
+                break;
+            }
+        }
+
+        if (pHeap == nullptr)
+        {
+            D3D12_HEAP_DESC d3d12HeapDesc{};
+            d3d12HeapDesc.SizeInBytes                     = m_HeapSize;
+            d3d12HeapDesc.Properties.Type                 = D3D12_HEAP_TYPE_DEFAULT;
+            d3d12HeapDesc.Properties.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+            d3d12HeapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+            d3d12HeapDesc.Properties.CreationNodeMask     = 1;
+            d3d12HeapDesc.Properties.VisibleNodeMask      = 1;
+            d3d12HeapDesc.Alignment                       = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            d3d12HeapDesc.Flags                           = Category == HEAP_CATEGORY_BUFFERS ?
+                D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS :
+                D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+            CComPtr<ID3D12Heap> pd3d12Heap;
+
+            auto hr = m_pd3d12Device->CreateHeap(&d3d12HeapDesc, __uuidof(pd3d12Heap), reinterpret_cast<void**>(static_cast<ID3D12Heap**>(&pd3d12Heap)));
+            if (FAILED(hr))
+            {
+                LOG_D3D_ERROR(hr, "Failed to create placed resource heap");
+                return false;
+            }
+            pd3d12Heap->SetName(Category == HEAP_CATEGORY_BUFFERS ? L"Placed buffer heap" : L"Placed texture heap");
+
+            Heaps.emplace_back(std::make_unique<D3D12PlacedResourceHeap>(m_Allocator, std::move(pd3d12Heap), d3d12HeapDesc.SizeInBytes, Category));
+            m_TotalHeapSize += d3d12HeapDesc.SizeInBytes;
+            m_PeakHeapSize = std::max(m_PeakHeapSize, m_TotalHeapSize);
+
+            pHeap          = Heaps.back().get();
+            HeapAllocation = pHeap->Mgr.Allocate(AllocInfo.SizeInBytes, AllocInfo.Alignment);
+            VERIFY_EXPR(HeapAllocation.IsValid());
+        }
+
+        ++m_AllocationCount;
+        m_UsedSize += HeapAllocation.Size;
+    }
+
+    // The heap can't be released while the allocation is alive, so the resource can be created outside of the lock
+    const auto HeapOffset = AlignUp(HeapAllocation.UnalignedOffset, AllocInfo.Alignment);
+
+    auto hr = m_pd3d12Device->CreatePlacedResource(pHeap->pd3d12Heap, HeapOffset, &d3d12PlacedDesc, d3d12InitialState, pClearValue,
+                                                   __uuidof(pd3d12Resource), reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&pd3d12Resource)));
+    if (FAILED(hr))
+    {
+        LOG_D3D_ERROR(hr, "Failed to create placed resource");
+        Free(*pHeap, HeapAllocation);
+        return false;
+    }
+
+    Allocation = D3D12PlacedResourceAllocation{*this, *pHeap, HeapAllocation};
+    return true;
+}
+
+void D3D12PlacedResourceAllocator::Free(D3D12PlacedResourceHeap& Heap, VariableSizeAllocationsManager::Allocation& Allocation)
+{
+    std::lock_guard<std::mutex> Lock{m_HeapsMtx};
+
+    VERIFY_EXPR(m_AllocationCount > 0 && m_UsedSize >= Allocation.Size);
+    --m_AllocationCount;
+    m_UsedSize -= Allocation.Size;
+    Heap.Mgr.Free(std::move(Allocation));
+
+    // Release empty heaps, but keep one heap of every category to avoid recreating it
+    auto& Heaps = m_Heaps[Heap.Category];
+    if (Heap.Mgr.IsEmpty() && Heaps.size() > 1)
+    {
+        auto it = std::find_if(Heaps.begin(), Heaps.end(), [&Heap](const auto& pHeap) { return pHeap.get() == &Heap; });
+        VERIFY_EXPR(it != Heaps.end());
+        m_TotalHeapSize -= Heap.Mgr.GetMaxSize();
+        Heaps.erase(it);
+    }
+}
+
+void D3D12PlacedResourceAllocator::GetStats(PlacedResourceHeapStatsD3D12& Stats) const
+{
+    std::lock_guard<std::mutex> Lock{m_HeapsMtx};
+
+    Stats = {};
+    for (const auto& Heaps : m_Heaps)
+        Stats.HeapCount += static_cast<Uint32>(Heaps.size());
+    Stats.AllocationCount = m_AllocationCount;
+    Stats.HeapSize        = m_TotalHeapSize;
+    Stats.UsedSize        = m_UsedSize;
+    Stats.PeakHeapSize    = m_PeakHeapSize;
+}
+
+} // namespace Diligent
@@ -479,6 +479,112 @@ D3D12_RESOURCE_STATES GetSupportedD3D12ResourceStatesForCommandList(D3D12_COMMAN
     }
 }
 
+#ifdef D3D12_H_HAS_ENHANCED_BARRIERS
+bool ResourceStateFlagsToD3D12BarrierAccessInfo(RESOURCE_STATE StateFlags, bool IsTexture, D3D12BarrierAccessInfo& Info)
+{
+    static_assert(RESOURCE_STATE_MAX_BIT == (1u << 21), "This function must be updated to handle new resource state flag");
+
+    Info = {};
+    switch (StateFlags)
+    {
+        case RESOURCE_STATE_UNDEFINED:
+            // Undefined state maps to D3D12_RESOURCE_STATE_COMMON in legacy barriers, so use
+            // the matching layout to stay compatible with resources created with legacy initial states.
+            Info.Access = D3D12_BARRIER_ACCESS_NO_ACCESS;
+            Info.Layout = D3D12_BARRIER_LAYOUT_COMMON;
+            return true;
+
+        case RESOURCE_STATE_PRESENT:
+            // Presentation is not a command list operation
+            Info.Access = D3D12_BARRIER_ACCESS_NO_ACCESS;
+            Info.Layout = D3D12_BARRIER_LAYOUT_PRESENT;
+            return true;
+
+        case RESOURCE_STATE_COMMON:
+            Info.Sync   = D3D12_BARRIER_SYNC_ALL;
+            Info.Access = D3D12_BARRIER_ACCESS_COMMON;
+            Info.Layout = D3D12_BARRIER_LAYOUT_COMMON;
+            return true;
+
+        default:
+            break;
+    }
+
+    auto Bits = StateFlags;
+    while (Bits != 0)
+    {
+        const auto StateFlag = ExtractLSB(Bits);
+        switch (StateFlag)
+        {
+            // clang-format off
+            case RESOURCE_STATE_VERTEX_BUFFER:     Info.Sync |= D3D12_BARRIER_SYNC_VERTEX_SHADING;   Info.Access |= D3D12_BARRIER_ACCESS_VERTEX_BUFFER;        break;
+            case RESOURCE_STATE_CONSTANT_BUFFER:   Info.Sync |= D3D12_BARRIER_SYNC_ALL_SHADING;      Info.Access |= D3D12_BARRIER_ACCESS_CONSTANT_BUFFER;      break;
+            case RESOURCE_STATE_INDEX_BUFFER:      Info.Sync |= D3D12_BARRIER_SYNC_INDEX_INPUT;      Info.Access |= D3D12_BARRIER_ACCESS_INDEX_BUFFER;         break;
+            case RESOURCE_STATE_RENDER_TARGET:     Info.Sync |= D3D12_BARRIER_SYNC_RENDER_TARGET;    Info.Access |= D3D12_BARRIER_ACCESS_RENDER_TARGET;        break;
+            case RESOURCE_STATE_DEPTH_WRITE:       Info.Sync |= D3D12_BARRIER_SYNC_DEPTH_STENCIL;    Info.Access |= D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE;  break;
+            case RESOURCE_STATE_DEPTH_READ:        Info.Sync |= D3D12_BARRIER_SYNC_DEPTH_STENCIL;    Info.Access |= D3D12_BARRIER_ACCESS_DEPTH_STENCIL_READ;   break;
+            case RESOURCE_STATE_SHADER_RESOURCE:   Info.Sync |= D3D12_BARRIER_SYNC_ALL_SHADING;      Info.Access |= D3D12_BARRIER_ACCESS_SHADER_RESOURCE;      break;
+            case RESOURCE_STATE_INPUT_ATTACHMENT:  Info.Sync |= D3D12_BARRIER_SYNC_PIXEL_SHADING;    Info.Access |= D3D12_BARRIER_ACCESS_SHADER_RESOURCE;      break;
+            case RESOURCE_STATE_INDIRECT_ARGUMENT: Info.Sync |= D3D12_BARRIER_SYNC_EXECUTE_INDIRECT; Info.Access |= D3D12_BARRIER_ACCESS_INDIRECT_ARGUMENT;    break;
+            case RESOURCE_STATE_COPY_DEST:         Info.Sync |= D3D12_BARRIER_SYNC_COPY;             Info.Access |= D3D12_BARRIER_ACCESS_COPY_DEST;            break;
+            case RESOURCE_STATE_COPY_SOURCE:       Info.Sync |= D3D12_BARRIER_SYNC_COPY;             Info.Access |= D3D12_BARRIER_ACCESS_COPY_SOURCE;          break;
+            case RESOURCE_STATE_RESOLVE_DEST:      Info.Sync |= D3D12_BARRIER_SYNC_RESOLVE;          Info.Access |= D3D12_BARRIER_ACCESS_RESOLVE_DEST;         break;
+            case RESOURCE_STATE_RESOLVE_SOURCE:    Info.Sync |= D3D12_BARRIER_SYNC_RESOLVE;          Info.Access |= D3D12_BARRIER_ACCESS_RESOLVE_SOURCE;       break;
+            case RESOURCE_STATE_SHADING_RATE:      Info.Sync |= D3D12_BARRIER_SYNC_PIXEL_SHADING;    Info.Access |= D3D12_BARRIER_ACCESS_SHADING_RATE_SOURCE;  break;
+            case RESOURCE_STATE_UNORDERED_ACCESS:
+                Info.Sync   |= D3D12_BARRIER_SYNC_ALL_SHADING | D3D12_BARRIER_SYNC_CLEAR_UNORDERED_ACCESS_VIEW;
+                Info.Access |= D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+                break;
+            // clang-format on
+
+            default:
+                // Stream output, acceleration structure states and COMMON/PRESENT combined
+                // with other states are handled by legacy barriers
+                return false;
+        }
+    }
+
+    if (!IsTexture)
+        return true;
+
+    constexpr RESOURCE_STATE ShaderReadStates = RESOURCE_STATE_SHADER_RESOURCE | RESOURCE_STATE_INPUT_ATTACHMENT;
+    switch (StateFlags)
+    {
+        // clang-format off
+        case RESOURCE_STATE_RENDER_TARGET:    Info.Layout = D3D12_BARRIER_LAYOUT_RENDER_TARGET;         return true;
+        case RESOURCE_STATE_UNORDERED_ACCESS: Info.Layout = D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS;      return true;
+        case RESOURCE_STATE_DEPTH_WRITE:      Info.Layout = D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE;   return true;
+        case RESOURCE_STATE_COPY_DEST:        Info.Layout = D3D12_BARRIER_LAYOUT_COPY_DEST;             return true;
+        case RESOURCE_STATE_COPY_SOURCE:      Info.Layout = D3D12_BARRIER_LAYOUT_COPY_SOURCE;           return true;
+        case RESOURCE_STATE_RESOLVE_DEST:     Info.Layout = D3D12_BARRIER_LAYOUT_RESOLVE_DEST;          return true;
+        case RESOURCE_STATE_RESOLVE_SOURCE:   Info.Layout = D3D12_BARRIER_LAYOUT_RESOLVE_SOURCE;        return true;
+        case RESOURCE_STATE_SHADING_RATE:     Info.Layout = D3D12_BARRIER_LAYOUT_SHADING_RATE_SOURCE;   return true;
+        // clang-format on
+        default:
+            break;
+    }
+
+    if ((StateFlags & ~ShaderReadStates) == 0)
+    {
+        Info.Layout = D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+        return true;
+    }
+    if ((StateFlags & RESOURCE_STATE_DEPTH_READ) != 0 && (StateFlags & ~(ShaderReadStates | RESOURCE_STATE_DEPTH_READ)) == 0)
+    {
+        Info.Layout = D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_READ;
+        return true;
+    }
+    if ((StateFlags & ~(ShaderReadStates | RESOURCE_STATE_COPY_SOURCE)) == 0)
+    {
+        Info.Layout = D3D12_BARRIER_LAYOUT_GENERIC_READ;
+        return true;
+    }
+
+    // No single layout supports this combination of states
+    return false;
+}
+#endif
+
 static RESOURCE_STATE D3D12ResourceStateToResourceStateFlags(D3D12_RESOURCE_STATES state)
 {
     static_assert(RESOURCE_STATE_MAX_BIT == (1u << 21), "This function must be updated to handle new resource state flag");
@@ -43,4 +43,35 @@ RefCntAutoPtr<IPipelineResourceSignature> DearchiverD3D12Impl::UnpackResourceSig
     return DearchiverBase::UnpackResourceSignatureImpl<RenderDeviceD3D12Impl, PRSSerializerD3D12<SerializerMode::Read>>(DeArchiveInfo, IsImplicit);
 }
 
+RefCntAutoPtr<IShader> DearchiverD3D12Impl::UnpackShader(const ShaderCreateInfo& ShaderCI, IRenderDevice* pDevice)
+{
+    if (ShaderCI.ByteCode == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Direct3D12 shader '", ShaderCI.Desc.Name, "' has no bytecode. Archive file may be corrupted or invalid.");
+        return {};
+    }
+
+    // See ShaderD3D12Serializer
+    ShaderCreateInfo UnpackedCI{ShaderCI};
+
+    const void* pResources    = nullptr;
+    size_t      ResourcesSize = 0;
+    {
+        Serializer<SerializerMode::Read> Ser{SerializedData{const_cast<void*>(ShaderCI.ByteCode), ShaderCI.ByteCodeSize}};
+        if (!ShaderD3D12Serializer<SerializerMode::Read>::SerializeBytecode(Ser, UnpackedCI.ByteCode, UnpackedCI.ByteCodeSize, pResources, ResourcesSize))
+        {
+            LOG_ERROR_MESSAGE("Failed to deserialize Direct3D12 shader '", ShaderCI.Desc.Name, "'. Archive file may be corrupted or invalid.");
+            return {};
+        }
+        VERIFY_EXPR(Ser.IsEnded());
+    }
+
+    // Resources are empty if the shader was archived without the reflection
+    const SerializedData SerializedResources{ResourcesSize != 0 ? const_cast<void*>(pResources) : nullptr, ResourcesSize};
+
+    RefCntAutoPtr<IShader> pShader;
+    ClassPtrCast<RenderDeviceD3D12Impl>(pDevice)->CreateShader(UnpackedCI, SerializedResources, &pShader);
+    return pShader;
+}
+
 } // namespace Diligent
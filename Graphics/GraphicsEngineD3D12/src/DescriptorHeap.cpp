@@ -257,6 +257,15 @@ void DescriptorHeapAllocationManager::FreeAllocation(DescriptorHeapAllocation&&
 //
 // CPUDescriptorHeap implementation
 //
+CPUDescriptorHeap::HeapShard::HeapShard(const D3D12_DESCRIPTOR_HEAP_DESC& _HeapDesc) :
+    // clang-format off
+    HeapPool      (STD_ALLOCATOR_RAW_MEM(DescriptorHeapAllocationManager, GetRawAllocator(), "Allocator for vector<DescriptorHeapAllocationManager>")),
+    AvailableHeaps(STD_ALLOCATOR_RAW_MEM(size_t, GetRawAllocator(), "Allocator for unordered_set<size_t>")),
+    HeapDesc      {_HeapDesc}
+// clang-format on
+{
+}
+
 CPUDescriptorHeap::CPUDescriptorHeap(IMemoryAllocator&           Allocator,
                                      RenderDeviceD3D12Impl&      DeviceD3D12Impl,
                                      Uint32                      NumDescriptorsInHeap,
@@ -265,38 +274,59 @@ CPUDescriptorHeap::CPUDescriptorHeap(IMemoryAllocator&           Allocator,
     // clang-format off
     m_MemAllocator   {Allocator      },
     m_DeviceD3D12Impl{DeviceD3D12Impl},
-    m_HeapPool       (STD_ALLOCATOR_RAW_MEM(DescriptorHeapAllocationManager, GetRawAllocator(), "Allocator for vector<DescriptorHeapAllocationManager>")),
-    m_AvailableHeaps (STD_ALLOCATOR_RAW_MEM(size_t, GetRawAllocator(), "Allocator for unordered_set<size_t>")),
-    m_HeapDesc
-    {
-        Type,
-        NumDescriptorsInHeap,
-        Flags,
-        1   // NodeMask
-    },
-    m_DescriptorSize{DeviceD3D12Impl.GetD3D12Device()->GetDescriptorHandleIncrementSize(Type)}
+    m_HeapType       {Type           },
+    m_DescriptorSize {DeviceD3D12Impl.GetD3D12Device()->GetDescriptorHandleIncrementSize(Type)}
 // clang-format on
 {
-    // Create one pool
-    m_HeapPool.emplace_back(m_MemAllocator, m_DeviceD3D12Impl, *this, 0, m_HeapDesc);
-    m_AvailableHeaps.insert(0);
+    const D3D12_DESCRIPTOR_HEAP_DESC HeapDesc //
+        {
+            Type,
+            NumDescriptorsInHeap,
+            Flags,
+            1 // NodeMask
+        };
+    for (auto& pShard : m_Shards)
+        pShard = std::make_unique<HeapShard>(HeapDesc);
+
+    // Create one pool in the first shard. Pools in other shards are created on demand.
+    auto& Shard0 = *m_Shards[0];
+    Shard0.HeapPool.emplace_back(m_MemAllocator, m_DeviceD3D12Impl, *this, 0, Shard0.HeapDesc);
+    Shard0.AvailableHeaps.insert(0);
 }
 
 CPUDescriptorHeap::~CPUDescriptorHeap()
 {
-    DEV_CHECK_ERR(m_CurrentSize == 0, "Not all allocations released");
-
-    DEV_CHECK_ERR(m_AvailableHeaps.size() == m_HeapPool.size(), "Not all descriptor heap pools are released");
     Uint32 TotalDescriptors = 0;
-    for (auto& Heap : m_HeapPool)
+    Uint32 MaxSize          = 0;
+    size_t PoolCount        = 0;
+    for (const auto& pShard : m_Shards)
     {
-        DEV_CHECK_ERR(Heap.GetNumAvailableDescriptors() == Heap.GetMaxDescriptors(), "Not all descriptors in the descriptor pool are released");
-        TotalDescriptors += Heap.GetMaxDescriptors();
+        const auto& Shard = *pShard;
+        DEV_CHECK_ERR(Shard.CurrentSize == 0, "Not all allocations released");
+        DEV_CHECK_ERR(Shard.AvailableHeaps.size() == Shard.HeapPool.size(), "Not all descriptor heap pools are released");
+        for (auto& Heap : Shard.HeapPool)
+        {
+            DEV_CHECK_ERR(Heap.GetNumAvailableDescriptors() == Heap.GetMaxDescriptors(), "Not all descriptors in the descriptor pool are released");
+            TotalDescriptors += Heap.GetMaxDescriptors();
+        }
+        MaxSize += Shard.MaxSize;
+        PoolCount += Shard.HeapPool.size();
     }
 
-    LOG_INFO_MESSAGE(std::setw(38), std::left, GetD3D12DescriptorHeapTypeLiteralName(m_HeapDesc.Type), " CPU heap allocated pool count: ", m_HeapPool.size(),
-                     ". Max descriptors: ", m_MaxSize, '/', TotalDescriptors,
-                     " (", std::fixed, std::setprecision(2), m_MaxSize * 100.0 / std::max(TotalDescriptors, 1u), "%).");
+    LOG_INFO_MESSAGE(std::setw(38), std::left, GetD3D12DescriptorHeapTypeLiteralName(m_HeapType), " CPU heap allocated pool count: ", PoolCount,
+                     ". Max descriptors: ", MaxSize, '/', TotalDescriptors,
+                     " (", std::fixed, std::setprecision(2), MaxSize * 100.0 / std::max(TotalDescriptors, 1u), "%).");
+}
+
+void CPUDescriptorHeap::GetStats(DescriptorHeapStats& Stats)
+{
+    for (auto& pShard : m_Shards)
+    {
+        std::lock_guard<std::mutex> LockGuard(pShard->HeapPoolMutex);
+        Stats.Allocated += pShard->CurrentSize;
+        for (const auto& Heap : pShard->HeapPool)
+            Stats.Capacity += Heap.GetMaxDescriptors();
+    }
 }
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -304,31 +334,47 @@ int32_t CPUDescriptorHeap::DvpGetTotalAllocationCount()
 {
     int32_t AllocationCount = 0;
 
-    std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
-    for (auto& Heap : m_HeapPool)
-        AllocationCount += Heap.DvpGetAllocationsCounter();
+    for (auto& pShard : m_Shards)
+    {
+        std::lock_guard<std::mutex> LockGuard(pShard->HeapPoolMutex);
+        for (auto& Heap : pShard->HeapPool)
+            AllocationCount += Heap.DvpGetAllocationsCounter();
+    }
     return AllocationCount;
 }
 #endif
 
+Uint32 CPUDescriptorHeap::GetThreadShardIndex()
+{
+    // Threads are assigned to shards in round-robin order when they first allocate a descriptor
+    static std::atomic<Uint32>       NextShardIndex{0};
+    static thread_local const Uint32 tl_ShardIndex = NextShardIndex.fetch_add(1) % NumShards;
+    return tl_ShardIndex;
+}
+
 DescriptorHeapAllocation CPUDescriptorHeap::Allocate(uint32_t Count)
 {
-    std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+    DILIGENT_CPU_PROFILE_SCOPE("CPUDescriptorHeap::Allocate");
+
+    const auto ShardIdx = GetThreadShardIndex();
+    auto&      Shard    = *m_Shards[ShardIdx];
+
+    std::lock_guard<std::mutex> LockGuard(Shard.HeapPoolMutex);
     // Note that every DescriptorHeapAllocationManager object instance is itself
     // thread-safe. Nested mutexes cannot cause a deadlock
 
     DescriptorHeapAllocation Allocation;
     // Go through all descriptor heap managers that have free descriptors
-    auto AvailableHeapIt = m_AvailableHeaps.begin();
-    while (AvailableHeapIt != m_AvailableHeaps.end())
+    auto AvailableHeapIt = Shard.AvailableHeaps.begin();
+    while (AvailableHeapIt != Shard.AvailableHeaps.end())
     {
         auto NextIt = AvailableHeapIt;
         ++NextIt;
         // Try to allocate descriptor using the current descriptor heap manager
-        Allocation = m_HeapPool[*AvailableHeapIt].Allocate(Count);
+        Allocation = Shard.HeapPool[*AvailableHeapIt].Allocate(Count);
         // Remove the manager from the pool if it has no more available descriptors
-        if (m_HeapPool[*AvailableHeapIt].GetNumAvailableDescriptors() == 0)
-            m_AvailableHeaps.erase(*AvailableHeapIt);
+        if (Shard.HeapPool[*AvailableHeapIt].GetNumAvailableDescriptors() == 0)
+            Shard.AvailableHeaps.erase(*AvailableHeapIt);
 
         // Terminate the loop if descriptor was successfully allocated, otherwise
         // go to the next manager
@@ -342,23 +388,25 @@ DescriptorHeapAllocation CPUDescriptorHeap::Allocate(uint32_t Count)
     if (Allocation.IsNull())
     {
         // Make sure the heap is large enough to accommodate the requested number of descriptors
-        if (Count > m_HeapDesc.NumDescriptors)
+        if (Count > Shard.HeapDesc.NumDescriptors)
         {
-            LOG_INFO_MESSAGE("Number of requested CPU descriptors handles (", Count, ") exceeds the descriptor heap size (", m_HeapDesc.NumDescriptors, "). Increasing the number of descriptors in the heap");
+            LOG_INFO_MESSAGE("Number of requested CPU descriptors handles (", Count, ") exceeds the descriptor heap size (", Shard.HeapDesc.NumDescriptors, "). Increasing the number of descriptors in the heap");
         }
-        m_HeapDesc.NumDescriptors = std::max(m_HeapDesc.NumDescriptors, static_cast<UINT>(Count));
+        Shard.HeapDesc.NumDescriptors = std::max(Shard.HeapDesc.NumDescriptors, static_cast<UINT>(Count));
         // Create a new descriptor heap manager. Note that this constructor creates a new D3D12 descriptor
-        // heap and references the entire heap. Pool index is used as manager ID
-        m_HeapPool.emplace_back(m_MemAllocator, m_DeviceD3D12Impl, *this, m_HeapPool.size(), m_HeapDesc);
-        auto NewHeapIt = m_AvailableHeaps.insert(m_HeapPool.size() - 1);
+        // heap and references the entire heap. Manager ID encodes the pool index and the shard index.
+        const auto PoolIdx   = Shard.HeapPool.size();
+        const auto ManagerId = PoolIdx * NumShards + ShardIdx;
+        Shard.HeapPool.emplace_back(m_MemAllocator, m_DeviceD3D12Impl, *this, ManagerId, Shard.HeapDesc);
+        auto NewHeapIt = Shard.AvailableHeaps.insert(PoolIdx);
         VERIFY_EXPR(NewHeapIt.second);
 
         // Use the new manager to allocate descriptor handles
-        Allocation = m_HeapPool[*NewHeapIt.first].Allocate(Count);
+        Allocation = Shard.HeapPool[*NewHeapIt.first].Allocate(Count);
     }
 
-    m_CurrentSize += static_cast<Uint32>(Allocation.GetNumHandles());
-    m_MaxSize = std::max(m_MaxSize, m_CurrentSize);
+    Shard.CurrentSize += static_cast<Uint32>(Allocation.GetNumHandles());
+    Shard.MaxSize = std::max(Shard.MaxSize, Shard.CurrentSize);
 
     return Allocation;
 }
@@ -401,13 +449,18 @@ void CPUDescriptorHeap::Free(DescriptorHeapAllocation&& Allocation, Uint64 CmdQu
 
 void CPUDescriptorHeap::FreeAllocation(DescriptorHeapAllocation&& Allocation)
 {
-    std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
-    auto                        ManagerId = Allocation.GetAllocationManagerId();
-    m_CurrentSize -= static_cast<Uint32>(Allocation.GetNumHandles());
-    m_HeapPool[ManagerId].FreeAllocation(std::move(Allocation));
+    // Return the allocation to the shard that created it
+    const auto ManagerId = Allocation.GetAllocationManagerId();
+    const auto PoolIdx   = ManagerId / NumShards;
+    auto&      Shard     = *m_Shards[ManagerId % NumShards];
+
+    std::lock_guard<std::mutex> LockGuard(Shard.HeapPoolMutex);
+    VERIFY_EXPR(PoolIdx < Shard.HeapPool.size());
+    Shard.CurrentSize -= static_cast<Uint32>(Allocation.GetNumHandles());
+    Shard.HeapPool[PoolIdx].FreeAllocation(std::move(Allocation));
     // Return the manager to the pool of available managers
-    VERIFY_EXPR(m_HeapPool[ManagerId].GetNumAvailableDescriptors() > 0);
-    m_AvailableHeaps.insert(ManagerId);
+    VERIFY_EXPR(Shard.HeapPool[PoolIdx].GetNumAvailableDescriptors() > 0);
+    Shard.AvailableHeaps.insert(PoolIdx);
 }
 
 
@@ -538,6 +591,8 @@ void DynamicSuballocationsManager::ReleaseAllocations(Uint64 CmdQueueMask)
 
 DescriptorHeapAllocation DynamicSuballocationsManager::Allocate(Uint32 Count)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DynamicSuballocationsManager::Allocate");
+
     // This method is intentionally lock-free as it is expected to
     // be called through device context from single thread only
 
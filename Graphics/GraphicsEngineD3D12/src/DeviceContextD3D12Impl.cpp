@@ -50,6 +50,7 @@
 #include "DXGITypeConversions.hpp"
 
 #include "D3D12TileMappingHelper.hpp"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -82,6 +83,19 @@ DeviceContextD3D12Impl::DeviceContextD3D12Impl(IReferenceCounters*          pRef
         GetContextObjectName("Dynamic heap", Desc.IsDeferred, Desc.ContextId),
         EngineCI.DynamicHeapPageSize
     },
+    m_GPUUploadDynamicHeap
+    {
+        pDeviceD3D12Impl->GetDynamicMemoryManager(),
+        GetContextObjectName("GPU upload dynamic heap", Desc.IsDeferred, Desc.ContextId),
+        EngineCI.DynamicHeapPageSize,
+        pDeviceD3D12Impl->GetDynamicMemoryManager().IsGPUUploadHeapSupported()
+    },
+    m_GPUUploadHeapBindFlags
+    {
+        pDeviceD3D12Impl->GetDynamicMemoryManager().IsGPUUploadHeapSupported() ?
+            EngineCI.DynamicGPUUploadHeapBindFlags :
+            BIND_NONE
+    },
     m_DynamicGPUDescriptorAllocator
     {
         {
@@ -196,7 +210,8 @@ DeviceContextD3D12Impl::~DeviceContextD3D12Impl()
 
     // Note: as dynamic pages are returned to the global dynamic memory manager hosted by the render device,
     // the dynamic heap can be destroyed before all pages are actually returned to the global manager.
-    DEV_CHECK_ERR(m_DynamicHeap.GetAllocatedPagesCount() == 0, "All dynamic pages must have been released by now.");
+    DEV_CHECK_ERR(m_DynamicHeap.GetAllocatedPagesCount() == 0 && m_GPUUploadDynamicHeap.GetAllocatedPagesCount() == 0,
+                  "All dynamic pages must have been released by now.");
 
     for (size_t i = 0; i < _countof(m_DynamicGPUDescriptorAllocator); ++i)
     {
@@ -264,10 +279,14 @@ void DeviceContextD3D12Impl::Begin(Uint32 ImmediateContextId)
 
 void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
 {
-    RefCntAutoPtr<PipelineStateD3D12Impl> pPipelineStateD3D12{pPipelineState, PipelineStateD3D12Impl::IID_InternalImpl};
-    VERIFY(pPipelineState == nullptr || pPipelineStateD3D12 != nullptr, "Unknown pipeline state object implementation");
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::SetPipelineState");
+
+    BorrowedPtr<PipelineStateD3D12Impl> pPipelineStateD3D12 = BorrowPipelineState(pPipelineState);
     if (PipelineStateD3D12Impl::IsSameObject(m_pPipelineState, pPipelineStateD3D12))
+    {
+        ++m_Stats.CommandCounters.RedundantSetPipelineState;
         return;
+    }
 
     const auto& PSODesc = pPipelineStateD3D12->GetDesc();
 
@@ -293,7 +312,7 @@ void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
             CommitScissor = m_pPipelineState->GetGraphicsPipelineDesc().RasterizerDesc.ScissorEnable != pPipelineStateD3D12->GetGraphicsPipelineDesc().RasterizerDesc.ScissorEnable;
     }
 
-    TDeviceContextBase::SetPipelineState(std::move(pPipelineStateD3D12), 0 /*Dummy*/);
+    TDeviceContextBase::SetPipelineState(pPipelineStateD3D12, 0 /*Dummy*/);
 
     auto& CmdCtx        = GetCmdContext();
     auto& RootInfo      = GetRootTableInfo(PSODesc.PipelineType);
@@ -370,7 +389,7 @@ void DeviceContextD3D12Impl::SetPipelineState(IPipelineState* pPipelineState)
 }
 
 template <bool IsCompute>
-void DeviceContextD3D12Impl::CommitRootTablesAndViews(RootTableInfo& RootInfo, Uint32 CommitSRBMask, CommandContext& CmdCtx) const
+void DeviceContextD3D12Impl::CommitRootTablesAndViews(RootTableInfo& RootInfo, Uint32 CommitSRBMask, CommandContext& CmdCtx)
 {
     const auto& RootSig = m_pPipelineState->GetRootSignature();
 
@@ -381,6 +400,8 @@ void DeviceContextD3D12Impl::CommitRootTablesAndViews(RootTableInfo& RootInfo, U
             GetContextId(),
             IsCompute //
         };
+    CommitAttribs.pCommittedDynamicDescriptors = &m_CommittedDynamicDescriptors;
+    CommitAttribs.pDescriptorBytesCopied       = &m_Stats.DescriptorBytesCopied;
 
     VERIFY(CommitSRBMask != 0, "This method should not be called when there is nothing to commit");
     while (CommitSRBMask != 0)
@@ -401,6 +422,9 @@ void DeviceContextD3D12Impl::CommitRootTablesAndViews(RootTableInfo& RootInfo, U
         {
             // Commit root tables for stale SRBs only
             pSignature->CommitRootTables(CommitAttribs);
+
+            if (m_pDevice->GetResidencyManager() != nullptr)
+                pResourceCache->MarkResidencyUsed();
         }
 
         // Always commit root views. If the root view is up-to-date (e.g. it is not stale and is intact),
@@ -437,6 +461,8 @@ void DeviceContextD3D12Impl::TransitionShaderResources(IShaderResourceBinding* p
 
 void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::CommitShaderResources");
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* pResBindingD3D12Impl = ClassPtrCast<ShaderResourceBindingD3D12Impl>(pShaderResourceBinding);
@@ -462,6 +488,15 @@ void DeviceContextD3D12Impl::CommitShaderResources(IShaderResourceBinding* pShad
     const auto SRBIndex = pResBindingD3D12Impl->GetBindingIndex();
     auto&      RootInfo = GetRootTableInfo(pSignature->GetPipelineType());
 
+    if (RootInfo.IsIntact(SRBIndex, ResourceCache))
+    {
+        // The SRB is already committed and its resources have not changed since then,
+        // so there is no need to commit the root tables again. Root views of dynamic
+        // buffers are handled by CommitRootTablesAndViews() through the DynamicSRBMask.
+        ++m_Stats.CommandCounters.RedundantCommitShaderResources;
+        return;
+    }
+
     RootInfo.Set(SRBIndex, pResBindingD3D12Impl);
 }
 
@@ -667,6 +702,7 @@ void DeviceContextD3D12Impl::PrepareForIndexedDraw(GraphicsContext& GraphCtx, DR
 
 void DeviceContextD3D12Impl::Draw(const DrawAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::Draw(Attribs, 0);
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
@@ -680,11 +716,15 @@ void DeviceContextD3D12Impl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextD3D12Impl::MultiDraw(const MultiDrawAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDraw(Attribs, 0);
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
-    if (Attribs.NumInstances > 0)
+    if (Attribs.NumInstances == 0)
+        return;
+
+    if (Attribs.DrawCount < MultiDrawIndirectThreshold)
     {
         for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
         {
@@ -695,11 +735,42 @@ void DeviceContextD3D12Impl::MultiDraw(const MultiDrawAttribs& Attribs)
                 ++m_State.NumCommands;
             }
         }
+        return;
+    }
+
+    // Write draw arguments to the upload heap and issue a single ExecuteIndirect.
+    // Upload heap resources are always in D3D12_RESOURCE_STATE_GENERIC_READ state,
+    // which includes D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT.
+    auto DynAlloc = AllocateDynamicSpace(sizeof(D3D12_DRAW_ARGUMENTS) * Attribs.DrawCount, 16);
+    VERIFY_EXPR(DynAlloc.CPUAddress != nullptr);
+
+    auto*  pArgs   = static_cast<D3D12_DRAW_ARGUMENTS*>(DynAlloc.CPUAddress);
+    Uint32 NumArgs = 0;
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumVertices > 0)
+        {
+            auto& Args                  = pArgs[NumArgs++];
+            Args.VertexCountPerInstance = Item.NumVertices;
+            Args.InstanceCount          = Attribs.NumInstances;
+            Args.StartVertexLocation    = Item.StartVertexLocation;
+            Args.StartInstanceLocation  = Attribs.FirstInstanceLocation;
+        }
+    }
+
+    if (NumArgs > 0)
+    {
+        auto* pDrawIndirectSignature = GetDrawIndirectSignature(sizeof(D3D12_DRAW_ARGUMENTS));
+        VERIFY_EXPR(pDrawIndirectSignature != nullptr);
+        GraphCtx.ExecuteIndirect(pDrawIndirectSignature, NumArgs, DynAlloc.pBuffer, DynAlloc.Offset);
+        ++m_State.NumCommands;
     }
 }
 
 void DeviceContextD3D12Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexed(Attribs, 0);
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
@@ -713,11 +784,15 @@ void DeviceContextD3D12Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
 void DeviceContextD3D12Impl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDrawIndexed(Attribs, 0);
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
-    if (Attribs.NumInstances > 0)
+    if (Attribs.NumInstances == 0)
+        return;
+
+    if (Attribs.DrawCount < MultiDrawIndirectThreshold)
     {
         for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
         {
@@ -728,6 +803,35 @@ void DeviceContextD3D12Impl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Att
                 ++m_State.NumCommands;
             }
         }
+        return;
+    }
+
+    // See comments in MultiDraw()
+    auto DynAlloc = AllocateDynamicSpace(sizeof(D3D12_DRAW_INDEXED_ARGUMENTS) * Attribs.DrawCount, 16);
+    VERIFY_EXPR(DynAlloc.CPUAddress != nullptr);
+
+    auto*  pArgs   = static_cast<D3D12_DRAW_INDEXED_ARGUMENTS*>(DynAlloc.CPUAddress);
+    Uint32 NumArgs = 0;
+    for (Uint32 i = 0; i < Attribs.DrawCount; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumIndices > 0)
+        {
+            auto& Args                 = pArgs[NumArgs++];
+            Args.IndexCountPerInstance = Item.NumIndices;
+            Args.InstanceCount         = Attribs.NumInstances;
+            Args.StartIndexLocation    = Item.FirstIndexLocation;
+            Args.BaseVertexLocation    = static_cast<INT>(Item.BaseVertex);
+            Args.StartInstanceLocation = Attribs.FirstInstanceLocation;
+        }
+    }
+
+    if (NumArgs > 0)
+    {
+        auto* pDrawIndexedIndirectSignature = GetDrawIndexedIndirectSignature(sizeof(D3D12_DRAW_INDEXED_ARGUMENTS));
+        VERIFY_EXPR(pDrawIndexedIndirectSignature != nullptr);
+        GraphCtx.ExecuteIndirect(pDrawIndexedIndirectSignature, NumArgs, DynAlloc.pBuffer, DynAlloc.Offset);
+        ++m_State.NumCommands;
     }
 }
 
@@ -755,6 +859,7 @@ void DeviceContextD3D12Impl::PrepareIndirectAttribsBuffer(CommandContext&
 
 void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndirect(Attribs, 0);
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
@@ -791,6 +896,7 @@ void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexedIndirect(Attribs, 0);
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
@@ -828,6 +934,7 @@ void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
 
 void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawMesh(Attribs, 0);
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext6();
@@ -842,6 +949,7 @@ void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 
 void DeviceContextD3D12Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawMeshIndirect(Attribs, 0);
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
@@ -899,6 +1007,7 @@ void DeviceContextD3D12Impl::PrepareForDispatchRays(GraphicsContext& GraphCtx)
 
 void DeviceContextD3D12Impl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchCompute(Attribs, 0);
 
     auto& ComputeCtx = GetCmdContext().AsComputeContext();
@@ -912,6 +1021,7 @@ void DeviceContextD3D12Impl::DispatchCompute(const DispatchComputeAttribs& Attri
 
 void DeviceContextD3D12Impl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchComputeIndirect(Attribs, 0);
 
     auto& ComputeCtx = GetCmdContext().AsComputeContext();
@@ -939,7 +1049,9 @@ void DeviceContextD3D12Impl::ClearDepthStencil(ITextureView*                  pV
     auto* pViewD3D12    = ClassPtrCast<ITextureViewD3D12>(pView);
     auto* pTextureD3D12 = ClassPtrCast<TextureD3D12Impl>(pViewD3D12->GetTexture());
     auto& CmdCtx        = GetCmdContext();
-    TransitionOrVerifyTextureState(CmdCtx, *pTextureD3D12, StateTransitionMode, RESOURCE_STATE_DEPTH_WRITE, "Clearing depth-stencil buffer (DeviceContextD3D12Impl::ClearDepthStencil)");
+
+    const auto SubresRange = pTextureD3D12->GetViewSubresourceRange(pViewD3D12->GetDesc());
+    TransitionOrVerifyTextureState(CmdCtx, *pTextureD3D12, StateTransitionMode, RESOURCE_STATE_DEPTH_WRITE, "Clearing depth-stencil buffer (DeviceContextD3D12Impl::ClearDepthStencil)", &SubresRange);
 
     D3D12_CLEAR_FLAGS d3d12ClearFlags = (D3D12_CLEAR_FLAGS)0;
     if (ClearFlags & CLEAR_DEPTH_FLAG) d3d12ClearFlags |= D3D12_CLEAR_FLAG_DEPTH;
@@ -977,7 +1089,9 @@ void DeviceContextD3D12Impl::ClearRenderTarget(ITextureView* pView, const void*
 
     auto* pTextureD3D12 = ClassPtrCast<TextureD3D12Impl>(pViewD3D12->GetTexture());
     auto& CmdCtx        = GetCmdContext();
-    TransitionOrVerifyTextureState(CmdCtx, *pTextureD3D12, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, "Clearing render target (DeviceContextD3D12Impl::ClearRenderTarget)");
+
+    const auto SubresRange = pTextureD3D12->GetViewSubresourceRange(pViewD3D12->GetDesc());
+    TransitionOrVerifyTextureState(CmdCtx, *pTextureD3D12, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, "Clearing render target (DeviceContextD3D12Impl::ClearRenderTarget)", &SubresRange);
 
     // The full extent of the resource view is always cleared.
     // Viewport and scissor settings are not applied??
@@ -1001,14 +1115,18 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
                   "Flushing device context that has ", m_ActiveQueriesCounter,
                   " active queries. Direct3D12 requires that queries are begun and ended in the same command list");
 
-    // TODO: use small_vector
-    std::vector<RenderDeviceD3D12Impl::PooledCommandContext> Contexts;
+    DEV_CHECK_ERR(!m_DvpConditionalRenderingActive,
+                  "Flushing device context with active conditional rendering. Predication must be set and reset in the same command list");
+
+    std::vector<RenderDeviceD3D12Impl::PooledCommandContext>& Contexts = m_FlushContexts;
+    VERIFY_EXPR(Contexts.empty());
     Contexts.reserve(size_t{NumCommandLists} + 1);
 
     // First, execute current context
     if (m_CurrCmdCtx)
     {
         VERIFY(!IsDeferred(), "Deferred contexts cannot execute command lists directly");
+        m_Stats.BarrierCount += m_CurrCmdCtx->ExtractNumBarriers();
         if (m_State.NumCommands != 0)
             Contexts.emplace_back(std::move(m_CurrCmdCtx));
         else if (!RequestNewCmdCtx) // Reuse existing context instead of disposing and creating new one.
@@ -1030,11 +1148,13 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
     if (!Contexts.empty())
     {
         m_pDevice->CloseAndExecuteCommandContexts(GetCommandQueueId(), static_cast<Uint32>(Contexts.size()), Contexts.data(), true, &m_SignalFences, &m_WaitFences);
+        ++m_Stats.SubmitCount;
 
 #ifdef DILIGENT_DEBUG
         for (const auto& Ctx : Contexts)
             VERIFY(!Ctx, "All contexts must be disposed by CloseAndExecuteCommandContexts");
 #endif
+        Contexts.clear();
     }
     else
     {
@@ -1068,6 +1188,8 @@ void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
 
 void DeviceContextD3D12Impl::Flush()
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextD3D12Impl::Flush");
+
     DEV_CHECK_ERR(!IsDeferred(), "Flush() should only be called for immediate contexts");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Flushing device context inside an active render pass.");
 
@@ -1121,12 +1243,18 @@ void DeviceContextD3D12Impl::FinishFrame()
 
     // Released pages are returned to the global dynamic memory manager hosted by render device.
     m_DynamicHeap.ReleaseAllocatedPages(QueueMask);
+    m_GPUUploadDynamicHeap.ReleaseAllocatedPages(QueueMask);
 
     // Dynamic GPU descriptor allocations are returned to the global GPU descriptor heap
     // hosted by the render device.
+    m_CommittedDynamicDescriptors.clear();
     for (size_t i = 0; i < _countof(m_DynamicGPUDescriptorAllocator); ++i)
         m_DynamicGPUDescriptorAllocator[i].ReleaseAllocations(QueueMask);
 
+    // Submit the command lists batched by the command queue during the frame (see EngineD3D12CreateInfo::SubmitBatchSize)
+    if (!IsDeferred())
+        m_pDevice->FlushBatchedSubmits(GetCommandQueueId());
+
     EndFrame();
 }
 
@@ -1137,7 +1265,7 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
                                               RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                               SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    const bool StreamsChanged = TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags, 0);
 
     auto& CmdCtx = GetCmdContext();
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
@@ -1147,7 +1275,8 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
             TransitionOrVerifyBufferState(CmdCtx, *pBufferD3D12, StateTransitionMode, RESOURCE_STATE_VERTEX_BUFFER, "Setting vertex buffers (DeviceContextD3D12Impl::SetVertexBuffers)");
     }
 
-    m_State.bCommittedD3D12VBsUpToDate = false;
+    if (StreamsChanged)
+        m_State.bCommittedD3D12VBsUpToDate = false;
 }
 
 void DeviceContextD3D12Impl::InvalidateState()
@@ -1163,13 +1292,14 @@ void DeviceContextD3D12Impl::InvalidateState()
 
 void DeviceContextD3D12Impl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const bool IndexBufferChanged = TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode, 0);
     if (m_pIndexBuffer)
     {
         auto& CmdCtx = GetCmdContext();
         TransitionOrVerifyBufferState(CmdCtx, *m_pIndexBuffer, StateTransitionMode, RESOURCE_STATE_INDEX_BUFFER, "Setting index buffer (DeviceContextD3D12Impl::SetIndexBuffer)");
     }
-    m_State.bCommittedD3D12IBUpToDate = false;
+    if (IndexBufferChanged)
+        m_State.bCommittedD3D12IBUpToDate = false;
 }
 
 void DeviceContextD3D12Impl::CommitViewports()
@@ -1194,7 +1324,8 @@ void DeviceContextD3D12Impl::CommitViewports()
 void DeviceContextD3D12Impl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
     static_assert(MAX_VIEWPORTS >= D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE, "MaxViewports constant must be greater than D3D12_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE");
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
 
     CommitViewports();
@@ -1257,7 +1388,8 @@ void DeviceContextD3D12Impl::SetScissorRects(Uint32 NumRects, const Rect* pRects
     VERIFY(NumRects < MaxScissorRects, "Too many scissor rects are being set");
     NumRects = std::min(NumRects, MaxScissorRects);
 
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     // Only commit scissor rects if scissor test is enabled in the rasterizer state.
     // If scissor is currently disabled, or no PSO is bound, scissor rects will be committed by
@@ -1298,8 +1430,9 @@ void DeviceContextD3D12Impl::CommitRenderTargets(RESOURCE_STATE_TRANSITION_MODE
     {
         if (auto* pRTV = ppRTVs[i])
         {
-            auto* pTexture = ClassPtrCast<TextureD3D12Impl>(pRTV->GetTexture());
-            TransitionOrVerifyTextureState(CmdCtx, *pTexture, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, "Setting render targets (DeviceContextD3D12Impl::CommitRenderTargets)");
+            auto*      pTexture    = ClassPtrCast<TextureD3D12Impl>(pRTV->GetTexture());
+            const auto SubresRange = pTexture->GetViewSubresourceRange(pRTV->GetDesc());
+            TransitionOrVerifyTextureState(CmdCtx, *pTexture, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, "Setting render targets (DeviceContextD3D12Impl::CommitRenderTargets)", &SubresRange);
             RTVHandles[i] = pRTV->GetCPUDescriptorHandle();
             VERIFY_EXPR(RTVHandles[i].ptr != 0);
         }
@@ -1325,9 +1458,10 @@ void DeviceContextD3D12Impl::CommitRenderTargets(RESOURCE_STATE_TRANSITION_MODE
             NewState |= RESOURCE_STATE_SHADER_RESOURCE;
         }
 
-        auto* pTexture = ClassPtrCast<TextureD3D12Impl>(pDSV->GetTexture());
+        auto*      pTexture    = ClassPtrCast<TextureD3D12Impl>(pDSV->GetTexture());
+        const auto SubresRange = pTexture->GetViewSubresourceRange(pDSV->GetDesc());
 
-        TransitionOrVerifyTextureState(CmdCtx, *pTexture, StateTransitionMode, NewState, "Setting depth-stencil buffer (DeviceContextD3D12Impl::CommitRenderTargets)");
+        TransitionOrVerifyTextureState(CmdCtx, *pTexture, StateTransitionMode, NewState, "Setting depth-stencil buffer (DeviceContextD3D12Impl::CommitRenderTargets)", &SubresRange);
         DSVHandle = pDSV->GetCPUDescriptorHandle();
         VERIFY_EXPR(DSVHandle.ptr != 0);
     }
@@ -1477,7 +1611,7 @@ void DeviceContextD3D12Impl::CommitSubpassRenderTargets()
                     const auto& SrcTexDesc  = pSrcTexD3D12->GetDesc();
                     const auto& DstTexDesc  = pDstTexD3D12->GetDesc();
 
-                    VERIFY_EXPR(SrcRTVDesc.NumArraySlices == 1);
+                    VERIFY_EXPR(SrcRTVDesc.NumArraySlices == 1 || Subpass.ViewMask != 0);
                     Uint32 SubresourceCount = SrcRTVDesc.NumArraySlices;
                     m_AttachmentResolveInfo.resize(SubresourceCount);
                     const auto MipProps = GetMipLevelProperties(SrcTexDesc, SrcRTVDesc.MostDetailedMip);
@@ -1599,6 +1733,12 @@ void DeviceContextD3D12Impl::CommitSubpassRenderTargets()
         auto* pTexD3D12 = ClassPtrCast<TextureD3D12Impl>(m_pBoundShadingRateMap->GetTexture());
         CmdCtx.AsGraphicsContext5().SetShadingRateImage(pTexD3D12->GetD3D12Resource());
     }
+
+    if (Subpass.ViewMask != 0)
+    {
+        // Set bits of the view instance mask disable the corresponding view instances
+        CmdCtx.AsGraphicsContext1().SetViewInstanceMask(~Subpass.ViewMask);
+    }
 }
 
 void DeviceContextD3D12Impl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
@@ -1629,12 +1769,16 @@ void DeviceContextD3D12Impl::EndRenderPass()
     TransitionSubpassAttachments(m_SubpassIndex + 1);
     if (m_pBoundShadingRateMap)
         CmdCtx.AsGraphicsContext5().SetShadingRateImage(nullptr);
+    if (m_pActiveRenderPass->GetDesc().pSubpasses[0].ViewMask != 0)
+        CmdCtx.AsGraphicsContext1().SetViewInstanceMask(0);
     TDeviceContextBase::EndRenderPass();
 }
 
-D3D12DynamicAllocation DeviceContextD3D12Impl::AllocateDynamicSpace(Uint64 NumBytes, Uint32 Alignment)
+D3D12DynamicAllocation DeviceContextD3D12Impl::AllocateDynamicSpace(Uint64 NumBytes, Uint32 Alignment, bool GPUUpload)
 {
-    return m_DynamicHeap.Allocate(NumBytes, Alignment, GetFrameNumber());
+    auto& DynamicHeap = GPUUpload ? m_GPUUploadDynamicHeap : m_DynamicHeap;
+    m_Stats.DynamicMemoryAllocated += NumBytes;
+    return DynamicHeap.Allocate(NumBytes, Alignment, GetFrameNumber());
 }
 
 void DeviceContextD3D12Impl::UpdateBufferRegion(BufferD3D12Impl*               pBuffD3D12,
@@ -1742,8 +1886,9 @@ void DeviceContextD3D12Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_F
             auto& DynamicData = pBufferD3D12->m_DynamicData[GetContextId()];
             if ((MapFlags & MAP_FLAG_DISCARD) != 0 || DynamicData.CPUAddress == nullptr)
             {
-                Uint32 Alignment = (BuffDesc.BindFlags & BIND_UNIFORM_BUFFER) ? D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT : 16;
-                DynamicData      = AllocateDynamicSpace(BuffDesc.Size, Alignment);
+                Uint32     Alignment = (BuffDesc.BindFlags & BIND_UNIFORM_BUFFER) ? D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT : 16;
+                const bool GPUUpload = (BuffDesc.BindFlags & m_GPUUploadHeapBindFlags) != 0;
+                DynamicData          = AllocateDynamicSpace(BuffDesc.Size, Alignment, GPUUpload);
             }
             else
             {
@@ -1809,6 +1954,31 @@ void DeviceContextD3D12Impl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
     }
 }
 
+// Aligns the update region by the compressed block size
+static Box AlignBoxToCompressedBlock(TEXTURE_FORMAT Format, const Box& DstBox)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    if (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+        return DstBox;
+
+    Box BlockAlignedBox;
+
+    VERIFY((DstBox.MinX % FmtAttribs.BlockWidth) == 0, "Update region min X coordinate (", DstBox.MinX, ") must be multiple of a compressed block width (", Uint32{FmtAttribs.BlockWidth}, ")");
+    BlockAlignedBox.MinX = DstBox.MinX;
+    VERIFY((FmtAttribs.BlockWidth & (FmtAttribs.BlockWidth - 1)) == 0, "Compressed block width (", Uint32{FmtAttribs.BlockWidth}, ") is expected to be power of 2");
+    BlockAlignedBox.MaxX = (DstBox.MaxX + FmtAttribs.BlockWidth - 1) & ~(FmtAttribs.BlockWidth - 1);
+
+    VERIFY((DstBox.MinY % FmtAttribs.BlockHeight) == 0, "Update region min Y coordinate (", DstBox.MinY, ") must be multiple of a compressed block height (", Uint32{FmtAttribs.BlockHeight}, ")");
+    BlockAlignedBox.MinY = DstBox.MinY;
+    VERIFY((FmtAttribs.BlockHeight & (FmtAttribs.BlockHeight - 1)) == 0, "Compressed block height (", Uint32{FmtAttribs.BlockHeight}, ") is expected to be power of 2");
+    BlockAlignedBox.MaxY = (DstBox.MaxY + FmtAttribs.BlockHeight - 1) & ~(FmtAttribs.BlockHeight - 1);
+
+    BlockAlignedBox.MinZ = DstBox.MinZ;
+    BlockAlignedBox.MaxZ = DstBox.MaxZ;
+
+    return BlockAlignedBox;
+}
+
 void DeviceContextD3D12Impl::UpdateTexture(ITexture*                      pTexture,
                                            Uint32                         MipLevel,
                                            Uint32                         Slice,
@@ -1825,42 +1995,17 @@ void DeviceContextD3D12Impl::UpdateTexture(ITexture*                      pTextu
     DEV_CHECK_ERR(Desc.Usage == USAGE_DEFAULT || Desc.Usage == USAGE_SPARSE,
                   "Only USAGE_DEFAULT or USAGE_SPARSE textures should be updated with UpdateData()");
 
-    Box         BlockAlignedBox;
-    const auto& FmtAttribs = GetTextureFormatAttribs(Desc.Format);
-    const Box*  pBox       = nullptr;
-    if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
-    {
-        // Align update region by the compressed block size
-
-        VERIFY((DstBox.MinX % FmtAttribs.BlockWidth) == 0, "Update region min X coordinate (", DstBox.MinX, ") must be multiple of a compressed block width (", Uint32{FmtAttribs.BlockWidth}, ")");
-        BlockAlignedBox.MinX = DstBox.MinX;
-        VERIFY((FmtAttribs.BlockWidth & (FmtAttribs.BlockWidth - 1)) == 0, "Compressed block width (", Uint32{FmtAttribs.BlockWidth}, ") is expected to be power of 2");
-        BlockAlignedBox.MaxX = (DstBox.MaxX + FmtAttribs.BlockWidth - 1) & ~(FmtAttribs.BlockWidth - 1);
-
-        VERIFY((DstBox.MinY % FmtAttribs.BlockHeight) == 0, "Update region min Y coordinate (", DstBox.MinY, ") must be multiple of a compressed block height (", Uint32{FmtAttribs.BlockHeight}, ")");
-        BlockAlignedBox.MinY = DstBox.MinY;
-        VERIFY((FmtAttribs.BlockHeight & (FmtAttribs.BlockHeight - 1)) == 0, "Compressed block height (", Uint32{FmtAttribs.BlockHeight}, ") is expected to be power of 2");
-        BlockAlignedBox.MaxY = (DstBox.MaxY + FmtAttribs.BlockHeight - 1) & ~(FmtAttribs.BlockHeight - 1);
-
-        BlockAlignedBox.MinZ = DstBox.MinZ;
-        BlockAlignedBox.MaxZ = DstBox.MaxZ;
-
-        pBox = &BlockAlignedBox;
-    }
-    else
-    {
-        pBox = &DstBox;
-    }
-    auto DstSubResIndex = D3D12CalcSubresource(MipLevel, Slice, 0, Desc.MipLevels, Desc.GetArraySize());
+    const Box BlockAlignedBox = AlignBoxToCompressedBlock(Desc.Format, DstBox);
+    auto      DstSubResIndex  = D3D12CalcSubresource(MipLevel, Slice, 0, Desc.MipLevels, Desc.GetArraySize());
     if (SubresData.pSrcBuffer == nullptr)
     {
         UpdateTextureRegion(SubresData.pData, SubresData.Stride, SubresData.DepthStride,
-                            *pTexD3D12, DstSubResIndex, *pBox, TextureTransitionMode);
+                            *pTexD3D12, DstSubResIndex, BlockAlignedBox, TextureTransitionMode);
     }
     else
     {
         CopyTextureRegion(SubresData.pSrcBuffer, 0, SubresData.Stride, SubresData.DepthStride,
-                          *pTexD3D12, DstSubResIndex, *pBox,
+                          *pTexD3D12, DstSubResIndex, BlockAlignedBox,
                           SrcBufferTransitionMode, TextureTransitionMode);
     }
 }
@@ -1894,83 +2039,79 @@ void DeviceContextD3D12Impl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
                       CopyAttribs.DstTextureTransitionMode);
 }
 
-void DeviceContextD3D12Impl::CopyTextureRegion(TextureD3D12Impl*              pSrcTexture,
-                                               Uint32                         SrcSubResIndex,
-                                               const D3D12_BOX*               pD3D12SrcBox,
-                                               RESOURCE_STATE_TRANSITION_MODE SrcTextureTransitionMode,
-                                               TextureD3D12Impl*              pDstTexture,
-                                               Uint32                         DstSubResIndex,
-                                               Uint32                         DstX,
-                                               Uint32                         DstY,
-                                               Uint32                         DstZ,
-                                               RESOURCE_STATE_TRANSITION_MODE DstTextureTransitionMode)
+void DeviceContextD3D12Impl::PrepareTextureCopy(TextureD3D12Impl&              SrcTexture,
+                                                RESOURCE_STATE_TRANSITION_MODE SrcTextureTransitionMode,
+                                                TextureD3D12Impl&              DstTexture,
+                                                RESOURCE_STATE_TRANSITION_MODE DstTextureTransitionMode)
 {
     // We must unbind the textures from framebuffer because
     // we will transition their states. If we later try to commit
     // them as render targets (e.g. from SetPipelineState()), a
     // state mismatch error will occur.
-    UnbindTextureFromFramebuffer(pSrcTexture, true);
-    UnbindTextureFromFramebuffer(pDstTexture, true);
+    UnbindTextureFromFramebuffer(&SrcTexture, true);
+    UnbindTextureFromFramebuffer(&DstTexture, true);
 
     auto& CmdCtx = GetCmdContext();
-    if (pSrcTexture->GetDesc().Usage == USAGE_STAGING)
+    if (SrcTexture.GetDesc().Usage == USAGE_STAGING)
     {
-        DEV_CHECK_ERR((pSrcTexture->GetDesc().CPUAccessFlags & CPU_ACCESS_WRITE) != 0, "Source staging texture must be created with CPU_ACCESS_WRITE flag");
-        DEV_CHECK_ERR(pSrcTexture->GetState() == RESOURCE_STATE_GENERIC_READ || !pSrcTexture->IsInKnownState(), "Staging texture must always be in RESOURCE_STATE_GENERIC_READ state");
+        DEV_CHECK_ERR((SrcTexture.GetDesc().CPUAccessFlags & CPU_ACCESS_WRITE) != 0, "Source staging texture must be created with CPU_ACCESS_WRITE flag");
+        DEV_CHECK_ERR(SrcTexture.GetState() == RESOURCE_STATE_GENERIC_READ || !SrcTexture.IsInKnownState(), "Staging texture must always be in RESOURCE_STATE_GENERIC_READ state");
     }
-    TransitionOrVerifyTextureState(CmdCtx, *pSrcTexture, SrcTextureTransitionMode, RESOURCE_STATE_COPY_SOURCE, "Using resource as copy source (DeviceContextD3D12Impl::CopyTextureRegion)");
+    TransitionOrVerifyTextureState(CmdCtx, SrcTexture, SrcTextureTransitionMode, RESOURCE_STATE_COPY_SOURCE, "Using resource as copy source (DeviceContextD3D12Impl::CopyTextureRegion)");
 
-    if (pDstTexture->GetDesc().Usage == USAGE_STAGING)
+    if (DstTexture.GetDesc().Usage == USAGE_STAGING)
     {
-        DEV_CHECK_ERR((pDstTexture->GetDesc().CPUAccessFlags & CPU_ACCESS_READ) != 0, "Destination staging texture must be created with CPU_ACCESS_READ flag");
-        DEV_CHECK_ERR(pDstTexture->GetState() == RESOURCE_STATE_COPY_DEST || !pDstTexture->IsInKnownState(), "Staging texture must always be in RESOURCE_STATE_COPY_DEST state");
+        DEV_CHECK_ERR((DstTexture.GetDesc().CPUAccessFlags & CPU_ACCESS_READ) != 0, "Destination staging texture must be created with CPU_ACCESS_READ flag");
+        DEV_CHECK_ERR(DstTexture.GetState() == RESOURCE_STATE_COPY_DEST || !DstTexture.IsInKnownState(), "Staging texture must always be in RESOURCE_STATE_COPY_DEST state");
     }
-    TransitionOrVerifyTextureState(CmdCtx, *pDstTexture, DstTextureTransitionMode, RESOURCE_STATE_COPY_DEST, "Using resource as copy destination (DeviceContextD3D12Impl::CopyTextureRegion)");
+    TransitionOrVerifyTextureState(CmdCtx, DstTexture, DstTextureTransitionMode, RESOURCE_STATE_COPY_DEST, "Using resource as copy destination (DeviceContextD3D12Impl::CopyTextureRegion)");
+}
 
-    D3D12_TEXTURE_COPY_LOCATION DstLocation = {}, SrcLocation = {};
+static D3D12_TEXTURE_COPY_LOCATION GetTextureCopyLocation(TextureD3D12Impl& Texture, Uint32 SubResIndex)
+{
+    D3D12_TEXTURE_COPY_LOCATION Location = {};
 
-    SrcLocation.pResource = pSrcTexture->GetD3D12Resource();
-    if (pSrcTexture->GetDesc().Usage == USAGE_STAGING)
+    Location.pResource = Texture.GetD3D12Resource();
+    if (Texture.GetDesc().Usage == USAGE_STAGING)
     {
-        SrcLocation.Type            = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-        SrcLocation.PlacedFootprint = pSrcTexture->GetStagingFootprint(SrcSubResIndex);
+        Location.Type            = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        Location.PlacedFootprint = Texture.GetStagingFootprint(SubResIndex);
     }
     else
     {
-        SrcLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-        SrcLocation.SubresourceIndex = SrcSubResIndex;
+        Location.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        Location.SubresourceIndex = SubResIndex;
     }
+    return Location;
+}
 
-    DstLocation.pResource = pDstTexture->GetD3D12Resource();
-    if (pDstTexture->GetDesc().Usage == USAGE_STAGING)
-    {
-        DstLocation.Type            = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-        DstLocation.PlacedFootprint = pDstTexture->GetStagingFootprint(DstSubResIndex);
-    }
-    else
-    {
-        DstLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-        DstLocation.SubresourceIndex = DstSubResIndex;
-    }
+void DeviceContextD3D12Impl::CopyTextureRegion(TextureD3D12Impl*              pSrcTexture,
+                                               Uint32                         SrcSubResIndex,
+                                               const D3D12_BOX*               pD3D12SrcBox,
+                                               RESOURCE_STATE_TRANSITION_MODE SrcTextureTransitionMode,
+                                               TextureD3D12Impl*              pDstTexture,
+                                               Uint32                         DstSubResIndex,
+                                               Uint32                         DstX,
+                                               Uint32                         DstY,
+                                               Uint32                         DstZ,
+                                               RESOURCE_STATE_TRANSITION_MODE DstTextureTransitionMode)
+{
+    PrepareTextureCopy(*pSrcTexture, SrcTextureTransitionMode, *pDstTexture, DstTextureTransitionMode);
 
+    const D3D12_TEXTURE_COPY_LOCATION SrcLocation = GetTextureCopyLocation(*pSrcTexture, SrcSubResIndex);
+    const D3D12_TEXTURE_COPY_LOCATION DstLocation = GetTextureCopyLocation(*pDstTexture, DstSubResIndex);
+
+    auto& CmdCtx = GetCmdContext();
     CmdCtx.FlushResourceBarriers();
     CmdCtx.GetCommandList()->CopyTextureRegion(&DstLocation, DstX, DstY, DstZ, &SrcLocation, pD3D12SrcBox);
     ++m_State.NumCommands;
 }
 
-void DeviceContextD3D12Impl::CopyTextureRegion(ID3D12Resource*                pd3d12Buffer,
-                                               Uint64                         SrcOffset,
-                                               Uint64                         SrcStride,
-                                               Uint64                         SrcDepthStride,
-                                               Uint64                         BufferSize,
-                                               TextureD3D12Impl&              TextureD3D12,
-                                               Uint32                         DstSubResIndex,
-                                               const Box&                     DstBox,
-                                               RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+bool DeviceContextD3D12Impl::GetTextureCopyDestBarrier(TextureD3D12Impl&              TextureD3D12,
+                                                       Uint32                         DstSubResIndex,
+                                                       RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode,
+                                                       D3D12_RESOURCE_BARRIER&        BarrierDesc)
 {
-    const auto& TexDesc = TextureD3D12.GetDesc();
-    auto&       CmdCtx  = GetCmdContext();
-
     bool StateTransitionRequired = false;
     if (TextureTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
@@ -1982,20 +2123,29 @@ void DeviceContextD3D12Impl::CopyTextureRegion(ID3D12Resource*                pd
         DvpVerifyTextureState(TextureD3D12, RESOURCE_STATE_COPY_DEST, "Using texture as copy destination (DeviceContextD3D12Impl::CopyTextureRegion)");
     }
 #endif
-    D3D12_RESOURCE_BARRIER BarrierDesc;
     if (StateTransitionRequired)
     {
-        const auto ResStateMask = GetSupportedD3D12ResourceStatesForCommandList(CmdCtx.GetCommandListType());
+        const auto ResStateMask = GetSupportedD3D12ResourceStatesForCommandList(GetCmdContext().GetCommandListType());
 
+        // The texture is temporarily transitioned to the copy destination state and then back,
+        // so that its tracked state does not change.
         BarrierDesc.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
         BarrierDesc.Transition.pResource   = TextureD3D12.GetD3D12Resource();
         BarrierDesc.Transition.Subresource = DstSubResIndex;
         BarrierDesc.Transition.StateBefore = ResourceStateFlagsToD3D12ResourceStates(TextureD3D12.GetState()) & ResStateMask;
         BarrierDesc.Transition.StateAfter  = D3D12_RESOURCE_STATE_COPY_DEST;
         BarrierDesc.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        CmdCtx.ResourceBarrier(BarrierDesc);
     }
+    return StateTransitionRequired;
+}
 
+void DeviceContextD3D12Impl::RecordBufferToTextureCopy(ID3D12Resource*   pd3d12Buffer,
+                                                       Uint64            SrcOffset,
+                                                       Uint64            SrcStride,
+                                                       TextureD3D12Impl& TextureD3D12,
+                                                       Uint32            DstSubResIndex,
+                                                       const Box&        DstBox)
+{
     D3D12_TEXTURE_COPY_LOCATION DstLocation;
     DstLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
     DstLocation.pResource        = TextureD3D12.GetD3D12Resource();
@@ -2009,19 +2159,10 @@ void DeviceContextD3D12Impl::CopyTextureRegion(ID3D12Resource*                pd
     Footprint.Footprint.Width                     = StaticCast<UINT>(DstBox.Width());
     Footprint.Footprint.Height                    = StaticCast<UINT>(DstBox.Height());
     Footprint.Footprint.Depth                     = StaticCast<UINT>(DstBox.Depth()); // Depth cannot be 0
-    Footprint.Footprint.Format                    = TexFormatToDXGI_Format(TexDesc.Format);
+    Footprint.Footprint.Format                    = TexFormatToDXGI_Format(TextureD3D12.GetDesc().Format);
 
     Footprint.Footprint.RowPitch = StaticCast<UINT>(SrcStride);
 
-#ifdef DILIGENT_DEBUG
-    {
-        const auto&  FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
-        const Uint32 RowCount   = std::max((Footprint.Footprint.Height / FmtAttribs.BlockHeight), 1u);
-        VERIFY(BufferSize >= Uint64{Footprint.Footprint.RowPitch} * RowCount * Footprint.Footprint.Depth, "Buffer is not large enough");
-        VERIFY(Footprint.Footprint.Depth == 1 || StaticCast<UINT>(SrcDepthStride) == Footprint.Footprint.RowPitch * RowCount, "Depth stride must be equal to the size of 2D plane");
-    }
-#endif
-
     D3D12_BOX D3D12SrcBox;
     D3D12SrcBox.left   = 0;
     D3D12SrcBox.right  = Footprint.Footprint.Width;
@@ -2029,14 +2170,43 @@ void DeviceContextD3D12Impl::CopyTextureRegion(ID3D12Resource*                pd
     D3D12SrcBox.bottom = Footprint.Footprint.Height;
     D3D12SrcBox.front  = 0;
     D3D12SrcBox.back   = Footprint.Footprint.Depth;
-    CmdCtx.FlushResourceBarriers();
-    CmdCtx.GetCommandList()->CopyTextureRegion(&DstLocation,
-                                               StaticCast<UINT>(DstBox.MinX),
-                                               StaticCast<UINT>(DstBox.MinY),
-                                               StaticCast<UINT>(DstBox.MinZ),
-                                               &SrcLocation, &D3D12SrcBox);
+    GetCmdContext().GetCommandList()->CopyTextureRegion(&DstLocation,
+                                                        StaticCast<UINT>(DstBox.MinX),
+                                                        StaticCast<UINT>(DstBox.MinY),
+                                                        StaticCast<UINT>(DstBox.MinZ),
+                                                        &SrcLocation, &D3D12SrcBox);
 
     ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::CopyTextureRegion(ID3D12Resource*                pd3d12Buffer,
+                                               Uint64                         SrcOffset,
+                                               Uint64                         SrcStride,
+                                               Uint64                         SrcDepthStride,
+                                               Uint64                         BufferSize,
+                                               TextureD3D12Impl&              TextureD3D12,
+                                               Uint32                         DstSubResIndex,
+                                               const Box&                     DstBox,
+                                               RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    auto& CmdCtx = GetCmdContext();
+
+    D3D12_RESOURCE_BARRIER BarrierDesc;
+    const bool             StateTransitionRequired = GetTextureCopyDestBarrier(TextureD3D12, DstSubResIndex, TextureTransitionMode, BarrierDesc);
+    if (StateTransitionRequired)
+        CmdCtx.ResourceBarrier(BarrierDesc);
+
+#ifdef DILIGENT_DEBUG
+    {
+        const auto&  FmtAttribs = GetTextureFormatAttribs(TextureD3D12.GetDesc().Format);
+        const Uint32 RowCount   = std::max((DstBox.Height() / FmtAttribs.BlockHeight), 1u);
+        VERIFY(BufferSize >= SrcStride * RowCount * DstBox.Depth(), "Buffer is not large enough");
+        VERIFY(DstBox.Depth() == 1 || SrcDepthStride == SrcStride * RowCount, "Depth stride must be equal to the size of 2D plane");
+    }
+#endif
+
+    CmdCtx.FlushResourceBarriers();
+    RecordBufferToTextureCopy(pd3d12Buffer, SrcOffset, SrcStride, TextureD3D12, DstSubResIndex, DstBox);
 
     if (StateTransitionRequired)
     {
@@ -2079,10 +2249,10 @@ void DeviceContextD3D12Impl::CopyTextureRegion(IBuffer*                       pS
                       pBufferD3D12->GetDesc().Size, TextureD3D12, DstSubResIndex, DstBox, TextureTransitionMode);
 }
 
-DeviceContextD3D12Impl::TextureUploadSpace DeviceContextD3D12Impl::AllocateTextureUploadSpace(TEXTURE_FORMAT TexFmt,
-                                                                                              const Box&     Region)
+Uint64 DeviceContextD3D12Impl::GetTextureUploadLayout(TEXTURE_FORMAT      TexFmt,
+                                                     const Box&          Region,
+                                                     TextureUploadSpace& UploadSpace)
 {
-    TextureUploadSpace UploadSpace;
     VERIFY_EXPR(Region.IsValid());
     auto UpdateRegionWidth  = Region.Width();
     auto UpdateRegionHeight = Region.Height();
@@ -2103,27 +2273,31 @@ DeviceContextD3D12Impl::TextureUploadSpace DeviceContextD3D12Impl::AllocateTextu
         UploadSpace.RowCount = UpdateRegionHeight;
     }
     // RowPitch must be a multiple of 256 (aka. D3D12_TEXTURE_DATA_PITCH_ALIGNMENT)
-    UploadSpace.Stride        = (UploadSpace.RowSize + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1);
-    UploadSpace.DepthStride   = UploadSpace.RowCount * UploadSpace.Stride;
-    const auto MemorySize     = UpdateRegionDepth * UploadSpace.DepthStride;
-    UploadSpace.Allocation    = AllocateDynamicSpace(MemorySize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
-    UploadSpace.AlignedOffset = (UploadSpace.Allocation.Offset + (D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1)) & ~(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
-    UploadSpace.Region        = Region;
+    UploadSpace.Stride      = (UploadSpace.RowSize + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1) & ~(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1);
+    UploadSpace.DepthStride = UploadSpace.RowCount * UploadSpace.Stride;
+    UploadSpace.Region      = Region;
+
+    return UpdateRegionDepth * UploadSpace.DepthStride;
+}
+
+DeviceContextD3D12Impl::TextureUploadSpace DeviceContextD3D12Impl::AllocateTextureUploadSpace(TEXTURE_FORMAT TexFmt,
+                                                                                              const Box&     Region)
+{
+    TextureUploadSpace UploadSpace;
+    const auto         MemorySize = GetTextureUploadLayout(TexFmt, Region, UploadSpace);
+    UploadSpace.Allocation        = AllocateDynamicSpace(MemorySize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    UploadSpace.AlignedOffset     = (UploadSpace.Allocation.Offset + (D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1)) & ~(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
 
     return UploadSpace;
 }
 
-void DeviceContextD3D12Impl::UpdateTextureRegion(const void*                    pSrcData,
-                                                 Uint64                         SrcStride,
-                                                 Uint64                         SrcDepthStride,
-                                                 TextureD3D12Impl&              TextureD3D12,
-                                                 Uint32                         DstSubResIndex,
-                                                 const Box&                     DstBox,
-                                                 RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+void DeviceContextD3D12Impl::WriteTextureUploadData(const void*               pSrcData,
+                                                    Uint64                    SrcStride,
+                                                    Uint64                    SrcDepthStride,
+                                                    const TextureUploadSpace& UploadSpace,
+                                                    void*                     pDstData)
 {
-    const auto& TexDesc           = TextureD3D12.GetDesc();
-    auto        UploadSpace       = AllocateTextureUploadSpace(TexDesc.Format, DstBox);
-    auto        UpdateRegionDepth = DstBox.Depth();
+    const auto UpdateRegionDepth = UploadSpace.Region.Depth();
 #ifdef DILIGENT_DEBUG
     {
         VERIFY(SrcStride >= UploadSpace.RowSize, "Source data stride (", SrcStride, ") is below the image row size (", UploadSpace.RowSize, ")");
@@ -2131,8 +2305,6 @@ void DeviceContextD3D12Impl::UpdateTextureRegion(const void*
         VERIFY(UpdateRegionDepth == 1 || SrcDepthStride >= PlaneSize, "Source data depth stride (", SrcDepthStride, ") is below the image plane size (", PlaneSize, ")");
     }
 #endif
-    const auto AlignedOffset = UploadSpace.AlignedOffset;
-
     for (Uint32 DepthSlice = 0; DepthSlice < UpdateRegionDepth; ++DepthSlice)
     {
         for (Uint32 row = 0; row < UploadSpace.RowCount; ++row)
@@ -2140,11 +2312,27 @@ void DeviceContextD3D12Impl::UpdateTextureRegion(const void*
             const auto* pSrcPtr =
                 reinterpret_cast<const Uint8*>(pSrcData) + row * SrcStride + DepthSlice * SrcDepthStride;
             auto* pDstPtr =
-                reinterpret_cast<Uint8*>(UploadSpace.Allocation.CPUAddress) + (AlignedOffset - UploadSpace.Allocation.Offset) + row * UploadSpace.Stride + DepthSlice * UploadSpace.DepthStride;
+                reinterpret_cast<Uint8*>(pDstData) + row * UploadSpace.Stride + DepthSlice * UploadSpace.DepthStride;
 
             memcpy(pDstPtr, pSrcPtr, StaticCast<size_t>(UploadSpace.RowSize));
         }
     }
+}
+
+void DeviceContextD3D12Impl::UpdateTextureRegion(const void*                    pSrcData,
+                                                 Uint64                         SrcStride,
+                                                 Uint64                         SrcDepthStride,
+                                                 TextureD3D12Impl&              TextureD3D12,
+                                                 Uint32                         DstSubResIndex,
+                                                 const Box&                     DstBox,
+                                                 RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    const auto& TexDesc       = TextureD3D12.GetDesc();
+    auto        UploadSpace   = AllocateTextureUploadSpace(TexDesc.Format, DstBox);
+    const auto  AlignedOffset = UploadSpace.AlignedOffset;
+
+    WriteTextureUploadData(pSrcData, SrcStride, SrcDepthStride, UploadSpace,
+                           reinterpret_cast<Uint8*>(UploadSpace.Allocation.CPUAddress) + (AlignedOffset - UploadSpace.Allocation.Offset));
     CopyTextureRegion(UploadSpace.Allocation.pBuffer,
                       StaticCast<Uint32>(AlignedOffset),
                       UploadSpace.Stride,
@@ -2156,6 +2344,188 @@ void DeviceContextD3D12Impl::UpdateTextureRegion(const void*
                       TextureTransitionMode);
 }
 
+void DeviceContextD3D12Impl::UpdateTextures(const UpdateTextureAttribs* pUpdates, Uint32 NumUpdates)
+{
+    DEV_CHECK_ERR(pUpdates != nullptr || NumUpdates == 0, "pUpdates must not be null when NumUpdates is not zero");
+
+    struct BatchedUpdate
+    {
+        const UpdateTextureAttribs* pAttribs;
+        TextureD3D12Impl*           pTexD3D12;
+        Uint32                      DstSubResIndex;
+        TextureUploadSpace          Layout;
+        Uint64                      Offset;
+    };
+    std::vector<BatchedUpdate> Batch;
+    Batch.reserve(NumUpdates);
+
+    std::vector<D3D12_RESOURCE_BARRIER> Barriers;
+
+    auto FlushBatch = [&]() {
+        if (Batch.empty())
+            return;
+
+        // Write the data of all updates into a single upload allocation
+        Uint64 TotalSize = 0;
+        for (auto& Update : Batch)
+        {
+            Update.Offset = AlignUp(TotalSize, Uint64{D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT});
+            TotalSize     = Update.Offset + Update.Layout.Region.Depth() * Update.Layout.DepthStride;
+        }
+
+        const auto Allocation = AllocateDynamicSpace(TotalSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+        VERIFY((Allocation.Offset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT) == 0, "Dynamic allocation is not properly aligned");
+        for (const auto& Update : Batch)
+        {
+            const auto& SubresData = Update.pAttribs->SubresData;
+            WriteTextureUploadData(SubresData.pData, SubresData.Stride, SubresData.DepthStride, Update.Layout,
+                                   reinterpret_cast<Uint8*>(Allocation.CPUAddress) + Update.Offset);
+        }
+
+        // Transition all destination subresources with a single barrier batch
+        auto& CmdCtx = GetCmdContext();
+        for (const auto& Update : Batch)
+        {
+            D3D12_RESOURCE_BARRIER BarrierDesc;
+            if (!GetTextureCopyDestBarrier(*Update.pTexD3D12, Update.DstSubResIndex, Update.pAttribs->TextureTransitionMode, BarrierDesc))
+                continue;
+
+            // The same subresource may be updated more than once
+            const auto DuplicateIt = std::find_if(Barriers.begin(), Barriers.end(), [&BarrierDesc](const D3D12_RESOURCE_BARRIER& Barrier) {
+                return Barrier.Transition.pResource == BarrierDesc.Transition.pResource && Barrier.Transition.Subresource == BarrierDesc.Transition.Subresource;
+            });
+            if (DuplicateIt == Barriers.end())
+                Barriers.emplace_back(BarrierDesc);
+        }
+        for (const auto& Barrier : Barriers)
+            CmdCtx.ResourceBarrier(Barrier);
+        CmdCtx.FlushResourceBarriers();
+
+        for (const auto& Update : Batch)
+        {
+            RecordBufferToTextureCopy(Allocation.pBuffer, Allocation.Offset + Update.Offset, Update.Layout.Stride,
+                                      *Update.pTexD3D12, Update.DstSubResIndex, Update.Layout.Region);
+        }
+
+        // Return the subresources to their original states
+        for (auto& Barrier : Barriers)
+        {
+            std::swap(Barrier.Transition.StateBefore, Barrier.Transition.StateAfter);
+            CmdCtx.ResourceBarrier(Barrier);
+        }
+
+        Barriers.clear();
+        Batch.clear();
+    };
+
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update = pUpdates[i];
+        DEV_CHECK_ERR(Update.pTexture != nullptr, "pUpdates[", i, "].pTexture must not be null");
+        if (Update.pTexture == nullptr)
+            continue;
+
+        const Box DstBox = GetUpdateTextureBox(Update);
+        if (Update.SubresData.pSrcBuffer != nullptr)
+        {
+            // Preserve the order of the updates
+            FlushBatch();
+            UpdateTexture(Update.pTexture, Update.MipLevel, Update.Slice, DstBox, Update.SubresData, Update.SrcBufferTransitionMode, Update.TextureTransitionMode);
+            continue;
+        }
+
+        TDeviceContextBase::UpdateTexture(Update.pTexture, Update.MipLevel, Update.Slice, DstBox, Update.SubresData, Update.SrcBufferTransitionMode, Update.TextureTransitionMode);
+
+        auto*       pTexD3D12 = ClassPtrCast<TextureD3D12Impl>(Update.pTexture);
+        const auto& Desc      = pTexD3D12->GetDesc();
+        DEV_CHECK_ERR(Desc.Usage == USAGE_DEFAULT || Desc.Usage == USAGE_SPARSE,
+                      "Only USAGE_DEFAULT or USAGE_SPARSE textures should be updated with UpdateData()");
+
+        BatchedUpdate Batched{&Update, pTexD3D12, D3D12CalcSubresource(Update.MipLevel, Update.Slice, 0, Desc.MipLevels, Desc.GetArraySize()), {}, 0};
+        GetTextureUploadLayout(Desc.Format, AlignBoxToCompressedBlock(Desc.Format, DstBox), Batched.Layout);
+        Batch.emplace_back(std::move(Batched));
+    }
+
+    FlushBatch();
+}
+
+void DeviceContextD3D12Impl::CopyTextures(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+{
+    DEV_CHECK_ERR(pCopies != nullptr || NumCopies == 0, "pCopies must not be null when NumCopies is not zero");
+
+    std::vector<const CopyTextureAttribs*> Batch;
+    Batch.reserve(NumCopies);
+
+    auto FlushBatch = [&]() {
+        if (Batch.empty())
+            return;
+
+        // Transitions of all textures are flushed as a single barrier batch before the first copy
+        for (const auto* pCopy : Batch)
+        {
+            PrepareTextureCopy(*ClassPtrCast<TextureD3D12Impl>(pCopy->pSrcTexture), pCopy->SrcTextureTransitionMode,
+                               *ClassPtrCast<TextureD3D12Impl>(pCopy->pDstTexture), pCopy->DstTextureTransitionMode);
+        }
+
+        auto& CmdCtx = GetCmdContext();
+        CmdCtx.FlushResourceBarriers();
+        for (const auto* pCopy : Batch)
+        {
+            auto* pSrcTexD3D12 = ClassPtrCast<TextureD3D12Impl>(pCopy->pSrcTexture);
+            auto* pDstTexD3D12 = ClassPtrCast<TextureD3D12Impl>(pCopy->pDstTexture);
+
+            const auto& SrcTexDesc = pSrcTexD3D12->GetDesc();
+            const auto& DstTexDesc = pDstTexD3D12->GetDesc();
+
+            D3D12_BOX D3D12SrcBox, *pD3D12SrcBox = nullptr;
+            if (const auto* pSrcBox = pCopy->pSrcBox)
+            {
+                D3D12SrcBox.left   = pSrcBox->MinX;
+                D3D12SrcBox.right  = pSrcBox->MaxX;
+                D3D12SrcBox.top    = pSrcBox->MinY;
+                D3D12SrcBox.bottom = pSrcBox->MaxY;
+                D3D12SrcBox.front  = pSrcBox->MinZ;
+                D3D12SrcBox.back   = pSrcBox->MaxZ;
+                pD3D12SrcBox       = &D3D12SrcBox;
+            }
+
+            const auto SrcLocation = GetTextureCopyLocation(*pSrcTexD3D12, D3D12CalcSubresource(pCopy->SrcMipLevel, pCopy->SrcSlice, 0, SrcTexDesc.MipLevels, SrcTexDesc.GetArraySize()));
+            const auto DstLocation = GetTextureCopyLocation(*pDstTexD3D12, D3D12CalcSubresource(pCopy->DstMipLevel, pCopy->DstSlice, 0, DstTexDesc.MipLevels, DstTexDesc.GetArraySize()));
+            CmdCtx.GetCommandList()->CopyTextureRegion(&DstLocation, pCopy->DstX, pCopy->DstY, pCopy->DstZ, &SrcLocation, pD3D12SrcBox);
+            ++m_State.NumCommands;
+        }
+
+        Batch.clear();
+    };
+
+    for (Uint32 i = 0; i < NumCopies; ++i)
+    {
+        const auto& Copy = pCopies[i];
+        if (Copy.pSrcTexture == nullptr || Copy.pDstTexture == nullptr || Copy.pSrcTexture == Copy.pDstTexture)
+        {
+            // Copies within the same texture are not batched
+            FlushBatch();
+            CopyTexture(Copy);
+            continue;
+        }
+
+        // A texture can't be in the copy source and copy destination states at the same time
+        for (const auto* pBatched : Batch)
+        {
+            if (pBatched->pDstTexture == Copy.pSrcTexture || pBatched->pSrcTexture == Copy.pDstTexture)
+            {
+                FlushBatch();
+                break;
+            }
+        }
+
+        TDeviceContextBase::CopyTexture(Copy);
+        Batch.emplace_back(&Copy);
+    }
+
+    FlushBatch();
+}
+
 void DeviceContextD3D12Impl::MapTextureSubresource(ITexture*                 pTexture,
                                                    Uint32                    MipLevel,
                                                    Uint32                    ArraySlice,
@@ -2311,8 +2681,8 @@ void DeviceContextD3D12Impl::GenerateMips(ITextureView* pTexView)
 
     auto& Ctx = GetCmdContext();
 
-    const auto& MipsGenerator = m_pDevice->GetMipsGenerator();
-    MipsGenerator.GenerateMips(m_pDevice->GetD3D12Device(), ClassPtrCast<TextureViewD3D12Impl>(pTexView), Ctx);
+    auto& MipsGenerator = m_pDevice->GetMipsGenerator();
+    MipsGenerator.GenerateMips(ClassPtrCast<TextureViewD3D12Impl>(pTexView), Ctx);
     ++m_State.NumCommands;
 
     // Invalidate compute resources as they were set by the mips generator
@@ -2362,6 +2732,9 @@ void DeviceContextD3D12Impl::FinishCommandList(ICommandList** ppCommandList)
     DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
 
+    if (m_CurrCmdCtx)
+        m_Stats.BarrierCount += m_CurrCmdCtx->ExtractNumBarriers();
+
     CommandListD3D12Impl* pCmdListD3D12(NEW_RC_OBJ(m_CmdListAllocator, "CommandListD3D12Impl instance", CommandListD3D12Impl)(m_pDevice, this, std::move(m_CurrCmdCtx)));
     pCmdListD3D12->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
 
@@ -2503,9 +2876,15 @@ void DeviceContextD3D12Impl::TransitionResourceStates(Uint32 BarrierCount, const
         else
         {
             if (RefCntAutoPtr<TextureD3D12Impl> pTextureD3D12Impl{Barrier.pResource, IID_TextureD3D12})
+            {
+                pTextureD3D12Impl->MarkResidencyUsed();
                 CmdCtx.TransitionResource(*pTextureD3D12Impl, Barrier);
+            }
             else if (RefCntAutoPtr<BufferD3D12Impl> pBufferD3D12Impl{Barrier.pResource, IID_BufferD3D12})
+            {
+                pBufferD3D12Impl->MarkResidencyUsed();
                 CmdCtx.TransitionResource(*pBufferD3D12Impl, Barrier);
+            }
             else if (RefCntAutoPtr<BottomLevelASD3D12Impl> pBLASD3D12Impl{Barrier.pResource, IID_BottomLevelASD3D12})
                 CmdCtx.TransitionResource(*pBLASD3D12Impl, Barrier);
             else if (RefCntAutoPtr<TopLevelASD3D12Impl> pTLASD3D12Impl{Barrier.pResource, IID_TopLevelASD3D12})
@@ -2522,6 +2901,8 @@ void DeviceContextD3D12Impl::TransitionOrVerifyBufferState(CommandContext&
                                                            RESOURCE_STATE                 RequiredState,
                                                            const char*                    OperationName)
 {
+    Buffer.MarkResidencyUsed();
+
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         if (Buffer.IsInKnownState())
@@ -2539,17 +2920,29 @@ void DeviceContextD3D12Impl::TransitionOrVerifyTextureState(CommandContext&
                                                             TextureD3D12Impl&              Texture,
                                                             RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                             RESOURCE_STATE                 RequiredState,
-                                                            const char*                    OperationName)
+                                                            const char*                    OperationName,
+                                                            const TextureSubresourceRange* pRange)
 {
+    Texture.MarkResidencyUsed();
+
+    const bool UseSubresRange = pRange != nullptr && Texture.HasSubresourceStates();
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         if (Texture.IsInKnownState())
-            CmdCtx.TransitionResource(Texture, RequiredState);
+        {
+            if (UseSubresRange)
+                CmdCtx.TransitionResource(Texture, *pRange, RequiredState);
+            else
+                CmdCtx.TransitionResource(Texture, RequiredState);
+        }
     }
 #ifdef DILIGENT_DEVELOPMENT
     else if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
     {
-        DvpVerifyTextureState(Texture, RequiredState, OperationName);
+        if (UseSubresRange)
+            DvpVerifyTextureSubresourceState(Texture, *pRange, RequiredState, OperationName);
+        else
+            DvpVerifyTextureState(Texture, RequiredState, OperationName);
     }
 #endif
 }
@@ -2615,6 +3008,83 @@ ID3D12GraphicsCommandList* DeviceContextD3D12Impl::GetD3D12CommandList()
     return CmdCtx.GetCommandList();
 }
 
+void DeviceContextD3D12Impl::ExecuteIndirectCommands(const ExecuteIndirectCommandsAttribsD3D12& Attribs)
+{
+    const auto CPUTimer = SampleCPUTime();
+
+    DEV_CHECK_ERR(m_pPipelineState, "No pipeline state is bound");
+    DEV_CHECK_ERR(Attribs.pCommandSignature != nullptr, "Command signature must not be null");
+    DEV_CHECK_ERR(Attribs.pArgsBuffer != nullptr, "Arguments buffer must not be null");
+    DEV_CHECK_ERR((Attribs.ModifiedStates & INDIRECT_COMMAND_STATE_FLAG_D3D12_INDEX_BUFFER) == 0 || Attribs.IndexType == VT_UNDEFINED,
+                  "Index type must be VT_UNDEFINED when the command signature sets the index buffer");
+
+    const auto& PSODesc   = m_pPipelineState->GetDesc();
+    const bool  IsCompute = PSODesc.PipelineType == PIPELINE_TYPE_COMPUTE;
+    DEV_CHECK_ERR(IsCompute || PSODesc.PipelineType == PIPELINE_TYPE_GRAPHICS || PSODesc.PipelineType == PIPELINE_TYPE_MESH,
+                  "Indirect commands can only be executed with graphics, mesh or compute pipelines");
+    DEV_CHECK_ERR(!IsCompute || m_pActiveRenderPass == nullptr, "Indirect dispatch commands must be executed outside of render pass");
+
+    auto& CmdCtx = GetCmdContext();
+    if (IsCompute)
+    {
+        PrepareForDispatchCompute(CmdCtx.AsComputeContext());
+    }
+    else
+    {
+        auto& GraphCtx = CmdCtx.AsGraphicsContext();
+        if ((Attribs.ModifiedStates & INDIRECT_COMMAND_STATE_FLAG_D3D12_VERTEX_BUFFERS) != 0)
+        {
+            // Vertex buffers are set by the commands, so there is no need to commit them
+            m_State.bCommittedD3D12VBsUpToDate = true;
+        }
+
+        if (Attribs.IndexType != VT_UNDEFINED)
+            PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
+        else
+            PrepareForDraw(GraphCtx, Attribs.Flags);
+    }
+
+    ID3D12Resource* pd3d12ArgsBuff          = nullptr;
+    Uint64          BuffDataStartByteOffset = 0;
+    PrepareIndirectAttribsBuffer(CmdCtx, Attribs.pArgsBuffer, Attribs.ArgsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset,
+                                 "Indirect commands (DeviceContextD3D12Impl::ExecuteIndirectCommands)");
+
+    ID3D12Resource* pd3d12CountBuff              = nullptr;
+    Uint64          CountBuffDataStartByteOffset = 0;
+    if (Attribs.pCounterBuffer != nullptr)
+    {
+        PrepareIndirectAttribsBuffer(CmdCtx, Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode, pd3d12CountBuff, CountBuffDataStartByteOffset,
+                                     "Counter buffer (DeviceContextD3D12Impl::ExecuteIndirectCommands)");
+    }
+
+    if (Attribs.MaxCommandCount > 0)
+    {
+        CmdCtx.ExecuteIndirect(Attribs.pCommandSignature,
+                               Attribs.MaxCommandCount,
+                               pd3d12ArgsBuff,
+                               Attribs.ArgsByteOffset + BuffDataStartByteOffset,
+                               pd3d12CountBuff,
+                               pd3d12CountBuff != nullptr ? Attribs.CounterOffset + CountBuffDataStartByteOffset : 0);
+        ++m_State.NumCommands;
+    }
+
+    // The commands may have overwritten the states that the context tracks,
+    // so make sure they are committed anew by the next draw or dispatch command.
+    if ((Attribs.ModifiedStates & INDIRECT_COMMAND_STATE_FLAG_D3D12_VERTEX_BUFFERS) != 0)
+    {
+        m_State.bCommittedD3D12VBsUpToDate = false;
+    }
+    if ((Attribs.ModifiedStates & INDIRECT_COMMAND_STATE_FLAG_D3D12_INDEX_BUFFER) != 0)
+    {
+        m_State.CommittedD3D12IndexBuffer = nullptr;
+        m_State.bCommittedD3D12IBUpToDate = false;
+    }
+    if ((Attribs.ModifiedStates & INDIRECT_COMMAND_STATE_FLAG_D3D12_ROOT_ARGUMENTS) != 0)
+    {
+        GetRootTableInfo(PSODesc.PipelineType).MakeAllStale();
+    }
+}
+
 void DeviceContextD3D12Impl::ResolveTextureSubresource(ITexture*                               pSrcTexture,
                                                        ITexture*                               pDstTexture,
                                                        const ResolveTextureSubresourceAttribs& ResolveAttribs)
@@ -2838,7 +3308,7 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
         for (Uint32 i = 0; i < Attribs.InstanceCount; ++i)
         {
             const auto& Inst     = Attribs.pInstances[i];
-            const auto  InstDesc = pTLASD3D12->GetInstanceDesc(Inst.InstanceName);
+            const auto  InstDesc = pTLASD3D12->GetInstanceDesc(Inst.InstanceName, i);
 
             if (InstDesc.InstanceIndex >= Attribs.InstanceCount)
             {
@@ -3043,16 +3513,16 @@ void DeviceContextD3D12Impl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIn
 
         // Buffer ranges do not intersect, so we don't need to add barriers between them
         if (RayGenShaderRecord.pData)
-            UpdateBuffer(pSBTBufferD3D12, RayGenShaderRecord.Offset, RayGenShaderRecord.Size, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferD3D12, RayGenShaderRecord.UpdateOffset, RayGenShaderRecord.UpdateSize, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (MissShaderTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, MissShaderTable.Offset, MissShaderTable.Size, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferD3D12, MissShaderTable.UpdateOffset, MissShaderTable.UpdateSize, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (HitGroupTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, HitGroupTable.Offset, HitGroupTable.Size, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferD3D12, HitGroupTable.UpdateOffset, HitGroupTable.UpdateSize, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (CallableShaderTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, CallableShaderTable.Offset, CallableShaderTable.Size, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferD3D12, CallableShaderTable.UpdateOffset, CallableShaderTable.UpdateSize, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         TransitionOrVerifyBufferState(CmdCtx, *pSBTBufferD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_RAY_TRACING, OpName);
     }
@@ -3219,4 +3689,80 @@ void DeviceContextD3D12Impl::BindSparseResourceMemory(const BindSparseResourceMe
     UnlockCommandQueue();
 }
 
+void DeviceContextD3D12Impl::ResolveQueries(const ResolveQueriesAttribs& Attribs)
+{
+    TDeviceContextBase::ResolveQueries(Attribs, 0);
+
+    if (Attribs.NumQueries == 0)
+        return;
+
+    auto& QueryMgr = GetQueryManager();
+    auto& CmdCtx   = GetCmdContext();
+
+    BufferD3D12Impl* pDstBufferD3D12 = ClassPtrCast<BufferD3D12Impl>(Attribs.pDstBuffer);
+    TransitionOrVerifyBufferState(CmdCtx, *pDstBufferD3D12, Attribs.DstBufferTransitionMode, RESOURCE_STATE_COPY_DEST,
+                                  "Resolving queries (DeviceContextD3D12Impl::ResolveQueries)");
+
+    Uint64          DataStartByteOffset = 0;
+    ID3D12Resource* pd3d12DstBuffer     = pDstBufferD3D12->GetD3D12Buffer(DataStartByteOffset, this);
+    CmdCtx.FlushResourceBarriers();
+
+    // Queries of the same type that occupy consecutive slots of the heap are resolved by a single command
+    for (Uint32 Start = 0; Start < Attribs.NumQueries;)
+    {
+        const QueryD3D12Impl* pFirstQuery = ClassPtrCast<const QueryD3D12Impl>(Attribs.ppQueries[Start]);
+        const QUERY_TYPE      QueryType   = pFirstQuery->GetDesc().Type;
+        const Uint32          FirstIdx    = pFirstQuery->GetQueryHeapIndex(0);
+
+        Uint32 Count = 1;
+        while (Start + Count < Attribs.NumQueries)
+        {
+            const QueryD3D12Impl* pQuery = ClassPtrCast<const QueryD3D12Impl>(Attribs.ppQueries[Start + Count]);
+            if (pQuery->GetDesc().Type != QueryType || pQuery->GetQueryHeapIndex(0) != FirstIdx + Count)
+                break;
+            ++Count;
+        }
+
+        CmdCtx.ResolveQueryData(QueryMgr.GetQueryHeap(QueryType), QueryTypeToD3D12QueryType(QueryType), FirstIdx, Count,
+                                pd3d12DstBuffer, DataStartByteOffset + Attribs.DstOffset + Uint64{Start} * sizeof(Uint64));
+        ++m_State.NumCommands;
+
+        Start += Count;
+    }
+}
+
+void DeviceContextD3D12Impl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    TDeviceContextBase::BeginConditionalRendering(Attribs, 0);
+
+    auto& CmdCtx = GetCmdContext();
+
+    // RESOURCE_STATE_INDIRECT_ARGUMENT is the same as D3D12_RESOURCE_STATE_PREDICATION
+    BufferD3D12Impl* pBufferD3D12 = ClassPtrCast<BufferD3D12Impl>(Attribs.pBuffer);
+    TransitionOrVerifyBufferState(CmdCtx, *pBufferD3D12, Attribs.BufferTransitionMode, RESOURCE_STATE_INDIRECT_ARGUMENT,
+                                  "Beginning conditional rendering (DeviceContextD3D12Impl::BeginConditionalRendering)");
+
+    Uint64          DataStartByteOffset = 0;
+    ID3D12Resource* pd3d12Buffer        = pBufferD3D12->GetD3D12Buffer(DataStartByteOffset, this);
+    CmdCtx.FlushResourceBarriers();
+
+    // D3D12_PREDICATION_OP_EQUAL_ZERO skips the commands if the value is zero
+    CmdCtx.SetPredication(pd3d12Buffer, DataStartByteOffset + Attribs.Offset,
+                          Attribs.Inverted ? D3D12_PREDICATION_OP_NOT_EQUAL_ZERO : D3D12_PREDICATION_OP_EQUAL_ZERO);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::EndConditionalRendering()
+{
+    TDeviceContextBase::EndConditionalRendering(0);
+
+    GetCmdContext().SetPredication(nullptr, 0, D3D12_PREDICATION_OP_EQUAL_ZERO);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::SetDynamicRenderState(const DynamicRenderState& State)
+{
+    UNSUPPORTED("SetDynamicRenderState is not supported in Direct3D12");
+}
+
 } // namespace Diligent
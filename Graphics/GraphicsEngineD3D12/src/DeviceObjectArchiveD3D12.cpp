@@ -42,8 +42,25 @@ bool PRSSerializerD3D12<Mode>::SerializeInternalData(
     return PRSSerializer<Mode>::template SerializeInternalData<PipelineResourceSignatureInternalDataD3D12>(Ser, InternalData, Allocator);
 }
 
+template <SerializerMode Mode>
+bool ShaderD3D12Serializer<Mode>::SerializeBytecode(Serializer<Mode>&  Ser,
+                                                   VoidPtr            pBytecode,
+                                                   ConstQual<size_t>& BytecodeSize,
+                                                   VoidPtr            pResources,
+                                                   ConstQual<size_t>& ResourcesSize)
+{
+    if (!Ser.SerializeBytes(pBytecode, BytecodeSize))
+        return false;
+
+    return Ser.SerializeBytes(pResources, ResourcesSize);
+}
+
 template struct PRSSerializerD3D12<SerializerMode::Read>;
 template struct PRSSerializerD3D12<SerializerMode::Write>;
 template struct PRSSerializerD3D12<SerializerMode::Measure>;
 
+template struct ShaderD3D12Serializer<SerializerMode::Read>;
+template struct ShaderD3D12Serializer<SerializerMode::Write>;
+template struct ShaderD3D12Serializer<SerializerMode::Measure>;
+
 } // namespace Diligent
@@ -268,7 +268,8 @@ void ValidateD3D12CreateInfo(const EngineD3D12CreateInfo& EngineCI) noexcept(fal
 
 RefCntAutoPtr<CommandQueueD3D12Impl> CreateCommandQueueD3D12(ID3D12Device*       pd3d12Device,
                                                              ID3D12CommandQueue* pd3d12Queue,
-                                                             LPCWSTR             FenceName)
+                                                             LPCWSTR             FenceName,
+                                                             Uint32              SubmitBatchSize = 0)
 {
 
     CComPtr<ID3D12Fence> pd3d12Fence;
@@ -278,7 +279,7 @@ RefCntAutoPtr<CommandQueueD3D12Impl> CreateCommandQueueD3D12(ID3D12Device*
     hr = pd3d12Fence->SetName(FenceName);
     VERIFY_EXPR(SUCCEEDED(hr));
 
-    return RefCntAutoPtr<CommandQueueD3D12Impl>{NEW_RC_OBJ(GetRawAllocator(), "CommandQueueD3D12 instance", CommandQueueD3D12Impl)(pd3d12Queue, pd3d12Fence)};
+    return RefCntAutoPtr<CommandQueueD3D12Impl>{NEW_RC_OBJ(GetRawAllocator(), "CommandQueueD3D12 instance", CommandQueueD3D12Impl)(pd3d12Queue, pd3d12Fence, SubmitBatchSize)};
 }
 
 } // namespace
@@ -490,7 +491,7 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
             hr = pd3d12CmdQueue->SetName(WidenString(ContextCI.Name).c_str());
             VERIFY_EXPR(SUCCEEDED(hr));
 
-            auto pCmdQueueD3D12 = Diligent::CreateCommandQueueD3D12(d3d12Device, pd3d12CmdQueue, (WidenString(ContextCI.Name) + L" Fence").c_str());
+            auto pCmdQueueD3D12 = Diligent::CreateCommandQueueD3D12(d3d12Device, pd3d12CmdQueue, (WidenString(ContextCI.Name) + L" Fence").c_str(), EngineCI.SubmitBatchSize);
             CmdQueueD3D12Refs.push_back(pCmdQueueD3D12);
             CmdQueues.push_back(pCmdQueueD3D12);
         };
@@ -771,6 +772,8 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
             if (AdapterInfo.Type != ADAPTER_TYPE_SOFTWARE && (DataArch.UMA || DataArch.CacheCoherentUMA))
                 AdapterInfo.Type = ADAPTER_TYPE_INTEGRATED;
         }
+
+        AdapterInfo.NumNodes = d3d12Device->GetNodeCount();
     }
 
     // Set queue info
@@ -947,6 +950,8 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
             {
                 if (d3d12Features3.CopyQueueTimestampQueriesSupported)
                     Features.TransferQueueTimestampQueries = DEVICE_FEATURE_STATE_ENABLED;
+                if (d3d12Features3.ViewInstancingTier != D3D12_VIEW_INSTANCING_TIER_NOT_SUPPORTED)
+                    Features.MultiView = DEVICE_FEATURE_STATE_ENABLED;
             }
 
             D3D12_FEATURE_DATA_D3D12_OPTIONS4 d3d12Features4{};
@@ -1121,7 +1126,7 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
         ASSERT_SIZEOF(DrawCommandProps, 12, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
     }
 
-    ASSERT_SIZEOF(DeviceFeatures, 47, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(DeviceFeatures, 50, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
     return AdapterInfo;
 }
@@ -29,8 +29,6 @@
 
 #include "FenceD3D12Impl.hpp"
 
-#include <thread>
-
 #include "WinHPreface.h"
 #include <atlbase.h>
 #include "WinHPostface.h"
@@ -44,18 +42,15 @@ namespace Diligent
 FenceD3D12Impl::FenceD3D12Impl(IReferenceCounters*    pRefCounters,
                                RenderDeviceD3D12Impl* pDevice,
                                const FenceDesc&       Desc) :
-    TFenceBase{pRefCounters, pDevice, Desc},
-    m_FenceCompleteEvent //
-    {
-        CreateEvent(NULL,  // default security attributes
-                    TRUE,  // manual-reset event
-                    FALSE, // initial state is nonsignaled
-                    NULL)  // object name
-    }
+    TFenceBase{pRefCounters, pDevice, Desc}
 {
-    VERIFY(m_FenceCompleteEvent != NULL, "Failed to create fence complete event");
+    auto Flags = D3D12_FENCE_FLAG_NONE;
+    if (m_Desc.Type == FENCE_TYPE_GENERAL && pDevice->GetNumImmediateContexts() > 1)
+        Flags = D3D12_FENCE_FLAG_SHARED;
+    // Exportable fences must be shared, so that ID3D12Device::CreateSharedHandle() can open them in another API or process
+    if (m_Desc.Flags & FENCE_FLAG_EXPORTABLE)
+        Flags = D3D12_FENCE_FLAG_SHARED;
 
-    const auto  Flags        = (m_Desc.Type == FENCE_TYPE_GENERAL && pDevice->GetNumImmediateContexts() > 1) ? D3D12_FENCE_FLAG_SHARED : D3D12_FENCE_FLAG_NONE;
     auto* const pd3d12Device = pDevice->GetD3D12Device();
     auto        hr           = pd3d12Device->CreateFence(0, Flags, __uuidof(m_pd3d12Fence), reinterpret_cast<void**>(static_cast<ID3D12Fence**>(&m_pd3d12Fence)));
     CHECK_D3D_RESULT_THROW(hr, "Failed to create D3D12 fence");
@@ -67,10 +62,6 @@ FenceD3D12Impl::~FenceD3D12Impl()
 {
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Fence), ~0ull);
-    if (m_FenceCompleteEvent != NULL)
-    {
-        CloseHandle(m_FenceCompleteEvent);
-    }
 }
 
 Uint64 FenceD3D12Impl::GetCompletedValue()
@@ -90,20 +81,70 @@ void FenceD3D12Impl::Signal(Uint64 Value)
 }
 
 void FenceD3D12Impl::Wait(Uint64 Value)
+{
+    WaitWithTimeout(Value, FenceWaitTimeout::Infinite);
+}
+
+Bool FenceD3D12Impl::WaitWithTimeout(Uint64 Value, Uint64 Timeout)
 {
     if (GetCompletedValue() >= Value)
-        return;
+        return True;
+
+    // The fence may be signaled after the command lists that are still batched by a command queue
+    GetDevice()->FlushBatchedSubmits();
+
+    if (Timeout == 0)
+        return False;
 
-    if (m_FenceCompleteEvent != NULL)
+    if (Timeout == FenceWaitTimeout::Infinite)
     {
-        m_pd3d12Fence->SetEventOnCompletion(Value, m_FenceCompleteEvent);
-        WaitForSingleObject(m_FenceCompleteEvent, INFINITE);
+        // When the event handle is null, SetEventOnCompletion() blocks
+        // the calling thread until the fence reaches the value.
+        auto hr = m_pd3d12Fence->SetEventOnCompletion(Value, NULL);
+        DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to wait for the fence");
+        (void)hr;
+        return True;
     }
-    else
+
+    const HANDLE     hEvent = GetThreadWaitEvent();
+    FenceWaitTimeout WaitTimeout{Timeout};
+    while (GetCompletedValue() < Value)
     {
-        while (GetCompletedValue() < Value)
-            std::this_thread::sleep_for(std::chrono::microseconds{1});
+        const Uint64 Remaining = WaitTimeout.GetRemaining();
+        if (Remaining == 0)
+            return False;
+
+        m_pd3d12Fence->SetEventOnCompletion(Value, hEvent);
+        WaitForSingleObject(hEvent, TimeoutToMilliseconds(Remaining));
     }
+    return True;
+}
+
+HANDLE FenceD3D12Impl::GetThreadWaitEvent()
+{
+    struct ThreadEvent
+    {
+        const HANDLE hEvent = CreateEvent(NULL,  // default security attributes
+                                          FALSE, // auto-reset event
+                                          FALSE, // initial state is nonsignaled
+                                          NULL); // object name
+        ~ThreadEvent()
+        {
+            if (hEvent != NULL)
+                CloseHandle(hEvent);
+        }
+    };
+    static thread_local ThreadEvent Event;
+    VERIFY(Event.hEvent != NULL, "Failed to create fence wait event");
+    return Event.hEvent;
+}
+
+DWORD FenceD3D12Impl::TimeoutToMilliseconds(Uint64 Timeout)
+{
+    constexpr Uint64 NanosecondsPerMillisecond = 1000000;
+
+    const Uint64 Milliseconds = (Timeout / NanosecondsPerMillisecond) + (Timeout % NanosecondsPerMillisecond != 0 ? 1 : 0);
+    return Milliseconds < INFINITE ? static_cast<DWORD>(Milliseconds) : INFINITE - 1;
 }
 
 } // namespace Diligent
@@ -64,8 +64,55 @@
 
 namespace Diligent
 {
-GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
+GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device) :
+    m_pd3d12Device{pd3d12Device}
 {
+}
+
+GenerateMipsHelper::~GenerateMipsHelper()
+{
+    // The initialization task references this object
+    AsyncInitializer::Update(m_AsyncInitializer, /*WaitForCompletion = */ true);
+}
+
+void GenerateMipsHelper::Initialize(IThreadPool* pThreadPool) noexcept(false)
+{
+    if (pThreadPool == nullptr)
+    {
+        std::lock_guard<std::mutex> Lock{m_InitMtx};
+        CreatePipelineStates();
+        m_Initialized.store(true);
+        return;
+    }
+
+    m_AsyncInitializer = AsyncInitializer::Start(pThreadPool, [this](Uint32 ThreadId) {
+        std::lock_guard<std::mutex> Lock{m_InitMtx};
+        // GenerateMips() may have already created the pipeline states if the task was not started in time
+        if (m_Initialized.load())
+            return;
+
+        try
+        {
+            CreatePipelineStates();
+            m_Initialized.store(true);
+        }
+        catch (...)
+        {
+            // The error has already been logged. GenerateMips() will try again.
+        }
+    });
+}
+
+void GenerateMipsHelper::CreatePipelineStates() noexcept(false)
+{
+    // Release the objects left by a failed attempt
+    m_pGenerateMipsRS.Release();
+    for (Uint32 i = 0; i < _countof(m_pGenerateMipsLinearPSO); ++i)
+    {
+        m_pGenerateMipsLinearPSO[i].Release();
+        m_pGenerateMipsGammaPSO[i].Release();
+    }
+
     CD3DX12_ROOT_PARAMETER Params[3];
     Params[0].InitAsConstants(6, 0);
     CD3DX12_DESCRIPTOR_RANGE SRVRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
@@ -86,7 +133,7 @@ GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
 
     HRESULT hr = D3D12SerializeRootSignature(&RootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
 
-    hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pGenerateMipsRS), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pGenerateMipsRS)));
+    hr = m_pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pGenerateMipsRS), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pGenerateMipsRS)));
     CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature for mipmap generation");
 
     D3D12_COMPUTE_PIPELINE_STATE_DESC PSODesc = {};
@@ -95,14 +142,14 @@ GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
     PSODesc.NodeMask       = 0;
     PSODesc.Flags          = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-#define CreatePSO(PSO, ShaderByteCode)                                                                                                                                      \
-    do                                                                                                                                                                      \
-    {                                                                                                                                                                       \
-        PSODesc.CS.pShaderBytecode = ShaderByteCode;                                                                                                                        \
-        PSODesc.CS.BytecodeLength  = sizeof(ShaderByteCode);                                                                                                                \
-        hr                         = pd3d12Device->CreateComputePipelineState(&PSODesc, __uuidof(PSO), reinterpret_cast<void**>(static_cast<ID3D12PipelineState**>(&PSO))); \
-        CHECK_D3D_RESULT_THROW(hr, "Failed to create Pipeline state for mipmap generation");                                                                                \
-        PSO->SetName(L"Generate mips PSO");                                                                                                                                 \
+#define CreatePSO(PSO, ShaderByteCode)                                                                                                                                        \
+    do                                                                                                                                                                        \
+    {                                                                                                                                                                         \
+        PSODesc.CS.pShaderBytecode = ShaderByteCode;                                                                                                                          \
+        PSODesc.CS.BytecodeLength  = sizeof(ShaderByteCode);                                                                                                                  \
+        hr                         = m_pd3d12Device->CreateComputePipelineState(&PSODesc, __uuidof(PSO), reinterpret_cast<void**>(static_cast<ID3D12PipelineState**>(&PSO))); \
+        CHECK_D3D_RESULT_THROW(hr, "Failed to create Pipeline state for mipmap generation");                                                                                  \
+        PSO->SetName(L"Generate mips PSO");                                                                                                                                   \
     } while (false)
 
     CreatePSO(m_pGenerateMipsLinearPSO[0], g_pGenerateMipsLinearCS);
@@ -115,8 +162,28 @@ GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
     CreatePSO(m_pGenerateMipsGammaPSO[3], g_pGenerateMipsGammaOddCS);
 }
 
-void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx) const
+void GenerateMipsHelper::GenerateMips(TextureViewD3D12Impl* pTexView, CommandContext& Ctx)
 {
+    if (!m_Initialized.load())
+    {
+        // If the asynchronous initialization is running, this waits for it to finish.
+        // If it has not started yet, the pipeline states are created here.
+        std::lock_guard<std::mutex> Lock{m_InitMtx};
+        if (!m_Initialized.load())
+        {
+            try
+            {
+                CreatePipelineStates();
+            }
+            catch (...)
+            {
+                // The error has already been logged
+                return;
+            }
+            m_Initialized.store(true);
+        }
+    }
+
     auto& ComputeCtx = Ctx.AsComputeContext();
     ComputeCtx.SetComputeRootSignature(m_pGenerateMipsRS);
     auto*       pTexD3D12 = pTexView->GetTexture<TextureD3D12Impl>();
@@ -138,15 +205,24 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
         return;
     }
 
-    if (pTexD3D12->GetState() == RESOURCE_STATE_UNDEFINED)
+    const bool HasSubresourceStates = pTexD3D12->HasSubresourceStates();
+    const auto ViewSubresRange      = pTexD3D12->GetViewSubresourceRange(ViewDesc);
+    if (HasSubresourceStates)
+    {
+        // Subresources of the view may be in different states. Bring them to shader resource state;
+        // subresources outside of the view are not affected.
+        Ctx.TransitionResource(*pTexD3D12, ViewSubresRange, RESOURCE_STATE_SHADER_RESOURCE);
+    }
+    else if (pTexD3D12->GetState() == RESOURCE_STATE_UNDEFINED)
     {
         // If texture state is undefined, transition it to shader resource state.
         // We need all subresources to be in a defined state at the end of the procedure.
         Ctx.TransitionResource(*pTexD3D12, RESOURCE_STATE_SHADER_RESOURCE);
     }
 
-    const auto OriginalState = pTexD3D12->GetState();
-    pTexD3D12->SetState(RESOURCE_STATE_UNKNOWN); // Switch to manual state management
+    const auto OriginalState = HasSubresourceStates ? RESOURCE_STATE_SHADER_RESOURCE : pTexD3D12->GetState();
+    if (!HasSubresourceStates)
+        pTexD3D12->SetState(RESOURCE_STATE_UNKNOWN); // Switch to manual state management
 
     // If we are processing the entire texture, we will leave it in SHADER_RESOURCE layout.
     // Otherwise we will transition affected subresources back to original layout.
@@ -225,7 +301,7 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
         for (Uint32 u = 0; u < MaxMipsHandledByCS; ++u)
             SrcDescriptorRanges[1 + u] = pTexView->GetMipLevelUAV(TopMip + std::min(u + 1, NumMips));
 
-        pd3d12Device->CopyDescriptors(1, &DstDescriptorRange, &DstRangeSize, 1 + MaxMipsHandledByCS, SrcDescriptorRanges, SrcRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        m_pd3d12Device->CopyDescriptors(1, &DstDescriptorRange, &DstRangeSize, 1 + MaxMipsHandledByCS, SrcDescriptorRanges, SrcRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
         // Transition top mip level to the shader resource state
         StateTransitionDesc SrcMipBarrier{pTexD3D12, TopMip == 0 ? OriginalState : RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_NONE};
@@ -275,6 +351,9 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
     }
 
     // Set state
-    pTexD3D12->SetState(FinalState);
+    if (HasSubresourceStates)
+        pTexD3D12->SetSubresourceState(ViewSubresRange, FinalState);
+    else
+        pTexD3D12->SetState(FinalState);
 }
 } // namespace Diligent
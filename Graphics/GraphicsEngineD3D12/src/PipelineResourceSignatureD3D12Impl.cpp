@@ -390,6 +390,10 @@ void PipelineResourceSignatureD3D12Impl::CopyStaticResources(ShaderResourceCache
     const auto  DstCacheType     = DstResourceCache.GetContentType();
     VERIFY_EXPR(SrcCacheType == ResourceCacheContentType::Signature);
 
+    // Static descriptors are gathered and copied into the GPU-visible tables with a single
+    // CopyDescriptors() call per heap type.
+    ShaderResourceCacheD3D12::DescriptorCopyBatch CopyBatch{d3d12Device};
+
     for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
     {
         const auto& ResDesc   = GetResourceDesc(r);
@@ -428,7 +432,7 @@ void PipelineResourceSignatureD3D12Impl::CopyStaticResources(ShaderResourceCache
             if (DstRes.pObject != SrcRes.pObject)
             {
                 DEV_CHECK_ERR(DstRes.pObject == nullptr, "Static resource has already been initialized, and the new resource does not match previously assigned resource.");
-                DstResourceCache.CopyResource(d3d12Device, DstRootIndex, DstCacheOffset, SrcRes);
+                DstResourceCache.CopyResource(d3d12Device, DstRootIndex, DstCacheOffset, SrcRes, &CopyBatch);
             }
             else
             {
@@ -438,6 +442,8 @@ void PipelineResourceSignatureD3D12Impl::CopyStaticResources(ShaderResourceCache
             }
         }
     }
+
+    CopyBatch.Flush();
 }
 
 void PipelineResourceSignatureD3D12Impl::CommitRootViews(const CommitCacheResourcesAttribs& CommitAttribs,
@@ -536,6 +542,15 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
     // Reserve space for DescriptorHeapAllocation objects (do NOT zero-out!)
     alignas(DescriptorHeapAllocation) uint8_t DynamicDescriptorAllocationsRawMem[sizeof(DescriptorHeapAllocation) * (D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1)];
 
+    // Dynamic descriptors previously committed by the context for the same resource cache contents
+    CommittedDynamicDescriptors* pCommitted = nullptr;
+    if (CommitAttribs.pCommittedDynamicDescriptors != nullptr &&
+        (m_RootParams.GetParameterGroupSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, ROOT_PARAMETER_GROUP_DYNAMIC) > 0 ||
+         m_RootParams.GetParameterGroupSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, ROOT_PARAMETER_GROUP_DYNAMIC) > 0))
+    {
+        pCommitted = &(*CommitAttribs.pCommittedDynamicDescriptors)[ResourceCache.GetRevision()];
+    }
+
     for (Uint32 heap_type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV; heap_type < D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1; ++heap_type)
     {
         const auto d3d12HeapType = static_cast<D3D12_DESCRIPTOR_HEAP_TYPE>(heap_type);
@@ -545,9 +560,23 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
         {
             auto& pAllocation = pDynamicDescriptorAllocations[d3d12HeapType];
 
-            // Create new DescriptorHeapAllocation in-place
-            pAllocation = new (&DynamicDescriptorAllocationsRawMem[sizeof(DescriptorHeapAllocation) * heap_type])
-                DescriptorHeapAllocation{CmdCtx.AllocateDynamicGPUVisibleDescriptor(d3d12HeapType, NumDynamicDescriptors)};
+            if (pCommitted != nullptr)
+            {
+                pAllocation = &pCommitted->Allocations[heap_type];
+                if (!pAllocation->IsNull())
+                {
+                    // The descriptors have not changed since they were last copied - reuse them
+                    VERIFY_EXPR(pAllocation->GetNumHandles() == NumDynamicDescriptors);
+                    continue;
+                }
+                *pAllocation = CmdCtx.AllocateDynamicGPUVisibleDescriptor(d3d12HeapType, NumDynamicDescriptors);
+            }
+            else
+            {
+                // Create new DescriptorHeapAllocation in-place
+                pAllocation = new (&DynamicDescriptorAllocationsRawMem[sizeof(DescriptorHeapAllocation) * heap_type])
+                    DescriptorHeapAllocation{CmdCtx.AllocateDynamicGPUVisibleDescriptor(d3d12HeapType, NumDynamicDescriptors)};
+            }
 
             DEV_CHECK_ERR(!pAllocation->IsNull(),
                           "Failed to allocate ", NumDynamicDescriptors, " dynamic GPU-visible ",
@@ -560,6 +589,8 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
             const auto& SrcDynamicAllocation = ResourceCache.GetDescriptorAllocation(d3d12HeapType, ROOT_PARAMETER_GROUP_DYNAMIC);
             VERIFY_EXPR(SrcDynamicAllocation.GetNumHandles() == NumDynamicDescriptors);
             pd3d12Device->CopyDescriptorsSimple(NumDynamicDescriptors, pAllocation->GetCpuHandle(), SrcDynamicAllocation.GetCpuHandle(), d3d12HeapType);
+            if (CommitAttribs.pDescriptorBytesCopied != nullptr)
+                *CommitAttribs.pDescriptorBytesCopied += Uint64{NumDynamicDescriptors} * pAllocation->GetDescriptorSize();
         }
     }
 
@@ -624,11 +655,15 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
         CommitRootViews(CommitAttribs, NonDynamicBuffersMask);
     }
 
-    // Manually destroy DescriptorHeapAllocation objects we created.
-    for (auto* pAllocation : pDynamicDescriptorAllocations)
+    // Manually destroy DescriptorHeapAllocation objects we created in-place.
+    // Allocations stored in the committed descriptors map are kept until the end of the frame.
+    if (pCommitted == nullptr)
     {
-        if (pAllocation != nullptr)
-            pAllocation->~DescriptorHeapAllocation();
+        for (auto* pAllocation : pDynamicDescriptorAllocations)
+        {
+            if (pAllocation != nullptr)
+                pAllocation->~DescriptorHeapAllocation();
+        }
     }
 }
 
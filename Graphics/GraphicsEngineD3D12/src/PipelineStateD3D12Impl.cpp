@@ -51,6 +51,9 @@
 #include "DynamicLinearAllocator.hpp"
 #include "D3DShaderResourceValidation.hpp"
 #include "DataBlobImpl.hpp"
+#include "ShaderCompilationProfiler.hpp"
+#include "PlatformMisc.hpp"
+#include "ThreadPool.hpp"
 
 #include "DXBCUtils.hpp"
 #include "DXCompiler.hpp"
@@ -91,6 +94,86 @@ struct alignas(void*) PSS_SubObject
 #    pragma warning(pop)
 #endif
 
+// View instancing can only be defined through the pipeline state stream
+void CreateViewInstancedGraphicsPipeline(ID3D12Device2*                            pd3d12Device2,
+                                         const D3D12_GRAPHICS_PIPELINE_STATE_DESC& d3d12PSODesc,
+                                         Uint32                                    ViewMask,
+                                         CComPtr<ID3D12DeviceChild>&               pd3d12PSO) noexcept(false)
+{
+    struct VIEW_INSTANCED_PIPELINE_STATE_DESC
+    {
+        PSS_SubObject<D3D12_PIPELINE_STATE_FLAGS, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS>                      Flags;
+        PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK>                                        NodeMask;
+        PSS_SubObject<ID3D12RootSignature*, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE>                   pRootSignature;
+        PSS_SubObject<D3D12_INPUT_LAYOUT_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_INPUT_LAYOUT>                  InputLayout;
+        PSS_SubObject<D3D12_INDEX_BUFFER_STRIP_CUT_VALUE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_IB_STRIP_CUT_VALUE> IBStripCutValue;
+        PSS_SubObject<D3D12_PRIMITIVE_TOPOLOGY_TYPE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PRIMITIVE_TOPOLOGY>      PrimitiveTopologyType;
+        PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VS>                              VS;
+        PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_GS>                              GS;
+        PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_HS>                              HS;
+        PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DS>                              DS;
+        PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS>                              PS;
+        PSS_SubObject<D3D12_BLEND_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND>                                BlendState;
+        PSS_SubObject<D3D12_DEPTH_STENCIL_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL>                DepthStencilState;
+        PSS_SubObject<D3D12_RASTERIZER_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER>                      RasterizerState;
+        PSS_SubObject<DXGI_SAMPLE_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC>                          SampleDesc;
+        PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK>                                      SampleMask;
+        PSS_SubObject<DXGI_FORMAT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT>                      DSVFormat;
+        PSS_SubObject<D3D12_RT_FORMAT_ARRAY, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS>           RTVFormatArray;
+        PSS_SubObject<D3D12_VIEW_INSTANCING_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VIEW_INSTANCING>            ViewInstancing;
+    };
+    VIEW_INSTANCED_PIPELINE_STATE_DESC d3d12StreamDesc = {};
+
+    d3d12StreamDesc.Flags                 = d3d12PSODesc.Flags;
+    d3d12StreamDesc.NodeMask              = d3d12PSODesc.NodeMask;
+    d3d12StreamDesc.pRootSignature        = d3d12PSODesc.pRootSignature;
+    d3d12StreamDesc.InputLayout           = d3d12PSODesc.InputLayout;
+    d3d12StreamDesc.IBStripCutValue       = d3d12PSODesc.IBStripCutValue;
+    d3d12StreamDesc.PrimitiveTopologyType = d3d12PSODesc.PrimitiveTopologyType;
+    d3d12StreamDesc.VS                    = d3d12PSODesc.VS;
+    d3d12StreamDesc.GS                    = d3d12PSODesc.GS;
+    d3d12StreamDesc.HS                    = d3d12PSODesc.HS;
+    d3d12StreamDesc.DS                    = d3d12PSODesc.DS;
+    d3d12StreamDesc.PS                    = d3d12PSODesc.PS;
+    d3d12StreamDesc.BlendState            = d3d12PSODesc.BlendState;
+    d3d12StreamDesc.DepthStencilState     = d3d12PSODesc.DepthStencilState;
+    d3d12StreamDesc.RasterizerState       = d3d12PSODesc.RasterizerState;
+    d3d12StreamDesc.SampleDesc            = d3d12PSODesc.SampleDesc;
+    d3d12StreamDesc.SampleMask            = d3d12PSODesc.SampleMask;
+    d3d12StreamDesc.DSVFormat             = d3d12PSODesc.DSVFormat;
+
+    d3d12StreamDesc.RTVFormatArray->NumRenderTargets = d3d12PSODesc.NumRenderTargets;
+    for (Uint32 rt = 0; rt < _countof(d3d12PSODesc.RTVFormats); ++rt)
+        d3d12StreamDesc.RTVFormatArray->RTFormats[rt] = d3d12PSODesc.RTVFormats[rt];
+
+    // Follow Vulkan multiview semantics: view instance N renders to array slice N of all render targets,
+    // and the instances that are not in the view mask are disabled by SetViewInstanceMask().
+    const Uint32 NumViews = PlatformMisc::GetMSB(ViewMask) + 1;
+    if (NumViews > D3D12_MAX_VIEW_INSTANCE_COUNT)
+    {
+        LOG_ERROR_AND_THROW("The view mask uses view ", NumViews - 1, ", but Direct3D12 only supports ", D3D12_MAX_VIEW_INSTANCE_COUNT, " view instances.");
+    }
+
+    std::array<D3D12_VIEW_INSTANCE_LOCATION, D3D12_MAX_VIEW_INSTANCE_COUNT> d3d12ViewLocations{};
+    for (Uint32 view = 0; view < NumViews; ++view)
+    {
+        d3d12ViewLocations[view].ViewportArrayIndex     = 0;
+        d3d12ViewLocations[view].RenderTargetArrayIndex = view;
+    }
+    d3d12StreamDesc.ViewInstancing->Flags                  = D3D12_VIEW_INSTANCING_FLAG_NONE;
+    d3d12StreamDesc.ViewInstancing->ViewInstanceCount      = NumViews;
+    d3d12StreamDesc.ViewInstancing->pViewInstanceLocations = d3d12ViewLocations.data();
+
+    D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+    streamDesc.SizeInBytes                   = sizeof(d3d12StreamDesc);
+    streamDesc.pPipelineStateSubobjectStream = &d3d12StreamDesc;
+
+    // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
+    HRESULT hr = pd3d12Device2->CreatePipelineState(&streamDesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&pd3d12PSO));
+    if (FAILED(hr))
+        LOG_ERROR_AND_THROW("Failed to create view-instanced pipeline state");
+}
+
 
 class PrimitiveTopology_To_D3D12_PRIMITIVE_TOPOLOGY_TYPE
 {
@@ -407,16 +490,22 @@ void PipelineStateD3D12Impl::RemapOrVerifyShaderResources(TShaderStages&
                                                           IDXCompiler*                                             pDxCompiler,
                                                           LocalRootSignatureD3D12*                                 pLocalRootSig,
                                                           const TValidateShaderResourcesFn&                        ValidateShaderResourcesFn,
-                                                          const TValidateShaderBindingsFn&                         VlidateBindingsFn) noexcept(false)
+                                                          const TValidateShaderBindingsFn&                         VlidateBindingsFn,
+                                                          IThreadPool*                                             pThreadPool) noexcept(false)
 {
+    // Resource binding maps are kept alive until all shaders are patched
+    std::vector<ResourceBinding::TMap> ResourceMaps(ShaderStages.size());
+
+    // Shaders whose byte code needs to be patched
+    std::vector<std::pair<size_t, size_t>> ShadersToPatch;
+
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
         const auto& Shaders    = ShaderStages[s].Shaders;
-        auto&       ByteCodes  = ShaderStages[s].ByteCodes;
         const auto  ShaderType = ShaderStages[s].Type;
 
-        bool                  HasImtblSamArray = false;
-        ResourceBinding::TMap ResourceMap;
+        bool                   HasImtblSamArray = false;
+        ResourceBinding::TMap& ResourceMap      = ResourceMaps[s];
         // Note that we must use signatures from m_ResourceSignatures for resource binding map,
         // because signatures from RootSig may have resources with different names.
         for (Uint32 sign = 0; sign < SignatureCount; ++sign)
@@ -471,33 +560,50 @@ void PipelineStateD3D12Impl::RemapOrVerifyShaderResources(TShaderStages&
                 ValidateShaderResourcesFn(pShader, pLocalRootSig);
 
             if (VlidateBindingsFn)
-            {
                 VlidateBindingsFn(pShader, ResourceMap);
-            }
             else
-            {
-                auto& pBytecode = ByteCodes[i];
-                if (IsDXILBytecode(pBytecode->GetConstDataPtr(), pBytecode->GetSize()))
-                {
-                    if (!pDxCompiler)
-                        LOG_ERROR_AND_THROW("DXC compiler does not exists, can not remap resource bindings");
-
-                    CComPtr<IDxcBlob> pPatchedBytecode;
-                    CComPtr<IDxcBlob> pDxcBytecode;
-                    CreateDxcBlobWrapper(pBytecode, &pDxcBytecode);
-                    if (!pDxCompiler->RemapResourceBindings(ResourceMap, pDxcBytecode, &pPatchedBytecode))
-                        LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
-                    pBytecode = DataBlobImpl::Create(pPatchedBytecode->GetBufferSize(), pPatchedBytecode->GetBufferPointer());
-                }
-                else
-                {
-                    pBytecode = DataBlobImpl::MakeCopy(pBytecode);
-                    if (!DXBCUtils::RemapResourceBindings(ResourceMap, pBytecode->GetDataPtr(), pBytecode->GetSize()))
-                        LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
-                }
-            }
+                ShadersToPatch.emplace_back(s, i);
         }
     }
+
+    // Patching the byte code is independent for every shader and is by far the most
+    // expensive part of the work for DXIL, so it is done after all validation is complete.
+    const auto PatchShader = [&](size_t Idx) {
+        const size_t s = ShadersToPatch[Idx].first;
+        const size_t i = ShadersToPatch[Idx].second;
+
+        const auto* const pShader     = ShaderStages[s].Shaders[i];
+        const auto&       ResourceMap = ResourceMaps[s];
+        auto&             pBytecode   = ShaderStages[s].ByteCodes[i];
+        if (IsDXILBytecode(pBytecode->GetConstDataPtr(), pBytecode->GetSize()))
+        {
+            if (!pDxCompiler)
+                LOG_ERROR_AND_THROW("DXC compiler does not exists, can not remap resource bindings");
+
+            CComPtr<IDxcBlob> pPatchedBytecode;
+            CComPtr<IDxcBlob> pDxcBytecode;
+            CreateDxcBlobWrapper(pBytecode, &pDxcBytecode);
+            if (!pDxCompiler->RemapResourceBindings(ResourceMap, pDxcBytecode, &pPatchedBytecode))
+                LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
+            pBytecode = DataBlobImpl::Create(pPatchedBytecode->GetBufferSize(), pPatchedBytecode->GetBufferPointer());
+        }
+        else
+        {
+            pBytecode = DataBlobImpl::MakeCopy(pBytecode);
+            if (!DXBCUtils::RemapResourceBindings(ResourceMap, pBytecode->GetDataPtr(), pBytecode->GetSize()))
+                LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
+        }
+    };
+
+    if (pThreadPool != nullptr && ShadersToPatch.size() > 1)
+    {
+        ProcessItemsInParallel(pThreadPool, ShadersToPatch.size(), PatchShader);
+    }
+    else
+    {
+        for (size_t Idx = 0; Idx < ShadersToPatch.size(); ++Idx)
+            PatchShader(Idx);
+    }
 }
 
 void PipelineStateD3D12Impl::InitRootSignature(const PipelineStateCreateInfo& CreateInfo,
@@ -550,7 +656,9 @@ void PipelineStateD3D12Impl::InitRootSignature(const PipelineStateCreateInfo& Cr
             [this](const ShaderD3D12Impl* pShader, const LocalRootSignatureD3D12* pLocalRootSig) {
                 ValidateShaderResources(pShader, pLocalRootSig);
             },
-            ValidateBindingsFn);
+            ValidateBindingsFn,
+            // Only split the work when the pipeline is created asynchronously
+            (CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 ? GetDevice()->GetShaderCompilationThreadPool() : nullptr);
     }
 }
 
@@ -764,12 +872,27 @@ void PipelineStateD3D12Impl::InitializePipeline(const GraphicsPipelineStateCreat
         // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
         d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-        // Try to load from the cache
+        const Uint32 ViewMask = GraphicsPipeline.pRenderPass != nullptr ?
+            GraphicsPipeline.pRenderPass->GetDesc().pSubpasses[GraphicsPipeline.SubpassIndex].ViewMask :
+            0;
+
+        // Try to load from the cache.
+        // Note that view-instanced pipelines are not cached as they can't be described by D3D12_GRAPHICS_PIPELINE_STATE_DESC.
         auto* const pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
-        if (pPSOCacheD3D12 != nullptr && !WName.empty())
+        if (pPSOCacheD3D12 != nullptr && !WName.empty() && ViewMask == 0)
+        {
             m_pd3d12PSO = pPSOCacheD3D12->LoadGraphicsPipeline(WName.c_str(), d3d12PSODesc);
-        if (!m_pd3d12PSO)
+            ShaderCompilationProfiler::AddCacheResult(m_pd3d12PSO != nullptr);
+        }
+        if (ViewMask != 0)
+        {
+            ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+            CreateViewInstancedGraphicsPipeline(m_pDevice->GetD3D12Device2(), d3d12PSODesc, ViewMask, m_pd3d12PSO);
+        }
+        else if (!m_pd3d12PSO)
         {
+            ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+
             // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
             HRESULT hr = pd3d12Device->CreateGraphicsPipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
             if (FAILED(hr))
@@ -858,6 +981,8 @@ void PipelineStateD3D12Impl::InitializePipeline(const GraphicsPipelineStateCreat
         streamDesc.pPipelineStateSubobjectStream = &d3d12PSODesc;
 
         auto* pd3d12Device2 = m_pDevice->GetD3D12Device2();
+
+        ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
         // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
         HRESULT hr = pd3d12Device2->CreatePipelineState(&streamDesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
         if (FAILED(hr))
@@ -907,9 +1032,14 @@ void PipelineStateD3D12Impl::InitializePipeline(const ComputePipelineStateCreate
     const auto  WName          = WidenString(m_Desc.Name);
     auto* const pPSOCacheD3D12 = ClassPtrCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
     if (pPSOCacheD3D12 != nullptr && !WName.empty())
+    {
         m_pd3d12PSO = pPSOCacheD3D12->LoadComputePipeline(WName.c_str(), d3d12PSODesc);
+        ShaderCompilationProfiler::AddCacheResult(m_pd3d12PSO != nullptr);
+    }
     if (!m_pd3d12PSO)
     {
+        ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+
         // Note: renderdoc frame capture fails if any interface but IID_ID3D12PipelineState is requested
         HRESULT hr = pd3d12Device->CreateComputePipelineState(&d3d12PSODesc, __uuidof(ID3D12PipelineState), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
         if (FAILED(hr))
@@ -950,9 +1080,13 @@ void PipelineStateD3D12Impl::InitializePipeline(const RayTracingPipelineStateCre
     RTPipelineDesc.NumSubobjects           = static_cast<UINT>(Subobjects.size());
     RTPipelineDesc.pSubobjects             = Subobjects.data();
 
-    HRESULT hr = pd3d12Device->CreateStateObject(&RTPipelineDesc, __uuidof(ID3D12StateObject), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
-    if (FAILED(hr))
-        LOG_ERROR_AND_THROW("Failed to create ray tracing state object");
+    {
+        ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+
+        HRESULT hr = pd3d12Device->CreateStateObject(&RTPipelineDesc, __uuidof(ID3D12StateObject), IID_PPV_ARGS_Helper(&m_pd3d12PSO));
+        if (FAILED(hr))
+            LOG_ERROR_AND_THROW("Failed to create ray tracing state object");
+    }
 
     // Extract shader identifiers from ray tracing pipeline and store them in ShaderHandles
     GetShaderIdentifiers(m_pd3d12PSO, CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex,
@@ -42,6 +42,7 @@
 #include "BufferD3D12Impl.hpp"
 #include "ShaderResourceBindingD3D12Impl.hpp"
 #include "DeviceContextD3D12Impl.hpp"
+#include "CommandQueueD3D12Impl.hpp"
 #include "FenceD3D12Impl.hpp"
 #include "QueryD3D12Impl.hpp"
 #include "RenderPassD3D12Impl.hpp"
@@ -161,11 +162,12 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
         {*this, D3D12_COMMAND_LIST_TYPE_COMPUTE},
         {*this, D3D12_COMMAND_LIST_TYPE_COPY}
     },
-    m_DynamicMemoryManager  {GetRawAllocator(), *this, EngineCI.NumDynamicHeapPagesToReserve, EngineCI.DynamicHeapPageSize},
-    m_MipsGenerator         {pd3d12Device},
-    m_pDxCompiler           {CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, EngineCI.pDxCompilerPath)},
-    m_RootSignatureAllocator{GetRawAllocator(), sizeof(RootSignatureD3D12), 128},
-    m_RootSignatureCache    {*this}
+    m_DynamicMemoryManager   {GetRawAllocator(), *this, EngineCI.NumDynamicHeapPagesToReserve, EngineCI.DynamicHeapPageSize},
+    m_PlacedResourceAllocator{GetRawAllocator(), pd3d12Device, EngineCI.PlacedResourceHeapSize, EngineCI.PlacedResourceMaxSize},
+    m_MipsGenerator          {pd3d12Device},
+    m_pDxCompiler            {CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, EngineCI.pDxCompilerPath)},
+    m_RootSignatureAllocator {GetRawAllocator(), sizeof(RootSignatureD3D12), 128},
+    m_RootSignatureCache     {*this}
 // clang-format on
 {
     m_DeviceInfo.Type = RENDER_DEVICE_TYPE_D3D12;
@@ -256,6 +258,15 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
         if (IsNvApiEnabled())
             m_pNVApiHeap = CreateDummyNVApiHeap(m_pd3d12Device);
 
+        {
+            CComPtr<IDXGIFactory4> pDXGIFactory;
+            if (SUCCEEDED(CreateDXGIFactory1(__uuidof(pDXGIFactory), reinterpret_cast<void**>(static_cast<IDXGIFactory4**>(&pDXGIFactory)))))
+                pDXGIFactory->EnumAdapterByLuid(m_pd3d12Device->GetAdapterLuid(), __uuidof(m_pDXGIAdapter3), reinterpret_cast<void**>(static_cast<IDXGIAdapter3**>(&m_pDXGIAdapter3)));
+        }
+
+        if (EngineCI.EnableResidencyManagement)
+            m_pResidencyMgr = std::make_unique<ResidencyManagerD3D12>(*this, EngineCI.ResidencyEvictionFrameThreshold);
+
         // Check PSO cache support
         {
             D3D12_FEATURE_DATA_SHADER_CACHE ShaderCacheFeature{};
@@ -267,6 +278,11 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
         }
 
         InitShaderCompilationThreadPool(EngineCI.pAsyncShaderCompilationThreadPool, EngineCI.NumAsyncShaderCompilationThreads);
+
+        // Create the mipmap generation pipelines on the shader compilation thread pool if it is available.
+        // Deferred pipelines are created by the first GenerateMips() call.
+        if (!EngineCI.DeferSubsystemInitialization)
+            m_MipsGenerator.Initialize(m_pShaderCompilationThreadPool);
     }
     catch (...)
     {
@@ -335,6 +351,69 @@ void RenderDeviceD3D12Impl::FreeCommandContext(PooledCommandContext&& Ctx)
 #endif
 }
 
+void RenderDeviceD3D12Impl::FreeSubmittedCommandContext(SoftwareQueueIndex CommandQueueId, PooledCommandContext&& Ctx)
+{
+    auto* pQueueD3D12 = m_CommandQueues[CommandQueueId].CmdQueue.RawPtr<CommandQueueD3D12Impl>();
+    if (!pQueueD3D12->IsSubmitBatchingEnabled())
+    {
+        FreeCommandContext(std::move(Ctx));
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> Guard{m_BatchedCtxMutex};
+        m_BatchedCtxs.emplace_back(CommandQueueId, std::move(Ctx));
+    }
+    // The queue may have submitted the batch when the list was added to it
+    ReleaseBatchedCommandContexts(CommandQueueId);
+}
+
+void RenderDeviceD3D12Impl::ReleaseBatchedCommandContexts(SoftwareQueueIndex CommandQueueId)
+{
+    auto* pQueueD3D12 = m_CommandQueues[CommandQueueId].CmdQueue.RawPtr<CommandQueueD3D12Impl>();
+
+    std::vector<PooledCommandContext> SubmittedCtxs;
+    {
+        // The mutex must be held while the queue is checked so that a context
+        // whose list is batched after the check is not released.
+        std::lock_guard<std::mutex> Guard{m_BatchedCtxMutex};
+        if (m_BatchedCtxs.empty() || pQueueD3D12->HasBatchedSubmits())
+            return;
+
+        for (auto it = m_BatchedCtxs.begin(); it != m_BatchedCtxs.end();)
+        {
+            if (it->first == CommandQueueId)
+            {
+                SubmittedCtxs.emplace_back(std::move(it->second));
+                it = m_BatchedCtxs.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (auto& pCtx : SubmittedCtxs)
+        FreeCommandContext(std::move(pCtx));
+}
+
+void RenderDeviceD3D12Impl::FlushBatchedSubmits(SoftwareQueueIndex CommandQueueId)
+{
+    auto* pQueueD3D12 = m_CommandQueues[CommandQueueId].CmdQueue.RawPtr<CommandQueueD3D12Impl>();
+    if (!pQueueD3D12->IsSubmitBatchingEnabled())
+        return;
+
+    pQueueD3D12->FlushBatchedSubmits();
+    ReleaseBatchedCommandContexts(CommandQueueId);
+}
+
+void RenderDeviceD3D12Impl::FlushBatchedSubmits()
+{
+    for (Uint32 q = 0; q < m_CmdQueueCount; ++q)
+        FlushBatchedSubmits(SoftwareQueueIndex{q});
+}
+
 void RenderDeviceD3D12Impl::CloseAndExecuteTransientCommandContext(SoftwareQueueIndex CommandQueueId, PooledCommandContext&& Ctx)
 {
     auto& CmdListMngr = GetCmdListManager(CommandQueueId);
@@ -350,8 +429,8 @@ void RenderDeviceD3D12Impl::CloseAndExecuteTransientCommandContext(SoftwareQueue
                        {
                            FenceValue = pCmdQueue->Submit(1, &pCmdList);
                        });
-    CmdListMngr.ReleaseAllocator(std::move(pAllocator), CommandQueueId, FenceValue);
-    FreeCommandContext(std::move(Ctx));
+    CmdListMngr.ReleaseAllocator(std::move(pAllocator), CommandQueueId, FenceValue, &Ctx->GetAllocatorRing());
+    FreeSubmittedCommandContext(CommandQueueId, std::move(Ctx));
 }
 
 Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex                                     CommandQueueId,
@@ -402,6 +481,9 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
         //                  |     with number N                      |                                   |
         if (pWaitFences != nullptr)
             WaitFences(CommandQueueId, *pWaitFences);
+        // Resources referenced by the command lists must be resident before the lists are executed
+        if (m_pResidencyMgr)
+            m_pResidencyMgr->MakeResidentPending();
         auto SubmittedCmdBuffInfo = TRenderDeviceBase::SubmitCommandBuffer(CommandQueueId, true, NumContexts, d3d12CmdLists.data());
         FenceValue                = SubmittedCmdBuffInfo.FenceValue;
         if (pSignalFences != nullptr)
@@ -410,8 +492,8 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
 
     for (Uint32 i = 0; i < NumContexts; ++i)
     {
-        CmdListMngr.ReleaseAllocator(std::move(CmdAllocators[i]), CommandQueueId, FenceValue);
-        FreeCommandContext(std::move(pContexts[i]));
+        CmdListMngr.ReleaseAllocator(std::move(CmdAllocators[i]), CommandQueueId, FenceValue, &pContexts[i]->GetAllocatorRing());
+        FreeSubmittedCommandContext(CommandQueueId, std::move(pContexts[i]));
     }
 
     PurgeReleaseQueue(CommandQueueId);
@@ -445,10 +527,92 @@ void RenderDeviceD3D12Impl::WaitFences(SoftwareQueueIndex CommandQueueId, std::v
 
 void RenderDeviceD3D12Impl::IdleGPU()
 {
+    FlushBatchedSubmits();
     IdleAllCommandQueues(true);
     ReleaseStaleResources();
 }
 
+Bool RenderDeviceD3D12Impl::WaitForFences(const WaitForFencesAttribs& Attribs)
+{
+    if (Attribs.NumFences == 0)
+        return True;
+    if (!VerifyWaitForFencesAttribs(Attribs))
+        return False;
+
+    FlushBatchedSubmits();
+
+    // SetEventOnMultipleFenceCompletion() requires ID3D12Device1
+    if (m_MaxD3D12DeviceVersion < 1)
+        return TRenderDeviceBase::WaitForFences(Attribs);
+
+    std::vector<ID3D12Fence*> d3d12Fences(Attribs.NumFences);
+    for (Uint32 i = 0; i < Attribs.NumFences; ++i)
+        d3d12Fences[i] = ClassPtrCast<FenceD3D12Impl>(Attribs.ppFences[i])->GetD3D12Fence();
+
+    auto IsComplete = [&]() {
+        for (Uint32 i = 0; i < Attribs.NumFences; ++i)
+        {
+            const bool FenceComplete = d3d12Fences[i]->GetCompletedValue() >= Attribs.pValues[i];
+            if (FenceComplete != (Attribs.WaitAll != False))
+                return FenceComplete;
+        }
+        return Attribs.WaitAll != False;
+    };
+
+    if (IsComplete())
+        return True;
+
+    if (Attribs.Timeout == 0)
+        return False;
+
+    ID3D12Device1* pd3d12Device1 = GetD3D12Device1();
+
+    const D3D12_MULTIPLE_FENCE_WAIT_FLAGS Flags = Attribs.WaitAll ? D3D12_MULTIPLE_FENCE_WAIT_FLAG_ALL : D3D12_MULTIPLE_FENCE_WAIT_FLAG_ANY;
+    if (Attribs.Timeout == FenceWaitTimeout::Infinite)
+    {
+        // When the event handle is null, the method blocks the calling thread until the wait condition is satisfied
+        auto hr = pd3d12Device1->SetEventOnMultipleFenceCompletion(d3d12Fences.data(), Attribs.pValues, Attribs.NumFences, Flags, NULL);
+        DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to wait for the fences");
+        (void)hr;
+        return True;
+    }
+
+    const HANDLE     hEvent = FenceD3D12Impl::GetThreadWaitEvent();
+    FenceWaitTimeout WaitTimeout{Attribs.Timeout};
+    while (!IsComplete())
+    {
+        const Uint64 Remaining = WaitTimeout.GetRemaining();
+        if (Remaining == 0)
+            return False;
+
+        pd3d12Device1->SetEventOnMultipleFenceCompletion(d3d12Fences.data(), Attribs.pValues, Attribs.NumFences, Flags, hEvent);
+        WaitForSingleObject(hEvent, FenceD3D12Impl::TimeoutToMilliseconds(Remaining));
+    }
+    return True;
+}
+
+void RenderDeviceD3D12Impl::GetMemoryStats(DeviceMemoryStats& Stats)
+{
+    Stats = DeviceMemoryStats{};
+
+    GetDXGIMemoryBudget(Stats);
+
+    // Placed resource heaps are default heaps that reside in the local segment group
+    PlacedResourceHeapStatsD3D12 PlacedStats;
+    m_PlacedResourceAllocator.GetStats(PlacedStats);
+    Stats.Heaps[0].Reserved = PlacedStats.HeapSize;
+    Stats.Heaps[0].Used     = PlacedStats.UsedSize;
+
+    m_DynamicMemoryManager.GetMemoryStats(Stats.DynamicMemoryReserved, Stats.DynamicMemoryUsed);
+
+    m_GPUDescriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV].GetStats(Stats.ShaderVisibleResourceDescriptors);
+    m_GPUDescriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER].GetStats(Stats.ShaderVisibleSamplerDescriptors);
+    for (auto& CPUHeap : m_CPUDescriptorHeaps)
+        CPUHeap.GetStats(Stats.CPUDescriptors);
+
+    GetReleaseQueueStats(Stats);
+}
+
 void RenderDeviceD3D12Impl::FlushStaleResources(SoftwareQueueIndex CommandQueueId)
 {
     // Submit empty command list to the queue. This will effectively signal the fence and
@@ -459,6 +623,46 @@ void RenderDeviceD3D12Impl::FlushStaleResources(SoftwareQueueIndex CommandQueueI
 void RenderDeviceD3D12Impl::ReleaseStaleResources(bool ForceRelease)
 {
     PurgeReleaseQueues(ForceRelease);
+
+    if (m_pResidencyMgr && !ForceRelease)
+        m_pResidencyMgr->Update();
+}
+
+void RenderDeviceD3D12Impl::SetResidencyPriority(IDeviceObject* pResource, D3D12_RESIDENCY_PRIORITY Priority)
+{
+    DEV_CHECK_ERR(pResource != nullptr, "Resource must not be null");
+
+    D3D12ResourceBase* pResourceD3D12 = nullptr;
+    bool               IsPlaced       = false;
+    if (RefCntAutoPtr<TextureD3D12Impl> pTextureD3D12{pResource, IID_TextureD3D12})
+    {
+        pResourceD3D12 = pTextureD3D12.RawPtr();
+        IsPlaced       = pTextureD3D12->IsPlaced();
+    }
+    else if (RefCntAutoPtr<BufferD3D12Impl> pBufferD3D12{pResource, IID_BufferD3D12})
+    {
+        pResourceD3D12 = pBufferD3D12.RawPtr();
+        IsPlaced       = pBufferD3D12->IsPlaced();
+    }
+    else
+    {
+        DEV_ERROR("Residency priority can only be set for buffers and textures");
+        return;
+    }
+
+    // Placed resources share the residency of their heap; dynamic buffers may not have a resource
+    ID3D12Pageable* pd3d12Pageable = pResourceD3D12->GetD3D12Resource();
+    if (IsPlaced || pd3d12Pageable == nullptr)
+        return;
+
+    if (auto* pEntry = pResourceD3D12->GetResidencyEntry())
+        m_pResidencyMgr->SetPriority(*pEntry, Priority);
+
+    if (CComQIPtr<ID3D12Device1> pd3d12Device1{m_pd3d12Device})
+    {
+        auto hr = pd3d12Device1->SetResidencyPriority(1, &pd3d12Pageable, &Priority);
+        LOG_D3D_ERROR(hr, "Failed to set residency priority");
+    }
 }
 
 
@@ -584,6 +788,25 @@ void RenderDeviceD3D12Impl::CreateShader(const ShaderCreateInfo& ShaderCI,
     CreateShaderImpl(ppShader, ShaderCI, D3D12ShaderCI);
 }
 
+void RenderDeviceD3D12Impl::CreateShader(const ShaderCreateInfo& ShaderCI,
+                                         const SerializedData&   SerializedResources,
+                                         IShader**               ppShader)
+{
+    DEV_CHECK_ERR(ShaderCI.ByteCode != nullptr, "Serialized resources can only be used with the shader bytecode");
+    const ShaderD3D12Impl::CreateInfo D3D12ShaderCI{
+        {
+            GetDeviceInfo(),
+            GetAdapterInfo(),
+            GetDxCompiler(),
+            nullptr,
+            m_pShaderCompilationThreadPool,
+        },
+        m_DeviceInfo.MaxShaderVersion.HLSL,
+        &SerializedResources,
+    };
+    CreateShaderImpl(ppShader, ShaderCI, D3D12ShaderCI);
+}
+
 void RenderDeviceD3D12Impl::CreateTextureFromD3DResource(ID3D12Resource* pd3d12Texture, RESOURCE_STATE InitialState, ITexture** ppTexture)
 {
     TextureDesc TexDesc;
@@ -0,0 +1,259 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ResidencyManagerD3D12.hpp"
+
+#include <algorithm>
+
+#include "RenderDeviceD3D12Impl.hpp"
+
+namespace Diligent
+{
+
+ResidencyManagerD3D12::ResidencyManagerD3D12(RenderDeviceD3D12Impl& Device, Uint32 EvictionFrameThreshold) :
+    // clang-format off
+    m_Device                {Device                              },
+    m_EvictionFrameThreshold{std::max(EvictionFrameThreshold, 1u)}
+// clang-format on
+{
+    CComPtr<IDXGIFactory4> pDXGIFactory;
+    if (SUCCEEDED(CreateDXGIFactory1(__uuidof(pDXGIFactory), reinterpret_cast<void**>(static_cast<IDXGIFactory4**>(&pDXGIFactory)))))
+    {
+        const auto AdapterLUID = Device.GetD3D12Device()->GetAdapterLuid();
+        pDXGIFactory->EnumAdapterByLuid(AdapterLUID, __uuidof(m_pDXGIAdapter), reinterpret_cast<void**>(static_cast<IDXGIAdapter3**>(&m_pDXGIAdapter)));
+    }
+
+    if (!m_pDXGIAdapter)
+        LOG_WARNING_MESSAGE("Failed to get IDXGIAdapter3 interface. Video memory budget will not be monitored and resources will not be evicted.");
+}
+
+ResidencyManagerD3D12::~ResidencyManagerD3D12()
+{
+    DEV_CHECK_ERR(m_Entries.empty(), m_Entries.size(), " resource(s) have not been unregistered from the residency manager");
+    for (auto* pEntry : m_Entries)
+        delete pEntry;
+}
+
+ResidencyManagerD3D12::Entry* ResidencyManagerD3D12::Register(ID3D12Resource* pd3d12Resource)
+{
+    VERIFY_EXPR(pd3d12Resource != nullptr);
+
+    const auto d3d12Desc = pd3d12Resource->GetDesc();
+    const auto AllocInfo = m_Device.GetD3D12Device()->GetResourceAllocationInfo(0, 1, &d3d12Desc);
+
+    auto* pEntry = new Entry{*this, pd3d12Resource, AllocInfo.SizeInBytes};
+    pEntry->LastUsedFrame.store(m_CurrentFrame.load());
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Entries.emplace(pEntry);
+    return pEntry;
+}
+
+void ResidencyManagerD3D12::Unregister(Entry* pEntry)
+{
+    VERIFY_EXPR(pEntry != nullptr && &pEntry->Mgr == this);
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        m_Entries.erase(pEntry);
+        if (pEntry->MakeResidentPending)
+        {
+            auto it = std::find(m_PendingEntries.begin(), m_PendingEntries.end(), pEntry);
+            VERIFY_EXPR(it != m_PendingEntries.end());
+            m_PendingEntries.erase(it);
+            m_NumPendingEntries.fetch_sub(1);
+        }
+        // Evicted resources may be released without making them resident
+    }
+    delete pEntry;
+}
+
+void ResidencyManagerD3D12::SetPriority(Entry& E, D3D12_RESIDENCY_PRIORITY Priority)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    E.Priority = Priority;
+}
+
+void ResidencyManagerD3D12::RequestMakeResident(Entry& E)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    // The eviction may have been cancelled or the resource may have already been queued
+    if (E.Evicted && !E.MakeResidentPending)
+    {
+        E.MakeResidentPending = true;
+        m_PendingEntries.emplace_back(&E);
+        m_NumPendingEntries.fetch_add(1);
+    }
+}
+
+void ResidencyManagerD3D12::MakeResidentPending()
+{
+    // Resources are queued while the command list is recorded, which happens before
+    // the command list is submitted, so the relaxed check is sufficient.
+    if (m_NumPendingEntries.load(std::memory_order_relaxed) == 0)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    std::vector<ID3D12Pageable*> Pageables;
+    Pageables.reserve(m_PendingEntries.size());
+    for (auto* pEntry : m_PendingEntries)
+    {
+        VERIFY_EXPR(pEntry->Evicted && pEntry->MakeResidentPending);
+        Pageables.emplace_back(pEntry->pPageable);
+        pEntry->Evicted             = false;
+        pEntry->MakeResidentPending = false;
+        pEntry->EvictionRequested.store(false);
+    }
+    m_PendingEntries.clear();
+    m_NumPendingEntries.store(0);
+
+    // MakeResident blocks until the resources are paged in
+    auto hr = m_Device.GetD3D12Device()->MakeResident(static_cast<UINT>(Pageables.size()), Pageables.data());
+    LOG_D3D_ERROR(hr, "Failed to make evicted resources resident");
+}
+
+void ResidencyManagerD3D12::Update()
+{
+    const auto NumQueues = m_Device.GetCommandQueueCount();
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    // Close the current frame
+    {
+        const auto Frame = m_CurrentFrame.load();
+
+        FrameFenceValues FrameFences;
+        FrameFences.Frame = Frame;
+        FrameFences.NextFenceValues.resize(NumQueues);
+        for (Uint32 q = 0; q < NumQueues; ++q)
+            FrameFences.NextFenceValues[q] = m_Device.GetNextFenceValue(SoftwareQueueIndex{q});
+        m_InFlightFrames.emplace_back(std::move(FrameFences));
+
+        m_CurrentFrame.store(Frame + 1);
+    }
+
+    while (!m_InFlightFrames.empty())
+    {
+        const auto& OldestFrame = m_InFlightFrames.front();
+
+        bool IsCompleted = true;
+        for (Uint32 q = 0; q < NumQueues && IsCompleted; ++q)
+        {
+            // The last command list submitted in the frame signals NextFenceValue - 1
+            IsCompleted = m_Device.GetCompletedFenceValue(SoftwareQueueIndex{q}) + 1 >= OldestFrame.NextFenceValues[q];
+        }
+        if (!IsCompleted)
+            break;
+
+        m_CompletedFrame = OldestFrame.Frame;
+        m_InFlightFrames.pop_front();
+    }
+
+    if (!m_pDXGIAdapter)
+        return;
+
+    DXGI_QUERY_VIDEO_MEMORY_INFO MemInfo{};
+    if (FAILED(m_pDXGIAdapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &MemInfo)))
+        return;
+
+    if (MemInfo.CurrentUsage <= MemInfo.Budget)
+        return;
+
+    // Resources referenced after this frame may still be used by the GPU
+    const auto CurrentFrame = m_CurrentFrame.load();
+    if (CurrentFrame <= m_EvictionFrameThreshold)
+        return;
+    const auto MaxLastUsedFrame = std::min(m_CompletedFrame, CurrentFrame - m_EvictionFrameThreshold);
+
+    struct Candidate
+    {
+        Entry* pEntry;
+        Uint64 LastUsedFrame;
+    };
+    std::vector<Candidate> Candidates;
+    for (auto* pEntry : m_Entries)
+    {
+        const auto LastUsedFrame = pEntry->LastUsedFrame.load(std::memory_order_relaxed);
+        if (!pEntry->Evicted && LastUsedFrame <= MaxLastUsedFrame)
+            Candidates.push_back({pEntry, LastUsedFrame});
+    }
+    if (Candidates.empty())
+        return;
+
+    // Evict resources with lower priority first, then least recently used ones
+    std::sort(Candidates.begin(), Candidates.end(),
+              [](const Candidate& lhs, const Candidate& rhs) {
+                  if (lhs.pEntry->Priority != rhs.pEntry->Priority)
+                      return lhs.pEntry->Priority < rhs.pEntry->Priority;
+                  return lhs.LastUsedFrame < rhs.LastUsedFrame;
+              });
+
+    const auto BytesToEvict = MemInfo.CurrentUsage - MemInfo.Budget;
+
+    std::vector<Entry*>          EvictedEntries;
+    std::vector<ID3D12Pageable*> Pageables;
+    Uint64                       EvictedSize = 0;
+    for (const auto& Cand : Candidates)
+    {
+        if (EvictedSize >= BytesToEvict)
+            break;
+
+        auto& E = *Cand.pEntry;
+        // Request the eviction first, then check if the resource has been referenced by a command
+        // list in the meantime. MarkUsed() performs the same operations in the opposite order.
+        E.EvictionRequested.store(true);
+        if (E.LastUsedFrame.load() <= MaxLastUsedFrame)
+        {
+            E.Evicted = true;
+            EvictedEntries.emplace_back(&E);
+            Pageables.emplace_back(E.pPageable);
+            EvictedSize += E.Size;
+        }
+        else
+        {
+            E.EvictionRequested.store(false);
+        }
+    }
+
+    if (Pageables.empty())
+        return;
+
+    auto hr = m_Device.GetD3D12Device()->Evict(static_cast<UINT>(Pageables.size()), Pageables.data());
+    if (FAILED(hr))
+    {
+        LOG_D3D_ERROR(hr, "Failed to evict resources");
+        for (auto* pEntry : EvictedEntries)
+        {
+            // Entries that have been queued by MakeResident() will be skipped
+            pEntry->Evicted = false;
+            pEntry->EvictionRequested.store(false);
+        }
+    }
+}
+
+} // namespace Diligent
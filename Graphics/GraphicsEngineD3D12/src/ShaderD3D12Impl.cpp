@@ -115,18 +115,31 @@ ShaderD3D12Impl::ShaderD3D12Impl(IReferenceCounters*     pRefCounters,
         D3D12ShaderCI,
         IsDeviceInternal,
         GetD3D12ShaderModel(ShaderCI, D3D12ShaderCI.pDXCompiler, D3D12ShaderCI.MaxShaderVersion),
-        [pDXCompiler      = D3D12ShaderCI.pDXCompiler,
-         LoadCBReflection = ShaderCI.LoadConstantBufferReflection](const ShaderDesc& Desc, IDataBlob* pShaderByteCode) {
-            auto& Allocator  = GetRawAllocator();
-            auto* pRawMem    = ALLOCATE(Allocator, "Allocator for ShaderResources", ShaderResourcesD3D12, 1);
-            auto* pResources = new (pRawMem) ShaderResourcesD3D12 //
-                {
-                    pShaderByteCode,
-                    Desc,
-                    Desc.UseCombinedTextureSamplers ? Desc.CombinedSamplerSuffix : nullptr,
-                    pDXCompiler,
-                    LoadCBReflection,
-                };
+        [pDXCompiler          = D3D12ShaderCI.pDXCompiler,
+         LoadCBReflection     = ShaderCI.LoadConstantBufferReflection,
+         pSerializedResources = ShaderCI.ByteCode != nullptr ? D3D12ShaderCI.pSerializedResources : nullptr](const ShaderDesc& Desc, IDataBlob* pShaderByteCode) {
+            auto& Allocator = GetRawAllocator();
+            auto* pRawMem   = ALLOCATE(Allocator, "Allocator for ShaderResources", ShaderResourcesD3D12, 1);
+
+            const char* CombinedSamplerSuffix = Desc.UseCombinedTextureSamplers ? Desc.CombinedSamplerSuffix : nullptr;
+
+            ShaderResourcesD3D12* pResources = nullptr;
+            // Constant buffer reflection is not serialized and requires the bytecode reflection
+            if (pSerializedResources != nullptr && *pSerializedResources && !LoadCBReflection)
+            {
+                pResources = new (pRawMem) ShaderResourcesD3D12{*pSerializedResources, Desc, CombinedSamplerSuffix};
+            }
+            else
+            {
+                pResources = new (pRawMem) ShaderResourcesD3D12 //
+                    {
+                        pShaderByteCode,
+                        Desc,
+                        CombinedSamplerSuffix,
+                        pDXCompiler,
+                        LoadCBReflection,
+                    };
+            }
             return std::shared_ptr<const ShaderResourcesD3D12>{pResources, STDDeleterRawMem<ShaderResourcesD3D12>(Allocator)};
         },
     },
@@ -365,11 +365,22 @@ const ShaderResourceCacheD3D12::Resource& ShaderResourceCacheD3D12::SetResource(
 
     auto& DstRes = Tbl.GetResource(OffsetFromTableStart);
 
+    // Only update the revision when the descriptor actually changes so that rebinding the
+    // same resource does not force the cache to be committed and its dynamic descriptors copied again.
+    const bool DescriptorChanged =
+        DstRes.Type != SrcRes.Type ||
+        DstRes.CPUDescriptorHandle.ptr != SrcRes.CPUDescriptorHandle.ptr ||
+        DstRes.pObject != SrcRes.pObject ||
+        DstRes.BufferBaseOffset != SrcRes.BufferBaseOffset ||
+        DstRes.BufferRangeSize != SrcRes.BufferRangeSize;
+
     DstRes = std::move(SrcRes);
     // Make sure dynamic offset is reset
     DstRes.BufferDynamicOffset = 0;
 
-    UpdateRevision();
+    MarkResourceForTransition(Tbl.GetStartOffset() + OffsetFromTableStart);
+    if (DescriptorChanged)
+        UpdateRevision();
 
     return DstRes;
 }
@@ -386,10 +397,11 @@ void ShaderResourceCacheD3D12::SetBufferDynamicOffset(Uint32 RootIndex,
     Res.BufferDynamicOffset = BufferDynamicOffset;
 }
 
-const ShaderResourceCacheD3D12::Resource& ShaderResourceCacheD3D12::CopyResource(ID3D12Device*   pd3d12Device,
-                                                                                 Uint32          RootIndex,
-                                                                                 Uint32          OffsetFromTableStart,
-                                                                                 const Resource& SrcRes)
+const ShaderResourceCacheD3D12::Resource& ShaderResourceCacheD3D12::CopyResource(ID3D12Device*        pd3d12Device,
+                                                                                 Uint32               RootIndex,
+                                                                                 Uint32               OffsetFromTableStart,
+                                                                                 const Resource&      SrcRes,
+                                                                                 DescriptorCopyBatch* pCopyBatch)
 {
     const auto& DstRes = SetResource(RootIndex, OffsetFromTableStart, Resource{SrcRes});
 
@@ -404,7 +416,10 @@ const ShaderResourceCacheD3D12::Resource& ShaderResourceCacheD3D12::CopyResource
                 HeapType, ROOT_PARAMETER_GROUP_STATIC_MUTABLE, RootIndex, OffsetFromTableStart);
             if (DstRes.CPUDescriptorHandle.ptr != 0)
             {
-                pd3d12Device->CopyDescriptorsSimple(1, DstDescrHandle, SrcRes.CPUDescriptorHandle, HeapType);
+                if (pCopyBatch != nullptr)
+                    pCopyBatch->Add(HeapType, DstDescrHandle, SrcRes.CPUDescriptorHandle);
+                else
+                    pd3d12Device->CopyDescriptorsSimple(1, DstDescrHandle, SrcRes.CPUDescriptorHandle, HeapType);
             }
             else
             {
@@ -420,6 +435,83 @@ const ShaderResourceCacheD3D12::Resource& ShaderResourceCacheD3D12::CopyResource
     return DstRes;
 }
 
+ShaderResourceCacheD3D12::DescriptorCopyBatch::DescriptorCopyBatch(ID3D12Device* pd3d12Device) :
+    m_pd3d12Device{pd3d12Device}
+{
+    VERIFY_EXPR(m_pd3d12Device != nullptr);
+    for (Uint32 heap_type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV; heap_type < m_Batches.size(); ++heap_type)
+        m_Batches[heap_type].DescriptorSize = m_pd3d12Device->GetDescriptorHandleIncrementSize(static_cast<D3D12_DESCRIPTOR_HEAP_TYPE>(heap_type));
+}
+
+ShaderResourceCacheD3D12::DescriptorCopyBatch::~DescriptorCopyBatch()
+{
+    for (const auto& Batch : m_Batches)
+    {
+        VERIFY(Batch.NumDescriptors == 0, "Descriptor copy batch is destroyed without being flushed");
+    }
+}
+
+void ShaderResourceCacheD3D12::DescriptorCopyBatch::DescriptorRanges::Add(D3D12_CPU_DESCRIPTOR_HANDLE Handle, UINT DescriptorSize)
+{
+    if (!Starts.empty() && Starts.back().ptr + SIZE_T{Sizes.back()} * DescriptorSize == Handle.ptr)
+    {
+        // The descriptor immediately follows the last range - extend it
+        ++Sizes.back();
+    }
+    else
+    {
+        Starts.push_back(Handle);
+        Sizes.push_back(1);
+    }
+}
+
+void ShaderResourceCacheD3D12::DescriptorCopyBatch::DescriptorRanges::Clear()
+{
+    Starts.clear();
+    Sizes.clear();
+}
+
+void ShaderResourceCacheD3D12::DescriptorCopyBatch::Add(D3D12_DESCRIPTOR_HEAP_TYPE  HeapType,
+                                                        D3D12_CPU_DESCRIPTOR_HANDLE DstHandle,
+                                                        D3D12_CPU_DESCRIPTOR_HANDLE SrcHandle)
+{
+    VERIFY_EXPR(HeapType == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || HeapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+    VERIFY_EXPR(DstHandle.ptr != 0 && SrcHandle.ptr != 0);
+
+    auto& Batch = m_Batches[HeapType];
+    // Source and destination ranges are merged independently: CopyDescriptors() only
+    // requires the total number of descriptors in both arrays to match.
+    Batch.Dst.Add(DstHandle, Batch.DescriptorSize);
+    Batch.Src.Add(SrcHandle, Batch.DescriptorSize);
+    ++Batch.NumDescriptors;
+}
+
+void ShaderResourceCacheD3D12::DescriptorCopyBatch::Flush()
+{
+    for (Uint32 heap_type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV; heap_type < m_Batches.size(); ++heap_type)
+    {
+        auto& Batch = m_Batches[heap_type];
+        if (Batch.NumDescriptors == 0)
+            continue;
+
+        const auto d3d12HeapType = static_cast<D3D12_DESCRIPTOR_HEAP_TYPE>(heap_type);
+        if (Batch.Dst.Starts.size() == 1 && Batch.Src.Starts.size() == 1)
+        {
+            m_pd3d12Device->CopyDescriptorsSimple(Batch.NumDescriptors, Batch.Dst.Starts[0], Batch.Src.Starts[0], d3d12HeapType);
+        }
+        else
+        {
+            m_pd3d12Device->CopyDescriptors(static_cast<UINT>(Batch.Dst.Starts.size()), Batch.Dst.Starts.data(), Batch.Dst.Sizes.data(),
+                                            static_cast<UINT>(Batch.Src.Starts.size()), Batch.Src.Starts.data(), Batch.Src.Sizes.data(),
+                                            d3d12HeapType);
+        }
+
+        Batch.Dst.Clear();
+        Batch.Src.Clear();
+        Batch.NumDescriptors = 0;
+    }
+}
+
 
 #ifdef DILIGENT_DEBUG
 void ShaderResourceCacheD3D12::DbgValidateDynamicBuffersMask() const
@@ -524,7 +616,14 @@ void ShaderResourceCacheD3D12::Resource::TransitionResource(CommandContext& Ctx)
         {
             auto* pTexViewD3D12    = pObject.RawPtr<TextureViewD3D12Impl>();
             auto* pTexToTransition = pTexViewD3D12->GetTexture<TextureD3D12Impl>();
-            if (pTexToTransition->IsInKnownState() && !pTexToTransition->CheckAnyState(RESOURCE_STATE_SHADER_RESOURCE | RESOURCE_STATE_INPUT_ATTACHMENT))
+            if (pTexToTransition->HasSubresourceStates())
+            {
+                // Only transition the subresources referenced by the view
+                const auto Range = pTexToTransition->GetViewSubresourceRange(pTexViewD3D12->GetDesc());
+                if (pTexToTransition->IsInKnownState() && !pTexToTransition->CheckSubresourceState(Range, RESOURCE_STATE_SHADER_RESOURCE))
+                    Ctx.TransitionResource(*pTexToTransition, Range, RESOURCE_STATE_SHADER_RESOURCE);
+            }
+            else if (pTexToTransition->IsInKnownState() && !pTexToTransition->CheckAnyState(RESOURCE_STATE_SHADER_RESOURCE | RESOURCE_STATE_INPUT_ATTACHMENT))
                 Ctx.TransitionResource(*pTexToTransition, RESOURCE_STATE_SHADER_RESOURCE);
         }
         break;
@@ -537,7 +636,10 @@ void ShaderResourceCacheD3D12::Resource::TransitionResource(CommandContext& Ctx)
             {
                 // We must always call TransitionResource() even when the state is already
                 // RESOURCE_STATE_UNORDERED_ACCESS as in this case UAV barrier must be executed
-                Ctx.TransitionResource(*pTexToTransition, RESOURCE_STATE_UNORDERED_ACCESS);
+                if (pTexToTransition->HasSubresourceStates())
+                    Ctx.TransitionResource(*pTexToTransition, pTexToTransition->GetViewSubresourceRange(pTexViewD3D12->GetDesc()), RESOURCE_STATE_UNORDERED_ACCESS);
+                else
+                    Ctx.TransitionResource(*pTexToTransition, RESOURCE_STATE_UNORDERED_ACCESS);
             }
         }
         break;
@@ -630,7 +732,11 @@ void ShaderResourceCacheD3D12::Resource::DvpVerifyResourceState()
             {
                 RequiredStates |= RESOURCE_STATE_DEPTH_READ;
             }
-            if (pTexD3D12->IsInKnownState() && !pTexD3D12->CheckAnyState(RequiredStates))
+            const bool IsInRequiredState = !pTexD3D12->IsInKnownState() ||
+                (pTexD3D12->HasSubresourceStates() ?
+                     pTexD3D12->CheckSubresourceState(pTexD3D12->GetViewSubresourceRange(pTexViewD3D12->GetDesc()), RESOURCE_STATE_SHADER_RESOURCE) :
+                     pTexD3D12->CheckAnyState(RequiredStates));
+            if (!IsInRequiredState)
             {
                 LOG_ERROR_MESSAGE("Texture '", pTexD3D12->GetDesc().Name, "' must be in one of ", GetResourceStateString(RequiredStates), " states. Actual state: ",
                                   GetResourceStateString(pTexD3D12->GetState()),
@@ -645,7 +751,12 @@ void ShaderResourceCacheD3D12::Resource::DvpVerifyResourceState()
         {
             const auto* pTexViewD3D12 = pObject.ConstPtr<TextureViewD3D12Impl>();
             const auto* pTexD3D12     = pTexViewD3D12->GetTexture<const TextureD3D12Impl>();
-            if (pTexD3D12->IsInKnownState() && !pTexD3D12->CheckState(RESOURCE_STATE_UNORDERED_ACCESS))
+
+            const bool IsInRequiredState = !pTexD3D12->IsInKnownState() ||
+                (pTexD3D12->HasSubresourceStates() ?
+                     pTexD3D12->CheckSubresourceState(pTexD3D12->GetViewSubresourceRange(pTexViewD3D12->GetDesc()), RESOURCE_STATE_UNORDERED_ACCESS) :
+                     pTexD3D12->CheckState(RESOURCE_STATE_UNORDERED_ACCESS));
+            if (!IsInRequiredState)
             {
                 LOG_ERROR_MESSAGE("Texture '", pTexD3D12->GetDesc().Name, "' must be in RESOURCE_STATE_UNORDERED_ACCESS state. Actual state: ",
                                   GetResourceStateString(pTexD3D12->GetState()),
@@ -684,23 +795,74 @@ void ShaderResourceCacheD3D12::Resource::DvpVerifyResourceState()
 
 void ShaderResourceCacheD3D12::TransitionResourceStates(CommandContext& Ctx, StateTransitionMode Mode)
 {
-    for (Uint32 r = 0; r < m_TotalResourceCount; ++r)
+    switch (Mode)
     {
-        auto& Res = GetResource(r);
-        switch (Mode)
+        case StateTransitionMode::Transition:
         {
-            case StateTransitionMode::Transition:
+            // Only process resources that could have changed their states since the last pass.
+            // This avoids iterating over large descriptor arrays on every commit.
+            const StateTransitionRange Range = BeginStateTransition(m_TotalResourceCount);
+
+            bool HasUnconditionalTransitions = false;
+            for (Uint32 r = Range.First; r < Range.End; ++r)
+            {
+                auto& Res = GetResource(r);
+                // UAVs and TLASes are always transitioned to execute UAV barriers
+                if (Res.Type == SHADER_RESOURCE_TYPE_BUFFER_UAV ||
+                    Res.Type == SHADER_RESOURCE_TYPE_TEXTURE_UAV ||
+                    Res.Type == SHADER_RESOURCE_TYPE_ACCEL_STRUCT)
+                {
+                    HasUnconditionalTransitions = true;
+                }
                 Res.TransitionResource(Ctx);
-                break;
+            }
 
-            case StateTransitionMode::Verify:
+            EndStateTransition(Range, m_TotalResourceCount, HasUnconditionalTransitions);
+        }
+        break;
+
+        case StateTransitionMode::Verify:
 #ifdef DILIGENT_DEVELOPMENT
-                Res.DvpVerifyResourceState();
+            for (Uint32 r = 0; r < m_TotalResourceCount; ++r)
+                GetResource(r).DvpVerifyResourceState();
 #endif
+            break;
+
+        default:
+            UNEXPECTED("Unexpected mode");
+    }
+}
+
+void ShaderResourceCacheD3D12::MarkResidencyUsed() const
+{
+    static_assert(SHADER_RESOURCE_TYPE_LAST == 8, "Please update this function to handle the new resource type");
+    const auto* pResources = reinterpret_cast<const Resource*>(reinterpret_cast<const RootTable*>(m_pMemory.get()) + m_NumTables);
+    for (Uint32 r = 0; r < m_TotalResourceCount; ++r)
+    {
+        const auto& Res = pResources[r];
+        if (Res.IsNull())
+            continue;
+
+        switch (Res.Type)
+        {
+            case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:
+                Res.pObject.ConstPtr<BufferD3D12Impl>()->MarkResidencyUsed();
+                break;
+
+            case SHADER_RESOURCE_TYPE_BUFFER_SRV:
+            case SHADER_RESOURCE_TYPE_BUFFER_UAV:
+                Res.pObject.ConstPtr<BufferViewD3D12Impl>()->GetBuffer<const BufferD3D12Impl>()->MarkResidencyUsed();
+                break;
+
+            case SHADER_RESOURCE_TYPE_TEXTURE_SRV:
+            case SHADER_RESOURCE_TYPE_TEXTURE_UAV:
+            case SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT:
+                Res.pObject.ConstPtr<TextureViewD3D12Impl>()->GetTexture<const TextureD3D12Impl>()->MarkResidencyUsed();
                 break;
 
             default:
-                UNEXPECTED("Unexpected mode");
+                // Samplers and acceleration structures are not tracked
+                break;
         }
     }
 }
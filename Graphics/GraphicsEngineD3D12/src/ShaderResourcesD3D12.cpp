@@ -103,4 +103,15 @@ ShaderResourcesD3D12::ShaderResourcesD3D12(IDataBlob*        pShaderBytecode,
         LoadConstantBufferReflection);
 }
 
+ShaderResourcesD3D12::ShaderResourcesD3D12(const SerializedData& SerializedResources,
+                                           const ShaderDesc&     ShdrDesc,
+                                           const char*           CombinedSamplerSuffix) :
+    ShaderResources{ShdrDesc.ShaderType}
+{
+    Serializer<SerializerMode::Read> Ser{SerializedResources};
+    Deserialize(Ser, ShdrDesc.Name, CombinedSamplerSuffix);
+    if (!Ser.IsEnded())
+        LOG_ERROR_AND_THROW("Unexpected data at the end of serialized resources of shader '", ShdrDesc.Name, "'");
+}
+
 } // namespace Diligent
@@ -98,7 +98,7 @@ void ShaderVariableManagerD3D12::Initialize(const PipelineResourceSignatureD3D12
     if (m_NumVariables == 0)
         return;
 
-    TBase::Initialize(Signature, Allocator, MemSize);
+    TBase::Initialize(Signature, Allocator, MemSize, ShaderType);
 
     Uint32 VarInd = 0;
     ProcessSignatureResources(Signature, AllowedVarTypes, NumAllowedTypes, ShaderType,
@@ -135,13 +135,10 @@ const ShaderVariableManagerD3D12::ResourceAttribs& ShaderVariableManagerD3D12::G
 
 ShaderVariableD3D12Impl* ShaderVariableManagerD3D12::GetVariable(const Char* Name) const
 {
-    for (Uint32 v = 0; v < m_NumVariables; ++v)
-    {
-        auto& Var = m_pVariables[v];
-        if (strcmp(Var.GetDesc().Name, Name) == 0)
-            return &Var;
-    }
-    return nullptr;
+    if (m_NumVariables == 0)
+        return nullptr;
+
+    return FindVariableByResIndex(m_pVariables, m_NumVariables, FindResourceIndex(Name));
 }
 
 
@@ -227,10 +224,15 @@ private:
             VERIFY(CPUDescriptorHandle.ptr != 0, "CPU descriptor handle must not be null for resources allocated in descriptor tables");
             DEV_CHECK_ERR(m_DstRes.pObject == nullptr || m_AllowOverwrite,
                           "Static and mutable resource descriptors should only be copied once unless ALLOW_OVERWRITE flag is set.");
-            const auto d3d12HeapType = m_ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER ?
-                D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER :
-                D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-            GetD3D12Device()->CopyDescriptorsSimple(1, m_DstTableCPUDescriptorHandle, CPUDescriptorHandle, d3d12HeapType);
+            // The cache keeps a strong reference to the bound object, so the same source handle
+            // always refers to the same descriptor and there is no need to copy it again.
+            if (m_DstRes.CPUDescriptorHandle.ptr != CPUDescriptorHandle.ptr)
+            {
+                const auto d3d12HeapType = m_ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER ?
+                    D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER :
+                    D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+                GetD3D12Device()->CopyDescriptorsSimple(1, m_DstTableCPUDescriptorHandle, CPUDescriptorHandle, d3d12HeapType);
+            }
         }
 
         m_ResourceCache.SetResource(m_RootIndex, m_OffsetFromTableStart,
@@ -367,7 +369,8 @@ void BindResourceHelper::CacheCB(const BindResourceInfo& BindInfo) const
                           "Static and mutable resource descriptors should only be copied once unless ALLOW_OVERWRITE flag is set.");
             if (RangeSize == BuffDesc.Size)
             {
-                GetD3D12Device()->CopyDescriptorsSimple(1, m_DstTableCPUDescriptorHandle, CPUDescriptorHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                if (m_DstRes.CPUDescriptorHandle.ptr != CPUDescriptorHandle.ptr)
+                    GetD3D12Device()->CopyDescriptorsSimple(1, m_DstTableCPUDescriptorHandle, CPUDescriptorHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
             }
             else
             {
@@ -148,13 +148,15 @@ void SwapChainD3D12Impl::Present(Uint32 SyncInterval)
     CmdCtx.TransitionResource(*pBackBuffer, RESOURCE_STATE_PRESENT);
 
     pImmediateCtxD3D12->Flush();
+    // The command lists must be executed before the frame is presented
+    m_pRenderDevice.RawPtr<RenderDeviceD3D12Impl>()->FlushBatchedSubmits(pImmediateCtxD3D12->GetCommandQueueId());
 
     // In contrast to MSDN sample, we wait for the frame as late as possible - right
     // before presenting.
     // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
     WaitForFrame();
 
-    auto hr = m_pSwapChain->Present(SyncInterval, 0);
+    auto hr = m_pSwapChain->Present(SyncInterval, GetPresentFlags(SyncInterval));
     VERIFY(SUCCEEDED(hr), "Present failed");
 
     if (m_SwapChainDesc.IsPrimary)
@@ -235,15 +235,32 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
         // By default, committed resources and heaps are almost always zeroed upon creation.
         // CREATE_NOT_ZEROED flag allows this to be elided in some scenarios to lower the overhead
         // of creating the heap. No need to zero the resource if we initialize it.
-        const auto d3d12HeapFlags = bInitializeTexture ?
+        auto d3d12HeapFlags = bInitializeTexture ?
             D3D12_HEAP_FLAG_CREATE_NOT_ZEROED :
             D3D12_HEAP_FLAG_NONE;
 
-        auto hr = pd3d12Device->CreateCommittedResource(
-            &HeapProps, d3d12HeapFlags, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
-            reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
-        if (FAILED(hr))
-            LOG_ERROR_AND_THROW("Failed to create D3D12 texture");
+        // Exportable textures must be committed resources in a shared heap, so that
+        // ID3D12Device::CreateSharedHandle() can be used to open them in another API or process.
+        const bool IsExportable = (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_EXPORTABLE) != 0;
+        if (IsExportable)
+            d3d12HeapFlags |= D3D12_HEAP_FLAG_SHARED;
+
+        // Small textures are suballocated from shared heaps
+        const auto IsPlaced = !IsExportable &&
+            pRenderDeviceD3D12->GetPlacedResourceAllocator().CreateResource(d3d12TexDesc, d3d12State, pClearValue, m_pd3d12Resource, m_PlacedAllocation);
+
+        HRESULT hr = S_OK;
+        if (!IsPlaced)
+        {
+            hr = pd3d12Device->CreateCommittedResource(
+                &HeapProps, d3d12HeapFlags, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
+                reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            if (FAILED(hr))
+                LOG_ERROR_AND_THROW("Failed to create D3D12 texture");
+
+            if (auto* pResidencyMgr = pRenderDeviceD3D12->GetResidencyManager())
+                m_pResidencyEntry = pResidencyMgr->Register(m_pd3d12Resource);
+        }
 
         if (*m_Desc.Name != 0)
             m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
@@ -630,6 +647,9 @@ TextureD3D12Impl::~TextureD3D12Impl()
 {
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Resource), m_Desc.ImmediateContextMask);
+    // Heap memory of a placed texture must be released after the texture itself
+    if (!m_PlacedAllocation.IsNull())
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_PlacedAllocation), m_Desc.ImmediateContextMask);
     if (m_StagingFootprints != nullptr)
     {
         FREE(GetRawAllocator(), m_StagingFootprints);
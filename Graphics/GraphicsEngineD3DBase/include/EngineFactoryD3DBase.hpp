@@ -244,6 +244,9 @@ public:
             Features.NativeMultiDraw               = DEVICE_FEATURE_STATE_DISABLED;
             Features.AsyncShaderCompilation        = DEVICE_FEATURE_STATE_ENABLED;
             Features.FormattedBuffers              = DEVICE_FEATURE_STATE_ENABLED;
+            Features.ConditionalRendering          = DevType == RENDER_DEVICE_TYPE_D3D12 ? DEVICE_FEATURE_STATE_ENABLED : DEVICE_FEATURE_STATE_DISABLED;
+            Features.MultiView                     = DEVICE_FEATURE_STATE_DISABLED;
+            Features.ExtendedDynamicState          = DEVICE_FEATURE_STATE_DISABLED;
         }
 
         // Set memory properties
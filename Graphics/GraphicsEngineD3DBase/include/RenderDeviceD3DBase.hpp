@@ -31,7 +31,7 @@
 /// Implementation of the Diligent::RenderDeviceBase template class and related structures
 
 #include "WinHPreface.h"
-#include <dxgi.h>
+#include <dxgi1_4.h>
 #include "WinHPostface.h"
 
 #include "RenderDeviceBase.hpp"
@@ -215,8 +215,33 @@ protected:
         return Info;
     }
 
+    // Initializes the local and non-local memory segment group heaps in the memory stats and
+    // writes their budget and usage if IDXGIAdapter3 is available
+    void GetDXGIMemoryBudget(DeviceMemoryStats& Stats) const
+    {
+        static constexpr DXGI_MEMORY_SEGMENT_GROUP SegmentGroups[] = {DXGI_MEMORY_SEGMENT_GROUP_LOCAL, DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL};
+
+        Stats.NumHeaps             = _countof(SegmentGroups);
+        Stats.Heaps[0].DeviceLocal = True;
+        if (!m_pDXGIAdapter3)
+            return;
+
+        for (Uint32 i = 0; i < _countof(SegmentGroups); ++i)
+        {
+            DXGI_QUERY_VIDEO_MEMORY_INFO MemInfo{};
+            if (SUCCEEDED(m_pDXGIAdapter3->QueryVideoMemoryInfo(0, SegmentGroups[i], &MemInfo)))
+            {
+                Stats.Heaps[i].Budget = MemInfo.Budget;
+                Stats.Heaps[i].Usage  = MemInfo.CurrentUsage;
+            }
+        }
+    }
+
 protected:
     NVApiLoader m_NVApi;
+
+    // Used to query the video memory budget. May be null on systems that don't support IDXGIAdapter3.
+    CComPtr<IDXGIAdapter3> m_pDXGIAdapter3;
 };
 
 } // namespace Diligent
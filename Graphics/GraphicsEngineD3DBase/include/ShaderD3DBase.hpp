@@ -39,6 +39,7 @@
 #include "ShaderBase.hpp"
 #include "ThreadPool.h"
 #include "RefCntAutoPtr.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 /// \file
 /// Base implementation of a D3D shader
@@ -190,9 +191,12 @@ private:
                     IDataBlob**             ppCompilerOutput,
                     InitResourcesFuncType   InitResources) noexcept(false)
     {
+        ShaderCompilationScope CompilationScope{this->m_Desc.Name, false};
+
         m_pShaderByteCode = CompileD3DBytecode(ShaderCI, ShaderModel, pDxCompiler, ppCompilerOutput);
         if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0)
         {
+            ShaderCompilationStageScope Reflection{SHADER_COMPILATION_STAGE_REFLECTION};
             m_pShaderResources = InitResources(this->m_Desc, m_pShaderByteCode);
         }
         this->m_Status.store(SHADER_STATUS_READY);
@@ -70,6 +70,7 @@
 #include "STDAllocator.hpp"
 #include "HashUtils.hpp"
 #include "StringPool.hpp"
+#include "Serializer.hpp"
 #include "D3DShaderResourceLoader.hpp"
 #include "PipelineState.h"
 #include "D3DCommonTypeConversions.hpp"
@@ -432,6 +433,12 @@ public:
         Minor = (m_ShaderVersion & 0x0000000F);
     }
 
+    // Serializes the shader model and the resource tables so that the resources can later be
+    // restored by Deserialize() without the shader reflection.
+    // Constant buffer reflection is not serialized.
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser) const;
+
 protected:
     template <typename TD3DReflectionTraits,
               typename TShaderReflection,
@@ -442,6 +449,13 @@ protected:
                     const Char*         SamplerSuffix,
                     bool                LoadConstantBufferReflection);
 
+    // Initializes the resources from the data written by Serialize().
+    // Combined samplers are assigned using CombinedSamplerSuffix, which may differ from the suffix
+    // the data was serialized with.
+    void Deserialize(Serializer<SerializerMode::Read>& Ser,
+                     const Char*                       ShaderName,
+                     const Char*                       CombinedSamplerSuffix) noexcept(false);
+
 
     __forceinline D3DShaderResourceAttribs& GetResAttribs(Uint32 n, Uint32 NumResources, Uint32 Offset) noexcept
     {
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <VersionHelpers.h>
+#include <dxgi1_5.h>
 #include "SwapChainBase.hpp"
 #include "DXGITypeConversions.hpp"
 #include "GraphicsAccessories.hpp"
@@ -54,7 +55,7 @@ public:
         TBase{pRefCounters, pDevice, pDeviceContext, SCDesc},
         m_FSDesc           {FSDesc},
         m_Window           {Window},
-        m_MaxFrameLatency  {SCDesc.BufferCount}
+        m_MaxFrameLatency  {SCDesc.MaxFrameLatency != 0 ? SCDesc.MaxFrameLatency : SCDesc.BufferCount}
     // clang-format on
     {
         if (m_DesiredPreTransform != SURFACE_TRANSFORM_OPTIMAL &&
@@ -214,6 +215,23 @@ protected:
             }
         }
 
+        // DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING is required to present with tearing when vertical
+        // synchronization is disabled. The flag is only supported starting with Windows 10.
+        m_AllowTearing = false;
+        if (m_SwapChainDesc.UnsyncedPresentMode == UNSYNCED_PRESENT_MODE_IMMEDIATE)
+        {
+            CComPtr<IDXGIFactory5> pDXGIFactory5;
+            if (SUCCEEDED(pDXGIFactory.QueryInterface(&pDXGIFactory5)))
+            {
+                BOOL AllowTearing = FALSE;
+                if (SUCCEEDED(pDXGIFactory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &AllowTearing, sizeof(AllowTearing))) && AllowTearing)
+                {
+                    swapChainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+                    m_AllowTearing = true;
+                }
+            }
+        }
+
 
         CComPtr<IDXGISwapChain1> pSwapChain1;
 
@@ -260,6 +278,8 @@ protected:
         hr = pSwapChain1.QueryInterface(&m_pSwapChain);
         CHECK_D3D_RESULT_THROW(hr, "Failed to query the required swap chain interface");
 
+        m_FrameWaited = false;
+
         if ((swapChainDesc.Flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) != 0)
         {
             CComPtr<IDXGISwapChain2> pSwapChain2;
@@ -281,6 +301,13 @@ protected:
 
     void WaitForFrame()
     {
+        if (m_FrameWaited)
+        {
+            // The application has already waited for this frame with WaitForNextFrame()
+            m_FrameWaited = false;
+            return;
+        }
+
         // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
         if (m_FrameLatencyWaitableObject != NULL)
         {
@@ -297,6 +324,32 @@ protected:
         }
     }
 
+    // Returns the flags for IDXGISwapChain::Present()
+    UINT GetPresentFlags(Uint32 SyncInterval) const
+    {
+        // DXGI_PRESENT_ALLOW_TEARING can't be used in fullscreen exclusive mode
+        return (SyncInterval == 0 && m_AllowTearing && !m_FSDesc.Fullscreen) ? DXGI_PRESENT_ALLOW_TEARING : 0;
+    }
+
+    virtual Bool DILIGENT_CALL_TYPE WaitForNextFrame(Uint32 Timeout) override final
+    {
+        // If there is no waitable object, Present() blocks when the frame queue is full
+        if (m_FrameWaited || m_FrameLatencyWaitableObject == NULL)
+            return True;
+
+        // 0xFFFFFFFF is INFINITE
+        auto Res = WaitForSingleObjectEx(m_FrameLatencyWaitableObject, Timeout, true);
+        if (Res != WAIT_OBJECT_0)
+        {
+            if (Res != WAIT_TIMEOUT)
+                LOG_ERROR_MESSAGE("Waiting for the frame waitable object failed.");
+            return False;
+        }
+
+        m_FrameWaited = true;
+        return True;
+    }
+
     virtual void DILIGENT_CALL_TYPE SetFullscreenMode(const DisplayModeAttribs& DisplayMode) override final
     {
         if (m_pSwapChain)
@@ -373,6 +426,12 @@ protected:
     HANDLE m_FrameLatencyWaitableObject = NULL;
 
     Uint32 m_MaxFrameLatency = 0;
+
+    // Indicates that the swap chain was created with DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING flag
+    bool m_AllowTearing = false;
+
+    // Indicates that the application has waited for the current frame with WaitForNextFrame()
+    bool m_FrameWaited = false;
 };
 
 } // namespace Diligent
@@ -25,6 +25,9 @@
  *  of the possibility of such damages.
  */
 
+#include <vector>
+#include <utility>
+
 #include "EngineMemory.h"
 #include "StringTools.hpp"
 #include "ShaderResources.hpp"
@@ -389,6 +392,146 @@ HLSLShaderResourceDesc ShaderResources::GetHLSLShaderResourceDesc(Uint32 Index)
     return HLSLResourceDesc;
 }
 
+template <SerializerMode Mode>
+bool ShaderResources::Serialize(Serializer<Mode>& Ser) const
+{
+    static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Use Deserialize() to read the resources");
+
+    D3DShaderResourceCounters ResCounters;
+    ResCounters.NumCBs          = GetNumCBs();
+    ResCounters.NumTexSRVs      = GetNumTexSRV();
+    ResCounters.NumTexUAVs      = GetNumTexUAV();
+    ResCounters.NumBufSRVs      = GetNumBufSRV();
+    ResCounters.NumBufUAVs      = GetNumBufUAV();
+    ResCounters.NumSamplers     = GetNumSamplers();
+    ResCounters.NumAccelStructs = GetNumAccelStructs();
+
+    if (!Ser(m_ShaderVersion,
+             ResCounters.NumCBs,
+             ResCounters.NumTexSRVs,
+             ResCounters.NumTexUAVs,
+             ResCounters.NumBufSRVs,
+             ResCounters.NumBufUAVs,
+             ResCounters.NumSamplers,
+             ResCounters.NumAccelStructs))
+        return false;
+
+    // Resources are serialized in the memory order. Sampler assignments are not serialized
+    // as they are restored from the names.
+    for (Uint32 n = 0; n < m_TotalResources; ++n)
+    {
+        const D3DShaderResourceAttribs& Res = GetResAttribs(n, m_TotalResources, 0);
+
+        const Uint8 InputType    = static_cast<Uint8>(Res.GetInputType());
+        const Uint8 SRVDimension = static_cast<Uint8>(Res.GetSRVDimension());
+        if (!Ser(Res.Name, Res.BindPoint, Res.BindCount, Res.Space, InputType, SRVDimension))
+            return false;
+    }
+
+    return true;
+}
+
+template bool ShaderResources::Serialize<SerializerMode::Write>(Serializer<SerializerMode::Write>& Ser) const;
+template bool ShaderResources::Serialize<SerializerMode::Measure>(Serializer<SerializerMode::Measure>& Ser) const;
+
+void ShaderResources::Deserialize(Serializer<SerializerMode::Read>& Ser,
+                                  const Char*                       ShaderName,
+                                  const Char*                       CombinedSamplerSuffix) noexcept(false)
+{
+    VERIFY(m_TotalResources == 0, "Shader resources have already been initialized");
+
+    D3DShaderResourceCounters ResCounters;
+    if (!Ser(m_ShaderVersion,
+             ResCounters.NumCBs,
+             ResCounters.NumTexSRVs,
+             ResCounters.NumTexUAVs,
+             ResCounters.NumBufSRVs,
+             ResCounters.NumBufUAVs,
+             ResCounters.NumSamplers,
+             ResCounters.NumAccelStructs))
+        LOG_ERROR_AND_THROW("Failed to deserialize resource counters of shader '", ShaderName, "'");
+
+    // clang-format off
+    const std::pair<Uint32, SHADER_RESOURCE_TYPE> Ranges[] =
+    {
+        {ResCounters.NumCBs,          SHADER_RESOURCE_TYPE_CONSTANT_BUFFER},
+        {ResCounters.NumTexSRVs,      SHADER_RESOURCE_TYPE_TEXTURE_SRV},
+        {ResCounters.NumTexUAVs,      SHADER_RESOURCE_TYPE_TEXTURE_UAV},
+        {ResCounters.NumBufSRVs,      SHADER_RESOURCE_TYPE_BUFFER_SRV},
+        {ResCounters.NumBufUAVs,      SHADER_RESOURCE_TYPE_BUFFER_UAV},
+        {ResCounters.NumSamplers,     SHADER_RESOURCE_TYPE_SAMPLER},
+        {ResCounters.NumAccelStructs, SHADER_RESOURCE_TYPE_ACCEL_STRUCT},
+    };
+    // clang-format on
+
+    // Read all resources first so that the data is validated before the memory is allocated.
+    // Names reference the serialized data.
+    std::vector<D3DShaderResourceAttribs> Resources;
+
+    size_t ResourceNamesPoolSize = 0;
+    for (const auto& Range : Ranges)
+    {
+        for (Uint32 i = 0; i < Range.first; ++i)
+        {
+            const char* Name         = nullptr;
+            Uint32      BindPoint    = 0;
+            Uint32      BindCount    = 0;
+            Uint32      Space        = 0;
+            Uint8       InputType    = 0;
+            Uint8       SRVDimension = 0;
+            if (!Ser(Name, BindPoint, BindCount, Space, InputType, SRVDimension))
+                LOG_ERROR_AND_THROW("Failed to deserialize resource attributes of shader '", ShaderName, "'");
+
+            if (InputType > D3D_SIT_RTACCELERATIONSTRUCTURE || InputType == D3D_SIT_TBUFFER || SRVDimension > D3D_SRV_DIMENSION_BUFFEREX)
+                LOG_ERROR_AND_THROW("Resource '", Name, "' of shader '", ShaderName, "' has invalid attributes");
+
+            Resources.emplace_back(Name, BindPoint, BindCount, Space,
+                                   static_cast<D3D_SHADER_INPUT_TYPE>(InputType),
+                                   static_cast<D3D_SRV_DIMENSION>(SRVDimension),
+                                   D3DShaderResourceAttribs::InvalidSamplerId);
+            if (Resources.back().GetShaderResourceType() != Range.second)
+                LOG_ERROR_AND_THROW("Resource '", Name, "' of shader '", ShaderName, "' is serialized in the wrong range");
+
+            ResourceNamesPoolSize += strlen(Name) + 1;
+        }
+    }
+
+    VERIFY_EXPR(ShaderName != nullptr);
+    ResourceNamesPoolSize += strlen(ShaderName) + 1;
+    if (CombinedSamplerSuffix != nullptr)
+        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
+
+    StringPool ResourceNamesPool;
+    AllocateMemory(GetRawAllocator(), ResCounters, ResourceNamesPoolSize, ResourceNamesPool);
+    VERIFY_EXPR(Resources.size() == m_TotalResources);
+
+    // Samplers must be initialized before texture SRVs
+    for (Uint32 n = 0; n < m_TotalResources; ++n)
+    {
+        if (n >= m_TexSRVOffset && n < m_TexUAVOffset)
+            continue;
+        new (&GetResAttribs(n, m_TotalResources, 0)) D3DShaderResourceAttribs{ResourceNamesPool, Resources[n]};
+    }
+
+    for (Uint32 n = 0; n < GetNumTexSRV(); ++n)
+    {
+        const D3DShaderResourceAttribs& TexAttribs = Resources[m_TexSRVOffset + n];
+
+        const auto SamplerId = CombinedSamplerSuffix != nullptr ? FindAssignedSamplerId(TexAttribs, CombinedSamplerSuffix) : D3DShaderResourceAttribs::InvalidSamplerId;
+        new (&GetTexSRV(n)) D3DShaderResourceAttribs{ResourceNamesPool, TexAttribs, SamplerId};
+        if (SamplerId != D3DShaderResourceAttribs::InvalidSamplerId)
+        {
+            GetSampler(SamplerId).SetTexSRVId(n);
+        }
+    }
+
+    m_ShaderName = ResourceNamesPool.CopyString(ShaderName);
+    if (CombinedSamplerSuffix != nullptr)
+        m_SamplerSuffix = ResourceNamesPool.CopyString(CombinedSamplerSuffix);
+
+    VERIFY_EXPR(ResourceNamesPool.GetRemainingSize() == 0);
+}
+
 size_t ShaderResources::GetHash() const
 {
     size_t hash = ComputeHash(GetNumCBs(), GetNumTexSRV(), GetNumTexUAV(), GetNumBufSRV(), GetNumBufUAV(), GetNumSamplers());
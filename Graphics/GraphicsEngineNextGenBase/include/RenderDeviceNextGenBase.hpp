@@ -61,6 +61,7 @@ public:
                             const EngineCreateInfo&    EngineCI,
                             const GraphicsAdapterInfo& AdapterInfo) :
         TBase{pRefCounters, RawMemAllocator, pEngineFactory, EngineCI, AdapterInfo},
+        m_StaleResourcePool{RawMemAllocator, StaleResourcePoolBlockSize},
         m_CmdQueueCount{CmdQueueCount}
     {
         VERIFY(m_CmdQueueCount < MAX_COMMAND_QUEUES, "The number of command queue is greater than maximum allowed value (", MAX_COMMAND_QUEUES, ")");
@@ -114,7 +115,7 @@ public:
 
         DynamicStaleResourceWrapper::RefCounterType NumReferences = PlatformMisc::CountOneBits(QueueMask);
 
-        auto Wrapper = DynamicStaleResourceWrapper::Create(std::move(Object), NumReferences);
+        auto Wrapper = DynamicStaleResourceWrapper::Create(std::move(Object), NumReferences, &m_StaleResourcePool);
 
         while (QueueMask != 0)
         {
@@ -235,6 +236,18 @@ public:
         return CmdBuffInfo;
     }
 
+    // Adds the number of stale resources and resources pending release in all queues to the memory stats.
+    // Resources released in several queues are counted once for every queue.
+    void GetReleaseQueueStats(DeviceMemoryStats& Stats) const
+    {
+        for (size_t q = 0; q < m_CmdQueueCount; ++q)
+        {
+            const auto& ReleaseQueue = m_CommandQueues[q].ReleaseQueue;
+            Stats.StaleResourceCount += static_cast<Uint32>(ReleaseQueue.GetStaleResourceCount());
+            Stats.PendingReleaseResourceCount += static_cast<Uint32>(ReleaseQueue.GetPendingReleaseResourceCount());
+        }
+    }
+
     ResourceReleaseQueue<DynamicStaleResourceWrapper>& GetReleaseQueue(SoftwareQueueIndex QueueInd)
     {
         VERIFY_EXPR(QueueInd < m_CmdQueueCount);
@@ -319,6 +332,15 @@ protected:
         RefCntAutoPtr<CommandQueueType>                   CmdQueue;
         ResourceReleaseQueue<DynamicStaleResourceWrapper> ReleaseQueue;
     };
+
+    // Most device objects (Vulkan handle wrappers, memory allocations, COM pointers)
+    // together with the stale resource header fit into 64 bytes.
+    static constexpr size_t StaleResourcePoolBlockSize = 64;
+
+    // Pool for the stale resources released through SafeReleaseDeviceObject().
+    // The release queues are destroyed by DestroyCommandQueues(), before the pool.
+    LockFreeBlockPool m_StaleResourcePool;
+
     const size_t  m_CmdQueueCount = 0;
     CommandQueue* m_CommandQueues = nullptr;
 };
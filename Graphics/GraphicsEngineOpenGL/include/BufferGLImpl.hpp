@@ -35,6 +35,7 @@
 #include "GLObjectWrapper.hpp"
 #include "AsyncWritableResource.hpp"
 #include "GLContextState.hpp"
+#include "GLDynamicHeap.hpp"
 
 namespace Diligent
 {
@@ -76,6 +77,16 @@ public:
 
     const GLObjectWrappers::GLBufferObj& GetGLHandle() const { return m_GlBuffer; }
 
+    /// Returns true if the buffer is suballocated from the context's dynamic heap when mapped with MAP_FLAG_DISCARD.
+    bool UsesDynamicHeap() const { return m_UseDynamicHeap; }
+
+    /// Returns the GL buffer that currently holds the buffer data. For buffers suballocated
+    /// from the dynamic heap, this is the heap buffer; the data starts at GetDataOffset().
+    const GLObjectWrappers::GLBufferObj& GetDataGLHandle() const { return m_DynamicAllocation ? *m_DynamicAllocation.pBuffer : m_GlBuffer; }
+
+    /// Returns the offset of the buffer data in the GL buffer returned by GetDataGLHandle().
+    Uint64 GetDataOffset() const { return m_DynamicAllocation.Offset; }
+
     /// Implementation of IBufferGL::GetGLBufferHandle().
     virtual GLuint DILIGENT_CALL_TYPE GetGLBufferHandle() const override final { return GetGLHandle(); }
 
@@ -94,6 +105,10 @@ private:
     GLObjectWrappers::GLBufferObj m_GlBuffer;
     const Uint32                  m_BindTarget;
     const GLenum                  m_GLUsageHint;
+    const bool                    m_UseDynamicHeap;
+
+    // The current dynamic heap allocation, if any
+    GLDynamicAllocation m_DynamicAllocation;
 
 #if PLATFORM_EMSCRIPTEN
     struct MappedData
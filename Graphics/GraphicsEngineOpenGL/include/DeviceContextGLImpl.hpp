@@ -28,6 +28,8 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <utility>
 
 #include "EngineGLImplTraits.hpp"
 #include "DeviceContextBase.hpp"
@@ -43,11 +45,17 @@
 
 #include "GLContextState.hpp"
 #include "GLObjectWrapper.hpp"
+#include "GLDynamicHeap.hpp"
+#include "GLCommandStream.hpp"
 
 namespace Diligent
 {
 
 /// Device context implementation in OpenGL backend.
+
+/// Deferred contexts never issue GL calls. They record commands into a GLCommandStream
+/// on any thread, and the immediate context replays the commands on the thread that owns
+/// the GL context when the command lists are executed.
 class DeviceContextGLImpl final : public DeviceContextBase<EngineGLImplTraits>
 {
 public:
@@ -292,6 +300,18 @@ public:
     /// Implementation of IDeviceContext::BindSparseResourceMemory() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::ResolveQueries() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE ResolveQueries(const ResolveQueriesAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
+    /// Implementation of IDeviceContext::SetDynamicRenderState() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetDynamicRenderState(const DynamicRenderState& State) override final;
+
     /// Implementation of IDeviceContextGL::UpdateCurrentGLContext().
     virtual bool DILIGENT_CALL_TYPE UpdateCurrentGLContext() override final;
 
@@ -302,6 +322,10 @@ public:
 
     void CommitRenderTargets();
 
+    // Invalidates the color and/or depth-stencil attachments of the framebuffer
+    // that contains the bound render targets (see SET_RENDER_TARGETS_FLAGS).
+    void InvalidateRenderTargets(bool InvalidateColor, bool InvalidateDepthStencil);
+
     virtual void DILIGENT_CALL_TYPE SetSwapChain(ISwapChainGL* pSwapChain) override final;
 
     virtual void ResetRenderTargets() override final;
@@ -315,6 +339,10 @@ protected:
 
     GLContextState m_ContextState;
 
+    // Persistently mapped heap used to suballocate dynamic uniform buffers.
+    // Null if the heap is disabled or GL_ARB_buffer_storage is not supported.
+    std::unique_ptr<GLDynamicHeap> m_pDynamicHeap;
+
 private:
     __forceinline void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenum& GlTopology);
     __forceinline void PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 FirstIndexLocation, GLenum& GLIndexType, size_t& FirstIndexByteOffset);
@@ -332,6 +360,9 @@ private:
     void BeginSubpass();
     void EndSubpass();
 
+    // Returns the stream that records the commands of the deferred context.
+    GLCommandStream& GetCommandStream();
+
     struct BindInfo : CommittedShaderResources
     {
 #ifdef DILIGENT_DEVELOPMENT
@@ -360,6 +391,13 @@ private:
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
 
     std::vector<OptimizedClearValue> m_AttachmentClearValues;
+
+    // Command stream that is being recorded by the deferred context.
+    // The stream is moved to the command list by FinishCommandList().
+    std::unique_ptr<GLCommandStream> m_pCommandStream;
+
+    // Buffers mapped by the deferred context and their staging memory in the command stream.
+    std::vector<std::pair<IBuffer*, void*>> m_DeferredMappedBuffers;
 };
 
 } // namespace Diligent
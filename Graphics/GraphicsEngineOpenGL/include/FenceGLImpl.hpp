@@ -62,6 +62,9 @@ public:
     /// Implementation of IFence::Wait() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE Wait(Uint64 Value) override final;
 
+    /// Implementation of IFence::WaitWithTimeout() in OpenGL backend.
+    virtual Bool DILIGENT_CALL_TYPE WaitWithTimeout(Uint64 Value, Uint64 Timeout) override final;
+
     void AddPendingFence(GLObjectWrappers::GLSyncObj&& Fence, Uint64 Value)
     {
         m_PendingFences.emplace_back(Value, std::move(Fence));
@@ -72,7 +75,7 @@ public:
 #endif
     }
 
-    void HostWait(Uint64 Value, bool FlushCommands);
+    bool HostWait(Uint64 Value, bool FlushCommands, Uint64 Timeout = FenceWaitTimeout::Infinite);
     void DeviceWait(Uint64 Value);
 
 private:
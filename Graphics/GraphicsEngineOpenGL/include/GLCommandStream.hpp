@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLCommandStream class
+
+#include <vector>
+#include <type_traits>
+#include <cstring>
+
+#include "Object.h"
+#include "RefCntAutoPtr.hpp"
+#include "DynamicLinearAllocator.hpp"
+
+namespace Diligent
+{
+
+class DeviceContextGLImpl;
+
+// The command stream is recorded by a deferred context and is replayed by the immediate context
+// when the command list is executed. Deferred contexts never issue GL calls, so they can record
+// commands on any thread, while only the thread that owns the GL context executes them.
+//
+// Every command is a small function object that is placed into the linear memory arena together
+// with the pointer to the function that invokes it. Arrays referenced by the command attributes
+// and the data of buffer and texture updates are copied into the same arena. The stream keeps
+// strong references to all objects used by the commands.
+//
+//   ___________________________________________________________________
+//  |                                                                   |
+//  |  | Cmd 0 | Cmd 1 | Viewports | Cmd 2 | Upload data | Cmd 3 | ...  |
+//  |____|__________|_______________A___|_______________________A_______|
+//       |          |               |   |                       |
+//       '---pNext--'---pNext-------|---'                       |
+//                                  |                           |
+//                 Arrays and data are referenced by the commands
+//
+class GLCommandStream
+{
+public:
+    explicit GLCommandStream(IMemoryAllocator& Allocator) :
+        m_Allocator{Allocator, 16 << 10}
+    {}
+
+    // clang-format off
+    GLCommandStream           (const GLCommandStream&)  = delete;
+    GLCommandStream           (      GLCommandStream&&) = delete;
+    GLCommandStream& operator=(const GLCommandStream&)  = delete;
+    GLCommandStream& operator=(      GLCommandStream&&) = delete;
+    // clang-format on
+
+    /// Appends the command to the stream.
+
+    /// \param [in] Handler - Function object that is called with the immediate context
+    ///                       when the stream is executed.
+    ///
+    /// \remarks    Handlers are never destroyed, so they may only capture raw pointers
+    ///             and plain data. Use KeepAlive(), CopyArray() and CopyData() to make
+    ///             the objects and memory they point to outlive the stream.
+    template <typename HandlerType>
+    void Record(const HandlerType& Handler)
+    {
+        static_assert(std::is_trivially_destructible<HandlerType>::value, "Command handlers are never destroyed and must be trivially destructible");
+
+        CommandHeader* pCmd = m_Allocator.Construct<Command<HandlerType>>(Handler);
+        if (m_pLastCmd != nullptr)
+            m_pLastCmd->pNext = pCmd;
+        else
+            m_pFirstCmd = pCmd;
+        m_pLastCmd = pCmd;
+        ++m_NumCommands;
+    }
+
+    /// Keeps a strong reference to the object until the stream is destroyed and returns the raw pointer.
+    template <typename ObjectType>
+    ObjectType* KeepAlive(ObjectType* pObject)
+    {
+        // Consecutive commands often use the same object
+        if (pObject != nullptr && (m_Objects.empty() || m_Objects.back().RawPtr() != pObject))
+            m_Objects.emplace_back(pObject);
+        return pObject;
+    }
+
+    /// Copies the array into the stream memory. Returns null if the array is empty.
+    template <typename T>
+    T* CopyArray(const T* pSrc, size_t Count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "Array elements are never destroyed and must be trivially destructible");
+        return (pSrc != nullptr && Count != 0) ? m_Allocator.CopyArray<T>(pSrc, Count) : nullptr;
+    }
+
+    /// Copies the string into the stream memory.
+    const Char* CopyString(const Char* Str)
+    {
+        return m_Allocator.CopyString(Str);
+    }
+
+    /// Allocates the staging memory for the data of buffer and texture updates.
+    void* AllocateData(size_t Size)
+    {
+        return m_Allocator.Allocate(Size, DataAlignment);
+    }
+
+    /// Copies the data of a buffer or texture update into the staging memory.
+    const void* CopyData(const void* pData, size_t Size)
+    {
+        if (pData == nullptr || Size == 0)
+            return nullptr;
+
+        void* pDst = AllocateData(Size);
+        std::memcpy(pDst, pData, Size);
+        return pDst;
+    }
+
+    /// Replays all recorded commands in the given context.
+    void Execute(DeviceContextGLImpl& Ctx) const
+    {
+        for (const CommandHeader* pCmd = m_pFirstCmd; pCmd != nullptr; pCmd = pCmd->pNext)
+            pCmd->Execute(*pCmd, Ctx);
+    }
+
+    Uint32 GetNumCommands() const { return m_NumCommands; }
+
+private:
+    static constexpr size_t DataAlignment = 16;
+
+    struct CommandHeader
+    {
+        using ExecuteProcType = void (*)(const CommandHeader&, DeviceContextGLImpl&);
+
+        ExecuteProcType Execute = nullptr;
+        CommandHeader*  pNext   = nullptr;
+    };
+
+    template <typename HandlerType>
+    struct Command final : CommandHeader
+    {
+        explicit Command(const HandlerType& _Handler) :
+            CommandHeader{&ExecuteProc},
+            Handler{_Handler}
+        {}
+
+        static void ExecuteProc(const CommandHeader& Cmd, DeviceContextGLImpl& Ctx)
+        {
+            static_cast<const Command&>(Cmd).Handler(Ctx);
+        }
+
+        const HandlerType Handler;
+    };
+
+    DynamicLinearAllocator m_Allocator;
+
+    CommandHeader* m_pFirstCmd   = nullptr;
+    CommandHeader* m_pLastCmd    = nullptr;
+    Uint32         m_NumCommands = 0;
+
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+};
+
+} // namespace Diligent
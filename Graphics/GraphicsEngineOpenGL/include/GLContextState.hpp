@@ -29,6 +29,7 @@
 
 #include <limits>
 #include <vector>
+#include <algorithm>
 
 #include "GraphicsTypes.h"
 #include "GLObjectWrapper.hpp"
@@ -59,6 +60,17 @@ public:
     void BindImage         (Uint32 Index, class BufferViewGLImpl* pBuffView, GLenum Access, GLenum Format);
     void BindStorageBlock  (Int32 Index, const GLObjectWrappers::GLBufferObj& Buff, GLintptr Offset, GLsizeiptr Size);
 
+    // clang-format on
+
+    // When multi-bind is supported, BindTexture, BindSampler, BindUniformBuffer and BindStorageBlock calls
+    // with non-negative indices made between BeginBatchedBinding() and CommitBatchedBindings() only update
+    // the shadow state. CommitBatchedBindings() then issues contiguous ranges of the changed slots with
+    // glBindTextures, glBindSamplers and glBindBuffersRange. Texture units are not activated in this mode.
+    void BeginBatchedBinding();
+    void CommitBatchedBindings();
+
+    // clang-format off
+
     void EnsureMemoryBarrier(MEMORY_BARRIER RequiredBarriers, class AsyncWritableResource *pRes = nullptr);
     void SetPendingMemoryBarriers(MEMORY_BARRIER PendingBarriers);
 
@@ -116,6 +128,7 @@ public:
         bool  IsFillModeSelectionSupported = true;
         bool  IsProgramPipelineSupported   = true;
         bool  IsDepthClampSupported        = true;
+        bool  IsMultiBindSupported         = false;
         GLint MaxCombinedTexUnits          = 0;
         GLint MaxDrawBuffers               = 0;
         GLint MaxUniformBufferBindings     = 0;
@@ -151,6 +164,8 @@ private:
     {
         UniqueIdentifier TexID      = -1;
         GLenum           BindTarget = 0;
+        GLuint           GLHandle   = 0;
+        bool             Pending    = false; // Updated in batched mode, but not yet committed
 
         constexpr bool operator!=(const BoundTextureInfo& rhs) const
         {
@@ -165,17 +180,21 @@ private:
     {
         BoundBufferInfo() {}
         BoundBufferInfo(UniqueIdentifier _BufferID,
+                        GLuint           _GLHandle,
                         GLintptr         _Offset,
                         GLsizeiptr       _Size) :
             // clang-format off
             BufferID{_BufferID},
+            GLHandle{_GLHandle},
             Offset  {_Offset},
             Size    {_Size}
         // clang-format on
         {}
         UniqueIdentifier BufferID = -1;
+        GLuint           GLHandle = 0;
         GLintptr         Offset   = 0;
         GLsizeiptr       Size     = 0;
+        bool             Pending  = false; // Updated in batched mode, but not yet committed
 
         constexpr bool operator!=(const BoundBufferInfo& rhs) const
         {
@@ -231,12 +250,44 @@ private:
         }
     };
 
+    struct BoundSamplerInfo
+    {
+        UniqueIdentifier SamplerID = -1;
+        GLuint           GLHandle  = 0;
+        bool             Pending   = false; // Updated in batched mode, but not yet committed
+    };
+
     std::vector<BoundTextureInfo> m_BoundTextures;
-    std::vector<UniqueIdentifier> m_BoundSamplers;
+    std::vector<BoundSamplerInfo> m_BoundSamplers;
     std::vector<BoundBufferInfo>  m_BoundUniformBuffers;
     std::vector<BoundImageInfo>   m_BoundImages;
     std::vector<BoundBufferInfo>  m_BoundStorageBlocks;
 
+    // Range of slots that may contain pending bindings
+    struct PendingSlotRange
+    {
+        Uint32 First = ~0u;
+        Uint32 Last  = 0;
+
+        void Add(Uint32 Slot)
+        {
+            First = (std::min)(First, Slot);
+            Last  = (std::max)(Last, Slot);
+        }
+        bool IsEmpty() const { return First > Last; }
+    };
+    PendingSlotRange m_PendingTextures;
+    PendingSlotRange m_PendingSamplers;
+    PendingSlotRange m_PendingUniformBuffers;
+    PendingSlotRange m_PendingStorageBlocks;
+
+    bool m_BatchedBinding = false;
+
+    // Scratch arrays for multi-bind calls
+    std::vector<GLuint>     m_MultiBindHandles;
+    std::vector<GLintptr>   m_MultiBindOffsets;
+    std::vector<GLsizeiptr> m_MultiBindSizes;
+
     MEMORY_BARRIER m_PendingMemoryBarriers = MEMORY_BARRIER_NONE;
 
     class EnableStateHelper
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLDynamicHeap class
+
+#include <deque>
+
+#include "GLObjectWrapper.hpp"
+#include "RingBuffer.hpp"
+
+namespace Diligent
+{
+
+class GLContextState;
+
+/// Describes a chunk of memory suballocated from the dynamic heap
+struct GLDynamicAllocation
+{
+    /// Heap buffer the allocation resides in
+    const GLObjectWrappers::GLBufferObj* pBuffer = nullptr;
+
+    /// Offset from the start of the buffer
+    Uint64 Offset = 0;
+
+    /// CPU address of the allocation
+    Uint8* CPUAddress = nullptr;
+
+    explicit operator bool() const
+    {
+        return pBuffer != nullptr;
+    }
+};
+
+// The dynamic heap is used by the device context to suballocate memory for USAGE_DYNAMIC
+// buffers when they are mapped with MAP_FLAG_DISCARD. The heap uses a single buffer that is created
+// with glBufferStorage() and is persistently and coherently mapped, so that no glMapBufferRange() /
+// glUnmapBuffer() round-trips are required. Memory is allocated in a ring fashion; the space used
+// in a frame is released when the GL fence inserted by FinishFrame() is signaled.
+//
+//   ______________________________________________________________________
+//  |                                                                      |
+//  |                         GLDynamicHeap buffer                         |
+//  |  || Frame N-2 allocations | Frame N-1 allocations | Frame N ... ||   |
+//  |______________________________________________________________________|
+//               A                                             |
+//               |                                             |
+//           Released when                            Allocate()
+//           frame fence is signaled
+//
+class GLDynamicHeap
+{
+public:
+    GLDynamicHeap(IMemoryAllocator& Allocator, GLContextState& GLState, Uint64 Size, Uint32 Alignment);
+    ~GLDynamicHeap();
+
+    // clang-format off
+    GLDynamicHeap            (const GLDynamicHeap&)  = delete;
+    GLDynamicHeap            (      GLDynamicHeap&&) = delete;
+    GLDynamicHeap& operator= (const GLDynamicHeap&)  = delete;
+    GLDynamicHeap& operator= (      GLDynamicHeap&&) = delete;
+    // clang-format on
+
+    /// Allocates Size bytes from the heap.
+    /// If there is not enough space, waits for the previous frames to complete.
+    /// Returns an empty allocation if the request can't be satisfied.
+    GLDynamicAllocation Allocate(Uint64 Size);
+
+    /// Inserts the fence for the current frame and releases the space used
+    /// by the frames that have been completed by the GPU.
+    void FinishFrame();
+
+    Uint64 GetSize() const { return m_RingBuffer.GetMaxSize(); }
+
+private:
+    // Releases the frames whose fences have been signaled.
+    // If WaitForOldest is true, waits for the oldest pending fence first.
+    void ReleaseCompletedFrames(bool WaitForOldest);
+
+    GLObjectWrappers::GLBufferObj m_Buffer{false};
+
+    Uint8* m_CPUAddress = nullptr;
+
+    const Uint32 m_Alignment;
+
+    RingBuffer m_RingBuffer;
+
+    std::deque<std::pair<Uint64, GLObjectWrappers::GLSyncObj>> m_PendingFences;
+
+    Uint64 m_NextFenceValue = 1;
+
+    Uint64 m_PeakFrameSize = 0;
+    Uint64 m_CurrFrameSize = 0;
+};
+
+} // namespace Diligent
@@ -32,6 +32,7 @@
 #include "GLObjectWrapper.hpp"
 #include "ShaderResourcesGL.hpp"
 #include "PipelineResourceSignatureGLImpl.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 namespace Diligent
 {
@@ -42,9 +43,10 @@ class GLContextState;
 class GLProgram
 {
 public:
-    GLProgram(ShaderGLImpl* const* ppShaders,
-              Uint32               NumShaders,
-              bool                 IsSeparableProgram) noexcept;
+    GLProgram(ShaderGLImpl* const*      ppShaders,
+              Uint32                    NumShaders,
+              bool                      IsSeparableProgram,
+              PipelineStateCacheGLImpl* pPSOCache = nullptr) noexcept;
     ~GLProgram();
 
     const GLObjectWrappers::GLProgramObj& GetGLHandle() const { return m_GLProg; }
@@ -87,6 +89,10 @@ private:
 
     std::shared_ptr<const ShaderResourcesGL> m_pResources;
 
+    // The cache to store the program binary to once the program is linked
+    RefCntAutoPtr<PipelineStateCacheGLImpl> m_pPSOCache;
+    PipelineStateCacheGLImpl::ProgramKey    m_PSOCacheKey;
+
 #ifdef DILIGENT_DEBUG
     PipelineResourceSignatureGLImpl::TBindings m_DbgBaseBindings{};
 #endif
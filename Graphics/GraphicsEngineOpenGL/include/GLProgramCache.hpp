@@ -27,17 +27,18 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
 #include <mutex>
 #include <vector>
 
 #include "GraphicsTypesX.hpp"
+#include "FlatHashMap.hpp"
 #include "GLProgram.hpp"
 
 namespace Diligent
 {
 
 class ShaderGLImpl;
+class PipelineStateCacheGLImpl;
 
 /// Program cached contains linked programs for the given combination of shaders and resource layouts.
 class GLProgramCache
@@ -63,6 +64,7 @@ public:
         PipelineResourceLayoutDesc*  pResourceLayout    = nullptr;
         IPipelineResourceSignature** ppSignatures       = nullptr;
         Uint32                       NumSignatures      = 0;
+        PipelineStateCacheGLImpl*    pPSOCache          = nullptr;
     };
 
     SharedGLProgramObjPtr GetProgram(const GetProgramAttribs& Attribs);
@@ -95,8 +97,8 @@ private:
         }
     };
 
-    std::mutex                                                                           m_CacheMtx;
-    std::unordered_map<ProgramCacheKey, std::weak_ptr<GLProgram>, ProgramCacheKeyHasher> m_Cache;
+    std::mutex                                                                    m_CacheMtx;
+    FlatHashMap<ProgramCacheKey, std::weak_ptr<GLProgram>, ProgramCacheKeyHasher> m_Cache;
 };
 
 } // namespace Diligent
@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineStateCacheGLImpl class
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineGLImplTraits.hpp"
+#include "PipelineStateCacheBase.hpp"
+
+namespace Diligent
+{
+
+class ShaderGLImpl;
+
+/// Pipeline state cache object implementation in OpenGL backend.
+
+/// The cache stores linked program binaries obtained with glGetProgramBinary() keyed by
+/// the hash of the program's shader sources. The cache data is only valid for the driver
+/// it was created with: the data is discarded when loaded on a different vendor, renderer
+/// or driver version.
+class PipelineStateCacheGLImpl final : public PipelineStateCacheBase<EngineGLImplTraits>
+{
+public:
+    using TPipelineStateCacheBase = PipelineStateCacheBase<EngineGLImplTraits>;
+
+    PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                             RenderDeviceGLImpl*                 pDeviceGL,
+                             const PipelineStateCacheCreateInfo& CreateInfo);
+    ~PipelineStateCacheGLImpl();
+
+    /// Implementation of IPipelineStateCache::GetData().
+    virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
+
+    struct ProgramKey
+    {
+        size_t Hash = 0;
+
+        // Total length of all shader sources, reduces the probability of
+        // collisions on platforms where size_t is 32-bit.
+        Uint64 SourceLength = 0;
+
+        bool operator==(const ProgramKey& rhs) const noexcept
+        {
+            return Hash == rhs.Hash && SourceLength == rhs.SourceLength;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const ProgramKey& Key) const noexcept
+            {
+                return Key.Hash;
+            }
+        };
+    };
+
+    /// Computes the key for the program linked from the given shaders.
+    static ProgramKey ComputeProgramKey(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+
+    /// Loads the program binary with the given key into the GL program object.
+    /// Returns true if the binary was found and the program was successfully loaded.
+    bool LoadProgram(const ProgramKey& Key, GLuint GLProgram);
+
+    /// Retrieves the binary of the linked GL program object and adds it to the cache.
+    void StoreProgram(const ProgramKey& Key, GLuint GLProgram);
+
+    bool IsLoadEnabled() const { return m_IsSupported && (m_Desc.Mode & PSO_CACHE_MODE_LOAD) != 0; }
+    bool IsStoreEnabled() const { return m_IsSupported && (m_Desc.Mode & PSO_CACHE_MODE_STORE) != 0; }
+
+private:
+    bool Load(const void* pData, size_t DataSize);
+
+private:
+    // GL vendor, renderer and version strings
+    const std::string m_DriverId;
+
+    bool m_IsSupported = false;
+
+    struct ProgramBinary
+    {
+        GLenum             Format = 0;
+        std::vector<Uint8> Data;
+    };
+
+    std::mutex                                                        m_BinariesMtx;
+    std::unordered_map<ProgramKey, ProgramBinary, ProgramKey::Hasher> m_Binaries;
+};
+
+} // namespace Diligent
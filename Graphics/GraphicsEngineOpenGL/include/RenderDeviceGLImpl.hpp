@@ -219,11 +219,16 @@ public:
 
     struct GLDeviceCaps
     {
-        bool FramebufferSRGB  = false;
-        bool SemalessCubemaps = false;
+        bool FramebufferSRGB     = false;
+        bool SemalessCubemaps    = false;
+        bool BufferStorage       = false;
+        bool VertexAttribBinding = false;
+        bool MultiBind           = false;
     };
     const GLDeviceCaps& GetGLCaps() const { return m_GLCaps; }
 
+    Uint32 GetDynamicHeapSize() const { return m_DynamicHeapSize; }
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -257,6 +262,8 @@ private:
 
     GLDeviceLimits m_DeviceLimits = {};
     GLDeviceCaps   m_GLCaps       = {};
+
+    const Uint32 m_DynamicHeapSize;
 };
 
 } // namespace Diligent
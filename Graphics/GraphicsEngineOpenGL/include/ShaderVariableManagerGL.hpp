@@ -201,6 +201,9 @@ public:
 
     IObject& GetOwner() { return m_Owner; }
 
+    using TBase::GetSignature;
+    using TBase::GetResourceCache;
+
     Uint32 GetVariableCount() const
     {
         return GetNumUBs() + GetNumTextures() + GetNumImages() + GetNumStorageBuffers();
@@ -252,7 +255,7 @@ private:
     }
 
     template <typename ResourceType>
-    IShaderResourceVariable* GetResourceByName(const Char* Name) const;
+    IShaderResourceVariable* GetResourceByResIndex(Uint32 ResIndex) const;
 
     template <typename THandleUB,
               typename THandleTexture,
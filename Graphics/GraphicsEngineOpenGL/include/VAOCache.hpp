@@ -47,7 +47,10 @@ class BufferGLImpl;
 class VAOCache
 {
 public:
-    VAOCache();
+    // When UseVertexAttribBinding is true, the cache keeps one VAO per PSO that only
+    // defines the vertex format (GL_ARB_vertex_attrib_binding), while buffers are
+    // bound with glBindVertexBuffer every time the VAO is requested.
+    explicit VAOCache(bool UseVertexAttribBinding);
     ~VAOCache();
 
     // clang-format off
@@ -78,7 +81,7 @@ private:
     // This structure is used as the key to find VAO
     struct VAOHashKey
     {
-        VAOHashKey(const VAOAttribs& Attribs);
+        VAOHashKey(const VAOAttribs& Attribs, bool IncludeBuffers);
 
         // Note that using pointers is unsafe as they may (and will) be reused:
         // pBuffer->Release();
@@ -87,7 +90,8 @@ private:
         // VAO encapsulates both input layout and all bound buffers.
         // PSO uniquely defines the layout (attrib pointers, divisors, etc.),
         // so we do not need to add individual layout elements to the key.
-        // The key needs to contain all bound buffers.
+        // The key needs to contain all bound buffers unless vertex attrib binding
+        // is used, in which case buffer UIDs and offsets are zero.
         UniqueIdentifier PsoUId         = 0;
         UniqueIdentifier IndexBufferUId = 0;
 
@@ -123,6 +127,14 @@ private:
     // Clears stale entries from m_PSOToKey and m_BuffToKey when a VAO is removed from m_Cache
     void ClearStaleKeys(const std::vector<VAOHashKey>& StaleKeys);
 
+    // Initializes the vertex format of the currently bound VAO
+    void InitVertexFormat(const VAOAttribs& Attribs, GLContextState& GLState);
+
+    // Binds vertex and index buffers to the currently bound format-only VAO
+    void BindVertexBuffers(const VAOAttribs& Attribs, GLContextState& GLState);
+
+    const bool m_UseVertexAttribBinding;
+
     Threading::SpinLock                                                                    m_CacheLock;
     std::unordered_map<VAOHashKey, GLObjectWrappers::GLVertexArrayObj, VAOHashKey::Hasher> m_Cache;
 
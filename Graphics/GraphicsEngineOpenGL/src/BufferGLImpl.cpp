@@ -38,6 +38,17 @@
 namespace Diligent
 {
 
+static bool CanUseDynamicHeap(const BufferDesc& Desc, const RenderDeviceGLImpl& DeviceGL)
+{
+    // Only uniform buffers are suballocated from the dynamic heap: vertex and index buffer
+    // handles and offsets are part of the VAO state, so changing them on every map would
+    // defeat the VAO cache.
+    return (Desc.Usage == USAGE_DYNAMIC &&
+            Desc.BindFlags == BIND_UNIFORM_BUFFER &&
+            DeviceGL.GetGLCaps().BufferStorage &&
+            DeviceGL.GetDynamicHeapSize() != 0);
+}
+
 static GLenum GetBufferBindTarget(const BufferDesc& Desc)
 {
     GLenum Target = GL_ARRAY_BUFFER;
@@ -85,9 +96,10 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
         BuffDesc,
         bIsDeviceInternal
     },
-    m_GlBuffer    {true                          }, // Create buffer immediately
-    m_BindTarget  {GetBufferBindTarget(BuffDesc) },
-    m_GLUsageHint {UsageToGLUsage(BuffDesc)}
+    m_GlBuffer       {true                                   }, // Create buffer immediately
+    m_BindTarget     {GetBufferBindTarget(BuffDesc)          },
+    m_GLUsageHint    {UsageToGLUsage(BuffDesc)               },
+    m_UseDynamicHeap {CanUseDynamicHeap(BuffDesc, *pDeviceGL)}
 // clang-format on
 {
     ValidateBufferInitData(BuffDesc, pBuffData);
@@ -199,9 +211,10 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
         bIsDeviceInternal
     },
     // Attach to external buffer handle
-    m_GlBuffer    {true, GLObjectWrappers::GLBufferObjCreateReleaseHelper(GLHandle)},
-    m_BindTarget  {GetBufferBindTarget(m_Desc)},
-    m_GLUsageHint {UsageToGLUsage(BuffDesc)   }
+    m_GlBuffer       {true, GLObjectWrappers::GLBufferObjCreateReleaseHelper(GLHandle)},
+    m_BindTarget     {GetBufferBindTarget(m_Desc)},
+    m_GLUsageHint    {UsageToGLUsage(BuffDesc)   },
+    m_UseDynamicHeap {false                      }
 // clang-format on
 {
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
@@ -253,7 +266,9 @@ void BufferGLImpl::CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL,
     // what was bound to the target before your copy.
     constexpr bool ResetVAO = false; // No need to reset VAO for READ/WRITE targets
     CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer, ResetVAO);
-    CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.m_GlBuffer, ResetVAO);
+    // The source buffer may be suballocated from the dynamic heap
+    CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.GetDataGLHandle(), ResetVAO);
+    SrcOffset += SrcBufferGL.GetDataOffset();
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, StaticCast<GLintptr>(SrcOffset), StaticCast<GLintptr>(DstOffset), StaticCast<GLsizeiptr>(Size));
     DEV_CHECK_GL_ERROR("glCopyBufferSubData() failed");
     CtxState.BindBuffer(GL_COPY_READ_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
@@ -33,6 +33,8 @@
 #include <fstream>
 #include <string>
 #include <array>
+#include <algorithm>
+#include <cstring>
 
 #include "SwapChainGL.h"
 
@@ -49,6 +51,7 @@
 #include "PipelineStateGLImpl.hpp"
 #include "FenceGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
+#include "CommandListGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
@@ -74,6 +77,13 @@ DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters*      pRefCounters,
 {
     m_BoundWritableTextures.reserve(16);
     m_BoundWritableBuffers.reserve(16);
+
+    // Deferred contexts never issue GL calls and do not need the dynamic heap
+    if (!IsDeferred() && pDeviceGL->GetGLCaps().BufferStorage && pDeviceGL->GetDynamicHeapSize() != 0)
+    {
+        const auto& BufferProps = pDeviceGL->GetAdapterInfo().Buffer;
+        m_pDynamicHeap          = std::make_unique<GLDynamicHeap>(GetRawAllocator(), m_ContextState, pDeviceGL->GetDynamicHeapSize(), BufferProps.ConstantBufferOffsetAlignment);
+    }
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceContextBase)
@@ -81,20 +91,41 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceConte
 
 void DeviceContextGLImpl::Begin(Uint32 ImmediateContextId)
 {
-    UNEXPECTED("OpenGL does not support deferred contexts");
-    (void)(ImmediateContextId);
+    DEV_CHECK_ERR(ImmediateContextId == 0, "OpenGL supports only one immediate context");
+    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, COMMAND_QUEUE_TYPE_GRAPHICS);
+
+    VERIFY(!m_pCommandStream, "The command stream should have been released by FinishCommandList()");
+    m_pCommandStream = std::make_unique<GLCommandStream>(GetRawAllocator());
+}
+
+GLCommandStream& DeviceContextGLImpl::GetCommandStream()
+{
+    VERIFY(IsDeferred(), "Only deferred contexts record commands");
+    DEV_CHECK_ERR(m_pCommandStream, "Deferred context is not recording commands. Call Begin() first.");
+    return *m_pCommandStream;
 }
 
 void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextGLImpl::SetPipelineState");
+
     VERIFY_EXPR(pPipelineState != nullptr);
 
-    RefCntAutoPtr<PipelineStateGLImpl> pPipelineStateGLImpl{pPipelineState, PipelineStateGLImpl::IID_InternalImpl};
-    VERIFY(pPipelineState == nullptr || pPipelineStateGLImpl != nullptr, "Unknown pipeline state object implementation");
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pPSO = Stream.KeepAlive(pPipelineState)](DeviceContextGLImpl& Ctx) { Ctx.SetPipelineState(pPSO); });
+        return;
+    }
+
+    BorrowedPtr<PipelineStateGLImpl> pPipelineStateGLImpl = BorrowPipelineState(pPipelineState);
     if (PipelineStateGLImpl::IsSameObject(m_pPipelineState, pPipelineStateGLImpl))
+    {
+        ++m_Stats.CommandCounters.RedundantSetPipelineState;
         return;
+    }
 
-    TDeviceContextBase::SetPipelineState(std::move(pPipelineStateGLImpl), 0 /*Dummy*/);
+    TDeviceContextBase::SetPipelineState(pPipelineStateGLImpl, 0 /*Dummy*/);
 
     const auto& Desc = m_pPipelineState->GetDesc();
     if (Desc.PipelineType == PIPELINE_TYPE_COMPUTE)
@@ -176,6 +207,17 @@ void DeviceContextGLImpl::TransitionShaderResources(IShaderResourceBinding* pSha
 
 void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextGLImpl::CommitShaderResources");
+
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pSRB = Stream.KeepAlive(pShaderResourceBinding), StateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.CommitShaderResources(pSRB, StateTransitionMode);
+        });
+        return;
+    }
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0);
 
     auto* const pShaderResBindingGL = ClassPtrCast<ShaderResourceBindingGLImpl>(pShaderResourceBinding);
@@ -190,6 +232,12 @@ void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
 
 void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
 {
+    if (IsDeferred())
+    {
+        GetCommandStream().Record([StencilRef](DeviceContextGLImpl& Ctx) { Ctx.SetStencilRef(StencilRef); });
+        return;
+    }
+
     if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
     {
         m_ContextState.SetStencilRef(GL_FRONT, StencilRef);
@@ -199,6 +247,13 @@ void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
 
 void DeviceContextGLImpl::SetBlendFactors(const float* pBlendFactors)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pFactors = Stream.CopyArray(pBlendFactors, 4)](DeviceContextGLImpl& Ctx) { Ctx.SetBlendFactors(pFactors); });
+        return;
+    }
+
     if (TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
     {
         m_ContextState.SetBlendFactors(m_BlendFactors);
@@ -212,12 +267,36 @@ void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
-    m_ContextState.InvalidateVAO();
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        for (Uint32 i = 0; ppBuffers != nullptr && i < NumBuffersSet; ++i)
+            Stream.KeepAlive(ppBuffers[i]);
+
+        Stream.Record([StartSlot, NumBuffersSet,
+                       ppBuffersCopy = Stream.CopyArray(ppBuffers, NumBuffersSet),
+                       pOffsetsCopy  = Stream.CopyArray(pOffsets, NumBuffersSet),
+                       StateTransitionMode, Flags](DeviceContextGLImpl& Ctx) {
+            Ctx.SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffersCopy, pOffsetsCopy, StateTransitionMode, Flags);
+        });
+        return;
+    }
+
+    if (TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags, 0))
+        m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::InvalidateState()
 {
+    if (IsDeferred())
+    {
+        // Every command list starts from the default state, so there is nothing to invalidate
+        // outside of the recording.
+        if (m_pCommandStream)
+            m_pCommandStream->Record([](DeviceContextGLImpl& Ctx) { Ctx.InvalidateState(); });
+        return;
+    }
+
     TDeviceContextBase::InvalidateState();
 
     m_ContextState.Invalidate();
@@ -229,13 +308,32 @@ void DeviceContextGLImpl::InvalidateState()
 
 void DeviceContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
-    m_ContextState.InvalidateVAO();
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pIB = Stream.KeepAlive(pIndexBuffer), ByteOffset, StateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.SetIndexBuffer(pIB, ByteOffset, StateTransitionMode);
+        });
+        return;
+    }
+
+    if (TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode, 0))
+        m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([NumViewports, pViewportsCopy = Stream.CopyArray(pViewports, NumViewports), RTWidth, RTHeight](DeviceContextGLImpl& Ctx) {
+            Ctx.SetViewports(NumViewports, pViewportsCopy, RTWidth, RTHeight);
+        });
+        return;
+    }
+
+    if (!TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        return;
 
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
     if (NumViewports == 1)
@@ -317,7 +415,17 @@ void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
 
 void DeviceContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([NumRects, pRectsCopy = Stream.CopyArray(pRects, NumRects), RTWidth, RTHeight](DeviceContextGLImpl& Ctx) {
+            Ctx.SetScissorRects(NumRects, pRectsCopy, RTWidth, RTHeight);
+        });
+        return;
+    }
+
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
     if (NumRects == 1)
@@ -419,10 +527,77 @@ void DeviceContextGLImpl::CommitRenderTargets()
     SetViewports(1, nullptr, 0, 0);
 }
 
+void DeviceContextGLImpl::InvalidateRenderTargets(bool InvalidateColor, bool InvalidateDepthStencil)
+{
+    if (glInvalidateFramebuffer == nullptr)
+        return;
+
+    // It is crucially important to invalidate the framebuffer while it is bound (see EndSubpass)
+    CommitRenderTargets();
+
+    // Attachments of the default framebuffer are identified by the buffer names
+    const bool IsDefaultFramebuffer = m_IsDefaultFBOBound && GetDefaultFBO() == 0;
+
+    GLsizei InvalidateAttachmentsCount = 0;
+
+    std::array<GLenum, MAX_RENDER_TARGETS + 2> InvalidateAttachments;
+    if (InvalidateColor)
+    {
+        for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+        {
+            if (m_pBoundRenderTargets[rt])
+                InvalidateAttachments[InvalidateAttachmentsCount++] = IsDefaultFramebuffer ? GL_COLOR : GL_COLOR_ATTACHMENT0 + rt;
+        }
+    }
+
+    if (InvalidateDepthStencil && m_pBoundDepthStencil)
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(m_pBoundDepthStencil->GetDesc().Format);
+        VERIFY_EXPR(FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH || FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL);
+        if (IsDefaultFramebuffer)
+        {
+            InvalidateAttachments[InvalidateAttachmentsCount++] = GL_DEPTH;
+            if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+                InvalidateAttachments[InvalidateAttachmentsCount++] = GL_STENCIL;
+        }
+        else
+        {
+            InvalidateAttachments[InvalidateAttachmentsCount++] = FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH ? GL_DEPTH_ATTACHMENT : GL_DEPTH_STENCIL_ATTACHMENT;
+        }
+    }
+
+    if (InvalidateAttachmentsCount > 0)
+    {
+        glInvalidateFramebuffer(GL_DRAW_FRAMEBUFFER, InvalidateAttachmentsCount, InvalidateAttachments.data());
+        DEV_CHECK_GL_ERROR("glInvalidateFramebuffer() failed");
+    }
+}
+
 void DeviceContextGLImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        for (Uint32 rt = 0; Attribs.ppRenderTargets != nullptr && rt < Attribs.NumRenderTargets; ++rt)
+            Stream.KeepAlive(Attribs.ppRenderTargets[rt]);
+
+        SetRenderTargetsAttribs AttribsCopy = Attribs;
+        AttribsCopy.ppRenderTargets         = Stream.CopyArray(Attribs.ppRenderTargets, Attribs.NumRenderTargets);
+        AttribsCopy.pDepthStencil           = Stream.KeepAlive(Attribs.pDepthStencil);
+        AttribsCopy.pShadingRateMap         = Stream.KeepAlive(Attribs.pShadingRateMap);
+        Stream.Record([AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.SetRenderTargetsExt(AttribsCopy); });
+        return;
+    }
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
 
+    if ((m_RenderTargetsFlags & SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL_ON_UNBIND) != 0 &&
+        m_pBoundDepthStencil && static_cast<ITextureView*>(m_pBoundDepthStencil.RawPtr()) != Attribs.pDepthStencil)
+    {
+        // The depth-stencil buffer is being unbound
+        InvalidateRenderTargets(false, true);
+    }
+
     if (TDeviceContextBase::SetRenderTargets(Attribs))
     {
         if (m_NumBoundRenderTargets == 1 && m_pBoundRenderTargets[0] && m_pBoundRenderTargets[0]->GetTexture<TextureBaseGL>()->GetGLHandle() == 0)
@@ -443,11 +618,19 @@ void DeviceContextGLImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Att
         }
 
         CommitRenderTargets();
+
+        const bool DiscardRenderTargets = (m_RenderTargetsFlags & SET_RENDER_TARGETS_FLAG_DISCARD_RENDER_TARGETS) != 0;
+        const bool DiscardDepthStencil  = (m_RenderTargetsFlags & SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL) != 0;
+        if (DiscardRenderTargets || DiscardDepthStencil)
+            InvalidateRenderTargets(DiscardRenderTargets, DiscardDepthStencil);
     }
 }
 
 void DeviceContextGLImpl::ResetRenderTargets()
 {
+    if ((m_RenderTargetsFlags & SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL_ON_UNBIND) != 0 && m_pBoundDepthStencil)
+        InvalidateRenderTargets(false, true);
+
     TDeviceContextBase::ResetRenderTargets();
     m_IsDefaultFBOBound = false;
     m_ContextState.InvalidateFBO();
@@ -636,6 +819,18 @@ void DeviceContextGLImpl::EndSubpass()
 
 void DeviceContextGLImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+
+        BeginRenderPassAttribs AttribsCopy = Attribs;
+        AttribsCopy.pRenderPass            = Stream.KeepAlive(Attribs.pRenderPass);
+        AttribsCopy.pFramebuffer           = Stream.KeepAlive(Attribs.pFramebuffer);
+        AttribsCopy.pClearValues           = Stream.CopyArray(Attribs.pClearValues, Attribs.ClearValueCount);
+        Stream.Record([AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.BeginRenderPass(AttribsCopy); });
+        return;
+    }
+
     TDeviceContextBase::BeginRenderPass(Attribs);
 
     m_AttachmentClearValues.resize(Attribs.ClearValueCount);
@@ -651,6 +846,12 @@ void DeviceContextGLImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 
 void DeviceContextGLImpl::NextSubpass()
 {
+    if (IsDeferred())
+    {
+        GetCommandStream().Record([](DeviceContextGLImpl& Ctx) { Ctx.NextSubpass(); });
+        return;
+    }
+
     EndSubpass();
     TDeviceContextBase::NextSubpass();
     BeginSubpass();
@@ -659,6 +860,12 @@ void DeviceContextGLImpl::NextSubpass()
 
 void DeviceContextGLImpl::EndRenderPass()
 {
+    if (IsDeferred())
+    {
+        GetCommandStream().Record([](DeviceContextGLImpl& Ctx) { Ctx.EndRenderPass(); });
+        return;
+    }
+
     EndSubpass();
     TDeviceContextBase::EndRenderPass();
     m_ContextState.InvalidateFBO();
@@ -688,6 +895,8 @@ void DeviceContextGLImpl::BindProgramResources(Uint32 BindSRBMask)
 
     m_CommittedResourcesTentativeBarriers = MEMORY_BARRIER_NONE;
 
+    // Collect bindings from all resource caches and commit them with multi-bind calls, if supported
+    m_ContextState.BeginBatchedBinding();
     while (BindSRBMask != 0)
     {
         auto SignBit = ExtractLSB(BindSRBMask);
@@ -712,6 +921,7 @@ void DeviceContextGLImpl::BindProgramResources(Uint32 BindSRBMask)
             pResourceCache->BindDynamicBuffers(GetContextState(), BaseBindings);
         }
     }
+    m_ContextState.CommitBatchedBindings();
     m_BindInfo.StaleSRBMask &= ~m_BindInfo.ActiveSRBMask;
 
 
@@ -856,6 +1066,13 @@ inline void DrawArrays(GLenum  GlTopology,
 
 void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GetCommandStream().Record([Attribs](DeviceContextGLImpl& Ctx) { Ctx.Draw(Attribs); });
+        return;
+    }
+
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::Draw(Attribs, 0);
 
     GLenum GlTopology;
@@ -894,6 +1111,16 @@ inline void MultiDrawArrays(GLenum         GlTopology,
 
 void DeviceContextGLImpl::MultiDraw(const MultiDrawAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto&            Stream      = GetCommandStream();
+        MultiDrawAttribs AttribsCopy = Attribs;
+        AttribsCopy.pDrawItems       = Stream.CopyArray(Attribs.pDrawItems, Attribs.DrawCount);
+        Stream.Record([AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.MultiDraw(AttribsCopy); });
+        return;
+    }
+
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDraw(Attribs, 0);
 
     GLenum GlTopology;
@@ -988,6 +1215,13 @@ inline void DrawElements(GLenum  GlTopology,
 
 void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GetCommandStream().Record([Attribs](DeviceContextGLImpl& Ctx) { Ctx.DrawIndexed(Attribs); });
+        return;
+    }
+
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexed(Attribs, 0);
 
     GLenum GlTopology;
@@ -1042,6 +1276,16 @@ inline void MultiDrawElements(GLenum   GlTopology,
 
 void DeviceContextGLImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto&                   Stream      = GetCommandStream();
+        MultiDrawIndexedAttribs AttribsCopy = Attribs;
+        AttribsCopy.pDrawItems              = Stream.CopyArray(Attribs.pDrawItems, Attribs.DrawCount);
+        Stream.Record([AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.MultiDrawIndexed(AttribsCopy); });
+        return;
+    }
+
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDrawIndexed(Attribs, 0);
 
     GLenum GlTopology;
@@ -1154,6 +1398,16 @@ void DeviceContextGLImpl::PrepareForIndirectDrawCount(IBuffer* pCountBuffer)
 
 void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.KeepAlive(Attribs.pAttribsBuffer);
+        Stream.KeepAlive(Attribs.pCounterBuffer);
+        Stream.Record([Attribs](DeviceContextGLImpl& Ctx) { Ctx.DrawIndirect(Attribs); });
+        return;
+    }
+
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndirect(Attribs, 0);
 
     GLenum GlTopology;
@@ -1228,6 +1482,16 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.KeepAlive(Attribs.pAttribsBuffer);
+        Stream.KeepAlive(Attribs.pCounterBuffer);
+        Stream.Record([Attribs](DeviceContextGLImpl& Ctx) { Ctx.DrawIndexedIndirect(Attribs); });
+        return;
+    }
+
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexedIndirect(Attribs, 0);
 
     GLenum GlTopology;
@@ -1320,6 +1584,13 @@ void DeviceContextGLImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
 
 void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GetCommandStream().Record([Attribs](DeviceContextGLImpl& Ctx) { Ctx.DispatchCompute(Attribs); });
+        return;
+    }
+
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchCompute(Attribs, 0);
 
 #if GL_ARB_compute_shader
@@ -1350,6 +1621,15 @@ void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
 void DeviceContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.KeepAlive(Attribs.pAttribsBuffer);
+        Stream.Record([Attribs](DeviceContextGLImpl& Ctx) { Ctx.DispatchComputeIndirect(Attribs); });
+        return;
+    }
+
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchComputeIndirect(Attribs, 0);
 
 #if GL_ARB_compute_shader
@@ -1396,6 +1676,15 @@ void DeviceContextGLImpl::ClearDepthStencil(ITextureView*                  pView
                                             Uint8                          Stencil,
                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pView = Stream.KeepAlive(pView), ClearFlags, fDepth, Stencil, StateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.ClearDepthStencil(pView, ClearFlags, fDepth, Stencil, StateTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::ClearDepthStencil(pView);
 
     if (pView != m_pBoundDepthStencil)
@@ -1435,6 +1724,16 @@ void DeviceContextGLImpl::ClearDepthStencil(ITextureView*                  pView
 
 void DeviceContextGLImpl::ClearRenderTarget(ITextureView* pView, const void* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        // The clear color is four 32-bit float or integer components
+        Stream.Record([pView = Stream.KeepAlive(pView), pColor = Stream.CopyArray(static_cast<const Uint32*>(RGBA), 4), StateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.ClearRenderTarget(pView, pColor, StateTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::ClearRenderTarget(pView);
 
     Int32 RTIndex = -1;
@@ -1499,27 +1798,65 @@ void DeviceContextGLImpl::ClearRenderTarget(ITextureView* pView, const void* RGB
 
 void DeviceContextGLImpl::Flush()
 {
+    if (IsDeferred())
+    {
+        DEV_ERROR("Flush() should only be called for immediate contexts");
+        return;
+    }
+
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextGLImpl::Flush");
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Flushing device context inside an active render pass.");
 
     glFlush();
+    ++m_Stats.SubmitCount;
 
     m_BindInfo = {};
 }
 
 void DeviceContextGLImpl::FinishFrame()
 {
+    if (m_pDynamicHeap)
+        m_pDynamicHeap->FinishFrame();
+
     TDeviceContextBase::EndFrame();
 }
 
 void DeviceContextGLImpl::FinishCommandList(ICommandList** ppCommandList)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    DEV_CHECK_ERR(IsDeferred(), "Only deferred contexts can record command list");
+    DEV_CHECK_ERR(m_DeferredMappedBuffers.empty(), "All buffers mapped by the deferred context must be unmapped before finishing the command list");
+    m_DeferredMappedBuffers.clear();
+
+    CommandListGLImpl* pCmdListGL{NEW_RC_OBJ(GetRawAllocator(), "CommandListGLImpl instance", CommandListGLImpl)(m_pDevice, this, std::move(m_pCommandStream))};
+    pCmdListGL->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+
+    TDeviceContextBase::FinishCommandList();
 }
 
 void DeviceContextGLImpl::ExecuteCommandLists(Uint32               NumCommandLists,
                                               ICommandList* const* ppCommandLists)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    DEV_CHECK_ERR(!IsDeferred(), "Only immediate context can execute command list");
+
+    if (NumCommandLists == 0)
+        return;
+    DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
+
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        // Similar to other backends, every command list starts from the default state
+        InvalidateState();
+
+        // The commands are replayed through the regular immediate context methods
+        // on this thread, which owns the GL context.
+        // GL command lists are immutable and may be executed any number of times.
+        auto* pCmdListGL = ClassPtrCast<CommandListGLImpl>(ppCommandLists[i]);
+        pCmdListGL->GetCommands().Execute(*this);
+    }
+
+    // Do not leak the state set by the last command list
+    InvalidateState();
 }
 
 void DeviceContextGLImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
@@ -1553,6 +1890,13 @@ void DeviceContextGLImpl::WaitForIdle()
 
 void DeviceContextGLImpl::BeginQuery(IQuery* pQuery)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pQuery = Stream.KeepAlive(pQuery)](DeviceContextGLImpl& Ctx) { Ctx.BeginQuery(pQuery); });
+        return;
+    }
+
     TDeviceContextBase::BeginQuery(pQuery, 0);
 
     auto* pQueryGLImpl = ClassPtrCast<QueryGLImpl>(pQuery);
@@ -1600,6 +1944,13 @@ void DeviceContextGLImpl::BeginQuery(IQuery* pQuery)
 
 void DeviceContextGLImpl::EndQuery(IQuery* pQuery)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pQuery = Stream.KeepAlive(pQuery)](DeviceContextGLImpl& Ctx) { Ctx.EndQuery(pQuery); });
+        return;
+    }
+
     TDeviceContextBase::EndQuery(pQuery, 0);
 
     auto* pQueryGLImpl = ClassPtrCast<QueryGLImpl>(pQuery);
@@ -1655,6 +2006,8 @@ void DeviceContextGLImpl::EndQuery(IQuery* pQuery)
 
 bool DeviceContextGLImpl::UpdateCurrentGLContext()
 {
+    DEV_CHECK_ERR(!IsDeferred(), "Deferred contexts do not use the GL context");
+
     auto NativeGLContext = m_pDevice->m_GLContext.GetCurrentNativeGLContext();
     if (NativeGLContext == NULL)
         return false;
@@ -1676,6 +2029,16 @@ void DeviceContextGLImpl::UpdateBuffer(IBuffer*                       pBuffer,
                                        const void*                    pData,
                                        RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        // Copy the data into the staging memory of the command stream
+        auto& Stream = GetCommandStream();
+        Stream.Record([pBuffer = Stream.KeepAlive(pBuffer), Offset, Size, pDataCopy = Stream.CopyData(pData, static_cast<size_t>(Size)), StateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.UpdateBuffer(pBuffer, Offset, Size, pDataCopy, StateTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
 
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
@@ -1690,6 +2053,16 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
                                      Uint64                         Size,
                                      RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pSrcBuffer = Stream.KeepAlive(pSrcBuffer), SrcOffset, SrcBufferTransitionMode,
+                       pDstBuffer = Stream.KeepAlive(pDstBuffer), DstOffset, Size, DstBufferTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
 
     auto* pSrcBufferGL = ClassPtrCast<BufferGLImpl>(pSrcBuffer);
@@ -1699,15 +2072,75 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
 
 void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    if (IsDeferred())
+    {
+        // The application writes the data into the staging memory of the command stream.
+        // The data is uploaded when the command list is executed.
+        pMappedData = nullptr;
+        if (MapType != MAP_WRITE || (MapFlags & MAP_FLAG_DISCARD) == 0)
+        {
+            LOG_ERROR_MESSAGE("Deferred contexts in OpenGL backend can only map buffers with MAP_WRITE type and MAP_FLAG_DISCARD flag");
+            return;
+        }
+        pMappedData = GetCommandStream().AllocateData(static_cast<size_t>(pBuffer->GetDesc().Size));
+        m_DeferredMappedBuffers.emplace_back(pBuffer, pMappedData);
+        return;
+    }
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
+    if (pBufferGL->UsesDynamicHeap() && MapType == MAP_WRITE)
+    {
+        VERIFY_EXPR(m_pDynamicHeap);
+        if ((MapFlags & MAP_FLAG_DISCARD) != 0)
+            pBufferGL->m_DynamicAllocation = m_pDynamicHeap->Allocate(pBufferGL->GetDesc().Size);
+
+        // MAP_FLAG_NO_OVERWRITE keeps the current allocation
+        if (pBufferGL->m_DynamicAllocation)
+        {
+            pMappedData = pBufferGL->m_DynamicAllocation.CPUAddress;
+            return;
+        }
+
+        // The heap is exhausted - fall back to mapping the buffer's own storage
+    }
     pBufferGL->Map(m_ContextState, MapType, MapFlags, pMappedData);
 }
 
 void DeviceContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
+    if (IsDeferred())
+    {
+        auto it = std::find_if(m_DeferredMappedBuffers.begin(), m_DeferredMappedBuffers.end(),
+                               [pBuffer](const std::pair<IBuffer*, void*>& Mapped) { return Mapped.first == pBuffer; });
+        if (it == m_DeferredMappedBuffers.end())
+        {
+            LOG_ERROR_MESSAGE("Buffer '", pBuffer->GetDesc().Name, "' has not been mapped by this deferred context");
+            return;
+        }
+
+        auto& Stream = GetCommandStream();
+        Stream.Record([pBuffer = Stream.KeepAlive(pBuffer), pData = it->second](DeviceContextGLImpl& Ctx) {
+            PVoid pMappedData = nullptr;
+            Ctx.MapBuffer(pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pMappedData);
+            if (pMappedData != nullptr)
+            {
+                std::memcpy(pMappedData, pData, static_cast<size_t>(pBuffer->GetDesc().Size));
+                Ctx.UnmapBuffer(pBuffer, MAP_WRITE);
+            }
+        });
+        m_DeferredMappedBuffers.erase(it);
+        return;
+    }
+
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
+    if (pBufferGL->m_DynamicAllocation)
+    {
+        // The heap is persistently and coherently mapped, nothing to do
+        VERIFY_EXPR(MapType == MAP_WRITE);
+        return;
+    }
     pBufferGL->Unmap(m_ContextState);
 }
 
@@ -1719,6 +2152,37 @@ void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
                                         RESOURCE_STATE_TRANSITION_MODE SrcBufferStateTransitionMode,
                                         RESOURCE_STATE_TRANSITION_MODE TextureStateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+
+        TextureSubResData SubresDataCopy = SubresData;
+        if (SubresData.pSrcBuffer != nullptr)
+        {
+            Stream.KeepAlive(SubresData.pSrcBuffer);
+        }
+        else if (SubresData.pData != nullptr)
+        {
+            // Copy the region into the staging memory of the command stream keeping the source strides
+            const auto&  FmtAttribs   = GetTextureFormatAttribs(pTexture->GetDesc().Format);
+            const bool   IsCompressed = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED;
+            const Uint32 BlockWidth   = IsCompressed ? Uint32{FmtAttribs.BlockWidth} : 1;
+            const Uint32 BlockHeight  = IsCompressed ? Uint32{FmtAttribs.BlockHeight} : 1;
+            const Uint64 RowSize      = Uint64{(DstBox.Width() + BlockWidth - 1) / BlockWidth} * FmtAttribs.GetElementSize();
+            const Uint32 NumRows      = (std::max(DstBox.Height(), 1u) + BlockHeight - 1) / BlockHeight;
+            const Uint32 NumSlices    = std::max(DstBox.Depth(), 1u);
+            const Uint64 DataSize     = (NumSlices - 1) * SubresData.DepthStride + (NumRows - 1) * SubresData.Stride + RowSize;
+
+            SubresDataCopy.pData = Stream.CopyData(SubresData.pData, static_cast<size_t>(DataSize));
+        }
+
+        Stream.Record([pTexture = Stream.KeepAlive(pTexture), MipLevel, Slice, DstBox, SubresDataCopy,
+                       SrcBufferStateTransitionMode, TextureStateTransitionMode](DeviceContextGLImpl& Ctx) {
+            Ctx.UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresDataCopy, SrcBufferStateTransitionMode, TextureStateTransitionMode);
+        });
+        return;
+    }
+
     TDeviceContextBase::UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferStateTransitionMode, TextureStateTransitionMode);
     auto* pTexGL = ClassPtrCast<TextureBaseGL>(pTexture);
     pTexGL->UpdateData(m_ContextState, MipLevel, Slice, DstBox, SubresData);
@@ -1726,6 +2190,18 @@ void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
 
 void DeviceContextGLImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+
+        CopyTextureAttribs AttribsCopy = CopyAttribs;
+        AttribsCopy.pSrcTexture        = Stream.KeepAlive(CopyAttribs.pSrcTexture);
+        AttribsCopy.pSrcBox            = Stream.CopyArray(CopyAttribs.pSrcBox, 1);
+        AttribsCopy.pDstTexture        = Stream.KeepAlive(CopyAttribs.pDstTexture);
+        Stream.Record([AttribsCopy](DeviceContextGLImpl& Ctx) { Ctx.CopyTexture(AttribsCopy); });
+        return;
+    }
+
     TDeviceContextBase::CopyTexture(CopyAttribs);
     auto* pSrcTexGL = ClassPtrCast<TextureBaseGL>(CopyAttribs.pSrcTexture);
     auto* pDstTexGL = ClassPtrCast<TextureBaseGL>(CopyAttribs.pDstTexture);
@@ -1847,6 +2323,13 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
                                                 const Box*                pMapRegion,
                                                 MappedTextureSubresource& MappedData)
 {
+    if (IsDeferred())
+    {
+        LOG_ERROR_MESSAGE("Textures can't be mapped by deferred contexts in OpenGL backend");
+        MappedData = MappedTextureSubresource{};
+        return;
+    }
+
     TDeviceContextBase::MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
     auto*       pTexGL  = ClassPtrCast<TextureBaseGL>(pTexture);
     const auto& TexDesc = pTexGL->GetDesc();
@@ -1870,6 +2353,12 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
 
 void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 MipLevel, Uint32 ArraySlice)
 {
+    if (IsDeferred())
+    {
+        LOG_ERROR_MESSAGE("Textures can't be mapped by deferred contexts in OpenGL backend");
+        return;
+    }
+
     TDeviceContextBase::UnmapTextureSubresource(pTexture, MipLevel, ArraySlice);
     auto*       pTexGL  = ClassPtrCast<TextureBaseGL>(pTexture);
     const auto& TexDesc = pTexGL->GetDesc();
@@ -1886,6 +2375,13 @@ void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 Mip
 
 void DeviceContextGLImpl::GenerateMips(ITextureView* pTexView)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pTexView = Stream.KeepAlive(pTexView)](DeviceContextGLImpl& Ctx) { Ctx.GenerateMips(pTexView); });
+        return;
+    }
+
     TDeviceContextBase::GenerateMips(pTexView);
     auto* pTexViewGL = ClassPtrCast<TextureViewGLImpl>(pTexView);
     auto  BindTarget = pTexViewGL->GetBindTarget();
@@ -1904,6 +2400,15 @@ void DeviceContextGLImpl::ResolveTextureSubresource(ITexture*
                                                     ITexture*                               pDstTexture,
                                                     const ResolveTextureSubresourceAttribs& ResolveAttribs)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([pSrcTexture = Stream.KeepAlive(pSrcTexture), pDstTexture = Stream.KeepAlive(pDstTexture), ResolveAttribs](DeviceContextGLImpl& Ctx) {
+            Ctx.ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
+        });
+        return;
+    }
+
     TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
     auto*       pSrcTexGl  = ClassPtrCast<TextureBaseGL>(pSrcTexture);
     auto*       pDstTexGl  = ClassPtrCast<TextureBaseGL>(pDstTexture);
@@ -2035,8 +2540,37 @@ void DeviceContextGLImpl::BindSparseResourceMemory(const BindSparseResourceMemor
     UNSUPPORTED("BindSparseResourceMemory is not supported in OpenGL");
 }
 
+void DeviceContextGLImpl::ResolveQueries(const ResolveQueriesAttribs& Attribs)
+{
+    UNSUPPORTED("ResolveQueries is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    UNSUPPORTED("BeginConditionalRendering is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::EndConditionalRendering()
+{
+    UNSUPPORTED("EndConditionalRendering is not supported in OpenGL");
+}
+
+void DeviceContextGLImpl::SetDynamicRenderState(const DynamicRenderState& State)
+{
+    UNSUPPORTED("SetDynamicRenderState is not supported in OpenGL");
+}
+
 void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([NameCopy = Stream.CopyString(Name), pColorCopy = Stream.CopyArray(pColor, 4)](DeviceContextGLImpl& Ctx) {
+            Ctx.BeginDebugGroup(NameCopy, pColorCopy);
+        });
+        return;
+    }
+
     TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
 
 #if GL_KHR_debug
@@ -2047,6 +2581,12 @@ void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 
 void DeviceContextGLImpl::EndDebugGroup()
 {
+    if (IsDeferred())
+    {
+        GetCommandStream().Record([](DeviceContextGLImpl& Ctx) { Ctx.EndDebugGroup(); });
+        return;
+    }
+
     TDeviceContextBase::EndDebugGroup(0);
 
 #if GL_KHR_debug
@@ -2057,6 +2597,15 @@ void DeviceContextGLImpl::EndDebugGroup()
 
 void DeviceContextGLImpl::InsertDebugLabel(const Char* Label, const float* pColor)
 {
+    if (IsDeferred())
+    {
+        auto& Stream = GetCommandStream();
+        Stream.Record([LabelCopy = Stream.CopyString(Label), pColorCopy = Stream.CopyArray(pColor, 4)](DeviceContextGLImpl& Ctx) {
+            Ctx.InsertDebugLabel(LabelCopy, pColorCopy);
+        });
+        return;
+    }
+
     TDeviceContextBase::InsertDebugLabel(Label, pColor, 0);
 
 #if GL_KHR_debug
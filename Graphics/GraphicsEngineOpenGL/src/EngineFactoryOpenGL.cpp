@@ -187,13 +187,41 @@ void EngineFactoryOpenGLImpl::EnumerateAdapters(Version              MinVersion,
     }
 }
 
+// Deferred contexts never touch the GL context: they only record commands that
+// the immediate context replays in ExecuteCommandLists().
+static void CreateDeferredContexts(RenderDeviceGLImpl* pRenderDeviceOpenGL,
+                                   Uint32              NumDeferredContexts,
+                                   IDeviceContext**    ppDeferredContexts)
+{
+    auto& RawMemAllocator = GetRawAllocator();
+    for (Uint32 DeferredCtx = 0; DeferredCtx < NumDeferredContexts; ++DeferredCtx)
+    {
+        RefCntAutoPtr<DeviceContextGLImpl> pDeferredCtxOpenGL{
+            NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
+                pRenderDeviceOpenGL,
+                DeviceContextDesc{
+                    nullptr,
+                    COMMAND_QUEUE_TYPE_UNKNOWN,
+                    True,           // IsDeferred
+                    1 + DeferredCtx // Context id
+                })                  //
+        };
+        // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
+        // keep a weak reference to the context
+        pDeferredCtxOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppDeferredContexts + DeferredCtx));
+        pRenderDeviceOpenGL->SetDeferredContext(DeferredCtx, pDeferredCtxOpenGL);
+    }
+}
+
 /// Creates render device, device context and swap chain for OpenGL/GLES-based engine implementation
 
 /// \param [in]  EngineCI           - Engine creation attributes.
 /// \param [out] ppDevice           - Address of the memory location where pointer to
 ///                                   the created device will be written.
 /// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+///                                   the immediate context will be written. If
+///                                   EngineCI.NumDeferredContexts > 0, pointers to the
+///                                   deferred contexts are written after the immediate context.
 /// \param [in]  SCDesc             - Swap chain description.
 /// \param [out] ppSwapChain        - Address of the memory location where pointer to the new
 ///                                   swap chain will be written.
@@ -213,21 +241,15 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
     if (!ppDevice || !ppImmediateContext || !ppSwapChain)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_ERROR_MESSAGE("OpenGL back-end does not support deferred contexts");
-        return;
-    }
-
     if (EngineCI.NumImmediateContexts > 1)
     {
         LOG_ERROR_MESSAGE("OpenGL back-end does not support multiple immediate contexts");
         return;
     }
 
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
-    *ppSwapChain        = nullptr;
+    *ppDevice    = nullptr;
+    *ppSwapChain = nullptr;
+    memset(ppImmediateContext, 0, sizeof(*ppImmediateContext) * (size_t{1} + size_t{EngineCI.NumDeferredContexts}));
 
     try
     {
@@ -262,6 +284,8 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
         pRenderDeviceOpenGL->SetImmediateContext(0, pDeviceContextOpenGL);
 
+        CreateDeferredContexts(pRenderDeviceOpenGL, EngineCI.NumDeferredContexts, ppImmediateContext + 1);
+
         TSwapChain* pSwapChainGL = NEW_RC_OBJ(RawMemAllocator, "SwapChainGLImpl instance", TSwapChain)(EngineCI, SCDesc, pRenderDeviceOpenGL, pDeviceContextOpenGL);
         pSwapChainGL->QueryInterface(IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain));
 
@@ -275,10 +299,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppImmediateContext[ctx] != nullptr)
+            {
+                ppImmediateContext[ctx]->Release();
+                ppImmediateContext[ctx] = nullptr;
+            }
         }
 
         if (*ppSwapChain)
@@ -298,7 +325,9 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
 /// \param [out] ppDevice - Address of the memory location where pointer to
 ///                         the created device will be written.
 /// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+///                                   the immediate context will be written. If
+///                                   EngineCI.NumDeferredContexts > 0, pointers to the
+///                                   deferred contexts are written after the immediate context.
 void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo& EngineCI,
                                                       IRenderDevice**           ppDevice,
                                                       IDeviceContext**          ppImmediateContext)
@@ -313,20 +342,14 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
     if (!ppDevice || !ppImmediateContext)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_ERROR_MESSAGE("OpenGL back-end does not support deferred contexts");
-        return;
-    }
-
     if (EngineCI.NumImmediateContexts > 1)
     {
         LOG_ERROR_MESSAGE("OpenGL back-end does not support multiple immediate contexts");
         return;
     }
 
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
+    *ppDevice = nullptr;
+    memset(ppImmediateContext, 0, sizeof(*ppImmediateContext) * (size_t{1} + size_t{EngineCI.NumDeferredContexts}));
 
     try
     {
@@ -360,6 +383,8 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         // keep a weak reference to the context
         pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
         pRenderDeviceOpenGL->SetImmediateContext(0, pDeviceContextOpenGL);
+
+        CreateDeferredContexts(pRenderDeviceOpenGL, EngineCI.NumDeferredContexts, ppImmediateContext + 1);
     }
     catch (const std::runtime_error&)
     {
@@ -369,10 +394,13 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppImmediateContext[ctx] != nullptr)
+            {
+                ppImmediateContext[ctx]->Release();
+                ppImmediateContext[ctx] = nullptr;
+            }
         }
 
         LOG_ERROR("Failed to initialize OpenGL-based render device");
@@ -83,21 +83,26 @@ Uint64 FenceGLImpl::GetCompletedValue()
     return m_LastCompletedFenceValue.load();
 }
 
-void FenceGLImpl::HostWait(Uint64 Value, bool FlushCommands)
+bool FenceGLImpl::HostWait(Uint64 Value, bool FlushCommands, Uint64 Timeout)
 {
+    FenceWaitTimeout WaitTimeout{Timeout};
     while (!m_PendingFences.empty())
     {
         auto& val_fence = m_PendingFences.front();
         if (val_fence.first > Value)
             break;
 
-        auto res = glClientWaitSync(val_fence.second, FlushCommands ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, std::numeric_limits<GLuint64>::max());
+        // FenceWaitTimeout::Infinite is the maximum GLuint64 value
+        auto res = glClientWaitSync(val_fence.second, FlushCommands ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, GLuint64{WaitTimeout.GetRemaining()});
+        if (res == GL_TIMEOUT_EXPIRED)
+            return false;
         VERIFY_EXPR(res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED);
-        (void)res;
 
         UpdateLastCompletedFenceValue(val_fence.first);
         m_PendingFences.pop_front();
     }
+
+    return m_LastCompletedFenceValue.load() >= Value;
 }
 
 void FenceGLImpl::DeviceWait(Uint64 Value)
@@ -121,7 +126,12 @@ void FenceGLImpl::Signal(Uint64 NewValue)
 
 void FenceGLImpl::Wait(Uint64 Value)
 {
-    return HostWait(Value, false);
+    HostWait(Value, false);
+}
+
+Bool FenceGLImpl::WaitWithTimeout(Uint64 Value, Uint64 Timeout)
+{
+    return HostWait(Value, false, Timeout);
 }
 
 } // namespace Diligent
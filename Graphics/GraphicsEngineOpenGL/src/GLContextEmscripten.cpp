@@ -30,6 +30,8 @@
 #include "GraphicsTypes.h"
 #include "GLTypeConversions.hpp"
 
+#include <emscripten/threading.h>
+
 namespace Diligent
 {
 
@@ -91,6 +93,17 @@ GLContext::GLContext(const EngineGLCreateInfo& InitAttribs, RENDER_DEVICE_TYPE&
             default: UNEXPECTED("Unknown power preference");
         }
 
+#if defined(__EMSCRIPTEN_PTHREADS__)
+        if (!emscripten_is_main_browser_thread())
+        {
+            // When the context is created on a worker thread, render directly to the canvas if it
+            // was transferred to the worker as an OffscreenCanvas. Otherwise, proxy the context to
+            // the main thread and present through an offscreen back buffer.
+            ContextAttributes.proxyContextToMainThread     = EMSCRIPTEN_WEBGL_CONTEXT_PROXY_FALLBACK;
+            ContextAttributes.renderViaOffscreenBackBuffer = true;
+        }
+#endif
+
         m_GLContext = emscripten_webgl_create_context(InitAttribs.Window.pCanvasId, &ContextAttributes);
         if (m_GLContext == 0)
         {
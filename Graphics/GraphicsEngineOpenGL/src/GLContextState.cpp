@@ -48,6 +48,7 @@ GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL)
     m_Caps.IsFillModeSelectionSupported = AdapterInfo.Features.WireframeFill;
     m_Caps.IsProgramPipelineSupported   = AdapterInfo.Features.SeparablePrograms;
     m_Caps.IsDepthClampSupported        = AdapterInfo.Features.DepthClamp;
+    m_Caps.IsMultiBindSupported         = pDeviceGL->GetGLCaps().MultiBind;
 
     {
         m_Caps.MaxCombinedTexUnits = 0;
@@ -109,6 +110,12 @@ void GLContextState::Invalidate()
     m_BoundUniformBuffers.clear();
     m_BoundStorageBlocks.clear();
 
+    m_PendingTextures       = {};
+    m_PendingSamplers       = {};
+    m_PendingUniformBuffers = {};
+    m_PendingStorageBlocks  = {};
+    m_BatchedBinding        = false;
+
     m_DSState = DepthStencilGLState();
     m_RSState = RasterizerGLState();
 
@@ -216,21 +223,35 @@ void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectW
 {
     VERIFY_EXPR(BindTarget != 0);
 
+    // Negative indices are used to bind textures to the active unit for immediate operations
+    const bool IsBatched = m_BatchedBinding && Index >= 0;
     if (Index < 0)
     {
         Index += m_Caps.MaxCombinedTexUnits;
     }
     VERIFY(0 <= Index && Index < m_Caps.MaxCombinedTexUnits, "Texture unit is out of range");
 
-    // Always update active texture unit
-    SetActiveTexture(Index);
-
     if (static_cast<size_t>(Index) >= m_BoundTextures.size())
         m_BoundTextures.resize(Index + 1);
 
-    BoundTextureInfo  NewTex{TexObj ? TexObj.GetUniqueID() : 0, BindTarget};
+    BoundTextureInfo  NewTex{TexObj ? TexObj.GetUniqueID() : 0, BindTarget, TexObj};
     BoundTextureInfo& BoundTex = m_BoundTextures[Index];
-    if (BoundTex != NewTex)
+    if (IsBatched)
+    {
+        // glBindTextures does not use the active texture unit
+        if (BoundTex != NewTex || BoundTex.Pending)
+        {
+            BoundTex         = NewTex;
+            BoundTex.Pending = true;
+            m_PendingTextures.Add(static_cast<Uint32>(Index));
+        }
+        return;
+    }
+
+    // Always update active texture unit
+    SetActiveTexture(Index);
+
+    if (BoundTex != NewTex || BoundTex.Pending)
     {
         // Unbind texture from the previous target.
         // This is necessary as at least on NVidia, having different textures bound to
@@ -250,13 +271,24 @@ void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectW
 void GLContextState::BindSampler(Uint32 Index, const GLObjectWrappers::GLSamplerObj& GLSampler)
 {
     if (static_cast<size_t>(Index) >= m_BoundSamplers.size())
-        m_BoundSamplers.resize(size_t{Index} + 1, -1);
+        m_BoundSamplers.resize(size_t{Index} + 1);
 
+    auto&  BoundSam        = m_BoundSamplers[Index];
     GLuint GLSamplerHandle = 0;
-    if (UpdateBoundObject(m_BoundSamplers[Index], GLSampler, GLSamplerHandle))
+    if (UpdateBoundObject(BoundSam.SamplerID, GLSampler, GLSamplerHandle) || BoundSam.Pending)
     {
-        glBindSampler(Index, GLSamplerHandle);
-        DEV_CHECK_GL_ERROR("Failed to bind sampler to slot ", Index);
+        BoundSam.GLHandle = GLSamplerHandle;
+        if (m_BatchedBinding)
+        {
+            BoundSam.Pending = true;
+            m_PendingSamplers.Add(Index);
+        }
+        else
+        {
+            BoundSam.Pending = false;
+            glBindSampler(Index, GLSamplerHandle);
+            DEV_CHECK_GL_ERROR("Failed to bind sampler to slot ", Index);
+        }
     }
 }
 
@@ -356,14 +388,22 @@ void GLContextState::BindUniformBuffer(Int32 Index, const GLObjectWrappers::GLBu
 {
     VERIFY(0 <= Index && Index < m_Caps.MaxUniformBufferBindings, "Uniform buffer index is out of range");
 
-    BoundBufferInfo NewUBOInfo{Buff.GetUniqueID(), Offset, Size};
+    BoundBufferInfo NewUBOInfo{Buff.GetUniqueID(), Buff, Offset, Size};
     if (Index >= static_cast<Int32>(m_BoundUniformBuffers.size()))
         m_BoundUniformBuffers.resize(static_cast<size_t>(Index) + 1);
 
-    if (m_BoundUniformBuffers[Index] != NewUBOInfo)
+    auto& BoundUBO = m_BoundUniformBuffers[Index];
+    if (BoundUBO != NewUBOInfo || BoundUBO.Pending)
     {
-        m_BoundUniformBuffers[Index] = NewUBOInfo;
-        GLuint GLBufferHandle        = Buff;
+        BoundUBO = NewUBOInfo;
+        if (m_BatchedBinding)
+        {
+            BoundUBO.Pending = true;
+            m_PendingUniformBuffers.Add(static_cast<Uint32>(Index));
+            return;
+        }
+
+        GLuint GLBufferHandle = Buff;
         // In addition to binding buffer to the indexed buffer binding target, glBindBufferBase also binds
         // buffer to the generic buffer binding point specified by target.
         glBindBufferRange(GL_UNIFORM_BUFFER, Index, GLBufferHandle, Offset, Size);
@@ -374,14 +414,22 @@ void GLContextState::BindUniformBuffer(Int32 Index, const GLObjectWrappers::GLBu
 void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBufferObj& Buff, GLintptr Offset, GLsizeiptr Size)
 {
 #if GL_ARB_shader_storage_buffer_object
-    BoundBufferInfo NewSSBOInfo{Buff.GetUniqueID(), Offset, Size};
+    BoundBufferInfo NewSSBOInfo{Buff.GetUniqueID(), Buff, Offset, Size};
     if (Index >= static_cast<Int32>(m_BoundStorageBlocks.size()))
         m_BoundStorageBlocks.resize(static_cast<size_t>(Index) + 1);
 
-    if (m_BoundStorageBlocks[Index] != NewSSBOInfo)
+    auto& BoundSSBO = m_BoundStorageBlocks[Index];
+    if (BoundSSBO != NewSSBOInfo || BoundSSBO.Pending)
     {
-        m_BoundStorageBlocks[Index] = NewSSBOInfo;
-        GLuint GLBufferHandle       = Buff;
+        BoundSSBO = NewSSBOInfo;
+        if (m_BatchedBinding)
+        {
+            BoundSSBO.Pending = true;
+            m_PendingStorageBlocks.Add(static_cast<Uint32>(Index));
+            return;
+        }
+
+        GLuint GLBufferHandle = Buff;
         // In addition to binding buffer to the indexed buffer binding target, glBindBufferRange also binds
         // buffer to the generic buffer binding point specified by target.
         glBindBufferRange(GL_SHADER_STORAGE_BUFFER, Index, GLBufferHandle, Offset, Size);
@@ -392,6 +440,104 @@ void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBuf
 #endif
 }
 
+void GLContextState::BeginBatchedBinding()
+{
+    VERIFY(!m_BatchedBinding, "Batched binding has already been started");
+    m_BatchedBinding = m_Caps.IsMultiBindSupported;
+}
+
+// Calls Handler(First, Count) for every contiguous run of pending slots in the range and resets the pending flags
+template <typename BoundInfoType, typename HandlerType>
+static void ProcessPendingSlots(std::vector<BoundInfoType>& BoundSlots, Uint32 First, Uint32 Last, HandlerType&& Handler)
+{
+    const Uint32 End = (std::min)(Last + 1, static_cast<Uint32>(BoundSlots.size()));
+    for (Uint32 Slot = First; Slot < End;)
+    {
+        if (!BoundSlots[Slot].Pending)
+        {
+            ++Slot;
+            continue;
+        }
+
+        const Uint32 RunStart = Slot;
+        while (Slot < End && BoundSlots[Slot].Pending)
+        {
+            BoundSlots[Slot].Pending = false;
+            ++Slot;
+        }
+        Handler(RunStart, Slot - RunStart);
+    }
+}
+
+void GLContextState::CommitBatchedBindings()
+{
+    if (!m_BatchedBinding)
+        return;
+
+    m_BatchedBinding = false;
+
+#if GL_ARB_multi_bind
+    if (!m_PendingTextures.IsEmpty())
+    {
+        ProcessPendingSlots(m_BoundTextures, m_PendingTextures.First, m_PendingTextures.Last,
+                            [this](Uint32 First, Uint32 Count) //
+                            {
+                                m_MultiBindHandles.resize(Count);
+                                for (Uint32 i = 0; i < Count; ++i)
+                                    m_MultiBindHandles[i] = m_BoundTextures[First + i].GLHandle;
+                                // glBindTextures binds every texture to its own target and unbinds all other targets of the unit
+                                glBindTextures(First, Count, m_MultiBindHandles.data());
+                                DEV_CHECK_GL_ERROR("Failed to bind ", Count, " textures starting at slot ", First);
+                            });
+        m_PendingTextures = {};
+    }
+
+    if (!m_PendingSamplers.IsEmpty())
+    {
+        ProcessPendingSlots(m_BoundSamplers, m_PendingSamplers.First, m_PendingSamplers.Last,
+                            [this](Uint32 First, Uint32 Count) //
+                            {
+                                m_MultiBindHandles.resize(Count);
+                                for (Uint32 i = 0; i < Count; ++i)
+                                    m_MultiBindHandles[i] = m_BoundSamplers[First + i].GLHandle;
+                                glBindSamplers(First, Count, m_MultiBindHandles.data());
+                                DEV_CHECK_GL_ERROR("Failed to bind ", Count, " samplers starting at slot ", First);
+                            });
+        m_PendingSamplers = {};
+    }
+
+    auto CommitBuffers = [this](GLenum Target, std::vector<BoundBufferInfo>& BoundBuffers, PendingSlotRange& PendingRange) //
+    {
+        if (PendingRange.IsEmpty())
+            return;
+
+        ProcessPendingSlots(BoundBuffers, PendingRange.First, PendingRange.Last,
+                            [&](Uint32 First, Uint32 Count) //
+                            {
+                                m_MultiBindHandles.resize(Count);
+                                m_MultiBindOffsets.resize(Count);
+                                m_MultiBindSizes.resize(Count);
+                                for (Uint32 i = 0; i < Count; ++i)
+                                {
+                                    const auto& Buff      = BoundBuffers[First + i];
+                                    m_MultiBindHandles[i] = Buff.GLHandle;
+                                    m_MultiBindOffsets[i] = Buff.Offset;
+                                    m_MultiBindSizes[i]   = Buff.Size;
+                                }
+                                glBindBuffersRange(Target, First, Count, m_MultiBindHandles.data(), m_MultiBindOffsets.data(), m_MultiBindSizes.data());
+                                DEV_CHECK_GL_ERROR("Failed to bind ", Count, " buffers starting at slot ", First);
+                            });
+        PendingRange = {};
+    };
+    CommitBuffers(GL_UNIFORM_BUFFER, m_BoundUniformBuffers, m_PendingUniformBuffers);
+#    if GL_ARB_shader_storage_buffer_object
+    CommitBuffers(GL_SHADER_STORAGE_BUFFER, m_BoundStorageBlocks, m_PendingStorageBlocks);
+#    endif
+#else
+    UNEXPECTED("Batched binding requires GL_ARB_multi_bind");
+#endif
+}
+
 void GLContextState::BindBuffer(GLenum BindTarget, const GLObjectWrappers::GLBufferObj& Buff, bool ResetVAO)
 {
     // Binding ARRAY_BUFFER or ELEMENT_ARRAY_BUFFER affects currently bound VAO
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GLDynamicHeap.hpp"
+
+#include <limits>
+
+#include "GLContextState.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+GLDynamicHeap::GLDynamicHeap(IMemoryAllocator& Allocator, GLContextState& GLState, Uint64 Size, Uint32 Alignment) :
+    // clang-format off
+    m_Buffer    {true},
+    m_Alignment {Alignment},
+    m_RingBuffer{StaticCast<RingBuffer::OffsetType>(Size), Allocator}
+// clang-format on
+{
+    VERIFY(IsPowerOfTwo(m_Alignment), "Alignment (", m_Alignment, ") must be power of 2");
+
+#if GL_ARB_buffer_storage
+    constexpr GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    // GL_COPY_WRITE_BUFFER target is not used for anything else, so there is no need to reset VAO
+    constexpr bool ResetVAO = false;
+    GLState.BindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer, ResetVAO);
+
+    glBufferStorage(GL_COPY_WRITE_BUFFER, StaticCast<GLsizeiptr>(Size), nullptr, StorageFlags);
+    CHECK_GL_ERROR_AND_THROW("glBufferStorage() failed");
+
+    m_CPUAddress = static_cast<Uint8*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, StaticCast<GLsizeiptr>(Size), StorageFlags));
+    CHECK_GL_ERROR_AND_THROW("Failed to persistently map the dynamic heap buffer");
+    GLState.BindBuffer(GL_COPY_WRITE_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    if (m_CPUAddress == nullptr)
+        LOG_ERROR_AND_THROW("Failed to persistently map the dynamic heap buffer");
+
+    m_Buffer.SetName("Dynamic heap buffer");
+
+    LOG_INFO_MESSAGE("GL dynamic heap created. Total buffer size: ", FormatMemorySize(Size, 2));
+#else
+    LOG_ERROR_AND_THROW("GL_ARB_buffer_storage is not supported");
+#endif
+}
+
+GLDynamicHeap::~GLDynamicHeap()
+{
+    // The buffer is deleted below, and GL keeps its storage alive until the GPU is done with it
+    m_RingBuffer.FinishCurrentFrame(m_NextFenceValue);
+    m_RingBuffer.ReleaseCompletedFrames(m_NextFenceValue);
+
+    LOG_INFO_MESSAGE("GL dynamic heap: peak frame size: ", FormatMemorySize(m_PeakFrameSize, 2), " / ", FormatMemorySize(GetSize(), 2));
+}
+
+GLDynamicAllocation GLDynamicHeap::Allocate(Uint64 Size)
+{
+    VERIFY_EXPR(Size > 0);
+
+    auto Offset = m_RingBuffer.Allocate(StaticCast<RingBuffer::OffsetType>(Size), m_Alignment);
+    while (Offset == RingBuffer::InvalidOffset && !m_PendingFences.empty())
+    {
+        // Wait for the oldest frame to complete and try again
+        ReleaseCompletedFrames(/*WaitForOldest = */ true);
+        Offset = m_RingBuffer.Allocate(StaticCast<RingBuffer::OffsetType>(Size), m_Alignment);
+    }
+
+    if (Offset == RingBuffer::InvalidOffset)
+    {
+        // The request can't be satisfied even after all previous frames have completed
+        return {};
+    }
+
+    m_CurrFrameSize += AlignUp(Size, Uint64{m_Alignment});
+
+    return GLDynamicAllocation{&m_Buffer, Offset, m_CPUAddress + Offset};
+}
+
+void GLDynamicHeap::FinishFrame()
+{
+    m_PeakFrameSize = std::max(m_PeakFrameSize, m_CurrFrameSize);
+    if (m_CurrFrameSize != 0)
+    {
+        GLObjectWrappers::GLSyncObj Fence{glFenceSync(
+            GL_SYNC_GPU_COMMANDS_COMPLETE, // Condition must always be GL_SYNC_GPU_COMMANDS_COMPLETE
+            0                              // Flags, must be 0
+            )};
+        DEV_CHECK_GL_ERROR("Failed to create gl fence");
+
+        m_RingBuffer.FinishCurrentFrame(m_NextFenceValue);
+        m_PendingFences.emplace_back(m_NextFenceValue, std::move(Fence));
+        ++m_NextFenceValue;
+        m_CurrFrameSize = 0;
+    }
+
+    ReleaseCompletedFrames(/*WaitForOldest = */ false);
+}
+
+void GLDynamicHeap::ReleaseCompletedFrames(bool WaitForOldest)
+{
+    Uint64 CompletedFenceValue = 0;
+    while (!m_PendingFences.empty())
+    {
+        auto& val_fence = m_PendingFences.front();
+
+        const auto Timeout = WaitForOldest ? std::numeric_limits<GLuint64>::max() : 0;
+        const auto res     = glClientWaitSync(val_fence.second, WaitForOldest ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, Timeout);
+        if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED)
+            break;
+
+        CompletedFenceValue = val_fence.first;
+        m_PendingFences.pop_front();
+        WaitForOldest = false;
+    }
+
+    if (CompletedFenceValue != 0)
+        m_RingBuffer.ReleaseCompletedFrames(CompletedFenceValue);
+}
+
+} // namespace Diligent
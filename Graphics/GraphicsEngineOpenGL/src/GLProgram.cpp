@@ -29,13 +29,15 @@
 #include "GLProgram.hpp"
 #include "ShaderGLImpl.hpp"
 #include "RenderDeviceGLImpl.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 namespace Diligent
 {
 
-GLProgram::GLProgram(ShaderGLImpl* const* ppShaders,
-                     Uint32               NumShaders,
-                     bool                 IsSeparableProgram) noexcept :
+GLProgram::GLProgram(ShaderGLImpl* const*      ppShaders,
+                     Uint32                    NumShaders,
+                     bool                      IsSeparableProgram,
+                     PipelineStateCacheGLImpl* pPSOCache) noexcept :
     m_AttachedShaders{ppShaders, ppShaders + NumShaders}
 {
     VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
@@ -47,6 +49,28 @@ GLProgram::GLProgram(ShaderGLImpl* const* ppShaders,
         DEV_CHECK_GL_ERROR("glProgramParameteri(GL_PROGRAM_SEPARABLE) failed");
     }
 
+    if (pPSOCache != nullptr)
+    {
+        m_PSOCacheKey = PipelineStateCacheGLImpl::ComputeProgramKey(ppShaders, NumShaders, IsSeparableProgram);
+        if (pPSOCache->LoadProgram(m_PSOCacheKey, m_GLProg))
+        {
+            // The program has been loaded from the binary, no need to link it
+            m_AttachedShaders.clear();
+            m_LinkStatus = LinkStatus::Succeeded;
+            return;
+        }
+
+        if (pPSOCache->IsStoreEnabled())
+        {
+#if !PLATFORM_EMSCRIPTEN
+            // The hint must be set before linking the program
+            glProgramParameteri(m_GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            DEV_CHECK_GL_ERROR("glProgramParameteri(GL_PROGRAM_BINARY_RETRIEVABLE_HINT) failed");
+#endif
+            m_pPSOCache = pPSOCache;
+        }
+    }
+
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ppShaders[i];
@@ -64,8 +88,11 @@ GLProgram::GLProgram(ShaderGLImpl* const* ppShaders,
     //compatible program on the other side of the interface. If a mismatch
     //between programs occurs, no GL error will be generated, but some or all
     //of the inputs on the interface will be undefined.
-    glLinkProgram(m_GLProg);
-    DEV_CHECK_GL_ERROR("glLinkProgram() failed");
+    {
+        ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+        glLinkProgram(m_GLProg);
+        DEV_CHECK_GL_ERROR("glLinkProgram() failed");
+    }
 
     // Note: according to the spec, shaders can be detached immediately after glLinkProgram call.
     //       However, on NVidia GPUs this completely disables the GL_KHR_parallel_shader_compile
@@ -101,6 +128,12 @@ GLProgram::LinkStatus GLProgram::GetLinkStatus(bool WaitForCompletion) noexcept
     if (IsLinked)
     {
         m_LinkStatus = LinkStatus::Succeeded;
+
+        if (m_pPSOCache)
+        {
+            m_pPSOCache->StoreProgram(m_PSOCacheKey, m_GLProg);
+            m_pPSOCache.Release();
+        }
     }
     else
     {
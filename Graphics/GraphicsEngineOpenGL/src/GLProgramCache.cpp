@@ -116,7 +116,7 @@ GLProgramCache::SharedGLProgramObjPtr GLProgramCache::GetProgram(const GetProgra
     // and the rest will be destroyed.
 
     // Linking the program may take a considerable amount of time.
-    std::shared_ptr<GLProgram> NewProgram = std::make_shared<GLProgram>(Attribs.ppShaders, Attribs.NumShaders, Attribs.IsSeparableProgram);
+    std::shared_ptr<GLProgram> NewProgram = std::make_shared<GLProgram>(Attribs.ppShaders, Attribs.NumShaders, Attribs.IsSeparableProgram, Attribs.pPSOCache);
 
     std::lock_guard<std::mutex> Lock{m_CacheMtx};
 
@@ -0,0 +1,300 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "PipelineStateCacheGLImpl.hpp"
+
+#include "RenderDeviceGLImpl.hpp"
+#include "ShaderGLImpl.hpp"
+#include "DataBlobImpl.hpp"
+#include "Serializer.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct ProgramBinaryCacheHeader
+{
+    static constexpr Uint32 HeaderMagic   = 0x47C0CACE;
+    static constexpr Uint32 HeaderVersion = 1;
+
+    Uint32 Magic   = HeaderMagic;
+    Uint32 Version = HeaderVersion;
+
+    const char* DriverId = nullptr;
+
+    Uint64 ElementCount = 0;
+
+    template <typename SerType>
+    bool Serialize(SerType& Stream)
+    {
+        return Stream(Magic, Version, DriverId, ElementCount);
+    }
+};
+
+struct ProgramBinaryCacheElementHeader
+{
+    Uint64 Hash         = 0;
+    Uint64 SourceLength = 0;
+    Uint32 Format       = 0;
+    Uint32 DataSize     = 0;
+
+    template <typename SerType>
+    bool Serialize(SerType& Stream)
+    {
+        return Stream(Hash, SourceLength, Format, DataSize);
+    }
+};
+
+std::string GetGLDriverId()
+{
+    std::string DriverId;
+    for (GLenum Name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        if (const char* Str = reinterpret_cast<const char*>(glGetString(Name)))
+            DriverId += Str;
+        DriverId += '\n';
+    }
+    return DriverId;
+}
+
+} // namespace
+
+PipelineStateCacheGLImpl::PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                                                   RenderDeviceGLImpl*                 pDeviceGL,
+                                                   const PipelineStateCacheCreateInfo& CreateInfo) :
+    TPipelineStateCacheBase{pRefCounters, pDeviceGL, CreateInfo},
+    m_DriverId{GetGLDriverId()}
+{
+#if !PLATFORM_EMSCRIPTEN
+    GLint NumBinaryFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumBinaryFormats);
+    CHECK_GL_ERROR("Failed to get the number of program binary formats");
+    m_IsSupported = NumBinaryFormats > 0;
+#endif
+
+    if (!m_IsSupported)
+    {
+        LOG_WARNING_MESSAGE("Program binaries are not supported by this device. Pipeline state cache '", m_Desc.Name, "' will not be used.");
+        return;
+    }
+
+    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize != 0 && IsLoadEnabled())
+    {
+        if (!Load(CreateInfo.pCacheData, CreateInfo.CacheDataSize))
+            m_Binaries.clear();
+    }
+}
+
+PipelineStateCacheGLImpl::~PipelineStateCacheGLImpl()
+{
+}
+
+bool PipelineStateCacheGLImpl::Load(const void* pData, size_t DataSize)
+{
+    Serializer<SerializerMode::Read> Stream{SerializedData{const_cast<void*>(pData), DataSize}};
+
+    ProgramBinaryCacheHeader Header;
+    if (!Header.Serialize(Stream))
+    {
+        LOG_ERROR_MESSAGE("Failed to read GL pipeline state cache header");
+        return false;
+    }
+
+    if (Header.Magic != ProgramBinaryCacheHeader::HeaderMagic)
+    {
+        LOG_ERROR_MESSAGE("Incorrect GL pipeline state cache header magic number");
+        return false;
+    }
+
+    if (Header.Version != ProgramBinaryCacheHeader::HeaderVersion)
+    {
+        LOG_ERROR_MESSAGE("Incorrect GL pipeline state cache version (", Header.Version, "). ", Uint32{ProgramBinaryCacheHeader::HeaderVersion}, " is expected.");
+        return false;
+    }
+
+    if (m_DriverId != Header.DriverId)
+    {
+        // Program binaries are only valid for the driver they were created with
+        LOG_INFO_MESSAGE("GL pipeline state cache was created with a different driver and will be discarded");
+        return false;
+    }
+
+    for (Uint64 ItemID = 0; ItemID < Header.ElementCount; ++ItemID)
+    {
+        ProgramBinaryCacheElementHeader ElementHeader;
+        if (!ElementHeader.Serialize(Stream))
+        {
+            LOG_ERROR_MESSAGE("Failed to read GL pipeline state cache element ", ItemID);
+            return false;
+        }
+
+        ProgramBinary Binary;
+        Binary.Format = static_cast<GLenum>(ElementHeader.Format);
+        Binary.Data.resize(ElementHeader.DataSize);
+        if (!Stream.CopyBytes(Binary.Data.data(), Binary.Data.size()))
+        {
+            LOG_ERROR_MESSAGE("Failed to read GL pipeline state cache element ", ItemID);
+            return false;
+        }
+
+        const ProgramKey Key{static_cast<size_t>(ElementHeader.Hash), ElementHeader.SourceLength};
+        m_Binaries.emplace(Key, std::move(Binary));
+    }
+
+    return true;
+}
+
+void PipelineStateCacheGLImpl::GetData(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    DEV_CHECK_ERR(*ppBlob == nullptr, "*ppBlob is not null. Make sure you are not overwriting reference to an existing object as this may result in memory leaks.");
+
+    std::lock_guard<std::mutex> Lock{m_BinariesMtx};
+
+    auto WriteData = [&](auto& Stream) //
+    {
+        ProgramBinaryCacheHeader Header;
+        Header.DriverId     = m_DriverId.c_str();
+        Header.ElementCount = m_Binaries.size();
+        Header.Serialize(Stream);
+
+        for (const auto& it : m_Binaries)
+        {
+            const ProgramBinary& Binary = it.second;
+
+            ProgramBinaryCacheElementHeader ElementHeader;
+            ElementHeader.Hash         = it.first.Hash;
+            ElementHeader.SourceLength = it.first.SourceLength;
+            ElementHeader.Format       = static_cast<Uint32>(Binary.Format);
+            ElementHeader.DataSize     = static_cast<Uint32>(Binary.Data.size());
+            ElementHeader.Serialize(Stream);
+
+            Stream.CopyBytes(Binary.Data.data(), Binary.Data.size());
+        }
+    };
+
+    Serializer<SerializerMode::Measure> MeasureStream{};
+    WriteData(MeasureStream);
+
+    const auto Memory = MeasureStream.AllocateData(GetRawAllocator());
+
+    Serializer<SerializerMode::Write> WriteStream{Memory};
+    WriteData(WriteStream);
+    VERIFY_EXPR(WriteStream.IsEnded());
+
+    *ppBlob = DataBlobImpl::Create(Memory.Size(), Memory.Ptr()).Detach();
+}
+
+PipelineStateCacheGLImpl::ProgramKey PipelineStateCacheGLImpl::ComputeProgramKey(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+{
+    ProgramKey Key;
+    Key.Hash = ComputeHash(IsSeparableProgram, NumShaders);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        const void* pSource      = nullptr;
+        Uint64      SourceLength = 0;
+        ppShaders[i]->GetBytecode(&pSource, SourceLength);
+
+        HashCombine(Key.Hash, ppShaders[i]->GetDesc().ShaderType, ComputeHashRaw(pSource, StaticCast<size_t>(SourceLength)));
+        Key.SourceLength += SourceLength;
+    }
+    return Key;
+}
+
+bool PipelineStateCacheGLImpl::LoadProgram(const ProgramKey& Key, GLuint GLProgram)
+{
+    if (!IsLoadEnabled())
+        return false;
+
+    std::lock_guard<std::mutex> Lock{m_BinariesMtx};
+
+    auto it = m_Binaries.find(Key);
+    if (it == m_Binaries.end())
+    {
+        if (m_Desc.Flags & PSO_CACHE_FLAG_VERBOSE)
+            LOG_INFO_MESSAGE("Program binary was not found in the cache '", m_Desc.Name, "'");
+        return false;
+    }
+
+    GLint IsLinked = GL_FALSE;
+#if !PLATFORM_EMSCRIPTEN
+    const ProgramBinary& Binary = it->second;
+    glProgramBinary(GLProgram, Binary.Format, Binary.Data.data(), static_cast<GLsizei>(Binary.Data.size()));
+    // The driver may reject the binary (e.g. after an update that did not change the version string),
+    // in which case the program is linked from the shaders. Do not report the error.
+    if (glGetError() == GL_NO_ERROR)
+    {
+        glGetProgramiv(GLProgram, GL_LINK_STATUS, &IsLinked);
+        DEV_CHECK_GL_ERROR("glGetProgramiv(GL_LINK_STATUS) failed");
+    }
+#endif
+
+    if (!IsLinked)
+    {
+        if (m_Desc.Flags & PSO_CACHE_FLAG_VERBOSE)
+            LOG_INFO_MESSAGE("Failed to load program binary from the cache '", m_Desc.Name, "'. The binary will be discarded.");
+        m_Binaries.erase(it);
+        return false;
+    }
+
+    return true;
+}
+
+void PipelineStateCacheGLImpl::StoreProgram(const ProgramKey& Key, GLuint GLProgram)
+{
+    if (!IsStoreEnabled())
+        return;
+
+#if !PLATFORM_EMSCRIPTEN
+    GLint BinaryLength = 0;
+    glGetProgramiv(GLProgram, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    DEV_CHECK_GL_ERROR("glGetProgramiv(GL_PROGRAM_BINARY_LENGTH) failed");
+    if (BinaryLength <= 0)
+        return;
+
+    ProgramBinary Binary;
+    Binary.Data.resize(static_cast<size_t>(BinaryLength));
+
+    GLsizei Length = 0;
+    glGetProgramBinary(GLProgram, BinaryLength, &Length, &Binary.Format, Binary.Data.data());
+    if (glGetError() != GL_NO_ERROR || Length <= 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to get program binary");
+        return;
+    }
+    Binary.Data.resize(static_cast<size_t>(Length));
+
+    std::lock_guard<std::mutex> Lock{m_BinariesMtx};
+    m_Binaries[Key] = std::move(Binary);
+#endif
+}
+
+} // namespace Diligent
@@ -399,6 +399,7 @@ private:
                         m_CreateInfo.ResourceSignaturesCount == 0 ? &m_CreateInfo.PSODesc.ResourceLayout : nullptr,
                         m_CreateInfo.ppResourceSignatures,
                         m_CreateInfo.ResourceSignaturesCount,
+                        ClassPtrCast<PipelineStateCacheGLImpl>(m_CreateInfo.pPSOCache),
                     };
                     m_Pipeline.m_GLPrograms[i]  = m_Pipeline.GetDevice()->GetProgramCache().GetProgram(ProgAttribs);
                     m_Pipeline.m_ShaderTypes[i] = m_Shaders[i]->GetDesc().ShaderType;
@@ -416,6 +417,7 @@ private:
                     m_CreateInfo.ResourceSignaturesCount == 0 ? &m_CreateInfo.PSODesc.ResourceLayout : nullptr,
                     m_CreateInfo.ppResourceSignatures,
                     m_CreateInfo.ResourceSignaturesCount,
+                    ClassPtrCast<PipelineStateCacheGLImpl>(m_CreateInfo.pPSOCache),
                 };
                 m_Pipeline.m_GLPrograms[0]  = m_Pipeline.GetDevice()->GetProgramCache().GetProgram(ProgAttribs);
                 m_Pipeline.m_ShaderTypes[0] = ActiveStages;
@@ -47,6 +47,7 @@
 #include "RenderPassGLImpl.hpp"
 #include "FramebufferGLImpl.hpp"
 #include "PipelineResourceSignatureGLImpl.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
@@ -174,13 +175,12 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         GraphicsAdapterInfo{} // Adapter properties can only be queried after GL context is initialized
     },
     // Device caps must be filled in before the constructor of Pipeline Cache is called!
-    m_GLContext{EngineCI, m_DeviceInfo.Type, m_DeviceInfo.APIVersion, pSCDesc}
+    m_GLContext{EngineCI, m_DeviceInfo.Type, m_DeviceInfo.APIVersion, pSCDesc},
+    m_DynamicHeapSize{EngineCI.DynamicHeapSize}
 // clang-format on
 {
     VerifyEngineGLCreateInfo(EngineCI);
 
-    VERIFY(EngineCI.NumDeferredContexts == 0, "EngineCI.NumDeferredContexts > 0 should've been caught by CreateDeviceAndSwapChainGL() or AttachToActiveGLContext()");
-
     GLint NumExtensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &NumExtensions);
     CHECK_GL_ERROR("Failed to get the number of extensions");
@@ -646,7 +646,7 @@ void RenderDeviceGLImpl::CreateDeviceMemory(const DeviceMemoryCreateInfo& Create
 void RenderDeviceGLImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
                                                   IPipelineStateCache**               ppPSOCache)
 {
-    *ppPSOCache = nullptr;
+    CreatePipelineStateCacheImpl(ppPSOCache, CreateInfo);
 }
 
 SparseTextureFormatInfo RenderDeviceGLImpl::GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
@@ -782,6 +782,9 @@ void RenderDeviceGLImpl::InitAdapterInfo()
         Features.TileShaders                 = DEVICE_FEATURE_STATE_DISABLED;
         Features.SubpassFramebufferFetch     = DEVICE_FEATURE_STATE_DISABLED;
         Features.TextureComponentSwizzle     = DEVICE_FEATURE_STATE_DISABLED;
+        Features.ConditionalRendering        = DEVICE_FEATURE_STATE_DISABLED;
+        Features.MultiView                   = DEVICE_FEATURE_STATE_DISABLED;
+        Features.ExtendedDynamicState        = DEVICE_FEATURE_STATE_DISABLED;
 
         {
             bool WireframeFillSupported = (glPolygonMode != nullptr);
@@ -888,6 +891,15 @@ void RenderDeviceGLImpl::InitAdapterInfo()
 
             m_GLCaps.FramebufferSRGB  = IsGL40OrAbove || CheckExtension("GL_ARB_framebuffer_sRGB");
             m_GLCaps.SemalessCubemaps = IsGL40OrAbove || CheckExtension("GL_ARB_seamless_cube_map");
+#if GL_ARB_buffer_storage
+            m_GLCaps.BufferStorage = GLVersion >= Version{4, 4} || CheckExtension("GL_ARB_buffer_storage");
+#endif
+#if GL_ARB_vertex_attrib_binding
+            m_GLCaps.VertexAttribBinding = IsGL43OrAbove || CheckExtension("GL_ARB_vertex_attrib_binding");
+#endif
+#if GL_ARB_multi_bind
+            m_GLCaps.MultiBind = GLVersion >= Version{4, 4} || CheckExtension("GL_ARB_multi_bind");
+#endif
         }
         else
         {
@@ -1115,7 +1127,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
         m_AdapterInfo.Queues[0].TextureCopyGranularity[2] = 1;
     }
 
-    ASSERT_SIZEOF(DeviceFeatures, 47, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(DeviceFeatures, 50, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 }
 
 void RenderDeviceGLImpl::FlagSupportedTexFormats()
@@ -1685,7 +1697,7 @@ void RenderDeviceGLImpl::OnReleaseTexture(ITexture* pTexture)
 VAOCache& RenderDeviceGLImpl::GetVAOCache(GLContext::NativeGLContextType Context)
 {
     Threading::SpinLockGuard VAOCacheGuard{m_VAOCacheLock};
-    return m_VAOCache[Context];
+    return m_VAOCache.try_emplace(Context, m_GLCaps.VertexAttribBinding).first->second;
 }
 
 void RenderDeviceGLImpl::OnDestroyPSO(PipelineStateGLImpl& PSO)
@@ -38,6 +38,7 @@
 #include "ShaderToolsCommon.hpp"
 #include "GLTypeConversions.hpp"
 #include "GLProgram.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 using namespace Diligent;
 
@@ -221,6 +222,8 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "'ByteCode' must be null when shader is created from the source code or a file");
     DEV_CHECK_ERR(ShaderCI.ShaderCompiler == SHADER_COMPILER_DEFAULT, "only default compiler is supported in OpenGL");
 
+    ShaderCompilationScope CompilationScope{m_Desc.Name, false};
+
     const auto& DeviceInfo  = GLShaderCI.DeviceInfo;
     const auto& AdapterInfo = GLShaderCI.AdapterInfo;
 
@@ -290,6 +293,7 @@ void ShaderGLImpl::CompileShader() noexcept
     // Provide source strings (the strings will be saved in internal OpenGL memory)
     glShaderSource(m_GLShaderObj, static_cast<GLsizei>(ShaderStrings.size()), ShaderStrings.data(), Lengths.data());
     // When the shader is compiled, it will be compiled as if all of the given strings were concatenated end-to-end.
+    ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
     glCompileShader(m_GLShaderObj);
 }
 
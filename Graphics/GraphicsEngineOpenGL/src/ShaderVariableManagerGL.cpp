@@ -117,7 +117,7 @@ void ShaderVariableManagerGL::Initialize(const PipelineResourceSignatureGLImpl&
     // clang-format off
     auto TotalMemorySize = m_VariableEndOffset;
     VERIFY_EXPR(TotalMemorySize == GetRequiredMemorySize(Signature, AllowedVarTypes, NumAllowedTypes, ShaderType));
-    TBase::Initialize(Signature, Allocator, TotalMemorySize);
+    TBase::Initialize(Signature, Allocator, TotalMemorySize, ShaderType);
 
     // clang-format off
     VERIFY_EXPR(Counters.NumUBs           == GetNumUBs()           );
@@ -446,33 +446,32 @@ void ShaderVariableManagerGL::CheckResources(IResourceMapping*
 }
 
 template <typename ResourceType>
-IShaderResourceVariable* ShaderVariableManagerGL::GetResourceByName(const Char* Name) const
+IShaderResourceVariable* ShaderVariableManagerGL::GetResourceByResIndex(Uint32 ResIndex) const
 {
-    auto NumResources = GetNumResources<ResourceType>();
-    for (Uint32 res = 0; res < NumResources; ++res)
-    {
-        auto&       Resource = GetResource<ResourceType>(res);
-        const auto& ResDesc  = Resource.GetDesc();
-        if (strcmp(ResDesc.Name, Name) == 0)
-            return &Resource;
-    }
+    const Uint32 NumResources = GetNumResources<ResourceType>();
+    if (NumResources == 0)
+        return nullptr;
 
-    return nullptr;
+    return FindVariableByResIndex(&GetResource<ResourceType>(0), NumResources, ResIndex);
 }
 
 
 IShaderResourceVariable* ShaderVariableManagerGL::GetVariable(const Char* Name) const
 {
-    if (auto* pUB = GetResourceByName<UniformBuffBindInfo>(Name))
+    const Uint32 ResIndex = FindResourceIndex(Name);
+    if (ResIndex == InvalidPipelineResourceIndex)
+        return nullptr;
+
+    if (auto* pUB = GetResourceByResIndex<UniformBuffBindInfo>(ResIndex))
         return pUB;
 
-    if (auto* pTexture = GetResourceByName<TextureBindInfo>(Name))
+    if (auto* pTexture = GetResourceByResIndex<TextureBindInfo>(ResIndex))
         return pTexture;
 
-    if (auto* pImage = GetResourceByName<ImageBindInfo>(Name))
+    if (auto* pImage = GetResourceByResIndex<ImageBindInfo>(ResIndex))
         return pImage;
 
-    if (auto* pSSBO = GetResourceByName<StorageBufferBindInfo>(Name))
+    if (auto* pSSBO = GetResourceByResIndex<StorageBufferBindInfo>(ResIndex))
         return pSSBO;
 
     return nullptr;
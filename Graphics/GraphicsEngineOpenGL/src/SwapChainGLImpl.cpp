@@ -133,6 +133,9 @@ void SwapChainGLImpl::Present(Uint32 SyncInterval)
         auto* pDeviceCtxGl = pDeviceContext.RawPtr<DeviceContextGLImpl>();
         auto* pBackBuffer  = ClassPtrCast<TextureBaseGL>(m_pRenderTargetView->GetTexture());
         pDeviceCtxGl->UnbindTextureFromFramebuffer(pBackBuffer, false);
+
+        if (m_SwapChainDesc.IsPrimary)
+            pDeviceCtxGl->FinishFrame();
     }
 }
 
@@ -44,7 +44,8 @@
 namespace Diligent
 {
 
-VAOCache::VAOCache() :
+VAOCache::VAOCache(bool UseVertexAttribBinding) :
+    m_UseVertexAttribBinding{UseVertexAttribBinding},
     m_EmptyVAO{true}
 {
     m_Cache.max_load_factor(0.5f);
@@ -167,10 +168,10 @@ void VAOCache::ClearStaleKeys(const std::vector<VAOHashKey>& StaleKeys)
     RemoveStaleEntries(CandidateBuffers, m_BuffToKey);
 }
 
-VAOCache::VAOHashKey::VAOHashKey(const VAOAttribs& Attribs) :
+VAOCache::VAOHashKey::VAOHashKey(const VAOAttribs& Attribs, bool IncludeBuffers) :
     // clang-format off
     PsoUId         {Attribs.PSO.GetUniqueID()},
-    IndexBufferUId {Attribs.pIndexBuffer ? Attribs.pIndexBuffer->GetUniqueID() : 0}
+    IndexBufferUId {IncludeBuffers && Attribs.pIndexBuffer ? Attribs.pIndexBuffer->GetUniqueID() : 0}
 // clang-format on
 {
 #ifdef DILIGENT_DEBUG
@@ -194,13 +195,14 @@ VAOCache::VAOHashKey::VAOHashKey(const VAOAttribs& Attribs) :
         const auto& SrcStream = Attribs.VertexStreams[BufferSlot];
         DEV_CHECK_ERR(SrcStream.pBuffer, "VAO requires buffer at slot ", BufferSlot, ", but none is bound in the context.");
 
-        const auto BuffId  = SrcStream.pBuffer ? SrcStream.pBuffer->GetUniqueID() : 0;
+        const auto BuffId  = IncludeBuffers && SrcStream.pBuffer ? SrcStream.pBuffer->GetUniqueID() : 0;
+        const auto Offset  = IncludeBuffers ? SrcStream.Offset : 0;
         const auto SlotBit = 1u << BufferSlot;
         if ((UsedSlotsMask & SlotBit) == 0)
         {
             auto& DstStream     = Streams[BufferSlot];
             DstStream.BufferUId = BuffId;
-            DstStream.Offset    = SrcStream.Offset;
+            DstStream.Offset    = Offset;
             UsedSlotsMask |= SlotBit;
             HashCombine(Hash, DstStream.BufferUId, DstStream.Offset);
         }
@@ -209,7 +211,7 @@ VAOCache::VAOHashKey::VAOHashKey(const VAOAttribs& Attribs) :
             const auto& DstStream = Streams[BufferSlot];
             // The slot has already been initialized
             VERIFY_EXPR(DstStream.BufferUId == BuffId);
-            VERIFY_EXPR(DstStream.Offset == SrcStream.Offset);
+            VERIFY_EXPR(DstStream.Offset == Offset);
         }
     }
     HashCombine(Hash, UsedSlotsMask);
@@ -246,7 +248,7 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
     Threading::SpinLockGuard CacheGuard{m_CacheLock};
 
     // Construct the key
-    VAOHashKey Key{Attribs};
+    VAOHashKey Key{Attribs, !m_UseVertexAttribBinding};
 
     for (auto SlotMask = Key.UsedSlotsMask; SlotMask != 0;)
     {
@@ -255,7 +257,7 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
 
         auto& pBuffer = Attribs.VertexStreams[Slot].pBuffer;
         VERIFY_EXPR(pBuffer);
-        VERIFY_EXPR(Key.Streams[Slot].BufferUId == pBuffer->GetUniqueID());
+        VERIFY_EXPR(m_UseVertexAttribBinding || Key.Streams[Slot].BufferUId == pBuffer->GetUniqueID());
 
         pBuffer->BufferMemoryBarrier(
             MEMORY_BARRIER_VERTEX_BUFFER, // Vertex data sourced from buffer objects after the barrier
@@ -279,6 +281,11 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
     auto It = m_Cache.find(Key);
     if (It != m_Cache.end())
     {
+        if (m_UseVertexAttribBinding)
+        {
+            GLState.BindVAO(It->second);
+            BindVertexBuffers(Attribs, GLState);
+        }
         return It->second;
     }
     else
@@ -288,47 +295,12 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
 
         // Initialize VAO
         GLState.BindVAO(NewVAO);
-
-        const auto& InputLayout = Attribs.PSO.GetGraphicsPipelineDesc().InputLayout;
-        const auto* LayoutElems = InputLayout.LayoutElements;
-        for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+        InitVertexFormat(Attribs, GLState);
+        if (m_UseVertexAttribBinding)
         {
-            const auto& LayoutElem = LayoutElems[i];
-            const auto  BuffSlot   = LayoutElem.BufferSlot;
-            VERIFY_EXPR(BuffSlot < Attribs.NumVertexStreams);
-
-            // Get buffer through the strong reference. Note that we are not
-            // using pointers stored in the key for safety
-            const auto&   CurrStream = Attribs.VertexStreams[BuffSlot];
-            const auto    Stride     = Attribs.PSO.GetBufferStride(BuffSlot);
-            BufferGLImpl* pBuffer    = Attribs.VertexStreams[BuffSlot].pBuffer;
-
-            constexpr bool ResetVAO = false;
-            GLState.BindBuffer(GL_ARRAY_BUFFER, pBuffer->m_GlBuffer, ResetVAO);
-            GLvoid* DataStartOffset = reinterpret_cast<GLvoid*>(StaticCast<size_t>(CurrStream.Offset) + static_cast<size_t>(LayoutElem.RelativeOffset));
-
-            const auto GlType = TypeToGLType(LayoutElem.ValueType);
-            if (!LayoutElem.IsNormalized &&
-                (LayoutElem.ValueType == VT_INT8 ||
-                 LayoutElem.ValueType == VT_INT16 ||
-                 LayoutElem.ValueType == VT_INT32 ||
-                 LayoutElem.ValueType == VT_UINT8 ||
-                 LayoutElem.ValueType == VT_UINT16 ||
-                 LayoutElem.ValueType == VT_UINT32))
-                glVertexAttribIPointer(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, Stride, DataStartOffset);
-            else
-                glVertexAttribPointer(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.IsNormalized, Stride, DataStartOffset);
-
-            if (LayoutElem.Frequency == INPUT_ELEMENT_FREQUENCY_PER_INSTANCE)
-            {
-                // If divisor is zero, then the attribute acts like normal, being indexed by the array or index
-                // buffer. If divisor is non-zero, then the current instance is divided by this divisor, and
-                // the result of that is used to access the attribute array.
-                glVertexAttribDivisor(LayoutElem.InputIndex, LayoutElem.InstanceDataStepRate);
-            }
-            glEnableVertexAttribArray(LayoutElem.InputIndex);
+            BindVertexBuffers(Attribs, GLState);
         }
-        if (Attribs.pIndexBuffer)
+        else if (Attribs.pIndexBuffer)
         {
             constexpr bool ResetVAO = false;
             GLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, Attribs.pIndexBuffer->m_GlBuffer, ResetVAO);
@@ -340,6 +312,12 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
         VERIFY_EXPR(Key.PsoUId == Attribs.PSO.GetUniqueID());
         m_PSOToKey[Key.PsoUId].push_back(Key);
 
+        if (m_UseVertexAttribBinding)
+        {
+            // Format-only VAOs do not reference buffers
+            return NewElems.first->second;
+        }
+
         if (Attribs.pIndexBuffer)
         {
             VERIFY_EXPR(Key.IndexBufferUId == Attribs.pIndexBuffer->GetUniqueID());
@@ -365,6 +343,108 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
     }
 }
 
+static bool IsIntegerVertexAttrib(const LayoutElement& LayoutElem)
+{
+    return (!LayoutElem.IsNormalized &&
+            (LayoutElem.ValueType == VT_INT8 ||
+             LayoutElem.ValueType == VT_INT16 ||
+             LayoutElem.ValueType == VT_INT32 ||
+             LayoutElem.ValueType == VT_UINT8 ||
+             LayoutElem.ValueType == VT_UINT16 ||
+             LayoutElem.ValueType == VT_UINT32));
+}
+
+void VAOCache::InitVertexFormat(const VAOAttribs& Attribs, GLContextState& GLState)
+{
+    const auto& InputLayout = Attribs.PSO.GetGraphicsPipelineDesc().InputLayout;
+    const auto* LayoutElems = InputLayout.LayoutElements;
+    for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+    {
+        const auto& LayoutElem = LayoutElems[i];
+        const auto  GlType     = TypeToGLType(LayoutElem.ValueType);
+        const auto  Divisor    = LayoutElem.Frequency == INPUT_ELEMENT_FREQUENCY_PER_INSTANCE ? LayoutElem.InstanceDataStepRate : 0;
+
+        if (m_UseVertexAttribBinding)
+        {
+#if GL_ARB_vertex_attrib_binding
+            // Every attribute uses its own binding point so that per-element relative offsets
+            // and instance step rates are handled exactly as with glVertexAttribPointer.
+            // The relative offset is applied to the buffer offset in BindVertexBuffers().
+            if (IsIntegerVertexAttrib(LayoutElem))
+                glVertexAttribIFormat(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, 0);
+            else
+                glVertexAttribFormat(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.IsNormalized, 0);
+            glVertexAttribBinding(LayoutElem.InputIndex, LayoutElem.InputIndex);
+            glVertexBindingDivisor(LayoutElem.InputIndex, Divisor);
+#else
+            UNEXPECTED("Vertex attrib binding is not supported");
+#endif
+        }
+        else
+        {
+            const auto BuffSlot = LayoutElem.BufferSlot;
+            VERIFY_EXPR(BuffSlot < Attribs.NumVertexStreams);
+
+            // Get buffer through the strong reference. Note that we are not
+            // using pointers stored in the key for safety
+            const auto&   CurrStream = Attribs.VertexStreams[BuffSlot];
+            const auto    Stride     = Attribs.PSO.GetBufferStride(BuffSlot);
+            BufferGLImpl* pBuffer    = Attribs.VertexStreams[BuffSlot].pBuffer;
+
+            constexpr bool ResetVAO = false;
+            GLState.BindBuffer(GL_ARRAY_BUFFER, pBuffer->m_GlBuffer, ResetVAO);
+            GLvoid* DataStartOffset = reinterpret_cast<GLvoid*>(StaticCast<size_t>(CurrStream.Offset) + static_cast<size_t>(LayoutElem.RelativeOffset));
+
+            if (IsIntegerVertexAttrib(LayoutElem))
+                glVertexAttribIPointer(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, Stride, DataStartOffset);
+            else
+                glVertexAttribPointer(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.IsNormalized, Stride, DataStartOffset);
+
+            if (Divisor != 0)
+            {
+                // If divisor is zero, then the attribute acts like normal, being indexed by the array or index
+                // buffer. If divisor is non-zero, then the current instance is divided by this divisor, and
+                // the result of that is used to access the attribute array.
+                glVertexAttribDivisor(LayoutElem.InputIndex, Divisor);
+            }
+        }
+        glEnableVertexAttribArray(LayoutElem.InputIndex);
+    }
+}
+
+void VAOCache::BindVertexBuffers(const VAOAttribs& Attribs, GLContextState& GLState)
+{
+    VERIFY_EXPR(m_UseVertexAttribBinding);
+
+#if GL_ARB_vertex_attrib_binding
+    const auto& InputLayout = Attribs.PSO.GetGraphicsPipelineDesc().InputLayout;
+    const auto* LayoutElems = InputLayout.LayoutElements;
+    for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+    {
+        const auto& LayoutElem = LayoutElems[i];
+        const auto  BuffSlot   = LayoutElem.BufferSlot;
+        VERIFY_EXPR(BuffSlot < Attribs.NumVertexStreams);
+
+        const auto&   CurrStream = Attribs.VertexStreams[BuffSlot];
+        const auto    Stride     = Attribs.PSO.GetBufferStride(BuffSlot);
+        BufferGLImpl* pBuffer    = CurrStream.pBuffer;
+        VERIFY_EXPR(pBuffer != nullptr);
+
+        const auto Offset = StaticCast<GLintptr>(CurrStream.Offset + LayoutElem.RelativeOffset);
+        glBindVertexBuffer(LayoutElem.InputIndex, pBuffer->m_GlBuffer, Offset, Stride);
+    }
+#else
+    UNEXPECTED("Vertex attrib binding is not supported");
+#endif
+
+    // Element array buffer binding is part of the VAO state
+    constexpr bool ResetVAO = false;
+    if (Attribs.pIndexBuffer)
+        GLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, Attribs.pIndexBuffer->m_GlBuffer, ResetVAO);
+    else
+        GLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+}
+
 const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetEmptyVAO()
 {
     return m_EmptyVAO;
@@ -37,6 +37,7 @@
 #include "VulkanDynamicHeap.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
+#include "VulkanUtilities/VulkanCommandBuffer.hpp"
 #include "STDAllocator.hpp"
 
 namespace Diligent
@@ -89,6 +90,11 @@ public:
         }
     }
 
+    // Returns the device address of the buffer data in the given context, accounting for the
+    // dynamic allocation. The buffer must have been created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+    // or be a dynamic buffer without a backing buffer when descriptor buffers are enabled.
+    VkDeviceAddress GetDynamicVkDeviceAddress(DeviceContextIndex CtxId) const;
+
     /// Implementation of IBufferVk::GetVkBuffer().
     virtual VkBuffer DILIGENT_CALL_TYPE GetVkBuffer() const override final;
 
@@ -126,6 +132,24 @@ public:
         return reinterpret_cast<Uint8*>(m_MemoryAllocation.Page->GetCPUMemory()) + m_BufferMemoryAlignedOffset;
     }
 
+    // Returns true if the buffer may be moved to new memory by RenderDeviceVkImpl::DefragmentMemory()
+    bool IsRelocatable() const;
+
+    const VulkanUtilities::VulkanMemoryAllocation& GetMemoryAllocation() const { return m_MemoryAllocation; }
+
+    // Vulkan objects that the buffer used before it was relocated
+    struct RelocationData
+    {
+        VulkanUtilities::BufferWrapper          Buffer;
+        VulkanUtilities::VulkanMemoryAllocation Memory;
+    };
+
+    // Creates a new buffer in new memory and records the command that copies the buffer contents
+    // to it. The caller must record the memory barriers before and after the copy. The old objects
+    // are moved to OldResources and must be released after the command buffer has been submitted.
+    // Returns false if the buffer could not be relocated.
+    bool Relocate(VulkanUtilities::VulkanCommandBuffer& CmdBuffer, RelocationData& OldResources) noexcept(false);
+
 private:
     friend class DeviceContextVkImpl;
 
@@ -136,6 +160,12 @@ private:
     Uint32       m_DynamicOffsetAlignment    = 0;
     VkDeviceSize m_BufferMemoryAlignedOffset = 0;
 
+    // Device address of m_VulkanBuffer, if it was created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+    VkDeviceAddress m_VkDeviceAddress = 0;
+
+    // Usage flags of m_VulkanBuffer, required to recreate the buffer when it is relocated
+    VkBufferUsageFlags m_VkUsageFlags = 0;
+
     // TODO (assiduous): move dynamic allocations to device context.
     static constexpr size_t CacheLineSize = 64;
     struct alignas(CacheLineSize) CtxDynamicData : VulkanDynamicAllocation
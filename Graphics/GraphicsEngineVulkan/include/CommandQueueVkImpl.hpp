@@ -33,6 +33,7 @@
 #include <mutex>
 #include <deque>
 #include <atomic>
+#include <vector>
 
 #include "EngineVkImplTraits.hpp"
 #include "ObjectBase.hpp"
@@ -104,7 +105,8 @@ public:
                        SoftwareQueueIndex                                    CommandQueueId,
                        Uint32                                                NumCommandQueues,
                        Uint32                                                vkQueueIndex,
-                       const ImmediateContextCreateInfo&                     CreateInfo);
+                       const ImmediateContextCreateInfo&                     CreateInfo,
+                       Uint32                                                SubmitBatchSize = 0);
     ~CommandQueueVkImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_CommandQueueVk, TBase)
@@ -118,6 +120,9 @@ public:
     /// Implementation of ICommandQueue::WaitForIdle().
     virtual Uint64 DILIGENT_CALL_TYPE WaitForIdle() override final;
 
+    /// Implementation of ICommandQueue::GetTimestampCalibration().
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final;
+
     /// Implementation of ICommandQueueVk::SubmitCmdBuffer().
     virtual Uint64 DILIGENT_CALL_TYPE SubmitCmdBuffer(VkCommandBuffer cmdBuffer) override final;
 
@@ -155,11 +160,20 @@ public:
         return m_LastSyncPoint;
     }
 
+    /// Submits all batched submissions to the Vulkan queue, see EngineVkCreateInfo::SubmitBatchSize.
+    void FlushBatchedSubmits();
+
+    bool IsSubmitBatchingEnabled() const { return m_SubmitBatchSize != 0; }
+
 private:
     SyncPointVkPtr CreateSyncPoint(Uint64 dbgValue);
 
     void InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore, Uint64 Value);
 
+    bool CanBatchSubmit(const VkSubmitInfo& SubmitInfo) const;
+    void AppendBatchedSubmit(const VkSubmitInfo& SubmitInfo);
+    void InternalFlushBatchedSubmits();
+
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice> m_LogicalDevice;
 
     const VkQueue            m_VkQueue;
@@ -191,6 +205,45 @@ private:
 
     std::shared_ptr<VulkanUtilities::VulkanSyncObjectManager> m_SyncObjectManager;
     FixedBlockMemoryAllocator                                 m_SyncPointAllocator;
+
+    // The maximum number of submissions that are batched before they are submitted to the queue.
+    // Zero if batching is disabled.
+    const Uint32 m_SubmitBatchSize;
+
+    // Submissions that have not been passed to vkQueueSubmit yet.
+    // All arrays are only accessed while m_QueueMutex is locked.
+    struct BatchedSubmitsInfo
+    {
+        struct SubmitRange
+        {
+            Uint32 FirstCmdBuffer       = 0;
+            Uint32 CmdBufferCount       = 0;
+            Uint32 FirstWaitSemaphore   = 0;
+            Uint32 WaitSemaphoreCount   = 0;
+            Uint32 FirstSignalSemaphore = 0;
+            Uint32 SignalSemaphoreCount = 0;
+            Uint32 WaitValueCount       = 0;
+            Uint32 SignalValueCount     = 0;
+            bool   HasTimelineValues    = false;
+        };
+        std::vector<SubmitRange> Submits;
+
+        std::vector<VkCommandBuffer>      CmdBuffers;
+        std::vector<VkSemaphore>          WaitSemaphores;
+        std::vector<VkPipelineStageFlags> WaitDstStageMasks;
+        std::vector<Uint64>               WaitValues; // Same size as WaitSemaphores
+        std::vector<VkSemaphore>          SignalSemaphores;
+        std::vector<Uint64>               SignalValues; // Same size as SignalSemaphores
+
+        // Temporary arrays that are filled when the batch is submitted
+        std::vector<VkSubmitInfo>                  SubmitInfos;
+        std::vector<VkTimelineSemaphoreSubmitInfo> TimelineInfos;
+
+        // Sync point that is signaled when all batched submissions are complete.
+        // Null if there are no batched submissions.
+        SyncPointVkPtr pSyncPoint;
+    };
+    BatchedSubmitsInfo m_Batch;
 };
 
 } // namespace Diligent
@@ -204,28 +204,24 @@ public:
         }
     // clang-format on
     {
-#ifdef DILIGENT_DEVELOPMENT
-        m_AllocatedSetCounter = 0;
-#endif
     }
 
     ~DescriptorSetAllocator();
 
     DescriptorSetAllocation Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "");
 
-#ifdef DILIGENT_DEVELOPMENT
     Int32 GetAllocatedDescriptorSetCounter() const
     {
         return m_AllocatedSetCounter.load();
     }
-#endif
+
+    // Adds the number of allocated descriptor sets and the total number of sets in all pools to the stats
+    void GetStats(DescriptorHeapStats& Stats);
 
 private:
     void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask);
 
-#ifdef DILIGENT_DEVELOPMENT
-    std::atomic<Int32> m_AllocatedSetCounter;
-#endif
+    std::atomic<Int32> m_AllocatedSetCounter{0};
 };
 
 
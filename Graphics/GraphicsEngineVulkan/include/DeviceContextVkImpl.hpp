@@ -58,6 +58,7 @@
 #include "DescriptorPoolManager.hpp"
 #include "HashUtils.hpp"
 #include "ManagedVulkanObject.hpp"
+#include "RenderPassCache.hpp"
 
 namespace Diligent
 {
@@ -213,6 +214,12 @@ public:
     /// Implementation of IDeviceContext::CopyTexture() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override final;
 
+    /// Implementation of IDeviceContext::UpdateTextures() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE UpdateTextures(const UpdateTextureAttribs* pUpdates, Uint32 NumUpdates) override final;
+
+    /// Implementation of IDeviceContext::CopyTextures() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CopyTextures(const CopyTextureAttribs* pCopies, Uint32 NumCopies) override final;
+
     /// Implementation of IDeviceContext::MapTextureSubresource() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE MapTextureSubresource(ITexture*                 pTexture,
                                                           Uint32                    MipLevel,
@@ -294,9 +301,23 @@ public:
     /// Implementation of IDeviceContext::BindSparseResourceMemory() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::ResolveQueries() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE ResolveQueries(const ResolveQueriesAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
+    /// Implementation of IDeviceContext::SetDynamicRenderState() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetDynamicRenderState(const DynamicRenderState& State) override final;
+
     // Transitions texture subresources from OldState to NewState, and optionally updates
     // internal texture state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal texture state is used as old state.
+    // If the texture tracks subresource states, every group of subresources in the range
+    // is transitioned from its own state.
     void TransitionTextureState(TextureVkImpl&           TextureVk,
                                 RESOURCE_STATE           OldState,
                                 RESOURCE_STATE           NewState,
@@ -321,6 +342,9 @@ public:
     /// Implementation of IDeviceContextVk::GetVkCommandBuffer().
     virtual VkCommandBuffer DILIGENT_CALL_TYPE GetVkCommandBuffer() override final;
 
+    /// Implementation of IDeviceContextVk::SetAsyncUploadContext().
+    virtual void DILIGENT_CALL_TYPE SetAsyncUploadContext(IDeviceContext* pUploadContext) override final;
+
     // Transitions BLAS state from OldState to NewState, and optionally updates internal state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal BLAS state is used as old state.
     void TransitionBLASState(BottomLevelASVkImpl& BLAS,
@@ -365,6 +389,8 @@ public:
                            RESOURCE_STATE_TRANSITION_MODE DstTextureTransitionMode,
                            const VkImageCopy&             CopyRegion);
 
+    VkDeviceSize GetTextureUploadOffsetAlignment(TEXTURE_FORMAT Format) const;
+
     void UpdateTextureRegion(const void*                    pSrcData,
                              Uint64                         SrcStride,
                              Uint64                         SrcDepthStride,
@@ -416,17 +442,24 @@ private:
     void Flush(Uint32               NumCommandLists,
                ICommandList* const* ppCommandLists);
 
+    // Executes secondary command buffers inside the active render pass
+    void ExecuteSecondaryCommandLists(Uint32               NumCommandLists,
+                                      ICommandList* const* ppCommandLists);
+
     __forceinline void TransitionOrVerifyBufferState(BufferVkImpl&                  Buffer,
                                                      RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                      RESOURCE_STATE                 RequiredState,
                                                      VkAccessFlagBits               ExpectedAccessFlags,
                                                      const char*                    OperationName);
 
+    // If pRange is not null and the texture tracks subresource states, only the
+    // subresources in the range are transitioned or verified.
     __forceinline void TransitionOrVerifyTextureState(TextureVkImpl&                 Texture,
                                                       RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                       RESOURCE_STATE                 RequiredState,
                                                       VkImageLayout                  ExpectedLayout,
-                                                      const char*                    OperationName);
+                                                      const char*                    OperationName,
+                                                      const TextureSubresourceRange* pRange = nullptr);
 
     __forceinline void TransitionOrVerifyBLASState(BottomLevelASVkImpl&           BLAS,
                                                    RESOURCE_STATE_TRANSITION_MODE TransitionMode,
@@ -440,6 +473,8 @@ private:
 
     void AliasingBarrier(IDeviceObject* pResourceBefore, IDeviceObject* pResourceAfter);
 
+    void CommitDynamicRenderState(const DynamicRenderState& State);
+
     __forceinline void EnsureVkCmdBuffer()
     {
         VERIFY_EXPR(m_CmdPool != nullptr);
@@ -450,11 +485,11 @@ private:
         if (m_CommandBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE)
         {
             auto vkCmdBuff = m_CmdPool->GetCommandBuffer();
-            m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff, m_CmdPool->GetSupportedStagesMask(), m_CmdPool->GetSupportedAccessMask());
+            m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff, m_CmdPool->GetSupportedStagesMask(), m_CmdPool->GetSupportedAccessMask(), m_pDevice->IsSynchronization2Enabled());
         }
     }
 
-    inline void DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue);
+    inline void DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, VkCommandBufferLevel Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
     inline void DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQueue, Uint64 FenceValue);
 
     void CopyBufferToTexture(VkBuffer                       vkSrcBuffer,
@@ -487,7 +522,17 @@ private:
 
     void PrepareCommandPool(SoftwareQueueIndex CommandQueueId);
 
+    // Returns true if the update of the resource should be recorded into the async upload context
+    template <typename ResourceImplType>
+    bool UseAsyncUpload(ResourceImplType& Resource, RESOURCE_STATE_TRANSITION_MODE TransitionMode) const;
+    void OnAsyncUpload(IDeviceObject* pResource);
+    // Submits the uploads recorded into the async upload context since the last call
+    void SubmitAsyncUploads();
+
     void ChooseRenderPassAndFramebuffer();
+    void SetupDynamicRenderingAttachments();
+    void InitImplicitRenderPassOps();
+    void BeginImplicitRenderPass();
 
     VulkanUtilities::VulkanCommandBuffer m_CommandBuffer;
 
@@ -523,6 +568,14 @@ private:
             // Static/mutable and dynamic descriptor sets
             std::array<VkDescriptorSet, MAX_DESCR_SET_PER_SIGNATURE> vkSets = {};
 
+            // The number of descriptor sets that are written to the descriptor buffer
+            // when descriptor buffers are used instead of vkSets.
+            Uint32 NumDescrBufferSets = 0;
+
+            // Index of the dynamic descriptor set that is either pushed with vkCmdPushDescriptorSetKHR or
+            // allocated by CommitDescriptorSets(), depending on the pipeline layout. ~0u if there is none.
+            Uint32 DeferredDynamicSetInd = ~0u;
+
             // Descriptor set base index given by Layout.GetFirstDescrSetIndex
             Uint32 BaseInd = 0;
 
@@ -540,6 +593,9 @@ private:
         // Pipeline layout of the currently bound pipeline
         VkPipelineLayout vkPipelineLayout = VK_NULL_HANDLE;
 
+        // Binding index of the signature whose dynamic set is written with push descriptors
+        Uint32 PushDescrSetSign = PipelineLayoutVk::InvalidPushDescrSetBindIndex;
+
         ResourceBindInfo()
         {}
     };
@@ -547,6 +603,10 @@ private:
     __forceinline ResourceBindInfo& GetBindInfo(PIPELINE_TYPE Type);
 
     __forceinline void CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint32 CommitSRBMask);
+    void               CommitDescriptorBufferSets(ResourceBindInfo& BindInfo, Uint32 CommitSRBMask);
+
+    VkDescriptorSet AllocateAndWriteDynamicDescriptorSet(const PipelineResourceSignatureVkImpl& Signature,
+                                                         const ShaderResourceCacheVk&           ResourceCache);
 #ifdef DILIGENT_DEVELOPMENT
     void DvpValidateCommittedShaderResources(ResourceBindInfo& BindInfo);
 #endif
@@ -568,6 +628,43 @@ private:
     /// This framebuffer may or may not be currently set in the command buffer
     VkFramebuffer m_vkFramebuffer = VK_NULL_HANDLE;
 
+    /// Attachments that match currently bound render targets when they are rendered
+    /// with vkCmdBeginRendering instead of m_vkRenderPass and m_vkFramebuffer
+    /// (see RenderDeviceVkImpl::IsDynamicRenderingEnabled()).
+    /// The dynamic render pass instance may or may not be currently started in the command buffer.
+    struct DynamicRenderingAttachments
+    {
+        bool IsValid    = false;
+        bool HasDepth   = false;
+        bool HasStencil = false;
+
+        Uint32 NumColorAttachments = 0;
+
+        std::array<VkRenderingAttachmentInfoKHR, MAX_RENDER_TARGETS> ColorAttachments;
+        VkRenderingAttachmentInfoKHR                                 DepthStencilAttachment;
+    };
+    DynamicRenderingAttachments m_DynamicRendering;
+
+    /// Load and store operations of the implicit render pass instance (m_vkRenderPass or dynamic rendering)
+    /// that will be started for the currently bound render targets.
+    /// A clear that starts the instance becomes ATTACHMENT_LOAD_OP_CLEAR, and SetRenderTargetsAttribs::Flags
+    /// select ATTACHMENT_LOAD_OP_DISCARD and ATTACHMENT_STORE_OP_DISCARD.
+    /// When the instance is interrupted and started again, the attachments are loaded.
+    struct ImplicitRenderPassState
+    {
+        RenderPassCache::RenderPassCacheKey Key;
+        RenderPassCache::AttachmentOps      Ops;
+
+        /// Clear values of the color attachments that use ATTACHMENT_LOAD_OP_CLEAR, indexed by render target.
+        std::array<VkClearValue, MAX_RENDER_TARGETS> RTVClearValues = {};
+        /// Clear value of the depth-stencil attachment.
+        VkClearValue DSVClearValue = {};
+
+        /// Whether an instance has been started since the render targets were set.
+        bool Started = false;
+    };
+    ImplicitRenderPassState m_ImplicitRenderPass;
+
     FixedBlockMemoryAllocator m_CmdListAllocator;
 
     // Semaphores are not owned by the command context
@@ -587,8 +684,26 @@ private:
     std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>> m_SignalFences;
     std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>> m_WaitFences;
 
+    // Scratch arrays reused by Flush() and ExecuteSecondaryCommandLists() to avoid allocating memory every time
+    std::vector<VkCommandBuffer>               m_ScratchVkCmdBuffs;
+    std::vector<RefCntAutoPtr<IDeviceContext>> m_ScratchDeferredCtxs;
+
     std::unordered_map<BufferVkImpl*, VulkanUploadAllocation> m_UploadAllocations;
 
+    // Immediate context that executes resource uploads asynchronously (see SetAsyncUploadContext())
+    RefCntAutoPtr<DeviceContextVkImpl> m_pAsyncUploadCtx;
+    // Fence signaled by the upload context and waited for by this context
+    RefCntAutoPtr<FenceVkImpl> m_pAsyncUploadFence;
+    // The last fence value signaled by the upload context
+    Uint64 m_AsyncUploadSignaledValue = 0;
+    // The last fence value this context has waited for
+    Uint64 m_AsyncUploadWaitedValue = 0;
+    // The number of uploads recorded into the upload context that have not been submitted yet
+    Uint32 m_NumPendingAsyncUploads = 0;
+    // Resources updated through the upload context that have not been used by this context
+    // since it was last flushed. Further updates of these resources also go to the upload context.
+    std::unordered_map<IDeviceObject*, RefCntAutoPtr<IDeviceObject>> m_AsyncUploadResources;
+
     struct MappedTextureKey
     {
         TextureVkImpl* const Texture;
@@ -633,6 +748,14 @@ private:
 
     std::vector<VkClearValue> m_vkClearValues;
 
+    // Immediate context: the active render pass was begun with BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS.
+    // Deferred context: the command buffer is a secondary command buffer that inherits the render pass.
+    bool m_SecondaryCmdBuffersRenderPass = false;
+
+    // Secondary command buffers executed by the immediate context that are disposed
+    // when the primary command buffer is submitted.
+    std::vector<std::pair<RefCntAutoPtr<DeviceContextVkImpl>, VkCommandBuffer>> m_ExecutedSecondaryCmdBuffers;
+
     VulkanUtilities::QueryPoolWrapper m_ASQueryPool;
 };
 
@@ -70,9 +70,19 @@ public:
     /// Implementation of IFence::Wait() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE Wait(Uint64 Value) override final;
 
+    /// Implementation of IFence::WaitWithTimeout() in Vulkan backend.
+    virtual Bool DILIGENT_CALL_TYPE WaitWithTimeout(Uint64 Value, Uint64 Timeout) override final;
+
+    // Same as WaitWithTimeout(), but does not submit the work batched by the command queues.
+    // Used by the command queue that waits for its own fence while its mutex is locked.
+    Bool InternalWait(Uint64 Value, Uint64 Timeout);
+
     /// Implementation of IFenceVk::GetVkSemaphore().
     virtual VkSemaphore DILIGENT_CALL_TYPE GetVkSemaphore() override final { return m_TimelineSemaphore; }
 
+    /// Implementation of IFenceVk::ExportSemaphoreHandle().
+    virtual Bool DILIGENT_CALL_TYPE ExportSemaphoreHandle(Uint64& Handle) override final;
+
     VulkanUtilities::VulkanRecycledSemaphore ExtractSignalSemaphore(SoftwareQueueIndex CommandQueueId, Uint64 Value);
 
     void Reset(Uint64 Value);
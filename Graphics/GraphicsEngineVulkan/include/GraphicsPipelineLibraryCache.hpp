@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GraphicsPipelineLibraryCache class
+
+#include <array>
+#include <unordered_map>
+#include <mutex>
+
+#include "GraphicsTypes.h"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Caches the graphics pipeline libraries (VK_EXT_graphics_pipeline_library) that
+/// graphics pipelines are linked from. The libraries are shared between all pipelines
+/// created by the device and live as long as the device.
+class GraphicsPipelineLibraryCache
+{
+public:
+    GraphicsPipelineLibraryCache(RenderDeviceVkImpl& DeviceVk) noexcept;
+
+    // clang-format off
+    GraphicsPipelineLibraryCache             (const GraphicsPipelineLibraryCache&) = delete;
+    GraphicsPipelineLibraryCache             (GraphicsPipelineLibraryCache&&)      = delete;
+    GraphicsPipelineLibraryCache& operator = (const GraphicsPipelineLibraryCache&) = delete;
+    GraphicsPipelineLibraryCache& operator = (GraphicsPipelineLibraryCache&&)      = delete;
+    // clang-format on
+
+    ~GraphicsPipelineLibraryCache();
+
+    enum LIBRARY_TYPE : Uint32
+    {
+        LIBRARY_TYPE_VERTEX_INPUT = 0,
+        LIBRARY_TYPE_PRE_RASTERIZATION,
+        LIBRARY_TYPE_FRAGMENT_SHADER,
+        LIBRARY_TYPE_FRAGMENT_OUTPUT,
+        LIBRARY_TYPE_COUNT
+    };
+
+    // Returns the library of the given type with the given hash. If there is no such library
+    // in the cache, it is created from the state of the complete pipeline create info PipelineCI
+    // that is relevant for the library type.
+    VkPipeline GetLibrary(LIBRARY_TYPE                        Type,
+                          size_t                              Hash,
+                          const VkGraphicsPipelineCreateInfo& PipelineCI,
+                          VkPipelineCache                     vkPSOCache,
+                          const char*                         PipelineName) noexcept(false);
+
+    void Destroy();
+
+private:
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    std::mutex                                                                                  m_Mutex;
+    std::array<std::unordered_map<size_t, VulkanUtilities::PipelineWrapper>, LIBRARY_TYPE_COUNT> m_Libraries;
+};
+
+} // namespace Diligent
@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PersistentPipelineCache class
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "GraphicsTypes.h"
+#include "VulkanUtilities/VulkanLogicalDevice.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Engine-managed Vulkan pipeline cache that is loaded from and saved to a file
+/// (see EngineVkCreateInfo::PipelineCacheFilePath). It is used by all pipelines that
+/// are created without an explicit pipeline state cache.
+///
+/// Pipelines are created with caches taken from a pool, so that pipelines compiled
+/// in parallel never use the same VkPipelineCache object. Before the data is saved, the pooled
+/// caches are merged into the main cache with vkMergePipelineCaches.
+///
+/// When VK_EXT_shader_module_identifier is enabled, the file also stores the identifiers of the
+/// shader modules the pipelines were created with. On the next run, pipelines are first created
+/// from the identifiers only, which avoids creating the shader modules if the pipelines are found
+/// in the cache.
+class PersistentPipelineCache
+{
+public:
+    PersistentPipelineCache(RenderDeviceVkImpl& DeviceVk, const char* FilePath, Uint32 SaveInterval) noexcept(false);
+
+    // clang-format off
+    PersistentPipelineCache             (const PersistentPipelineCache&) = delete;
+    PersistentPipelineCache             (PersistentPipelineCache&&)      = delete;
+    PersistentPipelineCache& operator = (const PersistentPipelineCache&) = delete;
+    PersistentPipelineCache& operator = (PersistentPipelineCache&&)      = delete;
+    // clang-format on
+
+    ~PersistentPipelineCache();
+
+    /// Pipeline cache that is returned to the pool when the object is destroyed.
+    class ScopedCache
+    {
+    public:
+        ScopedCache(PersistentPipelineCache* pOwner, VkPipelineCache vkCache) noexcept :
+            m_pOwner{pOwner},
+            m_vkCache{vkCache}
+        {}
+
+        ScopedCache(ScopedCache&& Other) noexcept :
+            m_pOwner{Other.m_pOwner},
+            m_vkCache{Other.m_vkCache}
+        {
+            Other.m_pOwner  = nullptr;
+            Other.m_vkCache = VK_NULL_HANDLE;
+        }
+
+        // clang-format off
+        ScopedCache             (const ScopedCache&) = delete;
+        ScopedCache& operator = (const ScopedCache&) = delete;
+        ScopedCache& operator = (ScopedCache&&)      = delete;
+        // clang-format on
+
+        ~ScopedCache()
+        {
+            if (m_pOwner != nullptr)
+                m_pOwner->Release(m_vkCache);
+        }
+
+        operator VkPipelineCache() const { return m_vkCache; }
+
+    private:
+        PersistentPipelineCache* m_pOwner  = nullptr;
+        VkPipelineCache          m_vkCache = VK_NULL_HANDLE;
+    };
+
+    /// Returns the cache that the calling thread may use exclusively until the returned object is destroyed.
+    /// If the persistent cache is disabled, the returned object holds VK_NULL_HANDLE.
+    ScopedCache Acquire();
+
+    /// Merges all pooled caches into the main cache and writes the data to the file.
+    /// Does nothing if no pipelines were created since the last save.
+    void Save();
+
+    /// Stops the background thread, saves the cache and destroys all Vulkan objects.
+    void Destroy();
+
+    bool IsEnabled() const { return !m_FilePath.empty(); }
+
+    /// Shader module identifier, see VkShaderModuleIdentifierEXT.
+    struct ShaderModuleIdentifier
+    {
+        Uint32 Size = 0;
+        Uint8  Data[VK_MAX_SHADER_MODULE_IDENTIFIER_SIZE_EXT] = {};
+    };
+
+    /// Returns true if the cache stores shader module identifiers.
+    bool AreShaderModuleIdentifiersEnabled() const { return m_ShaderModuleIdsEnabled; }
+
+    /// Finds the identifier of the shader module that was created from the given SPIR-V code.
+    bool FindShaderModuleIdentifier(const std::vector<uint32_t>& SPIRV, ShaderModuleIdentifier& Id);
+
+    /// Stores the identifier of the shader module that was created from the given SPIR-V code.
+    void AddShaderModuleIdentifier(const std::vector<uint32_t>& SPIRV, VkShaderModule vkModule);
+
+    /// Checks that the pipeline cache data was produced by the physical device with the given properties.
+    static bool IsCacheDataCompatible(const VkPhysicalDeviceProperties& Props, const void* pData, size_t DataSize);
+
+private:
+    void Release(VkPipelineCache vkCache);
+
+    void StopSaveThread();
+
+    void SaveThreadFunc(Uint32 SaveInterval);
+
+private:
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    const std::string m_FilePath;
+
+    // Data loaded from the file that all caches are initialized with
+    std::vector<Uint8> m_InitialData;
+
+    // Protects the main cache and the file
+    std::mutex                            m_SaveMtx;
+    VulkanUtilities::PipelineCacheWrapper m_MainCache;
+
+    // Protects the pool
+    std::mutex                                         m_PoolMtx;
+    std::vector<VulkanUtilities::PipelineCacheWrapper> m_Caches;
+    std::vector<VkPipelineCache>                       m_FreeCaches;
+
+    // Set when a pooled cache is released or a new shader module identifier is added,
+    // and cleared when the data is saved
+    std::atomic<bool> m_IsDirty{false};
+
+    // Shader module identifiers keyed by the hash of the SPIR-V code
+    bool                                               m_ShaderModuleIdsEnabled = false;
+    std::mutex                                         m_ShaderModuleIdsMtx;
+    std::unordered_map<Uint64, ShaderModuleIdentifier> m_ShaderModuleIds;
+
+    std::thread             m_SaveThread;
+    std::mutex              m_SaveThreadMtx;
+    std::condition_variable m_SaveThreadCV;
+    bool                    m_StopSaveThread = false;
+};
+
+} // namespace Diligent
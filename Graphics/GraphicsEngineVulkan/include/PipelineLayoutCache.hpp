@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineLayoutCache class
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "GraphicsTypes.h"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Device-wide cache of descriptor set layouts and pipeline layouts.
+///
+/// Layouts are looked up by their contents, so resource signatures that define identical
+/// descriptor sets share the same VkDescriptorSetLayout, and pipelines that use identical
+/// sets share the same VkPipelineLayout. Since the device context only rebinds descriptor
+/// sets when the pipeline layout handle changes, switching between layout-compatible
+/// pipelines keeps the bound sets intact.
+///
+/// Layouts are reference-counted and are released when the last reference is destroyed.
+class PipelineLayoutCache
+{
+private:
+    struct SetLayoutKey
+    {
+        SetLayoutKey(const VkDescriptorSetLayoutCreateInfo& LayoutCI);
+
+        bool operator==(const SetLayoutKey& rhs) const;
+
+        struct Hasher
+        {
+            size_t operator()(const SetLayoutKey& Key) const
+            {
+                return Key.Hash;
+            }
+        };
+
+        VkDescriptorSetLayoutCreateFlags Flags = 0;
+
+        // Binding descriptions. pImmutableSamplers is always null, the samplers of all
+        // bindings are stored consecutively in ImmutableSamplers (a single null handle
+        // for bindings that don't use immutable samplers).
+        std::vector<VkDescriptorSetLayoutBinding> Bindings;
+        std::vector<VkSampler>                    ImmutableSamplers;
+
+        size_t Hash = 0;
+    };
+
+    struct SetLayoutEntry
+    {
+        VulkanUtilities::DescriptorSetLayoutWrapper vkLayout;
+
+        Uint32 RefCount = 0;
+    };
+    using SetLayoutMapType = std::unordered_map<SetLayoutKey, SetLayoutEntry, SetLayoutKey::Hasher>;
+
+public:
+    /// Reference to a cached layout
+    template <typename MapType, typename VkObjectType>
+    class LayoutRef
+    {
+    public:
+        LayoutRef() noexcept {}
+
+        LayoutRef(const LayoutRef& rhs) noexcept :
+            m_pCache{rhs.m_pCache},
+            m_pNode{rhs.m_pNode}
+        {
+            if (m_pNode != nullptr)
+                m_pCache->AddRef(m_pNode);
+        }
+
+        LayoutRef(LayoutRef&& rhs) noexcept :
+            m_pCache{rhs.m_pCache},
+            m_pNode{rhs.m_pNode}
+        {
+            rhs.m_pCache = nullptr;
+            rhs.m_pNode  = nullptr;
+        }
+
+        LayoutRef& operator=(const LayoutRef& rhs) noexcept
+        {
+            if (this != &rhs)
+                *this = LayoutRef{rhs};
+            return *this;
+        }
+
+        LayoutRef& operator=(LayoutRef&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                Release();
+                m_pCache     = rhs.m_pCache;
+                m_pNode      = rhs.m_pNode;
+                rhs.m_pCache = nullptr;
+                rhs.m_pNode  = nullptr;
+            }
+            return *this;
+        }
+
+        ~LayoutRef()
+        {
+            Release();
+        }
+
+        /// Releases the reference. The layout is destroyed when this was the last one.
+        void Release()
+        {
+            if (m_pNode != nullptr)
+            {
+                m_pCache->Release(m_pNode);
+                m_pCache = nullptr;
+                m_pNode  = nullptr;
+            }
+        }
+
+        operator VkObjectType() const
+        {
+            return m_pNode != nullptr ? static_cast<VkObjectType>(m_pNode->second.vkLayout) : VK_NULL_HANDLE;
+        }
+
+        explicit operator bool() const
+        {
+            return m_pNode != nullptr;
+        }
+
+    private:
+        friend PipelineLayoutCache;
+
+        using NodeType = typename MapType::value_type;
+
+        // Pointers to unordered_map elements are not invalidated by rehashing
+        LayoutRef(PipelineLayoutCache* pCache, NodeType* pNode) noexcept :
+            m_pCache{pCache},
+            m_pNode{pNode}
+        {}
+
+        PipelineLayoutCache* m_pCache = nullptr;
+        NodeType*            m_pNode  = nullptr;
+    };
+
+    using SetLayoutRef = LayoutRef<SetLayoutMapType, VkDescriptorSetLayout>;
+
+private:
+    struct PipelineLayoutKey
+    {
+        PipelineLayoutKey(const SetLayoutRef* const* ppSetLayouts, Uint32 SetLayoutCount);
+
+        bool operator==(const PipelineLayoutKey& rhs) const
+        {
+            return Hash == rhs.Hash && SetLayouts == rhs.SetLayouts;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const PipelineLayoutKey& Key) const
+            {
+                return Key.Hash;
+            }
+        };
+
+        // Set layouts are deduplicated, so comparing the handles is
+        // equivalent to comparing the layout contents.
+        std::vector<VkDescriptorSetLayout> SetLayouts;
+
+        size_t Hash = 0;
+    };
+
+    struct PipelineLayoutEntry
+    {
+        VulkanUtilities::PipelineLayoutWrapper vkLayout;
+
+        // Keep the set layouts alive while the pipeline layout is in the cache
+        // as otherwise their handles may be reused by other layouts.
+        std::vector<SetLayoutRef> SetLayouts;
+
+        Uint32 RefCount = 0;
+    };
+    using PipelineLayoutMapType = std::unordered_map<PipelineLayoutKey, PipelineLayoutEntry, PipelineLayoutKey::Hasher>;
+
+public:
+    using PipelineLayoutRef = LayoutRef<PipelineLayoutMapType, VkPipelineLayout>;
+
+    PipelineLayoutCache(RenderDeviceVkImpl& DeviceVk) noexcept;
+
+    // clang-format off
+    PipelineLayoutCache             (const PipelineLayoutCache&) = delete;
+    PipelineLayoutCache             (PipelineLayoutCache&&)      = delete;
+    PipelineLayoutCache& operator = (const PipelineLayoutCache&) = delete;
+    PipelineLayoutCache& operator = (PipelineLayoutCache&&)      = delete;
+    // clang-format on
+
+    ~PipelineLayoutCache();
+
+    /// Returns the descriptor set layout with the given description, creating it if necessary.
+    SetLayoutRef GetSetLayout(const VkDescriptorSetLayoutCreateInfo& LayoutCI) noexcept(false);
+
+    /// Returns the pipeline layout that uses the given descriptor set layouts, creating it if necessary.
+    PipelineLayoutRef GetPipelineLayout(const SetLayoutRef* const* ppSetLayouts, Uint32 SetLayoutCount) noexcept(false);
+
+private:
+    template <typename NodeType>
+    void AddRef(NodeType* pNode);
+
+    void Release(SetLayoutMapType::value_type* pNode);
+    void Release(PipelineLayoutMapType::value_type* pNode);
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    std::mutex            m_Mutex;
+    SetLayoutMapType      m_SetLayouts;
+    PipelineLayoutMapType m_PipelineLayouts;
+};
+
+} // namespace Diligent
@@ -32,7 +32,7 @@
 
 #include <array>
 
-#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "PipelineLayoutCache.hpp"
 
 namespace Diligent
 {
@@ -48,7 +48,7 @@ public:
     ~PipelineLayoutVk();
 
     void Create(RenderDeviceVkImpl* pDeviceVk, RefCntAutoPtr<PipelineResourceSignatureVkImpl> ppSignatures[], Uint32 SignatureCount) noexcept(false);
-    void Release(RenderDeviceVkImpl* pDeviceVkImpl, Uint64 CommandQueueMask);
+    void Release();
 
     VkPipelineLayout GetVkPipelineLayout() const { return m_VkPipelineLayout; }
 
@@ -59,8 +59,21 @@ public:
         return m_FirstDescrSetIndex[Index];
     }
 
+    static constexpr Uint32 InvalidPushDescrSetBindIndex = 0xFF;
+
+    // Returns the binding index of the resource signature whose dynamic descriptor set
+    // is written with push descriptors, or InvalidPushDescrSetBindIndex.
+    Uint32 GetPushDescrSetBindIndex() const { return m_PushDescrSetBindIndex; }
+
+    // Returns the hash of the resource signatures that define this layout.
+    // Layouts with equal hashes are identically defined.
+    size_t GetHash() const { return m_Hash; }
+
 private:
-    VulkanUtilities::PipelineLayoutWrapper m_VkPipelineLayout;
+    // Pipeline layouts are shared by all pipelines that use identical descriptor set layouts (see PipelineLayoutCache)
+    PipelineLayoutCache::PipelineLayoutRef m_VkPipelineLayout;
+
+    size_t m_Hash = 0;
 
     using FirstDescrSetIndexArrayType = std::array<Uint8, MAX_RESOURCE_SIGNATURES>;
     // Index of the first descriptor set, for every resource signature.
@@ -70,6 +83,9 @@ private:
     // (Maximum is MAX_RESOURCE_SIGNATURES * 2)
     Uint8 m_DescrSetCount = 0;
 
+    // Binding index of the signature that uses the push descriptor set
+    Uint8 m_PushDescrSetBindIndex = InvalidPushDescrSetBindIndex;
+
 #ifdef DILIGENT_DEBUG
     Uint32 m_DbgMaxBindIndex = 0;
 #endif
@@ -199,5 +199,23 @@ inline VkDescriptorType DescriptorTypeToVkDescriptorType(DescriptorType Type)
     }
 }
 
+// Descriptor buffers do not support descriptors with dynamic offsets. Buffers with dynamic
+// offsets use regular descriptors that are rewritten with the current buffer address instead.
+inline VkDescriptorType DescriptorTypeToVkDescriptorBufferType(DescriptorType Type)
+{
+    switch (Type)
+    {
+        case DescriptorType::UniformBufferDynamic:
+            return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+            return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+        default:
+            return DescriptorTypeToVkDescriptorType(Type);
+    }
+}
+
 
 } // namespace Diligent
@@ -42,7 +42,9 @@
 #include "ShaderResourceBindingVkImpl.hpp"
 
 #include "PipelineResourceAttribsVk.hpp"
+#include "PipelineLayoutCache.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "VulkanUtilities/VulkanCommandBuffer.hpp"
 #include "SRBMemoryAllocator.hpp"
 
 namespace Diligent
@@ -120,7 +122,9 @@ public:
 
     VkDescriptorSetLayout GetVkDescriptorSetLayout(DESCRIPTOR_SET_ID SetId) const { return m_VkDescrSetLayouts[SetId]; }
 
-    bool   HasDescriptorSet(DESCRIPTOR_SET_ID SetId) const { return m_VkDescrSetLayouts[SetId] != VK_NULL_HANDLE; }
+    const PipelineLayoutCache::SetLayoutRef& GetDescriptorSetLayoutRef(DESCRIPTOR_SET_ID SetId) const { return m_VkDescrSetLayouts[SetId]; }
+
+    bool   HasDescriptorSet(DESCRIPTOR_SET_ID SetId) const { return static_cast<bool>(m_VkDescrSetLayouts[SetId]); }
     Uint32 GetDescriptorSetSize(DESCRIPTOR_SET_ID SetId) const { return m_DescriptorSetSizes[SetId]; }
 
     void InitSRBResourceCache(ShaderResourceCacheVk& ResourceCache);
@@ -134,6 +138,25 @@ public:
     void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                 VkDescriptorSet              vkDynamicDescriptorSet) const;
 
+    // Writes dynamic resources from ResourceCache into the command buffer with vkCmdPushDescriptorSetKHR.
+    // vkLayout must have been created with the push descriptor set layout at SetIndex.
+    void PushDynamicResources(const ShaderResourceCacheVk&          ResourceCache,
+                              VulkanUtilities::VulkanCommandBuffer& CmdBuffer,
+                              VkPipelineBindPoint                   BindPoint,
+                              VkPipelineLayout                      vkLayout,
+                              Uint32                                SetIndex) const;
+
+    // Returns true if the dynamic descriptor set is small enough to be pushed with vkCmdPushDescriptorSetKHR.
+    bool HasPushDescriptorSetLayout() const { return static_cast<bool>(m_VkPushDescrSetLayout); }
+
+    // Returns the push descriptor variant of the dynamic descriptor set layout
+    VkDescriptorSetLayout GetVkPushDescriptorSetLayout() const { return m_VkPushDescrSetLayout; }
+
+    const PipelineLayoutCache::SetLayoutRef& GetPushDescriptorSetLayoutRef() const { return m_VkPushDescrSetLayout; }
+
+    // The maximum number of descriptors in the dynamic set that may be written with push descriptors
+    static constexpr Uint32 MaxPushDescriptorSetSize = 16;
+
 #ifdef DILIGENT_DEVELOPMENT
     /// Verifies committed resource using the SPIRV resource attributes from the PSO.
     bool DvpValidateCommittedResource(const DeviceContextVkImpl*        pDeviceCtx,
@@ -178,15 +201,38 @@ private:
 
     void CreateSetLayouts(bool IsSerialized);
 
+    bool CanUsePushDescriptors(const std::vector<VkDescriptorSetLayoutBinding>& DynSetBindings) const;
+
+    template <typename FlushWritesType>
+    void WriteDynamicResources(const ShaderResourceCacheVk& ResourceCache,
+                               VkDescriptorSet              vkDynamicDescriptorSet,
+                               FlushWritesType              FlushWrites) const;
+    void InitDescriptorBufferLayouts(const std::array<Uint32, DESCRIPTOR_SET_ID_NUM_SETS>& DSMapping,
+                                     const std::vector<const VkSampler*>&                 ResourceImmutableSamplers);
+
+    // Returns the descriptor buffer layouts, or null if descriptor buffers are not used
+    const DescriptorBufferSetLayoutVk* GetDescriptorBufferLayouts() const
+    {
+        return m_DescrBufferLayouts[0].DataSize != 0 ? m_DescrBufferLayouts.data() : nullptr;
+    }
+
     static inline CACHE_GROUP       GetResourceCacheGroup(const PipelineResourceDesc& Res);
     static inline DESCRIPTOR_SET_ID VarTypeToDescriptorSetId(SHADER_RESOURCE_VARIABLE_TYPE VarType);
 
 private:
-    std::array<VulkanUtilities::DescriptorSetLayoutWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrSetLayouts;
+    // Descriptor set layouts are shared by all signatures that define identical sets (see PipelineLayoutCache)
+    std::array<PipelineLayoutCache::SetLayoutRef, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrSetLayouts;
+
+    // Push descriptor variant of m_VkDescrSetLayouts[DESCRIPTOR_SET_ID_DYNAMIC], if the set is small enough
+    PipelineLayoutCache::SetLayoutRef m_VkPushDescrSetLayout;
 
     // Descriptor set sizes indexed by the set index in the layout (not DESCRIPTOR_SET_ID!)
     std::array<Uint32, MAX_DESCRIPTOR_SETS> m_DescriptorSetSizes = {~0U, ~0U};
 
+    // Descriptor buffer layouts indexed by the set index in the layout.
+    // Only initialized when descriptor buffers are enabled.
+    std::array<DescriptorBufferSetLayoutVk, MAX_DESCRIPTOR_SETS> m_DescrBufferLayouts;
+
     // The total number of uniform buffers with dynamic offsets in both descriptor sets,
     // accounting for array size.
     Uint16 m_DynamicUniformBufferCount = 0;
@@ -31,6 +31,7 @@
 /// Declaration of Diligent::PipelineStateVkImpl class
 
 #include <array>
+#include <atomic>
 #include <memory>
 
 #include "EngineVkImplTraits.hpp"
@@ -69,7 +70,14 @@ public:
     virtual IRenderPassVk* DILIGENT_CALL_TYPE GetRenderPass() const override final { return GetRenderPassPtr().RawPtr<IRenderPassVk>(); }
 
     /// Implementation of IPipelineStateVk::GetVkPipeline().
-    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final { return m_Pipeline; }
+    ///
+    /// \remarks   For pipelines linked from graphics pipeline libraries, this returns the
+    ///             link-time optimized pipeline once it has been compiled in the background.
+    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final
+    {
+        const VkPipeline vkOptimizedPipeline = m_vkOptimizedPipeline.load(std::memory_order_acquire);
+        return vkOptimizedPipeline != VK_NULL_HANDLE ? vkOptimizedPipeline : static_cast<VkPipeline>(m_Pipeline);
+    }
 
     const PipelineLayoutVk& GetPipelineLayout() const { return m_PipelineLayout; }
 
@@ -112,7 +120,8 @@ public:
         bool                                                 bStripReflection,
         const char*                                          PipelineName,
         TShaderResources*                                    pShaderResources     = nullptr,
-        TResourceAttibutions*                                pResourceAttibutions = nullptr) noexcept(false);
+        TResourceAttibutions*                                pResourceAttibutions = nullptr,
+        IThreadPool*                                         pThreadPool          = nullptr) noexcept(false);
 
     static PipelineResourceSignatureDescWrapper GetDefaultResourceSignatureDesc(
         const TShaderStages&              ShaderStages,
@@ -122,9 +131,8 @@ public:
 
 private:
     template <typename PSOCreateInfoType>
-    TShaderStages InitInternalObjects(const PSOCreateInfoType&                           CreateInfo,
-                                      std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-                                      std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules) noexcept(false);
+    TShaderStages InitInternalObjects(const PSOCreateInfoType&                      CreateInfo,
+                                      std::vector<VkPipelineShaderStageCreateInfo>& vkShaderStages) noexcept(false);
 
     void InitPipelineLayout(const PipelineStateCreateInfo& CreateInfo,
                             TShaderStages&                 ShaderStages) noexcept(false);
@@ -141,6 +149,12 @@ private:
     VulkanUtilities::PipelineWrapper m_Pipeline;
     PipelineLayoutVk                 m_PipelineLayout;
 
+    // Link-time optimized pipeline that is linked from graphics pipeline libraries
+    // in the background and replaces the fast-linked m_Pipeline when it is ready.
+    VulkanUtilities::PipelineWrapper m_OptimizedPipeline;
+    std::atomic<VkPipeline>          m_vkOptimizedPipeline{VK_NULL_HANDLE};
+    RefCntAutoPtr<IAsyncTask>        m_pOptimizedPipelineTask;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Shader resources for all shaders in all shader stages
     TShaderResources m_ShaderResources;
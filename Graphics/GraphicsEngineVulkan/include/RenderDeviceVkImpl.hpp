@@ -30,7 +30,9 @@
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "EngineVkImplTraits.hpp"
@@ -51,6 +53,9 @@
 #include "VulkanUploadHeap.hpp"
 #include "FramebufferCache.hpp"
 #include "RenderPassCache.hpp"
+#include "GraphicsPipelineLibraryCache.hpp"
+#include "PersistentPipelineCache.hpp"
+#include "PipelineLayoutCache.hpp"
 #include "CommandPoolManager.hpp"
 #include "DXCompiler.hpp"
 
@@ -201,9 +206,42 @@ public:
                                                                   const FenceDesc& Desc,
                                                                   IFence**         ppFence) override final;
 
+    /// Implementation of IRenderDeviceVk::GetMemoryHeapCount().
+    virtual Uint32 DILIGENT_CALL_TYPE GetMemoryHeapCount() override final { return m_PhysicalDevice->GetMemoryProperties().memoryHeapCount; }
+
+    /// Implementation of IRenderDeviceVk::GetMemoryHeapBudget().
+    virtual void DILIGENT_CALL_TYPE GetMemoryHeapBudget(Uint32              HeapIndex,
+                                                        MemoryHeapBudgetVk& Budget) override final;
+
+    /// Implementation of IRenderDeviceVk::SetMemoryBudgetCallback().
+    virtual void DILIGENT_CALL_TYPE SetMemoryBudgetCallback(MemoryBudgetCallbackType Callback,
+                                                            float                    Threshold,
+                                                            void*                    pUserData) override final;
+
+    /// Implementation of IRenderDeviceVk::DefragmentMemory().
+    virtual void DILIGENT_CALL_TYPE DefragmentMemory(const DefragmentMemoryAttribsVk& Attribs,
+                                                     DefragmentMemoryStatsVk*         pStats) override final;
+
+    // Buffers and textures that may be moved to new memory by DefragmentMemory() register
+    // themselves at the end of the constructor and unregister at the start of the destructor.
+    void RegisterRelocatableResource(BufferVkImpl* pBuffer);
+    void RegisterRelocatableResource(TextureVkImpl* pTexture);
+    void UnregisterRelocatableResource(BufferVkImpl* pBuffer);
+    void UnregisterRelocatableResource(TextureVkImpl* pTexture);
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
+    /// Implementation of IRenderDevice::WaitForFences() in Vulkan backend.
+    virtual Bool DILIGENT_CALL_TYPE WaitForFences(const WaitForFencesAttribs& Attribs) override final;
+
+    /// Implementation of IRenderDevice::GetMemoryStats() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE GetMemoryStats(DeviceMemoryStats& Stats) override final;
+
+    // Submits the work batched by all command queues (see EngineVkCreateInfo::SubmitBatchSize).
+    // Must be called before the host waits for the GPU.
+    void FlushBatchedSubmits();
+
     // pImmediateCtx parameter is only used to make sure the command buffer is submitted from the immediate context
     // The method returns fence value associated with the submitted command buffer
     Uint64 ExecuteCommandBuffer(SoftwareQueueIndex CommandQueueId, const VkSubmitInfo& SubmitInfo, std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>>* pSignalFences);
@@ -236,19 +274,67 @@ public:
     FramebufferCache& GetFramebufferCache() { return m_FramebufferCache; }
     RenderPassCache&  GetImplicitRenderPassCache() { return m_ImplicitRenderPassCache; }
 
-    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties, VkMemoryAllocateFlags AllocateFlags = 0)
+    GraphicsPipelineLibraryCache& GetGraphicsPipelineLibraryCache() { return m_GraphicsPipelineLibraryCache; }
+
+    PersistentPipelineCache& GetPersistentPipelineCache() { return m_PersistentPipelineCache; }
+
+    PipelineLayoutCache& GetPipelineLayoutCache() { return m_PipelineLayoutCache; }
+
+    // Returns true if implicit render passes use VK_KHR_dynamic_rendering instead of
+    // render pass and framebuffer objects (see EngineVkCreateInfo::EnableDynamicRendering).
+    bool IsDynamicRenderingEnabled() const
     {
-        return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags);
+        return m_LogicalVkDevice->GetEnabledExtFeatures().DynamicRendering.dynamicRendering != VK_FALSE;
     }
-    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, VkMemoryAllocateFlags AllocateFlags = 0)
+
+    // Returns true if shader resources are bound through VK_EXT_descriptor_buffer instead of
+    // descriptor sets (see EngineVkCreateInfo::EnableDescriptorBuffer).
+    bool IsDescriptorBufferEnabled() const
+    {
+        return m_LogicalVkDevice->GetEnabledExtFeatures().DescriptorBuffer.descriptorBuffer != VK_FALSE;
+    }
+
+    // Returns true if small dynamic descriptor sets may be written with vkCmdPushDescriptorSetKHR
+    bool IsPushDescriptorEnabled() const
+    {
+        return m_LogicalVkDevice->GetEnabledExtFeatures().PushDescriptor;
+    }
+
+    // Returns true if pipeline barriers are recorded with vkCmdPipelineBarrier2KHR
+    bool IsSynchronization2Enabled() const
+    {
+        return m_LogicalVkDevice->GetEnabledExtFeatures().Synchronization2.synchronization2 != VK_FALSE;
+    }
+
+    // Returns true if graphics pipelines are created by linking pipeline libraries
+    // (see EngineVkCreateInfo::EnableGraphicsPipelineLibrary).
+    bool IsGraphicsPipelineLibraryEnabled() const
+    {
+        return m_LogicalVkDevice->GetEnabledExtFeatures().GraphicsPipelineLibrary.graphicsPipelineLibrary != VK_FALSE;
+    }
+
+    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements&                           MemReqs,
+                                                           VkMemoryPropertyFlags                                 MemoryProperties,
+                                                           VkMemoryAllocateFlags                                 AllocateFlags  = 0,
+                                                           const VulkanUtilities::VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr)
+    {
+        return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags, pDedicatedInfo);
+    }
+    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(VkDeviceSize                                          Size,
+                                                           VkDeviceSize                                          Alignment,
+                                                           uint32_t                                              MemoryTypeIndex,
+                                                           VkMemoryAllocateFlags                                 AllocateFlags  = 0,
+                                                           const VulkanUtilities::VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr)
     {
         const auto& MemoryProps = m_PhysicalDevice->GetMemoryProperties();
         VERIFY_EXPR(MemoryTypeIndex < MemoryProps.memoryTypeCount);
         const auto MemoryFlags = MemoryProps.memoryTypes[MemoryTypeIndex].propertyFlags;
-        return m_MemoryMgr.Allocate(Size, Alignment, MemoryTypeIndex, (MemoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0, AllocateFlags);
+        return m_MemoryMgr.Allocate(Size, Alignment, MemoryTypeIndex, (MemoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0, AllocateFlags, pDedicatedInfo);
     }
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
+    VulkanUploadPagePool& GetUploadPagePool() { return m_UploadPagePool; }
+
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
     void FlushStaleResources(SoftwareQueueIndex CmdQueueIndex);
@@ -295,10 +381,13 @@ private:
     std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> m_PhysicalDevice;
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  m_LogicalVkDevice;
 
-    FramebufferCache       m_FramebufferCache;
-    RenderPassCache        m_ImplicitRenderPassCache;
-    DescriptorSetAllocator m_DescriptorSetAllocator;
-    DescriptorPoolManager  m_DynamicDescriptorPool;
+    FramebufferCache             m_FramebufferCache;
+    RenderPassCache              m_ImplicitRenderPassCache;
+    GraphicsPipelineLibraryCache m_GraphicsPipelineLibraryCache;
+    PersistentPipelineCache      m_PersistentPipelineCache;
+    PipelineLayoutCache          m_PipelineLayoutCache;
+    DescriptorSetAllocator       m_DescriptorSetAllocator;
+    DescriptorPoolManager        m_DynamicDescriptorPool;
 
     // These one-time command pools are used by buffer and texture constructors to
     // issue copy commands. Vulkan requires that every command pool is used by one thread
@@ -312,6 +401,13 @@ private:
 
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
 
+    // Upload heap pages released by the device contexts, see EngineVkCreateInfo::UploadPagePoolSize.
+    VulkanUploadPagePool m_UploadPagePool;
+
+    std::mutex                         m_RelocatableResourcesMtx;
+    std::unordered_set<BufferVkImpl*>  m_RelocatableBuffers;
+    std::unordered_set<TextureVkImpl*> m_RelocatableTextures;
+
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
 };
 
@@ -30,12 +30,12 @@
 /// \file
 /// Declaration of Diligent::RenderPassCache class
 
-#include <unordered_map>
 #include <mutex>
 
 #include "GraphicsTypes.h"
 #include "Constants.h"
 #include "HashUtils.hpp"
+#include "FlatHashMap.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "RefCntAutoPtr.hpp"
 
@@ -59,6 +59,36 @@ public:
 
     ~RenderPassCache();
 
+    // Load and store operations of the implicit render pass attachments.
+    // Render passes that only differ in load and store operations are compatible (8.2),
+    // so the same pipelines and framebuffers can be used with all of them.
+    struct AttachmentOps
+    {
+        ATTACHMENT_LOAD_OP  RTVLoadOps[MAX_RENDER_TARGETS] = {};
+        ATTACHMENT_LOAD_OP  DepthLoadOp                    = ATTACHMENT_LOAD_OP_LOAD;
+        ATTACHMENT_LOAD_OP  StencilLoadOp                  = ATTACHMENT_LOAD_OP_LOAD;
+        ATTACHMENT_STORE_OP DepthStencilStoreOp            = ATTACHMENT_STORE_OP_STORE;
+
+        // Resets the load operations, but keeps the store operation
+        void ResetLoadOps() noexcept
+        {
+            for (auto& LoadOp : RTVLoadOps)
+                LoadOp = ATTACHMENT_LOAD_OP_LOAD;
+            DepthLoadOp   = ATTACHMENT_LOAD_OP_LOAD;
+            StencilLoadOp = ATTACHMENT_LOAD_OP_LOAD;
+        }
+
+        bool IsDefault() const noexcept
+        {
+            for (auto LoadOp : RTVLoadOps)
+            {
+                if (LoadOp != ATTACHMENT_LOAD_OP_LOAD)
+                    return false;
+            }
+            return DepthLoadOp == ATTACHMENT_LOAD_OP_LOAD && StencilLoadOp == ATTACHMENT_LOAD_OP_LOAD && DepthStencilStoreOp == ATTACHMENT_STORE_OP_STORE;
+        }
+    };
+
     // This structure is used as the key to find framebuffer
     struct RenderPassCacheKey
     {
@@ -90,23 +120,38 @@ public:
         TEXTURE_FORMAT DSVFormat                      = TEX_FORMAT_UNKNOWN;
         TEXTURE_FORMAT RTVFormats[MAX_RENDER_TARGETS] = {};
 
+        // Load and store operations. The default operations preserve the attachment contents.
+        const AttachmentOps& GetOps() const noexcept { return Ops; }
+
+        void SetOps(const AttachmentOps& _Ops) noexcept
+        {
+            Ops  = _Ops;
+            Hash = 0;
+        }
+
         bool operator==(const RenderPassCacheKey& rhs) const noexcept
         {
             // clang-format off
-            if (GetHash()        != rhs.GetHash()        ||
-                NumRenderTargets != rhs.NumRenderTargets ||
-                SampleCount      != rhs.SampleCount      ||
-                EnableVRS        != rhs.EnableVRS        ||
-                DSVFormat        != rhs.DSVFormat        ||
-                ReadOnlyDSV      != rhs.ReadOnlyDSV)
+            if (GetHash()               != rhs.GetHash()               ||
+                NumRenderTargets        != rhs.NumRenderTargets        ||
+                SampleCount             != rhs.SampleCount             ||
+                EnableVRS               != rhs.EnableVRS               ||
+                DSVFormat               != rhs.DSVFormat               ||
+                ReadOnlyDSV             != rhs.ReadOnlyDSV             ||
+                Ops.DepthLoadOp         != rhs.Ops.DepthLoadOp         ||
+                Ops.StencilLoadOp       != rhs.Ops.StencilLoadOp       ||
+                Ops.DepthStencilStoreOp != rhs.Ops.DepthStencilStoreOp)
             {
                 return false;
             }
             // clang-format on
 
             for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
-                if (RTVFormats[rt] != rhs.RTVFormats[rt])
+            {
+                if (RTVFormats[rt] != rhs.RTVFormats[rt] ||
+                    Ops.RTVLoadOps[rt] != rhs.Ops.RTVLoadOps[rt])
                     return false;
+            }
 
             return true;
         }
@@ -115,14 +160,17 @@ public:
         {
             if (Hash == 0)
             {
-                Hash = ComputeHash(NumRenderTargets, SampleCount, DSVFormat, EnableVRS, ReadOnlyDSV);
+                Hash = ComputeHash(NumRenderTargets, SampleCount, DSVFormat, EnableVRS, ReadOnlyDSV,
+                                   Ops.DepthLoadOp, Ops.StencilLoadOp, Ops.DepthStencilStoreOp);
                 for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
-                    HashCombine(Hash, RTVFormats[rt]);
+                    HashCombine(Hash, RTVFormats[rt], Ops.RTVLoadOps[rt]);
             }
             return Hash;
         }
 
     private:
+        AttachmentOps Ops;
+
         mutable size_t Hash = 0;
     };
 
@@ -141,8 +189,8 @@ private:
 
     RenderDeviceVkImpl& m_DeviceVkImpl;
 
-    std::mutex                                                                                      m_Mutex;
-    std::unordered_map<RenderPassCacheKey, RefCntAutoPtr<RenderPassVkImpl>, RenderPassCacheKeyHash> m_Cache;
+    std::mutex                                                                               m_Mutex;
+    FlatHashMap<RenderPassCacheKey, RefCntAutoPtr<RenderPassVkImpl>, RenderPassCacheKeyHash> m_Cache;
 };
 
 } // namespace Diligent
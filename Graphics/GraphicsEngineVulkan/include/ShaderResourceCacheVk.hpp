@@ -52,6 +52,11 @@
 //
 // Descriptor set for static and mutable resources is assigned during cache initialization
 // Descriptor set for dynamic resources is assigned at every draw call
+//
+// When descriptor buffers are enabled (VK_EXT_descriptor_buffer), no Vulkan descriptor sets are allocated.
+// Instead, every descriptor set keeps the descriptor data in host memory that follows the resources.
+// The data is written when a resource is set and is copied to the context's dynamic heap when
+// the resources are committed.
 
 #include <vector>
 #include <memory>
@@ -68,6 +73,31 @@ namespace Diligent
 
 class DeviceContextVkImpl;
 
+// Layout of the descriptor set data in a descriptor buffer (VK_EXT_descriptor_buffer)
+struct DescriptorBufferSetLayoutVk
+{
+    struct Descriptor
+    {
+        // Offset of the descriptor from the start of the descriptor set data
+        Uint32 Offset = 0;
+
+        // Descriptor size, in bytes
+        Uint32 Size = 0;
+
+        // Immutable sampler that must be written to the descriptor, if any
+        VkSampler ImmutableSampler = VK_NULL_HANDLE;
+    };
+
+    // The total size of the descriptor set data, as returned by vkGetDescriptorSetLayoutSizeEXT
+    Uint32 DataSize = 0;
+
+    // Descriptors indexed by the resource cache offset
+    std::vector<Descriptor> Descriptors;
+
+    // Separate immutable samplers that are not stored in the resource cache
+    std::vector<Descriptor> ImmutableSamplers;
+};
+
 // sizeof(ShaderResourceCacheVk) == 24 (x64, msvc, Release)
 class ShaderResourceCacheVk : public ShaderResourceCacheBase
 {
@@ -88,11 +118,15 @@ public:
 
     ~ShaderResourceCacheVk();
 
-    static size_t GetRequiredMemorySize(Uint32 NumSets, const Uint32* SetSizes);
+    // pDescrBufferLayouts is an optional array of NumSets descriptor buffer set layouts.
+    static size_t GetRequiredMemorySize(Uint32 NumSets, const Uint32* SetSizes, const DescriptorBufferSetLayoutVk* pDescrBufferLayouts = nullptr);
 
-    void InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, const Uint32* SetSizes);
+    void InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, const Uint32* SetSizes, const DescriptorBufferSetLayoutVk* pDescrBufferLayouts = nullptr);
     void InitializeResources(Uint32 Set, Uint32 Offset, Uint32 ArraySize, DescriptorType Type, bool HasImmutableSampler);
 
+    // Writes immutable sampler descriptors to the descriptor buffer data of all sets.
+    void InitializeImmutableSamplerDescriptors(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice);
+
     // sizeof(Resource) == 32 (x64, msvc, Release)
     struct Resource
     {
@@ -140,14 +174,19 @@ public:
         explicit operator bool() const { return !IsNull(); }
     };
 
-    // sizeof(DescriptorSet) == 48 (x64, msvc, Release)
+    // sizeof(DescriptorSet) == 64 (x64, msvc, Release)
     class DescriptorSet
     {
     public:
         // clang-format off
-        DescriptorSet(Uint32 NumResources, Resource *pResources) :
-            m_NumResources  {NumResources},
-            m_pResources    {pResources  }
+        DescriptorSet(Uint32                             NumResources,
+                      Resource*                          pResources,
+                      const DescriptorBufferSetLayoutVk* pDescrBufferLayout = nullptr,
+                      Uint8*                             pDescriptorData    = nullptr) :
+            m_NumResources      {NumResources      },
+            m_pResources        {pResources        },
+            m_pDescrBufferLayout{pDescrBufferLayout},
+            m_pDescriptorData   {pDescriptorData   }
         {}
 
         DescriptorSet             (const DescriptorSet&) = delete;
@@ -169,12 +208,20 @@ public:
             return m_DescriptorSetAllocation.GetVkDescriptorSet();
         }
 
+        // Returns the size of the descriptor buffer data, or 0 if descriptor buffers are not used.
+        Uint32 GetDescriptorDataSize() const
+        {
+            return m_pDescrBufferLayout != nullptr ? m_pDescrBufferLayout->DataSize : 0;
+        }
+
     private:
         // clang-format off
-/* 0 */ const Uint32            m_NumResources = 0;
-/* 8 */ Resource* const         m_pResources   = nullptr;
-/*16 */ DescriptorSetAllocation m_DescriptorSetAllocation;
-/*48 */ // End of structure
+/* 0 */ const Uint32                             m_NumResources = 0;
+/* 8 */ Resource* const                          m_pResources   = nullptr;
+/*16 */ DescriptorSetAllocation                  m_DescriptorSetAllocation;
+/*48 */ const DescriptorBufferSetLayoutVk* const m_pDescrBufferLayout = nullptr;
+/*56 */ Uint8* const                             m_pDescriptorData    = nullptr;
+/*64 */ // End of structure
         // clang-format on
 
     private:
@@ -264,6 +311,13 @@ public:
                                                  std::vector<uint32_t>& Offsets,
                                                  Uint32                 StartInd) const;
 
+    // Copies the descriptor buffer data of the given set to pDstData and writes the descriptors
+    // of the buffers with dynamic offsets using their current addresses in the context.
+    void WriteDescriptorBufferData(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                   DeviceContextIndex                          CtxId,
+                                   Uint32                                      SetIndex,
+                                   Uint8*                                      pDstData) const;
+
 private:
     Resource* GetFirstResourcePtr()
     {
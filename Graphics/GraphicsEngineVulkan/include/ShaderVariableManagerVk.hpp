@@ -117,6 +117,9 @@ public:
 
     IObject& GetOwner() { return m_Owner; }
 
+    using TBase::GetSignature;
+    using TBase::GetResourceCache;
+
 private:
     friend TBase;
     friend ShaderVariableVkImpl;
@@ -67,6 +67,12 @@ public:
     /// Implementation of ISwapChain::SetWindowedMode() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetWindowedMode() override final;
 
+    /// Implementation of ISwapChain::SetMaximumFrameLatency() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetMaximumFrameLatency(Uint32 MaxLatency) override final;
+
+    /// Implementation of ISwapChain::WaitForNextFrame() in Vulkan backend.
+    virtual Bool DILIGENT_CALL_TYPE WaitForNextFrame(Uint32 Timeout) override final;
+
     /// Implementation of ISwapChainVk::GetVkSurface().
     virtual VkSurfaceKHR DILIGENT_CALL_TYPE GetVkSurface() override final { return m_VkSurface; }
 
@@ -90,6 +96,9 @@ private:
     VkResult AcquireNextImage(DeviceContextVkImpl* pDeviceCtxVk);
     void     RecreateVulkanSwapchain(DeviceContextVkImpl* pImmediateCtxVk);
     void     WaitForImageAcquiredFences();
+    void     CreateFrameCompleteFences();
+    bool     WaitForFrameCompleteFence(uint64_t Timeout);
+    void     WaitForFrameCompleteFences();
     void     ReleaseSwapChainResources(DeviceContextVkImpl* pImmediateCtxVk, bool DestroyVkSwapChain);
 
     const NativeWindow m_Window;
@@ -121,10 +130,17 @@ private:
     std::vector<bool, STDAllocatorRawMem<bool>> m_SwapChainImagesInitialized;
     std::vector<bool, STDAllocatorRawMem<bool>> m_ImageAcquiredFenceSubmitted;
 
+    // Fences that are signaled when the GPU completes the frames. The number
+    // of the fences is equal to the maximum frame latency.
+    std::vector<VulkanUtilities::FenceWrapper>  m_FrameCompleteFences;
+    std::vector<bool, STDAllocatorRawMem<bool>> m_FrameCompleteFenceSubmitted;
+
     RefCntAutoPtr<ITextureViewVk> m_pDepthBufferDSV;
 
     Uint32   m_SemaphoreIndex  = 0;
     uint32_t m_BackBufferIndex = 0;
+    Uint32   m_FrameFenceIndex = 0;
+    Uint32   m_MaxFrameLatency = 0;
     bool     m_IsMinimized     = false;
     bool     m_VSyncEnabled    = true;
 };
@@ -56,7 +56,14 @@ public:
     /// Implementation of ITextureViewVk::GetVulkanImageView().
     virtual VkImageView DILIGENT_CALL_TYPE GetVulkanImageView() const override final { return m_ImageView; }
 
+    // Replaces the image view after the texture has been moved to new memory by
+    // RenderDeviceVkImpl::DefragmentMemory(). Returns the old view that must be released by the caller.
+    VulkanUtilities::ImageViewWrapper ReplaceImageView(VulkanUtilities::ImageViewWrapper&& ImgView);
+
 protected:
+    // Returns true if the view may be used as a framebuffer attachment
+    bool IsAttachmentView() const;
+
     /// Vulkan image view descriptor handle
     VulkanUtilities::ImageViewWrapper m_ImageView;
 };
@@ -34,6 +34,7 @@
 #include "TextureBase.hpp"
 #include "TextureViewVkImpl.hpp"
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
+#include "VulkanUtilities/VulkanCommandBuffer.hpp"
 
 namespace Diligent
 {
@@ -76,6 +77,9 @@ public:
     /// Implementation of ITextureVk::GetLayout().
     virtual VkImageLayout DILIGENT_CALL_TYPE GetLayout() const override final;
 
+    /// Implementation of ITextureVk::ExportMemoryHandle().
+    virtual Bool DILIGENT_CALL_TYPE ExportMemoryHandle(ExternalMemoryHandleVk& Handle) const override final;
+
     VkBuffer GetVkStagingBuffer() const
     {
         return m_StagingBuffer;
@@ -98,6 +102,25 @@ public:
     // ("Copying Data Between Buffers and Images")
     static constexpr Uint32 StagingBufferOffsetAlignment = 16; // max texel size - 16 bytes (RGBA32F), max texel block size - 16 bytes.
 
+    // Returns true if the texture may be moved to new memory by RenderDeviceVkImpl::DefragmentMemory()
+    bool IsRelocatable() const;
+
+    const VulkanUtilities::VulkanMemoryAllocation& GetMemoryAllocation() const { return m_MemoryAllocation; }
+
+    // Vulkan objects that the texture used before it was relocated
+    struct RelocationData
+    {
+        VulkanUtilities::ImageWrapper                  Image;
+        VulkanUtilities::VulkanMemoryAllocation        Memory;
+        std::vector<VulkanUtilities::ImageViewWrapper> Views;
+    };
+
+    // Creates a new image in new memory, records the commands that copy the texture contents
+    // to it, and recreates the default views. The old objects are moved to OldResources and
+    // must be released after the command buffer has been submitted.
+    // Returns false if the texture could not be relocated.
+    bool Relocate(VulkanUtilities::VulkanCommandBuffer& CmdBuffer, RelocationData& OldResources) noexcept(false);
+
 protected:
     void CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) override;
 
@@ -146,16 +146,25 @@ public:
     Uint8*   GetCPUAddress()const{return m_CPUAddress;}
     // clang-format on
 
+    // Returns the device address of the dynamic buffer. The address is only
+    // available when descriptor buffers are enabled.
+    VkDeviceAddress GetVkDeviceAddress() const { return m_VkDeviceAddress; }
+
     void Destroy();
 
     static constexpr const Uint32 MasterBlockAlignment = 1024;
     MasterBlock                   AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment);
 
+    // Attempts to allocate a master block without waiting for the GPU to release
+    // stale blocks. Returns an invalid block if there is not enough free space.
+    MasterBlock TryAllocateMasterBlock(OffsetType SizeInBytes);
+
 private:
     RenderDeviceVkImpl&                  m_DeviceVk;
     VulkanUtilities::BufferWrapper       m_VkBuffer;
     VulkanUtilities::DeviceMemoryWrapper m_BufferMemory;
     Uint8*                               m_CPUAddress;
+    VkDeviceAddress                      m_VkDeviceAddress = 0;
     const VkDeviceSize                   m_DefaultAlignment;
     const Uint64                         m_CommandQueueMask;
     OffsetType                           m_TotalPeakSize = 0;
@@ -171,6 +180,12 @@ private:
 // The heap allocates master blocks from the global dynamic memory manager.
 // The pages are released and returned to the manager at the end of every frame.
 //
+// Allocating a master block requires locking the global manager, which is contended when
+// many deferred contexts map dynamic resources in parallel. To keep the number of locks
+// per frame low, the size of the first block requested in a frame is set to the amount of
+// memory the heap used during the previous frame, and every following block in the same
+// frame is twice as large as the previous one (up to 1/16 of the global heap).
+//
 //   _______________________________________________________________________________________________________________________________
 //  |                                                                                                                               |
 //  |                                                  VulkanDynamicHeap                                                            |
@@ -192,11 +207,7 @@ class VulkanDynamicHeap
 {
 public:
     // clang-format off
-    VulkanDynamicHeap(VulkanDynamicMemoryManager& DynamicMemMgr, std::string HeapName, Uint32 PageSize) :
-        m_GlobalDynamicMemMgr{DynamicMemMgr},
-        m_HeapName           {std::move(HeapName)},
-        m_MasterBlockSize    (PageSize)
-    {}
+    VulkanDynamicHeap(VulkanDynamicMemoryManager& DynamicMemMgr, std::string HeapName, Uint32 PageSize);
 
     VulkanDynamicHeap            (const VulkanDynamicHeap&) = delete;
     VulkanDynamicHeap            (VulkanDynamicHeap&&)      = delete;
@@ -230,8 +241,12 @@ private:
 
     OffsetType   m_CurrOffset = InvalidOffset;
     const Uint32 m_MasterBlockSize;
+    const Uint32 m_MaxMasterBlockSize;
     Uint32       m_AvailableSize = 0;
 
+    // The size of the next master block to request from the global manager
+    Uint32 m_NextMasterBlockSize;
+
     Uint32 m_CurrAlignedSize   = 0;
     Uint32 m_CurrUsedSize      = 0;
     Uint32 m_PeakAlignedSize   = 0;
@@ -28,6 +28,8 @@
 #pragma once
 
 #include <unordered_map>
+#include <map>
+#include <mutex>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 
@@ -37,8 +39,9 @@ namespace Diligent
 // Upload heap is used by a device context to update texture and buffer regions through
 // UpdateBufferRegion() and UpdateTextureRegion().
 //
-// The heap allocates pages from the global memory manager.
-// The pages are released and returned to the manager at the end of every frame.
+// The heap allocates pages from the upload page pool hosted by the render device.
+// The pages are released at the end of every frame and return to the pool when
+// the GPU is done with them.
 //
 //   _______________________________________________________________________________________________________________________________
 //  |                                                                                                                               |
@@ -49,16 +52,126 @@ namespace Diligent
 //  |__________|____________________________________________________________________________________________________________________|
 //             |                                      A                   |
 //             |                                      |                   |
-//             |Allocate()             CreateNewPage()|                   |ReleaseAllocatedPages()
+//             |Allocate()                 Allocate()|                   |ReleasePages()
 //             |                                ______|___________________V____
 //             V                               |                              |
-//   VulkanUploadAllocation                    |    Global Memory Manager     |
-//                                             |    (VulkanMemoryManager)     |
+//   VulkanUploadAllocation                    |       Upload page pool       |
+//                                             |    (VulkanUploadPagePool)    |
+//                                             |______________________________|
+//                                                    A                   |
+//                                                    |                   |CreatePage()
+//                                              ______|___________________V____
 //                                             |                              |
+//                                             |    Global Memory Manager     |
+//                                             |    (VulkanMemoryManager)     |
 //                                             |______________________________|
 //
 class RenderDeviceVkImpl;
 
+struct VulkanUploadPage
+{
+    VulkanUploadPage() noexcept {}
+
+    // clang-format off
+    VulkanUploadPage(VulkanUtilities::VulkanMemoryAllocation&& _MemAllocation,
+                     VulkanUtilities::BufferWrapper&&          _Buffer,
+                     Uint8*                                    _CPUAddress,
+                     VkDeviceSize                              _Size) noexcept :
+        MemAllocation{std::move(_MemAllocation)},
+        Buffer       {std::move(_Buffer)       },
+        CPUAddress   {_CPUAddress              },
+        Size         {_Size                    }
+    {
+    }
+
+    VulkanUploadPage             (const VulkanUploadPage&)  = delete;
+    VulkanUploadPage& operator = (const VulkanUploadPage&)  = delete;
+    VulkanUploadPage             (      VulkanUploadPage&&) = default;
+    VulkanUploadPage& operator = (      VulkanUploadPage&&) = default;
+    // clang-format on
+
+    VulkanUtilities::VulkanMemoryAllocation MemAllocation;
+    VulkanUtilities::BufferWrapper          Buffer;
+    Uint8*                                  CPUAddress = nullptr;
+
+    // Size of the buffer
+    VkDeviceSize Size = 0;
+
+    // Persistent page is never released to the memory manager, see EngineVkCreateInfo::PersistentUploadPageSize.
+    bool IsPersistent = false;
+};
+
+// Upload page pool keeps the pages released by the upload heaps so that they can be reused
+// without creating new buffers and allocating memory. Pages are grouped by size classes.
+// The pool is thread-safe.
+class VulkanUploadPagePool
+{
+public:
+    VulkanUploadPagePool(RenderDeviceVkImpl& RenderDevice,
+                         VkDeviceSize        MaxPoolSize,
+                         VkDeviceSize        PersistentPageSize);
+
+    // clang-format off
+    VulkanUploadPagePool            (const VulkanUploadPagePool&)  = delete;
+    VulkanUploadPagePool            (      VulkanUploadPagePool&&) = delete;
+    VulkanUploadPagePool& operator= (const VulkanUploadPagePool&)  = delete;
+    VulkanUploadPagePool& operator= (      VulkanUploadPagePool&&) = delete;
+    // clang-format on
+
+    ~VulkanUploadPagePool();
+
+    // Returns a page that is at least SizeInBytes large.
+    VulkanUploadPage Allocate(VkDeviceSize SizeInBytes);
+
+    // Moves the pages into the release queues. The pages return to the pool
+    // when all command queues in CmdQueueMask are done with them.
+    void ReleasePages(std::vector<VulkanUploadPage>& Pages, Uint64 CmdQueueMask);
+
+    // Immediately releases all pooled pages. Must be called when the GPU is idle.
+    void Destroy();
+
+    struct Statistics
+    {
+        // The number of Allocate() calls
+        Uint64 NumRequests = 0;
+
+        // The number of requests that were served by the pooled pages
+        Uint64 NumHits = 0;
+
+        // Total size of the pages created by the pool
+        VkDeviceSize CreatedSize = 0;
+
+        // The number and total size of the pages currently in the pool
+        Uint32       NumPooledPages = 0;
+        VkDeviceSize PooledSize     = 0;
+        VkDeviceSize PeakPooledSize = 0;
+    };
+    Statistics GetStatistics() const;
+
+    // Rounds the size up to one of the four size classes per power of two,
+    // which limits the wasted space to 25%.
+    static VkDeviceSize GetSizeClass(VkDeviceSize Size);
+
+private:
+    VulkanUploadPage CreatePage(VkDeviceSize SizeInBytes) const;
+
+    void Recycle(VulkanUploadPage&& Page);
+
+private:
+    RenderDeviceVkImpl& m_RenderDevice;
+    const VkDeviceSize  m_MaxPoolSize;
+    const VkDeviceSize  m_PersistentPageSize;
+
+    mutable std::mutex m_Mtx;
+
+    // Pooled pages sorted by size
+    std::multimap<VkDeviceSize, VulkanUploadPage> m_Pages;
+
+    bool m_PersistentPageCreated = false;
+
+    Statistics m_Stats;
+};
+
 struct VulkanUploadAllocation
 {
     VulkanUploadAllocation() noexcept {}
@@ -102,9 +215,9 @@ public:
 
     VulkanUploadAllocation Allocate(VkDeviceSize SizeInBytes, VkDeviceSize Alignment);
 
-    // Releases all allocated pages that are later returned to the global memory manager by the release queues.
-    // As global memory manager is hosted by the render device, the upload heap can be destroyed before the
-    // pages are actually returned to the manager.
+    // Releases all allocated pages that are later returned to the upload page pool by the release queues.
+    // As the pool is hosted by the render device, the upload heap can be destroyed before the
+    // pages are actually returned to the pool.
     void ReleaseAllocatedPages(Uint64 CmdQueueMask);
 
     size_t GetStalePagesCount() const
@@ -117,24 +230,7 @@ private:
     std::string         m_HeapName;
     const VkDeviceSize  m_PageSize;
 
-    struct UploadPageInfo
-    {
-        // clang-format off
-        UploadPageInfo(VulkanUtilities::VulkanMemoryAllocation&& _MemAllocation,
-                       VulkanUtilities::BufferWrapper&&          _Buffer,
-                       Uint8*                                    _CPUAddress) :
-            MemAllocation{std::move(_MemAllocation)},
-            Buffer       {std::move(_Buffer)       },
-            CPUAddress   {_CPUAddress              }
-        {
-        }
-        // clang-format on
-
-        VulkanUtilities::VulkanMemoryAllocation MemAllocation;
-        VulkanUtilities::BufferWrapper          Buffer;
-        Uint8* const                            CPUAddress = nullptr;
-    };
-    std::vector<UploadPageInfo> m_Pages;
+    std::vector<VulkanUploadPage> m_Pages;
 
     struct CurrPageInfo
     {
@@ -143,12 +239,12 @@ private:
         VkDeviceSize CurrOffset     = 0;
         VkDeviceSize AvailableSize  = 0;
 
-        void Reset(UploadPageInfo& NewPage, VkDeviceSize PageSize)
+        void Reset(VulkanUploadPage& NewPage)
         {
             vkBuffer       = NewPage.Buffer;
             CurrCPUAddress = NewPage.CPUAddress;
             CurrOffset     = 0;
-            AvailableSize  = PageSize;
+            AvailableSize  = NewPage.Size;
         }
 
         void Advance(VkDeviceSize SizeInBytes)
@@ -163,8 +259,6 @@ private:
     VkDeviceSize m_PeakFrameSize     = 0;
     VkDeviceSize m_CurrAllocatedSize = 0;
     VkDeviceSize m_PeakAllocatedSize = 0;
-
-    UploadPageInfo CreateNewPage(VkDeviceSize SizeInBytes) const;
 };
 
 } // namespace Diligent
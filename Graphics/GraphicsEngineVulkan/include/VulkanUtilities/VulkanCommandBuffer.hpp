@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <utility>
 #include "VulkanHeaders.h"
 #include "DebugUtilities.hpp"
 
@@ -51,7 +52,7 @@ public:
                                        const VkImageSubresourceRange& Subresource)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearColorImage() must be called outside of render pass (17.1)");
+        VERIFY(!IsInRenderPass(), "vkCmdClearColorImage() must be called outside of render pass (17.1)");
         VERIFY(Subresource.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT, "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_COLOR_BIT (17.1)");
 
         FlushBarriers();
@@ -69,7 +70,7 @@ public:
                                               const VkImageSubresourceRange&  Subresource)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearDepthStencilImage() must be called outside of render pass (17.1)");
+        VERIFY(!IsInRenderPass(), "vkCmdClearDepthStencilImage() must be called outside of render pass (17.1)");
         // clang-format off
         VERIFY((Subresource.aspectMask &  (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0 &&
                (Subresource.aspectMask & ~(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) == 0,
@@ -89,7 +90,7 @@ public:
     __forceinline void ClearAttachment(const VkClearAttachment& Attachment, const VkClearRect& ClearRect)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdClearAttachments() must be called inside render pass (17.2)");
+        VERIFY(IsInRenderPass(), "vkCmdClearAttachments() must be called inside render pass (17.2)");
 
         vkCmdClearAttachments(
             m_VkCmdBuffer,
@@ -104,7 +105,7 @@ public:
     __forceinline void Draw(uint32_t VertexCount, uint32_t InstanceCount, uint32_t FirstVertex, uint32_t FirstInstance)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDraw() must be called inside render pass (19.3)");
+        VERIFY(IsInRenderPass(), "vkCmdDraw() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDraw(m_VkCmdBuffer, VertexCount, InstanceCount, FirstVertex, FirstInstance);
@@ -113,7 +114,7 @@ public:
     __forceinline void DrawIndexed(uint32_t IndexCount, uint32_t InstanceCount, uint32_t FirstIndex, int32_t VertexOffset, uint32_t FirstInstance)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndexed() must be called inside render pass (19.3)");
+        VERIFY(IsInRenderPass(), "vkCmdDrawIndexed() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
@@ -123,7 +124,7 @@ public:
     __forceinline void DrawIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(IsInRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
@@ -132,7 +133,7 @@ public:
     __forceinline void DrawIndexedIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(IsInRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
@@ -143,7 +144,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirectCountKHR() must be called inside render pass (19.3)");
+        VERIFY(IsInRenderPass(), "vkCmdDrawIndirectCountKHR() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawIndirectCountKHR(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
@@ -156,7 +157,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(IsInRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
@@ -170,7 +171,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksEXT() must be called inside render pass");
+        VERIFY(IsInRenderPass(), "vkCmdDrawMeshTasksEXT() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksEXT(m_VkCmdBuffer, TaskCountX, TaskCountY, TaskCountZ);
@@ -183,7 +184,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksIndirectEXT() must be called inside render pass");
+        VERIFY(IsInRenderPass(), "vkCmdDrawMeshTasksIndirectEXT() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksIndirectEXT(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
@@ -196,7 +197,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksIndirectCountEXT() must be called inside render pass");
+        VERIFY(IsInRenderPass(), "vkCmdDrawMeshTasksIndirectCountEXT() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksIndirectCountEXT(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
@@ -212,7 +213,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDraw() must be called inside render pass (19.3)");
+        VERIFY(IsInRenderPass(), "vkCmdDraw() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMultiEXT(m_VkCmdBuffer, DrawCount, pVertexInfo, InstanceCount, FirstInstance, sizeof(VkMultiDrawInfoEXT));
@@ -228,7 +229,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndexed() must be called inside render pass (19.3)");
+        VERIFY(IsInRenderPass(), "vkCmdDrawIndexed() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
@@ -244,7 +245,7 @@ public:
     __forceinline void Dispatch(uint32_t GroupCountX, uint32_t GroupCountY, uint32_t GroupCountZ)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatch() must be called outside of render pass (27)");
+        VERIFY(!IsInRenderPass(), "vkCmdDispatch() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
         FlushBarriers();
@@ -254,7 +255,7 @@ public:
     __forceinline void DispatchIndirect(VkBuffer Buffer, VkDeviceSize Offset)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatchIndirect() must be called outside of render pass (27)");
+        VERIFY(!IsInRenderPass(), "vkCmdDispatchIndirect() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
         FlushBarriers();
@@ -266,10 +267,11 @@ public:
                                        uint32_t            FramebufferWidth,
                                        uint32_t            FramebufferHeight,
                                        uint32_t            ClearValueCount = 0,
-                                       const VkClearValue* pClearValues    = nullptr)
+                                       const VkClearValue* pClearValues    = nullptr,
+                                       VkSubpassContents   Contents        = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
+        VERIFY(!IsInRenderPass(), "Current pass has not been ended");
 
         if (m_State.RenderPass != RenderPass || m_State.Framebuffer != Framebuffer)
         {
@@ -290,11 +292,13 @@ public:
                                                       // corresponding to cleared attachments are used. Other elements of pClearValues are
                                                       // ignored (7.4)
 
-            vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo,
-                                 VK_SUBPASS_CONTENTS_INLINE // the contents of the subpass will be recorded inline in the
-                                                            // primary command buffer, and secondary command buffers must not
-                                                            // be executed within the subpass
-            );
+            // VK_SUBPASS_CONTENTS_INLINE - the contents of the subpass will be recorded inline in the
+            //                              primary command buffer, and secondary command buffers must not
+            //                              be executed within the subpass.
+            // VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS - the contents are recorded in secondary command
+            //                              buffers, and vkCmdExecuteCommands is the only valid command in the
+            //                              subpass until vkCmdNextSubpass or vkCmdEndRenderPass (8.4).
+            vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo, Contents);
             m_State.RenderPass        = RenderPass;
             m_State.Framebuffer       = Framebuffer;
             m_State.FramebufferWidth  = FramebufferWidth;
@@ -302,11 +306,62 @@ public:
         }
     }
 
+    // Makes the secondary command buffer continue the render pass instance that is
+    // started by the primary command buffer that executes it. No commands are recorded.
+    __forceinline void InheritRenderPass(VkRenderPass  RenderPass,
+                                         VkFramebuffer Framebuffer,
+                                         uint32_t      FramebufferWidth,
+                                         uint32_t      FramebufferHeight)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(!IsInRenderPass(), "Current pass has not been ended");
+
+        m_State.RenderPass          = RenderPass;
+        m_State.Framebuffer         = Framebuffer;
+        m_State.FramebufferWidth    = FramebufferWidth;
+        m_State.FramebufferHeight   = FramebufferHeight;
+        m_State.InheritedRenderPass = true;
+    }
+
+    // Starts a dynamic render pass instance (VK_KHR_dynamic_rendering).
+    // The instance is ended by EndRenderPass().
+    __forceinline void BeginRendering(const VkRenderingInfoKHR& RenderingInfo)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(!IsInRenderPass(), "Current pass has not been ended");
+
+        FlushBarriers();
+        vkCmdBeginRenderingKHR(m_VkCmdBuffer, &RenderingInfo);
+
+        m_State.DynamicRendering  = true;
+        m_State.FramebufferWidth  = RenderingInfo.renderArea.extent.width;
+        m_State.FramebufferHeight = RenderingInfo.renderArea.extent.height;
+#else
+        UNSUPPORTED("Dynamic rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void EndRenderPass()
     {
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
+        VERIFY(IsInRenderPass(), "Render pass has not been started");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        vkCmdEndRenderPass(m_VkCmdBuffer);
+        if (m_State.DynamicRendering)
+        {
+#if DILIGENT_USE_VOLK
+            vkCmdEndRenderingKHR(m_VkCmdBuffer);
+#endif
+            m_State.DynamicRendering = false;
+        }
+        else if (m_State.InheritedRenderPass)
+        {
+            // The render pass instance is ended by the primary command buffer
+            m_State.InheritedRenderPass = false;
+        }
+        else
+        {
+            vkCmdEndRenderPass(m_VkCmdBuffer);
+        }
         m_State.RenderPass        = VK_NULL_HANDLE;
         m_State.Framebuffer       = VK_NULL_HANDLE;
         m_State.FramebufferWidth  = 0;
@@ -320,17 +375,35 @@ public:
         }
     }
 
-    __forceinline void NextSubpass()
+    __forceinline void NextSubpass(VkSubpassContents Contents = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
+        VERIFY(!m_State.InheritedRenderPass, "Secondary command buffers can't advance the inherited render pass");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        vkCmdNextSubpass(m_VkCmdBuffer, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdNextSubpass(m_VkCmdBuffer, Contents);
+    }
+
+    __forceinline void ExecuteCommands(uint32_t CommandBufferCount, const VkCommandBuffer* pCommandBuffers)
+    {
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Secondary command buffers must be executed inside a render pass");
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdExecuteCommands(m_VkCmdBuffer, CommandBufferCount, pCommandBuffers);
+
+        // The state of the primary command buffer that is bound by commands is undefined
+        // after the secondary command buffers have been executed (6.7).
+        m_State.GraphicsPipeline        = VK_NULL_HANDLE;
+        m_State.ComputePipeline         = VK_NULL_HANDLE;
+        m_State.RayTracingPipeline      = VK_NULL_HANDLE;
+        m_State.IndexBuffer             = VK_NULL_HANDLE;
+        m_State.IndexBufferOffset       = 0;
+        m_State.IndexType               = VK_INDEX_TYPE_MAX_ENUM;
+        m_State.DescriptorBufferAddress = 0;
     }
 
     __forceinline void EndCommandBuffer()
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Render pass has not been ended");
+        VERIFY(!IsInRenderPass(), "Render pass has not been ended");
         FlushBarriers();
         vkEndCommandBuffer(m_VkCmdBuffer);
     }
@@ -400,6 +473,35 @@ public:
         vkCmdSetBlendConstants(m_VkCmdBuffer, BlendConstants);
     }
 
+    // Sets the rasterizer and depth-stencil states that are dynamic in pipelines
+    // created with VK_EXT_extended_dynamic_state. Topology is not set if it is VK_PRIMITIVE_TOPOLOGY_MAX_ENUM.
+    __forceinline void SetExtendedDynamicState(VkCullModeFlags                              CullMode,
+                                               VkFrontFace                                  FrontFace,
+                                               VkPrimitiveTopology                          Topology,
+                                               const VkPipelineDepthStencilStateCreateInfo& DSState)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetCullModeEXT(m_VkCmdBuffer, CullMode);
+        vkCmdSetFrontFaceEXT(m_VkCmdBuffer, FrontFace);
+        if (Topology != VK_PRIMITIVE_TOPOLOGY_MAX_ENUM)
+            vkCmdSetPrimitiveTopologyEXT(m_VkCmdBuffer, Topology);
+
+        vkCmdSetDepthTestEnableEXT(m_VkCmdBuffer, DSState.depthTestEnable);
+        vkCmdSetDepthWriteEnableEXT(m_VkCmdBuffer, DSState.depthWriteEnable);
+        vkCmdSetDepthCompareOpEXT(m_VkCmdBuffer, DSState.depthCompareOp);
+
+        vkCmdSetStencilTestEnableEXT(m_VkCmdBuffer, DSState.stencilTestEnable);
+        vkCmdSetStencilOpEXT(m_VkCmdBuffer, VK_STENCIL_FACE_FRONT_BIT, DSState.front.failOp, DSState.front.passOp, DSState.front.depthFailOp, DSState.front.compareOp);
+        vkCmdSetStencilOpEXT(m_VkCmdBuffer, VK_STENCIL_FACE_BACK_BIT, DSState.back.failOp, DSState.back.passOp, DSState.back.depthFailOp, DSState.back.compareOp);
+        // Front and back masks are always the same
+        vkCmdSetStencilCompareMask(m_VkCmdBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, DSState.front.compareMask);
+        vkCmdSetStencilWriteMask(m_VkCmdBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, DSState.front.writeMask);
+#else
+        UNSUPPORTED("Extended dynamic state is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void BindIndexBuffer(VkBuffer Buffer, VkDeviceSize Offset, VkIndexType IndexType)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
@@ -446,13 +548,63 @@ public:
         vkCmdBindDescriptorSets(m_VkCmdBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
     }
 
+    __forceinline void PushDescriptorSet(VkPipelineBindPoint         pipelineBindPoint,
+                                         VkPipelineLayout            layout,
+                                         uint32_t                    set,
+                                         uint32_t                    descriptorWriteCount,
+                                         const VkWriteDescriptorSet* pDescriptorWrites)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdPushDescriptorSetKHR(m_VkCmdBuffer, pipelineBindPoint, layout, set, descriptorWriteCount, pDescriptorWrites);
+#else
+        UNSUPPORTED("Push descriptors are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void BindDescriptorBuffer(VkDeviceAddress Address, VkBufferUsageFlags Usage)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR(Address != 0);
+        if (m_State.DescriptorBufferAddress != Address)
+        {
+            VkDescriptorBufferBindingInfoEXT BindingInfo{};
+            BindingInfo.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+            BindingInfo.pNext   = nullptr;
+            BindingInfo.address = Address;
+            BindingInfo.usage   = Usage;
+            vkCmdBindDescriptorBuffersEXT(m_VkCmdBuffer, 1, &BindingInfo);
+            m_State.DescriptorBufferAddress = Address;
+        }
+#else
+        UNSUPPORTED("Descriptor buffers are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void SetDescriptorBufferOffsets(VkPipelineBindPoint pipelineBindPoint,
+                                                  VkPipelineLayout    layout,
+                                                  uint32_t            firstSet,
+                                                  uint32_t            setCount,
+                                                  const uint32_t*     pBufferIndices,
+                                                  const VkDeviceSize* pOffsets)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.DescriptorBufferAddress != 0, "No descriptor buffer is bound");
+        vkCmdSetDescriptorBufferOffsetsEXT(m_VkCmdBuffer, pipelineBindPoint, layout, firstSet, setCount, pBufferIndices, pOffsets);
+#else
+        UNSUPPORTED("Descriptor buffers are not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void CopyBuffer(VkBuffer            srcBuffer,
                                   VkBuffer            dstBuffer,
                                   uint32_t            regionCount,
                                   const VkBufferCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Copy buffer operation must be performed outside of render pass.
             EndRenderPass();
@@ -469,7 +621,7 @@ public:
                                  const VkImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -485,7 +637,7 @@ public:
                                          const VkBufferImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -501,7 +653,7 @@ public:
                                          const VkBufferImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -519,7 +671,7 @@ public:
                                  VkFilter           filter)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Blit must be performed outside of render pass.
             EndRenderPass();
@@ -536,7 +688,7 @@ public:
                                     const VkImageResolve* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Resolve must be performed outside of render pass.
             EndRenderPass();
@@ -566,7 +718,7 @@ public:
 
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         vkCmdBeginQuery(m_VkCmdBuffer, queryPool, query, flags);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
             m_State.InsidePassQueries |= queryFlag;
         else
             m_State.OutsidePassQueries |= queryFlag;
@@ -578,7 +730,7 @@ public:
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         vkCmdEndQuery(m_VkCmdBuffer, queryPool, query);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             VERIFY((m_State.InsidePassQueries & queryFlag) != 0, "No active inside-pass queries found.");
             m_State.InsidePassQueries &= ~queryFlag;
@@ -603,7 +755,7 @@ public:
                                       uint32_t    queryCount)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Query pool reset must be performed outside of render pass (17.2).
             EndRenderPass();
@@ -621,7 +773,7 @@ public:
                                             VkQueryResultFlags flags)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Copy query results must be performed outside of render pass (17.2).
             EndRenderPass();
@@ -631,13 +783,42 @@ public:
                                   dstBuffer, dstOffset, stride, flags);
     }
 
+    __forceinline void BeginConditionalRendering(VkBuffer Buffer, VkDeviceSize Offset, VkConditionalRenderingFlagsEXT Flags)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        // The predicate must be visible to the conditional rendering stage
+        FlushBarriers();
+
+        VkConditionalRenderingBeginInfoEXT BeginInfo{};
+        BeginInfo.sType  = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
+        BeginInfo.pNext  = nullptr;
+        BeginInfo.buffer = Buffer;
+        BeginInfo.offset = Offset;
+        BeginInfo.flags  = Flags;
+        vkCmdBeginConditionalRenderingEXT(m_VkCmdBuffer, &BeginInfo);
+#else
+        UNSUPPORTED("Conditional rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void EndConditionalRendering()
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdEndConditionalRenderingEXT(m_VkCmdBuffer);
+#else
+        UNSUPPORTED("Conditional rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void BuildAccelerationStructure(uint32_t                                               infoCount,
                                                   const VkAccelerationStructureBuildGeometryInfoKHR*     pInfos,
                                                   const VkAccelerationStructureBuildRangeInfoKHR* const* ppBuildRangeInfos)
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Build AS operations must be performed outside of render pass.
             EndRenderPass();
@@ -653,7 +834,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Copy AS operations must be performed outside of render pass.
             EndRenderPass();
@@ -669,7 +850,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             // Write AS properties operations must be performed outside of render pass.
             EndRenderPass();
@@ -692,7 +873,7 @@ public:
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RayTracingPipeline != VK_NULL_HANDLE, "No ray tracing pipeline bound");
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             EndRenderPass();
         }
@@ -712,7 +893,7 @@ public:
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
         VERIFY(m_State.RayTracingPipeline != VK_NULL_HANDLE, "No ray tracing pipeline bound");
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInRenderPass())
         {
             EndRenderPass();
         }
@@ -776,14 +957,24 @@ public:
 
     void FlushBarriers();
 
-    __forceinline void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer, VkPipelineStageFlags StageMask, VkAccessFlags AccessMask)
+    // If UseSynchronization2 is true, barriers are recorded with vkCmdPipelineBarrier2KHR,
+    // which allows every image barrier to use its own stage masks.
+    __forceinline void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer, VkPipelineStageFlags StageMask, VkAccessFlags AccessMask, bool UseSynchronization2 = false)
     {
         m_VkCmdBuffer                 = VkCmdBuffer;
         m_Barrier.SupportedStagesMask = StageMask;
         m_Barrier.SupportedAccessMask = AccessMask;
+#if DILIGENT_USE_VOLK
+        m_UseSynchronization2 = UseSynchronization2;
+#else
+        VERIFY(!UseSynchronization2, "Synchronization2 is not supported when vulkan library is linked statically");
+#endif
     }
     VkCommandBuffer GetVkCmdBuffer() const { return m_VkCmdBuffer; }
 
+    // Returns the number of image and memory barriers recorded since the last call to this method
+    uint32_t ExtractNumBarriers() { return std::exchange(m_NumBarriers, 0u); }
+
     VkPipelineStageFlags GetSupportedStagesMask() const { return m_Barrier.SupportedStagesMask; }
     VkAccessFlags        GetSupportedAccessMask() const { return m_Barrier.SupportedAccessMask; }
 
@@ -801,10 +992,19 @@ public:
         uint32_t      FramebufferHeight  = 0;
         uint32_t      InsidePassQueries  = 0;
         uint32_t      OutsidePassQueries = 0;
+        bool          DynamicRendering   = false; // Whether a dynamic render pass instance is active
+
+        // Whether the render pass instance is inherited by a secondary command buffer
+        bool InheritedRenderPass = false;
+
+        VkDeviceAddress DescriptorBufferAddress = 0;
     };
 
     const StateCache& GetState() const { return m_State; }
 
+    // Returns true if either a render pass or a dynamic render pass instance is active
+    bool IsInRenderPass() const { return m_State.RenderPass != VK_NULL_HANDLE || m_State.DynamicRendering; }
+
 private:
     struct PipelineBarrier
     {
@@ -824,7 +1024,14 @@ private:
     StateCache      m_State;
     PipelineBarrier m_Barrier;
 
-    std::vector<VkImageMemoryBarrier> m_ImageBarriers;
+    // Image barriers are stored with their own stage masks. The legacy path combines
+    // the stages of all barriers and converts them to VkImageMemoryBarrier.
+    std::vector<VkImageMemoryBarrier2KHR> m_ImageBarriers;
+    std::vector<VkImageMemoryBarrier>     m_LegacyImageBarriers;
+
+    bool m_UseSynchronization2 = false;
+
+    uint32_t m_NumBarriers = 0;
 };
 
 } // namespace VulkanUtilities
@@ -27,7 +27,8 @@
 
 #pragma once
 
-#include <deque>
+#include <array>
+#include <vector>
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -54,9 +55,15 @@ public:
 
     ~VulkanCommandBufferPool();
 
-    VkCommandBuffer GetCommandBuffer(const char* DebugName = "");
-    // The GPU must have finished with the command buffer being returned to the pool
-    void RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer);
+    // Must only be called by the thread that owns the pool (i.e. the thread recording
+    // commands into the device context). Does not take the lock unless the local free
+    // list is exhausted and there are buffers returned by the release queue.
+    // If pInheritanceInfo is not null, a secondary command buffer is returned that
+    // continues the render pass specified by the inheritance info.
+    VkCommandBuffer GetCommandBuffer(const char* DebugName = "", const VkCommandBufferInheritanceInfo* pInheritanceInfo = nullptr);
+    // The GPU must have finished with the command buffer being returned to the pool.
+    // May be called from any thread (typically, from the thread releasing stale resources).
+    void RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer, VkCommandBufferLevel Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
     VkPipelineStageFlags GetSupportedStagesMask() const { return m_SupportedStagesMask; }
     VkAccessFlags        GetSupportedAccessMask() const { return m_SupportedAccessMask; }
@@ -67,10 +74,20 @@ private:
 
     CommandPoolWrapper m_CmdPool;
 
-    std::mutex                  m_Mutex;
-    std::deque<VkCommandBuffer> m_CmdBuffers;
-    const VkPipelineStageFlags  m_SupportedStagesMask;
-    const VkAccessFlags         m_SupportedAccessMask;
+    // Primary and secondary command buffers are kept in separate lists indexed by VkCommandBufferLevel
+    static constexpr size_t NumLevels = 2;
+
+    // Free command buffers that are only accessed by the owning thread
+    std::array<std::vector<VkCommandBuffer>, NumLevels> m_CmdBuffers;
+
+    // Command buffers returned by the release queue. They are moved to m_CmdBuffers
+    // in one batch when the owning thread runs out of free buffers.
+    std::mutex                                          m_RecycledBuffersMtx;
+    std::array<std::vector<VkCommandBuffer>, NumLevels> m_RecycledBuffers;
+    std::atomic<size_t>                                 m_NumRecycledBuffers[NumLevels] = {};
+
+    const VkPipelineStageFlags m_SupportedStagesMask;
+    const VkAccessFlags        m_SupportedAccessMask;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<int32_t> m_BuffCounter{0};
@@ -54,6 +54,7 @@ public:
         bool               EnableValidation       = false;
         bool               EnableDeviceSimulation = false;
         bool               LogExtensions          = false;
+        bool               DeferGlslangInit       = false;
         uint32_t           EnabledLayerCount      = 0;
         const char* const* ppEnabledLayerNames    = nullptr;
         uint32_t           ExtensionCount         = 0;
@@ -99,6 +100,9 @@ public:
 
     const std::vector<VkPhysicalDevice>& GetVkPhysicalDevices() const { return m_PhysicalDevices; }
 
+    // Returns the number of physical devices in the device group that contains the given device
+    uint32_t GetPhysicalDeviceGroupSize(VkPhysicalDevice vkDevice) const;
+
 private:
     explicit VulkanInstance(const CreateInfo& CI);
 
@@ -118,6 +122,8 @@ private:
     std::vector<VkExtensionProperties> m_Extensions;
     std::vector<const char*>           m_EnabledExtensions;
     std::vector<VkPhysicalDevice>      m_PhysicalDevices;
+
+    std::vector<VkPhysicalDeviceGroupProperties> m_PhysicalDeviceGroups;
 };
 
 } // namespace VulkanUtilities
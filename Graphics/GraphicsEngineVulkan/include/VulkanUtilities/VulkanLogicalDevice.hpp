@@ -142,6 +142,8 @@ public:
     RenderPassWrapper   CreateRenderPass    (const VkRenderPassCreateInfo2& RenderPassCI,const char* DebugName = "") const;
     DeviceMemoryWrapper AllocateDeviceMemory(const VkMemoryAllocateInfo &   AllocInfo,   const char* DebugName = "") const;
 
+    // Compute and graphics pipeline functions return an empty wrapper if the pipeline is created with
+    // VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT flag and is not found in the cache.
     PipelineWrapper     CreateComputePipeline   (const VkComputePipelineCreateInfo&       PipelineCI, VkPipelineCache cache, const char* DebugName = "") const;
     PipelineWrapper     CreateGraphicsPipeline  (const VkGraphicsPipelineCreateInfo&      PipelineCI, VkPipelineCache cache, const char* DebugName = "") const;
     PipelineWrapper     CreateRayTracingPipeline(const VkRayTracingPipelineCreateInfoKHR& PipelineCI, VkPipelineCache cache, const char* DebugName = "") const;
@@ -153,7 +155,7 @@ public:
     DescriptorSetLayoutWrapper CreateDescriptorSetLayout(const VkDescriptorSetLayoutCreateInfo& LayoutCI,       const char* DebugName = "") const;
 
     SemaphoreWrapper    CreateSemaphore(const VkSemaphoreCreateInfo& SemaphoreCI, const char* DebugName = "") const;
-    SemaphoreWrapper    CreateTimelineSemaphore(uint64_t InitialValue, const char* DebugName = "") const;
+    SemaphoreWrapper    CreateTimelineSemaphore(uint64_t InitialValue, const char* DebugName = "", bool Exportable = false) const;
     QueryPoolWrapper    CreateQueryPool(const VkQueryPoolCreateInfo& QueryPoolCI, const char* DebugName = "") const;
     AccelStructWrapper  CreateAccelStruct(const VkAccelerationStructureCreateInfoKHR& CI, const char* DebugName = "") const;
 
@@ -187,7 +189,11 @@ public:
 
     VkMemoryRequirements GetBufferMemoryRequirements(VkBuffer vkBuffer) const;
     VkMemoryRequirements GetImageMemoryRequirements (VkImage  vkImage ) const;
+    // If VK_KHR_dedicated_allocation is not enabled, PrefersDedicated is always false
+    VkMemoryRequirements GetBufferMemoryRequirements(VkBuffer vkBuffer, bool& PrefersDedicated) const;
+    VkMemoryRequirements GetImageMemoryRequirements (VkImage  vkImage,  bool& PrefersDedicated) const;
     VkDeviceAddress      GetAccelerationStructureDeviceAddress(VkAccelerationStructureKHR AS) const;
+    VkDeviceAddress      GetBufferDeviceAddress(VkBuffer vkBuffer) const;
 
     VkResult BindBufferMemory(VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) const;
     VkResult BindImageMemory (VkImage image,   VkDeviceMemory memory, VkDeviceSize memoryOffset) const;
@@ -215,6 +221,10 @@ public:
                               uint32_t                    descriptorCopyCount,
                               const VkCopyDescriptorSet*  pDescriptorCopies) const;
 
+    VkDeviceSize GetDescriptorSetLayoutSize(VkDescriptorSetLayout Layout) const;
+    VkDeviceSize GetDescriptorSetLayoutBindingOffset(VkDescriptorSetLayout Layout, uint32_t Binding) const;
+    void         GetDescriptor(const VkDescriptorGetInfoEXT& DescriptorInfo, size_t DataSize, void* pDescriptor) const;
+
     VkResult ResetCommandPool(VkCommandPool           vkCmdPool,
                               VkCommandPoolResetFlags flags = 0) const;
 
@@ -241,12 +251,29 @@ public:
 
     VkResult GetRayTracingShaderGroupHandles(VkPipeline pipeline, uint32_t firstGroup, uint32_t groupCount, size_t dataSize, void* pData) const;
 
+    // Queries the identifier of the shader module with vkGetShaderModuleIdentifierEXT (VK_EXT_shader_module_identifier).
+    void GetShaderModuleIdentifier(VkShaderModule vkModule, VkShaderModuleIdentifierEXT& Identifier) const;
+
+    // Samples calibrated timestamps with vkGetCalibratedTimestampsEXT (VK_EXT_calibrated_timestamps).
+    VkResult GetCalibratedTimestamps(uint32_t                            TimestampCount,
+                                     const VkCalibratedTimestampInfoEXT* pTimestampInfos,
+                                     uint64_t*                           pTimestamps,
+                                     uint64_t*                           pMaxDeviation) const;
+
+    // Exports a memory object or a semaphore as a platform handle of type VulkanPhysicalDevice::ExternalMemoryHandleType
+    // or VulkanPhysicalDevice::ExternalSemaphoreHandleType (a file descriptor or an NT handle).
+    VkResult GetMemoryHandle(VkDeviceMemory vkMemory, uint64_t& Handle) const;
+    VkResult GetSemaphoreHandle(VkSemaphore vkSemaphore, uint64_t& Handle) const;
+
     VkPipelineStageFlags GetSupportedStagesMask(HardwareQueueIndex QueueFamilyIndex) const { return m_SupportedStagesMask[QueueFamilyIndex]; }
     VkAccessFlags        GetSupportedAccessMask(HardwareQueueIndex QueueFamilyIndex) const { return m_SupportedAccessMask[QueueFamilyIndex]; }
 
     const VkPhysicalDeviceFeatures& GetEnabledFeatures() const { return m_EnabledFeatures; }
     const ExtensionFeatures&        GetEnabledExtFeatures() const { return m_EnabledExtFeatures; }
 
+    // The number of nanoseconds required for a timestamp query to be incremented by 1
+    float GetTimestampPeriod() const { return m_TimestampPeriod; }
+
 private:
     VulkanLogicalDevice(const CreateInfo& CI);
 
@@ -263,6 +290,7 @@ private:
     const VkAllocationCallbacks* const m_VkAllocator;
     const VkPhysicalDeviceFeatures     m_EnabledFeatures;
     ExtensionFeatures                  m_EnabledExtFeatures = {};
+    const float                        m_TimestampPeriod;
     std::vector<VkPipelineStageFlags>  m_SupportedStagesMask;
     std::vector<VkAccessFlags>         m_SupportedAccessMask;
 };
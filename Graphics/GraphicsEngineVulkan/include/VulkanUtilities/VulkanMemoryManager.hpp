@@ -30,10 +30,17 @@
 #include <mutex>
 #include <array>
 #include <unordered_map>
+#include <list>
+#include <vector>
 #include <atomic>
 #include <string>
+#include <functional>
 #include "MemoryAllocator.h"
-#include "VariableSizeAllocationsManager.hpp"
+#if DILIGENT_USE_TLSF_ALLOCATIONS_MANAGER
+#    include "TLSFAllocationsManager.hpp"
+#else
+#    include "VariableSizeAllocationsManager.hpp"
+#endif
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
@@ -45,6 +52,53 @@ namespace VulkanUtilities
 class VulkanMemoryPage;
 class VulkanMemoryManager;
 
+// Describes the resource that memory is allocated for, see VulkanMemoryManager::Allocate().
+struct VulkanDedicatedAllocationInfo
+{
+    // At most one of the handles may be set. If VK_KHR_dedicated_allocation is enabled
+    // and the resource gets its own page, the memory is allocated for this resource only.
+    VkImage  Image  = VK_NULL_HANDLE;
+    VkBuffer Buffer = VK_NULL_HANDLE;
+
+    // Whether the driver prefers or requires a dedicated allocation for the resource
+    // (see VkMemoryDedicatedRequirements).
+    bool PrefersDedicated = false;
+
+    // Handle types the memory must be exportable as (see VkExportMemoryAllocateInfo).
+    // Exportable memory is always allocated in its own page.
+    VkExternalMemoryHandleTypeFlags ExportHandleTypes = 0;
+};
+
+// Allocation policy of VulkanMemoryManager
+struct VulkanMemoryAllocationPolicy
+{
+    // Allocations that are at least this large get their own page, so that they do not
+    // fragment the shared pages. 0 disables dedicated pages for large allocations.
+    VkDeviceSize DedicatedAllocationThreshold = 0;
+
+    // Allocations up to this size are rounded up to a power-of-two size class, and each
+    // size class is suballocated from its own pages. 0 disables size classes.
+    VkDeviceSize SmallAllocationMaxSize = 0;
+
+    // Page size of the small allocation size classes
+    VkDeviceSize SmallAllocationPageSize = 0;
+
+    // Page size for every memory type. 0 means that the default device-local or host-visible
+    // page size is used.
+    std::array<VkDeviceSize, VK_MAX_MEMORY_TYPES> MemoryTypePageSize = {};
+};
+
+// Fragmentation statistics of the memory pages, see VulkanMemoryManager::GetFragmentationStats().
+struct VulkanMemoryFragmentationStats
+{
+    size_t       PageCount          = 0; // Total number of pages, including dedicated pages
+    size_t       DedicatedPageCount = 0; // Number of pages that hold a single allocation
+    size_t       FreeBlockCount     = 0; // Total number of free blocks in all shared pages
+    VkDeviceSize AllocatedSize      = 0; // Total size of all pages
+    VkDeviceSize UsedSize           = 0; // Total size of all allocations
+    VkDeviceSize MaxFreeBlockSize   = 0; // Size of the largest free block in all shared pages
+};
+
 struct VulkanMemoryAllocation
 {
     VulkanMemoryAllocation() noexcept {}
@@ -104,11 +158,13 @@ struct VulkanMemoryAllocation
 class VulkanMemoryPage
 {
 public:
-    VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
-                     VkDeviceSize          PageSize,
-                     uint32_t              MemoryTypeIndex,
-                     bool                  IsHostVisible,
-                     VkMemoryAllocateFlags AllocateFlags);
+    // If pDedicatedInfo is not null, the page holds a single allocation of the given resource
+    VulkanMemoryPage(VulkanMemoryManager&                 ParentMemoryMgr,
+                     VkDeviceSize                         PageSize,
+                     uint32_t                             MemoryTypeIndex,
+                     bool                                 IsHostVisible,
+                     VkMemoryAllocateFlags                AllocateFlags,
+                     const VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr);
     ~VulkanMemoryPage();
 
     // clang-format off
@@ -116,7 +172,10 @@ public:
         m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
         m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
         m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
+        m_CPUMemory       {rhs.m_CPUMemory               },
+        m_MemoryTypeIndex {rhs.m_MemoryTypeIndex         },
+        m_IsDedicated     {rhs.m_IsDedicated             },
+        m_IsEvacuating    {rhs.m_IsEvacuating            }
     {
         rhs.m_CPUMemory = nullptr;
     }
@@ -129,6 +188,13 @@ public:
     bool IsFull()  const { return m_AllocationMgr.IsFull();  }
     VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
     VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
+    bool         IsDedicated() const { return m_IsDedicated; }
+    bool         IsEvacuating() const { return m_IsEvacuating; }
+    uint32_t     GetMemoryTypeIndex() const { return m_MemoryTypeIndex; }
+
+    // Fragmentation statistics
+    size_t       GetNumFreeBlocks()    { std::lock_guard<std::mutex> Lock{m_Mutex}; return m_AllocationMgr.GetNumFreeBlocks();    }
+    VkDeviceSize GetMaxFreeBlockSize() { std::lock_guard<std::mutex> Lock{m_Mutex}; return m_AllocationMgr.GetMaxFreeBlockSize(); }
 
     // clang-format on
 
@@ -138,32 +204,44 @@ public:
     void*          GetCPUMemory() const { return m_CPUMemory; }
 
 private:
-    using AllocationsMgrOffsetType = Diligent::VariableSizeAllocationsManager::OffsetType;
+#if DILIGENT_USE_TLSF_ALLOCATIONS_MANAGER
+    using AllocationsMgrType = Diligent::TLSFAllocationsManager;
+#else
+    using AllocationsMgrType = Diligent::VariableSizeAllocationsManager;
+#endif
+    using AllocationsMgrOffsetType = AllocationsMgrType::OffsetType;
 
     friend struct VulkanMemoryAllocation;
+    friend class VulkanMemoryManager;
 
     // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
     void Free(VulkanMemoryAllocation&& Allocation);
 
-    VulkanMemoryManager&                     m_ParentMemoryMgr;
-    std::mutex                               m_Mutex;
-    Diligent::VariableSizeAllocationsManager m_AllocationMgr;
-    VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
-    void*                                    m_CPUMemory = nullptr;
+    VulkanMemoryManager&                 m_ParentMemoryMgr;
+    std::mutex                           m_Mutex;
+    AllocationsMgrType                   m_AllocationMgr;
+    VulkanUtilities::DeviceMemoryWrapper m_VkMemory;
+    void*                                m_CPUMemory       = nullptr;
+    uint32_t                             m_MemoryTypeIndex = 0;
+    bool                                 m_IsDedicated     = false;
+    // No new allocations are made from the page while its resources are being relocated.
+    // Protected by the parent manager's m_PagesMtx.
+    bool m_IsEvacuating = false;
 };
 
 class VulkanMemoryManager
 {
 public:
     // clang-format off
-	VulkanMemoryManager(std::string                  MgrName,
-                        const VulkanLogicalDevice&   LogicalDevice,
-                        const VulkanPhysicalDevice&  PhysicalDevice,
-                        Diligent::IMemoryAllocator&  Allocator,
-                        VkDeviceSize                 DeviceLocalPageSize,
-                        VkDeviceSize                 HostVisiblePageSize,
-                        VkDeviceSize                 DeviceLocalReserveSize,
-                        VkDeviceSize                 HostVisibleReserveSize) :
+	VulkanMemoryManager(std::string                         MgrName,
+                        const VulkanLogicalDevice&          LogicalDevice,
+                        const VulkanPhysicalDevice&         PhysicalDevice,
+                        Diligent::IMemoryAllocator&         Allocator,
+                        VkDeviceSize                        DeviceLocalPageSize,
+                        VkDeviceSize                        HostVisiblePageSize,
+                        VkDeviceSize                        DeviceLocalReserveSize,
+                        VkDeviceSize                        HostVisibleReserveSize,
+                        const VulkanMemoryAllocationPolicy& Policy = {}) :
         m_MgrName               {std::move(MgrName)    },
         m_LogicalDevice         {LogicalDevice         },
         m_PhysicalDevice        {PhysicalDevice        },
@@ -171,7 +249,8 @@ public:
         m_DeviceLocalPageSize   {DeviceLocalPageSize   },
         m_HostVisiblePageSize   {HostVisiblePageSize   },
         m_DeviceLocalReserveSize{DeviceLocalReserveSize},
-        m_HostVisibleReserveSize{HostVisibleReserveSize}
+        m_HostVisibleReserveSize{HostVisibleReserveSize},
+        m_Policy                {Policy                }
     {}
 
 
@@ -189,15 +268,25 @@ public:
         m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
         m_DeviceLocalReserveSize {rhs.m_DeviceLocalReserveSize},
         m_HostVisibleReserveSize {rhs.m_HostVisibleReserveSize},
+        m_Policy                 {rhs.m_Policy                },
+        m_DedicatedPages         {std::move(rhs.m_DedicatedPages)},
 
         //m_CurrUsedSize      {rhs.m_CurrUsedSize},
         m_PeakUsedSize      {rhs.m_PeakUsedSize     },
         m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
+        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize},
+
+        m_BudgetCallback    {std::move(rhs.m_BudgetCallback)},
+        m_BudgetThreshold   {rhs.m_BudgetThreshold          },
+        m_HeapOverThreshold {rhs.m_HeapOverThreshold        },
+
+        m_HasEvacuatingPages{rhs.m_HasEvacuatingPages}
     {
         // clang-format on
         for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
             m_CurrUsedSize[i].store(rhs.m_CurrUsedSize[i].load());
+        for (size_t i = 0; i < m_HeapAllocatedSize.size(); ++i)
+            m_HeapAllocatedSize[i].store(rhs.m_HeapAllocatedSize[i].load());
     }
 
     ~VulkanMemoryManager();
@@ -208,13 +297,49 @@ public:
     VulkanMemoryManager& operator= (VulkanMemoryManager&&)      = delete;
     // clang-format on
 
-    VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags);
-    VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags);
+    // pDedicatedInfo describes the resource the memory is allocated for. It is used to decide if
+    // the allocation gets its own page (see VulkanMemoryAllocationPolicy::DedicatedAllocationThreshold).
+    VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr);
+    VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedAllocationInfo* pDedicatedInfo = nullptr);
     void                   ShrinkMemory();
 
+    VulkanMemoryFragmentationStats GetFragmentationStats();
+
+    // Selects device-local pages whose used size is less than Threshold * page size, starting
+    // from the least used one, until the total used size of the selected pages exceeds MaxBytes.
+    // No new allocations are made from the selected pages; the pages are released by ShrinkMemory()
+    // once all their allocations are freed.
+    std::vector<VulkanMemoryPage*> BeginDefragmentation(float Threshold, VkDeviceSize MaxBytes);
+
+    // Makes the pages that could not be fully evacuated available for allocations again.
+    // The pages are only used for lookup and may have been destroyed.
+    void CancelDefragmentation(const std::vector<VulkanMemoryPage*>& Pages);
+
+    // Returns the total size of the pages allocated by this manager from the given memory heap
+    VkDeviceSize GetHeapAllocatedSize(uint32_t HeapIndex) const
+    {
+        VERIFY_EXPR(HeapIndex < m_HeapAllocatedSize.size());
+        return m_HeapAllocatedSize[HeapIndex].load();
+    }
+
+    // Returns the total size of the allocations in the pages allocated from every memory heap
+    void GetHeapUsedSizes(std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>& UsedSizes);
+
+    // Returns the current budget and usage of the memory heap. If VK_EXT_memory_budget is not enabled,
+    // the budget is the heap size, and the usage is the size of the pages allocated by this manager.
+    void GetHeapBudget(uint32_t HeapIndex, VkDeviceSize& Budget, VkDeviceSize& Usage) const;
+
+    // The callback is called when a new page is allocated and the usage of its heap
+    // exceeds the given fraction of the heap budget.
+    using BudgetCallbackType = std::function<void(uint32_t HeapIndex)>;
+    void SetBudgetCallback(BudgetCallbackType Callback, float Threshold);
+
 protected:
     friend class VulkanMemoryPage;
 
+    // The hooks are called for shared as well as dedicated pages. Derived classes may use
+    // VulkanMemoryPage::GetNumFreeBlocks() and VulkanMemoryPage::GetMaxFreeBlockSize()
+    // to track page fragmentation.
     virtual void OnNewPageCreated(VulkanMemoryPage& NewPage) {}
     virtual void OnPageDestroy(VulkanMemoryPage& Page) {}
 
@@ -231,21 +356,25 @@ protected:
         const uint32_t              MemoryTypeIndex;
         const VkMemoryAllocateFlags AllocateFlags;
         const bool                  IsHostVisible;
+        const VkDeviceSize          SizeClass; // 0 for pages that are not limited to one size class
 
         // clang-format off
         MemoryPageIndex(uint32_t              _MemoryTypeIndex,
                         bool                  _IsHostVisible,
-                        VkMemoryAllocateFlags _AllocateFlags) :
+                        VkMemoryAllocateFlags _AllocateFlags,
+                        VkDeviceSize          _SizeClass = 0) :
             MemoryTypeIndex{_MemoryTypeIndex},
             AllocateFlags  {_AllocateFlags},
-            IsHostVisible  {_IsHostVisible}
+            IsHostVisible  {_IsHostVisible},
+            SizeClass      {_SizeClass}
         {}
 
         bool operator == (const MemoryPageIndex& rhs)const
         {
             return MemoryTypeIndex == rhs.MemoryTypeIndex &&
                    AllocateFlags   == rhs.AllocateFlags   &&
-                   IsHostVisible   == rhs.IsHostVisible;
+                   IsHostVisible   == rhs.IsHostVisible   &&
+                   SizeClass       == rhs.SizeClass;
         }
         // clang-format on
 
@@ -253,7 +382,7 @@ protected:
         {
             size_t operator()(const MemoryPageIndex& PageIndex) const
             {
-                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.AllocateFlags, PageIndex.IsHostVisible);
+                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.AllocateFlags, PageIndex.IsHostVisible, PageIndex.SizeClass);
             }
         };
     };
@@ -264,14 +393,60 @@ protected:
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
 
+    const VulkanMemoryAllocationPolicy m_Policy;
+
+    // Pages that hold a single allocation. Protected by m_PagesMtx.
+    std::list<VulkanMemoryPage> m_DedicatedPages;
+
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible);
 
+    VulkanMemoryAllocation AllocateImpl(VkDeviceSize          Size,
+                                        VkDeviceSize                         Alignment,
+                                        uint32_t                             MemoryTypeIndex,
+                                        bool                                 HostVisible,
+                                        VkMemoryAllocateFlags                AllocateFlags,
+                                        const VulkanDedicatedAllocationInfo* pDedicatedInfo,
+                                        bool                                 RespectBudget);
+
+    // Returns the page size for the memory type, not accounting for size classes
+    VkDeviceSize GetPageSize(uint32_t MemoryTypeIndex, bool HostVisible) const;
+
+    // Returns true if the allocation should get its own page
+    bool UseDedicatedPage(VkDeviceSize Size, const VulkanDedicatedAllocationInfo* pDedicatedInfo) const;
+
+    // Returns the size class of the allocation, or 0 if the allocation is not small
+    VkDeviceSize GetSizeClass(VkDeviceSize Size, VkDeviceSize Alignment) const;
+
+    // Checks if the heap budget allows allocating a new page of the given size
+    bool CheckHeapBudget(uint32_t HeapIndex, VkDeviceSize PageSize) const;
+
+    // Updates the statistics and calls OnPageDestroy(). The caller must remove the page from the container.
+    void DestroyPage(VulkanMemoryPage& Page);
+
+    // Returns the index of a memory type from a heap that is not device-local,
+    // which may be used when memory type MemoryTypeIndex is exhausted.
+    uint32_t GetFallbackMemoryTypeIndex(uint32_t MemoryTypeBits, uint32_t MemoryTypeIndex) const;
+
+    // Updates the threshold state of the heap. Returns true if the budget callback must be called.
+    bool UpdateHeapBudgetState(uint32_t HeapIndex);
+
     // 0 == Device local, 1 == Host-visible
     std::array<std::atomic<int64_t>, 2> m_CurrUsedSize      = {};
     std::array<VkDeviceSize, 2>         m_PeakUsedSize      = {};
     std::array<VkDeviceSize, 2>         m_CurrAllocatedSize = {};
     std::array<VkDeviceSize, 2>         m_PeakAllocatedSize = {};
 
+    // Total size of the pages allocated from every memory heap
+    std::array<std::atomic<VkDeviceSize>, VK_MAX_MEMORY_HEAPS> m_HeapAllocatedSize = {};
+
+    // Protected by m_PagesMtx
+    BudgetCallbackType                    m_BudgetCallback;
+    float                                 m_BudgetThreshold   = 1.f;
+    std::array<bool, VK_MAX_MEMORY_HEAPS> m_HeapOverThreshold = {};
+
+    // Whether any shared page is being evacuated. Protected by m_PagesMtx.
+    bool m_HasEvacuatingPages = false;
+
     // If adding new member, do not forget to update move ctor
 };
 
@@ -48,25 +48,34 @@ public:
 
     struct ExtensionFeatures
     {
-        VkPhysicalDeviceMeshShaderFeaturesEXT             MeshShader             = {};
-        VkPhysicalDevice16BitStorageFeaturesKHR           Storage16Bit           = {};
-        VkPhysicalDevice8BitStorageFeaturesKHR            Storage8Bit            = {};
-        VkPhysicalDeviceShaderFloat16Int8FeaturesKHR      ShaderFloat16Int8      = {};
-        VkPhysicalDeviceAccelerationStructureFeaturesKHR  AccelStruct            = {};
-        VkPhysicalDeviceRayTracingPipelineFeaturesKHR     RayTracingPipeline     = {};
-        VkPhysicalDeviceRayQueryFeaturesKHR               RayQuery               = {};
-        VkPhysicalDeviceBufferDeviceAddressFeaturesKHR    BufferDeviceAddress    = {};
-        VkPhysicalDeviceDescriptorIndexingFeaturesEXT     DescriptorIndexing     = {};
-        VkPhysicalDevicePortabilitySubsetFeaturesKHR      PortabilitySubset      = {};
-        VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT VertexAttributeDivisor = {};
-        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR      TimelineSemaphore      = {};
-        VkPhysicalDeviceHostQueryResetFeatures            HostQueryReset         = {};
-        VkPhysicalDeviceFragmentShadingRateFeaturesKHR    ShadingRate            = {};
-        VkPhysicalDeviceFragmentDensityMapFeaturesEXT     FragmentDensityMap     = {}; // Only for desktop devices
-        VkPhysicalDeviceFragmentDensityMap2FeaturesEXT    FragmentDensityMap2    = {}; // Only for mobile devices
-        VkPhysicalDeviceMultiviewFeaturesKHR              Multiview              = {}; // Required for RenderPass2
-        VkPhysicalDeviceMultiDrawFeaturesEXT              MultiDraw              = {};
-        VkPhysicalDeviceShaderDrawParametersFeatures      ShaderDrawParameters   = {};
+        VkPhysicalDeviceMeshShaderFeaturesEXT              MeshShader              = {};
+        VkPhysicalDevice16BitStorageFeaturesKHR            Storage16Bit            = {};
+        VkPhysicalDevice8BitStorageFeaturesKHR             Storage8Bit             = {};
+        VkPhysicalDeviceShaderFloat16Int8FeaturesKHR       ShaderFloat16Int8       = {};
+        VkPhysicalDeviceAccelerationStructureFeaturesKHR   AccelStruct             = {};
+        VkPhysicalDeviceRayTracingPipelineFeaturesKHR      RayTracingPipeline      = {};
+        VkPhysicalDeviceRayQueryFeaturesKHR                RayQuery                = {};
+        VkPhysicalDeviceBufferDeviceAddressFeaturesKHR     BufferDeviceAddress     = {};
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT      DescriptorIndexing      = {};
+        VkPhysicalDevicePortabilitySubsetFeaturesKHR       PortabilitySubset       = {};
+        VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT  VertexAttributeDivisor  = {};
+        VkPhysicalDeviceTimelineSemaphoreFeaturesKHR       TimelineSemaphore       = {};
+        VkPhysicalDeviceHostQueryResetFeatures             HostQueryReset          = {};
+        VkPhysicalDeviceFragmentShadingRateFeaturesKHR     ShadingRate             = {};
+        VkPhysicalDeviceFragmentDensityMapFeaturesEXT      FragmentDensityMap      = {}; // Only for desktop devices
+        VkPhysicalDeviceFragmentDensityMap2FeaturesEXT     FragmentDensityMap2     = {}; // Only for mobile devices
+        VkPhysicalDeviceMultiviewFeaturesKHR               Multiview               = {}; // Required for RenderPass2
+        VkPhysicalDeviceMultiDrawFeaturesEXT               MultiDraw               = {};
+        VkPhysicalDeviceShaderDrawParametersFeatures       ShaderDrawParameters    = {};
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR        DynamicRendering        = {};
+        VkPhysicalDeviceDescriptorBufferFeaturesEXT        DescriptorBuffer        = {};
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT GraphicsPipelineLibrary = {};
+        VkPhysicalDeviceSynchronization2FeaturesKHR        Synchronization2        = {};
+        VkPhysicalDeviceConditionalRenderingFeaturesEXT    ConditionalRendering    = {};
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT    ExtendedDynamicState    = {};
+
+        VkPhysicalDevicePipelineCreationCacheControlFeaturesEXT PipelineCreationCacheControl = {};
+        VkPhysicalDeviceShaderModuleIdentifierFeaturesEXT       ShaderModuleIdentifier       = {}; // Requires PipelineCreationCacheControl
 
         bool Spirv14              = false; // Ray tracing requires Vulkan 1.2 or SPIRV 1.4 extension
         bool Spirv15              = false; // DXC shaders with ray tracing requires Vulkan 1.2 with SPIRV 1.5
@@ -74,24 +83,34 @@ public:
         bool HasPortabilitySubset = false;
         bool RenderPass2          = false;
         bool DrawIndirectCount    = false;
+        bool PushDescriptor       = false;
+        bool MemoryBudget         = false;
+        bool DedicatedAllocation  = false;
+        bool CalibratedTimestamps = false;
+        bool ExternalMemory       = false; // VK_KHR_external_memory_fd or VK_KHR_external_memory_win32, requires Vulkan 1.1
+        bool ExternalSemaphore    = false; // VK_KHR_external_semaphore_fd or VK_KHR_external_semaphore_win32, requires Vulkan 1.1
     };
 
     struct ExtensionProperties
     {
-        VkPhysicalDeviceMeshShaderPropertiesEXT             MeshShader             = {};
-        VkPhysicalDeviceAccelerationStructurePropertiesKHR  AccelStruct            = {};
-        VkPhysicalDeviceRayTracingPipelinePropertiesKHR     RayTracingPipeline     = {};
-        VkPhysicalDeviceDescriptorIndexingPropertiesEXT     DescriptorIndexing     = {};
-        VkPhysicalDevicePortabilitySubsetPropertiesKHR      PortabilitySubset      = {};
-        VkPhysicalDeviceSubgroupProperties                  Subgroup               = {};
-        VkPhysicalDeviceVertexAttributeDivisorPropertiesEXT VertexAttributeDivisor = {};
-        VkPhysicalDeviceTimelineSemaphorePropertiesKHR      TimelineSemaphore      = {};
-        VkPhysicalDeviceFragmentShadingRatePropertiesKHR    ShadingRate            = {};
-        VkPhysicalDeviceFragmentDensityMapPropertiesEXT     FragmentDensityMap     = {};
-        VkPhysicalDeviceMultiviewPropertiesKHR              Multiview              = {};
-        VkPhysicalDeviceMaintenance3Properties              Maintenance3           = {};
-        VkPhysicalDeviceFragmentDensityMap2PropertiesEXT    FragmentDensityMap2    = {};
-        VkPhysicalDeviceMultiDrawPropertiesEXT              MultiDraw              = {};
+        VkPhysicalDeviceMeshShaderPropertiesEXT              MeshShader              = {};
+        VkPhysicalDeviceAccelerationStructurePropertiesKHR   AccelStruct             = {};
+        VkPhysicalDeviceRayTracingPipelinePropertiesKHR      RayTracingPipeline      = {};
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT      DescriptorIndexing      = {};
+        VkPhysicalDevicePortabilitySubsetPropertiesKHR       PortabilitySubset       = {};
+        VkPhysicalDeviceSubgroupProperties                   Subgroup                = {};
+        VkPhysicalDeviceVertexAttributeDivisorPropertiesEXT  VertexAttributeDivisor  = {};
+        VkPhysicalDeviceTimelineSemaphorePropertiesKHR       TimelineSemaphore       = {};
+        VkPhysicalDeviceFragmentShadingRatePropertiesKHR     ShadingRate             = {};
+        VkPhysicalDeviceFragmentDensityMapPropertiesEXT      FragmentDensityMap      = {};
+        VkPhysicalDeviceMultiviewPropertiesKHR               Multiview               = {};
+        VkPhysicalDeviceMaintenance3Properties               Maintenance3            = {};
+        VkPhysicalDeviceFragmentDensityMap2PropertiesEXT     FragmentDensityMap2     = {};
+        VkPhysicalDeviceMultiDrawPropertiesEXT               MultiDraw               = {};
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT        DescriptorBuffer        = {};
+        VkPhysicalDevicePushDescriptorPropertiesKHR          PushDescriptor          = {};
+        VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT GraphicsPipelineLibrary = {};
+        VkPhysicalDeviceShaderModuleIdentifierPropertiesEXT  ShaderModuleIdentifier  = {};
     };
 
 public:
@@ -111,8 +130,27 @@ public:
 
     static constexpr uint32_t InvalidMemoryTypeIndex = ~uint32_t{0};
 
+    // Host time domain that matches the clock of std::chrono::steady_clock
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    static constexpr VkTimeDomainEXT HostTimeDomain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+#else
+    static constexpr VkTimeDomainEXT HostTimeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+#endif
+
+    // Handle types of the memory objects and semaphores exported by the engine
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+    static constexpr VkExternalMemoryHandleTypeFlagBits    ExternalMemoryHandleType    = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
+    static constexpr VkExternalSemaphoreHandleTypeFlagBits ExternalSemaphoreHandleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_WIN32_BIT;
+#else
+    static constexpr VkExternalMemoryHandleTypeFlagBits    ExternalMemoryHandleType    = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+    static constexpr VkExternalSemaphoreHandleTypeFlagBits ExternalSemaphoreHandleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+#endif
+
     uint32_t GetMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
+    // Queries the current memory budget of every heap. Returns false if VK_EXT_memory_budget is not supported.
+    bool GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& Budget) const;
+
     VkPhysicalDevice                            GetVkDeviceHandle() const { return m_VkDevice; }
     uint32_t                                    GetVkVersion() const { return m_VkVersion; }
     const VkPhysicalDeviceProperties&           GetProperties() const { return m_Properties; }
@@ -122,12 +160,14 @@ public:
     const VkPhysicalDeviceMemoryProperties&     GetMemoryProperties() const { return m_MemoryProperties; }
     VkFormatProperties                          GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
     const std::vector<VkQueueFamilyProperties>& GetQueueProperties() const { return m_QueueFamilyProperties; }
+    uint32_t                                    GetDeviceGroupSize() const { return m_DeviceGroupSize; }
 
 private:
     VulkanPhysicalDevice(const CreateInfo& CI);
 
     const VkPhysicalDevice               m_VkDevice;
     uint32_t                             m_VkVersion        = 0;
+    uint32_t                             m_DeviceGroupSize  = 1;
     VkPhysicalDeviceProperties           m_Properties       = {};
     VkPhysicalDeviceFeatures             m_Features         = {};
     VkPhysicalDeviceMemoryProperties     m_MemoryProperties = {};
@@ -84,6 +84,31 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL VkCommandBuffer METHOD(GetVkCommandBuffer)(THIS) PURE;
+
+    /// Sets the immediate context that executes resource uploads issued through this context asynchronously
+
+    /// \param [in] pUploadContext - Immediate context, typically created for a dedicated transfer
+    ///                               queue, that will execute the uploads. Pass null to disable
+    ///                               asynchronous uploads.
+    ///
+    /// \remarks  When the upload context is set, UpdateBuffer() and UpdateTexture() calls that use
+    ///           RESOURCE_STATE_TRANSITION_MODE_TRANSITION are recorded into the upload context when the
+    ///           resource has not been used by the GPU yet (i.e. it is in RESOURCE_STATE_UNDEFINED state),
+    ///           or when it has only been updated through the upload context since this context was last
+    ///           flushed. Other updates are recorded into this context as usual.
+    ///           Uploads are submitted to the upload context queue when this context is flushed, and
+    ///           this context's queue waits for them to complete before executing its commands.
+    ///
+    ///           The resource ImmediateContextMask must include both contexts; otherwise the update is
+    ///           recorded into this context.
+    ///
+    ///           The upload context is used by the thread that records commands into this context,
+    ///           so the application must not use it directly while it is set. FinishFrame() called
+    ///           for this context also finishes the frame in the upload context.
+    ///
+    ///           This method is only allowed for immediate contexts.
+    VIRTUAL void METHOD(SetAsyncUploadContext)(THIS_
+                                               IDeviceContext* pUploadContext) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -95,6 +120,7 @@ DILIGENT_END_INTERFACE
 
 #    define IDeviceContextVk_TransitionImageLayout(This, ...) CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout, This, __VA_ARGS__)
 #    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
+#    define IDeviceContextVk_SetAsyncUploadContext(This, ...) CALL_IFACE_METHOD(DeviceContextVk, SetAsyncUploadContext, This, __VA_ARGS__)
 
 // clang-format on
 
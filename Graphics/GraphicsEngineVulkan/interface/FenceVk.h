@@ -52,6 +52,18 @@ DILIGENT_BEGIN_INTERFACE(IFenceVk, IFence)
 {
     /// If timeline semaphores are supported, returns the semaphore object; otherwise returns VK_NULL_HANDLE.
     VIRTUAL VkSemaphore METHOD(GetVkSemaphore)(THIS) PURE;
+
+    /// Exports the timeline semaphore of the fence to another API or process.
+
+    /// \param [out] Handle - Platform handle of the exported semaphore: a file descriptor
+    ///                       (VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT) on POSIX platforms or an NT handle
+    ///                       (VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_WIN32_BIT) on Windows.
+    ///                       The application owns the handle and must close it when it is no longer needed.
+    /// \return     true if the handle was successfully exported, and false otherwise.
+    ///
+    /// \note The fence must have been created with FENCE_FLAG_EXPORTABLE flag.
+    VIRTUAL Bool METHOD(ExportSemaphoreHandle)(THIS_
+                                               Uint64 REF Handle) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -61,7 +73,8 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IFenceVk_GetVkSemaphore(This)    CALL_IFACE_METHOD(FenceVk, GetVkSemaphore, This)
+#    define IFenceVk_GetVkSemaphore(This)           CALL_IFACE_METHOD(FenceVk, GetVkSemaphore,        This)
+#    define IFenceVk_ExportSemaphoreHandle(This, ...) CALL_IFACE_METHOD(FenceVk, ExportSemaphoreHandle, This, __VA_ARGS__)
 
 // clang-format on
 
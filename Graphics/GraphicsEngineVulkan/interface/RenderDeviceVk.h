@@ -47,6 +47,85 @@ static DILIGENT_CONSTEXPR INTERFACE_ID IID_RenderDeviceVk =
 
 // clang-format off
 
+/// Memory budget of a Vulkan memory heap, see IRenderDeviceVk::GetMemoryHeapBudget().
+struct MemoryHeapBudgetVk
+{
+    /// The total size of the heap, in bytes.
+    VkDeviceSize Size                DEFAULT_INITIALIZER(0);
+
+    /// An estimate of how much memory the process can allocate from the heap before
+    /// allocations may fail or cause performance degradation, in bytes.
+    /// If VK_EXT_memory_budget is not supported, this is the heap size.
+    VkDeviceSize Budget              DEFAULT_INITIALIZER(0);
+
+    /// An estimate of how much memory the process is currently using in the heap, in bytes.
+    /// If VK_EXT_memory_budget is not supported, this is the size of the memory
+    /// allocated by the engine.
+    VkDeviceSize Usage               DEFAULT_INITIALIZER(0);
+
+    /// The size of the memory pages allocated from the heap by the engine's resource memory manager, in bytes.
+    VkDeviceSize EngineAllocatedSize DEFAULT_INITIALIZER(0);
+
+    /// Whether the heap is device-local.
+    Bool         IsDeviceLocal       DEFAULT_INITIALIZER(False);
+};
+typedef struct MemoryHeapBudgetVk MemoryHeapBudgetVk;
+
+/// Memory budget callback function, see IRenderDeviceVk::SetMemoryBudgetCallback().
+
+/// \param [in] HeapIndex - Index of the memory heap whose usage has exceeded the threshold.
+/// \param [in] Budget    - Memory budget of the heap.
+/// \param [in] pUserData - User data pointer that was given to IRenderDeviceVk::SetMemoryBudgetCallback().
+typedef void (DILIGENT_CALL_TYPE* MemoryBudgetCallbackType)(Uint32                       HeapIndex,
+                                                            const MemoryHeapBudgetVk REF Budget,
+                                                            void*                        pUserData);
+
+/// Resource relocation callback function, see DefragmentMemoryAttribsVk::Callback.
+
+/// \param [in] pResource - The buffer or texture that has been moved to a new memory location.
+/// \param [in] pUserData - User data pointer from DefragmentMemoryAttribsVk::pUserData.
+typedef void (DILIGENT_CALL_TYPE* ResourceRelocatedCallbackType)(IDeviceObject* pResource,
+                                                                 void*          pUserData);
+
+/// Memory defragmentation attributes, see IRenderDeviceVk::DefragmentMemory().
+struct DefragmentMemoryAttribsVk
+{
+    /// The maximum number of bytes to move during one defragmentation pass.
+    Uint64                        MaxBytesToMove      DEFAULT_INITIALIZER(64 << 20);
+
+    /// Memory pages whose used size is less than this fraction of the page size
+    /// are evacuated, in the (0, 1] range.
+    float                         SparsePageThreshold DEFAULT_INITIALIZER(0.5f);
+
+    /// Whether to relocate textures. When textures are relocated, their default views are
+    /// recreated, but all other views must be recreated by the application.
+    Bool                          RelocateTextures    DEFAULT_INITIALIZER(False);
+
+    /// An optional callback that is called for every relocated resource after the pass is complete.
+    ResourceRelocatedCallbackType Callback            DEFAULT_INITIALIZER(nullptr);
+
+    /// User data pointer that is passed to the callback.
+    void*                         pUserData           DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct DefragmentMemoryAttribsVk DefragmentMemoryAttribsVk;
+
+/// Memory defragmentation statistics, see IRenderDeviceVk::DefragmentMemory().
+struct DefragmentMemoryStatsVk
+{
+    /// The number of sparse memory pages that were selected for evacuation.
+    Uint32 NumSparsePages       DEFAULT_INITIALIZER(0);
+
+    /// The number of buffers moved to new memory.
+    Uint32 NumRelocatedBuffers  DEFAULT_INITIALIZER(0);
+
+    /// The number of textures moved to new memory.
+    Uint32 NumRelocatedTextures DEFAULT_INITIALIZER(0);
+
+    /// The total size of the relocated resources, in bytes.
+    Uint64 RelocatedBytes       DEFAULT_INITIALIZER(0);
+};
+typedef struct DefragmentMemoryStatsVk DefragmentMemoryStatsVk;
+
 /// Exposes Vulkan-specific functionality of a render device.
 DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
 {
@@ -157,6 +236,58 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                        VkSemaphore         vkTimelineSemaphore,
                                                        const FenceDesc REF Desc,
                                                        IFence**            ppFence) PURE;
+
+    /// Returns the number of Vulkan memory heaps of the physical device.
+    VIRTUAL Uint32 METHOD(GetMemoryHeapCount)(THIS) PURE;
+
+    /// Returns the current memory budget of the Vulkan memory heap.
+
+    /// \param [in]  HeapIndex - Memory heap index, must be less than GetMemoryHeapCount().
+    /// \param [out] Budget    - Memory budget of the heap.
+    ///
+    /// \remarks   If VK_EXT_memory_budget is supported, the budget and usage are queried
+    ///             from the driver. The usage then also includes the memory that the
+    ///             application allocated outside of the engine.
+    VIRTUAL void METHOD(GetMemoryHeapBudget)(THIS_
+                                             Uint32                 HeapIndex,
+                                             MemoryHeapBudgetVk REF Budget) PURE;
+
+    /// Sets the callback that is called when the memory usage of a heap exceeds
+    /// the given fraction of its budget.
+
+    /// \param [in] Callback  - Callback function, or null to remove the callback.
+    /// \param [in] Threshold - Fraction of the heap budget, in the (0, 1] range.
+    /// \param [in] pUserData - User data pointer that is passed to the callback.
+    ///
+    /// \remarks   The usage is checked every time the engine allocates a new device memory page.
+    ///             The callback is called once when the usage of a heap exceeds the threshold, and
+    ///             is not called again for the same heap until the usage drops below the threshold.
+    ///             The callback may be called from any thread that creates resources. The application
+    ///             may release resources from the callback, but it must not create new ones.
+    VIRTUAL void METHOD(SetMemoryBudgetCallback)(THIS_
+                                                 MemoryBudgetCallbackType Callback,
+                                                 float                    Threshold,
+                                                 void*                    pUserData) PURE;
+
+    /// Runs one incremental memory defragmentation pass.
+
+    /// \param [in]  Attribs - Defragmentation attributes.
+    /// \param [out] pStats  - Optional pointer to the structure that receives the pass statistics.
+    ///
+    /// \remarks   The device moves resources out of sparsely used device-local memory pages with
+    ///             GPU copies so that the pages can later be released by ReleaseStaleResources().
+    ///             Only USAGE_DEFAULT and USAGE_IMMUTABLE resources that are used by a single
+    ///             immediate context are relocated. Relocated resources get new Vulkan handles
+    ///             and device addresses.
+    ///
+    ///             The method must be called at a frame boundary after all device contexts have been
+    ///             flushed, and no other thread may use the resources while the method is running.
+    ///             Relocated resources must be set again in shader resource bindings with
+    ///             SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE flag; the callback in Attribs is
+    ///             the right place to do this.
+    VIRTUAL void METHOD(DefragmentMemory)(THIS_
+                                          const DefragmentMemoryAttribsVk REF Attribs,
+                                          DefragmentMemoryStatsVk*            pStats DEFAULT_VALUE(nullptr)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -174,6 +305,10 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateFenceFromVulkanResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceVk, CreateFenceFromVulkanResource,  This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetMemoryHeapCount(This)                  CALL_IFACE_METHOD(RenderDeviceVk, GetMemoryHeapCount,             This)
+#    define IRenderDeviceVk_GetMemoryHeapBudget(This, ...)            CALL_IFACE_METHOD(RenderDeviceVk, GetMemoryHeapBudget,            This, __VA_ARGS__)
+#    define IRenderDeviceVk_SetMemoryBudgetCallback(This, ...)        CALL_IFACE_METHOD(RenderDeviceVk, SetMemoryBudgetCallback,        This, __VA_ARGS__)
+#    define IRenderDeviceVk_DefragmentMemory(This, ...)               CALL_IFACE_METHOD(RenderDeviceVk, DefragmentMemory,               This, __VA_ARGS__)
 
 // clang-format on
 
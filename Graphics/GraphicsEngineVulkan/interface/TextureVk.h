@@ -47,6 +47,25 @@ static DILIGENT_CONSTEXPR INTERFACE_ID IID_TextureVk =
 
 // clang-format off
 
+/// This structure is returned by ITextureVk::ExportMemoryHandle()
+struct ExternalMemoryHandleVk
+{
+    /// Platform handle of the exported memory object: a file descriptor on POSIX platforms
+    /// or an NT handle on Windows. The application owns the handle and must close it
+    /// (or transfer the ownership by importing it) when it is no longer needed.
+    Uint64                          Handle          DEFAULT_INITIALIZER(0);
+
+    /// Type of the handle (VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT or VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT).
+    VkExternalMemoryHandleTypeFlags HandleType      DEFAULT_INITIALIZER(0);
+
+    /// Size of the memory object, in bytes. The importer must use the same allocation size.
+    VkDeviceSize                    AllocationSize  DEFAULT_INITIALIZER(0);
+
+    /// Offset of the image in the memory object, in bytes.
+    VkDeviceSize                    Offset          DEFAULT_INITIALIZER(0);
+};
+typedef struct ExternalMemoryHandleVk ExternalMemoryHandleVk;
+
 /// Exposes Vulkan-specific functionality of a texture object.
 DILIGENT_BEGIN_INTERFACE(ITextureVk, ITexture)
 {
@@ -65,6 +84,16 @@ DILIGENT_BEGIN_INTERFACE(ITextureVk, ITexture)
 
     /// Returns current Vulkan image layout. If the state is unknown to the engine, returns VK_IMAGE_LAYOUT_UNDEFINED
     VIRTUAL VkImageLayout METHOD(GetLayout)(THIS) CONST PURE;
+
+    /// Exports the memory of the texture to another API or process.
+
+    /// \param [out] Handle - Exported memory handle, see Diligent::ExternalMemoryHandleVk.
+    /// \return     true if the handle was successfully exported, and false otherwise.
+    ///
+    /// \note The texture must have been created with MISC_TEXTURE_FLAG_EXPORTABLE flag.
+    ///       Every call creates a new handle.
+    VIRTUAL Bool METHOD(ExportMemoryHandle)(THIS_
+                                            ExternalMemoryHandleVk REF Handle) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -74,9 +103,10 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define ITextureVk_GetVkImage(This)     CALL_IFACE_METHOD(TextureVk, GetVkImage,This)
-#    define ITextureVk_SetLayout(This, ...) CALL_IFACE_METHOD(TextureVk, SetLayout, This, __VA_ARGS__)
-#    define ITextureVk_GetLayout(This)      CALL_IFACE_METHOD(TextureVk, GetLayout, This)
+#    define ITextureVk_GetVkImage(This)              CALL_IFACE_METHOD(TextureVk, GetVkImage,This)
+#    define ITextureVk_SetLayout(This, ...)          CALL_IFACE_METHOD(TextureVk, SetLayout, This, __VA_ARGS__)
+#    define ITextureVk_GetLayout(This)               CALL_IFACE_METHOD(TextureVk, GetLayout, This)
+#    define ITextureVk_ExportMemoryHandle(This, ...) CALL_IFACE_METHOD(TextureVk, ExportMemoryHandle, This, __VA_ARGS__)
 
 // clang-format on
 
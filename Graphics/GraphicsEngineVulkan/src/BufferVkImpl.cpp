@@ -130,6 +130,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
             case BIND_INDIRECT_DRAW_ARGS:
             {
                 VkBuffCI.usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+                // Indirect argument buffers may also contain conditional rendering predicates
+                if (pRenderDeviceVk->GetDeviceInfo().Features.ConditionalRendering)
+                    VkBuffCI.usage |= VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
                 break;
             }
             case BIND_UNIFORM_BUFFER:
@@ -189,6 +192,17 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         // Read-only storage buffers (aka structured buffers) don't need a backing buffer.
         ((VkBuffCI.usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) != 0 && (m_Desc.BindFlags & BIND_UNORDERED_ACCESS) != 0);
 
+    if (pRenderDeviceVk->IsDescriptorBufferEnabled() &&
+        m_Desc.Usage != USAGE_SPARSE &&
+        (m_Desc.Usage != USAGE_DYNAMIC || RequiresBackingBuffer) &&
+        (VkBuffCI.usage & (VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                           VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT)) != 0)
+    {
+        // Descriptor buffers reference buffers by device address
+        VkBuffCI.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
+    m_VkUsageFlags = VkBuffCI.usage;
+
     if (m_Desc.Usage == USAGE_SPARSE)
     {
         VkBuffCI.flags =
@@ -220,6 +234,7 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         {
             constexpr VkAccessFlags AccessFlags =
                 VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+                VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT |
                 VK_ACCESS_INDEX_READ_BIT |
                 VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
                 VK_ACCESS_UNIFORM_READ_BIT |
@@ -238,7 +253,10 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
 
-        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
+        VulkanUtilities::VulkanDedicatedAllocationInfo DedicatedInfo;
+        DedicatedInfo.Buffer = m_VulkanBuffer;
+
+        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer, DedicatedInfo.PrefersDedicated);
 
         static constexpr auto InvalidMemoryTypeIndex = VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex;
 
@@ -315,8 +333,11 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
             MemReqs.size      = AlignUp(MemReqs.size, DeviceLimits.nonCoherentAtomSize);
         }
 
+        // Dedicated allocation size must match the buffer memory requirements, so the buffer
+        // can only be given dedicated memory when its size has not been adjusted.
         VERIFY(IsPowerOfTwo(RequiredAlignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs.size, RequiredAlignment, MemoryTypeIndex, AllocateFlags);
+        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs.size, RequiredAlignment, MemoryTypeIndex, AllocateFlags,
+                                                             AlignToNonCoherentAtomSize ? nullptr : &DedicatedInfo);
         if (!m_MemoryAllocation)
             LOG_ERROR_AND_THROW("Failed to allocate memory for buffer '", m_Desc.Name, "'.");
 
@@ -326,6 +347,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
         CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
 
+        if (VkBuffCI.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+            m_VkDeviceAddress = LogicalDevice.GetBufferDeviceAddress(m_VulkanBuffer);
+
         VERIFY(!AlignToNonCoherentAtomSize || (m_BufferMemoryAlignedOffset + MemReqs.size) % DeviceLimits.nonCoherentAtomSize == 0, "End offset is not properly aligned");
 
 #ifdef DILIGENT_DEBUG
@@ -452,6 +476,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
     }
 
     VERIFY_EXPR(IsInKnownState());
+
+    if (IsRelocatable())
+        pRenderDeviceVk->RegisterRelocatableResource(this);
 }
 
 
@@ -479,6 +506,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
 BufferVkImpl::~BufferVkImpl()
 {
+    if (IsRelocatable())
+        m_pDevice->UnregisterRelocatableResource(this);
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     if (m_VulkanBuffer != VK_NULL_HANDLE)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.ImmediateContextMask);
@@ -545,6 +575,73 @@ VulkanUtilities::BufferViewWrapper BufferVkImpl::CreateView(struct BufferViewDes
     return BuffView;
 }
 
+bool BufferVkImpl::IsRelocatable() const
+{
+    // Formatted buffers are excluded as their views reference the Vulkan buffer, and
+    // ray tracing buffers are excluded as acceleration structures store their device addresses.
+    return (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_IMMUTABLE) &&
+        m_Desc.Mode != BUFFER_MODE_FORMATTED &&
+        (m_Desc.BindFlags & BIND_RAY_TRACING) == 0 &&
+        m_MemoryAllocation.Page != nullptr &&
+        m_MemoryAllocation.Page->GetCPUMemory() == nullptr &&
+        PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) == 1;
+}
+
+bool BufferVkImpl::Relocate(VulkanUtilities::VulkanCommandBuffer& CmdBuffer, RelocationData& OldResources) noexcept(false)
+{
+    VERIFY_EXPR(IsRelocatable());
+
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+
+    VkBufferCreateInfo VkBuffCI{};
+    VkBuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkBuffCI.pNext                 = nullptr;
+    VkBuffCI.flags                 = 0;
+    VkBuffCI.size                  = m_Desc.Size;
+    VkBuffCI.usage                 = m_VkUsageFlags;
+    VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE; // The buffer is only used by one immediate context
+    VkBuffCI.queueFamilyIndexCount = 0;
+    VkBuffCI.pQueueFamilyIndices   = nullptr;
+
+    VulkanUtilities::BufferWrapper NewBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
+
+    VulkanUtilities::VulkanDedicatedAllocationInfo DedicatedInfo;
+    DedicatedInfo.Buffer = NewBuffer;
+
+    VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(NewBuffer, DedicatedInfo.PrefersDedicated);
+    VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+
+    VkMemoryAllocateFlags AllocateFlags = 0;
+    if (m_VkUsageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+        AllocateFlags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+    VulkanUtilities::VulkanMemoryAllocation NewMemory = GetDevice()->AllocateMemory(MemReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, AllocateFlags, &DedicatedInfo);
+    if (!NewMemory)
+        return false;
+
+    const auto AlignedOffset = AlignUp(VkDeviceSize{NewMemory.UnalignedOffset}, MemReqs.alignment);
+    VERIFY(NewMemory.Size >= MemReqs.size + (AlignedOffset - NewMemory.UnalignedOffset), "Size of memory allocation is too small");
+    auto err = LogicalDevice.BindBufferMemory(NewBuffer, NewMemory.Page->GetVkMemory(), AlignedOffset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+
+    VkBufferCopy BuffCopy{};
+    BuffCopy.srcOffset = 0;
+    BuffCopy.dstOffset = 0;
+    BuffCopy.size      = m_Desc.Size;
+    CmdBuffer.CopyBuffer(m_VulkanBuffer, NewBuffer, 1, &BuffCopy);
+
+    OldResources.Buffer         = std::move(m_VulkanBuffer);
+    OldResources.Memory         = std::move(m_MemoryAllocation);
+    m_VulkanBuffer              = std::move(NewBuffer);
+    m_MemoryAllocation          = std::move(NewMemory);
+    m_BufferMemoryAlignedOffset = AlignedOffset;
+
+    if (m_VkUsageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+        m_VkDeviceAddress = LogicalDevice.GetBufferDeviceAddress(m_VulkanBuffer);
+
+    return true;
+}
+
 VkBuffer BufferVkImpl::GetVkBuffer() const
 {
     if (m_VulkanBuffer != VK_NULL_HANDLE)
@@ -556,6 +653,21 @@ VkBuffer BufferVkImpl::GetVkBuffer() const
     }
 }
 
+VkDeviceAddress BufferVkImpl::GetDynamicVkDeviceAddress(DeviceContextIndex CtxId) const
+{
+    if (m_VulkanBuffer != VK_NULL_HANDLE)
+    {
+        VERIFY(m_VkDeviceAddress != 0, "Buffer '", m_Desc.Name, "' was not created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT");
+        return m_VkDeviceAddress;
+    }
+    else
+    {
+        const VulkanDynamicMemoryManager& DynamicMemMgr = m_pDevice->GetDynamicMemoryManager();
+        VERIFY(DynamicMemMgr.GetVkDeviceAddress() != 0, "Dynamic heap buffer has no device address. Descriptor buffers must be enabled.");
+        return DynamicMemMgr.GetVkDeviceAddress() + GetDynamicOffset(CtxId, nullptr);
+    }
+}
+
 void BufferVkImpl::SetAccessFlags(VkAccessFlags AccessFlags)
 {
     SetState(VkAccessFlagsToResourceStates(AccessFlags));
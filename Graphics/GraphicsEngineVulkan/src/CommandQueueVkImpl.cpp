@@ -40,7 +40,8 @@ CommandQueueVkImpl::CommandQueueVkImpl(IReferenceCounters*
                                        SoftwareQueueIndex                                    CommandQueueId,
                                        Uint32                                                NumCommandQueues,
                                        Uint32                                                vkQueueIndex,
-                                       const ImmediateContextCreateInfo&                     CreateInfo) :
+                                       const ImmediateContextCreateInfo&                     CreateInfo,
+                                       Uint32                                                SubmitBatchSize) :
     // clang-format off
     TBase{pRefCounters},
     m_LogicalDevice             {LogicalDevice},
@@ -51,12 +52,21 @@ CommandQueueVkImpl::CommandQueueVkImpl(IReferenceCounters*
     m_NumCommandQueues          {static_cast<Uint8>(m_SupportedTimelineSemaphore ? 1u : NumCommandQueues)},
     m_NextFenceValue            {1},
     m_SyncObjectManager         {std::make_shared<VulkanUtilities::VulkanSyncObjectManager>(*LogicalDevice)},
-    m_SyncPointAllocator        {GetRawAllocator(), SyncPointVk::SizeOf(m_NumCommandQueues), 16}
+    m_SyncPointAllocator        {GetRawAllocator(), SyncPointVk::SizeOf(m_NumCommandQueues), 16},
+    // Batched submissions share one sync point, which is only possible when
+    // sync points don't use binary semaphores to synchronize with other queues.
+    m_SubmitBatchSize           {m_NumCommandQueues == 1 ? SubmitBatchSize : 0}
 // clang-format on
 {
     VERIFY(m_CommandQueueId == CommandQueueId, "Not enough bits to store command queue index");
     VERIFY(m_SupportedTimelineSemaphore || m_NumCommandQueues == NumCommandQueues, "Not enough bits to store command queue count");
 
+    if (SubmitBatchSize != 0 && m_SubmitBatchSize == 0)
+    {
+        LOG_INFO_MESSAGE("Submit batching is disabled for command queue ", Uint32{CommandQueueId},
+                         " because timeline semaphores are not supported and there are multiple command queues.");
+    }
+
     if (CreateInfo.Name != nullptr)
         VulkanUtilities::SetQueueName(m_LogicalDevice->GetVkDevice(), m_VkQueue, CreateInfo.Name);
 
@@ -147,10 +157,152 @@ __forceinline SyncPointVkPtr CommandQueueVkImpl::CreateSyncPoint(Uint64 dbgValue
     return {new (ptr) SyncPointVk{m_CommandQueueId, m_NumCommandQueues, *m_SyncObjectManager, m_LogicalDevice->GetVkDevice(), dbgValue}, std::move(Deleter)};
 }
 
+bool CommandQueueVkImpl::CanBatchSubmit(const VkSubmitInfo& SubmitInfo) const
+{
+    if (m_SubmitBatchSize == 0)
+        return false;
+
+    // Only the timeline semaphore values are copied to the batch
+    const VkBaseInStructure* pStruct = static_cast<const VkBaseInStructure*>(SubmitInfo.pNext);
+    return (pStruct == nullptr ||
+            (pStruct->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO && pStruct->pNext == nullptr));
+}
+
+void CommandQueueVkImpl::AppendBatchedSubmit(const VkSubmitInfo& SubmitInfo)
+{
+    VERIFY_EXPR(CanBatchSubmit(SubmitInfo));
+
+    if (SubmitInfo.waitSemaphoreCount == 0 &&
+        SubmitInfo.commandBufferCount == 0 &&
+        SubmitInfo.signalSemaphoreCount == 0)
+        return;
+
+    const VkTimelineSemaphoreSubmitInfo* pTimelineInfo = static_cast<const VkTimelineSemaphoreSubmitInfo*>(SubmitInfo.pNext);
+
+    BatchedSubmitsInfo::SubmitRange Range;
+
+    Range.FirstCmdBuffer = static_cast<Uint32>(m_Batch.CmdBuffers.size());
+    Range.CmdBufferCount = SubmitInfo.commandBufferCount;
+    m_Batch.CmdBuffers.insert(m_Batch.CmdBuffers.end(), SubmitInfo.pCommandBuffers, SubmitInfo.pCommandBuffers + SubmitInfo.commandBufferCount);
+
+    Range.FirstWaitSemaphore = static_cast<Uint32>(m_Batch.WaitSemaphores.size());
+    Range.WaitSemaphoreCount = SubmitInfo.waitSemaphoreCount;
+    Range.WaitValueCount     = pTimelineInfo != nullptr ? pTimelineInfo->waitSemaphoreValueCount : 0;
+    for (uint32_t s = 0; s < SubmitInfo.waitSemaphoreCount; ++s)
+    {
+        m_Batch.WaitSemaphores.push_back(SubmitInfo.pWaitSemaphores[s]);
+        m_Batch.WaitDstStageMasks.push_back(SubmitInfo.pWaitDstStageMask[s]);
+        m_Batch.WaitValues.push_back(s < Range.WaitValueCount ? pTimelineInfo->pWaitSemaphoreValues[s] : 0);
+    }
+
+    Range.FirstSignalSemaphore = static_cast<Uint32>(m_Batch.SignalSemaphores.size());
+    Range.SignalSemaphoreCount = SubmitInfo.signalSemaphoreCount;
+    Range.SignalValueCount     = pTimelineInfo != nullptr ? pTimelineInfo->signalSemaphoreValueCount : 0;
+    for (uint32_t s = 0; s < SubmitInfo.signalSemaphoreCount; ++s)
+    {
+        m_Batch.SignalSemaphores.push_back(SubmitInfo.pSignalSemaphores[s]);
+        m_Batch.SignalValues.push_back(s < Range.SignalValueCount ? pTimelineInfo->pSignalSemaphoreValues[s] : 0);
+    }
+
+    Range.HasTimelineValues = pTimelineInfo != nullptr;
+
+    m_Batch.Submits.push_back(Range);
+}
+
+template <typename T>
+static const T* GetBatchRangePtr(const std::vector<T>& Items, Uint32 First, Uint32 Count)
+{
+    return Count != 0 ? &Items[First] : nullptr;
+}
+
+void CommandQueueVkImpl::InternalFlushBatchedSubmits()
+{
+    if (m_Batch.Submits.empty() && !m_Batch.pSyncPoint)
+        return;
+
+    const size_t NumSubmits = m_Batch.Submits.size();
+    m_Batch.SubmitInfos.resize(NumSubmits);
+    m_Batch.TimelineInfos.resize(NumSubmits);
+    for (size_t i = 0; i < NumSubmits; ++i)
+    {
+        const BatchedSubmitsInfo::SubmitRange& Range = m_Batch.Submits[i];
+
+        VkTimelineSemaphoreSubmitInfo& TimelineInfo = m_Batch.TimelineInfos[i];
+        TimelineInfo                           = {};
+        TimelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        TimelineInfo.waitSemaphoreValueCount   = Range.WaitValueCount;
+        TimelineInfo.pWaitSemaphoreValues      = GetBatchRangePtr(m_Batch.WaitValues, Range.FirstWaitSemaphore, Range.WaitValueCount);
+        TimelineInfo.signalSemaphoreValueCount = Range.SignalValueCount;
+        TimelineInfo.pSignalSemaphoreValues    = GetBatchRangePtr(m_Batch.SignalValues, Range.FirstSignalSemaphore, Range.SignalValueCount);
+
+        VkSubmitInfo& SubmitInfo = m_Batch.SubmitInfos[i];
+        SubmitInfo                      = {};
+        SubmitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        SubmitInfo.pNext                = Range.HasTimelineValues ? &TimelineInfo : nullptr;
+        SubmitInfo.waitSemaphoreCount   = Range.WaitSemaphoreCount;
+        SubmitInfo.pWaitSemaphores      = GetBatchRangePtr(m_Batch.WaitSemaphores, Range.FirstWaitSemaphore, Range.WaitSemaphoreCount);
+        SubmitInfo.pWaitDstStageMask    = GetBatchRangePtr(m_Batch.WaitDstStageMasks, Range.FirstWaitSemaphore, Range.WaitSemaphoreCount);
+        SubmitInfo.commandBufferCount   = Range.CmdBufferCount;
+        SubmitInfo.pCommandBuffers      = GetBatchRangePtr(m_Batch.CmdBuffers, Range.FirstCmdBuffer, Range.CmdBufferCount);
+        SubmitInfo.signalSemaphoreCount = Range.SignalSemaphoreCount;
+        SubmitInfo.pSignalSemaphores    = GetBatchRangePtr(m_Batch.SignalSemaphores, Range.FirstSignalSemaphore, Range.SignalSemaphoreCount);
+    }
+
+    // Batches in one vkQueueSubmit call follow the same submission order as separate calls.
+    // The fence is signaled when all of them are complete.
+    const VkFence vkFence = m_Batch.pSyncPoint ? m_Batch.pSyncPoint->GetFence() : VK_NULL_HANDLE;
+
+    auto err = vkQueueSubmit(m_VkQueue, static_cast<uint32_t>(NumSubmits), NumSubmits != 0 ? m_Batch.SubmitInfos.data() : nullptr, vkFence);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit batched command buffers to the command queue");
+    (void)err;
+
+    m_Batch.Submits.clear();
+    m_Batch.CmdBuffers.clear();
+    m_Batch.WaitSemaphores.clear();
+    m_Batch.WaitDstStageMasks.clear();
+    m_Batch.WaitValues.clear();
+    m_Batch.SignalSemaphores.clear();
+    m_Batch.SignalValues.clear();
+    m_Batch.pSyncPoint.reset();
+}
+
+void CommandQueueVkImpl::FlushBatchedSubmits()
+{
+    std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
+    InternalFlushBatchedSubmits();
+}
+
 Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
 {
     std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
 
+    if (CanBatchSubmit(InSubmitInfo))
+    {
+        const uint64_t FenceValue = m_NextFenceValue.fetch_add(1);
+
+        // All submissions in the batch share the sync point that is signaled when the batch is complete.
+        if (!m_Batch.pSyncPoint)
+            m_Batch.pSyncPoint = CreateSyncPoint(FenceValue);
+
+        AppendBatchedSubmit(InSubmitInfo);
+
+        VERIFY(m_pFence != nullptr, "Command queue fence has not been initialized");
+        m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, m_Batch.pSyncPoint);
+
+        {
+            Threading::SpinLockGuard SyncPointGuard{m_LastSyncPointLock};
+            m_LastSyncPoint = m_Batch.pSyncPoint;
+        }
+
+        if (m_Batch.Submits.size() >= m_SubmitBatchSize)
+            InternalFlushBatchedSubmits();
+
+        return FenceValue;
+    }
+
+    // Submissions that can't be batched must not overtake the batched ones
+    InternalFlushBatchedSubmits();
+
     // Increment the value before submitting the buffer to be overly safe
     const uint64_t FenceValue = m_NextFenceValue.fetch_add(1);
 
@@ -225,12 +377,14 @@ Uint64 CommandQueueVkImpl::WaitForIdle()
 {
     std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
 
+    InternalFlushBatchedSubmits();
+
     // Update last completed fence value to unlock all waiting events.
     const auto FenceValue = m_NextFenceValue.fetch_add(1);
 
     vkQueueWaitIdle(m_VkQueue);
     // For some reason after idling the queue not all fences are signaled
-    m_pFence->Wait(UINT64_MAX);
+    m_pFence->InternalWait(UINT64_MAX, FenceWaitTimeout::Infinite);
     m_pFence->Reset(FenceValue);
 
     return FenceValue;
@@ -241,12 +395,48 @@ Uint64 CommandQueueVkImpl::GetCompletedFenceValue()
     return m_pFence->GetCompletedValue();
 }
 
+Bool CommandQueueVkImpl::GetTimestampCalibration(TimestampCalibration& Calibration)
+{
+    Calibration = {};
+
+    if (!m_LogicalDevice->GetEnabledExtFeatures().CalibratedTimestamps)
+        return False;
+
+    VkCalibratedTimestampInfoEXT TimestampInfos[2]{};
+    TimestampInfos[0].sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    TimestampInfos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    TimestampInfos[1].sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    TimestampInfos[1].timeDomain = VulkanUtilities::VulkanPhysicalDevice::HostTimeDomain;
+
+    uint64_t Timestamps[2] = {};
+    uint64_t MaxDeviation  = 0;
+    if (m_LogicalDevice->GetCalibratedTimestamps(_countof(TimestampInfos), TimestampInfos, Timestamps, &MaxDeviation) != VK_SUCCESS)
+        return False;
+
+    Calibration.GPUTimestamp = Timestamps[0];
+    Calibration.GPUFrequency = static_cast<Uint64>(1000000000.0 / m_LogicalDevice->GetTimestampPeriod());
+    Calibration.CPUTimestamp = Timestamps[1];
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    LARGE_INTEGER CPUFrequency{};
+    QueryPerformanceFrequency(&CPUFrequency);
+    Calibration.CPUFrequency = static_cast<Uint64>(CPUFrequency.QuadPart);
+#else
+    // CLOCK_MONOTONIC is measured in nanoseconds
+    Calibration.CPUFrequency = 1000000000;
+#endif
+    Calibration.MaxDeviation = MaxDeviation;
+    return True;
+}
+
 void CommandQueueVkImpl::EnqueueSignalFence(VkFence vkFence)
 {
     DEV_CHECK_ERR(vkFence != VK_NULL_HANDLE, "vkFence must not be null");
 
     std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
 
+    // The fence must only be signaled after all batched submissions are complete
+    InternalFlushBatchedSubmits();
+
     auto err = vkQueueSubmit(m_VkQueue, 0, nullptr, vkFence);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit fence signal command to the command queue");
     (void)err;
@@ -279,6 +469,14 @@ void CommandQueueVkImpl::InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore
     SubmitInfo.signalSemaphoreCount = 1;
     SubmitInfo.pSignalSemaphores    = &vkTimelineSemaphore;
 
+    if (CanBatchSubmit(SubmitInfo))
+    {
+        AppendBatchedSubmit(SubmitInfo);
+        if (m_Batch.Submits.size() >= m_SubmitBatchSize)
+            InternalFlushBatchedSubmits();
+        return;
+    }
+
     auto err = vkQueueSubmit(m_VkQueue, 1, &SubmitInfo, VK_NULL_HANDLE);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit timeline semaphore signal command to the command queue");
     (void)err;
@@ -287,6 +485,10 @@ void CommandQueueVkImpl::InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore
 VkResult CommandQueueVkImpl::Present(const VkPresentInfoKHR& PresentInfo)
 {
     std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
+
+    // Presentation waits for the semaphores that are signaled by the batched submissions
+    InternalFlushBatchedSubmits();
+
     return vkQueuePresentKHR(m_VkQueue, &PresentInfo);
 }
 
@@ -294,6 +496,8 @@ Uint64 CommandQueueVkImpl::BindSparse(const VkBindSparseInfo& InBindInfo)
 {
     std::lock_guard<std::mutex> QueueGuard{m_QueueMutex};
 
+    InternalFlushBatchedSubmits();
+
     // Increment the value before submitting the buffer to be overly safe
     const uint64_t FenceValue = m_NextFenceValue.fetch_add(1);
 
@@ -197,6 +197,8 @@ DescriptorSetAllocator::~DescriptorSetAllocator()
 
 DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DescriptorSetAllocator::Allocate");
+
     // Descriptor pools are externally synchronized, meaning that the application must not allocate
     // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
     std::lock_guard<std::mutex> Lock{m_Mutex};
@@ -215,9 +217,7 @@ DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask
                 std::swap(*it, m_Pools.front());
             }
 
-#ifdef DILIGENT_DEVELOPMENT
             ++m_AllocatedSetCounter;
-#endif
             return {Set, Pool, CommandQueueMask, *this};
         }
     }
@@ -230,13 +230,18 @@ DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask
     auto  Set     = AllocateDescriptorSet(LogicalDevice, NewPool, SetLayout, DebugName);
     DEV_CHECK_ERR(Set != VK_NULL_HANDLE, "Failed to allocate descriptor set");
 
-#ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedSetCounter;
-#endif
 
     return {Set, NewPool, CommandQueueMask, *this};
 }
 
+void DescriptorSetAllocator::GetStats(DescriptorHeapStats& Stats)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    Stats.Allocated += static_cast<Uint32>(m_AllocatedSetCounter.load());
+    Stats.Capacity += static_cast<Uint32>(m_Pools.size()) * m_MaxSets;
+}
+
 void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask)
 {
     class DescriptorSetDeleter
@@ -272,9 +277,7 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
             {
                 std::lock_guard<std::mutex> Lock{Allocator->m_Mutex};
                 Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(Pool, Set);
-#ifdef DILIGENT_DEVELOPMENT
                 --Allocator->m_AllocatedSetCounter;
-#endif
             }
         }
 
@@ -289,6 +292,8 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
 
 VkDescriptorSet DynamicDescriptorSetAllocator::Allocate(VkDescriptorSetLayout SetLayout, const char* DebugName)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DynamicDescriptorSetAllocator::Allocate");
+
     VkDescriptorSet set           = VK_NULL_HANDLE;
     const auto&     LogicalDevice = m_GlobalPoolMgr.GetDeviceVkImpl().GetLogicalDevice();
     if (!m_AllocatedPools.empty())
@@ -183,8 +183,9 @@ void DeviceContextVkImpl::PrepareCommandPool(SoftwareQueueIndex CommandQueueId)
     auto& Pool = m_QueueFamilyCmdPools[QueueFamilyIndex];
     if (!Pool)
     {
-        // Command pools must be thread-safe because command buffers are returned into pools by release queues
-        // potentially running in another thread
+        // Command buffers are only allocated by the thread recording commands into this context, but they are
+        // returned into the pool by release queues potentially running in another thread. The pool keeps these
+        // lists separate, so the recording thread only takes the lock when it runs out of free buffers.
         Pool = std::make_unique<VulkanUtilities::VulkanCommandBufferPool>(
             m_pDevice->GetLogicalDevice().GetSharedPtr(),
             QueueFamilyIndex,
@@ -212,7 +213,7 @@ void DeviceContextVkImpl::Begin(Uint32 ImmediateContextId)
     m_pQueryMgr = &m_pDevice->GetQueryMgr(CommandQueueId);
 }
 
-void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue)
+void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue, VkCommandBufferLevel Level)
 {
     VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
     VERIFY_EXPR(m_CmdPool != nullptr);
@@ -221,9 +222,11 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
     public:
         // clang-format off
         CmdBufferRecycler(VkCommandBuffer                           _vkCmdBuff,
-                         VulkanUtilities::VulkanCommandBufferPool& _Pool) noexcept :
+                         VulkanUtilities::VulkanCommandBufferPool& _Pool,
+                         VkCommandBufferLevel                      _Level) noexcept :
             vkCmdBuff {_vkCmdBuff},
-            Pool      {&_Pool    }
+            Pool      {&_Pool    },
+            Level     {_Level    }
         {
             VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
         }
@@ -234,7 +237,8 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
 
         CmdBufferRecycler(CmdBufferRecycler&& rhs) noexcept :
             vkCmdBuff {rhs.vkCmdBuff},
-            Pool      {rhs.Pool     }
+            Pool      {rhs.Pool     },
+            Level     {rhs.Level    }
         {
             rhs.vkCmdBuff = VK_NULL_HANDLE;
             rhs.Pool      = nullptr;
@@ -245,24 +249,25 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
         {
             if (Pool != nullptr)
             {
-                Pool->RecycleCommandBuffer(std::move(vkCmdBuff));
+                Pool->RecycleCommandBuffer(std::move(vkCmdBuff), Level);
             }
         }
 
     private:
         VkCommandBuffer                           vkCmdBuff = VK_NULL_HANDLE;
         VulkanUtilities::VulkanCommandBufferPool* Pool      = nullptr;
+        VkCommandBufferLevel                      Level     = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     };
 
     // Discard command buffer directly to the release queue since we know exactly which queue it was submitted to
     // as well as the associated FenceValue.
     auto& ReleaseQueue = m_pDevice->GetReleaseQueue(CmdQueue);
-    ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, *m_CmdPool}, FenceValue);
+    ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, *m_CmdPool, Level}, FenceValue);
 }
 
 inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
 {
-    VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Disposing command buffer with unfinished render pass");
+    VERIFY(!m_CommandBuffer.IsInRenderPass(), "Disposing command buffer with unfinished render pass");
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     if (vkCmdBuff != VK_NULL_HANDLE)
     {
@@ -271,13 +276,52 @@ inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQ
     }
 }
 
+template <typename ResourceImplType>
+bool DeviceContextVkImpl::UseAsyncUpload(ResourceImplType& Resource, RESOURCE_STATE_TRANSITION_MODE TransitionMode) const
+{
+    if (!m_pAsyncUploadCtx || TransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+        return false;
+
+    const auto& Desc = Resource.GetDesc();
+    if (Desc.Usage != USAGE_DEFAULT || (Desc.ImmediateContextMask & (Uint64{1} << m_pAsyncUploadCtx->GetCommandQueueId())) == 0)
+        return false;
+
+    if (m_AsyncUploadResources.find(&Resource) != m_AsyncUploadResources.end())
+        return true;
+
+    // Only resources that have never been used by the GPU can be safely updated in another queue
+    // without waiting for the commands of this context that may have accessed them.
+    return Resource.IsInKnownState() && Resource.GetState() == RESOURCE_STATE_UNDEFINED;
+}
+
+void DeviceContextVkImpl::OnAsyncUpload(IDeviceObject* pResource)
+{
+    m_AsyncUploadResources.emplace(pResource, RefCntAutoPtr<IDeviceObject>{pResource});
+    ++m_NumPendingAsyncUploads;
+}
+
+void DeviceContextVkImpl::SubmitAsyncUploads()
+{
+    if (m_NumPendingAsyncUploads == 0)
+        return;
+
+    VERIFY_EXPR(m_pAsyncUploadCtx && m_pAsyncUploadFence);
+    m_pAsyncUploadCtx->EnqueueSignal(m_pAsyncUploadFence, ++m_AsyncUploadSignaledValue);
+    m_pAsyncUploadCtx->Flush();
+    m_NumPendingAsyncUploads = 0;
+}
+
 
 void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
-    RefCntAutoPtr<PipelineStateVkImpl> pPipelineStateVk{pPipelineState, PipelineStateVkImpl::IID_InternalImpl};
-    VERIFY(pPipelineState == nullptr || pPipelineStateVk != nullptr, "Unknown pipeline state object implementation");
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextVkImpl::SetPipelineState");
+
+    BorrowedPtr<PipelineStateVkImpl> pPipelineStateVk = BorrowPipelineState(pPipelineState);
     if (PipelineStateVkImpl::IsSameObject(m_pPipelineState, pPipelineStateVk))
+    {
+        ++m_Stats.CommandCounters.RedundantSetPipelineState;
         return;
+    }
 
     const auto& PSODesc = pPipelineStateVk->GetDesc();
 
@@ -303,7 +347,7 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
             CommitScissor = !m_pPipelineState->GetGraphicsPipelineDesc().RasterizerDesc.ScissorEnable;
     }
 
-    TDeviceContextBase::SetPipelineState(std::move(pPipelineStateVk), 0 /*Dummy*/);
+    TDeviceContextBase::SetPipelineState(pPipelineStateVk, 0 /*Dummy*/);
     EnsureVkCmdBuffer();
 
     auto vkPipeline = m_pPipelineState->GetVkPipeline();
@@ -317,6 +361,17 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
             auto& GraphicsPipeline = m_pPipelineState->GetGraphicsPipelineDesc();
             m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
 
+            if (m_pPipelineState->HasExtendedDynamicState())
+            {
+                // Dynamic states are initialized with the values from the pipeline description
+                DynamicRenderState State;
+                State.CullMode              = GraphicsPipeline.RasterizerDesc.CullMode;
+                State.FrontCounterClockwise = GraphicsPipeline.RasterizerDesc.FrontCounterClockwise;
+                State.PrimitiveTopology     = GraphicsPipeline.PrimitiveTopology;
+                State.DepthStencilDesc      = GraphicsPipeline.DepthStencilDesc;
+                CommitDynamicRenderState(State);
+            }
+
             if (CommitStates)
             {
                 m_CommandBuffer.SetStencilReference(m_StencilRef);
@@ -366,10 +421,20 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     {
         // Do not clear DescriptorSetBaseInd and DynamicOffsetCount!
         BindInfo.SetInfo[sign].vkSets.fill(VK_NULL_HANDLE);
+        BindInfo.SetInfo[sign].NumDescrBufferSets    = 0;
+        BindInfo.SetInfo[sign].DeferredDynamicSetInd = ~0u;
+        BindInfo.IntactSRBMask &= ~(1u << sign);
     }
 #endif
 
+    if (BindInfo.vkPipelineLayout != Layout.GetVkPipelineLayout())
+    {
+        // Descriptor set indices may be different in the new layout,
+        // so all SRBs must be bound again when they are committed.
+        BindInfo.IntactSRBMask = 0;
+    }
     BindInfo.vkPipelineLayout = Layout.GetVkPipelineLayout();
+    BindInfo.PushDescrSetSign = Layout.GetPushDescrSetBindIndex();
 
     Uint32 TotalDynamicOffsetCount = 0;
     for (Uint32 i = 0; i < SignCount; ++i)
@@ -380,6 +445,7 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
         if (pSignature == nullptr || pSignature->GetNumDescriptorSets() == 0)
         {
             SetInfo = {};
+            BindInfo.IntactSRBMask &= ~(1u << i);
             continue;
         }
 
@@ -421,37 +487,77 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
 {
     VERIFY(CommitSRBMask != 0, "This method should not be called when there is nothing to commit");
 
+    if (m_pDevice->IsDescriptorBufferEnabled())
+    {
+        CommitDescriptorBufferSets(BindInfo, CommitSRBMask);
+        return;
+    }
+
     const auto FirstSign = PlatformMisc::GetLSB(CommitSRBMask);
     const auto LastSign  = PlatformMisc::GetMSB(CommitSRBMask);
     VERIFY_EXPR(LastSign < m_pPipelineState->GetResourceSignatureCount());
 
-    // Bind all descriptor sets in a single BindDescriptorSets call
-    uint32_t   DynamicOffsetCount = 0;
-    uint32_t   TotalSetCount      = 0;
-    const auto FirstSetToBind     = BindInfo.SetInfo[FirstSign].BaseInd;
+    // Bind all descriptor sets in as few BindDescriptorSets calls as possible. The only reason to
+    // split the calls is the push descriptor set as it can't be bound with vkCmdBindDescriptorSets.
+    uint32_t DynamicOffsetCount = 0;
+    uint32_t BatchFirstOffset   = 0;
+    uint32_t TotalSetCount      = 0;
+    auto     FirstSetToBind     = BindInfo.SetInfo[FirstSign].BaseInd;
+
+    VERIFY_EXPR(m_State.vkPipelineBindPoint != VK_PIPELINE_BIND_POINT_MAX_ENUM);
+    const auto FlushBoundSets = [&]() {
+        if (TotalSetCount == 0)
+            return;
+
+        // vkCmdBindDescriptorSets causes the sets numbered [firstSet .. firstSet+descriptorSetCount-1] to use the
+        // bindings stored in pDescriptorSets[0 .. descriptorSetCount-1] for subsequent rendering commands
+        // (either compute or graphics, according to the pipelineBindPoint). Any bindings that were previously
+        // applied via these sets are no longer valid.
+        // https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/vkCmdBindDescriptorSets.html
+        m_CommandBuffer.BindDescriptorSets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, FirstSetToBind, TotalSetCount,
+                                           m_DescriptorSets.data(), DynamicOffsetCount - BatchFirstOffset, m_DynamicBufferOffsets.data() + BatchFirstOffset);
+        BatchFirstOffset = DynamicOffsetCount;
+        TotalSetCount    = 0;
+    };
+
     for (Uint32 sign = FirstSign; sign <= LastSign; ++sign)
     {
-        auto& SetInfo = BindInfo.SetInfo[sign];
-        VERIFY(SetInfo.vkSets[0] != VK_NULL_HANDLE || (CommitSRBMask & (1u << sign)) == 0,
+        auto&      SetInfo = BindInfo.SetInfo[sign];
+        const bool HasSets = SetInfo.vkSets[0] != VK_NULL_HANDLE || SetInfo.DeferredDynamicSetInd != ~0u;
+        VERIFY(HasSets || (CommitSRBMask & (1u << sign)) == 0,
                "At least one descriptor set in the stale SRB must not be NULL. Empty SRBs should not be marked as stale by CommitShaderResources()");
 
-        VERIFY((BindInfo.ActiveSRBMask & (1u << sign)) != 0 || SetInfo.vkSets[0] == VK_NULL_HANDLE, "Descriptor sets must be null for inactive slots");
-        if (SetInfo.vkSets[0] == VK_NULL_HANDLE)
+        VERIFY((BindInfo.ActiveSRBMask & (1u << sign)) != 0 || !HasSets, "Descriptor sets must be null for inactive slots");
+        if (!HasSets)
         {
             VERIFY_EXPR(SetInfo.vkSets[1] == VK_NULL_HANDLE);
             continue;
         }
 
+        const auto* pResourceCache = BindInfo.ResourceCaches[sign];
+        DEV_CHECK_ERR(pResourceCache != nullptr, "Resource cache at binding index ", sign, " is null, but corresponding descriptor set is not");
+
+        const bool PushDynamicSet = SetInfo.DeferredDynamicSetInd != ~0u && sign == BindInfo.PushDescrSetSign;
+        if (SetInfo.DeferredDynamicSetInd != ~0u && !PushDynamicSet && SetInfo.vkSets[SetInfo.DeferredDynamicSetInd] == VK_NULL_HANDLE)
+        {
+            // The pipeline layout uses a regular descriptor set for this signature
+            SetInfo.vkSets[SetInfo.DeferredDynamicSetInd] = AllocateAndWriteDynamicDescriptorSet(*m_pPipelineState->GetResourceSignature(sign), *pResourceCache);
+        }
+
+        if (TotalSetCount == 0)
+            FirstSetToBind = SetInfo.BaseInd;
+
         VERIFY_EXPR(SetInfo.BaseInd >= FirstSetToBind + TotalSetCount);
         while (FirstSetToBind + TotalSetCount < SetInfo.BaseInd)
             m_DescriptorSets[TotalSetCount++] = VK_NULL_HANDLE;
 
-        const auto* pResourceCache = BindInfo.ResourceCaches[sign];
-        DEV_CHECK_ERR(pResourceCache != nullptr, "Resource cache at binding index ", sign, " is null, but corresponding descriptor set is not");
-
-        m_DescriptorSets[TotalSetCount++] = SetInfo.vkSets[0];
-        if (SetInfo.vkSets[1] != VK_NULL_HANDLE)
-            m_DescriptorSets[TotalSetCount++] = SetInfo.vkSets[1];
+        for (Uint32 s = 0; s < MAX_DESCR_SET_PER_SIGNATURE; ++s)
+        {
+            if (PushDynamicSet && s == SetInfo.DeferredDynamicSetInd)
+                break; // The dynamic set is always the last one
+            if (SetInfo.vkSets[s] != VK_NULL_HANDLE)
+                m_DescriptorSets[TotalSetCount++] = SetInfo.vkSets[s];
+        }
 
         if (SetInfo.DynamicOffsetCount > 0)
         {
@@ -463,6 +569,15 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
             DynamicOffsetCount += SetInfo.DynamicOffsetCount;
         }
 
+        if (PushDynamicSet)
+        {
+            // Descriptor sets with lower indices must be bound first as vkCmdBindDescriptorSets
+            // can't be used for the push descriptor set.
+            FlushBoundSets();
+            m_pPipelineState->GetResourceSignature(sign)->PushDynamicResources(*pResourceCache, m_CommandBuffer, m_State.vkPipelineBindPoint,
+                                                                               BindInfo.vkPipelineLayout, SetInfo.BaseInd + SetInfo.DeferredDynamicSetInd);
+        }
+
 #ifdef DILIGENT_DEVELOPMENT
         SetInfo.LastBoundBaseInd = SetInfo.BaseInd;
 #endif
@@ -470,15 +585,64 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
 
     // Note that there is one global dynamic buffer from which all dynamic resources are suballocated in Vulkan back-end,
     // and this buffer is not resizable, so the buffer handle can never change.
+    FlushBoundSets();
 
-    // vkCmdBindDescriptorSets causes the sets numbered [firstSet .. firstSet+descriptorSetCount-1] to use the
-    // bindings stored in pDescriptorSets[0 .. descriptorSetCount-1] for subsequent rendering commands
-    // (either compute or graphics, according to the pipelineBindPoint). Any bindings that were previously
-    // applied via these sets are no longer valid.
-    // https://www.khronos.org/registry/vulkan/specs/1.3-extensions/man/html/vkCmdBindDescriptorSets.html
-    VERIFY_EXPR(m_State.vkPipelineBindPoint != VK_PIPELINE_BIND_POINT_MAX_ENUM);
-    m_CommandBuffer.BindDescriptorSets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, FirstSetToBind, TotalSetCount,
-                                       m_DescriptorSets.data(), DynamicOffsetCount, m_DynamicBufferOffsets.data());
+    BindInfo.StaleSRBMask &= ~BindInfo.ActiveSRBMask;
+}
+
+void DeviceContextVkImpl::CommitDescriptorBufferSets(ResourceBindInfo& BindInfo, Uint32 CommitSRBMask)
+{
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+    const auto& DynamicMemMgr = m_pDevice->GetDynamicMemoryManager();
+    const auto  Alignment     = static_cast<Uint32>(m_pDevice->GetPhysicalDevice().GetExtProperties().DescriptorBuffer.descriptorBufferOffsetAlignment);
+
+    // All descriptor sets are suballocated from the dynamic heap, and the heap buffer never changes,
+    // so it only needs to be bound once per command buffer.
+    m_CommandBuffer.BindDescriptorBuffer(DynamicMemMgr.GetVkDeviceAddress(),
+                                         VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT);
+
+    const auto FirstSign = PlatformMisc::GetLSB(CommitSRBMask);
+    const auto LastSign  = PlatformMisc::GetMSB(CommitSRBMask);
+    VERIFY_EXPR(LastSign < m_pPipelineState->GetResourceSignatureCount());
+
+    // All sets use the same buffer
+    static constexpr uint32_t BufferIndices[MAX_DESCR_SET_PER_SIGNATURE] = {};
+
+    for (Uint32 sign = FirstSign; sign <= LastSign; ++sign)
+    {
+        auto& SetInfo = BindInfo.SetInfo[sign];
+        VERIFY(SetInfo.NumDescrBufferSets != 0 || (CommitSRBMask & (1u << sign)) == 0,
+               "At least one descriptor set in the stale SRB must not be empty. Empty SRBs should not be marked as stale by CommitShaderResources()");
+        if (SetInfo.NumDescrBufferSets == 0)
+            continue;
+
+        const auto* pResourceCache = BindInfo.ResourceCaches[sign];
+        DEV_CHECK_ERR(pResourceCache != nullptr, "Resource cache at binding index ", sign, " is null, but corresponding descriptor set is not");
+
+        std::array<VkDeviceSize, MAX_DESCR_SET_PER_SIGNATURE> Offsets = {};
+        for (Uint32 s = 0; s < SetInfo.NumDescrBufferSets; ++s)
+        {
+            const Uint32 DataSize   = pResourceCache->GetDescriptorSet(s).GetDescriptorDataSize();
+            auto         Allocation = AllocateDynamicSpace(DataSize, Alignment);
+            if (!Allocation)
+            {
+                LOG_ERROR_MESSAGE("Failed to allocate ", DataSize, " bytes in the dynamic heap for descriptor buffer data. Increase the dynamic heap size.");
+                return;
+            }
+
+            pResourceCache->WriteDescriptorBufferData(LogicalDevice, GetContextId(), s, DynamicMemMgr.GetCPUAddress() + Allocation.AlignedOffset);
+            m_Stats.DescriptorBytesCopied += DataSize;
+            Offsets[s] = Allocation.AlignedOffset;
+        }
+
+        VERIFY_EXPR(m_State.vkPipelineBindPoint != VK_PIPELINE_BIND_POINT_MAX_ENUM);
+        m_CommandBuffer.SetDescriptorBufferOffsets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, SetInfo.BaseInd,
+                                                   SetInfo.NumDescrBufferSets, BufferIndices, Offsets.data());
+
+#ifdef DILIGENT_DEVELOPMENT
+        SetInfo.LastBoundBaseInd = SetInfo.BaseInd;
+#endif
+    }
 
     BindInfo.StaleSRBMask &= ~BindInfo.ActiveSRBMask;
 }
@@ -504,7 +668,7 @@ void DeviceContextVkImpl::DvpValidateCommittedShaderResources(ResourceBindInfo&
         const auto  DSCount = pSign->GetNumDescriptorSets();
         for (Uint32 s = 0; s < DSCount; ++s)
         {
-            DEV_CHECK_ERR(SetInfo.vkSets[s] != VK_NULL_HANDLE,
+            DEV_CHECK_ERR(SetInfo.vkSets[s] != VK_NULL_HANDLE || s < SetInfo.NumDescrBufferSets || s == SetInfo.DeferredDynamicSetInd,
                           "descriptor set with index ", s, " is not bound for resource signature '",
                           pSign->GetDesc().Name, "', binding index ", i, ".");
         }
@@ -534,6 +698,8 @@ void DeviceContextVkImpl::TransitionShaderResources(IShaderResourceBinding* pSha
 
 void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextVkImpl::CommitShaderResources");
+
     TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     auto* pResBindingVkImpl = ClassPtrCast<ShaderResourceBindingVkImpl>(pShaderResourceBinding);
@@ -564,10 +730,29 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
     auto&       BindInfo   = GetBindInfo(pResBindingVkImpl->GetPipelineType());
     auto&       SetInfo    = BindInfo.SetInfo[SRBIndex];
 
+    if (BindInfo.IsIntact(SRBIndex, ResourceCache))
+    {
+        // The SRB is already committed and its resources have not changed since then,
+        // so the descriptor sets bound to the command buffer are up to date.
+        // Dynamic buffer offsets are handled by CommitDescriptorSets() through the DynamicSRBMask.
+        ++m_Stats.CommandCounters.RedundantCommitShaderResources;
+        return;
+    }
+
     BindInfo.Set(SRBIndex, pResBindingVkImpl);
     // We must not clear entire ResInfo as DescriptorSetBaseInd and DynamicOffsetCount
     // are set by SetPipelineState().
-    SetInfo.vkSets = {};
+    SetInfo.vkSets                = {};
+    SetInfo.NumDescrBufferSets    = 0;
+    SetInfo.DeferredDynamicSetInd = ~0u;
+
+    if (m_pDevice->IsDescriptorBufferEnabled())
+    {
+        // Descriptor data is kept in the resource cache and is written to the
+        // descriptor buffer by CommitDescriptorBufferSets().
+        SetInfo.NumDescrBufferSets = ResourceCache.GetNumDescriptorSets();
+        return;
+    }
 
     Uint32 DSIndex = 0;
     if (pSignature->HasDescriptorSet(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE))
@@ -584,28 +769,42 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
         VERIFY_EXPR(DSIndex == pSignature->GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC>());
         VERIFY_EXPR(const_cast<const ShaderResourceCacheVk&>(ResourceCache).GetDescriptorSet(DSIndex).GetVkDescriptorSet() == VK_NULL_HANDLE);
 
-        const auto vkLayout = pSignature->GetVkDescriptorSetLayout(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC);
+        if (pSignature->HasPushDescriptorSetLayout())
+        {
+            // Whether the set is pushed or allocated depends on the pipeline layout, which may not be known yet.
+            // CommitDescriptorSets() will handle the set.
+            SetInfo.DeferredDynamicSetInd = DSIndex;
+        }
+        else
+        {
+            SetInfo.vkSets[DSIndex] = AllocateAndWriteDynamicDescriptorSet(*pSignature, ResourceCache);
+        }
+        ++DSIndex;
+    }
+
+    VERIFY_EXPR(DSIndex == ResourceCache.GetNumDescriptorSets());
+}
+
+VkDescriptorSet DeviceContextVkImpl::AllocateAndWriteDynamicDescriptorSet(const PipelineResourceSignatureVkImpl& Signature,
+                                                                          const ShaderResourceCacheVk&           ResourceCache)
+{
+    const auto vkLayout = Signature.GetVkDescriptorSetLayout(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC);
 
-        VkDescriptorSet vkDynamicDescrSet   = VK_NULL_HANDLE;
-        const char*     DynamicDescrSetName = "Dynamic Descriptor Set";
+    const char* DynamicDescrSetName = "Dynamic Descriptor Set";
 #ifdef DILIGENT_DEVELOPMENT
-        String _DynamicDescrSetName{DynamicDescrSetName};
-        _DynamicDescrSetName.append(" (");
-        _DynamicDescrSetName.append(pSignature->GetDesc().Name);
-        _DynamicDescrSetName += ')';
-        DynamicDescrSetName = _DynamicDescrSetName.c_str();
+    String _DynamicDescrSetName{DynamicDescrSetName};
+    _DynamicDescrSetName.append(" (");
+    _DynamicDescrSetName.append(Signature.GetDesc().Name);
+    _DynamicDescrSetName += ')';
+    DynamicDescrSetName = _DynamicDescrSetName.c_str();
 #endif
-        // Allocate vulkan descriptor set for dynamic resources
-        vkDynamicDescrSet = AllocateDynamicDescriptorSet(vkLayout, DynamicDescrSetName);
-
-        // Write all dynamic resource descriptors
-        pSignature->CommitDynamicResources(ResourceCache, vkDynamicDescrSet);
+    // Allocate vulkan descriptor set for dynamic resources
+    VkDescriptorSet vkDynamicDescrSet = AllocateDynamicDescriptorSet(vkLayout, DynamicDescrSetName);
 
-        SetInfo.vkSets[DSIndex] = vkDynamicDescrSet;
-        ++DSIndex;
-    }
+    // Write all dynamic resource descriptors
+    Signature.CommitDynamicResources(ResourceCache, vkDynamicDescrSet);
 
-    VERIFY_EXPR(DSIndex == ResourceCache.GetNumDescriptorSets());
+    return vkDynamicDescrSet;
 }
 
 void DeviceContextVkImpl::SetStencilRef(Uint32 StencilRef)
@@ -727,7 +926,7 @@ void DeviceContextVkImpl::DvpLogRenderPass_PSOMismatch()
 
 void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 {
-    if (m_vkFramebuffer == VK_NULL_HANDLE && m_State.NullRenderTargets)
+    if (m_vkFramebuffer == VK_NULL_HANDLE && !m_DynamicRendering.IsValid && m_State.NullRenderTargets)
     {
         DEV_CHECK_ERR(m_FramebufferWidth > 0 && m_FramebufferHeight > 0,
                       "Framebuffer width/height is zero. Call SetViewports to set the framebuffer sizes when no render targets are set.");
@@ -735,11 +934,18 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     }
 
 #ifdef DILIGENT_DEVELOPMENT
+    DEV_CHECK_ERR(!m_SecondaryCmdBuffersRenderPass || IsDeferred(),
+                  "Draw commands can't be recorded by the immediate context inside a render pass that was begun with "
+                  "BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS flag. Record them into deferred contexts that inherit the render pass.");
+
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
         DvpVerifyRenderTargets();
 
-    VERIFY(m_vkRenderPass != VK_NULL_HANDLE, "No render pass is active while executing draw command");
-    VERIFY(m_vkFramebuffer != VK_NULL_HANDLE, "No framebuffer is bound while executing draw command");
+    if (!m_DynamicRendering.IsValid)
+    {
+        VERIFY(m_vkRenderPass != VK_NULL_HANDLE, "No render pass is active while executing draw command");
+        VERIFY(m_vkFramebuffer != VK_NULL_HANDLE, "No framebuffer is bound while executing draw command");
+    }
 #endif
 
     EnsureVkCmdBuffer();
@@ -778,7 +984,10 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     if (m_pPipelineState->GetGraphicsPipelineDesc().pRenderPass == nullptr)
     {
 #ifdef DILIGENT_DEVELOPMENT
-        if (m_pPipelineState->GetRenderPass()->GetVkRenderPass() != m_vkRenderPass)
+        // Pipelines that use dynamic rendering have no render pass
+        const auto*        pPSORenderPass  = m_pPipelineState->GetRenderPass();
+        const VkRenderPass vkPSORenderPass = pPSORenderPass != nullptr ? pPSORenderPass->GetVkRenderPass() : VK_NULL_HANDLE;
+        if (vkPSORenderPass != m_vkRenderPass)
         {
             // Note that different Vulkan render passes may still be compatible,
             // so we should only verify implicit render passes
@@ -825,6 +1034,7 @@ void DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE Ind
 
 void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::Draw(Attribs, 0);
 
     PrepareForDraw(Attribs.Flags);
@@ -838,6 +1048,7 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 
 void DeviceContextVkImpl::MultiDraw(const MultiDrawAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDraw(Attribs, 0);
 
     PrepareForDraw(Attribs.Flags);
@@ -881,6 +1092,7 @@ void DeviceContextVkImpl::MultiDraw(const MultiDrawAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexed(Attribs, 0);
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
@@ -894,6 +1106,7 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 
 void DeviceContextVkImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDrawIndexed(Attribs, 0);
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
@@ -937,6 +1150,7 @@ void DeviceContextVkImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attrib
 
 void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndirect(Attribs, 0);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -972,6 +1186,7 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexedIndirect(Attribs, 0);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -1007,6 +1222,7 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 
 void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawMesh(Attribs, 0);
 
     PrepareForDraw(Attribs.Flags);
@@ -1020,6 +1236,7 @@ void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 
 void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawMeshIndirect(Attribs, 0);
 
     // We must prepare indirect draw attribs buffer first because state transitions must
@@ -1059,7 +1276,7 @@ void DeviceContextVkImpl::PrepareForDispatchCompute()
     EnsureVkCmdBuffer();
 
     // Dispatch commands must be executed outside of render pass
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    if (m_CommandBuffer.IsInRenderPass())
         m_CommandBuffer.EndRenderPass();
 
     auto& BindInfo = GetBindInfo(PIPELINE_TYPE_COMPUTE);
@@ -1092,6 +1309,7 @@ void DeviceContextVkImpl::PrepareForRayTracing()
 
 void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchCompute(Attribs, 0);
 
     PrepareForDispatchCompute();
@@ -1105,6 +1323,7 @@ void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
 void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchComputeIndirect(Attribs, 0);
 
     PrepareForDispatchCompute();
@@ -1162,12 +1381,27 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
            "checks if the DSV is bound as a framebuffer attachment and triggers an assert otherwise (in development mode).");
     if (ClearAsAttachment)
     {
-        VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR((m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE) || m_DynamicRendering.IsValid);
         if (m_pActiveRenderPass == nullptr)
         {
             // Render pass may not be currently committed
 
             TransitionRenderTargets(StateTransitionMode);
+            if (!m_ImplicitRenderPass.Started)
+            {
+                // Start the render pass instance with the clear load operation, which
+                // saves loading the attachment into the tile memory on tile-based GPUs.
+                if (ClearFlags & CLEAR_DEPTH_FLAG)
+                    m_ImplicitRenderPass.Ops.DepthLoadOp = ATTACHMENT_LOAD_OP_CLEAR;
+                if (ClearFlags & CLEAR_STENCIL_FLAG)
+                    m_ImplicitRenderPass.Ops.StencilLoadOp = ATTACHMENT_LOAD_OP_CLEAR;
+                m_ImplicitRenderPass.DSVClearValue.depthStencil.depth   = fDepth;
+                m_ImplicitRenderPass.DSVClearValue.depthStencil.stencil = Stencil;
+                // No need to verify states again
+                CommitRenderPassAndFramebuffer(false);
+                ++m_State.NumCommands;
+                return;
+            }
             // No need to verify states again
             CommitRenderPassAndFramebuffer(false);
         }
@@ -1194,15 +1428,16 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
     else
     {
         // End render pass to clear the buffer with vkCmdClearDepthStencilImage
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         auto* pTexture   = pVkDSV->GetTexture();
         auto* pTextureVk = ClassPtrCast<TextureVkImpl>(pTexture);
 
         // Image layout must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL (17.1)
+        const auto SubresRange = pTextureVk->GetViewSubresourceRange(pVkDSV->GetDesc());
         TransitionOrVerifyTextureState(*pTextureVk, StateTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                       "Clearing depth-stencil buffer outside of render pass (DeviceContextVkImpl::ClearDepthStencil)");
+                                       "Clearing depth-stencil buffer outside of render pass (DeviceContextVkImpl::ClearDepthStencil)", &SubresRange);
 
         VkClearDepthStencilValue ClearValue;
         ClearValue.depth   = fDepth;
@@ -1280,12 +1515,22 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const void* RGB
 
     if (attachmentIndex != InvalidAttachmentIndex)
     {
-        VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR((m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE) || m_DynamicRendering.IsValid);
         if (m_pActiveRenderPass == nullptr)
         {
             // Render pass may not be currently committed
 
             TransitionRenderTargets(StateTransitionMode);
+            if (!m_ImplicitRenderPass.Started)
+            {
+                // Start the render pass instance with the clear load operation (see ClearDepthStencil)
+                m_ImplicitRenderPass.Ops.RTVLoadOps[attachmentIndex]      = ATTACHMENT_LOAD_OP_CLEAR;
+                m_ImplicitRenderPass.RTVClearValues[attachmentIndex].color = ClearValueToVkClearValue(RGBA, ViewDesc.Format);
+                // No need to verify states again
+                CommitRenderPassAndFramebuffer(false);
+                ++m_State.NumCommands;
+                return;
+            }
             // No need to verify states again
             CommitRenderPassAndFramebuffer(false);
         }
@@ -1314,15 +1559,16 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const void* RGB
         VERIFY(m_pActiveRenderPass == nullptr, "This branch should never execute inside a render pass.");
 
         // End current render pass and clear the image with vkCmdClearColorImage
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         auto* pTexture   = pVkRTV->GetTexture();
         auto* pTextureVk = ClassPtrCast<TextureVkImpl>(pTexture);
 
         // Image layout must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL (17.1)
+        const auto SubresRange = pTextureVk->GetViewSubresourceRange(ViewDesc);
         TransitionOrVerifyTextureState(*pTextureVk, StateTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                       "Clearing render target outside of render pass (DeviceContextVkImpl::ClearRenderTarget)");
+                                       "Clearing render target outside of render pass (DeviceContextVkImpl::ClearRenderTarget)", &SubresRange);
 
         auto ClearValue = ClearValueToVkClearValue(RGBA, ViewDesc.Format);
 
@@ -1385,6 +1631,13 @@ void DeviceContextVkImpl::FinishFrame()
     if (!m_MappedTextures.empty())
         LOG_ERROR_MESSAGE("There are mapped textures in the device context when finishing the frame. All dynamic resources must be used in the same frame in which they are mapped.");
 
+    if (m_pAsyncUploadCtx)
+    {
+        // This context will wait for the uploads the next time it is flushed
+        SubmitAsyncUploads();
+        m_pAsyncUploadCtx->FinishFrame();
+    }
+
     const Uint64 QueueMask = GetSubmittedBuffersCmdQueueMask();
     VERIFY_EXPR(IsDeferred() || QueueMask == (Uint64{1} << GetCommandQueueId()));
 
@@ -1405,11 +1658,22 @@ void DeviceContextVkImpl::FinishFrame()
     // be destroyed before the pools are actually returned to the global pool manager.
     m_DynamicDescrSetAllocator.ReleasePools(QueueMask);
 
+    if (!IsDeferred())
+    {
+        // Submit the work batched by the command queue during the frame (see EngineVkCreateInfo::SubmitBatchSize)
+        auto* pQueueVk = ClassPtrCast<CommandQueueVkImpl>(LockCommandQueue());
+        if (pQueueVk->IsSubmitBatchingEnabled())
+            pQueueVk->FlushBatchedSubmits();
+        UnlockCommandQueue();
+    }
+
     EndFrame();
 }
 
 void DeviceContextVkImpl::Flush()
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextVkImpl::Flush");
+
     Flush(0, nullptr);
 }
 
@@ -1425,9 +1689,21 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr,
                   "Flushing device context inside an active render pass.");
 
-    // TODO: replace with small_vector
-    std::vector<VkCommandBuffer>               vkCmdBuffs;
-    std::vector<RefCntAutoPtr<IDeviceContext>> DeferredCtxs;
+    DEV_CHECK_ERR(!m_DvpConditionalRenderingActive,
+                  "Flushing device context with active conditional rendering. Conditional rendering must begin and end in the same command buffer.");
+
+    // Submit async uploads first so that this submission can wait for them
+    SubmitAsyncUploads();
+    if (m_AsyncUploadSignaledValue > m_AsyncUploadWaitedValue)
+    {
+        m_WaitFences.emplace_back(m_AsyncUploadSignaledValue, m_pAsyncUploadFence);
+        m_AsyncUploadWaitedValue = m_AsyncUploadSignaledValue;
+    }
+    m_AsyncUploadResources.clear();
+
+    std::vector<VkCommandBuffer>&               vkCmdBuffs   = m_ScratchVkCmdBuffs;
+    std::vector<RefCntAutoPtr<IDeviceContext>>& DeferredCtxs = m_ScratchDeferredCtxs;
+    VERIFY_EXPR(vkCmdBuffs.empty() && DeferredCtxs.empty());
     vkCmdBuffs.reserve(size_t{NumCommandLists} + 1);
     DeferredCtxs.reserve(size_t{NumCommandLists} + 1);
 
@@ -1444,7 +1720,7 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
 
         if (m_State.NumCommands != 0)
         {
-            if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+            if (m_CommandBuffer.IsInRenderPass())
             {
                 m_CommandBuffer.EndRenderPass();
             }
@@ -1456,6 +1732,7 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
 
             m_CommandBuffer.FlushBarriers();
             m_CommandBuffer.EndCommandBuffer();
+            m_Stats.BarrierCount += m_CommandBuffer.ExtractNumBarriers();
 
             vkCmdBuffs.push_back(vkCmdBuff);
         }
@@ -1556,6 +1833,7 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
 
     // Submit command buffer even if there are no commands to release stale resources.
     auto SubmittedFenceValue = m_pDevice->ExecuteCommandBuffer(GetCommandQueueId(), SubmitInfo, &m_SignalFences);
+    ++m_Stats.SubmitCount;
 
     // Recycle semaphores
     {
@@ -1596,6 +1874,16 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
         pDeferredCtxVkImpl->DisposeVkCmdBuffer(GetCommandQueueId(), std::move(vkCmdBuffs[buff_idx]), SubmittedFenceValue);
     }
     VERIFY_EXPR(buff_idx == vkCmdBuffs.size());
+    vkCmdBuffs.clear();
+    DeferredCtxs.clear();
+
+    // Secondary command buffers were executed by the primary command buffer that has just been submitted
+    for (auto& CtxAndBuff : m_ExecutedSecondaryCmdBuffers)
+    {
+        CtxAndBuff.first->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
+        CtxAndBuff.first->DisposeVkCmdBuffer(GetCommandQueueId(), CtxAndBuff.second, SubmittedFenceValue, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    }
+    m_ExecutedSecondaryCmdBuffers.clear();
 
     m_State    = {};
     m_BindInfo = {};
@@ -1612,7 +1900,7 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+    const bool StreamsChanged = TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags, 0);
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
         auto& CurrStream = m_VertexStreams[Buff];
@@ -1622,7 +1910,8 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
                                           "Setting vertex buffers (DeviceContextVkImpl::SetVertexBuffers)");
         }
     }
-    m_State.CommittedVBsUpToDate = false;
+    if (StreamsChanged)
+        m_State.CommittedVBsUpToDate = false;
 }
 
 void DeviceContextVkImpl::InvalidateState()
@@ -1636,18 +1925,21 @@ void DeviceContextVkImpl::InvalidateState()
     m_vkRenderPass  = VK_NULL_HANDLE;
     m_vkFramebuffer = VK_NULL_HANDLE;
 
-    VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Invalidating context with unfinished render pass");
+    m_DynamicRendering.IsValid = false;
+
+    VERIFY(!m_CommandBuffer.IsInRenderPass(), "Invalidating context with unfinished render pass");
     m_CommandBuffer.Reset();
 }
 
 void DeviceContextVkImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    const bool IndexBufferChanged = TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode, 0);
     if (m_pIndexBuffer)
     {
         TransitionOrVerifyBufferState(*m_pIndexBuffer, StateTransitionMode, RESOURCE_STATE_INDEX_BUFFER, VK_ACCESS_INDEX_READ_BIT, "Binding buffer as index buffer  (DeviceContextVkImpl::SetIndexBuffer)");
     }
-    m_State.CommittedIBUpToDate = false;
+    if (IndexBufferChanged)
+        m_State.CommittedIBUpToDate = false;
 }
 
 
@@ -1700,7 +1992,7 @@ void DeviceContextVkImpl::CommitViewports()
 
 void DeviceContextVkImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+    const bool ViewportsChanged = TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
 
     if (m_State.NullRenderTargets)
@@ -1713,6 +2005,8 @@ void DeviceContextVkImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
         {
             // We need to bind another framebuffer since the size has changed
             m_vkFramebuffer = VK_NULL_HANDLE;
+
+            m_DynamicRendering.IsValid = false;
         }
         m_FramebufferWidth   = VPWidth;
         m_FramebufferHeight  = VPHeight;
@@ -1722,7 +2016,7 @@ void DeviceContextVkImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
 
     // If no graphics PSO is currently bound, viewports will be committed by
     // the SetPipelineState() when a graphics PSO is set.
-    if (m_pPipelineState && m_pPipelineState->GetDesc().IsAnyGraphicsPipeline())
+    if (ViewportsChanged && m_pPipelineState && m_pPipelineState->GetDesc().IsAnyGraphicsPipeline())
     {
         CommitViewports();
     }
@@ -1751,7 +2045,8 @@ void DeviceContextVkImpl::CommitScissorRects()
 
 void DeviceContextVkImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+    if (!TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        return;
 
     // Only commit scissor rects if scissor test is enabled in the rasterizer state.
     // If scissor is currently disabled, or no PSO is bound, scissor rects will be committed by
@@ -1783,18 +2078,20 @@ void DeviceContextVkImpl::TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE
             VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL :
             VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
-        auto* pDepthBufferVk = m_pBoundDepthStencil->GetTexture<TextureVkImpl>();
+        auto*      pDepthBufferVk = m_pBoundDepthStencil->GetTexture<TextureVkImpl>();
+        const auto SubresRange    = pDepthBufferVk->GetViewSubresourceRange(m_pBoundDepthStencil->GetDesc());
         TransitionOrVerifyTextureState(*pDepthBufferVk, StateTransitionMode, NewState, ExpectedLayout,
-                                       "Binding depth-stencil buffer (DeviceContextVkImpl::TransitionRenderTargets)");
+                                       "Binding depth-stencil buffer (DeviceContextVkImpl::TransitionRenderTargets)", &SubresRange);
     }
 
     for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
     {
         if (auto& pRTVVk = m_pBoundRenderTargets[rt])
         {
-            auto* pRenderTargetVk = pRTVVk->GetTexture<TextureVkImpl>();
+            auto*      pRenderTargetVk = pRTVVk->GetTexture<TextureVkImpl>();
+            const auto SubresRange     = pRenderTargetVk->GetViewSubresourceRange(pRTVVk->GetDesc());
             TransitionOrVerifyTextureState(*pRenderTargetVk, StateTransitionMode, RESOURCE_STATE_RENDER_TARGET, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                                           "Binding render targets (DeviceContextVkImpl::TransitionRenderTargets)");
+                                           "Binding render targets (DeviceContextVkImpl::TransitionRenderTargets)", &SubresRange);
         }
     }
 
@@ -1816,9 +2113,29 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
     VERIFY(m_pActiveRenderPass == nullptr, "This method must not be called inside an active render pass.");
 
     const auto& CmdBufferState = m_CommandBuffer.GetState();
-    if (CmdBufferState.Framebuffer != m_vkFramebuffer)
+    if (m_DynamicRendering.IsValid)
+    {
+        VERIFY_EXPR(m_vkRenderPass == VK_NULL_HANDLE && m_vkFramebuffer == VK_NULL_HANDLE);
+        if (!CmdBufferState.DynamicRendering)
+        {
+            if (m_CommandBuffer.IsInRenderPass())
+                m_CommandBuffer.EndRenderPass();
+
+#ifdef DILIGENT_DEVELOPMENT
+            if (VerifyStates)
+            {
+                TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            }
+#endif
+            BeginImplicitRenderPass();
+        }
+    }
+    else if (CmdBufferState.Framebuffer != m_vkFramebuffer ||
+             // The framebuffer may still be in use by the instance started for the previous
+             // binding of the same render targets, with different load and store operations.
+             (!m_ImplicitRenderPass.Started && !m_ImplicitRenderPass.Ops.IsDefault()))
     {
-        if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         if (m_vkFramebuffer != VK_NULL_HANDLE)
@@ -1830,13 +2147,188 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
                 TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE_VERIFY);
             }
 #endif
-            m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight);
+            BeginImplicitRenderPass();
         }
     }
 }
 
+void DeviceContextVkImpl::InitImplicitRenderPassOps()
+{
+    auto& Ops = m_ImplicitRenderPass.Ops;
+
+    Ops                          = {};
+    m_ImplicitRenderPass.Started = false;
+
+    if (m_RenderTargetsFlags & SET_RENDER_TARGETS_FLAG_DISCARD_RENDER_TARGETS)
+    {
+        for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+            Ops.RTVLoadOps[rt] = ATTACHMENT_LOAD_OP_DISCARD;
+    }
+
+    if (m_pBoundDepthStencil)
+    {
+        if (m_RenderTargetsFlags & SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL)
+        {
+            Ops.DepthLoadOp   = ATTACHMENT_LOAD_OP_DISCARD;
+            Ops.StencilLoadOp = ATTACHMENT_LOAD_OP_DISCARD;
+        }
+        if (m_RenderTargetsFlags & SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL_ON_UNBIND)
+            Ops.DepthStencilStoreOp = ATTACHMENT_STORE_OP_DISCARD;
+    }
+}
+
+void DeviceContextVkImpl::BeginImplicitRenderPass()
+{
+    auto& Ops = m_ImplicitRenderPass.Ops;
+    if (m_ImplicitRenderPass.Started)
+    {
+        // The instance has been interrupted by a command that can't be executed inside a render pass:
+        // the attachments must be loaded, while the store operation is kept.
+        Ops.ResetLoadOps();
+#ifdef DILIGENT_DEVELOPMENT
+        if (Ops.DepthStencilStoreOp == ATTACHMENT_STORE_OP_DISCARD)
+        {
+            LOG_WARNING_MESSAGE_ONCE("Implicit render pass that discards the depth-stencil buffer (SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL_ON_UNBIND) "
+                                     "has been interrupted. The depth-stencil buffer contents are undefined.");
+        }
+#endif
+    }
+    m_ImplicitRenderPass.Started = true;
+
+    if (m_DynamicRendering.IsValid)
+    {
+        // Dynamic rendering attachments are copied since the load and store operations are set here.
+        std::array<VkRenderingAttachmentInfoKHR, MAX_RENDER_TARGETS> ColorAttachments;
+        for (Uint32 rt = 0; rt < m_DynamicRendering.NumColorAttachments; ++rt)
+        {
+            ColorAttachments[rt]            = m_DynamicRendering.ColorAttachments[rt];
+            ColorAttachments[rt].loadOp     = AttachmentLoadOpToVkAttachmentLoadOp(Ops.RTVLoadOps[rt]);
+            ColorAttachments[rt].clearValue = m_ImplicitRenderPass.RTVClearValues[rt];
+        }
+
+        VkRenderingAttachmentInfoKHR DepthAttachment = m_DynamicRendering.DepthStencilAttachment;
+        DepthAttachment.loadOp                       = AttachmentLoadOpToVkAttachmentLoadOp(Ops.DepthLoadOp);
+        DepthAttachment.storeOp                      = AttachmentStoreOpToVkAttachmentStoreOp(Ops.DepthStencilStoreOp);
+        DepthAttachment.clearValue                   = m_ImplicitRenderPass.DSVClearValue;
+
+        VkRenderingAttachmentInfoKHR StencilAttachment = DepthAttachment;
+        StencilAttachment.loadOp                       = AttachmentLoadOpToVkAttachmentLoadOp(Ops.StencilLoadOp);
+
+        VkRenderingInfoKHR RenderingInfo{};
+        RenderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        RenderingInfo.pNext                = nullptr;
+        RenderingInfo.flags                = 0;
+        RenderingInfo.renderArea           = {{0, 0}, {m_FramebufferWidth, m_FramebufferHeight}};
+        RenderingInfo.layerCount           = m_FramebufferSlices;
+        RenderingInfo.viewMask             = 0;
+        RenderingInfo.colorAttachmentCount = m_DynamicRendering.NumColorAttachments;
+        RenderingInfo.pColorAttachments    = m_DynamicRendering.NumColorAttachments > 0 ? ColorAttachments.data() : nullptr;
+        RenderingInfo.pDepthAttachment     = m_DynamicRendering.HasDepth ? &DepthAttachment : nullptr;
+        RenderingInfo.pStencilAttachment   = m_DynamicRendering.HasStencil ? &StencilAttachment : nullptr;
+        m_CommandBuffer.BeginRendering(RenderingInfo);
+        return;
+    }
+
+    VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+    if (Ops.IsDefault())
+    {
+        m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight);
+        return;
+    }
+
+    // Render passes that only differ in load and store operations are compatible (8.2),
+    // so the framebuffer created for m_vkRenderPass can be used with the variant.
+    auto& Key = m_ImplicitRenderPass.Key;
+    Key.SetOps(Ops);
+    auto* pRenderPass = m_pDevice->GetImplicitRenderPassCache().GetRenderPass(Key);
+    if (pRenderPass == nullptr)
+    {
+        UNEXPECTED("Unable to get implicit render pass with custom load and store operations");
+        m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight);
+        return;
+    }
+
+    // Clear values are indexed by attachment number, see GetImplicitRenderPassDesc()
+    std::array<VkClearValue, MAX_RENDER_TARGETS + 1> ClearValues;
+
+    Uint32 ClearValueCount = 0;
+    if (Key.DSVFormat != TEX_FORMAT_UNKNOWN)
+        ClearValues[ClearValueCount++] = m_ImplicitRenderPass.DSVClearValue;
+    for (Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt)
+    {
+        if (Key.RTVFormats[rt] != TEX_FORMAT_UNKNOWN)
+            ClearValues[ClearValueCount++] = m_ImplicitRenderPass.RTVClearValues[rt];
+    }
+
+    m_CommandBuffer.BeginRenderPass(pRenderPass->GetVkRenderPass(), m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, ClearValueCount, ClearValues.data());
+}
+
+void DeviceContextVkImpl::SetupDynamicRenderingAttachments()
+{
+    m_vkRenderPass  = VK_NULL_HANDLE;
+    m_vkFramebuffer = VK_NULL_HANDLE;
+
+    // Attachments of the active dynamic render pass instance can't be changed, so end it.
+    // Unlike framebuffers, there is no handle that CommitRenderPassAndFramebuffer() could compare.
+    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().DynamicRendering)
+        m_CommandBuffer.EndRenderPass();
+
+    auto InitAttachment = [](VkRenderingAttachmentInfoKHR& Attachment, VkImageView vkView, VkImageLayout vkLayout) {
+        Attachment                    = {};
+        Attachment.sType              = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        Attachment.pNext              = nullptr;
+        Attachment.imageView          = vkView;
+        Attachment.imageLayout        = vkLayout;
+        Attachment.resolveMode        = VK_RESOLVE_MODE_NONE;
+        Attachment.resolveImageView   = VK_NULL_HANDLE;
+        Attachment.resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        // Default load and store operations, BeginImplicitRenderPass() sets the actual ones
+        Attachment.loadOp  = VK_ATTACHMENT_LOAD_OP_LOAD;
+        Attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    };
+
+    m_DynamicRendering.NumColorAttachments = m_NumBoundRenderTargets;
+    for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+    {
+        // Null image views are ignored, and writes to the corresponding locations are discarded
+        auto* pRTVVk = m_pBoundRenderTargets[rt].RawPtr();
+        InitAttachment(m_DynamicRendering.ColorAttachments[rt],
+                       pRTVVk != nullptr ? pRTVVk->GetVulkanImageView() : VK_NULL_HANDLE,
+                       VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    }
+
+    m_DynamicRendering.HasDepth   = false;
+    m_DynamicRendering.HasStencil = false;
+    if (m_pBoundDepthStencil)
+    {
+        const auto& ViewDesc  = m_pBoundDepthStencil->GetDesc();
+        const bool  bReadOnly = ViewDesc.ViewType == TEXTURE_VIEW_READ_ONLY_DEPTH_STENCIL;
+        // Must match the layouts in TransitionRenderTargets()
+        InitAttachment(m_DynamicRendering.DepthStencilAttachment,
+                       m_pBoundDepthStencil->GetVulkanImageView(),
+                       bReadOnly ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+
+        const auto ComponentType      = GetTextureFormatAttribs(ViewDesc.Format).ComponentType;
+        m_DynamicRendering.HasDepth   = ComponentType == COMPONENT_TYPE_DEPTH || ComponentType == COMPONENT_TYPE_DEPTH_STENCIL;
+        m_DynamicRendering.HasStencil = ComponentType == COMPONENT_TYPE_DEPTH_STENCIL;
+    }
+
+    m_DynamicRendering.IsValid = true;
+}
+
 void DeviceContextVkImpl::ChooseRenderPassAndFramebuffer()
 {
+    // Shading rate attachments require render pass objects.
+    // Note that PipelineStateVkImpl makes the same choice for pipelines that use texture-based shading rate.
+    if (m_pDevice->IsDynamicRenderingEnabled() && !m_pBoundShadingRateMap)
+    {
+        // No render pass or framebuffer objects are needed
+        SetupDynamicRenderingAttachments();
+        InitImplicitRenderPassOps();
+        return;
+    }
+    m_DynamicRendering.IsValid = false;
+
     FramebufferCache::FramebufferCacheKey FBKey;
     RenderPassCache::RenderPassCacheKey   RenderPassKey;
     if (m_pBoundDepthStencil)
@@ -1905,6 +2397,9 @@ void DeviceContextVkImpl::ChooseRenderPassAndFramebuffer()
         m_vkRenderPass  = VK_NULL_HANDLE;
         m_vkFramebuffer = VK_NULL_HANDLE;
     }
+
+    m_ImplicitRenderPass.Key = RenderPassKey;
+    InitImplicitRenderPassOps();
 }
 
 void DeviceContextVkImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs)
@@ -1931,7 +2426,9 @@ void DeviceContextVkImpl::ResetRenderTargets()
     TDeviceContextBase::ResetRenderTargets();
     m_vkRenderPass  = VK_NULL_HANDLE;
     m_vkFramebuffer = VK_NULL_HANDLE;
-    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+
+    m_DynamicRendering.IsValid = false;
+    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.IsInRenderPass())
         m_CommandBuffer.EndRenderPass();
     m_State.ShadingRateIsSet = false;
 }
@@ -1944,6 +2441,7 @@ void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
     VERIFY_EXPR(m_pBoundFramebuffer != nullptr);
     VERIFY_EXPR(m_vkRenderPass == VK_NULL_HANDLE);
     VERIFY_EXPR(m_vkFramebuffer == VK_NULL_HANDLE);
+    VERIFY_EXPR(!m_DynamicRendering.IsValid);
 
     m_vkRenderPass  = m_pActiveRenderPass->GetVkRenderPass();
     m_vkFramebuffer = m_pBoundFramebuffer->GetVkFramebuffer();
@@ -1976,8 +2474,36 @@ void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
         pVkClearValues = m_vkClearValues.data();
     }
 
-    EnsureVkCmdBuffer();
-    m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, Attribs.ClearValueCount, pVkClearValues);
+    m_SecondaryCmdBuffersRenderPass = (Attribs.Flags & BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS) != 0;
+    if (m_SecondaryCmdBuffersRenderPass && IsDeferred())
+    {
+        DEV_CHECK_ERR(m_CommandBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE,
+                      "A deferred context that inherits the render pass must not record any commands before BeginRenderPass()");
+
+        VkCommandBufferInheritanceInfo InheritanceInfo{};
+        InheritanceInfo.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        InheritanceInfo.renderPass  = m_vkRenderPass;
+        InheritanceInfo.subpass     = 0;
+        InheritanceInfo.framebuffer = m_vkFramebuffer;
+
+        auto vkCmdBuff = m_CmdPool->GetCommandBuffer("", &InheritanceInfo);
+        m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff, m_CmdPool->GetSupportedStagesMask(), m_CmdPool->GetSupportedAccessMask(), m_pDevice->IsSynchronization2Enabled());
+        m_CommandBuffer.InheritRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight);
+        EnsureVkCmdBuffer();
+    }
+    else
+    {
+        EnsureVkCmdBuffer();
+        m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, Attribs.ClearValueCount, pVkClearValues,
+                                        m_SecondaryCmdBuffersRenderPass ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+    }
+
+    if (m_SecondaryCmdBuffersRenderPass && !IsDeferred())
+    {
+        // No commands other than vkCmdExecuteCommands may be recorded into the subpass. Reset the pipeline
+        // so that the viewports are committed when a pipeline is set after the render pass ends.
+        m_pPipelineState = nullptr;
+    }
 
     // Set the viewport to match the framebuffer size
     SetViewports(1, nullptr, 0, 0);
@@ -1988,13 +2514,15 @@ void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 void DeviceContextVkImpl::NextSubpass()
 {
     TDeviceContextBase::NextSubpass();
-    VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE);
-    m_CommandBuffer.NextSubpass();
+    VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.IsInRenderPass());
+    m_CommandBuffer.NextSubpass(m_SecondaryCmdBuffersRenderPass ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
 }
 
 void DeviceContextVkImpl::EndRenderPass()
 {
     TDeviceContextBase::EndRenderPass();
+    if (!IsDeferred())
+        m_SecondaryCmdBuffersRenderPass = false;
     // TDeviceContextBase::EndRenderPass calls ResetRenderTargets() that in turn
     // calls m_CommandBuffer.EndRenderPass()
 }
@@ -2035,6 +2563,13 @@ void DeviceContextVkImpl::UpdateBuffer(IBuffer*                       pBuffer,
 
     DEV_CHECK_ERR(pBuffVk->GetDesc().Usage != USAGE_DYNAMIC, "Dynamic buffers must be updated via Map()");
 
+    if (UseAsyncUpload(*pBuffVk, StateTransitionMode))
+    {
+        m_pAsyncUploadCtx->UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
+        OnAsyncUpload(pBuffer);
+        return;
+    }
+
     constexpr size_t Alignment = 4;
     // Source buffer offset must be multiple of 4 (18.4)
     auto TmpSpace = m_UploadHeap.Allocate(Size, Alignment);
@@ -2187,6 +2722,27 @@ void DeviceContextVkImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
     }
 }
 
+// Checks if the region satisfies the minImageTransferGranularity requirements of the queue (19.2)
+static bool IsAlignedToCopyGranularity(const TextureDesc& TexDesc, Uint32 MipLevel, const Box& Region, const Uint32 Granularity[3])
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+    const auto  MipProps   = GetMipLevelProperties(TexDesc, MipLevel);
+
+    auto IsAligned = [](Uint32 Min, Uint32 Max, Uint32 LogicalSize, Uint32 StorageSize, Uint32 G) {
+        const bool IsFullExtent = Min == 0 && (Max == LogicalSize || Max == StorageSize);
+        // Zero granularity only allows whole-subresource copies
+        if (G == 0)
+            return IsFullExtent;
+        return (Min % G) == 0 && ((Max % G) == 0 || Max == LogicalSize || Max == StorageSize);
+    };
+
+    const Uint32 BlockWidth  = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? Uint32{FmtAttribs.BlockWidth} : 1;
+    const Uint32 BlockHeight = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ? Uint32{FmtAttribs.BlockHeight} : 1;
+    return (IsAligned(Region.MinX, Region.MaxX, MipProps.LogicalWidth, MipProps.StorageWidth, Granularity[0] * BlockWidth) &&
+            IsAligned(Region.MinY, Region.MaxY, MipProps.LogicalHeight, MipProps.StorageHeight, Granularity[1] * BlockHeight) &&
+            IsAligned(Region.MinZ, Region.MaxZ, MipProps.Depth, MipProps.Depth, Granularity[2]));
+}
+
 void DeviceContextVkImpl::UpdateTexture(ITexture*                      pTexture,
                                         Uint32                         MipLevel,
                                         Uint32                         Slice,
@@ -2206,6 +2762,12 @@ void DeviceContextVkImpl::UpdateTexture(ITexture*                      pTexture,
     {
         UNSUPPORTED("Copying buffer to texture is not implemented");
     }
+    else if (UseAsyncUpload(*pTexVk, TextureStateTransitionMode) &&
+             IsAlignedToCopyGranularity(pTexVk->GetDesc(), MipLevel, DstBox, m_pAsyncUploadCtx->GetDesc().TextureCopyGranularity))
+    {
+        m_pAsyncUploadCtx->UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferStateTransitionMode, TextureStateTransitionMode);
+        OnAsyncUpload(pTexture);
+    }
     else
     {
         UpdateTextureRegion(SubresData.pData, SubresData.Stride, SubresData.DepthStride, *pTexVk,
@@ -2213,6 +2775,51 @@ void DeviceContextVkImpl::UpdateTexture(ITexture*                      pTexture,
     }
 }
 
+static VkImageCopy GetImageCopyInfo(const CopyTextureAttribs& CopyAttribs,
+                                    const TextureDesc&        SrcTexDesc,
+                                    const TextureDesc&        DstTexDesc,
+                                    const Box&                SrcBox)
+{
+    VkImageCopy CopyRegion = {};
+
+    CopyRegion.srcOffset.x   = SrcBox.MinX;
+    CopyRegion.srcOffset.y   = SrcBox.MinY;
+    CopyRegion.srcOffset.z   = SrcBox.MinZ;
+    CopyRegion.extent.width  = SrcBox.Width();
+    CopyRegion.extent.height = std::max(SrcBox.Height(), 1u);
+    CopyRegion.extent.depth  = std::max(SrcBox.Depth(), 1u);
+
+    auto GetAspectMak = [](TEXTURE_FORMAT Format) -> VkImageAspectFlags {
+        const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+        switch (FmtAttribs.ComponentType)
+        {
+            // clang-format off
+            case COMPONENT_TYPE_DEPTH:         return VK_IMAGE_ASPECT_DEPTH_BIT;
+            case COMPONENT_TYPE_DEPTH_STENCIL: return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+            // clang-format on
+            default: return VK_IMAGE_ASPECT_COLOR_BIT;
+        }
+    };
+    VkImageAspectFlags aspectMask = GetAspectMak(SrcTexDesc.Format);
+    DEV_CHECK_ERR(aspectMask == GetAspectMak(DstTexDesc.Format), "Vulkan spec requires that dst and src aspect masks must match");
+
+    CopyRegion.srcSubresource.baseArrayLayer = CopyAttribs.SrcSlice;
+    CopyRegion.srcSubresource.layerCount     = 1;
+    CopyRegion.srcSubresource.mipLevel       = CopyAttribs.SrcMipLevel;
+    CopyRegion.srcSubresource.aspectMask     = aspectMask;
+
+    CopyRegion.dstSubresource.baseArrayLayer = CopyAttribs.DstSlice;
+    CopyRegion.dstSubresource.layerCount     = 1;
+    CopyRegion.dstSubresource.mipLevel       = CopyAttribs.DstMipLevel;
+    CopyRegion.dstSubresource.aspectMask     = aspectMask;
+
+    CopyRegion.dstOffset.x = CopyAttribs.DstX;
+    CopyRegion.dstOffset.y = CopyAttribs.DstY;
+    CopyRegion.dstOffset.z = CopyAttribs.DstZ;
+
+    return CopyRegion;
+}
+
 void DeviceContextVkImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
     TDeviceContextBase::CopyTexture(CopyAttribs);
@@ -2242,43 +2849,7 @@ void DeviceContextVkImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 
     if (SrcTexDesc.Usage != USAGE_STAGING && DstTexDesc.Usage != USAGE_STAGING)
     {
-        VkImageCopy CopyRegion = {};
-
-        CopyRegion.srcOffset.x   = pSrcBox->MinX;
-        CopyRegion.srcOffset.y   = pSrcBox->MinY;
-        CopyRegion.srcOffset.z   = pSrcBox->MinZ;
-        CopyRegion.extent.width  = pSrcBox->Width();
-        CopyRegion.extent.height = std::max(pSrcBox->Height(), 1u);
-        CopyRegion.extent.depth  = std::max(pSrcBox->Depth(), 1u);
-
-        auto GetAspectMak = [](TEXTURE_FORMAT Format) -> VkImageAspectFlags {
-            const auto& FmtAttribs = GetTextureFormatAttribs(Format);
-            switch (FmtAttribs.ComponentType)
-            {
-                // clang-format off
-                case COMPONENT_TYPE_DEPTH:         return VK_IMAGE_ASPECT_DEPTH_BIT;
-                case COMPONENT_TYPE_DEPTH_STENCIL: return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
-                // clang-format on
-                default: return VK_IMAGE_ASPECT_COLOR_BIT;
-            }
-        };
-        VkImageAspectFlags aspectMask = GetAspectMak(SrcTexDesc.Format);
-        DEV_CHECK_ERR(aspectMask == GetAspectMak(DstTexDesc.Format), "Vulkan spec requires that dst and src aspect masks must match");
-
-        CopyRegion.srcSubresource.baseArrayLayer = CopyAttribs.SrcSlice;
-        CopyRegion.srcSubresource.layerCount     = 1;
-        CopyRegion.srcSubresource.mipLevel       = CopyAttribs.SrcMipLevel;
-        CopyRegion.srcSubresource.aspectMask     = aspectMask;
-
-        CopyRegion.dstSubresource.baseArrayLayer = CopyAttribs.DstSlice;
-        CopyRegion.dstSubresource.layerCount     = 1;
-        CopyRegion.dstSubresource.mipLevel       = CopyAttribs.DstMipLevel;
-        CopyRegion.dstSubresource.aspectMask     = aspectMask;
-
-        CopyRegion.dstOffset.x = CopyAttribs.DstX;
-        CopyRegion.dstOffset.y = CopyAttribs.DstY;
-        CopyRegion.dstOffset.z = CopyAttribs.DstZ;
-
+        const VkImageCopy CopyRegion = GetImageCopyInfo(CopyAttribs, SrcTexDesc, DstTexDesc, *pSrcBox);
         CopyTextureRegion(pSrcTexVk, CopyAttribs.SrcTextureTransitionMode, pDstTexVk, CopyAttribs.DstTextureTransitionMode, CopyRegion);
     }
     else if (SrcTexDesc.Usage == USAGE_STAGING && DstTexDesc.Usage != USAGE_STAGING)
@@ -2353,10 +2924,12 @@ void DeviceContextVkImpl::CopyTextureRegion(TextureVkImpl*                 pSrcT
                                             const VkImageCopy&             CopyRegion)
 {
     EnsureVkCmdBuffer();
+    const auto SrcRange = pSrcTexture->GetSubresourceRange(CopyRegion.srcSubresource.mipLevel, 1, CopyRegion.srcSubresource.baseArrayLayer, CopyRegion.srcSubresource.layerCount);
+    const auto DstRange = pDstTexture->GetSubresourceRange(CopyRegion.dstSubresource.mipLevel, 1, CopyRegion.dstSubresource.baseArrayLayer, CopyRegion.dstSubresource.layerCount);
     TransitionOrVerifyTextureState(*pSrcTexture, SrcTextureTransitionMode, RESOURCE_STATE_COPY_SOURCE, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                   "Using texture as transfer source (DeviceContextVkImpl::CopyTextureRegion)");
+                                   "Using texture as transfer source (DeviceContextVkImpl::CopyTextureRegion)", &SrcRange);
     TransitionOrVerifyTextureState(*pDstTexture, DstTextureTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                   "Using texture as transfer destination (DeviceContextVkImpl::CopyTextureRegion)");
+                                   "Using texture as transfer destination (DeviceContextVkImpl::CopyTextureRegion)", &DstRange);
 
     // srcImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL
     // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.3)
@@ -2364,37 +2937,28 @@ void DeviceContextVkImpl::CopyTextureRegion(TextureVkImpl*                 pSrcT
     ++m_State.NumCommands;
 }
 
-void DeviceContextVkImpl::UpdateTextureRegion(const void*                    pSrcData,
-                                              Uint64                         SrcStride,
-                                              Uint64                         SrcDepthStride,
-                                              TextureVkImpl&                 TextureVk,
-                                              Uint32                         MipLevel,
-                                              Uint32                         Slice,
-                                              const Box&                     DstBox,
-                                              RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+VkDeviceSize DeviceContextVkImpl::GetTextureUploadOffsetAlignment(TEXTURE_FORMAT Format) const
 {
-    const auto& TexDesc = TextureVk.GetDesc();
-    VERIFY(TexDesc.SampleCount == 1, "Only single-sample textures can be updated with vkCmdCopyBufferToImage()");
-
-    const auto& DeviceLimits      = m_pDevice->GetPhysicalDevice().GetProperties().limits;
-    const auto  CopyInfo          = GetBufferToTextureCopyInfo(TexDesc.Format, DstBox, static_cast<Uint32>(DeviceLimits.optimalBufferCopyRowPitchAlignment));
-    const auto  UpdateRegionDepth = CopyInfo.Region.Depth();
-
-    // For UpdateTextureRegion(), use UploadHeap, not dynamic heap
+    const auto& DeviceLimits = m_pDevice->GetPhysicalDevice().GetProperties().limits;
     // Source buffer offset must be multiple of 4 (18.4)
     auto BufferOffsetAlignment = std::max(DeviceLimits.optimalBufferCopyOffsetAlignment, VkDeviceSize{4});
     // If the calling command's VkImage parameter is a compressed image, bufferOffset must be a multiple of
     // the compressed texel block size in bytes (18.4)
-    const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
     if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
     {
         BufferOffsetAlignment = std::max(BufferOffsetAlignment, VkDeviceSize{FmtAttribs.ComponentSize});
     }
-    auto Allocation = m_UploadHeap.Allocate(CopyInfo.MemorySize, BufferOffsetAlignment);
-    // The allocation will stay in the upload heap until the end of the frame at which point all upload
-    // pages will be discarded
-    VERIFY((Allocation.AlignedOffset % BufferOffsetAlignment) == 0, "Allocation offset must be at least 32-bit aligned");
+    return BufferOffsetAlignment;
+}
 
+static void WriteTextureUploadData(const void*                    pSrcData,
+                                   Uint64                         SrcStride,
+                                   Uint64                         SrcDepthStride,
+                                   const BufferToTextureCopyInfo& CopyInfo,
+                                   void*                          pDstData)
+{
+    const auto UpdateRegionDepth = CopyInfo.Region.Depth();
 #ifdef DILIGENT_DEBUG
     {
         VERIFY(SrcStride >= CopyInfo.RowSize, "Source data stride (", SrcStride, ") is below the image row size (", CopyInfo.RowSize, ")");
@@ -2412,7 +2976,7 @@ void DeviceContextVkImpl::UpdateTextureRegion(const void*                    pSr
                 + row        * SrcStride
                 + DepthSlice * SrcDepthStride;
             auto* pDstPtr =
-                reinterpret_cast<Uint8*>(Allocation.CPUAddress)
+                reinterpret_cast<Uint8*>(pDstData)
                 + row        * CopyInfo.RowStride
                 + DepthSlice * CopyInfo.DepthStride;
             // clang-format on
@@ -2420,6 +2984,31 @@ void DeviceContextVkImpl::UpdateTextureRegion(const void*                    pSr
             memcpy(pDstPtr, pSrcPtr, StaticCast<size_t>(CopyInfo.RowSize));
         }
     }
+}
+
+void DeviceContextVkImpl::UpdateTextureRegion(const void*                    pSrcData,
+                                              Uint64                         SrcStride,
+                                              Uint64                         SrcDepthStride,
+                                              TextureVkImpl&                 TextureVk,
+                                              Uint32                         MipLevel,
+                                              Uint32                         Slice,
+                                              const Box&                     DstBox,
+                                              RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    const auto& TexDesc = TextureVk.GetDesc();
+    VERIFY(TexDesc.SampleCount == 1, "Only single-sample textures can be updated with vkCmdCopyBufferToImage()");
+
+    const auto& DeviceLimits = m_pDevice->GetPhysicalDevice().GetProperties().limits;
+    const auto  CopyInfo     = GetBufferToTextureCopyInfo(TexDesc.Format, DstBox, static_cast<Uint32>(DeviceLimits.optimalBufferCopyRowPitchAlignment));
+
+    // For UpdateTextureRegion(), use UploadHeap, not dynamic heap
+    const auto BufferOffsetAlignment = GetTextureUploadOffsetAlignment(TexDesc.Format);
+    auto       Allocation            = m_UploadHeap.Allocate(CopyInfo.MemorySize, BufferOffsetAlignment);
+    // The allocation will stay in the upload heap until the end of the frame at which point all upload
+    // pages will be discarded
+    VERIFY((Allocation.AlignedOffset % BufferOffsetAlignment) == 0, "Allocation offset must be at least 32-bit aligned");
+
+    WriteTextureUploadData(pSrcData, SrcStride, SrcDepthStride, CopyInfo, Allocation.CPUAddress);
     CopyBufferToTexture(Allocation.vkBuffer,
                         Allocation.AlignedOffset,
                         CopyInfo.RowStrideInTexels,
@@ -2506,8 +3095,9 @@ void DeviceContextVkImpl::CopyBufferToTexture(VkBuffer                       vkS
                                               RESOURCE_STATE_TRANSITION_MODE DstTextureTransitionMode)
 {
     EnsureVkCmdBuffer();
+    const auto DstRange = DstTextureVk.GetSubresourceRange(DstMipLevel, 1, DstArraySlice, 1);
     TransitionOrVerifyTextureState(DstTextureVk, DstTextureTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                   "Using texture as copy destination (DeviceContextVkImpl::CopyBufferToTexture)");
+                                   "Using texture as copy destination (DeviceContextVkImpl::CopyBufferToTexture)", &DstRange);
 
     const auto&       TexDesc     = DstTextureVk.GetDesc();
     VkBufferImageCopy BuffImgCopy = GetBufferImageCopyInfo(SrcBufferOffset, SrcBufferRowStrideInTexels, TexDesc, DstRegion, DstMipLevel, DstArraySlice);
@@ -2530,8 +3120,9 @@ void DeviceContextVkImpl::CopyTextureToBuffer(TextureVkImpl&                 Src
                                               Uint32                         DstBufferRowStrideInTexels)
 {
     EnsureVkCmdBuffer();
+    const auto SrcRange = SrcTextureVk.GetSubresourceRange(SrcMipLevel, 1, SrcArraySlice, 1);
     TransitionOrVerifyTextureState(SrcTextureVk, SrcTextureTransitionMode, RESOURCE_STATE_COPY_SOURCE, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                   "Using texture as source destination (DeviceContextVkImpl::CopyTextureToBuffer)");
+                                   "Using texture as source destination (DeviceContextVkImpl::CopyTextureToBuffer)", &SrcRange);
 
     const auto&       TexDesc     = SrcTextureVk.GetDesc();
     VkBufferImageCopy BuffImgCopy = GetBufferImageCopyInfo(DstBufferOffset, DstBufferRowStrideInTexels, TexDesc, SrcRegion, SrcMipLevel, SrcArraySlice);
@@ -2545,6 +3136,198 @@ void DeviceContextVkImpl::CopyTextureToBuffer(TextureVkImpl&                 Src
 }
 
 
+void DeviceContextVkImpl::UpdateTextures(const UpdateTextureAttribs* pUpdates, Uint32 NumUpdates)
+{
+    DEV_CHECK_ERR(pUpdates != nullptr || NumUpdates == 0, "pUpdates must not be null when NumUpdates is not zero");
+
+    struct BatchedUpdate
+    {
+        const UpdateTextureAttribs* pAttribs;
+        TextureVkImpl*              pTexVk;
+        BufferToTextureCopyInfo     CopyInfo;
+        VkDeviceSize                Offset;
+    };
+    std::vector<BatchedUpdate> Batch;
+    Batch.reserve(NumUpdates);
+
+    const auto& DeviceLimits = m_pDevice->GetPhysicalDevice().GetProperties().limits;
+
+    auto FlushBatch = [&]() {
+        if (Batch.empty())
+            return;
+
+        // Write the data of all updates into a single upload allocation
+        VkDeviceSize TotalSize    = 0;
+        VkDeviceSize MaxAlignment = 4;
+        for (auto& Update : Batch)
+        {
+            const auto Alignment = GetTextureUploadOffsetAlignment(Update.pTexVk->GetDesc().Format);
+            Update.Offset = AlignUp(TotalSize, Alignment);
+            TotalSize     = Update.Offset + Update.CopyInfo.MemorySize;
+            MaxAlignment  = std::max(MaxAlignment, Alignment);
+        }
+
+        auto Allocation = m_UploadHeap.Allocate(TotalSize, MaxAlignment);
+        for (const auto& Update : Batch)
+        {
+            const auto& SubresData = Update.pAttribs->SubresData;
+            WriteTextureUploadData(SubresData.pData, SubresData.Stride, SubresData.DepthStride, Update.CopyInfo,
+                                   reinterpret_cast<Uint8*>(Allocation.CPUAddress) + Update.Offset);
+        }
+
+        // Record all layout transitions first so that they are issued as a single pipeline barrier
+        // before the first copy.
+        EnsureVkCmdBuffer();
+        for (const auto& Update : Batch)
+        {
+            TransitionOrVerifyTextureState(*Update.pTexVk, Update.pAttribs->TextureTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                           "Using texture as copy destination (DeviceContextVkImpl::UpdateTextures)");
+        }
+
+        // Consecutive updates of the same texture are merged into a single copy command
+        std::vector<VkBufferImageCopy> Regions;
+        Regions.reserve(Batch.size());
+        for (size_t i = 0; i < Batch.size(); ++i)
+        {
+            const auto& Update = Batch[i];
+            Regions.emplace_back(GetBufferImageCopyInfo(Allocation.AlignedOffset + Update.Offset, Update.CopyInfo.RowStrideInTexels, Update.pTexVk->GetDesc(),
+                                                        Update.CopyInfo.Region, Update.pAttribs->MipLevel, Update.pAttribs->Slice));
+            if (i + 1 == Batch.size() || Batch[i + 1].pTexVk != Update.pTexVk)
+            {
+                m_CommandBuffer.CopyBufferToImage(Allocation.vkBuffer, Update.pTexVk->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                  static_cast<uint32_t>(Regions.size()), Regions.data());
+                ++m_State.NumCommands;
+                Regions.clear();
+            }
+        }
+
+        Batch.clear();
+    };
+
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update = pUpdates[i];
+        DEV_CHECK_ERR(Update.pTexture != nullptr, "pUpdates[", i, "].pTexture must not be null");
+        if (Update.pTexture == nullptr)
+            continue;
+
+        auto*     pTexVk = ClassPtrCast<TextureVkImpl>(Update.pTexture);
+        const Box DstBox = GetUpdateTextureBox(Update);
+        if (Update.SubresData.pSrcBuffer != nullptr ||
+            (UseAsyncUpload(*pTexVk, Update.TextureTransitionMode) &&
+             IsAlignedToCopyGranularity(pTexVk->GetDesc(), Update.MipLevel, DstBox, m_pAsyncUploadCtx->GetDesc().TextureCopyGranularity)))
+        {
+            // Preserve the order of the updates
+            FlushBatch();
+            UpdateTexture(Update.pTexture, Update.MipLevel, Update.Slice, DstBox, Update.SubresData, Update.SrcBufferTransitionMode, Update.TextureTransitionMode);
+            continue;
+        }
+
+        TDeviceContextBase::UpdateTexture(Update.pTexture, Update.MipLevel, Update.Slice, DstBox, Update.SubresData, Update.SrcBufferTransitionMode, Update.TextureTransitionMode);
+        DEV_CHECK_ERR(pTexVk->GetDesc().Usage == USAGE_DEFAULT || pTexVk->GetDesc().Usage == USAGE_SPARSE,
+                      "Only USAGE_DEFAULT or USAGE_SPARSE textures should be updated with UpdateData()");
+        VERIFY(pTexVk->GetDesc().SampleCount == 1, "Only single-sample textures can be updated with vkCmdCopyBufferToImage()");
+
+        const auto CopyInfo = GetBufferToTextureCopyInfo(pTexVk->GetDesc().Format, DstBox, static_cast<Uint32>(DeviceLimits.optimalBufferCopyRowPitchAlignment));
+        Batch.emplace_back(BatchedUpdate{&Update, pTexVk, CopyInfo, 0});
+    }
+
+    FlushBatch();
+}
+
+void DeviceContextVkImpl::CopyTextures(const CopyTextureAttribs* pCopies, Uint32 NumCopies)
+{
+    DEV_CHECK_ERR(pCopies != nullptr || NumCopies == 0, "pCopies must not be null when NumCopies is not zero");
+
+    struct BatchedCopy
+    {
+        const CopyTextureAttribs* pAttribs;
+        TextureVkImpl*            pSrcTexVk;
+        TextureVkImpl*            pDstTexVk;
+        VkImageCopy               Region;
+    };
+    std::vector<BatchedCopy> Batch;
+    Batch.reserve(NumCopies);
+
+    auto FlushBatch = [&]() {
+        if (Batch.empty())
+            return;
+
+        // Record all layout transitions first so that they are issued as a single pipeline barrier
+        // before the first copy.
+        EnsureVkCmdBuffer();
+        for (const auto& Copy : Batch)
+        {
+            TransitionOrVerifyTextureState(*Copy.pSrcTexVk, Copy.pAttribs->SrcTextureTransitionMode, RESOURCE_STATE_COPY_SOURCE, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                           "Using texture as transfer source (DeviceContextVkImpl::CopyTextures)");
+            TransitionOrVerifyTextureState(*Copy.pDstTexVk, Copy.pAttribs->DstTextureTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                           "Using texture as transfer destination (DeviceContextVkImpl::CopyTextures)");
+        }
+
+        // Consecutive copies between the same pair of textures are merged into a single command
+        std::vector<VkImageCopy> Regions;
+        Regions.reserve(Batch.size());
+        for (size_t i = 0; i < Batch.size(); ++i)
+        {
+            const auto& Copy = Batch[i];
+            Regions.emplace_back(Copy.Region);
+            if (i + 1 == Batch.size() || Batch[i + 1].pSrcTexVk != Copy.pSrcTexVk || Batch[i + 1].pDstTexVk != Copy.pDstTexVk)
+            {
+                m_CommandBuffer.CopyImage(Copy.pSrcTexVk->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, Copy.pDstTexVk->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                          static_cast<uint32_t>(Regions.size()), Regions.data());
+                ++m_State.NumCommands;
+                Regions.clear();
+            }
+        }
+
+        Batch.clear();
+    };
+
+    for (Uint32 i = 0; i < NumCopies; ++i)
+    {
+        const auto& Copy      = pCopies[i];
+        auto*       pSrcTexVk = ClassPtrCast<TextureVkImpl>(Copy.pSrcTexture);
+        auto*       pDstTexVk = ClassPtrCast<TextureVkImpl>(Copy.pDstTexture);
+        if (pSrcTexVk == nullptr || pDstTexVk == nullptr || pSrcTexVk == pDstTexVk ||
+            pSrcTexVk->GetDesc().Usage == USAGE_STAGING || pDstTexVk->GetDesc().Usage == USAGE_STAGING)
+        {
+            // Staging copies and copies within the same texture are not batched
+            FlushBatch();
+            CopyTexture(Copy);
+            continue;
+        }
+
+        // A texture can't be in the copy source and copy destination layouts at the same time
+        for (const auto& Batched : Batch)
+        {
+            if (Batched.pDstTexVk == pSrcTexVk || Batched.pSrcTexVk == pDstTexVk)
+            {
+                FlushBatch();
+                break;
+            }
+        }
+
+        TDeviceContextBase::CopyTexture(Copy);
+
+        UnbindTextureFromFramebuffer(pSrcTexVk, true);
+        UnbindTextureFromFramebuffer(pDstTexVk, true);
+
+        Box SrcBox;
+        if (Copy.pSrcBox != nullptr)
+        {
+            SrcBox = *Copy.pSrcBox;
+        }
+        else
+        {
+            const auto MipLevelAttribs = GetMipLevelProperties(pSrcTexVk->GetDesc(), Copy.SrcMipLevel);
+            SrcBox                     = Box{0, MipLevelAttribs.LogicalWidth, 0, MipLevelAttribs.LogicalHeight, 0, MipLevelAttribs.Depth};
+        }
+        Batch.emplace_back(BatchedCopy{&Copy, pSrcTexVk, pDstTexVk, GetImageCopyInfo(Copy, pSrcTexVk->GetDesc(), pDstTexVk->GetDesc(), SrcBox)});
+    }
+
+    FlushBatch();
+}
+
 void DeviceContextVkImpl::MapTextureSubresource(ITexture*                 pTexture,
                                                 Uint32                    MipLevel,
                                                 Uint32                    ArraySlice,
@@ -2704,7 +3487,7 @@ void DeviceContextVkImpl::FinishCommandList(ICommandList** ppCommandList)
     DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
 
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    if (m_CommandBuffer.IsInRenderPass())
     {
         m_CommandBuffer.EndRenderPass();
     }
@@ -2714,8 +3497,11 @@ void DeviceContextVkImpl::FinishCommandList(ICommandList** ppCommandList)
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer");
     (void)err;
 
-    CommandListVkImpl* pCmdListVk{NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff)};
+    m_Stats.BarrierCount += m_CommandBuffer.ExtractNumBarriers();
+
+    CommandListVkImpl* pCmdListVk{NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff, m_SecondaryCmdBuffersRenderPass)};
     pCmdListVk->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+    m_SecondaryCmdBuffersRenderPass = false;
 
     m_CommandBuffer.Reset();
     m_State          = ContextState{};
@@ -2736,11 +3522,68 @@ void DeviceContextVkImpl::ExecuteCommandLists(Uint32               NumCommandLis
         return;
     DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
 
+    if (m_pActiveRenderPass != nullptr)
+    {
+        ExecuteSecondaryCommandLists(NumCommandLists, ppCommandLists);
+        return;
+    }
+
+#ifdef DILIGENT_DEVELOPMENT
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        DEV_CHECK_ERR(!ClassPtrCast<CommandListVkImpl>(ppCommandLists[i])->IsSecondary(),
+                      "Command list ", i, " inherits a render pass and must be executed inside the render pass begun with BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS flag");
+    }
+#endif
+
     Flush(NumCommandLists, ppCommandLists);
 
     InvalidateState();
 }
 
+void DeviceContextVkImpl::ExecuteSecondaryCommandLists(Uint32               NumCommandLists,
+                                                       ICommandList* const* ppCommandLists)
+{
+    DEV_CHECK_ERR(m_SecondaryCmdBuffersRenderPass,
+                  "Command lists can only be executed inside a render pass that was begun with BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS flag");
+    VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.IsInRenderPass());
+
+    std::vector<VkCommandBuffer>& vkCmdBuffs = m_ScratchVkCmdBuffs;
+    VERIFY_EXPR(vkCmdBuffs.empty());
+    vkCmdBuffs.reserve(NumCommandLists);
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        auto* pCmdListVk = ClassPtrCast<CommandListVkImpl>(ppCommandLists[i]);
+        DEV_CHECK_ERR(pCmdListVk != nullptr, "Command list must not be null");
+        DEV_CHECK_ERR(pCmdListVk->IsSecondary(), "Command list ", i, " does not inherit the render pass and can't be executed inside it");
+        DEV_CHECK_ERR(pCmdListVk->GetQueueId() == GetDesc().QueueId, "Command list recorded for QueueId ", pCmdListVk->GetQueueId(), ", but executed on QueueId ", GetDesc().QueueId, ".");
+
+        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
+        VkCommandBuffer               vkCmdBuff = VK_NULL_HANDLE;
+        pCmdListVk->Close(pDeferredCtx, vkCmdBuff);
+        VERIFY(vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(pDeferredCtx != nullptr);
+
+        // The buffer is disposed when the primary command buffer is submitted by Flush()
+        m_ExecutedSecondaryCmdBuffers.emplace_back(ClassPtrCast<DeviceContextVkImpl>(pDeferredCtx.RawPtr()), vkCmdBuff);
+        vkCmdBuffs.push_back(vkCmdBuff);
+    }
+
+    m_CommandBuffer.ExecuteCommands(static_cast<uint32_t>(vkCmdBuffs.size()), vkCmdBuffs.data());
+    vkCmdBuffs.clear();
+    m_State.NumCommands += NumCommandLists;
+
+    // The bound pipeline, vertex and index buffers and descriptor sets are undefined after the
+    // secondary command buffers have been executed. Dynamic states are committed by SetPipelineState()
+    // when no pipeline is bound.
+    m_pPipelineState             = nullptr;
+    m_BindInfo                   = {};
+    m_State.CommittedVBsUpToDate = false;
+    m_State.CommittedIBUpToDate  = false;
+    m_State.ShadingRateIsSet     = false;
+    m_State.vkPipelineBindPoint  = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+}
+
 void DeviceContextVkImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
 {
     TDeviceContextBase::EnqueueSignal(pFence, Value, 0);
@@ -2838,12 +3681,12 @@ void DeviceContextVkImpl::EndQuery(IQuery* pQuery)
                "No query flag is set which indicates there was no matching BeginQuery call or there was an error while beginning the query.");
         if (CmdBuffState.OutsidePassQueries & (1 << QueryType))
         {
-            if (m_CommandBuffer.GetState().RenderPass)
+            if (m_CommandBuffer.IsInRenderPass())
                 m_CommandBuffer.EndRenderPass();
         }
         else
         {
-            if (!m_CommandBuffer.GetState().RenderPass)
+            if (!m_CommandBuffer.IsInRenderPass())
                 LOG_ERROR_MESSAGE("The query was started inside render pass, but is being ended outside of render pass. "
                                   "Vulkan requires that a query must either begin and end inside the same "
                                   "subpass of a render pass instance, or must both begin and end outside of a render pass "
@@ -2887,6 +3730,25 @@ NODISCARD inline bool ResourceStateHasWriteAccess(RESOURCE_STATE State)
 
     return State & WriteAccessStates;
 }
+
+TextureSubresourceRange VkSubresourceRangeToTextureSubresourceRange(const TextureVkImpl& TextureVk, const VkImageSubresourceRange& VkRange)
+{
+    return TextureVk.GetSubresourceRange(VkRange.baseMipLevel,
+                                         VkRange.levelCount == VK_REMAINING_MIP_LEVELS ? REMAINING_MIP_LEVELS : VkRange.levelCount,
+                                         VkRange.baseArrayLayer,
+                                         VkRange.layerCount == VK_REMAINING_ARRAY_LAYERS ? REMAINING_ARRAY_SLICES : VkRange.layerCount);
+}
+
+VkImageSubresourceRange TextureSubresourceRangeToVkSubresourceRange(const TextureSubresourceRange& Range)
+{
+    VkImageSubresourceRange VkRange;
+    VkRange.aspectMask     = 0; // Will be determined from the texture format
+    VkRange.baseMipLevel   = Range.FirstMip;
+    VkRange.levelCount     = Range.NumMips;
+    VkRange.baseArrayLayer = Range.FirstSlice;
+    VkRange.layerCount     = Range.NumSlices;
+    return VkRange;
+}
 } // namespace
 
 void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           TextureVk,
@@ -2896,8 +3758,33 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
                                                  VkImageSubresourceRange* pSubresRange /* = nullptr*/)
 {
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+    if (!m_AsyncUploadResources.empty())
+    {
+        // The texture is now used by this context, so further updates must be recorded here
+        m_AsyncUploadResources.erase(&TextureVk);
+    }
     if (OldState == RESOURCE_STATE_UNKNOWN)
     {
+        if (TextureVk.HasSubresourceStates() && TextureVk.IsInKnownState())
+        {
+            // Transition every group of subresources that share the same state individually
+            // so that the barriers use the exact old layouts.
+            VkImageSubresourceRange FullSubresRange{0, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS};
+            const auto&             VkRange = pSubresRange != nullptr ? *pSubresRange : FullSubresRange;
+            const auto              Range   = VkSubresourceRangeToTextureSubresourceRange(TextureVk, VkRange);
+            TextureVk.ProcessSubresourceStates(
+                Range,
+                [&](const TextureSubresourceRange& SubRange, RESOURCE_STATE SubresState) {
+                    VERIFY(SubresState != RESOURCE_STATE_UNKNOWN, "Subresources of a texture in known state must not be in unknown state");
+                    auto SubresVkRange       = TextureSubresourceRangeToVkSubresourceRange(SubRange);
+                    SubresVkRange.aspectMask = VkRange.aspectMask;
+                    TransitionTextureState(TextureVk, SubresState, NewState, Flags & ~STATE_TRANSITION_FLAG_UPDATE_STATE, &SubresVkRange);
+                });
+            if ((Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0)
+                TextureVk.SetSubresourceState(Range, NewState);
+            return;
+        }
+
         if (TextureVk.IsInKnownState())
         {
             OldState = TextureVk.GetState();
@@ -2910,7 +3797,7 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
     }
     else
     {
-        if (TextureVk.IsInKnownState() && TextureVk.GetState() != OldState)
+        if (TextureVk.IsInKnownState() && !TextureVk.HasSubresourceStates() && TextureVk.GetState() != OldState)
         {
             LOG_ERROR_MESSAGE("The state ", GetResourceStateString(TextureVk.GetState()), " of texture '",
                               TextureVk.GetDesc().Name, "' does not match the old state ", GetResourceStateString(OldState),
@@ -2966,8 +3853,15 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
         m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, *pSubresRange, OldStages, NewStages);
         if ((Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0)
         {
-            TextureVk.SetState(NewState);
-            VERIFY_EXPR(TextureVk.GetLayout() == NewLayout);
+            if (TextureVk.HasSubresourceStates())
+            {
+                TextureVk.SetSubresourceState(VkSubresourceRangeToTextureSubresourceRange(TextureVk, *pSubresRange), NewState);
+            }
+            else
+            {
+                TextureVk.SetState(NewState);
+                VERIFY_EXPR(TextureVk.GetLayout() == NewLayout);
+            }
         }
     }
 }
@@ -2976,21 +3870,34 @@ void DeviceContextVkImpl::TransitionOrVerifyTextureState(TextureVkImpl&
                                                          RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                          RESOURCE_STATE                 RequiredState,
                                                          VkImageLayout                  ExpectedLayout,
-                                                         const char*                    OperationName)
+                                                         const char*                    OperationName,
+                                                         const TextureSubresourceRange* pRange)
 {
+    const bool UseSubresRange = pRange != nullptr && Texture.HasSubresourceStates();
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
         if (Texture.IsInKnownState())
         {
-            TransitionTextureState(Texture, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE);
-            VERIFY_EXPR(Texture.GetLayout() == ExpectedLayout);
+            if (UseSubresRange)
+            {
+                auto SubresRange = TextureSubresourceRangeToVkSubresourceRange(*pRange);
+                TransitionTextureState(Texture, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE, &SubresRange);
+            }
+            else
+            {
+                TransitionTextureState(Texture, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE);
+                VERIFY_EXPR(Texture.GetLayout() == ExpectedLayout);
+            }
         }
     }
 #ifdef DILIGENT_DEVELOPMENT
     else if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
     {
-        DvpVerifyTextureState(Texture, RequiredState, OperationName);
+        if (UseSubresRange)
+            DvpVerifyTextureSubresourceState(Texture, *pRange, RequiredState, OperationName);
+        else
+            DvpVerifyTextureState(Texture, RequiredState, OperationName);
     }
 #endif
 }
@@ -3018,9 +3925,46 @@ VkCommandBuffer DeviceContextVkImpl::GetVkCommandBuffer()
     return m_CommandBuffer.GetVkCmdBuffer();
 }
 
+void DeviceContextVkImpl::SetAsyncUploadContext(IDeviceContext* pUploadContext)
+{
+    DEV_CHECK_ERR(!IsDeferred(), "Async uploads can only be enabled for immediate contexts");
+
+    auto* pUploadCtxVk = ClassPtrCast<DeviceContextVkImpl>(pUploadContext);
+    if (pUploadCtxVk == m_pAsyncUploadCtx.RawPtr())
+        return;
+
+    if (pUploadCtxVk != nullptr)
+    {
+        DEV_CHECK_ERR(pUploadCtxVk != this, "Device context can't be its own upload context");
+        DEV_CHECK_ERR(!pUploadCtxVk->IsDeferred(), "Upload context must be an immediate context");
+        DEV_CHECK_ERR(!pUploadCtxVk->m_pAsyncUploadCtx, "Upload context must not have its own upload context");
+    }
+
+    // Submit the uploads recorded into the previous upload context.
+    // This context will still wait for them the next time it is flushed.
+    SubmitAsyncUploads();
+    m_AsyncUploadResources.clear();
+
+    m_pAsyncUploadCtx = pUploadCtxVk;
+    if (m_pAsyncUploadCtx && !m_pAsyncUploadFence)
+    {
+        FenceDesc Desc;
+        Desc.Name = "Async upload fence";
+        Desc.Type = FENCE_TYPE_GENERAL;
+        RefCntAutoPtr<IFence> pFence;
+        m_pDevice->CreateFence(Desc, &pFence);
+        m_pAsyncUploadFence = pFence.RawPtr<FenceVkImpl>();
+    }
+}
+
 void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE_STATE OldState, RESOURCE_STATE NewState, bool UpdateBufferState)
 {
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+    if (!m_AsyncUploadResources.empty())
+    {
+        // The buffer is now used by this context, so further updates must be recorded here
+        m_AsyncUploadResources.erase(&BufferVk);
+    }
     if (OldState == RESOURCE_STATE_UNKNOWN)
     {
         if (BufferVk.IsInKnownState())
@@ -3232,6 +4176,7 @@ VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint64 SizeInB
                   "Dynamic allocation size must be less than 2^32");
 
     auto DynAlloc = m_DynamicHeap.Allocate(static_cast<Uint32>(SizeInBytes), Alignment);
+    m_Stats.DynamicMemoryAllocated += SizeInBytes;
 #ifdef DILIGENT_DEVELOPMENT
     DynAlloc.dvpFrameNumber = GetFrameNumber();
 #endif
@@ -3592,7 +4537,7 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
         for (Uint32 i = 0; i < Attribs.InstanceCount; ++i)
         {
             const auto& Inst     = Attribs.pInstances[i];
-            const auto  InstDesc = pTLASVk->GetInstanceDesc(Inst.InstanceName);
+            const auto  InstDesc = pTLASVk->GetInstanceDesc(Inst.InstanceName, i);
 
             if (InstDesc.InstanceIndex >= Attribs.InstanceCount)
             {
@@ -3825,16 +4770,16 @@ void DeviceContextVkImpl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndir
 
         // Buffer ranges do not intersect, so we don't need to add barriers between them
         if (RayGenShaderRecord.pData)
-            UpdateBuffer(pSBTBufferVk, RayGenShaderRecord.Offset, RayGenShaderRecord.Size, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferVk, RayGenShaderRecord.UpdateOffset, RayGenShaderRecord.UpdateSize, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (MissShaderTable.pData)
-            UpdateBuffer(pSBTBufferVk, MissShaderTable.Offset, MissShaderTable.Size, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferVk, MissShaderTable.UpdateOffset, MissShaderTable.UpdateSize, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (HitGroupTable.pData)
-            UpdateBuffer(pSBTBufferVk, HitGroupTable.Offset, HitGroupTable.Size, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferVk, HitGroupTable.UpdateOffset, HitGroupTable.UpdateSize, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         if (CallableShaderTable.pData)
-            UpdateBuffer(pSBTBufferVk, CallableShaderTable.Offset, CallableShaderTable.Size, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            UpdateBuffer(pSBTBufferVk, CallableShaderTable.UpdateOffset, CallableShaderTable.UpdateSize, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         TransitionOrVerifyBufferState(*pSBTBufferVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_RAY_TRACING, VK_ACCESS_SHADER_READ_BIT, OpName);
     }
@@ -4189,4 +5134,114 @@ void DeviceContextVkImpl::BindSparseResourceMemory(const BindSparseResourceMemor
     m_WaitSemaphoreValues.clear();
 }
 
+void DeviceContextVkImpl::ResolveQueries(const ResolveQueriesAttribs& Attribs)
+{
+    TDeviceContextBase::ResolveQueries(Attribs, 0);
+
+    if (Attribs.NumQueries == 0)
+        return;
+
+    VERIFY(m_pQueryMgr != nullptr || IsDeferred(), "Query manager should never be null for immediate contexts. This might be a bug.");
+    DEV_CHECK_ERR(m_pQueryMgr != nullptr, "Query manager is null, which indicates that this deferred context is not in a recording state");
+
+    BufferVkImpl* pDstBufferVk = ClassPtrCast<BufferVkImpl>(Attribs.pDstBuffer);
+    VERIFY(pDstBufferVk->m_VulkanBuffer != VK_NULL_HANDLE, "Destination buffer must not be suballocated");
+
+    EnsureVkCmdBuffer();
+    TransitionOrVerifyBufferState(*pDstBufferVk, Attribs.DstBufferTransitionMode, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                  "Resolving queries (DeviceContextVkImpl::ResolveQueries)");
+
+    // Queries of the same type that occupy consecutive slots of the pool are copied by a single command
+    for (Uint32 Start = 0; Start < Attribs.NumQueries;)
+    {
+        const QueryVkImpl* pFirstQuery = ClassPtrCast<const QueryVkImpl>(Attribs.ppQueries[Start]);
+        const QUERY_TYPE   QueryType   = pFirstQuery->GetDesc().Type;
+        const Uint32       FirstIdx    = pFirstQuery->GetQueryPoolIndex(0);
+
+        Uint32 Count = 1;
+        while (Start + Count < Attribs.NumQueries)
+        {
+            const QueryVkImpl* pQuery = ClassPtrCast<const QueryVkImpl>(Attribs.ppQueries[Start + Count]);
+            if (pQuery->GetDesc().Type != QueryType || pQuery->GetQueryPoolIndex(0) != FirstIdx + Count)
+                break;
+            ++Count;
+        }
+
+        VkQueryPool vkQueryPool = m_pQueryMgr->GetQueryPool(QueryType);
+        VERIFY(vkQueryPool != VK_NULL_HANDLE, "Query pool is not initialized for query type");
+        m_CommandBuffer.CopyQueryPoolResults(vkQueryPool, FirstIdx, Count, pDstBufferVk->GetVkBuffer(),
+                                             Attribs.DstOffset + Uint64{Start} * sizeof(Uint64), sizeof(Uint64),
+                                             VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        ++m_State.NumCommands;
+
+        Start += Count;
+    }
+}
+
+void DeviceContextVkImpl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    TDeviceContextBase::BeginConditionalRendering(Attribs, 0);
+
+    BufferVkImpl* pBufferVk = ClassPtrCast<BufferVkImpl>(Attribs.pBuffer);
+
+    EnsureVkCmdBuffer();
+    TransitionOrVerifyBufferState(*pBufferVk, Attribs.BufferTransitionMode, RESOURCE_STATE_INDIRECT_ARGUMENT, VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+                                  "Beginning conditional rendering (DeviceContextVkImpl::BeginConditionalRendering)");
+
+    // If conditional rendering begins outside of a render pass instance, it must end outside of it.
+    // Vulkan render pass that was implicitly started by the draw commands is ended here so that
+    // conditional rendering contains entire render pass instances.
+    if (m_pActiveRenderPass == nullptr && m_CommandBuffer.IsInRenderPass())
+        m_CommandBuffer.EndRenderPass();
+
+    // Vulkan reads the predicate as a 32-bit value. The upper half of the 64-bit query result
+    // is zero for any realistic number of samples.
+    m_CommandBuffer.BeginConditionalRendering(pBufferVk->GetVkBuffer(), Attribs.Offset,
+                                              Attribs.Inverted ? VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT : 0);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::CommitDynamicRenderState(const DynamicRenderState& State)
+{
+    VERIFY_EXPR(m_pPipelineState && m_pPipelineState->HasExtendedDynamicState());
+
+    VkPrimitiveTopology vkTopology = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+    if (State.PrimitiveTopology != PRIMITIVE_TOPOLOGY_UNDEFINED && m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS)
+    {
+        uint32_t PatchControlPoints = 0;
+        PrimitiveTopology_To_VkPrimitiveTopologyAndPatchCPCount(State.PrimitiveTopology, vkTopology, PatchControlPoints);
+    }
+
+    const VkPipelineDepthStencilStateCreateInfo DSState = DepthStencilStateDesc_To_VkDepthStencilStateCI(State.DepthStencilDesc);
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.SetExtendedDynamicState(CullModeToVkCullMode(State.CullMode),
+                                            State.FrontCounterClockwise ? VK_FRONT_FACE_COUNTER_CLOCKWISE : VK_FRONT_FACE_CLOCKWISE,
+                                            vkTopology,
+                                            DSState);
+}
+
+void DeviceContextVkImpl::SetDynamicRenderState(const DynamicRenderState& State)
+{
+    TDeviceContextBase::SetDynamicRenderState(State, 0);
+
+    if (!m_pPipelineState || !m_pPipelineState->HasExtendedDynamicState())
+        return;
+
+    CommitDynamicRenderState(State);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::EndConditionalRendering()
+{
+    TDeviceContextBase::EndConditionalRendering(0);
+
+    EnsureVkCmdBuffer();
+    if (m_pActiveRenderPass == nullptr && m_CommandBuffer.IsInRenderPass())
+        m_CommandBuffer.EndRenderPass();
+
+    m_CommandBuffer.EndConditionalRendering();
+    ++m_State.NumCommands;
+}
+
 } // namespace Diligent
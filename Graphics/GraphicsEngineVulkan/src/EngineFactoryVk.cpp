@@ -30,6 +30,7 @@
 
 #include "pch.h"
 #include <array>
+#include <algorithm>
 #include "EngineFactoryVk.h"
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
@@ -160,6 +161,7 @@ GraphicsAdapterInfo GetPhysicalDeviceGraphicsAdapterInfo(const VulkanUtilities::
         AdapterInfo.VendorId   = vkDeviceProps.vendorID;
         AdapterInfo.DeviceId   = vkDeviceProps.deviceID;
         AdapterInfo.NumOutputs = 0;
+        AdapterInfo.NumNodes   = PhysicalDevice.GetDeviceGroupSize();
     }
 
     // Label all enabled features as optional
@@ -608,6 +610,8 @@ void EngineFactoryVkImpl::EnumerateAdapters(Version              MinVersion,
     // If Volk is not enabled, the version will be 1.0.
     InstanceCI.ApiVersion             = VK_MAKE_VERSION(0xFF, 0xFF, 0);
     InstanceCI.EnableDeviceSimulation = m_EnableDeviceSimulation;
+    // The instance is only used to query the adapters and never compiles shaders
+    InstanceCI.DeferGlslangInit = true;
 
     auto Instance = VulkanUtilities::VulkanInstance::Create(InstanceCI);
 
@@ -705,6 +709,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         InstanceCI.pVkAllocator              = reinterpret_cast<VkAllocationCallbacks*>(EngineCI.pVkAllocator);
         InstanceCI.IgnoreDebugMessageCount   = EngineCI.IgnoreDebugMessageCount;
         InstanceCI.ppIgnoreDebugMessageNames = EngineCI.ppIgnoreDebugMessageNames;
+        InstanceCI.DeferGlslangInit          = EngineCI.DeferSubsystemInitialization;
 
 #if DILIGENT_USE_OPENXR
         if (EngineCI.pXRAttribs != nullptr && EngineCI.pXRAttribs->Instance != 0)
@@ -1228,6 +1233,253 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 NextExt  = &EnabledExtFeats.ShaderDrawParameters.pNext;
             }
 
+            if (EnabledFeatures.ConditionalRendering != DEVICE_FEATURE_STATE_DISABLED)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+
+                EnabledExtFeats.ConditionalRendering = DeviceExtFeatures.ConditionalRendering;
+
+                *NextExt = &EnabledExtFeats.ConditionalRendering;
+                NextExt  = &EnabledExtFeats.ConditionalRendering.pNext;
+            }
+
+            if (EnabledFeatures.ExtendedDynamicState != DEVICE_FEATURE_STATE_DISABLED)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+
+                EnabledExtFeats.ExtendedDynamicState = DeviceExtFeatures.ExtendedDynamicState;
+
+                *NextExt = &EnabledExtFeats.ExtendedDynamicState;
+                NextExt  = &EnabledExtFeats.ExtendedDynamicState.pNext;
+            }
+
+            // Multiview may have already been enabled for shading rate
+            if (EnabledFeatures.MultiView != DEVICE_FEATURE_STATE_DISABLED && EnabledExtFeats.Multiview.multiview == VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_MULTIVIEW_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_MULTIVIEW_EXTENSION_NAME);
+
+                EnabledExtFeats.Multiview = DeviceExtFeatures.Multiview;
+
+                *NextExt = &EnabledExtFeats.Multiview;
+                NextExt  = &EnabledExtFeats.Multiview.pNext;
+            }
+
+#if DILIGENT_USE_VOLK
+            // Some extensions may be required by several features
+            const auto EnableExtension = [&DeviceExtensions](const char* ExtName) {
+                if (std::find_if(DeviceExtensions.begin(), DeviceExtensions.end(),
+                                 [ExtName](const char* Name) { return std::strcmp(Name, ExtName) == 0; }) == DeviceExtensions.end())
+                    DeviceExtensions.push_back(ExtName);
+            };
+
+            if (EngineCI.EnableDynamicRendering)
+            {
+                if (DeviceExtFeatures.DynamicRendering.dynamicRendering != VK_FALSE)
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME));
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME));
+
+                    // Extensions required for RenderPass2 may have already been enabled for shading rate
+                    for (const char* ExtName : {VK_KHR_MAINTENANCE2_EXTENSION_NAME,
+                                                VK_KHR_MULTIVIEW_EXTENSION_NAME,
+                                                VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+                                                VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME,
+                                                VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME})
+                    {
+                        VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(ExtName));
+                        EnableExtension(ExtName);
+                    }
+
+                    EnabledExtFeats.RenderPass2      = DeviceExtFeatures.RenderPass2;
+                    EnabledExtFeats.DynamicRendering = DeviceExtFeatures.DynamicRendering;
+
+                    *NextExt = &EnabledExtFeats.DynamicRendering;
+                    NextExt  = &EnabledExtFeats.DynamicRendering.pNext;
+                }
+                else
+                {
+                    LOG_INFO_MESSAGE("Dynamic rendering is not supported by the device. Implicit render passes will use Vulkan render pass objects.");
+                }
+            }
+
+            if (EngineCI.EnableDescriptorBuffer)
+            {
+                const auto& DescrBufferProps = PhysicalDevice->GetExtProperties().DescriptorBuffer;
+
+                // The entire dynamic heap buffer is bound as both resource and sampler descriptor buffer
+                const VkDeviceSize MaxDescrBufferRange = std::min({DescrBufferProps.maxResourceDescriptorBufferRange,
+                                                                   DescrBufferProps.maxSamplerDescriptorBufferRange,
+                                                                   DescrBufferProps.resourceDescriptorBufferAddressSpaceSize,
+                                                                   DescrBufferProps.samplerDescriptorBufferAddressSpaceSize});
+                if (DeviceExtFeatures.DescriptorBuffer.descriptorBuffer == VK_FALSE ||
+                    DeviceExtFeatures.BufferDeviceAddress.bufferDeviceAddress == VK_FALSE)
+                {
+                    LOG_INFO_MESSAGE("Descriptor buffer is not supported by the device. Shader resources will use Vulkan descriptor sets.");
+                }
+                else if (DescrBufferProps.combinedImageSamplerDescriptorSingleArray == VK_FALSE)
+                {
+                    LOG_INFO_MESSAGE("Descriptor buffer is not enabled because the device requires combined image sampler arrays to be split. "
+                                     "Shader resources will use Vulkan descriptor sets.");
+                }
+                else if (EngineCI.DynamicHeapSize > MaxDescrBufferRange)
+                {
+                    LOG_WARNING_MESSAGE("Descriptor buffer is not enabled because the dynamic heap size (", EngineCI.DynamicHeapSize,
+                                        ") exceeds the maximum descriptor buffer range (", MaxDescrBufferRange, ").");
+                }
+                else
+                {
+                    for (const char* ExtName : {VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
+                                                VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME,
+                                                VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME,
+                                                VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME})
+                    {
+                        VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(ExtName));
+                        EnableExtension(ExtName);
+                    }
+
+                    // Buffer device address features may have already been enabled for ray tracing
+                    if (EnabledExtFeats.BufferDeviceAddress.bufferDeviceAddress == VK_FALSE)
+                    {
+                        EnabledExtFeats.BufferDeviceAddress = DeviceExtFeatures.BufferDeviceAddress;
+
+                        *NextExt = &EnabledExtFeats.BufferDeviceAddress;
+                        NextExt  = &EnabledExtFeats.BufferDeviceAddress.pNext;
+                    }
+
+                    EnabledExtFeats.DescriptorBuffer = DeviceExtFeatures.DescriptorBuffer;
+
+                    // Disable unused features
+                    EnabledExtFeats.DescriptorBuffer.descriptorBufferCaptureReplay      = VK_FALSE;
+                    EnabledExtFeats.DescriptorBuffer.descriptorBufferImageLayoutIgnored = VK_FALSE;
+                    EnabledExtFeats.DescriptorBuffer.descriptorBufferPushDescriptors    = VK_FALSE;
+
+                    *NextExt = &EnabledExtFeats.DescriptorBuffer;
+                    NextExt  = &EnabledExtFeats.DescriptorBuffer.pNext;
+                }
+            }
+
+            // Push descriptors are used for small dynamic descriptor sets (see PipelineResourceSignatureVkImpl).
+            // They are not needed when descriptor buffers are enabled.
+            if (DeviceExtFeatures.PushDescriptor && EnabledExtFeats.DescriptorBuffer.descriptorBuffer == VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME));
+                EnableExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+                EnabledExtFeats.PushDescriptor = true;
+            }
+
+            // Memory budget is used to avoid exceeding the device-local heap budget (see VulkanMemoryManager)
+            if (DeviceExtFeatures.MemoryBudget)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME));
+                EnableExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+                EnabledExtFeats.MemoryBudget = true;
+            }
+
+            // Dedicated allocations are used for large resources and for resources the driver
+            // prefers to have their own memory (see VulkanMemoryManager)
+            if (DeviceExtFeatures.DedicatedAllocation)
+            {
+                for (const char* ExtName : {VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+                                            VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME})
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(ExtName));
+                    EnableExtension(ExtName);
+                }
+                EnabledExtFeats.DedicatedAllocation = true;
+            }
+
+            // External memory and semaphores are used to export textures and fences to other APIs or processes
+            if (DeviceExtFeatures.ExternalMemory)
+            {
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+                constexpr const char* ExtName = VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME;
+#else
+                constexpr const char* ExtName = VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME;
+#endif
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(ExtName));
+                EnableExtension(ExtName);
+                EnabledExtFeats.ExternalMemory = true;
+            }
+            if (DeviceExtFeatures.ExternalSemaphore)
+            {
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+                constexpr const char* ExtName = VK_KHR_EXTERNAL_SEMAPHORE_WIN32_EXTENSION_NAME;
+#else
+                constexpr const char* ExtName = VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME;
+#endif
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(ExtName));
+                EnableExtension(ExtName);
+                EnabledExtFeats.ExternalSemaphore = true;
+            }
+
+            // Calibrated timestamps are used by ICommandQueue::GetTimestampCalibration()
+            if (DeviceExtFeatures.CalibratedTimestamps)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME));
+                EnableExtension(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+                EnabledExtFeats.CalibratedTimestamps = true;
+            }
+
+            // Synchronization2 allows every image barrier to use its own stage masks (see VulkanCommandBuffer::FlushBarriers)
+            if (DeviceExtFeatures.Synchronization2.synchronization2 != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME));
+                EnableExtension(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+
+                EnabledExtFeats.Synchronization2 = DeviceExtFeatures.Synchronization2;
+
+                *NextExt = &EnabledExtFeats.Synchronization2;
+                NextExt  = &EnabledExtFeats.Synchronization2.pNext;
+            }
+
+            if (EngineCI.EnableGraphicsPipelineLibrary)
+            {
+                if (DeviceExtFeatures.GraphicsPipelineLibrary.graphicsPipelineLibrary != VK_FALSE)
+                {
+                    for (const char* ExtName : {VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
+                                                VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME})
+                    {
+                        VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(ExtName));
+                        EnableExtension(ExtName);
+                    }
+
+                    EnabledExtFeats.GraphicsPipelineLibrary = DeviceExtFeatures.GraphicsPipelineLibrary;
+
+                    *NextExt = &EnabledExtFeats.GraphicsPipelineLibrary;
+                    NextExt  = &EnabledExtFeats.GraphicsPipelineLibrary.pNext;
+                }
+                else
+                {
+                    LOG_INFO_MESSAGE("Graphics pipeline library is not supported by the device. Graphics pipelines will be created as monolithic objects.");
+                }
+            }
+
+            // Shader module identifiers are stored in the engine-managed pipeline cache (see PersistentPipelineCache)
+            if (EngineCI.PipelineCacheFilePath != nullptr &&
+                DeviceExtFeatures.ShaderModuleIdentifier.shaderModuleIdentifier != VK_FALSE &&
+                DeviceExtFeatures.PipelineCreationCacheControl.pipelineCreationCacheControl != VK_FALSE)
+            {
+                for (const char* ExtName : {VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME,
+                                            VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME})
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(ExtName));
+                    EnableExtension(ExtName);
+                }
+
+                EnabledExtFeats.PipelineCreationCacheControl = DeviceExtFeatures.PipelineCreationCacheControl;
+                EnabledExtFeats.ShaderModuleIdentifier       = DeviceExtFeatures.ShaderModuleIdentifier;
+
+                *NextExt = &EnabledExtFeats.PipelineCreationCacheControl;
+                NextExt  = &EnabledExtFeats.PipelineCreationCacheControl.pNext;
+
+                *NextExt = &EnabledExtFeats.ShaderModuleIdentifier;
+                NextExt  = &EnabledExtFeats.ShaderModuleIdentifier.pNext;
+            }
+#endif
+
             // Append user-defined features
             *NextExt = EngineCI.pDeviceExtensionFeatures;
         }
@@ -1237,7 +1489,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 LOG_ERROR_MESSAGE("Can not enable extended device features when VK_KHR_get_physical_device_properties2 extension is not supported by device");
         }
 
-        ASSERT_SIZEOF(DeviceFeatures, 47, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+        ASSERT_SIZEOF(DeviceFeatures, 50, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
         for (Uint32 i = 0; i < EngineCI.DeviceExtensionCount; ++i)
         {
@@ -1305,7 +1557,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 VERIFY_EXPR(QueueIndex != DEFAULT_QUEUE_ID);
                 auto& QueueCI = QueueInfos[QueueIndex];
 
-                CommandQueuesVk[CtxInd] = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, SoftwareQueueIndex{CtxInd}, EngineCI.NumImmediateContexts, QueueCI.queueCount, ContextInfo);
+                CommandQueuesVk[CtxInd] = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, SoftwareQueueIndex{CtxInd}, EngineCI.NumImmediateContexts, QueueCI.queueCount, ContextInfo, EngineCI.SubmitBatchSize);
                 CommandQueues[CtxInd]   = CommandQueuesVk[CtxInd];
                 QueueCI.queueCount += 1;
             }
@@ -1317,7 +1569,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
             DefaultContextInfo.Name    = "Graphics context";
             DefaultContextInfo.QueueId = static_cast<Uint8>(QueueInfos[0].queueFamilyIndex);
 
-            CommandQueuesVk[0] = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, SoftwareQueueIndex{0}, 1u, 1u, DefaultContextInfo);
+            CommandQueuesVk[0] = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, SoftwareQueueIndex{0}, 1u, 1u, DefaultContextInfo, EngineCI.SubmitBatchSize);
             CommandQueues[0]   = CommandQueuesVk[0];
         }
 
@@ -49,11 +49,21 @@ FenceVkImpl::FenceVkImpl(IReferenceCounters* pRefCounters,
     }
 // clang-format on
 {
+    const bool Exportable = (m_Desc.Flags & FENCE_FLAG_EXPORTABLE) != 0;
+    if (Exportable)
+    {
+        // Only timeline semaphores can be exported, binary VkFence objects are not visible to other APIs
+        if (m_Desc.Type != FENCE_TYPE_GENERAL || !pRenderDeviceVkImpl->GetFeatures().NativeFence)
+            LOG_ERROR_AND_THROW("Exportable fence '", m_Desc.Name, "' must use FENCE_TYPE_GENERAL and requires NativeFence feature.");
+        if (!pRenderDeviceVkImpl->GetLogicalDevice().GetEnabledExtFeatures().ExternalSemaphore)
+            LOG_ERROR_AND_THROW("Exportable fence '", m_Desc.Name, "' requires external semaphore extension that is not supported by the device.");
+    }
+
     if (m_Desc.Type == FENCE_TYPE_GENERAL &&
         pRenderDeviceVkImpl->GetFeatures().NativeFence)
     {
         const auto& LogicalDevice = pRenderDeviceVkImpl->GetLogicalDevice();
-        m_TimelineSemaphore       = LogicalDevice.CreateTimelineSemaphore(0, m_Desc.Name);
+        m_TimelineSemaphore       = LogicalDevice.CreateTimelineSemaphore(0, m_Desc.Name, Exportable);
     }
 }
 
@@ -99,6 +109,26 @@ FenceVkImpl::~FenceVkImpl()
 #endif
 }
 
+Bool FenceVkImpl::ExportSemaphoreHandle(Uint64& Handle)
+{
+    if ((m_Desc.Flags & FENCE_FLAG_EXPORTABLE) == 0)
+    {
+        DEV_ERROR("Fence '", m_Desc.Name, "' was not created with FENCE_FLAG_EXPORTABLE flag");
+        return False;
+    }
+    VERIFY_EXPR(IsTimelineSemaphore());
+
+    uint64_t vkHandle = 0;
+    if (m_pDevice->GetLogicalDevice().GetSemaphoreHandle(m_TimelineSemaphore, vkHandle) != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to export the semaphore of fence '", m_Desc.Name, "'");
+        return False;
+    }
+
+    Handle = vkHandle;
+    return True;
+}
+
 void FenceVkImpl::ImmediatelyReleaseResources()
 {
     m_TimelineSemaphore.Release();
@@ -189,6 +219,19 @@ void FenceVkImpl::Reset(Uint64 Value)
 }
 
 void FenceVkImpl::Wait(Uint64 Value)
+{
+    WaitWithTimeout(Value, FenceWaitTimeout::Infinite);
+}
+
+Bool FenceVkImpl::WaitWithTimeout(Uint64 Value, Uint64 Timeout)
+{
+    // The fence may be signaled by a submission that is still batched by a command queue
+    m_pDevice->FlushBatchedSubmits();
+
+    return InternalWait(Value, Timeout);
+}
+
+Bool FenceVkImpl::InternalWait(Uint64 Value, Uint64 Timeout)
 {
     if (IsTimelineSemaphore())
     {
@@ -202,11 +245,16 @@ void FenceVkImpl::Wait(Uint64 Value)
         WaitInfo.pSemaphores    = &m_TimelineSemaphore;
         WaitInfo.pValues        = &Value;
 
-        auto err = LogicalDevice.WaitSemaphores(WaitInfo, UINT64_MAX);
+        auto err = LogicalDevice.WaitSemaphores(WaitInfo, Timeout);
+        if (err == VK_TIMEOUT)
+            return False;
         DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to wait timeline semaphore");
+        return True;
     }
     else
     {
+        FenceWaitTimeout WaitTimeout{Timeout};
+
         std::lock_guard<std::mutex> Lock{m_SyncPointsGuard};
 
         const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
@@ -220,7 +268,9 @@ void FenceVkImpl::Wait(Uint64 Value)
             auto    status = LogicalDevice.GetFenceStatus(Fence);
             if (status == VK_NOT_READY)
             {
-                status = LogicalDevice.WaitForFences(1, &Fence, VK_TRUE, UINT64_MAX);
+                status = LogicalDevice.WaitForFences(1, &Fence, VK_TRUE, WaitTimeout.GetRemaining());
+                if (status == VK_TIMEOUT)
+                    return False;
             }
 
             DEV_CHECK_ERR(status == VK_SUCCESS, "All pending fences must now be complete!");
@@ -228,6 +278,8 @@ void FenceVkImpl::Wait(Uint64 Value)
 
             m_SyncPoints.pop_front();
         }
+
+        return m_LastCompletedFenceValue.load() >= Value;
     }
 }
 
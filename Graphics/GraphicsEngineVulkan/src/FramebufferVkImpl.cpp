@@ -68,7 +68,8 @@ FramebufferVkImpl::FramebufferVkImpl(IReferenceCounters*    pRefCounters,
 
     FramebufferCI.width  = m_Desc.Width;
     FramebufferCI.height = m_Desc.Height;
-    FramebufferCI.layers = m_Desc.NumArraySlices;
+    // Multiview render passes render to the array slices defined by the view mask, and the framebuffer must have a single layer.
+    FramebufferCI.layers = pRenderPassVkImpl->GetDesc().pSubpasses[0].ViewMask != 0 ? 1 : m_Desc.NumArraySlices;
 
     const auto& LogicalDevice = pDevice->GetLogicalDevice();
 
@@ -50,11 +50,21 @@ void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx)
         return;
     }
 
-    const auto  OriginalState  = pTexVk->GetState();
-    const auto  OriginalLayout = pTexVk->GetLayout();
-    const auto  OldStages      = ResourceStateFlagsToVkPipelineStageFlags(OriginalState);
-    const auto& TexDesc        = pTexVk->GetDesc();
-    const auto& ViewDesc       = TexView.GetDesc();
+    const auto& TexDesc  = pTexVk->GetDesc();
+    const auto& ViewDesc = TexView.GetDesc();
+
+    if (pTexVk->HasSubresourceStates())
+    {
+        // Subresources of the view may be in different states. Move them to the transfer source layout
+        // and leave them there, so that the subresources outside of the view are not affected.
+        const auto              Range = pTexVk->GetViewSubresourceRange(ViewDesc);
+        VkImageSubresourceRange VkRange{0, Range.FirstMip, Range.NumMips, Range.FirstSlice, Range.NumSlices};
+        Ctx.TransitionTextureState(*pTexVk, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE, &VkRange);
+    }
+
+    const auto OriginalState  = pTexVk->HasSubresourceStates() ? RESOURCE_STATE_COPY_SOURCE : pTexVk->GetState();
+    const auto OriginalLayout = pTexVk->HasSubresourceStates() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : pTexVk->GetLayout();
+    const auto OldStages      = ResourceStateFlagsToVkPipelineStageFlags(OriginalState);
 
     DEV_CHECK_ERR(ViewDesc.NumMipLevels > 1, "Number of mip levels in the view must be greater than 1");
     DEV_CHECK_ERR(OriginalState != RESOURCE_STATE_UNDEFINED,
@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#include "pch.h"
+
+#include "GraphicsPipelineLibraryCache.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "RenderDeviceVkImpl.hpp"
+
+namespace Diligent
+{
+
+GraphicsPipelineLibraryCache::GraphicsPipelineLibraryCache(RenderDeviceVkImpl& DeviceVk) noexcept :
+    m_DeviceVkImpl{DeviceVk}
+{}
+
+GraphicsPipelineLibraryCache::~GraphicsPipelineLibraryCache()
+{
+    VERIFY(std::all_of(m_Libraries.begin(), m_Libraries.end(), [](const auto& Libs) { return Libs.empty(); }),
+           "Graphics pipeline library cache is not empty. Did you call Destroy?");
+}
+
+void GraphicsPipelineLibraryCache::Destroy()
+{
+    // Pipelines that reference the libraries have been released by now, and
+    // the device is idle, so the libraries can be destroyed immediately.
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    for (auto& Libs : m_Libraries)
+        Libs.clear();
+}
+
+static const char* GetLibraryTypeName(GraphicsPipelineLibraryCache::LIBRARY_TYPE Type)
+{
+    switch (Type)
+    {
+        // clang-format off
+        case GraphicsPipelineLibraryCache::LIBRARY_TYPE_VERTEX_INPUT:      return "vertex input";
+        case GraphicsPipelineLibraryCache::LIBRARY_TYPE_PRE_RASTERIZATION: return "pre-rasterization";
+        case GraphicsPipelineLibraryCache::LIBRARY_TYPE_FRAGMENT_SHADER:   return "fragment shader";
+        case GraphicsPipelineLibraryCache::LIBRARY_TYPE_FRAGMENT_OUTPUT:   return "fragment output";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected library type");
+            return "unknown";
+    }
+}
+
+VkPipeline GraphicsPipelineLibraryCache::GetLibrary(LIBRARY_TYPE                        Type,
+                                                    size_t                              Hash,
+                                                    const VkGraphicsPipelineCreateInfo& PipelineCI,
+                                                    VkPipelineCache                     vkPSOCache,
+                                                    const char*                         PipelineName) noexcept(false)
+{
+    VERIFY_EXPR(Type < LIBRARY_TYPE_COUNT);
+    auto& Libraries = m_Libraries[Type];
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+
+        auto it = Libraries.find(Hash);
+        if (it != Libraries.end())
+            return it->second;
+    }
+
+    // Create the library outside of the lock as compiling shaders may take a long time.
+    VkGraphicsPipelineLibraryCreateInfoEXT LibraryCI{};
+    LibraryCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+
+    VkGraphicsPipelineCreateInfo LibPipelineCI{};
+    LibPipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    LibPipelineCI.pNext = &LibraryCI;
+    LibPipelineCI.flags =
+        PipelineCI.flags |
+        VK_PIPELINE_CREATE_LIBRARY_BIT_KHR |
+        VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT; // Allows linking an optimized pipeline later
+    LibPipelineCI.pDynamicState      = PipelineCI.pDynamicState;
+    LibPipelineCI.basePipelineHandle = VK_NULL_HANDLE;
+    LibPipelineCI.basePipelineIndex  = -1;
+
+    // Render pass state (VkPipelineRenderingCreateInfoKHR or render pass object) is
+    // required by all libraries except for the vertex input interface
+    const auto SetRenderPassState = [&]() {
+        LibraryCI.pNext          = PipelineCI.pNext;
+        LibPipelineCI.renderPass = PipelineCI.renderPass;
+        LibPipelineCI.subpass    = PipelineCI.subpass;
+    };
+
+    std::array<VkPipelineShaderStageCreateInfo, 5> Stages{};
+    switch (Type)
+    {
+        case LIBRARY_TYPE_VERTEX_INPUT:
+            LibraryCI.flags                   = VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+            LibPipelineCI.pVertexInputState   = PipelineCI.pVertexInputState;
+            LibPipelineCI.pInputAssemblyState = PipelineCI.pInputAssemblyState;
+            break;
+
+        case LIBRARY_TYPE_PRE_RASTERIZATION:
+            LibraryCI.flags = VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+            for (Uint32 s = 0; s < PipelineCI.stageCount; ++s)
+            {
+                if (PipelineCI.pStages[s].stage != VK_SHADER_STAGE_FRAGMENT_BIT)
+                {
+                    VERIFY_EXPR(LibPipelineCI.stageCount < Stages.size());
+                    Stages[LibPipelineCI.stageCount++] = PipelineCI.pStages[s];
+                }
+            }
+            LibPipelineCI.pStages             = Stages.data();
+            LibPipelineCI.pViewportState      = PipelineCI.pViewportState;
+            LibPipelineCI.pRasterizationState = PipelineCI.pRasterizationState;
+            LibPipelineCI.pTessellationState  = PipelineCI.pTessellationState;
+            LibPipelineCI.layout              = PipelineCI.layout;
+            SetRenderPassState();
+            break;
+
+        case LIBRARY_TYPE_FRAGMENT_SHADER:
+            LibraryCI.flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+            for (Uint32 s = 0; s < PipelineCI.stageCount; ++s)
+            {
+                if (PipelineCI.pStages[s].stage == VK_SHADER_STAGE_FRAGMENT_BIT)
+                    Stages[LibPipelineCI.stageCount++] = PipelineCI.pStages[s];
+            }
+            LibPipelineCI.pStages            = Stages.data();
+            LibPipelineCI.pDepthStencilState = PipelineCI.pDepthStencilState;
+            LibPipelineCI.pMultisampleState  = PipelineCI.pMultisampleState;
+            LibPipelineCI.layout             = PipelineCI.layout;
+            SetRenderPassState();
+            break;
+
+        case LIBRARY_TYPE_FRAGMENT_OUTPUT:
+            LibraryCI.flags                 = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+            LibPipelineCI.pColorBlendState  = PipelineCI.pColorBlendState;
+            LibPipelineCI.pMultisampleState = PipelineCI.pMultisampleState;
+            SetRenderPassState();
+            break;
+
+        default:
+            UNEXPECTED("Unexpected library type");
+    }
+
+    const std::string LibraryName = std::string{PipelineName != nullptr ? PipelineName : ""} + " - " + GetLibraryTypeName(Type) + " library";
+
+    VulkanUtilities::PipelineWrapper Library = m_DeviceVkImpl.GetLogicalDevice().CreateGraphicsPipeline(LibPipelineCI, vkPSOCache, LibraryName.c_str());
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    // Another thread may have created the same library while the lock was released.
+    // In this case, the new library is discarded.
+    auto it = Libraries.emplace(Hash, std::move(Library)).first;
+    return it->second;
+}
+
+} // namespace Diligent
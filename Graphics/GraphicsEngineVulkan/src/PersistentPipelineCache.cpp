@@ -0,0 +1,377 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "PersistentPipelineCache.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#include "RenderDeviceVkImpl.hpp"
+#include "FileWrapper.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The header that precedes the Vulkan pipeline cache data in the file.
+// VkPipelineCacheHeaderVersionOne does not contain the driver version, so drivers that
+// do not update the pipeline cache UUID may otherwise be given stale data.
+// The pipeline cache data is followed by NumShaderModuleIds ShaderModuleIdFileEntry structures.
+// DataHash covers both.
+struct PipelineCacheFileHeader
+{
+    static constexpr Uint32 ExpectedMagic  = 0x4350564Bu; // "KVPC"
+    static constexpr Uint32 CurrentVersion = 2;
+
+    Uint32 Magic              = ExpectedMagic;
+    Uint32 Version            = CurrentVersion;
+    Uint32 VendorID           = 0;
+    Uint32 DeviceID           = 0;
+    Uint32 DriverVersion      = 0;
+    Uint32 NumShaderModuleIds = 0;
+    Uint64 DataSize           = 0;
+    Uint64 DataHash           = 0;
+
+    // VkPhysicalDeviceShaderModuleIdentifierPropertiesEXT::shaderModuleIdentifierAlgorithmUUID
+    Uint8 ShaderModuleIdAlgorithmUUID[VK_UUID_SIZE] = {};
+};
+static_assert(sizeof(PipelineCacheFileHeader) == 56, "Unexpected header size. Did you add padding?");
+
+struct ShaderModuleIdFileEntry
+{
+    Uint64 Key     = 0;
+    Uint32 Size    = 0;
+    Uint32 Padding = 0;
+    Uint8  Data[VK_MAX_SHADER_MODULE_IDENTIFIER_SIZE_EXT] = {};
+};
+static_assert(sizeof(ShaderModuleIdFileEntry) == 16 + VK_MAX_SHADER_MODULE_IDENTIFIER_SIZE_EXT, "Unexpected entry size. Did you add padding?");
+
+Uint64 ComputeSPIRVKey(const std::vector<uint32_t>& SPIRV)
+{
+    return ComputeHash(ComputeHashRaw(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0])), SPIRV.size());
+}
+
+} // namespace
+
+bool PersistentPipelineCache::IsCacheDataCompatible(const VkPhysicalDeviceProperties& Props, const void* pData, size_t DataSize)
+{
+    if (pData == nullptr || DataSize <= sizeof(VkPipelineCacheHeaderVersionOne))
+        return false;
+
+    VkPipelineCacheHeaderVersionOne Header;
+    std::memcpy(&Header, pData, sizeof(Header));
+
+    return (Header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            Header.headerSize == 32 && // from specs
+            Header.deviceID == Props.deviceID &&
+            Header.vendorID == Props.vendorID &&
+            std::memcmp(Header.pipelineCacheUUID, Props.pipelineCacheUUID, sizeof(Header.pipelineCacheUUID)) == 0);
+}
+
+PersistentPipelineCache::PersistentPipelineCache(RenderDeviceVkImpl& DeviceVk, const char* FilePath, Uint32 SaveInterval) noexcept(false) :
+    m_DeviceVkImpl{DeviceVk},
+    m_FilePath{FilePath != nullptr ? FilePath : ""}
+{
+    if (!IsEnabled())
+        return;
+
+    const VkPhysicalDeviceProperties& Props = m_DeviceVkImpl.GetPhysicalDevice().GetProperties();
+
+    m_ShaderModuleIdsEnabled = m_DeviceVkImpl.GetLogicalDevice().GetEnabledExtFeatures().ShaderModuleIdentifier.shaderModuleIdentifier != VK_FALSE;
+
+    const auto& ShaderModuleIdAlgorithmUUID = m_DeviceVkImpl.GetPhysicalDevice().GetExtProperties().ShaderModuleIdentifier.shaderModuleIdentifierAlgorithmUUID;
+
+    std::vector<Uint8> FileData;
+    if (FileSystem::FileExists(m_FilePath.c_str()) && FileWrapper::ReadWholeFile(m_FilePath.c_str(), FileData, /*Silent = */ true))
+    {
+        PipelineCacheFileHeader Header;
+        if (FileData.size() >= sizeof(Header))
+            std::memcpy(&Header, FileData.data(), sizeof(Header));
+        else
+            Header.Magic = 0;
+
+        const Uint8* pData = FileData.data() + sizeof(Header);
+        if (Header.Magic == PipelineCacheFileHeader::ExpectedMagic &&
+            Header.Version != PipelineCacheFileHeader::CurrentVersion)
+        {
+            LOG_INFO_MESSAGE("Pipeline cache file '", m_FilePath, "' has an outdated format and will be overwritten.");
+        }
+        else if (Header.Magic != PipelineCacheFileHeader::ExpectedMagic ||
+                 Header.DataSize + Uint64{Header.NumShaderModuleIds} * sizeof(ShaderModuleIdFileEntry) != FileData.size() - sizeof(Header))
+        {
+            LOG_WARNING_MESSAGE("Pipeline cache file '", m_FilePath, "' is corrupted and will be overwritten.");
+        }
+        else if (Header.VendorID != Props.vendorID ||
+                 Header.DeviceID != Props.deviceID ||
+                 Header.DriverVersion != Props.driverVersion ||
+                 !IsCacheDataCompatible(Props, pData, static_cast<size_t>(Header.DataSize)))
+        {
+            LOG_INFO_MESSAGE("Pipeline cache file '", m_FilePath, "' was created by a different device or driver and will be overwritten.");
+        }
+        else if (Header.DataHash != ComputeHashRaw(pData, FileData.size() - sizeof(Header)))
+        {
+            LOG_WARNING_MESSAGE("Pipeline cache file '", m_FilePath, "' failed the checksum test and will be overwritten.");
+        }
+        else
+        {
+            m_InitialData.assign(pData, pData + Header.DataSize);
+
+            // Identifiers are only valid for the same identifier algorithm
+            if (m_ShaderModuleIdsEnabled &&
+                std::memcmp(Header.ShaderModuleIdAlgorithmUUID, ShaderModuleIdAlgorithmUUID, VK_UUID_SIZE) == 0)
+            {
+                const Uint8* pEntries = pData + Header.DataSize;
+                for (Uint32 i = 0; i < Header.NumShaderModuleIds; ++i)
+                {
+                    ShaderModuleIdFileEntry Entry;
+                    std::memcpy(&Entry, pEntries + i * sizeof(Entry), sizeof(Entry));
+                    if (Entry.Size == 0 || Entry.Size > VK_MAX_SHADER_MODULE_IDENTIFIER_SIZE_EXT)
+                        continue;
+
+                    auto& Id = m_ShaderModuleIds[Entry.Key];
+                    Id.Size  = Entry.Size;
+                    std::memcpy(Id.Data, Entry.Data, Entry.Size);
+                }
+            }
+        }
+    }
+
+    VkPipelineCacheCreateInfo PipelineCacheCI{};
+    PipelineCacheCI.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.initialDataSize = m_InitialData.size();
+    PipelineCacheCI.pInitialData    = !m_InitialData.empty() ? m_InitialData.data() : nullptr;
+
+    m_MainCache = m_DeviceVkImpl.GetLogicalDevice().CreatePipelineCache(PipelineCacheCI, "Persistent pipeline cache");
+
+    if (SaveInterval > 0)
+        m_SaveThread = std::thread{&PersistentPipelineCache::SaveThreadFunc, this, SaveInterval};
+}
+
+PersistentPipelineCache::~PersistentPipelineCache()
+{
+    // The thread is still running if the device failed to initialize
+    StopSaveThread();
+
+    VERIFY(m_Caches.empty(), "Persistent pipeline cache has not been destroyed. Did you call Destroy?");
+}
+
+PersistentPipelineCache::ScopedCache PersistentPipelineCache::Acquire()
+{
+    if (!m_MainCache)
+        return ScopedCache{nullptr, VK_NULL_HANDLE};
+
+    std::lock_guard<std::mutex> Lock{m_PoolMtx};
+    if (m_FreeCaches.empty())
+    {
+        // All pooled caches start with the data loaded from the file, so that
+        // pipelines compiled in the previous runs are found by every thread.
+        VkPipelineCacheCreateInfo PipelineCacheCI{};
+        PipelineCacheCI.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        PipelineCacheCI.initialDataSize = m_InitialData.size();
+        PipelineCacheCI.pInitialData    = !m_InitialData.empty() ? m_InitialData.data() : nullptr;
+
+        m_Caches.emplace_back(m_DeviceVkImpl.GetLogicalDevice().CreatePipelineCache(PipelineCacheCI, "Pooled pipeline cache"));
+        m_FreeCaches.push_back(m_Caches.back());
+    }
+
+    VkPipelineCache vkCache = m_FreeCaches.back();
+    m_FreeCaches.pop_back();
+    return ScopedCache{this, vkCache};
+}
+
+bool PersistentPipelineCache::FindShaderModuleIdentifier(const std::vector<uint32_t>& SPIRV, ShaderModuleIdentifier& Id)
+{
+    if (!m_ShaderModuleIdsEnabled)
+        return false;
+
+    const Uint64 Key = ComputeSPIRVKey(SPIRV);
+
+    std::lock_guard<std::mutex> Lock{m_ShaderModuleIdsMtx};
+
+    auto it = m_ShaderModuleIds.find(Key);
+    if (it == m_ShaderModuleIds.end())
+        return false;
+
+    Id = it->second;
+    return true;
+}
+
+void PersistentPipelineCache::AddShaderModuleIdentifier(const std::vector<uint32_t>& SPIRV, VkShaderModule vkModule)
+{
+    if (!m_ShaderModuleIdsEnabled)
+        return;
+
+    VkShaderModuleIdentifierEXT vkId{};
+    vkId.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_IDENTIFIER_EXT;
+    m_DeviceVkImpl.GetLogicalDevice().GetShaderModuleIdentifier(vkModule, vkId);
+    if (vkId.identifierSize == 0 || vkId.identifierSize > VK_MAX_SHADER_MODULE_IDENTIFIER_SIZE_EXT)
+        return;
+
+    ShaderModuleIdentifier Id;
+    Id.Size = vkId.identifierSize;
+    std::memcpy(Id.Data, vkId.identifier, vkId.identifierSize);
+
+    const Uint64 Key = ComputeSPIRVKey(SPIRV);
+
+    std::lock_guard<std::mutex> Lock{m_ShaderModuleIdsMtx};
+
+    auto it = m_ShaderModuleIds.find(Key);
+    if (it != m_ShaderModuleIds.end() &&
+        it->second.Size == Id.Size &&
+        std::memcmp(it->second.Data, Id.Data, Id.Size) == 0)
+        return;
+
+    m_ShaderModuleIds[Key] = Id;
+    m_IsDirty.store(true);
+}
+
+void PersistentPipelineCache::Release(VkPipelineCache vkCache)
+{
+    VERIFY_EXPR(vkCache != VK_NULL_HANDLE);
+
+    std::lock_guard<std::mutex> Lock{m_PoolMtx};
+    m_FreeCaches.push_back(vkCache);
+    m_IsDirty.store(true);
+}
+
+void PersistentPipelineCache::Save()
+{
+    std::lock_guard<std::mutex> SaveLock{m_SaveMtx};
+    if (!m_MainCache || !m_IsDirty.exchange(false))
+        return;
+
+    const VkDevice vkDevice = m_DeviceVkImpl.GetLogicalDevice().GetVkDevice();
+
+    std::vector<VkPipelineCache> SrcCaches;
+    {
+        // Source caches do not require external synchronization, so the caches
+        // may be merged while other threads are creating pipelines with them.
+        std::lock_guard<std::mutex> PoolLock{m_PoolMtx};
+        SrcCaches.reserve(m_Caches.size());
+        for (const auto& Cache : m_Caches)
+            SrcCaches.push_back(Cache);
+    }
+
+    if (!SrcCaches.empty())
+    {
+        if (vkMergePipelineCaches(vkDevice, m_MainCache, static_cast<uint32_t>(SrcCaches.size()), SrcCaches.data()) != VK_SUCCESS)
+        {
+            LOG_ERROR_MESSAGE("Failed to merge pipeline caches");
+            return;
+        }
+    }
+
+    size_t DataSize = 0;
+    if (vkGetPipelineCacheData(vkDevice, m_MainCache, &DataSize, nullptr) != VK_SUCCESS)
+        return;
+
+    std::vector<Uint8> FileData(sizeof(PipelineCacheFileHeader) + DataSize);
+    if (vkGetPipelineCacheData(vkDevice, m_MainCache, &DataSize, FileData.data() + sizeof(PipelineCacheFileHeader)) != VK_SUCCESS)
+        return;
+    FileData.resize(sizeof(PipelineCacheFileHeader) + DataSize);
+
+    const VkPhysicalDeviceProperties& Props = m_DeviceVkImpl.GetPhysicalDevice().GetProperties();
+
+    PipelineCacheFileHeader Header;
+    Header.VendorID      = Props.vendorID;
+    Header.DeviceID      = Props.deviceID;
+    Header.DriverVersion = Props.driverVersion;
+    Header.DataSize      = DataSize;
+
+    if (m_ShaderModuleIdsEnabled)
+    {
+        std::memcpy(Header.ShaderModuleIdAlgorithmUUID,
+                    m_DeviceVkImpl.GetPhysicalDevice().GetExtProperties().ShaderModuleIdentifier.shaderModuleIdentifierAlgorithmUUID,
+                    VK_UUID_SIZE);
+
+        std::lock_guard<std::mutex> Lock{m_ShaderModuleIdsMtx};
+
+        Header.NumShaderModuleIds = static_cast<Uint32>(m_ShaderModuleIds.size());
+        FileData.reserve(FileData.size() + m_ShaderModuleIds.size() * sizeof(ShaderModuleIdFileEntry));
+        for (const auto& it : m_ShaderModuleIds)
+        {
+            ShaderModuleIdFileEntry Entry;
+            Entry.Key  = it.first;
+            Entry.Size = it.second.Size;
+            std::memcpy(Entry.Data, it.second.Data, it.second.Size);
+
+            const Uint8* pEntry = reinterpret_cast<const Uint8*>(&Entry);
+            FileData.insert(FileData.end(), pEntry, pEntry + sizeof(Entry));
+        }
+    }
+
+    Header.DataHash = ComputeHashRaw(FileData.data() + sizeof(Header), FileData.size() - sizeof(Header));
+    std::memcpy(FileData.data(), &Header, sizeof(Header));
+
+    if (!FileWrapper::WriteFile(m_FilePath.c_str(), FileData.data(), FileData.size(), /*Silent = */ true))
+        LOG_ERROR_MESSAGE("Failed to save pipeline cache to file '", m_FilePath, "'");
+}
+
+void PersistentPipelineCache::SaveThreadFunc(Uint32 SaveInterval)
+{
+    std::unique_lock<std::mutex> Lock{m_SaveThreadMtx};
+    while (!m_SaveThreadCV.wait_for(Lock, std::chrono::seconds{SaveInterval}, [this]() { return m_StopSaveThread; }))
+    {
+        Lock.unlock();
+        Save();
+        Lock.lock();
+    }
+}
+
+void PersistentPipelineCache::StopSaveThread()
+{
+    if (!m_SaveThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> Lock{m_SaveThreadMtx};
+        m_StopSaveThread = true;
+    }
+    m_SaveThreadCV.notify_one();
+    m_SaveThread.join();
+}
+
+void PersistentPipelineCache::Destroy()
+{
+    StopSaveThread();
+    Save();
+
+    // Pipelines created with the caches do not reference them, so the caches
+    // can be destroyed immediately.
+    std::lock_guard<std::mutex> Lock{m_PoolMtx};
+    VERIFY(m_FreeCaches.size() == m_Caches.size(), "Not all pooled pipeline caches have been released");
+    m_FreeCaches.clear();
+    m_Caches.clear();
+    m_MainCache.Release();
+}
+
+} // namespace Diligent
@@ -0,0 +1,223 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "PipelineLayoutCache.hpp"
+
+#include "RenderDeviceVkImpl.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+PipelineLayoutCache::SetLayoutKey::SetLayoutKey(const VkDescriptorSetLayoutCreateInfo& LayoutCI) :
+    Flags{LayoutCI.flags}
+{
+    VERIFY(LayoutCI.pNext == nullptr, "Extension structures are not taken into account by the cache");
+
+    Bindings.reserve(LayoutCI.bindingCount);
+    HashCombine(Hash, Flags, LayoutCI.bindingCount);
+    for (uint32_t i = 0; i < LayoutCI.bindingCount; ++i)
+    {
+        VkDescriptorSetLayoutBinding Binding = LayoutCI.pBindings[i];
+        HashCombine(Hash, Binding.binding, Binding.descriptorType, Binding.descriptorCount, Binding.stageFlags);
+        if (Binding.pImmutableSamplers != nullptr)
+        {
+            for (uint32_t s = 0; s < Binding.descriptorCount; ++s)
+            {
+                ImmutableSamplers.push_back(Binding.pImmutableSamplers[s]);
+                HashCombine(Hash, Binding.pImmutableSamplers[s]);
+            }
+        }
+        else
+        {
+            // Null entry marks a binding without immutable samplers, which makes
+            // the sampler sequence unambiguous as valid handles are never null.
+            ImmutableSamplers.push_back(VK_NULL_HANDLE);
+            HashCombine(Hash, VkSampler{VK_NULL_HANDLE});
+        }
+        Binding.pImmutableSamplers = nullptr;
+        Bindings.push_back(Binding);
+    }
+}
+
+bool PipelineLayoutCache::SetLayoutKey::operator==(const SetLayoutKey& rhs) const
+{
+    // clang-format off
+    if (Hash              != rhs.Hash            ||
+        Flags             != rhs.Flags           ||
+        Bindings.size()   != rhs.Bindings.size() ||
+        ImmutableSamplers != rhs.ImmutableSamplers)
+        return false;
+    // clang-format on
+
+    for (size_t i = 0; i < Bindings.size(); ++i)
+    {
+        const auto& B0 = Bindings[i];
+        const auto& B1 = rhs.Bindings[i];
+        // clang-format off
+        if (B0.binding         != B1.binding         ||
+            B0.descriptorType  != B1.descriptorType  ||
+            B0.descriptorCount != B1.descriptorCount ||
+            B0.stageFlags      != B1.stageFlags)
+            return false;
+        // clang-format on
+    }
+
+    return true;
+}
+
+PipelineLayoutCache::PipelineLayoutKey::PipelineLayoutKey(const SetLayoutRef* const* ppSetLayouts, Uint32 SetLayoutCount) :
+    SetLayouts(SetLayoutCount)
+{
+    HashCombine(Hash, SetLayoutCount);
+    for (Uint32 i = 0; i < SetLayoutCount; ++i)
+    {
+        VERIFY_EXPR(*ppSetLayouts[i]);
+        SetLayouts[i] = *ppSetLayouts[i];
+        HashCombine(Hash, SetLayouts[i]);
+    }
+}
+
+
+PipelineLayoutCache::PipelineLayoutCache(RenderDeviceVkImpl& DeviceVk) noexcept :
+    m_DeviceVkImpl{DeviceVk}
+{}
+
+PipelineLayoutCache::~PipelineLayoutCache()
+{
+    // All layouts are released by resource signatures and pipeline states,
+    // which must have been destroyed by now.
+    VERIFY(m_PipelineLayouts.empty(), "Pipeline layout cache is not empty. There are ", m_PipelineLayouts.size(), " outstanding pipeline layout(s).");
+    VERIFY(m_SetLayouts.empty(), "Pipeline layout cache is not empty. There are ", m_SetLayouts.size(), " outstanding descriptor set layout(s).");
+}
+
+PipelineLayoutCache::SetLayoutRef PipelineLayoutCache::GetSetLayout(const VkDescriptorSetLayoutCreateInfo& LayoutCI) noexcept(false)
+{
+    SetLayoutKey Key{LayoutCI};
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = m_SetLayouts.find(Key);
+    if (it == m_SetLayouts.end())
+    {
+        SetLayoutEntry Entry;
+        Entry.vkLayout = m_DeviceVkImpl.GetLogicalDevice().CreateDescriptorSetLayout(LayoutCI);
+
+        it = m_SetLayouts.emplace(std::move(Key), std::move(Entry)).first;
+    }
+    ++it->second.RefCount;
+
+    return SetLayoutRef{this, &*it};
+}
+
+PipelineLayoutCache::PipelineLayoutRef PipelineLayoutCache::GetPipelineLayout(const SetLayoutRef* const* ppSetLayouts, Uint32 SetLayoutCount) noexcept(false)
+{
+    PipelineLayoutKey Key{ppSetLayouts, SetLayoutCount};
+
+    // Take references to the set layouts before acquiring the lock as copying a reference locks the cache.
+    // If the layout is found in the cache, the references are released after the lock.
+    std::vector<SetLayoutRef> SetLayouts;
+    SetLayouts.reserve(SetLayoutCount);
+    for (Uint32 i = 0; i < SetLayoutCount; ++i)
+        SetLayouts.emplace_back(*ppSetLayouts[i]);
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = m_PipelineLayouts.find(Key);
+    if (it == m_PipelineLayouts.end())
+    {
+        VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
+
+        PipelineLayoutCI.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        PipelineLayoutCI.pNext                  = nullptr;
+        PipelineLayoutCI.flags                  = 0; // reserved for future use
+        PipelineLayoutCI.setLayoutCount         = SetLayoutCount;
+        PipelineLayoutCI.pSetLayouts            = SetLayoutCount ? Key.SetLayouts.data() : nullptr;
+        PipelineLayoutCI.pushConstantRangeCount = 0;
+        PipelineLayoutCI.pPushConstantRanges    = nullptr;
+
+        PipelineLayoutEntry Entry;
+        Entry.vkLayout   = m_DeviceVkImpl.GetLogicalDevice().CreatePipelineLayout(PipelineLayoutCI);
+        Entry.SetLayouts = std::move(SetLayouts);
+
+        it = m_PipelineLayouts.emplace(std::move(Key), std::move(Entry)).first;
+    }
+    ++it->second.RefCount;
+
+    return PipelineLayoutRef{this, &*it};
+}
+
+template <typename NodeType>
+void PipelineLayoutCache::AddRef(NodeType* pNode)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    VERIFY_EXPR(pNode->second.RefCount > 0);
+    ++pNode->second.RefCount;
+}
+
+template void PipelineLayoutCache::AddRef<PipelineLayoutCache::SetLayoutMapType::value_type>(SetLayoutMapType::value_type* pNode);
+template void PipelineLayoutCache::AddRef<PipelineLayoutCache::PipelineLayoutMapType::value_type>(PipelineLayoutMapType::value_type* pNode);
+
+void PipelineLayoutCache::Release(SetLayoutMapType::value_type* pNode)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    VERIFY_EXPR(pNode->second.RefCount > 0);
+    if (--pNode->second.RefCount > 0)
+        return;
+
+    // The layout may be shared by objects that are used by any queue
+    m_DeviceVkImpl.SafeReleaseDeviceObject(std::move(pNode->second.vkLayout), ~0ull);
+
+    auto it = m_SetLayouts.find(pNode->first);
+    VERIFY_EXPR(it != m_SetLayouts.end() && &*it == pNode);
+    m_SetLayouts.erase(it);
+}
+
+void PipelineLayoutCache::Release(PipelineLayoutMapType::value_type* pNode)
+{
+    // Set layout references must be released after the lock is released
+    std::vector<SetLayoutRef> SetLayouts;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mutex};
+
+        VERIFY_EXPR(pNode->second.RefCount > 0);
+        if (--pNode->second.RefCount > 0)
+            return;
+
+        m_DeviceVkImpl.SafeReleaseDeviceObject(std::move(pNode->second.vkLayout), ~0ull);
+        SetLayouts = std::move(pNode->second.SetLayouts);
+
+        auto it = m_PipelineLayouts.find(pNode->first);
+        VERIFY_EXPR(it != m_PipelineLayouts.end() && &*it == pNode);
+        m_PipelineLayouts.erase(it);
+    }
+}
+
+} // namespace Diligent
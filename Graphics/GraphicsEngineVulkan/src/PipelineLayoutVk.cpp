@@ -37,6 +37,7 @@
 
 #include "VulkanTypeConversions.hpp"
 #include "StringTools.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -51,19 +52,18 @@ PipelineLayoutVk::~PipelineLayoutVk()
     VERIFY(!m_VkPipelineLayout, "Pipeline layout have not been released!");
 }
 
-void PipelineLayoutVk::Release(RenderDeviceVkImpl* pDeviceVk, Uint64 CommandQueueMask)
+void PipelineLayoutVk::Release()
 {
-    if (m_VkPipelineLayout)
-    {
-        pDeviceVk->SafeReleaseDeviceObject(std::move(m_VkPipelineLayout), CommandQueueMask);
-    }
+    // The layout may be shared with other pipelines, so the cache releases
+    // it through the release queues of all command queues once it is unused.
+    m_VkPipelineLayout.Release();
 }
 
 void PipelineLayoutVk::Create(RenderDeviceVkImpl* pDeviceVk, RefCntAutoPtr<PipelineResourceSignatureVkImpl> ppSignatures[], Uint32 SignatureCount) noexcept(false)
 {
     VERIFY(m_DescrSetCount == 0 && !m_VkPipelineLayout, "This pipeline layout is already initialized");
 
-    std::array<VkDescriptorSetLayout, MAX_RESOURCE_SIGNATURES * PipelineResourceSignatureVkImpl::MAX_DESCRIPTOR_SETS> DescSetLayouts;
+    std::array<const PipelineLayoutCache::SetLayoutRef*, MAX_RESOURCE_SIGNATURES * PipelineResourceSignatureVkImpl::MAX_DESCRIPTOR_SETS> DescSetLayouts;
 
     Uint32 DescSetLayoutCount        = 0;
     Uint32 DynamicUniformBufferCount = 0;
@@ -82,10 +82,27 @@ void PipelineLayoutVk::Create(RenderDeviceVkImpl* pDeviceVk, RefCntAutoPtr<Pipel
 
         for (auto SetId : {PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE, PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC})
         {
-            if (pSignature->HasDescriptorSet(SetId))
-                DescSetLayouts[DescSetLayoutCount++] = pSignature->GetVkDescriptorSetLayout(SetId);
+            if (!pSignature->HasDescriptorSet(SetId))
+                continue;
+
+            // Only one push descriptor set is allowed in a pipeline layout, so use it for the first signature that supports it.
+            // Note that the choice only depends on signatures [0..BindInd], which keeps layouts with compatible
+            // signatures compatible.
+            if (SetId == PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC &&
+                m_PushDescrSetBindIndex == InvalidPushDescrSetBindIndex &&
+                pSignature->HasPushDescriptorSetLayout())
+            {
+                m_PushDescrSetBindIndex              = static_cast<Uint8>(BindInd);
+                DescSetLayouts[DescSetLayoutCount++] = &pSignature->GetPushDescriptorSetLayoutRef();
+            }
+            else
+            {
+                DescSetLayouts[DescSetLayoutCount++] = &pSignature->GetDescriptorSetLayoutRef(SetId);
+            }
         }
 
+        HashCombine(m_Hash, BindInd, pSignature->GetHash());
+
         DynamicUniformBufferCount += pSignature->GetDynamicUniformBufferCount();
         DynamicStorageBufferCount += pSignature->GetDynamicStorageBufferCount();
 #ifdef DILIGENT_DEBUG
@@ -116,18 +133,11 @@ void PipelineLayoutVk::Create(RenderDeviceVkImpl* pDeviceVk, RefCntAutoPtr<Pipel
     VERIFY(m_DescrSetCount <= std::numeric_limits<decltype(m_DescrSetCount)>::max(),
            "Descriptor set count (", DescSetLayoutCount, ") exceeds the maximum representable value");
 
-    VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
-
-    PipelineLayoutCI.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    PipelineLayoutCI.pNext                  = nullptr;
-    PipelineLayoutCI.flags                  = 0; // reserved for future use
-    PipelineLayoutCI.setLayoutCount         = DescSetLayoutCount;
-    PipelineLayoutCI.pSetLayouts            = DescSetLayoutCount ? DescSetLayouts.data() : nullptr;
-    PipelineLayoutCI.pushConstantRangeCount = 0;
-    PipelineLayoutCI.pPushConstantRanges    = nullptr;
-    m_VkPipelineLayout                      = pDeviceVk->GetLogicalDevice().CreatePipelineLayout(PipelineLayoutCI);
+    m_VkPipelineLayout = pDeviceVk->GetPipelineLayoutCache().GetPipelineLayout(DescSetLayouts.data(), DescSetLayoutCount);
 
     m_DescrSetCount = static_cast<Uint8>(DescSetLayoutCount);
+
+    HashCombine(m_Hash, m_PushDescrSetBindIndex);
 }
 
 } // namespace Diligent
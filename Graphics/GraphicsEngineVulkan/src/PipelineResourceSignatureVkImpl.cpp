@@ -155,7 +155,7 @@ PipelineResourceSignatureVkImpl::PipelineResourceSignatureVkImpl(IReferenceCount
             },
             [this]() //
             {
-                return ShaderResourceCacheVk::GetRequiredMemorySize(GetNumDescriptorSets(), m_DescriptorSetSizes.data());
+                return ShaderResourceCacheVk::GetRequiredMemorySize(GetNumDescriptorSets(), m_DescriptorSetSizes.data(), GetDescriptorBufferLayouts());
             });
     }
     catch (...)
@@ -248,6 +248,11 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
 
     DynamicLinearAllocator TempAllocator{GetRawAllocator(), 256};
 
+    const bool UseDescriptorBuffer = HasDevice() && GetDevice()->IsDescriptorBufferEnabled();
+    // Immutable samplers assigned to each resource. Only used with descriptor buffers, since
+    // the samplers must be written to the buffer explicitly.
+    std::vector<const VkSampler*> ResourceImmutableSamplers(UseDescriptorBuffer ? m_Desc.NumResources : 0, nullptr);
+
     std::vector<bool> ImmutableSamplerWithResource(m_Desc.NumImmutableSamplers, false);
     for (Uint32 i = 0; i < m_Desc.NumResources; ++i)
     {
@@ -329,9 +334,14 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
         vkSetLayoutBinding.descriptorCount    = ResDesc.ArraySize;
         vkSetLayoutBinding.stageFlags         = ShaderTypesToVkShaderStageFlags(ResDesc.ShaderStages);
         vkSetLayoutBinding.pImmutableSamplers = pVkImmutableSamplers;
-        vkSetLayoutBinding.descriptorType     = DescriptorTypeToVkDescriptorType(pAttribs->GetDescriptorType());
+        vkSetLayoutBinding.descriptorType     = UseDescriptorBuffer ?
+            DescriptorTypeToVkDescriptorBufferType(pAttribs->GetDescriptorType()) :
+            DescriptorTypeToVkDescriptorType(pAttribs->GetDescriptorType());
         vkSetLayoutBindings[SetId].push_back(vkSetLayoutBinding);
 
+        if (UseDescriptorBuffer)
+            ResourceImmutableSamplers[i] = pVkImmutableSamplers;
+
         if (ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
         {
             VERIFY(pAttribs->DescrSet == 0, "Static resources must always be allocated in descriptor set 0");
@@ -453,11 +463,11 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
 
     SetLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     SetLayoutCI.pNext = nullptr;
-    SetLayoutCI.flags = 0;
+    SetLayoutCI.flags = UseDescriptorBuffer ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0;
 
     if (HasDevice())
     {
-        const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+        auto& LayoutCache = GetDevice()->GetPipelineLayoutCache();
 
         for (size_t i = 0; i < vkSetLayoutBindings.size(); ++i)
         {
@@ -467,9 +477,141 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
 
             SetLayoutCI.bindingCount = StaticCast<uint32_t>(vkSetLayoutBinding.size());
             SetLayoutCI.pBindings    = vkSetLayoutBinding.data();
-            m_VkDescrSetLayouts[i]   = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
+            m_VkDescrSetLayouts[i]   = LayoutCache.GetSetLayout(SetLayoutCI);
         }
         VERIFY_EXPR(NumSets == GetNumDescriptorSets());
+
+        if (CanUsePushDescriptors(vkSetLayoutBindings[DESCRIPTOR_SET_ID_DYNAMIC]))
+        {
+            // Create an alternative layout for the dynamic set. The pipeline layout decides which one to use
+            // since only one push descriptor set is allowed per pipeline layout.
+            const auto& DynSetBindings = vkSetLayoutBindings[DESCRIPTOR_SET_ID_DYNAMIC];
+
+            SetLayoutCI.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+            SetLayoutCI.bindingCount = StaticCast<uint32_t>(DynSetBindings.size());
+            SetLayoutCI.pBindings    = DynSetBindings.data();
+            m_VkPushDescrSetLayout   = LayoutCache.GetSetLayout(SetLayoutCI);
+        }
+
+        if (UseDescriptorBuffer)
+            InitDescriptorBufferLayouts(DSMapping, ResourceImmutableSamplers);
+    }
+}
+
+bool PipelineResourceSignatureVkImpl::CanUsePushDescriptors(const std::vector<VkDescriptorSetLayoutBinding>& DynSetBindings) const
+{
+    const auto* pDevice = GetDevice();
+    if (!pDevice->IsPushDescriptorEnabled() || DynSetBindings.empty())
+        return false;
+
+    Uint32 NumDescriptors = 0;
+    for (const auto& Binding : DynSetBindings)
+    {
+        // Push descriptor set layouts must not contain descriptors with dynamic offsets
+        if (Binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC ||
+            Binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)
+            return false;
+
+        NumDescriptors += Binding.descriptorCount;
+    }
+
+    const Uint32 MaxPushDescriptors = pDevice->GetPhysicalDevice().GetExtProperties().PushDescriptor.maxPushDescriptors;
+    return NumDescriptors <= std::min(MaxPushDescriptors, MaxPushDescriptorSetSize);
+}
+
+static Uint32 GetDescriptorBufferDescriptorSize(const VkPhysicalDeviceDescriptorBufferPropertiesEXT& Props,
+                                                VkDescriptorType                                     vkType,
+                                                bool                                                 RobustBufferAccess)
+{
+    switch (vkType)
+    {
+        // clang-format off
+        case VK_DESCRIPTOR_TYPE_SAMPLER:                    return static_cast<Uint32>(Props.samplerDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:     return static_cast<Uint32>(Props.combinedImageSamplerDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:              return static_cast<Uint32>(Props.sampledImageDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:              return static_cast<Uint32>(Props.storageImageDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:       return static_cast<Uint32>(RobustBufferAccess ? Props.robustUniformTexelBufferDescriptorSize : Props.uniformTexelBufferDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:       return static_cast<Uint32>(RobustBufferAccess ? Props.robustStorageTexelBufferDescriptorSize : Props.storageTexelBufferDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:             return static_cast<Uint32>(RobustBufferAccess ? Props.robustUniformBufferDescriptorSize : Props.uniformBufferDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:             return static_cast<Uint32>(RobustBufferAccess ? Props.robustStorageBufferDescriptorSize : Props.storageBufferDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:           return static_cast<Uint32>(Props.inputAttachmentDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR: return static_cast<Uint32>(Props.accelerationStructureDescriptorSize);
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected descriptor type");
+            return 0;
+    }
+}
+
+void PipelineResourceSignatureVkImpl::InitDescriptorBufferLayouts(const std::array<Uint32, DESCRIPTOR_SET_ID_NUM_SETS>& DSMapping,
+                                                                  const std::vector<const VkSampler*>&                 ResourceImmutableSamplers)
+{
+    const auto& LogicalDevice  = GetDevice()->GetLogicalDevice();
+    const auto& DescrBuffProps = GetDevice()->GetPhysicalDevice().GetExtProperties().DescriptorBuffer;
+    const bool  IsRobust       = LogicalDevice.GetEnabledFeatures().robustBufferAccess != VK_FALSE;
+
+    // Descriptor set layouts are indexed by DESCRIPTOR_SET_ID, while resource cache sets are indexed by the set index
+    const auto GetSetLayout = [&](Uint32 SetIndex) {
+        for (Uint32 SetId = 0; SetId < DESCRIPTOR_SET_ID_NUM_SETS; ++SetId)
+        {
+            if (DSMapping[SetId] == SetIndex)
+                return static_cast<VkDescriptorSetLayout>(m_VkDescrSetLayouts[SetId]);
+        }
+        UNEXPECTED("Descriptor set ", SetIndex, " is not found");
+        return VkDescriptorSetLayout{VK_NULL_HANDLE};
+    };
+
+    const Uint32 NumSets = GetNumDescriptorSets();
+    for (Uint32 s = 0; s < NumSets; ++s)
+    {
+        auto& Layout = m_DescrBufferLayouts[s];
+
+        Layout.DataSize = StaticCast<Uint32>(LogicalDevice.GetDescriptorSetLayoutSize(GetSetLayout(s)));
+        Layout.Descriptors.resize(m_DescriptorSetSizes[s]);
+    }
+
+    for (Uint32 i = 0; i < m_Desc.NumResources; ++i)
+    {
+        const auto&            ResDesc   = m_Desc.Resources[i];
+        const ResourceAttribs& Attribs   = m_pResourceAttribs[i];
+        const VkSampler*       pSamplers = ResourceImmutableSamplers[i];
+
+        const VkDescriptorSetLayout vkLayout = GetSetLayout(Attribs.DescrSet);
+        const Uint32                Offset   = StaticCast<Uint32>(LogicalDevice.GetDescriptorSetLayoutBindingOffset(vkLayout, Attribs.BindingIndex));
+        const Uint32                Size     = GetDescriptorBufferDescriptorSize(DescrBuffProps, DescriptorTypeToVkDescriptorBufferType(Attribs.GetDescriptorType()), IsRobust);
+
+        auto& Descriptors = m_DescrBufferLayouts[Attribs.DescrSet].Descriptors;
+        for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
+        {
+            auto& Descr{Descriptors[Attribs.SRBCacheOffset + ArrInd]};
+
+            // Array elements are tightly packed in the descriptor buffer
+            Descr.Offset           = Offset + ArrInd * Size;
+            Descr.Size             = Size;
+            Descr.ImmutableSampler = pSamplers != nullptr ? pSamplers[ArrInd] : VK_NULL_HANDLE;
+        }
+    }
+
+    for (Uint32 i = 0; i < m_Desc.NumImmutableSamplers; ++i)
+    {
+        const ImmutableSamplerAttribsVk& ImtblSampAttribs = m_pImmutableSamplerAttribs[i];
+        if (ImtblSampAttribs.DescrSet == ~0u)
+        {
+            // The sampler is assigned to a resource
+            continue;
+        }
+
+        const RefCntAutoPtr<SamplerVkImpl>& pSamplerVk = m_pImmutableSamplers[i];
+        if (!pSamplerVk)
+            continue;
+
+        const VkDescriptorSetLayout vkLayout = GetSetLayout(ImtblSampAttribs.DescrSet);
+
+        DescriptorBufferSetLayoutVk::Descriptor Descr;
+        Descr.Offset           = StaticCast<Uint32>(LogicalDevice.GetDescriptorSetLayoutBindingOffset(vkLayout, ImtblSampAttribs.BindingIndex));
+        Descr.Size             = static_cast<Uint32>(DescrBuffProps.samplerDescriptorSize);
+        Descr.ImmutableSampler = pSamplerVk->GetVkSampler();
+        m_DescrBufferLayouts[ImtblSampAttribs.DescrSet].ImmutableSamplers.push_back(Descr);
     }
 }
 
@@ -480,11 +622,10 @@ PipelineResourceSignatureVkImpl::~PipelineResourceSignatureVkImpl()
 
 void PipelineResourceSignatureVkImpl::Destruct()
 {
+    // The cache releases the layouts when they are no longer used by any signature
     for (auto& Layout : m_VkDescrSetLayouts)
-    {
-        if (Layout)
-            GetDevice()->SafeReleaseDeviceObject(std::move(Layout), ~0ull);
-    }
+        Layout.Release();
+    m_VkPushDescrSetLayout.Release();
 
     TPipelineResourceSignatureBase::Destruct();
 }
@@ -498,7 +639,7 @@ void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk
 #endif
 
     auto& CacheMemAllocator = m_SRBMemAllocator.GetResourceCacheDataAllocator(0);
-    ResourceCache.InitializeSets(CacheMemAllocator, NumSets, m_DescriptorSetSizes.data());
+    ResourceCache.InitializeSets(CacheMemAllocator, NumSets, m_DescriptorSetSizes.data(), GetDescriptorBufferLayouts());
 
     const auto TotalResources = GetTotalResourceCount();
     const auto CacheType      = ResourceCache.GetContentType();
@@ -514,7 +655,12 @@ void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk
     ResourceCache.DbgVerifyResourceInitialization();
 #endif
 
-    if (auto vkLayout = GetVkDescriptorSetLayout(DESCRIPTOR_SET_ID_STATIC_MUTABLE))
+    if (GetDescriptorBufferLayouts() != nullptr)
+    {
+        // Descriptor data is stored in the resource cache and copied to the descriptor buffer when committed
+        ResourceCache.InitializeImmutableSamplerDescriptors(GetDevice()->GetLogicalDevice());
+    }
+    else if (auto vkLayout = GetVkDescriptorSetLayout(DESCRIPTOR_SET_ID_STATIC_MUTABLE))
     {
         const char* DescrSetName = "Static/Mutable Descriptor Set";
 #ifdef DILIGENT_DEVELOPMENT
@@ -608,8 +754,36 @@ Uint32 PipelineResourceSignatureVkImpl::GetDescriptorSetIndex<PipelineResourceSi
 void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                                              VkDescriptorSet              vkDynamicDescriptorSet) const
 {
-    VERIFY(HasDescriptorSet(DESCRIPTOR_SET_ID_DYNAMIC), "This signature does not contain dynamic resources");
     VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
+
+    const VulkanUtilities::VulkanLogicalDevice& LogicalDevice = GetDevice()->GetLogicalDevice();
+    WriteDynamicResources(ResourceCache, vkDynamicDescriptorSet,
+                          [&LogicalDevice](Uint32 DescrWriteCount, const VkWriteDescriptorSet* pDescrWrites) {
+                              LogicalDevice.UpdateDescriptorSets(DescrWriteCount, pDescrWrites, 0, nullptr);
+                          });
+}
+
+void PipelineResourceSignatureVkImpl::PushDynamicResources(const ShaderResourceCacheVk&          ResourceCache,
+                                                           VulkanUtilities::VulkanCommandBuffer& CmdBuffer,
+                                                           VkPipelineBindPoint                   BindPoint,
+                                                           VkPipelineLayout                      vkLayout,
+                                                           Uint32                                SetIndex) const
+{
+    VERIFY(HasPushDescriptorSetLayout(), "This signature does not support push descriptors");
+
+    // dstSet is ignored by vkCmdPushDescriptorSetKHR
+    WriteDynamicResources(ResourceCache, VK_NULL_HANDLE,
+                          [&](Uint32 DescrWriteCount, const VkWriteDescriptorSet* pDescrWrites) {
+                              CmdBuffer.PushDescriptorSet(BindPoint, vkLayout, SetIndex, DescrWriteCount, pDescrWrites);
+                          });
+}
+
+template <typename FlushWritesType>
+void PipelineResourceSignatureVkImpl::WriteDynamicResources(const ShaderResourceCacheVk& ResourceCache,
+                                                            VkDescriptorSet              vkDynamicDescriptorSet,
+                                                            FlushWritesType              FlushWrites) const
+{
+    VERIFY(HasDescriptorSet(DESCRIPTOR_SET_ID_DYNAMIC), "This signature does not contain dynamic resources");
     VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
 
 #ifdef DILIGENT_DEBUG
@@ -641,7 +815,6 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
 
     const Uint32                                DynamicSetIdx  = GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>();
     const ShaderResourceCacheVk::DescriptorSet& SetResources   = ResourceCache.GetDescriptorSet(DynamicSetIdx);
-    const VulkanUtilities::VulkanLogicalDevice& LogicalDevice  = GetDevice()->GetLogicalDevice();
     const std::pair<Uint32, Uint32>             DynResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
 
     constexpr ResourceCacheContentType CacheType = ResourceCacheContentType::SRB;
@@ -665,7 +838,6 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
         WriteDescrSetIt->pNext = nullptr;
         VERIFY(SetResources.GetVkDescriptorSet() == VK_NULL_HANDLE, "Dynamic descriptor set must not be assigned to the resource cache");
         WriteDescrSetIt->dstSet = vkDynamicDescriptorSet;
-        VERIFY(WriteDescrSetIt->dstSet != VK_NULL_HANDLE, "Vulkan descriptor set must not be null");
         WriteDescrSetIt->dstBinding      = Attr.BindingIndex;
         WriteDescrSetIt->dstArrayElement = ArrElem;
         // descriptorType must be the same type as that specified in VkDescriptorSetLayoutBinding for dstSet at dstBinding.
@@ -781,7 +953,7 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
         {
             Uint32 DescrWriteCount = static_cast<Uint32>(std::distance(WriteDescrSetArr.begin(), WriteDescrSetIt));
             if (DescrWriteCount > 0)
-                LogicalDevice.UpdateDescriptorSets(DescrWriteCount, WriteDescrSetArr.data(), 0, nullptr);
+                FlushWrites(DescrWriteCount, WriteDescrSetArr.data());
 
             DescrImgIt      = DescrImgInfoArr.begin();
             DescrBuffIt     = DescrBuffInfoArr.begin();
@@ -793,7 +965,7 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
 
     Uint32 DescrWriteCount = static_cast<Uint32>(std::distance(WriteDescrSetArr.begin(), WriteDescrSetIt));
     if (DescrWriteCount > 0)
-        LogicalDevice.UpdateDescriptorSets(DescrWriteCount, WriteDescrSetArr.data(), 0, nullptr);
+        FlushWrites(DescrWriteCount, WriteDescrSetArr.data());
 }
 
 
@@ -958,7 +1130,7 @@ PipelineResourceSignatureVkImpl::PipelineResourceSignatureVkImpl(IReferenceCount
             },
             [this]() //
             {
-                return ShaderResourceCacheVk::GetRequiredMemorySize(GetNumDescriptorSets(), m_DescriptorSetSizes.data());
+                return ShaderResourceCacheVk::GetRequiredMemorySize(GetNumDescriptorSets(), m_DescriptorSetSizes.data(), GetDescriptorBufferLayouts());
             });
     }
     catch (...)
@@ -38,10 +38,13 @@
 #include "RenderPassVkImpl.hpp"
 #include "ShaderResourceBindingVkImpl.hpp"
 #include "PipelineStateCacheVkImpl.hpp"
+#include "GraphicsPipelineLibraryCache.hpp"
 
 #include "VulkanTypeConversions.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
+#include "HashUtils.hpp"
+#include "ThreadPool.hpp"
 
 #if !DILIGENT_NO_HLSL
 #    include "SPIRVTools.hpp"
@@ -55,18 +58,16 @@ constexpr INTERFACE_ID PipelineStateVkImpl::IID_InternalImpl;
 namespace
 {
 
-void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&        LogicalDevice,
-                              PipelineStateVkImpl::TShaderStages&                ShaderStages,
-                              std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
-                              std::vector<VkPipelineShaderStageCreateInfo>&      Stages)
+// Initializes the shader stages without the shader modules, which are created by CreateShaderModules().
+void InitPipelineShaderStages(const PipelineStateVkImpl::TShaderStages&     ShaderStages,
+                              std::vector<VkPipelineShaderStageCreateInfo>& Stages)
 {
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
         const auto& Shaders    = ShaderStages[s].Shaders;
-        auto&       SPIRVs     = ShaderStages[s].SPIRVs;
         const auto  ShaderType = ShaderStages[s].Type;
 
-        VERIFY_EXPR(Shaders.size() == SPIRVs.size());
+        VERIFY_EXPR(Shaders.size() == ShaderStages[s].SPIRVs.size());
 
         VkPipelineShaderStageCreateInfo StageCI{};
         StageCI.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -74,30 +75,92 @@ void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&
         StageCI.flags = 0; //  reserved for future use
         StageCI.stage = ShaderTypeToVkShaderStageFlagBit(ShaderType);
 
-        VkShaderModuleCreateInfo ShaderModuleCI{};
-        ShaderModuleCI.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        ShaderModuleCI.pNext = nullptr;
-        ShaderModuleCI.flags = 0;
-
         for (size_t i = 0; i < Shaders.size(); ++i)
         {
-            auto* pShader = Shaders[i];
-            auto& SPIRV   = SPIRVs[i];
+            StageCI.module              = VK_NULL_HANDLE;
+            StageCI.pName               = Shaders[i]->GetEntryPoint();
+            StageCI.pSpecializationInfo = nullptr;
+
+            Stages.push_back(StageCI);
+        }
+    }
+}
+
+// Creates the shader modules for all stages. If pModuleIdCache is not null, the module
+// identifiers are added to the cache so that the modules can be skipped on the next run.
+void CreateShaderModules(const VulkanUtilities::VulkanLogicalDevice&        LogicalDevice,
+                         const PipelineStateVkImpl::TShaderStages&          ShaderStages,
+                         std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
+                         std::vector<VkPipelineShaderStageCreateInfo>&      Stages,
+                         PersistentPipelineCache*                           pModuleIdCache)
+{
+    VkShaderModuleCreateInfo ShaderModuleCI{};
+    ShaderModuleCI.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    ShaderModuleCI.pNext = nullptr;
+    ShaderModuleCI.flags = 0;
+
+    size_t StageIdx = 0;
+    for (const auto& Stage : ShaderStages)
+    {
+        for (size_t i = 0; i < Stage.Shaders.size(); ++i, ++StageIdx)
+        {
+            const auto& SPIRV = Stage.SPIRVs[i];
 
             ShaderModuleCI.codeSize = SPIRV.size() * sizeof(uint32_t);
             ShaderModuleCI.pCode    = SPIRV.data();
 
-            ShaderModules.push_back(LogicalDevice.CreateShaderModule(ShaderModuleCI, pShader->GetDesc().Name));
+            ShaderModules.push_back(LogicalDevice.CreateShaderModule(ShaderModuleCI, Stage.Shaders[i]->GetDesc().Name));
 
-            StageCI.module              = ShaderModules.back();
-            StageCI.pName               = pShader->GetEntryPoint();
-            StageCI.pSpecializationInfo = nullptr;
+            // Remove the module identifier that may have been set by UseShaderModuleIdentifiers()
+            Stages[StageIdx].pNext  = nullptr;
+            Stages[StageIdx].module = ShaderModules.back();
 
-            Stages.push_back(StageCI);
+            if (pModuleIdCache != nullptr)
+                pModuleIdCache->AddShaderModuleIdentifier(SPIRV, ShaderModules.back());
         }
     }
+    VERIFY_EXPR(StageIdx == Stages.size());
+}
 
-    VERIFY_EXPR(ShaderModules.size() == Stages.size());
+struct ShaderModuleIdentifierStageInfo
+{
+    PersistentPipelineCache::ShaderModuleIdentifier    Id;
+    VkPipelineShaderStageModuleIdentifierCreateInfoEXT CI{};
+};
+
+// Makes the stages reference the shader modules by the identifiers stored in the persistent pipeline cache
+// (VK_EXT_shader_module_identifier). Returns false, leaving the stages intact, if any identifier is not found.
+bool UseShaderModuleIdentifiers(PersistentPipelineCache&                      ModuleIdCache,
+                                const PipelineStateVkImpl::TShaderStages&     ShaderStages,
+                                std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+                                std::vector<ShaderModuleIdentifierStageInfo>& IdStages)
+{
+    IdStages.resize(Stages.size());
+
+    size_t StageIdx = 0;
+    for (const auto& Stage : ShaderStages)
+    {
+        for (const auto& SPIRV : Stage.SPIRVs)
+        {
+            if (!ModuleIdCache.FindShaderModuleIdentifier(SPIRV, IdStages[StageIdx++].Id))
+                return false;
+        }
+    }
+    VERIFY_EXPR(StageIdx == Stages.size());
+
+    for (size_t i = 0; i < Stages.size(); ++i)
+    {
+        auto& IdStage{IdStages[i]};
+        IdStage.CI.sType          = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_MODULE_IDENTIFIER_CREATE_INFO_EXT;
+        IdStage.CI.pNext          = nullptr;
+        IdStage.CI.identifierSize = IdStage.Id.Size;
+        IdStage.CI.pIdentifier    = IdStage.Id.Data;
+
+        VERIFY_EXPR(Stages[i].module == VK_NULL_HANDLE);
+        Stages[i].pNext = &IdStage.CI;
+    }
+
+    return true;
 }
 
 
@@ -106,16 +169,20 @@ void CreateComputePipeline(RenderDeviceVkImpl*                           pDevice
                            const PipelineLayoutVk&                       Layout,
                            const PipelineStateDesc&                      PSODesc,
                            VulkanUtilities::PipelineWrapper&             Pipeline,
-                           VkPipelineCache                               vkPSOCache)
+                           VkPipelineCache                               vkPSOCache,
+                           VkPipelineCreateFlags                         ExtraFlags)
 {
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
 
     VkComputePipelineCreateInfo PipelineCI{};
     PipelineCI.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
     PipelineCI.pNext = nullptr;
+    PipelineCI.flags = ExtraFlags;
 #ifdef DILIGENT_DEBUG
-    PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
+    PipelineCI.flags |= VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
 #endif
+    if (pDeviceVk->IsDescriptorBufferEnabled())
+        PipelineCI.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
@@ -126,20 +193,123 @@ void CreateComputePipeline(RenderDeviceVkImpl*                           pDevice
 }
 
 
+using GraphicsPipelineLibrariesArray = std::array<VkPipeline, GraphicsPipelineLibraryCache::LIBRARY_TYPE_COUNT>;
+
+// Computes the hashes of the graphics pipeline libraries the pipeline is linked from.
+// Every hash covers all the state that is used to create the library of the corresponding type.
+std::array<size_t, GraphicsPipelineLibraryCache::LIBRARY_TYPE_COUNT> ComputeGraphicsPipelineLibraryHashes(
+    const PipelineStateVkImpl::TShaderStages&           ShaderStages,
+    const std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+    const PipelineLayoutVk&                             Layout,
+    const GraphicsPipelineDesc&                         GraphicsPipeline,
+    const IRenderPass*                                  pRenderPass)
+{
+    VERIFY_EXPR(ShaderStages.size() == Stages.size());
+
+    // Render pass or dynamic rendering attachment formats
+    size_t RenderTargetsHash = 0;
+    if (pRenderPass != nullptr)
+    {
+        RenderTargetsHash = ComputeHash(pRenderPass->GetDesc(), GraphicsPipeline.SubpassIndex);
+    }
+    else
+    {
+        RenderTargetsHash = ComputeHash(GraphicsPipeline.NumRenderTargets, GraphicsPipeline.DSVFormat);
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+            HashCombine(RenderTargetsHash, GraphicsPipeline.RTVFormats[rt]);
+    }
+
+    std::array<size_t, GraphicsPipelineLibraryCache::LIBRARY_TYPE_COUNT> Hashes{};
+
+    // Dynamic state depends on the scissor enable flag and shading rate flags
+    Hashes[GraphicsPipelineLibraryCache::LIBRARY_TYPE_VERTEX_INPUT] =
+        ComputeHash(GraphicsPipeline.InputLayout, GraphicsPipeline.PrimitiveTopology, GraphicsPipeline.RasterizerDesc.ScissorEnable, GraphicsPipeline.ShadingRateFlags);
+
+    Hashes[GraphicsPipelineLibraryCache::LIBRARY_TYPE_PRE_RASTERIZATION] =
+        ComputeHash(Layout.GetHash(), RenderTargetsHash, GraphicsPipeline.RasterizerDesc, GraphicsPipeline.PrimitiveTopology, GraphicsPipeline.NumViewports, GraphicsPipeline.ShadingRateFlags);
+
+    Hashes[GraphicsPipelineLibraryCache::LIBRARY_TYPE_FRAGMENT_SHADER] =
+        ComputeHash(Layout.GetHash(), RenderTargetsHash, GraphicsPipeline.DepthStencilDesc, GraphicsPipeline.SmplDesc, GraphicsPipeline.SampleMask,
+                    GraphicsPipeline.RasterizerDesc.ScissorEnable, GraphicsPipeline.ShadingRateFlags);
+
+    Hashes[GraphicsPipelineLibraryCache::LIBRARY_TYPE_FRAGMENT_OUTPUT] =
+        ComputeHash(RenderTargetsHash, GraphicsPipeline.BlendDesc, GraphicsPipeline.SmplDesc, GraphicsPipeline.SampleMask,
+                    GraphicsPipeline.RasterizerDesc.ScissorEnable, GraphicsPipeline.ShadingRateFlags);
+
+    for (size_t s = 0; s < ShaderStages.size(); ++s)
+    {
+        VERIFY(ShaderStages[s].SPIRVs.size() == 1, "Graphics pipelines must have exactly one shader per stage");
+        const auto& SPIRV = ShaderStages[s].SPIRVs[0];
+
+        auto& Hash = Hashes[ShaderStages[s].Type == SHADER_TYPE_PIXEL ? GraphicsPipelineLibraryCache::LIBRARY_TYPE_FRAGMENT_SHADER : GraphicsPipelineLibraryCache::LIBRARY_TYPE_PRE_RASTERIZATION];
+        HashCombine(Hash, ShaderStages[s].Type, ComputeHashRaw(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0])), CStringHash<char>{}(Stages[s].pName));
+    }
+
+    return Hashes;
+}
+
+// Links the pipeline libraries into a complete graphics pipeline. An optimized pipeline
+// takes longer to link, but its performance is on par with a monolithic pipeline.
+VulkanUtilities::PipelineWrapper LinkGraphicsPipelineLibraries(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                                               const GraphicsPipelineLibrariesArray&       Libraries,
+                                                               VkPipelineCreateFlags                       Flags,
+                                                               VkPipelineLayout                            vkLayout,
+                                                               bool                                        Optimize,
+                                                               VkPipelineCache                             vkPSOCache,
+                                                               const char*                                 Name)
+{
+    VkPipelineLibraryCreateInfoKHR LibraryCI{};
+    LibraryCI.sType        = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    LibraryCI.pNext        = nullptr;
+    LibraryCI.libraryCount = static_cast<uint32_t>(Libraries.size());
+    LibraryCI.pLibraries   = Libraries.data();
+
+    VkGraphicsPipelineCreateInfo PipelineCI{};
+    PipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    PipelineCI.pNext = &LibraryCI;
+    PipelineCI.flags = Flags;
+    if (Optimize)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT;
+    PipelineCI.layout             = vkLayout;
+    PipelineCI.basePipelineHandle = VK_NULL_HANDLE;
+    PipelineCI.basePipelineIndex  = -1;
+
+    return LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkPSOCache, Name);
+}
+
+// Mesh pipelines have no vertex input interface and are always created as monolithic objects.
+// Library hashes do not account for the dynamic state, so pipelines with extended dynamic state are monolithic as well.
+bool UseGraphicsPipelineLibraries(const RenderDeviceVkImpl* pDeviceVk, const PipelineStateDesc& PSODesc, bool ExtendedDynamicState)
+{
+    return pDeviceVk->IsGraphicsPipelineLibraryEnabled() && PSODesc.PipelineType != PIPELINE_TYPE_MESH && !ExtendedDynamicState;
+}
+
 void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDeviceVk,
+                            const PipelineStateVkImpl::TShaderStages&     ShaderStages,
                             std::vector<VkPipelineShaderStageCreateInfo>& Stages,
                             const PipelineLayoutVk&                       Layout,
                             const PipelineStateDesc&                      PSODesc,
                             const GraphicsPipelineDesc&                   GraphicsPipeline,
                             VulkanUtilities::PipelineWrapper&             Pipeline,
+                            GraphicsPipelineLibrariesArray&               Libraries,
+                            VkPipelineCreateFlags&                        Flags,
                             RefCntAutoPtr<IRenderPass>&                   pRenderPass,
-                            VkPipelineCache                               vkPSOCache)
+                            VkPipelineCache                               vkPSOCache,
+                            bool                                          ExtendedDynamicState,
+                            VkPipelineCreateFlags                         ExtraFlags)
 {
     const auto& LogicalDevice  = pDeviceVk->GetLogicalDevice();
     const auto& PhysicalDevice = pDeviceVk->GetPhysicalDevice();
     auto&       RPCache        = pDeviceVk->GetImplicitRenderPassCache();
 
-    if (pRenderPass == nullptr)
+    // Pipelines that use texture-based shading rate require a render pass with the shading rate attachment.
+    // Note that the device context makes the same choice when it binds render targets.
+    const bool UseDynamicRendering =
+        pRenderPass == nullptr &&
+        pDeviceVk->IsDynamicRenderingEnabled() &&
+        (GraphicsPipeline.ShadingRateFlags & PIPELINE_SHADING_RATE_FLAG_TEXTURE_BASED) == 0;
+
+    if (pRenderPass == nullptr && !UseDynamicRendering)
     {
         RenderPassCache::RenderPassCacheKey Key{
             GraphicsPipeline.NumRenderTargets,
@@ -159,6 +329,8 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
 #ifdef DILIGENT_DEBUG
     PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
 #endif
+    if (pDeviceVk->IsDescriptorBufferEnabled())
+        PipelineCI.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
 
     PipelineCI.stageCount = static_cast<Uint32>(Stages.size());
     PipelineCI.pStages    = Stages.data();
@@ -270,8 +442,9 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
         DepthStencilStateDesc_To_VkDepthStencilStateCI(GraphicsPipeline.DepthStencilDesc);
     PipelineCI.pDepthStencilState = &DepthStencilStateCI;
 
-    const auto& RPDesc           = pRenderPass->GetDesc();
-    const auto  NumRTAttachments = RPDesc.pSubpasses[GraphicsPipeline.SubpassIndex].RenderTargetAttachmentCount;
+    const Uint32 NumRTAttachments = UseDynamicRendering ?
+        GraphicsPipeline.NumRenderTargets :
+        pRenderPass->GetDesc().pSubpasses[GraphicsPipeline.SubpassIndex].RenderTargetAttachmentCount;
     VERIFY_EXPR(GraphicsPipeline.pRenderPass != nullptr || GraphicsPipeline.NumRenderTargets == NumRTAttachments);
     std::vector<VkPipelineColorBlendAttachmentState> ColorBlendAttachmentStates(NumRTAttachments);
 
@@ -319,17 +492,97 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
         DynamicStates.push_back(VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR);
     }
 
+    if (ExtendedDynamicState)
+    {
+        // Cull mode, front face and depth-stencil states in the pipeline create info are ignored
+        // and are set by the device context with vkCmdSet*EXT commands (VK_EXT_extended_dynamic_state).
+        DynamicStates.insert(DynamicStates.end(),
+                             {
+                                 VK_DYNAMIC_STATE_CULL_MODE_EXT,
+                                 VK_DYNAMIC_STATE_FRONT_FACE_EXT,
+                                 VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT,
+                                 VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT,
+                                 VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT,
+                                 VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT,
+                                 VK_DYNAMIC_STATE_STENCIL_OP_EXT,
+                                 VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK,
+                                 VK_DYNAMIC_STATE_STENCIL_WRITE_MASK,
+                             });
+
+        // Mesh pipelines have no input assembly state
+        if (PSODesc.PipelineType == PIPELINE_TYPE_GRAPHICS)
+            DynamicStates.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+    }
+
     DynamicStateCI.dynamicStateCount = static_cast<uint32_t>(DynamicStates.size());
     DynamicStateCI.pDynamicStates    = DynamicStates.data();
     PipelineCI.pDynamicState         = &DynamicStateCI;
 
 
-    PipelineCI.renderPass         = pRenderPass.RawPtr<IRenderPassVk>()->GetVkRenderPass();
-    PipelineCI.subpass            = GraphicsPipeline.SubpassIndex;
+    std::array<VkFormat, MAX_RENDER_TARGETS> ColorAttachmentFormats;
+    VkPipelineRenderingCreateInfoKHR         RenderingCI{};
+    if (UseDynamicRendering)
+    {
+        RenderingCI.sType                = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        RenderingCI.pNext                = nullptr;
+        RenderingCI.viewMask             = 0;
+        RenderingCI.colorAttachmentCount = GraphicsPipeline.NumRenderTargets;
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+        {
+            // Unused attachments must use VK_FORMAT_UNDEFINED
+            ColorAttachmentFormats[rt] = GraphicsPipeline.RTVFormats[rt] != TEX_FORMAT_UNKNOWN ?
+                TexFormatToVkFormat(GraphicsPipeline.RTVFormats[rt]) :
+                VK_FORMAT_UNDEFINED;
+        }
+        RenderingCI.pColorAttachmentFormats = ColorAttachmentFormats.data();
+        RenderingCI.depthAttachmentFormat   = VK_FORMAT_UNDEFINED;
+        RenderingCI.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+        if (GraphicsPipeline.DSVFormat != TEX_FORMAT_UNKNOWN)
+        {
+            const auto     FmtComponentType = GetTextureFormatAttribs(GraphicsPipeline.DSVFormat).ComponentType;
+            const VkFormat vkDSVFormat      = TexFormatToVkFormat(GraphicsPipeline.DSVFormat);
+            if (FmtComponentType == COMPONENT_TYPE_DEPTH || FmtComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+                RenderingCI.depthAttachmentFormat = vkDSVFormat;
+            if (FmtComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+                RenderingCI.stencilAttachmentFormat = vkDSVFormat;
+        }
+
+        PipelineCI.pNext      = &RenderingCI;
+        PipelineCI.renderPass = VK_NULL_HANDLE;
+        PipelineCI.subpass    = 0;
+    }
+    else
+    {
+        PipelineCI.renderPass = pRenderPass.RawPtr<IRenderPassVk>()->GetVkRenderPass();
+        PipelineCI.subpass    = GraphicsPipeline.SubpassIndex;
+    }
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-    Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    Flags = PipelineCI.flags;
+    Libraries.fill(VK_NULL_HANDLE);
+
+    if (UseGraphicsPipelineLibraries(pDeviceVk, PSODesc, ExtendedDynamicState))
+    {
+        VERIFY(ExtraFlags == 0, "Extra flags are not supported for pipeline libraries");
+
+        const auto Hashes = ComputeGraphicsPipelineLibraryHashes(ShaderStages, Stages, Layout, GraphicsPipeline, pRenderPass);
+
+        // Only the libraries that are not found in the cache are compiled
+        auto& LibraryCache = pDeviceVk->GetGraphicsPipelineLibraryCache();
+        for (Uint32 i = 0; i < GraphicsPipelineLibraryCache::LIBRARY_TYPE_COUNT; ++i)
+        {
+            const auto Type = static_cast<GraphicsPipelineLibraryCache::LIBRARY_TYPE>(i);
+            Libraries[i]    = LibraryCache.GetLibrary(Type, Hashes[i], PipelineCI, vkPSOCache, PSODesc.Name);
+        }
+
+        Pipeline = LinkGraphicsPipelineLibraries(LogicalDevice, Libraries, Flags, PipelineCI.layout, /*Optimize = */ false, vkPSOCache, PSODesc.Name);
+    }
+    else
+    {
+        PipelineCI.flags |= ExtraFlags;
+        Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    }
 }
 
 
@@ -350,6 +603,8 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
 #ifdef DILIGENT_DEBUG
     PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
 #endif
+    if (pDeviceVk->IsDescriptorBufferEnabled())
+        PipelineCI.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
 
     PipelineCI.stageCount                   = static_cast<Uint32>(vkStages.size());
     PipelineCI.pStages                      = vkStages.data();
@@ -381,7 +636,7 @@ std::vector<VkRayTracingShaderGroupCreateInfoKHR> BuildRTShaderGroupDescription(
         VERIFY(pShaderVk, "Unexpected shader object implementation");
 
         const auto ShaderType = pShaderVk->GetDesc().ShaderType;
-        // Shader modules are initialized in the same order by InitPipelineShaderStages().
+        // Shader stages are initialized in the same order by InitPipelineShaderStages().
         uint32_t idx = 0;
         for (const auto& Stage : ShaderStages)
         {
@@ -633,121 +888,148 @@ void PipelineStateVkImpl::RemapOrVerifyShaderResources(
     bool                                                 bStripReflection,
     const char*                                          PipelineName,
     TShaderResources*                                    pDvpShaderResources,
-    TResourceAttibutions*                                pDvpResourceAttibutions) noexcept(false)
+    TResourceAttibutions*                                pDvpResourceAttibutions,
+    IThreadPool*                                         pThreadPool) noexcept(false)
 {
     if (PipelineName == nullptr)
         PipelineName = "<null>";
 
-    // Verify that pipeline layout is compatible with shader resources and
-    // remap resource bindings.
+    // Flatten the shaders so that each one can be processed independently
+    std::vector<std::pair<size_t, size_t>> ShaderIndices;
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
+        VERIFY_EXPR(ShaderStages[s].Shaders.size() == ShaderStages[s].SPIRVs.size());
+        for (size_t i = 0; i < ShaderStages[s].Shaders.size(); ++i)
+            ShaderIndices.emplace_back(s, i);
+    }
+
+    // Resource attributions are collected per shader and merged in the original order
+    std::vector<TResourceAttibutions> ShaderResAttibutions(pDvpResourceAttibutions != nullptr ? ShaderIndices.size() : 0);
+
+    // Verify that pipeline layout is compatible with shader resources and
+    // remap resource bindings.
+    const auto ProcessShader = [&](size_t Idx) {
+        const size_t s = ShaderIndices[Idx].first;
+        const size_t i = ShaderIndices[Idx].second;
+
         const auto& Shaders    = ShaderStages[s].Shaders;
         auto&       SPIRVs     = ShaderStages[s].SPIRVs;
         const auto  ShaderType = ShaderStages[s].Type;
 
-        VERIFY_EXPR(Shaders.size() == SPIRVs.size());
+        auto* pShader = Shaders[i];
+        auto& SPIRV   = SPIRVs[i];
 
-        for (size_t i = 0; i < Shaders.size(); ++i)
-        {
-            auto* pShader = Shaders[i];
-            auto& SPIRV   = SPIRVs[i];
-
-            const auto& pShaderResources = pShader->GetShaderResources();
-            VERIFY_EXPR(pShaderResources);
-
-            if (pDvpShaderResources)
-                pDvpShaderResources->emplace_back(pShaderResources);
+        const auto& pShaderResources = pShader->GetShaderResources();
+        VERIFY_EXPR(pShaderResources);
 
-            pShaderResources->ProcessResources(
-                [&](const SPIRVShaderResourceAttribs& SPIRVAttribs, Uint32) //
+        pShaderResources->ProcessResources(
+            [&](const SPIRVShaderResourceAttribs& SPIRVAttribs, Uint32) //
+            {
+                const auto ResAttribution = GetResourceAttribution(SPIRVAttribs.Name, ShaderType, pSignatures, SignatureCount);
+                if (!ResAttribution)
                 {
-                    const auto ResAttribution = GetResourceAttribution(SPIRVAttribs.Name, ShaderType, pSignatures, SignatureCount);
-                    if (!ResAttribution)
-                    {
-                        LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' contains resource '", SPIRVAttribs.Name,
-                                            "' that is not present in any pipeline resource signature used to create pipeline state '",
-                                            PipelineName, "'.");
-                    }
+                    LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' contains resource '", SPIRVAttribs.Name,
+                                        "' that is not present in any pipeline resource signature used to create pipeline state '",
+                                        PipelineName, "'.");
+                }
 
-                    const auto& SignDesc = ResAttribution.pSignature->GetDesc();
-                    const auto  ResType  = SPIRVShaderResourceAttribs::GetShaderResourceType(SPIRVAttribs.Type);
-                    const auto  Flags    = SPIRVShaderResourceAttribs::GetPipelineResourceFlags(SPIRVAttribs.Type);
+                const auto& SignDesc = ResAttribution.pSignature->GetDesc();
+                const auto  ResType  = SPIRVShaderResourceAttribs::GetShaderResourceType(SPIRVAttribs.Type);
+                const auto  Flags    = SPIRVShaderResourceAttribs::GetPipelineResourceFlags(SPIRVAttribs.Type);
 
-                    Uint32 ResourceBinding = ~0u;
-                    Uint32 DescriptorSet   = ~0u;
-                    if (ResAttribution.ResourceIndex != ResourceAttribution::InvalidResourceIndex)
-                    {
-                        const auto& ResDesc = ResAttribution.pSignature->GetResourceDesc(ResAttribution.ResourceIndex);
-                        ValidatePipelineResourceCompatibility(ResDesc, ResType, Flags, SPIRVAttribs.ArraySize,
-                                                              pShader->GetDesc().Name, SignDesc.Name);
+                Uint32 ResourceBinding = ~0u;
+                Uint32 DescriptorSet   = ~0u;
+                if (ResAttribution.ResourceIndex != ResourceAttribution::InvalidResourceIndex)
+                {
+                    const auto& ResDesc = ResAttribution.pSignature->GetResourceDesc(ResAttribution.ResourceIndex);
+                    ValidatePipelineResourceCompatibility(ResDesc, ResType, Flags, SPIRVAttribs.ArraySize,
+                                                          pShader->GetDesc().Name, SignDesc.Name);
 
-                        const auto& ResAttribs{ResAttribution.pSignature->GetResourceAttribs(ResAttribution.ResourceIndex)};
-                        ResourceBinding = ResAttribs.BindingIndex;
-                        DescriptorSet   = ResAttribs.DescrSet;
-                    }
-                    else if (ResAttribution.ImmutableSamplerIndex != ResourceAttribution::InvalidResourceIndex)
-                    {
-                        if (ResType != SHADER_RESOURCE_TYPE_SAMPLER)
-                        {
-                            LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' contains resource with name '", SPIRVAttribs.Name,
-                                                "' and type '", GetShaderResourceTypeLiteralName(ResType),
-                                                "' that is not compatible with immutable sampler defined in pipeline resource signature '",
-                                                SignDesc.Name, "'.");
-                        }
-                        const auto& SamAttribs{ResAttribution.pSignature->GetImmutableSamplerAttribs(ResAttribution.ImmutableSamplerIndex)};
-                        ResourceBinding = SamAttribs.BindingIndex;
-                        DescriptorSet   = SamAttribs.DescrSet;
-                    }
-                    else
+                    const auto& ResAttribs{ResAttribution.pSignature->GetResourceAttribs(ResAttribution.ResourceIndex)};
+                    ResourceBinding = ResAttribs.BindingIndex;
+                    DescriptorSet   = ResAttribs.DescrSet;
+                }
+                else if (ResAttribution.ImmutableSamplerIndex != ResourceAttribution::InvalidResourceIndex)
+                {
+                    if (ResType != SHADER_RESOURCE_TYPE_SAMPLER)
                     {
-                        UNEXPECTED("Either immutable sampler or resource index should be valid");
+                        LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' contains resource with name '", SPIRVAttribs.Name,
+                                            "' and type '", GetShaderResourceTypeLiteralName(ResType),
+                                            "' that is not compatible with immutable sampler defined in pipeline resource signature '",
+                                            SignDesc.Name, "'.");
                     }
+                    const auto& SamAttribs{ResAttribution.pSignature->GetImmutableSamplerAttribs(ResAttribution.ImmutableSamplerIndex)};
+                    ResourceBinding = SamAttribs.BindingIndex;
+                    DescriptorSet   = SamAttribs.DescrSet;
+                }
+                else
+                {
+                    UNEXPECTED("Either immutable sampler or resource index should be valid");
+                }
 
-                    VERIFY_EXPR(ResourceBinding != ~0u && DescriptorSet != ~0u);
-                    DescriptorSet += BindIndexToDescSetIndex[SignDesc.BindingIndex];
-                    if (bVerifyOnly)
+                VERIFY_EXPR(ResourceBinding != ~0u && DescriptorSet != ~0u);
+                DescriptorSet += BindIndexToDescSetIndex[SignDesc.BindingIndex];
+                if (bVerifyOnly)
+                {
+                    const auto SpvBinding  = SPIRV[SPIRVAttribs.BindingDecorationOffset];
+                    const auto SpvDescrSet = SPIRV[SPIRVAttribs.DescriptorSetDecorationOffset];
+                    if (SpvBinding != ResourceBinding)
                     {
-                        const auto SpvBinding  = SPIRV[SPIRVAttribs.BindingDecorationOffset];
-                        const auto SpvDescrSet = SPIRV[SPIRVAttribs.DescriptorSetDecorationOffset];
-                        if (SpvBinding != ResourceBinding)
-                        {
-                            LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' maps resource '", SPIRVAttribs.Name,
-                                                "' to binding ", SpvBinding, ", but the same resource in pipeline resource signature '",
-                                                SignDesc.Name, "' is mapped to binding ", ResourceBinding, '.');
-                        }
-                        if (SpvDescrSet != DescriptorSet)
-                        {
-                            LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' maps resource '", SPIRVAttribs.Name,
-                                                "' to descriptor set ", SpvDescrSet, ", but the same resource in pipeline resource signature '",
-                                                SignDesc.Name, "' is mapped to set ", DescriptorSet, '.');
-                        }
+                        LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' maps resource '", SPIRVAttribs.Name,
+                                            "' to binding ", SpvBinding, ", but the same resource in pipeline resource signature '",
+                                            SignDesc.Name, "' is mapped to binding ", ResourceBinding, '.');
                     }
-                    else
+                    if (SpvDescrSet != DescriptorSet)
                     {
-                        SPIRV[SPIRVAttribs.BindingDecorationOffset]       = ResourceBinding;
-                        SPIRV[SPIRVAttribs.DescriptorSetDecorationOffset] = DescriptorSet;
+                        LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' maps resource '", SPIRVAttribs.Name,
+                                            "' to descriptor set ", SpvDescrSet, ", but the same resource in pipeline resource signature '",
+                                            SignDesc.Name, "' is mapped to set ", DescriptorSet, '.');
                     }
+                }
+                else
+                {
+                    SPIRV[SPIRVAttribs.BindingDecorationOffset]       = ResourceBinding;
+                    SPIRV[SPIRVAttribs.DescriptorSetDecorationOffset] = DescriptorSet;
+                }
 
-                    if (pDvpResourceAttibutions)
-                        pDvpResourceAttibutions->emplace_back(ResAttribution);
-                });
+                if (pDvpResourceAttibutions)
+                    ShaderResAttibutions[Idx].emplace_back(ResAttribution);
+            });
 
-            if (bStripReflection)
-            {
+        if (bStripReflection)
+        {
 #if !DILIGENT_NO_HLSL
-                // We have to strip reflection instructions to fix the following validation error:
-                //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
-                // Optimizer also performs validation and may catch problems with the byte code.
-                // NB: SPIRV offsets become INVALID after this operation.
-                auto StrippedSPIRV = OptimizeSPIRV(SPIRV, SPV_ENV_MAX, SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION);
-                if (!StrippedSPIRV.empty())
-                    SPIRV = std::move(StrippedSPIRV);
-                else
-                    LOG_ERROR("Failed to strip reflection information from shader '", pShader->GetDesc().Name, "'. This may indicate a problem with the byte code.");
+            // We have to strip reflection instructions to fix the following validation error:
+            //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
+            // Optimizer also performs validation and may catch problems with the byte code.
+            // NB: SPIRV offsets become INVALID after this operation.
+            auto StrippedSPIRV = OptimizeSPIRV(SPIRV, SPV_ENV_MAX, SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION);
+            if (!StrippedSPIRV.empty())
+                SPIRV = std::move(StrippedSPIRV);
+            else
+                LOG_ERROR("Failed to strip reflection information from shader '", pShader->GetDesc().Name, "'. This may indicate a problem with the byte code.");
 #endif
-            }
         }
+    };
+
+    if (pThreadPool != nullptr && ShaderIndices.size() > 1)
+    {
+        // Stripping reflection runs the SPIR-V optimizer, which is the most expensive part
+        // of the pipeline front-end work, so process shaders in parallel when possible.
+        ProcessItemsInParallel(pThreadPool, ShaderIndices.size(), ProcessShader);
+    }
+    else
+    {
+        for (size_t Idx = 0; Idx < ShaderIndices.size(); ++Idx)
+            ProcessShader(Idx);
+    }
+
+    for (size_t Idx = 0; Idx < ShaderIndices.size(); ++Idx)
+    {
+        if (pDvpShaderResources)
+            pDvpShaderResources->emplace_back(ShaderStages[ShaderIndices[Idx].first].Shaders[ShaderIndices[Idx].second]->GetShaderResources());
+        if (pDvpResourceAttibutions)
+            pDvpResourceAttibutions->insert(pDvpResourceAttibutions->end(), ShaderResAttibutions[Idx].begin(), ShaderResAttibutions[Idx].end());
     }
 }
 
@@ -785,19 +1067,19 @@ void PipelineStateVkImpl::InitPipelineLayout(const PipelineStateCreateInfo& Crea
                                      true,           // bStripReflection
                                      m_Desc.Name,
 #ifdef DILIGENT_DEVELOPMENT
-                                     &m_ShaderResources, &m_ResourceAttibutions
+                                     &m_ShaderResources, &m_ResourceAttibutions,
 #else
-                                     nullptr, nullptr
+                                     nullptr, nullptr,
 #endif
-        );
+                                     // Only split the work when the pipeline is created asynchronously
+                                     (CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 ? m_pDevice->GetShaderCompilationThreadPool() : nullptr);
     }
 }
 
 template <typename PSOCreateInfoType>
 PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
-    const PSOCreateInfoType&                           CreateInfo,
-    std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-    std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules) noexcept(false)
+    const PSOCreateInfoType&                      CreateInfo,
+    std::vector<VkPipelineShaderStageCreateInfo>& vkShaderStages) noexcept(false)
 {
     TShaderStages ShaderStages;
     ExtractShaders<ShaderVkImpl>(CreateInfo, ShaderStages, /*WaitUntilShadersReady = */ true);
@@ -808,27 +1090,88 @@ PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
 
     MemPool.Reserve();
 
-    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
-
     InitializePipelineDesc(CreateInfo, MemPool);
 
     InitPipelineLayout(CreateInfo, ShaderStages);
 
-    // Create shader modules and initialize shader stages
-    InitPipelineShaderStages(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages);
+    // Initialize shader stages. Shader modules are created later, unless the pipeline
+    // can be created from the shader module identifiers.
+    InitPipelineShaderStages(ShaderStages, vkShaderStages);
 
     return ShaderStages;
 }
 
+// Returns the pipeline cache from the create info or, if there is none, a cache
+// acquired from the engine-managed persistent pipeline cache.
+static PersistentPipelineCache::ScopedCache AcquirePipelineCache(RenderDeviceVkImpl* pDevice, IPipelineStateCache* pPSOCache)
+{
+    if (pPSOCache != nullptr)
+        return PersistentPipelineCache::ScopedCache{nullptr, ClassPtrCast<PipelineStateCacheVkImpl>(pPSOCache)->GetVkPipelineCache()};
+
+    return pDevice->GetPersistentPipelineCache().Acquire();
+}
+
+// Returns the persistent pipeline cache if it stores shader module identifiers and the pipeline
+// uses it, or null otherwise. Identifiers are only useful together with the cache that contains
+// the pipelines created from them.
+static PersistentPipelineCache* GetShaderModuleIdentifierCache(RenderDeviceVkImpl* pDevice, IPipelineStateCache* pPSOCache)
+{
+    auto& PersistentCache = pDevice->GetPersistentPipelineCache();
+    return pPSOCache == nullptr && PersistentCache.AreShaderModuleIdentifiersEnabled() ? &PersistentCache : nullptr;
+}
+
 void PipelineStateVkImpl::InitializePipeline(const GraphicsPipelineStateCreateInfo& CreateInfo)
 {
     std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
     std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
 
-    InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+    const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages);
+
+    const auto vkSPOCache = AcquirePipelineCache(m_pDevice, CreateInfo.pPSOCache);
+
+    GraphicsPipelineLibrariesArray Libraries{};
+    VkPipelineCreateFlags          Flags = 0;
 
-    const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-    CreateGraphicsPipeline(m_pDevice, vkShaderStages, m_PipelineLayout, m_Desc, m_pGraphicsPipelineData->Desc, m_Pipeline, GetRenderPassPtr(), vkSPOCache);
+    // Pipeline libraries are cached by the engine and always require the shader modules
+    auto* pModuleIdCache = !UseGraphicsPipelineLibraries(m_pDevice, m_Desc, HasExtendedDynamicState()) ?
+        GetShaderModuleIdentifierCache(m_pDevice, CreateInfo.pPSOCache) :
+        nullptr;
+
+    std::vector<ShaderModuleIdentifierStageInfo> IdStages;
+    if (pModuleIdCache != nullptr && UseShaderModuleIdentifiers(*pModuleIdCache, ShaderStages, vkShaderStages, IdStages))
+    {
+        CreateGraphicsPipeline(m_pDevice, ShaderStages, vkShaderStages, m_PipelineLayout, m_Desc, m_pGraphicsPipelineData->Desc, m_Pipeline, Libraries, Flags, GetRenderPassPtr(), vkSPOCache, HasExtendedDynamicState(),
+                               VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT);
+    }
+
+    if (m_Pipeline == VK_NULL_HANDLE)
+    {
+        CreateShaderModules(m_pDevice->GetLogicalDevice(), ShaderStages, ShaderModules, vkShaderStages, pModuleIdCache);
+        CreateGraphicsPipeline(m_pDevice, ShaderStages, vkShaderStages, m_PipelineLayout, m_Desc, m_pGraphicsPipelineData->Desc, m_Pipeline, Libraries, Flags, GetRenderPassPtr(), vkSPOCache, HasExtendedDynamicState(), 0);
+    }
+
+    IThreadPool* pThreadPool = m_pDevice->GetShaderCompilationThreadPool();
+    if (Libraries[0] != VK_NULL_HANDLE && pThreadPool != nullptr)
+    {
+        // Link the optimized pipeline in the background. The fast-linked pipeline is used until it is ready.
+        RefCntAutoPtr<IPipelineStateCache> pPSOCache{CreateInfo.pPSOCache};
+        m_pOptimizedPipelineTask = EnqueueAsyncWork(
+            pThreadPool,
+            [this, Libraries, Flags, pPSOCache = std::move(pPSOCache)](Uint32 ThreadId) {
+                const auto vkPSOCache = AcquirePipelineCache(m_pDevice, pPSOCache);
+                try
+                {
+                    m_OptimizedPipeline = LinkGraphicsPipelineLibraries(m_pDevice->GetLogicalDevice(), Libraries, Flags, m_PipelineLayout.GetVkPipelineLayout(),
+                                                                        /*Optimize = */ true, vkPSOCache, m_Desc.Name);
+                    m_vkOptimizedPipeline.store(m_OptimizedPipeline);
+                }
+                catch (...)
+                {
+                    LOG_WARNING_MESSAGE("Failed to link optimized pipeline '", m_Desc.Name, "'. The fast-linked pipeline will be used.");
+                }
+                return ASYNC_TASK_STATUS_COMPLETE;
+            });
+    }
 }
 
 void PipelineStateVkImpl::InitializePipeline(const ComputePipelineStateCreateInfo& CreateInfo)
@@ -836,10 +1179,20 @@ void PipelineStateVkImpl::InitializePipeline(const ComputePipelineStateCreateInf
     std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
     std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
 
-    InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+    const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages);
 
-    const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-    CreateComputePipeline(m_pDevice, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache);
+    const auto vkSPOCache     = AcquirePipelineCache(m_pDevice, CreateInfo.pPSOCache);
+    auto*      pModuleIdCache = GetShaderModuleIdentifierCache(m_pDevice, CreateInfo.pPSOCache);
+
+    std::vector<ShaderModuleIdentifierStageInfo> IdStages;
+    if (pModuleIdCache != nullptr && UseShaderModuleIdentifiers(*pModuleIdCache, ShaderStages, vkShaderStages, IdStages))
+        CreateComputePipeline(m_pDevice, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache, VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT);
+
+    if (m_Pipeline == VK_NULL_HANDLE)
+    {
+        CreateShaderModules(m_pDevice->GetLogicalDevice(), ShaderStages, ShaderModules, vkShaderStages, pModuleIdCache);
+        CreateComputePipeline(m_pDevice, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache, 0);
+    }
 }
 
 void PipelineStateVkImpl::InitializePipeline(const RayTracingPipelineStateCreateInfo& CreateInfo)
@@ -849,9 +1202,11 @@ void PipelineStateVkImpl::InitializePipeline(const RayTracingPipelineStateCreate
     std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
     std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
 
-    const auto ShaderStages   = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
+    const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages);
+    CreateShaderModules(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages, nullptr);
+
     const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
-    const auto vkSPOCache     = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
+    const auto vkSPOCache     = AcquirePipelineCache(m_pDevice, CreateInfo.pPSOCache);
 
     CreateRayTracingPipeline(m_pDevice, vkShaderStages, vkShaderGroups, m_PipelineLayout, m_Desc, m_pRayTracingPipelineData->Desc, m_Pipeline, vkSPOCache);
 
@@ -898,8 +1253,24 @@ PipelineStateVkImpl::~PipelineStateVkImpl()
 
 void PipelineStateVkImpl::Destruct()
 {
+    if (m_pOptimizedPipelineTask)
+    {
+        // The task references the pipeline object
+        IThreadPool* pThreadPool = m_pDevice->GetShaderCompilationThreadPool();
+        VERIFY_EXPR(pThreadPool != nullptr);
+        if (!pThreadPool->RemoveTask(m_pOptimizedPipelineTask))
+        {
+            m_pOptimizedPipelineTask->Cancel();
+            m_pOptimizedPipelineTask->WaitForCompletion();
+        }
+        m_pOptimizedPipelineTask.Release();
+    }
+
+    m_vkOptimizedPipeline.store(VK_NULL_HANDLE);
+    if (m_OptimizedPipeline)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_OptimizedPipeline), m_Desc.ImmediateContextMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_Pipeline), m_Desc.ImmediateContextMask);
-    m_PipelineLayout.Release(m_pDevice, m_Desc.ImmediateContextMask);
+    m_PipelineLayout.Release();
 
     TPipelineStateBase::Destruct();
 }
@@ -55,6 +55,37 @@
 namespace Diligent
 {
 
+namespace
+{
+
+VulkanUtilities::VulkanMemoryAllocationPolicy GetMemoryAllocationPolicy(const EngineVkCreateInfo& EngineCI)
+{
+    VulkanUtilities::VulkanMemoryAllocationPolicy Policy;
+    Policy.DedicatedAllocationThreshold = EngineCI.DedicatedAllocationThreshold;
+    Policy.SmallAllocationMaxSize       = EngineCI.SmallAllocationMaxSize;
+    Policy.SmallAllocationPageSize      = EngineCI.SmallAllocationPageSize;
+
+    if (EngineCI.MemoryTypePageSizeCount > 0)
+    {
+        if (EngineCI.pMemoryTypePageSizes == nullptr)
+            LOG_ERROR_AND_THROW("MemoryTypePageSizeCount is ", EngineCI.MemoryTypePageSizeCount, ", but pMemoryTypePageSizes is null");
+
+        if (EngineCI.MemoryTypePageSizeCount > Policy.MemoryTypePageSize.size())
+        {
+            LOG_WARNING_MESSAGE("MemoryTypePageSizeCount (", EngineCI.MemoryTypePageSizeCount, ") exceeds the maximum number of Vulkan memory types (",
+                                Policy.MemoryTypePageSize.size(), "). Extra page sizes will be ignored.");
+        }
+
+        const size_t Count = std::min(size_t{EngineCI.MemoryTypePageSizeCount}, Policy.MemoryTypePageSize.size());
+        for (size_t i = 0; i < Count; ++i)
+            Policy.MemoryTypePageSize[i] = EngineCI.pMemoryTypePageSizes[i];
+    }
+
+    return Policy;
+}
+
+} // namespace
+
 RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*                                    pRefCounters,
                                        IMemoryAllocator&                                      RawMemAllocator,
                                        IEngineFactory*                                        pEngineFactory,
@@ -76,11 +107,14 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI,
         AdapterInfo
     },
-    m_VulkanInstance         {Instance                 },
-    m_PhysicalDevice         {std::move(PhysicalDevice)},
-    m_LogicalVkDevice        {std::move(LogicalDevice) },
-    m_FramebufferCache       {*this                    },
-    m_ImplicitRenderPassCache{*this                    },
+    m_VulkanInstance              {Instance                 },
+    m_PhysicalDevice              {std::move(PhysicalDevice)},
+    m_LogicalVkDevice             {std::move(LogicalDevice) },
+    m_FramebufferCache            {*this                    },
+    m_ImplicitRenderPassCache     {*this                    },
+    m_GraphicsPipelineLibraryCache{*this                    },
+    m_PersistentPipelineCache     {*this, EngineCI.PipelineCacheFilePath, EngineCI.PipelineCacheSaveInterval},
+    m_PipelineLayoutCache         {*this                    },
     m_DescriptorSetAllocator
     {
         *this,
@@ -134,7 +168,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DeviceLocalMemoryPageSize,
         EngineCI.HostVisibleMemoryPageSize,
         EngineCI.DeviceLocalMemoryReserveSize,
-        EngineCI.HostVisibleMemoryReserveSize
+        EngineCI.HostVisibleMemoryReserveSize,
+        GetMemoryAllocationPolicy(EngineCI)
     },
     m_DynamicMemoryManager
     {
@@ -143,6 +178,12 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DynamicHeapSize,
         ~Uint64{0}
     },
+    m_UploadPagePool
+    {
+        *this,
+        EngineCI.UploadPagePoolSize,
+        EngineCI.PersistentUploadPageSize
+    },
     m_pDxCompiler{CreateDXCompiler(DXCompilerTarget::Vulkan, m_PhysicalDevice->GetVkVersion(), EngineCI.pDxCompilerPath)}
 // clang-format on
 {
@@ -211,6 +252,15 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
 
     ReleaseStaleResources(true);
 
+    // All upload pages have been returned to the pool by the release queues
+    m_UploadPagePool.Destroy();
+
+    // All pipelines linked from the libraries have been destroyed now
+    m_GraphicsPipelineLibraryCache.Destroy();
+
+    // Merge the pooled caches and save the data to the file
+    m_PersistentPipelineCache.Destroy();
+
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
     DEV_CHECK_ERR(m_DynamicDescriptorPool.GetAllocatedPoolCounter() == 0, "All allocated dynamic descriptor pools must have been released now.");
     DEV_CHECK_ERR(m_DynamicMemoryManager.GetMasterBlockCounter() == 0, "All allocated dynamic master blocks must have been returned to the pool.");
@@ -272,7 +322,8 @@ void RenderDeviceVkImpl::AllocateTransientCmdPool(SoftwareQueueIndex
 
     CmdBuffer.SetVkCmdBuffer(vkCmdBuff,
                              m_LogicalVkDevice->GetSupportedStagesMask(QueueFamilyIndex),
-                             m_LogicalVkDevice->GetSupportedAccessMask(QueueFamilyIndex));
+                             m_LogicalVkDevice->GetSupportedAccessMask(QueueFamilyIndex),
+                             IsSynchronization2Enabled());
 }
 
 
@@ -436,6 +487,92 @@ void RenderDeviceVkImpl::IdleGPU()
     ReleaseStaleResources();
 }
 
+Bool RenderDeviceVkImpl::WaitForFences(const WaitForFencesAttribs& Attribs)
+{
+    if (Attribs.NumFences == 0)
+        return True;
+    if (!VerifyWaitForFencesAttribs(Attribs))
+        return False;
+
+    std::vector<VkSemaphore> vkSemaphores(Attribs.NumFences);
+    for (Uint32 i = 0; i < Attribs.NumFences; ++i)
+    {
+        FenceVkImpl* pFenceVk = ClassPtrCast<FenceVkImpl>(Attribs.ppFences[i]);
+        if (!pFenceVk->IsTimelineSemaphore())
+        {
+            // Binary fences are waited for one by one
+            return TRenderDeviceBase::WaitForFences(Attribs);
+        }
+        vkSemaphores[i] = pFenceVk->GetVkSemaphore();
+    }
+
+    FlushBatchedSubmits();
+
+    // All fences are timeline semaphores, so a single call waits for all or any of them
+    VkSemaphoreWaitInfo WaitInfo{};
+    WaitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    WaitInfo.pNext          = nullptr;
+    WaitInfo.flags          = Attribs.WaitAll ? 0 : VK_SEMAPHORE_WAIT_ANY_BIT;
+    WaitInfo.semaphoreCount = Attribs.NumFences;
+    WaitInfo.pSemaphores    = vkSemaphores.data();
+    WaitInfo.pValues        = Attribs.pValues;
+
+    const VkResult err = m_LogicalVkDevice->WaitSemaphores(WaitInfo, Attribs.Timeout);
+    if (err == VK_TIMEOUT)
+        return False;
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to wait for timeline semaphores");
+    return True;
+}
+
+void RenderDeviceVkImpl::GetMemoryStats(DeviceMemoryStats& Stats)
+{
+    Stats = DeviceMemoryStats{};
+
+    const auto& MemProps = m_PhysicalDevice->GetMemoryProperties();
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT BudgetProps{};
+    const bool HasBudget = m_LogicalVkDevice->GetEnabledExtFeatures().MemoryBudget && m_PhysicalDevice->GetMemoryBudget(BudgetProps);
+
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> UsedSizes;
+    m_MemoryMgr.GetHeapUsedSizes(UsedSizes);
+
+    Stats.NumHeaps = std::min(MemProps.memoryHeapCount, Uint32{MAX_MEMORY_HEAPS});
+    for (Uint32 HeapIndex = 0; HeapIndex < Stats.NumHeaps; ++HeapIndex)
+    {
+        auto& Heap       = Stats.Heaps[HeapIndex];
+        Heap.DeviceLocal = (MemProps.memoryHeaps[HeapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        Heap.Reserved    = m_MemoryMgr.GetHeapAllocatedSize(HeapIndex);
+        Heap.Used        = UsedSizes[HeapIndex];
+        if (HasBudget)
+        {
+            Heap.Budget = BudgetProps.heapBudget[HeapIndex];
+            Heap.Usage  = BudgetProps.heapUsage[HeapIndex];
+        }
+        else
+        {
+            Heap.Budget = MemProps.memoryHeaps[HeapIndex].size;
+            Heap.Usage  = Heap.Reserved;
+        }
+    }
+
+    Stats.DynamicMemoryReserved = m_DynamicMemoryManager.GetSize();
+    Stats.DynamicMemoryUsed     = m_DynamicMemoryManager.GetUsedSize();
+
+    m_DescriptorSetAllocator.GetStats(Stats.ShaderVisibleResourceDescriptors);
+
+    GetReleaseQueueStats(Stats);
+}
+
+void RenderDeviceVkImpl::FlushBatchedSubmits()
+{
+    for (Uint32 q = 0; q < m_CmdQueueCount; ++q)
+    {
+        auto* pQueueVk = m_CommandQueues[q].CmdQueue.RawPtr<CommandQueueVkImpl>();
+        if (pQueueVk->IsSubmitBatchingEnabled())
+            pQueueVk->FlushBatchedSubmits();
+    }
+}
+
 void RenderDeviceVkImpl::FlushStaleResources(SoftwareQueueIndex CmdQueueIndex)
 {
     // Submit empty command buffer to the queue. This will effectively signal the fence and
@@ -692,6 +829,248 @@ void RenderDeviceVkImpl::CreateFenceFromVulkanResource(VkSemaphore      vkTimeli
     CreateFenceImpl(ppFence, Desc, vkTimelineSemaphore);
 }
 
+void RenderDeviceVkImpl::GetMemoryHeapBudget(Uint32              HeapIndex,
+                                             MemoryHeapBudgetVk& Budget)
+{
+    const auto& MemProps = m_PhysicalDevice->GetMemoryProperties();
+    if (HeapIndex >= MemProps.memoryHeapCount)
+    {
+        DEV_ERROR("Memory heap index (", HeapIndex, ") is out of range. The device has ", MemProps.memoryHeapCount, " memory heaps.");
+        Budget = {};
+        return;
+    }
+
+    const auto& Heap = MemProps.memoryHeaps[HeapIndex];
+
+    Budget.Size          = Heap.size;
+    Budget.IsDeviceLocal = (Heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    m_MemoryMgr.GetHeapBudget(HeapIndex, Budget.Budget, Budget.Usage);
+    Budget.EngineAllocatedSize = m_MemoryMgr.GetHeapAllocatedSize(HeapIndex);
+}
+
+void RenderDeviceVkImpl::SetMemoryBudgetCallback(MemoryBudgetCallbackType Callback,
+                                                 float                    Threshold,
+                                                 void*                    pUserData)
+{
+    if (Callback == nullptr)
+    {
+        m_MemoryMgr.SetBudgetCallback(nullptr, 1.f);
+        return;
+    }
+
+    DEV_CHECK_ERR(Threshold > 0 && Threshold <= 1, "Memory budget threshold (", Threshold, ") must be in (0, 1] range");
+    Threshold = std::min(std::max(Threshold, 0.f), 1.f);
+
+    m_MemoryMgr.SetBudgetCallback(
+        [this, Callback, pUserData](uint32_t HeapIndex) {
+            MemoryHeapBudgetVk Budget;
+            GetMemoryHeapBudget(HeapIndex, Budget);
+            Callback(HeapIndex, Budget, pUserData);
+        },
+        Threshold);
+}
+
+void RenderDeviceVkImpl::RegisterRelocatableResource(BufferVkImpl* pBuffer)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableBuffers.insert(pBuffer);
+}
+
+void RenderDeviceVkImpl::RegisterRelocatableResource(TextureVkImpl* pTexture)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableTextures.insert(pTexture);
+}
+
+void RenderDeviceVkImpl::UnregisterRelocatableResource(BufferVkImpl* pBuffer)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableBuffers.erase(pBuffer);
+}
+
+void RenderDeviceVkImpl::UnregisterRelocatableResource(TextureVkImpl* pTexture)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableTextures.erase(pTexture);
+}
+
+void RenderDeviceVkImpl::DefragmentMemory(const DefragmentMemoryAttribsVk& Attribs,
+                                          DefragmentMemoryStatsVk*         pStats)
+{
+    DEV_CHECK_ERR(Attribs.SparsePageThreshold > 0 && Attribs.SparsePageThreshold <= 1,
+                  "Sparse page threshold (", Attribs.SparsePageThreshold, ") must be in (0, 1] range");
+
+    DefragmentMemoryStatsVk Stats;
+
+    // No new allocations are made from the pages that are being evacuated, so the
+    // relocated resources are always moved to other pages.
+    const std::vector<VulkanUtilities::VulkanMemoryPage*> Pages = m_MemoryMgr.BeginDefragmentation(Attribs.SparsePageThreshold, Attribs.MaxBytesToMove);
+    Stats.NumSparsePages                                        = static_cast<Uint32>(Pages.size());
+
+    std::vector<RefCntAutoPtr<BufferVkImpl>>  Buffers;
+    std::vector<RefCntAutoPtr<TextureVkImpl>> Textures;
+    if (!Pages.empty())
+    {
+        const auto IsEvacuated = [&Pages](const VulkanUtilities::VulkanMemoryAllocation& Allocation) {
+            return std::find(Pages.begin(), Pages.end(), Allocation.Page) != Pages.end();
+        };
+
+        std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+        for (BufferVkImpl* pBuffer : m_RelocatableBuffers)
+        {
+            // The buffer may be in the middle of destruction, in which case the weak pointer can't be locked
+            if (auto pStrongBuffer = RefCntWeakPtr<BufferVkImpl>{pBuffer}.Lock())
+            {
+                if (IsEvacuated(pStrongBuffer->GetMemoryAllocation()))
+                    Buffers.emplace_back(std::move(pStrongBuffer));
+            }
+        }
+
+        if (Attribs.RelocateTextures)
+        {
+            for (TextureVkImpl* pTexture : m_RelocatableTextures)
+            {
+                if (auto pStrongTexture = RefCntWeakPtr<TextureVkImpl>{pTexture}.Lock())
+                {
+                    if (IsEvacuated(pStrongTexture->GetMemoryAllocation()))
+                        Textures.emplace_back(std::move(pStrongTexture));
+                }
+            }
+        }
+    }
+
+    std::unordered_map<const VulkanUtilities::VulkanMemoryPage*, VkDeviceSize> MovedSize;
+    std::vector<RefCntAutoPtr<IDeviceObject>>                                  RelocatedResources;
+
+    // Old objects of the relocated resources and the masks of the queues that used them
+    std::vector<std::pair<Uint64, BufferVkImpl::RelocationData>>  OldBuffers;
+    std::vector<std::pair<Uint64, TextureVkImpl::RelocationData>> OldTextures;
+
+    // Resources are only used by a single immediate context, so they are copied in the queue of that
+    // context, which avoids queue family ownership transfers and cross-queue synchronization.
+    for (Uint32 q = 0; q < GetCommandQueueCount() && (!Buffers.empty() || !Textures.empty()); ++q)
+    {
+        const Uint64 QueueMask = Uint64{1} << Uint64{q};
+
+        const auto HasQueueResources =
+            std::any_of(Buffers.begin(), Buffers.end(), [QueueMask](const auto& pBuffer) { return pBuffer->GetDesc().ImmediateContextMask == QueueMask; }) ||
+            std::any_of(Textures.begin(), Textures.end(), [QueueMask](const auto& pTexture) { return pTexture->GetDesc().ImmediateContextMask == QueueMask; });
+        if (!HasQueueResources)
+            continue;
+
+        const SoftwareQueueIndex CmdQueueInd{q};
+
+        VulkanUtilities::CommandPoolWrapper  CmdPool;
+        VulkanUtilities::VulkanCommandBuffer CmdBuffer;
+        AllocateTransientCmdPool(CmdQueueInd, CmdPool, CmdBuffer, "Transient command pool for memory defragmentation");
+
+        // Generic memory access flags are not used as they are not supported by the barrier
+        // recording in VulkanCommandBuffer, so all access types of the queue family are used instead.
+        const auto          QueueFamilyIndex = HardwareQueueIndex{GetCommandQueue(CmdQueueInd).GetQueueFamilyIndex()};
+        const VkAccessFlags AllAccessFlags   = m_LogicalVkDevice->GetSupportedAccessMask(QueueFamilyIndex);
+        CmdBuffer.MemoryBarrier(AllAccessFlags, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+        const auto CanMove = [&](const VulkanUtilities::VulkanMemoryAllocation& Allocation) {
+            return Stats.RelocatedBytes + Allocation.Size <= Attribs.MaxBytesToMove;
+        };
+        const auto OnRelocated = [&](const VulkanUtilities::VulkanMemoryAllocation& OldAllocation, IDeviceObject* pResource) {
+            MovedSize[OldAllocation.Page] += OldAllocation.Size;
+            Stats.RelocatedBytes += OldAllocation.Size;
+            RelocatedResources.emplace_back(pResource);
+        };
+
+        for (auto& pBuffer : Buffers)
+        {
+            if (pBuffer->GetDesc().ImmediateContextMask != QueueMask || !CanMove(pBuffer->GetMemoryAllocation()))
+                continue;
+
+            BufferVkImpl::RelocationData OldResources;
+            try
+            {
+                if (!pBuffer->Relocate(CmdBuffer, OldResources))
+                    continue;
+            }
+            catch (const std::runtime_error&)
+            {
+                LOG_ERROR_MESSAGE("Failed to relocate buffer '", pBuffer->GetDesc().Name, "'");
+                continue;
+            }
+
+            OnRelocated(OldResources.Memory, pBuffer);
+            OldBuffers.emplace_back(QueueMask, std::move(OldResources));
+            ++Stats.NumRelocatedBuffers;
+        }
+
+        for (auto& pTexture : Textures)
+        {
+            if (pTexture->GetDesc().ImmediateContextMask != QueueMask || !CanMove(pTexture->GetMemoryAllocation()))
+                continue;
+
+            TextureVkImpl::RelocationData OldResources;
+
+            bool Relocated = false;
+            try
+            {
+                Relocated = pTexture->Relocate(CmdBuffer, OldResources);
+            }
+            catch (const std::runtime_error&)
+            {
+                LOG_ERROR_MESSAGE("Failed to relocate texture '", pTexture->GetDesc().Name, "'");
+            }
+
+            if (Relocated)
+            {
+                OnRelocated(OldResources.Memory, pTexture);
+                ++Stats.NumRelocatedTextures;
+            }
+
+            // If view creation failed, the new image is returned as it is referenced by the copy commands
+            if (OldResources.Image != VK_NULL_HANDLE)
+                OldTextures.emplace_back(QueueMask, std::move(OldResources));
+        }
+
+        CmdBuffer.MemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, AllAccessFlags, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        CmdBuffer.FlushBarriers();
+        ExecuteAndDisposeTransientCmdBuff(CmdQueueInd, CmdBuffer.GetVkCmdBuffer(), std::move(CmdPool));
+    }
+
+    // Pages that still contain allocations of resources that could not be moved are made available again.
+    // A page whose resources have all been moved is released by ShrinkMemory() once the stale
+    // allocations are discarded. The pages with moved allocations are kept alive by the old allocations,
+    // other pages are not accessed as they may have been released by another thread.
+    std::vector<VulkanUtilities::VulkanMemoryPage*> PagesInUse;
+    for (auto* pPage : Pages)
+    {
+        auto moved_it = MovedSize.find(pPage);
+        if (moved_it == MovedSize.end() || moved_it->second < pPage->GetUsedSize())
+            PagesInUse.push_back(pPage);
+    }
+    m_MemoryMgr.CancelDefragmentation(PagesInUse);
+
+    // The old objects may still be used by the commands submitted before, and are read by the copy commands
+    for (auto& OldBuffer : OldBuffers)
+    {
+        SafeReleaseDeviceObject(std::move(OldBuffer.second.Buffer), OldBuffer.first);
+        SafeReleaseDeviceObject(std::move(OldBuffer.second.Memory), OldBuffer.first);
+    }
+    for (auto& OldTexture : OldTextures)
+    {
+        for (auto& View : OldTexture.second.Views)
+            SafeReleaseDeviceObject(std::move(View), OldTexture.first);
+        SafeReleaseDeviceObject(std::move(OldTexture.second.Image), OldTexture.first);
+        SafeReleaseDeviceObject(std::move(OldTexture.second.Memory), OldTexture.first);
+    }
+
+    if (Attribs.Callback != nullptr)
+    {
+        for (auto& pResource : RelocatedResources)
+            Attribs.Callback(pResource, Attribs.pUserData);
+    }
+
+    if (pStats != nullptr)
+        *pStats = Stats;
+}
+
 void RenderDeviceVkImpl::CreateTLAS(const TopLevelASDesc& Desc,
                                     ITopLevelAS**         ppTLAS)
 {
@@ -69,6 +69,7 @@ static RenderPassDesc GetImplicitRenderPassDesc(
     Uint8                                                         SampleCount,
     TEXTURE_FORMAT                                                ShadingRateTexFormat,
     uint2                                                         ShadingRateTileSize,
+    const RenderPassCache::AttachmentOps&                         Ops,
     std::array<RenderPassAttachmentDesc, MAX_RENDER_TARGETS + 2>& Attachments,
     std::array<AttachmentReference, MAX_RENDER_TARGETS + 2>&      AttachmentReferences,
     SubpassDesc&                                                  SubpassDesc,
@@ -89,14 +90,13 @@ static RenderPassDesc GetImplicitRenderPassDesc(
 
         DepthAttachment.Format      = DSVFormat;
         DepthAttachment.SampleCount = SampleCount;
-        DepthAttachment.LoadOp      = ATTACHMENT_LOAD_OP_LOAD; // previous contents of the image within the render area
-                                                               // will be preserved. For attachments with a depth/stencil format,
-                                                               // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT.
-        DepthAttachment.StoreOp = ATTACHMENT_STORE_OP_STORE;   // the contents generated during the render pass and within the render
-                                                               // area are written to memory. For attachments with a depth/stencil format,
-                                                               // this uses the access type VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT.
-        DepthAttachment.StencilLoadOp  = ATTACHMENT_LOAD_OP_LOAD;
-        DepthAttachment.StencilStoreOp = ATTACHMENT_STORE_OP_STORE;
+        // By default, previous contents of the image within the render area are preserved (LOAD), and the contents
+        // generated during the render pass are written to memory (STORE). The device context replaces these operations
+        // with CLEAR or DISCARD when it knows that the contents are not needed (see DeviceContextVkImpl::BeginImplicitRenderPass).
+        DepthAttachment.LoadOp         = Ops.DepthLoadOp;
+        DepthAttachment.StoreOp        = Ops.DepthStencilStoreOp;
+        DepthAttachment.StencilLoadOp  = Ops.StencilLoadOp;
+        DepthAttachment.StencilStoreOp = Ops.DepthStencilStoreOp;
         DepthAttachment.InitialState   = DepthAttachmentState;
         DepthAttachment.FinalState     = DepthAttachmentState;
 
@@ -122,12 +122,10 @@ static RenderPassDesc GetImplicitRenderPassDesc(
 
         ColorAttachment.Format      = RTVFormats[rt];
         ColorAttachment.SampleCount = SampleCount;
-        ColorAttachment.LoadOp      = ATTACHMENT_LOAD_OP_LOAD; // previous contents of the image within the render area
-                                                               // will be preserved. For attachments with a depth/stencil format,
-                                                               // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_READ_BIT.
-        ColorAttachment.StoreOp = ATTACHMENT_STORE_OP_STORE;   // the contents generated during the render pass and within the render
-                                                               // area are written to memory. For attachments with a color format,
-                                                               // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT.
+        ColorAttachment.LoadOp      = Ops.RTVLoadOps[rt];
+        ColorAttachment.StoreOp     = ATTACHMENT_STORE_OP_STORE; // the contents generated during the render pass and within the render
+                                                                 // area are written to memory. For attachments with a color format,
+                                                                 // this uses the access type VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT.
         ColorAttachment.StencilLoadOp  = ATTACHMENT_LOAD_OP_DISCARD;
         ColorAttachment.StencilStoreOp = ATTACHMENT_STORE_OP_DISCARD;
         ColorAttachment.InitialState   = RESOURCE_STATE_RENDER_TARGET;
@@ -212,7 +210,7 @@ RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
         ShadingRateAttachment ShadingRate;
 
         auto RPDesc = GetImplicitRenderPassDesc(Key.NumRenderTargets, Key.RTVFormats, Key.DSVFormat, Key.ReadOnlyDSV, Key.SampleCount, SRFormat, SRTileSize,
-                                                Attachments, AttachmentReferences, Subpass, ShadingRate);
+                                                Key.GetOps(), Attachments, AttachmentReferences, Subpass, ShadingRate);
 
         std::stringstream PassNameSS;
         PassNameSS << "Implicit render pass: RT count: " << Uint32{Key.NumRenderTargets} << "; sample count: " << Uint32{Key.SampleCount}
@@ -227,6 +225,8 @@ RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
         }
         if (Key.EnableVRS)
             PassNameSS << "; VRS";
+        if (!Key.GetOps().IsDefault())
+            PassNameSS << "; custom load/store ops";
 
         const auto PassName{PassNameSS.str()};
         RPDesc.Name = PassName.c_str();
@@ -61,6 +61,24 @@ RenderPassVkImpl::RenderPassVkImpl(IReferenceCounters*   pRefCounters,
         // Fragment density map is defined through RenderPassCI.pNext
     }
 
+    // Multiview is defined through VkSubpassDescription2::viewMask in render pass 2,
+    // and through RenderPassCI.pNext in render pass 1.
+    if (m_Desc.pSubpasses[0].ViewMask != 0)
+    {
+        DEV_CHECK_ERR(ExtFeats.Multiview.multiview != VK_FALSE, "This render pass requires Multiview Vulkan feature that is not enabled");
+
+        const Uint32 MaxViewCount = pDevice->GetPhysicalDevice().GetExtProperties().Multiview.maxMultiviewViewCount;
+        for (Uint32 i = 0; i < m_Desc.SubpassCount; ++i)
+        {
+            const Uint32 ViewMask = m_Desc.pSubpasses[i].ViewMask;
+            if (PlatformMisc::GetMSB(ViewMask) >= MaxViewCount)
+            {
+                LOG_ERROR_AND_THROW("Subpass ", i, " of render pass '", m_Desc.Name, "' uses view ", PlatformMisc::GetMSB(ViewMask),
+                                    ", but the device only supports ", MaxViewCount, " views.");
+            }
+        }
+    }
+
 
     switch (RenderPassVersion)
     {
@@ -98,6 +116,12 @@ inline void SetSubpassDescriptionNext(VkSubpassDescription2& Subpass, const void
     Subpass.pNext = pNext;
 }
 
+inline void SetSubpassViewMask(VkSubpassDescription&, Uint32) {}
+inline void SetSubpassViewMask(VkSubpassDescription2& Subpass, Uint32 ViewMask)
+{
+    Subpass.viewMask = ViewMask;
+}
+
 inline void InitSubpassDependency(VkSubpassDependency&) {}
 inline void InitSubpassDependency(VkSubpassDependency2& Dependency)
 {
@@ -186,6 +210,7 @@ void RenderPassVkImpl::CreateRenderPass() noexcept(false)
         InitSubpassDescription(vkSubpass);
         vkSubpass.flags             = 0;
         vkSubpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        SetSubpassViewMask(vkSubpass, SubpassDesc.ViewMask);
 
         std::fill(AttachmentStates.begin(), AttachmentStates.end(), RESOURCE_STATE_UNKNOWN);
         auto UpdateAttachmentsStates = [&AttachmentStates](Uint32 NumAttachments, const AttachmentReference* pSrcAttachments) //
@@ -342,6 +367,29 @@ void RenderPassVkImpl::CreateRenderPass() noexcept(false)
         FragDensityMapCI.fragmentDensityMapAttachment.layout     = VK_IMAGE_LAYOUT_FRAGMENT_DENSITY_MAP_OPTIMAL_EXT;
     }
 
+    // Enable multiview in render pass 1. Render pass 2 uses VkSubpassDescription2::viewMask.
+    std::vector<uint32_t>           vkViewMasks;
+    VkRenderPassMultiviewCreateInfo MultiviewCI{};
+    if (RPVersion == 1 && m_Desc.pSubpasses[0].ViewMask != 0)
+    {
+        vkViewMasks.resize(m_Desc.SubpassCount);
+        for (Uint32 i = 0; i < m_Desc.SubpassCount; ++i)
+            vkViewMasks[i] = m_Desc.pSubpasses[i].ViewMask;
+
+        MultiviewCI.sType        = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO;
+        MultiviewCI.pNext        = RenderPassCI.pNext;
+        MultiviewCI.subpassCount = m_Desc.SubpassCount;
+        MultiviewCI.pViewMasks   = vkViewMasks.data();
+        // Dependencies between subpasses only apply to the same view
+        MultiviewCI.dependencyCount = 0;
+        MultiviewCI.pViewOffsets    = nullptr;
+        // Views of a subpass are not expected to be spatially correlated
+        MultiviewCI.correlationMaskCount = 0;
+        MultiviewCI.pCorrelationMasks    = nullptr;
+
+        RenderPassCI.pNext = &MultiviewCI;
+    }
+
     m_VkRenderPass = LogicalDevice.CreateRenderPass(RenderPassCI, m_Desc.Name);
     if (!m_VkRenderPass)
     {
@@ -41,16 +41,27 @@
 namespace Diligent
 {
 
-size_t ShaderResourceCacheVk::GetRequiredMemorySize(Uint32 NumSets, const Uint32* SetSizes)
+static size_t GetTotalDescriptorDataSize(Uint32 NumSets, const DescriptorBufferSetLayoutVk* pDescrBufferLayouts)
+{
+    size_t DataSize = 0;
+    if (pDescrBufferLayouts != nullptr)
+    {
+        for (Uint32 t = 0; t < NumSets; ++t)
+            DataSize += pDescrBufferLayouts[t].DataSize;
+    }
+    return DataSize;
+}
+
+size_t ShaderResourceCacheVk::GetRequiredMemorySize(Uint32 NumSets, const Uint32* SetSizes, const DescriptorBufferSetLayoutVk* pDescrBufferLayouts)
 {
     Uint32 TotalResources = 0;
     for (Uint32 t = 0; t < NumSets; ++t)
         TotalResources += SetSizes[t];
-    size_t MemorySize = NumSets * sizeof(DescriptorSet) + TotalResources * sizeof(Resource);
+    size_t MemorySize = NumSets * sizeof(DescriptorSet) + TotalResources * sizeof(Resource) + GetTotalDescriptorDataSize(NumSets, pDescrBufferLayouts);
     return MemorySize;
 }
 
-void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, const Uint32* SetSizes)
+void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, const Uint32* SetSizes, const DescriptorBufferSetLayoutVk* pDescrBufferLayouts)
 {
     VERIFY(!m_pMemory, "Memory has already been allocated");
 
@@ -59,10 +70,11 @@ void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint3
     //  m_pMemory
     //  |
     //  V
-    // ||  DescriptorSet[0]  |   ....    |  DescriptorSet[Ns-1]  |  Res[0]  |  ... |  Res[n-1]  |    ....     | Res[0]  |  ... |  Res[m-1]  ||
+    // ||  DescriptorSet[0]  |   ....    |  DescriptorSet[Ns-1]  |  Res[0]  |  ... |  Res[n-1]  |    ....     | Res[0]  |  ... |  Res[m-1]  | Data[0] | ... | Data[Ns-1] ||
     //
     //
     //  Ns = m_NumSets
+    //  Data[i] is the descriptor buffer data of set i (only when pDescrBufferLayouts is not null)
 
     m_NumSets = static_cast<Uint16>(NumSets);
     VERIFY(m_NumSets == NumSets, "NumSets (", NumSets, ") exceed maximum representable value");
@@ -74,8 +86,9 @@ void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint3
         m_TotalResources += SetSizes[t];
     }
 
-    const auto MemorySize = NumSets * sizeof(DescriptorSet) + m_TotalResources * sizeof(Resource);
-    VERIFY_EXPR(MemorySize == GetRequiredMemorySize(NumSets, SetSizes));
+    const auto DescriptorDataSize = GetTotalDescriptorDataSize(NumSets, pDescrBufferLayouts);
+    const auto MemorySize         = NumSets * sizeof(DescriptorSet) + m_TotalResources * sizeof(Resource) + DescriptorDataSize;
+    VERIFY_EXPR(MemorySize == GetRequiredMemorySize(NumSets, SetSizes, pDescrBufferLayouts));
 #ifdef DILIGENT_DEBUG
     m_DbgInitializedResources.resize(m_NumSets);
 #endif
@@ -88,15 +101,31 @@ void ShaderResourceCacheVk::InitializeSets(IMemoryAllocator& MemAllocator, Uint3
 
         DescriptorSet* pSets       = reinterpret_cast<DescriptorSet*>(m_pMemory.get());
         Resource*      pCurrResPtr = reinterpret_cast<Resource*>(pSets + m_NumSets);
+        Uint8*         pCurrData   = reinterpret_cast<Uint8*>(pCurrResPtr + m_TotalResources);
+        if (DescriptorDataSize > 0)
+        {
+            // Descriptors that are never written must not be accessed by shaders, but keep the data deterministic
+            memset(pCurrData, 0, DescriptorDataSize);
+        }
         for (Uint32 t = 0; t < NumSets; ++t)
         {
-            new (&GetDescriptorSet(t)) DescriptorSet{SetSizes[t], SetSizes[t] > 0 ? pCurrResPtr : nullptr};
+            const DescriptorBufferSetLayoutVk* pLayout = pDescrBufferLayouts != nullptr ? &pDescrBufferLayouts[t] : nullptr;
+            VERIFY_EXPR(pLayout == nullptr || pLayout->Descriptors.size() == SetSizes[t]);
+
+            new (&GetDescriptorSet(t)) DescriptorSet{
+                SetSizes[t],
+                SetSizes[t] > 0 ? pCurrResPtr : nullptr,
+                pLayout,
+                pLayout != nullptr ? pCurrData : nullptr,
+            };
             pCurrResPtr += SetSizes[t];
+            if (pLayout != nullptr)
+                pCurrData += pLayout->DataSize;
 #ifdef DILIGENT_DEBUG
             m_DbgInitializedResources[t].resize(SetSizes[t]);
 #endif
         }
-        VERIFY_EXPR((char*)pCurrResPtr == (char*)m_pMemory.get() + MemorySize);
+        VERIFY_EXPR(pCurrData == (Uint8*)m_pMemory.get() + MemorySize);
     }
 }
 
@@ -164,6 +193,117 @@ static bool IsDynamicBuffer(const ShaderResourceCacheVk::Resource& Res)
 }
 
 
+// Writes the resource descriptor to the descriptor buffer data of its set
+static void WriteDescriptorData(const VulkanUtilities::VulkanLogicalDevice&    LogicalDevice,
+                                const ShaderResourceCacheVk::Resource&         Res,
+                                const DescriptorBufferSetLayoutVk::Descriptor& Descr,
+                                DeviceContextIndex                             CtxId,
+                                Uint8*                                         pSetData)
+{
+    Uint8* const pDstDescriptor = pSetData + Descr.Offset;
+
+    const bool IsImmutableSampler = Res.Type == DescriptorType::Sampler && Res.HasImmutableSampler;
+    if (!Res.pObject && !IsImmutableSampler)
+    {
+        memset(pDstDescriptor, 0, Descr.Size);
+        return;
+    }
+
+    VkDescriptorGetInfoEXT DescrInfo{};
+    DescrInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+    DescrInfo.pNext = nullptr;
+    DescrInfo.type  = DescriptorTypeToVkDescriptorBufferType(Res.Type);
+
+    // Do not zero-initialize!
+    union
+    {
+        VkSampler                  vkSampler;
+        VkDescriptorImageInfo      vkImageInfo;
+        VkDescriptorAddressInfoEXT vkAddressInfo;
+    };
+
+    const auto InitAddressInfo = [&](const BufferVkImpl* pBuffVk, Uint64 Offset, Uint64 Range, VkFormat Format) {
+        vkAddressInfo.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+        vkAddressInfo.pNext   = nullptr;
+        vkAddressInfo.address = pBuffVk->GetDynamicVkDeviceAddress(CtxId) + Offset;
+        vkAddressInfo.range   = Range;
+        vkAddressInfo.format  = Format;
+    };
+
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
+    switch (Res.Type)
+    {
+        case DescriptorType::Sampler:
+            // Immutable samplers must be written to the descriptor buffer explicitly
+            vkSampler               = Res.HasImmutableSampler ? Descr.ImmutableSampler : Res.GetSamplerDescriptorWriteInfo().sampler;
+            DescrInfo.data.pSampler = &vkSampler;
+            break;
+
+        case DescriptorType::CombinedImageSampler:
+            vkImageInfo = Res.GetImageDescriptorWriteInfo();
+            if (Res.HasImmutableSampler)
+                vkImageInfo.sampler = Descr.ImmutableSampler;
+            DescrInfo.data.pCombinedImageSampler = &vkImageInfo;
+            break;
+
+        case DescriptorType::SeparateImage:
+            vkImageInfo                  = Res.GetImageDescriptorWriteInfo();
+            DescrInfo.data.pSampledImage = &vkImageInfo;
+            break;
+
+        case DescriptorType::StorageImage:
+            vkImageInfo                  = Res.GetImageDescriptorWriteInfo();
+            DescrInfo.data.pStorageImage = &vkImageInfo;
+            break;
+
+        case DescriptorType::UniformTexelBuffer:
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+        {
+            const BufferViewVkImpl* pBuffViewVk = Res.pObject.ConstPtr<BufferViewVkImpl>();
+            const BufferViewDesc&   ViewDesc    = pBuffViewVk->GetDesc();
+            InitAddressInfo(pBuffViewVk->GetBuffer<const BufferVkImpl>(), ViewDesc.ByteOffset, ViewDesc.ByteWidth,
+                            TypeToVkFormat(ViewDesc.Format.ValueType, ViewDesc.Format.NumComponents, ViewDesc.Format.IsNormalized));
+            if (Res.Type == DescriptorType::UniformTexelBuffer)
+                DescrInfo.data.pUniformTexelBuffer = &vkAddressInfo;
+            else
+                DescrInfo.data.pStorageTexelBuffer = &vkAddressInfo;
+            break;
+        }
+
+        case DescriptorType::UniformBuffer:
+        case DescriptorType::UniformBufferDynamic:
+            InitAddressInfo(Res.pObject.ConstPtr<BufferVkImpl>(), Res.BufferBaseOffset + Res.BufferDynamicOffset, Res.BufferRangeSize, VK_FORMAT_UNDEFINED);
+            DescrInfo.data.pUniformBuffer = &vkAddressInfo;
+            break;
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+            InitAddressInfo(Res.pObject.ConstPtr<BufferViewVkImpl>()->GetBuffer<const BufferVkImpl>(),
+                            Res.BufferBaseOffset + Res.BufferDynamicOffset, Res.BufferRangeSize, VK_FORMAT_UNDEFINED);
+            DescrInfo.data.pStorageBuffer = &vkAddressInfo;
+            break;
+
+        case DescriptorType::InputAttachment:
+        case DescriptorType::InputAttachment_General:
+            vkImageInfo                          = Res.GetInputAttachmentDescriptorWriteInfo();
+            DescrInfo.data.pInputAttachmentImage = &vkImageInfo;
+            break;
+
+        case DescriptorType::AccelerationStructure:
+            DescrInfo.data.accelerationStructure = Res.pObject.ConstPtr<TopLevelASVkImpl>()->GetVkDeviceAddress();
+            break;
+
+        default:
+            UNEXPECTED("Unexpected descriptor type");
+            return;
+    }
+
+    LogicalDevice.GetDescriptor(DescrInfo, Descr.Size, pDstDescriptor);
+}
+
 #ifdef DILIGENT_DEBUG
 void ShaderResourceCacheVk::DbgVerifyResourceInitialization() const
 {
@@ -329,7 +469,16 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
     }
 
     VkDescriptorSet vkSet = DescrSet.GetVkDescriptorSet();
-    if (vkSet != VK_NULL_HANDLE && DstRes.pObject)
+    if (DescrSet.m_pDescriptorData != nullptr)
+    {
+        // Descriptors of buffers with dynamic offsets are written by WriteDescriptorBufferData()
+        if (!IsDynamicDescriptorType(DstRes.Type))
+        {
+            VERIFY(pLogicalDevice != nullptr || !DstRes.pObject, "Logical device must not be null to write a non-null descriptor");
+            WriteDescriptorData(*pLogicalDevice, DstRes, DescrSet.m_pDescrBufferLayout->Descriptors[CacheOffset], DeviceContextIndex{0}, DescrSet.m_pDescriptorData);
+        }
+    }
+    else if (vkSet != VK_NULL_HANDLE && DstRes.pObject)
     {
         VERIFY(pLogicalDevice != nullptr, "Logical device must not be null to write descriptor to a non-null set");
 
@@ -410,11 +559,64 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
         pLogicalDevice->UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
     }
 
+    MarkResourceForTransition(static_cast<Uint32>(&DstRes - GetFirstResourcePtr()));
     UpdateRevision();
 
     return DstRes;
 }
 
+void ShaderResourceCacheVk::InitializeImmutableSamplerDescriptors(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice)
+{
+    for (Uint32 t = 0; t < m_NumSets; ++t)
+    {
+        DescriptorSet& DescrSet = GetDescriptorSet(t);
+        if (DescrSet.m_pDescriptorData == nullptr)
+            continue;
+
+        const DescriptorBufferSetLayoutVk& Layout = *DescrSet.m_pDescrBufferLayout;
+        for (Uint32 res = 0; res < DescrSet.GetSize(); ++res)
+        {
+            const Resource& Res = DescrSet.GetResource(res);
+            if (Res.Type == DescriptorType::Sampler && Res.HasImmutableSampler)
+                WriteDescriptorData(LogicalDevice, Res, Layout.Descriptors[res], DeviceContextIndex{0}, DescrSet.m_pDescriptorData);
+        }
+
+        for (const auto& Sampler : Layout.ImmutableSamplers)
+        {
+            VERIFY_EXPR(Sampler.ImmutableSampler != VK_NULL_HANDLE);
+
+            VkDescriptorGetInfoEXT DescrInfo{};
+            DescrInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+            DescrInfo.type          = VK_DESCRIPTOR_TYPE_SAMPLER;
+            DescrInfo.data.pSampler = &Sampler.ImmutableSampler;
+            LogicalDevice.GetDescriptor(DescrInfo, Sampler.Size, DescrSet.m_pDescriptorData + Sampler.Offset);
+        }
+    }
+}
+
+void ShaderResourceCacheVk::WriteDescriptorBufferData(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                                      DeviceContextIndex                          CtxId,
+                                                      Uint32                                      SetIndex,
+                                                      Uint8*                                      pDstData) const
+{
+    const DescriptorSet& DescrSet = GetDescriptorSet(SetIndex);
+    VERIFY(DescrSet.m_pDescriptorData != nullptr, "Descriptor set ", SetIndex, " has no descriptor buffer data");
+
+    const DescriptorBufferSetLayoutVk& Layout = *DescrSet.m_pDescrBufferLayout;
+    memcpy(pDstData, DescrSet.m_pDescriptorData, Layout.DataSize);
+
+    // Uniform and storage buffers with dynamic offsets always go first in each descriptor set (see GetDynamicBufferOffsets()).
+    // Their addresses may change every time the buffer is mapped, so the descriptors are written every time.
+    for (Uint32 res = 0; res < DescrSet.GetSize(); ++res)
+    {
+        const Resource& Res = DescrSet.GetResource(res);
+        if (!IsDynamicDescriptorType(Res.Type))
+            break;
+
+        WriteDescriptorData(LogicalDevice, Res, Layout.Descriptors[res], CtxId, pDstData);
+    }
+}
+
 void ShaderResourceCacheVk::SetDynamicBufferOffset(Uint32 DescrSetIndex,
                                                    Uint32 CacheOffset,
                                                    Uint32 DynamicBufferOffset)
@@ -585,7 +787,13 @@ inline void TransitionTextureView(DeviceContextVkImpl* pCtxVkImpl,
             VERIFY_EXPR(ResourceStateToVkImageLayout(RequiredState) == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
         }
     }
-    const bool IsInRequiredState = pTextureVk->CheckState(RequiredState);
+    // Textures that track subresource states are only transitioned within the range of the view
+    const bool                    UseSubresRange = pTextureVk->HasSubresourceStates();
+    const TextureSubresourceRange SubresRange    = UseSubresRange ? pTextureVk->GetViewSubresourceRange(pTextureViewVk->GetDesc()) : TextureSubresourceRange{};
+
+    const bool IsInRequiredState = UseSubresRange ?
+        pTextureVk->CheckSubresourceState(SubresRange, RequiredState) :
+        pTextureVk->CheckState(RequiredState);
 
     if (VerifyOnly)
     {
@@ -605,7 +813,15 @@ inline void TransitionTextureView(DeviceContextVkImpl* pCtxVkImpl,
         // to make sure that all UAV writes are complete and visible.
         if (!IsInRequiredState || RequiredState == RESOURCE_STATE_UNORDERED_ACCESS)
         {
-            pCtxVkImpl->TransitionTextureState(*pTextureVk, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE);
+            if (UseSubresRange)
+            {
+                VkImageSubresourceRange VkSubresRange{0, SubresRange.FirstMip, SubresRange.NumMips, SubresRange.FirstSlice, SubresRange.NumSlices};
+                pCtxVkImpl->TransitionTextureState(*pTextureVk, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE, &VkSubresRange);
+            }
+            else
+            {
+                pCtxVkImpl->TransitionTextureState(*pTextureVk, RESOURCE_STATE_UNKNOWN, RequiredState, STATE_TRANSITION_FLAG_UPDATE_STATE);
+            }
         }
     }
 }
@@ -651,11 +867,26 @@ inline void TransitionAccelStruct(DeviceContextVkImpl* pCtxVkImpl,
 template <bool VerifyOnly>
 void ShaderResourceCacheVk::TransitionResources(DeviceContextVkImpl* pCtxVkImpl)
 {
+    // When transitioning resources, skip the ones that could not have changed their states
+    // since the last pass. This avoids iterating over large descriptor arrays on every commit.
+    const StateTransitionRange Range = VerifyOnly ?
+        StateTransitionRange{0, m_TotalResources, 0} :
+        BeginStateTransition(m_TotalResources);
+
+    bool HasUnconditionalTransitions = false;
+
     Resource* pResources = GetFirstResourcePtr();
-    for (Uint32 res = 0; res < m_TotalResources; ++res)
+    for (Uint32 res = Range.First; res < Range.End; ++res)
     {
         Resource& Res = pResources[res];
 
+        // UAVs require a barrier every time they are used, and TLAS content must be validated
+        if (!VerifyOnly && Res.pObject &&
+            (Res.Type == DescriptorType::AccelerationStructure || DescriptorTypeToResourceState(Res.Type) == RESOURCE_STATE_UNORDERED_ACCESS))
+        {
+            HasUnconditionalTransitions = true;
+        }
+
         static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
         switch (Res.Type)
         {
@@ -698,6 +929,9 @@ void ShaderResourceCacheVk::TransitionResources(DeviceContextVkImpl* pCtxVkImpl)
             default: UNEXPECTED("Unexpected resource type");
         }
     }
+
+    if (!VerifyOnly)
+        EndStateTransition(Range, m_TotalResources, HasUnconditionalTransitions);
 }
 
 template void ShaderResourceCacheVk::TransitionResources<false>(DeviceContextVkImpl* pCtxVkImpl);
@@ -37,6 +37,7 @@
 #include "GLSLUtils.hpp"
 #include "DXCompiler.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 #if !DILIGENT_NO_GLSLANG
 #    include "GLSLangUtils.hpp"
@@ -78,7 +79,11 @@ std::vector<uint32_t> CompileShaderDXC(const ShaderCreateInfo&         ShaderCI,
     {
         // SPIR-V bytecode generated from HLSL must be legalized to
         // turn it into a valid vulkan SPIR-V shader.
-        auto LegalizedSPIRV = OptimizeSPIRV(SPIRV, SPV_ENV_MAX, SPIRV_OPTIMIZATION_FLAG_LEGALIZATION);
+        SPIRV_OPTIMIZATION_FLAGS Passes = SPIRV_OPTIMIZATION_FLAG_LEGALIZATION;
+        // DXC has already optimized the bytecode for performance
+        if (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE)
+            Passes |= SPIRV_OPTIMIZATION_FLAG_SIZE;
+        auto LegalizedSPIRV = OptimizeSPIRV(SPIRV, SPV_ENV_MAX, Passes);
         if (!LegalizedSPIRV.empty())
             SPIRV = std::move(LegalizedSPIRV);
         else
@@ -144,6 +149,7 @@ std::vector<uint32_t> CompileShaderGLSLang(const ShaderCreateInfo&         Shade
         Attribs.Macros                     = Macros;
         Attribs.AssignBindings             = true;
         Attribs.UseRowMajorMatrices        = (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR) != 0;
+        Attribs.OptimizeForSize            = (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE) != 0;
         Attribs.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
         Attribs.ppCompilerOutput           = VkShaderCI.ppCompilerOutput;
 
@@ -164,6 +170,8 @@ std::vector<uint32_t> CompileShaderGLSLang(const ShaderCreateInfo&         Shade
 void ShaderVkImpl::Initialize(const ShaderCreateInfo& ShaderCI,
                               const CreateInfo&       VkShaderCI)
 {
+    ShaderCompilationScope CompilationScope{m_Desc.Name, false};
+
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "'ByteCode' must be null when shader is created from source code or a file");
@@ -219,6 +227,8 @@ void ShaderVkImpl::Initialize(const ShaderCreateInfo& ShaderCI,
     {
         if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0)
         {
+            ShaderCompilationStageScope Reflection{SHADER_COMPILATION_STAGE_REFLECTION};
+
             auto& Allocator = GetRawAllocator();
 
             std::unique_ptr<void, STDDeleterRawMem<void>> pRawMem{
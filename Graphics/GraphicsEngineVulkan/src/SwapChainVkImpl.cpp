@@ -49,12 +49,15 @@ SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
     m_DesiredBufferCount         {SCDesc.BufferCount},
     m_pBackBufferRTV             (STD_ALLOCATOR_RAW_MEM(RefCntAutoPtr<ITextureView>, GetRawAllocator(), "Allocator for vector<RefCntAutoPtr<ITextureView>>")),
     m_SwapChainImagesInitialized (STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>")),
-    m_ImageAcquiredFenceSubmitted(STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>"))
+    m_ImageAcquiredFenceSubmitted(STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>")),
+    m_FrameCompleteFenceSubmitted(STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>")),
+    m_MaxFrameLatency            {SCDesc.MaxFrameLatency != 0 ? SCDesc.MaxFrameLatency : SCDesc.BufferCount}
 // clang-format on
 {
     CreateSurface();
     CreateVulkanSwapChain();
     InitBuffersAndViews();
+    CreateFrameCompleteFences();
     auto res = AcquireNextImage(pDeviceContextVk);
     DEV_CHECK_ERR(res == VK_SUCCESS, "Failed to acquire next image for the newly created swap chain");
     (void)res;
@@ -335,6 +338,13 @@ void SwapChainVkImpl::CreateVulkanSwapChain()
             PreferredPresentModes.push_back(VK_PRESENT_MODE_FIFO_RELAXED_KHR);
             PreferredPresentModes.push_back(VK_PRESENT_MODE_FIFO_KHR);
         }
+        else if (m_SwapChainDesc.UnsyncedPresentMode == UNSYNCED_PRESENT_MODE_IMMEDIATE)
+        {
+            // Immediate mode has the lowest latency, but may result in tearing.
+            PreferredPresentModes.push_back(VK_PRESENT_MODE_IMMEDIATE_KHR);
+            PreferredPresentModes.push_back(VK_PRESENT_MODE_MAILBOX_KHR);
+            PreferredPresentModes.push_back(VK_PRESENT_MODE_FIFO_KHR);
+        }
         else
         {
             // Mailbox is the lowest latency non-tearing presentation mode.
@@ -527,6 +537,10 @@ SwapChainVkImpl::~SwapChainVkImpl()
         VERIFY_EXPR(m_VkSwapChain == VK_NULL_HANDLE);
     }
 
+    // The fences are destroyed immediately, so we must wait until they are signaled
+    WaitForFrameCompleteFences();
+    m_FrameCompleteFences.clear();
+
     if (m_VkSurface != VK_NULL_HANDLE)
     {
         vkDestroySurfaceKHR(m_VulkanInstance->GetVkInstance(), m_VkSurface, NULL);
@@ -700,6 +714,29 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
 
     pImmediateCtxVk->Flush();
 
+    // Make sure that there are no more than m_MaxFrameLatency frames in the queue, and track this frame.
+    // We wait for the frame as late as possible - right before presenting. If the application has already
+    // waited for the frame with WaitForNextFrame(), the fence is not submitted and this is a no-op.
+    //
+    //         N-L                          N-1           N (Current frame)
+    //          |                            |            |
+    //          |
+    //  Wait for this fence
+    //
+    WaitForFrameCompleteFence(UINT64_MAX);
+    {
+        VkFence FrameCompleteFence = m_FrameCompleteFences[m_FrameFenceIndex];
+        pDeviceVk->LockCmdQueueAndRun(
+            pImmediateCtxVk->GetCommandQueueId(),
+            [FrameCompleteFence](ICommandQueueVk* pCmdQueueVk) //
+            {
+                pCmdQueueVk->EnqueueSignalFence(FrameCompleteFence);
+            } //
+        );
+        m_FrameCompleteFenceSubmitted[m_FrameFenceIndex] = true;
+        m_FrameFenceIndex                                = (m_FrameFenceIndex + 1) % static_cast<Uint32>(m_FrameCompleteFences.size());
+    }
+
     if (!m_IsMinimized)
     {
         VkPresentInfoKHR PresentInfo = {};
@@ -786,6 +823,83 @@ void SwapChainVkImpl::WaitForImageAcquiredFences()
     }
 }
 
+void SwapChainVkImpl::CreateFrameCompleteFences()
+{
+    VERIFY(m_FrameCompleteFences.empty(), "Frame complete fences have already been created");
+
+    const auto& LogicalDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice();
+
+    VkFenceCreateInfo FenceCI = {};
+
+    FenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    FenceCI.pNext = nullptr;
+    FenceCI.flags = 0;
+
+    const Uint32 NumFences = std::max(m_MaxFrameLatency, 1u);
+    m_FrameCompleteFences.resize(NumFences);
+    for (Uint32 i = 0; i < NumFences; ++i)
+        m_FrameCompleteFences[i] = LogicalDevice.CreateFence(FenceCI, "Swap chain frame complete fence");
+    m_FrameCompleteFenceSubmitted.assign(NumFences, false);
+    m_FrameFenceIndex = 0;
+}
+
+bool SwapChainVkImpl::WaitForFrameCompleteFence(uint64_t Timeout)
+{
+    // The fence at the current index is the oldest one
+    if (!m_FrameCompleteFenceSubmitted[m_FrameFenceIndex])
+        return true;
+
+    const auto& LogicalDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice();
+
+    VkFence vkFence = m_FrameCompleteFences[m_FrameFenceIndex];
+    if (LogicalDevice.GetFenceStatus(vkFence) == VK_NOT_READY)
+    {
+        auto res = LogicalDevice.WaitForFences(1, &vkFence, VK_TRUE, Timeout);
+        if (res != VK_SUCCESS)
+        {
+            DEV_CHECK_ERR(res == VK_TIMEOUT, "Failed to wait for the frame complete fence");
+            return false;
+        }
+    }
+    LogicalDevice.ResetFence(vkFence);
+    m_FrameCompleteFenceSubmitted[m_FrameFenceIndex] = false;
+
+    return true;
+}
+
+void SwapChainVkImpl::WaitForFrameCompleteFences()
+{
+    const auto& LogicalDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice();
+    for (size_t i = 0; i < m_FrameCompleteFences.size(); ++i)
+    {
+        if (m_FrameCompleteFenceSubmitted[i])
+        {
+            VkFence vkFence = m_FrameCompleteFences[i];
+            if (LogicalDevice.GetFenceStatus(vkFence) == VK_NOT_READY)
+                LogicalDevice.WaitForFences(1, &vkFence, VK_TRUE, UINT64_MAX);
+            m_FrameCompleteFenceSubmitted[i] = false;
+        }
+    }
+}
+
+void SwapChainVkImpl::SetMaximumFrameLatency(Uint32 MaxLatency)
+{
+    if (m_MaxFrameLatency == MaxLatency)
+        return;
+
+    m_MaxFrameLatency = MaxLatency;
+
+    // Wait for all frames to complete as they may have been submitted with the old latency.
+    WaitForFrameCompleteFences();
+    m_FrameCompleteFences.clear();
+    CreateFrameCompleteFences();
+}
+
+Bool SwapChainVkImpl::WaitForNextFrame(Uint32 Timeout)
+{
+    return WaitForFrameCompleteFence(Timeout == 0xFFFFFFFFu ? UINT64_MAX : Uint64{Timeout} * 1000000u);
+}
+
 void SwapChainVkImpl::ReleaseSwapChainResources(DeviceContextVkImpl* pImmediateCtxVk, bool DestroyVkSwapChain)
 {
     if (m_VkSwapChain == VK_NULL_HANDLE)
@@ -55,14 +55,32 @@ TextureViewVkImpl::TextureViewVkImpl(IReferenceCounters*                 pRefCou
 
 TextureViewVkImpl::~TextureViewVkImpl()
 {
-    if (m_Desc.ViewType == TEXTURE_VIEW_DEPTH_STENCIL ||
-        m_Desc.ViewType == TEXTURE_VIEW_READ_ONLY_DEPTH_STENCIL ||
-        m_Desc.ViewType == TEXTURE_VIEW_RENDER_TARGET ||
-        m_Desc.ViewType == TEXTURE_VIEW_SHADING_RATE)
+    if (IsAttachmentView())
     {
         m_pDevice->GetFramebufferCache().OnDestroyImageView(m_ImageView);
     }
     m_pDevice->SafeReleaseDeviceObject(std::move(m_ImageView), m_pTexture->GetDesc().ImmediateContextMask);
 }
 
+bool TextureViewVkImpl::IsAttachmentView() const
+{
+    return (m_Desc.ViewType == TEXTURE_VIEW_DEPTH_STENCIL ||
+            m_Desc.ViewType == TEXTURE_VIEW_READ_ONLY_DEPTH_STENCIL ||
+            m_Desc.ViewType == TEXTURE_VIEW_RENDER_TARGET ||
+            m_Desc.ViewType == TEXTURE_VIEW_SHADING_RATE);
+}
+
+VulkanUtilities::ImageViewWrapper TextureViewVkImpl::ReplaceImageView(VulkanUtilities::ImageViewWrapper&& ImgView)
+{
+    // Framebuffers that use the old view must not be reused
+    if (IsAttachmentView())
+    {
+        m_pDevice->GetFramebufferCache().OnDestroyImageView(m_ImageView);
+    }
+
+    VulkanUtilities::ImageViewWrapper OldView = std::move(m_ImageView);
+    m_ImageView                               = std::move(ImgView);
+    return OldView;
+}
+
 } // namespace Diligent
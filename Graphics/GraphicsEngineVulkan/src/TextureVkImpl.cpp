@@ -197,6 +197,18 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         // and the transition away from this layout is not guaranteed to preserve that data.
         ImageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
+        VkExternalMemoryImageCreateInfo ExternalMemoryCI{};
+        if (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_EXPORTABLE)
+        {
+            if (!LogicalDevice.GetEnabledExtFeatures().ExternalMemory)
+                LOG_ERROR_AND_THROW("Exportable texture '", m_Desc.Name, "' requires external memory extension that is not supported by the device.");
+
+            ExternalMemoryCI.sType       = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO;
+            ExternalMemoryCI.pNext       = ImageCI.pNext;
+            ExternalMemoryCI.handleTypes = VulkanUtilities::VulkanPhysicalDevice::ExternalMemoryHandleType;
+            ImageCI.pNext                = &ExternalMemoryCI;
+        }
+
         if (m_Desc.Usage == USAGE_SPARSE)
         {
             m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
@@ -209,11 +221,15 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
         {
             m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
 
-            VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
+            VulkanUtilities::VulkanDedicatedAllocationInfo DedicatedInfo;
+            DedicatedInfo.Image             = m_VulkanImage;
+            DedicatedInfo.ExportHandleTypes = ExternalMemoryCI.handleTypes;
+
+            VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage, DedicatedInfo.PrefersDedicated);
 
             const auto ImageMemoryFlags = IsMemoryless ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
             VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
-            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags, 0, &DedicatedInfo);
             if (!m_MemoryAllocation)
                 LOG_ERROR_AND_THROW("Failed to allocate memory for texture '", m_Desc.Name, "'.");
 
@@ -239,6 +255,9 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
     }
 
     VERIFY_EXPR(IsInKnownState());
+
+    if (IsRelocatable())
+        pRenderDeviceVk->RegisterRelocatableResource(this);
 }
 
 void TextureVkImpl::InitializeTextureContent(const TextureData&          InitData,
@@ -563,6 +582,9 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
 
 TextureVkImpl::~TextureVkImpl()
 {
+    if (IsRelocatable())
+        m_pDevice->UnregisterRelocatableResource(this);
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     // Wrappers for external texture will not be destroyed as they are created with null device pointer
     if (m_VulkanImage)
@@ -770,6 +792,132 @@ VulkanUtilities::ImageViewWrapper TextureVkImpl::CreateImageView(TextureViewDesc
     return LogicalDevice.CreateImageView(ImageViewCI, ViewName.c_str());
 }
 
+bool TextureVkImpl::IsRelocatable() const
+{
+    return (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_IMMUTABLE) &&
+        (m_Desc.MiscFlags & (MISC_TEXTURE_FLAG_MEMORYLESS | MISC_TEXTURE_FLAG_SUBSAMPLED | MISC_TEXTURE_FLAG_EXPORTABLE)) == 0 &&
+        m_MemoryAllocation.Page != nullptr &&
+        PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) == 1;
+}
+
+bool TextureVkImpl::Relocate(VulkanUtilities::VulkanCommandBuffer& CmdBuffer, RelocationData& OldResources) noexcept(false)
+{
+    VERIFY_EXPR(IsRelocatable());
+
+    // The image layout must be known to copy the contents and transition the new image to the same layout
+    if (!IsInKnownState())
+        return false;
+
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+
+    VkImageCreateInfo ImageCI = TextureDescToVkImageCreateInfo(m_Desc, GetDevice());
+    ImageCI.initialLayout     = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VulkanUtilities::ImageWrapper NewImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
+
+    VulkanUtilities::VulkanDedicatedAllocationInfo DedicatedInfo;
+    DedicatedInfo.Image = NewImage;
+
+    VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(NewImage, DedicatedInfo.PrefersDedicated);
+    VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+
+    VulkanUtilities::VulkanMemoryAllocation NewMemory = GetDevice()->AllocateMemory(MemReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, &DedicatedInfo);
+    if (!NewMemory)
+        return false;
+
+    auto AlignedOffset = AlignUp(NewMemory.UnalignedOffset, MemReqs.alignment);
+    VERIFY_EXPR(NewMemory.Size >= MemReqs.size + (AlignedOffset - NewMemory.UnalignedOffset));
+    auto err = LogicalDevice.BindImageMemory(NewImage, NewMemory.Page->GetVkMemory(), AlignedOffset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
+
+    const VkImageLayout Layout = GetLayout();
+    // Contents of a texture in undefined state do not need to be preserved
+    if (Layout != VK_IMAGE_LAYOUT_UNDEFINED)
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(m_Desc.Format);
+
+        VkImageSubresourceRange SubresRange;
+        if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
+            SubresRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        else if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+            SubresRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        else
+            SubresRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        SubresRange.baseArrayLayer = 0;
+        SubresRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+        SubresRange.baseMipLevel   = 0;
+        SubresRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+
+        // Memory dependency on the previous commands is established by the caller
+        CmdBuffer.TransitionImageLayout(m_VulkanImage, Layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, SubresRange,
+                                        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        CmdBuffer.TransitionImageLayout(NewImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange,
+                                        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+        std::vector<VkImageCopy> Regions(m_Desc.MipLevels);
+        for (Uint32 mip = 0; mip < m_Desc.MipLevels; ++mip)
+        {
+            const auto MipInfo = GetMipLevelProperties(m_Desc, mip);
+
+            auto& Region                         = Regions[mip];
+            Region.srcSubresource.aspectMask     = SubresRange.aspectMask;
+            Region.srcSubresource.mipLevel       = mip;
+            Region.srcSubresource.baseArrayLayer = 0;
+            Region.srcSubresource.layerCount     = m_Desc.GetArraySize();
+            Region.srcOffset                     = VkOffset3D{0, 0, 0};
+            Region.dstSubresource                = Region.srcSubresource;
+            Region.dstOffset                     = VkOffset3D{0, 0, 0};
+            // For compressed formats, logical mip size is either a multiple of the block size or reaches the image edge
+            Region.extent = VkExtent3D{MipInfo.LogicalWidth, MipInfo.LogicalHeight, MipInfo.Depth};
+        }
+        CmdBuffer.CopyImage(m_VulkanImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, NewImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            static_cast<uint32_t>(Regions.size()), Regions.data());
+
+        CmdBuffer.TransitionImageLayout(NewImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, Layout, SubresRange,
+                                        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    }
+
+    // Default view objects are kept, so that the pointers held by the application remain valid.
+    // New image views are created before anything is replaced, so that the texture is left
+    // unchanged if view creation fails.
+    const auto NumDefaultViews = m_pDefaultViews != nullptr ? GetNumDefaultViews() : 0;
+    auto**     ppDefaultViews  = GetDefaultViewsArrayPtr();
+
+    std::swap(m_VulkanImage, NewImage);
+    std::vector<VulkanUtilities::ImageViewWrapper> NewViews;
+    try
+    {
+        for (Uint32 i = 0; i < NumDefaultViews; ++i)
+        {
+            if (auto* pView = ppDefaultViews[i])
+            {
+                TextureViewDesc ViewDesc = pView->GetDesc();
+                NewViews.emplace_back(CreateImageView(ViewDesc));
+            }
+        }
+    }
+    catch (...)
+    {
+        std::swap(m_VulkanImage, NewImage);
+        // The copy commands reference the new image, so it must be released by the caller
+        OldResources.Image  = std::move(NewImage);
+        OldResources.Memory = std::move(NewMemory);
+        throw;
+    }
+
+    OldResources.Image  = std::move(NewImage);
+    OldResources.Memory = std::move(m_MemoryAllocation);
+    m_MemoryAllocation  = std::move(NewMemory);
+
+    for (Uint32 i = 0, v = 0; i < NumDefaultViews; ++i)
+    {
+        if (auto* pView = ppDefaultViews[i])
+            OldResources.Views.emplace_back(pView->ReplaceImageView(std::move(NewViews[v++])));
+    }
+
+    return true;
+}
+
 void TextureVkImpl::SetLayout(VkImageLayout Layout)
 {
     SetState(VkImageLayoutToResourceState(Layout));
@@ -781,6 +929,37 @@ VkImageLayout TextureVkImpl::GetLayout() const
     return ResourceStateToVkImageLayout(GetState(), /*IsInsideRenderPass = */ false, fragmentDensityMap != VK_FALSE);
 }
 
+Bool TextureVkImpl::ExportMemoryHandle(ExternalMemoryHandleVk& Handle) const
+{
+    if ((m_Desc.MiscFlags & MISC_TEXTURE_FLAG_EXPORTABLE) == 0)
+    {
+        DEV_ERROR("Texture '", m_Desc.Name, "' was not created with MISC_TEXTURE_FLAG_EXPORTABLE flag");
+        return False;
+    }
+    if (m_MemoryAllocation.Page == nullptr)
+    {
+        DEV_ERROR("Texture '", m_Desc.Name, "' does not own its memory and can't be exported");
+        return False;
+    }
+    VERIFY(m_MemoryAllocation.Page->IsDedicated(), "Exportable textures must use dedicated memory pages");
+
+    uint64_t vkHandle = 0;
+    if (m_pDevice->GetLogicalDevice().GetMemoryHandle(m_MemoryAllocation.Page->GetVkMemory(), vkHandle) != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to export the memory of texture '", m_Desc.Name, "'");
+        return False;
+    }
+
+    // The image is bound at the start of its dedicated page
+    VERIFY_EXPR(m_MemoryAllocation.UnalignedOffset == 0);
+
+    Handle.Handle         = vkHandle;
+    Handle.HandleType     = VulkanUtilities::VulkanPhysicalDevice::ExternalMemoryHandleType;
+    Handle.AllocationSize = m_MemoryAllocation.Page->GetPageSize();
+    Handle.Offset         = 0;
+    return True;
+}
+
 void TextureVkImpl::InvalidateStagingRange(VkDeviceSize Offset, VkDeviceSize Size)
 {
     const auto& LogicalDevice    = m_pDevice->GetLogicalDevice();
@@ -69,6 +69,14 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
         VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
         VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    if (DeviceVk.IsDescriptorBufferEnabled())
+    {
+        // Descriptors are suballocated from the dynamic heap, and dynamic buffers are referenced by device address
+        VkBuffCI.usage |=
+            VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+            VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
     VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
     VkBuffCI.queueFamilyIndexCount = 0;
     VkBuffCI.pQueueFamilyIndices   = nullptr;
@@ -84,6 +92,14 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
     MemAlloc.sType          = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     MemAlloc.allocationSize = MemReqs.size;
 
+    VkMemoryAllocateFlagsInfo FlagsInfo{};
+    if (VkBuffCI.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+    {
+        FlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+        FlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+        MemAlloc.pNext  = &FlagsInfo;
+    }
+
     // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges
     // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
     // to the host (10.2)
@@ -111,6 +127,9 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
     err = LogicalDevice.BindBufferMemory(m_VkBuffer, m_BufferMemory, 0 /*offset*/);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
 
+    if (VkBuffCI.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+        m_VkDeviceAddress = LogicalDevice.GetBufferDeviceAddress(m_VkBuffer);
+
     LOG_INFO_MESSAGE("GPU dynamic heap created. Total buffer size: ", FormatMemorySize(Size, 2));
 }
 
@@ -122,7 +141,8 @@ void VulkanDynamicMemoryManager::Destroy()
         m_DeviceVk.SafeReleaseDeviceObject(std::move(m_VkBuffer), m_CommandQueueMask);
         m_DeviceVk.SafeReleaseDeviceObject(std::move(m_BufferMemory), m_CommandQueueMask);
     }
-    m_CPUAddress = nullptr;
+    m_CPUAddress      = nullptr;
+    m_VkDeviceAddress = 0;
 }
 
 VulkanDynamicMemoryManager::~VulkanDynamicMemoryManager()
@@ -219,6 +239,39 @@ VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMast
     return Block;
 }
 
+VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::TryAllocateMasterBlock(OffsetType SizeInBytes)
+{
+    if (SizeInBytes > GetSize())
+        return MasterBlock{};
+
+    auto Block = TBase::AllocateMasterBlock(SizeInBytes, MasterBlockAlignment);
+    if (Block.IsValid())
+    {
+        m_TotalPeakSize = std::max(m_TotalPeakSize, GetUsedSize());
+    }
+    return Block;
+}
+
+
+static Uint32 GetMaxMasterBlockSize(const VulkanDynamicMemoryManager& DynamicMemMgr, Uint32 PageSize)
+{
+    // Limit the adaptive block size so that a single context can't take over the entire heap
+    const auto MaxSize = static_cast<Uint32>(DynamicMemMgr.GetSize() / 16);
+    return std::max(AlignDownNonPw2(MaxSize, PageSize), PageSize);
+}
+
+VulkanDynamicHeap::VulkanDynamicHeap(VulkanDynamicMemoryManager& DynamicMemMgr, std::string HeapName, Uint32 PageSize) :
+    // clang-format off
+    m_GlobalDynamicMemMgr{DynamicMemMgr},
+    m_HeapName           {std::move(HeapName)},
+    m_MasterBlockSize    {PageSize},
+    m_MaxMasterBlockSize {GetMaxMasterBlockSize(DynamicMemMgr, PageSize)},
+    m_NextMasterBlockSize{PageSize}
+// clang-format on
+{
+    VERIFY_EXPR(m_MasterBlockSize > 0);
+}
+
 
 VulkanDynamicAllocation VulkanDynamicHeap::Allocate(Uint32 SizeInBytes, Uint32 Alignment)
 {
@@ -244,13 +297,25 @@ VulkanDynamicAllocation VulkanDynamicHeap::Allocate(Uint32 SizeInBytes, Uint32 A
     {
         if (m_CurrOffset == InvalidOffset || SizeInBytes + (AlignUp(m_CurrOffset, size_t{Alignment}) - m_CurrOffset) > m_AvailableSize)
         {
-            auto MasterBlock = m_GlobalDynamicMemMgr.AllocateMasterBlock(m_MasterBlockSize, 0);
+            MasterBlock MasterBlock;
+            if (m_NextMasterBlockSize > m_MasterBlockSize)
+            {
+                // Do not wait for the GPU if there is no space for the larger block - fall
+                // back to the default block size instead.
+                MasterBlock = m_GlobalDynamicMemMgr.TryAllocateMasterBlock(m_NextMasterBlockSize);
+            }
+            if (!MasterBlock.IsValid())
+                MasterBlock = m_GlobalDynamicMemMgr.AllocateMasterBlock(m_MasterBlockSize, 0);
+
             if (MasterBlock.IsValid())
             {
                 m_CurrOffset = MasterBlock.UnalignedOffset;
                 m_CurrAllocatedSize += static_cast<Uint32>(MasterBlock.Size);
                 m_AvailableSize = static_cast<Uint32>(MasterBlock.Size);
                 m_MasterBlocks.emplace_back(MasterBlock);
+
+                // If the context needs more memory in this frame, request a larger block next time
+                m_NextMasterBlockSize = std::min(std::max(m_NextMasterBlockSize, static_cast<Uint32>(MasterBlock.Size)) * 2, m_MaxMasterBlockSize);
             }
         }
 
@@ -289,6 +354,10 @@ void VulkanDynamicHeap::ReleaseMasterBlocks(RenderDeviceVkImpl& DeviceVkImpl, Ui
     m_GlobalDynamicMemMgr.ReleaseMasterBlocks(m_MasterBlocks, DeviceVkImpl, CmdQueueMask);
     m_MasterBlocks.clear();
 
+    // Size the first block of the next frame by the memory used in this frame, so that
+    // a context with steady usage locks the global manager only once per frame.
+    m_NextMasterBlockSize = std::min(std::max(AlignUpNonPw2(m_CurrAlignedSize, m_MasterBlockSize), m_MasterBlockSize), m_MaxMasterBlockSize);
+
     m_CurrOffset    = InvalidOffset;
     m_AvailableSize = 0;
 
@@ -27,32 +27,41 @@
 
 #include "pch.h"
 #include "VulkanUploadHeap.hpp"
+
+#include <iomanip>
+
 #include "RenderDeviceVkImpl.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
 
-VulkanUploadHeap::VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
-                                   std::string         HeapName,
-                                   VkDeviceSize        PageSize) :
+VulkanUploadPagePool::VulkanUploadPagePool(RenderDeviceVkImpl& RenderDevice,
+                                           VkDeviceSize        MaxPoolSize,
+                                           VkDeviceSize        PersistentPageSize) :
     // clang-format off
-    m_RenderDevice {RenderDevice       },
-    m_HeapName     {std::move(HeapName)},
-    m_PageSize     {PageSize           }
+    m_RenderDevice      {RenderDevice      },
+    m_MaxPoolSize       {MaxPoolSize       },
+    m_PersistentPageSize{PersistentPageSize}
 // clang-format on
 {
 }
 
-VulkanUploadHeap::~VulkanUploadHeap()
+VulkanUploadPagePool::~VulkanUploadPagePool()
 {
-    DEV_CHECK_ERR(m_Pages.empty(), "Upload heap '", m_HeapName, "' not all pages are released");
-    auto PeakAllocatedPages = m_PeakAllocatedSize / m_PageSize;
-    LOG_INFO_MESSAGE(m_HeapName, " peak used/allocated frame size: ", FormatMemorySize(m_PeakFrameSize, 2, m_PeakAllocatedSize),
-                     " / ", FormatMemorySize(m_PeakAllocatedSize, 2),
-                     " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)"));
+    DEV_CHECK_ERR(m_Pages.empty(), "Upload page pool must be destroyed explicitly by Destroy()");
+}
+
+VkDeviceSize VulkanUploadPagePool::GetSizeClass(VkDeviceSize Size)
+{
+    if (Size <= 4)
+        return Size;
+
+    const VkDeviceSize Pow2 = VkDeviceSize{1} << PlatformMisc::GetMSB(Size);
+    return AlignUp(Size, Pow2 / 4);
 }
 
-VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize SizeInBytes) const
+VulkanUploadPage VulkanUploadPagePool::CreatePage(VkDeviceSize SizeInBytes) const
 {
     VkBufferCreateInfo StagingBufferCI{};
     StagingBufferCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -86,18 +95,169 @@ VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize Si
     (void)err;
     auto CPUAddress = reinterpret_cast<Uint8*>(MemAllocation.Page->GetCPUMemory()) + AlignedOffset;
 
-    return UploadPageInfo{std::move(MemAllocation), std::move(NewBuffer), CPUAddress};
+    return VulkanUploadPage{std::move(MemAllocation), std::move(NewBuffer), CPUAddress, SizeInBytes};
+}
+
+VulkanUploadPage VulkanUploadPagePool::Allocate(VkDeviceSize SizeInBytes)
+{
+    const VkDeviceSize SizeClass = GetSizeClass(SizeInBytes);
+
+    bool CreatePersistentPage = false;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        ++m_Stats.NumRequests;
+
+        // Do not use pages that are more than twice as large as requested
+        auto it = m_Pages.lower_bound(SizeClass);
+        if (it != m_Pages.end() && it->first <= SizeClass * 2)
+        {
+            VulkanUploadPage Page = std::move(it->second);
+            m_Pages.erase(it);
+
+            ++m_Stats.NumHits;
+            m_Stats.PooledSize -= Page.Size;
+            --m_Stats.NumPooledPages;
+            return Page;
+        }
+
+        if (!m_PersistentPageCreated && m_PersistentPageSize >= SizeClass && m_PersistentPageSize <= SizeClass * 2)
+        {
+            m_PersistentPageCreated = true;
+            CreatePersistentPage    = true;
+        }
+
+        m_Stats.CreatedSize += CreatePersistentPage ? m_PersistentPageSize : SizeClass;
+    }
+
+    // Create the page outside of the lock
+    if (CreatePersistentPage)
+    {
+        VulkanUploadPage Page = CreatePage(m_PersistentPageSize);
+        Page.IsPersistent     = true;
+        return Page;
+    }
+
+    return CreatePage(SizeClass);
+}
+
+void VulkanUploadPagePool::Recycle(VulkanUploadPage&& Page)
+{
+    VulkanUploadPage PageToRelease;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (Page.IsPersistent || m_Stats.PooledSize + Page.Size <= m_MaxPoolSize)
+        {
+            m_Stats.PooledSize += Page.Size;
+            m_Stats.PeakPooledSize = std::max(m_Stats.PeakPooledSize, m_Stats.PooledSize);
+            ++m_Stats.NumPooledPages;
+            m_Pages.emplace(Page.Size, std::move(Page));
+            return;
+        }
+        PageToRelease = std::move(Page);
+    }
+    // The GPU is done with the page, so it can be destroyed immediately.
+    // The memory is returned to the global memory manager.
+}
+
+void VulkanUploadPagePool::ReleasePages(std::vector<VulkanUploadPage>& Pages, Uint64 CmdQueueMask)
+{
+    struct StaleUploadPage
+    {
+        VulkanUploadPage      Page;
+        VulkanUploadPagePool* Pool;
+
+        // clang-format off
+        StaleUploadPage(VulkanUploadPage&& _Page, VulkanUploadPagePool* _Pool) noexcept :
+            Page{std::move(_Page)},
+            Pool{_Pool           }
+        {
+        }
+
+        StaleUploadPage            (const StaleUploadPage&)  = delete;
+        StaleUploadPage& operator= (const StaleUploadPage&)  = delete;
+        StaleUploadPage& operator= (      StaleUploadPage&&) = delete;
+
+        StaleUploadPage(StaleUploadPage&& rhs) noexcept :
+            Page{std::move(rhs.Page)},
+            Pool{rhs.Pool           }
+        {
+            rhs.Pool = nullptr;
+        }
+        // clang-format on
+
+        ~StaleUploadPage()
+        {
+            if (Pool != nullptr)
+                Pool->Recycle(std::move(Page));
+        }
+    };
+
+    for (auto& Page : Pages)
+        m_RenderDevice.SafeReleaseDeviceObject(StaleUploadPage{std::move(Page), this}, CmdQueueMask);
+    Pages.clear();
+}
+
+void VulkanUploadPagePool::Destroy()
+{
+    std::multimap<VkDeviceSize, VulkanUploadPage> Pages;
+    Statistics                                    Stats;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        Pages = std::move(m_Pages);
+        m_Pages.clear();
+        Stats                  = m_Stats;
+        m_Stats.NumPooledPages = 0;
+        m_Stats.PooledSize     = 0;
+    }
+
+    if (Stats.NumRequests > 0)
+    {
+        LOG_INFO_MESSAGE("Upload page pool usage stats: ", Stats.NumRequests, " page requests, ",
+                         std::fixed, std::setprecision(1), static_cast<double>(Stats.NumHits) / static_cast<double>(Stats.NumRequests) * 100.0,
+                         "% served by pooled pages. Created pages size: ", FormatMemorySize(Stats.CreatedSize, 2),
+                         ". Peak pooled size: ", FormatMemorySize(Stats.PeakPooledSize, 2));
+    }
+}
+
+VulkanUploadPagePool::Statistics VulkanUploadPagePool::GetStatistics() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Stats;
+}
+
+
+VulkanUploadHeap::VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
+                                   std::string         HeapName,
+                                   VkDeviceSize        PageSize) :
+    // clang-format off
+    m_RenderDevice {RenderDevice       },
+    m_HeapName     {std::move(HeapName)},
+    m_PageSize     {PageSize           }
+// clang-format on
+{
+}
+
+VulkanUploadHeap::~VulkanUploadHeap()
+{
+    DEV_CHECK_ERR(m_Pages.empty(), "Upload heap '", m_HeapName, "' not all pages are released");
+    auto PeakAllocatedPages = m_PeakAllocatedSize / m_PageSize;
+    LOG_INFO_MESSAGE(m_HeapName, " peak used/allocated frame size: ", FormatMemorySize(m_PeakFrameSize, 2, m_PeakAllocatedSize),
+                     " / ", FormatMemorySize(m_PeakAllocatedSize, 2),
+                     " (", PeakAllocatedPages, (PeakAllocatedPages == 1 ? " page)" : " pages)"));
 }
 
 VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDeviceSize Alignment)
 {
     VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of two");
 
+    auto& PagePool = m_RenderDevice.GetUploadPagePool();
+
     VulkanUploadAllocation Allocation;
     if (SizeInBytes >= m_PageSize / 2)
     {
-        // Allocate large chunk directly from the memory manager
-        auto NewPage          = CreateNewPage(SizeInBytes);
+        // Allocate large chunk in its own page
+        auto NewPage          = PagePool.Allocate(SizeInBytes);
         Allocation.vkBuffer   = NewPage.Buffer;
         Allocation.CPUAddress = NewPage.CPUAddress;
         Allocation.Size       = SizeInBytes;
@@ -112,8 +272,8 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
         if (m_CurrPage.AvailableSize < SizeInBytes + AlignmentOffset)
         {
             // Allocate new page
-            auto NewPage = CreateNewPage(m_PageSize);
-            m_CurrPage.Reset(NewPage, m_PageSize);
+            auto NewPage = PagePool.Allocate(m_PageSize);
+            m_CurrPage.Reset(NewPage);
             m_CurrAllocatedSize += NewPage.MemAllocation.Size;
             m_Pages.emplace_back(std::move(NewPage));
             VERIFY_EXPR((m_CurrPage.CurrOffset & (Alignment - 1)) == 0);
@@ -140,13 +300,7 @@ void VulkanUploadHeap::ReleaseAllocatedPages(Uint64 CmdQueueMask)
 {
     // The pages will go into the stale resources queue first, however they will move into the release
     // queue immediately when RenderDeviceVkImpl::FlushStaleResources() is called by the DeviceContextVkImpl::FinishFrame()
-    for (auto& Page : m_Pages)
-    {
-        m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.MemAllocation), CmdQueueMask);
-        m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.Buffer), CmdQueueMask);
-    }
-
-    m_Pages.clear();
+    m_RenderDevice.GetUploadPagePool().ReleasePages(m_Pages, CmdQueueMask);
 
     m_CurrPage          = CurrPageInfo{};
     m_CurrFrameSize     = 0;
@@ -146,6 +146,7 @@ static VkAccessFlags AccessMaskFromImageLayout(VkImageLayout Layout,
 VulkanCommandBuffer::VulkanCommandBuffer() noexcept
 {
     m_ImageBarriers.reserve(32);
+    m_LegacyImageBarriers.reserve(32);
 }
 
 void VulkanCommandBuffer::TransitionImageLayout(VkImage                        Image,
@@ -155,7 +156,7 @@ void VulkanCommandBuffer::TransitionImageLayout(VkImage                        I
                                                 VkPipelineStageFlags           SrcStages,
                                                 VkPipelineStageFlags           DstStages)
 {
-    if (m_State.RenderPass != VK_NULL_HANDLE)
+    if (IsInRenderPass())
     {
         // Image layout transitions within a render pass execute
         // dependencies between attachments
@@ -209,9 +210,11 @@ void VulkanCommandBuffer::TransitionImageLayout(VkImage                        I
     m_Barrier.ImageSrcStages |= SrcStages;
     m_Barrier.ImageDstStages |= DstStages;
 
-    VkImageMemoryBarrier ImgBarrier{};
-    ImgBarrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    VkImageMemoryBarrier2KHR ImgBarrier{};
+    ImgBarrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
     ImgBarrier.pNext               = nullptr;
+    ImgBarrier.srcStageMask        = SrcStages & m_Barrier.SupportedStagesMask;
+    ImgBarrier.dstStageMask        = DstStages & m_Barrier.SupportedStagesMask;
     ImgBarrier.oldLayout           = OldLayout;
     ImgBarrier.newLayout           = NewLayout;
     ImgBarrier.image               = Image;
@@ -228,7 +231,7 @@ void VulkanCommandBuffer::MemoryBarrier(VkAccessFlags        srcAccessMask,
                                         VkPipelineStageFlags SrcStages,
                                         VkPipelineStageFlags DstStages)
 {
-    if (m_State.RenderPass != VK_NULL_HANDLE)
+    if (IsInRenderPass())
     {
         EndRenderPass();
     }
@@ -248,37 +251,91 @@ void VulkanCommandBuffer::FlushBarriers()
     if (m_Barrier.MemorySrcStages == 0 && m_Barrier.MemoryDstStages == 0 && m_ImageBarriers.empty())
         return;
 
-    if (m_State.RenderPass != VK_NULL_HANDLE)
+    if (IsInRenderPass())
     {
         EndRenderPass();
     }
 
     VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
 
-    VkMemoryBarrier vkMemBarrier{};
-    vkMemBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
-    vkMemBarrier.pNext         = nullptr;
-    vkMemBarrier.srcAccessMask = m_Barrier.MemorySrcAccess & m_Barrier.SupportedAccessMask;
-    vkMemBarrier.dstAccessMask = m_Barrier.MemoryDstAccess & m_Barrier.SupportedAccessMask;
-
-    const bool HasMemoryBarrier =
-        m_Barrier.MemorySrcStages != 0 && m_Barrier.MemoryDstStages != 0 &&
-        m_Barrier.MemorySrcAccess != 0 && m_Barrier.MemoryDstAccess != 0;
-
-    const VkPipelineStageFlags SrcStages = (m_Barrier.ImageSrcStages | m_Barrier.MemorySrcStages) & m_Barrier.SupportedStagesMask;
-    const VkPipelineStageFlags DstStages = (m_Barrier.ImageDstStages | m_Barrier.MemoryDstStages) & m_Barrier.SupportedStagesMask;
-    VERIFY_EXPR(SrcStages != 0 && DstStages != 0);
-
-    vkCmdPipelineBarrier(m_VkCmdBuffer,
-                         SrcStages,
-                         DstStages,
-                         0,
-                         HasMemoryBarrier ? 1 : 0,
-                         HasMemoryBarrier ? &vkMemBarrier : nullptr,
-                         0,
-                         nullptr,
-                         static_cast<uint32_t>(m_ImageBarriers.size()),
-                         m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data());
+#if DILIGENT_USE_VOLK
+    if (m_UseSynchronization2)
+    {
+        // Image barriers keep their own stage masks, so that a transition of one resource
+        // does not make the whole batch wait for the stages used by other resources.
+        VkMemoryBarrier2KHR vkMemBarrier{};
+        vkMemBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR;
+        vkMemBarrier.pNext         = nullptr;
+        vkMemBarrier.srcStageMask  = m_Barrier.MemorySrcStages & m_Barrier.SupportedStagesMask;
+        vkMemBarrier.srcAccessMask = m_Barrier.MemorySrcAccess & m_Barrier.SupportedAccessMask;
+        vkMemBarrier.dstStageMask  = m_Barrier.MemoryDstStages & m_Barrier.SupportedStagesMask;
+        vkMemBarrier.dstAccessMask = m_Barrier.MemoryDstAccess & m_Barrier.SupportedAccessMask;
+
+        // Unlike the legacy path, execution-only dependencies require a memory barrier with empty access masks
+        const bool HasMemoryBarrier = m_Barrier.MemorySrcStages != 0 || m_Barrier.MemoryDstStages != 0;
+
+        VkDependencyInfoKHR DependencyInfo{};
+        DependencyInfo.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+        DependencyInfo.pNext                    = nullptr;
+        DependencyInfo.dependencyFlags          = 0;
+        DependencyInfo.memoryBarrierCount       = HasMemoryBarrier ? 1 : 0;
+        DependencyInfo.pMemoryBarriers          = HasMemoryBarrier ? &vkMemBarrier : nullptr;
+        DependencyInfo.bufferMemoryBarrierCount = 0;
+        DependencyInfo.pBufferMemoryBarriers    = nullptr;
+        DependencyInfo.imageMemoryBarrierCount  = static_cast<uint32_t>(m_ImageBarriers.size());
+        DependencyInfo.pImageMemoryBarriers     = m_ImageBarriers.empty() ? nullptr : m_ImageBarriers.data();
+
+        vkCmdPipelineBarrier2KHR(m_VkCmdBuffer, &DependencyInfo);
+    }
+    else
+#endif
+    {
+        VkMemoryBarrier vkMemBarrier{};
+        vkMemBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        vkMemBarrier.pNext         = nullptr;
+        vkMemBarrier.srcAccessMask = m_Barrier.MemorySrcAccess & m_Barrier.SupportedAccessMask;
+        vkMemBarrier.dstAccessMask = m_Barrier.MemoryDstAccess & m_Barrier.SupportedAccessMask;
+
+        const bool HasMemoryBarrier =
+            m_Barrier.MemorySrcStages != 0 && m_Barrier.MemoryDstStages != 0 &&
+            m_Barrier.MemorySrcAccess != 0 && m_Barrier.MemoryDstAccess != 0;
+
+        const VkPipelineStageFlags SrcStages = (m_Barrier.ImageSrcStages | m_Barrier.MemorySrcStages) & m_Barrier.SupportedStagesMask;
+        const VkPipelineStageFlags DstStages = (m_Barrier.ImageDstStages | m_Barrier.MemoryDstStages) & m_Barrier.SupportedStagesMask;
+        VERIFY_EXPR(SrcStages != 0 && DstStages != 0);
+
+        m_LegacyImageBarriers.clear();
+        for (const auto& ImgBarrier2 : m_ImageBarriers)
+        {
+            VkImageMemoryBarrier ImgBarrier{};
+            ImgBarrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            ImgBarrier.pNext               = nullptr;
+            ImgBarrier.srcAccessMask       = static_cast<VkAccessFlags>(ImgBarrier2.srcAccessMask);
+            ImgBarrier.dstAccessMask       = static_cast<VkAccessFlags>(ImgBarrier2.dstAccessMask);
+            ImgBarrier.oldLayout           = ImgBarrier2.oldLayout;
+            ImgBarrier.newLayout           = ImgBarrier2.newLayout;
+            ImgBarrier.srcQueueFamilyIndex = ImgBarrier2.srcQueueFamilyIndex;
+            ImgBarrier.dstQueueFamilyIndex = ImgBarrier2.dstQueueFamilyIndex;
+            ImgBarrier.image               = ImgBarrier2.image;
+            ImgBarrier.subresourceRange    = ImgBarrier2.subresourceRange;
+            m_LegacyImageBarriers.emplace_back(ImgBarrier);
+        }
+
+        vkCmdPipelineBarrier(m_VkCmdBuffer,
+                             SrcStages,
+                             DstStages,
+                             0,
+                             HasMemoryBarrier ? 1 : 0,
+                             HasMemoryBarrier ? &vkMemBarrier : nullptr,
+                             0,
+                             nullptr,
+                             static_cast<uint32_t>(m_LegacyImageBarriers.size()),
+                             m_LegacyImageBarriers.empty() ? nullptr : m_LegacyImageBarriers.data());
+    }
+
+    m_NumBarriers += static_cast<uint32_t>(m_ImageBarriers.size());
+    if (m_Barrier.MemorySrcStages != 0 || m_Barrier.MemoryDstStages != 0)
+        ++m_NumBarriers;
 
     m_ImageBarriers.clear();
     m_Barrier.ImageSrcStages  = 0;
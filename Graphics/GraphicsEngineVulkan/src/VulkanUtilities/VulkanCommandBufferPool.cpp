@@ -59,30 +59,45 @@ VulkanCommandBufferPool::~VulkanCommandBufferPool()
                   "buffers in release queues, VulkanCommandBufferPool::RecycleCommandBuffer() will crash when attempting to "
                   "return the buffer to the pool.");
 
-    for (auto CmdBuff : m_CmdBuffers)
-        m_LogicalDevice->FreeCommandBuffer(m_CmdPool, CmdBuff);
+    for (const auto& CmdBuffers : m_CmdBuffers)
+    {
+        for (auto CmdBuff : CmdBuffers)
+            m_LogicalDevice->FreeCommandBuffer(m_CmdPool, CmdBuff);
+    }
+    for (const auto& CmdBuffers : m_RecycledBuffers)
+    {
+        for (auto CmdBuff : CmdBuffers)
+            m_LogicalDevice->FreeCommandBuffer(m_CmdPool, CmdBuff);
+    }
     m_CmdPool.Release();
 }
 
-VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
+VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName, const VkCommandBufferInheritanceInfo* pInheritanceInfo)
 {
     VkCommandBuffer CmdBuffer = VK_NULL_HANDLE;
 
+    const VkCommandBufferLevel Level      = pInheritanceInfo != nullptr ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    auto&                      CmdBuffers = m_CmdBuffers[Level];
+
+    if (CmdBuffers.empty() && m_NumRecycledBuffers[Level].load(std::memory_order_acquire) != 0)
+    {
+        // Grab all buffers returned by the release queue at once
+        std::lock_guard<std::mutex> Lock{m_RecycledBuffersMtx};
+        CmdBuffers.swap(m_RecycledBuffers[Level]);
+        m_NumRecycledBuffers[Level].store(0, std::memory_order_release);
+    }
+
+    if (!CmdBuffers.empty())
     {
-        std::lock_guard<std::mutex> Lock{m_Mutex};
-
-        if (!m_CmdBuffers.empty())
-        {
-            CmdBuffer = m_CmdBuffers.front();
-            auto err  = vkResetCommandBuffer(
-                CmdBuffer,
-                0 // VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT -  specifies that most or all memory resources currently
-                  // owned by the command buffer should be returned to the parent command pool.
-            );
-            DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to reset command buffer");
-            (void)err;
-            m_CmdBuffers.pop_front();
-        }
+        CmdBuffer = CmdBuffers.back();
+        CmdBuffers.pop_back();
+        auto err = vkResetCommandBuffer(
+            CmdBuffer,
+            0 // VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT -  specifies that most or all memory resources currently
+              // owned by the command buffer should be returned to the parent command pool.
+        );
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to reset command buffer");
+        (void)err;
     }
 
     // If no cmd buffers were ready to be reused, create a new one
@@ -93,7 +108,7 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
         BuffAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         BuffAllocInfo.pNext              = nullptr;
         BuffAllocInfo.commandPool        = m_CmdPool;
-        BuffAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        BuffAllocInfo.level              = Level;
         BuffAllocInfo.commandBufferCount = 1;
 
         CmdBuffer = m_LogicalDevice->AllocateVkCommandBuffer(BuffAllocInfo);
@@ -107,7 +122,12 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
     CmdBuffBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // Each recording of the command buffer will only be
                                                                           // submitted once, and the command buffer will be reset
                                                                           // and recorded again between each submission.
-    CmdBuffBeginInfo.pInheritanceInfo = nullptr;                          // Ignored for a primary command buffer
+    CmdBuffBeginInfo.pInheritanceInfo = pInheritanceInfo;                 // Ignored for a primary command buffer
+    if (pInheritanceInfo != nullptr && pInheritanceInfo->renderPass != VK_NULL_HANDLE)
+    {
+        // The secondary command buffer will be entirely inside a render pass (6.6)
+        CmdBuffBeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    }
 
     auto err = vkBeginCommandBuffer(CmdBuffer, &CmdBuffBeginInfo);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to begin command buffer");
@@ -118,10 +138,14 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
     return CmdBuffer;
 }
 
-void VulkanCommandBufferPool::RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer)
+void VulkanCommandBufferPool::RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer, VkCommandBufferLevel Level)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
-    m_CmdBuffers.emplace_back(CmdBuffer);
+    VERIFY_EXPR(static_cast<size_t>(Level) < NumLevels);
+    {
+        std::lock_guard<std::mutex> Lock{m_RecycledBuffersMtx};
+        m_RecycledBuffers[Level].emplace_back(CmdBuffer);
+        m_NumRecycledBuffers[Level].store(m_RecycledBuffers[Level].size(), std::memory_order_release);
+    }
     CmdBuffer = VK_NULL_HANDLE;
 #ifdef DILIGENT_DEVELOPMENT
     --m_BuffCounter;
@@ -590,11 +590,41 @@ VulkanInstance::VulkanInstance(const CreateInfo& CI) :
         CHECK_VK_ERROR(err, "Failed to enumerate physical devices");
         VERIFY_EXPR(m_PhysicalDevices.size() == PhysicalDeviceCount);
     }
+
+    // Enumerate physical device groups
+    if (m_VkVersion >= VK_API_VERSION_1_1)
+    {
+        uint32_t PhysicalDeviceGroupCount = 0;
+        auto     err                      = vkEnumeratePhysicalDeviceGroups(m_VkInstance, &PhysicalDeviceGroupCount, nullptr);
+        if (err == VK_SUCCESS && PhysicalDeviceGroupCount > 0)
+        {
+            m_PhysicalDeviceGroups.resize(PhysicalDeviceGroupCount, VkPhysicalDeviceGroupProperties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GROUP_PROPERTIES});
+            err = vkEnumeratePhysicalDeviceGroups(m_VkInstance, &PhysicalDeviceGroupCount, m_PhysicalDeviceGroups.data());
+            if (err != VK_SUCCESS)
+            {
+                LOG_WARNING_MESSAGE("Failed to enumerate physical device groups");
+                m_PhysicalDeviceGroups.clear();
+            }
+        }
+    }
 #if !DILIGENT_NO_GLSLANG
-    Diligent::GLSLangUtils::InitializeGlslang();
+    Diligent::GLSLangUtils::InitializeGlslang(CI.DeferGlslangInit);
 #endif
 }
 
+uint32_t VulkanInstance::GetPhysicalDeviceGroupSize(VkPhysicalDevice vkDevice) const
+{
+    for (const auto& Group : m_PhysicalDeviceGroups)
+    {
+        for (uint32_t i = 0; i < Group.physicalDeviceCount; ++i)
+        {
+            if (Group.physicalDevices[i] == vkDevice)
+                return Group.physicalDeviceCount;
+        }
+    }
+    return 1;
+}
+
 VulkanInstance::~VulkanInstance()
 {
     if (m_DebugMode != DebugMode::Disabled)
@@ -30,6 +30,7 @@
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanDebug.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 namespace VulkanUtilities
 {
@@ -49,7 +50,8 @@ VulkanLogicalDevice::VulkanLogicalDevice(const CreateInfo& CI) :
     m_VkDevice{CI.vkDevice},
     m_VkAllocator{CI.vkAllocator},
     m_EnabledFeatures{CI.EnabledFeatures},
-    m_EnabledExtFeatures{CI.EnabledExtFeatures}
+    m_EnabledExtFeatures{CI.EnabledExtFeatures},
+    m_TimestampPeriod{CI.PhysicalDevice.GetProperties().limits.timestampPeriod}
 {
 #if DILIGENT_USE_VOLK
     // Since we only use one device at this time, load device function entries
@@ -99,6 +101,12 @@ VulkanLogicalDevice::VulkanLogicalDevice(const CreateInfo& CI) :
         ComputeStages |= VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
         ComputeAccessMask |= VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
     }
+    if (m_EnabledExtFeatures.ConditionalRendering.conditionalRendering != VK_FALSE)
+    {
+        // Conditional rendering applies to draw and dispatch commands
+        ComputeStages |= VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT;
+        ComputeAccessMask |= VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT;
+    }
     if (m_EnabledExtFeatures.ShadingRate.attachmentFragmentShadingRate != VK_FALSE)
     {
         GraphicsStages |= VK_PIPELINE_STAGE_FRAGMENT_SHADING_RATE_ATTACHMENT_BIT_KHR;
@@ -273,7 +281,15 @@ PipelineWrapper VulkanLogicalDevice::CreateComputePipeline(const VkComputePipeli
 
     VkPipeline vkPipeline = VK_NULL_HANDLE;
 
+    ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+
     auto err = vkCreateComputePipelines(m_VkDevice, cache, 1, &PipelineCI, m_VkAllocator, &vkPipeline);
+    if (err == VK_PIPELINE_COMPILE_REQUIRED_EXT && (PipelineCI.flags & VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT) != 0)
+    {
+        // The pipeline was not found in the cache. This is not an error: the caller will create the pipeline
+        // without the VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT flag.
+        return PipelineWrapper{};
+    }
     CHECK_VK_ERROR_AND_THROW(err, "Failed to create compute pipeline '", DebugName, '\'');
 
     if (*DebugName != 0)
@@ -293,7 +309,14 @@ PipelineWrapper VulkanLogicalDevice::CreateGraphicsPipeline(const VkGraphicsPipe
 
     VkPipeline vkPipeline = VK_NULL_HANDLE;
 
+    ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+
     auto err = vkCreateGraphicsPipelines(m_VkDevice, cache, 1, &PipelineCI, m_VkAllocator, &vkPipeline);
+    if (err == VK_PIPELINE_COMPILE_REQUIRED_EXT && (PipelineCI.flags & VK_PIPELINE_CREATE_FAIL_ON_PIPELINE_COMPILE_REQUIRED_BIT_EXT) != 0)
+    {
+        // See CreateComputePipeline()
+        return PipelineWrapper{};
+    }
     CHECK_VK_ERROR_AND_THROW(err, "Failed to create graphics pipeline '", DebugName, '\'');
 
     if (*DebugName != 0)
@@ -312,6 +335,8 @@ PipelineWrapper VulkanLogicalDevice::CreateRayTracingPipeline(const VkRayTracing
 
     VkPipeline vkPipeline = VK_NULL_HANDLE;
 
+    ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+
     auto err = vkCreateRayTracingPipelinesKHR(m_VkDevice, VK_NULL_HANDLE, cache, 1, &PipelineCI, m_VkAllocator, &vkPipeline);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to create ray tracing pipeline '", DebugName, '\'');
 
@@ -328,6 +353,7 @@ PipelineWrapper VulkanLogicalDevice::CreateRayTracingPipeline(const VkRayTracing
 ShaderModuleWrapper VulkanLogicalDevice::CreateShaderModule(const VkShaderModuleCreateInfo& ShaderModuleCI, const char* DebugName) const
 {
     VERIFY_EXPR(ShaderModuleCI.sType == VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO);
+    ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
     return CreateVulkanObject<VkShaderModule, VulkanHandleTypeId::ShaderModule>(vkCreateShaderModule, ShaderModuleCI, DebugName, "shader module");
 }
 
@@ -361,7 +387,7 @@ SemaphoreWrapper VulkanLogicalDevice::CreateSemaphore(const VkSemaphoreCreateInf
     return CreateVulkanObject<VkSemaphore, VulkanHandleTypeId::Semaphore>(vkCreateSemaphore, SemaphoreCI, DebugName, "semaphore");
 }
 
-SemaphoreWrapper VulkanLogicalDevice::CreateTimelineSemaphore(uint64_t InitialValue, const char* DebugName) const
+SemaphoreWrapper VulkanLogicalDevice::CreateTimelineSemaphore(uint64_t InitialValue, const char* DebugName, bool Exportable) const
 {
     VERIFY_EXPR(m_EnabledExtFeatures.TimelineSemaphore.timelineSemaphore == VK_TRUE);
 
@@ -374,6 +400,15 @@ SemaphoreWrapper VulkanLogicalDevice::CreateTimelineSemaphore(uint64_t InitialVa
     SemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
     SemaphoreCI.pNext = &TimelineCI;
 
+    VkExportSemaphoreCreateInfo ExportCI{};
+    if (Exportable)
+    {
+        VERIFY(m_EnabledExtFeatures.ExternalSemaphore, "External semaphore extension is not enabled");
+        ExportCI.sType       = VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO;
+        ExportCI.handleTypes = VulkanPhysicalDevice::ExternalSemaphoreHandleType;
+        TimelineCI.pNext     = &ExportCI;
+    }
+
     return CreateVulkanObject<VkSemaphore, VulkanHandleTypeId::Semaphore>(vkCreateSemaphore, SemaphoreCI, DebugName, "timeline semaphore");
 }
 
@@ -585,6 +620,56 @@ VkMemoryRequirements VulkanLogicalDevice::GetImageMemoryRequirements(VkImage vkI
     return MemReqs;
 }
 
+VkMemoryRequirements VulkanLogicalDevice::GetBufferMemoryRequirements(VkBuffer vkBuffer, bool& PrefersDedicated) const
+{
+    PrefersDedicated = false;
+#if DILIGENT_USE_VOLK
+    if (m_EnabledExtFeatures.DedicatedAllocation)
+    {
+        VkMemoryDedicatedRequirements DedicatedReqs{};
+        DedicatedReqs.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+        VkMemoryRequirements2 MemReqs2{};
+        MemReqs2.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        MemReqs2.pNext = &DedicatedReqs;
+
+        VkBufferMemoryRequirementsInfo2 ReqsInfo{};
+        ReqsInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+        ReqsInfo.buffer = vkBuffer;
+        vkGetBufferMemoryRequirements2KHR(m_VkDevice, &ReqsInfo, &MemReqs2);
+
+        PrefersDedicated = DedicatedReqs.prefersDedicatedAllocation != VK_FALSE || DedicatedReqs.requiresDedicatedAllocation != VK_FALSE;
+        return MemReqs2.memoryRequirements;
+    }
+#endif
+    return GetBufferMemoryRequirements(vkBuffer);
+}
+
+VkMemoryRequirements VulkanLogicalDevice::GetImageMemoryRequirements(VkImage vkImage, bool& PrefersDedicated) const
+{
+    PrefersDedicated = false;
+#if DILIGENT_USE_VOLK
+    if (m_EnabledExtFeatures.DedicatedAllocation)
+    {
+        VkMemoryDedicatedRequirements DedicatedReqs{};
+        DedicatedReqs.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+        VkMemoryRequirements2 MemReqs2{};
+        MemReqs2.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        MemReqs2.pNext = &DedicatedReqs;
+
+        VkImageMemoryRequirementsInfo2 ReqsInfo{};
+        ReqsInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+        ReqsInfo.image = vkImage;
+        vkGetImageMemoryRequirements2KHR(m_VkDevice, &ReqsInfo, &MemReqs2);
+
+        PrefersDedicated = DedicatedReqs.prefersDedicatedAllocation != VK_FALSE || DedicatedReqs.requiresDedicatedAllocation != VK_FALSE;
+        return MemReqs2.memoryRequirements;
+    }
+#endif
+    return GetImageMemoryRequirements(vkImage);
+}
+
 VkResult VulkanLogicalDevice::BindBufferMemory(VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) const
 {
     return vkBindBufferMemory(m_VkDevice, buffer, memory, memoryOffset);
@@ -610,6 +695,54 @@ VkDeviceAddress VulkanLogicalDevice::GetAccelerationStructureDeviceAddress(VkAcc
 #endif
 }
 
+VkDeviceAddress VulkanLogicalDevice::GetBufferDeviceAddress(VkBuffer vkBuffer) const
+{
+#if DILIGENT_USE_VOLK
+    VkBufferDeviceAddressInfoKHR BufferInfo = {};
+
+    BufferInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+    BufferInfo.buffer = vkBuffer;
+
+    return vkGetBufferDeviceAddressKHR(m_VkDevice, &BufferInfo);
+#else
+    UNSUPPORTED("vkGetBufferDeviceAddressKHR is only available through Volk");
+    return VkDeviceAddress{};
+#endif
+}
+
+VkDeviceSize VulkanLogicalDevice::GetDescriptorSetLayoutSize(VkDescriptorSetLayout Layout) const
+{
+#if DILIGENT_USE_VOLK
+    VkDeviceSize Size = 0;
+    vkGetDescriptorSetLayoutSizeEXT(m_VkDevice, Layout, &Size);
+    return Size;
+#else
+    UNSUPPORTED("vkGetDescriptorSetLayoutSizeEXT is only available through Volk");
+    return 0;
+#endif
+}
+
+VkDeviceSize VulkanLogicalDevice::GetDescriptorSetLayoutBindingOffset(VkDescriptorSetLayout Layout, uint32_t Binding) const
+{
+#if DILIGENT_USE_VOLK
+    VkDeviceSize Offset = 0;
+    vkGetDescriptorSetLayoutBindingOffsetEXT(m_VkDevice, Layout, Binding, &Offset);
+    return Offset;
+#else
+    UNSUPPORTED("vkGetDescriptorSetLayoutBindingOffsetEXT is only available through Volk");
+    return 0;
+#endif
+}
+
+void VulkanLogicalDevice::GetDescriptor(const VkDescriptorGetInfoEXT& DescriptorInfo, size_t DataSize, void* pDescriptor) const
+{
+#if DILIGENT_USE_VOLK
+    vkGetDescriptorEXT(m_VkDevice, &DescriptorInfo, DataSize, pDescriptor);
+#else
+    UNSUPPORTED("vkGetDescriptorEXT is only available through Volk");
+#endif
+}
+
 void VulkanLogicalDevice::GetAccelerationStructureBuildSizes(const VkAccelerationStructureBuildGeometryInfoKHR& BuildInfo, const uint32_t* pMaxPrimitiveCounts, VkAccelerationStructureBuildSizesInfoKHR& SizeInfo) const
 {
 #if DILIGENT_USE_VOLK
@@ -726,6 +859,79 @@ void VulkanLogicalDevice::ResetQueryPool(VkQueryPool queryPool,
 #endif
 }
 
+VkResult VulkanLogicalDevice::GetCalibratedTimestamps(uint32_t                            TimestampCount,
+                                                      const VkCalibratedTimestampInfoEXT* pTimestampInfos,
+                                                      uint64_t*                           pTimestamps,
+                                                      uint64_t*                           pMaxDeviation) const
+{
+#if DILIGENT_USE_VOLK
+    VERIFY(m_EnabledExtFeatures.CalibratedTimestamps, "Calibrated timestamps extension is not enabled");
+    return vkGetCalibratedTimestampsEXT(m_VkDevice, TimestampCount, pTimestampInfos, pTimestamps, pMaxDeviation);
+#else
+    UNSUPPORTED("vkGetCalibratedTimestampsEXT is only available through Volk");
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+#endif
+}
+
+VkResult VulkanLogicalDevice::GetMemoryHandle(VkDeviceMemory vkMemory, uint64_t& Handle) const
+{
+#if DILIGENT_USE_VOLK
+    VERIFY(m_EnabledExtFeatures.ExternalMemory, "External memory extension is not enabled");
+#    if defined(VK_USE_PLATFORM_WIN32_KHR)
+    VkMemoryGetWin32HandleInfoKHR HandleInfo{};
+    HandleInfo.sType      = VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR;
+    HandleInfo.memory     = vkMemory;
+    HandleInfo.handleType = VulkanPhysicalDevice::ExternalMemoryHandleType;
+
+    HANDLE   hMemory = NULL;
+    VkResult err     = vkGetMemoryWin32HandleKHR(m_VkDevice, &HandleInfo, &hMemory);
+    Handle           = reinterpret_cast<uint64_t>(hMemory);
+#    else
+    VkMemoryGetFdInfoKHR HandleInfo{};
+    HandleInfo.sType      = VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR;
+    HandleInfo.memory     = vkMemory;
+    HandleInfo.handleType = VulkanPhysicalDevice::ExternalMemoryHandleType;
+
+    int      Fd  = -1;
+    VkResult err = vkGetMemoryFdKHR(m_VkDevice, &HandleInfo, &Fd);
+    Handle       = static_cast<uint64_t>(Fd);
+#    endif
+    return err;
+#else
+    UNSUPPORTED("External memory functions are only available through Volk");
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+#endif
+}
+
+VkResult VulkanLogicalDevice::GetSemaphoreHandle(VkSemaphore vkSemaphore, uint64_t& Handle) const
+{
+#if DILIGENT_USE_VOLK
+    VERIFY(m_EnabledExtFeatures.ExternalSemaphore, "External semaphore extension is not enabled");
+#    if defined(VK_USE_PLATFORM_WIN32_KHR)
+    VkSemaphoreGetWin32HandleInfoKHR HandleInfo{};
+    HandleInfo.sType      = VK_STRUCTURE_TYPE_SEMAPHORE_GET_WIN32_HANDLE_INFO_KHR;
+    HandleInfo.semaphore  = vkSemaphore;
+    HandleInfo.handleType = VulkanPhysicalDevice::ExternalSemaphoreHandleType;
+
+    HANDLE   hSemaphore = NULL;
+    VkResult err        = vkGetSemaphoreWin32HandleKHR(m_VkDevice, &HandleInfo, &hSemaphore);
+    Handle              = reinterpret_cast<uint64_t>(hSemaphore);
+#    else
+    VkSemaphoreGetFdInfoKHR HandleInfo{};
+    HandleInfo.sType      = VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR;
+    HandleInfo.semaphore  = vkSemaphore;
+    HandleInfo.handleType = VulkanPhysicalDevice::ExternalSemaphoreHandleType;
+
+    int      Fd  = -1;
+    VkResult err = vkGetSemaphoreFdKHR(m_VkDevice, &HandleInfo, &Fd);
+    Handle       = static_cast<uint64_t>(Fd);
+#    endif
+    return err;
+#else
+    UNSUPPORTED("External semaphore functions are only available through Volk");
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+#endif
+}
 
 VkResult VulkanLogicalDevice::GetRayTracingShaderGroupHandles(VkPipeline pipeline, uint32_t firstGroup, uint32_t groupCount, size_t dataSize, void* pData) const
 {
@@ -737,4 +943,15 @@ VkResult VulkanLogicalDevice::GetRayTracingShaderGroupHandles(VkPipeline pipelin
 #endif
 }
 
+void VulkanLogicalDevice::GetShaderModuleIdentifier(VkShaderModule vkModule, VkShaderModuleIdentifierEXT& Identifier) const
+{
+    VERIFY_EXPR(Identifier.sType == VK_STRUCTURE_TYPE_SHADER_MODULE_IDENTIFIER_EXT);
+#if DILIGENT_USE_VOLK
+    vkGetShaderModuleIdentifierEXT(m_VkDevice, vkModule, &Identifier);
+#else
+    UNSUPPORTED("vkGetShaderModuleIdentifierEXT is only available through Volk");
+    Identifier.identifierSize = 0;
+#endif
+}
+
 } // namespace VulkanUtilities
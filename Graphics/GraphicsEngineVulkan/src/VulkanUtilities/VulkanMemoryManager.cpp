@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include <sstream>
+#include <algorithm>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 
 namespace VulkanUtilities
@@ -40,37 +41,74 @@ VulkanMemoryAllocation::~VulkanMemoryAllocation()
     }
 }
 
-VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
-                                   VkDeviceSize          PageSize,
-                                   uint32_t              MemoryTypeIndex,
-                                   bool                  IsHostVisible,
-                                   VkMemoryAllocateFlags AllocateFlags) :
+VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&                 ParentMemoryMgr,
+                                   VkDeviceSize                         PageSize,
+                                   uint32_t                             MemoryTypeIndex,
+                                   bool                                 IsHostVisible,
+                                   VkMemoryAllocateFlags                AllocateFlags,
+                                   const VulkanDedicatedAllocationInfo* pDedicatedInfo) :
     // clang-format off
     m_ParentMemoryMgr{ParentMemoryMgr},
-    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator},
+    m_MemoryTypeIndex{MemoryTypeIndex},
+    m_IsDedicated    {pDedicatedInfo != nullptr}
 // clang-format on
 {
     VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "PageSize (", PageSize, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
 
-    VkMemoryAllocateInfo      MemAlloc    = {};
-    VkMemoryAllocateFlagsInfo MemFlagInfo = {};
+    VkMemoryAllocateInfo          MemAlloc      = {};
+    VkMemoryAllocateFlagsInfo     MemFlagInfo   = {};
+    VkMemoryDedicatedAllocateInfo DedicatedInfo = {};
+    VkExportMemoryAllocateInfo    ExportInfo    = {};
 
     MemAlloc.pNext           = nullptr;
     MemAlloc.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     MemAlloc.allocationSize  = PageSize;
     MemAlloc.memoryTypeIndex = MemoryTypeIndex;
 
+    const void** NextInfo = &MemAlloc.pNext;
     if (AllocateFlags)
     {
-        MemAlloc.pNext    = &MemFlagInfo;
         MemFlagInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
         MemFlagInfo.pNext = nullptr;
         MemFlagInfo.flags = AllocateFlags;
+
+        *NextInfo = &MemFlagInfo;
+        NextInfo  = &MemFlagInfo.pNext;
+    }
+
+    if (pDedicatedInfo != nullptr &&
+        (pDedicatedInfo->Image != VK_NULL_HANDLE || pDedicatedInfo->Buffer != VK_NULL_HANDLE) &&
+        ParentMemoryMgr.m_LogicalDevice.GetEnabledExtFeatures().DedicatedAllocation)
+    {
+        VERIFY(pDedicatedInfo->Image == VK_NULL_HANDLE || pDedicatedInfo->Buffer == VK_NULL_HANDLE,
+               "Dedicated allocation can't be made for an image and a buffer at the same time");
+
+        DedicatedInfo.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+        DedicatedInfo.pNext  = nullptr;
+        DedicatedInfo.image  = pDedicatedInfo->Image;
+        DedicatedInfo.buffer = pDedicatedInfo->Buffer;
+
+        *NextInfo = &DedicatedInfo;
+        NextInfo  = &DedicatedInfo.pNext;
+    }
+
+    if (pDedicatedInfo != nullptr && pDedicatedInfo->ExportHandleTypes != 0)
+    {
+        VERIFY(ParentMemoryMgr.m_LogicalDevice.GetEnabledExtFeatures().ExternalMemory, "External memory extension is not enabled");
+
+        ExportInfo.sType       = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO;
+        ExportInfo.pNext       = nullptr;
+        ExportInfo.handleTypes = pDedicatedInfo->ExportHandleTypes;
+
+        *NextInfo = &ExportInfo;
+        NextInfo  = &ExportInfo.pNext;
     }
 
-    auto MemoryName = Diligent::FormatString("Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
+    auto MemoryName = Diligent::FormatString(m_IsDedicated ? "Dedicated device memory page. Size: " : "Device memory page. Size: ",
+                                             Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
     m_VkMemory      = ParentMemoryMgr.m_LogicalDevice.AllocateDeviceMemory(MemAlloc, MemoryName.c_str());
 
     if (IsHostVisible)
@@ -126,7 +164,10 @@ void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
     Allocation = VulkanMemoryAllocation{};
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags)
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&          MemReqs,
+                                                     VkMemoryPropertyFlags                MemoryProps,
+                                                     VkMemoryAllocateFlags                AllocateFlags,
+                                                     const VulkanDedicatedAllocationInfo* pDedicatedInfo)
 {
     // memoryTypeBits is a bitmask and contains one bit set for every supported memory type for the resource.
     // Bit i is set if the memory type i in the VkPhysicalDeviceMemoryProperties structure for the
@@ -155,10 +196,167 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
     }
 
     bool HostVisible = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
-    return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags);
+    if (MemoryProps == VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+    {
+        // When the device-local heap is exhausted or its budget would be exceeded, fall back to
+        // the memory the device accesses over the bus rather than failing the allocation.
+        const uint32_t FallbackTypeIndex = GetFallbackMemoryTypeIndex(MemReqs.memoryTypeBits, MemoryTypeIndex);
+        if (FallbackTypeIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+        {
+            VulkanMemoryAllocation Allocation;
+            try
+            {
+                Allocation = AllocateImpl(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags, pDedicatedInfo, /*RespectBudget = */ true);
+            }
+            catch (...)
+            {
+            }
+
+            if (Allocation)
+                return Allocation;
+
+            LOG_WARNING_MESSAGE("VulkanMemoryManager '", m_MgrName, "': failed to allocate ", Diligent::FormatMemorySize(MemReqs.size, 2),
+                                " of device-local memory (type idx: ", MemoryTypeIndex, "). Falling back to memory type ", FallbackTypeIndex,
+                                ", which may reduce performance.");
+            MemoryTypeIndex = FallbackTypeIndex;
+        }
+    }
+
+    return AllocateImpl(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags, pDedicatedInfo, /*RespectBudget = */ false);
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
+uint32_t VulkanMemoryManager::GetFallbackMemoryTypeIndex(uint32_t MemoryTypeBits, uint32_t MemoryTypeIndex) const
+{
+    const auto& MemProps = m_PhysicalDevice.GetMemoryProperties();
+    VERIFY_EXPR(MemoryTypeIndex < MemProps.memoryTypeCount);
+    const uint32_t HeapIndex = MemProps.memoryTypes[MemoryTypeIndex].heapIndex;
+
+    for (uint32_t i = 0; i < MemProps.memoryTypeCount; ++i)
+    {
+        if ((MemoryTypeBits & (1u << i)) == 0)
+            continue;
+
+        const auto& MemType = MemProps.memoryTypes[i];
+        if (MemType.heapIndex != HeapIndex && (MemProps.memoryHeaps[MemType.heapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0)
+            return i;
+    }
+
+    // On integrated GPUs, all memory types may share the same heap
+    return VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex;
+}
+
+void VulkanMemoryManager::GetHeapBudget(uint32_t HeapIndex, VkDeviceSize& Budget, VkDeviceSize& Usage) const
+{
+    const auto& MemProps = m_PhysicalDevice.GetMemoryProperties();
+    VERIFY_EXPR(HeapIndex < MemProps.memoryHeapCount);
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT BudgetProps{};
+    if (m_LogicalDevice.GetEnabledExtFeatures().MemoryBudget && m_PhysicalDevice.GetMemoryBudget(BudgetProps))
+    {
+        Budget = BudgetProps.heapBudget[HeapIndex];
+        Usage  = BudgetProps.heapUsage[HeapIndex];
+    }
+    else
+    {
+        Budget = MemProps.memoryHeaps[HeapIndex].size;
+        Usage  = GetHeapAllocatedSize(HeapIndex);
+    }
+}
+
+void VulkanMemoryManager::SetBudgetCallback(BudgetCallbackType Callback, float Threshold)
+{
+    DEV_CHECK_ERR(Callback == nullptr || (Threshold > 0 && Threshold <= 1), "Budget threshold (", Threshold, ") must be in (0, 1] range");
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    m_BudgetCallback  = std::move(Callback);
+    m_BudgetThreshold = Threshold;
+    m_HeapOverThreshold.fill(false);
+}
+
+bool VulkanMemoryManager::UpdateHeapBudgetState(uint32_t HeapIndex)
+{
+    if (!m_BudgetCallback)
+        return false;
+
+    VkDeviceSize Budget = 0;
+    VkDeviceSize Usage  = 0;
+    GetHeapBudget(HeapIndex, Budget, Usage);
+
+    const bool IsOverThreshold = static_cast<double>(Usage) >= static_cast<double>(Budget) * m_BudgetThreshold;
+    const bool NotifyCallback  = IsOverThreshold && !m_HeapOverThreshold[HeapIndex];
+
+    m_HeapOverThreshold[HeapIndex] = IsOverThreshold;
+    return NotifyCallback;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize                         Size,
+                                                     VkDeviceSize                         Alignment,
+                                                     uint32_t                             MemoryTypeIndex,
+                                                     bool                                 HostVisible,
+                                                     VkMemoryAllocateFlags                AllocateFlags,
+                                                     const VulkanDedicatedAllocationInfo* pDedicatedInfo)
+{
+    return AllocateImpl(Size, Alignment, MemoryTypeIndex, HostVisible, AllocateFlags, pDedicatedInfo, /*RespectBudget = */ false);
+}
+
+VkDeviceSize VulkanMemoryManager::GetPageSize(uint32_t MemoryTypeIndex, bool HostVisible) const
+{
+    VERIFY_EXPR(MemoryTypeIndex < m_Policy.MemoryTypePageSize.size());
+    if (m_Policy.MemoryTypePageSize[MemoryTypeIndex] != 0)
+        return m_Policy.MemoryTypePageSize[MemoryTypeIndex];
+
+    return HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
+}
+
+bool VulkanMemoryManager::UseDedicatedPage(VkDeviceSize Size, const VulkanDedicatedAllocationInfo* pDedicatedInfo) const
+{
+    if (pDedicatedInfo == nullptr)
+        return false;
+
+    // Exported memory must not be shared with other resources
+    if (pDedicatedInfo->ExportHandleTypes != 0)
+        return true;
+
+    if (pDedicatedInfo->PrefersDedicated && m_LogicalDevice.GetEnabledExtFeatures().DedicatedAllocation)
+        return true;
+
+    return m_Policy.DedicatedAllocationThreshold != 0 && Size >= m_Policy.DedicatedAllocationThreshold;
+}
+
+VkDeviceSize VulkanMemoryManager::GetSizeClass(VkDeviceSize Size, VkDeviceSize Alignment) const
+{
+    if (m_Policy.SmallAllocationMaxSize == 0 || Size > m_Policy.SmallAllocationMaxSize)
+        return 0;
+
+    // All allocations in a size-class page have the same power-of-two size that is
+    // not smaller than the alignment, so the page never requires alignment padding.
+    constexpr VkDeviceSize MinSizeClass = 256;
+
+    VkDeviceSize SizeClass = MinSizeClass;
+    while (SizeClass < Size || SizeClass < Alignment)
+        SizeClass *= 2;
+
+    return SizeClass <= m_Policy.SmallAllocationMaxSize ? SizeClass : 0;
+}
+
+bool VulkanMemoryManager::CheckHeapBudget(uint32_t HeapIndex, VkDeviceSize PageSize) const
+{
+    if (!m_LogicalDevice.GetEnabledExtFeatures().MemoryBudget)
+        return true;
+
+    VkDeviceSize Budget = 0;
+    VkDeviceSize Usage  = 0;
+    GetHeapBudget(HeapIndex, Budget, Usage);
+    return Usage + PageSize <= Budget;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateImpl(VkDeviceSize                         Size,
+                                                         VkDeviceSize                         Alignment,
+                                                         uint32_t                             MemoryTypeIndex,
+                                                         bool                                 HostVisible,
+                                                         VkMemoryAllocateFlags                AllocateFlags,
+                                                         const VulkanDedicatedAllocationInfo* pDedicatedInfo,
+                                                         bool                                 RespectBudget)
 {
     VulkanMemoryAllocation Allocation;
 
@@ -169,53 +367,142 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     // even though on integrated GPUs same pages can be used for both GPU-only and staging
     // allocations. Staging allocations are short-living and will be released when upload is
     // complete, while GPU-only allocations are expected to be long-living.
-    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
-
-    auto range = m_Pages.equal_range(PageIdx);
-    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    //
+    // Large allocations get their own page, while small allocations are suballocated from
+    // pages that only contain allocations of the same size class. This keeps the shared
+    // pages from being fragmented.
+    const bool         UseDedicated = UseDedicatedPage(Size, pDedicatedInfo);
+    const VkDeviceSize SizeClass    = UseDedicated ? 0 : GetSizeClass(Size, Alignment);
+    if (SizeClass != 0)
     {
-        Allocation = page_it->second.Allocate(Size, Alignment);
-        if (Allocation.Page != nullptr)
-            break;
+        VERIFY_EXPR(SizeClass >= Size && SizeClass >= Alignment);
+        Size = SizeClass;
     }
 
-    size_t stat_ind = HostVisible ? 1 : 0;
-    if (Allocation.Page == nullptr)
-    {
-        auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
-        while (PageSize < Size)
-            PageSize *= 2;
-
-        m_CurrAllocatedSize[stat_ind] += PageSize;
-        m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
-
-        auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags});
-        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
-                         " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
-                         "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
-        OnNewPageCreated(it->second);
-        Allocation = it->second.Allocate(Size, Alignment);
-        DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
-    }
+    MemoryPageIndex PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags, SizeClass};
 
-    if (Allocation.Page != nullptr)
+    const uint32_t     HeapIndex = m_PhysicalDevice.GetMemoryProperties().memoryTypes[MemoryTypeIndex].heapIndex;
+    BudgetCallbackType BudgetCallback;
     {
-        VERIFY_EXPR(Size + Diligent::AlignUp(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
+        std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+        if (!UseDedicated)
+        {
+            auto range = m_Pages.equal_range(PageIdx);
+            for (auto page_it = range.first; page_it != range.second; ++page_it)
+            {
+                if (page_it->second.m_IsEvacuating)
+                    continue;
+
+                Allocation = page_it->second.Allocate(Size, Alignment);
+                if (Allocation.Page != nullptr)
+                    break;
+            }
+        }
+
+        size_t stat_ind = HostVisible ? 1 : 0;
+        if (Allocation.Page == nullptr)
+        {
+            // Dedicated pages are allocated with the exact size of the resource
+            auto PageSize = Size;
+            if (!UseDedicated)
+            {
+                PageSize = (SizeClass != 0 && m_Policy.SmallAllocationPageSize != 0) ?
+                    m_Policy.SmallAllocationPageSize :
+                    GetPageSize(MemoryTypeIndex, HostVisible);
+                while (PageSize < Size)
+                    PageSize *= 2;
+            }
+
+            if (RespectBudget && !CheckHeapBudget(HeapIndex, PageSize))
+                return {};
+
+            VulkanMemoryPage* pPage = nullptr;
+            if (UseDedicated)
+            {
+                m_DedicatedPages.emplace_back(*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags, pDedicatedInfo);
+                pPage = &m_DedicatedPages.back();
+            }
+            else
+            {
+                auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags});
+                pPage   = &it->second;
+            }
+
+            m_CurrAllocatedSize[stat_ind] += PageSize;
+            m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
+            m_HeapAllocatedSize[HeapIndex].fetch_add(PageSize);
+
+            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (UseDedicated ? "dedicated " : ""), (HostVisible ? "host-visible" : "device-local"),
+                             " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
+                             "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
+            OnNewPageCreated(*pPage);
+            // Dedicated page has the exact size of the allocation and its offset is zero,
+            // so it always satisfies the alignment.
+            Allocation = pPage->Allocate(Size, UseDedicated ? 1 : Alignment);
+            DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+
+            if (UpdateHeapBudgetState(HeapIndex))
+                BudgetCallback = m_BudgetCallback;
+        }
+
+        if (Allocation.Page != nullptr)
+        {
+            VERIFY_EXPR(Size + Diligent::AlignUp(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
+        }
+
+        m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
+        m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
     }
 
-    m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
-    m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+    // Call the callback outside of the lock as it may release resources
+    if (BudgetCallback)
+        BudgetCallback(HeapIndex);
 
     return Allocation;
 }
 
+void VulkanMemoryManager::DestroyPage(VulkanMemoryPage& Page)
+{
+    const bool     IsHostVisible = Page.GetCPUMemory() != nullptr;
+    const auto     PageSize      = Page.GetPageSize();
+    const uint32_t HeapIndex     = m_PhysicalDevice.GetMemoryProperties().memoryTypes[Page.GetMemoryTypeIndex()].heapIndex;
+
+    m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
+    m_HeapAllocatedSize[HeapIndex].fetch_sub(PageSize);
+    LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (Page.IsDedicated() ? "dedicated " : ""), (IsHostVisible ? "host-visible" : "device-local"),
+                     " page (", Diligent::FormatMemorySize(PageSize, 2),
+                     "). Current allocated size: ",
+                     Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
+    OnPageDestroy(Page);
+}
+
 void VulkanMemoryManager::ShrinkMemory()
 {
     std::lock_guard<std::mutex> Lock{m_PagesMtx};
-    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
+
+    // Dedicated pages are never reused, so they are always released
+    for (auto it = m_DedicatedPages.begin(); it != m_DedicatedPages.end();)
+    {
+        if (it->IsEmpty())
+        {
+            const uint32_t HeapIndex = m_PhysicalDevice.GetMemoryProperties().memoryTypes[it->GetMemoryTypeIndex()].heapIndex;
+            DestroyPage(*it);
+            it = m_DedicatedPages.erase(it);
+            // Re-arm the budget callback once the heap usage drops below the threshold
+            UpdateHeapBudgetState(HeapIndex);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize && !m_HasEvacuatingPages)
         return;
 
+    bool HasEvacuatingPages = false;
+
     auto it = m_Pages.begin();
     while (it != m_Pages.end())
     {
@@ -224,18 +511,120 @@ void VulkanMemoryManager::ShrinkMemory()
         auto& Page          = curr_it->second;
         bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
         auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
-        if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+        // Evacuated pages are not reused, so they are released regardless of the reserve size
+        if (Page.IsEmpty() && (Page.m_IsEvacuating || m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize))
         {
-            auto PageSize = Page.GetPageSize();
-            m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
-            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
-                             " page (", Diligent::FormatMemorySize(PageSize, 2),
-                             "). Current allocated size: ",
-                             Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
-            OnPageDestroy(Page);
+            const uint32_t HeapIndex = m_PhysicalDevice.GetMemoryProperties().memoryTypes[Page.GetMemoryTypeIndex()].heapIndex;
+            DestroyPage(Page);
             m_Pages.erase(curr_it);
+            // Re-arm the budget callback once the heap usage drops below the threshold
+            UpdateHeapBudgetState(HeapIndex);
         }
+        else
+        {
+            HasEvacuatingPages = HasEvacuatingPages || Page.m_IsEvacuating;
+        }
+    }
+    m_HasEvacuatingPages = HasEvacuatingPages;
+}
+
+VulkanMemoryFragmentationStats VulkanMemoryManager::GetFragmentationStats()
+{
+    VulkanMemoryFragmentationStats Stats;
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    for (auto& it : m_Pages)
+    {
+        auto& Page = it.second;
+        Stats.AllocatedSize += Page.GetPageSize();
+        Stats.UsedSize += Page.GetUsedSize();
+        Stats.FreeBlockCount += Page.GetNumFreeBlocks();
+        Stats.MaxFreeBlockSize = std::max(Stats.MaxFreeBlockSize, Page.GetMaxFreeBlockSize());
+    }
+    Stats.PageCount = m_Pages.size();
+
+    for (const auto& Page : m_DedicatedPages)
+    {
+        Stats.AllocatedSize += Page.GetPageSize();
+        Stats.UsedSize += Page.GetUsedSize();
+    }
+    Stats.DedicatedPageCount = m_DedicatedPages.size();
+    Stats.PageCount += Stats.DedicatedPageCount;
+
+    return Stats;
+}
+
+void VulkanMemoryManager::GetHeapUsedSizes(std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>& UsedSizes)
+{
+    UsedSizes.fill(0);
+
+    const auto& MemProps = m_PhysicalDevice.GetMemoryProperties();
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    for (auto& it : m_Pages)
+    {
+        const auto& Page = it.second;
+        UsedSizes[MemProps.memoryTypes[Page.GetMemoryTypeIndex()].heapIndex] += Page.GetUsedSize();
+    }
+    for (const auto& Page : m_DedicatedPages)
+    {
+        UsedSizes[MemProps.memoryTypes[Page.GetMemoryTypeIndex()].heapIndex] += Page.GetUsedSize();
+    }
+}
+
+std::vector<VulkanMemoryPage*> VulkanMemoryManager::BeginDefragmentation(float Threshold, VkDeviceSize MaxBytes)
+{
+    std::vector<VulkanMemoryPage*> Pages;
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    for (auto& it : m_Pages)
+    {
+        auto& Page = it.second;
+        if (Page.GetCPUMemory() != nullptr || Page.m_IsEvacuating || Page.IsEmpty())
+            continue;
+
+        if (static_cast<double>(Page.GetUsedSize()) < static_cast<double>(Page.GetPageSize()) * Threshold)
+            Pages.push_back(&Page);
+    }
+
+    std::sort(Pages.begin(), Pages.end(),
+              [](const VulkanMemoryPage* lhs, const VulkanMemoryPage* rhs) {
+                  return lhs->GetUsedSize() < rhs->GetUsedSize();
+              });
+
+    VkDeviceSize TotalUsedSize = 0;
+    size_t       NumPages      = 0;
+    for (; NumPages < Pages.size(); ++NumPages)
+    {
+        TotalUsedSize += Pages[NumPages]->GetUsedSize();
+        if (TotalUsedSize > MaxBytes)
+            break;
+        Pages[NumPages]->m_IsEvacuating = true;
+    }
+    Pages.resize(NumPages);
+
+    if (!Pages.empty())
+        m_HasEvacuatingPages = true;
+
+    return Pages;
+}
+
+void VulkanMemoryManager::CancelDefragmentation(const std::vector<VulkanMemoryPage*>& Pages)
+{
+    if (Pages.empty())
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    bool HasEvacuatingPages = false;
+    for (auto& it : m_Pages)
+    {
+        auto& Page = it.second;
+        if (Page.m_IsEvacuating && std::find(Pages.begin(), Pages.end(), &Page) != Pages.end())
+            Page.m_IsEvacuating = false;
+        HasEvacuatingPages = HasEvacuatingPages || Page.m_IsEvacuating;
     }
+    m_HasEvacuatingPages = HasEvacuatingPages;
 }
 
 void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible)
@@ -259,6 +648,8 @@ VulkanMemoryManager::~VulkanMemoryManager()
 
     for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
         VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+    for (const auto& Page : m_DedicatedPages)
+        VERIFY(Page.IsEmpty(), "The dedicated page contains outstanding allocations");
     VERIFY(m_CurrUsedSize[0] == 0 && m_CurrUsedSize[1] == 0, "Not all allocations have been released");
 }
 
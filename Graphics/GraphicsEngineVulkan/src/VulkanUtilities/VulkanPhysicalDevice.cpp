@@ -49,6 +49,8 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(const CreateInfo& CI) :
     vkGetPhysicalDeviceProperties(m_VkDevice, &m_Properties);
     vkGetPhysicalDeviceFeatures(m_VkDevice, &m_Features);
     vkGetPhysicalDeviceMemoryProperties(m_VkDevice, &m_MemoryProperties);
+    m_DeviceGroupSize = CI.Instance.GetPhysicalDeviceGroupSize(m_VkDevice);
+
     uint32_t QueueFamilyCount = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(m_VkDevice, &QueueFamilyCount, nullptr);
     VERIFY_EXPR(QueueFamilyCount > 0);
@@ -336,6 +338,140 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(const CreateInfo& CI) :
             m_ExtProperties.MultiDraw.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_PROPERTIES_EXT;
         }
 
+        // Dynamic rendering requires VK_KHR_depth_stencil_resolve that in turn requires VK_KHR_create_renderpass2
+        if (IsExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME) &&
+            m_ExtFeatures.RenderPass2)
+        {
+            *NextFeat = &m_ExtFeatures.DynamicRendering;
+            NextFeat  = &m_ExtFeatures.DynamicRendering.pNext;
+
+            m_ExtFeatures.DynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        }
+
+        // Descriptor buffer requires VK_KHR_buffer_device_address, VK_KHR_synchronization2 and VK_EXT_descriptor_indexing
+        if (IsExtensionSupported(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.DescriptorBuffer;
+            NextFeat  = &m_ExtFeatures.DescriptorBuffer.pNext;
+
+            m_ExtFeatures.DescriptorBuffer.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.DescriptorBuffer;
+            NextProp  = &m_ExtProperties.DescriptorBuffer.pNext;
+
+            m_ExtProperties.DescriptorBuffer.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+        }
+
+        if (IsExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+        {
+            m_ExtFeatures.PushDescriptor = true;
+
+            *NextProp = &m_ExtProperties.PushDescriptor;
+            NextProp  = &m_ExtProperties.PushDescriptor.pNext;
+
+            m_ExtProperties.PushDescriptor.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+        }
+
+        // Memory budget is queried with vkGetPhysicalDeviceMemoryProperties2KHR
+        m_ExtFeatures.MemoryBudget = IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+        // Dedicated allocation requirements are queried with vkGet*MemoryRequirements2KHR
+        m_ExtFeatures.DedicatedAllocation = IsExtensionSupported(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME);
+
+        // External memory and semaphores are used to export textures and fences (see MISC_TEXTURE_FLAG_EXPORTABLE
+        // and FENCE_FLAG_EXPORTABLE). Vulkan 1.1 is required as VK_KHR_external_memory and VK_KHR_external_semaphore
+        // are core in this version.
+        if (m_VkVersion >= VK_API_VERSION_1_1)
+        {
+#if defined(VK_USE_PLATFORM_WIN32_KHR)
+            m_ExtFeatures.ExternalMemory    = IsExtensionSupported(VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME);
+            m_ExtFeatures.ExternalSemaphore = IsExtensionSupported(VK_KHR_EXTERNAL_SEMAPHORE_WIN32_EXTENSION_NAME);
+#else
+            m_ExtFeatures.ExternalMemory    = IsExtensionSupported(VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME);
+            m_ExtFeatures.ExternalSemaphore = IsExtensionSupported(VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME);
+#endif
+        }
+
+        // Calibrated timestamps are only useful if both the device time domain and
+        // the host time domain of std::chrono::steady_clock are supported (see CommandQueueVkImpl)
+        if (IsExtensionSupported(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME))
+        {
+            uint32_t TimeDomainCount = 0;
+            vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(m_VkDevice, &TimeDomainCount, nullptr);
+            std::vector<VkTimeDomainEXT> TimeDomains(TimeDomainCount);
+            if (TimeDomainCount > 0)
+                vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(m_VkDevice, &TimeDomainCount, TimeDomains.data());
+
+            const auto IsTimeDomainSupported = [&TimeDomains](VkTimeDomainEXT Domain) {
+                return std::find(TimeDomains.begin(), TimeDomains.end(), Domain) != TimeDomains.end();
+            };
+            m_ExtFeatures.CalibratedTimestamps = IsTimeDomainSupported(VK_TIME_DOMAIN_DEVICE_EXT) && IsTimeDomainSupported(HostTimeDomain);
+        }
+
+        if (IsExtensionSupported(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.Synchronization2;
+            NextFeat  = &m_ExtFeatures.Synchronization2.pNext;
+
+            m_ExtFeatures.Synchronization2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR;
+        }
+
+        if (IsExtensionSupported(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.ConditionalRendering;
+            NextFeat  = &m_ExtFeatures.ConditionalRendering.pNext;
+
+            m_ExtFeatures.ConditionalRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+        }
+
+        if (IsExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.ExtendedDynamicState;
+            NextFeat  = &m_ExtFeatures.ExtendedDynamicState.pNext;
+
+            m_ExtFeatures.ExtendedDynamicState.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+        }
+
+        // Graphics pipeline library requires VK_KHR_pipeline_library
+        if (IsExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.GraphicsPipelineLibrary;
+            NextFeat  = &m_ExtFeatures.GraphicsPipelineLibrary.pNext;
+
+            m_ExtFeatures.GraphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.GraphicsPipelineLibrary;
+            NextProp  = &m_ExtProperties.GraphicsPipelineLibrary.pNext;
+
+            m_ExtProperties.GraphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+        }
+
+        // Shader module identifiers require VK_EXT_pipeline_creation_cache_control
+        if (IsExtensionSupported(VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_EXT_PIPELINE_CREATION_CACHE_CONTROL_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.PipelineCreationCacheControl;
+            NextFeat  = &m_ExtFeatures.PipelineCreationCacheControl.pNext;
+
+            m_ExtFeatures.PipelineCreationCacheControl.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_CREATION_CACHE_CONTROL_FEATURES_EXT;
+
+            *NextFeat = &m_ExtFeatures.ShaderModuleIdentifier;
+            NextFeat  = &m_ExtFeatures.ShaderModuleIdentifier.pNext;
+
+            m_ExtFeatures.ShaderModuleIdentifier.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_MODULE_IDENTIFIER_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.ShaderModuleIdentifier;
+            NextProp  = &m_ExtProperties.ShaderModuleIdentifier.pNext;
+
+            m_ExtProperties.ShaderModuleIdentifier.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_MODULE_IDENTIFIER_PROPERTIES_EXT;
+        }
+
         // make sure that last pNext is null
         *NextFeat = nullptr;
         *NextProp = nullptr;
@@ -509,6 +645,26 @@ uint32_t VulkanPhysicalDevice::GetMemoryTypeIndex(uint32_t              memoryTy
     return InvalidMemoryTypeIndex;
 }
 
+bool VulkanPhysicalDevice::GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& Budget) const
+{
+    Budget = {};
+#if DILIGENT_USE_VOLK
+    if (!m_ExtFeatures.MemoryBudget)
+        return false;
+
+    Budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 MemProps2{};
+    MemProps2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    MemProps2.pNext = &Budget;
+    vkGetPhysicalDeviceMemoryProperties2KHR(m_VkDevice, &MemProps2);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
 VkFormatProperties VulkanPhysicalDevice::GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const
 {
     VkFormatProperties formatProperties;
@@ -0,0 +1,131 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BindGroupCacheWebGPU class
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "WebGPUObjectWrappers.hpp"
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+// Bind group cache shares WebGPU bind groups between shader resource bindings that bind
+// identical resources with the same layout, and avoids re-creating bind groups when the same
+// set of resources is bound again (e.g. when dynamic variables alternate between several objects).
+//
+// Bind groups are keyed by the layout and the unique IDs and buffer ranges of the bound objects.
+// Unique IDs are never reused, so a key can't match an object that was released, but the cached
+// bind group keeps WebGPU resources alive. For this reason, the entries that reference an object
+// are removed when the object is destroyed. The least recently used entries are evicted when
+// the cache is full.
+class BindGroupCacheWebGPU
+{
+public:
+    using BindGroupPtr = std::shared_ptr<WebGPUBindGroupWrapper>;
+
+    struct ResourceKey
+    {
+        Int32  UniqueID = 0;
+        Uint64 Offset   = 0;
+        Uint64 Size     = 0;
+
+        bool operator==(const ResourceKey& RHS) const
+        {
+            return UniqueID == RHS.UniqueID && Offset == RHS.Offset && Size == RHS.Size;
+        }
+    };
+
+    struct Key
+    {
+        WGPUBindGroupLayout      wgpuLayout = nullptr;
+        std::vector<ResourceKey> Resources;
+
+        bool operator==(const Key& RHS) const
+        {
+            return wgpuLayout == RHS.wgpuLayout && Resources == RHS.Resources;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& key) const;
+        };
+    };
+
+    BindGroupCacheWebGPU(WGPUDevice wgpuDevice, Uint32 MaxSize);
+    ~BindGroupCacheWebGPU();
+
+    // clang-format off
+    BindGroupCacheWebGPU           (const BindGroupCacheWebGPU&)  = delete;
+    BindGroupCacheWebGPU           (      BindGroupCacheWebGPU&&) = delete;
+    BindGroupCacheWebGPU& operator=(const BindGroupCacheWebGPU&)  = delete;
+    BindGroupCacheWebGPU& operator=(      BindGroupCacheWebGPU&&) = delete;
+    // clang-format on
+
+    // Returns the bind group for the given key, creating it from the descriptor if it is not in the cache.
+    BindGroupPtr GetBindGroup(const Key& key, const WGPUBindGroupDescriptor& wgpuBindGroupDesc);
+
+    // Removes all entries that reference an object with the given unique ID.
+    void OnObjectReleased(Int32 UniqueID);
+
+    // Removes all entries that use the given layout.
+    void OnLayoutReleased(WGPUBindGroupLayout wgpuLayout);
+
+private:
+    struct Entry
+    {
+        Key          key;
+        BindGroupPtr pBindGroup;
+    };
+    using EntryList = std::list<Entry>;
+
+    void EraseEntry(EntryList::iterator Iter);
+
+private:
+    const WGPUDevice m_wgpuDevice;
+    const size_t     m_MaxSize;
+
+    std::mutex m_Mtx;
+
+    // The most recently used entries are at the front of the list
+    EntryList                                                 m_Entries;
+    std::unordered_map<Key, EntryList::iterator, Key::Hasher> m_EntriesMap;
+
+    // The number of cached entries that reference each object. Allows skipping the
+    // search when an object that is not referenced by the cache is released.
+    std::unordered_map<Int32, Uint32> m_ObjectRefCounts;
+};
+
+} // namespace Diligent
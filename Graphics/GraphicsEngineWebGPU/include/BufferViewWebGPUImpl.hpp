@@ -47,6 +47,7 @@ public:
                          IBuffer*                pBuffer,
                          bool                    IsDefaultView,
                          bool                    bIsDeviceInternal);
+    ~BufferViewWebGPUImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BufferViewWebGPU, TBufferViewBase)
 };
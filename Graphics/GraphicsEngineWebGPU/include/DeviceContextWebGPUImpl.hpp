@@ -31,6 +31,7 @@
 
 #include <array>
 #include <vector>
+#include <string>
 #include <unordered_map>
 
 #include "EngineWebGPUImplTraits.hpp"
@@ -43,6 +44,7 @@
 #include "FramebufferWebGPUImpl.hpp"
 #include "RenderPassWebGPUImpl.hpp"
 #include "UploadMemoryManagerWebGPU.hpp"
+#include "SyncPointWebGPU.hpp"
 
 namespace Diligent
 {
@@ -281,6 +283,18 @@ public:
     /// Implementation of IDeviceContext::BindSparseResourceMemory() in WebGPU backend.
     void DILIGENT_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::ResolveQueries() in WebGPU backend.
+    void DILIGENT_CALL_TYPE ResolveQueries(const ResolveQueriesAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in WebGPU backend.
+    void DILIGENT_CALL_TYPE BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in WebGPU backend.
+    void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
+    /// Implementation of IDeviceContext::SetDynamicRenderState() in WebGPU backend.
+    void DILIGENT_CALL_TYPE SetDynamicRenderState(const DynamicRenderState& State) override final;
+
     /// Implementation of IDeviceContext::GenerateMips() in WebGPU backend.
     void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override final;
 
@@ -304,6 +318,12 @@ public:
     /// Implementation of IDeviceContextWebGPU::GetWebGPUQueue() in WebGPU backend.
     WGPUQueue DILIGENT_CALL_TYPE GetWebGPUQueue() override final;
 
+    /// Implementation of IDeviceContextWebGPU::BeginRenderBundle() in WebGPU backend.
+    void DILIGENT_CALL_TYPE BeginRenderBundle(const Char* Name) override final;
+
+    /// Implementation of IDeviceContextWebGPU::EndRenderBundle() in WebGPU backend.
+    void DILIGENT_CALL_TYPE EndRenderBundle(ICommandList** ppCommandList) override final;
+
     QueryManagerWebGPU& GetQueryManager();
 
     Uint64 GetNextFenceValue();
@@ -362,18 +382,34 @@ private:
                          const float               ClearData[],
                          Uint8                     Stencil);
 
-    WGPURenderPassEncoder  PrepareForDraw(DRAW_FLAGS Flags);
-    WGPURenderPassEncoder  PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE IndexType);
+    // Calls the handler with the render bundle encoder if a bundle is being recorded,
+    // and with the render pass encoder otherwise.
+    template <typename HandlerType>
+    void EncodeDrawCommand(HandlerType&& Handler);
+
+    template <typename CmdEncoderType>
+    void PrepareForDraw(CmdEncoderType CmdEncoder, DRAW_FLAGS Flags);
+    template <typename CmdEncoderType>
+    void PrepareForIndexedDraw(CmdEncoderType CmdEncoder, DRAW_FLAGS Flags, VALUE_TYPE IndexType);
+
     WGPUComputePassEncoder PrepareForDispatchCompute();
     WGPUBuffer             PrepareForIndirectCommand(IBuffer* pAttribsBuffer, Uint64& IdirectBufferOffset);
 
-    void CommitGraphicsPSO(WGPURenderPassEncoder CmdEncoder);
+    template <typename CmdEncoderType>
+    void CommitGraphicsPSO(CmdEncoderType CmdEncoder);
     void CommitComputePSO(WGPUComputePassEncoder CmdEncoder);
-    void CommitVertexBuffers(WGPURenderPassEncoder CmdEncoder);
-    void CommitIndexBuffer(WGPURenderPassEncoder CmdEncoder, VALUE_TYPE IndexType);
+    template <typename CmdEncoderType>
+    void CommitVertexBuffers(CmdEncoderType CmdEncoder);
+    template <typename CmdEncoderType>
+    void CommitIndexBuffer(CmdEncoderType CmdEncoder, VALUE_TYPE IndexType);
     void CommitViewports(WGPURenderPassEncoder CmdEncoder);
     void CommitScissorRects(WGPURenderPassEncoder CmdEncoder);
 
+    // Viewports, scissor rects, blend factors and stencil reference are render pass state
+    // that render bundles inherit, so they are only committed to the render pass encoder.
+    void CommitDynamicState(WGPURenderPassEncoder CmdEncoder);
+    void CommitDynamicState(WGPURenderBundleEncoder) {}
+
     template <typename CmdEncoderType>
     void CommitBindGroups(CmdEncoderType CmdEncoder, Uint32 CommitSRBMask);
 
@@ -574,11 +610,14 @@ private:
     using DebugGroupStack         = std::vector<DEBUG_GROUP_TYPE>;
     using OcclusionQueryStack     = std::vector<std::pair<OCCLUSION_QUERY_TYPE, Uint32>>;
     using PendingStagingResources = std::unordered_map<WebGPUResourceBase::StagingBufferInfo*, RefCntAutoPtr<IObject>>;
+    using SyncPointList           = std::vector<RefCntAutoPtr<SyncPointWebGPUImpl>>;
 
-    WebGPUQueueWrapper              m_wgpuQueue;
-    WebGPUCommandEncoderWrapper     m_wgpuCommandEncoder;
-    WebGPURenderPassEncoderWrapper  m_wgpuRenderPassEncoder;
-    WebGPUComputePassEncoderWrapper m_wgpuComputePassEncoder;
+    WebGPUQueueWrapper               m_wgpuQueue;
+    WebGPUCommandEncoderWrapper      m_wgpuCommandEncoder;
+    WebGPURenderPassEncoderWrapper   m_wgpuRenderPassEncoder;
+    WebGPUComputePassEncoderWrapper  m_wgpuComputePassEncoder;
+    WebGPURenderBundleEncoderWrapper m_wgpuRenderBundleEncoder;
+    std::string                      m_RenderBundleName;
 
     PendingFenceList        m_SignaledFences;
     AttachmentClearList     m_AttachmentClearValues;
@@ -591,6 +630,7 @@ private:
     OcclusionQueryStack     m_OcclusionQueriesStack;
     PendingStagingResources m_PendingStagingReads;
     PendingStagingResources m_PendingStagingWrites;
+    SyncPointList           m_FlushSyncPoints; // Reused by Flush() to avoid allocating memory every time
 
     RefCntAutoPtr<IFence> m_pFence;
     Uint64                m_FenceValue = 0;
@@ -102,6 +102,11 @@ public:
         return m_wgpuBuffer;
     }
 
+    size_t GetBufferSize() const { return m_BufferSize; }
+
+    // Returns the total size of the pages that are used by the contexts or wait to be recycled
+    size_t GetAllocatedPageSize();
+
 private:
     void RecyclePage(Page&& page);
 
@@ -109,6 +114,7 @@ private:
     const size_t        m_PageSize;
     const size_t        m_BufferSize;
     size_t              m_CurrentOffset = 0;
+    size_t              m_AllocatedPageSize = 0; // Protected by m_AvailablePagesMtx
     WebGPUBufferWrapper m_wgpuBuffer;
 
     std::mutex         m_AvailablePagesMtx;
@@ -60,6 +60,9 @@ public:
     /// Implementation of IFence::Wait() in WebGPU backend.
     void DILIGENT_CALL_TYPE Wait(Uint64 Value) override final;
 
+    /// Implementation of IFence::WaitWithTimeout() in WebGPU backend.
+    Bool DILIGENT_CALL_TYPE WaitWithTimeout(Uint64 Value, Uint64 Timeout) override final;
+
     void AppendSyncPoints(const std::vector<RefCntAutoPtr<SyncPointWebGPUImpl>>& SyncPoints, Uint64 Value);
 
 private:
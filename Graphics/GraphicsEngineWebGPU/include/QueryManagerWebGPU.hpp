@@ -64,7 +64,20 @@ public:
 
     Uint64 GetQueryResult(QUERY_TYPE Type, Uint32 Index) const;
 
-    void ResolveQuerySet(RenderDeviceWebGPUImpl* pDevice, DeviceContextWebGPUImpl* pDeviceContext);
+    // Returns the fence value after which the result of the query is available on the CPU,
+    // or UINT64_MAX if the query has not been resolved yet.
+    Uint64 GetQueryResolveFenceValue(QUERY_TYPE Type, Uint32 Index) const;
+
+    // Marks the query as written by the GPU so that it is resolved by the next ResolveQuerySet() call.
+    void OnQueryWritten(QUERY_TYPE Type, Uint32 Index);
+
+    // Resolves all queries written since the last call with a single resolve per query set and
+    // copies the results to one of the readback buffers of the set's ring. The results are mapped
+    // asynchronously and become available once the context fence reaches FenceValue.
+    void ResolveQuerySet(RenderDeviceWebGPUImpl* pDevice, DeviceContextWebGPUImpl* pDeviceContext, Uint64 FenceValue);
+
+    // The maximum number of frames whose query results may be pending readback
+    static constexpr size_t MaxPendingReadbacks = 16;
 
 private:
     class QuerySetObject final : public ObjectBase<IDeviceObject>, public WebGPUResourceBase
@@ -84,11 +97,15 @@ private:
 
         Uint64 GetQueryResult(Uint32 Index) const;
 
+        Uint64 GetResolveFenceValue(Uint32 Index) const;
+
+        void OnQueryWritten(Uint32 Index);
+
         WGPUQuerySet GetWebGPUQuerySet() const;
 
         Uint32 GetMaxAllocatedQueries() const;
 
-        void ResolveQueries(RenderDeviceWebGPUImpl* pDevice, DeviceContextWebGPUImpl* pDeviceContext);
+        void ResolveQueries(RenderDeviceWebGPUImpl* pDevice, DeviceContextWebGPUImpl* pDeviceContext, Uint64 FenceValue);
 
         const DeviceObjectAttribs& DILIGENT_CALL_TYPE GetDesc() const override final;
 
@@ -104,9 +121,18 @@ private:
         WebGPUBufferWrapper   m_wgpuResolveBuffer;
         std::vector<Uint32>   m_AvailableQueries;
 
+        // Fence value after which the result of each query is available, see GetQueryResolveFenceValue()
+        std::vector<Uint64> m_ResolveFenceValues;
+
         QUERY_TYPE m_Type                = QUERY_TYPE_UNDEFINED;
         Uint32     m_QueryCount          = 0;
         Uint32     m_MaxAllocatedQueries = 0;
+
+        // Range of queries written since the last resolve
+        Uint32 m_FirstUnresolvedQuery = UINT32_MAX;
+        Uint32 m_LastUnresolvedQuery  = 0;
+
+        bool m_ReadbackRingFullWarningShown = false;
     };
 
     std::array<RefCntAutoPtr<QuerySetObject>, QUERY_TYPE_NUM_TYPES> m_QuerySets;
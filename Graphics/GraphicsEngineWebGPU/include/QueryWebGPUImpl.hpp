@@ -70,9 +70,8 @@ private:
     void DiscardQueries();
 
 private:
-    std::array<Uint32, 2> m_QuerySetIndices    = {QueryManagerWebGPU::InvalidIndex, QueryManagerWebGPU::InvalidIndex};
-    QueryManagerWebGPU*   m_pQueryMgr          = nullptr;
-    Uint64                m_QueryEndFenceValue = 0;
+    std::array<Uint32, 2> m_QuerySetIndices = {QueryManagerWebGPU::InvalidIndex, QueryManagerWebGPU::InvalidIndex};
+    QueryManagerWebGPU*   m_pQueryMgr       = nullptr;
 };
 
 } // namespace Diligent
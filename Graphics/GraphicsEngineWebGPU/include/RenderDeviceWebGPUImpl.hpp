@@ -38,6 +38,7 @@
 #include "ShaderWebGPUImpl.hpp"
 #include "UploadMemoryManagerWebGPU.hpp"
 #include "DynamicMemoryManagerWebGPU.hpp"
+#include "BindGroupCacheWebGPU.hpp"
 #include "GenerateMipsHelperWebGPU.hpp"
 
 namespace Diligent
@@ -142,6 +143,9 @@ public:
     /// Implementation of IRenderDevice::IdleGPU() in WebGPU backend.
     void DILIGENT_CALL_TYPE IdleGPU() override final;
 
+    /// Implementation of IRenderDevice::GetMemoryStats() in WebGPU backend.
+    void DILIGENT_CALL_TYPE GetMemoryStats(DeviceMemoryStats& Stats) override final;
+
     /// Implementation of IRenderDevice::GetSparseTextureFormatInfo() in WebGPU backend.
     SparseTextureFormatInfo DILIGENT_CALL_TYPE GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
                                                                           RESOURCE_DIMENSION Dimension,
@@ -213,6 +217,11 @@ public:
         return *m_pDynamicMemoryManager;
     }
 
+    BindGroupCacheWebGPU& GetBindGroupCache() const
+    {
+        return *m_pBindGroupCache;
+    }
+
     void DeviceTick();
 
 private:
@@ -226,6 +235,9 @@ private:
     WebGPUDeviceWrapper   m_wgpuDevice;
     WGPULimits            m_wgpuLimits{};
 
+    // Must be destroyed after all device-internal objects that may reference it
+    std::unique_ptr<BindGroupCacheWebGPU> m_pBindGroupCache;
+
     std::unique_ptr<UploadMemoryManagerWebGPU>  m_pUploadMemoryManager;
     std::unique_ptr<DynamicMemoryManagerWebGPU> m_pDynamicMemoryManager;
 
@@ -48,6 +48,7 @@ public:
                       bool                    bIsDeviceInternal);
     // Special constructor for serialization
     SamplerWebGPUImpl(IReferenceCounters* pRefCounters, const SamplerDesc& SamplerDesc) noexcept;
+    ~SamplerWebGPUImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_SamplerWebGPU, TSamplerBase)
 
@@ -36,6 +36,7 @@
 #include "PipelineResourceAttribsWebGPU.hpp"
 #include "STDAllocator.hpp"
 #include "WebGPUObjectWrappers.hpp"
+#include "BindGroupCacheWebGPU.hpp"
 #include "IndexWrapper.hpp"
 
 namespace Diligent
@@ -124,15 +125,15 @@ public:
 
         WGPUBindGroup GetWGPUBindGroup() const
         {
-            return m_wgpuBindGroup;
+            return m_pBindGroup ? m_pBindGroup->Get() : nullptr;
         }
 
     private:
-        /* 0 */ const Uint32              m_NumResources = 0;
-        /* 5*/ bool                       m_IsDirty      = true;
-        /* 8 */ Resource* const           m_pResources   = nullptr;
-        /*16 */ WGPUBindGroupEntry* const m_wgpuEntries  = nullptr;
-        /*24 */ WebGPUBindGroupWrapper    m_wgpuBindGroup;
+        /* 0 */ const Uint32                       m_NumResources = 0;
+        /* 5*/ bool                                m_IsDirty      = true;
+        /* 8 */ Resource* const                    m_pResources   = nullptr;
+        /*16 */ WGPUBindGroupEntry* const          m_wgpuEntries  = nullptr;
+        /*24 */ BindGroupCacheWebGPU::BindGroupPtr m_pBindGroup;
         /*40 */ // End of structure
 
     private:
@@ -177,7 +178,7 @@ public:
 
     ResourceCacheContentType GetContentType() const { return static_cast<ResourceCacheContentType>(m_ContentType); }
 
-    WGPUBindGroup UpdateBindGroup(WGPUDevice wgpuDevice, Uint32 GroupIndex, WGPUBindGroupLayout wgpuGroupLayout);
+    WGPUBindGroup UpdateBindGroup(BindGroupCacheWebGPU& BindGroupCache, Uint32 GroupIndex, WGPUBindGroupLayout wgpuGroupLayout);
 
     // Returns true if any dynamic offset has changed
     bool GetDynamicBufferOffsets(DeviceContextIndex     CtxId,
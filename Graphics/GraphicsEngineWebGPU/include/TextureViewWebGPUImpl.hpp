@@ -53,6 +53,7 @@ public:
                           std::vector<WebGPUTextureViewWrapper>&& wgpuTextureMipUAVs,
                           bool                                    bIsDefaultView,
                           bool                                    bIsDeviceInternal);
+    ~TextureViewWebGPUImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_TextureViewWebGPU, TTextureViewBase)
 
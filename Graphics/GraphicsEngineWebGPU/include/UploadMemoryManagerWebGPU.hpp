@@ -46,6 +46,11 @@ namespace Diligent
 //
 // The data is first written to the upload memory and the copy command is added to the command list.
 // Upload data is flushed to the GPU memory before the command list is submitted to the queue.
+//
+// By default, the data is written to a CPU-side copy of the page that is flushed with wgpuQueueWriteBuffer.
+// When mapped pages are enabled, pages are MapWrite staging buffers and the data is written directly to the
+// mapped memory. A page is unmapped before the submit and is asynchronously mapped again when it is recycled.
+// It only becomes available once the GPU has finished all copies from it, so the pages form a ring.
 class UploadMemoryManagerWebGPU
 {
 public:
@@ -83,17 +88,21 @@ public:
 
         size_t GetSize() const
         {
-            return m_Data.size();
+            return m_Size;
         }
 
     private:
+        friend UploadMemoryManagerWebGPU;
+
         UploadMemoryManagerWebGPU* m_pMgr = nullptr;
         WebGPUBufferWrapper        m_wgpuBuffer;
-        std::vector<Uint8>         m_Data;
-        size_t                     m_CurrOffset = 0;
+        std::vector<Uint8>         m_Data;                  // CPU-side copy, only used when pages are not mapped
+        Uint8*                     m_pMappedData = nullptr; // Mapped buffer memory, only used when pages are mapped
+        size_t                     m_Size        = 0;
+        size_t                     m_CurrOffset  = 0;
     };
 
-    UploadMemoryManagerWebGPU(WGPUDevice wgpuDevice, size_t PageSize);
+    UploadMemoryManagerWebGPU(WGPUDevice wgpuDevice, size_t PageSize, bool UseMappedPages);
     ~UploadMemoryManagerWebGPU();
 
     Page GetPage(size_t Size);
@@ -101,13 +110,21 @@ public:
 private:
     void RecyclePage(Page&& page);
 
+    struct PendingMapPage;
+    void MapPageAsync(Page&& page);
+    void OnPageMapped(PendingMapPage* pPending, bool Success);
+
 private:
     const size_t m_PageSize;
+    const bool   m_UseMappedPages;
     WGPUDevice   m_wgpuDevice;
 
     std::mutex        m_AvailablePagesMtx;
     std::vector<Page> m_AvailablePages;
 
+    // Pages that are waiting for wgpuBufferMapAsync to complete, protected by m_AvailablePagesMtx
+    std::vector<PendingMapPage*> m_PendingMapPages;
+
 #if DILIGENT_DEBUG
     std::atomic<uint32_t> m_DbgPageCounter{0};
 #endif
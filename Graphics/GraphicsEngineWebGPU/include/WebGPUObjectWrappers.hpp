@@ -146,5 +146,7 @@ DECLARE_WEBGPU_WRAPPER(WebGPURenderPassEncoder, WGPURenderPassEncoder, wgpuRende
 DECLARE_WEBGPU_WRAPPER(WebGPUComputePassEncoder, WGPUComputePassEncoder, wgpuComputePassEncoder)
 DECLARE_WEBGPU_WRAPPER(WebGPUBindGroup, WGPUBindGroup, wgpuBindGroup)
 DECLARE_WEBGPU_WRAPPER(WebGPUQuerySet, WGPUQuerySet, wgpuQuerySet)
+DECLARE_WEBGPU_WRAPPER(WebGPURenderBundle, WGPURenderBundle, wgpuRenderBundle)
+DECLARE_WEBGPU_WRAPPER(WebGPURenderBundleEncoder, WGPURenderBundleEncoder, wgpuRenderBundleEncoder)
 
 } // namespace Diligent
@@ -49,6 +49,11 @@ public:
         WebGPUResourceBase&                Resource;
         WebGPUBufferWrapper                wgpuBuffer;
         RefCntAutoPtr<SyncPointWebGPUImpl> pSyncPoint = {};
+
+        // Range of the mapped data that is read back by ProcessAsyncReadback().
+        // FindStagingReadBuffer() resets it to the entire resource.
+        size_t ReadbackOffset = 0;
+        size_t ReadbackSize   = 0;
     };
 
     WebGPUResourceBase(IDeviceObject& Owner, size_t MaxPendingBuffers);
@@ -55,6 +55,31 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextWebGPU, IDeviceContext)
 {
     /// Returns a pointer to the WebGPU queue object associated with this device context.
     VIRTUAL WGPUQueue METHOD(GetWebGPUQueue)(THIS) PURE;
+
+    /// Begins recording a render bundle.
+
+    /// \param [in] Name - Optional name of the render bundle.
+    ///
+    /// \remarks   The bundle is compatible with the render targets and depth-stencil buffer
+    ///           that are currently bound to the context. All draw commands issued until
+    ///           IDeviceContextWebGPU::EndRenderBundle() is called are recorded into the bundle
+    ///           instead of the render pass.
+    ///
+    ///           The bundle inherits viewport, scissor rect, blend factors and stencil reference
+    ///           from the render pass it is executed in. Dynamic buffers, whose memory changes
+    ///           every time they are mapped, can't be used while recording a bundle.
+    VIRTUAL void METHOD(BeginRenderBundle)(THIS_
+                                           const Char* Name DEFAULT_VALUE(nullptr)) PURE;
+
+    /// Ends recording the render bundle and returns it as a command list.
+
+    /// \param [out] ppCommandList - Memory location where the pointer to the command list
+    ///                              will be written.
+    ///
+    /// \remarks   The command list may be executed any number of times by IDeviceContext::ExecuteCommandLists()
+    ///           while render targets compatible with those the bundle was recorded for are bound.
+    VIRTUAL void METHOD(EndRenderBundle)(THIS_
+                                         ICommandList** ppCommandList) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -66,6 +91,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContextWebGPU_MapBufferAsync(This, ...)              CALL_IFACE_METHOD(DeviceContextWebGPU, MapBufferAsync, This, __VA_ARGS__)
 #    define IDeviceContextWebGPU_MapTextureSubresourceAsync(This, ...)  CALL_IFACE_METHOD(DeviceContextWebGPU, MapTextureSubresourceAsync, This, __VA_ARGS__)
 #    define IDeviceContextWebGPU_GetWebGPUQueue(This)                   CALL_IFACE_METHOD(DeviceContextWebGPU, GetWebGPUQueue, This)
+#    define IDeviceContextWebGPU_BeginRenderBundle(This, ...)           CALL_IFACE_METHOD(DeviceContextWebGPU, BeginRenderBundle, This, __VA_ARGS__)
+#    define IDeviceContextWebGPU_EndRenderBundle(This, ...)             CALL_IFACE_METHOD(DeviceContextWebGPU, EndRenderBundle, This, __VA_ARGS__)
 // clang-format on
 
 #endif
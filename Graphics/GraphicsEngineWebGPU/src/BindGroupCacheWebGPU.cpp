@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "BindGroupCacheWebGPU.hpp"
+#include "HashUtils.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+size_t BindGroupCacheWebGPU::Key::Hasher::operator()(const Key& key) const
+{
+    size_t Hash = ComputeHash(reinterpret_cast<size_t>(key.wgpuLayout), key.Resources.size());
+    for (const ResourceKey& Res : key.Resources)
+        HashCombine(Hash, Res.UniqueID, Res.Offset, Res.Size);
+    return Hash;
+}
+
+BindGroupCacheWebGPU::BindGroupCacheWebGPU(WGPUDevice wgpuDevice, Uint32 MaxSize) :
+    m_wgpuDevice{wgpuDevice},
+    m_MaxSize{MaxSize}
+{
+}
+
+BindGroupCacheWebGPU::~BindGroupCacheWebGPU()
+{
+    VERIFY(m_Entries.size() == m_EntriesMap.size(), "Inconsistent cache state");
+}
+
+BindGroupCacheWebGPU::BindGroupPtr BindGroupCacheWebGPU::GetBindGroup(const Key& key, const WGPUBindGroupDescriptor& wgpuBindGroupDesc)
+{
+    VERIFY_EXPR(key.wgpuLayout == wgpuBindGroupDesc.layout);
+
+    auto CreateBindGroup = [&]() {
+        return std::make_shared<WebGPUBindGroupWrapper>(wgpuDeviceCreateBindGroup(m_wgpuDevice, &wgpuBindGroupDesc));
+    };
+
+    if (m_MaxSize == 0)
+        return CreateBindGroup();
+
+    std::lock_guard Lock{m_Mtx};
+
+    auto MapIt = m_EntriesMap.find(key);
+    if (MapIt != m_EntriesMap.end())
+    {
+        // Move the entry to the front of the list
+        m_Entries.splice(m_Entries.begin(), m_Entries, MapIt->second);
+        return MapIt->second->pBindGroup;
+    }
+
+    while (m_Entries.size() >= m_MaxSize)
+        EraseEntry(std::prev(m_Entries.end()));
+
+    BindGroupPtr pBindGroup = CreateBindGroup();
+    if (!*pBindGroup)
+    {
+        LOG_ERROR_MESSAGE("Failed to create WebGPU bind group");
+        return pBindGroup;
+    }
+
+    m_Entries.emplace_front(Entry{key, pBindGroup});
+    m_EntriesMap.emplace(key, m_Entries.begin());
+    for (const ResourceKey& Res : key.Resources)
+    {
+        if (Res.UniqueID != 0)
+            ++m_ObjectRefCounts[Res.UniqueID];
+    }
+
+    return pBindGroup;
+}
+
+void BindGroupCacheWebGPU::EraseEntry(EntryList::iterator Iter)
+{
+    for (const ResourceKey& Res : Iter->key.Resources)
+    {
+        if (Res.UniqueID == 0)
+            continue;
+
+        auto RefIt = m_ObjectRefCounts.find(Res.UniqueID);
+        VERIFY_EXPR(RefIt != m_ObjectRefCounts.end() && RefIt->second > 0);
+        if (--RefIt->second == 0)
+            m_ObjectRefCounts.erase(RefIt);
+    }
+
+    m_EntriesMap.erase(Iter->key);
+    m_Entries.erase(Iter);
+}
+
+void BindGroupCacheWebGPU::OnObjectReleased(Int32 UniqueID)
+{
+    std::lock_guard Lock{m_Mtx};
+
+    if (m_ObjectRefCounts.find(UniqueID) == m_ObjectRefCounts.end())
+        return;
+
+    for (auto Iter = m_Entries.begin(); Iter != m_Entries.end();)
+    {
+        const std::vector<ResourceKey>& Resources = Iter->key.Resources;
+
+        auto CurrIt = Iter++;
+        if (std::any_of(Resources.begin(), Resources.end(), [UniqueID](const ResourceKey& Res) { return Res.UniqueID == UniqueID; }))
+            EraseEntry(CurrIt);
+    }
+    VERIFY_EXPR(m_ObjectRefCounts.find(UniqueID) == m_ObjectRefCounts.end());
+}
+
+void BindGroupCacheWebGPU::OnLayoutReleased(WGPUBindGroupLayout wgpuLayout)
+{
+    std::lock_guard Lock{m_Mtx};
+
+    for (auto Iter = m_Entries.begin(); Iter != m_Entries.end();)
+    {
+        auto CurrIt = Iter++;
+        if (CurrIt->key.wgpuLayout == wgpuLayout)
+            EraseEntry(CurrIt);
+    }
+}
+
+} // namespace Diligent
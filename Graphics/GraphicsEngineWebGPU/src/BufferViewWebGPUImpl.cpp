@@ -52,4 +52,9 @@ BufferViewWebGPUImpl::BufferViewWebGPUImpl(IReferenceCounters*     pRefCounters,
 {
 }
 
+BufferViewWebGPUImpl::~BufferViewWebGPUImpl()
+{
+    m_pDevice->GetBindGroupCache().OnObjectReleased(GetUniqueID());
+}
+
 } // namespace Diligent
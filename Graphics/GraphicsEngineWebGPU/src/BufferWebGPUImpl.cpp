@@ -178,6 +178,11 @@ BufferWebGPUImpl::BufferWebGPUImpl(IReferenceCounters*        pRefCounters,
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
 }
 
+BufferWebGPUImpl::~BufferWebGPUImpl()
+{
+    m_pDevice->GetBindGroupCache().OnObjectReleased(GetUniqueID());
+}
+
 Uint64 BufferWebGPUImpl::GetNativeHandle()
 {
     return BitCast<Uint64>(GetWebGPUBuffer());
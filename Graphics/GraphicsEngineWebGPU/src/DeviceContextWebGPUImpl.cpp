@@ -43,6 +43,7 @@
 #include "AttachmentCleanerWebGPU.hpp"
 #include "WebGPUTypeConversions.hpp"
 #include "SyncPointWebGPU.hpp"
+#include "CommandListWebGPUImpl.hpp"
 
 namespace Diligent
 {
@@ -74,12 +75,16 @@ void DeviceContextWebGPUImpl::Begin(Uint32 ImmediateContextId)
 
 void DeviceContextWebGPUImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
-    RefCntAutoPtr<PipelineStateWebGPUImpl> pPipelineStateWebGPU{pPipelineState, PipelineStateWebGPUImpl::IID_InternalImpl};
-    VERIFY(pPipelineState == nullptr || pPipelineStateWebGPU != nullptr, "Unknown pipeline state object implementation");
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextWebGPUImpl::SetPipelineState");
+
+    BorrowedPtr<PipelineStateWebGPUImpl> pPipelineStateWebGPU = BorrowPipelineState(pPipelineState);
     if (PipelineStateWebGPUImpl::IsSameObject(m_pPipelineState, pPipelineStateWebGPU))
+    {
+        ++m_Stats.CommandCounters.RedundantSetPipelineState;
         return;
+    }
 
-    TDeviceContextBase::SetPipelineState(std::move(pPipelineStateWebGPU), 0 /*Dummy*/);
+    TDeviceContextBase::SetPipelineState(pPipelineStateWebGPU, 0 /*Dummy*/);
 
     m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_PIPELINE_STATE);
 
@@ -174,6 +179,8 @@ void DeviceContextWebGPUImpl::DvpValidateCommittedShaderResources()
 void DeviceContextWebGPUImpl::CommitShaderResources(IShaderResourceBinding*        pShaderResourceBinding,
                                                     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextWebGPUImpl::CommitShaderResources");
+
     TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0 /*Dummy*/);
 
     ShaderResourceBindingWebGPUImpl* pResBindingWebGPU = ClassPtrCast<ShaderResourceBindingWebGPUImpl>(pShaderResourceBinding);
@@ -188,7 +195,7 @@ void DeviceContextWebGPUImpl::CommitShaderResources(IShaderResourceBinding*
     ResourceCache.DbgVerifyDynamicBuffersCounter();
 #endif
 
-    const WGPUDevice wgpuDevice = m_pDevice->GetWebGPUDevice();
+    BindGroupCacheWebGPU& BindGroupCache = m_pDevice->GetBindGroupCache();
 
     const Uint32                         SRBIndex   = pResBindingWebGPU->GetBindingIndex();
     PipelineResourceSignatureWebGPUImpl* pSignature = pResBindingWebGPU->GetSignature();
@@ -201,7 +208,7 @@ void DeviceContextWebGPUImpl::CommitShaderResources(IShaderResourceBinding*
         WebGPUResourceBindInfo::BindGroupInfo& BindGroup = m_BindInfo.BindGroups[SRBIndex][BindGroupId];
         if (pSignature->HasBindGroup(BindGroupId))
         {
-            BindGroup.wgpuBindGroup = ResourceCache.UpdateBindGroup(wgpuDevice, BGIndex, pSignature->GetWGPUBindGroupLayout(BindGroupId));
+            BindGroup.wgpuBindGroup = ResourceCache.UpdateBindGroup(BindGroupCache, BGIndex, pSignature->GetWGPUBindGroupLayout(BindGroupId));
             ++BGIndex;
         }
         else
@@ -220,6 +227,74 @@ void SetBindGroup(WGPUComputePassEncoder Encoder, uint32_t GroupIndex, WGPUBindG
 {
     wgpuComputePassEncoderSetBindGroup(Encoder, GroupIndex, Group, DynamicOffsets.size(), !DynamicOffsets.empty() ? DynamicOffsets.data() : nullptr);
 }
+void SetBindGroup(WGPURenderBundleEncoder Encoder, uint32_t GroupIndex, WGPUBindGroup Group, const std::vector<Uint32>& DynamicOffsets)
+{
+    wgpuRenderBundleEncoderSetBindGroup(Encoder, GroupIndex, Group, DynamicOffsets.size(), !DynamicOffsets.empty() ? DynamicOffsets.data() : nullptr);
+}
+
+// Overloads that let the draw path record commands to either a render pass or a render bundle encoder
+void EncoderSetPipeline(WGPURenderPassEncoder Encoder, WGPURenderPipeline Pipeline)
+{
+    wgpuRenderPassEncoderSetPipeline(Encoder, Pipeline);
+}
+void EncoderSetPipeline(WGPURenderBundleEncoder Encoder, WGPURenderPipeline Pipeline)
+{
+    wgpuRenderBundleEncoderSetPipeline(Encoder, Pipeline);
+}
+
+void EncoderSetVertexBuffer(WGPURenderPassEncoder Encoder, Uint32 Slot, WGPUBuffer Buffer, Uint64 Offset, Uint64 Size)
+{
+    wgpuRenderPassEncoderSetVertexBuffer(Encoder, Slot, Buffer, Offset, Size);
+}
+void EncoderSetVertexBuffer(WGPURenderBundleEncoder Encoder, Uint32 Slot, WGPUBuffer Buffer, Uint64 Offset, Uint64 Size)
+{
+    wgpuRenderBundleEncoderSetVertexBuffer(Encoder, Slot, Buffer, Offset, Size);
+}
+
+void EncoderSetIndexBuffer(WGPURenderPassEncoder Encoder, WGPUBuffer Buffer, WGPUIndexFormat Format, Uint64 Offset, Uint64 Size)
+{
+    wgpuRenderPassEncoderSetIndexBuffer(Encoder, Buffer, Format, Offset, Size);
+}
+void EncoderSetIndexBuffer(WGPURenderBundleEncoder Encoder, WGPUBuffer Buffer, WGPUIndexFormat Format, Uint64 Offset, Uint64 Size)
+{
+    wgpuRenderBundleEncoderSetIndexBuffer(Encoder, Buffer, Format, Offset, Size);
+}
+
+void EncoderDraw(WGPURenderPassEncoder Encoder, Uint32 VertexCount, Uint32 InstanceCount, Uint32 FirstVertex, Uint32 FirstInstance)
+{
+    wgpuRenderPassEncoderDraw(Encoder, VertexCount, InstanceCount, FirstVertex, FirstInstance);
+}
+void EncoderDraw(WGPURenderBundleEncoder Encoder, Uint32 VertexCount, Uint32 InstanceCount, Uint32 FirstVertex, Uint32 FirstInstance)
+{
+    wgpuRenderBundleEncoderDraw(Encoder, VertexCount, InstanceCount, FirstVertex, FirstInstance);
+}
+
+void EncoderDrawIndexed(WGPURenderPassEncoder Encoder, Uint32 IndexCount, Uint32 InstanceCount, Uint32 FirstIndex, Int32 BaseVertex, Uint32 FirstInstance)
+{
+    wgpuRenderPassEncoderDrawIndexed(Encoder, IndexCount, InstanceCount, FirstIndex, BaseVertex, FirstInstance);
+}
+void EncoderDrawIndexed(WGPURenderBundleEncoder Encoder, Uint32 IndexCount, Uint32 InstanceCount, Uint32 FirstIndex, Int32 BaseVertex, Uint32 FirstInstance)
+{
+    wgpuRenderBundleEncoderDrawIndexed(Encoder, IndexCount, InstanceCount, FirstIndex, BaseVertex, FirstInstance);
+}
+
+void EncoderDrawIndirect(WGPURenderPassEncoder Encoder, WGPUBuffer IndirectBuffer, Uint64 IndirectOffset)
+{
+    wgpuRenderPassEncoderDrawIndirect(Encoder, IndirectBuffer, IndirectOffset);
+}
+void EncoderDrawIndirect(WGPURenderBundleEncoder Encoder, WGPUBuffer IndirectBuffer, Uint64 IndirectOffset)
+{
+    wgpuRenderBundleEncoderDrawIndirect(Encoder, IndirectBuffer, IndirectOffset);
+}
+
+void EncoderDrawIndexedIndirect(WGPURenderPassEncoder Encoder, WGPUBuffer IndirectBuffer, Uint64 IndirectOffset)
+{
+    wgpuRenderPassEncoderDrawIndexedIndirect(Encoder, IndirectBuffer, IndirectOffset);
+}
+void EncoderDrawIndexedIndirect(WGPURenderBundleEncoder Encoder, WGPUBuffer IndirectBuffer, Uint64 IndirectOffset)
+{
+    wgpuRenderBundleEncoderDrawIndexedIndirect(Encoder, IndirectBuffer, IndirectOffset);
+}
 
 template <typename CmdEncoderType>
 void DeviceContextWebGPUImpl::CommitBindGroups(CmdEncoderType CmdEncoder, Uint32 CommitSRBMask)
@@ -302,8 +377,8 @@ void DeviceContextWebGPUImpl::SetVertexBuffers(Uint32                         St
                                                RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                                SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
-    TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
-    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_VERTEX_BUFFERS);
+    if (TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags, 0))
+        m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_VERTEX_BUFFERS);
 }
 
 
@@ -311,8 +386,8 @@ void DeviceContextWebGPUImpl::SetIndexBuffer(IBuffer*                       pInd
                                              Uint64                         ByteOffset,
                                              RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
-    TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
-    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_INDEX_BUFFER);
+    if (TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode, 0))
+        m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_INDEX_BUFFER);
 }
 
 void DeviceContextWebGPUImpl::SetViewports(Uint32          NumViewports,
@@ -320,14 +395,14 @@ void DeviceContextWebGPUImpl::SetViewports(Uint32          NumViewports,
                                            Uint32          RTWidth,
                                            Uint32          RTHeight)
 {
-    TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
-    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_VIEWPORTS);
+    if (TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight))
+        m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_VIEWPORTS);
 }
 
 void DeviceContextWebGPUImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
-    TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
-    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_SCISSOR_RECTS);
+    if (TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight))
+        m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_SCISSOR_RECTS);
 }
 
 void DeviceContextWebGPUImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs)
@@ -381,6 +456,7 @@ void DeviceContextWebGPUImpl::EndRenderPass()
 
 void DeviceContextWebGPUImpl::Draw(const DrawAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::Draw(Attribs, 0);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -390,12 +466,16 @@ void DeviceContextWebGPUImpl::Draw(const DrawAttribs& Attribs)
     if (Attribs.NumVertices == 0 || Attribs.NumInstances == 0)
         return;
 
-    WGPURenderPassEncoder wgpuRenderCmdEncoder = PrepareForDraw(Attribs.Flags);
-    wgpuRenderPassEncoderDraw(wgpuRenderCmdEncoder, Attribs.NumVertices, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
+    EncodeDrawCommand([&](auto CmdEncoder) //
+                      {
+                          PrepareForDraw(CmdEncoder, Attribs.Flags);
+                          EncoderDraw(CmdEncoder, Attribs.NumVertices, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
+                      });
 }
 
 void DeviceContextWebGPUImpl::MultiDraw(const MultiDrawAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDraw(Attribs, 0);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -405,17 +485,21 @@ void DeviceContextWebGPUImpl::MultiDraw(const MultiDrawAttribs& Attribs)
     if (Attribs.NumInstances == 0)
         return;
 
-    WGPURenderPassEncoder wgpuRenderCmdEncoder = PrepareForDraw(Attribs.Flags);
-    for (Uint32 DrawIdx = 0; DrawIdx < Attribs.DrawCount; ++DrawIdx)
-    {
-        const MultiDrawItem& Item = Attribs.pDrawItems[DrawIdx];
-        if (Item.NumVertices > 0)
-            wgpuRenderPassEncoderDraw(wgpuRenderCmdEncoder, Item.NumVertices, Attribs.NumInstances, Item.StartVertexLocation, Attribs.FirstInstanceLocation);
-    }
+    EncodeDrawCommand([&](auto CmdEncoder) //
+                      {
+                          PrepareForDraw(CmdEncoder, Attribs.Flags);
+                          for (Uint32 DrawIdx = 0; DrawIdx < Attribs.DrawCount; ++DrawIdx)
+                          {
+                              const MultiDrawItem& Item = Attribs.pDrawItems[DrawIdx];
+                              if (Item.NumVertices > 0)
+                                  EncoderDraw(CmdEncoder, Item.NumVertices, Attribs.NumInstances, Item.StartVertexLocation, Attribs.FirstInstanceLocation);
+                          }
+                      });
 }
 
 void DeviceContextWebGPUImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexed(Attribs, 0);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -425,12 +509,16 @@ void DeviceContextWebGPUImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
     if (Attribs.NumIndices == 0 || Attribs.NumInstances == 0)
         return;
 
-    WGPURenderPassEncoder wgpuRenderCmdEncoder = PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
-    wgpuRenderPassEncoderDrawIndexed(wgpuRenderCmdEncoder, Attribs.NumIndices, Attribs.NumInstances, Attribs.FirstIndexLocation, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
+    EncodeDrawCommand([&](auto CmdEncoder) //
+                      {
+                          PrepareForIndexedDraw(CmdEncoder, Attribs.Flags, Attribs.IndexType);
+                          EncoderDrawIndexed(CmdEncoder, Attribs.NumIndices, Attribs.NumInstances, Attribs.FirstIndexLocation, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
+                      });
 }
 
 void DeviceContextWebGPUImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::MultiDrawIndexed(Attribs, 0);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -440,17 +528,21 @@ void DeviceContextWebGPUImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& At
     if (Attribs.NumInstances == 0)
         return;
 
-    WGPURenderPassEncoder wgpuRenderCmdEncoder = PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
-    for (Uint32 DrawIdx = 0; DrawIdx < Attribs.DrawCount; ++DrawIdx)
-    {
-        const MultiDrawIndexedItem& Item = Attribs.pDrawItems[DrawIdx];
-        if (Item.NumIndices > 0)
-            wgpuRenderPassEncoderDrawIndexed(wgpuRenderCmdEncoder, Item.NumIndices, Attribs.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Attribs.FirstInstanceLocation);
-    }
+    EncodeDrawCommand([&](auto CmdEncoder) //
+                      {
+                          PrepareForIndexedDraw(CmdEncoder, Attribs.Flags, Attribs.IndexType);
+                          for (Uint32 DrawIdx = 0; DrawIdx < Attribs.DrawCount; ++DrawIdx)
+                          {
+                              const MultiDrawIndexedItem& Item = Attribs.pDrawItems[DrawIdx];
+                              if (Item.NumIndices > 0)
+                                  EncoderDrawIndexed(CmdEncoder, Item.NumIndices, Attribs.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Attribs.FirstInstanceLocation);
+                          }
+                      });
 }
 
 void DeviceContextWebGPUImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndirect(Attribs, 0);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -459,19 +551,26 @@ void DeviceContextWebGPUImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
         ClassPtrCast<BufferWebGPUImpl>(Attribs.pAttribsBuffer)->DvpVerifyDynamicAllocation(this);
 #endif
 
-    WGPURenderPassEncoder wgpuRenderCmdEncoder = PrepareForDraw(Attribs.Flags);
-    Uint64                IndirectBufferOffset = Attribs.DrawArgsOffset;
-    WGPUBuffer            wgpuIndirectBuffer   = PrepareForIndirectCommand(Attribs.pAttribsBuffer, IndirectBufferOffset);
+    DEV_CHECK_ERR(!m_wgpuRenderBundleEncoder || Attribs.pAttribsBuffer->GetDesc().Usage != USAGE_DYNAMIC,
+                  "Dynamic indirect argument buffers can't be used while recording a render bundle");
 
-    for (Uint32 DrawIdx = 0; DrawIdx < Attribs.DrawCount; ++DrawIdx)
-    {
-        wgpuRenderPassEncoderDrawIndirect(wgpuRenderCmdEncoder, wgpuIndirectBuffer, IndirectBufferOffset);
-        IndirectBufferOffset += Attribs.DrawArgsStride;
-    }
+    EncodeDrawCommand([&](auto CmdEncoder) //
+                      {
+                          PrepareForDraw(CmdEncoder, Attribs.Flags);
+                          Uint64     IndirectBufferOffset = Attribs.DrawArgsOffset;
+                          WGPUBuffer wgpuIndirectBuffer   = PrepareForIndirectCommand(Attribs.pAttribsBuffer, IndirectBufferOffset);
+
+                          for (Uint32 DrawIdx = 0; DrawIdx < Attribs.DrawCount; ++DrawIdx)
+                          {
+                              EncoderDrawIndirect(CmdEncoder, wgpuIndirectBuffer, IndirectBufferOffset);
+                              IndirectBufferOffset += Attribs.DrawArgsStride;
+                          }
+                      });
 }
 
 void DeviceContextWebGPUImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DrawIndexedIndirect(Attribs, 0);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -480,15 +579,21 @@ void DeviceContextWebGPUImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttri
         ClassPtrCast<BufferWebGPUImpl>(Attribs.pAttribsBuffer)->DvpVerifyDynamicAllocation(this);
 #endif
 
-    WGPURenderPassEncoder wgpuRenderCmdEncoder = PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
-    Uint64                IndirectBufferOffset = Attribs.DrawArgsOffset;
-    WGPUBuffer            wgpuIndirectBuffer   = PrepareForIndirectCommand(Attribs.pAttribsBuffer, IndirectBufferOffset);
+    DEV_CHECK_ERR(!m_wgpuRenderBundleEncoder || Attribs.pAttribsBuffer->GetDesc().Usage != USAGE_DYNAMIC,
+                  "Dynamic indirect argument buffers can't be used while recording a render bundle");
 
-    for (Uint32 DrawIdx = 0; DrawIdx < Attribs.DrawCount; ++DrawIdx)
-    {
-        wgpuRenderPassEncoderDrawIndexedIndirect(wgpuRenderCmdEncoder, wgpuIndirectBuffer, IndirectBufferOffset);
-        IndirectBufferOffset += Attribs.DrawArgsStride;
-    }
+    EncodeDrawCommand([&](auto CmdEncoder) //
+                      {
+                          PrepareForIndexedDraw(CmdEncoder, Attribs.Flags, Attribs.IndexType);
+                          Uint64     IndirectBufferOffset = Attribs.DrawArgsOffset;
+                          WGPUBuffer wgpuIndirectBuffer   = PrepareForIndirectCommand(Attribs.pAttribsBuffer, IndirectBufferOffset);
+
+                          for (Uint32 DrawIdx = 0; DrawIdx < Attribs.DrawCount; ++DrawIdx)
+                          {
+                              EncoderDrawIndexedIndirect(CmdEncoder, wgpuIndirectBuffer, IndirectBufferOffset);
+                              IndirectBufferOffset += Attribs.DrawArgsStride;
+                          }
+                      });
 }
 
 void DeviceContextWebGPUImpl::DrawMesh(const DrawMeshAttribs& Attribs)
@@ -503,6 +608,7 @@ void DeviceContextWebGPUImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& At
 
 void DeviceContextWebGPUImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchCompute(Attribs, 0);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -518,6 +624,7 @@ void DeviceContextWebGPUImpl::DispatchCompute(const DispatchComputeAttribs& Attr
 
 void DeviceContextWebGPUImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
+    const auto CPUTimer = SampleCPUTime();
     TDeviceContextBase::DispatchComputeIndirect(Attribs, 0);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -1258,7 +1365,41 @@ void DeviceContextWebGPUImpl::FinishCommandList(ICommandList** ppCommandList)
 
 void DeviceContextWebGPUImpl::ExecuteCommandLists(Uint32 NumCommandLists, ICommandList* const* ppCommandLists)
 {
-    LOG_ERROR("Deferred contexts are not supported in WebGPU");
+    DEV_CHECK_ERR(!m_wgpuRenderBundleEncoder, "Command lists can't be executed while a render bundle is being recorded");
+    if (NumCommandLists == 0)
+        return;
+    DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
+
+    std::vector<WGPURenderBundle> wgpuRenderBundles;
+    wgpuRenderBundles.reserve(NumCommandLists);
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        if (ppCommandLists[i] == nullptr)
+        {
+            DEV_ERROR("Command list at index ", i, " is null");
+            continue;
+        }
+        wgpuRenderBundles.push_back(ClassPtrCast<CommandListWebGPUImpl>(ppCommandLists[i])->GetWebGPURenderBundle());
+    }
+    if (wgpuRenderBundles.empty())
+        return;
+
+    WGPURenderPassEncoder wgpuRenderCmdEncoder = GetRenderPassCommandEncoder();
+
+    // Render bundles inherit viewport, scissor rect, blend constant and stencil reference from the render pass.
+    // The blend factors and stencil reference are set unconditionally since their state flags depend on the
+    // currently bound pipeline, not on the pipelines used by the bundles.
+    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_BLEND_FACTORS);
+    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_STENCIL_REF);
+    CommitDynamicState(wgpuRenderCmdEncoder);
+
+    wgpuRenderPassEncoderExecuteBundles(wgpuRenderCmdEncoder, wgpuRenderBundles.size(), wgpuRenderBundles.data());
+
+    // Executing bundles resets the pipeline, bind groups, and vertex and index buffers of the render pass
+    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_PIPELINE_STATE);
+    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_VERTEX_BUFFERS);
+    m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_INDEX_BUFFER);
+    m_BindInfo.StaleSRBMask |= m_BindInfo.ActiveSRBMask;
 }
 
 void DeviceContextWebGPUImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
@@ -1306,6 +1447,7 @@ void DeviceContextWebGPUImpl::BeginQuery(IQuery* pQuery)
             wgpuComputePassEncoderWriteTimestamp(GetComputePassCommandEncoder(), wgpuQuerySet, QuerySetIdx);
         else
             wgpuCommandEncoderWriteTimestamp(GetCommandEncoder(), wgpuQuerySet, QuerySetIdx);
+        GetQueryManager().OnQueryWritten(QueryType, QuerySetIdx);
     }
     else if (QueryType == QUERY_TYPE_OCCLUSION)
     {
@@ -1351,6 +1493,7 @@ void DeviceContextWebGPUImpl::EndQuery(IQuery* pQuery)
             wgpuComputePassEncoderWriteTimestamp(GetComputePassCommandEncoder(), wgpuQuerySet, QuerySetIdx);
         else
             wgpuCommandEncoderWriteTimestamp(GetCommandEncoder(), wgpuQuerySet, QuerySetIdx);
+        GetQueryManager().OnQueryWritten(QueryType, QuerySetIdx);
     }
     else if (QueryType == QUERY_TYPE_OCCLUSION)
     {
@@ -1373,6 +1516,7 @@ void DeviceContextWebGPUImpl::EndQuery(IQuery* pQuery)
             wgpuRenderPassEncoderEndOcclusionQuery(GetRenderPassCommandEncoder());
         else
             UNEXPECTED("Unexpected behavior");
+        GetQueryManager().OnQueryWritten(QueryType, QuerySetIdx);
     }
     else
     {
@@ -1382,6 +1526,8 @@ void DeviceContextWebGPUImpl::EndQuery(IQuery* pQuery)
 
 void DeviceContextWebGPUImpl::Flush()
 {
+    DILIGENT_CPU_PROFILE_SCOPE("DeviceContextWebGPUImpl::Flush");
+
     EnqueueSignal(m_pFence, ++m_FenceValue);
     EndCommandEncoders();
 
@@ -1399,11 +1545,7 @@ void DeviceContextWebGPUImpl::Flush()
     m_DynamicMemPages.clear();
 
     for (UploadMemoryManagerWebGPU::Page& MemPage : m_UploadMemPages)
-    {
         MemPage.FlushWrites(m_wgpuQueue);
-        MemPage.Recycle();
-    }
-    m_UploadMemPages.clear();
 
     if (m_wgpuCommandEncoder || !m_SignaledFences.empty())
     {
@@ -1414,11 +1556,12 @@ void DeviceContextWebGPUImpl::Flush()
             pSyncPoint->Release();
         };
 
-        GetQueryManager().ResolveQuerySet(m_pDevice, this);
+        GetQueryManager().ResolveQuerySet(m_pDevice, this, m_FenceValue);
 
         RefCntAutoPtr<SyncPointWebGPUImpl> pWorkDoneSyncPoint{MakeNewRCObj<SyncPointWebGPUImpl>()()};
 
-        std::vector<RefCntAutoPtr<SyncPointWebGPUImpl>> SyncPoints;
+        SyncPointList& SyncPoints = m_FlushSyncPoints;
+        VERIFY_EXPR(SyncPoints.empty());
         SyncPoints.push_back(pWorkDoneSyncPoint);
         for (const auto& PendingReadIt : m_PendingStagingReads)
             SyncPoints.push_back(PendingReadIt.first->pSyncPoint);
@@ -1428,12 +1571,14 @@ void DeviceContextWebGPUImpl::Flush()
             Fence->AppendSyncPoints(SyncPoints, Value);
         }
         m_SignaledFences.clear();
+        SyncPoints.clear();
 
         WGPUCommandBufferDescriptor wgpuCmdBufferDesc{};
         WebGPUCommandBufferWrapper  wgpuCmdBuffer{wgpuCommandEncoderFinish(GetCommandEncoder(), &wgpuCmdBufferDesc)};
         DEV_CHECK_ERR(wgpuCmdBuffer != nullptr, "Failed to finish command encoder");
 
         wgpuQueueSubmit(m_wgpuQueue, 1, &wgpuCmdBuffer.Get());
+        ++m_Stats.SubmitCount;
         wgpuQueueOnSubmittedWorkDone(m_wgpuQueue, WorkDoneCallback, pWorkDoneSyncPoint.Detach());
         m_wgpuCommandEncoder.Reset(nullptr);
 
@@ -1444,6 +1589,12 @@ void DeviceContextWebGPUImpl::Flush()
         m_PendingStagingReads.clear();
     }
 
+    // Upload pages are recycled after the submit since mapped pages are asynchronously mapped again,
+    // and a buffer with a pending map can't be used by a submitted command buffer.
+    for (UploadMemoryManagerWebGPU::Page& MemPage : m_UploadMemPages)
+        MemPage.Recycle();
+    m_UploadMemPages.clear();
+
     // Without DeviceTick(), the work done callback is never called
     m_pDevice->DeviceTick();
 }
@@ -1506,6 +1657,26 @@ void DeviceContextWebGPUImpl::BindSparseResourceMemory(const BindSparseResourceM
     UNSUPPORTED("BindSparseResourceMemory is not supported in WebGPU");
 }
 
+void DeviceContextWebGPUImpl::ResolveQueries(const ResolveQueriesAttribs& Attribs)
+{
+    UNSUPPORTED("ResolveQueries is not supported in WebGPU");
+}
+
+void DeviceContextWebGPUImpl::BeginConditionalRendering(const BeginConditionalRenderingAttribs& Attribs)
+{
+    UNSUPPORTED("BeginConditionalRendering is not supported in WebGPU");
+}
+
+void DeviceContextWebGPUImpl::EndConditionalRendering()
+{
+    UNSUPPORTED("EndConditionalRendering is not supported in WebGPU");
+}
+
+void DeviceContextWebGPUImpl::SetDynamicRenderState(const DynamicRenderState& State)
+{
+    UNSUPPORTED("SetDynamicRenderState is not supported in WebGPU");
+}
+
 void DeviceContextWebGPUImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 {
     VERIFY(!(m_wgpuRenderPassEncoder && m_wgpuComputePassEncoder), "Another command encoder is currently active");
@@ -1665,6 +1836,67 @@ WGPUQueue DeviceContextWebGPUImpl::GetWebGPUQueue()
     return m_wgpuQueue;
 }
 
+void DeviceContextWebGPUImpl::BeginRenderBundle(const Char* Name)
+{
+    DEV_CHECK_ERR(!m_wgpuRenderBundleEncoder, "Another render bundle is already being recorded. Call EndRenderBundle() first.");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Render bundles can't be recorded inside a render pass");
+    DEV_CHECK_ERR(m_NumBoundRenderTargets > 0 || m_pBoundDepthStencil, "Render bundle requires at least one render target or depth-stencil buffer to be bound");
+
+    WGPUTextureFormat wgpuColorFormats[MAX_RENDER_TARGETS] = {};
+    for (Uint32 RTIndex = 0; RTIndex < m_NumBoundRenderTargets; ++RTIndex)
+    {
+        if (TextureViewWebGPUImpl* pRTV = m_pBoundRenderTargets[RTIndex])
+            wgpuColorFormats[RTIndex] = TextureFormatToWGPUFormat(pRTV->GetDesc().Format);
+        else
+            wgpuColorFormats[RTIndex] = WGPUTextureFormat_Undefined;
+    }
+
+    WGPURenderBundleEncoderDescriptor wgpuRenderBundleEncoderDesc{};
+    wgpuRenderBundleEncoderDesc.label              = GetWGPUStringView(Name);
+    wgpuRenderBundleEncoderDesc.colorFormatCount   = m_NumBoundRenderTargets;
+    wgpuRenderBundleEncoderDesc.colorFormats       = wgpuColorFormats;
+    wgpuRenderBundleEncoderDesc.depthStencilFormat = m_pBoundDepthStencil ? TextureFormatToWGPUFormat(m_pBoundDepthStencil->GetDesc().Format) : WGPUTextureFormat_Undefined;
+    wgpuRenderBundleEncoderDesc.sampleCount        = std::max(m_FramebufferSamples, 1u);
+    if (m_pBoundDepthStencil && m_pBoundDepthStencil->GetDesc().ViewType == TEXTURE_VIEW_READ_ONLY_DEPTH_STENCIL)
+    {
+        wgpuRenderBundleEncoderDesc.depthReadOnly   = true;
+        wgpuRenderBundleEncoderDesc.stencilReadOnly = true;
+    }
+
+    m_wgpuRenderBundleEncoder.Reset(wgpuDeviceCreateRenderBundleEncoder(m_pDevice->GetWebGPUDevice(), &wgpuRenderBundleEncoderDesc));
+    DEV_CHECK_ERR(m_wgpuRenderBundleEncoder != nullptr, "Failed to create render bundle encoder");
+    m_RenderBundleName = Name != nullptr ? Name : "";
+
+    // The bundle starts with no pipeline, bind groups or buffers set
+    ClearEncoderState();
+}
+
+void DeviceContextWebGPUImpl::EndRenderBundle(ICommandList** ppCommandList)
+{
+    DEV_CHECK_ERR(ppCommandList != nullptr, "ppCommandList must not be null");
+    DEV_CHECK_ERR(m_wgpuRenderBundleEncoder, "There is no render bundle being recorded. Call BeginRenderBundle() first.");
+    if (!m_wgpuRenderBundleEncoder)
+        return;
+
+    WGPURenderBundleDescriptor wgpuRenderBundleDesc{};
+    wgpuRenderBundleDesc.label = GetWGPUStringView(m_RenderBundleName);
+
+    WGPURenderBundle wgpuRenderBundle = wgpuRenderBundleEncoderFinish(m_wgpuRenderBundleEncoder, &wgpuRenderBundleDesc);
+    DEV_CHECK_ERR(wgpuRenderBundle != nullptr, "Failed to finish render bundle");
+    m_wgpuRenderBundleEncoder.Reset(nullptr);
+
+    CommandListDesc Desc;
+    Desc.Name = m_RenderBundleName.c_str();
+
+    CommandListWebGPUImpl* pCmdListWebGPU{NEW_RC_OBJ(GetRawAllocator(), "CommandListWebGPUImpl instance", CommandListWebGPUImpl)(m_pDevice, Desc, wgpuRenderBundle)};
+    pCmdListWebGPU->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+    m_RenderBundleName.clear();
+
+    // The render pass encoder state was not affected by the bundle, but the context state was
+    // committed to the bundle encoder, so it needs to be committed again.
+    ClearEncoderState();
+}
+
 WGPUCommandEncoder DeviceContextWebGPUImpl::GetCommandEncoder()
 {
     if (!m_wgpuCommandEncoder)
@@ -1679,6 +1911,8 @@ WGPUCommandEncoder DeviceContextWebGPUImpl::GetCommandEncoder()
 
 WGPURenderPassEncoder DeviceContextWebGPUImpl::GetRenderPassCommandEncoder()
 {
+    DEV_CHECK_ERR(!m_wgpuRenderBundleEncoder, "Render pass commands can't be recorded while a render bundle is being recorded");
+
     if (!m_wgpuRenderPassEncoder)
     {
         EndCommandEncoders(COMMAND_ENCODER_FLAG_ALL & ~COMMAND_ENCODER_FLAG_RENDER);
@@ -1988,28 +2222,22 @@ void DeviceContextWebGPUImpl::ClearAttachment(Int32                     RTIndex,
     m_EncoderState.Invalidate(WebGPUEncoderState::CMD_ENCODER_STATE_PIPELINE_STATE);
 }
 
-WGPURenderPassEncoder DeviceContextWebGPUImpl::PrepareForDraw(DRAW_FLAGS Flags)
+template <typename HandlerType>
+void DeviceContextWebGPUImpl::EncodeDrawCommand(HandlerType&& Handler)
 {
-#ifdef DILIGENT_DEVELOPMENT
-    if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
-        DvpVerifyRenderTargets();
-#endif
-    DEV_CHECK_ERR(m_pPipelineState != nullptr, "No PSO is bound in the context");
-
-    WGPURenderPassEncoder wgpuRenderCmdEncoder = GetRenderPassCommandEncoder();
-
-    // Handle pipeline state first because CommitGraphicsPSO may update another flags
-    if (!m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_PIPELINE_STATE))
-        CommitGraphicsPSO(wgpuRenderCmdEncoder);
-
-    if (!m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_VERTEX_BUFFERS) || (m_EncoderState.HasDynamicVertexBuffers && (Flags & DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT) == 0))
-        CommitVertexBuffers(wgpuRenderCmdEncoder);
+    if (m_wgpuRenderBundleEncoder)
+        Handler(m_wgpuRenderBundleEncoder.Get());
+    else
+        Handler(GetRenderPassCommandEncoder());
+}
 
+void DeviceContextWebGPUImpl::CommitDynamicState(WGPURenderPassEncoder CmdEncoder)
+{
     if (!m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_VIEWPORTS))
-        CommitViewports(wgpuRenderCmdEncoder);
+        CommitViewports(CmdEncoder);
 
     if (!m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_SCISSOR_RECTS))
-        CommitScissorRects(wgpuRenderCmdEncoder);
+        CommitScissorRects(CmdEncoder);
 
     if (!m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_BLEND_FACTORS))
     {
@@ -2019,32 +2247,53 @@ WGPURenderPassEncoder DeviceContextWebGPUImpl::PrepareForDraw(DRAW_FLAGS Flags)
         wgpuBlendColor.b = m_BlendFactors[2];
         wgpuBlendColor.a = m_BlendFactors[3];
 
-        wgpuRenderPassEncoderSetBlendConstant(wgpuRenderCmdEncoder, &wgpuBlendColor);
+        wgpuRenderPassEncoderSetBlendConstant(CmdEncoder, &wgpuBlendColor);
         m_EncoderState.SetUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_BLEND_FACTORS);
     }
 
     if (!m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_STENCIL_REF))
     {
-        wgpuRenderPassEncoderSetStencilReference(wgpuRenderCmdEncoder, m_StencilRef);
+        wgpuRenderPassEncoderSetStencilReference(CmdEncoder, m_StencilRef);
         m_EncoderState.SetUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_STENCIL_REF);
     }
+}
 
-    if (auto CommitSRBMask = m_BindInfo.GetCommitMask(Flags & DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT))
-        CommitBindGroups(wgpuRenderCmdEncoder, CommitSRBMask);
+template <typename CmdEncoderType>
+void DeviceContextWebGPUImpl::PrepareForDraw(CmdEncoderType CmdEncoder, DRAW_FLAGS Flags)
+{
+#ifdef DILIGENT_DEVELOPMENT
+    if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
+        DvpVerifyRenderTargets();
+#endif
+    DEV_CHECK_ERR(m_pPipelineState != nullptr, "No PSO is bound in the context");
+
+    // Handle pipeline state first because CommitGraphicsPSO may update another flags
+    if (!m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_PIPELINE_STATE))
+        CommitGraphicsPSO(CmdEncoder);
+
+    if (!m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_VERTEX_BUFFERS) || (m_EncoderState.HasDynamicVertexBuffers && (Flags & DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT) == 0))
+        CommitVertexBuffers(CmdEncoder);
+
+    CommitDynamicState(CmdEncoder);
 
-    return wgpuRenderCmdEncoder;
+    if (auto CommitSRBMask = m_BindInfo.GetCommitMask(Flags & DRAW_FLAG_DYNAMIC_RESOURCE_BUFFERS_INTACT))
+    {
+        DEV_CHECK_ERR(!m_wgpuRenderBundleEncoder || (CommitSRBMask & m_BindInfo.DynamicSRBMask) == 0,
+                      "Shader resource bindings with dynamic buffers can't be used while recording a render bundle: "
+                      "dynamic offsets are baked into the bundle, but dynamic buffer memory changes every time the buffer is mapped.");
+        CommitBindGroups(CmdEncoder, CommitSRBMask);
+    }
 }
 
-WGPURenderPassEncoder DeviceContextWebGPUImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE IndexType)
+template <typename CmdEncoderType>
+void DeviceContextWebGPUImpl::PrepareForIndexedDraw(CmdEncoderType CmdEncoder, DRAW_FLAGS Flags, VALUE_TYPE IndexType)
 {
     DEV_CHECK_ERR(m_pPipelineState != nullptr, "No PSO is bound in the context");
 
-    WGPURenderPassEncoder wgpuRenderCmdEncoder = PrepareForDraw(Flags);
+    PrepareForDraw(CmdEncoder, Flags);
 
     if (!m_EncoderState.IsUpToDate((WebGPUEncoderState::CMD_ENCODER_STATE_INDEX_BUFFER)))
-        CommitIndexBuffer(wgpuRenderCmdEncoder, IndexType);
-
-    return wgpuRenderCmdEncoder;
+        CommitIndexBuffer(CmdEncoder, IndexType);
 }
 
 WGPUComputePassEncoder DeviceContextWebGPUImpl::PrepareForDispatchCompute()
@@ -2081,13 +2330,14 @@ WGPUBuffer DeviceContextWebGPUImpl::PrepareForIndirectCommand(IBuffer* pAttribsB
     return wgpuIndirectBuffer;
 }
 
-void DeviceContextWebGPUImpl::CommitGraphicsPSO(WGPURenderPassEncoder CmdEncoder)
+template <typename CmdEncoderType>
+void DeviceContextWebGPUImpl::CommitGraphicsPSO(CmdEncoderType CmdEncoder)
 {
     DEV_CHECK_ERR(m_pPipelineState, "No pipeline state to commit!");
     DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS, "Current PSO is not a graphics pipeline");
 
     WGPURenderPipeline wgpuPipeline = m_pPipelineState->GetWebGPURenderPipeline();
-    wgpuRenderPassEncoderSetPipeline(CmdEncoder, wgpuPipeline);
+    EncoderSetPipeline(CmdEncoder, wgpuPipeline);
 
     const auto& GraphicsPipeline = m_pPipelineState->GetGraphicsPipelineDesc();
     const auto& BlendDesc        = GraphicsPipeline.BlendDesc;
@@ -2122,7 +2372,8 @@ void DeviceContextWebGPUImpl::CommitComputePSO(WGPUComputePassEncoder CmdEncoder
     m_EncoderState.SetUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_PIPELINE_STATE);
 }
 
-void DeviceContextWebGPUImpl::CommitVertexBuffers(WGPURenderPassEncoder CmdEncoder)
+template <typename CmdEncoderType>
+void DeviceContextWebGPUImpl::CommitVertexBuffers(CmdEncoderType CmdEncoder)
 {
     DEV_CHECK_ERR(m_pPipelineState, "No pipeline state to commit!");
 
@@ -2145,6 +2396,7 @@ void DeviceContextWebGPUImpl::CommitVertexBuffers(WGPURenderPassEncoder CmdEncod
             wgpuBuffer = pBufferWebGPU->GetWebGPUBuffer();
             if (Desc.Usage == USAGE_DYNAMIC)
             {
+                DEV_CHECK_ERR(!m_wgpuRenderBundleEncoder, "Dynamic vertex buffer '", Desc.Name, "' can't be used while recording a render bundle");
                 m_EncoderState.HasDynamicVertexBuffers = true;
 #ifdef DILIGENT_DEVELOPMENT
                 pBufferWebGPU->DvpVerifyDynamicAllocation(this);
@@ -2158,7 +2410,7 @@ void DeviceContextWebGPUImpl::CommitVertexBuffers(WGPURenderPassEncoder CmdEncod
         if (m_EncoderState.VertexBufferOffsets[SlotIdx] != Offset || !m_EncoderState.IsUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_VERTEX_BUFFERS))
         {
             // Do NOT use WGPU_WHOLE_SIZE due to https://github.com/emscripten-core/emscripten/issues/20538
-            wgpuRenderPassEncoderSetVertexBuffer(CmdEncoder, SlotIdx, wgpuBuffer, Offset, Size);
+            EncoderSetVertexBuffer(CmdEncoder, SlotIdx, wgpuBuffer, Offset, Size);
             m_EncoderState.VertexBufferOffsets[SlotIdx] = Offset;
         }
     }
@@ -2166,25 +2418,26 @@ void DeviceContextWebGPUImpl::CommitVertexBuffers(WGPURenderPassEncoder CmdEncod
     m_EncoderState.SetUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_VERTEX_BUFFERS);
 }
 
-void DeviceContextWebGPUImpl::CommitIndexBuffer(WGPURenderPassEncoder CmdEncoder, VALUE_TYPE IndexType)
+template <typename CmdEncoderType>
+void DeviceContextWebGPUImpl::CommitIndexBuffer(CmdEncoderType CmdEncoder, VALUE_TYPE IndexType)
 {
     DEV_CHECK_ERR(m_pPipelineState, "No pipeline state to commit!");
     DEV_CHECK_ERR(IndexType == VT_UINT16 || IndexType == VT_UINT32, "Unsupported index format. Only R16_UINT and R32_UINT are allowed.");
 
     const BufferDesc& IndexBuffDesc = m_pIndexBuffer->GetDesc();
+    DEV_CHECK_ERR(!m_wgpuRenderBundleEncoder || IndexBuffDesc.Usage != USAGE_DYNAMIC,
+                  "Dynamic index buffer '", IndexBuffDesc.Name, "' can't be used while recording a render bundle");
     const Uint64      Offset        = m_IndexDataStartOffset + m_pIndexBuffer->GetDynamicOffset(GetContextId(), this);
     // Do NOT use WGPU_WHOLE_SIZE due to https://github.com/emscripten-core/emscripten/issues/20538
     VERIFY_EXPR(IndexBuffDesc.Size >= m_IndexDataStartOffset);
     const Uint64 Size = IndexBuffDesc.Size - m_IndexDataStartOffset;
-    wgpuRenderPassEncoderSetIndexBuffer(CmdEncoder, m_pIndexBuffer->GetWebGPUBuffer(), IndexTypeToWGPUIndexFormat(IndexType), Offset, Size);
+    EncoderSetIndexBuffer(CmdEncoder, m_pIndexBuffer->GetWebGPUBuffer(), IndexTypeToWGPUIndexFormat(IndexType), Offset, Size);
     if (IndexBuffDesc.Usage != USAGE_DYNAMIC)
         m_EncoderState.SetUpToDate(WebGPUEncoderState::CMD_ENCODER_STATE_INDEX_BUFFER);
 }
 
 void DeviceContextWebGPUImpl::CommitViewports(WGPURenderPassEncoder CmdEncoder)
 {
-    DEV_CHECK_ERR(m_pPipelineState, "No pipeline state to commit!");
-
     bool UpdateViewports = false;
 
     for (Uint32 ViewportIdx = 0; ViewportIdx < m_NumViewports; ++ViewportIdx)
@@ -2216,9 +2469,10 @@ void DeviceContextWebGPUImpl::CommitViewports(WGPURenderPassEncoder CmdEncoder)
 
 void DeviceContextWebGPUImpl::CommitScissorRects(WGPURenderPassEncoder CmdEncoder)
 {
-    DEV_CHECK_ERR(m_pPipelineState, "No pipeline state to commit!");
-
-    const bool ScissorEnabled = m_pPipelineState->GetGraphicsPipelineDesc().RasterizerDesc.ScissorEnable;
+    // There may be no graphics pipeline bound when render bundles are executed
+    const bool ScissorEnabled = (m_pPipelineState &&
+                                 m_pPipelineState->GetDesc().IsAnyGraphicsPipeline() &&
+                                 m_pPipelineState->GetGraphicsPipelineDesc().RasterizerDesc.ScissorEnable);
 
     bool UpdateScissorRects = false;
 
@@ -2302,6 +2556,7 @@ DynamicMemoryManagerWebGPU::Allocation DeviceContextWebGPUImpl::AllocateDynamicM
     }
 
     VERIFY_EXPR(Alloc);
+    m_Stats.DynamicMemoryAllocated += Size;
 #ifdef DILIGENT_DEVELOPMENT
     Alloc.dvpFrameNumber = GetFrameNumber();
 #endif
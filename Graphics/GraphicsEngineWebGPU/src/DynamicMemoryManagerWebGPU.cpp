@@ -162,6 +162,7 @@ DynamicMemoryManagerWebGPU::Page DynamicMemoryManagerWebGPU::GetPage(size_t Size
         {
             auto Result = std::move(*Iter);
             m_AvailablePages.erase(Iter);
+            m_AllocatedPageSize += Result.GetSize();
             return Result;
         }
         ++Iter;
@@ -175,6 +176,7 @@ DynamicMemoryManagerWebGPU::Page DynamicMemoryManagerWebGPU::GetPage(size_t Size
 
     size_t Offset = m_CurrentOffset;
     m_CurrentOffset += PageSize;
+    m_AllocatedPageSize += PageSize;
 
     return Page{this, PageSize, Offset};
 }
@@ -182,7 +184,14 @@ DynamicMemoryManagerWebGPU::Page DynamicMemoryManagerWebGPU::GetPage(size_t Size
 void DynamicMemoryManagerWebGPU::RecyclePage(Page&& Item)
 {
     std::lock_guard Lock{m_AvailablePagesMtx};
+    m_AllocatedPageSize -= Item.GetSize();
     m_AvailablePages.emplace_back(std::move(Item));
 }
 
+size_t DynamicMemoryManagerWebGPU::GetAllocatedPageSize()
+{
+    std::lock_guard Lock{m_AvailablePagesMtx};
+    return m_AllocatedPageSize;
+}
+
 } // namespace Diligent
@@ -400,6 +400,9 @@ GraphicsAdapterInfo GetGraphicsAdapterInfo(WGPUAdapter wgpuAdapter, WGPUDevice w
 
         Features.WireframeFill               = DEVICE_FEATURE_STATE_DISABLED;
         Features.FormattedBuffers            = DEVICE_FEATURE_STATE_DISABLED;
+        Features.ConditionalRendering        = DEVICE_FEATURE_STATE_DISABLED;
+        Features.MultiView                   = DEVICE_FEATURE_STATE_DISABLED;
+        Features.ExtendedDynamicState        = DEVICE_FEATURE_STATE_DISABLED;
         Features.ShaderResourceStaticArrays  = DEVICE_FEATURE_STATE_DISABLED;
         Features.ShaderResourceRuntimeArrays = DEVICE_FEATURE_STATE_DISABLED;
 
@@ -426,7 +429,7 @@ GraphicsAdapterInfo GetGraphicsAdapterInfo(WGPUAdapter wgpuAdapter, WGPUDevice w
         }
     }
 
-    ASSERT_SIZEOF(DeviceFeatures, 47, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
+    ASSERT_SIZEOF(DeviceFeatures, 50, "Did you add a new feature to DeviceFeatures? Please handle its status here.");
 
     WGPUSupportedLimits wgpuSupportedLimits{};
     if (wgpuAdapter)
@@ -85,12 +85,25 @@ void FenceWebGPUImpl::Signal(Uint64 Value)
 }
 
 void FenceWebGPUImpl::Wait(Uint64 Value)
+{
+    WaitWithTimeout(Value, FenceWaitTimeout::Infinite);
+}
+
+Bool FenceWebGPUImpl::WaitWithTimeout(Uint64 Value, Uint64 Timeout)
 {
 #if PLATFORM_EMSCRIPTEN
-    LOG_ERROR_MESSAGE("IFence::Wait() is not supported on the Web. Use non-blocking synchronization methods.");
+    if (Timeout != 0)
+        LOG_ERROR_MESSAGE("IFence::Wait() is not supported on the Web. Use non-blocking synchronization methods.");
+    return GetCompletedValue() >= Value;
 #else
+    FenceWaitTimeout WaitTimeout{Timeout};
     while (GetCompletedValue() < Value)
+    {
+        if (WaitTimeout.IsExpired())
+            return False;
         m_pDevice->DeviceTick();
+    }
+    return True;
 #endif
 }
 
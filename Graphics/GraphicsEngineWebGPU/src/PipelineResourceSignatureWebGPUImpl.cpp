@@ -697,6 +697,13 @@ WGPUBindGroupLayout PipelineResourceSignatureWebGPUImpl::GetWGPUBindGroupLayout(
 
 PipelineResourceSignatureWebGPUImpl::~PipelineResourceSignatureWebGPUImpl()
 {
+    // Release cached bind groups that use the layouts of this signature
+    for (const WebGPUBindGroupLayoutWrapper& wgpuBindGroupLayout : m_wgpuBindGroupLayouts)
+    {
+        if (wgpuBindGroupLayout && m_pDevice != nullptr)
+            m_pDevice->GetBindGroupCache().OnLayoutReleased(wgpuBindGroupLayout);
+    }
+
     Destruct();
 }
 
@@ -32,6 +32,7 @@
 #include "RenderPassWebGPUImpl.hpp"
 #include "WebGPUTypeConversions.hpp"
 #include "WGSLUtils.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 namespace Diligent
 {
@@ -395,7 +396,10 @@ void PipelineStateWebGPUImpl::InitializeWebGPURenderPipeline(const TShaderStages
         WGPUShaderModuleDescriptor wgpuShaderModuleDesc{};
         wgpuShaderModuleDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&wgpuShaderCodeDesc);
         wgpuShaderModuleDesc.label       = GetWGPUStringView(Stage.pShader->GetDesc().Name);
-        wgpuShaderModules[ShaderIdx].Reset(wgpuDeviceCreateShaderModule(m_pDevice->GetWebGPUDevice(), &wgpuShaderModuleDesc));
+        {
+            ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+            wgpuShaderModules[ShaderIdx].Reset(wgpuDeviceCreateShaderModule(m_pDevice->GetWebGPUDevice(), &wgpuShaderModuleDesc));
+        }
         VERIFY(wgpuShaderModules[ShaderIdx], "Failed to create WGPU shader module for shader '", Stage.pShader->GetDesc().Name, "'.");
 
         switch (Stage.Type)
@@ -585,6 +589,7 @@ void PipelineStateWebGPUImpl::InitializeWebGPURenderPipeline(const TShaderStages
     }
     else
     {
+        ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
         m_wgpuRenderPipeline.Reset(wgpuDeviceCreateRenderPipeline(m_pDevice->GetWebGPUDevice(), &wgpuRenderPipelineDesc));
         if (!m_wgpuRenderPipeline)
             LOG_ERROR_AND_THROW("Failed to create pipeline state");
@@ -606,7 +611,10 @@ void PipelineStateWebGPUImpl::InitializeWebGPUComputePipeline(const TShaderStage
     WGPUShaderModuleDescriptor wgpuShaderModuleDesc{};
     wgpuShaderModuleDesc.nextInChain = reinterpret_cast<WGPUChainedStruct*>(&wgpuShaderCodeDesc);
     wgpuShaderModuleDesc.label       = GetWGPUStringView(pShaderWebGPU->GetDesc().Name);
-    wgpuShaderModule.Reset(wgpuDeviceCreateShaderModule(m_pDevice->GetWebGPUDevice(), &wgpuShaderModuleDesc));
+    {
+        ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+        wgpuShaderModule.Reset(wgpuDeviceCreateShaderModule(m_pDevice->GetWebGPUDevice(), &wgpuShaderModuleDesc));
+    }
 
     WGPUComputePipelineDescriptor wgpuComputePipelineDesc{};
     wgpuComputePipelineDesc.label              = GetWGPUStringView(m_Desc.Name);
@@ -633,6 +641,7 @@ void PipelineStateWebGPUImpl::InitializeWebGPUComputePipeline(const TShaderStage
     }
     else
     {
+        ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
         m_wgpuComputePipeline.Reset(wgpuDeviceCreateComputePipeline(m_pDevice->GetWebGPUDevice(), &wgpuComputePipelineDesc));
         if (!m_wgpuComputePipeline)
             LOG_ERROR_AND_THROW("Failed to create pipeline state");
@@ -102,13 +102,23 @@ Uint64 QueryManagerWebGPU::GetQueryResult(QUERY_TYPE Type, Uint32 Index) const
     return m_QuerySets[Type]->GetQueryResult(Index);
 }
 
-void QueryManagerWebGPU::ResolveQuerySet(RenderDeviceWebGPUImpl* pDevice, DeviceContextWebGPUImpl* pDeviceContext)
+Uint64 QueryManagerWebGPU::GetQueryResolveFenceValue(QUERY_TYPE Type, Uint32 Index) const
+{
+    return m_QuerySets[Type]->GetResolveFenceValue(Index);
+}
+
+void QueryManagerWebGPU::OnQueryWritten(QUERY_TYPE Type, Uint32 Index)
+{
+    m_QuerySets[Type]->OnQueryWritten(Index);
+}
+
+void QueryManagerWebGPU::ResolveQuerySet(RenderDeviceWebGPUImpl* pDevice, DeviceContextWebGPUImpl* pDeviceContext, Uint64 FenceValue)
 {
     for (Uint32 QueryType = QUERY_TYPE_UNDEFINED + 1; QueryType < QUERY_TYPE_NUM_TYPES; ++QueryType)
     {
         auto& pQuerySetObject = m_QuerySets[QueryType];
         if (pQuerySetObject)
-            pQuerySetObject->ResolveQueries(pDevice, pDeviceContext);
+            pQuerySetObject->ResolveQueries(pDevice, pDeviceContext, FenceValue);
     }
 }
 
@@ -117,7 +127,7 @@ QueryManagerWebGPU::QuerySetObject::QuerySetObject(IReferenceCounters*     pRefC
                                                    Uint32                  HeapSize,
                                                    QUERY_TYPE              QueryType) :
     ObjectBase<IDeviceObject>{pRefCounters},
-    WebGPUResourceBase{*this, 16}
+    WebGPUResourceBase{*this, MaxPendingReadbacks}
 {
     String QuerySetName = String{"QueryManagerWebGPU: Query set ["} + GetQueryTypeString(QueryType) + "]";
 
@@ -149,6 +159,7 @@ QueryManagerWebGPU::QuerySetObject::QuerySetObject(IReferenceCounters*     pRefC
     for (Uint32 QueryIdx = 0; QueryIdx < m_QueryCount; ++QueryIdx)
         m_AvailableQueries[QueryIdx] = QueryIdx;
     m_MappedData.resize(static_cast<size_t>(wgpuResolveBufferDesc.size));
+    m_ResolveFenceValues.resize(m_QueryCount, UINT64_MAX);
 
     String QueryObjectName = String{"QueryManagerWebGPU: QuerySetObject["} + GetQueryTypeString(m_Type) + "]";
 
@@ -214,6 +225,20 @@ Uint64 QueryManagerWebGPU::QuerySetObject::GetQueryResult(Uint32 Index) const
     return reinterpret_cast<const Uint64*>(m_MappedData.data())[Index];
 }
 
+Uint64 QueryManagerWebGPU::QuerySetObject::GetResolveFenceValue(Uint32 Index) const
+{
+    VERIFY(Index < m_QueryCount, "Query index ", Index, " is out of range");
+    return m_ResolveFenceValues[Index];
+}
+
+void QueryManagerWebGPU::QuerySetObject::OnQueryWritten(Uint32 Index)
+{
+    VERIFY(Index < m_QueryCount, "Query index ", Index, " is out of range");
+    m_ResolveFenceValues[Index] = UINT64_MAX;
+    m_FirstUnresolvedQuery      = std::min(m_FirstUnresolvedQuery, Index);
+    m_LastUnresolvedQuery       = std::max(m_LastUnresolvedQuery, Index);
+}
+
 WGPUQuerySet QueryManagerWebGPU::QuerySetObject::GetWebGPUQuerySet() const
 {
     return m_wgpuQuerySet.Get();
@@ -224,15 +249,43 @@ Uint32 QueryManagerWebGPU::QuerySetObject::GetMaxAllocatedQueries() const
     return m_MaxAllocatedQueries;
 }
 
-void QueryManagerWebGPU::QuerySetObject::ResolveQueries(RenderDeviceWebGPUImpl* pDevice, DeviceContextWebGPUImpl* pDeviceContext)
+void QueryManagerWebGPU::QuerySetObject::ResolveQueries(RenderDeviceWebGPUImpl* pDevice, DeviceContextWebGPUImpl* pDeviceContext, Uint64 FenceValue)
 {
-    if (m_AvailableQueries.size() != m_QueryCount)
+    if (m_FirstUnresolvedQuery > m_LastUnresolvedQuery)
+        return;
+
+    WebGPUResourceBase::StagingBufferInfo* pDstStagingBuffer = GetStagingBuffer(pDevice->GetWebGPUDevice(), CPU_ACCESS_READ);
+    if (pDstStagingBuffer == nullptr)
     {
-        WebGPUResourceBase::StagingBufferInfo* pDstStagingBuffer = GetStagingBuffer(pDevice->GetWebGPUDevice(), CPU_ACCESS_READ);
-        wgpuCommandEncoderResolveQuerySet(pDeviceContext->GetCommandEncoder(), m_wgpuQuerySet, 0, m_QueryCount, m_wgpuResolveBuffer, 0);
-        wgpuCommandEncoderCopyBufferToBuffer(pDeviceContext->GetCommandEncoder(), m_wgpuResolveBuffer, 0, pDstStagingBuffer->wgpuBuffer, 0, m_QueryCount * sizeof(Uint64));
-        pDeviceContext->m_PendingStagingReads.emplace(pDstStagingBuffer, RefCntAutoPtr<IObject>{this});
+        // All readback buffers are still waiting to be mapped. Keep the queries unresolved
+        // and try again on the next flush rather than stalling.
+        if (!m_ReadbackRingFullWarningShown)
+        {
+            LOG_WARNING_MESSAGE("All ", MaxPendingReadbacks, " readback buffers of '", m_Desc.Name,
+                                "' are in use. Query results will be delayed.");
+            m_ReadbackRingFullWarningShown = true;
+        }
+        return;
     }
+
+    const Uint32 FirstQuery = m_FirstUnresolvedQuery;
+    const Uint32 QueryCount = m_LastUnresolvedQuery - m_FirstUnresolvedQuery + 1;
+    const Uint64 DataOffset = Uint64{FirstQuery} * sizeof(Uint64);
+    const Uint64 DataSize   = Uint64{QueryCount} * sizeof(Uint64);
+
+    WGPUCommandEncoder wgpuCmdEncoder = pDeviceContext->GetCommandEncoder();
+    wgpuCommandEncoderResolveQuerySet(wgpuCmdEncoder, m_wgpuQuerySet, FirstQuery, QueryCount, m_wgpuResolveBuffer, DataOffset);
+    wgpuCommandEncoderCopyBufferToBuffer(wgpuCmdEncoder, m_wgpuResolveBuffer, DataOffset, pDstStagingBuffer->wgpuBuffer, DataOffset, DataSize);
+
+    pDstStagingBuffer->ReadbackOffset = static_cast<size_t>(DataOffset);
+    pDstStagingBuffer->ReadbackSize   = static_cast<size_t>(DataSize);
+    pDeviceContext->m_PendingStagingReads.emplace(pDstStagingBuffer, RefCntAutoPtr<IObject>{this});
+
+    for (Uint32 QueryIdx = FirstQuery; QueryIdx < FirstQuery + QueryCount; ++QueryIdx)
+        m_ResolveFenceValues[QueryIdx] = FenceValue;
+
+    m_FirstUnresolvedQuery = UINT32_MAX;
+    m_LastUnresolvedQuery  = 0;
 }
 
 const DeviceObjectAttribs& QueryManagerWebGPU::QuerySetObject::GetDesc() const
@@ -93,10 +93,17 @@ bool QueryWebGPUImpl::GetData(void* pData, Uint32 DataSize, bool AutoInvalidate)
 {
     TQueryBase::CheckQueryDataPtr(pData, DataSize);
     DEV_CHECK_ERR(m_pQueryMgr != nullptr, "Requesting data from query that has not been ended or has been invalidated");
+    if (m_pQueryMgr == nullptr)
+        return false;
 
     VERIFY_EXPR(m_pDevice->GetNumImmediateContexts() == 1);
     DeviceContextWebGPUImpl* pContext = m_pDevice->GetImmediateContext(0);
-    if (pContext->GetCompletedFenceValue() >= m_QueryEndFenceValue)
+    // Query results are resolved once per flush and read back asynchronously, so they are available
+    // when the context fence reaches the value of the flush that resolved the end query.
+    const Uint64 CompletedFenceValue = pContext->GetCompletedFenceValue();
+    const Uint32 LastQueryIdx        = m_Desc.Type == QUERY_TYPE_DURATION ? 1 : 0;
+    if (CompletedFenceValue >= m_pQueryMgr->GetQueryResolveFenceValue(m_Desc.Type, m_QuerySetIndices[0]) &&
+        CompletedFenceValue >= m_pQueryMgr->GetQueryResolveFenceValue(m_Desc.Type, m_QuerySetIndices[LastQueryIdx]))
     {
         switch (m_Desc.Type)
         {
@@ -182,7 +189,6 @@ bool QueryWebGPUImpl::OnEndQuery(DeviceContextWebGPUImpl* pContext)
         return false;
     }
 
-    m_QueryEndFenceValue = pContext->GetNextFenceValue();
     return true;
 }
 
@@ -112,14 +112,15 @@ RenderDeviceWebGPUImpl::RenderDeviceWebGPUImpl(IReferenceCounters*           pRe
 
     m_DeviceInfo.Features = EnableDeviceFeatures(m_AdapterInfo.Features, EngineCI.Features);
 
-    m_pUploadMemoryManager  = std::make_unique<UploadMemoryManagerWebGPU>(m_wgpuDevice, EngineCI.UploadHeapPageSize);
+    m_pBindGroupCache       = std::make_unique<BindGroupCacheWebGPU>(m_wgpuDevice, EngineCI.BindGroupCacheSize);
+    m_pUploadMemoryManager  = std::make_unique<UploadMemoryManagerWebGPU>(m_wgpuDevice, EngineCI.UploadHeapPageSize, EngineCI.UseMappedUploadHeap);
     m_pDynamicMemoryManager = std::make_unique<DynamicMemoryManagerWebGPU>(m_wgpuDevice, EngineCI.DynamicHeapPageSize, EngineCI.DynamicHeapSize);
     m_pAttachmentCleaner    = std::make_unique<AttachmentCleanerWebGPU>(*this);
     m_pMipsGenerator        = std::make_unique<GenerateMipsHelperWebGPU>(*this);
     m_pQueryManager         = std::make_unique<QueryManagerWebGPU>(this, EngineCI.QueryPoolSizes);
 
 #if !DILIGENT_NO_GLSLANG
-    GLSLangUtils::InitializeGlslang();
+    GLSLangUtils::InitializeGlslang(EngineCI.DeferSubsystemInitialization);
 #endif
 
     InitShaderCompilationThreadPool(EngineCI.pAsyncShaderCompilationThreadPool, EngineCI.NumAsyncShaderCompilationThreads);
@@ -308,6 +309,15 @@ void RenderDeviceWebGPUImpl::IdleGPU()
 #endif
 }
 
+void RenderDeviceWebGPUImpl::GetMemoryStats(DeviceMemoryStats& Stats)
+{
+    // WebGPU does not expose memory heaps and budgets, so only the engine-side
+    // dynamic memory is reported.
+    Stats                       = {};
+    Stats.DynamicMemoryReserved = m_pDynamicMemoryManager->GetBufferSize();
+    Stats.DynamicMemoryUsed     = m_pDynamicMemoryManager->GetAllocatedPageSize();
+}
+
 void RenderDeviceWebGPUImpl::CreateTextureFromWebGPUTexture(WGPUTexture        wgpuTexture,
                                                             const TextureDesc& TexDesc,
                                                             RESOURCE_STATE     InitialState,
@@ -82,6 +82,13 @@ SamplerWebGPUImpl::SamplerWebGPUImpl(IReferenceCounters* pRefCounters,
     // Since WebGPU does not support multithreading, we cannot create WebGPU sampler here.
 }
 
+SamplerWebGPUImpl::~SamplerWebGPUImpl()
+{
+    // Samplers created for serialization have no device.
+    if (m_pDevice != nullptr)
+        m_pDevice->GetBindGroupCache().OnObjectReleased(GetUniqueID());
+}
+
 WGPUSampler SamplerWebGPUImpl::GetWebGPUSampler() const
 {
     if (!m_wgpuSampler)
@@ -456,11 +456,24 @@ void ShaderResourceCacheWebGPU::SetDynamicBufferOffset(Uint32 BindGroupIndex,
     DstRes.BufferDynamicOffset = DynamicBufferOffset;
 }
 
-WGPUBindGroup ShaderResourceCacheWebGPU::UpdateBindGroup(WGPUDevice wgpuDevice, Uint32 GroupIndex, WGPUBindGroupLayout wgpuGroupLayout)
+WGPUBindGroup ShaderResourceCacheWebGPU::UpdateBindGroup(BindGroupCacheWebGPU& BindGroupCache, Uint32 GroupIndex, WGPUBindGroupLayout wgpuGroupLayout)
 {
     BindGroup& Group = GetBindGroup(GroupIndex);
-    if (!Group.m_wgpuBindGroup || Group.m_IsDirty)
+    if (!Group.m_pBindGroup || Group.m_IsDirty)
     {
+        BindGroupCacheWebGPU::Key Key;
+        Key.wgpuLayout = wgpuGroupLayout;
+        Key.Resources.resize(Group.m_NumResources);
+        for (Uint32 res = 0; res < Group.m_NumResources; ++res)
+        {
+            const Resource&                   Res    = Group.GetResource(res);
+            BindGroupCacheWebGPU::ResourceKey& ResKey = Key.Resources[res];
+
+            ResKey.UniqueID = Res.pObject ? Res.pObject->GetUniqueID() : 0;
+            ResKey.Offset   = Res.BufferBaseOffset;
+            ResKey.Size     = Res.BufferRangeSize;
+        }
+
         WGPUBindGroupDescriptor wgpuBindGroupDescriptor{};
         wgpuBindGroupDescriptor.nextInChain = nullptr;
         wgpuBindGroupDescriptor.label       = {};
@@ -468,11 +481,11 @@ WGPUBindGroup ShaderResourceCacheWebGPU::UpdateBindGroup(WGPUDevice wgpuDevice,
         wgpuBindGroupDescriptor.entryCount  = Group.m_NumResources;
         wgpuBindGroupDescriptor.entries     = Group.m_wgpuEntries;
 
-        Group.m_wgpuBindGroup.Reset(wgpuDeviceCreateBindGroup(wgpuDevice, &wgpuBindGroupDescriptor));
-        Group.m_IsDirty = false;
+        Group.m_pBindGroup = BindGroupCache.GetBindGroup(Key, wgpuBindGroupDescriptor);
+        Group.m_IsDirty    = false;
     }
 
-    return Group.m_wgpuBindGroup;
+    return Group.GetWGPUBindGroup();
 }
 
 bool ShaderResourceCacheWebGPU::GetDynamicBufferOffsets(DeviceContextIndex     CtxId,
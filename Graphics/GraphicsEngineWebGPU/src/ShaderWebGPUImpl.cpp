@@ -34,6 +34,7 @@
 #include "HLSLUtils.hpp"
 #include "HLSLParsingTools.hpp"
 #include "SPIRVUtils.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 #if !DILIGENT_NO_GLSLANG
 #    include "GLSLangUtils.hpp"
@@ -144,6 +145,7 @@ std::vector<uint32_t> CompileShaderToSPIRV(const ShaderCreateInfo&             S
         Attribs.Macros                     = Macros;
         Attribs.AssignBindings             = true;
         Attribs.UseRowMajorMatrices        = (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR) != 0;
+        Attribs.OptimizeForSize            = (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE) != 0;
         Attribs.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
         Attribs.ppCompilerOutput           = WebGPUShaderCI.ppCompilerOutput;
 
@@ -159,6 +161,8 @@ std::vector<uint32_t> CompileShaderToSPIRV(const ShaderCreateInfo&             S
 void ShaderWebGPUImpl::Initialize(const ShaderCreateInfo& ShaderCI,
                                   const CreateInfo&       WebGPUShaderCI) noexcept(false)
 {
+    ShaderCompilationScope CompilationScope{m_Desc.Name, false};
+
     SHADER_SOURCE_LANGUAGE ParsedSourceLanguage = SHADER_SOURCE_LANGUAGE_DEFAULT;
     SHADER_SOURCE_LANGUAGE SourceLanguage       = ShaderCI.SourceLanguage;
     if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_DEFAULT ||
@@ -229,6 +233,8 @@ void ShaderWebGPUImpl::Initialize(const ShaderCreateInfo& ShaderCI,
     // Load shader resources
     if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_SKIP_REFLECTION) == 0)
     {
+        ShaderCompilationStageScope Reflection{SHADER_COMPILATION_STAGE_REFLECTION};
+
         auto& Allocator = GetRawAllocator();
 
         std::unique_ptr<void, STDDeleterRawMem<void>> pRawMem{
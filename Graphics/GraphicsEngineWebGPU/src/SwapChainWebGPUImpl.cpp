@@ -474,6 +474,12 @@ void SwapChainWebGPUImpl::ConfigureSurface()
         {
             PreferredPresentModes.push_back(WGPUPresentMode_Fifo);
         }
+        else if (m_SwapChainDesc.UnsyncedPresentMode == UNSYNCED_PRESENT_MODE_IMMEDIATE)
+        {
+            PreferredPresentModes.push_back(WGPUPresentMode_Immediate);
+            PreferredPresentModes.push_back(WGPUPresentMode_Mailbox);
+            PreferredPresentModes.push_back(WGPUPresentMode_Fifo);
+        }
         else
         {
             PreferredPresentModes.push_back(WGPUPresentMode_Mailbox);
@@ -58,6 +58,11 @@ TextureViewWebGPUImpl::TextureViewWebGPUImpl(IReferenceCounters*
 {
 }
 
+TextureViewWebGPUImpl::~TextureViewWebGPUImpl()
+{
+    m_pDevice->GetBindGroupCache().OnObjectReleased(GetUniqueID());
+}
+
 WGPUTextureView TextureViewWebGPUImpl::GetWebGPUTextureView() const
 {
     return m_wgpuTextureView.Get();
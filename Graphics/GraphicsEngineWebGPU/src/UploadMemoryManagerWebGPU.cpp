@@ -26,6 +26,8 @@
 
 #include "pch.h"
 
+#include <algorithm>
+
 #include "Cast.hpp"
 #include "Align.hpp"
 #include "UploadMemoryManagerWebGPU.hpp"
@@ -34,22 +36,44 @@
 namespace Diligent
 {
 
+struct UploadMemoryManagerWebGPU::PendingMapPage
+{
+    UploadMemoryManagerWebGPU* pMgr;
+    Page                       MemPage;
+};
+
 UploadMemoryManagerWebGPU::Page::Page(UploadMemoryManagerWebGPU& Mgr, size_t Size) :
     m_pMgr{&Mgr},
-    m_Data(Size)
+    m_Size{Size}
 {
     WGPUBufferDescriptor wgpuBufferDesc{};
     wgpuBufferDesc.label = GetWGPUStringView("Upload memory page");
     wgpuBufferDesc.size  = Size;
-    wgpuBufferDesc.usage =
-        WGPUBufferUsage_CopyDst |
-        WGPUBufferUsage_CopySrc |
-        WGPUBufferUsage_Uniform |
-        WGPUBufferUsage_Storage |
-        WGPUBufferUsage_Vertex |
-        WGPUBufferUsage_Index |
-        WGPUBufferUsage_Indirect;
+    if (m_pMgr->m_UseMappedPages)
+    {
+        // MapWrite may only be combined with CopySrc
+        wgpuBufferDesc.usage            = WGPUBufferUsage_MapWrite | WGPUBufferUsage_CopySrc;
+        wgpuBufferDesc.mappedAtCreation = true;
+    }
+    else
+    {
+        wgpuBufferDesc.usage =
+            WGPUBufferUsage_CopyDst |
+            WGPUBufferUsage_CopySrc |
+            WGPUBufferUsage_Uniform |
+            WGPUBufferUsage_Storage |
+            WGPUBufferUsage_Vertex |
+            WGPUBufferUsage_Index |
+            WGPUBufferUsage_Indirect;
+        m_Data.resize(Size);
+    }
     m_wgpuBuffer.Reset(wgpuDeviceCreateBuffer(m_pMgr->m_wgpuDevice, &wgpuBufferDesc));
+
+    if (m_pMgr->m_UseMappedPages)
+    {
+        m_pMappedData = static_cast<Uint8*>(wgpuBufferGetMappedRange(m_wgpuBuffer, 0, Size));
+        VERIFY(m_pMappedData != nullptr, "Mapped range is null");
+    }
     LOG_INFO_MESSAGE("Created a new upload memory page, size: ", FormatMemorySize(Size));
 }
 
@@ -58,6 +82,8 @@ UploadMemoryManagerWebGPU::Page::Page(Page&& RHS) noexcept :
     m_pMgr{RHS.m_pMgr},
     m_wgpuBuffer{std::move(RHS.m_wgpuBuffer)},
     m_Data{std::move(RHS.m_Data)},
+    m_pMappedData{RHS.m_pMappedData},
+    m_Size{RHS.m_Size},
     m_CurrOffset{RHS.m_CurrOffset}
 // clang-format on
 {
@@ -69,13 +95,17 @@ UploadMemoryManagerWebGPU::Page& UploadMemoryManagerWebGPU::Page::operator=(Page
     if (&RHS == this)
         return *this;
 
-    m_pMgr       = RHS.m_pMgr;
-    m_wgpuBuffer = std::move(RHS.m_wgpuBuffer);
-    m_Data       = std::move(RHS.m_Data);
-    m_CurrOffset = RHS.m_CurrOffset;
+    m_pMgr        = RHS.m_pMgr;
+    m_wgpuBuffer  = std::move(RHS.m_wgpuBuffer);
+    m_Data        = std::move(RHS.m_Data);
+    m_pMappedData = RHS.m_pMappedData;
+    m_Size        = RHS.m_Size;
+    m_CurrOffset  = RHS.m_CurrOffset;
 
-    RHS.m_pMgr       = nullptr;
-    RHS.m_CurrOffset = 0;
+    RHS.m_pMgr        = nullptr;
+    RHS.m_pMappedData = nullptr;
+    RHS.m_Size        = 0;
+    RHS.m_CurrOffset  = 0;
 
     return *this;
 }
@@ -91,10 +121,11 @@ UploadMemoryManagerWebGPU::Allocation UploadMemoryManagerWebGPU::Page::Allocate(
     Allocation Alloc;
     Alloc.Offset = AlignUp(m_CurrOffset, Alignment);
     Alloc.Size   = AlignUp(Size, Alignment);
-    if (Alloc.Offset + Alloc.Size <= m_Data.size())
+    if (Alloc.Offset + Alloc.Size <= m_Size)
     {
+        VERIFY(m_pMappedData != nullptr || !m_Data.empty(), "The page is neither mapped nor has CPU-side data. Was it flushed and not recycled?");
         Alloc.wgpuBuffer = m_wgpuBuffer;
-        Alloc.pData      = &m_Data[Alloc.Offset];
+        Alloc.pData      = m_pMappedData != nullptr ? m_pMappedData + Alloc.Offset : &m_Data[Alloc.Offset];
         m_CurrOffset     = Alloc.Offset + Alloc.Size;
         return Alloc;
     }
@@ -103,7 +134,13 @@ UploadMemoryManagerWebGPU::Allocation UploadMemoryManagerWebGPU::Page::Allocate(
 
 void UploadMemoryManagerWebGPU::Page::FlushWrites(WGPUQueue wgpuQueue)
 {
-    if (m_CurrOffset > 0)
+    if (m_pMappedData != nullptr)
+    {
+        // The buffer must be unmapped before the command buffer that copies from it is submitted
+        wgpuBufferUnmap(m_wgpuBuffer);
+        m_pMappedData = nullptr;
+    }
+    else if (m_CurrOffset > 0)
     {
         wgpuQueueWriteBuffer(wgpuQueue, m_wgpuBuffer, 0, m_Data.data(), m_CurrOffset);
     }
@@ -122,8 +159,9 @@ void UploadMemoryManagerWebGPU::Page::Recycle()
 }
 
 
-UploadMemoryManagerWebGPU::UploadMemoryManagerWebGPU(WGPUDevice wgpuDevice, size_t PageSize) :
+UploadMemoryManagerWebGPU::UploadMemoryManagerWebGPU(WGPUDevice wgpuDevice, size_t PageSize, bool UseMappedPages) :
     m_PageSize{PageSize},
+    m_UseMappedPages{UseMappedPages},
     m_wgpuDevice{wgpuDevice}
 {
     VERIFY(IsPowerOfTwo(m_PageSize), "Page size must be power of two");
@@ -131,8 +169,15 @@ UploadMemoryManagerWebGPU::UploadMemoryManagerWebGPU(WGPUDevice wgpuDevice, size
 
 UploadMemoryManagerWebGPU::~UploadMemoryManagerWebGPU()
 {
-    VERIFY(m_DbgPageCounter == m_AvailablePages.size(),
+    VERIFY(m_DbgPageCounter == m_AvailablePages.size() + m_PendingMapPages.size(),
            "Not all pages have been recycled. This may result in a crash if the page is recycled later.");
+
+    // Map callbacks are only delivered when the device is ticked, which never happens concurrently with
+    // the manager destruction. Orphaned pages are released by their callbacks.
+    for (PendingMapPage* pPending : m_PendingMapPages)
+        pPending->pMgr = nullptr;
+    m_PendingMapPages.clear();
+
     size_t TotalSize = 0;
     for (const Page& page : m_AvailablePages)
         TotalSize += page.GetSize();
@@ -169,8 +214,63 @@ UploadMemoryManagerWebGPU::Page UploadMemoryManagerWebGPU::GetPage(size_t Size)
 
 void UploadMemoryManagerWebGPU::RecyclePage(Page&& Item)
 {
+    if (m_UseMappedPages)
+    {
+        // The page becomes available once it is mapped again
+        MapPageAsync(std::move(Item));
+        return;
+    }
+
     std::lock_guard Lock{m_AvailablePagesMtx};
     m_AvailablePages.emplace_back(std::move(Item));
 }
 
+void UploadMemoryManagerWebGPU::MapPageAsync(Page&& Item)
+{
+    VERIFY(Item.m_pMappedData == nullptr, "The page must be unmapped before it is recycled. Did you forget to call FlushWrites()?");
+
+    auto MapAsyncCallback = [](WGPUBufferMapAsyncStatus MapStatus, void* pUserData) {
+        VERIFY_EXPR(pUserData != nullptr);
+        PendingMapPage* pPending = static_cast<PendingMapPage*>(pUserData);
+        if (pPending->pMgr != nullptr)
+            pPending->pMgr->OnPageMapped(pPending, MapStatus == WGPUBufferMapAsyncStatus_Success);
+        delete pPending;
+    };
+
+    const size_t    Size       = Item.GetSize();
+    WGPUBuffer      wgpuBuffer = Item.m_wgpuBuffer;
+    PendingMapPage* pPending   = new PendingMapPage{this, std::move(Item)};
+    {
+        std::lock_guard Lock{m_AvailablePagesMtx};
+        m_PendingMapPages.push_back(pPending);
+    }
+    // The map operation completes after the GPU has finished all previously submitted copies from the buffer
+    wgpuBufferMapAsync(wgpuBuffer, WGPUMapMode_Write, 0, Size, MapAsyncCallback, pPending);
+}
+
+void UploadMemoryManagerWebGPU::OnPageMapped(PendingMapPage* pPending, bool Success)
+{
+    std::lock_guard Lock{m_AvailablePagesMtx};
+
+    auto Iter = std::find(m_PendingMapPages.begin(), m_PendingMapPages.end(), pPending);
+    VERIFY_EXPR(Iter != m_PendingMapPages.end());
+    m_PendingMapPages.erase(Iter);
+
+    Page& MappedPage = pPending->MemPage;
+    if (Success)
+        MappedPage.m_pMappedData = static_cast<Uint8*>(wgpuBufferGetMappedRange(MappedPage.m_wgpuBuffer, 0, MappedPage.GetSize()));
+
+    if (MappedPage.m_pMappedData != nullptr)
+    {
+        m_AvailablePages.emplace_back(std::move(MappedPage));
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Failed to map upload memory page. The page will be released.");
+#if DILIGENT_DEBUG
+        m_DbgPageCounter.fetch_sub(1);
+#endif
+    }
+}
+
 } // namespace Diligent
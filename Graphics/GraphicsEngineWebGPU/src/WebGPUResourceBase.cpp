@@ -83,6 +83,8 @@ WebGPUResourceBase::StagingBufferInfo* WebGPUResourceBase::FindStagingReadBuffer
                 // Create a new sync point since the old one can still be referenced by fences
                 BufferInfo.pSyncPoint = MakeNewRCObj<SyncPointWebGPUImpl>()();
             }
+            BufferInfo.ReadbackOffset = 0;
+            BufferInfo.ReadbackSize   = m_MappedData.size();
             return &BufferInfo;
         }
     }
@@ -114,6 +116,8 @@ WebGPUResourceBase::StagingBufferInfo* WebGPUResourceBase::FindStagingReadBuffer
             *this,
             std::move(wgpuBuffer),
             RefCntAutoPtr<SyncPointWebGPUImpl>{MakeNewRCObj<SyncPointWebGPUImpl>()()},
+            0,
+            m_MappedData.size(),
         });
     return &m_StagingBuffers.back();
 }
@@ -190,10 +194,11 @@ void WebGPUResourceBase::ProcessAsyncReadback(StagingBufferInfo& Buffer)
         if (MapStatus == WGPUBufferMapAsyncStatus_Success)
         {
             // Do NOT use WGPU_WHOLE_MAP_SIZE due to https://github.com/emscripten-core/emscripten/issues/20538
-            const size_t MappedDataSize = BufferInfo.Resource.m_MappedData.size();
-            if (const void* pData = wgpuBufferGetConstMappedRange(BufferInfo.wgpuBuffer, 0, AlignUp(MappedDataSize, MappedRangeAlignment)))
+            const size_t ReadbackOffset = BufferInfo.ReadbackOffset;
+            const size_t ReadbackSize   = BufferInfo.ReadbackSize;
+            if (const void* pData = wgpuBufferGetConstMappedRange(BufferInfo.wgpuBuffer, ReadbackOffset, AlignUp(ReadbackSize, MappedRangeAlignment)))
             {
-                memcpy(BufferInfo.Resource.m_MappedData.data(), pData, MappedDataSize);
+                memcpy(&BufferInfo.Resource.m_MappedData[ReadbackOffset], pData, ReadbackSize);
             }
             else
             {
@@ -210,9 +215,10 @@ void WebGPUResourceBase::ProcessAsyncReadback(StagingBufferInfo& Buffer)
 
     // Keep the resource alive until the callback is called
     m_Owner.AddRef();
+    VERIFY(Buffer.ReadbackOffset % 8 == 0, "Readback offset must be a multiple of 8");
+    VERIFY(Buffer.ReadbackOffset + Buffer.ReadbackSize <= Buffer.Resource.m_MappedData.size(), "Readback range is out of bounds");
     // Do NOT use WGPU_WHOLE_MAP_SIZE due to https://github.com/emscripten-core/emscripten/issues/20538
-    const size_t MappedDataSize = Buffer.Resource.m_MappedData.size();
-    wgpuBufferMapAsync(Buffer.wgpuBuffer, WGPUMapMode_Read, 0, AlignUp(MappedDataSize, MappedRangeAlignment), MapAsyncCallback, &Buffer);
+    wgpuBufferMapAsync(Buffer.wgpuBuffer, WGPUMapMode_Read, Buffer.ReadbackOffset, AlignUp(Buffer.ReadbackSize, MappedRangeAlignment), MapAsyncCallback, &Buffer);
 }
 
 } // namespace Diligent
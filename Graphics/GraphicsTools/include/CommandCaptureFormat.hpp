@@ -0,0 +1,564 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Command capture file format shared by Diligent::CommandCapture and Diligent::CommandReplay
+
+#include <cstring>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/include/PSOSerializer.hpp"
+#include "../../../Common/interface/Serializer.hpp"
+#include "../../../Common/interface/Align.hpp"
+
+namespace Diligent
+{
+
+namespace CommandCaptureFormat
+{
+
+/// File signature: 'DGCC'
+static constexpr Uint32 Magic = 0x43434744u;
+
+/// Format version. Descriptions are stored as raw structures, so the captures can only be
+/// replayed by the engine build with the same structure layout.
+static constexpr Uint32 Version = 1;
+
+using ObjectId = Uint32;
+
+static constexpr ObjectId InvalidObjectId = ~0u;
+
+enum CMD : Uint32
+{
+    CMD_UNKNOWN = 0,
+
+    // Object creation
+    CMD_CREATE_BUFFER,
+    CMD_CREATE_TEXTURE,
+    CMD_CREATE_BUFFER_VIEW,
+    CMD_CREATE_TEXTURE_VIEW,
+    CMD_CREATE_SAMPLER,
+    CMD_CREATE_SHADER,
+    CMD_CREATE_GRAPHICS_PIPELINE,
+    CMD_CREATE_COMPUTE_PIPELINE,
+    CMD_CREATE_SRB,
+    CMD_SET_STATIC_VARIABLE,
+    CMD_SET_SRB_VARIABLE,
+
+    // Device context commands
+    CMD_SET_PIPELINE_STATE,
+    CMD_COMMIT_SHADER_RESOURCES,
+    CMD_SET_VERTEX_BUFFERS,
+    CMD_SET_INDEX_BUFFER,
+    CMD_SET_RENDER_TARGETS,
+    CMD_SET_VIEWPORTS,
+    CMD_SET_SCISSOR_RECTS,
+    CMD_SET_STENCIL_REF,
+    CMD_SET_BLEND_FACTORS,
+    CMD_CLEAR_RENDER_TARGET,
+    CMD_CLEAR_DEPTH_STENCIL,
+    CMD_DRAW,
+    CMD_DRAW_INDEXED,
+    CMD_DISPATCH_COMPUTE,
+    CMD_UPDATE_BUFFER,
+    CMD_WRITE_DYNAMIC_BUFFER,
+    CMD_COPY_BUFFER,
+    CMD_BEGIN_DEBUG_GROUP,
+    CMD_END_DEBUG_GROUP,
+
+    CMD_COUNT
+};
+
+/// Every command in a stream starts with the header followed by the payload,
+/// which is padded to a multiple of 8 bytes.
+struct CommandHeader
+{
+    CMD    Cmd  = CMD_UNKNOWN;
+    Uint32 Size = 0;
+};
+static_assert(sizeof(CommandHeader) == 8, "Unexpected command header size");
+
+/// Appends the command to the stream. SerializeFn is called twice: with the Measure serializer
+/// to compute the payload size and with the Write serializer to write the payload.
+template <typename SerializeFnType>
+void AppendCommand(std::vector<Uint8>& Stream, CMD Cmd, SerializeFnType&& SerializeFn)
+{
+    Serializer<SerializerMode::Measure> MeasureSer;
+    SerializeFn(MeasureSer);
+
+    const size_t Size   = MeasureSer.GetSize();
+    const size_t Offset = Stream.size();
+    VERIFY_EXPR(Offset % 8 == 0);
+    Stream.resize(Offset + sizeof(CommandHeader) + AlignUp(Size, size_t{8}));
+
+    CommandHeader Header;
+    Header.Cmd  = Cmd;
+    Header.Size = static_cast<Uint32>(Size);
+    std::memcpy(&Stream[Offset], &Header, sizeof(Header));
+
+    SerializedData                    Payload{&Stream[Offset + sizeof(CommandHeader)], Size};
+    Serializer<SerializerMode::Write> WriteSer{Payload};
+    SerializeFn(WriteSer);
+    VERIFY_EXPR(WriteSer.IsEnded());
+}
+
+/// Serializes a description structure that has a Name member.
+/// The structure is stored as raw bytes followed by the name string.
+template <SerializerMode Mode, typename DescType>
+bool SerializeNamedDesc(Serializer<Mode>& Ser, typename Serializer<Mode>::template ConstQual<DescType>& Desc)
+{
+    DescType    Tmp{Desc};
+    const char* Name = Tmp.Name;
+    Tmp.Name         = nullptr;
+    if (!Ser.CopyBytes(&Tmp, sizeof(Tmp)))
+        return false;
+    if (!Ser(Name))
+        return false;
+
+    if (Mode == SerializerMode::Read)
+    {
+        Tmp.Name                      = Name;
+        const_cast<DescType&>(Desc) = Tmp;
+    }
+    return true;
+}
+
+/// Serializes a plain structure without pointers as raw bytes.
+template <SerializerMode Mode, typename StructType>
+bool SerializeRaw(Serializer<Mode>& Ser, typename Serializer<Mode>::template ConstQual<StructType>& Struct)
+{
+    return Ser.CopyBytes(const_cast<StructType*>(&Struct), sizeof(StructType));
+}
+
+// Serializes the array of plain structures without pointers
+template <SerializerMode Mode, typename StructType>
+bool SerializeRawArray(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator, const StructType*& pElements, Uint32& Count)
+{
+    return Ser.SerializeArray(Allocator, pElements, Count,
+                              [](Serializer<Mode>& Ser, typename Serializer<Mode>::template ConstQual<StructType>& Elem) {
+                                  return SerializeRaw<Mode, StructType>(Ser, Elem);
+                              });
+}
+
+
+// Command payloads. Every payload is serialized with the same method when the command is
+// recorded and replayed. Pointers reference the capture data when the command is read.
+
+struct CreateBufferCmd
+{
+    ObjectId    Id = InvalidObjectId;
+    BufferDesc  Desc;
+    const void* pData    = nullptr;
+    size_t      DataSize = 0;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Id) &&
+            SerializeNamedDesc<Mode, BufferDesc>(Ser, Desc) &&
+            Ser.SerializeBytes(pData, DataSize);
+    }
+};
+
+struct CreateTextureCmd
+{
+    struct SubresourceData
+    {
+        Uint64      Stride      = 0;
+        Uint64      DepthStride = 0;
+        const void* pData       = nullptr;
+        size_t      DataSize    = 0;
+    };
+
+    ObjectId               Id = InvalidObjectId;
+    TextureDesc            Desc;
+    const SubresourceData* pSubresources   = nullptr;
+    Uint32                 NumSubresources = 0;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator)
+    {
+        return Ser(Id) &&
+            SerializeNamedDesc<Mode, TextureDesc>(Ser, Desc) &&
+            Ser.SerializeArray(Allocator, pSubresources, NumSubresources,
+                               [](Serializer<Mode>& Ser, typename Serializer<Mode>::template ConstQual<SubresourceData>& Subres) {
+                                   return Ser(Subres.Stride, Subres.DepthStride) && Ser.SerializeBytes(Subres.pData, Subres.DataSize);
+                               });
+    }
+};
+
+struct CreateBufferViewCmd
+{
+    ObjectId       Id     = InvalidObjectId;
+    ObjectId       Buffer = InvalidObjectId;
+    BufferViewDesc Desc;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Id, Buffer) && SerializeNamedDesc<Mode, BufferViewDesc>(Ser, Desc);
+    }
+};
+
+struct CreateTextureViewCmd
+{
+    ObjectId        Id      = InvalidObjectId;
+    ObjectId        Texture = InvalidObjectId;
+    TextureViewDesc Desc;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Id, Texture) && SerializeNamedDesc<Mode, TextureViewDesc>(Ser, Desc);
+    }
+};
+
+struct CreateSamplerCmd
+{
+    ObjectId    Id = InvalidObjectId;
+    SamplerDesc Desc;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Id) && SerializeNamedDesc<Mode, SamplerDesc>(Ser, Desc);
+    }
+};
+
+struct CreateShaderCmd
+{
+    ObjectId         Id = InvalidObjectId;
+    ShaderCreateInfo CI;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator)
+    {
+        return Ser(Id) &&
+            ShaderSerializer<Mode>::SerializeCI(Ser, CI) &&
+            Ser.SerializeArray(Allocator, CI.Macros.Elements, CI.Macros.Count,
+                               [](Serializer<Mode>& Ser, typename Serializer<Mode>::template ConstQual<ShaderMacro>& Macro) {
+                                   return Ser(Macro.Name, Macro.Definition);
+                               });
+    }
+};
+
+struct CreateGraphicsPipelineCmd
+{
+    enum SHADER_SLOT : Uint32
+    {
+        SHADER_SLOT_VS,
+        SHADER_SLOT_PS,
+        SHADER_SLOT_GS,
+        SHADER_SLOT_HS,
+        SHADER_SLOT_DS,
+        SHADER_SLOT_AS,
+        SHADER_SLOT_MS,
+        SHADER_SLOT_COUNT
+    };
+
+    ObjectId                        Id = InvalidObjectId;
+    GraphicsPipelineStateCreateInfo CI;
+    ObjectId                        Shaders[SHADER_SLOT_COUNT] = {};
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator)
+    {
+        DeviceObjectArchive::TPRSNames PRSNames{};
+        const char*                    RenderPassName = nullptr;
+        return Ser(Id, CI.PSODesc.Name, Shaders) &&
+            PSOSerializer<Mode>::SerializeCreateInfo(Ser, CI, PRSNames, Allocator, RenderPassName);
+    }
+};
+
+struct CreateComputePipelineCmd
+{
+    ObjectId                       Id = InvalidObjectId;
+    ComputePipelineStateCreateInfo CI;
+    ObjectId                       CS = InvalidObjectId;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator)
+    {
+        DeviceObjectArchive::TPRSNames PRSNames{};
+        return Ser(Id, CI.PSODesc.Name, CS) &&
+            PSOSerializer<Mode>::SerializeCreateInfo(Ser, CI, PRSNames, Allocator);
+    }
+};
+
+struct CreateSRBCmd
+{
+    ObjectId Id                  = InvalidObjectId;
+    ObjectId PSO                 = InvalidObjectId;
+    bool     InitStaticResources = false;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Id, PSO, InitStaticResources);
+    }
+};
+
+// CMD_SET_STATIC_VARIABLE (Owner is the pipeline) and CMD_SET_SRB_VARIABLE (Owner is the SRB)
+struct SetVariableCmd
+{
+    ObjectId    Owner      = InvalidObjectId;
+    SHADER_TYPE ShaderType = SHADER_TYPE_UNKNOWN;
+    const char* Name       = nullptr;
+    ObjectId    Object     = InvalidObjectId;
+    Uint32      ArrayIndex = 0;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Owner, ShaderType, Name, Object, ArrayIndex);
+    }
+};
+
+struct SetPipelineStateCmd
+{
+    ObjectId PSO = InvalidObjectId;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(PSO);
+    }
+};
+
+struct CommitShaderResourcesCmd
+{
+    ObjectId                       SRB            = InvalidObjectId;
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(SRB, TransitionMode);
+    }
+};
+
+struct SetVertexBuffersCmd
+{
+    Uint32                         StartSlot      = 0;
+    Uint32                         NumBuffers     = 0;
+    const ObjectId*                pBuffers       = nullptr;
+    const Uint64*                  pOffsets       = nullptr;
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+    SET_VERTEX_BUFFERS_FLAGS       Flags          = SET_VERTEX_BUFFERS_FLAG_NONE;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator)
+    {
+        Uint32 NumOffsets = NumBuffers;
+        return Ser(StartSlot, TransitionMode, Flags) &&
+            Ser.SerializeArrayRaw(Allocator, pBuffers, NumBuffers) &&
+            Ser.SerializeArrayRaw(Allocator, pOffsets, NumOffsets);
+    }
+};
+
+struct SetIndexBufferCmd
+{
+    ObjectId                       Buffer         = InvalidObjectId;
+    Uint64                         Offset         = 0;
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Buffer, Offset, TransitionMode);
+    }
+};
+
+struct SetRenderTargetsCmd
+{
+    Uint32                         NumRenderTargets = 0;
+    const ObjectId*                pRenderTargets   = nullptr;
+    ObjectId                       DepthStencil     = InvalidObjectId;
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode   = RESOURCE_STATE_TRANSITION_MODE_NONE;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator)
+    {
+        return Ser(DepthStencil, TransitionMode) &&
+            Ser.SerializeArrayRaw(Allocator, pRenderTargets, NumRenderTargets);
+    }
+};
+
+struct SetViewportsCmd
+{
+    Uint32          NumViewports = 0;
+    const Viewport* pViewports   = nullptr;
+    Uint32          RTWidth      = 0;
+    Uint32          RTHeight     = 0;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator)
+    {
+        return Ser(RTWidth, RTHeight) && SerializeRawArray<Mode, Viewport>(Ser, Allocator, pViewports, NumViewports);
+    }
+};
+
+struct SetScissorRectsCmd
+{
+    Uint32      NumRects = 0;
+    const Rect* pRects   = nullptr;
+    Uint32      RTWidth  = 0;
+    Uint32      RTHeight = 0;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator* Allocator)
+    {
+        return Ser(RTWidth, RTHeight) && SerializeRawArray<Mode, Rect>(Ser, Allocator, pRects, NumRects);
+    }
+};
+
+struct SetStencilRefCmd
+{
+    Uint32 StencilRef = 0;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(StencilRef);
+    }
+};
+
+// CMD_SET_BLEND_FACTORS and CMD_BEGIN_DEBUG_GROUP
+struct ColorCmd
+{
+    const char* Name     = nullptr;
+    bool        HasColor = false;
+    float       Color[4] = {};
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Name, HasColor, Color);
+    }
+};
+
+struct ClearRenderTargetCmd
+{
+    ObjectId                       View           = InvalidObjectId;
+    float                          Color[4]       = {};
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(View, Color, TransitionMode);
+    }
+};
+
+struct ClearDepthStencilCmd
+{
+    ObjectId                       View           = InvalidObjectId;
+    CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags     = CLEAR_DEPTH_FLAG_NONE;
+    float                          Depth          = 1;
+    Uint8                          Stencil        = 0;
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(View, ClearFlags, Depth, Stencil, TransitionMode);
+    }
+};
+
+// CMD_DRAW, CMD_DRAW_INDEXED and CMD_DISPATCH_COMPUTE
+template <typename AttribsType>
+struct AttribsCmd
+{
+    AttribsType Attribs;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return SerializeRaw<Mode, AttribsType>(Ser, Attribs);
+    }
+};
+
+// CMD_UPDATE_BUFFER and CMD_WRITE_DYNAMIC_BUFFER
+struct UpdateBufferCmd
+{
+    ObjectId                       Buffer         = InvalidObjectId;
+    Uint64                         Offset         = 0;
+    const void*                    pData          = nullptr;
+    size_t                         DataSize       = 0;
+    RESOURCE_STATE_TRANSITION_MODE TransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(Buffer, Offset, TransitionMode) && Ser.SerializeBytes(pData, DataSize);
+    }
+};
+
+struct CopyBufferCmd
+{
+    ObjectId                       SrcBuffer         = InvalidObjectId;
+    Uint64                         SrcOffset         = 0;
+    RESOURCE_STATE_TRANSITION_MODE SrcTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+    ObjectId                       DstBuffer         = InvalidObjectId;
+    Uint64                         DstOffset         = 0;
+    Uint64                         Size              = 0;
+    RESOURCE_STATE_TRANSITION_MODE DstTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>& Ser, DynamicLinearAllocator*)
+    {
+        return Ser(SrcBuffer, SrcOffset, SrcTransitionMode, DstBuffer, DstOffset, Size, DstTransitionMode);
+    }
+};
+
+struct EmptyCmd
+{
+    template <SerializerMode Mode>
+    bool Serialize(Serializer<Mode>&, DynamicLinearAllocator*)
+    {
+        return true;
+    }
+};
+
+/// Appends the command with the given payload to the stream.
+template <typename CmdType>
+void AppendCommand(std::vector<Uint8>& Stream, CMD Cmd, CmdType& Payload)
+{
+    AppendCommand(Stream, Cmd, [&Payload](auto& Ser) {
+        const bool Res = Payload.Serialize(Ser, nullptr);
+        VERIFY(Res, "Failed to serialize the command payload");
+        (void)Res;
+    });
+}
+
+} // namespace CommandCaptureFormat
+
+} // namespace Diligent
@@ -30,6 +30,7 @@
 /// Definition of the Diligent::ReloadablePipelineState class
 
 #include <memory>
+#include <unordered_set>
 
 #include "PipelineState.h"
 #include "RenderStateCache.h"
@@ -70,6 +71,9 @@ public:
 
     bool Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData);
 
+    /// Returns true if the pipeline create info references any of the shaders.
+    bool UsesAnyShader(const std::unordered_set<const IShader*>& Shaders) const;
+
 private:
     void CopyStaticResources();
 
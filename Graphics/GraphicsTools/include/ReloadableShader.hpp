@@ -29,6 +29,9 @@
 /// \file
 /// Definition of the Diligent::ReloadableShader class
 
+#include <string>
+#include <vector>
+
 #include "Shader.h"
 #include "ShaderBase.hpp"
 
@@ -111,10 +114,18 @@ public:
 
     bool Reload();
 
+    /// Returns true if the shader source file or any file it includes matches the file path.
+    /// The dependencies are collected on the first call and after every reload.
+    bool DependsOnFile(const char* FilePath);
+
 private:
     RefCntAutoPtr<RenderStateCacheImpl> m_pStateCache;
     RefCntAutoPtr<IShader>              m_pShader;
     ShaderCreateInfoWrapper             m_CreateInfo;
+
+    // Shader source file and all include files
+    std::vector<std::string> m_Dependencies;
+    bool                     m_DependenciesValid = false;
 };
 
 } // namespace Diligent
@@ -30,7 +30,10 @@
 /// Definition of the Diligent::RenderStateCacheImpl class
 
 #include <unordered_map>
+#include <vector>
+#include <string>
 #include <mutex>
+#include <atomic>
 
 #include "RenderStateCache.h"
 #include "SerializationDevice.h"
@@ -38,6 +41,7 @@
 #include "UniqueIdentifier.hpp"
 #include "ObjectBase.hpp"
 #include "XXH128Hasher.hpp"
+#include "Timer.hpp"
 
 namespace Diligent
 {
@@ -52,6 +56,8 @@ public:
     RenderStateCacheImpl(IReferenceCounters*               pRefCounters,
                          const RenderStateCacheCreateInfo& CreateInfo);
 
+    ~RenderStateCacheImpl();
+
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_RenderStateCache, TBase);
 
     virtual bool DILIGENT_CALL_TYPE Load(const IDataBlob* pArchive,
@@ -96,10 +102,31 @@ public:
 
     virtual Bool DILIGENT_CALL_TYPE WriteToStream(Uint32 ContentVersion, IFileStream* pStream) override final;
 
+    virtual Bool DILIGENT_CALL_TYPE AppendToJournal(Uint32 ContentVersion, IFileStream* pJournal, IThreadPool* pThreadPool) override final;
+
+    virtual Bool DILIGENT_CALL_TYPE LoadJournal(const IDataBlob* pJournal, Uint32 ContentVersion, Bool MakeCopy) override final;
+
+    virtual void DILIGENT_CALL_TYPE WaitForJournal() override final;
+
     virtual void DILIGENT_CALL_TYPE Reset() override final;
 
     virtual Uint32 DILIGENT_CALL_TYPE Reload(ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline, void* pUserData) override final;
 
+    virtual Uint32 DILIGENT_CALL_TYPE ReloadFiles(const char* const*                 ppFilePaths,
+                                                  Uint32                             NumFiles,
+                                                  ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline,
+                                                  void*                              pUserData) override final;
+
+    virtual Bool DILIGENT_CALL_TYPE WriteUsageManifest(IDataBlob** ppManifest) override final;
+
+    virtual void DILIGENT_CALL_TYPE ResetUsage() override final;
+
+    virtual Uint32 DILIGENT_CALL_TYPE Prewarm(const IDataBlob* pManifest) override final;
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetNumPendingPrewarmPipelines() override final;
+
+    virtual void DILIGENT_CALL_TYPE ReleasePrewarmedPipelines() override final;
+
     virtual Uint32 DILIGENT_CALL_TYPE GetContentVersion() const override final
     {
         return m_pDearchiver ? m_pDearchiver->GetContentVersion() : ~0u;
@@ -119,6 +146,13 @@ private:
 
     static std::string MakeHashStr(const char* Name, const XXH128Hash& Hash);
 
+    // Serializes the render states from the archiver, moves them to the dearchiver and resets the archiver.
+    bool SerializeNewStates(Uint32 ContentVersion, RefCntAutoPtr<IDataBlob>& pNewData);
+
+    XXH128Hash GetShaderSourceHash(const ShaderCreateInfo& ShaderCI);
+
+    void RecordPipelineUsage(const PipelineStateDesc& PSODesc, const XXH128Hash& Hash);
+
     template <typename CreateInfoType>
     struct SerializedPsoCIWrapperBase;
 
@@ -142,6 +176,20 @@ private:
     std::mutex                                             m_ShadersMtx;
     std::unordered_map<XXH128Hash, RefCntWeakPtr<IShader>> m_Shaders;
 
+    struct ShaderSourceHashInfo
+    {
+        // Source factory that was used to read the shader source and its includes
+        RefCntWeakPtr<IShaderSourceInputStreamFactory> pFactory;
+
+        // Hash of the shader source including all include files
+        XXH128Hash Hash;
+    };
+    // Hashes of the shader sources keyed by the hash of the source factory pointer and
+    // the file path or the inline source, so that permutations of the same shader
+    // do not need to read and hash the source and all its includes again.
+    std::mutex                                           m_ShaderSourceHashesMtx;
+    std::unordered_map<XXH128Hash, ShaderSourceHashInfo> m_ShaderSourceHashes;
+
     std::mutex                                                   m_ReloadableShadersMtx;
     std::unordered_map<UniqueIdentifier, RefCntWeakPtr<IShader>> m_ReloadableShaders;
 
@@ -150,6 +198,31 @@ private:
 
     std::mutex                                                          m_ReloadablePipelinesMtx;
     std::unordered_map<UniqueIdentifier, RefCntWeakPtr<IPipelineState>> m_ReloadablePipelines;
+
+    struct PipelineUsageInfo
+    {
+        PIPELINE_TYPE PipelineType = PIPELINE_TYPE_INVALID;
+
+        // Pipeline name, if any
+        bool        HasName = false;
+        std::string Name;
+
+        // Time of the first request, in milliseconds since the usage recording started
+        Uint32 FirstUseTime = 0;
+    };
+    std::mutex                                        m_PipelineUsageMtx;
+    std::unordered_map<XXH128Hash, PipelineUsageInfo> m_PipelineUsage;
+    Timer                                             m_UsageTimer;
+
+    // Strong references to the pipelines created by Prewarm()
+    std::mutex                                 m_PrewarmedPipelinesMtx;
+    std::vector<RefCntAutoPtr<IPipelineState>> m_PrewarmedPipelines;
+
+    // The number of render states added to the archiver since it was last serialized
+    std::atomic<Uint32> m_NumNewStates{0};
+
+    // The last task that writes a journal record
+    RefCntAutoPtr<IAsyncTask> m_pJournalTask;
 };
 
 } // namespace Diligent
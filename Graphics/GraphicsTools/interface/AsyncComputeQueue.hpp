@@ -0,0 +1,180 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::AsyncComputeQueue class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Resource accessed by an asynchronous compute job, see Diligent::AsyncComputeJob.
+struct AsyncComputeResource
+{
+    /// Texture or buffer.
+    IDeviceObject* pResource = nullptr;
+
+    /// The state the job accesses the resource in, for example RESOURCE_STATE_SHADER_RESOURCE
+    /// or RESOURCE_STATE_UNORDERED_ACCESS.
+    RESOURCE_STATE State = RESOURCE_STATE_UNKNOWN;
+};
+
+/// Asynchronous compute job, see AsyncComputeQueue::Submit().
+struct AsyncComputeJob
+{
+    /// Job name used for the debug group. May be null.
+    const char* Name = nullptr;
+
+    /// Compute pipeline state.
+    IPipelineState* pPSO = nullptr;
+
+    /// Shader resource binding. May be null if the pipeline does not use resources.
+    IShaderResourceBinding* pSRB = nullptr;
+
+    /// Dispatches that are executed in order.
+    const DispatchComputeAttribs* pDispatches = nullptr;
+
+    /// The number of elements in pDispatches.
+    Uint32 NumDispatches = 0;
+
+    /// Resources produced by the source context and accessed by the job.
+    const AsyncComputeResource* pResources = nullptr;
+
+    /// The number of elements in pResources.
+    Uint32 NumResources = 0;
+};
+
+/// Token returned by AsyncComputeQueue::Submit() that other contexts can wait on.
+struct AsyncComputeToken
+{
+    /// The value of the compute fence that is signaled when the job is complete.
+    Uint64 FenceValue = 0;
+
+    /// Returns true if the token refers to a submitted job.
+    bool IsValid() const { return FenceValue != 0; }
+};
+
+/// Asynchronous compute queue.
+
+/// The helper runs compute jobs on an immediate context of an asynchronous compute queue
+/// and takes care of the synchronization that overlapping compute with graphics work requires:
+///
+/// - The resources of the job are transitioned to the requested states by the source context,
+///   because the compute queue can't transition resources out of graphics-only states
+///   such as RESOURCE_STATE_RENDER_TARGET.
+/// - The source context signals a fence and is flushed, and the compute context waits
+///   for the fence on the GPU before it executes the job.
+/// - The compute context signals its own fence after the job. The returned token is used
+///   to make other contexts wait for the job on the GPU (Wait()) or to poll the completion
+///   on the CPU (IsComplete()).
+///
+/// Resources that are accessed by several queues must be created with ImmediateContextMask
+/// that includes all of them. In Vulkan, such resources use concurrent sharing mode
+/// between the queue families, so no queue family ownership transfer is required.
+/// Resources whose state is not known to the engine are not transitioned.
+///
+/// \note   The class is not thread-safe.
+class AsyncComputeQueue
+{
+public:
+    /// \param[in] pDevice         - Render device to create the fences with.
+    /// \param[in] pComputeContext - Immediate context of the compute queue that executes the jobs.
+    ///
+    /// \remarks    The constructor throws an exception in case of an error.
+    AsyncComputeQueue(IRenderDevice* pDevice, IDeviceContext* pComputeContext);
+    ~AsyncComputeQueue();
+
+    // clang-format off
+    AsyncComputeQueue           (const AsyncComputeQueue&)  = delete;
+    AsyncComputeQueue& operator=(const AsyncComputeQueue&)  = delete;
+    AsyncComputeQueue           (      AsyncComputeQueue&&) = delete;
+    AsyncComputeQueue& operator=(      AsyncComputeQueue&&) = delete;
+    // clang-format on
+
+    /// Submits the compute job.
+
+    /// \param[in] pSrcContext - Immediate context that produced the job resources, typically
+    ///                          the graphics context. May be null, in which case the compute context
+    ///                          does not wait for any other context and transitions the resources itself.
+    /// \param[in] Job         - Compute job, see Diligent::AsyncComputeJob.
+    ///
+    /// \return     The token that other contexts can wait on, or an invalid token in case of an error.
+    ///
+    /// \remarks    Both the source and the compute contexts are flushed.
+    AsyncComputeToken Submit(IDeviceContext* pSrcContext, const AsyncComputeJob& Job);
+
+    /// Makes the context wait on the GPU for the job to complete.
+
+    /// \param[in] pContext - Immediate context that uses the results of the job.
+    /// \param[in] Token    - Token returned by Submit().
+    ///
+    /// \remarks    The method does not block the CPU. The context transitions the resources
+    ///             from the states used by the job as usual.
+    void Wait(IDeviceContext* pContext, const AsyncComputeToken& Token);
+
+    /// Returns true if the job has been completed by the GPU.
+    bool IsComplete(const AsyncComputeToken& Token) const;
+
+    /// Blocks the CPU until the job is completed by the GPU.
+    void WaitForCompletion(const AsyncComputeToken& Token);
+
+    /// Returns the compute context.
+    IDeviceContext* GetComputeContext() const { return m_pComputeContext; }
+
+    /// Returns the fence that is signaled by the compute context with the token values.
+    IFence* GetFence() const { return m_pFence; }
+
+private:
+    IFence* GetSourceFence(IDeviceContext* pSrcContext, Uint64& Value);
+
+private:
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pComputeContext;
+
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_FenceValue = 0;
+
+    struct SourceFence
+    {
+        RefCntAutoPtr<IFence> pFence;
+        Uint64                Value = 0;
+    };
+    // Fences signaled by the source contexts, indexed by the context id.
+    std::vector<SourceFence> m_SourceFences;
+
+    std::vector<StateTransitionDesc> m_Barriers;
+};
+
+} // namespace Diligent
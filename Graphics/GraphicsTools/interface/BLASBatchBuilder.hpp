@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::BLASBatchBuilder class
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/BottomLevelAS.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// BLAS batch builder create info.
+struct BLASBatchBuilderCreateInfo
+{
+    /// Prefix of the names of the shared scratch buffer, the compaction fence and the buffers that
+    /// receive compacted sizes. Compacted copies are named after their source BLAS instead.
+    /// If null, "BLAS batch builder" is used.
+    const char* Name = nullptr;
+
+    /// The maximum size of the shared scratch buffer, in bytes.
+
+    /// Builds whose total scratch size exceeds this value are split into several groups,
+    /// and the groups are separated by a barrier on the scratch buffer. A single build
+    /// that requires more scratch memory than this value enlarges the buffer.
+    Uint64 MaxScratchBufferSize = Uint64{64} << 20;
+};
+
+/// Builds many bottom-level acceleration structures at once and compacts them.
+
+/// IDeviceContext::BuildBLAS() needs a user-provided scratch buffer, and when the same buffer
+/// is reused, the state transition inserts a barrier between every two builds. The builder
+/// suballocates the scratch memory for all BLASes of a batch from one buffer and records all builds
+/// back to back without barriers, so that the GPU can execute them in parallel. The state transitions
+/// of the acceleration structures and geometry buffers are also issued once for the whole batch.
+///
+/// When compaction is requested, the builder writes the compacted sizes of the built BLASes and
+/// copies them to a readback buffer. ProcessCompaction() checks if the GPU has finished the batch,
+/// in which case it creates the compacted BLASes and records the compacting copies. This way
+/// the application never waits for the GPU, it only has to call ProcessCompaction() every frame
+/// and replace the source BLASes with the compacted ones.
+///
+/// \remarks    The device must support ray tracing. The context passed to Build() and ProcessCompaction()
+///             must be an immediate context.
+///
+/// \note   The class is not thread-safe.
+class BLASBatchBuilder
+{
+public:
+    BLASBatchBuilder(IRenderDevice* pDevice, const BLASBatchBuilderCreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    BLASBatchBuilder           (const BLASBatchBuilder&)  = delete;
+    BLASBatchBuilder& operator=(const BLASBatchBuilder&)  = delete;
+    BLASBatchBuilder           (      BLASBatchBuilder&&) = delete;
+    BLASBatchBuilder& operator=(      BLASBatchBuilder&&) = delete;
+    // clang-format on
+
+    /// Builds or updates the bottom-level acceleration structures.
+
+    /// \param [in] pContext  - Immediate device context.
+    /// \param [in] pAttribs  - An array of NumBLASes build attributes, one for every BLAS.
+    /// \param [in] NumBLASes - The number of elements in pAttribs.
+    /// \param [in] Compact   - Whether to compact the BLASes, see ProcessCompaction().
+    ///                         BLASes that were not created with RAYTRACING_BUILD_AS_ALLOW_COMPACTION
+    ///                         flag, as well as updated BLASes, are not compacted.
+    ///
+    /// \remarks    pScratchBuffer, ScratchBufferOffset and ScratchBufferTransitionMode members of
+    ///             the attributes are ignored.
+    ///
+    ///             BLASes and geometry buffers with RESOURCE_STATE_TRANSITION_MODE_TRANSITION mode are transitioned
+    ///             by one TransitionResourceStates() call before the builds, and the BLASes are transitioned to
+    ///             RESOURCE_STATE_BUILD_AS_READ state after the builds. With other modes, the application is
+    ///             responsible for the states as with IDeviceContext::BuildBLAS(). BLASes that are compacted are
+    ///             always transitioned to RESOURCE_STATE_BUILD_AS_READ state.
+    void Build(IDeviceContext* pContext, const BuildBLASAttribs* pAttribs, Uint32 NumBLASes, bool Compact = false);
+
+    /// Compacted BLAS.
+    struct CompactedBLAS
+    {
+        /// The BLAS passed to Build().
+        RefCntAutoPtr<IBottomLevelAS> pSource;
+
+        /// The compacted copy of the source BLAS.
+        RefCntAutoPtr<IBottomLevelAS> pCompacted;
+    };
+
+    /// Compacts the BLASes of all batches that have been completed by the GPU.
+
+    /// \param [in]  pContext  - Immediate device context. Must be the same context that was used by Build().
+    /// \param [out] Compacted - The BLASes compacted by this call are appended to this array.
+    ///
+    /// \return     The number of BLASes that have been compacted by this call.
+    ///
+    /// \remarks    The compacted BLASes are in RESOURCE_STATE_BUILD_AS_READ state. The application
+    ///             must not update or rebuild the source BLASes while the compaction is pending.
+    ///             Once the compacted BLAS is returned, the source BLAS may be released.
+    Uint32 ProcessCompaction(IDeviceContext* pContext, std::vector<CompactedBLAS>& Compacted);
+
+    /// Returns the number of BLASes whose compaction is pending.
+    Uint32 GetNumPendingCompactions() const { return m_NumPendingCompactions; }
+
+    /// Returns the current size of the shared scratch buffer.
+    Uint64 GetScratchBufferSize() const;
+
+private:
+    Uint64 GetScratchSize(const BuildBLASAttribs& Attribs) const;
+    void   ReserveScratchBuffer(Uint64 Size);
+    void   AddTransition(IBuffer* pBuffer, RESOURCE_STATE NewState);
+    void   BuildGroup(IDeviceContext* pContext, const BuildBLASAttribs* pAttribs, Uint32 NumBLASes, bool Compact);
+    void   WriteCompactedSizes(IDeviceContext* pContext, const BuildBLASAttribs* pAttribs, Uint32 NumBLASes);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const std::string m_Name;
+    const Uint64      m_MaxScratchBufferSize;
+
+    Uint64 m_ScratchAlignment = 1;
+
+    RefCntAutoPtr<IBuffer> m_pScratchBuffer;
+
+    // Fence signaled after every batch that needs compaction
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_NextFenceValue = 1;
+
+    struct PendingBatch
+    {
+        std::vector<RefCntAutoPtr<IBottomLevelAS>> BLASes;
+        RefCntAutoPtr<IBuffer>                     pReadbackBuffer;
+        Uint64                                     FenceValue = 0;
+    };
+    std::vector<PendingBatch> m_PendingBatches;
+    Uint32                    m_NumPendingCompactions = 0;
+
+    // Arrays reused between the calls
+    std::vector<StateTransitionDesc>  m_Barriers;
+    std::unordered_set<const IBuffer*> m_TransitionedBuffers;
+};
+
+} // namespace Diligent
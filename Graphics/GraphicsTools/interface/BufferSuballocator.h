@@ -105,12 +105,38 @@ struct BufferSuballocatorUsageStats
     /// The current number of allocations.
     Uint32 AllocationCount = 0;
 
+    /// The number of free chunks in the buffer.
+
+    /// \remarks    Together with MaxFreeChunkSize, this value indicates how fragmented the free
+    ///             space is: a large number of free chunks with a small maximum chunk size means
+    ///             that large allocations will require expanding the buffer.
+    Uint32 FreeChunkCount = 0;
+
+    /// The total size of the pages reserved by the thread caches, in bytes.
+
+    /// \remarks    The pages are included in UsedSize.
+    Uint64 ThreadCacheReservedSize = 0;
+
+    /// The total size of the live allocations made from the thread caches, in bytes.
+    ///
+    /// \remarks    The difference between ThreadCacheReservedSize and this value is the memory that is lost
+    ///             to the internal fragmentation of the pages, until they are reclaimed by
+    ///             IBufferSuballocator::ReconcileThreadCaches().
+    Uint64 ThreadCacheAllocatedSize = 0;
+
+    /// The number of pages reserved by the thread caches.
+    Uint32 ThreadCachePageCount = 0;
+
     BufferSuballocatorUsageStats& operator+=(const BufferSuballocatorUsageStats& rhs)
     {
         CommittedSize += rhs.CommittedSize;
         UsedSize += rhs.UsedSize;
         MaxFreeChunkSize = (std::max)(MaxFreeChunkSize, rhs.MaxFreeChunkSize);
         AllocationCount += rhs.AllocationCount;
+        FreeChunkCount += rhs.FreeChunkCount;
+        ThreadCacheReservedSize += rhs.ThreadCacheReservedSize;
+        ThreadCacheAllocatedSize += rhs.ThreadCacheAllocatedSize;
+        ThreadCachePageCount += rhs.ThreadCachePageCount;
         return *this;
     }
 };
@@ -146,11 +172,23 @@ struct IBufferSuballocator : public IObject
     ///                               stored.
     ///
     /// \remarks    The method is thread-safe and can be called from multiple threads simultaneously.
+    ///             If thread caches are enabled (see BufferSuballocatorCreateInfo::ThreadCachePageSize),
+    ///             small suballocations are made from the page owned by the calling thread without
+    ///             locking the shared allocator.
     virtual void Allocate(Uint32                 Size,
                           Uint32                 Alignment,
                           IBufferSuballocation** ppSuballocation) = 0;
 
 
+    /// Returns the thread cache pages that have no live suballocations to the shared allocator.
+
+    /// \remarks    The pages of the thread caches are not released when their last suballocation
+    ///             is released, as this would require locking the shared allocator. Instead, the
+    ///             application should call this method once per frame.
+    ///             The method is thread-safe. It does nothing if thread caches are disabled.
+    virtual void ReconcileThreadCaches() = 0;
+
+
     /// Returns the suballocator usage stats, see Diligent::BufferSuballocatorUsageStats.
     virtual void GetUsageStats(BufferSuballocatorUsageStats& UsageStats) = 0;
 
@@ -158,6 +196,37 @@ struct IBufferSuballocator : public IObject
     /// Returns the internal buffer version. The version is incremented every time
     /// the buffer is expanded.
     virtual Uint32 GetVersion() const = 0;
+
+
+    /// Moves suballocations towards the beginning of the buffer to reduce fragmentation.
+
+    /// \param[in]  pDevice        - A pointer to the render device that will be used to create
+    ///                              the intermediate copy buffer, if necessary.
+    /// \param[in]  pContext       - A pointer to the device context that will be used to
+    ///                              record copy commands.
+    /// \param[in]  MaxBytesToMove - The maximum number of bytes to move during this call.
+    ///
+    /// \return     The number of bytes moved.
+    ///
+    /// \remarks    The method performs one incremental compaction step and is intended to be
+    ///             called once per frame with a bounded budget. Every suballocation that can be
+    ///             moved to a lower free range is copied through an intermediate buffer using
+    ///             pContext, after which its offset (see IBufferSuballocation::GetOffset()) is updated
+    ///             and the old range is released. All commands recorded in pContext after this call
+    ///             observe the new layout, so the new offsets can be used immediately.
+    ///             When at least one suballocation is moved, the layout version (see GetLayoutVersion())
+    ///             is incremented so that the application can rebuild the data that stores offsets,
+    ///             such as indirect draw arguments.
+    ///
+    ///             The method must be called from the same thread as Update(). Allocating and
+    ///             releasing suballocations in other threads at the same time is safe.
+    ///             Suballocations made from thread cache pages are never moved.
+    virtual Uint64 Defragment(IRenderDevice* pDevice, IDeviceContext* pContext, Uint64 MaxBytesToMove) = 0;
+
+
+    /// Returns the layout version. The version is incremented every time
+    /// Defragment() changes the offset of at least one suballocation.
+    virtual Uint32 GetLayoutVersion() const = 0;
 };
 
 /// Buffer suballocator create information.
@@ -187,6 +256,19 @@ struct BufferSuballocatorCreateInfo
     ///             to true, the validation is disabled.
     ///             The flag is ignored in release builds as the validation is always disabled.
     bool DisableDebugValidation = false;
+
+    /// The size of the pages reserved by thread caches, in bytes.
+
+    /// \remarks    When non-zero, every thread that allocates from the suballocator (up to 16 threads
+    ///             get their own cache) reserves pages of this size from the shared allocator, and
+    ///             suballocations that are not larger than a quarter of the page size are made from
+    ///             these pages without locking the shared allocator. Released space in the pages
+    ///             is not reused. A full page is retired and returned to the shared allocator by
+    ///             IBufferSuballocator::ReconcileThreadCaches() once all its suballocations are released.
+    ///
+    ///             This mode is intended for many threads that allocate a large number of small
+    ///             suballocations with similar lifetimes, such as mesh chunks of streamed content.
+    Uint32 ThreadCachePageSize = 0;
 };
 
 /// Creates a new buffer suballocator.
@@ -35,6 +35,21 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 struct BytecodeCacheCreateInfo
 {
     enum RENDER_DEVICE_TYPE DeviceType DEFAULT_INITIALIZER(RENDER_DEVICE_TYPE_UNDEFINED);
+
+    /// An optional directory to persist the byte code in.
+
+    /// When the directory is specified, every byte code is also stored in a separate
+    /// file named after the hash of the shader create parameters. Files are written
+    /// to a temporary file first and then renamed, so multiple processes may safely
+    /// share the same directory. Byte code that is not found in memory is looked up
+    /// in the directory.
+    const Char* CacheDirectory DEFAULT_INITIALIZER(nullptr);
+
+    /// The maximum total size of the files in the cache directory, in bytes.
+
+    /// When the limit is exceeded, the least recently used files are deleted.
+    /// Zero means no limit.
+    Uint64 MaxDirectorySize DEFAULT_INITIALIZER(0);
 };
 typedef struct BytecodeCacheCreateInfo BytecodeCacheCreateInfo;
 
@@ -79,7 +94,8 @@ DILIGENT_BEGIN_INTERFACE(IBytecodeCache, IObject)
     /// \param [in] pByteCode - A pointer to the byte code to add to the cache.
     ///
     /// \remarks    If the byte code for the given shader create parameters is already present
-    ///             in the cache, it is replaced.
+    ///             in the cache, it is replaced. If the cache directory is specified, the byte
+    ///             code is also written to the directory.
     VIRTUAL void METHOD(AddBytecode)(THIS_ 
                                      const ShaderCreateInfo REF ShaderCI,
                                      IDataBlob*                 pByteCode) PURE;
@@ -87,6 +103,8 @@ DILIGENT_BEGIN_INTERFACE(IBytecodeCache, IObject)
     /// Removes the byte code from the cache.
 
     /// \param [in] ShaderCI - Shader create information for the byte code to remove.
+    ///
+    /// \remarks    If the cache directory is specified, the byte code file is deleted as well.
     VIRTUAL void METHOD(RemoveBytecode)(THIS_ 
                                         const ShaderCreateInfo REF ShaderCI) PURE;
 
@@ -103,6 +121,8 @@ DILIGENT_BEGIN_INTERFACE(IBytecodeCache, IObject)
 
 
     /// Clears the cache and resets it to default state.
+
+    /// \remarks   The files in the cache directory are not deleted.
     VIRTUAL void METHOD(Clear)(THIS) PURE;
 };
 DILIGENT_END_INTERFACE
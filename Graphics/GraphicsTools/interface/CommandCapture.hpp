@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::CommandCapture class
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/Serializer.hpp"
+
+namespace Diligent
+{
+
+/// Records the device context command stream and the resources it references,
+/// so that the frames can be replayed by Diligent::CommandReplay on any backend.
+
+/// The capture is a recording layer on top of the render device and the immediate context:
+/// the application creates the objects and records the commands through the capture instead of
+/// calling the device and the context directly. Every call is executed immediately and is also
+/// recorded into the capture.
+///
+/// Commands recorded between BeginFrame() and EndFrame() form a frame. Everything recorded
+/// outside of the frames (object creation, initial buffer updates, shader variable bindings)
+/// forms the setup stream that the replay executes once before replaying the frames.
+///
+/// The captured data includes:
+/// - Buffers and textures with their initial data. Buffers and textures that were not created
+///   through the capture (e.g. swap chain images) are recreated on replay from their descriptions
+///   without contents.
+/// - Buffer and texture views, samplers.
+/// - Shaders, as source code with all includes unrolled, or as bytecode. Source shaders can be
+///   replayed on any backend, bytecode only on the backend it was compiled for.
+/// - Graphics and compute pipelines that use the implicit resource signature defined by the resource
+///   layout, without render passes.
+/// - Shader resource bindings and the variable bindings.
+///
+/// \note   Commands issued directly to the context are not captured. The file format stores
+///         description structures as raw bytes and is only compatible with the same engine version.
+///         The class is not thread-safe.
+class CommandCapture
+{
+public:
+    CommandCapture(IRenderDevice* pDevice, IDeviceContext* pContext) noexcept(false);
+
+    // clang-format off
+    CommandCapture           (const CommandCapture&)  = delete;
+    CommandCapture& operator=(const CommandCapture&)  = delete;
+    CommandCapture           (      CommandCapture&&) = delete;
+    CommandCapture& operator=(      CommandCapture&&) = delete;
+    // clang-format on
+
+    ~CommandCapture();
+
+    IRenderDevice*  GetDevice() const { return m_pDevice; }
+    IDeviceContext* GetContext() const { return m_pContext; }
+
+    /// \name Object creation
+    /// The methods have the same semantics as the corresponding IRenderDevice methods.
+    ///@{
+    void CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer);
+    void CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture);
+    void CreateSampler(const SamplerDesc& SamDesc, ISampler** ppSampler);
+    void CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader, IDataBlob** ppCompilerOutput = nullptr);
+    void CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState);
+    void CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState);
+    void CreateShaderResourceBinding(IPipelineState* pPSO, IShaderResourceBinding** ppSRB, bool InitStaticResources = false);
+    ///@}
+
+    /// Binds the object to the static variable of the pipeline and records the binding.
+    /// The object must be a buffer, a buffer view, a texture view or a sampler.
+    void SetStaticVariable(IPipelineState* pPSO, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject, Uint32 ArrayIndex = 0);
+
+    /// Binds the object to the mutable or dynamic variable of the shader resource binding and records the binding.
+    /// The object must be a buffer, a buffer view, a texture view or a sampler.
+    void SetVariable(IShaderResourceBinding* pSRB, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject, Uint32 ArrayIndex = 0);
+
+    /// Begins a new frame.
+    void BeginFrame();
+
+    /// Ends the current frame.
+    void EndFrame();
+
+    /// \name Device context commands
+    /// The methods have the same semantics as the corresponding IDeviceContext methods.
+    ///@{
+    void SetPipelineState(IPipelineState* pPipelineState);
+    void CommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void SetVertexBuffers(Uint32                         StartSlot,
+                          Uint32                         NumBuffersSet,
+                          IBuffer* const*                ppBuffers,
+                          const Uint64*                  pOffsets,
+                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                          SET_VERTEX_BUFFERS_FLAGS       Flags = SET_VERTEX_BUFFERS_FLAG_NONE);
+    void SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void SetRenderTargets(Uint32                         NumRenderTargets,
+                          ITextureView*                  ppRenderTargets[],
+                          ITextureView*                  pDepthStencil,
+                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight);
+    void SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight);
+    void SetStencilRef(Uint32 StencilRef);
+    void SetBlendFactors(const float* pBlendFactors = nullptr);
+    void ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void ClearDepthStencil(ITextureView*                  pView,
+                           CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                           float                          fDepth,
+                           Uint8                          Stencil,
+                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void Draw(const DrawAttribs& Attribs);
+    void DrawIndexed(const DrawIndexedAttribs& Attribs);
+    void DispatchCompute(const DispatchComputeAttribs& Attribs);
+    void UpdateBuffer(IBuffer* pBuffer, Uint64 Offset, Uint64 Size, const void* pData, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+    void CopyBuffer(IBuffer*                       pSrcBuffer,
+                    Uint64                         SrcOffset,
+                    RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                    IBuffer*                       pDstBuffer,
+                    Uint64                         DstOffset,
+                    Uint64                         Size,
+                    RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode);
+    void BeginDebugGroup(const char* Name, const float* pColor = nullptr);
+    void EndDebugGroup();
+    ///@}
+
+    /// Maps the dynamic buffer with MAP_FLAG_DISCARD, writes the data and records the contents.
+    /// This replaces the MapBuffer()/UnmapBuffer() pair, whose writes can not be intercepted.
+    void WriteDynamicBuffer(IBuffer* pBuffer, const void* pData, Uint64 Size);
+
+    /// Returns the number of completed frames.
+    Uint32 GetNumFrames() const { return static_cast<Uint32>(m_Frames.size()); }
+
+    /// Serializes the capture.
+    SerializedData Serialize(IMemoryAllocator& Allocator) const;
+
+    /// Serializes the capture and writes it to the file.
+    bool SaveToFile(const char* FilePath) const;
+
+private:
+    using ObjectId = Uint32;
+
+    std::vector<Uint8>& GetStream();
+
+    // Returns the id of the object, or registers objects that were not created through the capture.
+    // Returns the invalid id for null and unsupported objects.
+    ObjectId GetObjectId(IObject* pObject);
+    ObjectId AddObject(IObject* pObject);
+
+    void RecordSetVariable(bool IsStatic, ObjectId Owner, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject, Uint32 ArrayIndex);
+
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+
+    // Keep the objects alive so that their addresses can not be reused by other objects
+    std::vector<RefCntAutoPtr<IObject>>    m_Objects;
+    std::unordered_map<IObject*, ObjectId> m_ObjectIds;
+
+    std::vector<Uint8>              m_SetupStream;
+    std::vector<std::vector<Uint8>> m_Frames;
+
+    bool m_IsInFrame = false;
+};
+
+} // namespace Diligent
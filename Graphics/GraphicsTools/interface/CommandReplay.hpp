@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::CommandReplay class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/DynamicLinearAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Replay statistics of a single captured frame.
+struct CommandReplayFrameStats
+{
+    /// The number of times the frame was replayed.
+    Uint32 NumSamples = 0;
+
+    /// CPU time, in seconds, spent recording and submitting the frame commands.
+    double MinCPUTime = 0;
+    double AvgCPUTime = 0;
+    double MaxCPUTime = 0;
+
+    /// The number of GPU time samples. Zero if GPU time was not measured.
+    Uint32 NumGPUSamples = 0;
+
+    /// GPU time, in seconds, measured with timestamp queries.
+    double MinGPUTime = 0;
+    double AvgGPUTime = 0;
+    double MaxGPUTime = 0;
+};
+
+/// Replays the command stream recorded by Diligent::CommandCapture.
+
+/// The constructor recreates all captured objects and executes the setup stream.
+/// The frames may then be replayed individually with ReplayFrame(), or repeatedly with Run()
+/// that also collects per-frame CPU and GPU timings.
+///
+/// \note   The replay does not restore resource contents between the iterations, so frames
+///         that read the data written by previous frames may produce different results on
+///         subsequent iterations. This does not affect the amount of work they submit.
+class CommandReplay
+{
+public:
+    /// Creates the replay from the capture data. The data is copied.
+    CommandReplay(IRenderDevice* pDevice, IDeviceContext* pContext, const void* pData, size_t DataSize) noexcept(false);
+
+    /// Creates the replay from the capture file.
+    CommandReplay(IRenderDevice* pDevice, IDeviceContext* pContext, const char* FilePath) noexcept(false);
+
+    // clang-format off
+    CommandReplay           (const CommandReplay&)  = delete;
+    CommandReplay& operator=(const CommandReplay&)  = delete;
+    CommandReplay           (      CommandReplay&&) = delete;
+    CommandReplay& operator=(      CommandReplay&&) = delete;
+    // clang-format on
+
+    ~CommandReplay();
+
+    /// Returns the number of captured frames.
+    Uint32 GetNumFrames() const { return static_cast<Uint32>(m_Frames.size()); }
+
+    /// Returns the number of captured objects.
+    Uint32 GetNumObjects() const { return static_cast<Uint32>(m_Objects.size()); }
+
+    /// Returns the recreated object. Object ids are assigned in the order in which the objects
+    /// were created or first referenced by the capture, starting from zero.
+    IObject* GetObjectById(Uint32 Id) const { return Id < m_Objects.size() ? m_Objects[Id].pObject.RawPtr() : nullptr; }
+
+    /// Records the commands of the frame into the device context.
+    bool ReplayFrame(Uint32 FrameIndex);
+
+    /// Replays all frames NumIterations times and returns the statistics for every frame.
+
+    /// \param [in] NumIterations  - The number of times to replay the frame sequence.
+    /// \param [in] MeasureGPUTime - Whether to measure GPU time. Requires timestamp queries.
+    ///
+    /// \remarks    The context is flushed after every frame. The method waits for the GPU
+    ///             to become idle before returning.
+    std::vector<CommandReplayFrameStats> Run(Uint32 NumIterations, bool MeasureGPUTime = true);
+
+private:
+    void Initialize();
+    bool ExecuteStream(const Uint8* pData, size_t Size);
+    bool ExecuteCommand(Uint32 Cmd, const void* pPayload, size_t PayloadSize);
+
+    template <typename InterfaceType>
+    InterfaceType* GetTypedObject(Uint32 Id, const INTERFACE_ID& IID) const;
+    bool SetObject(Uint32 Id, IObject* pObject, const INTERFACE_ID& IID);
+
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+
+    std::vector<Uint8> m_Data;
+
+    struct StreamData
+    {
+        const Uint8* pData = nullptr;
+        size_t       Size  = 0;
+    };
+    StreamData              m_SetupStream;
+    std::vector<StreamData> m_Frames;
+
+    struct ObjectInfo
+    {
+        RefCntAutoPtr<IObject> pObject;
+        INTERFACE_ID           IID;
+    };
+    std::vector<ObjectInfo> m_Objects;
+
+    // Temporary storage for arrays of the command being executed
+    DynamicLinearAllocator m_Allocator;
+};
+
+} // namespace Diligent
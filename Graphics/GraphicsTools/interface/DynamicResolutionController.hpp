@@ -0,0 +1,266 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::DynamicResolutionController class
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "DurationQueryHelper.hpp"
+
+namespace Diligent
+{
+
+/// Defines how the dynamic resolution controller provides render targets of the current resolution.
+enum DYNAMIC_RESOLUTION_MODE : Uint8
+{
+    /// Render targets are created once with the maximum size, and rendering is
+    /// limited to the top-left sub-rectangle with the current resolution.
+    /// Textures are only recreated when the maximum size changes.
+    DYNAMIC_RESOLUTION_MODE_VIEWPORT = 0,
+
+    /// Render targets are recreated with the current resolution every time it changes.
+    DYNAMIC_RESOLUTION_MODE_REALLOCATE,
+
+    DYNAMIC_RESOLUTION_MODE_COUNT
+};
+
+/// Dynamic resolution controller create info.
+struct DynamicResolutionControllerCreateInfo
+{
+    /// Identifies the controller in log messages and prefixes the default names of render
+    /// targets whose descriptions have no name. If null, "Dynamic resolution controller" is used.
+    const char* Name = nullptr;
+
+    /// Maximum (native) render width.
+    Uint32 MaxWidth = 0;
+
+    /// Maximum (native) render height.
+    Uint32 MaxHeight = 0;
+
+    /// Render target management mode, see Diligent::DYNAMIC_RESOLUTION_MODE.
+    DYNAMIC_RESOLUTION_MODE Mode = DYNAMIC_RESOLUTION_MODE_VIEWPORT;
+
+    /// Descriptions of the render targets managed by the controller. Width and height are ignored.
+    /// May be null if the application manages the render targets itself.
+    const TextureDesc* pRenderTargets = nullptr;
+
+    /// The number of elements in pRenderTargets array.
+    Uint32 NumRenderTargets = 0;
+
+    /// GPU time budget, in seconds, for the work enclosed by BeginFrame() and EndFrame().
+    float TargetGPUTime = 1.f / 60.f;
+
+    /// Minimum and maximum scale of the render width and height.
+    float MinScale = 0.5f;
+    float MaxScale = 1.0f;
+
+    /// Initial scale.
+    float InitialScale = 1.0f;
+
+    /// Scale quantization step. The applied scale is changed only when the controller output
+    /// differs from it by at least one step, which prevents resolution changes every frame.
+    float ScaleStep = 0.025f;
+
+    /// Proportional, integral and derivative gains of the controller.
+    /// The error is the relative GPU time headroom: e = 1 - GPUTime / TargetGPUTime.
+    /// The controller is implemented in the velocity form, i.e. every measurement changes
+    /// the scale by Ki * e + Kp * (e - e') + Kd * (e - 2 * e' + e''), where e' and e''
+    /// are the previous errors.
+    float Kp = 0.1f;
+    float Ki = 0.05f;
+    float Kd = 0.02f;
+
+    /// Exponential smoothing factor of the GPU time, in (0, 1]. Larger values react faster.
+    float Smoothing = 0.25f;
+
+    /// Relative GPU time overshoot above which the scale is reduced immediately
+    /// assuming that the GPU time is proportional to the number of pixels.
+    float PanicThreshold = 0.25f;
+
+    /// Whether to measure the GPU time with timestamp queries between BeginFrame() and EndFrame().
+    /// Requires DeviceFeatures::TimestampQueries. If false or the queries are not supported,
+    /// the GPU time must be provided with Update().
+    bool MeasureGPUTime = true;
+};
+
+/// Adjusts the render resolution to keep the GPU time within the budget.
+
+/// Every frame, the GPU time is fed to a PID controller that adjusts the render scale.
+/// The time is measured with timestamp queries between BeginFrame() and EndFrame() or provided by the
+/// application with Update() (e.g. from Diligent::GPUProfiler). The query results arrive a few frames later,
+/// so the gains should be low enough to keep the loop stable with this latency. Sudden spikes that exceed
+/// the budget by more than PanicThreshold bypass the controller and reduce the scale immediately.
+///
+/// The new resolution is applied by BeginFrame(), so the render size, the viewport and the render targets
+/// stay the same for the whole frame. In DYNAMIC_RESOLUTION_MODE_VIEWPORT mode, the scene must be rendered
+/// with the viewport returned by GetViewport(), and the upscaler must sample the top-left part of
+/// the render targets defined by GetUVScale().
+///
+/// Typical usage:
+///
+///     Controller.BeginFrame(pContext);
+///     Controller.SetViewport(pContext);
+///     // Render the scene into Controller.GetRenderTarget(i)
+///     Controller.EndFrame(pContext);
+///     // Upscale to the swap chain using GetRenderWidth(), GetRenderHeight() and GetUVScale()
+///
+/// \note   The class is not thread-safe.
+class DynamicResolutionController
+{
+public:
+    DynamicResolutionController(IRenderDevice* pDevice, const DynamicResolutionControllerCreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    DynamicResolutionController           (const DynamicResolutionController&)  = delete;
+    DynamicResolutionController& operator=(const DynamicResolutionController&)  = delete;
+    DynamicResolutionController           (      DynamicResolutionController&&) = delete;
+    DynamicResolutionController& operator=(      DynamicResolutionController&&) = delete;
+    // clang-format on
+
+    ~DynamicResolutionController();
+
+    /// Applies the resolution computed from the previous measurements, (re)creates the render
+    /// targets if necessary and begins measuring the GPU time.
+    void BeginFrame(IDeviceContext* pContext);
+
+    /// Ends measuring the GPU time and updates the controller with the oldest available measurement.
+    void EndFrame(IDeviceContext* pContext);
+
+    /// Updates the controller with the GPU time of a frame.
+
+    /// \param [in] GPUTime - GPU time, in seconds.
+    /// \param [in] Scale   - Scale the frame was rendered with, or 0 to use the current scale.
+    ///
+    /// \remarks   The new scale is applied by the next BeginFrame().
+    void Update(double GPUTime, float Scale = 0);
+
+    /// Sets the maximum render size, e.g. when the window is resized.
+    /// The render targets are recreated by the next BeginFrame().
+    void Resize(Uint32 MaxWidth, Uint32 MaxHeight);
+
+    /// Sets the GPU time budget, in seconds.
+    void SetTargetGPUTime(float TargetGPUTime);
+
+    /// Resets the controller state and sets the scale.
+    void Reset(float Scale);
+
+    /// Returns the scale of the current frame.
+    float GetScale() const { return m_AppliedScale; }
+
+    /// Returns the scale that will be applied by the next BeginFrame().
+    float GetPendingScale() const { return m_PendingScale; }
+
+    /// Returns the render size of the current frame.
+    Uint32 GetRenderWidth() const { return m_RenderWidth; }
+    Uint32 GetRenderHeight() const { return m_RenderHeight; }
+
+    Uint32 GetMaxWidth() const { return m_MaxWidth; }
+    Uint32 GetMaxHeight() const { return m_MaxHeight; }
+
+    /// Returns the size of the render targets.
+    Uint32 GetTargetWidth() const { return m_TargetWidth; }
+    Uint32 GetTargetHeight() const { return m_TargetHeight; }
+
+    /// Returns the ratio of the render size to the render target size, i.e. the maximum
+    /// texture coordinates of the rendered area.
+    float2 GetUVScale() const;
+
+    /// Returns the viewport that covers the rendered area.
+    Viewport GetViewport() const;
+
+    /// Sets the viewport returned by GetViewport().
+    void SetViewport(IDeviceContext* pContext) const;
+
+    Uint32 GetNumRenderTargets() const { return static_cast<Uint32>(m_RenderTargets.size()); }
+
+    /// Returns the render target with the given index, see DynamicResolutionControllerCreateInfo::pRenderTargets.
+    ITexture* GetRenderTarget(Uint32 Index) const;
+
+    /// Returns the smoothed GPU time, in seconds, or 0 if no measurements have been made yet.
+    double GetSmoothedGPUTime() const { return m_SmoothedGPUTime; }
+
+    /// Returns the total number of GPU time measurements.
+    Uint64 GetNumMeasurements() const { return m_NumMeasurements; }
+
+    /// Returns the total number of times the render targets have been (re)created.
+    Uint32 GetNumTargetAllocations() const { return m_NumTargetAllocations; }
+
+private:
+    void UpdateRenderSize();
+    void CreateRenderTargets(Uint32 Width, Uint32 Height);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    DynamicResolutionControllerCreateInfo m_CI;
+
+    const std::string        m_Name;
+    std::vector<TextureDesc> m_TargetDescs;
+    std::vector<std::string> m_TargetNames;
+
+    std::vector<RefCntAutoPtr<ITexture>> m_RenderTargets;
+
+    std::unique_ptr<DurationQueryHelper> m_DurationQueries;
+
+    // Scales of the frames whose GPU time has not been read yet
+    std::deque<float> m_PendingFrameScales;
+
+    bool m_IsInFrame = false;
+
+    Uint32 m_MaxWidth     = 0;
+    Uint32 m_MaxHeight    = 0;
+    Uint32 m_RenderWidth  = 0;
+    Uint32 m_RenderHeight = 0;
+    Uint32 m_TargetWidth  = 0;
+    Uint32 m_TargetHeight = 0;
+
+    // Continuous controller output
+    float m_ControllerScale = 1;
+    // Quantized scale that will be applied by the next BeginFrame()
+    float m_PendingScale = 1;
+    // Scale of the current frame
+    float m_AppliedScale = 1;
+
+    // Previous two errors
+    float  m_PrevError[2]    = {};
+    double m_SmoothedGPUTime = 0;
+
+    Uint64 m_NumMeasurements      = 0;
+    Uint32 m_NumTargetAllocations = 0;
+};
+
+} // namespace Diligent
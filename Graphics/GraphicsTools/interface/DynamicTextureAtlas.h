@@ -111,6 +111,22 @@ struct DynamicTextureAtlasUsageStats
     /// Used area is always equal to or larger than the
     /// allocated area due to alignment requirements.
     Uint64 UsedArea = 0;
+
+    /// The number of slices that contain at least one allocation.
+    Uint32 AllocatedSliceCount = 0;
+
+    /// The total number of free regions in all allocated slices.
+    Uint32 FreeRegionCount = 0;
+
+    /// The ratio of the used area to the total area of the allocated slices.
+    float Occupancy = 0;
+
+    /// Fragmentation of the free space in the allocated slices, in [0, 1] range.
+
+    /// Fragmentation is computed as one minus the ratio of the sum of the largest free
+    /// region areas of all allocated slices to the total free area of these slices.
+    /// Zero means that the free space of every slice is a single region.
+    float Fragmentation = 0;
 };
 
 
@@ -178,6 +194,22 @@ struct IDynamicTextureAtlas : public IObject
 };
 
 
+/// Dynamic texture atlas region packing algorithm.
+enum DYNAMIC_TEXTURE_ATLAS_PACKING : Uint8
+{
+    /// Regions are placed into the best-fitting free rectangle that is split
+    /// into smaller rectangles (see Diligent::DynamicAtlasManager).
+    /// Works best for regions of arbitrary sizes.
+    DYNAMIC_TEXTURE_ATLAS_PACKING_GUILLOTINE = 0,
+
+    /// Regions are placed left to right into horizontal shelves whose heights are rounded
+    /// up to size classes (see Diligent::ShelfAtlasManager). Allocation and release take
+    /// logarithmic time. Works best for a large number of small regions of similar sizes,
+    /// such as glyphs or thumbnails.
+    DYNAMIC_TEXTURE_ATLAS_PACKING_SHELF,
+};
+
+
 /// Dynamic texture atlas create information.
 struct DynamicTextureAtlasCreateInfo
 {
@@ -237,6 +269,9 @@ struct DynamicTextureAtlasCreateInfo
     /// Maximum number of slices in texture array.
     Uint32 MaxSliceCount = 2048;
 
+    /// Region packing algorithm, see Diligent::DYNAMIC_TEXTURE_ATLAS_PACKING.
+    DYNAMIC_TEXTURE_ATLAS_PACKING Packing = DYNAMIC_TEXTURE_ATLAS_PACKING_GUILLOTINE;
+
     /// Silence allocation errors.
     bool Silent = false;
 };
@@ -97,6 +97,15 @@ public:
         pCtx->EnqueueSignal(m_pFence, m_NextFenceValue++);
     }
 
+    /// Waits until the GPU completes all enqueued objects.
+
+    /// \remarks   The context that was used to enqueue the objects must be flushed first.
+    void WaitForAll()
+    {
+        if (m_NextFenceValue > 1)
+            m_pFence->Wait(m_NextFenceValue - 1);
+    }
+
 private:
     struct PendingObject
     {
@@ -0,0 +1,293 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::GPUProfiler class
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Query.h"
+#include "../../GraphicsEngine/interface/CommandQueue.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// GPU profiler create info.
+struct GPUProfilerCreateInfo
+{
+    /// The maximum number of frames whose results may be pending at the same time.
+    /// If the GPU falls further behind, new frames are not profiled.
+    Uint32 NumFramesInFlight = 4;
+
+    /// The number of timestamp queries to create upfront. The pool grows as needed.
+    Uint32 InitialQueryCount = 256;
+
+    /// Whether to enclose every scope in a debug group with the same name.
+    bool EmitDebugGroups = true;
+};
+
+/// GPU profiling scope of a resolved frame.
+struct GPUProfileNode
+{
+    /// Scope name.
+    const char* Name = nullptr;
+
+    /// Index of the parent node in the frame, or ~0u for the frame root.
+    Uint32 Parent = ~0u;
+
+    /// Nesting depth, 0 for the frame root.
+    Uint32 Depth = 0;
+
+    /// Start time relative to the frame start, in seconds.
+    double StartTime = 0;
+
+    /// Scope duration, in seconds.
+    double Duration = 0;
+};
+
+/// Statistics of a GPU profiling scope accumulated over all resolved frames.
+struct GPUProfileScopeStats
+{
+    /// Scope name.
+    std::string Name;
+
+    /// Index of the parent scope in the statistics array, or ~0u for the frame root.
+    Uint32 Parent = ~0u;
+
+    /// Nesting depth, 0 for the frame root.
+    Uint32 Depth = 0;
+
+    /// The number of frames in which the scope was recorded.
+    Uint32 NumFrames = 0;
+
+    /// The minimum, maximum and total time spent in the scope per frame, in seconds.
+    /// If the scope is entered multiple times in one frame, the durations are added up.
+    double MinTime   = 0;
+    double MaxTime   = 0;
+    double TotalTime = 0;
+
+    double GetAvgTime() const
+    {
+        return NumFrames > 0 ? TotalTime / NumFrames : 0;
+    }
+};
+
+/// Hierarchical GPU profiler.
+
+/// The profiler records a pair of timestamp queries for every scope between BeginFrame() and EndFrame().
+/// Query objects are taken from a pool and reused once the results have been read, so no objects
+/// are created in steady state; the backends allocate the queries from their query heaps.
+/// The results of all scopes of a frame are read at once, when the last timestamp of the
+/// frame becomes available, and are combined into a tree (see GetLastFrame()) and into
+/// per-scope statistics (see GetStats()).
+/// Between BeginCapture() and EndCapture(), the resolved frames are also accumulated and written
+/// out in the Chrome trace event format used by CPUProfiler.
+///
+/// \remarks    All methods must be called on the same immediate context.
+///             Scope names must be string literals or otherwise outlive the profiler.
+///             Dynamic names can be interned with CPUProfiler::InternName().
+class GPUProfiler
+{
+public:
+    GPUProfiler(IRenderDevice* pDevice, const GPUProfilerCreateInfo& CI);
+
+    // clang-format off
+    GPUProfiler           (const GPUProfiler&)  = delete;
+    GPUProfiler& operator=(const GPUProfiler&)  = delete;
+    GPUProfiler           (      GPUProfiler&&) = delete;
+    GPUProfiler& operator=(      GPUProfiler&&) = delete;
+    // clang-format on
+
+    /// Reads the results of the completed frames and begins a new frame.
+
+    /// \param [in] pContext - Immediate device context.
+    /// \param [in] Name     - Name of the frame root scope.
+    void BeginFrame(IDeviceContext* pContext, const char* Name = "Frame");
+
+    /// Ends the frame started by BeginFrame(). All scopes must be closed.
+    void EndFrame(IDeviceContext* pContext);
+
+    /// Begins a nested scope and, if EmitDebugGroups is true, a debug group with the same name.
+    void BeginScope(IDeviceContext* pContext, const char* Name, const float* pColor = nullptr);
+
+    /// Ends the scope started by the matching BeginScope().
+    void EndScope(IDeviceContext* pContext);
+
+    /// Returns the scopes of the last resolved frame, in the order they were begun.
+    /// The first node is the frame root.
+    const std::vector<GPUProfileNode>& GetLastFrame() const { return m_LastFrame; }
+
+    /// Returns the statistics of all scopes, parents first.
+    const std::vector<GPUProfileScopeStats>& GetStats() const { return m_Stats; }
+
+    void ResetStats();
+
+    /// Returns the total number of resolved frames.
+    Uint64 GetNumResolvedFrames() const { return m_NumResolvedFrames; }
+
+    /// Returns the total number of frames that were not profiled because
+    /// the results of NumFramesInFlight previous frames were still pending.
+    Uint64 GetNumSkippedFrames() const { return m_NumSkippedFrames; }
+
+    /// Starts accumulating the resolved frames for the trace.
+    void BeginCapture();
+
+    bool IsCapturing() const { return m_IsCapturing; }
+
+    /// Stops the capture and returns the trace in Chrome trace event JSON format.
+
+    /// \remarks    The events are placed on a separate "GPU" process track. If the command queue of the context
+    ///             provides calibrated timestamps (see ICommandQueue::GetTimestampCalibration()), the GPU timestamps
+    ///             are converted to the CPUProfiler time base, so the trace can be merged with the CPU trace
+    ///             into a single timeline. Otherwise, the time is counted from the start of the first captured frame.
+    std::string EndCapture();
+
+    /// Returns true if the events of the current capture are in the CPUProfiler time base.
+    bool IsCaptureCalibrated() const { return m_CalibrationState == CALIBRATION_STATE_CALIBRATED; }
+
+private:
+    RefCntAutoPtr<IQuery> AllocateQuery();
+    void                  ResolveFrames();
+    void                  UpdateCalibration(IDeviceContext* pContext);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const GPUProfilerCreateInfo m_CI;
+
+    struct PendingScope
+    {
+        const char* Name   = nullptr;
+        Uint32      Parent = ~0u;
+        Uint32      Depth  = 0;
+
+        // Indices of the begin and end timestamp queries in the frame query array
+        Uint32 BeginQuery = ~0u;
+        Uint32 EndQuery   = ~0u;
+    };
+
+    struct FrameData
+    {
+        std::vector<PendingScope>          Scopes;
+        std::vector<RefCntAutoPtr<IQuery>> Queries;
+    };
+
+    // Ring of frames whose results are pending
+    std::vector<FrameData> m_Frames;
+
+    Uint32 m_FirstPendingFrame = 0;
+    Uint32 m_NumPendingFrames  = 0;
+
+    // Whether the current frame is being recorded
+    bool m_IsRecording = false;
+    bool m_IsInFrame   = false;
+
+    // Open scopes of the current frame. Scopes of a skipped frame are tracked by the count only.
+    std::vector<Uint32> m_ScopeStack;
+    Uint32              m_SkippedScopeDepth = 0;
+
+    std::vector<RefCntAutoPtr<IQuery>> m_QueryPool;
+
+    std::vector<GPUProfileNode>       m_LastFrame;
+    std::vector<GPUProfileScopeStats> m_Stats;
+    std::vector<double>               m_FrameStatTimes;
+
+    // Index of the parent statistics and the scope name. The name points to the string passed to BeginScope().
+    struct StatsKey
+    {
+        Uint32      Parent = ~0u;
+        const char* Name   = nullptr;
+
+        bool operator==(const StatsKey& rhs) const;
+
+        struct Hasher
+        {
+            size_t operator()(const StatsKey& Key) const;
+        };
+    };
+    std::unordered_map<StatsKey, Uint32, StatsKey::Hasher> m_StatsIndices;
+
+    Uint64 m_NumResolvedFrames = 0;
+    Uint64 m_NumSkippedFrames  = 0;
+
+    struct CapturedEvent
+    {
+        const char* Name      = nullptr;
+        Uint32      Depth     = 0;
+        double      StartTime = 0;
+        double      Duration  = 0;
+    };
+    bool                       m_IsCapturing = false;
+    std::vector<CapturedEvent> m_CapturedEvents;
+
+    enum CALIBRATION_STATE : Uint8
+    {
+        CALIBRATION_STATE_UNKNOWN,
+        CALIBRATION_STATE_CALIBRATED,
+        CALIBRATION_STATE_UNAVAILABLE
+    };
+    CALIBRATION_STATE m_CalibrationState = CALIBRATION_STATE_UNKNOWN;
+
+    // Offset, in seconds, that converts the GPU time to the CPUProfiler time
+    double m_GPUToCPUTimeOffset = 0;
+};
+
+/// RAII GPU profiling scope.
+class GPUProfileScope
+{
+public:
+    GPUProfileScope(GPUProfiler& Profiler, IDeviceContext* pContext, const char* Name, const float* pColor = nullptr) :
+        m_Profiler{Profiler},
+        m_pContext{pContext}
+    {
+        m_Profiler.BeginScope(m_pContext, Name, pColor);
+    }
+
+    ~GPUProfileScope()
+    {
+        m_Profiler.EndScope(m_pContext);
+    }
+
+    // clang-format off
+    GPUProfileScope           (const GPUProfileScope&)  = delete;
+    GPUProfileScope& operator=(const GPUProfileScope&)  = delete;
+    GPUProfileScope           (      GPUProfileScope&&) = delete;
+    GPUProfileScope& operator=(      GPUProfileScope&&) = delete;
+    // clang-format on
+
+private:
+    GPUProfiler&    m_Profiler;
+    IDeviceContext* m_pContext;
+};
+
+} // namespace Diligent
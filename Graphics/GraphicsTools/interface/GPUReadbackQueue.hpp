@@ -0,0 +1,196 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <future>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "GPUCompletionAwaitQueue.hpp"
+
+namespace Diligent
+{
+
+/// Read-back data passed to the GPUReadbackQueue callback.
+struct GPUReadbackData
+{
+    /// Pointer to the mapped staging memory. The data is only valid during the callback.
+    const void* pData = nullptr;
+
+    /// The size of the data, in bytes.
+    Uint64 DataSize = 0;
+
+    /// For textures, the row stride, in bytes.
+    Uint64 Stride = 0;
+
+    /// For 3D textures, the depth slice stride, in bytes.
+    Uint64 DepthStride = 0;
+
+    /// For textures, the dimensions of the read-back region and the texture format.
+    Uint32         Width  = 0;
+    Uint32         Height = 0;
+    Uint32         Depth  = 0;
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+};
+
+/// GPUReadbackQueue callback.
+using GPUReadbackCallbackType = std::function<void(const GPUReadbackData& Data)>;
+
+/// Asynchronously reads back buffer and texture data from the GPU.
+
+/// The queue copies the source data to pooled staging resources, tracks the copies with
+/// GPUCompletionAwaitQueue, and delivers the mapped data to the callback once the GPU has
+/// finished the copy. The application never waits for the GPU and does not manage staging resources.
+///
+/// \remarks    The class is not thread-safe. All methods must be called from the thread that
+///             uses the device context. Callbacks are called by ProcessCompleted() and WaitForCompletion().
+class GPUReadbackQueue
+{
+public:
+    explicit GPUReadbackQueue(IRenderDevice* pDevice);
+    ~GPUReadbackQueue();
+
+    // clang-format off
+    GPUReadbackQueue           (const GPUReadbackQueue&)  = delete;
+    GPUReadbackQueue           (      GPUReadbackQueue&&) = delete;
+    GPUReadbackQueue& operator=(const GPUReadbackQueue&)  = delete;
+    GPUReadbackQueue& operator=(      GPUReadbackQueue&&) = delete;
+    // clang-format on
+
+    /// Enqueues a read back of the buffer region.
+
+    /// \param [in] pContext            - Device context to record the copy command.
+    /// \param [in] pBuffer             - Source buffer.
+    /// \param [in] Offset              - Offset of the region, in bytes.
+    /// \param [in] Size                - Size of the region, in bytes.
+    /// \param [in] Callback            - Callback that receives the data.
+    /// \param [in] StateTransitionMode - State transition mode for the source buffer.
+    void ReadbackBufferAsync(IDeviceContext*                pContext,
+                             IBuffer*                       pBuffer,
+                             Uint64                         Offset,
+                             Uint64                         Size,
+                             GPUReadbackCallbackType        Callback,
+                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    /// Enqueues a read back of the buffer region and returns a future that receives a copy of the data.
+
+    /// \remarks    The future is fulfilled by ProcessCompleted() or WaitForCompletion(),
+    ///             so waiting for it without calling these methods will never return.
+    std::future<std::vector<Uint8>> ReadbackBufferAsync(IDeviceContext*                pContext,
+                                                        IBuffer*                       pBuffer,
+                                                        Uint64                         Offset,
+                                                        Uint64                         Size,
+                                                        RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    /// Enqueues a read back of the texture subresource region.
+
+    /// \param [in] pContext            - Device context to record the copy command.
+    /// \param [in] pTexture            - Source texture.
+    /// \param [in] MipLevel            - Mip level to read.
+    /// \param [in] Slice               - Array slice to read.
+    /// \param [in] pRegion             - Region to read, or null to read the entire subresource.
+    /// \param [in] Callback            - Callback that receives the data.
+    /// \param [in] StateTransitionMode - State transition mode for the source texture.
+    void ReadbackTextureAsync(IDeviceContext*                pContext,
+                              ITexture*                      pTexture,
+                              Uint32                         MipLevel,
+                              Uint32                         Slice,
+                              const Box*                     pRegion,
+                              GPUReadbackCallbackType        Callback,
+                              RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    /// Enqueues a read back of the texture subresource region and returns a future that
+    /// receives the tightly packed data.
+
+    /// \remarks    See remarks for the buffer overload.
+    std::future<std::vector<Uint8>> ReadbackTextureAsync(IDeviceContext*                pContext,
+                                                         ITexture*                      pTexture,
+                                                         Uint32                         MipLevel,
+                                                         Uint32                         Slice,
+                                                         const Box*                     pRegion,
+                                                         RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    /// Delivers the data of all completed read backs to their callbacks.
+
+    /// \param [in] pContext - Device context to map the staging resources.
+    ///                        Must be the context that was used to enqueue the read backs.
+    ///
+    /// \remarks    The method never waits for the GPU and should be called once per frame.
+    void ProcessCompleted(IDeviceContext* pContext);
+
+    /// Flushes the context, waits until the GPU finishes all copies and delivers all data.
+    void WaitForCompletion(IDeviceContext* pContext);
+
+    /// Returns the number of read backs that have not been delivered yet.
+    size_t GetNumPendingReadbacks() const { return m_NumPending; }
+
+    /// Releases the pooled staging resources.
+    void ReleaseStagingResources();
+
+private:
+    struct PendingReadback
+    {
+        RefCntAutoPtr<IBuffer>  pStagingBuffer;
+        RefCntAutoPtr<ITexture> pStagingTexture;
+        Uint64                  DataSize = 0;
+        GPUReadbackCallbackType Callback;
+
+        explicit operator bool() const
+        {
+            return pStagingBuffer || pStagingTexture;
+        }
+    };
+
+    RefCntAutoPtr<IBuffer>  GetStagingBuffer(Uint64 Size);
+    RefCntAutoPtr<ITexture> GetStagingTexture(const TextureDesc& Desc);
+
+    // Maps the staging resource and calls the callback. Returns false if the resource can't be mapped yet.
+    bool Deliver(IDeviceContext* pContext, PendingReadback& Readback);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    GPUCompletionAwaitQueue<PendingReadback> m_AwaitQueue;
+
+    // Read backs whose copies have completed, but that could not be mapped yet
+    // (e.g. WebGPU maps staging buffers asynchronously).
+    std::deque<PendingReadback> m_CompletedReadbacks;
+
+    std::vector<RefCntAutoPtr<IBuffer>>  m_StagingBuffers;
+    std::vector<RefCntAutoPtr<ITexture>> m_StagingTextures;
+
+    size_t m_NumPending = 0;
+};
+
+} // namespace Diligent
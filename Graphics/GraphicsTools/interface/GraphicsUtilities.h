@@ -71,7 +71,18 @@ DILIGENT_TYPED_ENUM(MIP_FILTER_TYPE, Uint8)
     /// Use the most frequent element from the 2x2 box.
     /// This filter does not introduce new values and should be used
     /// for integer textures that contain non-filterable data (e.g. indices).
-    MIP_FILTER_TYPE_MOST_FREQUENT
+    MIP_FILTER_TYPE_MOST_FREQUENT,
+
+    /// Kaiser-windowed sinc filter with the radius of three coarse texels.
+    /// The filter keeps more detail than the box filter with little ringing.
+    /// It is supported for 8- and 16-bit UNORM and SNORM, 8-bit sRGB and 32-bit float formats.
+    /// sRGB textures are filtered in linear space.
+    MIP_FILTER_TYPE_KAISER,
+
+    /// Lanczos filter with three lobes.
+    /// The filter is sharper than the Kaiser filter, but may produce more ringing.
+    /// It is supported for the same formats as the Kaiser filter.
+    MIP_FILTER_TYPE_LANCZOS
 };
 
 
@@ -139,6 +150,61 @@ typedef struct ComputeMipLevelAttribs ComputeMipLevelAttribs;
 void DILIGENT_GLOBAL_FUNCTION(ComputeMipLevel)(const ComputeMipLevelAttribs REF Attribs);
 
 
+/// ComputeMipChain function attributes
+struct ComputeMipChainAttribs
+{
+    /// Texture format.
+    TEXTURE_FORMAT Format      DEFAULT_INITIALIZER(TEX_FORMAT_UNKNOWN);
+
+    /// The width of the most detailed mip level.
+    Uint32 Width               DEFAULT_INITIALIZER(0);
+
+    /// The height of the most detailed mip level.
+    Uint32 Height              DEFAULT_INITIALIZER(0);
+
+    /// The number of mip levels, including the most detailed level.
+    Uint32 MipLevels           DEFAULT_INITIALIZER(0);
+
+    /// An array of MipLevels pointers to the mip level data.
+    /// The first element points to the most detailed level that contains the source data,
+    /// all other levels are computed by the function.
+    void* const* ppMipData     DEFAULT_INITIALIZER(nullptr);
+
+    /// An array of MipLevels mip level strides, in bytes.
+    const size_t* pMipStrides  DEFAULT_INITIALIZER(nullptr);
+
+    /// Filter type.
+    MIP_FILTER_TYPE FilterType DEFAULT_INITIALIZER(MIP_FILTER_TYPE_DEFAULT);
+
+    /// Alpha cutoff value, see ComputeMipLevelAttribs::AlphaCutoff.
+    float AlphaCutoff          DEFAULT_INITIALIZER(0);
+
+    /// Whether to preserve alpha test coverage.
+    ///
+    /// \remarks
+    ///     When AlphaCutoff is not 0 and this flag is set, alpha channel of every mip level is scaled
+    ///     so that the fraction of texels with alpha greater than AlphaCutoff matches the most detailed
+    ///     level, instead of being remapped as described in ComputeMipLevelAttribs::AlphaCutoff.
+    ///     This keeps alpha-tested geometry such as foliage from thinning out in the distance.
+    Bool PreserveAlphaCoverage DEFAULT_INITIALIZER(False);
+
+    /// An optional thread pool to compute every mip level in parallel.
+    ///
+    /// \remarks
+    ///     The levels are computed one after another, and every level is split into tiles
+    ///     of rows that are processed by the thread pool threads and the calling thread.
+    IThreadPool* pThreadPool   DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct ComputeMipChainAttribs ComputeMipChainAttribs;
+
+/// Computes all mip levels of a texture from the most detailed level.
+
+/// Every level is computed from the previous one as described in ComputeMipLevel.
+/// Unlike calling ComputeMipLevel for every level, the function splits every level
+/// into tiles that may be processed in parallel.
+void DILIGENT_GLOBAL_FUNCTION(ComputeMipChain)(const ComputeMipChainAttribs REF Attribs);
+
+
 /// Creates a sparse texture in Metal backend.
 
 /// \param [in]  pDevice   - A pointer to the render device.
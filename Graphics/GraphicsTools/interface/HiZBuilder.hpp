@@ -0,0 +1,179 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::HiZBuilder class
+
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/TextureView.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Hi-Z builder create info.
+struct HiZBuilderCreateInfo
+{
+    /// Prefix of the names of the objects created by the builder: the constant and counter
+    /// buffers, the pipelines and the depth pyramid. If null, "Hi-Z builder" is used.
+    const char* Name = nullptr;
+
+    /// Whether the depth buffer uses reversed depth (1 at the near plane, 0 at the far plane).
+    bool ReverseDepth = false;
+
+    /// Whether to also store the nearest depth of every region in the second channel
+    /// of the pyramid (TEX_FORMAT_RG32_FLOAT). Otherwise, the pyramid only contains
+    /// the farthest depth (TEX_FORMAT_R32_FLOAT).
+    bool StoreNearestDepth = false;
+};
+
+/// Builds the hierarchical depth (Hi-Z) pyramid from a depth buffer.
+
+/// The first channel of every texel of the pyramid contains the farthest depth of the depth buffer region
+/// it covers (the maximum depth, or the minimum depth if HiZBuilderCreateInfo::ReverseDepth is true).
+/// Optionally, the second channel contains the nearest depth.
+///
+/// The size of the most detailed level is the depth buffer size rounded down to a power of two
+/// (at most 4096), so that every texel of a coarser level covers exactly 2x2 texels of the previous level.
+/// A texel of the most detailed level covers all depth buffer texels that overlap its footprint
+/// (up to 3x3 texels), so the pyramid is conservative for any depth buffer size.
+///
+/// On Direct3D12 and Vulkan, the entire pyramid is built by a single compute dispatch: every thread group
+/// reduces a 64x64 tile of the most detailed level to a single texel, writing levels 0 through 6,
+/// and the last group that finishes reduces the results of all groups and writes levels 7 through 12
+/// (see MipGenerator). Other backends use one dispatch per level.
+///
+/// The pyramid can be passed to IndirectDrawGenerator::GenerateAttribs::pHiZBufferSRV.
+/// Shaders can test bounding boxes against the pyramid using the include returned by
+/// GetOcclusionTestShaderSource().
+///
+/// \remarks    The device must support compute shaders.
+///
+/// \note   The class is not thread-safe.
+class HiZBuilder
+{
+public:
+    HiZBuilder(IRenderDevice* pDevice, const HiZBuilderCreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    HiZBuilder           (const HiZBuilder&)  = delete;
+    HiZBuilder& operator=(const HiZBuilder&)  = delete;
+    HiZBuilder           (      HiZBuilder&&) = delete;
+    HiZBuilder& operator=(      HiZBuilder&&) = delete;
+    // clang-format on
+
+    /// Builds the Hi-Z pyramid.
+
+    /// \param[in] pContext  - Device context to record the commands to.
+    /// \param[in] pDepthSRV - Shader resource view of the single-sample depth buffer.
+    ///
+    /// \remarks    The pyramid texture is recreated when the depth buffer size changes.
+    ///             The depth buffer is transitioned to RESOURCE_STATE_SHADER_RESOURCE state,
+    ///             and the pyramid is left in RESOURCE_STATE_SHADER_RESOURCE state.
+    void Build(IDeviceContext* pContext, ITextureView* pDepthSRV);
+
+    /// Returns the shader resource view of all levels of the pyramid, or null if Build() has not been called.
+    ITextureView* GetHiZSRV() const { return m_pHiZSRV; }
+
+    /// Returns the pyramid texture, or null if Build() has not been called.
+    ITexture* GetHiZTexture() const { return m_pHiZTexture; }
+
+    /// Returns true if the pyramid is built by a single dispatch.
+    bool IsSinglePass() const { return m_SinglePass; }
+
+    /// Returns the HLSL include that tests bounding boxes against the Hi-Z pyramid.
+
+    /// The include defines the following functions:
+    ///
+    ///     // Returns the farthest depth of the screen region from the level of the pyramid where the region
+    ///     // covers at most 2x2 texels, or false if the pyramid has no such level.
+    ///     bool GetHiZFarthestDepth(Texture2D<float> HiZ, float2 HiZSize, uint HiZMipCount,
+    ///                              float2 MinUV, float2 MaxUV, out float Depth);
+    ///
+    ///     // Returns true if the box transformed by ViewProj is occluded.
+    ///     bool IsBoxOccludedByHiZ(Texture2D<float> HiZ, float2 HiZSize, uint HiZMipCount,
+    ///                             float3 BoundsMin, float3 BoundsMax, float4x4 ViewProj, bool IsGLNDC);
+    ///
+    /// HiZSize is the size of the most detailed level of the view, and HiZMipCount is the number of levels in the view.
+    /// ViewProj uses the same convention as other Diligent shaders, i.e. the transposed matrix is passed to mul(Pos, ViewProj).
+    /// The pyramid that also stores the nearest depth can be bound to the Texture2D<float> variable as well.
+    ///
+    /// Define HIZ_REVERSE_DEPTH to 1 before the include if the depth is reversed.
+    ///
+    /// The source can be added to the shader source factory, e.g. with CreateMemoryShaderSourceFactory().
+    static const char* GetOcclusionTestShaderSource();
+
+private:
+    void CreatePipelines(const HiZBuilderCreateInfo& CI);
+    bool CreateHiZTexture(Uint32 DepthWidth, Uint32 DepthHeight);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const std::string    m_Name;
+    const TEXTURE_FORMAT m_Format;
+
+    bool m_SinglePass = false;
+
+    struct Pipeline
+    {
+        RefCntAutoPtr<IPipelineState>         pPSO;
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        IShaderResourceVariable*              pDepthVar   = nullptr;
+        IShaderResourceVariable*              pPrevMipVar = nullptr;
+        IShaderResourceVariable*              pOutMipVars[13]{};
+    };
+    // Single-pass: [0]; multi-pass: [0] builds the most detailed level, [1] reduces the previous level
+    Pipeline m_Pipelines[2];
+
+    RefCntAutoPtr<IBuffer> m_pConstantsBuffer;
+    // Level 6 values written by every thread group
+    RefCntAutoPtr<IBuffer> m_pMip6Buffer;
+    // Atomic counter of the finished thread groups
+    RefCntAutoPtr<IBuffer> m_pCounterBuffer;
+
+    RefCntAutoPtr<ITexture>                  m_pHiZTexture;
+    RefCntAutoPtr<ITextureView>              m_pHiZSRV;
+    std::vector<RefCntAutoPtr<ITextureView>> m_MipSRVs;
+    std::vector<RefCntAutoPtr<ITextureView>> m_MipUAVs;
+
+    Uint32 m_DepthWidth  = 0;
+    Uint32 m_DepthHeight = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,213 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::IndirectDrawGenerator class
+
+#include <string>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/TextureView.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "VertexPool.h"
+#include "BufferSuballocator.h"
+
+namespace Diligent
+{
+
+/// Indirect draw generator create info.
+struct IndirectDrawGeneratorCreateInfo
+{
+    /// Prefix of the names of the culling buffers and pipelines, e.g. "<Name> - draw args".
+    /// If null, "Indirect draw generator" is used.
+    const char* Name = nullptr;
+
+    /// The maximum number of instances that can be processed by one Generate() call.
+    Uint32 MaxInstances = 0;
+
+    /// Whether to compile the occlusion culling path that tests instance bounds
+    /// against a hierarchical depth buffer (Hi-Z) passed to Generate().
+    bool EnableOcclusionCulling = false;
+
+    /// Whether the Hi-Z pyramid uses reversed depth (1 at the near plane, 0 at the far plane).
+    /// If false, every Hi-Z texel must hold the maximum depth of the region it covers;
+    /// otherwise it must hold the minimum depth.
+    bool ReverseDepth = false;
+
+    /// Compute shader thread group size.
+    Uint32 ThreadGroupSize = 64;
+};
+
+/// Generates compacted indexed indirect draw commands on the GPU for instances that pass culling.
+
+/// The application uploads a set of geometry ranges (index count, first index and base vertex,
+/// typically taken from IVertexPoolAllocation and IBufferSuballocation objects) and a set of instances,
+/// each referencing a geometry range and providing its world-space bounding box.
+/// Generate() runs a compute pass that tests every instance against the view frustum and, optionally,
+/// the Hi-Z buffer, and appends a DrawIndexedIndirectAttribs-compatible command for every visible instance
+/// to the draw arguments buffer, and increments the draw count in the count buffer.
+/// The buffers can then be passed directly to IDeviceContext::DrawIndexedIndirect(),
+/// see GetDrawIndexedIndirectAttribs().
+///
+/// The FirstInstanceLocation of every generated command is set to the instance index, so that
+/// the shaders can fetch per-instance data.
+///
+/// \remarks    The device must support compute shaders and indirect draws with a counter buffer
+///             (DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER).
+///
+/// \note   The class is not thread-safe.
+class IndirectDrawGenerator
+{
+public:
+    /// Geometry range. The layout matches the structure used by the culling shader.
+    struct DrawRange
+    {
+        /// The number of indices to draw.
+        Uint32 NumIndices = 0;
+
+        /// LOCATION (NOT the byte offset) of the first index in the index buffer.
+        Uint32 FirstIndexLocation = 0;
+
+        /// A constant which is added to each index before accessing the vertex buffer.
+        Uint32 BaseVertex = 0;
+
+        Uint32 Padding = 0;
+    };
+    static_assert(sizeof(DrawRange) == 16, "DrawRange must match the shader structure");
+
+    /// Instance data. The layout matches the structure used by the culling shader.
+    struct Instance
+    {
+        /// World-space bounding box minimum.
+        float3 BoundsMin;
+
+        /// Index of the geometry range in the array passed to SetDrawRanges().
+        Uint32 DrawRangeIndex = 0;
+
+        /// World-space bounding box maximum.
+        float3 BoundsMax;
+
+        Uint32 Padding = 0;
+    };
+    static_assert(sizeof(Instance) == 32, "Instance must match the shader structure");
+
+    /// Makes the geometry range from the vertex pool allocation and the index buffer suballocation.
+
+    /// \param[in] pVertices - Vertex pool allocation that contains the vertices of the geometry.
+    /// \param[in] pIndices  - Index buffer suballocation that contains the indices of the geometry.
+    /// \param[in] IndexSize - Index size in bytes (2 or 4).
+    static DrawRange MakeDrawRange(const IVertexPoolAllocation* pVertices, const IBufferSuballocation* pIndices, Uint32 IndexSize);
+
+    IndirectDrawGenerator(IRenderDevice* pDevice, const IndirectDrawGeneratorCreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    IndirectDrawGenerator           (const IndirectDrawGenerator&)  = delete;
+    IndirectDrawGenerator& operator=(const IndirectDrawGenerator&)  = delete;
+    IndirectDrawGenerator           (      IndirectDrawGenerator&&) = delete;
+    IndirectDrawGenerator& operator=(      IndirectDrawGenerator&&) = delete;
+    // clang-format on
+
+    /// Uploads the geometry ranges to the GPU.
+    void SetDrawRanges(IDeviceContext* pContext, const DrawRange* pRanges, Uint32 NumRanges);
+
+    /// Uploads the instances to the GPU.
+
+    /// \remarks    The number of instances must not exceed IndirectDrawGeneratorCreateInfo::MaxInstances.
+    ///             The buffers only need to be updated when the instances change.
+    void SetInstances(IDeviceContext* pContext, const Instance* pInstances, Uint32 NumInstances);
+
+    /// Generate() attributes.
+    struct GenerateAttribs
+    {
+        /// View-projection matrix used to cull the instances.
+        float4x4 ViewProj = float4x4::Identity();
+
+        /// Whether to cull the instances against the view frustum.
+        bool FrustumCulling = true;
+
+        /// Shader resource view of the Hi-Z pyramid. If null, occlusion culling is not performed.
+        /// Ignored if the generator was created without IndirectDrawGeneratorCreateInfo::EnableOcclusionCulling.
+        ///
+        /// \note   The Hi-Z pyramid must have been built from the depth buffer rendered with the same
+        ///         view-projection matrix, and all mip levels must be accessible through the view.
+        ///         HiZBuilder builds a compatible pyramid.
+        ITextureView* pHiZBufferSRV = nullptr;
+    };
+
+    /// Runs the culling pass and writes the compacted draw commands and the draw count.
+    void Generate(IDeviceContext* pContext, const GenerateAttribs& Attribs);
+
+    /// Returns the buffer that contains the generated draw commands.
+    IBuffer* GetDrawArgsBuffer() const { return m_pDrawArgsBuffer; }
+
+    /// Returns the buffer that contains the number of generated draw commands.
+    IBuffer* GetCountBuffer() const { return m_pCountBuffer; }
+
+    /// Returns the attributes of the DrawIndexedIndirect() command that executes the generated draws.
+    DrawIndexedIndirectAttribs GetDrawIndexedIndirectAttribs(VALUE_TYPE IndexType, DRAW_FLAGS Flags = DRAW_FLAG_NONE) const;
+
+    /// Returns the number of instances set by SetInstances().
+    Uint32 GetNumInstances() const { return m_NumInstances; }
+
+private:
+    struct CullingPipeline
+    {
+        RefCntAutoPtr<IPipelineState>         pPSO;
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        IShaderResourceVariable*              pDrawRangesVar = nullptr;
+        IShaderResourceVariable*              pHiZVar        = nullptr;
+    };
+    void CreatePipeline(const IndirectDrawGeneratorCreateInfo& CI, bool OcclusionCulling, CullingPipeline& Pipeline);
+    void CreateStructuredBuffer(const char* BufferName, Uint32 ElementSize, Uint32 NumElements, RefCntAutoPtr<IBuffer>& pBuffer);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const std::string m_Name;
+    const Uint32      m_MaxInstances;
+    const Uint32      m_ThreadGroupSize;
+
+    // Pipelines without and with occlusion culling
+    CullingPipeline m_Pipelines[2];
+
+    RefCntAutoPtr<IBuffer> m_pConstantsBuffer;
+    RefCntAutoPtr<IBuffer> m_pDrawRangesBuffer;
+    RefCntAutoPtr<IBuffer> m_pInstancesBuffer;
+    RefCntAutoPtr<IBuffer> m_pDrawArgsBuffer;
+    RefCntAutoPtr<IBuffer> m_pCountBuffer;
+
+    Uint32 m_NumDrawRanges = 0;
+    Uint32 m_NumInstances  = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,235 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::InstanceDataPool class
+
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "BufferSuballocator.h"
+
+namespace Diligent
+{
+
+/// Instance data pool create info.
+struct InstanceDataPoolCreateInfo
+{
+    /// Name of the instance data buffer. It also prefixes the names of the scatter pipeline,
+    /// its constant buffer and the delta buffer. If null, "Instance data pool" is used.
+    const char* Name = nullptr;
+
+    /// The size of the data of one instance, in bytes. Must be a multiple of 16.
+    Uint32 InstanceDataSize = 0;
+
+    /// The number of slots the buffer is initially created with.
+    Uint32 InitialCapacity = 1024;
+
+    /// The maximum number of slots, rounded up to a multiple of SlotsPerPage. If zero, the capacity
+    /// is only limited by the maximum buffer size that can be addressed with 32-bit offsets.
+    Uint32 MaxCapacity = 0;
+
+    /// The number of slots that are reserved from the buffer suballocator at once.
+    Uint32 SlotsPerPage = 256;
+
+    /// Instance buffer bind flags.
+
+    /// \remarks    The buffer uses the formatted mode with 16-byte elements, so that the shaders
+    ///             can read the data through a four-component formatted view (e.g. Buffer<float4>),
+    ///             and it can also be bound as a vertex buffer with per-instance attributes.
+    ///             BIND_UNORDERED_ACCESS is required to update the buffer with the compute shader,
+    ///             see ComputeUpdateThreshold.
+    BIND_FLAGS BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+
+    /// The number of non-contiguous dirty slot ranges starting from which the buffer is updated
+    /// with a compute shader rather than with one IDeviceContext::UpdateBuffer() call per range.
+
+    /// \remarks    When the compute shader is used, the dirty slots are packed into a compact delta
+    ///             buffer that is uploaded with a single call and scattered to their slots on the GPU.
+    ///             If zero, or if the device does not support compute shaders, or if BindFlags
+    ///             does not include BIND_UNORDERED_ACCESS, the compute shader is never used.
+    Uint32 ComputeUpdateThreshold = 64;
+
+    /// Compute shader thread group size.
+    Uint32 ThreadGroupSize = 64;
+};
+
+/// Stores per-instance data, such as transforms, in persistent GPU buffer slots.
+
+/// Every instance is assigned a slot that keeps its index for the whole lifetime of the instance,
+/// so the data only needs to be uploaded when it changes. The pool keeps a CPU copy of the data and
+/// tracks the slots that have been modified since the last Commit(), which then uploads only these slots:
+/// - When there are few dirty ranges, every range of adjacent dirty slots is written with IDeviceContext::UpdateBuffer().
+/// - When there are many, the dirty slots are packed into a compact delta buffer that is uploaded at once,
+///   and a compute shader scatters the data to the slots (see InstanceDataPoolCreateInfo::ComputeUpdateThreshold).
+///
+/// Slots are allocated from pages reserved from a buffer suballocator, which expands the buffer and
+/// preserves its contents when more space is needed. Slot indices are element indices in the buffer
+/// in units of InstanceDataPoolCreateInfo::InstanceDataSize, and can be passed to the shaders through
+/// inline constants, as the first instance location of a draw command, or as a per-instance vertex attribute.
+///
+/// \remarks    When the buffer is expanded, the buffer object changes and the resources that reference
+///             it must be updated. Use GetVersion() to detect this.
+///
+/// \note   The class is not thread-safe.
+class InstanceDataPool
+{
+public:
+    /// Slot index.
+    using SlotIndex = Uint32;
+
+    /// Invalid slot index.
+    static constexpr SlotIndex InvalidSlot = ~0u;
+
+    /// The method that was used by Commit() to upload the data.
+    enum UPDATE_MODE : Uint8
+    {
+        /// No slots have changed since the last commit.
+        UPDATE_MODE_NONE,
+
+        /// The dirty slot ranges have been written with IDeviceContext::UpdateBuffer().
+        UPDATE_MODE_CPU,
+
+        /// The dirty slots have been scattered to the buffer by the compute shader.
+        UPDATE_MODE_COMPUTE
+    };
+
+    InstanceDataPool(IRenderDevice* pDevice, const InstanceDataPoolCreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    InstanceDataPool           (const InstanceDataPool&)  = delete;
+    InstanceDataPool& operator=(const InstanceDataPool&)  = delete;
+    InstanceDataPool           (      InstanceDataPool&&) = delete;
+    InstanceDataPool& operator=(      InstanceDataPool&&) = delete;
+    // clang-format on
+
+    ~InstanceDataPool();
+
+    /// Allocates a slot and optionally initializes its data.
+
+    /// \param[in] pData - Instance data of InstanceDataPoolCreateInfo::InstanceDataSize bytes.
+    ///                    If null, the slot data is zero-initialized.
+    ///
+    /// \return     The slot index, or InvalidSlot if the maximum capacity has been reached.
+    SlotIndex Allocate(const void* pData = nullptr);
+
+    /// Releases the slot. The slot may be returned by a subsequent Allocate() call.
+    void Free(SlotIndex Slot);
+
+    /// Sets the slot data and marks the slot as dirty.
+    void SetData(SlotIndex Slot, const void* pData);
+
+    /// Returns a pointer to the CPU copy of the slot data and marks the slot as dirty.
+
+    /// \remarks    The pointer is invalidated by the next Allocate() call.
+    void* GetDataForWrite(SlotIndex Slot);
+
+    /// Returns a pointer to the CPU copy of the slot data.
+    const void* GetData(SlotIndex Slot) const;
+
+    /// Uploads the data of the dirty slots to the GPU.
+
+    /// \param[in] pContext - Device context that records the upload commands.
+    ///
+    /// \return     The method that was used to upload the data.
+    ///
+    /// \remarks    The method also expands the buffer if new slots have been allocated
+    ///             beyond its current size. The buffer is left in the state required by the
+    ///             upload, and should be transitioned by the commands that use it.
+    UPDATE_MODE Commit(IDeviceContext* pContext);
+
+    /// Returns the instance buffer.
+
+    /// \remarks    The buffer may be replaced with a larger one by Commit().
+    IBuffer* GetBuffer() const { return m_pSuballocator->GetBuffer(); }
+
+    /// Returns the buffer version. The version is incremented every time the buffer is expanded.
+    Uint32 GetVersion() const { return m_pSuballocator->GetVersion(); }
+
+    /// Returns the size of the data of one instance, in bytes.
+    Uint32 GetInstanceDataSize() const { return m_InstanceDataSize; }
+
+    /// Returns the number of allocated slots.
+    Uint32 GetSlotCount() const { return m_SlotCount; }
+
+    /// Returns the number of slots that have been modified since the last commit.
+    Uint32 GetNumDirtySlots() const { return static_cast<Uint32>(m_DirtySlots.size()); }
+
+    /// Returns the number of bytes uploaded by the last Commit() call.
+    Uint64 GetLastUploadSize() const { return m_LastUploadSize; }
+
+private:
+    void MarkDirty(SlotIndex Slot);
+    bool AllocatePage();
+    void CreateScatterPipeline();
+    void CommitCPU(IDeviceContext* pContext, IBuffer* pBuffer);
+    bool CommitCompute(IDeviceContext* pContext, IBuffer* pBuffer);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const std::string m_Name;
+    const Uint32      m_InstanceDataSize;
+    const Uint32      m_SlotsPerPage;
+    const Uint32      m_ComputeUpdateThreshold;
+    const Uint32      m_ThreadGroupSize;
+
+    RefCntAutoPtr<IBufferSuballocator>               m_pSuballocator;
+    std::vector<RefCntAutoPtr<IBufferSuballocation>> m_Pages;
+
+    // CPU copy of the buffer contents
+    std::vector<Uint8> m_Data;
+
+    std::vector<SlotIndex> m_FreeSlots;
+    std::vector<bool>      m_AllocatedFlags;
+    std::vector<bool>      m_DirtyFlags;
+    std::vector<SlotIndex> m_DirtySlots;
+
+    Uint32 m_SlotCount      = 0;
+    Uint64 m_LastUploadSize = 0;
+
+    // Compute update resources. The pipeline is null if the compute update is disabled.
+    RefCntAutoPtr<IPipelineState>         m_pScatterPSO;
+    RefCntAutoPtr<IShaderResourceBinding> m_pScatterSRB;
+    IShaderResourceVariable*              m_pInstanceDataVar = nullptr;
+    IShaderResourceVariable*              m_pDeltaVar        = nullptr;
+    RefCntAutoPtr<IBuffer>                m_pConstantsBuffer;
+    RefCntAutoPtr<IBuffer>                m_pDeltaBuffer;
+    RefCntAutoPtr<IBufferView>            m_pInstanceDataUAV;
+    RefCntAutoPtr<IBufferView>            m_pDeltaSRV;
+    std::vector<Uint8>                    m_DeltaData;
+};
+
+} // namespace Diligent
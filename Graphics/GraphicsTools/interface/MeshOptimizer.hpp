@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Index and vertex buffer optimization utilities
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+#include "../../../Common/interface/ThreadPool.h"
+
+namespace Diligent
+{
+
+/// Attributes of the mesh optimization functions.
+struct OptimizeMeshAttribs
+{
+    /// Triangle list indices. The indices are modified in place.
+    void* pIndices = nullptr;
+
+    /// Index type, must be VT_UINT16 or VT_UINT32.
+    VALUE_TYPE IndexType = VT_UINT32;
+
+    /// The number of indices, must be a multiple of 3.
+    Uint32 NumIndices = 0;
+
+    /// The number of vertices.
+    Uint32 NumVertices = 0;
+
+    /// Pointer to the first vertex position (three 32-bit floats).
+    /// Only required by OptimizeOverdraw().
+    const void* pPositions = nullptr;
+
+    /// Stride between the vertex positions, in bytes.
+    Uint32 PositionStride = 3 * sizeof(float);
+
+    /// The size of the simulated post-transform vertex cache.
+    /// The default value suits most desktop and mobile GPUs.
+    Uint32 CacheSize = 16;
+
+    /// The maximum allowed increase of the average cache miss ratio when
+    /// reordering triangles for overdraw, e.g. 1.05 allows the ratio to grow by 5%.
+    float OverdrawThreshold = 1.05f;
+
+    /// Whether front-facing triangles have counter-clockwise winding,
+    /// see RasterizerStateDesc::FrontCounterClockwise.
+    bool FrontCounterClockwise = false;
+
+    /// An optional thread pool to process large meshes in parallel.
+    ///
+    /// Vertex cache and overdraw optimizations split the index buffer into fixed-size
+    /// ranges of triangles that are optimized independently, so the result does not
+    /// depend on whether the thread pool is used.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Reorders the triangles to improve the post-transform vertex cache efficiency.
+///
+/// The function implements the Tipsify algorithm (Sander P., Nehab D., Barczak J.,
+/// "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", 2007).
+///
+/// \return     true if the indices have been reordered, and false if the input is invalid.
+bool OptimizeVertexCache(const OptimizeMeshAttribs& Attribs);
+
+/// Reorders the triangle clusters to reduce overdraw while keeping the vertex cache efficiency.
+///
+/// The index buffer should be optimized with OptimizeVertexCache() first.
+/// The triangles are split into clusters whose average cache miss ratio stays within
+/// OptimizeMeshAttribs::OverdrawThreshold, and the clusters that face outwards are
+/// moved to the beginning, so that they are more likely to occlude the rest of the mesh.
+///
+/// \return     true if the indices have been reordered, and false if the input is invalid.
+bool OptimizeOverdraw(const OptimizeMeshAttribs& Attribs);
+
+/// Reorders the vertices in the order of their first use by the index buffer to improve
+/// vertex fetch locality, and updates the indices.
+///
+/// \param [in]  Attribs      - Mesh attributes.
+/// \param [in]  pVertices    - Optional vertex data that is reordered in place.
+/// \param [in]  VertexStride - Vertex data stride, in bytes.
+/// \param [out] pRemap       - Optional array of Attribs.NumVertices elements that receives
+///                             the new index of every vertex. It can be used to reorder
+///                             other vertex streams with RemapVertices().
+///
+/// \return     true if the vertices have been reordered, and false if the input is invalid.
+///
+/// \remarks    Unreferenced vertices are moved to the end of the vertex buffer.
+///             The index buffer should be optimized for the vertex cache and overdraw first.
+bool OptimizeVertexFetch(const OptimizeMeshAttribs& Attribs,
+                         void*                      pVertices    = nullptr,
+                         Uint32                     VertexStride = 0,
+                         Uint32*                    pRemap       = nullptr);
+
+/// Reorders the vertex data in place using the remap table produced by OptimizeVertexFetch().
+bool RemapVertices(void*         pVertices,
+                   Uint32        VertexStride,
+                   Uint32        NumVertices,
+                   const Uint32* pRemap,
+                   IThreadPool*  pThreadPool = nullptr);
+
+/// Returns the average number of post-transform vertex cache misses per triangle (ACMR)
+/// for the FIFO cache of OptimizeMeshAttribs::CacheSize entries.
+float ComputeVertexCacheMissRatio(const OptimizeMeshAttribs& Attribs);
+
+} // namespace Diligent
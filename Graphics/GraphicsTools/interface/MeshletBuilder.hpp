@@ -0,0 +1,260 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Meshlet generation for mesh shader rendering
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../../Primitives/interface/FlagEnum.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "../../../Common/interface/ThreadPool.h"
+
+namespace Diligent
+{
+
+/// Meshlet description.
+///
+/// The structure layout matches the Meshlet structure of the reference
+/// mesh shaders (see GetMeshletShaderSource()), so the array of meshlets
+/// can be uploaded to a structured buffer as is.
+struct MeshletDesc
+{
+    /// Offset of the first vertex index in MeshletData::VertexIndices.
+    Uint32 VertexOffset = 0;
+
+    /// Offset of the first primitive in MeshletData::PrimitiveIndices.
+    Uint32 PrimitiveOffset = 0;
+
+    /// The number of unique vertices referenced by the meshlet.
+    Uint32 VertexCount = 0;
+
+    /// The number of triangles in the meshlet.
+    Uint32 PrimitiveCount = 0;
+
+    /// Center of the meshlet bounding sphere.
+    float3 Center;
+
+    /// Radius of the meshlet bounding sphere.
+    float Radius = 0;
+
+    /// Apex of the normal cone.
+    float3 ConeApex;
+
+    /// Sine of the normal cone half-angle. The meshlet is back-facing
+    /// for every camera position that satisfies
+    ///
+    ///     dot(normalize(ConeApex - CameraPos), ConeAxis) >= ConeCutoff
+    ///
+    /// If the triangle normals diverge too much for the test to be useful,
+    /// the cutoff is 1 and the axis is zero, so the test always fails.
+    float ConeCutoff = 1;
+
+    /// Normal cone axis.
+    float3 ConeAxis;
+
+    float Padding = 0;
+};
+static_assert(sizeof(MeshletDesc) == 64, "The structure must match the layout of the Meshlet structure in the shader");
+
+/// Attributes of the BuildMeshlets function.
+struct BuildMeshletsAttribs
+{
+    /// Pointer to the first vertex position (three 32-bit floats).
+    const void* pPositions = nullptr;
+
+    /// Stride between the vertex positions, in bytes. This allows using interleaved vertex data
+    /// directly, e.g. the data produced by CreateGeometryPrimitive().
+    Uint32 PositionStride = sizeof(float3);
+
+    /// The number of vertices.
+    Uint32 NumVertices = 0;
+
+    /// Triangle list indices.
+    const void* pIndices = nullptr;
+
+    /// Index type, must be VT_UINT16 or VT_UINT32.
+    VALUE_TYPE IndexType = VT_UINT32;
+
+    /// The number of indices, must be a multiple of 3.
+    Uint32 NumIndices = 0;
+
+    /// The maximum number of vertices in a meshlet, at most 256.
+    Uint32 MaxVertices = 64;
+
+    /// The maximum number of triangles in a meshlet, at most 256.
+    Uint32 MaxPrimitives = 124;
+
+    /// Whether front-facing triangles have counter-clockwise winding,
+    /// see RasterizerStateDesc::FrontCounterClockwise. This defines
+    /// the direction of the normal cone.
+    bool FrontCounterClockwise = false;
+
+    /// An optional thread pool to build the meshlets in parallel.
+    ///
+    /// The triangles are split into fixed-size ranges that are processed
+    /// independently, so the result does not depend on whether the thread pool is used.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Meshlet data produced by BuildMeshlets.
+struct MeshletData
+{
+    /// Meshlet descriptions.
+    std::vector<MeshletDesc> Meshlets;
+
+    /// Vertex indices of all meshlets. The vertices of meshlet M are
+    /// VertexIndices[M.VertexOffset] ... VertexIndices[M.VertexOffset + M.VertexCount - 1].
+    std::vector<Uint32> VertexIndices;
+
+    /// Triangles of all meshlets. Every triangle is packed into one 32-bit value that contains
+    /// three 8-bit indices into the meshlet vertices: i0 | (i1 << 8) | (i2 << 16).
+    std::vector<Uint32> PrimitiveIndices;
+};
+
+/// Partitions the indexed triangle list into meshlets and computes their culling data.
+///
+/// \param [in]  Attribs - Build attributes, see Diligent::BuildMeshletsAttribs.
+/// \param [out] Data    - Meshlet data.
+///
+/// \return     true if the meshlets have been built, and false if the input is invalid.
+///
+/// \remarks    The triangles are assigned to meshlets in the index buffer order, so the
+///             quality of the meshlets depends on the index buffer locality. Index buffers
+///             optimized for the vertex cache produce compact meshlets.
+bool BuildMeshlets(const BuildMeshletsAttribs& Attribs, MeshletData& Data);
+
+/// GPU buffers that contain the meshlet data.
+struct MeshletBuffers
+{
+    /// Structured buffer of Diligent::MeshletDesc.
+    RefCntAutoPtr<IBuffer> pMeshlets;
+
+    /// Structured buffer of the vertex indices (uint).
+    RefCntAutoPtr<IBuffer> pVertexIndices;
+
+    /// Structured buffer of the packed triangles (uint).
+    RefCntAutoPtr<IBuffer> pPrimitiveIndices;
+};
+
+/// Creates immutable structured buffers that contain the meshlet data.
+///
+/// \param [in]  pDevice - Render device.
+/// \param [in]  Data    - Meshlet data produced by BuildMeshlets().
+/// \param [in]  Name    - Optional name used as the prefix of the buffer names.
+/// \param [out] Buffers - Created buffers.
+///
+/// \return     true if the buffers have been created, and false otherwise.
+bool CreateMeshletBuffers(IRenderDevice*     pDevice,
+                          const MeshletData& Data,
+                          const char*        Name,
+                          MeshletBuffers&    Buffers);
+
+/// Meshlet culling flags of the reference shaders.
+enum MESHLET_CULL_FLAGS : Uint32
+{
+    MESHLET_CULL_FLAG_NONE     = 0u,
+    MESHLET_CULL_FLAG_FRUSTUM  = 1u << 0u,
+    MESHLET_CULL_FLAG_BACKFACE = 1u << 1u,
+    MESHLET_CULL_FLAG_ALL      = MESHLET_CULL_FLAG_FRUSTUM | MESHLET_CULL_FLAG_BACKFACE
+};
+DEFINE_FLAG_ENUM_OPERATORS(MESHLET_CULL_FLAGS)
+
+/// Constants of the reference meshlet shaders (cbMeshletConstants constant buffer).
+struct MeshletCullingConstants
+{
+    /// Transposed object-to-clip-space matrix.
+    float4x4 WorldViewProj;
+
+    /// Normalized frustum planes in object space. A point P is inside the plane if
+    /// dot(Plane.xyz, P) + Plane.w >= 0.
+    float4 FrustumPlanes[6];
+
+    /// Camera position in object space.
+    float4 CameraPos;
+
+    /// The total number of meshlets.
+    Uint32 NumMeshlets = 0;
+
+    /// Culling flags, see Diligent::MESHLET_CULL_FLAGS.
+    Uint32 CullFlags = 0;
+
+    Uint32 Padding[2] = {};
+};
+
+/// Initializes the constants of the reference meshlet shaders.
+///
+/// \param [in]  World       - Object-to-world matrix. The matrix must be invertible.
+/// \param [in]  ViewProj    - View-projection matrix.
+/// \param [in]  CameraPos   - Camera position in world space.
+/// \param [in]  NumMeshlets - The number of meshlets.
+/// \param [in]  CullFlags   - Culling flags.
+/// \param [in]  IsGL        - Whether the projection matrix uses OpenGL clip space.
+/// \param [out] Constants   - Shader constants.
+void InitMeshletCullingConstants(const float4x4&          World,
+                                 const float4x4&          ViewProj,
+                                 const float3&            CameraPos,
+                                 Uint32                   NumMeshlets,
+                                 MESHLET_CULL_FLAGS       CullFlags,
+                                 bool                     IsGL,
+                                 MeshletCullingConstants& Constants);
+
+/// Returns the HLSL source of the reference meshlet shaders.
+///
+/// The source contains two entry points:
+/// - MeshletAS - amplification shader that tests every meshlet against the frustum and the normal cone
+///   and launches one mesh shader group per visible meshlet. It must be dispatched with
+///   DrawMeshAttribs::ThreadGroupCountX = (NumMeshlets + MESHLET_AS_GROUP_SIZE - 1) / MESHLET_AS_GROUP_SIZE.
+/// - MeshletMS - mesh shader that outputs the vertices and triangles of the meshlet.
+///
+/// The shaders use the following resources:
+/// - cbMeshletConstants - Diligent::MeshletCullingConstants.
+/// - g_Meshlets, g_VertexIndices, g_PrimitiveIndices - buffers created by CreateMeshletBuffers().
+/// - g_VertexData - raw buffer (BUFFER_MODE_RAW) that contains the vertex data. The position
+///   is loaded from the beginning of every vertex, and the vertex stride is defined by
+///   the MESHLET_VERTEX_STRIDE macro (12 by default).
+///
+/// The following macros can be defined to configure the shaders:
+/// - MESHLET_AS_GROUP_SIZE  - amplification shader group size (32 by default).
+/// - MESHLET_MS_GROUP_SIZE  - mesh shader group size (64 by default).
+/// - MESHLET_MAX_VERTICES   - must not be less than BuildMeshletsAttribs::MaxVertices (64 by default).
+/// - MESHLET_MAX_PRIMITIVES - must not be less than BuildMeshletsAttribs::MaxPrimitives (124 by default).
+/// - MESHLET_CUSTOM_VERTEX  - if defined, the mesh shader includes "MeshletCustomVertex.fxh" that must
+///                            define the MeshletVertexOut structure and the
+///                            MeshletVertexOut GetMeshletVertex(uint VertexIndex, uint MeshletIndex) function.
+///                            Otherwise, the mesh shader outputs the clip-space position (SV_Position) and
+///                            the meshlet index (MESHLET_INDEX) that can be used for visualization.
+///
+/// The shaders must be compiled with DXC.
+const char* GetMeshletShaderSource();
+
+} // namespace Diligent
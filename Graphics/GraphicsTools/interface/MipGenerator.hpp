@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::MipGenerator class
+
+#include <string>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Mip generator create info.
+struct MipGeneratorCreateInfo
+{
+    /// Name of the mip generation pipeline, also used as the prefix of its buffer and texture names.
+    /// If null, "Mip generator" is used.
+    const char* Name = nullptr;
+};
+
+/// Generates the mip chains of 2D textures with a single-pass compute downsampler.
+
+/// Every texture is processed by one dispatch: every thread group reduces a 64x64 tile of the
+/// most detailed mip level to a single texel, writing mip levels 1 through 6 from the group-shared memory.
+/// The last group that finishes (determined by an atomic counter) reduces the results of all groups
+/// and writes mip levels 7 through 12. Compared to IDeviceContext::GenerateMips(), which processes
+/// one or two levels at a time with a barrier after every step, this removes all intermediate barriers.
+///
+/// GenerateMips() takes a batch of textures: it issues a single barrier for all textures before the dispatches
+/// and a single barrier after them. Since every texture uses its own region of the internal buffers,
+/// the dispatches do not depend on each other and may overlap on the GPU.
+///
+/// The single-pass path is used for textures that satisfy all of the following requirements:
+/// - The device is Direct3D12 or Vulkan and supports compute shaders.
+/// - The texture is 2D, 2D array, cube or cube array texture with at most 13 mip levels, i.e.
+///   its dimensions do not exceed 4096.
+/// - The texture is created with BIND_SHADER_RESOURCE and BIND_UNORDERED_ACCESS flags.
+/// - The texture format is a non-sRGB UNORM, SNORM or FLOAT color format.
+/// - The texture state is known.
+///
+/// All other textures are processed by IDeviceContext::GenerateMips() and must be created with the
+/// MISC_TEXTURE_FLAG_GENERATE_MIPS flag.
+///
+/// \note   Like IDeviceContext::GenerateMips(), the generator uses a 2x2 box filter.
+///         When the dimension of a level is odd, the last texel is repeated.
+///         On Vulkan, the device must support storage image writes without format
+///         (shaderStorageImageWriteWithoutFormat).
+///
+/// \note   The class is not thread-safe.
+class MipGenerator
+{
+public:
+    MipGenerator(IRenderDevice* pDevice, const MipGeneratorCreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    MipGenerator           (const MipGenerator&)  = delete;
+    MipGenerator& operator=(const MipGenerator&)  = delete;
+    MipGenerator           (      MipGenerator&&) = delete;
+    MipGenerator& operator=(      MipGenerator&&) = delete;
+    // clang-format on
+
+    /// Returns true if the texture is processed by the single-pass downsampler.
+    bool IsSinglePassSupported(const ITexture* pTexture) const;
+
+    /// Generates the mip chains of all textures in the batch.
+
+    /// \param[in] pContext    - Device context to record the commands to.
+    /// \param[in] ppTextures  - Array of NumTextures textures.
+    /// \param[in] NumTextures - The number of textures.
+    ///
+    /// \remarks    Mip level 0 of every array slice is used as the source.
+    ///             All textures are left in RESOURCE_STATE_SHADER_RESOURCE state.
+    void GenerateMips(IDeviceContext* pContext, ITexture* const* ppTextures, Uint32 NumTextures);
+
+    /// Generates the mip chain of a single texture.
+    void GenerateMips(IDeviceContext* pContext, ITexture* pTexture)
+    {
+        GenerateMips(pContext, &pTexture, 1);
+    }
+
+private:
+    void CreatePipeline();
+    void ReserveBuffers(Uint32 NumMip6Texels, Uint32 NumCounters);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const std::string m_Name;
+
+    RefCntAutoPtr<IPipelineState>         m_pPSO;
+    RefCntAutoPtr<IShaderResourceBinding> m_pSRB;
+    IShaderResourceVariable*              m_pSourceVar = nullptr;
+    IShaderResourceVariable*              m_pOutMipVars[12]{};
+
+    RefCntAutoPtr<IBuffer> m_pConstantsBuffer;
+    // Mip level 6 values written by every thread group
+    RefCntAutoPtr<IBuffer> m_pMip6Buffer;
+    // Atomic counters of the finished thread groups of every array slice
+    RefCntAutoPtr<IBuffer> m_pCountersBuffer;
+};
+
+} // namespace Diligent
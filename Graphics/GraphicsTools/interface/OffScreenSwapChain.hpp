@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/SwapChain.h"
 
@@ -34,4 +36,42 @@ namespace Diligent
 
 void CreateOffScreenSwapChain(IRenderDevice* pDevice, IDeviceContext* pContext, const SwapChainDesc& SCDesc, ISwapChain** ppSwapChain);
 
+
+/// Frame that is handed to the application by an exportable off-screen swap chain, see CreateExportableOffScreenSwapChain().
+struct OffScreenSwapChainFrame
+{
+    /// Back buffer that has been presented.
+    /// The texture is created with MISC_TEXTURE_FLAG_EXPORTABLE flag, so its memory can be shared with
+    /// another API or process (e.g. a video encoder) using ITextureVk::ExportMemoryHandle() in Vulkan or
+    /// ID3D12Device::CreateSharedHandle() in Direct3D12. The texture is transitioned to RESOURCE_STATE_COMMON.
+    ITexture* pBackBuffer = nullptr;
+
+    /// Index of the back buffer. Back buffers are reused in round-robin order, so the application
+    /// may import every back buffer once and cache the imported object by its index.
+    Uint32 BackBufferIndex = 0;
+
+    /// Exportable fence (see FENCE_FLAG_EXPORTABLE) that is shared by all frames.
+    IFence* pFence = nullptr;
+
+    /// Value the fence is signaled with when rendering to the back buffer is complete.
+    Uint64 FenceValue = 0;
+};
+
+/// Callback that is called by IDeviceContext::Present() of an exportable off-screen swap chain.
+using OffScreenSwapChainPresentCallbackType = std::function<void(const OffScreenSwapChainFrame& Frame)>;
+
+/// Creates an off-screen swap chain whose back buffers can be exported without copying.
+
+/// The swap chain creates SCDesc.BufferCount exportable back buffers and an exportable fence.
+/// Every Present() signals the fence, flushes the context and passes the back buffer and the fence value
+/// to PresentCallback. The consumer must wait for the fence value on the GPU before reading the back buffer,
+/// and must be done with the back buffer before it is reused, i.e. after SCDesc.BufferCount more presents.
+///
+/// \remarks Exportable textures and fences are only supported in Direct3D12 and Vulkan.
+void CreateExportableOffScreenSwapChain(IRenderDevice*                        pDevice,
+                                        IDeviceContext*                       pContext,
+                                        const SwapChainDesc&                  SCDesc,
+                                        OffScreenSwapChainPresentCallbackType PresentCallback,
+                                        ISwapChain**                          ppSwapChain);
+
 } // namespace Diligent
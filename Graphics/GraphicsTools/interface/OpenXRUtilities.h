@@ -121,6 +121,49 @@ void DILIGENT_GLOBAL_FUNCTION(GetOpenXRSwapchainImage)(IRenderDevice*
                                                        const Diligent::TextureDesc REF   TexDesc,
                                                        ITexture**                        ppImage);
 
+/// Returns the texture objects for all images of the OpenXR swapchain.
+///
+/// \param [in]  pDevice    - Pointer to the render device.
+/// \param [in]  ImageData  - Pointer to the OpenXR swapchain image data returned by xrEnumerateSwapchainImages.
+/// \param [in]  ImageCount - Number of images in the swapchain.
+/// \param [in]  TexDesc    - Texture description, see GetOpenXRSwapchainImage.
+/// \param [out] ppImages   - Pointer to the array of ImageCount elements where the pointers to
+///                           the texture objects will be written.
+///
+/// \remarks    OpenXR swapchain images are owned by the runtime and do not change during the lifetime
+///             of the swapchain, so an application should wrap them once after the swapchain is created
+///             and keep the textures (as well as their views) until the swapchain is destroyed.
+///             The index returned by xrAcquireSwapchainImage then selects the texture to render to,
+///             and no objects need to be created every frame.
+///
+///             If any image could not be obtained, all elements of ppImages are set to null.
+void DILIGENT_GLOBAL_FUNCTION(GetOpenXRSwapchainImages)(IRenderDevice*                    pDevice,
+                                                        const XrSwapchainImageBaseHeader* ImageData,
+                                                        Uint32                            ImageCount,
+                                                        const Diligent::TextureDesc REF   TexDesc,
+                                                        ITexture**                        ppImages);
+
+/// Creates a render target or depth-stencil view of the OpenXR swapchain image array slices
+/// that can be used as a multiview render pass attachment.
+///
+/// \param [in]  pImage          - Swapchain image created by GetOpenXRSwapchainImage or GetOpenXRSwapchainImages.
+/// \param [in]  FirstArraySlice - The first array slice of the view.
+/// \param [in]  NumArraySlices  - The number of array slices of the view, typically the number of views.
+/// \param [out] ppView          - Address of the memory location where the pointer to the view will be stored.
+///
+/// \remarks    To render all views in a single pass, create the swapchain with XrSwapchainCreateInfo::arraySize
+///             equal to the number of views, create a render pass whose subpasses set SubpassDesc::ViewMask
+///             to (1 << NumViews) - 1, and use the views created by this function as framebuffer attachments.
+///             View N then renders to array slice N, which should be set as the imageArrayIndex of
+///             the corresponding XrCompositionLayerProjectionView::subImage.
+///
+///             The view type is TEXTURE_VIEW_DEPTH_STENCIL for depth-stencil formats, and
+///             TEXTURE_VIEW_RENDER_TARGET otherwise.
+void DILIGENT_GLOBAL_FUNCTION(CreateOpenXRSwapchainImageView)(ITexture*      pImage,
+                                                              Uint32         FirstArraySlice,
+                                                              Uint32         NumArraySlices,
+                                                              ITextureView** ppView);
+
 #include "../../../Primitives/interface/UndefRefMacro.h"
 
 DILIGENT_END_NAMESPACE // namespace Diligent
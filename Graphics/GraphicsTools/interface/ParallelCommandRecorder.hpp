@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::ParallelCommandRecorder class
+
+#include <functional>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/CommandList.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.h"
+
+namespace Diligent
+{
+
+/// Parallel command recorder create info.
+struct ParallelCommandRecorderCreateInfo
+{
+    /// Deferred contexts used to record the commands.
+    /// If NumDeferredContexts is zero, all commands are recorded directly into the immediate context.
+    IDeviceContext* const* ppDeferredContexts = nullptr;
+
+    /// The number of deferred contexts in the ppDeferredContexts array.
+    Uint32 NumDeferredContexts = 0;
+
+    /// An optional thread pool that runs the recording jobs.
+    /// If null, all jobs are recorded sequentially by the thread that calls Record().
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Records commands in parallel using a pool of deferred contexts and submits
+/// the command lists to the immediate context in a deterministic order.
+
+/// Record() splits a range of work items into contiguous ranges, one per job.
+/// Every job is recorded by its own deferred context: one job is recorded by the calling
+/// thread, the others are run by the thread pool. When all jobs are complete, the command
+/// lists are executed by the immediate context in the order of the ranges, so that the result
+/// does not depend on the number of threads or their scheduling.
+///
+/// The deferred contexts start every job with the default state: the record callback must
+/// set the render targets, viewports, pipeline states etc. it needs.
+///
+/// Typical usage:
+///
+///     Recorder.Record(pImmediateCtx, NumObjects,
+///                     [&](IDeviceContext* pCtx, Uint32 JobIndex, Uint32 FirstItem, Uint32 NumItems) {
+///                         pCtx->SetRenderTargets(...);
+///                         for (Uint32 i = FirstItem; i < FirstItem + NumItems; ++i)
+///                             DrawObject(pCtx, i);
+///                     });
+///     ...
+///     pSwapChain->Present();
+///     Recorder.FinishFrame();
+///
+/// \remarks    FinishFrame() must be called once per frame after all Record() calls.
+///             It calls IDeviceContext::FinishFrame() for every deferred context that recorded
+///             commands since the previous call.
+///
+/// \note   The class is not thread-safe: Record() and FinishFrame() must be called from the same thread.
+///         In Metal backend, deferred context FinishFrame() must be called by the thread that recorded
+///         the commands, so the recorder must be created without a thread pool.
+class ParallelCommandRecorder
+{
+public:
+    /// Record callback.
+
+    /// \param[in] pContext  - Context to record the commands into.
+    /// \param[in] JobIndex  - Index of the job.
+    /// \param[in] FirstItem - Index of the first work item of the job.
+    /// \param[in] NumItems  - The number of work items in the job.
+    using RecordCallbackType = std::function<void(IDeviceContext* pContext, Uint32 JobIndex, Uint32 FirstItem, Uint32 NumItems)>;
+
+    explicit ParallelCommandRecorder(const ParallelCommandRecorderCreateInfo& CI);
+    ~ParallelCommandRecorder();
+
+    // clang-format off
+    ParallelCommandRecorder           (const ParallelCommandRecorder&)  = delete;
+    ParallelCommandRecorder& operator=(const ParallelCommandRecorder&)  = delete;
+    ParallelCommandRecorder           (      ParallelCommandRecorder&&) = delete;
+    ParallelCommandRecorder& operator=(      ParallelCommandRecorder&&) = delete;
+    // clang-format on
+
+    /// Records the work items in parallel and executes the command lists.
+
+    /// \param[in] pImmediateCtx  - Immediate context that executes the command lists.
+    /// \param[in] NumItems       - The number of work items.
+    /// \param[in] Callback       - Callback that records a range of work items.
+    /// \param[in] MinItemsPerJob - The minimum number of work items in a job. This value prevents
+    ///                             splitting small amounts of work into many jobs.
+    ///
+    /// \remarks    The number of jobs does not exceed the number of deferred contexts.
+    ///             If there are no deferred contexts, the callback is called once with the immediate context.
+    void Record(IDeviceContext*           pImmediateCtx,
+                Uint32                    NumItems,
+                const RecordCallbackType& Callback,
+                Uint32                    MinItemsPerJob = 1);
+
+    /// Finishes the frame for every deferred context that recorded commands since the previous call.
+    void FinishFrame();
+
+    /// Returns the number of deferred contexts in the pool.
+    Uint32 GetNumDeferredContexts() const { return static_cast<Uint32>(m_Contexts.size()); }
+
+    /// Returns the number of jobs the last Record() call was split into.
+    Uint32 GetLastJobCount() const { return m_LastJobCount; }
+
+private:
+    void RecordJob(Uint32 JobIndex, Uint32 ImmediateCtxId, Uint32 FirstItem, Uint32 NumItems, const RecordCallbackType& Callback);
+
+private:
+    struct ContextInfo
+    {
+        RefCntAutoPtr<IDeviceContext> pContext;
+        RefCntAutoPtr<ICommandList>   pCommandList;
+
+        // Whether the context recorded commands since the last FinishFrame()
+        bool NeedsFinishFrame = false;
+    };
+    std::vector<ContextInfo> m_Contexts;
+
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> m_Tasks;
+    std::vector<ICommandList*>             m_CommandLists;
+
+    Uint32 m_LastJobCount = 0;
+};
+
+} // namespace Diligent
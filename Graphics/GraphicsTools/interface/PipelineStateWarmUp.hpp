@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::PipelineStateWarmUp class
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/Dearchiver.h"
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.h"
+
+namespace Diligent
+{
+
+/// Pipeline state warm-up create info.
+struct PipelineStateWarmUpCreateInfo
+{
+    /// Render device to create the pipeline states with.
+    IRenderDevice* pDevice = nullptr;
+
+    /// Dearchiver to unpack the pipeline states from.
+    IDearchiver* pDearchiver = nullptr;
+
+    /// An optional thread pool that unpacks the pipeline states.
+    /// If null, the device's shader compilation thread pool is used (see IRenderDevice::GetShaderCompilationThreadPool).
+    /// If the device does not have a thread pool either, all pipelines are unpacked by the thread
+    /// that creates the object.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// Pipeline states to unpack, see Diligent::PipelineStateUnpackInfo.
+    /// The pDevice member of every unpack info is ignored and pDevice above is used instead.
+    /// The names are copied, so the array does not need to be kept alive.
+    const PipelineStateUnpackInfo* pUnpackInfos = nullptr;
+
+    /// The number of elements in pUnpackInfos array.
+    Uint32 NumPipelineStates = 0;
+};
+
+/// Unpacks a batch of pipeline states from the dearchiver in parallel.
+
+/// Loading screens typically need to create hundreds of pipeline states. Unpacking them one at a time
+/// leaves all but one core idle. This class enqueues one task per pipeline state into the thread pool and
+/// allows polling the progress:
+///
+///     PipelineStateWarmUp WarmUp{WarmUpCI};
+///     while (!WarmUp.IsComplete())
+///     {
+///         DrawLoadingScreen(WarmUp.GetProgress());
+///     }
+///     IPipelineState* pPSO = WarmUp.GetPipelineState(0);
+///
+/// Resource signatures, render passes and shaders shared by multiple pipelines are unpacked once:
+/// the dearchiver keeps them in its caches, and if two tasks unpack the same object at the same time,
+/// both pipelines use the instance that was cached first.
+///
+/// \note   ModifyPipelineStateCreateInfo callbacks are called from the thread pool threads
+///         and must be thread-safe.
+///
+///         The destructor waits for all tasks to complete.
+class PipelineStateWarmUp
+{
+public:
+    explicit PipelineStateWarmUp(const PipelineStateWarmUpCreateInfo& CI);
+    ~PipelineStateWarmUp();
+
+    // clang-format off
+    PipelineStateWarmUp           (const PipelineStateWarmUp&)  = delete;
+    PipelineStateWarmUp& operator=(const PipelineStateWarmUp&)  = delete;
+    PipelineStateWarmUp           (      PipelineStateWarmUp&&) = delete;
+    PipelineStateWarmUp& operator=(      PipelineStateWarmUp&&) = delete;
+    // clang-format on
+
+    /// Returns the number of pipeline states in the batch.
+    Uint32 GetNumPipelineStates() const { return static_cast<Uint32>(m_Items.size()); }
+
+    /// Returns the number of pipeline states that have been processed, including the failed ones.
+    Uint32 GetNumCompleted() const { return m_NumCompleted.load(); }
+
+    /// Returns the number of pipeline states that failed to unpack.
+    Uint32 GetNumFailed() const { return m_NumFailed.load(); }
+
+    /// Returns the progress in [0, 1] range.
+    float GetProgress() const;
+
+    /// Returns true if all pipeline states have been processed.
+    bool IsComplete() const { return GetNumCompleted() == GetNumPipelineStates(); }
+
+    /// Waits until all pipeline states are processed.
+    void WaitForCompletion();
+
+    /// Returns the pipeline state with the given index in the pUnpackInfos array.
+
+    /// \return     A pointer to the pipeline state, or null if the pipeline is not unpacked yet
+    ///             or failed to unpack.
+    IPipelineState* GetPipelineState(Uint32 Index) const;
+
+private:
+    void UnpackPipelineState(Uint32 Index);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IDearchiver>   m_pDearchiver;
+
+    struct ItemInfo
+    {
+        PipelineStateUnpackInfo UnpackInfo;
+        std::string             Name;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        RefCntAutoPtr<IAsyncTask>     pTask;
+
+        // Set when the item is processed
+        std::atomic<bool> IsComplete{false};
+    };
+    std::vector<ItemInfo> m_Items;
+
+    std::atomic<Uint32> m_NumCompleted{0};
+    std::atomic<Uint32> m_NumFailed{0};
+};
+
+} // namespace Diligent
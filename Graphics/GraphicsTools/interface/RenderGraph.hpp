@@ -0,0 +1,494 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::RenderGraph class
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/RenderPass.h"
+#include "../../GraphicsEngine/interface/Framebuffer.h"
+#include "../../GraphicsEngine/interface/GraphicsTypesX.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Handle of a resource managed by a render graph.
+struct RenderGraphResource
+{
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    /// Index of the resource in the render graph.
+    Uint32 Index = InvalidIndex;
+
+    constexpr bool IsValid() const { return Index != InvalidIndex; }
+
+    constexpr bool operator==(const RenderGraphResource& RHS) const { return Index == RHS.Index; }
+    constexpr bool operator!=(const RenderGraphResource& RHS) const { return Index != RHS.Index; }
+};
+
+class RenderGraph;
+
+/// Declares resources used by a render graph pass.
+
+/// An instance of this class is passed to the setup callback of every pass
+/// added with RenderGraph::AddPass().
+class RenderGraphBuilder
+{
+public:
+    /// Declares a transient texture.
+
+    /// \remarks    The device object is created or taken from the pool of the render graph when the graph
+    ///             is compiled, and is only valid between the first and the last pass that uses it.
+    ///             Its contents are undefined before the first write.
+    ///             Bind flags required by the declared accesses are added to Desc.BindFlags automatically.
+    RenderGraphResource CreateTexture(const TextureDesc& Desc);
+
+    /// Declares a transient buffer, see CreateTexture().
+    RenderGraphResource CreateBuffer(const BufferDesc& Desc);
+
+    /// Declares that the pass reads the resource in the given state.
+    void Read(RenderGraphResource Res, RESOURCE_STATE State);
+
+    /// Declares that the pass writes the resource in the given state.
+    void Write(RenderGraphResource Res, RESOURCE_STATE State);
+
+    /// Marks the pass as having side effects that are not expressed through its writes
+    /// (e.g. reading back data), so that the pass is never culled.
+    void SetSideEffects();
+
+    /// Declares that the pass renders to the texture bound to the given render target slot.
+
+    /// \param[in] Slot       - Render target slot.
+    /// \param[in] Res        - Texture resource.
+    /// \param[in] LoadOp     - Operation that is performed on the texture contents before the pass.
+    /// \param[in] ClearValue - Clear value used when LoadOp is ATTACHMENT_LOAD_OP_CLEAR.
+    ///
+    /// \remarks    The graph binds the render targets and the depth-stencil buffer of the pass
+    ///             before the execute callback is called, and the callback must not change them.
+    ///             See also RenderGraphContext::GetRenderPass().
+    void SetRenderTarget(Uint32                     Slot,
+                         RenderGraphResource        Res,
+                         ATTACHMENT_LOAD_OP         LoadOp     = ATTACHMENT_LOAD_OP_LOAD,
+                         const OptimizedClearValue& ClearValue = {});
+
+    /// Declares that the pass renders to the texture as the depth-stencil buffer, see SetRenderTarget().
+
+    /// \param[in] ReadOnly - Whether the depth-stencil buffer is only read by the pass.
+    void SetDepthStencil(RenderGraphResource        Res,
+                         ATTACHMENT_LOAD_OP         LoadOp     = ATTACHMENT_LOAD_OP_LOAD,
+                         const OptimizedClearValue& ClearValue = {},
+                         bool                       ReadOnly   = false);
+
+    /// Declares that the pass reads the texture only at the location of the pixel being shaded.
+
+    /// When subpass merging is enabled and the texture is rendered to by a previous pass that is merged
+    /// with this one, the texture is read as an input attachment (RESOURCE_STATE_INPUT_ATTACHMENT),
+    /// and the data may stay in the tile memory. Otherwise it is read as a shader resource.
+    /// Use RenderGraphContext::IsInputAttachment() to check which access is used.
+    ///
+    /// \remarks    The texture must not be declared with any other access in the same pass.
+    void ReadInputAttachment(RenderGraphResource Res);
+
+private:
+    friend RenderGraph;
+    RenderGraphBuilder(RenderGraph& Graph, Uint32 PassIndex) noexcept :
+        m_Graph{Graph},
+        m_PassIndex{PassIndex}
+    {}
+
+    RenderGraph& m_Graph;
+    const Uint32 m_PassIndex;
+};
+
+/// Provides access to the device objects of render graph resources when a pass is executed.
+class RenderGraphContext
+{
+public:
+    /// Returns the device context that executes the pass.
+    IDeviceContext* GetDeviceContext() const { return m_pContext; }
+
+    /// Returns the texture object of the resource. The resource must be declared by the pass.
+    ITexture* GetTexture(RenderGraphResource Res) const;
+
+    /// Returns the buffer object of the resource. The resource must be declared by the pass.
+    IBuffer* GetBuffer(RenderGraphResource Res) const;
+
+    /// Returns the render pass that the pass is executed in as a subpass, or null if the
+    /// render targets of the pass are bound with SetRenderTargets.
+
+    /// Pipelines that are used by a pass executed in a render pass must be created for this
+    /// render pass and subpass (GraphicsPipelineDesc::pRenderPass and GraphicsPipelineDesc::SubpassIndex).
+    /// Render passes are cached by the graph, so the same object is returned while the merged passes
+    /// do not change.
+    IRenderPass* GetRenderPass() const { return m_pRenderPass; }
+
+    /// Returns the index of the subpass, see GetRenderPass().
+    Uint32 GetSubpassIndex() const { return m_SubpassIndex; }
+
+    /// Returns true if the resource declared with RenderGraphBuilder::ReadInputAttachment()
+    /// is read as an input attachment, and false if it is read as a shader resource.
+    bool IsInputAttachment(RenderGraphResource Res) const;
+
+private:
+    friend RenderGraph;
+    RenderGraphContext(const RenderGraph& Graph, IDeviceContext* pContext, IRenderPass* pRenderPass, Uint32 SubpassIndex) noexcept :
+        m_Graph{Graph},
+        m_pContext{pContext},
+        m_pRenderPass{pRenderPass},
+        m_SubpassIndex{SubpassIndex}
+    {}
+
+    const RenderGraph&    m_Graph;
+    IDeviceContext* const m_pContext;
+    IRenderPass* const    m_pRenderPass;
+    const Uint32          m_SubpassIndex;
+};
+
+/// Render graph.
+
+/// The render graph records passes together with the resources they read and write, and then
+///  - culls the passes whose results are not used by any output,
+///  - assigns device objects to transient resources reusing objects whose lifetimes do not overlap,
+///  - computes the state transitions and issues them with one TransitionResourceStates() call per pass.
+///
+/// When split barriers are enabled and a state transition is separated from the previous access to
+/// the resource by at least one other pass, the graph begins the transition right after the previous
+/// access (STATE_TRANSITION_TYPE_BEGIN) and ends it right before the next one (STATE_TRANSITION_TYPE_END),
+/// so that the driver can overlap the transition (e.g. render target decompression) with the passes in between.
+/// Split barriers only have effect in Direct3D12 backend and are not used on other devices.
+///
+/// Passes that declare render targets and depth-stencil buffers (RenderGraphBuilder::SetRenderTarget(),
+/// RenderGraphBuilder::SetDepthStencil()) are rasterization passes, and the graph binds their attachments.
+/// When subpass merging is enabled, consecutive rasterization passes whose attachments have the same size,
+/// and that only read the attachments of the previous passes at the current pixel (RenderGraphBuilder::ReadInputAttachment()),
+/// are merged into one render pass with a subpass per pass. Attachments whose contents are not used after the render
+/// pass are not stored, so on tile-based GPUs, intermediate results such as the G-buffer stay in the tile memory.
+///
+/// Resources that are not created by the graph must be imported with ImportTexture() or ImportBuffer().
+/// Passes that write imported resources, or have side effects, are never culled.
+/// Passes are executed in the order they were added.
+///
+/// Typical usage:
+///
+///     Graph.Reset();
+///     auto BackBuffer = Graph.ImportTexture(pBackBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_PRESENT);
+///     RenderGraphResource GBuffer;
+///     Graph.AddPass("GBuffer",
+///                   [&](RenderGraphBuilder& Builder) {
+///                       GBuffer = Builder.CreateTexture(GBufferDesc);
+///                       Builder.Write(GBuffer, RESOURCE_STATE_RENDER_TARGET);
+///                   },
+///                   [&](const RenderGraphContext& Ctx) { ... });
+///     Graph.AddPass("Lighting", ...);
+///     Graph.Execute(pContext);
+///
+/// \note   The class is not thread-safe.
+class RenderGraph
+{
+public:
+    using SetupCallbackType   = std::function<void(RenderGraphBuilder& Builder)>;
+    using ExecuteCallbackType = std::function<void(const RenderGraphContext& Context)>;
+
+    /// \param[in] pDevice              - Render device.
+    /// \param[in] EnableSplitBarriers  - Whether to use split barriers when the device supports them.
+    /// \param[in] EnableSubpassMerging - Whether to merge rasterization passes into render passes with subpasses.
+    explicit RenderGraph(IRenderDevice* pDevice, bool EnableSplitBarriers = true, bool EnableSubpassMerging = false);
+    ~RenderGraph();
+
+    // clang-format off
+    RenderGraph           (const RenderGraph&)  = delete;
+    RenderGraph& operator=(const RenderGraph&)  = delete;
+    RenderGraph           (      RenderGraph&&) = delete;
+    RenderGraph& operator=(      RenderGraph&&) = delete;
+    // clang-format on
+
+    /// Imports an external texture into the graph.
+
+    /// \param[in] pTexture     - Texture to import.
+    /// \param[in] InitialState - State of the texture when the graph starts executing.
+    ///                           If RESOURCE_STATE_UNKNOWN, the state tracked by the engine is used.
+    /// \param[in] FinalState   - State the texture is transitioned to after the graph is executed.
+    ///                           If RESOURCE_STATE_UNKNOWN, the texture is left in the state of its last use.
+    RenderGraphResource ImportTexture(ITexture*      pTexture,
+                                      RESOURCE_STATE InitialState = RESOURCE_STATE_UNKNOWN,
+                                      RESOURCE_STATE FinalState   = RESOURCE_STATE_UNKNOWN);
+
+    /// Imports an external buffer into the graph, see ImportTexture().
+    RenderGraphResource ImportBuffer(IBuffer*       pBuffer,
+                                     RESOURCE_STATE InitialState = RESOURCE_STATE_UNKNOWN,
+                                     RESOURCE_STATE FinalState   = RESOURCE_STATE_UNKNOWN);
+
+    /// Adds a pass to the graph.
+
+    /// \param[in] Name    - Pass name. It is also used as the debug group name.
+    /// \param[in] Setup   - Callback that declares the resources used by the pass. It is called immediately.
+    /// \param[in] Execute - Callback that records the pass commands. It is called by Execute()
+    ///                      unless the pass is culled.
+    void AddPass(const char* Name, const SetupCallbackType& Setup, ExecuteCallbackType Execute);
+
+    /// Culls unused passes and assigns device objects to transient resources.
+
+    /// \remarks    Execute() compiles the graph if it has not been compiled.
+    void Compile();
+
+    /// Executes the graph.
+    void Execute(IDeviceContext* pContext);
+
+    /// Removes all passes and resources from the graph. The pool of transient objects is kept.
+    void Reset();
+
+    /// Releases the pooled device objects, render passes and framebuffers that are not used by the current graph.
+    void ReleaseTransientResources();
+
+    struct Statistics
+    {
+        /// The number of passes in the graph.
+        Uint32 NumPasses = 0;
+
+        /// The number of culled passes.
+        Uint32 NumCulledPasses = 0;
+
+        /// The number of transient resources used by the executed passes.
+        Uint32 NumTransientResources = 0;
+
+        /// The number of device objects assigned to transient resources.
+        /// This number is smaller than NumTransientResources when objects are reused.
+        Uint32 NumTransientObjects = 0;
+
+        /// The number of state transitions issued by the last Execute() call.
+        /// A split barrier counts as one transition.
+        Uint32 NumTransitions = 0;
+
+        /// The number of state transitions that are issued as split barriers.
+        Uint32 NumSplitBarriers = 0;
+
+        /// The number of render passes that the rasterization passes are merged into.
+        Uint32 NumRenderPasses = 0;
+
+        /// The number of rasterization passes that are executed as subpasses of these render passes.
+        Uint32 NumMergedPasses = 0;
+    };
+
+    /// Returns the statistics of the graph.
+    const Statistics& GetStatistics() const { return m_Stats; }
+
+    /// Returns true if the pass with the given index has been culled by Compile().
+    bool IsPassCulled(Uint32 PassIndex) const;
+
+private:
+    friend RenderGraphBuilder;
+    friend RenderGraphContext;
+
+    enum class ResourceType : Uint8
+    {
+        Texture,
+        Buffer
+    };
+
+    struct ResourceInfo
+    {
+        ResourceType Type = ResourceType::Texture;
+        std::string  Name;
+        TextureDesc  TexDesc;
+        BufferDesc   BuffDesc;
+
+        // Imported resource, or the object taken from the pool for a transient resource
+        RefCntAutoPtr<IDeviceObject> pObject;
+
+        bool           IsImported   = false;
+        RESOURCE_STATE InitialState = RESOURCE_STATE_UNKNOWN;
+        RESOURCE_STATE FinalState   = RESOURCE_STATE_UNKNOWN;
+
+        // The first and the last non-culled pass that use the resource
+        Uint32 FirstPass = ~0u;
+        Uint32 LastPass  = 0;
+
+        // Index of the object in the pool (transient resources only)
+        Uint32 PoolIndex = ~0u;
+
+        // Resource state during execution
+        RESOURCE_STATE State = RESOURCE_STATE_UNKNOWN;
+
+        // Read-only depth-stencil view of an imported texture (there is no default view of this type)
+        RefCntAutoPtr<ITextureView> pReadOnlyDSV;
+    };
+
+    struct ResourceAccess
+    {
+        Uint32         ResIndex = 0;
+        RESOURCE_STATE State    = RESOURCE_STATE_UNKNOWN;
+        bool           IsWrite  = false;
+
+        // Whether the access is declared with RenderGraphBuilder::ReadInputAttachment().
+        // State is set to RESOURCE_STATE_INPUT_ATTACHMENT or RESOURCE_STATE_SHADER_RESOURCE by Compile().
+        bool IsInputAttachment = false;
+
+        // Whether the transition to State ends a split barrier that was begun after the previous access
+        bool EndsSplitBarrier = false;
+    };
+
+    struct SplitBarrier
+    {
+        Uint32         ResIndex = 0;
+        RESOURCE_STATE OldState = RESOURCE_STATE_UNKNOWN;
+        RESOURCE_STATE NewState = RESOURCE_STATE_UNKNOWN;
+    };
+
+    struct AttachmentInfo
+    {
+        Uint32              ResIndex = RenderGraphResource::InvalidIndex;
+        ATTACHMENT_LOAD_OP  LoadOp   = ATTACHMENT_LOAD_OP_LOAD;
+        OptimizedClearValue ClearValue;
+    };
+
+    struct PassInfo
+    {
+        std::string                 Name;
+        std::vector<ResourceAccess> Accesses;
+        ExecuteCallbackType         Execute;
+        bool                        HasSideEffects = false;
+        bool                        IsCulled       = false;
+
+        // Split barriers to begin after the pass is executed
+        std::vector<SplitBarrier> BeginSplitBarriers;
+
+        // Attachments of a rasterization pass
+        Uint32         NumRenderTargets = 0;
+        AttachmentInfo RenderTargets[MAX_RENDER_TARGETS];
+        AttachmentInfo DepthStencil;
+        bool           ReadOnlyDepth = false;
+
+        // Index of the render pass the pass is merged into, or ~0u
+        Uint32 RenderPassIndex = ~0u;
+        Uint32 SubpassIndex    = 0;
+
+        bool IsRasterPass() const
+        {
+            return NumRenderTargets > 0 || DepthStencil.ResIndex != RenderGraphResource::InvalidIndex;
+        }
+
+        bool IsAttachment(Uint32 ResIndex) const
+        {
+            for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
+            {
+                if (RenderTargets[rt].ResIndex == ResIndex)
+                    return true;
+            }
+            return DepthStencil.ResIndex == ResIndex;
+        }
+    };
+
+    // Consecutive rasterization passes merged into one render pass
+    struct MergedRenderPass
+    {
+        Uint32 FirstPass = 0;
+        Uint32 LastPass  = 0;
+
+        // Resource index of every render pass attachment
+        std::vector<Uint32>              Attachments;
+        std::vector<OptimizedClearValue> ClearValues;
+
+        IRenderPass*  pRenderPass  = nullptr;
+        IFramebuffer* pFramebuffer = nullptr;
+    };
+
+    struct CachedRenderPass
+    {
+        // Subpass descriptions own the attachment references of Desc
+        std::vector<SubpassDescX>  Subpasses;
+        RenderPassDescX            Desc;
+        RefCntAutoPtr<IRenderPass> pRenderPass;
+        bool                       InUse = false;
+    };
+
+    struct CachedFramebuffer
+    {
+        IRenderPass*                pRenderPass = nullptr;
+        std::vector<ITextureView*>  Attachments;
+        RefCntAutoPtr<IFramebuffer> pFramebuffer;
+        bool                        InUse = false;
+    };
+
+    struct PooledObject
+    {
+        ResourceType                 Type = ResourceType::Texture;
+        TextureDesc                  TexDesc;
+        BufferDesc                   BuffDesc;
+        RefCntAutoPtr<IDeviceObject> pObject;
+        RefCntAutoPtr<ITextureView>  pReadOnlyDSV;
+        bool                         InUse = false;
+    };
+
+    RenderGraphResource AddResource(ResourceInfo&& Res);
+    void                AddAccess(Uint32 PassIndex, RenderGraphResource Res, RESOURCE_STATE State, bool IsWrite);
+    void                CullPasses();
+    void                CalculateLifetimes();
+    void                AllocateTransientResources();
+    void                PlanSplitBarriers();
+    void                MergeRasterPasses();
+    bool                CanMergePass(const MergedRenderPass& RP, Uint32 PassIndex) const;
+    bool                CreateRenderPass(MergedRenderPass& RP);
+    void                SetPassRenderTargets(IDeviceContext* pContext, const PassInfo& Pass);
+    void                AddPassBarriers(Uint32 PassIndex, std::vector<bool>* pInRenderPass);
+    ITextureView*       GetAttachmentView(Uint32 ResIndex, TEXTURE_VIEW_TYPE ViewType);
+    Uint32              AcquirePooledObject(const ResourceInfo& Res);
+    IDeviceObject*      GetResourceObject(RenderGraphResource Res, ResourceType Type) const;
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const bool m_SplitBarriersEnabled;
+    const bool m_SubpassMergingEnabled;
+
+    std::vector<ResourceInfo> m_Resources;
+    std::vector<PassInfo>     m_Passes;
+    std::vector<PooledObject> m_Pool;
+
+    std::vector<MergedRenderPass>  m_RenderPasses;
+    std::vector<CachedRenderPass>  m_RenderPassCache;
+    std::vector<CachedFramebuffer> m_FramebufferCache;
+
+    std::vector<StateTransitionDesc> m_Barriers;
+
+    Statistics m_Stats;
+
+    bool m_IsCompiled = false;
+
+    // Index of the pass that is being executed, used to validate resource access
+    Uint32 m_CurrentPass = ~0u;
+};
+
+} // namespace Diligent
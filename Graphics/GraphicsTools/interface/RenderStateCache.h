@@ -30,6 +30,7 @@
 /// Defines Diligent::IRenderStateCache interface
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Common/interface/ThreadPool.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
@@ -76,6 +77,13 @@ struct RenderStateCacheCreateInfo
     /// shaders. If null, original source factory will be used.
     IShaderSourceInputStreamFactory* pReloadSource DEFAULT_INITIALIZER(nullptr);
 
+    /// Whether to record which pipeline states are requested from the cache.
+    ///
+    /// \remarks   The recorded usage can be written to a pre-warm manifest with
+    ///             IRenderStateCache::WriteUsageManifest() and later passed to
+    ///             IRenderStateCache::Prewarm().
+    bool RecordUsage DEFAULT_INITIALIZER(false);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr RenderStateCacheCreateInfo() noexcept
     {}
@@ -228,6 +236,62 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateCache, IObject)
                                        Uint32       ContentVersion, 
                                        IFileStream* pStream) PURE;
 
+    /// Appends render states created since the last write to the journal.
+
+    /// \param [in]  ContentVersion - The version of the content to write.
+    /// \param [in]  pJournal       - Pointer to the IFileStream interface to append the journal record to.
+    /// \param [in]  pThreadPool    - Optional thread pool to write the record in a background task.
+    ///                               If null, the record is written by the calling thread.
+    ///
+    /// \return     true if there was no new data, or if the record was successfully written
+    ///             or enqueued for writing, and false otherwise.
+    ///
+    /// \remarks    Unlike WriteToStream(), this method only serializes the render states that have
+    ///             not been written yet. It can be called frequently (e.g. after a level is loaded)
+    ///             so that new data reaches the disk even if the application terminates unexpectedly.
+    ///
+    ///             At startup, load the main cache data with Load(), then load the journal with LoadJournal().
+    ///             To compact the journal, write the cache with WriteToStream() and truncate the journal.
+    ///
+    ///             Records are written in the order of AppendToJournal() calls. The journal stream must
+    ///             remain valid until the record is written, see WaitForJournal().
+    ///
+    ///             If ContentVersion is ~0u (aka 0xFFFFFFFF), the version of the
+    ///             previously loaded content will be used, or 0 if none was loaded.
+    ///
+    /// \warning    This method is not thread-safe and must not be called simultaneously
+    ///             with other methods.
+    VIRTUAL Bool METHOD(AppendToJournal)(THIS_
+                                         Uint32       ContentVersion,
+                                         IFileStream* pJournal,
+                                         IThreadPool* pThreadPool DEFAULT_VALUE(nullptr)) PURE;
+
+    /// Loads render states from the journal written by AppendToJournal().
+
+    /// \param [in] pJournal       - A pointer to the journal data.
+    /// \param [in] ContentVersion - The expected version of the content in the journal.
+    ///                              If the version of the content in any record does not match the expected version,
+    ///                              the record will not be loaded.
+    ///                              If ~0u is specified (aka 0xFFFFFFFF), the version will not be checked.
+    /// \param [in] MakeCopy       - Whether to make a copy of the journal data. Same as for Load().
+    ///
+    /// \return     true if all journal records were loaded successfully, and false otherwise.
+    ///
+    /// \remarks    An incomplete last record, e.g. if the application terminated while the
+    ///             record was being written, is ignored.
+    ///             A memory-mapped file (see MappedFileDataBlob) can be used to avoid reading
+    ///             the whole journal when MakeCopy is false.
+    ///
+    /// \warning    This method is not thread-safe and must not be called simultaneously
+    ///             with other methods.
+    VIRTUAL Bool METHOD(LoadJournal)(THIS_
+                                     const IDataBlob* pJournal,
+                                     Uint32           ContentVersion DEFAULT_VALUE(~0u),
+                                     Bool             MakeCopy       DEFAULT_VALUE(false)) PURE;
+
+    /// Waits until all journal records enqueued by AppendToJournal() are written.
+    VIRTUAL void METHOD(WaitForJournal)(THIS) PURE;
+
 
     /// Resets the cache to default state.
     VIRTUAL void METHOD(Reset)(THIS) PURE;
@@ -247,6 +311,82 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateCache, IObject)
                                   ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline DEFAULT_VALUE(nullptr), 
                                   void*                              pUserData              DEFAULT_VALUE(nullptr)) PURE;
 
+    /// Reloads the render states that depend on the changed files.
+
+    /// \param [in]  ppFilePaths            - An array of paths of the files that have changed, for instance, as reported
+    ///                                       by a file watcher.
+    /// \param [in]  NumFiles               - The number of elements in ppFilePaths array.
+    /// \param [in]  ReloadGraphicsPipeline - An optional callback function that will be called by the render state cache
+    ///                                       to let the application modify graphics pipeline state info before creating new
+    ///                                       pipeline.
+    /// \param [in]  pUserData              - A pointer to the user-specific data to pass to ReloadGraphicsPipeline callback.
+    ///
+    /// \return     The total number of render states (shaders and pipelines) that were reloaded.
+    ///
+    /// \remarks    Unlike Reload(), this method only reloads the shaders whose source file or any of the files it includes,
+    ///             directly or indirectly, matches one of the changed files, and the pipelines that use these shaders.
+    ///             A changed file matches a shader dependency if the dependency path is a trailing part of the changed
+    ///             file path, so absolute paths reported by a file watcher can be used.
+    ///
+    ///             Shaders and then pipelines are recreated in parallel on the device's shader compilation thread pool,
+    ///             if it is available. The ReloadGraphicsPipeline callback may thus be called from multiple threads
+    ///             simultaneously. The method returns when all states are recreated, and every reloadable object
+    ///             switches to the new internal object only after it has been successfully created.
+    ///
+    ///             Reloading is only enabled if the cache was created with the EnableHotReload member of
+    ///             RenderStateCacheCreateInfo member set to true.
+    VIRTUAL Uint32 METHOD(ReloadFiles)(THIS_
+                                       const char* const*                 ppFilePaths,
+                                       Uint32                             NumFiles,
+                                       ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline DEFAULT_VALUE(nullptr),
+                                       void*                              pUserData              DEFAULT_VALUE(nullptr)) PURE;
+
+    /// Writes the pipeline state usage recorded since the cache was created or ResetUsage() was called.
+
+    /// \param [out] ppManifest - Address of the memory location where a pointer to the data blob
+    ///                           containing the pre-warm manifest will be written.
+    ///
+    /// \return     true if the manifest was written successfully, and false otherwise.
+    ///
+    /// \remarks    The manifest lists every pipeline state requested from the cache, ordered by the time
+    ///             of its first request. It only references the pipelines by their archive names,
+    ///             so it is compact and does not contain any pipeline data.
+    ///
+    ///             Usage is only recorded if the cache was created with the RecordUsage member of
+    ///             RenderStateCacheCreateInfo set to true.
+    VIRTUAL Bool METHOD(WriteUsageManifest)(THIS_
+                                            IDataBlob** ppManifest) PURE;
+
+    /// Clears the recorded pipeline state usage, for instance, when a new level starts loading.
+    VIRTUAL void METHOD(ResetUsage)(THIS) PURE;
+
+    /// Creates the pipeline states listed in the pre-warm manifest.
+
+    /// \param [in] pManifest - A pointer to the manifest written by WriteUsageManifest().
+    ///
+    /// \return     The number of pipeline states that were unpacked from the cache.
+    ///
+    /// \remarks    The method is intended to be called during loading screens. Pipelines are unpacked from
+    ///             the cache data in the order of their first use, so that the pipelines needed first are
+    ///             ready first. Resource signatures and shaders referenced by the pipelines are unpacked
+    ///             along with them. Pipelines that are not found in the cache data are skipped.
+    ///
+    ///             If the device supports asynchronous shader compilation, the pipelines are compiled
+    ///             asynchronously, and the method returns immediately. Use GetNumPendingPrewarmPipelines()
+    ///             to check the progress. A request for a pipeline that is still compiling waits for
+    ///             its compilation to complete, unless the request itself is asynchronous.
+    ///
+    ///             The cache keeps strong references to the pre-warmed pipelines until
+    ///             ReleasePrewarmedPipelines() or Reset() is called.
+    VIRTUAL Uint32 METHOD(Prewarm)(THIS_
+                                   const IDataBlob* pManifest) PURE;
+
+    /// Returns the number of pipelines created by Prewarm() that are still being compiled.
+    VIRTUAL Uint32 METHOD(GetNumPendingPrewarmPipelines)(THIS) PURE;
+
+    /// Releases the references to the pipelines created by Prewarm().
+    VIRTUAL void METHOD(ReleasePrewarmedPipelines)(THIS) PURE;
+
     /// Returns the content version of the cache data.
     /// If no data has been loaded, returns ~0u (aka 0xFFFFFFFF).
     VIRTUAL Uint32 METHOD(GetContentVersion)(THIS) CONST PURE;
@@ -266,8 +406,17 @@ DILIGENT_END_INTERFACE
 #    define IRenderStateCache_CreateTilePipelineState(This, ...)       CALL_IFACE_METHOD(RenderStateCache, CreateTilePipelineState,      This, __VA_ARGS__)
 #    define IRenderStateCache_WriteToBlob(This, ...)                   CALL_IFACE_METHOD(RenderStateCache, WriteToBlob,                  This, __VA_ARGS__)
 #    define IRenderStateCache_WriteToStream(This, ...)                 CALL_IFACE_METHOD(RenderStateCache, WriteToStream,                This, __VA_ARGS__)
+#    define IRenderStateCache_AppendToJournal(This, ...)               CALL_IFACE_METHOD(RenderStateCache, AppendToJournal,              This, __VA_ARGS__)
+#    define IRenderStateCache_LoadJournal(This, ...)                   CALL_IFACE_METHOD(RenderStateCache, LoadJournal,                  This, __VA_ARGS__)
+#    define IRenderStateCache_WaitForJournal(This)                     CALL_IFACE_METHOD(RenderStateCache, WaitForJournal,               This)
 #    define IRenderStateCache_Reset(This)                              CALL_IFACE_METHOD(RenderStateCache, Reset,                        This)
 #    define IRenderStateCache_Reload(This, ...)                        CALL_IFACE_METHOD(RenderStateCache, Reload,                       This, __VA_ARGS__)
+#    define IRenderStateCache_ReloadFiles(This, ...)                   CALL_IFACE_METHOD(RenderStateCache, ReloadFiles,                  This, __VA_ARGS__)
+#    define IRenderStateCache_WriteUsageManifest(This, ...)            CALL_IFACE_METHOD(RenderStateCache, WriteUsageManifest,           This, __VA_ARGS__)
+#    define IRenderStateCache_ResetUsage(This)                         CALL_IFACE_METHOD(RenderStateCache, ResetUsage,                   This)
+#    define IRenderStateCache_Prewarm(This, ...)                       CALL_IFACE_METHOD(RenderStateCache, Prewarm,                      This, __VA_ARGS__)
+#    define IRenderStateCache_GetNumPendingPrewarmPipelines(This)      CALL_IFACE_METHOD(RenderStateCache, GetNumPendingPrewarmPipelines,This)
+#    define IRenderStateCache_ReleasePrewarmedPipelines(This)          CALL_IFACE_METHOD(RenderStateCache, ReleasePrewarmedPipelines,    This)
 #    define IRenderStateCache_GetContentVersion(This)                  CALL_IFACE_METHOD(RenderStateCache, GetContentVersion,            This)
 // clang-format on
 
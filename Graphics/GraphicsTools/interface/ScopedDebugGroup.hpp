@@ -30,11 +30,15 @@
 
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/CPUProfiler.hpp"
 
 namespace Diligent
 {
 
 /// Helper class to manage scoped debug group.
+
+/// When the CPU profiler is enabled (DILIGENT_CPU_PROFILER_ENABLED), the group
+/// is also recorded as a CPU profiling scope with the same name.
 class ScopedDebugGroup
 {
 public:
@@ -44,6 +48,10 @@ public:
                      const Char*     Name,
                      const float*    pColor = nullptr) noexcept :
         m_pContext{pContext}
+#if DILIGENT_CPU_PROFILER_ENABLED
+        ,
+        m_CPUScope{CPUProfiler::IsEnabled() ? CPUProfiler::InternName(Name) : nullptr}
+#endif
     {
         VERIFY_EXPR(pContext != nullptr && Name != nullptr);
         pContext->BeginDebugGroup(Name, pColor);
@@ -70,6 +78,10 @@ public:
 
     ScopedDebugGroup(ScopedDebugGroup&& rhs) noexcept :
         m_pContext{rhs.m_pContext}
+#if DILIGENT_CPU_PROFILER_ENABLED
+        ,
+        m_CPUScope{std::move(rhs.m_CPUScope)}
+#endif
     {
         rhs.m_pContext = nullptr;
     }
@@ -78,11 +90,17 @@ public:
     {
         m_pContext     = rhs.m_pContext;
         rhs.m_pContext = nullptr;
+#if DILIGENT_CPU_PROFILER_ENABLED
+        m_CPUScope = std::move(rhs.m_CPUScope);
+#endif
         return *this;
     }
 
 private:
     IDeviceContext* m_pContext = nullptr;
+#if DILIGENT_CPU_PROFILER_ENABLED
+    CPUProfileScope m_CPUScope;
+#endif
 };
 
 } // namespace Diligent
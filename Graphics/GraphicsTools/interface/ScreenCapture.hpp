@@ -30,21 +30,108 @@
 #include <mutex>
 #include <vector>
 #include <deque>
+#include <functional>
+#include <memory>
 
 #include "../../GraphicsEngine/interface/SwapChain.h"
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.h"
 
 namespace Diligent
 {
 
+/// Captured frame data passed to the ScreenCapture frame callback.
+struct CapturedFrame
+{
+    /// Frame id passed to ScreenCapture::Capture().
+    Uint32 Id = 0;
+
+    /// Frame width, in pixels.
+    Uint32 Width = 0;
+
+    /// Frame height, in pixels.
+    Uint32 Height = 0;
+
+    /// Pixel format. If ScreenCaptureCreateInfo::ConvertToRGBA8 is true,
+    /// BGRA8 frames are converted to the corresponding RGBA8 format.
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+
+    /// Tightly packed pixel data. The data is only valid during the callback.
+    const Uint8* pData = nullptr;
+
+    /// Row stride, in bytes.
+    Uint64 Stride = 0;
+};
+
+/// ScreenCapture frame callback.
+///
+/// \remarks   The callback is called by the thread pool threads, if ScreenCaptureCreateInfo::pThreadPool
+///            is not null, so it may be called by multiple threads simultaneously and receive the
+///            frames out of order. Otherwise it is called by ScreenCapture::ProcessCaptures().
+using ScreenCaptureCallbackType = std::function<void(const CapturedFrame& Frame)>;
+
+/// ScreenCapture create info.
+struct ScreenCaptureCreateInfo
+{
+    /// The maximum number of frames that may be in flight, i.e. copied to the staging
+    /// textures, but not yet delivered to the application. When the limit is reached,
+    /// Capture() drops the frame instead of creating a new staging texture.
+    /// Zero means no limit.
+    Uint32 MaxFramesInFlight = 0;
+
+    /// An optional callback that receives the captured frames, see Diligent::ScreenCaptureCallbackType.
+    /// When the callback is set, ProcessCaptures() must be called every frame,
+    /// and GetCapture() must not be used.
+    ScreenCaptureCallbackType FrameCallback;
+
+    /// An optional thread pool to convert the captured frames and call the frame callback.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// Whether to convert BGRA8 frames to RGBA8.
+    bool ConvertToRGBA8 = false;
+};
+
+/// ScreenCapture statistics.
+struct ScreenCaptureStats
+{
+    /// The total number of frames copied to the staging textures.
+    Uint64 NumCapturedFrames = 0;
+
+    /// The total number of frames dropped because MaxFramesInFlight was reached.
+    Uint64 NumDroppedFrames = 0;
+
+    /// The number of frames that are in flight.
+    Uint32 NumFramesInFlight = 0;
+};
+
 class ScreenCapture
 {
 public:
-    ScreenCapture(IRenderDevice* pDevice);
+    ScreenCapture(IRenderDevice* pDevice, const ScreenCaptureCreateInfo& CI = {});
+    ~ScreenCapture();
+
+    /// Copies the current back buffer of the swap chain to a staging texture.
+
+    /// \return    false if the frame was dropped because ScreenCaptureCreateInfo::MaxFramesInFlight
+    ///            frames are in flight, and true otherwise.
+    bool Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId);
+
+    /// Delivers the captured frames to the frame callback.
+
+    /// \param[in] pContext - Device context to map the staging textures.
+    ///                       Must be the context that is used by Capture().
+    ///
+    /// \remarks   The method maps the staging textures whose copies have completed, and hands the
+    ///            mapped data over to the thread pool for conversion and the callback. The only
+    ///            work the render thread does is mapping and unmapping the staging textures.
+    void ProcessCaptures(IDeviceContext* pContext);
 
-    void Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId);
+    /// Waits until all captured frames are delivered to the frame callback.
+    void WaitForCompletion(IDeviceContext* pContext);
+
+    ScreenCaptureStats GetStats();
 
     struct CaptureInfo
     {
@@ -68,10 +155,20 @@ public:
         return m_PendingTextures.size();
     }
 
+private:
+    struct ConversionTask;
+    void ConvertFrame(ConversionTask& Task) const;
+    void ReleaseConversionTasks(IDeviceContext* pContext, bool WaitForTasks);
+
 private:
     RefCntAutoPtr<IFence>        m_pFence;
     RefCntAutoPtr<IRenderDevice> m_pDevice;
 
+    const Uint32                     m_MaxFramesInFlight;
+    const ScreenCaptureCallbackType  m_FrameCallback;
+    const RefCntAutoPtr<IThreadPool> m_pThreadPool;
+    const bool                       m_ConvertToRGBA8;
+
     std::mutex                           m_AvailableTexturesMtx;
     std::vector<RefCntAutoPtr<ITexture>> m_AvailableTextures;
 
@@ -94,6 +191,13 @@ private:
     std::deque<PendingTextureInfo> m_PendingTextures;
 
     Uint64 m_CurrentFenceValue = 1;
+
+    // Frames delivered to the callback whose staging textures are mapped
+    std::vector<std::unique_ptr<ConversionTask>> m_ConversionTasks;
+    std::vector<std::unique_ptr<ConversionTask>> m_FreeConversionTasks;
+
+    Uint64 m_NumCapturedFrames = 0;
+    Uint64 m_NumDroppedFrames  = 0;
 };
 
 } // namespace Diligent
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+// clang-format off
+/// \file
+/// Defines the content-addressed shader compile cache
+#include "../../Archiver/interface/ShaderCompileExecutor.h"
+#include "../../Archiver/interface/SerializationDevice.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+/// Shader compile cache create info
+struct ShaderCompileCacheCreateInfo
+{
+    /// The directory to store the compiled byte code in.
+
+    /// Every byte code is stored in a separate file named after the hash of the
+    /// serialized compile job (see Diligent::ShaderCompileJob::pData), which covers the
+    /// shader source, the compile parameters, the target device and its attributes.
+    /// Files are written to a temporary file first and then renamed, so the directory
+    /// may be shared by multiple processes and machines, e.g. located on a network drive
+    /// used by all machines of a build farm.
+    const Char* CacheDirectory DEFAULT_INITIALIZER(nullptr);
+
+    /// An optional executor that is used to compile the shaders that are not found in
+    /// the cache, for instance an executor that sends the jobs to remote workers.
+    IShaderCompileExecutor* pExecutor DEFAULT_INITIALIZER(nullptr);
+
+    /// An optional serialization device that compiles the shaders that are not found in
+    /// the cache and were not compiled by pExecutor, see ISerializationDevice::CompileShaderJob().
+
+    /// \remarks    This must not be the device that uses the cache as its compile executor, as
+    ///             this would create a circular reference. Without the device, shaders that are
+    ///             not found in the cache are compiled locally by the serialization device that
+    ///             uses the cache, and are not added to the cache.
+    ISerializationDevice* pDevice DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct ShaderCompileCacheCreateInfo ShaderCompileCacheCreateInfo;
+
+// clang-format on
+
+#include "../../../Primitives/interface/DefineGlobalFuncHelperMacros.h"
+
+/// Creates a shader compile executor that caches the compiled byte code in a directory.
+
+/// \param [in]  CreateInfo  - Shader compile cache create info, see Diligent::ShaderCompileCacheCreateInfo.
+/// \param [out] ppExecutor  - Address of the memory location where a pointer to the
+///                            shader compile executor interface will be written.
+///
+/// \remarks    The returned executor is intended to be passed to the serialization device through
+///             SerializationDeviceCreateInfo::pCompileExecutor. The byte code returned by a remote
+///             worker or compiled by pDevice is identical for identical jobs, so the archives
+///             produced with and without the cache are identical.
+void DILIGENT_GLOBAL_FUNCTION(CreateShaderCompileCache)(const ShaderCompileCacheCreateInfo REF CreateInfo,
+                                                        IShaderCompileExecutor**               ppExecutor);
+
+#include "../../../Primitives/interface/UndefGlobalFuncHelperMacros.h"
+
+DILIGENT_END_NAMESPACE // namespace Diligent
@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::ShadingRateGenerator class
+
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/PipelineState.h"
+#include "../../GraphicsEngine/interface/ShaderResourceBinding.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/TextureView.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Shading rate generator create info.
+struct ShadingRateGeneratorCreateInfo
+{
+    /// Prefix of the names of the shading rate map and the density buffers.
+    /// If null, "Shading rate generator" is used.
+    const char* Name = nullptr;
+
+    /// Width of the render target that the shading rate map is applied to.
+    Uint32 Width = 0;
+
+    /// Height of the render target that the shading rate map is applied to.
+    Uint32 Height = 0;
+
+    /// Preferred shading rate tile size, in pixels.
+    /// The size is rounded down to a power of two and clamped to
+    /// [ShadingRateProperties::MinTileSize, ShadingRateProperties::MaxTileSize].
+    Uint32 TileSize = 16;
+
+    /// Sample count of the render target. Only the shading rates that
+    /// support this sample count are written to the shading rate map.
+    Uint32 SampleCount = 1;
+
+    /// The number of shading rate maps that may be in flight when the device
+    /// reads the map on the CPU (ShadingRateProperties::ShadingRateTextureAccess is not
+    /// SHADING_RATE_TEXTURE_ACCESS_ON_GPU, or the map is a Metal rasterization rate map).
+    Uint32 MaxFramesInFlight = 3;
+};
+
+/// Generates the shading rate map from the luminance and motion vectors of the previous frame.
+
+/// Generate() runs a compute pass that, for every shading rate tile, estimates the horizontal and
+/// vertical luminance gradients of the previous frame and the average motion. The shading rate along
+/// each axis is reduced where the luminance changes less than the threshold. Motion raises the threshold,
+/// since moving content is blurred by temporal filtering and by the display itself.
+///
+/// The map is produced in the format required by the device (see ShadingRateProperties::Format):
+/// - SHADING_RATE_FORMAT_PALETTE (Vulkan fragment shading rate, Direct3D12 VRS tier 2):
+///   R8_UINT texture that contains Diligent::SHADING_RATE values. Every rate is replaced
+///   with the closest finer rate from ShadingRateProperties::ShadingRates.
+/// - SHADING_RATE_FORMAT_UNORM8 (Vulkan fragment density map): RG8_UNORM texture that contains
+///   the fragment density (1.0, 0.5 or 0.25) for the X and Y axes.
+/// - SHADING_RATE_FORMAT_COL_ROW_FP32 (Metal): the tile rates are reduced to per-column and per-row
+///   rates that are read back and used to create a rasterization rate map.
+///
+/// In all cases, GetShadingRateMap() returns the view that must be set as SetRenderTargetsAttribs::pShadingRateMap
+/// or used as the shading rate attachment of a render pass. For texture-based maps, the base rate and
+/// the combiners must be set with
+///
+///     pContext->SetShadingRate(SHADING_RATE_1X1, SHADING_RATE_COMBINER_PASSTHROUGH, SHADING_RATE_COMBINER_OVERRIDE);
+///
+/// \remarks    The device must support compute shaders and texture-based variable rate shading
+///             (SHADING_RATE_CAP_FLAG_TEXTURE_BASED), or be a Metal device with
+///             SHADING_RATE_FORMAT_COL_ROW_FP32 format.
+///
+/// \remarks    When the device reads the map on the CPU, and always for Metal rasterization rate maps,
+///             the result of Generate() becomes available after the GPU has executed the pass,
+///             so the map returned by GetShadingRateMap() may lag behind by a few frames.
+///             Until the first map is available, GetShadingRateMap() returns null.
+///             Render targets used with a rasterization rate map must have the physical size
+///             reported by IRasterizationRateMapMtl::GetPhysicalSizeForLayer().
+///
+/// \note   The class is not thread-safe.
+class ShadingRateGenerator
+{
+public:
+    ShadingRateGenerator(IRenderDevice* pDevice, const ShadingRateGeneratorCreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    ShadingRateGenerator           (const ShadingRateGenerator&)  = delete;
+    ShadingRateGenerator& operator=(const ShadingRateGenerator&)  = delete;
+    ShadingRateGenerator           (      ShadingRateGenerator&&) = delete;
+    ShadingRateGenerator& operator=(      ShadingRateGenerator&&) = delete;
+    // clang-format on
+
+    /// Generate() attributes.
+    struct GenerateAttribs
+    {
+        /// Shader resource view of the previous frame color.
+        /// The luminance is computed from the RGB channels, which should be in [0, 1] range.
+        /// The texture must have the same size as the render target.
+        ITextureView* pColorSRV = nullptr;
+
+        /// Shader resource view of the motion vectors of the previous frame (RG channels).
+        /// If null, the shading rate only depends on the luminance.
+        /// The texture must have the same size as the render target.
+        ITextureView* pMotionVectorsSRV = nullptr;
+
+        /// Scale that converts the motion vectors to pixels.
+        /// For motion vectors in UV space, use (Width, Height).
+        float2 MotionVectorScale = float2{1, 1};
+
+        /// Average luminance difference between neighboring pixels below which
+        /// the shading rate along the axis is halved.
+        float LuminanceThreshold = 1.f / 64.f;
+
+        /// Fraction of the luminance threshold below which the shading rate
+        /// along the axis is quartered.
+        float QuarterRateThresholdScale = 0.25f;
+
+        /// Motion, in pixels per frame, that doubles the luminance threshold.
+        /// Zero disables motion-based rate reduction.
+        float MotionSensitivity = 8.f;
+    };
+
+    /// Runs the shading rate generation pass.
+    void Generate(IDeviceContext* pContext, const GenerateAttribs& Attribs);
+
+    /// Returns the view of the most recent shading rate map that can be used for rendering, or null
+    /// if no map is available yet. The view remains valid until the next call to Generate().
+    ITextureView* GetShadingRateMap() const { return m_pShadingRateMap; }
+
+    /// Returns the Metal rasterization rate map object (IRasterizationRateMapMtl)
+    /// that owns the view returned by GetShadingRateMap(), or null on other backends.
+    IDeviceObject* GetRasterizationRateMap() const { return m_pRasterizationRateMap; }
+
+    /// Returns the shading rate tile size, in pixels.
+    uint2 GetTileSize() const { return m_TileSize; }
+
+    /// Returns the number of shading rate tiles along each axis.
+    uint2 GetNumTiles() const { return m_NumTiles; }
+
+private:
+    void CreatePipeline();
+    void ProcessCompletedFrames(IDeviceContext* pContext);
+    void CreateRasterizationRateMap(const Uint32* pColumnDensity, const Uint32* pRowDensity);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const std::string         m_Name;
+    const SHADING_RATE_FORMAT m_Format;
+    const Uint32              m_Width;
+    const Uint32              m_Height;
+
+    uint2 m_TileSize;
+    uint2 m_NumTiles;
+
+    // Supported shading rate for every Diligent::SHADING_RATE value
+    SHADING_RATE m_RateRemap[SHADING_RATE_MAX + 1] = {};
+
+    RefCntAutoPtr<IPipelineState>         m_pPSO;
+    RefCntAutoPtr<IShaderResourceBinding> m_pSRB;
+    IShaderResourceVariable*              m_pColorVar         = nullptr;
+    IShaderResourceVariable*              m_pMotionVectorsVar = nullptr;
+    IShaderResourceVariable*              m_pOutputVar        = nullptr;
+
+    RefCntAutoPtr<IBuffer> m_pConstantsBuffer;
+
+    // Texture the pass writes to when shading rate textures can't be used as UAVs
+    RefCntAutoPtr<ITexture> m_pIntermediateTexture;
+
+    // Per-column and per-row densities written by the pass for Metal rasterization rate maps
+    RefCntAutoPtr<IBuffer>       m_pColumnRowBuffer;
+    std::vector<Uint32>          m_ColumnRowClearData;
+    std::vector<Uint32>          m_ColumnRowDensities;
+    RefCntAutoPtr<IDeviceObject> m_pRasterizationRateMap;
+
+    struct FrameData
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+        RefCntAutoPtr<IBuffer>  pReadbackBuffer;
+
+        // Zero if the frame is not in flight
+        Uint64 FenceValue = 0;
+    };
+    std::vector<FrameData> m_Frames;
+    Uint32                 m_NextFrame = 0;
+
+    // Index of the frame whose texture is returned by GetShadingRateMap()
+    Uint32 m_ReadyFrame = ~0u;
+
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_NextFenceValue = 1;
+
+    ITextureView* m_pShadingRateMap = nullptr;
+};
+
+} // namespace Diligent
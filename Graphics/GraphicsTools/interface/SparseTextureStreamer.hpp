@@ -0,0 +1,376 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::SparseTextureStreamer class
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/DeviceMemory.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Sparse texture tile.
+struct SparseTextureTile
+{
+    /// Tile column at the mip level.
+    Uint32 X = 0;
+
+    /// Tile row at the mip level.
+    Uint32 Y = 0;
+
+    /// Mip level of the tile.
+    Uint32 MipLevel = 0;
+
+    constexpr bool operator==(const SparseTextureTile& RHS) const
+    {
+        return X == RHS.X && Y == RHS.Y && MipLevel == RHS.MipLevel;
+    }
+};
+
+/// Sparse texture tile loader.
+
+/// The loader must write the texels of the Region of the tile's mip level in the texture format
+/// to the memory described by Data, and return true on success.
+/// The tiles of the packed mip tail are loaded once for every mip level in the tail, with
+/// Tile.X and Tile.Y equal to zero and Region covering the entire mip level.
+/// The loader is called by the thread that calls SparseTextureStreamer::Update().
+using SparseTextureTileLoaderType = std::function<bool(const SparseTextureTile& Tile, const Box& Region, const MappedTextureSubresource& Data)>;
+
+/// Sparse texture streamer create info.
+struct SparseTextureStreamerCreateInfo
+{
+    /// Texture name.
+    const char* Name = nullptr;
+
+    /// Texture width, in texels.
+    Uint32 Width = 0;
+
+    /// Texture height, in texels.
+    Uint32 Height = 0;
+
+    /// Texture format.
+    TEXTURE_FORMAT Format = TEX_FORMAT_RGBA8_UNORM;
+
+    /// Texture bind flags. The texture always has the complete mip chain.
+    BIND_FLAGS BindFlags = BIND_SHADER_RESOURCE;
+
+    /// The number of memory pages in the pool, excluding the pages of the mip tail.
+
+    /// \remarks    The page size is the sparse block size of the texture (typically 64 KB),
+    ///             so this value defines the fixed amount of memory used by the streamed mip levels.
+    Uint32 NumMemoryPages = 256;
+
+    /// The maximum number of tiles bound by one Update() call.
+    Uint32 MaxBindsPerFrame = 32;
+
+    /// The number of frames between writing the GPU feedback and reading it back on the CPU.
+    Uint32 FeedbackLatency = 2;
+
+    /// Tile loader, see Diligent::SparseTextureTileLoaderType.
+    SparseTextureTileLoaderType TileLoader;
+};
+
+/// Sparse texture streamer statistics.
+struct SparseTextureStreamerStats
+{
+    /// The number of tiles bound to the memory pool, excluding the mip tail.
+    Uint32 NumResidentTiles = 0;
+
+    /// The number of free memory pages.
+    Uint32 NumFreePages = 0;
+
+    /// The number of evicted tiles that wait for the GPU to finish using them before they are unbound.
+    Uint32 NumPendingUnbinds = 0;
+
+    /// The number of non-resident tiles requested by the last feedback.
+    Uint32 NumRequestedTiles = 0;
+
+    /// The total number of tiles bound since the streamer was created.
+    Uint64 NumBoundTiles = 0;
+
+    /// The total number of tiles unbound since the streamer was created.
+    Uint64 NumUnboundTiles = 0;
+
+    /// The total number of tiles that failed to load.
+    Uint64 NumFailedTiles = 0;
+
+    /// The total number of IDeviceContext::BindSparseResourceMemory() calls.
+    Uint64 NumBindBatches = 0;
+};
+
+/// Sparse texture streamer.
+
+/// The streamer creates a sparse 2D texture with the complete mip chain and a memory pool
+/// of NumMemoryPages pages, and maps the tiles of the texture to the pool pages based on
+/// the mip residency feedback written by the shaders:
+///
+/// - The shader that samples the texture computes the mip level it needs (e.g. with
+///   CalculateLevelOfDetail() in HLSL or textureQueryLod() in GLSL) and writes it with
+///   InterlockedMin() / atomicMin() to the feedback buffer (RWStructuredBuffer<uint>,
+///   see GetFeedbackBuffer()) at the index of the feedback region that contains
+///   the sample: Feedback[RegionY * GetNumRegionsX() + RegionX], where
+///   RegionX = UV.x * GetNumRegionsX(), RegionY = UV.y * GetNumRegionsY().
+///   A region is covered by one tile of mip level 0.
+/// - Update() reads the feedback back with a latency of FeedbackLatency frames, binds
+///   the missing tiles within the per-frame budget and loads them with the tile loader,
+///   evicts the least recently used tiles when the pool is full, and updates the residency map.
+///   All bind and unbind operations of one Update() call are submitted by a single
+///   IDeviceContext::BindSparseResourceMemory() call.
+/// - The residency map (GetResidencyMap()) is an R8_UINT texture with one texel per region
+///   that contains the finest resident mip level of the region. The shader must clamp the
+///   level of detail to this value so that it never accesses unbound tiles,
+///   e.g. Texture.Sample(Sampler, UV, int2(0, 0), float(ResidencyMap.Load(int3(Region, 0)))) in HLSL.
+///
+/// A tile is only bound if the tile of the next mip level that covers it is resident, and only
+/// tiles without resident finer tiles are evicted, so the resident mip levels of every region
+/// always form a contiguous range. The packed mip tail is bound and loaded by the first Update()
+/// call and is never evicted. Evicted tiles are excluded from the residency map immediately,
+/// but are only unbound once the GPU has finished the frames that may still access them.
+///
+/// \note   The class is not thread-safe. Update() must be called by the thread that owns
+///         the device contexts passed to it.
+class SparseTextureStreamer
+{
+public:
+    /// \param[in] pDevice - Render device to create the resources with.
+    /// \param[in] CI      - Create info, see Diligent::SparseTextureStreamerCreateInfo.
+    ///
+    /// \remarks    The constructor throws an exception in case of an error, in particular
+    ///             if the device does not support sparse 2D textures.
+    SparseTextureStreamer(IRenderDevice* pDevice, const SparseTextureStreamerCreateInfo& CI);
+    ~SparseTextureStreamer();
+
+    // clang-format off
+    SparseTextureStreamer           (const SparseTextureStreamer&)  = delete;
+    SparseTextureStreamer& operator=(const SparseTextureStreamer&)  = delete;
+    SparseTextureStreamer           (      SparseTextureStreamer&&) = delete;
+    SparseTextureStreamer& operator=(      SparseTextureStreamer&&) = delete;
+    // clang-format on
+
+    /// Feedback value that does not request any mip level.
+    static constexpr Uint32 InvalidFeedback = ~0u;
+
+    /// Adds the feedback values to the tile requests processed by the next Update() call.
+
+    /// \param[in] pFeedback  - Desired mip level for every feedback region, see GetFeedbackBuffer().
+    ///                         InvalidFeedback values are ignored.
+    /// \param[in] NumEntries - The number of values in pFeedback. Must not exceed
+    ///                         GetNumRegionsX() * GetNumRegionsY().
+    ///
+    /// \remarks    The resident tiles referenced by the feedback are marked as recently used.
+    ///             The method is called by Update() for the GPU feedback buffer, and may be
+    ///             used by the application to provide additional feedback.
+    void AnalyzeFeedback(const Uint32* pFeedback, size_t NumEntries);
+
+    /// Updates the tile residency.
+
+    /// \param[in] pContext        - Device context to read back the feedback, load the tiles
+    ///                              and update the residency map.
+    /// \param[in] pBindingContext - Optional device context to bind the sparse memory with,
+    ///                              for example a context of the sparse binding queue.
+    ///                              If null, pContext is used.
+    ///
+    /// \remarks    The method should be called once per frame after the commands that
+    ///             write the feedback buffer have been recorded.
+    ///             Note that IDeviceContext::BindSparseResourceMemory() flushes pBindingContext,
+    ///             and that pContext waits on the GPU for the bind operations before it writes the tiles.
+    void Update(IDeviceContext* pContext, IDeviceContext* pBindingContext = nullptr);
+
+    /// Returns the sparse texture.
+    ITexture* GetTexture() const { return m_pTexture; }
+
+    /// Returns the residency map texture.
+    ITexture* GetResidencyMap() const { return m_pResidencyMap; }
+
+    /// Returns the GPU feedback buffer.
+
+    /// \remarks    The buffer is filled with InvalidFeedback by Update().
+    IBuffer* GetFeedbackBuffer() const { return m_pFeedbackBuffer; }
+
+    /// Returns the memory pool.
+    IDeviceMemory* GetMemory() const { return m_pMemory; }
+
+    /// Returns the number of feedback region columns, which is the number of tile columns at mip level 0.
+    Uint32 GetNumRegionsX() const { return m_NumRegionsX; }
+
+    /// Returns the number of feedback region rows, which is the number of tile rows at mip level 0.
+    Uint32 GetNumRegionsY() const { return m_NumRegionsY; }
+
+    /// Returns the first mip level of the packed mip tail.
+    Uint32 GetFirstMipInTail() const { return m_FirstMipInTail; }
+
+    /// Returns the number of tile columns at the given mip level.
+    Uint32 GetNumTilesX(Uint32 MipLevel) const;
+
+    /// Returns the number of tile rows at the given mip level.
+    Uint32 GetNumTilesY(Uint32 MipLevel) const;
+
+    /// Returns the CPU copy of the finest resident mip level of the feedback region.
+    Uint32 GetResidentMip(Uint32 RegionX, Uint32 RegionY) const;
+
+    /// Returns true if the tile is bound and loaded. Tiles of the mip tail are resident
+    /// once the first Update() call has loaded it.
+    bool IsTileResident(const SparseTextureTile& Tile) const;
+
+    /// Returns the streamer statistics, see Diligent::SparseTextureStreamerStats.
+    SparseTextureStreamerStats GetStats() const;
+
+private:
+    static constexpr Uint32 EncodeTile(const SparseTextureTile& Tile)
+    {
+        return (Tile.MipLevel << 24u) | (Tile.Y << 12u) | Tile.X;
+    }
+
+    static SparseTextureTile DecodeTile(Uint32 Key)
+    {
+        SparseTextureTile Tile;
+        Tile.X        = Key & 0xFFFu;
+        Tile.Y        = (Key >> 12u) & 0xFFFu;
+        Tile.MipLevel = Key >> 24u;
+        return Tile;
+    }
+
+    bool IsValidTile(const SparseTextureTile& Tile) const;
+    Box  GetTileRegion(const SparseTextureTile& Tile) const;
+
+    void   ReadBackFeedback(IDeviceContext* pContext);
+    void   ProcessPendingUnbinds();
+    void   StartBinds();
+    Uint32 AllocatePage();
+    bool   EvictTile();
+    void   SubmitBinds(IDeviceContext* pContext, IDeviceContext* pBindingContext);
+    bool   LoadTile(IDeviceContext* pContext, const SparseTextureTile& Tile);
+    void   UpdateResidency(const SparseTextureTile& Tile, bool IsResident);
+    void   UploadResidencyMap(IDeviceContext* pContext);
+
+private:
+    const std::string m_Name;
+
+    const TEXTURE_FORMAT m_Format;
+    const Uint32         m_MaxBindsPerFrame;
+
+    SparseTextureTileLoaderType m_TileLoader;
+
+    RefCntAutoPtr<ITexture>      m_pTexture;
+    RefCntAutoPtr<IDeviceMemory> m_pMemory;
+    RefCntAutoPtr<ITexture>      m_pResidencyMap;
+
+    Uint32 m_NumMipLevels   = 0;
+    Uint32 m_FirstMipInTail = 0;
+    Uint32 m_TileWidth      = 0;
+    Uint32 m_TileHeight     = 0;
+    Uint32 m_NumRegionsX    = 0;
+    Uint32 m_NumRegionsY    = 0;
+    Uint64 m_BlockSize      = 0;
+    Uint64 m_MipTailSize    = 0;
+
+    // The mip tail occupies the first pages of the memory
+    Uint32 m_NumMipTailPages = 0;
+    bool   m_MipTailBound    = false;
+
+    // CPU copy of the residency map
+    std::vector<Uint8> m_ResidencyMap;
+    Box                m_DirtyRegion;
+
+    struct ResidentTile
+    {
+        Uint32 Page = 0;
+
+        // The frame when the tile was last requested by the feedback.
+        Uint64 LastUsedFrame = 0;
+
+        // The number of resident or binding tiles of the next finer mip level that this tile covers.
+        Uint32 NumResidentChildren = 0;
+    };
+    // Resident tiles: encoded tile -> tile info.
+    std::unordered_map<Uint32, ResidentTile> m_ResidentTiles;
+    // Tiles that failed to load. They are not requested again.
+    std::unordered_set<Uint32> m_FailedTiles;
+
+    // Non-resident tiles requested by the feedback since the last Update(): encoded tile -> request count.
+    std::unordered_map<Uint32, Uint32> m_RequestedTiles;
+    Uint32                             m_NumRequestedTiles = 0;
+
+    struct PendingBind
+    {
+        Uint32 Tile = 0;
+        Uint32 Page = 0;
+    };
+    // Tiles to bind by the current Update() call.
+    std::vector<PendingBind> m_PendingBinds;
+
+    struct PendingUnbind
+    {
+        Uint32 Tile       = 0;
+        Uint32 Page       = 0;
+        Uint64 FenceValue = 0;
+    };
+    // Evicted tiles that will be unbound when the frame fence reaches the value.
+    std::vector<PendingUnbind> m_PendingUnbinds;
+    // Tiles to unbind by the current Update() call.
+    std::vector<Uint32> m_TilesToUnbind;
+
+    std::vector<Uint32> m_FreePages;
+
+    std::vector<Uint8> m_LoadData;
+
+    RefCntAutoPtr<IBuffer>              m_pFeedbackBuffer;
+    std::vector<Uint32>                 m_FeedbackClearData;
+    std::vector<RefCntAutoPtr<IBuffer>> m_FeedbackReadbackBuffers;
+    std::vector<Uint64>                 m_FeedbackReadbackFenceValues;
+    Uint32                              m_NextFeedbackReadback = 0;
+
+    // Signaled by pContext at the end of every Update() call with the frame index.
+    RefCntAutoPtr<IFence> m_pFrameFence;
+    // Signaled by the bind operations and waited for by pContext. Null in Direct3D11,
+    // where tile mapping is executed by the immediate context in order.
+    RefCntAutoPtr<IFence> m_pBindFence;
+    Uint64                m_NextBindFenceValue = 1;
+
+    Uint64 m_FrameIndex = 1;
+
+    Uint64 m_NumBoundTiles   = 0;
+    Uint64 m_NumUnboundTiles = 0;
+    Uint64 m_NumFailedTiles  = 0;
+    Uint64 m_NumBindBatches  = 0;
+};
+
+} // namespace Diligent
@@ -27,7 +27,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -36,6 +38,7 @@
 #include "../../GraphicsEngine/interface/Buffer.h"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
 #include "MapHelper.hpp"
+#include "GPUCompletionAwaitQueue.hpp"
 
 namespace Diligent
 {
@@ -47,6 +50,49 @@ struct StreamingBufferCreateInfo
     std::function<void(IBuffer*)> OnBufferResizeCallback = nullptr;
     Uint32                        NumContexts            = 1;
     bool                          AllowPersistentMapping = false;
+
+    /// Whether to grow the buffer by chaining fixed-size pages.
+
+    /// By default, when the data does not fit into the buffer, the buffer is
+    /// released and a larger one is created, which stalls and keeps the memory
+    /// after a usage spike. When this flag is set, every context instead owns a chain
+    /// of BuffDesc.Size-byte pages: when the data does not fit into the current page,
+    /// the context switches to another page, and the previous page is recycled
+    /// once the GPU is done with it. An allocation larger than the page size
+    /// gets a dedicated page that is released after use.
+    ///
+    /// \remarks   GetBuffer() returns the current page of the context, which may change
+    ///            after every Map() call. OnBufferResizeCallback is called every time
+    ///            the context switches to a different page.
+    bool UsePages = false;
+
+    /// When UsePages is true, the maximum number of unused pages every context keeps for reuse.
+    /// Pages above the limit are released, so that the buffer shrinks after usage spikes.
+    Uint32 MaxIdlePages = 2;
+};
+
+/// Streaming buffer statistics of a device context.
+struct StreamingBufferStats
+{
+    /// The number of bytes allocated since the last Flush() or Reset().
+    Uint64 CurrentSize = 0;
+
+    /// The maximum number of bytes allocated between two flushes.
+    Uint64 PeakSize = 0;
+
+    /// The number of pages the context has used since the last flush.
+    /// Always 1 if StreamingBufferCreateInfo::UsePages is false.
+    Uint32 NumActivePages = 0;
+
+    /// The maximum number of pages used between two flushes.
+    Uint32 PeakActivePages = 0;
+
+    /// The total number of pages owned by the context, including the pages that
+    /// are waiting for the GPU and the idle pages.
+    Uint32 NumPages = 0;
+
+    /// The number of idle pages available for reuse.
+    Uint32 NumIdlePages = 0;
 };
 
 class StreamingBuffer
@@ -57,16 +103,33 @@ public:
 
     explicit StreamingBuffer(const StreamingBufferCreateInfo& CI) :
         m_UsePersistentMap{CI.AllowPersistentMapping && (CI.pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_VULKAN || CI.pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D12)},
+        m_UsePages{CI.UsePages},
+        m_MaxIdlePages{CI.MaxIdlePages},
         m_BufferSize{CI.BuffDesc.Size},
         m_OnBufferResizeCallback{CI.OnBufferResizeCallback},
         m_MapInfo(CI.NumContexts)
     {
         VERIFY_EXPR(CI.pDevice != nullptr);
         VERIFY_EXPR(CI.BuffDesc.Usage == USAGE_DYNAMIC);
-        CI.pDevice->CreateBuffer(CI.BuffDesc, nullptr, &m_pBuffer);
-        VERIFY_EXPR(m_pBuffer);
-        if (m_OnBufferResizeCallback)
-            m_OnBufferResizeCallback(m_pBuffer);
+        if (m_UsePages)
+        {
+            for (auto& MapInfo : m_MapInfo)
+            {
+                MapInfo.m_pPageQueue = std::make_unique<PageQueueType>(CI.pDevice);
+                CI.pDevice->CreateBuffer(CI.BuffDesc, nullptr, &MapInfo.m_pPage);
+                VERIFY_EXPR(MapInfo.m_pPage);
+                MapInfo.m_NumPages = 1;
+                if (m_OnBufferResizeCallback)
+                    m_OnBufferResizeCallback(MapInfo.m_pPage);
+            }
+        }
+        else
+        {
+            CI.pDevice->CreateBuffer(CI.BuffDesc, nullptr, &m_pBuffer);
+            VERIFY_EXPR(m_pBuffer);
+            if (m_OnBufferResizeCallback)
+                m_OnBufferResizeCallback(m_pBuffer);
+        }
     }
 
     StreamingBuffer(const StreamingBuffer&) = delete;
@@ -89,12 +152,18 @@ public:
         VERIFY_EXPR(Size > 0);
 
         auto& MapInfo = m_MapInfo[CtxNum];
+        if (m_UsePages)
+        {
+            // Check if there is enough space in the current page
+            if (MapInfo.m_CurrOffset + Size > MapInfo.m_pPage->GetDesc().Size)
+                SwitchPage(pCtx, pDevice, Size, MapInfo);
+        }
         // Check if there is enough space in the buffer
-        if (MapInfo.m_CurrOffset + Size > m_BufferSize)
+        else if (MapInfo.m_CurrOffset + Size > m_BufferSize)
         {
-            // Unmap the buffer
-            Flush(CtxNum);
-            VERIFY_EXPR(MapInfo.m_CurrOffset == 0);
+            // Unmap the buffer. Do not use Flush() to keep the statistics of the current frame.
+            MapInfo.m_MappedData.Unmap();
+            MapInfo.m_CurrOffset = 0;
 
             if (Size > m_BufferSize)
             {
@@ -125,13 +194,16 @@ public:
         {
             // If current offset is zero, we are mapping the buffer for the first time after it has been Reset. Use MAP_FLAG_DISCARD flag.
             // Otherwise use MAP_FLAG_NO_OVERWRITE flag.
-            MapInfo.m_MappedData.Map(pCtx, m_pBuffer, MAP_WRITE, MapInfo.m_CurrOffset == 0 ? MAP_FLAG_DISCARD : MAP_FLAG_NO_OVERWRITE);
+            MapInfo.m_MappedData.Map(pCtx, GetBuffer(CtxNum), MAP_WRITE, MapInfo.m_CurrOffset == 0 ? MAP_FLAG_DISCARD : MAP_FLAG_NO_OVERWRITE);
             VERIFY_EXPR(MapInfo.m_MappedData);
         }
 
         auto Offset = MapInfo.m_CurrOffset;
         // Update offset
         MapInfo.m_CurrOffset += Size;
+
+        MapInfo.m_Stats.CurrentSize += Size;
+        MapInfo.m_Stats.PeakSize = std::max(MapInfo.m_Stats.PeakSize, MapInfo.m_Stats.CurrentSize);
         return Offset;
     }
 
@@ -158,6 +230,9 @@ public:
     {
         m_MapInfo[CtxNum].m_MappedData.Unmap();
         m_MapInfo[CtxNum].m_CurrOffset = 0;
+
+        m_MapInfo[CtxNum].m_Stats.CurrentSize    = 0;
+        m_MapInfo[CtxNum].m_Stats.NumActivePages = 1;
     }
 
     void Reset()
@@ -166,16 +241,89 @@ public:
             Flush(ctx);
     }
 
-    IBuffer* GetBuffer() const { return m_pBuffer; }
+    IBuffer* GetBuffer(size_t CtxNum = 0) const
+    {
+        return m_UsePages ? m_MapInfo[CtxNum].m_pPage.RawPtr() : m_pBuffer.RawPtr();
+    }
 
     void* GetMappedCPUAddress(size_t CtxNum = 0)
     {
         return m_MapInfo[CtxNum].m_MappedData;
     }
 
+    StreamingBufferStats GetStats(size_t CtxNum = 0) const
+    {
+        const auto& MapInfo = m_MapInfo[CtxNum];
+
+        StreamingBufferStats Stats = MapInfo.m_Stats;
+        Stats.NumPages             = m_UsePages ? MapInfo.m_NumPages : 1;
+        Stats.NumIdlePages         = MapInfo.m_NumIdlePages;
+        return Stats;
+    }
+
+private:
+    using PageQueueType = GPUCompletionAwaitQueue<RefCntAutoPtr<IBuffer>>;
+
+    struct MapInfo;
+
+    void SwitchPage(IDeviceContext* pCtx, IRenderDevice* pDevice, Uint32 Size, MapInfo& Info)
+    {
+        Info.m_MappedData.Unmap();
+
+        const auto BuffDesc = Info.m_pPage->GetDesc();
+        // The page may be reused once the GPU has executed the commands recorded so far
+        Info.m_pPageQueue->Enqueue(pCtx, std::move(Info.m_pPage));
+
+        // Recycle the completed pages and release dedicated pages as well as
+        // pages above the idle limit
+        while (RefCntAutoPtr<IBuffer> pCompletedPage = Info.m_pPageQueue->GetFirstCompleted())
+        {
+            if (pCompletedPage->GetDesc().Size == m_BufferSize && Info.m_NumIdlePages < m_MaxIdlePages)
+            {
+                Info.m_pPageQueue->Recycle(std::move(pCompletedPage));
+                ++Info.m_NumIdlePages;
+            }
+            else
+            {
+                --Info.m_NumPages;
+            }
+        }
+
+        if (Size <= m_BufferSize)
+        {
+            Info.m_pPage = Info.m_pPageQueue->GetRecycled();
+            if (Info.m_pPage)
+                --Info.m_NumIdlePages;
+        }
+
+        if (!Info.m_pPage)
+        {
+            BufferDesc PageDesc = BuffDesc;
+            PageDesc.Size       = std::max(m_BufferSize, Uint64{Size});
+            // BuffDesc.Name becomes invalid after the old page is released
+            std::string Name = BuffDesc.Name != nullptr ? BuffDesc.Name : "";
+            PageDesc.Name    = Name.c_str();
+
+            pDevice->CreateBuffer(PageDesc, nullptr, &Info.m_pPage);
+            VERIFY_EXPR(Info.m_pPage);
+            ++Info.m_NumPages;
+        }
+
+        Info.m_CurrOffset = 0;
+        ++Info.m_Stats.NumActivePages;
+        Info.m_Stats.PeakActivePages = std::max(Info.m_Stats.PeakActivePages, Info.m_Stats.NumActivePages);
+
+        if (m_OnBufferResizeCallback)
+            m_OnBufferResizeCallback(Info.m_pPage);
+    }
+
 private:
     bool m_UsePersistentMap = false;
+    bool m_UsePages         = false;
 
+    Uint32 m_MaxIdlePages = 0;
+
+    // Buffer size, or page size when pages are used
     Uint64 m_BufferSize = 0;
 
     RefCntAutoPtr<IBuffer> m_pBuffer;
@@ -186,6 +334,14 @@ private:
     {
         MapHelper<Uint8> m_MappedData;
         Uint32           m_CurrOffset = 0;
+
+        // Current page and the pages that wait for the GPU or are idle, when pages are used
+        RefCntAutoPtr<IBuffer>         m_pPage;
+        std::unique_ptr<PageQueueType> m_pPageQueue;
+        Uint32                         m_NumPages     = 0;
+        Uint32                         m_NumIdlePages = 0;
+
+        StreamingBufferStats m_Stats{0, 0, 1, 1};
     };
     // We need to keep track of mapped data for every context
     std::vector<MapInfo> m_MapInfo;
@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::TLASInstanceManager class
+
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/TopLevelAS.h"
+#include "../../GraphicsEngine/interface/BottomLevelAS.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// TLAS instance manager create info.
+struct TLASInstanceManagerCreateInfo
+{
+    /// Name of the TLAS, which also prefixes the names of the instance and scratch buffers.
+    /// If null, "TLAS instance manager" is used.
+    const char* Name = nullptr;
+
+    /// TLAS build flags. RAYTRACING_BUILD_AS_ALLOW_UPDATE flag is required to update
+    /// the TLAS in place; without it, the TLAS is always rebuilt.
+    RAYTRACING_BUILD_AS_FLAGS Flags = RAYTRACING_BUILD_AS_ALLOW_UPDATE | RAYTRACING_BUILD_AS_PREFER_FAST_TRACE;
+
+    /// The initial TLAS capacity. The TLAS is recreated with a larger capacity when the number of instances exceeds it.
+    Uint32 InitialCapacity = 0;
+
+    /// Hit group binding attributes, see Diligent::BuildTLASAttribs.
+    Uint32                 HitGroupStride                  = 1;
+    Uint32                 BaseContributionToHitGroupIndex = 0;
+    HIT_GROUP_BINDING_MODE BindingMode                     = HIT_GROUP_BINDING_MODE_PER_GEOMETRY;
+
+    /// BLAS state transition mode, see Diligent::BuildTLASAttribs::BLASTransitionMode.
+    RESOURCE_STATE_TRANSITION_MODE BLASTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+    /// Refit threshold.
+
+    /// Updating the TLAS in place is faster than rebuilding it, but the quality of the acceleration
+    /// structure degrades as the instances move. The TLAS is rebuilt when the total number of instance
+    /// changes since the last rebuild exceeds RebuildThreshold * InstanceCount. For example, with the
+    /// default value, a TLAS where all instances move every frame is rebuilt every fourth frame.
+    float RebuildThreshold = 4.f;
+};
+
+/// Manages the instances of a top-level acceleration structure.
+
+/// The manager keeps a persistent array of instances that are added, removed and modified by handle,
+/// and builds the TLAS when Build() is called. Only the instances that have been changed since the last
+/// build are tracked, and the manager decides how to apply the changes:
+/// - When instances are added or removed, the TLAS is rebuilt, since an update requires the same instances.
+/// - When only the instance data such as transforms changed, the TLAS is updated in place, unless the number of
+///   changes since the last rebuild exceeds the threshold (see TLASInstanceManagerCreateInfo::RebuildThreshold).
+///
+/// The instance array is passed to IDeviceContext::BuildTLAS() in the same order in every update,
+/// which allows the engine to find the instances of the previous build without name lookups.
+///
+/// \remarks    When the TLAS is rebuilt, the hit group indices of the instances may change, and the
+///             shader binding table must be updated.
+///
+/// \note   The class is not thread-safe.
+class TLASInstanceManager
+{
+public:
+    /// Instance handle.
+    using InstanceHandle = Uint32;
+
+    /// Invalid instance handle.
+    static constexpr InstanceHandle InvalidHandle = ~0u;
+
+    /// The type of the operation performed by Build().
+    enum BUILD_TYPE : Uint8
+    {
+        /// Nothing has changed since the last build.
+        BUILD_TYPE_NONE,
+
+        /// The TLAS has been updated in place.
+        BUILD_TYPE_UPDATE,
+
+        /// The TLAS has been rebuilt.
+        BUILD_TYPE_REBUILD
+    };
+
+    TLASInstanceManager(IRenderDevice* pDevice, const TLASInstanceManagerCreateInfo& CI) noexcept(false);
+
+    // clang-format off
+    TLASInstanceManager           (const TLASInstanceManager&)  = delete;
+    TLASInstanceManager& operator=(const TLASInstanceManager&)  = delete;
+    TLASInstanceManager           (      TLASInstanceManager&&) = delete;
+    TLASInstanceManager& operator=(      TLASInstanceManager&&) = delete;
+    // clang-format on
+
+    /// Adds the instance and returns its handle.
+
+    /// \remarks    If Data.InstanceName is null, the name is generated from the handle, see GetInstanceName().
+    ///             Otherwise the name must be unique. The manager keeps a strong reference to the BLAS.
+    InstanceHandle AddInstance(const TLASBuildInstanceData& Data);
+
+    /// Removes the instance.
+    void RemoveInstance(InstanceHandle Handle);
+
+    /// Sets the transform of the instance.
+    void SetTransform(InstanceHandle Handle, const InstanceMatrix& Transform);
+
+    /// Sets the instance data. The instance name can't be changed, and Data.InstanceName is ignored.
+    void SetInstance(InstanceHandle Handle, const TLASBuildInstanceData& Data);
+
+    /// Returns the instance data. Use GetInstanceName() to get the instance name.
+    const TLASBuildInstanceData& GetInstance(InstanceHandle Handle) const;
+
+    /// Returns the instance name.
+    const char* GetInstanceName(InstanceHandle Handle) const;
+
+    /// Requests the TLAS to be rebuilt by the next Build() call.
+    void RequestRebuild() { m_RebuildRequired = true; }
+
+    /// Builds or updates the TLAS if any instances have changed since the last call.
+
+    /// \param [in] pContext - Device context.
+    ///
+    /// \return     The type of the operation that has been performed.
+    ///
+    /// \remarks    If there are no instances, the TLAS is not built.
+    BUILD_TYPE Build(IDeviceContext* pContext);
+
+    /// Returns the TLAS, or null if it has not been built yet.
+    ITopLevelAS* GetTLAS() const { return m_pTLAS; }
+
+    /// Returns the number of instances.
+    Uint32 GetInstanceCount() const { return static_cast<Uint32>(m_Instances.size()); }
+
+    /// Returns the number of instances that have been changed since the last build.
+    Uint32 GetNumDirtyInstances() const { return m_NumDirtyInstances; }
+
+private:
+    Uint32 GetSlot(InstanceHandle Handle) const;
+    void   MarkDirty(Uint32 Slot);
+    void   ReserveResources(Uint32 InstanceCount);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const std::string                   m_Name;
+    const TLASInstanceManagerCreateInfo m_CI;
+
+    RefCntAutoPtr<ITopLevelAS> m_pTLAS;
+    RefCntAutoPtr<IBuffer>     m_pInstanceBuffer;
+    RefCntAutoPtr<IBuffer>     m_pScratchBuffer;
+
+    // Dense arrays of instances. m_Instances is passed to BuildTLAS() directly.
+    std::vector<TLASBuildInstanceData>         m_Instances;
+    std::vector<std::string>                   m_InstanceNames;
+    std::vector<RefCntAutoPtr<IBottomLevelAS>> m_InstanceBLASes;
+    std::vector<InstanceHandle>                m_InstanceHandles;
+    std::vector<bool>                          m_DirtyFlags;
+
+    // Handle -> instance slot
+    std::vector<Uint32>         m_HandleSlots;
+    std::vector<InstanceHandle> m_FreeHandles;
+
+    Uint32 m_NumDirtyInstances      = 0;
+    Uint64 m_NumChangesSinceRebuild = 0;
+    bool   m_RebuildRequired        = true;
+};
+
+} // namespace Diligent
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// CPU block compression of texture data
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Common/interface/ThreadPool.h"
+#include "TextureUploader.hpp"
+
+namespace Diligent
+{
+
+/// Block compression quality.
+enum BLOCK_COMPRESSION_QUALITY : Uint8
+{
+    /// Real-time quality: the endpoints are selected from the bounding box of the block colors.
+    BLOCK_COMPRESSION_QUALITY_FAST = 0,
+
+    /// Higher quality: the endpoints are fit to the principal axis of the block colors
+    /// and refined by the least squares method. Several times slower than the fast mode.
+    BLOCK_COMPRESSION_QUALITY_NORMAL,
+};
+
+/// Returns true if CompressTextureData() can produce the given format.
+///
+/// The following formats are supported:
+/// - TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC1_UNORM_SRGB - RGB, alpha is ignored
+/// - TEX_FORMAT_BC3_UNORM, TEX_FORMAT_BC3_UNORM_SRGB - RGBA
+/// - TEX_FORMAT_BC4_UNORM - the red channel
+/// - TEX_FORMAT_BC5_UNORM - the red and green channels
+/// - TEX_FORMAT_BC7_UNORM, TEX_FORMAT_BC7_UNORM_SRGB - RGBA
+bool IsBlockCompressionSupported(TEXTURE_FORMAT Format);
+
+/// Selects the block-compressed format for the uncompressed texture data.
+///
+/// \param [in] pDevice   - Render device whose format support is checked.
+/// \param [in] SrcFormat - Format of the source data: TEX_FORMAT_RGBA8_UNORM or TEX_FORMAT_RGBA8_UNORM_SRGB.
+/// \param [in] HasAlpha  - Whether the alpha channel needs to be preserved.
+/// \param [in] Quality   - Compression quality. BC7 is only selected for the normal quality since
+///                         the fast BC1 and BC3 encoders are considerably faster.
+///
+/// \return     The format supported by both the device and CompressTextureData(), or
+///             TEX_FORMAT_UNKNOWN if there is no such format, in which case the data
+///             should be uploaded uncompressed.
+TEXTURE_FORMAT SelectBlockCompressedFormat(IRenderDevice*            pDevice,
+                                           TEXTURE_FORMAT            SrcFormat,
+                                           bool                      HasAlpha,
+                                           BLOCK_COMPRESSION_QUALITY Quality = BLOCK_COMPRESSION_QUALITY_FAST);
+
+/// Attributes of the CompressTextureData function.
+struct CompressTextureDataAttribs
+{
+    /// Texture width, in texels. Does not need to be a multiple of the block size.
+    Uint32 Width = 0;
+
+    /// Texture height, in texels. Does not need to be a multiple of the block size.
+    Uint32 Height = 0;
+
+    /// Source data in TEX_FORMAT_RGBA8_UNORM or TEX_FORMAT_RGBA8_UNORM_SRGB format.
+    /// The data is compressed as is, so sRGB-encoded data should be compressed to the sRGB format.
+    const void* pSrcData = nullptr;
+
+    /// Source row stride, in bytes.
+    size_t SrcStride = 0;
+
+    /// Destination block-compressed format, see IsBlockCompressionSupported().
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// Destination data.
+    void* pDstData = nullptr;
+
+    /// Destination stride in bytes between the rows of blocks.
+    size_t DstStride = 0;
+
+    /// Compression quality.
+    BLOCK_COMPRESSION_QUALITY Quality = BLOCK_COMPRESSION_QUALITY_FAST;
+
+    /// An optional thread pool to compress the rows of blocks in parallel.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Compresses the texture data into the block-compressed format.
+///
+/// \return     true if the data has been compressed, and false if the input is invalid.
+///
+/// \remarks    The texels of the blocks that extend beyond the texture are replicated from the edge.
+///             The block evaluation uses SSE2 or NEON where available.
+bool CompressTextureData(const CompressTextureDataAttribs& Attribs);
+
+/// Compresses the texture data into the subresource of the upload buffer.
+///
+/// \param [in] pUploadBuffer - Upload buffer allocated by ITextureUploader::AllocateUploadBuffer()
+///                             with the block-compressed format, e.g. the one returned by
+///                             SelectBlockCompressedFormat(). The subresource must be mapped,
+///                             i.e. the function must be called before ITextureUploader::ScheduleGPUCopy().
+/// \param [in] Mip           - Mip level of the upload buffer.
+/// \param [in] Slice         - Array slice of the upload buffer.
+/// \param [in] Attribs       - Compression attributes. Width, Height, DstFormat, pDstData and DstStride
+///                             are ignored and are taken from the upload buffer.
+bool CompressTextureToUploadBuffer(IUploadBuffer*                    pUploadBuffer,
+                                   Uint32                            Mip,
+                                   Uint32                            Slice,
+                                   const CompressTextureDataAttribs& Attribs);
+
+} // namespace Diligent
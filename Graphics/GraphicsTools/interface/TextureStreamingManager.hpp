@@ -0,0 +1,340 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::TextureStreamingManager class
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/ShaderResourceVariable.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Streamed texture mip level loader.
+
+/// The loader must write the texels of the mip level in the texture format to the memory
+/// described by Data, and return true on success.
+/// The loader is called by the thread that calls TextureStreamingManager::Update().
+using StreamedTextureMipLoaderType = std::function<bool(Uint32 MipLevel, const MappedTextureSubresource& Data)>;
+
+/// Streamed texture description, see TextureStreamingManager::RegisterTexture().
+struct StreamedTextureDesc
+{
+    /// Texture name.
+    const char* Name = nullptr;
+
+    /// Width of the most detailed mip level, in texels.
+    Uint32 Width = 0;
+
+    /// Height of the most detailed mip level, in texels.
+    Uint32 Height = 0;
+
+    /// Texture format.
+    TEXTURE_FORMAT Format = TEX_FORMAT_RGBA8_UNORM;
+
+    /// The number of mip levels. If zero, the full mip chain is used.
+    Uint32 MipLevels = 0;
+
+    /// Mip level loader, see Diligent::StreamedTextureMipLoaderType.
+    StreamedTextureMipLoaderType MipLoader;
+};
+
+/// Texture streaming manager create info.
+struct TextureStreamingManagerCreateInfo
+{
+    /// The maximum number of bytes uploaded by one Update() call.
+
+    /// \remarks    At least one mip level is uploaded per call, even if it is larger than the budget.
+    Uint64 UploadBudget = Uint64{16} << 20u;
+
+    /// The maximum total size, in bytes, of the streamed textures.
+
+    /// \remarks    If zero, the limit is derived every frame from the budget of the device-local
+    ///             memory heaps reported by IRenderDevice::GetMemoryStats(), see DeviceBudgetFraction.
+    ///             If the device does not report the budget, the memory is not limited.
+    Uint64 MemoryBudget = 0;
+
+    /// The fraction of the device-local memory budget that the streamed textures may use
+    /// when MemoryBudget is zero.
+    float DeviceBudgetFraction = 0.5f;
+
+    /// Mip levels whose largest dimension does not exceed this value are always resident.
+    Uint32 MaxTailSize = 64;
+
+    /// The number of frames after which a mip request that has not been renewed expires.
+
+    /// \remarks    Textures without active requests only keep their mip tail, and are evicted first.
+    Uint32 RequestLifetime = 8;
+};
+
+/// Texture streaming manager statistics.
+struct TextureStreamingStats
+{
+    /// The number of registered textures.
+    Uint32 NumTextures = 0;
+
+    /// The number of textures that have pending mip requests.
+    Uint32 NumPendingRequests = 0;
+
+    /// The total size, in bytes, of the streamed textures.
+    Uint64 AllocatedMemory = 0;
+
+    /// The memory limit used by the last Update() call.
+    Uint64 MemoryBudget = 0;
+
+    /// The number of bytes uploaded by the last Update() call.
+    Uint64 FrameUploadedBytes = 0;
+
+    /// The total number of bytes uploaded since the manager was created.
+    Uint64 TotalUploadedBytes = 0;
+
+    /// The total number of mip levels uploaded since the manager was created.
+    Uint64 NumLoadedMips = 0;
+
+    /// The total number of mip levels evicted since the manager was created.
+    Uint64 NumEvictedMips = 0;
+
+    /// The total number of mip levels that failed to load.
+    Uint64 NumFailedMips = 0;
+
+    /// The total number of texture reallocations.
+    Uint64 NumReallocations = 0;
+};
+
+/// Texture streaming manager.
+
+/// The manager streams the mip levels of regular 2D textures based on per-texture requests
+/// that contain the desired mip level and the priority, for example the projected screen-space
+/// size of the object that uses the texture. The requests may come from the application or
+/// from the GPU feedback read back by the application.
+///
+/// - Every texture is stored in a texture object that only contains the mip levels starting
+///   from the allocated mip. When a finer mip level is requested, the manager creates a larger
+///   texture and copies the resident mip levels to it. Evicting mip levels works the same way
+///   in the other direction, so the memory of the evicted mips is actually released.
+/// - Requests are processed in priority order. The mip levels are uploaded from coarse to fine
+///   within the per-frame upload budget (UploadBudget), so a texture may be allocated for
+///   more mip levels than are loaded. The texture view (GetView()) only addresses the loaded
+///   mip levels through TextureViewDesc::MostDetailedMip.
+/// - If the total size of the streamed textures would exceed the memory budget, the manager
+///   first evicts the mip levels that are no longer requested, and then the mip levels of the
+///   textures with lower priority than the request being processed.
+/// - Whenever the view of a texture changes, the manager sets it to all shader resource variables
+///   registered with BindVariable(), so shader resource binding objects don't need to be recreated.
+///
+/// The mip levels whose largest dimension does not exceed MaxTailSize are always resident, and
+/// are loaded by the first Update() call after the texture is registered regardless of the budgets.
+///
+/// \note   The class is not thread-safe. Update() must be called by the thread that owns
+///         the device context passed to it.
+class TextureStreamingManager
+{
+public:
+    /// Streamed texture identifier.
+    using TextureId = Uint32;
+
+    /// Invalid texture identifier.
+    static constexpr TextureId InvalidTextureId = 0;
+
+    /// \param[in] pDevice - Render device to create the textures with.
+    /// \param[in] CI      - Create info, see Diligent::TextureStreamingManagerCreateInfo.
+    ///
+    /// \remarks    The constructor throws an exception in case of an error.
+    TextureStreamingManager(IRenderDevice* pDevice, const TextureStreamingManagerCreateInfo& CI);
+    ~TextureStreamingManager();
+
+    // clang-format off
+    TextureStreamingManager           (const TextureStreamingManager&)  = delete;
+    TextureStreamingManager& operator=(const TextureStreamingManager&)  = delete;
+    TextureStreamingManager           (      TextureStreamingManager&&) = delete;
+    TextureStreamingManager& operator=(      TextureStreamingManager&&) = delete;
+    // clang-format on
+
+    /// Registers a streamed texture.
+
+    /// \param[in] Desc - Texture description, see Diligent::StreamedTextureDesc.
+    ///
+    /// \return     The texture identifier, or InvalidTextureId if the description is invalid
+    ///             or the texture could not be created.
+    TextureId RegisterTexture(const StreamedTextureDesc& Desc);
+
+    /// Unregisters the texture and releases its memory.
+    void UnregisterTexture(TextureId Id);
+
+    /// Requests the texture mip level.
+
+    /// \param[in] Id         - Texture identifier.
+    /// \param[in] DesiredMip - The most detailed mip level that should be resident.
+    /// \param[in] Priority   - Request priority, for example the projected screen-space size
+    ///                         of the object. Requests with higher priority are processed first.
+    ///
+    /// \remarks    Multiple requests for the same texture made before the next Update() call are
+    ///             combined: the finest mip level and the highest priority are used.
+    ///             The request must be renewed at least every RequestLifetime frames.
+    void RequestMip(TextureId Id, Uint32 DesiredMip, float Priority);
+
+    /// Sets the texture view to the shader resource variable whenever the view changes.
+
+    /// \param[in] Id         - Texture identifier.
+    /// \param[in] pVariable  - Shader resource variable.
+    /// \param[in] ArrayIndex - Array index of the variable element.
+    ///
+    /// \remarks    The view is set immediately if it exists. The manager keeps a strong
+    ///             reference to the variable (and thus to its shader resource binding object)
+    ///             until UnbindVariable() is called or the texture is unregistered.
+    ///
+    ///             The views are set with SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE flag,
+    ///             so the variables should normally be dynamic. When overwriting a mutable variable
+    ///             in Direct3D12 and Vulkan, the application must ensure that the GPU is not using
+    ///             the shader resource binding object.
+    void BindVariable(TextureId Id, IShaderResourceVariable* pVariable, Uint32 ArrayIndex = 0);
+
+    /// Stops setting the texture view to the shader resource variable.
+    void UnbindVariable(TextureId Id, IShaderResourceVariable* pVariable, Uint32 ArrayIndex = 0);
+
+    /// Processes the mip requests.
+
+    /// \param[in] pContext - Device context to copy and upload the textures with.
+    ///
+    /// \remarks    The method should be called once per frame. All modified textures
+    ///             are transitioned to RESOURCE_STATE_SHADER_RESOURCE state.
+    void Update(IDeviceContext* pContext);
+
+    /// Returns the texture that currently stores the resident mip levels, or null if the
+    /// texture is not registered.
+
+    /// \remarks    The texture object changes when the texture is reallocated, and
+    ///             its mip 0 corresponds to the allocated mip level (GetAllocatedMip()).
+    ITexture* GetTexture(TextureId Id) const;
+
+    /// Returns the shader resource view that addresses the resident mip levels, or null if
+    /// the mip tail has not been loaded yet.
+    ITextureView* GetView(TextureId Id) const;
+
+    /// Returns the most detailed resident mip level of the texture.
+    Uint32 GetResidentMip(TextureId Id) const;
+
+    /// Returns the most detailed mip level that the texture memory is allocated for.
+    Uint32 GetAllocatedMip(TextureId Id) const;
+
+    /// Returns the first mip level of the always resident mip tail.
+    Uint32 GetTailMip(TextureId Id) const;
+
+    /// Returns the manager statistics, see Diligent::TextureStreamingStats.
+    TextureStreamingStats GetStats() const;
+
+private:
+    struct BoundVariable
+    {
+        RefCntAutoPtr<IShaderResourceVariable> pVariable;
+        Uint32                                 ArrayIndex = 0;
+    };
+
+    struct TextureInfo
+    {
+        TextureId   Id = InvalidTextureId;
+        std::string Name;
+        TextureDesc Desc;
+
+        StreamedTextureMipLoaderType MipLoader;
+
+        // Size of every mip level, and the total size of the mip levels starting from the given one.
+        std::vector<Uint64> MipSizes;
+        std::vector<Uint64> AllocSizes;
+
+        Uint32 TailMip      = 0;
+        Uint32 AllocatedMip = 0;
+        // The number of mip levels if no mip level has been loaded.
+        Uint32 ResidentMip = 0;
+        // Mip levels finer than this one failed to load and are not requested again.
+        Uint32 MinLoadableMip = 0;
+
+        Uint32 DesiredMip       = 0;
+        float  Priority         = 0;
+        Uint64 LastRequestFrame = 0;
+
+        RefCntAutoPtr<ITexture>     pTexture;
+        RefCntAutoPtr<ITextureView> pView;
+
+        std::vector<BoundVariable> Variables;
+
+        bool IsModified = false;
+    };
+
+    TextureInfo*       FindTexture(TextureId Id);
+    const TextureInfo* FindTexture(TextureId Id) const;
+
+    bool   IsValidAllocationMip(const TextureInfo& Tex, Uint32 Mip) const;
+    void   UpdateMemoryBudget();
+    void   LoadTail(IDeviceContext* pContext, TextureInfo& Tex);
+    bool   StreamIn(IDeviceContext* pContext, TextureInfo& Tex);
+    bool   LoadMip(IDeviceContext* pContext, TextureInfo& Tex, Uint32 Mip);
+    bool   Reallocate(IDeviceContext* pContext, TextureInfo& Tex, Uint32 AllocatedMip);
+    Uint64 FreeMemory(IDeviceContext* pContext, Uint64 Size, float Priority, const TextureInfo* pExclude);
+    void   UpdateView(TextureInfo& Tex);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const Uint64 m_UploadBudget;
+    const Uint64 m_MemoryBudgetOverride;
+    const float  m_DeviceBudgetFraction;
+    const Uint32 m_MaxTailSize;
+    const Uint32 m_RequestLifetime;
+
+    std::unordered_map<TextureId, TextureInfo> m_Textures;
+    TextureId                                  m_NextTextureId = 1;
+
+    // Textures whose mip tail has not been loaded yet.
+    std::vector<TextureId> m_NewTextures;
+
+    std::vector<TextureInfo*> m_SortedTextures;
+    std::vector<Uint8>        m_LoadData;
+
+    Uint64 m_FrameIndex = 0;
+
+    Uint64 m_AllocatedMemory    = 0;
+    Uint64 m_MemoryBudget       = ~Uint64{0};
+    Uint64 m_FrameUploadedBytes = 0;
+    Uint64 m_TotalUploadedBytes = 0;
+    Uint64 m_NumLoadedMips      = 0;
+    Uint64 m_NumEvictedMips     = 0;
+    Uint64 m_NumFailedMips      = 0;
+    Uint64 m_NumReallocations   = 0;
+};
+
+} // namespace Diligent
@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 
@@ -66,13 +68,45 @@ public:
 /// Texture uploader description.
 struct TextureUploaderDesc
 {
+    /// Whether to map recycled upload buffers in advance.
+
+    /// When this flag is set, RenderThreadUpdate() maps the recycled upload buffers whose
+    /// previous copy has completed on the GPU, so that AllocateUploadBuffer() called by a worker
+    /// thread can return one immediately instead of waiting for the render thread.
+    ///
+    /// \remarks    Supported by Direct3D12, Vulkan and OpenGL backends. In Direct3D12 and Vulkan,
+    ///             staging textures stay mapped at no extra cost. In OpenGL, the pixel unpack buffers
+    ///             are mapped without synchronization once a fence indicates that the copy from them
+    ///             has completed. Other backends ignore this flag.
+    bool PremapRecycledBuffers = false;
 };
 
 
 /// Texture uploader statistics.
 struct TextureUploaderStats
 {
+    /// The number of operations waiting to be executed by the render thread.
     Uint32 NumPendingOperations = 0;
+
+    /// The total number of staging buffers created by the uploader.
+    Uint32 NumStagingBuffers = 0;
+
+    /// The number of staging buffers that are available for reuse.
+    Uint32 NumFreeStagingBuffers = 0;
+
+    /// The total size of all staging buffers, in bytes.
+    Uint64 StagingMemorySize = 0;
+
+    /// The total number of bytes scheduled for GPU copy since the uploader was created.
+    Uint64 TotalBytesUploaded = 0;
+
+    /// The number of bytes scheduled for GPU copy per second, measured
+    /// over the time interval since the previous GetStats() call.
+    float BytesPerSecond = 0;
+
+    /// The total time, in seconds, worker threads spent in AllocateUploadBuffer()
+    /// waiting for the render thread to map the upload buffer.
+    double TotalStallTime = 0;
 };
 
 /// Asynchronous texture uploader
@@ -80,6 +114,11 @@ class ITextureUploader : public IObject
 {
 public:
     /// Executes pending render-thread operations
+
+    /// \remarks   All copy operations scheduled by the worker threads since the previous call are
+    ///             recorded into pContext together. pContext may be an immediate context that runs
+    ///             on a transfer queue (see Diligent::COMMAND_QUEUE_TYPE_TRANSFER), in which case the
+    ///             application is responsible for synchronizing the queue with the graphics queue.
     virtual void RenderThreadUpdate(IDeviceContext* pContext) = 0;
 
 
@@ -146,4 +185,50 @@ public:
 
 void CreateTextureUploader(IRenderDevice* pDevice, const TextureUploaderDesc& Desc, ITextureUploader** ppUploader);
 
+
+class AsyncFileReader;
+
+/// Location of the upload buffer subresource data in a file.
+struct UploadBufferFileRegion
+{
+    /// Upload buffer mip level.
+    Uint32 Mip = 0;
+
+    /// Upload buffer array slice.
+    Uint32 Slice = 0;
+
+    /// Offset of the subresource data in the file, in bytes.
+    Uint64 Offset = 0;
+
+    /// Row stride in the file, in bytes. For compressed formats, the stride
+    /// of the rows of blocks. If zero, the rows are tightly packed.
+    Uint64 Stride = 0;
+
+    /// Depth slice stride in the file, in bytes. If zero, the depth slices are tightly packed.
+    Uint64 DepthStride = 0;
+};
+
+/// Reads the upload buffer subresources from the file directly into the mapped memory.
+
+/// \param [in] Reader        - File reader.
+/// \param [in] pUploadBuffer - Upload buffer to read the data to.
+/// \param [in] pRegions      - Subresources to read and their locations in the file.
+/// \param [in] NumRegions    - The number of elements in pRegions array.
+/// \param [in] Callback      - Function that is called once all reads have completed.
+///                             Success is true if all data has been read.
+///
+/// \remarks   The data is read by the file reader without intermediate copies. When the row stride
+///            in the file matches the stride of the mapped subresource, every subresource is read with
+///            a single request; otherwise every row is read separately.
+///
+///            The function keeps a reference to the upload buffer until the callback returns.
+///            The callback is called from the reader's internal thread and should not block,
+///            e.g. by calling ITextureUploader::ScheduleGPUCopy() that waits for the render thread.
+///            Instead, it should notify the thread that schedules the copy.
+void ReadUploadBufferFromFile(AsyncFileReader&                  Reader,
+                              IUploadBuffer*                    pUploadBuffer,
+                              const UploadBufferFileRegion*     pRegions,
+                              Uint32                            NumRegions,
+                              std::function<void(bool Success)> Callback);
+
 } // namespace Diligent
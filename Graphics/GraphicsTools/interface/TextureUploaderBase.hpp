@@ -28,11 +28,14 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
+#include <mutex>
 
 #include "TextureUploader.hpp"
 #include "../../../Common/interface/ObjectBase.hpp"
 #include "../../../Common/interface/HashUtils.hpp"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/Timer.hpp"
 
 namespace std
 {
@@ -97,11 +100,47 @@ class TextureUploaderBase : public ObjectBase<ITextureUploader>
 public:
     TextureUploaderBase(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
         ObjectBase<ITextureUploader>{pRefCounters},
-        m_pDevice{pDevice}
+        m_pDevice{pDevice},
+        m_Desc{Desc}
     {}
 
+protected:
+    // Returns the total size of all subresources of the upload buffer.
+    static Uint64 GetUploadBufferDataSize(const UploadBufferDesc& Desc);
+
+    void OnStagingBufferCreated(const UploadBufferDesc& Desc)
+    {
+        m_NumStagingBuffers.fetch_add(1);
+        m_StagingMemorySize.fetch_add(GetUploadBufferDataSize(Desc));
+    }
+
+    void OnCopyScheduled(const UploadBufferDesc& Desc)
+    {
+        m_TotalBytesUploaded.fetch_add(GetUploadBufferDataSize(Desc));
+    }
+
+    void OnWorkerStall(double Duration)
+    {
+        m_TotalStallTimeUs.fetch_add(static_cast<Uint64>(Duration * 1e+6));
+    }
+
+    // Fills the statistics that are common for all backends.
+    void GetCommonStats(TextureUploaderStats& Stats);
+
 protected:
     RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const TextureUploaderDesc m_Desc;
+
+private:
+    std::atomic<Uint32> m_NumStagingBuffers{0};
+    std::atomic<Uint64> m_StagingMemorySize{0};
+    std::atomic<Uint64> m_TotalBytesUploaded{0};
+    std::atomic<Uint64> m_TotalStallTimeUs{0};
+
+    std::mutex m_RateMtx;
+    Timer      m_RateTimer;
+    Uint64     m_RateBytesUploaded = 0;
 };
 
 } // namespace Diligent
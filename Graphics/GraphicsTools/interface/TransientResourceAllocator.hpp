@@ -0,0 +1,197 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::TransientResourceAllocator class
+
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/DeviceMemory.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Transient resource allocator create info.
+struct TransientResourceAllocatorCreateInfo
+{
+    /// Prefix of the names of the device memory objects the resources are aliased in; it also
+    /// identifies the allocator in log messages. Transient resources keep the names from their
+    /// descriptions. If null, "Transient resource allocator" is used.
+    const char* Name = nullptr;
+
+    /// Whether to place resources with non-overlapping lifetimes into shared memory.
+    /// If false, or if the device does not support aliased sparse resources,
+    /// the allocator only reuses resources with identical descriptions.
+    bool EnableAliasing = true;
+};
+
+/// Allocates short-lived resources so that resources whose lifetimes do not overlap share memory.
+
+/// The application adds resource descriptions together with the indices of the first and the last
+/// use (e.g. pass indices) and calls Allocate(). The allocator then
+///  - on Direct3D12 and Vulkan devices that support aliased sparse resources, creates sparse
+///    resources and packs their memory into one memory object per resource kind (textures and buffers),
+///    so that resources with non-overlapping lifetimes occupy the same memory range;
+///  - on other devices, or for resources that can't be sparse, creates regular resources and reuses
+///    the resource object for resources with identical descriptions and non-overlapping lifetimes.
+///
+/// \remarks    The contents of an aliased resource are undefined at its first use: the application must
+///             fully overwrite it, e.g. by clearing or discarding it, and issue the barriers returned by
+///             GetAliasingBarriers() before the resource is used.
+///
+/// \note   The class is not thread-safe.
+class TransientResourceAllocator
+{
+public:
+    TransientResourceAllocator(IRenderDevice* pDevice, const TransientResourceAllocatorCreateInfo& CI);
+    ~TransientResourceAllocator();
+
+    // clang-format off
+    TransientResourceAllocator           (const TransientResourceAllocator&)  = delete;
+    TransientResourceAllocator& operator=(const TransientResourceAllocator&)  = delete;
+    TransientResourceAllocator           (      TransientResourceAllocator&&) = delete;
+    TransientResourceAllocator& operator=(      TransientResourceAllocator&&) = delete;
+    // clang-format on
+
+    /// Adds a texture and returns its index.
+
+    /// \param[in] Desc     - Texture description. The texture usage must be USAGE_DEFAULT.
+    /// \param[in] FirstUse - Index of the first use of the texture.
+    /// \param[in] LastUse  - Index of the last use of the texture. Must be greater than or equal to FirstUse.
+    Uint32 AddTexture(const TextureDesc& Desc, Uint32 FirstUse, Uint32 LastUse);
+
+    /// Adds a buffer and returns its index, see AddTexture().
+    Uint32 AddBuffer(const BufferDesc& Desc, Uint32 FirstUse, Uint32 LastUse);
+
+    /// Creates the resources and binds the memory.
+
+    /// \param[in] pContext - Device context that is used to bind the sparse resource memory.
+    ///
+    /// \return     true if all resources have been created successfully, and false otherwise.
+    ///
+    /// \remarks    The resources created by the previous call are released.
+    bool Allocate(IDeviceContext* pContext);
+
+    /// Returns the texture with the given index. Allocate() must be called first.
+    ITexture* GetTexture(Uint32 Index) const;
+
+    /// Returns the buffer with the given index. Allocate() must be called first.
+    IBuffer* GetBuffer(Uint32 Index) const;
+
+    /// Appends the aliasing barriers that must be issued before the resources whose first use is UseIndex.
+
+    /// For every such resource that shares memory with a resource used earlier, the method adds
+    /// an aliasing transition from the last of those resources.
+    void GetAliasingBarriers(Uint32 UseIndex, std::vector<StateTransitionDesc>& Barriers) const;
+
+    /// Releases all resources and memory and removes all resource descriptions.
+    void Reset();
+
+    /// Returns true if the allocator places resources into shared memory on this device.
+    bool IsAliasingSupported() const { return m_AliasingSupported; }
+
+    struct Statistics
+    {
+        /// The number of resources added to the allocator.
+        Uint32 NumResources = 0;
+
+        /// The number of resources placed into shared memory.
+        Uint32 NumAliasedResources = 0;
+
+        /// The number of regular resource objects created for the resources that are not aliased.
+        Uint32 NumPooledObjects = 0;
+
+        /// The total memory size the aliased resources would require without aliasing.
+        Uint64 AliasedResourcesSize = 0;
+
+        /// The total size of the memory objects allocated for the aliased resources.
+        Uint64 MemorySize = 0;
+    };
+
+    /// Returns the allocation statistics.
+    const Statistics& GetStatistics() const { return m_Stats; }
+
+private:
+    struct ResourceInfo
+    {
+        bool        IsTexture = true;
+        std::string Name;
+        TextureDesc TexDesc;
+        BufferDesc  BuffDesc;
+
+        Uint32 FirstUse = 0;
+        Uint32 LastUse  = 0;
+
+        RefCntAutoPtr<IDeviceObject> pObject;
+
+        // Memory range of the aliased resource
+        bool   IsAliased    = false;
+        Uint64 MemoryOffset = 0;
+        Uint64 MemorySize   = 0;
+        Uint32 Alignment    = 0;
+
+        bool OverlapsInTime(const ResourceInfo& Other) const
+        {
+            return FirstUse <= Other.LastUse && Other.FirstUse <= LastUse;
+        }
+
+        bool OverlapsInMemory(const ResourceInfo& Other) const
+        {
+            return MemoryOffset < Other.MemoryOffset + Other.MemorySize && Other.MemoryOffset < MemoryOffset + MemorySize;
+        }
+    };
+
+    bool   CanAlias(const ResourceInfo& Res) const;
+    bool   CreateSparseResource(ResourceInfo& Res);
+    Uint64 PackResources(const std::vector<Uint32>& Resources);
+    bool   CreateMemory(const std::vector<Uint32>& Resources, Uint64 Size, const char* Kind, RefCntAutoPtr<IDeviceMemory>& pMemory);
+    void   BindMemory(IDeviceContext* pContext);
+    bool   CreatePooledResources(const std::vector<Uint32>& Resources);
+
+private:
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    const std::string m_Name;
+
+    bool m_AliasingSupported = false;
+
+    std::vector<ResourceInfo> m_Resources;
+
+    RefCntAutoPtr<IDeviceMemory> m_pTextureMemory;
+    RefCntAutoPtr<IDeviceMemory> m_pBufferMemory;
+
+    Statistics m_Stats;
+};
+
+} // namespace Diligent
@@ -259,6 +259,36 @@ struct IVertexPool : public IObject
 
     /// Returns the pool description.
     virtual const VertexPoolDesc& GetDesc() const = 0;
+
+
+    /// Moves allocations towards the beginning of the pool to reduce fragmentation.
+
+    /// \param[in]  pDevice        - A pointer to the render device that will be used to create
+    ///                              the intermediate copy buffer, if necessary.
+    /// \param[in]  pContext       - A pointer to the device context that will be used to
+    ///                              record copy commands.
+    /// \param[in]  MaxBytesToMove - The maximum number of bytes to move during this call,
+    ///                              across all internal buffers.
+    ///
+    /// \return     The number of bytes moved.
+    ///
+    /// \remarks    The method performs one incremental compaction step and is intended to be
+    ///             called once per frame with a bounded budget. Every allocation that can be
+    ///             moved to a lower free range is copied through an intermediate buffer using
+    ///             pContext, after which its start vertex (see IVertexPoolAllocation::GetStartVertex())
+    ///             is updated and the old range is released. All commands recorded in pContext after
+    ///             this call observe the new layout, so the new start vertices can be used immediately.
+    ///             When at least one allocation is moved, the layout version (see GetLayoutVersion())
+    ///             is incremented so that the application can rebuild the data that stores start
+    ///             vertices, such as indirect draw arguments.
+    ///
+    ///             The method must be called from the same thread as Update(). Allocating and
+    ///             releasing vertices in other threads at the same time is safe.
+    virtual Uint64 Defragment(IRenderDevice* pDevice, IDeviceContext* pContext, Uint64 MaxBytesToMove) = 0;
+
+    /// Returns the layout version. The version is incremented every time
+    /// Defragment() changes the start vertex of at least one allocation.
+    virtual Uint32 GetLayoutVersion() const = 0;
 };
 
 
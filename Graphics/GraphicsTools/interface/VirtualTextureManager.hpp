@@ -0,0 +1,357 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::VirtualTextureManager class
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.h"
+#include "TextureUploader.hpp"
+
+namespace Diligent
+{
+
+/// Virtual texture tile.
+struct VirtualTextureTile
+{
+    /// Tile column at the mip level.
+    Uint32 X = 0;
+
+    /// Tile row at the mip level.
+    Uint32 Y = 0;
+
+    /// Mip level of the tile.
+    Uint32 MipLevel = 0;
+
+    constexpr bool operator==(const VirtualTextureTile& RHS) const
+    {
+        return X == RHS.X && Y == RHS.Y && MipLevel == RHS.MipLevel;
+    }
+};
+
+/// Virtual texture tile loader.
+
+/// The loader must write TileSize x TileSize texels of the tile in the virtual texture format
+/// to the memory described by Data, and return true on success.
+/// If VirtualTextureManagerCreateInfo::pThreadPool is not null, the loader is called by the
+/// thread pool threads and must be thread-safe.
+using VirtualTextureTileLoaderType = std::function<bool(const VirtualTextureTile& Tile, const MappedTextureSubresource& Data)>;
+
+/// Virtual texture manager create info.
+struct VirtualTextureManagerCreateInfo
+{
+    /// Virtual texture name.
+    const char* Name = nullptr;
+
+    /// Virtual texture width, in texels.
+    Uint32 Width = 0;
+
+    /// Virtual texture height, in texels.
+    Uint32 Height = 0;
+
+    /// Tile size, in texels.
+
+    /// \remarks    Width / TileSize and Height / TileSize must be powers of two
+    ///             not greater than 4096.
+    Uint32 TileSize = 128;
+
+    /// Texel format of the virtual texture.
+    TEXTURE_FORMAT Format = TEX_FORMAT_RGBA8_UNORM;
+
+    /// The number of tiles in the physical page cache.
+
+    /// \remarks    The physical cache is a texture array with one TileSize x TileSize slice per page,
+    ///             so this value also defines the fixed amount of video memory used by the
+    ///             virtual texture. It must not exceed the maximum number of texture array slices.
+    Uint32 NumPhysicalPages = 256;
+
+    /// The maximum number of tiles whose loading is started by one Update() call.
+    Uint32 MaxLoadsPerFrame = 16;
+
+    /// The maximum number of tiles that may be loading at the same time.
+    Uint32 MaxPendingLoads = 64;
+
+    /// The number of entries in the GPU feedback buffer, see VirtualTextureManager::GetFeedbackBuffer().
+    /// If zero, the feedback buffer is not created and the application must provide the feedback
+    /// through VirtualTextureManager::AnalyzeFeedback().
+    Uint32 FeedbackBufferSize = 0;
+
+    /// The number of frames between writing the GPU feedback and reading it back on the CPU.
+    Uint32 FeedbackLatency = 2;
+
+    /// An optional thread pool used to run the tile loader.
+    /// If null, tiles are loaded by the thread that calls Update().
+    IThreadPool* pThreadPool = nullptr;
+
+    /// An optional texture uploader to upload the tiles with.
+    /// If null, the manager creates its own uploader.
+    ITextureUploader* pUploader = nullptr;
+
+    /// Tile loader, see Diligent::VirtualTextureTileLoaderType.
+    VirtualTextureTileLoaderType TileLoader;
+};
+
+/// Virtual texture manager statistics.
+struct VirtualTextureStats
+{
+    /// The number of tiles resident in the physical cache.
+    Uint32 NumResidentTiles = 0;
+
+    /// The number of tiles that are currently being loaded.
+    Uint32 NumPendingLoads = 0;
+
+    /// The number of non-resident tiles requested by the last feedback.
+    Uint32 NumRequestedTiles = 0;
+
+    /// The total number of tiles loaded since the manager was created.
+    Uint64 NumLoadedTiles = 0;
+
+    /// The total number of tiles evicted from the physical cache.
+    Uint64 NumEvictedTiles = 0;
+
+    /// The total number of tiles that failed to load.
+    Uint64 NumFailedTiles = 0;
+};
+
+/// Streaming virtual texture manager.
+
+/// The manager keeps the tiles of a large virtual texture in a fixed-size physical
+/// page cache and streams the tiles requested by the GPU feedback:
+///
+/// - The shader that samples the virtual texture determines the tile and mip level it needs,
+///   and writes the tile encoded with EncodeFeedback() to the feedback buffer
+///   (RWStructuredBuffer<uint>, see GetFeedbackBuffer()), typically at a reduced
+///   resolution, e.g. Feedback[(Pixel.y * Width + Pixel.x) % FeedbackBufferSize].
+/// - Update() reads the feedback back with a latency of FeedbackLatency frames,
+///   starts loading the missing tiles within the per-frame budget, uploads the loaded tiles
+///   to the physical cache through the texture uploader, evicts the least recently
+///   used tiles when the cache is full, and updates the page table.
+/// - The page table (GetPageTable()) is an R32_UINT texture with one texel per tile and one
+///   mip level per virtual texture mip level. Every texel contains the entry encoded with
+///   EncodePageTableEntry() for the finest resident tile that covers it: the physical cache
+///   slice in the low 16 bits and the mip level of the resident tile in the bits 16..23.
+///   The texel coordinates within the physical page are computed as
+///   frac(UV * TilesAtMip(ResidentMip)) * TileSize. Entries of the regions that have
+///   no resident tiles yet contain InvalidPageTableEntry.
+///
+/// The single tile of the coarsest mip level is always requested and is never evicted,
+/// so every region falls back to it once it is loaded.
+///
+/// \note   The class is not thread-safe. Update() and AnalyzeFeedback() must be called
+///         by the same thread, which must own the device context passed to Update().
+class VirtualTextureManager
+{
+public:
+    /// \param[in] pDevice - Render device to create the resources with.
+    /// \param[in] CI      - Create info, see Diligent::VirtualTextureManagerCreateInfo.
+    ///
+    /// \remarks    The constructor throws an exception in case of an error.
+    VirtualTextureManager(IRenderDevice* pDevice, const VirtualTextureManagerCreateInfo& CI);
+    ~VirtualTextureManager();
+
+    // clang-format off
+    VirtualTextureManager           (const VirtualTextureManager&)  = delete;
+    VirtualTextureManager& operator=(const VirtualTextureManager&)  = delete;
+    VirtualTextureManager           (      VirtualTextureManager&&) = delete;
+    VirtualTextureManager& operator=(      VirtualTextureManager&&) = delete;
+    // clang-format on
+
+    /// Feedback value that does not request any tile.
+    static constexpr Uint32 InvalidFeedback = ~0u;
+
+    /// Page table entry of a region that has no resident tiles.
+    static constexpr Uint32 InvalidPageTableEntry = ~0u;
+
+    /// Encodes the tile for the feedback buffer.
+    static constexpr Uint32 EncodeFeedback(const VirtualTextureTile& Tile)
+    {
+        return (Tile.MipLevel << 24u) | (Tile.Y << 12u) | Tile.X;
+    }
+
+    /// Decodes the tile from the feedback value.
+    static VirtualTextureTile DecodeFeedback(Uint32 Feedback)
+    {
+        VirtualTextureTile Tile;
+        Tile.X        = Feedback & 0xFFFu;
+        Tile.Y        = (Feedback >> 12u) & 0xFFFu;
+        Tile.MipLevel = Feedback >> 24u;
+        return Tile;
+    }
+
+    /// Encodes the page table entry.
+    static constexpr Uint32 EncodePageTableEntry(Uint32 PhysicalPage, Uint32 MipLevel)
+    {
+        return (MipLevel << 16u) | PhysicalPage;
+    }
+
+    /// Adds the feedback values to the tile requests processed by the next Update() call.
+
+    /// \param[in] pFeedback  - Feedback values encoded with EncodeFeedback().
+    ///                         InvalidFeedback values and out-of-range tiles are ignored.
+    /// \param[in] NumEntries - The number of values in pFeedback.
+    ///
+    /// \remarks    The resident tiles referenced by the feedback are marked as recently used.
+    ///             The method is called by Update() for the GPU feedback buffer, and may be
+    ///             used by the application to provide additional feedback.
+    void AnalyzeFeedback(const Uint32* pFeedback, size_t NumEntries);
+
+    /// Updates the tile residency.
+
+    /// \param[in] pContext - Device context to read back the feedback, upload
+    ///                       the tiles and update the page table.
+    ///
+    /// \remarks    The method should be called once per frame after the commands that
+    ///             write the feedback buffer have been recorded.
+    void Update(IDeviceContext* pContext);
+
+    /// Returns the physical page cache texture (2D texture array).
+    ITexture* GetPhysicalCache() const { return m_pPhysicalCache; }
+
+    /// Returns the page table texture.
+    ITexture* GetPageTable() const { return m_pPageTable; }
+
+    /// Returns the GPU feedback buffer, or null if VirtualTextureManagerCreateInfo::FeedbackBufferSize is zero.
+
+    /// \remarks    The buffer is filled with InvalidFeedback by Update().
+    IBuffer* GetFeedbackBuffer() const { return m_pFeedbackBuffer; }
+
+    /// Returns the number of mip levels of the virtual texture.
+    Uint32 GetNumMipLevels() const { return static_cast<Uint32>(m_PageTable.size()); }
+
+    /// Returns the number of tile columns at the given mip level.
+    Uint32 GetNumTilesX(Uint32 MipLevel) const { return std::max(m_NumTilesX >> MipLevel, 1u); }
+
+    /// Returns the number of tile rows at the given mip level.
+    Uint32 GetNumTilesY(Uint32 MipLevel) const { return std::max(m_NumTilesY >> MipLevel, 1u); }
+
+    /// Returns the CPU copy of the page table entry for the given tile.
+    Uint32 GetPageTableEntry(const VirtualTextureTile& Tile) const;
+
+    /// Returns true if the tile is resident in the physical cache.
+    bool IsTileResident(const VirtualTextureTile& Tile) const;
+
+    /// Returns the manager statistics, see Diligent::VirtualTextureStats.
+    VirtualTextureStats GetStats() const;
+
+private:
+    struct TileLoadRequest;
+
+    bool IsValidTile(const VirtualTextureTile& Tile) const;
+
+    void   ReadBackFeedback(IDeviceContext* pContext);
+    void   StartLoads(IDeviceContext* pContext);
+    void   FinishLoads(IDeviceContext* pContext);
+    Uint32 AllocatePhysicalPage();
+    void   EvictTile(Uint32 Page);
+    void   UpdatePageTable(const VirtualTextureTile& Tile);
+    void   UploadPageTable(IDeviceContext* pContext);
+
+    static void LoadTile(TileLoadRequest& Request, const VirtualTextureTileLoaderType& Loader);
+
+private:
+    const std::string m_Name;
+
+    const Uint32         m_TileSize;
+    const TEXTURE_FORMAT m_Format;
+    const Uint32         m_NumTilesX;
+    const Uint32         m_NumTilesY;
+    const Uint32         m_MaxLoadsPerFrame;
+    const Uint32         m_MaxPendingLoads;
+
+    VirtualTextureTileLoaderType m_TileLoader;
+
+    RefCntAutoPtr<IThreadPool>      m_pThreadPool;
+    RefCntAutoPtr<ITextureUploader> m_pUploader;
+
+    RefCntAutoPtr<ITexture> m_pPhysicalCache;
+    RefCntAutoPtr<ITexture> m_pPageTable;
+
+    // CPU copy of the page table, one vector per mip level.
+    std::vector<std::vector<Uint32>> m_PageTable;
+    // Dirty region of every page table mip level.
+    std::vector<Box> m_DirtyRegions;
+
+    struct PhysicalPage
+    {
+        // Encoded tile that occupies the page, or InvalidFeedback if the page is free.
+        Uint32 Tile = InvalidFeedback;
+
+        // The frame when the tile was last requested by the feedback.
+        Uint64 LastUsedFrame = 0;
+
+        // Whether the page is being loaded.
+        bool IsLoading = false;
+
+        // Whether the page must never be evicted.
+        bool IsPinned = false;
+    };
+    std::vector<PhysicalPage> m_PhysicalPages;
+    std::vector<Uint32>       m_FreePages;
+
+    // Resident tiles: encoded tile -> physical page.
+    std::unordered_map<Uint32, Uint32> m_ResidentTiles;
+    // Tiles that are being loaded.
+    std::unordered_set<Uint32> m_LoadingTiles;
+    // Tiles that failed to load. They are not requested again.
+    std::unordered_set<Uint32> m_FailedTiles;
+
+    // Non-resident tiles requested by the feedback since the last Update(): encoded tile -> request count.
+    std::unordered_map<Uint32, Uint32> m_RequestedTiles;
+    Uint32                             m_NumRequestedTiles = 0;
+
+    std::vector<std::unique_ptr<TileLoadRequest>> m_PendingLoads;
+
+    RefCntAutoPtr<IBuffer>              m_pFeedbackBuffer;
+    std::vector<Uint32>                 m_FeedbackClearData;
+    std::vector<RefCntAutoPtr<IBuffer>> m_FeedbackReadbackBuffers;
+    std::vector<Uint64>                 m_FeedbackReadbackFenceValues;
+    RefCntAutoPtr<IFence>               m_pFeedbackFence;
+    Uint64                              m_NextFeedbackFenceValue = 1;
+    Uint32                              m_NextFeedbackReadback   = 0;
+
+    Uint64 m_FrameIndex = 1;
+
+    Uint64 m_NumLoadedTiles  = 0;
+    Uint64 m_NumEvictedTiles = 0;
+    Uint64 m_NumFailedTiles  = 0;
+};
+
+} // namespace Diligent
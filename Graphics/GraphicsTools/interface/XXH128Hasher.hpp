@@ -123,6 +123,21 @@ struct XXH128State final
 
     void Update(const ShaderCreateInfo& ShaderCI) noexcept;
 
+    /// Updates the hash with the shader create info using the precomputed hash
+    /// of the shader source instead of reading and hashing the source.
+
+    /// \param [in] ShaderCI   - Shader create info.
+    /// \param [in] SourceHash - Hash of the shader source, see ComputeShaderSourceHash().
+    ///
+    /// \remarks   This allows hashing several permutations of the same shader
+    ///            (e.g. with different macros) without processing the source
+    ///            and all its include files every time.
+    void Update(const ShaderCreateInfo& ShaderCI, const XXH128Hash& SourceHash) noexcept;
+
+    /// Computes the hash of the shader source including all include files,
+    /// or of the shader byte code if the source is not specified.
+    static XXH128Hash ComputeShaderSourceHash(const ShaderCreateInfo& ShaderCI) noexcept;
+
     template <typename T>
     typename std::enable_if<(std::is_same<typename std::remove_cv<T>::type, SamplerDesc>::value ||
                              std::is_same<typename std::remove_cv<T>::type, StencilOpDesc>::value ||
@@ -130,6 +145,7 @@ struct XXH128State final
                              std::is_same<typename std::remove_cv<T>::type, RasterizerStateDesc>::value ||
                              std::is_same<typename std::remove_cv<T>::type, BlendStateDesc>::value ||
                              std::is_same<typename std::remove_cv<T>::type, TextureViewDesc>::value ||
+                             std::is_same<typename std::remove_cv<T>::type, BufferViewDesc>::value ||
                              std::is_same<typename std::remove_cv<T>::type, SampleDesc>::value ||
                              std::is_same<typename std::remove_cv<T>::type, ShaderResourceVariableDesc>::value ||
                              std::is_same<typename std::remove_cv<T>::type, ImmutableSamplerDesc>::value ||
@@ -0,0 +1,218 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "AsyncComputeQueue.hpp"
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+AsyncComputeQueue::AsyncComputeQueue(IRenderDevice* pDevice, IDeviceContext* pComputeContext) :
+    m_pDevice{pDevice},
+    m_pComputeContext{pComputeContext}
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("pDevice must not be null");
+    if (pComputeContext == nullptr)
+        LOG_ERROR_AND_THROW("pComputeContext must not be null");
+
+    const DeviceContextDesc& CtxDesc = pComputeContext->GetDesc();
+    if (CtxDesc.IsDeferred)
+        LOG_ERROR_AND_THROW("Context '", CtxDesc.Name, "' is deferred. Asynchronous compute requires an immediate context");
+    if ((CtxDesc.QueueType & COMMAND_QUEUE_TYPE_COMPUTE) != COMMAND_QUEUE_TYPE_COMPUTE)
+        LOG_ERROR_AND_THROW("Context '", CtxDesc.Name, "' does not support compute commands");
+
+    FenceDesc Desc;
+    Desc.Name = "Async compute queue fence";
+    Desc.Type = FENCE_TYPE_GENERAL;
+    pDevice->CreateFence(Desc, &m_pFence);
+    if (!m_pFence)
+        LOG_ERROR_AND_THROW("Failed to create async compute queue fence");
+}
+
+AsyncComputeQueue::~AsyncComputeQueue()
+{
+}
+
+IFence* AsyncComputeQueue::GetSourceFence(IDeviceContext* pSrcContext, Uint64& Value)
+{
+    const Uint32 ContextId = pSrcContext->GetDesc().ContextId;
+    if (ContextId >= m_SourceFences.size())
+        m_SourceFences.resize(ContextId + 1);
+
+    // Every source context needs its own fence as the values signaled by
+    // different queues would not be monotonic.
+    SourceFence& Fence = m_SourceFences[ContextId];
+    if (!Fence.pFence)
+    {
+        FenceDesc Desc;
+        Desc.Name = "Async compute queue source fence";
+        Desc.Type = FENCE_TYPE_GENERAL;
+        m_pDevice->CreateFence(Desc, &Fence.pFence);
+        if (!Fence.pFence)
+        {
+            LOG_ERROR_MESSAGE("Failed to create async compute queue source fence");
+            return nullptr;
+        }
+    }
+
+    Value = ++Fence.Value;
+    return Fence.pFence;
+}
+
+AsyncComputeToken AsyncComputeQueue::Submit(IDeviceContext* pSrcContext, const AsyncComputeJob& Job)
+{
+    if (Job.pPSO == nullptr || Job.pPSO->GetDesc().PipelineType != PIPELINE_TYPE_COMPUTE)
+    {
+        DEV_ERROR("Job '", (Job.Name != nullptr ? Job.Name : ""), "' must use a compute pipeline");
+        return {};
+    }
+    if (Job.NumDispatches != 0 && Job.pDispatches == nullptr)
+    {
+        DEV_ERROR("pDispatches must not be null");
+        return {};
+    }
+    if (Job.NumResources != 0 && Job.pResources == nullptr)
+    {
+        DEV_ERROR("pResources must not be null");
+        return {};
+    }
+
+    if (pSrcContext == m_pComputeContext)
+        pSrcContext = nullptr;
+
+    if (pSrcContext != nullptr && pSrcContext->GetDesc().IsDeferred)
+    {
+        DEV_ERROR("Source context '", pSrcContext->GetDesc().Name, "' must be an immediate context");
+        return {};
+    }
+
+    // Transition the resources by the context that produced them: it supports all the states
+    // the resources may be in, while the compute queue may not.
+    IDeviceContext* const pTransitionCtx = pSrcContext != nullptr ? pSrcContext : m_pComputeContext.RawPtr();
+#ifdef DILIGENT_DEVELOPMENT
+    const Uint64 QueueMask = (Uint64{1} << m_pComputeContext->GetDesc().ContextId) |
+        (pSrcContext != nullptr ? (Uint64{1} << pSrcContext->GetDesc().ContextId) : 0);
+#endif
+
+    m_Barriers.clear();
+    for (Uint32 i = 0; i < Job.NumResources; ++i)
+    {
+        const AsyncComputeResource& Res = Job.pResources[i];
+        if (Res.pResource == nullptr)
+            continue;
+
+        DEV_CHECK_ERR(Res.State != RESOURCE_STATE_UNKNOWN, "Resource state must not be unknown");
+
+        StateTransitionDesc Barrier;
+        Barrier.pResource = Res.pResource;
+        Barrier.OldState  = RESOURCE_STATE_UNKNOWN;
+        Barrier.NewState  = Res.State;
+        Barrier.Flags     = STATE_TRANSITION_FLAG_UPDATE_STATE;
+
+        if (RefCntAutoPtr<ITexture> pTexture{Res.pResource, IID_Texture})
+        {
+            const TextureDesc& Desc = pTexture->GetDesc();
+            DEV_CHECK_ERR((Desc.ImmediateContextMask & QueueMask) == QueueMask,
+                          "Texture '", Desc.Name, "' is used by the async compute job, but its immediate context mask does not include all contexts that access it");
+            if (pTexture->GetState() == RESOURCE_STATE_UNKNOWN)
+                continue;
+        }
+        else if (RefCntAutoPtr<IBuffer> pBuffer{Res.pResource, IID_Buffer})
+        {
+            const BufferDesc& Desc = pBuffer->GetDesc();
+            DEV_CHECK_ERR((Desc.ImmediateContextMask & QueueMask) == QueueMask,
+                          "Buffer '", Desc.Name, "' is used by the async compute job, but its immediate context mask does not include all contexts that access it");
+            if (pBuffer->GetState() == RESOURCE_STATE_UNKNOWN)
+                continue;
+        }
+        else
+        {
+            DEV_ERROR("Only textures and buffers are expected");
+            continue;
+        }
+
+        m_Barriers.push_back(Barrier);
+    }
+    if (!m_Barriers.empty())
+        pTransitionCtx->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+
+    if (pSrcContext != nullptr)
+    {
+        Uint64  SrcFenceValue = 0;
+        IFence* pSrcFence     = GetSourceFence(pSrcContext, SrcFenceValue);
+        if (pSrcFence == nullptr)
+            return {};
+
+        pSrcContext->EnqueueSignal(pSrcFence, SrcFenceValue);
+        // The value must be pending before the compute context can wait for it
+        pSrcContext->Flush();
+        m_pComputeContext->DeviceWaitForFence(pSrcFence, SrcFenceValue);
+    }
+
+    if (Job.Name != nullptr)
+        m_pComputeContext->BeginDebugGroup(Job.Name);
+
+    m_pComputeContext->SetPipelineState(Job.pPSO);
+    if (Job.pSRB != nullptr)
+        m_pComputeContext->CommitShaderResources(Job.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    for (Uint32 i = 0; i < Job.NumDispatches; ++i)
+        m_pComputeContext->DispatchCompute(Job.pDispatches[i]);
+
+    if (Job.Name != nullptr)
+        m_pComputeContext->EndDebugGroup();
+
+    m_pComputeContext->EnqueueSignal(m_pFence, ++m_FenceValue);
+    m_pComputeContext->Flush();
+
+    return {m_FenceValue};
+}
+
+void AsyncComputeQueue::Wait(IDeviceContext* pContext, const AsyncComputeToken& Token)
+{
+    if (!Token.IsValid() || pContext == m_pComputeContext)
+        return;
+
+    DEV_CHECK_ERR(pContext != nullptr, "pContext must not be null");
+    DEV_CHECK_ERR(Token.FenceValue <= m_FenceValue, "Token was not returned by this queue");
+    pContext->DeviceWaitForFence(m_pFence, Token.FenceValue);
+}
+
+bool AsyncComputeQueue::IsComplete(const AsyncComputeToken& Token) const
+{
+    return m_pFence->GetCompletedValue() >= Token.FenceValue;
+}
+
+void AsyncComputeQueue::WaitForCompletion(const AsyncComputeToken& Token)
+{
+    if (Token.IsValid())
+        m_pFence->Wait(Token.FenceValue);
+}
+
+} // namespace Diligent
@@ -0,0 +1,377 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BLASBatchBuilder.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Compacted sizes are written as 64-bit values (32-bit in Metal)
+constexpr Uint32 CompactedSizeStride = sizeof(Uint64);
+
+bool IsCompactable(const BuildBLASAttribs& Attribs)
+{
+    return !Attribs.Update && (Attribs.pBLAS->GetDesc().Flags & RAYTRACING_BUILD_AS_ALLOW_COMPACTION) != 0;
+}
+
+} // namespace
+
+BLASBatchBuilder::BLASBatchBuilder(IRenderDevice* pDevice, const BLASBatchBuilderCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Name{CI.Name != nullptr ? CI.Name : "BLAS batch builder"},
+    m_MaxScratchBufferSize{CI.MaxScratchBufferSize}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (!m_pDevice->GetDeviceInfo().Features.RayTracing)
+        LOG_ERROR_AND_THROW("BLAS batch builder requires ray tracing");
+
+    m_ScratchAlignment = std::max(Uint64{m_pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment}, Uint64{1});
+
+    const std::string FenceName = m_Name + " - compaction fence";
+
+    FenceDesc Desc;
+    Desc.Name = FenceName.c_str();
+    Desc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+    m_pDevice->CreateFence(Desc, &m_pFence);
+    if (!m_pFence)
+        LOG_ERROR_AND_THROW("Failed to create the compaction fence");
+}
+
+Uint64 BLASBatchBuilder::GetScratchSize(const BuildBLASAttribs& Attribs) const
+{
+    const ScratchBufferSizes Sizes = Attribs.pBLAS->GetScratchBufferSizes();
+    return AlignUp(Attribs.Update ? Sizes.Update : Sizes.Build, m_ScratchAlignment);
+}
+
+Uint64 BLASBatchBuilder::GetScratchBufferSize() const
+{
+    return m_pScratchBuffer ? m_pScratchBuffer->GetDesc().Size : 0;
+}
+
+void BLASBatchBuilder::ReserveScratchBuffer(Uint64 Size)
+{
+    if (m_pScratchBuffer && m_pScratchBuffer->GetDesc().Size >= Size)
+        return;
+
+    // The old buffer is kept alive by the engine until the GPU stops using it
+    m_pScratchBuffer.Release();
+
+    const std::string Name = m_Name + " - scratch buffer";
+
+    BufferDesc Desc;
+    Desc.Name      = Name.c_str();
+    Desc.Usage     = USAGE_DEFAULT;
+    Desc.BindFlags = BIND_RAY_TRACING;
+    Desc.Size      = Size;
+    m_pDevice->CreateBuffer(Desc, nullptr, &m_pScratchBuffer);
+    if (!m_pScratchBuffer)
+        LOG_ERROR_AND_THROW("Failed to create the scratch buffer of size ", Size);
+}
+
+void BLASBatchBuilder::AddTransition(IBuffer* pBuffer, RESOURCE_STATE NewState)
+{
+    if (pBuffer != nullptr && m_TransitionedBuffers.insert(pBuffer).second)
+        m_Barriers.emplace_back(pBuffer, RESOURCE_STATE_UNKNOWN, NewState, STATE_TRANSITION_FLAG_UPDATE_STATE);
+}
+
+void BLASBatchBuilder::Build(IDeviceContext* pContext, const BuildBLASAttribs* pAttribs, Uint32 NumBLASes, bool Compact)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pAttribs != nullptr || NumBLASes == 0, "pAttribs must not be null");
+    if (NumBLASes == 0)
+        return;
+
+    Uint64 TotalScratchSize = 0;
+    Uint64 MaxScratchSize   = 0;
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        DEV_CHECK_ERR(pAttribs[i].pBLAS != nullptr, "pBLAS must not be null");
+        const Uint64 Size = GetScratchSize(pAttribs[i]);
+        TotalScratchSize += Size;
+        MaxScratchSize = std::max(MaxScratchSize, Size);
+    }
+    ReserveScratchBuffer(std::max(std::min(TotalScratchSize, m_MaxScratchBufferSize), MaxScratchSize));
+
+    // Split the builds into groups that fit into the scratch buffer
+    const Uint64 ScratchBufferSize = m_pScratchBuffer->GetDesc().Size;
+
+    Uint32 GroupStart = 0;
+    Uint64 GroupSize  = 0;
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        const Uint64 Size = GetScratchSize(pAttribs[i]);
+        if (GroupSize + Size > ScratchBufferSize)
+        {
+            VERIFY_EXPR(i > GroupStart);
+            BuildGroup(pContext, pAttribs + GroupStart, i - GroupStart, Compact);
+            GroupStart = i;
+            GroupSize  = 0;
+        }
+        GroupSize += Size;
+    }
+    BuildGroup(pContext, pAttribs + GroupStart, NumBLASes - GroupStart, Compact);
+
+    if (Compact)
+        WriteCompactedSizes(pContext, pAttribs, NumBLASes);
+}
+
+void BLASBatchBuilder::BuildGroup(IDeviceContext* pContext, const BuildBLASAttribs* pAttribs, Uint32 NumBLASes, bool Compact)
+{
+    m_Barriers.clear();
+    m_TransitionedBuffers.clear();
+
+    // If the scratch buffer is already in BUILD_AS_WRITE state, the transition inserts
+    // a barrier that waits for the builds of the previous group to complete.
+    AddTransition(m_pScratchBuffer, RESOURCE_STATE_BUILD_AS_WRITE);
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        const BuildBLASAttribs& Attribs = pAttribs[i];
+        if (Attribs.BLASTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+            m_Barriers.emplace_back(Attribs.pBLAS, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_BUILD_AS_WRITE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+
+        if (Attribs.GeometryTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+        {
+            // Geometry buffers are often shared by many BLASes
+            for (Uint32 j = 0; j < Attribs.TriangleDataCount; ++j)
+            {
+                const BLASBuildTriangleData& Tri = Attribs.pTriangleData[j];
+                AddTransition(Tri.pVertexBuffer, RESOURCE_STATE_BUILD_AS_READ);
+                AddTransition(Tri.pIndexBuffer, RESOURCE_STATE_BUILD_AS_READ);
+                AddTransition(Tri.pTransformBuffer, RESOURCE_STATE_BUILD_AS_READ);
+            }
+            for (Uint32 j = 0; j < Attribs.BoxDataCount; ++j)
+                AddTransition(Attribs.pBoxData[j].pBoxBuffer, RESOURCE_STATE_BUILD_AS_READ);
+        }
+    }
+    pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+
+    // All builds use disjoint scratch regions and are recorded without barriers
+    Uint64 ScratchOffset = 0;
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        BuildBLASAttribs Attribs = pAttribs[i];
+        if (Attribs.BLASTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+            Attribs.BLASTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+        if (Attribs.GeometryTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+            Attribs.GeometryTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+        Attribs.pScratchBuffer              = m_pScratchBuffer;
+        Attribs.ScratchBufferOffset         = ScratchOffset;
+        Attribs.ScratchBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+        pContext->BuildBLAS(Attribs);
+
+        ScratchOffset += GetScratchSize(Attribs);
+    }
+    VERIFY_EXPR(ScratchOffset <= m_pScratchBuffer->GetDesc().Size);
+
+    m_Barriers.clear();
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        const BuildBLASAttribs& Attribs = pAttribs[i];
+        if (Attribs.BLASTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION || (Compact && IsCompactable(Attribs)))
+        {
+            // The state of the BLAS is unknown if the application manages it
+            const RESOURCE_STATE OldState = Attribs.pBLAS->GetState() == RESOURCE_STATE_UNKNOWN ? RESOURCE_STATE_BUILD_AS_WRITE : RESOURCE_STATE_UNKNOWN;
+            m_Barriers.emplace_back(Attribs.pBLAS, OldState, RESOURCE_STATE_BUILD_AS_READ, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        }
+    }
+    if (!m_Barriers.empty())
+        pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+}
+
+void BLASBatchBuilder::WriteCompactedSizes(IDeviceContext* pContext, const BuildBLASAttribs* pAttribs, Uint32 NumBLASes)
+{
+    PendingBatch Batch;
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        if (IsCompactable(pAttribs[i]))
+            Batch.BLASes.emplace_back(pAttribs[i].pBLAS);
+    }
+    if (Batch.BLASes.empty())
+        return;
+
+    const Uint64 SizesBufferSize = Uint64{CompactedSizeStride} * Batch.BLASes.size();
+
+    RefCntAutoPtr<IBuffer> pSizesBuffer;
+    {
+        const std::string Name = m_Name + " - compacted sizes";
+
+        BufferDesc Desc;
+        Desc.Name      = Name.c_str();
+        Desc.Usage     = USAGE_DEFAULT;
+        Desc.BindFlags = BIND_UNORDERED_ACCESS;
+        Desc.Mode      = BUFFER_MODE_RAW;
+        Desc.Size      = SizesBufferSize;
+        m_pDevice->CreateBuffer(Desc, nullptr, &pSizesBuffer);
+        if (!pSizesBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create the compacted sizes buffer. BLASes will not be compacted.");
+            return;
+        }
+    }
+    {
+        const std::string Name = m_Name + " - compacted sizes readback";
+
+        BufferDesc Desc;
+        Desc.Name           = Name.c_str();
+        Desc.Usage          = USAGE_STAGING;
+        Desc.CPUAccessFlags = CPU_ACCESS_READ;
+        Desc.Size           = SizesBufferSize;
+        m_pDevice->CreateBuffer(Desc, nullptr, &Batch.pReadbackBuffer);
+        if (!Batch.pReadbackBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create the compacted sizes readback buffer. BLASes will not be compacted.");
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < Batch.BLASes.size(); ++i)
+    {
+        // Only the first write transitions the buffer; the writes use disjoint ranges.
+        WriteBLASCompactedSizeAttribs Attribs{
+            Batch.BLASes[i],
+            pSizesBuffer,
+            CompactedSizeStride * i,
+            RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+            i == 0 ? RESOURCE_STATE_TRANSITION_MODE_TRANSITION : RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+        };
+        pContext->WriteBLASCompactedSize(Attribs);
+    }
+
+    pContext->CopyBuffer(pSizesBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         Batch.pReadbackBuffer, 0, SizesBufferSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    Batch.FenceValue = m_NextFenceValue++;
+    pContext->EnqueueSignal(m_pFence, Batch.FenceValue);
+
+    m_NumPendingCompactions += static_cast<Uint32>(Batch.BLASes.size());
+    m_PendingBatches.emplace_back(std::move(Batch));
+}
+
+Uint32 BLASBatchBuilder::ProcessCompaction(IDeviceContext* pContext, std::vector<CompactedBLAS>& Compacted)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    if (m_PendingBatches.empty())
+        return 0;
+
+    const Uint64 CompletedFenceValue = m_pFence->GetCompletedValue();
+    const bool   Is32BitSize         = m_pDevice->GetDeviceInfo().IsMetalDevice();
+
+    const size_t FirstCompacted = Compacted.size();
+
+    m_Barriers.clear();
+
+    // Batches are signaled in order
+    size_t NumCompletedBatches = 0;
+    for (; NumCompletedBatches < m_PendingBatches.size(); ++NumCompletedBatches)
+    {
+        PendingBatch& Batch = m_PendingBatches[NumCompletedBatches];
+        if (Batch.FenceValue > CompletedFenceValue)
+            break;
+
+        void* pMappedData = nullptr;
+        pContext->MapBuffer(Batch.pReadbackBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pMappedData);
+        if (pMappedData == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to map the compacted sizes readback buffer");
+            break;
+        }
+
+        for (size_t i = 0; i < Batch.BLASes.size(); ++i)
+        {
+            const Uint8* pSize         = static_cast<const Uint8*>(pMappedData) + CompactedSizeStride * i;
+            const Uint64 CompactedSize = Is32BitSize ? Uint64{*reinterpret_cast<const Uint32*>(pSize)} : *reinterpret_cast<const Uint64*>(pSize);
+
+            IBottomLevelAS* const    pSrcBLAS = Batch.BLASes[i];
+            const BottomLevelASDesc& SrcDesc  = pSrcBLAS->GetDesc();
+            if (CompactedSize == 0)
+            {
+                LOG_ERROR_MESSAGE("Failed to get the compacted size of BLAS '", SrcDesc.Name, "'");
+                continue;
+            }
+
+            const std::string Name = std::string{SrcDesc.Name != nullptr ? SrcDesc.Name : ""} + " (compacted)";
+
+            BottomLevelASDesc Desc;
+            Desc.Name                 = Name.c_str();
+            Desc.CompactedSize        = CompactedSize;
+            Desc.ImmediateContextMask = SrcDesc.ImmediateContextMask;
+
+            RefCntAutoPtr<IBottomLevelAS> pDstBLAS;
+            m_pDevice->CreateBLAS(Desc, &pDstBLAS);
+            if (!pDstBLAS)
+            {
+                LOG_ERROR_MESSAGE("Failed to create the compacted copy of BLAS '", SrcDesc.Name, "'");
+                continue;
+            }
+
+            m_Barriers.emplace_back(pDstBLAS, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_BUILD_AS_WRITE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+            Compacted.emplace_back(CompactedBLAS{Batch.BLASes[i], std::move(pDstBLAS)});
+        }
+
+        pContext->UnmapBuffer(Batch.pReadbackBuffer, MAP_READ);
+        m_NumPendingCompactions -= static_cast<Uint32>(Batch.BLASes.size());
+    }
+    m_PendingBatches.erase(m_PendingBatches.begin(), m_PendingBatches.begin() + NumCompletedBatches);
+
+    const Uint32 NumCompacted = static_cast<Uint32>(Compacted.size() - FirstCompacted);
+    if (NumCompacted == 0)
+        return 0;
+
+    pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+
+    for (size_t i = FirstCompacted; i < Compacted.size(); ++i)
+    {
+        CopyBLASAttribs Attribs{
+            Compacted[i].pSource,
+            Compacted[i].pCompacted,
+            COPY_AS_MODE_COMPACT,
+            RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+            RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+        };
+        pContext->CopyBLAS(Attribs);
+    }
+
+    for (StateTransitionDesc& Barrier : m_Barriers)
+    {
+        Barrier.OldState = RESOURCE_STATE_BUILD_AS_WRITE;
+        Barrier.NewState = RESOURCE_STATE_BUILD_AS_READ;
+    }
+    pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+
+    return NumCompacted;
+}
+
+} // namespace Diligent
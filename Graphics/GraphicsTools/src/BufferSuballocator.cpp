@@ -29,6 +29,10 @@
 
 #include <mutex>
 #include <atomic>
+#include <map>
+#include <vector>
+#include <array>
+#include <memory>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
@@ -38,12 +42,50 @@
 #include "Align.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
+#include "SpinLock.hpp"
 
 namespace Diligent
 {
 
 class BufferSuballocatorImpl;
 
+// A page reserved from the shared allocations manager by a thread cache.
+// Suballocations are carved out of the page with a bump pointer by the thread that
+// currently owns it. When the page is full, it is retired and is returned to the
+// manager by ReconcileThreadCaches() once all its suballocations have been released.
+struct ThreadCachePage
+{
+    ThreadCachePage(VariableSizeAllocationsManager::Allocation&& _Region, Uint32 _Offset, Uint32 _Size) :
+        // clang-format off
+        Region{std::move(_Region)},
+        Offset{_Offset},
+        Size  {_Size}
+    // clang-format on
+    {}
+
+    // Must only be called by the thread that owns the page.
+    bool Allocate(Uint32 AllocSize, Uint32 Alignment, Uint32& AllocOffset)
+    {
+        const Uint32 Start = AlignUp(Offset + UsedSize, Alignment);
+        if (Uint64{Start} + AllocSize > Uint64{Offset} + Size)
+            return false;
+
+        AllocOffset = Start;
+        UsedSize    = Start + AllocSize - Offset;
+        return true;
+    }
+
+    VariableSizeAllocationsManager::Allocation Region;
+
+    const Uint32 Offset;
+    const Uint32 Size;
+
+    Uint32 UsedSize = 0;
+
+    // The number of live suballocations in the page.
+    std::atomic<Uint32> NumAllocations{0};
+};
+
 class BufferSuballocationImpl final : public ObjectBase<IBufferSuballocation>
 {
 public:
@@ -52,17 +94,21 @@ public:
                             BufferSuballocatorImpl*                      pParentAllocator,
                             Uint32                                       Offset,
                             Uint32                                       Size,
-                            VariableSizeAllocationsManager::Allocation&& Subregion) :
+                            Uint32                                       Alignment,
+                            VariableSizeAllocationsManager::Allocation&& Subregion,
+                            ThreadCachePage*                             pPage = nullptr) :
         // clang-format off
         TBase             {pRefCounters},
         m_pParentAllocator{pParentAllocator},
         m_Subregion       {std::move(Subregion)},
+        m_pPage           {pPage},
         m_Offset          {Offset},
-        m_Size            {Size}
+        m_Size            {Size},
+        m_Alignment       {Alignment}
     // clang-format on
     {
         VERIFY_EXPR(m_pParentAllocator);
-        VERIFY_EXPR(m_Subregion.IsValid());
+        VERIFY(m_Subregion.IsValid() != (m_pPage != nullptr), "Suballocation must either own a subregion or reference a thread cache page");
     }
 
     ~BufferSuballocationImpl();
@@ -83,7 +129,7 @@ public:
 
     virtual Uint32 GetOffset() const override final
     {
-        return m_Offset;
+        return m_Offset.load();
     }
 
     virtual Uint32 GetSize() const override final
@@ -107,13 +153,38 @@ public:
         return m_pUserData;
     }
 
+    // The following methods must only be called by the parent allocator while its mutex is locked.
+    Uint32 GetAlignment() const
+    {
+        return m_Alignment;
+    }
+
+    VariableSizeAllocationsManager::Allocation Relocate(VariableSizeAllocationsManager::Allocation&& NewSubregion, Uint32 NewOffset)
+    {
+        VERIFY_EXPR(NewSubregion.IsValid());
+        std::swap(m_Subregion, NewSubregion);
+        m_Offset.store(NewOffset);
+        return std::move(NewSubregion);
+    }
+
+    VariableSizeAllocationsManager::Allocation ReleaseSubregion()
+    {
+        return std::move(m_Subregion);
+    }
+
 private:
     RefCntAutoPtr<BufferSuballocatorImpl> m_pParentAllocator;
 
     VariableSizeAllocationsManager::Allocation m_Subregion;
 
-    const Uint32 m_Offset;
-    const Uint32 m_Size;
+    // The thread cache page this suballocation was made from.
+    // If not null, m_Subregion is invalid.
+    ThreadCachePage* const m_pPage;
+
+    // The offset is updated by the defragmentation and may be read in other threads.
+    std::atomic<Uint32> m_Offset;
+    const Uint32        m_Size;
+    const Uint32        m_Alignment;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
@@ -160,10 +231,13 @@ public:
             },
         },
         m_BufferSize{m_Buffer.GetDesc().Size},
+        m_ThreadCachePageSize{CreateInfo.ThreadCachePageSize},
         m_SuballocationsAllocator{
             DefaultRawMemoryAllocator::GetAllocator(),
             sizeof(BufferSuballocationImpl),
-            1024u / Uint32{sizeof(BufferSuballocationImpl)} // Use 1 Kb pages.
+            1024u / Uint32{sizeof(BufferSuballocationImpl)}, // Use 1 Kb pages.
+            // Suballocation objects must also be created without locking when thread caches are used.
+            CreateInfo.ThreadCachePageSize != 0 ? 64u : 0u,
         }
     {
     }
@@ -171,6 +245,17 @@ public:
     ~BufferSuballocatorImpl()
     {
         VERIFY_EXPR(m_AllocationCount.load() == 0);
+
+        for (auto& Shard : m_ThreadCacheShards)
+        {
+            if (Shard.pPage)
+                m_RetiredPages.emplace_back(std::move(Shard.pPage));
+        }
+        for (auto& pPage : m_RetiredPages)
+        {
+            VERIFY_EXPR(pPage->NumAllocations.load() == 0);
+            m_Mgr.Free(std::move(pPage->Region));
+        }
     }
 
     virtual IBuffer* Update(IRenderDevice* pDevice, IDeviceContext* pContext) override final
@@ -217,73 +302,210 @@ public:
 
         DEV_CHECK_ERR(*ppSuballocation == nullptr, "Overwriting reference to existing object may cause memory leaks");
 
-        VariableSizeAllocationsManager::Allocation Subregion;
+        if (m_ThreadCachePageSize != 0 && AlignUp(Size, Alignment) <= m_ThreadCachePageSize / 4)
+        {
+            AllocateFromThreadCache(Size, Alignment, ppSuballocation);
+            return;
+        }
+
         {
             std::lock_guard<std::mutex> Lock{m_MgrMtx};
 
+            VariableSizeAllocationsManager::Allocation Subregion = AllocateSubregion(Size, Alignment);
+
+            UpdateUsageStats();
+
+            if (Subregion.IsValid())
             {
-                // After the resize, the actual buffer size may be larger due to alignment
-                // requirements (for sparse buffers, the size is aligned by the memory page size).
-                const auto BufferSize = m_BufferSize.load();
-                const auto MgrSize    = m_Mgr.GetMaxSize();
-                if (BufferSize > MgrSize)
-                {
-                    m_Mgr.Extend(StaticCast<size_t>(BufferSize - MgrSize));
-                    VERIFY_EXPR(m_Mgr.GetMaxSize() == BufferSize);
-                    m_MgrSize.store(m_Mgr.GetMaxSize());
-                }
+                const auto UnalignedOffset = Subregion.UnalignedOffset;
+                // clang-format off
+                BufferSuballocationImpl* pSuballocation{
+                    NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
+                    (
+                        this,
+                        AlignUp(static_cast<Uint32>(UnalignedOffset), Alignment),
+                        Size,
+                        Alignment,
+                        std::move(Subregion)
+                    )
+                };
+                // clang-format on
+
+                // Register the suballocation while the mutex is locked so that
+                // the defragmentation never misses it.
+                m_Suballocations.emplace(UnalignedOffset, pSuballocation);
+
+                pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
+                m_AllocationCount.fetch_add(1);
             }
+        }
+    }
 
-            Subregion = m_Mgr.Allocate(Size, Alignment);
+    void Free(BufferSuballocationImpl& Suballocation)
+    {
+        std::lock_guard<std::mutex> Lock{m_MgrMtx};
 
-            while (!Subregion.IsValid() && (m_MaxSize == 0 || m_MaxSize > m_Mgr.GetMaxSize()))
-            {
-                size_t ExtraSize = m_ExpansionSize != 0 ?
-                    std::max(m_ExpansionSize, AlignUp(Size, Alignment)) :
-                    m_Mgr.GetMaxSize();
+        // NB: the subregion must be read while the mutex is locked as it may be changed by Defragment().
+        auto Subregion = Suballocation.ReleaseSubregion();
+        VERIFY_EXPR(m_Suballocations.count(Subregion.UnalignedOffset) == 1 && m_Suballocations[Subregion.UnalignedOffset] == &Suballocation);
+        m_Suballocations.erase(Subregion.UnalignedOffset);
 
-                if (m_MaxSize != 0)
-                    ExtraSize = std::min(ExtraSize, StaticCast<size_t>(m_MaxSize) - m_Mgr.GetMaxSize());
+        m_Mgr.Free(std::move(Subregion));
+        m_AllocationCount.fetch_add(-1);
+        UpdateUsageStats();
+    }
 
-                m_Mgr.Extend(ExtraSize);
-                m_MgrSize.store(m_Mgr.GetMaxSize());
+    void FreeToThreadCache(ThreadCachePage& Page, Uint32 Size)
+    {
+        m_ThreadCacheAllocatedSize.fetch_sub(Size);
+        m_AllocationCount.fetch_add(-1);
+        // NB: this must be the last access to the page as it may be released
+        //     by ReconcileThreadCaches() as soon as the counter reaches zero.
+        Page.NumAllocations.fetch_sub(1);
+    }
 
-                Subregion = m_Mgr.Allocate(Size, Alignment);
-            }
+    virtual void ReconcileThreadCaches() override final
+    {
+        if (m_ThreadCachePageSize == 0)
+            return;
 
-            UpdateUsageStats();
+        // Retire the pages that have no live suballocations so that they
+        // can be returned to the shared manager.
+        std::vector<std::unique_ptr<ThreadCachePage>> EmptyPages;
+        for (auto& Shard : m_ThreadCacheShards)
+        {
+            Threading::SpinLockGuard Guard{Shard.Lock};
+            if (Shard.pPage && Shard.pPage->NumAllocations.load() == 0)
+                EmptyPages.emplace_back(std::move(Shard.pPage));
         }
 
-        if (Subregion.IsValid())
+        std::lock_guard<std::mutex> Lock{m_MgrMtx};
+        for (auto& pPage : EmptyPages)
+            m_RetiredPages.emplace_back(std::move(pPage));
+
+        auto PageIt = m_RetiredPages.begin();
+        while (PageIt != m_RetiredPages.end())
         {
-            // clang-format off
-            BufferSuballocationImpl* pSuballocation{
-                NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
-                (
-                    this,
-                    AlignUp(static_cast<Uint32>(Subregion.UnalignedOffset), Alignment),
-                    Size,
-                    std::move(Subregion)
-                )
-            };
-            // clang-format on
-
-            pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
-            m_AllocationCount.fetch_add(1);
+            ThreadCachePage& Page = **PageIt;
+            if (Page.NumAllocations.load() == 0)
+            {
+                m_ThreadCacheReservedSize.fetch_sub(Page.Size);
+                m_ThreadCachePageCount.fetch_add(-1);
+                m_Mgr.Free(std::move(Page.Region));
+                PageIt = m_RetiredPages.erase(PageIt);
+            }
+            else
+            {
+                ++PageIt;
+            }
         }
+
+        UpdateUsageStats();
+    }
+
+    virtual Uint32 GetVersion() const override final
+    {
+        return m_Buffer.GetVersion();
     }
 
-    void Free(VariableSizeAllocationsManager::Allocation&& Subregion)
+    virtual Uint64 Defragment(IRenderDevice* pDevice, IDeviceContext* pContext, Uint64 MaxBytesToMove) override final
     {
+        if (pContext == nullptr)
+        {
+            UNEXPECTED("pContext must not be null");
+            return 0;
+        }
+
+        IBuffer* pBuffer = Update(pDevice, pContext);
+        if (pBuffer == nullptr || MaxBytesToMove == 0)
+            return 0;
+
+        // NB: the mutex is held while copy commands are recorded to make sure
+        //     that suballocations are not released while they are being moved.
         std::lock_guard<std::mutex> Lock{m_MgrMtx};
-        m_Mgr.Free(std::move(Subregion));
-        m_AllocationCount.fetch_add(-1);
+
+        if (m_Mgr.GetFreeSize() == 0)
+            return 0;
+
+        // Suballocations can only be moved within the range backed by the current buffer.
+        const Uint64 BufferSize = m_Buffer.GetDesc().Size;
+
+        m_PendingMoves.clear();
+        Uint64 ScratchSize = 0;
+        Uint64 BytesToMove = 0;
+        // Start from the end of the buffer to shrink the used range.
+        for (auto it = m_Suballocations.rbegin(); it != m_Suballocations.rend() && BytesToMove < MaxBytesToMove; ++it)
+        {
+            BufferSuballocationImpl& Suballoc = *it->second;
+
+            const Uint32 Size      = Suballoc.GetSize();
+            const Uint32 Alignment = Suballoc.GetAlignment();
+            const Uint32 SrcOffset = Suballoc.GetOffset();
+            if (BytesToMove + Size > MaxBytesToMove || Uint64{SrcOffset} + Size > BufferSize)
+                continue;
+
+            auto NewSubregion = m_Mgr.Allocate(Size, Alignment);
+            if (!NewSubregion.IsValid())
+                continue;
+
+            const Uint32 DstOffset = AlignUp(static_cast<Uint32>(NewSubregion.UnalignedOffset), Alignment);
+            if (DstOffset >= SrcOffset || Uint64{DstOffset} + Size > BufferSize)
+            {
+                // The best-fit free range is not closer to the beginning of the buffer
+                m_Mgr.Free(std::move(NewSubregion));
+                continue;
+            }
+
+            m_PendingMoves.emplace_back(Suballoc, std::move(NewSubregion), SrcOffset, DstOffset, ScratchSize);
+            BytesToMove += Size;
+            ScratchSize += AlignUp(Uint64{Size}, Uint64{16});
+        }
+
+        if (m_PendingMoves.empty())
+            return 0;
+
+        IBuffer* pScratchBuffer = GetScratchBuffer(pDevice, ScratchSize);
+        if (pScratchBuffer == nullptr)
+        {
+            for (auto& Move : m_PendingMoves)
+                m_Mgr.Free(std::move(Move.NewSubregion));
+            m_PendingMoves.clear();
+            return 0;
+        }
+
+        // Source and destination ranges are in the same buffer, which can't be in the copy
+        // source and copy destination states at the same time, so the data is copied through
+        // the scratch buffer.
+        for (const auto& Move : m_PendingMoves)
+        {
+            pContext->CopyBuffer(pBuffer, Move.SrcOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                 pScratchBuffer, Move.ScratchOffset, Move.pSuballoc->GetSize(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+        for (auto& Move : m_PendingMoves)
+        {
+            BufferSuballocationImpl& Suballoc = *Move.pSuballoc;
+
+            pContext->CopyBuffer(pScratchBuffer, Move.ScratchOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                 pBuffer, Move.DstOffset, Suballoc.GetSize(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            const auto NewUnalignedOffset = Move.NewSubregion.UnalignedOffset;
+
+            auto OldSubregion = Suballoc.Relocate(std::move(Move.NewSubregion), Move.DstOffset);
+            m_Suballocations.erase(OldSubregion.UnalignedOffset);
+            m_Suballocations.emplace(NewUnalignedOffset, &Suballoc);
+            m_Mgr.Free(std::move(OldSubregion));
+        }
+        m_PendingMoves.clear();
+
         UpdateUsageStats();
+        m_LayoutVersion.fetch_add(1);
+
+        return BytesToMove;
     }
 
-    virtual Uint32 GetVersion() const override final
+    virtual Uint32 GetLayoutVersion() const override final
     {
-        return m_Buffer.GetVersion();
+        return m_LayoutVersion.load();
     }
 
     virtual void GetUsageStats(BufferSuballocatorUsageStats& UsageStats) override final
@@ -293,6 +515,11 @@ public:
         UsageStats.UsedSize         = m_UsedSize.load();
         UsageStats.MaxFreeChunkSize = m_MaxFreeBlockSize.load();
         UsageStats.AllocationCount  = m_AllocationCount.load();
+        UsageStats.FreeChunkCount   = m_FreeChunkCount.load();
+
+        UsageStats.ThreadCacheReservedSize  = m_ThreadCacheReservedSize.load();
+        UsageStats.ThreadCacheAllocatedSize = m_ThreadCacheAllocatedSize.load();
+        UsageStats.ThreadCachePageCount     = m_ThreadCachePageCount.load();
     }
 
 private:
@@ -300,6 +527,139 @@ private:
     {
         m_UsedSize.store(m_Mgr.GetUsedSize());
         m_MaxFreeBlockSize.store(m_Mgr.GetMaxFreeBlockSize());
+        m_FreeChunkCount.store(static_cast<Uint32>(m_Mgr.GetNumFreeBlocks()));
+    }
+
+    // Must be called while m_MgrMtx is locked.
+    VariableSizeAllocationsManager::Allocation AllocateSubregion(Uint32 Size, Uint32 Alignment)
+    {
+        {
+            // After the resize, the actual buffer size may be larger due to alignment
+            // requirements (for sparse buffers, the size is aligned by the memory page size).
+            const auto BufferSize = m_BufferSize.load();
+            const auto MgrSize    = m_Mgr.GetMaxSize();
+            if (BufferSize > MgrSize)
+            {
+                m_Mgr.Extend(StaticCast<size_t>(BufferSize - MgrSize));
+                VERIFY_EXPR(m_Mgr.GetMaxSize() == BufferSize);
+                m_MgrSize.store(m_Mgr.GetMaxSize());
+            }
+        }
+
+        VariableSizeAllocationsManager::Allocation Subregion = m_Mgr.Allocate(Size, Alignment);
+
+        while (!Subregion.IsValid() && (m_MaxSize == 0 || m_MaxSize > m_Mgr.GetMaxSize()))
+        {
+            size_t ExtraSize = m_ExpansionSize != 0 ?
+                std::max(m_ExpansionSize, AlignUp(Size, Alignment)) :
+                m_Mgr.GetMaxSize();
+
+            if (m_MaxSize != 0)
+                ExtraSize = std::min(ExtraSize, StaticCast<size_t>(m_MaxSize) - m_Mgr.GetMaxSize());
+
+            m_Mgr.Extend(ExtraSize);
+            m_MgrSize.store(m_Mgr.GetMaxSize());
+
+            Subregion = m_Mgr.Allocate(Size, Alignment);
+        }
+
+        return Subregion;
+    }
+
+    static size_t GetThreadCacheShardIndex()
+    {
+        // Threads are assigned to shards in round-robin order when they first allocate from a thread cache
+        static std::atomic<Uint32>       NextShardIndex{0};
+        static thread_local const Uint32 tl_ShardIndex = NextShardIndex.fetch_add(1) % NumThreadCacheShards;
+        return tl_ShardIndex;
+    }
+
+    void AllocateFromThreadCache(Uint32                 Size,
+                                 Uint32                 Alignment,
+                                 IBufferSuballocation** ppSuballocation)
+    {
+        ThreadCacheShard& Shard = m_ThreadCacheShards[GetThreadCacheShardIndex()];
+
+        // The shard lock is practically never contended as long as the number
+        // of allocating threads does not exceed the number of shards.
+        Threading::SpinLockGuard Guard{Shard.Lock};
+
+        Uint32 Offset = 0;
+        if (!Shard.pPage || !Shard.pPage->Allocate(Size, Alignment, Offset))
+        {
+            // Reserve a new page from the shared manager
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+            VariableSizeAllocationsManager::Allocation PageRegion = AllocateSubregion(m_ThreadCachePageSize, Alignment);
+            if (!PageRegion.IsValid())
+            {
+                UpdateUsageStats();
+                return;
+            }
+
+            if (Shard.pPage)
+                m_RetiredPages.emplace_back(std::move(Shard.pPage));
+
+            const Uint32 PageOffset = AlignUp(static_cast<Uint32>(PageRegion.UnalignedOffset), Alignment);
+            Shard.pPage             = std::make_unique<ThreadCachePage>(std::move(PageRegion), PageOffset, m_ThreadCachePageSize);
+            m_ThreadCacheReservedSize.fetch_add(m_ThreadCachePageSize);
+            m_ThreadCachePageCount.fetch_add(1);
+            UpdateUsageStats();
+
+            if (!Shard.pPage->Allocate(Size, Alignment, Offset))
+            {
+                UNEXPECTED("Allocation from a new page must always succeed");
+                return;
+            }
+        }
+        Shard.pPage->NumAllocations.fetch_add(1);
+
+        // clang-format off
+        BufferSuballocationImpl* pSuballocation{
+            NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
+            (
+                this,
+                Offset,
+                Size,
+                Alignment,
+                VariableSizeAllocationsManager::Allocation{},
+                Shard.pPage.get()
+            )
+        };
+        // clang-format on
+
+        pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
+        m_AllocationCount.fetch_add(1);
+        m_ThreadCacheAllocatedSize.fetch_add(Size);
+    }
+
+    IBuffer* GetScratchBuffer(IRenderDevice* pDevice, Uint64 Size)
+    {
+        if (m_pScratchBuffer && m_pScratchBuffer->GetDesc().Size >= Size)
+            return m_pScratchBuffer;
+
+        if (pDevice == nullptr)
+        {
+            UNEXPECTED("pDevice must not be null when the scratch buffer needs to be created");
+            return nullptr;
+        }
+
+        const auto& Desc = m_Buffer.GetDesc();
+
+        std::string Name = Desc.Name != nullptr ? Desc.Name : "Buffer suballocator";
+        Name += " - defragmentation scratch buffer";
+
+        BufferDesc ScratchDesc;
+        ScratchDesc.Name  = Name.c_str();
+        ScratchDesc.Size  = m_pScratchBuffer ? std::max(Size, m_pScratchBuffer->GetDesc().Size * 2) : Size;
+        ScratchDesc.Usage = USAGE_DEFAULT;
+
+        m_pScratchBuffer.Release();
+        pDevice->CreateBuffer(ScratchDesc, nullptr, &m_pScratchBuffer);
+        if (!m_pScratchBuffer)
+            LOG_ERROR_MESSAGE("Failed to create the defragmentation scratch buffer");
+
+        return m_pScratchBuffer;
     }
 
 private:
@@ -317,14 +677,67 @@ private:
     std::atomic<Int32>  m_AllocationCount{0};
     std::atomic<Uint64> m_UsedSize{0};
     std::atomic<Uint64> m_MaxFreeBlockSize{0};
+    std::atomic<Uint32> m_FreeChunkCount{0};
+
+    const Uint32 m_ThreadCachePageSize;
+
+    static constexpr size_t NumThreadCacheShards = 16;
+    struct ThreadCacheShard
+    {
+        Threading::SpinLock Lock;
+
+        // The page the shard currently allocates from.
+        std::unique_ptr<ThreadCachePage> pPage;
+    };
+    std::array<ThreadCacheShard, NumThreadCacheShards> m_ThreadCacheShards;
+
+    // Pages that are no longer used for new allocations. Protected by m_MgrMtx.
+    std::vector<std::unique_ptr<ThreadCachePage>> m_RetiredPages;
+
+    std::atomic<Uint64> m_ThreadCacheReservedSize{0};
+    std::atomic<Uint64> m_ThreadCacheAllocatedSize{0};
+    std::atomic<Int32>  m_ThreadCachePageCount{0};
 
     FixedBlockMemoryAllocator m_SuballocationsAllocator;
+
+    // Live suballocations sorted by the unaligned offset. Protected by m_MgrMtx.
+    std::map<VariableSizeAllocationsManager::OffsetType, BufferSuballocationImpl*> m_Suballocations;
+
+    struct PendingMove
+    {
+        PendingMove(BufferSuballocationImpl&                     _Suballoc,
+                    VariableSizeAllocationsManager::Allocation&& _NewSubregion,
+                    Uint32                                       _SrcOffset,
+                    Uint32                                       _DstOffset,
+                    Uint64                                       _ScratchOffset) :
+            // clang-format off
+            pSuballoc    {&_Suballoc},
+            NewSubregion {std::move(_NewSubregion)},
+            SrcOffset    {_SrcOffset},
+            DstOffset    {_DstOffset},
+            ScratchOffset{_ScratchOffset}
+        // clang-format on
+        {}
+
+        BufferSuballocationImpl*                   pSuballoc;
+        VariableSizeAllocationsManager::Allocation NewSubregion;
+        Uint32                                     SrcOffset;
+        Uint32                                     DstOffset;
+        Uint64                                     ScratchOffset;
+    };
+    std::vector<PendingMove> m_PendingMoves;
+
+    RefCntAutoPtr<IBuffer> m_pScratchBuffer;
+    std::atomic<Uint32>    m_LayoutVersion{0};
 };
 
 
 BufferSuballocationImpl::~BufferSuballocationImpl()
 {
-    m_pParentAllocator->Free(std::move(m_Subregion));
+    if (m_pPage != nullptr)
+        m_pParentAllocator->FreeToThreadCache(*m_pPage, m_Size);
+    else
+        m_pParentAllocator->Free(*this);
 }
 
 IBufferSuballocator* BufferSuballocationImpl::GetAllocator()
@@ -25,9 +25,19 @@
  */
 
 #include <unordered_map>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <random>
+#include <cstdio>
+#include <ctime>
+#include <cstring>
 
 #include "RefCntAutoPtr.hpp"
 #include "DataBlobImpl.hpp"
+#include "ProxyDataBlob.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
 #include "ObjectBase.hpp"
 #include "Serializer.hpp"
 #include "BytecodeCache.h"
@@ -72,12 +82,49 @@ public:
         }
     };
 
+    // Header of the byte code file in the cache directory
+    struct BytecodeFileHeader
+    {
+        static constexpr Uint32 HeaderMagic   = 0x7ADEF11E;
+        static constexpr Uint32 HeaderVersion = 1;
+
+        Uint32 Magic   = HeaderMagic;
+        Uint32 Version = HeaderVersion;
+
+        // Reserved for the compression mode
+        Uint32 Flags   = 0;
+        Uint32 Padding = 0;
+
+        Uint64 DataSize = 0;
+
+        // Hash of the byte code used to detect corrupted files
+        XXH128Hash DataHash = {};
+    };
+    static_assert(sizeof(BytecodeFileHeader) == 40, "Unexpected header size");
+
+    static constexpr char BytecodeFileExtension[] = ".dbc";
+
 public:
     BytecodeCacheImpl(IReferenceCounters*            pRefCounters,
                       const BytecodeCacheCreateInfo& CreateInfo) :
         TBase{pRefCounters},
-        m_DeviceType{CreateInfo.DeviceType}
+        m_DeviceType{CreateInfo.DeviceType},
+        m_MaxDirectorySize{CreateInfo.MaxDirectorySize}
     {
+        if (CreateInfo.CacheDirectory != nullptr && CreateInfo.CacheDirectory[0] != '\0')
+        {
+            m_Directory = CreateInfo.CacheDirectory;
+            if (!FileSystem::IsSlash(m_Directory.back()))
+                m_Directory.push_back(FileSystem::SlashSymbol);
+
+            if (!FileSystem::PathExists(m_Directory.c_str()) && !FileSystem::CreateDirectory(m_Directory.c_str()))
+                LOG_ERROR_AND_THROW("Failed to create bytecode cache directory '", CreateInfo.CacheDirectory, "'");
+
+            std::random_device rd;
+            m_TmpFileSuffix = '.' + std::to_string(rd()) + ".tmp";
+
+            ScanDirectory();
+        }
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BytecodeCache, TBase);
@@ -129,6 +176,17 @@ public:
         {
             auto pObject = Iter->second;
             *ppByteCode  = pObject.Detach();
+            MarkFileUsed(Hash);
+            return;
+        }
+
+        if (!m_Directory.empty())
+        {
+            if (auto pBytecode = ReadBytecodeFile(Hash))
+            {
+                m_HashMap.emplace(Hash, pBytecode);
+                *ppByteCode = pBytecode.Detach();
+            }
         }
     }
 
@@ -139,12 +197,18 @@ public:
         const auto Iter = m_HashMap.emplace(Hash, pByteCode);
         if (!Iter.second)
             Iter.first->second = pByteCode;
+
+        if (!m_Directory.empty() && pByteCode != nullptr)
+            WriteBytecodeFile(Hash, pByteCode);
     }
 
     virtual void DILIGENT_CALL_TYPE RemoveBytecode(const ShaderCreateInfo& ShaderCI) override final
     {
         const auto Hash = ComputeHash(ShaderCI);
         m_HashMap.erase(Hash);
+
+        if (!m_Directory.empty())
+            DeleteBytecodeFile(Hash);
     }
 
     virtual void DILIGENT_CALL_TYPE Store(IDataBlob** ppDataBlob) override final
@@ -196,12 +260,252 @@ private:
         return Hasher.Digest();
     }
 
+    static std::string HashToFileName(const XXH128Hash& Hash)
+    {
+        char Str[33];
+        std::snprintf(Str, sizeof(Str), "%016llx%016llx",
+                      static_cast<unsigned long long>(Hash.HighPart),
+                      static_cast<unsigned long long>(Hash.LowPart));
+        return std::string{Str} + BytecodeFileExtension;
+    }
+
+    static bool FileNameToHash(const std::string& Name, XXH128Hash& Hash)
+    {
+        if (Name.length() != 32 + sizeof(BytecodeFileExtension) - 1 ||
+            Name.compare(32, std::string::npos, BytecodeFileExtension) != 0)
+            return false;
+
+        Uint64 Parts[2] = {};
+        for (size_t i = 0; i < 32; ++i)
+        {
+            const char c = Name[i];
+
+            Uint64 Digit = 0;
+            if (c >= '0' && c <= '9')
+                Digit = static_cast<Uint64>(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                Digit = static_cast<Uint64>(c - 'a' + 10);
+            else
+                return false;
+
+            Uint64& Part = Parts[i / 16];
+            Part         = (Part << 4u) | Digit;
+        }
+        Hash.HighPart = Parts[0];
+        Hash.LowPart  = Parts[1];
+        return true;
+    }
+
+    std::string GetFilePath(const XXH128Hash& Hash) const
+    {
+        return m_Directory + HashToFileName(Hash);
+    }
+
+    Uint64 NextUseStamp()
+    {
+        // Use the current time so that the stamps are comparable with the file modification
+        // times of the files that were written by other processes, but keep them strictly
+        // increasing to preserve the access order within the session.
+        const Uint64 Now = static_cast<Uint64>(std::time(nullptr));
+        m_LastUseStamp   = std::max(m_LastUseStamp + 1, Now);
+        return m_LastUseStamp;
+    }
+
+    void MarkFileUsed(const XXH128Hash& Hash)
+    {
+        auto it = m_Files.find(Hash);
+        if (it != m_Files.end())
+            it->second.LastUse = NextUseStamp();
+    }
+
+    // Synchronizes the file list with the cache directory that may have been
+    // modified by other processes.
+    void ScanDirectory()
+    {
+        const auto SearchRes = FileSystem::Search((m_Directory + '*' + BytecodeFileExtension).c_str());
+
+        std::unordered_map<XXH128Hash, FileInfo> Files;
+        Files.reserve(SearchRes.size());
+        m_DirectorySize = 0;
+        for (const auto& File : SearchRes)
+        {
+            XXH128Hash Hash;
+            if (File.IsDirectory || !FileNameToHash(File.Name, Hash))
+                continue;
+
+            FileInfo Info{File.Size, File.LastWriteTime};
+
+            // Keep the access stamps of the files used by this session
+            auto it = m_Files.find(Hash);
+            if (it != m_Files.end())
+                Info.LastUse = std::max(Info.LastUse, it->second.LastUse);
+
+            m_DirectorySize += Info.Size;
+            Files.emplace(Hash, Info);
+        }
+        m_Files = std::move(Files);
+    }
+
+    RefCntAutoPtr<IDataBlob> ReadBytecodeFile(const XXH128Hash& Hash)
+    {
+        const std::string Path = GetFilePath(Hash);
+        if (!FileSystem::FileExists(Path.c_str()))
+            return {};
+
+        RefCntAutoPtr<IDataBlob> pFileData;
+        if (!FileWrapper::ReadWholeFile(Path.c_str(), &pFileData, /*Silent = */ true))
+            return {};
+
+        const size_t FileSize = pFileData->GetSize();
+
+        BytecodeFileHeader Header;
+        bool               IsValid = FileSize >= sizeof(Header);
+        if (IsValid)
+        {
+            memcpy(&Header, pFileData->GetConstDataPtr(), sizeof(Header));
+            IsValid = (Header.Magic == BytecodeFileHeader::HeaderMagic &&
+                       Header.Version == BytecodeFileHeader::HeaderVersion &&
+                       Header.Flags == 0 &&
+                       Header.DataSize == FileSize - sizeof(Header));
+        }
+
+        const void* pData = pFileData->GetConstDataPtr(sizeof(Header));
+        if (IsValid)
+        {
+            XXH128State Hasher;
+            Hasher.UpdateRaw(pData, Header.DataSize);
+            IsValid = Hasher.Digest() == Header.DataHash;
+        }
+
+        if (!IsValid)
+        {
+            LOG_WARNING_MESSAGE("Bytecode cache file '", Path, "' is invalid or corrupted and will be deleted.");
+            DeleteBytecodeFile(Hash);
+            return {};
+        }
+
+        auto& Info = m_Files[Hash];
+        if (Info.Size != FileSize)
+        {
+            // The file was written by another process after the directory was scanned
+            m_DirectorySize = m_DirectorySize - Info.Size + FileSize;
+            Info.Size       = FileSize;
+        }
+        Info.LastUse = NextUseStamp();
+
+        // Reference the byte code in place
+        return ProxyDataBlob::Create(pData, StaticCast<size_t>(Header.DataSize), pFileData);
+    }
+
+    void WriteBytecodeFile(const XXH128Hash& Hash, IDataBlob* pByteCode)
+    {
+        BytecodeFileHeader Header;
+        Header.DataSize = pByteCode->GetSize();
+        {
+            XXH128State Hasher;
+            Hasher.UpdateRaw(pByteCode->GetConstDataPtr(), Header.DataSize);
+            Header.DataHash = Hasher.Digest();
+        }
+
+        std::vector<Uint8> FileData(sizeof(Header) + pByteCode->GetSize());
+        memcpy(FileData.data(), &Header, sizeof(Header));
+        memcpy(FileData.data() + sizeof(Header), pByteCode->GetConstDataPtr(), pByteCode->GetSize());
+
+        // Write the data to a temporary file and then rename it so that other processes
+        // never see a partially written file.
+        const std::string Path    = GetFilePath(Hash);
+        const std::string TmpPath = Path + m_TmpFileSuffix;
+        if (!FileWrapper::WriteFile(TmpPath.c_str(), FileData.data(), FileData.size(), /*Silent = */ true))
+        {
+            LOG_WARNING_MESSAGE("Failed to write bytecode cache file '", TmpPath, "'.");
+            return;
+        }
+
+        if (std::rename(TmpPath.c_str(), Path.c_str()) != 0)
+        {
+            // Rename does not replace existing files on some platforms
+            FileSystem::DeleteFile(Path.c_str());
+            if (std::rename(TmpPath.c_str(), Path.c_str()) != 0)
+            {
+                LOG_WARNING_MESSAGE("Failed to rename bytecode cache file '", TmpPath, "' to '", Path, "'.");
+                FileSystem::DeleteFile(TmpPath.c_str());
+                return;
+            }
+        }
+
+        auto& Info      = m_Files[Hash];
+        m_DirectorySize = m_DirectorySize - Info.Size + FileData.size();
+        Info.Size       = FileData.size();
+        Info.LastUse    = NextUseStamp();
+
+        EvictFiles();
+    }
+
+    void DeleteBytecodeFile(const XXH128Hash& Hash)
+    {
+        const std::string Path = GetFilePath(Hash);
+        if (FileSystem::FileExists(Path.c_str()))
+            FileSystem::DeleteFile(Path.c_str());
+
+        auto it = m_Files.find(Hash);
+        if (it != m_Files.end())
+        {
+            m_DirectorySize -= it->second.Size;
+            m_Files.erase(it);
+        }
+    }
+
+    // Deletes the least recently used files until the directory size fits the limit
+    void EvictFiles()
+    {
+        if (m_MaxDirectorySize == 0 || m_DirectorySize <= m_MaxDirectorySize)
+            return;
+
+        // Other processes may have added or removed files
+        ScanDirectory();
+        if (m_DirectorySize <= m_MaxDirectorySize)
+            return;
+
+        std::vector<std::pair<Uint64, XXH128Hash>> Files;
+        Files.reserve(m_Files.size());
+        for (const auto& it : m_Files)
+            Files.emplace_back(it.second.LastUse, it.first);
+        std::sort(Files.begin(), Files.end(),
+                  [](const std::pair<Uint64, XXH128Hash>& lhs, const std::pair<Uint64, XXH128Hash>& rhs) {
+                      return lhs.first < rhs.first;
+                  });
+
+        for (const auto& File : Files)
+        {
+            if (m_DirectorySize <= m_MaxDirectorySize)
+                break;
+            DeleteBytecodeFile(File.second);
+        }
+    }
+
 private:
     RENDER_DEVICE_TYPE m_DeviceType;
 
     std::unordered_map<XXH128Hash, RefCntAutoPtr<IDataBlob>> m_HashMap;
+
+    // Cache directory, always ends with a slash. Empty if the directory is not used.
+    std::string m_Directory;
+    std::string m_TmpFileSuffix;
+
+    struct FileInfo
+    {
+        Uint64 Size    = 0;
+        Uint64 LastUse = 0;
+    };
+    std::unordered_map<XXH128Hash, FileInfo> m_Files;
+
+    const Uint64 m_MaxDirectorySize;
+    Uint64       m_DirectorySize = 0;
+    Uint64       m_LastUseStamp  = 0;
 };
 
+constexpr char BytecodeCacheImpl::BytecodeFileExtension[];
+
 void CreateBytecodeCache(const BytecodeCacheCreateInfo& CreateInfo,
                          IBytecodeCache**               ppCache)
 {
@@ -0,0 +1,654 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CommandCapture.hpp"
+
+#include <string>
+
+#include "CommandCaptureFormat.hpp"
+#include "GraphicsAccessories.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "FileWrapper.hpp"
+#include "MapHelper.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+using namespace CommandCaptureFormat;
+
+CommandCapture::CommandCapture(IRenderDevice* pDevice, IDeviceContext* pContext) noexcept(false) :
+    m_pDevice{pDevice},
+    m_pContext{pContext}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (m_pContext == nullptr)
+        LOG_ERROR_AND_THROW("Device context must not be null");
+}
+
+CommandCapture::~CommandCapture()
+{
+    if (m_IsInFrame)
+        LOG_WARNING_MESSAGE("Command capture is destroyed in the middle of a frame");
+}
+
+std::vector<Uint8>& CommandCapture::GetStream()
+{
+    return m_IsInFrame ? m_Frames.back() : m_SetupStream;
+}
+
+CommandCapture::ObjectId CommandCapture::AddObject(IObject* pObject)
+{
+    VERIFY_EXPR(pObject != nullptr && m_ObjectIds.find(pObject) == m_ObjectIds.end());
+    const ObjectId Id = static_cast<ObjectId>(m_Objects.size());
+    m_Objects.emplace_back(pObject);
+    m_ObjectIds.emplace(pObject, Id);
+    return Id;
+}
+
+CommandCapture::ObjectId CommandCapture::GetObjectId(IObject* pObject)
+{
+    if (pObject == nullptr)
+        return InvalidObjectId;
+
+    auto it = m_ObjectIds.find(pObject);
+    if (it != m_ObjectIds.end())
+        return it->second;
+
+    // The object was not created through the capture. Record the description
+    // so that the replay can recreate the object without its contents.
+    if (RefCntAutoPtr<ITextureView> pView{pObject, IID_TextureView})
+    {
+        CreateTextureViewCmd Cmd;
+        Cmd.Texture = GetObjectId(pView->GetTexture());
+        Cmd.Desc    = pView->GetDesc();
+        Cmd.Id      = AddObject(pObject);
+        AppendCommand(m_SetupStream, CMD_CREATE_TEXTURE_VIEW, Cmd);
+        return Cmd.Id;
+    }
+    else if (RefCntAutoPtr<IBufferView> pView{pObject, IID_BufferView})
+    {
+        CreateBufferViewCmd Cmd;
+        Cmd.Buffer = GetObjectId(pView->GetBuffer());
+        Cmd.Desc   = pView->GetDesc();
+        Cmd.Id     = AddObject(pObject);
+        AppendCommand(m_SetupStream, CMD_CREATE_BUFFER_VIEW, Cmd);
+        return Cmd.Id;
+    }
+    else if (RefCntAutoPtr<ITexture> pTexture{pObject, IID_Texture})
+    {
+        CreateTextureCmd Cmd;
+        Cmd.Desc = pTexture->GetDesc();
+        Cmd.Id   = AddObject(pObject);
+        AppendCommand(m_SetupStream, CMD_CREATE_TEXTURE, Cmd);
+        return Cmd.Id;
+    }
+    else if (RefCntAutoPtr<IBuffer> pBuffer{pObject, IID_Buffer})
+    {
+        CreateBufferCmd Cmd;
+        Cmd.Desc = pBuffer->GetDesc();
+        Cmd.Id   = AddObject(pObject);
+        AppendCommand(m_SetupStream, CMD_CREATE_BUFFER, Cmd);
+        return Cmd.Id;
+    }
+    else if (RefCntAutoPtr<ISampler> pSampler{pObject, IID_Sampler})
+    {
+        CreateSamplerCmd Cmd;
+        Cmd.Desc = pSampler->GetDesc();
+        Cmd.Id   = AddObject(pObject);
+        AppendCommand(m_SetupStream, CMD_CREATE_SAMPLER, Cmd);
+        return Cmd.Id;
+    }
+
+    RefCntAutoPtr<IDeviceObject> pDeviceObject{pObject, IID_DeviceObject};
+    LOG_ERROR_MESSAGE("Object '", (pDeviceObject ? pDeviceObject->GetDesc().Name : "<unknown>"),
+                      "' was not created through the command capture and can't be recreated on replay");
+    return InvalidObjectId;
+}
+
+void CommandCapture::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer)
+{
+    m_pDevice->CreateBuffer(BuffDesc, pBuffData, ppBuffer);
+    if (*ppBuffer == nullptr)
+        return;
+
+    CreateBufferCmd Cmd;
+    Cmd.Desc = BuffDesc;
+    if (pBuffData != nullptr && pBuffData->pData != nullptr)
+    {
+        Cmd.pData    = pBuffData->pData;
+        Cmd.DataSize = StaticCast<size_t>(pBuffData->DataSize);
+    }
+    Cmd.Id = AddObject(*ppBuffer);
+    AppendCommand(m_SetupStream, CMD_CREATE_BUFFER, Cmd);
+}
+
+void CommandCapture::CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture)
+{
+    m_pDevice->CreateTexture(TexDesc, pData, ppTexture);
+    if (*ppTexture == nullptr)
+        return;
+
+    std::vector<CreateTextureCmd::SubresourceData> Subresources;
+    if (pData != nullptr && pData->NumSubresources > 0)
+    {
+        const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+        const Uint32                NumSlices  = TexDesc.GetArraySize();
+        if (pData->NumSubresources == NumSlices * TexDesc.MipLevels)
+        {
+            Subresources.resize(pData->NumSubresources);
+            for (Uint32 Slice = 0, Subres = 0; Slice < NumSlices; ++Slice)
+            {
+                for (Uint32 Mip = 0; Mip < TexDesc.MipLevels; ++Mip, ++Subres)
+                {
+                    const TextureSubResData& SrcSubres = pData->pSubResources[Subres];
+                    if (SrcSubres.pData == nullptr)
+                    {
+                        LOG_WARNING_MESSAGE("Texture '", TexDesc.Name, "': subresource ", Subres,
+                                            " is initialized from a buffer. Its contents will not be captured.");
+                        continue;
+                    }
+
+                    const MipLevelProperties MipProps = GetMipLevelProperties(TexDesc, Mip);
+                    const Uint32             NumRows  = MipProps.StorageHeight / FmtAttribs.BlockHeight;
+
+                    CreateTextureCmd::SubresourceData& DstSubres = Subresources[Subres];
+                    DstSubres.Stride                             = SrcSubres.Stride;
+                    DstSubres.DepthStride                        = SrcSubres.DepthStride;
+                    DstSubres.pData                              = SrcSubres.pData;
+                    DstSubres.DataSize                           = StaticCast<size_t>((MipProps.Depth - 1) * SrcSubres.DepthStride +
+                                                                                      (NumRows - 1) * SrcSubres.Stride +
+                                                                                      MipProps.RowSize);
+                }
+            }
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Texture '", TexDesc.Name, "': the number of initial subresources (", pData->NumSubresources,
+                                ") does not match the number of texture subresources. The contents will not be captured.");
+        }
+    }
+
+    CreateTextureCmd Cmd;
+    Cmd.Desc            = TexDesc;
+    Cmd.pSubresources   = Subresources.data();
+    Cmd.NumSubresources = static_cast<Uint32>(Subresources.size());
+    Cmd.Id              = AddObject(*ppTexture);
+    AppendCommand(m_SetupStream, CMD_CREATE_TEXTURE, Cmd);
+}
+
+void CommandCapture::CreateSampler(const SamplerDesc& SamDesc, ISampler** ppSampler)
+{
+    m_pDevice->CreateSampler(SamDesc, ppSampler);
+    if (*ppSampler == nullptr)
+        return;
+
+    CreateSamplerCmd Cmd;
+    Cmd.Desc = SamDesc;
+    Cmd.Id   = AddObject(*ppSampler);
+    AppendCommand(m_SetupStream, CMD_CREATE_SAMPLER, Cmd);
+}
+
+void CommandCapture::CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader, IDataBlob** ppCompilerOutput)
+{
+    m_pDevice->CreateShader(ShaderCI, ppShader, ppCompilerOutput);
+    if (*ppShader == nullptr)
+        return;
+
+    CreateShaderCmd Cmd;
+    Cmd.CI = ShaderCI;
+
+    // Make the shader self-contained: the replay has no access to the source files.
+    std::string Source;
+    if (ShaderCI.ByteCode == nullptr)
+    {
+        if (ShaderCI.pShaderSourceStreamFactory != nullptr)
+        {
+            Source = UnrollShaderIncludes(ShaderCI);
+        }
+        else
+        {
+            VERIFY(ShaderCI.Source != nullptr, "Shader source must not be null");
+            Source.assign(ShaderCI.Source, ShaderCI.SourceLength != 0 ? ShaderCI.SourceLength : strlen(ShaderCI.Source));
+        }
+        Cmd.CI.Source       = Source.c_str();
+        Cmd.CI.SourceLength = Source.length();
+    }
+    Cmd.CI.FilePath                   = nullptr;
+    Cmd.CI.pShaderSourceStreamFactory = nullptr;
+
+    Cmd.Id = AddObject(*ppShader);
+    AppendCommand(m_SetupStream, CMD_CREATE_SHADER, Cmd);
+}
+
+void CommandCapture::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, ppPipelineState);
+    if (*ppPipelineState == nullptr)
+        return;
+
+    if (PSOCreateInfo.ResourceSignaturesCount != 0 || PSOCreateInfo.GraphicsPipeline.pRenderPass != nullptr)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", PSOCreateInfo.PSODesc.Name,
+                          "' uses explicit resource signatures or a render pass, which are not supported by the command capture");
+        return;
+    }
+
+    CreateGraphicsPipelineCmd Cmd;
+    Cmd.CI = PSOCreateInfo;
+
+    IShader* const Shaders[] = {
+        PSOCreateInfo.pVS,
+        PSOCreateInfo.pPS,
+        PSOCreateInfo.pGS,
+        PSOCreateInfo.pHS,
+        PSOCreateInfo.pDS,
+        PSOCreateInfo.pAS,
+        PSOCreateInfo.pMS,
+    };
+    static_assert(_countof(Shaders) == CreateGraphicsPipelineCmd::SHADER_SLOT_COUNT, "Please update the shader list");
+    for (size_t i = 0; i < _countof(Shaders); ++i)
+        Cmd.Shaders[i] = GetObjectId(Shaders[i]);
+
+    Cmd.Id = AddObject(*ppPipelineState);
+    AppendCommand(m_SetupStream, CMD_CREATE_GRAPHICS_PIPELINE, Cmd);
+}
+
+void CommandCapture::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, ppPipelineState);
+    if (*ppPipelineState == nullptr)
+        return;
+
+    if (PSOCreateInfo.ResourceSignaturesCount != 0)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", PSOCreateInfo.PSODesc.Name,
+                          "' uses explicit resource signatures, which are not supported by the command capture");
+        return;
+    }
+
+    CreateComputePipelineCmd Cmd;
+    Cmd.CI = PSOCreateInfo;
+    Cmd.CS = GetObjectId(PSOCreateInfo.pCS);
+    Cmd.Id = AddObject(*ppPipelineState);
+    AppendCommand(m_SetupStream, CMD_CREATE_COMPUTE_PIPELINE, Cmd);
+}
+
+void CommandCapture::CreateShaderResourceBinding(IPipelineState* pPSO, IShaderResourceBinding** ppSRB, bool InitStaticResources)
+{
+    VERIFY_EXPR(pPSO != nullptr);
+    pPSO->CreateShaderResourceBinding(ppSRB, InitStaticResources);
+    if (*ppSRB == nullptr)
+        return;
+
+    CreateSRBCmd Cmd;
+    Cmd.PSO                 = GetObjectId(pPSO);
+    Cmd.InitStaticResources = InitStaticResources;
+    Cmd.Id                  = AddObject(*ppSRB);
+    AppendCommand(m_SetupStream, CMD_CREATE_SRB, Cmd);
+}
+
+void CommandCapture::RecordSetVariable(bool IsStatic, ObjectId Owner, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject, Uint32 ArrayIndex)
+{
+    SetVariableCmd Cmd;
+    Cmd.Owner      = Owner;
+    Cmd.ShaderType = ShaderType;
+    Cmd.Name       = Name;
+    Cmd.Object     = GetObjectId(pObject);
+    Cmd.ArrayIndex = ArrayIndex;
+    AppendCommand(GetStream(), IsStatic ? CMD_SET_STATIC_VARIABLE : CMD_SET_SRB_VARIABLE, Cmd);
+}
+
+void CommandCapture::SetStaticVariable(IPipelineState* pPSO, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject, Uint32 ArrayIndex)
+{
+    VERIFY_EXPR(pPSO != nullptr && Name != nullptr);
+    IShaderResourceVariable* pVar = pPSO->GetStaticVariableByName(ShaderType, Name);
+    if (pVar == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Static variable '", Name, "' is not found in pipeline '", pPSO->GetDesc().Name, "'");
+        return;
+    }
+    pVar->SetArray(&pObject, ArrayIndex, 1);
+    RecordSetVariable(true, GetObjectId(pPSO), ShaderType, Name, pObject, ArrayIndex);
+}
+
+void CommandCapture::SetVariable(IShaderResourceBinding* pSRB, SHADER_TYPE ShaderType, const char* Name, IDeviceObject* pObject, Uint32 ArrayIndex)
+{
+    VERIFY_EXPR(pSRB != nullptr && Name != nullptr);
+    IShaderResourceVariable* pVar = pSRB->GetVariableByName(ShaderType, Name);
+    if (pVar == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Variable '", Name, "' is not found in the shader resource binding");
+        return;
+    }
+    pVar->SetArray(&pObject, ArrayIndex, 1);
+    RecordSetVariable(false, GetObjectId(pSRB), ShaderType, Name, pObject, ArrayIndex);
+}
+
+void CommandCapture::BeginFrame()
+{
+    DEV_CHECK_ERR(!m_IsInFrame, "BeginFrame() must not be called twice without EndFrame()");
+    m_Frames.emplace_back();
+    m_IsInFrame = true;
+}
+
+void CommandCapture::EndFrame()
+{
+    DEV_CHECK_ERR(m_IsInFrame, "EndFrame() must be called after BeginFrame()");
+    m_IsInFrame = false;
+}
+
+void CommandCapture::SetPipelineState(IPipelineState* pPipelineState)
+{
+    m_pContext->SetPipelineState(pPipelineState);
+
+    SetPipelineStateCmd Cmd;
+    Cmd.PSO = GetObjectId(pPipelineState);
+    AppendCommand(GetStream(), CMD_SET_PIPELINE_STATE, Cmd);
+}
+
+void CommandCapture::CommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->CommitShaderResources(pSRB, StateTransitionMode);
+
+    CommitShaderResourcesCmd Cmd;
+    Cmd.SRB            = GetObjectId(pSRB);
+    Cmd.TransitionMode = StateTransitionMode;
+    AppendCommand(GetStream(), CMD_COMMIT_SHADER_RESOURCES, Cmd);
+}
+
+void CommandCapture::SetVertexBuffers(Uint32                         StartSlot,
+                                      Uint32                         NumBuffersSet,
+                                      IBuffer* const*                ppBuffers,
+                                      const Uint64*                  pOffsets,
+                                      RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                      SET_VERTEX_BUFFERS_FLAGS       Flags)
+{
+    m_pContext->SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+
+    std::vector<ObjectId> Buffers(NumBuffersSet);
+    std::vector<Uint64>   Offsets(NumBuffersSet);
+    for (Uint32 i = 0; i < NumBuffersSet; ++i)
+    {
+        Buffers[i] = GetObjectId(ppBuffers != nullptr ? ppBuffers[i] : nullptr);
+        Offsets[i] = pOffsets != nullptr ? pOffsets[i] : 0;
+    }
+
+    SetVertexBuffersCmd Cmd;
+    Cmd.StartSlot      = StartSlot;
+    Cmd.NumBuffers     = NumBuffersSet;
+    Cmd.pBuffers       = Buffers.data();
+    Cmd.pOffsets       = Offsets.data();
+    Cmd.TransitionMode = StateTransitionMode;
+    Cmd.Flags          = Flags;
+    AppendCommand(GetStream(), CMD_SET_VERTEX_BUFFERS, Cmd);
+}
+
+void CommandCapture::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+
+    SetIndexBufferCmd Cmd;
+    Cmd.Buffer         = GetObjectId(pIndexBuffer);
+    Cmd.Offset         = ByteOffset;
+    Cmd.TransitionMode = StateTransitionMode;
+    AppendCommand(GetStream(), CMD_SET_INDEX_BUFFER, Cmd);
+}
+
+void CommandCapture::SetRenderTargets(Uint32                         NumRenderTargets,
+                                      ITextureView*                  ppRenderTargets[],
+                                      ITextureView*                  pDepthStencil,
+                                      RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil, StateTransitionMode);
+
+    std::vector<ObjectId> RenderTargets(NumRenderTargets);
+    for (Uint32 i = 0; i < NumRenderTargets; ++i)
+        RenderTargets[i] = GetObjectId(ppRenderTargets[i]);
+
+    SetRenderTargetsCmd Cmd;
+    Cmd.NumRenderTargets = NumRenderTargets;
+    Cmd.pRenderTargets   = RenderTargets.data();
+    Cmd.DepthStencil     = GetObjectId(pDepthStencil);
+    Cmd.TransitionMode   = StateTransitionMode;
+    AppendCommand(GetStream(), CMD_SET_RENDER_TARGETS, Cmd);
+}
+
+void CommandCapture::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
+{
+    m_pContext->SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+
+    SetViewportsCmd Cmd;
+    Cmd.NumViewports = pViewports != nullptr ? NumViewports : 0;
+    Cmd.pViewports   = pViewports;
+    Cmd.RTWidth      = RTWidth;
+    Cmd.RTHeight     = RTHeight;
+    AppendCommand(GetStream(), CMD_SET_VIEWPORTS, Cmd);
+}
+
+void CommandCapture::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
+{
+    m_pContext->SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+
+    SetScissorRectsCmd Cmd;
+    Cmd.NumRects = pRects != nullptr ? NumRects : 0;
+    Cmd.pRects   = pRects;
+    Cmd.RTWidth  = RTWidth;
+    Cmd.RTHeight = RTHeight;
+    AppendCommand(GetStream(), CMD_SET_SCISSOR_RECTS, Cmd);
+}
+
+void CommandCapture::SetStencilRef(Uint32 StencilRef)
+{
+    m_pContext->SetStencilRef(StencilRef);
+
+    SetStencilRefCmd Cmd;
+    Cmd.StencilRef = StencilRef;
+    AppendCommand(GetStream(), CMD_SET_STENCIL_REF, Cmd);
+}
+
+void CommandCapture::SetBlendFactors(const float* pBlendFactors)
+{
+    m_pContext->SetBlendFactors(pBlendFactors);
+
+    ColorCmd Cmd;
+    Cmd.HasColor = pBlendFactors != nullptr;
+    if (pBlendFactors != nullptr)
+        memcpy(Cmd.Color, pBlendFactors, sizeof(Cmd.Color));
+    AppendCommand(GetStream(), CMD_SET_BLEND_FACTORS, Cmd);
+}
+
+void CommandCapture::ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->ClearRenderTarget(pView, RGBA, StateTransitionMode);
+
+    ClearRenderTargetCmd Cmd;
+    Cmd.View = GetObjectId(pView);
+    if (RGBA != nullptr)
+        memcpy(Cmd.Color, RGBA, sizeof(Cmd.Color));
+    Cmd.TransitionMode = StateTransitionMode;
+    AppendCommand(GetStream(), CMD_CLEAR_RENDER_TARGET, Cmd);
+}
+
+void CommandCapture::ClearDepthStencil(ITextureView*                  pView,
+                                       CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                                       float                          fDepth,
+                                       Uint8                          Stencil,
+                                       RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->ClearDepthStencil(pView, ClearFlags, fDepth, Stencil, StateTransitionMode);
+
+    ClearDepthStencilCmd Cmd;
+    Cmd.View           = GetObjectId(pView);
+    Cmd.ClearFlags     = ClearFlags;
+    Cmd.Depth          = fDepth;
+    Cmd.Stencil        = Stencil;
+    Cmd.TransitionMode = StateTransitionMode;
+    AppendCommand(GetStream(), CMD_CLEAR_DEPTH_STENCIL, Cmd);
+}
+
+void CommandCapture::Draw(const DrawAttribs& Attribs)
+{
+    m_pContext->Draw(Attribs);
+
+    AttribsCmd<DrawAttribs> Cmd{Attribs};
+    AppendCommand(GetStream(), CMD_DRAW, Cmd);
+}
+
+void CommandCapture::DrawIndexed(const DrawIndexedAttribs& Attribs)
+{
+    m_pContext->DrawIndexed(Attribs);
+
+    AttribsCmd<DrawIndexedAttribs> Cmd{Attribs};
+    AppendCommand(GetStream(), CMD_DRAW_INDEXED, Cmd);
+}
+
+void CommandCapture::DispatchCompute(const DispatchComputeAttribs& Attribs)
+{
+    m_pContext->DispatchCompute(Attribs);
+
+    AttribsCmd<DispatchComputeAttribs> Cmd{Attribs};
+    AppendCommand(GetStream(), CMD_DISPATCH_COMPUTE, Cmd);
+}
+
+void CommandCapture::UpdateBuffer(IBuffer* pBuffer, Uint64 Offset, Uint64 Size, const void* pData, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    m_pContext->UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
+
+    UpdateBufferCmd Cmd;
+    Cmd.Buffer         = GetObjectId(pBuffer);
+    Cmd.Offset         = Offset;
+    Cmd.pData          = pData;
+    Cmd.DataSize       = StaticCast<size_t>(Size);
+    Cmd.TransitionMode = StateTransitionMode;
+    AppendCommand(GetStream(), CMD_UPDATE_BUFFER, Cmd);
+}
+
+void CommandCapture::WriteDynamicBuffer(IBuffer* pBuffer, const void* pData, Uint64 Size)
+{
+    VERIFY_EXPR(pBuffer != nullptr && pData != nullptr);
+    {
+        MapHelper<Uint8> MappedData{m_pContext, pBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+        if (!MappedData)
+        {
+            LOG_ERROR_MESSAGE("Failed to map buffer '", pBuffer->GetDesc().Name, "'");
+            return;
+        }
+        memcpy(MappedData, pData, StaticCast<size_t>(Size));
+    }
+
+    UpdateBufferCmd Cmd;
+    Cmd.Buffer   = GetObjectId(pBuffer);
+    Cmd.pData    = pData;
+    Cmd.DataSize = StaticCast<size_t>(Size);
+    AppendCommand(GetStream(), CMD_WRITE_DYNAMIC_BUFFER, Cmd);
+}
+
+void CommandCapture::CopyBuffer(IBuffer*                       pSrcBuffer,
+                                Uint64                         SrcOffset,
+                                RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                                IBuffer*                       pDstBuffer,
+                                Uint64                         DstOffset,
+                                Uint64                         Size,
+                                RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
+{
+    m_pContext->CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+
+    CopyBufferCmd Cmd;
+    Cmd.SrcBuffer         = GetObjectId(pSrcBuffer);
+    Cmd.SrcOffset         = SrcOffset;
+    Cmd.SrcTransitionMode = SrcBufferTransitionMode;
+    Cmd.DstBuffer         = GetObjectId(pDstBuffer);
+    Cmd.DstOffset         = DstOffset;
+    Cmd.Size              = Size;
+    Cmd.DstTransitionMode = DstBufferTransitionMode;
+    AppendCommand(GetStream(), CMD_COPY_BUFFER, Cmd);
+}
+
+void CommandCapture::BeginDebugGroup(const char* Name, const float* pColor)
+{
+    m_pContext->BeginDebugGroup(Name, pColor);
+
+    ColorCmd Cmd;
+    Cmd.Name     = Name;
+    Cmd.HasColor = pColor != nullptr;
+    if (pColor != nullptr)
+        memcpy(Cmd.Color, pColor, sizeof(Cmd.Color));
+    AppendCommand(GetStream(), CMD_BEGIN_DEBUG_GROUP, Cmd);
+}
+
+void CommandCapture::EndDebugGroup()
+{
+    m_pContext->EndDebugGroup();
+
+    EmptyCmd Cmd;
+    AppendCommand(GetStream(), CMD_END_DEBUG_GROUP, Cmd);
+}
+
+SerializedData CommandCapture::Serialize(IMemoryAllocator& Allocator) const
+{
+    DEV_CHECK_ERR(!m_IsInFrame, "The capture must not be serialized in the middle of a frame");
+
+    auto SerializeCapture = [this](auto& Ser) {
+        const Uint32 NumObjects = static_cast<Uint32>(m_Objects.size());
+        const Uint32 NumFrames  = static_cast<Uint32>(m_Frames.size());
+
+        bool Res = Ser(Magic, CommandCaptureFormat::Version, NumObjects);
+        Res      = Res && Ser.SerializeBytes(m_SetupStream.data(), m_SetupStream.size());
+        Res      = Res && Ser(NumFrames);
+        for (Uint32 i = 0; i < NumFrames && Res; ++i)
+            Res = Ser.SerializeBytes(m_Frames[i].data(), m_Frames[i].size());
+        return Res;
+    };
+
+    Serializer<SerializerMode::Measure> MeasureSer;
+    SerializeCapture(MeasureSer);
+
+    SerializedData                    Data = MeasureSer.AllocateData(Allocator);
+    Serializer<SerializerMode::Write> WriteSer{Data};
+    if (!SerializeCapture(WriteSer))
+    {
+        UNEXPECTED("Failed to serialize the command capture");
+        return {};
+    }
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    return Data;
+}
+
+bool CommandCapture::SaveToFile(const char* FilePath) const
+{
+    const SerializedData Data = Serialize(DefaultRawMemoryAllocator::GetAllocator());
+    if (!Data)
+        return false;
+
+    return FileWrapper::WriteFile(FilePath, Data.Ptr(), Data.Size());
+}
+
+} // namespace Diligent
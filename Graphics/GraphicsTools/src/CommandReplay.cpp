@@ -0,0 +1,689 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "CommandReplay.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <memory>
+
+#include "CommandCaptureFormat.hpp"
+#include "DurationQueryHelper.hpp"
+#include "FileWrapper.hpp"
+#include "MapHelper.hpp"
+#include "Timer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+using namespace CommandCaptureFormat;
+
+CommandReplay::CommandReplay(IRenderDevice* pDevice, IDeviceContext* pContext, const void* pData, size_t DataSize) noexcept(false) :
+    m_pDevice{pDevice},
+    m_pContext{pContext},
+    m_Data{static_cast<const Uint8*>(pData), static_cast<const Uint8*>(pData) + DataSize},
+    m_Allocator{DefaultRawMemoryAllocator::GetAllocator()}
+{
+    Initialize();
+}
+
+CommandReplay::CommandReplay(IRenderDevice* pDevice, IDeviceContext* pContext, const char* FilePath) noexcept(false) :
+    m_pDevice{pDevice},
+    m_pContext{pContext},
+    m_Allocator{DefaultRawMemoryAllocator::GetAllocator()}
+{
+    if (FilePath == nullptr || !FileWrapper::ReadWholeFile(FilePath, m_Data))
+        LOG_ERROR_AND_THROW("Failed to read command capture file '", (FilePath != nullptr ? FilePath : "<null>"), "'");
+
+    Initialize();
+}
+
+CommandReplay::~CommandReplay()
+{
+}
+
+void CommandReplay::Initialize()
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (m_pContext == nullptr)
+        LOG_ERROR_AND_THROW("Device context must not be null");
+
+    SerializedData                   Data{m_Data.data(), m_Data.size()};
+    Serializer<SerializerMode::Read> Ser{Data};
+
+    Uint32 FileMagic   = 0;
+    Uint32 FileVersion = 0;
+    Uint32 NumObjects  = 0;
+    if (!Ser(FileMagic, FileVersion, NumObjects) || FileMagic != Magic)
+        LOG_ERROR_AND_THROW("The data is not a valid command capture");
+    if (FileVersion != CommandCaptureFormat::Version)
+        LOG_ERROR_AND_THROW("Command capture version ", FileVersion, " is not supported. Expected version: ", CommandCaptureFormat::Version);
+
+    const void* pSetupStream = nullptr;
+    Uint32      NumFrames    = 0;
+    if (!Ser.SerializeBytes(pSetupStream, m_SetupStream.Size) || !Ser(NumFrames))
+        LOG_ERROR_AND_THROW("Failed to read the command capture setup stream");
+    m_SetupStream.pData = static_cast<const Uint8*>(pSetupStream);
+
+    m_Frames.resize(NumFrames);
+    for (StreamData& Frame : m_Frames)
+    {
+        const void* pFrameData = nullptr;
+        if (!Ser.SerializeBytes(pFrameData, Frame.Size))
+            LOG_ERROR_AND_THROW("Failed to read the command capture frame data");
+        Frame.pData = static_cast<const Uint8*>(pFrameData);
+    }
+
+    m_Objects.resize(NumObjects);
+    if (!ExecuteStream(m_SetupStream.pData, m_SetupStream.Size))
+        LOG_ERROR_AND_THROW("Failed to execute the command capture setup stream");
+}
+
+bool CommandReplay::SetObject(Uint32 Id, IObject* pObject, const INTERFACE_ID& IID)
+{
+    if (Id >= m_Objects.size())
+    {
+        LOG_ERROR_MESSAGE("Object id ", Id, " is out of range");
+        return false;
+    }
+    if (pObject == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to recreate object ", Id);
+        return false;
+    }
+    m_Objects[Id].pObject = pObject;
+    m_Objects[Id].IID     = IID;
+    return true;
+}
+
+template <typename InterfaceType>
+InterfaceType* CommandReplay::GetTypedObject(Uint32 Id, const INTERFACE_ID& IID) const
+{
+    if (Id == InvalidObjectId)
+        return nullptr;
+
+    if (Id >= m_Objects.size() || m_Objects[Id].IID != IID)
+    {
+        LOG_ERROR_MESSAGE("Object id ", Id, " is invalid or references an object of unexpected type");
+        return nullptr;
+    }
+
+    return static_cast<InterfaceType*>(m_Objects[Id].pObject.RawPtr());
+}
+
+bool CommandReplay::ExecuteStream(const Uint8* pData, size_t Size)
+{
+    size_t Offset = 0;
+    while (Offset < Size)
+    {
+        if (Offset + sizeof(CommandHeader) > Size)
+        {
+            LOG_ERROR_MESSAGE("Unexpected end of the command stream");
+            return false;
+        }
+
+        CommandHeader Header;
+        memcpy(&Header, pData + Offset, sizeof(Header));
+        Offset += sizeof(Header);
+        if (Offset + Header.Size > Size)
+        {
+            LOG_ERROR_MESSAGE("Unexpected end of the command stream");
+            return false;
+        }
+
+        const bool Res = ExecuteCommand(Header.Cmd, pData + Offset, Header.Size);
+        m_Allocator.Discard();
+        if (!Res)
+        {
+            LOG_ERROR_MESSAGE("Failed to execute command ", Uint32{Header.Cmd});
+            return false;
+        }
+
+        Offset += AlignUp(size_t{Header.Size}, size_t{8});
+    }
+
+    return true;
+}
+
+bool CommandReplay::ExecuteCommand(Uint32 Cmd, const void* pPayload, size_t PayloadSize)
+{
+    SerializedData                   Payload{const_cast<void*>(pPayload), PayloadSize};
+    Serializer<SerializerMode::Read> Ser{Payload};
+
+    auto ReadCmd = [&](auto& CmdData) {
+        return CmdData.Serialize(Ser, &m_Allocator) && Ser.IsEnded();
+    };
+
+    IDeviceContext* const pCtx = m_pContext;
+
+    switch (Cmd)
+    {
+        case CMD_CREATE_BUFFER:
+        {
+            CreateBufferCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            BufferData InitData{Data.pData, Data.DataSize};
+
+            RefCntAutoPtr<IBuffer> pBuffer;
+            m_pDevice->CreateBuffer(Data.Desc, Data.pData != nullptr ? &InitData : nullptr, &pBuffer);
+            return SetObject(Data.Id, pBuffer, IID_Buffer);
+        }
+
+        case CMD_CREATE_TEXTURE:
+        {
+            CreateTextureCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            std::vector<TextureSubResData> Subresources(Data.NumSubresources);
+            for (Uint32 i = 0; i < Data.NumSubresources; ++i)
+            {
+                const CreateTextureCmd::SubresourceData& Subres = Data.pSubresources[i];
+                Subresources[i]                                 = TextureSubResData{Subres.pData, Subres.Stride, Subres.DepthStride};
+            }
+            TextureData InitData{Subresources.data(), Data.NumSubresources};
+
+            RefCntAutoPtr<ITexture> pTexture;
+            m_pDevice->CreateTexture(Data.Desc, Data.NumSubresources > 0 ? &InitData : nullptr, &pTexture);
+            return SetObject(Data.Id, pTexture, IID_Texture);
+        }
+
+        case CMD_CREATE_BUFFER_VIEW:
+        {
+            CreateBufferViewCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            IBuffer* pBuffer = GetTypedObject<IBuffer>(Data.Buffer, IID_Buffer);
+            if (pBuffer == nullptr)
+                return false;
+
+            RefCntAutoPtr<IBufferView> pView;
+            pBuffer->CreateView(Data.Desc, &pView);
+            return SetObject(Data.Id, pView, IID_BufferView);
+        }
+
+        case CMD_CREATE_TEXTURE_VIEW:
+        {
+            CreateTextureViewCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            ITexture* pTexture = GetTypedObject<ITexture>(Data.Texture, IID_Texture);
+            if (pTexture == nullptr)
+                return false;
+
+            RefCntAutoPtr<ITextureView> pView;
+            pTexture->CreateView(Data.Desc, &pView);
+            return SetObject(Data.Id, pView, IID_TextureView);
+        }
+
+        case CMD_CREATE_SAMPLER:
+        {
+            CreateSamplerCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            RefCntAutoPtr<ISampler> pSampler;
+            m_pDevice->CreateSampler(Data.Desc, &pSampler);
+            return SetObject(Data.Id, pSampler, IID_Sampler);
+        }
+
+        case CMD_CREATE_SHADER:
+        {
+            CreateShaderCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            RefCntAutoPtr<IShader> pShader;
+            m_pDevice->CreateShader(Data.CI, &pShader);
+            return SetObject(Data.Id, pShader, IID_Shader);
+        }
+
+        case CMD_CREATE_GRAPHICS_PIPELINE:
+        {
+            CreateGraphicsPipelineCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            IShader** ppShaders[] = {
+                &Data.CI.pVS,
+                &Data.CI.pPS,
+                &Data.CI.pGS,
+                &Data.CI.pHS,
+                &Data.CI.pDS,
+                &Data.CI.pAS,
+                &Data.CI.pMS,
+            };
+            static_assert(_countof(ppShaders) == CreateGraphicsPipelineCmd::SHADER_SLOT_COUNT, "Please update the shader list");
+            for (size_t i = 0; i < _countof(ppShaders); ++i)
+                *ppShaders[i] = GetTypedObject<IShader>(Data.Shaders[i], IID_Shader);
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            m_pDevice->CreateGraphicsPipelineState(Data.CI, &pPSO);
+            return SetObject(Data.Id, pPSO, IID_PipelineState);
+        }
+
+        case CMD_CREATE_COMPUTE_PIPELINE:
+        {
+            CreateComputePipelineCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            Data.CI.pCS = GetTypedObject<IShader>(Data.CS, IID_Shader);
+
+            RefCntAutoPtr<IPipelineState> pPSO;
+            m_pDevice->CreateComputePipelineState(Data.CI, &pPSO);
+            return SetObject(Data.Id, pPSO, IID_PipelineState);
+        }
+
+        case CMD_CREATE_SRB:
+        {
+            CreateSRBCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            IPipelineState* pPSO = GetTypedObject<IPipelineState>(Data.PSO, IID_PipelineState);
+            if (pPSO == nullptr)
+                return false;
+
+            RefCntAutoPtr<IShaderResourceBinding> pSRB;
+            pPSO->CreateShaderResourceBinding(&pSRB, Data.InitStaticResources);
+            return SetObject(Data.Id, pSRB, IID_ShaderResourceBinding);
+        }
+
+        case CMD_SET_STATIC_VARIABLE:
+        case CMD_SET_SRB_VARIABLE:
+        {
+            SetVariableCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            IShaderResourceVariable* pVar = nullptr;
+            if (Cmd == CMD_SET_STATIC_VARIABLE)
+            {
+                if (IPipelineState* pPSO = GetTypedObject<IPipelineState>(Data.Owner, IID_PipelineState))
+                    pVar = pPSO->GetStaticVariableByName(Data.ShaderType, Data.Name);
+            }
+            else
+            {
+                if (IShaderResourceBinding* pSRB = GetTypedObject<IShaderResourceBinding>(Data.Owner, IID_ShaderResourceBinding))
+                    pVar = pSRB->GetVariableByName(Data.ShaderType, Data.Name);
+            }
+            if (pVar == nullptr)
+            {
+                LOG_ERROR_MESSAGE("Shader variable '", (Data.Name != nullptr ? Data.Name : "<null>"), "' is not found");
+                return false;
+            }
+
+            IDeviceObject* pObject = nullptr;
+            if (Data.Object != InvalidObjectId)
+            {
+                if (Data.Object >= m_Objects.size())
+                    return false;
+
+                const ObjectInfo& Obj = m_Objects[Data.Object];
+                if (Obj.IID != IID_Buffer && Obj.IID != IID_BufferView && Obj.IID != IID_TextureView && Obj.IID != IID_Sampler)
+                {
+                    LOG_ERROR_MESSAGE("Object ", Data.Object, " can't be bound to a shader variable");
+                    return false;
+                }
+                pObject = static_cast<IDeviceObject*>(Obj.pObject.RawPtr());
+            }
+            pVar->SetArray(&pObject, Data.ArrayIndex, 1);
+            return true;
+        }
+
+        case CMD_SET_PIPELINE_STATE:
+        {
+            SetPipelineStateCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            IPipelineState* pPSO = GetTypedObject<IPipelineState>(Data.PSO, IID_PipelineState);
+            if (pPSO == nullptr)
+                return false;
+
+            pCtx->SetPipelineState(pPSO);
+            return true;
+        }
+
+        case CMD_COMMIT_SHADER_RESOURCES:
+        {
+            CommitShaderResourcesCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->CommitShaderResources(GetTypedObject<IShaderResourceBinding>(Data.SRB, IID_ShaderResourceBinding), Data.TransitionMode);
+            return true;
+        }
+
+        case CMD_SET_VERTEX_BUFFERS:
+        {
+            SetVertexBuffersCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            IBuffer** ppBuffers = m_Allocator.ConstructArray<IBuffer*>(Data.NumBuffers);
+            for (Uint32 i = 0; i < Data.NumBuffers; ++i)
+                ppBuffers[i] = GetTypedObject<IBuffer>(Data.pBuffers[i], IID_Buffer);
+
+            pCtx->SetVertexBuffers(Data.StartSlot, Data.NumBuffers, ppBuffers, Data.pOffsets, Data.TransitionMode, Data.Flags);
+            return true;
+        }
+
+        case CMD_SET_INDEX_BUFFER:
+        {
+            SetIndexBufferCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->SetIndexBuffer(GetTypedObject<IBuffer>(Data.Buffer, IID_Buffer), Data.Offset, Data.TransitionMode);
+            return true;
+        }
+
+        case CMD_SET_RENDER_TARGETS:
+        {
+            SetRenderTargetsCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            ITextureView** ppRTVs = m_Allocator.ConstructArray<ITextureView*>(Data.NumRenderTargets);
+            for (Uint32 i = 0; i < Data.NumRenderTargets; ++i)
+                ppRTVs[i] = GetTypedObject<ITextureView>(Data.pRenderTargets[i], IID_TextureView);
+
+            pCtx->SetRenderTargets(Data.NumRenderTargets, ppRTVs, GetTypedObject<ITextureView>(Data.DepthStencil, IID_TextureView), Data.TransitionMode);
+            return true;
+        }
+
+        case CMD_SET_VIEWPORTS:
+        {
+            SetViewportsCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->SetViewports(Data.NumViewports, Data.pViewports, Data.RTWidth, Data.RTHeight);
+            return true;
+        }
+
+        case CMD_SET_SCISSOR_RECTS:
+        {
+            SetScissorRectsCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->SetScissorRects(Data.NumRects, Data.pRects, Data.RTWidth, Data.RTHeight);
+            return true;
+        }
+
+        case CMD_SET_STENCIL_REF:
+        {
+            SetStencilRefCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->SetStencilRef(Data.StencilRef);
+            return true;
+        }
+
+        case CMD_SET_BLEND_FACTORS:
+        {
+            ColorCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->SetBlendFactors(Data.HasColor ? Data.Color : nullptr);
+            return true;
+        }
+
+        case CMD_CLEAR_RENDER_TARGET:
+        {
+            ClearRenderTargetCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->ClearRenderTarget(GetTypedObject<ITextureView>(Data.View, IID_TextureView), Data.Color, Data.TransitionMode);
+            return true;
+        }
+
+        case CMD_CLEAR_DEPTH_STENCIL:
+        {
+            ClearDepthStencilCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->ClearDepthStencil(GetTypedObject<ITextureView>(Data.View, IID_TextureView), Data.ClearFlags, Data.Depth, Data.Stencil, Data.TransitionMode);
+            return true;
+        }
+
+        case CMD_DRAW:
+        {
+            AttribsCmd<DrawAttribs> Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->Draw(Data.Attribs);
+            return true;
+        }
+
+        case CMD_DRAW_INDEXED:
+        {
+            AttribsCmd<DrawIndexedAttribs> Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->DrawIndexed(Data.Attribs);
+            return true;
+        }
+
+        case CMD_DISPATCH_COMPUTE:
+        {
+            AttribsCmd<DispatchComputeAttribs> Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->DispatchCompute(Data.Attribs);
+            return true;
+        }
+
+        case CMD_UPDATE_BUFFER:
+        case CMD_WRITE_DYNAMIC_BUFFER:
+        {
+            UpdateBufferCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            IBuffer* pBuffer = GetTypedObject<IBuffer>(Data.Buffer, IID_Buffer);
+            if (pBuffer == nullptr)
+                return false;
+
+            if (Cmd == CMD_UPDATE_BUFFER)
+            {
+                pCtx->UpdateBuffer(pBuffer, Data.Offset, Data.DataSize, Data.pData, Data.TransitionMode);
+            }
+            else
+            {
+                MapHelper<Uint8> MappedData{pCtx, pBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+                if (!MappedData)
+                    return false;
+                memcpy(MappedData, Data.pData, Data.DataSize);
+            }
+            return true;
+        }
+
+        case CMD_COPY_BUFFER:
+        {
+            CopyBufferCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->CopyBuffer(GetTypedObject<IBuffer>(Data.SrcBuffer, IID_Buffer), Data.SrcOffset, Data.SrcTransitionMode,
+                             GetTypedObject<IBuffer>(Data.DstBuffer, IID_Buffer), Data.DstOffset, Data.Size, Data.DstTransitionMode);
+            return true;
+        }
+
+        case CMD_BEGIN_DEBUG_GROUP:
+        {
+            ColorCmd Data;
+            if (!ReadCmd(Data))
+                return false;
+
+            pCtx->BeginDebugGroup(Data.Name != nullptr ? Data.Name : "", Data.HasColor ? Data.Color : nullptr);
+            return true;
+        }
+
+        case CMD_END_DEBUG_GROUP:
+            pCtx->EndDebugGroup();
+            return true;
+
+        default:
+            LOG_ERROR_MESSAGE("Unknown command ", Cmd);
+            return false;
+    }
+}
+
+bool CommandReplay::ReplayFrame(Uint32 FrameIndex)
+{
+    if (FrameIndex >= m_Frames.size())
+    {
+        LOG_ERROR_MESSAGE("Frame index ", FrameIndex, " is out of range");
+        return false;
+    }
+
+    const StreamData& Frame = m_Frames[FrameIndex];
+    return ExecuteStream(Frame.pData, Frame.Size);
+}
+
+std::vector<CommandReplayFrameStats> CommandReplay::Run(Uint32 NumIterations, bool MeasureGPUTime)
+{
+    std::vector<CommandReplayFrameStats> Stats(m_Frames.size());
+    if (m_Frames.empty() || NumIterations == 0)
+        return Stats;
+
+    std::unique_ptr<DurationQueryHelper> pDurationQueries;
+    if (MeasureGPUTime)
+    {
+        if (m_pDevice->GetDeviceInfo().Features.TimestampQueries)
+            pDurationQueries = std::make_unique<DurationQueryHelper>(m_pDevice, 4, 8);
+        else
+            LOG_WARNING_MESSAGE("Timestamp queries are not supported by the device. GPU time will not be measured.");
+    }
+
+    // Indices of the frames whose GPU time has not been read yet.
+    // Invalid index marks the empty query pairs used to drain the results at the end.
+    static constexpr Uint32 InvalidFrame = ~0u;
+    std::deque<Uint32>      PendingFrames;
+
+    auto EndQuery = [&]() {
+        double Duration = 0;
+        if (!pDurationQueries->End(m_pContext, Duration))
+            return;
+
+        VERIFY_EXPR(!PendingFrames.empty());
+        const Uint32 FrameIdx = PendingFrames.front();
+        PendingFrames.pop_front();
+        if (FrameIdx == InvalidFrame)
+            return;
+
+        CommandReplayFrameStats& FrameStats = Stats[FrameIdx];
+        FrameStats.MinGPUTime               = FrameStats.NumGPUSamples > 0 ? std::min(FrameStats.MinGPUTime, Duration) : Duration;
+        FrameStats.MaxGPUTime               = std::max(FrameStats.MaxGPUTime, Duration);
+        FrameStats.AvgGPUTime += Duration;
+        ++FrameStats.NumGPUSamples;
+    };
+
+    Timer CPUTimer;
+    for (Uint32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+    {
+        for (Uint32 FrameIdx = 0; FrameIdx < m_Frames.size(); ++FrameIdx)
+        {
+            if (pDurationQueries)
+            {
+                pDurationQueries->Begin(m_pContext);
+                PendingFrames.push_back(FrameIdx);
+            }
+
+            CPUTimer.Restart();
+            ReplayFrame(FrameIdx);
+            m_pContext->Flush();
+            const double CPUTime = CPUTimer.GetElapsedTime();
+
+            if (pDurationQueries)
+                EndQuery();
+
+            m_pContext->FinishFrame();
+
+            CommandReplayFrameStats& FrameStats = Stats[FrameIdx];
+            FrameStats.MinCPUTime               = FrameStats.NumSamples > 0 ? std::min(FrameStats.MinCPUTime, CPUTime) : CPUTime;
+            FrameStats.MaxCPUTime               = std::max(FrameStats.MaxCPUTime, CPUTime);
+            FrameStats.AvgCPUTime += CPUTime;
+            ++FrameStats.NumSamples;
+        }
+    }
+
+    if (pDurationQueries)
+    {
+        // All queries are complete once the GPU is idle. Every empty query pair returns the
+        // result of the oldest pending query.
+        m_pContext->WaitForIdle();
+        for (size_t Attempt = 0, MaxAttempts = PendingFrames.size() * 2; Attempt < MaxAttempts; ++Attempt)
+        {
+            if (PendingFrames.empty() || PendingFrames.front() == InvalidFrame)
+                break;
+
+            const size_t NumPending = PendingFrames.size();
+            pDurationQueries->Begin(m_pContext);
+            PendingFrames.push_back(InvalidFrame);
+            EndQuery();
+            if (PendingFrames.size() > NumPending)
+            {
+                // The result of the oldest query is not available yet
+                m_pContext->Flush();
+                m_pContext->WaitForIdle();
+            }
+        }
+    }
+    m_pContext->WaitForIdle();
+
+    for (CommandReplayFrameStats& FrameStats : Stats)
+    {
+        if (FrameStats.NumSamples > 0)
+            FrameStats.AvgCPUTime /= FrameStats.NumSamples;
+        if (FrameStats.NumGPUSamples > 0)
+            FrameStats.AvgGPUTime /= FrameStats.NumGPUSamples;
+    }
+
+    return Stats;
+}
+
+} // namespace Diligent
@@ -0,0 +1,263 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "DynamicResolutionController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+DynamicResolutionController::DynamicResolutionController(IRenderDevice*                               pDevice,
+                                                         const DynamicResolutionControllerCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_CI{CI},
+    m_Name{CI.Name != nullptr ? CI.Name : "Dynamic resolution controller"},
+    m_MaxWidth{CI.MaxWidth},
+    m_MaxHeight{CI.MaxHeight}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (CI.MaxWidth == 0 || CI.MaxHeight == 0)
+        LOG_ERROR_AND_THROW("Maximum render size must not be zero");
+    if (CI.Mode >= DYNAMIC_RESOLUTION_MODE_COUNT)
+        LOG_ERROR_AND_THROW("Invalid dynamic resolution mode");
+    if (!(CI.MinScale > 0 && CI.MinScale <= CI.MaxScale))
+        LOG_ERROR_AND_THROW("MinScale (", CI.MinScale, ") must be positive and not greater than MaxScale (", CI.MaxScale, ")");
+    if (!(CI.TargetGPUTime > 0))
+        LOG_ERROR_AND_THROW("Target GPU time must be positive");
+    if (!(CI.Smoothing > 0 && CI.Smoothing <= 1))
+        LOG_ERROR_AND_THROW("Smoothing factor (", CI.Smoothing, ") must be in (0, 1] range");
+    if (CI.NumRenderTargets != 0 && CI.pRenderTargets == nullptr)
+        LOG_ERROR_AND_THROW("pRenderTargets must not be null when NumRenderTargets (", CI.NumRenderTargets, ") is not zero");
+
+    m_TargetDescs.assign(CI.pRenderTargets, CI.pRenderTargets + CI.NumRenderTargets);
+    m_TargetNames.resize(CI.NumRenderTargets);
+    for (Uint32 i = 0; i < CI.NumRenderTargets; ++i)
+    {
+        const TextureDesc& Desc = m_TargetDescs[i];
+        if (Desc.Type != RESOURCE_DIM_TEX_2D && Desc.Type != RESOURCE_DIM_TEX_2D_ARRAY)
+            LOG_ERROR_AND_THROW("Render target ", i, " must be a 2D texture or a 2D texture array");
+        m_TargetNames[i] = Desc.Name != nullptr ? Desc.Name : m_Name + " - render target " + std::to_string(i);
+    }
+    m_CI.pRenderTargets   = nullptr;
+    m_CI.NumRenderTargets = 0;
+    m_RenderTargets.resize(m_TargetDescs.size());
+
+    if (CI.MeasureGPUTime)
+    {
+        if (m_pDevice->GetDeviceInfo().Features.TimestampQueries)
+            m_DurationQueries = std::make_unique<DurationQueryHelper>(m_pDevice, 4, 8);
+        else
+            LOG_WARNING_MESSAGE(m_Name, ": timestamp queries are not supported by the device. GPU time must be provided with Update().");
+    }
+
+    Reset(CI.InitialScale);
+    m_AppliedScale = m_PendingScale;
+    UpdateRenderSize();
+}
+
+DynamicResolutionController::~DynamicResolutionController()
+{
+}
+
+void DynamicResolutionController::Reset(float Scale)
+{
+    m_ControllerScale = clamp(Scale, m_CI.MinScale, m_CI.MaxScale);
+    m_PendingScale    = m_ControllerScale;
+    m_PrevError[0]    = 0;
+    m_PrevError[1]    = 0;
+    m_SmoothedGPUTime = 0;
+}
+
+void DynamicResolutionController::Resize(Uint32 MaxWidth, Uint32 MaxHeight)
+{
+    DEV_CHECK_ERR(MaxWidth > 0 && MaxHeight > 0, "Maximum render size must not be zero");
+    m_MaxWidth  = std::max(MaxWidth, 1u);
+    m_MaxHeight = std::max(MaxHeight, 1u);
+}
+
+void DynamicResolutionController::SetTargetGPUTime(float TargetGPUTime)
+{
+    DEV_CHECK_ERR(TargetGPUTime > 0, "Target GPU time must be positive");
+    if (TargetGPUTime > 0)
+        m_CI.TargetGPUTime = TargetGPUTime;
+}
+
+void DynamicResolutionController::UpdateRenderSize()
+{
+    m_RenderWidth  = clamp(static_cast<Uint32>(static_cast<float>(m_MaxWidth) * m_AppliedScale + 0.5f), 1u, m_MaxWidth);
+    m_RenderHeight = clamp(static_cast<Uint32>(static_cast<float>(m_MaxHeight) * m_AppliedScale + 0.5f), 1u, m_MaxHeight);
+
+    const Uint32 TargetWidth  = m_CI.Mode == DYNAMIC_RESOLUTION_MODE_VIEWPORT ? m_MaxWidth : m_RenderWidth;
+    const Uint32 TargetHeight = m_CI.Mode == DYNAMIC_RESOLUTION_MODE_VIEWPORT ? m_MaxHeight : m_RenderHeight;
+    if (TargetWidth != m_TargetWidth || TargetHeight != m_TargetHeight)
+        CreateRenderTargets(TargetWidth, TargetHeight);
+}
+
+void DynamicResolutionController::CreateRenderTargets(Uint32 Width, Uint32 Height)
+{
+    m_TargetWidth  = Width;
+    m_TargetHeight = Height;
+    if (m_TargetDescs.empty())
+        return;
+
+    for (size_t i = 0; i < m_TargetDescs.size(); ++i)
+    {
+        TextureDesc Desc = m_TargetDescs[i];
+        Desc.Name        = m_TargetNames[i].c_str();
+        Desc.Width       = Width;
+        Desc.Height      = Height;
+
+        m_RenderTargets[i].Release();
+        m_pDevice->CreateTexture(Desc, nullptr, &m_RenderTargets[i]);
+        if (!m_RenderTargets[i])
+            LOG_ERROR_MESSAGE(m_Name, ": failed to create render target '", Desc.Name, "' of size ", Width, "x", Height);
+    }
+    ++m_NumTargetAllocations;
+}
+
+void DynamicResolutionController::BeginFrame(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(!m_IsInFrame, "BeginFrame() must not be called twice without EndFrame()");
+    m_IsInFrame = true;
+
+    m_AppliedScale = m_PendingScale;
+    UpdateRenderSize();
+
+    if (m_DurationQueries)
+    {
+        m_DurationQueries->Begin(pContext);
+        m_PendingFrameScales.push_back(m_AppliedScale);
+    }
+}
+
+void DynamicResolutionController::EndFrame(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(m_IsInFrame, "EndFrame() must be called after BeginFrame()");
+    m_IsInFrame = false;
+
+    if (!m_DurationQueries)
+        return;
+
+    double Duration = 0;
+    if (m_DurationQueries->End(pContext, Duration))
+    {
+        VERIFY_EXPR(!m_PendingFrameScales.empty());
+        const float FrameScale = m_PendingFrameScales.front();
+        m_PendingFrameScales.pop_front();
+        Update(Duration, FrameScale);
+    }
+}
+
+void DynamicResolutionController::Update(double GPUTime, float Scale)
+{
+    if (!(GPUTime > 0))
+        return;
+
+    if (Scale <= 0)
+        Scale = m_AppliedScale;
+
+    const double TargetTime = m_CI.TargetGPUTime;
+
+    m_SmoothedGPUTime = m_SmoothedGPUTime > 0 ?
+        m_SmoothedGPUTime + (GPUTime - m_SmoothedGPUTime) * m_CI.Smoothing :
+        GPUTime;
+    ++m_NumMeasurements;
+
+    if (GPUTime > TargetTime * (1.0 + m_CI.PanicThreshold))
+    {
+        // Assume that the GPU time is proportional to the number of pixels and reduce the scale
+        // immediately. The frame may have been rendered with a larger scale a few frames ago, so
+        // the scale is never increased here. This prevents compounding the reduction when
+        // several frames that were rendered before it arrive.
+        const float PanicScale = Scale * static_cast<float>(std::sqrt(TargetTime / GPUTime));
+
+        m_ControllerScale = std::max(std::min(m_ControllerScale, PanicScale), m_CI.MinScale);
+        m_SmoothedGPUTime = std::min(m_SmoothedGPUTime, TargetTime);
+        m_PrevError[0]    = 0;
+        m_PrevError[1]    = 0;
+    }
+    else
+    {
+        const float Error = 1.f - static_cast<float>(m_SmoothedGPUTime / TargetTime);
+
+        const float Delta =
+            m_CI.Ki * Error +
+            m_CI.Kp * (Error - m_PrevError[0]) +
+            m_CI.Kd * (Error - 2.f * m_PrevError[0] + m_PrevError[1]);
+
+        m_ControllerScale = clamp(m_ControllerScale + Delta, m_CI.MinScale, m_CI.MaxScale);
+        m_PrevError[1]    = m_PrevError[0];
+        m_PrevError[0]    = Error;
+    }
+
+    if (m_CI.ScaleStep > 0)
+    {
+        // Change the resolution only when the controller output moves by at least one step
+        if (std::abs(m_ControllerScale - m_PendingScale) >= m_CI.ScaleStep ||
+            (m_ControllerScale == m_CI.MinScale || m_ControllerScale == m_CI.MaxScale))
+        {
+            const float Quantized = std::round(m_ControllerScale / m_CI.ScaleStep) * m_CI.ScaleStep;
+            m_PendingScale        = clamp(Quantized, m_CI.MinScale, m_CI.MaxScale);
+        }
+    }
+    else
+    {
+        m_PendingScale = m_ControllerScale;
+    }
+}
+
+float2 DynamicResolutionController::GetUVScale() const
+{
+    return float2{
+        static_cast<float>(m_RenderWidth) / static_cast<float>(m_TargetWidth),
+        static_cast<float>(m_RenderHeight) / static_cast<float>(m_TargetHeight),
+    };
+}
+
+Viewport DynamicResolutionController::GetViewport() const
+{
+    return Viewport{m_RenderWidth, m_RenderHeight};
+}
+
+void DynamicResolutionController::SetViewport(IDeviceContext* pContext) const
+{
+    const Viewport VP = GetViewport();
+    pContext->SetViewports(1, &VP, m_TargetWidth, m_TargetHeight);
+}
+
+ITexture* DynamicResolutionController::GetRenderTarget(Uint32 Index) const
+{
+    DEV_CHECK_ERR(Index < m_RenderTargets.size(), "Render target index (", Index, ") is out of range");
+    return Index < m_RenderTargets.size() ? m_RenderTargets[Index].RawPtr() : nullptr;
+}
+
+} // namespace Diligent
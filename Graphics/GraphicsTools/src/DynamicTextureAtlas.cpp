@@ -35,6 +35,7 @@
 #include <set>
 
 #include "DynamicAtlasManager.hpp"
+#include "ShelfAtlasManager.hpp"
 #include "DynamicTextureArray.hpp"
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
@@ -143,9 +144,13 @@ namespace
 class ThreadSafeAtlasManager
 {
 public:
-    ThreadSafeAtlasManager(const uint2& Dim) noexcept :
-        Mgr{Dim.x, Dim.y}
-    {}
+    ThreadSafeAtlasManager(const uint2& Dim, DYNAMIC_TEXTURE_ATLAS_PACKING Packing)
+    {
+        if (Packing == DYNAMIC_TEXTURE_ATLAS_PACKING_SHELF)
+            pShelfMgr = std::make_unique<ShelfAtlasManager>(Dim.x, Dim.y);
+        else
+            pGuillotineMgr = std::make_unique<DynamicAtlasManager>(Dim.x, Dim.y);
+    }
 
     // clang-format off
     ThreadSafeAtlasManager           (const ThreadSafeAtlasManager&)  = delete;
@@ -154,6 +159,22 @@ public:
     ThreadSafeAtlasManager& operator=(      ThreadSafeAtlasManager&&) = delete;
     // clang-format on
 
+private:
+    // Calls the handler with the atlas manager that is used by this slice
+    template <typename HandlerType>
+    auto Dispatch(HandlerType&& Handler)
+    {
+        VERIFY_EXPR((pShelfMgr != nullptr) != (pGuillotineMgr != nullptr));
+        return pShelfMgr ? Handler(*pShelfMgr) : Handler(*pGuillotineMgr);
+    }
+    template <typename HandlerType>
+    auto Dispatch(HandlerType&& Handler) const
+    {
+        VERIFY_EXPR((pShelfMgr != nullptr) != (pGuillotineMgr != nullptr));
+        return pShelfMgr ? Handler(static_cast<const ShelfAtlasManager&>(*pShelfMgr)) : Handler(static_cast<const DynamicAtlasManager&>(*pGuillotineMgr));
+    }
+
+public:
     class ManagerGuard
     {
     public:
@@ -203,7 +224,9 @@ public:
             VERIFY_EXPR(pAtlasMgr != nullptr);
             VERIFY_EXPR(pAtlasMgr->UseCount > 0);
             std::lock_guard<std::mutex> Guard{pAtlasMgr->Mtx};
-            return pAtlasMgr->Mgr.Allocate(Width, Height);
+            return pAtlasMgr->Dispatch([Width, Height](auto& Mgr) {
+                return Mgr.Allocate(Width, Height);
+            });
         }
 
         // Frees a region and returns true if the atlas is empty
@@ -212,8 +235,10 @@ public:
             VERIFY_EXPR(pAtlasMgr != nullptr);
             VERIFY_EXPR(pAtlasMgr->UseCount > 0);
             std::lock_guard<std::mutex> Guard{pAtlasMgr->Mtx};
-            pAtlasMgr->Mgr.Free(std::move(R));
-            return pAtlasMgr->Mgr.IsEmpty();
+            return pAtlasMgr->Dispatch([&R](auto& Mgr) {
+                Mgr.Free(std::move(R));
+                return Mgr.IsEmpty();
+            });
         }
 
         bool IsEmpty()
@@ -221,7 +246,9 @@ public:
             VERIFY_EXPR(pAtlasMgr != nullptr);
             VERIFY_EXPR(pAtlasMgr->UseCount > 0);
             std::lock_guard<std::mutex> Guard{pAtlasMgr->Mtx};
-            return pAtlasMgr->Mgr.IsEmpty();
+            return pAtlasMgr->Dispatch([](auto& Mgr) {
+                return Mgr.IsEmpty();
+            });
         }
 
     private:
@@ -246,9 +273,31 @@ public:
         return UseCount.load();
     }
 
+    struct FreeSpaceStats
+    {
+        Uint32 SliceCount        = 0;
+        Uint32 FreeRegionCount   = 0;
+        Uint64 FreeArea          = 0;
+        Uint64 MaxFreeRegionArea = 0;
+    };
+    // Adds the free space stats of this slice, in atlas manager units, to Stats
+    void AccumulateFreeSpaceStats(FreeSpaceStats& Stats) const
+    {
+        std::lock_guard<std::mutex> Guard{Mtx};
+        Dispatch([&Stats](const auto& Mgr) {
+            if (Mgr.IsEmpty())
+                return;
+            Stats.SliceCount += 1;
+            Stats.FreeRegionCount += Mgr.GetFreeRegionCount();
+            Stats.FreeArea += Mgr.GetTotalFreeArea();
+            Stats.MaxFreeRegionArea += Mgr.GetMaxFreeRegionArea();
+        });
+    }
+
 private:
     friend ManagerGuard;
 
+
     int AddUse()
     {
         auto Uses = UseCount.fetch_add(1) + 1;
@@ -264,8 +313,11 @@ private:
     }
 
 private:
-    std::mutex          Mtx;
-    DynamicAtlasManager Mgr;
+    mutable std::mutex Mtx;
+
+    // Only one of the managers is used, depending on the packing algorithm
+    std::unique_ptr<DynamicAtlasManager> pGuillotineMgr;
+    std::unique_ptr<ShelfAtlasManager>   pShelfMgr;
 
     std::atomic_int UseCount{0};
 };
@@ -273,8 +325,9 @@ private:
 
 struct SliceBatch
 {
-    SliceBatch(const uint2 AtlasDim) noexcept :
-        m_AtlasDim{AtlasDim}
+    SliceBatch(const uint2 AtlasDim, DYNAMIC_TEXTURE_ATLAS_PACKING Packing) noexcept :
+        m_AtlasDim{AtlasDim},
+        m_Packing{Packing}
     {}
 
     ~SliceBatch()
@@ -318,7 +371,7 @@ struct SliceBatch
         std::lock_guard<std::mutex> Guard{m_Mtx};
 
         VERIFY(m_Slices.find(Slice) == m_Slices.end(), "Slice ", Slice, " already present in the batch.");
-        auto it = m_Slices.emplace(Slice, m_AtlasDim).first;
+        auto it = m_Slices.emplace(std::piecewise_construct, std::forward_as_tuple(Slice), std::forward_as_tuple(m_AtlasDim, m_Packing)).first;
         // NB: Lock() atomically increases the use count of the slice while we hold the mutex.
         return it->second.Lock();
     }
@@ -352,10 +405,18 @@ struct SliceBatch
         return true;
     }
 
+    void AccumulateFreeSpaceStats(ThreadSafeAtlasManager::FreeSpaceStats& Stats) const
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+        for (const auto& it : m_Slices)
+            it.second.AccumulateFreeSpaceStats(Stats);
+    }
+
 private:
-    const uint2 m_AtlasDim;
+    const uint2                         m_AtlasDim;
+    const DYNAMIC_TEXTURE_ATLAS_PACKING m_Packing;
 
-    std::mutex m_Mtx;
+    mutable std::mutex m_Mtx;
     // For every alignment, we keep a list of slice managers sorted by the slice index.
     std::map<Uint32, ThreadSafeAtlasManager> m_Slices;
 };
@@ -387,6 +448,7 @@ public:
         m_ExtraSliceFactor{clamp(CreateInfo.GrowthFactor, 1.f, 2.f) - 1.f},
         m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{2048}) : 1},
         m_Silent          {CreateInfo.Silent},
+        m_Packing         {CreateInfo.Packing},
         m_SuballocationsAllocator
         {
             DefaultRawMemoryAllocator::GetAllocator(),
@@ -672,6 +734,32 @@ public:
         Stats.AllocationCount = m_AllocationCount.load();
         Stats.AllocatedArea   = m_AllocatedArea.load();
         Stats.UsedArea        = m_UsedArea.load();
+
+        Uint64 SliceArea            = 0;
+        Uint64 FreeArea             = 0;
+        Uint64 MaxFreeRegionAreaSum = 0;
+
+        Stats.AllocatedSliceCount = 0;
+        Stats.FreeRegionCount     = 0;
+        {
+            std::lock_guard<std::mutex> Guard{m_SliceBatchesByAlignmentMtx};
+            for (const auto& it : m_SliceBatchesByAlignment)
+            {
+                ThreadSafeAtlasManager::FreeSpaceStats BatchStats;
+                it.second.AccumulateFreeSpaceStats(BatchStats);
+
+                // Atlas managers operate in units of the batch alignment
+                const Uint64 UnitArea = Uint64{it.first} * Uint64{it.first};
+                Stats.AllocatedSliceCount += BatchStats.SliceCount;
+                Stats.FreeRegionCount += BatchStats.FreeRegionCount;
+                SliceArea += Uint64{BatchStats.SliceCount} * Uint64{m_Desc.Width} * Uint64{m_Desc.Height};
+                FreeArea += BatchStats.FreeArea * UnitArea;
+                MaxFreeRegionAreaSum += BatchStats.MaxFreeRegionArea * UnitArea;
+            }
+        }
+
+        Stats.Occupancy     = SliceArea > 0 ? static_cast<float>(static_cast<double>(Stats.UsedArea) / static_cast<double>(SliceArea)) : 0.f;
+        Stats.Fragmentation = FreeArea > 0 ? 1.f - static_cast<float>(static_cast<double>(MaxFreeRegionAreaSum) / static_cast<double>(FreeArea)) : 0.f;
     }
 
 private:
@@ -711,7 +799,7 @@ private:
         // Get the list of slices for this alignment
         auto BatchIt = m_SliceBatchesByAlignment.find(Alignment);
         if (BatchIt == m_SliceBatchesByAlignment.end() && AtlasWidth != 0 && AtlasHeight != 0)
-            BatchIt = m_SliceBatchesByAlignment.emplace(Alignment, uint2{AtlasWidth, AtlasHeight}).first;
+            BatchIt = m_SliceBatchesByAlignment.emplace(std::piecewise_construct, std::forward_as_tuple(Alignment), std::forward_as_tuple(uint2{AtlasWidth, AtlasHeight}, m_Packing)).first;
 
         return BatchIt != m_SliceBatchesByAlignment.end() ? &BatchIt->second : nullptr;
     }
@@ -726,6 +814,8 @@ private:
     const Uint32 m_MaxSliceCount;
     const bool   m_Silent;
 
+    const DYNAMIC_TEXTURE_ATLAS_PACKING m_Packing;
+
     std::unique_ptr<DynamicTextureArray> m_DynamicTexArray;
     RefCntAutoPtr<ITexture>              m_pTexture;
 
@@ -738,7 +828,7 @@ private:
     std::atomic<Int64> m_AllocatedArea{0};
     std::atomic<Int64> m_UsedArea{0};
 
-    std::mutex m_SliceBatchesByAlignmentMtx;
+    mutable std::mutex m_SliceBatchesByAlignmentMtx;
     // Alignment -> slice batch
     std::unordered_map<Uint32, SliceBatch> m_SliceBatchesByAlignment;
 
@@ -0,0 +1,409 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUProfiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#include "DebugUtilities.hpp"
+#include "HashUtils.hpp"
+#include "CPUProfiler.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+void WriteEscapedString(std::string& Out, const char* Str)
+{
+    for (const char* c = Str; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            Out.push_back('\\');
+            Out.push_back(*c);
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20)
+        {
+            char Buff[8];
+            snprintf(Buff, sizeof(Buff), "\\u%04x", static_cast<unsigned int>(*c));
+            Out += Buff;
+        }
+        else
+        {
+            Out.push_back(*c);
+        }
+    }
+}
+
+void WriteMicroseconds(std::string& Out, double Seconds)
+{
+    char Buff[32];
+    snprintf(Buff, sizeof(Buff), "%.3f", std::max(Seconds, 0.0) * 1e+6);
+    Out += Buff;
+}
+
+} // namespace
+
+GPUProfiler::GPUProfiler(IRenderDevice* pDevice, const GPUProfilerCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_CI{CI}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+
+    if (!m_pDevice->GetDeviceInfo().Features.TimestampQueries)
+        LOG_ERROR_AND_THROW("Timestamp queries are not supported by the device");
+
+    if (m_CI.NumFramesInFlight == 0)
+        LOG_ERROR_AND_THROW("The number of frames in flight must not be zero");
+
+    m_Frames.resize(m_CI.NumFramesInFlight);
+
+    m_QueryPool.reserve(m_CI.InitialQueryCount);
+    for (Uint32 i = 0; i < m_CI.InitialQueryCount; ++i)
+    {
+        RefCntAutoPtr<IQuery> pQuery = AllocateQuery();
+        if (!pQuery)
+            LOG_ERROR_AND_THROW("Failed to create timestamp query");
+        m_QueryPool.emplace_back(std::move(pQuery));
+    }
+}
+
+RefCntAutoPtr<IQuery> GPUProfiler::AllocateQuery()
+{
+    RefCntAutoPtr<IQuery> pQuery;
+    if (!m_QueryPool.empty())
+    {
+        pQuery = std::move(m_QueryPool.back());
+        m_QueryPool.pop_back();
+    }
+    else
+    {
+        QueryDesc Desc{QUERY_TYPE_TIMESTAMP};
+        Desc.Name = "GPU profiler timestamp query";
+        m_pDevice->CreateQuery(Desc, &pQuery);
+        VERIFY(pQuery, "Failed to create timestamp query");
+    }
+    return pQuery;
+}
+
+void GPUProfiler::BeginFrame(IDeviceContext* pContext, const char* Name)
+{
+    DEV_CHECK_ERR(!m_IsInFrame, "BeginFrame() is called twice without EndFrame()");
+
+    // GPU and CPU clocks drift apart, so the calibration is refreshed every frame while capturing
+    if (m_IsCapturing && m_CalibrationState != CALIBRATION_STATE_UNAVAILABLE)
+        UpdateCalibration(pContext);
+
+    ResolveFrames();
+
+    m_IsInFrame   = true;
+    m_IsRecording = m_NumPendingFrames < m_Frames.size();
+    if (!m_IsRecording)
+        ++m_NumSkippedFrames;
+
+    BeginScope(pContext, Name);
+}
+
+void GPUProfiler::EndFrame(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(m_IsInFrame, "EndFrame() is called without BeginFrame()");
+    DEV_CHECK_ERR((m_IsRecording ? m_ScopeStack.size() : m_SkippedScopeDepth) == 1, "All scopes must be ended before the frame ends");
+
+    EndScope(pContext);
+
+    if (m_IsRecording)
+        ++m_NumPendingFrames;
+
+    m_IsInFrame   = false;
+    m_IsRecording = false;
+}
+
+void GPUProfiler::BeginScope(IDeviceContext* pContext, const char* Name, const float* pColor)
+{
+    DEV_CHECK_ERR(m_IsInFrame, "Scopes must be recorded between BeginFrame() and EndFrame()");
+    DEV_CHECK_ERR(Name != nullptr, "Scope name must not be null");
+
+    if (m_CI.EmitDebugGroups)
+        pContext->BeginDebugGroup(Name, pColor);
+
+    if (!m_IsRecording)
+    {
+        ++m_SkippedScopeDepth;
+        return;
+    }
+
+    FrameData& Frame = m_Frames[(m_FirstPendingFrame + m_NumPendingFrames) % m_Frames.size()];
+
+    PendingScope Scope;
+    Scope.Name       = Name;
+    Scope.Parent     = !m_ScopeStack.empty() ? m_ScopeStack.back() : ~0u;
+    Scope.Depth      = static_cast<Uint32>(m_ScopeStack.size());
+    Scope.BeginQuery = static_cast<Uint32>(Frame.Queries.size());
+
+    Frame.Queries.emplace_back(AllocateQuery());
+    pContext->EndQuery(Frame.Queries.back());
+
+    m_ScopeStack.push_back(static_cast<Uint32>(Frame.Scopes.size()));
+    Frame.Scopes.push_back(Scope);
+}
+
+void GPUProfiler::EndScope(IDeviceContext* pContext)
+{
+    if (m_IsRecording)
+    {
+        if (m_ScopeStack.empty())
+        {
+            DEV_ERROR("EndScope() is called without matching BeginScope()");
+            return;
+        }
+
+        FrameData&    Frame = m_Frames[(m_FirstPendingFrame + m_NumPendingFrames) % m_Frames.size()];
+        PendingScope& Scope = Frame.Scopes[m_ScopeStack.back()];
+        m_ScopeStack.pop_back();
+
+        Scope.EndQuery = static_cast<Uint32>(Frame.Queries.size());
+        Frame.Queries.emplace_back(AllocateQuery());
+        pContext->EndQuery(Frame.Queries.back());
+    }
+    else
+    {
+        if (m_SkippedScopeDepth == 0)
+        {
+            DEV_ERROR("EndScope() is called without matching BeginScope()");
+            return;
+        }
+        --m_SkippedScopeDepth;
+    }
+
+    if (m_CI.EmitDebugGroups)
+        pContext->EndDebugGroup();
+}
+
+bool GPUProfiler::StatsKey::operator==(const StatsKey& rhs) const
+{
+    return Parent == rhs.Parent && strcmp(Name, rhs.Name) == 0;
+}
+
+size_t GPUProfiler::StatsKey::Hasher::operator()(const StatsKey& Key) const
+{
+    return ComputeHash(Key.Parent, CStringHash<char>{}(Key.Name));
+}
+
+void GPUProfiler::ResolveFrames()
+{
+    std::vector<double> Timestamps;
+    std::vector<Uint32> NodeStats;
+    while (m_NumPendingFrames > 0)
+    {
+        FrameData& Frame = m_Frames[m_FirstPendingFrame];
+        VERIFY_EXPR(!Frame.Queries.empty() && !Frame.Scopes.empty());
+
+        // The frame end timestamp is written last, so when it is available,
+        // all other timestamps of the frame are available too.
+        QueryDataTimestamp Data;
+        if (!Frame.Queries.back()->GetData(&Data, sizeof(Data), false))
+            break;
+
+        bool IsValid = true;
+        Timestamps.resize(Frame.Queries.size());
+        for (size_t i = 0; i < Frame.Queries.size(); ++i)
+        {
+            IQuery* pQuery = Frame.Queries[i];
+            if (pQuery->GetData(&Data, sizeof(Data), false) && Data.Frequency != 0)
+                Timestamps[i] = static_cast<double>(Data.Counter) / static_cast<double>(Data.Frequency);
+            else
+                IsValid = false;
+            pQuery->Invalidate();
+            m_QueryPool.emplace_back(std::move(Frame.Queries[i]));
+        }
+
+        if (IsValid)
+        {
+            const double FrameStart = Timestamps[Frame.Scopes[0].BeginQuery];
+
+            m_LastFrame.resize(Frame.Scopes.size());
+            NodeStats.resize(Frame.Scopes.size());
+            std::fill(m_FrameStatTimes.begin(), m_FrameStatTimes.end(), -1.0);
+            for (size_t i = 0; i < Frame.Scopes.size(); ++i)
+            {
+                const PendingScope& Scope = Frame.Scopes[i];
+                VERIFY_EXPR(Scope.EndQuery != ~0u);
+
+                GPUProfileNode& Node = m_LastFrame[i];
+                Node.Name            = Scope.Name;
+                Node.Parent          = Scope.Parent;
+                Node.Depth           = Scope.Depth;
+                Node.StartTime       = Timestamps[Scope.BeginQuery] - FrameStart;
+                Node.Duration        = std::max(Timestamps[Scope.EndQuery] - Timestamps[Scope.BeginQuery], 0.0);
+
+                // Parents are always recorded before their children
+                const Uint32 ParentStats = Scope.Parent != ~0u ? NodeStats[Scope.Parent] : ~0u;
+
+                auto it = m_StatsIndices.find(StatsKey{ParentStats, Scope.Name});
+                if (it == m_StatsIndices.end())
+                {
+                    GPUProfileScopeStats Stats;
+                    Stats.Name   = Scope.Name;
+                    Stats.Parent = ParentStats;
+                    Stats.Depth  = Scope.Depth;
+                    m_Stats.emplace_back(std::move(Stats));
+                    m_FrameStatTimes.push_back(-1.0);
+                    it = m_StatsIndices.emplace(StatsKey{ParentStats, Scope.Name}, static_cast<Uint32>(m_Stats.size() - 1)).first;
+                }
+                NodeStats[i] = it->second;
+
+                double& FrameTime = m_FrameStatTimes[it->second];
+                FrameTime         = std::max(FrameTime, 0.0) + Node.Duration;
+
+                if (m_IsCapturing)
+                    m_CapturedEvents.push_back({Scope.Name, Scope.Depth, Timestamps[Scope.BeginQuery] + m_GPUToCPUTimeOffset, Node.Duration});
+            }
+
+            for (size_t i = 0; i < m_Stats.size(); ++i)
+            {
+                const double FrameTime = m_FrameStatTimes[i];
+                if (FrameTime < 0)
+                    continue;
+
+                GPUProfileScopeStats& Stats = m_Stats[i];
+                Stats.MinTime               = Stats.NumFrames > 0 ? std::min(Stats.MinTime, FrameTime) : FrameTime;
+                Stats.MaxTime               = Stats.NumFrames > 0 ? std::max(Stats.MaxTime, FrameTime) : FrameTime;
+                Stats.TotalTime += FrameTime;
+                ++Stats.NumFrames;
+            }
+
+            ++m_NumResolvedFrames;
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Failed to read GPU profiler timestamps. The frame is discarded.");
+        }
+
+        Frame.Queries.clear();
+        Frame.Scopes.clear();
+        m_FirstPendingFrame = (m_FirstPendingFrame + 1) % static_cast<Uint32>(m_Frames.size());
+        --m_NumPendingFrames;
+    }
+}
+
+void GPUProfiler::ResetStats()
+{
+    m_Stats.clear();
+    m_FrameStatTimes.clear();
+    m_StatsIndices.clear();
+}
+
+void GPUProfiler::UpdateCalibration(IDeviceContext* pContext)
+{
+    TimestampCalibration Calibration;
+
+    bool Calibrated = false;
+    if (ICommandQueue* pQueue = pContext->LockCommandQueue())
+    {
+        Calibrated = pQueue->GetTimestampCalibration(Calibration) && Calibration.GPUFrequency != 0 && Calibration.CPUFrequency != 0;
+        pContext->UnlockCommandQueue();
+    }
+
+    if (!Calibrated)
+    {
+        // Do not mix calibrated and uncalibrated events in one capture
+        if (m_CalibrationState == CALIBRATION_STATE_UNKNOWN)
+            m_CalibrationState = CALIBRATION_STATE_UNAVAILABLE;
+        return;
+    }
+
+    // The calibration CPU clock is the clock of std::chrono::steady_clock, while
+    // CPUProfiler counts the time from its own start.
+    const double SteadyClockTime = std::chrono::duration<double>{std::chrono::steady_clock::now().time_since_epoch()}.count();
+    const double ProfilerTime    = static_cast<double>(CPUProfiler::GetTimestamp()) * 1e-9;
+
+    const double CalibrationCPUTime = static_cast<double>(Calibration.CPUTimestamp) / static_cast<double>(Calibration.CPUFrequency);
+    const double CalibrationGPUTime = static_cast<double>(Calibration.GPUTimestamp) / static_cast<double>(Calibration.GPUFrequency);
+
+    m_GPUToCPUTimeOffset = CalibrationCPUTime - (SteadyClockTime - ProfilerTime) - CalibrationGPUTime;
+    m_CalibrationState   = CALIBRATION_STATE_CALIBRATED;
+}
+
+void GPUProfiler::BeginCapture()
+{
+    m_IsCapturing = true;
+    m_CapturedEvents.clear();
+    m_CalibrationState   = CALIBRATION_STATE_UNKNOWN;
+    m_GPUToCPUTimeOffset = 0;
+}
+
+std::string GPUProfiler::EndCapture()
+{
+    if (!m_IsCapturing)
+    {
+        LOG_WARNING_MESSAGE("GPU profiler capture has not been started");
+        return {};
+    }
+    m_IsCapturing = false;
+
+    // Calibrated events are already in the CPUProfiler time base
+    double StartTime = 0;
+    if (m_CalibrationState != CALIBRATION_STATE_CALIBRATED)
+    {
+        for (size_t i = 0; i < m_CapturedEvents.size(); ++i)
+            StartTime = i == 0 ? m_CapturedEvents[i].StartTime : std::min(StartTime, m_CapturedEvents[i].StartTime);
+    }
+
+    std::string Trace;
+    Trace.reserve(128 + m_CapturedEvents.size() * 96);
+    Trace += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    Trace += "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"GPU\"}}";
+
+    for (const CapturedEvent& Event : m_CapturedEvents)
+    {
+        Trace += ",\n{\"name\":\"";
+        WriteEscapedString(Trace, Event.Name);
+        Trace += "\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":";
+        WriteMicroseconds(Trace, Event.StartTime - StartTime);
+        Trace += ",\"dur\":";
+        WriteMicroseconds(Trace, Event.Duration);
+        Trace += ",\"args\":{\"depth\":";
+        Trace += std::to_string(Event.Depth);
+        Trace += "}}";
+    }
+
+    Trace += "\n]}\n";
+
+    m_CapturedEvents.clear();
+    m_CapturedEvents.shrink_to_fit();
+
+    return Trace;
+}
+
+} // namespace Diligent
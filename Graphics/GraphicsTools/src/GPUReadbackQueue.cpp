@@ -0,0 +1,355 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUReadbackQueue.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "GraphicsAccessories.hpp"
+#include "Align.hpp"
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Staging resources that are not reused are released when the pools grow beyond these limits
+constexpr size_t MaxPooledStagingBuffers  = 32;
+constexpr size_t MaxPooledStagingTextures = 16;
+
+constexpr Uint64 MinStagingBufferSize = 256;
+
+RESOURCE_DIMENSION GetStagingTextureType(RESOURCE_DIMENSION SrcType)
+{
+    switch (SrcType)
+    {
+        case RESOURCE_DIM_TEX_1D:
+        case RESOURCE_DIM_TEX_1D_ARRAY:
+            return RESOURCE_DIM_TEX_1D;
+
+        case RESOURCE_DIM_TEX_3D:
+            return RESOURCE_DIM_TEX_3D;
+
+        default:
+            return RESOURCE_DIM_TEX_2D;
+    }
+}
+
+} // namespace
+
+GPUReadbackQueue::GPUReadbackQueue(IRenderDevice* pDevice) :
+    m_pDevice{pDevice},
+    m_AwaitQueue{pDevice}
+{
+}
+
+GPUReadbackQueue::~GPUReadbackQueue()
+{
+    DEV_CHECK_ERR(m_NumPending == 0, "Destroying GPU readback queue with ", m_NumPending,
+                  " pending read backs. Call WaitForCompletion() to deliver them.");
+}
+
+RefCntAutoPtr<IBuffer> GPUReadbackQueue::GetStagingBuffer(Uint64 Size)
+{
+    // Find the smallest pooled buffer that is large enough
+    auto BestIt = m_StagingBuffers.end();
+    for (auto it = m_StagingBuffers.begin(); it != m_StagingBuffers.end(); ++it)
+    {
+        const Uint64 BuffSize = (*it)->GetDesc().Size;
+        if (BuffSize >= Size && (BestIt == m_StagingBuffers.end() || BuffSize < (*BestIt)->GetDesc().Size))
+            BestIt = it;
+    }
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    if (BestIt != m_StagingBuffers.end())
+    {
+        pBuffer = std::move(*BestIt);
+        m_StagingBuffers.erase(BestIt);
+        return pBuffer;
+    }
+
+    BufferDesc Desc;
+    Desc.Name           = "GPU readback queue staging buffer";
+    Desc.Size           = Size <= MinStagingBufferSize ? MinStagingBufferSize : Uint64{1} << (PlatformMisc::GetMSB(Size - 1) + 1);
+    Desc.Usage          = USAGE_STAGING;
+    Desc.CPUAccessFlags = CPU_ACCESS_READ;
+    m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+    DEV_CHECK_ERR(pBuffer, "Failed to create staging buffer of size ", Desc.Size);
+    return pBuffer;
+}
+
+RefCntAutoPtr<ITexture> GPUReadbackQueue::GetStagingTexture(const TextureDesc& Desc)
+{
+    for (auto it = m_StagingTextures.begin(); it != m_StagingTextures.end(); ++it)
+    {
+        const TextureDesc& TexDesc = (*it)->GetDesc();
+        if (TexDesc.Type == Desc.Type &&
+            TexDesc.Width == Desc.Width &&
+            TexDesc.Height == Desc.Height &&
+            TexDesc.Depth == Desc.Depth &&
+            TexDesc.Format == Desc.Format)
+        {
+            RefCntAutoPtr<ITexture> pTexture = std::move(*it);
+            m_StagingTextures.erase(it);
+            return pTexture;
+        }
+    }
+
+    RefCntAutoPtr<ITexture> pTexture;
+    m_pDevice->CreateTexture(Desc, nullptr, &pTexture);
+    DEV_CHECK_ERR(pTexture, "Failed to create ", Desc.Width, "x", Desc.Height, " staging texture");
+    return pTexture;
+}
+
+void GPUReadbackQueue::ReadbackBufferAsync(IDeviceContext*                pContext,
+                                           IBuffer*                       pBuffer,
+                                           Uint64                         Offset,
+                                           Uint64                         Size,
+                                           GPUReadbackCallbackType        Callback,
+                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    DEV_CHECK_ERR(pContext != nullptr && pBuffer != nullptr, "Context and buffer must not be null");
+    DEV_CHECK_ERR(Size > 0, "Read back size must not be zero");
+    DEV_CHECK_ERR(Callback, "Callback must not be empty");
+
+    PendingReadback Readback;
+    Readback.pStagingBuffer = GetStagingBuffer(Size);
+    if (!Readback.pStagingBuffer)
+        return;
+
+    Readback.DataSize = Size;
+    Readback.Callback = std::move(Callback);
+
+    pContext->CopyBuffer(pBuffer, Offset, StateTransitionMode,
+                         Readback.pStagingBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    m_AwaitQueue.Enqueue(pContext, std::move(Readback));
+    ++m_NumPending;
+}
+
+std::future<std::vector<Uint8>> GPUReadbackQueue::ReadbackBufferAsync(IDeviceContext*                pContext,
+                                                                      IBuffer*                       pBuffer,
+                                                                      Uint64                         Offset,
+                                                                      Uint64                         Size,
+                                                                      RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    // std::function requires the callable to be copyable
+    auto pPromise = std::make_shared<std::promise<std::vector<Uint8>>>();
+    auto Future   = pPromise->get_future();
+    ReadbackBufferAsync(
+        pContext, pBuffer, Offset, Size,
+        [pPromise](const GPUReadbackData& Data) {
+            const Uint8* pData = static_cast<const Uint8*>(Data.pData);
+            pPromise->set_value(std::vector<Uint8>{pData, pData + static_cast<size_t>(Data.DataSize)});
+        },
+        StateTransitionMode);
+    return Future;
+}
+
+void GPUReadbackQueue::ReadbackTextureAsync(IDeviceContext*                pContext,
+                                            ITexture*                      pTexture,
+                                            Uint32                         MipLevel,
+                                            Uint32                         Slice,
+                                            const Box*                     pRegion,
+                                            GPUReadbackCallbackType        Callback,
+                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    DEV_CHECK_ERR(pContext != nullptr && pTexture != nullptr, "Context and texture must not be null");
+    DEV_CHECK_ERR(Callback, "Callback must not be empty");
+
+    const TextureDesc& SrcDesc = pTexture->GetDesc();
+    DEV_CHECK_ERR(MipLevel < SrcDesc.MipLevels, "Mip level ", MipLevel, " is out of range");
+
+    Box Region;
+    if (pRegion != nullptr)
+    {
+        Region = *pRegion;
+    }
+    else
+    {
+        const MipLevelProperties MipProps = GetMipLevelProperties(SrcDesc, MipLevel);
+
+        Region.MaxX = MipProps.StorageWidth;
+        Region.MaxY = MipProps.StorageHeight;
+        Region.MaxZ = MipProps.Depth;
+    }
+
+    TextureDesc StagingDesc;
+    StagingDesc.Name           = "GPU readback queue staging texture";
+    StagingDesc.Type           = GetStagingTextureType(SrcDesc.Type);
+    StagingDesc.Width          = Region.Width();
+    StagingDesc.Height         = StagingDesc.Type == RESOURCE_DIM_TEX_1D ? 1 : Region.Height();
+    StagingDesc.Depth          = StagingDesc.Type == RESOURCE_DIM_TEX_3D ? Region.Depth() : 1;
+    StagingDesc.Format         = SrcDesc.Format;
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    PendingReadback Readback;
+    Readback.pStagingTexture = GetStagingTexture(StagingDesc);
+    if (!Readback.pStagingTexture)
+        return;
+
+    Readback.Callback = std::move(Callback);
+
+    CopyTextureAttribs CopyAttribs{pTexture, StateTransitionMode, Readback.pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    CopyAttribs.SrcMipLevel = MipLevel;
+    CopyAttribs.SrcSlice    = Slice;
+    CopyAttribs.pSrcBox     = &Region;
+    pContext->CopyTexture(CopyAttribs);
+
+    m_AwaitQueue.Enqueue(pContext, std::move(Readback));
+    ++m_NumPending;
+}
+
+std::future<std::vector<Uint8>> GPUReadbackQueue::ReadbackTextureAsync(IDeviceContext*                pContext,
+                                                                       ITexture*                      pTexture,
+                                                                       Uint32                         MipLevel,
+                                                                       Uint32                         Slice,
+                                                                       const Box*                     pRegion,
+                                                                       RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    auto pPromise = std::make_shared<std::promise<std::vector<Uint8>>>();
+    auto Future   = pPromise->get_future();
+    ReadbackTextureAsync(
+        pContext, pTexture, MipLevel, Slice, pRegion,
+        [pPromise](const GPUReadbackData& Data) {
+            const BufferToTextureCopyInfo CopyInfo = GetBufferToTextureCopyInfo(Data.Format, Box{0, Data.Width, 0, Data.Height, 0, Data.Depth}, 1);
+
+            std::vector<Uint8> PackedData(static_cast<size_t>(CopyInfo.MemorySize));
+            for (Uint32 z = 0; z < Data.Depth; ++z)
+            {
+                for (Uint32 row = 0; row < CopyInfo.RowCount; ++row)
+                {
+                    const Uint8* pSrcRow = static_cast<const Uint8*>(Data.pData) + z * Data.DepthStride + row * Data.Stride;
+                    Uint8*       pDstRow = PackedData.data() + z * CopyInfo.DepthStride + row * CopyInfo.RowStride;
+                    memcpy(pDstRow, pSrcRow, static_cast<size_t>(CopyInfo.RowSize));
+                }
+            }
+            pPromise->set_value(std::move(PackedData));
+        },
+        StateTransitionMode);
+    return Future;
+}
+
+bool GPUReadbackQueue::Deliver(IDeviceContext* pContext, PendingReadback& Readback)
+{
+    if (Readback.pStagingBuffer)
+    {
+        void* pData = nullptr;
+        pContext->MapBuffer(Readback.pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        if (pData == nullptr)
+            return false;
+
+        GPUReadbackData Data;
+        Data.pData    = pData;
+        Data.DataSize = Readback.DataSize;
+        Readback.Callback(Data);
+
+        pContext->UnmapBuffer(Readback.pStagingBuffer, MAP_READ);
+        if (m_StagingBuffers.size() < MaxPooledStagingBuffers)
+            m_StagingBuffers.emplace_back(std::move(Readback.pStagingBuffer));
+    }
+    else
+    {
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(Readback.pStagingTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        if (MappedData.pData == nullptr)
+            return false;
+
+        const TextureDesc&          Desc       = Readback.pStagingTexture->GetDesc();
+        const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(Desc.Format);
+
+        const Uint32 Depth   = Desc.Type == RESOURCE_DIM_TEX_3D ? Desc.Depth : 1;
+        const Uint32 NumRows = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ?
+            AlignUp(Desc.Height, Uint32{FmtAttribs.BlockHeight}) / FmtAttribs.BlockHeight :
+            Desc.Height;
+
+        GPUReadbackData Data;
+        Data.pData       = MappedData.pData;
+        Data.Stride      = MappedData.Stride;
+        Data.DepthStride = MappedData.DepthStride;
+        Data.DataSize    = MappedData.DepthStride * (Depth - 1) + MappedData.Stride * NumRows;
+        Data.Width       = Desc.Width;
+        Data.Height      = Desc.Height;
+        Data.Depth       = Depth;
+        Data.Format      = Desc.Format;
+        Readback.Callback(Data);
+
+        pContext->UnmapTextureSubresource(Readback.pStagingTexture, 0, 0);
+        if (m_StagingTextures.size() < MaxPooledStagingTextures)
+            m_StagingTextures.emplace_back(std::move(Readback.pStagingTexture));
+    }
+
+    --m_NumPending;
+    return true;
+}
+
+void GPUReadbackQueue::ProcessCompleted(IDeviceContext* pContext)
+{
+    while (PendingReadback Readback = m_AwaitQueue.GetFirstCompleted())
+        m_CompletedReadbacks.emplace_back(std::move(Readback));
+
+    // Deliver the data in the order the read backs were enqueued
+    while (!m_CompletedReadbacks.empty())
+    {
+        if (!Deliver(pContext, m_CompletedReadbacks.front()))
+            break;
+        m_CompletedReadbacks.pop_front();
+    }
+}
+
+void GPUReadbackQueue::WaitForCompletion(IDeviceContext* pContext)
+{
+    // Make sure that the fence signals are submitted before waiting
+    pContext->Flush();
+    m_AwaitQueue.WaitForAll();
+    ProcessCompleted(pContext);
+
+    if (!m_CompletedReadbacks.empty())
+    {
+        // Staging resources that are mapped asynchronously (WebGPU) may become
+        // available only after the device has processed its events.
+        pContext->WaitForIdle();
+        ProcessCompleted(pContext);
+        if (!m_CompletedReadbacks.empty())
+        {
+            LOG_WARNING_MESSAGE(m_CompletedReadbacks.size(), " staging resource(s) could not be mapped. "
+                                                             "The data will be delivered by subsequent calls to ProcessCompleted().");
+        }
+    }
+}
+
+void GPUReadbackQueue::ReleaseStagingResources()
+{
+    m_StagingBuffers.clear();
+    m_StagingTextures.clear();
+}
+
+} // namespace Diligent
@@ -27,14 +27,21 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <atomic>
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
 #include "RefCntAutoPtr.hpp"
+#include "ThreadPool.hpp"
+#include "Intrinsics.hpp"
 
 #define PI_F 3.1415926f
 
@@ -321,17 +328,19 @@ template <typename ChannelType,
           typename FilterType>
 void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
                     Uint32                        NumChannels,
-                    FilterType                    Filter)
+                    FilterType                    Filter,
+                    Uint32                        RowBegin,
+                    Uint32                        RowEnd)
 {
     VERIFY_EXPR(Attribs.FineMipWidth > 0 && Attribs.FineMipHeight > 0);
     DEV_CHECK_ERR(Attribs.FineMipHeight == 1 || Attribs.FineMipStride >= Attribs.FineMipWidth * sizeof(ChannelType) * NumChannels, "Fine mip level stride is too small");
 
-    const auto CoarseMipWidth  = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
-    const auto CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
+    const auto CoarseMipWidth = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
 
-    VERIFY(CoarseMipHeight == 1 || Attribs.CoarseMipStride >= CoarseMipWidth * sizeof(ChannelType) * NumChannels, "Coarse mip level stride is too small");
+    VERIFY(Attribs.FineMipHeight < 4 || Attribs.CoarseMipStride >= CoarseMipWidth * sizeof(ChannelType) * NumChannels, "Coarse mip level stride is too small");
+    VERIFY_EXPR(RowBegin <= RowEnd && RowEnd <= std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1}));
 
-    for (Uint32 row = 0; row < CoarseMipHeight; ++row)
+    for (Uint32 row = RowBegin; row < RowEnd; ++row)
     {
         auto src_row0 = row * 2;
         auto src_row1 = std::min(row * 2 + 1, Attribs.FineMipHeight - 1);
@@ -359,13 +368,73 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
     }
 }
 
+// Box filter for 4-channel 8-bit textures that processes two coarse texels at a time.
+// The results are identical to LinearAverage<Uint8>.
+void BoxFilterMipLevelRGBA8(const ComputeMipLevelAttribs& Attribs,
+                            Uint32                        RowBegin,
+                            Uint32                        RowEnd)
+{
+    VERIFY_EXPR(Attribs.FineMipWidth >= 2);
+
+    const Uint32 CoarseMipWidth = Attribs.FineMipWidth / 2;
+
+    for (Uint32 row = RowBegin; row < RowEnd; ++row)
+    {
+        const Uint8* pSrcRow0 = reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + size_t{row * 2} * Attribs.FineMipStride;
+        const Uint8* pSrcRow1 = reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + size_t{std::min(row * 2 + 1, Attribs.FineMipHeight - 1)} * Attribs.FineMipStride;
+        Uint8*       pDstRow  = reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + size_t{row} * Attribs.CoarseMipStride;
+
+        Uint32 col = 0;
+#if DILIGENT_SSE2_ENABLED
+        const __m128i Zero = _mm_setzero_si128();
+        for (; col + 2 <= CoarseMipWidth; col += 2)
+        {
+            // Four fine texels from each row
+            const __m128i Row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcRow0 + col * 8));
+            const __m128i Row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcRow1 + col * 8));
+
+            // Texels 0 and 1, and texels 2 and 3 as 16-bit values
+            const __m128i Sum01 = _mm_add_epi16(_mm_unpacklo_epi8(Row0, Zero), _mm_unpacklo_epi8(Row1, Zero));
+            const __m128i Sum23 = _mm_add_epi16(_mm_unpackhi_epi8(Row0, Zero), _mm_unpackhi_epi8(Row1, Zero));
+
+            __m128i Sum = _mm_add_epi16(_mm_unpacklo_epi64(Sum01, Sum23), _mm_unpackhi_epi64(Sum01, Sum23));
+            Sum         = _mm_srli_epi16(Sum, 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(pDstRow + col * 4), _mm_packus_epi16(Sum, Sum));
+        }
+#elif DILIGENT_NEON_ENABLED
+        for (; col + 2 <= CoarseMipWidth; col += 2)
+        {
+            const uint8x16_t Row0 = vld1q_u8(pSrcRow0 + col * 8);
+            const uint8x16_t Row1 = vld1q_u8(pSrcRow1 + col * 8);
+
+            const uint16x8_t Sum01 = vaddl_u8(vget_low_u8(Row0), vget_low_u8(Row1));
+            const uint16x8_t Sum23 = vaddl_u8(vget_high_u8(Row0), vget_high_u8(Row1));
+
+            const uint16x8_t Sum = vcombine_u16(vadd_u16(vget_low_u16(Sum01), vget_high_u16(Sum01)),
+                                                vadd_u16(vget_low_u16(Sum23), vget_high_u16(Sum23)));
+            vst1_u8(pDstRow + col * 4, vmovn_u16(vshrq_n_u16(Sum, 2)));
+        }
+#endif
+        for (; col < CoarseMipWidth; ++col)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                pDstRow[col * 4 + c] = LinearAverage<Uint8>(pSrcRow0[col * 8 + c], pSrcRow0[col * 8 + 4 + c],
+                                                            pSrcRow1[col * 8 + c], pSrcRow1[col * 8 + 4 + c],
+                                                            col, row);
+            }
+        }
+    }
+}
+
 void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
                 Uint32                        NumChannels,
-                Uint32                        AlphaChannelInd)
+                Uint32                        AlphaChannelInd,
+                Uint32                        RowBegin,
+                Uint32                        RowEnd)
 {
-    const auto CoarseMipWidth  = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
-    const auto CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
-    for (Uint32 row = 0; row < CoarseMipHeight; ++row)
+    const auto CoarseMipWidth = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
+    for (Uint32 row = RowBegin; row < RowEnd; ++row)
     {
         for (Uint32 col = 0; col < CoarseMipWidth; ++col)
         {
@@ -384,105 +453,666 @@ void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
     }
 }
 
-template <typename ChannelType>
-void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
-                             const TextureFormatAttribs&   FmtAttribs)
+
+// Windowed sinc filters extend over three coarse texels on each side
+static constexpr float WindowedFilterRadius = 3.f;
+
+static float Sinc(float x)
+{
+    if (std::abs(x) < 1e-5f)
+        return 1.f;
+    x *= PI_F;
+    return std::sin(x) / x;
+}
+
+// Zero-order modified Bessel function of the first kind
+static float BesselI0(float x)
 {
-    auto FilterType = Attribs.FilterType;
-    if (FilterType == MIP_FILTER_TYPE_DEFAULT)
+    const float HalfX = x * 0.5f;
+
+    float Sum  = 1.f;
+    float Term = 1.f;
+    for (int k = 1; k < 32 && Term > Sum * 1e-8f; ++k)
     {
-        FilterType = FmtAttribs.ComponentType == COMPONENT_TYPE_UINT || FmtAttribs.ComponentType == COMPONENT_TYPE_SINT ?
-            MIP_FILTER_TYPE_MOST_FREQUENT :
-            MIP_FILTER_TYPE_BOX_AVERAGE;
+        const float t = HalfX / static_cast<float>(k);
+        Term *= t * t;
+        Sum += Term;
     }
+    return Sum;
+}
+
+static float LanczosKernel(float x)
+{
+    return std::abs(x) < WindowedFilterRadius ? Sinc(x) * Sinc(x / WindowedFilterRadius) : 0.f;
+}
+
+static float KaiserKernel(float x)
+{
+    static constexpr float Alpha = 4.f;
+    if (std::abs(x) >= WindowedFilterRadius)
+        return 0.f;
 
-    FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents,
-                                FilterType == MIP_FILTER_TYPE_BOX_AVERAGE ?
-                                    LinearAverage<ChannelType> :
-                                    MostFrequentSelector<ChannelType>);
+    const float t = x / WindowedFilterRadius;
+    return Sinc(x) * BesselI0(Alpha * std::sqrt(1.f - t * t)) / BesselI0(Alpha);
 }
 
-void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
+namespace
 {
-    DEV_CHECK_ERR(Attribs.Format != TEX_FORMAT_UNKNOWN, "Format must not be unknown");
-    DEV_CHECK_ERR(Attribs.FineMipWidth != 0, "Fine mip width must not be zero");
-    DEV_CHECK_ERR(Attribs.FineMipHeight != 0, "Fine mip height must not be zero");
-    DEV_CHECK_ERR(Attribs.pFineMipData != nullptr, "Fine level data must not be null");
-    DEV_CHECK_ERR(Attribs.pCoarseMipData != nullptr, "Coarse level data must not be null");
 
-    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
+// Taps of a windowed filter for every coarse texel along one axis
+struct FilterTaps
+{
+    // The number of taps for every coarse texel
+    Uint32 NumTaps = 0;
 
-    VERIFY_EXPR(Attribs.AlphaCutoff >= 0 && Attribs.AlphaCutoff <= 1);
-    VERIFY(Attribs.AlphaCutoff == 0 || FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1,
-           "Alpha remapping is only supported for 4-channel 8-bit textures");
+    // Fine texel indices and normalized weights, NumTaps for every coarse texel
+    std::vector<Uint32> Indices;
+    std::vector<float>  Weights;
 
-    switch (FmtAttribs.ComponentType)
+    FilterTaps(Uint32 FineSize, Uint32 CoarseSize, float (*Kernel)(float))
     {
-        case COMPONENT_TYPE_UNORM_SRGB:
-            VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
-            FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents,
-                                  Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT ?
-                                      MostFrequentSelector<Uint8> :
-                                      SRGBAverage<Uint8>);
-            if (Attribs.AlphaCutoff > 0)
+        VERIFY_EXPR(FineSize > 0 && CoarseSize > 0);
+
+        // The ratio is not 2 for odd sizes
+        const float Scale   = static_cast<float>(FineSize) / static_cast<float>(CoarseSize);
+        const float Support = WindowedFilterRadius * Scale;
+
+        NumTaps = static_cast<Uint32>(std::ceil(Support * 2.f)) + 1;
+        Indices.resize(size_t{CoarseSize} * NumTaps);
+        Weights.resize(size_t{CoarseSize} * NumTaps);
+        for (Uint32 i = 0; i < CoarseSize; ++i)
+        {
+            const float Center = (static_cast<float>(i) + 0.5f) * Scale;
+            const int   First  = static_cast<int>(std::floor(Center - Support));
+
+            float  WeightSum = 0;
+            Uint32 Offset    = i * NumTaps;
+            for (Uint32 t = 0; t < NumTaps; ++t)
             {
-                RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1);
+                const int   j = First + static_cast<int>(t);
+                const float w = Kernel((static_cast<float>(j) + 0.5f - Center) / Scale);
+
+                // Clamp to edge
+                Indices[Offset + t] = static_cast<Uint32>(std::min(std::max(j, 0), static_cast<int>(FineSize) - 1));
+                Weights[Offset + t] = w;
+                WeightSum += w;
             }
-            break;
+            VERIFY_EXPR(WeightSum > 0);
+            for (Uint32 t = 0; t < NumTaps; ++t)
+                Weights[Offset + t] /= WeightSum;
+        }
+    }
+};
 
-        case COMPONENT_TYPE_UNORM:
-        case COMPONENT_TYPE_UINT:
-            switch (FmtAttribs.ComponentSize)
+// Converts texels to linear floating-point values and back.
+class TexelConverter
+{
+public:
+    explicit TexelConverter(const TextureFormatAttribs& FmtAttribs) :
+        m_ComponentType{FmtAttribs.ComponentType},
+        m_ComponentSize{FmtAttribs.ComponentSize},
+        m_NumChannels{FmtAttribs.NumComponents}
+    {
+        if (m_ComponentSize == 1)
+        {
+            // Alpha channel is always linear
+            const Uint32 AlphaChannel = m_NumChannels == 4 ? 3 : ~0u;
+            m_ToFloatLUT.resize(size_t{256} * m_NumChannels);
+            for (Uint32 c = 0; c < m_NumChannels; ++c)
+            {
+                for (Uint32 i = 0; i < 256; ++i)
+                {
+                    float& Val = m_ToFloatLUT[c * 256 + i];
+                    if (m_ComponentType == COMPONENT_TYPE_SNORM)
+                        Val = std::max(static_cast<float>(static_cast<Int8>(i)) / 127.f, -1.f);
+                    else if (m_ComponentType == COMPONENT_TYPE_UNORM_SRGB && c != AlphaChannel)
+                        Val = GammaToLinear(static_cast<Uint8>(i));
+                    else
+                        Val = static_cast<float>(i) / 255.f;
+                }
+            }
+
+            if (m_ComponentType == COMPONENT_TYPE_UNORM_SRGB)
             {
-                case 1:
-                    ComputeMipLevelInternal<Uint8>(Attribs, FmtAttribs);
-                    if (Attribs.AlphaCutoff > 0)
+                // Linear values halfway between the consecutive sRGB values
+                for (Uint32 i = 0; i < m_LinearToSRGBThresholds.size(); ++i)
+                    m_LinearToSRGBThresholds[i] = GammaToLinear((static_cast<float>(i) + 0.5f) / 255.f);
+            }
+        }
+    }
+
+    static bool IsSupported(const TextureFormatAttribs& FmtAttribs)
+    {
+        switch (FmtAttribs.ComponentType)
+        {
+            case COMPONENT_TYPE_UNORM:
+            case COMPONENT_TYPE_SNORM:
+                return FmtAttribs.ComponentSize == 1 || FmtAttribs.ComponentSize == 2;
+
+            case COMPONENT_TYPE_UNORM_SRGB:
+                return FmtAttribs.ComponentSize == 1;
+
+            case COMPONENT_TYPE_FLOAT:
+                return FmtAttribs.ComponentSize == 4;
+
+            default:
+                return false;
+        }
+    }
+
+    void ToFloat(const void* pSrc, Uint32 NumTexels, float* pDst) const
+    {
+        const size_t NumValues = size_t{NumTexels} * m_NumChannels;
+        if (m_ComponentSize == 1)
+        {
+            const Uint8* pSrc8 = static_cast<const Uint8*>(pSrc);
+            for (size_t i = 0; i < NumValues; ++i)
+                pDst[i] = m_ToFloatLUT[(i % m_NumChannels) * 256 + pSrc8[i]];
+        }
+        else if (m_ComponentType == COMPONENT_TYPE_UNORM)
+        {
+            const Uint16* pSrc16 = static_cast<const Uint16*>(pSrc);
+            for (size_t i = 0; i < NumValues; ++i)
+                pDst[i] = static_cast<float>(pSrc16[i]) / 65535.f;
+        }
+        else if (m_ComponentType == COMPONENT_TYPE_SNORM)
+        {
+            const Int16* pSrc16 = static_cast<const Int16*>(pSrc);
+            for (size_t i = 0; i < NumValues; ++i)
+                pDst[i] = std::max(static_cast<float>(pSrc16[i]) / 32767.f, -1.f);
+        }
+        else
+        {
+            memcpy(pDst, pSrc, NumValues * sizeof(float));
+        }
+    }
+
+    void FromFloat(const float* pSrc, Uint32 NumTexels, void* pDst) const
+    {
+        const size_t NumValues = size_t{NumTexels} * m_NumChannels;
+        switch (m_ComponentType)
+        {
+            case COMPONENT_TYPE_UNORM_SRGB:
+            {
+                const Uint32 AlphaChannel = m_NumChannels == 4 ? 3 : ~0u;
+                Uint8*       pDst8        = static_cast<Uint8*>(pDst);
+                for (size_t i = 0; i < NumValues; ++i)
+                {
+                    const float Val = clamp(pSrc[i], 0.f, 1.f);
+                    if ((i % m_NumChannels) != AlphaChannel)
                     {
-                        RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1);
+                        // Round to the nearest sRGB value
+                        pDst8[i] = static_cast<Uint8>(std::upper_bound(m_LinearToSRGBThresholds.begin(), m_LinearToSRGBThresholds.end(), Val) - m_LinearToSRGBThresholds.begin());
                     }
-                    break;
+                    else
+                    {
+                        pDst8[i] = static_cast<Uint8>(Val * 255.f + 0.5f);
+                    }
+                }
+                break;
+            }
 
-                case 2:
-                    ComputeMipLevelInternal<Uint16>(Attribs, FmtAttribs);
-                    break;
+            case COMPONENT_TYPE_UNORM:
+                if (m_ComponentSize == 1)
+                {
+                    Uint8* pDst8 = static_cast<Uint8*>(pDst);
+                    for (size_t i = 0; i < NumValues; ++i)
+                        pDst8[i] = static_cast<Uint8>(clamp(pSrc[i], 0.f, 1.f) * 255.f + 0.5f);
+                }
+                else
+                {
+                    Uint16* pDst16 = static_cast<Uint16*>(pDst);
+                    for (size_t i = 0; i < NumValues; ++i)
+                        pDst16[i] = static_cast<Uint16>(clamp(pSrc[i], 0.f, 1.f) * 65535.f + 0.5f);
+                }
+                break;
+
+            case COMPONENT_TYPE_SNORM:
+                if (m_ComponentSize == 1)
+                {
+                    Int8* pDst8 = static_cast<Int8*>(pDst);
+                    for (size_t i = 0; i < NumValues; ++i)
+                        pDst8[i] = static_cast<Int8>(std::round(clamp(pSrc[i], -1.f, 1.f) * 127.f));
+                }
+                else
+                {
+                    Int16* pDst16 = static_cast<Int16*>(pDst);
+                    for (size_t i = 0; i < NumValues; ++i)
+                        pDst16[i] = static_cast<Int16>(std::round(clamp(pSrc[i], -1.f, 1.f) * 32767.f));
+                }
+                break;
+
+            default:
+                memcpy(pDst, pSrc, NumValues * sizeof(float));
+        }
+    }
 
-                case 4:
-                    ComputeMipLevelInternal<Uint32>(Attribs, FmtAttribs);
-                    break;
+private:
+    const COMPONENT_TYPE m_ComponentType;
+    const Uint32         m_ComponentSize;
+    const Uint32         m_NumChannels;
 
-                default:
-                    UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for UNORM/UINT texture format");
-            }
-            break;
+    // Lookup table for 8-bit formats, 256 values for every channel
+    std::vector<float> m_ToFloatLUT;
 
-        case COMPONENT_TYPE_SNORM:
-        case COMPONENT_TYPE_SINT:
-            switch (FmtAttribs.ComponentSize)
-            {
-                case 1:
-                    ComputeMipLevelInternal<Int8>(Attribs, FmtAttribs);
-                    break;
+    std::array<float, 255> m_LinearToSRGBThresholds{};
+};
 
-                case 2:
-                    ComputeMipLevelInternal<Int16>(Attribs, FmtAttribs);
-                    break;
+// Dst += Src * Weight
+void AccumulateWeightedRow(float* pDst, const float* pSrc, float Weight, size_t Count)
+{
+    size_t i = 0;
+#if DILIGENT_SSE2_ENABLED
+    const __m128 w = _mm_set1_ps(Weight);
+    for (; i + 4 <= Count; i += 4)
+        _mm_storeu_ps(pDst + i, _mm_add_ps(_mm_loadu_ps(pDst + i), _mm_mul_ps(_mm_loadu_ps(pSrc + i), w)));
+#elif DILIGENT_NEON_ENABLED
+    for (; i + 4 <= Count; i += 4)
+        vst1q_f32(pDst + i, vmlaq_n_f32(vld1q_f32(pDst + i), vld1q_f32(pSrc + i), Weight));
+#endif
+    for (; i < Count; ++i)
+        pDst[i] += pSrc[i] * Weight;
+}
 
-                case 4:
-                    ComputeMipLevelInternal<Int32>(Attribs, FmtAttribs);
-                    break;
+// Filters one row of the fine level along the horizontal axis
+void FilterRowHorizontal(const float* pSrc, const FilterTaps& Taps, Uint32 CoarseWidth, Uint32 NumChannels, float* pDst)
+{
+    const Uint32* pIndices = Taps.Indices.data();
+    const float*  pWeights = Taps.Weights.data();
+    for (Uint32 col = 0; col < CoarseWidth; ++col, pIndices += Taps.NumTaps, pWeights += Taps.NumTaps)
+    {
+        float* pDstTexel = pDst + size_t{col} * NumChannels;
+#if DILIGENT_SSE2_ENABLED || DILIGENT_NEON_ENABLED
+        if (NumChannels == 4)
+        {
+#    if DILIGENT_SSE2_ENABLED
+            __m128 Sum = _mm_setzero_ps();
+            for (Uint32 t = 0; t < Taps.NumTaps; ++t)
+                Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_loadu_ps(pSrc + size_t{pIndices[t]} * 4), _mm_set1_ps(pWeights[t])));
+            _mm_storeu_ps(pDstTexel, Sum);
+#    else
+            float32x4_t Sum = vdupq_n_f32(0);
+            for (Uint32 t = 0; t < Taps.NumTaps; ++t)
+                Sum = vmlaq_n_f32(Sum, vld1q_f32(pSrc + size_t{pIndices[t]} * 4), pWeights[t]);
+            vst1q_f32(pDstTexel, Sum);
+#    endif
+            continue;
+        }
+#endif
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            float Sum = 0;
+            for (Uint32 t = 0; t < Taps.NumTaps; ++t)
+                Sum += pSrc[size_t{pIndices[t]} * NumChannels + c] * pWeights[t];
+            pDstTexel[c] = Sum;
+        }
+    }
+}
 
-                default:
-                    UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for UINT/SINT texture format");
+// Computes the coarse mip level rows, possibly in multiple threads.
+class MipLevelFilter
+{
+public:
+    MipLevelFilter(const ComputeMipLevelAttribs& Attribs) :
+        m_Attribs{Attribs},
+        m_FmtAttribs{GetTextureFormatAttribs(Attribs.Format)},
+        m_CoarseMipWidth{std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1})},
+        m_CoarseMipHeight{std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1})},
+        m_FilterType{Attribs.FilterType}
+    {
+        const bool IsIntegerFormat = m_FmtAttribs.ComponentType == COMPONENT_TYPE_UINT || m_FmtAttribs.ComponentType == COMPONENT_TYPE_SINT;
+        if (m_FilterType == MIP_FILTER_TYPE_KAISER || m_FilterType == MIP_FILTER_TYPE_LANCZOS)
+        {
+            if (TexelConverter::IsSupported(m_FmtAttribs))
+            {
+                auto Kernel = m_FilterType == MIP_FILTER_TYPE_KAISER ? KaiserKernel : LanczosKernel;
+                m_pHorzTaps.reset(new FilterTaps{Attribs.FineMipWidth, m_CoarseMipWidth, Kernel});
+                m_pVertTaps.reset(new FilterTaps{Attribs.FineMipHeight, m_CoarseMipHeight, Kernel});
+                m_pConverter.reset(new TexelConverter{m_FmtAttribs});
             }
-            break;
+            else
+            {
+                DEV_ERROR("Windowed filters are not supported for ", m_FmtAttribs.Name, " format. Using the default filter.");
+                m_FilterType = MIP_FILTER_TYPE_DEFAULT;
+            }
+        }
 
-        case COMPONENT_TYPE_FLOAT:
-            VERIFY(FmtAttribs.ComponentSize == 4, "Only 32-bit float formats are currently supported");
-            ComputeMipLevelInternal<Float32>(Attribs, FmtAttribs);
-            break;
+        if (m_FilterType == MIP_FILTER_TYPE_DEFAULT)
+        {
+            m_FilterType = IsIntegerFormat ?
+                MIP_FILTER_TYPE_MOST_FREQUENT :
+                MIP_FILTER_TYPE_BOX_AVERAGE;
+        }
+    }
 
-        default:
-            UNEXPECTED("Unsupported component type");
+    Uint32 GetCoarseMipWidth() const { return m_CoarseMipWidth; }
+    Uint32 GetCoarseMipHeight() const { return m_CoarseMipHeight; }
+
+    // Returns the recommended number of rows processed by one thread
+    Uint32 GetRowsPerTile() const
+    {
+        // Windowed filters process more fine rows than they write, so use larger tiles to reduce the overlap
+        const Uint32 TexelsPerTile = m_pVertTaps ? (1u << 17) : (1u << 15);
+        return std::max(TexelsPerTile / m_CoarseMipWidth, m_pVertTaps ? Uint32{16} : Uint32{1});
+    }
+
+    void FilterRows(Uint32 RowBegin, Uint32 RowEnd) const;
+
+private:
+    template <typename ChannelType>
+    void FilterRowsInternal(Uint32 RowBegin, Uint32 RowEnd) const
+    {
+        FilterMipLevel<ChannelType>(m_Attribs, m_FmtAttribs.NumComponents,
+                                    m_FilterType == MIP_FILTER_TYPE_BOX_AVERAGE ?
+                                        LinearAverage<ChannelType> :
+                                        MostFrequentSelector<ChannelType>,
+                                    RowBegin, RowEnd);
+    }
+
+    void FilterRowsWindowed(Uint32 RowBegin, Uint32 RowEnd) const;
+
+private:
+    const ComputeMipLevelAttribs& m_Attribs;
+    const TextureFormatAttribs&   m_FmtAttribs;
+
+    const Uint32 m_CoarseMipWidth;
+    const Uint32 m_CoarseMipHeight;
+
+    MIP_FILTER_TYPE m_FilterType;
+
+    std::unique_ptr<FilterTaps>     m_pHorzTaps;
+    std::unique_ptr<FilterTaps>     m_pVertTaps;
+    std::unique_ptr<TexelConverter> m_pConverter;
+};
+
+void MipLevelFilter::FilterRowsWindowed(Uint32 RowBegin, Uint32 RowEnd) const
+{
+    const FilterTaps& VertTaps    = *m_pVertTaps;
+    const Uint32      NumChannels = m_FmtAttribs.NumComponents;
+
+    // Fine rows used by the coarse rows of the tile
+    Uint32 FirstFineRow = ~0u;
+    Uint32 LastFineRow  = 0;
+    for (size_t i = size_t{RowBegin} * VertTaps.NumTaps; i < size_t{RowEnd} * VertTaps.NumTaps; ++i)
+    {
+        FirstFineRow = std::min(FirstFineRow, VertTaps.Indices[i]);
+        LastFineRow  = std::max(LastFineRow, VertTaps.Indices[i]);
+    }
+
+    const size_t FineRowSize   = size_t{m_Attribs.FineMipWidth} * NumChannels;
+    const size_t CoarseRowSize = size_t{m_CoarseMipWidth} * NumChannels;
+
+    // Filter all fine rows horizontally first
+    std::vector<float> FineRow(FineRowSize);
+    std::vector<float> HorzFiltered(CoarseRowSize * (LastFineRow - FirstFineRow + 1));
+    for (Uint32 FineRowIdx = FirstFineRow; FineRowIdx <= LastFineRow; ++FineRowIdx)
+    {
+        const void* pSrcRow = reinterpret_cast<const Uint8*>(m_Attribs.pFineMipData) + FineRowIdx * m_Attribs.FineMipStride;
+        m_pConverter->ToFloat(pSrcRow, m_Attribs.FineMipWidth, FineRow.data());
+        FilterRowHorizontal(FineRow.data(), *m_pHorzTaps, m_CoarseMipWidth, NumChannels, &HorzFiltered[CoarseRowSize * (FineRowIdx - FirstFineRow)]);
+    }
+
+    std::vector<float> CoarseRow(CoarseRowSize);
+    for (Uint32 row = RowBegin; row < RowEnd; ++row)
+    {
+        std::fill(CoarseRow.begin(), CoarseRow.end(), 0.f);
+
+        const size_t Offset = size_t{row} * VertTaps.NumTaps;
+        for (Uint32 t = 0; t < VertTaps.NumTaps; ++t)
+        {
+            const float Weight = VertTaps.Weights[Offset + t];
+            if (Weight != 0)
+                AccumulateWeightedRow(CoarseRow.data(), &HorzFiltered[CoarseRowSize * (VertTaps.Indices[Offset + t] - FirstFineRow)], Weight, CoarseRowSize);
+        }
+
+        void* pDstRow = reinterpret_cast<Uint8*>(m_Attribs.pCoarseMipData) + row * m_Attribs.CoarseMipStride;
+        m_pConverter->FromFloat(CoarseRow.data(), m_CoarseMipWidth, pDstRow);
+    }
+}
+
+void MipLevelFilter::FilterRows(Uint32 RowBegin, Uint32 RowEnd) const
+{
+    const auto& FmtAttribs = m_FmtAttribs;
+
+    if (m_pVertTaps)
+    {
+        FilterRowsWindowed(RowBegin, RowEnd);
+    }
+    else
+    {
+        switch (FmtAttribs.ComponentType)
+        {
+            case COMPONENT_TYPE_UNORM_SRGB:
+                VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
+                FilterMipLevel<Uint8>(m_Attribs, FmtAttribs.NumComponents,
+                                      m_FilterType == MIP_FILTER_TYPE_MOST_FREQUENT ?
+                                          MostFrequentSelector<Uint8> :
+                                          SRGBAverage<Uint8>,
+                                      RowBegin, RowEnd);
+                break;
+
+            case COMPONENT_TYPE_UNORM:
+            case COMPONENT_TYPE_UINT:
+                switch (FmtAttribs.ComponentSize)
+                {
+                    case 1:
+                        if (FmtAttribs.NumComponents == 4 && m_FilterType == MIP_FILTER_TYPE_BOX_AVERAGE && m_Attribs.FineMipWidth >= 2)
+                            BoxFilterMipLevelRGBA8(m_Attribs, RowBegin, RowEnd);
+                        else
+                            FilterRowsInternal<Uint8>(RowBegin, RowEnd);
+                        break;
+
+                    case 2:
+                        FilterRowsInternal<Uint16>(RowBegin, RowEnd);
+                        break;
+
+                    case 4:
+                        FilterRowsInternal<Uint32>(RowBegin, RowEnd);
+                        break;
+
+                    default:
+                        UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for UNORM/UINT texture format");
+                }
+                break;
+
+            case COMPONENT_TYPE_SNORM:
+            case COMPONENT_TYPE_SINT:
+                switch (FmtAttribs.ComponentSize)
+                {
+                    case 1:
+                        FilterRowsInternal<Int8>(RowBegin, RowEnd);
+                        break;
+
+                    case 2:
+                        FilterRowsInternal<Int16>(RowBegin, RowEnd);
+                        break;
+
+                    case 4:
+                        FilterRowsInternal<Int32>(RowBegin, RowEnd);
+                        break;
+
+                    default:
+                        UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for UINT/SINT texture format");
+                }
+                break;
+
+            case COMPONENT_TYPE_FLOAT:
+                VERIFY(FmtAttribs.ComponentSize == 4, "Only 32-bit float formats are currently supported");
+                FilterRowsInternal<Float32>(RowBegin, RowEnd);
+                break;
+
+            default:
+                UNEXPECTED("Unsupported component type");
+        }
+    }
+
+    if (m_Attribs.AlphaCutoff > 0 && FmtAttribs.ComponentSize == 1 &&
+        (FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM || FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB || FmtAttribs.ComponentType == COMPONENT_TYPE_UINT))
+    {
+        RemapAlpha(m_Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1, RowBegin, RowEnd);
+    }
+}
+
+void ProcessTiles(IThreadPool* pThreadPool, Uint32 NumTiles, const std::function<void(size_t)>& Handler)
+{
+    if (pThreadPool != nullptr && NumTiles > 1)
+    {
+        try
+        {
+            ProcessItemsInParallel(pThreadPool, NumTiles, Handler);
+            return;
+        }
+        catch (...)
+        {
+            // The handlers do not throw
+            UNEXPECTED("Unexpected exception");
+        }
+    }
+
+    for (Uint32 i = 0; i < NumTiles; ++i)
+        Handler(i);
+}
+
+// Returns the number of texels whose alpha passes the alpha test after scaling
+Uint64 GetAlphaCoverage(const std::array<Uint64, 256>& AlphaHistogram, float AlphaScale, float AlphaCutoff)
+{
+    Uint64 Coverage = 0;
+    for (Uint32 a = 0; a < 256; ++a)
+    {
+        if (std::min(static_cast<float>(a) * AlphaScale, 255.f) > AlphaCutoff * 255.f)
+            Coverage += AlphaHistogram[a];
+    }
+    return Coverage;
+}
+
+std::array<Uint64, 256> ComputeAlphaHistogram(const void* pData, size_t Stride, Uint32 Width, Uint32 Height, Uint32 NumChannels)
+{
+    std::array<Uint64, 256> Histogram{};
+    for (Uint32 row = 0; row < Height; ++row)
+    {
+        const Uint8* pRow = reinterpret_cast<const Uint8*>(pData) + row * Stride;
+        for (Uint32 col = 0; col < Width; ++col)
+            ++Histogram[pRow[col * NumChannels + NumChannels - 1]];
+    }
+    return Histogram;
+}
+
+} // namespace
+
+void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Format != TEX_FORMAT_UNKNOWN, "Format must not be unknown");
+    DEV_CHECK_ERR(Attribs.FineMipWidth != 0, "Fine mip width must not be zero");
+    DEV_CHECK_ERR(Attribs.FineMipHeight != 0, "Fine mip height must not be zero");
+    DEV_CHECK_ERR(Attribs.pFineMipData != nullptr, "Fine level data must not be null");
+    DEV_CHECK_ERR(Attribs.pCoarseMipData != nullptr, "Coarse level data must not be null");
+
+    VERIFY_EXPR(Attribs.AlphaCutoff >= 0 && Attribs.AlphaCutoff <= 1);
+    VERIFY(Attribs.AlphaCutoff == 0 || GetTextureFormatAttribs(Attribs.Format).NumComponents == 4 && GetTextureFormatAttribs(Attribs.Format).ComponentSize == 1,
+           "Alpha remapping is only supported for 4-channel 8-bit textures");
+
+    MipLevelFilter Filter{Attribs};
+    Filter.FilterRows(0, Filter.GetCoarseMipHeight());
+}
+
+void ComputeMipChain(const ComputeMipChainAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Format != TEX_FORMAT_UNKNOWN, "Format must not be unknown");
+    DEV_CHECK_ERR(Attribs.Width != 0, "Width must not be zero");
+    DEV_CHECK_ERR(Attribs.Height != 0, "Height must not be zero");
+    DEV_CHECK_ERR(Attribs.MipLevels != 0, "The number of mip levels must not be zero");
+    DEV_CHECK_ERR(Attribs.MipLevels <= ComputeMipLevelsCount(Attribs.Width, Attribs.Height), "The number of mip levels (", Attribs.MipLevels,
+                  ") exceeds the full mip chain length (", ComputeMipLevelsCount(Attribs.Width, Attribs.Height), ")");
+    DEV_CHECK_ERR(Attribs.ppMipData != nullptr, "ppMipData must not be null");
+    DEV_CHECK_ERR(Attribs.pMipStrides != nullptr, "pMipStrides must not be null");
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
+
+    VERIFY_EXPR(Attribs.AlphaCutoff >= 0 && Attribs.AlphaCutoff <= 1);
+    VERIFY(Attribs.AlphaCutoff == 0 || FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1,
+           "Alpha remapping is only supported for 4-channel 8-bit textures");
+
+    const bool PreserveAlphaCoverage = Attribs.PreserveAlphaCoverage && Attribs.AlphaCutoff > 0;
+
+    // The fraction of texels in the most detailed level that pass the alpha test
+    double RefCoverage = 0;
+    if (PreserveAlphaCoverage)
+    {
+        const auto Histogram = ComputeAlphaHistogram(Attribs.ppMipData[0], Attribs.pMipStrides[0], Attribs.Width, Attribs.Height, FmtAttribs.NumComponents);
+        RefCoverage          = static_cast<double>(GetAlphaCoverage(Histogram, 1.f, Attribs.AlphaCutoff)) / (static_cast<double>(Attribs.Width) * static_cast<double>(Attribs.Height));
+    }
+
+    for (Uint32 Mip = 1; Mip < Attribs.MipLevels; ++Mip)
+    {
+        ComputeMipLevelAttribs LevelAttribs;
+        LevelAttribs.Format          = Attribs.Format;
+        LevelAttribs.FineMipWidth    = std::max(Attribs.Width >> (Mip - 1), 1u);
+        LevelAttribs.FineMipHeight   = std::max(Attribs.Height >> (Mip - 1), 1u);
+        LevelAttribs.pFineMipData    = Attribs.ppMipData[Mip - 1];
+        LevelAttribs.FineMipStride   = Attribs.pMipStrides[Mip - 1];
+        LevelAttribs.pCoarseMipData  = Attribs.ppMipData[Mip];
+        LevelAttribs.CoarseMipStride = Attribs.pMipStrides[Mip];
+        LevelAttribs.FilterType      = Attribs.FilterType;
+        LevelAttribs.AlphaCutoff     = PreserveAlphaCoverage ? 0.f : Attribs.AlphaCutoff;
+        DEV_CHECK_ERR(LevelAttribs.pCoarseMipData != nullptr, "Mip level ", Mip, " data must not be null");
+
+        const MipLevelFilter Filter{LevelAttribs};
+
+        const Uint32 CoarseMipHeight = Filter.GetCoarseMipHeight();
+        const Uint32 RowsPerTile     = Filter.GetRowsPerTile();
+        const Uint32 NumTiles        = (CoarseMipHeight + RowsPerTile - 1) / RowsPerTile;
+        ProcessTiles(Attribs.pThreadPool, NumTiles,
+                     [&](size_t Tile) {
+                         const Uint32 RowBegin = static_cast<Uint32>(Tile) * RowsPerTile;
+                         Filter.FilterRows(RowBegin, std::min(RowBegin + RowsPerTile, CoarseMipHeight));
+                     });
+
+        if (PreserveAlphaCoverage)
+        {
+            // Scale alpha so that the fraction of texels that pass the alpha test matches the most detailed
+            // level, see http://the-witness.net/news/2010/09/computing-alpha-mipmaps/
+            const Uint32 CoarseMipWidth = Filter.GetCoarseMipWidth();
+            const auto   Histogram      = ComputeAlphaHistogram(LevelAttribs.pCoarseMipData, LevelAttribs.CoarseMipStride, CoarseMipWidth, CoarseMipHeight, FmtAttribs.NumComponents);
+            const double NumTexels      = static_cast<double>(CoarseMipWidth) * static_cast<double>(CoarseMipHeight);
+
+            auto GetCoverageError = [&](float Scale) {
+                return std::abs(static_cast<double>(GetAlphaCoverage(Histogram, Scale, Attribs.AlphaCutoff)) / NumTexels - RefCoverage);
+            };
+
+            // Coverage is a non-decreasing step function of the scale, so the exact match may not exist.
+            // Find the step that contains the reference coverage and use its closest side.
+            float MinScale = 0;
+            float MaxScale = 256;
+            for (int i = 0; i < 24; ++i)
+            {
+                const float Scale = (MinScale + MaxScale) * 0.5f;
+                if (static_cast<double>(GetAlphaCoverage(Histogram, Scale, Attribs.AlphaCutoff)) / NumTexels < RefCoverage)
+                    MinScale = Scale;
+                else
+                    MaxScale = Scale;
+            }
+            const float AlphaScale = GetCoverageError(MinScale) < GetCoverageError(MaxScale) ? MinScale : MaxScale;
+
+            std::array<Uint8, 256> AlphaRemap;
+            for (Uint32 a = 0; a < 256; ++a)
+                AlphaRemap[a] = static_cast<Uint8>(std::min(static_cast<float>(a) * AlphaScale + 0.5f, 255.f));
+
+            const Uint32 NumChannels = FmtAttribs.NumComponents;
+            ProcessTiles(Attribs.pThreadPool, NumTiles,
+                         [&](size_t Tile) {
+                             const Uint32 RowBegin = static_cast<Uint32>(Tile) * RowsPerTile;
+                             const Uint32 RowEnd   = std::min(RowBegin + RowsPerTile, CoarseMipHeight);
+                             for (Uint32 row = RowBegin; row < RowEnd; ++row)
+                             {
+                                 Uint8* pRow = reinterpret_cast<Uint8*>(LevelAttribs.pCoarseMipData) + row * LevelAttribs.CoarseMipStride;
+                                 for (Uint32 col = 0; col < CoarseMipWidth; ++col)
+                                 {
+                                     Uint8& Alpha = pRow[col * NumChannels + NumChannels - 1];
+                                     Alpha        = AlphaRemap[Alpha];
+                                 }
+                             }
+                         });
+        }
     }
 }
 
@@ -764,6 +1394,11 @@ extern "C"
         Diligent::ComputeMipLevel(Attribs);
     }
 
+    void Diligent_ComputeMipChain(const Diligent::ComputeMipChainAttribs& Attribs)
+    {
+        Diligent::ComputeMipChain(Attribs);
+    }
+
     void Diligent_CreateSparseTextureMtl(Diligent::IRenderDevice*     pDevice,
                                          const Diligent::TextureDesc& TexDesc,
                                          Diligent::IDeviceMemory*     pMemory,
@@ -57,6 +57,43 @@ void CreateSparseTextureMtl(IRenderDevice*     pDevice,
     pDeviceMtl->CreateSparseTexture(TexDesc, pMemory, ppTexture);
 }
 
+void CreateRasterizationRateMapMtl(IRenderDevice*  pDevice,
+                                   const char*     Name,
+                                   Uint32          ScreenWidth,
+                                   Uint32          ScreenHeight,
+                                   Uint32          NumColumns,
+                                   const float*    pHorizontal,
+                                   Uint32          NumRows,
+                                   const float*    pVertical,
+                                   IDeviceObject** ppRRM,
+                                   ITextureView**  ppView)
+{
+    RefCntAutoPtr<IRenderDeviceMtl> pDeviceMtl{pDevice, IID_RenderDeviceMtl};
+    if (!pDeviceMtl)
+        return;
+
+    RasterizationRateLayerDesc Layer;
+    Layer.HorizontalCount = NumColumns;
+    Layer.VerticalCount   = NumRows;
+    Layer.pHorizontal     = pHorizontal;
+    Layer.pVertical       = pVertical;
+
+    RasterizationRateMapCreateInfo CI;
+    CI.Desc.Name         = Name;
+    CI.Desc.ScreenWidth  = ScreenWidth;
+    CI.Desc.ScreenHeight = ScreenHeight;
+    CI.Desc.LayerCount   = 1;
+    CI.pLayers           = &Layer;
+
+    RefCntAutoPtr<IRasterizationRateMapMtl> pRRM;
+    pDeviceMtl->CreateRasterizationRateMap(CI, &pRRM);
+    if (!pRRM)
+        return;
+
+    *ppView = pRRM->GetView();
+    *ppRRM  = pRRM.Detach();
+}
+
 int64_t GetNativeTextureFormatMtl(TEXTURE_FORMAT TexFormat)
 {
     return static_cast<int64_t>(TextureFormatToMTLPixelFormat(TexFormat));
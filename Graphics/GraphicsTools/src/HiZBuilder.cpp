@@ -0,0 +1,805 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "HiZBuilder.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "PlatformMisc.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Every thread group reduces a 64x64 tile of the most detailed level, and the last thread group
+// reduces up to 64x64 tiles, which limits the pyramid size to 4096x4096 (13 levels).
+constexpr Uint32 MaxHiZLevels = 13;
+constexpr Uint32 TileSize     = 64;
+constexpr Uint32 MaxHiZSize   = TileSize * TileSize;
+
+// Thread group size of the multi-pass shaders
+constexpr Uint32 ReduceGroupSize = 8;
+
+constexpr int HIZ_MODE_SINGLE_PASS = 0;
+constexpr int HIZ_MODE_LEVEL0      = 1;
+constexpr int HIZ_MODE_REDUCE      = 2;
+
+struct HiZConstants
+{
+    Uint32 DepthWidth  = 0;
+    Uint32 DepthHeight = 0;
+    Uint32 HiZWidth    = 0;
+    Uint32 HiZHeight   = 0;
+
+    Uint32 LastMip       = 0;
+    Uint32 NumWorkGroups = 0;
+    Uint32 NumGroupsX    = 0;
+    Uint32 Mip           = 0;
+};
+
+constexpr char HiZShaderSource[] = R"(
+#define HIZ_MODE_SINGLE_PASS 0
+#define HIZ_MODE_LEVEL0      1
+#define HIZ_MODE_REDUCE      2
+
+cbuffer cbHiZConstants
+{
+    uint2 g_DepthSize;
+    uint2 g_HiZSize;
+
+    uint  g_LastMip;
+    uint  g_NumWorkGroups;
+    uint  g_NumGroupsX;
+    uint  g_Mip;
+};
+
+#if REVERSE_DEPTH
+#    define FARTHEST_DEPTH min
+#    define NEAREST_DEPTH  max
+#else
+#    define FARTHEST_DEPTH max
+#    define NEAREST_DEPTH  min
+#endif
+
+// x - the farthest depth, y - the nearest depth
+float2 Combine(float2 A, float2 B)
+{
+    return float2(FARTHEST_DEPTH(A.x, B.x), NEAREST_DEPTH(A.y, B.y));
+}
+
+#if STORE_NEAREST_DEPTH
+#    define HIZ_VALUE(Value) (Value)
+#else
+#    define HIZ_VALUE(Value) (Value).x
+#endif
+
+uint2 GetMipSize(uint Mip)
+{
+    return max(g_HiZSize >> Mip, uint2(1u, 1u));
+}
+
+#if HIZ_MODE != HIZ_MODE_REDUCE
+Texture2D<float> g_Depth;
+
+// Returns the farthest and the nearest depth of all depth buffer texels that overlap the level 0 texel.
+// The level 0 size never exceeds the depth buffer size, so the footprint is at most 3x3 texels.
+float2 LoadDepthFootprint(uint2 Texel)
+{
+    uint2  Start = (Texel * g_DepthSize) / g_HiZSize;
+    uint2  End   = min(((Texel + uint2(1u, 1u)) * g_DepthSize + g_HiZSize - uint2(1u, 1u)) / g_HiZSize, g_DepthSize);
+    float  Depth = g_Depth.Load(int3(int2(Start), 0));
+    float2 Value = float2(Depth, Depth);
+    for (uint y = Start.y; y < End.y; ++y)
+    {
+        for (uint x = Start.x; x < End.x; ++x)
+        {
+            Depth = g_Depth.Load(int3(int(x), int(y), 0));
+            Value = Combine(Value, float2(Depth, Depth));
+        }
+    }
+    return Value;
+}
+#endif
+
+#if HIZ_MODE == HIZ_MODE_SINGLE_PASS
+
+#if STORE_NEAREST_DEPTH
+#    define HIZ_TYPE float2
+#else
+#    define HIZ_TYPE float
+#endif
+
+RWTexture2D<HIZ_TYPE> g_OutMip0;
+RWTexture2D<HIZ_TYPE> g_OutMip1;
+RWTexture2D<HIZ_TYPE> g_OutMip2;
+RWTexture2D<HIZ_TYPE> g_OutMip3;
+RWTexture2D<HIZ_TYPE> g_OutMip4;
+RWTexture2D<HIZ_TYPE> g_OutMip5;
+RWTexture2D<HIZ_TYPE> g_OutMip6;
+RWTexture2D<HIZ_TYPE> g_OutMip7;
+RWTexture2D<HIZ_TYPE> g_OutMip8;
+RWTexture2D<HIZ_TYPE> g_OutMip9;
+RWTexture2D<HIZ_TYPE> g_OutMip10;
+RWTexture2D<HIZ_TYPE> g_OutMip11;
+RWTexture2D<HIZ_TYPE> g_OutMip12;
+
+globallycoherent RWStructuredBuffer<float2> g_Mip6;
+RWBuffer<uint /*format=r32ui*/> g_Counter;
+
+groupshared float2 g_Tile[32 * 32];
+groupshared uint   g_PrevCount;
+
+void StoreMip(uint Mip, uint2 Coord, float2 Value)
+{
+    uint2 Size = GetMipSize(Mip);
+    if (Mip > g_LastMip || Coord.x >= Size.x || Coord.y >= Size.y)
+        return;
+
+    if      (Mip ==  0u) g_OutMip0[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  1u) g_OutMip1[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  2u) g_OutMip2[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  3u) g_OutMip3[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  4u) g_OutMip4[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  5u) g_OutMip5[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  6u) g_OutMip6[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  7u) g_OutMip7[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  8u) g_OutMip8[Coord]  = HIZ_VALUE(Value);
+    else if (Mip ==  9u) g_OutMip9[Coord]  = HIZ_VALUE(Value);
+    else if (Mip == 10u) g_OutMip10[Coord] = HIZ_VALUE(Value);
+    else if (Mip == 11u) g_OutMip11[Coord] = HIZ_VALUE(Value);
+    else if (Mip == 12u) g_OutMip12[Coord] = HIZ_VALUE(Value);
+}
+
+// Reduces the level Mip-1 tile stored in the group-shared memory to the level Mip tile of size TileSize.
+// TileOrigin is the position of the level Mip tile in the level.
+void ReduceTile(uint LocalIdx, uint TileSize, uint Mip, uint2 TileOrigin)
+{
+    bool   IsActive = LocalIdx < TileSize * TileSize;
+    uint2  Coord    = uint2(LocalIdx % TileSize, LocalIdx / TileSize);
+    float2 Value    = float2(0.0, 0.0);
+    if (IsActive)
+    {
+        // Level sizes are powers of two, so the children are only clamped when
+        // one dimension of the level is 1, or when the tile is outside of the level.
+        uint2 PrevSize = GetMipSize(Mip - 1u);
+        for (uint i = 0u; i < 4u; ++i)
+        {
+            uint2 Child = min((TileOrigin + Coord) * 2u + uint2(i & 1u, i >> 1u), PrevSize - 1u);
+            Child       = max(Child, TileOrigin * 2u) - TileOrigin * 2u;
+
+            float2 ChildValue = g_Tile[Child.y * TileSize * 2u + Child.x];
+            Value = i == 0u ? ChildValue : Combine(Value, ChildValue);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (IsActive)
+    {
+        g_Tile[Coord.y * TileSize + Coord.x] = Value;
+        StoreMip(Mip, TileOrigin + Coord, Value);
+    }
+    GroupMemoryBarrierWithGroupSync();
+}
+
+[numthreads(256, 1, 1)]
+void main(uint3 GroupId  : SV_GroupID,
+          uint  LocalIdx : SV_GroupIndex)
+{
+    uint2 Group = GroupId.xy;
+
+    // Levels 0 and 1: every thread computes 4 texels of the 32x32 level 1 tile
+    // from 2x2 level 0 texels each, which are read from the depth buffer.
+    {
+        uint2 Mip1Origin = Group * 32u;
+        for (uint i = 0u; i < 4u; ++i)
+        {
+            uint   Idx   = LocalIdx + i * 256u;
+            uint2  Texel = Mip1Origin + uint2(Idx % 32u, Idx / 32u);
+            float2 Value = float2(0.0, 0.0);
+            for (uint j = 0u; j < 4u; ++j)
+            {
+                uint2  Mip0Texel = Texel * 2u + uint2(j & 1u, j >> 1u);
+                float2 Mip0Value = LoadDepthFootprint(min(Mip0Texel, g_HiZSize - 1u));
+                StoreMip(0u, Mip0Texel, Mip0Value);
+                Value = j == 0u ? Mip0Value : Combine(Value, Mip0Value);
+            }
+            g_Tile[Idx] = Value;
+            StoreMip(1u, Texel, Value);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Levels 2 to 6
+    for (uint Mip = 2u; Mip <= min(g_LastMip, 6u); ++Mip)
+    {
+        uint TileSize = 32u >> (Mip - 1u);
+        ReduceTile(LocalIdx, TileSize, Mip, Group * TileSize);
+    }
+
+    if (g_LastMip <= 6u)
+        return;
+
+    if (LocalIdx == 0u)
+    {
+        g_Mip6[Group.y * g_NumGroupsX + Group.x] = g_Tile[0];
+        // Make the value visible to other groups before incrementing the counter
+        DeviceMemoryBarrier();
+        uint PrevCount;
+        InterlockedAdd(g_Counter[0], 1u, PrevCount);
+        g_PrevCount = PrevCount;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Only the last group continues
+    if (g_PrevCount != g_NumWorkGroups - 1u)
+        return;
+
+    if (LocalIdx == 0u)
+    {
+        // Reset the counter for the next use
+        g_Counter[0] = 0u;
+    }
+    DeviceMemoryBarrier();
+
+    // Level 7: every thread computes 4 texels from the level 6 values of all groups
+    {
+        uint2 Mip6Size = GetMipSize(6u);
+        for (uint i = 0u; i < 4u; ++i)
+        {
+            uint   Idx   = LocalIdx + i * 256u;
+            uint2  Texel = uint2(Idx % 32u, Idx / 32u);
+            float2 Value = float2(0.0, 0.0);
+            for (uint j = 0u; j < 4u; ++j)
+            {
+                uint2  Src      = min(Texel * 2u + uint2(j & 1u, j >> 1u), Mip6Size - 1u);
+                float2 SrcValue = g_Mip6[Src.y * g_NumGroupsX + Src.x];
+                Value = j == 0u ? SrcValue : Combine(Value, SrcValue);
+            }
+            g_Tile[Idx] = Value;
+            StoreMip(7u, Texel, Value);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Levels 8 to 12
+    for (uint Mip = 8u; Mip <= g_LastMip; ++Mip)
+    {
+        ReduceTile(LocalIdx, 32u >> (Mip - 7u), Mip, uint2(0u, 0u));
+    }
+}
+
+#else
+
+#if STORE_NEAREST_DEPTH
+RWTexture2D<float2 /*format=rg32f*/> g_OutMip;
+#else
+RWTexture2D<float /*format=r32f*/> g_OutMip;
+#endif
+
+#if HIZ_MODE == HIZ_MODE_REDUCE
+#    if STORE_NEAREST_DEPTH
+Texture2D<float2> g_PrevMip;
+#    else
+Texture2D<float> g_PrevMip;
+#    endif
+
+float2 LoadPrevMip(uint2 Coord)
+{
+#    if STORE_NEAREST_DEPTH
+    return g_PrevMip.Load(int3(int2(Coord), 0));
+#    else
+    float Depth = g_PrevMip.Load(int3(int2(Coord), 0));
+    return float2(Depth, Depth);
+#    endif
+}
+#endif
+
+[numthreads(REDUCE_GROUP_SIZE, REDUCE_GROUP_SIZE, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    uint2 Size = GetMipSize(g_Mip);
+    if (DTid.x >= Size.x || DTid.y >= Size.y)
+        return;
+
+#if HIZ_MODE == HIZ_MODE_LEVEL0
+    float2 Value = LoadDepthFootprint(DTid.xy);
+#else
+    uint2  PrevMax = GetMipSize(g_Mip - 1u) - uint2(1u, 1u);
+    float2 Value   = LoadPrevMip(min(DTid.xy * 2u, PrevMax));
+    Value = Combine(Value, LoadPrevMip(min(DTid.xy * 2u + uint2(1u, 0u), PrevMax)));
+    Value = Combine(Value, LoadPrevMip(min(DTid.xy * 2u + uint2(0u, 1u), PrevMax)));
+    Value = Combine(Value, LoadPrevMip(min(DTid.xy * 2u + uint2(1u, 1u), PrevMax)));
+#endif
+
+    g_OutMip[DTid.xy] = HIZ_VALUE(Value);
+}
+
+#endif
+)";
+
+constexpr char HiZOcclusionTestShaderSource[] = R"(
+#ifndef HIZ_REVERSE_DEPTH
+#    define HIZ_REVERSE_DEPTH 0
+#endif
+
+// Returns the farthest depth of the screen region [MinUV, MaxUV] from the level of the Hi-Z pyramid
+// where the region covers at most 2x2 texels, or false if the pyramid has no such level.
+bool GetHiZFarthestDepth(Texture2D<float> HiZ,
+                         float2           HiZSize,
+                         uint             HiZMipCount,
+                         float2           MinUV,
+                         float2           MaxUV,
+                         out float        Depth)
+{
+    Depth = 0.0;
+
+    float2 Extent   = (MaxUV - MinUV) * HiZSize;
+    uint   MipLevel = uint(ceil(log2(max(max(Extent.x, Extent.y), 1.0))));
+    if (MipLevel >= HiZMipCount)
+        return false;
+
+    float2 MipSize  = max(floor(HiZSize / exp2(float(MipLevel))), float2(1.0, 1.0));
+    int2   MaxCoord = int2(MipSize) - int2(1, 1);
+    int2   MinTexel = min(int2(MinUV * MipSize), MaxCoord);
+    int2   MaxTexel = min(int2(MaxUV * MipSize), MaxCoord);
+
+    float4 Texels;
+    Texels.x = HiZ.Load(int3(MinTexel.x, MinTexel.y, int(MipLevel)));
+    Texels.y = HiZ.Load(int3(MaxTexel.x, MinTexel.y, int(MipLevel)));
+    Texels.z = HiZ.Load(int3(MinTexel.x, MaxTexel.y, int(MipLevel)));
+    Texels.w = HiZ.Load(int3(MaxTexel.x, MaxTexel.y, int(MipLevel)));
+
+#if HIZ_REVERSE_DEPTH
+    Depth = min(min(Texels.x, Texels.y), min(Texels.z, Texels.w));
+#else
+    Depth = max(max(Texels.x, Texels.y), max(Texels.z, Texels.w));
+#endif
+    return true;
+}
+
+// Returns true if the box transformed by ViewProj is entirely behind the depth stored in the Hi-Z pyramid.
+bool IsBoxOccludedByHiZ(Texture2D<float> HiZ,
+                        float2           HiZSize,
+                        uint             HiZMipCount,
+                        float3           BoundsMin,
+                        float3           BoundsMax,
+                        float4x4         ViewProj,
+                        bool             IsGLNDC)
+{
+    float2 MinUV    = float2(1.0, 1.0);
+    float2 MaxUV    = float2(0.0, 0.0);
+    float  MinDepth = 1.0;
+    float  MaxDepth = 0.0;
+    for (uint i = 0u; i < 8u; ++i)
+    {
+        float3 Corner = float3((i & 1u) != 0u ? BoundsMax.x : BoundsMin.x,
+                               (i & 2u) != 0u ? BoundsMax.y : BoundsMin.y,
+                               (i & 4u) != 0u ? BoundsMax.z : BoundsMin.z);
+        float4 Pos = mul(float4(Corner, 1.0), ViewProj);
+        if (Pos.w <= 0.0)
+            return false; // The box intersects the near plane
+
+        float3 NDC = Pos.xyz / Pos.w;
+        float2 UV;
+        float  Depth;
+        if (IsGLNDC)
+        {
+            UV    = NDC.xy * 0.5 + 0.5;
+            Depth = NDC.z * 0.5 + 0.5;
+        }
+        else
+        {
+            UV    = float2(NDC.x * 0.5 + 0.5, 0.5 - NDC.y * 0.5);
+            Depth = NDC.z;
+        }
+        MinUV    = min(MinUV, UV);
+        MaxUV    = max(MaxUV, UV);
+        MinDepth = min(MinDepth, Depth);
+        MaxDepth = max(MaxDepth, Depth);
+    }
+
+    float HiZDepth;
+    if (!GetHiZFarthestDepth(HiZ, HiZSize, HiZMipCount, saturate(MinUV), saturate(MaxUV), HiZDepth))
+        return false;
+
+#if HIZ_REVERSE_DEPTH
+    // The box is occluded if its nearest point is farther than the farthest occluder
+    return MaxDepth < HiZDepth;
+#else
+    return MinDepth > HiZDepth;
+#endif
+}
+)";
+
+} // namespace
+
+HiZBuilder::HiZBuilder(IRenderDevice* pDevice, const HiZBuilderCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Name{CI.Name != nullptr ? CI.Name : "Hi-Z builder"},
+    m_Format{CI.StoreNearestDepth ? TEX_FORMAT_RG32_FLOAT : TEX_FORMAT_R32_FLOAT}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+
+    const RenderDeviceInfo& DeviceInfo = m_pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("Hi-Z builder requires compute shaders");
+
+    // Direct3D11 does not allow binding 14 UAVs to the compute stage on feature level 11.0.
+    // OpenGL, WebGPU and Metal build the pyramid one level at a time.
+    m_SinglePass = DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12 || DeviceInfo.Type == RENDER_DEVICE_TYPE_VULKAN;
+
+    CreateUniformBuffer(m_pDevice, sizeof(HiZConstants), (m_Name + " - constants").c_str(), &m_pConstantsBuffer);
+    if (!m_pConstantsBuffer)
+        LOG_ERROR_AND_THROW("Failed to create the constants buffer");
+
+    CreatePipelines(CI);
+
+    if (m_SinglePass)
+    {
+        const std::string Name = m_Name + " - counter";
+
+        BufferDesc Desc;
+        Desc.Name              = Name.c_str();
+        Desc.Size              = sizeof(Uint32);
+        Desc.BindFlags         = BIND_UNORDERED_ACCESS;
+        Desc.Usage             = USAGE_DEFAULT;
+        Desc.Mode              = BUFFER_MODE_FORMATTED;
+        Desc.ElementByteStride = sizeof(Uint32);
+
+        // The counter must be zero initially. The last thread group resets it.
+        const Uint32 Zero = 0;
+        BufferData   InitData{&Zero, sizeof(Zero)};
+
+        m_pDevice->CreateBuffer(Desc, &InitData, &m_pCounterBuffer);
+        if (!m_pCounterBuffer)
+            LOG_ERROR_AND_THROW("Failed to create the counter buffer");
+
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 1;
+
+        RefCntAutoPtr<IBufferView> pUAV;
+        m_pCounterBuffer->CreateView(ViewDesc, &pUAV);
+        if (!pUAV)
+            LOG_ERROR_AND_THROW("Failed to create the UAV of the counter buffer");
+        m_Pipelines[0].pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Counter")->Set(pUAV);
+    }
+}
+
+void HiZBuilder::CreatePipelines(const HiZBuilderCreateInfo& CI)
+{
+    const Uint32 NumPipelines = m_SinglePass ? 1 : 2;
+    for (Uint32 i = 0; i < NumPipelines; ++i)
+    {
+        Pipeline& Pipeline = m_Pipelines[i];
+
+        const int Mode = m_SinglePass ? HIZ_MODE_SINGLE_PASS : (i == 0 ? HIZ_MODE_LEVEL0 : HIZ_MODE_REDUCE);
+
+        ShaderMacroHelper Macros;
+        Macros.Add("HIZ_MODE", Mode);
+        Macros.Add("REDUCE_GROUP_SIZE", static_cast<int>(ReduceGroupSize));
+        Macros.Add("REVERSE_DEPTH", CI.ReverseDepth);
+        Macros.Add("STORE_NEAREST_DEPTH", CI.StoreNearestDepth);
+
+        const std::string Name = m_Name + (Mode == HIZ_MODE_LEVEL0 ? " - level 0" : (Mode == HIZ_MODE_REDUCE ? " - reduction" : ""));
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Desc           = {Name.c_str(), SHADER_TYPE_COMPUTE, true};
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.Source         = HiZShaderSource;
+        ShaderCI.SourceLength   = sizeof(HiZShaderSource) - 1;
+        ShaderCI.EntryPoint     = "main";
+        ShaderCI.Macros         = Macros;
+
+        RefCntAutoPtr<IShader> pCS;
+        m_pDevice->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            LOG_ERROR_AND_THROW("Failed to create the Hi-Z shader");
+
+        // clang-format off
+        const ShaderResourceVariableDesc Variables[] =
+        {
+            {SHADER_TYPE_COMPUTE, "cbHiZConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        };
+        // clang-format on
+
+        ComputePipelineStateCreateInfo PsoCI{Name.c_str()};
+        PsoCI.pCS = pCS;
+
+        // The depth buffer and the pyramid levels change between the dispatches
+        PsoCI.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+        PsoCI.PSODesc.ResourceLayout.Variables           = Variables;
+        PsoCI.PSODesc.ResourceLayout.NumVariables        = _countof(Variables);
+
+        m_pDevice->CreateComputePipelineState(PsoCI, &Pipeline.pPSO);
+        if (!Pipeline.pPSO)
+            LOG_ERROR_AND_THROW("Failed to create the Hi-Z pipeline");
+
+        Pipeline.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbHiZConstants")->Set(m_pConstantsBuffer);
+
+        Pipeline.pPSO->CreateShaderResourceBinding(&Pipeline.pSRB, true);
+        VERIFY_EXPR(Pipeline.pSRB);
+
+        if (Mode == HIZ_MODE_REDUCE)
+        {
+            Pipeline.pPrevMipVar = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_PrevMip");
+            VERIFY_EXPR(Pipeline.pPrevMipVar != nullptr);
+        }
+        else
+        {
+            Pipeline.pDepthVar = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Depth");
+            VERIFY_EXPR(Pipeline.pDepthVar != nullptr);
+        }
+
+        if (Mode == HIZ_MODE_SINGLE_PASS)
+        {
+            for (Uint32 Mip = 0; Mip < MaxHiZLevels; ++Mip)
+            {
+                const std::string VarName = "g_OutMip" + std::to_string(Mip);
+                Pipeline.pOutMipVars[Mip] = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, VarName.c_str());
+                VERIFY_EXPR(Pipeline.pOutMipVars[Mip] != nullptr);
+            }
+        }
+        else
+        {
+            Pipeline.pOutMipVars[0] = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_OutMip");
+            VERIFY_EXPR(Pipeline.pOutMipVars[0] != nullptr);
+        }
+    }
+}
+
+bool HiZBuilder::CreateHiZTexture(Uint32 DepthWidth, Uint32 DepthHeight)
+{
+    m_pHiZTexture.Release();
+    m_pHiZSRV.Release();
+    m_MipSRVs.clear();
+    m_MipUAVs.clear();
+    m_DepthWidth  = 0;
+    m_DepthHeight = 0;
+
+    const std::string Name = m_Name + " - pyramid";
+
+    // Every texel of a coarser level covers exactly 2x2 texels of the previous level
+    TextureDesc Desc;
+    Desc.Name      = Name.c_str();
+    Desc.Type      = RESOURCE_DIM_TEX_2D;
+    Desc.Width     = std::min(Uint32{1} << PlatformMisc::GetMSB(DepthWidth), MaxHiZSize);
+    Desc.Height    = std::min(Uint32{1} << PlatformMisc::GetMSB(DepthHeight), MaxHiZSize);
+    Desc.MipLevels = ComputeMipLevelsCount(Desc.Width, Desc.Height);
+    Desc.Format    = m_Format;
+    Desc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    Desc.Usage     = USAGE_DEFAULT;
+    VERIFY_EXPR(Desc.MipLevels <= MaxHiZLevels);
+
+    m_pDevice->CreateTexture(Desc, nullptr, &m_pHiZTexture);
+    if (!m_pHiZTexture)
+    {
+        LOG_ERROR_MESSAGE("Failed to create the Hi-Z pyramid texture");
+        return false;
+    }
+    m_pHiZSRV = m_pHiZTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    TextureViewDesc ViewDesc;
+    ViewDesc.TextureDim   = RESOURCE_DIM_TEX_2D;
+    ViewDesc.NumMipLevels = 1;
+
+    m_MipUAVs.resize(Desc.MipLevels);
+    if (!m_SinglePass)
+        m_MipSRVs.resize(Desc.MipLevels);
+    for (Uint32 Mip = 0; Mip < Desc.MipLevels; ++Mip)
+    {
+        ViewDesc.MostDetailedMip = Mip;
+
+        ViewDesc.ViewType = TEXTURE_VIEW_UNORDERED_ACCESS;
+        m_pHiZTexture->CreateView(ViewDesc, &m_MipUAVs[Mip]);
+
+        if (!m_SinglePass)
+        {
+            ViewDesc.ViewType = TEXTURE_VIEW_SHADER_RESOURCE;
+            m_pHiZTexture->CreateView(ViewDesc, &m_MipSRVs[Mip]);
+        }
+
+        if (!m_MipUAVs[Mip] || (!m_SinglePass && !m_MipSRVs[Mip]))
+        {
+            LOG_ERROR_MESSAGE("Failed to create the view of level ", Mip, " of the Hi-Z pyramid");
+            m_pHiZTexture.Release();
+            m_pHiZSRV.Release();
+            return false;
+        }
+    }
+
+    if (m_SinglePass)
+    {
+        // Levels that the pyramid does not have are never written and use the last level's view
+        for (Uint32 Mip = 0; Mip < MaxHiZLevels; ++Mip)
+            m_Pipelines[0].pOutMipVars[Mip]->Set(m_MipUAVs[std::min(Mip, Desc.MipLevels - 1)]);
+
+        const Uint32 NumGroups = ((Desc.Width + TileSize - 1) / TileSize) * ((Desc.Height + TileSize - 1) / TileSize);
+        if (!m_pMip6Buffer || m_pMip6Buffer->GetDesc().Size < Uint64{NumGroups} * sizeof(float2))
+        {
+            const std::string BufferName = m_Name + " - level 6";
+
+            BufferDesc BuffDesc;
+            BuffDesc.Name              = BufferName.c_str();
+            BuffDesc.Size              = Uint64{NumGroups} * sizeof(float2);
+            BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+            BuffDesc.Usage             = USAGE_DEFAULT;
+            BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+            BuffDesc.ElementByteStride = sizeof(float2);
+
+            m_pMip6Buffer.Release();
+            m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_pMip6Buffer);
+            if (!m_pMip6Buffer)
+            {
+                LOG_ERROR_MESSAGE("Failed to create the level 6 buffer");
+                m_pHiZTexture.Release();
+                m_pHiZSRV.Release();
+                return false;
+            }
+            m_Pipelines[0].pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Mip6")->Set(m_pMip6Buffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        }
+    }
+
+    m_DepthWidth  = DepthWidth;
+    m_DepthHeight = DepthHeight;
+
+    return true;
+}
+
+void HiZBuilder::Build(IDeviceContext* pContext, ITextureView* pDepthSRV)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pDepthSRV != nullptr, "Depth buffer view must not be null");
+    if (pDepthSRV == nullptr)
+        return;
+
+    const TextureViewDesc& DepthViewDesc = pDepthSRV->GetDesc();
+    ITexture*              pDepth        = pDepthSRV->GetTexture();
+    const TextureDesc&     DepthDesc     = pDepth->GetDesc();
+    DEV_CHECK_ERR(DepthViewDesc.ViewType == TEXTURE_VIEW_SHADER_RESOURCE, "Depth buffer view must be a shader resource view");
+    DEV_CHECK_ERR(DepthDesc.SampleCount == 1, "Multisample depth buffers are not supported");
+
+    const Uint32 DepthWidth  = std::max(DepthDesc.Width >> DepthViewDesc.MostDetailedMip, 1u);
+    const Uint32 DepthHeight = std::max(DepthDesc.Height >> DepthViewDesc.MostDetailedMip, 1u);
+    if (!m_pHiZTexture || DepthWidth != m_DepthWidth || DepthHeight != m_DepthHeight)
+    {
+        if (!CreateHiZTexture(DepthWidth, DepthHeight))
+            return;
+    }
+
+    const TextureDesc& HiZDesc = m_pHiZTexture->GetDesc();
+
+    // The buffers are transitioned from the unordered access state too, which makes
+    // the writes of the previous build visible.
+    std::vector<StateTransitionDesc> Barriers;
+    Barriers.reserve(4);
+    if (pDepth->GetState() != RESOURCE_STATE_UNKNOWN)
+        Barriers.emplace_back(pDepth, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    Barriers.emplace_back(m_pHiZTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    if (m_SinglePass)
+    {
+        Barriers.emplace_back(m_pMip6Buffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        Barriers.emplace_back(m_pCounterBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    }
+    pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+
+    HiZConstants Constants;
+    Constants.DepthWidth  = DepthWidth;
+    Constants.DepthHeight = DepthHeight;
+    Constants.HiZWidth    = HiZDesc.Width;
+    Constants.HiZHeight   = HiZDesc.Height;
+    Constants.LastMip     = HiZDesc.MipLevels - 1;
+
+    if (m_SinglePass)
+    {
+        const Pipeline& Pipeline = m_Pipelines[0];
+
+        const Uint32 NumGroupsX = (HiZDesc.Width + TileSize - 1) / TileSize;
+        const Uint32 NumGroupsY = (HiZDesc.Height + TileSize - 1) / TileSize;
+
+        Constants.NumWorkGroups = NumGroupsX * NumGroupsY;
+        Constants.NumGroupsX    = NumGroupsX;
+        {
+            MapHelper<HiZConstants> pConstants{pContext, m_pConstantsBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+            *pConstants = Constants;
+        }
+
+        Pipeline.pDepthVar->Set(pDepthSRV);
+
+        pContext->SetPipelineState(Pipeline.pPSO);
+        // All resources have been transitioned above
+        pContext->CommitShaderResources(Pipeline.pSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+        DispatchComputeAttribs DispatchAttribs{NumGroupsX, NumGroupsY, 1};
+        pContext->DispatchCompute(DispatchAttribs);
+
+        StateTransitionDesc Barrier{m_pHiZTexture, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+        pContext->TransitionResourceStates(1, &Barrier);
+    }
+    else
+    {
+        for (Uint32 Mip = 0; Mip < HiZDesc.MipLevels; ++Mip)
+        {
+            const Pipeline& Pipeline = m_Pipelines[Mip == 0 ? 0 : 1];
+
+            if (Mip == 0)
+            {
+                Pipeline.pDepthVar->Set(pDepthSRV);
+            }
+            else
+            {
+                // The previous level is read by this dispatch
+                StateTransitionDesc Barrier{m_pHiZTexture, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, Mip - 1, 1u};
+                pContext->TransitionResourceStates(1, &Barrier);
+                Pipeline.pPrevMipVar->Set(m_MipSRVs[Mip - 1]);
+            }
+            Pipeline.pOutMipVars[0]->Set(m_MipUAVs[Mip]);
+
+            Constants.Mip = Mip;
+            {
+                MapHelper<HiZConstants> pConstants{pContext, m_pConstantsBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+                *pConstants = Constants;
+            }
+
+            if (Mip <= 1)
+                pContext->SetPipelineState(Pipeline.pPSO);
+            pContext->CommitShaderResources(Pipeline.pSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+            const Uint32 MipWidth  = std::max(HiZDesc.Width >> Mip, 1u);
+            const Uint32 MipHeight = std::max(HiZDesc.Height >> Mip, 1u);
+
+            DispatchComputeAttribs DispatchAttribs{
+                (MipWidth + ReduceGroupSize - 1) / ReduceGroupSize,
+                (MipHeight + ReduceGroupSize - 1) / ReduceGroupSize,
+                1,
+            };
+            pContext->DispatchCompute(DispatchAttribs);
+        }
+
+        StateTransitionDesc Barrier{m_pHiZTexture, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, HiZDesc.MipLevels - 1, 1u};
+        pContext->TransitionResourceStates(1, &Barrier);
+
+        // Subresource transitions do not update the texture state
+        m_pHiZTexture->SetState(RESOURCE_STATE_SHADER_RESOURCE);
+    }
+}
+
+const char* HiZBuilder::GetOcclusionTestShaderSource()
+{
+    return HiZOcclusionTestShaderSource;
+}
+
+} // namespace Diligent
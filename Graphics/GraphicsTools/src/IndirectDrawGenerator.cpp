@@ -0,0 +1,444 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "IndirectDrawGenerator.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "AdvancedMath.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsUtilities.h"
+#include "ShaderMacroHelper.hpp"
+#include "ShaderSourceFactoryUtils.h"
+#include "HiZBuilder.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Number of Uint32 values in one DrawIndexedIndirect command
+constexpr Uint32 DrawArgsStride = 5;
+
+constexpr Uint32 CULLING_FLAG_FRUSTUM   = 1u << 0u;
+constexpr Uint32 CULLING_FLAG_OCCLUSION = 1u << 1u;
+constexpr Uint32 CULLING_FLAG_GL_NDC    = 1u << 2u;
+
+struct CullingConstants
+{
+    float4x4 ViewProj;
+    float4   FrustumPlanes[ViewFrustum::NUM_PLANES];
+
+    Uint32 NumInstances  = 0;
+    Uint32 NumDrawRanges = 0;
+    Uint32 Flags         = 0;
+    Uint32 HiZMipCount   = 0;
+
+    float2 HiZSize;
+    float2 Padding;
+};
+
+constexpr char CullingShaderSource[] = R"(
+cbuffer cbCullingConstants
+{
+    float4x4 g_ViewProj;
+    float4   g_FrustumPlanes[6];
+
+    uint     g_NumInstances;
+    uint     g_NumDrawRanges;
+    uint     g_Flags;
+    uint     g_HiZMipCount;
+
+    float2   g_HiZSize;
+    float2   g_Padding;
+};
+
+#define CULLING_FLAG_FRUSTUM   1u
+#define CULLING_FLAG_OCCLUSION 2u
+#define CULLING_FLAG_GL_NDC    4u
+
+struct DrawRange
+{
+    uint NumIndices;
+    uint FirstIndexLocation;
+    uint BaseVertex;
+    uint Padding;
+};
+
+struct InstanceData
+{
+    float3 BoundsMin;
+    uint   DrawRangeIndex;
+    float3 BoundsMax;
+    uint   Padding;
+};
+
+StructuredBuffer<DrawRange>    g_DrawRanges;
+StructuredBuffer<InstanceData> g_Instances;
+
+RWBuffer<uint /*format=r32ui*/> g_DrawArgs;
+RWBuffer<uint /*format=r32ui*/> g_DrawCount;
+
+bool IsInFrustum(float3 BoundsMin, float3 BoundsMax)
+{
+    for (uint i = 0u; i < 6u; ++i)
+    {
+        float4 Plane = g_FrustumPlanes[i];
+        // The box corner that is farthest along the plane normal
+        float3 Corner = float3(Plane.x >= 0.0 ? BoundsMax.x : BoundsMin.x,
+                               Plane.y >= 0.0 ? BoundsMax.y : BoundsMin.y,
+                               Plane.z >= 0.0 ? BoundsMax.z : BoundsMin.z);
+        if (dot(Plane.xyz, Corner) + Plane.w < 0.0)
+            return false;
+    }
+    return true;
+}
+
+#if OCCLUSION_CULLING
+Texture2D<float> g_HiZ;
+
+#define HIZ_REVERSE_DEPTH REVERSE_DEPTH
+#include "HiZOcclusionTest.fxh"
+#endif
+
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    uint InstanceIdx = DTid.x;
+    if (InstanceIdx >= g_NumInstances)
+        return;
+
+    InstanceData Instance = g_Instances[InstanceIdx];
+    if (Instance.DrawRangeIndex >= g_NumDrawRanges)
+        return;
+
+    if ((g_Flags & CULLING_FLAG_FRUSTUM) != 0u && !IsInFrustum(Instance.BoundsMin, Instance.BoundsMax))
+        return;
+
+#if OCCLUSION_CULLING
+    if ((g_Flags & CULLING_FLAG_OCCLUSION) != 0u &&
+        IsBoxOccludedByHiZ(g_HiZ, g_HiZSize, g_HiZMipCount, Instance.BoundsMin, Instance.BoundsMax, g_ViewProj, (g_Flags & CULLING_FLAG_GL_NDC) != 0u))
+        return;
+#endif
+
+    DrawRange Range = g_DrawRanges[Instance.DrawRangeIndex];
+
+    uint DrawIdx;
+    InterlockedAdd(g_DrawCount[0], 1u, DrawIdx);
+
+    uint Offset = DrawIdx * 5u;
+    g_DrawArgs[Offset + 0u] = Range.NumIndices;
+    g_DrawArgs[Offset + 1u] = 1u; // NumInstances
+    g_DrawArgs[Offset + 2u] = Range.FirstIndexLocation;
+    g_DrawArgs[Offset + 3u] = Range.BaseVertex;
+    g_DrawArgs[Offset + 4u] = InstanceIdx; // FirstInstanceLocation
+}
+)";
+
+} // namespace
+
+IndirectDrawGenerator::DrawRange IndirectDrawGenerator::MakeDrawRange(const IVertexPoolAllocation* pVertices, const IBufferSuballocation* pIndices, Uint32 IndexSize)
+{
+    DEV_CHECK_ERR(pVertices != nullptr, "Vertex pool allocation must not be null");
+    DEV_CHECK_ERR(pIndices != nullptr, "Index buffer suballocation must not be null");
+    DEV_CHECK_ERR(IndexSize == 2 || IndexSize == 4, "Index size (", IndexSize, ") must be 2 or 4");
+    DEV_CHECK_ERR(pIndices->GetOffset() % IndexSize == 0, "Index buffer suballocation offset (", pIndices->GetOffset(), ") is not a multiple of the index size (", IndexSize, ")");
+
+    DrawRange Range;
+    Range.NumIndices         = pIndices->GetSize() / IndexSize;
+    Range.FirstIndexLocation = pIndices->GetOffset() / IndexSize;
+    Range.BaseVertex         = pVertices->GetStartVertex();
+    return Range;
+}
+
+IndirectDrawGenerator::IndirectDrawGenerator(IRenderDevice* pDevice, const IndirectDrawGeneratorCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Name{CI.Name != nullptr ? CI.Name : "Indirect draw generator"},
+    m_MaxInstances{CI.MaxInstances},
+    m_ThreadGroupSize{CI.ThreadGroupSize}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (m_MaxInstances == 0)
+        LOG_ERROR_AND_THROW("MaxInstances must not be zero");
+    if (m_ThreadGroupSize == 0)
+        LOG_ERROR_AND_THROW("ThreadGroupSize must not be zero");
+
+    const RenderDeviceInfo& DeviceInfo = m_pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("Indirect draw generator requires compute shaders");
+    if ((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER) == 0)
+        LOG_ERROR_AND_THROW("Indirect draw generator requires indirect draws with a counter buffer");
+
+    CreateUniformBuffer(m_pDevice, sizeof(CullingConstants), (m_Name + " - constants").c_str(), &m_pConstantsBuffer);
+    if (!m_pConstantsBuffer)
+        LOG_ERROR_AND_THROW("Failed to create the constants buffer");
+
+    CreateStructuredBuffer("instances", sizeof(Instance), m_MaxInstances, m_pInstancesBuffer);
+
+    {
+        const std::string Name = m_Name + " - draw args";
+
+        BufferDesc Desc;
+        Desc.Name              = Name.c_str();
+        Desc.Size              = Uint64{m_MaxInstances} * DrawArgsStride * sizeof(Uint32);
+        Desc.BindFlags         = BIND_UNORDERED_ACCESS | BIND_INDIRECT_DRAW_ARGS;
+        Desc.Usage             = USAGE_DEFAULT;
+        Desc.Mode              = BUFFER_MODE_FORMATTED;
+        Desc.ElementByteStride = sizeof(Uint32);
+        m_pDevice->CreateBuffer(Desc, nullptr, &m_pDrawArgsBuffer);
+        if (!m_pDrawArgsBuffer)
+            LOG_ERROR_AND_THROW("Failed to create the draw args buffer");
+    }
+
+    {
+        const std::string Name = m_Name + " - draw count";
+
+        BufferDesc Desc;
+        Desc.Name              = Name.c_str();
+        Desc.Size              = sizeof(Uint32);
+        Desc.BindFlags         = BIND_UNORDERED_ACCESS | BIND_INDIRECT_DRAW_ARGS;
+        Desc.Usage             = USAGE_DEFAULT;
+        Desc.Mode              = BUFFER_MODE_FORMATTED;
+        Desc.ElementByteStride = sizeof(Uint32);
+
+        constexpr Uint32 Zero = 0;
+        BufferData       InitData{&Zero, sizeof(Zero)};
+        m_pDevice->CreateBuffer(Desc, &InitData, &m_pCountBuffer);
+        if (!m_pCountBuffer)
+            LOG_ERROR_AND_THROW("Failed to create the draw count buffer");
+    }
+
+    CreatePipeline(CI, false, m_Pipelines[0]);
+    if (CI.EnableOcclusionCulling)
+        CreatePipeline(CI, true, m_Pipelines[1]);
+}
+
+void IndirectDrawGenerator::CreateStructuredBuffer(const char* BufferName, Uint32 ElementSize, Uint32 NumElements, RefCntAutoPtr<IBuffer>& pBuffer)
+{
+    const std::string Name = m_Name + " - " + BufferName;
+
+    BufferDesc Desc;
+    Desc.Name              = Name.c_str();
+    Desc.Size              = Uint64{ElementSize} * NumElements;
+    Desc.BindFlags         = BIND_SHADER_RESOURCE;
+    Desc.Usage             = USAGE_DEFAULT;
+    Desc.Mode              = BUFFER_MODE_STRUCTURED;
+    Desc.ElementByteStride = ElementSize;
+
+    pBuffer.Release();
+    m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+    if (!pBuffer)
+        LOG_ERROR_AND_THROW("Failed to create the ", BufferName, " buffer");
+}
+
+void IndirectDrawGenerator::CreatePipeline(const IndirectDrawGeneratorCreateInfo& CI, bool OcclusionCulling, CullingPipeline& Pipeline)
+{
+    ShaderMacroHelper Macros;
+    Macros.Add("THREAD_GROUP_SIZE", static_cast<int>(m_ThreadGroupSize));
+    Macros.Add("OCCLUSION_CULLING", OcclusionCulling);
+    Macros.Add("REVERSE_DEPTH", CI.ReverseDepth);
+
+    const std::string Name = m_Name + (OcclusionCulling ? " - frustum and occlusion culling" : " - frustum culling");
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc           = {Name.c_str(), SHADER_TYPE_COMPUTE, true};
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Source         = CullingShaderSource;
+    ShaderCI.SourceLength   = sizeof(CullingShaderSource) - 1;
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Macros         = Macros;
+
+    // The occlusion test is shared with HiZBuilder
+    const MemoryShaderSourceFileInfo Includes[] = {
+        {"HiZOcclusionTest.fxh", HiZBuilder::GetOcclusionTestShaderSource()},
+    };
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    CreateMemoryShaderSourceFactory(MemoryShaderSourceFactoryCreateInfo{Includes, _countof(Includes)}, &pShaderSourceFactory);
+    ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        LOG_ERROR_AND_THROW("Failed to create the culling shader");
+
+    // clang-format off
+    const ShaderResourceVariableDesc Variables[] =
+    {
+        {SHADER_TYPE_COMPUTE, "g_DrawRanges", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        {SHADER_TYPE_COMPUTE, "g_HiZ",        SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+    };
+    // clang-format on
+
+    ComputePipelineStateCreateInfo PsoCI{Name.c_str()};
+    PsoCI.pCS = pCS;
+
+    PsoCI.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+    PsoCI.PSODesc.ResourceLayout.Variables           = Variables;
+    PsoCI.PSODesc.ResourceLayout.NumVariables        = OcclusionCulling ? _countof(Variables) : 1;
+
+    m_pDevice->CreateComputePipelineState(PsoCI, &Pipeline.pPSO);
+    if (!Pipeline.pPSO)
+        LOG_ERROR_AND_THROW("Failed to create the culling pipeline");
+
+    Pipeline.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbCullingConstants")->Set(m_pConstantsBuffer);
+    Pipeline.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_Instances")->Set(m_pInstancesBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+
+    auto SetFormattedUAV = [&](const char* VarName, IBuffer* pBuffer) {
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 1;
+
+        RefCntAutoPtr<IBufferView> pUAV;
+        pBuffer->CreateView(ViewDesc, &pUAV);
+        if (!pUAV)
+            LOG_ERROR_AND_THROW("Failed to create the UAV of buffer '", pBuffer->GetDesc().Name, "'");
+        Pipeline.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, VarName)->Set(pUAV);
+    };
+    SetFormattedUAV("g_DrawArgs", m_pDrawArgsBuffer);
+    SetFormattedUAV("g_DrawCount", m_pCountBuffer);
+
+    Pipeline.pPSO->CreateShaderResourceBinding(&Pipeline.pSRB, true);
+    VERIFY_EXPR(Pipeline.pSRB);
+
+    Pipeline.pDrawRangesVar = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_DrawRanges");
+    VERIFY_EXPR(Pipeline.pDrawRangesVar != nullptr);
+    if (OcclusionCulling)
+    {
+        Pipeline.pHiZVar = Pipeline.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_HiZ");
+        VERIFY_EXPR(Pipeline.pHiZVar != nullptr);
+    }
+}
+
+void IndirectDrawGenerator::SetDrawRanges(IDeviceContext* pContext, const DrawRange* pRanges, Uint32 NumRanges)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(NumRanges == 0 || pRanges != nullptr, "pRanges must not be null when NumRanges is not zero");
+
+    m_NumDrawRanges = NumRanges;
+    if (NumRanges == 0)
+        return;
+
+    if (!m_pDrawRangesBuffer || m_pDrawRangesBuffer->GetDesc().Size < Uint64{NumRanges} * sizeof(DrawRange))
+    {
+        // Grow the buffer geometrically to avoid recreating it every time a range is added
+        const Uint32 Capacity = m_pDrawRangesBuffer ? std::max(NumRanges, static_cast<Uint32>(m_pDrawRangesBuffer->GetDesc().Size / sizeof(DrawRange)) * 2) : NumRanges;
+        CreateStructuredBuffer("draw ranges", sizeof(DrawRange), Capacity, m_pDrawRangesBuffer);
+    }
+    pContext->UpdateBuffer(m_pDrawRangesBuffer, 0, Uint64{NumRanges} * sizeof(DrawRange), pRanges, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void IndirectDrawGenerator::SetInstances(IDeviceContext* pContext, const Instance* pInstances, Uint32 NumInstances)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(NumInstances == 0 || pInstances != nullptr, "pInstances must not be null when NumInstances is not zero");
+    DEV_CHECK_ERR(NumInstances <= m_MaxInstances, "The number of instances (", NumInstances, ") exceeds the maximum number of instances (", m_MaxInstances, ")");
+
+    m_NumInstances = std::min(NumInstances, m_MaxInstances);
+    if (m_NumInstances == 0)
+        return;
+
+    pContext->UpdateBuffer(m_pInstancesBuffer, 0, Uint64{m_NumInstances} * sizeof(Instance), pInstances, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void IndirectDrawGenerator::Generate(IDeviceContext* pContext, const GenerateAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    constexpr Uint32 Zero = 0;
+    pContext->UpdateBuffer(m_pCountBuffer, 0, sizeof(Zero), &Zero, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    if (m_NumInstances == 0 || m_NumDrawRanges == 0)
+        return;
+
+    const bool       OcclusionCulling = Attribs.pHiZBufferSRV != nullptr && m_Pipelines[1].pPSO;
+    CullingPipeline& Pipeline         = m_Pipelines[OcclusionCulling ? 1 : 0];
+
+    const bool IsGL = m_pDevice->GetDeviceInfo().IsGLDevice();
+    {
+        MapHelper<CullingConstants> Constants{pContext, m_pConstantsBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+
+        Constants->ViewProj = Attribs.ViewProj.Transpose();
+
+        ViewFrustum Frustum;
+        ExtractViewFrustumPlanesFromMatrix(Attribs.ViewProj, Frustum, IsGL);
+        for (Uint32 i = 0; i < ViewFrustum::NUM_PLANES; ++i)
+            Constants->FrustumPlanes[i] = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+
+        Constants->NumInstances  = m_NumInstances;
+        Constants->NumDrawRanges = m_NumDrawRanges;
+        Constants->Flags         = 0;
+        if (Attribs.FrustumCulling)
+            Constants->Flags |= CULLING_FLAG_FRUSTUM;
+        if (OcclusionCulling)
+            Constants->Flags |= CULLING_FLAG_OCCLUSION;
+        if (IsGL)
+            Constants->Flags |= CULLING_FLAG_GL_NDC;
+
+        if (OcclusionCulling)
+        {
+            const TextureViewDesc& ViewDesc = Attribs.pHiZBufferSRV->GetDesc();
+            const TextureDesc&     TexDesc  = Attribs.pHiZBufferSRV->GetTexture()->GetDesc();
+
+            Constants->HiZMipCount = ViewDesc.NumMipLevels;
+            Constants->HiZSize     = float2{
+                static_cast<float>(std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u)),
+                static_cast<float>(std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u)),
+            };
+        }
+        else
+        {
+            Constants->HiZMipCount = 0;
+            Constants->HiZSize     = float2{0, 0};
+        }
+    }
+
+    Pipeline.pDrawRangesVar->Set(m_pDrawRangesBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    if (OcclusionCulling)
+        Pipeline.pHiZVar->Set(Attribs.pHiZBufferSRV);
+
+    pContext->SetPipelineState(Pipeline.pPSO);
+    pContext->CommitShaderResources(Pipeline.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttribs{(m_NumInstances + m_ThreadGroupSize - 1) / m_ThreadGroupSize, 1, 1};
+    pContext->DispatchCompute(DispatchAttribs);
+}
+
+DrawIndexedIndirectAttribs IndirectDrawGenerator::GetDrawIndexedIndirectAttribs(VALUE_TYPE IndexType, DRAW_FLAGS Flags) const
+{
+    DrawIndexedIndirectAttribs Attribs{IndexType, m_pDrawArgsBuffer, Flags};
+    Attribs.DrawCount                        = std::min(m_NumInstances, m_pDevice->GetAdapterInfo().DrawCommand.MaxDrawIndirectCount);
+    Attribs.DrawArgsStride                   = DrawArgsStride * sizeof(Uint32);
+    Attribs.AttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.pCounterBuffer                   = m_pCountBuffer;
+    Attribs.CounterBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    return Attribs;
+}
+
+} // namespace Diligent
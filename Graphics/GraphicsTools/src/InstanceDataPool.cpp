@@ -0,0 +1,430 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "InstanceDataPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsUtilities.h"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The buffer is accessed through four-component 32-bit formatted views
+constexpr Uint32 ElementSize = 16;
+
+// The maximum number of thread groups in one scatter dispatch. Larger updates are
+// processed by the same threads in several iterations.
+constexpr Uint32 MaxScatterThreadGroups = 4096;
+
+struct ScatterConstants
+{
+    Uint32 NumSlots        = 0;
+    Uint32 ElementsPerSlot = 0;
+    Uint32 DataOffset      = 0;
+    Uint32 ThreadCount     = 0;
+};
+
+constexpr char ScatterShaderSource[] = R"(
+cbuffer cbScatterConstants
+{
+    uint g_NumSlots;        // The number of dirty slots
+    uint g_ElementsPerSlot; // The number of elements in one slot
+    uint g_DataOffset;      // Offset of the slot data in the delta buffer, in elements
+    uint g_ThreadCount;     // The total number of threads in the dispatch
+};
+
+// Slot indices (four per element), followed by the data of the dirty slots
+Buffer<uint4> g_Delta;
+
+RWBuffer<uint4 /*format=rgba32ui*/> g_InstanceData;
+
+[numthreads(THREAD_GROUP_SIZE, 1, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    uint NumElements = g_NumSlots * g_ElementsPerSlot;
+    for (uint Idx = DTid.x; Idx < NumElements; Idx += g_ThreadCount)
+    {
+        uint Entry = Idx / g_ElementsPerSlot;
+        uint Slot  = g_Delta[Entry / 4u][Entry % 4u];
+        g_InstanceData[Slot * g_ElementsPerSlot + Idx % g_ElementsPerSlot] = g_Delta[g_DataOffset + Idx];
+    }
+}
+)";
+
+} // namespace
+
+InstanceDataPool::InstanceDataPool(IRenderDevice* pDevice, const InstanceDataPoolCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Name{CI.Name != nullptr ? CI.Name : "Instance data pool"},
+    m_InstanceDataSize{CI.InstanceDataSize},
+    m_SlotsPerPage{std::max(CI.SlotsPerPage, 1u)},
+    m_ComputeUpdateThreshold{CI.ComputeUpdateThreshold},
+    m_ThreadGroupSize{CI.ThreadGroupSize}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (m_InstanceDataSize == 0 || m_InstanceDataSize % ElementSize != 0)
+        LOG_ERROR_AND_THROW("Instance data size (", m_InstanceDataSize, ") must be a non-zero multiple of ", ElementSize);
+    if (m_ThreadGroupSize == 0)
+        LOG_ERROR_AND_THROW("ThreadGroupSize must not be zero");
+
+    // Suballocation offsets are 32-bit
+    const Uint64 PageSize = Uint64{m_SlotsPerPage} * m_InstanceDataSize;
+    if (PageSize > std::numeric_limits<Uint32>::max())
+        LOG_ERROR_AND_THROW("The page size (", PageSize, ") exceeds the maximum buffer size");
+    const Uint64 MaxBufferSize = (Uint64{std::numeric_limits<Uint32>::max()} / PageSize) * PageSize;
+
+    // All pages have the same size, and the buffer size is always a multiple of the page size,
+    // so every page starts at a slot boundary.
+    const Uint64 InitialSize = std::min(AlignUp(Uint64{std::max(CI.InitialCapacity, 1u)} * m_InstanceDataSize, PageSize), MaxBufferSize);
+    const Uint64 MaxSize     = CI.MaxCapacity != 0 ?
+        std::min(AlignUp(Uint64{CI.MaxCapacity} * m_InstanceDataSize, PageSize), MaxBufferSize) :
+        MaxBufferSize;
+
+    BufferSuballocatorCreateInfo SuballocatorCI;
+    SuballocatorCI.Desc.Name              = m_Name.c_str();
+    SuballocatorCI.Desc.Size              = InitialSize;
+    SuballocatorCI.Desc.BindFlags         = CI.BindFlags;
+    SuballocatorCI.Desc.Usage             = USAGE_DEFAULT;
+    SuballocatorCI.Desc.Mode              = BUFFER_MODE_FORMATTED;
+    SuballocatorCI.Desc.ElementByteStride = ElementSize;
+    SuballocatorCI.MaxSize                = std::max(MaxSize, InitialSize);
+    CreateBufferSuballocator(m_pDevice, SuballocatorCI, &m_pSuballocator);
+    if (!m_pSuballocator)
+        LOG_ERROR_AND_THROW("Failed to create the buffer suballocator");
+
+    if (m_ComputeUpdateThreshold != 0 &&
+        m_pDevice->GetDeviceInfo().Features.ComputeShaders &&
+        (CI.BindFlags & BIND_UNORDERED_ACCESS) != 0)
+    {
+        CreateScatterPipeline();
+    }
+}
+
+InstanceDataPool::~InstanceDataPool()
+{
+    // Pages must be released before the suballocator
+    m_Pages.clear();
+}
+
+void InstanceDataPool::CreateScatterPipeline()
+{
+    ShaderMacroHelper Macros;
+    Macros.Add("THREAD_GROUP_SIZE", static_cast<int>(m_ThreadGroupSize));
+
+    const std::string Name = m_Name + " - scatter";
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc           = {Name.c_str(), SHADER_TYPE_COMPUTE, true};
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Source         = ScatterShaderSource;
+    ShaderCI.SourceLength   = sizeof(ScatterShaderSource) - 1;
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Macros         = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        LOG_ERROR_AND_THROW("Failed to create the scatter shader");
+
+    // clang-format off
+    const ShaderResourceVariableDesc Variables[] =
+    {
+        {SHADER_TYPE_COMPUTE, "g_Delta",        SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        {SHADER_TYPE_COMPUTE, "g_InstanceData", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+    };
+    // clang-format on
+
+    ComputePipelineStateCreateInfo PsoCI{Name.c_str()};
+    PsoCI.pCS = pCS;
+
+    PsoCI.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+    PsoCI.PSODesc.ResourceLayout.Variables           = Variables;
+    PsoCI.PSODesc.ResourceLayout.NumVariables        = _countof(Variables);
+
+    m_pDevice->CreateComputePipelineState(PsoCI, &m_pScatterPSO);
+    if (!m_pScatterPSO)
+        LOG_ERROR_AND_THROW("Failed to create the scatter pipeline");
+
+    CreateUniformBuffer(m_pDevice, sizeof(ScatterConstants), (m_Name + " - scatter constants").c_str(), &m_pConstantsBuffer);
+    if (!m_pConstantsBuffer)
+        LOG_ERROR_AND_THROW("Failed to create the constants buffer");
+    m_pScatterPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbScatterConstants")->Set(m_pConstantsBuffer);
+
+    m_pScatterPSO->CreateShaderResourceBinding(&m_pScatterSRB, true);
+    VERIFY_EXPR(m_pScatterSRB);
+
+    m_pDeltaVar        = m_pScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Delta");
+    m_pInstanceDataVar = m_pScatterSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_InstanceData");
+    VERIFY_EXPR(m_pDeltaVar != nullptr && m_pInstanceDataVar != nullptr);
+}
+
+bool InstanceDataPool::AllocatePage()
+{
+    RefCntAutoPtr<IBufferSuballocation> pPage;
+    m_pSuballocator->Allocate(m_SlotsPerPage * m_InstanceDataSize, ElementSize, &pPage);
+    if (!pPage)
+    {
+        LOG_ERROR_MESSAGE("Failed to allocate instance data slots in '", m_Name, "': the maximum capacity has been reached");
+        return false;
+    }
+    VERIFY(pPage->GetOffset() % m_InstanceDataSize == 0, "Page offset (", pPage->GetOffset(), ") is not a multiple of the instance data size (", m_InstanceDataSize, ")");
+
+    const SlotIndex FirstSlot = pPage->GetOffset() / m_InstanceDataSize;
+    const SlotIndex EndSlot   = FirstSlot + m_SlotsPerPage;
+    if (EndSlot > m_AllocatedFlags.size())
+    {
+        m_Data.resize(size_t{EndSlot} * m_InstanceDataSize);
+        m_AllocatedFlags.resize(EndSlot);
+        m_DirtyFlags.resize(EndSlot);
+    }
+
+    // Push the slots in reverse order so that lower slots are allocated first
+    for (SlotIndex Slot = EndSlot; Slot > FirstSlot; --Slot)
+        m_FreeSlots.push_back(Slot - 1);
+
+    m_Pages.emplace_back(std::move(pPage));
+    return true;
+}
+
+InstanceDataPool::SlotIndex InstanceDataPool::Allocate(const void* pData)
+{
+    if (m_FreeSlots.empty() && !AllocatePage())
+        return InvalidSlot;
+
+    const SlotIndex Slot = m_FreeSlots.back();
+    m_FreeSlots.pop_back();
+
+    VERIFY_EXPR(!m_AllocatedFlags[Slot]);
+    m_AllocatedFlags[Slot] = true;
+    ++m_SlotCount;
+
+    Uint8* pDst = &m_Data[size_t{Slot} * m_InstanceDataSize];
+    if (pData != nullptr)
+        std::memcpy(pDst, pData, m_InstanceDataSize);
+    else
+        std::memset(pDst, 0, m_InstanceDataSize);
+    MarkDirty(Slot);
+
+    return Slot;
+}
+
+void InstanceDataPool::Free(SlotIndex Slot)
+{
+    DEV_CHECK_ERR(Slot < m_AllocatedFlags.size() && m_AllocatedFlags[Slot], "Slot ", Slot, " is not allocated");
+    if (Slot >= m_AllocatedFlags.size() || !m_AllocatedFlags[Slot])
+        return;
+
+    // The slot may still be dirty, which results in a redundant, but harmless upload
+    m_AllocatedFlags[Slot] = false;
+    --m_SlotCount;
+    m_FreeSlots.push_back(Slot);
+}
+
+void InstanceDataPool::MarkDirty(SlotIndex Slot)
+{
+    if (!m_DirtyFlags[Slot])
+    {
+        m_DirtyFlags[Slot] = true;
+        m_DirtySlots.push_back(Slot);
+    }
+}
+
+void InstanceDataPool::SetData(SlotIndex Slot, const void* pData)
+{
+    DEV_CHECK_ERR(pData != nullptr, "pData must not be null");
+    std::memcpy(GetDataForWrite(Slot), pData, m_InstanceDataSize);
+}
+
+void* InstanceDataPool::GetDataForWrite(SlotIndex Slot)
+{
+    DEV_CHECK_ERR(Slot < m_AllocatedFlags.size() && m_AllocatedFlags[Slot], "Slot ", Slot, " is not allocated");
+    MarkDirty(Slot);
+    return &m_Data[size_t{Slot} * m_InstanceDataSize];
+}
+
+const void* InstanceDataPool::GetData(SlotIndex Slot) const
+{
+    DEV_CHECK_ERR(Slot < m_AllocatedFlags.size() && m_AllocatedFlags[Slot], "Slot ", Slot, " is not allocated");
+    return &m_Data[size_t{Slot} * m_InstanceDataSize];
+}
+
+InstanceDataPool::UPDATE_MODE InstanceDataPool::Commit(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    m_LastUploadSize = 0;
+
+    // Expand the buffer if new pages have been allocated. The existing contents are preserved.
+    IBuffer* pBuffer = m_pSuballocator->Update(m_pDevice, pContext);
+    if (m_DirtySlots.empty())
+        return UPDATE_MODE_NONE;
+
+    if (pBuffer == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to update the instance buffer of '", m_Name, "'");
+        return UPDATE_MODE_NONE;
+    }
+
+    std::sort(m_DirtySlots.begin(), m_DirtySlots.end());
+
+    Uint32 NumRanges = 0;
+    for (size_t i = 0; i < m_DirtySlots.size(); ++i)
+    {
+        if (i == 0 || m_DirtySlots[i] != m_DirtySlots[i - 1] + 1)
+            ++NumRanges;
+    }
+
+    UPDATE_MODE Mode = UPDATE_MODE_COMPUTE;
+    if (!m_pScatterPSO || NumRanges < m_ComputeUpdateThreshold || !CommitCompute(pContext, pBuffer))
+    {
+        CommitCPU(pContext, pBuffer);
+        Mode = UPDATE_MODE_CPU;
+    }
+
+    for (SlotIndex Slot : m_DirtySlots)
+        m_DirtyFlags[Slot] = false;
+    m_DirtySlots.clear();
+
+    return Mode;
+}
+
+void InstanceDataPool::CommitCPU(IDeviceContext* pContext, IBuffer* pBuffer)
+{
+    // Write every range of adjacent dirty slots with one call
+    size_t RangeStart = 0;
+    for (size_t i = 1; i <= m_DirtySlots.size(); ++i)
+    {
+        if (i < m_DirtySlots.size() && m_DirtySlots[i] == m_DirtySlots[i - 1] + 1)
+            continue;
+
+        const SlotIndex FirstSlot = m_DirtySlots[RangeStart];
+        const Uint64    Offset    = Uint64{FirstSlot} * m_InstanceDataSize;
+        const Uint64    Size      = Uint64{i - RangeStart} * m_InstanceDataSize;
+        pContext->UpdateBuffer(pBuffer, Offset, Size, &m_Data[static_cast<size_t>(Offset)], RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_LastUploadSize += Size;
+
+        RangeStart = i;
+    }
+}
+
+bool InstanceDataPool::CommitCompute(IDeviceContext* pContext, IBuffer* pBuffer)
+{
+    const Uint32 NumSlots        = static_cast<Uint32>(m_DirtySlots.size());
+    const Uint32 ElementsPerSlot = m_InstanceDataSize / ElementSize;
+    // Slot indices are packed four per element
+    const Uint32 DataOffset = (NumSlots + 3) / 4;
+    const size_t DeltaSize  = (size_t{DataOffset} + size_t{NumSlots} * ElementsPerSlot) * ElementSize;
+
+    m_DeltaData.resize(DeltaSize);
+    std::memset(m_DeltaData.data(), 0, size_t{DataOffset} * ElementSize);
+    std::memcpy(m_DeltaData.data(), m_DirtySlots.data(), size_t{NumSlots} * sizeof(SlotIndex));
+    for (Uint32 i = 0; i < NumSlots; ++i)
+    {
+        std::memcpy(&m_DeltaData[(size_t{DataOffset} + size_t{i} * ElementsPerSlot) * ElementSize],
+                    &m_Data[size_t{m_DirtySlots[i]} * m_InstanceDataSize],
+                    m_InstanceDataSize);
+    }
+
+    if (!m_pDeltaBuffer || m_pDeltaBuffer->GetDesc().Size < DeltaSize)
+    {
+        const std::string Name = m_Name + " - delta";
+
+        BufferDesc Desc;
+        Desc.Name              = Name.c_str();
+        Desc.Size              = m_pDeltaBuffer ? std::max(Uint64{DeltaSize}, m_pDeltaBuffer->GetDesc().Size * 2) : Uint64{DeltaSize};
+        Desc.BindFlags         = BIND_SHADER_RESOURCE;
+        Desc.Usage             = USAGE_DEFAULT;
+        Desc.Mode              = BUFFER_MODE_FORMATTED;
+        Desc.ElementByteStride = ElementSize;
+
+        m_pDeltaBuffer.Release();
+        m_pDeltaSRV.Release();
+        m_pDevice->CreateBuffer(Desc, nullptr, &m_pDeltaBuffer);
+        if (!m_pDeltaBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create the delta buffer of '", m_Name, "'. Falling back to CPU update.");
+            return false;
+        }
+
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = BUFFER_VIEW_SHADER_RESOURCE;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 4;
+        m_pDeltaBuffer->CreateView(ViewDesc, &m_pDeltaSRV);
+        VERIFY_EXPR(m_pDeltaSRV);
+    }
+
+    // The buffer object changes when the suballocator expands it
+    if (!m_pInstanceDataUAV || m_pInstanceDataUAV->GetBuffer() != pBuffer)
+    {
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 4;
+
+        m_pInstanceDataUAV.Release();
+        pBuffer->CreateView(ViewDesc, &m_pInstanceDataUAV);
+        VERIFY_EXPR(m_pInstanceDataUAV);
+    }
+
+    pContext->UpdateBuffer(m_pDeltaBuffer, 0, DeltaSize, m_DeltaData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    m_LastUploadSize = DeltaSize;
+
+    const Uint32 NumElements     = NumSlots * ElementsPerSlot;
+    const Uint32 NumThreadGroups = std::min((NumElements + m_ThreadGroupSize - 1) / m_ThreadGroupSize, MaxScatterThreadGroups);
+    {
+        MapHelper<ScatterConstants> Constants{pContext, m_pConstantsBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+        Constants->NumSlots        = NumSlots;
+        Constants->ElementsPerSlot = ElementsPerSlot;
+        Constants->DataOffset      = DataOffset;
+        Constants->ThreadCount     = NumThreadGroups * m_ThreadGroupSize;
+    }
+
+    m_pDeltaVar->Set(m_pDeltaSRV);
+    m_pInstanceDataVar->Set(m_pInstanceDataUAV);
+
+    pContext->SetPipelineState(m_pScatterPSO);
+    pContext->CommitShaderResources(m_pScatterSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttribs{NumThreadGroups, 1, 1};
+    pContext->DispatchCompute(DispatchAttribs);
+
+    return true;
+}
+
+} // namespace Diligent
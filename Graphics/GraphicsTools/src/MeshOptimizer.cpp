@@ -0,0 +1,542 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "DebugUtilities.hpp"
+#include "BasicMath.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The number of triangles optimized independently. The value does not depend on the
+// number of threads so that the output is the same with and without the thread pool.
+constexpr Uint32 TrianglesPerRange = 1u << 16u;
+
+// The number of vertices or indices processed by one task when remapping
+constexpr Uint32 ElementsPerTask = 1u << 16u;
+
+constexpr Uint32 InvalidVertex = ~0u;
+
+bool ValidateAttribs(const OptimizeMeshAttribs& Attribs, bool RequirePositions)
+{
+    if (Attribs.IndexType != VT_UINT16 && Attribs.IndexType != VT_UINT32)
+    {
+        DEV_ERROR("Index type must be VT_UINT16 or VT_UINT32");
+        return false;
+    }
+    if (Attribs.NumIndices % 3 != 0)
+    {
+        DEV_ERROR("The number of indices (", Attribs.NumIndices, ") must be a multiple of 3");
+        return false;
+    }
+    if (Attribs.NumIndices > 0 && Attribs.pIndices == nullptr)
+    {
+        DEV_ERROR("Indices must not be null");
+        return false;
+    }
+    if (Attribs.CacheSize < 3)
+    {
+        DEV_ERROR("Cache size (", Attribs.CacheSize, ") must be at least 3");
+        return false;
+    }
+    if (RequirePositions && Attribs.NumIndices > 0)
+    {
+        if (Attribs.pPositions == nullptr)
+        {
+            DEV_ERROR("Positions must not be null");
+            return false;
+        }
+        if (Attribs.PositionStride < sizeof(float3))
+        {
+            DEV_ERROR("Position stride (", Attribs.PositionStride, ") is too small");
+            return false;
+        }
+    }
+
+    for (Uint32 i = 0; i < Attribs.NumIndices; ++i)
+    {
+        const Uint32 Index = Attribs.IndexType == VT_UINT32 ?
+            static_cast<const Uint32*>(Attribs.pIndices)[i] :
+            Uint32{static_cast<const Uint16*>(Attribs.pIndices)[i]};
+        if (Index >= Attribs.NumVertices)
+        {
+            DEV_ERROR("Index ", Index, " at position ", i, " is out of range [0, ", Attribs.NumVertices, ")");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Uint32 LoadIndex(const OptimizeMeshAttribs& Attribs, Uint32 i)
+{
+    return Attribs.IndexType == VT_UINT32 ?
+        static_cast<const Uint32*>(Attribs.pIndices)[i] :
+        Uint32{static_cast<const Uint16*>(Attribs.pIndices)[i]};
+}
+
+void StoreIndex(const OptimizeMeshAttribs& Attribs, Uint32 i, Uint32 Index)
+{
+    if (Attribs.IndexType == VT_UINT32)
+        static_cast<Uint32*>(Attribs.pIndices)[i] = Index;
+    else
+        static_cast<Uint16*>(Attribs.pIndices)[i] = static_cast<Uint16>(Index);
+}
+
+void ProcessItems(IThreadPool* pThreadPool, Uint32 NumItems, const std::function<void(size_t)>& Handler)
+{
+    if (pThreadPool != nullptr && NumItems > 1)
+    {
+        ProcessItemsInParallel(pThreadPool, NumItems, Handler);
+    }
+    else
+    {
+        for (Uint32 i = 0; i < NumItems; ++i)
+            Handler(i);
+    }
+}
+
+// Range of triangles with the vertex indices compacted to [0, Vertices.size())
+struct LocalMesh
+{
+    // Local vertex indices
+    std::vector<Uint32> Indices;
+
+    // Global index of every local vertex
+    std::vector<Uint32> Vertices;
+
+    LocalMesh(const OptimizeMeshAttribs& Attribs, Uint32 FirstIndex, Uint32 NumIndices) :
+        Indices(NumIndices),
+        Vertices(NumIndices)
+    {
+        for (Uint32 i = 0; i < NumIndices; ++i)
+            Vertices[i] = LoadIndex(Attribs, FirstIndex + i);
+
+        std::sort(Vertices.begin(), Vertices.end());
+        Vertices.erase(std::unique(Vertices.begin(), Vertices.end()), Vertices.end());
+
+        for (Uint32 i = 0; i < NumIndices; ++i)
+        {
+            const Uint32 Index = LoadIndex(Attribs, FirstIndex + i);
+            Indices[i]         = static_cast<Uint32>(std::lower_bound(Vertices.begin(), Vertices.end(), Index) - Vertices.begin());
+        }
+    }
+
+    void Store(const OptimizeMeshAttribs& Attribs, Uint32 FirstIndex) const
+    {
+        for (size_t i = 0; i < Indices.size(); ++i)
+            StoreIndex(Attribs, FirstIndex + static_cast<Uint32>(i), Vertices[Indices[i]]);
+    }
+
+    Uint32 GetNumVertices() const { return static_cast<Uint32>(Vertices.size()); }
+    Uint32 GetNumTriangles() const { return static_cast<Uint32>(Indices.size() / 3); }
+};
+
+// FIFO post-transform cache simulation
+class VertexCache
+{
+public:
+    VertexCache(Uint32 NumVertices, Uint32 CacheSize) :
+        m_Timestamps(NumVertices, 0),
+        m_CacheSize{CacheSize},
+        m_Time{CacheSize + 1}
+    {}
+
+    Uint32 AddTriangle(const Uint32* Tri)
+    {
+        Uint32 NumMisses = 0;
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            if (m_Time - m_Timestamps[Tri[i]] > m_CacheSize)
+            {
+                m_Timestamps[Tri[i]] = m_Time++;
+                ++NumMisses;
+            }
+        }
+        return NumMisses;
+    }
+
+    void Flush()
+    {
+        m_Time += m_CacheSize + 1;
+    }
+
+private:
+    std::vector<Uint32> m_Timestamps;
+
+    const Uint32 m_CacheSize;
+    Uint32       m_Time;
+};
+
+void Tipsify(LocalMesh& Mesh, Uint32 CacheSize)
+{
+    const Uint32 NumVertices  = Mesh.GetNumVertices();
+    const Uint32 NumTriangles = Mesh.GetNumTriangles();
+
+    // Vertex-triangle adjacency
+    std::vector<Uint32> NumLiveTriangles(NumVertices, 0);
+    for (Uint32 Index : Mesh.Indices)
+        ++NumLiveTriangles[Index];
+
+    std::vector<Uint32> AdjOffsets(NumVertices + 1, 0);
+    for (Uint32 v = 0; v < NumVertices; ++v)
+        AdjOffsets[v + 1] = AdjOffsets[v] + NumLiveTriangles[v];
+
+    std::vector<Uint32> AdjTriangles(Mesh.Indices.size());
+    {
+        std::vector<Uint32> AdjCounts(NumVertices, 0);
+        for (Uint32 t = 0; t < NumTriangles; ++t)
+        {
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const Uint32 v = Mesh.Indices[t * 3 + i];
+                AdjTriangles[AdjOffsets[v] + AdjCounts[v]++] = t;
+            }
+        }
+    }
+
+    std::vector<Uint32> CacheTime(NumVertices, 0);
+    std::vector<bool>   Emitted(NumTriangles, false);
+    std::vector<Uint32> DeadEndStack;
+    std::vector<Uint32> Candidates;
+    std::vector<Uint32> OutIndices;
+    OutIndices.reserve(Mesh.Indices.size());
+
+    Uint32 Time    = CacheSize + 1;
+    Uint32 Cursor  = 0;
+    Uint32 Fanning = 0;
+    while (Fanning != InvalidVertex)
+    {
+        // Emit all remaining triangles adjacent to the fanning vertex
+        Candidates.clear();
+        for (Uint32 a = AdjOffsets[Fanning]; a < AdjOffsets[Fanning + 1]; ++a)
+        {
+            const Uint32 t = AdjTriangles[a];
+            if (Emitted[t])
+                continue;
+
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const Uint32 v = Mesh.Indices[t * 3 + i];
+                OutIndices.push_back(v);
+                DeadEndStack.push_back(v);
+                Candidates.push_back(v);
+                --NumLiveTriangles[v];
+                if (Time - CacheTime[v] > CacheSize)
+                    CacheTime[v] = Time++;
+            }
+            Emitted[t] = true;
+        }
+
+        // Select the candidate that will still be in the cache after all its triangles are emitted,
+        // preferring the oldest one
+        Uint32 Next         = InvalidVertex;
+        Int64  BestPriority = -1;
+        for (Uint32 v : Candidates)
+        {
+            if (NumLiveTriangles[v] == 0)
+                continue;
+
+            Int64 Priority = 0;
+            if (Time - CacheTime[v] + 2 * NumLiveTriangles[v] <= CacheSize)
+                Priority = Time - CacheTime[v];
+            if (Priority > BestPriority)
+            {
+                BestPriority = Priority;
+                Next         = v;
+            }
+        }
+
+        if (Next == InvalidVertex)
+        {
+            // Dead end: try the recently used vertices first, then scan the remaining ones
+            while (!DeadEndStack.empty() && Next == InvalidVertex)
+            {
+                const Uint32 v = DeadEndStack.back();
+                DeadEndStack.pop_back();
+                if (NumLiveTriangles[v] > 0)
+                    Next = v;
+            }
+            for (; Cursor < NumVertices && Next == InvalidVertex; ++Cursor)
+            {
+                if (NumLiveTriangles[Cursor] > 0)
+                    Next = Cursor;
+            }
+        }
+
+        Fanning = Next;
+    }
+    VERIFY_EXPR(OutIndices.size() == Mesh.Indices.size());
+
+    Mesh.Indices.swap(OutIndices);
+}
+
+void SortClusters(LocalMesh& Mesh, const OptimizeMeshAttribs& Attribs)
+{
+    const Uint32 NumVertices  = Mesh.GetNumVertices();
+    const Uint32 NumTriangles = Mesh.GetNumTriangles();
+
+    std::vector<float3> Positions(NumVertices);
+    float3              MeshCenter;
+    for (Uint32 v = 0; v < NumVertices; ++v)
+    {
+        memcpy(&Positions[v], static_cast<const Uint8*>(Attribs.pPositions) + size_t{Mesh.Vertices[v]} * Attribs.PositionStride, sizeof(float3));
+        MeshCenter += Positions[v];
+    }
+    MeshCenter /= static_cast<float>(NumVertices);
+
+    // Clusters start where all vertices of a triangle miss the cache, which usually
+    // indicates that the vertex cache optimizer started a new patch of the mesh.
+    std::vector<Uint32> Clusters;
+    {
+        std::vector<Uint32> HardBoundaries;
+        VertexCache         Cache{NumVertices, Attribs.CacheSize};
+        for (Uint32 t = 0; t < NumTriangles; ++t)
+        {
+            if (Cache.AddTriangle(&Mesh.Indices[t * 3]) == 3 || t == 0)
+                HardBoundaries.push_back(t);
+        }
+        HardBoundaries.push_back(NumTriangles);
+
+        // Split the clusters further as long as the cache miss ratio of every part
+        // stays within the threshold of the original cluster's ratio
+        for (size_t c = 0; c + 1 < HardBoundaries.size(); ++c)
+        {
+            const Uint32 Start = HardBoundaries[c];
+            const Uint32 End   = HardBoundaries[c + 1];
+
+            Uint32 ClusterMisses = 0;
+            Cache.Flush();
+            for (Uint32 t = Start; t < End; ++t)
+                ClusterMisses += Cache.AddTriangle(&Mesh.Indices[t * 3]);
+
+            const float TargetRatio = Attribs.OverdrawThreshold * static_cast<float>(ClusterMisses) / static_cast<float>(End - Start);
+
+            Clusters.push_back(Start);
+            Cache.Flush();
+            Uint32 PartStart  = Start;
+            Uint32 PartMisses = 0;
+            for (Uint32 t = Start; t + 1 < End; ++t)
+            {
+                PartMisses += Cache.AddTriangle(&Mesh.Indices[t * 3]);
+                if (static_cast<float>(PartMisses) <= TargetRatio * static_cast<float>(t - PartStart + 1))
+                {
+                    PartStart  = t + 1;
+                    PartMisses = 0;
+                    Clusters.push_back(PartStart);
+                    Cache.Flush();
+                }
+            }
+        }
+        Clusters.push_back(NumTriangles);
+    }
+
+    const Uint32 NumClusters = static_cast<Uint32>(Clusters.size() - 1);
+
+    // Clusters that are farther from the mesh center along their normal are more
+    // likely to occlude other clusters, so they are drawn first.
+    std::vector<float> SortKeys(NumClusters);
+    for (Uint32 c = 0; c < NumClusters; ++c)
+    {
+        float3 Center;
+        float3 Normal;
+        float  Area = 0;
+        for (Uint32 t = Clusters[c]; t < Clusters[c + 1]; ++t)
+        {
+            const float3& P0 = Positions[Mesh.Indices[t * 3 + 0]];
+            const float3& P1 = Positions[Mesh.Indices[t * 3 + 1]];
+            const float3& P2 = Positions[Mesh.Indices[t * 3 + 2]];
+
+            const float3 N        = cross(P1 - P0, P2 - P0);
+            const float  TriArea2 = length(N);
+            Center += (P0 + P1 + P2) * (TriArea2 / 3.f);
+            Normal += N;
+            Area += TriArea2;
+        }
+
+        const float NormalLen = length(Normal);
+        if (Area == 0 || NormalLen == 0)
+            continue;
+
+        Center /= Area;
+        SortKeys[c] = dot(Center - MeshCenter, Normal / NormalLen) * (Attribs.FrontCounterClockwise ? -1.f : 1.f);
+    }
+
+    std::vector<Uint32> Order(NumClusters);
+    std::iota(Order.begin(), Order.end(), 0u);
+    std::stable_sort(Order.begin(), Order.end(), [&SortKeys](Uint32 c0, Uint32 c1) { return SortKeys[c0] > SortKeys[c1]; });
+
+    std::vector<Uint32> OutIndices;
+    OutIndices.reserve(Mesh.Indices.size());
+    for (Uint32 c : Order)
+        OutIndices.insert(OutIndices.end(), Mesh.Indices.begin() + Clusters[c] * 3, Mesh.Indices.begin() + Clusters[c + 1] * 3);
+
+    Mesh.Indices.swap(OutIndices);
+}
+
+template <typename HandlerType>
+void ProcessTriangleRanges(const OptimizeMeshAttribs& Attribs, HandlerType Handler)
+{
+    const Uint32 NumTriangles = Attribs.NumIndices / 3;
+    const Uint32 NumRanges    = (NumTriangles + TrianglesPerRange - 1) / TrianglesPerRange;
+
+    ProcessItems(Attribs.pThreadPool, NumRanges, [&](size_t Range) {
+        const Uint32 FirstIndex = static_cast<Uint32>(Range) * TrianglesPerRange * 3;
+        const Uint32 NumIndices = std::min(TrianglesPerRange * 3, Attribs.NumIndices - FirstIndex);
+
+        LocalMesh Mesh{Attribs, FirstIndex, NumIndices};
+        Handler(Mesh);
+        Mesh.Store(Attribs, FirstIndex);
+    });
+}
+
+} // namespace
+
+bool OptimizeVertexCache(const OptimizeMeshAttribs& Attribs)
+{
+    if (!ValidateAttribs(Attribs, false))
+        return false;
+
+    ProcessTriangleRanges(Attribs, [&](LocalMesh& Mesh) {
+        Tipsify(Mesh, Attribs.CacheSize);
+    });
+    return true;
+}
+
+bool OptimizeOverdraw(const OptimizeMeshAttribs& Attribs)
+{
+    if (!ValidateAttribs(Attribs, true))
+        return false;
+
+    ProcessTriangleRanges(Attribs, [&](LocalMesh& Mesh) {
+        SortClusters(Mesh, Attribs);
+    });
+    return true;
+}
+
+bool OptimizeVertexFetch(const OptimizeMeshAttribs& Attribs,
+                         void*                      pVertices,
+                         Uint32                     VertexStride,
+                         Uint32*                    pRemap)
+{
+    if (!ValidateAttribs(Attribs, false))
+        return false;
+
+    std::vector<Uint32> Remap(Attribs.NumVertices, InvalidVertex);
+
+    Uint32 NextVertex = 0;
+    for (Uint32 i = 0; i < Attribs.NumIndices; ++i)
+    {
+        Uint32& NewIndex = Remap[LoadIndex(Attribs, i)];
+        if (NewIndex == InvalidVertex)
+            NewIndex = NextVertex++;
+    }
+    for (Uint32& NewIndex : Remap)
+    {
+        if (NewIndex == InvalidVertex)
+            NewIndex = NextVertex++;
+    }
+    VERIFY_EXPR(NextVertex == Attribs.NumVertices);
+
+    ProcessItems(Attribs.pThreadPool, (Attribs.NumIndices + ElementsPerTask - 1) / ElementsPerTask, [&](size_t Task) {
+        const Uint32 Start = static_cast<Uint32>(Task) * ElementsPerTask;
+        const Uint32 End   = std::min(Start + ElementsPerTask, Attribs.NumIndices);
+        for (Uint32 i = Start; i < End; ++i)
+            StoreIndex(Attribs, i, Remap[LoadIndex(Attribs, i)]);
+    });
+
+    if (pVertices != nullptr)
+    {
+        if (!RemapVertices(pVertices, VertexStride, Attribs.NumVertices, Remap.data(), Attribs.pThreadPool))
+            return false;
+    }
+
+    if (pRemap != nullptr)
+        std::copy(Remap.begin(), Remap.end(), pRemap);
+
+    return true;
+}
+
+bool RemapVertices(void*         pVertices,
+                   Uint32        VertexStride,
+                   Uint32        NumVertices,
+                   const Uint32* pRemap,
+                   IThreadPool*  pThreadPool)
+{
+    if (NumVertices == 0)
+        return true;
+
+    if (pVertices == nullptr || pRemap == nullptr || VertexStride == 0)
+    {
+        DEV_ERROR("Vertices and remap table must not be null, and vertex stride must not be zero");
+        return false;
+    }
+
+    const size_t       DataSize = size_t{NumVertices} * VertexStride;
+    std::vector<Uint8> SrcData(static_cast<const Uint8*>(pVertices), static_cast<const Uint8*>(pVertices) + DataSize);
+
+    ProcessItems(pThreadPool, (NumVertices + ElementsPerTask - 1) / ElementsPerTask, [&](size_t Task) {
+        const Uint32 Start = static_cast<Uint32>(Task) * ElementsPerTask;
+        const Uint32 End   = std::min(Start + ElementsPerTask, NumVertices);
+        for (Uint32 v = Start; v < End; ++v)
+        {
+            VERIFY(pRemap[v] < NumVertices, "Remapped index ", pRemap[v], " is out of range");
+            memcpy(static_cast<Uint8*>(pVertices) + size_t{pRemap[v]} * VertexStride, &SrcData[size_t{v} * VertexStride], VertexStride);
+        }
+    });
+
+    return true;
+}
+
+float ComputeVertexCacheMissRatio(const OptimizeMeshAttribs& Attribs)
+{
+    if (!ValidateAttribs(Attribs, false) || Attribs.NumIndices == 0)
+        return 0;
+
+    VertexCache Cache{Attribs.NumVertices, Attribs.CacheSize};
+
+    Uint32 NumMisses = 0;
+    for (Uint32 i = 0; i < Attribs.NumIndices; i += 3)
+    {
+        const Uint32 Tri[3] = {LoadIndex(Attribs, i), LoadIndex(Attribs, i + 1), LoadIndex(Attribs, i + 2)};
+        NumMisses += Cache.AddTriangle(Tri);
+    }
+    return static_cast<float>(NumMisses) / static_cast<float>(Attribs.NumIndices / 3);
+}
+
+} // namespace Diligent
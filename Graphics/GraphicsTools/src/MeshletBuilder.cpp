@@ -0,0 +1,579 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+#include "AdvancedMath.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The number of triangles processed by one task. The value does not depend on the
+// number of threads so that the output is the same with and without the thread pool.
+constexpr Uint32 TrianglesPerRange = 16384;
+
+// Minimal cosine of the angle between the cone axis and the triangle normals
+// for which the normal cone is useful for culling.
+constexpr float MinConeCosine = 0.1f;
+
+constexpr char MeshletShaderSource[] = R"(
+#ifndef MESHLET_AS_GROUP_SIZE
+#    define MESHLET_AS_GROUP_SIZE 32
+#endif
+
+#ifndef MESHLET_MS_GROUP_SIZE
+#    define MESHLET_MS_GROUP_SIZE 64
+#endif
+
+#ifndef MESHLET_MAX_VERTICES
+#    define MESHLET_MAX_VERTICES 64
+#endif
+
+#ifndef MESHLET_MAX_PRIMITIVES
+#    define MESHLET_MAX_PRIMITIVES 124
+#endif
+
+#ifndef MESHLET_VERTEX_STRIDE
+#    define MESHLET_VERTEX_STRIDE 12
+#endif
+
+#define MESHLET_CULL_FLAG_FRUSTUM  1u
+#define MESHLET_CULL_FLAG_BACKFACE 2u
+
+struct Meshlet
+{
+    uint   VertexOffset;
+    uint   PrimitiveOffset;
+    uint   VertexCount;
+    uint   PrimitiveCount;
+
+    float3 Center;
+    float  Radius;
+
+    float3 ConeApex;
+    float  ConeCutoff;
+
+    float3 ConeAxis;
+    float  Padding;
+};
+
+cbuffer cbMeshletConstants
+{
+    float4x4 g_WorldViewProj;
+    float4   g_FrustumPlanes[6];
+    float4   g_CameraPos;
+    uint     g_NumMeshlets;
+    uint     g_CullFlags;
+    uint2    g_Padding;
+};
+
+StructuredBuffer<Meshlet> g_Meshlets;
+StructuredBuffer<uint>    g_VertexIndices;
+StructuredBuffer<uint>    g_PrimitiveIndices;
+ByteAddressBuffer         g_VertexData;
+
+struct MeshletPayload
+{
+    uint MeshletIndices[MESHLET_AS_GROUP_SIZE];
+};
+
+bool IsMeshletVisible(Meshlet M)
+{
+    if ((g_CullFlags & MESHLET_CULL_FLAG_FRUSTUM) != 0u)
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            if (dot(g_FrustumPlanes[i].xyz, M.Center) + g_FrustumPlanes[i].w < -M.Radius)
+                return false;
+        }
+    }
+
+    if ((g_CullFlags & MESHLET_CULL_FLAG_BACKFACE) != 0u)
+    {
+        // All triangles are back-facing if the camera is inside the negative normal cone
+        if (dot(normalize(M.ConeApex - g_CameraPos.xyz), M.ConeAxis) >= M.ConeCutoff)
+            return false;
+    }
+
+    return true;
+}
+
+groupshared MeshletPayload s_Payload;
+groupshared uint           s_NumVisible;
+
+[numthreads(MESHLET_AS_GROUP_SIZE, 1, 1)]
+void MeshletAS(uint I : SV_GroupIndex, uint3 GroupId : SV_GroupID)
+{
+    if (I == 0u)
+        s_NumVisible = 0u;
+    GroupMemoryBarrierWithGroupSync();
+
+    uint MeshletIndex = GroupId.x * MESHLET_AS_GROUP_SIZE + I;
+    if (MeshletIndex < g_NumMeshlets && IsMeshletVisible(g_Meshlets[MeshletIndex]))
+    {
+        uint Slot;
+        InterlockedAdd(s_NumVisible, 1u, Slot);
+        s_Payload.MeshletIndices[Slot] = MeshletIndex;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    DispatchMesh(s_NumVisible, 1, 1, s_Payload);
+}
+
+#ifdef MESHLET_CUSTOM_VERTEX
+#    include "MeshletCustomVertex.fxh"
+#else
+struct MeshletVertexOut
+{
+    float4 Pos : SV_Position;
+    nointerpolation uint MeshletIndex : MESHLET_INDEX;
+};
+
+MeshletVertexOut GetMeshletVertex(uint VertexIndex, uint MeshletIndex)
+{
+    float3 Pos = asfloat(g_VertexData.Load3(VertexIndex * MESHLET_VERTEX_STRIDE));
+
+    MeshletVertexOut Out;
+    Out.Pos          = mul(float4(Pos, 1.0), g_WorldViewProj);
+    Out.MeshletIndex = MeshletIndex;
+    return Out;
+}
+#endif
+
+[numthreads(MESHLET_MS_GROUP_SIZE, 1, 1)]
+[outputtopology("triangle")]
+void MeshletMS(uint I       : SV_GroupIndex,
+               uint3 GroupId : SV_GroupID,
+               in  payload  MeshletPayload   Payload,
+               out indices  uint3            Triangles[MESHLET_MAX_PRIMITIVES],
+               out vertices MeshletVertexOut Vertices[MESHLET_MAX_VERTICES])
+{
+    uint    MeshletIndex = Payload.MeshletIndices[GroupId.x];
+    Meshlet M            = g_Meshlets[MeshletIndex];
+
+    SetMeshOutputCounts(M.VertexCount, M.PrimitiveCount);
+
+    for (uint v = I; v < M.VertexCount; v += MESHLET_MS_GROUP_SIZE)
+    {
+        Vertices[v] = GetMeshletVertex(g_VertexIndices[M.VertexOffset + v], MeshletIndex);
+    }
+
+    for (uint p = I; p < M.PrimitiveCount; p += MESHLET_MS_GROUP_SIZE)
+    {
+        uint Packed  = g_PrimitiveIndices[M.PrimitiveOffset + p];
+        Triangles[p] = uint3(Packed & 0xFFu, (Packed >> 8u) & 0xFFu, (Packed >> 16u) & 0xFFu);
+    }
+}
+)";
+
+float3 LoadPosition(const BuildMeshletsAttribs& Attribs, Uint32 Vertex)
+{
+    float3 Pos;
+    memcpy(&Pos, static_cast<const Uint8*>(Attribs.pPositions) + size_t{Vertex} * Attribs.PositionStride, sizeof(Pos));
+    return Pos;
+}
+
+Uint32 LoadIndex(const BuildMeshletsAttribs& Attribs, Uint32 i)
+{
+    return Attribs.IndexType == VT_UINT32 ?
+        static_cast<const Uint32*>(Attribs.pIndices)[i] :
+        Uint32{static_cast<const Uint16*>(Attribs.pIndices)[i]};
+}
+
+void ComputeBoundingSphere(const std::vector<float3>& Points, MeshletDesc& Meshlet)
+{
+    VERIFY_EXPR(!Points.empty());
+
+    // Ritter's bounding sphere: start with the sphere through two distant points and grow it to include all points
+    auto FindFarthest = [&Points](const float3& From) {
+        size_t Farthest = 0;
+        float  MaxDist2 = -1;
+        for (size_t i = 0; i < Points.size(); ++i)
+        {
+            const float Dist2 = dot(Points[i] - From, Points[i] - From);
+            if (Dist2 > MaxDist2)
+            {
+                MaxDist2 = Dist2;
+                Farthest = i;
+            }
+        }
+        return Points[Farthest];
+    };
+
+    const float3 P0 = FindFarthest(Points[0]);
+    const float3 P1 = FindFarthest(P0);
+
+    float3 Center = (P0 + P1) * 0.5f;
+    float  Radius = length(P1 - P0) * 0.5f;
+    for (const float3& P : Points)
+    {
+        const float Dist = length(P - Center);
+        if (Dist > Radius)
+        {
+            const float NewRadius = (Radius + Dist) * 0.5f;
+            Center += (P - Center) * ((NewRadius - Radius) / Dist);
+            Radius = NewRadius;
+        }
+    }
+
+    Meshlet.Center = Center;
+    Meshlet.Radius = Radius;
+}
+
+void ComputeMeshletBounds(const BuildMeshletsAttribs& Attribs,
+                          const Uint32*               pVertexIndices,
+                          const Uint32*               pPrimitives,
+                          std::vector<float3>&        Positions,
+                          std::vector<float3>&        Normals,
+                          MeshletDesc&                Meshlet)
+{
+    Positions.resize(Meshlet.VertexCount);
+    for (Uint32 v = 0; v < Meshlet.VertexCount; ++v)
+        Positions[v] = LoadPosition(Attribs, pVertexIndices[v]);
+
+    ComputeBoundingSphere(Positions, Meshlet);
+
+    // Normals that point away from the front face, zero for degenerate triangles
+    Normals.resize(Meshlet.PrimitiveCount);
+    float3 AxisSum;
+    for (Uint32 p = 0; p < Meshlet.PrimitiveCount; ++p)
+    {
+        const Uint32  Packed = pPrimitives[p];
+        const float3& P0     = Positions[Packed & 0xFFu];
+        const float3& P1     = Positions[(Packed >> 8u) & 0xFFu];
+        const float3& P2     = Positions[(Packed >> 16u) & 0xFFu];
+
+        float3      N   = cross(P1 - P0, P2 - P0);
+        const float Len = length(N);
+        N               = Len > 0 ? N / (Attribs.FrontCounterClockwise ? -Len : Len) : float3{};
+
+        Normals[p] = N;
+        AxisSum += N;
+    }
+
+    Meshlet.ConeApex   = Meshlet.Center;
+    Meshlet.ConeAxis   = float3{0, 0, 0};
+    Meshlet.ConeCutoff = 1;
+
+    const float AxisLen = length(AxisSum);
+    if (AxisLen == 0)
+        return;
+
+    const float3 Axis   = AxisSum / AxisLen;
+    float        MinDot = 1;
+    for (const float3& N : Normals)
+    {
+        if (N != float3{})
+            MinDot = std::min(MinDot, dot(Axis, N));
+    }
+
+    if (MinDot <= MinConeCosine)
+        return; // The normals diverge too much
+
+    // Move the apex along the negative axis until all triangle planes are in front of it, so that
+    // the camera is behind every triangle whenever it is inside the negative cone.
+    float MaxT = 0;
+    for (Uint32 p = 0; p < Meshlet.PrimitiveCount; ++p)
+    {
+        const float3& N = Normals[p];
+        if (N == float3{})
+            continue;
+
+        const float3& P0 = Positions[pPrimitives[p] & 0xFFu];
+        // dot(Axis, N) > MinConeCosine > 0
+        const float T = dot(Meshlet.Center - P0, N) / dot(Axis, N);
+        MaxT          = std::max(MaxT, T);
+    }
+
+    Meshlet.ConeApex   = Meshlet.Center - Axis * MaxT;
+    Meshlet.ConeAxis   = Axis;
+    Meshlet.ConeCutoff = std::sqrt(1 - MinDot * MinDot);
+}
+
+void BuildMeshletRange(const BuildMeshletsAttribs& Attribs, Uint32 FirstTriangle, Uint32 NumTriangles, MeshletData& Data)
+{
+    Data.Meshlets.clear();
+    Data.VertexIndices.clear();
+    Data.PrimitiveIndices.clear();
+
+    MeshletDesc Meshlet;
+
+    std::vector<float3> Positions;
+    std::vector<float3> Normals;
+
+    auto FinishMeshlet = [&]() {
+        if (Meshlet.PrimitiveCount == 0)
+            return;
+
+        ComputeMeshletBounds(Attribs,
+                             &Data.VertexIndices[Meshlet.VertexOffset],
+                             &Data.PrimitiveIndices[Meshlet.PrimitiveOffset],
+                             Positions, Normals, Meshlet);
+        Data.Meshlets.push_back(Meshlet);
+
+        Meshlet                 = {};
+        Meshlet.VertexOffset    = static_cast<Uint32>(Data.VertexIndices.size());
+        Meshlet.PrimitiveOffset = static_cast<Uint32>(Data.PrimitiveIndices.size());
+    };
+
+    for (Uint32 t = FirstTriangle; t < FirstTriangle + NumTriangles; ++t)
+    {
+        const Uint32 Tri[3] = {
+            LoadIndex(Attribs, t * 3 + 0),
+            LoadIndex(Attribs, t * 3 + 1),
+            LoadIndex(Attribs, t * 3 + 2),
+        };
+
+        // Find the local indices of the triangle vertices; ~0u for the new vertices
+        auto FindLocalIndices = [&](Uint32 (&LocalIdx)[3]) {
+            Uint32 NumNew = 0;
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const Uint32* pVerts = Data.VertexIndices.data() + Meshlet.VertexOffset;
+                const Uint32* pFound = std::find(pVerts, pVerts + Meshlet.VertexCount, Tri[i]);
+                LocalIdx[i]          = pFound != pVerts + Meshlet.VertexCount ? static_cast<Uint32>(pFound - pVerts) : ~0u;
+                // The same new vertex may be referenced more than once by degenerate triangles
+                if (LocalIdx[i] == ~0u && (i == 0 || (Tri[i] != Tri[0] && (i == 1 || Tri[i] != Tri[1]))))
+                    ++NumNew;
+            }
+            return NumNew;
+        };
+
+        Uint32 LocalIdx[3];
+        if (Meshlet.VertexCount + FindLocalIndices(LocalIdx) > Attribs.MaxVertices || Meshlet.PrimitiveCount == Attribs.MaxPrimitives)
+        {
+            FinishMeshlet();
+            FindLocalIndices(LocalIdx);
+        }
+
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            if (LocalIdx[i] != ~0u)
+                continue;
+
+            // Check the vertices added by this triangle
+            const Uint32* pVerts = Data.VertexIndices.data() + Meshlet.VertexOffset;
+            const Uint32* pFound = std::find(pVerts, pVerts + Meshlet.VertexCount, Tri[i]);
+            if (pFound != pVerts + Meshlet.VertexCount)
+            {
+                LocalIdx[i] = static_cast<Uint32>(pFound - pVerts);
+            }
+            else
+            {
+                LocalIdx[i] = Meshlet.VertexCount++;
+                Data.VertexIndices.push_back(Tri[i]);
+            }
+        }
+        VERIFY_EXPR(Meshlet.VertexCount <= Attribs.MaxVertices);
+
+        Data.PrimitiveIndices.push_back(LocalIdx[0] | (LocalIdx[1] << 8u) | (LocalIdx[2] << 16u));
+        ++Meshlet.PrimitiveCount;
+    }
+
+    FinishMeshlet();
+}
+
+} // namespace
+
+bool BuildMeshlets(const BuildMeshletsAttribs& Attribs, MeshletData& Data)
+{
+    Data.Meshlets.clear();
+    Data.VertexIndices.clear();
+    Data.PrimitiveIndices.clear();
+
+    if (Attribs.IndexType != VT_UINT16 && Attribs.IndexType != VT_UINT32)
+    {
+        DEV_ERROR("Index type must be VT_UINT16 or VT_UINT32");
+        return false;
+    }
+    if (Attribs.NumIndices % 3 != 0)
+    {
+        DEV_ERROR("The number of indices (", Attribs.NumIndices, ") must be a multiple of 3");
+        return false;
+    }
+    if (Attribs.MaxVertices < 3 || Attribs.MaxVertices > 256 || Attribs.MaxPrimitives < 1 || Attribs.MaxPrimitives > 256)
+    {
+        DEV_ERROR("The maximum number of meshlet vertices (", Attribs.MaxVertices, ") must be in [3, 256] range, and the maximum number of primitives (",
+                  Attribs.MaxPrimitives, ") must be in [1, 256] range");
+        return false;
+    }
+    if (Attribs.PositionStride < sizeof(float3))
+    {
+        DEV_ERROR("Position stride (", Attribs.PositionStride, ") is too small");
+        return false;
+    }
+    if (Attribs.NumIndices == 0)
+        return true;
+
+    if (Attribs.pPositions == nullptr || Attribs.pIndices == nullptr)
+    {
+        DEV_ERROR("Positions and indices must not be null");
+        return false;
+    }
+
+    for (Uint32 i = 0; i < Attribs.NumIndices; ++i)
+    {
+        const Uint32 Index = LoadIndex(Attribs, i);
+        if (Index >= Attribs.NumVertices)
+        {
+            DEV_ERROR("Index ", Index, " at position ", i, " is out of range [0, ", Attribs.NumVertices, ")");
+            return false;
+        }
+    }
+
+    const Uint32 NumTriangles = Attribs.NumIndices / 3;
+    const Uint32 NumRanges    = (NumTriangles + TrianglesPerRange - 1) / TrianglesPerRange;
+
+    std::vector<MeshletData> Ranges(NumRanges);
+
+    auto BuildRange = [&](size_t Range) {
+        const Uint32 FirstTriangle = static_cast<Uint32>(Range) * TrianglesPerRange;
+        BuildMeshletRange(Attribs, FirstTriangle, std::min(TrianglesPerRange, NumTriangles - FirstTriangle), Ranges[Range]);
+    };
+
+    if (Attribs.pThreadPool != nullptr && NumRanges > 1)
+    {
+        ProcessItemsInParallel(Attribs.pThreadPool, NumRanges, BuildRange);
+    }
+    else
+    {
+        for (Uint32 Range = 0; Range < NumRanges; ++Range)
+            BuildRange(Range);
+    }
+
+    size_t NumMeshlets = 0, NumVertexIndices = 0, NumPrimitives = 0;
+    for (const MeshletData& Range : Ranges)
+    {
+        NumMeshlets += Range.Meshlets.size();
+        NumVertexIndices += Range.VertexIndices.size();
+        NumPrimitives += Range.PrimitiveIndices.size();
+    }
+    Data.Meshlets.reserve(NumMeshlets);
+    Data.VertexIndices.reserve(NumVertexIndices);
+    Data.PrimitiveIndices.reserve(NumPrimitives);
+
+    for (const MeshletData& Range : Ranges)
+    {
+        const Uint32 VertexOffset    = static_cast<Uint32>(Data.VertexIndices.size());
+        const Uint32 PrimitiveOffset = static_cast<Uint32>(Data.PrimitiveIndices.size());
+        for (MeshletDesc Meshlet : Range.Meshlets)
+        {
+            Meshlet.VertexOffset += VertexOffset;
+            Meshlet.PrimitiveOffset += PrimitiveOffset;
+            Data.Meshlets.push_back(Meshlet);
+        }
+        Data.VertexIndices.insert(Data.VertexIndices.end(), Range.VertexIndices.begin(), Range.VertexIndices.end());
+        Data.PrimitiveIndices.insert(Data.PrimitiveIndices.end(), Range.PrimitiveIndices.begin(), Range.PrimitiveIndices.end());
+    }
+
+    return true;
+}
+
+bool CreateMeshletBuffers(IRenderDevice*     pDevice,
+                          const MeshletData& Data,
+                          const char*        Name,
+                          MeshletBuffers&    Buffers)
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "Render device must not be null");
+
+    Buffers = {};
+    if (Data.Meshlets.empty())
+    {
+        DEV_ERROR("Meshlet data is empty");
+        return false;
+    }
+
+    const std::string Prefix = Name != nullptr ? Name : "Meshlets";
+
+    auto CreateStructuredBuffer = [&](const char* Suffix, const void* pData, size_t Size, Uint32 ElementSize, RefCntAutoPtr<IBuffer>& pBuffer) {
+        const std::string BuffName = Prefix + " - " + Suffix;
+
+        BufferDesc Desc;
+        Desc.Name              = BuffName.c_str();
+        Desc.Size              = Size;
+        Desc.Usage             = USAGE_IMMUTABLE;
+        Desc.BindFlags         = BIND_SHADER_RESOURCE;
+        Desc.Mode              = BUFFER_MODE_STRUCTURED;
+        Desc.ElementByteStride = ElementSize;
+
+        BufferData InitData{pData, Size};
+        pDevice->CreateBuffer(Desc, &InitData, &pBuffer);
+        if (!pBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create buffer '", BuffName, "'");
+            return false;
+        }
+        return true;
+    };
+
+    return (CreateStructuredBuffer("meshlets", Data.Meshlets.data(), Data.Meshlets.size() * sizeof(MeshletDesc), sizeof(MeshletDesc), Buffers.pMeshlets) &&
+            CreateStructuredBuffer("vertex indices", Data.VertexIndices.data(), Data.VertexIndices.size() * sizeof(Uint32), sizeof(Uint32), Buffers.pVertexIndices) &&
+            CreateStructuredBuffer("primitive indices", Data.PrimitiveIndices.data(), Data.PrimitiveIndices.size() * sizeof(Uint32), sizeof(Uint32), Buffers.pPrimitiveIndices));
+}
+
+void InitMeshletCullingConstants(const float4x4&          World,
+                                 const float4x4&          ViewProj,
+                                 const float3&            CameraPos,
+                                 Uint32                   NumMeshlets,
+                                 MESHLET_CULL_FLAGS       CullFlags,
+                                 bool                     IsGL,
+                                 MeshletCullingConstants& Constants)
+{
+    const float4x4 WorldViewProj = World * ViewProj;
+    Constants.WorldViewProj      = WorldViewProj.Transpose();
+
+    // Planes extracted from the world-view-projection matrix are in object space
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(WorldViewProj, Frustum, IsGL);
+    for (Uint32 i = 0; i < ViewFrustum::NUM_PLANES; ++i)
+    {
+        const Plane3D& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+
+        const float Len             = length(Plane.Normal);
+        Constants.FrustumPlanes[i] = Len > 0 ? float4{Plane.Normal / Len, Plane.Distance / Len} : float4{0, 0, 0, 1};
+    }
+
+    Constants.CameraPos   = float4{CameraPos * World.Inverse(), 1};
+    Constants.NumMeshlets = NumMeshlets;
+    Constants.CullFlags   = CullFlags;
+}
+
+const char* GetMeshletShaderSource()
+{
+    return MeshletShaderSource;
+}
+
+} // namespace Diligent
@@ -0,0 +1,549 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MipGenerator.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "DebugUtilities.hpp"
+#include "BasicMath.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The most detailed level is reduced by 64x64 tiles, the last thread group reduces up to 64x64 tiles,
+// which limits the texture size to 4096x4096.
+constexpr Uint32 MaxGeneratedMips = 12;
+constexpr Uint32 TileSize         = 64;
+
+struct SPDConstants
+{
+    Uint32 NumMips       = 0;
+    Uint32 NumWorkGroups = 0;
+    Uint32 Mip6Offset    = 0;
+    Uint32 CounterOffset = 0;
+
+    Uint32 SrcWidth      = 0;
+    Uint32 SrcHeight     = 0;
+    Uint32 NumGroupsX    = 0;
+    Uint32 Padding       = 0;
+};
+
+constexpr char SPDShaderSource[] = R"(
+cbuffer cbSPDConstants
+{
+    uint  g_NumMips;
+    uint  g_NumWorkGroups;
+    uint  g_Mip6Offset;
+    uint  g_CounterOffset;
+
+    uint2 g_SrcSize;
+    uint  g_NumGroupsX;
+    uint  g_Padding;
+};
+
+Texture2DArray<float4> g_Source;
+
+RWTexture2DArray<float4> g_OutMip1;
+RWTexture2DArray<float4> g_OutMip2;
+RWTexture2DArray<float4> g_OutMip3;
+RWTexture2DArray<float4> g_OutMip4;
+RWTexture2DArray<float4> g_OutMip5;
+RWTexture2DArray<float4> g_OutMip6;
+RWTexture2DArray<float4> g_OutMip7;
+RWTexture2DArray<float4> g_OutMip8;
+RWTexture2DArray<float4> g_OutMip9;
+RWTexture2DArray<float4> g_OutMip10;
+RWTexture2DArray<float4> g_OutMip11;
+RWTexture2DArray<float4> g_OutMip12;
+
+globallycoherent RWStructuredBuffer<float4> g_Mip6;
+RWBuffer<uint /*format=r32ui*/> g_Counters;
+
+groupshared float4 g_Tile[32 * 32];
+groupshared uint   g_PrevCount;
+
+uint2 GetMipSize(uint Mip)
+{
+    return max(g_SrcSize >> Mip, uint2(1u, 1u));
+}
+
+void StoreMip(uint Mip, uint2 Coord, uint Slice, float4 Value)
+{
+    uint2 Size = GetMipSize(Mip);
+    if (Mip > g_NumMips || Coord.x >= Size.x || Coord.y >= Size.y)
+        return;
+
+    uint3 Loc = uint3(Coord, Slice);
+    if      (Mip ==  1u) g_OutMip1[Loc]  = Value;
+    else if (Mip ==  2u) g_OutMip2[Loc]  = Value;
+    else if (Mip ==  3u) g_OutMip3[Loc]  = Value;
+    else if (Mip ==  4u) g_OutMip4[Loc]  = Value;
+    else if (Mip ==  5u) g_OutMip5[Loc]  = Value;
+    else if (Mip ==  6u) g_OutMip6[Loc]  = Value;
+    else if (Mip ==  7u) g_OutMip7[Loc]  = Value;
+    else if (Mip ==  8u) g_OutMip8[Loc]  = Value;
+    else if (Mip ==  9u) g_OutMip9[Loc]  = Value;
+    else if (Mip == 10u) g_OutMip10[Loc] = Value;
+    else if (Mip == 11u) g_OutMip11[Loc] = Value;
+    else if (Mip == 12u) g_OutMip12[Loc] = Value;
+}
+
+// Reduces the level Mip-1 tile stored in the group-shared memory to the level Mip tile of size TileSize.
+// TileOrigin is the position of the level Mip tile in the level.
+void ReduceTile(uint LocalIdx, uint TileSize, uint Mip, uint2 TileOrigin, uint Slice)
+{
+    bool   IsActive = LocalIdx < TileSize * TileSize;
+    uint2  Coord    = uint2(LocalIdx % TileSize, LocalIdx / TileSize);
+    float4 Value    = float4(0.0, 0.0, 0.0, 0.0);
+    if (IsActive)
+    {
+        // Texels outside of the level are never read: the last texel is repeated instead.
+        // The tiles of the groups at the bottom and right edges may be entirely outside of the level.
+        // Their values are never stored, and the children are clamped to the tile to stay within the group-shared memory.
+        uint2 PrevSize = GetMipSize(Mip - 1u);
+        for (uint i = 0u; i < 4u; ++i)
+        {
+            uint2 Child = min((TileOrigin + Coord) * 2u + uint2(i & 1u, i >> 1u), PrevSize - 1u);
+            Child       = max(Child, TileOrigin * 2u) - TileOrigin * 2u;
+            Value += g_Tile[Child.y * TileSize * 2u + Child.x];
+        }
+        Value *= 0.25;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (IsActive)
+    {
+        g_Tile[Coord.y * TileSize + Coord.x] = Value;
+        StoreMip(Mip, TileOrigin + Coord, Slice, Value);
+    }
+    GroupMemoryBarrierWithGroupSync();
+}
+
+[numthreads(256, 1, 1)]
+void main(uint3 GroupId  : SV_GroupID,
+          uint  LocalIdx : SV_GroupIndex)
+{
+    uint  Slice = GroupId.z;
+    uint2 Group = GroupId.xy;
+
+    // Level 1: every thread computes 4 texels of the 32x32 tile
+    {
+        uint2 Mip1Origin = Group * 32u;
+        for (uint i = 0u; i < 4u; ++i)
+        {
+            uint   Idx   = LocalIdx + i * 256u;
+            uint2  Texel = Mip1Origin + uint2(Idx % 32u, Idx / 32u);
+            float4 Value = float4(0.0, 0.0, 0.0, 0.0);
+            for (uint j = 0u; j < 4u; ++j)
+            {
+                uint2 Src = min(Texel * 2u + uint2(j & 1u, j >> 1u), g_SrcSize - 1u);
+                Value += g_Source.Load(int4(Src, Slice, 0));
+            }
+            Value *= 0.25;
+            g_Tile[Idx] = Value;
+            StoreMip(1u, Texel, Slice, Value);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Levels 2 to 6
+    for (uint Mip = 2u; Mip <= min(g_NumMips, 6u); ++Mip)
+    {
+        uint TileSize = 32u >> (Mip - 1u);
+        ReduceTile(LocalIdx, TileSize, Mip, Group * TileSize, Slice);
+    }
+
+    if (g_NumMips <= 6u)
+        return;
+
+    uint Mip6Base = g_Mip6Offset + Slice * g_NumWorkGroups;
+    if (LocalIdx == 0u)
+    {
+        g_Mip6[Mip6Base + Group.y * g_NumGroupsX + Group.x] = g_Tile[0];
+        // Make the value visible to other groups before incrementing the counter
+        DeviceMemoryBarrier();
+        uint PrevCount;
+        InterlockedAdd(g_Counters[g_CounterOffset + Slice], 1u, PrevCount);
+        g_PrevCount = PrevCount;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Only the last group of the slice continues
+    if (g_PrevCount != g_NumWorkGroups - 1u)
+        return;
+
+    if (LocalIdx == 0u)
+    {
+        // Reset the counter for the next use
+        g_Counters[g_CounterOffset + Slice] = 0u;
+    }
+    DeviceMemoryBarrier();
+
+    // Level 7: every thread computes 4 texels from the level 6 values of all groups
+    {
+        uint2 Mip6Size = GetMipSize(6u);
+        for (uint i = 0u; i < 4u; ++i)
+        {
+            uint   Idx   = LocalIdx + i * 256u;
+            uint2  Texel = uint2(Idx % 32u, Idx / 32u);
+            float4 Value = float4(0.0, 0.0, 0.0, 0.0);
+            for (uint j = 0u; j < 4u; ++j)
+            {
+                uint2 Src = min(Texel * 2u + uint2(j & 1u, j >> 1u), Mip6Size - 1u);
+                Value += g_Mip6[Mip6Base + Src.y * g_NumGroupsX + Src.x];
+            }
+            Value *= 0.25;
+            g_Tile[Idx] = Value;
+            StoreMip(7u, Texel, Slice, Value);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    // Levels 8 to 12
+    for (uint Mip = 8u; Mip <= g_NumMips; ++Mip)
+    {
+        ReduceTile(LocalIdx, 32u >> (Mip - 7u), Mip, uint2(0u, 0u), Slice);
+    }
+}
+)";
+
+} // namespace
+
+MipGenerator::MipGenerator(IRenderDevice* pDevice, const MipGeneratorCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Name{CI.Name != nullptr ? CI.Name : "Mip generator"}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+
+    const RenderDeviceInfo& DeviceInfo = m_pDevice->GetDeviceInfo();
+    // Direct3D11 does not allow binding 14 UAVs to the compute stage on feature level 11.0.
+    // OpenGL, WebGPU and Metal use IDeviceContext::GenerateMips().
+    if ((DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && DeviceInfo.Type != RENDER_DEVICE_TYPE_VULKAN) || !DeviceInfo.Features.ComputeShaders)
+        return;
+
+    CreateUniformBuffer(m_pDevice, sizeof(SPDConstants), (m_Name + " - constants").c_str(), &m_pConstantsBuffer);
+    if (!m_pConstantsBuffer)
+        LOG_ERROR_AND_THROW("Failed to create the constants buffer");
+
+    CreatePipeline();
+}
+
+void MipGenerator::CreatePipeline()
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc           = {m_Name.c_str(), SHADER_TYPE_COMPUTE, true};
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Source         = SPDShaderSource;
+    ShaderCI.SourceLength   = sizeof(SPDShaderSource) - 1;
+    ShaderCI.EntryPoint     = "main";
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        LOG_ERROR_AND_THROW("Failed to create the downsampling shader");
+
+    // clang-format off
+    const ShaderResourceVariableDesc Variables[] =
+    {
+        {SHADER_TYPE_COMPUTE, "cbSPDConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+    };
+    // clang-format on
+
+    ComputePipelineStateCreateInfo PsoCI{m_Name.c_str()};
+    PsoCI.pCS = pCS;
+
+    // The textures and the buffers change between the dispatches
+    PsoCI.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    PsoCI.PSODesc.ResourceLayout.Variables           = Variables;
+    PsoCI.PSODesc.ResourceLayout.NumVariables        = _countof(Variables);
+
+    m_pDevice->CreateComputePipelineState(PsoCI, &m_pPSO);
+    if (!m_pPSO)
+        LOG_ERROR_AND_THROW("Failed to create the downsampling pipeline");
+
+    m_pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbSPDConstants")->Set(m_pConstantsBuffer);
+
+    m_pPSO->CreateShaderResourceBinding(&m_pSRB, true);
+    VERIFY_EXPR(m_pSRB);
+
+    m_pSourceVar = m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Source");
+    VERIFY_EXPR(m_pSourceVar != nullptr);
+    for (Uint32 Mip = 1; Mip <= MaxGeneratedMips; ++Mip)
+    {
+        const std::string VarName = "g_OutMip" + std::to_string(Mip);
+        m_pOutMipVars[Mip - 1]    = m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, VarName.c_str());
+        VERIFY_EXPR(m_pOutMipVars[Mip - 1] != nullptr);
+    }
+}
+
+void MipGenerator::ReserveBuffers(Uint32 NumMip6Texels, Uint32 NumCounters)
+{
+    if (!m_pMip6Buffer || m_pMip6Buffer->GetDesc().Size < Uint64{NumMip6Texels} * sizeof(float4))
+    {
+        const Uint32 Capacity = m_pMip6Buffer ? std::max(NumMip6Texels, static_cast<Uint32>(m_pMip6Buffer->GetDesc().Size / sizeof(float4)) * 2) : NumMip6Texels;
+
+        const std::string Name = m_Name + " - mip 6";
+
+        BufferDesc Desc;
+        Desc.Name              = Name.c_str();
+        Desc.Size              = Uint64{Capacity} * sizeof(float4);
+        Desc.BindFlags         = BIND_UNORDERED_ACCESS;
+        Desc.Usage             = USAGE_DEFAULT;
+        Desc.Mode              = BUFFER_MODE_STRUCTURED;
+        Desc.ElementByteStride = sizeof(float4);
+
+        m_pMip6Buffer.Release();
+        m_pDevice->CreateBuffer(Desc, nullptr, &m_pMip6Buffer);
+        if (!m_pMip6Buffer)
+            LOG_ERROR_AND_THROW("Failed to create the mip 6 buffer");
+
+        m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Mip6")->Set(m_pMip6Buffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    }
+
+    if (!m_pCountersBuffer || m_pCountersBuffer->GetDesc().Size < Uint64{NumCounters} * sizeof(Uint32))
+    {
+        const Uint32 Capacity = m_pCountersBuffer ? std::max(NumCounters, static_cast<Uint32>(m_pCountersBuffer->GetDesc().Size / sizeof(Uint32)) * 2) : NumCounters;
+
+        const std::string Name = m_Name + " - counters";
+
+        BufferDesc Desc;
+        Desc.Name              = Name.c_str();
+        Desc.Size              = Uint64{Capacity} * sizeof(Uint32);
+        Desc.BindFlags         = BIND_UNORDERED_ACCESS;
+        Desc.Usage             = USAGE_DEFAULT;
+        Desc.Mode              = BUFFER_MODE_FORMATTED;
+        Desc.ElementByteStride = sizeof(Uint32);
+
+        // The counters must be zero initially. Every dispatch resets the counters it uses.
+        const std::vector<Uint32> Zeros(Capacity);
+        BufferData                InitData{Zeros.data(), Desc.Size};
+
+        m_pCountersBuffer.Release();
+        m_pDevice->CreateBuffer(Desc, &InitData, &m_pCountersBuffer);
+        if (!m_pCountersBuffer)
+            LOG_ERROR_AND_THROW("Failed to create the counters buffer");
+
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 1;
+
+        RefCntAutoPtr<IBufferView> pUAV;
+        m_pCountersBuffer->CreateView(ViewDesc, &pUAV);
+        if (!pUAV)
+            LOG_ERROR_AND_THROW("Failed to create the UAV of the counters buffer");
+        m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Counters")->Set(pUAV);
+    }
+}
+
+bool MipGenerator::IsSinglePassSupported(const ITexture* pTexture) const
+{
+    if (!m_pPSO || pTexture == nullptr)
+        return false;
+
+    const TextureDesc& Desc = pTexture->GetDesc();
+    if (Desc.Type != RESOURCE_DIM_TEX_2D && Desc.Type != RESOURCE_DIM_TEX_2D_ARRAY &&
+        Desc.Type != RESOURCE_DIM_TEX_CUBE && Desc.Type != RESOURCE_DIM_TEX_CUBE_ARRAY)
+        return false;
+
+    if (Desc.MipLevels < 2 || Desc.MipLevels > MaxGeneratedMips + 1 || Desc.SampleCount > 1)
+        return false;
+
+    if ((Desc.BindFlags & (BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS)) != (BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS))
+        return false;
+
+    // The most detailed level of the 13-level texture may be larger than 4096 when the other dimension is 1
+    if (Desc.Width > TileSize * TileSize || Desc.Height > TileSize * TileSize)
+        return false;
+
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(Desc.Format);
+    if (FmtAttribs.ComponentType != COMPONENT_TYPE_UNORM &&
+        FmtAttribs.ComponentType != COMPONENT_TYPE_SNORM &&
+        FmtAttribs.ComponentType != COMPONENT_TYPE_FLOAT)
+        return false;
+
+    return pTexture->GetState() != RESOURCE_STATE_UNKNOWN;
+}
+
+void MipGenerator::GenerateMips(IDeviceContext* pContext, ITexture* const* ppTextures, Uint32 NumTextures)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(NumTextures == 0 || ppTextures != nullptr, "ppTextures must not be null when NumTextures is not zero");
+
+    std::vector<ITexture*> SinglePassTextures;
+    SinglePassTextures.reserve(NumTextures);
+
+    Uint32 NumMip6Texels = 0;
+    Uint32 NumCounters   = 0;
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        ITexture* pTexture = ppTextures[i];
+        DEV_CHECK_ERR(pTexture != nullptr, "Texture at index ", i, " is null");
+        if (pTexture == nullptr)
+            continue;
+
+        const TextureDesc& Desc = pTexture->GetDesc();
+        if (Desc.MipLevels <= 1)
+            continue;
+
+        if (IsSinglePassSupported(pTexture))
+        {
+            SinglePassTextures.push_back(pTexture);
+            if (Desc.MipLevels - 1 > 6)
+            {
+                const Uint32 NumGroups = ((Desc.Width + TileSize - 1) / TileSize) * ((Desc.Height + TileSize - 1) / TileSize);
+                NumMip6Texels += NumGroups * Desc.ArraySize;
+                NumCounters += Desc.ArraySize;
+            }
+        }
+        else if ((Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS) != 0)
+        {
+            pContext->GenerateMips(pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE("Unable to generate mips for texture '", Desc.Name,
+                              "': the texture is not supported by the single-pass downsampler and was not created with MISC_TEXTURE_FLAG_GENERATE_MIPS flag");
+        }
+    }
+
+    if (SinglePassTextures.empty())
+        return;
+
+    // The buffers always exist so that all shader variables are initialized
+    ReserveBuffers(std::max(NumMip6Texels, 1u), std::max(NumCounters, 1u));
+
+    // Source level is read as shader resource, the other levels are written as unordered access.
+    // The buffers are transitioned from the unordered access state too, which makes the writes
+    // of the previous batch visible.
+    std::vector<StateTransitionDesc> Barriers;
+    Barriers.reserve(SinglePassTextures.size() * 2 + 2);
+    for (ITexture* pTexture : SinglePassTextures)
+    {
+        const RESOURCE_STATE OldState = pTexture->GetState();
+        Barriers.emplace_back(pTexture, OldState, RESOURCE_STATE_SHADER_RESOURCE, 0u, 1u);
+        Barriers.emplace_back(pTexture, OldState, RESOURCE_STATE_UNORDERED_ACCESS, 1u, REMAINING_MIP_LEVELS);
+    }
+    Barriers.emplace_back(m_pMip6Buffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    Barriers.emplace_back(m_pCountersBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+
+    pContext->SetPipelineState(m_pPSO);
+
+    Uint32 Mip6Offset    = 0;
+    Uint32 CounterOffset = 0;
+    for (ITexture* pTexture : SinglePassTextures)
+    {
+        const TextureDesc& Desc    = pTexture->GetDesc();
+        const Uint32       NumMips = Desc.MipLevels - 1;
+
+        TextureViewDesc ViewDesc;
+        ViewDesc.ViewType        = TEXTURE_VIEW_SHADER_RESOURCE;
+        ViewDesc.TextureDim      = RESOURCE_DIM_TEX_2D_ARRAY;
+        ViewDesc.MostDetailedMip = 0;
+        ViewDesc.NumMipLevels    = 1;
+        ViewDesc.FirstArraySlice = 0;
+        ViewDesc.NumArraySlices  = Desc.ArraySize;
+
+        RefCntAutoPtr<ITextureView> pSRV;
+        pTexture->CreateView(ViewDesc, &pSRV);
+        if (!pSRV)
+        {
+            LOG_ERROR_MESSAGE("Failed to create the source view of texture '", Desc.Name, "'");
+            continue;
+        }
+        m_pSourceVar->Set(pSRV);
+
+        ViewDesc.ViewType = TEXTURE_VIEW_UNORDERED_ACCESS;
+
+        RefCntAutoPtr<ITextureView> pUAVs[MaxGeneratedMips];
+        for (Uint32 Mip = 1; Mip <= MaxGeneratedMips; ++Mip)
+        {
+            // Levels that the texture does not have are never written and use the last level's view
+            if (Mip <= NumMips)
+            {
+                ViewDesc.MostDetailedMip = Mip;
+                pTexture->CreateView(ViewDesc, &pUAVs[Mip - 1]);
+                if (!pUAVs[Mip - 1])
+                {
+                    LOG_ERROR_MESSAGE("Failed to create the view of mip level ", Mip, " of texture '", Desc.Name, "'");
+                    break;
+                }
+            }
+            else
+            {
+                pUAVs[Mip - 1] = pUAVs[NumMips - 1];
+            }
+            m_pOutMipVars[Mip - 1]->Set(pUAVs[Mip - 1]);
+        }
+        if (!pUAVs[MaxGeneratedMips - 1])
+            continue;
+
+        const Uint32 NumGroupsX = (Desc.Width + TileSize - 1) / TileSize;
+        const Uint32 NumGroupsY = (Desc.Height + TileSize - 1) / TileSize;
+        {
+            MapHelper<SPDConstants> Constants{pContext, m_pConstantsBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+            Constants->NumMips       = NumMips;
+            Constants->NumWorkGroups = NumGroupsX * NumGroupsY;
+            Constants->Mip6Offset    = Mip6Offset;
+            Constants->CounterOffset = CounterOffset;
+            Constants->SrcWidth      = Desc.Width;
+            Constants->SrcHeight     = Desc.Height;
+            Constants->NumGroupsX    = NumGroupsX;
+        }
+        if (NumMips > 6)
+        {
+            Mip6Offset += NumGroupsX * NumGroupsY * Desc.ArraySize;
+            CounterOffset += Desc.ArraySize;
+        }
+
+        // All resources have been transitioned above
+        pContext->CommitShaderResources(m_pSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+        DispatchComputeAttribs DispatchAttribs{NumGroupsX, NumGroupsY, Desc.ArraySize};
+        pContext->DispatchCompute(DispatchAttribs);
+    }
+
+    Barriers.clear();
+    for (ITexture* pTexture : SinglePassTextures)
+        Barriers.emplace_back(pTexture, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, 1u, REMAINING_MIP_LEVELS);
+    pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+
+    // Subresource transitions do not update the texture state
+    for (ITexture* pTexture : SinglePassTextures)
+        pTexture->SetState(RESOURCE_STATE_SHADER_RESOURCE);
+}
+
+} // namespace Diligent
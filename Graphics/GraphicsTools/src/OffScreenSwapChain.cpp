@@ -32,6 +32,8 @@
 
 #include "OffScreenSwapChain.hpp"
 
+#include <vector>
+
 namespace Diligent
 {
 
@@ -40,12 +42,26 @@ class OffScreenSwapChain : public SwapChainBase<ISwapChain>
 public:
     using TSwapChainBase = SwapChainBase;
 
-    OffScreenSwapChain(IReferenceCounters*  pRefCounters,
-                       IRenderDevice*       pDevice,
-                       IDeviceContext*      pContext,
-                       const SwapChainDesc& SCDesc) :
-        SwapChainBase{pRefCounters, pDevice, pContext, SCDesc}
+    OffScreenSwapChain(IReferenceCounters*                   pRefCounters,
+                       IRenderDevice*                        pDevice,
+                       IDeviceContext*                       pContext,
+                       const SwapChainDesc&                  SCDesc,
+                       OffScreenSwapChainPresentCallbackType PresentCallback = {}) :
+        SwapChainBase{pRefCounters, pDevice, pContext, SCDesc},
+        m_PresentCallback{std::move(PresentCallback)}
     {
+        if (IsExportable())
+        {
+            m_SwapChainDesc.BufferCount = std::max(m_SwapChainDesc.BufferCount, 1u);
+
+            FenceDesc FenceCI;
+            FenceCI.Name  = "Off screen swap chain fence";
+            FenceCI.Type  = FENCE_TYPE_GENERAL;
+            FenceCI.Flags = FENCE_FLAG_EXPORTABLE;
+            m_pRenderDevice->CreateFence(FenceCI, &m_pFence);
+            if (!m_pFence)
+                LOG_ERROR_AND_THROW("Failed to create exportable fence for the off-screen swap chain");
+        }
 
         if (m_DesiredPreTransform != SURFACE_TRANSFORM_OPTIMAL && m_DesiredPreTransform != SURFACE_TRANSFORM_IDENTITY)
         {
@@ -69,8 +85,30 @@ public:
             return;
         }
 
+        if (IsExportable())
+        {
+            // Hand the back buffer over in a state that does not depend on how it was used
+            StateTransitionDesc Barrier{m_pRenderTarget, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COMMON, STATE_TRANSITION_FLAG_UPDATE_STATE};
+            pDeviceContext->TransitionResourceStates(1, &Barrier);
+            pDeviceContext->EnqueueSignal(m_pFence, ++m_FenceValue);
+        }
+
         pDeviceContext->Flush();
 
+        if (IsExportable())
+        {
+            OffScreenSwapChainFrame Frame;
+            Frame.pBackBuffer     = m_pRenderTarget;
+            Frame.BackBufferIndex = m_BackBufferIndex;
+            Frame.pFence          = m_pFence;
+            Frame.FenceValue      = m_FenceValue;
+            m_PresentCallback(Frame);
+
+            m_BackBufferIndex = (m_BackBufferIndex + 1) % static_cast<Uint32>(m_BackBuffers.size());
+            m_pRenderTarget   = m_BackBuffers[m_BackBufferIndex];
+            m_pRTV            = m_pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        }
+
         if (m_SwapChainDesc.IsPrimary)
         {
             pDeviceContext->FinishFrame();
@@ -86,7 +124,11 @@ public:
             m_pDSV.Release();
             m_pRenderTarget.Release();
             m_pDepthBuffer.Release();
+            m_BackBuffers.clear();
+            m_BackBufferIndex = 0;
 
+            const Uint32 NumBackBuffers = IsExportable() ? m_SwapChainDesc.BufferCount : 1;
+            for (Uint32 i = 0; i < NumBackBuffers; ++i)
             {
                 TextureDesc RenderTargetDesc;
                 RenderTargetDesc.Name        = "Off screen color buffer";
@@ -97,12 +139,18 @@ public:
                 RenderTargetDesc.SampleCount = 1;
                 RenderTargetDesc.Usage       = USAGE_DEFAULT;
                 RenderTargetDesc.BindFlags   = BIND_RENDER_TARGET;
-                m_pRenderDevice->CreateTexture(RenderTargetDesc, nullptr, &m_pRenderTarget);
-                VERIFY_EXPR(m_pRenderTarget != nullptr);
-                m_pRTV = m_pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
-                VERIFY_EXPR(m_pRTV != nullptr);
+                RenderTargetDesc.MiscFlags   = IsExportable() ? MISC_TEXTURE_FLAG_EXPORTABLE : MISC_TEXTURE_FLAG_NONE;
+
+                RefCntAutoPtr<ITexture> pBackBuffer;
+                m_pRenderDevice->CreateTexture(RenderTargetDesc, nullptr, &pBackBuffer);
+                VERIFY_EXPR(pBackBuffer != nullptr);
+                m_BackBuffers.emplace_back(std::move(pBackBuffer));
             }
 
+            m_pRenderTarget = m_BackBuffers[0];
+            m_pRTV          = m_pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+            VERIFY_EXPR(m_pRTV != nullptr);
+
             if (m_SwapChainDesc.DepthBufferFormat != TEX_FORMAT_UNKNOWN)
             {
                 TextureDesc DepthBufferDesc;
@@ -153,6 +201,16 @@ public:
     }
 
 protected:
+    bool IsExportable() const { return static_cast<bool>(m_PresentCallback); }
+
+    const OffScreenSwapChainPresentCallbackType m_PresentCallback;
+
+    std::vector<RefCntAutoPtr<ITexture>> m_BackBuffers;
+    Uint32                               m_BackBufferIndex = 0;
+
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_FenceValue = 0;
+
     RefCntAutoPtr<ITexture>     m_pRenderTarget;
     RefCntAutoPtr<ITexture>     m_pDepthBuffer;
     RefCntAutoPtr<ITextureView> m_pRTV;
@@ -174,4 +232,28 @@ void CreateOffScreenSwapChain(IRenderDevice* pDevice, IDeviceContext* pContext,
     }
 }
 
+void CreateExportableOffScreenSwapChain(IRenderDevice*                        pDevice,
+                                        IDeviceContext*                       pContext,
+                                        const SwapChainDesc&                  SCDesc,
+                                        OffScreenSwapChainPresentCallbackType PresentCallback,
+                                        ISwapChain**                          ppSwapChain)
+{
+    if (!PresentCallback)
+    {
+        DEV_ERROR("Present callback must not be empty");
+        return;
+    }
+
+    try
+    {
+        RefCntAutoPtr<ISwapChain> pSwapChain{MakeNewRCObj<OffScreenSwapChain>()(pDevice, pContext, SCDesc, std::move(PresentCallback))};
+        if (pSwapChain)
+            pSwapChain->QueryInterface(IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain));
+    }
+    catch (...)
+    {
+        LOG_ERROR("Failed to create exportable off-screen swap chain");
+    }
+}
+
 } // namespace Diligent
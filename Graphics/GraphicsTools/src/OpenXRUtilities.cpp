@@ -251,6 +251,69 @@ void GetOpenXRSwapchainImage(IRenderDevice*                    pDevice,
     }
 }
 
+void GetOpenXRSwapchainImages(IRenderDevice*                    pDevice,
+                              const XrSwapchainImageBaseHeader* ImageData,
+                              Uint32                            ImageCount,
+                              const TextureDesc&                TexDesc,
+                              ITexture**                        ppImages)
+{
+    if (ppImages == nullptr)
+    {
+        UNEXPECTED("ppImages must not be null");
+        return;
+    }
+
+    for (Uint32 i = 0; i < ImageCount; ++i)
+    {
+        ppImages[i] = nullptr;
+        GetOpenXRSwapchainImage(pDevice, ImageData, i, TexDesc, &ppImages[i]);
+        if (ppImages[i] == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to get OpenXR swapchain image ", i);
+            for (Uint32 j = 0; j < i; ++j)
+            {
+                ppImages[j]->Release();
+                ppImages[j] = nullptr;
+            }
+            return;
+        }
+    }
+}
+
+void CreateOpenXRSwapchainImageView(ITexture*      pImage,
+                                    Uint32         FirstArraySlice,
+                                    Uint32         NumArraySlices,
+                                    ITextureView** ppView)
+{
+    if (pImage == nullptr)
+    {
+        UNEXPECTED("pImage must not be null");
+        return;
+    }
+
+    if (ppView == nullptr)
+    {
+        UNEXPECTED("ppView must not be null");
+        return;
+    }
+
+    const TextureDesc& TexDesc = pImage->GetDesc();
+    if (FirstArraySlice + NumArraySlices > TexDesc.GetArraySize())
+    {
+        LOG_ERROR_MESSAGE("Array slices [", FirstArraySlice, ", ", FirstArraySlice + NumArraySlices, ") are out of range of swapchain image '",
+                          (TexDesc.Name != nullptr ? TexDesc.Name : ""), "' that has ", TexDesc.GetArraySize(), " slice(s).");
+        return;
+    }
+
+    TextureViewDesc ViewDesc;
+    ViewDesc.Name            = "OpenXR swapchain image view";
+    ViewDesc.ViewType        = GetTextureFormatAttribs(TexDesc.Format).IsDepthStencil() ? TEXTURE_VIEW_DEPTH_STENCIL : TEXTURE_VIEW_RENDER_TARGET;
+    ViewDesc.TextureDim      = TexDesc.IsArray() ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D;
+    ViewDesc.FirstArraySlice = FirstArraySlice;
+    ViewDesc.NumArraySlices  = NumArraySlices;
+    pImage->CreateView(ViewDesc, ppView);
+}
+
 static XrBool32 OpenXRMessageCallbackFunction(XrDebugUtilsMessageSeverityFlagsEXT         xrMessageSeverity,
                                               XrDebugUtilsMessageTypeFlagsEXT             xrMessageType,
                                               const XrDebugUtilsMessengerCallbackDataEXT* pCallbackData,
@@ -390,4 +453,21 @@ extern "C"
     {
         Diligent::GetOpenXRSwapchainImage(pDevice, ImageData, ImageIndex, TexDesc, ppImage);
     }
+
+    void Diligent_GetOpenXRSwapchainImages(Diligent::IRenderDevice*          pDevice,
+                                           const XrSwapchainImageBaseHeader* ImageData,
+                                           Diligent::Uint32                  ImageCount,
+                                           const Diligent::TextureDesc&      TexDesc,
+                                           Diligent::ITexture**              ppImages)
+    {
+        Diligent::GetOpenXRSwapchainImages(pDevice, ImageData, ImageCount, TexDesc, ppImages);
+    }
+
+    void Diligent_CreateOpenXRSwapchainImageView(Diligent::ITexture*      pImage,
+                                                 Diligent::Uint32         FirstArraySlice,
+                                                 Diligent::Uint32         NumArraySlices,
+                                                 Diligent::ITextureView** ppView)
+    {
+        Diligent::CreateOpenXRSwapchainImageView(pImage, FirstArraySlice, NumArraySlices, ppView);
+    }
 }
@@ -0,0 +1,174 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ParallelCommandRecorder.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+ParallelCommandRecorder::ParallelCommandRecorder(const ParallelCommandRecorderCreateInfo& CI) :
+    m_pThreadPool{CI.pThreadPool}
+{
+    DEV_CHECK_ERR(CI.NumDeferredContexts == 0 || CI.ppDeferredContexts != nullptr, "ppDeferredContexts must not be null when NumDeferredContexts is not zero");
+
+    m_Contexts.reserve(CI.NumDeferredContexts);
+    for (Uint32 i = 0; i < CI.NumDeferredContexts; ++i)
+    {
+        IDeviceContext* pContext = CI.ppDeferredContexts[i];
+        if (pContext == nullptr)
+        {
+            DEV_ERROR("Deferred context ", i, " is null");
+            continue;
+        }
+        DEV_CHECK_ERR(pContext->GetDesc().IsDeferred, "Context '", pContext->GetDesc().Name, "' is not a deferred context");
+
+        ContextInfo Ctx;
+        Ctx.pContext = pContext;
+        m_Contexts.emplace_back(std::move(Ctx));
+    }
+}
+
+ParallelCommandRecorder::~ParallelCommandRecorder()
+{
+    FinishFrame();
+}
+
+void ParallelCommandRecorder::RecordJob(Uint32 JobIndex, Uint32 ImmediateCtxId, Uint32 FirstItem, Uint32 NumItems, const RecordCallbackType& Callback)
+{
+    ContextInfo& Ctx = m_Contexts[JobIndex];
+    Ctx.pContext->Begin(ImmediateCtxId);
+    Callback(Ctx.pContext, JobIndex, FirstItem, NumItems);
+    Ctx.pContext->FinishCommandList(&Ctx.pCommandList);
+}
+
+void ParallelCommandRecorder::Record(IDeviceContext*           pImmediateCtx,
+                                     Uint32                    NumItems,
+                                     const RecordCallbackType& Callback,
+                                     Uint32                    MinItemsPerJob)
+{
+    DEV_CHECK_ERR(pImmediateCtx != nullptr, "Immediate context must not be null");
+    DEV_CHECK_ERR(!pImmediateCtx->GetDesc().IsDeferred, "Command lists must be executed by an immediate context");
+    DEV_CHECK_ERR(Callback, "Record callback must not be null");
+
+    m_LastJobCount = 0;
+    if (NumItems == 0)
+        return;
+
+    if (m_Contexts.empty())
+    {
+        // No deferred contexts: record everything into the immediate context
+        Callback(pImmediateCtx, 0, 0, NumItems);
+        m_LastJobCount = 1;
+        return;
+    }
+
+    MinItemsPerJob        = std::max(MinItemsPerJob, 1u);
+    const Uint32 NumJobs  = std::max(std::min(static_cast<Uint32>(m_Contexts.size()), NumItems / MinItemsPerJob), 1u);
+    const Uint32 ImmCtxId = pImmediateCtx->GetDesc().ContextId;
+
+    // Distribute the remainder between the first jobs so that the job sizes differ by at most one
+    const Uint32 ItemsPerJob = NumItems / NumJobs;
+    const Uint32 Remainder   = NumItems % NumJobs;
+    auto         GetJobRange = [&](Uint32 Job, Uint32& FirstItem, Uint32& JobItems) {
+        FirstItem = Job * ItemsPerJob + std::min(Job, Remainder);
+        JobItems  = ItemsPerJob + (Job < Remainder ? 1 : 0);
+    };
+
+    // Jobs 1..NumJobs-1 are run by the thread pool, job 0 is recorded by this thread
+    m_Tasks.clear();
+    for (Uint32 Job = 1; Job < NumJobs; ++Job)
+    {
+        Uint32 FirstItem = 0, JobItems = 0;
+        GetJobRange(Job, FirstItem, JobItems);
+        if (m_pThreadPool)
+        {
+            m_Tasks.emplace_back(EnqueueAsyncWork(m_pThreadPool,
+                                                  [this, Job, ImmCtxId, FirstItem, JobItems, &Callback](Uint32 ThreadId) {
+                                                      RecordJob(Job, ImmCtxId, FirstItem, JobItems, Callback);
+                                                      return ASYNC_TASK_STATUS_COMPLETE;
+                                                  }));
+        }
+    }
+
+    {
+        Uint32 FirstItem = 0, JobItems = 0;
+        GetJobRange(0, FirstItem, JobItems);
+        RecordJob(0, ImmCtxId, FirstItem, JobItems, Callback);
+    }
+
+    if (m_pThreadPool)
+    {
+        for (IAsyncTask* pTask : m_Tasks)
+            pTask->WaitForCompletion();
+        m_Tasks.clear();
+    }
+    else
+    {
+        for (Uint32 Job = 1; Job < NumJobs; ++Job)
+        {
+            Uint32 FirstItem = 0, JobItems = 0;
+            GetJobRange(Job, FirstItem, JobItems);
+            RecordJob(Job, ImmCtxId, FirstItem, JobItems, Callback);
+        }
+    }
+
+    // Execute the command lists in the job order
+    m_CommandLists.clear();
+    for (Uint32 Job = 0; Job < NumJobs; ++Job)
+    {
+        ContextInfo& Ctx = m_Contexts[Job];
+        if (Ctx.pCommandList)
+            m_CommandLists.push_back(Ctx.pCommandList);
+        Ctx.NeedsFinishFrame = true;
+    }
+    pImmediateCtx->ExecuteCommandLists(static_cast<Uint32>(m_CommandLists.size()), m_CommandLists.data());
+    m_CommandLists.clear();
+
+    // Command lists can't be executed again (except for Direct3D11), release them
+    for (Uint32 Job = 0; Job < NumJobs; ++Job)
+        m_Contexts[Job].pCommandList.Release();
+
+    m_LastJobCount = NumJobs;
+}
+
+void ParallelCommandRecorder::FinishFrame()
+{
+    for (ContextInfo& Ctx : m_Contexts)
+    {
+        if (!Ctx.NeedsFinishFrame)
+            continue;
+
+        Ctx.pContext->FinishFrame();
+        Ctx.NeedsFinishFrame = false;
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "PipelineStateWarmUp.hpp"
+
+#include "DebugUtilities.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+PipelineStateWarmUp::PipelineStateWarmUp(const PipelineStateWarmUpCreateInfo& CI) :
+    m_pDevice{CI.pDevice},
+    m_pDearchiver{CI.pDearchiver},
+    m_Items(CI.NumPipelineStates)
+{
+    DEV_CHECK_ERR(CI.pDevice != nullptr, "pDevice must not be null");
+    DEV_CHECK_ERR(CI.pDearchiver != nullptr, "pDearchiver must not be null");
+    DEV_CHECK_ERR(CI.NumPipelineStates == 0 || CI.pUnpackInfos != nullptr, "pUnpackInfos must not be null when NumPipelineStates is not zero");
+
+    for (Uint32 i = 0; i < CI.NumPipelineStates; ++i)
+    {
+        ItemInfo& Item = m_Items[i];
+
+        Item.UnpackInfo         = CI.pUnpackInfos[i];
+        Item.UnpackInfo.pDevice = m_pDevice;
+        if (Item.UnpackInfo.Name != nullptr)
+        {
+            Item.Name            = Item.UnpackInfo.Name;
+            Item.UnpackInfo.Name = Item.Name.c_str();
+        }
+    }
+
+    if (!m_pDevice || !m_pDearchiver)
+    {
+        m_NumFailed.store(CI.NumPipelineStates);
+        m_NumCompleted.store(CI.NumPipelineStates);
+        return;
+    }
+
+    IThreadPool* pThreadPool = CI.pThreadPool != nullptr ? CI.pThreadPool : m_pDevice->GetShaderCompilationThreadPool();
+    for (Uint32 i = 0; i < CI.NumPipelineStates; ++i)
+    {
+        if (pThreadPool != nullptr)
+        {
+            m_Items[i].pTask = EnqueueAsyncWork(pThreadPool,
+                                                [this, i](Uint32 ThreadId) {
+                                                    UnpackPipelineState(i);
+                                                    return ASYNC_TASK_STATUS_COMPLETE;
+                                                });
+        }
+        else
+        {
+            UnpackPipelineState(i);
+        }
+    }
+}
+
+PipelineStateWarmUp::~PipelineStateWarmUp()
+{
+    WaitForCompletion();
+}
+
+void PipelineStateWarmUp::UnpackPipelineState(Uint32 Index)
+{
+    ItemInfo& Item = m_Items[Index];
+
+    m_pDearchiver->UnpackPipelineState(Item.UnpackInfo, &Item.pPSO);
+    if (!Item.pPSO)
+    {
+        LOG_ERROR_MESSAGE("Failed to unpack pipeline state '", Item.Name, "'");
+        m_NumFailed.fetch_add(1);
+    }
+
+    Item.IsComplete.store(true);
+    m_NumCompleted.fetch_add(1);
+}
+
+float PipelineStateWarmUp::GetProgress() const
+{
+    const Uint32 NumPipelineStates = GetNumPipelineStates();
+    return NumPipelineStates > 0 ?
+        static_cast<float>(GetNumCompleted()) / static_cast<float>(NumPipelineStates) :
+        1.f;
+}
+
+void PipelineStateWarmUp::WaitForCompletion()
+{
+    for (ItemInfo& Item : m_Items)
+    {
+        if (Item.pTask)
+            Item.pTask->WaitForCompletion();
+    }
+}
+
+IPipelineState* PipelineStateWarmUp::GetPipelineState(Uint32 Index) const
+{
+    DEV_CHECK_ERR(Index < m_Items.size(), "Pipeline state index (", Index, ") is out of range");
+    if (Index >= m_Items.size())
+        return nullptr;
+
+    const ItemInfo& Item = m_Items[Index];
+    return Item.IsComplete.load() ? Item.pPSO.RawPtr() : nullptr;
+}
+
+} // namespace Diligent
@@ -38,6 +38,8 @@ constexpr INTERFACE_ID ReloadablePipelineState::IID_InternalImpl;
 struct ReloadablePipelineState::CreateInfoWrapperBase
 {
     virtual ~CreateInfoWrapperBase() {}
+
+    virtual bool UsesAnyShader(const std::unordered_set<const IShader*>& Shaders) const = 0;
 };
 
 template <typename CreateInfoType>
@@ -64,6 +66,16 @@ struct ReloadablePipelineState::CreateInfoWrapper : CreateInfoWrapperBase
         return m_CI;
     }
 
+    virtual bool UsesAnyShader(const std::unordered_set<const IShader*>& Shaders) const override final
+    {
+        bool UsesShader = false;
+        ProcessPipelineStateCreateInfoShaders(static_cast<const CreateInfoType&>(m_CI), [&](IShader* pShader) {
+            if (pShader != nullptr && Shaders.find(pShader) != Shaders.end())
+                UsesShader = true;
+        });
+        return UsesShader;
+    }
+
     operator const CreateInfoType&() const
     {
         return m_CI;
@@ -270,6 +282,11 @@ bool ReloadablePipelineState::Reload(ReloadGraphicsPipelineCallbackType ReloadGr
     }
 }
 
+bool ReloadablePipelineState::UsesAnyShader(const std::unordered_set<const IShader*>& Shaders) const
+{
+    return m_pCreateInfo && m_pCreateInfo->UsesAnyShader(Shaders);
+}
+
 void ReloadablePipelineState::Create(RenderStateCacheImpl*          pStateCache,
                                      IPipelineState*                pPipeline,
                                      const PipelineStateCreateInfo& CreateInfo,
@@ -26,6 +26,8 @@
 
 #include "ReloadableShader.hpp"
 #include "RenderStateCacheImpl.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "BasicFileSystem.hpp"
 
 namespace Diligent
 {
@@ -95,9 +97,62 @@ bool ReloadableShader::Reload()
         const char* Name = m_CreateInfo.Get().Desc.Name;
         LOG_ERROR_MESSAGE("Failed to reload shader '", (Name ? Name : "<unnamed>"), "'.");
     }
+    // Include files may have been added or removed
+    m_DependenciesValid = false;
+
     return !FoundInCache;
 }
 
+// Changed file paths, e.g. reported by a file watcher, are typically absolute while the
+// dependencies are relative to the source factory search directories, so the dependency
+// is only required to match the trailing path components.
+static bool FilePathMatchesDependency(const std::string& FilePath, const std::string& Dependency)
+{
+    if (Dependency.empty() || FilePath.length() < Dependency.length())
+        return false;
+
+    const size_t Offset = FilePath.length() - Dependency.length();
+    if (FilePath.compare(Offset, Dependency.length(), Dependency) != 0)
+        return false;
+
+    return Offset == 0 || FilePath[Offset - 1] == '/';
+}
+
+bool ReloadableShader::DependsOnFile(const char* FilePath)
+{
+    if (FilePath == nullptr)
+        return false;
+
+    if (!m_DependenciesValid)
+    {
+        m_Dependencies.clear();
+
+        const ShaderCreateInfo& ShaderCI = m_CreateInfo;
+        if (ShaderCI.pShaderSourceStreamFactory != nullptr)
+        {
+            if (ShaderCI.FilePath != nullptr)
+                m_Dependencies.emplace_back(ShaderCI.FilePath);
+
+            std::vector<std::string> Includes;
+            if (GetShaderIncludeDependencies(ShaderCI, Includes))
+                m_Dependencies.insert(m_Dependencies.end(), Includes.begin(), Includes.end());
+        }
+
+        for (std::string& Dependency : m_Dependencies)
+            Dependency = BasicFileSystem::SimplifyPath(Dependency.c_str(), '/');
+
+        m_DependenciesValid = true;
+    }
+
+    const std::string Path = BasicFileSystem::SimplifyPath(FilePath, '/');
+    for (const std::string& Dependency : m_Dependencies)
+    {
+        if (FilePathMatchesDependency(Path, Dependency))
+            return true;
+    }
+
+    return false;
+}
 
 void ReloadableShader::Create(RenderStateCacheImpl*   pStateCache,
                               IShader*                pShader,
@@ -0,0 +1,1239 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+#include "ScopedDebugGroup.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+BIND_FLAGS TextureStateToBindFlags(RESOURCE_STATE State)
+{
+    BIND_FLAGS BindFlags = BIND_NONE;
+    if (State & RESOURCE_STATE_RENDER_TARGET)
+        BindFlags |= BIND_RENDER_TARGET;
+    if (State & (RESOURCE_STATE_DEPTH_WRITE | RESOURCE_STATE_DEPTH_READ))
+        BindFlags |= BIND_DEPTH_STENCIL;
+    if (State & (RESOURCE_STATE_SHADER_RESOURCE | RESOURCE_STATE_INPUT_ATTACHMENT))
+        BindFlags |= BIND_SHADER_RESOURCE;
+    if (State & RESOURCE_STATE_UNORDERED_ACCESS)
+        BindFlags |= BIND_UNORDERED_ACCESS;
+    if (State & RESOURCE_STATE_SHADING_RATE)
+        BindFlags |= BIND_SHADING_RATE;
+    return BindFlags;
+}
+
+BIND_FLAGS BufferStateToBindFlags(RESOURCE_STATE State)
+{
+    BIND_FLAGS BindFlags = BIND_NONE;
+    if (State & RESOURCE_STATE_VERTEX_BUFFER)
+        BindFlags |= BIND_VERTEX_BUFFER;
+    if (State & RESOURCE_STATE_INDEX_BUFFER)
+        BindFlags |= BIND_INDEX_BUFFER;
+    if (State & RESOURCE_STATE_CONSTANT_BUFFER)
+        BindFlags |= BIND_UNIFORM_BUFFER;
+    if (State & RESOURCE_STATE_SHADER_RESOURCE)
+        BindFlags |= BIND_SHADER_RESOURCE;
+    if (State & RESOURCE_STATE_UNORDERED_ACCESS)
+        BindFlags |= BIND_UNORDERED_ACCESS;
+    if (State & RESOURCE_STATE_INDIRECT_ARGUMENT)
+        BindFlags |= BIND_INDIRECT_DRAW_ARGS;
+    return BindFlags;
+}
+
+} // namespace
+
+RenderGraphResource RenderGraphBuilder::CreateTexture(const TextureDesc& Desc)
+{
+    RenderGraph::ResourceInfo Res;
+    Res.Type         = RenderGraph::ResourceType::Texture;
+    Res.Name         = Desc.Name != nullptr ? Desc.Name : "";
+    Res.TexDesc      = Desc;
+    Res.TexDesc.Name = nullptr;
+    return m_Graph.AddResource(std::move(Res));
+}
+
+RenderGraphResource RenderGraphBuilder::CreateBuffer(const BufferDesc& Desc)
+{
+    RenderGraph::ResourceInfo Res;
+    Res.Type          = RenderGraph::ResourceType::Buffer;
+    Res.Name          = Desc.Name != nullptr ? Desc.Name : "";
+    Res.BuffDesc      = Desc;
+    Res.BuffDesc.Name = nullptr;
+    return m_Graph.AddResource(std::move(Res));
+}
+
+void RenderGraphBuilder::Read(RenderGraphResource Res, RESOURCE_STATE State)
+{
+    m_Graph.AddAccess(m_PassIndex, Res, State, /*IsWrite = */ false);
+}
+
+void RenderGraphBuilder::Write(RenderGraphResource Res, RESOURCE_STATE State)
+{
+    m_Graph.AddAccess(m_PassIndex, Res, State, /*IsWrite = */ true);
+}
+
+void RenderGraphBuilder::SetSideEffects()
+{
+    m_Graph.m_Passes[m_PassIndex].HasSideEffects = true;
+}
+
+void RenderGraphBuilder::SetRenderTarget(Uint32 Slot, RenderGraphResource Res, ATTACHMENT_LOAD_OP LoadOp, const OptimizedClearValue& ClearValue)
+{
+    DEV_CHECK_ERR(Slot < MAX_RENDER_TARGETS, "Render target slot (", Slot, ") exceeds the maximum allowed value (", MAX_RENDER_TARGETS - 1, ")");
+    if (Slot >= MAX_RENDER_TARGETS)
+        return;
+
+    m_Graph.AddAccess(m_PassIndex, Res, RESOURCE_STATE_RENDER_TARGET, /*IsWrite = */ true);
+    if (!Res.IsValid() || Res.Index >= m_Graph.m_Resources.size())
+        return;
+
+    RenderGraph::PassInfo& Pass = m_Graph.m_Passes[m_PassIndex];
+    Pass.RenderTargets[Slot]    = {Res.Index, LoadOp, ClearValue};
+    Pass.NumRenderTargets       = std::max(Pass.NumRenderTargets, Slot + 1);
+}
+
+void RenderGraphBuilder::SetDepthStencil(RenderGraphResource Res, ATTACHMENT_LOAD_OP LoadOp, const OptimizedClearValue& ClearValue, bool ReadOnly)
+{
+    m_Graph.AddAccess(m_PassIndex, Res, ReadOnly ? RESOURCE_STATE_DEPTH_READ : RESOURCE_STATE_DEPTH_WRITE, /*IsWrite = */ !ReadOnly);
+    if (!Res.IsValid() || Res.Index >= m_Graph.m_Resources.size())
+        return;
+
+    RenderGraph::PassInfo& Pass = m_Graph.m_Passes[m_PassIndex];
+    Pass.DepthStencil           = {Res.Index, LoadOp, ClearValue};
+    Pass.ReadOnlyDepth          = ReadOnly;
+}
+
+void RenderGraphBuilder::ReadInputAttachment(RenderGraphResource Res)
+{
+    m_Graph.AddAccess(m_PassIndex, Res, RESOURCE_STATE_INPUT_ATTACHMENT, /*IsWrite = */ false);
+    if (!Res.IsValid() || Res.Index >= m_Graph.m_Resources.size())
+        return;
+
+    RenderGraph::ResourceInfo& ResInfo = m_Graph.m_Resources[Res.Index];
+    if (!ResInfo.IsImported && m_Graph.m_SubpassMergingEnabled)
+        ResInfo.TexDesc.BindFlags |= BIND_INPUT_ATTACHMENT;
+
+    for (RenderGraph::ResourceAccess& Access : m_Graph.m_Passes[m_PassIndex].Accesses)
+    {
+        if (Access.ResIndex == Res.Index)
+        {
+            DEV_CHECK_ERR(Access.State == RESOURCE_STATE_INPUT_ATTACHMENT, "Input attachment '", ResInfo.Name, "' must not be declared with any other access in the same pass");
+            Access.IsInputAttachment = true;
+        }
+    }
+}
+
+
+ITexture* RenderGraphContext::GetTexture(RenderGraphResource Res) const
+{
+    return static_cast<ITexture*>(m_Graph.GetResourceObject(Res, RenderGraph::ResourceType::Texture));
+}
+
+IBuffer* RenderGraphContext::GetBuffer(RenderGraphResource Res) const
+{
+    return static_cast<IBuffer*>(m_Graph.GetResourceObject(Res, RenderGraph::ResourceType::Buffer));
+}
+
+bool RenderGraphContext::IsInputAttachment(RenderGraphResource Res) const
+{
+    if (m_Graph.m_CurrentPass >= m_Graph.m_Passes.size())
+        return false;
+
+    for (const RenderGraph::ResourceAccess& Access : m_Graph.m_Passes[m_Graph.m_CurrentPass].Accesses)
+    {
+        if (Access.ResIndex == Res.Index)
+            return Access.IsInputAttachment && Access.State == RESOURCE_STATE_INPUT_ATTACHMENT;
+    }
+
+    DEV_ERROR("Resource is not declared by pass '", m_Graph.m_Passes[m_Graph.m_CurrentPass].Name, "'");
+    return false;
+}
+
+
+RenderGraph::RenderGraph(IRenderDevice* pDevice, bool EnableSplitBarriers, bool EnableSubpassMerging) :
+    m_pDevice{pDevice},
+    // Begin-split barriers are ignored by all backends except Direct3D12
+    m_SplitBarriersEnabled{EnableSplitBarriers && pDevice != nullptr && pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D12},
+    m_SubpassMergingEnabled{EnableSubpassMerging}
+{
+    DEV_CHECK_ERR(m_pDevice, "Render device must not be null");
+}
+
+RenderGraph::~RenderGraph()
+{
+}
+
+RenderGraphResource RenderGraph::ImportTexture(ITexture* pTexture, RESOURCE_STATE InitialState, RESOURCE_STATE FinalState)
+{
+    DEV_CHECK_ERR(pTexture != nullptr, "Texture must not be null");
+
+    ResourceInfo Res;
+    Res.Type         = ResourceType::Texture;
+    Res.Name         = pTexture->GetDesc().Name != nullptr ? pTexture->GetDesc().Name : "";
+    Res.TexDesc      = pTexture->GetDesc();
+    Res.TexDesc.Name = nullptr;
+    Res.pObject      = pTexture;
+    Res.IsImported   = true;
+    Res.InitialState = InitialState;
+    Res.FinalState   = FinalState;
+    return AddResource(std::move(Res));
+}
+
+RenderGraphResource RenderGraph::ImportBuffer(IBuffer* pBuffer, RESOURCE_STATE InitialState, RESOURCE_STATE FinalState)
+{
+    DEV_CHECK_ERR(pBuffer != nullptr, "Buffer must not be null");
+
+    ResourceInfo Res;
+    Res.Type          = ResourceType::Buffer;
+    Res.Name          = pBuffer->GetDesc().Name != nullptr ? pBuffer->GetDesc().Name : "";
+    Res.BuffDesc      = pBuffer->GetDesc();
+    Res.BuffDesc.Name = nullptr;
+    Res.pObject       = pBuffer;
+    Res.IsImported    = true;
+    Res.InitialState  = InitialState;
+    Res.FinalState    = FinalState;
+    return AddResource(std::move(Res));
+}
+
+RenderGraphResource RenderGraph::AddResource(ResourceInfo&& Res)
+{
+    m_IsCompiled = false;
+
+    RenderGraphResource Handle;
+    Handle.Index = static_cast<Uint32>(m_Resources.size());
+    m_Resources.emplace_back(std::move(Res));
+    return Handle;
+}
+
+void RenderGraph::AddAccess(Uint32 PassIndex, RenderGraphResource Res, RESOURCE_STATE State, bool IsWrite)
+{
+    if (!Res.IsValid() || Res.Index >= m_Resources.size())
+    {
+        DEV_ERROR("Invalid render graph resource");
+        return;
+    }
+    DEV_CHECK_ERR(State != RESOURCE_STATE_UNKNOWN, "Resource access state must not be unknown");
+
+    ResourceInfo& ResInfo = m_Resources[Res.Index];
+    if (!ResInfo.IsImported)
+    {
+        if (ResInfo.Type == ResourceType::Texture)
+            ResInfo.TexDesc.BindFlags |= TextureStateToBindFlags(State);
+        else
+            ResInfo.BuffDesc.BindFlags |= BufferStateToBindFlags(State);
+    }
+
+    // Accesses to the same resource within one pass are merged so that the pass
+    // requires a single transition for every resource.
+    PassInfo& Pass = m_Passes[PassIndex];
+    for (ResourceAccess& Access : Pass.Accesses)
+    {
+        if (Access.ResIndex == Res.Index)
+        {
+            Access.State |= State;
+            Access.IsWrite = Access.IsWrite || IsWrite;
+            return;
+        }
+    }
+    Pass.Accesses.push_back({Res.Index, State, IsWrite});
+}
+
+void RenderGraph::AddPass(const char* Name, const SetupCallbackType& Setup, ExecuteCallbackType Execute)
+{
+    DEV_CHECK_ERR(Name != nullptr, "Pass name must not be null");
+
+    m_IsCompiled = false;
+
+    const Uint32 PassIndex = static_cast<Uint32>(m_Passes.size());
+    {
+        PassInfo Pass;
+        Pass.Name    = Name != nullptr ? Name : "";
+        Pass.Execute = std::move(Execute);
+        m_Passes.emplace_back(std::move(Pass));
+    }
+
+    if (Setup)
+    {
+        RenderGraphBuilder Builder{*this, PassIndex};
+        Setup(Builder);
+    }
+}
+
+void RenderGraph::CullPasses()
+{
+    // Resources whose contents are required by the passes that are kept.
+    // Imported resources are the outputs of the graph.
+    std::vector<bool> IsResourceNeeded(m_Resources.size());
+    for (size_t i = 0; i < m_Resources.size(); ++i)
+        IsResourceNeeded[i] = m_Resources[i].IsImported;
+
+    m_Stats.NumCulledPasses = 0;
+    for (size_t pass = m_Passes.size(); pass-- > 0;)
+    {
+        PassInfo& Pass = m_Passes[pass];
+
+        bool IsNeeded = Pass.HasSideEffects;
+        for (const ResourceAccess& Access : Pass.Accesses)
+        {
+            if (Access.IsWrite && IsResourceNeeded[Access.ResIndex])
+                IsNeeded = true;
+        }
+
+        Pass.IsCulled = !IsNeeded;
+        if (Pass.IsCulled)
+        {
+            ++m_Stats.NumCulledPasses;
+            continue;
+        }
+
+        // All resources used by the pass are needed, including the written ones,
+        // as the pass may only partially overwrite them.
+        for (const ResourceAccess& Access : Pass.Accesses)
+            IsResourceNeeded[Access.ResIndex] = true;
+    }
+}
+
+void RenderGraph::CalculateLifetimes()
+{
+    for (ResourceInfo& Res : m_Resources)
+    {
+        Res.FirstPass = ~0u;
+        Res.LastPass  = 0;
+    }
+
+    for (Uint32 pass = 0; pass < m_Passes.size(); ++pass)
+    {
+        const PassInfo& Pass = m_Passes[pass];
+        if (Pass.IsCulled)
+            continue;
+
+        for (const ResourceAccess& Access : Pass.Accesses)
+        {
+            ResourceInfo& Res = m_Resources[Access.ResIndex];
+            Res.FirstPass     = std::min(Res.FirstPass, pass);
+            Res.LastPass      = std::max(Res.LastPass, pass);
+        }
+    }
+}
+
+Uint32 RenderGraph::AcquirePooledObject(const ResourceInfo& Res)
+{
+    for (Uint32 i = 0; i < m_Pool.size(); ++i)
+    {
+        const PooledObject& Obj = m_Pool[i];
+        if (Obj.InUse || Obj.Type != Res.Type)
+            continue;
+
+        if ((Res.Type == ResourceType::Texture && Obj.TexDesc == Res.TexDesc) ||
+            (Res.Type == ResourceType::Buffer && Obj.BuffDesc == Res.BuffDesc))
+            return i;
+    }
+
+    PooledObject Obj;
+    Obj.Type = Res.Type;
+    if (Res.Type == ResourceType::Texture)
+    {
+        Obj.TexDesc = Res.TexDesc;
+
+        TextureDesc Desc = Res.TexDesc;
+        Desc.Name        = Res.Name.c_str();
+
+        RefCntAutoPtr<ITexture> pTexture;
+        m_pDevice->CreateTexture(Desc, nullptr, &pTexture);
+        if (!pTexture)
+        {
+            LOG_ERROR_MESSAGE("Failed to create transient texture '", Res.Name, "'");
+            return ~0u;
+        }
+        Obj.pObject = pTexture;
+    }
+    else
+    {
+        Obj.BuffDesc = Res.BuffDesc;
+
+        BufferDesc Desc = Res.BuffDesc;
+        Desc.Name       = Res.Name.c_str();
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+        if (!pBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create transient buffer '", Res.Name, "'");
+            return ~0u;
+        }
+        Obj.pObject = pBuffer;
+    }
+
+    m_Pool.emplace_back(std::move(Obj));
+    return static_cast<Uint32>(m_Pool.size() - 1);
+}
+
+void RenderGraph::AllocateTransientResources()
+{
+    for (PooledObject& Obj : m_Pool)
+        Obj.InUse = false;
+
+    for (ResourceInfo& Res : m_Resources)
+    {
+        if (!Res.IsImported)
+        {
+            Res.pObject.Release();
+            Res.PoolIndex = ~0u;
+        }
+    }
+
+    // Resources sorted by the pass in which their lifetime ends
+    std::vector<Uint32> ResourcesByLastPass;
+    for (Uint32 i = 0; i < m_Resources.size(); ++i)
+    {
+        const ResourceInfo& Res = m_Resources[i];
+        if (!Res.IsImported && Res.FirstPass != ~0u)
+            ResourcesByLastPass.push_back(i);
+    }
+    std::sort(ResourcesByLastPass.begin(), ResourcesByLastPass.end(),
+              [this](Uint32 lhs, Uint32 rhs) {
+                  return m_Resources[lhs].LastPass < m_Resources[rhs].LastPass;
+              });
+
+    m_Stats.NumTransientResources = static_cast<Uint32>(ResourcesByLastPass.size());
+
+    // Walk the passes in execution order. Objects of the resources that are no longer
+    // used are returned to the pool before the resources of the next pass are allocated,
+    // so that resources with non-overlapping lifetimes share the same object.
+    size_t NextToRelease = 0;
+    for (Uint32 pass = 0; pass < m_Passes.size(); ++pass)
+    {
+        for (; NextToRelease < ResourcesByLastPass.size(); ++NextToRelease)
+        {
+            const ResourceInfo& Res = m_Resources[ResourcesByLastPass[NextToRelease]];
+            if (Res.LastPass >= pass)
+                break;
+            if (Res.PoolIndex != ~0u)
+                m_Pool[Res.PoolIndex].InUse = false;
+        }
+
+        if (m_Passes[pass].IsCulled)
+            continue;
+
+        for (const ResourceAccess& Access : m_Passes[pass].Accesses)
+        {
+            ResourceInfo& Res = m_Resources[Access.ResIndex];
+            if (Res.IsImported || Res.FirstPass != pass)
+                continue;
+
+            Res.PoolIndex = AcquirePooledObject(Res);
+            if (Res.PoolIndex == ~0u)
+                continue;
+
+            PooledObject& Obj = m_Pool[Res.PoolIndex];
+            VERIFY_EXPR(!Obj.InUse);
+            Obj.InUse   = true;
+            Res.pObject = Obj.pObject;
+        }
+    }
+
+    std::vector<bool> IsObjectUsed(m_Pool.size());
+    for (const ResourceInfo& Res : m_Resources)
+    {
+        if (Res.PoolIndex != ~0u)
+            IsObjectUsed[Res.PoolIndex] = true;
+    }
+    m_Stats.NumTransientObjects = static_cast<Uint32>(std::count(IsObjectUsed.begin(), IsObjectUsed.end(), true));
+
+    // Keep all objects used by the graph reserved until the next compilation
+    for (Uint32 i = 0; i < m_Pool.size(); ++i)
+        m_Pool[i].InUse = IsObjectUsed[i];
+}
+
+void RenderGraph::PlanSplitBarriers()
+{
+    for (PassInfo& Pass : m_Passes)
+    {
+        Pass.BeginSplitBarriers.clear();
+        for (ResourceAccess& Access : Pass.Accesses)
+            Access.EndsSplitBarrier = false;
+    }
+    m_Stats.NumSplitBarriers = 0;
+
+    if (!m_SplitBarriersEnabled)
+        return;
+
+    // Replay the state changes performed by Execute() and find the transitions that are separated
+    // from the previous access to the resource by at least one pass.
+    std::vector<RESOURCE_STATE> States(m_Resources.size());
+    std::vector<Uint32>         LastAccessPass(m_Resources.size(), ~0u);
+    for (size_t i = 0; i < m_Resources.size(); ++i)
+        States[i] = m_Resources[i].IsImported ? m_Resources[i].InitialState : RESOURCE_STATE_UNKNOWN;
+
+    Uint32 PrevPass = ~0u;
+    for (Uint32 pass = 0; pass < m_Passes.size(); ++pass)
+    {
+        PassInfo& Pass = m_Passes[pass];
+        if (Pass.IsCulled)
+            continue;
+
+        for (ResourceAccess& Access : Pass.Accesses)
+        {
+            const Uint32         ResIndex     = Access.ResIndex;
+            const RESOURCE_STATE OldState     = States[ResIndex];
+            const Uint32         ProducerPass = LastAccessPass[ResIndex];
+
+            // Transitions can't be performed inside a render pass: begin-split barriers can only follow
+            // the last subpass, and end-split barriers can only precede the first one.
+            const bool ProducerInRenderPass =
+                ProducerPass != ~0u &&
+                m_Passes[ProducerPass].RenderPassIndex != ~0u &&
+                m_RenderPasses[m_Passes[ProducerPass].RenderPassIndex].LastPass != ProducerPass;
+            const bool ConsumerInRenderPass =
+                Pass.RenderPassIndex != ~0u &&
+                m_RenderPasses[Pass.RenderPassIndex].FirstPass != pass;
+
+            if (m_Resources[ResIndex].pObject &&
+                ProducerPass != ~0u && ProducerPass != PrevPass && ProducerPass != pass &&
+                !ProducerInRenderPass && !ConsumerInRenderPass &&
+                OldState != RESOURCE_STATE_UNKNOWN && OldState != Access.State)
+            {
+                m_Passes[ProducerPass].BeginSplitBarriers.push_back({ResIndex, OldState, Access.State});
+                Access.EndsSplitBarrier = true;
+                ++m_Stats.NumSplitBarriers;
+            }
+
+            States[ResIndex]         = Access.State;
+            LastAccessPass[ResIndex] = pass;
+        }
+
+        PrevPass = pass;
+    }
+}
+
+bool RenderGraph::CanMergePass(const MergedRenderPass& RP, Uint32 PassIndex) const
+{
+    const PassInfo& Pass = m_Passes[PassIndex];
+    VERIFY_EXPR(Pass.IsRasterPass());
+
+    // All attachments of the render pass must have the same size and sample count
+    const PassInfo& FirstPass = m_Passes[RP.FirstPass];
+
+    Uint32 RefIndex = FirstPass.DepthStencil.ResIndex;
+    for (Uint32 rt = 0; rt < FirstPass.NumRenderTargets && RefIndex == RenderGraphResource::InvalidIndex; ++rt)
+        RefIndex = FirstPass.RenderTargets[rt].ResIndex;
+    if (RefIndex == RenderGraphResource::InvalidIndex)
+        return false;
+    const TextureDesc* pRefDesc = &m_Resources[RefIndex].TexDesc;
+
+    auto IsCompatible = [&](const AttachmentInfo& Attachment) {
+        if (Attachment.ResIndex == RenderGraphResource::InvalidIndex)
+            return true;
+
+        const ResourceInfo& Res = m_Resources[Attachment.ResIndex];
+        return (Res.pObject &&
+                Res.TexDesc.Type == RESOURCE_DIM_TEX_2D &&
+                Res.TexDesc.Width == pRefDesc->Width &&
+                Res.TexDesc.Height == pRefDesc->Height &&
+                Res.TexDesc.SampleCount == pRefDesc->SampleCount);
+    };
+    for (Uint32 rt = 0; rt < Pass.NumRenderTargets; ++rt)
+    {
+        if (!IsCompatible(Pass.RenderTargets[rt]))
+            return false;
+    }
+    if (!IsCompatible(Pass.DepthStencil))
+        return false;
+
+    for (const ResourceAccess& Access : Pass.Accesses)
+    {
+        const bool IsAttachment = Pass.IsAttachment(Access.ResIndex);
+
+        bool UsedAsAttachment = false;
+        bool UsedAsInput      = false;
+        bool UsedOtherwise    = false;
+        bool IsSameAccess     = true;
+        for (Uint32 p = RP.FirstPass; p <= RP.LastPass; ++p)
+        {
+            const PassInfo& PrevPass = m_Passes[p];
+            if (PrevPass.IsCulled)
+                continue;
+
+            for (const ResourceAccess& PrevAccess : PrevPass.Accesses)
+            {
+                if (PrevAccess.ResIndex != Access.ResIndex)
+                    continue;
+
+                if (PrevPass.IsAttachment(Access.ResIndex))
+                    UsedAsAttachment = true;
+                else if (PrevAccess.IsInputAttachment && p != RP.FirstPass)
+                    UsedAsInput = true;
+                else
+                {
+                    UsedOtherwise = true;
+                    IsSameAccess  = IsSameAccess && !PrevAccess.IsWrite && PrevAccess.State == Access.State;
+                }
+            }
+        }
+
+        if (Access.IsInputAttachment)
+        {
+            // Framebuffer-local read of an attachment rendered by one of the previous subpasses
+            if (!UsedAsAttachment || UsedOtherwise)
+                return false;
+        }
+        else if (IsAttachment)
+        {
+            // Rendering to a texture that was read as an input attachment requires a feedback loop
+            if (UsedAsInput || UsedOtherwise)
+                return false;
+        }
+        else if (UsedAsAttachment || UsedAsInput || (UsedOtherwise && (!IsSameAccess || Access.IsWrite)))
+        {
+            // Other resources are transitioned before the render pass begins, so they must
+            // be accessed in the same state by all subpasses.
+            return false;
+        }
+    }
+
+    return true;
+}
+
+ITextureView* RenderGraph::GetAttachmentView(Uint32 ResIndex, TEXTURE_VIEW_TYPE ViewType)
+{
+    ResourceInfo& Res      = m_Resources[ResIndex];
+    ITexture*     pTexture = static_cast<ITexture*>(Res.pObject.RawPtr());
+    if (pTexture == nullptr)
+        return nullptr;
+
+    if (ViewType != TEXTURE_VIEW_READ_ONLY_DEPTH_STENCIL)
+        return pTexture->GetDefaultView(ViewType);
+
+    // There is no default read-only depth-stencil view
+    RefCntAutoPtr<ITextureView>& pView = Res.PoolIndex != ~0u ? m_Pool[Res.PoolIndex].pReadOnlyDSV : Res.pReadOnlyDSV;
+    if (!pView)
+    {
+        TextureViewDesc ViewDesc;
+        ViewDesc.Name     = "Render graph read-only DSV";
+        ViewDesc.ViewType = TEXTURE_VIEW_READ_ONLY_DEPTH_STENCIL;
+        pTexture->CreateView(ViewDesc, &pView);
+    }
+    return pView;
+}
+
+bool RenderGraph::CreateRenderPass(MergedRenderPass& RP)
+{
+    RP.Attachments.clear();
+    RP.ClearValues.clear();
+    RP.pRenderPass  = nullptr;
+    RP.pFramebuffer = nullptr;
+
+    std::vector<RenderPassAttachmentDesc> Attachments;
+    std::vector<SubpassDescX>             Subpasses;
+
+    // The first and the last subpass that use every attachment
+    std::vector<std::pair<Uint32, Uint32>> AttachmentUses;
+    std::vector<std::vector<bool>>         SubpassAttachments;
+
+    auto FindAttachment = [&](Uint32 ResIndex) {
+        auto it = std::find(RP.Attachments.begin(), RP.Attachments.end(), ResIndex);
+        return it != RP.Attachments.end() ? static_cast<Uint32>(it - RP.Attachments.begin()) : ATTACHMENT_UNUSED;
+    };
+
+    auto UseAttachment = [&](Uint32 AttachmentIndex, RESOURCE_STATE State) {
+        Attachments[AttachmentIndex].FinalState = State;
+
+        const Uint32 Subpass = static_cast<Uint32>(Subpasses.size());
+        AttachmentUses[AttachmentIndex].second = Subpass;
+        SubpassAttachments.back()[AttachmentIndex] = true;
+        return AttachmentReference{AttachmentIndex, State};
+    };
+
+    auto AddAttachment = [&](const AttachmentInfo& Info, RESOURCE_STATE State) {
+        Uint32 AttachmentIndex = FindAttachment(Info.ResIndex);
+        if (AttachmentIndex == ATTACHMENT_UNUSED)
+        {
+            const ResourceInfo& Res = m_Resources[Info.ResIndex];
+
+            RenderPassAttachmentDesc Attachment;
+            Attachment.Format      = Res.TexDesc.Format;
+            Attachment.SampleCount = static_cast<Uint8>(Res.TexDesc.SampleCount);
+            Attachment.LoadOp      = Info.LoadOp;
+            // Contents that are not used after the render pass never leave the tile memory
+            Attachment.StoreOp = (Res.IsImported || Res.LastPass > RP.LastPass) ? ATTACHMENT_STORE_OP_STORE : ATTACHMENT_STORE_OP_DISCARD;
+            if (GetTextureFormatAttribs(Res.TexDesc.Format).ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+            {
+                Attachment.StencilLoadOp  = Attachment.LoadOp;
+                Attachment.StencilStoreOp = Attachment.StoreOp;
+            }
+            else
+            {
+                Attachment.StencilLoadOp  = ATTACHMENT_LOAD_OP_DISCARD;
+                Attachment.StencilStoreOp = ATTACHMENT_STORE_OP_DISCARD;
+            }
+            Attachment.InitialState = State;
+
+            AttachmentIndex = static_cast<Uint32>(Attachments.size());
+            Attachments.push_back(Attachment);
+            RP.Attachments.push_back(Info.ResIndex);
+            RP.ClearValues.push_back(Info.ClearValue);
+
+            const Uint32 Subpass = static_cast<Uint32>(Subpasses.size());
+            AttachmentUses.emplace_back(Subpass, Subpass);
+            for (std::vector<bool>& Used : SubpassAttachments)
+                Used.push_back(false);
+        }
+        return UseAttachment(AttachmentIndex, State);
+    };
+
+    for (Uint32 p = RP.FirstPass; p <= RP.LastPass; ++p)
+    {
+        const PassInfo& Pass = m_Passes[p];
+        if (Pass.IsCulled)
+            continue;
+
+        SubpassAttachments.emplace_back(Attachments.size(), false);
+
+        SubpassDescX Subpass;
+        for (Uint32 rt = 0; rt < Pass.NumRenderTargets; ++rt)
+        {
+            if (Pass.RenderTargets[rt].ResIndex != RenderGraphResource::InvalidIndex)
+                Subpass.AddRenderTarget(AddAttachment(Pass.RenderTargets[rt], RESOURCE_STATE_RENDER_TARGET));
+            else
+                Subpass.AddRenderTarget(AttachmentReference{ATTACHMENT_UNUSED, RESOURCE_STATE_RENDER_TARGET});
+        }
+        if (Pass.DepthStencil.ResIndex != RenderGraphResource::InvalidIndex)
+            Subpass.SetDepthStencil(AddAttachment(Pass.DepthStencil, Pass.ReadOnlyDepth ? RESOURCE_STATE_DEPTH_READ : RESOURCE_STATE_DEPTH_WRITE));
+
+        if (p != RP.FirstPass)
+        {
+            for (const ResourceAccess& Access : Pass.Accesses)
+            {
+                if (!Access.IsInputAttachment)
+                    continue;
+
+                const Uint32 AttachmentIndex = FindAttachment(Access.ResIndex);
+                VERIFY(AttachmentIndex != ATTACHMENT_UNUSED, "Input attachment must be rendered by one of the previous subpasses. This should've been checked by CanMergePass().");
+                Subpass.AddInput(UseAttachment(AttachmentIndex, RESOURCE_STATE_INPUT_ATTACHMENT));
+            }
+        }
+
+        Subpasses.emplace_back(std::move(Subpass));
+    }
+    VERIFY_EXPR(Subpasses.size() > 1);
+
+    // The contents of the attachments that are not used by a subpass must be preserved
+    // when the attachments are used by earlier and later subpasses.
+    for (Uint32 i = 0; i < Attachments.size(); ++i)
+    {
+        for (Uint32 subpass = AttachmentUses[i].first + 1; subpass < AttachmentUses[i].second; ++subpass)
+        {
+            if (!SubpassAttachments[subpass][i])
+                Subpasses[subpass].AddPreserve(i);
+        }
+    }
+
+    RenderPassDescX Desc;
+    for (const RenderPassAttachmentDesc& Attachment : Attachments)
+        Desc.AddAttachment(Attachment);
+    for (const SubpassDescX& Subpass : Subpasses)
+        Desc.AddSubpass(Subpass);
+    for (Uint32 subpass = 1; subpass < Subpasses.size(); ++subpass)
+    {
+        // Attachment writes of the previous subpass must be visible to the input attachment
+        // reads and attachment accesses of the next subpass.
+        SubpassDependencyDesc Dependency;
+        Dependency.SrcSubpass    = subpass - 1;
+        Dependency.DstSubpass    = subpass;
+        Dependency.SrcStageMask  = PIPELINE_STAGE_FLAG_RENDER_TARGET | PIPELINE_STAGE_FLAG_EARLY_FRAGMENT_TESTS | PIPELINE_STAGE_FLAG_LATE_FRAGMENT_TESTS;
+        Dependency.DstStageMask  = PIPELINE_STAGE_FLAG_PIXEL_SHADER | PIPELINE_STAGE_FLAG_RENDER_TARGET | PIPELINE_STAGE_FLAG_EARLY_FRAGMENT_TESTS | PIPELINE_STAGE_FLAG_LATE_FRAGMENT_TESTS;
+        Dependency.SrcAccessMask = ACCESS_FLAG_RENDER_TARGET_WRITE | ACCESS_FLAG_DEPTH_STENCIL_WRITE;
+        Dependency.DstAccessMask = ACCESS_FLAG_INPUT_ATTACHMENT_READ | ACCESS_FLAG_RENDER_TARGET_READ | ACCESS_FLAG_RENDER_TARGET_WRITE |
+            ACCESS_FLAG_DEPTH_STENCIL_READ | ACCESS_FLAG_DEPTH_STENCIL_WRITE;
+        Desc.AddDependency(Dependency);
+    }
+
+    // Render passes are kept in the cache so that the pipelines created for them remain valid
+    CachedRenderPass* pCachedRP = nullptr;
+    for (CachedRenderPass& CachedRP : m_RenderPassCache)
+    {
+        if (CachedRP.Desc == Desc)
+        {
+            pCachedRP = &CachedRP;
+            break;
+        }
+    }
+    if (pCachedRP == nullptr)
+    {
+        RenderPassDesc RPDesc = Desc;
+        RPDesc.Name           = "Render graph merged pass";
+
+        RefCntAutoPtr<IRenderPass> pRenderPass;
+        m_pDevice->CreateRenderPass(RPDesc, &pRenderPass);
+        if (!pRenderPass)
+        {
+            LOG_ERROR_MESSAGE("Failed to create render pass for merged passes '", m_Passes[RP.FirstPass].Name, "' - '", m_Passes[RP.LastPass].Name, "'");
+            return false;
+        }
+
+        CachedRenderPass CachedRP;
+        CachedRP.Subpasses   = std::move(Subpasses);
+        CachedRP.Desc        = std::move(Desc);
+        CachedRP.pRenderPass = std::move(pRenderPass);
+        m_RenderPassCache.emplace_back(std::move(CachedRP));
+        pCachedRP = &m_RenderPassCache.back();
+    }
+    pCachedRP->InUse = true;
+    RP.pRenderPass   = pCachedRP->pRenderPass;
+
+    std::vector<ITextureView*> Views(RP.Attachments.size());
+    for (size_t i = 0; i < RP.Attachments.size(); ++i)
+    {
+        const bool IsDepth = GetTextureFormatAttribs(Attachments[i].Format).IsDepthStencil();
+        Views[i]           = GetAttachmentView(RP.Attachments[i], IsDepth ? TEXTURE_VIEW_DEPTH_STENCIL : TEXTURE_VIEW_RENDER_TARGET);
+        if (Views[i] == nullptr)
+            return false;
+    }
+
+    CachedFramebuffer* pCachedFB = nullptr;
+    for (CachedFramebuffer& CachedFB : m_FramebufferCache)
+    {
+        if (CachedFB.pRenderPass == RP.pRenderPass && CachedFB.Attachments == Views)
+        {
+            pCachedFB = &CachedFB;
+            break;
+        }
+    }
+    if (pCachedFB == nullptr)
+    {
+        const TextureDesc& TexDesc = m_Resources[RP.Attachments[0]].TexDesc;
+
+        FramebufferDesc FBDesc;
+        FBDesc.Name            = "Render graph framebuffer";
+        FBDesc.pRenderPass     = RP.pRenderPass;
+        FBDesc.AttachmentCount = static_cast<Uint32>(Views.size());
+        FBDesc.ppAttachments   = Views.data();
+        FBDesc.Width           = TexDesc.Width;
+        FBDesc.Height          = TexDesc.Height;
+        FBDesc.NumArraySlices  = 1;
+
+        RefCntAutoPtr<IFramebuffer> pFramebuffer;
+        m_pDevice->CreateFramebuffer(FBDesc, &pFramebuffer);
+        if (!pFramebuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to create framebuffer for merged passes '", m_Passes[RP.FirstPass].Name, "' - '", m_Passes[RP.LastPass].Name, "'");
+            return false;
+        }
+
+        CachedFramebuffer CachedFB;
+        CachedFB.pRenderPass  = RP.pRenderPass;
+        CachedFB.Attachments  = std::move(Views);
+        CachedFB.pFramebuffer = std::move(pFramebuffer);
+        m_FramebufferCache.emplace_back(std::move(CachedFB));
+        pCachedFB = &m_FramebufferCache.back();
+    }
+    pCachedFB->InUse = true;
+    RP.pFramebuffer  = pCachedFB->pFramebuffer;
+
+    return true;
+}
+
+void RenderGraph::MergeRasterPasses()
+{
+    m_RenderPasses.clear();
+    for (PassInfo& Pass : m_Passes)
+    {
+        Pass.RenderPassIndex = ~0u;
+        Pass.SubpassIndex    = 0;
+    }
+    for (CachedRenderPass& CachedRP : m_RenderPassCache)
+        CachedRP.InUse = false;
+    for (CachedFramebuffer& CachedFB : m_FramebufferCache)
+        CachedFB.InUse = false;
+
+    m_Stats.NumRenderPasses = 0;
+    m_Stats.NumMergedPasses = 0;
+
+    if (m_SubpassMergingEnabled)
+    {
+        MergedRenderPass RP;
+        Uint32           NumSubpasses = 0;
+
+        auto FinishRenderPass = [&]() {
+            if (NumSubpasses > 1 && CreateRenderPass(RP))
+            {
+                const Uint32 RenderPassIndex = static_cast<Uint32>(m_RenderPasses.size());
+
+                Uint32 Subpass = 0;
+                for (Uint32 p = RP.FirstPass; p <= RP.LastPass; ++p)
+                {
+                    PassInfo& Pass = m_Passes[p];
+                    if (Pass.IsCulled)
+                        continue;
+                    Pass.RenderPassIndex = RenderPassIndex;
+                    Pass.SubpassIndex    = Subpass++;
+                }
+                m_RenderPasses.emplace_back(std::move(RP));
+
+                ++m_Stats.NumRenderPasses;
+                m_Stats.NumMergedPasses += NumSubpasses;
+            }
+            RP           = {};
+            NumSubpasses = 0;
+        };
+
+        for (Uint32 pass = 0; pass < m_Passes.size(); ++pass)
+        {
+            const PassInfo& Pass = m_Passes[pass];
+            if (Pass.IsCulled)
+                continue;
+
+            if (!Pass.IsRasterPass())
+            {
+                FinishRenderPass();
+                continue;
+            }
+
+            if (NumSubpasses == 0 || !CanMergePass(RP, pass))
+            {
+                FinishRenderPass();
+                RP.FirstPass = pass;
+            }
+            RP.LastPass = pass;
+            ++NumSubpasses;
+        }
+        FinishRenderPass();
+    }
+
+    // Input attachments of the passes that are not merged with the pass that renders them are read as shader resources
+    for (PassInfo& Pass : m_Passes)
+    {
+        const bool IsSubpass = Pass.RenderPassIndex != ~0u && Pass.SubpassIndex > 0;
+        for (ResourceAccess& Access : Pass.Accesses)
+        {
+            if (Access.IsInputAttachment)
+                Access.State = IsSubpass ? RESOURCE_STATE_INPUT_ATTACHMENT : RESOURCE_STATE_SHADER_RESOURCE;
+        }
+    }
+}
+
+void RenderGraph::Compile()
+{
+    m_Stats.NumPasses = static_cast<Uint32>(m_Passes.size());
+
+    CullPasses();
+    CalculateLifetimes();
+    AllocateTransientResources();
+    MergeRasterPasses();
+    PlanSplitBarriers();
+
+    m_IsCompiled = true;
+}
+
+void RenderGraph::AddPassBarriers(Uint32 PassIndex, std::vector<bool>* pInRenderPass)
+{
+    const PassInfo& Pass = m_Passes[PassIndex];
+    for (const ResourceAccess& Access : Pass.Accesses)
+    {
+        ResourceInfo& Res = m_Resources[Access.ResIndex];
+        if (!Res.pObject)
+            continue;
+
+        if (pInRenderPass != nullptr)
+        {
+            // Resources are transitioned before the render pass begins. Transitions of the attachments
+            // between subpasses are performed by the render pass.
+            if ((*pInRenderPass)[Access.ResIndex])
+            {
+                Res.State = Access.State;
+                continue;
+            }
+            (*pInRenderPass)[Access.ResIndex] = true;
+        }
+
+        // Subsequent UAV accesses require a barrier even though the state does not change
+        const bool NeedBarrier =
+            Res.State == RESOURCE_STATE_UNKNOWN ||
+            Res.State != Access.State ||
+            Access.State == RESOURCE_STATE_UNORDERED_ACCESS;
+        if (NeedBarrier)
+        {
+            STATE_TRANSITION_FLAGS Flags = STATE_TRANSITION_FLAG_UPDATE_STATE;
+            if (!Res.IsImported && Res.FirstPass == PassIndex && Access.IsWrite)
+                Flags |= STATE_TRANSITION_FLAG_DISCARD_CONTENT;
+
+            if (Res.Type == ResourceType::Texture)
+                m_Barriers.emplace_back(static_cast<ITexture*>(Res.pObject.RawPtr()), Res.State, Access.State, Flags);
+            else
+                m_Barriers.emplace_back(static_cast<IBuffer*>(Res.pObject.RawPtr()), Res.State, Access.State, Flags);
+            if (Access.EndsSplitBarrier)
+                m_Barriers.back().TransitionType = STATE_TRANSITION_TYPE_END;
+        }
+        Res.State = Access.State;
+    }
+}
+
+void RenderGraph::SetPassRenderTargets(IDeviceContext* pContext, const PassInfo& Pass)
+{
+    ITextureView* pRTVs[MAX_RENDER_TARGETS] = {};
+    ITextureView* pDSV                      = nullptr;
+
+    // Previous contents are not needed when all render targets are cleared or discarded
+    bool DiscardRenderTargets = Pass.NumRenderTargets > 0;
+    for (Uint32 rt = 0; rt < Pass.NumRenderTargets; ++rt)
+    {
+        const AttachmentInfo& RT = Pass.RenderTargets[rt];
+        if (RT.ResIndex == RenderGraphResource::InvalidIndex)
+            continue;
+
+        pRTVs[rt] = GetAttachmentView(RT.ResIndex, TEXTURE_VIEW_RENDER_TARGET);
+        if (RT.LoadOp == ATTACHMENT_LOAD_OP_LOAD)
+            DiscardRenderTargets = false;
+    }
+    if (Pass.DepthStencil.ResIndex != RenderGraphResource::InvalidIndex)
+        pDSV = GetAttachmentView(Pass.DepthStencil.ResIndex, Pass.ReadOnlyDepth ? TEXTURE_VIEW_READ_ONLY_DEPTH_STENCIL : TEXTURE_VIEW_DEPTH_STENCIL);
+
+    SetRenderTargetsAttribs Attribs;
+    Attribs.NumRenderTargets    = Pass.NumRenderTargets;
+    Attribs.ppRenderTargets     = pRTVs;
+    Attribs.pDepthStencil       = pDSV;
+    Attribs.StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+    if (DiscardRenderTargets)
+        Attribs.Flags |= SET_RENDER_TARGETS_FLAG_DISCARD_RENDER_TARGETS;
+    if (pDSV != nullptr && Pass.DepthStencil.LoadOp != ATTACHMENT_LOAD_OP_LOAD)
+        Attribs.Flags |= SET_RENDER_TARGETS_FLAG_DISCARD_DEPTH_STENCIL;
+    pContext->SetRenderTargetsExt(Attribs);
+
+    for (Uint32 rt = 0; rt < Pass.NumRenderTargets; ++rt)
+    {
+        if (pRTVs[rt] != nullptr && Pass.RenderTargets[rt].LoadOp == ATTACHMENT_LOAD_OP_CLEAR)
+            pContext->ClearRenderTarget(pRTVs[rt], Pass.RenderTargets[rt].ClearValue.Color, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    }
+    if (pDSV != nullptr && Pass.DepthStencil.LoadOp == ATTACHMENT_LOAD_OP_CLEAR)
+    {
+        const OptimizedClearValue& ClearValue = Pass.DepthStencil.ClearValue;
+
+        CLEAR_DEPTH_STENCIL_FLAGS ClearFlags = CLEAR_DEPTH_FLAG;
+        if (GetTextureFormatAttribs(pDSV->GetDesc().Format).ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+            ClearFlags |= CLEAR_STENCIL_FLAG;
+        pContext->ClearDepthStencil(pDSV, ClearFlags, ClearValue.DepthStencil.Depth, ClearValue.DepthStencil.Stencil, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    }
+}
+
+void RenderGraph::Execute(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    if (!m_IsCompiled)
+        Compile();
+
+    for (ResourceInfo& Res : m_Resources)
+    {
+        // RESOURCE_STATE_UNKNOWN makes the engine use the state it tracks
+        Res.State = Res.IsImported ? Res.InitialState : RESOURCE_STATE_UNKNOWN;
+    }
+
+    m_Stats.NumTransitions = 0;
+    for (Uint32 pass = 0; pass < m_Passes.size(); ++pass)
+    {
+        const PassInfo& Pass = m_Passes[pass];
+        if (Pass.IsCulled)
+            continue;
+
+        ScopedDebugGroup DebugGroup{pContext, Pass.Name};
+
+        MergedRenderPass* pRenderPass = Pass.RenderPassIndex != ~0u ? &m_RenderPasses[Pass.RenderPassIndex] : nullptr;
+        if (pRenderPass == nullptr || pRenderPass->FirstPass == pass)
+        {
+            m_Barriers.clear();
+            if (pRenderPass != nullptr)
+            {
+                // Transitions are not allowed inside the render pass, so the resources
+                // of all subpasses are transitioned before it begins.
+                std::vector<bool> InRenderPass(m_Resources.size());
+                for (Uint32 p = pRenderPass->FirstPass; p <= pRenderPass->LastPass; ++p)
+                {
+                    if (!m_Passes[p].IsCulled)
+                        AddPassBarriers(p, &InRenderPass);
+                }
+            }
+            else
+            {
+                AddPassBarriers(pass, nullptr);
+            }
+
+            if (!m_Barriers.empty())
+            {
+                pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+                m_Stats.NumTransitions += static_cast<Uint32>(m_Barriers.size());
+            }
+        }
+
+        if (pRenderPass != nullptr)
+        {
+            if (pRenderPass->FirstPass == pass)
+            {
+                BeginRenderPassAttribs Attribs;
+                Attribs.pRenderPass     = pRenderPass->pRenderPass;
+                Attribs.pFramebuffer    = pRenderPass->pFramebuffer;
+                Attribs.ClearValueCount = static_cast<Uint32>(pRenderPass->ClearValues.size());
+                Attribs.pClearValues    = pRenderPass->ClearValues.data();
+                // The attachments are already in their initial states. The transition mode
+                // makes the engine update the states at every subpass.
+                Attribs.StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+                pContext->BeginRenderPass(Attribs);
+            }
+            else
+            {
+                pContext->NextSubpass();
+            }
+        }
+        else if (Pass.IsRasterPass())
+        {
+            SetPassRenderTargets(pContext, Pass);
+        }
+
+        if (Pass.Execute)
+        {
+            m_CurrentPass = pass;
+            Pass.Execute(RenderGraphContext{*this, pContext, pRenderPass != nullptr ? pRenderPass->pRenderPass : nullptr, Pass.SubpassIndex});
+            m_CurrentPass = ~0u;
+        }
+
+        if (pRenderPass != nullptr && pRenderPass->LastPass == pass)
+            pContext->EndRenderPass();
+
+        if (!Pass.BeginSplitBarriers.empty())
+        {
+            m_Barriers.clear();
+            for (const SplitBarrier& Split : Pass.BeginSplitBarriers)
+            {
+                const ResourceInfo& Res = m_Resources[Split.ResIndex];
+                // The state is updated by the end-split barrier
+                if (Res.Type == ResourceType::Texture)
+                    m_Barriers.emplace_back(static_cast<ITexture*>(Res.pObject.RawPtr()), Split.OldState, Split.NewState, STATE_TRANSITION_FLAG_NONE);
+                else
+                    m_Barriers.emplace_back(static_cast<IBuffer*>(Res.pObject.RawPtr()), Split.OldState, Split.NewState, STATE_TRANSITION_FLAG_NONE);
+                m_Barriers.back().TransitionType = STATE_TRANSITION_TYPE_BEGIN;
+            }
+            pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+        }
+    }
+
+    m_Barriers.clear();
+    for (const ResourceInfo& Res : m_Resources)
+    {
+        if (!Res.IsImported || Res.FinalState == RESOURCE_STATE_UNKNOWN || Res.State == Res.FinalState)
+            continue;
+
+        if (Res.Type == ResourceType::Texture)
+            m_Barriers.emplace_back(static_cast<ITexture*>(Res.pObject.RawPtr()), Res.State, Res.FinalState, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        else
+            m_Barriers.emplace_back(static_cast<IBuffer*>(Res.pObject.RawPtr()), Res.State, Res.FinalState, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    }
+    if (!m_Barriers.empty())
+    {
+        pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+        m_Stats.NumTransitions += static_cast<Uint32>(m_Barriers.size());
+    }
+}
+
+void RenderGraph::Reset()
+{
+    m_Passes.clear();
+    m_Resources.clear();
+    m_RenderPasses.clear();
+    for (PooledObject& Obj : m_Pool)
+        Obj.InUse = false;
+
+    m_Stats      = {};
+    m_IsCompiled = false;
+}
+
+void RenderGraph::ReleaseTransientResources()
+{
+    // Framebuffers keep references to the views of the pooled textures
+    m_FramebufferCache.erase(std::remove_if(m_FramebufferCache.begin(), m_FramebufferCache.end(),
+                                            [](const CachedFramebuffer& FB) { return !FB.InUse; }),
+                             m_FramebufferCache.end());
+    m_RenderPassCache.erase(std::remove_if(m_RenderPassCache.begin(), m_RenderPassCache.end(),
+                                           [](const CachedRenderPass& RP) { return !RP.InUse; }),
+                            m_RenderPassCache.end());
+
+    m_Pool.erase(std::remove_if(m_Pool.begin(), m_Pool.end(),
+                                [](const PooledObject& Obj) { return !Obj.InUse; }),
+                 m_Pool.end());
+
+    // Pool indices have changed
+    for (ResourceInfo& Res : m_Resources)
+    {
+        if (Res.PoolIndex == ~0u)
+            continue;
+
+        Res.PoolIndex = ~0u;
+        for (Uint32 i = 0; i < m_Pool.size(); ++i)
+        {
+            if (m_Pool[i].pObject == Res.pObject)
+            {
+                Res.PoolIndex = i;
+                break;
+            }
+        }
+    }
+}
+
+bool RenderGraph::IsPassCulled(Uint32 PassIndex) const
+{
+    DEV_CHECK_ERR(PassIndex < m_Passes.size(), "Pass index (", PassIndex, ") is out of range");
+    return PassIndex < m_Passes.size() ? m_Passes[PassIndex].IsCulled : false;
+}
+
+IDeviceObject* RenderGraph::GetResourceObject(RenderGraphResource Res, ResourceType Type) const
+{
+    if (!Res.IsValid() || Res.Index >= m_Resources.size())
+    {
+        DEV_ERROR("Invalid render graph resource");
+        return nullptr;
+    }
+
+    const ResourceInfo& ResInfo = m_Resources[Res.Index];
+    DEV_CHECK_ERR(ResInfo.Type == Type, "Resource '", ResInfo.Name, "' is not a ", (Type == ResourceType::Texture ? "texture" : "buffer"));
+#ifdef DILIGENT_DEVELOPMENT
+    if (m_CurrentPass < m_Passes.size())
+    {
+        const std::vector<ResourceAccess>& Accesses = m_Passes[m_CurrentPass].Accesses;
+        DEV_CHECK_ERR(std::any_of(Accesses.begin(), Accesses.end(), [&Res](const ResourceAccess& Access) { return Access.ResIndex == Res.Index; }),
+                      "Resource '", ResInfo.Name, "' is not declared by pass '", m_Passes[m_CurrentPass].Name, "'");
+    }
+#endif
+    return ResInfo.Type == Type ? ResInfo.pObject.RawPtr() : nullptr;
+}
+
+} // namespace Diligent
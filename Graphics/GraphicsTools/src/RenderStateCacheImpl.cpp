@@ -32,9 +32,11 @@
 #include "ReloadablePipelineState.hpp"
 #include "AsyncPipelineState.hpp"
 
+#include <algorithm>
 #include <array>
 #include <mutex>
 #include <vector>
+#include <unordered_set>
 
 #include "Archiver.h"
 #include "Dearchiver.h"
@@ -49,22 +51,79 @@
 #include "GraphicsAccessories.hpp"
 #include "GraphicsUtilities.h"
 #include "ShaderSourceFactoryUtils.hpp"
+#include "DataBlobImpl.hpp"
+#include "ProxyDataBlob.hpp"
+#include "ThreadPool.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "BasicFileSystem.hpp"
+#include "Align.hpp"
 
 namespace Diligent
 {
 
-Bool RenderStateCacheImpl::WriteToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
+#define RENDER_STATE_CACHE_LOG(Level, ...)                         \
+    do                                                             \
+    {                                                              \
+        if (m_CI.LogLevel >= Level)                                \
+        {                                                          \
+            LOG_INFO_MESSAGE("Render state cache: ", __VA_ARGS__); \
+        }                                                          \
+    } while (false)
+
+namespace
 {
-    if (ContentVersion == ~0u)
-    {
-        ContentVersion = GetContentVersion();
-        if (ContentVersion == ~0u)
-            ContentVersion = 0;
-    }
 
-    // Load new render states from archiver to dearchiver
+// Journal record header. Every record contains a complete archive with
+// the render states that were added since the previous record.
+struct JournalRecordHeader
+{
+    static constexpr Uint32 MagicNumber = 0x4A435352; // 'RSCJ'
+    static constexpr Uint32 Alignment   = 16;
 
-    RefCntAutoPtr<IDataBlob> pNewData;
+    Uint32 Magic   = MagicNumber;
+    Uint32 Padding = 0;
+
+    // The size of the archive data that follows the header
+    Uint64 DataSize = 0;
+};
+static_assert(sizeof(JournalRecordHeader) % JournalRecordHeader::Alignment == 0, "Record data must be aligned");
+
+// Pre-warm manifest header. The header is followed by NumEntries entries
+// sorted by the first-use time. Every entry is followed by the pipeline name.
+struct UsageManifestHeader
+{
+    static constexpr Uint32 MagicNumber = 0x4D435352; // 'RSCM'
+    static constexpr Uint32 Version     = 1;
+
+    Uint32 Magic         = MagicNumber;
+    Uint32 FormatVersion = Version;
+    Uint32 NumEntries    = 0;
+    Uint32 Padding       = 0;
+};
+
+struct UsageManifestEntry
+{
+    static constexpr Uint32 NullName = ~0u;
+
+    // Hash of the pipeline state create info
+    Uint64 HashLow  = 0;
+    Uint64 HashHigh = 0;
+
+    // Time of the first request, in milliseconds
+    Uint32 FirstUseTime = 0;
+
+    // Length of the pipeline name that follows the entry, or NullName if the pipeline has no name
+    Uint32 NameLength = NullName;
+
+    Uint8 PipelineType = PIPELINE_TYPE_INVALID;
+    Uint8 Padding[7]   = {};
+};
+static_assert(sizeof(UsageManifestEntry) == 32, "Unexpected manifest entry size");
+
+} // namespace
+
+bool RenderStateCacheImpl::SerializeNewStates(Uint32 ContentVersion, RefCntAutoPtr<IDataBlob>& pNewData)
+{
     m_pArchiver->SerializeToBlob(ContentVersion, &pNewData);
     if (!pNewData)
     {
@@ -72,6 +131,7 @@ Bool RenderStateCacheImpl::WriteToBlob(Uint32 ContentVersion, IDataBlob** ppBlob
         return false;
     }
 
+    // Load new render states from archiver to dearchiver
     if (!m_pDearchiver->LoadArchive(pNewData, ContentVersion))
     {
         LOG_ERROR_MESSAGE("Failed to add new render state data to existing archive");
@@ -79,10 +139,148 @@ Bool RenderStateCacheImpl::WriteToBlob(Uint32 ContentVersion, IDataBlob** ppBlob
     }
 
     m_pArchiver->Reset();
+    m_NumNewStates.store(0);
+
+    return true;
+}
+
+Bool RenderStateCacheImpl::WriteToBlob(Uint32 ContentVersion, IDataBlob** ppBlob)
+{
+    if (ContentVersion == ~0u)
+    {
+        ContentVersion = GetContentVersion();
+        if (ContentVersion == ~0u)
+            ContentVersion = 0;
+    }
+
+    RefCntAutoPtr<IDataBlob> pNewData;
+    if (!SerializeNewStates(ContentVersion, pNewData))
+        return false;
 
     return m_pDearchiver->Store(ppBlob);
 }
 
+Bool RenderStateCacheImpl::AppendToJournal(Uint32 ContentVersion, IFileStream* pJournal, IThreadPool* pThreadPool)
+{
+    DEV_CHECK_ERR(pJournal != nullptr, "pJournal must not be null");
+    if (pJournal == nullptr)
+        return false;
+
+    if (m_NumNewStates.load() == 0)
+        return true;
+
+    if (ContentVersion == ~0u)
+    {
+        ContentVersion = GetContentVersion();
+        if (ContentVersion == ~0u)
+            ContentVersion = 0;
+    }
+
+    // Only the render states added since the last write are serialized.
+    RefCntAutoPtr<IDataBlob> pNewData;
+    if (!SerializeNewStates(ContentVersion, pNewData))
+        return false;
+
+    JournalRecordHeader Header;
+    Header.DataSize = pNewData->GetSize();
+
+    const size_t RecordSize = AlignUp(sizeof(Header) + pNewData->GetSize(), size_t{JournalRecordHeader::Alignment});
+
+    RefCntAutoPtr<DataBlobImpl> pRecord = DataBlobImpl::Create(RecordSize);
+    memset(pRecord->GetDataPtr(), 0, RecordSize);
+    memcpy(pRecord->GetDataPtr(), &Header, sizeof(Header));
+    memcpy(pRecord->GetDataPtr(sizeof(Header)), pNewData->GetConstDataPtr(), pNewData->GetSize());
+
+    auto WriteRecord = [pJournalStream = RefCntAutoPtr<IFileStream>{pJournal}, pRecord]() {
+        pJournalStream->SetPos(0, static_cast<int>(FilePosOrigin::End));
+        if (!pJournalStream->Write(pRecord->GetConstDataPtr(), pRecord->GetSize()))
+        {
+            LOG_ERROR_MESSAGE("Failed to write render state cache journal record");
+            return false;
+        }
+        return true;
+    };
+
+    if (pThreadPool != nullptr)
+    {
+        // Make the new task depend on the previous one to keep the records in order
+        IAsyncTask* pPrevTask = m_pJournalTask;
+        m_pJournalTask        = EnqueueAsyncWork(pThreadPool, pPrevTask != nullptr ? &pPrevTask : nullptr, pPrevTask != nullptr ? 1 : 0,
+                                                 [WriteRecord](Uint32 ThreadId) {
+                                              WriteRecord();
+                                              return ASYNC_TASK_STATUS_COMPLETE;
+                                          });
+        return true;
+    }
+    else
+    {
+        // Wait for the records that are being written in the background
+        WaitForJournal();
+        return WriteRecord();
+    }
+}
+
+Bool RenderStateCacheImpl::LoadJournal(const IDataBlob* pJournal, Uint32 ContentVersion, Bool MakeCopy)
+{
+    DEV_CHECK_ERR(pJournal != nullptr, "pJournal must not be null");
+    if (pJournal == nullptr)
+        return false;
+
+    const size_t JournalSize = pJournal->GetSize();
+    if (JournalSize == 0)
+        return true;
+
+    const Uint8* pJournalData = static_cast<const Uint8*>(pJournal->GetConstDataPtr());
+
+    bool   AllLoaded  = true;
+    Uint32 NumRecords = 0;
+    for (size_t Offset = 0; Offset + sizeof(JournalRecordHeader) <= JournalSize;)
+    {
+        JournalRecordHeader Header;
+        memcpy(&Header, pJournalData + Offset, sizeof(Header));
+        if (Header.Magic != JournalRecordHeader::MagicNumber)
+        {
+            LOG_ERROR_MESSAGE("Render state cache journal is corrupted: invalid record header at offset ", Offset);
+            return false;
+        }
+
+        const size_t DataOffset = Offset + sizeof(Header);
+        if (Header.DataSize > JournalSize - DataOffset)
+        {
+            LOG_WARNING_MESSAGE("Ignoring incomplete render state cache journal record at offset ", Offset,
+                                ". This may happen if the application was terminated while the record was being written.");
+            break;
+        }
+
+        // The proxy blob keeps the journal blob alive when the data is not copied
+        RefCntAutoPtr<ProxyDataBlob> pRecordData = ProxyDataBlob::Create(pJournalData + DataOffset, StaticCast<size_t>(Header.DataSize), const_cast<IDataBlob*>(pJournal));
+        if (m_pDearchiver->LoadArchive(pRecordData, ContentVersion, MakeCopy))
+        {
+            ++NumRecords;
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE("Failed to load render state cache journal record at offset ", Offset);
+            AllLoaded = false;
+        }
+
+        Offset = AlignUp(DataOffset + StaticCast<size_t>(Header.DataSize), size_t{JournalRecordHeader::Alignment});
+    }
+
+    RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Loaded ", NumRecords, " journal record(s).");
+
+    return AllLoaded;
+}
+
+void RenderStateCacheImpl::WaitForJournal()
+{
+    if (m_pJournalTask)
+    {
+        m_pJournalTask->WaitForCompletion();
+        m_pJournalTask.Release();
+    }
+}
+
 Bool RenderStateCacheImpl::WriteToStream(Uint32 ContentVersion, IFileStream* pStream)
 {
     DEV_CHECK_ERR(pStream != nullptr, "pStream must not be null");
@@ -96,14 +294,212 @@ Bool RenderStateCacheImpl::WriteToStream(Uint32 ContentVersion, IFileStream* pSt
     return pStream->Write(pDataBlob->GetConstDataPtr(), pDataBlob->GetSize());
 }
 
+void RenderStateCacheImpl::RecordPipelineUsage(const PipelineStateDesc& PSODesc, const XXH128Hash& Hash)
+{
+    std::lock_guard<std::mutex> Guard{m_PipelineUsageMtx};
+
+    auto it_inserted = m_PipelineUsage.emplace(Hash, PipelineUsageInfo{});
+    if (!it_inserted.second)
+        return;
+
+    PipelineUsageInfo& Usage = it_inserted.first->second;
+    Usage.PipelineType       = PSODesc.PipelineType;
+    Usage.HasName            = PSODesc.Name != nullptr;
+    Usage.Name               = PSODesc.Name != nullptr ? PSODesc.Name : "";
+    Usage.FirstUseTime       = static_cast<Uint32>(m_UsageTimer.GetElapsedTime() * 1000.0);
+}
+
+Bool RenderStateCacheImpl::WriteUsageManifest(IDataBlob** ppManifest)
+{
+    DEV_CHECK_ERR(ppManifest != nullptr, "ppManifest must not be null");
+    if (ppManifest == nullptr)
+        return false;
+    DEV_CHECK_ERR(*ppManifest == nullptr, "Overwriting reference to existing data blob may cause memory leaks");
+
+    if (!m_CI.RecordUsage)
+        LOG_WARNING_MESSAGE("Pipeline usage is not recorded. Set RenderStateCacheCreateInfo::RecordUsage to true to enable recording.");
+
+    std::vector<std::pair<XXH128Hash, PipelineUsageInfo>> Entries;
+    {
+        std::lock_guard<std::mutex> Guard{m_PipelineUsageMtx};
+        Entries.assign(m_PipelineUsage.begin(), m_PipelineUsage.end());
+    }
+    std::sort(Entries.begin(), Entries.end(),
+              [](const std::pair<XXH128Hash, PipelineUsageInfo>& lhs, const std::pair<XXH128Hash, PipelineUsageInfo>& rhs) {
+                  return lhs.second.FirstUseTime < rhs.second.FirstUseTime;
+              });
+
+    size_t ManifestSize = sizeof(UsageManifestHeader);
+    for (const auto& Entry : Entries)
+        ManifestSize += sizeof(UsageManifestEntry) + Entry.second.Name.length();
+
+    RefCntAutoPtr<DataBlobImpl> pManifest = DataBlobImpl::Create(ManifestSize);
+    Uint8*                      pDst      = pManifest->GetDataPtr<Uint8>();
+
+    UsageManifestHeader Header;
+    Header.NumEntries = StaticCast<Uint32>(Entries.size());
+    memcpy(pDst, &Header, sizeof(Header));
+    pDst += sizeof(Header);
+
+    for (const auto& Entry : Entries)
+    {
+        const PipelineUsageInfo& Usage = Entry.second;
+
+        UsageManifestEntry DstEntry;
+        DstEntry.HashLow      = Entry.first.LowPart;
+        DstEntry.HashHigh     = Entry.first.HighPart;
+        DstEntry.FirstUseTime = Usage.FirstUseTime;
+        DstEntry.NameLength   = Usage.HasName ? StaticCast<Uint32>(Usage.Name.length()) : UsageManifestEntry::NullName;
+        DstEntry.PipelineType = static_cast<Uint8>(Usage.PipelineType);
+        memcpy(pDst, &DstEntry, sizeof(DstEntry));
+        pDst += sizeof(DstEntry);
+
+        memcpy(pDst, Usage.Name.data(), Usage.Name.length());
+        pDst += Usage.Name.length();
+    }
+    VERIFY_EXPR(pDst == pManifest->GetDataPtr<Uint8>() + ManifestSize);
+
+    *ppManifest = pManifest.Detach();
+    return true;
+}
+
+void RenderStateCacheImpl::ResetUsage()
+{
+    std::lock_guard<std::mutex> Guard{m_PipelineUsageMtx};
+    m_PipelineUsage.clear();
+    m_UsageTimer.Restart();
+}
+
+Uint32 RenderStateCacheImpl::Prewarm(const IDataBlob* pManifest)
+{
+    DEV_CHECK_ERR(pManifest != nullptr, "pManifest must not be null");
+    if (pManifest == nullptr)
+        return 0;
+
+    const Uint8* const pData    = static_cast<const Uint8*>(pManifest->GetConstDataPtr());
+    const size_t       DataSize = pManifest->GetSize();
+
+    UsageManifestHeader Header;
+    if (DataSize < sizeof(Header))
+    {
+        LOG_ERROR_MESSAGE("Render state cache pre-warm manifest is too small");
+        return 0;
+    }
+    memcpy(&Header, pData, sizeof(Header));
+    if (Header.Magic != UsageManifestHeader::MagicNumber || Header.FormatVersion != UsageManifestHeader::Version)
+    {
+        LOG_ERROR_MESSAGE("Invalid render state cache pre-warm manifest");
+        return 0;
+    }
+
+    const bool AsyncCompilation = m_pDevice->GetShaderCompilationThreadPool() != nullptr;
+
+    Uint32 NumPrewarmed = 0;
+    size_t Offset       = sizeof(Header);
+    for (Uint32 i = 0; i < Header.NumEntries; ++i)
+    {
+        UsageManifestEntry Entry;
+        if (Offset + sizeof(Entry) > DataSize)
+        {
+            LOG_ERROR_MESSAGE("Render state cache pre-warm manifest is corrupted: unexpected end of data");
+            break;
+        }
+        memcpy(&Entry, pData + Offset, sizeof(Entry));
+        Offset += sizeof(Entry);
+
+        const size_t NameLength = Entry.NameLength != UsageManifestEntry::NullName ? Entry.NameLength : 0;
+        if (NameLength > DataSize - Offset)
+        {
+            LOG_ERROR_MESSAGE("Render state cache pre-warm manifest is corrupted: unexpected end of data");
+            break;
+        }
+        const std::string Name{reinterpret_cast<const char*>(pData + Offset), NameLength};
+        Offset += NameLength;
+
+        const char* PSOName = Entry.NameLength != UsageManifestEntry::NullName ? Name.c_str() : nullptr;
+
+        XXH128Hash Hash;
+        Hash.LowPart  = Entry.HashLow;
+        Hash.HighPart = Entry.HashHigh;
+
+        {
+            std::lock_guard<std::mutex> Guard{m_PipelinesMtx};
+
+            auto it = m_Pipelines.find(Hash);
+            if (it != m_Pipelines.end() && it->second.IsValid())
+                continue; // The pipeline is already alive
+        }
+
+        const std::string HashStr = MakeHashStr(PSOName, Hash);
+
+        auto Callback = MakeCallback(
+            [PSOName, AsyncCompilation](PipelineStateCreateInfo& CI) {
+                CI.PSODesc.Name = PSOName;
+                if (AsyncCompilation)
+                    CI.Flags |= PSO_CREATE_FLAG_ASYNCHRONOUS;
+            });
+
+        PipelineStateUnpackInfo UnpackInfo;
+        UnpackInfo.PipelineType                  = static_cast<PIPELINE_TYPE>(Entry.PipelineType);
+        UnpackInfo.Name                          = HashStr.c_str();
+        UnpackInfo.pDevice                       = m_pDevice;
+        UnpackInfo.ModifyPipelineStateCreateInfo = Callback;
+        UnpackInfo.pUserData                     = Callback;
+        RefCntAutoPtr<IPipelineState> pPSO;
+        m_pDearchiver->UnpackPipelineState(UnpackInfo, &pPSO);
+        if (!pPSO)
+        {
+            RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Pipeline '", HashStr, "' from the pre-warm manifest is not found in the archive.");
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> Guard{m_PipelinesMtx};
+            m_Pipelines[Hash] = pPSO;
+        }
+        {
+            std::lock_guard<std::mutex> Guard{m_PrewarmedPipelinesMtx};
+            m_PrewarmedPipelines.emplace_back(std::move(pPSO));
+        }
+        ++NumPrewarmed;
+    }
+
+    RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Pre-warming ", NumPrewarmed, " pipeline(s) out of ", Header.NumEntries, " listed in the manifest.");
+
+    return NumPrewarmed;
+}
+
+Uint32 RenderStateCacheImpl::GetNumPendingPrewarmPipelines()
+{
+    std::lock_guard<std::mutex> Guard{m_PrewarmedPipelinesMtx};
+
+    Uint32 NumPending = 0;
+    for (auto& pPSO : m_PrewarmedPipelines)
+    {
+        if (pPSO->GetStatus() == PIPELINE_STATE_STATUS_COMPILING)
+            ++NumPending;
+    }
+    return NumPending;
+}
+
+void RenderStateCacheImpl::ReleasePrewarmedPipelines()
+{
+    std::lock_guard<std::mutex> Guard{m_PrewarmedPipelinesMtx};
+    m_PrewarmedPipelines.clear();
+}
+
 void RenderStateCacheImpl::Reset()
 {
+    WaitForJournal();
     m_pDearchiver->Reset();
     m_pArchiver->Reset();
+    m_NumNewStates.store(0);
     m_Shaders.clear();
+    m_ShaderSourceHashes.clear();
     m_ReloadableShaders.clear();
     m_Pipelines.clear();
     m_ReloadablePipelines.clear();
+    m_PrewarmedPipelines.clear();
 }
 
 RefCntAutoPtr<IShader> RenderStateCacheImpl::FindReloadableShader(IShader* pShader)
@@ -230,14 +626,11 @@ RenderStateCacheImpl::RenderStateCacheImpl(IReferenceCounters*               pRe
         LOG_ERROR_AND_THROW("Failed to create dearchiver");
 }
 
-#define RENDER_STATE_CACHE_LOG(Level, ...)                         \
-    do                                                             \
-    {                                                              \
-        if (m_CI.LogLevel >= Level)                                \
-        {                                                          \
-            LOG_INFO_MESSAGE("Render state cache: ", __VA_ARGS__); \
-        }                                                          \
-    } while (false)
+RenderStateCacheImpl::~RenderStateCacheImpl()
+{
+    // Make sure that all journal records are written before the cache is destroyed
+    WaitForJournal();
+}
 
 bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
                                         IShader**               ppShader)
@@ -307,6 +700,58 @@ bool RenderStateCacheImpl::CreateShader(const ShaderCreateInfo& ShaderCI,
     return FoundInCache;
 }
 
+XXH128Hash RenderStateCacheImpl::GetShaderSourceHash(const ShaderCreateInfo& ShaderCI)
+{
+    if (ShaderCI.Source == nullptr && ShaderCI.FilePath == nullptr)
+    {
+        // Byte code has to be hashed anyway to compute the key
+        return XXH128State::ComputeShaderSourceHash(ShaderCI);
+    }
+
+    // Including the factory pointer in the key makes sure that the same file path
+    // will be looked up separately for different factories.
+    XXH128State KeyHasher;
+    KeyHasher.Update(reinterpret_cast<uintptr_t>(ShaderCI.pShaderSourceStreamFactory));
+    if (ShaderCI.Source != nullptr)
+    {
+        // The source is in memory, so hashing it is cheap compared to reading
+        // all include files through the factory.
+        KeyHasher.Update(true);
+        if (ShaderCI.SourceLength != 0 || ShaderCI.Source[0] != '\0')
+            KeyHasher.UpdateStr(ShaderCI.Source, ShaderCI.SourceLength);
+    }
+    else
+    {
+        KeyHasher.Update(false);
+        KeyHasher.UpdateStr(ShaderCI.FilePath);
+    }
+    const auto Key = KeyHasher.Digest();
+
+    {
+        std::lock_guard<std::mutex> Guard{m_ShaderSourceHashesMtx};
+
+        auto it = m_ShaderSourceHashes.find(Key);
+        if (it != m_ShaderSourceHashes.end())
+        {
+            // If the factory was released, a new factory may have been allocated at the same address
+            if (it->second.pFactory.Lock().RawPtr() == ShaderCI.pShaderSourceStreamFactory)
+                return it->second.Hash;
+
+            m_ShaderSourceHashes.erase(it);
+        }
+    }
+
+    // Read the source and all include files only if the hash was not found
+    const auto SourceHash = XXH128State::ComputeShaderSourceHash(ShaderCI);
+
+    {
+        std::lock_guard<std::mutex> Guard{m_ShaderSourceHashesMtx};
+        m_ShaderSourceHashes.emplace(Key, ShaderSourceHashInfo{RefCntWeakPtr<IShaderSourceInputStreamFactory>{ShaderCI.pShaderSourceStreamFactory}, SourceHash});
+    }
+
+    return SourceHash;
+}
+
 bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI,
                                                 IShader**               ppShader)
 {
@@ -318,7 +763,8 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
 #else
     constexpr bool IsDebug = false;
 #endif
-    Hasher.Update(ShaderCI, m_DeviceHash, IsDebug);
+    Hasher.Update(ShaderCI, GetShaderSourceHash(ShaderCI));
+    Hasher.Update(m_DeviceHash, IsDebug);
     const auto Hash = Hasher.Digest();
 
     // First, try to check if the shader has already been requested
@@ -413,7 +859,10 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
         if (pArchivedShader)
         {
             if (m_pArchiver->AddShader(pArchivedShader))
+            {
+                m_NumNewStates.fetch_add(1);
                 RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Added shader '", HashStr, "'.");
+            }
             else
                 LOG_ERROR_MESSAGE("Failed to archive shader '", HashStr, "'.");
         }
@@ -768,24 +1217,34 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
     Hasher.Update(PSOCreateInfo, m_DeviceHash);
     const auto Hash = Hasher.Digest();
 
+    if (m_CI.RecordUsage)
+        RecordPipelineUsage(PSOCreateInfo.PSODesc, Hash);
+
     // First, try to check if the PSO has already been requested
     {
-        std::lock_guard<std::mutex> Guard{m_PipelinesMtx};
-
-        auto it = m_Pipelines.find(Hash);
-        if (it != m_Pipelines.end())
+        RefCntAutoPtr<IPipelineState> pExistingPSO;
         {
-            if (auto pPSO = it->second.Lock())
-            {
-                *ppPipelineState = pPSO.Detach();
-                RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing pipeline '", (PSOCreateInfo.PSODesc.Name ? PSOCreateInfo.PSODesc.Name : ""), "'.");
-                return true;
-            }
-            else
+            std::lock_guard<std::mutex> Guard{m_PipelinesMtx};
+
+            auto it = m_Pipelines.find(Hash);
+            if (it != m_Pipelines.end())
             {
-                m_Pipelines.erase(it);
+                pExistingPSO = it->second.Lock();
+                if (!pExistingPSO)
+                    m_Pipelines.erase(it);
             }
         }
+
+        if (pExistingPSO)
+        {
+            // The pipeline may still be compiling if it was created by Prewarm()
+            if ((PSOCreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) == 0)
+                pExistingPSO->GetStatus(/*WaitForCompletion = */ true);
+
+            *ppPipelineState = pExistingPSO.Detach();
+            RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE, "Reusing existing pipeline '", (PSOCreateInfo.PSODesc.Name ? PSOCreateInfo.PSODesc.Name : ""), "'.");
+            return true;
+        }
     }
 
     const auto HashStr = MakeHashStr(PSOCreateInfo.PSODesc.Name, Hash);
@@ -875,7 +1334,10 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
         if (pSerializedPSO)
         {
             if (m_pArchiver->AddPipelineState(pSerializedPSO))
+            {
+                m_NumNewStates.fetch_add(1);
                 RENDER_STATE_CACHE_LOG(RENDER_STATE_CACHE_LOG_LEVEL_NORMAL, "Added pipeline '", HashStr, "'.");
+            }
             else
                 LOG_ERROR_MESSAGE("Failed to archive PSO '", HashStr, "'.");
         }
@@ -897,6 +1359,12 @@ Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGra
 
     Uint32 NumStatesReloaded = 0;
 
+    // Shader source files may have changed, so their hashes must be computed anew
+    {
+        std::lock_guard<std::mutex> Guard{m_ShaderSourceHashesMtx};
+        m_ShaderSourceHashes.clear();
+    }
+
     // Reload all shaders first
     {
         std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
@@ -944,6 +1412,117 @@ Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGra
     return NumStatesReloaded;
 }
 
+Uint32 RenderStateCacheImpl::ReloadFiles(const char* const*                 ppFilePaths,
+                                         Uint32                             NumFiles,
+                                         ReloadGraphicsPipelineCallbackType ReloadGraphicsPipeline,
+                                         void*                              pUserData)
+{
+    if (!m_CI.EnableHotReload)
+    {
+        DEV_ERROR("This render state cache was not created with hot reload enabled. Set EnableHotReload to true.");
+        return 0;
+    }
+
+    if (NumFiles == 0)
+        return 0;
+
+    DEV_CHECK_ERR(ppFilePaths != nullptr, "ppFilePaths must not be null when NumFiles is not zero");
+
+    // Shader source files have changed, so their hashes must be computed anew
+    {
+        std::lock_guard<std::mutex> Guard{m_ShaderSourceHashesMtx};
+        m_ShaderSourceHashes.clear();
+    }
+    InvalidateShaderSourceCache();
+
+    // Collect the shaders first and check the dependencies without holding the lock,
+    // since this may read the source files.
+    std::vector<RefCntAutoPtr<ReloadableShader>> ReloadableShaders;
+    {
+        std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
+        ReloadableShaders.reserve(m_ReloadableShaders.size());
+        for (auto shader_it : m_ReloadableShaders)
+        {
+            if (auto pShader = shader_it.second.Lock())
+            {
+                RefCntAutoPtr<ReloadableShader> pReloadableShader{pShader, ReloadableShader::IID_InternalImpl};
+                if (pReloadableShader)
+                    ReloadableShaders.emplace_back(std::move(pReloadableShader));
+                else
+                    UNEXPECTED("Shader object is not a ReloadableShader");
+            }
+        }
+    }
+
+    std::vector<RefCntAutoPtr<ReloadableShader>> ShadersToReload;
+    // Pipeline create infos reference reloadable shaders
+    std::unordered_set<const IShader*> ChangedShaders;
+    for (auto& pShader : ReloadableShaders)
+    {
+        for (Uint32 i = 0; i < NumFiles; ++i)
+        {
+            if (pShader->DependsOnFile(ppFilePaths[i]))
+            {
+                ChangedShaders.emplace(pShader.RawPtr());
+                ShadersToReload.emplace_back(std::move(pShader));
+                break;
+            }
+        }
+    }
+    if (ShadersToReload.empty())
+        return 0;
+
+    std::vector<RefCntAutoPtr<ReloadablePipelineState>> PipelinesToReload;
+    {
+        std::lock_guard<std::mutex> Guard{m_ReloadablePipelinesMtx};
+        for (auto pso_it : m_ReloadablePipelines)
+        {
+            if (auto pPSO = pso_it.second.Lock())
+            {
+                RefCntAutoPtr<ReloadablePipelineState> pReloadablePSO{pPSO, ReloadablePipelineState::IID_InternalImpl};
+                if (pReloadablePSO)
+                {
+                    if (pReloadablePSO->UsesAnyShader(ChangedShaders))
+                        PipelinesToReload.emplace_back(std::move(pReloadablePSO));
+                }
+                else
+                {
+                    UNEXPECTED("Pipeline state object is not a ReloadablePipelineState");
+                }
+            }
+        }
+    }
+
+    IThreadPool* pThreadPool = m_pDevice->GetShaderCompilationThreadPool();
+
+    const auto ProcessItems = [pThreadPool](size_t NumItems, std::function<void(size_t)> Handler) {
+        if (pThreadPool != nullptr)
+        {
+            ProcessItemsInParallel(pThreadPool, NumItems, std::move(Handler));
+        }
+        else
+        {
+            for (size_t i = 0; i < NumItems; ++i)
+                Handler(i);
+        }
+    };
+
+    std::atomic<Uint32> NumStatesReloaded{0};
+
+    // Reload shaders first as the pipelines are created from the reloaded shaders
+    ProcessItems(ShadersToReload.size(), [&](size_t i) {
+        if (ShadersToReload[i]->Reload())
+            NumStatesReloaded.fetch_add(1);
+    });
+
+    ProcessItems(PipelinesToReload.size(), [&](size_t i) {
+        if (PipelinesToReload[i]->Reload(ReloadGraphicsPipeline, pUserData))
+            NumStatesReloaded.fetch_add(1);
+    });
+
+    return NumStatesReloaded.load();
+}
+
 static constexpr char RenderStateCacheFileExtension[] = ".diligentcache";
 
 std::string GetRenderStateCacheFilePath(const char* CacheLocation, const char* AppName, RENDER_DEVICE_TYPE DeviceType)
@@ -27,23 +27,62 @@
 
 #include "ScreenCapture.hpp"
 
+#include <cstring>
+
+#include "GraphicsAccessories.hpp"
+#include "TextureFormatConversion.hpp"
+#include "ThreadPool.hpp"
+
 namespace Diligent
 {
 
-ScreenCapture::ScreenCapture(IRenderDevice* pDevice) :
-    m_pDevice{pDevice}
+struct ScreenCapture::ConversionTask
+{
+    RefCntAutoPtr<ITexture>   pTexture;
+    RefCntAutoPtr<IAsyncTask> pTask;
+    MappedTextureSubresource  MappedData;
+    Uint32                    Id = 0;
+
+    // Converted frame data. The buffer is reused by subsequent frames.
+    std::vector<Uint8> Data;
+};
+
+ScreenCapture::ScreenCapture(IRenderDevice* pDevice, const ScreenCaptureCreateInfo& CI) :
+    // clang-format off
+    m_pDevice          {pDevice             },
+    m_MaxFramesInFlight{CI.MaxFramesInFlight},
+    m_FrameCallback    {CI.FrameCallback    },
+    m_pThreadPool      {CI.pThreadPool      },
+    m_ConvertToRGBA8   {CI.ConvertToRGBA8   }
+// clang-format on
 {
     FenceDesc fenceDesc;
     fenceDesc.Name = "Screen capture fence";
     m_pDevice->CreateFence(fenceDesc, &m_pFence);
 }
 
-void ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId)
+ScreenCapture::~ScreenCapture()
+{
+    for (std::unique_ptr<ConversionTask>& pTask : m_ConversionTasks)
+    {
+        if (pTask->pTask)
+            pTask->pTask->WaitForCompletion();
+    }
+    DEV_CHECK_ERR(m_ConversionTasks.empty(), "Destroying screen capture with mapped staging textures. Call WaitForCompletion() or ProcessCaptures() to unmap them.");
+}
+
+bool ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Uint32 FrameId)
 {
     auto*       pCurrentRTV        = pSwapChain->GetCurrentBackBufferRTV();
     auto*       pCurrentBackBuffer = pCurrentRTV->GetTexture();
     const auto& SCDesc             = pSwapChain->GetDesc();
 
+    if (m_MaxFramesInFlight != 0 && GetNumPendingCaptures() + m_ConversionTasks.size() >= m_MaxFramesInFlight)
+    {
+        ++m_NumDroppedFrames;
+        return false;
+    }
+
     RefCntAutoPtr<ITexture> pStagingTexture;
 
     {
@@ -85,6 +124,150 @@ void ScreenCapture::Capture(ISwapChain* pSwapChain, IDeviceContext* pContext, Ui
     }
 
     ++m_CurrentFenceValue;
+    ++m_NumCapturedFrames;
+    return true;
+}
+
+void ScreenCapture::ConvertFrame(ConversionTask& Task) const
+{
+    const TextureDesc&          TexDesc   = Task.pTexture->GetDesc();
+    const TextureFormatAttribs& FmtAttrs  = GetTextureFormatAttribs(TexDesc.Format);
+    const Uint64                RowSize   = Uint64{TexDesc.Width} * FmtAttrs.GetElementSize();
+    const Uint8*                pSrcData  = static_cast<const Uint8*>(Task.MappedData.pData);
+    const bool                  SwapRB    = m_ConvertToRGBA8 && (TexDesc.Format == TEX_FORMAT_BGRA8_UNORM || TexDesc.Format == TEX_FORMAT_BGRA8_UNORM_SRGB);
+    const size_t                FrameSize = static_cast<size_t>(RowSize * TexDesc.Height);
+
+    CapturedFrame Frame;
+    Frame.Id     = Task.Id;
+    Frame.Width  = TexDesc.Width;
+    Frame.Height = TexDesc.Height;
+    Frame.Format = TexDesc.Format;
+    if (SwapRB)
+        Frame.Format = TexDesc.Format == TEX_FORMAT_BGRA8_UNORM ? TEX_FORMAT_RGBA8_UNORM : TEX_FORMAT_RGBA8_UNORM_SRGB;
+
+    Task.Data.resize(FrameSize);
+    if (SwapRB)
+    {
+        ConvertTextureDataAttribs ConvertAttribs;
+        ConvertAttribs.Width     = TexDesc.Width;
+        ConvertAttribs.Height    = TexDesc.Height;
+        ConvertAttribs.SrcFormat = TexDesc.Format;
+        ConvertAttribs.pSrcData  = pSrcData;
+        ConvertAttribs.SrcStride = Task.MappedData.Stride;
+        ConvertAttribs.DstFormat = Frame.Format;
+        ConvertAttribs.pDstData  = Task.Data.data();
+        ConvertAttribs.DstStride = static_cast<size_t>(RowSize);
+        ConvertTextureData(ConvertAttribs);
+    }
+    else
+    {
+        for (Uint32 y = 0; y < TexDesc.Height; ++y)
+            memcpy(Task.Data.data() + RowSize * y, pSrcData + Task.MappedData.Stride * y, static_cast<size_t>(RowSize));
+    }
+    Frame.pData  = Task.Data.data();
+    Frame.Stride = RowSize;
+    m_FrameCallback(Frame);
+}
+
+void ScreenCapture::ReleaseConversionTasks(IDeviceContext* pContext, bool WaitForTasks)
+{
+    auto TaskIt = m_ConversionTasks.begin();
+    while (TaskIt != m_ConversionTasks.end())
+    {
+        ConversionTask& Task = **TaskIt;
+        if (Task.pTask)
+        {
+            if (WaitForTasks)
+                Task.pTask->WaitForCompletion();
+            else if (!Task.pTask->IsFinished())
+            {
+                ++TaskIt;
+                continue;
+            }
+        }
+
+        pContext->UnmapTextureSubresource(Task.pTexture, 0, 0);
+        RecycleStagingTexture(std::move(Task.pTexture));
+        Task.pTask.Release();
+        Task.MappedData = {};
+
+        m_FreeConversionTasks.emplace_back(std::move(*TaskIt));
+        TaskIt = m_ConversionTasks.erase(TaskIt);
+    }
+}
+
+void ScreenCapture::ProcessCaptures(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(m_FrameCallback, "Frame callback is not set");
+    if (!m_FrameCallback)
+        return;
+
+    ReleaseConversionTasks(pContext, /*WaitForTasks = */ false);
+
+    while (CaptureInfo Capture = GetCapture())
+    {
+        std::unique_ptr<ConversionTask> pTask;
+        if (!m_FreeConversionTasks.empty())
+        {
+            pTask = std::move(m_FreeConversionTasks.back());
+            m_FreeConversionTasks.pop_back();
+        }
+        else
+        {
+            pTask.reset(new ConversionTask);
+        }
+
+        // The copy has completed, so mapping does not stall
+        pContext->MapTextureSubresource(Capture.pTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, pTask->MappedData);
+        if (pTask->MappedData.pData == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to map staging texture for screen capture ", Capture.Id);
+            RecycleStagingTexture(std::move(Capture.pTexture));
+            m_FreeConversionTasks.emplace_back(std::move(pTask));
+            continue;
+        }
+        pTask->pTexture = std::move(Capture.pTexture);
+        pTask->Id       = Capture.Id;
+
+        ConversionTask* pConversionTask = pTask.get();
+        if (m_pThreadPool)
+        {
+            pTask->pTask = EnqueueAsyncWork(m_pThreadPool,
+                                            [this, pConversionTask](Uint32 ThreadId) {
+                                                ConvertFrame(*pConversionTask);
+                                                return ASYNC_TASK_STATUS_COMPLETE;
+                                            });
+        }
+        else
+        {
+            ConvertFrame(*pConversionTask);
+        }
+        m_ConversionTasks.emplace_back(std::move(pTask));
+    }
+
+    if (!m_pThreadPool)
+        ReleaseConversionTasks(pContext, /*WaitForTasks = */ false);
+}
+
+void ScreenCapture::WaitForCompletion(IDeviceContext* pContext)
+{
+    if (m_FrameCallback)
+    {
+        // Make sure that the fence signals are submitted before waiting
+        pContext->Flush();
+        m_pFence->Wait(m_CurrentFenceValue - 1);
+        ProcessCaptures(pContext);
+        ReleaseConversionTasks(pContext, /*WaitForTasks = */ true);
+    }
+}
+
+ScreenCaptureStats ScreenCapture::GetStats()
+{
+    ScreenCaptureStats Stats;
+    Stats.NumCapturedFrames = m_NumCapturedFrames;
+    Stats.NumDroppedFrames  = m_NumDroppedFrames;
+    Stats.NumFramesInFlight = static_cast<Uint32>(GetNumPendingCaptures() + m_ConversionTasks.size());
+    return Stats;
 }
 
 
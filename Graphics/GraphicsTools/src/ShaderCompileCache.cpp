@@ -0,0 +1,258 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <random>
+#include <cstdio>
+#include <cstring>
+
+#include "ShaderCompileCache.h"
+#include "RefCntAutoPtr.hpp"
+#include "DataBlobImpl.hpp"
+#include "ProxyDataBlob.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+#include "ObjectBase.hpp"
+#include "XXH128Hasher.hpp"
+
+namespace Diligent
+{
+
+/// Implementation of the content-addressed shader compile cache
+class ShaderCompileCacheImpl final : public ObjectBase<IShaderCompileExecutor>
+{
+public:
+    using TBase = ObjectBase<IShaderCompileExecutor>;
+
+    // Header of the byte code file in the cache directory
+    struct CacheFileHeader
+    {
+        static constexpr Uint32 HeaderMagic   = 0x5C0FCACE;
+        static constexpr Uint32 HeaderVersion = 1;
+
+        Uint32 Magic   = HeaderMagic;
+        Uint32 Version = HeaderVersion;
+
+        Uint64 DataSize = 0;
+
+        // Hash of the byte code used to detect corrupted files
+        XXH128Hash DataHash = {};
+    };
+    static_assert(sizeof(CacheFileHeader) == 32, "Unexpected header size");
+
+    static constexpr char CacheFileExtension[] = ".dsc";
+
+public:
+    ShaderCompileCacheImpl(IReferenceCounters*                 pRefCounters,
+                           const ShaderCompileCacheCreateInfo& CreateInfo) :
+        TBase{pRefCounters},
+        m_pExecutor{CreateInfo.pExecutor},
+        m_pDevice{CreateInfo.pDevice}
+    {
+        if (CreateInfo.CacheDirectory == nullptr || CreateInfo.CacheDirectory[0] == '\0')
+            LOG_ERROR_AND_THROW("Shader compile cache directory must not be null or empty");
+
+        m_Directory = CreateInfo.CacheDirectory;
+        if (!FileSystem::IsSlash(m_Directory.back()))
+            m_Directory.push_back(FileSystem::SlashSymbol);
+
+        if (!FileSystem::PathExists(m_Directory.c_str()) && !FileSystem::CreateDirectory(m_Directory.c_str()))
+            LOG_ERROR_AND_THROW("Failed to create shader compile cache directory '", CreateInfo.CacheDirectory, "'");
+
+        // The suffix must be unique among all processes that share the directory
+        std::random_device rd;
+        m_TmpFileSuffix = '.' + std::to_string(rd()) + '.' + std::to_string(rd());
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ShaderCompileExecutor, TBase);
+
+    virtual void DILIGENT_CALL_TYPE Compile(const ShaderCompileJob& Job,
+                                            IDataBlob**             ppByteCode) override final
+    {
+        DEV_CHECK_ERR(ppByteCode != nullptr, "ppByteCode must not be null");
+        DEV_CHECK_ERR(*ppByteCode == nullptr, "Overwriting reference to an existing object may result in memory leaks");
+        if (Job.pData == nullptr || Job.DataSize == 0)
+        {
+            DEV_ERROR("Shader compile job data must not be empty");
+            return;
+        }
+
+        XXH128Hash Hash;
+        {
+            XXH128State Hasher;
+            Hasher.UpdateRaw(Job.pData, Job.DataSize);
+            Hash = Hasher.Digest();
+        }
+
+        RefCntAutoPtr<IDataBlob> pByteCode = ReadCacheFile(Hash);
+        if (!pByteCode)
+        {
+            if (m_pExecutor)
+                m_pExecutor->Compile(Job, &pByteCode);
+
+            if (!pByteCode && m_pDevice)
+                m_pDevice->CompileShaderJob(Job.pData, Job.DataSize, &pByteCode);
+
+            if (pByteCode && pByteCode->GetSize() > 0)
+                WriteCacheFile(Hash, pByteCode);
+        }
+
+        *ppByteCode = pByteCode.Detach();
+    }
+
+private:
+    std::string GetFilePath(const XXH128Hash& Hash) const
+    {
+        char Str[33];
+        std::snprintf(Str, sizeof(Str), "%016llx%016llx",
+                      static_cast<unsigned long long>(Hash.HighPart),
+                      static_cast<unsigned long long>(Hash.LowPart));
+        return m_Directory + Str + CacheFileExtension;
+    }
+
+    RefCntAutoPtr<IDataBlob> ReadCacheFile(const XXH128Hash& Hash) const
+    {
+        const std::string Path = GetFilePath(Hash);
+        if (!FileSystem::FileExists(Path.c_str()))
+            return {};
+
+        RefCntAutoPtr<IDataBlob> pFileData;
+        if (!FileWrapper::ReadWholeFile(Path.c_str(), &pFileData, /*Silent = */ true))
+            return {};
+
+        const size_t FileSize = pFileData->GetSize();
+
+        CacheFileHeader Header;
+        bool            IsValid = FileSize >= sizeof(Header);
+        if (IsValid)
+        {
+            memcpy(&Header, pFileData->GetConstDataPtr(), sizeof(Header));
+            IsValid = (Header.Magic == CacheFileHeader::HeaderMagic &&
+                       Header.Version == CacheFileHeader::HeaderVersion &&
+                       Header.DataSize != 0 &&
+                       Header.DataSize == FileSize - sizeof(Header));
+        }
+
+        const void* pData = pFileData->GetConstDataPtr(sizeof(Header));
+        if (IsValid)
+        {
+            XXH128State Hasher;
+            Hasher.UpdateRaw(pData, Header.DataSize);
+            IsValid = Hasher.Digest() == Header.DataHash;
+        }
+
+        if (!IsValid)
+        {
+            // Do not delete the file as it may be being replaced by another process.
+            // A valid file will overwrite it once the shader is compiled.
+            LOG_WARNING_MESSAGE("Shader compile cache file '", Path, "' is invalid or corrupted and will be ignored.");
+            return {};
+        }
+
+        // Reference the byte code in place
+        return ProxyDataBlob::Create(pData, StaticCast<size_t>(Header.DataSize), pFileData);
+    }
+
+    void WriteCacheFile(const XXH128Hash& Hash, IDataBlob* pByteCode) const
+    {
+        CacheFileHeader Header;
+        Header.DataSize = pByteCode->GetSize();
+        {
+            XXH128State Hasher;
+            Hasher.UpdateRaw(pByteCode->GetConstDataPtr(), Header.DataSize);
+            Header.DataHash = Hasher.Digest();
+        }
+
+        std::vector<Uint8> FileData(sizeof(Header) + pByteCode->GetSize());
+        memcpy(FileData.data(), &Header, sizeof(Header));
+        memcpy(FileData.data() + sizeof(Header), pByteCode->GetConstDataPtr(), pByteCode->GetSize());
+
+        // Write the data to a temporary file and then rename it so that other processes
+        // never see a partially written file. The counter makes the temporary file names
+        // unique among the threads of this process.
+        const std::string Path    = GetFilePath(Hash);
+        const std::string TmpPath = Path + m_TmpFileSuffix + '.' + std::to_string(m_TmpFileCounter.fetch_add(1)) + ".tmp";
+        if (!FileWrapper::WriteFile(TmpPath.c_str(), FileData.data(), FileData.size(), /*Silent = */ true))
+        {
+            LOG_WARNING_MESSAGE("Failed to write shader compile cache file '", TmpPath, "'.");
+            return;
+        }
+
+        if (std::rename(TmpPath.c_str(), Path.c_str()) != 0)
+        {
+            // Rename does not replace existing files on some platforms. The file with the same
+            // name contains the same byte code, so there is no need to replace it unless it is corrupted.
+            if (!FileSystem::FileExists(Path.c_str()) || !ReadCacheFile(Hash))
+            {
+                FileSystem::DeleteFile(Path.c_str());
+                if (std::rename(TmpPath.c_str(), Path.c_str()) == 0)
+                    return;
+                LOG_WARNING_MESSAGE("Failed to rename shader compile cache file '", TmpPath, "' to '", Path, "'.");
+            }
+            FileSystem::DeleteFile(TmpPath.c_str());
+        }
+    }
+
+private:
+    RefCntAutoPtr<IShaderCompileExecutor> m_pExecutor;
+    RefCntAutoPtr<ISerializationDevice>   m_pDevice;
+
+    std::string m_Directory;
+    std::string m_TmpFileSuffix;
+
+    mutable std::atomic<Uint32> m_TmpFileCounter{0};
+};
+
+constexpr char ShaderCompileCacheImpl::CacheFileExtension[];
+
+void CreateShaderCompileCache(const ShaderCompileCacheCreateInfo& CreateInfo,
+                              IShaderCompileExecutor**            ppExecutor)
+{
+    try
+    {
+        RefCntAutoPtr<IShaderCompileExecutor> pExecutor{MakeNewRCObj<ShaderCompileCacheImpl>()(CreateInfo)};
+        if (pExecutor)
+            pExecutor->QueryInterface(IID_ShaderCompileExecutor, reinterpret_cast<IObject**>(ppExecutor));
+    }
+    catch (...)
+    {
+        LOG_ERROR("Failed to create the shader compile cache");
+    }
+}
+
+} // namespace Diligent
+
+extern "C"
+{
+    void CreateShaderCompileCache(const Diligent::ShaderCompileCacheCreateInfo& CreateInfo,
+                                  Diligent::IShaderCompileExecutor**            ppExecutor)
+    {
+        Diligent::CreateShaderCompileCache(CreateInfo, ppExecutor);
+    }
+}
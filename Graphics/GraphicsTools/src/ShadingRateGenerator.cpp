@@ -0,0 +1,602 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShadingRateGenerator.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "PlatformMisc.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsUtilities.h"
+#include "ShaderMacroHelper.hpp"
+
+namespace Diligent
+{
+
+#if METAL_SUPPORTED
+void CreateRasterizationRateMapMtl(IRenderDevice*  pDevice,
+                                   const char*     Name,
+                                   Uint32          ScreenWidth,
+                                   Uint32          ScreenHeight,
+                                   Uint32          NumColumns,
+                                   const float*    pHorizontal,
+                                   Uint32          NumRows,
+                                   const float*    pVertical,
+                                   IDeviceObject** ppRRM,
+                                   ITextureView**  ppView);
+#endif
+
+namespace
+{
+
+constexpr Uint32 OUTPUT_FORMAT_PALETTE = 0;
+constexpr Uint32 OUTPUT_FORMAT_UNORM8  = 1;
+constexpr Uint32 OUTPUT_FORMAT_COL_ROW = 2;
+
+constexpr Uint32 GENERATOR_FLAG_MOTION_VECTORS = 1u << 0u;
+
+struct GeneratorConstants
+{
+    // Supported rate indexed by [AxisRateX][AxisRateY]
+    uint4 RateRemap[4];
+
+    uint2 ScreenSize;
+    uint2 TileSize;
+
+    uint2  NumTiles;
+    Uint32 Flags              = 0;
+    float  LuminanceThreshold = 0;
+
+    float2 MotionVectorScale;
+    float  QuarterRateThresholdScale = 0;
+    float  MotionSensitivity         = 0;
+};
+
+constexpr char GeneratorShaderSource[] = R"(
+cbuffer cbGeneratorConstants
+{
+    uint4  g_RateRemap[4];
+
+    uint2  g_ScreenSize;
+    uint2  g_TileSize;
+
+    uint2  g_NumTiles;
+    uint   g_Flags;
+    float  g_LuminanceThreshold;
+
+    float2 g_MotionVectorScale;
+    float  g_QuarterRateThresholdScale;
+    float  g_MotionSensitivity;
+};
+
+#define GENERATOR_FLAG_MOTION_VECTORS 1u
+
+#define OUTPUT_FORMAT_PALETTE 0
+#define OUTPUT_FORMAT_UNORM8  1
+#define OUTPUT_FORMAT_COL_ROW 2
+
+Texture2D<float4> g_Color;
+Texture2D<float4> g_MotionVectors;
+
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_PALETTE
+RWTexture2D<uint /*format=r8ui*/> g_Output;
+#elif OUTPUT_FORMAT == OUTPUT_FORMAT_UNORM8
+RWTexture2D<float2 /*format=rg8*/> g_Output;
+#else
+// Column densities followed by row densities (4 - full rate, 2 - half rate, 1 - quarter rate)
+RWBuffer<uint /*format=r32ui*/> g_Output;
+#endif
+
+#define GROUP_SIZE  8u
+#define NUM_THREADS 64u
+
+// x - horizontal gradient, y - vertical gradient, z - motion, w - pixel count
+groupshared float4 g_Sums[NUM_THREADS];
+
+float GetLuminance(int2 Pixel)
+{
+    Pixel = min(Pixel, int2(g_ScreenSize) - int2(1, 1));
+    float3 Color = saturate(g_Color.Load(int3(Pixel, 0)).rgb);
+    // Square root approximates the perceptual response to the linear luminance
+    return sqrt(dot(Color, float3(0.2126, 0.7152, 0.0722)));
+}
+
+// Returns AXIS_SHADING_RATE value
+uint GetAxisRate(float Gradient, float Threshold)
+{
+    if (Gradient < Threshold * g_QuarterRateThresholdScale)
+        return 2u;
+    else if (Gradient < Threshold)
+        return 1u;
+    else
+        return 0u;
+}
+
+[numthreads(GROUP_SIZE, GROUP_SIZE, 1)]
+void main(uint3 Gid  : SV_GroupID,
+          uint3 GTid : SV_GroupThreadID,
+          uint  GI   : SV_GroupIndex)
+{
+    uint2  TileOrigin = Gid.xy * g_TileSize;
+    float4 Sum        = float4(0.0, 0.0, 0.0, 0.0);
+    for (uint y = GTid.y; y < g_TileSize.y; y += GROUP_SIZE)
+    {
+        for (uint x = GTid.x; x < g_TileSize.x; x += GROUP_SIZE)
+        {
+            uint2 Pixel = TileOrigin + uint2(x, y);
+            if (Pixel.x >= g_ScreenSize.x || Pixel.y >= g_ScreenSize.y)
+                continue;
+
+            int2  iPixel = int2(Pixel);
+            float L      = GetLuminance(iPixel);
+            Sum.x += abs(GetLuminance(iPixel + int2(1, 0)) - L);
+            Sum.y += abs(GetLuminance(iPixel + int2(0, 1)) - L);
+            if ((g_Flags & GENERATOR_FLAG_MOTION_VECTORS) != 0u)
+                Sum.z += length(g_MotionVectors.Load(int3(iPixel, 0)).xy * g_MotionVectorScale);
+            Sum.w += 1.0;
+        }
+    }
+
+    g_Sums[GI] = Sum;
+    GroupMemoryBarrierWithGroupSync();
+    for (uint s = NUM_THREADS / 2u; s > 0u; s >>= 1u)
+    {
+        if (GI < s)
+            g_Sums[GI] += g_Sums[GI + s];
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (GI != 0u)
+        return;
+
+    Sum = g_Sums[0];
+    float3 Avg = Sum.xyz / max(Sum.w, 1.0);
+
+    float Threshold = g_LuminanceThreshold;
+    if (g_MotionSensitivity > 0.0)
+        Threshold *= 1.0 + Avg.z / g_MotionSensitivity;
+
+    uint RateX = GetAxisRate(Avg.x, Threshold);
+    uint RateY = GetAxisRate(Avg.y, Threshold);
+
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_PALETTE
+    g_Output[Gid.xy] = g_RateRemap[RateX][RateY];
+#elif OUTPUT_FORMAT == OUTPUT_FORMAT_UNORM8
+    g_Output[Gid.xy] = float2(1.0 / float(1u << RateX), 1.0 / float(1u << RateY));
+#else
+    uint Prev;
+    InterlockedMax(g_Output[Gid.x], 4u >> RateX, Prev);
+    InterlockedMax(g_Output[g_NumTiles.x + Gid.y], 4u >> RateY, Prev);
+#endif
+}
+)";
+
+Uint32 ComputeTileSize(Uint32 PreferredSize, Uint32 MinSize, Uint32 MaxSize)
+{
+    Uint32 Size = PreferredSize != 0 ? (1u << PlatformMisc::GetMSB(PreferredSize)) : 16u;
+    if (MinSize != 0)
+        Size = std::max(Size, MinSize);
+    if (MaxSize != 0)
+        Size = std::min(Size, MaxSize);
+    return Size;
+}
+
+} // namespace
+
+ShadingRateGenerator::ShadingRateGenerator(IRenderDevice* pDevice, const ShadingRateGeneratorCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Name{CI.Name != nullptr ? CI.Name : "Shading rate generator"},
+    m_Format{pDevice != nullptr ? pDevice->GetAdapterInfo().ShadingRate.Format : SHADING_RATE_FORMAT_UNKNOWN},
+    m_Width{CI.Width},
+    m_Height{CI.Height}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (m_Width == 0 || m_Height == 0)
+        LOG_ERROR_AND_THROW("Render target size must not be zero");
+
+    const RenderDeviceInfo&      DeviceInfo = m_pDevice->GetDeviceInfo();
+    const ShadingRateProperties& SRProps    = m_pDevice->GetAdapterInfo().ShadingRate;
+    if (!DeviceInfo.Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("Shading rate generator requires compute shaders");
+    if (!DeviceInfo.Features.VariableRateShading)
+        LOG_ERROR_AND_THROW("Shading rate generator requires variable rate shading");
+
+    const bool IsTextureBased = m_Format == SHADING_RATE_FORMAT_PALETTE || m_Format == SHADING_RATE_FORMAT_UNORM8;
+    if (IsTextureBased)
+    {
+        if ((SRProps.CapFlags & SHADING_RATE_CAP_FLAG_TEXTURE_BASED) == 0)
+            LOG_ERROR_AND_THROW("Shading rate generator requires texture-based variable rate shading");
+    }
+    else if (m_Format == SHADING_RATE_FORMAT_COL_ROW_FP32)
+    {
+#if !METAL_SUPPORTED
+        LOG_ERROR_AND_THROW("Column/row shading rates are only supported by Metal");
+#endif
+    }
+    else
+    {
+        LOG_ERROR_AND_THROW("Unsupported shading rate format");
+    }
+
+    m_TileSize = uint2{
+        ComputeTileSize(CI.TileSize, SRProps.MinTileSize[0], SRProps.MaxTileSize[0]),
+        ComputeTileSize(CI.TileSize, SRProps.MinTileSize[1], SRProps.MaxTileSize[1]),
+    };
+    m_NumTiles = uint2{
+        (m_Width + m_TileSize.x - 1) / m_TileSize.x,
+        (m_Height + m_TileSize.y - 1) / m_TileSize.y,
+    };
+
+    // For every requested rate, select the coarsest supported rate that is not coarser along either axis
+    for (Uint32 Rate = 0; Rate <= SHADING_RATE_MAX; ++Rate)
+    {
+        const Uint32 RateX = Rate >> SHADING_RATE_X_SHIFT;
+        const Uint32 RateY = Rate & ((1u << SHADING_RATE_X_SHIFT) - 1u);
+
+        SHADING_RATE BestRate = SHADING_RATE_1X1;
+        for (Uint32 i = 0; i < SRProps.NumShadingRates; ++i)
+        {
+            const ShadingRateMode& Mode = SRProps.ShadingRates[i];
+            if (!Mode.HasSampleCount(CI.SampleCount))
+                continue;
+
+            const Uint32 ModeX = Uint32{Mode.Rate} >> SHADING_RATE_X_SHIFT;
+            const Uint32 ModeY = Uint32{Mode.Rate} & ((1u << SHADING_RATE_X_SHIFT) - 1u);
+            const Uint32 BestX = Uint32{BestRate} >> SHADING_RATE_X_SHIFT;
+            const Uint32 BestY = Uint32{BestRate} & ((1u << SHADING_RATE_X_SHIFT) - 1u);
+            if (ModeX <= RateX && ModeY <= RateY && ModeX + ModeY > BestX + BestY)
+                BestRate = Mode.Rate;
+        }
+        m_RateRemap[Rate] = BestRate;
+    }
+
+    CreateUniformBuffer(m_pDevice, sizeof(GeneratorConstants), (m_Name + " - constants").c_str(), &m_pConstantsBuffer);
+    if (!m_pConstantsBuffer)
+        LOG_ERROR_AND_THROW("Failed to create the constants buffer");
+
+    // The device reads shading rate textures on the GPU, so the pass may write the texture that is used in the same frame.
+    // Otherwise, and for rasterization rate maps that are created on the CPU, the results are used once the GPU is done.
+    const bool ReadOnGPU = IsTextureBased && SRProps.ShadingRateTextureAccess == SHADING_RATE_TEXTURE_ACCESS_ON_GPU;
+    m_Frames.resize(ReadOnGPU ? 1 : std::max(CI.MaxFramesInFlight, 2u));
+
+    if (IsTextureBased)
+    {
+        const bool CanWriteDirectly = (SRProps.BindFlags & BIND_UNORDERED_ACCESS) != 0;
+
+        const std::string Name = m_Name + " - shading rate map";
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = Name.c_str();
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = m_NumTiles.x;
+        TexDesc.Height    = m_NumTiles.y;
+        TexDesc.Format    = m_Format == SHADING_RATE_FORMAT_PALETTE ? TEX_FORMAT_R8_UINT : TEX_FORMAT_RG8_UNORM;
+        TexDesc.BindFlags = BIND_SHADING_RATE | (CanWriteDirectly ? BIND_UNORDERED_ACCESS : BIND_NONE);
+        TexDesc.Usage     = USAGE_DEFAULT;
+
+        // Initialize the maps with the full shading rate
+        const Uint32       TexelSize = m_Format == SHADING_RATE_FORMAT_PALETTE ? 1 : 2;
+        const Uint8        FullRate  = m_Format == SHADING_RATE_FORMAT_PALETTE ? Uint8{SHADING_RATE_1X1} : Uint8{255};
+        std::vector<Uint8> FullRateData(size_t{TexDesc.Width} * TexDesc.Height * TexelSize, FullRate);
+        TextureSubResData  SubResData{FullRateData.data(), Uint64{TexDesc.Width} * TexelSize};
+        TextureData        InitData{&SubResData, 1};
+        for (FrameData& Frame : m_Frames)
+        {
+            m_pDevice->CreateTexture(TexDesc, &InitData, &Frame.pTexture);
+            if (!Frame.pTexture)
+                LOG_ERROR_AND_THROW("Failed to create the shading rate map");
+        }
+
+        if (!CanWriteDirectly)
+        {
+            const std::string IntermediateName = m_Name + " - intermediate shading rate map";
+
+            TexDesc.Name      = IntermediateName.c_str();
+            TexDesc.BindFlags = BIND_UNORDERED_ACCESS;
+            m_pDevice->CreateTexture(TexDesc, nullptr, &m_pIntermediateTexture);
+            if (!m_pIntermediateTexture)
+                LOG_ERROR_AND_THROW("Failed to create the intermediate shading rate map");
+        }
+
+        if (ReadOnGPU)
+        {
+            m_ReadyFrame      = 0;
+            m_pShadingRateMap = m_Frames[0].pTexture->GetDefaultView(TEXTURE_VIEW_SHADING_RATE);
+        }
+    }
+    else
+    {
+        m_ColumnRowClearData.resize(size_t{m_NumTiles.x} + m_NumTiles.y);
+        m_ColumnRowDensities.resize(m_ColumnRowClearData.size());
+
+        const std::string Name = m_Name + " - column and row densities";
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = Name.c_str();
+        BuffDesc.Size              = m_ColumnRowClearData.size() * sizeof(Uint32);
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+        BuffDesc.ElementByteStride = sizeof(Uint32);
+        m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_pColumnRowBuffer);
+        if (!m_pColumnRowBuffer)
+            LOG_ERROR_AND_THROW("Failed to create the column and row density buffer");
+
+        const std::string ReadbackName = m_Name + " - column and row density readback";
+
+        BuffDesc.Name              = ReadbackName.c_str();
+        BuffDesc.BindFlags         = BIND_NONE;
+        BuffDesc.Usage             = USAGE_STAGING;
+        BuffDesc.Mode              = BUFFER_MODE_UNDEFINED;
+        BuffDesc.ElementByteStride = 0;
+        BuffDesc.CPUAccessFlags    = CPU_ACCESS_READ;
+        for (FrameData& Frame : m_Frames)
+        {
+            m_pDevice->CreateBuffer(BuffDesc, nullptr, &Frame.pReadbackBuffer);
+            if (!Frame.pReadbackBuffer)
+                LOG_ERROR_AND_THROW("Failed to create the column and row density readback buffer");
+        }
+    }
+
+    if (!ReadOnGPU)
+    {
+        const std::string Name = m_Name + " - fence";
+
+        FenceDesc FncDesc;
+        FncDesc.Name = Name.c_str();
+        FncDesc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+        m_pDevice->CreateFence(FncDesc, &m_pFence);
+        if (!m_pFence)
+            LOG_ERROR_AND_THROW("Failed to create the fence");
+    }
+
+    CreatePipeline();
+}
+
+void ShadingRateGenerator::CreatePipeline()
+{
+    Uint32 OutputFormat = OUTPUT_FORMAT_COL_ROW;
+    if (m_Format == SHADING_RATE_FORMAT_PALETTE)
+        OutputFormat = OUTPUT_FORMAT_PALETTE;
+    else if (m_Format == SHADING_RATE_FORMAT_UNORM8)
+        OutputFormat = OUTPUT_FORMAT_UNORM8;
+
+    ShaderMacroHelper Macros;
+    Macros.Add("OUTPUT_FORMAT", static_cast<int>(OutputFormat));
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc           = {m_Name.c_str(), SHADER_TYPE_COMPUTE, true};
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Source         = GeneratorShaderSource;
+    ShaderCI.SourceLength   = sizeof(GeneratorShaderSource) - 1;
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Macros         = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        LOG_ERROR_AND_THROW("Failed to create the shading rate generator shader");
+
+    // clang-format off
+    const ShaderResourceVariableDesc Variables[] =
+    {
+        {SHADER_TYPE_COMPUTE, "g_Color",         SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        {SHADER_TYPE_COMPUTE, "g_MotionVectors", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        {SHADER_TYPE_COMPUTE, "g_Output",        SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+    };
+    // clang-format on
+
+    ComputePipelineStateCreateInfo PsoCI{m_Name.c_str()};
+    PsoCI.pCS = pCS;
+
+    PsoCI.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+    PsoCI.PSODesc.ResourceLayout.Variables           = Variables;
+    PsoCI.PSODesc.ResourceLayout.NumVariables        = _countof(Variables);
+
+    m_pDevice->CreateComputePipelineState(PsoCI, &m_pPSO);
+    if (!m_pPSO)
+        LOG_ERROR_AND_THROW("Failed to create the shading rate generator pipeline");
+
+    m_pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbGeneratorConstants")->Set(m_pConstantsBuffer);
+
+    m_pPSO->CreateShaderResourceBinding(&m_pSRB, true);
+    VERIFY_EXPR(m_pSRB);
+
+    m_pColorVar         = m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Color");
+    m_pMotionVectorsVar = m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_MotionVectors");
+    m_pOutputVar        = m_pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output");
+    VERIFY_EXPR(m_pColorVar != nullptr && m_pMotionVectorsVar != nullptr && m_pOutputVar != nullptr);
+
+    if (m_pColumnRowBuffer)
+    {
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 1;
+
+        RefCntAutoPtr<IBufferView> pUAV;
+        m_pColumnRowBuffer->CreateView(ViewDesc, &pUAV);
+        if (!pUAV)
+            LOG_ERROR_AND_THROW("Failed to create the UAV of the column and row density buffer");
+        m_pOutputVar->Set(pUAV);
+    }
+}
+
+void ShadingRateGenerator::ProcessCompletedFrames(IDeviceContext* pContext)
+{
+    if (!m_pFence)
+        return;
+
+    const Uint64 CompletedValue = m_pFence->GetCompletedValue();
+
+    // Go from the oldest frame to the newest, so that the newest completed frame is used
+    const Uint32 NumFrames = static_cast<Uint32>(m_Frames.size());
+    for (Uint32 i = 0; i < NumFrames; ++i)
+    {
+        const Uint32 FrameIdx = (m_NextFrame + i) % NumFrames;
+        FrameData&   Frame    = m_Frames[FrameIdx];
+        if (Frame.FenceValue == 0 || Frame.FenceValue > CompletedValue)
+            continue;
+
+        Frame.FenceValue = 0;
+        if (Frame.pTexture)
+        {
+            m_ReadyFrame      = FrameIdx;
+            m_pShadingRateMap = Frame.pTexture->GetDefaultView(TEXTURE_VIEW_SHADING_RATE);
+        }
+        else
+        {
+            void* pData = nullptr;
+            pContext->MapBuffer(Frame.pReadbackBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+            if (pData != nullptr)
+            {
+                const Uint32* pDensities = static_cast<const Uint32*>(pData);
+                // Rasterization rate maps are immutable, so only create a new map when the densities change
+                if (!m_pRasterizationRateMap || !std::equal(m_ColumnRowDensities.begin(), m_ColumnRowDensities.end(), pDensities))
+                {
+                    m_ColumnRowDensities.assign(pDensities, pDensities + m_ColumnRowDensities.size());
+                    CreateRasterizationRateMap(pDensities, pDensities + m_NumTiles.x);
+                }
+                pContext->UnmapBuffer(Frame.pReadbackBuffer, MAP_READ);
+            }
+        }
+    }
+}
+
+void ShadingRateGenerator::CreateRasterizationRateMap(const Uint32* pColumnDensity, const Uint32* pRowDensity)
+{
+#if METAL_SUPPORTED
+    std::vector<float> Horizontal(m_NumTiles.x);
+    std::vector<float> Vertical(m_NumTiles.y);
+    // Density 4 is the full rate, 1 is the quarter rate.
+    for (Uint32 i = 0; i < m_NumTiles.x; ++i)
+        Horizontal[i] = static_cast<float>(std::max(pColumnDensity[i], 1u)) / 4.f;
+    for (Uint32 i = 0; i < m_NumTiles.y; ++i)
+        Vertical[i] = static_cast<float>(std::max(pRowDensity[i], 1u)) / 4.f;
+
+    const std::string Name = m_Name + " - rasterization rate map";
+
+    RefCntAutoPtr<IDeviceObject> pRRM;
+    ITextureView*                pView = nullptr;
+    CreateRasterizationRateMapMtl(m_pDevice, Name.c_str(), m_Width, m_Height,
+                                  m_NumTiles.x, Horizontal.data(), m_NumTiles.y, Vertical.data(),
+                                  &pRRM, &pView);
+    if (!pRRM || pView == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to create the rasterization rate map");
+        return;
+    }
+
+    m_pRasterizationRateMap = std::move(pRRM);
+    m_pShadingRateMap       = pView;
+#else
+    (void)pColumnDensity;
+    (void)pRowDensity;
+    UNEXPECTED("Rasterization rate maps are only supported by Metal");
+#endif
+}
+
+void ShadingRateGenerator::Generate(IDeviceContext* pContext, const GenerateAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(Attribs.pColorSRV != nullptr, "Color SRV must not be null");
+    if (Attribs.pColorSRV == nullptr)
+        return;
+
+    ProcessCompletedFrames(pContext);
+
+    FrameData& Frame = m_Frames[m_NextFrame];
+    if (Frame.FenceValue != 0)
+    {
+        // All frames are in flight
+        return;
+    }
+    if (m_Frames.size() > 1 && Frame.pTexture && m_NextFrame == m_ReadyFrame)
+    {
+        // The texture may be used for rendering in this frame
+        return;
+    }
+
+    {
+        MapHelper<GeneratorConstants> Constants{pContext, m_pConstantsBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+        for (Uint32 x = 0; x < 4; ++x)
+        {
+            for (Uint32 y = 0; y < 4; ++y)
+            {
+                const Uint32 Rate          = (x << SHADING_RATE_X_SHIFT) | y;
+                Constants->RateRemap[x][y] = Rate <= SHADING_RATE_MAX ? Uint32{m_RateRemap[Rate]} : Uint32{SHADING_RATE_1X1};
+            }
+        }
+        Constants->ScreenSize                = uint2{m_Width, m_Height};
+        Constants->TileSize                  = m_TileSize;
+        Constants->NumTiles                  = m_NumTiles;
+        Constants->Flags                     = Attribs.pMotionVectorsSRV != nullptr ? GENERATOR_FLAG_MOTION_VECTORS : 0;
+        Constants->LuminanceThreshold        = Attribs.LuminanceThreshold;
+        Constants->MotionVectorScale         = Attribs.MotionVectorScale;
+        Constants->QuarterRateThresholdScale = Attribs.QuarterRateThresholdScale;
+        Constants->MotionSensitivity         = Attribs.MotionSensitivity;
+    }
+
+    m_pColorVar->Set(Attribs.pColorSRV);
+    // The variable must be bound even when motion vectors are not used
+    m_pMotionVectorsVar->Set(Attribs.pMotionVectorsSRV != nullptr ? Attribs.pMotionVectorsSRV : Attribs.pColorSRV);
+
+    ITexture* pOutputTexture = m_pIntermediateTexture ? m_pIntermediateTexture.RawPtr() : Frame.pTexture.RawPtr();
+    if (pOutputTexture != nullptr)
+        m_pOutputVar->Set(pOutputTexture->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+    else
+        pContext->UpdateBuffer(m_pColumnRowBuffer, 0, m_ColumnRowClearData.size() * sizeof(Uint32), m_ColumnRowClearData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    pContext->SetPipelineState(m_pPSO);
+    pContext->CommitShaderResources(m_pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttribs{m_NumTiles.x, m_NumTiles.y, 1};
+    pContext->DispatchCompute(DispatchAttribs);
+
+    if (m_pIntermediateTexture)
+    {
+        CopyTextureAttribs CopyAttribs{m_pIntermediateTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, Frame.pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+    }
+
+    if (Frame.pReadbackBuffer)
+    {
+        pContext->CopyBuffer(m_pColumnRowBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             Frame.pReadbackBuffer, 0, m_ColumnRowClearData.size() * sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    if (m_pFence)
+    {
+        Frame.FenceValue = m_NextFenceValue++;
+        pContext->EnqueueSignal(m_pFence, Frame.FenceValue);
+    }
+
+    m_NextFrame = (m_NextFrame + 1) % static_cast<Uint32>(m_Frames.size());
+}
+
+} // namespace Diligent
@@ -0,0 +1,685 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "SparseTextureStreamer.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+static constexpr Uint32 InvalidPage = ~0u;
+
+SparseTextureStreamer::SparseTextureStreamer(IRenderDevice* pDevice, const SparseTextureStreamerCreateInfo& CI) :
+    // clang-format off
+    m_Name            {CI.Name != nullptr ? CI.Name : "Sparse texture"},
+    m_Format          {CI.Format},
+    m_MaxBindsPerFrame{std::max(CI.MaxBindsPerFrame, 1u)},
+    m_TileLoader      {CI.TileLoader}
+// clang-format on
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("pDevice must not be null");
+    if (CI.Width == 0 || CI.Height == 0)
+        LOG_ERROR_AND_THROW("Texture size (", CI.Width, "x", CI.Height, ") must not be zero");
+    if (CI.NumMemoryPages == 0)
+        LOG_ERROR_AND_THROW("The number of memory pages must not be zero");
+    if (!m_TileLoader)
+        LOG_ERROR_AND_THROW("Tile loader must not be empty");
+    if (!pDevice->GetDeviceInfo().Features.SparseResources)
+        LOG_ERROR_AND_THROW("SparseResources feature is not enabled");
+    if ((pDevice->GetAdapterInfo().SparseResources.CapFlags & SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D) == 0)
+        LOG_ERROR_AND_THROW("Sparse 2D textures are not supported by this device");
+
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = m_Name.c_str();
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = CI.Width;
+        TexDesc.Height    = CI.Height;
+        TexDesc.MipLevels = 0;
+        TexDesc.Format    = m_Format;
+        TexDesc.Usage     = USAGE_SPARSE;
+        TexDesc.BindFlags = CI.BindFlags;
+        pDevice->CreateTexture(TexDesc, nullptr, &m_pTexture);
+        if (!m_pTexture)
+            LOG_ERROR_AND_THROW("Failed to create sparse texture '", m_Name, "'");
+    }
+
+    const SparseTextureProperties& SparseProps = m_pTexture->GetSparseProperties();
+
+    m_NumMipLevels   = m_pTexture->GetDesc().MipLevels;
+    m_FirstMipInTail = SparseProps.FirstMipInTail;
+    m_TileWidth      = SparseProps.TileSize[0];
+    m_TileHeight     = SparseProps.TileSize[1];
+    m_BlockSize      = SparseProps.BlockSize;
+    m_MipTailSize    = SparseProps.MipTailSize;
+    if (m_TileWidth == 0 || m_TileHeight == 0 || m_BlockSize == 0)
+        LOG_ERROR_AND_THROW("Sparse texture '", m_Name, "' has invalid sparse properties");
+    if (m_FirstMipInTail >= m_NumMipLevels || m_MipTailSize == 0)
+        LOG_ERROR_AND_THROW("Sparse texture '", m_Name, "' has no packed mip tail");
+
+    m_NumRegionsX = GetNumTilesX(0);
+    m_NumRegionsY = GetNumTilesY(0);
+    if (m_NumRegionsX > 4096 || m_NumRegionsY > 4096)
+        LOG_ERROR_AND_THROW("The number of tiles (", m_NumRegionsX, "x", m_NumRegionsY, ") of sparse texture '", m_Name, "' must not exceed 4096 in each dimension");
+
+    m_NumMipTailPages = static_cast<Uint32>((m_MipTailSize + m_BlockSize - 1) / m_BlockSize);
+
+    {
+        const std::string Name = m_Name + " - memory";
+
+        IDeviceObject* pCompatibleResource = m_pTexture;
+
+        DeviceMemoryCreateInfo MemCI;
+        MemCI.Desc.Name             = Name.c_str();
+        MemCI.Desc.Type             = DEVICE_MEMORY_TYPE_SPARSE;
+        MemCI.Desc.PageSize         = m_BlockSize;
+        MemCI.InitialSize           = Uint64{m_NumMipTailPages + CI.NumMemoryPages} * m_BlockSize;
+        MemCI.ppCompatibleResources = &pCompatibleResource;
+        MemCI.NumResources          = 1;
+        pDevice->CreateDeviceMemory(MemCI, &m_pMemory);
+        if (!m_pMemory || m_pMemory->GetCapacity() < MemCI.InitialSize)
+            LOG_ERROR_AND_THROW("Failed to create memory for sparse texture '", m_Name, "'");
+    }
+
+    m_ResidencyMap.resize(size_t{m_NumRegionsX} * size_t{m_NumRegionsY}, static_cast<Uint8>(m_FirstMipInTail));
+    {
+        const std::string Name = m_Name + " - residency map";
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = Name.c_str();
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = m_NumRegionsX;
+        TexDesc.Height    = m_NumRegionsY;
+        TexDesc.MipLevels = 1;
+        TexDesc.Format    = TEX_FORMAT_R8_UINT;
+        TexDesc.Usage     = USAGE_DEFAULT;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        TextureSubResData SubResData{m_ResidencyMap.data(), Uint64{m_NumRegionsX}};
+        TextureData       InitData{&SubResData, 1};
+
+        pDevice->CreateTexture(TexDesc, &InitData, &m_pResidencyMap);
+        if (!m_pResidencyMap)
+            LOG_ERROR_AND_THROW("Failed to create residency map for sparse texture '", m_Name, "'");
+    }
+
+    {
+        m_FeedbackClearData.resize(m_ResidencyMap.size(), InvalidFeedback);
+
+        const std::string Name = m_Name + " - feedback";
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = Name.c_str();
+        BuffDesc.Size              = Uint64{m_FeedbackClearData.size()} * sizeof(Uint32);
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS | BIND_SHADER_RESOURCE;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(Uint32);
+
+        BufferData InitData{m_FeedbackClearData.data(), BuffDesc.Size};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &m_pFeedbackBuffer);
+        if (!m_pFeedbackBuffer)
+            LOG_ERROR_AND_THROW("Failed to create feedback buffer for sparse texture '", m_Name, "'");
+
+        const std::string ReadbackName = m_Name + " - feedback readback";
+
+        BuffDesc.Name              = ReadbackName.c_str();
+        BuffDesc.Usage             = USAGE_STAGING;
+        BuffDesc.BindFlags         = BIND_NONE;
+        BuffDesc.Mode              = BUFFER_MODE_UNDEFINED;
+        BuffDesc.ElementByteStride = 0;
+        BuffDesc.CPUAccessFlags    = CPU_ACCESS_READ;
+
+        // The feedback written in frame N is read back in frame N + FeedbackLatency
+        m_FeedbackReadbackBuffers.resize(std::max(CI.FeedbackLatency, 1u));
+        m_FeedbackReadbackFenceValues.resize(m_FeedbackReadbackBuffers.size());
+        for (RefCntAutoPtr<IBuffer>& pReadbackBuffer : m_FeedbackReadbackBuffers)
+        {
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pReadbackBuffer);
+            if (!pReadbackBuffer)
+                LOG_ERROR_AND_THROW("Failed to create feedback readback buffer for sparse texture '", m_Name, "'");
+        }
+    }
+
+    {
+        FenceDesc FncDesc;
+        FncDesc.Name = "Sparse texture frame fence";
+        FncDesc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+        pDevice->CreateFence(FncDesc, &m_pFrameFence);
+        if (!m_pFrameFence)
+            LOG_ERROR_AND_THROW("Failed to create frame fence for sparse texture '", m_Name, "'");
+    }
+
+    if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D11)
+    {
+        FenceDesc FncDesc;
+        FncDesc.Name = "Sparse texture bind fence";
+        FncDesc.Type = FENCE_TYPE_GENERAL;
+        pDevice->CreateFence(FncDesc, &m_pBindFence);
+        if (!m_pBindFence)
+            LOG_ERROR_AND_THROW("Failed to create bind fence for sparse texture '", m_Name, "'");
+    }
+
+    // Allocate pages with lower indices first
+    m_FreePages.reserve(CI.NumMemoryPages);
+    for (Uint32 Page = m_NumMipTailPages + CI.NumMemoryPages; Page > m_NumMipTailPages; --Page)
+        m_FreePages.push_back(Page - 1);
+}
+
+SparseTextureStreamer::~SparseTextureStreamer() = default;
+
+Uint32 SparseTextureStreamer::GetNumTilesX(Uint32 MipLevel) const
+{
+    const Uint32 MipWidth = std::max(m_pTexture->GetDesc().Width >> MipLevel, 1u);
+    return (MipWidth + m_TileWidth - 1) / m_TileWidth;
+}
+
+Uint32 SparseTextureStreamer::GetNumTilesY(Uint32 MipLevel) const
+{
+    const Uint32 MipHeight = std::max(m_pTexture->GetDesc().Height >> MipLevel, 1u);
+    return (MipHeight + m_TileHeight - 1) / m_TileHeight;
+}
+
+bool SparseTextureStreamer::IsValidTile(const SparseTextureTile& Tile) const
+{
+    return Tile.MipLevel < m_FirstMipInTail && Tile.X < GetNumTilesX(Tile.MipLevel) && Tile.Y < GetNumTilesY(Tile.MipLevel);
+}
+
+Box SparseTextureStreamer::GetTileRegion(const SparseTextureTile& Tile) const
+{
+    const Uint32 MipWidth  = std::max(m_pTexture->GetDesc().Width >> Tile.MipLevel, 1u);
+    const Uint32 MipHeight = std::max(m_pTexture->GetDesc().Height >> Tile.MipLevel, 1u);
+    if (Tile.MipLevel >= m_FirstMipInTail)
+        return Box{0, MipWidth, 0, MipHeight};
+
+    const Uint32 MinX = Tile.X * m_TileWidth;
+    const Uint32 MinY = Tile.Y * m_TileHeight;
+    return Box{MinX, std::min(MinX + m_TileWidth, MipWidth), MinY, std::min(MinY + m_TileHeight, MipHeight)};
+}
+
+void SparseTextureStreamer::AnalyzeFeedback(const Uint32* pFeedback, size_t NumEntries)
+{
+    DEV_CHECK_ERR(pFeedback != nullptr || NumEntries == 0, "pFeedback must not be null");
+    DEV_CHECK_ERR(NumEntries <= m_ResidencyMap.size(), "The number of feedback entries (", NumEntries, ") exceeds the number of regions (", m_ResidencyMap.size(), ")");
+    NumEntries = std::min(NumEntries, m_ResidencyMap.size());
+
+    for (size_t i = 0; i < NumEntries; ++i)
+    {
+        const Uint32 DesiredMip = pFeedback[i];
+        // The mip tail is always resident
+        if (DesiredMip >= m_FirstMipInTail)
+            continue;
+
+        const Uint32 RegionX = static_cast<Uint32>(i % m_NumRegionsX);
+        const Uint32 RegionY = static_cast<Uint32>(i / m_NumRegionsX);
+
+        // Request the tile and all its ancestors so that the region falls back
+        // to the finest available mip level while the tiles are being bound.
+        for (Uint32 Mip = DesiredMip; Mip < m_FirstMipInTail; ++Mip)
+        {
+            const Uint32 Key = EncodeTile({RegionX >> Mip, RegionY >> Mip, Mip});
+
+            auto ResidentIt = m_ResidentTiles.find(Key);
+            if (ResidentIt != m_ResidentTiles.end())
+            {
+                if (ResidentIt->second.LastUsedFrame == m_FrameIndex)
+                {
+                    // All ancestors have already been processed
+                    break;
+                }
+                ResidentIt->second.LastUsedFrame = m_FrameIndex;
+            }
+            else if (m_FailedTiles.find(Key) == m_FailedTiles.end())
+            {
+                ++m_RequestedTiles[Key];
+            }
+        }
+    }
+}
+
+void SparseTextureStreamer::ReadBackFeedback(IDeviceContext* pContext)
+{
+    IBuffer* pReadbackBuffer = m_FeedbackReadbackBuffers[m_NextFeedbackReadback];
+    Uint64&  FenceValue      = m_FeedbackReadbackFenceValues[m_NextFeedbackReadback];
+    if (FenceValue != 0)
+    {
+        if (m_pFrameFence->GetCompletedValue() < FenceValue)
+        {
+            // The GPU has not finished writing the feedback to the readback buffer yet.
+            // Keep accumulating the feedback in the feedback buffer.
+            return;
+        }
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pReadbackBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        if (pData != nullptr)
+        {
+            AnalyzeFeedback(static_cast<const Uint32*>(pData), m_FeedbackClearData.size());
+            pContext->UnmapBuffer(pReadbackBuffer, MAP_READ);
+        }
+        FenceValue = 0;
+    }
+
+    pContext->CopyBuffer(m_pFeedbackBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pReadbackBuffer, 0, m_pFeedbackBuffer->GetDesc().Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    // The frame fence is signaled with the frame index at the end of Update()
+    FenceValue = m_FrameIndex;
+
+    pContext->UpdateBuffer(m_pFeedbackBuffer, 0, m_pFeedbackBuffer->GetDesc().Size, m_FeedbackClearData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    m_NextFeedbackReadback = (m_NextFeedbackReadback + 1) % static_cast<Uint32>(m_FeedbackReadbackBuffers.size());
+}
+
+void SparseTextureStreamer::ProcessPendingUnbinds()
+{
+    const Uint64 CompletedValue = m_pFrameFence->GetCompletedValue();
+
+    auto UnbindIt = m_PendingUnbinds.begin();
+    while (UnbindIt != m_PendingUnbinds.end())
+    {
+        if (UnbindIt->FenceValue > CompletedValue)
+        {
+            ++UnbindIt;
+            continue;
+        }
+
+        // The page may be bound to another tile by the same batch
+        m_TilesToUnbind.push_back(UnbindIt->Tile);
+        m_FreePages.push_back(UnbindIt->Page);
+        UnbindIt = m_PendingUnbinds.erase(UnbindIt);
+    }
+}
+
+Uint32 SparseTextureStreamer::AllocatePage()
+{
+    if (m_FreePages.empty())
+        return InvalidPage;
+
+    const Uint32 Page = m_FreePages.back();
+    m_FreePages.pop_back();
+    return Page;
+}
+
+bool SparseTextureStreamer::EvictTile()
+{
+    // Find the least recently used tile that has no resident finer tiles. Tiles used in the
+    // current frame are never evicted as this would make the tiles compete for the pool every frame.
+    auto LRUIt = m_ResidentTiles.end();
+    for (auto it = m_ResidentTiles.begin(); it != m_ResidentTiles.end(); ++it)
+    {
+        const ResidentTile& TileInfo = it->second;
+        if (TileInfo.NumResidentChildren != 0 || TileInfo.LastUsedFrame >= m_FrameIndex)
+            continue;
+
+        if (LRUIt == m_ResidentTiles.end() || TileInfo.LastUsedFrame < LRUIt->second.LastUsedFrame)
+            LRUIt = it;
+    }
+    if (LRUIt == m_ResidentTiles.end())
+        return false;
+
+    const Uint32            Key  = LRUIt->first;
+    const Uint32            Page = LRUIt->second.Page;
+    const SparseTextureTile Tile = DecodeTile(Key);
+    m_ResidentTiles.erase(LRUIt);
+
+    if (Tile.MipLevel + 1 < m_FirstMipInTail)
+    {
+        auto ParentIt = m_ResidentTiles.find(EncodeTile({Tile.X >> 1, Tile.Y >> 1, Tile.MipLevel + 1}));
+        VERIFY(ParentIt != m_ResidentTiles.end() && ParentIt->second.NumResidentChildren > 0, "The parent of a resident tile must be resident");
+        if (ParentIt != m_ResidentTiles.end())
+            --ParentIt->second.NumResidentChildren;
+    }
+
+    // Exclude the tile from the residency map now, but unbind it only when the GPU
+    // has finished all frames that may still sample it.
+    UpdateResidency(Tile, false);
+    m_PendingUnbinds.push_back({Key, Page, m_FrameIndex});
+
+    return true;
+}
+
+void SparseTextureStreamer::StartBinds()
+{
+    m_NumRequestedTiles = static_cast<Uint32>(m_RequestedTiles.size());
+    if (m_RequestedTiles.empty())
+        return;
+
+    std::vector<std::pair<Uint32, Uint32>> Requests{m_RequestedTiles.begin(), m_RequestedTiles.end()};
+    m_RequestedTiles.clear();
+
+    // Bind coarse mip levels first since finer tiles require them, then the most requested tiles
+    std::sort(Requests.begin(), Requests.end(),
+              [](const std::pair<Uint32, Uint32>& lhs, const std::pair<Uint32, Uint32>& rhs) {
+                  const Uint32 lhsMip = lhs.first >> 24u;
+                  const Uint32 rhsMip = rhs.first >> 24u;
+                  if (lhsMip != rhsMip)
+                      return lhsMip > rhsMip;
+                  if (lhs.second != rhs.second)
+                      return lhs.second > rhs.second;
+                  return lhs.first < rhs.first;
+              });
+
+    Uint32 NumEvictedTiles = 0;
+    for (const auto& Request : Requests)
+    {
+        if (m_PendingBinds.size() >= m_MaxBindsPerFrame)
+            break;
+
+        const Uint32            Key  = Request.first;
+        const SparseTextureTile Tile = DecodeTile(Key);
+        if (m_ResidentTiles.find(Key) != m_ResidentTiles.end())
+            continue;
+
+        // Wait until the previous binding of the tile is released
+        if (std::find_if(m_PendingUnbinds.begin(), m_PendingUnbinds.end(), [Key](const PendingUnbind& Unbind) { return Unbind.Tile == Key; }) != m_PendingUnbinds.end() ||
+            std::find(m_TilesToUnbind.begin(), m_TilesToUnbind.end(), Key) != m_TilesToUnbind.end())
+            continue;
+
+        ResidentTile* pParent = nullptr;
+        if (Tile.MipLevel + 1 < m_FirstMipInTail)
+        {
+            auto ParentIt = m_ResidentTiles.find(EncodeTile({Tile.X >> 1, Tile.Y >> 1, Tile.MipLevel + 1}));
+            if (ParentIt == m_ResidentTiles.end())
+            {
+                // The parent could not be bound in this frame
+                continue;
+            }
+            pParent = &ParentIt->second;
+        }
+
+        const Uint32 Page = AllocatePage();
+        if (Page == InvalidPage)
+        {
+            // Evicted pages become available when the GPU is done with them
+            if (NumEvictedTiles < m_MaxBindsPerFrame && EvictTile())
+                ++NumEvictedTiles;
+            continue;
+        }
+
+        ResidentTile& TileInfo = m_ResidentTiles[Key];
+        TileInfo.Page          = Page;
+        TileInfo.LastUsedFrame = m_FrameIndex;
+        if (pParent != nullptr)
+            ++pParent->NumResidentChildren;
+
+        m_PendingBinds.push_back({Key, Page});
+    }
+}
+
+void SparseTextureStreamer::SubmitBinds(IDeviceContext* pContext, IDeviceContext* pBindingContext)
+{
+    if (m_MipTailBound && m_PendingBinds.empty() && m_TilesToUnbind.empty())
+        return;
+
+    std::vector<SparseTextureMemoryBindRange> BindRanges;
+    BindRanges.reserve(m_NumMipTailPages + m_PendingBinds.size() + m_TilesToUnbind.size());
+
+    if (!m_MipTailBound)
+    {
+        for (Uint32 Page = 0; Page < m_NumMipTailPages; ++Page)
+        {
+            BindRanges.emplace_back();
+            SparseTextureMemoryBindRange& Range = BindRanges.back();
+
+            Range.MipLevel        = m_FirstMipInTail;
+            Range.OffsetInMipTail = Page * m_BlockSize;
+            Range.MemoryOffset    = Page * m_BlockSize;
+            Range.MemorySize      = m_BlockSize;
+            Range.pMemory         = m_pMemory;
+        }
+    }
+
+    for (const PendingBind& Bind : m_PendingBinds)
+    {
+        const SparseTextureTile Tile = DecodeTile(Bind.Tile);
+
+        BindRanges.emplace_back();
+        SparseTextureMemoryBindRange& Range = BindRanges.back();
+
+        Range.MipLevel     = Tile.MipLevel;
+        Range.Region       = GetTileRegion(Tile);
+        Range.MemoryOffset = Bind.Page * m_BlockSize;
+        Range.MemorySize   = m_BlockSize;
+        Range.pMemory      = m_pMemory;
+    }
+
+    for (Uint32 Key : m_TilesToUnbind)
+    {
+        const SparseTextureTile Tile = DecodeTile(Key);
+
+        BindRanges.emplace_back();
+        SparseTextureMemoryBindRange& Range = BindRanges.back();
+
+        Range.MipLevel   = Tile.MipLevel;
+        Range.Region     = GetTileRegion(Tile);
+        Range.MemorySize = m_BlockSize;
+    }
+    m_NumUnboundTiles += m_TilesToUnbind.size();
+    m_TilesToUnbind.clear();
+
+    SparseTextureMemoryBindInfo TexBind;
+    TexBind.pTexture  = m_pTexture;
+    TexBind.pRanges   = BindRanges.data();
+    TexBind.NumRanges = static_cast<Uint32>(BindRanges.size());
+
+    BindSparseResourceMemoryAttribs BindAttribs;
+    BindAttribs.pTextureBinds   = &TexBind;
+    BindAttribs.NumTextureBinds = 1;
+
+    IFence*      pSignalFence = m_pBindFence;
+    const Uint64 SignalValue  = m_NextBindFenceValue;
+    if (pSignalFence != nullptr)
+    {
+        BindAttribs.ppSignalFences     = &pSignalFence;
+        BindAttribs.pSignalFenceValues = &SignalValue;
+        BindAttribs.NumSignalFences    = 1;
+        ++m_NextBindFenceValue;
+    }
+    pBindingContext->BindSparseResourceMemory(BindAttribs);
+    ++m_NumBindBatches;
+
+    // The tiles must be bound before they are written
+    if (pSignalFence != nullptr)
+        pContext->DeviceWaitForFence(pSignalFence, SignalValue);
+
+    if (!m_MipTailBound)
+    {
+        for (Uint32 Mip = m_FirstMipInTail; Mip < m_NumMipLevels; ++Mip)
+        {
+            if (!LoadTile(pContext, {0, 0, Mip}))
+                LOG_WARNING_MESSAGE("Failed to load mip level ", Mip, " of the mip tail of sparse texture '", m_Name, "'");
+        }
+        m_MipTailBound = true;
+    }
+
+    // Binds are sorted from coarse to fine mip levels, so parents are loaded before their children
+    for (const PendingBind& Bind : m_PendingBinds)
+    {
+        const SparseTextureTile Tile = DecodeTile(Bind.Tile);
+
+        auto ParentIt = m_ResidentTiles.end();
+
+        bool IsParentResident = true;
+        if (Tile.MipLevel + 1 < m_FirstMipInTail)
+        {
+            ParentIt         = m_ResidentTiles.find(EncodeTile({Tile.X >> 1, Tile.Y >> 1, Tile.MipLevel + 1}));
+            IsParentResident = ParentIt != m_ResidentTiles.end();
+        }
+
+        if (IsParentResident && LoadTile(pContext, Tile))
+        {
+            UpdateResidency(Tile, true);
+            ++m_NumBoundTiles;
+            continue;
+        }
+
+        if (IsParentResident)
+        {
+            LOG_WARNING_MESSAGE("Failed to load tile (", Tile.X, ", ", Tile.Y, ") of mip level ", Tile.MipLevel,
+                                " of sparse texture '", m_Name, "'");
+            m_FailedTiles.insert(Bind.Tile);
+            ++m_NumFailedTiles;
+        }
+        // Otherwise the parent has failed to load, the tile may be requested again later.
+
+        m_ResidentTiles.erase(Bind.Tile);
+        if (ParentIt != m_ResidentTiles.end())
+            --ParentIt->second.NumResidentChildren;
+
+        // The tile has never been visible to the GPU
+        m_PendingUnbinds.push_back({Bind.Tile, Bind.Page, m_FrameIndex});
+    }
+    m_PendingBinds.clear();
+}
+
+bool SparseTextureStreamer::LoadTile(IDeviceContext* pContext, const SparseTextureTile& Tile)
+{
+    const Box Region = GetTileRegion(Tile);
+
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(m_Format);
+
+    Uint64 RowSize = 0;
+    Uint32 NumRows = 0;
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+    {
+        RowSize = Uint64{(Region.Width() + FmtAttribs.BlockWidth - 1u) / FmtAttribs.BlockWidth} * FmtAttribs.GetElementSize();
+        NumRows = (Region.Height() + FmtAttribs.BlockHeight - 1u) / FmtAttribs.BlockHeight;
+    }
+    else
+    {
+        RowSize = Uint64{Region.Width()} * FmtAttribs.GetElementSize();
+        NumRows = Region.Height();
+    }
+
+    m_LoadData.resize(static_cast<size_t>(RowSize * NumRows));
+    const MappedTextureSubresource Data{m_LoadData.data(), RowSize, RowSize * NumRows};
+    if (!m_TileLoader(Tile, Region, Data))
+        return false;
+
+    TextureSubResData SubresData{m_LoadData.data(), RowSize};
+    pContext->UpdateTexture(m_pTexture, Tile.MipLevel, 0, Region, SubresData, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    return true;
+}
+
+void SparseTextureStreamer::UpdateResidency(const SparseTextureTile& Tile, bool IsResident)
+{
+    const Uint32 Shift = Tile.MipLevel;
+
+    const Uint32 MinX = std::min(Tile.X << Shift, m_NumRegionsX - 1);
+    const Uint32 MinY = std::min(Tile.Y << Shift, m_NumRegionsY - 1);
+    const Uint32 MaxX = std::min((Tile.X + 1) << Shift, m_NumRegionsX);
+    const Uint32 MaxY = std::min((Tile.Y + 1) << Shift, m_NumRegionsY);
+
+    // Only tiles without resident children are evicted, so the finest resident mip level
+    // of all regions covered by the evicted tile becomes the mip level of its parent.
+    for (Uint32 y = MinY; y < MaxY; ++y)
+    {
+        for (Uint32 x = MinX; x < MaxX; ++x)
+        {
+            Uint8& ResidentMip = m_ResidencyMap[size_t{y} * m_NumRegionsX + x];
+            ResidentMip        = IsResident ?
+                static_cast<Uint8>(std::min(Uint32{ResidentMip}, Tile.MipLevel)) :
+                static_cast<Uint8>(std::max(Uint32{ResidentMip}, Tile.MipLevel + 1));
+        }
+    }
+
+    if (m_DirtyRegion.MaxX == 0)
+    {
+        m_DirtyRegion = Box{MinX, MaxX, MinY, MaxY};
+    }
+    else
+    {
+        m_DirtyRegion.MinX = std::min(m_DirtyRegion.MinX, MinX);
+        m_DirtyRegion.MaxX = std::max(m_DirtyRegion.MaxX, MaxX);
+        m_DirtyRegion.MinY = std::min(m_DirtyRegion.MinY, MinY);
+        m_DirtyRegion.MaxY = std::max(m_DirtyRegion.MaxY, MaxY);
+    }
+}
+
+void SparseTextureStreamer::UploadResidencyMap(IDeviceContext* pContext)
+{
+    if (m_DirtyRegion.MaxX == 0)
+        return;
+
+    TextureSubResData SubresData{&m_ResidencyMap[size_t{m_DirtyRegion.MinY} * m_NumRegionsX + m_DirtyRegion.MinX], Uint64{m_NumRegionsX}};
+    pContext->UpdateTexture(m_pResidencyMap, 0, 0, m_DirtyRegion, SubresData, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    m_DirtyRegion = Box{};
+}
+
+void SparseTextureStreamer::Update(IDeviceContext* pContext, IDeviceContext* pBindingContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "pContext must not be null");
+    if (pBindingContext == nullptr)
+        pBindingContext = pContext;
+
+    ReadBackFeedback(pContext);
+    ProcessPendingUnbinds();
+    StartBinds();
+    SubmitBinds(pContext, pBindingContext);
+    UploadResidencyMap(pContext);
+
+    pContext->EnqueueSignal(m_pFrameFence, m_FrameIndex);
+    ++m_FrameIndex;
+}
+
+Uint32 SparseTextureStreamer::GetResidentMip(Uint32 RegionX, Uint32 RegionY) const
+{
+    DEV_CHECK_ERR(RegionX < m_NumRegionsX && RegionY < m_NumRegionsY, "Region (", RegionX, ", ", RegionY, ") is out of range");
+    if (RegionX >= m_NumRegionsX || RegionY >= m_NumRegionsY)
+        return m_FirstMipInTail;
+
+    return m_ResidencyMap[size_t{RegionY} * m_NumRegionsX + RegionX];
+}
+
+bool SparseTextureStreamer::IsTileResident(const SparseTextureTile& Tile) const
+{
+    if (Tile.MipLevel >= m_FirstMipInTail)
+        return m_MipTailBound && Tile.MipLevel < m_NumMipLevels && Tile.X == 0 && Tile.Y == 0;
+
+    return IsValidTile(Tile) && m_ResidentTiles.find(EncodeTile(Tile)) != m_ResidentTiles.end();
+}
+
+SparseTextureStreamerStats SparseTextureStreamer::GetStats() const
+{
+    SparseTextureStreamerStats Stats;
+    Stats.NumResidentTiles  = static_cast<Uint32>(m_ResidentTiles.size());
+    Stats.NumFreePages      = static_cast<Uint32>(m_FreePages.size());
+    Stats.NumPendingUnbinds = static_cast<Uint32>(m_PendingUnbinds.size());
+    Stats.NumRequestedTiles = m_NumRequestedTiles;
+    Stats.NumBoundTiles     = m_NumBoundTiles;
+    Stats.NumUnboundTiles   = m_NumUnboundTiles;
+    Stats.NumFailedTiles    = m_NumFailedTiles;
+    Stats.NumBindBatches    = m_NumBindBatches;
+    return Stats;
+}
+
+} // namespace Diligent
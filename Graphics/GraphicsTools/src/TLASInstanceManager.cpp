@@ -0,0 +1,277 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TLASInstanceManager.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+constexpr TLASInstanceManager::InstanceHandle TLASInstanceManager::InvalidHandle;
+
+TLASInstanceManager::TLASInstanceManager(IRenderDevice* pDevice, const TLASInstanceManagerCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Name{CI.Name != nullptr ? CI.Name : "TLAS instance manager"},
+    m_CI{CI}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Device must not be null");
+    if (!m_pDevice->GetDeviceInfo().Features.RayTracing)
+        LOG_ERROR_AND_THROW("TLAS instance manager requires ray tracing");
+
+    if (CI.InitialCapacity != 0)
+        ReserveResources(CI.InitialCapacity);
+}
+
+Uint32 TLASInstanceManager::GetSlot(InstanceHandle Handle) const
+{
+    DEV_CHECK_ERR(Handle < m_HandleSlots.size() && m_HandleSlots[Handle] != ~0u, "Invalid instance handle ", Handle);
+    return m_HandleSlots[Handle];
+}
+
+void TLASInstanceManager::MarkDirty(Uint32 Slot)
+{
+    if (!m_DirtyFlags[Slot])
+    {
+        m_DirtyFlags[Slot] = true;
+        ++m_NumDirtyInstances;
+    }
+}
+
+TLASInstanceManager::InstanceHandle TLASInstanceManager::AddInstance(const TLASBuildInstanceData& Data)
+{
+    DEV_CHECK_ERR(Data.pBLAS != nullptr, "Instance BLAS must not be null");
+
+    InstanceHandle Handle = InvalidHandle;
+    if (!m_FreeHandles.empty())
+    {
+        Handle = m_FreeHandles.back();
+        m_FreeHandles.pop_back();
+    }
+    else
+    {
+        Handle = static_cast<InstanceHandle>(m_HandleSlots.size());
+        m_HandleSlots.emplace_back();
+    }
+
+    const Uint32 Slot     = static_cast<Uint32>(m_Instances.size());
+    m_HandleSlots[Handle] = Slot;
+
+    m_Instances.emplace_back(Data);
+    m_InstanceNames.emplace_back(Data.InstanceName != nullptr ? std::string{Data.InstanceName} : "Instance " + std::to_string(Handle));
+    m_InstanceBLASes.emplace_back(Data.pBLAS);
+    m_InstanceHandles.emplace_back(Handle);
+    m_DirtyFlags.emplace_back(false);
+
+    // Name pointers are updated before the rebuild
+    m_Instances.back().InstanceName = nullptr;
+    m_RebuildRequired               = true;
+
+    return Handle;
+}
+
+void TLASInstanceManager::RemoveInstance(InstanceHandle Handle)
+{
+    const Uint32 Slot     = GetSlot(Handle);
+    const Uint32 LastSlot = static_cast<Uint32>(m_Instances.size() - 1);
+
+    if (m_DirtyFlags[Slot])
+        --m_NumDirtyInstances;
+
+    // Move the last instance into the slot
+    if (Slot != LastSlot)
+    {
+        m_Instances[Slot]       = m_Instances[LastSlot];
+        m_InstanceNames[Slot]   = std::move(m_InstanceNames[LastSlot]);
+        m_InstanceBLASes[Slot]  = std::move(m_InstanceBLASes[LastSlot]);
+        m_InstanceHandles[Slot] = m_InstanceHandles[LastSlot];
+        m_DirtyFlags[Slot]      = m_DirtyFlags[LastSlot];
+
+        m_HandleSlots[m_InstanceHandles[Slot]] = Slot;
+    }
+    m_Instances.pop_back();
+    m_InstanceNames.pop_back();
+    m_InstanceBLASes.pop_back();
+    m_InstanceHandles.pop_back();
+    m_DirtyFlags.pop_back();
+
+    m_HandleSlots[Handle] = ~0u;
+    m_FreeHandles.push_back(Handle);
+
+    m_RebuildRequired = true;
+}
+
+void TLASInstanceManager::SetTransform(InstanceHandle Handle, const InstanceMatrix& Transform)
+{
+    const Uint32 Slot = GetSlot(Handle);
+
+    m_Instances[Slot].Transform = Transform;
+    MarkDirty(Slot);
+}
+
+void TLASInstanceManager::SetInstance(InstanceHandle Handle, const TLASBuildInstanceData& Data)
+{
+    DEV_CHECK_ERR(Data.pBLAS != nullptr, "Instance BLAS must not be null");
+
+    const Uint32 Slot = GetSlot(Handle);
+
+    TLASBuildInstanceData& Inst = m_Instances[Slot];
+
+    const char* Name  = Inst.InstanceName;
+    Inst              = Data;
+    Inst.InstanceName = Name;
+
+    m_InstanceBLASes[Slot] = Data.pBLAS;
+    MarkDirty(Slot);
+}
+
+const TLASBuildInstanceData& TLASInstanceManager::GetInstance(InstanceHandle Handle) const
+{
+    return m_Instances[GetSlot(Handle)];
+}
+
+const char* TLASInstanceManager::GetInstanceName(InstanceHandle Handle) const
+{
+    return m_InstanceNames[GetSlot(Handle)].c_str();
+}
+
+void TLASInstanceManager::ReserveResources(Uint32 InstanceCount)
+{
+    if (!m_pTLAS || m_pTLAS->GetDesc().MaxInstanceCount < InstanceCount)
+    {
+        const Uint32 Capacity = m_pTLAS ? std::max(InstanceCount, m_pTLAS->GetDesc().MaxInstanceCount * 3 / 2) : InstanceCount;
+
+        // The old TLAS is kept alive by the engine until the GPU stops using it
+        m_pTLAS.Release();
+        m_pInstanceBuffer.Release();
+
+        {
+            TopLevelASDesc Desc;
+            Desc.Name             = m_Name.c_str();
+            Desc.MaxInstanceCount = Capacity;
+            Desc.Flags            = m_CI.Flags;
+            m_pDevice->CreateTLAS(Desc, &m_pTLAS);
+            if (!m_pTLAS)
+                LOG_ERROR_AND_THROW("Failed to create the TLAS with capacity ", Capacity);
+        }
+
+        {
+            const std::string Name = m_Name + " - instances";
+
+            BufferDesc Desc;
+            Desc.Name      = Name.c_str();
+            Desc.Usage     = USAGE_DEFAULT;
+            Desc.BindFlags = BIND_RAY_TRACING;
+            Desc.Size      = Uint64{Capacity} * TLAS_INSTANCE_DATA_SIZE;
+            m_pDevice->CreateBuffer(Desc, nullptr, &m_pInstanceBuffer);
+            if (!m_pInstanceBuffer)
+                LOG_ERROR_AND_THROW("Failed to create the instance buffer");
+        }
+    }
+
+    const ScratchBufferSizes ScratchSizes = m_pTLAS->GetScratchBufferSizes();
+    const Uint64             ScratchSize  = std::max(ScratchSizes.Build, ScratchSizes.Update);
+    if (!m_pScratchBuffer || m_pScratchBuffer->GetDesc().Size < ScratchSize)
+    {
+        m_pScratchBuffer.Release();
+
+        const std::string Name = m_Name + " - scratch buffer";
+
+        BufferDesc Desc;
+        Desc.Name      = Name.c_str();
+        Desc.Usage     = USAGE_DEFAULT;
+        Desc.BindFlags = BIND_RAY_TRACING;
+        Desc.Size      = ScratchSize;
+        m_pDevice->CreateBuffer(Desc, nullptr, &m_pScratchBuffer);
+        if (!m_pScratchBuffer)
+            LOG_ERROR_AND_THROW("Failed to create the scratch buffer");
+    }
+}
+
+TLASInstanceManager::BUILD_TYPE TLASInstanceManager::Build(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    if (m_Instances.empty() || (!m_RebuildRequired && m_NumDirtyInstances == 0))
+        return BUILD_TYPE_NONE;
+
+    const Uint32 InstanceCount = GetInstanceCount();
+
+    bool Rebuild = m_RebuildRequired || !m_pTLAS || (m_CI.Flags & RAYTRACING_BUILD_AS_ALLOW_UPDATE) == 0;
+    if (!Rebuild)
+    {
+        m_NumChangesSinceRebuild += m_NumDirtyInstances;
+        Rebuild = static_cast<double>(m_NumChangesSinceRebuild) > static_cast<double>(m_CI.RebuildThreshold) * InstanceCount;
+    }
+
+    if (Rebuild)
+    {
+        try
+        {
+            ReserveResources(InstanceCount);
+        }
+        catch (...)
+        {
+            return BUILD_TYPE_NONE;
+        }
+
+        // Names may have been moved by adding or removing instances
+        for (size_t i = 0; i < m_Instances.size(); ++i)
+            m_Instances[i].InstanceName = m_InstanceNames[i].c_str();
+    }
+
+    BuildTLASAttribs Attribs;
+    Attribs.pTLAS                           = m_pTLAS;
+    Attribs.TLASTransitionMode              = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.BLASTransitionMode              = m_CI.BLASTransitionMode;
+    Attribs.pInstances                      = m_Instances.data();
+    Attribs.InstanceCount                   = InstanceCount;
+    Attribs.pInstanceBuffer                 = m_pInstanceBuffer;
+    Attribs.InstanceBufferTransitionMode    = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.HitGroupStride                  = m_CI.HitGroupStride;
+    Attribs.BaseContributionToHitGroupIndex = m_CI.BaseContributionToHitGroupIndex;
+    Attribs.BindingMode                     = m_CI.BindingMode;
+    Attribs.pScratchBuffer                  = m_pScratchBuffer;
+    Attribs.ScratchBufferTransitionMode     = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.Update                          = !Rebuild;
+    pContext->BuildTLAS(Attribs);
+
+    std::fill(m_DirtyFlags.begin(), m_DirtyFlags.end(), false);
+    m_NumDirtyInstances = 0;
+    if (Rebuild)
+    {
+        m_NumChangesSinceRebuild = 0;
+        m_RebuildRequired        = false;
+    }
+
+    return Rebuild ? BUILD_TYPE_REBUILD : BUILD_TYPE_UPDATE;
+}
+
+} // namespace Diligent
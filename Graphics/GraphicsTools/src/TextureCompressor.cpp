@@ -0,0 +1,800 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TextureCompressor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "GraphicsAccessories.hpp"
+#include "DebugUtilities.hpp"
+#include "ThreadPool.hpp"
+#include "Intrinsics.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Texels of a 4x4 block in the structure of arrays layout
+template <Uint32 NumChannels>
+struct BlockTexels
+{
+    alignas(16) float Channels[NumChannels][16];
+};
+
+// Finds the nearest palette entry for every texel of the block and returns the total squared error.
+// The palette contains PaletteSize entries of NumChannels values each.
+template <Uint32 NumChannels>
+float FindNearestIndices(const BlockTexels<NumChannels>& Texels, const float* Palette, Uint32 PaletteSize, Uint8* Indices)
+{
+    float TotalError = 0;
+#if DILIGENT_SSE2_ENABLED
+    for (Uint32 t = 0; t < 16; t += 4)
+    {
+        __m128 Texel[NumChannels];
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Texel[c] = _mm_load_ps(&Texels.Channels[c][t]);
+
+        __m128  BestError = _mm_set1_ps(FLT_MAX);
+        __m128i BestIndex = _mm_setzero_si128();
+        for (Uint32 p = 0; p < PaletteSize; ++p)
+        {
+            __m128 Error = _mm_setzero_ps();
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const __m128 Diff = _mm_sub_ps(Texel[c], _mm_set1_ps(Palette[p * NumChannels + c]));
+                Error             = _mm_add_ps(Error, _mm_mul_ps(Diff, Diff));
+            }
+            const __m128i IsBetter = _mm_castps_si128(_mm_cmplt_ps(Error, BestError));
+            BestError              = _mm_min_ps(Error, BestError);
+            BestIndex              = _mm_or_si128(_mm_and_si128(IsBetter, _mm_set1_epi32(static_cast<int>(p))), _mm_andnot_si128(IsBetter, BestIndex));
+        }
+
+        alignas(16) Int32 BestIndices[4];
+        alignas(16) float BestErrors[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(BestIndices), BestIndex);
+        _mm_store_ps(BestErrors, BestError);
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            Indices[t + i] = static_cast<Uint8>(BestIndices[i]);
+            TotalError += BestErrors[i];
+        }
+    }
+#elif DILIGENT_NEON_ENABLED
+    for (Uint32 t = 0; t < 16; t += 4)
+    {
+        float32x4_t Texel[NumChannels];
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Texel[c] = vld1q_f32(&Texels.Channels[c][t]);
+
+        float32x4_t BestError = vdupq_n_f32(FLT_MAX);
+        uint32x4_t  BestIndex = vdupq_n_u32(0);
+        for (Uint32 p = 0; p < PaletteSize; ++p)
+        {
+            float32x4_t Error = vdupq_n_f32(0);
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const float32x4_t Diff = vsubq_f32(Texel[c], vdupq_n_f32(Palette[p * NumChannels + c]));
+                Error                  = vmlaq_f32(Error, Diff, Diff);
+            }
+            const uint32x4_t IsBetter = vcltq_f32(Error, BestError);
+            BestError                 = vminq_f32(Error, BestError);
+            BestIndex                 = vbslq_u32(IsBetter, vdupq_n_u32(p), BestIndex);
+        }
+
+        Uint32 BestIndices[4];
+        float  BestErrors[4];
+        vst1q_u32(BestIndices, BestIndex);
+        vst1q_f32(BestErrors, BestError);
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            Indices[t + i] = static_cast<Uint8>(BestIndices[i]);
+            TotalError += BestErrors[i];
+        }
+    }
+#else
+    for (Uint32 t = 0; t < 16; ++t)
+    {
+        float BestError = FLT_MAX;
+        for (Uint32 p = 0; p < PaletteSize; ++p)
+        {
+            float Error = 0;
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const float Diff = Texels.Channels[c][t] - Palette[p * NumChannels + c];
+                Error += Diff * Diff;
+            }
+            if (Error < BestError)
+            {
+                BestError  = Error;
+                Indices[t] = static_cast<Uint8>(p);
+            }
+        }
+        TotalError += BestError;
+    }
+#endif
+    return TotalError;
+}
+
+// Selects the initial endpoints of the line segment that approximates the block colors
+template <Uint32 NumChannels>
+void ComputeEndpoints(const BlockTexels<NumChannels>& Texels,
+                      BLOCK_COMPRESSION_QUALITY       Quality,
+                      float*                          Endpoint0,
+                      float*                          Endpoint1)
+{
+    float MinVal[NumChannels];
+    float MaxVal[NumChannels];
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        MinVal[c] = *std::min_element(Texels.Channels[c], Texels.Channels[c] + 16);
+        MaxVal[c] = *std::max_element(Texels.Channels[c], Texels.Channels[c] + 16);
+    }
+
+    float Mean[NumChannels];
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        Mean[c] = 0;
+        for (Uint32 t = 0; t < 16; ++t)
+            Mean[c] += Texels.Channels[c][t];
+        Mean[c] /= 16.f;
+    }
+
+    // Covariance matrix
+    float Cov[NumChannels][NumChannels];
+    for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+    {
+        for (Uint32 c1 = c0; c1 < NumChannels; ++c1)
+        {
+            float Sum = 0;
+            for (Uint32 t = 0; t < 16; ++t)
+                Sum += (Texels.Channels[c0][t] - Mean[c0]) * (Texels.Channels[c1][t] - Mean[c1]);
+            Cov[c0][c1] = Sum;
+            Cov[c1][c0] = Sum;
+        }
+    }
+
+    if (Quality == BLOCK_COMPRESSION_QUALITY_FAST || NumChannels == 1)
+    {
+        // Use the diagonal of the bounding box that follows the correlation of the channels
+        // with the channel that has the largest range, and inset the box to reduce the error,
+        // see "Real-Time DXT Compression" by J.M.P. van Waveren.
+        Uint32 MainChannel = 0;
+        for (Uint32 c = 1; c < NumChannels; ++c)
+        {
+            if (MaxVal[c] - MinVal[c] > MaxVal[MainChannel] - MinVal[MainChannel])
+                MainChannel = c;
+        }
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            const float Inset = NumChannels > 1 ? (MaxVal[c] - MinVal[c]) / 16.f : 0.f;
+            Endpoint0[c]      = MinVal[c] + Inset;
+            Endpoint1[c]      = MaxVal[c] - Inset;
+            if (Cov[c][MainChannel] < 0)
+                std::swap(Endpoint0[c], Endpoint1[c]);
+        }
+        return;
+    }
+
+    // Find the principal axis with the power iteration starting from the bounding box diagonal
+    float Axis[NumChannels];
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        Axis[c] = MaxVal[c] - MinVal[c];
+    for (Uint32 i = 0; i < 8; ++i)
+    {
+        float NewAxis[NumChannels] = {};
+        float MaxComp              = 0;
+        for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+        {
+            for (Uint32 c1 = 0; c1 < NumChannels; ++c1)
+                NewAxis[c0] += Cov[c0][c1] * Axis[c1];
+            MaxComp = std::max(MaxComp, std::abs(NewAxis[c0]));
+        }
+        if (MaxComp == 0)
+            break;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Axis[c] = NewAxis[c] / MaxComp;
+    }
+
+    float AxisLenSq = 0;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        AxisLenSq += Axis[c] * Axis[c];
+    if (AxisLenSq == 0)
+    {
+        // All texels are the same
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Endpoint0[c] = Endpoint1[c] = Mean[c];
+        return;
+    }
+
+    // Project the texels onto the axis
+    float MinProj = FLT_MAX;
+    float MaxProj = -FLT_MAX;
+    for (Uint32 t = 0; t < 16; ++t)
+    {
+        float Proj = 0;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Proj += (Texels.Channels[c][t] - Mean[c]) * Axis[c];
+        MinProj = std::min(MinProj, Proj);
+        MaxProj = std::max(MaxProj, Proj);
+    }
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        Endpoint0[c] = clamp(Mean[c] + Axis[c] * MinProj / AxisLenSq, 0.f, 255.f);
+        Endpoint1[c] = clamp(Mean[c] + Axis[c] * MaxProj / AxisLenSq, 0.f, 255.f);
+    }
+}
+
+// Finds the endpoints that minimize the squared error for the given indices, where
+// the texel with index i is approximated by (1 - Weights[i]) * Endpoint0 + Weights[i] * Endpoint1.
+template <Uint32 NumChannels>
+bool RefineEndpoints(const BlockTexels<NumChannels>& Texels,
+                     const Uint8*                    Indices,
+                     const float*                    Weights,
+                     float*                          Endpoint0,
+                     float*                          Endpoint1)
+{
+    float A = 0, B = 0, C = 0;
+    float Alpha[NumChannels] = {};
+    float Beta[NumChannels]  = {};
+    for (Uint32 t = 0; t < 16; ++t)
+    {
+        const float w = Weights[Indices[t]];
+        A += (1 - w) * (1 - w);
+        B += (1 - w) * w;
+        C += w * w;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            Alpha[c] += (1 - w) * Texels.Channels[c][t];
+            Beta[c] += w * Texels.Channels[c][t];
+        }
+    }
+
+    const float Det = A * C - B * B;
+    if (std::abs(Det) < 1e-6f)
+        return false;
+
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        Endpoint0[c] = clamp((Alpha[c] * C - Beta[c] * B) / Det, 0.f, 255.f);
+        Endpoint1[c] = clamp((Beta[c] * A - Alpha[c] * B) / Det, 0.f, 255.f);
+    }
+    return true;
+}
+
+inline Uint32 QuantizeUnorm(float Val, Uint32 MaxValue)
+{
+    return static_cast<Uint32>(clamp(Val * static_cast<float>(MaxValue) / 255.f + 0.5f, 0.f, static_cast<float>(MaxValue)));
+}
+
+inline Uint16 ToRGB565(const float* RGB)
+{
+    return static_cast<Uint16>((QuantizeUnorm(RGB[0], 31) << 11) | (QuantizeUnorm(RGB[1], 63) << 5) | QuantizeUnorm(RGB[2], 31));
+}
+
+inline void FromRGB565(Uint16 Color, float* RGB)
+{
+    const Uint32 R = (Color >> 11) & 0x1F;
+    const Uint32 G = (Color >> 5) & 0x3F;
+    const Uint32 B = Color & 0x1F;
+    RGB[0]         = static_cast<float>((R << 3) | (R >> 2));
+    RGB[1]         = static_cast<float>((G << 2) | (G >> 4));
+    RGB[2]         = static_cast<float>((B << 3) | (B >> 2));
+}
+
+inline void WriteUint16(Uint8* pDst, Uint16 Val)
+{
+    pDst[0] = static_cast<Uint8>(Val & 0xFF);
+    pDst[1] = static_cast<Uint8>(Val >> 8);
+}
+
+void EncodeBC1Block(const BlockTexels<3>& Texels, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pDst)
+{
+    struct Encoding
+    {
+        Uint16 Color0 = 0;
+        Uint16 Color1 = 0;
+        Uint8  Indices[16]{};
+        float  Error = FLT_MAX;
+    };
+
+    auto Encode = [&Texels](const float* Endpoint0, const float* Endpoint1) {
+        Encoding Enc;
+        Enc.Color0 = ToRGB565(Endpoint0);
+        Enc.Color1 = ToRGB565(Endpoint1);
+
+        // Four-color mode requires Color0 > Color1
+        const bool Swap = Enc.Color0 < Enc.Color1;
+        if (Swap)
+            std::swap(Enc.Color0, Enc.Color1);
+
+        float Palette[4][3];
+        FromRGB565(Enc.Color0, Palette[0]);
+        FromRGB565(Enc.Color1, Palette[1]);
+        for (Uint32 c = 0; c < 3; ++c)
+        {
+            Palette[2][c] = (2.f * Palette[0][c] + Palette[1][c]) / 3.f;
+            Palette[3][c] = (Palette[0][c] + 2.f * Palette[1][c]) / 3.f;
+        }
+        // If the colors are equal, the block is in the three-color mode where index 3 is black
+        Enc.Error = FindNearestIndices<3>(Texels, &Palette[0][0], Enc.Color0 != Enc.Color1 ? 4 : 1, Enc.Indices);
+        return Enc;
+    };
+
+    float Endpoint0[3], Endpoint1[3];
+    ComputeEndpoints<3>(Texels, Quality, Endpoint0, Endpoint1);
+
+    Encoding Best = Encode(Endpoint0, Endpoint1);
+    if (Quality == BLOCK_COMPRESSION_QUALITY_NORMAL)
+    {
+        // Palette weights of Color0 and Color1
+        static constexpr float Weights[] = {0.f, 1.f, 1.f / 3.f, 2.f / 3.f};
+        for (Uint32 i = 0; i < 2 && Best.Error > 0; ++i)
+        {
+            if (!RefineEndpoints<3>(Texels, Best.Indices, Weights, Endpoint0, Endpoint1))
+                break;
+
+            const Encoding Refined = Encode(Endpoint0, Endpoint1);
+            if (Refined.Error >= Best.Error)
+                break;
+            Best = Refined;
+        }
+    }
+
+    WriteUint16(pDst + 0, Best.Color0);
+    WriteUint16(pDst + 2, Best.Color1);
+    Uint32 Indices = 0;
+    for (Uint32 t = 0; t < 16; ++t)
+        Indices |= Uint32{Best.Indices[t]} << (t * 2);
+    for (Uint32 i = 0; i < 4; ++i)
+        pDst[4 + i] = static_cast<Uint8>((Indices >> (i * 8)) & 0xFF);
+}
+
+void EncodeBC4Block(const BlockTexels<1>& Texels, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pDst)
+{
+    struct Encoding
+    {
+        Uint8 Value0 = 0;
+        Uint8 Value1 = 0;
+        Uint8 Indices[16]{};
+        float Error = FLT_MAX;
+    };
+
+    // Eight-value mode, Value0 > Value1
+    auto Encode8 = [&Texels](float MaxVal, float MinVal) {
+        Encoding Enc;
+        Enc.Value0 = static_cast<Uint8>(QuantizeUnorm(MaxVal, 255));
+        Enc.Value1 = static_cast<Uint8>(QuantizeUnorm(MinVal, 255));
+        if (Enc.Value0 < Enc.Value1)
+            std::swap(Enc.Value0, Enc.Value1);
+        if (Enc.Value0 == Enc.Value1)
+        {
+            Enc.Error = FindNearestIndices<1>(Texels, std::array<float, 1>{static_cast<float>(Enc.Value0)}.data(), 1, Enc.Indices);
+            return Enc;
+        }
+
+        float Palette[8] = {static_cast<float>(Enc.Value0), static_cast<float>(Enc.Value1)};
+        for (Uint32 i = 2; i < 8; ++i)
+            Palette[i] = (static_cast<float>(8 - i) * Palette[0] + static_cast<float>(i - 1) * Palette[1]) / 7.f;
+        Enc.Error = FindNearestIndices<1>(Texels, Palette, 8, Enc.Indices);
+        return Enc;
+    };
+
+    // Six-value mode with explicit 0 and 255, Value0 <= Value1
+    auto Encode6 = [&Texels](float MinVal, float MaxVal) {
+        Encoding Enc;
+        Enc.Value0 = static_cast<Uint8>(QuantizeUnorm(MinVal, 255));
+        Enc.Value1 = static_cast<Uint8>(QuantizeUnorm(MaxVal, 255));
+        if (Enc.Value0 > Enc.Value1)
+            std::swap(Enc.Value0, Enc.Value1);
+
+        float Palette[8] = {static_cast<float>(Enc.Value0), static_cast<float>(Enc.Value1)};
+        for (Uint32 i = 2; i < 6; ++i)
+            Palette[i] = (static_cast<float>(6 - i) * Palette[0] + static_cast<float>(i - 1) * Palette[1]) / 5.f;
+        Palette[6] = 0;
+        Palette[7] = 255;
+        Enc.Error  = FindNearestIndices<1>(Texels, Palette, 8, Enc.Indices);
+        return Enc;
+    };
+
+    float MinVal, MaxVal;
+    ComputeEndpoints<1>(Texels, Quality, &MinVal, &MaxVal);
+
+    Encoding Best = Encode8(MaxVal, MinVal);
+    if (Quality == BLOCK_COMPRESSION_QUALITY_NORMAL && Best.Error > 0)
+    {
+        if (Best.Value0 != Best.Value1)
+        {
+            // Palette weights of Value1
+            static constexpr float Weights[] = {0.f, 1.f, 1.f / 7.f, 2.f / 7.f, 3.f / 7.f, 4.f / 7.f, 5.f / 7.f, 6.f / 7.f};
+
+            float Value0 = Best.Value0, Value1 = Best.Value1;
+            if (RefineEndpoints<1>(Texels, Best.Indices, Weights, &Value0, &Value1))
+            {
+                const Encoding Refined = Encode8(Value0, Value1);
+                if (Refined.Error < Best.Error)
+                    Best = Refined;
+            }
+        }
+
+        // The six-value mode represents the extremes exactly and spends the
+        // interpolated values on the rest of the block
+        float InnerMin = 255, InnerMax = 0;
+        for (Uint32 t = 0; t < 16; ++t)
+        {
+            const float Val = Texels.Channels[0][t];
+            if (Val > 0 && Val < 255)
+            {
+                InnerMin = std::min(InnerMin, Val);
+                InnerMax = std::max(InnerMax, Val);
+            }
+        }
+        if (InnerMin <= InnerMax)
+        {
+            const Encoding Enc6 = Encode6(InnerMin, InnerMax);
+            if (Enc6.Error < Best.Error)
+                Best = Enc6;
+        }
+    }
+
+    pDst[0]        = Best.Value0;
+    pDst[1]        = Best.Value1;
+    Uint64 Indices = 0;
+    for (Uint32 t = 0; t < 16; ++t)
+        Indices |= Uint64{Best.Indices[t]} << (t * 3);
+    for (Uint32 i = 0; i < 6; ++i)
+        pDst[2 + i] = static_cast<Uint8>((Indices >> (i * 8)) & 0xFF);
+}
+
+class BitWriter
+{
+public:
+    explicit BitWriter(Uint8* pDst) noexcept :
+        m_pDst{pDst}
+    {}
+
+    void Write(Uint32 Value, Uint32 NumBits)
+    {
+        for (Uint32 i = 0; i < NumBits; ++i, ++m_Pos)
+        {
+            if ((Value >> i) & 1u)
+                m_pDst[m_Pos / 8] |= static_cast<Uint8>(1u << (m_Pos % 8));
+        }
+    }
+
+    Uint32 GetPos() const { return m_Pos; }
+
+private:
+    Uint8* const m_pDst;
+    Uint32       m_Pos = 0;
+};
+
+// BC7 mode 6: one subset, RGBA 7-bit endpoints with a unique P-bit each, and 4-bit indices
+void EncodeBC7Mode6Block(const BlockTexels<4>& Texels, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pDst)
+{
+    static constexpr Uint32 Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    struct Encoding
+    {
+        Uint32 Endpoints[2][4]{}; // 7-bit values
+        Uint32 PBits[2]{};
+        Uint8  Indices[16]{};
+        float  Error = FLT_MAX;
+    };
+
+    auto Encode = [&Texels](const float* Endpoint0, const float* Endpoint1) {
+        Encoding Enc;
+
+        // Find the P-bit that gives the closest endpoint
+        Uint32 Endpoints8[2][4];
+        const float* const Endpoints[] = {Endpoint0, Endpoint1};
+        for (Uint32 e = 0; e < 2; ++e)
+        {
+            float BestError = FLT_MAX;
+            for (Uint32 p = 0; p < 2; ++p)
+            {
+                Uint32 Quantized[4];
+                float  Error = 0;
+                for (Uint32 c = 0; c < 4; ++c)
+                {
+                    const float Val = (Endpoints[e][c] - static_cast<float>(p)) / 2.f;
+                    Quantized[c]    = static_cast<Uint32>(clamp(Val + 0.5f, 0.f, 127.f));
+                    const float Diff = static_cast<float>((Quantized[c] << 1) | p) - Endpoints[e][c];
+                    Error += Diff * Diff;
+                }
+                if (Error < BestError)
+                {
+                    BestError    = Error;
+                    Enc.PBits[e] = p;
+                    for (Uint32 c = 0; c < 4; ++c)
+                    {
+                        Enc.Endpoints[e][c] = Quantized[c];
+                        Endpoints8[e][c]    = (Quantized[c] << 1) | p;
+                    }
+                }
+            }
+        }
+
+        float Palette[16][4];
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+                Palette[i][c] = static_cast<float>(((64 - Weights[i]) * Endpoints8[0][c] + Weights[i] * Endpoints8[1][c] + 32) >> 6);
+        }
+        Enc.Error = FindNearestIndices<4>(Texels, &Palette[0][0], 16, Enc.Indices);
+        return Enc;
+    };
+
+    float Endpoint0[4], Endpoint1[4];
+    ComputeEndpoints<4>(Texels, Quality, Endpoint0, Endpoint1);
+
+    Encoding Best = Encode(Endpoint0, Endpoint1);
+    if (Quality == BLOCK_COMPRESSION_QUALITY_NORMAL)
+    {
+        float RefineWeights[16];
+        for (Uint32 i = 0; i < 16; ++i)
+            RefineWeights[i] = static_cast<float>(Weights[i]) / 64.f;
+
+        for (Uint32 i = 0; i < 2 && Best.Error > 0; ++i)
+        {
+            if (!RefineEndpoints<4>(Texels, Best.Indices, RefineWeights, Endpoint0, Endpoint1))
+                break;
+
+            const Encoding Refined = Encode(Endpoint0, Endpoint1);
+            if (Refined.Error >= Best.Error)
+                break;
+            Best = Refined;
+        }
+    }
+
+    // The most significant bit of the first index is implicitly zero
+    if (Best.Indices[0] & 0x8)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            std::swap(Best.Endpoints[0][c], Best.Endpoints[1][c]);
+        std::swap(Best.PBits[0], Best.PBits[1]);
+        for (Uint8& Index : Best.Indices)
+            Index = static_cast<Uint8>(15 - Index);
+    }
+
+    memset(pDst, 0, 16);
+    BitWriter Writer{pDst};
+    Writer.Write(1u << 6, 7); // Mode 6
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        Writer.Write(Best.Endpoints[0][c], 7);
+        Writer.Write(Best.Endpoints[1][c], 7);
+    }
+    Writer.Write(Best.PBits[0], 1);
+    Writer.Write(Best.PBits[1], 1);
+    Writer.Write(Best.Indices[0], 3);
+    for (Uint32 t = 1; t < 16; ++t)
+        Writer.Write(Best.Indices[t], 4);
+    VERIFY_EXPR(Writer.GetPos() == 128);
+}
+
+// Loads the 4x4 block of RGBA8 texels, replicating the edge texels outside of the texture
+void LoadBlock(const CompressTextureDataAttribs& Attribs, Uint32 BlockX, Uint32 BlockY, BlockTexels<4>& Texels)
+{
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        const Uint32 Row  = std::min(BlockY * 4 + y, Attribs.Height - 1);
+        const Uint8* pRow = static_cast<const Uint8*>(Attribs.pSrcData) + size_t{Row} * Attribs.SrcStride;
+        for (Uint32 x = 0; x < 4; ++x)
+        {
+            const Uint32 Col = std::min(BlockX * 4 + x, Attribs.Width - 1);
+            for (Uint32 c = 0; c < 4; ++c)
+                Texels.Channels[c][y * 4 + x] = static_cast<float>(pRow[Col * 4 + c]);
+        }
+    }
+}
+
+template <Uint32 NumChannels>
+BlockTexels<NumChannels> GetChannels(const BlockTexels<4>& Texels, Uint32 FirstChannel)
+{
+    BlockTexels<NumChannels> Subset;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        memcpy(Subset.Channels[c], Texels.Channels[FirstChannel + c], sizeof(Subset.Channels[c]));
+    return Subset;
+}
+
+void EncodeBlock(TEXTURE_FORMAT Format, const BlockTexels<4>& Texels, BLOCK_COMPRESSION_QUALITY Quality, Uint8* pDst)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+            EncodeBC1Block(GetChannels<3>(Texels, 0), Quality, pDst);
+            break;
+
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+            EncodeBC4Block(GetChannels<1>(Texels, 3), Quality, pDst);
+            EncodeBC1Block(GetChannels<3>(Texels, 0), Quality, pDst + 8);
+            break;
+
+        case TEX_FORMAT_BC4_UNORM:
+            EncodeBC4Block(GetChannels<1>(Texels, 0), Quality, pDst);
+            break;
+
+        case TEX_FORMAT_BC5_UNORM:
+            EncodeBC4Block(GetChannels<1>(Texels, 0), Quality, pDst);
+            EncodeBC4Block(GetChannels<1>(Texels, 1), Quality, pDst + 8);
+            break;
+
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            EncodeBC7Mode6Block(Texels, Quality, pDst);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected format");
+    }
+}
+
+bool IsFormatUsable(IRenderDevice* pDevice, TEXTURE_FORMAT Format)
+{
+    const TextureFormatInfoExt& FmtInfo = pDevice->GetTextureFormatInfoExt(Format);
+    return FmtInfo.Supported &&
+        (FmtInfo.BindFlags & BIND_SHADER_RESOURCE) != 0 &&
+        (FmtInfo.Dimensions & RESOURCE_DIMENSION_SUPPORT_TEX_2D) != 0;
+}
+
+} // namespace
+
+bool IsBlockCompressionSupported(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+        case TEX_FORMAT_BC4_UNORM:
+        case TEX_FORMAT_BC5_UNORM:
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+TEXTURE_FORMAT SelectBlockCompressedFormat(IRenderDevice*            pDevice,
+                                           TEXTURE_FORMAT            SrcFormat,
+                                           bool                      HasAlpha,
+                                           BLOCK_COMPRESSION_QUALITY Quality)
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "Render device must not be null");
+    if (SrcFormat != TEX_FORMAT_RGBA8_UNORM && SrcFormat != TEX_FORMAT_RGBA8_UNORM_SRGB)
+    {
+        DEV_ERROR("Unsupported source format: ", GetTextureFormatAttribs(SrcFormat).Name);
+        return TEX_FORMAT_UNKNOWN;
+    }
+
+    const bool IsSRGB = SrcFormat == TEX_FORMAT_RGBA8_UNORM_SRGB;
+
+    const TEXTURE_FORMAT BC7Format  = IsSRGB ? TEX_FORMAT_BC7_UNORM_SRGB : TEX_FORMAT_BC7_UNORM;
+    const TEXTURE_FORMAT BC13Format = HasAlpha ?
+        (IsSRGB ? TEX_FORMAT_BC3_UNORM_SRGB : TEX_FORMAT_BC3_UNORM) :
+        (IsSRGB ? TEX_FORMAT_BC1_UNORM_SRGB : TEX_FORMAT_BC1_UNORM);
+
+    const TEXTURE_FORMAT Candidates[] = {
+        Quality == BLOCK_COMPRESSION_QUALITY_NORMAL ? BC7Format : BC13Format,
+        Quality == BLOCK_COMPRESSION_QUALITY_NORMAL ? BC13Format : BC7Format,
+    };
+    for (TEXTURE_FORMAT Format : Candidates)
+    {
+        if (IsFormatUsable(pDevice, Format))
+            return Format;
+    }
+
+    return TEX_FORMAT_UNKNOWN;
+}
+
+bool CompressTextureData(const CompressTextureDataAttribs& Attribs)
+{
+    if (!IsBlockCompressionSupported(Attribs.DstFormat))
+    {
+        DEV_ERROR("Compression to ", GetTextureFormatAttribs(Attribs.DstFormat).Name, " is not supported");
+        return false;
+    }
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+        return true;
+
+    if (Attribs.pSrcData == nullptr || Attribs.pDstData == nullptr)
+    {
+        DEV_ERROR("Source and destination data must not be null");
+        return false;
+    }
+
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(Attribs.DstFormat);
+
+    const Uint32 NumBlocksX = (Attribs.Width + 3) / 4;
+    const Uint32 NumBlocksY = (Attribs.Height + 3) / 4;
+    const Uint32 BlockSize  = FmtAttribs.GetElementSize();
+    if (Attribs.SrcStride < size_t{Attribs.Width} * 4 || Attribs.DstStride < size_t{NumBlocksX} * BlockSize)
+    {
+        DEV_ERROR("Source or destination stride is too small");
+        return false;
+    }
+
+    auto CompressBlockRow = [&](size_t BlockY) {
+        Uint8* pDstRow = static_cast<Uint8*>(Attribs.pDstData) + BlockY * Attribs.DstStride;
+
+        BlockTexels<4> Texels;
+        for (Uint32 BlockX = 0; BlockX < NumBlocksX; ++BlockX)
+        {
+            LoadBlock(Attribs, BlockX, static_cast<Uint32>(BlockY), Texels);
+            EncodeBlock(Attribs.DstFormat, Texels, Attribs.Quality, pDstRow + BlockX * BlockSize);
+        }
+    };
+
+    if (Attribs.pThreadPool != nullptr && NumBlocksY > 1)
+    {
+        ProcessItemsInParallel(Attribs.pThreadPool, NumBlocksY, CompressBlockRow);
+    }
+    else
+    {
+        for (Uint32 BlockY = 0; BlockY < NumBlocksY; ++BlockY)
+            CompressBlockRow(BlockY);
+    }
+
+    return true;
+}
+
+bool CompressTextureToUploadBuffer(IUploadBuffer*                    pUploadBuffer,
+                                   Uint32                            Mip,
+                                   Uint32                            Slice,
+                                   const CompressTextureDataAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pUploadBuffer != nullptr, "Upload buffer must not be null");
+
+    const UploadBufferDesc&        Desc       = pUploadBuffer->GetDesc();
+    const MappedTextureSubresource MappedData = pUploadBuffer->GetMappedData(Mip, Slice);
+    if (MappedData.pData == nullptr)
+    {
+        DEV_ERROR("Subresource ", Mip, ", ", Slice, " of the upload buffer is not mapped");
+        return false;
+    }
+
+    CompressTextureDataAttribs BufferAttribs = Attribs;
+    BufferAttribs.Width                      = std::max(Desc.Width >> Mip, 1u);
+    BufferAttribs.Height                     = std::max(Desc.Height >> Mip, 1u);
+    BufferAttribs.DstFormat                  = Desc.Format;
+    BufferAttribs.pDstData                   = MappedData.pData;
+    BufferAttribs.DstStride                  = static_cast<size_t>(MappedData.Stride);
+    return CompressTextureData(BufferAttribs);
+}
+
+} // namespace Diligent
@@ -0,0 +1,611 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TextureStreamingManager.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+constexpr TextureStreamingManager::TextureId TextureStreamingManager::InvalidTextureId;
+
+TextureStreamingManager::TextureStreamingManager(IRenderDevice* pDevice, const TextureStreamingManagerCreateInfo& CI) :
+    // clang-format off
+    m_pDevice             {pDevice},
+    m_UploadBudget        {CI.UploadBudget},
+    m_MemoryBudgetOverride{CI.MemoryBudget},
+    m_DeviceBudgetFraction{std::max(std::min(CI.DeviceBudgetFraction, 1.f), 0.f)},
+    m_MaxTailSize         {std::max(CI.MaxTailSize, 1u)},
+    m_RequestLifetime     {std::max(CI.RequestLifetime, 1u)}
+// clang-format on
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("pDevice must not be null");
+    if (m_UploadBudget == 0)
+        LOG_ERROR_AND_THROW("Upload budget must not be zero");
+
+    // Frame 0 is reserved for textures that have never been requested
+    m_FrameIndex = 1;
+}
+
+TextureStreamingManager::~TextureStreamingManager()
+{
+}
+
+TextureStreamingManager::TextureInfo* TextureStreamingManager::FindTexture(TextureId Id)
+{
+    auto it = m_Textures.find(Id);
+    return it != m_Textures.end() ? &it->second : nullptr;
+}
+
+const TextureStreamingManager::TextureInfo* TextureStreamingManager::FindTexture(TextureId Id) const
+{
+    auto it = m_Textures.find(Id);
+    return it != m_Textures.end() ? &it->second : nullptr;
+}
+
+bool TextureStreamingManager::IsValidAllocationMip(const TextureInfo& Tex, Uint32 Mip) const
+{
+    if (Mip == 0)
+        return true;
+
+    // The most detailed level of a texture in block-compressed format must be a whole number of blocks
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(Tex.Desc.Format);
+    if (FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+        return true;
+
+    return (std::max(Tex.Desc.Width >> Mip, 1u) % FmtAttribs.BlockWidth) == 0 &&
+        (std::max(Tex.Desc.Height >> Mip, 1u) % FmtAttribs.BlockHeight) == 0;
+}
+
+TextureStreamingManager::TextureId TextureStreamingManager::RegisterTexture(const StreamedTextureDesc& Desc)
+{
+    const char* Name = Desc.Name != nullptr ? Desc.Name : "Streamed texture";
+    if (Desc.Width == 0 || Desc.Height == 0)
+    {
+        LOG_ERROR_MESSAGE("Size (", Desc.Width, "x", Desc.Height, ") of streamed texture '", Name, "' must not be zero");
+        return InvalidTextureId;
+    }
+    if (!Desc.MipLoader)
+    {
+        LOG_ERROR_MESSAGE("Mip loader of streamed texture '", Name, "' must not be empty");
+        return InvalidTextureId;
+    }
+
+    TextureInfo Tex;
+    Tex.Id        = m_NextTextureId;
+    Tex.Name      = Name;
+    Tex.MipLoader = Desc.MipLoader;
+
+    Tex.Desc.Type      = RESOURCE_DIM_TEX_2D;
+    Tex.Desc.Width     = Desc.Width;
+    Tex.Desc.Height    = Desc.Height;
+    Tex.Desc.Format    = Desc.Format;
+    Tex.Desc.MipLevels = ComputeMipLevelsCount(Desc.Width, Desc.Height);
+    if (Desc.MipLevels != 0)
+        Tex.Desc.MipLevels = std::min(Desc.MipLevels, Tex.Desc.MipLevels);
+    Tex.Desc.Usage     = USAGE_DEFAULT;
+    Tex.Desc.BindFlags = BIND_SHADER_RESOURCE;
+
+    const Uint32 NumMips = Tex.Desc.MipLevels;
+
+    Tex.MipSizes.resize(NumMips);
+    Tex.AllocSizes.resize(NumMips + 1);
+    for (Uint32 Mip = NumMips; Mip-- > 0;)
+    {
+        Tex.MipSizes[Mip]   = GetMipLevelProperties(Tex.Desc, Mip).MipSize;
+        Tex.AllocSizes[Mip] = Tex.AllocSizes[Mip + 1] + Tex.MipSizes[Mip];
+    }
+
+    Tex.TailMip = NumMips - 1;
+    while (Tex.TailMip > 0 && std::max(Tex.Desc.Width >> (Tex.TailMip - 1), Tex.Desc.Height >> (Tex.TailMip - 1)) <= m_MaxTailSize)
+        --Tex.TailMip;
+    while (!IsValidAllocationMip(Tex, Tex.TailMip))
+        --Tex.TailMip;
+
+    Tex.AllocatedMip = NumMips;
+    Tex.ResidentMip  = NumMips;
+    Tex.DesiredMip   = Tex.TailMip;
+
+    if (!Reallocate(nullptr, Tex, Tex.TailMip))
+        return InvalidTextureId;
+
+    ++m_NextTextureId;
+    m_NewTextures.push_back(Tex.Id);
+    const TextureId Id = Tex.Id;
+    m_Textures.emplace(Id, std::move(Tex));
+    return Id;
+}
+
+void TextureStreamingManager::UnregisterTexture(TextureId Id)
+{
+    auto it = m_Textures.find(Id);
+    if (it == m_Textures.end())
+    {
+        DEV_ERROR("Texture ", Id, " is not registered");
+        return;
+    }
+
+    const TextureInfo& Tex = it->second;
+    VERIFY_EXPR(m_AllocatedMemory >= Tex.AllocSizes[Tex.AllocatedMip]);
+    m_AllocatedMemory -= Tex.AllocSizes[Tex.AllocatedMip];
+    m_Textures.erase(it);
+}
+
+void TextureStreamingManager::RequestMip(TextureId Id, Uint32 DesiredMip, float Priority)
+{
+    TextureInfo* pTex = FindTexture(Id);
+    if (pTex == nullptr)
+    {
+        DEV_ERROR("Texture ", Id, " is not registered");
+        return;
+    }
+
+    DesiredMip = std::min(DesiredMip, pTex->TailMip);
+    if (pTex->LastRequestFrame == m_FrameIndex)
+    {
+        pTex->DesiredMip = std::min(pTex->DesiredMip, DesiredMip);
+        pTex->Priority   = std::max(pTex->Priority, Priority);
+    }
+    else
+    {
+        pTex->DesiredMip       = DesiredMip;
+        pTex->Priority         = Priority;
+        pTex->LastRequestFrame = m_FrameIndex;
+    }
+}
+
+void TextureStreamingManager::BindVariable(TextureId Id, IShaderResourceVariable* pVariable, Uint32 ArrayIndex)
+{
+    TextureInfo* pTex = FindTexture(Id);
+    if (pTex == nullptr)
+    {
+        DEV_ERROR("Texture ", Id, " is not registered");
+        return;
+    }
+    if (pVariable == nullptr)
+    {
+        DEV_ERROR("pVariable must not be null");
+        return;
+    }
+
+    pTex->Variables.push_back({RefCntAutoPtr<IShaderResourceVariable>{pVariable}, ArrayIndex});
+    if (pTex->pView)
+    {
+        IDeviceObject* pView = pTex->pView;
+        pVariable->SetArray(&pView, ArrayIndex, 1, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+    }
+}
+
+void TextureStreamingManager::UnbindVariable(TextureId Id, IShaderResourceVariable* pVariable, Uint32 ArrayIndex)
+{
+    TextureInfo* pTex = FindTexture(Id);
+    if (pTex == nullptr)
+    {
+        DEV_ERROR("Texture ", Id, " is not registered");
+        return;
+    }
+
+    auto& Vars = pTex->Variables;
+    Vars.erase(std::remove_if(Vars.begin(), Vars.end(),
+                              [&](const BoundVariable& Var) {
+                                  return Var.pVariable == pVariable && Var.ArrayIndex == ArrayIndex;
+                              }),
+               Vars.end());
+}
+
+void TextureStreamingManager::UpdateMemoryBudget()
+{
+    if (m_MemoryBudgetOverride != 0)
+    {
+        m_MemoryBudget = m_MemoryBudgetOverride;
+        return;
+    }
+
+    DeviceMemoryStats Stats;
+    m_pDevice->GetMemoryStats(Stats);
+
+    Uint64 Budget = 0;
+    Uint64 Usage  = 0;
+    for (Uint32 i = 0; i < std::min(Stats.NumHeaps, Uint32{DILIGENT_MAX_MEMORY_HEAPS}); ++i)
+    {
+        const MemoryHeapStats& Heap = Stats.Heaps[i];
+        if (Heap.DeviceLocal)
+        {
+            Budget += Heap.Budget;
+            Usage += Heap.Usage;
+        }
+    }
+
+    if (Budget == 0)
+    {
+        m_MemoryBudget = ~Uint64{0};
+        return;
+    }
+
+    // The streamed textures may use the given fraction of the budget, but must never
+    // push the total usage of the process over the budget.
+    const Uint64 OtherUsage = Usage > m_AllocatedMemory ? Usage - m_AllocatedMemory : 0;
+    const Uint64 Available  = Budget > OtherUsage ? Budget - OtherUsage : 0;
+    m_MemoryBudget          = std::min(static_cast<Uint64>(static_cast<double>(Budget) * m_DeviceBudgetFraction), Available);
+}
+
+bool TextureStreamingManager::Reallocate(IDeviceContext* pContext, TextureInfo& Tex, Uint32 AllocatedMip)
+{
+    const Uint32 NumMips = Tex.Desc.MipLevels;
+    VERIFY_EXPR(AllocatedMip < NumMips && IsValidAllocationMip(Tex, AllocatedMip));
+
+    TextureDesc Desc = Tex.Desc;
+    Desc.Name        = Tex.Name.c_str();
+    Desc.Width       = std::max(Tex.Desc.Width >> AllocatedMip, 1u);
+    Desc.Height      = std::max(Tex.Desc.Height >> AllocatedMip, 1u);
+    Desc.MipLevels   = NumMips - AllocatedMip;
+
+    RefCntAutoPtr<ITexture> pNewTexture;
+    m_pDevice->CreateTexture(Desc, nullptr, &pNewTexture);
+    if (!pNewTexture)
+    {
+        LOG_ERROR_MESSAGE("Failed to allocate mip levels ", AllocatedMip, "..", NumMips - 1, " of streamed texture '", Tex.Name, "'");
+        return false;
+    }
+
+    if (Tex.pTexture)
+    {
+        if (Tex.ResidentMip < NumMips)
+        {
+            VERIFY_EXPR(pContext != nullptr);
+            for (Uint32 Mip = std::max(Tex.ResidentMip, AllocatedMip); Mip < NumMips; ++Mip)
+            {
+                CopyTextureAttribs CopyAttribs{Tex.pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pNewTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+                CopyAttribs.SrcMipLevel = Mip - Tex.AllocatedMip;
+                CopyAttribs.DstMipLevel = Mip - AllocatedMip;
+                pContext->CopyTexture(CopyAttribs);
+            }
+            if (Tex.ResidentMip < AllocatedMip)
+                m_NumEvictedMips += AllocatedMip - Tex.ResidentMip;
+        }
+
+        VERIFY_EXPR(m_AllocatedMemory >= Tex.AllocSizes[Tex.AllocatedMip]);
+        m_AllocatedMemory -= Tex.AllocSizes[Tex.AllocatedMip];
+        ++m_NumReallocations;
+    }
+    m_AllocatedMemory += Tex.AllocSizes[AllocatedMip];
+
+    // The old texture is released when the GPU has finished using it
+    Tex.pTexture     = std::move(pNewTexture);
+    Tex.AllocatedMip = AllocatedMip;
+    Tex.ResidentMip  = std::max(Tex.ResidentMip, AllocatedMip);
+    Tex.IsModified   = true;
+    UpdateView(Tex);
+
+    return true;
+}
+
+void TextureStreamingManager::UpdateView(TextureInfo& Tex)
+{
+    const Uint32 NumMips = Tex.Desc.MipLevels;
+    if (Tex.ResidentMip >= NumMips)
+        return;
+
+    if (Tex.pView &&
+        Tex.pView->GetTexture() == Tex.pTexture &&
+        Tex.pView->GetDesc().MostDetailedMip == Tex.ResidentMip - Tex.AllocatedMip)
+        return;
+
+    TextureViewDesc ViewDesc;
+    ViewDesc.Name            = Tex.Name.c_str();
+    ViewDesc.ViewType        = TEXTURE_VIEW_SHADER_RESOURCE;
+    ViewDesc.TextureDim      = RESOURCE_DIM_TEX_2D;
+    ViewDesc.MostDetailedMip = Tex.ResidentMip - Tex.AllocatedMip;
+    ViewDesc.NumMipLevels    = NumMips - Tex.ResidentMip;
+
+    RefCntAutoPtr<ITextureView> pView;
+    Tex.pTexture->CreateView(ViewDesc, &pView);
+    if (!pView)
+    {
+        LOG_ERROR_MESSAGE("Failed to create view of streamed texture '", Tex.Name, "'");
+        return;
+    }
+    Tex.pView = std::move(pView);
+
+    IDeviceObject* pViewObj = Tex.pView;
+    for (const BoundVariable& Var : Tex.Variables)
+        Var.pVariable->SetArray(&pViewObj, Var.ArrayIndex, 1, SET_SHADER_RESOURCE_FLAG_ALLOW_OVERWRITE);
+}
+
+bool TextureStreamingManager::LoadMip(IDeviceContext* pContext, TextureInfo& Tex, Uint32 Mip)
+{
+    VERIFY_EXPR(Mip >= Tex.AllocatedMip && Mip < Tex.Desc.MipLevels);
+
+    const MipLevelProperties MipProps = GetMipLevelProperties(Tex.Desc, Mip);
+
+    m_LoadData.resize(static_cast<size_t>(MipProps.MipSize));
+    const MappedTextureSubresource Data{m_LoadData.data(), MipProps.RowSize, MipProps.MipSize};
+    if (!Tex.MipLoader(Mip, Data))
+    {
+        LOG_WARNING_MESSAGE("Failed to load mip level ", Mip, " of streamed texture '", Tex.Name, "'");
+        ++m_NumFailedMips;
+        return false;
+    }
+
+    const Box         Region{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight};
+    TextureSubResData SubresData{m_LoadData.data(), MipProps.RowSize};
+    pContext->UpdateTexture(Tex.pTexture, Mip - Tex.AllocatedMip, 0, Region, SubresData, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    m_FrameUploadedBytes += MipProps.MipSize;
+    m_TotalUploadedBytes += MipProps.MipSize;
+    ++m_NumLoadedMips;
+    Tex.IsModified = true;
+
+    return true;
+}
+
+void TextureStreamingManager::LoadTail(IDeviceContext* pContext, TextureInfo& Tex)
+{
+    VERIFY_EXPR(Tex.AllocatedMip <= Tex.TailMip);
+    for (Uint32 Mip = Tex.Desc.MipLevels; Mip-- > Tex.TailMip;)
+    {
+        // The tail is resident even if it failed to load, but finer levels are not streamed
+        if (!LoadMip(pContext, Tex, Mip))
+            Tex.MinLoadableMip = Tex.TailMip;
+        Tex.ResidentMip = Mip;
+    }
+    UpdateView(Tex);
+}
+
+Uint64 TextureStreamingManager::FreeMemory(IDeviceContext* pContext, Uint64 Size, float Priority, const TextureInfo* pExclude)
+{
+    std::vector<TextureInfo*> Candidates;
+    for (auto& it : m_Textures)
+    {
+        TextureInfo& Tex = it.second;
+        if (&Tex != pExclude && Tex.AllocatedMip < Tex.TailMip)
+            Candidates.push_back(&Tex);
+    }
+    std::sort(Candidates.begin(), Candidates.end(),
+              [](const TextureInfo* pTex0, const TextureInfo* pTex1) {
+                  return pTex0->Priority != pTex1->Priority ? pTex0->Priority < pTex1->Priority : pTex0->Id < pTex1->Id;
+              });
+
+    Uint64 Freed = 0;
+
+    // Releases the memory of the mip levels of the texture up to LastMip, but no more than necessary.
+    auto Shrink = [&](TextureInfo& Tex, Uint32 LastMip) {
+        Uint32 NewMip = Tex.AllocatedMip;
+        for (Uint32 Mip = Tex.AllocatedMip + 1; Mip <= LastMip; ++Mip)
+        {
+            if (!IsValidAllocationMip(Tex, Mip))
+                continue;
+            NewMip = Mip;
+            if (Tex.AllocSizes[Tex.AllocatedMip] - Tex.AllocSizes[Mip] >= Size - Freed)
+                break;
+        }
+        if (NewMip == Tex.AllocatedMip)
+            return;
+
+        const Uint64 OldSize = Tex.AllocSizes[Tex.AllocatedMip];
+        if (Reallocate(pContext, Tex, NewMip))
+            Freed += OldSize - Tex.AllocSizes[NewMip];
+    };
+
+    // Evict the mip levels that are not requested first
+    for (TextureInfo* pTex : Candidates)
+    {
+        if (Freed >= Size)
+            break;
+        const Uint32 LastMip = std::min(std::max(pTex->DesiredMip, pTex->MinLoadableMip), pTex->TailMip);
+        Shrink(*pTex, LastMip);
+    }
+
+    // Evict the requested mip levels of the textures with lower priority
+    for (TextureInfo* pTex : Candidates)
+    {
+        if (Freed >= Size || pTex->Priority >= Priority)
+            break;
+        Shrink(*pTex, pTex->TailMip);
+    }
+
+    return Freed;
+}
+
+bool TextureStreamingManager::StreamIn(IDeviceContext* pContext, TextureInfo& Tex)
+{
+    const Uint32 TargetMip = std::max(Tex.DesiredMip, Tex.MinLoadableMip);
+    if (TargetMip >= Tex.ResidentMip)
+        return true;
+
+    if (TargetMip < Tex.AllocatedMip)
+    {
+        Uint32 AllocatedMip = TargetMip;
+        while (!IsValidAllocationMip(Tex, AllocatedMip))
+            --AllocatedMip;
+
+        const Uint64 Growth = Tex.AllocSizes[AllocatedMip] - Tex.AllocSizes[Tex.AllocatedMip];
+        if (m_AllocatedMemory + Growth > m_MemoryBudget)
+            FreeMemory(pContext, m_AllocatedMemory + Growth - m_MemoryBudget, Tex.Priority, &Tex);
+
+        // Allocate as many mip levels as the budget allows
+        while (AllocatedMip < Tex.AllocatedMip &&
+               (!IsValidAllocationMip(Tex, AllocatedMip) ||
+                m_AllocatedMemory + Tex.AllocSizes[AllocatedMip] - Tex.AllocSizes[Tex.AllocatedMip] > m_MemoryBudget))
+            ++AllocatedMip;
+
+        if (AllocatedMip < Tex.AllocatedMip)
+            Reallocate(pContext, Tex, AllocatedMip);
+    }
+
+    // Load the mip levels from coarse to fine, so that the resident levels always form a contiguous range
+    bool         BudgetAvailable = true;
+    const Uint32 LastMip         = std::max(TargetMip, Tex.AllocatedMip);
+    while (Tex.ResidentMip > LastMip)
+    {
+        const Uint32 Mip = Tex.ResidentMip - 1;
+        if (m_FrameUploadedBytes > 0 && m_FrameUploadedBytes + Tex.MipSizes[Mip] > m_UploadBudget)
+        {
+            BudgetAvailable = false;
+            break;
+        }
+
+        if (!LoadMip(pContext, Tex, Mip))
+        {
+            Tex.MinLoadableMip = Mip + 1;
+            break;
+        }
+        Tex.ResidentMip = Mip;
+    }
+    UpdateView(Tex);
+
+    return BudgetAvailable && m_FrameUploadedBytes < m_UploadBudget;
+}
+
+void TextureStreamingManager::Update(IDeviceContext* pContext)
+{
+    if (pContext == nullptr)
+    {
+        DEV_ERROR("pContext must not be null");
+        return;
+    }
+
+    ++m_FrameIndex;
+    m_FrameUploadedBytes = 0;
+
+    UpdateMemoryBudget();
+
+    for (TextureId Id : m_NewTextures)
+    {
+        if (TextureInfo* pTex = FindTexture(Id))
+            LoadTail(pContext, *pTex);
+    }
+    m_NewTextures.clear();
+
+    for (auto& it : m_Textures)
+    {
+        TextureInfo& Tex = it.second;
+        if (m_FrameIndex - Tex.LastRequestFrame > m_RequestLifetime)
+        {
+            Tex.DesiredMip = Tex.TailMip;
+            Tex.Priority   = 0;
+        }
+    }
+
+    // The budget may have decreased since the last frame
+    if (m_AllocatedMemory > m_MemoryBudget)
+        FreeMemory(pContext, m_AllocatedMemory - m_MemoryBudget, FLT_MAX, nullptr);
+
+    m_SortedTextures.clear();
+    for (auto& it : m_Textures)
+    {
+        TextureInfo& Tex = it.second;
+        if (std::max(Tex.DesiredMip, Tex.MinLoadableMip) < Tex.ResidentMip)
+            m_SortedTextures.push_back(&Tex);
+    }
+    std::sort(m_SortedTextures.begin(), m_SortedTextures.end(),
+              [](const TextureInfo* pTex0, const TextureInfo* pTex1) {
+                  return pTex0->Priority != pTex1->Priority ? pTex0->Priority > pTex1->Priority : pTex0->Id < pTex1->Id;
+              });
+
+    for (TextureInfo* pTex : m_SortedTextures)
+    {
+        if (!StreamIn(pContext, *pTex))
+            break;
+    }
+    m_SortedTextures.clear();
+
+    std::vector<StateTransitionDesc> Barriers;
+    for (auto& it : m_Textures)
+    {
+        TextureInfo& Tex = it.second;
+        if (!Tex.IsModified)
+            continue;
+
+        Barriers.emplace_back(Tex.pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        Tex.IsModified = false;
+    }
+    if (!Barriers.empty())
+        pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+}
+
+ITexture* TextureStreamingManager::GetTexture(TextureId Id) const
+{
+    const TextureInfo* pTex = FindTexture(Id);
+    return pTex != nullptr ? pTex->pTexture.RawPtr() : nullptr;
+}
+
+ITextureView* TextureStreamingManager::GetView(TextureId Id) const
+{
+    const TextureInfo* pTex = FindTexture(Id);
+    return pTex != nullptr ? pTex->pView.RawPtr() : nullptr;
+}
+
+Uint32 TextureStreamingManager::GetResidentMip(TextureId Id) const
+{
+    const TextureInfo* pTex = FindTexture(Id);
+    DEV_CHECK_ERR(pTex != nullptr, "Texture ", Id, " is not registered");
+    return pTex != nullptr ? pTex->ResidentMip : 0;
+}
+
+Uint32 TextureStreamingManager::GetAllocatedMip(TextureId Id) const
+{
+    const TextureInfo* pTex = FindTexture(Id);
+    DEV_CHECK_ERR(pTex != nullptr, "Texture ", Id, " is not registered");
+    return pTex != nullptr ? pTex->AllocatedMip : 0;
+}
+
+Uint32 TextureStreamingManager::GetTailMip(TextureId Id) const
+{
+    const TextureInfo* pTex = FindTexture(Id);
+    DEV_CHECK_ERR(pTex != nullptr, "Texture ", Id, " is not registered");
+    return pTex != nullptr ? pTex->TailMip : 0;
+}
+
+TextureStreamingStats TextureStreamingManager::GetStats() const
+{
+    TextureStreamingStats Stats;
+    Stats.NumTextures = static_cast<Uint32>(m_Textures.size());
+    for (const auto& it : m_Textures)
+    {
+        const TextureInfo& Tex = it.second;
+        if (std::max(Tex.DesiredMip, Tex.MinLoadableMip) < Tex.ResidentMip)
+            ++Stats.NumPendingRequests;
+    }
+    Stats.AllocatedMemory    = m_AllocatedMemory;
+    Stats.MemoryBudget       = m_MemoryBudget;
+    Stats.FrameUploadedBytes = m_FrameUploadedBytes;
+    Stats.TotalUploadedBytes = m_TotalUploadedBytes;
+    Stats.NumLoadedMips      = m_NumLoadedMips;
+    Stats.NumEvictedMips     = m_NumEvictedMips;
+    Stats.NumFailedMips      = m_NumFailedMips;
+    Stats.NumReallocations   = m_NumReallocations;
+    return Stats;
+}
+
+} // namespace Diligent
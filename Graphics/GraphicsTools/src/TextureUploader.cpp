@@ -26,7 +26,14 @@
  */
 
 #include "TextureUploader.hpp"
+
+#include <atomic>
+#include <memory>
+
+#include "TextureUploaderBase.hpp"
+#include "AsyncFileReader.hpp"
 #include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
 
 #if D3D11_SUPPORTED
 #    include "TextureUploaderD3D11.hpp"
@@ -47,6 +54,48 @@
 namespace Diligent
 {
 
+static TextureDesc GetUploadBufferTextureDesc(const UploadBufferDesc& Desc)
+{
+    TextureDesc TexDesc;
+    TexDesc.Type      = Desc.Depth > 1 ? RESOURCE_DIM_TEX_3D : (Desc.ArraySize > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D);
+    TexDesc.Width     = Desc.Width;
+    TexDesc.Height    = Desc.Height;
+    TexDesc.Format    = Desc.Format;
+    TexDesc.MipLevels = Desc.MipLevels;
+    if (TexDesc.Type == RESOURCE_DIM_TEX_3D)
+        TexDesc.Depth = Desc.Depth;
+    else
+        TexDesc.ArraySize = Desc.ArraySize;
+    return TexDesc;
+}
+
+Uint64 TextureUploaderBase::GetUploadBufferDataSize(const UploadBufferDesc& Desc)
+{
+    const TextureDesc TexDesc = GetUploadBufferTextureDesc(Desc);
+
+    Uint64 Size = 0;
+    for (Uint32 Mip = 0; Mip < Desc.MipLevels; ++Mip)
+        Size += GetMipLevelProperties(TexDesc, Mip).MipSize;
+
+    return Size * Desc.ArraySize;
+}
+
+void TextureUploaderBase::GetCommonStats(TextureUploaderStats& Stats)
+{
+    Stats.NumStagingBuffers  = m_NumStagingBuffers.load();
+    Stats.StagingMemorySize  = m_StagingMemorySize.load();
+    Stats.TotalBytesUploaded = m_TotalBytesUploaded.load();
+    Stats.TotalStallTime     = static_cast<double>(m_TotalStallTimeUs.load()) * 1e-6;
+
+    std::lock_guard<std::mutex> Lock{m_RateMtx};
+
+    const double ElapsedTime = m_RateTimer.GetElapsedTime();
+    if (ElapsedTime > 0)
+        Stats.BytesPerSecond = static_cast<float>(static_cast<double>(Stats.TotalBytesUploaded - m_RateBytesUploaded) / ElapsedTime);
+    m_RateBytesUploaded = Stats.TotalBytesUploaded;
+    m_RateTimer.Restart();
+}
+
 void CreateTextureUploader(IRenderDevice* pDevice, const TextureUploaderDesc& Desc, ITextureUploader** ppUploader)
 {
     *ppUploader = nullptr;
@@ -84,4 +133,102 @@ void CreateTextureUploader(IRenderDevice* pDevice, const TextureUploaderDesc& De
         (*ppUploader)->AddRef();
 }
 
+void ReadUploadBufferFromFile(AsyncFileReader&                  Reader,
+                              IUploadBuffer*                    pUploadBuffer,
+                              const UploadBufferFileRegion*     pRegions,
+                              Uint32                            NumRegions,
+                              std::function<void(bool Success)> Callback)
+{
+    DEV_CHECK_ERR(pUploadBuffer != nullptr, "Upload buffer must not be null");
+    DEV_CHECK_ERR(pRegions != nullptr || NumRegions == 0, "pRegions must not be null");
+
+    struct ReadState
+    {
+        RefCntAutoPtr<IUploadBuffer>      pBuffer;
+        std::function<void(bool Success)> Callback;
+
+        // The number of pending reads plus one for the submitting thread, so that
+        // the callback can't be called before all reads have been submitted.
+        std::atomic<Uint32> NumPending{1};
+        std::atomic<bool>   Success{true};
+
+        void OnReadComplete(bool ReadSuccess)
+        {
+            if (!ReadSuccess)
+                Success.store(false);
+            if (NumPending.fetch_sub(1) == 1)
+            {
+                if (Callback)
+                    Callback(Success.load());
+                // Release the buffer after the callback has returned
+                pBuffer.Release();
+            }
+        }
+    };
+    auto pState      = std::make_shared<ReadState>();
+    pState->pBuffer  = pUploadBuffer;
+    pState->Callback = std::move(Callback);
+
+    auto Read = [&](Uint64 Offset, Uint64 Size, void* pDst) {
+        if (Size == 0)
+            return;
+        pState->NumPending.fetch_add(1);
+        Reader.ReadAsync(Offset, static_cast<size_t>(Size), pDst,
+                         [pState, Size](bool Success, size_t NumBytesRead) {
+                             pState->OnReadComplete(Success && NumBytesRead == Size);
+                         });
+    };
+
+    const UploadBufferDesc&     BuffDesc   = pUploadBuffer->GetDesc();
+    const TextureDesc           TexDesc    = GetUploadBufferTextureDesc(BuffDesc);
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(BuffDesc.Format);
+    for (Uint32 i = 0; i < NumRegions; ++i)
+    {
+        const UploadBufferFileRegion& Region = pRegions[i];
+        if (Region.Mip >= BuffDesc.MipLevels || Region.Slice >= BuffDesc.ArraySize)
+        {
+            LOG_ERROR_MESSAGE("Subresource (mip ", Region.Mip, ", slice ", Region.Slice, ") is out of range of the upload buffer with ",
+                              BuffDesc.MipLevels, " mip levels and ", BuffDesc.ArraySize, " array slices");
+            pState->Success.store(false);
+            continue;
+        }
+
+        const MipLevelProperties MipProps = GetMipLevelProperties(TexDesc, Region.Mip);
+
+        // For compressed formats, a row is a row of blocks
+        const Uint32 NumRows = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ?
+            MipProps.StorageHeight / FmtAttribs.BlockHeight :
+            MipProps.StorageHeight;
+
+        const Uint64 SrcStride      = Region.Stride != 0 ? Region.Stride : MipProps.RowSize;
+        const Uint64 SrcDepthStride = Region.DepthStride != 0 ? Region.DepthStride : SrcStride * NumRows;
+        DEV_CHECK_ERR(SrcStride >= MipProps.RowSize, "File row stride (", SrcStride, ") is smaller than the row size (", MipProps.RowSize, ")");
+
+        const MappedTextureSubresource MappedData = pUploadBuffer->GetMappedData(Region.Mip, Region.Slice);
+        VERIFY_EXPR(MappedData.pData != nullptr);
+
+        Uint8* const pDstData = static_cast<Uint8*>(MappedData.pData);
+        if (SrcStride == MappedData.Stride && (MipProps.Depth == 1 || SrcDepthStride == MappedData.DepthStride))
+        {
+            // The layouts match: read the entire subresource at once
+            const Uint64 Size = (MipProps.Depth - 1) * SrcDepthStride + (NumRows - 1) * SrcStride + MipProps.RowSize;
+            Read(Region.Offset, Size, pDstData);
+        }
+        else
+        {
+            for (Uint32 z = 0; z < MipProps.Depth; ++z)
+            {
+                for (Uint32 row = 0; row < NumRows; ++row)
+                {
+                    Read(Region.Offset + z * SrcDepthStride + row * SrcStride,
+                         MipProps.RowSize,
+                         pDstData + z * MappedData.DepthStride + row * MappedData.Stride);
+                }
+            }
+        }
+    }
+
+    pState->OnReadComplete(true);
+}
+
 } // namespace Diligent
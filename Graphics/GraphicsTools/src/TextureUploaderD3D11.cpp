@@ -390,6 +390,7 @@ void TextureUploaderD3D11::AllocateUploadBuffer(IDeviceContext*         pContext
                          m_pDevice->GetTextureFormatInfo(Desc.Format).Name, " staging texture");
 
         pUploadBuffer = MakeNewRCObj<UploadBufferD3D11>()(Desc, pStagingTex);
+        OnStagingBufferCreated(Desc);
     }
 
     if (pUploadBuffer)
@@ -403,8 +404,10 @@ void TextureUploaderD3D11::AllocateUploadBuffer(IDeviceContext*         pContext
         else
         {
             // Worker thread
+            Timer StallTimer;
             m_pInternalData->EnqueueMap(pUploadBuffer, InternalData::PendingBufferOperation::Map);
             pUploadBuffer->WaitForMap();
+            OnWorkerStall(StallTimer.GetElapsedTime());
         }
     }
 
@@ -421,6 +424,7 @@ void TextureUploaderD3D11::ScheduleGPUCopy(IDeviceContext* pContext,
     RefCntAutoPtr<ITextureD3D11> pDstTexD3D11(pDstTexture, IID_TextureD3D11);
     auto*                        pd3d11NativeDstTex = pDstTexD3D11->GetD3D11Texture();
     const auto&                  DstTexDesc         = pDstTexture->GetDesc();
+    OnCopyScheduled(pUploadBufferD3D11->GetDesc());
     if (pContext != nullptr)
     {
         // Main thread
@@ -454,9 +458,19 @@ void TextureUploaderD3D11::RecycleBuffer(IUploadBuffer* pUploadBuffer)
 
 TextureUploaderStats TextureUploaderD3D11::GetStats()
 {
-    TextureUploaderStats        Stats;
-    std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingOperationsMtx);
-    Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->m_PendingOperations.size());
+    TextureUploaderStats Stats;
+    GetCommonStats(Stats);
+
+    {
+        std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingOperationsMtx);
+        Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->m_PendingOperations.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
+        for (const auto& it : m_pInternalData->m_UploadBufferCache)
+            Stats.NumFreeStagingBuffers += static_cast<Uint32>(it.second.size());
+    }
 
     return Stats;
 }
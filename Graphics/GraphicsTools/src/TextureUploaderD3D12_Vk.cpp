@@ -115,11 +115,18 @@ public:
         return m_CopyScheduledSignal.IsTriggered();
     }
 
-    bool DbgIsMapped()
+    bool IsTextureMapped()
     {
         return m_TextureMappedSignal.IsTriggered();
     }
 
+    // Forgets the mapped pointers without unmapping the staging texture.
+    // Staging textures may be released while mapped in Direct3D12 and Vulkan.
+    void DiscardMapping()
+    {
+        UploadBufferBase::Reset();
+    }
+
     Uint64 GetCopyScheduledFenceValue() const
     {
         VERIFY(m_CopyScheduledFenceValue != 0, "Fence value has not been initialized");
@@ -175,6 +182,12 @@ struct TextureUploaderD3D12_Vk::InternalData
 
     ~InternalData()
     {
+        for (auto& it : m_MappedUploadTexturesCache)
+        {
+            for (auto& pUploadTexture : it.second)
+                pUploadTexture->DiscardMapping();
+        }
+
         for (auto it : m_UploadTexturesCache)
         {
             if (it.second.size())
@@ -227,7 +240,17 @@ struct TextureUploaderD3D12_Vk::InternalData
     {
         RefCntAutoPtr<UploadTexture> pUploadTexture;
         std::lock_guard<std::mutex>  CacheLock(m_UploadTexturesCacheMtx);
-        auto                         DequeIt = m_UploadTexturesCache.find(Desc);
+
+        // Textures that have been mapped in advance can be used right away
+        auto MappedDequeIt = m_MappedUploadTexturesCache.find(Desc);
+        if (MappedDequeIt != m_MappedUploadTexturesCache.end() && !MappedDequeIt->second.empty())
+        {
+            pUploadTexture = std::move(MappedDequeIt->second.front());
+            MappedDequeIt->second.pop_front();
+            return pUploadTexture;
+        }
+
+        auto DequeIt = m_UploadTexturesCache.find(Desc);
         if (DequeIt != m_UploadTexturesCache.end())
         {
             auto& Deque = DequeIt->second;
@@ -253,6 +276,50 @@ struct TextureUploaderD3D12_Vk::InternalData
         Deque.emplace_back(pUploadTexture);
     }
 
+    // Maps the recycled textures whose copy has been completed by the GPU.
+    // Must be called by the render thread after UpdatedCompletedFenceValue().
+    void PremapRecycledTextures(IDeviceContext* pContext)
+    {
+        std::vector<RefCntAutoPtr<UploadTexture>> Textures;
+        {
+            std::lock_guard<std::mutex> CacheLock(m_UploadTexturesCacheMtx);
+            for (auto& it : m_UploadTexturesCache)
+            {
+                auto& Deque = it.second;
+                while (!Deque.empty() && Deque.front()->GetCopyScheduledFenceValue() <= m_CompletedFenceValue)
+                {
+                    Textures.emplace_back(std::move(Deque.front()));
+                    Deque.pop_front();
+                }
+            }
+        }
+        if (Textures.empty())
+            return;
+
+        for (auto& pUploadTexture : Textures)
+        {
+            pUploadTexture->Reset();
+            PendingBufferOperation MapOp{PendingBufferOperation::Operation::Map, pUploadTexture};
+            Execute(pContext, MapOp);
+        }
+
+        std::lock_guard<std::mutex> CacheLock(m_UploadTexturesCacheMtx);
+        for (auto& pUploadTexture : Textures)
+            m_MappedUploadTexturesCache[pUploadTexture->GetDesc()].emplace_back(std::move(pUploadTexture));
+    }
+
+    Uint32 GetNumFreeUploadTextures()
+    {
+        std::lock_guard<std::mutex> CacheLock(m_UploadTexturesCacheMtx);
+
+        size_t NumTextures = 0;
+        for (const auto& it : m_UploadTexturesCache)
+            NumTextures += it.second.size();
+        for (const auto& it : m_MappedUploadTexturesCache)
+            NumTextures += it.second.size();
+        return static_cast<Uint32>(NumTextures);
+    }
+
     Uint32 GetNumPendingOperations()
     {
         std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
@@ -268,6 +335,8 @@ private:
 
     std::mutex                                                                     m_UploadTexturesCacheMtx;
     std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadTexture>>> m_UploadTexturesCache;
+    // Recycled textures that have been mapped by PremapRecycledTextures()
+    std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadTexture>>> m_MappedUploadTexturesCache;
 
     RefCntAutoPtr<IFence> m_pFence;
     Uint64                m_NextFenceValue      = 1;
@@ -323,6 +392,9 @@ void TextureUploaderD3D12_Vk::RenderThreadUpdate(IDeviceContext* pContext)
 
     // This must be called by the same thread that signals the fence
     m_pInternalData->UpdatedCompletedFenceValue();
+
+    if (m_Desc.PremapRecycledBuffers)
+        m_pInternalData->PremapRecycledTextures(pContext);
 }
 
 
@@ -349,7 +421,7 @@ void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pCon
 
         case InternalData::PendingBufferOperation::Copy:
         {
-            VERIFY(pUploadTex->DbgIsMapped(), "Upload texture must be copied only after it has been mapped");
+            VERIFY(pUploadTex->IsTextureMapped(), "Upload texture must be copied only after it has been mapped");
             for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
             {
                 for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
@@ -402,9 +474,14 @@ void TextureUploaderD3D12_Vk::AllocateUploadBuffer(IDeviceContext*         pCont
                          GetTextureFormatAttribs(Desc.Format).Name, " staging texture");
 
         pUploadTexture = MakeNewRCObj<UploadTexture>()(Desc, pStagingTexture);
+        OnStagingBufferCreated(Desc);
     }
 
-    if (pContext != nullptr)
+    if (pUploadTexture->IsTextureMapped())
+    {
+        // The texture has been mapped in advance by RenderThreadUpdate()
+    }
+    else if (pContext != nullptr)
     {
         // Render thread
         InternalData::PendingBufferOperation MapOp{InternalData::PendingBufferOperation::Operation::Map, pUploadTexture};
@@ -413,8 +490,10 @@ void TextureUploaderD3D12_Vk::AllocateUploadBuffer(IDeviceContext*         pCont
     else
     {
         // Worker thread
+        Timer StallTimer;
         m_pInternalData->EnqueueMap(pUploadTexture);
         pUploadTexture->WaitForMap();
+        OnWorkerStall(StallTimer.GetElapsedTime());
     }
     *ppBuffer = pUploadTexture.Detach();
 }
@@ -426,6 +505,7 @@ void TextureUploaderD3D12_Vk::ScheduleGPUCopy(IDeviceContext* pContext,
                                               IUploadBuffer*  pUploadBuffer)
 {
     auto* pUploadTexture = ClassPtrCast<UploadTexture>(pUploadBuffer);
+    OnCopyScheduled(pUploadTexture->GetDesc());
     if (pContext != nullptr)
     {
         // Render thread
@@ -464,7 +544,9 @@ void TextureUploaderD3D12_Vk::RecycleBuffer(IUploadBuffer* pUploadBuffer)
 TextureUploaderStats TextureUploaderD3D12_Vk::GetStats()
 {
     TextureUploaderStats Stats;
-    Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->GetNumPendingOperations());
+    GetCommonStats(Stats);
+    Stats.NumPendingOperations  = static_cast<Uint32>(m_pInternalData->GetNumPendingOperations());
+    Stats.NumFreeStagingBuffers = m_pInternalData->GetNumFreeUploadTextures();
     return Stats;
 }
 
@@ -88,8 +88,9 @@ public:
         m_BufferMappedSignal.Trigger();
     }
 
-    void SignalCopyScheduled()
+    void SignalCopyScheduled(Uint64 FenceValue)
     {
+        m_CopyFenceValue = FenceValue;
         m_CopyScheduledSignal.Trigger();
     }
 
@@ -100,6 +101,11 @@ public:
 
     bool DbgIsCopyScheduled() const { return m_CopyScheduledSignal.IsTriggered(); }
 
+    bool IsMapped() const { return m_BufferMappedSignal.IsTriggered(); }
+
+    // The value of the fence signaled after the last copy from the staging buffer, or 0 if there was none
+    Uint64 GetCopyFenceValue() const { return m_CopyFenceValue; }
+
     void SetDataPtr(Uint8* pBufferData)
     {
         for (Uint32 Slice = 0; Slice < m_Desc.ArraySize; ++Slice)
@@ -140,6 +146,7 @@ private:
     Threading::Signal      m_BufferMappedSignal;
     Threading::Signal      m_CopyScheduledSignal;
     RefCntAutoPtr<IBuffer> m_pStagingBuffer;
+    Uint64                 m_CopyFenceValue = 0;
     std::vector<Uint32>    m_SubresourceOffsets;
     std::vector<Uint32>    m_SubresourceStrides;
 };
@@ -149,6 +156,13 @@ private:
 
 struct TextureUploaderGL::InternalData
 {
+    InternalData(IRenderDevice* pDevice)
+    {
+        FenceDesc fenceDesc;
+        fenceDesc.Name = "Texture uploader sync fence";
+        pDevice->CreateFence(fenceDesc, &m_pFence);
+    }
+
     void SwapMapQueues()
     {
         std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
@@ -199,17 +213,43 @@ struct TextureUploaderGL::InternalData
                  IDeviceContext*         pContext,
                  PendingBufferOperation& OperationInfo);
 
+    // Must only be called by the render thread
+    Uint64 SignalFence(IDeviceContext* pContext)
+    {
+        auto FenceValue = m_NextFenceValue++;
+        pContext->EnqueueSignal(m_pFence, FenceValue);
+        return FenceValue;
+    }
+
+    // Must only be called by the render thread
+    void UpdateCompletedFenceValue()
+    {
+        m_CompletedFenceValue = m_pFence->GetCompletedValue();
+    }
+
+    // Maps the recycled buffers whose copy has been completed by the GPU.
+    // Must be called by the render thread after UpdateCompletedFenceValue().
+    void PremapRecycledBuffers(IRenderDevice* pDevice, IDeviceContext* pContext);
+
     std::mutex                          m_PendingOperationsMtx;
     std::vector<PendingBufferOperation> m_PendingOperations;
     std::vector<PendingBufferOperation> m_InWorkOperations;
 
     std::mutex                                                                      m_UploadBuffCacheMtx;
     std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadBufferGL>>> m_UploadBufferCache;
+    // Recycled buffers that have been mapped by PremapRecycledBuffers()
+    std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadBufferGL>>> m_MappedUploadBufferCache;
+
+    // The fence is signaled after the copy operations so that the staging buffers can be
+    // mapped without synchronization (and without orphaning their storage) once the copies complete.
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_NextFenceValue      = 1;
+    Uint64                m_CompletedFenceValue = 0;
 };
 
 TextureUploaderGL::TextureUploaderGL(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
     TextureUploaderBase{pRefCounters, pDevice, Desc},
-    m_pInternalData{new InternalData{}}
+    m_pInternalData{new InternalData{pDevice}}
 {
 }
 
@@ -238,15 +278,65 @@ TextureUploaderGL::~TextureUploaderGL()
 
 void TextureUploaderGL::RenderThreadUpdate(IDeviceContext* pContext)
 {
+    m_pInternalData->UpdateCompletedFenceValue();
+
     m_pInternalData->SwapMapQueues();
     if (!m_pInternalData->m_InWorkOperations.empty())
     {
+        Uint32 NumCopyOperations = 0;
         for (auto& OperationInfo : m_pInternalData->m_InWorkOperations)
         {
             m_pInternalData->Execute(m_pDevice, pContext, OperationInfo);
+            if (OperationInfo.operation == InternalData::PendingBufferOperation::Copy)
+                ++NumCopyOperations;
         }
+
+        if (NumCopyOperations > 0)
+        {
+            // The buffer may be recycled immediately after the copy scheduled is signaled,
+            // so we must signal the fence first.
+            const auto SignaledFenceValue = m_pInternalData->SignalFence(pContext);
+            for (auto& OperationInfo : m_pInternalData->m_InWorkOperations)
+            {
+                if (OperationInfo.operation == InternalData::PendingBufferOperation::Copy)
+                    OperationInfo.pUploadBuffer->SignalCopyScheduled(SignaledFenceValue);
+            }
+        }
+
         m_pInternalData->m_InWorkOperations.clear();
     }
+
+    if (m_Desc.PremapRecycledBuffers)
+        m_pInternalData->PremapRecycledBuffers(m_pDevice, pContext);
+}
+
+void TextureUploaderGL::InternalData::PremapRecycledBuffers(IRenderDevice* pDevice, IDeviceContext* pContext)
+{
+    std::vector<RefCntAutoPtr<UploadBufferGL>> Buffers;
+    {
+        std::lock_guard<std::mutex> CacheLock(m_UploadBuffCacheMtx);
+        for (auto& it : m_UploadBufferCache)
+        {
+            auto& Deque = it.second;
+            while (!Deque.empty() && Deque.front()->GetCopyFenceValue() <= m_CompletedFenceValue)
+            {
+                Buffers.emplace_back(std::move(Deque.front()));
+                Deque.pop_front();
+            }
+        }
+    }
+    if (Buffers.empty())
+        return;
+
+    for (auto& pBuffer : Buffers)
+    {
+        PendingBufferOperation MapOp{PendingBufferOperation::Operation::Map, pBuffer};
+        Execute(pDevice, pContext, MapOp);
+    }
+
+    std::lock_guard<std::mutex> CacheLock(m_UploadBuffCacheMtx);
+    for (auto& pBuffer : Buffers)
+        m_MappedUploadBufferCache[pBuffer->GetDesc()].emplace_back(std::move(pBuffer));
 }
 
 void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
@@ -271,8 +361,13 @@ void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
                 pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer->m_pStagingBuffer);
             }
 
+            // If the GPU has completed the previous copy from the buffer, map it without synchronization.
+            // Otherwise, discard the previous contents, which makes the driver orphan the buffer storage
+            // rather than wait for the copy to complete.
+            const auto MapFlags = pBuffer->GetCopyFenceValue() <= m_CompletedFenceValue ? MAP_FLAG_NO_OVERWRITE : MAP_FLAG_DISCARD;
+
             PVoid CpuAddress = nullptr;
-            pContext->MapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE, MAP_FLAG_DISCARD, CpuAddress);
+            pContext->MapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE, MapFlags, CpuAddress);
             pBuffer->SetDataPtr(reinterpret_cast<Uint8*>(CpuAddress));
 
             pBuffer->SignalMapped();
@@ -300,7 +395,6 @@ void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
                                             SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
                 }
             }
-            pBuffer->SignalCopyScheduled();
         }
         break;
     }
@@ -315,8 +409,18 @@ void TextureUploaderGL::AllocateUploadBuffer(IDeviceContext*         pContext,
 
     {
         std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
-        auto&                       Cache = m_pInternalData->m_UploadBufferCache;
-        if (!Cache.empty())
+
+        // Buffers that have been mapped in advance can be used right away
+        auto& MappedCache   = m_pInternalData->m_MappedUploadBufferCache;
+        auto  MappedDequeIt = MappedCache.find(Desc);
+        if (MappedDequeIt != MappedCache.end() && !MappedDequeIt->second.empty())
+        {
+            pUploadBuffer = std::move(MappedDequeIt->second.front());
+            MappedDequeIt->second.pop_front();
+        }
+
+        auto& Cache = m_pInternalData->m_UploadBufferCache;
+        if (!pUploadBuffer && !Cache.empty())
         {
             auto DequeIt = Cache.find(Desc);
             if (DequeIt != Cache.end())
@@ -334,22 +438,30 @@ void TextureUploaderGL::AllocateUploadBuffer(IDeviceContext*         pContext,
     if (!pUploadBuffer)
     {
         pUploadBuffer = MakeNewRCObj<UploadBufferGL>()(Desc);
+        OnStagingBufferCreated(Desc);
         LOG_INFO_MESSAGE("TextureUploaderGL: created upload buffer for ", Desc.Width, 'x', Desc.Height, 'x',
                          Desc.Depth, ' ', Desc.MipLevels, "-mip ", Desc.ArraySize, "-slice ",
                          m_pDevice->GetTextureFormatInfo(Desc.Format).Name, " texture");
     }
 
-    if (pContext != nullptr)
+    if (pUploadBuffer->IsMapped())
+    {
+        // The buffer has been mapped in advance by RenderThreadUpdate()
+    }
+    else if (pContext != nullptr)
     {
         // Render thread
+        m_pInternalData->UpdateCompletedFenceValue();
         InternalData::PendingBufferOperation MapOp{InternalData::PendingBufferOperation::Operation::Map, pUploadBuffer};
         m_pInternalData->Execute(m_pDevice, pContext, MapOp);
     }
     else
     {
         // Worker thread
+        Timer StallTimer;
         m_pInternalData->EnqueueMap(pUploadBuffer);
         pUploadBuffer->WaitForMap();
+        OnWorkerStall(StallTimer.GetElapsedTime());
     }
     *ppBuffer = pUploadBuffer.Detach();
 }
@@ -361,6 +473,7 @@ void TextureUploaderGL::ScheduleGPUCopy(IDeviceContext* pContext,
                                         IUploadBuffer*  pUploadBuffer)
 {
     auto* pUploadBufferGL = ClassPtrCast<UploadBufferGL>(pUploadBuffer);
+    OnCopyScheduled(pUploadBufferGL->GetDesc());
     if (pContext != nullptr)
     {
         // Render thread
@@ -373,6 +486,10 @@ void TextureUploaderGL::ScheduleGPUCopy(IDeviceContext* pContext,
                 MipLevel //
             };
         m_pInternalData->Execute(m_pDevice, pContext, CopyOp);
+
+        // The buffer may be recycled immediately after the copy scheduled is signaled,
+        // so we must signal the fence first.
+        pUploadBufferGL->SignalCopyScheduled(m_pInternalData->SignalFence(pContext));
     }
     else
     {
@@ -396,9 +513,22 @@ void TextureUploaderGL::RecycleBuffer(IUploadBuffer* pUploadBuffer)
 
 TextureUploaderStats TextureUploaderGL::GetStats()
 {
-    TextureUploaderStats        Stats;
-    std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingOperationsMtx);
-    Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->m_PendingOperations.size());
+    TextureUploaderStats Stats;
+    GetCommonStats(Stats);
+
+    {
+        std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingOperationsMtx);
+        Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->m_PendingOperations.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
+        for (const auto& it : m_pInternalData->m_UploadBufferCache)
+            Stats.NumFreeStagingBuffers += static_cast<Uint32>(it.second.size());
+        for (const auto& it : m_pInternalData->m_MappedUploadBufferCache)
+            Stats.NumFreeStagingBuffers += static_cast<Uint32>(it.second.size());
+    }
+
     return Stats;
 }
 
@@ -340,6 +340,7 @@ void TextureUploaderWebGPU::AllocateUploadBuffer(IDeviceContext*         pContex
     if (!pUploadBuffer)
     {
         pUploadBuffer = MakeNewRCObj<UploadBufferWebGPU>()(Desc);
+        OnStagingBufferCreated(Desc);
         LOG_INFO_MESSAGE("TextureUploaderWebGPU: created upload buffer for ", Desc.Width, 'x', Desc.Height, 'x',
                          Desc.Depth, ' ', Desc.MipLevels, "-mip ", Desc.ArraySize, "-slice ",
                          m_pDevice->GetTextureFormatInfo(Desc.Format).Name, " texture");
@@ -354,8 +355,10 @@ void TextureUploaderWebGPU::AllocateUploadBuffer(IDeviceContext*         pContex
     else
     {
         // Worker thread
+        Timer StallTimer;
         m_pInternalData->EnqueueMap(pUploadBuffer);
         pUploadBuffer->WaitForMap();
+        OnWorkerStall(StallTimer.GetElapsedTime());
     }
     *ppBuffer = pUploadBuffer.Detach();
 }
@@ -367,6 +370,7 @@ void TextureUploaderWebGPU::ScheduleGPUCopy(IDeviceContext* pContext,
                                             IUploadBuffer*  pUploadBuffer)
 {
     auto* pUploadBufferWebGPU = ClassPtrCast<UploadBufferWebGPU>(pUploadBuffer);
+    OnCopyScheduled(pUploadBufferWebGPU->GetDesc());
     if (pContext != nullptr)
     {
         // Render thread
@@ -402,9 +406,20 @@ void TextureUploaderWebGPU::RecycleBuffer(IUploadBuffer* pUploadBuffer)
 
 TextureUploaderStats TextureUploaderWebGPU::GetStats()
 {
-    TextureUploaderStats        Stats;
-    std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingOperationsMtx);
-    Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->m_PendingOperations.size());
+    TextureUploaderStats Stats;
+    GetCommonStats(Stats);
+
+    {
+        std::lock_guard<std::mutex> QueueLock(m_pInternalData->m_PendingOperationsMtx);
+        Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->m_PendingOperations.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
+        for (const auto& it : m_pInternalData->m_UploadBufferCache)
+            Stats.NumFreeStagingBuffers += static_cast<Uint32>(it.second.size());
+    }
+
     return Stats;
 }
 
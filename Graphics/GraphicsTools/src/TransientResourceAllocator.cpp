@@ -0,0 +1,584 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TransientResourceAllocator.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+SPARSE_RESOURCE_CAP_FLAGS GetRequiredSparseTextureCaps(const TextureDesc& Desc)
+{
+    SPARSE_RESOURCE_CAP_FLAGS Caps = SPARSE_RESOURCE_CAP_FLAG_ALIASED;
+    switch (Desc.Type)
+    {
+        case RESOURCE_DIM_TEX_2D:
+        case RESOURCE_DIM_TEX_2D_ARRAY:
+            Caps |= SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D;
+            break;
+
+        case RESOURCE_DIM_TEX_3D:
+            Caps |= SPARSE_RESOURCE_CAP_FLAG_TEXTURE_3D;
+            break;
+
+        default:
+            // Other texture types can't be sparse
+            return SPARSE_RESOURCE_CAP_FLAG_NONE;
+    }
+
+    switch (Desc.SampleCount)
+    {
+        case 1: break;
+        case 2: Caps |= SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2_SAMPLES; break;
+        case 4: Caps |= SPARSE_RESOURCE_CAP_FLAG_TEXTURE_4_SAMPLES; break;
+        case 8: Caps |= SPARSE_RESOURCE_CAP_FLAG_TEXTURE_8_SAMPLES; break;
+        case 16: Caps |= SPARSE_RESOURCE_CAP_FLAG_TEXTURE_16_SAMPLES; break;
+        default: return SPARSE_RESOURCE_CAP_FLAG_NONE;
+    }
+
+    if (Desc.IsArray() && Desc.MipLevels != 1)
+        Caps |= SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D_ARRAY_MIP_TAIL;
+
+    return Caps;
+}
+
+Uint64 GetSparseTextureMemorySize(ITexture* pTexture)
+{
+    const TextureDesc&             Desc  = pTexture->GetDesc();
+    const SparseTextureProperties& Props = pTexture->GetSparseProperties();
+
+    const Uint32 NumNormalMips = std::min(Desc.MipLevels, Props.FirstMipInTail);
+    const bool   HasMipTail    = Desc.MipLevels > Props.FirstMipInTail;
+
+    Uint64 NumBlocksInSlice = 0;
+    for (Uint32 Mip = 0; Mip < NumNormalMips; ++Mip)
+    {
+        const uint3 NumTilesInMip = GetNumSparseTilesInMipLevel(Desc, Props.TileSize, Mip);
+        NumBlocksInSlice += Uint64{NumTilesInMip.x} * Uint64{NumTilesInMip.y} * Uint64{NumTilesInMip.z};
+    }
+
+    const Uint32 NumSlices   = Desc.GetArraySize();
+    const Uint32 NumMipTails = HasMipTail ? ((Props.Flags & SPARSE_TEXTURE_FLAG_SINGLE_MIPTAIL) != 0 ? 1 : NumSlices) : 0;
+    return NumBlocksInSlice * Props.BlockSize * NumSlices + Props.MipTailSize * NumMipTails;
+}
+
+void GetSparseTextureBindRanges(ITexture* pTexture, IDeviceMemory* pMemory, Uint64 MemoryOffset, std::vector<SparseTextureMemoryBindRange>& Ranges)
+{
+    const TextureDesc&             Desc  = pTexture->GetDesc();
+    const SparseTextureProperties& Props = pTexture->GetSparseProperties();
+
+    const Uint32 NumNormalMips = std::min(Desc.MipLevels, Props.FirstMipInTail);
+    const bool   HasMipTail    = Desc.MipLevels > Props.FirstMipInTail;
+    const bool   SingleMipTail = (Props.Flags & SPARSE_TEXTURE_FLAG_SINGLE_MIPTAIL) != 0;
+    const Uint32 NumSlices     = Desc.GetArraySize();
+#ifdef DILIGENT_DEBUG
+    const Uint64 EndMemoryOffset = MemoryOffset + GetSparseTextureMemorySize(pTexture);
+#endif
+
+    for (Uint32 Slice = 0; Slice < NumSlices; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < NumNormalMips; ++Mip)
+        {
+            const MipLevelProperties MipProps = GetMipLevelProperties(Desc, Mip);
+
+            SparseTextureMemoryBindRange Range;
+            Range.ArraySlice   = Slice;
+            Range.MipLevel     = Mip;
+            Range.Region       = Box{0, MipProps.StorageWidth, 0, MipProps.StorageHeight, 0, MipProps.Depth};
+            Range.pMemory      = pMemory;
+            Range.MemoryOffset = MemoryOffset;
+
+            const uint3 NumTilesInMip = GetNumSparseTilesInBox(Range.Region, Props.TileSize);
+            Range.MemorySize          = Uint64{NumTilesInMip.x} * NumTilesInMip.y * NumTilesInMip.z * Props.BlockSize;
+
+            MemoryOffset += Range.MemorySize;
+            Ranges.push_back(Range);
+        }
+
+        if (HasMipTail && (!SingleMipTail || Slice == 0))
+        {
+            SparseTextureMemoryBindRange Range;
+            Range.ArraySlice   = Slice;
+            Range.MipLevel     = Props.FirstMipInTail;
+            Range.MemorySize   = Props.MipTailSize;
+            Range.pMemory      = pMemory;
+            Range.MemoryOffset = MemoryOffset;
+
+            MemoryOffset += Range.MemorySize;
+            Ranges.push_back(Range);
+        }
+    }
+#ifdef DILIGENT_DEBUG
+    VERIFY_EXPR(MemoryOffset == EndMemoryOffset);
+#endif
+}
+
+} // namespace
+
+TransientResourceAllocator::TransientResourceAllocator(IRenderDevice* pDevice, const TransientResourceAllocatorCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Name{CI.Name != nullptr ? CI.Name : "Transient resource allocator"}
+{
+    DEV_CHECK_ERR(m_pDevice, "Render device must not be null");
+
+    const RenderDeviceInfo& DeviceInfo = m_pDevice->GetDeviceInfo();
+    // Direct3D11 requires the entire sparse resource to use a single memory object and Metal requires
+    // the memory at creation time, so aliasing is only performed in Direct3D12 and Vulkan.
+    m_AliasingSupported =
+        CI.EnableAliasing &&
+        DeviceInfo.Features.SparseResources &&
+        (DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12 || DeviceInfo.Type == RENDER_DEVICE_TYPE_VULKAN) &&
+        (m_pDevice->GetAdapterInfo().SparseResources.CapFlags & SPARSE_RESOURCE_CAP_FLAG_ALIASED) != 0;
+}
+
+TransientResourceAllocator::~TransientResourceAllocator()
+{
+}
+
+Uint32 TransientResourceAllocator::AddTexture(const TextureDesc& Desc, Uint32 FirstUse, Uint32 LastUse)
+{
+    DEV_CHECK_ERR(Desc.Usage == USAGE_DEFAULT, "Transient texture '", (Desc.Name != nullptr ? Desc.Name : ""), "' must use USAGE_DEFAULT");
+    DEV_CHECK_ERR(FirstUse <= LastUse, "The first use (", FirstUse, ") must not be greater than the last use (", LastUse, ")");
+
+    ResourceInfo Res;
+    Res.IsTexture    = true;
+    Res.Name         = Desc.Name != nullptr ? Desc.Name : "";
+    Res.TexDesc      = Desc;
+    Res.TexDesc.Name = nullptr;
+    Res.FirstUse     = FirstUse;
+    Res.LastUse      = LastUse;
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<Uint32>(m_Resources.size() - 1);
+}
+
+Uint32 TransientResourceAllocator::AddBuffer(const BufferDesc& Desc, Uint32 FirstUse, Uint32 LastUse)
+{
+    DEV_CHECK_ERR(Desc.Usage == USAGE_DEFAULT, "Transient buffer '", (Desc.Name != nullptr ? Desc.Name : ""), "' must use USAGE_DEFAULT");
+    DEV_CHECK_ERR(FirstUse <= LastUse, "The first use (", FirstUse, ") must not be greater than the last use (", LastUse, ")");
+
+    ResourceInfo Res;
+    Res.IsTexture     = false;
+    Res.Name          = Desc.Name != nullptr ? Desc.Name : "";
+    Res.BuffDesc      = Desc;
+    Res.BuffDesc.Name = nullptr;
+    Res.FirstUse      = FirstUse;
+    Res.LastUse       = LastUse;
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<Uint32>(m_Resources.size() - 1);
+}
+
+bool TransientResourceAllocator::CanAlias(const ResourceInfo& Res) const
+{
+    if (!m_AliasingSupported)
+        return false;
+
+    const SPARSE_RESOURCE_CAP_FLAGS SupportedCaps = m_pDevice->GetAdapterInfo().SparseResources.CapFlags;
+    if (Res.IsTexture)
+    {
+        const TextureDesc& Desc = Res.TexDesc;
+        if (Desc.Usage != USAGE_DEFAULT || Desc.CPUAccessFlags != CPU_ACCESS_NONE || (Desc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) != 0)
+            return false;
+
+        const SPARSE_RESOURCE_CAP_FLAGS RequiredCaps = GetRequiredSparseTextureCaps(Desc);
+        if (RequiredCaps == SPARSE_RESOURCE_CAP_FLAG_NONE || (SupportedCaps & RequiredCaps) != RequiredCaps)
+            return false;
+
+        const SparseTextureFormatInfo FmtInfo = m_pDevice->GetSparseTextureFormatInfo(Desc.Format, Desc.Type, Desc.SampleCount);
+        return (FmtInfo.BindFlags & Desc.BindFlags) == Desc.BindFlags;
+    }
+    else
+    {
+        const BufferDesc& Desc = Res.BuffDesc;
+        if (Desc.Usage != USAGE_DEFAULT || Desc.CPUAccessFlags != CPU_ACCESS_NONE)
+            return false;
+
+        return (SupportedCaps & SPARSE_RESOURCE_CAP_FLAG_BUFFER) != 0;
+    }
+}
+
+bool TransientResourceAllocator::CreateSparseResource(ResourceInfo& Res)
+{
+    VERIFY_EXPR(!Res.pObject);
+
+    if (Res.IsTexture)
+    {
+        TextureDesc Desc = Res.TexDesc;
+        Desc.Name        = Res.Name.c_str();
+        Desc.Usage       = USAGE_SPARSE;
+        Desc.MiscFlags |= MISC_TEXTURE_FLAG_SPARSE_ALIASING;
+
+        RefCntAutoPtr<ITexture> pTexture;
+        m_pDevice->CreateTexture(Desc, nullptr, &pTexture);
+        if (!pTexture)
+            return false;
+
+        Res.MemorySize = GetSparseTextureMemorySize(pTexture);
+        Res.Alignment  = pTexture->GetSparseProperties().BlockSize;
+        Res.pObject    = pTexture;
+    }
+    else
+    {
+        BufferDesc Desc = Res.BuffDesc;
+        Desc.Name       = Res.Name.c_str();
+        Desc.Usage      = USAGE_SPARSE;
+        Desc.MiscFlags |= MISC_BUFFER_FLAG_SPARSE_ALIASING;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+        if (!pBuffer)
+            return false;
+
+        const SparseBufferProperties& Props = pBuffer->GetSparseProperties();
+
+        Res.MemorySize = AlignUp(Desc.Size, Uint64{Props.BlockSize});
+        Res.Alignment  = Props.BlockSize;
+        Res.pObject    = pBuffer;
+    }
+
+    VERIFY_EXPR(IsPowerOfTwo(Res.Alignment));
+    Res.IsAliased = true;
+    return true;
+}
+
+Uint64 TransientResourceAllocator::PackResources(const std::vector<Uint32>& Resources)
+{
+    // Greedy packing: place the largest resources first at the lowest offset at which
+    // the resource does not overlap any already placed resource whose lifetime overlaps its own.
+    std::vector<Uint32> SortedResources = Resources;
+    std::sort(SortedResources.begin(), SortedResources.end(),
+              [this](Uint32 lhs, Uint32 rhs) {
+                  const ResourceInfo& L = m_Resources[lhs];
+                  const ResourceInfo& R = m_Resources[rhs];
+                  return L.MemorySize != R.MemorySize ? L.MemorySize > R.MemorySize : L.FirstUse < R.FirstUse;
+              });
+
+    Uint64 TotalSize = 0;
+
+    std::vector<Uint32> PlacedResources;
+    std::vector<Uint32> Conflicts;
+    for (Uint32 ResIdx : SortedResources)
+    {
+        ResourceInfo& Res = m_Resources[ResIdx];
+
+        Conflicts.clear();
+        for (Uint32 PlacedIdx : PlacedResources)
+        {
+            if (m_Resources[PlacedIdx].OverlapsInTime(Res))
+                Conflicts.push_back(PlacedIdx);
+        }
+        std::sort(Conflicts.begin(), Conflicts.end(),
+                  [this](Uint32 lhs, Uint32 rhs) {
+                      return m_Resources[lhs].MemoryOffset < m_Resources[rhs].MemoryOffset;
+                  });
+
+        Uint64 Offset = 0;
+        for (Uint32 ConflictIdx : Conflicts)
+        {
+            const ResourceInfo& Conflict = m_Resources[ConflictIdx];
+            if (Offset + Res.MemorySize <= Conflict.MemoryOffset)
+                break;
+            Offset = std::max(Offset, AlignUp(Conflict.MemoryOffset + Conflict.MemorySize, Uint64{Res.Alignment}));
+        }
+
+        Res.MemoryOffset = Offset;
+        TotalSize        = std::max(TotalSize, Offset + Res.MemorySize);
+        PlacedResources.push_back(ResIdx);
+
+        m_Stats.AliasedResourcesSize += Res.MemorySize;
+    }
+
+    return TotalSize;
+}
+
+bool TransientResourceAllocator::CreateMemory(const std::vector<Uint32>& Resources, Uint64 Size, const char* Kind, RefCntAutoPtr<IDeviceMemory>& pMemory)
+{
+    VERIFY_EXPR(!pMemory && Size > 0);
+
+    std::vector<IDeviceObject*> CompatibleResources;
+    CompatibleResources.reserve(Resources.size());
+    for (Uint32 ResIdx : Resources)
+        CompatibleResources.push_back(m_Resources[ResIdx].pObject);
+
+    const std::string Name = m_Name + " - " + Kind + " memory";
+
+    DeviceMemoryCreateInfo MemCI;
+    MemCI.Desc.Name             = Name.c_str();
+    MemCI.Desc.Type             = DEVICE_MEMORY_TYPE_SPARSE;
+    MemCI.Desc.PageSize         = Size;
+    MemCI.InitialSize           = Size;
+    MemCI.ppCompatibleResources = CompatibleResources.data();
+    MemCI.NumResources          = static_cast<Uint32>(CompatibleResources.size());
+    m_pDevice->CreateDeviceMemory(MemCI, &pMemory);
+    if (!pMemory)
+    {
+        LOG_ERROR_MESSAGE("Failed to create ", Kind, " memory for '", m_Name, "'. Aliasing will be disabled for these resources.");
+        return false;
+    }
+
+    m_Stats.MemorySize += Size;
+    return true;
+}
+
+void TransientResourceAllocator::BindMemory(IDeviceContext* pContext)
+{
+    // Ranges are collected first as the bind infos reference them
+    std::vector<std::vector<SparseTextureMemoryBindRange>> TextureRanges;
+    std::vector<SparseBufferMemoryBindRange>               BufferRanges;
+    std::vector<const ResourceInfo*>                       Textures;
+    std::vector<const ResourceInfo*>                       Buffers;
+    for (const ResourceInfo& Res : m_Resources)
+    {
+        if (!Res.IsAliased)
+            continue;
+
+        if (Res.IsTexture)
+        {
+            TextureRanges.emplace_back();
+            GetSparseTextureBindRanges(Res.pObject.RawPtr<ITexture>(), m_pTextureMemory, Res.MemoryOffset, TextureRanges.back());
+            Textures.push_back(&Res);
+        }
+        else
+        {
+            SparseBufferMemoryBindRange Range;
+            Range.BufferOffset = 0;
+            Range.MemoryOffset = Res.MemoryOffset;
+            Range.MemorySize   = Res.MemorySize;
+            Range.pMemory      = m_pBufferMemory;
+            BufferRanges.push_back(Range);
+            Buffers.push_back(&Res);
+        }
+    }
+
+    std::vector<SparseTextureMemoryBindInfo> TexBinds(Textures.size());
+    for (size_t i = 0; i < Textures.size(); ++i)
+    {
+        TexBinds[i].pTexture  = Textures[i]->pObject.RawPtr<ITexture>();
+        TexBinds[i].pRanges   = TextureRanges[i].data();
+        TexBinds[i].NumRanges = static_cast<Uint32>(TextureRanges[i].size());
+    }
+
+    std::vector<SparseBufferMemoryBindInfo> BuffBinds(Buffers.size());
+    for (size_t i = 0; i < Buffers.size(); ++i)
+    {
+        BuffBinds[i].pBuffer   = Buffers[i]->pObject.RawPtr<IBuffer>();
+        BuffBinds[i].pRanges   = &BufferRanges[i];
+        BuffBinds[i].NumRanges = 1;
+    }
+
+    if (TexBinds.empty() && BuffBinds.empty())
+        return;
+
+    BindSparseResourceMemoryAttribs BindMemAttribs;
+    BindMemAttribs.NumTextureBinds = static_cast<Uint32>(TexBinds.size());
+    BindMemAttribs.pTextureBinds   = TexBinds.data();
+    BindMemAttribs.NumBufferBinds  = static_cast<Uint32>(BuffBinds.size());
+    BindMemAttribs.pBufferBinds    = BuffBinds.data();
+    pContext->BindSparseResourceMemory(BindMemAttribs);
+}
+
+bool TransientResourceAllocator::CreatePooledResources(const std::vector<Uint32>& Resources)
+{
+    // Resources are processed in the order of their first use. A resource reuses the object of
+    // a previous resource with the same description whose lifetime has ended.
+    std::vector<Uint32> SortedResources = Resources;
+    std::sort(SortedResources.begin(), SortedResources.end(),
+              [this](Uint32 lhs, Uint32 rhs) {
+                  return m_Resources[lhs].FirstUse < m_Resources[rhs].FirstUse;
+              });
+
+    // The last resource that uses the object
+    std::vector<Uint32> PooledObjects;
+
+    bool Success = true;
+    for (Uint32 ResIdx : SortedResources)
+    {
+        ResourceInfo& Res = m_Resources[ResIdx];
+        VERIFY_EXPR(!Res.IsAliased);
+
+        for (Uint32& OwnerIdx : PooledObjects)
+        {
+            const ResourceInfo& Owner = m_Resources[OwnerIdx];
+            if (Owner.IsTexture != Res.IsTexture || Owner.LastUse >= Res.FirstUse)
+                continue;
+
+            if ((Res.IsTexture && Owner.TexDesc == Res.TexDesc) || (!Res.IsTexture && Owner.BuffDesc == Res.BuffDesc))
+            {
+                Res.pObject = Owner.pObject;
+                OwnerIdx    = ResIdx;
+                break;
+            }
+        }
+        if (Res.pObject)
+            continue;
+
+        if (Res.IsTexture)
+        {
+            TextureDesc Desc = Res.TexDesc;
+            Desc.Name        = Res.Name.c_str();
+
+            RefCntAutoPtr<ITexture> pTexture;
+            m_pDevice->CreateTexture(Desc, nullptr, &pTexture);
+            Res.pObject = pTexture;
+        }
+        else
+        {
+            BufferDesc Desc = Res.BuffDesc;
+            Desc.Name       = Res.Name.c_str();
+
+            RefCntAutoPtr<IBuffer> pBuffer;
+            m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+            Res.pObject = pBuffer;
+        }
+
+        if (!Res.pObject)
+        {
+            LOG_ERROR_MESSAGE("Failed to create transient ", (Res.IsTexture ? "texture" : "buffer"), " '", Res.Name, "'");
+            Success = false;
+            continue;
+        }
+
+        PooledObjects.push_back(ResIdx);
+    }
+
+    m_Stats.NumPooledObjects = static_cast<Uint32>(PooledObjects.size());
+    return Success;
+}
+
+bool TransientResourceAllocator::Allocate(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    for (ResourceInfo& Res : m_Resources)
+    {
+        Res.pObject.Release();
+        Res.IsAliased    = false;
+        Res.MemoryOffset = 0;
+        Res.MemorySize   = 0;
+        Res.Alignment    = 0;
+    }
+    m_pTextureMemory.Release();
+    m_pBufferMemory.Release();
+    m_Stats              = {};
+    m_Stats.NumResources = static_cast<Uint32>(m_Resources.size());
+
+    std::vector<Uint32> AliasedTextures;
+    std::vector<Uint32> AliasedBuffers;
+    std::vector<Uint32> PooledResources;
+    for (Uint32 i = 0; i < m_Resources.size(); ++i)
+    {
+        ResourceInfo& Res = m_Resources[i];
+        if (CanAlias(Res) && CreateSparseResource(Res))
+            (Res.IsTexture ? AliasedTextures : AliasedBuffers).push_back(i);
+        else
+            PooledResources.push_back(i);
+    }
+
+    // Textures and buffers use separate memory objects as not all devices
+    // support mixing resource types in one heap.
+    const auto AllocateMemory = [&](std::vector<Uint32>& Resources, const char* Kind, RefCntAutoPtr<IDeviceMemory>& pMemory) {
+        if (Resources.empty())
+            return;
+
+        const Uint64 Size = PackResources(Resources);
+        if (CreateMemory(Resources, Size, Kind, pMemory))
+        {
+            m_Stats.NumAliasedResources += static_cast<Uint32>(Resources.size());
+            return;
+        }
+
+        for (Uint32 ResIdx : Resources)
+        {
+            ResourceInfo& Res = m_Resources[ResIdx];
+            Res.pObject.Release();
+            Res.IsAliased = false;
+            PooledResources.push_back(ResIdx);
+        }
+        Resources.clear();
+    };
+    AllocateMemory(AliasedTextures, "texture", m_pTextureMemory);
+    AllocateMemory(AliasedBuffers, "buffer", m_pBufferMemory);
+
+    BindMemory(pContext);
+
+    return CreatePooledResources(PooledResources);
+}
+
+ITexture* TransientResourceAllocator::GetTexture(Uint32 Index) const
+{
+    DEV_CHECK_ERR(Index < m_Resources.size(), "Resource index (", Index, ") is out of range");
+    DEV_CHECK_ERR(m_Resources[Index].IsTexture, "Resource ", Index, " is not a texture");
+    return Index < m_Resources.size() && m_Resources[Index].IsTexture ?
+        m_Resources[Index].pObject.RawPtr<ITexture>() :
+        nullptr;
+}
+
+IBuffer* TransientResourceAllocator::GetBuffer(Uint32 Index) const
+{
+    DEV_CHECK_ERR(Index < m_Resources.size(), "Resource index (", Index, ") is out of range");
+    DEV_CHECK_ERR(!m_Resources[Index].IsTexture, "Resource ", Index, " is not a buffer");
+    return Index < m_Resources.size() && !m_Resources[Index].IsTexture ?
+        m_Resources[Index].pObject.RawPtr<IBuffer>() :
+        nullptr;
+}
+
+void TransientResourceAllocator::GetAliasingBarriers(Uint32 UseIndex, std::vector<StateTransitionDesc>& Barriers) const
+{
+    for (const ResourceInfo& Res : m_Resources)
+    {
+        if (!Res.IsAliased || Res.FirstUse != UseIndex)
+            continue;
+
+        const ResourceInfo* pBefore = nullptr;
+        for (const ResourceInfo& Other : m_Resources)
+        {
+            if (!Other.IsAliased || Other.IsTexture != Res.IsTexture || Other.LastUse >= UseIndex || !Other.OverlapsInMemory(Res))
+                continue;
+            if (pBefore == nullptr || Other.LastUse > pBefore->LastUse)
+                pBefore = &Other;
+        }
+
+        if (pBefore != nullptr)
+            Barriers.emplace_back(pBefore->pObject, Res.pObject);
+    }
+}
+
+void TransientResourceAllocator::Reset()
+{
+    m_Resources.clear();
+    m_pTextureMemory.Release();
+    m_pBufferMemory.Release();
+    m_Stats = {};
+}
+
+} // namespace Diligent
@@ -29,6 +29,8 @@
 #include <mutex>
 #include <atomic>
 #include <memory>
+#include <map>
+#include <vector>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
@@ -83,7 +85,7 @@ public:
 
     virtual Uint32 GetStartVertex() const override final
     {
-        return m_StartVertex;
+        return m_StartVertex.load();
     }
 
     virtual Uint32 GetVertexCount() const override final
@@ -107,13 +109,28 @@ public:
         return m_pUserData;
     }
 
+    // The following methods must only be called by the parent pool while its mutex is locked.
+    VariableSizeAllocationsManager::Allocation Relocate(VariableSizeAllocationsManager::Allocation&& NewRegion)
+    {
+        VERIFY_EXPR(NewRegion.IsValid());
+        std::swap(m_Region, NewRegion);
+        m_StartVertex.store(static_cast<Uint32>(m_Region.UnalignedOffset));
+        return std::move(NewRegion);
+    }
+
+    VariableSizeAllocationsManager::Allocation ReleaseRegion()
+    {
+        return std::move(m_Region);
+    }
+
 private:
     RefCntAutoPtr<VertexPoolImpl> m_pParentPool;
 
     VariableSizeAllocationsManager::Allocation m_Region;
 
-    const Uint32 m_StartVertex;
-    const Uint32 m_VertexCount;
+    // The start vertex is updated by the defragmentation and may be read in other threads.
+    std::atomic<Uint32> m_StartVertex;
+    const Uint32        m_VertexCount;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
@@ -311,30 +328,41 @@ public:
             }
 
             UpdateUsageStats();
-        }
 
-        if (Region.IsValid())
-        {
-            // clang-format off
-            VertexPoolAllocationImpl* pSuballocation{
-                NEW_RC_OBJ(m_AllocationObjAllocator, "VertexPoolAllocationImpl instance", VertexPoolAllocationImpl)
-                (
-                    this,
-                    static_cast<Uint32>(Region.UnalignedOffset),
-                    NumVertices,
-                    std::move(Region)
-                )
-            };
-            // clang-format on
-
-            pSuballocation->QueryInterface(IID_VertexPoolAllocation, reinterpret_cast<IObject**>(ppAllocation));
-            m_AllocationCount.fetch_add(1);
+            if (Region.IsValid())
+            {
+                const auto StartVertex = Region.UnalignedOffset;
+                // clang-format off
+                VertexPoolAllocationImpl* pSuballocation{
+                    NEW_RC_OBJ(m_AllocationObjAllocator, "VertexPoolAllocationImpl instance", VertexPoolAllocationImpl)
+                    (
+                        this,
+                        static_cast<Uint32>(StartVertex),
+                        NumVertices,
+                        std::move(Region)
+                    )
+                };
+                // clang-format on
+
+                // Register the allocation while the mutex is locked so that
+                // the defragmentation never misses it.
+                m_Allocations.emplace(StartVertex, pSuballocation);
+
+                pSuballocation->QueryInterface(IID_VertexPoolAllocation, reinterpret_cast<IObject**>(ppAllocation));
+                m_AllocationCount.fetch_add(1);
+            }
         }
     }
 
-    void Free(VariableSizeAllocationsManager::Allocation&& Region)
+    void Free(VertexPoolAllocationImpl& Allocation)
     {
         std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+        // NB: the region must be read while the mutex is locked as it may be changed by Defragment().
+        auto Region = Allocation.ReleaseRegion();
+        VERIFY_EXPR(m_Allocations.count(Region.UnalignedOffset) == 1 && m_Allocations[Region.UnalignedOffset] == &Allocation);
+        m_Allocations.erase(Region.UnalignedOffset);
+
         m_Mgr.Free(std::move(Region));
         m_AllocationCount.fetch_add(-1);
         UpdateUsageStats();
@@ -353,6 +381,136 @@ public:
         return m_Desc;
     }
 
+    virtual Uint64 Defragment(IRenderDevice* pDevice, IDeviceContext* pContext, Uint64 MaxBytesToMove) override final
+    {
+        if (pContext == nullptr)
+        {
+            UNEXPECTED("pContext must not be null");
+            return 0;
+        }
+
+        UpdateAll(pDevice, pContext);
+
+        Uint64 VertexSize = 0;
+        Uint64 Capacity   = ~Uint64{0};
+        for (Uint32 i = 0; i < m_Buffers.size(); ++i)
+        {
+            if (m_Buffers[i]->GetBuffer() == nullptr)
+                return 0;
+            VertexSize += m_Elements[i].Size;
+            Capacity = std::min(Capacity, m_Buffers[i]->GetDesc().Size / m_Elements[i].Size);
+        }
+        if (VertexSize == 0 || MaxBytesToMove < VertexSize)
+            return 0;
+
+        // NB: the mutex is held while copy commands are recorded to make sure
+        //     that allocations are not released while they are being moved.
+        std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+        if (m_Mgr.GetFreeSize() == 0)
+            return 0;
+
+        const Uint64 MaxVerticesToMove = MaxBytesToMove / VertexSize;
+
+        m_PendingMoves.clear();
+        Uint64 VerticesToMove = 0;
+        // Start from the end of the pool to shrink the used range.
+        for (auto it = m_Allocations.rbegin(); it != m_Allocations.rend() && VerticesToMove < MaxVerticesToMove; ++it)
+        {
+            VertexPoolAllocationImpl& Allocation = *it->second;
+
+            const Uint32 VertexCount = Allocation.GetVertexCount();
+            const Uint32 SrcVertex   = Allocation.GetStartVertex();
+            if (VerticesToMove + VertexCount > MaxVerticesToMove || Uint64{SrcVertex} + VertexCount > Capacity)
+                continue;
+
+            auto NewRegion = m_Mgr.Allocate(VertexCount, 1);
+            if (!NewRegion.IsValid())
+                continue;
+
+            const Uint32 DstVertex = static_cast<Uint32>(NewRegion.UnalignedOffset);
+            if (DstVertex >= SrcVertex || Uint64{DstVertex} + VertexCount > Capacity)
+            {
+                // The best-fit free range is not closer to the beginning of the pool
+                m_Mgr.Free(std::move(NewRegion));
+                continue;
+            }
+
+            m_PendingMoves.emplace_back(Allocation, std::move(NewRegion), SrcVertex, VerticesToMove);
+            VerticesToMove += VertexCount;
+        }
+
+        if (m_PendingMoves.empty())
+            return 0;
+
+        // Each vertex element is copied to its own range of the scratch buffer.
+        std::vector<Uint64> ScratchOffsets(m_Buffers.size());
+        Uint64              ScratchSize = 0;
+        for (size_t i = 0; i < m_Buffers.size(); ++i)
+        {
+            ScratchOffsets[i] = ScratchSize;
+            ScratchSize += AlignUp(VerticesToMove * m_Elements[i].Size, Uint64{16});
+        }
+
+        IBuffer* pScratchBuffer = GetScratchBuffer(pDevice, ScratchSize);
+        if (pScratchBuffer == nullptr)
+        {
+            for (auto& Move : m_PendingMoves)
+                m_Mgr.Free(std::move(Move.NewRegion));
+            m_PendingMoves.clear();
+            return 0;
+        }
+
+        // Source and destination ranges are in the same buffer, which can't be in the copy
+        // source and copy destination states at the same time, so the data is copied through
+        // the scratch buffer.
+        for (size_t i = 0; i < m_Buffers.size(); ++i)
+        {
+            IBuffer*     pBuffer  = m_Buffers[i]->GetBuffer();
+            const Uint64 ElemSize = m_Elements[i].Size;
+            for (const auto& Move : m_PendingMoves)
+            {
+                pContext->CopyBuffer(pBuffer, Move.SrcVertex * ElemSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                     pScratchBuffer, ScratchOffsets[i] + Move.ScratchVertex * ElemSize, Move.pAllocation->GetVertexCount() * ElemSize,
+                                     RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+        }
+        for (size_t i = 0; i < m_Buffers.size(); ++i)
+        {
+            IBuffer*     pBuffer  = m_Buffers[i]->GetBuffer();
+            const Uint64 ElemSize = m_Elements[i].Size;
+            for (const auto& Move : m_PendingMoves)
+            {
+                pContext->CopyBuffer(pScratchBuffer, ScratchOffsets[i] + Move.ScratchVertex * ElemSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                     pBuffer, Move.NewRegion.UnalignedOffset * ElemSize, Move.pAllocation->GetVertexCount() * ElemSize,
+                                     RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+        }
+
+        for (auto& Move : m_PendingMoves)
+        {
+            VertexPoolAllocationImpl& Allocation = *Move.pAllocation;
+
+            const auto NewStartVertex = Move.NewRegion.UnalignedOffset;
+
+            auto OldRegion = Allocation.Relocate(std::move(Move.NewRegion));
+            m_Allocations.erase(OldRegion.UnalignedOffset);
+            m_Allocations.emplace(NewStartVertex, &Allocation);
+            m_Mgr.Free(std::move(OldRegion));
+        }
+        m_PendingMoves.clear();
+
+        UpdateUsageStats();
+        m_LayoutVersion.fetch_add(1);
+
+        return VerticesToMove * VertexSize;
+    }
+
+    virtual Uint32 GetLayoutVersion() const override final
+    {
+        return m_LayoutVersion.load();
+    }
+
     virtual void GetUsageStats(VertexPoolUsageStats& UsageStats) override final
     {
         // NB: mutex must not be locked here to avoid stalling render thread
@@ -383,6 +541,33 @@ private:
         m_CommittedMemorySize.store(CommittedMemorySize);
     }
 
+    IBuffer* GetScratchBuffer(IRenderDevice* pDevice, Uint64 Size)
+    {
+        if (m_pScratchBuffer && m_pScratchBuffer->GetDesc().Size >= Size)
+            return m_pScratchBuffer;
+
+        if (pDevice == nullptr)
+        {
+            UNEXPECTED("pDevice must not be null when the scratch buffer needs to be created");
+            return nullptr;
+        }
+
+        std::string Name = m_Name;
+        Name += " - defragmentation scratch buffer";
+
+        BufferDesc ScratchDesc;
+        ScratchDesc.Name  = Name.c_str();
+        ScratchDesc.Size  = m_pScratchBuffer ? std::max(Size, m_pScratchBuffer->GetDesc().Size * 2) : Size;
+        ScratchDesc.Usage = USAGE_DEFAULT;
+
+        m_pScratchBuffer.Release();
+        pDevice->CreateBuffer(ScratchDesc, nullptr, &m_pScratchBuffer);
+        if (!m_pScratchBuffer)
+            LOG_ERROR_MESSAGE("Failed to create the defragmentation scratch buffer for vertex pool '", m_Name, "'");
+
+        return m_pScratchBuffer;
+    }
+
 private:
     const std::string                        m_Name;
     const std::vector<VertexPoolElementDesc> m_Elements;
@@ -406,12 +591,39 @@ private:
     std::atomic<Uint64> m_TotalVertexCount{0};
 
     FixedBlockMemoryAllocator m_AllocationObjAllocator;
+
+    // Live allocations sorted by the start vertex. Protected by m_MgrMtx.
+    std::map<VariableSizeAllocationsManager::OffsetType, VertexPoolAllocationImpl*> m_Allocations;
+
+    struct PendingMove
+    {
+        PendingMove(VertexPoolAllocationImpl&                    _Allocation,
+                    VariableSizeAllocationsManager::Allocation&& _NewRegion,
+                    Uint64                                       _SrcVertex,
+                    Uint64                                       _ScratchVertex) :
+            // clang-format off
+            pAllocation  {&_Allocation},
+            NewRegion    {std::move(_NewRegion)},
+            SrcVertex    {_SrcVertex},
+            ScratchVertex{_ScratchVertex}
+        // clang-format on
+        {}
+
+        VertexPoolAllocationImpl*                  pAllocation;
+        VariableSizeAllocationsManager::Allocation NewRegion;
+        Uint64                                     SrcVertex;
+        Uint64                                     ScratchVertex;
+    };
+    std::vector<PendingMove> m_PendingMoves;
+
+    RefCntAutoPtr<IBuffer> m_pScratchBuffer;
+    std::atomic<Uint32>    m_LayoutVersion{0};
 };
 
 
 VertexPoolAllocationImpl::~VertexPoolAllocationImpl()
 {
-    m_pParentPool->Free(std::move(m_Region));
+    m_pParentPool->Free(*this);
 }
 
 IVertexPool* VertexPoolAllocationImpl::GetPool()
@@ -0,0 +1,575 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "VirtualTextureManager.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+#include "PlatformMisc.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+struct VirtualTextureManager::TileLoadRequest
+{
+    VirtualTextureTile Tile;
+    Uint32             Page = 0;
+
+    RefCntAutoPtr<IUploadBuffer> pBuffer;
+    RefCntAutoPtr<IAsyncTask>    pTask;
+
+    enum STATUS : int
+    {
+        STATUS_PENDING = 0,
+        STATUS_LOADED,
+        STATUS_FAILED
+    };
+    std::atomic<int> Status{STATUS_PENDING};
+};
+
+static constexpr Uint32 InvalidPhysicalPage = ~0u;
+
+VirtualTextureManager::VirtualTextureManager(IRenderDevice* pDevice, const VirtualTextureManagerCreateInfo& CI) :
+    // clang-format off
+    m_Name            {CI.Name != nullptr ? CI.Name : "Virtual texture"},
+    m_TileSize        {CI.TileSize},
+    m_Format          {CI.Format},
+    m_NumTilesX       {CI.TileSize != 0 ? CI.Width  / CI.TileSize : 0},
+    m_NumTilesY       {CI.TileSize != 0 ? CI.Height / CI.TileSize : 0},
+    m_MaxLoadsPerFrame{std::max(CI.MaxLoadsPerFrame, 1u)},
+    m_MaxPendingLoads {std::max(CI.MaxPendingLoads, 1u)},
+    m_TileLoader      {CI.TileLoader},
+    m_pThreadPool     {CI.pThreadPool},
+    m_pUploader       {CI.pUploader}
+// clang-format on
+{
+    if (pDevice == nullptr)
+        LOG_ERROR_AND_THROW("pDevice must not be null");
+    if (m_TileSize == 0)
+        LOG_ERROR_AND_THROW("Tile size must not be zero");
+    if (CI.Width % m_TileSize != 0 || CI.Height % m_TileSize != 0)
+        LOG_ERROR_AND_THROW("Virtual texture size (", CI.Width, "x", CI.Height, ") must be a multiple of the tile size (", m_TileSize, ")");
+    if (m_NumTilesX == 0 || m_NumTilesY == 0 || !IsPowerOfTwo(m_NumTilesX) || !IsPowerOfTwo(m_NumTilesY))
+        LOG_ERROR_AND_THROW("The number of tiles (", m_NumTilesX, "x", m_NumTilesY, ") must be a non-zero power of two in each dimension");
+    if (m_NumTilesX > 4096 || m_NumTilesY > 4096)
+        LOG_ERROR_AND_THROW("The number of tiles (", m_NumTilesX, "x", m_NumTilesY, ") must not exceed 4096 in each dimension");
+    if (CI.NumPhysicalPages == 0 || CI.NumPhysicalPages > 0xFFFFu)
+        LOG_ERROR_AND_THROW("The number of physical pages (", CI.NumPhysicalPages, ") must be in range [1, 65535]");
+    if (!m_TileLoader)
+        LOG_ERROR_AND_THROW("Tile loader must not be empty");
+
+    const Uint32 NumMipLevels = PlatformMisc::GetMSB(std::max(m_NumTilesX, m_NumTilesY)) + 1;
+
+    m_PageTable.resize(NumMipLevels);
+    m_DirtyRegions.resize(NumMipLevels);
+    for (Uint32 Mip = 0; Mip < NumMipLevels; ++Mip)
+        m_PageTable[Mip].resize(size_t{GetNumTilesX(Mip)} * size_t{GetNumTilesY(Mip)}, InvalidPageTableEntry);
+
+    {
+        const std::string Name = m_Name + " - physical cache";
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = Name.c_str();
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+        TexDesc.Width     = m_TileSize;
+        TexDesc.Height    = m_TileSize;
+        TexDesc.ArraySize = CI.NumPhysicalPages;
+        TexDesc.MipLevels = 1;
+        TexDesc.Format    = m_Format;
+        TexDesc.Usage     = USAGE_DEFAULT;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        pDevice->CreateTexture(TexDesc, nullptr, &m_pPhysicalCache);
+        if (!m_pPhysicalCache)
+            LOG_ERROR_AND_THROW("Failed to create physical cache texture for virtual texture '", m_Name, "'");
+    }
+
+    {
+        const std::string Name = m_Name + " - page table";
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = Name.c_str();
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = m_NumTilesX;
+        TexDesc.Height    = m_NumTilesY;
+        TexDesc.MipLevels = NumMipLevels;
+        TexDesc.Format    = TEX_FORMAT_R32_UINT;
+        TexDesc.Usage     = USAGE_DEFAULT;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        std::vector<TextureSubResData> SubResData(NumMipLevels);
+        for (Uint32 Mip = 0; Mip < NumMipLevels; ++Mip)
+            SubResData[Mip] = TextureSubResData{m_PageTable[Mip].data(), Uint64{GetNumTilesX(Mip)} * sizeof(Uint32)};
+        TextureData InitData{SubResData.data(), NumMipLevels};
+
+        pDevice->CreateTexture(TexDesc, &InitData, &m_pPageTable);
+        if (!m_pPageTable)
+            LOG_ERROR_AND_THROW("Failed to create page table texture for virtual texture '", m_Name, "'");
+    }
+
+    if (CI.FeedbackBufferSize != 0)
+    {
+        m_FeedbackClearData.resize(CI.FeedbackBufferSize, InvalidFeedback);
+
+        const std::string Name = m_Name + " - feedback";
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = Name.c_str();
+        BuffDesc.Size              = Uint64{CI.FeedbackBufferSize} * sizeof(Uint32);
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS | BIND_SHADER_RESOURCE;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(Uint32);
+
+        BufferData InitData{m_FeedbackClearData.data(), BuffDesc.Size};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &m_pFeedbackBuffer);
+        if (!m_pFeedbackBuffer)
+            LOG_ERROR_AND_THROW("Failed to create feedback buffer for virtual texture '", m_Name, "'");
+
+        const std::string ReadbackName = m_Name + " - feedback readback";
+
+        BuffDesc.Name              = ReadbackName.c_str();
+        BuffDesc.Usage             = USAGE_STAGING;
+        BuffDesc.BindFlags         = BIND_NONE;
+        BuffDesc.Mode              = BUFFER_MODE_UNDEFINED;
+        BuffDesc.ElementByteStride = 0;
+        BuffDesc.CPUAccessFlags    = CPU_ACCESS_READ;
+
+        // The feedback written in frame N is read back in frame N + FeedbackLatency
+        m_FeedbackReadbackBuffers.resize(std::max(CI.FeedbackLatency, 1u));
+        m_FeedbackReadbackFenceValues.resize(m_FeedbackReadbackBuffers.size());
+        for (RefCntAutoPtr<IBuffer>& pReadbackBuffer : m_FeedbackReadbackBuffers)
+        {
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pReadbackBuffer);
+            if (!pReadbackBuffer)
+                LOG_ERROR_AND_THROW("Failed to create feedback readback buffer for virtual texture '", m_Name, "'");
+        }
+
+        FenceDesc FncDesc;
+        FncDesc.Name = "Virtual texture feedback fence";
+        FncDesc.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+        pDevice->CreateFence(FncDesc, &m_pFeedbackFence);
+        if (!m_pFeedbackFence)
+            LOG_ERROR_AND_THROW("Failed to create feedback fence for virtual texture '", m_Name, "'");
+    }
+
+    if (!m_pUploader)
+    {
+        CreateTextureUploader(pDevice, TextureUploaderDesc{}, &m_pUploader);
+        if (!m_pUploader)
+            LOG_ERROR_AND_THROW("Failed to create texture uploader for virtual texture '", m_Name, "'");
+    }
+
+    m_PhysicalPages.resize(CI.NumPhysicalPages);
+    // Allocate pages with lower indices first
+    m_FreePages.reserve(CI.NumPhysicalPages);
+    for (Uint32 Page = CI.NumPhysicalPages; Page > 0; --Page)
+        m_FreePages.push_back(Page - 1);
+}
+
+VirtualTextureManager::~VirtualTextureManager()
+{
+    for (std::unique_ptr<TileLoadRequest>& pRequest : m_PendingLoads)
+    {
+        if (pRequest->pTask)
+            pRequest->pTask->WaitForCompletion();
+    }
+}
+
+bool VirtualTextureManager::IsValidTile(const VirtualTextureTile& Tile) const
+{
+    return Tile.MipLevel < GetNumMipLevels() && Tile.X < GetNumTilesX(Tile.MipLevel) && Tile.Y < GetNumTilesY(Tile.MipLevel);
+}
+
+void VirtualTextureManager::AnalyzeFeedback(const Uint32* pFeedback, size_t NumEntries)
+{
+    DEV_CHECK_ERR(pFeedback != nullptr || NumEntries == 0, "pFeedback must not be null");
+
+    Uint32 PrevFeedback = InvalidFeedback;
+    for (size_t i = 0; i < NumEntries; ++i)
+    {
+        const Uint32 Feedback = pFeedback[i];
+        // Neighboring feedback entries typically request the same tile
+        if (Feedback == InvalidFeedback || Feedback == PrevFeedback)
+            continue;
+        PrevFeedback = Feedback;
+
+        VirtualTextureTile Tile = DecodeFeedback(Feedback);
+        if (!IsValidTile(Tile))
+            continue;
+
+        // Request the tile and all its ancestors so that the region falls back
+        // to the finest available mip level while the tile is being loaded.
+        for (; Tile.MipLevel < GetNumMipLevels(); Tile.X >>= 1, Tile.Y >>= 1, ++Tile.MipLevel)
+        {
+            const Uint32 Key = EncodeFeedback(Tile);
+
+            auto ResidentIt = m_ResidentTiles.find(Key);
+            if (ResidentIt != m_ResidentTiles.end())
+            {
+                PhysicalPage& Page = m_PhysicalPages[ResidentIt->second];
+                if (Page.LastUsedFrame == m_FrameIndex)
+                {
+                    // All ancestors have already been processed
+                    break;
+                }
+                Page.LastUsedFrame = m_FrameIndex;
+            }
+            else if (m_LoadingTiles.find(Key) == m_LoadingTiles.end() && m_FailedTiles.find(Key) == m_FailedTiles.end())
+            {
+                ++m_RequestedTiles[Key];
+            }
+        }
+    }
+}
+
+void VirtualTextureManager::ReadBackFeedback(IDeviceContext* pContext)
+{
+    if (!m_pFeedbackBuffer)
+        return;
+
+    IBuffer* pReadbackBuffer = m_FeedbackReadbackBuffers[m_NextFeedbackReadback];
+    Uint64&  FenceValue      = m_FeedbackReadbackFenceValues[m_NextFeedbackReadback];
+    if (FenceValue != 0)
+    {
+        if (m_pFeedbackFence->GetCompletedValue() < FenceValue)
+        {
+            // The GPU has not finished writing the feedback to the readback buffer yet.
+            // Keep accumulating the feedback in the feedback buffer.
+            return;
+        }
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pReadbackBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        if (pData != nullptr)
+        {
+            AnalyzeFeedback(static_cast<const Uint32*>(pData), m_FeedbackClearData.size());
+            pContext->UnmapBuffer(pReadbackBuffer, MAP_READ);
+        }
+        FenceValue = 0;
+    }
+
+    pContext->CopyBuffer(m_pFeedbackBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pReadbackBuffer, 0, m_pFeedbackBuffer->GetDesc().Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    FenceValue = m_NextFeedbackFenceValue++;
+    pContext->EnqueueSignal(m_pFeedbackFence, FenceValue);
+
+    pContext->UpdateBuffer(m_pFeedbackBuffer, 0, m_pFeedbackBuffer->GetDesc().Size, m_FeedbackClearData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    m_NextFeedbackReadback = (m_NextFeedbackReadback + 1) % static_cast<Uint32>(m_FeedbackReadbackBuffers.size());
+}
+
+Uint32 VirtualTextureManager::AllocatePhysicalPage()
+{
+    if (!m_FreePages.empty())
+    {
+        const Uint32 Page = m_FreePages.back();
+        m_FreePages.pop_back();
+        return Page;
+    }
+
+    // Find the least recently used page. Pages used in the current frame are never
+    // evicted as this would make the tiles compete for the cache every frame.
+    Uint32 LRUPage = InvalidPhysicalPage;
+    for (Uint32 Page = 0; Page < m_PhysicalPages.size(); ++Page)
+    {
+        const PhysicalPage& PageInfo = m_PhysicalPages[Page];
+        if (PageInfo.IsLoading || PageInfo.IsPinned || PageInfo.LastUsedFrame >= m_FrameIndex)
+            continue;
+
+        if (LRUPage == InvalidPhysicalPage || PageInfo.LastUsedFrame < m_PhysicalPages[LRUPage].LastUsedFrame)
+            LRUPage = Page;
+    }
+
+    if (LRUPage != InvalidPhysicalPage)
+        EvictTile(LRUPage);
+
+    return LRUPage;
+}
+
+void VirtualTextureManager::EvictTile(Uint32 Page)
+{
+    PhysicalPage& PageInfo = m_PhysicalPages[Page];
+    VERIFY_EXPR(!PageInfo.IsLoading && !PageInfo.IsPinned && PageInfo.Tile != InvalidFeedback);
+
+    const Uint32 Key = PageInfo.Tile;
+    m_ResidentTiles.erase(Key);
+    PageInfo.Tile = InvalidFeedback;
+    ++m_NumEvictedTiles;
+
+    UpdatePageTable(DecodeFeedback(Key));
+}
+
+void VirtualTextureManager::StartLoads(IDeviceContext* pContext)
+{
+    // The coarsest tile is the fallback for all regions and is always requested
+    {
+        const Uint32 TopTile = EncodeFeedback({0, 0, GetNumMipLevels() - 1});
+        if (m_ResidentTiles.find(TopTile) == m_ResidentTiles.end() &&
+            m_LoadingTiles.find(TopTile) == m_LoadingTiles.end() &&
+            m_FailedTiles.find(TopTile) == m_FailedTiles.end())
+            m_RequestedTiles.emplace(TopTile, 0);
+    }
+
+    m_NumRequestedTiles = static_cast<Uint32>(m_RequestedTiles.size());
+    if (m_RequestedTiles.empty())
+        return;
+
+    std::vector<std::pair<Uint32, Uint32>> Requests{m_RequestedTiles.begin(), m_RequestedTiles.end()};
+    m_RequestedTiles.clear();
+
+    // Load coarse mip levels first since they cover larger regions, then the most requested tiles
+    std::sort(Requests.begin(), Requests.end(),
+              [](const std::pair<Uint32, Uint32>& lhs, const std::pair<Uint32, Uint32>& rhs) {
+                  const Uint32 lhsMip = lhs.first >> 24u;
+                  const Uint32 rhsMip = rhs.first >> 24u;
+                  if (lhsMip != rhsMip)
+                      return lhsMip > rhsMip;
+                  if (lhs.second != rhs.second)
+                      return lhs.second > rhs.second;
+                  return lhs.first < rhs.first;
+              });
+
+    Uint32 NumLoadsStarted = 0;
+    for (const auto& Request : Requests)
+    {
+        if (NumLoadsStarted >= m_MaxLoadsPerFrame || m_PendingLoads.size() >= m_MaxPendingLoads)
+            break;
+
+        const Uint32 Key = Request.first;
+        if (m_ResidentTiles.find(Key) != m_ResidentTiles.end() || m_LoadingTiles.find(Key) != m_LoadingTiles.end())
+            continue;
+
+        const Uint32 Page = AllocatePhysicalPage();
+        if (Page == InvalidPhysicalPage)
+        {
+            // All pages are in use by the current frame
+            break;
+        }
+
+        std::unique_ptr<TileLoadRequest> pRequest{new TileLoadRequest};
+        pRequest->Tile = DecodeFeedback(Key);
+        pRequest->Page = Page;
+
+        UploadBufferDesc UploadDesc;
+        UploadDesc.Width  = m_TileSize;
+        UploadDesc.Height = m_TileSize;
+        UploadDesc.Format = m_Format;
+        // Allocate the buffer in the render thread so that the worker threads never wait for it
+        m_pUploader->AllocateUploadBuffer(pContext, UploadDesc, &pRequest->pBuffer);
+        if (!pRequest->pBuffer)
+        {
+            LOG_ERROR_MESSAGE("Failed to allocate upload buffer for virtual texture '", m_Name, "'");
+            m_FreePages.push_back(Page);
+            break;
+        }
+
+        PhysicalPage& PageInfo = m_PhysicalPages[Page];
+        PageInfo.Tile          = Key;
+        PageInfo.IsLoading     = true;
+        m_LoadingTiles.insert(Key);
+
+        TileLoadRequest* pReq = pRequest.get();
+        if (m_pThreadPool)
+        {
+            pRequest->pTask = EnqueueAsyncWork(m_pThreadPool,
+                                               [pReq, this](Uint32 ThreadId) {
+                                                   LoadTile(*pReq, m_TileLoader);
+                                                   return ASYNC_TASK_STATUS_COMPLETE;
+                                               });
+        }
+        else
+        {
+            LoadTile(*pReq, m_TileLoader);
+        }
+
+        m_PendingLoads.emplace_back(std::move(pRequest));
+        ++NumLoadsStarted;
+    }
+}
+
+void VirtualTextureManager::LoadTile(TileLoadRequest& Request, const VirtualTextureTileLoaderType& Loader)
+{
+    const MappedTextureSubresource Data = Request.pBuffer->GetMappedData(0, 0);
+
+    const bool Loaded = Data.pData != nullptr && Loader(Request.Tile, Data);
+    Request.Status.store(Loaded ? TileLoadRequest::STATUS_LOADED : TileLoadRequest::STATUS_FAILED);
+}
+
+void VirtualTextureManager::FinishLoads(IDeviceContext* pContext)
+{
+    auto LoadIt = m_PendingLoads.begin();
+    while (LoadIt != m_PendingLoads.end())
+    {
+        TileLoadRequest& Request = **LoadIt;
+
+        const int Status = Request.Status.load();
+        if (Status == TileLoadRequest::STATUS_PENDING)
+        {
+            ++LoadIt;
+            continue;
+        }
+
+        const Uint32  Key      = EncodeFeedback(Request.Tile);
+        PhysicalPage& PageInfo = m_PhysicalPages[Request.Page];
+        VERIFY_EXPR(PageInfo.IsLoading && PageInfo.Tile == Key);
+        PageInfo.IsLoading = false;
+        m_LoadingTiles.erase(Key);
+
+        if (Status == TileLoadRequest::STATUS_LOADED)
+        {
+            m_pUploader->ScheduleGPUCopy(pContext, m_pPhysicalCache, Request.Page, 0, Request.pBuffer);
+
+            PageInfo.LastUsedFrame = m_FrameIndex;
+            PageInfo.IsPinned      = Request.Tile.MipLevel == GetNumMipLevels() - 1;
+            m_ResidentTiles.emplace(Key, Request.Page);
+            ++m_NumLoadedTiles;
+
+            UpdatePageTable(Request.Tile);
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Failed to load tile (", Request.Tile.X, ", ", Request.Tile.Y, ") of mip level ", Request.Tile.MipLevel,
+                                " of virtual texture '", m_Name, "'");
+
+            PageInfo.Tile = InvalidFeedback;
+            m_FreePages.push_back(Request.Page);
+            m_FailedTiles.insert(Key);
+            ++m_NumFailedTiles;
+        }
+        m_pUploader->RecycleBuffer(Request.pBuffer);
+
+        LoadIt = m_PendingLoads.erase(LoadIt);
+    }
+}
+
+void VirtualTextureManager::UpdatePageTable(const VirtualTextureTile& Tile)
+{
+    // Recompute the entries of all tiles covered by the given tile, starting from the
+    // tile's mip level so that every entry can inherit the entry of its parent.
+    for (Uint32 Mip = Tile.MipLevel + 1; Mip-- > 0;)
+    {
+        const Uint32 Shift    = Tile.MipLevel - Mip;
+        const Uint32 NumTiles = GetNumTilesX(Mip);
+
+        const Uint32 MinX = std::min(Tile.X << Shift, NumTiles - 1);
+        const Uint32 MinY = std::min(Tile.Y << Shift, GetNumTilesY(Mip) - 1);
+        const Uint32 MaxX = std::min((Tile.X + 1) << Shift, NumTiles);
+        const Uint32 MaxY = std::min((Tile.Y + 1) << Shift, GetNumTilesY(Mip));
+
+        std::vector<Uint32>&       Entries       = m_PageTable[Mip];
+        const std::vector<Uint32>* pParentEntries = Mip + 1 < GetNumMipLevels() ? &m_PageTable[Mip + 1] : nullptr;
+        const Uint32               NumParentTiles = GetNumTilesX(Mip + 1);
+        for (Uint32 y = MinY; y < MaxY; ++y)
+        {
+            for (Uint32 x = MinX; x < MaxX; ++x)
+            {
+                auto ResidentIt = m_ResidentTiles.find(EncodeFeedback({x, y, Mip}));
+
+                Uint32& Entry = Entries[size_t{y} * NumTiles + x];
+                if (ResidentIt != m_ResidentTiles.end())
+                    Entry = EncodePageTableEntry(ResidentIt->second, Mip);
+                else if (pParentEntries != nullptr)
+                    Entry = (*pParentEntries)[size_t{y >> 1} * NumParentTiles + (x >> 1)];
+                else
+                    Entry = InvalidPageTableEntry;
+            }
+        }
+
+        Box& DirtyRegion = m_DirtyRegions[Mip];
+        if (DirtyRegion.MaxX == 0)
+        {
+            DirtyRegion = Box{MinX, MaxX, MinY, MaxY};
+        }
+        else
+        {
+            DirtyRegion.MinX = std::min(DirtyRegion.MinX, MinX);
+            DirtyRegion.MaxX = std::max(DirtyRegion.MaxX, MaxX);
+            DirtyRegion.MinY = std::min(DirtyRegion.MinY, MinY);
+            DirtyRegion.MaxY = std::max(DirtyRegion.MaxY, MaxY);
+        }
+    }
+}
+
+void VirtualTextureManager::UploadPageTable(IDeviceContext* pContext)
+{
+    for (Uint32 Mip = 0; Mip < GetNumMipLevels(); ++Mip)
+    {
+        Box& DirtyRegion = m_DirtyRegions[Mip];
+        if (DirtyRegion.MaxX == 0)
+            continue;
+
+        const Uint32      NumTiles = GetNumTilesX(Mip);
+        TextureSubResData SubresData{&m_PageTable[Mip][size_t{DirtyRegion.MinY} * NumTiles + DirtyRegion.MinX], Uint64{NumTiles} * sizeof(Uint32)};
+        pContext->UpdateTexture(m_pPageTable, Mip, 0, DirtyRegion, SubresData, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        DirtyRegion = Box{};
+    }
+}
+
+void VirtualTextureManager::Update(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "pContext must not be null");
+
+    ReadBackFeedback(pContext);
+    StartLoads(pContext);
+    FinishLoads(pContext);
+    m_pUploader->RenderThreadUpdate(pContext);
+    UploadPageTable(pContext);
+
+    ++m_FrameIndex;
+}
+
+Uint32 VirtualTextureManager::GetPageTableEntry(const VirtualTextureTile& Tile) const
+{
+    DEV_CHECK_ERR(IsValidTile(Tile), "Tile (", Tile.X, ", ", Tile.Y, ") of mip level ", Tile.MipLevel, " is out of range");
+    if (!IsValidTile(Tile))
+        return InvalidPageTableEntry;
+
+    return m_PageTable[Tile.MipLevel][size_t{Tile.Y} * GetNumTilesX(Tile.MipLevel) + Tile.X];
+}
+
+bool VirtualTextureManager::IsTileResident(const VirtualTextureTile& Tile) const
+{
+    return IsValidTile(Tile) && m_ResidentTiles.find(EncodeFeedback(Tile)) != m_ResidentTiles.end();
+}
+
+VirtualTextureStats VirtualTextureManager::GetStats() const
+{
+    VirtualTextureStats Stats;
+    Stats.NumResidentTiles  = static_cast<Uint32>(m_ResidentTiles.size());
+    Stats.NumPendingLoads   = static_cast<Uint32>(m_PendingLoads.size());
+    Stats.NumRequestedTiles = m_NumRequestedTiles;
+    Stats.NumLoadedTiles    = m_NumLoadedTiles;
+    Stats.NumEvictedTiles   = m_NumEvictedTiles;
+    Stats.NumFailedTiles    = m_NumFailedTiles;
+    return Stats;
+}
+
+} // namespace Diligent
@@ -60,52 +60,79 @@ XXH128Hash XXH128State::Digest() noexcept
     return {Hash.low64, Hash.high64};
 }
 
-void XXH128State::Update(const ShaderCreateInfo& ShaderCI) noexcept
+template <typename SourceHandlerType>
+static void UpdateShaderCI(XXH128State& Hasher, const ShaderCreateInfo& ShaderCI, SourceHandlerType&& SourceHandler) noexcept
 {
     ASSERT_SIZEOF64(ShaderCI, 152, "Did you add new members to ShaderCreateInfo? Please handle them here.");
 
-    Update(ShaderCI.SourceLength, // Aka ByteCodeSize
-           ShaderCI.EntryPoint,
-           ShaderCI.Desc,
-           ShaderCI.SourceLanguage,
-           ShaderCI.ShaderCompiler,
-           ShaderCI.HLSLVersion,
-           ShaderCI.GLSLVersion,
-           ShaderCI.GLESSLVersion,
-           ShaderCI.MSLVersion,
-           ShaderCI.CompileFlags,
-           ShaderCI.LoadConstantBufferReflection);
+    Hasher.Update(ShaderCI.SourceLength, // Aka ByteCodeSize
+                  ShaderCI.EntryPoint,
+                  ShaderCI.Desc,
+                  ShaderCI.SourceLanguage,
+                  ShaderCI.ShaderCompiler,
+                  ShaderCI.HLSLVersion,
+                  ShaderCI.GLSLVersion,
+                  ShaderCI.GLESSLVersion,
+                  ShaderCI.MSLVersion,
+                  ShaderCI.CompileFlags,
+                  ShaderCI.LoadConstantBufferReflection);
 
-    if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
-    {
-        DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "ShaderCI.ByteCode must be null when either Source or FilePath is specified");
-        ProcessShaderIncludes(ShaderCI, [this](const ShaderIncludePreprocessInfo& ProcessInfo) {
-            UpdateStr(ProcessInfo.Source, ProcessInfo.SourceLength);
-        });
-    }
-    else if (ShaderCI.ByteCode != nullptr && ShaderCI.ByteCodeSize != 0)
-    {
-        UpdateRaw(ShaderCI.ByteCode, ShaderCI.ByteCodeSize);
-    }
+    SourceHandler();
 
     if (ShaderCI.Macros)
     {
         for (size_t i = 0; i < ShaderCI.Macros.Count; ++i)
         {
             const auto& Macro = ShaderCI.Macros[i];
-            Update(Macro.Name, Macro.Definition);
+            Hasher.Update(Macro.Name, Macro.Definition);
         }
     }
 
     if (ShaderCI.GLSLExtensions != nullptr)
     {
-        UpdateStr(ShaderCI.GLSLExtensions);
+        Hasher.UpdateStr(ShaderCI.GLSLExtensions);
     }
 
     if (ShaderCI.WebGPUEmulatedArrayIndexSuffix != nullptr)
     {
-        UpdateStr(ShaderCI.WebGPUEmulatedArrayIndexSuffix);
+        Hasher.UpdateStr(ShaderCI.WebGPUEmulatedArrayIndexSuffix);
+    }
+}
+
+static void UpdateShaderSource(XXH128State& Hasher, const ShaderCreateInfo& ShaderCI) noexcept
+{
+    if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
+    {
+        DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "ShaderCI.ByteCode must be null when either Source or FilePath is specified");
+        ProcessShaderIncludes(ShaderCI, [&Hasher](const ShaderIncludePreprocessInfo& ProcessInfo) {
+            Hasher.UpdateStr(ProcessInfo.Source, ProcessInfo.SourceLength);
+        });
+    }
+    else if (ShaderCI.ByteCode != nullptr && ShaderCI.ByteCodeSize != 0)
+    {
+        Hasher.UpdateRaw(ShaderCI.ByteCode, ShaderCI.ByteCodeSize);
     }
 }
 
+void XXH128State::Update(const ShaderCreateInfo& ShaderCI) noexcept
+{
+    UpdateShaderCI(*this, ShaderCI, [&]() {
+        UpdateShaderSource(*this, ShaderCI);
+    });
+}
+
+void XXH128State::Update(const ShaderCreateInfo& ShaderCI, const XXH128Hash& SourceHash) noexcept
+{
+    UpdateShaderCI(*this, ShaderCI, [&]() {
+        Update(SourceHash.LowPart, SourceHash.HighPart);
+    });
+}
+
+XXH128Hash XXH128State::ComputeShaderSourceHash(const ShaderCreateInfo& ShaderCI) noexcept
+{
+    XXH128State Hasher;
+    UpdateShaderSource(Hasher, ShaderCI);
+    return Hasher.Digest();
+}
+
 } // namespace Diligent
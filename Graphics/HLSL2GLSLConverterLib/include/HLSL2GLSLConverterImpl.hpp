@@ -165,6 +165,29 @@ public:
                       size_t                           NumSymbols,
                       IHLSL2GLSLConversionStream**     ppStream) const;
 
+    /// Sets the maximum total size, in bytes, of the process-wide conversion cache.
+    ///
+    /// Shader permutations differ by macros that are not part of the converted source, so
+    /// every permutation converts the same HLSL code again. When the cache is enabled, the
+    /// converted GLSL is looked up by the HLSL source with all includes unrolled, the entry
+    /// point, the shader type and the conversion options. The source is only tokenized on
+    /// a miss. The least recently used entries are evicted when the total size of the HLSL
+    /// and GLSL sources exceeds the limit.
+    ///
+    /// Zero disables the cache and releases its contents. The cache is disabled by default.
+    static void SetConversionCacheSize(size_t MaxSize);
+
+    struct ConversionCacheStats
+    {
+        size_t NumHits    = 0;
+        size_t NumMisses  = 0;
+        size_t NumEntries = 0;
+        size_t Size       = 0;
+    };
+
+    /// Returns the statistics of the conversion cache.
+    static ConversionCacheStats GetConversionCacheStats();
+
 private:
     HLSL2GLSLConverterImpl();
 
@@ -242,6 +265,8 @@ private:
         /// \param [in] NumSymbols    - Number of symbols in the HLSLSource string
         /// \param [in] bPreserveTokens - Whether to preserve original tokens. This must be set to true if the stream
         ///                               will be used for multiple conversions.
+        ///
+        /// \remarks   The source is tokenized by the first conversion that is not served by the conversion cache.
         ConversionStream(IReferenceCounters*              pRefCounters,
                          const HLSL2GLSLConverterImpl&    Converter,
                          const char*                      InputFileName,
@@ -272,6 +297,10 @@ private:
     private:
         void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
 
+        String ConvertTokens(const Char* EntryPoint,
+                             SHADER_TYPE ShaderType,
+                             const char* SamplerSuffix);
+
         using SamplerHashType = std::unordered_map<String, bool>;
 
         const HLSLObjectInfo* FindHLSLObject(const String& Name);
@@ -459,8 +488,15 @@ private:
 
         String BuildGLSLSource();
 
+        // Source code with all includes unrolled
+        String m_Source;
+
+        // Hash of m_Source, or 0 if it has not been computed yet
+        size_t m_SourceHash = 0;
+
         // Tokenized source code
         TokenListType m_Tokens;
+        bool          m_bTokenized = false;
 
         // List of tokens defining structs
         std::unordered_map<HashMapStringKey, TokenListType::iterator> m_StructDefinitions;
@@ -372,6 +372,9 @@
 #include "pch.h"
 #include <unordered_set>
 #include <string>
+#include <list>
+#include <mutex>
+#include <cstring>
 
 #include "HLSL2GLSLConverterImpl.hpp"
 #include "GraphicsAccessories.hpp"
@@ -381,6 +384,8 @@
 #include "ParsingTools.hpp"
 #include "EngineMemory.h"
 #include "GLSLParsingTools.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 using namespace std;
 
@@ -706,12 +711,15 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
     // Put all the includes into the set to avoid multiple inclusion
     std::unordered_set<String> ProcessedIncludes;
 
+    // The source before this offset does not contain #include directives
+    size_t SearchStart = 0;
+
     try
     {
         do
         {
-            // Find the first #include statement
-            auto Pos             = GLSLSource.begin();
+            // Find the next #include statement
+            auto Pos             = GLSLSource.begin() + SearchStart;
             auto IncludeStartPos = GLSLSource.end();
             while (Pos != GLSLSource.end())
             {
@@ -781,6 +789,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
             // #   include "TestFile.fxh"
             // ^                         ^
             // IncludeStartPos           Pos
+            // The included text will be inserted at IncludeStartPos, so continue the search from there
+            SearchStart = IncludeStartPos - GLSLSource.begin();
             GLSLSource.erase(IncludeStartPos, Pos);
 
             // Convert the name to lower case
@@ -791,19 +801,17 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
             // replace the text with the file content
             if (It.second)
             {
-                RefCntAutoPtr<IFileStream> pIncludeDataStream;
-                pSourceStreamFactory->CreateInputStream(IncludeName.c_str(), &pIncludeDataStream);
-                if (!pIncludeDataStream)
+                // Include files are served by the shader source cache when it is enabled
+                RefCntAutoPtr<IDataBlob> pIncludeData = LoadShaderSourceFile(pSourceStreamFactory, IncludeName.c_str());
+                if (!pIncludeData)
                     LOG_ERROR_AND_THROW("Failed to open include file ", IncludeName);
-                auto pIncludeData = DataBlobImpl::Create();
-                pIncludeDataStream->ReadBlob(pIncludeData);
 
                 // Get include text
                 const Char* IncludeText = pIncludeData->GetConstDataPtr<Char>();
                 size_t      NumSymbols  = pIncludeData->GetSize();
 
                 // Insert the text into source
-                GLSLSource.insert(IncludeStartPos - GLSLSource.begin(), IncludeText, NumSymbols);
+                GLSLSource.insert(SearchStart, IncludeText, NumSymbols);
             }
         } while (true);
     }
@@ -4442,22 +4450,227 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
         if (pInputStreamFactory == nullptr)
             LOG_ERROR_AND_THROW("Input stream factory must not be null when HLSL source code is not provided");
 
-        RefCntAutoPtr<IFileStream> pSourceStream;
-        pInputStreamFactory->CreateInputStream(InputFileName, &pSourceStream);
-        if (pSourceStream == nullptr)
+        pFileData = LoadShaderSourceFile(pInputStreamFactory, InputFileName);
+        if (pFileData == nullptr)
             LOG_ERROR_AND_THROW("Failed to open shader source file ", InputFileName);
 
-        pFileData = DataBlobImpl::Create();
-        pSourceStream->ReadBlob(pFileData);
-        HLSLSource = reinterpret_cast<char*>(pFileData->GetDataPtr());
+        HLSLSource = pFileData->GetConstDataPtr<char>();
         NumSymbols = pFileData->GetSize();
     }
 
-    String Source(HLSLSource, NumSymbols);
+    m_Source.assign(HLSLSource, NumSymbols);
+
+    InsertIncludes(m_Source, pInputStreamFactory);
+}
+
+namespace
+{
+
+class HLSL2GLSLConversionCache
+{
+public:
+    static HLSL2GLSLConversionCache& GetInstance()
+    {
+        static HLSL2GLSLConversionCache Cache;
+        return Cache;
+    }
+
+    struct Key
+    {
+        Key(const String& _Source,
+            size_t        SourceHash,
+            const Char*   _EntryPoint,
+            SHADER_TYPE   _ShaderType,
+            const Char*   _SamplerSuffix,
+            bool          _UseInOutLocationQualifiers,
+            bool          _UseRowMajorMatrices) :
+            // clang-format off
+            Source                    {_Source},
+            EntryPoint                {_EntryPoint    != nullptr ? _EntryPoint    : ""},
+            SamplerSuffix             {_SamplerSuffix != nullptr ? _SamplerSuffix : ""},
+            ShaderType                {_ShaderType},
+            UseInOutLocationQualifiers{_UseInOutLocationQualifiers},
+            UseRowMajorMatrices       {_UseRowMajorMatrices},
+            // clang-format on
+            Hash{ComputeHash(SourceHash, CStringHash<Char>{}(EntryPoint), CStringHash<Char>{}(SamplerSuffix),
+                             static_cast<Uint32>(ShaderType), UseInOutLocationQualifiers, UseRowMajorMatrices)}
+        {}
+
+        // Creates a copy of the key that references other strings
+        Key(const Key& Other, const String& _Source, const Char* _EntryPoint, const Char* _SamplerSuffix) :
+            // clang-format off
+            Source                    {_Source},
+            EntryPoint                {_EntryPoint},
+            SamplerSuffix             {_SamplerSuffix},
+            ShaderType                {Other.ShaderType},
+            UseInOutLocationQualifiers{Other.UseInOutLocationQualifiers},
+            UseRowMajorMatrices       {Other.UseRowMajorMatrices},
+            Hash                      {Other.Hash}
+        // clang-format on
+        {}
+
+        bool operator==(const Key& RHS) const
+        {
+            // clang-format off
+            return Hash                       == RHS.Hash                       &&
+                   ShaderType                 == RHS.ShaderType                 &&
+                   UseInOutLocationQualifiers == RHS.UseInOutLocationQualifiers &&
+                   UseRowMajorMatrices        == RHS.UseRowMajorMatrices        &&
+                   strcmp(EntryPoint,    RHS.EntryPoint)    == 0 &&
+                   strcmp(SamplerSuffix, RHS.SamplerSuffix) == 0 &&
+                   Source == RHS.Source;
+            // clang-format on
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& K) const
+            {
+                return K.Hash;
+            }
+        };
+
+        const String&     Source;
+        const Char* const EntryPoint;
+        const Char* const SamplerSuffix;
+        const SHADER_TYPE ShaderType;
+        const bool        UseInOutLocationQualifiers;
+        const bool        UseRowMajorMatrices;
+        const size_t      Hash;
+    };
+
+    bool IsEnabled()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_MaxSize != 0;
+    }
+
+    void SetMaxSize(size_t MaxSize)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_MaxSize = MaxSize;
+        if (m_MaxSize == 0)
+        {
+            m_Map.clear();
+            m_Entries.clear();
+            m_Stats = {};
+        }
+        else
+        {
+            EvictEntries();
+        }
+    }
+
+    bool Find(const Key& SrcKey, String& GLSLSource)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
 
-    InsertIncludes(Source, pInputStreamFactory);
+        auto it = m_Map.find(SrcKey);
+        if (it == m_Map.end())
+        {
+            ++m_Stats.NumMisses;
+            return false;
+        }
 
-    m_Tokens = m_Converter.m_HLSLTokenizer.Tokenize(Source);
+        // Move the entry to the front of the LRU list
+        m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+        GLSLSource = it->second->GLSLSource;
+        ++m_Stats.NumHits;
+        return true;
+    }
+
+    void Add(const Key& SrcKey, const String& GLSLSource)
+    {
+        const size_t EntrySize = SrcKey.Source.size() + GLSLSource.size();
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (EntrySize > m_MaxSize)
+            return;
+
+        // The key references the strings owned by the list entry,
+        // which does not move when the list is reordered.
+        m_Entries.emplace_front(SrcKey, GLSLSource);
+        if (!m_Map.emplace(m_Entries.front().GetKey(), m_Entries.begin()).second)
+        {
+            // Another thread has added the same conversion
+            m_Entries.pop_front();
+            return;
+        }
+
+        m_Stats.Size += EntrySize;
+        ++m_Stats.NumEntries;
+        EvictEntries();
+    }
+
+    HLSL2GLSLConverterImpl::ConversionCacheStats GetStats()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Stats;
+    }
+
+private:
+    struct Entry
+    {
+        Entry(const Key& _SrcKey, const String& _GLSLSource) :
+            // clang-format off
+            HLSLSource   {_SrcKey.Source       },
+            EntryPoint   {_SrcKey.EntryPoint   },
+            SamplerSuffix{_SrcKey.SamplerSuffix},
+            GLSLSource   {_GLSLSource          },
+            SrcKey       {_SrcKey, HLSLSource, EntryPoint.c_str(), SamplerSuffix.c_str()}
+        // clang-format on
+        {}
+
+        const String HLSLSource;
+        const String EntryPoint;
+        const String SamplerSuffix;
+        const String GLSLSource;
+
+        // References HLSLSource, EntryPoint and SamplerSuffix
+        const Key SrcKey;
+
+        const Key& GetKey() const { return SrcKey; }
+
+        size_t GetSize() const
+        {
+            return HLSLSource.size() + GLSLSource.size();
+        }
+    };
+    using EntryListType = std::list<Entry>;
+
+    void EvictEntries()
+    {
+        while (m_Stats.Size > m_MaxSize && !m_Entries.empty())
+        {
+            const Entry& LRUEntry = m_Entries.back();
+            m_Map.erase(LRUEntry.GetKey());
+            m_Stats.Size -= LRUEntry.GetSize();
+            --m_Stats.NumEntries;
+            m_Entries.pop_back();
+        }
+    }
+
+private:
+    std::mutex m_Mtx;
+
+    size_t m_MaxSize = 0;
+
+    EntryListType                                                 m_Entries;
+    std::unordered_map<Key, EntryListType::iterator, Key::Hasher> m_Map;
+
+    HLSL2GLSLConverterImpl::ConversionCacheStats m_Stats;
+};
+
+} // namespace
+
+void HLSL2GLSLConverterImpl::SetConversionCacheSize(size_t MaxSize)
+{
+    HLSL2GLSLConversionCache::GetInstance().SetMaxSize(MaxSize);
+}
+
+HLSL2GLSLConverterImpl::ConversionCacheStats HLSL2GLSLConverterImpl::GetConversionCacheStats()
+{
+    return HLSL2GLSLConversionCache::GetInstance().GetStats();
 }
 
 
@@ -4549,8 +4762,50 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                                                          bool        UseInOutLocationQualifiers,
                                                          bool        UseRowMajorMatrices)
 {
+    ShaderCompilationStageScope CrossCompile{SHADER_COMPILATION_STAGE_CROSS_COMPILE};
+
     m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
     m_bUseRowMajorMatrices        = UseRowMajorMatrices;
+
+    String GLSLSource;
+
+    HLSL2GLSLConversionCache& Cache = HLSL2GLSLConversionCache::GetInstance();
+    if (Cache.IsEnabled())
+    {
+        if (m_SourceHash == 0)
+            m_SourceHash = ComputeHashRaw(m_Source.data(), m_Source.size());
+
+        const HLSL2GLSLConversionCache::Key SrcKey{m_Source, m_SourceHash, EntryPoint, ShaderType, SamplerSuffix, UseInOutLocationQualifiers, UseRowMajorMatrices};
+        const bool CacheHit = Cache.Find(SrcKey, GLSLSource);
+        ShaderCompilationProfiler::AddCacheResult(CacheHit);
+        if (!CacheHit)
+        {
+            GLSLSource = ConvertTokens(EntryPoint, ShaderType, SamplerSuffix);
+            Cache.Add(SrcKey, GLSLSource);
+        }
+    }
+    else
+    {
+        GLSLSource = ConvertTokens(EntryPoint, ShaderType, SamplerSuffix);
+    }
+
+    if (IncludeDefintions)
+        GLSLSource.insert(0, g_GLSLDefinitions);
+
+    GLSLSource.shrink_to_fit();
+    return GLSLSource;
+}
+
+String HLSL2GLSLConverterImpl::ConversionStream::ConvertTokens(const Char* EntryPoint,
+                                                               SHADER_TYPE ShaderType,
+                                                               const char* SamplerSuffix)
+{
+    if (!m_bTokenized)
+    {
+        m_Tokens     = m_Converter.m_HLSLTokenizer.Tokenize(m_Source);
+        m_bTokenized = true;
+    }
+
     TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
 
     Uint32 ShaderStorageBlockBinding = 0;
@@ -4796,10 +5051,6 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
         m_Objects.clear();
     }
 
-    if (IncludeDefintions)
-        GLSLSource.insert(0, g_GLSLDefinitions);
-
-    GLSLSource.shrink_to_fit();
     return GLSLSource;
 }
 
@@ -50,7 +50,9 @@ enum class SpirvVersion
     Count
 };
 
-void InitializeGlslang();
+/// Registers a glslang user. Every call must be matched by FinalizeGlslang().
+/// If Deferred is true, glslang is initialized by the first compilation rather than by this call.
+void InitializeGlslang(bool Deferred = false);
 void FinalizeGlslang();
 
 struct GLSLtoSPIRVAttribs
@@ -64,6 +66,7 @@ struct GLSLtoSPIRVAttribs
     IDataBlob**                      ppCompilerOutput           = nullptr;
     bool                             AssignBindings             = true;
     bool                             UseRowMajorMatrices        = false;
+    bool                             OptimizeForSize            = false;
 };
 
 std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs);
@@ -182,7 +182,8 @@ public:
 
     const HLSLTokenInfo* FindKeyword(const String& Keyword) const
     {
-        auto it = m_Keywords.find(HashMapStringKey{Keyword});
+        // Do not copy the string
+        auto it = m_Keywords.find(HashMapStringKey{Keyword.c_str()});
         return it != m_Keywords.end() ? &it->second : nullptr;
     }
 
@@ -190,6 +191,9 @@ public:
     TokenListType Tokenize(const String& Source) const;
 
 private:
+    // The maximum length of an HLSL keyword
+    static constexpr size_t MaxKeywordLength = 63;
+
     // HLSL keyword -> token info hash map
     // Example: "Texture2D" -> TokenInfo{TokenType::Texture2D, "Texture2D"}
     std::unordered_map<HashMapStringKey, HLSLTokenInfo> m_Keywords;
@@ -53,12 +53,6 @@
 #    define diligent_spirv_cross spirv_cross
 #endif
 
-namespace diligent_spirv_cross
-{
-class Compiler;
-struct Resource;
-} // namespace diligent_spirv_cross
-
 namespace Diligent
 {
 
@@ -104,12 +98,15 @@ struct SPIRVShaderResourceAttribs
 
     // clang-format on
 
-    SPIRVShaderResourceAttribs(const diligent_spirv_cross::Compiler& Compiler,
-                               const diligent_spirv_cross::Resource& Res,
-                               const char*                           _Name,
-                               ResourceType                          _Type,
-                               Uint32                                _BufferStaticSize = 0,
-                               Uint32                                _BufferStride     = 0) noexcept;
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               ResourceType       _Type,
+                               Uint16             _ArraySize,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               uint32_t           _BindingDecorationOffset,
+                               uint32_t           _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize = 0,
+                               Uint32             _BufferStride     = 0) noexcept;
 
     ShaderResourceDesc GetResourceDesc() const
     {
@@ -147,13 +144,16 @@ static_assert(sizeof(SPIRVShaderStageInputAttribs) % sizeof(void*) == 0, "Size o
 class SPIRVShaderResources
 {
 public:
-    SPIRVShaderResources(IMemoryAllocator&     Allocator,
-                         std::vector<uint32_t> spirv_binary,
-                         const ShaderDesc&     shaderDesc,
-                         const char*           CombinedSamplerSuffix,
-                         bool                  LoadShaderStageInputs,
-                         bool                  LoadUniformBufferReflection,
-                         std::string&          EntryPoint) noexcept(false);
+    /// Reflects the resources by walking the SPIRV words directly.
+    /// SPIRV-Cross is only used when LoadUniformBufferReflection is true
+    /// to load the uniform buffer member layouts.
+    SPIRVShaderResources(IMemoryAllocator&            Allocator,
+                         const std::vector<uint32_t>& spirv_binary,
+                         const ShaderDesc&            shaderDesc,
+                         const char*                  CombinedSamplerSuffix,
+                         bool                         LoadShaderStageInputs,
+                         bool                         LoadUniformBufferReflection,
+                         std::string&                 EntryPoint) noexcept(false);
 
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
@@ -40,7 +40,10 @@ enum SPIRV_OPTIMIZATION_FLAGS : Uint32
     SPIRV_OPTIMIZATION_FLAG_NONE             = 0u,
     SPIRV_OPTIMIZATION_FLAG_LEGALIZATION     = 1u << 0u,
     SPIRV_OPTIMIZATION_FLAG_PERFORMANCE      = 1u << 1u,
-    SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION = 1u << 2u
+    SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION = 1u << 2u,
+
+    // Size reduction passes. Takes precedence over SPIRV_OPTIMIZATION_FLAG_PERFORMANCE.
+    SPIRV_OPTIMIZATION_FLAG_SIZE = 1u << 3u
 };
 DEFINE_FLAG_ENUM_OPERATORS(SPIRV_OPTIMIZATION_FLAGS);
 
@@ -49,4 +52,27 @@ std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV,
                                     spv_target_env               TargetEnv,
                                     SPIRV_OPTIMIZATION_FLAGS     Passes);
 
+
+/// Sets the maximum total size, in bytes, of the process-wide optimized SPIR-V cache.
+///
+/// Different shader permutations often produce identical SPIR-V, which OptimizeSPIRV()
+/// then has to optimize again. When the cache is enabled, OptimizeSPIRV() looks up the result
+/// by the hash of the source SPIR-V, the target environment and the passes, and only runs the
+/// optimizer on a miss. The least recently used entries are evicted when the total size
+/// of the source and optimized bytecode exceeds the limit.
+///
+/// Zero disables the cache and releases its contents. The cache is disabled by default.
+void SetSPIRVOptimizationCacheSize(size_t MaxSize);
+
+struct SPIRVOptimizationCacheStats
+{
+    size_t NumHits    = 0;
+    size_t NumMisses  = 0;
+    size_t NumEntries = 0;
+    size_t Size       = 0;
+};
+
+/// Returns the statistics of the optimized SPIR-V cache.
+SPIRVOptimizationCacheStats GetSPIRVOptimizationCacheStats();
+
 } // namespace Diligent
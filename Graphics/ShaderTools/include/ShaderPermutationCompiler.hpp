@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+#include "ThreadPool.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Shader macro and the values it takes in the permutation space.
+struct ShaderPermutationMacro
+{
+    std::string              Name;
+    std::vector<std::string> Values;
+};
+
+/// Shader permutation compilation attributes.
+struct ShaderPermutationCompileInfo
+{
+    /// Shader create info that defines the source, the entry point, the shader type and
+    /// the macros that are shared by all permutations.
+    ShaderCreateInfo ShaderCI;
+
+    /// Permutation macros. Every combination of the macro values defines a permutation.
+    std::vector<ShaderPermutationMacro> Macros;
+
+    /// Optional thread pool to compile unique permutations in parallel.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// Function that compiles the shader, for example by calling IRenderDevice::CreateShader(),
+    /// and returns the result, or null in case of an error.
+    /// The function may be called from multiple threads simultaneously.
+    std::function<RefCntAutoPtr<IObject>(const ShaderCreateInfo&)> CompileHandler;
+};
+
+/// Shader permutation compilation results.
+struct ShaderPermutationCompileResult
+{
+    /// The compiled object for every permutation.
+    ///
+    /// Permutation index selects the value of every macro in mixed radix, where
+    /// the first macro changes fastest: Macros[0].Values[Index % NumValues0],
+    /// Macros[1].Values[(Index / NumValues0) % NumValues1], etc.
+    /// Permutations that have the same source share the same object.
+    std::vector<RefCntAutoPtr<IObject>> Permutations;
+
+    /// The index of the unique source for every permutation.
+    std::vector<Uint32> SourceIndices;
+
+    /// The hash of every unique source.
+    ///
+    /// The hash combines the normalized source with all includes unrolled, the definitions of the macros
+    /// that affect it, the entry point, the shader type, the source language, the shader compiler and
+    /// the compile flags, and may be used as a key in application caches.
+    std::vector<size_t> SourceHashes;
+
+    /// Permutation macros that do not affect the source.
+    std::vector<std::string> IgnoredMacros;
+};
+
+/// Compiles all permutations of a shader defined by the macro space, compiling every unique source only once.
+///
+/// The source and its includes are unrolled, normalized by removing comments and collapsing white space,
+/// and scanned for identifiers. A permutation macro can only affect the preprocessed output if its name appears in
+/// the source, in the shared macros or in the values of other such macros. Permutations that only differ by the
+/// values of the other macros produce the same preprocessed source and share the compiled object.
+///
+/// \param [in]  Info   - Compilation attributes.
+/// \param [out] Result - Compilation results.
+///
+/// \return     true if all unique permutations have been compiled successfully, and false otherwise.
+///
+/// \remarks    The function does not run the preprocessor, so a macro that is only referenced in an inactive
+///             #if block is considered to affect the source. If the source uses token pasting (##), all
+///             macros are considered to affect it since pasting may form the macro names.
+bool CompileShaderPermutations(const ShaderPermutationCompileInfo& Info, ShaderPermutationCompileResult& Result) noexcept;
+
+} // namespace Diligent
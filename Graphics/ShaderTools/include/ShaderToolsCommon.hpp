@@ -30,6 +30,7 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "GraphicsTypes.h"
 #include "Shader.h"
@@ -93,13 +94,54 @@ void AppendShaderSourceLanguageDefinition(std::string& Source, SHADER_SOURCE_LAN
 SHADER_SOURCE_LANGUAGE ParseShaderSourceLanguageDefinition(const std::string& Source);
 
 
+/// #include directive found in a shader source file.
+struct ShaderIncludeDirective
+{
+    /// The path of the included file.
+    std::string Path;
+
+    /// The offset of the directive start in the source file.
+    size_t Start = 0;
+
+    /// The offset of the directive end in the source file.
+    size_t End = 0;
+};
+
 struct ShaderSourceFileData
 {
     RefCntAutoPtr<IDataBlob> pFileData;
     const char*              Source       = nullptr;
     Uint32                   SourceLength = 0;
+
+    /// Include directives of the file, if the file was served by the shader source cache.
+    std::shared_ptr<const std::vector<ShaderIncludeDirective>> pIncludes;
 };
 
+/// Loads the shader source file using the input stream factory.
+/// If the shader source cache is enabled, the file is served from the cache.
+/// Returns null if the file could not be opened.
+RefCntAutoPtr<IDataBlob> LoadShaderSourceFile(IShaderSourceInputStreamFactory* pShaderSourceStreamFactory, const char* FilePath);
+
+/// Enables or disables the process-wide shader source cache.
+///
+/// When the cache is enabled, the shader source files loaded through an input stream factory
+/// are read and scanned for #include directives only once. ReadShaderSourceFile(), ProcessShaderIncludes(),
+/// UnrollShaderIncludes() as well as DXC and glslang include handlers then serve the files and
+/// the include graph from memory, which saves the work for shader permutations that share
+/// large include files.
+///
+/// The cache is keyed by the input stream factory and the file path, and keeps a reference
+/// to the factory. Since the input stream factory does not expose file modification times,
+/// the application must call InvalidateShaderSourceCache() when the files change, e.g. before
+/// reloading the shaders. Disabling the cache clears it.
+void SetShaderSourceCacheEnabled(bool Enabled);
+
+/// Returns true if the shader source cache is enabled.
+bool IsShaderSourceCacheEnabled();
+
+/// Removes the file from the shader source cache, or clears the cache if FilePath is null.
+void InvalidateShaderSourceCache(const char* FilePath = nullptr);
+
 /// Reads shader source code from a file or uses the one from the shader create info
 ShaderSourceFileData ReadShaderSourceFile(const char*                      SourceCode,
                                           size_t                           SourceLength,
@@ -140,6 +182,11 @@ bool ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, std::function<void(
 ///  Unrolls all include files into a single file
 std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(false);
 
+/// Returns the paths of all files the shader includes, directly or indirectly, in the
+/// order defined by ProcessShaderIncludes(). The shader file itself is not included.
+/// Use InvalidateShaderSourceCache() for every dependency when the shader needs to be reloaded.
+bool GetShaderIncludeDependencies(const ShaderCreateInfo& ShaderCI, std::vector<std::string>& Dependencies) noexcept;
+
 std::string GetShaderCodeTypeName(SHADER_CODE_BASIC_TYPE     BasicType,
                                   SHADER_CODE_VARIABLE_CLASS Class,
                                   Uint32                     NumRows,
@@ -30,6 +30,8 @@
 #include <vector>
 #include <unordered_map>
 
+#include "LRUCache.hpp"
+
 namespace tint
 {
 class Program;
@@ -56,6 +58,29 @@ std::string RamapWGSLResourceBindings(const std::string&         WGSL,
                                       const WGSLResourceMapping& ResMapping,
                                       const char*                EmulatedArrayIndexSuffix);
 
+/// Converts SPIR-V to WGSL and remaps resource bindings in a single pass.
+///
+/// The result is the same as calling RamapWGSLResourceBindings() for the output of ConvertSPIRVtoWGSL(),
+/// but the binding remapper runs on the program produced by the SPIR-V reader, so the WGSL is only
+/// generated once and is never parsed.
+std::string ConvertSPIRVtoWGSL(const std::vector<uint32_t>& SPIRV,
+                               const WGSLResourceMapping&   ResMapping,
+                               const char*                  EmulatedArrayIndexSuffix);
+
+/// Sets the maximum total size, in bytes, of the process-wide WGSL conversion cache.
+///
+/// When the cache is enabled, ConvertSPIRVtoWGSL() and RamapWGSLResourceBindings() look up the result
+/// by the source SPIR-V or WGSL, the resource mapping and the array index suffix, and only run Tint on
+/// a miss. This saves parsing the same shaders again, for example when several pipelines use the same
+/// shader with the same resource signatures. The least recently used entries are evicted when the total
+/// size of the keys and results exceeds the limit.
+///
+/// Zero disables the cache. The cache is disabled by default.
+void SetWGSLConversionCacheSize(size_t MaxSize);
+
+/// Returns the statistics of the WGSL conversion cache.
+LRUCacheStats GetWGSLConversionCacheStats();
+
 
 /// When WGSL is generated from SPIR-V, the names of resources may be mangled
 ///
@@ -60,6 +60,7 @@
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 #include "HLSLUtils.hpp"
 
@@ -118,7 +119,52 @@ public:
                                        IDxcBlob**                 ppDstByteCode) override final;
 
 private:
-    bool ValidateAndSign(DxcCreateInstanceProc CreateInstance, IDxcLibrary* pdxcLibrary, CComPtr<IDxcBlob>& pCompiled, IDxcBlob** ppOutput) const noexcept(false);
+    // DXC objects are not thread-safe, but they can be reused by subsequent operations.
+    // Creating the objects is relatively expensive, so every operation takes a set of
+    // objects from the pool and returns it when it is done. This way the objects
+    // are never used by two threads simultaneously.
+    struct DxcObjects
+    {
+        CComPtr<IDxcLibrary>   pLibrary;
+        CComPtr<IDxcCompiler>  pCompiler;
+        CComPtr<IDxcValidator> pValidator;
+        CComPtr<IDxcAssembler> pAssembler;
+    };
+
+    class PooledDxcObjects
+    {
+    public:
+        PooledDxcObjects(DXCompilerImpl& Compiler, std::unique_ptr<DxcObjects>&& pObjects) noexcept :
+            m_Compiler{Compiler},
+            m_pObjects{std::move(pObjects)}
+        {}
+
+        // clang-format off
+        PooledDxcObjects           (const PooledDxcObjects&)  = delete;
+        PooledDxcObjects& operator=(const PooledDxcObjects&)  = delete;
+        PooledDxcObjects           (      PooledDxcObjects&&) = default;
+        PooledDxcObjects& operator=(      PooledDxcObjects&&) = delete;
+        // clang-format on
+
+        ~PooledDxcObjects()
+        {
+            if (m_pObjects)
+                m_Compiler.ReleaseDxcObjects(std::move(m_pObjects));
+        }
+
+        DxcObjects* operator->() const noexcept { return m_pObjects.get(); }
+        DxcObjects& operator*() const noexcept { return *m_pObjects; }
+
+    private:
+        DXCompilerImpl&             m_Compiler;
+        std::unique_ptr<DxcObjects> m_pObjects;
+    };
+
+    // Takes a set of objects from the pool and creates the library and the compiler, if necessary.
+    PooledDxcObjects AcquireDxcObjects(DxcCreateInstanceProc CreateInstance) noexcept(false);
+    void             ReleaseDxcObjects(std::unique_ptr<DxcObjects>&& pObjects);
+
+    bool ValidateAndSign(DxcCreateInstanceProc CreateInstance, DxcObjects& Objects, CComPtr<IDxcBlob>& pCompiled, IDxcBlob** ppOutput) const noexcept(false);
 
     enum RES_TYPE : Uint32
     {
@@ -156,6 +202,10 @@ private:
 private:
     DXCompilerLibrary m_Library;
     const Uint32      m_APIVersion;
+
+    // The pool must be destroyed before the library is unloaded
+    std::mutex                               m_DxcObjectsPoolMtx;
+    std::vector<std::unique_ptr<DxcObjects>> m_DxcObjectsPool;
 };
 
 #define CHECK_D3D_RESULT(Expr, Message)   \
@@ -205,17 +255,14 @@ public:
         if (fileName.size() > 2 && fileName[0] == '.' && (fileName[1] == '\\' || fileName[1] == '/'))
             fileName.erase(0, 2);
 
-        RefCntAutoPtr<IFileStream> pSourceStream;
-        m_pStreamFactory->CreateInputStream(fileName.c_str(), &pSourceStream);
-        if (pSourceStream == nullptr)
+        // The file may be served by the shader source cache
+        RefCntAutoPtr<IDataBlob> pFileData = LoadShaderSourceFile(m_pStreamFactory, fileName.c_str());
+        if (pFileData == nullptr)
         {
             LOG_ERROR("Failed to open shader include file ", fileName, ". Check that the file exists");
             return E_FAIL;
         }
 
-        auto pFileData = DataBlobImpl::Create();
-        pSourceStream->ReadBlob(pFileData);
-
         CComPtr<IDxcBlobEncoding> pSourceBlob;
 
         HRESULT hr = m_pdxcLibrary->CreateBlobWithEncodingFromPinned(pFileData->GetDataPtr(), static_cast<UINT32>(pFileData->GetSize()), CP_UTF8, &pSourceBlob);
@@ -328,6 +375,8 @@ std::unique_ptr<IDXCompiler> CreateDXCompiler(DXCompilerTarget Target, Uint32 AP
 
 bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
 {
+    ShaderCompilationStageScope Compile{SHADER_COMPILATION_STAGE_COMPILE};
+
     try
     {
         DxcCreateInstanceProc CreateInstance = m_Library.GetDxcCreateInstance();
@@ -345,14 +394,12 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
         HRESULT hr;
 
         // NOTE: The call to DxcCreateInstance is thread-safe, but objects created by DxcCreateInstance aren't thread-safe.
-        // Compiler objects should be created and then used on the same thread.
+        // The pooled objects are used by one thread at a time.
         // https://github.com/microsoft/DirectXShaderCompiler/wiki/Using-dxc.exe-and-dxcompiler.dll#dxcompiler-dll-interface
+        PooledDxcObjects Objects = AcquireDxcObjects(CreateInstance);
 
-        CComPtr<IDxcLibrary> pdxcLibrary;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&pdxcLibrary)), "Failed to create DXC Library");
-
-        CComPtr<IDxcCompiler> pdxcCompiler;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&pdxcCompiler)), "Failed to create DXC Compiler");
+        IDxcLibrary*  pdxcLibrary  = Objects->pLibrary;
+        IDxcCompiler* pdxcCompiler = Objects->pCompiler;
 
         CComPtr<IDxcBlobEncoding> pSourceBlob;
         CHECK_D3D_RESULT(pdxcLibrary->CreateBlobWithEncodingFromPinned(Attribs.Source, UINT32{Attribs.SourceLength}, CP_UTF8, &pSourceBlob), "Failed to create DXC Blob Encoding");
@@ -398,7 +445,7 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
         // Validate and sign
         if (m_Library.GetTarget() == DXCompilerTarget::Direct3D12)
         {
-            return ValidateAndSign(CreateInstance, pdxcLibrary, pCompiledBlob, Attribs.ppBlobOut);
+            return ValidateAndSign(CreateInstance, *Objects, pCompiledBlob, Attribs.ppBlobOut);
         }
         else
         {
@@ -412,10 +459,42 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
     }
 }
 
-bool DXCompilerImpl::ValidateAndSign(DxcCreateInstanceProc CreateInstance, IDxcLibrary* library, CComPtr<IDxcBlob>& compiled, IDxcBlob** ppBlobOut) const noexcept(false)
+DXCompilerImpl::PooledDxcObjects DXCompilerImpl::AcquireDxcObjects(DxcCreateInstanceProc CreateInstance) noexcept(false)
 {
-    CComPtr<IDxcValidator> pdxcValidator;
-    CHECK_D3D_RESULT(CreateInstance(CLSID_DxcValidator, IID_PPV_ARGS(&pdxcValidator)), "Failed to create DXC Validator");
+    std::unique_ptr<DxcObjects> pObjects;
+    {
+        std::lock_guard<std::mutex> Lock{m_DxcObjectsPoolMtx};
+        if (!m_DxcObjectsPool.empty())
+        {
+            pObjects = std::move(m_DxcObjectsPool.back());
+            m_DxcObjectsPool.pop_back();
+        }
+    }
+    if (!pObjects)
+        pObjects = std::make_unique<DxcObjects>();
+
+    PooledDxcObjects Objects{*this, std::move(pObjects)};
+    if (!Objects->pLibrary)
+        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&Objects->pLibrary)), "Failed to create DXC Library");
+    if (!Objects->pCompiler)
+        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&Objects->pCompiler)), "Failed to create DXC Compiler");
+
+    return Objects;
+}
+
+void DXCompilerImpl::ReleaseDxcObjects(std::unique_ptr<DxcObjects>&& pObjects)
+{
+    std::lock_guard<std::mutex> Lock{m_DxcObjectsPoolMtx};
+    m_DxcObjectsPool.emplace_back(std::move(pObjects));
+}
+
+bool DXCompilerImpl::ValidateAndSign(DxcCreateInstanceProc CreateInstance, DxcObjects& Objects, CComPtr<IDxcBlob>& compiled, IDxcBlob** ppBlobOut) const noexcept(false)
+{
+    if (!Objects.pValidator)
+        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcValidator, IID_PPV_ARGS(&Objects.pValidator)), "Failed to create DXC Validator");
+
+    IDxcLibrary*   library       = Objects.pLibrary;
+    IDxcValidator* pdxcValidator = Objects.pValidator;
 
     CComPtr<IDxcOperationResult> pdxcResult;
     CHECK_D3D_RESULT(pdxcValidator->Validate(compiled, DxcValidatorFlags_InPlaceEdit, &pdxcResult), "Failed to validate shader bytecode");
@@ -827,14 +906,13 @@ bool DXCompilerImpl::RemapResourceBindings(const TResourceBindingMap& ResourceMa
             return false;
         }
 
-        CComPtr<IDxcLibrary> pdxcLibrary;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&pdxcLibrary)), "Failed to create DXC Library");
-
-        CComPtr<IDxcAssembler> pdxcAssembler;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcAssembler, IID_PPV_ARGS(&pdxcAssembler)), "Failed to create DXC assembler");
+        PooledDxcObjects Objects = AcquireDxcObjects(CreateInstance);
+        if (!Objects->pAssembler)
+            CHECK_D3D_RESULT(CreateInstance(CLSID_DxcAssembler, IID_PPV_ARGS(&Objects->pAssembler)), "Failed to create DXC assembler");
 
-        CComPtr<IDxcCompiler> pdxcCompiler;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&pdxcCompiler)), "Failed to create DXC Compiler");
+        IDxcLibrary*   pdxcLibrary   = Objects->pLibrary;
+        IDxcAssembler* pdxcAssembler = Objects->pAssembler;
+        IDxcCompiler*  pdxcCompiler  = Objects->pCompiler;
 
         CComPtr<IDxcBlobEncoding> pdxcDisasm;
         CHECK_D3D_RESULT(pdxcCompiler->Disassemble(pSrcBytecode, &pdxcDisasm), "Failed to disassemble bytecode");
@@ -988,7 +1066,7 @@ bool DXCompilerImpl::RemapResourceBindings(const TResourceBindingMap& ResourceMa
         CComPtr<IDxcBlob> pCompiledBlob;
         CHECK_D3D_RESULT(pdxcResult->GetResult(static_cast<IDxcBlob**>(&pCompiledBlob)), "Failed to get compiled blob from DXC result");
 
-        return ValidateAndSign(CreateInstance, pdxcLibrary, pCompiledBlob, ppDstByteCode);
+        return ValidateAndSign(CreateInstance, *Objects, pCompiledBlob, ppDstByteCode);
     }
     catch (...)
     {
@@ -37,6 +37,7 @@
 #include "DataBlobImpl.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "ParsingTools.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 namespace Diligent
 {
@@ -246,6 +247,8 @@ static void AppendPrecisionQualifiers(const DeviceFeatures&    Features,
 
 String BuildGLSLSourceString(const BuildGLSLSourceStringAttribs& Attribs) noexcept(false)
 {
+    ShaderCompilationStageScope Preprocess{SHADER_COMPILATION_STAGE_PREPROCESS};
+
     const ShaderCreateInfo& ShaderCI = Attribs.ShaderCI;
 
     if (!(ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_DEFAULT ||
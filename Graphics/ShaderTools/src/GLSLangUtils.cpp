@@ -31,6 +31,7 @@
 #include <unordered_map>
 #include <memory>
 #include <array>
+#include <mutex>
 
 #ifdef VK_USE_PLATFORM_METAL_EXT
 #    include <MoltenGLSLToSPIRVConverter/GLSLToSPIRVConverter.h>
@@ -47,6 +48,7 @@
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "ShaderCompilationProfiler.hpp"
 #ifdef USE_SPIRV_TOOLS
 #    include "SPIRVTools.hpp"
 #endif
@@ -64,14 +66,47 @@ namespace Diligent
 namespace GLSLangUtils
 {
 
-void InitializeGlslang()
+namespace
+{
+
+std::mutex g_GlslangMtx;
+// The number of InitializeGlslang() calls that have not been matched by FinalizeGlslang()
+Uint32 g_GlslangRefCount = 0;
+// Whether glslang::InitializeProcess() has been called
+bool g_GlslangProcessInitialized = false;
+
+void EnsureGlslangInitialized()
 {
-    ::glslang::InitializeProcess();
+    std::lock_guard<std::mutex> Lock{g_GlslangMtx};
+    if (!g_GlslangProcessInitialized)
+    {
+        ::glslang::InitializeProcess();
+        g_GlslangProcessInitialized = true;
+    }
+}
+
+} // namespace
+
+void InitializeGlslang(bool Deferred)
+{
+    std::lock_guard<std::mutex> Lock{g_GlslangMtx};
+    ++g_GlslangRefCount;
+    if (!Deferred && !g_GlslangProcessInitialized)
+    {
+        ::glslang::InitializeProcess();
+        g_GlslangProcessInitialized = true;
+    }
 }
 
 void FinalizeGlslang()
 {
-    ::glslang::FinalizeProcess();
+    std::lock_guard<std::mutex> Lock{g_GlslangMtx};
+    VERIFY(g_GlslangRefCount > 0, "Unbalanced call to FinalizeGlslang()");
+    if (g_GlslangRefCount > 0 && --g_GlslangRefCount == 0 && g_GlslangProcessInitialized)
+    {
+        ::glslang::FinalizeProcess();
+        g_GlslangProcessInitialized = false;
+    }
 }
 
 namespace
@@ -308,16 +343,13 @@ public:
                                          size_t /*inclusionDepth*/)
     {
         DEV_CHECK_ERR(m_pInputStreamFactory != nullptr, "The shader source contains #include directives, but no input stream factory was provided");
-        RefCntAutoPtr<IFileStream> pSourceStream;
-        m_pInputStreamFactory->CreateInputStream(headerName, &pSourceStream);
-        if (pSourceStream == nullptr)
+        // The file may be served by the shader source cache
+        RefCntAutoPtr<IDataBlob> pFileData = LoadShaderSourceFile(m_pInputStreamFactory, headerName);
+        if (pFileData == nullptr)
         {
             LOG_ERROR("Failed to open shader include file '", headerName, "'. Check that the file exists");
             return nullptr;
         }
-
-        auto pFileData = DataBlobImpl::Create();
-        pSourceStream->ReadBlob(pFileData);
         auto* pNewInclude =
             new IncludeResult{
                 headerName,
@@ -431,6 +463,10 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       const char*             ExtraDefinitions,
                                       IDataBlob**             ppCompilerOutput)
 {
+    ShaderCompilationStageScope Compile{SHADER_COMPILATION_STAGE_COMPILE};
+
+    EnsureGlslangInitialized();
+
     EShLanguage        ShLang = ShaderTypeToShLanguage(ShaderCI.Desc.ShaderType);
     ::glslang::TShader Shader{ShLang};
     EShMessages        messages  = (EShMessages)(EShMsgSpvRules | EShMsgVulkanRules | EShMsgReadHlsl | EShMsgHlslLegalization);
@@ -487,7 +523,11 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 #ifdef USE_SPIRV_TOOLS
     // SPIR-V bytecode generated from HLSL must be legalized to
     // turn it into a valid vulkan SPIR-V shader.
-    auto LegalizedSPIRV = OptimizeSPIRV(SPIRV, SpirvVersionToSpvTargetEnv(Version), SPIRV_OPTIMIZATION_FLAG_LEGALIZATION | SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    const SPIRV_OPTIMIZATION_FLAGS OptimizationPasses = (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_OPTIMIZE_FOR_SIZE) != 0 ?
+        SPIRV_OPTIMIZATION_FLAG_SIZE :
+        SPIRV_OPTIMIZATION_FLAG_PERFORMANCE;
+
+    auto LegalizedSPIRV = OptimizeSPIRV(SPIRV, SpirvVersionToSpvTargetEnv(Version), SPIRV_OPTIMIZATION_FLAG_LEGALIZATION | OptimizationPasses);
     if (!LegalizedSPIRV.empty())
     {
         return LegalizedSPIRV;
@@ -502,8 +542,12 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 
 std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
 {
+    ShaderCompilationStageScope Compile{SHADER_COMPILATION_STAGE_COMPILE};
+
     VERIFY_EXPR(Attribs.ShaderSource != nullptr && Attribs.SourceCodeLen > 0);
 
+    EnsureGlslangInitialized();
+
     const EShLanguage  ShLang = ShaderTypeToShLanguage(Attribs.ShaderType);
     ::glslang::TShader Shader(ShLang);
     ::EProfile         shProfile = EProfile::ENoProfile;
@@ -534,7 +578,8 @@ std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
         return SPIRV;
 
 #ifdef USE_SPIRV_TOOLS
-    auto OptimizedSPIRV = OptimizeSPIRV(SPIRV, SpirvVersionToSpvTargetEnv(Attribs.Version), SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    auto OptimizedSPIRV = OptimizeSPIRV(SPIRV, SpirvVersionToSpvTargetEnv(Attribs.Version),
+                                        Attribs.OptimizeForSize ? SPIRV_OPTIMIZATION_FLAG_SIZE : SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
     if (!OptimizedSPIRV.empty())
     {
         return OptimizedSPIRV;
@@ -26,6 +26,8 @@
 
 #include "HLSLTokenizer.hpp"
 
+#include <algorithm>
+
 namespace Diligent
 {
 
@@ -38,6 +40,11 @@ HLSLTokenizer::HLSLTokenizer()
 #define DEFINE_KEYWORD(keyword) m_Keywords.insert(std::make_pair(#keyword, HLSLTokenInfo(HLSLTokenType::kw_##keyword, #keyword)));
     ITERATE_HLSL_KEYWORDS(DEFINE_KEYWORD)
 #undef DEFINE_KEYWORD
+
+#ifdef DILIGENT_DEBUG
+    for (const auto& Keyword : m_Keywords)
+        VERIFY(Keyword.second.Literal.length() <= MaxKeywordLength, "Keyword '", Keyword.second.Literal, "' is too long");
+#endif
 }
 
 HLSLTokenizer::TokenListType HLSLTokenizer::Tokenize(const String& Source) const
@@ -57,10 +64,20 @@ HLSLTokenizer::TokenListType HLSLTokenizer::Tokenize(const String& Source) const
             },
             [&](const std::string::const_iterator& Start, const std::string::const_iterator& End) //
             {
-                auto KeywordIt = m_Keywords.find(HashMapStringKey{std::string{Start, End}});
+                // Identifiers longer than the longest keyword can't be keywords
+                const size_t Length = static_cast<size_t>(End - Start);
+                if (Length > MaxKeywordLength)
+                    return HLSLTokenType::Identifier;
+
+                // Copy the literal to the stack to avoid allocating a string for every identifier
+                char Literal[MaxKeywordLength + 1];
+                std::copy(Start, End, Literal);
+                Literal[Length] = '\0';
+
+                auto KeywordIt = m_Keywords.find(HashMapStringKey{Literal});
                 if (KeywordIt != m_Keywords.end())
                 {
-                    VERIFY(std::string(Start, End) == KeywordIt->second.Literal, "Inconsistent literal");
+                    VERIFY(KeywordIt->second.Literal == Literal, "Inconsistent literal");
                     return KeywordIt->second.Type;
                 }
                 return HLSLTokenType::Identifier;
@@ -31,6 +31,7 @@
 #include "HLSLUtils.hpp"
 #include "DebugUtilities.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 namespace Diligent
 {
@@ -46,6 +47,8 @@ static constexpr char g_HLSLDefinitions[] =
 String BuildHLSLSourceString(const ShaderCreateInfo& ShaderCI,
                              const char*             ExtraDefinitions) noexcept(false)
 {
+    ShaderCompilationStageScope Preprocess{SHADER_COMPILATION_STAGE_PREPROCESS};
+
     String HLSLSource;
 
     HLSLSource.append(g_HLSLDefinitions);
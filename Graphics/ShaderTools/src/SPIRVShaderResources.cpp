@@ -26,6 +26,8 @@
  */
 
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
 #include "SPIRVShaderResources.hpp"
 #include "spirv_parser.hpp"
 #include "spirv_cross.hpp"
@@ -38,88 +40,23 @@
 namespace Diligent
 {
 
-template <typename Type>
-Type GetResourceArraySize(const diligent_spirv_cross::Compiler& Compiler,
-                          const diligent_spirv_cross::Resource& Res)
-{
-    const auto& type    = Compiler.get_type(Res.type_id);
-    uint32_t    arrSize = 1;
-    if (!type.array.empty())
-    {
-        // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide#querying-array-types
-        VERIFY(type.array.size() == 1, "Only one-dimensional arrays are currently supported");
-        arrSize = type.array[0];
-    }
-    VERIFY(arrSize <= std::numeric_limits<Type>::max(), "Array size exceeds maximum representable value ", std::numeric_limits<Type>::max());
-    return static_cast<Type>(arrSize);
-}
-
-static RESOURCE_DIMENSION GetResourceDimension(const diligent_spirv_cross::Compiler& Compiler,
-                                               const diligent_spirv_cross::Resource& Res)
-{
-    const auto& type = Compiler.get_type(Res.type_id);
-    if (type.basetype == diligent_spirv_cross::SPIRType::BaseType::Image ||
-        type.basetype == diligent_spirv_cross::SPIRType::BaseType::SampledImage)
-    {
-        switch (type.image.dim)
-        {
-            // clang-format off
-            case spv::Dim1D:     return type.image.arrayed ? RESOURCE_DIM_TEX_1D_ARRAY : RESOURCE_DIM_TEX_1D;
-            case spv::Dim2D:     return type.image.arrayed ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D;
-            case spv::Dim3D:     return RESOURCE_DIM_TEX_3D;
-            case spv::DimCube:   return type.image.arrayed ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE;
-            case spv::DimBuffer: return RESOURCE_DIM_BUFFER;
-            // clang-format on
-            default: return RESOURCE_DIM_UNDEFINED;
-        }
-    }
-    else
-    {
-        return RESOURCE_DIM_UNDEFINED;
-    }
-}
-
-static bool IsMultisample(const diligent_spirv_cross::Compiler& Compiler,
-                          const diligent_spirv_cross::Resource& Res)
-{
-    const auto& type = Compiler.get_type(Res.type_id);
-    if (type.basetype == diligent_spirv_cross::SPIRType::BaseType::Image ||
-        type.basetype == diligent_spirv_cross::SPIRType::BaseType::SampledImage)
-    {
-        return type.image.ms;
-    }
-    else
-    {
-        return RESOURCE_DIM_UNDEFINED;
-    }
-}
-
-static uint32_t GetDecorationOffset(const diligent_spirv_cross::Compiler& Compiler,
-                                    const diligent_spirv_cross::Resource& Res,
-                                    spv::Decoration                       Decoration)
-{
-    VERIFY(Compiler.has_decoration(Res.id, Decoration), "Resource \'", Res.name, "\' has no requested decoration");
-    uint32_t offset   = 0;
-    auto     declared = Compiler.get_binary_offset_for_decoration(Res.id, Decoration, offset);
-    VERIFY(declared, "Requested decoration is not declared");
-    (void)declared;
-    return offset;
-}
-
-SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const diligent_spirv_cross::Compiler& Compiler,
-                                                       const diligent_spirv_cross::Resource& Res,
-                                                       const char*                           _Name,
-                                                       ResourceType                          _Type,
-                                                       Uint32                                _BufferStaticSize,
-                                                       Uint32                                _BufferStride) noexcept :
+SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const char*        _Name,
+                                                       ResourceType       _Type,
+                                                       Uint16             _ArraySize,
+                                                       RESOURCE_DIMENSION _ResourceDim,
+                                                       bool               _IsMS,
+                                                       uint32_t           _BindingDecorationOffset,
+                                                       uint32_t           _DescriptorSetDecorationOffset,
+                                                       Uint32             _BufferStaticSize,
+                                                       Uint32             _BufferStride) noexcept :
     // clang-format off
     Name                          {_Name},
-    ArraySize                     {GetResourceArraySize<decltype(ArraySize)>(Compiler, Res)},
+    ArraySize                     {_ArraySize},
     Type                          {_Type},
-    ResourceDim                   {Diligent::GetResourceDimension(Compiler, Res)},
-    IsMS                          {Diligent::IsMultisample(Compiler, Res) ? Uint8{1} : Uint8{0}},
-    BindingDecorationOffset       {GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationBinding)},
-    DescriptorSetDecorationOffset {GetDecorationOffset(Compiler, Res, spv::Decoration::DecorationDescriptorSet)},
+    ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+    IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+    BindingDecorationOffset       {_BindingDecorationOffset},
+    DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
     BufferStaticSize              {_BufferStaticSize},
     BufferStride                  {_BufferStride}
 // clang-format on
@@ -223,44 +160,6 @@ spv::ExecutionModel ShaderTypeToSpvExecutionModel(SHADER_TYPE ShaderType)
     }
 }
 
-const std::string& GetUBName(diligent_spirv_cross::Compiler&               Compiler,
-                             const diligent_spirv_cross::Resource&         UB,
-                             const diligent_spirv_cross::ParsedIR::Source& IRSource)
-{
-    // Consider the following HLSL constant buffer:
-    //
-    //    cbuffer Constants
-    //    {
-    //        float4x4 g_WorldViewProj;
-    //    };
-    //
-    // glslang emits SPIRV as if the following GLSL was written:
-    //
-    //    uniform Constants // UB.name
-    //    {
-    //        float4x4 g_WorldViewProj;
-    //    }; // no instance name
-    //
-    // DXC emits the byte code that corresponds to the following GLSL:
-    //
-    //    uniform type_Constants // UB.name
-    //    {
-    //        float4x4 g_WorldViewProj;
-    //    }Constants; // get_name(UB.id)
-    //
-    //
-    //                            |     glslang      |         DXC
-    //  -------------------------------------------------------------------
-    //  UB.name                   |   "Constants"    |   "type_Constants"
-    //  Compiler.get_name(UB.id)  |   ""             |   "Constants"
-    //
-    // Note that for the byte code produced from GLSL, we must always
-    // use UB.name even if the instance name is present
-
-    const auto& instance_name = Compiler.get_name(UB.id);
-    return (IRSource.hlsl && !instance_name.empty()) ? instance_name : UB.name;
-}
-
 static SHADER_CODE_BASIC_TYPE SpirvBaseTypeToShaderCodeBasicType(diligent_spirv_cross::SPIRType::BaseType SpvBaseType)
 {
     switch (SpvBaseType)
@@ -375,306 +274,1010 @@ ShaderCodeBufferDescX LoadUBReflection(const diligent_spirv_cross::Compiler& Com
 }
 
 
-SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
-                                           std::vector<uint32_t> spirv_binary,
-                                           const ShaderDesc&     shaderDesc,
-                                           const char*           CombinedSamplerSuffix,
-                                           bool                  LoadShaderStageInputs,
-                                           bool                  LoadUniformBufferReflection,
-                                           std::string&          EntryPoint) noexcept(false) :
-    m_ShaderType{shaderDesc.ShaderType}
+namespace
 {
-    // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide
-    diligent_spirv_cross::Parser parser{std::move(spirv_binary)};
-    parser.parse();
-    const auto ParsedIRSource = parser.get_parsed_ir().source;
-    m_IsHLSLSource            = ParsedIRSource.hlsl;
-    diligent_spirv_cross::Compiler Compiler{std::move(parser.get_parsed_ir())};
 
-    spv::ExecutionModel ExecutionModel = ShaderTypeToSpvExecutionModel(shaderDesc.ShaderType);
-    auto                EntryPoints    = Compiler.get_entry_points_and_stages();
-    for (const auto& CurrEntryPoint : EntryPoints)
+// Lightweight SPIR-V reflection that walks the word stream directly.
+//
+// Building the SPIRV-Cross IR and compiler is relatively expensive for large shaders,
+// while SPIRVShaderResources only needs resource types, names, array sizes, decoration
+// offsets and buffer sizes. The resources are classified the same way as
+// diligent_spirv_cross::Compiler::get_shader_resources() does. Parsing stops at
+// the first function definition as all declarations precede it.
+//
+// Note that SPIR-V literal strings are referenced in place: the strings are packed
+// into words starting from the lowest-order byte, which matches the memory layout
+// on little-endian platforms.
+class SPIRVReflection
+{
+public:
+    struct ResourceInfo
     {
-        if (CurrEntryPoint.execution_model == ExecutionModel)
+        uint32_t    VarId = 0;
+        std::string Name;
+
+        SPIRVShaderResourceAttribs::ResourceType Type = SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes;
+
+        Uint16             ArraySize   = 1;
+        RESOURCE_DIMENSION ResourceDim = RESOURCE_DIM_UNDEFINED;
+        bool               IsMS        = false;
+
+        // Offsets in SPIRV words of the binding and descriptor set decoration literals
+        uint32_t BindingDecorationOffset       = 0;
+        uint32_t DescriptorSetDecorationOffset = 0;
+
+        Uint32 BufferStaticSize = 0;
+        Uint32 BufferStride     = 0;
+    };
+
+    struct StageInputInfo
+    {
+        uint32_t    VarId                    = 0;
+        const char* Name                     = nullptr;
+        const char* Semantic                 = nullptr;
+        uint32_t    LocationDecorationOffset = 0;
+    };
+
+    struct ShaderResources
+    {
+        std::vector<ResourceInfo>   UniformBuffers;
+        std::vector<ResourceInfo>   StorageBuffers;
+        std::vector<ResourceInfo>   StorageImages;
+        std::vector<ResourceInfo>   SampledImages;
+        std::vector<ResourceInfo>   AtomicCounters;
+        std::vector<ResourceInfo>   SeparateSamplers;
+        std::vector<ResourceInfo>   SeparateImages;
+        std::vector<ResourceInfo>   SubpassInputs;
+        std::vector<ResourceInfo>   AccelerationStructures;
+        std::vector<StageInputInfo> StageInputs;
+    };
+
+    struct EntryPointInfo
+    {
+        spv::ExecutionModel ExecutionModel  = spv::ExecutionModelMax;
+        uint32_t            FunctionId      = 0;
+        const char*         Name            = nullptr;
+        uint32_t            InterfaceOffset = 0;
+        uint32_t            NumInterfaceIds = 0;
+    };
+
+    explicit SPIRVReflection(const std::vector<uint32_t>& SPIRV) noexcept(false);
+
+    const std::vector<EntryPointInfo>& GetEntryPoints() const { return m_EntryPoints; }
+
+    bool IsHLSLSource() const { return m_IsHLSLSource; }
+    bool UsesHlslFunctionality1() const { return m_HlslFunctionality1; }
+
+    ShaderResources GetShaderResources(const EntryPointInfo& EntryPoint) const noexcept(false);
+
+    std::array<Uint32, 3> GetLocalSize(const EntryPointInfo& EntryPoint) const;
+
+private:
+    enum DECORATION_FLAGS : Uint8
+    {
+        DECORATION_FLAG_NONE             = 0,
+        DECORATION_FLAG_BLOCK            = 1u << 0u,
+        DECORATION_FLAG_BUFFER_BLOCK     = 1u << 1u,
+        DECORATION_FLAG_NON_WRITABLE     = 1u << 2u,
+        DECORATION_FLAG_BUILT_IN         = 1u << 3u,
+        DECORATION_FLAG_MEMBER_BUILT_IN  = 1u << 4u,
+        DECORATION_FLAG_HAS_ARRAY_STRIDE = 1u << 5u,
+    };
+
+    struct IdInfo
+    {
+        // Offset of the instruction that defines the id, or 0 if the id is not a type, constant or variable
+        uint32_t DefOffset = 0;
+
+        const char* Name         = nullptr;
+        const char* HLSLSemantic = nullptr;
+
+        // Offsets of the decoration literals, or 0 if the decoration is not declared
+        uint32_t BindingOffset       = 0;
+        uint32_t DescriptorSetOffset = 0;
+        uint32_t LocationOffset      = 0;
+
+        uint32_t ArrayStride = 0;
+        Uint8    Flags       = DECORATION_FLAG_NONE;
+    };
+
+    struct MemberDecoration
+    {
+        uint32_t StructId;
+        uint32_t Member;
+        uint32_t Decoration;
+        uint32_t Value;
+
+        bool operator<(const MemberDecoration& rhs) const
         {
-            if (!EntryPoint.empty())
-            {
-                LOG_WARNING_MESSAGE("More than one entry point of type ", GetShaderTypeLiteralName(shaderDesc.ShaderType), " found in SPIRV binary for shader '", shaderDesc.Name, "'. The first one ('", EntryPoint, "') will be used.");
-            }
-            else
-            {
-                EntryPoint = CurrEntryPoint.name;
-            }
+            return StructId != rhs.StructId ? StructId < rhs.StructId : Member < rhs.Member;
         }
+    };
+
+    void ParseInstruction(spv::Op OpCode, uint32_t Offset, uint32_t WordCount) noexcept(false);
+
+    const char* GetString(uint32_t Offset, uint32_t MaxWords, uint32_t* pNumWords = nullptr) const noexcept(false);
+
+    IdInfo& GetIdInfo(uint32_t Id) noexcept(false)
+    {
+        if (Id >= m_Ids.size())
+            LOG_ERROR_AND_THROW("SPIRV id ", Id, " exceeds the id bound (", m_Ids.size(), ")");
+        return m_Ids[Id];
     }
-    if (EntryPoint.empty())
+
+    const IdInfo* FindIdInfo(uint32_t Id) const
     {
-        LOG_ERROR_AND_THROW("Unable to find entry point of type ", GetShaderTypeLiteralName(shaderDesc.ShaderType), " in SPIRV binary for shader '", shaderDesc.Name, "'");
+        return Id < m_Ids.size() ? &m_Ids[Id] : nullptr;
     }
-    Compiler.set_entry_point(EntryPoint, ExecutionModel);
 
-    // The SPIR-V is now parsed, and we can perform reflection on it.
-    diligent_spirv_cross::ShaderResources resources = Compiler.get_shader_resources();
+    // Returns the pointer to the instruction that defines the id, or null
+    const uint32_t* GetDefinition(uint32_t Id, spv::Op* pOpCode = nullptr) const
+    {
+        const IdInfo* pInfo = FindIdInfo(Id);
+        if (pInfo == nullptr || pInfo->DefOffset == 0)
+            return nullptr;
+
+        const uint32_t* pInstr = &m_SPIRV[pInfo->DefOffset];
+        if (pOpCode != nullptr)
+            *pOpCode = static_cast<spv::Op>(pInstr[0] & spv::OpCodeMask);
+        return pInstr;
+    }
 
-    size_t ResourceNamesPoolSize = 0;
-    for (const auto& ub : resources.uniform_buffers)
-        ResourceNamesPoolSize += GetUBName(Compiler, ub, ParsedIRSource).length() + 1;
-    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please account for the new resource type below");
-    for (auto* pResType :
-         {
-             &resources.storage_buffers,
-             &resources.storage_images,
-             &resources.sampled_images,
-             &resources.atomic_counters,
-             &resources.separate_images,
-             &resources.separate_samplers,
-             &resources.subpass_inputs,
-             &resources.acceleration_structures //
-         })                                     //
+    const uint32_t* GetTypeDefinition(uint32_t TypeId, spv::Op ExpectedOpCode) const noexcept(false);
+
+    const char* GetName(uint32_t Id) const
     {
-        for (const auto& res : *pResType)
-            ResourceNamesPoolSize += res.name.length() + 1;
+        const IdInfo* pInfo = FindIdInfo(Id);
+        return pInfo != nullptr && pInfo->Name != nullptr ? pInfo->Name : "";
     }
 
-    if (CombinedSamplerSuffix != nullptr)
+    std::string GetBlockName(uint32_t VarId, uint32_t BlockTypeId, bool PreferInstanceName) const;
+
+    bool FindMemberDecoration(uint32_t StructId, uint32_t Member, spv::Decoration Decoration, uint32_t* pValue = nullptr) const;
+
+    bool EvaluateConstant(uint32_t ConstantId, uint32_t& Value) const;
+
+    size_t GetDeclaredStructSize(uint32_t StructId) const noexcept(false);
+    size_t GetDeclaredStructMemberSize(uint32_t StructId, uint32_t Member) const noexcept(false);
+
+    bool IsSSBOInstanceNameSignificant() const;
+
+private:
+    const std::vector<uint32_t>& m_SPIRV;
+
+    uint32_t m_Version = 0;
+
+    std::vector<IdInfo>           m_Ids;
+    std::vector<MemberDecoration> m_MemberDecorations;
+    std::vector<uint32_t>         m_Variables;      // Offsets of global OpVariable instructions
+    std::vector<uint32_t>         m_ExecutionModes; // Offsets of OpExecutionMode and OpExecutionModeId instructions
+    std::vector<EntryPointInfo>   m_EntryPoints;
+
+    bool m_IsSourceKnown      = false;
+    bool m_IsHLSLSource       = false;
+    bool m_HlslFunctionality1 = false;
+};
+
+SPIRVReflection::SPIRVReflection(const std::vector<uint32_t>& SPIRV) noexcept(false) :
+    m_SPIRV{SPIRV}
+{
+    // https://registry.khronos.org/SPIR-V/specs/unified1/SPIRV.html#PhysicalLayout
+    constexpr size_t HeaderSize = 5;
+    if (SPIRV.size() < HeaderSize || SPIRV[0] != spv::MagicNumber)
+        LOG_ERROR_AND_THROW("Invalid SPIRV binary");
+
+    m_Version = SPIRV[1];
+    m_Ids.resize(SPIRV[3]);
+
+    for (size_t Offset = HeaderSize; Offset < SPIRV.size();)
     {
-        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
+        const uint32_t WordCount = SPIRV[Offset] >> spv::WordCountShift;
+        const spv::Op  OpCode    = static_cast<spv::Op>(SPIRV[Offset] & spv::OpCodeMask);
+        if (WordCount == 0 || Offset + WordCount > SPIRV.size())
+            LOG_ERROR_AND_THROW("Invalid SPIRV instruction at word offset ", Offset);
+
+        // Types, constants, global variables and annotations precede all functions
+        if (OpCode == spv::OpFunction)
+            break;
+
+        ParseInstruction(OpCode, static_cast<uint32_t>(Offset), WordCount);
+        Offset += WordCount;
     }
 
-    VERIFY_EXPR(shaderDesc.Name != nullptr);
-    ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
+    std::stable_sort(m_MemberDecorations.begin(), m_MemberDecorations.end());
+}
 
-    Uint32 NumShaderStageInputs = 0;
+const char* SPIRVReflection::GetString(uint32_t Offset, uint32_t MaxWords, uint32_t* pNumWords) const noexcept(false)
+{
+    const char* Str = reinterpret_cast<const char*>(&m_SPIRV[Offset]);
+    const void* End = memchr(Str, '\0', size_t{MaxWords} * sizeof(uint32_t));
+    if (End == nullptr)
+        LOG_ERROR_AND_THROW("SPIRV literal string at word offset ", Offset, " is not null-terminated");
+
+    if (pNumWords != nullptr)
+        *pNumWords = static_cast<uint32_t>((static_cast<const char*>(End) - Str) / sizeof(uint32_t) + 1);
+    return Str;
+}
 
-    if (!m_IsHLSLSource || resources.stage_inputs.empty())
-        LoadShaderStageInputs = false;
-    if (LoadShaderStageInputs)
+void SPIRVReflection::ParseInstruction(spv::Op OpCode, uint32_t Offset, uint32_t WordCount) noexcept(false)
+{
+    const uint32_t* Ops    = &m_SPIRV[Offset + 1];
+    const uint32_t  NumOps = WordCount - 1;
+
+    auto CheckNumOperands = [&](uint32_t MinOps) {
+        if (NumOps < MinOps)
+            LOG_ERROR_AND_THROW("SPIRV instruction at word offset ", Offset, " has too few operands");
+    };
+
+    switch (OpCode)
     {
-        const auto& Extensions         = Compiler.get_declared_extensions();
-        bool        HlslFunctionality1 = false;
-        for (const auto& ext : Extensions)
+        case spv::OpSource:
+            CheckNumOperands(1);
+            m_IsSourceKnown = (Ops[0] == spv::SourceLanguageESSL || Ops[0] == spv::SourceLanguageGLSL || Ops[0] == spv::SourceLanguageHLSL);
+            m_IsHLSLSource  = (Ops[0] == spv::SourceLanguageHLSL);
+            break;
+
+        case spv::OpExtension:
+            CheckNumOperands(1);
+            if (strcmp(GetString(Offset + 1, NumOps), "SPV_GOOGLE_hlsl_functionality1") == 0)
+                m_HlslFunctionality1 = true;
+            break;
+
+        case spv::OpEntryPoint:
         {
-            HlslFunctionality1 = (ext == "SPV_GOOGLE_hlsl_functionality1");
-            if (HlslFunctionality1)
-                break;
+            CheckNumOperands(3);
+            EntryPointInfo EntryPoint;
+            EntryPoint.ExecutionModel = static_cast<spv::ExecutionModel>(Ops[0]);
+            EntryPoint.FunctionId     = Ops[1];
+
+            uint32_t NameWords = 0;
+            EntryPoint.Name    = GetString(Offset + 3, NumOps - 2, &NameWords);
+
+            EntryPoint.InterfaceOffset = Offset + 3 + NameWords;
+            EntryPoint.NumInterfaceIds = NumOps - 2 - NameWords;
+            m_EntryPoints.emplace_back(EntryPoint);
+            break;
         }
 
-        if (HlslFunctionality1)
+        case spv::OpExecutionMode:
+        case spv::OpExecutionModeId:
+            CheckNumOperands(2);
+            m_ExecutionModes.emplace_back(Offset);
+            break;
+
+        case spv::OpName:
+            CheckNumOperands(2);
+            GetIdInfo(Ops[0]).Name = GetString(Offset + 2, NumOps - 1);
+            break;
+
+        case spv::OpDecorate:
+        case spv::OpDecorateId:
         {
-            for (const auto& Input : resources.stage_inputs)
+            CheckNumOperands(2);
+            IdInfo& Info = GetIdInfo(Ops[0]);
+            // The offset of the first decoration literal
+            const uint32_t LiteralOffset = NumOps >= 3 ? Offset + 3 : 0;
+            switch (Ops[1])
             {
-                if (Compiler.has_decoration(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE))
-                {
-                    const auto& Semantic = Compiler.get_decoration_string(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE);
-                    ResourceNamesPoolSize += Semantic.length() + 1;
-                    ++NumShaderStageInputs;
-                }
-                else
-                {
-                    LOG_ERROR_MESSAGE("Shader input '", Input.name, "' does not have DecorationHlslSemanticGOOGLE decoration, which is unexpected as the shader declares SPV_GOOGLE_hlsl_functionality1 extension");
-                }
+                // clang-format off
+                case spv::DecorationBinding:       Info.BindingOffset       = LiteralOffset; break;
+                case spv::DecorationDescriptorSet: Info.DescriptorSetOffset = LiteralOffset; break;
+                case spv::DecorationLocation:      Info.LocationOffset      = LiteralOffset; break;
+                case spv::DecorationBlock:         Info.Flags |= DECORATION_FLAG_BLOCK;        break;
+                case spv::DecorationBufferBlock:   Info.Flags |= DECORATION_FLAG_BUFFER_BLOCK; break;
+                case spv::DecorationNonWritable:   Info.Flags |= DECORATION_FLAG_NON_WRITABLE; break;
+                case spv::DecorationBuiltIn:       Info.Flags |= DECORATION_FLAG_BUILT_IN;     break;
+                // clang-format on
+                case spv::DecorationArrayStride:
+                    CheckNumOperands(3);
+                    Info.ArrayStride = Ops[2];
+                    Info.Flags |= DECORATION_FLAG_HAS_ARRAY_STRIDE;
+                    break;
+
+                default:
+                    break;
             }
+            break;
         }
-        else
+
+        case spv::OpDecorateString:
+            CheckNumOperands(3);
+            if (Ops[1] == spv::DecorationHlslSemanticGOOGLE)
+                GetIdInfo(Ops[0]).HLSLSemantic = GetString(Offset + 3, NumOps - 2);
+            break;
+
+        case spv::OpMemberDecorate:
+            CheckNumOperands(3);
+            if (Ops[2] == spv::DecorationBuiltIn)
+                GetIdInfo(Ops[0]).Flags |= DECORATION_FLAG_MEMBER_BUILT_IN;
+            m_MemberDecorations.emplace_back(MemberDecoration{Ops[0], Ops[1], Ops[2], NumOps >= 4 ? Ops[3] : 0});
+            break;
+
+        case spv::OpTypeBool:
+        case spv::OpTypeSampler:
+        case spv::OpTypeStruct:
+        case spv::OpTypeAccelerationStructureKHR:
+            CheckNumOperands(1);
+            GetIdInfo(Ops[0]).DefOffset = Offset;
+            break;
+
+        case spv::OpTypeInt:
+        case spv::OpTypeFloat:
+        case spv::OpTypeSampledImage:
+        case spv::OpTypeRuntimeArray:
+            CheckNumOperands(2);
+            GetIdInfo(Ops[0]).DefOffset = Offset;
+            break;
+
+        case spv::OpTypeVector:
+        case spv::OpTypeMatrix:
+        case spv::OpTypeArray:
+        case spv::OpTypePointer:
+            CheckNumOperands(3);
+            GetIdInfo(Ops[0]).DefOffset = Offset;
+            break;
+
+        case spv::OpTypeImage:
+            CheckNumOperands(8);
+            GetIdInfo(Ops[0]).DefOffset = Offset;
+            break;
+
+        case spv::OpConstant:
+        case spv::OpSpecConstant:
+            CheckNumOperands(3);
+            GetIdInfo(Ops[1]).DefOffset = Offset;
+            break;
+
+        case spv::OpVariable:
+            CheckNumOperands(3);
+            GetIdInfo(Ops[1]).DefOffset = Offset;
+            m_Variables.emplace_back(Offset);
+            break;
+
+        default:
+            break;
+    }
+}
+
+const uint32_t* SPIRVReflection::GetTypeDefinition(uint32_t TypeId, spv::Op ExpectedOpCode) const noexcept(false)
+{
+    spv::Op         OpCode = spv::OpNop;
+    const uint32_t* pDef   = GetDefinition(TypeId, &OpCode);
+    if (pDef == nullptr || OpCode != ExpectedOpCode)
+        LOG_ERROR_AND_THROW("SPIRV id ", TypeId, " is not a valid type");
+    return pDef;
+}
+
+std::string SPIRVReflection::GetBlockName(uint32_t VarId, uint32_t BlockTypeId, bool PreferInstanceName) const
+{
+    // Follows diligent_spirv_cross::Compiler::get_remapped_declared_block_name()
+    const char* InstanceName = GetName(VarId);
+    if (PreferInstanceName)
+        return *InstanceName != '\0' ? std::string{InstanceName} : "_" + std::to_string(VarId);
+
+    const char* BlockName = GetName(BlockTypeId);
+    if (*BlockName != '\0')
+        return BlockName;
+
+    return *InstanceName != '\0' ?
+        std::string{InstanceName} :
+        "_" + std::to_string(BlockTypeId) + "_" + std::to_string(VarId);
+}
+
+bool SPIRVReflection::FindMemberDecoration(uint32_t StructId, uint32_t Member, spv::Decoration Decoration, uint32_t* pValue) const
+{
+    const MemberDecoration Key{StructId, Member, 0, 0};
+
+    auto Range = std::equal_range(m_MemberDecorations.begin(), m_MemberDecorations.end(), Key);
+    for (auto it = Range.first; it != Range.second; ++it)
+    {
+        if (it->Decoration == static_cast<uint32_t>(Decoration))
         {
-            LoadShaderStageInputs = false;
-            if (m_IsHLSLSource)
-            {
-                LOG_WARNING_MESSAGE("SPIRV byte code of shader '", shaderDesc.Name,
-                                    "' does not use SPV_GOOGLE_hlsl_functionality1 extension. "
-                                    "As a result, it is not possible to get semantics of shader inputs and map them to proper locations. "
-                                    "The shader will still work correctly if all attributes are declared in ascending order without any gaps. "
-                                    "Enable SPV_GOOGLE_hlsl_functionality1 in your compiler to allow proper mapping of vertex shader inputs.");
-            }
+            if (pValue != nullptr)
+                *pValue = it->Value;
+            return true;
         }
     }
+    return false;
+}
 
-    ResourceCounters ResCounters;
-    ResCounters.NumUBs          = static_cast<Uint32>(resources.uniform_buffers.size());
-    ResCounters.NumSBs          = static_cast<Uint32>(resources.storage_buffers.size());
-    ResCounters.NumImgs         = static_cast<Uint32>(resources.storage_images.size());
-    ResCounters.NumSmpldImgs    = static_cast<Uint32>(resources.sampled_images.size());
-    ResCounters.NumACs          = static_cast<Uint32>(resources.atomic_counters.size());
-    ResCounters.NumSepSmplrs    = static_cast<Uint32>(resources.separate_samplers.size());
-    ResCounters.NumSepImgs      = static_cast<Uint32>(resources.separate_images.size());
-    ResCounters.NumInptAtts     = static_cast<Uint32>(resources.subpass_inputs.size());
-    ResCounters.NumAccelStructs = static_cast<Uint32>(resources.acceleration_structures.size());
-    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please set the new resource type counter here");
+bool SPIRVReflection::EvaluateConstant(uint32_t ConstantId, uint32_t& Value) const
+{
+    spv::Op         OpCode = spv::OpNop;
+    const uint32_t* pDef   = GetDefinition(ConstantId, &OpCode);
+    if (pDef == nullptr || (OpCode != spv::OpConstant && OpCode != spv::OpSpecConstant))
+        return false;
+
+    // Specialization constants are evaluated using their default values.
+    // 64-bit constants are truncated to their low-order word.
+    Value = pDef[3];
+    return true;
+}
 
-    // Resource names pool is only needed to facilitate string allocation.
-    StringPool ResourceNamesPool;
-    Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize, ResourceNamesPool);
+size_t SPIRVReflection::GetDeclaredStructSize(uint32_t StructId) const noexcept(false)
+{
+    // Follows diligent_spirv_cross::Compiler::get_declared_struct_size()
+    const uint32_t* pStruct    = GetTypeDefinition(StructId, spv::OpTypeStruct);
+    const uint32_t  NumMembers = (pStruct[0] >> spv::WordCountShift) - 2;
+    if (NumMembers == 0)
+        LOG_ERROR_AND_THROW("Declared struct in block cannot be empty");
+
+    // Offsets can be declared out of order, so find the member with the highest offset
+    uint32_t LastMember    = 0;
+    uint32_t HighestOffset = 0;
+    for (uint32_t i = 0; i < NumMembers; ++i)
+    {
+        uint32_t MemberOffset = 0;
+        if (!FindMemberDecoration(StructId, i, spv::DecorationOffset, &MemberOffset))
+            LOG_ERROR_AND_THROW("Member ", i, " of struct '", GetName(StructId), "' does not have Offset decoration");
 
-    // Uniform buffer reflections
-    std::vector<ShaderCodeBufferDescX> UBReflections;
+        if (MemberOffset > HighestOffset)
+        {
+            HighestOffset = MemberOffset;
+            LastMember    = i;
+        }
+    }
+
+    return size_t{HighestOffset} + GetDeclaredStructMemberSize(StructId, LastMember);
+}
+
+size_t SPIRVReflection::GetDeclaredStructMemberSize(uint32_t StructId, uint32_t Member) const noexcept(false)
+{
+    // Follows diligent_spirv_cross::Compiler::get_declared_struct_member_size()
+    const uint32_t* pStruct      = GetTypeDefinition(StructId, spv::OpTypeStruct);
+    const uint32_t  MemberTypeId = pStruct[2 + Member];
+
+    spv::Op         OpCode = spv::OpNop;
+    const uint32_t* pType  = GetDefinition(MemberTypeId, &OpCode);
+    if (pType == nullptr)
+        LOG_ERROR_AND_THROW("Unable to find the type of member ", Member, " of struct '", GetName(StructId), "'");
+
+    auto GetScalarSize = [&](uint32_t ScalarTypeId) -> size_t {
+        spv::Op         ScalarOpCode = spv::OpNop;
+        const uint32_t* pScalar      = GetDefinition(ScalarTypeId, &ScalarOpCode);
+        if (pScalar == nullptr || (ScalarOpCode != spv::OpTypeInt && ScalarOpCode != spv::OpTypeFloat))
+            LOG_ERROR_AND_THROW("Querying size for object with opaque size");
+        return pScalar[2] / 8;
+    };
 
+    switch (OpCode)
     {
-        Uint32 CurrUB = 0;
-        for (const auto& UB : resources.uniform_buffers)
+        case spv::OpTypeArray:
+        case spv::OpTypeRuntimeArray:
         {
-            const auto& name = GetUBName(Compiler, UB, ParsedIRSource);
-            const auto& Type = Compiler.get_type(UB.type_id);
-            const auto  Size = Compiler.get_declared_struct_size(Type);
-            new (&GetUB(CurrUB++)) SPIRVShaderResourceAttribs //
-                {
-                    Compiler,
-                    UB,
-                    ResourceNamesPool.CopyString(name),
-                    SPIRVShaderResourceAttribs::ResourceType::UniformBuffer,
-                    static_cast<Uint32>(Size) //
-                };
+            const IdInfo& ArrayInfo = m_Ids[MemberTypeId];
+            if ((ArrayInfo.Flags & DECORATION_FLAG_HAS_ARRAY_STRIDE) == 0)
+                LOG_ERROR_AND_THROW("Member ", Member, " of struct '", GetName(StructId), "' does not have ArrayStride decoration");
 
-            if (LoadUniformBufferReflection)
-            {
-                UBReflections.emplace_back(LoadUBReflection(Compiler, UB, m_IsHLSLSource));
-            }
+            uint32_t ArraySize = 0;
+            if (OpCode == spv::OpTypeArray && !EvaluateConstant(pType[3], ArraySize))
+                LOG_ERROR_AND_THROW("Unable to evaluate the array size of member ", Member, " of struct '", GetName(StructId), "'");
+
+            return size_t{ArrayInfo.ArrayStride} * ArraySize;
         }
-        VERIFY_EXPR(CurrUB == GetNumUBs());
+
+        case spv::OpTypeStruct:
+            return GetDeclaredStructSize(MemberTypeId);
+
+        case spv::OpTypePointer:
+            // Physical storage buffer pointer
+            return 8;
+
+        case spv::OpTypeInt:
+        case spv::OpTypeFloat:
+            return GetScalarSize(MemberTypeId);
+
+        case spv::OpTypeVector:
+            return GetScalarSize(pType[2]) * pType[3];
+
+        case spv::OpTypeMatrix:
+        {
+            const uint32_t* pColumnType  = GetTypeDefinition(pType[2], spv::OpTypeVector);
+            const uint32_t  NumRows      = pColumnType[3];
+            const uint32_t  NumColumns   = pType[3];
+            uint32_t        MatrixStride = 0;
+            if (!FindMemberDecoration(StructId, Member, spv::DecorationMatrixStride, &MatrixStride))
+                LOG_ERROR_AND_THROW("Member ", Member, " of struct '", GetName(StructId), "' does not have MatrixStride decoration");
+
+            if (FindMemberDecoration(StructId, Member, spv::DecorationRowMajor))
+                return size_t{MatrixStride} * NumRows;
+            else if (FindMemberDecoration(StructId, Member, spv::DecorationColMajor))
+                return size_t{MatrixStride} * NumColumns;
+            else
+                LOG_ERROR_AND_THROW("Either row-major or column-major must be declared for matrices");
+        }
+
+        default:
+            LOG_ERROR_AND_THROW("Querying size for object with opaque size");
     }
+}
 
+bool SPIRVReflection::IsSSBOInstanceNameSignificant() const
+{
+    // Follows diligent_spirv_cross::Compiler::reflection_ssbo_instance_name_is_significant()
+    if (m_IsSourceKnown)
+    {
+        // UAVs from HLSL source tend to be declared in a way where the type is reused,
+        // but the instance name is significant.
+        return m_IsHLSLSource;
+    }
+
+    // If the block type is shared by several storage buffers, assume HLSL-style UAV declarations
+    std::vector<uint32_t> SSBOTypes;
+    for (uint32_t VarOffset : m_Variables)
     {
-        Uint32 CurrSB = 0;
-        for (const auto& SB : resources.storage_buffers)
+        const uint32_t* pVar         = &m_SPIRV[VarOffset];
+        const uint32_t  StorageClass = pVar[3];
+
+        spv::Op         OpCode   = spv::OpNop;
+        const uint32_t* pPtrType = GetDefinition(pVar[1], &OpCode);
+        if (pPtrType == nullptr || OpCode != spv::OpTypePointer)
+            continue;
+
+        uint32_t TypeId = pPtrType[3];
+        while (const uint32_t* pType = GetDefinition(TypeId, &OpCode))
         {
-            auto BufferFlags = Compiler.get_buffer_block_flags(SB.id);
-            auto IsReadOnly  = BufferFlags.get(spv::DecorationNonWritable);
-            auto ResType     = IsReadOnly ?
-                SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer :
-                SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer;
-            const auto& Type   = Compiler.get_type(SB.type_id);
-            const auto  Size   = Compiler.get_declared_struct_size(Type);
-            const auto  Stride = Compiler.get_declared_struct_size_runtime_array(Type, 1) - Size;
-            new (&GetSB(CurrSB++)) SPIRVShaderResourceAttribs //
-                {
-                    Compiler,
-                    SB,
-                    ResourceNamesPool.CopyString(SB.name),
-                    ResType,
-                    static_cast<Uint32>(Size),
-                    static_cast<Uint32>(Stride) //
-                };
+            if (OpCode != spv::OpTypeArray && OpCode != spv::OpTypeRuntimeArray)
+                break;
+            TypeId = pType[2];
         }
-        VERIFY_EXPR(CurrSB == GetNumSBs());
+
+        const IdInfo* pTypeInfo = FindIdInfo(TypeId);
+        const bool    IsSSBO =
+            StorageClass == spv::StorageClassStorageBuffer ||
+            (StorageClass == spv::StorageClassUniform && pTypeInfo != nullptr && (pTypeInfo->Flags & DECORATION_FLAG_BUFFER_BLOCK) != 0);
+        if (!IsSSBO)
+            continue;
+
+        if (std::find(SSBOTypes.begin(), SSBOTypes.end(), TypeId) != SSBOTypes.end())
+            return true;
+        SSBOTypes.push_back(TypeId);
     }
 
+    return false;
+}
+
+SPIRVReflection::ShaderResources SPIRVReflection::GetShaderResources(const EntryPointInfo& EntryPoint) const noexcept(false)
+{
+    const uint32_t* const pInterfaceBegin     = &m_SPIRV[EntryPoint.InterfaceOffset];
+    const uint32_t* const pInterfaceEnd       = pInterfaceBegin + EntryPoint.NumInterfaceIds;
+    auto                  IsInterfaceVariable = [&](uint32_t VarId) {
+        return std::find(pInterfaceBegin, pInterfaceEnd, VarId) != pInterfaceEnd;
+    };
+
+    // In SPIR-V 1.4 and up, every global variable used by the entry point must be
+    // present in its interface list, not just inputs and outputs.
+    const bool AllGlobalsInInterface = m_Version >= 0x10400;
+
+    const bool SSBOInstanceName = IsSSBOInstanceNameSignificant();
+
+    ShaderResources Resources;
+    for (uint32_t VarOffset : m_Variables)
     {
-        Uint32 CurrSmplImg = 0;
-        for (const auto& SmplImg : resources.sampled_images)
+        const uint32_t* pVar         = &m_SPIRV[VarOffset];
+        const uint32_t  VarId        = pVar[2];
+        const uint32_t  StorageClass = pVar[3];
+        if (StorageClass == spv::StorageClassFunction)
+            continue;
+
+        if ((AllGlobalsInInterface || StorageClass == spv::StorageClassInput || StorageClass == spv::StorageClassOutput) && !IsInterfaceVariable(VarId))
+            continue;
+
+        // Strip the pointer and the arrays
+        const uint32_t* pPtrType = GetTypeDefinition(pVar[1], spv::OpTypePointer);
+
+        uint32_t TypeId        = pPtrType[3];
+        uint32_t NumArrayDims  = 0;
+        uint32_t InnermostSize = 1;
+        spv::Op  OpCode        = spv::OpNop;
+        for (const uint32_t* pType = GetDefinition(TypeId, &OpCode); pType != nullptr; pType = GetDefinition(TypeId, &OpCode))
+        {
+            if (OpCode == spv::OpTypeArray)
+            {
+                if (!EvaluateConstant(pType[3], InnermostSize))
+                    LOG_ERROR_AND_THROW("Unable to evaluate the array size of variable '", GetName(VarId), "'");
+            }
+            else if (OpCode == spv::OpTypeRuntimeArray)
+            {
+                InnermostSize = 0;
+            }
+            else
+            {
+                break;
+            }
+
+            ++NumArrayDims;
+            TypeId = pType[2];
+        }
+
+        const uint32_t* pType = GetDefinition(TypeId, &OpCode);
+        if (pType == nullptr)
+            continue;
+
+        const IdInfo& VarInfo  = m_Ids[VarId];
+        const IdInfo& TypeInfo = m_Ids[TypeId];
+        if ((VarInfo.Flags & DECORATION_FLAG_BUILT_IN) != 0 || (TypeInfo.Flags & DECORATION_FLAG_MEMBER_BUILT_IN) != 0)
+            continue;
+
+        if (StorageClass == spv::StorageClassInput)
+        {
+            Resources.StageInputs.emplace_back(StageInputInfo{VarId, GetName(VarId), VarInfo.HLSLSemantic, VarInfo.LocationOffset});
+            continue;
+        }
+        else if (StorageClass == spv::StorageClassOutput)
         {
-            const auto& type    = Compiler.get_type(SmplImg.type_id);
-            auto        ResType = type.image.dim == spv::DimBuffer ?
+            continue;
+        }
+
+        // Image type declaration of images and sampled images
+        const uint32_t* pImage = nullptr;
+        if (OpCode == spv::OpTypeImage)
+            pImage = pType;
+        else if (OpCode == spv::OpTypeSampledImage)
+            pImage = GetTypeDefinition(pType[2], spv::OpTypeImage);
+
+        ResourceInfo Res;
+        Res.VarId = VarId;
+
+        std::vector<ResourceInfo>* pResources = nullptr;
+        if (StorageClass == spv::StorageClassUniformConstant && pImage != nullptr && pImage[3] == spv::DimSubpassData)
+        {
+            Res.Type   = SPIRVShaderResourceAttribs::ResourceType::InputAttachment;
+            pResources = &Resources.SubpassInputs;
+        }
+        else if (StorageClass == spv::StorageClassUniform && (TypeInfo.Flags & DECORATION_FLAG_BLOCK) != 0)
+        {
+            Res.Type   = SPIRVShaderResourceAttribs::ResourceType::UniformBuffer;
+            pResources = &Resources.UniformBuffers;
+
+            // Consider the following HLSL constant buffer:
+            //
+            //    cbuffer Constants
+            //    {
+            //        float4x4 g_WorldViewProj;
+            //    };
+            //
+            // glslang emits SPIRV as if the following GLSL was written:
+            //
+            //    uniform Constants // block name
+            //    {
+            //        float4x4 g_WorldViewProj;
+            //    }; // no instance name
+            //
+            // DXC emits the byte code that corresponds to the following GLSL:
+            //
+            //    uniform type_Constants // block name
+            //    {
+            //        float4x4 g_WorldViewProj;
+            //    }Constants; // instance name
+            //
+            //
+            //                  |     glslang      |         DXC
+            //  ----------------------------------------------------------
+            //  block name      |   "Constants"    |   "type_Constants"
+            //  instance name   |   ""             |   "Constants"
+            //
+            // Note that for the byte code produced from GLSL, we must always
+            // use the block name even if the instance name is present
+            const char* InstanceName = GetName(VarId);
+            Res.Name                 = (m_IsHLSLSource && *InstanceName != '\0') ? std::string{InstanceName} : GetBlockName(VarId, TypeId, false);
+            Res.BufferStaticSize     = StaticCast<Uint32>(GetDeclaredStructSize(TypeId));
+        }
+        else if ((StorageClass == spv::StorageClassUniform && (TypeInfo.Flags & DECORATION_FLAG_BUFFER_BLOCK) != 0) ||
+                 StorageClass == spv::StorageClassStorageBuffer)
+        {
+            const uint32_t NumMembers = OpCode == spv::OpTypeStruct ? (pType[0] >> spv::WordCountShift) - 2 : 0;
+
+            // The buffer is read-only if the variable is decorated with NonWritable, or all members of the struct are.
+            bool IsReadOnly = (VarInfo.Flags & DECORATION_FLAG_NON_WRITABLE) != 0;
+            if (!IsReadOnly && NumMembers > 0)
+            {
+                IsReadOnly = true;
+                for (uint32_t i = 0; i < NumMembers && IsReadOnly; ++i)
+                    IsReadOnly = FindMemberDecoration(TypeId, i, spv::DecorationNonWritable);
+            }
+            Res.Type = IsReadOnly ?
+                SPIRVShaderResourceAttribs::ResourceType::ROStorageBuffer :
+                SPIRVShaderResourceAttribs::ResourceType::RWStorageBuffer;
+            pResources = &Resources.StorageBuffers;
+
+            Res.Name             = GetBlockName(VarId, TypeId, SSBOInstanceName);
+            Res.BufferStaticSize = StaticCast<Uint32>(GetDeclaredStructSize(TypeId));
+
+            // The stride of the runtime array that is declared as the last member
+            spv::Op LastMemberOpCode = spv::OpNop;
+            GetDefinition(pType[2 + NumMembers - 1], &LastMemberOpCode);
+            if (LastMemberOpCode == spv::OpTypeRuntimeArray)
+                Res.BufferStride = m_Ids[pType[2 + NumMembers - 1]].ArrayStride;
+        }
+        else if (StorageClass == spv::StorageClassAtomicCounter)
+        {
+            Res.Type   = SPIRVShaderResourceAttribs::ResourceType::AtomicCounter;
+            pResources = &Resources.AtomicCounters;
+        }
+        else if (StorageClass == spv::StorageClassUniformConstant && OpCode == spv::OpTypeImage)
+        {
+            // The Sampled operand is 2 for storage images and 1 for separate images
+            if (pImage[7] == 2)
+            {
+                Res.Type = pImage[3] == spv::DimBuffer ?
+                    SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer :
+                    SPIRVShaderResourceAttribs::ResourceType::StorageImage;
+                pResources = &Resources.StorageImages;
+            }
+            else if (pImage[7] == 1)
+            {
+                Res.Type = pImage[3] == spv::DimBuffer ?
+                    SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
+                    SPIRVShaderResourceAttribs::ResourceType::SeparateImage;
+                pResources = &Resources.SeparateImages;
+            }
+        }
+        else if (StorageClass == spv::StorageClassUniformConstant && OpCode == spv::OpTypeSampler)
+        {
+            Res.Type   = SPIRVShaderResourceAttribs::ResourceType::SeparateSampler;
+            pResources = &Resources.SeparateSamplers;
+        }
+        else if (StorageClass == spv::StorageClassUniformConstant && OpCode == spv::OpTypeSampledImage)
+        {
+            Res.Type = pImage[3] == spv::DimBuffer ?
                 SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
                 SPIRVShaderResourceAttribs::ResourceType::SampledImage;
-            new (&GetSmpldImg(CurrSmplImg++)) SPIRVShaderResourceAttribs //
-                {
-                    Compiler,
-                    SmplImg,
-                    ResourceNamesPool.CopyString(SmplImg.name),
-                    ResType //
-                };
+            pResources = &Resources.SampledImages;
+        }
+        else if (StorageClass == spv::StorageClassUniformConstant && OpCode == spv::OpTypeAccelerationStructureKHR)
+        {
+            Res.Type   = SPIRVShaderResourceAttribs::ResourceType::AccelerationStructure;
+            pResources = &Resources.AccelerationStructures;
         }
-        VERIFY_EXPR(CurrSmplImg == GetNumSmpldImgs());
+        // Push constants are not reflected
+
+        if (pResources == nullptr)
+            continue;
+
+        if (Res.Name.empty())
+            Res.Name = GetName(VarId);
+
+        // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide#querying-array-types
+        VERIFY(NumArrayDims <= 1, "Only one-dimensional arrays are currently supported");
+        VERIFY(InnermostSize <= std::numeric_limits<Uint16>::max(), "Array size exceeds maximum representable value ", std::numeric_limits<Uint16>::max());
+        Res.ArraySize = static_cast<Uint16>(InnermostSize);
+
+        if (pImage != nullptr)
+        {
+            const bool IsArrayed = pImage[5] != 0;
+            switch (pImage[3])
+            {
+                // clang-format off
+                case spv::Dim1D:     Res.ResourceDim = IsArrayed ? RESOURCE_DIM_TEX_1D_ARRAY   : RESOURCE_DIM_TEX_1D;   break;
+                case spv::Dim2D:     Res.ResourceDim = IsArrayed ? RESOURCE_DIM_TEX_2D_ARRAY   : RESOURCE_DIM_TEX_2D;   break;
+                case spv::Dim3D:     Res.ResourceDim = RESOURCE_DIM_TEX_3D;                                           break;
+                case spv::DimCube:   Res.ResourceDim = IsArrayed ? RESOURCE_DIM_TEX_CUBE_ARRAY : RESOURCE_DIM_TEX_CUBE; break;
+                case spv::DimBuffer: Res.ResourceDim = RESOURCE_DIM_BUFFER;                                           break;
+                // clang-format on
+                default: Res.ResourceDim = RESOURCE_DIM_UNDEFINED;
+            }
+            Res.IsMS = pImage[6] != 0;
+        }
+
+        VERIFY(VarInfo.BindingOffset != 0, "Resource '", Res.Name, "' has no binding decoration");
+        VERIFY(VarInfo.DescriptorSetOffset != 0, "Resource '", Res.Name, "' has no descriptor set decoration");
+        Res.BindingDecorationOffset       = VarInfo.BindingOffset;
+        Res.DescriptorSetDecorationOffset = VarInfo.DescriptorSetOffset;
+
+        pResources->emplace_back(std::move(Res));
     }
 
+    return Resources;
+}
+
+std::array<Uint32, 3> SPIRVReflection::GetLocalSize(const EntryPointInfo& EntryPoint) const
+{
+    std::array<Uint32, 3> LocalSize = {};
+    for (uint32_t ModeOffset : m_ExecutionModes)
     {
-        Uint32 CurrImg = 0;
-        for (const auto& Img : resources.storage_images)
+        const uint32_t* pMode     = &m_SPIRV[ModeOffset];
+        const uint32_t  WordCount = pMode[0] >> spv::WordCountShift;
+        if (pMode[1] != EntryPoint.FunctionId || WordCount < 6)
+            continue;
+
+        if (pMode[2] == spv::ExecutionModeLocalSize)
         {
-            const auto& type    = Compiler.get_type(Img.type_id);
-            auto        ResType = type.image.dim == spv::DimBuffer ?
-                SPIRVShaderResourceAttribs::ResourceType::StorageTexelBuffer :
-                SPIRVShaderResourceAttribs::ResourceType::StorageImage;
-            new (&GetImg(CurrImg++)) SPIRVShaderResourceAttribs //
-                {
-                    Compiler,
-                    Img,
-                    ResourceNamesPool.CopyString(Img.name),
-                    ResType //
-                };
+            for (size_t i = 0; i < LocalSize.size(); ++i)
+                LocalSize[i] = pMode[3 + i];
+        }
+        else if (pMode[2] == spv::ExecutionModeLocalSizeId)
+        {
+            for (size_t i = 0; i < LocalSize.size(); ++i)
+                EvaluateConstant(pMode[3 + i], LocalSize[i]);
         }
-        VERIFY_EXPR(CurrImg == GetNumImgs());
     }
+    return LocalSize;
+}
 
+// Loads the uniform buffer member layouts, which are not covered by SPIRVReflection, using SPIRV-Cross.
+std::vector<ShaderCodeBufferDescX> LoadUBReflections(std::vector<uint32_t>                             SPIRV,
+                                                     const std::string&                                EntryPoint,
+                                                     spv::ExecutionModel                               ExecutionModel,
+                                                     const std::vector<SPIRVReflection::ResourceInfo>& UBs,
+                                                     bool                                              IsHLSLSource) noexcept(false)
+{
+    // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide
+    diligent_spirv_cross::Parser parser{std::move(SPIRV)};
+    parser.parse();
+    diligent_spirv_cross::Compiler Compiler{std::move(parser.get_parsed_ir())};
+    Compiler.set_entry_point(EntryPoint, ExecutionModel);
+
+    const diligent_spirv_cross::ShaderResources resources = Compiler.get_shader_resources();
+
+    std::vector<ShaderCodeBufferDescX> UBReflections;
+    UBReflections.reserve(UBs.size());
+    for (const SPIRVReflection::ResourceInfo& UB : UBs)
     {
-        Uint32 CurrAC = 0;
-        for (const auto& AC : resources.atomic_counters)
+        auto it = std::find_if(resources.uniform_buffers.begin(), resources.uniform_buffers.end(),
+                               [&UB](const diligent_spirv_cross::Resource& Res) { return static_cast<uint32_t>(Res.id) == UB.VarId; });
+        if (it != resources.uniform_buffers.end())
         {
-            new (&GetAC(CurrAC++)) SPIRVShaderResourceAttribs //
-                {
-                    Compiler,
-                    AC,
-                    ResourceNamesPool.CopyString(AC.name),
-                    SPIRVShaderResourceAttribs::ResourceType::AtomicCounter //
-                };
+            UBReflections.emplace_back(LoadUBReflection(Compiler, *it, IsHLSLSource));
+        }
+        else
+        {
+            UNEXPECTED("Uniform buffer '", UB.Name, "' is not found by SPIRV-Cross");
+            ShaderCodeBufferDescX UBDesc;
+            UBDesc.Size = UB.BufferStaticSize;
+            UBReflections.emplace_back(std::move(UBDesc));
         }
-        VERIFY_EXPR(CurrAC == GetNumACs());
     }
+    return UBReflections;
+}
 
+} // namespace
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&            Allocator,
+                                           const std::vector<uint32_t>& spirv_binary,
+                                           const ShaderDesc&            shaderDesc,
+                                           const char*                  CombinedSamplerSuffix,
+                                           bool                         LoadShaderStageInputs,
+                                           bool                         LoadUniformBufferReflection,
+                                           std::string&                 EntryPoint) noexcept(false) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    const SPIRVReflection Reflection{spirv_binary};
+    m_IsHLSLSource = Reflection.IsHLSLSource();
+
+    spv::ExecutionModel                    ExecutionModel = ShaderTypeToSpvExecutionModel(shaderDesc.ShaderType);
+    const SPIRVReflection::EntryPointInfo* pEntryPoint    = nullptr;
+    for (const auto& CurrEntryPoint : Reflection.GetEntryPoints())
     {
-        Uint32 CurrSepSmpl = 0;
-        for (const auto& SepSam : resources.separate_samplers)
+        if (CurrEntryPoint.ExecutionModel == ExecutionModel)
         {
-            new (&GetSepSmplr(CurrSepSmpl++)) SPIRVShaderResourceAttribs //
-                {
-                    Compiler,
-                    SepSam,
-                    ResourceNamesPool.CopyString(SepSam.name),
-                    SPIRVShaderResourceAttribs::ResourceType::SeparateSampler //
-                };
+            if (pEntryPoint != nullptr)
+            {
+                LOG_WARNING_MESSAGE("More than one entry point of type ", GetShaderTypeLiteralName(shaderDesc.ShaderType), " found in SPIRV binary for shader '", shaderDesc.Name, "'. The first one ('", EntryPoint, "') will be used.");
+            }
+            else
+            {
+                pEntryPoint = &CurrEntryPoint;
+                EntryPoint  = CurrEntryPoint.Name;
+            }
         }
-        VERIFY_EXPR(CurrSepSmpl == GetNumSepSmplrs());
+    }
+    if (pEntryPoint == nullptr)
+    {
+        LOG_ERROR_AND_THROW("Unable to find entry point of type ", GetShaderTypeLiteralName(shaderDesc.ShaderType), " in SPIRV binary for shader '", shaderDesc.Name, "'");
     }
 
+    SPIRVReflection::ShaderResources resources = Reflection.GetShaderResources(*pEntryPoint);
+
+    size_t ResourceNamesPoolSize = 0;
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please account for the new resource type below");
+    for (auto* pResType :
+         {
+             &resources.UniformBuffers,
+             &resources.StorageBuffers,
+             &resources.StorageImages,
+             &resources.SampledImages,
+             &resources.AtomicCounters,
+             &resources.SeparateImages,
+             &resources.SeparateSamplers,
+             &resources.SubpassInputs,
+             &resources.AccelerationStructures //
+         })                                    //
     {
-        Uint32 CurrSepImg = 0;
-        for (const auto& SepImg : resources.separate_images)
-        {
-            const auto& type    = Compiler.get_type(SepImg.type_id);
-            const auto  ResType = type.image.dim == spv::DimBuffer ?
-                SPIRVShaderResourceAttribs::ResourceType::UniformTexelBuffer :
-                SPIRVShaderResourceAttribs::ResourceType::SeparateImage;
+        for (const auto& res : *pResType)
+            ResourceNamesPoolSize += res.Name.length() + 1;
+    }
 
-            new (&GetSepImg(CurrSepImg++)) SPIRVShaderResourceAttribs //
-                {
-                    Compiler,
-                    SepImg,
-                    ResourceNamesPool.CopyString(SepImg.name),
-                    ResType //
-                };
-        }
-        VERIFY_EXPR(CurrSepImg == GetNumSepImgs());
+    if (CombinedSamplerSuffix != nullptr)
+    {
+        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
     }
 
+    VERIFY_EXPR(shaderDesc.Name != nullptr);
+    ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
+
+    Uint32 NumShaderStageInputs = 0;
+
+    if (!m_IsHLSLSource || resources.StageInputs.empty())
+        LoadShaderStageInputs = false;
+    if (LoadShaderStageInputs)
     {
-        Uint32 CurrSubpassInput = 0;
-        for (const auto& SubpassInput : resources.subpass_inputs)
+        if (Reflection.UsesHlslFunctionality1())
         {
-            new (&GetInptAtt(CurrSubpassInput++)) SPIRVShaderResourceAttribs //
+            for (const auto& Input : resources.StageInputs)
+            {
+                if (Input.Semantic != nullptr)
                 {
-                    Compiler,
-                    SubpassInput,
-                    ResourceNamesPool.CopyString(SubpassInput.name),
-                    SPIRVShaderResourceAttribs::ResourceType::InputAttachment //
-                };
+                    ResourceNamesPoolSize += strlen(Input.Semantic) + 1;
+                    ++NumShaderStageInputs;
+                }
+                else
+                {
+                    LOG_ERROR_MESSAGE("Shader input '", Input.Name, "' does not have DecorationHlslSemanticGOOGLE decoration, which is unexpected as the shader declares SPV_GOOGLE_hlsl_functionality1 extension");
+                }
+            }
+        }
+        else
+        {
+            LoadShaderStageInputs = false;
+            if (m_IsHLSLSource)
+            {
+                LOG_WARNING_MESSAGE("SPIRV byte code of shader '", shaderDesc.Name,
+                                    "' does not use SPV_GOOGLE_hlsl_functionality1 extension. "
+                                    "As a result, it is not possible to get semantics of shader inputs and map them to proper locations. "
+                                    "The shader will still work correctly if all attributes are declared in ascending order without any gaps. "
+                                    "Enable SPV_GOOGLE_hlsl_functionality1 in your compiler to allow proper mapping of vertex shader inputs.");
+            }
         }
-        VERIFY_EXPR(CurrSubpassInput == GetNumInptAtts());
     }
 
-    {
-        Uint32 CurrAccelStruct = 0;
-        for (const auto& AccelStruct : resources.acceleration_structures)
+    ResourceCounters ResCounters;
+    ResCounters.NumUBs          = static_cast<Uint32>(resources.UniformBuffers.size());
+    ResCounters.NumSBs          = static_cast<Uint32>(resources.StorageBuffers.size());
+    ResCounters.NumImgs         = static_cast<Uint32>(resources.StorageImages.size());
+    ResCounters.NumSmpldImgs    = static_cast<Uint32>(resources.SampledImages.size());
+    ResCounters.NumACs          = static_cast<Uint32>(resources.AtomicCounters.size());
+    ResCounters.NumSepSmplrs    = static_cast<Uint32>(resources.SeparateSamplers.size());
+    ResCounters.NumSepImgs      = static_cast<Uint32>(resources.SeparateImages.size());
+    ResCounters.NumInptAtts     = static_cast<Uint32>(resources.SubpassInputs.size());
+    ResCounters.NumAccelStructs = static_cast<Uint32>(resources.AccelerationStructures.size());
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please set the new resource type counter here");
+
+    // Resource names pool is only needed to facilitate string allocation.
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize, ResourceNamesPool);
+
+    auto InitResources = [&ResourceNamesPool](const std::vector<SPIRVReflection::ResourceInfo>& Resources, Uint32 NumResources, auto GetAttribs) {
+        VERIFY_EXPR(Resources.size() == NumResources);
+        for (Uint32 i = 0; i < NumResources; ++i)
         {
-            new (&GetAccelStruct(CurrAccelStruct++)) SPIRVShaderResourceAttribs //
+            const auto& Res = Resources[i];
+            new (&GetAttribs(i)) SPIRVShaderResourceAttribs //
                 {
-                    Compiler,
-                    AccelStruct,
-                    ResourceNamesPool.CopyString(AccelStruct.name),
-                    SPIRVShaderResourceAttribs::ResourceType::AccelerationStructure //
+                    ResourceNamesPool.CopyString(Res.Name),
+                    Res.Type,
+                    Res.ArraySize,
+                    Res.ResourceDim,
+                    Res.IsMS,
+                    Res.BindingDecorationOffset,
+                    Res.DescriptorSetDecorationOffset,
+                    Res.BufferStaticSize,
+                    Res.BufferStride //
                 };
         }
-        VERIFY_EXPR(CurrAccelStruct == GetNumAccelStructs());
-    }
+    };
 
+    // clang-format off
+    InitResources(resources.UniformBuffers,         GetNumUBs(),          [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetUB(n);          });
+    InitResources(resources.StorageBuffers,         GetNumSBs(),          [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetSB(n);          });
+    InitResources(resources.SampledImages,          GetNumSmpldImgs(),    [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetSmpldImg(n);    });
+    InitResources(resources.StorageImages,          GetNumImgs(),         [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetImg(n);         });
+    InitResources(resources.AtomicCounters,         GetNumACs(),          [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetAC(n);          });
+    InitResources(resources.SeparateSamplers,       GetNumSepSmplrs(),    [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetSepSmplr(n);    });
+    InitResources(resources.SeparateImages,         GetNumSepImgs(),      [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetSepImg(n);      });
+    InitResources(resources.SubpassInputs,          GetNumInptAtts(),     [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetInptAtt(n);     });
+    InitResources(resources.AccelerationStructures, GetNumAccelStructs(), [this](Uint32 n) -> SPIRVShaderResourceAttribs& { return GetAccelStruct(n); });
+    // clang-format on
     static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please initialize SPIRVShaderResourceAttribs for the new resource type here");
 
     if (CombinedSamplerSuffix != nullptr)
@@ -687,15 +1290,15 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
     if (LoadShaderStageInputs)
     {
         Uint32 CurrStageInput = 0;
-        for (const auto& Input : resources.stage_inputs)
+        for (const auto& Input : resources.StageInputs)
         {
-            if (Compiler.has_decoration(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE))
+            if (Input.Semantic != nullptr)
             {
-                const auto& Semantic = Compiler.get_decoration_string(Input.id, spv::Decoration::DecorationHlslSemanticGOOGLE);
+                VERIFY(Input.LocationDecorationOffset != 0, "Shader input '", Input.Name, "' has no location decoration");
                 new (&GetShaderStageInputAttribs(CurrStageInput++)) SPIRVShaderStageInputAttribs //
                     {
-                        ResourceNamesPool.CopyString(Semantic),
-                        GetDecorationOffset(Compiler, Input, spv::Decoration::DecorationLocation) //
+                        ResourceNamesPool.CopyString(Input.Semantic),
+                        Input.LocationDecorationOffset //
                     };
             }
         }
@@ -706,13 +1309,13 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
 
     if (shaderDesc.ShaderType == SHADER_TYPE_COMPUTE)
     {
-        for (uint32_t i = 0; i < m_ComputeGroupSize.size(); ++i)
-            m_ComputeGroupSize[i] = Compiler.get_execution_mode_argument(spv::ExecutionModeLocalSize, i);
+        m_ComputeGroupSize = Reflection.GetLocalSize(*pEntryPoint);
     }
 
-    if (!UBReflections.empty())
+    // SPIRV-Cross is only used to load the uniform buffer member layouts
+    if (LoadUniformBufferReflection && !resources.UniformBuffers.empty())
     {
-        VERIFY_EXPR(LoadUniformBufferReflection);
+        std::vector<ShaderCodeBufferDescX> UBReflections = LoadUBReflections(spirv_binary, EntryPoint, ExecutionModel, resources.UniformBuffers, m_IsHLSLSource);
         VERIFY_EXPR(UBReflections.size() == GetNumUBs());
         m_UBReflectionBuffer = ShaderCodeBufferDescX::PackArray(UBReflections.cbegin(), UBReflections.cend(), GetRawAllocator());
     }
@@ -25,7 +25,14 @@
  */
 
 #include "SPIRVTools.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
 #include "DebugUtilities.hpp"
+#include "HashUtils.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 #include "spirv-tools/optimizer.hpp"
 
@@ -105,15 +112,211 @@ spv_target_env SpvTargetEnvFromSPIRV(const std::vector<uint32_t>& SPIRV)
     }
 }
 
+class SPIRVOptimizationCache
+{
+public:
+    static SPIRVOptimizationCache& GetInstance()
+    {
+        static SPIRVOptimizationCache Cache;
+        return Cache;
+    }
+
+    bool IsEnabled()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_MaxSize != 0;
+    }
+
+    void SetMaxSize(size_t MaxSize)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_MaxSize = MaxSize;
+        if (m_MaxSize == 0)
+        {
+            m_Map.clear();
+            m_Entries.clear();
+            m_Stats = {};
+        }
+        else
+        {
+            EvictEntries();
+        }
+    }
+
+    bool Find(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes, std::vector<uint32_t>& OptimizedSPIRV)
+    {
+        const Key SrcKey{SrcSPIRV, TargetEnv, Passes};
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Map.find(SrcKey);
+        if (it == m_Map.end())
+        {
+            ++m_Stats.NumMisses;
+            return false;
+        }
+
+        // Move the entry to the front of the LRU list
+        m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+        OptimizedSPIRV = it->second->OptimizedSPIRV;
+        ++m_Stats.NumHits;
+        return true;
+    }
+
+    void Add(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes, const std::vector<uint32_t>& OptimizedSPIRV)
+    {
+        const size_t EntrySize = (SrcSPIRV.size() + OptimizedSPIRV.size()) * sizeof(uint32_t);
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (EntrySize > m_MaxSize)
+            return;
+
+        // The key references the source bytecode owned by the list entry,
+        // which does not move when the list is reordered.
+        m_Entries.emplace_front(SrcSPIRV, TargetEnv, Passes, OptimizedSPIRV);
+        if (!m_Map.emplace(m_Entries.front().GetKey(), m_Entries.begin()).second)
+        {
+            // Another thread has added the same bytecode
+            m_Entries.pop_front();
+            return;
+        }
+
+        m_Stats.Size += EntrySize;
+        ++m_Stats.NumEntries;
+        EvictEntries();
+    }
+
+    SPIRVOptimizationCacheStats GetStats()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Stats;
+    }
+
+private:
+    struct Key
+    {
+        Key(const std::vector<uint32_t>& _SPIRV, spv_target_env _TargetEnv, SPIRV_OPTIMIZATION_FLAGS _Passes) :
+            SPIRV{_SPIRV},
+            TargetEnv{_TargetEnv},
+            Passes{_Passes},
+            Hash{ComputeHash(ComputeHashRaw(SPIRV.data(), SPIRV.size() * sizeof(uint32_t)), static_cast<int>(TargetEnv), static_cast<Uint32>(Passes))}
+        {}
+
+        bool operator==(const Key& RHS) const
+        {
+            return Hash == RHS.Hash && TargetEnv == RHS.TargetEnv && Passes == RHS.Passes && SPIRV == RHS.SPIRV;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& K) const
+            {
+                return K.Hash;
+            }
+        };
+
+        const std::vector<uint32_t>&   SPIRV;
+        const spv_target_env           TargetEnv;
+        const SPIRV_OPTIMIZATION_FLAGS Passes;
+        const size_t                   Hash;
+    };
+
+    struct Entry
+    {
+        Entry(const std::vector<uint32_t>& _SrcSPIRV,
+              spv_target_env               TargetEnv,
+              SPIRV_OPTIMIZATION_FLAGS     Passes,
+              const std::vector<uint32_t>& _OptimizedSPIRV) :
+            SrcSPIRV{_SrcSPIRV},
+            OptimizedSPIRV{_OptimizedSPIRV},
+            SrcKey{SrcSPIRV, TargetEnv, Passes}
+        {}
+
+        const std::vector<uint32_t> SrcSPIRV;
+        const std::vector<uint32_t> OptimizedSPIRV;
+
+        // References SrcSPIRV
+        const Key SrcKey;
+
+        const Key& GetKey() const { return SrcKey; }
+
+        size_t GetSize() const
+        {
+            return (SrcSPIRV.size() + OptimizedSPIRV.size()) * sizeof(uint32_t);
+        }
+    };
+    using EntryListType = std::list<Entry>;
+
+    void EvictEntries()
+    {
+        while (m_Stats.Size > m_MaxSize && !m_Entries.empty())
+        {
+            const Entry& LRUEntry = m_Entries.back();
+            m_Map.erase(LRUEntry.GetKey());
+            m_Stats.Size -= LRUEntry.GetSize();
+            --m_Stats.NumEntries;
+            m_Entries.pop_back();
+        }
+    }
+
+private:
+    std::mutex m_Mtx;
+
+    size_t m_MaxSize = 0;
+
+    EntryListType                                                 m_Entries;
+    std::unordered_map<Key, EntryListType::iterator, Key::Hasher> m_Map;
+
+    SPIRVOptimizationCacheStats m_Stats;
+};
+
+std::vector<uint32_t> RunSPIRVOptimizer(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes);
+
 } // namespace
 
 std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
 {
     VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
 
+    ShaderCompilationStageScope Optimize{SHADER_COMPILATION_STAGE_OPTIMIZE};
+
     if (TargetEnv == SPV_ENV_MAX)
         TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
 
+    SPIRVOptimizationCache& Cache = SPIRVOptimizationCache::GetInstance();
+    if (!Cache.IsEnabled())
+        return RunSPIRVOptimizer(SrcSPIRV, TargetEnv, Passes);
+
+    std::vector<uint32_t> OptimizedSPIRV;
+    const bool            CacheHit = Cache.Find(SrcSPIRV, TargetEnv, Passes, OptimizedSPIRV);
+    ShaderCompilationProfiler::AddCacheResult(CacheHit);
+    if (CacheHit)
+        return OptimizedSPIRV;
+
+    // Run the optimizer without holding the lock. If another thread is optimizing the same
+    // bytecode, both threads will produce the same result, and only one will be kept.
+    OptimizedSPIRV = RunSPIRVOptimizer(SrcSPIRV, TargetEnv, Passes);
+    if (!OptimizedSPIRV.empty())
+        Cache.Add(SrcSPIRV, TargetEnv, Passes, OptimizedSPIRV);
+
+    return OptimizedSPIRV;
+}
+
+void SetSPIRVOptimizationCacheSize(size_t MaxSize)
+{
+    SPIRVOptimizationCache::GetInstance().SetMaxSize(MaxSize);
+}
+
+SPIRVOptimizationCacheStats GetSPIRVOptimizationCacheStats()
+{
+    return SPIRVOptimizationCache::GetInstance().GetStats();
+}
+
+namespace
+{
+
+std::vector<uint32_t> RunSPIRVOptimizer(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+{
     spvtools::Optimizer SpirvOptimizer(TargetEnv);
     SpirvOptimizer.SetMessageConsumer(SpvOptimizerMessageConsumer);
 
@@ -124,7 +327,11 @@ std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_t
         SpirvOptimizer.RegisterLegalizationPasses();
     }
 
-    if (Passes & SPIRV_OPTIMIZATION_FLAG_PERFORMANCE)
+    if (Passes & SPIRV_OPTIMIZATION_FLAG_SIZE)
+    {
+        SpirvOptimizer.RegisterSizePasses();
+    }
+    else if (Passes & SPIRV_OPTIMIZATION_FLAG_PERFORMANCE)
     {
         SpirvOptimizer.RegisterPerformancePasses();
     }
@@ -143,4 +350,6 @@ std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_t
     return OptimizedSPIRV;
 }
 
+} // namespace
+
 } // namespace Diligent
@@ -0,0 +1,335 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderPermutationCompiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ShaderToolsCommon.hpp"
+#include "ThreadPool.hpp"
+#include "HashUtils.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+inline bool IsIdentifierChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// Removes comments, collapses white space and collects all identifiers.
+// New lines are preserved as they terminate preprocessor directives.
+std::string NormalizeSource(const char* Src, size_t Length, std::unordered_set<std::string>& Identifiers, bool& HasTokenPasting)
+{
+    std::string Normalized;
+    Normalized.reserve(Length);
+
+    const char* const End = Src + Length;
+
+    // Separator to insert before the next token: 0, ' ' or '\n'
+    char Separator = 0;
+
+    const char* Pos = Src;
+    while (Pos != End)
+    {
+        const char c = *Pos;
+        if (c == '/' && Pos + 1 != End && Pos[1] == '/')
+        {
+            // Single-line comment. The new line is processed as white space.
+            while (Pos != End && *Pos != '\n')
+                ++Pos;
+            continue;
+        }
+
+        if (c == '/' && Pos + 1 != End && Pos[1] == '*')
+        {
+            // Multi-line comment is replaced with a single space, even if it spans multiple lines
+            Pos += 2;
+            while (Pos != End && !(*Pos == '*' && Pos + 1 != End && Pos[1] == '/'))
+                ++Pos;
+            Pos = Pos != End ? Pos + 2 : End;
+            if (Separator == 0)
+                Separator = ' ';
+            continue;
+        }
+
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v')
+        {
+            if (c == '\n')
+                Separator = '\n';
+            else if (Separator == 0)
+                Separator = ' ';
+            ++Pos;
+            continue;
+        }
+
+        if (Separator != 0 && !Normalized.empty())
+            Normalized.push_back(Separator);
+        Separator = 0;
+
+        if (IsIdentifierChar(c))
+        {
+            const char* TokenStart = Pos;
+            while (Pos != End && IsIdentifierChar(*Pos))
+                ++Pos;
+            // Numeric constants start with a digit
+            if (!(*TokenStart >= '0' && *TokenStart <= '9'))
+                Identifiers.emplace(TokenStart, Pos);
+            Normalized.append(TokenStart, Pos);
+        }
+        else if (c == '"')
+        {
+            // Copy the string literal as is
+            const char* TokenStart = Pos++;
+            while (Pos != End && *Pos != '"' && *Pos != '\n')
+            {
+                if (*Pos == '\\' && Pos + 1 != End)
+                    ++Pos;
+                ++Pos;
+            }
+            if (Pos != End && *Pos == '"')
+                ++Pos;
+            Normalized.append(TokenStart, Pos);
+        }
+        else
+        {
+            if (c == '#' && Pos + 1 != End && Pos[1] == '#')
+                HasTokenPasting = true;
+            Normalized.push_back(c);
+            ++Pos;
+        }
+    }
+
+    return Normalized;
+}
+
+void CollectIdentifiers(const char* Str, std::unordered_set<std::string>& Identifiers, bool& HasTokenPasting)
+{
+    if (Str != nullptr)
+        NormalizeSource(Str, strlen(Str), Identifiers, HasTokenPasting);
+}
+
+} // namespace
+
+bool CompileShaderPermutations(const ShaderPermutationCompileInfo& Info, ShaderPermutationCompileResult& Result) noexcept
+{
+    Result = {};
+
+    if (!Info.CompileHandler)
+    {
+        DEV_ERROR("Compile handler must not be null");
+        return false;
+    }
+
+    size_t NumPermutations = 1;
+    for (const ShaderPermutationMacro& Macro : Info.Macros)
+    {
+        if (Macro.Values.empty())
+        {
+            DEV_ERROR("Permutation macro '", Macro.Name, "' has no values");
+            return false;
+        }
+        NumPermutations *= Macro.Values.size();
+    }
+
+    std::string UnrolledSource;
+    try
+    {
+        UnrolledSource = UnrollShaderIncludes(Info.ShaderCI);
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to load the source of shader '", (Info.ShaderCI.Desc.Name != nullptr ? Info.ShaderCI.Desc.Name : ""), "'");
+        return false;
+    }
+
+    std::unordered_set<std::string> Identifiers;
+
+    bool              HasTokenPasting  = false;
+    const std::string NormalizedSource = NormalizeSource(UnrolledSource.data(), UnrolledSource.size(), Identifiers, HasTokenPasting);
+    UnrolledSource.clear();
+
+    for (Uint32 i = 0; i < Info.ShaderCI.Macros.Count; ++i)
+    {
+        CollectIdentifiers(Info.ShaderCI.Macros[i].Name, Identifiers, HasTokenPasting);
+        CollectIdentifiers(Info.ShaderCI.Macros[i].Definition, Identifiers, HasTokenPasting);
+    }
+
+    // Find the macros that may affect the source. A macro referenced by the value of
+    // a relevant macro is also relevant.
+    std::vector<bool> IsRelevant(Info.Macros.size(), false);
+    for (bool Changed = true; Changed;)
+    {
+        Changed = false;
+        for (size_t i = 0; i < Info.Macros.size(); ++i)
+        {
+            if (IsRelevant[i])
+                continue;
+
+            const ShaderPermutationMacro& Macro = Info.Macros[i];
+            if (!HasTokenPasting && Identifiers.find(Macro.Name) == Identifiers.end())
+                continue;
+
+            IsRelevant[i] = true;
+            Changed       = true;
+            for (const std::string& Value : Macro.Values)
+                CollectIdentifiers(Value.c_str(), Identifiers, HasTokenPasting);
+        }
+    }
+
+    for (size_t i = 0; i < Info.Macros.size(); ++i)
+    {
+        if (!IsRelevant[i])
+            Result.IgnoredMacros.emplace_back(Info.Macros[i].Name);
+    }
+
+    const size_t SourceHash = ComputeHash(CStringHash<char>{}(NormalizedSource.c_str()),
+                                          CStringHash<char>{}(Info.ShaderCI.EntryPoint != nullptr ? Info.ShaderCI.EntryPoint : ""),
+                                          static_cast<Uint32>(Info.ShaderCI.Desc.ShaderType),
+                                          static_cast<Uint32>(Info.ShaderCI.SourceLanguage),
+                                          static_cast<Uint32>(Info.ShaderCI.ShaderCompiler),
+                                          static_cast<Uint32>(Info.ShaderCI.CompileFlags));
+
+    // Macros of the first permutation that has the source
+    struct UniqueSource
+    {
+        std::vector<ShaderMacro> Macros;
+        RefCntAutoPtr<IObject>   pObject;
+    };
+    std::vector<UniqueSource>                        UniqueSources;
+    std::unordered_map<std::string, Uint32>          SourceIndices;
+    std::vector<std::pair<const char*, const char*>> Definitions;
+
+    Result.SourceIndices.resize(NumPermutations);
+    for (size_t Permutation = 0; Permutation < NumPermutations; ++Permutation)
+    {
+        // The definitions of the shared macros and the relevant permutation macros, sorted by name,
+        // define the preprocessed source.
+        Definitions.clear();
+        for (Uint32 i = 0; i < Info.ShaderCI.Macros.Count; ++i)
+        {
+            const ShaderMacro& Macro = Info.ShaderCI.Macros[i];
+            Definitions.emplace_back(Macro.Name != nullptr ? Macro.Name : "", Macro.Definition != nullptr ? Macro.Definition : "");
+        }
+
+        size_t ValueIndex = Permutation;
+        for (size_t i = 0; i < Info.Macros.size(); ++i)
+        {
+            const ShaderPermutationMacro& Macro = Info.Macros[i];
+            if (IsRelevant[i])
+                Definitions.emplace_back(Macro.Name.c_str(), Macro.Values[ValueIndex % Macro.Values.size()].c_str());
+            ValueIndex /= Macro.Values.size();
+        }
+        std::stable_sort(Definitions.begin(), Definitions.end(),
+                         [](const std::pair<const char*, const char*>& lhs, const std::pair<const char*, const char*>& rhs) {
+                             return strcmp(lhs.first, rhs.first) < 0;
+                         });
+
+        std::string Key;
+        for (const auto& Def : Definitions)
+        {
+            Key.append(Def.first);
+            Key.push_back('=');
+            Key.append(Def.second);
+            Key.push_back('\n');
+        }
+
+        auto it = SourceIndices.emplace(std::move(Key), static_cast<Uint32>(UniqueSources.size()));
+        if (it.second)
+        {
+            UniqueSource Source;
+            for (Uint32 i = 0; i < Info.ShaderCI.Macros.Count; ++i)
+                Source.Macros.emplace_back(Info.ShaderCI.Macros[i]);
+
+            // Compile the permutation with all its macros
+            ValueIndex = Permutation;
+            for (const ShaderPermutationMacro& Macro : Info.Macros)
+            {
+                Source.Macros.emplace_back(Macro.Name.c_str(), Macro.Values[ValueIndex % Macro.Values.size()].c_str());
+                ValueIndex /= Macro.Values.size();
+            }
+            UniqueSources.emplace_back(std::move(Source));
+            Result.SourceHashes.emplace_back(ComputeHash(SourceHash, CStringHash<char>{}(it.first->first.c_str())));
+        }
+        Result.SourceIndices[Permutation] = it.first->second;
+    }
+
+    std::atomic<bool> AllCompiled{true};
+
+    auto CompileSource = [&](size_t SrcIdx) {
+        UniqueSource& Source = UniqueSources[SrcIdx];
+
+        ShaderCreateInfo ShaderCI = Info.ShaderCI;
+        ShaderCI.Macros           = {Source.Macros.data(), static_cast<Uint32>(Source.Macros.size())};
+
+        try
+        {
+            Source.pObject = Info.CompileHandler(ShaderCI);
+        }
+        catch (...)
+        {
+            Source.pObject.Release();
+        }
+
+        if (!Source.pObject)
+            AllCompiled.store(false);
+    };
+
+    if (Info.pThreadPool != nullptr && UniqueSources.size() > 1)
+    {
+        try
+        {
+            ProcessItemsInParallel(Info.pThreadPool, UniqueSources.size(), CompileSource);
+        }
+        catch (...)
+        {
+            // CompileSource does not throw
+            UNEXPECTED("Unexpected exception");
+            AllCompiled.store(false);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < UniqueSources.size(); ++i)
+            CompileSource(i);
+    }
+
+    Result.Permutations.resize(NumPermutations);
+    for (size_t Permutation = 0; Permutation < NumPermutations; ++Permutation)
+        Result.Permutations[Permutation] = UniqueSources[Result.SourceIndices[Permutation]].pObject;
+
+    return AllCompiled.load();
+}
+
+} // namespace Diligent
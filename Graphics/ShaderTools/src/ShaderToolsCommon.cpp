@@ -28,6 +28,9 @@
 #include "ShaderToolsCommon.hpp"
 
 #include <unordered_set>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
 
 #include "BasicFileSystem.hpp"
 #include "DebugUtilities.hpp"
@@ -35,6 +38,7 @@
 #include "StringDataBlobImpl.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ParsingTools.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 namespace Diligent
 {
@@ -219,6 +223,15 @@ SHADER_SOURCE_LANGUAGE ParseShaderSourceLanguageDefinition(const std::string& So
         SHADER_SOURCE_LANGUAGE_DEFAULT;
 }
 
+static RefCntAutoPtr<IDataBlob> LoadShaderSourceFileImpl(IShaderSourceInputStreamFactory*                            pShaderSourceStreamFactory,
+                                                         const char*                                                 FilePath,
+                                                         std::shared_ptr<const std::vector<ShaderIncludeDirective>>* ppIncludes);
+
+RefCntAutoPtr<IDataBlob> LoadShaderSourceFile(IShaderSourceInputStreamFactory* pShaderSourceStreamFactory, const char* FilePath)
+{
+    return LoadShaderSourceFileImpl(pShaderSourceStreamFactory, FilePath, nullptr);
+}
+
 ShaderSourceFileData ReadShaderSourceFile(const char*                      SourceCode,
                                           size_t                           SourceLength,
                                           IShaderSourceInputStreamFactory* pShaderSourceStreamFactory,
@@ -237,13 +250,10 @@ ShaderSourceFileData ReadShaderSourceFile(const char*                      Sourc
         {
             if (FilePath != nullptr)
             {
-                RefCntAutoPtr<IFileStream> pSourceStream;
-                pShaderSourceStreamFactory->CreateInputStream(FilePath, &pSourceStream);
-                if (pSourceStream == nullptr)
+                SourceData.pFileData = LoadShaderSourceFileImpl(pShaderSourceStreamFactory, FilePath, &SourceData.pIncludes);
+                if (SourceData.pFileData == nullptr)
                     LOG_ERROR_AND_THROW("Failed to load shader source file '", FilePath, '\'');
 
-                SourceData.pFileData = DataBlobImpl::Create();
-                pSourceStream->ReadBlob(SourceData.pFileData);
                 SourceData.Source       = SourceData.pFileData->GetConstDataPtr<char>();
                 SourceData.SourceLength = StaticCast<Uint32>(SourceData.pFileData->GetSize());
             }
@@ -404,6 +414,166 @@ bool FindIncludes(const char* pBuffer, size_t BufferSize, HandlerType&& IncludeH
     return true;
 }
 
+// Calls the handler for every include directive of the source file, using
+// the cached directives if the file was served by the shader source cache.
+template <typename HandlerType, typename ErrorHandlerType>
+bool FindIncludes(const ShaderSourceFileData& SourceData, HandlerType&& IncludeHandler, ErrorHandlerType ErrorHandler)
+{
+    if (SourceData.pIncludes)
+    {
+        for (const ShaderIncludeDirective& Include : *SourceData.pIncludes)
+            IncludeHandler(Include.Path, Include.Start, Include.End);
+        return true;
+    }
+
+    return FindIncludes(SourceData.Source, SourceData.SourceLength, std::forward<HandlerType>(IncludeHandler), ErrorHandler);
+}
+
+namespace
+{
+
+class ShaderSourceCache
+{
+public:
+    static ShaderSourceCache& GetInstance()
+    {
+        static ShaderSourceCache Cache;
+        return Cache;
+    }
+
+    struct FileInfo
+    {
+        RefCntAutoPtr<IDataBlob> pData;
+
+        // Null if the file contains invalid include directives
+        std::shared_ptr<const std::vector<ShaderIncludeDirective>> pIncludes;
+    };
+
+    bool Find(IShaderSourceInputStreamFactory* pFactory, const char* FilePath, FileInfo& Info)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto FactoryIt = m_Factories.find(pFactory);
+        if (FactoryIt == m_Factories.end())
+            return false;
+
+        auto FileIt = FactoryIt->second.Files.find(FilePath);
+        if (FileIt == FactoryIt->second.Files.end())
+            return false;
+
+        Info = FileIt->second;
+        return true;
+    }
+
+    void Add(IShaderSourceInputStreamFactory* pFactory, const char* FilePath, const FileInfo& Info)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        FactoryFiles& Factory = m_Factories[pFactory];
+        if (!Factory.pFactory)
+            Factory.pFactory = pFactory;
+        // If another thread has added the file in the meantime, keep its data
+        Factory.Files.emplace(FilePath, Info);
+    }
+
+    void Invalidate(const char* FilePath)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (FilePath != nullptr)
+        {
+            for (auto& Factory : m_Factories)
+                Factory.second.Files.erase(FilePath);
+        }
+        else
+        {
+            m_Factories.clear();
+        }
+    }
+
+    std::atomic<bool> Enabled{false};
+
+private:
+    std::mutex m_Mtx;
+
+    struct FactoryFiles
+    {
+        // Keep the factory alive so that its address can't be reused by another factory
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+
+        std::unordered_map<std::string, FileInfo> Files;
+    };
+    std::unordered_map<IShaderSourceInputStreamFactory*, FactoryFiles> m_Factories;
+};
+
+} // namespace
+
+static RefCntAutoPtr<IDataBlob> LoadShaderSourceFileImpl(IShaderSourceInputStreamFactory*                            pShaderSourceStreamFactory,
+                                                         const char*                                                 FilePath,
+                                                         std::shared_ptr<const std::vector<ShaderIncludeDirective>>* ppIncludes)
+{
+    if (pShaderSourceStreamFactory == nullptr || FilePath == nullptr)
+        return {};
+
+    ShaderSourceCache&          Cache        = ShaderSourceCache::GetInstance();
+    const bool                  CacheEnabled = Cache.Enabled.load();
+    ShaderSourceCache::FileInfo Info;
+    if (CacheEnabled && Cache.Find(pShaderSourceStreamFactory, FilePath, Info))
+    {
+        if (ppIncludes != nullptr)
+            *ppIncludes = std::move(Info.pIncludes);
+        return Info.pData;
+    }
+
+    RefCntAutoPtr<IFileStream> pSourceStream;
+    pShaderSourceStreamFactory->CreateInputStream(FilePath, &pSourceStream);
+    if (pSourceStream == nullptr)
+        return {};
+
+    RefCntAutoPtr<IDataBlob> pFileData = DataBlobImpl::Create();
+    pSourceStream->ReadBlob(pFileData);
+
+    if (CacheEnabled)
+    {
+        Info.pData = pFileData;
+
+        auto pIncludes = std::make_shared<std::vector<ShaderIncludeDirective>>();
+        const bool IncludesFound =
+            FindIncludes(
+                pFileData->GetConstDataPtr<char>(), pFileData->GetSize(),
+                [&](const std::string& Path, size_t Start, size_t End) {
+                    pIncludes->emplace_back(ShaderIncludeDirective{Path, Start, End});
+                },
+                [](const std::string&) {});
+        // If the file contains invalid directives, they will be reported by the caller
+        if (IncludesFound)
+            Info.pIncludes = std::move(pIncludes);
+
+        Cache.Add(pShaderSourceStreamFactory, FilePath, Info);
+        if (ppIncludes != nullptr)
+            *ppIncludes = Info.pIncludes;
+    }
+
+    return pFileData;
+}
+
+void SetShaderSourceCacheEnabled(bool Enabled)
+{
+    ShaderSourceCache& Cache = ShaderSourceCache::GetInstance();
+    Cache.Enabled.store(Enabled);
+    if (!Enabled)
+        Cache.Invalidate(nullptr);
+}
+
+bool IsShaderSourceCacheEnabled()
+{
+    return ShaderSourceCache::GetInstance().Enabled.load();
+}
+
+void InvalidateShaderSourceCache(const char* FilePath)
+{
+    ShaderSourceCache::GetInstance().Invalidate(FilePath);
+}
+
 static void ProcessIncludeErrorHandler(const ShaderCreateInfo& ShaderCI, const std::string& Error) noexcept(false)
 {
     std::string FileInfo;
@@ -433,7 +603,7 @@ void ProcessShaderIncludesImpl(const ShaderCreateInfo& ShaderCI, std::unordered_
     FileInfo.FilePath     = ShaderCI.FilePath != nullptr ? ShaderCI.FilePath : "";
 
     FindIncludes(
-        FileInfo.Source, FileInfo.SourceLength,
+        SourceData,
         [&](const std::string& FilePath, size_t Start, size_t End) //
         {
             if (!Includes.insert(FilePath).second)
@@ -483,7 +653,7 @@ static std::string UnrollShaderIncludesImpl(ShaderCreateInfo ShaderCI, std::unor
     size_t            PrevIncludeEnd = 0;
 
     FindIncludes(
-        ShaderCI.Source, ShaderCI.SourceLength, [&](const std::string& Path, size_t IncludeStart, size_t IncludeEnd) {
+        SourceData, [&](const std::string& Path, size_t IncludeStart, size_t IncludeEnd) {
             // Insert text before the include start
             Stream.write(ShaderCI.Source + PrevIncludeEnd, IncludeStart - PrevIncludeEnd);
 
@@ -510,6 +680,8 @@ static std::string UnrollShaderIncludesImpl(ShaderCreateInfo ShaderCI, std::unor
 
 std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(false)
 {
+    ShaderCompilationStageScope Preprocess{SHADER_COMPILATION_STAGE_PREPROCESS};
+
     std::unordered_set<std::string> Includes;
     if (ShaderCI.FilePath != nullptr)
         Includes.emplace(ShaderCI.FilePath);
@@ -526,6 +698,20 @@ std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(fals
     // Let other exceptions (e.g. 'Failed to load shader source file...') pass through
 }
 
+bool GetShaderIncludeDependencies(const ShaderCreateInfo& ShaderCI, std::vector<std::string>& Dependencies) noexcept
+{
+    Dependencies.clear();
+    if (!ProcessShaderIncludes(ShaderCI, [&](const ShaderIncludePreprocessInfo& ProcessInfo) {
+            Dependencies.emplace_back(ProcessInfo.FilePath);
+        }))
+        return false;
+
+    // The original file is processed last
+    VERIFY_EXPR(!Dependencies.empty());
+    Dependencies.pop_back();
+    return true;
+}
+
 std::string GetShaderCodeTypeName(SHADER_CODE_BASIC_TYPE     BasicType,
                                   SHADER_CODE_VARIABLE_CLASS Class,
                                   Uint32                     NumRows,
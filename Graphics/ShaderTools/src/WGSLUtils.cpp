@@ -25,9 +25,14 @@
  */
 
 #include "WGSLUtils.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
 #include "DebugUtilities.hpp"
 #include "ParsingTools.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "ShaderCompilationProfiler.hpp"
 
 #ifdef _MSC_VER
 #    pragma warning(push)
@@ -89,17 +94,121 @@ WGSLEmulatedResourceArrayElement GetWGSLEmulatedArrayElement(const std::string&
     return {Name, -1};
 }
 
-std::string ConvertSPIRVtoWGSL(const std::vector<uint32_t>& SPIRV)
+namespace
+{
+
+LRUCache<std::string, std::string>& GetWGSLConversionCache()
+{
+    static LRUCache<std::string, std::string> Cache;
+    return Cache;
+}
+
+enum class WGSLConversionType : char
+{
+    SPIRVtoWGSL         = 'S',
+    RemapBindings       = 'R',
+    SPIRVtoRemappedWGSL = 'M',
+};
+
+// Builds the cache key that contains the conversion type, the resource mapping
+// and the source, so that WGSL is never returned for a different input.
+std::string GetWGSLConversionCacheKey(WGSLConversionType         Type,
+                                      const void*                pSource,
+                                      size_t                     SourceSize,
+                                      const WGSLResourceMapping* pResMapping,
+                                      const char*                EmulatedArrayIndexSuffix)
+{
+    std::string Key;
+    Key.reserve(SourceSize + 64);
+    Key.push_back(static_cast<char>(Type));
+
+    if (pResMapping != nullptr)
+    {
+        const uint32_t NumResources = static_cast<uint32_t>(pResMapping->size());
+        Key.append(reinterpret_cast<const char*>(&NumResources), sizeof(NumResources));
+
+        // Sort the resources to make the key independent of the hash map order
+        std::vector<const WGSLResourceMapping::value_type*> Resources;
+        Resources.reserve(pResMapping->size());
+        for (const auto& Res : *pResMapping)
+            Resources.push_back(&Res);
+        std::sort(Resources.begin(), Resources.end(),
+                  [](const WGSLResourceMapping::value_type* lhs, const WGSLResourceMapping::value_type* rhs) {
+                      return lhs->first < rhs->first;
+                  });
+
+        for (const WGSLResourceMapping::value_type* pRes : Resources)
+        {
+            Key.append(pRes->first.c_str(), pRes->first.length() + 1);
+            const uint32_t Binding[] = {pRes->second.Group, pRes->second.Index, pRes->second.ArraySize};
+            Key.append(reinterpret_cast<const char*>(Binding), sizeof(Binding));
+        }
+
+        if (EmulatedArrayIndexSuffix != nullptr)
+            Key.append(EmulatedArrayIndexSuffix);
+        // Distinguish null suffix from empty suffix
+        Key.push_back(EmulatedArrayIndexSuffix != nullptr ? '\1' : '\0');
+    }
+
+    Key.append(static_cast<const char*>(pSource), SourceSize);
+    return Key;
+}
+
+// Looks up the conversion result in the cache, and runs the conversion on a miss.
+// Failed conversions are not cached.
+template <typename ConvertType>
+std::string ConvertWGSLCached(WGSLConversionType         Type,
+                              const void*                pSource,
+                              size_t                     SourceSize,
+                              const WGSLResourceMapping* pResMapping,
+                              const char*                EmulatedArrayIndexSuffix,
+                              ConvertType&&              Convert)
+{
+    ShaderCompilationStageScope CrossCompile{SHADER_COMPILATION_STAGE_CROSS_COMPILE};
+
+    LRUCache<std::string, std::string>& Cache = GetWGSLConversionCache();
+    if (Cache.GetMaxSize() == 0 && Cache.GetCurrSize() == 0)
+        return Convert();
+
+    const std::string Key = GetWGSLConversionCacheKey(Type, pSource, SourceSize, pResMapping, EmulatedArrayIndexSuffix);
+
+    bool Converted = false;
+    try
+    {
+        std::string Result = Cache.Get(Key,
+                                       [&](std::string& WGSL, size_t& Size) {
+                                           Converted = true;
+                                           WGSL      = Convert();
+                                           if (WGSL.empty())
+                                               throw std::runtime_error{"WGSL conversion failed"};
+                                           Size = Key.size() + WGSL.size();
+                                       });
+        ShaderCompilationProfiler::AddCacheResult(!Converted);
+        return Result;
+    }
+    catch (const std::runtime_error&)
+    {
+        ShaderCompilationProfiler::AddCacheResult(false);
+        return {};
+    }
+}
+
+bool ReadSPIRV(const std::vector<uint32_t>& SPIRV, tint::Program& Program)
 {
     tint::spirv::reader::Options SPIRVReaderOptions{true, {tint::wgsl::AllowedFeatures::Everything()}};
-    tint::Program                Program = Read(SPIRV, SPIRVReaderOptions);
+    Program = Read(SPIRV, SPIRVReaderOptions);
 
     if (!Program.IsValid())
     {
         LOG_ERROR_MESSAGE("Tint SPIR-V reader failure:\nParser: " + Program.Diagnostics().Str() + "\n");
-        return {};
+        return false;
     }
 
+    return true;
+}
+
+std::string GenerateWGSL(const tint::Program& Program)
+{
     auto GenerationResult = tint::wgsl::writer::Generate(Program, {});
     if (GenerationResult != tint::Success)
     {
@@ -107,7 +216,51 @@ std::string ConvertSPIRVtoWGSL(const std::vector<uint32_t>& SPIRV)
         return {};
     }
 
-    return GenerationResult->wgsl;
+    return std::move(GenerationResult->wgsl);
+}
+
+std::string RemapProgramBindings(const tint::Program&       Program,
+                                 const WGSLResourceMapping& ResMapping,
+                                 const char*                EmulatedArrayIndexSuffix);
+
+} // namespace
+
+std::string ConvertSPIRVtoWGSL(const std::vector<uint32_t>& SPIRV)
+{
+    return ConvertWGSLCached(
+        WGSLConversionType::SPIRVtoWGSL, SPIRV.data(), SPIRV.size() * sizeof(uint32_t), nullptr, nullptr,
+        [&]() -> std::string {
+            tint::Program Program;
+            if (!ReadSPIRV(SPIRV, Program))
+                return {};
+
+            return GenerateWGSL(Program);
+        });
+}
+
+std::string ConvertSPIRVtoWGSL(const std::vector<uint32_t>& SPIRV,
+                               const WGSLResourceMapping&   ResMapping,
+                               const char*                  EmulatedArrayIndexSuffix)
+{
+    return ConvertWGSLCached(
+        WGSLConversionType::SPIRVtoRemappedWGSL, SPIRV.data(), SPIRV.size() * sizeof(uint32_t), &ResMapping, EmulatedArrayIndexSuffix,
+        [&]() -> std::string {
+            tint::Program Program;
+            if (!ReadSPIRV(SPIRV, Program))
+                return {};
+
+            return RemapProgramBindings(Program, ResMapping, EmulatedArrayIndexSuffix);
+        });
+}
+
+void SetWGSLConversionCacheSize(size_t MaxSize)
+{
+    GetWGSLConversionCache().SetMaxSize(MaxSize);
+}
+
+LRUCacheStats GetWGSLConversionCacheStats()
+{
+    return GetWGSLConversionCache().GetStats();
 }
 
 static bool IsAtomic(const tint::core::type::Type* WGSLType)
@@ -267,19 +420,13 @@ static WGSLResourceMapping::const_iterator FindResourceAsArrayElement(const WGSL
     return ResMapping.end();
 }
 
-std::string RamapWGSLResourceBindings(const std::string&         WGSL,
-                                      const WGSLResourceMapping& ResMapping,
-                                      const char*                EmulatedArrayIndexSuffix)
+namespace
 {
-    tint::Source::File srcFile("", WGSL);
-    tint::Program      Program = tint::wgsl::reader::Parse(&srcFile, {tint::wgsl::AllowedFeatures::Everything()});
-
-    if (!Program.IsValid())
-    {
-        LOG_ERROR_MESSAGE("Tint WGSL reader failure:\nParser: ", Program.Diagnostics().Str(), "\n");
-        return {};
-    }
 
+std::string RemapProgramBindings(const tint::Program&       Program,
+                                 const WGSLResourceMapping& ResMapping,
+                                 const char*                EmulatedArrayIndexSuffix)
+{
     tint::ast::transform::BindingRemapper::BindingPoints BindingPoints;
 
     tint::inspector::Inspector Inspector{Program};
@@ -328,22 +475,38 @@ std::string RamapWGSLResourceBindings(const std::string&         WGSL,
     Manager.Add<tint::ast::transform::BindingRemapper>();
     tint::ast::transform::Output TransformResult = Manager.Run(Program, Inputs, Outputs);
 
-    auto GenerationResult = tint::wgsl::writer::Generate(TransformResult.program, {});
+    return GenerateWGSL(TransformResult.program);
+}
 
-    if (GenerationResult != tint::Success)
-    {
-        LOG_ERROR_MESSAGE("Tint WGSL writer failure:\nGeneate: ", GenerationResult.Failure().reason.Str(), "\n");
-        return {};
-    }
+} // namespace
+
+std::string RamapWGSLResourceBindings(const std::string&         WGSL,
+                                      const WGSLResourceMapping& ResMapping,
+                                      const char*                EmulatedArrayIndexSuffix)
+{
+    return ConvertWGSLCached(
+        WGSLConversionType::RemapBindings, WGSL.data(), WGSL.size(), &ResMapping, EmulatedArrayIndexSuffix,
+        [&]() -> std::string {
+            tint::Source::File srcFile("", WGSL);
+            tint::Program      Program = tint::wgsl::reader::Parse(&srcFile, {tint::wgsl::AllowedFeatures::Everything()});
+
+            if (!Program.IsValid())
+            {
+                LOG_ERROR_MESSAGE("Tint WGSL reader failure:\nParser: ", Program.Diagnostics().Str(), "\n");
+                return {};
+            }
 
-    std::string PatchedWGSL = std::move(GenerationResult->wgsl);
+            std::string PatchedWGSL = RemapProgramBindings(Program, ResMapping, EmulatedArrayIndexSuffix);
+            if (PatchedWGSL.empty())
+                return {};
 
-    // If original WGSL contains shader source language definition, append it to the patched WGSL
-    SHADER_SOURCE_LANGUAGE SrcLang = ParseShaderSourceLanguageDefinition(WGSL);
-    if (SrcLang != SHADER_SOURCE_LANGUAGE_DEFAULT)
-        AppendShaderSourceLanguageDefinition(PatchedWGSL, SrcLang);
+            // If original WGSL contains shader source language definition, append it to the patched WGSL
+            SHADER_SOURCE_LANGUAGE SrcLang = ParseShaderSourceLanguageDefinition(WGSL);
+            if (SrcLang != SHADER_SOURCE_LANGUAGE_DEFAULT)
+                AppendShaderSourceLanguageDefinition(PatchedWGSL, SrcLang);
 
-    return PatchedWGSL;
+            return PatchedWGSL;
+        });
 }
 
 } // namespace Diligent
@@ -39,6 +39,12 @@ struct AndroidMisc : public LinuxMisc
     /// Sets the current thread affinity mask and on success returns the previous mask.
     /// On failure, returns 0.
     static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
+
+    static ThreadPriority GetCurrentThreadPriority();
+
+    /// Sets the current thread priority and on success returns the previous priority.
+    /// On failure, returns ThreadPriority::Unknown.
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
 };
 
 } // namespace Diligent
@@ -26,12 +26,86 @@
 
 #include "AndroidPlatformMisc.hpp"
 
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <cerrno>
+
 namespace Diligent
 {
 
 Uint64 AndroidMisc::SetCurrentThreadAffinity(Uint64 Mask)
 {
-    return 0;
+    // pthread_setaffinity_np is not available on Android, but sched_setaffinity
+    // with zero pid applies to the calling thread.
+    Uint64 CurrAffinity = 0;
+
+    cpu_set_t CPUSet;
+    CPU_ZERO(&CPUSet);
+    if (sched_getaffinity(0, sizeof(CPUSet), &CPUSet) == 0)
+    {
+        for (Uint32 j = 0; j < 64; ++j)
+        {
+            if (CPU_ISSET(j, &CPUSet))
+                CurrAffinity |= Uint64{1} << j;
+        }
+    }
+
+    CPU_ZERO(&CPUSet);
+    for (Uint32 j = 0; j < 64; j++)
+    {
+        if (Mask & (Uint64{1} << j))
+            CPU_SET(j, &CPUSet);
+    }
+
+    if (sched_setaffinity(0, sizeof(CPUSet), &CPUSet) == 0)
+        return CurrAffinity;
+    else
+        return 0;
+}
+
+ThreadPriority AndroidMisc::GetCurrentThreadPriority()
+{
+    errno               = 0;
+    const int NiceValue = getpriority(PRIO_PROCESS, gettid());
+    if (NiceValue == -1 && errno != 0)
+        return ThreadPriority::Unknown;
+
+    if (NiceValue >= 15)
+        return ThreadPriority::Lowest;
+    else if (NiceValue > 0)
+        return ThreadPriority::BelowNormal;
+    else if (NiceValue == 0)
+        return ThreadPriority::Normal;
+    else if (NiceValue > -10)
+        return ThreadPriority::AboveNormal;
+    else
+        return ThreadPriority::Highest;
+}
+
+ThreadPriority AndroidMisc::SetCurrentThreadPriority(ThreadPriority Priority)
+{
+    int NiceValue = 0;
+    switch (Priority)
+    {
+        // clang-format off
+        case ThreadPriority::Lowest:      NiceValue = 19;  break;
+        case ThreadPriority::BelowNormal: NiceValue = 10;  break;
+        case ThreadPriority::Normal:      NiceValue = 0;   break;
+        case ThreadPriority::AboveNormal: NiceValue = -5;  break;
+        case ThreadPriority::Highest:     NiceValue = -10; break;
+        default:                          return ThreadPriority::Unknown;
+            // clang-format on
+    }
+
+    const ThreadPriority OrigPriority = GetCurrentThreadPriority();
+    if (OrigPriority == ThreadPriority::Unknown)
+        return ThreadPriority::Unknown;
+
+    if (setpriority(PRIO_PROCESS, gettid(), NiceValue) != 0)
+        return ThreadPriority::Unknown;
+
+    return OrigPriority;
 }
 
 } // namespace Diligent
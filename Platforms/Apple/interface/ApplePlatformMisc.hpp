@@ -37,6 +37,23 @@ namespace Diligent
 struct AppleMisc : public LinuxMisc
 {
     static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
+
+    static ThreadPriority GetCurrentThreadPriority()
+    {
+        return BasicPlatformMisc::GetCurrentThreadPriority();
+    }
+
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority)
+    {
+        return BasicPlatformMisc::SetCurrentThreadPriority(Priority);
+    }
+
+    /// Returns the CPU topology information.
+
+    /// \remarks   Apple platforms do not support thread affinity, so the core masks
+    ///            only describe the number of cores of each type, with performance
+    ///            cores occupying the lower bits.
+    static CPUTopologyInfo GetCPUTopology();
 };
 
 } // namespace Diligent
@@ -26,6 +26,8 @@
 
 #include "ApplePlatformMisc.hpp"
 
+#include <sys/sysctl.h>
+
 namespace Diligent
 {
 
@@ -35,4 +37,58 @@ Uint64 AppleMisc::SetCurrentThreadAffinity(Uint64 Mask)
     return 0;
 }
 
+static bool GetSysctlValue(const char* Name, Uint32& Value)
+{
+    int    IntValue = 0;
+    size_t Size     = sizeof(IntValue);
+    if (sysctlbyname(Name, &IntValue, &Size, nullptr, 0) != 0 || IntValue <= 0)
+        return false;
+
+    Value = static_cast<Uint32>(IntValue);
+    return true;
+}
+
+static Uint64 GetCoresMask(Uint32 FirstCore, Uint32 NumCores)
+{
+    Uint64 Mask = 0;
+    for (Uint32 i = FirstCore; i < FirstCore + NumCores && i < 64; ++i)
+        Mask |= Uint64{1} << i;
+    return Mask;
+}
+
+CPUTopologyInfo AppleMisc::GetCPUTopology()
+{
+    CPUTopologyInfo Topology = BasicPlatformMisc::GetCPUTopology();
+
+    GetSysctlValue("hw.logicalcpu", Topology.NumLogicalCores);
+    GetSysctlValue("hw.physicalcpu", Topology.NumPhysicalCores);
+
+    // Apple silicon reports performance levels starting with the fastest one
+    Uint32 NumPerfLevels = 0;
+    GetSysctlValue("hw.nperflevels", NumPerfLevels);
+    if (NumPerfLevels > 1)
+    {
+        Uint32 NumPCores = 0;
+        Uint32 NumECores = 0;
+        if (GetSysctlValue("hw.perflevel0.logicalcpu", NumPCores) && GetSysctlValue("hw.perflevel1.logicalcpu", NumECores))
+        {
+            Topology.NumPerformanceCores = NumPCores;
+            Topology.NumEfficiencyCores  = NumECores;
+        }
+    }
+    else
+    {
+        Topology.NumPerformanceCores = Topology.NumLogicalCores;
+        Topology.NumEfficiencyCores  = 0;
+    }
+
+    Topology.LogicalCoresMask     = GetCoresMask(0, Topology.NumLogicalCores);
+    Topology.PerformanceCoresMask = GetCoresMask(0, Topology.NumPerformanceCores);
+    Topology.EfficiencyCoresMask  = GetCoresMask(Topology.NumPerformanceCores, Topology.NumEfficiencyCores);
+    Topology.PrimaryThreadsMask   = GetCoresMask(0, Topology.NumPhysicalCores);
+    Topology.NUMANodeMasks[0]     = Topology.LogicalCoresMask;
+
+    return Topology;
+}
+
 } // namespace Diligent
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Reads a file asynchronously.
+
+/// The reader opens the file once and allows submitting any number of reads from any thread.
+/// The reads are executed in parallel and complete in arbitrary order; the completion
+/// callback of every read is called from an internal thread.
+///
+/// The backend is selected when the file is opened:
+/// - Linux: io_uring, if the kernel supports it and it is not disabled by the security policy.
+/// - Win32: overlapped reads with an I/O completion port.
+/// - Other platforms, or if io_uring is unavailable: worker threads that execute blocking reads.
+class AsyncFileReader
+{
+public:
+    enum BACKEND : Uint8
+    {
+        BACKEND_THREADS,
+        BACKEND_IO_URING,
+        BACKEND_IOCP
+    };
+
+    /// Read completion callback.
+
+    /// \param [in] Success      - Whether all requested bytes have been read.
+    /// \param [in] NumBytesRead - The number of bytes that have been read.
+    ///
+    /// \remarks    The callback is called from an internal thread and must not submit
+    ///             reads and wait for their completion, which may deadlock.
+    using ReadCallbackType = std::function<void(bool Success, size_t NumBytesRead)>;
+
+    /// Opens the file. Throws std::runtime_error if the file can't be opened.
+
+    /// \param [in] strFilePath      - File path.
+    /// \param [in] NumWorkerThreads - The number of worker threads used by the thread backend.
+    /// \param [in] QueueSize        - The maximum number of reads that are executed simultaneously
+    ///                                by the io_uring backend. Further reads wait until a slot is available.
+    explicit AsyncFileReader(const Char* strFilePath, Uint32 NumWorkerThreads = 2, Uint32 QueueSize = 64) noexcept(false);
+
+    /// Waits for all pending reads and closes the file.
+    ~AsyncFileReader();
+
+    // clang-format off
+    AsyncFileReader           (const AsyncFileReader&) = delete;
+    AsyncFileReader           (AsyncFileReader&&)      = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+    AsyncFileReader& operator=(AsyncFileReader&&)      = delete;
+    // clang-format on
+
+    /// Submits the read of Size bytes starting at Offset into pDst.
+
+    /// \remarks    The destination memory must remain valid until the callback is called.
+    ///             If the range exceeds the file size, the read fails without reading any data,
+    ///             and the callback is called immediately from the calling thread.
+    void ReadAsync(Uint64 Offset, size_t Size, void* pDst, ReadCallbackType Callback);
+
+    /// Waits until all submitted reads complete and their callbacks return.
+    void WaitIdle();
+
+    /// Returns the file size.
+    Uint64 GetSize() const;
+
+    /// Returns the backend used by the reader.
+    BACKEND GetBackend() const;
+
+    class Impl;
+
+private:
+    std::unique_ptr<Impl> m_pImpl;
+};
+
+} // namespace Diligent
@@ -135,6 +135,13 @@ struct FindFileData
 {
     String Name;
     bool   IsDirectory = false;
+
+    /// File size in bytes. Zero for directories and on platforms that do not report the size.
+    Uint64 Size = 0;
+
+    /// Last modification time in seconds since the Unix epoch.
+    /// Zero on platforms that do not report the time.
+    Uint64 LastWriteTime = 0;
 };
 
 struct BasicFileSystem
@@ -42,6 +42,56 @@ enum class ThreadPriority
     Highest
 };
 
+/// CPU topology information.
+
+/// \remarks   Core masks use the same bit layout as the affinity mask passed to
+///            SetCurrentThreadAffinity(): bit N corresponds to logical core N.
+///            Only the first 64 logical cores are represented in the masks.
+struct CPUTopologyInfo
+{
+    /// The maximum number of NUMA nodes reported in NUMANodeMasks.
+    static constexpr Uint32 MaxNUMANodes = 8;
+
+    /// The number of logical cores (hardware threads).
+    Uint32 NumLogicalCores = 0;
+
+    /// The number of physical cores.
+    Uint32 NumPhysicalCores = 0;
+
+    /// The number of logical performance cores (Intel P-cores, ARM big cores).
+
+    /// \remarks   On non-hybrid CPUs, all cores are treated as performance cores.
+    Uint32 NumPerformanceCores = 0;
+
+    /// The number of logical efficiency cores (Intel E-cores, ARM LITTLE cores).
+    Uint32 NumEfficiencyCores = 0;
+
+    /// The number of NUMA nodes.
+    Uint32 NumNUMANodes = 1;
+
+    /// The mask of all logical cores.
+    Uint64 LogicalCoresMask = 0;
+
+    /// The mask of logical performance cores.
+    Uint64 PerformanceCoresMask = 0;
+
+    /// The mask of logical efficiency cores.
+    Uint64 EfficiencyCoresMask = 0;
+
+    /// The mask that contains one logical core per physical core,
+    /// i.e. excludes SMT siblings.
+    Uint64 PrimaryThreadsMask = 0;
+
+    /// Logical core masks of the first MaxNUMANodes NUMA nodes.
+    Uint64 NUMANodeMasks[MaxNUMANodes] = {};
+
+    /// Returns true if the CPU has both performance and efficiency cores.
+    bool IsHybrid() const
+    {
+        return NumPerformanceCores > 0 && NumEfficiencyCores > 0;
+    }
+};
+
 struct BasicPlatformMisc
 {
     template <typename Type>
@@ -110,6 +160,12 @@ struct BasicPlatformMisc
     /// Sets the current thread affinity mask and on success returns the previous mask.
     static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
 
+    /// Returns the CPU topology information.
+
+    /// \remarks   The basic implementation treats every hardware thread
+    ///            as a separate performance core.
+    static CPUTopologyInfo GetCPUTopology();
+
 private:
     static void SwapBytes16(Uint16& Val)
     {
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Private copy-on-write view of a file mapped into the process address space.
+
+/// The file contents are not read when the file is mapped. Instead, the operating system
+/// loads the pages on first access, so that the parts of the file that are never accessed
+/// do not consume physical memory and do not cause disk reads.
+/// The view uses copy-on-write semantics: the data may be modified through the pointer
+/// returned by GetData(), but the changes are never written back to the file.
+class MemoryMappedFile
+{
+public:
+    /// Maps the entire file. Throws std::runtime_error if the file can't be mapped.
+    explicit MemoryMappedFile(const Char* strFilePath) noexcept(false);
+    ~MemoryMappedFile();
+
+    // clang-format off
+    MemoryMappedFile           (const MemoryMappedFile&) = delete;
+    MemoryMappedFile           (MemoryMappedFile&&)      = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(MemoryMappedFile&&)      = delete;
+    // clang-format on
+
+    /// Returns true if memory-mapped files are supported on the current platform.
+    static bool IsSupported();
+
+    void* GetData() const
+    {
+        return m_pData;
+    }
+
+    size_t GetSize() const
+    {
+        return m_Size;
+    }
+
+private:
+    void*  m_pData = nullptr;
+    size_t m_Size  = 0;
+};
+
+} // namespace Diligent
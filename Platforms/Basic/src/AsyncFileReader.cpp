@@ -0,0 +1,826 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "AsyncFileReader.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+#include "DebugUtilities.hpp"
+#include "Errors.hpp"
+
+#if PLATFORM_WIN32
+#    include "../../Win32/interface/WinHPreface.h"
+#    include <Windows.h>
+#    include "../../Win32/interface/WinHPostface.h"
+#    include <string>
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_EMSCRIPTEN
+#    include <sys/stat.h>
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <errno.h>
+#    include <string.h>
+#    define DILIGENT_POSIX_PREAD 1
+#endif
+
+#if PLATFORM_LINUX
+#    include <sys/syscall.h>
+#    include <sys/mman.h>
+#    include <sys/uio.h>
+#    include <linux/io_uring.h>
+#    if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#        define DILIGENT_IO_URING 1
+#    endif
+#endif
+
+namespace Diligent
+{
+
+class AsyncFileReader::Impl
+{
+public:
+    Impl(Uint64 Size, BACKEND Backend) noexcept :
+        m_Size{Size},
+        m_Backend{Backend}
+    {}
+
+    virtual ~Impl()
+    {
+        VERIFY(m_NumPending == 0, "Derived class must wait for all pending reads in its destructor");
+    }
+
+    void Read(Uint64 Offset, size_t Size, void* pDst, ReadCallbackType&& Callback)
+    {
+        if (Offset > m_Size || Size > m_Size - Offset)
+        {
+            LOG_ERROR_MESSAGE("Read range [", Offset, ", ", Offset + Size, ") exceeds the file size (", m_Size, ")");
+            if (Callback)
+                Callback(false, 0);
+            return;
+        }
+        DEV_CHECK_ERR(Size == 0 || pDst != nullptr, "Destination must not be null");
+        if (Size == 0 || pDst == nullptr)
+        {
+            if (Callback)
+                Callback(Size == 0, 0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock{m_PendingMtx};
+            ++m_NumPending;
+        }
+        Submit(Offset, Size, static_cast<Uint8*>(pDst), std::move(Callback));
+    }
+
+    void WaitIdle()
+    {
+        std::unique_lock<std::mutex> Lock{m_PendingMtx};
+        m_IdleCV.wait(Lock, [this]() { return m_NumPending == 0; });
+    }
+
+    Uint64 GetSize() const { return m_Size; }
+
+    BACKEND GetBackend() const { return m_Backend; }
+
+protected:
+    virtual void Submit(Uint64 Offset, size_t Size, Uint8* pDst, ReadCallbackType&& Callback) = 0;
+
+    // Calls the callback and marks the read as completed
+    void Complete(const ReadCallbackType& Callback, bool Success, size_t NumBytesRead)
+    {
+        if (Callback)
+            Callback(Success, NumBytesRead);
+
+        std::lock_guard<std::mutex> Lock{m_PendingMtx};
+        VERIFY_EXPR(m_NumPending > 0);
+        if (--m_NumPending == 0)
+            m_IdleCV.notify_all();
+    }
+
+private:
+    const Uint64  m_Size;
+    const BACKEND m_Backend;
+
+    std::mutex              m_PendingMtx;
+    std::condition_variable m_IdleCV;
+    size_t                  m_NumPending = 0;
+};
+
+namespace
+{
+
+using ReadCallbackType = AsyncFileReader::ReadCallbackType;
+
+#if !PLATFORM_WIN32
+
+struct OpenedFile
+{
+#    if DILIGENT_POSIX_PREAD
+    int Fd = -1;
+#    else
+    FILE* pFile = nullptr;
+#    endif
+    Uint64 Size = 0;
+};
+
+OpenedFile OpenFile(const Char* strFilePath) noexcept(false)
+{
+    OpenedFile File;
+#    if DILIGENT_POSIX_PREAD
+    File.Fd = open(strFilePath, O_RDONLY);
+    if (File.Fd < 0)
+        LOG_ERROR_AND_THROW("Failed to open file '", strFilePath, "': ", strerror(errno));
+
+    struct stat StatBuff;
+    if (fstat(File.Fd, &StatBuff) != 0)
+    {
+        const int Err = errno;
+        close(File.Fd);
+        LOG_ERROR_AND_THROW("Failed to get the size of file '", strFilePath, "': ", strerror(Err));
+    }
+    File.Size = static_cast<Uint64>(StatBuff.st_size);
+#    else
+    File.pFile = fopen(strFilePath, "rb");
+    if (File.pFile == nullptr)
+        LOG_ERROR_AND_THROW("Failed to open file '", strFilePath, "'");
+
+    const Int64 Size = _fseeki64(File.pFile, 0, SEEK_END) == 0 ? _ftelli64(File.pFile) : -1;
+    if (Size < 0)
+    {
+        fclose(File.pFile);
+        LOG_ERROR_AND_THROW("Failed to get the size of file '", strFilePath, "'");
+    }
+    File.Size = static_cast<Uint64>(Size);
+#    endif
+    return File;
+}
+
+void CloseFile(OpenedFile& File)
+{
+#    if DILIGENT_POSIX_PREAD
+    if (File.Fd >= 0)
+    {
+        close(File.Fd);
+        File.Fd = -1;
+    }
+#    else
+    if (File.pFile != nullptr)
+    {
+        fclose(File.pFile);
+        File.pFile = nullptr;
+    }
+#    endif
+}
+
+// Emulates asynchronous reads with worker threads that execute blocking reads.
+class ThreadsFileReader final : public AsyncFileReader::Impl
+{
+public:
+    // Takes the ownership of the file, even if the constructor throws
+    ThreadsFileReader(const OpenedFile& File, Uint32 NumWorkerThreads) noexcept(false) :
+        Impl{File.Size, AsyncFileReader::BACKEND_THREADS},
+        m_File{File}
+    {
+        StartWorkers(NumWorkerThreads);
+    }
+
+    ~ThreadsFileReader()
+    {
+        WaitIdle();
+        Stop();
+        CloseFile(m_File);
+    }
+
+protected:
+    virtual void Submit(Uint64 Offset, size_t Size, Uint8* pDst, ReadCallbackType&& Callback) override final
+    {
+        if (m_Workers.empty())
+        {
+            const size_t NumBytesRead = ReadAt(Offset, Size, pDst);
+            Complete(Callback, NumBytesRead == Size, NumBytesRead);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock{m_QueueMtx};
+            m_Queue.emplace_back(Request{Offset, Size, pDst, std::move(Callback)});
+        }
+        m_QueueCV.notify_one();
+    }
+
+private:
+    struct Request
+    {
+        Uint64           Offset = 0;
+        size_t           Size   = 0;
+        Uint8*           pDst   = nullptr;
+        ReadCallbackType Callback;
+    };
+
+    // Returns the number of bytes read
+    size_t ReadAt(Uint64 Offset, size_t Size, Uint8* pDst)
+    {
+#if DILIGENT_POSIX_PREAD
+        // pread does not use the file position and may be called from multiple threads
+        size_t NumBytesRead = 0;
+        while (NumBytesRead < Size)
+        {
+            const ssize_t Res = pread(m_File.Fd, pDst + NumBytesRead, Size - NumBytesRead, static_cast<off_t>(Offset + NumBytesRead));
+            if (Res < 0 && errno == EINTR)
+                continue;
+            if (Res <= 0)
+                break;
+            NumBytesRead += static_cast<size_t>(Res);
+        }
+        return NumBytesRead;
+#else
+        std::lock_guard<std::mutex> Lock{m_FileMtx};
+        if (_fseeki64(m_File.pFile, static_cast<Int64>(Offset), SEEK_SET) != 0)
+            return 0;
+        return fread(pDst, 1, Size, m_File.pFile);
+#endif
+    }
+
+    void StartWorkers(Uint32 NumWorkerThreads) noexcept(false)
+    {
+#if PLATFORM_EMSCRIPTEN && !defined(__EMSCRIPTEN_PTHREADS__)
+        // Threads are not available, so the reads are executed by ReadAsync()
+        NumWorkerThreads = 0;
+#endif
+        try
+        {
+            for (Uint32 i = 0; i < NumWorkerThreads; ++i)
+                m_Workers.emplace_back([this]() { WorkerThread(); });
+        }
+        catch (...)
+        {
+            Stop();
+            CloseFile(m_File);
+            throw;
+        }
+    }
+
+    void WorkerThread()
+    {
+        while (true)
+        {
+            Request Req;
+            {
+                std::unique_lock<std::mutex> Lock{m_QueueMtx};
+                m_QueueCV.wait(Lock, [this]() { return m_Stop || !m_Queue.empty(); });
+                if (m_Queue.empty())
+                    return;
+                Req = std::move(m_Queue.front());
+                m_Queue.pop_front();
+            }
+
+            const size_t NumBytesRead = ReadAt(Req.Offset, Req.Size, Req.pDst);
+            Complete(Req.Callback, NumBytesRead == Req.Size, NumBytesRead);
+        }
+    }
+
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_QueueMtx};
+            m_Stop = true;
+        }
+        m_QueueCV.notify_all();
+        for (std::thread& Worker : m_Workers)
+            Worker.join();
+        m_Workers.clear();
+    }
+
+private:
+    OpenedFile m_File;
+#if !DILIGENT_POSIX_PREAD
+    std::mutex m_FileMtx;
+#endif
+
+    std::mutex              m_QueueMtx;
+    std::condition_variable m_QueueCV;
+    std::deque<Request>     m_Queue;
+    bool                    m_Stop = false;
+
+    std::vector<std::thread> m_Workers;
+};
+
+#endif // !PLATFORM_WIN32
+
+#if DILIGENT_IO_URING
+
+// Submits the reads to the io_uring submission queue. The completion thread waits for
+// the completion queue entries and calls the callbacks.
+class IoUringFileReader final : public AsyncFileReader::Impl
+{
+public:
+    // Returns null if io_uring is not available. Takes the ownership of the file descriptor on success only.
+    static std::unique_ptr<IoUringFileReader> Create(const OpenedFile& File, Uint32 QueueSize)
+    {
+        std::unique_ptr<IoUringFileReader> pReader{new IoUringFileReader{File.Fd, File.Size}};
+        if (!pReader->Initialize(QueueSize))
+        {
+            pReader->m_Fd = -1;
+            return {};
+        }
+        return pReader;
+    }
+
+    ~IoUringFileReader()
+    {
+        if (m_CompletionThread.joinable())
+        {
+            WaitIdle();
+
+            // The no-op entry with zero user data stops the completion thread
+            {
+                std::lock_guard<std::mutex> Lock{m_SubmitMtx};
+                io_uring_sqe* pSQE = GetSQE();
+                pSQE->opcode       = IORING_OP_NOP;
+                pSQE->user_data    = 0;
+                SubmitSQEs();
+            }
+            m_CompletionThread.join();
+        }
+
+        if (m_pSQEs != nullptr)
+            munmap(m_pSQEs, m_SQEsSize);
+        if (m_pCQRing != nullptr && m_pCQRing != m_pSQRing)
+            munmap(m_pCQRing, m_CQRingSize);
+        if (m_pSQRing != nullptr)
+            munmap(m_pSQRing, m_SQRingSize);
+        if (m_RingFd >= 0)
+            close(m_RingFd);
+        if (m_Fd >= 0)
+            close(m_Fd);
+    }
+
+protected:
+    virtual void Submit(Uint64 Offset, size_t Size, Uint8* pDst, ReadCallbackType&& Callback) override final
+    {
+        std::lock_guard<std::mutex> Lock{m_SubmitMtx};
+        // Reads that do not fit into the queue are submitted when the slots are released.
+        // This way Submit() never blocks and may be called from the callbacks.
+        m_Backlog.emplace_back(Request{Offset, Size, pDst, 0, std::move(Callback), {}});
+        SubmitBacklog();
+    }
+
+private:
+    struct Request
+    {
+        Uint64           Offset       = 0;
+        size_t           Size         = 0;
+        Uint8*           pDst         = nullptr;
+        size_t           NumBytesRead = 0;
+        ReadCallbackType Callback;
+        iovec            Vec;
+    };
+
+    IoUringFileReader(int Fd, Uint64 Size) noexcept :
+        Impl{Size, AsyncFileReader::BACKEND_IO_URING},
+        m_Fd{Fd}
+    {}
+
+    bool Initialize(Uint32 QueueSize)
+    {
+        io_uring_params Params;
+        memset(&Params, 0, sizeof(Params));
+        m_RingFd = static_cast<int>(syscall(__NR_io_uring_setup, std::max(QueueSize, 1u), &Params));
+        if (m_RingFd < 0)
+            return false;
+
+        m_SQRingSize = Params.sq_off.array + Params.sq_entries * sizeof(__u32);
+        m_CQRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+        if (Params.features & IORING_FEAT_SINGLE_MMAP)
+            m_SQRingSize = m_CQRingSize = std::max(m_SQRingSize, m_CQRingSize);
+
+        void* pSQRing = mmap(nullptr, m_SQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_SQ_RING);
+        if (pSQRing == MAP_FAILED)
+            return false;
+        m_pSQRing = static_cast<Uint8*>(pSQRing);
+
+        if (Params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            m_pCQRing = m_pSQRing;
+        }
+        else
+        {
+            void* pCQRing = mmap(nullptr, m_CQRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_CQ_RING);
+            if (pCQRing == MAP_FAILED)
+                return false;
+            m_pCQRing = static_cast<Uint8*>(pCQRing);
+        }
+
+        m_SQEsSize  = Params.sq_entries * sizeof(io_uring_sqe);
+        void* pSQEs = mmap(nullptr, m_SQEsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_RingFd, IORING_OFF_SQES);
+        if (pSQEs == MAP_FAILED)
+            return false;
+        m_pSQEs = static_cast<io_uring_sqe*>(pSQEs);
+
+        m_pSQHead  = reinterpret_cast<__u32*>(m_pSQRing + Params.sq_off.head);
+        m_pSQTail  = reinterpret_cast<__u32*>(m_pSQRing + Params.sq_off.tail);
+        m_SQMask   = *reinterpret_cast<__u32*>(m_pSQRing + Params.sq_off.ring_mask);
+        m_pSQArray = reinterpret_cast<__u32*>(m_pSQRing + Params.sq_off.array);
+        m_pCQHead  = reinterpret_cast<__u32*>(m_pCQRing + Params.cq_off.head);
+        m_pCQTail  = reinterpret_cast<__u32*>(m_pCQRing + Params.cq_off.tail);
+        m_CQMask   = *reinterpret_cast<__u32*>(m_pCQRing + Params.cq_off.ring_mask);
+        m_pCQEs    = reinterpret_cast<io_uring_cqe*>(m_pCQRing + Params.cq_off.cqes);
+
+        // One slot is reserved for the no-op entry that stops the completion thread.
+        // The completion queue is at least as large as the submission queue, so it never overflows.
+        const Uint32 NumSlots = Params.sq_entries > 1 ? Params.sq_entries - 1 : 1;
+        m_Slots.resize(NumSlots);
+        for (Uint32 i = 0; i < NumSlots; ++i)
+            m_FreeSlots.push_back(NumSlots - 1 - i);
+
+        try
+        {
+            m_CompletionThread = std::thread{[this]() { CompletionThread(); }};
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // Must be called with the submit mutex locked
+    io_uring_sqe* GetSQE()
+    {
+        const __u32 Tail = *m_pSQTail;
+        VERIFY_EXPR(Tail - __atomic_load_n(m_pSQHead, __ATOMIC_ACQUIRE) <= m_SQMask);
+
+        const __u32   Idx  = Tail & m_SQMask;
+        io_uring_sqe* pSQE = &m_pSQEs[Idx];
+        memset(pSQE, 0, sizeof(*pSQE));
+        m_pSQArray[Idx] = Idx;
+        // The entry becomes visible to the kernel when the tail is updated
+        __atomic_store_n(m_pSQTail, Tail + 1, __ATOMIC_RELEASE);
+        ++m_NumUnsubmitted;
+        return pSQE;
+    }
+
+    // Must be called with the submit mutex locked
+    void SubmitSQEs()
+    {
+        while (m_NumUnsubmitted > 0)
+        {
+            const long Res = syscall(__NR_io_uring_enter, m_RingFd, m_NumUnsubmitted, 0, 0, nullptr, 0);
+            if (Res < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                    continue;
+                // The entries remain in the queue and will be submitted by the next call
+                LOG_ERROR_MESSAGE("io_uring_enter failed: ", strerror(errno));
+                return;
+            }
+            m_NumUnsubmitted -= std::min(static_cast<Uint32>(Res), m_NumUnsubmitted);
+        }
+    }
+
+    // Must be called with the submit mutex locked
+    void SubmitRead(Uint32 SlotIdx)
+    {
+        Request& Req = m_Slots[SlotIdx];
+
+        Req.Vec.iov_base = Req.pDst + Req.NumBytesRead;
+        Req.Vec.iov_len  = Req.Size - Req.NumBytesRead;
+
+        io_uring_sqe* pSQE = GetSQE();
+        // IORING_OP_READV is available since the first io_uring release (Linux 5.1)
+        pSQE->opcode    = IORING_OP_READV;
+        pSQE->fd        = m_Fd;
+        pSQE->off       = Req.Offset + Req.NumBytesRead;
+        pSQE->addr      = reinterpret_cast<__u64>(&Req.Vec);
+        pSQE->len       = 1;
+        pSQE->user_data = Uint64{SlotIdx} + 1;
+    }
+
+    // Must be called with the submit mutex locked
+    void SubmitBacklog()
+    {
+        while (!m_Backlog.empty() && !m_FreeSlots.empty())
+        {
+            const Uint32 SlotIdx = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+            m_Slots[SlotIdx] = std::move(m_Backlog.front());
+            m_Backlog.pop_front();
+            SubmitRead(SlotIdx);
+        }
+        SubmitSQEs();
+    }
+
+    void CompletionThread()
+    {
+        while (true)
+        {
+            // Only this thread updates the head
+            const __u32 Head = *m_pCQHead;
+            if (Head == __atomic_load_n(m_pCQTail, __ATOMIC_ACQUIRE))
+            {
+                syscall(__NR_io_uring_enter, m_RingFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                continue;
+            }
+
+            const io_uring_cqe CQE = m_pCQEs[Head & m_CQMask];
+            __atomic_store_n(m_pCQHead, Head + 1, __ATOMIC_RELEASE);
+
+            if (CQE.user_data == 0)
+                return;
+
+            const Uint32     SlotIdx = static_cast<Uint32>(CQE.user_data - 1);
+            ReadCallbackType Callback;
+            size_t           NumBytesRead = 0;
+            bool             Success      = false;
+            {
+                std::lock_guard<std::mutex> Lock{m_SubmitMtx};
+
+                Request& Req = m_Slots[SlotIdx];
+                if (CQE.res > 0)
+                    Req.NumBytesRead += static_cast<size_t>(CQE.res);
+
+                // Short reads are continued, interrupted reads are retried
+                if ((CQE.res > 0 && Req.NumBytesRead < Req.Size) || CQE.res == -EINTR || CQE.res == -EAGAIN)
+                {
+                    SubmitRead(SlotIdx);
+                    SubmitSQEs();
+                    continue;
+                }
+
+                Callback     = std::move(Req.Callback);
+                NumBytesRead = Req.NumBytesRead;
+                Success      = NumBytesRead == Req.Size;
+                Req          = {};
+                m_FreeSlots.push_back(SlotIdx);
+                SubmitBacklog();
+            }
+            Complete(Callback, Success, NumBytesRead);
+        }
+    }
+
+private:
+    int m_Fd     = -1;
+    int m_RingFd = -1;
+
+    Uint8*        m_pSQRing    = nullptr;
+    Uint8*        m_pCQRing    = nullptr;
+    size_t        m_SQRingSize = 0;
+    size_t        m_CQRingSize = 0;
+    io_uring_sqe* m_pSQEs      = nullptr;
+    size_t        m_SQEsSize   = 0;
+
+    __u32*        m_pSQHead  = nullptr;
+    __u32*        m_pSQTail  = nullptr;
+    __u32*        m_pSQArray = nullptr;
+    __u32         m_SQMask   = 0;
+    __u32*        m_pCQHead  = nullptr;
+    __u32*        m_pCQTail  = nullptr;
+    io_uring_cqe* m_pCQEs    = nullptr;
+    __u32         m_CQMask   = 0;
+
+    std::mutex           m_SubmitMtx;
+    Uint32               m_NumUnsubmitted = 0;
+    std::vector<Request> m_Slots;
+    std::vector<Uint32>  m_FreeSlots;
+    std::deque<Request>  m_Backlog;
+
+    std::thread m_CompletionThread;
+};
+
+#endif // DILIGENT_IO_URING
+
+#if PLATFORM_WIN32
+
+// Issues overlapped reads and waits for their completion on the I/O completion port.
+class IOCPFileReader final : public AsyncFileReader::Impl
+{
+public:
+    struct OpenedFile
+    {
+        HANDLE hFile = INVALID_HANDLE_VALUE;
+        Uint64 Size  = 0;
+    };
+
+    static OpenedFile OpenFile(const Char* strFilePath) noexcept(false)
+    {
+        std::wstring PathW;
+        if (int Len = MultiByteToWideChar(CP_UTF8, 0, strFilePath, -1, nullptr, 0))
+        {
+            PathW.resize(static_cast<size_t>(Len));
+            MultiByteToWideChar(CP_UTF8, 0, strFilePath, -1, &PathW[0], Len);
+        }
+
+        OpenedFile File;
+        File.hFile = CreateFileW(PathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+        if (File.hFile == INVALID_HANDLE_VALUE)
+            LOG_ERROR_AND_THROW("Failed to open file '", strFilePath, "'. Error code: ", GetLastError());
+
+        LARGE_INTEGER FileSize = {};
+        if (!GetFileSizeEx(File.hFile, &FileSize))
+        {
+            const DWORD Err = GetLastError();
+            CloseHandle(File.hFile);
+            LOG_ERROR_AND_THROW("Failed to get the size of file '", strFilePath, "'. Error code: ", Err);
+        }
+        File.Size = static_cast<Uint64>(FileSize.QuadPart);
+        return File;
+    }
+
+    // Takes the ownership of the file, even if the constructor throws
+    explicit IOCPFileReader(const OpenedFile& File) noexcept(false) :
+        Impl{File.Size, AsyncFileReader::BACKEND_IOCP},
+        m_hFile{File.hFile}
+    {
+        m_hPort = CreateIoCompletionPort(m_hFile, nullptr, 0, 1);
+        if (m_hPort == nullptr)
+        {
+            const DWORD Err = GetLastError();
+            CloseHandle(m_hFile);
+            LOG_ERROR_AND_THROW("Failed to create the I/O completion port. Error code: ", Err);
+        }
+
+        try
+        {
+            m_CompletionThread = std::thread{[this]() { CompletionThread(); }};
+        }
+        catch (...)
+        {
+            CloseHandle(m_hPort);
+            CloseHandle(m_hFile);
+            throw;
+        }
+    }
+
+    ~IOCPFileReader()
+    {
+        WaitIdle();
+        PostQueuedCompletionStatus(m_hPort, 0, ShutdownKey, nullptr);
+        m_CompletionThread.join();
+        CloseHandle(m_hPort);
+        CloseHandle(m_hFile);
+    }
+
+protected:
+    virtual void Submit(Uint64 Offset, size_t Size, Uint8* pDst, ReadCallbackType&& Callback) override final
+    {
+        Request* pReq  = new Request{};
+        pReq->Offset   = Offset;
+        pReq->Size     = Size;
+        pReq->pDst     = pDst;
+        pReq->Callback = std::move(Callback);
+        IssueRead(pReq);
+    }
+
+private:
+    static constexpr ULONG_PTR ShutdownKey = 1;
+
+    struct Request
+    {
+        // Must be the first member so that the request can be obtained from the OVERLAPPED pointer
+        OVERLAPPED       Overlapped;
+        Uint64           Offset       = 0;
+        size_t           Size         = 0;
+        Uint8*           pDst         = nullptr;
+        size_t           NumBytesRead = 0;
+        ReadCallbackType Callback;
+    };
+
+    void IssueRead(Request* pReq)
+    {
+        const Uint64 Offset = pReq->Offset + pReq->NumBytesRead;
+        // ReadFile takes a 32-bit size, so large reads are split into chunks
+        const DWORD ChunkSize = static_cast<DWORD>(std::min<size_t>(pReq->Size - pReq->NumBytesRead, size_t{1} << 30));
+
+        memset(&pReq->Overlapped, 0, sizeof(pReq->Overlapped));
+        pReq->Overlapped.Offset     = static_cast<DWORD>(Offset & 0xFFFFFFFFu);
+        pReq->Overlapped.OffsetHigh = static_cast<DWORD>(Offset >> 32u);
+        // The completion is posted to the port even if the read completes synchronously
+        if (!ReadFile(m_hFile, pReq->pDst + pReq->NumBytesRead, ChunkSize, nullptr, &pReq->Overlapped) && GetLastError() != ERROR_IO_PENDING)
+            FinishRequest(pReq);
+    }
+
+    void FinishRequest(Request* pReq)
+    {
+        Complete(pReq->Callback, pReq->NumBytesRead == pReq->Size, pReq->NumBytesRead);
+        delete pReq;
+    }
+
+    void CompletionThread()
+    {
+        while (true)
+        {
+            DWORD       NumBytes    = 0;
+            ULONG_PTR   Key         = 0;
+            OVERLAPPED* pOverlapped = nullptr;
+            const BOOL  Res         = GetQueuedCompletionStatus(m_hPort, &NumBytes, &Key, &pOverlapped, INFINITE);
+            if (pOverlapped == nullptr)
+            {
+                if (Key == ShutdownKey || !Res)
+                    return;
+                continue;
+            }
+
+            Request* pReq = reinterpret_cast<Request*>(pOverlapped);
+            if (Res && NumBytes > 0)
+            {
+                pReq->NumBytesRead += NumBytes;
+                if (pReq->NumBytesRead < pReq->Size)
+                {
+                    IssueRead(pReq);
+                    continue;
+                }
+            }
+            FinishRequest(pReq);
+        }
+    }
+
+private:
+    HANDLE      m_hFile = INVALID_HANDLE_VALUE;
+    HANDLE      m_hPort = nullptr;
+    std::thread m_CompletionThread;
+};
+
+#endif // PLATFORM_WIN32
+
+} // namespace
+
+AsyncFileReader::AsyncFileReader(const Char* strFilePath, Uint32 NumWorkerThreads, Uint32 QueueSize) noexcept(false)
+{
+    if (strFilePath == nullptr || strFilePath[0] == '\0')
+    {
+        LOG_ERROR_AND_THROW("File path must not be null or empty");
+    }
+
+#if PLATFORM_WIN32
+    (void)NumWorkerThreads;
+    (void)QueueSize;
+    m_pImpl.reset(new IOCPFileReader{IOCPFileReader::OpenFile(strFilePath)});
+#else
+    const OpenedFile File = OpenFile(strFilePath);
+#    if DILIGENT_IO_URING
+    m_pImpl = IoUringFileReader::Create(File, QueueSize);
+#    else
+    (void)QueueSize;
+#    endif
+    // io_uring may not be supported by the kernel or may be disabled (e.g. by seccomp in containers)
+    if (!m_pImpl)
+        m_pImpl.reset(new ThreadsFileReader{File, NumWorkerThreads});
+#endif
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+}
+
+void AsyncFileReader::ReadAsync(Uint64 Offset, size_t Size, void* pDst, ReadCallbackType Callback)
+{
+    m_pImpl->Read(Offset, Size, pDst, std::move(Callback));
+}
+
+void AsyncFileReader::WaitIdle()
+{
+    m_pImpl->WaitIdle();
+}
+
+Uint64 AsyncFileReader::GetSize() const
+{
+    return m_pImpl->GetSize();
+}
+
+AsyncFileReader::BACKEND AsyncFileReader::GetBackend() const
+{
+    return m_pImpl->GetBackend();
+}
+
+} // namespace Diligent
@@ -27,6 +27,9 @@
 #include "BasicPlatformMisc.hpp"
 #include "DebugUtilities.hpp"
 
+#include <algorithm>
+#include <thread>
+
 namespace Diligent
 {
 
@@ -48,4 +51,19 @@ Uint64 BasicPlatformMisc::SetCurrentThreadAffinity(Uint64 Mask)
     return 0;
 }
 
+CPUTopologyInfo BasicPlatformMisc::GetCPUTopology()
+{
+    CPUTopologyInfo Topology;
+    Topology.NumLogicalCores     = (std::max)(std::thread::hardware_concurrency(), 1u);
+    Topology.NumPhysicalCores    = Topology.NumLogicalCores;
+    Topology.NumPerformanceCores = Topology.NumLogicalCores;
+
+    Topology.LogicalCoresMask     = Topology.NumLogicalCores < 64 ? (Uint64{1} << Topology.NumLogicalCores) - 1 : ~Uint64{0};
+    Topology.PerformanceCoresMask = Topology.LogicalCoresMask;
+    Topology.PrimaryThreadsMask   = Topology.LogicalCoresMask;
+    Topology.NUMANodeMasks[0]     = Topology.LogicalCoresMask;
+
+    return Topology;
+}
+
 } // namespace Diligent
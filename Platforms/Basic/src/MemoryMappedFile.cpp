@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MemoryMappedFile.hpp"
+
+#include "Errors.hpp"
+
+#if PLATFORM_WIN32
+#    include "../../Win32/interface/WinHPreface.h"
+#    include <Windows.h>
+#    include "../../Win32/interface/WinHPostface.h"
+#    include <string>
+#elif PLATFORM_LINUX || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS || PLATFORM_ANDROID
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include <errno.h>
+#    include <string.h>
+#    define DILIGENT_POSIX_MMAP 1
+#endif
+
+namespace Diligent
+{
+
+bool MemoryMappedFile::IsSupported()
+{
+#if PLATFORM_WIN32 || defined(DILIGENT_POSIX_MMAP)
+    return true;
+#else
+    return false;
+#endif
+}
+
+MemoryMappedFile::MemoryMappedFile(const Char* strFilePath) noexcept(false)
+{
+    if (strFilePath == nullptr || strFilePath[0] == '\0')
+    {
+        LOG_ERROR_AND_THROW("File path must not be null or empty");
+    }
+
+#if PLATFORM_WIN32
+    std::wstring PathW;
+    if (int Len = MultiByteToWideChar(CP_UTF8, 0, strFilePath, -1, nullptr, 0))
+    {
+        PathW.resize(static_cast<size_t>(Len));
+        MultiByteToWideChar(CP_UTF8, 0, strFilePath, -1, &PathW[0], Len);
+    }
+
+    HANDLE hFile = CreateFileW(PathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        LOG_ERROR_AND_THROW("Failed to open file '", strFilePath, "'. Error code: ", GetLastError());
+    }
+
+    LARGE_INTEGER FileSize = {};
+    if (!GetFileSizeEx(hFile, &FileSize))
+    {
+        const auto Err = GetLastError();
+        CloseHandle(hFile);
+        LOG_ERROR_AND_THROW("Failed to get the size of file '", strFilePath, "'. Error code: ", Err);
+    }
+
+    m_Size = static_cast<size_t>(FileSize.QuadPart);
+    if (m_Size > 0)
+    {
+        // PAGE_WRITECOPY + FILE_MAP_COPY give a private copy-on-write view
+        HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (hMapping != nullptr)
+        {
+            m_pData = MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+            // The view keeps references to the mapping and the file, so the handles can be closed.
+            CloseHandle(hMapping);
+        }
+    }
+    const auto Err = GetLastError();
+    CloseHandle(hFile);
+
+    if (m_Size > 0 && m_pData == nullptr)
+    {
+        LOG_ERROR_AND_THROW("Failed to map file '", strFilePath, "'. Error code: ", Err);
+    }
+#elif defined(DILIGENT_POSIX_MMAP)
+    const int fd = open(strFilePath, O_RDONLY);
+    if (fd < 0)
+    {
+        LOG_ERROR_AND_THROW("Failed to open file '", strFilePath, "': ", strerror(errno));
+    }
+
+    struct stat StatBuff;
+    if (fstat(fd, &StatBuff) != 0)
+    {
+        const int Err = errno;
+        close(fd);
+        LOG_ERROR_AND_THROW("Failed to get the size of file '", strFilePath, "': ", strerror(Err));
+    }
+
+    m_Size = static_cast<size_t>(StatBuff.st_size);
+    if (m_Size > 0)
+    {
+        // MAP_PRIVATE gives a copy-on-write view and does not require write access to the file
+        void* pData = mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (pData == MAP_FAILED)
+        {
+            const int Err = errno;
+            close(fd);
+            LOG_ERROR_AND_THROW("Failed to map file '", strFilePath, "': ", strerror(Err));
+        }
+        m_pData = pData;
+    }
+
+    // The mapping remains valid after the file descriptor is closed
+    close(fd);
+#else
+    LOG_ERROR_AND_THROW("Memory-mapped files are not supported on this platform");
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (m_pData == nullptr)
+        return;
+
+#if PLATFORM_WIN32
+    UnmapViewOfFile(m_pData);
+#elif defined(DILIGENT_POSIX_MMAP)
+    munmap(m_pData, m_Size);
+#endif
+}
+
+} // namespace Diligent
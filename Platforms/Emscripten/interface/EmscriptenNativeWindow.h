@@ -33,6 +33,15 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 
 struct EmscriptenNativeWindow
 {
+    /// CSS selector of the canvas element, e.g. "#canvas".
+
+    /// \remarks   The device and swap chain may be created on a worker thread. In this case,
+    ///            the canvas should be transferred to the worker as an OffscreenCanvas
+    ///            (see emscripten_pthread_attr_settransferredcanvases) and the engine must
+    ///            be built with DILIGENT_EMSCRIPTEN_OFFSCREEN_CANVAS. The worker then owns
+    ///            the device, and frames are presented when it returns to the event loop.
+    ///            In OpenGL backend, if the canvas was not transferred, the context is
+    ///            proxied to the main thread.
     const char* pCanvasId DEFAULT_INITIALIZER(nullptr);
 #if DILIGENT_CPP_INTERFACE
     EmscriptenNativeWindow() noexcept
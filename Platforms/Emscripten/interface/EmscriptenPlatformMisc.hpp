@@ -33,6 +33,21 @@ namespace Diligent
 {
 
 struct EmscriptenMisc : public LinuxMisc
-{};
+{
+    static ThreadPriority GetCurrentThreadPriority()
+    {
+        return BasicPlatformMisc::GetCurrentThreadPriority();
+    }
+
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority)
+    {
+        return BasicPlatformMisc::SetCurrentThreadPriority(Priority);
+    }
+
+    static CPUTopologyInfo GetCPUTopology()
+    {
+        return BasicPlatformMisc::GetCPUTopology();
+    }
+};
 
 } // namespace Diligent
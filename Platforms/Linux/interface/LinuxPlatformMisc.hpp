@@ -111,6 +111,18 @@ struct LinuxMisc : public BasicPlatformMisc
     /// Sets the current thread affinity mask and on success returns the previous mask.
     /// On failure, returns 0.
     static Uint64 SetCurrentThreadAffinity(Uint64 Mask);
+
+    static ThreadPriority GetCurrentThreadPriority();
+
+    /// Sets the current thread priority and on success returns the previous priority.
+    /// On failure, returns ThreadPriority::Unknown.
+    ///
+    /// \remarks   The priority is set through the thread nice value. Raising the priority
+    ///            above normal typically requires the CAP_SYS_NICE capability.
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
+
+    /// Returns the CPU topology information read from sysfs.
+    static CPUTopologyInfo GetCPUTopology();
 };
 
 } // namespace Diligent
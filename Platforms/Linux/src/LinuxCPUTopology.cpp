@@ -0,0 +1,205 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "LinuxPlatformMisc.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <unistd.h>
+
+namespace Diligent
+{
+
+namespace
+{
+
+bool ReadSysFile(const std::string& Path, std::string& Content)
+{
+    std::ifstream File{Path};
+    if (!File.is_open())
+        return false;
+
+    std::getline(File, Content);
+    return !File.fail();
+}
+
+bool ReadSysFile(const std::string& Path, Uint64& Value)
+{
+    std::string Content;
+    if (!ReadSysFile(Path, Content))
+        return false;
+
+    char* pEnd = nullptr;
+    Value      = std::strtoull(Content.c_str(), &pEnd, 10);
+    return pEnd != Content.c_str();
+}
+
+// Parses a CPU list such as "0-3,8,10-11" into a bit mask.
+Uint64 ParseCPUList(const std::string& List)
+{
+    Uint64 Mask = 0;
+
+    const char* pos = List.c_str();
+    while (*pos != '\0')
+    {
+        char*               pEnd  = nullptr;
+        const unsigned long First = std::strtoul(pos, &pEnd, 10);
+        if (pEnd == pos)
+            break;
+        pos = pEnd;
+
+        unsigned long Last = First;
+        if (*pos == '-')
+        {
+            ++pos;
+            Last = std::strtoul(pos, &pEnd, 10);
+            if (pEnd == pos)
+                break;
+            pos = pEnd;
+        }
+
+        for (unsigned long cpu = First; cpu <= Last && cpu < 64; ++cpu)
+            Mask |= Uint64{1} << cpu;
+
+        if (*pos == ',')
+            ++pos;
+    }
+
+    return Mask;
+}
+
+} // namespace
+
+CPUTopologyInfo LinuxMisc::GetCPUTopology()
+{
+    const long NumConfiguredCPUs = sysconf(_SC_NPROCESSORS_CONF);
+    if (NumConfiguredCPUs <= 0)
+        return BasicPlatformMisc::GetCPUTopology();
+
+    const std::string CPUSysPath = "/sys/devices/system/cpu/cpu";
+
+    CPUTopologyInfo Topology;
+
+    std::string OnlineCPUs;
+    const Uint64 OnlineMask = ReadSysFile("/sys/devices/system/cpu/online", OnlineCPUs) ? ParseCPUList(OnlineCPUs) : ~Uint64{0};
+
+    // (package id, core id) pairs of the physical cores found so far
+    std::unordered_set<Uint64> PhysicalCores;
+
+    Uint64 MinCapacity    = ~Uint64{0};
+    Uint64 MaxCapacity    = 0;
+    Uint64 Capacities[64] = {};
+    for (Uint32 cpu = 0; cpu < static_cast<Uint32>(NumConfiguredCPUs); ++cpu)
+    {
+        if (cpu < 64 && (OnlineMask & (Uint64{1} << cpu)) == 0)
+            continue;
+
+        ++Topology.NumLogicalCores;
+
+        const std::string TopologyPath = CPUSysPath + std::to_string(cpu) + "/topology/";
+
+        Uint64 PackageId = 0;
+        Uint64 CoreId    = cpu;
+        ReadSysFile(TopologyPath + "physical_package_id", PackageId);
+        ReadSysFile(TopologyPath + "core_id", CoreId);
+
+        const bool IsPrimaryThread = PhysicalCores.insert((PackageId << 32u) | CoreId).second;
+        if (cpu >= 64)
+            continue;
+
+        const Uint64 CPUBit = Uint64{1} << cpu;
+        Topology.LogicalCoresMask |= CPUBit;
+        if (IsPrimaryThread)
+            Topology.PrimaryThreadsMask |= CPUBit;
+
+        // On ARM big.LITTLE systems, cpu_capacity reflects the relative performance of the core.
+        // If it is not available, use the maximum frequency.
+        Uint64 Capacity = 0;
+        if (!ReadSysFile(CPUSysPath + std::to_string(cpu) + "/cpu_capacity", Capacity))
+            ReadSysFile(CPUSysPath + std::to_string(cpu) + "/cpufreq/cpuinfo_max_freq", Capacity);
+        Capacities[cpu] = Capacity;
+        if (Capacity != 0)
+        {
+            MinCapacity = (std::min)(MinCapacity, Capacity);
+            MaxCapacity = (std::max)(MaxCapacity, Capacity);
+        }
+    }
+    Topology.NumPhysicalCores = static_cast<Uint32>(PhysicalCores.size());
+
+    // Intel hybrid CPUs expose separate PMUs for the P-cores and E-cores
+    std::string CoreCPUs, AtomCPUs;
+    if (ReadSysFile("/sys/devices/cpu_core/cpus", CoreCPUs) && ReadSysFile("/sys/devices/cpu_atom/cpus", AtomCPUs))
+    {
+        Topology.PerformanceCoresMask = ParseCPUList(CoreCPUs) & Topology.LogicalCoresMask;
+        Topology.EfficiencyCoresMask  = ParseCPUList(AtomCPUs) & Topology.LogicalCoresMask;
+    }
+    else if (MaxCapacity > MinCapacity && MinCapacity != 0)
+    {
+        // Cores with the lowest capacity are the efficiency cores. On tri-cluster
+        // ARM CPUs, both prime and big cores are treated as performance cores.
+        for (Uint32 cpu = 0; cpu < 64; ++cpu)
+        {
+            const Uint64 CPUBit = Uint64{1} << cpu;
+            if ((Topology.LogicalCoresMask & CPUBit) == 0)
+                continue;
+
+            if (Capacities[cpu] == MinCapacity)
+                Topology.EfficiencyCoresMask |= CPUBit;
+            else
+                Topology.PerformanceCoresMask |= CPUBit;
+        }
+    }
+    else
+    {
+        Topology.PerformanceCoresMask = Topology.LogicalCoresMask;
+    }
+    Topology.NumPerformanceCores = CountOneBits(Topology.PerformanceCoresMask);
+    Topology.NumEfficiencyCores  = CountOneBits(Topology.EfficiencyCoresMask);
+
+    Topology.NumNUMANodes = 0;
+    for (Uint32 node = 0; node < CPUTopologyInfo::MaxNUMANodes; ++node)
+    {
+        std::string NodeCPUs;
+        if (!ReadSysFile("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", NodeCPUs))
+            break;
+
+        Topology.NUMANodeMasks[node] = ParseCPUList(NodeCPUs) & Topology.LogicalCoresMask;
+        ++Topology.NumNUMANodes;
+    }
+    if (Topology.NumNUMANodes == 0)
+    {
+        Topology.NumNUMANodes     = 1;
+        Topology.NUMANodeMasks[0] = Topology.LogicalCoresMask;
+    }
+
+    return Topology;
+}
+
+} // namespace Diligent
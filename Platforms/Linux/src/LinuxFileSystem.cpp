@@ -184,7 +184,11 @@ LinuxFileSystem::SearchFilesResult LinuxFileSystem::Search(const Char* SearchPat
 
             std::string FileName;
             GetPathComponents(path, nullptr, &FileName);
-            SearchRes.emplace_back(FindFileData{std::move(FileName), S_ISDIR(StatBuff.st_mode)});
+            FindFileData FileData{std::move(FileName), S_ISDIR(StatBuff.st_mode)};
+            if (!FileData.IsDirectory)
+                FileData.Size = static_cast<Uint64>(StatBuff.st_size);
+            FileData.LastWriteTime = static_cast<Uint64>(StatBuff.st_mtime);
+            SearchRes.emplace_back(std::move(FileData));
         }
     }
     globfree(&glob_result);
@@ -27,6 +27,10 @@
 #include "LinuxPlatformMisc.hpp"
 
 #include <pthread.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
 
 namespace Diligent
 {
@@ -60,4 +64,62 @@ Uint64 LinuxMisc::SetCurrentThreadAffinity(Uint64 Mask)
         return 0;
 }
 
+static ThreadPriority NiceValueToThreadPriority(int NiceValue)
+{
+    if (NiceValue >= 15)
+        return ThreadPriority::Lowest;
+    else if (NiceValue > 0)
+        return ThreadPriority::BelowNormal;
+    else if (NiceValue == 0)
+        return ThreadPriority::Normal;
+    else if (NiceValue > -10)
+        return ThreadPriority::AboveNormal;
+    else
+        return ThreadPriority::Highest;
+}
+
+static int ThreadPriorityToNiceValue(ThreadPriority Priority)
+{
+    switch (Priority)
+    {
+        // clang-format off
+        case ThreadPriority::Lowest:      return 19;
+        case ThreadPriority::BelowNormal: return 10;
+        case ThreadPriority::Normal:      return 0;
+        case ThreadPriority::AboveNormal: return -5;
+        case ThreadPriority::Highest:     return -10;
+        default:                          return 0;
+            // clang-format on
+    }
+}
+
+ThreadPriority LinuxMisc::GetCurrentThreadPriority()
+{
+    // On Linux, the nice value is a per-thread attribute
+    const auto ThreadId = static_cast<id_t>(syscall(SYS_gettid));
+
+    errno               = 0;
+    const int NiceValue = getpriority(PRIO_PROCESS, ThreadId);
+    if (NiceValue == -1 && errno != 0)
+        return ThreadPriority::Unknown;
+
+    return NiceValueToThreadPriority(NiceValue);
+}
+
+ThreadPriority LinuxMisc::SetCurrentThreadPriority(ThreadPriority Priority)
+{
+    if (Priority == ThreadPriority::Unknown)
+        return ThreadPriority::Unknown;
+
+    const ThreadPriority OrigPriority = GetCurrentThreadPriority();
+    if (OrigPriority == ThreadPriority::Unknown)
+        return ThreadPriority::Unknown;
+
+    const auto ThreadId = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, ThreadId, ThreadPriorityToNiceValue(Priority)) != 0)
+        return ThreadPriority::Unknown;
+
+    return OrigPriority;
+}
+
 } // namespace Diligent
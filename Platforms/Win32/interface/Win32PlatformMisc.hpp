@@ -173,6 +173,11 @@ struct WindowsMisc : public BasicPlatformMisc
     /// Sets the current thread priority and on success returns the previous priority.
     /// On failure, returns ThreadPriority::Unknown.
     static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
+
+    /// Returns the CPU topology information.
+
+    /// \remarks   Core masks only describe the logical cores of processor group 0.
+    static CPUTopologyInfo GetCPUTopology();
 #endif
 };
 
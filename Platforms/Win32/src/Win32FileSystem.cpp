@@ -441,7 +441,16 @@ WindowsFileSystem::SearchFilesResult WindowsFileSystem::Search(const Char* Searc
         if (IsDot(ffd.cFileName) || IsDblDot(ffd.cFileName))
             continue;
 
-        SearchRes.emplace_back(FindFileData{ffd.cFileName, (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0});
+        FindFileData FileData{ffd.cFileName, (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0};
+        if (!FileData.IsDirectory)
+            FileData.Size = (Uint64{ffd.nFileSizeHigh} << 32u) | Uint64{ffd.nFileSizeLow};
+
+        // FILETIME is the number of 100-nanosecond intervals since January 1, 1601
+        constexpr Uint64 FileTimeToUnixEpoch = 116444736000000000ull;
+
+        const Uint64 FileTime  = (Uint64{ffd.ftLastWriteTime.dwHighDateTime} << 32u) | Uint64{ffd.ftLastWriteTime.dwLowDateTime};
+        FileData.LastWriteTime = FileTime > FileTimeToUnixEpoch ? (FileTime - FileTimeToUnixEpoch) / 10000000ull : 0;
+        SearchRes.emplace_back(std::move(FileData));
     } while (FindNextFileA(hFind, &ffd) != 0);
 
     auto dwError = GetLastError();
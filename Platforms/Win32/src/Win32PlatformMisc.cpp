@@ -30,6 +30,9 @@
 #include <Windows.h>
 #include "WinHPostface.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace Diligent
 {
 
@@ -88,4 +91,79 @@ ThreadPriority WindowsMisc::SetCurrentThreadPriority(ThreadPriority Priority)
         return ThreadPriority::Unknown;
 }
 
+CPUTopologyInfo WindowsMisc::GetCPUTopology()
+{
+    DWORD BufferSize = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &BufferSize);
+    if (BufferSize == 0)
+        return BasicPlatformMisc::GetCPUTopology();
+
+    std::vector<Uint8> Buffer(BufferSize);
+    if (!GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(Buffer.data()), &BufferSize))
+        return BasicPlatformMisc::GetCPUTopology();
+
+    struct PhysicalCoreInfo
+    {
+        Uint64 Mask;
+        BYTE   EfficiencyClass;
+    };
+    std::vector<PhysicalCoreInfo> PhysicalCores;
+
+    CPUTopologyInfo Topology;
+    Topology.NumNUMANodes = 0;
+
+    BYTE MaxEfficiencyClass = 0;
+    for (size_t Offset = 0; Offset < BufferSize;)
+    {
+        const auto& Info = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(Buffer.data() + Offset);
+        if (Info.Relationship == RelationProcessorCore)
+        {
+            for (WORD i = 0; i < Info.Processor.GroupCount; ++i)
+            {
+                const GROUP_AFFINITY& Affinity = Info.Processor.GroupMask[i];
+                Topology.NumLogicalCores += CountOneBits(static_cast<Uint64>(Affinity.Mask));
+            }
+            ++Topology.NumPhysicalCores;
+
+            // Core masks only cover processor group 0, which matches the thread affinity mask
+            const GROUP_AFFINITY& Affinity = Info.Processor.GroupMask[0];
+            if (Affinity.Group == 0 && Affinity.Mask != 0)
+            {
+                PhysicalCores.push_back({static_cast<Uint64>(Affinity.Mask), Info.Processor.EfficiencyClass});
+                MaxEfficiencyClass = (std::max)(MaxEfficiencyClass, Info.Processor.EfficiencyClass);
+            }
+        }
+        else if (Info.Relationship == RelationNumaNode)
+        {
+            if (Topology.NumNUMANodes < CPUTopologyInfo::MaxNUMANodes && Info.NumaNode.GroupMask.Group == 0)
+                Topology.NUMANodeMasks[Topology.NumNUMANodes] = static_cast<Uint64>(Info.NumaNode.GroupMask.Mask);
+            ++Topology.NumNUMANodes;
+        }
+        Offset += Info.Size;
+    }
+
+    for (const PhysicalCoreInfo& Core : PhysicalCores)
+    {
+        Topology.LogicalCoresMask |= Core.Mask;
+        Topology.PrimaryThreadsMask |= Uint64{1} << GetLSB(Core.Mask);
+
+        // Higher efficiency class means higher performance. On non-hybrid CPUs,
+        // all cores have the same class and are treated as performance cores.
+        if (Core.EfficiencyClass == MaxEfficiencyClass)
+            Topology.PerformanceCoresMask |= Core.Mask;
+        else
+            Topology.EfficiencyCoresMask |= Core.Mask;
+    }
+    Topology.NumPerformanceCores = CountOneBits(Topology.PerformanceCoresMask);
+    Topology.NumEfficiencyCores  = CountOneBits(Topology.EfficiencyCoresMask);
+
+    if (Topology.NumNUMANodes == 0)
+    {
+        Topology.NumNUMANodes     = 1;
+        Topology.NUMANodeMasks[0] = Topology.LogicalCoresMask;
+    }
+
+    return Topology;
+}
+
 } // namespace Diligent
@@ -0,0 +1,285 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cstdlib>
+#include <new>
+
+#include "GPUTestingEnvironment.hpp"
+#include "TrackingMemoryAllocator.hpp"
+#include "MapHelper.hpp"
+#include "BasicMath.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+// Replace the global operators new and delete to count the allocations made through the
+// standard library (e.g. by std containers), which bypass the engine's raw memory allocator.
+// This file is built into its own executable (DiligentCoreAPITest-ZeroAllocation), so that
+// the replacement does not affect the other API tests.
+void* operator new(size_t Size)
+{
+    void* Ptr = std::malloc(Size != 0 ? Size : 1);
+    if (Ptr == nullptr)
+        throw std::bad_alloc{};
+    TrackingMemoryAllocator::RecordAllocation(Size);
+    return Ptr;
+}
+
+void* operator new[](size_t Size)
+{
+    return operator new(Size);
+}
+
+void operator delete(void* Ptr) noexcept
+{
+    if (Ptr == nullptr)
+        return;
+    TrackingMemoryAllocator::RecordFree();
+    std::free(Ptr);
+}
+
+void operator delete[](void* Ptr) noexcept
+{
+    operator delete(Ptr);
+}
+
+void operator delete(void* Ptr, size_t) noexcept
+{
+    operator delete(Ptr);
+}
+
+void operator delete[](void* Ptr, size_t) noexcept
+{
+    operator delete(Ptr);
+}
+
+namespace
+{
+
+// clang-format off
+const std::string ZeroAllocationTest_VS{
+R"(
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+void main(in uint VertId : SV_VertexID,
+          out PSInput PSIn)
+{
+    float4 Pos[4];
+    Pos[0] = float4(-0.5, -0.5, 0.0, 1.0);
+    Pos[1] = float4(-0.5, +0.5, 0.0, 1.0);
+    Pos[2] = float4(+0.5, -0.5, 0.0, 1.0);
+    Pos[3] = float4(+0.5, +0.5, 0.0, 1.0);
+
+    PSIn.Pos = Pos[VertId];
+}
+)"
+};
+
+const std::string ZeroAllocationTest_PS{
+R"(
+cbuffer Constants
+{
+    float4 g_Color;
+};
+
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    return g_Color;
+}
+)"
+};
+// clang-format on
+
+class ZeroAllocationTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        GPUTestingEnvironment* pEnv    = GPUTestingEnvironment::GetInstance();
+        IRenderDevice*         pDevice = pEnv->GetDevice();
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Zero allocation test render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = 128;
+        TexDesc.Height    = 128;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+        TexDesc.Usage     = USAGE_DEFAULT;
+        RefCntAutoPtr<ITexture> pRenderTarget;
+        pDevice->CreateTexture(TexDesc, nullptr, &pRenderTarget);
+        ASSERT_NE(pRenderTarget, nullptr);
+        sm_pRTV = pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        ASSERT_NE(sm_pRTV, nullptr);
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Zero allocation test constants";
+        BuffDesc.Size           = sizeof(float4);
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &sm_pConstants);
+        ASSERT_NE(sm_pConstants, nullptr);
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PipelineStateDesc&              PSODesc          = PSOCreateInfo.PSODesc;
+        GraphicsPipelineDesc&           GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name = "Zero allocation test PSO";
+
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = TexDesc.Format;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc   = {"Zero allocation test VS", SHADER_TYPE_VERTEX, true};
+            ShaderCI.Source = ZeroAllocationTest_VS.c_str();
+            pDevice->CreateShader(ShaderCI, &pVS);
+            ASSERT_NE(pVS, nullptr);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc   = {"Zero allocation test PS", SHADER_TYPE_PIXEL, true};
+            ShaderCI.Source = ZeroAllocationTest_PS.c_str();
+            pDevice->CreateShader(ShaderCI, &pPS);
+            ASSERT_NE(pPS, nullptr);
+        }
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pPSO);
+        ASSERT_NE(sm_pPSO, nullptr);
+
+        IShaderResourceVariable* pConstantsVar = sm_pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "Constants");
+        ASSERT_NE(pConstantsVar, nullptr);
+        pConstantsVar->Set(sm_pConstants);
+
+        sm_pPSO->CreateShaderResourceBinding(&sm_pSRB, true);
+        ASSERT_NE(sm_pSRB, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pSRB.Release();
+        sm_pPSO.Release();
+        sm_pConstants.Release();
+        sm_pRTV.Release();
+
+        GPUTestingEnvironment::GetInstance()->Reset();
+    }
+
+    static void RecordFrame(IDeviceContext* pContext, Uint32 Frame)
+    {
+        ITextureView* pRTVs[] = {sm_pRTV};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        for (Uint32 i = 0; i < NumDrawsPerFrame; ++i)
+        {
+            {
+                MapHelper<float4> Color{pContext, sm_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+                *Color = float4{static_cast<float>(Frame % 2), static_cast<float>(i) / NumDrawsPerFrame, 0, 1};
+            }
+
+            pContext->SetPipelineState(sm_pPSO);
+            pContext->CommitShaderResources(sm_pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            pContext->Draw(DrawAttribs{4, DRAW_FLAG_VERIFY_ALL});
+        }
+
+        pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    }
+
+    static constexpr Uint32 NumDrawsPerFrame = 16;
+    static constexpr Uint32 NumWarmUpFrames  = 8;
+    static constexpr Uint32 NumTestFrames    = 4;
+
+    static RefCntAutoPtr<ITextureView>           sm_pRTV;
+    static RefCntAutoPtr<IBuffer>                sm_pConstants;
+    static RefCntAutoPtr<IPipelineState>         sm_pPSO;
+    static RefCntAutoPtr<IShaderResourceBinding> sm_pSRB;
+};
+
+RefCntAutoPtr<ITextureView>           ZeroAllocationTest::sm_pRTV;
+RefCntAutoPtr<IBuffer>                ZeroAllocationTest::sm_pConstants;
+RefCntAutoPtr<IPipelineState>         ZeroAllocationTest::sm_pPSO;
+RefCntAutoPtr<IShaderResourceBinding> ZeroAllocationTest::sm_pSRB;
+
+// Once the caches and pools have been warmed up, recording a frame must not allocate any memory.
+TEST_F(ZeroAllocationTest, SteadyStateDraw)
+{
+    if (!TrackingMemoryAllocator::IsEnabled())
+    {
+        GTEST_SKIP() << "Allocation tracking is only enabled in debug and development builds";
+    }
+
+    GPUTestingEnvironment* pEnv     = GPUTestingEnvironment::GetInstance();
+    IDeviceContext*        pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    for (Uint32 Frame = 0; Frame < NumWarmUpFrames; ++Frame)
+    {
+        RecordFrame(pContext, Frame);
+        pContext->Flush();
+        pContext->FinishFrame();
+    }
+
+    for (Uint32 Frame = 0; Frame < NumTestFrames; ++Frame)
+    {
+        const AllocationCounters StartCounters = TrackingMemoryAllocator::GetThreadCounters();
+
+        RecordFrame(pContext, NumWarmUpFrames + Frame);
+
+        const AllocationCounters EndCounters = TrackingMemoryAllocator::GetThreadCounters();
+        EXPECT_EQ(EndCounters.NumAllocations, StartCounters.NumAllocations)
+            << "Frame " << Frame << " made " << (EndCounters.NumAllocations - StartCounters.NumAllocations)
+            << " allocation(s) totaling " << (EndCounters.AllocatedBytes - StartCounters.AllocatedBytes) << " bytes";
+
+        pContext->Flush();
+        pContext->FinishFrame();
+    }
+}
+
+} // namespace
@@ -35,6 +35,9 @@
 #include "SerializedPipelineState.h"
 #include "SerializedShader.h"
 #include "ShaderMacroHelper.hpp"
+#include "PipelineStateWarmUp.hpp"
+#include "ThreadPool.hpp"
+#include "MemoryFileStream.hpp"
 
 #include "ResourceLayoutTestCommon.hpp"
 #include "gtest/gtest.h"
@@ -189,7 +192,8 @@ void UnpackPRS(IDataBlob*                  pArchive,
                const char*                 PRS1Name,
                const char*                 PRS2Name,
                IPipelineResourceSignature* pRefPRS_1,
-               IPipelineResourceSignature* pRefPRS_2)
+               IPipelineResourceSignature* pRefPRS_2,
+               bool                        FromStream = false)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
     auto* pDevice          = pEnv->GetDevice();
@@ -203,7 +207,16 @@ void UnpackPRS(IDataBlob*                  pArchive,
         GTEST_SKIP() << "Archiver library is not loaded";
 
     EXPECT_TRUE(pArchiverFactory->PrintArchiveContent(pArchive));
-    pDearchiver->LoadArchive(pArchive, ContentVersion);
+    if (FromStream)
+    {
+        RefCntAutoPtr<IFileStream> pStream{MemoryFileStream::Create(pArchive)};
+        ASSERT_NE(pStream, nullptr);
+        ASSERT_TRUE(pDearchiver->LoadArchiveFromStream(pStream, ContentVersion));
+    }
+    else
+    {
+        pDearchiver->LoadArchive(pArchive, ContentVersion);
+    }
 
     // Unpack PRS 1
     {
@@ -267,6 +280,18 @@ TEST(ArchiveTest, ResourceSignature)
     UnpackPRS(pArchive, PRS1Name, PRS2Name, pRefPRS_1, pRefPRS_2);
 }
 
+TEST(ArchiveTest, ResourceSignature_FromStream)
+{
+    constexpr char PRS1Name[] = "ArchiveTest.ResourceSignature_FromStream - PRS 1";
+    constexpr char PRS2Name[] = "ArchiveTest.ResourceSignature_FromStream - PRS 2";
+
+    RefCntAutoPtr<IDataBlob>                  pArchive;
+    RefCntAutoPtr<IPipelineResourceSignature> pRefPRS_1;
+    RefCntAutoPtr<IPipelineResourceSignature> pRefPRS_2;
+    ArchivePRS(pArchive, PRS1Name, PRS2Name, pRefPRS_1, pRefPRS_2, GetDeviceBits());
+    UnpackPRS(pArchive, PRS1Name, PRS2Name, pRefPRS_1, pRefPRS_2, /*FromStream = */ true);
+}
+
 
 TEST(ArchiveTest, RemoveDeviceData)
 {
@@ -1211,7 +1236,7 @@ TEST(ArchiveTest, GraphicsPipeline_Async)
     TestGraphicsPipeline(PSO_ARCHIVE_FLAG_NONE, /*CompileAsync = */ true);
 }
 
-void ArchiveGraphicsShaders(bool CompileAsync)
+void ArchiveGraphicsShaders(bool CompileAsync, bool CompressShaders = false)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
     auto* pDevice          = pEnv->GetDevice();
@@ -1228,6 +1253,7 @@ void ArchiveGraphicsShaders(bool CompileAsync)
     SerializationDeviceCreateInfo SerDeviceCI;
     SerDeviceCI.DeviceInfo.Features.SeparablePrograms = pDevice->GetDeviceInfo().Features.SeparablePrograms;
     SerDeviceCI.NumAsyncShaderCompilationThreads      = CompileAsync ? 4 : 0;
+    SerDeviceCI.CompressShaders                       = CompressShaders;
     RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
     pArchiverFactory->CreateSerializationDevice(SerDeviceCI, &pSerializationDevice);
     ASSERT_NE(pSerializationDevice, nullptr);
@@ -1243,9 +1269,9 @@ void ArchiveGraphicsShaders(bool CompileAsync)
         VertexShaderCI.CompileFlags = SHADER_COMPILE_FLAG_ASYNCHRONOUS;
         PixelShaderCI.CompileFlags  = SHADER_COMPILE_FLAG_ASYNCHRONOUS;
     }
-    RefCntAutoPtr<IShader> pSerializedVS, pSerializedVS2;
-    RefCntAutoPtr<IShader> pSerializedPS, pSerializedPS2;
-    CreateGraphicsShaders(pDevice, pSerializationDevice, VertexShaderCI, nullptr, &pSerializedVS, PixelShaderCI, nullptr, &pSerializedPS);
+    RefCntAutoPtr<IShader> pRefVS, pSerializedVS, pSerializedVS2;
+    RefCntAutoPtr<IShader> pRefPS, pSerializedPS, pSerializedPS2;
+    CreateGraphicsShaders(pDevice, pSerializationDevice, VertexShaderCI, &pRefVS, &pSerializedVS, PixelShaderCI, &pRefPS, &pSerializedPS);
     CreateGraphicsShaders(pDevice, pSerializationDevice, VertexShaderCI, nullptr, &pSerializedVS2, PixelShaderCI, nullptr, &pSerializedPS2);
 
     EXPECT_TRUE(pArchiver->AddShader(pSerializedVS));
@@ -1266,7 +1292,7 @@ void ArchiveGraphicsShaders(bool CompileAsync)
 
     pDearchiver->LoadArchive(pArchive, ContentVersion);
 
-    auto UnpackShader = [](IRenderDevice* pDevice, IDearchiver* pDearchiver, const ShaderCreateInfo& CI) {
+    auto UnpackShader = [](IRenderDevice* pDevice, IDearchiver* pDearchiver, const ShaderCreateInfo& CI, IShader* pRefShader) {
         RefCntAutoPtr<IShader> pUnpackedShader;
 
         ShaderUnpackInfo UnpackInfo;
@@ -1277,9 +1303,29 @@ void ArchiveGraphicsShaders(bool CompileAsync)
         ASSERT_NE(pUnpackedShader, nullptr);
         EXPECT_EQ(pUnpackedShader->GetDesc(), CI.Desc);
         EXPECT_STREQ(pUnpackedShader->GetDesc().Name, CI.Desc.Name);
+
+        if (pDevice->GetDeviceInfo().IsD3DDevice())
+        {
+            // Resources must match the shader compiled from the source. Note that Direct3D12 shaders
+            // are unpacked with the archived resources instead of the bytecode reflection.
+            ASSERT_EQ(pRefShader->GetStatus(/*WaitForCompletion = */ true), SHADER_STATUS_READY);
+            ASSERT_EQ(pUnpackedShader->GetResourceCount(), pRefShader->GetResourceCount());
+            for (Uint32 i = 0; i < pRefShader->GetResourceCount(); ++i)
+            {
+                ShaderResourceDesc RefDesc, UnpackedDesc;
+                pRefShader->GetResourceDesc(i, RefDesc);
+                pUnpackedShader->GetResourceDesc(i, UnpackedDesc);
+                EXPECT_EQ(UnpackedDesc, RefDesc);
+            }
+        }
+
+        // Unpacked shaders are cached by the dearchiver
+        RefCntAutoPtr<IShader> pUnpackedShader2;
+        pDearchiver->UnpackShader(UnpackInfo, &pUnpackedShader2);
+        EXPECT_EQ(pUnpackedShader2, pUnpackedShader);
     };
-    UnpackShader(pDevice, pDearchiver, VertexShaderCI);
-    UnpackShader(pDevice, pDearchiver, PixelShaderCI);
+    UnpackShader(pDevice, pDearchiver, VertexShaderCI, pRefVS);
+    UnpackShader(pDevice, pDearchiver, PixelShaderCI, pRefPS);
 }
 
 TEST(ArchiveTest, Shaders)
@@ -1292,6 +1338,11 @@ TEST(ArchiveTest, Shaders_Async)
     ArchiveGraphicsShaders(true);
 }
 
+TEST(ArchiveTest, Shaders_Compressed)
+{
+    ArchiveGraphicsShaders(false, /*CompressShaders = */ true);
+}
+
 namespace HLSL
 {
 
@@ -1316,6 +1367,96 @@ void main(uint3 DTid : SV_DispatchThreadID)
 } // namespace HLSL
 
 
+void TestShaderDeduplication(bool CompileInParallel)
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+    if (!pArchiverFactory)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    SerializationDeviceCreateInfo SerDeviceCI;
+    SerDeviceCI.NumAsyncShaderCompilationThreads = CompileInParallel ? 4 : 0;
+    RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+    pArchiverFactory->CreateSerializationDevice(SerDeviceCI, &pSerializationDevice);
+    ASSERT_NE(pSerializationDevice, nullptr);
+
+    auto DeviceBits = GetDeviceBits();
+#if PLATFORM_MACOS
+    // Compute shaders are not supported in OpenGL on MacOS
+    DeviceBits &= ~(ARCHIVE_DEVICE_DATA_FLAG_GL | ARCHIVE_DEVICE_DATA_FLAG_GLES);
+#endif
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc           = {"Shader deduplication test", SHADER_TYPE_COMPUTE, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = HLSL::ComputePSOTest_CS.c_str();
+
+    RefCntAutoPtr<IShader> pShader1;
+    pSerializationDevice->CreateShader(ShaderCI, ShaderArchiveInfo{DeviceBits}, &pShader1);
+    ASSERT_NE(pShader1, nullptr);
+
+    RefCntAutoPtr<ISerializedShader> pSerializedShader{pShader1, IID_SerializedShader};
+    ASSERT_NE(pSerializedShader, nullptr);
+    for (const auto Type : {RENDER_DEVICE_TYPE_D3D11, RENDER_DEVICE_TYPE_D3D12, RENDER_DEVICE_TYPE_VULKAN})
+    {
+        if (DeviceBits & RenderDeviceTypeToArchiveDataFlag(Type))
+            EXPECT_NE(pSerializedShader->GetDeviceShader(Type), nullptr);
+    }
+
+    // Identical shader must not be compiled again
+    {
+        RefCntAutoPtr<IShader> pShader2;
+        pSerializationDevice->CreateShader(ShaderCI, ShaderArchiveInfo{DeviceBits}, &pShader2);
+        EXPECT_EQ(pShader1, pShader2);
+    }
+
+    // Different name
+    {
+        ShaderCreateInfo ShaderCI2 = ShaderCI;
+        ShaderCI2.Desc.Name        = "Shader deduplication test 2";
+
+        RefCntAutoPtr<IShader> pShader2;
+        pSerializationDevice->CreateShader(ShaderCI2, ShaderArchiveInfo{DeviceBits}, &pShader2);
+        ASSERT_NE(pShader2, nullptr);
+        EXPECT_NE(pShader1, pShader2);
+    }
+
+    // Different macros
+    {
+        ShaderMacroHelper Macros;
+        Macros.AddShaderMacro("TEST_MACRO", 1);
+
+        ShaderCreateInfo ShaderCI2 = ShaderCI;
+        ShaderCI2.Macros           = Macros;
+
+        RefCntAutoPtr<IShader> pShader2;
+        pSerializationDevice->CreateShader(ShaderCI2, ShaderArchiveInfo{DeviceBits}, &pShader2);
+        ASSERT_NE(pShader2, nullptr);
+        EXPECT_NE(pShader1, pShader2);
+    }
+
+    // Compiler output is requested
+    {
+        RefCntAutoPtr<IShader>   pShader2;
+        RefCntAutoPtr<IDataBlob> pCompilerOutput;
+        pSerializationDevice->CreateShader(ShaderCI, ShaderArchiveInfo{DeviceBits}, &pShader2, &pCompilerOutput);
+        ASSERT_NE(pShader2, nullptr);
+        EXPECT_NE(pShader1, pShader2);
+    }
+}
+
+TEST(ArchiveTest, ShaderDeduplication)
+{
+    TestShaderDeduplication(false);
+}
+
+TEST(ArchiveTest, ShaderDeduplication_Parallel)
+{
+    TestShaderDeduplication(true);
+}
+
 void CreateComputeShader(IRenderDevice*        pDevice,
                          ISerializationDevice* pSerializationDevice,
                          ShaderCreateInfo&     ShaderCI,
@@ -1560,6 +1701,143 @@ TEST(ArchiveTest, ComputePipeline_SplitArchive_Async)
     TestComputePipeline(PSO_ARCHIVE_FLAG_DO_NOT_PACK_SIGNATURES, /*CompileAsync = */ true);
 }
 
+TEST(ArchiveTest, PipelineStateWarmUp)
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pDevice          = pEnv->GetDevice();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+
+    RefCntAutoPtr<IDearchiver> pDearchiver;
+    DearchiverCreateInfo       DearchiverCI{};
+    pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &pDearchiver);
+    if (!pDearchiver || !pArchiverFactory)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by device";
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    SerializationDeviceCreateInfo SerDeviceCI;
+    SerDeviceCI.DeviceInfo.Features.SeparablePrograms = pDevice->GetDeviceInfo().Features.SeparablePrograms;
+    RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+    pArchiverFactory->CreateSerializationDevice(SerDeviceCI, &pSerializationDevice);
+    ASSERT_NE(pSerializationDevice, nullptr);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pSerializedPRS;
+    {
+        constexpr PipelineResourceDesc Resources[] = {
+            {SHADER_TYPE_COMPUTE, "g_tex2DUAV", 1, SHADER_RESOURCE_TYPE_TEXTURE_UAV, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, PIPELINE_RESOURCE_FLAG_NONE, {WEB_GPU_BINDING_TYPE_WRITE_ONLY_TEXTURE_UAV, RESOURCE_DIM_TEX_2D, TEX_FORMAT_RGBA8_UNORM}},
+        };
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name         = "ArchiveTest.PipelineStateWarmUp - PRS";
+        PRSDesc.Resources    = Resources;
+        PRSDesc.NumResources = _countof(Resources);
+
+        pSerializationDevice->CreatePipelineResourceSignature(PRSDesc, ResourceSignatureArchiveInfo{GetDeviceBits()}, &pSerializedPRS);
+        ASSERT_NE(pSerializedPRS, nullptr);
+    }
+
+    constexpr Uint32         NumPSOs = 16;
+    std::vector<std::string> PSONames(NumPSOs);
+    {
+        RefCntAutoPtr<IArchiver> pArchiver;
+        pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
+        ASSERT_NE(pArchiver, nullptr);
+
+        ShaderCreateInfo       ShaderCI;
+        RefCntAutoPtr<IShader> pCS;
+        RefCntAutoPtr<IShader> pSerializedCS;
+        CreateComputeShader(pDevice, pSerializationDevice, ShaderCI, &pCS, &pSerializedCS);
+        ASSERT_NE(pSerializedCS, nullptr);
+
+        for (Uint32 i = 0; i < NumPSOs; ++i)
+        {
+            PSONames[i] = "ArchiveTest.PipelineStateWarmUp - PSO " + std::to_string(i);
+
+            ComputePipelineStateCreateInfo PSOCreateInfo;
+            PSOCreateInfo.PSODesc.Name         = PSONames[i].c_str();
+            PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+            PSOCreateInfo.pCS                  = pSerializedCS;
+
+            IPipelineResourceSignature* Signatures[] = {pSerializedPRS};
+            PSOCreateInfo.ResourceSignaturesCount    = _countof(Signatures);
+            PSOCreateInfo.ppResourceSignatures       = Signatures;
+
+            PipelineStateArchiveInfo ArchiveInfo;
+            ArchiveInfo.DeviceFlags = GetDeviceBits();
+#if PLATFORM_MACOS
+            // Compute shaders are not supported in OpenGL on MacOS
+            ArchiveInfo.DeviceFlags &= ~(ARCHIVE_DEVICE_DATA_FLAG_GL | ARCHIVE_DEVICE_DATA_FLAG_GLES);
+#endif
+            RefCntAutoPtr<IPipelineState> pSerializedPSO;
+            pSerializationDevice->CreateComputePipelineState(PSOCreateInfo, ArchiveInfo, &pSerializedPSO);
+            ASSERT_NE(pSerializedPSO, nullptr);
+            ASSERT_TRUE(pArchiver->AddPipelineState(pSerializedPSO));
+        }
+
+        RefCntAutoPtr<IDataBlob> pArchive;
+        pArchiver->SerializeToBlob(ContentVersion, &pArchive);
+        ASSERT_NE(pArchive, nullptr);
+        ASSERT_TRUE(pDearchiver->LoadArchive(pArchive, ContentVersion));
+    }
+
+    std::vector<PipelineStateUnpackInfo> UnpackInfos(NumPSOs + 1);
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        UnpackInfos[i].Name         = PSONames[i].c_str();
+        UnpackInfos[i].PipelineType = PIPELINE_TYPE_COMPUTE;
+    }
+    UnpackInfos[NumPSOs].Name         = "Non-existing PSO name";
+    UnpackInfos[NumPSOs].PipelineType = PIPELINE_TYPE_COMPUTE;
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    PipelineStateWarmUpCreateInfo WarmUpCI;
+    WarmUpCI.pDevice           = pDevice;
+    WarmUpCI.pDearchiver       = pDearchiver;
+    WarmUpCI.pThreadPool       = pThreadPool;
+    WarmUpCI.pUnpackInfos      = UnpackInfos.data();
+    WarmUpCI.NumPipelineStates = static_cast<Uint32>(UnpackInfos.size());
+
+    pEnv->SetErrorAllowance(1);
+    PipelineStateWarmUp WarmUp{WarmUpCI};
+    EXPECT_EQ(WarmUp.GetNumPipelineStates(), NumPSOs + 1);
+
+    WarmUp.WaitForCompletion();
+    EXPECT_TRUE(WarmUp.IsComplete());
+    EXPECT_EQ(WarmUp.GetNumCompleted(), NumPSOs + 1);
+    EXPECT_EQ(WarmUp.GetNumFailed(), 1u);
+    EXPECT_EQ(WarmUp.GetProgress(), 1.f);
+    EXPECT_EQ(WarmUp.GetPipelineState(NumPSOs), nullptr);
+
+    IPipelineResourceSignature* pPRS = nullptr;
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        IPipelineState* pPSO = WarmUp.GetPipelineState(i);
+        ASSERT_NE(pPSO, nullptr) << PSONames[i];
+        EXPECT_STREQ(pPSO->GetDesc().Name, PSONames[i].c_str());
+
+        // All pipelines must share the same signature object
+        if (pPRS == nullptr)
+            pPRS = pPSO->GetResourceSignature(0);
+        EXPECT_EQ(pPSO->GetResourceSignature(0), pPRS);
+    }
+
+    // Pipelines unpacked by the warm-up must be found in the dearchiver cache
+    {
+        PipelineStateUnpackInfo UnpackInfo;
+        UnpackInfo.Name         = PSONames[0].c_str();
+        UnpackInfo.pDevice      = pDevice;
+        UnpackInfo.PipelineType = PIPELINE_TYPE_COMPUTE;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDearchiver->UnpackPipelineState(UnpackInfo, &pPSO);
+        EXPECT_EQ(pPSO, WarmUp.GetPipelineState(0));
+    }
+}
+
 void TestRayTracingPipeline(bool CompileAsync = false)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
@@ -2767,4 +3045,139 @@ TEST(ArchiveTest, MergeArchives)
     }
 }
 
+TEST(ArchiveTest, DeltaArchive)
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pDevice          = pEnv->GetDevice();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RefCntAutoPtr<IDearchiver> pDearchiver;
+    DearchiverCreateInfo       DearchiverCI{};
+    DearchiverCI.AllowOverrides = True;
+    pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &pDearchiver);
+    if (!pDearchiver || !pArchiverFactory)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    SerializationDeviceCreateInfo SerDeviceCI;
+    SerDeviceCI.DeviceInfo.Features.SeparablePrograms = pDevice->GetDeviceInfo().Features.SeparablePrograms;
+    RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+    pArchiverFactory->CreateSerializationDevice(SerDeviceCI, &pSerializationDevice);
+    ASSERT_NE(pSerializationDevice, nullptr);
+
+    RefCntAutoPtr<IArchiver> pArchiver;
+    pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
+    ASSERT_NE(pArchiver, nullptr);
+
+    constexpr char PRS1Name[] = "ArchiveTest.DeltaArchive - PRS 1";
+    constexpr char PRS2Name[] = "ArchiveTest.DeltaArchive - PRS 2";
+
+    RefCntAutoPtr<IPipelineResourceSignature> pRefPRS_1;
+    RefCntAutoPtr<IPipelineResourceSignature> pRefPRS_2;
+    RefCntAutoPtr<IDataBlob>                  pPRSArchive1;
+    RefCntAutoPtr<IDataBlob>                  pPRSArchive2;
+    ArchivePRS(pPRSArchive1, PRS1Name, nullptr, pRefPRS_1, pRefPRS_2, GetDeviceBits());
+    ArchivePRS(pPRSArchive2, nullptr, PRS2Name, pRefPRS_1, pRefPRS_2, GetDeviceBits());
+
+    RefCntAutoPtr<IDataBlob> pCSArchive;
+    ShaderCreateInfo         CsCI;
+    {
+        RefCntAutoPtr<IShader> pSerCS;
+        CreateComputeShader(pDevice, pSerializationDevice, CsCI, nullptr, &pSerCS);
+        ASSERT_NE(pSerCS, nullptr);
+
+        EXPECT_TRUE(pArchiver->AddShader(pSerCS));
+
+        pArchiver->SerializeToBlob(ContentVersion, &pCSArchive);
+        ASSERT_NE(pCSArchive, nullptr);
+        pArchiver->Reset();
+    }
+
+    RefCntAutoPtr<IDataBlob> pGraphicsShadersArchive;
+    ShaderCreateInfo         VsCI;
+    ShaderCreateInfo         PsCI;
+    {
+        RefCntAutoPtr<IShader> pSerVS;
+        RefCntAutoPtr<IShader> pSerPS;
+        CreateGraphicsShaders(pDevice, pSerializationDevice, VsCI, nullptr, &pSerVS, PsCI, nullptr, &pSerPS);
+        ASSERT_NE(pSerVS, nullptr);
+        ASSERT_NE(pSerPS, nullptr);
+
+        EXPECT_TRUE(pArchiver->AddShader(pSerVS));
+        EXPECT_TRUE(pArchiver->AddShader(pSerPS));
+
+        pArchiver->SerializeToBlob(ContentVersion, &pGraphicsShadersArchive);
+        ASSERT_NE(pGraphicsShadersArchive, nullptr);
+    }
+
+    RefCntAutoPtr<IDataBlob> pBaseArchive;
+    {
+        const IDataBlob* ppArchives[] = {pPRSArchive1, pCSArchive};
+        pArchiverFactory->MergeArchives(ppArchives, _countof(ppArchives), &pBaseArchive);
+        ASSERT_NE(pBaseArchive, nullptr);
+    }
+
+    RefCntAutoPtr<IDataBlob> pNewArchive;
+    {
+        const IDataBlob* ppArchives[] = {pPRSArchive1, pPRSArchive2, pCSArchive, pGraphicsShadersArchive};
+        pArchiverFactory->MergeArchives(ppArchives, _countof(ppArchives), &pNewArchive);
+        ASSERT_NE(pNewArchive, nullptr);
+    }
+
+    // The delta only contains PRS 2 and the graphics shaders
+    RefCntAutoPtr<IDataBlob> pDeltaArchive;
+    pArchiverFactory->CreateDeltaArchive(pBaseArchive, pNewArchive, &pDeltaArchive);
+    ASSERT_NE(pDeltaArchive, nullptr);
+    EXPECT_TRUE(pArchiverFactory->PrintArchiveContent(pDeltaArchive));
+    EXPECT_LT(pDeltaArchive->GetSize(), pNewArchive->GetSize());
+
+    {
+        RefCntAutoPtr<IDataBlob> pEmptyDelta;
+        pArchiverFactory->CreateDeltaArchive(pNewArchive, pNewArchive, &pEmptyDelta);
+        ASSERT_NE(pEmptyDelta, nullptr);
+        EXPECT_LT(pEmptyDelta->GetSize(), pDeltaArchive->GetSize());
+    }
+
+    pPRSArchive1.Release();
+    pPRSArchive2.Release();
+    pCSArchive.Release();
+    pGraphicsShadersArchive.Release();
+
+    // Resources that are not in the delta are not found
+    UnpackPRS(pDeltaArchive, PRS1Name, PRS2Name, nullptr, pRefPRS_2);
+
+    EXPECT_TRUE(pDearchiver->LoadArchive(pBaseArchive, ContentVersion));
+    EXPECT_TRUE(pDearchiver->LoadArchive(pDeltaArchive, ContentVersion));
+    // Resources that are already loaded from the base are overridden without errors
+    EXPECT_TRUE(pDearchiver->LoadArchive(pNewArchive, ContentVersion));
+
+    auto UnpackShader = [](IRenderDevice* pDevice, IDearchiver* pDearchiver, const ShaderCreateInfo& CI) {
+        RefCntAutoPtr<IShader> pUnpackedShader;
+
+        ShaderUnpackInfo UnpackInfo;
+        UnpackInfo.Name    = CI.Desc.Name;
+        UnpackInfo.pDevice = pDevice;
+
+        pDearchiver->UnpackShader(UnpackInfo, &pUnpackedShader);
+        ASSERT_NE(pUnpackedShader, nullptr);
+        EXPECT_EQ(pUnpackedShader->GetDesc(), CI.Desc);
+    };
+
+    UnpackShader(pDevice, pDearchiver, VsCI);
+    UnpackShader(pDevice, pDearchiver, PsCI);
+    UnpackShader(pDevice, pDearchiver, CsCI);
+
+    for (const char* PRSName : {PRS1Name, PRS2Name})
+    {
+        ResourceSignatureUnpackInfo UnpackInfo;
+        UnpackInfo.Name    = PRSName;
+        UnpackInfo.pDevice = pDevice;
+
+        RefCntAutoPtr<IPipelineResourceSignature> pUnpackedPRS;
+        pDearchiver->UnpackResourceSignature(UnpackInfo, &pUnpackedPRS);
+        EXPECT_NE(pUnpackedPRS, nullptr) << PRSName;
+    }
+}
+
 } // namespace
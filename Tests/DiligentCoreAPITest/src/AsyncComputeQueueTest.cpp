@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "AsyncComputeQueue.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "MapHelper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(AsyncComputeQueueTest, FillBuffer)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    IDeviceContext* pGraphicsCtx = nullptr;
+    IDeviceContext* pComputeCtx  = nullptr;
+    for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts(); ++CtxInd)
+    {
+        auto*       Ctx       = pEnv->GetDeviceContext(CtxInd);
+        const auto& Desc      = Ctx->GetDesc();
+        const auto  QueueType = Desc.QueueType & (COMMAND_QUEUE_TYPE_GRAPHICS | COMMAND_QUEUE_TYPE_COMPUTE);
+
+        if (!pGraphicsCtx && QueueType == COMMAND_QUEUE_TYPE_GRAPHICS)
+            pGraphicsCtx = Ctx;
+        else if (!pComputeCtx && QueueType == COMMAND_QUEUE_TYPE_COMPUTE)
+            pComputeCtx = Ctx;
+    }
+    if (!pGraphicsCtx || !pComputeCtx)
+    {
+        GTEST_SKIP() << "Async compute queue is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    static constexpr char CSSource[] = R"(
+RWStructuredBuffer<uint> g_Output;
+
+[numthreads(64, 1, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    g_Output[DTid.x] = g_Output[DTid.x] * 2u + 1u;
+}
+)";
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc           = {"Async compute queue test - CS", SHADER_TYPE_COMPUTE, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = CSSource;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    const Uint64 QueueMask = (Uint64{1} << pGraphicsCtx->GetDesc().ContextId) | (Uint64{1} << pComputeCtx->GetDesc().ContextId);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                               = "Async compute queue test";
+    PSOCreateInfo.PSODesc.ImmediateContextMask               = QueueMask;
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    PSOCreateInfo.pCS                                        = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    constexpr Uint32 NumElements = 256;
+
+    std::vector<Uint32> InitValues(NumElements);
+    for (Uint32 i = 0; i < NumElements; ++i)
+        InitValues[i] = i;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name                 = "Async compute queue test - buffer";
+    BuffDesc.Size                 = sizeof(Uint32) * NumElements;
+    BuffDesc.BindFlags            = BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode                 = BUFFER_MODE_STRUCTURED;
+    BuffDesc.ElementByteStride    = sizeof(Uint32);
+    BuffDesc.ImmediateContextMask = QueueMask;
+
+    BufferData InitData{InitValues.data(), BuffDesc.Size, pGraphicsCtx};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    BuffDesc.Name                 = "Async compute queue test - staging buffer";
+    BuffDesc.BindFlags            = BIND_NONE;
+    BuffDesc.Mode                 = BUFFER_MODE_UNDEFINED;
+    BuffDesc.ElementByteStride    = 0;
+    BuffDesc.Usage                = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags       = CPU_ACCESS_READ;
+    BuffDesc.ImmediateContextMask = Uint64{1} << pGraphicsCtx->GetDesc().ContextId;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    AsyncComputeQueue ComputeQueue{pDevice, pComputeCtx};
+
+    const AsyncComputeResource   Resources[] = {{pBuffer, RESOURCE_STATE_UNORDERED_ACCESS}};
+    const DispatchComputeAttribs Dispatch{NumElements / 64, 1, 1};
+
+    AsyncComputeJob Job;
+    Job.Name          = "Async compute queue test";
+    Job.pPSO          = pPSO;
+    Job.pSRB          = pSRB;
+    Job.pDispatches   = &Dispatch;
+    Job.NumDispatches = 1;
+    Job.pResources    = Resources;
+    Job.NumResources  = _countof(Resources);
+
+    // Two jobs back to back must be executed in order
+    AsyncComputeToken Token0 = ComputeQueue.Submit(pGraphicsCtx, Job);
+    AsyncComputeToken Token1 = ComputeQueue.Submit(pGraphicsCtx, Job);
+    ASSERT_TRUE(Token0.IsValid());
+    ASSERT_TRUE(Token1.IsValid());
+    EXPECT_LT(Token0.FenceValue, Token1.FenceValue);
+
+    ComputeQueue.Wait(pGraphicsCtx, Token1);
+    pGraphicsCtx->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pStagingBuffer, 0, BuffDesc.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pGraphicsCtx->WaitForIdle();
+
+    ComputeQueue.WaitForCompletion(Token1);
+    EXPECT_TRUE(ComputeQueue.IsComplete(Token0));
+    EXPECT_TRUE(ComputeQueue.IsComplete(Token1));
+
+    MapHelper<Uint32> Data{pGraphicsCtx, pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT};
+    ASSERT_NE(Data, nullptr);
+    for (Uint32 i = 0; i < NumElements; ++i)
+    {
+        EXPECT_EQ(Data[i], (i * 2 + 1) * 2 + 1) << "i=" << i;
+    }
+}
+
+} // namespace
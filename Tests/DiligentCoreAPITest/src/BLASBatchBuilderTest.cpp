@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BLASBatchBuilder.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(BLASBatchBuilderTest, BuildAndCompact)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    if (!pEnv->SupportsRayTracing())
+    {
+        GTEST_SKIP() << "Ray tracing is not supported by this device";
+    }
+
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    // clang-format off
+    const float3 Vertices[] =
+    {
+        float3{0.25f, 0.25f, 0.0f},
+        float3{0.75f, 0.25f, 0.0f},
+        float3{0.50f, 0.75f, 0.0f},
+        float3{0.25f, 0.75f, 0.5f},
+        float3{0.75f, 0.75f, 0.5f},
+        float3{0.50f, 0.25f, 0.5f}
+    };
+    // clang-format on
+
+    RefCntAutoPtr<IBuffer> pVertexBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "BLAS batch builder test vertices";
+        BuffDesc.BindFlags = BIND_RAY_TRACING;
+        BuffDesc.Size      = sizeof(Vertices);
+
+        BufferData InitData{Vertices, sizeof(Vertices)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pVertexBuffer);
+        ASSERT_NE(pVertexBuffer, nullptr);
+    }
+
+    BLASTriangleDesc TriangleDesc;
+    TriangleDesc.GeometryName         = "Triangles";
+    TriangleDesc.MaxVertexCount       = _countof(Vertices);
+    TriangleDesc.VertexValueType      = VT_FLOAT32;
+    TriangleDesc.VertexComponentCount = 3;
+    TriangleDesc.MaxPrimitiveCount    = _countof(Vertices) / 3;
+
+    BLASBuildTriangleData TriangleData;
+    TriangleData.GeometryName         = TriangleDesc.GeometryName;
+    TriangleData.pVertexBuffer        = pVertexBuffer;
+    TriangleData.VertexStride         = sizeof(Vertices[0]);
+    TriangleData.VertexCount          = _countof(Vertices);
+    TriangleData.VertexValueType      = VT_FLOAT32;
+    TriangleData.VertexComponentCount = 3;
+    TriangleData.PrimitiveCount       = _countof(Vertices) / 3;
+    TriangleData.Flags                = RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+    // Every fourth BLAS does not allow compaction
+    constexpr Uint32 NumBLASes = 32;
+
+    std::vector<RefCntAutoPtr<IBottomLevelAS>> BLASes(NumBLASes);
+    std::vector<BuildBLASAttribs>              BuildAttribs(NumBLASes);
+
+    Uint32 NumCompactable = 0;
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+    {
+        const bool AllowCompaction = (i % 4) != 3;
+
+        BottomLevelASDesc ASDesc;
+        ASDesc.Name          = "BLAS batch builder test BLAS";
+        ASDesc.Flags         = RAYTRACING_BUILD_AS_PREFER_FAST_TRACE | (AllowCompaction ? RAYTRACING_BUILD_AS_ALLOW_COMPACTION : RAYTRACING_BUILD_AS_NONE);
+        ASDesc.pTriangles    = &TriangleDesc;
+        ASDesc.TriangleCount = 1;
+        pDevice->CreateBLAS(ASDesc, &BLASes[i]);
+        ASSERT_NE(BLASes[i], nullptr);
+
+        BuildBLASAttribs& Attribs      = BuildAttribs[i];
+        Attribs.pBLAS                  = BLASes[i];
+        Attribs.BLASTransitionMode     = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        Attribs.GeometryTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        Attribs.pTriangleData          = &TriangleData;
+        Attribs.TriangleDataCount      = 1;
+
+        if (AllowCompaction)
+            ++NumCompactable;
+    }
+
+    // Limit the scratch buffer so that the builds are split into several groups
+    BLASBatchBuilderCreateInfo BuilderCI;
+    BuilderCI.Name                 = "BLAS batch builder test";
+    BuilderCI.MaxScratchBufferSize = BLASes[0]->GetScratchBufferSizes().Build * 5;
+
+    BLASBatchBuilder Builder{pDevice, BuilderCI};
+    Builder.Build(pContext, BuildAttribs.data(), NumBLASes, /*Compact = */ true);
+    EXPECT_EQ(Builder.GetNumPendingCompactions(), NumCompactable);
+    EXPECT_LE(Builder.GetScratchBufferSize(), BuilderCI.MaxScratchBufferSize);
+
+    for (Uint32 i = 0; i < NumBLASes; ++i)
+        EXPECT_EQ(BLASes[i]->GetState(), RESOURCE_STATE_BUILD_AS_READ);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+
+    std::vector<BLASBatchBuilder::CompactedBLAS> Compacted;
+    EXPECT_EQ(Builder.ProcessCompaction(pContext, Compacted), NumCompactable);
+    EXPECT_EQ(Builder.GetNumPendingCompactions(), 0u);
+    ASSERT_EQ(Compacted.size(), size_t{NumCompactable});
+    for (const BLASBatchBuilder::CompactedBLAS& BLAS : Compacted)
+    {
+        ASSERT_NE(BLAS.pCompacted, nullptr);
+        EXPECT_NE(BLAS.pSource, nullptr);
+        EXPECT_GT(BLAS.pCompacted->GetDesc().CompactedSize, 0u);
+        EXPECT_EQ(BLAS.pCompacted->GetState(), RESOURCE_STATE_BUILD_AS_READ);
+        EXPECT_NE(BLAS.pSource->GetDesc().Flags & RAYTRACING_BUILD_AS_ALLOW_COMPACTION, 0);
+    }
+
+    // Nothing is left to compact
+    EXPECT_EQ(Builder.ProcessCompaction(pContext, Compacted), 0u);
+
+    // Rebuild the same BLASes without compaction
+    Builder.Build(pContext, BuildAttribs.data(), NumBLASes);
+    EXPECT_EQ(Builder.GetNumPendingCompactions(), 0u);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
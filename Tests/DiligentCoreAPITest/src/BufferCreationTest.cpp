@@ -437,4 +437,68 @@ TEST_F(BufferCreationTest, CreateUnifiedBuffer)
     }
 }
 
+
+TEST_F(BufferCreationTest, ViewCaching)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    const auto& DevInfo = pDevice->GetDeviceInfo();
+    if (!DevInfo.Features.ComputeShaders)
+    {
+        GTEST_SKIP();
+    }
+
+    constexpr Uint32 NumViews = 16;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "View caching test";
+    BuffDesc.Size              = 256 * NumViews;
+    BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+    BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    BuffDesc.ElementByteStride = 16;
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr) << GetObjectDescString(BuffDesc);
+
+    BufferViewDesc ViewDesc;
+    ViewDesc.ViewType  = BUFFER_VIEW_SHADER_RESOURCE;
+    ViewDesc.ByteWidth = 256;
+
+    std::vector<RefCntAutoPtr<IBufferView>> Views(NumViews);
+    for (Uint32 i = 0; i < NumViews; ++i)
+    {
+        ViewDesc.Name       = "View";
+        ViewDesc.ByteOffset = 256 * i;
+        pBuffer->CreateView(ViewDesc, &Views[i]);
+        ASSERT_NE(Views[i], nullptr);
+        EXPECT_EQ(Views[i]->GetDesc(), ViewDesc);
+
+        // The view with the same description (ignoring the name) must be reused
+        RefCntAutoPtr<IBufferView> pView;
+        ViewDesc.Name = "Another view";
+        pBuffer->CreateView(ViewDesc, &pView);
+        EXPECT_EQ(pView, Views[i]);
+    }
+
+    IBufferView* pFirstView = Views[0];
+    Views.clear();
+
+    // The first views are kept alive by the buffer and must be returned even after
+    // all references are released.
+    RefCntAutoPtr<IBufferView> pView;
+    ViewDesc.ByteOffset = 0;
+    pBuffer->CreateView(ViewDesc, &pView);
+    ASSERT_NE(pView, nullptr);
+    EXPECT_EQ(pView, pFirstView);
+
+    pView.Release();
+    ViewDesc.ByteOffset = 256 * (NumViews - 1);
+    pBuffer->CreateView(ViewDesc, &pView);
+    ASSERT_NE(pView, nullptr);
+    EXPECT_EQ(pView->GetDesc(), ViewDesc);
+}
+
 } // namespace
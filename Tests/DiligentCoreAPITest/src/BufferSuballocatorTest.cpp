@@ -30,6 +30,7 @@
 #include <vector>
 #include <algorithm>
 #include <thread>
+#include <cstring>
 
 #include "GPUTestingEnvironment.hpp"
 #include "FastRand.hpp"
@@ -153,4 +154,201 @@ TEST(BufferSuballocatorTest, Allocate)
     }
 }
 
+TEST(BufferSuballocatorTest, Defragment)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 NumAllocations = 16;
+    constexpr Uint32 AllocSize      = 64;
+    constexpr Uint32 BufferSize     = NumAllocations * AllocSize;
+
+    BufferSuballocatorCreateInfo CI;
+    CI.Desc.Name      = "Buffer Suballocator Defragment Test";
+    CI.Desc.BindFlags = BIND_VERTEX_BUFFER;
+    CI.Desc.Size      = BufferSize;
+
+    RefCntAutoPtr<IBufferSuballocator> pAllocator;
+    CreateBufferSuballocator(pDevice, CI, &pAllocator);
+    ASSERT_NE(pAllocator, nullptr);
+
+    auto* pBuffer = pAllocator->Update(pDevice, pContext);
+    ASSERT_NE(pBuffer, nullptr);
+
+    std::vector<RefCntAutoPtr<IBufferSuballocation>> Allocs(NumAllocations);
+    std::vector<std::vector<Uint8>>                  AllocData(NumAllocations);
+    for (Uint32 i = 0; i < NumAllocations; ++i)
+    {
+        pAllocator->Allocate(AllocSize, 16, &Allocs[i]);
+        ASSERT_TRUE(Allocs[i]);
+
+        AllocData[i].resize(AllocSize);
+        for (Uint32 j = 0; j < AllocSize; ++j)
+            AllocData[i][j] = static_cast<Uint8>(i * 7 + j);
+        pContext->UpdateBuffer(pBuffer, Allocs[i]->GetOffset(), AllocSize, AllocData[i].data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    // Release every other allocation to fragment the buffer
+    for (Uint32 i = 0; i < NumAllocations; i += 2)
+        Allocs[i].Release();
+
+    auto GetUsedRangeEnd = [&]() {
+        Uint32 End = 0;
+        for (const auto& Alloc : Allocs)
+        {
+            if (Alloc)
+                End = std::max(End, Alloc->GetOffset() + Alloc->GetSize());
+        }
+        return End;
+    };
+    const Uint32 UsedRangeEnd = GetUsedRangeEnd();
+
+    const Uint32 LayoutVersion = pAllocator->GetLayoutVersion();
+    EXPECT_EQ(pAllocator->Defragment(pDevice, pContext, 0), Uint64{0});
+    EXPECT_EQ(pAllocator->GetLayoutVersion(), LayoutVersion);
+
+    // The budget only allows moving two allocations
+    EXPECT_EQ(pAllocator->Defragment(pDevice, pContext, AllocSize * 2), Uint64{AllocSize * 2});
+    EXPECT_EQ(pAllocator->GetLayoutVersion(), LayoutVersion + 1);
+
+    for (Uint32 i = 0; i < NumAllocations && pAllocator->Defragment(pDevice, pContext, BufferSize) != 0; ++i)
+    {
+    }
+    EXPECT_LT(GetUsedRangeEnd(), UsedRangeEnd);
+    EXPECT_EQ(pAllocator->Defragment(pDevice, pContext, BufferSize), Uint64{0});
+
+    BufferSuballocatorUsageStats Stats;
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+    EXPECT_EQ(Stats.UsedSize, Uint64{NumAllocations / 2 * AllocSize});
+
+    // The buffer must not be recreated by the defragmentation
+    EXPECT_EQ(pAllocator->GetBuffer(), pBuffer);
+
+    RefCntAutoPtr<IBuffer> pStagingBuff;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Staging buffer for suballocator defragment test";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.BindFlags      = BIND_NONE;
+        BuffDesc.Size           = BufferSize;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuff);
+        ASSERT_NE(pStagingBuff, nullptr);
+    }
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingBuff, 0, BufferSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuff, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    for (Uint32 i = 1; i < NumAllocations; i += 2)
+    {
+        const auto* pAllocData = reinterpret_cast<const Uint8*>(pData) + Allocs[i]->GetOffset();
+        EXPECT_EQ(memcmp(pAllocData, AllocData[i].data(), AllocSize), 0) << "Allocation " << i;
+    }
+    pContext->UnmapBuffer(pStagingBuff, MAP_READ);
+}
+
+TEST(BufferSuballocatorTest, ThreadCaches)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 PageSize = 1024;
+
+    BufferSuballocatorCreateInfo CI;
+    CI.Desc.Name           = "Buffer Suballocator Thread Caches Test";
+    CI.Desc.BindFlags      = BIND_VERTEX_BUFFER;
+    CI.Desc.Size           = 4096;
+    CI.ExpansionSize       = 4096;
+    CI.MaxSize             = 64u << 20u;
+    CI.ThreadCachePageSize = PageSize;
+
+    RefCntAutoPtr<IBufferSuballocator> pAllocator;
+    CreateBufferSuballocator(pDevice, CI, &pAllocator);
+    ASSERT_NE(pAllocator, nullptr);
+
+    const size_t NumThreads     = std::max(4u, std::thread::hardware_concurrency());
+    const size_t NumAllocations = 512;
+
+    std::vector<std::vector<RefCntAutoPtr<IBufferSuballocation>>> pSubAllocations(NumThreads);
+    for (auto& Allocs : pSubAllocations)
+        Allocs.resize(NumAllocations);
+
+    {
+        std::vector<std::thread> Threads(NumThreads);
+        for (size_t t = 0; t < Threads.size(); ++t)
+        {
+            Threads[t] = std::thread{
+                [&](size_t thread_id) //
+                {
+                    // Suballocations larger than a quarter of the page size bypass the thread caches
+                    FastRandInt rnd{static_cast<unsigned int>(thread_id), 4, PageSize / 2};
+
+                    auto& Allocs = pSubAllocations[thread_id];
+                    for (auto& Alloc : Allocs)
+                    {
+                        Uint32 size = static_cast<Uint32>(rnd());
+                        pAllocator->Allocate(size, 16, &Alloc);
+                        ASSERT_TRUE(Alloc);
+                        EXPECT_EQ(Alloc->GetSize(), size);
+                        EXPECT_EQ(Alloc->GetOffset() % 16, 0u);
+                    }
+                },
+                t //
+            };
+        }
+
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+
+    {
+        // Suballocations must not overlap
+        std::vector<std::pair<Uint32, Uint32>> Ranges;
+        for (const auto& Allocs : pSubAllocations)
+        {
+            for (const auto& Alloc : Allocs)
+                Ranges.emplace_back(Alloc->GetOffset(), Alloc->GetSize());
+        }
+        std::sort(Ranges.begin(), Ranges.end());
+        for (size_t i = 1; i < Ranges.size(); ++i)
+            EXPECT_LE(Ranges[i - 1].first + Ranges[i - 1].second, Ranges[i].first);
+    }
+
+    BufferSuballocatorUsageStats Stats;
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumThreads * NumAllocations);
+    EXPECT_GT(Stats.ThreadCachePageCount, 0u);
+    EXPECT_EQ(Stats.ThreadCacheReservedSize, Uint64{Stats.ThreadCachePageCount} * PageSize);
+    EXPECT_GT(Stats.ThreadCacheAllocatedSize, Uint64{0});
+    EXPECT_LE(Stats.ThreadCacheAllocatedSize, Stats.ThreadCacheReservedSize);
+    EXPECT_GT(Stats.FreeChunkCount, 0u);
+
+    auto* pBuffer = pAllocator->Update(pDevice, pContext);
+    EXPECT_NE(pBuffer, nullptr);
+    EXPECT_GE(pBuffer->GetDesc().Size, Stats.UsedSize);
+
+    for (auto& Allocs : pSubAllocations)
+    {
+        for (auto& Alloc : Allocs)
+            Alloc.Release();
+    }
+
+    pAllocator->ReconcileThreadCaches();
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, 0u);
+    EXPECT_EQ(Stats.ThreadCachePageCount, 0u);
+    EXPECT_EQ(Stats.ThreadCacheReservedSize, Uint64{0});
+    EXPECT_EQ(Stats.ThreadCacheAllocatedSize, Uint64{0});
+    EXPECT_EQ(Stats.UsedSize, Uint64{0});
+}
+
 } // namespace
@@ -0,0 +1,292 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <array>
+#include <cstring>
+
+#include "CommandCapture.hpp"
+#include "CommandReplay.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr char ProceduralTriangleVS[] = R"(
+void main(in uint VertId : SV_VertexID, out float4 Pos : SV_Position)
+{
+    float2 UV = float2((VertId << 1) & 2, VertId & 2);
+    Pos = float4(UV * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+constexpr char ConstantColorPS[] = R"(
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return float4(0.25, 0.5, 0.75, 1.0);
+}
+)";
+
+std::vector<Uint8> ReadBuffer(IRenderDevice* pDevice, IDeviceContext* pContext, IBuffer* pBuffer)
+{
+    const Uint64 Size = pBuffer->GetDesc().Size;
+
+    BufferDesc StagingDesc;
+    StagingDesc.Name           = "Command capture test staging buffer";
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    StagingDesc.Size           = Size;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(StagingDesc, nullptr, &pStagingBuffer);
+    if (!pStagingBuffer)
+        return {};
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    std::vector<Uint8> Data(static_cast<size_t>(Size));
+    void*              pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    if (pData == nullptr)
+        return {};
+    memcpy(Data.data(), pData, Data.size());
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    return Data;
+}
+
+TEST(CommandCaptureTest, BufferCommands)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 NumValues = 16;
+
+    std::array<Uint32, NumValues> InitData{};
+    std::array<Uint32, NumValues> UpdateData{};
+    for (Uint32 i = 0; i < NumValues; ++i)
+    {
+        InitData[i]   = i + 1;
+        UpdateData[i] = (i + 1) * 100;
+    }
+
+    SerializedData CaptureData;
+    {
+        CommandCapture Capture{pDevice, pContext};
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Command capture test source buffer";
+        BuffDesc.Size      = sizeof(InitData);
+        BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+
+        BufferData InitBuffData{InitData.data(), sizeof(InitData)};
+
+        RefCntAutoPtr<IBuffer> pSrcBuffer;
+        Capture.CreateBuffer(BuffDesc, &InitBuffData, &pSrcBuffer);
+        ASSERT_NE(pSrcBuffer, nullptr);
+
+        std::array<Uint32, NumValues> ZeroData{};
+        BufferData                    ZeroBuffData{ZeroData.data(), sizeof(ZeroData)};
+
+        BuffDesc.Name = "Command capture test destination buffer";
+        RefCntAutoPtr<IBuffer> pDstBuffer;
+        Capture.CreateBuffer(BuffDesc, &ZeroBuffData, &pDstBuffer);
+        ASSERT_NE(pDstBuffer, nullptr);
+
+        constexpr Uint64 HalfSize = sizeof(InitData) / 2;
+
+        // Frame 0: copy the first half of the initial data
+        Capture.BeginFrame();
+        Capture.BeginDebugGroup("Frame 0");
+        Capture.CopyBuffer(pSrcBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                           pDstBuffer, 0, HalfSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Capture.EndDebugGroup();
+        Capture.EndFrame();
+
+        // Frame 1: update the source buffer and copy the second half
+        Capture.BeginFrame();
+        Capture.UpdateBuffer(pSrcBuffer, HalfSize, HalfSize, &UpdateData[NumValues / 2], RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Capture.CopyBuffer(pSrcBuffer, HalfSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                           pDstBuffer, HalfSize, HalfSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Capture.EndFrame();
+
+        EXPECT_EQ(Capture.GetNumFrames(), 2u);
+
+        CaptureData = Capture.Serialize(DefaultRawMemoryAllocator::GetAllocator());
+        ASSERT_TRUE(CaptureData);
+    }
+
+    CommandReplay Replay{pDevice, pContext, CaptureData.Ptr(), CaptureData.Size()};
+    EXPECT_EQ(Replay.GetNumFrames(), 2u);
+    ASSERT_EQ(Replay.GetNumObjects(), 2u);
+
+    // The setup stream recreates the destination buffer with its initial contents
+    RefCntAutoPtr<IBuffer> pReplayDstBuffer{Replay.GetObjectById(1), IID_Buffer};
+    ASSERT_NE(pReplayDstBuffer, nullptr);
+    {
+        const std::vector<Uint8> Data = ReadBuffer(pDevice, pContext, pReplayDstBuffer);
+        ASSERT_EQ(Data.size(), sizeof(InitData));
+        for (Uint8 Val : Data)
+            EXPECT_EQ(Val, 0);
+    }
+
+    EXPECT_TRUE(Replay.ReplayFrame(0));
+    EXPECT_TRUE(Replay.ReplayFrame(1));
+    EXPECT_FALSE(Replay.ReplayFrame(2));
+
+    std::array<Uint32, NumValues> RefData{};
+    for (Uint32 i = 0; i < NumValues; ++i)
+        RefData[i] = i < NumValues / 2 ? InitData[i] : UpdateData[i];
+
+    const std::vector<Uint8> Data = ReadBuffer(pDevice, pContext, pReplayDstBuffer);
+    ASSERT_EQ(Data.size(), sizeof(RefData));
+    EXPECT_EQ(memcmp(Data.data(), RefData.data(), sizeof(RefData)), 0);
+}
+
+TEST(CommandCaptureTest, DrawCommands)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 RTWidth  = 64;
+    constexpr Uint32 RTHeight = 64;
+
+    SerializedData CaptureData;
+    {
+        CommandCapture Capture{pDevice, pContext};
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Command capture test render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = RTWidth;
+        TexDesc.Height    = RTHeight;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+
+        RefCntAutoPtr<ITexture> pRenderTarget;
+        Capture.CreateTexture(TexDesc, nullptr, &pRenderTarget);
+        ASSERT_NE(pRenderTarget, nullptr);
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        ShaderCI.Desc   = {"Command capture test VS", SHADER_TYPE_VERTEX, true};
+        ShaderCI.Source = ProceduralTriangleVS;
+        Capture.CreateShader(ShaderCI, &pVS);
+        ASSERT_NE(pVS, nullptr);
+
+        RefCntAutoPtr<IShader> pPS;
+        ShaderCI.Desc   = {"Command capture test PS", SHADER_TYPE_PIXEL, true};
+        ShaderCI.Source = ConstantColorPS;
+        Capture.CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Command capture test PSO";
+
+        GraphicsPipelineDesc& GraphicsPipeline        = PSOCreateInfo.GraphicsPipeline;
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = TexDesc.Format;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        Capture.CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        Capture.CreateShaderResourceBinding(pPSO, &pSRB, true);
+        ASSERT_NE(pSRB, nullptr);
+
+        // The default view is not created through the capture and must be registered automatically
+        ITextureView* pRTV = pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+
+        constexpr Uint32 NumFrames = 3;
+        for (Uint32 frame = 0; frame < NumFrames; ++frame)
+        {
+            Capture.BeginFrame();
+            Capture.SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            const float ClearColor[] = {0, 0, 0, static_cast<float>(frame) / NumFrames};
+            Capture.ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            Viewport VP{RTWidth, RTHeight};
+            Capture.SetViewports(1, &VP, RTWidth, RTHeight);
+            Capture.SetPipelineState(pPSO);
+            Capture.CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            Capture.Draw({3, DRAW_FLAG_VERIFY_ALL});
+            Capture.EndFrame();
+        }
+        EXPECT_EQ(Capture.GetNumFrames(), NumFrames);
+
+        CaptureData = Capture.Serialize(DefaultRawMemoryAllocator::GetAllocator());
+        ASSERT_TRUE(CaptureData);
+    }
+
+    CommandReplay Replay{pDevice, pContext, CaptureData.Ptr(), CaptureData.Size()};
+    ASSERT_EQ(Replay.GetNumFrames(), 3u);
+    // Render target, two shaders, pipeline, SRB and render target view
+    ASSERT_EQ(Replay.GetNumObjects(), 6u);
+    for (Uint32 i = 0; i < Replay.GetNumObjects(); ++i)
+        EXPECT_NE(Replay.GetObjectById(i), nullptr);
+
+    constexpr Uint32 NumIterations = 4;
+
+    const std::vector<CommandReplayFrameStats> Stats = Replay.Run(NumIterations);
+    ASSERT_EQ(Stats.size(), 3u);
+    for (const CommandReplayFrameStats& FrameStats : Stats)
+    {
+        EXPECT_EQ(FrameStats.NumSamples, NumIterations);
+        EXPECT_LE(FrameStats.MinCPUTime, FrameStats.AvgCPUTime);
+        EXPECT_LE(FrameStats.AvgCPUTime, FrameStats.MaxCPUTime);
+        if (FrameStats.NumGPUSamples > 0)
+        {
+            EXPECT_LE(FrameStats.NumGPUSamples, NumIterations);
+            EXPECT_LE(FrameStats.MinGPUTime, FrameStats.MaxGPUTime);
+        }
+    }
+}
+
+} // namespace
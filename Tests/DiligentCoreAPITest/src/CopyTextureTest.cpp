@@ -279,4 +279,65 @@ TEST(CopyTexture, Texture3D)
     }
 }
 
+
+TEST(CopyTexture, BatchedUpdateAndCopy)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    for (size_t f = 0; f < _countof(TestFormats); ++f)
+    {
+        GPUTestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+        auto Format = TestFormats[f];
+
+        TextureDesc TexDesc;
+        TexDesc.Type      = RESOURCE_DIM_TEX_CUBE;
+        TexDesc.Format    = Format;
+        TexDesc.Width     = 64;
+        TexDesc.Height    = 64;
+        TexDesc.ArraySize = 6;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        TexDesc.MipLevels = 7;
+        TexDesc.Usage     = USAGE_DEFAULT;
+
+        Diligent::RefCntAutoPtr<ITexture> pSrcTex, pDstTex;
+        pDevice->CreateTexture(TexDesc, nullptr, &pSrcTex);
+        pDevice->CreateTexture(TexDesc, nullptr, &pDstTex);
+        ASSERT_NE(pSrcTex, nullptr);
+        ASSERT_NE(pDstTex, nullptr);
+
+        auto                 FmtAttribs = pDevice->GetTextureFormatInfo(Format);
+        auto                 TexelSize  = Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+        std::vector<uint8_t> DummyData(size_t{TexDesc.Width} * size_t{TexDesc.Height} * size_t{TexelSize});
+
+        std::vector<UpdateTextureAttribs> Updates;
+        std::vector<CopyTextureAttribs>   Copies;
+        for (Uint32 face = 0; face < TexDesc.ArraySize; ++face)
+        {
+            for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+            {
+                Updates.emplace_back(pSrcTex, mip, face, TextureSubResData{DummyData.data(), (TexDesc.Width >> mip) * TexelSize},
+                                     RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+                CopyTextureAttribs CopyAttribs{pSrcTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pDstTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+                CopyAttribs.SrcMipLevel = mip;
+                CopyAttribs.SrcSlice    = face;
+                CopyAttribs.DstMipLevel = mip;
+                CopyAttribs.DstSlice    = face;
+                Copies.emplace_back(CopyAttribs);
+            }
+        }
+        pContext->UpdateTextures(Updates.data(), static_cast<Uint32>(Updates.size()));
+        pContext->CopyTextures(Copies.data(), static_cast<Uint32>(Copies.size()));
+
+        // Copy the destination back to the source in the same batch to test batch splitting
+        Copies.resize(2);
+        std::swap(Copies[1].pSrcTexture, Copies[1].pDstTexture);
+        pContext->CopyTextures(Copies.data(), static_cast<Uint32>(Copies.size()));
+    }
+}
 } // namespace
@@ -0,0 +1,195 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "RenderDeviceD3D12.h"
+#include "DeviceContextD3D12.h"
+#include "MapHelper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// clang-format off
+const std::string ExecuteIndirectCommandsTest_CS{
+R"(
+RWStructuredBuffer<uint> g_Output;
+
+[numthreads(1, 1, 1)]
+void main(uint3 GroupId : SV_GroupID)
+{
+    g_Output[GroupId.x] = GroupId.x + 1;
+}
+)"
+};
+// clang-format on
+
+TEST(ExecuteIndirectCommandsTest, Dispatch)
+{
+    GPUTestingEnvironment* pEnv     = GPUTestingEnvironment::GetInstance();
+    IRenderDevice*         pDevice  = pEnv->GetDevice();
+    IDeviceContext*        pContext = pEnv->GetDeviceContext();
+
+    RefCntAutoPtr<IDeviceContextD3D12> pContextD3D12{pContext, IID_DeviceContextD3D12};
+    if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D12)
+    {
+        // ExecuteIndirectCommands is only exposed through the Direct3D12 device context interface
+        EXPECT_EQ(pContextD3D12, nullptr);
+        GTEST_SKIP() << "ExecuteIndirectCommands is only supported in Direct3D12";
+    }
+    ASSERT_NE(pContextD3D12, nullptr);
+
+    RefCntAutoPtr<IRenderDeviceD3D12> pDeviceD3D12{pDevice, IID_RenderDeviceD3D12};
+    ASSERT_NE(pDeviceD3D12, nullptr);
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 NumElements = 8;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+        ShaderCI.Desc           = {"Execute indirect commands test CS", SHADER_TYPE_COMPUTE, true};
+        ShaderCI.Source         = ExecuteIndirectCommandsTest_CS.c_str();
+
+        RefCntAutoPtr<IShader> pCS;
+        pDevice->CreateShader(ShaderCI, &pCS);
+        ASSERT_NE(pCS, nullptr);
+
+        ComputePipelineStateCreateInfo PSOCreateInfo{"Execute indirect commands test PSO"};
+        PSOCreateInfo.pCS = pCS;
+        pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Execute indirect commands test - output buffer";
+    BuffDesc.Size              = NumElements * sizeof(Uint32);
+    BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    BuffDesc.ElementByteStride = sizeof(Uint32);
+    BuffDesc.Usage             = USAGE_DEFAULT;
+
+    const std::vector<Uint32> ZeroData(NumElements);
+    BufferData                OutputInitData{ZeroData.data(), BuffDesc.Size};
+
+    RefCntAutoPtr<IBuffer> pOutputBuffer;
+    pDevice->CreateBuffer(BuffDesc, &OutputInitData, &pOutputBuffer);
+    ASSERT_NE(pOutputBuffer, nullptr);
+
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutputBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    // Two dispatch commands, but the counter buffer limits the execution to the first one
+    const D3D12_DISPATCH_ARGUMENTS DispatchArgs[] = {
+        {NumElements / 2, 1, 1},
+        {NumElements, 1, 1},
+    };
+    const Uint32 CommandCount = 1;
+
+    BuffDesc.Name              = "Execute indirect commands test - arguments buffer";
+    BuffDesc.Size              = sizeof(DispatchArgs);
+    BuffDesc.BindFlags         = BIND_INDIRECT_DRAW_ARGS;
+    BuffDesc.Mode              = BUFFER_MODE_UNDEFINED;
+    BuffDesc.ElementByteStride = 0;
+    BuffDesc.Usage             = USAGE_IMMUTABLE;
+
+    BufferData             ArgsInitData{DispatchArgs, sizeof(DispatchArgs)};
+    RefCntAutoPtr<IBuffer> pArgsBuffer;
+    pDevice->CreateBuffer(BuffDesc, &ArgsInitData, &pArgsBuffer);
+    ASSERT_NE(pArgsBuffer, nullptr);
+
+    BuffDesc.Name = "Execute indirect commands test - counter buffer";
+    BuffDesc.Size = sizeof(CommandCount);
+
+    BufferData             CounterInitData{&CommandCount, sizeof(CommandCount)};
+    RefCntAutoPtr<IBuffer> pCounterBuffer;
+    pDevice->CreateBuffer(BuffDesc, &CounterInitData, &pCounterBuffer);
+    ASSERT_NE(pCounterBuffer, nullptr);
+
+    BuffDesc.Name           = "Execute indirect commands test - staging buffer";
+    BuffDesc.Size           = NumElements * sizeof(Uint32);
+    BuffDesc.BindFlags      = BIND_NONE;
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    D3D12_INDIRECT_ARGUMENT_DESC ArgDesc{};
+    ArgDesc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH;
+
+    D3D12_COMMAND_SIGNATURE_DESC SignatureDesc{};
+    SignatureDesc.ByteStride       = sizeof(D3D12_DISPATCH_ARGUMENTS);
+    SignatureDesc.NumArgumentDescs = 1;
+    SignatureDesc.pArgumentDescs   = &ArgDesc;
+
+    // The signature only contains a dispatch argument, so it does not need a root signature
+    CComPtr<ID3D12CommandSignature> pd3d12Signature;
+    HRESULT hr = pDeviceD3D12->GetD3D12Device()->CreateCommandSignature(&SignatureDesc, nullptr, __uuidof(pd3d12Signature),
+                                                                         reinterpret_cast<void**>(static_cast<ID3D12CommandSignature**>(&pd3d12Signature)));
+    ASSERT_HRESULT_SUCCEEDED(hr) << "Failed to create the command signature";
+
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    ExecuteIndirectCommandsAttribsD3D12 Attribs;
+    Attribs.pCommandSignature                = pd3d12Signature;
+    Attribs.pArgsBuffer                      = pArgsBuffer;
+    Attribs.ArgsBufferStateTransitionMode    = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.MaxCommandCount                  = _countof(DispatchArgs);
+    Attribs.pCounterBuffer                   = pCounterBuffer;
+    Attribs.CounterBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContextD3D12->ExecuteIndirectCommands(Attribs);
+
+    pContext->CopyBuffer(pOutputBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, NumElements * sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    MapHelper<Uint32> Data{pContext, pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT};
+    ASSERT_NE(Data, nullptr);
+    for (Uint32 i = 0; i < NumElements; ++i)
+    {
+        const Uint32 RefValue = i < DispatchArgs[0].ThreadGroupCountX ? i + 1 : 0;
+        EXPECT_EQ(Data[i], RefValue) << "i=" << i;
+    }
+}
+
+} // namespace
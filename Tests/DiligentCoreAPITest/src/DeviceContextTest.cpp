@@ -50,4 +50,180 @@ TEST(DeviceContextTest, DebugGroups)
     pCtx->EndDebugGroup();
 }
 
+TEST(DeviceContextTest, RedundantStateFiltering)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    auto* pCtx = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const Viewport VP{0.f, 0.f, 64.f, 64.f};
+    const Rect     Scissor{0, 0, 32, 32};
+    const float    BlendFactors[] = {0.25f, 0.5f, 0.75f, 1.f};
+
+    pCtx->SetViewports(1, &VP, 64, 64);
+    pCtx->SetScissorRects(1, &Scissor, 64, 64);
+    pCtx->SetBlendFactors(BlendFactors);
+    pCtx->SetStencilRef(7);
+
+    const DeviceContextCommandCounters Counters0 = pCtx->GetStats().CommandCounters;
+
+    pCtx->SetViewports(1, &VP, 64, 64);
+    pCtx->SetScissorRects(1, &Scissor, 64, 64);
+    pCtx->SetBlendFactors(BlendFactors);
+    pCtx->SetStencilRef(7);
+
+    const DeviceContextCommandCounters Counters1 = pCtx->GetStats().CommandCounters;
+    EXPECT_EQ(Counters1.SetViewports, Counters0.SetViewports + 1);
+    EXPECT_EQ(Counters1.RedundantSetViewports, Counters0.RedundantSetViewports + 1);
+    EXPECT_EQ(Counters1.RedundantSetScissorRects, Counters0.RedundantSetScissorRects + 1);
+    EXPECT_EQ(Counters1.RedundantSetBlendFactors, Counters0.RedundantSetBlendFactors + 1);
+    EXPECT_EQ(Counters1.RedundantSetStencilRef, Counters0.RedundantSetStencilRef + 1);
+
+    pCtx->SetStencilRef(8);
+    EXPECT_EQ(pCtx->GetStats().CommandCounters.RedundantSetStencilRef, Counters1.RedundantSetStencilRef);
+
+    // The same rects must be applied again for a render target of a different size
+    pCtx->SetViewports(1, &VP, 64, 128);
+    pCtx->SetScissorRects(1, &Scissor, 64, 128);
+    EXPECT_EQ(pCtx->GetStats().CommandCounters.RedundantSetViewports, Counters1.RedundantSetViewports);
+    EXPECT_EQ(pCtx->GetStats().CommandCounters.RedundantSetScissorRects, Counters1.RedundantSetScissorRects);
+}
+
+TEST(DeviceContextTest, RedundantCommitShaderResources)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && !DeviceInfo.IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Redundant CommitShaderResources calls are only filtered in Direct3D12 and Vulkan";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    static constexpr char CSSource[] = R"(
+cbuffer Constants
+{
+    uint4 g_Value;
+}
+RWStructuredBuffer<uint4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = g_Value;
+}
+)";
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc           = {"Redundant commit test - CS", SHADER_TYPE_COMPUTE, true};
+    ShaderCI.EntryPoint     = "main";
+    ShaderCI.Source         = CSSource;
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                               = "Redundant commit test";
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    PSOCreateInfo.pCS                                        = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    BufferDesc CBDesc;
+    CBDesc.Name      = "Redundant commit test - constants";
+    CBDesc.Size      = sizeof(Uint32) * 4;
+    CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+
+    RefCntAutoPtr<IBuffer> pConstants[2];
+    pDevice->CreateBuffer(CBDesc, nullptr, &pConstants[0]);
+    pDevice->CreateBuffer(CBDesc, nullptr, &pConstants[1]);
+    ASSERT_TRUE(pConstants[0] && pConstants[1]);
+
+    BufferDesc OutDesc;
+    OutDesc.Name              = "Redundant commit test - output";
+    OutDesc.Size              = sizeof(Uint32) * 4;
+    OutDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+    OutDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    OutDesc.ElementByteStride = sizeof(Uint32) * 4;
+
+    RefCntAutoPtr<IBuffer> pOutput;
+    pDevice->CreateBuffer(OutDesc, nullptr, &pOutput);
+    ASSERT_NE(pOutput, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(pConstants[0]);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    pCtx->SetPipelineState(pPSO);
+    pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+    const DeviceContextCommandCounters Counters0 = pCtx->GetStats().CommandCounters;
+
+    // The SRB has not changed since it was committed
+    pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+    const DeviceContextCommandCounters Counters1 = pCtx->GetStats().CommandCounters;
+    EXPECT_EQ(Counters1.CommitShaderResources, Counters0.CommitShaderResources + 1);
+    EXPECT_EQ(Counters1.RedundantCommitShaderResources, Counters0.RedundantCommitShaderResources + 1);
+
+    // Binding a new resource must invalidate the committed SRB
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "Constants")->Set(pConstants[1]);
+    pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    EXPECT_EQ(pCtx->GetStats().CommandCounters.RedundantCommitShaderResources, Counters1.RedundantCommitShaderResources);
+
+    // Flushing the context must also invalidate the committed SRB
+    pCtx->Flush();
+    pCtx->SetPipelineState(pPSO);
+    pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    EXPECT_EQ(pCtx->GetStats().CommandCounters.RedundantCommitShaderResources, Counters1.RedundantCommitShaderResources);
+}
+
+TEST(DeviceContextTest, TransferStats)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Transfer stats test buffer";
+    BuffDesc.Size      = 256;
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    const Uint8 Data[64] = {};
+
+    const DeviceContextStats Stats0 = pCtx->GetStats();
+    pCtx->UpdateBuffer(pBuffer, 16, sizeof(Data), Data, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->Flush();
+
+    const DeviceContextStats& Stats1 = pCtx->GetStats();
+    EXPECT_EQ(Stats1.UploadBytes, Stats0.UploadBytes + sizeof(Data));
+    EXPECT_EQ(Stats1.SubmitCount, Stats0.SubmitCount + 1);
+    EXPECT_GE(Stats1.BarrierCount, Stats0.BarrierCount);
+    EXPECT_GE(Stats1.DynamicMemoryAllocated, Stats0.DynamicMemoryAllocated);
+
+    pCtx->ClearStats();
+    EXPECT_EQ(pCtx->GetStats().UploadBytes, Uint64{0});
+    EXPECT_EQ(pCtx->GetStats().SubmitCount, Uint32{0});
+}
+
 } // namespace
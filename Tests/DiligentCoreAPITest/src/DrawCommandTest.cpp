@@ -35,6 +35,8 @@
 #include "MapHelper.hpp"
 #include "FastRand.hpp"
 #include "ThreadSignal.hpp"
+#include "ThreadPool.hpp"
+#include "ParallelCommandRecorder.hpp"
 
 #include "gtest/gtest.h"
 
@@ -1062,6 +1064,52 @@ TEST_F(DrawCommandTest, DrawIndexed)
 }
 
 
+TEST_F(DrawCommandTest, SubmitDrawPackets)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        Vert[0], Vert[1], Vert[2],
+        Vert[3], Vert[4], Vert[5]
+    };
+    const Uint32 Indices[] = {3,4,5};
+    // clang-format on
+
+    auto pVB = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pIB = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer* pVBs[] = {pVB};
+
+    DrawPacket Packets[2];
+    // The indexed packet goes first in the array, but has the larger key
+    Packets[0].SortKey             = 2;
+    Packets[0].pPSO                = sm_pDrawPSO;
+    Packets[0].NumVertexBuffers    = 1;
+    Packets[0].ppVertexBuffers     = pVBs;
+    Packets[0].pIndexBuffer        = pIB;
+    Packets[0].StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Packets[0].IndexType           = VT_UINT32;
+    Packets[0].NumElements         = 3;
+    Packets[0].Flags               = DRAW_FLAG_VERIFY_ALL;
+
+    Packets[1].SortKey             = 1;
+    Packets[1].pPSO                = sm_pDrawPSO;
+    Packets[1].NumVertexBuffers    = 1;
+    Packets[1].ppVertexBuffers     = pVBs;
+    Packets[1].StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Packets[1].NumElements         = 3;
+    Packets[1].Flags               = DRAW_FLAG_VERIFY_ALL;
+
+    pContext->SubmitDrawPackets(Packets, _countof(Packets));
+
+    Present();
+}
+
 TEST_F(DrawCommandTest, DrawIndexed_StripCut)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
@@ -2467,6 +2515,63 @@ TEST_F(DrawCommandTest, DeferredContexts)
     Present();
 }
 
+TEST_F(DrawCommandTest, DeferredContexts_ReuseCommandList)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    const auto& DeviceInfo = pEnv->GetDevice()->GetDeviceInfo();
+    if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D11 && !DeviceInfo.IsGLDevice())
+    {
+        GTEST_SKIP() << "Command lists can only be executed multiple times in Direct3D11 and OpenGL";
+    }
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    auto* pSwapChain    = pEnv->GetSwapChain();
+    auto* pImmediateCtx = pEnv->GetDeviceContext();
+
+    const float ClearColor[] = {sm_Rnd(), sm_Rnd(), sm_Rnd(), sm_Rnd()};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    auto pVB = CreateVertexBuffer(Vert, sizeof(Vert));
+
+    StateTransitionDesc Barrier{pVB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pImmediateCtx->TransitionResourceStates(1, &Barrier);
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+
+    RefCntAutoPtr<ICommandList> pCmdList;
+    {
+        auto* pCtx = pEnv->GetDeferredContext(0);
+
+        pCtx->Begin(0);
+        pCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        IBuffer*     pVBs[]    = {pVB};
+        const Uint64 Offsets[] = {0};
+        pCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+        pCtx->SetPipelineState(sm_pDrawPSO);
+
+        DrawAttribs drawAttrs{6, DRAW_FLAG_VERIFY_ALL};
+        pCtx->Draw(drawAttrs);
+
+        pCtx->FinishCommandList(&pCmdList);
+        pCtx->FinishFrame();
+    }
+    ASSERT_NE(pCmdList, nullptr);
+
+    ICommandList* pCmdLists[] = {pCmdList};
+    for (Uint32 i = 0; i < 3; ++i)
+    {
+        pImmediateCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pImmediateCtx->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pImmediateCtx->ExecuteCommandLists(1, pCmdLists);
+    }
+
+    Present();
+}
+
 
 void DrawCommandTest::TestDynamicBufferUpdates(IShader*                      pVS,
                                                IShader*                      pPS,
@@ -2563,6 +2668,83 @@ void DrawCommandTest::TestDynamicBufferUpdates(IShader*                      pVS
 }
 
 // Test dynamic buffer update between two draw calls without committing and SRB
+TEST_F(DrawCommandTest, DeferredContexts_ParallelCommandRecorder)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+    VERIFY(pEnv->GetNumDeferredContexts() >= 2, "At least two deferred contexts are expected");
+
+    auto* pSwapChain    = pEnv->GetSwapChain();
+    auto* pImmediateCtx = pEnv->GetDeviceContext();
+
+    const float ClearColor[] = {sm_Rnd(), sm_Rnd(), sm_Rnd(), sm_Rnd()};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    const Uint32 Indices[] = {0, 1, 2, 3, 4, 5};
+    auto         pVB       = CreateVertexBuffer(Vert, sizeof(Vert));
+    auto         pIB       = CreateIndexBuffer(Indices, _countof(Indices));
+
+    StateTransitionDesc Barriers[] = //
+        {
+            {pVB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+            {pIB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE} //
+        };
+    pImmediateCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+    pImmediateCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pImmediateCtx->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    constexpr Uint32 NumThreads = 2;
+
+    std::array<IDeviceContext*, NumThreads> pDeferredCtxs = {pEnv->GetDeferredContext(0), pEnv->GetDeferredContext(1)};
+
+    // In Metal backend FinishFrame must be called from the same thread that issued rendering commands,
+    // so all jobs are recorded by this thread.
+    RefCntAutoPtr<IThreadPool> pThreadPool;
+    if (!pEnv->GetDevice()->GetDeviceInfo().IsMetalDevice())
+        pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads - 1});
+
+    ParallelCommandRecorderCreateInfo RecorderCI;
+    RecorderCI.ppDeferredContexts  = pDeferredCtxs.data();
+    RecorderCI.NumDeferredContexts = NumThreads;
+    RecorderCI.pThreadPool         = pThreadPool;
+    ParallelCommandRecorder Recorder{RecorderCI};
+
+    std::array<std::atomic<Uint32>, 2> ItemRecordCount{};
+    // Each item is one triangle
+    Recorder.Record(pImmediateCtx, 2,
+                    [&](IDeviceContext* pCtx, Uint32 JobIndex, Uint32 FirstItem, Uint32 NumItems) //
+                    {
+                        pCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+                        IBuffer*     pVBs[]    = {pVB};
+                        const Uint64 Offsets[] = {0};
+                        pCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+                        pCtx->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+                        pCtx->SetPipelineState(sm_pDrawPSO);
+
+                        for (Uint32 i = FirstItem; i < FirstItem + NumItems; ++i)
+                        {
+                            DrawIndexedAttribs drawAttrs{3, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+                            drawAttrs.FirstIndexLocation = 3 * i;
+                            pCtx->DrawIndexed(drawAttrs);
+                            ItemRecordCount[i].fetch_add(1);
+                        }
+                    });
+    EXPECT_EQ(Recorder.GetLastJobCount(), NumThreads);
+    for (const auto& Count : ItemRecordCount)
+        EXPECT_EQ(Count.load(), 1u);
+
+    Recorder.FinishFrame();
+
+    Present();
+}
+
 TEST_F(DrawCommandTest, DynamicUniformBufferUpdates)
 {
     auto* pEnv    = GPUTestingEnvironment::GetInstance();
@@ -0,0 +1,270 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cmath>
+
+#include "DynamicResolutionController.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 MaxWidth  = 256;
+constexpr Uint32 MaxHeight = 128;
+
+TextureDesc GetColorTargetDesc()
+{
+    TextureDesc Desc;
+    Desc.Name      = "Dynamic resolution test color target";
+    Desc.Type      = RESOURCE_DIM_TEX_2D;
+    Desc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    Desc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    return Desc;
+}
+
+// Simulates a GPU whose frame time is proportional to the number of pixels
+// and whose measurements arrive with a latency of a few frames.
+void RunSimulatedFrames(DynamicResolutionController& Controller, IDeviceContext* pContext, double TimeAtFullRes, Uint32 NumFrames)
+{
+    constexpr size_t Latency = 3;
+
+    std::vector<std::pair<double, float>> Pending;
+    for (Uint32 i = 0; i < NumFrames; ++i)
+    {
+        Controller.BeginFrame(pContext);
+        const float Scale = Controller.GetScale();
+        Pending.emplace_back(TimeAtFullRes * Scale * Scale, Scale);
+        Controller.EndFrame(pContext);
+
+        if (Pending.size() > Latency)
+        {
+            Controller.Update(Pending.front().first, Pending.front().second);
+            Pending.erase(Pending.begin());
+        }
+    }
+}
+
+TEST(DynamicResolutionControllerTest, Controller)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    DynamicResolutionControllerCreateInfo CI;
+    CI.MaxWidth       = MaxWidth;
+    CI.MaxHeight      = MaxHeight;
+    CI.TargetGPUTime  = 0.01f;
+    CI.MinScale       = 0.5f;
+    CI.MaxScale       = 1.0f;
+    CI.MeasureGPUTime = false;
+
+    DynamicResolutionController Controller{pDevice, CI};
+    EXPECT_EQ(Controller.GetScale(), 1.f);
+    EXPECT_EQ(Controller.GetRenderWidth(), MaxWidth);
+    EXPECT_EQ(Controller.GetRenderHeight(), MaxHeight);
+
+    // The budget allows 0.7 of the full resolution
+    const double TimeAtFullRes = CI.TargetGPUTime / (0.7 * 0.7);
+    RunSimulatedFrames(Controller, pContext, TimeAtFullRes, 200);
+    EXPECT_NEAR(Controller.GetScale(), 0.7f, 0.05f);
+    EXPECT_LT(Controller.GetRenderWidth(), MaxWidth);
+
+    // The GPU becomes faster: the scale must go back to the maximum
+    RunSimulatedFrames(Controller, pContext, CI.TargetGPUTime * 0.5, 200);
+    EXPECT_EQ(Controller.GetScale(), 1.f);
+
+    // Spike: the scale must be reduced by the next frame
+    Controller.Update(CI.TargetGPUTime * 4.0, 1.f);
+    Controller.BeginFrame(pContext);
+    EXPECT_LE(Controller.GetScale(), 0.5f + 1e-6f);
+    EXPECT_EQ(Controller.GetRenderWidth(), MaxWidth / 2);
+    EXPECT_EQ(Controller.GetRenderHeight(), MaxHeight / 2);
+    Controller.EndFrame(pContext);
+
+    // Stale measurements of the frames rendered before the spike must not reduce the scale further
+    Controller.Reset(0.8f);
+    Controller.Update(CI.TargetGPUTime * 2.0, 1.f);
+    const float ScaleAfterSpike = Controller.GetPendingScale();
+    Controller.Update(CI.TargetGPUTime * 2.0, 1.f);
+    EXPECT_EQ(Controller.GetPendingScale(), ScaleAfterSpike);
+}
+
+TEST(DynamicResolutionControllerTest, ViewportMode)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const TextureDesc RTDesc = GetColorTargetDesc();
+
+    DynamicResolutionControllerCreateInfo CI;
+    CI.MaxWidth         = MaxWidth;
+    CI.MaxHeight        = MaxHeight;
+    CI.Mode             = DYNAMIC_RESOLUTION_MODE_VIEWPORT;
+    CI.pRenderTargets   = &RTDesc;
+    CI.NumRenderTargets = 1;
+    CI.MeasureGPUTime   = false;
+
+    DynamicResolutionController Controller{pDevice, CI};
+    ASSERT_EQ(Controller.GetNumRenderTargets(), 1u);
+    ITexture* pRT = Controller.GetRenderTarget(0);
+    ASSERT_NE(pRT, nullptr);
+    EXPECT_EQ(pRT->GetDesc().Width, MaxWidth);
+    EXPECT_EQ(pRT->GetDesc().Height, MaxHeight);
+    EXPECT_EQ(Controller.GetNumTargetAllocations(), 1u);
+
+    for (double Time : {CI.TargetGPUTime * 2.0, CI.TargetGPUTime * 1.5, CI.TargetGPUTime * 0.5})
+    {
+        Controller.Update(Time);
+        Controller.BeginFrame(pContext);
+
+        // The render targets must never be recreated
+        EXPECT_EQ(Controller.GetRenderTarget(0), pRT);
+        EXPECT_EQ(Controller.GetNumTargetAllocations(), 1u);
+        EXPECT_EQ(Controller.GetTargetWidth(), MaxWidth);
+        EXPECT_EQ(Controller.GetTargetHeight(), MaxHeight);
+
+        const float2 UVScale = Controller.GetUVScale();
+        EXPECT_FLOAT_EQ(UVScale.x, static_cast<float>(Controller.GetRenderWidth()) / MaxWidth);
+        EXPECT_FLOAT_EQ(UVScale.y, static_cast<float>(Controller.GetRenderHeight()) / MaxHeight);
+
+        const Viewport VP = Controller.GetViewport();
+        EXPECT_EQ(VP.Width, static_cast<float>(Controller.GetRenderWidth()));
+        EXPECT_EQ(VP.Height, static_cast<float>(Controller.GetRenderHeight()));
+
+        ITextureView* pRTV = pRT->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Controller.SetViewport(pContext);
+        constexpr float ClearColor[] = {0.25f, 0.5f, 0.75f, 1.f};
+        pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        Controller.EndFrame(pContext);
+    }
+    EXPECT_LT(Controller.GetScale(), 1.f);
+
+    // Changing the maximum size recreates the targets
+    Controller.Resize(MaxWidth * 2, MaxHeight * 2);
+    Controller.BeginFrame(pContext);
+    EXPECT_EQ(Controller.GetNumTargetAllocations(), 2u);
+    EXPECT_EQ(Controller.GetRenderTarget(0)->GetDesc().Width, MaxWidth * 2);
+    EXPECT_EQ(Controller.GetRenderTarget(0)->GetDesc().Height, MaxHeight * 2);
+    Controller.EndFrame(pContext);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST(DynamicResolutionControllerTest, ReallocateMode)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const TextureDesc RTDesc = GetColorTargetDesc();
+
+    DynamicResolutionControllerCreateInfo CI;
+    CI.MaxWidth         = MaxWidth;
+    CI.MaxHeight        = MaxHeight;
+    CI.Mode             = DYNAMIC_RESOLUTION_MODE_REALLOCATE;
+    CI.pRenderTargets   = &RTDesc;
+    CI.NumRenderTargets = 1;
+    CI.InitialScale     = 0.75f;
+    CI.MeasureGPUTime   = false;
+
+    DynamicResolutionController Controller{pDevice, CI};
+    EXPECT_EQ(Controller.GetRenderWidth(), MaxWidth * 3 / 4);
+    EXPECT_EQ(Controller.GetRenderHeight(), MaxHeight * 3 / 4);
+
+    Controller.Update(CI.TargetGPUTime * 2.0);
+    Controller.BeginFrame(pContext);
+    EXPECT_EQ(Controller.GetNumTargetAllocations(), 2u);
+    ITexture* pRT = Controller.GetRenderTarget(0);
+    ASSERT_NE(pRT, nullptr);
+    EXPECT_EQ(pRT->GetDesc().Width, Controller.GetRenderWidth());
+    EXPECT_EQ(pRT->GetDesc().Height, Controller.GetRenderHeight());
+    EXPECT_EQ(Controller.GetUVScale(), float2(1, 1));
+    Controller.EndFrame(pContext);
+
+    // No change - no reallocation
+    Controller.BeginFrame(pContext);
+    EXPECT_EQ(Controller.GetNumTargetAllocations(), 2u);
+    Controller.EndFrame(pContext);
+}
+
+TEST(DynamicResolutionControllerTest, MeasureGPUTime)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.TimestampQueries)
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const TextureDesc RTDesc = GetColorTargetDesc();
+
+    DynamicResolutionControllerCreateInfo CI;
+    CI.MaxWidth         = MaxWidth;
+    CI.MaxHeight        = MaxHeight;
+    CI.pRenderTargets   = &RTDesc;
+    CI.NumRenderTargets = 1;
+
+    DynamicResolutionController Controller{pDevice, CI};
+    for (Uint32 Frame = 0; Frame < 8; ++Frame)
+    {
+        Controller.BeginFrame(pContext);
+
+        ITextureView* pRTV = Controller.GetRenderTarget(0)->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Controller.SetViewport(pContext);
+        constexpr float ClearColor[] = {0, 0, 0, 0};
+        pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        Controller.EndFrame(pContext);
+
+        pContext->Flush();
+        pContext->FinishFrame();
+        pContext->WaitForIdle();
+    }
+
+    EXPECT_GT(Controller.GetNumMeasurements(), 0u);
+    EXPECT_GT(Controller.GetSmoothedGPUTime(), 0.0);
+    // Clearing a small target is well within the default budget
+    EXPECT_EQ(Controller.GetScale(), 1.f);
+}
+
+} // namespace
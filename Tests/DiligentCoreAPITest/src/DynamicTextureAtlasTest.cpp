@@ -257,6 +257,54 @@ TEST(DynamicTextureAtlas, Allocate)
 }
 
 
+TEST(DynamicTextureAtlas, ShelfPacking)
+{
+    DynamicTextureAtlasCreateInfo CI;
+    CI.MinAlignment = 0;
+    CI.Packing      = DYNAMIC_TEXTURE_ATLAS_PACKING_SHELF;
+    CI.Desc.Format  = TEX_FORMAT_R8_UNORM;
+    CI.Desc.Name    = "Dynamic Texture Atlas Shelf Packing Test";
+    CI.Desc.Type    = RESOURCE_DIM_TEX_2D;
+    CI.Desc.Width   = 512;
+    CI.Desc.Height  = 512;
+
+    RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+    CreateDynamicTextureAtlas(nullptr, CI, &pAtlas);
+    ASSERT_TRUE(pAtlas);
+
+    // 16x16 glyphs fill the entire atlas
+    std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> pSubAllocations(32 * 32);
+    for (auto& pSuballoc : pSubAllocations)
+    {
+        pAtlas->Allocate(16, 16, &pSuballoc);
+        ASSERT_TRUE(pSuballoc);
+    }
+
+    DynamicTextureAtlasUsageStats Stats;
+    pAtlas->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, 32u * 32u);
+    EXPECT_EQ(Stats.AllocatedSliceCount, 1u);
+    EXPECT_EQ(Stats.FreeRegionCount, 0u);
+    EXPECT_EQ(Stats.Occupancy, 1.f);
+    EXPECT_EQ(Stats.Fragmentation, 0.f);
+
+    for (size_t i = 0; i < pSubAllocations.size(); i += 2)
+        pSubAllocations[i].Release();
+
+    pAtlas->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, 32u * 16u);
+    EXPECT_EQ(Stats.AllocatedSliceCount, 1u);
+    EXPECT_EQ(Stats.FreeRegionCount, 32u * 16u);
+    EXPECT_EQ(Stats.Occupancy, 0.5f);
+    EXPECT_GT(Stats.Fragmentation, 0.99f);
+
+    pSubAllocations.clear();
+    pAtlas->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, 0u);
+    EXPECT_EQ(Stats.AllocatedSliceCount, 0u);
+    EXPECT_EQ(Stats.Occupancy, 0.f);
+}
+
 // Allocate more regions than the atlas can hold
 TEST(DynamicTextureAtlas, Overflow)
 {
@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// clang-format off
+const std::string ExtendedDynamicStateTest_VS{
+R"(
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+void main(in uint VertId : SV_VertexID,
+          out PSInput PSIn)
+{
+    // Clockwise quad
+    float4 Pos[4];
+    Pos[0] = float4(-0.5, -0.5, 0.0, 1.0);
+    Pos[1] = float4(-0.5, +0.5, 0.0, 1.0);
+    Pos[2] = float4(+0.5, -0.5, 0.0, 1.0);
+    Pos[3] = float4(+0.5, +0.5, 0.0, 1.0);
+
+    PSIn.Pos = Pos[VertId];
+}
+)"
+};
+
+const std::string ExtendedDynamicStateTest_PS{
+R"(
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    return float4(0.0, 1.0, 0.0, 1.0);
+}
+)"
+};
+// clang-format on
+
+TEST(ExtendedDynamicStateTest, CullMode)
+{
+    GPUTestingEnvironment* pEnv    = GPUTestingEnvironment::GetInstance();
+    IRenderDevice*         pDevice = pEnv->GetDevice();
+
+    const RenderDeviceInfo& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.Features.ExtendedDynamicState)
+    {
+        // Only Vulkan implements extended dynamic state
+        if (!DeviceInfo.IsVulkanDevice())
+            EXPECT_EQ(DeviceInfo.Features.ExtendedDynamicState, DEVICE_FEATURE_STATE_DISABLED);
+        GTEST_SKIP() << "Extended dynamic state is not supported by this device";
+    }
+    if (!DeviceInfo.Features.OcclusionQueries)
+    {
+        GTEST_SKIP() << "Occlusion queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    IDeviceContext* pContext = pEnv->GetDeviceContext();
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Extended dynamic state test render target";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Width     = 128;
+    TexDesc.Height    = 128;
+    TexDesc.BindFlags = BIND_RENDER_TARGET;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    RefCntAutoPtr<ITexture> pRenderTarget;
+    pDevice->CreateTexture(TexDesc, nullptr, &pRenderTarget);
+    ASSERT_NE(pRenderTarget, nullptr);
+    ITextureView* pRTV = pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    ASSERT_NE(pRTV, nullptr);
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    PipelineStateDesc&              PSODesc          = PSOCreateInfo.PSODesc;
+    GraphicsPipelineDesc&           GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name        = "Extended dynamic state test PSO";
+    PSOCreateInfo.Flags = PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE;
+
+    GraphicsPipeline.NumRenderTargets  = 1;
+    GraphicsPipeline.RTVFormats[0]     = TexDesc.Format;
+    GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+    // The quad is front-facing, so the pipeline state culls it
+    GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_FRONT;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.EntryPoint     = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc   = {"Extended dynamic state test VS", SHADER_TYPE_VERTEX, true};
+        ShaderCI.Source = ExtendedDynamicStateTest_VS.c_str();
+        pDevice->CreateShader(ShaderCI, &pVS);
+        ASSERT_NE(pVS, nullptr);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc   = {"Extended dynamic state test PS", SHADER_TYPE_PIXEL, true};
+        ShaderCI.Source = ExtendedDynamicStateTest_PS.c_str();
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+    }
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    QueryDesc OcclusionQueryDesc;
+    OcclusionQueryDesc.Name = "Extended dynamic state test query";
+    OcclusionQueryDesc.Type = QUERY_TYPE_OCCLUSION;
+
+    std::vector<RefCntAutoPtr<IQuery>> Queries(3);
+    for (auto& pQuery : Queries)
+    {
+        pDevice->CreateQuery(OcclusionQueryDesc, &pQuery);
+        ASSERT_NE(pQuery, nullptr);
+    }
+
+    pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    auto DrawQuad = [&](IQuery* pQuery, const DynamicRenderState* pDynamicState) {
+        pContext->BeginQuery(pQuery);
+        pContext->SetPipelineState(pPSO);
+        if (pDynamicState != nullptr)
+            pContext->SetDynamicRenderState(*pDynamicState);
+        pContext->Draw(DrawAttribs{4, DRAW_FLAG_VERIFY_ALL});
+        pContext->EndQuery(pQuery);
+    };
+
+    DepthStencilStateDesc DepthStencilDesc;
+    DepthStencilDesc.DepthEnable = False;
+
+    const DynamicRenderState NoCulling{CULL_MODE_NONE, False, DepthStencilDesc};
+
+    // The state from the pipeline description culls the quad
+    DrawQuad(Queries[0], nullptr);
+    // The dynamic state disables culling
+    DrawQuad(Queries[1], &NoCulling);
+    // Binding the pipeline again restores the state from its description
+    DrawQuad(Queries[2], nullptr);
+
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    pContext->WaitForIdle();
+
+    Uint64 NumSamples[3] = {};
+    for (size_t i = 0; i < Queries.size(); ++i)
+    {
+        QueryDataOcclusion QueryData;
+        ASSERT_TRUE(Queries[i]->GetData(&QueryData, sizeof(QueryData))) << "Query data must be available after idling the context";
+        NumSamples[i] = QueryData.NumSamples;
+    }
+    EXPECT_EQ(NumSamples[0], Uint64{0});
+    EXPECT_GT(NumSamples[1], Uint64{0});
+    EXPECT_EQ(NumSamples[2], Uint64{0});
+}
+
+} // namespace
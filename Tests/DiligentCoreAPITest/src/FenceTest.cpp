@@ -325,4 +325,47 @@ TEST_F(FenceTest, ContextWaitForAnotherContext)
     pSwapChain->Present();
 }
 
+
+TEST_F(FenceTest, HostWaitWithTimeout)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    FenceDesc FenceCI;
+    FenceCI.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+
+    RefCntAutoPtr<IFence> pFences[2];
+    FenceCI.Name = "Host wait fence 1";
+    pDevice->CreateFence(FenceCI, &pFences[0]);
+    ASSERT_NE(pFences[0], nullptr);
+    FenceCI.Name = "Host wait fence 2";
+    pDevice->CreateFence(FenceCI, &pFences[1]);
+    ASSERT_NE(pFences[1], nullptr);
+
+    pContext->EnqueueSignal(pFences[0], 1);
+    pContext->Flush();
+
+    constexpr Uint64 Timeout = 1000000; // 1 ms
+
+    EXPECT_TRUE(pFences[0]->WaitWithTimeout(1, ~Uint64{0}));
+    EXPECT_GE(pFences[0]->GetCompletedValue(), 1u);
+    EXPECT_TRUE(pFences[0]->WaitWithTimeout(1, 0));
+
+    // The second fence is never signaled
+    EXPECT_FALSE(pFences[1]->WaitWithTimeout(1, 0));
+    EXPECT_FALSE(pFences[1]->WaitWithTimeout(1, Timeout));
+
+    IFence*      ppFences[] = {pFences[0], pFences[1]};
+    const Uint64 Values[]   = {1, 1};
+
+    EXPECT_FALSE(pDevice->WaitForFences({2, ppFences, Values, /*WaitAll = */ true, Timeout}));
+    EXPECT_TRUE(pDevice->WaitForFences({2, ppFences, Values, /*WaitAll = */ false, Timeout}));
+    EXPECT_TRUE(pDevice->WaitForFences({1, ppFences, Values, /*WaitAll = */ true}));
+
+    pContext->EnqueueSignal(pFences[1], 1);
+    pContext->Flush();
+    EXPECT_TRUE(pDevice->WaitForFences({2, ppFences, Values, /*WaitAll = */ true}));
+}
+
 } // namespace
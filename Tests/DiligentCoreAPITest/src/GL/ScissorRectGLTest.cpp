@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GL/TestingEnvironmentGL.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// OpenGL uses the bottom-left window origin, so the scissor box depends on the render target height
+TEST(ScissorRectGLTest, SameRectOnRenderTargetsOfDifferentHeight)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsGLDevice())
+        GTEST_SKIP() << "This test requires OpenGL device";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const Rect Scissor{8, 16, 40, 48};
+    for (Uint32 Height : {64u, 128u})
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Scissor rect test render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = 64;
+        TexDesc.Height    = Height;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+
+        RefCntAutoPtr<ITexture> pTexture;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+        ASSERT_NE(pTexture, nullptr);
+
+        ITextureView* pRTV = pTexture->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->SetScissorRects(1, &Scissor, 0, 0);
+
+        GLint ScissorBox[4] = {};
+        glGetIntegerv(GL_SCISSOR_BOX, ScissorBox);
+        EXPECT_EQ(ScissorBox[0], Scissor.left);
+        EXPECT_EQ(ScissorBox[1], static_cast<GLint>(Height) - Scissor.bottom) << "Render target height: " << Height;
+        EXPECT_EQ(ScissorBox[2], Scissor.right - Scissor.left);
+        EXPECT_EQ(ScissorBox[3], Scissor.bottom - Scissor.top);
+    }
+
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+}
+
+} // namespace
@@ -0,0 +1,208 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <chrono>
+#include <cmath>
+
+#include "GPUProfiler.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(GPUProfilerTest, ScopeTree)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    GPUProfilerCreateInfo ProfilerCI;
+    ProfilerCI.NumFramesInFlight = 2;
+    ProfilerCI.InitialQueryCount = 4;
+
+    GPUProfiler Profiler{pDevice, ProfilerCI};
+    Profiler.BeginCapture();
+
+    constexpr Uint32 NumFrames = 3;
+    for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        Profiler.BeginFrame(pContext);
+        {
+            GPUProfileScope Shadows{Profiler, pContext, "Shadows"};
+            for (Uint32 i = 0; i < 2; ++i)
+            {
+                GPUProfileScope Cascade{Profiler, pContext, "Cascade"};
+            }
+        }
+        {
+            GPUProfileScope Lighting{Profiler, pContext, "Lighting"};
+        }
+        Profiler.EndFrame(pContext);
+
+        pContext->Flush();
+        pContext->WaitForIdle();
+    }
+    // Resolve the last frame
+    Profiler.BeginFrame(pContext);
+    Profiler.EndFrame(pContext);
+
+    EXPECT_EQ(Profiler.GetNumResolvedFrames(), Uint64{NumFrames});
+    EXPECT_EQ(Profiler.GetNumSkippedFrames(), Uint64{0});
+
+    const std::vector<GPUProfileNode>& Nodes = Profiler.GetLastFrame();
+    ASSERT_EQ(Nodes.size(), size_t{5});
+    EXPECT_STREQ(Nodes[0].Name, "Frame");
+    EXPECT_EQ(Nodes[0].Parent, ~0u);
+    EXPECT_STREQ(Nodes[1].Name, "Shadows");
+    EXPECT_EQ(Nodes[1].Parent, 0u);
+    EXPECT_STREQ(Nodes[2].Name, "Cascade");
+    EXPECT_EQ(Nodes[2].Parent, 1u);
+    EXPECT_EQ(Nodes[2].Depth, 2u);
+    EXPECT_STREQ(Nodes[3].Name, "Cascade");
+    EXPECT_STREQ(Nodes[4].Name, "Lighting");
+    EXPECT_EQ(Nodes[4].Parent, 0u);
+    for (const GPUProfileNode& Node : Nodes)
+    {
+        EXPECT_GE(Node.StartTime, 0.0);
+        EXPECT_GE(Node.Duration, 0.0);
+    }
+
+    const std::vector<GPUProfileScopeStats>& Stats = Profiler.GetStats();
+    ASSERT_EQ(Stats.size(), size_t{4});
+    EXPECT_EQ(Stats[0].Name, "Frame");
+    EXPECT_EQ(Stats[2].Name, "Cascade");
+    EXPECT_EQ(Stats[2].Parent, 1u);
+    for (const GPUProfileScopeStats& S : Stats)
+    {
+        EXPECT_EQ(S.NumFrames, NumFrames);
+        EXPECT_LE(S.MinTime, S.GetAvgTime());
+        EXPECT_LE(S.GetAvgTime(), S.MaxTime);
+    }
+
+    const std::string Trace = Profiler.EndCapture();
+    EXPECT_NE(Trace.find("\"name\":\"Lighting\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"GPU\""), std::string::npos);
+}
+
+TEST(GPUProfilerTest, SkipFrames)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    GPUProfilerCreateInfo ProfilerCI;
+    ProfilerCI.NumFramesInFlight = 1;
+    ProfilerCI.EmitDebugGroups   = false;
+
+    GPUProfiler Profiler{pDevice, ProfilerCI};
+
+    // The results of the first frame are not normally available until the commands are
+    // submitted, so the second frame is skipped
+    Profiler.BeginFrame(pContext);
+    Profiler.EndFrame(pContext);
+    Profiler.BeginFrame(pContext);
+    Profiler.BeginScope(pContext, "Skipped");
+    Profiler.EndScope(pContext);
+    Profiler.EndFrame(pContext);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+
+    Profiler.BeginFrame(pContext);
+    Profiler.EndFrame(pContext);
+    EXPECT_GE(Profiler.GetNumResolvedFrames(), Uint64{1});
+    EXPECT_EQ(Profiler.GetNumResolvedFrames() + Profiler.GetNumSkippedFrames(), Uint64{2});
+    EXPECT_FALSE(Profiler.GetLastFrame().empty());
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST(GPUProfilerTest, TimestampCalibration)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TimestampCalibration Calibration;
+    bool                 Calibrated = false;
+    if (ICommandQueue* pQueue = pContext->LockCommandQueue())
+    {
+        Calibrated = pQueue->GetTimestampCalibration(Calibration);
+        pContext->UnlockCommandQueue();
+    }
+    if (!Calibrated)
+    {
+        GTEST_SKIP() << "Calibrated timestamps are not supported by this device";
+    }
+    EXPECT_NE(Calibration.GPUFrequency, Uint64{0});
+    EXPECT_NE(Calibration.CPUFrequency, Uint64{0});
+
+    RefCntAutoPtr<IQuery> pQuery;
+    pDevice->CreateQuery(QueryDesc{QUERY_TYPE_TIMESTAMP}, &pQuery);
+    ASSERT_NE(pQuery, nullptr);
+
+    pContext->EndQuery(pQuery);
+    pContext->Flush();
+    pContext->WaitForIdle();
+
+    QueryDataTimestamp Data;
+    ASSERT_TRUE(pQuery->GetData(&Data, sizeof(Data)));
+
+    // The timestamp converted to the CPU time base must be close to the current CPU time
+    const double CPUTime       = Calibration.GPUTimestampToCPUSeconds(Data.Counter);
+    const double SteadyTimeNow = std::chrono::duration<double>{std::chrono::steady_clock::now().time_since_epoch()}.count();
+    EXPECT_LT(std::abs(SteadyTimeNow - CPUTime), 1.0);
+}
+
+} // namespace
@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <chrono>
+#include <future>
+
+#include "GPUReadbackQueue.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(GPUReadbackQueueTest, Buffer)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 TestData[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "GPU readback queue test buffer";
+    BuffDesc.Size      = sizeof(TestData);
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    BufferData InitData{TestData, sizeof(TestData)};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    GPUReadbackQueue ReadbackQueue{pDevice};
+
+    std::vector<Uint32> CallbackData;
+    ReadbackQueue.ReadbackBufferAsync(pContext, pBuffer, sizeof(Uint32) * 4, sizeof(Uint32) * 8,
+                                      [&CallbackData](const GPUReadbackData& Data) {
+                                          const Uint32* pData = static_cast<const Uint32*>(Data.pData);
+                                          CallbackData.assign(pData, pData + Data.DataSize / sizeof(Uint32));
+                                      });
+
+    std::future<std::vector<Uint8>> Future = ReadbackQueue.ReadbackBufferAsync(pContext, pBuffer, 0, sizeof(TestData));
+    EXPECT_EQ(ReadbackQueue.GetNumPendingReadbacks(), size_t{2});
+
+    ReadbackQueue.WaitForCompletion(pContext);
+    EXPECT_EQ(ReadbackQueue.GetNumPendingReadbacks(), size_t{0});
+
+    ASSERT_EQ(CallbackData.size(), size_t{8});
+    EXPECT_EQ(memcmp(CallbackData.data(), &TestData[4], sizeof(Uint32) * 8), 0);
+
+    ASSERT_EQ(Future.wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    const std::vector<Uint8> FutureData = Future.get();
+    ASSERT_EQ(FutureData.size(), sizeof(TestData));
+    EXPECT_EQ(memcmp(FutureData.data(), TestData, sizeof(TestData)), 0);
+}
+
+TEST(GPUReadbackQueueTest, Texture)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 Width  = 16;
+    constexpr Uint32 Height = 8;
+
+    std::vector<Uint32> TestData(Width * Height);
+    for (Uint32 i = 0; i < TestData.size(); ++i)
+        TestData[i] = i * 0x01020304u;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "GPU readback queue test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    TextureSubResData SubresData{TestData.data(), Width * sizeof(Uint32)};
+    TextureData       InitData{&SubresData, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    GPUReadbackQueue ReadbackQueue{pDevice};
+
+    const Box Region{4, 12, 2, 6};
+
+    std::future<std::vector<Uint8>> Future = ReadbackQueue.ReadbackTextureAsync(pContext, pTexture, 0, 0, &Region);
+    ReadbackQueue.WaitForCompletion(pContext);
+
+    ASSERT_EQ(Future.wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    const std::vector<Uint8> Data = Future.get();
+    ASSERT_EQ(Data.size(), size_t{Region.Width() * Region.Height() * sizeof(Uint32)});
+
+    const Uint32* pTexels = reinterpret_cast<const Uint32*>(Data.data());
+    for (Uint32 y = 0; y < Region.Height(); ++y)
+    {
+        for (Uint32 x = 0; x < Region.Width(); ++x)
+        {
+            EXPECT_EQ(pTexels[y * Region.Width() + x], TestData[(Region.MinY + y) * Width + Region.MinX + x]) << "x=" << x << " y=" << y;
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,208 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <vector>
+#include <algorithm>
+
+#include "HiZBuilder.hpp"
+#include "GPUTestingEnvironment.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Builds the reference pyramid: x - the farthest (maximum) depth, y - the nearest (minimum) depth
+std::vector<std::vector<float2>> BuildReferencePyramid(const std::vector<float>& Depth, Uint32 DepthWidth, Uint32 DepthHeight, const TextureDesc& HiZDesc)
+{
+    std::vector<std::vector<float2>> Levels(HiZDesc.MipLevels);
+
+    Levels[0].resize(size_t{HiZDesc.Width} * HiZDesc.Height);
+    for (Uint32 y = 0; y < HiZDesc.Height; ++y)
+    {
+        for (Uint32 x = 0; x < HiZDesc.Width; ++x)
+        {
+            const Uint32 StartX = x * DepthWidth / HiZDesc.Width;
+            const Uint32 StartY = y * DepthHeight / HiZDesc.Height;
+            const Uint32 EndX   = std::min(((x + 1) * DepthWidth + HiZDesc.Width - 1) / HiZDesc.Width, DepthWidth);
+            const Uint32 EndY   = std::min(((y + 1) * DepthHeight + HiZDesc.Height - 1) / HiZDesc.Height, DepthHeight);
+
+            float2 Value{0, 1};
+            for (Uint32 sy = StartY; sy < EndY; ++sy)
+            {
+                for (Uint32 sx = StartX; sx < EndX; ++sx)
+                {
+                    const float d = Depth[size_t{sy} * DepthWidth + sx];
+                    Value         = float2{std::max(Value.x, d), std::min(Value.y, d)};
+                }
+            }
+            Levels[0][size_t{y} * HiZDesc.Width + x] = Value;
+        }
+    }
+
+    for (Uint32 mip = 1; mip < HiZDesc.MipLevels; ++mip)
+    {
+        const Uint32 PrevWidth  = std::max(HiZDesc.Width >> (mip - 1), 1u);
+        const Uint32 PrevHeight = std::max(HiZDesc.Height >> (mip - 1), 1u);
+        const Uint32 Width      = std::max(HiZDesc.Width >> mip, 1u);
+        const Uint32 Height     = std::max(HiZDesc.Height >> mip, 1u);
+
+        Levels[mip].resize(size_t{Width} * Height);
+        for (Uint32 y = 0; y < Height; ++y)
+        {
+            for (Uint32 x = 0; x < Width; ++x)
+            {
+                float2 Value{0, 1};
+                for (Uint32 i = 0; i < 4; ++i)
+                {
+                    const Uint32  cx = std::min(x * 2 + (i & 1), PrevWidth - 1);
+                    const Uint32  cy = std::min(y * 2 + (i >> 1), PrevHeight - 1);
+                    const float2& c  = Levels[mip - 1][size_t{cy} * PrevWidth + cx];
+                    Value            = float2{std::max(Value.x, c.x), std::min(Value.y, c.y)};
+                }
+                Levels[mip][size_t{y} * Width + x] = Value;
+            }
+        }
+    }
+
+    return Levels;
+}
+
+TEST(HiZBuilderTest, Build)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    HiZBuilderCreateInfo CI;
+    CI.Name              = "Hi-Z builder test";
+    CI.StoreNearestDepth = true;
+    HiZBuilder Builder{pDevice, CI};
+
+    // Non-power-of-two sizes. The second size recreates the pyramid and
+    // uses the last thread group path again, which checks that the counter is reset.
+    const uint2 DepthSizes[] = {
+        {300, 170},
+        {1000, 33},
+    };
+
+    FastRandFloat Rnd{0, 0.f, 1.f};
+    for (const uint2& DepthSize : DepthSizes)
+    {
+        std::vector<float> Depth(size_t{DepthSize.x} * DepthSize.y);
+        for (float& d : Depth)
+            d = Rnd();
+
+        // Depth-stencil textures can't be initialized, so the depth is stored in a color texture
+        TextureDesc DepthDesc;
+        DepthDesc.Name      = "Hi-Z builder test depth";
+        DepthDesc.Type      = RESOURCE_DIM_TEX_2D;
+        DepthDesc.Format    = TEX_FORMAT_R32_FLOAT;
+        DepthDesc.Width     = DepthSize.x;
+        DepthDesc.Height    = DepthSize.y;
+        DepthDesc.BindFlags = BIND_SHADER_RESOURCE;
+        DepthDesc.Usage     = USAGE_IMMUTABLE;
+
+        TextureSubResData SubresData{Depth.data(), DepthSize.x * sizeof(float)};
+        TextureData       InitData{&SubresData, 1};
+
+        RefCntAutoPtr<ITexture> pDepth;
+        pDevice->CreateTexture(DepthDesc, &InitData, &pDepth);
+        ASSERT_NE(pDepth, nullptr);
+
+        Builder.Build(pContext, pDepth->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        // Build again to check that the pyramid is reused
+        Builder.Build(pContext, pDepth->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+
+        ITexture* pHiZ = Builder.GetHiZTexture();
+        ASSERT_NE(pHiZ, nullptr);
+        EXPECT_EQ(pHiZ->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+
+        const TextureDesc& HiZDesc = pHiZ->GetDesc();
+        EXPECT_EQ(HiZDesc.Format, TEX_FORMAT_RG32_FLOAT);
+        EXPECT_LE(HiZDesc.Width, DepthSize.x);
+        EXPECT_LE(HiZDesc.Height, DepthSize.y);
+        EXPECT_GT(HiZDesc.Width * 2, DepthSize.x);
+        EXPECT_GT(HiZDesc.Height * 2, DepthSize.y);
+        EXPECT_TRUE(IsPowerOfTwo(HiZDesc.Width));
+        EXPECT_TRUE(IsPowerOfTwo(HiZDesc.Height));
+
+        TextureDesc StagingDesc    = HiZDesc;
+        StagingDesc.Name           = "Hi-Z builder test staging texture";
+        StagingDesc.BindFlags      = BIND_NONE;
+        StagingDesc.Usage          = USAGE_STAGING;
+        StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+        RefCntAutoPtr<ITexture> pStagingTex;
+        pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+        ASSERT_NE(pStagingTex, nullptr);
+
+        for (Uint32 mip = 0; mip < HiZDesc.MipLevels; ++mip)
+        {
+            CopyTextureAttribs CopyAttribs;
+            CopyAttribs.pSrcTexture              = pHiZ;
+            CopyAttribs.SrcMipLevel              = mip;
+            CopyAttribs.pDstTexture              = pStagingTex;
+            CopyAttribs.DstMipLevel              = mip;
+            CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            pContext->CopyTexture(CopyAttribs);
+        }
+        pContext->WaitForIdle();
+
+        const std::vector<std::vector<float2>> RefLevels = BuildReferencePyramid(Depth, DepthSize.x, DepthSize.y, HiZDesc);
+        for (Uint32 mip = 0; mip < HiZDesc.MipLevels; ++mip)
+        {
+            const Uint32 MipWidth  = std::max(HiZDesc.Width >> mip, 1u);
+            const Uint32 MipHeight = std::max(HiZDesc.Height >> mip, 1u);
+
+            MappedTextureSubresource MappedData;
+            pContext->MapTextureSubresource(pStagingTex, mip, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+            ASSERT_NE(MappedData.pData, nullptr);
+            Uint32 NumInvalidTexels = 0;
+            for (Uint32 y = 0; y < MipHeight; ++y)
+            {
+                const float2* pRow = reinterpret_cast<const float2*>(static_cast<const Uint8*>(MappedData.pData) + MappedData.Stride * y);
+                for (Uint32 x = 0; x < MipWidth; ++x)
+                    NumInvalidTexels += pRow[x] != RefLevels[mip][size_t{y} * MipWidth + x] ? 1 : 0;
+            }
+            pContext->UnmapTextureSubresource(pStagingTex, mip, 0);
+            EXPECT_EQ(NumInvalidTexels, 0u) << "Depth size " << DepthSize.x << "x" << DepthSize.y << ", mip " << mip;
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include "IndirectDrawGenerator.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(IndirectDrawGeneratorTest, FrustumCulling)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    if ((pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER) == 0)
+        GTEST_SKIP() << "Indirect draws with a counter buffer are not supported by this device";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    IndirectDrawGeneratorCreateInfo CI;
+    CI.Name         = "Indirect draw generator test";
+    CI.MaxInstances = 16;
+    IndirectDrawGenerator Generator{pDevice, CI};
+
+    IndirectDrawGenerator::DrawRange Ranges[2];
+    Ranges[0].NumIndices         = 36;
+    Ranges[0].FirstIndexLocation = 0;
+    Ranges[0].BaseVertex         = 0;
+    Ranges[1].NumIndices         = 6;
+    Ranges[1].FirstIndexLocation = 36;
+    Ranges[1].BaseVertex         = 24;
+    Generator.SetDrawRanges(pContext, Ranges, _countof(Ranges));
+
+    // With the identity view-projection matrix, the frustum is the [-1, 1] x [-1, 1] clip-space box.
+    IndirectDrawGenerator::Instance Instances[4];
+    Instances[0] = {float3{-0.5f, -0.5f, 0.2f}, 0, float3{0.5f, 0.5f, 0.4f}};
+    Instances[1] = {float3{+5.0f, +5.0f, 0.2f}, 1, float3{6.0f, 6.0f, 0.4f}}; // Culled
+    Instances[2] = {float3{+0.8f, -0.2f, 0.2f}, 1, float3{1.5f, 0.2f, 0.4f}}; // Partially visible
+    Instances[3] = {float3{-3.0f, -0.2f, 0.2f}, 0, float3{-2.f, 0.2f, 0.4f}}; // Culled
+    Generator.SetInstances(pContext, Instances, _countof(Instances));
+
+    IndirectDrawGenerator::GenerateAttribs Attribs;
+    Generator.Generate(pContext, Attribs);
+
+    RefCntAutoPtr<IBuffer> pStagingBuff;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Indirect draw generator test staging buffer";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.Size           = sizeof(Uint32) * (1 + 5 * _countof(Instances));
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuff);
+        ASSERT_NE(pStagingBuff, nullptr);
+    }
+    pContext->CopyBuffer(Generator.GetCountBuffer(), 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuff, 0, sizeof(Uint32), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->CopyBuffer(Generator.GetDrawArgsBuffer(), 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuff, sizeof(Uint32), sizeof(Uint32) * 5 * _countof(Instances), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuff, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    const Uint32* pValues = static_cast<const Uint32*>(pData);
+
+    const Uint32 DrawCount = pValues[0];
+    EXPECT_EQ(DrawCount, 2u);
+
+    // The order of the commands is not defined
+    std::vector<Uint32> VisibleInstances;
+    for (Uint32 i = 0; i < std::min(DrawCount, Uint32{_countof(Instances)}); ++i)
+    {
+        const Uint32* pArgs = pValues + 1 + i * 5;
+
+        const Uint32 InstanceIdx = pArgs[4];
+        ASSERT_LT(InstanceIdx, Uint32{_countof(Instances)});
+        const IndirectDrawGenerator::DrawRange& Range = Ranges[Instances[InstanceIdx].DrawRangeIndex];
+        EXPECT_EQ(pArgs[0], Range.NumIndices);
+        EXPECT_EQ(pArgs[1], 1u);
+        EXPECT_EQ(pArgs[2], Range.FirstIndexLocation);
+        EXPECT_EQ(pArgs[3], Range.BaseVertex);
+        VisibleInstances.push_back(InstanceIdx);
+    }
+    pContext->UnmapBuffer(pStagingBuff, MAP_READ);
+
+    std::sort(VisibleInstances.begin(), VisibleInstances.end());
+    EXPECT_EQ(VisibleInstances, (std::vector<Uint32>{0, 2}));
+}
+
+} // namespace
@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <vector>
+
+#include "InstanceDataPool.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 NumValuesPerSlot = 16;
+
+std::vector<Uint32> ReadBuffer(IBuffer* pBuffer, Uint32 NumValues)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Instance data pool test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.Size           = sizeof(Uint32) * NumValues;
+
+    RefCntAutoPtr<IBuffer> pStagingBuff;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuff);
+    if (!pStagingBuff)
+        return {};
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuff, 0, BuffDesc.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuff, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    if (pData == nullptr)
+        return {};
+
+    const Uint32*       pValues = static_cast<const Uint32*>(pData);
+    std::vector<Uint32> Values{pValues, pValues + NumValues};
+    pContext->UnmapBuffer(pStagingBuff, MAP_READ);
+    return Values;
+}
+
+void MakeSlotData(Uint32 Seed, Uint32 Data[NumValuesPerSlot])
+{
+    for (Uint32 i = 0; i < NumValuesPerSlot; ++i)
+        Data[i] = Seed * 100 + i;
+}
+
+void TestInstanceDataPool(bool UseCompute)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (UseCompute && !pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    InstanceDataPoolCreateInfo CI;
+    CI.Name                   = "Instance data pool test";
+    CI.InstanceDataSize       = sizeof(Uint32) * NumValuesPerSlot;
+    CI.InitialCapacity        = 4;
+    CI.SlotsPerPage           = 4;
+    CI.BindFlags              = UseCompute ? BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS : BIND_SHADER_RESOURCE;
+    CI.ComputeUpdateThreshold = UseCompute ? 2 : 0;
+    InstanceDataPool Pool{pDevice, CI};
+
+    constexpr Uint32 NumSlots = 10;
+
+    std::vector<InstanceDataPool::SlotIndex> Slots;
+    for (Uint32 i = 0; i < NumSlots; ++i)
+    {
+        Uint32 Data[NumValuesPerSlot];
+        MakeSlotData(i, Data);
+        Slots.push_back(Pool.Allocate(Data));
+        ASSERT_EQ(Slots.back(), i);
+    }
+    EXPECT_EQ(Pool.GetSlotCount(), NumSlots);
+    EXPECT_EQ(Pool.GetNumDirtySlots(), NumSlots);
+
+    // All slots form one contiguous range
+    EXPECT_EQ(Pool.Commit(pContext), InstanceDataPool::UPDATE_MODE_CPU);
+    EXPECT_EQ(Pool.GetLastUploadSize(), Uint64{NumSlots} * CI.InstanceDataSize);
+    EXPECT_EQ(Pool.GetNumDirtySlots(), 0u);
+    EXPECT_EQ(Pool.Commit(pContext), InstanceDataPool::UPDATE_MODE_NONE);
+
+    // Modify every other slot to create several non-contiguous ranges
+    for (Uint32 i = 0; i < NumSlots; i += 2)
+    {
+        Uint32 Data[NumValuesPerSlot];
+        MakeSlotData(i + NumSlots, Data);
+        Pool.SetData(Slots[i], Data);
+    }
+    EXPECT_EQ(Pool.GetNumDirtySlots(), NumSlots / 2);
+    EXPECT_EQ(Pool.Commit(pContext), UseCompute ? InstanceDataPool::UPDATE_MODE_COMPUTE : InstanceDataPool::UPDATE_MODE_CPU);
+
+    // Freed slots are reused
+    Pool.Free(Slots[3]);
+    EXPECT_EQ(Pool.GetSlotCount(), NumSlots - 1);
+    EXPECT_EQ(Pool.Allocate(), Slots[3]);
+    EXPECT_EQ(Pool.Commit(pContext), InstanceDataPool::UPDATE_MODE_CPU);
+
+    const std::vector<Uint32> Values = ReadBuffer(Pool.GetBuffer(), NumSlots * NumValuesPerSlot);
+    ASSERT_EQ(Values.size(), size_t{NumSlots} * NumValuesPerSlot);
+    for (Uint32 i = 0; i < NumSlots; ++i)
+    {
+        Uint32 Expected[NumValuesPerSlot] = {};
+        if (i != 3)
+            MakeSlotData(i % 2 == 0 ? i + NumSlots : i, Expected);
+
+        for (Uint32 v = 0; v < NumValuesPerSlot; ++v)
+            EXPECT_EQ(Values[i * NumValuesPerSlot + v], Expected[v]) << "slot " << i << ", value " << v;
+    }
+}
+
+TEST(InstanceDataPoolTest, CPUUpdate)
+{
+    TestInstanceDataPool(false);
+}
+
+TEST(InstanceDataPoolTest, ComputeUpdate)
+{
+    TestInstanceDataPool(true);
+}
+
+} // namespace
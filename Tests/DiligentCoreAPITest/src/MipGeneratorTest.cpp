@@ -0,0 +1,205 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include "MipGenerator.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+Uint32 GetSliceColor(Uint32 TexIdx, Uint32 Slice)
+{
+    return 0xFF000000u | ((TexIdx * 64u + 32u) << 16u) | ((Slice * 48u + 16u) << 8u) | 0x80u;
+}
+
+TEST(MipGeneratorTest, GenerateMipsBatch)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    MipGeneratorCreateInfo CI;
+    CI.Name = "Mip generator test";
+    MipGenerator Generator{pDevice, CI};
+
+    // Non-power-of-two texture that uses the last thread group path, a small texture array and
+    // a texture that is only supported by IDeviceContext::GenerateMips().
+    struct TestTexture
+    {
+        Uint32     Width;
+        Uint32     Height;
+        Uint32     ArraySize;
+        Uint32     MipLevels;
+        BIND_FLAGS ExtraBindFlags;
+    };
+    // clang-format off
+    const TestTexture TestTextures[] =
+    {
+        {300, 129, 1, 9, BIND_UNORDERED_ACCESS},
+        { 64,  64, 3, 7, BIND_UNORDERED_ACCESS},
+        { 96,  80, 1, 7, BIND_NONE},
+    };
+    // clang-format on
+
+    std::vector<RefCntAutoPtr<ITexture>> Textures;
+    std::vector<ITexture*>               ppTextures;
+    for (Uint32 t = 0; t < _countof(TestTextures); ++t)
+    {
+        const TestTexture& Test = TestTextures[t];
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Mip generator test texture";
+        TexDesc.Type      = Test.ArraySize > 1 ? RESOURCE_DIM_TEX_2D_ARRAY : RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = Test.Width;
+        TexDesc.Height    = Test.Height;
+        TexDesc.ArraySize = Test.ArraySize;
+        TexDesc.MipLevels = Test.MipLevels;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET | Test.ExtraBindFlags;
+        TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+        TexDesc.Usage     = USAGE_DEFAULT;
+
+        // Every slice is filled with a constant color, so all levels must have the same color
+        std::vector<std::vector<Uint32>> SliceData(Test.ArraySize);
+        std::vector<TextureSubResData>   SubresData(Test.ArraySize * Test.MipLevels);
+        for (Uint32 slice = 0; slice < Test.ArraySize; ++slice)
+        {
+            SliceData[slice].resize(size_t{Test.Width} * Test.Height, GetSliceColor(t, slice));
+            for (Uint32 mip = 0; mip < Test.MipLevels; ++mip)
+                SubresData[slice * Test.MipLevels + mip] = TextureSubResData{SliceData[slice].data(), Test.Width * 4};
+        }
+        TextureData InitData{SubresData.data(), static_cast<Uint32>(SubresData.size())};
+
+        RefCntAutoPtr<ITexture> pTex;
+        pDevice->CreateTexture(TexDesc, &InitData, &pTex);
+        if (!pTex && Test.ExtraBindFlags == BIND_UNORDERED_ACCESS)
+            GTEST_SKIP() << "RGBA8 unordered access textures are not supported by this device";
+        ASSERT_NE(pTex, nullptr) << "Failed to create texture: " << TexDesc;
+
+        // Clear the levels that have to be generated
+        for (Uint32 slice = 0; slice < Test.ArraySize; ++slice)
+        {
+            for (Uint32 mip = 1; mip < Test.MipLevels; ++mip)
+            {
+                TextureViewDesc ViewDesc{nullptr, TEXTURE_VIEW_RENDER_TARGET, RESOURCE_DIM_TEX_2D_ARRAY};
+                ViewDesc.MostDetailedMip = mip;
+                ViewDesc.FirstArraySlice = slice;
+                ViewDesc.NumArraySlices  = 1;
+
+                RefCntAutoPtr<ITextureView> pRTV;
+                pTex->CreateView(ViewDesc, &pRTV);
+                ASSERT_NE(pRTV, nullptr);
+
+                ITextureView* pRTVs[] = {pRTV};
+                pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                constexpr float Zero[4] = {};
+                pContext->ClearRenderTarget(pRTV, Zero, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+        }
+        pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+        Textures.emplace_back(pTex);
+        ppTextures.emplace_back(pTex);
+    }
+    EXPECT_FALSE(Generator.IsSinglePassSupported(ppTextures.back()));
+
+    Generator.GenerateMips(pContext, ppTextures.data(), static_cast<Uint32>(ppTextures.size()));
+    // Run the batch again to check that the counters are reset
+    Generator.GenerateMips(pContext, ppTextures.data(), static_cast<Uint32>(ppTextures.size()));
+
+    for (Uint32 t = 0; t < _countof(TestTextures); ++t)
+    {
+        const TestTexture& Test = TestTextures[t];
+        EXPECT_EQ(Textures[t]->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+
+        TextureDesc StagingDesc;
+        StagingDesc.Name           = "Mip generator test staging texture";
+        StagingDesc.Type           = RESOURCE_DIM_TEX_2D_ARRAY;
+        StagingDesc.Format         = TEX_FORMAT_RGBA8_UNORM;
+        StagingDesc.Width          = Test.Width;
+        StagingDesc.Height         = Test.Height;
+        StagingDesc.ArraySize      = Test.ArraySize;
+        StagingDesc.MipLevels      = Test.MipLevels;
+        StagingDesc.Usage          = USAGE_STAGING;
+        StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+        RefCntAutoPtr<ITexture> pStagingTex;
+        pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+        ASSERT_NE(pStagingTex, nullptr);
+
+        for (Uint32 slice = 0; slice < Test.ArraySize; ++slice)
+        {
+            for (Uint32 mip = 1; mip < Test.MipLevels; ++mip)
+            {
+                CopyTextureAttribs CopyAttribs;
+                CopyAttribs.pSrcTexture              = Textures[t];
+                CopyAttribs.SrcMipLevel              = mip;
+                CopyAttribs.SrcSlice                 = slice;
+                CopyAttribs.pDstTexture              = pStagingTex;
+                CopyAttribs.DstMipLevel              = mip;
+                CopyAttribs.DstSlice                 = slice;
+                CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+                CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+                pContext->CopyTexture(CopyAttribs);
+            }
+        }
+        pContext->WaitForIdle();
+
+        for (Uint32 slice = 0; slice < Test.ArraySize; ++slice)
+        {
+            for (Uint32 mip = 1; mip < Test.MipLevels; ++mip)
+            {
+                const Uint32 MipWidth  = std::max(Test.Width >> mip, 1u);
+                const Uint32 MipHeight = std::max(Test.Height >> mip, 1u);
+
+                MappedTextureSubresource MappedData;
+                pContext->MapTextureSubresource(pStagingTex, mip, slice, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+                ASSERT_NE(MappedData.pData, nullptr);
+                Uint32 NumInvalidTexels = 0;
+                for (Uint32 y = 0; y < MipHeight; ++y)
+                {
+                    const Uint32* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(MappedData.pData) + MappedData.Stride * y);
+                    for (Uint32 x = 0; x < MipWidth; ++x)
+                        NumInvalidTexels += pRow[x] != GetSliceColor(t, slice) ? 1 : 0;
+                }
+                pContext->UnmapTextureSubresource(pStagingTex, mip, slice);
+                EXPECT_EQ(NumInvalidTexels, 0u) << "Texture " << t << ", slice " << slice << ", mip " << mip;
+            }
+        }
+    }
+}
+
+} // namespace
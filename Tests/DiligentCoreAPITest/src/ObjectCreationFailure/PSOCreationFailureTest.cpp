@@ -654,6 +654,16 @@ TEST_F(PSOCreationFailureTest, UndefinedCullMode)
     TestCreatePSOFailure(PsoCI, "RasterizerDesc.CullMode must not be CULL_MODE_UNDEFINED");
 }
 
+TEST_F(PSOCreationFailureTest, ExtendedDynamicStateNotSupported)
+{
+    if (GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.ExtendedDynamicState)
+        GTEST_SKIP();
+
+    auto PsoCI{GetGraphicsPSOCreateInfo("PSO Create Failure - Extended Dynamic State Not Supported")};
+    PsoCI.Flags |= PSO_CREATE_FLAG_EXTENDED_DYNAMIC_STATE;
+    TestCreatePSOFailure(PsoCI, "requires ExtendedDynamicState device feature");
+}
+
 TEST_F(PSOCreationFailureTest, InvalidDepthFunc)
 {
     auto PsoCI{GetGraphicsPSOCreateInfo("PSO Create Failure - Invalid Depth Func")};
@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#if VULKAN_SUPPORTED
+#    define VK_NO_PROTOTYPES
+#    include "vulkan/vulkan.h"
+#    include "TextureVk.h"
+#    include "FenceVk.h"
+#endif
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID
+#    include <unistd.h>
+#endif
+
+#include <vector>
+
+#include "GPUTestingEnvironment.hpp"
+#include "OffScreenSwapChain.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(OffScreenSwapChainTest, ExportFrames)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && !DeviceInfo.IsVulkanDevice())
+        GTEST_SKIP() << "Exportable textures and fences are only supported in Direct3D12 and Vulkan";
+    if (DeviceInfo.IsVulkanDevice() && !DeviceInfo.Features.NativeFence)
+        GTEST_SKIP() << "Exportable fences require NativeFence feature in Vulkan";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    SwapChainDesc SCDesc;
+    SCDesc.Width             = 128;
+    SCDesc.Height            = 64;
+    SCDesc.ColorBufferFormat = TEX_FORMAT_RGBA8_UNORM;
+    SCDesc.DepthBufferFormat = TEX_FORMAT_UNKNOWN;
+    SCDesc.BufferCount       = 2;
+    SCDesc.IsPrimary         = false;
+
+    std::vector<OffScreenSwapChainFrame> Frames;
+
+    RefCntAutoPtr<ISwapChain> pSwapChain;
+    CreateExportableOffScreenSwapChain(
+        pDevice, pContext, SCDesc,
+        [&](const OffScreenSwapChainFrame& Frame) {
+            Frames.push_back(Frame);
+        },
+        &pSwapChain);
+    if (!pSwapChain)
+        GTEST_SKIP() << "Exportable resources are not supported by the device";
+
+    constexpr Uint32 NumFrames = 3;
+    for (Uint32 i = 0; i < NumFrames; ++i)
+    {
+        ITextureView* pRTV = pSwapChain->GetCurrentBackBufferRTV();
+        ASSERT_NE(pRTV, nullptr);
+        EXPECT_NE(pRTV->GetTexture()->GetDesc().MiscFlags & MISC_TEXTURE_FLAG_EXPORTABLE, 0);
+
+        pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        constexpr float ClearColor[] = {0.25f, 0.5f, 0.75f, 1.f};
+        pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+        pSwapChain->Present();
+    }
+
+    ASSERT_EQ(Frames.size(), NumFrames);
+    for (Uint32 i = 0; i < NumFrames; ++i)
+    {
+        const auto& Frame = Frames[i];
+        EXPECT_EQ(Frame.BackBufferIndex, i % SCDesc.BufferCount);
+        EXPECT_EQ(Frame.FenceValue, Uint64{i} + 1);
+        ASSERT_NE(Frame.pFence, nullptr);
+        EXPECT_NE(Frame.pFence->GetDesc().Flags & FENCE_FLAG_EXPORTABLE, 0);
+        EXPECT_EQ(Frame.pBackBuffer->GetState(), RESOURCE_STATE_COMMON);
+    }
+    // Back buffers are reused in round-robin order
+    EXPECT_EQ(Frames[0].pBackBuffer, Frames[2].pBackBuffer);
+    EXPECT_NE(Frames[0].pBackBuffer, Frames[1].pBackBuffer);
+
+    Frames.back().pFence->Wait(Frames.back().FenceValue);
+    EXPECT_GE(Frames.back().pFence->GetCompletedValue(), Frames.back().FenceValue);
+
+#if VULKAN_SUPPORTED && (PLATFORM_LINUX || PLATFORM_ANDROID)
+    if (DeviceInfo.IsVulkanDevice())
+    {
+        RefCntAutoPtr<ITextureVk> pTextureVk{Frames.back().pBackBuffer, IID_TextureVk};
+        ASSERT_NE(pTextureVk, nullptr);
+
+        ExternalMemoryHandleVk MemHandle;
+        ASSERT_TRUE(pTextureVk->ExportMemoryHandle(MemHandle));
+        EXPECT_EQ(MemHandle.HandleType, static_cast<VkExternalMemoryHandleTypeFlags>(VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT));
+        EXPECT_GT(MemHandle.AllocationSize, 0u);
+        close(static_cast<int>(MemHandle.Handle));
+
+        RefCntAutoPtr<IFenceVk> pFenceVk{Frames.back().pFence, IID_FenceVk};
+        ASSERT_NE(pFenceVk, nullptr);
+
+        Uint64 SemHandle = 0;
+        ASSERT_TRUE(pFenceVk->ExportSemaphoreHandle(SemHandle));
+        close(static_cast<int>(SemHandle));
+    }
+#endif
+}
+
+} // namespace
@@ -2031,4 +2031,167 @@ TEST_F(PipelineResourceSignatureTest, UnusedNullResources)
     pSwapChain->Present();
 }
 
+TEST_F(PipelineResourceSignatureTest, InlineConstants)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    float ClearColor[] = {0.25, 0.5, 0.125, 0.75};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc       = {"Inline constants test VS", SHADER_TYPE_VERTEX, true};
+        ShaderCI.EntryPoint = "main";
+        ShaderCI.Source     = HLSL::DrawTest_ProceduralTriangleVS.c_str();
+        pDevice->CreateShader(ShaderCI, &pVS);
+        ASSERT_NE(pVS, nullptr);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        const char* PSSource = R"(
+cbuffer cbInlineConstants
+{
+    float4 g_ColorScale;
+}
+
+struct PSInput
+{
+    float4 Pos   : SV_POSITION;
+    float3 Color : COLOR;
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    return float4(PSIn.Color.rgb * g_ColorScale.rgb, g_ColorScale.a);
+}
+)";
+        ShaderCI.Desc       = {"Inline constants test PS", SHADER_TYPE_PIXEL, true};
+        ShaderCI.EntryPoint = "main";
+        ShaderCI.Source     = PSSource;
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+    }
+
+    const PipelineResourceDesc Resources[] = //
+        {
+            {SHADER_TYPE_PIXEL, "cbInlineConstants", 4, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS} //
+        };
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name         = "Inline constants test";
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_TRUE(pPRS);
+
+    auto pPSO = CreateGraphicsPSO(pVS, pPS, {pPRS});
+    ASSERT_TRUE(pPSO);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPRS->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_TRUE(pSRB);
+
+    auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "cbInlineConstants");
+    ASSERT_NE(pVar, nullptr);
+    EXPECT_EQ(pVar->Get(0), nullptr);
+
+    ShaderResourceDesc ResDesc;
+    pVar->GetResourceDesc(ResDesc);
+    EXPECT_EQ(ResDesc.ArraySize, 1u);
+
+    // Commit the SRB with different values first to make sure that the constants
+    // are uploaded every time the SRB is committed.
+    const float ZeroScale[] = {0, 0, 0, 0};
+    pVar->SetInlineConstants(ZeroScale, 0, 4);
+    EXPECT_NE(pVar->Get(0), nullptr);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const float ColorScale[] = {1, 1, 1, 1};
+    pVar->SetInlineConstants(ColorScale, 0, 2);
+    pVar->SetInlineConstants(&ColorScale[2], 2, 2);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    ITextureView* ppRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+    pContext->SetRenderTargets(1, ppRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->ClearRenderTarget(ppRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    pContext->SetPipelineState(pPSO);
+
+    DrawAttribs DrawAttrs{6, DRAW_FLAG_VERIFY_ALL};
+    pContext->Draw(DrawAttrs);
+
+    pSwapChain->Present();
+}
+
+TEST_F(PipelineResourceSignatureTest, CreateShaderResourceBindings)
+{
+    auto* const pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const PipelineResourceDesc Resources[] = //
+        {
+            {SHADER_TYPE_PIXEL, "g_StaticTex", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+            {SHADER_TYPE_PIXEL, "g_MutableTex", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL, "g_DynamicTex", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC} //
+        };
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name                     = "Batch SRB creation test";
+    PRSDesc.Resources                = Resources;
+    PRSDesc.NumResources             = _countof(Resources);
+    PRSDesc.SRBAllocationGranularity = 8;
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_TRUE(pPRS);
+
+    auto  pTexture = pEnv->CreateTexture("Batch SRB creation test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 64, 64);
+    auto* pTexSRV  = pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    SET_STATIC_VAR(pPRS, SHADER_TYPE_PIXEL, "g_StaticTex", Set, pTexSRV);
+
+    constexpr Uint32        NumSRBs         = 12;
+    IShaderResourceBinding* ppSRBs[NumSRBs] = {};
+    pPRS->CreateShaderResourceBindings(NumSRBs, ppSRBs, true);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRBs[NumSRBs];
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+        pSRBs[i].Attach(ppSRBs[i]);
+
+    IShaderResourceVariable* pMutableVar0 = nullptr;
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+    {
+        ASSERT_NE(pSRBs[i], nullptr);
+        EXPECT_TRUE(pSRBs[i]->StaticResourcesInitialized());
+        EXPECT_EQ(pSRBs[i]->GetPipelineResourceSignature(), pPRS);
+        if (i > 0)
+            EXPECT_NE(pSRBs[i], pSRBs[i - 1]);
+
+        IShaderResourceVariable* pMutableVar = pSRBs[i]->GetVariableByName(SHADER_TYPE_PIXEL, "g_MutableTex");
+        ASSERT_NE(pMutableVar, nullptr);
+        if (i == 0)
+            pMutableVar0 = pMutableVar;
+        // Variable index is the same in all SRBs of the signature
+        EXPECT_EQ(pSRBs[i]->GetVariableByIndex(SHADER_TYPE_PIXEL, pMutableVar0->GetIndex()), pMutableVar);
+        pMutableVar->Set(pTexSRV);
+
+        EXPECT_EQ(pSRBs[i]->GetVariableByName(SHADER_TYPE_PIXEL, "g_StaticTex"), nullptr);
+        EXPECT_NE(pSRBs[i]->GetVariableByName(SHADER_TYPE_PIXEL, "g_DynamicTex"), nullptr);
+        EXPECT_EQ(pSRBs[i]->GetVariableByName(SHADER_TYPE_VERTEX, "g_MutableTex"), nullptr);
+    }
+}
+
 } // namespace Diligent
@@ -31,6 +31,7 @@
 
 #include "GPUTestingEnvironment.hpp"
 #include "ThreadSignal.hpp"
+#include "MapHelper.hpp"
 
 #include "gtest/gtest.h"
 
@@ -665,4 +666,114 @@ TEST_F(QueryTest, DeferredContexts)
     }
 }
 
+
+TEST_F(QueryTest, ResolveQueriesAndConditionalRendering)
+{
+    const auto& DeviceInfo = GPUTestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
+    if (!DeviceInfo.Features.ConditionalRendering)
+    {
+        // Conditional rendering is only implemented in Direct3D12 and Vulkan
+        if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && !DeviceInfo.IsVulkanDevice())
+            EXPECT_EQ(DeviceInfo.Features.ConditionalRendering, DEVICE_FEATURE_STATE_DISABLED);
+        GTEST_SKIP() << "Conditional rendering is not supported by this device";
+    }
+    if (!DeviceInfo.Features.OcclusionQueries || !DeviceInfo.Features.BinaryOcclusionQueries)
+    {
+        GTEST_SKIP() << "Occlusion queries are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    // The first predicate is written by the query, the second one stays zero
+    const Uint64 InitialData[2] = {};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Conditional rendering predicate buffer";
+    BuffDesc.Size      = sizeof(InitialData);
+    BuffDesc.BindFlags = BIND_INDIRECT_DRAW_ARGS;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+
+    BufferData InitData{InitialData, sizeof(InitialData)};
+
+    RefCntAutoPtr<IBuffer> pPredicateBuffer;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pPredicateBuffer);
+    ASSERT_NE(pPredicateBuffer, nullptr);
+
+    BuffDesc.Name           = "Conditional rendering staging buffer";
+    BuffDesc.BindFlags      = BIND_NONE;
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    QueryDesc queryDesc;
+    queryDesc.Name = "Binary occlusion query for conditional rendering";
+    queryDesc.Type = QUERY_TYPE_BINARY_OCCLUSION;
+
+    RefCntAutoPtr<IQuery> pBinaryQuery;
+    pDevice->CreateQuery(queryDesc, &pBinaryQuery);
+    ASSERT_NE(pBinaryQuery, nullptr);
+
+    queryDesc.Name = "Occlusion query for conditional rendering";
+    queryDesc.Type = QUERY_TYPE_OCCLUSION;
+
+    std::vector<RefCntAutoPtr<IQuery>> Queries(3);
+    for (auto& pQuery : Queries)
+    {
+        pDevice->CreateQuery(queryDesc, &pQuery);
+        ASSERT_NE(pQuery, nullptr);
+    }
+
+    pContext->BeginQuery(pBinaryQuery);
+    DrawQuad(pContext);
+    pContext->EndQuery(pBinaryQuery);
+
+    IQuery* ppQueries[] = {pBinaryQuery};
+    pContext->ResolveQueries(ResolveQueriesAttribs{ppQueries, _countof(ppQueries), pPredicateBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION});
+
+    // Occlusion queries must not begin inside the predicated block as Direct3D12 predicates resolve commands too
+    auto DrawPredicatedQuad = [&](IQuery* pQuery, Uint64 Offset, bool Inverted) {
+        pContext->BeginQuery(pQuery);
+        pContext->BeginConditionalRendering(BeginConditionalRenderingAttribs{pPredicateBuffer, Offset, Inverted, RESOURCE_STATE_TRANSITION_MODE_TRANSITION});
+        DrawQuad(pContext);
+        pContext->EndConditionalRendering();
+        pContext->EndQuery(pQuery);
+    };
+
+    // Non-zero predicate written by the query
+    DrawPredicatedQuad(Queries[0], 0, false);
+    // Zero predicate
+    DrawPredicatedQuad(Queries[1], sizeof(Uint64), false);
+    // Zero predicate with inverted condition
+    DrawPredicatedQuad(Queries[2], sizeof(Uint64), true);
+
+    pContext->CopyBuffer(pPredicateBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, sizeof(InitialData), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    Uint64 NumSamples[3] = {};
+    for (size_t i = 0; i < Queries.size(); ++i)
+    {
+        QueryDataOcclusion QueryData;
+
+        auto QueryReady = Queries[i]->GetData(&QueryData, sizeof(QueryData));
+        ASSERT_TRUE(QueryReady) << "Query data must be available after idling the context";
+        NumSamples[i] = QueryData.NumSamples;
+    }
+    EXPECT_GT(NumSamples[0], Uint64{0});
+    EXPECT_EQ(NumSamples[1], Uint64{0});
+    EXPECT_GT(NumSamples[2], Uint64{0});
+
+    MapHelper<Uint64> Predicates{pContext, pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT};
+    ASSERT_NE(Predicates, nullptr);
+    EXPECT_NE(Predicates[0], Uint64{0}) << "Binary occlusion query result must be non-zero";
+    EXPECT_EQ(Predicates[1], Uint64{0});
+}
+
 } // namespace
@@ -0,0 +1,349 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RenderGraph.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TextureDesc GetTransientTexDesc(const char* Name)
+{
+    TextureDesc TexDesc;
+    TexDesc.Name      = Name;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 64;
+    TexDesc.Height    = 64;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_NONE;
+    return TexDesc;
+}
+
+TEST(RenderGraphTest, CullPasses)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RefCntAutoPtr<ITexture> pOutput = pEnv->CreateTexture("RenderGraphTest output", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET | BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_NE(pOutput, nullptr);
+
+    RenderGraph Graph{pDevice};
+
+    const auto Output = Graph.ImportTexture(pOutput, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+
+    int ExecutedPasses = 0;
+
+    // Pass 0: writes a transient texture that is read by pass 2
+    RenderGraphResource Tex0;
+    Graph.AddPass(
+        "Pass 0",
+        [&](RenderGraphBuilder& Builder) {
+            Tex0 = Builder.CreateTexture(GetTransientTexDesc("Tex0"));
+            Builder.Write(Tex0, RESOURCE_STATE_RENDER_TARGET);
+        },
+        [&](const RenderGraphContext& Ctx) {
+            ++ExecutedPasses;
+            EXPECT_NE(Ctx.GetTexture(Tex0), nullptr);
+        });
+
+    // Pass 1: writes a transient texture that is never read and must be culled
+    Graph.AddPass(
+        "Pass 1",
+        [&](RenderGraphBuilder& Builder) {
+            auto Unused = Builder.CreateTexture(GetTransientTexDesc("Unused"));
+            Builder.Write(Unused, RESOURCE_STATE_RENDER_TARGET);
+        },
+        [&](const RenderGraphContext&) {
+            ADD_FAILURE() << "Culled pass must not be executed";
+        });
+
+    // Pass 2: reads Tex0 and writes the output
+    Graph.AddPass(
+        "Pass 2",
+        [&](RenderGraphBuilder& Builder) {
+            Builder.Read(Tex0, RESOURCE_STATE_SHADER_RESOURCE);
+            Builder.Write(Output, RESOURCE_STATE_RENDER_TARGET);
+        },
+        [&](const RenderGraphContext& Ctx) {
+            ++ExecutedPasses;
+            EXPECT_EQ(Ctx.GetTexture(Output), pOutput);
+        });
+
+    Graph.Execute(pContext);
+
+    EXPECT_EQ(ExecutedPasses, 2);
+    EXPECT_FALSE(Graph.IsPassCulled(0));
+    EXPECT_TRUE(Graph.IsPassCulled(1));
+    EXPECT_FALSE(Graph.IsPassCulled(2));
+
+    const auto& Stats = Graph.GetStatistics();
+    EXPECT_EQ(Stats.NumPasses, 3u);
+    EXPECT_EQ(Stats.NumCulledPasses, 1u);
+    EXPECT_EQ(Stats.NumTransientResources, 1u);
+    EXPECT_EQ(Stats.NumTransientObjects, 1u);
+    // Tex0 -> RT, Tex0 -> SRV, Output -> RT, Output -> SRV
+    EXPECT_EQ(Stats.NumTransitions, 4u);
+
+    EXPECT_EQ(pOutput->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST(RenderGraphTest, SplitBarriers)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RefCntAutoPtr<ITexture> pOutput = pEnv->CreateTexture("RenderGraphTest output", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET | BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_NE(pOutput, nullptr);
+
+    RenderGraph Graph{pDevice};
+
+    const auto Output = Graph.ImportTexture(pOutput, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+
+    // Pass 1 runs between the write of Tex0 in pass 0 and its read in pass 2,
+    // so the Tex0 RT -> SRV transition can be split.
+    RenderGraphResource Tex0, Tex1;
+    Graph.AddPass(
+        "Pass 0",
+        [&](RenderGraphBuilder& Builder) {
+            Tex0 = Builder.CreateTexture(GetTransientTexDesc("Tex0"));
+            Builder.Write(Tex0, RESOURCE_STATE_RENDER_TARGET);
+        },
+        nullptr);
+    Graph.AddPass(
+        "Pass 1",
+        [&](RenderGraphBuilder& Builder) {
+            Tex1 = Builder.CreateTexture(GetTransientTexDesc("Tex1"));
+            Builder.Write(Tex1, RESOURCE_STATE_RENDER_TARGET);
+        },
+        nullptr);
+    Graph.AddPass(
+        "Pass 2",
+        [&](RenderGraphBuilder& Builder) {
+            Builder.Read(Tex0, RESOURCE_STATE_SHADER_RESOURCE);
+            Builder.Read(Tex1, RESOURCE_STATE_SHADER_RESOURCE);
+            Builder.Write(Output, RESOURCE_STATE_RENDER_TARGET);
+        },
+        nullptr);
+
+    Graph.Execute(pContext);
+
+    const auto& Stats = Graph.GetStatistics();
+    // Tex0 -> RT, Tex1 -> RT, Tex0 -> SRV, Tex1 -> SRV, Output -> RT, Output -> SRV
+    EXPECT_EQ(Stats.NumTransitions, 6u);
+    // Split barriers are only used in Direct3D12
+    EXPECT_EQ(Stats.NumSplitBarriers, pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D12 ? 1u : 0u);
+
+    EXPECT_EQ(pOutput->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST(RenderGraphTest, ReuseTransientResources)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RefCntAutoPtr<ITexture> pOutput = pEnv->CreateTexture("RenderGraphTest output", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET, 64, 64);
+    ASSERT_NE(pOutput, nullptr);
+
+    RenderGraph Graph{pDevice};
+
+    ITexture* pFirstFrameTex = nullptr;
+    for (Uint32 frame = 0; frame < 2; ++frame)
+    {
+        Graph.Reset();
+
+        const auto Output = Graph.ImportTexture(pOutput);
+
+        // A -> B -> C -> Output: the lifetimes of A and C do not overlap
+        RenderGraphResource Tex[3];
+        ITexture*           pTex[3] = {};
+        for (Uint32 i = 0; i < 3; ++i)
+        {
+            Graph.AddPass(
+                "Pass",
+                [&, i](RenderGraphBuilder& Builder) {
+                    if (i > 0)
+                        Builder.Read(Tex[i - 1], RESOURCE_STATE_SHADER_RESOURCE);
+                    Tex[i] = Builder.CreateTexture(GetTransientTexDesc("Tex"));
+                    Builder.Write(Tex[i], RESOURCE_STATE_RENDER_TARGET);
+                },
+                [&, i](const RenderGraphContext& Ctx) {
+                    pTex[i] = Ctx.GetTexture(Tex[i]);
+                });
+        }
+        Graph.AddPass(
+            "Final",
+            [&](RenderGraphBuilder& Builder) {
+                Builder.Read(Tex[2], RESOURCE_STATE_SHADER_RESOURCE);
+                Builder.Write(Output, RESOURCE_STATE_RENDER_TARGET);
+            },
+            nullptr);
+
+        Graph.Execute(pContext);
+
+        const auto& Stats = Graph.GetStatistics();
+        EXPECT_EQ(Stats.NumTransientResources, 3u);
+        EXPECT_EQ(Stats.NumTransientObjects, 2u);
+        ASSERT_NE(pTex[0], nullptr);
+        ASSERT_NE(pTex[1], nullptr);
+        EXPECT_NE(pTex[0], pTex[1]);
+        EXPECT_EQ(pTex[0], pTex[2]);
+
+        // Objects are reused across frames
+        if (frame == 0)
+            pFirstFrameTex = pTex[0];
+        else
+            EXPECT_TRUE(pTex[0] == pFirstFrameTex || pTex[1] == pFirstFrameTex);
+
+        pContext->Flush();
+    }
+
+    pContext->WaitForIdle();
+    Graph.Reset();
+    Graph.ReleaseTransientResources();
+}
+
+void TestSubpassMerging(bool EnableMerging)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    RefCntAutoPtr<ITexture> pOutput = pEnv->CreateTexture("RenderGraphTest output", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET | BIND_SHADER_RESOURCE, 64, 64);
+    ASSERT_NE(pOutput, nullptr);
+
+    RenderGraph Graph{pDevice, /*EnableSplitBarriers = */ true, EnableMerging};
+
+    IRenderPass* pFirstFrameRenderPass = nullptr;
+    for (Uint32 frame = 0; frame < 2; ++frame)
+    {
+        Graph.Reset();
+
+        const auto Output = Graph.ImportTexture(pOutput, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+
+        // G-buffer -> lighting, the G-buffer is only read at the current pixel
+        RenderGraphResource GBuffer;
+        IRenderPass*        pRenderPass[2]  = {};
+        Uint32              SubpassIndex[2] = {~0u, ~0u};
+        Graph.AddPass(
+            "GBuffer",
+            [&](RenderGraphBuilder& Builder) {
+                GBuffer = Builder.CreateTexture(GetTransientTexDesc("GBuffer"));
+                OptimizedClearValue ClearValue;
+                ClearValue.SetColor(TEX_FORMAT_RGBA8_UNORM, 0.25f, 0.5f, 0.75f, 1.f);
+                Builder.SetRenderTarget(0, GBuffer, ATTACHMENT_LOAD_OP_CLEAR, ClearValue);
+            },
+            [&](const RenderGraphContext& Ctx) {
+                pRenderPass[0]  = Ctx.GetRenderPass();
+                SubpassIndex[0] = Ctx.GetSubpassIndex();
+            });
+        Graph.AddPass(
+            "Lighting",
+            [&](RenderGraphBuilder& Builder) {
+                Builder.ReadInputAttachment(GBuffer);
+                Builder.SetRenderTarget(0, Output, ATTACHMENT_LOAD_OP_DISCARD);
+            },
+            [&](const RenderGraphContext& Ctx) {
+                pRenderPass[1]  = Ctx.GetRenderPass();
+                SubpassIndex[1] = Ctx.GetSubpassIndex();
+                EXPECT_EQ(Ctx.IsInputAttachment(GBuffer), EnableMerging);
+            });
+
+        Graph.Execute(pContext);
+
+        const auto& Stats = Graph.GetStatistics();
+        if (EnableMerging)
+        {
+            EXPECT_EQ(Stats.NumRenderPasses, 1u);
+            EXPECT_EQ(Stats.NumMergedPasses, 2u);
+            ASSERT_NE(pRenderPass[0], nullptr);
+            EXPECT_EQ(pRenderPass[0], pRenderPass[1]);
+            EXPECT_EQ(SubpassIndex[0], 0u);
+            EXPECT_EQ(SubpassIndex[1], 1u);
+
+            const auto& RPDesc = pRenderPass[0]->GetDesc();
+            ASSERT_EQ(RPDesc.AttachmentCount, 2u);
+            // The G-buffer is not used after the render pass
+            EXPECT_EQ(RPDesc.pAttachments[0].StoreOp, ATTACHMENT_STORE_OP_DISCARD);
+            EXPECT_EQ(RPDesc.pAttachments[1].StoreOp, ATTACHMENT_STORE_OP_STORE);
+
+            // Render passes are cached across frames
+            if (frame == 0)
+                pFirstFrameRenderPass = pRenderPass[0];
+            else
+                EXPECT_EQ(pRenderPass[0], pFirstFrameRenderPass);
+        }
+        else
+        {
+            EXPECT_EQ(Stats.NumRenderPasses, 0u);
+            EXPECT_EQ(Stats.NumMergedPasses, 0u);
+            EXPECT_EQ(pRenderPass[0], nullptr);
+            EXPECT_EQ(pRenderPass[1], nullptr);
+        }
+
+        EXPECT_EQ(pOutput->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+
+        pContext->Flush();
+    }
+
+    pContext->WaitForIdle();
+    Graph.Reset();
+    Graph.ReleaseTransientResources();
+}
+
+TEST(RenderGraphTest, SubpassMerging)
+{
+    TestSubpassMerging(true);
+}
+
+TEST(RenderGraphTest, SubpassMergingDisabled)
+{
+    TestSubpassMerging(false);
+}
+
+} // namespace
@@ -557,6 +557,110 @@ TEST_F(RenderPassTest, Draw)
     Present();
 }
 
+TEST_F(RenderPassTest, SecondaryCommandLists)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pSwapChain = pEnv->GetSwapChain();
+    auto* pContext   = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Secondary command lists are only supported in Vulkan";
+    }
+    if (pEnv->GetNumDeferredContexts() < 2)
+    {
+        GTEST_SKIP() << "At least two deferred contexts are required";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr float ClearColor[] = {0.5f, 0.25f, 0.375f, 0.75f};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    const auto&              SCDesc = pSwapChain->GetDesc();
+    RenderPassAttachmentDesc Attachments[1];
+    Attachments[0].Format       = SCDesc.ColorBufferFormat;
+    Attachments[0].InitialState = RESOURCE_STATE_RENDER_TARGET;
+    Attachments[0].FinalState   = RESOURCE_STATE_RENDER_TARGET;
+    Attachments[0].LoadOp       = ATTACHMENT_LOAD_OP_CLEAR;
+    Attachments[0].StoreOp      = ATTACHMENT_STORE_OP_STORE;
+
+    constexpr AttachmentReference RTAttachmentRefs0[] = {{0, RESOURCE_STATE_RENDER_TARGET}};
+
+    SubpassDesc Subpasses[1];
+    Subpasses[0].RenderTargetAttachmentCount = _countof(RTAttachmentRefs0);
+    Subpasses[0].pRenderTargetAttachments    = RTAttachmentRefs0;
+
+    RenderPassDesc RPDesc;
+    RPDesc.Name            = "Render pass secondary command lists test";
+    RPDesc.AttachmentCount = _countof(Attachments);
+    RPDesc.pAttachments    = Attachments;
+    RPDesc.SubpassCount    = _countof(Subpasses);
+    RPDesc.pSubpasses      = Subpasses;
+
+    RefCntAutoPtr<IRenderPass> pRenderPass;
+    pDevice->CreateRenderPass(RPDesc, &pRenderPass);
+    ASSERT_NE(pRenderPass, nullptr);
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    CreateDrawTrisPSO(pRenderPass, 1, pPSO);
+    ASSERT_TRUE(pPSO != nullptr);
+
+    ITextureView* pRTAttachments[] = {pSwapChain->GetCurrentBackBufferRTV()};
+
+    FramebufferDesc FBDesc;
+    FBDesc.Name            = "Render pass secondary command lists test framebuffer";
+    FBDesc.pRenderPass     = pRenderPass;
+    FBDesc.AttachmentCount = _countof(Attachments);
+    FBDesc.ppAttachments   = pRTAttachments;
+    RefCntAutoPtr<IFramebuffer> pFramebuffer;
+    pDevice->CreateFramebuffer(FBDesc, &pFramebuffer);
+    ASSERT_TRUE(pFramebuffer);
+
+    BeginRenderPassAttribs RPBeginInfo;
+    RPBeginInfo.pRenderPass  = pRenderPass;
+    RPBeginInfo.pFramebuffer = pFramebuffer;
+    RPBeginInfo.Flags        = BEGIN_RENDER_PASS_FLAG_SECONDARY_COMMAND_LISTS;
+
+    // Every deferred context draws one of the two triangles
+    constexpr Uint32            NumCmdLists = 2;
+    RefCntAutoPtr<ICommandList> CmdLists[NumCmdLists];
+    ICommandList*               CmdListPtrs[NumCmdLists] = {};
+    for (Uint32 i = 0; i < NumCmdLists; ++i)
+    {
+        auto* pCtx = pEnv->GetDeferredContext(i);
+        pCtx->Begin(0);
+        pCtx->BeginRenderPass(RPBeginInfo);
+        pCtx->SetPipelineState(pPSO);
+        DrawAttribs DrawAttrs{3, DRAW_FLAG_VERIFY_ALL};
+        DrawAttrs.StartVertexLocation = 3 * i;
+        pCtx->Draw(DrawAttrs);
+        pCtx->EndRenderPass();
+        pCtx->FinishCommandList(&CmdLists[i]);
+        ASSERT_NE(CmdLists[i], nullptr);
+        CmdListPtrs[i] = CmdLists[i];
+    }
+
+    OptimizedClearValue ClearValues[1];
+    ClearValues[0].Color[0] = ClearColor[0];
+    ClearValues[0].Color[1] = ClearColor[1];
+    ClearValues[0].Color[2] = ClearColor[2];
+    ClearValues[0].Color[3] = ClearColor[3];
+
+    RPBeginInfo.pClearValues        = ClearValues;
+    RPBeginInfo.ClearValueCount     = _countof(ClearValues);
+    RPBeginInfo.StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContext->BeginRenderPass(RPBeginInfo);
+    pContext->ExecuteCommandLists(NumCmdLists, CmdListPtrs);
+    pContext->EndRenderPass();
+
+    for (Uint32 i = 0; i < NumCmdLists; ++i)
+        pEnv->GetDeferredContext(i)->FinishFrame();
+
+    Present();
+}
+
 void RenderPassTest::TestMSResolve(bool UseMemoryless)
 {
     auto* pEnv       = GPUTestingEnvironment::GetInstance();
@@ -1304,4 +1408,96 @@ TEST_F(RenderPassTest, InputAttachmentGeneralLayoutWithSignature)
     TestInputAttachmentGeneralLayout(true);
 }
 
+TEST_F(RenderPassTest, MultiView)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pSwapChain = pEnv->GetSwapChain();
+    auto* pContext   = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.MultiView)
+    {
+        GTEST_SKIP() << "Multiview is not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr float ClearColor[] = {0.25f, 0.5f, 0.375f, 0.5f};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    const auto& SCDesc = pSwapChain->GetDesc();
+
+    constexpr Uint32 NumViews = 2;
+
+    RefCntAutoPtr<ITexture> pTex;
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Multiview test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+        TexDesc.Format    = SCDesc.ColorBufferFormat;
+        TexDesc.Width     = SCDesc.Width;
+        TexDesc.Height    = SCDesc.Height;
+        TexDesc.ArraySize = NumViews;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+        TexDesc.MipLevels = 1;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTex);
+        ASSERT_NE(pTex, nullptr);
+    }
+
+    RenderPassAttachmentDesc Attachments[1];
+    Attachments[0].Format       = SCDesc.ColorBufferFormat;
+    Attachments[0].InitialState = RESOURCE_STATE_RENDER_TARGET;
+    Attachments[0].FinalState   = RESOURCE_STATE_RENDER_TARGET;
+    Attachments[0].LoadOp       = ATTACHMENT_LOAD_OP_CLEAR;
+    Attachments[0].StoreOp      = ATTACHMENT_STORE_OP_STORE;
+
+    constexpr AttachmentReference RTAttachmentRefs0[] = {{0, RESOURCE_STATE_RENDER_TARGET}};
+
+    SubpassDesc Subpasses[1];
+    Subpasses[0].RenderTargetAttachmentCount = _countof(RTAttachmentRefs0);
+    Subpasses[0].pRenderTargetAttachments    = RTAttachmentRefs0;
+    Subpasses[0].ViewMask                    = (1u << NumViews) - 1u;
+
+    RenderPassDesc RPDesc;
+    RPDesc.Name            = "Multiview render pass test";
+    RPDesc.AttachmentCount = _countof(Attachments);
+    RPDesc.pAttachments    = Attachments;
+    RPDesc.SubpassCount    = _countof(Subpasses);
+    RPDesc.pSubpasses      = Subpasses;
+
+    RefCntAutoPtr<IRenderPass> pRenderPass;
+    pDevice->CreateRenderPass(RPDesc, &pRenderPass);
+    ASSERT_NE(pRenderPass, nullptr);
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    CreateDrawTrisPSO(pRenderPass, 1, pPSO);
+    ASSERT_TRUE(pPSO != nullptr);
+
+    ITextureView* pRTAttachments[] = {pTex->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+
+    FramebufferDesc FBDesc;
+    FBDesc.Name            = "Multiview render pass test framebuffer";
+    FBDesc.pRenderPass     = pRenderPass;
+    FBDesc.AttachmentCount = _countof(Attachments);
+    FBDesc.ppAttachments   = pRTAttachments;
+    RefCntAutoPtr<IFramebuffer> pFramebuffer;
+    pDevice->CreateFramebuffer(FBDesc, &pFramebuffer);
+    ASSERT_TRUE(pFramebuffer);
+
+    DrawTris(pRenderPass, pFramebuffer, pPSO, ClearColor);
+
+    // The draw is broadcast to all views, so the last slice must match the reference
+    CopyTextureAttribs CopyAttrs;
+    CopyAttrs.pSrcTexture = pTex;
+    CopyAttrs.SrcSlice    = NumViews - 1;
+    CopyAttrs.pDstTexture = pSwapChain->GetCurrentBackBufferRTV()->GetTexture();
+
+    CopyAttrs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    CopyAttrs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+    pContext->CopyTexture(CopyAttrs);
+
+    Present();
+}
+
 } // namespace
@@ -33,6 +33,9 @@
 #include "FastRand.hpp"
 #include "GraphicsTypesX.hpp"
 #include "CallbackWrapper.hpp"
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
+#include "ThreadPool.hpp"
 #include "ResourceLayoutTestCommon.hpp"
 
 #include "InlineShaders/RayTracingTestHLSL.h"
@@ -1095,6 +1098,196 @@ TEST(RenderStateCacheTest, AppendData)
     }
 }
 
+TEST(RenderStateCacheTest, Journal)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    auto pWhiteTexture = CreateWhiteTexture();
+
+    constexpr bool UseSignature  = false;
+    constexpr bool UseRenderPass = false;
+    constexpr bool CompileAsync  = false;
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+
+    for (Uint32 HotReload = 0; HotReload < 2; ++HotReload)
+    {
+        RefCntAutoPtr<IDataBlob> pJournalData = DataBlobImpl::Create();
+        {
+            auto pJournal = MemoryFileStream::Create(pJournalData);
+
+            auto pCache = CreateCache(pDevice, HotReload);
+
+            RefCntAutoPtr<IShader> pCS;
+            CreateComputeShader(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pCS, false);
+            ASSERT_NE(pCS, nullptr);
+
+            RefCntAutoPtr<IPipelineState> pComputePSO;
+            CreateComputePSO(pCache, /*PresentInCache = */ false, pCS, UseSignature, CompileAsync, &pComputePSO);
+            ASSERT_NE(pComputePSO, nullptr);
+
+            EXPECT_TRUE(pCache->AppendToJournal(ContentVersion, pJournal));
+            const size_t FirstRecordSize = pJournalData->GetSize();
+            EXPECT_GT(FirstRecordSize, size_t{0});
+
+            // Nothing new - the journal must not grow
+            EXPECT_TRUE(pCache->AppendToJournal(ContentVersion, pJournal));
+            EXPECT_EQ(pJournalData->GetSize(), FirstRecordSize);
+
+            RefCntAutoPtr<IShader> pVS, pPS;
+            CreateGraphicsShaders(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pVS, pPS, false);
+            ASSERT_NE(pVS, nullptr);
+            ASSERT_NE(pPS, nullptr);
+
+            RefCntAutoPtr<IPipelineState> pGraphicsPSO;
+            CreateGraphicsPSO(pCache, /*PresentInCache = */ false, pVS, pPS, UseRenderPass, CompileAsync, &pGraphicsPSO);
+            ASSERT_NE(pGraphicsPSO, nullptr);
+
+            EXPECT_TRUE(pCache->AppendToJournal(ContentVersion, pJournal, pThreadPool));
+            pCache->WaitForJournal();
+            EXPECT_GT(pJournalData->GetSize(), FirstRecordSize);
+        }
+
+        {
+            auto pCache = CreateCache(pDevice, HotReload);
+            EXPECT_TRUE(pCache->LoadJournal(pJournalData, ContentVersion));
+
+            RefCntAutoPtr<IShader> pCS;
+            CreateComputeShader(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pCS, /*PresentInCache = */ true);
+            ASSERT_NE(pCS, nullptr);
+
+            RefCntAutoPtr<IPipelineState> pComputePSO;
+            CreateComputePSO(pCache, /*PresentInCache = */ true, pCS, UseSignature, CompileAsync, &pComputePSO);
+            ASSERT_NE(pComputePSO, nullptr);
+
+            RefCntAutoPtr<IShader> pVS, pPS;
+            CreateGraphicsShaders(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pVS, pPS, /*PresentInCache = */ true);
+            ASSERT_NE(pVS, nullptr);
+            ASSERT_NE(pPS, nullptr);
+
+            RefCntAutoPtr<IPipelineState> pGraphicsPSO;
+            CreateGraphicsPSO(pCache, /*PresentInCache = */ true, pVS, pPS, UseRenderPass, CompileAsync, &pGraphicsPSO);
+            ASSERT_NE(pGraphicsPSO, nullptr);
+
+            VerifyGraphicsPSO(pGraphicsPSO, nullptr, pWhiteTexture, UseRenderPass);
+
+            // Compact the journal into a single archive
+            RefCntAutoPtr<IDataBlob> pData;
+            pCache->WriteToBlob(ContentVersion, &pData);
+            ASSERT_NE(pData, nullptr);
+        }
+    }
+}
+
+TEST(RenderStateCacheTest, PrewarmManifest)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    auto pWhiteTexture = CreateWhiteTexture();
+
+    constexpr bool UseSignature  = false;
+    constexpr bool UseRenderPass = false;
+    constexpr bool CompileAsync  = false;
+
+    RenderStateCacheCreateInfo CacheCI{pDevice, RENDER_STATE_CACHE_LOG_LEVEL_VERBOSE};
+    CacheCI.RecordUsage = true;
+
+    RefCntAutoPtr<IDataBlob> pData;
+    RefCntAutoPtr<IDataBlob> pManifest;
+    {
+        RefCntAutoPtr<IRenderStateCache> pCache;
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_TRUE(pCache);
+
+        RefCntAutoPtr<IShader> pCS;
+        CreateComputeShader(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pCS, false);
+        ASSERT_NE(pCS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pComputePSO;
+        CreateComputePSO(pCache, /*PresentInCache = */ false, pCS, UseSignature, CompileAsync, &pComputePSO);
+        ASSERT_NE(pComputePSO, nullptr);
+
+        RefCntAutoPtr<IShader> pVS, pPS;
+        CreateGraphicsShaders(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pVS, pPS, false);
+        ASSERT_NE(pVS, nullptr);
+        ASSERT_NE(pPS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pGraphicsPSO;
+        CreateGraphicsPSO(pCache, /*PresentInCache = */ false, pVS, pPS, UseRenderPass, CompileAsync, &pGraphicsPSO);
+        ASSERT_NE(pGraphicsPSO, nullptr);
+
+        EXPECT_TRUE(pCache->WriteUsageManifest(&pManifest));
+        ASSERT_NE(pManifest, nullptr);
+
+        pCache->WriteToBlob(ContentVersion, &pData);
+        ASSERT_NE(pData, nullptr);
+
+        // Usage recorded after the reset must not include the pipelines created above
+        pCache->ResetUsage();
+        RefCntAutoPtr<IDataBlob> pEmptyManifest;
+        EXPECT_TRUE(pCache->WriteUsageManifest(&pEmptyManifest));
+        ASSERT_NE(pEmptyManifest, nullptr);
+        EXPECT_LT(pEmptyManifest->GetSize(), pManifest->GetSize());
+    }
+
+    {
+        RefCntAutoPtr<IRenderStateCache> pCache;
+        CreateRenderStateCache(CacheCI, &pCache);
+        ASSERT_TRUE(pCache);
+        EXPECT_TRUE(pCache->Load(pData, ContentVersion));
+
+        EXPECT_EQ(pCache->Prewarm(pManifest), 2u);
+        // All pipelines are alive, so there is nothing to pre-warm
+        EXPECT_EQ(pCache->Prewarm(pManifest), 0u);
+
+        RefCntAutoPtr<IShader> pCS;
+        CreateComputeShader(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pCS, /*PresentInCache = */ true);
+        ASSERT_NE(pCS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pComputePSO;
+        CreateComputePSO(pCache, /*PresentInCache = */ true, pCS, UseSignature, CompileAsync, &pComputePSO);
+        ASSERT_NE(pComputePSO, nullptr);
+        EXPECT_EQ(pComputePSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+
+        RefCntAutoPtr<IShader> pVS, pPS;
+        CreateGraphicsShaders(pCache, pShaderSourceFactory, SHADER_COMPILE_FLAG_NONE, pVS, pPS, /*PresentInCache = */ true);
+        ASSERT_NE(pVS, nullptr);
+        ASSERT_NE(pPS, nullptr);
+
+        RefCntAutoPtr<IPipelineState> pGraphicsPSO;
+        CreateGraphicsPSO(pCache, /*PresentInCache = */ true, pVS, pPS, UseRenderPass, CompileAsync, &pGraphicsPSO);
+        ASSERT_NE(pGraphicsPSO, nullptr);
+        EXPECT_EQ(pGraphicsPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+
+        VerifyGraphicsPSO(pGraphicsPSO, nullptr, pWhiteTexture, UseRenderPass);
+
+        EXPECT_EQ(pCache->GetNumPendingPrewarmPipelines(), 0u);
+        pCache->ReleasePrewarmedPipelines();
+    }
+}
+
 TEST(RenderStateCacheTest, RenderDeviceWithCache)
 {
     constexpr bool Execute = false;
@@ -1152,6 +1345,7 @@ enum TEST_PIPELINE_RELOAD_FLAGS : Uint32
     TEST_PIPELINE_RELOAD_FLAG_CREATE_SRB_BEFORE_RELOAD = 1u << 1u,
     TEST_PIPELINE_RELOAD_FLAG_USE_SIGNATURES           = 1u << 2u,
     TEST_PIPELINE_RELOAD_FLAG_ASYNC_COMPILE            = 1u << 3u,
+    TEST_PIPELINE_RELOAD_FLAG_RELOAD_FILES             = 1u << 4u,
 };
 DEFINE_FLAG_ENUM_OPERATORS(TEST_PIPELINE_RELOAD_FLAGS);
 
@@ -1161,6 +1355,7 @@ void TestPipelineReload(TEST_PIPELINE_RELOAD_FLAGS Flags)
     const bool CreateSrbBeforeReload = Flags & TEST_PIPELINE_RELOAD_FLAG_CREATE_SRB_BEFORE_RELOAD;
     const bool UseSignatures         = Flags & TEST_PIPELINE_RELOAD_FLAG_USE_SIGNATURES;
     const bool AsyncCompile          = Flags & TEST_PIPELINE_RELOAD_FLAG_ASYNC_COMPILE;
+    const bool ReloadFiles           = Flags & TEST_PIPELINE_RELOAD_FLAG_RELOAD_FILES;
 
     auto* pEnv       = GPUTestingEnvironment::GetInstance();
     auto* pDevice    = pEnv->GetDevice();
@@ -1396,7 +1591,20 @@ void TestPipelineReload(TEST_PIPELINE_RELOAD_FLAGS Flags)
                 GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
             });
 
-        Uint32 NumStatesReloaded = pCache->Reload(ModifyPSO, ModifyPSO);
+        Uint32 NumStatesReloaded = 0;
+        if (ReloadFiles)
+        {
+            const char* UnrelatedFiles[] = {"shaders/RenderStateCache/ComputeShader.csh"};
+            EXPECT_EQ(pCache->ReloadFiles(UnrelatedFiles, _countof(UnrelatedFiles), ModifyPSO, ModifyPSO), 0u);
+
+            // Both shaders include GraphicsCommon.h. Absolute paths reported by a file watcher must match relative include paths.
+            const char* ChangedFiles[] = {"/home/user/assets/shaders/RenderStateCache/GraphicsCommon.h"};
+            NumStatesReloaded          = pCache->ReloadFiles(ChangedFiles, _countof(ChangedFiles), ModifyPSO, ModifyPSO);
+        }
+        else
+        {
+            NumStatesReloaded = pCache->Reload(ModifyPSO, ModifyPSO);
+        }
         if (!AsyncCompile)
             EXPECT_EQ(NumStatesReloaded, pass == 0 ? 3u : 0u);
         ASSERT_EQ(pPSO->GetStatus(AsyncCompile), PIPELINE_STATE_STATUS_READY);
@@ -1472,6 +1680,15 @@ TEST(RenderStateCacheTest, Reload_Signatures_SrbBeforeReload_Async)
     TestPipelineReload(TEST_PIPELINE_RELOAD_FLAG_CREATE_SRB_BEFORE_RELOAD | TEST_PIPELINE_RELOAD_FLAG_USE_SIGNATURES | TEST_PIPELINE_RELOAD_FLAG_ASYNC_COMPILE);
 }
 
+TEST(RenderStateCacheTest, ReloadFiles)
+{
+    TestPipelineReload(TEST_PIPELINE_RELOAD_FLAG_RELOAD_FILES);
+}
+
+TEST(RenderStateCacheTest, ReloadFiles_Signatures_Async)
+{
+    TestPipelineReload(TEST_PIPELINE_RELOAD_FLAG_USE_SIGNATURES | TEST_PIPELINE_RELOAD_FLAG_RELOAD_FILES | TEST_PIPELINE_RELOAD_FLAG_ASYNC_COMPILE);
+}
 
 TEST(RenderStateCacheTest, Reload_Signatures2)
 {
@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include "ShadingRateGenerator.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 TestWidth  = 128;
+constexpr Uint32 TestHeight = 64;
+
+RefCntAutoPtr<ITexture> CreateColorTexture(IRenderDevice* pDevice, bool Checkerboard)
+{
+    std::vector<Uint32> Texels(TestWidth * TestHeight);
+    for (Uint32 y = 0; y < TestHeight; ++y)
+    {
+        for (Uint32 x = 0; x < TestWidth; ++x)
+            Texels[x + y * TestWidth] = (Checkerboard && ((x + y) & 1) != 0) ? 0xFFFFFFFFu : 0xFF808080u;
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Shading rate generator test color";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Width     = TestWidth;
+    TexDesc.Height    = TestHeight;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_IMMUTABLE;
+
+    TextureSubResData SubResData{Texels.data(), TestWidth * sizeof(Uint32)};
+    TextureData       InitData{&SubResData, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    return pTexture;
+}
+
+// Returns the shading rate map texels, two bytes per texel for SHADING_RATE_FORMAT_UNORM8
+std::vector<Uint8> ReadShadingRateMap(IRenderDevice* pDevice, IDeviceContext* pContext, ITexture* pMap)
+{
+    TextureDesc StagingDesc    = pMap->GetDesc();
+    StagingDesc.Name           = "Shading rate generator test staging texture";
+    StagingDesc.BindFlags      = BIND_NONE;
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<ITexture> pStagingTex;
+    pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+    if (!pStagingTex)
+        return {};
+
+    CopyTextureAttribs CopyAttribs{pMap, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    pContext->CopyTexture(CopyAttribs);
+    pContext->WaitForIdle();
+
+    const Uint32 TexelSize = StagingDesc.Format == TEX_FORMAT_RG8_UNORM ? 2 : 1;
+
+    std::vector<Uint8> Texels(size_t{StagingDesc.Width} * StagingDesc.Height * TexelSize);
+
+    MappedTextureSubresource MappedData;
+    pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+    if (MappedData.pData == nullptr)
+        return {};
+    for (Uint32 y = 0; y < StagingDesc.Height; ++y)
+    {
+        const Uint8* pRow = static_cast<const Uint8*>(MappedData.pData) + MappedData.Stride * y;
+        std::copy(pRow, pRow + StagingDesc.Width * TexelSize, Texels.begin() + size_t{y} * StagingDesc.Width * TexelSize);
+    }
+    pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+
+    return Texels;
+}
+
+TEST(ShadingRateGeneratorTest, LuminanceGradients)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    if (!pDevice->GetDeviceInfo().Features.VariableRateShading)
+        GTEST_SKIP() << "Variable rate shading is not supported by this device";
+
+    const ShadingRateProperties& SRProps = pDevice->GetAdapterInfo().ShadingRate;
+    if ((SRProps.CapFlags & SHADING_RATE_CAP_FLAG_TEXTURE_BASED) == 0)
+        GTEST_SKIP() << "Texture-based variable rate shading is not supported by this device";
+    if (SRProps.ShadingRateTextureAccess != SHADING_RATE_TEXTURE_ACCESS_ON_GPU)
+        GTEST_SKIP() << "This test requires the shading rate texture to be accessed on the GPU";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ShadingRateGeneratorCreateInfo CI;
+    CI.Name   = "Shading rate generator test";
+    CI.Width  = TestWidth;
+    CI.Height = TestHeight;
+    ShadingRateGenerator Generator{pDevice, CI};
+
+    const uint2 NumTiles = Generator.GetNumTiles();
+    EXPECT_EQ(NumTiles.x, (TestWidth + Generator.GetTileSize().x - 1) / Generator.GetTileSize().x);
+    EXPECT_EQ(NumTiles.y, (TestHeight + Generator.GetTileSize().y - 1) / Generator.GetTileSize().y);
+
+    ITextureView* pMapView = Generator.GetShadingRateMap();
+    ASSERT_NE(pMapView, nullptr);
+    ITexture* pMap = pMapView->GetTexture();
+    EXPECT_EQ(pMap->GetDesc().Width, NumTiles.x);
+    EXPECT_EQ(pMap->GetDesc().Height, NumTiles.y);
+
+    // Coarsest supported rate that does not exceed 4x4
+    SHADING_RATE CoarsestRate = SHADING_RATE_1X1;
+    for (Uint32 i = 0; i < SRProps.NumShadingRates; ++i)
+    {
+        const SHADING_RATE Rate = SRProps.ShadingRates[i].Rate;
+        if (!SRProps.ShadingRates[i].HasSampleCount(1))
+            continue;
+        if ((Rate >> SHADING_RATE_X_SHIFT) + (Rate & 0x3) > (CoarsestRate >> SHADING_RATE_X_SHIFT) + (CoarsestRate & 0x3))
+            CoarsestRate = Rate;
+    }
+
+    for (bool Checkerboard : {false, true})
+    {
+        RefCntAutoPtr<ITexture> pColor = CreateColorTexture(pDevice, Checkerboard);
+        ASSERT_NE(pColor, nullptr);
+
+        ShadingRateGenerator::GenerateAttribs Attribs;
+        Attribs.pColorSRV = pColor->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+        Generator.Generate(pContext, Attribs);
+        ASSERT_EQ(Generator.GetShadingRateMap(), pMapView);
+
+        const std::vector<Uint8> Texels = ReadShadingRateMap(pDevice, pContext, pMap);
+        ASSERT_FALSE(Texels.empty());
+
+        if (SRProps.Format == SHADING_RATE_FORMAT_PALETTE)
+        {
+            // Flat color is shaded at the coarsest rate, the checkerboard at the full rate
+            const Uint8 ExpectedRate = Checkerboard ? Uint8{SHADING_RATE_1X1} : Uint8{CoarsestRate};
+            for (size_t i = 0; i < Texels.size(); ++i)
+                EXPECT_EQ(Texels[i], ExpectedRate) << "Tile " << i << (Checkerboard ? " (checkerboard)" : " (flat)");
+        }
+        else
+        {
+            // Fragment density: 1.0 for the full rate, 0.25 for the quarter rate
+            const Uint8 ExpectedDensity = Checkerboard ? 255 : 64;
+            for (size_t i = 0; i < Texels.size(); ++i)
+                EXPECT_NEAR(Texels[i], ExpectedDensity, 1) << "Tile " << i / 2 << (Checkerboard ? " (checkerboard)" : " (flat)");
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,215 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "SparseTextureStreamer.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+IDeviceContext* FindSparseBindingContext()
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    if (!pDevice->GetDeviceInfo().Features.SparseResources ||
+        (pDevice->GetAdapterInfo().SparseResources.CapFlags & SPARSE_RESOURCE_CAP_FLAG_TEXTURE_2D) == 0)
+        return nullptr;
+
+    for (Uint32 CtxInd = 0; CtxInd < pEnv->GetNumImmediateContexts(); ++CtxInd)
+    {
+        auto* pCtx = pEnv->GetDeviceContext(CtxInd);
+        if ((pCtx->GetDesc().QueueType & COMMAND_QUEUE_TYPE_SPARSE_BINDING) == COMMAND_QUEUE_TYPE_SPARSE_BINDING)
+            return pCtx;
+    }
+    return nullptr;
+}
+
+struct TestTileLoader
+{
+    std::vector<SparseTextureTile> LoadedTiles;
+
+    bool operator()(const SparseTextureTile& Tile, const Box& Region, const MappedTextureSubresource& Data)
+    {
+        EXPECT_NE(Data.pData, nullptr);
+        EXPECT_GE(Data.Stride, Uint64{Region.Width()} * 4);
+        for (Uint32 y = 0; y < Region.Height(); ++y)
+        {
+            Uint32* pRow = reinterpret_cast<Uint32*>(static_cast<Uint8*>(Data.pData) + Data.Stride * y);
+            for (Uint32 x = 0; x < Region.Width(); ++x)
+                pRow[x] = 0xA0000000u | (Tile.MipLevel << 16u) | (Tile.Y << 8u) | Tile.X;
+        }
+        LoadedTiles.push_back(Tile);
+        return true;
+    }
+};
+
+SparseTextureStreamerCreateInfo GetTestCreateInfo(TestTileLoader& Loader, Uint32 NumMemoryPages)
+{
+    SparseTextureStreamerCreateInfo CI;
+    CI.Name             = "Sparse texture streamer test";
+    CI.Width            = 2048;
+    CI.Height           = 256;
+    CI.Format           = TEX_FORMAT_RGBA8_UNORM;
+    CI.NumMemoryPages   = NumMemoryPages;
+    CI.MaxBindsPerFrame = 8;
+    CI.TileLoader       = [&Loader](const SparseTextureTile& Tile, const Box& Region, const MappedTextureSubresource& Data) {
+        return Loader(Tile, Region, Data);
+    };
+    return CI;
+}
+
+void RequestMip(SparseTextureStreamer& Streamer, Uint32 RegionX, Uint32 RegionY, Uint32 MipLevel)
+{
+    std::vector<Uint32> Feedback(size_t{Streamer.GetNumRegionsX()} * Streamer.GetNumRegionsY(), SparseTextureStreamer::InvalidFeedback);
+    Feedback[size_t{RegionY} * Streamer.GetNumRegionsX() + RegionX] = MipLevel;
+    Streamer.AnalyzeFeedback(Feedback.data(), Feedback.size());
+}
+
+TEST(SparseTextureStreamerTest, Residency)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    IDeviceContext* pBindingCtx = FindSparseBindingContext();
+    if (pBindingCtx == nullptr)
+        GTEST_SKIP() << "Sparse 2D textures are not supported by this device";
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TestTileLoader        Loader;
+    SparseTextureStreamer Streamer{pDevice, GetTestCreateInfo(Loader, 16)};
+    ASSERT_NE(Streamer.GetTexture(), nullptr);
+    ASSERT_NE(Streamer.GetResidencyMap(), nullptr);
+    ASSERT_NE(Streamer.GetFeedbackBuffer(), nullptr);
+    ASSERT_NE(Streamer.GetMemory(), nullptr);
+
+    const Uint32 FirstMipInTail = Streamer.GetFirstMipInTail();
+    if (FirstMipInTail == 0)
+        GTEST_SKIP() << "All mip levels of the test texture are packed into the mip tail";
+
+    // The first update binds and loads the mip tail
+    Streamer.Update(pContext, pBindingCtx);
+    EXPECT_TRUE(Streamer.IsTileResident({0, 0, FirstMipInTail}));
+    EXPECT_EQ(Streamer.GetResidentMip(0, 0), FirstMipInTail);
+    EXPECT_EQ(Loader.LoadedTiles.size(), size_t{Streamer.GetTexture()->GetDesc().MipLevels - FirstMipInTail});
+    Loader.LoadedTiles.clear();
+
+    // Requesting mip level 0 binds the tile and all its ancestors in a single batch
+    RequestMip(Streamer, 1, 1, 0);
+    Streamer.Update(pContext, pBindingCtx);
+    for (Uint32 Mip = 0; Mip < FirstMipInTail; ++Mip)
+        EXPECT_TRUE(Streamer.IsTileResident({1u >> Mip, 1u >> Mip, Mip})) << "Mip " << Mip;
+    EXPECT_EQ(Loader.LoadedTiles.size(), size_t{FirstMipInTail});
+    // Ancestors are loaded first
+    if (!Loader.LoadedTiles.empty())
+    {
+        EXPECT_EQ(Loader.LoadedTiles.front().MipLevel, FirstMipInTail - 1);
+    }
+
+    EXPECT_EQ(Streamer.GetResidentMip(1, 1), 0u);
+    EXPECT_EQ(Streamer.GetResidentMip(0, 1), FirstMipInTail > 1 ? 1u : FirstMipInTail);
+    EXPECT_EQ(Streamer.GetResidentMip(Streamer.GetNumRegionsX() - 1, 0), FirstMipInTail);
+
+    SparseTextureStreamerStats Stats = Streamer.GetStats();
+    EXPECT_EQ(Stats.NumResidentTiles, FirstMipInTail);
+    EXPECT_EQ(Stats.NumBoundTiles, Uint64{FirstMipInTail});
+    EXPECT_EQ(Stats.NumFreePages, 16u - FirstMipInTail);
+    EXPECT_EQ(Stats.NumBindBatches, Uint64{2});
+
+    // No new requests - no bind operations
+    Streamer.Update(pContext, pBindingCtx);
+    EXPECT_EQ(Streamer.GetStats().NumBindBatches, Uint64{2});
+
+    pContext->WaitForIdle();
+}
+
+TEST(SparseTextureStreamerTest, Eviction)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    IDeviceContext* pBindingCtx = FindSparseBindingContext();
+    if (pBindingCtx == nullptr)
+        GTEST_SKIP() << "Sparse 2D textures are not supported by this device";
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TestTileLoader        Loader;
+    SparseTextureStreamer Streamer{pDevice, GetTestCreateInfo(Loader, 1)};
+
+    const Uint32 FirstMipInTail = Streamer.GetFirstMipInTail();
+    if (FirstMipInTail == 0 || Streamer.GetNumTilesX(FirstMipInTail - 1) < 2)
+        GTEST_SKIP() << "The coarsest mip level outside of the mip tail has less than two tiles";
+
+    const Uint32 Mip     = FirstMipInTail - 1;
+    const Uint32 Region1 = 1u << Mip;
+
+    Streamer.Update(pContext, pBindingCtx);
+
+    RequestMip(Streamer, 0, 0, Mip);
+    Streamer.Update(pContext, pBindingCtx);
+    EXPECT_TRUE(Streamer.IsTileResident({0, 0, Mip}));
+    EXPECT_EQ(Streamer.GetResidentMip(0, 0), Mip);
+
+    // The pool is full: the least recently used tile is evicted, but its page
+    // is not reused until the GPU has finished the frames that may sample it.
+    RequestMip(Streamer, Region1, 0, Mip);
+    Streamer.Update(pContext, pBindingCtx);
+    EXPECT_FALSE(Streamer.IsTileResident({0, 0, Mip}));
+    EXPECT_FALSE(Streamer.IsTileResident({1, 0, Mip}));
+    EXPECT_EQ(Streamer.GetResidentMip(0, 0), FirstMipInTail);
+
+    SparseTextureStreamerStats Stats = Streamer.GetStats();
+    EXPECT_EQ(Stats.NumPendingUnbinds, 1u);
+    EXPECT_EQ(Stats.NumFreePages, 0u);
+    EXPECT_EQ(Stats.NumBindBatches, Uint64{2});
+
+    pContext->WaitForIdle();
+
+    // The evicted tile is unbound and the new tile is bound by the same batch
+    RequestMip(Streamer, Region1, 0, Mip);
+    Streamer.Update(pContext, pBindingCtx);
+    EXPECT_TRUE(Streamer.IsTileResident({1, 0, Mip}));
+    EXPECT_EQ(Streamer.GetResidentMip(Region1, 0), Mip);
+
+    Stats = Streamer.GetStats();
+    EXPECT_EQ(Stats.NumPendingUnbinds, 0u);
+    EXPECT_EQ(Stats.NumUnboundTiles, Uint64{1});
+    EXPECT_EQ(Stats.NumBoundTiles, Uint64{2});
+    EXPECT_EQ(Stats.NumBindBatches, Uint64{3});
+
+    pContext->WaitForIdle();
+}
+
+} // namespace
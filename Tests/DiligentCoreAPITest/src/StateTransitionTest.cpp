@@ -134,4 +134,78 @@ TEST(ResourceStateTest, DiscardSubresource)
     pContext->Flush();
 }
 
+TEST(ResourceStateTest, SubresourceStateTracking)
+{
+    auto*       pEnv       = GPUTestingEnvironment::GetInstance();
+    auto*       pDevice    = pEnv->GetDevice();
+    auto*       pContext   = pEnv->GetDeviceContext();
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (DeviceInfo.Type != RENDER_DEVICE_TYPE_D3D12 && DeviceInfo.Type != RENDER_DEVICE_TYPE_VULKAN)
+        GTEST_SKIP() << "Subresource state tracking is only supported in D3D12 and Vulkan backends";
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "SubresourceStateTracking test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.ArraySize = 4;
+    TexDesc.MipLevels = 5;
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.MiscFlags = MISC_TEXTURE_FLAG_SUBRESOURCE_STATES;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    {
+        const StateTransitionDesc Barrier{pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+        pContext->TransitionResourceStates(1, &Barrier);
+    }
+    EXPECT_EQ(pTexture->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+
+    // Render into mip 2 of slices 1..2 while the rest of the texture stays in shader resource state
+    RefCntAutoPtr<ITextureView> pRTV;
+    {
+        TextureViewDesc ViewDesc{"Subresource RTV", TEXTURE_VIEW_RENDER_TARGET, RESOURCE_DIM_TEX_2D_ARRAY};
+        ViewDesc.FirstArraySlice = 1;
+        ViewDesc.NumArraySlices  = 2;
+        ViewDesc.MostDetailedMip = 2;
+        pTexture->CreateView(ViewDesc, &pRTV);
+        ASSERT_NE(pRTV, nullptr);
+    }
+
+    ITextureView* ppRTVs[] = {pRTV};
+    pContext->SetRenderTargets(1, ppRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const float ClearColor[] = {0.4f, 0.1f, 0.2f, 1.f};
+    pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    EXPECT_EQ(pTexture->GetState(), RESOURCE_STATE_UNKNOWN);
+    for (Uint32 Slice = 0; Slice < TexDesc.ArraySize; ++Slice)
+    {
+        for (Uint32 Mip = 0; Mip < TexDesc.MipLevels; ++Mip)
+        {
+            const auto ExpectedState = (Mip == 2 && Slice >= 1 && Slice <= 2) ?
+                RESOURCE_STATE_RENDER_TARGET :
+                RESOURCE_STATE_SHADER_RESOURCE;
+            EXPECT_EQ(pTexture->GetSubresourceState(Mip, Slice), ExpectedState) << "Mip " << Mip << ", slice " << Slice;
+        }
+    }
+
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    // Transitioning the whole texture must use the actual state of every subresource
+    {
+        const StateTransitionDesc Barrier{pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+        pContext->TransitionResourceStates(1, &Barrier);
+    }
+    EXPECT_EQ(pTexture->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+    EXPECT_EQ(pTexture->GetSubresourceState(2, 1), RESOURCE_STATE_SHADER_RESOURCE);
+
+    pContext->Flush();
+}
+
 } // namespace
@@ -101,4 +101,85 @@ TEST(StreamingBufferTest, MapUnmap)
     StreamBuff.Reset();
 }
 
+TEST(StreamingBufferTest, Pages)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr Uint32 PageSize = 1024;
+
+    Uint32 NumCallbacks = 0;
+
+    StreamingBufferCreateInfo CI;
+    CI.pDevice = pDevice;
+
+    CI.BuffDesc.Name           = "Test paged streaming buffer";
+    CI.BuffDesc.BindFlags      = BIND_VERTEX_BUFFER;
+    CI.BuffDesc.Usage          = USAGE_DYNAMIC;
+    CI.BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    CI.BuffDesc.Size           = PageSize;
+    CI.UsePages                = true;
+    CI.MaxIdlePages            = 2;
+    CI.OnBufferResizeCallback  = [&NumCallbacks](IBuffer*) { ++NumCallbacks; };
+
+    StreamingBuffer StreamBuff{CI};
+    ASSERT_TRUE(StreamBuff.GetBuffer() != nullptr);
+    EXPECT_EQ(NumCallbacks, 1u);
+
+    auto Map = [&](Uint32 Size) {
+        auto Offset = StreamBuff.Map(pContext, pDevice, Size);
+        EXPECT_NE(StreamBuff.GetMappedCPUAddress(), nullptr);
+        StreamBuff.Unmap();
+        return Offset;
+    };
+
+    IBuffer* pFirstPage = StreamBuff.GetBuffer();
+    EXPECT_EQ(Map(256), Uint32{0});
+    EXPECT_EQ(Map(512), Uint32{256});
+    EXPECT_EQ(StreamBuff.GetBuffer(), pFirstPage);
+
+    // The data does not fit into the first page: the buffer switches to a new page
+    EXPECT_EQ(Map(512), Uint32{0});
+    EXPECT_NE(StreamBuff.GetBuffer(), pFirstPage);
+    EXPECT_EQ(StreamBuff.GetBuffer()->GetDesc().Size, Uint64{PageSize});
+    EXPECT_EQ(NumCallbacks, 2u);
+
+    // Allocations larger than the page get a dedicated page
+    EXPECT_EQ(Map(PageSize * 2), Uint32{0});
+    EXPECT_EQ(StreamBuff.GetBuffer()->GetDesc().Size, Uint64{PageSize * 2});
+    EXPECT_EQ(NumCallbacks, 3u);
+
+    StreamingBufferStats Stats = StreamBuff.GetStats();
+    EXPECT_EQ(Stats.CurrentSize, Uint64{256 + 512 + 512 + PageSize * 2});
+    EXPECT_EQ(Stats.PeakSize, Stats.CurrentSize);
+    EXPECT_EQ(Stats.NumActivePages, 3u);
+    EXPECT_EQ(Stats.NumPages, 3u);
+
+    StreamBuff.Flush();
+    Stats = StreamBuff.GetStats();
+    EXPECT_EQ(Stats.CurrentSize, Uint64{0});
+    EXPECT_EQ(Stats.PeakSize, Uint64{256 + 512 + 512 + PageSize * 2});
+    EXPECT_EQ(Stats.NumActivePages, 1u);
+    EXPECT_EQ(Stats.PeakActivePages, 3u);
+
+    // Pages released by the GPU are reused
+    pContext->WaitForIdle();
+    EXPECT_EQ(Map(PageSize * 2), Uint32{0});
+    EXPECT_EQ(Map(64), Uint32{0});
+    EXPECT_EQ(StreamBuff.GetBuffer()->GetDesc().Size, Uint64{PageSize});
+    EXPECT_EQ(StreamBuff.GetStats().NumIdlePages, 1u);
+
+    // The dedicated page is released once the GPU is done with it
+    StreamBuff.Flush();
+    pContext->WaitForIdle();
+    EXPECT_EQ(Map(PageSize), Uint32{0});
+    EXPECT_EQ(Map(64), Uint32{0});
+    EXPECT_EQ(StreamBuff.GetStats().NumPages, 2u);
+
+    StreamBuff.Reset();
+}
+
 } // namespace
@@ -0,0 +1,186 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TLASInstanceManager.hpp"
+#include "BLASBatchBuilder.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(TLASInstanceManagerTest, AddUpdateRemove)
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    if (!pEnv->SupportsRayTracing())
+    {
+        GTEST_SKIP() << "Ray tracing is not supported by this device";
+    }
+
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    // clang-format off
+    const float3 Vertices[] =
+    {
+        float3{0.25f, 0.25f, 0.0f},
+        float3{0.75f, 0.25f, 0.0f},
+        float3{0.50f, 0.75f, 0.0f}
+    };
+    // clang-format on
+
+    RefCntAutoPtr<IBuffer> pVertexBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "TLAS instance manager test vertices";
+        BuffDesc.BindFlags = BIND_RAY_TRACING;
+        BuffDesc.Size      = sizeof(Vertices);
+
+        BufferData InitData{Vertices, sizeof(Vertices)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pVertexBuffer);
+        ASSERT_NE(pVertexBuffer, nullptr);
+    }
+
+    RefCntAutoPtr<IBottomLevelAS> pBLAS;
+    {
+        BLASTriangleDesc TriangleDesc;
+        TriangleDesc.GeometryName         = "Triangle";
+        TriangleDesc.MaxVertexCount       = _countof(Vertices);
+        TriangleDesc.VertexValueType      = VT_FLOAT32;
+        TriangleDesc.VertexComponentCount = 3;
+        TriangleDesc.MaxPrimitiveCount    = 1;
+
+        BottomLevelASDesc ASDesc;
+        ASDesc.Name          = "TLAS instance manager test BLAS";
+        ASDesc.pTriangles    = &TriangleDesc;
+        ASDesc.TriangleCount = 1;
+        pDevice->CreateBLAS(ASDesc, &pBLAS);
+        ASSERT_NE(pBLAS, nullptr);
+
+        BLASBuildTriangleData TriangleData;
+        TriangleData.GeometryName         = TriangleDesc.GeometryName;
+        TriangleData.pVertexBuffer        = pVertexBuffer;
+        TriangleData.VertexStride         = sizeof(Vertices[0]);
+        TriangleData.VertexCount          = _countof(Vertices);
+        TriangleData.VertexValueType      = VT_FLOAT32;
+        TriangleData.VertexComponentCount = 3;
+        TriangleData.PrimitiveCount       = 1;
+
+        BuildBLASAttribs Attribs;
+        Attribs.pBLAS                  = pBLAS;
+        Attribs.BLASTransitionMode     = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        Attribs.GeometryTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        Attribs.pTriangleData          = &TriangleData;
+        Attribs.TriangleDataCount      = 1;
+
+        BLASBatchBuilder Builder{pDevice, BLASBatchBuilderCreateInfo{}};
+        Builder.Build(pContext, &Attribs, 1);
+    }
+
+    TLASInstanceManagerCreateInfo ManagerCI;
+    ManagerCI.Name             = "TLAS instance manager test";
+    ManagerCI.InitialCapacity  = 8;
+    ManagerCI.RebuildThreshold = 1.5f;
+
+    TLASInstanceManager Manager{pDevice, ManagerCI};
+    EXPECT_EQ(Manager.Build(pContext), TLASInstanceManager::BUILD_TYPE_NONE);
+
+    std::vector<TLASInstanceManager::InstanceHandle> Handles;
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        TLASBuildInstanceData Inst;
+        Inst.InstanceName = i == 0 ? "First instance" : nullptr;
+        Inst.pBLAS        = pBLAS;
+        Inst.CustomId     = i;
+        Inst.Transform.SetTranslation(static_cast<float>(i), 0, 0);
+        Handles.push_back(Manager.AddInstance(Inst));
+    }
+    EXPECT_STREQ(Manager.GetInstanceName(Handles[0]), "First instance");
+    EXPECT_EQ(Manager.GetInstanceCount(), 16u);
+
+    // The TLAS is recreated with a larger capacity
+    EXPECT_EQ(Manager.Build(pContext), TLASInstanceManager::BUILD_TYPE_REBUILD);
+    ITopLevelAS* pTLAS = Manager.GetTLAS();
+    ASSERT_NE(pTLAS, nullptr);
+    EXPECT_GE(pTLAS->GetDesc().MaxInstanceCount, 16u);
+    EXPECT_EQ(pTLAS->GetBuildInfo().InstanceCount, 16u);
+    EXPECT_EQ(Manager.Build(pContext), TLASInstanceManager::BUILD_TYPE_NONE);
+
+    // Move a few instances
+    for (Uint32 i = 0; i < 4; ++i)
+        Manager.SetTransform(Handles[i], InstanceMatrix{}.SetTranslation(0, static_cast<float>(i), 0));
+    EXPECT_EQ(Manager.GetNumDirtyInstances(), 4u);
+    EXPECT_EQ(Manager.Build(pContext), TLASInstanceManager::BUILD_TYPE_UPDATE);
+    EXPECT_EQ(Manager.GetNumDirtyInstances(), 0u);
+    EXPECT_EQ(Manager.GetTLAS(), pTLAS);
+
+    // Moving all instances exceeds the rebuild threshold: 4 + 16 + 16 > 1.5 * 16
+    for (Uint32 Frame = 0; Frame < 2; ++Frame)
+    {
+        for (TLASInstanceManager::InstanceHandle Handle : Handles)
+        {
+            InstanceMatrix Transform = Manager.GetInstance(Handle).Transform;
+            Transform.data[2][3] += 1;
+            Manager.SetTransform(Handle, Transform);
+        }
+        EXPECT_EQ(Manager.Build(pContext), Frame == 0 ? TLASInstanceManager::BUILD_TYPE_UPDATE : TLASInstanceManager::BUILD_TYPE_REBUILD);
+    }
+
+    // Removing an instance requires a rebuild
+    Manager.RemoveInstance(Handles[3]);
+    Handles.erase(Handles.begin() + 3);
+    EXPECT_EQ(Manager.GetInstanceCount(), 15u);
+    EXPECT_EQ(Manager.Build(pContext), TLASInstanceManager::BUILD_TYPE_REBUILD);
+    EXPECT_EQ(pTLAS->GetBuildInfo().InstanceCount, 15u);
+
+    for (TLASInstanceManager::InstanceHandle Handle : Handles)
+    {
+        const TLASInstanceDesc Desc = pTLAS->GetInstanceDesc(Manager.GetInstanceName(Handle));
+        EXPECT_LT(Desc.InstanceIndex, 15u);
+        EXPECT_EQ(Desc.pBLAS, pBLAS);
+    }
+
+    // Change the instance data
+    {
+        TLASBuildInstanceData Inst = Manager.GetInstance(Handles[5]);
+        Inst.Mask                  = 0x0F;
+        Manager.SetInstance(Handles[5], Inst);
+        EXPECT_EQ(Manager.GetInstance(Handles[5]).Mask, 0x0F);
+        EXPECT_EQ(Manager.Build(pContext), TLASInstanceManager::BUILD_TYPE_UPDATE);
+    }
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
@@ -879,4 +879,59 @@ INSTANTIATE_TEST_SUITE_P(TextureCreation,
                          } //
 );
 
+
+TEST(TextureCreationTest, ViewDeduplication)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "View deduplication test";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Width     = 64;
+    TexDesc.Height    = 64;
+    TexDesc.ArraySize = 4;
+    TexDesc.MipLevels = 4;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    TextureViewDesc ViewDesc;
+    ViewDesc.ViewType        = TEXTURE_VIEW_SHADER_RESOURCE;
+    ViewDesc.TextureDim      = RESOURCE_DIM_TEX_2D_ARRAY;
+    ViewDesc.MostDetailedMip = 1;
+    ViewDesc.NumMipLevels    = 2;
+    ViewDesc.FirstArraySlice = 1;
+    ViewDesc.NumArraySlices  = 2;
+
+    RefCntAutoPtr<ITextureView> pView1, pView2, pView3;
+    ViewDesc.Name = "View 1";
+    pTexture->CreateView(ViewDesc, &pView1);
+    ViewDesc.Name = "View 2";
+    pTexture->CreateView(ViewDesc, &pView2);
+    ASSERT_NE(pView1, nullptr);
+    ASSERT_NE(pView2, nullptr);
+    EXPECT_EQ(pView1, pView2);
+    EXPECT_EQ(pView1->GetDesc(), ViewDesc);
+
+    ViewDesc.Name           = "View 3";
+    ViewDesc.NumArraySlices = 3;
+    pTexture->CreateView(ViewDesc, &pView3);
+    ASSERT_NE(pView3, nullptr);
+    EXPECT_NE(pView1, pView3);
+
+    // Once all references are released, the view must be recreated
+    pView1.Release();
+    pView2.Release();
+    ViewDesc.NumArraySlices = 2;
+    pTexture->CreateView(ViewDesc, &pView1);
+    ASSERT_NE(pView1, nullptr);
+    EXPECT_EQ(pView1->GetDesc(), ViewDesc);
+}
+
 } // namespace
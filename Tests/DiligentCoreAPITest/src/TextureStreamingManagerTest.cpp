@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+
+#include "TextureStreamingManager.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 TexSize     = 256;
+constexpr Uint32 MaxTailSize = 32;
+constexpr Uint32 TailMip     = 3;
+
+Uint64 GetMipSize(Uint32 Mip)
+{
+    const Uint64 Size = std::max(TexSize >> Mip, 1u);
+    return Size * Size * 4;
+}
+
+// Total size of the mip levels starting from the given one
+Uint64 GetAllocSize(Uint32 Mip)
+{
+    Uint64 Size = 0;
+    for (; (TexSize >> Mip) > 0; ++Mip)
+        Size += GetMipSize(Mip);
+    return Size;
+}
+
+Uint32 GetMipColor(Uint32 Mip)
+{
+    return 0xFF000000u | (Mip * 0x102030u);
+}
+
+bool LoadTestMip(Uint32 Mip, const MappedTextureSubresource& Data)
+{
+    const Uint32 Size  = std::max(TexSize >> Mip, 1u);
+    const Uint32 Color = GetMipColor(Mip);
+    for (Uint32 y = 0; y < Size; ++y)
+    {
+        Uint32* pRow = reinterpret_cast<Uint32*>(static_cast<Uint8*>(Data.pData) + Data.Stride * y);
+        for (Uint32 x = 0; x < Size; ++x)
+            pRow[x] = Color;
+    }
+    return true;
+}
+
+StreamedTextureDesc GetTestTextureDesc(const char* Name)
+{
+    StreamedTextureDesc Desc;
+    Desc.Name      = Name;
+    Desc.Width     = TexSize;
+    Desc.Height    = TexSize;
+    Desc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    Desc.MipLoader = LoadTestMip;
+    return Desc;
+}
+
+TEST(TextureStreamingManagerTest, Residency)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TextureStreamingManagerCreateInfo CI;
+    CI.UploadBudget = GetMipSize(1);
+    CI.MemoryBudget = GetAllocSize(0);
+    CI.MaxTailSize  = MaxTailSize;
+
+    TextureStreamingManager StreamingMgr{pDevice, CI};
+
+    const auto Id = StreamingMgr.RegisterTexture(GetTestTextureDesc("Texture streaming manager test"));
+    ASSERT_NE(Id, TextureStreamingManager::InvalidTextureId);
+    EXPECT_EQ(StreamingMgr.GetTailMip(Id), TailMip);
+    EXPECT_EQ(StreamingMgr.GetView(Id), nullptr);
+
+    // The first update loads the mip tail
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id), TailMip);
+    EXPECT_EQ(StreamingMgr.GetAllocatedMip(Id), TailMip);
+    ASSERT_NE(StreamingMgr.GetView(Id), nullptr);
+    EXPECT_EQ(StreamingMgr.GetView(Id)->GetDesc().MostDetailedMip, 0u);
+    EXPECT_EQ(StreamingMgr.GetStats().AllocatedMemory, GetAllocSize(TailMip));
+
+    // Mip 1 does not fit into the upload budget together with mip 2
+    StreamingMgr.RequestMip(Id, 0, 1.f);
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetAllocatedMip(Id), 0u);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id), 2u);
+    ASSERT_NE(StreamingMgr.GetView(Id), nullptr);
+    EXPECT_EQ(StreamingMgr.GetView(Id)->GetDesc().MostDetailedMip, 2u);
+    EXPECT_EQ(StreamingMgr.GetView(Id)->GetTexture(), StreamingMgr.GetTexture(Id));
+    EXPECT_EQ(StreamingMgr.GetStats().FrameUploadedBytes, GetMipSize(2));
+
+    StreamingMgr.RequestMip(Id, 0, 1.f);
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id), 1u);
+
+    // At least one mip level is loaded per update, even if it exceeds the budget
+    StreamingMgr.RequestMip(Id, 0, 1.f);
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id), 0u);
+    EXPECT_EQ(StreamingMgr.GetView(Id)->GetDesc().MostDetailedMip, 0u);
+
+    TextureStreamingStats Stats = StreamingMgr.GetStats();
+    EXPECT_EQ(Stats.NumPendingRequests, 0u);
+    EXPECT_EQ(Stats.AllocatedMemory, GetAllocSize(0));
+    EXPECT_EQ(Stats.NumReallocations, Uint64{1});
+    EXPECT_EQ(Stats.NumLoadedMips, Uint64{9});
+
+    // The mip tail must have been copied to the reallocated texture
+    RefCntAutoPtr<ITexture> pStagingTex;
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name           = "Texture streaming manager test staging texture";
+        TexDesc.Type           = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width          = TexSize >> TailMip;
+        TexDesc.Height         = TexSize >> TailMip;
+        TexDesc.Format         = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Usage          = USAGE_STAGING;
+        TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        pDevice->CreateTexture(TexDesc, nullptr, &pStagingTex);
+        ASSERT_NE(pStagingTex, nullptr);
+    }
+
+    CopyTextureAttribs CopyAttribs;
+    CopyAttribs.pSrcTexture              = StreamingMgr.GetTexture(Id);
+    CopyAttribs.SrcMipLevel              = TailMip;
+    CopyAttribs.pDstTexture              = pStagingTex;
+    CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContext->CopyTexture(CopyAttribs);
+    pContext->WaitForIdle();
+
+    MappedTextureSubresource MappedData;
+    pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+    ASSERT_NE(MappedData.pData, nullptr);
+    Uint32 NumInvalidTexels = 0;
+    for (Uint32 y = 0; y < (TexSize >> TailMip); ++y)
+    {
+        const Uint32* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(MappedData.pData) + MappedData.Stride * y);
+        for (Uint32 x = 0; x < (TexSize >> TailMip); ++x)
+            NumInvalidTexels += pRow[x] != GetMipColor(TailMip) ? 1 : 0;
+    }
+    pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+    EXPECT_EQ(NumInvalidTexels, 0u);
+
+    StreamingMgr.UnregisterTexture(Id);
+    EXPECT_EQ(StreamingMgr.GetStats().AllocatedMemory, Uint64{0});
+}
+
+TEST(TextureStreamingManagerTest, Eviction)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    // One texture with all mip levels and another one without mip 0
+    TextureStreamingManagerCreateInfo CI;
+    CI.UploadBudget = GetAllocSize(0) * 2;
+    CI.MemoryBudget = GetAllocSize(0) + GetAllocSize(1);
+    CI.MaxTailSize  = MaxTailSize;
+
+    TextureStreamingManager StreamingMgr{pDevice, CI};
+
+    const auto Id0 = StreamingMgr.RegisterTexture(GetTestTextureDesc("Texture streaming manager test 0"));
+    const auto Id1 = StreamingMgr.RegisterTexture(GetTestTextureDesc("Texture streaming manager test 1"));
+    ASSERT_NE(Id0, TextureStreamingManager::InvalidTextureId);
+    ASSERT_NE(Id1, TextureStreamingManager::InvalidTextureId);
+    StreamingMgr.Update(pContext);
+
+    // Requests are processed in priority order
+    StreamingMgr.RequestMip(Id0, 0, 1.f);
+    StreamingMgr.RequestMip(Id1, 0, 2.f);
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id1), 0u);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id0), 1u);
+    EXPECT_EQ(StreamingMgr.GetStats().NumPendingRequests, 1u);
+    EXPECT_LE(StreamingMgr.GetStats().AllocatedMemory, CI.MemoryBudget);
+
+    // The texture with lower priority is evicted
+    StreamingMgr.RequestMip(Id0, 0, 3.f);
+    StreamingMgr.RequestMip(Id1, 0, 2.f);
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id0), 0u);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id1), 1u);
+    EXPECT_EQ(StreamingMgr.GetStats().NumEvictedMips, Uint64{1});
+
+    // Mip levels that are not requested are evicted even for a request with lower priority,
+    // but only as many as needed
+    StreamingMgr.RequestMip(Id0, 2, 3.f);
+    StreamingMgr.RequestMip(Id1, 0, 1.f);
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id0), 1u);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id1), 0u);
+    EXPECT_EQ(StreamingMgr.GetStats().NumEvictedMips, Uint64{2});
+    EXPECT_LE(StreamingMgr.GetStats().AllocatedMemory, CI.MemoryBudget);
+}
+
+TEST(TextureStreamingManagerTest, LoadFailure)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TextureStreamingManagerCreateInfo CI;
+    CI.MemoryBudget = GetAllocSize(0);
+    CI.MaxTailSize  = MaxTailSize;
+
+    TextureStreamingManager StreamingMgr{pDevice, CI};
+
+    StreamedTextureDesc Desc = GetTestTextureDesc("Texture streaming manager load failure test");
+    Desc.MipLoader           = [](Uint32 Mip, const MappedTextureSubresource& Data) {
+        return Mip != 1 && LoadTestMip(Mip, Data);
+    };
+    const auto Id = StreamingMgr.RegisterTexture(Desc);
+    ASSERT_NE(Id, TextureStreamingManager::InvalidTextureId);
+
+    StreamingMgr.RequestMip(Id, 0, 1.f);
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id), 2u);
+    EXPECT_EQ(StreamingMgr.GetStats().NumFailedMips, Uint64{1});
+
+    // The failed mip level is not requested again
+    StreamingMgr.RequestMip(Id, 0, 1.f);
+    StreamingMgr.Update(pContext);
+    EXPECT_EQ(StreamingMgr.GetResidentMip(Id), 2u);
+    EXPECT_EQ(StreamingMgr.GetStats().NumFailedMips, Uint64{1});
+    EXPECT_EQ(StreamingMgr.GetStats().NumPendingRequests, 0u);
+}
+
+} // namespace
@@ -26,12 +26,15 @@
  */
 
 #include "TextureUploader.hpp"
+#include "AsyncFileReader.hpp"
 #include "GPUTestingEnvironment.hpp"
 
 #include "gtest/gtest.h"
 
 #include <atomic>
+#include <cstdio>
 #include <thread>
+#include <vector>
 
 using namespace Diligent;
 using namespace Diligent::Testing;
@@ -89,7 +92,7 @@ Uint32 WriteOrVerifyRGBAData(MappedTextureSubresource& MappedData,
     return NumInvalidPixels;
 }
 
-void TextureUploaderTest(bool IsRenderThread)
+void TextureUploaderTest(bool IsRenderThread, bool PremapRecycledBuffers = false)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
     auto* pDevice  = pEnv->GetDevice();
@@ -102,7 +105,9 @@ void TextureUploaderTest(bool IsRenderThread)
 
     GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
 
-    TextureUploaderDesc             UploaderDesc;
+    TextureUploaderDesc UploaderDesc;
+    UploaderDesc.PremapRecycledBuffers = PremapRecycledBuffers;
+
     RefCntAutoPtr<ITextureUploader> pTexUploader;
     CreateTextureUploader(pDevice, UploaderDesc, &pTexUploader);
     ASSERT_TRUE(pTexUploader);
@@ -137,8 +142,10 @@ void TextureUploaderTest(bool IsRenderThread)
     UploadBuffDesc.MipLevels = 2;
     UploadBuffDesc.ArraySize = 4;
 
+    constexpr Uint32 NumIterations = 3;
+
     Uint32 cnt = 0;
-    for (Uint32 i = 0; i < 3; ++i)
+    for (Uint32 i = 0; i < NumIterations; ++i)
     {
         auto ref_cnt = cnt;
 
@@ -208,6 +215,19 @@ void TextureUploaderTest(bool IsRenderThread)
             }
         }
     }
+
+    Uint64 UploadBufferSize = 0;
+    for (Uint32 mip = 0; mip < UploadBuffDesc.MipLevels; ++mip)
+        UploadBufferSize += Uint64{UploadBuffDesc.Width >> mip} * Uint64{UploadBuffDesc.Height >> mip} * 4 * UploadBuffDesc.ArraySize;
+
+    const TextureUploaderStats Stats = pTexUploader->GetStats();
+    EXPECT_EQ(Stats.NumPendingOperations, 0u);
+    EXPECT_EQ(Stats.TotalBytesUploaded, UploadBufferSize * NumIterations);
+    EXPECT_GE(Stats.NumStagingBuffers, 1u);
+    EXPECT_LE(Stats.NumStagingBuffers, NumIterations);
+    EXPECT_LE(Stats.NumFreeStagingBuffers, Stats.NumStagingBuffers);
+    EXPECT_EQ(Stats.StagingMemorySize, UploadBufferSize * Stats.NumStagingBuffers);
+    EXPECT_GT(Stats.BytesPerSecond, 0.f);
 }
 
 TEST(TextureUploaderTest, RenderThread)
@@ -220,4 +240,137 @@ TEST(TextureUploaderTest, WorkerThread)
     TextureUploaderTest(false);
 }
 
+TEST(TextureUploaderTest, WorkerThread_PremapRecycledBuffers)
+{
+    TextureUploaderTest(false, /*PremapRecycledBuffers = */ true);
+}
+
+TEST(TextureUploaderTest, ReadFromFile)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (pDevice->GetDeviceInfo().IsMetalDevice())
+    {
+        GTEST_SKIP() << "Texture uploader is not currently implemented in Metal";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<ITextureUploader> pTexUploader;
+    CreateTextureUploader(pDevice, TextureUploaderDesc{}, &pTexUploader);
+    ASSERT_TRUE(pTexUploader);
+
+    UploadBufferDesc UploadBuffDesc;
+    UploadBuffDesc.Width     = 120;
+    UploadBuffDesc.Height    = 64;
+    UploadBuffDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    UploadBuffDesc.MipLevels = 2;
+    UploadBuffDesc.ArraySize = 2;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Texture uploader read from file dst texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Width     = UploadBuffDesc.Width;
+    TexDesc.Height    = UploadBuffDesc.Height;
+    TexDesc.MipLevels = UploadBuffDesc.MipLevels;
+    TexDesc.ArraySize = UploadBuffDesc.ArraySize;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Format    = UploadBuffDesc.Format;
+    RefCntAutoPtr<ITexture> pDstTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pDstTexture);
+    ASSERT_TRUE(pDstTexture);
+
+    TexDesc.Name           = "Texture uploader read from file staging texture";
+    TexDesc.Usage          = USAGE_STAGING;
+    TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    TexDesc.BindFlags      = BIND_NONE;
+    RefCntAutoPtr<ITexture> pStagingTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pStagingTexture);
+    ASSERT_TRUE(pStagingTexture);
+
+    // Write the subresources to the file. Even slices are tightly packed, while odd slices
+    // use padded rows to test the row-by-row path.
+    std::vector<UploadBufferFileRegion> Regions;
+    std::vector<Uint8>                  FileData;
+
+    Uint32 cnt = 0;
+    for (Uint32 slice = 0; slice < UploadBuffDesc.ArraySize; ++slice)
+    {
+        for (Uint32 mip = 0; mip < UploadBuffDesc.MipLevels; ++mip)
+        {
+            const Uint32 Width  = UploadBuffDesc.Width >> mip;
+            const Uint32 Height = UploadBuffDesc.Height >> mip;
+
+            UploadBufferFileRegion Region;
+            Region.Mip    = mip;
+            Region.Slice  = slice;
+            Region.Offset = FileData.size();
+            Region.Stride = (slice & 0x01) ? Width * 4 + 20 : 0;
+            Regions.push_back(Region);
+
+            MappedTextureSubresource MappedData;
+            MappedData.Stride = Region.Stride != 0 ? Region.Stride : Width * 4;
+            FileData.resize(FileData.size() + MappedData.Stride * Height);
+            MappedData.pData = &FileData[static_cast<size_t>(Region.Offset)];
+            WriteOrVerifyRGBAData(MappedData, UploadBuffDesc, mip, slice, cnt, false);
+        }
+    }
+
+    const char* FilePath = "TextureUploaderReadFromFile.bin";
+    {
+        FILE* pFile = fopen(FilePath, "wb");
+        ASSERT_NE(pFile, nullptr);
+        EXPECT_EQ(fwrite(FileData.data(), 1, FileData.size(), pFile), FileData.size());
+        fclose(pFile);
+    }
+
+    {
+        AsyncFileReader Reader{FilePath};
+
+        RefCntAutoPtr<IUploadBuffer> pUploadBuffer;
+        pTexUploader->AllocateUploadBuffer(pContext, UploadBuffDesc, &pUploadBuffer);
+        ASSERT_TRUE(pUploadBuffer);
+
+        std::atomic<int> ReadResult{-1};
+        ReadUploadBufferFromFile(Reader, pUploadBuffer, Regions.data(), static_cast<Uint32>(Regions.size()),
+                                 [&](bool Success) {
+                                     ReadResult.store(Success ? 1 : 0);
+                                 });
+        Reader.WaitIdle();
+        EXPECT_EQ(ReadResult.load(), 1);
+
+        pTexUploader->ScheduleGPUCopy(pContext, pDstTexture, 0, 0, pUploadBuffer);
+        pTexUploader->RecycleBuffer(pUploadBuffer);
+    }
+    std::remove(FilePath);
+
+    for (Uint32 slice = 0; slice < UploadBuffDesc.ArraySize; ++slice)
+    {
+        for (Uint32 mip = 0; mip < UploadBuffDesc.MipLevels; ++mip)
+        {
+            CopyTextureAttribs CopyAttribs{pDstTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+            CopyAttribs.SrcMipLevel = mip;
+            CopyAttribs.SrcSlice    = slice;
+            CopyAttribs.DstMipLevel = mip;
+            CopyAttribs.DstSlice    = slice;
+            pContext->CopyTexture(CopyAttribs);
+        }
+    }
+    pContext->WaitForIdle();
+
+    cnt = 0;
+    for (Uint32 slice = 0; slice < UploadBuffDesc.ArraySize; ++slice)
+    {
+        for (Uint32 mip = 0; mip < UploadBuffDesc.MipLevels; ++mip)
+        {
+            MappedTextureSubresource MappedData;
+            pContext->MapTextureSubresource(pStagingTexture, mip, slice, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+            WriteOrVerifyRGBAData(MappedData, UploadBuffDesc, mip, slice, cnt, true);
+            pContext->UnmapTextureSubresource(pStagingTexture, mip, slice);
+        }
+    }
+}
+
 } // namespace
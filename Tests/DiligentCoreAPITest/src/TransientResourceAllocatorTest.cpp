@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TransientResourceAllocator.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(TransientResourceAllocatorTest, ShareMemory)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    TransientResourceAllocatorCreateInfo CI;
+    CI.Name = "Transient resource allocator test";
+    TransientResourceAllocator Allocator{pDevice, CI};
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Transient texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 512;
+    TexDesc.Height    = 512;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+
+    // A(0-1), B(1-2), C(2-3): A and C do not overlap
+    const Uint32 A = Allocator.AddTexture(TexDesc, 0, 1);
+    const Uint32 B = Allocator.AddTexture(TexDesc, 1, 2);
+    const Uint32 C = Allocator.AddTexture(TexDesc, 2, 3);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Transient buffer";
+    BuffDesc.Size      = 256 << 10;
+    BuffDesc.Usage     = USAGE_DEFAULT;
+    BuffDesc.BindFlags = BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode      = BUFFER_MODE_RAW;
+
+    const Uint32 D = Allocator.AddBuffer(BuffDesc, 0, 0);
+    const Uint32 E = Allocator.AddBuffer(BuffDesc, 1, 1);
+
+    ASSERT_TRUE(Allocator.Allocate(pContext));
+
+    for (Uint32 i : {A, B, C})
+        EXPECT_NE(Allocator.GetTexture(i), nullptr);
+    for (Uint32 i : {D, E})
+        EXPECT_NE(Allocator.GetBuffer(i), nullptr);
+
+    EXPECT_NE(Allocator.GetTexture(A), Allocator.GetTexture(B));
+
+    const auto& Stats = Allocator.GetStatistics();
+    EXPECT_EQ(Stats.NumResources, 5u);
+    if (Stats.NumAliasedResources == 5)
+    {
+        // A and C share memory
+        EXPECT_LT(Stats.MemorySize, Stats.AliasedResourcesSize);
+
+        std::vector<StateTransitionDesc> Barriers;
+        Allocator.GetAliasingBarriers(2, Barriers);
+        ASSERT_EQ(Barriers.size(), size_t{1});
+        EXPECT_EQ(Barriers[0].pResourceBefore, Allocator.GetTexture(A));
+        EXPECT_EQ(Barriers[0].pResource, Allocator.GetTexture(C));
+    }
+    else if (Stats.NumAliasedResources == 0)
+    {
+        // A and C reuse the same object, as well as D and E
+        EXPECT_EQ(Stats.NumPooledObjects, 3u);
+        EXPECT_EQ(Allocator.GetTexture(A), Allocator.GetTexture(C));
+        EXPECT_EQ(Allocator.GetBuffer(D), Allocator.GetBuffer(E));
+    }
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+
+    Allocator.Reset();
+}
+
+} // namespace
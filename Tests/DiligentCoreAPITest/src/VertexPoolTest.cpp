@@ -29,6 +29,7 @@
 #include <vector>
 #include <algorithm>
 #include <thread>
+#include <cstring>
 
 #include "GPUTestingEnvironment.hpp"
 #include "FastRand.hpp"
@@ -183,4 +184,107 @@ TEST(VertexPoolTest, Allocate)
     }
 }
 
+TEST(VertexPoolTest, Defragment)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 NumAllocations = 16;
+    constexpr Uint32 AllocVertices  = 16;
+    constexpr Uint32 VertexSize     = 16;
+    constexpr Uint32 AllocSize      = AllocVertices * VertexSize;
+    constexpr Uint32 BufferSize     = NumAllocations * AllocSize;
+
+    constexpr VertexPoolElementDesc Elements[] =
+        {
+            VertexPoolElementDesc{VertexSize},
+        };
+    VertexPoolCreateInfo CI;
+    CI.Desc.Name        = "Test vertex pool";
+    CI.Desc.pElements   = Elements;
+    CI.Desc.NumElements = _countof(Elements);
+    CI.Desc.VertexCount = NumAllocations * AllocVertices;
+
+    RefCntAutoPtr<IVertexPool> pVtxPool;
+    CreateVertexPool(pDevice, CI, &pVtxPool);
+    ASSERT_NE(pVtxPool, nullptr);
+
+    auto* pBuffer = pVtxPool->Update(0, pDevice, pContext);
+    ASSERT_NE(pBuffer, nullptr);
+
+    std::vector<RefCntAutoPtr<IVertexPoolAllocation>> Allocs(NumAllocations);
+    std::vector<std::vector<Uint8>>                   AllocData(NumAllocations);
+    for (Uint32 i = 0; i < NumAllocations; ++i)
+    {
+        pVtxPool->Allocate(AllocVertices, &Allocs[i]);
+        ASSERT_TRUE(Allocs[i]);
+
+        AllocData[i].resize(AllocSize);
+        for (Uint32 j = 0; j < AllocSize; ++j)
+            AllocData[i][j] = static_cast<Uint8>(i * 7 + j);
+        pContext->UpdateBuffer(pBuffer, Allocs[i]->GetStartVertex() * VertexSize, AllocSize, AllocData[i].data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    // Release every other allocation to fragment the pool
+    for (Uint32 i = 0; i < NumAllocations; i += 2)
+        Allocs[i].Release();
+
+    auto GetUsedRangeEnd = [&]() {
+        Uint32 End = 0;
+        for (const auto& Alloc : Allocs)
+        {
+            if (Alloc)
+                End = std::max(End, Alloc->GetStartVertex() + Alloc->GetVertexCount());
+        }
+        return End;
+    };
+    const Uint32 UsedRangeEnd = GetUsedRangeEnd();
+
+    const Uint32 LayoutVersion = pVtxPool->GetLayoutVersion();
+
+    // The budget only allows moving two allocations
+    EXPECT_EQ(pVtxPool->Defragment(pDevice, pContext, AllocSize * 2), Uint64{AllocSize * 2});
+    EXPECT_EQ(pVtxPool->GetLayoutVersion(), LayoutVersion + 1);
+
+    for (Uint32 i = 0; i < NumAllocations && pVtxPool->Defragment(pDevice, pContext, BufferSize) != 0; ++i)
+    {
+    }
+    EXPECT_LT(GetUsedRangeEnd(), UsedRangeEnd);
+    EXPECT_EQ(pVtxPool->Defragment(pDevice, pContext, BufferSize), Uint64{0});
+
+    VertexPoolUsageStats Stats;
+    pVtxPool->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+    EXPECT_EQ(Stats.AllocatedVertexCount, Uint64{NumAllocations / 2 * AllocVertices});
+
+    EXPECT_EQ(pVtxPool->GetBuffer(0), pBuffer);
+
+    RefCntAutoPtr<IBuffer> pStagingBuff;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Staging buffer for vertex pool defragment test";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.BindFlags      = BIND_NONE;
+        BuffDesc.Size           = BufferSize;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuff);
+        ASSERT_NE(pStagingBuff, nullptr);
+    }
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingBuff, 0, BufferSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuff, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    for (Uint32 i = 1; i < NumAllocations; i += 2)
+    {
+        const auto* pAllocData = reinterpret_cast<const Uint8*>(pData) + Allocs[i]->GetStartVertex() * VertexSize;
+        EXPECT_EQ(memcmp(pAllocData, AllocData[i].data(), AllocSize), 0) << "Allocation " << i;
+    }
+    pContext->UnmapBuffer(pStagingBuff, MAP_READ);
+}
+
 } // namespace
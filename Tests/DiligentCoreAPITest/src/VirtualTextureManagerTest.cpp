@@ -0,0 +1,251 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "VirtualTextureManager.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr Uint32 TileSize = 16;
+
+Uint32 GetTileColor(const VirtualTextureTile& Tile)
+{
+    return VirtualTextureManager::EncodeFeedback(Tile) | 0xA0000000u;
+}
+
+bool LoadTestTile(const VirtualTextureTile& Tile, const MappedTextureSubresource& Data)
+{
+    const Uint32 Color = GetTileColor(Tile);
+    for (Uint32 y = 0; y < TileSize; ++y)
+    {
+        Uint32* pRow = reinterpret_cast<Uint32*>(static_cast<Uint8*>(Data.pData) + Data.Stride * y);
+        for (Uint32 x = 0; x < TileSize; ++x)
+            pRow[x] = Color;
+    }
+    return true;
+}
+
+VirtualTextureManagerCreateInfo GetTestCreateInfo()
+{
+    VirtualTextureManagerCreateInfo CI;
+    CI.Name             = "Virtual texture manager test";
+    CI.Width            = TileSize * 8;
+    CI.Height           = TileSize * 8;
+    CI.TileSize         = TileSize;
+    CI.Format           = TEX_FORMAT_RGBA8_UNORM;
+    CI.NumPhysicalPages = 6;
+    CI.MaxLoadsPerFrame = 8;
+    CI.TileLoader       = LoadTestTile;
+    return CI;
+}
+
+void RequestTile(VirtualTextureManager& VTMgr, const VirtualTextureTile& Tile)
+{
+    const Uint32 Feedback[] = {
+        VirtualTextureManager::EncodeFeedback(Tile),
+        VirtualTextureManager::InvalidFeedback,
+    };
+    VTMgr.AnalyzeFeedback(Feedback, _countof(Feedback));
+}
+
+Uint32 GetResidentPage(VirtualTextureManager& VTMgr, const VirtualTextureTile& Tile)
+{
+    const Uint32 Entry = VTMgr.GetPageTableEntry(Tile);
+    EXPECT_NE(Entry, VirtualTextureManager::InvalidPageTableEntry);
+    EXPECT_EQ(Entry >> 16u, Tile.MipLevel);
+    return Entry & 0xFFFFu;
+}
+
+TEST(VirtualTextureManagerTest, Residency)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    VirtualTextureManager VTMgr{pDevice, GetTestCreateInfo()};
+    ASSERT_EQ(VTMgr.GetNumMipLevels(), 4u);
+    ASSERT_NE(VTMgr.GetPhysicalCache(), nullptr);
+    ASSERT_NE(VTMgr.GetPageTable(), nullptr);
+    EXPECT_EQ(VTMgr.GetFeedbackBuffer(), nullptr);
+    EXPECT_EQ(VTMgr.GetPageTableEntry({5, 3, 0}), VirtualTextureManager::InvalidPageTableEntry);
+
+    // Requesting the finest tile loads all its ancestors
+    RequestTile(VTMgr, {1, 2, 0});
+    VTMgr.Update(pContext);
+    EXPECT_TRUE(VTMgr.IsTileResident({1, 2, 0}));
+    EXPECT_TRUE(VTMgr.IsTileResident({0, 1, 1}));
+    EXPECT_TRUE(VTMgr.IsTileResident({0, 0, 2}));
+    EXPECT_TRUE(VTMgr.IsTileResident({0, 0, 3}));
+
+    VirtualTextureStats Stats = VTMgr.GetStats();
+    EXPECT_EQ(Stats.NumResidentTiles, 4u);
+    EXPECT_EQ(Stats.NumLoadedTiles, Uint64{4});
+    EXPECT_EQ(Stats.NumPendingLoads, 0u);
+    EXPECT_EQ(Stats.NumEvictedTiles, Uint64{0});
+
+    const Uint32 Page = GetResidentPage(VTMgr, {1, 2, 0});
+    // Non-resident tiles fall back to the finest resident ancestor
+    EXPECT_EQ(VTMgr.GetPageTableEntry({0, 2, 0}), VTMgr.GetPageTableEntry({0, 1, 1}));
+    EXPECT_EQ(VTMgr.GetPageTableEntry({7, 7, 0}), VTMgr.GetPageTableEntry({0, 0, 3}));
+    EXPECT_EQ(VTMgr.GetPageTableEntry({3, 3, 1}), VTMgr.GetPageTableEntry({0, 0, 3}));
+
+    // Read back the physical page of the tile
+    RefCntAutoPtr<ITexture> pStagingTex;
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name           = "Virtual texture manager test staging texture";
+        TexDesc.Type           = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width          = TileSize;
+        TexDesc.Height         = TileSize;
+        TexDesc.Format         = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Usage          = USAGE_STAGING;
+        TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        pDevice->CreateTexture(TexDesc, nullptr, &pStagingTex);
+        ASSERT_NE(pStagingTex, nullptr);
+    }
+
+    CopyTextureAttribs CopyAttribs;
+    CopyAttribs.pSrcTexture              = VTMgr.GetPhysicalCache();
+    CopyAttribs.SrcSlice                 = Page;
+    CopyAttribs.pDstTexture              = pStagingTex;
+    CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContext->CopyTexture(CopyAttribs);
+    pContext->WaitForIdle();
+
+    MappedTextureSubresource MappedData;
+    pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+    ASSERT_NE(MappedData.pData, nullptr);
+    Uint32 NumInvalidTexels = 0;
+    for (Uint32 y = 0; y < TileSize; ++y)
+    {
+        const Uint32* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(MappedData.pData) + MappedData.Stride * y);
+        for (Uint32 x = 0; x < TileSize; ++x)
+            NumInvalidTexels += pRow[x] != GetTileColor({1, 2, 0}) ? 1 : 0;
+    }
+    pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+    EXPECT_EQ(NumInvalidTexels, 0u);
+}
+
+TEST(VirtualTextureManagerTest, Eviction)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    VirtualTextureManager VTMgr{pDevice, GetTestCreateInfo()};
+
+    RequestTile(VTMgr, {0, 0, 0});
+    VTMgr.Update(pContext);
+    EXPECT_EQ(VTMgr.GetStats().NumResidentTiles, 4u);
+
+    // Three new tiles while only two pages are free: the least recently used tile must be evicted
+    RequestTile(VTMgr, {7, 7, 0});
+    VTMgr.Update(pContext);
+    EXPECT_TRUE(VTMgr.IsTileResident({7, 7, 0}));
+    EXPECT_TRUE(VTMgr.IsTileResident({3, 3, 1}));
+    EXPECT_TRUE(VTMgr.IsTileResident({1, 1, 2}));
+    // The coarsest tile is never evicted
+    EXPECT_TRUE(VTMgr.IsTileResident({0, 0, 3}));
+
+    VirtualTextureStats Stats = VTMgr.GetStats();
+    EXPECT_EQ(Stats.NumResidentTiles, 6u);
+    EXPECT_EQ(Stats.NumLoadedTiles, Uint64{7});
+    EXPECT_EQ(Stats.NumEvictedTiles, Uint64{1});
+
+    GetResidentPage(VTMgr, {7, 7, 0});
+
+    // Tiles used by the current frame are not evicted, so only two pages can be reused
+    const VirtualTextureTile Tiles[] = {{7, 7, 0}, {3, 3, 1}, {1, 1, 2}, {0, 0, 3}};
+    const Uint32             Feedback[] =
+        {
+            VirtualTextureManager::EncodeFeedback(Tiles[0]),
+            VirtualTextureManager::EncodeFeedback(Tiles[1]),
+            VirtualTextureManager::EncodeFeedback(Tiles[2]),
+            VirtualTextureManager::EncodeFeedback(Tiles[3]),
+            VirtualTextureManager::EncodeFeedback({4, 0, 0}),
+            VirtualTextureManager::EncodeFeedback({5, 0, 0}),
+            VirtualTextureManager::EncodeFeedback({6, 0, 0}),
+            VirtualTextureManager::EncodeFeedback({7, 0, 0}),
+        };
+    VTMgr.AnalyzeFeedback(Feedback, _countof(Feedback));
+    VTMgr.Update(pContext);
+    for (const VirtualTextureTile& Tile : Tiles)
+        EXPECT_TRUE(VTMgr.IsTileResident(Tile));
+
+    Stats = VTMgr.GetStats();
+    EXPECT_EQ(Stats.NumResidentTiles, 6u);
+    EXPECT_EQ(Stats.NumEvictedTiles, Uint64{3});
+    // Coarse and most requested tiles are loaded first
+    EXPECT_TRUE(VTMgr.IsTileResident({1, 0, 2}));
+    EXPECT_TRUE(VTMgr.IsTileResident({2, 0, 1}));
+    EXPECT_FALSE(VTMgr.IsTileResident({3, 0, 1}));
+    EXPECT_FALSE(VTMgr.IsTileResident({4, 0, 0}));
+    EXPECT_EQ(VTMgr.GetPageTableEntry({4, 0, 0}), VTMgr.GetPageTableEntry({2, 0, 1}));
+    EXPECT_EQ(VTMgr.GetPageTableEntry({6, 0, 0}), VTMgr.GetPageTableEntry({1, 0, 2}));
+}
+
+TEST(VirtualTextureManagerTest, LoadFailure)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    VirtualTextureManagerCreateInfo CI = GetTestCreateInfo();
+    CI.TileLoader                      = [](const VirtualTextureTile& Tile, const MappedTextureSubresource& Data) {
+        return Tile.MipLevel != 0 && LoadTestTile(Tile, Data);
+    };
+    VirtualTextureManager VTMgr{pDevice, CI};
+
+    RequestTile(VTMgr, {2, 2, 0});
+    VTMgr.Update(pContext);
+    EXPECT_FALSE(VTMgr.IsTileResident({2, 2, 0}));
+    EXPECT_TRUE(VTMgr.IsTileResident({1, 1, 1}));
+    EXPECT_EQ(VTMgr.GetPageTableEntry({2, 2, 0}), VTMgr.GetPageTableEntry({1, 1, 1}));
+
+    VirtualTextureStats Stats = VTMgr.GetStats();
+    EXPECT_EQ(Stats.NumFailedTiles, Uint64{1});
+    EXPECT_EQ(Stats.NumResidentTiles, 3u);
+
+    // Failed tiles are not requested again
+    RequestTile(VTMgr, {2, 2, 0});
+    VTMgr.Update(pContext);
+    EXPECT_EQ(VTMgr.GetStats().NumFailedTiles, Uint64{1});
+}
+
+} // namespace
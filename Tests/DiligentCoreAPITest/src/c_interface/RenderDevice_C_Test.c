@@ -40,6 +40,7 @@ int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
     TextureFormatInfo         TexFmtInfo;
     TextureFormatInfoExt      TexFmtInfoExt;
     IEngineFactory*           pFactory = NULL;
+    DeviceMemoryStats         MemStats;
 
     int num_errors = TestObjectCInterface((struct IObject*)pRenderDevice);
 
@@ -76,6 +77,12 @@ int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
     IRenderDevice_IdleGPU(pRenderDevice);
     IRenderDevice_ReleaseStaleResources(pRenderDevice, false);
 
+    IRenderDevice_GetMemoryStats(pRenderDevice, &MemStats);
+    if (MemStats.NumHeaps > DILIGENT_MAX_MEMORY_HEAPS)
+        ++num_errors;
+    if (MemStats.DynamicMemoryUsed > MemStats.DynamicMemoryReserved)
+        ++num_errors;
+
     pFactory = IRenderDevice_GetEngineFactory(pRenderDevice);
     if (pFactory == NULL)
         ++num_errors;
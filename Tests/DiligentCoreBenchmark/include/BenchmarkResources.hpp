@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "RefCntAutoPtr.hpp"
+
+#include "benchmark/benchmark.h"
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+/// Objects shared by the GPU benchmarks.
+struct BenchmarkResources
+{
+    RefCntAutoPtr<IPipelineState>         pPSO[2];
+    RefCntAutoPtr<IShaderResourceBinding> pSRB[2];
+    RefCntAutoPtr<IBuffer>                pVertexBuffer;
+    RefCntAutoPtr<IBuffer>                pIndexBuffer;
+    RefCntAutoPtr<IBuffer>                pConstants;
+    RefCntAutoPtr<ITexture>               pTexture;
+
+    static constexpr Uint32 NumVertices = 3;
+    static constexpr Uint32 NumIndices  = 3;
+};
+
+/// HLSL source of the vertex shader used by the benchmark pipelines (ATTRIB0: float2 position).
+extern const char* const VSSource;
+
+/// HLSL source of the pixel shader used by the benchmark pipelines.
+extern const char* const PSSource;
+
+/// Initializes the graphics pipeline description shared by all benchmark pipelines.
+void InitPipelineCreateInfo(GraphicsPipelineStateCreateInfo& PSOCreateInfo, const char* Name);
+
+/// Returns the render device, or null if the benchmarks run without a device.
+IRenderDevice* GetDevice();
+
+/// Returns the immediate device context, or null if the benchmarks run without a device.
+IDeviceContext* GetContext();
+
+/// Returns the shared resources; the resources are created on first use.
+/// If there is no device, reports an error to the benchmark state and returns null.
+const BenchmarkResources* GetResources(benchmark::State& state);
+
+/// Binds the swap chain render target, the vertex and index buffers.
+void SetRenderTargetsAndBuffers(IDeviceContext* pCtx, const BenchmarkResources& Res);
+
+/// Flushes the context every few thousands of commands to keep the command buffer size bounded.
+/// Since flushing resets the pipeline state and shader resources, pPSO and pSRB, if not null,
+/// are bound again after the flush.
+void FlushPeriodically(IDeviceContext* pCtx, Uint32& CommandCount, IPipelineState* pPSO = nullptr, IShaderResourceBinding* pSRB = nullptr);
+
+/// Flushes the context, waits for the GPU, releases the stale resources and
+/// invalidates the context state. Called after the timed loop of every GPU benchmark.
+void FinishBenchmark();
+
+/// Registers the benchmark that replays the frames of the command capture file
+/// recorded with Diligent::CommandCapture.
+void RegisterReplayBenchmark(const char* CaptureFilePath);
+
+/// Releases the command replay created by the replay benchmark.
+void ReleaseReplay();
+
+/// Releases the shared resources. Must be called before the testing environment is destroyed.
+void ReleaseResources();
+
+} // namespace Benchmark
+
+} // namespace Diligent
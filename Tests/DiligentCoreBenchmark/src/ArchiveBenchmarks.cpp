@@ -0,0 +1,171 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BenchmarkResources.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+#include "GraphicsAccessories.hpp"
+#include "ArchiverFactory.h"
+#include "Dearchiver.h"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static constexpr Uint32 ContentVersion    = 1;
+static constexpr char   ArchivedPSOName[] = "Archived benchmark PSO";
+
+// Serializes the benchmark pipeline for the current device type.
+RefCntAutoPtr<IDataBlob> CreateArchive()
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pDevice          = pEnv->GetDevice();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+    if (pArchiverFactory == nullptr)
+        return {};
+
+    const auto DeviceFlags = RenderDeviceTypeToArchiveDataFlag(pDevice->GetDeviceInfo().Type);
+
+    RefCntAutoPtr<ISerializationDevice> pSerializationDevice;
+    {
+        SerializationDeviceCreateInfo DeviceCI;
+        DeviceCI.DeviceInfo.Features.SeparablePrograms = pDevice->GetDeviceInfo().Features.SeparablePrograms;
+
+        DeviceCI.Metal.CompileOptionsMacOS = "-sdk macosx metal -std=macos-metal2.0 -mmacos-version-min=10.0";
+        DeviceCI.Metal.CompileOptionsiOS   = "-sdk iphoneos metal -std=ios-metal2.0 -mios-version-min=10.0";
+
+        pArchiverFactory->CreateSerializationDevice(DeviceCI, &pSerializationDevice);
+        if (!pSerializationDevice)
+            return {};
+    }
+
+    RefCntAutoPtr<IArchiver> pArchiver;
+    pArchiverFactory->CreateArchiver(pSerializationDevice, &pArchiver);
+    if (!pArchiver)
+        return {};
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.EntryPoint     = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc   = {"Archived benchmark VS", SHADER_TYPE_VERTEX, true};
+        ShaderCI.Source = VSSource;
+        pSerializationDevice->CreateShader(ShaderCI, ShaderArchiveInfo{DeviceFlags}, &pVS);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc   = {"Archived benchmark PS", SHADER_TYPE_PIXEL, true};
+        ShaderCI.Source = PSSource;
+        pSerializationDevice->CreateShader(ShaderCI, ShaderArchiveInfo{DeviceFlags}, &pPS);
+    }
+
+    if (!pVS || !pPS)
+        return {};
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    InitPipelineCreateInfo(PSOCreateInfo, ArchivedPSOName);
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    PipelineStateArchiveInfo ArchiveInfo;
+    ArchiveInfo.DeviceFlags = DeviceFlags;
+
+    RefCntAutoPtr<IPipelineState> pSerializedPSO;
+    pSerializationDevice->CreateGraphicsPipelineState(PSOCreateInfo, ArchiveInfo, &pSerializedPSO);
+    if (!pSerializedPSO || !pArchiver->AddPipelineState(pSerializedPSO))
+        return {};
+
+    RefCntAutoPtr<IDataBlob> pArchive;
+    pArchiver->SerializeToBlob(ContentVersion, &pArchive);
+    return pArchive;
+}
+
+
+// Unpacks the pipeline state from the archive.
+// If the argument is zero, the unpacked pipeline is released in every iteration, so that
+// the dearchiver creates a new pipeline and shaders each time. Otherwise, one instance of
+// the pipeline is kept alive and the benchmark measures the cache lookup.
+void Dearchiver_UnpackPipelineState(benchmark::State& state)
+{
+    if (GetResources(state) == nullptr)
+        return;
+
+    auto* pDevice = GetDevice();
+
+    RefCntAutoPtr<IDataBlob> pArchive = CreateArchive();
+    if (!pArchive)
+    {
+        state.SkipWithError("Failed to create the archive. Archiver library may not be available.");
+        return;
+    }
+
+    RefCntAutoPtr<IDearchiver> pDearchiver;
+    pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCreateInfo{}, &pDearchiver);
+    if (!pDearchiver || !pDearchiver->LoadArchive(pArchive, ContentVersion))
+    {
+        state.SkipWithError("Failed to load the archive");
+        return;
+    }
+
+    PipelineStateUnpackInfo UnpackInfo;
+    UnpackInfo.pDevice      = pDevice;
+    UnpackInfo.Name         = ArchivedPSOName;
+    UnpackInfo.PipelineType = PIPELINE_TYPE_GRAPHICS;
+
+    RefCntAutoPtr<IPipelineState> pCachedPSO;
+    if (state.range(0) != 0)
+    {
+        pDearchiver->UnpackPipelineState(UnpackInfo, &pCachedPSO);
+        if (!pCachedPSO)
+        {
+            state.SkipWithError("Failed to unpack the pipeline state");
+            return;
+        }
+    }
+
+    for (auto _ : state)
+    {
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDearchiver->UnpackPipelineState(UnpackInfo, &pPSO);
+        benchmark::DoNotOptimize(pPSO.RawPtr());
+    }
+
+    pCachedPSO.Release();
+    pDearchiver.Release();
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Dearchiver_UnpackPipelineState)->ArgName("Cached")->Arg(0)->Arg(1);
+
+} // namespace
@@ -0,0 +1,298 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BenchmarkResources.hpp"
+
+#include "GPUTestingEnvironment.hpp"
+#include "GraphicsTypesX.hpp"
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+using namespace Testing;
+
+const char* const VSSource = R"(
+cbuffer cbConstants
+{
+    float4 g_Offset;
+}
+
+struct VSInput
+{
+    float2 Pos : ATTRIB0;
+};
+
+void main(in  VSInput VSIn,
+          out float4  Pos : SV_Position)
+{
+    Pos = float4(VSIn.Pos + g_Offset.xy, 0.0, 1.0);
+}
+)";
+
+const char* const PSSource = R"(
+Texture2D<float4> g_Texture;
+
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return g_Texture.Load(int3(int2(Pos.xy) & 3, 0));
+}
+)";
+
+namespace
+{
+
+static constexpr Uint32 FlushInterval = 4096;
+
+BenchmarkResources* g_pResources = nullptr;
+
+bool CreateResources(BenchmarkResources& Res)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.EntryPoint     = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc   = {"Benchmark VS", SHADER_TYPE_VERTEX, true};
+        ShaderCI.Source = VSSource;
+        pDevice->CreateShader(ShaderCI, &pVS);
+        if (!pVS)
+            return false;
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc   = {"Benchmark PS", SHADER_TYPE_PIXEL, true};
+        ShaderCI.Source = PSSource;
+        pDevice->CreateShader(ShaderCI, &pPS);
+        if (!pPS)
+            return false;
+    }
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    InitPipelineCreateInfo(PSOCreateInfo, "Benchmark PSO 0");
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+    for (Uint32 i = 0; i < _countof(Res.pPSO); ++i)
+    {
+        // The second pipeline only differs in the blend state, so that switching between
+        // the pipelines does not change the resource layout.
+        if (i == 1)
+        {
+            PSOCreateInfo.PSODesc.Name = "Benchmark PSO 1";
+
+            auto& RT0          = PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0];
+            RT0.BlendEnable    = True;
+            RT0.SrcBlend       = BLEND_FACTOR_SRC_ALPHA;
+            RT0.DestBlend      = BLEND_FACTOR_INV_SRC_ALPHA;
+            RT0.SrcBlendAlpha  = BLEND_FACTOR_ONE;
+            RT0.DestBlendAlpha = BLEND_FACTOR_ZERO;
+        }
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &Res.pPSO[i]);
+        if (!Res.pPSO[i])
+            return false;
+    }
+
+    {
+        const float2 Vertices[] = {{-0.5f, -0.5f}, {0.f, 0.5f}, {0.5f, -0.5f}};
+        static_assert(_countof(Vertices) == BenchmarkResources::NumVertices, "Unexpected number of vertices");
+
+        BufferDesc BuffDesc{"Benchmark vertex buffer", sizeof(Vertices), BIND_VERTEX_BUFFER, USAGE_IMMUTABLE};
+        BufferData InitData{Vertices, sizeof(Vertices)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &Res.pVertexBuffer);
+    }
+
+    {
+        const Uint32 Indices[] = {0, 1, 2};
+        static_assert(_countof(Indices) == BenchmarkResources::NumIndices, "Unexpected number of indices");
+
+        BufferDesc BuffDesc{"Benchmark index buffer", sizeof(Indices), BIND_INDEX_BUFFER, USAGE_IMMUTABLE};
+        BufferData InitData{Indices, sizeof(Indices)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &Res.pIndexBuffer);
+    }
+
+    {
+        const float4 Offset{0, 0, 0, 0};
+
+        BufferDesc BuffDesc{"Benchmark constants", sizeof(Offset), BIND_UNIFORM_BUFFER, USAGE_DEFAULT};
+        BufferData InitData{&Offset, sizeof(Offset)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &Res.pConstants);
+    }
+
+    {
+        Uint32 Texels[4 * 4];
+        for (Uint32 i = 0; i < _countof(Texels); ++i)
+            Texels[i] = ((i ^ (i >> 2)) & 1) ? 0xFFFFFFFFu : 0xFF000000u;
+
+        Res.pTexture = pEnv->CreateTexture("Benchmark texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 4, 4, Texels);
+    }
+
+    if (!Res.pVertexBuffer || !Res.pIndexBuffer || !Res.pConstants || !Res.pTexture)
+        return false;
+
+    for (Uint32 i = 0; i < _countof(Res.pPSO); ++i)
+    {
+        Res.pPSO[i]->GetStaticVariableByName(SHADER_TYPE_VERTEX, "cbConstants")->Set(Res.pConstants);
+        Res.pPSO[i]->CreateShaderResourceBinding(&Res.pSRB[i], true);
+        if (!Res.pSRB[i])
+            return false;
+        Res.pSRB[i]->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(Res.pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    }
+
+    auto* pCtx = pEnv->GetDeviceContext();
+
+    // Transition the resources once so that the benchmarks that use RESOURCE_STATE_TRANSITION_MODE_VERIFY
+    // do not trigger state transitions.
+    StateTransitionDesc Barriers[] = {
+        {Res.pVertexBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {Res.pIndexBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {Res.pConstants, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+        {Res.pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE},
+    };
+    pCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+    pCtx->Flush();
+
+    return true;
+}
+
+} // namespace
+
+void InitPipelineCreateInfo(GraphicsPipelineStateCreateInfo& PSOCreateInfo, const char* Name)
+{
+    auto* pSwapChain = GPUTestingEnvironment::GetInstance()->GetSwapChain();
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name                                  = Name;
+    PSODesc.PipelineType                          = PIPELINE_TYPE_GRAPHICS;
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+    GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    static constexpr LayoutElement Elems[] = {LayoutElement{0, 0, 2, VT_FLOAT32, False}};
+
+    GraphicsPipeline.InputLayout.LayoutElements = Elems;
+    GraphicsPipeline.InputLayout.NumElements    = _countof(Elems);
+
+    static constexpr ShaderResourceVariableDesc Vars[] = {
+        {SHADER_TYPE_PIXEL, "g_Texture", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+    };
+
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+    PSODesc.ResourceLayout.Variables           = Vars;
+    PSODesc.ResourceLayout.NumVariables        = _countof(Vars);
+}
+
+IRenderDevice* GetDevice()
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    return pEnv != nullptr ? pEnv->GetDevice() : nullptr;
+}
+
+IDeviceContext* GetContext()
+{
+    auto* pEnv = GPUTestingEnvironment::GetInstance();
+    return pEnv != nullptr ? pEnv->GetDeviceContext() : nullptr;
+}
+
+const BenchmarkResources* GetResources(benchmark::State& state)
+{
+    if (GPUTestingEnvironment::GetInstance() == nullptr)
+    {
+        state.SkipWithError("Render device is not initialized. Use --mode=<backend> to run GPU benchmarks.");
+        return nullptr;
+    }
+
+    if (g_pResources == nullptr)
+    {
+        g_pResources = new BenchmarkResources;
+        if (!CreateResources(*g_pResources))
+        {
+            ReleaseResources();
+            state.SkipWithError("Failed to create benchmark resources");
+            return nullptr;
+        }
+    }
+
+    return g_pResources;
+}
+
+void SetRenderTargetsAndBuffers(IDeviceContext* pCtx, const BenchmarkResources& Res)
+{
+    auto*         pSwapChain = GPUTestingEnvironment::GetInstance()->GetSwapChain();
+    ITextureView* pRTVs[]    = {pSwapChain->GetCurrentBackBufferRTV()};
+    pCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    IBuffer* pVBs[] = {Res.pVertexBuffer};
+    pCtx->SetVertexBuffers(0, 1, pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pCtx->SetIndexBuffer(Res.pIndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+}
+
+void FlushPeriodically(IDeviceContext* pCtx, Uint32& CommandCount, IPipelineState* pPSO, IShaderResourceBinding* pSRB)
+{
+    if (++CommandCount < FlushInterval)
+        return;
+
+    CommandCount = 0;
+    pCtx->Flush();
+    pCtx->FinishFrame();
+
+    if (pPSO != nullptr)
+        pCtx->SetPipelineState(pPSO);
+    if (pSRB != nullptr)
+        pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+}
+
+void FinishBenchmark()
+{
+    if (auto* pEnv = GPUTestingEnvironment::GetInstance())
+        pEnv->Reset();
+}
+
+void ReleaseResources()
+{
+    ReleaseReplay();
+
+    delete g_pResources;
+    g_pResources = nullptr;
+
+    if (auto* pEnv = GPUTestingEnvironment::GetInstance())
+        pEnv->ReleaseResources();
+}
+
+} // namespace Benchmark
+
+} // namespace Diligent
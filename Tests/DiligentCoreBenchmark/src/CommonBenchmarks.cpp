@@ -0,0 +1,203 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FixedBlockMemoryAllocator.hpp"
+#include "DynamicLinearAllocator.hpp"
+#include "FrameArena.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
+#include "HashUtils.hpp"
+#include "FlatHashMap.hpp"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Allocates and releases blocks in FIFO order; the argument is the number of live blocks.
+void FixedBlockMemoryAllocator_AllocateFree(benchmark::State& state)
+{
+    const auto NumLiveBlocks = static_cast<size_t>(state.range(0));
+
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64, 1024};
+
+    std::vector<void*> Blocks(NumLiveBlocks);
+    for (auto& pBlock : Blocks)
+        pBlock = Allocator.Allocate(64, "Benchmark block", __FILE__, __LINE__);
+
+    size_t Idx = 0;
+    for (auto _ : state)
+    {
+        Allocator.Free(Blocks[Idx]);
+        Blocks[Idx] = Allocator.Allocate(64, "Benchmark block", __FILE__, __LINE__);
+        benchmark::DoNotOptimize(Blocks[Idx]);
+        Idx = (Idx + 1) % NumLiveBlocks;
+    }
+
+    for (auto* pBlock : Blocks)
+        Allocator.Free(pBlock);
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(FixedBlockMemoryAllocator_AllocateFree)->Arg(1)->Arg(1024);
+
+
+// Allocates the argument number of small objects and discards the allocator.
+void DynamicLinearAllocator_AllocateDiscard(benchmark::State& state)
+{
+    const auto NumAllocations = state.range(0);
+
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64 << 10};
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < NumAllocations; ++i)
+            benchmark::DoNotOptimize(Allocator.Allocate(24 + (i & 7) * 8, 16));
+        Allocator.Discard();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NumAllocations);
+}
+BENCHMARK(DynamicLinearAllocator_AllocateDiscard)->Arg(64)->Arg(4096);
+
+
+// Simulates a frame of transient allocations in a triple-buffered frame arena.
+void FrameArena_Frame(benchmark::State& state)
+{
+    const auto NumAllocations = state.range(0);
+
+    FrameArena Arena{DefaultRawMemoryAllocator::GetAllocator(), 3};
+    for (auto _ : state)
+    {
+        Arena.BeginFrame();
+        for (int64_t i = 0; i < NumAllocations; ++i)
+            benchmark::DoNotOptimize(Arena.Allocate(64 + (i & 3) * 64, 16));
+    }
+
+    state.SetItemsProcessed(state.iterations() * NumAllocations);
+}
+BENCHMARK(FrameArena_Frame)->Arg(64)->Arg(4096);
+
+
+// Allocates and releases ranges of random sizes; the argument is the number of live allocations.
+template <typename ManagerType>
+void AllocationsManager_AllocateFree(benchmark::State& state)
+{
+    const auto NumLiveAllocations = static_cast<size_t>(state.range(0));
+
+    using Allocation = typename ManagerType::Allocation;
+
+    ManagerType Mgr{typename ManagerType::CreateInfo{DefaultRawMemoryAllocator::GetAllocator(), size_t{256} << 20, true}};
+
+    FastRandInt Rnd{0, 1, 1024};
+
+    std::vector<Allocation> Allocations;
+    Allocations.reserve(NumLiveAllocations);
+    for (size_t i = 0; i < NumLiveAllocations; ++i)
+        Allocations.emplace_back(Mgr.Allocate(static_cast<size_t>(Rnd()) * 64, 256));
+
+    size_t Idx = 0;
+    for (auto _ : state)
+    {
+        // Release allocations in an order different from the allocation order to fragment the free list
+        Idx = (Idx + 7919) % NumLiveAllocations;
+        if (Allocations[Idx].IsValid())
+            Mgr.Free(std::move(Allocations[Idx]));
+        Allocations[Idx] = Mgr.Allocate(static_cast<size_t>(Rnd()) * 64, 256);
+        benchmark::DoNotOptimize(Allocations[Idx].UnalignedOffset);
+    }
+
+    for (auto& Alloc : Allocations)
+    {
+        if (Alloc.IsValid())
+            Mgr.Free(std::move(Alloc));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(AllocationsManager_AllocateFree, VariableSizeAllocationsManager)->Arg(16)->Arg(4096);
+BENCHMARK_TEMPLATE(AllocationsManager_AllocateFree, TLSFAllocationsManager)->Arg(16)->Arg(4096);
+
+
+// Looks up resource names in a hash map, as done by resource mappings and shader resource caches.
+void HashMapStringKey_Find(benchmark::State& state)
+{
+    const auto NumKeys = static_cast<size_t>(state.range(0));
+
+    std::vector<std::string> Names(NumKeys);
+    for (size_t i = 0; i < NumKeys; ++i)
+        Names[i] = "g_ShaderResource_" + std::to_string(i);
+
+    std::unordered_map<HashMapStringKey, size_t> Map;
+    for (size_t i = 0; i < NumKeys; ++i)
+        Map.emplace(HashMapStringKey{Names[i].c_str()}, i);
+
+    size_t Idx = 0;
+    for (auto _ : state)
+    {
+        Idx = (Idx + 13) % NumKeys;
+
+        auto it = Map.find(Names[Idx].c_str());
+        benchmark::DoNotOptimize(it);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(HashMapStringKey_Find)->Arg(16)->Arg(1024);
+
+
+// Looks up pointer-sized keys, as done by the object caches; half of the lookups miss.
+template <typename MapType>
+void HashMap_Find(benchmark::State& state)
+{
+    const auto NumKeys = static_cast<size_t>(state.range(0));
+
+    MapType Map;
+    for (size_t i = 0; i < NumKeys; ++i)
+        Map.emplace(i * 2 * 0x9E3779B97F4A7C15ull, i);
+
+    size_t Idx = 0;
+    for (auto _ : state)
+    {
+        Idx = (Idx + 13) % (NumKeys * 2);
+
+        auto it = Map.find(Idx * 0x9E3779B97F4A7C15ull);
+        benchmark::DoNotOptimize(it);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(HashMap_Find, std::unordered_map<Uint64, size_t>)->Arg(16)->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(HashMap_Find, FlatHashMap<Uint64, size_t>)->Arg(16)->Arg(1024)->Arg(65536);
+
+} // namespace
@@ -0,0 +1,231 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "BenchmarkResources.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Alternates between two pipelines with the same resource layout.
+void Context_SetPipelineState(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    auto* pCtx = GetContext();
+
+    Uint32 CmdCount = 0;
+    Uint32 Idx      = 0;
+    for (auto _ : state)
+    {
+        pCtx->SetPipelineState(pRes->pPSO[Idx]);
+        Idx ^= 1;
+        FlushPeriodically(pCtx, CmdCount);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Context_SetPipelineState);
+
+
+// Alternates between two shader resource bindings.
+// The argument is the state transition mode (0 - verify, 1 - transition).
+void Context_CommitShaderResources(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    const auto TransitionMode = state.range(0) != 0 ? RESOURCE_STATE_TRANSITION_MODE_TRANSITION : RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+
+    auto* pCtx = GetContext();
+    pCtx->SetPipelineState(pRes->pPSO[0]);
+
+    Uint32 CmdCount = 0;
+    Uint32 Idx      = 0;
+    for (auto _ : state)
+    {
+        pCtx->CommitShaderResources(pRes->pSRB[Idx], TransitionMode);
+        Idx ^= 1;
+        FlushPeriodically(pCtx, CmdCount, pRes->pPSO[0]);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Context_CommitShaderResources)->ArgName("Transition")->Arg(0)->Arg(1);
+
+
+void Context_Draw(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    auto* pCtx = GetContext();
+    SetRenderTargetsAndBuffers(pCtx, *pRes);
+    pCtx->SetPipelineState(pRes->pPSO[0]);
+    pCtx->CommitShaderResources(pRes->pSRB[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    const DrawAttribs Attribs{BenchmarkResources::NumVertices, DRAW_FLAG_NONE};
+
+    Uint32 CmdCount = 0;
+    for (auto _ : state)
+    {
+        pCtx->Draw(Attribs);
+        FlushPeriodically(pCtx, CmdCount, pRes->pPSO[0], pRes->pSRB[0]);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Context_Draw);
+
+
+void Context_DrawIndexed(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    auto* pCtx = GetContext();
+    SetRenderTargetsAndBuffers(pCtx, *pRes);
+    pCtx->SetPipelineState(pRes->pPSO[0]);
+    pCtx->CommitShaderResources(pRes->pSRB[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    const DrawIndexedAttribs Attribs{BenchmarkResources::NumIndices, VT_UINT32, DRAW_FLAG_NONE};
+
+    Uint32 CmdCount = 0;
+    for (auto _ : state)
+    {
+        pCtx->DrawIndexed(Attribs);
+        FlushPeriodically(pCtx, CmdCount, pRes->pPSO[0], pRes->pSRB[0]);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Context_DrawIndexed);
+
+
+// Per-draw state changes typical for a scene: pipeline, resources, draw.
+void Context_StateChangeAndDraw(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    auto* pCtx = GetContext();
+    SetRenderTargetsAndBuffers(pCtx, *pRes);
+
+    const DrawIndexedAttribs Attribs{BenchmarkResources::NumIndices, VT_UINT32, DRAW_FLAG_NONE};
+
+    Uint32 CmdCount = 0;
+    Uint32 Idx      = 0;
+    for (auto _ : state)
+    {
+        pCtx->SetPipelineState(pRes->pPSO[Idx]);
+        pCtx->CommitShaderResources(pRes->pSRB[Idx], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pCtx->DrawIndexed(Attribs);
+        Idx ^= 1;
+        FlushPeriodically(pCtx, CmdCount);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Context_StateChangeAndDraw);
+
+
+// The argument is the number of draw items in one MultiDraw command.
+void Context_MultiDraw(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    auto* pCtx = GetContext();
+    SetRenderTargetsAndBuffers(pCtx, *pRes);
+    pCtx->SetPipelineState(pRes->pPSO[0]);
+    pCtx->CommitShaderResources(pRes->pSRB[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    const auto DrawCount = static_cast<Uint32>(state.range(0));
+
+    std::vector<MultiDrawItem> DrawItems(DrawCount, MultiDrawItem{BenchmarkResources::NumVertices, 0});
+
+    const MultiDrawAttribs Attribs{DrawCount, DrawItems.data(), DRAW_FLAG_NONE};
+
+    Uint32 CmdCount = 0;
+    for (auto _ : state)
+    {
+        pCtx->MultiDraw(Attribs);
+        FlushPeriodically(pCtx, CmdCount, pRes->pPSO[0], pRes->pSRB[0]);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations() * DrawCount);
+}
+BENCHMARK(Context_MultiDraw)->Arg(1)->Arg(16)->Arg(256);
+
+
+// The argument is the number of draw items in one MultiDrawIndexed command.
+void Context_MultiDrawIndexed(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    auto* pCtx = GetContext();
+    SetRenderTargetsAndBuffers(pCtx, *pRes);
+    pCtx->SetPipelineState(pRes->pPSO[0]);
+    pCtx->CommitShaderResources(pRes->pSRB[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    const auto DrawCount = static_cast<Uint32>(state.range(0));
+
+    std::vector<MultiDrawIndexedItem> DrawItems(DrawCount, MultiDrawIndexedItem{BenchmarkResources::NumIndices, 0, 0});
+
+    const MultiDrawIndexedAttribs Attribs{DrawCount, DrawItems.data(), VT_UINT32, DRAW_FLAG_NONE};
+
+    Uint32 CmdCount = 0;
+    for (auto _ : state)
+    {
+        pCtx->MultiDrawIndexed(Attribs);
+        FlushPeriodically(pCtx, CmdCount, pRes->pPSO[0], pRes->pSRB[0]);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations() * DrawCount);
+}
+BENCHMARK(Context_MultiDrawIndexed)->Arg(1)->Arg(16)->Arg(256);
+
+} // namespace
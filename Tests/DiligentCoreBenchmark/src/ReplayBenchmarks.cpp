@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkResources.hpp"
+#include "CommandReplay.hpp"
+#include "GPUTestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::string                    g_CaptureFilePath;
+std::unique_ptr<CommandReplay> g_pReplay;
+
+// Replays all frames of the command capture once per iteration.
+// The iteration time is the CPU time spent recording and submitting the frames;
+// the counters report per-frame averages and the slowest frame.
+void Replay_CapturedFrames(benchmark::State& state)
+{
+    if (GPUTestingEnvironment::GetInstance() == nullptr)
+    {
+        state.SkipWithError("Render device is not initialized. Use --mode=<backend> to run GPU benchmarks.");
+        return;
+    }
+
+    if (!g_pReplay)
+    {
+        try
+        {
+            g_pReplay = std::make_unique<CommandReplay>(GetDevice(), GetContext(), g_CaptureFilePath.c_str());
+        }
+        catch (...)
+        {
+            state.SkipWithError("Failed to load the command capture");
+            return;
+        }
+    }
+
+    const Uint32 NumFrames = g_pReplay->GetNumFrames();
+    if (NumFrames == 0)
+    {
+        state.SkipWithError("The command capture contains no frames");
+        return;
+    }
+
+    double TotalCPUTime   = 0;
+    double TotalGPUTime   = 0;
+    double MaxFrameCPU    = 0;
+    double MaxFrameGPU    = 0;
+    Uint32 NumGPUSamples  = 0;
+    Uint64 NumFramesTotal = 0;
+    for (auto _ : state)
+    {
+        const std::vector<CommandReplayFrameStats> Stats = g_pReplay->Run(1);
+
+        double IterationCPUTime = 0;
+        for (const CommandReplayFrameStats& Frame : Stats)
+        {
+            IterationCPUTime += Frame.AvgCPUTime;
+            MaxFrameCPU = std::max(MaxFrameCPU, Frame.MaxCPUTime);
+            if (Frame.NumGPUSamples > 0)
+            {
+                TotalGPUTime += Frame.AvgGPUTime;
+                MaxFrameGPU = std::max(MaxFrameGPU, Frame.MaxGPUTime);
+                ++NumGPUSamples;
+            }
+        }
+        TotalCPUTime += IterationCPUTime;
+        NumFramesTotal += Stats.size();
+        state.SetIterationTime(IterationCPUTime);
+    }
+    FinishBenchmark();
+
+    if (NumFramesTotal > 0)
+    {
+        state.counters["CPUFrameTimeUs"]    = TotalCPUTime * 1e+6 / static_cast<double>(NumFramesTotal);
+        state.counters["MaxCPUFrameTimeUs"] = MaxFrameCPU * 1e+6;
+    }
+    if (NumGPUSamples > 0)
+    {
+        state.counters["GPUFrameTimeUs"]    = TotalGPUTime * 1e+6 / NumGPUSamples;
+        state.counters["MaxGPUFrameTimeUs"] = MaxFrameGPU * 1e+6;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(NumFramesTotal));
+}
+
+} // namespace
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+void RegisterReplayBenchmark(const char* CaptureFilePath)
+{
+    g_CaptureFilePath = CaptureFilePath;
+    benchmark::RegisterBenchmark(("Replay_CapturedFrames/" + g_CaptureFilePath).c_str(), Replay_CapturedFrames)->UseManualTime();
+}
+
+void ReleaseReplay()
+{
+    g_pReplay.reset();
+}
+
+} // namespace Benchmark
+
+} // namespace Diligent
@@ -0,0 +1,215 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "BenchmarkResources.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Objects released by the benchmarks are kept alive until the GPU is done with them;
+// release them periodically to keep the memory usage bounded.
+void ReleaseStaleResourcesPeriodically(benchmark::State& state, Uint32& Count)
+{
+    if (++Count < 1024)
+        return;
+
+    Count = 0;
+    state.PauseTiming();
+    auto* pCtx = GetContext();
+    pCtx->Flush();
+    pCtx->FinishFrame();
+    GetDevice()->ReleaseStaleResources();
+    state.ResumeTiming();
+}
+
+// Maps a dynamic buffer with MAP_FLAG_DISCARD and writes the whole buffer.
+// The argument is the buffer size.
+void Context_MapBufferDiscard(benchmark::State& state)
+{
+    if (GetResources(state) == nullptr)
+        return;
+
+    auto* pDevice = GetDevice();
+    auto* pCtx    = GetContext();
+
+    const auto Size = static_cast<Uint64>(state.range(0));
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    {
+        BufferDesc BuffDesc{"Dynamic buffer benchmark", Size, BIND_UNIFORM_BUFFER, USAGE_DYNAMIC, CPU_ACCESS_WRITE};
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        if (!pBuffer)
+        {
+            state.SkipWithError("Failed to create dynamic buffer");
+            return;
+        }
+    }
+
+    const std::vector<Uint8> Data(static_cast<size_t>(Size), Uint8{0x5A});
+
+    Uint32 CmdCount = 0;
+    for (auto _ : state)
+    {
+        void* pData = nullptr;
+        pCtx->MapBuffer(pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        memcpy(pData, Data.data(), Data.size());
+        pCtx->UnmapBuffer(pBuffer, MAP_WRITE);
+        FlushPeriodically(pCtx, CmdCount);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(Size));
+}
+BENCHMARK(Context_MapBufferDiscard)->Arg(256)->Arg(4 << 10)->Arg(64 << 10);
+
+
+// Updates a default buffer with UpdateBuffer. The argument is the update size.
+void Context_UpdateBuffer(benchmark::State& state)
+{
+    if (GetResources(state) == nullptr)
+        return;
+
+    auto* pDevice = GetDevice();
+    auto* pCtx    = GetContext();
+
+    const auto Size = static_cast<Uint64>(state.range(0));
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    {
+        BufferDesc BuffDesc{"Default buffer benchmark", Size, BIND_UNIFORM_BUFFER, USAGE_DEFAULT};
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        if (!pBuffer)
+        {
+            state.SkipWithError("Failed to create default buffer");
+            return;
+        }
+    }
+
+    const std::vector<Uint8> Data(static_cast<size_t>(Size), Uint8{0xA5});
+
+    Uint32 CmdCount = 0;
+    for (auto _ : state)
+    {
+        pCtx->UpdateBuffer(pBuffer, 0, Size, Data.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        FlushPeriodically(pCtx, CmdCount);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(Size));
+}
+BENCHMARK(Context_UpdateBuffer)->Arg(256)->Arg(4 << 10)->Arg(64 << 10);
+
+
+// Creates and releases a shader resource binding, initializing static resources.
+void Device_CreateShaderResourceBinding(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    auto* pPSO     = pRes->pPSO[0].RawPtr();
+    auto* pTexView = pRes->pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    Uint32 Count = 0;
+    for (auto _ : state)
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB, true);
+        pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(pTexView);
+        benchmark::DoNotOptimize(pSRB.RawPtr());
+        pSRB.Release();
+        ReleaseStaleResourcesPeriodically(state, Count);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Device_CreateShaderResourceBinding);
+
+
+// Creates and releases a texture view, which allocates and frees a CPU descriptor
+// (D3D11, D3D12), a Vulkan image view or a GL texture view.
+void Device_CreateTextureView(benchmark::State& state)
+{
+    const auto* pRes = GetResources(state);
+    if (pRes == nullptr)
+        return;
+
+    TextureViewDesc ViewDesc;
+    ViewDesc.Name     = "Benchmark texture view";
+    ViewDesc.ViewType = TEXTURE_VIEW_SHADER_RESOURCE;
+
+    Uint32 Count = 0;
+    for (auto _ : state)
+    {
+        RefCntAutoPtr<ITextureView> pView;
+        pRes->pTexture->CreateView(ViewDesc, &pView);
+        benchmark::DoNotOptimize(pView.RawPtr());
+        pView.Release();
+        ReleaseStaleResourcesPeriodically(state, Count);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Device_CreateTextureView);
+
+
+// Creates and releases a constant buffer, which allocates and frees device memory
+// and, depending on the backend, a descriptor.
+void Device_CreateBuffer(benchmark::State& state)
+{
+    if (GetResources(state) == nullptr)
+        return;
+
+    auto* pDevice = GetDevice();
+
+    const BufferDesc BuffDesc{"Benchmark buffer", 256, BIND_UNIFORM_BUFFER, USAGE_DEFAULT};
+
+    Uint32 Count = 0;
+    for (auto _ : state)
+    {
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        benchmark::DoNotOptimize(pBuffer.RawPtr());
+        pBuffer.Release();
+        ReleaseStaleResourcesPeriodically(state, Count);
+    }
+    FinishBenchmark();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Device_CreateBuffer);
+
+} // namespace
@@ -26,11 +26,15 @@
  */
 
 #include <array>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "FrameArena.hpp"
 
 #include "gtest/gtest.h"
 
@@ -124,6 +128,87 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, ThreadCache)
+{
+    constexpr Uint32 AllocSize             = 32;
+    constexpr Uint32 NumAllocationsPerPage = 16;
+    constexpr Uint32 ThreadCacheSize       = 8;
+    constexpr Uint32 NumThreads            = 4;
+    constexpr Uint32 NumIterations         = 256;
+    constexpr Uint32 NumLiveAllocations    = 12;
+
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, ThreadCacheSize};
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&TestAllocator, t]() {
+            std::vector<Uint32*> Allocations;
+            for (Uint32 i = 0; i < NumIterations; ++i)
+            {
+                auto* pData = reinterpret_cast<Uint32*>(TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__));
+                *pData      = t * NumIterations + i;
+                Allocations.push_back(pData);
+                if (Allocations.size() >= NumLiveAllocations)
+                {
+                    for (auto* pAlloc : Allocations)
+                        TestAllocator.Free(pAlloc);
+                    Allocations.clear();
+                }
+            }
+
+            // Check that no block has been handed out twice
+            for (size_t i = 0; i < Allocations.size(); ++i)
+                EXPECT_EQ(*Allocations[i], t * NumIterations + NumIterations - Allocations.size() + i);
+
+            for (auto* pAlloc : Allocations)
+                TestAllocator.Free(pAlloc);
+        });
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    const auto Stats = TestAllocator.GetThreadCacheStats();
+    EXPECT_EQ(Stats.NumAllocations, Uint64{NumThreads * NumIterations});
+    EXPECT_GT(Stats.NumCacheHits, Uint64{0});
+    EXPECT_GT(Stats.NumRefills, Uint64{0});
+    EXPECT_GT(Stats.NumFlushes, Uint64{0});
+    EXPECT_EQ(Stats.NumCacheHits + Stats.NumRefills, Stats.NumAllocations);
+}
+
+TEST(Common_FixedBlockMemoryAllocator, ThreadCacheOutlivesAllocator)
+{
+    constexpr Uint32 AllocSize             = 16;
+    constexpr Uint32 NumAllocationsPerPage = 4;
+    constexpr Uint32 ThreadCacheSize       = 4;
+
+    // The allocator is destroyed while the threads' caches still hold free blocks
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        auto pAllocator = std::make_unique<FixedBlockMemoryAllocator>(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, ThreadCacheSize);
+
+        void* pMem = pAllocator->Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+        pAllocator->Free(pMem);
+
+        std::thread Worker{[&pAllocator]() {
+            void* pMem = pAllocator->Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+            pAllocator->Free(pMem);
+        }};
+        Worker.join();
+
+        pAllocator.reset();
+    }
+
+    // The thread-local table of this thread now references destroyed allocators.
+    // Make sure the stale entries do not interfere with a new allocator.
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, ThreadCacheSize};
+
+    void* pMem = TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+    TestAllocator.Free(pMem);
+    EXPECT_EQ(TestAllocator.GetThreadCacheStats().NumAllocations, Uint64{1});
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -289,4 +374,74 @@ TEST(Common_DynamicLinearAllocator, ObjectConstruction)
     EXPECT_TRUE(reinterpret_cast<size_t>(Allocator.Allocate(200, 64)) % 64 == 0);
 }
 
+TEST(Common_DynamicLinearAllocator, Rewind)
+{
+    constexpr Uint32       BlockSize = 256;
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), BlockSize};
+
+    const auto EmptyMarker = Allocator.GetMarker();
+
+    auto* pData0 = Allocator.Allocate(64, 1);
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{64});
+
+    const auto Marker0 = Allocator.GetMarker();
+
+    auto* pData1 = Allocator.Allocate(128, 1);
+    EXPECT_EQ(pData1, static_cast<Uint8*>(pData0) + 64);
+
+    const auto Marker1 = Allocator.GetMarker();
+
+    // Does not fit into the first block
+    auto* pData2 = Allocator.Allocate(128, 1);
+    EXPECT_EQ(Allocator.GetBlockCount(), size_t{2});
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{64 + 128 + 128});
+
+    Allocator.Rewind(Marker1);
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{64 + 128});
+    // The second block is reused
+    EXPECT_EQ(Allocator.Allocate(128, 1), pData2);
+
+    Allocator.Rewind(Marker0);
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{64});
+    EXPECT_EQ(Allocator.Allocate(128, 1), pData1);
+
+    Allocator.Rewind(EmptyMarker);
+    EXPECT_EQ(Allocator.GetUsedSize(), size_t{0});
+    EXPECT_EQ(Allocator.Allocate(64, 1), pData0);
+
+    EXPECT_EQ(Allocator.GetBlockCount(), size_t{2});
+    EXPECT_EQ(Allocator.GetReservedSize(), size_t{BlockSize * 2});
+    EXPECT_EQ(Allocator.GetPeakUsedSize(), size_t{64 + 128 + 128});
+
+    Allocator.ResetPeakUsedSize();
+    EXPECT_EQ(Allocator.GetPeakUsedSize(), size_t{64});
+}
+
+TEST(Common_FrameArena, RecycleBlocks)
+{
+    constexpr Uint32 NumFrames = 3;
+    constexpr Uint32 BlockSize = 1024;
+
+    FrameArena Arena{DefaultRawMemoryAllocator::GetAllocator(), NumFrames, BlockSize};
+    EXPECT_EQ(Arena.GetNumFrames(), NumFrames);
+
+    std::array<void*, NumFrames> FrameData = {};
+    for (Uint32 frame = 0; frame < NumFrames * 4; ++frame)
+    {
+        Arena.BeginFrame();
+
+        void* pData = Arena.Allocate(512, 16);
+        ASSERT_NE(pData, nullptr);
+        if (frame >= NumFrames)
+        {
+            // The allocator of the same frame is reused without allocating new blocks
+            EXPECT_EQ(pData, FrameData[frame % NumFrames]);
+            EXPECT_EQ(Arena.GetAllocator().GetBlockCount(), size_t{1});
+        }
+        FrameData[frame % NumFrames] = pData;
+    }
+    EXPECT_EQ(Arena.GetReservedSize(), size_t{NumFrames * BlockSize});
+    EXPECT_EQ(Arena.GetPeakFrameSize(), size_t{512});
+}
+
 } // namespace
@@ -0,0 +1,267 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BVH.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class BVHTestScene
+{
+public:
+    explicit BVHTestScene(Uint32 NumTriangles)
+    {
+        FastRandFloat Rnd{0, -1.f, 1.f};
+        Verts.resize(NumTriangles * 3);
+        for (Uint32 i = 0; i < NumTriangles; ++i)
+        {
+            const float3 Center = float3{Rnd(), Rnd(), Rnd()} * 10.f;
+            for (Uint32 v = 0; v < 3; ++v)
+                Verts[i * 3 + v] = Center + float3{Rnd(), Rnd(), Rnd()} * 0.5f;
+        }
+        UpdateBoxes();
+    }
+
+    void UpdateBoxes()
+    {
+        Boxes.resize(Verts.size() / 3);
+        for (size_t i = 0; i < Boxes.size(); ++i)
+        {
+            Boxes[i].Min = (std::min)((std::min)(Verts[i * 3 + 0], Verts[i * 3 + 1]), Verts[i * 3 + 2]);
+            Boxes[i].Max = (std::max)((std::max)(Verts[i * 3 + 0], Verts[i * 3 + 1]), Verts[i * 3 + 2]);
+        }
+    }
+
+    float IntersectTriangle(Uint32 Tri, const BVH::Ray& Ray) const
+    {
+        return IntersectRayTriangle(Verts[Tri * 3 + 0], Verts[Tri * 3 + 1], Verts[Tri * 3 + 2], Ray.Origin, Ray.Direction);
+    }
+
+    BVH::Hit CastRayBruteForce(const BVH::Ray& Ray) const
+    {
+        BVH::Hit Hit;
+        for (Uint32 i = 0; i < static_cast<Uint32>(Boxes.size()); ++i)
+        {
+            const float Dist = IntersectTriangle(i, Ray);
+            if (Dist >= Ray.MinDistance && Dist < Ray.MaxDistance && Dist < Hit.Distance)
+            {
+                Hit.PrimitiveId = i;
+                Hit.Distance    = Dist;
+            }
+        }
+        return Hit;
+    }
+
+    std::vector<BVH::Ray> GenerateRays(size_t NumRays) const
+    {
+        FastRandFloat Rnd{1, -1.f, 1.f};
+
+        std::vector<BVH::Ray> Rays(NumRays);
+        for (BVH::Ray& Ray : Rays)
+        {
+            Ray.Origin    = float3{Rnd(), Rnd(), Rnd()} * 15.f;
+            Ray.Direction = float3{Rnd(), Rnd(), Rnd()};
+            // Axis-aligned rays
+            if (&Ray - Rays.data() < 16)
+                Ray.Direction = float3{0, 0, Ray.Direction.z > 0 ? 1.f : -1.f};
+        }
+        return Rays;
+    }
+
+    std::vector<float3>   Verts;
+    std::vector<BoundBox> Boxes;
+};
+
+void VerifyRays(const BVH& Bvh, const BVHTestScene& Scene, const std::vector<BVH::Ray>& Rays)
+{
+    size_t NumHits = 0;
+    for (size_t r = 0; r < Rays.size(); ++r)
+    {
+        const BVH::Ray& Ray = Rays[r];
+
+        const BVH::Hit RefHit = Scene.CastRayBruteForce(Ray);
+        const BVH::Hit Hit    = Bvh.CastRay(Ray, [&](Uint32 Tri, const BVH::Ray& R) { return Scene.IntersectTriangle(Tri, R); });
+        EXPECT_EQ(static_cast<bool>(Hit), static_cast<bool>(RefHit)) << "Ray " << r;
+        EXPECT_EQ(Hit.Distance, RefHit.Distance) << "Ray " << r;
+
+        const bool AnyHit = Bvh.IntersectsAny(Ray, [&](Uint32 Tri, const BVH::Ray& R) { return Scene.IntersectTriangle(Tri, R); });
+        EXPECT_EQ(AnyHit, static_cast<bool>(RefHit)) << "Ray " << r;
+
+        if (RefHit)
+            ++NumHits;
+    }
+    EXPECT_GT(NumHits, size_t{0});
+    EXPECT_LT(NumHits, Rays.size());
+}
+
+TEST(Common_BVH, Empty)
+{
+    BVH Bvh;
+    Bvh.Build(nullptr, 0);
+    EXPECT_EQ(Bvh.GetNumNodes(), 0u);
+
+    const BVH::Hit Hit = Bvh.CastRay(BVH::Ray{float3{0, 0, 0}, float3{0, 0, 1}}, [](Uint32, const BVH::Ray&) { return 0.f; });
+    EXPECT_FALSE(Hit);
+}
+
+TEST(Common_BVH, SinglePrimitive)
+{
+    BVHTestScene Scene{1};
+
+    BVH Bvh;
+    Bvh.Build(Scene.Boxes.data(), 1);
+    EXPECT_EQ(Bvh.GetNumNodes(), 1u);
+    EXPECT_EQ(Bvh.GetBounds(), Scene.Boxes[0]);
+
+    const float3   Center = (Scene.Verts[0] + Scene.Verts[1] + Scene.Verts[2]) / 3.f;
+    const BVH::Ray Ray{Center - float3{0, 0, 10}, float3{0, 0, 1}};
+    const BVH::Hit Hit = Bvh.CastRay(Ray, [&](Uint32 Tri, const BVH::Ray& R) { return Scene.IntersectTriangle(Tri, R); });
+    EXPECT_TRUE(Hit);
+    EXPECT_EQ(Hit.PrimitiveId, 0u);
+}
+
+TEST(Common_BVH, CastRay)
+{
+    BVHTestScene Scene{2000};
+
+    BVH Bvh;
+    Bvh.Build(Scene.Boxes.data(), static_cast<Uint32>(Scene.Boxes.size()));
+    EXPECT_GT(Bvh.GetNumNodes(), 1u);
+
+    VerifyRays(Bvh, Scene, Scene.GenerateRays(1000));
+
+    // Limited ray extent
+    std::vector<BVH::Ray> Rays = Scene.GenerateRays(1000);
+    for (BVH::Ray& Ray : Rays)
+    {
+        Ray.MinDistance = 0.5f;
+        Ray.MaxDistance = 5.f;
+    }
+    VerifyRays(Bvh, Scene, Rays);
+}
+
+TEST(Common_BVH, ParallelBuild)
+{
+    BVHTestScene Scene{10000};
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    BVH::BuildInfo Info;
+    Info.pThreadPool            = pThreadPool;
+    Info.ParallelBuildThreshold = 256;
+
+    BVH Bvh;
+    Bvh.Build(Scene.Boxes.data(), static_cast<Uint32>(Scene.Boxes.size()), Info);
+
+    const std::vector<BVH::Ray> Rays = Scene.GenerateRays(500);
+    VerifyRays(Bvh, Scene, Rays);
+
+    std::vector<BVH::Hit> Hits(Rays.size());
+    Bvh.CastRays(
+        Rays.data(), Rays.size(), Hits.data(),
+        [&](Uint32 Tri, const BVH::Ray& R) { return Scene.IntersectTriangle(Tri, R); },
+        pThreadPool, 64);
+    for (size_t r = 0; r < Rays.size(); ++r)
+    {
+        const BVH::Hit RefHit = Scene.CastRayBruteForce(Rays[r]);
+        EXPECT_EQ(Hits[r].PrimitiveId != BVH::InvalidIndex, static_cast<bool>(RefHit)) << "Ray " << r;
+        EXPECT_EQ(Hits[r].Distance, RefHit.Distance) << "Ray " << r;
+    }
+}
+
+TEST(Common_BVH, Refit)
+{
+    BVHTestScene Scene{2000};
+
+    BVH Bvh;
+    Bvh.Build(Scene.Boxes.data(), static_cast<Uint32>(Scene.Boxes.size()));
+
+    FastRandFloat Rnd{2, -1.f, 1.f};
+    for (size_t i = 0; i < Scene.Verts.size(); i += 3)
+    {
+        const float3 Offset{Rnd(), Rnd(), Rnd()};
+        for (size_t v = 0; v < 3; ++v)
+            Scene.Verts[i + v] += Offset;
+    }
+    Scene.UpdateBoxes();
+    Bvh.Refit(Scene.Boxes.data());
+
+    BoundBox SceneBounds{Scene.Boxes[0]};
+    for (const BoundBox& Box : Scene.Boxes)
+    {
+        SceneBounds.Min = (std::min)(SceneBounds.Min, Box.Min);
+        SceneBounds.Max = (std::max)(SceneBounds.Max, Box.Max);
+    }
+    EXPECT_EQ(Bvh.GetBounds(), SceneBounds);
+
+    VerifyRays(Bvh, Scene, Scene.GenerateRays(1000));
+}
+
+TEST(Common_BVH, QueryBox)
+{
+    BVHTestScene Scene{2000};
+
+    BVH Bvh;
+    Bvh.Build(Scene.Boxes.data(), static_cast<Uint32>(Scene.Boxes.size()));
+
+    const BoundBox QueryBox{float3{-2, -3, -1}, float3{3, 1, 2}};
+
+    std::vector<bool> Reported(Scene.Boxes.size());
+    Bvh.QueryBox(QueryBox, [&](Uint32 Prim) {
+        EXPECT_FALSE(Reported[Prim]) << "Primitive " << Prim << " is reported twice";
+        Reported[Prim] = true;
+        return true;
+    });
+
+    size_t NumOverlapping = 0;
+    for (size_t i = 0; i < Scene.Boxes.size(); ++i)
+    {
+        const BoundBox& Box = Scene.Boxes[i];
+
+        const bool Overlaps = Box.Min.x <= QueryBox.Max.x && Box.Max.x >= QueryBox.Min.x &&
+            Box.Min.y <= QueryBox.Max.y && Box.Max.y >= QueryBox.Min.y &&
+            Box.Min.z <= QueryBox.Max.z && Box.Max.z >= QueryBox.Min.z;
+        if (Overlaps)
+        {
+            EXPECT_TRUE(Reported[i]) << "Primitive " << i << " overlaps the query box, but is not reported";
+            ++NumOverlapping;
+        }
+    }
+    EXPECT_GT(NumOverlapping, size_t{0});
+}
+
+} // namespace
@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BlockCompression.hpp"
+
+#include <vector>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<Uint8> MakeRandomData(size_t Size, FastRand::StateType Seed, Uint32 NumSymbols = 256)
+{
+    FastRand           Rnd{Seed};
+    std::vector<Uint8> Data(Size);
+    for (Uint8& b : Data)
+        b = static_cast<Uint8>(Rnd() % NumSymbols);
+    return Data;
+}
+
+size_t TestRoundTrip(const std::vector<Uint8>& Src, const std::vector<Uint8>& Dict = {})
+{
+    std::vector<Uint8> Compressed(GetLZ4CompressBound(Src.size()));
+
+    const size_t CompressedSize = CompressLZ4Block(Src.data(), Src.size(), Compressed.data(), Compressed.size(), Dict.data(), Dict.size());
+    EXPECT_GT(CompressedSize, size_t{0});
+    EXPECT_LE(CompressedSize, Compressed.size());
+
+    std::vector<Uint8> Decompressed(Src.size());
+    EXPECT_TRUE(DecompressLZ4Block(Compressed.data(), CompressedSize, Decompressed.data(), Decompressed.size(), Dict.data(), Dict.size()));
+    EXPECT_EQ(Decompressed, Src);
+
+    return CompressedSize;
+}
+
+TEST(Common_BlockCompression, RoundTrip)
+{
+    TestRoundTrip({});
+    for (size_t Size : {1, 5, 12, 13, 16, 100, 1000, 65536, 200000})
+    {
+        TestRoundTrip(MakeRandomData(Size, static_cast<FastRand::StateType>(Size)));
+        TestRoundTrip(MakeRandomData(Size, static_cast<FastRand::StateType>(Size), 4));
+        TestRoundTrip(std::vector<Uint8>(Size, 7));
+    }
+
+    // Repetitive data must compress well
+    std::vector<Uint8> Src;
+    const auto         Pattern = MakeRandomData(97, 1);
+    for (int i = 0; i < 100; ++i)
+        Src.insert(Src.end(), Pattern.begin(), Pattern.end());
+    EXPECT_LT(TestRoundTrip(Src), Src.size() / 20);
+}
+
+TEST(Common_BlockCompression, Dictionary)
+{
+    const std::vector<Uint8> Common = MakeRandomData(300, 123);
+
+    std::vector<std::vector<Uint8>> Data(8);
+    std::vector<CompressionSample>  Samples;
+    for (size_t i = 0; i < Data.size(); ++i)
+    {
+        // Every sample has the common data in the middle
+        Data[i] = MakeRandomData(100 + i * 8, static_cast<FastRand::StateType>(i + 1));
+        Data[i].insert(Data[i].end(), Common.begin(), Common.end());
+        const auto Tail = MakeRandomData(50, static_cast<FastRand::StateType>(i + 100));
+        Data[i].insert(Data[i].end(), Tail.begin(), Tail.end());
+        Samples.push_back({Data[i].data(), Data[i].size()});
+    }
+
+    const std::vector<Uint8> Dict = TrainCompressionDictionary(Samples, 4096);
+    EXPECT_FALSE(Dict.empty());
+    EXPECT_LE(Dict.size(), size_t{4096});
+
+    for (const auto& Src : Data)
+    {
+        const size_t SizeWithoutDict = TestRoundTrip(Src);
+        const size_t SizeWithDict    = TestRoundTrip(Src, Dict);
+        EXPECT_LT(SizeWithDict + 200, SizeWithoutDict);
+    }
+
+    // Match that starts in the dictionary and continues in the data
+    std::vector<Uint8> Src{Common.end() - 100, Common.end()};
+    Src.insert(Src.end(), Src.begin(), Src.end());
+    TestRoundTrip(Src, Common);
+
+    EXPECT_TRUE(TrainCompressionDictionary(Samples, 0).empty());
+    EXPECT_TRUE(TrainCompressionDictionary({Samples[0]}, 4096).empty());
+}
+
+TEST(Common_BlockCompression, MalformedInput)
+{
+    const std::vector<Uint8> Src = MakeRandomData(1000, 5, 8);
+
+    std::vector<Uint8> Compressed(GetLZ4CompressBound(Src.size()));
+    const size_t       CompressedSize = CompressLZ4Block(Src.data(), Src.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+
+    std::vector<Uint8> Decompressed(Src.size());
+    // Truncated input
+    EXPECT_FALSE(DecompressLZ4Block(Compressed.data(), CompressedSize - 1, Decompressed.data(), Decompressed.size()));
+    // Wrong size
+    EXPECT_FALSE(DecompressLZ4Block(Compressed.data(), CompressedSize, Decompressed.data(), Decompressed.size() - 1));
+    // Missing dictionary
+    std::vector<Uint8> Dict = MakeRandomData(256, 7);
+    std::vector<Uint8> DictSrc{Dict.begin(), Dict.begin() + 100};
+    std::vector<Uint8> DictCompressed(GetLZ4CompressBound(DictSrc.size()));
+    const size_t       DictCompressedSize = CompressLZ4Block(DictSrc.data(), DictSrc.size(), DictCompressed.data(), DictCompressed.size(), Dict.data(), Dict.size());
+    ASSERT_GT(DictCompressedSize, size_t{0});
+    EXPECT_FALSE(DecompressLZ4Block(DictCompressed.data(), DictCompressedSize, DictSrc.data(), DictSrc.size()));
+
+    // Random garbage must not crash
+    for (FastRand::StateType Seed = 0; Seed < 100; ++Seed)
+    {
+        const auto Garbage = MakeRandomData(64, Seed);
+        DecompressLZ4Block(Garbage.data(), Garbage.size(), Decompressed.data(), Decompressed.size());
+    }
+
+    // Destination buffer is too small
+    std::vector<Uint8> Small(10);
+    EXPECT_EQ(CompressLZ4Block(Src.data(), Src.size(), Small.data(), Small.size()), size_t{0});
+}
+
+} // namespace
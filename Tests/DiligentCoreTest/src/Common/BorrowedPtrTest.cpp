@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BorrowedPtr.hpp"
+#include "RefCountedObjectImpl.hpp"
+#include "ObjectBase.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class Object : public ObjectBase<IObject>
+{
+public:
+    Object(IReferenceCounters* pRefCounters) :
+        ObjectBase<IObject>{pRefCounters}
+    {}
+
+    int Value = 0;
+};
+
+class DerivedObject final : public Object
+{
+public:
+    using Object::Object;
+};
+
+TEST(Common_BorrowedPtr, Basic)
+{
+    RefCntAutoPtr<Object> pObj{MakeNewRCObj<Object>()()};
+    IReferenceCounters*   pRefCounters = pObj->GetReferenceCounters();
+    EXPECT_EQ(pRefCounters->GetNumStrongRefs(), 1);
+
+    {
+        BorrowedPtr<Object> pBorrowed;
+        EXPECT_FALSE(pBorrowed);
+        EXPECT_EQ(pBorrowed.RawPtr(), nullptr);
+
+        pBorrowed = pObj.RawPtr();
+        EXPECT_TRUE(pBorrowed);
+        EXPECT_EQ(pBorrowed.RawPtr(), pObj.RawPtr());
+        EXPECT_EQ(pBorrowed, BorrowedPtr<Object>{pObj});
+
+        pBorrowed->Value = 10;
+        EXPECT_EQ((*pBorrowed).Value, 10);
+
+        // Borrowing does not add strong references
+        BorrowedPtr<Object> pBorrowed2{pBorrowed};
+        EXPECT_EQ(pRefCounters->GetNumStrongRefs(), 1);
+
+        Object* pRaw = pBorrowed2;
+        EXPECT_EQ(pRaw, pObj.RawPtr());
+
+        {
+            RefCntAutoPtr<Object> pLocked = pBorrowed.Lock();
+            EXPECT_EQ(pLocked, pObj);
+            EXPECT_EQ(pRefCounters->GetNumStrongRefs(), 2);
+        }
+        EXPECT_EQ(pRefCounters->GetNumStrongRefs(), 1);
+
+        pBorrowed.Reset();
+        EXPECT_FALSE(pBorrowed);
+        EXPECT_NE(pBorrowed, pBorrowed2);
+    }
+    EXPECT_EQ(pRefCounters->GetNumStrongRefs(), 1);
+}
+
+TEST(Common_BorrowedPtr, FromDerived)
+{
+    RefCntAutoPtr<DerivedObject> pObj{MakeNewRCObj<DerivedObject>()()};
+
+    BorrowedPtr<Object> pBorrowed{pObj};
+    EXPECT_EQ(pBorrowed.RawPtr(), static_cast<Object*>(pObj.RawPtr()));
+    EXPECT_EQ(pObj->GetReferenceCounters()->GetNumStrongRefs(), 1);
+}
+
+} // namespace
@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CPUProfiler.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const CPUProfileScopeStats* FindStats(const std::vector<CPUProfileScopeStats>& Stats, const char* Name)
+{
+    for (const auto& S : Stats)
+    {
+        if (S.Name == Name)
+            return &S;
+    }
+    return nullptr;
+}
+
+TEST(Common_CPUProfiler, FrameStats)
+{
+    CPUProfiler::EndFrame();
+
+    {
+        CPUProfileScope Outer{"Outer"};
+        for (int i = 0; i < 3; ++i)
+        {
+            CPUProfileScope Inner{"Inner"};
+        }
+        CPUProfileScope Inner2{CPUProfiler::InternName(std::string{"Inn"}.append("er").c_str())};
+    }
+    CPUProfiler::EndFrame();
+
+    const auto Stats = CPUProfiler::GetFrameStats();
+    ASSERT_EQ(Stats.size(), 2u);
+
+    const auto* pOuter = FindStats(Stats, "Outer");
+    const auto* pInner = FindStats(Stats, "Inner");
+    ASSERT_NE(pOuter, nullptr);
+    ASSERT_NE(pInner, nullptr);
+    EXPECT_EQ(pOuter->Count, 1u);
+    EXPECT_EQ(pInner->Count, 4u);
+    EXPECT_GE(pOuter->TotalTime, pInner->TotalTime);
+    EXPECT_GE(pInner->TotalTime, pInner->MaxTime);
+    // Stats are sorted by total time
+    EXPECT_EQ(Stats[0].Name, "Outer");
+
+    CPUProfiler::EndFrame();
+    EXPECT_TRUE(CPUProfiler::GetFrameStats().empty());
+}
+
+TEST(Common_CPUProfiler, Disable)
+{
+    CPUProfiler::EndFrame();
+
+    CPUProfiler::SetEnabled(false);
+    {
+        CPUProfileScope Scope{"Disabled"};
+    }
+    CPUProfiler::SetEnabled(true);
+    CPUProfiler::EndFrame();
+
+    EXPECT_TRUE(CPUProfiler::GetFrameStats().empty());
+}
+
+TEST(Common_CPUProfiler, MultipleThreads)
+{
+    CPUProfiler::EndFrame();
+    const auto NumDroppedEvents = CPUProfiler::GetNumDroppedEvents();
+
+    constexpr Uint32 NumThreads    = 4;
+    constexpr Uint32 NumIterations = 1024;
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([]() {
+            for (Uint32 i = 0; i < NumIterations; ++i)
+            {
+                CPUProfileScope Scope{"Worker"};
+                CPUProfileScope Nested{"Nested"};
+            }
+        });
+    }
+
+    // Collect the events while the threads are recording
+    std::vector<CPUProfileScopeStats> AllStats;
+    for (int i = 0; i < 16; ++i)
+    {
+        CPUProfiler::EndFrame();
+        auto Stats = CPUProfiler::GetFrameStats();
+        AllStats.insert(AllStats.end(), Stats.begin(), Stats.end());
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+    CPUProfiler::EndFrame();
+    {
+        auto Stats = CPUProfiler::GetFrameStats();
+        AllStats.insert(AllStats.end(), Stats.begin(), Stats.end());
+    }
+
+    Uint32 NumWorker = 0;
+    Uint32 NumNested = 0;
+    for (const auto& S : AllStats)
+    {
+        if (S.Name == "Worker")
+            NumWorker += S.Count;
+        else if (S.Name == "Nested")
+            NumNested += S.Count;
+    }
+    EXPECT_EQ(CPUProfiler::GetNumDroppedEvents(), NumDroppedEvents);
+    EXPECT_EQ(NumWorker, NumThreads * NumIterations);
+    EXPECT_EQ(NumNested, NumThreads * NumIterations);
+}
+
+TEST(Common_CPUProfiler, Capture)
+{
+    CPUProfiler::BeginCapture();
+    EXPECT_TRUE(CPUProfiler::IsCapturing());
+
+    std::thread Worker{[]() {
+        CPUProfiler::SetThreadName("Test \"Worker\"");
+        CPUProfileScope Scope{"WorkerScope"};
+    }};
+    Worker.join();
+
+    {
+        CPUProfileScope Scope{"MainScope"};
+        CPUProfileScope Nested{"NestedScope"};
+    }
+    CPUProfiler::EndFrame();
+
+    const std::string Trace = CPUProfiler::EndCapture();
+    EXPECT_FALSE(CPUProfiler::IsCapturing());
+
+    EXPECT_EQ(Trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+    EXPECT_NE(Trace.find("\"name\":\"WorkerScope\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"MainScope\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"NestedScope\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(Trace.find("\"args\":{\"depth\":1}"), std::string::npos);
+    EXPECT_NE(Trace.find("\"args\":{\"name\":\"Test \\\"Worker\\\"\"}"), std::string::npos);
+    EXPECT_NE(Trace.find("\"name\":\"EndFrame\""), std::string::npos);
+}
+
+} // namespace
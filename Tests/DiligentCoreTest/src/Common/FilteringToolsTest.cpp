@@ -27,6 +27,10 @@
 
 #include "FilteringTools.hpp"
 
+#include <vector>
+
+#include "FastRand.hpp"
+
 #include "gtest/gtest.h"
 
 using namespace Diligent;
@@ -292,4 +296,99 @@ TEST(Common_FilteringTools, FilterTexture2DBilinear)
     }
 }
 
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void TestFilterTexture2DBilinearBatch(float MinUV, float MaxUV)
+{
+    constexpr Uint32 Width  = 37;
+    constexpr Uint32 Height = 21;
+    constexpr size_t Stride = 41;
+
+    FastRandReal<float> Rnd{0, 0.f, 100.f};
+
+    std::vector<float> Data(Stride * Height);
+    for (auto& Val : Data)
+        Val = Rnd();
+
+    FastRandReal<float> RndUV{1, MinUV, MaxUV};
+
+    // Use sample count that is not a multiple of SIMD width to test the tail
+    constexpr size_t    NumSamples = 1027;
+    std::vector<float2> UVs(NumSamples);
+    for (auto& UV : UVs)
+    {
+        UV = float2{RndUV(), RndUV()};
+        if (!IsNormalizedCoord)
+            UV = UV * float2{static_cast<float>(Width), static_cast<float>(Height)};
+    }
+
+    std::vector<float> Values(NumSamples);
+    FilterTexture2DBilinearBatch<float, float, AddressMode, AddressMode, IsNormalizedCoord>(Width, Height, Data.data(), Stride, UVs.data(), NumSamples, Values.data());
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        const float Ref = FilterTexture2DBilinear<float, float, AddressMode, AddressMode, IsNormalizedCoord>(Width, Height, Data.data(), Stride, UVs[i].x, UVs[i].y);
+        EXPECT_FLOAT_EQ(Values[i], Ref) << "u=" << UVs[i].x << " v=" << UVs[i].y;
+    }
+}
+
+TEST(Common_FilteringTools, FilterTexture2DBilinearBatch)
+{
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_CLAMP, true>(-0.5f, 1.5f);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_CLAMP, false>(-0.5f, 1.5f);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_CLAMP, true>(-1e+6f, 1e+6f);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_WRAP, true>(-2.f, 2.f);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_MIRROR, false>(-2.f, 2.f);
+    TestFilterTexture2DBilinearBatch<TEXTURE_ADDRESS_UNKNOWN, true>(0.05f, 0.95f);
+
+    // Empty batch
+    FilterTexture2DBilinearClampBatch<float, float>(1, 1, nullptr, 1, nullptr, 0, nullptr);
+
+    // Integer data
+    {
+        constexpr Uint8  Data[] = {0, 64, 128, 255};
+        const float2     UVs[]  = {{0.25f, 0.25f}, {0.5f, 0.5f}, {0.75f, 0.25f}, {1.f, 1.f}};
+        float            Values[_countof(UVs)];
+        FilterTexture2DBilinearClampBatch<Uint8, float>(2, 2, Data, 2, UVs, _countof(UVs), Values);
+        for (size_t i = 0; i < _countof(UVs); ++i)
+            EXPECT_EQ(Values[i], (FilterTexture2DBilinearClamp<Uint8, float>(2, 2, Data, 2, UVs[i].x, UVs[i].y)));
+    }
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void TestResampleTexture2DBilinear(const float2& StartUV, const float2& StepUV)
+{
+    constexpr Uint32 SrcWidth  = 16;
+    constexpr Uint32 SrcHeight = 12;
+    constexpr Uint32 DstWidth  = 29;
+    constexpr Uint32 DstHeight = 23;
+    constexpr size_t DstStride = 31;
+
+    FastRandReal<float> Rnd{0, -10.f, 10.f};
+
+    std::vector<float> Src(SrcWidth * SrcHeight);
+    for (auto& Val : Src)
+        Val = Rnd();
+
+    std::vector<float> Dst(DstStride * DstHeight);
+    ResampleTexture2DBilinear<float, float, AddressMode, AddressMode, IsNormalizedCoord>(SrcWidth, SrcHeight, Src.data(), SrcWidth, StartUV, StepUV, DstWidth, DstHeight, Dst.data(), DstStride);
+    for (Uint32 y = 0; y < DstHeight; ++y)
+    {
+        for (Uint32 x = 0; x < DstWidth; ++x)
+        {
+            const float u   = StartUV.x + StepUV.x * static_cast<float>(x);
+            const float v   = StartUV.y + StepUV.y * static_cast<float>(y);
+            const float Ref = FilterTexture2DBilinear<float, float, AddressMode, AddressMode, IsNormalizedCoord>(SrcWidth, SrcHeight, Src.data(), SrcWidth, u, v);
+            EXPECT_EQ(Dst[x + y * DstStride], Ref) << "x=" << x << " y=" << y;
+        }
+    }
+}
+
+TEST(Common_FilteringTools, ResampleTexture2DBilinear)
+{
+    TestResampleTexture2DBilinear<TEXTURE_ADDRESS_CLAMP, true>(float2{0, 0}, float2{1.f / 28.f, 1.f / 22.f});
+    TestResampleTexture2DBilinear<TEXTURE_ADDRESS_CLAMP, false>(float2{-1, -1}, float2{0.7f, 0.6f});
+    TestResampleTexture2DBilinear<TEXTURE_ADDRESS_WRAP, true>(float2{-0.5f, 0.25f}, float2{0.1f, 0.1f});
+    TestResampleTexture2DBilinear<TEXTURE_ADDRESS_MIRROR, false>(float2{20, -5}, float2{-1.5f, 1.25f});
+    TestResampleTexture2DBilinear<TEXTURE_ADDRESS_UNKNOWN, false>(float2{0.5f, 0.5f}, float2{0.45f, 0.45f});
+}
+
 } // namespace
@@ -0,0 +1,214 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "FlatHashMap.hpp"
+
+#include <unordered_map>
+#include <string>
+#include <memory>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_FlatHashMap, Empty)
+{
+    FlatHashMap<int, int> Map;
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.size(), size_t{0});
+    EXPECT_EQ(Map.capacity(), size_t{0});
+    EXPECT_EQ(Map.begin(), Map.end());
+    EXPECT_EQ(Map.find(0), Map.end());
+    EXPECT_EQ(Map.count(0), size_t{0});
+    EXPECT_EQ(Map.erase(0), size_t{0});
+    Map.clear();
+}
+
+TEST(Common_FlatHashMap, InsertFindErase)
+{
+    FlatHashMap<std::string, int> Map;
+
+    auto it_inserted = Map.emplace("One", 1);
+    EXPECT_TRUE(it_inserted.second);
+    EXPECT_EQ(it_inserted.first->first, "One");
+    EXPECT_EQ(it_inserted.first->second, 1);
+
+    // Existing elements are not overwritten
+    it_inserted = Map.emplace("One", 10);
+    EXPECT_FALSE(it_inserted.second);
+    EXPECT_EQ(it_inserted.first->second, 1);
+
+    Map["Two"] = 2;
+    EXPECT_TRUE(Map.insert(std::make_pair(std::string{"Three"}, 3)).second);
+    EXPECT_EQ(Map.size(), size_t{3});
+
+    EXPECT_EQ(Map.find("One")->second, 1);
+    EXPECT_EQ(Map.find("Two")->second, 2);
+    EXPECT_EQ(Map.find("Three")->second, 3);
+    EXPECT_EQ(Map.find("Four"), Map.end());
+    EXPECT_EQ(Map["One"], 1);
+
+    EXPECT_EQ(Map.erase("Two"), size_t{1});
+    EXPECT_EQ(Map.erase("Two"), size_t{0});
+    EXPECT_EQ(Map.find("Two"), Map.end());
+    EXPECT_EQ(Map.size(), size_t{2});
+
+    auto it = Map.erase(Map.find("One"));
+    EXPECT_TRUE(it == Map.end() || it->first == "Three");
+    EXPECT_EQ(Map.size(), size_t{1});
+
+    Map.clear();
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.find("Three"), Map.end());
+}
+
+TEST(Common_FlatHashMap, Move)
+{
+    FlatHashMap<int, std::unique_ptr<int>> Map;
+    for (int i = 0; i < 100; ++i)
+        Map.emplace(i, std::make_unique<int>(i));
+
+    FlatHashMap<int, std::unique_ptr<int>> Map2{std::move(Map)};
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map2.size(), size_t{100});
+    EXPECT_EQ(*Map2.find(50)->second, 50);
+
+    Map = std::move(Map2);
+    EXPECT_TRUE(Map2.empty());
+    EXPECT_EQ(Map.size(), size_t{100});
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(*Map[i], i);
+}
+
+TEST(Common_FlatHashMap, EraseWhileIterating)
+{
+    FlatHashMap<int, int> Map;
+    for (int i = 0; i < 1000; ++i)
+        Map.emplace(i, i);
+
+    for (auto it = Map.begin(); it != Map.end();)
+    {
+        if (it->first % 3 == 0)
+            it = Map.erase(it);
+        else
+            ++it;
+    }
+
+    EXPECT_EQ(Map.size(), size_t{666});
+
+    size_t Count = 0;
+    for (const auto& it : Map)
+    {
+        EXPECT_NE(it.first % 3, 0);
+        EXPECT_EQ(it.first, it.second);
+        ++Count;
+    }
+    EXPECT_EQ(Count, Map.size());
+}
+
+TEST(Common_FlatHashMap, Reserve)
+{
+    FlatHashMap<int, int> Map;
+    Map.reserve(1000);
+    const auto Capacity = Map.capacity();
+    EXPECT_GE(Capacity, size_t{1000});
+    for (int i = 0; i < 1000; ++i)
+        Map.emplace(i, i);
+    EXPECT_EQ(Map.capacity(), Capacity);
+}
+
+// All keys have the same hash
+struct BadHasher
+{
+    size_t operator()(int) const { return 0; }
+};
+
+TEST(Common_FlatHashMap, Collisions)
+{
+    FlatHashMap<int, int, BadHasher> Map;
+    for (int i = 0; i < 100; ++i)
+        Map.emplace(i, -i);
+    for (int i = 0; i < 100; i += 2)
+        Map.erase(i);
+    for (int i = 0; i < 100; ++i)
+    {
+        auto it = Map.find(i);
+        if (i % 2 == 0)
+            EXPECT_EQ(it, Map.end());
+        else
+            EXPECT_EQ(it->second, -i);
+    }
+}
+
+TEST(Common_FlatHashMap, Random)
+{
+    FlatHashMap<Uint32, Uint32>      Map;
+    std::unordered_map<Uint32, Uint32> RefMap;
+
+    FastRandInt Rnd{0, 0, 4095};
+    for (Uint32 i = 0; i < 200000; ++i)
+    {
+        const Uint32 Key = static_cast<Uint32>(Rnd());
+        switch (i % 4)
+        {
+            case 0:
+            case 1:
+                EXPECT_EQ(Map.emplace(Key, i).second, RefMap.emplace(Key, i).second);
+                break;
+
+            case 2:
+                EXPECT_EQ(Map.erase(Key), RefMap.erase(Key));
+                break;
+
+            case 3:
+            {
+                auto it     = Map.find(Key);
+                auto ref_it = RefMap.find(Key);
+                ASSERT_EQ(it == Map.end(), ref_it == RefMap.end());
+                if (it != Map.end())
+                {
+                    EXPECT_EQ(it->second, ref_it->second);
+                }
+                break;
+            }
+        }
+        ASSERT_EQ(Map.size(), RefMap.size());
+    }
+
+    for (const auto& it : Map)
+        EXPECT_EQ(RefMap.at(it.first), it.second);
+
+    // The table must not grow indefinitely because of the deleted elements
+    EXPECT_LE(Map.capacity(), size_t{16384});
+}
+
+} // namespace
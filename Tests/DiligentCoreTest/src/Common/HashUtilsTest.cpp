@@ -570,6 +570,35 @@ TEST(Common_HashUtils, TextureViewDescXXH128Hash)
 }
 
 
+template <template <typename T> class HelperType>
+void TestBufferViewDescHasher()
+{
+    ASSERT_SIZEOF64(BufferViewDesc, 32, "Did you add new members to BufferViewDesc? Please update the tests.");
+    DEFINE_HELPER(BufferViewDesc);
+
+    TEST_RANGE(ViewType, static_cast<BUFFER_VIEW_TYPE>(1), BUFFER_VIEW_NUM_VIEWS);
+    TEST_RANGE(Format.ValueType, static_cast<VALUE_TYPE>(1), VT_NUM_TYPES);
+    TEST_RANGE(Format.NumComponents, Uint8{1}, Uint8{4});
+    TEST_BOOL(Format.IsNormalized);
+    TEST_RANGE(ByteOffset, Uint64{1}, Uint64{1024});
+    TEST_VALUE(ByteOffset, Uint64{1} << 32u);
+    TEST_VALUE(ByteOffset, Uint64{1} << 40u);
+    TEST_RANGE(ByteWidth, Uint64{1}, Uint64{1024});
+    TEST_VALUE(ByteWidth, Uint64{1} << 32u);
+    TEST_VALUE(ByteWidth, Uint64{1} << 40u);
+}
+
+TEST(Common_HashUtils, BufferViewDescStdHash)
+{
+    TestBufferViewDescHasher<StdHasherTestHelper>();
+}
+
+TEST(Common_HashUtils, BufferViewDescXXH128Hash)
+{
+    TestBufferViewDescHasher<XXH128HasherTestHelper>();
+}
+
+
 template <template <typename T> class HelperType>
 void TestSampleDescHasher()
 {
@@ -775,7 +804,7 @@ TEST(Common_HashUtils, ShadingRateAttachmentXXH128Hash)
 template <template <typename T> class HelperType>
 void TestSubpassDescHasher()
 {
-    ASSERT_SIZEOF64(SubpassDesc, 72, "Did you add new members to SubpassDesc? Please update the tests.");
+    ASSERT_SIZEOF64(SubpassDesc, 80, "Did you add new members to SubpassDesc? Please update the tests.");
     DEFINE_HELPER(SubpassDesc);
 
     constexpr AttachmentReference Inputs[] =
@@ -822,6 +851,8 @@ void TestSubpassDescHasher()
 
     constexpr ShadingRateAttachment SRA{{5, RESOURCE_STATE_SHADING_RATE}, 32, 64};
     TEST_VALUE(pShadingRateAttachment, &SRA);
+
+    TEST_FLAGS(ViewMask, 1u, 0x80000000u);
 }
 
 TEST(Common_HashUtils, SubpassDescStdHash)
@@ -1360,4 +1391,75 @@ TEST(Common_HashUtils, VertexPoolElementDescXXH128Hash)
 {
     TestVertexPoolElementDescHasher<XXH128HasherTestHelper>();
 }
+
+
+TEST(Common_HashUtils, ComputeWordsHash)
+{
+    constexpr Uint32 Words[]   = {1, 2, 3, 4, 5};
+    constexpr size_t WordsHash = ComputeWordsHash(Words, 5);
+    static_assert(WordsHash != ComputeWordsHash(Words, 4), "Hashes of different arrays must be different");
+
+    EXPECT_EQ(ComputeWordsHash(Words, 5), WordsHash);
+    EXPECT_NE(ComputeWordsHash(Words, 0), ComputeWordsHash(Words, 1));
+
+    // Zero words must not be ignored
+    constexpr Uint32 Zeros[] = {0, 0, 0};
+    EXPECT_NE(ComputeWordsHash(Zeros, 1), ComputeWordsHash(Zeros, 2));
+    EXPECT_NE(ComputeWordsHash(Zeros, 2), ComputeWordsHash(Zeros, 3));
+
+    std::unordered_set<size_t> Hashes;
+    for (Uint32 i = 0; i < 1024; ++i)
+    {
+        for (Uint32 j = 0; j < 3; ++j)
+        {
+            Uint32 Data[3] = {};
+            Data[j]        = i;
+            Hashes.insert(ComputeWordsHash(Data, 3));
+        }
+    }
+    EXPECT_EQ(Hashes.size(), size_t{1024 * 3 - 2});
+}
+
+TEST(Common_HashUtils, PackedHasherIgnoresName)
+{
+    SamplerDesc Desc1{FILTER_TYPE_LINEAR, FILTER_TYPE_LINEAR, FILTER_TYPE_LINEAR};
+    Desc1.Name = "Sampler 1";
+    SamplerDesc Desc2{Desc1};
+    Desc2.Name = "Sampler 2";
+    EXPECT_EQ(std::hash<SamplerDesc>{}(Desc1), std::hash<SamplerDesc>{}(Desc2));
+
+    TextureViewDesc ViewDesc1;
+    ViewDesc1.Name = "View 1";
+    TextureViewDesc ViewDesc2{ViewDesc1};
+    ViewDesc2.Name = "View 2";
+    EXPECT_EQ(std::hash<TextureViewDesc>{}(ViewDesc1), std::hash<TextureViewDesc>{}(ViewDesc2));
+
+    BufferViewDesc BuffViewDesc1;
+    BuffViewDesc1.Name = "Buffer View 1";
+    BufferViewDesc BuffViewDesc2{BuffViewDesc1};
+    BuffViewDesc2.Name = "Buffer View 2";
+    EXPECT_EQ(std::hash<BufferViewDesc>{}(BuffViewDesc1), std::hash<BufferViewDesc>{}(BuffViewDesc2));
+}
+
+TEST(Common_HashUtils, HashedDesc)
+{
+    SamplerDesc Desc1{FILTER_TYPE_LINEAR, FILTER_TYPE_LINEAR, FILTER_TYPE_LINEAR};
+    SamplerDesc Desc2{FILTER_TYPE_POINT, FILTER_TYPE_POINT, FILTER_TYPE_POINT};
+
+    HashedDesc<SamplerDesc> HashedDesc1{Desc1};
+    HashedDesc<SamplerDesc> HashedDesc2{Desc2};
+    EXPECT_EQ(HashedDesc1.GetHash(), std::hash<SamplerDesc>{}(Desc1));
+    EXPECT_EQ(HashedDesc2.GetHash(), std::hash<SamplerDesc>{}(Desc2));
+    EXPECT_EQ(HashedDesc1.GetDesc(), Desc1);
+    EXPECT_EQ(HashedDesc1, HashedDesc<SamplerDesc>{Desc1});
+    EXPECT_NE(HashedDesc1, HashedDesc2);
+
+    std::unordered_map<HashedDesc<SamplerDesc>, int> Map;
+    Map.emplace(Desc1, 1);
+    Map.emplace(Desc2, 2);
+    EXPECT_EQ(Map.size(), size_t{2});
+    EXPECT_EQ(Map[Desc1], 1);
+    EXPECT_EQ(Map[Desc2], 2);
+}
+
 } // namespace
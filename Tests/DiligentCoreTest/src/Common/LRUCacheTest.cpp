@@ -183,4 +183,127 @@ TEST(Common_LRUCache, Exceptions)
     }
 }
 
+
+TEST(Common_LRUCache, Stats)
+{
+    LRUCache<int, CacheData> Cache{4};
+
+    auto GetData = [&Cache](int Key) {
+        return Cache.Get(Key,
+                         [Key](CacheData& Data, size_t& Size) //
+                         {
+                             Data.Value = static_cast<Uint32>(Key);
+                             Size       = 1;
+                         });
+    };
+
+    for (int Key = 0; Key < 4; ++Key)
+        EXPECT_EQ(GetData(Key).Value, static_cast<Uint32>(Key));
+
+    auto Stats = Cache.GetStats();
+    EXPECT_EQ(Stats.NumHits, 0u);
+    EXPECT_EQ(Stats.NumMisses, 4u);
+    EXPECT_EQ(Stats.NumEvictions, 0u);
+
+    GetData(0);
+    GetData(1);
+    Stats = Cache.GetStats();
+    EXPECT_EQ(Stats.NumHits, 2u);
+    EXPECT_EQ(Stats.NumMisses, 4u);
+
+    // Evicts the least recently used key 2
+    GetData(4);
+    Stats = Cache.GetStats();
+    EXPECT_EQ(Stats.NumMisses, 5u);
+    EXPECT_EQ(Stats.NumEvictions, 1u);
+    EXPECT_EQ(Cache.GetCurrSize(), 4u);
+
+    GetData(2);
+    Stats = Cache.GetStats();
+    EXPECT_EQ(Stats.NumMisses, 6u);
+    EXPECT_EQ(Stats.NumEvictions, 2u);
+
+    // A cache with zero size does not store the data, but still counts the misses
+    Cache.SetMaxSize(0);
+    while (Cache.GetCurrSize() != 0)
+        GetData(5);
+    const size_t NumMisses = Cache.GetStats().NumMisses;
+    GetData(6);
+    GetData(6);
+    EXPECT_EQ(Cache.GetStats().NumMisses, NumMisses + 2);
+}
+
+
+TEST(Common_ShardedLRUCache, Get)
+{
+    constexpr size_t NumShards = 8;
+    constexpr size_t MaxSize   = 64;
+
+    ShardedLRUCache<int, CacheData> Cache{MaxSize, NumShards};
+    EXPECT_EQ(Cache.GetNumShards(), NumShards);
+
+    constexpr Uint32                    NumThreads = 16;
+    constexpr Uint32                    NumKeys    = 256;
+    std::vector<std::thread>            Threads(NumThreads);
+    std::vector<std::vector<CacheData>> ThreadsData(NumThreads);
+
+    Threading::Signal StartSignal;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        ThreadsData[i].resize(NumKeys);
+
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                StartSignal.Wait();
+
+                auto& Data = ThreadsData[ThreadId];
+                for (Uint32 i = 0; i < Data.size(); ++i)
+                {
+                    // Use different key order in every thread
+                    const Uint32 Key = (i * 7 + ThreadId) % NumKeys;
+
+                    Data[Key] = Cache.Get(static_cast<int>(Key),
+                                          [&](CacheData& Data, size_t& Size) //
+                                          {
+                                              Data.Value = Key;
+                                              Size       = 1;
+                                          });
+                }
+            },
+            i);
+    }
+    StartSignal.Trigger(true);
+
+    for (auto& T : Threads)
+        T.join();
+
+    for (auto& Data : ThreadsData)
+    {
+        for (Uint32 i = 0; i < Data.size(); ++i)
+        {
+            EXPECT_EQ(Data[i].Value, i);
+        }
+    }
+
+    EXPECT_LE(Cache.GetCurrSize(), MaxSize);
+
+    size_t        TotalMaxSize = 0;
+    LRUCacheStats ShardStats;
+    for (size_t i = 0; i < NumShards; ++i)
+    {
+        const auto& Shard = Cache.GetShard(i);
+        EXPECT_LE(Shard.GetCurrSize(), Shard.GetMaxSize());
+        TotalMaxSize += Shard.GetMaxSize();
+        ShardStats += Shard.GetStats();
+    }
+    EXPECT_EQ(TotalMaxSize, MaxSize);
+
+    const auto Stats = Cache.GetStats();
+    EXPECT_EQ(Stats.NumHits, ShardStats.NumHits);
+    EXPECT_EQ(Stats.NumMisses, ShardStats.NumMisses);
+    EXPECT_EQ(Stats.NumEvictions, ShardStats.NumEvictions);
+    EXPECT_EQ(Stats.NumHits + Stats.NumMisses, size_t{NumThreads} * NumKeys);
+    EXPECT_GE(Stats.NumMisses, size_t{NumKeys});
+}
+
 } // namespace
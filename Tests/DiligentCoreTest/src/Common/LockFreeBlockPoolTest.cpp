@@ -0,0 +1,131 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "LockFreeBlockPool.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_LockFreeBlockPool, AllocateFree)
+{
+    LockFreeBlockPool Pool{DefaultRawMemoryAllocator::GetAllocator(), 24, 4};
+    EXPECT_EQ(Pool.GetBlockSize(), size_t{24});
+
+    // Allocate enough blocks to span several chunks
+    std::vector<void*> Blocks;
+    for (Uint32 i = 0; i < 100; ++i)
+    {
+        void* pBlock = Pool.Allocate();
+        ASSERT_NE(pBlock, nullptr);
+        EXPECT_EQ(reinterpret_cast<size_t>(pBlock) % alignof(std::max_align_t), size_t{0});
+        std::memset(pBlock, static_cast<int>(i), 24);
+        Blocks.push_back(pBlock);
+    }
+    EXPECT_EQ(Pool.GetNumUsedBlocks(), 100u);
+    EXPECT_EQ(Pool.GetNumCarvedBlocks(), 100u);
+
+    std::vector<void*> SortedBlocks = Blocks;
+    std::sort(SortedBlocks.begin(), SortedBlocks.end());
+    EXPECT_EQ(std::unique(SortedBlocks.begin(), SortedBlocks.end()), SortedBlocks.end());
+
+    for (Uint32 i = 0; i < 100; ++i)
+    {
+        const Uint8* pData = static_cast<const Uint8*>(Blocks[i]);
+        EXPECT_TRUE(std::all_of(pData, pData + 24, [i](Uint8 b) { return b == static_cast<Uint8>(i); }));
+    }
+
+    for (size_t i = 0; i < Blocks.size(); i += 2)
+        Pool.Free(Blocks[i]);
+    EXPECT_EQ(Pool.GetNumUsedBlocks(), 50u);
+
+    // Released blocks must be reused
+    for (size_t i = 0; i < Blocks.size(); i += 2)
+    {
+        Blocks[i] = Pool.Allocate();
+        ASSERT_NE(Blocks[i], nullptr);
+    }
+    EXPECT_EQ(Pool.GetNumCarvedBlocks(), 100u);
+
+    for (void* pBlock : Blocks)
+        Pool.Free(pBlock);
+    EXPECT_EQ(Pool.GetNumUsedBlocks(), 0u);
+}
+
+TEST(Common_LockFreeBlockPool, ThreadContention)
+{
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 2u) * 2;
+
+    LockFreeBlockPool Pool{DefaultRawMemoryAllocator::GetAllocator(), sizeof(Uint64)};
+
+    static constexpr size_t NumThreadIterations = 16384;
+    static constexpr size_t NumLiveBlocks       = 16;
+
+    std::atomic<bool>        Failed{false};
+    std::vector<std::thread> Workers;
+    Workers.reserve(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Workers.emplace_back(
+            [&Pool, &Failed, t] //
+            {
+                Uint64* Blocks[NumLiveBlocks] = {};
+                for (size_t i = 0; i < NumThreadIterations; ++i)
+                {
+                    Uint64*& pBlock = Blocks[i % NumLiveBlocks];
+                    if (pBlock != nullptr)
+                    {
+                        // A block must not be handed out to two threads at the same time
+                        if (*pBlock != (Uint64{t} << 32u) + i - NumLiveBlocks)
+                            Failed.store(true);
+                        Pool.Free(pBlock);
+                    }
+                    pBlock  = static_cast<Uint64*>(Pool.Allocate());
+                    *pBlock = (Uint64{t} << 32u) + i;
+                }
+                for (Uint64* pBlock : Blocks)
+                    Pool.Free(pBlock);
+            });
+    }
+    for (auto& Thread : Workers)
+        Thread.join();
+
+    EXPECT_FALSE(Failed.load());
+    EXPECT_EQ(Pool.GetNumUsedBlocks(), 0u);
+    EXPECT_LE(Pool.GetNumCarvedBlocks(), NumThreads * NumLiveBlocks);
+}
+
+} // namespace
@@ -29,7 +29,10 @@
 #include <sstream>
 
 #include "BasicMath.hpp"
+#include "BasicMathSIMD.hpp"
 #include "AdvancedMath.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
 
 #include "gtest/gtest.h"
 
@@ -1675,6 +1678,81 @@ TEST(Common_BasicMath, MatrixOpeartorMinusEqual)
     // clang-format on
 }
 
+TEST(Common_BasicMath, SIMD)
+{
+    FastRandFloat Rnd{0, -2.f, 2.f};
+
+    auto RandomMatrix = [&Rnd]() {
+        float4x4 Mat;
+        for (int i = 0; i < 16; ++i)
+            Mat.Data()[i] = Rnd();
+        return Mat;
+    };
+
+    auto ExpectNear = [](const float4x4& Mat, const float4x4& Ref, float Epsilon) {
+        for (int i = 0; i < 16; ++i)
+            EXPECT_NEAR(Mat.Data()[i], Ref.Data()[i], Epsilon * std::max(1.f, std::abs(Ref.Data()[i]))) << "Element " << i;
+    };
+
+    constexpr float Epsilon = 1e-5f;
+    for (int test = 0; test < 64; ++test)
+    {
+        const auto M1 = RandomMatrix();
+        const auto M2 = RandomMatrix();
+
+        ExpectNear(MulSIMD(M1, M2), M1 * M2, Epsilon);
+        EXPECT_EQ(TransposeSIMD(M1), M1.Transpose());
+
+        const float4 v{Rnd(), Rnd(), Rnd(), Rnd()};
+        const float4 vRef = v * M1;
+        const float4 vRes = MulSIMD(v, M1);
+        for (int i = 0; i < 4; ++i)
+            EXPECT_NEAR(vRes[i], vRef[i], Epsilon * std::max(1.f, std::abs(vRef[i])));
+
+        if (std::abs(M1.Determinant()) > 1e-2f)
+        {
+            const auto Inv = InverseSIMD(M1);
+            ExpectNear(Inv * M1, float4x4::Identity(), 1e-3f);
+            ExpectNear(Inv, M1.Inverse(), 1e-3f);
+        }
+    }
+
+    {
+        const auto M = float4x4::Translation(1, 2, 3) * float4x4::RotationY(0.5f) * float4x4::Scale(2, 3, 4);
+        ExpectNear(InverseSIMD(M), M.Inverse(), Epsilon);
+    }
+
+    {
+        const auto M = RandomMatrix();
+
+        std::vector<float4> Vectors(37);
+        for (auto& v : Vectors)
+            v = float4{Rnd(), Rnd(), Rnd(), Rnd()};
+
+        std::vector<float4> Transformed(Vectors.size());
+        TransformVectorsSIMD(Vectors.data(), Vectors.size(), M, Transformed.data());
+        for (size_t i = 0; i < Vectors.size(); ++i)
+        {
+            const auto Ref = Vectors[i] * M;
+            for (int c = 0; c < 4; ++c)
+                EXPECT_NEAR(Transformed[i][c], Ref[c], Epsilon * std::max(1.f, std::abs(Ref[c])));
+        }
+
+        std::vector<float4x4> Matrices(13);
+        for (auto& Mat : Matrices)
+            Mat = RandomMatrix();
+
+        std::vector<float4x4> Results(Matrices.size());
+        MulMatricesSIMD(Matrices.data(), Matrices.size(), M, Results.data());
+        for (size_t i = 0; i < Matrices.size(); ++i)
+            ExpectNear(Results[i], Matrices[i] * M, Epsilon);
+
+        // In-place
+        MulMatricesSIMD(Matrices.data(), Matrices.size(), M, Matrices.data());
+        for (size_t i = 0; i < Matrices.size(); ++i)
+            EXPECT_EQ(Matrices[i], Results[i]);
+    }
+}
 
 TEST(Common_AdvancedMath, Planes)
 {
@@ -2904,6 +2982,80 @@ TEST(Common_AdvancedMath, GetOrientedBoxVisibilityAgainstPlane)
     }
 }
 
+TEST(Common_AdvancedMath, GetBoxVisibilityBatch)
+{
+    const auto ViewProj = float4x4::Translation(0.5f, -1.f, 10.f) * float4x4::RotationY(0.3f) * float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 50.f, false);
+
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    constexpr size_t NumBoxes = 10000 + 13;
+
+    std::vector<float> MinX(NumBoxes), MinY(NumBoxes), MinZ(NumBoxes);
+    std::vector<float> MaxX(NumBoxes), MaxY(NumBoxes), MaxZ(NumBoxes);
+    std::vector<BoundBox> RefBoxes(NumBoxes);
+
+    FastRandFloat RndPos{0, -60.f, 60.f};
+    FastRandFloat RndSize{1, 0.f, 10.f};
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const float3 Min{RndPos(), RndPos(), RndPos()};
+        const float3 Max = Min + float3{RndSize(), RndSize(), RndSize()};
+
+        RefBoxes[i] = BoundBox{Min, Max};
+
+        MinX[i] = Min.x;
+        MinY[i] = Min.y;
+        MinZ[i] = Min.z;
+        MaxX[i] = Max.x;
+        MaxY[i] = Max.y;
+        MaxZ[i] = Max.z;
+    }
+
+    BoundBoxSOA Boxes;
+    Boxes.MinX = MinX.data();
+    Boxes.MinY = MinY.data();
+    Boxes.MinZ = MinZ.data();
+    Boxes.MaxX = MaxX.data();
+    Boxes.MaxY = MaxY.data();
+    Boxes.MaxZ = MaxZ.data();
+
+    auto Verify = [&](const std::vector<BoxVisibility>& Visibility, const std::vector<Uint32>& Mask, FRUSTUM_PLANE_FLAGS PlaneFlags) {
+        size_t NumCounts[3] = {};
+        for (size_t i = 0; i < NumBoxes; ++i)
+        {
+            const auto RefVisibility = GetBoxVisibility(Frustum, RefBoxes[i], PlaneFlags);
+            ++NumCounts[static_cast<int>(RefVisibility)];
+            EXPECT_EQ(Visibility[i], RefVisibility) << "Box " << i;
+            EXPECT_EQ((Mask[i / 32] & (1u << (i % 32))) != 0, RefVisibility != BoxVisibility::Invisible) << "Box " << i;
+        }
+        // Unused bits must be cleared
+        EXPECT_EQ(Mask.back() >> (NumBoxes % 32), 0u);
+
+        // Make sure that the test covers all cases
+        EXPECT_GT(NumCounts[static_cast<int>(BoxVisibility::Invisible)], size_t{0});
+        EXPECT_GT(NumCounts[static_cast<int>(BoxVisibility::Intersecting)], size_t{0});
+        EXPECT_GT(NumCounts[static_cast<int>(BoxVisibility::FullyVisible)], size_t{0});
+    };
+
+    for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR})
+    {
+        std::vector<BoxVisibility> Visibility(NumBoxes);
+        std::vector<Uint32>        Mask((NumBoxes + 31) / 32, ~0u);
+        GetBoxVisibilityBatch(Frustum, Boxes, NumBoxes, Visibility.data(), Mask.data(), PlaneFlags);
+        Verify(Visibility, Mask, PlaneFlags);
+    }
+
+    {
+        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+        std::vector<BoxVisibility> Visibility(NumBoxes);
+        std::vector<Uint32>        Mask((NumBoxes + 31) / 32, ~0u);
+        GetBoxVisibilityBatchParallel(pThreadPool, Frustum, Boxes, NumBoxes, Visibility.data(), Mask.data(), FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, 1000);
+        Verify(Visibility, Mask, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+    }
+}
+
 TEST(Common_AdvancedMath, GetPointToBoxDistance)
 {
     BoundBox Box{float3{1, 2, 3}, float3{4, 5, 6}};
@@ -27,6 +27,7 @@
 #include "ParsingTools.hpp"
 
 #include <limits.h>
+#include <deque>
 
 #include "gtest/gtest.h"
 
@@ -392,6 +393,89 @@ sint occaecat //cupidatat non proident.
     EXPECT_EQ(ref_it, Chunks.end());
 }
 
+// Contiguous iterators are scanned in blocks, so compare the results with the
+// deque iterators that use the per-character path at all block offsets.
+TEST(Common_ParsingTools, BlockScanning)
+{
+    // Returns the offset of the comment end, or -1 if the comment is not closed
+    auto SkipCommentOffset = [](auto Begin, auto Pos, auto End) -> ptrdiff_t {
+        try
+        {
+            return SkipComment(Pos, End) - Begin;
+        }
+        catch (const std::pair<decltype(Pos), const char*>&)
+        {
+            return -1;
+        }
+    };
+
+    auto Test = [&](const std::string& Str) {
+        const std::deque<char> Deque{Str.begin(), Str.end()};
+        for (size_t Start = 0; Start < Str.size(); ++Start)
+        {
+            const char* const pStr = Str.c_str();
+            const char* const pEnd = pStr + Str.size();
+            const auto        DqIt = Deque.begin() + Start;
+
+            {
+                const size_t RefPos = SkipLine(DqIt, Deque.end(), true) - Deque.begin();
+                EXPECT_EQ(SkipLine(pStr + Start, pEnd, true) - pStr, static_cast<ptrdiff_t>(RefPos));
+                EXPECT_EQ(SkipLine(Str.begin() + Start, Str.end(), true) - Str.begin(), static_cast<ptrdiff_t>(RefPos));
+            }
+
+            {
+                const size_t RefPos = SkipDelimiters(DqIt, Deque.end()) - Deque.begin();
+                EXPECT_EQ(SkipDelimiters(pStr + Start, pEnd) - pStr, static_cast<ptrdiff_t>(RefPos));
+                EXPECT_EQ(SkipDelimiters(Str.begin() + Start, Str.end()) - Str.begin(), static_cast<ptrdiff_t>(RefPos));
+            }
+
+            {
+                const ptrdiff_t RefPos = SkipCommentOffset(Deque.begin(), DqIt, Deque.end());
+                EXPECT_EQ(SkipCommentOffset(pStr, pStr + Start, pEnd), RefPos);
+                EXPECT_EQ(SkipCommentOffset(Str.begin(), Str.begin() + Start, Str.end()), RefPos);
+            }
+        }
+    };
+
+    Test("");
+    Test("Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+    Test("                                       \t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t           End");
+    Test(" \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\n \r\nEnd");
+    Test("// Single-line comment that is longer than a single block\r\nNext line\nLast line");
+    Test("/* Multi-line comment * with ** asterisks *** that spans \n several \r\n blocks ******/ End");
+    Test("/* Unterminated multi-line comment that is longer than a single block * ** *");
+    Test("/* Comment with an embedded null character");
+    {
+        std::string StrWithNull = "Line with a null character";
+        StrWithNull[16]         = '\0';
+        Test(StrWithNull);
+        StrWithNull = "/* Comment with a null character that is longer than a block */";
+        StrWithNull[40] = '\0';
+        Test(StrWithNull);
+    }
+
+    // Large input that mimics shader source
+    std::string Source;
+    for (int i = 0; i < 64; ++i)
+    {
+        Source += "    float4 Color" + std::to_string(i) + " = Tex.Sample(Sam, UV); // Sample the texture\r\n";
+        Source += "    /* Apply the gamma\n       correction */ Color" + std::to_string(i) + ".rgb = pow(Color.rgb, 2.2);\n\n";
+    }
+    Test(Source);
+
+    size_t NumChunks = 0;
+    SplitString(Source.cbegin(), Source.cend(),
+                [&](std::string::const_iterator, std::string::const_iterator& Pos) //
+                {
+                    Pos = SkipLine(Pos, Source.cend());
+                    ++NumChunks;
+                    return true;
+                });
+    // Every pair of source lines is split into: the statement before the single-line comment,
+    // the statement following the multi-line comment, and the trailing empty chunk.
+    EXPECT_EQ(NumChunks, size_t{64 * 2 + 1});
+}
+
 TEST(Common_ParsingTools, GetContext)
 {
     const std::string TestStr =
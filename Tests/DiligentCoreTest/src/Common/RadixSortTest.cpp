@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RadixSort.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <utility>
+
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+template <typename KeyType>
+void TestRadixSort(size_t Count, KeyType KeyMask)
+{
+    using ItemType = std::pair<KeyType, size_t>;
+
+    FastRand Rnd{static_cast<FastRand::StateType>(Count)};
+
+    std::vector<ItemType> Items(Count);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        KeyType Key = 0;
+        for (size_t b = 0; b < sizeof(KeyType); b += 2)
+            Key |= static_cast<KeyType>(static_cast<KeyType>(Rnd()) << (b * 8));
+        Items[i] = {Key & KeyMask, i};
+    }
+
+    std::vector<ItemType> RefItems = Items;
+    std::stable_sort(RefItems.begin(), RefItems.end(), [](const ItemType& a, const ItemType& b) { return a.first < b.first; });
+
+    std::vector<ItemType> Scratch(Count);
+    RadixSort(Items.data(), Scratch.data(), Count, [](const ItemType& Item) { return Item.first; });
+    EXPECT_EQ(Items, RefItems) << "Count: " << Count;
+
+    // Sorting the sorted array must not change it
+    RadixSort(Items.data(), Scratch.data(), Count, [](const ItemType& Item) { return Item.first; });
+    EXPECT_EQ(Items, RefItems) << "Count: " << Count;
+}
+
+TEST(Common_RadixSort, Uint64)
+{
+    for (size_t Count : {0, 1, 2, 5, 31, 32, 33, 100, 1000, 10000})
+    {
+        TestRadixSort<Uint64>(Count, ~Uint64{0});
+        // Only a few passes are required; duplicate keys test stability
+        TestRadixSort<Uint64>(Count, Uint64{0xF0F});
+        TestRadixSort<Uint64>(Count, Uint64{0xFF} << 48);
+    }
+}
+
+TEST(Common_RadixSort, Uint32)
+{
+    for (size_t Count : {0, 3, 64, 4096})
+    {
+        TestRadixSort<Uint32>(Count, ~Uint32{0});
+        TestRadixSort<Uint32>(Count, Uint32{0x7});
+    }
+}
+
+TEST(Common_RadixSort, AllKeysEqual)
+{
+    TestRadixSort<Uint64>(500, Uint64{0});
+}
+
+} // namespace
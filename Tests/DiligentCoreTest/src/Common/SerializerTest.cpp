@@ -172,4 +172,146 @@ TEST(SerializerTest, SerializerTest)
     }
 }
 
+struct BulkTestStruct
+{
+    Uint32 u32;
+    Uint16 u16;
+    Uint8  u8[2];
+    float  f;
+};
+
+} // namespace
+
+namespace Diligent
+{
+DECL_TRIVIALLY_SERIALIZABLE(BulkTestStruct);
+} // namespace Diligent
+
+namespace
+{
+
+TEST(SerializerTest, BulkArray)
+{
+    auto& RawAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const BulkTestStruct RefStructs[] = {
+        {1, 2, {3, 4}, 5.f},
+        {6, 7, {8, 9}, 10.f},
+        {11, 12, {13, 14}, 15.f},
+    };
+    const Uint32 RefNumStructs = sizeof(RefStructs) / sizeof(RefStructs[0]);
+
+    const Uint16* RefNullArray = nullptr;
+    const Uint32  RefNullCount = 0;
+
+    // Bulk and per-element serialization must produce identical data
+    const auto WriteBulk = [&](auto& Ser) {
+        EXPECT_TRUE(Ser.SerializeArrayBulk(nullptr, RefStructs, RefNumStructs));
+        EXPECT_TRUE(Ser.SerializeArrayRaw(nullptr, RefNullArray, RefNullCount));
+    };
+    const auto WritePerElement = [&](auto& Ser) {
+        EXPECT_TRUE(Ser.SerializeArray(nullptr, RefStructs, RefNumStructs,
+                                       [](auto& Ser, const BulkTestStruct& Elem) { return Ser(Elem); }));
+        EXPECT_TRUE(Ser(RefNullCount));
+    };
+
+    Serializer<SerializerMode::Measure> MSer;
+    WriteBulk(MSer);
+    EXPECT_EQ(MSer.GetSize(), sizeof(Uint32) + sizeof(RefStructs) + sizeof(Uint32));
+
+    auto BulkData = MSer.AllocateData(RawAllocator);
+    {
+        Serializer<SerializerMode::Write> WSer{BulkData};
+        WriteBulk(WSer);
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+
+    auto PerElemData = MSer.AllocateData(RawAllocator);
+    {
+        Serializer<SerializerMode::Write> WSer{PerElemData};
+        WritePerElement(WSer);
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+    EXPECT_TRUE(BulkData == PerElemData);
+
+    DynamicLinearAllocator TmpAllocator{RawAllocator};
+
+    Serializer<SerializerMode::Read> RSer{BulkData};
+
+    const BulkTestStruct* pStructs   = nullptr;
+    Uint32                NumStructs = 0;
+    EXPECT_TRUE(RSer.SerializeArrayRaw(&TmpAllocator, pStructs, NumStructs));
+    ASSERT_EQ(NumStructs, RefNumStructs);
+    EXPECT_EQ(std::memcmp(pStructs, RefStructs, sizeof(RefStructs)), 0);
+
+    const Uint16* pNullArray = nullptr;
+    Uint32        NullCount  = ~0u;
+    EXPECT_TRUE(RSer.SerializeArrayBulk(&TmpAllocator, pNullArray, NullCount));
+    EXPECT_EQ(NullCount, 0u);
+    EXPECT_EQ(pNullArray, nullptr);
+
+    EXPECT_TRUE(RSer.IsEnded());
+}
+
+TEST(SerializerTest, VarInt)
+{
+    auto& RawAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const Uint8  RefU8[]  = {0, 1, 127, 128, 255};
+    const Uint32 RefU32[] = {0, 127, 128, 16383, 16384, 0x12345678u, ~0u};
+    const Uint64 RefU64[] = {0, 300, 0x123456789ABCDEFull, ~0ull};
+
+    const auto WriteData = [&](auto& Ser) {
+        for (const Uint8 Val : RefU8)
+            EXPECT_TRUE(Ser.template SerializeVarInt<Uint8>(Val));
+        for (const Uint32 Val : RefU32)
+            EXPECT_TRUE(Ser.template SerializeVarInt<Uint32>(Val));
+        for (const Uint64 Val : RefU64)
+            EXPECT_TRUE(Ser.template SerializeVarInt<Uint64>(Val));
+    };
+
+    {
+        Serializer<SerializerMode::Measure> MSer;
+        EXPECT_TRUE(MSer.SerializeVarInt<Uint32>(127));
+        EXPECT_EQ(MSer.GetSize(), size_t{1});
+        EXPECT_TRUE(MSer.SerializeVarInt<Uint32>(128));
+        EXPECT_EQ(MSer.GetSize(), size_t{3});
+        EXPECT_TRUE(MSer.SerializeVarInt<Uint32>(~0u));
+        EXPECT_EQ(MSer.GetSize(), size_t{8});
+        EXPECT_TRUE(MSer.SerializeVarInt<Uint64>(~0ull));
+        EXPECT_EQ(MSer.GetSize(), size_t{18});
+    }
+
+    Serializer<SerializerMode::Measure> MSer;
+    WriteData(MSer);
+
+    auto Data = MSer.AllocateData(RawAllocator);
+    {
+        Serializer<SerializerMode::Write> WSer{Data};
+        WriteData(WSer);
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+
+    Serializer<SerializerMode::Read> RSer{Data};
+    for (const Uint8 RefVal : RefU8)
+    {
+        Uint8 Val = 0;
+        EXPECT_TRUE(RSer.SerializeVarInt<Uint8>(Val));
+        EXPECT_EQ(Val, RefVal);
+    }
+    for (const Uint32 RefVal : RefU32)
+    {
+        Uint32 Val = 0;
+        EXPECT_TRUE(RSer.SerializeVarInt<Uint32>(Val));
+        EXPECT_EQ(Val, RefVal);
+    }
+    for (const Uint64 RefVal : RefU64)
+    {
+        Uint64 Val = 0;
+        EXPECT_TRUE(RSer.SerializeVarInt<Uint64>(Val));
+        EXPECT_EQ(Val, RefVal);
+    }
+    EXPECT_TRUE(RSer.IsEnded());
+}
+
 } // namespace
@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderCompilationProfiler.hpp"
+#include "CPUProfiler.hpp"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void Wait(Uint64 Nanoseconds)
+{
+    const Uint64 Start = CPUProfiler::GetTimestamp();
+    while (CPUProfiler::GetTimestamp() - Start < Nanoseconds)
+    {
+    }
+}
+
+class Common_ShaderCompilationProfiler : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ShaderCompilationProfiler::SetEnabled(true);
+        ShaderCompilationProfiler::ResetSummary();
+    }
+
+    void TearDown() override
+    {
+        ShaderCompilationProfiler::SetCallback({});
+        ShaderCompilationProfiler::SetEnabled(false);
+        ShaderCompilationProfiler::ResetSummary();
+    }
+};
+
+TEST_F(Common_ShaderCompilationProfiler, StageTimes)
+{
+    struct Result
+    {
+        std::string              Name;
+        ShaderCompilationTimings Timings;
+    };
+    std::vector<Result> Results;
+    ShaderCompilationProfiler::SetCallback([&](const ShaderCompilationTimings& Timings) {
+        Results.push_back({Timings.Name, Timings});
+    });
+
+    {
+        ShaderCompilationScope Shader{"Test shader", false};
+        {
+            ShaderCompilationStageScope Compile{SHADER_COMPILATION_STAGE_COMPILE};
+            Wait(1000000);
+            {
+                ShaderCompilationStageScope Preprocess{SHADER_COMPILATION_STAGE_PREPROCESS};
+                Wait(2000000);
+            }
+            ShaderCompilationProfiler::AddCacheResult(false);
+        }
+        ShaderCompilationProfiler::AddCacheResult(true);
+        ShaderCompilationProfiler::AddCacheResult(true);
+    }
+
+    ASSERT_EQ(Results.size(), 1u);
+    const ShaderCompilationTimings& Timings = Results[0].Timings;
+    EXPECT_EQ(Results[0].Name, "Test shader");
+    EXPECT_FALSE(Timings.IsPipeline);
+    EXPECT_EQ(Timings.CacheHits, 2u);
+    EXPECT_EQ(Timings.CacheMisses, 1u);
+
+    // The time of the nested stage is not counted in the compile stage
+    EXPECT_GE(Timings.StageTimes[SHADER_COMPILATION_STAGE_PREPROCESS], 0.002);
+    EXPECT_GE(Timings.StageTimes[SHADER_COMPILATION_STAGE_COMPILE], 0.001);
+    EXPECT_LT(Timings.StageTimes[SHADER_COMPILATION_STAGE_COMPILE], Timings.StageTimes[SHADER_COMPILATION_STAGE_PREPROCESS] + 0.001);
+    EXPECT_EQ(Timings.StageTimes[SHADER_COMPILATION_STAGE_OPTIMIZE], 0);
+    EXPECT_GE(Timings.TotalTime, Timings.StageTimes[SHADER_COMPILATION_STAGE_PREPROCESS] + Timings.StageTimes[SHADER_COMPILATION_STAGE_COMPILE]);
+}
+
+TEST_F(Common_ShaderCompilationProfiler, NestedObjects)
+{
+    std::vector<std::string> Names;
+    ShaderCompilationProfiler::SetCallback([&](const ShaderCompilationTimings& Timings) {
+        Names.emplace_back(Timings.Name);
+    });
+
+    {
+        ShaderCompilationScope Pipeline{"Test pipeline", true};
+        {
+            ShaderCompilationScope Shader{"Test shader", false};
+            ShaderCompilationStageScope Reflection{SHADER_COMPILATION_STAGE_REFLECTION};
+            Wait(1000000);
+        }
+        ShaderCompilationStageScope DriverCompile{SHADER_COMPILATION_STAGE_DRIVER_COMPILE};
+        Wait(1000000);
+    }
+
+    ASSERT_EQ(Names.size(), 2u);
+    EXPECT_EQ(Names[0], "Test shader");
+    EXPECT_EQ(Names[1], "Test pipeline");
+
+    const ShaderCompilationSummary Summary = ShaderCompilationProfiler::GetSummary();
+    EXPECT_EQ(Summary.Shaders.Count, 1u);
+    EXPECT_EQ(Summary.Pipelines.Count, 1u);
+    EXPECT_EQ(Summary.Pipelines.SlowestName, "Test pipeline");
+    // Stages are attributed to the innermost object
+    EXPECT_GE(Summary.Shaders.StageTimes[SHADER_COMPILATION_STAGE_REFLECTION], 0.001);
+    EXPECT_EQ(Summary.Pipelines.StageTimes[SHADER_COMPILATION_STAGE_REFLECTION], 0);
+    EXPECT_GE(Summary.Pipelines.StageTimes[SHADER_COMPILATION_STAGE_DRIVER_COMPILE], 0.001);
+    EXPECT_GE(Summary.Pipelines.TotalTime, Summary.Shaders.TotalTime);
+
+    const std::string Str = ShaderCompilationProfiler::GetSummaryString();
+    EXPECT_NE(Str.find("Driver compile"), std::string::npos);
+    EXPECT_NE(Str.find("Slowest pipeline: 'Test pipeline'"), std::string::npos);
+
+    ShaderCompilationProfiler::ResetSummary();
+    EXPECT_EQ(ShaderCompilationProfiler::GetSummary().Shaders.Count, 0u);
+}
+
+TEST_F(Common_ShaderCompilationProfiler, Disabled)
+{
+    ShaderCompilationProfiler::SetEnabled(false);
+
+    Uint32 NumCalls = 0;
+    ShaderCompilationProfiler::SetCallback([&](const ShaderCompilationTimings&) { ++NumCalls; });
+    {
+        ShaderCompilationScope      Shader{"Test shader", false};
+        ShaderCompilationStageScope Compile{SHADER_COMPILATION_STAGE_COMPILE};
+    }
+    // Stages outside of an object scope are ignored
+    ShaderCompilationProfiler::SetEnabled(true);
+    {
+        ShaderCompilationStageScope Compile{SHADER_COMPILATION_STAGE_COMPILE};
+        ShaderCompilationProfiler::AddCacheResult(true);
+    }
+
+    EXPECT_EQ(NumCalls, 0u);
+    EXPECT_EQ(ShaderCompilationProfiler::GetSummary().Shaders.Count, 0u);
+}
+
+} // namespace
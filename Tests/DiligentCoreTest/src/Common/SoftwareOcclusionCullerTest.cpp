@@ -0,0 +1,246 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "SoftwareOcclusionCuller.hpp"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr Uint32 TestSize = 64;
+
+// Returns the NDC coordinate that maps to the given integer screen-space coordinate
+float ScreenToNDC(int x)
+{
+    return (2.f * static_cast<float>(x) + 1.f) / static_cast<float>(TestSize) - 1.f;
+}
+
+float3 ScreenToNDC(int x, int y, float z)
+{
+    return float3{ScreenToNDC(x), -ScreenToNDC(y), z};
+}
+
+TEST(Common_SoftwareOcclusionCuller, CoverageMatchesRasterizeTriangle)
+{
+    const int2 Triangles[][3] = {
+        {{1, 1}, {1, 30}, {30, 1}},
+        {{1, 1}, {30, 1}, {1, 30}},
+        {{5, 3}, {60, 17}, {22, 58}},
+        {{40, 2}, {63, 63}, {0, 45}},
+        {{10, 10}, {11, 40}, {12, 11}},
+        {{-20, 30}, {32, 100}, {90, -10}},
+    };
+
+    SoftwareOcclusionCuller::CreateInfo CI;
+    CI.Width  = TestSize;
+    CI.Height = TestSize;
+    SoftwareOcclusionCuller Culler{CI};
+
+    for (const auto& Tri : Triangles)
+    {
+        Culler.BeginFrame(float4x4::Identity(), false);
+
+        const float3 Verts[] = {
+            ScreenToNDC(Tri[0].x, Tri[0].y, 0.5f),
+            ScreenToNDC(Tri[1].x, Tri[1].y, 0.5f),
+            ScreenToNDC(Tri[2].x, Tri[2].y, 0.5f),
+        };
+        const Uint32 Indices[] = {0, 1, 2};
+        Culler.AddOccluder(Verts, 3, Indices, 3);
+        Culler.RasterizeOccluders();
+        EXPECT_EQ(Culler.GetNumTriangles(), size_t{1});
+
+        std::set<std::pair<int, int>> RefPixels;
+        RasterizeTriangle(Tri[0].Recast<float>(), Tri[1].Recast<float>(), Tri[2].Recast<float>(),
+                          [&](const int2& Pixel) {
+                              if (Pixel.x >= 0 && Pixel.y >= 0 && Pixel.x < static_cast<int>(TestSize) && Pixel.y < static_cast<int>(TestSize))
+                                  RefPixels.emplace(Pixel.x, Pixel.y);
+                          });
+
+        const float* pDepth = Culler.GetDepthData();
+        for (int y = 0; y < static_cast<int>(TestSize); ++y)
+        {
+            for (int x = 0; x < static_cast<int>(TestSize); ++x)
+            {
+                const bool  IsCovered = RefPixels.find({x, y}) != RefPixels.end();
+                const float Depth     = pDepth[y * TestSize + x];
+                EXPECT_EQ(Depth, IsCovered ? 0.5f : 1.f) << "x: " << x << " y: " << y;
+            }
+        }
+    }
+}
+
+void AddQuad(SoftwareOcclusionCuller& Culler, float MinX, float MinY, float MaxX, float MaxY, float Z)
+{
+    const float3 Verts[] = {
+        {MinX, MinY, Z},
+        {MinX, MaxY, Z},
+        {MaxX, MaxY, Z},
+        {MaxX, MinY, Z},
+    };
+    const Uint32 Indices[] = {0, 1, 2, 0, 2, 3};
+    Culler.AddOccluder(Verts, 4, Indices, 6);
+}
+
+TEST(Common_SoftwareOcclusionCuller, BoxVisibility)
+{
+    SoftwareOcclusionCuller::CreateInfo CI;
+    CI.Width  = TestSize;
+    CI.Height = TestSize;
+    SoftwareOcclusionCuller Culler{CI};
+
+    for (bool IsOpenGL : {false, true})
+    {
+        // Map z from [0, 1] to [-1, 1] for OpenGL
+        auto Z = [IsOpenGL](float z) { return IsOpenGL ? z * 2.f - 1.f : z; };
+
+        Culler.BeginFrame(float4x4::Identity(), IsOpenGL);
+
+        // No occluders
+        EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{-0.1f, -0.1f, Z(0.5f)}, float3{0.1f, 0.1f, Z(0.6f)}}));
+
+        AddQuad(Culler, -0.5f, -0.5f, 0.5f, 0.5f, Z(0.2f));
+        Culler.RasterizeOccluders();
+        EXPECT_EQ(Culler.GetNumTriangles(), size_t{2});
+
+        // Behind the occluder
+        EXPECT_FALSE(Culler.IsBoxVisible(BoundBox{float3{-0.2f, -0.2f, Z(0.5f)}, float3{0.2f, 0.2f, Z(0.6f)}}));
+        // In front of the occluder
+        EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{-0.2f, -0.2f, Z(0.1f)}, float3{0.2f, 0.2f, Z(0.15f)}}));
+        // Intersects the occluder
+        EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{-0.2f, -0.2f, Z(0.1f)}, float3{0.2f, 0.2f, Z(0.3f)}}));
+        // Partially outside of the occluder
+        EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{0.3f, 0.3f, Z(0.5f)}, float3{0.7f, 0.7f, Z(0.6f)}}));
+        // Outside of the viewport
+        EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{2.f, 2.f, Z(0.5f)}, float3{3.f, 3.f, Z(0.6f)}}));
+        // In front of the near plane
+        EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{-0.2f, -0.2f, Z(0.5f) - 2.f}, float3{0.2f, 0.2f, Z(0.6f)}}));
+    }
+}
+
+TEST(Common_SoftwareOcclusionCuller, PerspectiveProjection)
+{
+    SoftwareOcclusionCuller::CreateInfo CI;
+    CI.Width  = 128;
+    CI.Height = 64;
+    SoftwareOcclusionCuller Culler{CI};
+
+    const float4x4 ViewProj = float4x4::Projection(PI_F / 2.f, 2.f, 1.f, 100.f, false);
+    Culler.BeginFrame(ViewProj, false);
+
+    // Wall at z = 10
+    AddQuad(Culler, -5, -5, 5, 5, 10);
+    Culler.RasterizeOccluders();
+
+    EXPECT_FALSE(Culler.IsBoxVisible(BoundBox{float3{-1, -1, 20}, float3{1, 1, 22}}));
+    EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{-1, -1, 5}, float3{1, 1, 7}}));
+    EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{8, -1, 20}, float3{10, 1, 22}}));
+    // Box that crosses the near plane
+    EXPECT_TRUE(Culler.IsBoxVisible(BoundBox{float3{-1, -1, -1}, float3{1, 1, 22}}));
+
+    // Occluders that cross the near plane are skipped
+    Culler.BeginFrame(ViewProj, false);
+    AddQuad(Culler, -5, -5, 5, 5, 0.5f);
+    EXPECT_EQ(Culler.GetNumTriangles(), size_t{0});
+}
+
+TEST(Common_SoftwareOcclusionCuller, Parallel)
+{
+    FastRandFloat Rnd{0, -1.f, 1.f};
+
+    std::vector<float3> Verts;
+    std::vector<Uint32> Indices;
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        const float3 Center{Rnd(), Rnd(), Rnd() * 0.5f + 0.5f};
+        const float  Size = std::abs(Rnd()) * 0.25f;
+        for (Uint32 v = 0; v < 3; ++v)
+        {
+            Indices.push_back(static_cast<Uint32>(Verts.size()));
+            Verts.push_back(Center + float3{Rnd(), Rnd(), 0} * Size);
+        }
+    }
+
+    std::vector<BoundBox> Boxes(1000);
+    for (BoundBox& Box : Boxes)
+    {
+        const float3 Center{Rnd(), Rnd(), Rnd() * 0.5f + 0.5f};
+        const float3 Extent = float3{std::abs(Rnd()), std::abs(Rnd()), std::abs(Rnd())} * 0.1f;
+        Box.Min             = Center - Extent;
+        Box.Max             = Center + Extent;
+    }
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    SoftwareOcclusionCuller::CreateInfo CI;
+    CI.Width        = 256;
+    CI.Height       = 128;
+    CI.TilesPerTask = 8;
+    CI.BoxesPerTask = 64;
+    SoftwareOcclusionCuller SerialCuller{CI};
+    CI.pThreadPool = pThreadPool;
+    SoftwareOcclusionCuller ParallelCuller{CI};
+
+    std::vector<Uint32> SerialMask((Boxes.size() + 31) / 32);
+    std::vector<Uint32> ParallelMask(SerialMask.size());
+    for (SoftwareOcclusionCuller* pCuller : {&SerialCuller, &ParallelCuller})
+    {
+        pCuller->BeginFrame(float4x4::Identity(), false);
+        pCuller->AddOccluder(Verts.data(), static_cast<Uint32>(Verts.size()), Indices.data(), static_cast<Uint32>(Indices.size()));
+        pCuller->RasterizeOccluders();
+        pCuller->TestBoxes(Boxes.data(), Boxes.size(), pCuller == &SerialCuller ? SerialMask.data() : ParallelMask.data());
+    }
+
+    const size_t NumPixels = size_t{SerialCuller.GetWidth()} * SerialCuller.GetHeight();
+    for (size_t i = 0; i < NumPixels; ++i)
+        ASSERT_EQ(SerialCuller.GetDepthData()[i], ParallelCuller.GetDepthData()[i]) << "Pixel " << i;
+
+    size_t NumOccluded = 0;
+    for (size_t i = 0; i < Boxes.size(); ++i)
+    {
+        const bool IsVisible = (SerialMask[i / 32] & (1u << (i % 32))) != 0;
+        EXPECT_EQ(IsVisible, SerialCuller.IsBoxVisible(Boxes[i])) << "Box " << i;
+        EXPECT_EQ(IsVisible, (ParallelMask[i / 32] & (1u << (i % 32))) != 0) << "Box " << i;
+        if (!IsVisible)
+            ++NumOccluded;
+    }
+    EXPECT_GT(NumOccluded, size_t{0});
+    EXPECT_LT(NumOccluded, Boxes.size());
+}
+
+} // namespace
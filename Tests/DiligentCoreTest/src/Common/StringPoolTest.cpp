@@ -0,0 +1,131 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "StringPool.hpp"
+
+#include <string>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_InternedStringPool, Intern)
+{
+    InternedStringPool Pool;
+
+    EXPECT_FALSE(Pool.Intern(nullptr));
+    EXPECT_EQ(Pool.GetNumStrings(), size_t{0});
+
+    std::string Name1{"g_Texture"};
+    std::string Name2{"g_Sampler"};
+
+    const InternedString Str1 = Pool.Intern(Name1);
+    const InternedString Str2 = Pool.Intern(Name2.c_str());
+    ASSERT_TRUE(Str1);
+    ASSERT_TRUE(Str2);
+    EXPECT_NE(Str1.GetStr(), Name1.c_str());
+    EXPECT_STREQ(Str1.GetStr(), "g_Texture");
+    EXPECT_STREQ(Str2.GetStr(), "g_Sampler");
+    EXPECT_NE(Str1, Str2);
+    EXPECT_EQ(Str1.GetHash(), CStringHash<Char>{}("g_Texture"));
+
+    // Interning the same string again must return the same handle
+    const InternedString Str1Dup = Pool.Intern(std::string{"g_"} + "Texture");
+    EXPECT_EQ(Str1Dup, Str1);
+    EXPECT_EQ(Str1Dup.GetStr(), Str1.GetStr());
+    EXPECT_EQ(Pool.GetNumStrings(), size_t{2});
+
+    EXPECT_EQ(Pool.Find("g_Sampler"), Str2);
+    EXPECT_FALSE(Pool.Find("g_Buffer"));
+    EXPECT_FALSE(Pool.Find(nullptr));
+
+    const InternedString Empty = Pool.Intern("");
+    ASSERT_TRUE(Empty);
+    EXPECT_STREQ(Empty.GetStr(), "");
+    EXPECT_EQ(Pool.Intern(""), Empty);
+
+    // Handles must remain valid after the pool is moved
+    InternedStringPool Pool2{std::move(Pool)};
+    EXPECT_STREQ(Str1.GetStr(), "g_Texture");
+    EXPECT_EQ(Pool2.Intern("g_Texture"), Str1);
+    EXPECT_EQ(Pool2.GetNumStrings(), size_t{3});
+
+    Pool2.Clear();
+    EXPECT_EQ(Pool2.GetNumStrings(), size_t{0});
+    EXPECT_FALSE(Pool2.Find("g_Texture"));
+}
+
+TEST(Common_InternedStringPool, ManyStrings)
+{
+    // Use small pages to test strings that span several pages and strings larger than a page
+    InternedStringPool Pool{DefaultRawMemoryAllocator::GetAllocator(), 64};
+
+    std::vector<InternedString> Handles;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string Name = "Resource" + std::to_string(i);
+        if (i % 100 == 0)
+            Name += std::string(100, 'x');
+        Handles.push_back(Pool.Intern(Name));
+    }
+    EXPECT_EQ(Pool.GetNumStrings(), size_t{1000});
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string Name = "Resource" + std::to_string(i);
+        if (i % 100 == 0)
+            Name += std::string(100, 'x');
+        EXPECT_STREQ(Handles[i].GetStr(), Name.c_str());
+        EXPECT_EQ(Pool.Intern(Name), Handles[i]);
+    }
+    EXPECT_EQ(Pool.GetNumStrings(), size_t{1000});
+}
+
+TEST(Common_InternedStringPool, HashMapStringKey)
+{
+    InternedStringPool Pool;
+
+    std::unordered_map<HashMapStringKey, int, HashMapStringKey::Hasher> Map;
+    Map.emplace(Pool.Intern("Var1").GetKey(), 1);
+    Map.emplace(Pool.Intern("Var2").GetKey(), 2);
+
+    // Keys made from handles must be interchangeable with the keys made from raw strings
+    EXPECT_EQ(Map.find("Var1")->second, 1);
+    EXPECT_EQ(Map.find("Var2")->second, 2);
+    EXPECT_EQ(Map.find(Pool.Intern("Var2").GetKey())->second, 2);
+    EXPECT_EQ(Map.find("Var3"), Map.end());
+
+    const HashMapStringKey Key = Pool.Intern("Var1").GetKey();
+    EXPECT_EQ(Key.GetHash(), HashMapStringKey{"Var1"}.GetHash());
+    EXPECT_TRUE(Key == HashMapStringKey{"Var1"});
+}
+
+} // namespace
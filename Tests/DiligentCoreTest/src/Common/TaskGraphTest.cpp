@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TaskGraph.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_TaskGraph, Chain)
+{
+    for (Uint32 NumThreads : {1, 4})
+    {
+        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+        ASSERT_NE(pThreadPool, nullptr);
+
+        constexpr Uint32 NumTasks = 64;
+
+        std::vector<std::atomic<bool>> TaskComplete(NumTasks);
+        std::atomic<Uint32>            NumTasksCorrectlyOrdered{0};
+        std::atomic<Uint32>            NumRuns{0};
+
+        TaskGraph Graph{pThreadPool};
+        for (Uint32 task = 0; task < NumTasks; ++task)
+        {
+            const Uint32 Idx = Graph.AddAsyncWork(
+                [task, &TaskComplete, &NumTasksCorrectlyOrdered, &NumRuns](Uint32 ThreadId) //
+                {
+                    NumRuns.fetch_add(1);
+                    if (task == 0 || TaskComplete[task - 1].load())
+                        NumTasksCorrectlyOrdered.fetch_add(1);
+                    TaskComplete[task].store(true);
+                    return ASYNC_TASK_STATUS_COMPLETE;
+                });
+            EXPECT_EQ(Idx, task);
+            if (task > 0)
+                Graph.AddDependency(task, task - 1);
+        }
+        EXPECT_EQ(Graph.GetTaskCount(), NumTasks);
+        EXPECT_FALSE(Graph.IsFinished());
+
+        Graph.Execute();
+        Graph.WaitForCompletion();
+        EXPECT_TRUE(Graph.IsFinished());
+
+        // Every task must run exactly once
+        EXPECT_EQ(NumRuns.load(), NumTasks);
+        EXPECT_EQ(NumTasksCorrectlyOrdered.load(), NumTasks);
+        for (Uint32 task = 0; task < NumTasks; ++task)
+            EXPECT_EQ(Graph.GetTask(task)->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    }
+}
+
+TEST(Common_TaskGraph, Diamond)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{8});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    constexpr Uint32 NumLayers     = 8;
+    constexpr Uint32 TasksPerLayer = 16;
+
+    std::vector<std::atomic<Uint32>> LayerCompleteCount(NumLayers);
+    std::atomic<Uint32>              NumOrderViolations{0};
+
+    TaskGraph Graph{pThreadPool};
+
+    std::vector<Uint32> PrevLayer;
+    for (Uint32 layer = 0; layer < NumLayers; ++layer)
+    {
+        std::vector<Uint32> Layer;
+        for (Uint32 i = 0; i < TasksPerLayer; ++i)
+        {
+            const Uint32 Idx = Graph.AddAsyncWork(
+                [layer, &LayerCompleteCount, &NumOrderViolations](Uint32 ThreadId) //
+                {
+                    if (layer > 0 && LayerCompleteCount[layer - 1].load() != TasksPerLayer)
+                        NumOrderViolations.fetch_add(1);
+                    LayerCompleteCount[layer].fetch_add(1);
+                    return ASYNC_TASK_STATUS_COMPLETE;
+                });
+            // Every task depends on all tasks in the previous layer
+            for (Uint32 Prereq : PrevLayer)
+                Graph.AddDependency(Idx, Prereq);
+            Layer.push_back(Idx);
+        }
+        PrevLayer = std::move(Layer);
+    }
+
+    Graph.Execute();
+    Graph.WaitForCompletion();
+
+    EXPECT_EQ(NumOrderViolations.load(), 0u);
+    for (Uint32 layer = 0; layer < NumLayers; ++layer)
+        EXPECT_EQ(LayerCompleteCount[layer].load(), TasksPerLayer);
+}
+
+TEST(Common_TaskGraph, ReRunAndDestroy)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::atomic<int>  ReRunCounter{8};
+    std::atomic<bool> DependentComplete{false};
+    {
+        TaskGraph Graph{pThreadPool};
+
+        const Uint32 Task0 = Graph.AddAsyncWork(
+            [&ReRunCounter](Uint32 ThreadId) //
+            {
+                return ReRunCounter.fetch_add(-1) - 1 > 0 ? ASYNC_TASK_STATUS_NOT_STARTED : ASYNC_TASK_STATUS_COMPLETE;
+            });
+        const Uint32 Task1 = Graph.AddAsyncWork(
+            [&ReRunCounter, &DependentComplete](Uint32 ThreadId) //
+            {
+                EXPECT_EQ(ReRunCounter.load(), 0);
+                DependentComplete.store(true);
+                return ASYNC_TASK_STATUS_COMPLETE;
+            });
+        Graph.AddDependency(Task1, Task0);
+        Graph.Execute();
+        // The graph is destroyed while the tasks may still be running
+    }
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(ReRunCounter.load(), 0);
+    EXPECT_TRUE(DependentComplete.load());
+
+    {
+        // The graph that was never executed must not leak
+        TaskGraph Graph{pThreadPool};
+        Graph.AddAsyncWork([](Uint32) { return ASYNC_TASK_STATUS_COMPLETE; });
+    }
+
+    {
+        TaskGraph Graph{pThreadPool};
+        Graph.Execute();
+        EXPECT_TRUE(Graph.IsFinished());
+        Graph.WaitForCompletion();
+    }
+}
+
+} // namespace
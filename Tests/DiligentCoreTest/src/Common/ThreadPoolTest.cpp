@@ -32,6 +32,7 @@
 #include <cmath>
 
 #include "ThreadSignal.hpp"
+#include "PlatformMisc.hpp"
 
 
 using namespace Diligent;
@@ -442,4 +443,320 @@ TEST(Common_ThreadPool, ReRunTasks)
         EXPECT_EQ(ReRunCounters[i], 0) << i;
 }
 
+
+TEST(Common_ThreadPool, WorkStealing_EnqueueTask)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumTasks   = 256;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = true;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::array<std::atomic<bool>, NumTasks> WorkComplete{};
+    std::atomic<Uint32>                     NumNestedTasksComplete{0};
+    for (size_t i = 0; i < NumTasks; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [i, &WorkComplete, &NumNestedTasksComplete, &ThreadPool = *pThreadPool](Uint32 ThreadId) //
+                         {
+                             // Enqueue a nested task from the worker thread
+                             EnqueueAsyncWork(&ThreadPool,
+                                              [&NumNestedTasksComplete](Uint32 ThreadId) //
+                                              {
+                                                  NumNestedTasksComplete.fetch_add(1);
+                                                  return ASYNC_TASK_STATUS_COMPLETE;
+                                              });
+
+                             WorkComplete[i].store(true);
+                             return ASYNC_TASK_STATUS_COMPLETE;
+                         },
+                         static_cast<float>(i % 4));
+    }
+
+    pThreadPool->WaitForAllTasks();
+
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    EXPECT_EQ(pThreadPool->GetRunningTaskCount(), 0u);
+    EXPECT_EQ(NumNestedTasksComplete.load(), NumTasks);
+    for (size_t i = 0; i < NumTasks; ++i)
+        EXPECT_TRUE(WorkComplete[i]) << "i=" << i;
+}
+
+
+TEST(Common_ThreadPool, WorkStealing_Priorities)
+{
+    ThreadPoolCreateInfo PoolCI{1};
+    PoolCI.EnableWorkStealing = true;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal       Signal;
+    RefCntAutoPtr<WaitTask> pWaitTask;
+    {
+        pWaitTask = MakeNewRCObj<WaitTask>()(Signal);
+        pThreadPool->EnqueueTask(pWaitTask);
+    }
+    pWaitTask->WaitUntilRunning();
+
+    constexpr Uint32 NumTasks = 8;
+
+    std::vector<int> CompletionOrder;
+    CompletionOrder.reserve(NumTasks);
+    std::array<RefCntAutoPtr<IAsyncTask>, NumTasks> Tasks;
+    for (Uint32 i = 0; i < NumTasks; ++i)
+    {
+        Tasks[i] =
+            EnqueueAsyncWork(pThreadPool,
+                             [&CompletionOrder, i](Uint32 ThreadId) //
+                             {
+                                 CompletionOrder.push_back(i);
+                                 return ASYNC_TASK_STATUS_COMPLETE;
+                             });
+    }
+
+    Tasks[0]->SetPriority(10);
+    Tasks[1]->SetPriority(10);
+    EXPECT_TRUE(pThreadPool->ReprioritizeTask(Tasks[1]));
+    EXPECT_TRUE(pThreadPool->ReprioritizeTask(Tasks[0]));
+
+    Tasks[4]->SetPriority(100);
+    Tasks[5]->SetPriority(100);
+    Tasks[7]->SetPriority(101);
+    pThreadPool->ReprioritizeAllTasks();
+
+    EXPECT_TRUE(pThreadPool->RemoveTask(Tasks[3]));
+    EXPECT_EQ(pThreadPool->GetQueueSize(), NumTasks - 1);
+
+    Signal.Trigger(true, 1);
+
+    pThreadPool->WaitForAllTasks();
+
+    // With a single queue, the order is the same as with the default scheduler
+    const std::vector<int> ExpectedOrder = {7, 4, 5, 1, 0, 2, 6};
+    ASSERT_EQ(ExpectedOrder.size(), CompletionOrder.size());
+    for (size_t i = 0; i < ExpectedOrder.size(); ++i)
+        EXPECT_EQ(ExpectedOrder[i], CompletionOrder[i]) << "i=" << i;
+}
+
+
+TEST(Common_ThreadPool, WorkStealing_Prerequisites)
+{
+    for (Uint32 NumThreads : {1, 8})
+    {
+        ThreadPoolCreateInfo PoolCI{NumThreads};
+        PoolCI.EnableWorkStealing = true;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
+        ASSERT_NE(pThreadPool, nullptr);
+
+        constexpr Uint32               NumTasks = 16;
+        std::vector<std::atomic<bool>> TaskComplete(NumTasks);
+
+        std::atomic<Uint32> NumTasksCorrectlyOrdered{0};
+        {
+            std::vector<RefCntAutoPtr<IAsyncTask>> spTasks(NumTasks);
+            for (Uint32 task = 0; task < NumTasks; ++task)
+            {
+                IAsyncTask* pPrereq = task > 0 ? spTasks[task - 1].RawPtr() : nullptr;
+
+                spTasks[task] =
+                    EnqueueAsyncWork(
+                        pThreadPool,
+                        task > 0 ? &pPrereq : nullptr,
+                        task > 0 ? 1 : 0,
+                        [task, &TaskComplete, &NumTasksCorrectlyOrdered](Uint32 ThreadId) //
+                        {
+                            TaskComplete[task].store(true);
+                            if (task == 0 || TaskComplete[task - 1].load())
+                                NumTasksCorrectlyOrdered.fetch_add(1);
+                            return ASYNC_TASK_STATUS_COMPLETE;
+                        },
+                        static_cast<float>(task));
+            }
+        }
+        pThreadPool->WaitForAllTasks();
+        EXPECT_EQ(NumTasksCorrectlyOrdered.load(), NumTasks);
+    }
+}
+
+
+TEST(Common_ThreadPool, WorkStealing_ProcessTask)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr Uint32 NumTasks   = 64;
+
+    ThreadPoolCreateInfo PoolCI{0};
+    PoolCI.EnableWorkStealing = true;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::vector<std::thread> WorkerThreads(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        WorkerThreads[i] = std::thread{
+            [&ThreadPool = *pThreadPool, i] //
+            {
+                while (ThreadPool.ProcessTask(i, true))
+                {
+                }
+            }};
+    }
+
+    std::vector<std::atomic<int>> ReRunCounters(NumTasks);
+    for (Uint32 task = 0; task < NumTasks; ++task)
+    {
+        ReRunCounters[task] = 4;
+        EnqueueAsyncWork(
+            pThreadPool,
+            [task, &ReRunCounters](Uint32 ThreadId) //
+            {
+                int ReRunCounter = ReRunCounters[task].fetch_add(-1) - 1;
+                return ReRunCounter > 0 ? ASYNC_TASK_STATUS_NOT_STARTED : ASYNC_TASK_STATUS_COMPLETE;
+            });
+    }
+
+    pThreadPool->WaitForAllTasks();
+    for (size_t i = 0; i < ReRunCounters.size(); ++i)
+        EXPECT_EQ(ReRunCounters[i], 0) << i;
+
+    pThreadPool->StopThreads();
+    for (auto& Thread : WorkerThreads)
+    {
+        Thread.join();
+    }
+}
+
+
+TEST(Common_ThreadPool, WaitWithTimeout)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal Signal;
+
+    RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+    pThreadPool->EnqueueTask(pWaitTask);
+    pWaitTask->WaitUntilRunning();
+
+    EXPECT_FALSE(pWaitTask->WaitForCompletionWithTimeout(0));
+    EXPECT_FALSE(pWaitTask->WaitForCompletionWithTimeout(10));
+
+    Signal.Trigger(true, 1);
+    EXPECT_TRUE(pWaitTask->WaitForCompletionWithTimeout(AsyncTaskBase::InfiniteTimeout));
+    EXPECT_TRUE(pWaitTask->WaitForCompletionWithTimeout(0));
+    pWaitTask->WaitForCompletion();
+
+    pThreadPool->WaitForAllTasks();
+}
+
+
+TEST(Common_ThreadPool, WaitForTasks)
+{
+    constexpr Uint32 NumThreads = 4;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal Signal;
+
+    RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+    pThreadPool->EnqueueTask(pWaitTask);
+
+    std::atomic<bool>         Proceed{false};
+    RefCntAutoPtr<IAsyncTask> pSpinTask =
+        EnqueueAsyncWork(pThreadPool,
+                         [&Proceed](Uint32 ThreadId) //
+                         {
+                             return Proceed.load() ? ASYNC_TASK_STATUS_COMPLETE : ASYNC_TASK_STATUS_NOT_STARTED;
+                         });
+
+    IAsyncTask* ppTasks[] = {pWaitTask, nullptr, pSpinTask};
+
+    EXPECT_EQ(WaitForAnyTask(ppTasks, static_cast<Uint32>(std::size(ppTasks)), 0), -1);
+    EXPECT_EQ(WaitForAnyTask(ppTasks, static_cast<Uint32>(std::size(ppTasks)), 10), -1);
+    EXPECT_FALSE(WaitForAllTasks(ppTasks, static_cast<Uint32>(std::size(ppTasks)), 10));
+
+    Proceed.store(true);
+    EXPECT_EQ(WaitForAnyTask(ppTasks, static_cast<Uint32>(std::size(ppTasks))), 2);
+    EXPECT_FALSE(WaitForAllTasks(ppTasks, static_cast<Uint32>(std::size(ppTasks)), 0));
+
+    Signal.Trigger(true, 1);
+    EXPECT_TRUE(WaitForAllTasks(ppTasks, static_cast<Uint32>(std::size(ppTasks))));
+    EXPECT_EQ(WaitForAnyTask(ppTasks, static_cast<Uint32>(std::size(ppTasks)), 0), 0);
+
+    IAsyncTask* ppNullTasks[] = {nullptr};
+    EXPECT_TRUE(WaitForAllTasks(ppNullTasks, static_cast<Uint32>(std::size(ppNullTasks)), 0));
+    EXPECT_EQ(WaitForAnyTask(ppNullTasks, static_cast<Uint32>(std::size(ppNullTasks))), -1);
+
+    pThreadPool->WaitForAllTasks();
+}
+
+TEST(Common_ThreadPool, ProcessItemsInParallel)
+{
+    constexpr Uint32 NumThreads = 4;
+    constexpr size_t NumItems   = 64;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::array<std::atomic<int>, NumItems> Counters{};
+    ProcessItemsInParallel(pThreadPool, NumItems, [&](size_t Item) { Counters[Item].fetch_add(1); });
+    for (size_t i = 0; i < NumItems; ++i)
+        EXPECT_EQ(Counters[i].load(), 1) << "Item " << i;
+
+    // Nested calls from the pool threads must not deadlock
+    std::atomic<int> NumNestedItems{0};
+    ProcessItemsInParallel(pThreadPool, NumThreads * 2, [&](size_t) {
+        ProcessItemsInParallel(pThreadPool, NumThreads, [&](size_t) { NumNestedItems.fetch_add(1); });
+    });
+    EXPECT_EQ(NumNestedItems.load(), static_cast<int>(NumThreads * NumThreads * 2));
+
+    // The exception is rethrown after all items are processed
+    std::atomic<int> NumProcessed{0};
+    EXPECT_THROW(ProcessItemsInParallel(pThreadPool, NumItems,
+                                        [&](size_t Item) {
+                                            NumProcessed.fetch_add(1);
+                                            if (Item == NumItems / 2)
+                                                throw std::runtime_error{"Test error"};
+                                        }),
+                 std::runtime_error);
+    EXPECT_EQ(NumProcessed.load(), static_cast<int>(NumItems));
+
+    pThreadPool->WaitForAllTasks();
+}
+
+TEST(Common_ThreadPool, CorePlacement)
+{
+    const CPUTopologyInfo Topology = PlatformMisc::GetCPUTopology();
+
+    EXPECT_EQ(GetThreadPoolCoresMask(ThreadPoolCorePlacement::Any), Uint64{0});
+    EXPECT_EQ(GetThreadPoolCoresMask(ThreadPoolCorePlacement::PerformanceCores), Topology.IsHybrid() ? Topology.PerformanceCoresMask : 0);
+    EXPECT_EQ(GetThreadPoolCoresMask(ThreadPoolCorePlacement::EfficiencyCores), Topology.IsHybrid() ? Topology.EfficiencyCoresMask : 0);
+
+    constexpr Uint32 NumThreads = 4;
+    for (ThreadPoolCorePlacement Placement : {ThreadPoolCorePlacement::PerformanceCores,
+                                              ThreadPoolCorePlacement::EfficiencyCores,
+                                              ThreadPoolCorePlacement::PhysicalCores})
+    {
+        ThreadPoolCreateInfo PoolCI;
+        PoolCI.NumThreads           = NumThreads;
+        PoolCI.CorePlacement        = Placement;
+        PoolCI.WorkerThreadPriority = ThreadPriority::BelowNormal;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
+        ASSERT_NE(pThreadPool, nullptr);
+
+        std::atomic<int> NumProcessed{0};
+        ProcessItemsInParallel(pThreadPool, NumThreads * 4, [&](size_t) { NumProcessed.fetch_add(1); });
+        EXPECT_EQ(NumProcessed.load(), static_cast<int>(NumThreads * 4));
+
+        pThreadPool->WaitForAllTasks();
+    }
+}
+
 } // namespace
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TrackingMemoryAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_TrackingMemoryAllocator, CountAllocations)
+{
+    if (!TrackingMemoryAllocator::IsEnabled())
+    {
+        GTEST_SKIP() << "Allocation tracking is disabled in this build";
+    }
+
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const AllocationCounters Start = TrackingMemoryAllocator::GetThreadCounters();
+
+    void* pData0 = Allocator.Allocate(16, "Test allocation", __FILE__, __LINE__);
+    void* pData1 = Allocator.AllocateAligned(64, 32, "Test aligned allocation", __FILE__, __LINE__);
+    ASSERT_NE(pData0, nullptr);
+    ASSERT_NE(pData1, nullptr);
+    EXPECT_EQ(reinterpret_cast<size_t>(pData1) % 32, size_t{0});
+
+    AllocationCounters Counters = TrackingMemoryAllocator::GetThreadCounters();
+    EXPECT_EQ(Counters.NumAllocations - Start.NumAllocations, Uint64{2});
+    EXPECT_EQ(Counters.AllocatedBytes - Start.AllocatedBytes, Uint64{16 + 64});
+    EXPECT_EQ(Counters.NumFrees - Start.NumFrees, Uint64{0});
+
+    Allocator.Free(pData0);
+    Allocator.FreeAligned(pData1);
+    // Null pointers are not counted
+    Allocator.Free(nullptr);
+
+    Counters = TrackingMemoryAllocator::GetThreadCounters();
+    EXPECT_EQ(Counters.NumAllocations - Start.NumAllocations, Uint64{2});
+    EXPECT_EQ(Counters.NumFrees - Start.NumFrees, Uint64{2});
+
+    TrackingMemoryAllocator::RecordAllocation(8);
+    TrackingMemoryAllocator::RecordFree();
+
+    Counters = TrackingMemoryAllocator::GetThreadCounters();
+    EXPECT_EQ(Counters.NumAllocations - Start.NumAllocations, Uint64{3});
+    EXPECT_EQ(Counters.AllocatedBytes - Start.AllocatedBytes, Uint64{16 + 64 + 8});
+    EXPECT_EQ(Counters.NumFrees - Start.NumFrees, Uint64{3});
+}
+
+TEST(Common_TrackingMemoryAllocator, PerThreadCounters)
+{
+    if (!TrackingMemoryAllocator::IsEnabled())
+    {
+        GTEST_SKIP() << "Allocation tracking is disabled in this build";
+    }
+
+    TrackingMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const AllocationCounters Start = TrackingMemoryAllocator::GetThreadCounters();
+
+    std::thread Worker{
+        [&Allocator]() {
+            const AllocationCounters WorkerStart = TrackingMemoryAllocator::GetThreadCounters();
+
+            void* pData = Allocator.Allocate(32, "Worker allocation", __FILE__, __LINE__);
+            Allocator.Free(pData);
+
+            const AllocationCounters WorkerEnd = TrackingMemoryAllocator::GetThreadCounters();
+            EXPECT_EQ(WorkerEnd.NumAllocations - WorkerStart.NumAllocations, Uint64{1});
+            EXPECT_EQ(WorkerEnd.NumFrees - WorkerStart.NumFrees, Uint64{1});
+        }};
+    Worker.join();
+
+    // Allocations made by other threads must not affect the counters of this thread
+    const AllocationCounters End = TrackingMemoryAllocator::GetThreadCounters();
+    EXPECT_EQ(End.NumAllocations, Start.NumAllocations);
+    EXPECT_EQ(End.NumFrees, Start.NumFrees);
+}
+
+} // namespace
@@ -26,8 +26,10 @@
  */
 
 #include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
+#include "ThreadPool.hpp"
 
 #include <vector>
 #include <array>
@@ -575,4 +577,206 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB_BOX_AVE)
     EXPECT_TRUE(CoarseData == RefCoarseData);
 }
 
+
+class MipChain
+{
+public:
+    MipChain(TEXTURE_FORMAT Format, Uint32 Width, Uint32 Height) :
+        m_Format{Format},
+        m_Width{Width},
+        m_Height{Height}
+    {
+        const auto&  FmtAttribs = GetTextureFormatAttribs(Format);
+        const Uint32 MipLevels  = ComputeMipLevelsCount(Width, Height);
+        for (Uint32 Mip = 0; Mip < MipLevels; ++Mip)
+        {
+            const Uint32 MipWidth  = std::max(Width >> Mip, 1u);
+            const Uint32 MipHeight = std::max(Height >> Mip, 1u);
+            // Add padding to test strides
+            m_Strides.push_back(size_t{MipWidth} * FmtAttribs.GetElementSize() + 4);
+            m_Levels.emplace_back(m_Strides.back() * MipHeight);
+            m_LevelPtrs.push_back(m_Levels.back().data());
+        }
+    }
+
+    std::vector<Uint8>& GetLevel(Uint32 Mip) { return m_Levels[Mip]; }
+
+    void Compute(MIP_FILTER_TYPE FilterType, IThreadPool* pThreadPool, float AlphaCutoff = 0, bool PreserveAlphaCoverage = false)
+    {
+        ComputeMipChainAttribs Attribs;
+        Attribs.Format                = m_Format;
+        Attribs.Width                 = m_Width;
+        Attribs.Height                = m_Height;
+        Attribs.MipLevels             = static_cast<Uint32>(m_Levels.size());
+        Attribs.ppMipData             = m_LevelPtrs.data();
+        Attribs.pMipStrides           = m_Strides.data();
+        Attribs.FilterType            = FilterType;
+        Attribs.AlphaCutoff           = AlphaCutoff;
+        Attribs.PreserveAlphaCoverage = PreserveAlphaCoverage;
+        Attribs.pThreadPool           = pThreadPool;
+        ComputeMipChain(Attribs);
+    }
+
+    void ComputeLevelByLevel(MIP_FILTER_TYPE FilterType)
+    {
+        for (Uint32 Mip = 1; Mip < m_Levels.size(); ++Mip)
+        {
+            ComputeMipLevel({m_Format, std::max(m_Width >> (Mip - 1), 1u), std::max(m_Height >> (Mip - 1), 1u),
+                             m_LevelPtrs[Mip - 1], m_Strides[Mip - 1], m_LevelPtrs[Mip], m_Strides[Mip], FilterType});
+        }
+    }
+
+    template <typename HandlerType>
+    void ProcessTexels(Uint32 Mip, HandlerType&& Handler) const
+    {
+        const Uint32 MipWidth    = std::max(m_Width >> Mip, 1u);
+        const Uint32 MipHeight   = std::max(m_Height >> Mip, 1u);
+        const size_t ElementSize = GetTextureFormatAttribs(m_Format).GetElementSize();
+        for (Uint32 y = 0; y < MipHeight; ++y)
+        {
+            for (Uint32 x = 0; x < MipWidth; ++x)
+                Handler(&m_Levels[Mip][y * m_Strides[Mip] + x * ElementSize]);
+        }
+    }
+
+    Uint32 GetMipLevels() const { return static_cast<Uint32>(m_Levels.size()); }
+
+private:
+    const TEXTURE_FORMAT m_Format;
+    const Uint32         m_Width;
+    const Uint32         m_Height;
+
+    std::vector<std::vector<Uint8>> m_Levels;
+    std::vector<void*>              m_LevelPtrs;
+    std::vector<size_t>             m_Strides;
+};
+
+TEST(GraphicsTools_ComputeMipChain, BoxAndMostFrequent)
+{
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    for (TEXTURE_FORMAT Fmt : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_R8_UINT, TEX_FORMAT_RG16_SNORM, TEX_FORMAT_RGBA32_FLOAT})
+    {
+        constexpr Uint32 Width  = 517;
+        constexpr Uint32 Height = 301;
+
+        MipChain RefChain{Fmt, Width, Height};
+        MipChain Chain{Fmt, Width, Height};
+        MipChain ParallelChain{Fmt, Width, Height};
+
+        FastRandInt rnd(0, 0, 255);
+        for (Uint8& c : RefChain.GetLevel(0))
+            c = static_cast<Uint8>(rnd());
+        if (GetTextureFormatAttribs(Fmt).ComponentType == COMPONENT_TYPE_FLOAT)
+        {
+            // Avoid NaNs
+            RefChain.ProcessTexels(0, [](const Uint8* pTexel) {
+                for (Uint32 c = 0; c < 4; ++c)
+                    const_cast<float*>(reinterpret_cast<const float*>(pTexel))[c] = static_cast<float>(pTexel[c * 4]) / 255.f;
+            });
+        }
+        Chain.GetLevel(0)         = RefChain.GetLevel(0);
+        ParallelChain.GetLevel(0) = RefChain.GetLevel(0);
+
+        RefChain.ComputeLevelByLevel(MIP_FILTER_TYPE_DEFAULT);
+        Chain.Compute(MIP_FILTER_TYPE_DEFAULT, nullptr);
+        ParallelChain.Compute(MIP_FILTER_TYPE_DEFAULT, pThreadPool);
+
+        for (Uint32 Mip = 1; Mip < RefChain.GetMipLevels(); ++Mip)
+        {
+            EXPECT_TRUE(Chain.GetLevel(Mip) == RefChain.GetLevel(Mip)) << GetTextureFormatAttribs(Fmt).Name << " mip " << Mip;
+            EXPECT_TRUE(ParallelChain.GetLevel(Mip) == RefChain.GetLevel(Mip)) << GetTextureFormatAttribs(Fmt).Name << " mip " << Mip;
+        }
+    }
+}
+
+TEST(GraphicsTools_ComputeMipChain, Windowed)
+{
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    for (MIP_FILTER_TYPE FilterType : {MIP_FILTER_TYPE_KAISER, MIP_FILTER_TYPE_LANCZOS})
+    {
+        for (TEXTURE_FORMAT Fmt : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_R8_SNORM})
+        {
+            constexpr Uint32 Width  = 389;
+            constexpr Uint32 Height = 250;
+
+            // Constant color must be preserved
+            {
+                MipChain Chain{Fmt, Width, Height};
+                for (Uint8& c : Chain.GetLevel(0))
+                    c = 93;
+                Chain.Compute(FilterType, nullptr);
+
+                for (Uint32 Mip = 1; Mip < Chain.GetMipLevels(); ++Mip)
+                {
+                    Chain.ProcessTexels(Mip, [&](const Uint8* pTexel) {
+                        for (Uint32 c = 0; c < GetTextureFormatAttribs(Fmt).NumComponents; ++c)
+                            ASSERT_NEAR(pTexel[c], 93, 1) << GetTextureFormatAttribs(Fmt).Name << " mip " << Mip;
+                    });
+                }
+            }
+
+            // Parallel computation must produce the same results
+            {
+                MipChain Chain{Fmt, Width, Height};
+                MipChain ParallelChain{Fmt, Width, Height};
+
+                FastRandInt rnd(0, 0, 255);
+                for (Uint8& c : Chain.GetLevel(0))
+                    c = static_cast<Uint8>(rnd());
+                ParallelChain.GetLevel(0) = Chain.GetLevel(0);
+
+                Chain.Compute(FilterType, nullptr);
+                ParallelChain.Compute(FilterType, pThreadPool);
+                for (Uint32 Mip = 1; Mip < Chain.GetMipLevels(); ++Mip)
+                    EXPECT_TRUE(ParallelChain.GetLevel(Mip) == Chain.GetLevel(Mip)) << GetTextureFormatAttribs(Fmt).Name << " mip " << Mip;
+            }
+        }
+    }
+
+    // Single level
+    {
+        const Uint8 FineData[] = {0, 0, 255, 255, 0, 0, 255, 255};
+        Uint8       CoarseData[2]{};
+        ComputeMipLevel({TEX_FORMAT_R8_UNORM, 4, 2, FineData, 4, CoarseData, 2, MIP_FILTER_TYPE_LANCZOS});
+        EXPECT_LT(CoarseData[0], 64);
+        EXPECT_GT(CoarseData[1], 192);
+    }
+}
+
+TEST(GraphicsTools_ComputeMipChain, AlphaCoverage)
+{
+    constexpr Uint32 Width       = 256;
+    constexpr Uint32 Height      = 256;
+    constexpr float  AlphaCutoff = 0.5f;
+
+    MipChain Chain{TEX_FORMAT_RGBA8_UNORM, Width, Height};
+
+    // Sparse opaque texels that fade out in the coarse levels without the coverage preservation
+    FastRandFloat rnd(0, 0.f, 1.f);
+    Chain.ProcessTexels(0, [&](const Uint8* pTexel) {
+        const_cast<Uint8*>(pTexel)[3] = rnd() < 0.3f ? 255 : 0;
+    });
+
+    auto GetCoverage = [&](Uint32 Mip) {
+        Uint32 NumPassed = 0;
+        Uint32 NumTexels = 0;
+        Chain.ProcessTexels(Mip, [&](const Uint8* pTexel) {
+            NumPassed += pTexel[3] > AlphaCutoff * 255 ? 1 : 0;
+            ++NumTexels;
+        });
+        return static_cast<float>(NumPassed) / static_cast<float>(NumTexels);
+    };
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    Chain.Compute(MIP_FILTER_TYPE_BOX_AVERAGE, pThreadPool, AlphaCutoff, /*PreserveAlphaCoverage = */ true);
+
+    const float RefCoverage = GetCoverage(0);
+    EXPECT_NEAR(RefCoverage, 0.3f, 0.02f);
+    // The coverage can't be matched exactly at the coarsest levels that have few distinct alpha values
+    for (Uint32 Mip = 1; Mip < Chain.GetMipLevels() - 2; ++Mip)
+        EXPECT_NEAR(GetCoverage(Mip), RefCoverage, 0.05f) << "mip " << Mip;
+}
+
 } // namespace
@@ -26,6 +26,9 @@
  */
 
 #include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -128,4 +131,164 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+// Counts the number of live instances
+struct CountedResource
+{
+    explicit CountedResource(std::atomic<int>& _Counter) :
+        pCounter{&_Counter}
+    {
+        pCounter->fetch_add(1);
+    }
+
+    CountedResource(CountedResource&& rhs) noexcept :
+        pCounter{rhs.pCounter}
+    {
+        rhs.pCounter = nullptr;
+    }
+
+    CountedResource(const CountedResource&) = delete;
+    CountedResource& operator=(const CountedResource&) = delete;
+    CountedResource& operator=(CountedResource&&) = delete;
+
+    ~CountedResource()
+    {
+        if (pCounter != nullptr)
+            pCounter->fetch_add(-1);
+    }
+
+    std::atomic<int>* pCounter = nullptr;
+};
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, OutOfOrderRelease)
+{
+    std::atomic<int> NumLive{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    Queue.SafeReleaseResource(CountedResource{NumLive}, 3);
+    Queue.SafeReleaseResource(CountedResource{NumLive}, 1);
+    Queue.SafeReleaseResource(CountedResource{NumLive}, 2);
+    Queue.DiscardResource(CountedResource{NumLive}, 20);
+    Queue.DiscardResource(CountedResource{NumLive}, 5);
+    EXPECT_EQ(NumLive, 5);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{3});
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{2});
+
+    // Resources released with command list numbers 1 and 2 must be moved to the
+    // release queue even though a resource with the greater number was released first.
+    Queue.DiscardStaleResources(2, 10);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{1});
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{4});
+
+    Queue.Purge(5);
+    EXPECT_EQ(NumLive, 4);
+
+    Queue.Purge(10);
+    EXPECT_EQ(NumLive, 2);
+
+    Queue.DiscardStaleResources(3, 15);
+    Queue.Purge(15);
+    EXPECT_EQ(NumLive, 1);
+
+    Queue.Purge(20);
+    EXPECT_EQ(NumLive, 0);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{0});
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, PooledWrappers)
+{
+    std::atomic<int> NumLive{0};
+
+    LockFreeBlockPool Pool{DefaultRawMemoryAllocator::GetAllocator(), 64};
+    {
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue0(DefaultRawMemoryAllocator::GetAllocator());
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue1(DefaultRawMemoryAllocator::GetAllocator());
+
+        auto Wrapper0 = DynamicStaleResourceWrapper::Create(CountedResource{NumLive}, 1, &Pool);
+        auto Wrapper1 = DynamicStaleResourceWrapper::Create(CountedResource{NumLive}, 2, &Pool);
+        EXPECT_EQ(Pool.GetNumUsedBlocks(), 2u);
+
+        // The resource does not fit into the pool block and is allocated on the heap
+        struct LargeResource
+        {
+            CountedResource Res;
+            Uint8           Data[128] = {};
+        };
+        auto Wrapper2 = DynamicStaleResourceWrapper::Create(LargeResource{CountedResource{NumLive}}, 1, &Pool);
+        EXPECT_EQ(Pool.GetNumUsedBlocks(), 2u);
+        EXPECT_EQ(NumLive, 3);
+
+        Queue0.SafeReleaseResource(std::move(Wrapper0), 0);
+        Queue0.SafeReleaseResource(Wrapper1, 0);
+        Queue1.SafeReleaseResource(Wrapper1, 0);
+        Wrapper1.GiveUpOwnership();
+        Queue1.DiscardResource(std::move(Wrapper2), 1);
+
+        Queue0.DiscardStaleResources(0, 1);
+        Queue0.Purge(1);
+        EXPECT_EQ(NumLive, 2);
+        EXPECT_EQ(Pool.GetNumUsedBlocks(), 1u);
+
+        Queue1.DiscardStaleResources(0, 1);
+        Queue1.Purge(1);
+        EXPECT_EQ(NumLive, 0);
+    }
+    EXPECT_EQ(Pool.GetNumUsedBlocks(), 0u);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, ThreadContention)
+{
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    static constexpr int NumThreadIterations = 4096;
+
+    std::atomic<int> NumLive{0};
+
+    LockFreeBlockPool Pool{DefaultRawMemoryAllocator::GetAllocator(), 64};
+    {
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+        std::atomic<Uint64> CmdListNumber{0};
+        std::atomic<Uint32> NumRunningThreads{NumThreads};
+
+        std::vector<std::thread> Workers;
+        Workers.reserve(NumThreads);
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Workers.emplace_back(
+                [&, t] //
+                {
+                    for (int i = 0; i < NumThreadIterations; ++i)
+                    {
+                        if ((i + t) % 4 == 0)
+                            Queue.DiscardResource(DynamicStaleResourceWrapper::Create(CountedResource{NumLive}, 1, &Pool), CmdListNumber.load());
+                        else
+                            Queue.SafeReleaseResource(DynamicStaleResourceWrapper::Create(CountedResource{NumLive}, 1, &Pool), CmdListNumber.load());
+                    }
+                    NumRunningThreads.fetch_add(~0u);
+                });
+        }
+
+        // Emulate the render thread that submits command lists and purges the queue
+        while (NumRunningThreads.load() != 0)
+        {
+            const Uint64 SubmittedCmdList = CmdListNumber.fetch_add(1);
+            Queue.DiscardStaleResources(SubmittedCmdList, SubmittedCmdList + 1);
+            Queue.Purge(SubmittedCmdList);
+        }
+
+        for (auto& Thread : Workers)
+            Thread.join();
+
+        const Uint64 LastCmdList = CmdListNumber.fetch_add(1);
+        Queue.DiscardStaleResources(LastCmdList, LastCmdList + 1);
+        Queue.Purge(LastCmdList + 1);
+        EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{0});
+        EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+        EXPECT_EQ(NumLive, 0);
+    }
+    EXPECT_EQ(Pool.GetNumUsedBlocks(), 0u);
+}
+
 } // namespace
@@ -0,0 +1,237 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShelfAtlasManager.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+using Region = ShelfAtlasManager::Region;
+
+bool RegionsOverlap(const Region& R0, const Region& R1)
+{
+    return R0.x < R1.x + R1.width && R1.x < R0.x + R0.width &&
+        R0.y < R1.y + R1.height && R1.y < R0.y + R0.height;
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, GetShelfHeight)
+{
+    const Uint32 RefHeights[][2] = {
+        {1, 1},
+        {2, 2},
+        {3, 3},
+        {4, 4},
+        {5, 6},
+        {6, 6},
+        {7, 8},
+        {8, 8},
+        {9, 12},
+        {12, 12},
+        {13, 16},
+        {17, 24},
+        {25, 32},
+        {33, 48},
+        {100, 128},
+        {1000, 1024},
+    };
+    for (const auto& Ref : RefHeights)
+        EXPECT_EQ(ShelfAtlasManager::GetShelfHeight(Ref[0]), Ref[1]) << Ref[0];
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, Empty)
+{
+    ShelfAtlasManager Mgr{128, 64};
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 128u * 64u);
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    EXPECT_EQ(Mgr.GetMaxFreeRegionArea(), 128u * 64u);
+
+    EXPECT_TRUE(Mgr.Allocate(0, 16).IsEmpty());
+    EXPECT_TRUE(Mgr.Allocate(129, 16).IsEmpty());
+    EXPECT_TRUE(Mgr.Allocate(16, 65).IsEmpty());
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, Move)
+{
+    ShelfAtlasManager Mgr{128, 64};
+    auto              R = Mgr.Allocate(16, 16);
+
+    ShelfAtlasManager Mgr2{std::move(Mgr)};
+    EXPECT_FALSE(Mgr2.IsEmpty());
+    Mgr2.Free(std::move(R));
+    EXPECT_TRUE(Mgr2.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, Allocate)
+{
+    ShelfAtlasManager Mgr{64, 64};
+
+    // Regions of the same size class share the same shelf
+    auto R0 = Mgr.Allocate(16, 8);
+    EXPECT_EQ(R0, Region(0, 0, 16, 8));
+    auto R1 = Mgr.Allocate(8, 7);
+    EXPECT_EQ(R1, Region(16, 0, 8, 7));
+
+    // New size class - new shelf
+    auto R2 = Mgr.Allocate(32, 16);
+    EXPECT_EQ(R2, Region(0, 8, 32, 16));
+    auto R3 = Mgr.Allocate(40, 8);
+    EXPECT_EQ(R3, Region(24, 0, 40, 8));
+    // The first shelf is full - open a new one
+    auto R4 = Mgr.Allocate(8, 8);
+    EXPECT_EQ(R4, Region(0, 24, 8, 8));
+    EXPECT_EQ(Mgr.GetShelfCount(), 3u);
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 64u * 64u - (16u * 8u + 8u * 7u + 32u * 16u + 40u * 8u + 8u * 8u));
+
+    // Freed space is merged with free neighbors and reused
+    Mgr.Free(std::move(R1));
+    Mgr.Free(std::move(R0));
+    auto R5 = Mgr.Allocate(24, 8);
+    EXPECT_EQ(R5, Region(0, 0, 24, 8));
+
+    // Releasing the last region in the shelf releases the shelf
+    Mgr.Free(std::move(R2));
+    EXPECT_EQ(Mgr.GetShelfCount(), 2u);
+    auto R6 = Mgr.Allocate(64, 12);
+    EXPECT_EQ(R6, Region(0, 8, 64, 12));
+
+    Mgr.Free(std::move(R3));
+    Mgr.Free(std::move(R4));
+    Mgr.Free(std::move(R5));
+    Mgr.Free(std::move(R6));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 64u * 64u);
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, SmallBand)
+{
+    ShelfAtlasManager Mgr{32, 21};
+
+    auto R0 = Mgr.Allocate(32, 16);
+    EXPECT_EQ(R0, Region(0, 0, 32, 16));
+
+    // The size class of 5 is 6, but only 5 rows are left
+    auto R1 = Mgr.Allocate(16, 5);
+    EXPECT_EQ(R1, Region(0, 16, 16, 5));
+    EXPECT_EQ(Mgr.GetShelfCount(), 2u);
+
+    // There is no space for a new shelf - the region is placed into the shelf of another size class
+    auto R2 = Mgr.Allocate(8, 2);
+    EXPECT_EQ(R2, Region(16, 16, 8, 2));
+
+    EXPECT_TRUE(Mgr.Allocate(8, 6).IsEmpty());
+    EXPECT_TRUE(Mgr.Allocate(16, 4).IsEmpty());
+
+    Mgr.Free(std::move(R0));
+    Mgr.Free(std::move(R1));
+    Mgr.Free(std::move(R2));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetShelfCount(), 0u);
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, UniformRegions)
+{
+    ShelfAtlasManager Mgr{512, 512};
+
+    // 16x16 glyphs fill the atlas entirely
+    std::vector<Region> Regions;
+    for (Uint32 i = 0; i < 32 * 32; ++i)
+    {
+        Regions.emplace_back(Mgr.Allocate(16, 16));
+        ASSERT_FALSE(Regions.back().IsEmpty());
+    }
+    EXPECT_TRUE(Mgr.Allocate(16, 16).IsEmpty());
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), 0u);
+
+    // Free every other region and allocate them again
+    for (size_t i = 0; i < Regions.size(); i += 2)
+        Mgr.Free(std::move(Regions[i]));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 32u * 16u);
+    for (size_t i = 0; i < Regions.size(); i += 2)
+    {
+        Regions[i] = Mgr.Allocate(16, 16);
+        ASSERT_FALSE(Regions[i].IsEmpty());
+    }
+
+    for (auto& R : Regions)
+        Mgr.Free(std::move(R));
+    EXPECT_TRUE(Mgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ShelfAtlasManager, AllocateRandom)
+{
+    ShelfAtlasManager Mgr{256, 256};
+    for (Uint32 i = 0; i < 10; ++i)
+    {
+        FastRandInt         rnd{static_cast<unsigned int>(i), 1, 16};
+        std::vector<Region> Regions(i * 64);
+        for (auto& R : Regions)
+        {
+            const Uint32 Width  = rnd();
+            const Uint32 Height = rnd();
+            R                   = Mgr.Allocate(Width, Height);
+            if (!R.IsEmpty())
+            {
+                EXPECT_EQ(R.width, Width);
+                EXPECT_EQ(R.height, Height);
+                EXPECT_LE(R.x + R.width, 256u);
+                EXPECT_LE(R.y + R.height, 256u);
+            }
+        }
+
+        for (size_t r0 = 0; r0 < Regions.size(); ++r0)
+        {
+            for (size_t r1 = r0 + 1; r1 < Regions.size(); ++r1)
+            {
+                if (!Regions[r0].IsEmpty() && !Regions[r1].IsEmpty())
+                    EXPECT_FALSE(RegionsOverlap(Regions[r0], Regions[r1]));
+            }
+        }
+
+        // Release in random order
+        for (size_t r = 0; r < Regions.size(); ++r)
+            std::swap(Regions[r], Regions[rnd() % Regions.size()]);
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+        EXPECT_TRUE(Mgr.IsEmpty());
+    }
+}
+
+} // namespace
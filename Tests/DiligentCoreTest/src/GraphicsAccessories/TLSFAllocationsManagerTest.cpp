@@ -0,0 +1,332 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TLSFAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FastRand.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using OffsetType = TLSFAllocationsManager::OffsetType;
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, AllocateFree)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager Mgr(128, Allocator);
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetFreeSize(), size_t{128});
+    EXPECT_EQ(Mgr.GetUsedSize(), size_t{0});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{128});
+    EXPECT_TRUE(Mgr.IsEmpty());
+
+    auto a1 = Mgr.Allocate(17, 4);
+    EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+    EXPECT_EQ(a1.Size, OffsetType{20});
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetUsedSize(), size_t{20});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{128 - 20});
+
+    // The padding is not included in the allocation
+    auto a2 = Mgr.Allocate(8, 16);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{32});
+    EXPECT_EQ(a2.Size, OffsetType{16});
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{2});
+    EXPECT_EQ(Mgr.GetUsedSize(), size_t{36});
+
+    // The 12-byte gap is reused
+    auto a3 = Mgr.Allocate(12, 4);
+    EXPECT_EQ(a3.UnalignedOffset, OffsetType{20});
+    EXPECT_EQ(a3.Size, OffsetType{12});
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+
+    auto a4 = Mgr.Allocate(80, 1);
+    EXPECT_EQ(a4.UnalignedOffset, OffsetType{48});
+    EXPECT_EQ(a4.Size, OffsetType{80});
+    EXPECT_TRUE(Mgr.IsFull());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{0});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{0});
+
+    auto a5 = Mgr.Allocate(1, 1);
+    EXPECT_FALSE(a5.IsValid());
+
+    Mgr.Free(std::move(a3));
+    EXPECT_FALSE(a3.IsValid());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{12});
+
+    Mgr.Free(a4.UnalignedOffset, a4.Size);
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{2});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{80});
+
+    // Merge with both neighbors
+    Mgr.Free(std::move(a2));
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{128 - 20});
+
+    Mgr.Free(std::move(a1));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{128});
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, FreeOrder)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    const auto NumAllocs = 6;
+    int        NumPerms  = 0;
+    size_t     ReleaseOrder[NumAllocs];
+    for (size_t a = 0; a < NumAllocs; ++a)
+        ReleaseOrder[a] = a;
+    do
+    {
+        ++NumPerms;
+        TLSFAllocationsManager Mgr(NumAllocs * 4, Allocator);
+
+        TLSFAllocationsManager::Allocation allocs[NumAllocs];
+        for (size_t a = 0; a < NumAllocs; ++a)
+        {
+            allocs[a] = Mgr.Allocate(4, 1);
+            EXPECT_EQ(allocs[a].UnalignedOffset, a * 4);
+            EXPECT_EQ(allocs[a].Size, OffsetType{4});
+        }
+        EXPECT_TRUE(Mgr.IsFull());
+
+        for (size_t a = 0; a < NumAllocs; ++a)
+            Mgr.Free(std::move(allocs[ReleaseOrder[a]]));
+
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    } while (std::next_permutation(std::begin(ReleaseOrder), std::end(ReleaseOrder)));
+    EXPECT_EQ(NumPerms, 720);
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Extend)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager Mgr(64, Allocator);
+
+    auto a1 = Mgr.Allocate(32, 1);
+    EXPECT_FALSE(Mgr.Allocate(64, 1).IsValid());
+
+    // The last free block is extended
+    Mgr.Extend(32);
+    EXPECT_EQ(Mgr.GetMaxSize(), size_t{96});
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    auto a2 = Mgr.Allocate(64, 1);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{32});
+    EXPECT_TRUE(Mgr.IsFull());
+
+    // A new block is added
+    Mgr.Extend(16);
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    auto a3 = Mgr.Allocate(16, 1);
+    EXPECT_EQ(a3.UnalignedOffset, OffsetType{96});
+
+    Mgr.Free(std::move(a2));
+    Mgr.Free(std::move(a1));
+    Mgr.Free(std::move(a3));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), size_t{112});
+
+    // Extending an empty manager
+    TLSFAllocationsManager EmptyMgr(0, Allocator);
+    EXPECT_FALSE(EmptyMgr.Allocate(1, 1).IsValid());
+    EmptyMgr.Extend(256);
+    auto a4 = EmptyMgr.Allocate(256, 256);
+    EXPECT_EQ(a4.UnalignedOffset, OffsetType{0});
+    EmptyMgr.Free(std::move(a4));
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, ExactFit)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    // An empty manager of any size must be able to allocate all its space
+    for (OffsetType MaxSize = 1; MaxSize <= 4096; ++MaxSize)
+    {
+        TLSFAllocationsManager Mgr(MaxSize, Allocator);
+
+        auto a = Mgr.Allocate(MaxSize, 1);
+        ASSERT_TRUE(a.IsValid()) << "MaxSize: " << MaxSize;
+        EXPECT_EQ(a.UnalignedOffset, OffsetType{0});
+        EXPECT_EQ(a.Size, MaxSize);
+        EXPECT_TRUE(Mgr.IsFull());
+
+        Mgr.Free(std::move(a));
+        EXPECT_TRUE(Mgr.IsEmpty());
+    }
+
+    for (OffsetType MaxSize : {OffsetType{1000}, OffsetType{65535}, OffsetType{1000000}, (OffsetType{1} << 32) + 12345})
+    {
+        TLSFAllocationsManager Mgr(MaxSize, Allocator);
+
+        auto a = Mgr.Allocate(MaxSize, 1);
+        ASSERT_TRUE(a.IsValid()) << "MaxSize: " << MaxSize;
+        EXPECT_EQ(a.Size, MaxSize);
+        Mgr.Free(std::move(a));
+    }
+
+    // Aligned exact fit
+    {
+        TLSFAllocationsManager Mgr(1000, Allocator);
+
+        auto a = Mgr.Allocate(1000, 8);
+        ASSERT_TRUE(a.IsValid());
+        EXPECT_EQ(a.UnalignedOffset, OffsetType{0});
+        EXPECT_EQ(a.Size, OffsetType{1000});
+        Mgr.Free(std::move(a));
+    }
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, NonPowerOfTwo)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager Mgr(1000, Allocator);
+
+    auto a1 = Mgr.Allocate(300, 1);
+    auto a2 = Mgr.Allocate(300, 1);
+    auto a3 = Mgr.Allocate(400, 1);
+    ASSERT_TRUE(a1.IsValid() && a2.IsValid() && a3.IsValid());
+    EXPECT_TRUE(Mgr.IsFull());
+
+    // The 300-byte hole must be reused by a request of the same size
+    Mgr.Free(a2.UnalignedOffset, a2.Size);
+    auto a4 = Mgr.Allocate(300, 1);
+    ASSERT_TRUE(a4.IsValid());
+    EXPECT_EQ(a4.UnalignedOffset, OffsetType{300});
+
+    // A smaller request from the same size class also fits
+    Mgr.Free(std::move(a4));
+    auto a5 = Mgr.Allocate(290, 1);
+    ASSERT_TRUE(a5.IsValid());
+    EXPECT_EQ(a5.UnalignedOffset, OffsetType{300});
+    EXPECT_FALSE(Mgr.Allocate(11, 1).IsValid());
+    auto a6 = Mgr.Allocate(10, 1);
+    ASSERT_TRUE(a6.IsValid());
+    EXPECT_EQ(a6.UnalignedOffset, OffsetType{590});
+
+    Mgr.Free(std::move(a1));
+    Mgr.Free(std::move(a3));
+    Mgr.Free(std::move(a5));
+    Mgr.Free(std::move(a6));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), OffsetType{1000});
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Move)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    TLSFAllocationsManager Mgr(1024, Allocator);
+    auto                   a1 = Mgr.Allocate(100, 4);
+
+    TLSFAllocationsManager Mgr2{std::move(Mgr)};
+    EXPECT_EQ(Mgr.GetMaxSize(), size_t{0});
+    EXPECT_EQ(Mgr2.GetMaxSize(), size_t{1024});
+    EXPECT_EQ(Mgr2.GetUsedSize(), size_t{100});
+
+    auto a2 = Mgr2.Allocate(100, 4);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{100});
+    Mgr2.Free(std::move(a1));
+    Mgr2.Free(std::move(a2));
+    EXPECT_TRUE(Mgr2.IsEmpty());
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Random)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    constexpr size_t MaxSize = size_t{1} << 20;
+
+    TLSFAllocationsManager Mgr{TLSFAllocationsManager::CreateInfo{Allocator, MaxSize, true}};
+
+    FastRandInt SizeRnd{0, 1, 4096};
+    FastRandInt AlignRnd{1, 0, 8};
+    FastRandInt IdxRnd{2, 0, 30000};
+
+    struct AllocInfo
+    {
+        TLSFAllocationsManager::Allocation Alloc;
+        OffsetType                         Alignment;
+    };
+    std::vector<AllocInfo> Allocs;
+
+    size_t UsedSize = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        if (Allocs.empty() || (IdxRnd() & 3) != 0)
+        {
+            const OffsetType Alignment = OffsetType{1} << AlignRnd();
+            auto             Alloc     = Mgr.Allocate(SizeRnd(), Alignment);
+            if (!Alloc.IsValid())
+                continue;
+
+            UsedSize += Alloc.Size;
+            EXPECT_LE(AlignUp(Alloc.UnalignedOffset, Alignment) + 1, Alloc.UnalignedOffset + Alloc.Size);
+            EXPECT_LE(Alloc.UnalignedOffset + Alloc.Size, MaxSize);
+            Allocs.push_back({Alloc, Alignment});
+        }
+        else
+        {
+            const size_t Idx = IdxRnd() % Allocs.size();
+            UsedSize -= Allocs[Idx].Alloc.Size;
+            Mgr.Free(std::move(Allocs[Idx].Alloc));
+            Allocs[Idx] = Allocs.back();
+            Allocs.pop_back();
+        }
+        ASSERT_EQ(Mgr.GetUsedSize(), UsedSize);
+    }
+
+    // Allocations must not overlap
+    std::sort(Allocs.begin(), Allocs.end(), [](const AllocInfo& lhs, const AllocInfo& rhs) {
+        return lhs.Alloc.UnalignedOffset < rhs.Alloc.UnalignedOffset;
+    });
+    for (size_t i = 1; i < Allocs.size(); ++i)
+    {
+        const auto& Prev = Allocs[i - 1].Alloc;
+        EXPECT_LE(Prev.UnalignedOffset + Prev.Size, Allocs[i].Alloc.UnalignedOffset);
+    }
+
+    for (auto& Alloc : Allocs)
+        Mgr.Free(std::move(Alloc.Alloc));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), MaxSize);
+}
+
+} // namespace
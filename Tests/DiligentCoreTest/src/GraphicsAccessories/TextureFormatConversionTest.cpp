@@ -0,0 +1,310 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TextureFormatConversion.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_TextureFormatConversion, Half)
+{
+    EXPECT_EQ(FloatToHalf(0.f), 0x0000);
+    EXPECT_EQ(FloatToHalf(-0.f), 0x8000);
+    EXPECT_EQ(FloatToHalf(1.f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-2.f), 0xC000);
+    EXPECT_EQ(FloatToHalf(65504.f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(65519.f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(65520.f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::infinity()), 0x7C00);
+    EXPECT_EQ(FloatToHalf(-std::numeric_limits<float>::infinity()), 0xFC00);
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.f, -24)), 0x0001);
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.f, -26)), 0x0000);
+    // Round to the nearest even
+    EXPECT_EQ(FloatToHalf(1.f + std::ldexp(1.f, -11)), 0x3C00);
+    EXPECT_EQ(FloatToHalf(1.f + 3.f * std::ldexp(1.f, -11)), 0x3C02);
+    EXPECT_TRUE(std::isnan(HalfToFloat(FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+
+    for (Uint32 h = 0; h <= 0xFFFF; ++h)
+    {
+        const float f = HalfToFloat(static_cast<Uint16>(h));
+        if ((h & 0x7C00) == 0x7C00 && (h & 0x03FF) != 0)
+            EXPECT_TRUE(std::isnan(f)) << h;
+        else
+            EXPECT_EQ(FloatToHalf(f), h);
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, R11G11B10F)
+{
+    EXPECT_EQ(UnpackR11G11B10F(PackR11G11B10F(float3{1.f, 2.f, 0.5f})), (float3{1.f, 2.f, 0.5f}));
+    EXPECT_EQ(UnpackR11G11B10F(PackR11G11B10F(float3{-1.f, 0.f, 1e10f})), (float3{0.f, 0.f, 64512.f}));
+    EXPECT_EQ(UnpackR11G11B10F(PackR11G11B10F(float3{65024.f, 1e10f, 0.f})), (float3{65024.f, 65024.f, 0.f}));
+
+    // All finite values must be preserved
+    for (Uint32 v = 0; v < 0x7C0; ++v)
+    {
+        const float3 RGB{UnpackR11G11B10F(v | (v << 11) | ((v >> 1) << 22))};
+        EXPECT_EQ(PackR11G11B10F(RGB), v | (v << 11) | ((v >> 1) << 22)) << v;
+    }
+
+    // The nearest value is selected
+    const float3 RGB = UnpackR11G11B10F(PackR11G11B10F(float3{1.01f, 0.99f, 3.3f}));
+    EXPECT_NEAR(RGB.r, 1.01f, 1.f / 64.f);
+    EXPECT_NEAR(RGB.g, 0.99f, 1.f / 128.f);
+    EXPECT_NEAR(RGB.b, 3.3f, 2.f / 32.f);
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, RGB9E5)
+{
+    EXPECT_EQ(UnpackRGB9E5(PackRGB9E5(float3{1.f, 0.5f, 0.25f})), (float3{1.f, 0.5f, 0.25f}));
+    EXPECT_EQ(UnpackRGB9E5(PackRGB9E5(float3{0.f, 0.f, 0.f})), (float3{0.f, 0.f, 0.f}));
+    EXPECT_EQ(UnpackRGB9E5(PackRGB9E5(float3{-1.f, 1e10f, 0.f})), (float3{0.f, 65408.f, 0.f}));
+
+    FastRandFloat rnd{0, 0.f, 1.f};
+    for (Uint32 i = 0; i < 1000; ++i)
+    {
+        const float  Scale = std::ldexp(1.f, static_cast<int>(i % 20) - 10);
+        const float3 RGB{rnd() * Scale, rnd() * Scale, rnd() * Scale};
+        const float3 Unpacked = UnpackRGB9E5(PackRGB9E5(RGB));
+        // The error does not exceed half of the step of the largest component
+        const float MaxError = std::max(std::max(RGB.r, RGB.g), RGB.b) / 512.f;
+        EXPECT_NEAR(Unpacked.r, RGB.r, MaxError);
+        EXPECT_NEAR(Unpacked.g, RGB.g, MaxError);
+        EXPECT_NEAR(Unpacked.b, RGB.b, MaxError);
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, IsTexelConversionSupported)
+{
+    EXPECT_TRUE(IsTexelConversionSupported(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA32_FLOAT));
+    EXPECT_TRUE(IsTexelConversionSupported(TEX_FORMAT_BGRA8_UNORM_SRGB, TEX_FORMAT_R11G11B10_FLOAT));
+    EXPECT_TRUE(IsTexelConversionSupported(TEX_FORMAT_RGB9E5_SHAREDEXP, TEX_FORMAT_RGBA16_FLOAT));
+    EXPECT_FALSE(IsTexelConversionSupported(TEX_FORMAT_BC1_UNORM, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_FALSE(IsTexelConversionSupported(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_R8_UNORM));
+}
+
+// Odd number of texels to test the remainders of the vectorized loops
+constexpr size_t NumTestTexels = 256 + 37;
+
+std::vector<Uint8> GetTestRGBA8Data()
+{
+    std::vector<Uint8> Data(NumTestTexels * 4);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i < 1024 ? i / 4 : i * 7);
+    return Data;
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, RGBA8)
+{
+    const std::vector<Uint8> RGBA8 = GetTestRGBA8Data();
+
+    const TEXTURE_FORMAT Formats8[] = {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_BGRA8_UNORM, TEX_FORMAT_BGRA8_UNORM_SRGB};
+    for (TEXTURE_FORMAT Fmt : Formats8)
+    {
+        const bool IsSRGB = Fmt == TEX_FORMAT_RGBA8_UNORM_SRGB || Fmt == TEX_FORMAT_BGRA8_UNORM_SRGB;
+        const bool IsBGRA = Fmt == TEX_FORMAT_BGRA8_UNORM || Fmt == TEX_FORMAT_BGRA8_UNORM_SRGB;
+
+        std::vector<float> RGBA32F(NumTestTexels * 4);
+        ASSERT_TRUE(ConvertTexels(Fmt, RGBA8.data(), TEX_FORMAT_RGBA32_FLOAT, RGBA32F.data(), NumTestTexels));
+        for (size_t t = 0; t < NumTestTexels; ++t)
+        {
+            for (size_t c = 0; c < 4; ++c)
+            {
+                const Uint8 Val = RGBA8[t * 4 + (IsBGRA && c < 3 ? 2 - c : c)];
+                EXPECT_NEAR(RGBA32F[t * 4 + c], IsSRGB && c < 3 ? GammaToLinear(Val / 255.f) : Val / 255.f, 1e-6f);
+            }
+        }
+
+        // 8-bit values must survive the round trip
+        std::vector<Uint8> RoundTrip(NumTestTexels * 4);
+        ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGBA32_FLOAT, RGBA32F.data(), Fmt, RoundTrip.data(), NumTestTexels));
+        EXPECT_EQ(RoundTrip, RGBA8) << GetTextureFormatAttribs(Fmt).Name;
+
+        // Direct 8-bit conversions must match the conversions through floating point
+        for (TEXTURE_FORMAT DstFmt : Formats8)
+        {
+            std::vector<Uint8> Direct(NumTestTexels * 4);
+            ASSERT_TRUE(ConvertTexels(Fmt, RGBA8.data(), DstFmt, Direct.data(), NumTestTexels));
+
+            std::vector<Uint8> Ref(NumTestTexels * 4);
+            ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGBA32_FLOAT, RGBA32F.data(), DstFmt, Ref.data(), NumTestTexels));
+            EXPECT_EQ(Direct, Ref) << GetTextureFormatAttribs(Fmt).Name << " -> " << GetTextureFormatAttribs(DstFmt).Name;
+        }
+    }
+
+    // Out-of-range values are clamped
+    const float  Floats[] = {-1.f, 2.f, std::numeric_limits<float>::quiet_NaN(), 0.5f};
+    Uint8        Clamped[4]{};
+    const Uint8  RefClamped[] = {0, 255, 0, 128};
+    ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGBA32_FLOAT, Floats, TEX_FORMAT_RGBA8_UNORM, Clamped, 1));
+    for (size_t c = 0; c < 4; ++c)
+        EXPECT_EQ(Clamped[c], RefClamped[c]);
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, LinearToSRGB)
+{
+    // Every linear value is converted to the nearest sRGB value
+    FastRandFloat      rnd{0, 0.f, 1.f};
+    std::vector<float> RGBA32F(NumTestTexels * 4);
+    for (size_t i = 0; i < RGBA32F.size(); ++i)
+        RGBA32F[i] = i < 256 ? static_cast<float>(i) / 255.f : rnd();
+
+    std::vector<Uint8> SRGB8(NumTestTexels * 4);
+    ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGBA32_FLOAT, RGBA32F.data(), TEX_FORMAT_RGBA8_UNORM_SRGB, SRGB8.data(), NumTestTexels));
+    for (size_t i = 0; i < RGBA32F.size(); ++i)
+    {
+        if (i % 4 == 3)
+            continue;
+        const float Ref = LinearToGamma(RGBA32F[i]) * 255.f;
+        EXPECT_LE(std::abs(static_cast<float>(SRGB8[i]) - Ref), 0.5f + 1e-3f) << RGBA32F[i];
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, FloatFormats)
+{
+    FastRandFloat      rnd{0, -100.f, 100.f};
+    std::vector<float> RGBA32F(NumTestTexels * 4);
+    for (float& f : RGBA32F)
+        f = rnd();
+    RGBA32F[0] = 0;
+    RGBA32F[1] = 1e-6f;
+    RGBA32F[2] = -1e6f;
+    RGBA32F[3] = std::numeric_limits<float>::infinity();
+
+    // RGBA16F
+    {
+        std::vector<Uint16> RGBA16F(NumTestTexels * 4);
+        ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGBA32_FLOAT, RGBA32F.data(), TEX_FORMAT_RGBA16_FLOAT, RGBA16F.data(), NumTestTexels));
+        for (size_t i = 0; i < RGBA32F.size(); ++i)
+            EXPECT_EQ(RGBA16F[i], FloatToHalf(RGBA32F[i])) << i;
+
+        std::vector<float> Unpacked(NumTestTexels * 4);
+        ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGBA16_FLOAT, RGBA16F.data(), TEX_FORMAT_RGBA32_FLOAT, Unpacked.data(), NumTestTexels));
+        for (size_t i = 0; i < RGBA32F.size(); ++i)
+            EXPECT_EQ(Unpacked[i], HalfToFloat(RGBA16F[i])) << i;
+    }
+
+    // RGB32F
+    {
+        std::vector<float> RGB32F(NumTestTexels * 3);
+        ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGBA32_FLOAT, RGBA32F.data(), TEX_FORMAT_RGB32_FLOAT, RGB32F.data(), NumTestTexels));
+
+        std::vector<Uint16> RGBA16F(NumTestTexels * 4);
+        ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGB32_FLOAT, RGB32F.data(), TEX_FORMAT_RGBA16_FLOAT, RGBA16F.data(), NumTestTexels));
+        for (size_t t = 0; t < NumTestTexels; ++t)
+        {
+            for (size_t c = 0; c < 4; ++c)
+                EXPECT_EQ(RGBA16F[t * 4 + c], c < 3 ? FloatToHalf(RGBA32F[t * 4 + c]) : 0x3C00);
+        }
+    }
+
+    // R11G11B10F and RGB9E5
+    {
+        std::vector<Uint32> Packed(NumTestTexels);
+        ASSERT_TRUE(ConvertTexels(TEX_FORMAT_RGBA32_FLOAT, RGBA32F.data(), TEX_FORMAT_R11G11B10_FLOAT, Packed.data(), NumTestTexels));
+        for (size_t t = 0; t < NumTestTexels; ++t)
+            EXPECT_EQ(Packed[t], PackR11G11B10F(float3{RGBA32F[t * 4 + 0], RGBA32F[t * 4 + 1], RGBA32F[t * 4 + 2]}));
+
+        std::vector<Uint32> RGB9E5(NumTestTexels);
+        ASSERT_TRUE(ConvertTexels(TEX_FORMAT_R11G11B10_FLOAT, Packed.data(), TEX_FORMAT_RGB9E5_SHAREDEXP, RGB9E5.data(), NumTestTexels));
+        for (size_t t = 0; t < NumTestTexels; ++t)
+            EXPECT_EQ(RGB9E5[t], PackRGB9E5(UnpackR11G11B10F(Packed[t])));
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, ConvertTextureData)
+{
+    constexpr Uint32 Width     = 13;
+    constexpr Uint32 Height    = 5;
+    constexpr size_t SrcStride = Width * 4 + 12;
+    constexpr size_t DstStride = Width * 8 + 6;
+
+    std::vector<Uint8> SrcData(SrcStride * Height);
+    for (size_t i = 0; i < SrcData.size(); ++i)
+        SrcData[i] = static_cast<Uint8>(i * 13);
+
+    std::vector<Uint8> DstData(DstStride * Height, 0xCD);
+
+    ConvertTextureDataAttribs Attribs;
+    Attribs.Width     = Width;
+    Attribs.Height    = Height;
+    Attribs.SrcFormat = TEX_FORMAT_BGRA8_UNORM;
+    Attribs.pSrcData  = SrcData.data();
+    Attribs.SrcStride = SrcStride;
+    Attribs.DstFormat = TEX_FORMAT_RGBA16_FLOAT;
+    Attribs.pDstData  = DstData.data();
+    Attribs.DstStride = DstStride;
+    ASSERT_TRUE(ConvertTextureData(Attribs));
+
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        const Uint8* pSrcRow = SrcData.data() + y * SrcStride;
+        const Uint8* pDstRow = DstData.data() + y * DstStride;
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                Uint16 h;
+                memcpy(&h, pDstRow + (x * 4 + c) * 2, sizeof(h));
+                EXPECT_EQ(h, FloatToHalf(pSrcRow[x * 4 + (c < 3 ? 2 - c : c)] / 255.f));
+            }
+        }
+        // Padding must not be touched
+        for (size_t i = Width * 8; i < DstStride; ++i)
+            EXPECT_EQ(pDstRow[i], 0xCD);
+    }
+}
+
+TEST(GraphicsAccessories_TextureFormatConversion, ExpandRGB8ToRGBA8)
+{
+    std::vector<Uint8> RGB8(NumTestTexels * 3);
+    for (size_t i = 0; i < RGB8.size(); ++i)
+        RGB8[i] = static_cast<Uint8>(i * 3);
+
+    std::vector<Uint8> RGBA8(NumTestTexels * 4);
+    ExpandRGB8ToRGBA8(RGB8.data(), RGBA8.data(), NumTestTexels, 200);
+    for (size_t t = 0; t < NumTestTexels; ++t)
+    {
+        for (size_t c = 0; c < 3; ++c)
+            EXPECT_EQ(RGBA8[t * 4 + c], RGB8[t * 3 + c]);
+        EXPECT_EQ(RGBA8[t * 4 + 3], 200);
+    }
+}
+
+} // namespace
@@ -118,6 +118,9 @@ TEST(GraphicsTypesXTest, SubpassDescX)
     Ref.pShadingRateAttachment  = &ShadingRate;
     TestCtorsAndAssignments<SubpassDescX>(Ref);
 
+    Ref.ViewMask = 0x3;
+    TestCtorsAndAssignments<SubpassDescX>(Ref);
+
     SubpassDescX DescCopy;
     SubpassDescX DescMove;
     SubpassDesc  Ref2;
@@ -132,7 +135,8 @@ TEST(GraphicsTypesXTest, SubpassDescX)
             .SetShadingRate(&ShadingRate)
             .AddPreserve(Preserves[0])
             .AddPreserve(Preserves[1])
-            .AddPreserve(Preserves[2]);
+            .AddPreserve(Preserves[2])
+            .SetViewMask(0x3);
         EXPECT_EQ(DescX, Ref);
 
         DescX.ClearRenderTargets();
@@ -821,8 +825,8 @@ struct DumyShader final : IShader
 {
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final {}
 
-    virtual ReferenceCounterValueType DILIGENT_CALL_TYPE AddRef() override final { return 0; }
-    virtual ReferenceCounterValueType DILIGENT_CALL_TYPE Release() override final { return 0; }
+    virtual ReferenceCounterValueType DILIGENT_CALL_TYPE AddRef() override final { return ++RefCount; }
+    virtual ReferenceCounterValueType DILIGENT_CALL_TYPE Release() override final { return --RefCount; }
     virtual IReferenceCounters* DILIGENT_CALL_TYPE       GetReferenceCounters() const override final { return nullptr; }
 
     virtual const ShaderDesc& DILIGENT_CALL_TYPE GetDesc() const override final
@@ -846,6 +850,8 @@ struct DumyShader final : IShader
     virtual void DILIGENT_CALL_TYPE GetBytecode(const void** ppBytecode, Uint64& Size) const override final {}
 
     virtual SHADER_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final { return SHADER_STATUS_UNINITIALIZED; }
+
+    ReferenceCounterValueType RefCount = 0;
 };
 
 TEST(GraphicsTypesXTest, RayTracingPipelineStateCreateInfoX)
@@ -1160,6 +1166,116 @@ TEST(GraphicsTypesXTest, TilePipelineStateCreateInfoX)
     EXPECT_EQ(DescX, Ref);
 }
 
+TEST(GraphicsTypesXTest, GraphicsPipelineStateCreateInfoCopy)
+{
+    {
+        GraphicsPipelineStateCreateInfoCopy EmptyCopy{GraphicsPipelineStateCreateInfo{}};
+        EXPECT_EQ(EmptyCopy.Get(), GraphicsPipelineStateCreateInfo{});
+    }
+
+    DumyShader VS, PS;
+
+    GraphicsPipelineStateCreateInfo Ref;
+    Ref.PSODesc.Name = "Graphics PSO copy test";
+    Ref.pVS          = &VS;
+    Ref.pPS          = &PS;
+
+    GraphicsPipelineStateCreateInfoCopy Copy;
+    {
+        StringPool Pool;
+
+        const ShaderResourceVariableDesc Variables[] = {
+            {SHADER_TYPE_VERTEX, Pool("Var1"), SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+            {SHADER_TYPE_PIXEL, Pool("Var2"), SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        };
+        const ImmutableSamplerDesc ImtblSamplers[] = {
+            {SHADER_TYPE_PIXEL, Pool("Sampler"), SamplerDesc{}},
+        };
+        const LayoutElement Elements[] = {
+            {Pool("ATTRIB"), 0u, 0u, 3u, VT_FLOAT32},
+            {Pool("ATTRIB"), 1u, 1u, 4u, VT_FLOAT32},
+        };
+
+        GraphicsPipelineStateCreateInfo CI = Ref;
+        CI.PSODesc.Name                               = Pool("Graphics PSO copy test");
+        CI.PSODesc.ResourceLayout.Variables           = Variables;
+        CI.PSODesc.ResourceLayout.NumVariables        = _countof(Variables);
+        CI.PSODesc.ResourceLayout.ImmutableSamplers   = ImtblSamplers;
+        CI.PSODesc.ResourceLayout.NumImmutableSamplers = _countof(ImtblSamplers);
+        CI.GraphicsPipeline.InputLayout               = {Elements, _countof(Elements)};
+
+        Copy = GraphicsPipelineStateCreateInfoCopy{CI};
+        EXPECT_GT(Copy.GetMemorySize(), size_t{0});
+        EXPECT_EQ(VS.RefCount, 1);
+        EXPECT_EQ(PS.RefCount, 1);
+
+        // Compare with the data that is still alive
+        EXPECT_EQ(Copy.Get(), CI);
+        EXPECT_NE(Copy->PSODesc.Name, CI.PSODesc.Name);
+        EXPECT_NE(Copy->GraphicsPipeline.InputLayout.LayoutElements, CI.GraphicsPipeline.InputLayout.LayoutElements);
+
+        Pool.Clear();
+    }
+    EXPECT_STREQ(Copy->PSODesc.Name, "Graphics PSO copy test");
+    ASSERT_EQ(Copy->PSODesc.ResourceLayout.NumVariables, 2u);
+    EXPECT_STREQ(Copy->PSODesc.ResourceLayout.Variables[0].Name, "Var1");
+    EXPECT_STREQ(Copy->PSODesc.ResourceLayout.Variables[1].Name, "Var2");
+    EXPECT_EQ(Copy->PSODesc.ResourceLayout.Variables[1].Type, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    ASSERT_EQ(Copy->PSODesc.ResourceLayout.NumImmutableSamplers, 1u);
+    EXPECT_STREQ(Copy->PSODesc.ResourceLayout.ImmutableSamplers[0].SamplerOrTextureName, "Sampler");
+    ASSERT_EQ(Copy->GraphicsPipeline.InputLayout.NumElements, 2u);
+    EXPECT_STREQ(Copy->GraphicsPipeline.InputLayout.LayoutElements[0].HLSLSemantic, "ATTRIB");
+    EXPECT_EQ(Copy->GraphicsPipeline.InputLayout.LayoutElements[1].NumComponents, 4u);
+
+    GraphicsPipelineStateCreateInfoCopy Moved{std::move(Copy)};
+    EXPECT_EQ(Copy.Get(), GraphicsPipelineStateCreateInfo{});
+    EXPECT_EQ(Moved->pVS, &VS);
+    EXPECT_EQ(VS.RefCount, 1);
+
+    Moved.Clear();
+    EXPECT_EQ(Moved.Get(), GraphicsPipelineStateCreateInfo{});
+    EXPECT_EQ(VS.RefCount, 0);
+    EXPECT_EQ(PS.RefCount, 0);
+}
+
+TEST(GraphicsTypesXTest, RayTracingPipelineStateCreateInfoCopy)
+{
+    DumyShader Shaders[6];
+
+    RayTracingPipelineStateCreateInfo Ref;
+    Ref.PSODesc.Name = "RT PSO copy test";
+
+    const RayTracingGeneralShaderGroup       GeneralShaders[] = {{"General", &Shaders[0]}};
+    const RayTracingTriangleHitShaderGroup   TriHitShaders[]  = {{"Tri Hit", &Shaders[1], &Shaders[2]}};
+    const RayTracingProceduralHitShaderGroup ProcHitShaders[] = {{"Proc Hit", &Shaders[3], &Shaders[4], &Shaders[5]}};
+
+    Ref.pGeneralShaders          = GeneralShaders;
+    Ref.GeneralShaderCount       = _countof(GeneralShaders);
+    Ref.pTriangleHitShaders      = TriHitShaders;
+    Ref.TriangleHitShaderCount   = _countof(TriHitShaders);
+    Ref.pProceduralHitShaders    = ProcHitShaders;
+    Ref.ProceduralHitShaderCount = _countof(ProcHitShaders);
+    Ref.pShaderRecordName        = "ShaderRecord";
+
+    {
+        RayTracingPipelineStateCreateInfoCopy Copy{Ref};
+        EXPECT_EQ(Copy.Get(), Ref);
+        EXPECT_NE(Copy->pGeneralShaders, Ref.pGeneralShaders);
+        EXPECT_NE(Copy->pProceduralHitShaders[0].Name, Ref.pProceduralHitShaders[0].Name);
+        EXPECT_STREQ(Copy->pShaderRecordName, "ShaderRecord");
+        for (const DumyShader& Shader : Shaders)
+            EXPECT_EQ(Shader.RefCount, 1);
+
+        RayTracingPipelineStateCreateInfoCopy Copy2;
+        Copy2 = std::move(Copy);
+        EXPECT_EQ(Copy2.Get(), Ref);
+        for (const DumyShader& Shader : Shaders)
+            EXPECT_EQ(Shader.RefCount, 1);
+    }
+    for (const DumyShader& Shader : Shaders)
+        EXPECT_EQ(Shader.RefCount, 0);
+}
+
 TEST(GraphicsTypesXTest, RenderDeviceX)
 {
     constexpr bool Execute = false;
@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ResourceMappingImpl.hpp"
+
+#include <thread>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <algorithm>
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "ObjectBase.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class DummyDeviceObject final : public ObjectBase<IDeviceObject>
+{
+public:
+    explicit DummyDeviceObject(IReferenceCounters* pRefCounters) :
+        ObjectBase<IDeviceObject>{pRefCounters}
+    {}
+
+    virtual const DeviceObjectAttribs& DILIGENT_CALL_TYPE GetDesc() const override final { return m_Desc; }
+    virtual Int32 DILIGENT_CALL_TYPE                      GetUniqueID() const override final { return 0; }
+    virtual void DILIGENT_CALL_TYPE                       SetUserData(IObject* pUserData) override final {}
+    virtual IObject* DILIGENT_CALL_TYPE                   GetUserData() const override final { return nullptr; }
+
+private:
+    DeviceObjectAttribs m_Desc;
+};
+
+RefCntAutoPtr<IResourceMapping> CreateMapping()
+{
+    return RefCntAutoPtr<IResourceMapping>{MakeNewRCObj<ResourceMappingImpl>()(DefaultRawMemoryAllocator::GetAllocator())};
+}
+
+RefCntAutoPtr<IDeviceObject> CreateObject()
+{
+    return RefCntAutoPtr<IDeviceObject>{MakeNewRCObj<DummyDeviceObject>()()};
+}
+
+TEST(ResourceMappingTest, AddRemove)
+{
+    auto pMapping = CreateMapping();
+    auto pObj0    = CreateObject();
+    auto pObj1    = CreateObject();
+    auto pObj2    = CreateObject();
+
+    EXPECT_EQ(pMapping->GetResource("Tex"), nullptr);
+    EXPECT_EQ(pMapping->GetSize(), size_t{0});
+
+    pMapping->AddResource("Tex", pObj0, false);
+    EXPECT_EQ(pMapping->GetResource("Tex"), pObj0);
+    EXPECT_EQ(pMapping->GetResource("Tex", 1), nullptr);
+    EXPECT_EQ(pMapping->GetResource("Te"), nullptr);
+    EXPECT_EQ(pMapping->GetResource("Tex2"), nullptr);
+
+    IDeviceObject* ppObjects[] = {pObj1, pObj2};
+    pMapping->AddResourceArray("Arr", 1, ppObjects, 2, false);
+    EXPECT_EQ(pMapping->GetSize(), size_t{3});
+    EXPECT_EQ(pMapping->GetResource("Arr", 0), nullptr);
+    EXPECT_EQ(pMapping->GetResource("Arr", 1), pObj1);
+    EXPECT_EQ(pMapping->GetResource("Arr", 2), pObj2);
+
+    // Replace the existing resource
+    pMapping->AddResource("Tex", pObj2, false);
+    EXPECT_EQ(pMapping->GetResource("Tex"), pObj2);
+    EXPECT_EQ(pMapping->GetSize(), size_t{3});
+
+    pMapping->RemoveResourceByName("Arr", 1);
+    EXPECT_EQ(pMapping->GetResource("Arr", 1), nullptr);
+    EXPECT_EQ(pMapping->GetResource("Arr", 2), pObj2);
+    EXPECT_EQ(pMapping->GetSize(), size_t{2});
+
+    // Removing the resource must release the reference
+    pMapping->RemoveResourceByName("Tex");
+    pMapping->RemoveResourceByName("Arr", 2);
+    EXPECT_EQ(pMapping->GetSize(), size_t{0});
+    EXPECT_EQ(pObj2->GetReferenceCounters()->GetNumStrongRefs(), 1);
+    EXPECT_EQ(pMapping->GetResource("Tex"), nullptr);
+}
+
+TEST(ResourceMappingTest, ManyResources)
+{
+    auto pMapping = CreateMapping();
+
+    constexpr Uint32 NumResources = 1000;
+
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        Objects.emplace_back(CreateObject());
+        pMapping->AddResource(("Resource" + std::to_string(i)).c_str(), Objects.back(), true);
+        // Interleave reads and writes to rebuild the snapshot
+        if (i % 100 == 0)
+            EXPECT_EQ(pMapping->GetResource(("Resource" + std::to_string(i)).c_str()), Objects[i]);
+    }
+
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        const auto Name = "Resource" + std::to_string(i);
+        EXPECT_EQ(pMapping->GetResource(Name.c_str()), Objects[i]);
+        EXPECT_EQ(pMapping->GetResource(Name.c_str(), 1), nullptr);
+    }
+}
+
+TEST(ResourceMappingTest, ConcurrentReadWrite)
+{
+    auto pMapping = CreateMapping();
+
+    constexpr Uint32 NumStaticResources = 64;
+
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    std::vector<std::string>                  Names;
+    for (Uint32 i = 0; i < NumStaticResources; ++i)
+    {
+        Objects.emplace_back(CreateObject());
+        Names.emplace_back("Static" + std::to_string(i));
+        pMapping->AddResource(Names.back().c_str(), Objects.back(), true);
+    }
+    auto pDynamicObj = CreateObject();
+
+    std::atomic<bool> Stop{false};
+
+    const Uint32 NumReaders = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    std::vector<std::thread> Readers;
+    std::atomic<Uint32>      NumErrors{0};
+    for (Uint32 t = 0; t < NumReaders; ++t)
+    {
+        Readers.emplace_back([&]() {
+            while (!Stop.load())
+            {
+                for (Uint32 i = 0; i < NumStaticResources; ++i)
+                {
+                    if (pMapping->GetResource(Names[i].c_str()) != Objects[i])
+                        NumErrors.fetch_add(1);
+                }
+                auto* pObj = pMapping->GetResource("Dynamic");
+                if (pObj != nullptr && pObj != pDynamicObj)
+                    NumErrors.fetch_add(1);
+            }
+        });
+    }
+
+    for (Uint32 i = 0; i < 2000; ++i)
+    {
+        if (i % 2 == 0)
+            pMapping->AddResource("Dynamic", pDynamicObj, false);
+        else
+            pMapping->RemoveResourceByName("Dynamic");
+    }
+
+    Stop.store(true);
+    for (auto& Thread : Readers)
+        Thread.join();
+
+    EXPECT_EQ(NumErrors.load(), 0u);
+}
+
+} // namespace
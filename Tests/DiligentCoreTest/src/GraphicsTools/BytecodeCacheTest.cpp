@@ -27,9 +27,13 @@
 #include "BytecodeCache.h"
 #include "DataBlobImpl.hpp"
 #include "DefaultShaderSourceStreamFactory.h"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "TempDirectory.hpp"
 #include "gtest/gtest.h"
 
 using namespace Diligent;
+using namespace Diligent::Testing;
 
 namespace
 {
@@ -186,4 +190,125 @@ TEST(BytecodeCacheTest, Include)
     }
 }
 
+ShaderCreateInfo GetTestShaderCI(const char* Source)
+{
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "TestName";
+    ShaderCI.Source          = Source;
+    return ShaderCI;
+}
+
+TEST(BytecodeCacheTest, Directory)
+{
+    TempDirectory TmpDir;
+
+    BytecodeCacheCreateInfo CacheCI;
+    CacheCI.DeviceType     = RENDER_DEVICE_TYPE_VULKAN;
+    CacheCI.CacheDirectory = TmpDir.Get().c_str();
+
+    const ShaderCreateInfo ShaderCI0 = GetTestShaderCI("SomeCode0");
+    const ShaderCreateInfo ShaderCI1 = GetTestShaderCI("SomeCode1");
+    const std::string      Data{"TestString"};
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        pCache->AddBytecode(ShaderCI0, DataBlobImpl::Create(Data.length(), Data.c_str()));
+        pCache->AddBytecode(ShaderCI1, DataBlobImpl::Create(Data.length(), Data.c_str()));
+    }
+
+    auto Files = FileSystem::Search((TmpDir.Get() + FileSystem::SlashSymbol + '*').c_str());
+    ASSERT_EQ(Files.size(), size_t{2});
+
+    {
+        // Another cache instance must find the byte code in the directory
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(ShaderCI0, &pBytecode);
+        ASSERT_NE(pBytecode, nullptr);
+        ASSERT_EQ(pBytecode->GetSize(), Data.length());
+        EXPECT_EQ(memcmp(pBytecode->GetConstDataPtr(), Data.c_str(), Data.length()), 0);
+
+        pCache->RemoveBytecode(ShaderCI0);
+        Files = FileSystem::Search((TmpDir.Get() + FileSystem::SlashSymbol + '*').c_str());
+        ASSERT_EQ(Files.size(), size_t{1});
+    }
+
+    // Corrupt the remaining file
+    {
+        const std::string Path = TmpDir.Get() + FileSystem::SlashSymbol + Files[0].Name;
+        const std::string Garbage{"Garbage"};
+        EXPECT_TRUE(FileWrapper::WriteFile(Path.c_str(), Garbage.c_str(), Garbage.length()));
+    }
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(ShaderCI1, &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr);
+
+        // Corrupted file must be deleted
+        Files = FileSystem::Search((TmpDir.Get() + FileSystem::SlashSymbol + '*').c_str());
+        EXPECT_TRUE(Files.empty());
+    }
+}
+
+TEST(BytecodeCacheTest, DirectorySizeLimit)
+{
+    TempDirectory TmpDir;
+
+    constexpr Uint32 NumShaders   = 5;
+    constexpr size_t BytecodeSize = 1024;
+    const auto       GetFileCount = [&]() {
+        return FileSystem::Search((TmpDir.Get() + FileSystem::SlashSymbol + '*').c_str()).size();
+    };
+
+    BytecodeCacheCreateInfo CacheCI;
+    CacheCI.DeviceType       = RENDER_DEVICE_TYPE_VULKAN;
+    CacheCI.CacheDirectory   = TmpDir.Get().c_str();
+    CacheCI.MaxDirectorySize = 4 * (BytecodeSize + 64);
+
+    RefCntAutoPtr<IBytecodeCache> pCache;
+    CreateBytecodeCache(CacheCI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    std::vector<std::string> Sources(NumShaders);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+        Sources[i] = "SomeCode" + std::to_string(i);
+
+    const std::vector<Uint8> Data(BytecodeSize, 0xAB);
+    for (Uint32 i = 0; i < 4; ++i)
+        pCache->AddBytecode(GetTestShaderCI(Sources[i].c_str()), DataBlobImpl::Create(Data.size(), Data.data()));
+    EXPECT_EQ(GetFileCount(), size_t{4});
+
+    // Use the first shader so that it becomes the most recently used one
+    {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(GetTestShaderCI(Sources[0].c_str()), &pBytecode);
+        EXPECT_NE(pBytecode, nullptr);
+    }
+
+    // Shader 1 is now the least recently used one and must be evicted
+    pCache->AddBytecode(GetTestShaderCI(Sources[4].c_str()), DataBlobImpl::Create(Data.size(), Data.data()));
+    EXPECT_EQ(GetFileCount(), size_t{4});
+
+    pCache.Release();
+    CreateBytecodeCache(CacheCI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(GetTestShaderCI(Sources[i].c_str()), &pBytecode);
+        EXPECT_EQ(pBytecode != nullptr, i != 1) << i;
+    }
+}
+
 } // namespace
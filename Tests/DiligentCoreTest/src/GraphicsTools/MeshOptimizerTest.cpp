@@ -0,0 +1,227 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "GeometryPrimitives.h"
+#include "DataBlob.h"
+#include "BasicMath.hpp"
+#include "FastRand.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestMesh
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+
+    explicit TestMesh(Uint32 NumSubdivisions)
+    {
+        RefCntAutoPtr<IDataBlob> pVertices;
+        RefCntAutoPtr<IDataBlob> pIndices;
+        GeometryPrimitiveInfo    Info;
+        CreateGeometryPrimitive(SphereGeometryPrimitiveAttributes{1.f, GEOMETRY_PRIMITIVE_VERTEX_FLAG_POSITION, NumSubdivisions},
+                                &pVertices, &pIndices, &Info);
+
+        const float3* pPos = static_cast<const float3*>(pVertices->GetConstDataPtr());
+        Positions.assign(pPos, pPos + Info.NumVertices);
+
+        const Uint32* pIdx = static_cast<const Uint32*>(pIndices->GetConstDataPtr());
+        Indices.assign(pIdx, pIdx + Info.NumIndices);
+    }
+
+    OptimizeMeshAttribs GetAttribs()
+    {
+        OptimizeMeshAttribs Attribs;
+        Attribs.pIndices    = Indices.data();
+        Attribs.NumIndices  = static_cast<Uint32>(Indices.size());
+        Attribs.NumVertices = static_cast<Uint32>(Positions.size());
+        Attribs.pPositions  = Positions.data();
+        return Attribs;
+    }
+
+    // Shuffles the triangles to produce an index buffer with poor locality
+    void ShuffleTriangles()
+    {
+        FastRand Rnd{0};
+
+        const size_t NumTriangles = Indices.size() / 3;
+        for (size_t t = NumTriangles - 1; t > 0; --t)
+        {
+            const size_t Other = static_cast<size_t>(Rnd()) % (t + 1);
+            for (size_t i = 0; i < 3; ++i)
+                std::swap(Indices[t * 3 + i], Indices[Other * 3 + i]);
+        }
+    }
+
+    // Returns the sorted list of triangles defined by vertex positions
+    std::vector<std::array<float, 9>> GetTriangles() const
+    {
+        std::vector<std::array<float, 9>> Triangles(Indices.size() / 3);
+        for (size_t t = 0; t < Triangles.size(); ++t)
+        {
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const float3& Pos       = Positions[Indices[t * 3 + i]];
+                Triangles[t][i * 3 + 0] = Pos.x;
+                Triangles[t][i * 3 + 1] = Pos.y;
+                Triangles[t][i * 3 + 2] = Pos.z;
+            }
+        }
+        std::sort(Triangles.begin(), Triangles.end());
+        return Triangles;
+    }
+};
+
+TEST(MeshOptimizerTest, VertexCache)
+{
+    TestMesh Mesh{32};
+    Mesh.ShuffleTriangles();
+
+    const std::vector<std::array<float, 9>> RefTriangles = Mesh.GetTriangles();
+
+    OptimizeMeshAttribs Attribs = Mesh.GetAttribs();
+
+    const float ShuffledACMR = ComputeVertexCacheMissRatio(Attribs);
+    ASSERT_TRUE(OptimizeVertexCache(Attribs));
+    const float OptimizedACMR = ComputeVertexCacheMissRatio(Attribs);
+
+    // The ideal ratio for a regular grid is 0.5
+    EXPECT_GT(ShuffledACMR, 2.f);
+    EXPECT_LT(OptimizedACMR, 0.9f);
+    EXPECT_EQ(Mesh.GetTriangles(), RefTriangles);
+}
+
+TEST(MeshOptimizerTest, Overdraw)
+{
+    for (bool FrontCounterClockwise : {false, true})
+    {
+        TestMesh Mesh{32};
+        Mesh.ShuffleTriangles();
+
+        const std::vector<std::array<float, 9>> RefTriangles = Mesh.GetTriangles();
+
+        OptimizeMeshAttribs Attribs   = Mesh.GetAttribs();
+        Attribs.FrontCounterClockwise = FrontCounterClockwise;
+        ASSERT_TRUE(OptimizeVertexCache(Attribs));
+        const float VertexCacheACMR = ComputeVertexCacheMissRatio(Attribs);
+
+        ASSERT_TRUE(OptimizeOverdraw(Attribs));
+        EXPECT_LT(ComputeVertexCacheMissRatio(Attribs), VertexCacheACMR * 1.25f);
+        EXPECT_EQ(Mesh.GetTriangles(), RefTriangles);
+    }
+}
+
+TEST(MeshOptimizerTest, VertexFetch)
+{
+    TestMesh Mesh{16};
+    Mesh.ShuffleTriangles();
+
+    const std::vector<std::array<float, 9>> RefTriangles = Mesh.GetTriangles();
+
+    std::vector<float3> Normals = Mesh.Positions;
+
+    OptimizeMeshAttribs Attribs = Mesh.GetAttribs();
+
+    std::vector<Uint32> Remap(Mesh.Positions.size());
+    ASSERT_TRUE(OptimizeVertexFetch(Attribs, Mesh.Positions.data(), sizeof(float3), Remap.data()));
+    ASSERT_TRUE(RemapVertices(Normals.data(), sizeof(float3), static_cast<Uint32>(Normals.size()), Remap.data()));
+
+    EXPECT_EQ(Mesh.GetTriangles(), RefTriangles);
+    EXPECT_EQ(Normals, Mesh.Positions);
+
+    // The vertices must be in the order of the first use
+    Uint32 NextVertex = 0;
+    for (Uint32 Index : Mesh.Indices)
+    {
+        ASSERT_LE(Index, NextVertex);
+        if (Index == NextVertex)
+            ++NextVertex;
+    }
+}
+
+TEST(MeshOptimizerTest, Index16)
+{
+    TestMesh Mesh{16};
+    Mesh.ShuffleTriangles();
+
+    std::vector<Uint16> Indices16(Mesh.Indices.begin(), Mesh.Indices.end());
+
+    OptimizeMeshAttribs Attribs = Mesh.GetAttribs();
+    ASSERT_TRUE(OptimizeVertexCache(Attribs));
+    ASSERT_TRUE(OptimizeOverdraw(Attribs));
+
+    Attribs.pIndices  = Indices16.data();
+    Attribs.IndexType = VT_UINT16;
+    ASSERT_TRUE(OptimizeVertexCache(Attribs));
+    ASSERT_TRUE(OptimizeOverdraw(Attribs));
+
+    EXPECT_TRUE(std::equal(Indices16.begin(), Indices16.end(), Mesh.Indices.begin()));
+}
+
+TEST(MeshOptimizerTest, Parallel)
+{
+    // The mesh is large enough to be split into multiple ranges.
+    // The triangles are not shuffled since the ranges are optimized independently.
+    TestMesh Mesh{128};
+
+    std::vector<Uint32>       RefIndices   = Mesh.Indices;
+    const std::vector<float3> RefPositions = Mesh.Positions;
+
+    OptimizeMeshAttribs Attribs = Mesh.GetAttribs();
+    Attribs.pIndices            = RefIndices.data();
+
+    const float OriginalACMR = ComputeVertexCacheMissRatio(Attribs);
+    ASSERT_TRUE(OptimizeVertexCache(Attribs));
+    ASSERT_TRUE(OptimizeOverdraw(Attribs));
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    Attribs.pIndices                       = Mesh.Indices.data();
+    Attribs.pThreadPool                    = pThreadPool;
+    ASSERT_TRUE(OptimizeVertexCache(Attribs));
+    ASSERT_TRUE(OptimizeOverdraw(Attribs));
+    EXPECT_EQ(Mesh.Indices, RefIndices);
+    EXPECT_LT(ComputeVertexCacheMissRatio(Attribs), OriginalACMR);
+
+    std::vector<Uint32> Remap(Mesh.Positions.size());
+    ASSERT_TRUE(OptimizeVertexFetch(Attribs, Mesh.Positions.data(), sizeof(float3), Remap.data()));
+    for (size_t v = 0; v < RefPositions.size(); ++v)
+        EXPECT_EQ(Mesh.Positions[Remap[v]], RefPositions[v]);
+}
+
+} // namespace
@@ -0,0 +1,240 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "MeshletBuilder.hpp"
+
+#include <vector>
+
+#include "GeometryPrimitives.h"
+#include "DataBlob.h"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+struct TestMesh
+{
+    RefCntAutoPtr<IDataBlob> pVertices;
+    RefCntAutoPtr<IDataBlob> pIndices;
+    GeometryPrimitiveInfo    Info;
+
+    BuildMeshletsAttribs GetAttribs() const
+    {
+        BuildMeshletsAttribs Attribs;
+        Attribs.pPositions     = pVertices->GetConstDataPtr();
+        Attribs.PositionStride = Info.VertexSize;
+        Attribs.NumVertices    = Info.NumVertices;
+        Attribs.pIndices       = pIndices->GetConstDataPtr();
+        Attribs.NumIndices     = Info.NumIndices;
+        return Attribs;
+    }
+
+    float3 GetPosition(Uint32 Vertex) const
+    {
+        return *reinterpret_cast<const float3*>(static_cast<const Uint8*>(pVertices->GetConstDataPtr()) + size_t{Vertex} * Info.VertexSize);
+    }
+
+    Uint32 GetIndex(Uint32 i) const
+    {
+        return static_cast<const Uint32*>(pIndices->GetConstDataPtr())[i];
+    }
+};
+
+TestMesh CreateSphere(Uint32 NumSubdivisions)
+{
+    TestMesh Mesh;
+    CreateGeometryPrimitive(SphereGeometryPrimitiveAttributes{1.f, GEOMETRY_PRIMITIVE_VERTEX_FLAG_POS_NORM, NumSubdivisions},
+                            &Mesh.pVertices, &Mesh.pIndices, &Mesh.Info);
+    return Mesh;
+}
+
+void VerifyMeshlets(const TestMesh& Mesh, const BuildMeshletsAttribs& Attribs, const MeshletData& Data)
+{
+    ASSERT_FALSE(Data.Meshlets.empty());
+
+    Uint32 NumTriangles = 0;
+    for (const MeshletDesc& Meshlet : Data.Meshlets)
+    {
+        EXPECT_GT(Meshlet.PrimitiveCount, 0u);
+        EXPECT_LE(Meshlet.PrimitiveCount, Attribs.MaxPrimitives);
+        EXPECT_LE(Meshlet.VertexCount, Attribs.MaxVertices);
+        ASSERT_LE(Meshlet.VertexOffset + Meshlet.VertexCount, Data.VertexIndices.size());
+        ASSERT_LE(Meshlet.PrimitiveOffset + Meshlet.PrimitiveCount, Data.PrimitiveIndices.size());
+
+        for (Uint32 p = 0; p < Meshlet.PrimitiveCount; ++p)
+        {
+            const Uint32 Packed = Data.PrimitiveIndices[Meshlet.PrimitiveOffset + p];
+            for (Uint32 i = 0; i < 3; ++i)
+            {
+                const Uint32 LocalIdx = (Packed >> (i * 8)) & 0xFFu;
+                ASSERT_LT(LocalIdx, Meshlet.VertexCount);
+
+                // Meshlets must reproduce the original triangles in the original order
+                const Uint32 Vertex = Data.VertexIndices[Meshlet.VertexOffset + LocalIdx];
+                EXPECT_EQ(Vertex, Mesh.GetIndex(NumTriangles * 3 + i));
+
+                const float3 Pos = Mesh.GetPosition(Vertex);
+                EXPECT_LE(length(Pos - Meshlet.Center), Meshlet.Radius * 1.0001f + 1e-6f);
+            }
+            ++NumTriangles;
+        }
+    }
+    EXPECT_EQ(NumTriangles * 3, Mesh.Info.NumIndices);
+}
+
+TEST(MeshletBuilderTest, Sphere)
+{
+    const TestMesh Mesh = CreateSphere(16);
+
+    for (Uint32 MaxVertices : {64u, 128u, 256u})
+    {
+        BuildMeshletsAttribs Attribs = Mesh.GetAttribs();
+        Attribs.MaxVertices          = MaxVertices;
+        Attribs.MaxPrimitives        = MaxVertices == 64 ? 124 : 256;
+
+        MeshletData Data;
+        ASSERT_TRUE(BuildMeshlets(Attribs, Data));
+        VerifyMeshlets(Mesh, Attribs, Data);
+    }
+}
+
+TEST(MeshletBuilderTest, Index16)
+{
+    const TestMesh Mesh = CreateSphere(8);
+
+    std::vector<Uint16> Indices16(Mesh.Info.NumIndices);
+    for (Uint32 i = 0; i < Mesh.Info.NumIndices; ++i)
+        Indices16[i] = static_cast<Uint16>(Mesh.GetIndex(i));
+
+    BuildMeshletsAttribs Attribs = Mesh.GetAttribs();
+
+    MeshletData Data32;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Data32));
+
+    Attribs.pIndices  = Indices16.data();
+    Attribs.IndexType = VT_UINT16;
+
+    MeshletData Data16;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Data16));
+
+    EXPECT_EQ(Data16.VertexIndices, Data32.VertexIndices);
+    EXPECT_EQ(Data16.PrimitiveIndices, Data32.PrimitiveIndices);
+}
+
+TEST(MeshletBuilderTest, NormalCone)
+{
+    const TestMesh Mesh = CreateSphere(16);
+
+    for (bool FrontCounterClockwise : {false, true})
+    {
+        BuildMeshletsAttribs Attribs  = Mesh.GetAttribs();
+        Attribs.FrontCounterClockwise = FrontCounterClockwise;
+
+        MeshletData Data;
+        ASSERT_TRUE(BuildMeshlets(Attribs, Data));
+
+        FastRandFloat Rnd{0, -5.f, 5.f};
+
+        Uint32 NumCulled = 0;
+        for (Uint32 test = 0; test < 64; ++test)
+        {
+            const float3 CameraPos{Rnd(), Rnd(), Rnd()};
+            for (const MeshletDesc& Meshlet : Data.Meshlets)
+            {
+                if (dot(normalize(Meshlet.ConeApex - CameraPos), Meshlet.ConeAxis) < Meshlet.ConeCutoff)
+                    continue;
+
+                // All triangles of the culled meshlet must be back-facing
+                ++NumCulled;
+                for (Uint32 p = 0; p < Meshlet.PrimitiveCount; ++p)
+                {
+                    const Uint32 Packed = Data.PrimitiveIndices[Meshlet.PrimitiveOffset + p];
+                    const float3 P0     = Mesh.GetPosition(Data.VertexIndices[Meshlet.VertexOffset + (Packed & 0xFFu)]);
+                    const float3 P1     = Mesh.GetPosition(Data.VertexIndices[Meshlet.VertexOffset + ((Packed >> 8u) & 0xFFu)]);
+                    const float3 P2     = Mesh.GetPosition(Data.VertexIndices[Meshlet.VertexOffset + ((Packed >> 16u) & 0xFFu)]);
+
+                    float3 N = cross(P1 - P0, P2 - P0);
+                    if (FrontCounterClockwise)
+                        N = -N;
+                    EXPECT_LE(dot(CameraPos - P0, N), 1e-5f);
+                }
+            }
+        }
+        // About half of the sphere is back-facing for any camera position
+        EXPECT_GT(NumCulled, 0u);
+    }
+}
+
+TEST(MeshletBuilderTest, Parallel)
+{
+    // The mesh is large enough to be split into multiple ranges
+    const TestMesh Mesh = CreateSphere(64);
+
+    BuildMeshletsAttribs Attribs = Mesh.GetAttribs();
+
+    MeshletData RefData;
+    ASSERT_TRUE(BuildMeshlets(Attribs, RefData));
+    VerifyMeshlets(Mesh, Attribs, RefData);
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    Attribs.pThreadPool                    = pThreadPool;
+
+    MeshletData Data;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Data));
+    EXPECT_EQ(Data.VertexIndices, RefData.VertexIndices);
+    EXPECT_EQ(Data.PrimitiveIndices, RefData.PrimitiveIndices);
+    ASSERT_EQ(Data.Meshlets.size(), RefData.Meshlets.size());
+    for (size_t i = 0; i < Data.Meshlets.size(); ++i)
+    {
+        EXPECT_EQ(Data.Meshlets[i].VertexOffset, RefData.Meshlets[i].VertexOffset);
+        EXPECT_EQ(Data.Meshlets[i].PrimitiveOffset, RefData.Meshlets[i].PrimitiveOffset);
+        EXPECT_EQ(Data.Meshlets[i].Center, RefData.Meshlets[i].Center);
+        EXPECT_EQ(Data.Meshlets[i].ConeAxis, RefData.Meshlets[i].ConeAxis);
+    }
+}
+
+TEST(MeshletBuilderTest, InvalidInput)
+{
+    const TestMesh Mesh = CreateSphere(2);
+
+    BuildMeshletsAttribs Attribs = Mesh.GetAttribs();
+    Attribs.NumVertices          = 3;
+
+    MeshletData Data;
+    TestingEnvironment::ErrorScope ExpectedErrors{"is out of range"};
+    EXPECT_FALSE(BuildMeshlets(Attribs, Data));
+}
+
+} // namespace
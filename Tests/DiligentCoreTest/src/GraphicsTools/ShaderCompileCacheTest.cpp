@@ -0,0 +1,208 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <string>
+#include <cstring>
+#include <algorithm>
+
+#include "ShaderCompileCache.h"
+#include "DataBlobImpl.hpp"
+#include "ObjectBase.hpp"
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+#include "TempDirectory.hpp"
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class TestCompileExecutor final : public ObjectBase<IShaderCompileExecutor>
+{
+public:
+    TestCompileExecutor(IReferenceCounters* pRefCounters, bool Succeed) :
+        ObjectBase<IShaderCompileExecutor>{pRefCounters},
+        m_Succeed{Succeed}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ShaderCompileExecutor, ObjectBase<IShaderCompileExecutor>);
+
+    virtual void DILIGENT_CALL_TYPE Compile(const ShaderCompileJob& Job, IDataBlob** ppByteCode) override final
+    {
+        ++NumCalls;
+        if (!m_Succeed)
+            return;
+
+        // The "byte code" is the reversed job data
+        std::string ByteCode{static_cast<const char*>(Job.pData), static_cast<size_t>(Job.DataSize)};
+        std::reverse(ByteCode.begin(), ByteCode.end());
+        *ppByteCode = DataBlobImpl::Create(ByteCode.length(), ByteCode.data()).Detach();
+    }
+
+    Uint32 NumCalls = 0;
+
+private:
+    const bool m_Succeed;
+};
+
+ShaderCompileJob GetTestJob(const std::string& Data)
+{
+    ShaderCompileJob Job;
+    Job.DeviceFlag = ARCHIVE_DEVICE_DATA_FLAG_VULKAN;
+    Job.pData      = Data.data();
+    Job.DataSize   = Data.length();
+    return Job;
+}
+
+void CheckByteCode(IDataBlob* pByteCode, const std::string& JobData)
+{
+    ASSERT_NE(pByteCode, nullptr);
+    const std::string Expected{JobData.rbegin(), JobData.rend()};
+    ASSERT_EQ(pByteCode->GetSize(), Expected.length());
+    EXPECT_EQ(memcmp(pByteCode->GetConstDataPtr(), Expected.data(), Expected.length()), 0);
+}
+
+TEST(ShaderCompileCacheTest, CacheHit)
+{
+    TempDirectory TmpDir;
+
+    const std::string JobData0{"ShaderCompileJob0"};
+    const std::string JobData1{"ShaderCompileJob1"};
+
+    RefCntAutoPtr<TestCompileExecutor> pRemote{MakeNewRCObj<TestCompileExecutor>()(true)};
+
+    ShaderCompileCacheCreateInfo CacheCI;
+    CacheCI.CacheDirectory = TmpDir.Get().c_str();
+    CacheCI.pExecutor      = pRemote;
+    {
+        RefCntAutoPtr<IShaderCompileExecutor> pCache;
+        CreateShaderCompileCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        for (const std::string* pData : {&JobData0, &JobData1, &JobData0})
+        {
+            RefCntAutoPtr<IDataBlob> pByteCode;
+            pCache->Compile(GetTestJob(*pData), &pByteCode);
+            CheckByteCode(pByteCode, *pData);
+        }
+        EXPECT_EQ(pRemote->NumCalls, 2u);
+    }
+
+    const auto Files = FileSystem::Search((TmpDir.Get() + FileSystem::SlashSymbol + '*').c_str());
+    EXPECT_EQ(Files.size(), size_t{2});
+
+    {
+        // Another cache instance that shares the directory must not use the executor
+        RefCntAutoPtr<TestCompileExecutor> pRemote2{MakeNewRCObj<TestCompileExecutor>()(true)};
+        CacheCI.pExecutor = pRemote2;
+
+        RefCntAutoPtr<IShaderCompileExecutor> pCache;
+        CreateShaderCompileCache(CacheCI, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pByteCode;
+        pCache->Compile(GetTestJob(JobData1), &pByteCode);
+        CheckByteCode(pByteCode, JobData1);
+        EXPECT_EQ(pRemote2->NumCalls, 0u);
+    }
+}
+
+TEST(ShaderCompileCacheTest, CompileFailure)
+{
+    TempDirectory TmpDir;
+
+    RefCntAutoPtr<TestCompileExecutor> pRemote{MakeNewRCObj<TestCompileExecutor>()(false)};
+
+    ShaderCompileCacheCreateInfo CacheCI;
+    CacheCI.CacheDirectory = TmpDir.Get().c_str();
+    CacheCI.pExecutor      = pRemote;
+
+    RefCntAutoPtr<IShaderCompileExecutor> pCache;
+    CreateShaderCompileCache(CacheCI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    const std::string JobData{"ShaderCompileJob"};
+
+    RefCntAutoPtr<IDataBlob> pByteCode;
+    pCache->Compile(GetTestJob(JobData), &pByteCode);
+    EXPECT_EQ(pByteCode, nullptr);
+    EXPECT_EQ(pRemote->NumCalls, 1u);
+
+    // Failed jobs must not be cached
+    EXPECT_TRUE(FileSystem::Search((TmpDir.Get() + FileSystem::SlashSymbol + '*').c_str()).empty());
+}
+
+TEST(ShaderCompileCacheTest, CorruptedFile)
+{
+    TempDirectory TmpDir;
+
+    RefCntAutoPtr<TestCompileExecutor> pRemote{MakeNewRCObj<TestCompileExecutor>()(true)};
+
+    ShaderCompileCacheCreateInfo CacheCI;
+    CacheCI.CacheDirectory = TmpDir.Get().c_str();
+    CacheCI.pExecutor      = pRemote;
+
+    RefCntAutoPtr<IShaderCompileExecutor> pCache;
+    CreateShaderCompileCache(CacheCI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    const std::string JobData{"ShaderCompileJob"};
+    {
+        RefCntAutoPtr<IDataBlob> pByteCode;
+        pCache->Compile(GetTestJob(JobData), &pByteCode);
+        CheckByteCode(pByteCode, JobData);
+    }
+
+    auto Files = FileSystem::Search((TmpDir.Get() + FileSystem::SlashSymbol + '*').c_str());
+    ASSERT_EQ(Files.size(), size_t{1});
+    const std::string Path = TmpDir.Get() + FileSystem::SlashSymbol + Files[0].Name;
+    {
+        const std::string Garbage{"Garbage"};
+        EXPECT_TRUE(FileWrapper::WriteFile(Path.c_str(), Garbage.c_str(), Garbage.length()));
+    }
+
+    // The corrupted file must be ignored and replaced with the new byte code
+    {
+        RefCntAutoPtr<IDataBlob> pByteCode;
+        pCache->Compile(GetTestJob(JobData), &pByteCode);
+        CheckByteCode(pByteCode, JobData);
+        EXPECT_EQ(pRemote->NumCalls, 2u);
+    }
+
+    Files = FileSystem::Search((TmpDir.Get() + FileSystem::SlashSymbol + '*').c_str());
+    ASSERT_EQ(Files.size(), size_t{1});
+    {
+        RefCntAutoPtr<IDataBlob> pByteCode;
+        pCache->Compile(GetTestJob(JobData), &pByteCode);
+        CheckByteCode(pByteCode, JobData);
+        EXPECT_EQ(pRemote->NumCalls, 2u);
+    }
+}
+
+} // namespace
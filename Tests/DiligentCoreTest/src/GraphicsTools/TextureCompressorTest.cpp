@@ -0,0 +1,334 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "TextureCompressor.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "GraphicsAccessories.hpp"
+#include "FastRand.hpp"
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using Texel = std::array<int, 4>;
+
+Texel Expand565(Uint32 Color)
+{
+    const int R = (Color >> 11) & 0x1F;
+    const int G = (Color >> 5) & 0x3F;
+    const int B = Color & 0x1F;
+    return {(R << 3) | (R >> 2), (G << 2) | (G >> 4), (B << 3) | (B >> 2), 255};
+}
+
+void DecodeBC1Block(const Uint8* pBlock, Texel* pTexels)
+{
+    const Uint32 Color0 = pBlock[0] | (pBlock[1] << 8);
+    const Uint32 Color1 = pBlock[2] | (pBlock[3] << 8);
+
+    Texel Palette[4] = {Expand565(Color0), Expand565(Color1)};
+    for (int c = 0; c < 3; ++c)
+    {
+        if (Color0 > Color1)
+        {
+            Palette[2][c] = (2 * Palette[0][c] + Palette[1][c]) / 3;
+            Palette[3][c] = (Palette[0][c] + 2 * Palette[1][c]) / 3;
+        }
+        else
+        {
+            Palette[2][c] = (Palette[0][c] + Palette[1][c]) / 2;
+            Palette[3][c] = 0;
+        }
+    }
+    Palette[2][3] = 255;
+    Palette[3][3] = Color0 > Color1 ? 255 : 0;
+
+    const Uint32 Indices = pBlock[4] | (pBlock[5] << 8) | (pBlock[6] << 16) | (Uint32{pBlock[7]} << 24);
+    for (Uint32 t = 0; t < 16; ++t)
+        pTexels[t] = Palette[(Indices >> (t * 2)) & 3];
+}
+
+void DecodeBC4Block(const Uint8* pBlock, Texel* pTexels, Uint32 Channel)
+{
+    const int Value0 = pBlock[0];
+    const int Value1 = pBlock[1];
+
+    int Palette[8] = {Value0, Value1};
+    if (Value0 > Value1)
+    {
+        for (int i = 2; i < 8; ++i)
+            Palette[i] = ((8 - i) * Value0 + (i - 1) * Value1) / 7;
+    }
+    else
+    {
+        for (int i = 2; i < 6; ++i)
+            Palette[i] = ((6 - i) * Value0 + (i - 1) * Value1) / 5;
+        Palette[6] = 0;
+        Palette[7] = 255;
+    }
+
+    Uint64 Indices = 0;
+    for (Uint32 i = 0; i < 6; ++i)
+        Indices |= Uint64{pBlock[2 + i]} << (i * 8);
+    for (Uint32 t = 0; t < 16; ++t)
+        pTexels[t][Channel] = Palette[(Indices >> (t * 3)) & 7];
+}
+
+Uint32 ReadBits(const Uint8* pBlock, Uint32& Pos, Uint32 NumBits)
+{
+    Uint32 Value = 0;
+    for (Uint32 i = 0; i < NumBits; ++i, ++Pos)
+        Value |= ((pBlock[Pos / 8] >> (Pos % 8)) & 1u) << i;
+    return Value;
+}
+
+void DecodeBC7Mode6Block(const Uint8* pBlock, Texel* pTexels)
+{
+    Uint32 Pos = 0;
+    ASSERT_EQ(ReadBits(pBlock, Pos, 7), 1u << 6);
+
+    int Endpoints[2][4];
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        Endpoints[0][c] = ReadBits(pBlock, Pos, 7);
+        Endpoints[1][c] = ReadBits(pBlock, Pos, 7);
+    }
+    const Uint32 PBits[] = {ReadBits(pBlock, Pos, 1), ReadBits(pBlock, Pos, 1)};
+    for (Uint32 e = 0; e < 2; ++e)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            Endpoints[e][c] = (Endpoints[e][c] << 1) | PBits[e];
+    }
+
+    static constexpr int Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    for (Uint32 t = 0; t < 16; ++t)
+    {
+        const Uint32 Index = ReadBits(pBlock, Pos, t == 0 ? 3 : 4);
+        for (Uint32 c = 0; c < 4; ++c)
+            pTexels[t][c] = ((64 - Weights[Index]) * Endpoints[0][c] + Weights[Index] * Endpoints[1][c] + 32) >> 6;
+    }
+    EXPECT_EQ(Pos, 128u);
+}
+
+std::vector<Texel> Decompress(TEXTURE_FORMAT Format, const std::vector<Uint8>& Data, Uint32 Width, Uint32 Height)
+{
+    const Uint32 NumBlocksX = (Width + 3) / 4;
+    const Uint32 BlockSize  = GetTextureFormatAttribs(Format).GetElementSize();
+
+    std::vector<Texel> Texels(size_t{Width} * Height);
+    for (Uint32 y = 0; y < Height; y += 4)
+    {
+        for (Uint32 x = 0; x < Width; x += 4)
+        {
+            const Uint8* pBlock = &Data[(size_t{y / 4} * NumBlocksX + x / 4) * BlockSize];
+
+            Texel Block[16];
+            for (Texel& t : Block)
+                t = {0, 0, 0, 255};
+            switch (Format)
+            {
+                case TEX_FORMAT_BC1_UNORM: DecodeBC1Block(pBlock, Block); break;
+                case TEX_FORMAT_BC3_UNORM:
+                    DecodeBC1Block(pBlock + 8, Block);
+                    DecodeBC4Block(pBlock, Block, 3);
+                    break;
+                case TEX_FORMAT_BC4_UNORM: DecodeBC4Block(pBlock, Block, 0); break;
+                case TEX_FORMAT_BC5_UNORM:
+                    DecodeBC4Block(pBlock, Block, 0);
+                    DecodeBC4Block(pBlock + 8, Block, 1);
+                    break;
+                case TEX_FORMAT_BC7_UNORM: DecodeBC7Mode6Block(pBlock, Block); break;
+                default: UNEXPECTED("Unexpected format");
+            }
+
+            for (Uint32 by = 0; by < 4 && y + by < Height; ++by)
+            {
+                for (Uint32 bx = 0; bx < 4 && x + bx < Width; ++bx)
+                    Texels[size_t{y + by} * Width + x + bx] = Block[by * 4 + bx];
+            }
+        }
+    }
+    return Texels;
+}
+
+// Returns the peak signal-to-noise ratio of the channels in [FirstChannel, FirstChannel + NumChannels)
+float ComputePSNR(const std::vector<Uint8>& RGBA8, const std::vector<Texel>& Decoded, Uint32 FirstChannel, Uint32 NumChannels)
+{
+    double Error = 0;
+    for (size_t t = 0; t < Decoded.size(); ++t)
+    {
+        for (Uint32 c = FirstChannel; c < FirstChannel + NumChannels; ++c)
+        {
+            const double Diff = static_cast<double>(RGBA8[t * 4 + c]) - static_cast<double>(Decoded[t][c]);
+            Error += Diff * Diff;
+        }
+    }
+    const double MSE = Error / static_cast<double>(Decoded.size() * NumChannels);
+    return MSE > 0 ? static_cast<float>(10.0 * std::log10(255.0 * 255.0 / MSE)) : 100.f;
+}
+
+// Smooth color gradients with noise
+std::vector<Uint8> GenerateImage(Uint32 Width, Uint32 Height)
+{
+    FastRandInt        rnd{0, -8, 8};
+    std::vector<Uint8> RGBA8(size_t{Width} * Height * 4);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            const float u   = static_cast<float>(x) / static_cast<float>(Width);
+            const float v   = static_cast<float>(y) / static_cast<float>(Height);
+            const int   R   = static_cast<int>(255.f * (0.5f + 0.5f * std::sin(u * 6.f)));
+            const int   G   = static_cast<int>(255.f * v);
+            const int   B   = static_cast<int>(255.f * (0.5f + 0.5f * std::cos((u + v) * 4.f)));
+            const int   A   = static_cast<int>(255.f * u * v);
+            Uint8*      pTx = &RGBA8[(size_t{y} * Width + x) * 4];
+            pTx[0]          = static_cast<Uint8>(clamp(R + rnd(), 0, 255));
+            pTx[1]          = static_cast<Uint8>(clamp(G + rnd(), 0, 255));
+            pTx[2]          = static_cast<Uint8>(clamp(B + rnd(), 0, 255));
+            pTx[3]          = static_cast<Uint8>(clamp(A + rnd(), 0, 255));
+        }
+    }
+    return RGBA8;
+}
+
+std::vector<Uint8> Compress(const std::vector<Uint8>& RGBA8, Uint32 Width, Uint32 Height, TEXTURE_FORMAT Format, BLOCK_COMPRESSION_QUALITY Quality, IThreadPool* pThreadPool = nullptr)
+{
+    const Uint32 NumBlocksX = (Width + 3) / 4;
+    const Uint32 NumBlocksY = (Height + 3) / 4;
+    const Uint32 BlockSize  = GetTextureFormatAttribs(Format).GetElementSize();
+
+    std::vector<Uint8> Data(size_t{NumBlocksX} * NumBlocksY * BlockSize);
+
+    CompressTextureDataAttribs Attribs;
+    Attribs.Width       = Width;
+    Attribs.Height      = Height;
+    Attribs.pSrcData    = RGBA8.data();
+    Attribs.SrcStride   = size_t{Width} * 4;
+    Attribs.DstFormat   = Format;
+    Attribs.pDstData    = Data.data();
+    Attribs.DstStride   = size_t{NumBlocksX} * BlockSize;
+    Attribs.Quality     = Quality;
+    Attribs.pThreadPool = pThreadPool;
+    EXPECT_TRUE(CompressTextureData(Attribs));
+    return Data;
+}
+
+TEST(GraphicsTools_TextureCompressor, Quality)
+{
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 48;
+
+    const std::vector<Uint8> RGBA8 = GenerateImage(Width, Height);
+
+    struct FormatInfo
+    {
+        TEXTURE_FORMAT Format;
+        Uint32         FirstChannel;
+        Uint32         NumChannels;
+        float          MinPSNR;
+    };
+    const FormatInfo Formats[] = {
+        {TEX_FORMAT_BC1_UNORM, 0, 3, 30},
+        {TEX_FORMAT_BC3_UNORM, 0, 4, 31},
+        {TEX_FORMAT_BC4_UNORM, 0, 1, 40},
+        {TEX_FORMAT_BC5_UNORM, 0, 2, 40},
+        {TEX_FORMAT_BC7_UNORM, 0, 4, 31},
+    };
+    for (const FormatInfo& Fmt : Formats)
+    {
+        const char* Name = GetTextureFormatAttribs(Fmt.Format).Name;
+
+        const float FastPSNR   = ComputePSNR(RGBA8, Decompress(Fmt.Format, Compress(RGBA8, Width, Height, Fmt.Format, BLOCK_COMPRESSION_QUALITY_FAST), Width, Height), Fmt.FirstChannel, Fmt.NumChannels);
+        const float NormalPSNR = ComputePSNR(RGBA8, Decompress(Fmt.Format, Compress(RGBA8, Width, Height, Fmt.Format, BLOCK_COMPRESSION_QUALITY_NORMAL), Width, Height), Fmt.FirstChannel, Fmt.NumChannels);
+        EXPECT_GT(FastPSNR, Fmt.MinPSNR) << Name;
+        EXPECT_GE(NormalPSNR, FastPSNR - 0.1f) << Name;
+    }
+}
+
+TEST(GraphicsTools_TextureCompressor, SolidColor)
+{
+    // 6x5 texture tests partial blocks
+    constexpr Uint32 Width  = 6;
+    constexpr Uint32 Height = 5;
+
+    std::vector<Uint8> RGBA8(Width * Height * 4);
+    for (size_t t = 0; t < Width * Height; ++t)
+    {
+        RGBA8[t * 4 + 0] = 255;
+        RGBA8[t * 4 + 1] = 0;
+        RGBA8[t * 4 + 2] = 255;
+        RGBA8[t * 4 + 3] = 128;
+    }
+
+    const TEXTURE_FORMAT Formats[] = {TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC3_UNORM, TEX_FORMAT_BC4_UNORM, TEX_FORMAT_BC5_UNORM, TEX_FORMAT_BC7_UNORM};
+    for (TEXTURE_FORMAT Format : Formats)
+    {
+        const Uint32 NumChannels = Format == TEX_FORMAT_BC1_UNORM ? 3 : (Format == TEX_FORMAT_BC4_UNORM ? 1 : (Format == TEX_FORMAT_BC5_UNORM ? 2 : 4));
+        for (BLOCK_COMPRESSION_QUALITY Quality : {BLOCK_COMPRESSION_QUALITY_FAST, BLOCK_COMPRESSION_QUALITY_NORMAL})
+        {
+            const std::vector<Texel> Decoded = Decompress(Format, Compress(RGBA8, Width, Height, Format, Quality), Width, Height);
+            for (size_t t = 0; t < Decoded.size(); ++t)
+            {
+                for (Uint32 c = 0; c < NumChannels; ++c)
+                    EXPECT_NEAR(Decoded[t][c], RGBA8[t * 4 + c], 1) << GetTextureFormatAttribs(Format).Name;
+            }
+        }
+    }
+}
+
+TEST(GraphicsTools_TextureCompressor, Parallel)
+{
+    constexpr Uint32 Width  = 128;
+    constexpr Uint32 Height = 100;
+
+    const std::vector<Uint8> RGBA8 = GenerateImage(Width, Height);
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    for (TEXTURE_FORMAT Format : {TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC7_UNORM})
+    {
+        EXPECT_EQ(Compress(RGBA8, Width, Height, Format, BLOCK_COMPRESSION_QUALITY_NORMAL, pThreadPool),
+                  Compress(RGBA8, Width, Height, Format, BLOCK_COMPRESSION_QUALITY_NORMAL));
+    }
+}
+
+TEST(GraphicsTools_TextureCompressor, IsBlockCompressionSupported)
+{
+    EXPECT_TRUE(IsBlockCompressionSupported(TEX_FORMAT_BC1_UNORM_SRGB));
+    EXPECT_TRUE(IsBlockCompressionSupported(TEX_FORMAT_BC7_UNORM));
+    EXPECT_FALSE(IsBlockCompressionSupported(TEX_FORMAT_BC6H_UF16));
+    EXPECT_FALSE(IsBlockCompressionSupported(TEX_FORMAT_RGBA8_UNORM));
+}
+
+} // namespace
@@ -76,4 +76,39 @@ TEST(XXH128HasherTest, Struct)
     EXPECT_EQ(Hasher1.Digest(), Hasher2.Digest());
 }
 
+TEST(XXH128HasherTest, ShaderSourceHash)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source     = "void main() {}";
+    ShaderCI.EntryPoint = "main";
+    ShaderCI.Desc       = {"Test shader", SHADER_TYPE_VERTEX, true};
+
+    const XXH128Hash SourceHash = XXH128State::ComputeShaderSourceHash(ShaderCI);
+
+    auto GetHash = [&](const ShaderCreateInfo& CI, const XXH128Hash& SrcHash) {
+        XXH128State Hasher;
+        Hasher.Update(CI, SrcHash);
+        return Hasher.Digest();
+    };
+
+    const XXH128Hash Hash0 = GetHash(ShaderCI, SourceHash);
+    EXPECT_EQ(Hash0, GetHash(ShaderCI, SourceHash));
+
+    // The same source in a different memory location must produce the same hash
+    const std::string SourceCopy{ShaderCI.Source};
+    ShaderCreateInfo  ShaderCI2 = ShaderCI;
+    ShaderCI2.Source            = SourceCopy.c_str();
+    EXPECT_EQ(XXH128State::ComputeShaderSourceHash(ShaderCI2), SourceHash);
+
+    // Permutations with different macros share the source hash
+    const ShaderMacro Macros[] = {{"MACRO", "1"}};
+    ShaderCI2.Macros           = {Macros, _countof(Macros)};
+    EXPECT_EQ(XXH128State::ComputeShaderSourceHash(ShaderCI2), SourceHash);
+    EXPECT_FALSE(GetHash(ShaderCI2, SourceHash) == Hash0);
+
+    // Different source must produce a different hash
+    ShaderCI2.Source = "void main() { }";
+    EXPECT_FALSE(XXH128State::ComputeShaderSourceHash(ShaderCI2) == SourceHash);
+}
+
 } // namespace
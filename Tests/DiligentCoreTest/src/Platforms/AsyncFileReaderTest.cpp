@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "AsyncFileReader.hpp"
+
+#include <vector>
+#include <atomic>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "FileSystem.hpp"
+#include "TempDirectory.hpp"
+#include "FileWrapper.hpp"
+#include "FastRand.hpp"
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class AsyncFileReaderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_FileData.resize(1 << 20);
+        FastRandInt rnd{0, 0, 255};
+        for (Uint8& Byte : m_FileData)
+            Byte = static_cast<Uint8>(rnd());
+
+        m_FilePath = m_TmpDir.Get() + FileSystem::SlashSymbol + "AsyncRead.bin";
+        ASSERT_TRUE(FileWrapper::WriteFile(m_FilePath.c_str(), m_FileData.data(), m_FileData.size()));
+    }
+
+    TempDirectory      m_TmpDir;
+    std::string        m_FilePath;
+    std::vector<Uint8> m_FileData;
+};
+
+TEST_F(AsyncFileReaderTest, ParallelReads)
+{
+    // The queue is smaller than the number of reads to test the backlog
+    AsyncFileReader Reader{m_FilePath.c_str(), 4, 8};
+    ASSERT_EQ(Reader.GetSize(), m_FileData.size());
+
+    constexpr size_t NumReads = 256;
+    constexpr size_t ReadSize = 3001;
+
+    std::vector<Uint8>  Data(NumReads * ReadSize);
+    std::atomic<Uint32> NumSucceeded{0};
+    for (size_t i = 0; i < NumReads; ++i)
+    {
+        const Uint64 Offset = (i * 7919) % (m_FileData.size() - ReadSize);
+        Reader.ReadAsync(Offset, ReadSize, &Data[i * ReadSize], [&, Offset, i](bool Success, size_t NumBytesRead) {
+            if (Success && NumBytesRead == ReadSize && memcmp(&Data[i * ReadSize], &m_FileData[Offset], ReadSize) == 0)
+                NumSucceeded.fetch_add(1);
+        });
+    }
+    Reader.WaitIdle();
+    EXPECT_EQ(NumSucceeded.load(), NumReads);
+}
+
+TEST_F(AsyncFileReaderTest, WholeFile)
+{
+    std::vector<Uint8> Data(m_FileData.size());
+    {
+        AsyncFileReader Reader{m_FilePath.c_str()};
+        Reader.ReadAsync(0, Data.size(), Data.data(), [](bool Success, size_t NumBytesRead) {
+            EXPECT_TRUE(Success);
+        });
+        // The destructor waits for the read
+    }
+    EXPECT_EQ(Data, m_FileData);
+}
+
+TEST_F(AsyncFileReaderTest, ReadFromCallback)
+{
+    AsyncFileReader Reader{m_FilePath.c_str(), 1, 2};
+
+    // Every read submits the next one from the callback
+    constexpr size_t ChunkSize = 1 << 16;
+
+    std::vector<Uint8>                Data(m_FileData.size());
+    AsyncFileReader::ReadCallbackType ReadChunk;
+
+    size_t NumChunks = 0;
+    ReadChunk        = [&](bool Success, size_t NumBytesRead) {
+        EXPECT_TRUE(Success);
+        ++NumChunks;
+        const size_t Offset = NumChunks * ChunkSize;
+        if (Offset < Data.size())
+            Reader.ReadAsync(Offset, ChunkSize, &Data[Offset], ReadChunk);
+    };
+    Reader.ReadAsync(0, ChunkSize, Data.data(), ReadChunk);
+
+    // The next read is submitted before the callback returns, so the reader
+    // only becomes idle after the last chunk.
+    Reader.WaitIdle();
+    EXPECT_EQ(NumChunks, Data.size() / ChunkSize);
+    EXPECT_EQ(Data, m_FileData);
+}
+
+TEST_F(AsyncFileReaderTest, InvalidRange)
+{
+    AsyncFileReader Reader{m_FilePath.c_str()};
+
+    Uint8 Byte   = 0;
+    bool  Called = false;
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"exceeds the file size"};
+        Reader.ReadAsync(m_FileData.size(), 1, &Byte, [&](bool Success, size_t NumBytesRead) {
+            EXPECT_FALSE(Success);
+            EXPECT_EQ(NumBytesRead, 0u);
+            Called = true;
+        });
+    }
+    // Invalid reads complete immediately
+    EXPECT_TRUE(Called);
+
+    Called = false;
+    Reader.ReadAsync(m_FileData.size(), 0, nullptr, [&](bool Success, size_t NumBytesRead) {
+        EXPECT_TRUE(Success);
+        Called = true;
+    });
+    EXPECT_TRUE(Called);
+}
+
+TEST_F(AsyncFileReaderTest, MissingFile)
+{
+    TestingEnvironment::ErrorScope ExpectedErrors{"Failed to open file"};
+    EXPECT_THROW(AsyncFileReader((m_TmpDir.Get() + FileSystem::SlashSymbol + "MissingFile.bin").c_str()), std::runtime_error);
+}
+
+} // namespace
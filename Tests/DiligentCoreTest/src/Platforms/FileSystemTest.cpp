@@ -36,6 +36,8 @@
 #include "FileWrapper.hpp"
 #include "FastRand.hpp"
 #include "DataBlobImpl.hpp"
+#include "MappedFileDataBlob.hpp"
+#include "TestingEnvironment.hpp"
 
 using namespace Diligent;
 using namespace Diligent::Testing;
@@ -467,6 +469,64 @@ TEST(Platforms_FileSystem, File)
     EXPECT_FALSE(FileSystem::FileExists(FilePath.c_str()));
 }
 
+TEST(Platforms_FileSystem, MappedFile)
+{
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+
+    std::vector<Int32> Data(4096);
+
+    FastRandInt rnd{0, 0, static_cast<Int32>(FastRand::Max - 1)};
+    for (auto& Elem : Data)
+        Elem = rnd();
+    const auto FilePath = TmpDirPath + FileSystem::SlashSymbol + "MappedFile.ext";
+    ASSERT_TRUE(FileWrapper::WriteFile(FilePath.c_str(), Data.data(), Data.size() * sizeof(Data[0])));
+
+    {
+        RefCntAutoPtr<IDataBlob> pData;
+        ASSERT_TRUE(FileWrapper::MapWholeFile(FilePath.c_str(), &pData));
+        ASSERT_EQ(pData->GetSize(), Data.size() * sizeof(Data[0]));
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Data.data(), pData->GetSize()), 0);
+    }
+
+    if (MemoryMappedFile::IsSupported())
+    {
+        auto pData = MappedFileDataBlob::Create(FilePath.c_str());
+        ASSERT_TRUE(pData);
+        ASSERT_EQ(pData->GetSize(), Data.size() * sizeof(Data[0]));
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Data.data(), pData->GetSize()), 0);
+
+        // Changes must not be written back to the file
+        static_cast<Int32*>(pData->GetDataPtr())[0] = ~Data[0];
+        pData.Release();
+
+        std::vector<Uint8> FileData;
+        ASSERT_TRUE(FileWrapper::ReadWholeFile(FilePath.c_str(), FileData));
+        ASSERT_EQ(FileData.size(), Data.size() * sizeof(Data[0]));
+        EXPECT_EQ(memcmp(FileData.data(), Data.data(), FileData.size()), 0);
+
+        {
+            TestingEnvironment::ErrorScope ExpectedErrors{"Failed to open file"};
+            EXPECT_FALSE(MappedFileDataBlob::Create((TmpDirPath + FileSystem::SlashSymbol + "MissingFile.ext").c_str()));
+        }
+
+        // Empty file
+        const auto EmptyFilePath = TmpDirPath + FileSystem::SlashSymbol + "EmptyFile.ext";
+        {
+            FileWrapper EmptyFile{EmptyFilePath.c_str(), EFileAccessMode::Overwrite};
+            ASSERT_TRUE(EmptyFile);
+        }
+        pData = MappedFileDataBlob::Create(EmptyFilePath.c_str());
+        ASSERT_TRUE(pData);
+        EXPECT_EQ(pData->GetSize(), size_t{0});
+        EXPECT_EQ(pData->GetConstDataPtr(), pData->GetDataPtr());
+        pData.Release();
+        FileSystem::DeleteFile(EmptyFilePath.c_str());
+    }
+
+    FileSystem::DeleteFile(FilePath.c_str());
+}
+
 TEST(Platforms_FileSystem, Directories)
 {
     TempDirectory TmpDir;
@@ -535,7 +595,13 @@ TEST(Platforms_FileSystem, Search)
     for (const auto& Res : SearchRes)
     {
         if (FileNames.find(Res.Name) != FileNames.end())
+        {
             EXPECT_FALSE(Res.IsDirectory);
+#if PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_MACOS
+            EXPECT_EQ(Res.Size, Uint64{512 * sizeof(Int32)});
+            EXPECT_GT(Res.LastWriteTime, Uint64{0});
+#endif
+        }
         else if (DirNames.find(Res.Name) != DirNames.end())
             EXPECT_TRUE(Res.IsDirectory);
         else
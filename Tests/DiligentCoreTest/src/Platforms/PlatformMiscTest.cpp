@@ -114,4 +114,29 @@ TEST(Platforms_PlatformMisc, SwapBytes)
     EXPECT_EQ(PlatformMisc::SwapBytes(fswap), f);
 }
 
+template <class PlatformClass>
+void TestCPUTopology()
+{
+    const CPUTopologyInfo Topology = PlatformClass::GetCPUTopology();
+
+    EXPECT_GT(Topology.NumLogicalCores, 0u);
+    EXPECT_GT(Topology.NumPhysicalCores, 0u);
+    EXPECT_LE(Topology.NumPhysicalCores, Topology.NumLogicalCores);
+    EXPECT_EQ(Topology.NumPerformanceCores + Topology.NumEfficiencyCores, PlatformClass::CountOneBits(Topology.LogicalCoresMask));
+    EXPECT_GE(Topology.NumNUMANodes, 1u);
+
+    EXPECT_NE(Topology.LogicalCoresMask, Uint64{0});
+    EXPECT_NE(Topology.PerformanceCoresMask, Uint64{0});
+    EXPECT_EQ(Topology.PerformanceCoresMask & Topology.EfficiencyCoresMask, Uint64{0});
+    EXPECT_EQ(Topology.PerformanceCoresMask | Topology.EfficiencyCoresMask, Topology.LogicalCoresMask);
+    EXPECT_EQ(Topology.PrimaryThreadsMask & ~Topology.LogicalCoresMask, Uint64{0});
+    EXPECT_EQ(Topology.IsHybrid(), Topology.EfficiencyCoresMask != 0);
+}
+
+TEST(Platforms_PlatformMisc, GetCPUTopology)
+{
+    TestCPUTopology<PlatformMisc>();
+    TestCPUTopology<BasicPlatformMisc>();
+}
+
 } // namespace
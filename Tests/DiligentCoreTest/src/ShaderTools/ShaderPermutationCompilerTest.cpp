@@ -0,0 +1,165 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderPermutationCompiler.hpp"
+
+#include <atomic>
+#include <set>
+
+#include "DataBlobImpl.hpp"
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+static constexpr char g_TestSource[] = R"(
+// USE_COMMENT must be ignored
+/* USE_BLOCK_COMMENT
+   must be ignored */
+#if USE_A
+#    define VALUE COLOR
+#endif
+float4 main() : SV_Target
+{
+    return VALUE;
+}
+)";
+
+void TestPermutations(IThreadPool* pThreadPool)
+{
+    ShaderPermutationCompileInfo Info;
+    Info.ShaderCI.Source         = g_TestSource;
+    Info.ShaderCI.SourceLength   = sizeof(g_TestSource) - 1;
+    Info.ShaderCI.EntryPoint     = "main";
+    Info.ShaderCI.Desc           = {"Permutation test", SHADER_TYPE_PIXEL};
+    Info.ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+
+    constexpr ShaderMacro SharedMacros[] = {{"COLOR", "COLOR_VALUE"}};
+    Info.ShaderCI.Macros                 = {SharedMacros, _countof(SharedMacros)};
+
+    Info.Macros = {
+        {"USE_A", {"0", "1"}},
+        {"USE_COMMENT", {"0", "1"}},
+        {"COLOR_VALUE", {"float4(0,0,0,0)", "float4(1,1,1,1)", "float4(0,0,0,0)"}},
+        {"USE_BLOCK_COMMENT", {"0", "1"}},
+    };
+    Info.pThreadPool = pThreadPool;
+
+    std::atomic<int> NumCompiled{0};
+    Info.CompileHandler = [&](const ShaderCreateInfo& ShaderCI) -> RefCntAutoPtr<IObject> {
+        NumCompiled.fetch_add(1);
+        EXPECT_EQ(ShaderCI.Macros.Count, Uint32{5});
+        return RefCntAutoPtr<IObject>{DataBlobImpl::Create()};
+    };
+
+    ShaderPermutationCompileResult Result;
+    EXPECT_TRUE(CompileShaderPermutations(Info, Result));
+
+    constexpr size_t NumPermutations = 2 * 2 * 3 * 2;
+    ASSERT_EQ(Result.Permutations.size(), NumPermutations);
+    ASSERT_EQ(Result.SourceIndices.size(), NumPermutations);
+
+    // USE_A x COLOR_VALUE, where COLOR_VALUE 0 and 2 are identical
+    EXPECT_EQ(NumCompiled.load(), 4);
+    EXPECT_EQ(Result.SourceHashes.size(), size_t{4});
+    EXPECT_EQ(std::set<size_t>(Result.SourceHashes.begin(), Result.SourceHashes.end()).size(), size_t{4});
+    EXPECT_EQ(Result.IgnoredMacros, (std::vector<std::string>{"USE_COMMENT", "USE_BLOCK_COMMENT"}));
+
+    for (size_t i = 0; i < NumPermutations; ++i)
+    {
+        EXPECT_NE(Result.Permutations[i], nullptr);
+
+        const size_t UseA       = i % 2;
+        const size_t ColorValue = (i / 4) % 3;
+        // Permutation with USE_A = 0, USE_COMMENT = 0, COLOR_VALUE = ColorValue % 2, USE_BLOCK_COMMENT = 0
+        const size_t RefPermutation = UseA + (ColorValue % 2) * 4;
+        EXPECT_EQ(Result.SourceIndices[i], Result.SourceIndices[RefPermutation]) << "Permutation " << i;
+        EXPECT_EQ(Result.Permutations[i], Result.Permutations[RefPermutation]) << "Permutation " << i;
+    }
+    EXPECT_NE(Result.SourceIndices[0], Result.SourceIndices[1]);
+    EXPECT_NE(Result.SourceIndices[0], Result.SourceIndices[4]);
+}
+
+TEST(ShaderPermutationCompilerTest, Deduplication)
+{
+    TestPermutations(nullptr);
+}
+
+TEST(ShaderPermutationCompilerTest, Parallel)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+    TestPermutations(pThreadPool);
+    pThreadPool->WaitForAllTasks();
+}
+
+TEST(ShaderPermutationCompilerTest, TokenPasting)
+{
+    static constexpr char Source[] = R"(
+#define CAT(a, b) a##b
+float4 main() : SV_Target
+{
+    return CAT(USE_, COLOR);
+}
+)";
+
+    ShaderPermutationCompileInfo Info;
+    Info.ShaderCI.Source       = Source;
+    Info.ShaderCI.SourceLength = sizeof(Source) - 1;
+    Info.ShaderCI.EntryPoint   = "main";
+    Info.Macros                = {{"USE_COLOR", {"0", "1"}}};
+    Info.CompileHandler        = [&](const ShaderCreateInfo& ShaderCI) -> RefCntAutoPtr<IObject> {
+        return RefCntAutoPtr<IObject>{DataBlobImpl::Create()};
+    };
+
+    ShaderPermutationCompileResult Result;
+    EXPECT_TRUE(CompileShaderPermutations(Info, Result));
+    EXPECT_EQ(Result.SourceHashes.size(), size_t{2});
+    EXPECT_TRUE(Result.IgnoredMacros.empty());
+}
+
+TEST(ShaderPermutationCompilerTest, CompileFailure)
+{
+    ShaderPermutationCompileInfo Info;
+    Info.ShaderCI.Source     = g_TestSource;
+    Info.ShaderCI.EntryPoint = "main";
+    Info.Macros              = {{"USE_A", {"0", "1"}}};
+    Info.CompileHandler      = [&](const ShaderCreateInfo& ShaderCI) -> RefCntAutoPtr<IObject> {
+        return ShaderCI.Macros[0].Definition[0] == '1' ? RefCntAutoPtr<IObject>{DataBlobImpl::Create()} : RefCntAutoPtr<IObject>{};
+    };
+
+    ShaderPermutationCompileResult Result;
+    EXPECT_FALSE(CompileShaderPermutations(Info, Result));
+    ASSERT_EQ(Result.Permutations.size(), size_t{2});
+    EXPECT_EQ(Result.Permutations[0], nullptr);
+    EXPECT_NE(Result.Permutations[1], nullptr);
+}
+
+} // namespace
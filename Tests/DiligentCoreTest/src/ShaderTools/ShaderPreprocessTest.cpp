@@ -194,6 +194,47 @@ TEST(ShaderPreprocessTest, UnrollIncludes)
     }
 }
 
+TEST(ShaderPreprocessTest, SourceCache)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    CreateDefaultShaderSourceStreamFactory("shaders/ShaderPreprocessor", &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.Desc.Name                  = "TestShader";
+    ShaderCI.FilePath                   = "IncludeBasicTest.hlsl";
+    ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+
+    ASSERT_FALSE(IsShaderSourceCacheEnabled());
+    const std::string RefUnrolledSource = UnrollShaderIncludes(ShaderCI);
+
+    const std::vector<std::string> RefDependencies{"IncludeCommon0.hlsl", "IncludeCommon1.hlsl"};
+    std::vector<std::string>       Dependencies;
+    EXPECT_TRUE(GetShaderIncludeDependencies(ShaderCI, Dependencies));
+    EXPECT_EQ(Dependencies, RefDependencies);
+
+    EXPECT_NE(LoadShaderSourceFile(pShaderSourceFactory, "IncludeCommon0.hlsl").RawPtr(),
+              LoadShaderSourceFile(pShaderSourceFactory, "IncludeCommon0.hlsl").RawPtr());
+
+    SetShaderSourceCacheEnabled(true);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        EXPECT_EQ(UnrollShaderIncludes(ShaderCI), RefUnrolledSource);
+        EXPECT_TRUE(GetShaderIncludeDependencies(ShaderCI, Dependencies));
+        EXPECT_EQ(Dependencies, RefDependencies);
+    }
+
+    RefCntAutoPtr<IDataBlob> pCachedData = LoadShaderSourceFile(pShaderSourceFactory, "IncludeCommon0.hlsl");
+    ASSERT_NE(pCachedData, nullptr);
+    EXPECT_EQ(LoadShaderSourceFile(pShaderSourceFactory, "IncludeCommon0.hlsl").RawPtr(), pCachedData.RawPtr());
+
+    InvalidateShaderSourceCache("IncludeCommon0.hlsl");
+    EXPECT_NE(LoadShaderSourceFile(pShaderSourceFactory, "IncludeCommon0.hlsl").RawPtr(), pCachedData.RawPtr());
+
+    SetShaderSourceCacheEnabled(false);
+    EXPECT_FALSE(IsShaderSourceCacheEnabled());
+}
+
 TEST(ShaderPreprocessTest, ShaderSourceLanguageDefiniton)
 {
     EXPECT_EQ(ParseShaderSourceLanguageDefinition(""), SHADER_SOURCE_LANGUAGE_DEFAULT);
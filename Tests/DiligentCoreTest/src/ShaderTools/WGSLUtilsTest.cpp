@@ -103,7 +103,7 @@ TEST(WGSLUtils, GetWGSLEmulatedArrayElementInfo)
     EXPECT_EQ(GetWGSLEmulatedArrayElement("Tex2Dxxxxxx5", "xx"), WGSLEmulatedResourceArrayElement("Tex2Dxxxx", 5));
 }
 
-std::string HLSLtoWGLS(const char* FilePath)
+std::vector<uint32_t> HLSLtoSPIRV(const char* FilePath)
 {
     ShaderCreateInfo ShaderCI;
     ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
@@ -122,6 +122,12 @@ std::string HLSLtoWGLS(const char* FilePath)
     auto SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, GLSLangUtils::SpirvVersion::Vk100, nullptr, nullptr);
     GLSLangUtils::FinalizeGlslang();
 
+    return SPIRV;
+}
+
+std::string HLSLtoWGLS(const char* FilePath)
+{
+    const auto SPIRV = HLSLtoSPIRV(FilePath);
     if (SPIRV.empty())
         return {};
 
@@ -184,6 +190,50 @@ TEST(WGSLUtils, RemapUniformBuffers)
                           });
 }
 
+TEST(WGSLUtils, ConvertAndRemap)
+{
+    const auto SPIRV = HLSLtoSPIRV("UniformBuffers.psh");
+    ASSERT_FALSE(SPIRV.empty());
+
+    const WGSLResourceMapping ResRemapping{
+        {"CB0", {1, 2}},
+        {"CB1", {3, 4}},
+        {"CB2", {5, 6}},
+    };
+
+    const auto WGSL = ConvertSPIRVtoWGSL(SPIRV);
+    ASSERT_FALSE(WGSL.empty());
+    const auto RemappedWGSL = RamapWGSLResourceBindings(WGSL, ResRemapping, "_");
+    ASSERT_FALSE(RemappedWGSL.empty());
+
+    EXPECT_EQ(ConvertSPIRVtoWGSL(SPIRV, ResRemapping, "_"), RemappedWGSL);
+}
+
+TEST(WGSLUtils, ConversionCache)
+{
+    const auto SPIRV = HLSLtoSPIRV("UniformBuffers.psh");
+    ASSERT_FALSE(SPIRV.empty());
+
+    const auto RefWGSL = ConvertSPIRVtoWGSL(SPIRV);
+    ASSERT_FALSE(RefWGSL.empty());
+
+    SetWGSLConversionCacheSize(size_t{16} << 20);
+
+    const auto Stats = GetWGSLConversionCacheStats();
+    EXPECT_EQ(ConvertSPIRVtoWGSL(SPIRV), RefWGSL);
+    EXPECT_EQ(ConvertSPIRVtoWGSL(SPIRV), RefWGSL);
+    EXPECT_EQ(GetWGSLConversionCacheStats().NumMisses, Stats.NumMisses + 1);
+    EXPECT_EQ(GetWGSLConversionCacheStats().NumHits, Stats.NumHits + 1);
+
+    // Different resource mappings must not share the results
+    const auto WGSL0 = RamapWGSLResourceBindings(RefWGSL, {{"CB0", {1, 2}}, {"CB1", {3, 4}}, {"CB2", {5, 6}}}, "_");
+    const auto WGSL1 = RamapWGSLResourceBindings(RefWGSL, {{"CB0", {1, 3}}, {"CB1", {3, 4}}, {"CB2", {5, 6}}}, "_");
+    EXPECT_NE(WGSL0, WGSL1);
+    EXPECT_EQ(RamapWGSLResourceBindings(RefWGSL, {{"CB2", {5, 6}}, {"CB1", {3, 4}}, {"CB0", {1, 2}}}, "_"), WGSL0);
+
+    SetWGSLConversionCacheSize(0);
+}
+
 TEST(WGSLUtils, RemapTextures)
 {
     TestResourceRemapping("Textures.psh",
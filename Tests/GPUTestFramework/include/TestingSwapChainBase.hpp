@@ -219,6 +219,11 @@ public:
         UNEXPECTED("Testing swap chain can't set the maximum frame latency");
     }
 
+    virtual Bool DILIGENT_CALL_TYPE WaitForNextFrame(Uint32 Timeout) override final
+    {
+        return True;
+    }
+
     virtual ITextureView* DILIGENT_CALL_TYPE GetCurrentBackBufferRTV() override final
     {
         return m_pRTV;
@@ -362,9 +362,10 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
             // Always enable validation
             EngineCI.SetValidationLevel(VALIDATION_LEVEL_1);
 
-            EngineCI.Window   = Window;
-            EngineCI.Features = EnvCI.Features;
-            NumDeferredCtx    = 0;
+            EngineCI.Window              = Window;
+            EngineCI.Features            = EnvCI.Features;
+            NumDeferredCtx               = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts = NumDeferredCtx;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
             RefCntAutoPtr<ISwapChain> pSwapChain; // We will use testing swap chain instead
             pFactoryOpenGL->CreateDeviceAndSwapChainGL(
@@ -663,6 +664,15 @@ GPUTestingEnvironment::~GPUTestingEnvironment()
                 "\n    GenerateMips              ", CmdCounters.GenerateMips,
                 "\n    ResolveTextureSubresource ", CmdCounters.ResolveTextureSubresource,
                 "\n    BindSparseResourceMemory  ", CmdCounters.BindSparseResourceMemory,
+                "\n  Redundant state commands",
+                "\n    SetPipelineState          ", CmdCounters.RedundantSetPipelineState,
+                "\n    SetVertexBuffers          ", CmdCounters.RedundantSetVertexBuffers,
+                "\n    SetIndexBuffer            ", CmdCounters.RedundantSetIndexBuffer,
+                "\n    SetBlendFactors           ", CmdCounters.RedundantSetBlendFactors,
+                "\n    SetStencilRef             ", CmdCounters.RedundantSetStencilRef,
+                "\n    SetViewports              ", CmdCounters.RedundantSetViewports,
+                "\n    SetScissorRects           ", CmdCounters.RedundantSetScissorRects,
+                "\n    CommitShaderResources     ", CmdCounters.RedundantCommitShaderResources,
                 "\n  Primitives",
                 "\n    TRIANGLE_LIST             ", Stats.PrimitiveCounts[PRIMITIVE_TOPOLOGY_TRIANGLE_LIST],
                 "\n    TRIANGLE_STRIP            ", Stats.PrimitiveCounts[PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP],
@@ -40,6 +40,8 @@ void TestAsyncTask()
     (void)IsFinished;
     IAsyncTask_WaitForCompletion((IAsyncTask*)NULL);
     IAsyncTask_WaitUntilRunning((IAsyncTask*)NULL);
+    bool IsComplete = IAsyncTask_WaitForCompletionWithTimeout((IAsyncTask*)NULL, 10);
+    (void)IsComplete;
 }
 
 void TestThreadPool()
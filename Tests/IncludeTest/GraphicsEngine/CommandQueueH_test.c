@@ -35,4 +35,8 @@ void TestCommandQueueCInterface(ICommandQueue* pQueue)
     (void)FenceVal;
 
     ICommandQueue_WaitForIdle(pQueue);
+
+    TimestampCalibration Calibration;
+    Bool                 Res = ICommandQueue_GetTimestampCalibration(pQueue, &Calibration);
+    (void)Res;
 }
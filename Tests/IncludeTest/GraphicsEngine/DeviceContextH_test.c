@@ -88,6 +88,8 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     IDeviceContext_UnmapBuffer(pCtx, (struct IBuffer*)NULL, MAP_WRITE);
     IDeviceContext_UpdateTexture(pCtx, (struct ITexture*)NULL, 0u, 0u, (const struct Box*)NULL, (const struct TextureSubResData*)NULL, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_NONE);
     IDeviceContext_CopyTexture(pCtx, (const struct CopyTextureAttribs*)NULL);
+    IDeviceContext_UpdateTextures(pCtx, (const struct UpdateTextureAttribs*)NULL, 0u);
+    IDeviceContext_CopyTextures(pCtx, (const struct CopyTextureAttribs*)NULL, 0u);
     IDeviceContext_MapTextureSubresource(pCtx, (struct ITexture*)NULL, 0u, 0u, MAP_WRITE, MAP_FLAG_DISCARD, (const struct Box*)NULL, (struct MappedTextureSubresource*)NULL);
     IDeviceContext_UnmapTextureSubresource(pCtx, (struct ITexture*)NULL, 0u, 0u);
     IDeviceContext_GenerateMips(pCtx, (struct ITextureView*)NULL);
@@ -122,6 +124,13 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
 
     IDeviceContext_BindSparseResourceMemory(pCtx, (const BindSparseResourceMemoryAttribs*)NULL);
 
+    IDeviceContext_SubmitDrawPackets(pCtx, (const DrawPacket*)NULL, 0);
+
+    IDeviceContext_ResolveQueries(pCtx, (const ResolveQueriesAttribs*)NULL);
+    IDeviceContext_BeginConditionalRendering(pCtx, (const BeginConditionalRenderingAttribs*)NULL);
+    IDeviceContext_EndConditionalRendering(pCtx);
+    IDeviceContext_SetDynamicRenderState(pCtx, (const DynamicRenderState*)NULL);
+
     IDeviceContext_ClearStats(pCtx);
     const struct DeviceContextStats* pStats = IDeviceContext_GetStats(pCtx);
     (void)pStats;
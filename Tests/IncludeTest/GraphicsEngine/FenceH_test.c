@@ -36,4 +36,12 @@ void TestFenceCInterface(struct IFence* pFence)
 
     IFence_Signal(pFence, (Uint64)0);
     IFence_Wait(pFence, (Uint64)0);
+
+    Bool Completed = IFence_WaitWithTimeout(pFence, (Uint64)0, (Uint64)1000);
+    (void)(Completed);
+
+    WaitForFencesAttribs Attribs;
+    Attribs.NumFences = 1;
+    Attribs.ppFences  = &pFence;
+    (void)(Attribs);
 }
@@ -31,6 +31,8 @@ void TestPipelineResourceSignature(struct IPipelineResourceSignature* pSign)
 {
     IPipelineResourceSignature_CreateShaderResourceBinding(pSign, (struct IShaderResourceBinding**)NULL, true);
 
+    IPipelineResourceSignature_CreateShaderResourceBindings(pSign, 4, (struct IShaderResourceBinding**)NULL, true);
+
     struct IShaderResourceVariable* pVar1 = IPipelineResourceSignature_GetStaticVariableByName(pSign, SHADER_TYPE_UNKNOWN, "name");
     (void)pVar1;
 
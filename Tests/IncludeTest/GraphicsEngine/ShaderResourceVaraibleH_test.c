@@ -41,4 +41,5 @@ void TestShaderResourceVariable_CInterface(IShaderResourceVariable* pVar)
     (void)Idx;
     struct IDeviceObject* pObj = IShaderResourceVariable_Get(pVar, (Uint32)1);
     (void)pObj;
+    IShaderResourceVariable_SetInlineConstants(pVar, (const void*)NULL, (Uint32)0, (Uint32)4);
 }
@@ -39,6 +39,8 @@ void TestTexture_CInterface(ITexture* pTexture)
     ITexture_SetState(pTexture, RESOURCE_STATE_UNKNOWN);
     RESOURCE_STATE State = ITexture_GetState(pTexture);
     (void)State;
+    State = ITexture_GetSubresourceState(pTexture, 0, 0);
+    (void)State;
     const SparseTextureProperties* pSparseProps = ITexture_GetSparseProperties(pTexture);
     (void)pSparseProps;
 }
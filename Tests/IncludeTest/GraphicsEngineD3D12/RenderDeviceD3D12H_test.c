@@ -38,4 +38,8 @@ void TestRenderDeviceD3D12CInterface(IRenderDeviceD3D12* pDevice)
     IRenderDeviceD3D12_CreateBufferFromD3DResource(pDevice, (ID3D12Resource*)NULL, (BufferDesc*)NULL, RESOURCE_STATE_CONSTANT_BUFFER, (IBuffer**)NULL);
     IRenderDeviceD3D12_CreateBLASFromD3DResource(pDevice, (ID3D12Resource*)NULL, (BottomLevelASDesc*)NULL, RESOURCE_STATE_BUILD_AS_READ, (IBottomLevelAS**)NULL);
     IRenderDeviceD3D12_CreateTLASFromD3DResource(pDevice, (ID3D12Resource*)NULL, (TopLevelASDesc*)NULL, RESOURCE_STATE_BUILD_AS_READ, (ITopLevelAS**)NULL);
+
+    PlacedResourceHeapStatsD3D12 Stats;
+    IRenderDeviceD3D12_GetPlacedResourceHeapStats(pDevice, &Stats);
+    IRenderDeviceD3D12_SetResidencyPriority(pDevice, (IDeviceObject*)NULL, D3D12_RESIDENCY_PRIORITY_NORMAL);
 }
@@ -32,4 +32,8 @@ void TestFenceVk_CInterface(IFenceVk* pFence)
 {
     VkSemaphore Sem = IFenceVk_GetVkSemaphore(pFence);
     (void)Sem;
+
+    Uint64 Handle   = 0;
+    bool   Exported = IFenceVk_ExportSemaphoreHandle(pFence, &Handle);
+    (void)Exported;
 }
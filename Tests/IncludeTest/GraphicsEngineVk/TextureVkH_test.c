@@ -37,4 +37,8 @@ void TestTextureVk_CInterface(ITextureVk* pTexture)
 
     VkImageLayout vkLayout = ITextureVk_GetLayout(pTexture);
     (void)vkLayout;
+
+    ExternalMemoryHandleVk Handle;
+    bool                   Exported = ITextureVk_ExportMemoryHandle(pTexture, &Handle);
+    (void)Exported;
 }
@@ -45,8 +45,19 @@ void TestRenderStateCacheCInterface()
     IRenderStateCache_CreateTilePipelineState(pCache, (TilePipelineStateCreateInfo*)NULL, &pPSO);
     IRenderStateCache_WriteToBlob(pCache, 1234, (IDataBlob**)NULL);
     IRenderStateCache_WriteToStream(pCache, 1234, (IFileStream*)NULL);
+    IRenderStateCache_AppendToJournal(pCache, 1234, (IFileStream*)NULL, (IThreadPool*)NULL);
+    IRenderStateCache_LoadJournal(pCache, (IDataBlob*)NULL, 1234, true);
+    IRenderStateCache_WaitForJournal(pCache);
     IRenderStateCache_Reset(pCache);
     IRenderStateCache_Reload(pCache, NULL, NULL);
+    IRenderStateCache_ReloadFiles(pCache, NULL, 0, NULL, NULL);
+    IRenderStateCache_WriteUsageManifest(pCache, (IDataBlob**)NULL);
+    IRenderStateCache_ResetUsage(pCache);
+    Uint32 NumPrewarmed = IRenderStateCache_Prewarm(pCache, (IDataBlob*)NULL);
+    (void)NumPrewarmed;
+    Uint32 NumPending = IRenderStateCache_GetNumPendingPrewarmPipelines(pCache);
+    (void)NumPending;
+    IRenderStateCache_ReleasePrewarmedPipelines(pCache);
     Uint32 Ver = IRenderStateCache_GetContentVersion(pCache);
     (void)Ver;
 }